@@ -425,6 +425,50 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt& ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Structure-of-arrays representation of a batch of bounding boxes
+struct BoundBoxBatch
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+};
+
+/// Tests a batch of bounding boxes against the view frustum
+
+/// \param [in]  Frustum           - View frustum.
+/// \param [in]  Boxes             - Bounding boxes in the structure-of-arrays layout.
+/// \param [in]  NumBoxes          - The number of boxes in the batch.
+/// \param [out] pVisibleMask      - Array of (NumBoxes + 31) / 32 words. Bit (i % 32) of
+///                                  word (i / 32) is set if box i is not invisible.
+/// \param [out] pFullyVisibleMask - Optional array of the same size. The bit is set if the box
+///                                  is fully visible.
+/// \param [in]  PlaneFlags        - Frustum planes to test the boxes against.
+///
+/// \remarks   The results are the same as those returned by GetBoxVisibility().
+///            Unused bits of the last mask word are set to zero.
+///            The function uses AVX, SSE2 or NEON instructions if they are enabled
+///            by the compiler settings.
+void GetBoxVisibilityBatch(const ViewFrustum&   Frustum,
+                           const BoundBoxBatch& Boxes,
+                           size_t               NumBoxes,
+                           Uint32*              pVisibleMask,
+                           Uint32*              pFullyVisibleMask = nullptr,
+                           FRUSTUM_PLANE_FLAGS  PlaneFlags        = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
+/// Tests a batch of bounding boxes against the view frustum, see GetBoxVisibilityBatch().
+
+/// Like GetBoxVisibility(const ViewFrustumExt&, ...), when all planes are tested, the boxes
+/// that intersect the frustum planes are additionally tested against the frustum corners.
+void GetBoxVisibilityBatch(const ViewFrustumExt& Frustum,
+                           const BoundBoxBatch&  Boxes,
+                           size_t                NumBoxes,
+                           Uint32*               pVisibleMask,
+                           Uint32*               pFullyVisibleMask = nullptr,
+                           FRUSTUM_PLANE_FLAGS   PlaneFlags        = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM);
+
 inline float GetPointToBoxDistance(const BoundBox& BndBox, const float3& Pos)
 {
     VERIFY_EXPR(BndBox.Max.x >= BndBox.Min.x &&
@@ -635,6 +679,72 @@ inline float IntersectRayTriangle(const float3& V0,
 }
 
 
+/// Structure-of-arrays representation of a batch of rays
+struct RayBatch
+{
+    const float* OriginX    = nullptr;
+    const float* OriginY    = nullptr;
+    const float* OriginZ    = nullptr;
+    const float* DirectionX = nullptr;
+    const float* DirectionY = nullptr;
+    const float* DirectionZ = nullptr;
+};
+
+/// Intersects a batch of rays with the axis-aligned bounding box
+
+/// \param [in]  Rays       - Rays in the structure-of-arrays layout.
+/// \param [in]  NumRays    - The number of rays in the batch.
+/// \param [in]  AABB       - Axis-aligned bounding box.
+/// \param [out] pHitMask   - Array of (NumRays + 31) / 32 words. Bit (i % 32) of
+///                           word (i / 32) is set if ray i intersects the box.
+/// \param [out] pEnterDist - Optional array of NumRays distances to the entry points.
+/// \param [out] pExitDist  - Optional array of NumRays distances to the exit points.
+///
+/// \remarks   The results are the same as those returned by IntersectRayAABB().
+///            The function uses AVX, SSE2 or NEON instructions if they are enabled
+///            by the compiler settings.
+void IntersectRayBatchAABB(const RayBatch& Rays,
+                           size_t          NumRays,
+                           const BoundBox& AABB,
+                           Uint32*         pHitMask,
+                           float*          pEnterDist = nullptr,
+                           float*          pExitDist  = nullptr);
+
+/// Structure-of-arrays representation of a batch of triangles
+struct TriangleBatch
+{
+    const float* V0X = nullptr;
+    const float* V0Y = nullptr;
+    const float* V0Z = nullptr;
+    const float* V1X = nullptr;
+    const float* V1Y = nullptr;
+    const float* V1Z = nullptr;
+    const float* V2X = nullptr;
+    const float* V2Y = nullptr;
+    const float* V2Z = nullptr;
+};
+
+/// Intersects a ray with a batch of triangles
+
+/// \param [in]  RayOrigin    - Ray origin.
+/// \param [in]  RayDirection - Ray direction.
+/// \param [in]  Triangles    - Triangles in the structure-of-arrays layout.
+/// \param [in]  NumTriangles - The number of triangles in the batch.
+/// \param [out] pDistances   - Array of NumTriangles distances along the ray to the intersection
+///                             points, or +FLT_MAX for triangles that are not intersected.
+/// \param [in]  CullBackFace - Whether to ignore back-facing triangles.
+///
+/// \remarks   The results are the same as those returned by IntersectRayTriangle().
+///            The function uses AVX, SSE2 or NEON instructions if they are enabled
+///            by the compiler settings.
+void IntersectRayTriangleBatch(const float3&        RayOrigin,
+                               const float3&        RayDirection,
+                               const TriangleBatch& Triangles,
+                               size_t               NumTriangles,
+                               float*               pDistances,
+                               bool                 CullBackFace = false);
+
+
 /// Traces a 2D line through the square cell grid and enumerates all cells the line touches.
 
 /// \tparam TCallback - Type of the callback function.
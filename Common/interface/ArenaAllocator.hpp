@@ -0,0 +1,184 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ArenaAllocator class
+
+#include <vector>
+#include <cstring>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "CompilerDefinitions.h"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Resettable linear memory arena that implements IMemoryAllocator interface.
+
+/// Memory is bump-allocated from a single contiguous block. When the block runs out of space,
+/// additional overflow blocks are allocated from the raw allocator. Reset() invalidates all
+/// allocations at once and, if overflow blocks were used, replaces all blocks with a single
+/// block large enough to hold them, so that after a few resets the arena stops touching
+/// the raw allocator entirely.
+///
+/// \remarks Free() is a no-op. The allocator is not thread-safe.
+class ArenaAllocator final : public IMemoryAllocator
+{
+public:
+    /// Alignment of the memory returned by IMemoryAllocator::Allocate().
+    static constexpr size_t DefaultAlignment = 16;
+
+    // clang-format off
+    ArenaAllocator           (const ArenaAllocator&) = delete;
+    ArenaAllocator           (ArenaAllocator&&)      = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(ArenaAllocator&&)      = delete;
+    // clang-format on
+
+    /// \param [in] RawAllocator - Allocator that is used to allocate arena blocks.
+    /// \param [in] InitialSize  - Initial arena size. The block is allocated lazily
+    ///                            by the first allocation.
+    explicit ArenaAllocator(IMemoryAllocator& RawAllocator, size_t InitialSize = 64 << 10) :
+        m_pRawAllocator{&RawAllocator},
+        m_Capacity{InitialSize}
+    {
+    }
+
+    ~ArenaAllocator()
+    {
+        ReleaseBlocks();
+    }
+
+    /// Implementation of IMemoryAllocator::Allocate().
+    virtual void* Allocate(size_t Size, const Char* /*dbgDescription*/, const char* /*dbgFileName*/, const Int32 /*dbgLineNumber*/) override final
+    {
+        return Allocate(Size, DefaultAlignment);
+    }
+
+    /// Implementation of IMemoryAllocator::Free(); does nothing as the memory is reclaimed by Reset().
+    virtual void Free(void* /*Ptr*/) override final
+    {
+    }
+
+    NODISCARD void* Allocate(size_t Size, size_t Alignment)
+    {
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") is not power of two");
+        if (Size == 0)
+            return nullptr;
+
+        if (m_pData == nullptr && m_OverflowBlocks.empty())
+        {
+            m_pData = reinterpret_cast<Uint8*>(m_pRawAllocator->Allocate(m_Capacity, "Arena allocator block", __FILE__, __LINE__));
+            m_Size  = m_Capacity;
+        }
+
+        if (m_pData != nullptr)
+        {
+            auto* Ptr = AlignUp(m_pData + m_Offset, Alignment);
+            if (Ptr + Size <= m_pData + m_Size)
+            {
+                m_Offset = (Ptr + Size) - m_pData;
+                return Ptr;
+            }
+        }
+
+        // The main block is exhausted - allocate a dedicated overflow block.
+        // This only happens until the next Reset() grows the main block.
+        const auto BlockSize = Size + Alignment - 1;
+        auto*      pBlock    = reinterpret_cast<Uint8*>(m_pRawAllocator->Allocate(BlockSize, "Arena allocator overflow block", __FILE__, __LINE__));
+        m_OverflowBlocks.push_back(pBlock);
+        m_OverflowSize += BlockSize;
+        return AlignUp(pBlock, Alignment);
+    }
+
+    template <typename T>
+    NODISCARD T* Allocate(size_t Count = 1)
+    {
+        return reinterpret_cast<T*>(Allocate(sizeof(T) * Count, alignof(T)));
+    }
+
+    template <typename T>
+    NODISCARD T* CopyArray(const T* Src, size_t Count)
+    {
+        T* Dst = Allocate<T>(Count);
+        for (size_t i = 0; i < Count; ++i)
+            new (Dst + i) T{Src[i]};
+        return Dst;
+    }
+
+    /// Invalidates all allocations made since the last reset.
+    void Reset()
+    {
+        if (!m_OverflowBlocks.empty())
+        {
+            // Grow the arena so that the peak usage fits into a single block
+            const size_t RequiredSize = m_Size + m_OverflowSize;
+            while (m_Capacity < RequiredSize)
+                m_Capacity *= 2;
+            ReleaseBlocks();
+        }
+        m_Offset = 0;
+    }
+
+    /// Returns the size of the main block, in bytes.
+    size_t GetCapacity() const { return m_Capacity; }
+
+    /// Returns the number of bytes used in the main block.
+    size_t GetUsedSize() const { return m_Offset; }
+
+private:
+    void ReleaseBlocks()
+    {
+        if (m_pData != nullptr)
+        {
+            m_pRawAllocator->Free(m_pData);
+            m_pData = nullptr;
+            m_Size  = 0;
+        }
+        for (auto* pBlock : m_OverflowBlocks)
+            m_pRawAllocator->Free(pBlock);
+        m_OverflowBlocks.clear();
+        m_OverflowSize = 0;
+    }
+
+    IMemoryAllocator* const m_pRawAllocator;
+
+    Uint8* m_pData    = nullptr;
+    size_t m_Size     = 0;
+    size_t m_Offset   = 0;
+    size_t m_Capacity = 0;
+
+    std::vector<Uint8*> m_OverflowBlocks;
+    size_t              m_OverflowSize = 0;
+};
+
+} // namespace Diligent
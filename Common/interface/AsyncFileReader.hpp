@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::AsyncFileReader class
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../Primitives/interface/DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Reads files on the worker threads of a thread pool.
+
+/// The reads are scheduled onto the pool that is shared with the rest of the application
+/// (see Diligent::IThreadPool). If no pool is provided, the reader creates its own pool on first use.
+/// File reads are dominated by latency rather than CPU time (in particular on network
+/// storage), so that pool has a fixed number of threads independent of the number of cores
+/// to keep several reads in flight.
+class AsyncFileReader
+{
+public:
+    /// Callback that is invoked on a worker thread when the read completes.
+    /// pData is null if none of the files could be read.
+    using CallbackType = std::function<void(IDataBlob* pData)>;
+
+    /// The number of threads in the pool that the reader creates when no pool is provided.
+    static constexpr Uint32 DefaultThreadCount = 4;
+
+    explicit AsyncFileReader(IThreadPool* pThreadPool = nullptr) :
+        m_pThreadPool{pThreadPool}
+    {}
+
+    /// Waits for the reads enqueued by this reader.
+    ~AsyncFileReader();
+
+    // clang-format off
+    AsyncFileReader           (const AsyncFileReader&)  = delete;
+    AsyncFileReader           (      AsyncFileReader&&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&)  = delete;
+    AsyncFileReader& operator=(      AsyncFileReader&&) = delete;
+    // clang-format on
+
+    /// Schedules the subsequent reads onto the given pool. Reads that have already been enqueued
+    /// are completed by the previous pool. If pThreadPool is null, the reader creates its own pool.
+    void SetThreadPool(IThreadPool* pThreadPool);
+
+    /// Stops scheduling the reads onto pThreadPool if it is the current pool of the reader.
+    void ResetThreadPool(IThreadPool* pThreadPool);
+
+    /// Enqueues reading the first file from the list that can be opened, which allows
+    /// resolving search paths on the worker thread as well.
+    void ReadFile(std::vector<std::string> CandidatePaths, CallbackType&& Callback);
+
+    /// Enqueues reading the file and invokes the callback when the read completes.
+    void ReadFile(std::string Path, CallbackType&& Callback);
+
+    /// Enqueues reading the file and returns the future that receives the data.
+    std::future<RefCntAutoPtr<IDataBlob>> ReadFile(std::string Path);
+
+    /// Blocks until all reads enqueued by this reader have completed.
+
+    /// \remarks   Other tasks of the thread pool are not waited for. The method must not be
+    ///             called from a worker thread of the pool.
+    void WaitForAllReads();
+
+    /// Reads the first file from the list that can be opened on the calling thread.
+    static RefCntAutoPtr<IDataBlob> ReadFileSync(const std::vector<std::string>& CandidatePaths);
+
+    /// Returns the reader shared by the engine components.
+
+    /// When the render device is created with EngineCreateInfo::pAsyncTaskPool, the shared reader
+    /// schedules the reads onto that pool. Otherwise, its own threads are created on first use.
+    static AsyncFileReader& GetSharedInstance();
+
+private:
+    // Registers a new read and returns the pool to schedule it onto
+    RefCntAutoPtr<IThreadPool> BeginRead();
+    void                       EndRead();
+
+    std::mutex                 m_Mtx;
+    std::condition_variable    m_ReadsCompletedCV;
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+    Uint32                     m_NumPendingReads = 0;
+};
+
+} // namespace Diligent
@@ -54,6 +54,14 @@
 
 #include "HashUtils.hpp"
 
+/// Define DILIGENT_BASIC_MATH_SIMD to 1 to enable SSE2/NEON implementations of float4x4
+/// multiplication and inverse, float4-float4x4 transforms and quaternion multiplication.
+/// The macro must be set consistently for all translation units, e.g. as a compile definition.
+/// The memory layout of the types is not affected.
+#if DILIGENT_BASIC_MATH_SIMD
+#    include "BasicMathSIMD.hpp"
+#endif
+
 #ifdef _MSC_VER
 #    pragma warning(push)
 #    pragma warning(disable : 4201) // nonstandard extension used: nameless struct/union
@@ -1899,6 +1907,43 @@ using float4x4 = Matrix4x4<float>;
 using float3x3 = Matrix3x3<float>;
 using float2x2 = Matrix2x2<float>;
 
+
+#if DILIGENT_BASIC_MATH_SIMD && (DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON)
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Mul(const Matrix4x4<float>& m1, const Matrix4x4<float>& m2)
+{
+    Matrix4x4<float> mOut;
+    BasicMathSIMD::MulMatMat(m1.Data(), m2.Data(), mOut.Data());
+    return mOut;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::Inverse() const
+{
+    Matrix4x4<float> inv;
+    BasicMathSIMD::InverseMat(Data(), inv.Data());
+    return inv;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(const Matrix4x4<float>& m) const
+{
+    Vector4<float> out;
+    BasicMathSIMD::Store(out.Data(), BasicMathSIMD::MulVecMat(Data(), m.Data()));
+    return out;
+}
+
+template <>
+inline Vector4<float> operator*(const Matrix4x4<float>& m, const Vector4<float>& v)
+{
+    Vector4<float> out;
+    BasicMathSIMD::Store(out.Data(), BasicMathSIMD::MulMatVec(m.Data(), v.Data()));
+    return out;
+}
+
+#endif
+
 using double4x4 = Matrix4x4<double>;
 using double3x3 = Matrix3x3<double>;
 using double2x2 = Matrix2x2<double>;
@@ -1987,10 +2032,14 @@ struct Quaternion
     static Quaternion Mul(const Quaternion& q1, const Quaternion& q2)
     {
         Quaternion q1_q2;
+#if DILIGENT_BASIC_MATH_SIMD && (DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON)
+        BasicMathSIMD::Store(q1_q2.q.Data(), BasicMathSIMD::MulQuat(q1.q.Data(), q2.q.Data()));
+#else
         q1_q2.q.x = +q1.q.x * q2.q.w + q1.q.y * q2.q.z - q1.q.z * q2.q.y + q1.q.w * q2.q.x;
         q1_q2.q.y = -q1.q.x * q2.q.z + q1.q.y * q2.q.w + q1.q.z * q2.q.x + q1.q.w * q2.q.y;
         q1_q2.q.z = +q1.q.x * q2.q.y - q1.q.y * q2.q.x + q1.q.z * q2.q.w + q1.q.w * q2.q.z;
         q1_q2.q.w = -q1.q.x * q2.q.x - q1.q.y * q2.q.y - q1.q.z * q2.q.z + q1.q.w * q2.q.w;
+#endif
         return q1_q2;
     }
 
@@ -0,0 +1,324 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// SSE2/NEON kernels for 4x4 float matrices, 4-component vectors and quaternions,
+/// and the 4-wide float primitives they are built from.
+///
+/// Matrices are row-major and vectors are 4 contiguous floats, which matches the layout of
+/// float4x4, float4 and Quaternion. Multiplications sum the products in the same order as
+/// the scalar code in BasicMath.hpp. Inverse uses block-wise 2x2 adjugates and differs
+/// from the scalar version within the floating-point rounding error.
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define DILIGENT_BASIC_MATH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define DILIGENT_BASIC_MATH_NEON 1
+#endif
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+
+namespace Diligent
+{
+
+namespace BasicMathSIMD
+{
+
+#if DILIGENT_BASIC_MATH_SSE2
+
+using VecType = __m128;
+
+inline VecType Load(const float* p) { return _mm_loadu_ps(p); }
+inline void    Store(float* p, VecType v) { _mm_storeu_ps(p, v); }
+inline VecType Set1(float s) { return _mm_set1_ps(s); }
+inline VecType Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline VecType Add(VecType a, VecType b) { return _mm_add_ps(a, b); }
+inline VecType Sub(VecType a, VecType b) { return _mm_sub_ps(a, b); }
+inline VecType Mul(VecType a, VecType b) { return _mm_mul_ps(a, b); }
+inline VecType Div(VecType a, VecType b) { return _mm_div_ps(a, b); }
+inline VecType Min(VecType a, VecType b) { return _mm_min_ps(a, b); }
+inline VecType Max(VecType a, VecType b) { return _mm_max_ps(a, b); }
+
+// Comparisons return a mask with all bits set in the lanes where the condition holds
+inline VecType CmpLT(VecType a, VecType b) { return _mm_cmplt_ps(a, b); }
+inline VecType CmpGE(VecType a, VecType b) { return _mm_cmpge_ps(a, b); }
+
+// Returns Mask ? a : b in every lane
+inline VecType Select(VecType Mask, VecType a, VecType b) { return _mm_or_ps(_mm_and_ps(Mask, a), _mm_andnot_ps(Mask, b)); }
+
+// Rounds towards zero; the values must be in the Int32 range
+inline VecType Trunc(VecType v) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(v)); }
+inline void    StoreInt(Int32* p, VecType v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v)); }
+
+// Returns {a[x], a[y], b[z], b[w]}
+template <int x, int y, int z, int w>
+VecType Shuffle(VecType a, VecType b)
+{
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+}
+
+// Returns the columns of the 4x4 row-major matrix m
+inline void LoadColumns(const float* m, VecType& c0, VecType& c1, VecType& c2, VecType& c3)
+{
+    c0 = Load(m + 0);
+    c1 = Load(m + 4);
+    c2 = Load(m + 8);
+    c3 = Load(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+}
+
+#elif DILIGENT_BASIC_MATH_NEON
+
+using VecType = float32x4_t;
+
+inline VecType Load(const float* p) { return vld1q_f32(p); }
+inline void    Store(float* p, VecType v) { vst1q_f32(p, v); }
+inline VecType Set1(float s) { return vdupq_n_f32(s); }
+inline VecType Set(float x, float y, float z, float w)
+{
+    const float v[] = {x, y, z, w};
+    return vld1q_f32(v);
+}
+inline VecType Add(VecType a, VecType b) { return vaddq_f32(a, b); }
+inline VecType Sub(VecType a, VecType b) { return vsubq_f32(a, b); }
+inline VecType Mul(VecType a, VecType b) { return vmulq_f32(a, b); }
+inline VecType Div(VecType a, VecType b)
+{
+#    if defined(__aarch64__) || defined(_M_ARM64)
+    return vdivq_f32(a, b);
+#    else
+    // Two Newton-Raphson refinement steps of the reciprocal estimate
+    VecType r = vrecpeq_f32(b);
+    r         = vmulq_f32(vrecpsq_f32(b, r), r);
+    r         = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+#    endif
+}
+inline VecType Min(VecType a, VecType b) { return vminq_f32(a, b); }
+inline VecType Max(VecType a, VecType b) { return vmaxq_f32(a, b); }
+
+// Comparisons return a mask with all bits set in the lanes where the condition holds
+inline VecType CmpLT(VecType a, VecType b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline VecType CmpGE(VecType a, VecType b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+
+// Returns Mask ? a : b in every lane
+inline VecType Select(VecType Mask, VecType a, VecType b) { return vbslq_f32(vreinterpretq_u32_f32(Mask), a, b); }
+
+// Rounds towards zero; the values must be in the Int32 range
+inline VecType Trunc(VecType v) { return vcvtq_f32_s32(vcvtq_s32_f32(v)); }
+inline void    StoreInt(Int32* p, VecType v) { vst1q_s32(p, vcvtq_s32_f32(v)); }
+
+// Returns {a[x], a[y], b[z], b[w]}
+template <int x, int y, int z, int w>
+VecType Shuffle(VecType a, VecType b)
+{
+    VecType r = vdupq_n_f32(vgetq_lane_f32(a, x));
+    r         = vsetq_lane_f32(vgetq_lane_f32(a, y), r, 1);
+    r         = vsetq_lane_f32(vgetq_lane_f32(b, z), r, 2);
+    r         = vsetq_lane_f32(vgetq_lane_f32(b, w), r, 3);
+    return r;
+}
+
+// Returns the columns of the 4x4 row-major matrix m
+inline void LoadColumns(const float* m, VecType& c0, VecType& c1, VecType& c2, VecType& c3)
+{
+    const float32x4x4_t Cols = vld4q_f32(m);
+
+    c0 = Cols.val[0];
+    c1 = Cols.val[1];
+    c2 = Cols.val[2];
+    c3 = Cols.val[3];
+}
+
+#endif
+
+template <int x, int y, int z, int w>
+VecType Swizzle(VecType v)
+{
+    return Shuffle<x, y, z, w>(v, v);
+}
+
+// Rounds towards negative infinity; the values must be in the Int32 range
+inline VecType Floor(VecType v)
+{
+    const VecType t = Trunc(v);
+    return Sub(t, Select(CmpLT(v, t), Set1(1.f), Set1(0.f)));
+}
+
+template <int i>
+VecType Splat(VecType v)
+{
+    return Shuffle<i, i, i, i>(v, v);
+}
+
+// Computes v * m, where v is a row-vector and m is a 4x4 row-major matrix
+inline VecType MulVecMat(const float* v, const float* m)
+{
+    VecType r = Mul(Set1(v[0]), Load(m + 0));
+    r         = Add(r, Mul(Set1(v[1]), Load(m + 4)));
+    r         = Add(r, Mul(Set1(v[2]), Load(m + 8)));
+    r         = Add(r, Mul(Set1(v[3]), Load(m + 12)));
+    return r;
+}
+
+// Computes m * v, where v is a column-vector and m is a 4x4 row-major matrix
+inline VecType MulMatVec(const float* m, const float* v)
+{
+    VecType c0, c1, c2, c3;
+    LoadColumns(m, c0, c1, c2, c3);
+
+    VecType r = Mul(c0, Set1(v[0]));
+    r         = Add(r, Mul(c1, Set1(v[1])));
+    r         = Add(r, Mul(c2, Set1(v[2])));
+    r         = Add(r, Mul(c3, Set1(v[3])));
+    return r;
+}
+
+// Computes m1 * m2 and writes the result to out
+inline void MulMatMat(const float* m1, const float* m2, float* out)
+{
+    const VecType r0 = Load(m2 + 0);
+    const VecType r1 = Load(m2 + 4);
+    const VecType r2 = Load(m2 + 8);
+    const VecType r3 = Load(m2 + 12);
+    for (int i = 0; i < 4; ++i)
+    {
+        const float* row = m1 + i * 4;
+
+        VecType r = Mul(Set1(row[0]), r0);
+        r         = Add(r, Mul(Set1(row[1]), r1));
+        r         = Add(r, Mul(Set1(row[2]), r2));
+        r         = Add(r, Mul(Set1(row[3]), r3));
+        Store(out + i * 4, r);
+    }
+}
+
+// 2x2 row-major matrices packed as {_11, _12, _21, _22}
+
+// A * B
+inline VecType Mat2Mul(VecType A, VecType B)
+{
+    return Add(Mul(A, Swizzle<0, 3, 0, 3>(B)),
+               Mul(Swizzle<1, 0, 3, 2>(A), Swizzle<2, 1, 2, 1>(B)));
+}
+
+// adj(A) * B
+inline VecType Mat2AdjMul(VecType A, VecType B)
+{
+    return Sub(Mul(Swizzle<3, 3, 0, 0>(A), B),
+               Mul(Swizzle<1, 1, 2, 2>(A), Swizzle<2, 3, 0, 1>(B)));
+}
+
+// A * adj(B)
+inline VecType Mat2MulAdj(VecType A, VecType B)
+{
+    return Sub(Mul(A, Swizzle<3, 0, 3, 0>(B)),
+               Mul(Swizzle<1, 0, 3, 2>(A), Swizzle<2, 1, 2, 1>(B)));
+}
+
+// Computes the inverse of the 4x4 row-major matrix m using the block-wise formula
+//
+//      | A  B |-1            | X  Y |
+//  M = |      |     = 1/|M| *|      |
+//      | C  D |              | Z  W |
+//
+inline void InverseMat(const float* m, float* out)
+{
+    const VecType r0 = Load(m + 0);
+    const VecType r1 = Load(m + 4);
+    const VecType r2 = Load(m + 8);
+    const VecType r3 = Load(m + 12);
+
+    const VecType A = Shuffle<0, 1, 0, 1>(r0, r1);
+    const VecType B = Shuffle<2, 3, 2, 3>(r0, r1);
+    const VecType C = Shuffle<0, 1, 0, 1>(r2, r3);
+    const VecType D = Shuffle<2, 3, 2, 3>(r2, r3);
+
+    // {|A|, |B|, |C|, |D|}
+    const VecType DetSub = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+                               Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+
+    const VecType DetA = Splat<0>(DetSub);
+    const VecType DetB = Splat<1>(DetSub);
+    const VecType DetC = Splat<2>(DetSub);
+    const VecType DetD = Splat<3>(DetSub);
+
+    const VecType D_C = Mat2AdjMul(D, C);
+    const VecType A_B = Mat2AdjMul(A, B);
+
+    // adj(X) = |D|A - B(adj(D)C)
+    VecType X_ = Sub(Mul(DetD, A), Mat2Mul(B, D_C));
+    // adj(W) = |A|D - C(adj(A)B)
+    VecType W_ = Sub(Mul(DetA, D), Mat2Mul(C, A_B));
+    // adj(Y) = |B|C - D adj(adj(A)B)
+    VecType Y_ = Sub(Mul(DetB, C), Mat2MulAdj(D, A_B));
+    // adj(Z) = |C|B - A adj(adj(D)C)
+    VecType Z_ = Sub(Mul(DetC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+    VecType Tr = Mul(A_B, Swizzle<0, 2, 1, 3>(D_C));
+    Tr         = Add(Tr, Swizzle<1, 0, 3, 2>(Tr));
+    Tr         = Add(Tr, Swizzle<2, 3, 0, 1>(Tr));
+
+    const VecType DetM  = Sub(Add(Mul(DetA, DetD), Mul(DetB, DetC)), Tr);
+    const VecType RDetM = Div(Set(1.f, -1.f, -1.f, 1.f), DetM);
+
+    X_ = Mul(X_, RDetM);
+    Y_ = Mul(Y_, RDetM);
+    Z_ = Mul(Z_, RDetM);
+    W_ = Mul(W_, RDetM);
+
+    // Apply the final adjugate shuffle
+    Store(out + 0, Shuffle<3, 1, 3, 1>(X_, Y_));
+    Store(out + 4, Shuffle<2, 0, 2, 0>(X_, Y_));
+    Store(out + 8, Shuffle<3, 1, 3, 1>(Z_, W_));
+    Store(out + 12, Shuffle<2, 0, 2, 0>(Z_, W_));
+}
+
+// Computes the Hamilton product q1 * q2 of quaternions stored as {x, y, z, w}
+inline VecType MulQuat(const float* q1, const float* q2)
+{
+    const VecType Q2 = Load(q2);
+
+    VecType r = Mul(Set1(q1[0]), Mul(Swizzle<3, 2, 1, 0>(Q2), Set(+1.f, -1.f, +1.f, -1.f)));
+    r         = Add(r, Mul(Set1(q1[1]), Mul(Swizzle<2, 3, 0, 1>(Q2), Set(+1.f, +1.f, -1.f, -1.f))));
+    r         = Add(r, Mul(Set1(q1[2]), Mul(Swizzle<1, 0, 3, 2>(Q2), Set(-1.f, +1.f, +1.f, -1.f))));
+    r         = Add(r, Mul(Set1(q1[3]), Q2));
+    return r;
+}
+
+} // namespace BasicMathSIMD
+
+} // namespace Diligent
+
+#endif
@@ -30,6 +30,11 @@
 /// \file
 /// Defines Diligent::DefaultRawMemoryAllocator class
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+
 #include "../../Primitives/interface/MemoryAllocator.h"
 
 namespace Diligent
@@ -48,11 +53,66 @@ public:
 
     static DefaultRawMemoryAllocator& GetAllocator();
 
+    /// Allocation statistics collected while tracking is enabled
+    struct AllocationStats
+    {
+        Uint64 NumAllocations = 0;
+        Uint64 NumFrees       = 0;
+        Uint64 BytesAllocated = 0;
+    };
+
+    /// Call site of a recorded allocation
+    struct AllocationCallSite
+    {
+        size_t      Size = 0;
+        std::string Description;
+        std::string FileName;
+        Int32       LineNumber = 0;
+    };
+
+    /// Enables or disables allocation tracking.
+
+    /// When tracking is disabled, the only overhead is a relaxed load of the tracking flag.
+    /// Tracking is intended for verifying that the steady-state frame loop performs no allocations:
+    /// enable it after warm-up and call ResetTrackingPeriod() at every frame boundary.
+    void EnableTracking(bool Enable);
+
+    bool IsTrackingEnabled() const { return m_TrackingEnabled.load(std::memory_order_relaxed); }
+
+    /// Returns the statistics collected since the last ResetTrackingPeriod() call.
+    AllocationStats GetTrackingStats() const;
+
+    /// Starts a new tracking period (e.g. a frame) and returns the statistics of the previous one.
+    /// Recorded call sites are not cleared.
+    AllocationStats ResetTrackingPeriod();
+
+    /// Sets the number of allocations within a tracking period after which the allocator
+    /// records call sites of all subsequent allocations in the same period.
+    /// The default value is 0, i.e. every tracked allocation is recorded.
+    void SetCallSiteRecordThreshold(Uint32 Threshold);
+
+    /// Returns the recorded allocation call sites and clears the list.
+    std::vector<AllocationCallSite> TakeRecordedCallSites();
+
+    /// The maximum number of call sites the allocator keeps.
+    static constexpr size_t MaxRecordedCallSites = 256;
+
 private:
+    void TrackAllocation(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber);
+
     DefaultRawMemoryAllocator(const DefaultRawMemoryAllocator&) = delete;
     DefaultRawMemoryAllocator(DefaultRawMemoryAllocator&&)      = delete;
     DefaultRawMemoryAllocator& operator=(const DefaultRawMemoryAllocator&) = delete;
     DefaultRawMemoryAllocator& operator=(DefaultRawMemoryAllocator&&) = delete;
+
+    std::atomic<bool>   m_TrackingEnabled{false};
+    std::atomic<Uint64> m_NumAllocations{0};
+    std::atomic<Uint64> m_NumFrees{0};
+    std::atomic<Uint64> m_BytesAllocated{0};
+    std::atomic<Uint32> m_CallSiteRecordThreshold{0};
+
+    std::mutex                      m_CallSitesMtx;
+    std::vector<AllocationCallSite> m_CallSites;
 };
 
 } // namespace Diligent
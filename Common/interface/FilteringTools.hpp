@@ -30,6 +30,7 @@
 #include "../../Platforms/interface/PlatformDefinitions.h"
 
 #include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
 
 #include "../../Graphics/GraphicsEngine/interface/Sampler.h"
 
@@ -157,6 +158,95 @@ LinearTexFilterSampleInfo GetLinearTexFilterSampleInfo(Uint32 Width, float u)
     return SampleInfo;
 }
 
+/// Computes linear texture filter sample infos for four coordinates at once.
+///
+/// The results are identical to GetLinearTexFilterSampleInfo(), but are written in SoA form.
+/// With SSE2/NEON, the address computations are performed in floating-point arithmetic and are
+/// exact as long as the absolute texel coordinate is less than 2^22.
+///
+/// \param [in]  Width - Texture width.
+/// \param [in]  u     - Four texture sample coordinates.
+/// \param [out] i0    - Four first sample indices.
+/// \param [out] i1    - Four second sample indices.
+/// \param [out] w     - Four blend weights.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void GetLinearTexFilterSampleInfo4(Uint32 Width, const float* u, Int32* i0, Int32* i1, float* w)
+{
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+    using namespace BasicMathSIMD;
+
+    const VecType fWidth = Set1(static_cast<float>(Width));
+    const VecType Zero   = Set1(0.f);
+    const VecType One    = Set1(1.f);
+
+    VecType x = Load(u);
+    if (IsNormalizedCoord)
+        x = Mul(x, fWidth);
+    x = Sub(x, Set1(0.5f));
+
+    VecType x0 = Floor(x);
+    Store(w, Sub(x, x0));
+    VecType x1 = Add(x0, One);
+
+    auto WrapCoord = [&](VecType i, VecType W) //
+    {
+        // The quotient may be rounded up, so the remainder is corrected by one period
+        i = Sub(i, Mul(Floor(Div(i, W)), W));
+        i = Select(CmpLT(i, Zero), Add(i, W), i);
+        return Select(CmpGE(i, W), Sub(i, W), i);
+    };
+
+    auto MirrorCoord = [&](VecType i) //
+    {
+        const VecType Width2 = Add(fWidth, fWidth);
+
+        i = WrapCoord(i, Width2);
+        return Select(CmpGE(i, fWidth), Sub(Sub(Width2, One), i), i);
+    };
+
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_UNKNOWN:
+            // do nothing
+            break;
+
+        case TEXTURE_ADDRESS_WRAP:
+            x0 = WrapCoord(x0, fWidth);
+            x1 = WrapCoord(x1, fWidth);
+            break;
+
+        case TEXTURE_ADDRESS_MIRROR:
+            x0 = MirrorCoord(x0);
+            x1 = MirrorCoord(x1);
+            break;
+
+        case TEXTURE_ADDRESS_CLAMP:
+        {
+            const VecType MaxCoord = Sub(fWidth, One);
+
+            x0 = Min(Max(x0, Zero), MaxCoord);
+            x1 = Min(Max(x1, Zero), MaxCoord);
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected texture address mode");
+    }
+
+    StoreInt(i0, x0);
+    StoreInt(i1, x1);
+#else
+    for (size_t k = 0; k < 4; ++k)
+    {
+        const auto SampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, u[k]);
+
+        i0[k] = SampleInfo.i0;
+        i1[k] = SampleInfo.i1;
+        w[k]  = SampleInfo.w;
+    }
+#endif
+}
+
 #ifdef DILIGENT_DEBUG
 template <TEXTURE_ADDRESS_MODE AddressMode>
 void _DbgVerifyFilterInfo(const LinearTexFilterSampleInfo& FilterInfo, Uint32 Width, const char* Direction, float u)
@@ -217,6 +307,112 @@ DstType FilterTexture2DBilinear(Uint32         Width,
     return lerp(lerp(S00, S10, UFilterInfo.w), lerp(S01, S11, UFilterInfo.w), VFilterInfo.w);
 }
 
+/// Blends four bilinear samples per lane: lerp(lerp(S00, S10, wu), lerp(S01, S11, wu), wv).
+template <typename DstType>
+void _BlendBilinearSamples4(const DstType* S00,
+                            const DstType* S10,
+                            const DstType* S01,
+                            const DstType* S11,
+                            const float*   wu,
+                            const float*   wv,
+                            DstType*       pDst)
+{
+    for (size_t k = 0; k < 4; ++k)
+        pDst[k] = lerp(lerp(S00[k], S10[k], wu[k]), lerp(S01[k], S11[k], wu[k]), wv[k]);
+}
+
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+template <>
+inline void _BlendBilinearSamples4<float>(const float* S00,
+                                          const float* S10,
+                                          const float* S01,
+                                          const float* S11,
+                                          const float* wu,
+                                          const float* wv,
+                                          float*       pDst)
+{
+    using namespace BasicMathSIMD;
+
+    const VecType One = Set1(1.f);
+    const VecType Wu  = Load(wu);
+    const VecType Wv  = Load(wv);
+    const VecType Wu1 = Sub(One, Wu);
+
+    const VecType S0 = Add(Mul(Load(S00), Wu1), Mul(Load(S10), Wu));
+    const VecType S1 = Add(Mul(Load(S01), Wu1), Mul(Load(S11), Wu));
+    Store(pDst, Add(Mul(S0, Sub(One, Wv)), Mul(S1, Wv)));
+}
+#endif
+
+/// Samples 2D texture at multiple locations using bilinear filter.
+///
+/// The function produces the same results as calling FilterTexture2DBilinear() for every sample,
+/// but computes the sample indices and weights for four samples at a time, see GetLinearTexFilterSampleInfo4().
+/// When DstType is float, the samples are also blended four at a time.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pU           - Array of NumSamples u coordinates.
+/// \param [in]  pV           - Array of NumSamples v coordinates.
+/// \param [in]  NumSamples   - Number of samples.
+/// \param [out] pDst         - Array of NumSamples filtered texture samples.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinearBatch(Uint32         Width,
+                                  Uint32         Height,
+                                  const SrcType* pData,
+                                  size_t         Stride,
+                                  const float*   pU,
+                                  const float*   pV,
+                                  size_t         NumSamples,
+                                  DstType*       pDst)
+{
+    size_t s = 0;
+    for (; s + 4 <= NumSamples; s += 4)
+    {
+        Int32 u0[4], u1[4], v0[4], v1[4];
+        float wu[4], wv[4];
+        GetLinearTexFilterSampleInfo4<AddressModeU, IsNormalizedCoord>(Width, pU + s, u0, u1, wu);
+        GetLinearTexFilterSampleInfo4<AddressModeV, IsNormalizedCoord>(Height, pV + s, v0, v1, wv);
+
+        DstType S00[4], S10[4], S01[4], S11[4];
+        for (size_t k = 0; k < 4; ++k)
+        {
+#ifdef DILIGENT_DEBUG
+            {
+                _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{u0[k], u1[k], wu[k]}, Width, "horizontal", pU[s + k]);
+                _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{v0[k], v1[k], wv[k]}, Height, "vertical", pV[s + k]);
+            }
+#endif
+            const SrcType* pRow0 = pData + v0[k] * Stride;
+            const SrcType* pRow1 = pData + v1[k] * Stride;
+
+            S00[k] = static_cast<DstType>(pRow0[u0[k]]);
+            S10[k] = static_cast<DstType>(pRow0[u1[k]]);
+            S01[k] = static_cast<DstType>(pRow1[u0[k]]);
+            S11[k] = static_cast<DstType>(pRow1[u1[k]]);
+        }
+
+        _BlendBilinearSamples4(S00, S10, S01, S11, wu, wv, pDst + s);
+    }
+
+    for (; s < NumSamples; ++s)
+    {
+        pDst[s] = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, IsNormalizedCoord>(Width, Height, pData, Stride, pU[s], pV[s]);
+    }
+}
+
 /// Specialization of FilterTexture2DBilinear function that uses CLAMP texture address mode
 /// and takes normalized texture coordinates.
 template <typename SrcType, typename DstType>
@@ -30,6 +30,7 @@
 /// \file
 /// Declaration of Diligent::FixedBlockMemoryAllocator class
 
+#include <array>
 #include <unordered_map>
 #include <mutex>
 #include <unordered_set>
@@ -53,9 +54,20 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 #endif
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// Every thread is assigned one of NumMagazines magazines, a small cache of free blocks.
+/// Allocate() and Free() only lock the thread's magazine, which is uncontended unless more
+/// than NumMagazines threads use the allocator simultaneously. The shared page pool is
+/// only locked when a magazine runs empty or overflows, and then blocks are moved in batches.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
+    /// The number of magazines that threads are distributed across.
+    static constexpr Uint32 NumMagazines = 16;
+
+    /// The maximum number of free blocks a single magazine can hold.
+    static constexpr Uint32 MagazineSize = 32;
+
     FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
     ~FixedBlockMemoryAllocator();
 
@@ -65,6 +77,15 @@ public:
     /// Releases memory
     virtual void Free(void* Ptr) override final;
 
+    /// Returns the number of blocks that are currently allocated and the total number of blocks in all pages.
+
+    /// Blocks cached in the thread magazines are counted as free. If other threads allocate or release
+    /// blocks at the same time, the statistics are approximate.
+    void GetStatistics(Uint32& NumAllocatedBlocks, Uint32& NumReservedBlocks);
+
+    /// Returns the size of a block, in bytes.
+    size_t GetBlockSize() const { return m_BlockSize; }
+
 private:
     // clang-format off
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
@@ -75,6 +96,26 @@ private:
 
     void CreateNewPage();
 
+    struct Magazine
+    {
+        std::mutex Mtx;
+        Uint32     NumBlocks = 0;
+        void*      Blocks[MagazineSize];
+    };
+
+    static Uint32 GetThreadMagazineIndex();
+
+    // Moves up to m_MagazineRefillSize blocks from the pages to the magazine.
+    // Must be called with the magazine locked.
+    void RefillMagazine(Magazine& Mag);
+
+    // Returns NumBlocks blocks from the bottom of the magazine to the pages.
+    // Must be called with the magazine locked.
+    void FlushMagazine(Magazine& Mag, Uint32 NumBlocks);
+
+    void* AllocateFromPages();
+    void  FreeToPages(void* Ptr);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -205,8 +246,9 @@ private:
             ++m_NumFreeBlocks;
         }
 
-        bool HasSpace() const { return m_NumFreeBlocks > 0; }
-        bool HasAllocations() const { return m_NumFreeBlocks < m_NumInitializedBlocks; }
+        bool   HasSpace() const { return m_NumFreeBlocks > 0; }
+        Uint32 GetNumFreeBlocks() const { return m_NumFreeBlocks; }
+        bool   HasAllocations() const { return m_NumFreeBlocks < m_NumInitializedBlocks; }
 
     private:
         MemoryPage(const MemoryPage&) = delete;
@@ -226,11 +268,15 @@ private:
     using AddrToPageIdMapElem = std::pair<void* const, size_t>;
     std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
 
+    // Protects the pages
     std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_MagazineRefillSize;
+
+    std::array<Magazine, NumMagazines> m_Magazines;
 };
 
 IMemoryAllocator& GetRawAllocator();
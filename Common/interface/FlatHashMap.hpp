@@ -0,0 +1,504 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::FlatHashMap class
+
+#include <memory>
+#include <utility>
+#include <functional>
+#include <iterator>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Open-addressing hash map that stores all elements in a single flat array.
+
+/// The map uses linear probing and keeps one control byte per slot that holds
+/// 7 bits of the element hash, so most non-matching slots are rejected without
+/// comparing the keys. Erased slots are marked as deleted and are reclaimed when
+/// the table is rehashed.
+///
+/// The interface follows std::unordered_map, with the following differences:
+/// - Insertion may rehash the table, which invalidates all iterators, pointers
+///   and references to the elements.
+/// - Erasing an element only invalidates iterators, pointers and references to
+///   that element, and never rehashes the table.
+/// - emplace() takes the key and the value constructor arguments separately.
+///
+/// \tparam KeyType       - Key type.
+/// \tparam ValueType     - Mapped value type.
+/// \tparam HasherType    - Key hash function.
+/// \tparam KeyEqualType  - Key comparison function.
+/// \tparam AllocatorType - STL-compatible allocator, e.g. STDAllocatorRawMem. It is
+///                         rebound to allocate the table memory as raw bytes.
+template <typename KeyType,
+          typename ValueType,
+          typename HasherType    = std::hash<KeyType>,
+          typename KeyEqualType  = std::equal_to<KeyType>,
+          typename AllocatorType = std::allocator<std::pair<const KeyType, ValueType>>>
+class FlatHashMap
+{
+public:
+    using key_type        = KeyType;
+    using mapped_type     = ValueType;
+    using value_type      = std::pair<const KeyType, ValueType>;
+    using size_type       = size_t;
+    using hasher          = HasherType;
+    using key_equal       = KeyEqualType;
+    using allocator_type  = AllocatorType;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    static_assert(alignof(value_type) <= alignof(std::max_align_t), "Over-aligned value types are not supported");
+
+private:
+    template <bool IsConst>
+    class IteratorBase
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename FlatHashMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = typename std::conditional<IsConst, const value_type*, value_type*>::type;
+        using reference         = typename std::conditional<IsConst, const value_type&, value_type&>::type;
+
+        IteratorBase() noexcept {}
+
+        // Allows iterator -> const_iterator conversion
+        template <bool _IsConst = IsConst, typename = typename std::enable_if<_IsConst>::type>
+        IteratorBase(const IteratorBase<false>& It) noexcept :
+            m_pCtrl{It.m_pCtrl},
+            m_pSlots{It.m_pSlots},
+            m_Idx{It.m_Idx},
+            m_Capacity{It.m_Capacity}
+        {}
+
+        reference operator*() const
+        {
+            VERIFY_EXPR(m_Idx < m_Capacity && IsFull(m_pCtrl[m_Idx]));
+            return m_pSlots[m_Idx];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        IteratorBase& operator++()
+        {
+            VERIFY(m_Idx < m_Capacity, "Incrementing end iterator");
+            m_Idx = SkipEmptySlots(m_pCtrl, m_Idx + 1, m_Capacity);
+            return *this;
+        }
+
+        IteratorBase operator++(int)
+        {
+            auto Tmp = *this;
+            ++(*this);
+            return Tmp;
+        }
+
+        bool operator==(const IteratorBase& rhs) const { return m_Idx == rhs.m_Idx; }
+        bool operator!=(const IteratorBase& rhs) const { return m_Idx != rhs.m_Idx; }
+
+    private:
+        friend class FlatHashMap;
+        friend class IteratorBase<!IsConst>;
+
+        using SlotType = typename std::conditional<IsConst, const value_type, value_type>::type;
+
+        IteratorBase(const Uint8* pCtrl, SlotType* pSlots, size_t Idx, size_t Capacity) noexcept :
+            m_pCtrl{pCtrl},
+            m_pSlots{pSlots},
+            m_Idx{Idx},
+            m_Capacity{Capacity}
+        {}
+
+        const Uint8* m_pCtrl    = nullptr;
+        SlotType*    m_pSlots   = nullptr;
+        size_t       m_Idx      = 0;
+        size_t       m_Capacity = 0;
+    };
+
+public:
+    using iterator       = IteratorBase<false>;
+    using const_iterator = IteratorBase<true>;
+
+    explicit FlatHashMap(const AllocatorType& Allocator = AllocatorType{}) :
+        m_Allocator{Allocator}
+    {}
+
+    FlatHashMap(size_t InitialCapacity, const AllocatorType& Allocator = AllocatorType{}) :
+        m_Allocator{Allocator}
+    {
+        reserve(InitialCapacity);
+    }
+
+    FlatHashMap(FlatHashMap&& rhs) noexcept :
+        // clang-format off
+        m_Allocator  {std::move(rhs.m_Allocator)},
+        m_pCtrl      {rhs.m_pCtrl      },
+        m_pSlots     {rhs.m_pSlots     },
+        m_Capacity   {rhs.m_Capacity   },
+        m_Size       {rhs.m_Size       },
+        m_NumDeleted {rhs.m_NumDeleted }
+    // clang-format on
+    {
+        rhs.m_pCtrl      = nullptr;
+        rhs.m_pSlots     = nullptr;
+        rhs.m_Capacity   = 0;
+        rhs.m_Size       = 0;
+        rhs.m_NumDeleted = 0;
+    }
+
+    // clang-format off
+    FlatHashMap           (const FlatHashMap&)  = delete;
+    FlatHashMap& operator=(const FlatHashMap&)  = delete;
+    FlatHashMap& operator=(      FlatHashMap&&) = delete;
+    // clang-format on
+
+    ~FlatHashMap()
+    {
+        clear();
+        FreeTable();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{m_pCtrl, m_pSlots, SkipEmptySlots(m_pCtrl, 0, m_Capacity), m_Capacity};
+    }
+    iterator end() noexcept
+    {
+        return iterator{m_pCtrl, m_pSlots, m_Capacity, m_Capacity};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{m_pCtrl, m_pSlots, SkipEmptySlots(m_pCtrl, 0, m_Capacity), m_Capacity};
+    }
+    const_iterator end() const noexcept
+    {
+        return const_iterator{m_pCtrl, m_pSlots, m_Capacity, m_Capacity};
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool   empty() const noexcept { return m_Size == 0; }
+    size_t size() const noexcept { return m_Size; }
+
+    /// Returns the number of slots in the table
+    size_t capacity() const noexcept { return m_Capacity; }
+
+    /// Destroys all elements, but keeps the table memory
+    void clear() noexcept
+    {
+        if (m_Size == 0 && m_NumDeleted == 0)
+            return;
+
+        for (size_t i = 0; i < m_Capacity; ++i)
+        {
+            if (IsFull(m_pCtrl[i]))
+                m_pSlots[i].~value_type();
+        }
+        memset(m_pCtrl, CtrlEmpty, m_Capacity);
+        m_Size       = 0;
+        m_NumDeleted = 0;
+    }
+
+    /// Makes sure that the map can hold at least Count elements without rehashing
+    void reserve(size_t Count)
+    {
+        size_t NewCapacity = size_t{MinCapacity};
+        while (!IsWithinLoadFactor(Count, NewCapacity))
+            NewCapacity *= 2;
+
+        if (NewCapacity > m_Capacity || (m_NumDeleted > 0 && !IsWithinLoadFactor(m_Size + m_NumDeleted, m_Capacity)))
+            Rehash(std::max(NewCapacity, m_Capacity));
+    }
+
+    iterator find(const KeyType& Key)
+    {
+        const auto Idx = FindIndex(Key);
+        return iterator{m_pCtrl, m_pSlots, Idx != InvalidIndex ? Idx : m_Capacity, m_Capacity};
+    }
+
+    const_iterator find(const KeyType& Key) const
+    {
+        const auto Idx = FindIndex(Key);
+        return const_iterator{m_pCtrl, m_pSlots, Idx != InvalidIndex ? Idx : m_Capacity, m_Capacity};
+    }
+
+    size_t count(const KeyType& Key) const
+    {
+        return FindIndex(Key) != InvalidIndex ? 1 : 0;
+    }
+
+    /// Inserts a new element constructed from ValueArgs if there is no element with the given key.
+
+    /// \return     A pair consisting of an iterator to the element with the given key and
+    ///             a bool value that is true if the element was inserted.
+    template <typename KeyArgType, typename... ValueArgsType>
+    std::pair<iterator, bool> emplace(KeyArgType&& Key, ValueArgsType&&... ValueArgs)
+    {
+        const auto Hash = ComputeKeyHash(Key);
+
+        auto Idx = FindIndex(Key, Hash);
+        if (Idx != InvalidIndex)
+            return {iterator{m_pCtrl, m_pSlots, Idx, m_Capacity}, false};
+
+        Idx = PrepareInsert(Hash);
+        new (m_pSlots + Idx) value_type{std::piecewise_construct,
+                                        std::forward_as_tuple(std::forward<KeyArgType>(Key)),
+                                        std::forward_as_tuple(std::forward<ValueArgsType>(ValueArgs)...)};
+        CommitInsert(Idx, Hash);
+        return {iterator{m_pCtrl, m_pSlots, Idx, m_Capacity}, true};
+    }
+
+    std::pair<iterator, bool> insert(value_type&& Value)
+    {
+        return emplace(std::move(const_cast<KeyType&>(Value.first)), std::move(Value.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& Value)
+    {
+        return emplace(Value.first, Value.second);
+    }
+
+    ValueType& operator[](const KeyType& Key)
+    {
+        return emplace(Key).first->second;
+    }
+
+    /// Erases the element and returns the iterator to the next element
+    iterator erase(const_iterator It)
+    {
+        VERIFY(It.m_pCtrl == m_pCtrl && It.m_Idx < m_Capacity && IsFull(m_pCtrl[It.m_Idx]), "Invalid iterator");
+        EraseAt(It.m_Idx);
+        return iterator{m_pCtrl, m_pSlots, SkipEmptySlots(m_pCtrl, It.m_Idx + 1, m_Capacity), m_Capacity};
+    }
+
+    iterator erase(iterator It)
+    {
+        return erase(const_iterator{It});
+    }
+
+    size_t erase(const KeyType& Key)
+    {
+        const auto Idx = FindIndex(Key);
+        if (Idx == InvalidIndex)
+            return 0;
+
+        EraseAt(Idx);
+        return 1;
+    }
+
+private:
+    using ByteAllocatorType = typename std::allocator_traits<AllocatorType>::template rebind_alloc<Uint8>;
+
+    static constexpr Uint8  CtrlEmpty    = 0x80;
+    static constexpr Uint8  CtrlDeleted  = 0xFE;
+    static constexpr size_t MinCapacity  = 16;
+    static constexpr size_t InvalidIndex = ~size_t{0};
+
+    static bool IsFull(Uint8 Ctrl)
+    {
+        return (Ctrl & 0x80) == 0;
+    }
+
+    static size_t SkipEmptySlots(const Uint8* pCtrl, size_t Idx, size_t Capacity)
+    {
+        while (Idx < Capacity && !IsFull(pCtrl[Idx]))
+            ++Idx;
+        return Idx;
+    }
+
+    // The maximum load factor, including deleted slots, is 7/8
+    static bool IsWithinLoadFactor(size_t Count, size_t Capacity)
+    {
+        return Count * 8 <= Capacity * 7;
+    }
+
+    Uint64 ComputeKeyHash(const KeyType& Key) const
+    {
+        // std::hash is the identity function for integers in most implementations, so
+        // the hash is mixed to spread the bits used for the slot index and the control byte.
+        return WyHash::Mix(Uint64{HasherType{}(Key)} ^ WyHash::Secret0, WyHash::Secret1);
+    }
+
+    static Uint8 GetCtrlHash(Uint64 Hash)
+    {
+        return static_cast<Uint8>(Hash & 0x7F);
+    }
+
+    static size_t GetFirstSlot(Uint64 Hash, size_t Capacity)
+    {
+        return static_cast<size_t>(Hash >> 7) & (Capacity - 1);
+    }
+
+    size_t FindIndex(const KeyType& Key) const
+    {
+        return m_Size != 0 ? FindIndex(Key, ComputeKeyHash(Key)) : InvalidIndex;
+    }
+
+    size_t FindIndex(const KeyType& Key, Uint64 Hash) const
+    {
+        if (m_Capacity == 0)
+            return InvalidIndex;
+
+        const auto CtrlHash = GetCtrlHash(Hash);
+        const auto Mask     = m_Capacity - 1;
+        for (size_t Idx = GetFirstSlot(Hash, m_Capacity);; Idx = (Idx + 1) & Mask)
+        {
+            const auto Ctrl = m_pCtrl[Idx];
+            if (Ctrl == CtrlHash && KeyEqualType{}(m_pSlots[Idx].first, Key))
+                return Idx;
+            if (Ctrl == CtrlEmpty)
+                return InvalidIndex;
+            // The table always has at least one empty slot, so the loop terminates
+        }
+    }
+
+    // Returns the index of the slot where the element with the given hash should be constructed
+    size_t PrepareInsert(Uint64 Hash)
+    {
+        if (!IsWithinLoadFactor(m_Size + m_NumDeleted + 1, m_Capacity))
+        {
+            // Grow the table if it is mostly full, otherwise just purge deleted slots
+            Rehash(IsWithinLoadFactor((m_Size + 1) * 2, m_Capacity) ? m_Capacity : std::max(m_Capacity * 2, size_t{MinCapacity}));
+        }
+
+        const auto Mask = m_Capacity - 1;
+        auto       Idx  = GetFirstSlot(Hash, m_Capacity);
+        while (IsFull(m_pCtrl[Idx]))
+            Idx = (Idx + 1) & Mask;
+        return Idx;
+    }
+
+    void CommitInsert(size_t Idx, Uint64 Hash)
+    {
+        if (m_pCtrl[Idx] == CtrlDeleted)
+            --m_NumDeleted;
+        m_pCtrl[Idx] = GetCtrlHash(Hash);
+        ++m_Size;
+    }
+
+    void EraseAt(size_t Idx)
+    {
+        m_pSlots[Idx].~value_type();
+
+        // If the next slot is empty, no probe sequence passes through this slot,
+        // and it can be marked empty rather than deleted.
+        if (m_pCtrl[(Idx + 1) & (m_Capacity - 1)] == CtrlEmpty)
+        {
+            m_pCtrl[Idx] = CtrlEmpty;
+        }
+        else
+        {
+            m_pCtrl[Idx] = CtrlDeleted;
+            ++m_NumDeleted;
+        }
+        --m_Size;
+    }
+
+    static size_t GetSlotsOffset(size_t Capacity)
+    {
+        return (Capacity + alignof(value_type) - 1) & ~(alignof(value_type) - 1);
+    }
+
+    void Rehash(size_t NewCapacity)
+    {
+        VERIFY_EXPR((NewCapacity & (NewCapacity - 1)) == 0 && IsWithinLoadFactor(m_Size + 1, NewCapacity));
+
+        const auto SlotsOffset = GetSlotsOffset(NewCapacity);
+
+        ByteAllocatorType ByteAllocator{m_Allocator};
+
+        auto* pNewMemory = ByteAllocator.allocate(SlotsOffset + sizeof(value_type) * NewCapacity);
+        auto* pNewCtrl   = reinterpret_cast<Uint8*>(pNewMemory);
+        auto* pNewSlots  = reinterpret_cast<value_type*>(pNewMemory + SlotsOffset);
+        memset(pNewCtrl, CtrlEmpty, NewCapacity);
+
+        const auto Mask = NewCapacity - 1;
+        for (size_t i = 0; i < m_Capacity; ++i)
+        {
+            if (!IsFull(m_pCtrl[i]))
+                continue;
+
+            auto&      Slot = m_pSlots[i];
+            const auto Hash = ComputeKeyHash(Slot.first);
+
+            auto Idx = GetFirstSlot(Hash, NewCapacity);
+            while (pNewCtrl[Idx] != CtrlEmpty)
+                Idx = (Idx + 1) & Mask;
+
+            // Keys and values are expected not to throw when moved
+            new (pNewSlots + Idx) value_type{std::move(const_cast<KeyType&>(Slot.first)), std::move(Slot.second)};
+            Slot.~value_type();
+            pNewCtrl[Idx] = GetCtrlHash(Hash);
+        }
+
+        FreeTable();
+
+        m_pCtrl      = pNewCtrl;
+        m_pSlots     = pNewSlots;
+        m_Capacity   = NewCapacity;
+        m_NumDeleted = 0;
+    }
+
+    void FreeTable()
+    {
+        if (m_pCtrl == nullptr)
+            return;
+
+        ByteAllocatorType ByteAllocator{m_Allocator};
+        ByteAllocator.deallocate(m_pCtrl, GetSlotsOffset(m_Capacity) + sizeof(value_type) * m_Capacity);
+        m_pCtrl  = nullptr;
+        m_pSlots = nullptr;
+    }
+
+private:
+    AllocatorType m_Allocator;
+
+    Uint8*      m_pCtrl      = nullptr;
+    value_type* m_pSlots     = nullptr;
+    size_t      m_Capacity   = 0;
+    size_t      m_Size       = 0;
+    size_t      m_NumDeleted = 0;
+};
+
+} // namespace Diligent
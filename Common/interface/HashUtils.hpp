@@ -30,7 +30,13 @@
 #include <functional>
 #include <memory>
 #include <cstring>
+#include <string>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#    include <intrin.h>
+#endif
+
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -39,11 +45,137 @@
 namespace Diligent
 {
 
-// http://www.boost.org/doc/libs/1_35_0/doc/html/hash/combine.html
+namespace WyHash
+{
+
+// Hashing primitives based on wyhash (https://github.com/wangyi-fudan/wyhash, public domain).
+
+constexpr Uint64 Secret0 = 0x2d358dccaa6c78a5ull;
+constexpr Uint64 Secret1 = 0x8bb84b93962eacc9ull;
+constexpr Uint64 Secret2 = 0x4b33a62ed433d4a3ull;
+constexpr Uint64 Secret3 = 0x4d5a2da51de1aa47ull;
+
+/// Computes the full 128-bit product of A and B and returns its low and high halves in A and B.
+inline void Multiply128(Uint64& A, Uint64& B)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto r = static_cast<unsigned __int128>(A) * B;
+
+    A = static_cast<Uint64>(r);
+    B = static_cast<Uint64>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    A = _umul128(A, B, &B);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    const auto Lo = A * B;
+
+    B = __umulh(A, B);
+    A = Lo;
+#else
+    const Uint64 ha = A >> 32, hb = B >> 32, la = static_cast<Uint32>(A), lb = static_cast<Uint32>(B);
+
+    const Uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+
+    Uint64 c  = t < rl ? 1 : 0;
+    Uint64 lo = t + (rm1 << 32);
+    c += lo < t ? 1 : 0;
+    Uint64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+
+    A = lo;
+    B = hi;
+#endif
+}
+
+/// Multiplies A and B and folds the 128-bit product into 64 bits
+inline Uint64 Mix(Uint64 A, Uint64 B)
+{
+    Multiply128(A, B);
+    return A ^ B;
+}
+
+inline Uint64 Read8(const Uint8* p)
+{
+    Uint64 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline Uint64 Read4(const Uint8* p)
+{
+    Uint32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline Uint64 Read3(const Uint8* p, size_t k)
+{
+    return (Uint64{p[0]} << 16) | (Uint64{p[k >> 1]} << 8) | p[k - 1];
+}
+
+/// Computes the 64-bit hash of a byte range
+inline Uint64 Hash(const void* pData, size_t Size, Uint64 Seed = 0)
+{
+    const auto* p = static_cast<const Uint8*>(pData);
+
+    Seed ^= Mix(Seed ^ Secret0, Secret1);
+
+    Uint64 a = 0, b = 0;
+    if (Size <= 16)
+    {
+        if (Size >= 4)
+        {
+            a = (Read4(p) << 32) | Read4(p + ((Size >> 3) << 2));
+            b = (Read4(p + Size - 4) << 32) | Read4(p + Size - 4 - ((Size >> 3) << 2));
+        }
+        else if (Size > 0)
+        {
+            a = Read3(p, Size);
+        }
+    }
+    else
+    {
+        size_t i = Size;
+        if (i > 48)
+        {
+            // Three independent lanes let the CPU overlap the multiplications
+            Uint64 See1 = Seed, See2 = Seed;
+            do
+            {
+                Seed = Mix(Read8(p) ^ Secret1, Read8(p + 8) ^ Seed);
+                See1 = Mix(Read8(p + 16) ^ Secret2, Read8(p + 24) ^ See1);
+                See2 = Mix(Read8(p + 32) ^ Secret3, Read8(p + 40) ^ See2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            Seed ^= See1 ^ See2;
+        }
+        while (i > 16)
+        {
+            Seed = Mix(Read8(p) ^ Secret1, Read8(p + 8) ^ Seed);
+            i -= 16;
+            p += 16;
+        }
+        a = Read8(p + i - 16);
+        b = Read8(p + i - 8);
+    }
+
+    a ^= Secret1;
+    b ^= Seed;
+    Multiply128(a, b);
+    return Mix(a ^ Secret0 ^ Size, b ^ Secret1);
+}
+
+} // namespace WyHash
+
+/// Combines the hash of Val with the seed.
+
+/// The hash of Val is mixed with the seed through a 64x64->128 bit multiplication,
+/// which distributes the bits much better than the additive boost-style combine
+/// when std::hash is the identity function (as it is for integers in most
+/// standard library implementations).
 template <typename T>
 void HashCombine(std::size_t& Seed, const T& Val)
 {
-    Seed ^= std::hash<T>{}(Val) + 0x9e3779b9 + (Seed << 6) + (Seed >> 2);
+    Seed = static_cast<std::size_t>(WyHash::Mix(Uint64{Seed} ^ WyHash::Secret0, Uint64{std::hash<T>{}(Val)} ^ WyHash::Secret1));
 }
 
 template <typename FirstArgType, typename... RestArgsType>
@@ -61,16 +193,20 @@ std::size_t ComputeHash(const ArgsType&... Args)
     return Seed;
 }
 
+/// Computes the hash of a raw memory block, e.g. a POD structure
+inline std::size_t ComputeHashRaw(const void* pData, size_t Size, std::size_t Seed = 0)
+{
+    return static_cast<std::size_t>(WyHash::Hash(pData, Size, Seed));
+}
+
 template <typename CharType>
 struct CStringHash
 {
     size_t operator()(const CharType* str) const
     {
-        // http://www.cse.yorku.ca/~oz/hash.html
-        std::size_t Seed = 0;
-        while (std::size_t Ch = *(str++))
-            Seed = Seed * 65599 + Ch;
-        return Seed;
+        // The standard library strlen is vectorized, so measuring the string first
+        // and hashing it 8 or 48 bytes at a time is much faster than walking it char by char.
+        return ComputeHashRaw(str, std::char_traits<CharType>::length(str) * sizeof(CharType));
     }
 };
 
@@ -118,6 +254,16 @@ public:
         }
     }
 
+    // This constructor does not copy the string and uses the hash that was computed
+    // beforehand, which must be equal to CStringHash<Char>{}(_Str).
+    HashMapStringKey(const Char* _Str, size_t Hash) noexcept :
+        Str{_Str},
+        Ownership_Hash{Hash & HashMask}
+    {
+        VERIFY(Str, "String pointer must not be null");
+        VERIFY(Hash == CStringHash<Char>{}.operator()(Str), "Precomputed hash does not match the string");
+    }
+
     // Make this constructor explicit to avoid unintentional string copies
     explicit HashMapStringKey(const String& Str) :
         HashMapStringKey{Str.c_str(), true}
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::InternedStringTable class
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Thread-safe table of interned strings.
+
+/// Every unique string is stored once, and all calls to Intern() with equal strings
+/// return the same pointer, so interned strings can be compared by address.
+/// The returned pointers stay valid until the matching number of Release() calls is made.
+/// The table is split into independently locked shards to reduce contention.
+class InternedStringTable
+{
+public:
+    explicit InternedStringTable(IMemoryAllocator& Allocator) noexcept;
+    ~InternedStringTable();
+
+    // clang-format off
+    InternedStringTable           (const InternedStringTable&)  = delete;
+    InternedStringTable           (      InternedStringTable&&) = delete;
+    InternedStringTable& operator=(const InternedStringTable&)  = delete;
+    InternedStringTable& operator=(      InternedStringTable&&) = delete;
+    // clang-format on
+
+    /// Returns the interned copy of the string and adds a reference to it.
+    /// If Str is null, returns null.
+    const Char* Intern(const Char* Str) noexcept(false);
+
+    /// Adds a reference to a string previously returned by Intern().
+    void AddRef(const Char* InternedStr);
+
+    /// Releases a reference to a string previously returned by Intern().
+    /// When the last reference is released, the string is removed from the table.
+    /// If InternedStr is null, does nothing.
+    void Release(const Char* InternedStr);
+
+    /// Returns the number of unique strings in the table.
+    size_t GetSize() const;
+
+    /// Returns true if the string was returned by Intern() and has not been released.
+    bool IsInterned(const Char* Str) const;
+
+private:
+    struct EntryHeader
+    {
+        Uint32 RefCount;
+        Uint32 ShardIdx;
+    };
+
+    static EntryHeader* GetEntryHeader(const Char* InternedStr)
+    {
+        return reinterpret_cast<EntryHeader*>(const_cast<Char*>(InternedStr)) - 1;
+    }
+
+    static Uint32 GetShardIndex(size_t Hash)
+    {
+        // The low bits select the bucket within the shard's hash map, so use the high bits here.
+        return static_cast<Uint32>((Hash >> 16) % NumShards);
+    }
+
+    static constexpr Uint32 NumShards = 16;
+
+    struct Shard
+    {
+        mutable std::mutex                                                           Mtx;
+        std::unordered_map<HashMapStringKey, EntryHeader*, HashMapStringKey::Hasher> Map;
+    };
+
+    IMemoryAllocator&            m_Allocator;
+    std::array<Shard, NumShards> m_Shards;
+};
+
+} // namespace Diligent
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::LargePageMemoryAllocator class
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+
+namespace Diligent
+{
+
+/// Large page memory allocator create information, see Diligent::LargePageMemoryAllocator.
+struct LargePageMemoryAllocatorCreateInfo
+{
+    /// The size of a single arena, in bytes. The size is rounded up to a multiple of the large page size.
+    size_t ArenaSize = size_t{16} << 20;
+
+    /// The largest block, in bytes, that is allocated from the arenas, including the 16-byte block header.
+    /// Must be a power of two from 64 to 2 MB and must not exceed ArenaSize.
+    /// Larger allocations are forwarded to the fallback allocator.
+    size_t MaxBlockSize = size_t{64} << 10;
+
+    /// Allocator that is used for the allocations that are larger than MaxBlockSize
+    /// and for the arenas when large pages are not available.
+    /// If null, Diligent::DefaultRawMemoryAllocator is used.
+    IMemoryAllocator* pFallbackAllocator = nullptr;
+
+    /// Whether to back the arenas with large pages. If false, the arenas are always allocated from
+    /// the fallback allocator, which is useful to measure the effect of large pages.
+    bool UseLargePages = true;
+};
+
+/// Raw memory allocator that serves allocations from large arenas backed by large memory pages.
+
+/// The engine allocates the CPU-side objects that are accessed on every draw call (pipeline resource
+/// signatures, shader resource caches, object pools, release queues) through the raw memory allocator.
+/// With the default allocator these objects are scattered over many small pages, and translation lookaside
+/// buffer misses become noticeable during command submission. Packing them into a few large pages reduces the misses.
+/// Use the allocator by setting it as EngineCreateInfo::pRawMemAllocator.
+///
+/// Allocations up to the max block size are served from the arenas. Block sizes are rounded up to one of four
+/// size classes per power of two (80, 96, 112, 128, 160, ...), so at most 25% of the memory is lost to rounding.
+/// Freed blocks are kept in per-class free lists and reused; the arenas are only released when the allocator is destroyed.
+/// When large pages are not available (see IsUsingLargePages()), the arenas are allocated from the fallback
+/// allocator, so the allocator still works and keeps the objects together, but on regular pages.
+///
+/// The allocator is thread-safe. It must outlive all objects that were allocated from it,
+/// in particular all render devices that were created with it.
+class LargePageMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    explicit LargePageMemoryAllocator(const LargePageMemoryAllocatorCreateInfo& CI);
+    ~LargePageMemoryAllocator();
+
+    // clang-format off
+    LargePageMemoryAllocator           (const LargePageMemoryAllocator&)  = delete;
+    LargePageMemoryAllocator           (      LargePageMemoryAllocator&&) = delete;
+    LargePageMemoryAllocator& operator=(const LargePageMemoryAllocator&)  = delete;
+    LargePageMemoryAllocator& operator=(      LargePageMemoryAllocator&&) = delete;
+    // clang-format on
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns true if the arenas are backed by large pages. The value may change from true
+    /// to false when the system runs out of large pages.
+    bool IsUsingLargePages() const;
+
+    /// Returns the number of arenas and the total size of the arenas, in bytes.
+    void GetArenaStatistics(Uint32& NumArenas, size_t& TotalSize) const;
+
+private:
+    struct BlockHeader;
+
+    BlockHeader* AllocateFromArena(Uint32 SizeClass);
+    bool         CreateArena();
+
+    static constexpr Uint32 MaxSizeClasses = 64;
+
+    IMemoryAllocator& m_FallbackAllocator;
+
+    const Uint32 m_NumSizeClasses;
+
+    size_t m_ArenaSize     = 0;
+    bool   m_UseLargePages = false;
+
+    mutable std::mutex m_Mtx;
+
+    struct Arena
+    {
+        void* pMemory     = nullptr;
+        bool  IsLargePage = false;
+    };
+    std::vector<Arena> m_Arenas;
+
+    // The unused part of the last arena
+    Uint8* m_pArenaCurr = nullptr;
+    Uint8* m_pArenaEnd  = nullptr;
+
+    // Free block lists for every size class
+    std::array<BlockHeader*, MaxSizeClasses> m_FreeLists = {};
+};
+
+} // namespace Diligent
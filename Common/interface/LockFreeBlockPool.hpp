@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::LockFreeBlockPool class
+
+#include <atomic>
+#include <array>
+#include <new>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Thread-safe lock-free pool of fixed-size memory blocks.
+
+/// Blocks are carved out of chunks that are allocated from the raw memory allocator
+/// on demand and are only returned to it when the pool is destroyed. Free blocks are
+/// kept in an intrusive stack that is addressed by 32-bit block indices. The stack head
+/// packs the index of the top block together with a 32-bit modification tag, which
+/// protects Allocate() from the ABA problem without requiring double-width atomics.
+///
+/// When all chunks are exhausted, the pool falls back to allocating individual
+/// blocks from the raw memory allocator.
+class LockFreeBlockPool
+{
+public:
+    /// Alignment of the blocks returned by Allocate()
+    static constexpr size_t BlockAlignment = 16;
+
+    /// Maximum number of chunks the pool may allocate before it falls back to the raw allocator
+    static constexpr Uint32 MaxChunks = 256;
+
+    LockFreeBlockPool(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInChunk) :
+        // clang-format off
+        m_RawMemoryAllocator{RawMemoryAllocator},
+        m_BlockStride       {AlignUp(HeaderSize + BlockSize, BlockAlignment)},
+        m_NumBlocksInChunk  {NumBlocksInChunk}
+    // clang-format on
+    {
+        VERIFY_EXPR(BlockSize > 0);
+        VERIFY(m_NumBlocksInChunk > 1, "Chunk must contain at least two blocks");
+        VERIFY(Uint64{m_NumBlocksInChunk} * Uint64{MaxChunks} < Uint64{0xFFFFFFFFu}, "Too many blocks in a chunk");
+        for (auto& Chunk : m_Chunks)
+            Chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // clang-format off
+    LockFreeBlockPool             (const LockFreeBlockPool&) = delete;
+    LockFreeBlockPool             (LockFreeBlockPool&&)      = delete;
+    LockFreeBlockPool& operator = (const LockFreeBlockPool&) = delete;
+    LockFreeBlockPool& operator = (LockFreeBlockPool&&)      = delete;
+    // clang-format on
+
+    ~LockFreeBlockPool()
+    {
+        auto NumChunks = m_NumChunks.load();
+        if (NumChunks > MaxChunks)
+            NumChunks = MaxChunks;
+        for (Uint32 c = 0; c < NumChunks; ++c)
+        {
+            if (auto* pChunk = m_Chunks[c].load())
+                m_RawMemoryAllocator.Free(pChunk);
+        }
+    }
+
+    /// Allocates a block. The method is thread-safe and lock-free.
+    void* Allocate()
+    {
+        auto Head = m_FreeHead.load(std::memory_order_acquire);
+        while (UnpackIndex(Head) != InvalidIndex)
+        {
+            auto& Header = GetHeader(UnpackIndex(Head));
+            // The block may be popped and reused by another thread at this point.
+            // Its memory is never released while the pool is alive, so reading the
+            // link is safe, and the tag makes the exchange below fail in this case.
+            const auto NextIdx = Header.NextFree.load(std::memory_order_relaxed);
+            if (m_FreeHead.compare_exchange_weak(Head, PackHead(NextIdx, UnpackTag(Head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+                return GetPayload(Header);
+        }
+
+        return AllocateFromNewChunk();
+    }
+
+    /// Returns the block to the pool. The method is thread-safe and lock-free.
+    void Free(void* pBlock)
+    {
+        if (pBlock == nullptr)
+            return;
+
+        auto& Header = *reinterpret_cast<BlockHeader*>(reinterpret_cast<Uint8*>(pBlock) - HeaderSize);
+        if (Header.Index == InvalidIndex)
+        {
+            // The block was allocated directly from the raw allocator
+            m_RawMemoryAllocator.Free(&Header);
+            return;
+        }
+
+        PushFreeList(Header, Header);
+    }
+
+private:
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct BlockHeader
+    {
+        // Index of the next block in the free list, or InvalidIndex
+        std::atomic<Uint32> NextFree{InvalidIndex};
+
+        // Global index of this block, or InvalidIndex if the block was allocated
+        // directly from the raw allocator
+        Uint32 Index = InvalidIndex;
+    };
+    static constexpr size_t HeaderSize = (sizeof(BlockHeader) + BlockAlignment - 1) & ~(BlockAlignment - 1);
+
+    static Uint64 PackHead(Uint32 Index, Uint32 Tag)
+    {
+        // Index is stored with the offset of one so that zero-initialized head means empty list
+        return (Uint64{Tag} << 32u) | Uint64{Index + 1u};
+    }
+    static Uint32 UnpackIndex(Uint64 Head)
+    {
+        return static_cast<Uint32>(Head & 0xFFFFFFFFu) - 1u;
+    }
+    static Uint32 UnpackTag(Uint64 Head)
+    {
+        return static_cast<Uint32>(Head >> 32u);
+    }
+
+    BlockHeader& GetHeader(Uint32 Index) const
+    {
+        auto* pChunk = m_Chunks[Index / m_NumBlocksInChunk].load(std::memory_order_acquire);
+        VERIFY_EXPR(pChunk != nullptr);
+        return *reinterpret_cast<BlockHeader*>(pChunk + size_t{Index % m_NumBlocksInChunk} * m_BlockStride);
+    }
+
+    static void* GetPayload(BlockHeader& Header)
+    {
+        return reinterpret_cast<Uint8*>(&Header) + HeaderSize;
+    }
+
+    // Pushes the chain of blocks First -> ... -> Last to the free list.
+    // Last.NextFree is overwritten.
+    void PushFreeList(BlockHeader& First, BlockHeader& Last)
+    {
+        auto Head = m_FreeHead.load(std::memory_order_relaxed);
+        do
+        {
+            Last.NextFree.store(UnpackIndex(Head), std::memory_order_relaxed);
+        } while (!m_FreeHead.compare_exchange_weak(Head, PackHead(First.Index, UnpackTag(Head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void* AllocateFromNewChunk()
+    {
+        // Do not increment the counter once the limit is reached to prevent it from wrapping around
+        const auto ChunkIdx = m_NumChunks.load() < MaxChunks ? m_NumChunks.fetch_add(1) : Uint32{MaxChunks};
+        if (ChunkIdx >= MaxChunks)
+        {
+            auto* pHeader = new (m_RawMemoryAllocator.Allocate(m_BlockStride, "LockFreeBlockPool block", __FILE__, __LINE__)) BlockHeader{};
+            return GetPayload(*pHeader);
+        }
+
+        auto* pChunk = reinterpret_cast<Uint8*>(m_RawMemoryAllocator.Allocate(m_BlockStride * m_NumBlocksInChunk, "LockFreeBlockPool chunk", __FILE__, __LINE__));
+
+        const auto FirstIdx = ChunkIdx * m_NumBlocksInChunk;
+        for (Uint32 b = 0; b < m_NumBlocksInChunk; ++b)
+        {
+            auto* pHeader  = new (pChunk + size_t{b} * m_BlockStride) BlockHeader{};
+            pHeader->Index = FirstIdx + b;
+            if (b > 0 && b + 1 < m_NumBlocksInChunk)
+                pHeader->NextFree.store(FirstIdx + b + 1, std::memory_order_relaxed);
+        }
+        // Publish the chunk before any of its block indices become visible through the free list
+        m_Chunks[ChunkIdx].store(pChunk, std::memory_order_release);
+
+        // Block 0 is returned to the caller, the rest is added to the free list
+        auto* pFirst = reinterpret_cast<BlockHeader*>(pChunk + m_BlockStride);
+        auto* pLast  = reinterpret_cast<BlockHeader*>(pChunk + size_t{m_NumBlocksInChunk - 1} * m_BlockStride);
+        PushFreeList(*pFirst, *pLast);
+
+        return GetPayload(*reinterpret_cast<BlockHeader*>(pChunk));
+    }
+
+    IMemoryAllocator& m_RawMemoryAllocator;
+
+    const size_t m_BlockStride;
+    const Uint32 m_NumBlocksInChunk;
+
+    std::atomic<Uint64> m_FreeHead{0};
+    std::atomic<Uint32> m_NumChunks{0};
+
+    std::array<std::atomic<Uint8*>, MaxChunks> m_Chunks;
+};
+
+} // namespace Diligent
@@ -30,9 +30,73 @@
 #include "../../Platforms/interface/Atomics.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#    include <emmintrin.h>
+#    define DILIGENT_CPU_PAUSE() _mm_pause()
+#elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#    include <intrin.h>
+#    define DILIGENT_CPU_PAUSE() __yield()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__arm__) || defined(__aarch64__))
+#    define DILIGENT_CPU_PAUSE() __asm__ __volatile__("yield")
+#else
+#    define DILIGENT_CPU_PAUSE()
+#endif
+
 namespace ThreadingTools
 {
 
+// Exponential backoff for spin-wait loops. Every call to Spin() executes twice as many
+// CPU pause instructions as the previous one until the total number of pauses reaches
+// the spin limit. After that, every call yields the remainder of the thread's time slice.
+class SpinBackoff
+{
+public:
+    explicit SpinBackoff(int MaxSpinCount) noexcept :
+        m_MaxSpinCount{MaxSpinCount}
+    {}
+
+    void Spin() noexcept
+    {
+        if (IsSpinning())
+        {
+            for (int i = 0; i < m_NumPauses; ++i)
+                Pause();
+            m_TotalPauses += m_NumPauses;
+            m_NumPauses *= 2;
+        }
+        else
+        {
+            YieldThread();
+        }
+    }
+
+    // Returns true while the backoff has not exhausted its spin budget yet
+    bool IsSpinning() const noexcept
+    {
+        return m_TotalPauses < m_MaxSpinCount;
+    }
+
+    void Reset() noexcept
+    {
+        m_NumPauses   = 1;
+        m_TotalPauses = 0;
+    }
+
+    // Hints the processor that the thread is in a spin-wait loop
+    static void Pause() noexcept
+    {
+        DILIGENT_CPU_PAUSE();
+    }
+
+    static void YieldThread() noexcept;
+
+private:
+    const int m_MaxSpinCount;
+
+    int m_NumPauses   = 1;
+    int m_TotalPauses = 0;
+};
+
 class LockFlag
 {
 public:
@@ -56,6 +120,9 @@ private:
 
 // Spinlock implementation. This kind of lock should be used in scenarios
 // where simultaneous access is uncommon but possible.
+// A contending thread spins on a plain load with exponential backoff and only
+// attempts the interlocked exchange when the flag appears to be unlocked. When the spin
+// budget is exhausted, the thread yields its time slice on every further attempt.
 class LockHelper
 {
 public:
@@ -106,15 +173,15 @@ public:
 
     static void UnsafeLock(LockFlag& LockFlag, int SpinCountToYield = DefaultSpinCountToYield) noexcept
     {
-        int SpinCount = 0;
+        SpinBackoff Backoff{SpinCountToYield};
         while (!UnsafeTryLock(LockFlag))
         {
-            ++SpinCount;
-            if (SpinCount == SpinCountToYield)
+            // Wait until the flag appears to be unlocked before trying to take it again
+            // to avoid bouncing the cache line between the cores with interlocked operations
+            do
             {
-                SpinCount = 0;
-                YieldThread();
-            }
+                Backoff.Spin();
+            } while (LockFlag.m_Flag.load(std::memory_order_relaxed) != LockFlag::LOCK_FLAG_UNLOCKED);
         }
     }
 
@@ -122,21 +189,13 @@ public:
     {
         VERIFY(m_pLockFlag == NULL, "Object already locked");
         // Wait for the flag to become unlocked and lock it
-        int SpinCount = 0;
-        while (!TryLock(LockFlag))
-        {
-            ++SpinCount;
-            if (SpinCount == SpinCountToYield)
-            {
-                SpinCount = 0;
-                YieldThread();
-            }
-        }
+        UnsafeLock(LockFlag, SpinCountToYield);
+        m_pLockFlag = &LockFlag;
     }
 
     static void UnsafeUnlock(LockFlag& LockFlag) noexcept
     {
-        LockFlag.m_Flag = LockFlag::LOCK_FLAG_UNLOCKED;
+        LockFlag.m_Flag.store(LockFlag::LOCK_FLAG_UNLOCKED, std::memory_order_release);
     }
 
     void Unlock() noexcept
@@ -147,8 +206,6 @@ public:
     }
 
 private:
-    static void YieldThread() noexcept;
-
     LockFlag* m_pLockFlag = nullptr;
 
     // clang-format off
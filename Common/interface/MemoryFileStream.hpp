@@ -53,6 +53,9 @@ public:
     /// Reads data from the stream
     virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override;
 
+    /// Reads the remaining data from the stream into a new data blob
+    virtual void DILIGENT_CALL_TYPE ReadBlob2(IDataBlob** ppData) override;
+
     /// Reads data from the stream
     virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override;
 
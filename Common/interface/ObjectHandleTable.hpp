@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ObjectHandleTable class
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Packed 32-bit object handle: the low bits hold the slot index, the high bits hold the generation
+/// of the slot. A null handle is zero; valid handles are never zero.
+using ObjectHandle = Uint32;
+
+/// Thread-safe table of dense object handles.
+
+/// Every live object gets a slot index in [0, GetSlotCount()), so per-object state can be kept in
+/// plain arrays and bitsets indexed by the slot rather than in hash maps. When an object is released,
+/// its slot is recycled with an incremented generation, so a stale handle never compares equal to the handle
+/// of the object that reuses the slot (until the generation counter wraps around, which the table
+/// delays by recycling slots in FIFO order only after MinFreeSlots slots have been released).
+class ObjectHandleTable
+{
+public:
+    static constexpr Uint32 SlotIndexBits  = 20;
+    static constexpr Uint32 GenerationBits = 32 - SlotIndexBits;
+    static constexpr Uint32 MaxSlots       = 1u << SlotIndexBits;
+    static constexpr Uint32 MinFreeSlots   = 1024;
+
+    static constexpr ObjectHandle NullHandle = 0;
+
+    ObjectHandleTable() noexcept {}
+
+    // clang-format off
+    ObjectHandleTable           (const ObjectHandleTable&)  = delete;
+    ObjectHandleTable           (      ObjectHandleTable&&) = delete;
+    ObjectHandleTable& operator=(const ObjectHandleTable&)  = delete;
+    ObjectHandleTable& operator=(      ObjectHandleTable&&) = delete;
+    // clang-format on
+
+    ~ObjectHandleTable();
+
+    /// Allocates a new handle. Throws an exception if all MaxSlots slots are in use.
+    ObjectHandle Allocate() noexcept(false);
+
+    /// Releases the handle previously returned by Allocate(). If Handle is null, does nothing.
+    void Release(ObjectHandle Handle);
+
+    /// Returns true if the handle was returned by Allocate() and has not been released.
+    bool IsAlive(ObjectHandle Handle) const;
+
+    /// Returns the number of slots that have ever been used. The slot indices of all
+    /// handles are less than this value.
+    Uint32 GetSlotCount() const;
+
+    /// Returns the number of handles that have not been released.
+    Uint32 GetNumAliveHandles() const;
+
+    static Uint32 GetSlotIndex(ObjectHandle Handle)
+    {
+        return Handle & (MaxSlots - 1);
+    }
+
+    static Uint32 GetGeneration(ObjectHandle Handle)
+    {
+        return Handle >> SlotIndexBits;
+    }
+
+private:
+    static constexpr Uint32 AliveFlag = 1u << 31;
+
+    mutable std::mutex m_Mtx;
+
+    // Current generation of every slot, combined with AliveFlag if the slot is in use
+    std::vector<Uint32> m_Slots;
+
+    // Released slots in the order they were released
+    std::deque<Uint32> m_FreeSlots;
+};
+
+} // namespace Diligent
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface that references external memory
+
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that references external memory without copying it.
+
+/// The external memory is kept alive either by a reference-counted owner object, or
+/// by the caller until the release callback is invoked. If neither is given, the caller
+/// must guarantee that the memory outlives the blob.
+///
+/// The external memory is treated as read-only: GetConstDataPtr() returns the original pointer,
+/// while GetDataPtr() and Resize() first copy the data into the blob's own storage and release
+/// the external memory.
+class ProxyDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    typedef ObjectBase<IDataBlob> TBase;
+
+    /// Callback that is invoked when the blob no longer references the external memory
+    using ReleaseCallbackType = void (*)(const void* pData, void* pUserData);
+
+    ProxyDataBlob(IReferenceCounters* pRefCounters,
+                  const void*         pData,
+                  size_t              Size,
+                  IObject*            pOwner = nullptr);
+
+    ProxyDataBlob(IReferenceCounters* pRefCounters,
+                  const void*         pData,
+                  size_t              Size,
+                  ReleaseCallbackType ReleaseCallback,
+                  void*               pUserData);
+
+    ~ProxyDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Copies the external data into the blob's own storage and resizes it
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the data
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override;
+
+    /// Copies the external data into the blob's own storage and returns the pointer to it
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override;
+
+    /// Returns the pointer to the external data, or to the blob's own storage if the data has been copied
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override;
+
+    /// Returns true if the blob still references the external memory
+    bool IsExternal() const { return m_pExternalData != nullptr; }
+
+private:
+    void MakeCopy();
+    void ReleaseExternalData();
+
+    const void* m_pExternalData = nullptr;
+    size_t      m_ExternalSize  = 0;
+
+    RefCntAutoPtr<IObject> m_pOwner;
+    ReleaseCallbackType    m_ReleaseCallback = nullptr;
+    void*                  m_pUserData       = nullptr;
+
+    std::vector<Uint8> m_DataBuff;
+};
+
+} // namespace Diligent
@@ -0,0 +1,404 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ReadMostlyHashMap class
+
+#include <atomic>
+#include <vector>
+#include <functional>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Hash map optimized for workloads where lookups vastly outnumber modifications.
+
+/// Find() does not take any locks and may be called concurrently from any number of threads,
+/// including while the map is being modified. Insert(), Erase() and Clear() must be externally
+/// synchronized with each other (typically by a mutex the owner already holds to create the value).
+///
+/// Elements are stored in immutable nodes chained into buckets through atomic pointers. Removed
+/// nodes and bucket arrays are retired and deleted by a later modification once no reader is
+/// inside Find(). Readers register themselves in one of several padded counters selected
+/// per thread, so that concurrent lookups do not contend for the same cache line.
+///
+/// \tparam KeyType    - Key type. Keys are compared with operator==.
+/// \tparam ValueType  - Value type. Find() returns a copy of the value, so the type should be
+///                      cheap to copy, e.g. a handle or a raw pointer.
+/// \tparam HasherType - Key hasher type.
+///
+/// \note  Find() may return a value that is being concurrently erased by another thread.
+///        The owner is responsible for keeping such values valid, e.g. by deferring their
+///        destruction through a release queue.
+template <typename KeyType, typename ValueType, typename HasherType = std::hash<KeyType>>
+class ReadMostlyHashMap
+{
+public:
+    explicit ReadMostlyHashMap(size_t InitialBucketCount = 64) :
+        m_pTable{CreateTable(InitialBucketCount)}
+    {
+        for (auto& Slot : m_ReaderSlots)
+            Slot.NumReaders.store(0, std::memory_order_relaxed);
+    }
+
+    // clang-format off
+    ReadMostlyHashMap           (const ReadMostlyHashMap&) = delete;
+    ReadMostlyHashMap           (ReadMostlyHashMap&&)      = delete;
+    ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+    ReadMostlyHashMap& operator=(ReadMostlyHashMap&&)      = delete;
+    // clang-format on
+
+    ~ReadMostlyHashMap()
+    {
+#ifdef DILIGENT_DEBUG
+        for (const auto& Slot : m_ReaderSlots)
+            VERIFY(Slot.NumReaders.load(std::memory_order_relaxed) == 0, "Destroying the map while it is being read");
+#endif
+        auto* pTable = m_pTable.load(std::memory_order_relaxed);
+        DestroyTable(pTable, /*DestroyNodes = */ true);
+        FreeRetired();
+    }
+
+    /// Looks up the key and copies the value to Value. Returns true if the key was found.
+
+    /// The method is lock-free and is safe to call concurrently with any other method.
+    bool Find(const KeyType& Key, ValueType& Value) const
+    {
+        return Find(Key, [&Value](const ValueType& NodeValue) {
+            Value = NodeValue;
+            return true;
+        });
+    }
+
+    /// Looks up the key and calls Handler(const ValueType&) for the value without copying it.
+    /// Returns the value returned by the handler, or false if the key was not found.
+
+    /// The handler is called while the node is protected from deletion, so it may access
+    /// objects owned by the value. The value itself is immutable, but the handler may update
+    /// atomic state the value refers to, e.g. a last-used timestamp.
+    /// The method is lock-free and is safe to call concurrently with any other method.
+    template <typename HandlerType>
+    bool Find(const KeyType& Key, HandlerType&& Handler) const
+    {
+        const auto Hash = m_Hasher(Key);
+
+        ReaderScope Reader{*this};
+
+        // Sequentially consistent loads pair with the writer stores that unlink retired
+        // objects, see ReclaimRetired(). On common architectures they are plain loads.
+        const auto* pTable = m_pTable.load();
+        for (const auto* pNode = pTable->Buckets[Hash & pTable->Mask].load(); pNode != nullptr; pNode = pNode->pNext.load())
+        {
+            if (pNode->Hash == Hash && pNode->Key == Key)
+                return Handler(pNode->Value);
+        }
+        return false;
+    }
+
+    /// Inserts the key-value pair. Returns false if the key is already in the map.
+
+    /// The method must be externally synchronized with other modifications.
+    bool Insert(const KeyType& Key, const ValueType& Value)
+    {
+        const auto Hash = m_Hasher(Key);
+
+        auto* pTable = m_pTable.load(std::memory_order_relaxed);
+        for (auto* pNode = pTable->Buckets[Hash & pTable->Mask].load(std::memory_order_relaxed); pNode != nullptr; pNode = pNode->pNext.load(std::memory_order_relaxed))
+        {
+            if (pNode->Hash == Hash && pNode->Key == Key)
+                return false;
+        }
+
+        if (m_Size + 1 > pTable->Mask + 1)
+            pTable = Rehash(pTable, (pTable->Mask + 1) * 2);
+
+        auto& Bucket = pTable->Buckets[Hash & pTable->Mask];
+
+        auto* pNewNode = new Node{Key, Value, Hash, Bucket.load(std::memory_order_relaxed)};
+        // Keys that lazily cache their hash must do so before the node becomes visible
+        // to readers, so that comparisons in Find() do not modify the shared node.
+        (void)m_Hasher(pNewNode->Key);
+
+        Bucket.store(pNewNode, std::memory_order_release);
+        ++m_Size;
+
+        ReclaimRetired();
+        return true;
+    }
+
+    /// Removes the key from the map. Returns true if the key was found.
+
+    /// The method must be externally synchronized with other modifications.
+    bool Erase(const KeyType& Key)
+    {
+        const auto Hash = m_Hasher(Key);
+
+        auto* pTable = m_pTable.load(std::memory_order_relaxed);
+
+        std::atomic<Node*>* pLink = &pTable->Buckets[Hash & pTable->Mask];
+        for (auto* pNode = pLink->load(std::memory_order_relaxed); pNode != nullptr; pNode = pLink->load(std::memory_order_relaxed))
+        {
+            if (pNode->Hash == Hash && pNode->Key == Key)
+            {
+                // Readers that are already on the node will continue to the rest of the chain
+                pLink->store(pNode->pNext.load(std::memory_order_relaxed));
+                m_RetiredNodes.push_back(pNode);
+                --m_Size;
+
+                ReclaimRetired();
+                return true;
+            }
+            pLink = &pNode->pNext;
+        }
+
+        return false;
+    }
+
+    /// Removes all elements from the map.
+
+    /// The method must be externally synchronized with other modifications.
+    void Clear()
+    {
+        auto* pTable = m_pTable.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= pTable->Mask; ++i)
+        {
+            auto* pNode = pTable->Buckets[i].exchange(nullptr);
+            while (pNode != nullptr)
+            {
+                m_RetiredNodes.push_back(pNode);
+                pNode = pNode->pNext.load(std::memory_order_relaxed);
+            }
+        }
+        m_Size = 0;
+
+        ReclaimRetired();
+    }
+
+    /// Calls Handler(const KeyType&, const ValueType&) for every element in the map.
+
+    /// The method must be externally synchronized with modifications, and the handler must not
+    /// modify the map.
+    template <typename HandlerType>
+    void ForEach(HandlerType&& Handler) const
+    {
+        const auto* pTable = m_pTable.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= pTable->Mask; ++i)
+        {
+            for (const auto* pNode = pTable->Buckets[i].load(std::memory_order_relaxed); pNode != nullptr; pNode = pNode->pNext.load(std::memory_order_relaxed))
+                Handler(pNode->Key, pNode->Value);
+        }
+    }
+
+    /// Returns the number of elements in the map.
+
+    /// The method must be externally synchronized with modifications.
+    size_t Size() const
+    {
+        return m_Size;
+    }
+
+    /// Returns the number of removed nodes and bucket arrays that have not yet been deleted
+    /// because readers were active. This is intended for testing and diagnostics.
+    size_t GetNumRetiredObjects() const
+    {
+        return m_RetiredNodes.size() + m_RetiredTables.size();
+    }
+
+private:
+    struct Node
+    {
+        Node(const KeyType& _Key, const ValueType& _Value, size_t _Hash, Node* _pNext) :
+            // clang-format off
+            Key  {_Key},
+            Value{_Value},
+            Hash {_Hash},
+            pNext{_pNext}
+        // clang-format on
+        {}
+
+        const KeyType      Key;
+        const ValueType    Value;
+        const size_t       Hash;
+        std::atomic<Node*> pNext;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t BucketCount) :
+            Mask{BucketCount - 1},
+            Buckets{new std::atomic<Node*>[BucketCount]}
+        {
+            for (size_t i = 0; i < BucketCount; ++i)
+                Buckets[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~Table()
+        {
+            delete[] Buckets;
+        }
+
+        // clang-format off
+        Table           (const Table&) = delete;
+        Table& operator=(const Table&) = delete;
+        // clang-format on
+
+        const size_t              Mask;
+        std::atomic<Node*>* const Buckets;
+    };
+
+    static Table* CreateTable(size_t BucketCount)
+    {
+        // Round up to the power of two
+        size_t Size = 1;
+        while (Size < BucketCount)
+            Size *= 2;
+        return new Table{Size};
+    }
+
+    static void DestroyTable(Table* pTable, bool DestroyNodes)
+    {
+        if (DestroyNodes)
+        {
+            for (size_t i = 0; i <= pTable->Mask; ++i)
+            {
+                auto* pNode = pTable->Buckets[i].load(std::memory_order_relaxed);
+                while (pNode != nullptr)
+                {
+                    auto* pNext = pNode->pNext.load(std::memory_order_relaxed);
+                    delete pNode;
+                    pNode = pNext;
+                }
+            }
+        }
+        delete pTable;
+    }
+
+    // Readers may be traversing the chains of the old table, so the old nodes
+    // are not relinked. Instead, the new table gets copies of all nodes.
+    Table* Rehash(Table* pOldTable, size_t NewBucketCount)
+    {
+        auto* pNewTable = CreateTable(NewBucketCount);
+        for (size_t i = 0; i <= pOldTable->Mask; ++i)
+        {
+            for (auto* pNode = pOldTable->Buckets[i].load(std::memory_order_relaxed); pNode != nullptr; pNode = pNode->pNext.load(std::memory_order_relaxed))
+            {
+                auto& Bucket = pNewTable->Buckets[pNode->Hash & pNewTable->Mask];
+                Bucket.store(new Node{pNode->Key, pNode->Value, pNode->Hash, Bucket.load(std::memory_order_relaxed)}, std::memory_order_relaxed);
+            }
+        }
+
+        m_pTable.store(pNewTable);
+        m_RetiredTables.push_back(pOldTable);
+        return pNewTable;
+    }
+
+    void ReclaimRetired()
+    {
+        if (m_RetiredNodes.empty() && m_RetiredTables.empty())
+            return;
+
+        // All operations that unlink retired objects, reader counter updates and reader loads are
+        // sequentially consistent. If a reader's counter increment is not visible here, it follows
+        // the unlinking stores in the total order, so the reader can't reach the retired objects.
+        for (const auto& Slot : m_ReaderSlots)
+        {
+            if (Slot.NumReaders.load() != 0)
+                return;
+        }
+
+        FreeRetired();
+    }
+
+    void FreeRetired()
+    {
+        for (auto* pNode : m_RetiredNodes)
+            delete pNode;
+        m_RetiredNodes.clear();
+
+        for (auto* pTable : m_RetiredTables)
+            DestroyTable(pTable, /*DestroyNodes = */ true);
+        m_RetiredTables.clear();
+    }
+
+    static constexpr size_t NumReaderSlots = 16;
+
+    struct ReaderSlot
+    {
+        std::atomic<Uint32> NumReaders;
+        // Keep counters of different slots in different cache lines
+        Uint8 Padding[64 - sizeof(std::atomic<Uint32>)];
+    };
+
+    static size_t GetReaderSlotIndex()
+    {
+        static std::atomic<size_t> NextSlotIdx{0};
+        // Threads are assigned to slots in round-robin order the first time they read the map
+        thread_local const size_t SlotIdx = NextSlotIdx.fetch_add(1, std::memory_order_relaxed) % NumReaderSlots;
+        return SlotIdx;
+    }
+
+    class ReaderScope
+    {
+    public:
+        explicit ReaderScope(const ReadMostlyHashMap& Map) :
+            m_Slot{Map.m_ReaderSlots[GetReaderSlotIndex()]}
+        {
+            m_Slot.NumReaders.fetch_add(1);
+        }
+
+        ~ReaderScope()
+        {
+            m_Slot.NumReaders.fetch_sub(1, std::memory_order_release);
+        }
+
+        // clang-format off
+        ReaderScope           (const ReaderScope&) = delete;
+        ReaderScope& operator=(const ReaderScope&) = delete;
+        // clang-format on
+
+    private:
+        ReaderSlot& m_Slot;
+    };
+
+    mutable ReaderSlot m_ReaderSlots[NumReaderSlots];
+
+    std::atomic<Table*> m_pTable;
+    size_t              m_Size = 0;
+
+    std::vector<Node*>  m_RetiredNodes;
+    std::vector<Table*> m_RetiredTables;
+
+    HasherType m_Hasher;
+};
+
+} // namespace Diligent
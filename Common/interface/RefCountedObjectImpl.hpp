@@ -36,12 +36,21 @@
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "LockHelper.hpp"
 #include "ValidatedCast.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
 
+#ifdef DILIGENT_CACHE_ALIGNED_REF_COUNTERS
+// Reference counters of objects that are shared between threads are allocated
+// next to each other and would otherwise falsely share cache lines.
+static constexpr size_t RefCountersAlignment = 64;
+#else
+static constexpr size_t RefCountersAlignment = alignof(void*);
+#endif
+
 // This class controls the lifetime of a refcounted object
-class RefCountersImpl final : public IReferenceCounters
+class alignas(RefCountersAlignment) RefCountersImpl final : public IReferenceCounters
 {
 public:
     inline virtual ReferenceCounterValueType AddStrongRef() override final
@@ -457,6 +466,23 @@ private:
         delete this;
     }
 
+#ifdef DILIGENT_CACHE_ALIGNED_REF_COUNTERS
+    // C++14 operator new does not respect extended alignment, so allocate the
+    // padded block manually and keep the original pointer right in front of it.
+    void* operator new(size_t Size)
+    {
+        auto* pRawMem  = new Uint8[Size + RefCountersAlignment + sizeof(void*)];
+        auto* pAligned = AlignUp(pRawMem + sizeof(void*), RefCountersAlignment);
+        reinterpret_cast<Uint8**>(pAligned)[-1] = pRawMem;
+        return pAligned;
+    }
+
+    void operator delete(void* ptr)
+    {
+        delete[] reinterpret_cast<Uint8**>(ptr)[-1];
+    }
+#endif
+
     ~RefCountersImpl()
     {
         VERIFY(m_lNumStrongReferences == 0 && m_lNumWeakReferences == 0,
@@ -480,7 +506,8 @@ private:
     // which does have virtual destructor.
     static constexpr size_t ObjectWrapperBufferSize = sizeof(ObjectWrapper<IObjectStub, IMemoryAllocator>) / sizeof(size_t);
 
-    size_t                   m_ObjectWrapperBuffer[ObjectWrapperBufferSize];
+    // Frequently written counters go first so that they share the cache line with the vtable
+    // pointer rather than straddle the line boundary when the block is cache-line aligned.
     Atomics::AtomicLong      m_lNumStrongReferences;
     Atomics::AtomicLong      m_lNumWeakReferences;
     ThreadingTools::LockFlag m_LockFlag;
@@ -491,8 +518,13 @@ private:
         Destroyed
     };
     volatile ObjectState m_ObjectState = ObjectState::NotInitialized;
+    size_t               m_ObjectWrapperBuffer[ObjectWrapperBufferSize];
 };
 
+#ifdef DILIGENT_CACHE_ALIGNED_REF_COUNTERS
+static_assert(sizeof(RefCountersImpl) == RefCountersAlignment, "Reference counters are expected to occupy exactly one cache line");
+#endif
+
 
 /// Base class for all reference counting objects
 template <typename Base>
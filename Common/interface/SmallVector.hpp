@@ -0,0 +1,384 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::SmallVector class
+
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+#include <type_traits>
+#include <algorithm>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Vector that stores up to N elements in place and only allocates memory
+/// from the allocator when the number of elements exceeds N.
+
+/// The interface follows std::vector. Note that moving a vector whose elements are
+/// stored in place moves the elements individually, so unlike std::vector, iterators
+/// and pointers to the elements of the source vector are not preserved.
+///
+/// \tparam T             - Element type.
+/// \tparam N             - Number of elements stored in place.
+/// \tparam AllocatorType - STL-compatible allocator, e.g. STDAllocatorRawMem, that is used when
+///                         the number of elements exceeds N.
+template <typename T, size_t N, typename AllocatorType = std::allocator<T>>
+class SmallVector
+{
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using allocator_type         = AllocatorType;
+
+    static_assert(N > 0, "The number of in-place elements must not be zero");
+
+    explicit SmallVector(const AllocatorType& Allocator = AllocatorType{}) noexcept :
+        m_Allocator{Allocator}
+    {}
+
+    explicit SmallVector(size_t Count, const AllocatorType& Allocator = AllocatorType{}) :
+        m_Allocator{Allocator}
+    {
+        resize(Count);
+    }
+
+    SmallVector(size_t Count, const T& Value, const AllocatorType& Allocator = AllocatorType{}) :
+        m_Allocator{Allocator}
+    {
+        resize(Count, Value);
+    }
+
+    SmallVector(std::initializer_list<T> List, const AllocatorType& Allocator = AllocatorType{}) :
+        m_Allocator{Allocator}
+    {
+        assign(List.begin(), List.end());
+    }
+
+    SmallVector(const SmallVector& rhs) :
+        m_Allocator{rhs.m_Allocator}
+    {
+        assign(rhs.begin(), rhs.end());
+    }
+
+    SmallVector(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) :
+        m_Allocator{std::move(rhs.m_Allocator)}
+    {
+        MoveFrom(std::move(rhs));
+    }
+
+    SmallVector& operator=(const SmallVector& rhs)
+    {
+        if (this != &rhs)
+            assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            FreeHeapStorage();
+            MoveFrom(std::move(rhs));
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        FreeHeapStorage();
+    }
+
+    template <typename InputIteratorType>
+    void assign(InputIteratorType First, InputIteratorType Last)
+    {
+        clear();
+        reserve(static_cast<size_t>(std::distance(First, Last)));
+        for (; First != Last; ++First)
+            new (m_pData + m_Size++) T(*First);
+    }
+
+    // clang-format off
+    iterator       begin()       noexcept { return m_pData; }
+    const_iterator begin() const noexcept { return m_pData; }
+    iterator       end()         noexcept { return m_pData + m_Size; }
+    const_iterator end()   const noexcept { return m_pData + m_Size; }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    reverse_iterator       rbegin()       noexcept { return reverse_iterator{end()}; }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+    reverse_iterator       rend()         noexcept { return reverse_iterator{begin()}; }
+    const_reverse_iterator rend()   const noexcept { return const_reverse_iterator{begin()}; }
+
+    T*       data()       noexcept { return m_pData; }
+    const T* data() const noexcept { return m_pData; }
+
+    bool   empty()    const noexcept { return m_Size == 0; }
+    size_t size()     const noexcept { return m_Size; }
+    size_t capacity() const noexcept { return m_Capacity; }
+
+    /// Returns true if the elements are stored in place
+    bool IsInPlace() const noexcept { return m_pData == GetInPlaceData(); }
+    // clang-format on
+
+    T& operator[](size_t Idx) noexcept
+    {
+        VERIFY(Idx < m_Size, "Index ", Idx, " is out of range [0, ", m_Size, ")");
+        return m_pData[Idx];
+    }
+    const T& operator[](size_t Idx) const noexcept
+    {
+        VERIFY(Idx < m_Size, "Index ", Idx, " is out of range [0, ", m_Size, ")");
+        return m_pData[Idx];
+    }
+
+    T& front() noexcept
+    {
+        VERIFY(!empty(), "Vector is empty");
+        return m_pData[0];
+    }
+    const T& front() const noexcept
+    {
+        VERIFY(!empty(), "Vector is empty");
+        return m_pData[0];
+    }
+
+    T& back() noexcept
+    {
+        VERIFY(!empty(), "Vector is empty");
+        return m_pData[m_Size - 1];
+    }
+    const T& back() const noexcept
+    {
+        VERIFY(!empty(), "Vector is empty");
+        return m_pData[m_Size - 1];
+    }
+
+    void reserve(size_t NewCapacity)
+    {
+        if (NewCapacity <= m_Capacity)
+            return;
+
+        auto* pNewData = std::allocator_traits<AllocatorType>::allocate(m_Allocator, NewCapacity);
+        for (size_t i = 0; i < m_Size; ++i)
+        {
+            new (pNewData + i) T(std::move_if_noexcept(m_pData[i]));
+            m_pData[i].~T();
+        }
+        FreeHeapStorage();
+
+        m_pData    = pNewData;
+        m_Capacity = NewCapacity;
+    }
+
+    template <typename... ArgsType>
+    T& emplace_back(ArgsType&&... Args)
+    {
+        if (m_Size == m_Capacity)
+            Grow();
+        auto* pElem = new (m_pData + m_Size) T(std::forward<ArgsType>(Args)...);
+        ++m_Size;
+        return *pElem;
+    }
+
+    void push_back(const T& Value)
+    {
+        if (m_Size == m_Capacity && &Value >= m_pData && &Value < m_pData + m_Size)
+        {
+            // Value references an element of this vector that will be moved by Grow()
+            T Copy(Value);
+            emplace_back(std::move(Copy));
+        }
+        else
+        {
+            emplace_back(Value);
+        }
+    }
+
+    void push_back(T&& Value)
+    {
+        if (m_Size == m_Capacity && &Value >= m_pData && &Value < m_pData + m_Size)
+        {
+            T Tmp(std::move(Value));
+            emplace_back(std::move(Tmp));
+        }
+        else
+        {
+            emplace_back(std::move(Value));
+        }
+    }
+
+    void pop_back() noexcept
+    {
+        VERIFY(!empty(), "Vector is empty");
+        m_pData[--m_Size].~T();
+    }
+
+    void resize(size_t NewSize)
+    {
+        if (NewSize > m_Size)
+        {
+            reserve(NewSize);
+            for (; m_Size < NewSize; ++m_Size)
+                new (m_pData + m_Size) T();
+        }
+        else
+        {
+            Shrink(NewSize);
+        }
+    }
+
+    void resize(size_t NewSize, const T& Value)
+    {
+        if (NewSize > m_Size)
+        {
+            VERIFY(&Value < m_pData || &Value >= m_pData + m_Size, "Value must not reference an element of this vector");
+            reserve(NewSize);
+            for (; m_Size < NewSize; ++m_Size)
+                new (m_pData + m_Size) T(Value);
+        }
+        else
+        {
+            Shrink(NewSize);
+        }
+    }
+
+    /// Erases the element at the given position and returns the iterator to the next element
+    iterator erase(const_iterator Pos)
+    {
+        VERIFY(Pos >= begin() && Pos < end(), "Iterator is out of range");
+        auto* pElem = m_pData + (Pos - m_pData);
+        std::move(pElem + 1, end(), pElem);
+        pop_back();
+        return pElem;
+    }
+
+    /// Destroys all elements, but keeps the allocated memory
+    void clear() noexcept
+    {
+        Shrink(0);
+    }
+
+private:
+    T* GetInPlaceData() noexcept
+    {
+        return reinterpret_cast<T*>(&m_InPlaceStorage);
+    }
+    const T* GetInPlaceData() const noexcept
+    {
+        return reinterpret_cast<const T*>(&m_InPlaceStorage);
+    }
+
+    void Grow()
+    {
+        reserve(std::max(m_Capacity * 2, size_t{N}));
+    }
+
+    void Shrink(size_t NewSize) noexcept
+    {
+        while (m_Size > NewSize)
+            m_pData[--m_Size].~T();
+    }
+
+    void FreeHeapStorage() noexcept
+    {
+        if (!IsInPlace())
+        {
+            std::allocator_traits<AllocatorType>::deallocate(m_Allocator, m_pData, m_Capacity);
+            m_pData    = GetInPlaceData();
+            m_Capacity = N;
+        }
+    }
+
+    // Takes the elements from rhs. This vector must be empty and use in-place storage.
+    void MoveFrom(SmallVector&& rhs)
+    {
+        VERIFY_EXPR(m_Size == 0 && IsInPlace());
+        if (rhs.IsInPlace() || !(m_Allocator == rhs.m_Allocator))
+        {
+            // The heap memory can only be taken over if it can be released by our allocator
+            reserve(rhs.m_Size);
+            for (size_t i = 0; i < rhs.m_Size; ++i)
+                new (m_pData + i) T(std::move(rhs.m_pData[i]));
+            m_Size = rhs.m_Size;
+            rhs.clear();
+        }
+        else
+        {
+            m_pData    = rhs.m_pData;
+            m_Size     = rhs.m_Size;
+            m_Capacity = rhs.m_Capacity;
+
+            rhs.m_pData    = rhs.GetInPlaceData();
+            rhs.m_Size     = 0;
+            rhs.m_Capacity = N;
+        }
+    }
+
+private:
+    AllocatorType m_Allocator;
+
+    T*     m_pData    = GetInPlaceData();
+    size_t m_Size     = 0;
+    size_t m_Capacity = N;
+
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type m_InPlaceStorage;
+};
+
+template <typename T, size_t N, typename AllocatorType>
+bool operator==(const SmallVector<T, N, AllocatorType>& lhs, const SmallVector<T, N, AllocatorType>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t N, typename AllocatorType>
+bool operator!=(const SmallVector<T, N, AllocatorType>& lhs, const SmallVector<T, N, AllocatorType>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace Diligent
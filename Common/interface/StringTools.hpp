@@ -257,4 +257,52 @@ inline size_t CountFloatNumberChars(const char* str)
     return num_end - str;
 }
 
+/// Calls Handler(std::string&& Name) for the file name of every #include directive in the source.
+/// Both "name" and <name> forms are recognized. Conditional directives are not evaluated,
+/// so the handler may be called for files that the preprocessor would not include.
+template <typename HandlerType>
+void ForEachIncludeDirective(const char* Source, size_t SourceLength, HandlerType&& Handler)
+{
+    auto SkipSpaces = [](const char*& Pos, const char* End) {
+        while (Pos < End && (*Pos == ' ' || *Pos == '\t'))
+            ++Pos;
+    };
+
+    const auto* Pos = Source;
+    const auto* End = Source + SourceLength;
+    while (Pos < End)
+    {
+        SkipSpaces(Pos, End);
+        if (Pos < End && *Pos == '#')
+        {
+            ++Pos;
+            SkipSpaces(Pos, End);
+
+            static constexpr char   IncludeStr[] = "include";
+            static constexpr size_t IncludeLen   = sizeof(IncludeStr) - 1;
+            if (static_cast<size_t>(End - Pos) > IncludeLen && strncmp(Pos, IncludeStr, IncludeLen) == 0)
+            {
+                Pos += IncludeLen;
+                SkipSpaces(Pos, End);
+                if (Pos < End && (*Pos == '"' || *Pos == '<'))
+                {
+                    const auto  ClosingQuote = *Pos == '"' ? '"' : '>';
+                    const auto* NameStart    = ++Pos;
+                    while (Pos < End && *Pos != ClosingQuote && *Pos != '\n')
+                        ++Pos;
+
+                    if (Pos < End && *Pos == ClosingQuote)
+                        Handler(std::string{NameStart, Pos});
+                }
+            }
+        }
+
+        // Move to the next line
+        while (Pos < End && *Pos != '\n')
+            ++Pos;
+        if (Pos < End)
+            ++Pos;
+    }
+}
+
 } // namespace Diligent
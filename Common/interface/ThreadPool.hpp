@@ -0,0 +1,306 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ThreadPool class
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/ThreadPool.h"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// A pool of worker threads with work stealing.
+
+/// Every worker thread owns a task queue. Tasks enqueued by a worker thread are added to its own queue,
+/// which the thread processes in LIFO order to keep the data of the recently spawned tasks in the cache.
+/// Tasks enqueued by other threads are added to the shared queue and are started in FIFO order.
+/// A worker thread that has run out of tasks takes tasks from the shared queue and then steals
+/// the oldest tasks from the queues of the other worker threads.
+///
+/// \remarks    The state shared by the worker threads is reference-counted, so the pool can be
+///             safely destroyed from one of its own worker threads (e.g. when a task releases the
+///             last reference to the object that owns the pool). In this case the worker thread
+///             is detached and exits as soon as it returns from the task.
+class ThreadPool
+{
+public:
+    using TaskType = std::function<void()>;
+
+    /// Creates the pool with the given number of threads.
+    /// If NumThreads is 0, the number of threads is selected by GetDefaultThreadCount().
+    explicit ThreadPool(Uint32 NumThreads = 0)
+    {
+        if (NumThreads == 0)
+            NumThreads = GetDefaultThreadCount();
+
+        m_pState = std::make_shared<SharedState>(NumThreads);
+        m_Threads.reserve(NumThreads);
+        for (Uint32 i = 0; i < NumThreads; ++i)
+            m_Threads.emplace_back(WorkerThreadFunc, m_pState, size_t{i});
+    }
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&)  = delete;
+    ThreadPool           (      ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(      ThreadPool&&) = delete;
+    // clang-format on
+
+    /// Stops the pool. Tasks that have already been enqueued are executed before the threads exit.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+            m_pState->Stop.store(true);
+        }
+        m_pState->TaskAvailableCV.notify_all();
+
+        const auto ThisThreadId = std::this_thread::get_id();
+        for (auto& Thread : m_Threads)
+        {
+            if (Thread.get_id() == ThisThreadId)
+                Thread.detach();
+            else
+                Thread.join();
+        }
+    }
+
+    /// Adds the task to the queue. The task will be executed by the first available worker thread.
+    /// Tasks must not throw exceptions.
+    void EnqueueTask(TaskType&& Task)
+    {
+        VERIFY_EXPR(Task);
+        // Keep the state alive as the task may destroy the pool before this method returns
+        const auto pState = m_pState;
+        auto&      State  = *pState;
+        VERIFY(!State.Stop.load(), "Enqueueing a task into the pool that is being destroyed");
+
+        // The task must be counted as pending before any thread can pick it up
+        State.NumPendingTasks.fetch_add(1);
+
+        const auto& ThreadInfo = GetThisThreadInfo();
+        auto&       Queue      = ThreadInfo.pState == &State ? State.LocalQueues[ThreadInfo.Index] : State.SharedQueue;
+        {
+            std::lock_guard<std::mutex> Lock{Queue.Mtx};
+            Queue.Tasks.emplace_back(std::move(Task));
+        }
+
+        // Both operations are sequentially consistent, as are the increment of NumSleepingThreads and
+        // the check of NumQueuedTasks in WorkerThreadFunc(), so either an idle thread sees the new task,
+        // or we see that the thread is going to sleep.
+        State.NumQueuedTasks.fetch_add(1);
+        if (State.NumSleepingThreads.load() > 0)
+        {
+            // The worker thread checks the number of queued tasks while holding the mutex, and the mutex
+            // is only released when the thread is blocked by the condition variable.
+            {
+                std::lock_guard<std::mutex> Lock{State.Mtx};
+            }
+            State.TaskAvailableCV.notify_one();
+        }
+    }
+
+    /// Blocks until all enqueued tasks have finished executing.
+    /// This method must not be called from a worker thread of the pool.
+    void WaitForAllTasks()
+    {
+        VERIFY(GetThisThreadInfo().pState != m_pState.get(), "Waiting for all tasks from a worker thread of the same pool will cause a deadlock");
+        std::unique_lock<std::mutex> Lock{m_pState->Mtx};
+        m_pState->TasksFinishedCV.wait(Lock, [this] { return m_pState->NumPendingTasks.load() == 0; });
+    }
+
+    Uint32 GetThreadCount() const
+    {
+        return static_cast<Uint32>(m_Threads.size());
+    }
+
+    /// Returns the number of hardware threads minus one (to leave a core for the
+    /// thread that enqueues the tasks), but at least one.
+    static Uint32 GetDefaultThreadCount()
+    {
+        const auto NumCores = std::thread::hardware_concurrency();
+        return std::max(NumCores, 2u) - 1u;
+    }
+
+private:
+    struct TaskQueue
+    {
+        std::mutex           Mtx;
+        std::deque<TaskType> Tasks;
+    };
+
+    struct SharedState
+    {
+        explicit SharedState(size_t NumThreads) :
+            LocalQueues(NumThreads)
+        {}
+
+        // Protects the sleeping state of the worker threads and the waiting in WaitForAllTasks()
+        std::mutex              Mtx;
+        std::condition_variable TaskAvailableCV;
+        std::condition_variable TasksFinishedCV;
+
+        // Tasks enqueued by the threads that do not belong to the pool
+        TaskQueue SharedQueue;
+        // Every worker thread's own queue
+        std::vector<TaskQueue> LocalQueues;
+
+        // The number of tasks in all queues. It may briefly go negative as it
+        // is incremented after the task is added to the queue.
+        std::atomic<int>    NumQueuedTasks{0};
+        std::atomic<size_t> NumPendingTasks{0};
+        std::atomic<int>    NumSleepingThreads{0};
+        std::atomic<bool>   Stop{false};
+    };
+
+    struct WorkerThreadInfo
+    {
+        // The pool the current thread belongs to, or null if the thread is not a worker thread
+        const SharedState* pState = nullptr;
+        size_t             Index  = 0;
+    };
+
+    static WorkerThreadInfo& GetThisThreadInfo()
+    {
+        static thread_local WorkerThreadInfo ThreadInfo;
+        return ThreadInfo;
+    }
+
+    static bool PopTask(TaskQueue& Queue, bool FromBack, TaskType& Task)
+    {
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        if (Queue.Tasks.empty())
+            return false;
+
+        if (FromBack)
+        {
+            Task = std::move(Queue.Tasks.back());
+            Queue.Tasks.pop_back();
+        }
+        else
+        {
+            Task = std::move(Queue.Tasks.front());
+            Queue.Tasks.pop_front();
+        }
+        return true;
+    }
+
+    static bool FindTask(SharedState& State, size_t ThreadIndex, TaskType& Task)
+    {
+        if (State.NumQueuedTasks.load() <= 0)
+            return false;
+
+        // The most recent task from the own queue, then the oldest task from the shared queue
+        bool Found = PopTask(State.LocalQueues[ThreadIndex], true, Task) || PopTask(State.SharedQueue, false, Task);
+
+        // Steal the oldest task from another thread
+        const auto NumThreads = State.LocalQueues.size();
+        for (size_t i = 1; i < NumThreads && !Found; ++i)
+            Found = PopTask(State.LocalQueues[(ThreadIndex + i) % NumThreads], false, Task);
+
+        if (Found)
+            State.NumQueuedTasks.fetch_sub(1);
+        return Found;
+    }
+
+    static void WorkerThreadFunc(std::shared_ptr<SharedState> pState, size_t ThreadIndex)
+    {
+        auto& ThreadInfo  = GetThisThreadInfo();
+        ThreadInfo.pState = pState.get();
+        ThreadInfo.Index  = ThreadIndex;
+
+        auto& State = *pState;
+        while (true)
+        {
+            TaskType Task;
+            if (!FindTask(State, ThreadIndex, Task))
+            {
+                std::unique_lock<std::mutex> Lock{State.Mtx};
+                if (State.Stop.load() && State.NumQueuedTasks.load() <= 0)
+                    break;
+
+                State.NumSleepingThreads.fetch_add(1);
+                State.TaskAvailableCV.wait(Lock, [&State] { return State.Stop.load() || State.NumQueuedTasks.load() > 0; });
+                State.NumSleepingThreads.fetch_sub(1);
+                continue;
+            }
+
+            Task();
+            // Release the resources held by the task before reporting completion
+            Task = nullptr;
+
+            VERIFY_EXPR(State.NumPendingTasks.load() > 0);
+            if (State.NumPendingTasks.fetch_sub(1) == 1)
+            {
+                // Acquire the mutex to make sure that the thread in WaitForAllTasks() is either
+                // blocked by the condition variable or will see the updated value.
+                {
+                    std::lock_guard<std::mutex> Lock{State.Mtx};
+                }
+                State.TasksFinishedCV.notify_all();
+            }
+        }
+
+        ThreadInfo = WorkerThreadInfo{};
+    }
+
+    std::shared_ptr<SharedState> m_pState;
+    std::vector<std::thread>     m_Threads;
+};
+
+/// Adds a task to the pool represented by the IThreadPool interface.
+inline void EnqueueTask(IThreadPool* pThreadPool, ThreadPool::TaskType&& Task)
+{
+    VERIFY_EXPR(pThreadPool != nullptr && Task);
+    auto* pTask = new ThreadPool::TaskType{std::move(Task)};
+    pThreadPool->EnqueueTask(
+        [](void* pUserData) {
+            std::unique_ptr<ThreadPool::TaskType> pTask{static_cast<ThreadPool::TaskType*>(pUserData)};
+            (*pTask)();
+        },
+        pTask);
+}
+
+/// Creates a thread pool object that implements the IThreadPool interface.
+void CreateThreadPool(const ThreadPoolCreateInfo& CreateInfo, IThreadPool** ppThreadPool);
+
+} // namespace Diligent
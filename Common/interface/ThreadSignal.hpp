@@ -32,34 +32,44 @@
 #include <atomic>
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "LockHelper.hpp"
 
 namespace ThreadingTools
 {
 
+// Signal fast paths are lock-free: Wait() returns without touching the mutex when the signal
+// is already triggered, and Trigger() only acquires the mutex when there are threads that
+// are sleeping on the condition variable. A waiting thread spins with exponential backoff
+// for a short while before it parks.
 class Signal
 {
 public:
+    static constexpr const int DefaultSpinCount = 128;
+
     Signal()
     {
         m_SignaledValue.store(0);
         m_NumThreadsAwaken.store(0);
+        m_NumSleepingThreads.store(0);
     }
 
-    // http://en.cppreference.com/w/cpp/thread/condition_variable
     void Trigger(bool NotifyAll = false, int SignalValue = 1)
     {
         VERIFY(SignalValue != 0, "Signal value must not be zero");
+        VERIFY(m_SignaledValue.load() == 0 && m_NumThreadsAwaken.load() == 0, "Not all threads have been awaken since the signal was triggered last time, or the signal has not been reset");
+
+        // Both the store and the load below are sequentially consistent, as are the increment of
+        // m_NumSleepingThreads and the check of m_SignaledValue in Wait(). Thus either
+        // the waiting thread sees the new value, or we see that the thread is about to sleep.
+        m_SignaledValue.store(SignalValue);
+        if (m_NumSleepingThreads.load() == 0)
+            return;
 
-        //  The thread that intends to modify the variable has to
-        //  * acquire a std::mutex (typically via std::lock_guard)
-        //  * perform the modification while the lock is held
-        //  * execute notify_one or notify_all on the std::condition_variable (the lock does not need to be held for notification)
+        // The waiting thread increments m_NumSleepingThreads and checks the value while holding
+        // the mutex, and the mutex is only released when the thread is blocked by the condition variable.
+        // Acquiring the mutex here guarantees that the notification is not lost.
         {
-            // std::condition_variable works only with std::unique_lock<std::mutex>
             std::lock_guard<std::mutex> Lock{m_Mutex};
-            VERIFY(SignalValue != 0, "Signal value must not be 0");
-            VERIFY(m_SignaledValue.load() == 0 && m_NumThreadsAwaken.load() == 0, "Not all threads have been awaken since the signal was triggered last time, or the signal has not been reset");
-            m_SignaledValue.store(SignalValue);
         }
         // Unlocking is done before notifying, to avoid waking up the waiting
         // thread only to block again (see notify_one for details)
@@ -75,35 +85,39 @@ public:
     // go through the loop twice. In this case, every thread must wait for its
     // own auto-reset signal or the threads must be blocked by another signal
 
-    int Wait(bool AutoReset = false, int NumThreadsWaiting = 0)
+    int Wait(bool AutoReset = false, int NumThreadsWaiting = 0, int SpinCount = DefaultSpinCount)
     {
-        //  Any thread that intends to wait on std::condition_variable has to
-        //  * acquire a std::unique_lock<std::mutex>, on the SAME MUTEX as used to protect the shared variable
-        //  * execute wait, wait_for, or wait_until. The wait operations atomically release the mutex
-        //    and suspend the execution of the thread.
-        //  * When the condition variable is notified, a timeout expires, or a spurious wakeup occurs,
-        //    the thread is awakened, and the mutex is atomically reacquired:
-        //    - The thread should then check the condition and resume waiting if the wake up was spurious.
-        std::unique_lock<std::mutex> Lock(m_Mutex);
-        // It is safe to check m_SignaledValue since we are holding
-        // the mutex
-        if (m_SignaledValue.load() == 0)
+        auto SignaledValue = m_SignaledValue.load();
+        if (SignaledValue == 0)
         {
-            m_CondVar.wait(Lock, [&] { return m_SignaledValue.load() != 0; });
+            SpinBackoff Backoff{SpinCount};
+            while (Backoff.IsSpinning() && SignaledValue == 0)
+            {
+                Backoff.Spin();
+                SignaledValue = m_SignaledValue.load();
+            }
         }
-        auto SignaledValue = m_SignaledValue.load();
-        // Update the number of threads awaken while holding the mutex
-        const auto NumThreadsAwaken = m_NumThreadsAwaken.fetch_add(1) + 1;
+
+        if (SignaledValue == 0)
+        {
+            std::unique_lock<std::mutex> Lock{m_Mutex};
+            m_NumSleepingThreads.fetch_add(1);
+            m_CondVar.wait(Lock, [&] { SignaledValue = m_SignaledValue.load(); return SignaledValue != 0; });
+            m_NumSleepingThreads.fetch_sub(1);
+        }
+
         // fetch_add returns the original value immediately preceding the addition.
+        const auto NumThreadsAwaken = m_NumThreadsAwaken.fetch_add(1) + 1;
         if (AutoReset)
         {
             VERIFY(NumThreadsWaiting > 0, "Number of waiting threads must not be 0 when auto resetting the signal");
-            // Reset the signal while holding the mutex. If Trigger() is executed by another
-            // thread, it will wait until we release the mutex
+            // The last awaken thread resets the signal. The counter is reset first so that
+            // Trigger() called by another thread right after the signal value is cleared
+            // finds the signal in the consistent state.
             if (NumThreadsAwaken == NumThreadsWaiting)
             {
-                m_SignaledValue.store(0);
                 m_NumThreadsAwaken.store(0);
+                m_SignaledValue.store(0);
             }
         }
         return SignaledValue;
@@ -111,9 +125,8 @@ public:
 
     void Reset()
     {
-        std::lock_guard<std::mutex> Lock{m_Mutex};
-        m_SignaledValue.store(0);
         m_NumThreadsAwaken.store(0);
+        m_SignaledValue.store(0);
     }
 
     bool IsTriggered() const { return m_SignaledValue.load() != 0; }
@@ -123,6 +136,7 @@ private:
     std::condition_variable m_CondVar;
     std::atomic_int         m_SignaledValue{0};
     std::atomic_int         m_NumThreadsAwaken{0};
+    std::atomic_int         m_NumSleepingThreads{0};
 
     Signal(const Signal&) = delete;
     Signal& operator=(const Signal&) = delete;
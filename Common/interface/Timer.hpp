@@ -41,7 +41,7 @@ public:
     float  GetElapsedTimef() const;
 
 private:
-    std::chrono::high_resolution_clock::time_point m_StartTime;
+    std::chrono::steady_clock::time_point m_StartTime;
 };
 
 } // namespace Diligent
@@ -0,0 +1,522 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#if defined(__AVX__)
+#    define DILIGENT_ADVANCED_MATH_AVX 1
+#    include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_ADVANCED_MATH_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define DILIGENT_ADVANCED_MATH_NEON 1
+#    include <arm_neon.h>
+#endif
+
+#include "AdvancedMath.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+#if DILIGENT_ADVANCED_MATH_AVX
+
+struct SIMD
+{
+    static constexpr Uint32 Width = 8;
+
+    using Float = __m256;
+    using Mask  = __m256;
+
+    // clang-format off
+    static Float Load(const float* p)            { return _mm256_loadu_ps(p); }
+    static void  Store(float* p, Float v)        { _mm256_storeu_ps(p, v); }
+    static Float Set1(float f)                   { return _mm256_set1_ps(f); }
+    static Float FloatZero()                     { return _mm256_setzero_ps(); }
+    static Float Add(Float a, Float b)           { return _mm256_add_ps(a, b); }
+    static Float Sub(Float a, Float b)           { return _mm256_sub_ps(a, b); }
+    static Float Mul(Float a, Float b)           { return _mm256_mul_ps(a, b); }
+    static Float Div(Float a, Float b)           { return _mm256_div_ps(a, b); }
+    static Float Min(Float a, Float b)           { return _mm256_min_ps(a, b); }
+    static Float Max(Float a, Float b)           { return _mm256_max_ps(a, b); }
+    static Float Abs(Float a)                    { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Float Select(Mask m, Float a, Float b){ return _mm256_blendv_ps(b, a, m); } // m ? a : b
+    static Mask  Less(Float a, Float b)          { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask  LessEqual(Float a, Float b)     { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static Mask  Greater(Float a, Float b)       { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask  GreaterEqual(Float a, Float b)  { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask  Zero()                          { return _mm256_setzero_ps(); }
+    static Mask  AllOnes()                       { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static Mask  Or(Mask a, Mask b)              { return _mm256_or_ps(a, b); }
+    static Mask  And(Mask a, Mask b)             { return _mm256_and_ps(a, b); }
+    static Mask  AndNot(Mask a, Mask b)          { return _mm256_andnot_ps(a, b); } // ~a & b
+    static Uint32 MoveMask(Mask m)               { return static_cast<Uint32>(_mm256_movemask_ps(m)); }
+    // clang-format on
+};
+
+#elif DILIGENT_ADVANCED_MATH_SSE2
+
+struct SIMD
+{
+    static constexpr Uint32 Width = 4;
+
+    using Float = __m128;
+    using Mask  = __m128;
+
+    // clang-format off
+    static Float Load(const float* p)            { return _mm_loadu_ps(p); }
+    static void  Store(float* p, Float v)        { _mm_storeu_ps(p, v); }
+    static Float Set1(float f)                   { return _mm_set1_ps(f); }
+    static Float FloatZero()                     { return _mm_setzero_ps(); }
+    static Float Add(Float a, Float b)           { return _mm_add_ps(a, b); }
+    static Float Sub(Float a, Float b)           { return _mm_sub_ps(a, b); }
+    static Float Mul(Float a, Float b)           { return _mm_mul_ps(a, b); }
+    static Float Div(Float a, Float b)           { return _mm_div_ps(a, b); }
+    static Float Min(Float a, Float b)           { return _mm_min_ps(a, b); }
+    static Float Max(Float a, Float b)           { return _mm_max_ps(a, b); }
+    static Float Abs(Float a)                    { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Float Select(Mask m, Float a, Float b){ return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); } // m ? a : b
+    static Mask  Less(Float a, Float b)          { return _mm_cmplt_ps(a, b); }
+    static Mask  LessEqual(Float a, Float b)     { return _mm_cmple_ps(a, b); }
+    static Mask  Greater(Float a, Float b)       { return _mm_cmpgt_ps(a, b); }
+    static Mask  GreaterEqual(Float a, Float b)  { return _mm_cmpge_ps(a, b); }
+    static Mask  Zero()                          { return _mm_setzero_ps(); }
+    static Mask  AllOnes()                       { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static Mask  Or(Mask a, Mask b)              { return _mm_or_ps(a, b); }
+    static Mask  And(Mask a, Mask b)             { return _mm_and_ps(a, b); }
+    static Mask  AndNot(Mask a, Mask b)          { return _mm_andnot_ps(a, b); } // ~a & b
+    static Uint32 MoveMask(Mask m)               { return static_cast<Uint32>(_mm_movemask_ps(m)); }
+    // clang-format on
+};
+
+#elif DILIGENT_ADVANCED_MATH_NEON
+
+struct SIMD
+{
+    static constexpr Uint32 Width = 4;
+
+    using Float = float32x4_t;
+    using Mask  = uint32x4_t;
+
+    // clang-format off
+    static Float Load(const float* p)            { return vld1q_f32(p); }
+    static void  Store(float* p, Float v)        { vst1q_f32(p, v); }
+    static Float Set1(float f)                   { return vdupq_n_f32(f); }
+    static Float FloatZero()                     { return vdupq_n_f32(0.f); }
+    static Float Add(Float a, Float b)           { return vaddq_f32(a, b); }
+    static Float Sub(Float a, Float b)           { return vsubq_f32(a, b); }
+    static Float Mul(Float a, Float b)           { return vmulq_f32(a, b); }
+    static Float Min(Float a, Float b)           { return vminq_f32(a, b); }
+    static Float Max(Float a, Float b)           { return vmaxq_f32(a, b); }
+    static Float Abs(Float a)                    { return vabsq_f32(a); }
+    static Float Select(Mask m, Float a, Float b){ return vbslq_f32(m, a, b); } // m ? a : b
+    static Mask  Less(Float a, Float b)          { return vcltq_f32(a, b); }
+    static Mask  LessEqual(Float a, Float b)     { return vcleq_f32(a, b); }
+    static Mask  Greater(Float a, Float b)       { return vcgtq_f32(a, b); }
+    static Mask  GreaterEqual(Float a, Float b)  { return vcgeq_f32(a, b); }
+    static Mask  Zero()                          { return vdupq_n_u32(0); }
+    static Mask  AllOnes()                       { return vdupq_n_u32(~0u); }
+    static Mask  Or(Mask a, Mask b)              { return vorrq_u32(a, b); }
+    static Mask  And(Mask a, Mask b)             { return vandq_u32(a, b); }
+    static Mask  AndNot(Mask a, Mask b)          { return vbicq_u32(b, a); } // ~a & b
+    // clang-format on
+
+    static Float Div(Float a, Float b)
+    {
+#    if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32(a, b);
+#    else
+        // ARMv7 NEON has no division instruction
+        float va[4], vb[4];
+        vst1q_f32(va, a);
+        vst1q_f32(vb, b);
+        for (int i = 0; i < 4; ++i)
+            va[i] /= vb[i];
+        return vld1q_f32(va);
+#    endif
+    }
+
+    static Uint32 MoveMask(Mask m)
+    {
+        static const uint32_t LaneBits[4] = {1, 2, 4, 8};
+
+        const uint32x4_t Bits = vandq_u32(m, vld1q_u32(LaneBits));
+        const uint32x2_t Sum  = vpadd_u32(vget_low_u32(Bits), vget_high_u32(Bits));
+        return vget_lane_u32(vpadd_u32(Sum, Sum), 0);
+    }
+};
+
+#endif
+
+// Plane data prepared for the batch test
+struct BatchPlane
+{
+    // Coordinate arrays of the farthest (Max) and nearest (Min) box corners along the plane normal
+    const float* MaxPointX;
+    const float* MaxPointY;
+    const float* MaxPointZ;
+    const float* MinPointX;
+    const float* MinPointY;
+    const float* MinPointZ;
+
+    Plane3D Plane;
+};
+
+Uint32 PrepareBatchPlanes(const ViewFrustum& Frustum, const BoundBoxBatch& Boxes, FRUSTUM_PLANE_FLAGS PlaneFlags, BatchPlane Planes[])
+{
+    Uint32 NumPlanes = 0;
+    for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+    {
+        if ((PlaneFlags & (1 << plane_idx)) == 0)
+            continue;
+
+        auto& Plane = Planes[NumPlanes++];
+
+        Plane.Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+        const auto& Normal = Plane.Plane.Normal;
+        // Same selection as in GetBoxVisibilityAgainstPlane()
+        Plane.MaxPointX = Normal.x > 0 ? Boxes.MaxX : Boxes.MinX;
+        Plane.MaxPointY = Normal.y > 0 ? Boxes.MaxY : Boxes.MinY;
+        Plane.MaxPointZ = Normal.z > 0 ? Boxes.MaxZ : Boxes.MinZ;
+        Plane.MinPointX = Normal.x > 0 ? Boxes.MinX : Boxes.MaxX;
+        Plane.MinPointY = Normal.y > 0 ? Boxes.MinY : Boxes.MaxY;
+        Plane.MinPointZ = Normal.z > 0 ? Boxes.MinZ : Boxes.MaxZ;
+    }
+    return NumPlanes;
+}
+
+void GetBoxVisibilityBatchImpl(const ViewFrustum&    Frustum,
+                               const ViewFrustumExt* pFrustumExt,
+                               const BoundBoxBatch&  Boxes,
+                               size_t                NumBoxes,
+                               Uint32*               pVisibleMask,
+                               Uint32*               pFullyVisibleMask,
+                               FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    VERIFY_EXPR(pVisibleMask != nullptr);
+    VERIFY_EXPR(NumBoxes == 0 || (Boxes.MinX != nullptr && Boxes.MinY != nullptr && Boxes.MinZ != nullptr && Boxes.MaxX != nullptr && Boxes.MaxY != nullptr && Boxes.MaxZ != nullptr));
+
+    const size_t NumWords = (NumBoxes + 31) / 32;
+    for (size_t w = 0; w < NumWords; ++w)
+    {
+        pVisibleMask[w] = 0;
+        if (pFullyVisibleMask != nullptr)
+            pFullyVisibleMask[w] = 0;
+    }
+
+    // The corner test is only performed by GetBoxVisibility(const ViewFrustumExt&) when all planes are tested
+    if ((PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+        pFrustumExt = nullptr;
+
+    size_t box = 0;
+
+#if DILIGENT_ADVANCED_MATH_AVX || DILIGENT_ADVANCED_MATH_SSE2 || DILIGENT_ADVANCED_MATH_NEON
+    BatchPlane Planes[ViewFrustum::NUM_PLANES];
+
+    const auto NumPlanes = PrepareBatchPlanes(Frustum, Boxes, PlaneFlags, Planes);
+
+    // Bounding box of the frustum corners. The box is outside of the frustum if the frustum
+    // is entirely on the outer side of one of the box planes.
+    float3 FrustumMin, FrustumMax;
+    if (pFrustumExt != nullptr)
+    {
+        FrustumMin = FrustumMax = pFrustumExt->FrustumCorners[0];
+        for (size_t i = 1; i < _countof(pFrustumExt->FrustumCorners); ++i)
+        {
+            FrustumMin = std::min(FrustumMin, pFrustumExt->FrustumCorners[i]);
+            FrustumMax = std::max(FrustumMax, pFrustumExt->FrustumCorners[i]);
+        }
+    }
+
+    constexpr Uint32 AllLanes = (1u << SIMD::Width) - 1u;
+    for (; box + SIMD::Width <= NumBoxes; box += SIMD::Width)
+    {
+        auto Invisible      = SIMD::Zero();
+        auto NotFullyInside = SIMD::Zero();
+        for (Uint32 p = 0; p < NumPlanes; ++p)
+        {
+            const auto& Plane = Planes[p];
+
+            const auto Nx = SIMD::Set1(Plane.Plane.Normal.x);
+            const auto Ny = SIMD::Set1(Plane.Plane.Normal.y);
+            const auto Nz = SIMD::Set1(Plane.Plane.Normal.z);
+            const auto D  = SIMD::Set1(Plane.Plane.Distance);
+
+            // Same evaluation order as dot(MaxPoint, Normal) + Plane.Distance
+            const auto DMax = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(SIMD::Load(Plane.MaxPointX + box), Nx),
+                                                            SIMD::Mul(SIMD::Load(Plane.MaxPointY + box), Ny)),
+                                                  SIMD::Mul(SIMD::Load(Plane.MaxPointZ + box), Nz)),
+                                        D);
+            Invisible = SIMD::Or(Invisible, SIMD::Less(DMax, SIMD::FloatZero()));
+
+            // All boxes in the batch are behind one of the planes
+            if (SIMD::MoveMask(Invisible) == AllLanes)
+                break;
+
+            const auto DMin = SIMD::Add(SIMD::Add(SIMD::Add(SIMD::Mul(SIMD::Load(Plane.MinPointX + box), Nx),
+                                                            SIMD::Mul(SIMD::Load(Plane.MinPointY + box), Ny)),
+                                                  SIMD::Mul(SIMD::Load(Plane.MinPointZ + box), Nz)),
+                                        D);
+            NotFullyInside = SIMD::Or(NotFullyInside, SIMD::AndNot(SIMD::Greater(DMin, SIMD::FloatZero()), SIMD::AllOnes()));
+        }
+
+        if (pFrustumExt != nullptr)
+        {
+            const auto Intersecting = SIMD::AndNot(Invisible, NotFullyInside);
+            if (SIMD::MoveMask(Intersecting) != 0)
+            {
+                auto Overlap = SIMD::And(SIMD::Greater(SIMD::Set1(FrustumMax.x), SIMD::Load(Boxes.MinX + box)),
+                                         SIMD::Greater(SIMD::Load(Boxes.MaxX + box), SIMD::Set1(FrustumMin.x)));
+                Overlap      = SIMD::And(Overlap, SIMD::Greater(SIMD::Set1(FrustumMax.y), SIMD::Load(Boxes.MinY + box)));
+                Overlap      = SIMD::And(Overlap, SIMD::Greater(SIMD::Load(Boxes.MaxY + box), SIMD::Set1(FrustumMin.y)));
+                Overlap      = SIMD::And(Overlap, SIMD::Greater(SIMD::Set1(FrustumMax.z), SIMD::Load(Boxes.MinZ + box)));
+                Overlap      = SIMD::And(Overlap, SIMD::Greater(SIMD::Load(Boxes.MaxZ + box), SIMD::Set1(FrustumMin.z)));
+                Invisible    = SIMD::Or(Invisible, SIMD::AndNot(Overlap, Intersecting));
+            }
+        }
+
+        const auto Shift         = static_cast<Uint32>(box % 32);
+        const auto InvisibleBits = SIMD::MoveMask(Invisible);
+        pVisibleMask[box / 32] |= (~InvisibleBits & AllLanes) << Shift;
+        if (pFullyVisibleMask != nullptr)
+            pFullyVisibleMask[box / 32] |= (~(InvisibleBits | SIMD::MoveMask(NotFullyInside)) & AllLanes) << Shift;
+    }
+#endif
+
+    // Remaining boxes
+    for (; box < NumBoxes; ++box)
+    {
+        BoundBox Box;
+        Box.Min = float3{Boxes.MinX[box], Boxes.MinY[box], Boxes.MinZ[box]};
+        Box.Max = float3{Boxes.MaxX[box], Boxes.MaxY[box], Boxes.MaxZ[box]};
+
+        const auto Visibility = pFrustumExt != nullptr ?
+            GetBoxVisibility(*pFrustumExt, Box, PlaneFlags) :
+            GetBoxVisibility(Frustum, Box, PlaneFlags);
+
+        const auto Bit = 1u << static_cast<Uint32>(box % 32);
+        if (Visibility != BoxVisibility::Invisible)
+            pVisibleMask[box / 32] |= Bit;
+        if (Visibility == BoxVisibility::FullyVisible && pFullyVisibleMask != nullptr)
+            pFullyVisibleMask[box / 32] |= Bit;
+    }
+}
+
+} // namespace
+
+void GetBoxVisibilityBatch(const ViewFrustum&   Frustum,
+                           const BoundBoxBatch& Boxes,
+                           size_t               NumBoxes,
+                           Uint32*              pVisibleMask,
+                           Uint32*              pFullyVisibleMask,
+                           FRUSTUM_PLANE_FLAGS  PlaneFlags)
+{
+    GetBoxVisibilityBatchImpl(Frustum, nullptr, Boxes, NumBoxes, pVisibleMask, pFullyVisibleMask, PlaneFlags);
+}
+
+void GetBoxVisibilityBatch(const ViewFrustumExt& Frustum,
+                           const BoundBoxBatch&  Boxes,
+                           size_t                NumBoxes,
+                           Uint32*               pVisibleMask,
+                           Uint32*               pFullyVisibleMask,
+                           FRUSTUM_PLANE_FLAGS   PlaneFlags)
+{
+    GetBoxVisibilityBatchImpl(Frustum, &Frustum, Boxes, NumBoxes, pVisibleMask, pFullyVisibleMask, PlaneFlags);
+}
+
+void IntersectRayBatchAABB(const RayBatch& Rays,
+                           size_t          NumRays,
+                           const BoundBox& AABB,
+                           Uint32*         pHitMask,
+                           float*          pEnterDist,
+                           float*          pExitDist)
+{
+    VERIFY_EXPR(pHitMask != nullptr);
+    VERIFY_EXPR(NumRays == 0 || (Rays.OriginX != nullptr && Rays.OriginY != nullptr && Rays.OriginZ != nullptr && Rays.DirectionX != nullptr && Rays.DirectionY != nullptr && Rays.DirectionZ != nullptr));
+
+    for (size_t w = 0; w < (NumRays + 31) / 32; ++w)
+        pHitMask[w] = 0;
+
+    size_t ray = 0;
+
+#if DILIGENT_ADVANCED_MATH_AVX || DILIGENT_ADVANCED_MATH_SSE2 || DILIGENT_ADVANCED_MATH_NEON
+    const auto Epsilon = SIMD::Set1(1e-20f);
+    const auto PosMax  = SIMD::Set1(+FLT_MAX);
+    const auto NegMax  = SIMD::Set1(-FLT_MAX);
+
+    // Returns the distances to the box slab planes along one axis
+    auto GetSlabDistances = [&](const float* Origin, const float* Direction, float BoxMin, float BoxMax, SIMD::Float& tEnter, SIMD::Float& tExit) {
+        const auto O = SIMD::Load(Origin + ray);
+        const auto D = SIMD::Load(Direction + ray);
+
+        const auto IsValidDir = SIMD::Greater(SIMD::Abs(D), Epsilon);
+
+        const auto t_min = SIMD::Select(IsValidDir, SIMD::Div(SIMD::Sub(SIMD::Set1(BoxMin), O), D), PosMax);
+        const auto t_max = SIMD::Select(IsValidDir, SIMD::Div(SIMD::Sub(SIMD::Set1(BoxMax), O), D), NegMax);
+
+        // Same as std::min(t_min, t_max) and std::max(t_min, t_max)
+        tEnter = SIMD::Min(t_max, t_min);
+        tExit  = SIMD::Max(t_max, t_min);
+    };
+
+    for (; ray + SIMD::Width <= NumRays; ray += SIMD::Width)
+    {
+        SIMD::Float EnterX, ExitX, EnterY, ExitY, EnterZ, ExitZ;
+        GetSlabDistances(Rays.OriginX, Rays.DirectionX, AABB.Min.x, AABB.Max.x, EnterX, ExitX);
+        GetSlabDistances(Rays.OriginY, Rays.DirectionY, AABB.Min.y, AABB.Max.y, EnterY, ExitY);
+        GetSlabDistances(Rays.OriginZ, Rays.DirectionZ, AABB.Min.z, AABB.Max.z, EnterZ, ExitZ);
+
+        // Same as max3() and min3()
+        const auto EnterDist = SIMD::Max(EnterZ, SIMD::Max(EnterY, EnterX));
+        const auto ExitDist  = SIMD::Min(ExitZ, SIMD::Min(ExitY, ExitX));
+
+        const auto Hit = SIMD::And(SIMD::GreaterEqual(ExitDist, SIMD::FloatZero()), SIMD::LessEqual(EnterDist, ExitDist));
+
+        pHitMask[ray / 32] |= SIMD::MoveMask(Hit) << static_cast<Uint32>(ray % 32);
+        if (pEnterDist != nullptr)
+            SIMD::Store(pEnterDist + ray, EnterDist);
+        if (pExitDist != nullptr)
+            SIMD::Store(pExitDist + ray, ExitDist);
+    }
+#endif
+
+    // Remaining rays
+    for (; ray < NumRays; ++ray)
+    {
+        const float3 RayOrigin{Rays.OriginX[ray], Rays.OriginY[ray], Rays.OriginZ[ray]};
+        const float3 RayDirection{Rays.DirectionX[ray], Rays.DirectionY[ray], Rays.DirectionZ[ray]};
+
+        float EnterDist, ExitDist;
+        if (IntersectRayAABB(RayOrigin, RayDirection, AABB, EnterDist, ExitDist))
+            pHitMask[ray / 32] |= 1u << static_cast<Uint32>(ray % 32);
+        if (pEnterDist != nullptr)
+            pEnterDist[ray] = EnterDist;
+        if (pExitDist != nullptr)
+            pExitDist[ray] = ExitDist;
+    }
+}
+
+void IntersectRayTriangleBatch(const float3&        RayOrigin,
+                               const float3&        RayDirection,
+                               const TriangleBatch& Triangles,
+                               size_t               NumTriangles,
+                               float*               pDistances,
+                               bool                 CullBackFace)
+{
+    VERIFY_EXPR(pDistances != nullptr);
+    VERIFY_EXPR(NumTriangles == 0 ||
+                (Triangles.V0X != nullptr && Triangles.V0Y != nullptr && Triangles.V0Z != nullptr &&
+                 Triangles.V1X != nullptr && Triangles.V1Y != nullptr && Triangles.V1Z != nullptr &&
+                 Triangles.V2X != nullptr && Triangles.V2Y != nullptr && Triangles.V2Z != nullptr));
+
+    size_t tri = 0;
+
+#if DILIGENT_ADVANCED_MATH_AVX || DILIGENT_ADVANCED_MATH_SSE2 || DILIGENT_ADVANCED_MATH_NEON
+    const auto Ox = SIMD::Set1(RayOrigin.x);
+    const auto Oy = SIMD::Set1(RayOrigin.y);
+    const auto Oz = SIMD::Set1(RayOrigin.z);
+    const auto Dx = SIMD::Set1(RayDirection.x);
+    const auto Dy = SIMD::Set1(RayDirection.y);
+    const auto Dz = SIMD::Set1(RayDirection.z);
+
+    const auto Zero    = SIMD::FloatZero();
+    const auto One     = SIMD::Set1(1.f);
+    const auto PosEps  = SIMD::Set1(+1e-10f);
+    const auto NegEps  = SIMD::Set1(-1e-10f);
+    const auto PosMax  = SIMD::Set1(+FLT_MAX);
+    const auto NoCull  = CullBackFace ? SIMD::Zero() : SIMD::AllOnes();
+    const auto Dot3    = [](SIMD::Float ax, SIMD::Float ay, SIMD::Float az, SIMD::Float bx, SIMD::Float by, SIMD::Float bz) {
+        return SIMD::Add(SIMD::Add(SIMD::Mul(ax, bx), SIMD::Mul(ay, by)), SIMD::Mul(az, bz));
+    };
+
+    // Same operation order as in IntersectRayTriangle()
+    for (; tri + SIMD::Width <= NumTriangles; tri += SIMD::Width)
+    {
+        const auto V0x = SIMD::Load(Triangles.V0X + tri);
+        const auto V0y = SIMD::Load(Triangles.V0Y + tri);
+        const auto V0z = SIMD::Load(Triangles.V0Z + tri);
+
+        const auto E1x = SIMD::Sub(SIMD::Load(Triangles.V1X + tri), V0x);
+        const auto E1y = SIMD::Sub(SIMD::Load(Triangles.V1Y + tri), V0y);
+        const auto E1z = SIMD::Sub(SIMD::Load(Triangles.V1Z + tri), V0z);
+        const auto E2x = SIMD::Sub(SIMD::Load(Triangles.V2X + tri), V0x);
+        const auto E2y = SIMD::Sub(SIMD::Load(Triangles.V2Y + tri), V0y);
+        const auto E2z = SIMD::Sub(SIMD::Load(Triangles.V2Z + tri), V0z);
+
+        // PVec = cross(RayDirection, V0_V2)
+        const auto Px = SIMD::Sub(SIMD::Mul(Dy, E2z), SIMD::Mul(Dz, E2y));
+        const auto Py = SIMD::Sub(SIMD::Mul(Dz, E2x), SIMD::Mul(Dx, E2z));
+        const auto Pz = SIMD::Sub(SIMD::Mul(Dx, E2y), SIMD::Mul(Dy, E2x));
+
+        const auto Det = Dot3(E1x, E1y, E1z, Px, Py, Pz);
+
+        auto Hit = SIMD::Or(SIMD::Greater(Det, PosEps), SIMD::And(NoCull, SIMD::Less(Det, NegEps)));
+        if (SIMD::MoveMask(Hit) == 0)
+        {
+            SIMD::Store(pDistances + tri, PosMax);
+            continue;
+        }
+
+        // V0_RO = RayOrigin - V0
+        const auto Tx = SIMD::Sub(Ox, V0x);
+        const auto Ty = SIMD::Sub(Oy, V0y);
+        const auto Tz = SIMD::Sub(Oz, V0z);
+
+        const auto u = SIMD::Div(Dot3(Tx, Ty, Tz, Px, Py, Pz), Det);
+
+        // QVec = cross(V0_RO, V0_V1)
+        const auto Qx = SIMD::Sub(SIMD::Mul(Ty, E1z), SIMD::Mul(Tz, E1y));
+        const auto Qy = SIMD::Sub(SIMD::Mul(Tz, E1x), SIMD::Mul(Tx, E1z));
+        const auto Qz = SIMD::Sub(SIMD::Mul(Tx, E1y), SIMD::Mul(Ty, E1x));
+
+        const auto v = SIMD::Div(Dot3(Dx, Dy, Dz, Qx, Qy, Qz), Det);
+        const auto t = SIMD::Div(Dot3(E2x, E2y, E2z, Qx, Qy, Qz), Det);
+
+        Hit = SIMD::And(Hit, SIMD::And(SIMD::GreaterEqual(u, Zero), SIMD::LessEqual(u, One)));
+        Hit = SIMD::And(Hit, SIMD::And(SIMD::GreaterEqual(v, Zero), SIMD::LessEqual(SIMD::Add(u, v), One)));
+
+        SIMD::Store(pDistances + tri, SIMD::Select(Hit, t, PosMax));
+    }
+#endif
+
+    // Remaining triangles
+    for (; tri < NumTriangles; ++tri)
+    {
+        const float3 V0{Triangles.V0X[tri], Triangles.V0Y[tri], Triangles.V0Z[tri]};
+        const float3 V1{Triangles.V1X[tri], Triangles.V1Y[tri], Triangles.V1Z[tri]};
+        const float3 V2{Triangles.V2X[tri], Triangles.V2Y[tri], Triangles.V2Z[tri]};
+
+        pDistances[tri] = IntersectRayTriangle(V0, V1, V2, RayOrigin, RayDirection, CullBackFace);
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <memory>
+
+#include "AsyncFileReader.hpp"
+#include "BasicFileStream.hpp"
+#include "FileSystem.hpp"
+
+namespace Diligent
+{
+
+AsyncFileReader::~AsyncFileReader()
+{
+    // The tasks reference the reader
+    WaitForAllReads();
+}
+
+void AsyncFileReader::SetThreadPool(IThreadPool* pThreadPool)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_pThreadPool = pThreadPool;
+}
+
+void AsyncFileReader::ResetThreadPool(IThreadPool* pThreadPool)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (m_pThreadPool.RawPtr() == pThreadPool)
+        m_pThreadPool.Release();
+}
+
+RefCntAutoPtr<IThreadPool> AsyncFileReader::BeginRead()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (!m_pThreadPool)
+    {
+        ThreadPoolCreateInfo PoolCI;
+        PoolCI.NumThreads = DefaultThreadCount;
+        CreateThreadPool(PoolCI, &m_pThreadPool);
+    }
+    ++m_NumPendingReads;
+    return m_pThreadPool;
+}
+
+void AsyncFileReader::EndRead()
+{
+    // Notify under the lock as the reader may be destroyed as soon as the counter reaches zero
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    VERIFY_EXPR(m_NumPendingReads > 0);
+    if (--m_NumPendingReads == 0)
+        m_ReadsCompletedCV.notify_all();
+}
+
+void AsyncFileReader::WaitForAllReads()
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_ReadsCompletedCV.wait(Lock, [this]() { return m_NumPendingReads == 0; });
+}
+
+RefCntAutoPtr<IDataBlob> AsyncFileReader::ReadFileSync(const std::vector<std::string>& CandidatePaths)
+{
+    for (const auto& Path : CandidatePaths)
+    {
+        if (!FileSystem::FileExists(Path.c_str()))
+            continue;
+
+        RefCntAutoPtr<BasicFileStream> pStream{MakeNewRCObj<BasicFileStream>()(Path.c_str(), EFileAccessMode::Read)};
+        if (!pStream->IsValid())
+            continue;
+
+        // Use the basic stream rather than the mapped one: the purpose of the
+        // read is to fetch the data on the worker thread, while the mapped stream
+        // would defer the I/O to page faults in the consumer thread.
+        RefCntAutoPtr<IDataBlob> pData;
+        pStream->ReadBlob2(&pData);
+        return pData;
+    }
+
+    return {};
+}
+
+void AsyncFileReader::ReadFile(std::vector<std::string> CandidatePaths, CallbackType&& Callback)
+{
+    VERIFY_EXPR(Callback);
+    // std::function requires the task to be copyable, so move the arguments into a shared object
+    auto pArgs       = std::make_shared<std::pair<std::vector<std::string>, CallbackType>>(std::move(CandidatePaths), std::move(Callback));
+    auto pThreadPool = BeginRead();
+    EnqueueTask(pThreadPool,
+                [this, pArgs]() {
+                    auto pData = ReadFileSync(pArgs->first);
+                    pArgs->second(pData);
+                    EndRead();
+                });
+}
+
+void AsyncFileReader::ReadFile(std::string Path, CallbackType&& Callback)
+{
+    ReadFile(std::vector<std::string>{std::move(Path)}, std::move(Callback));
+}
+
+std::future<RefCntAutoPtr<IDataBlob>> AsyncFileReader::ReadFile(std::string Path)
+{
+    auto pPromise = std::make_shared<std::promise<RefCntAutoPtr<IDataBlob>>>();
+    auto Future   = pPromise->get_future();
+    ReadFile(std::move(Path),
+             [pPromise](IDataBlob* pData) {
+                 pPromise->set_value(RefCntAutoPtr<IDataBlob>{pData});
+             });
+    return Future;
+}
+
+AsyncFileReader& AsyncFileReader::GetSharedInstance()
+{
+    static AsyncFileReader Reader;
+    return Reader;
+}
+
+} // namespace Diligent
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include "BasicFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -51,6 +52,15 @@ void BasicFileStream::ReadBlob(Diligent::IDataBlob* pData)
     return m_FileWrpr->Read(pData);
 }
 
+void BasicFileStream::ReadBlob2(IDataBlob** ppData)
+{
+    VERIFY_EXPR(ppData != nullptr && *ppData == nullptr);
+    auto* pDataBlob = MakeNewRCObj<DataBlobImpl>{}(m_FileWrpr->GetSize() - m_FileWrpr->GetPos());
+    if (!m_FileWrpr->Read(pDataBlob->GetDataPtr(), pDataBlob->GetSize()))
+        LOG_ERROR_MESSAGE("Failed to read ", pDataBlob->GetSize(), " bytes from file ", m_FileWrpr->GetPath());
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
 bool BasicFileStream::Write(const void* Data, size_t Size)
 {
     return m_FileWrpr->Write(Data, Size);
@@ -38,14 +38,76 @@ DefaultRawMemoryAllocator::DefaultRawMemoryAllocator()
 void* DefaultRawMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
 {
     VERIFY_EXPR(Size > 0);
+    if (m_TrackingEnabled.load(std::memory_order_relaxed))
+        TrackAllocation(Size, dbgDescription, dbgFileName, dbgLineNumber);
     return new Uint8[Size];
 }
 
 void DefaultRawMemoryAllocator::Free(void* Ptr)
 {
+    if (Ptr != nullptr && m_TrackingEnabled.load(std::memory_order_relaxed))
+        m_NumFrees.fetch_add(1, std::memory_order_relaxed);
     delete[] reinterpret_cast<Uint8*>(Ptr);
 }
 
+void DefaultRawMemoryAllocator::TrackAllocation(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    const auto AllocIdx = m_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_BytesAllocated.fetch_add(Size, std::memory_order_relaxed);
+
+    if (AllocIdx < m_CallSiteRecordThreshold.load(std::memory_order_relaxed))
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_CallSitesMtx};
+    if (m_CallSites.size() < MaxRecordedCallSites)
+    {
+        AllocationCallSite CallSite;
+        CallSite.Size        = Size;
+        CallSite.Description = dbgDescription != nullptr ? dbgDescription : "";
+        CallSite.FileName    = dbgFileName != nullptr ? dbgFileName : "";
+        CallSite.LineNumber  = dbgLineNumber;
+        m_CallSites.emplace_back(std::move(CallSite));
+    }
+}
+
+void DefaultRawMemoryAllocator::EnableTracking(bool Enable)
+{
+    m_TrackingEnabled.store(Enable);
+}
+
+DefaultRawMemoryAllocator::AllocationStats DefaultRawMemoryAllocator::GetTrackingStats() const
+{
+    AllocationStats Stats;
+    Stats.NumAllocations = m_NumAllocations.load(std::memory_order_relaxed);
+    Stats.NumFrees       = m_NumFrees.load(std::memory_order_relaxed);
+    Stats.BytesAllocated = m_BytesAllocated.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+DefaultRawMemoryAllocator::AllocationStats DefaultRawMemoryAllocator::ResetTrackingPeriod()
+{
+    AllocationStats Stats;
+    Stats.NumAllocations = m_NumAllocations.exchange(0);
+    Stats.NumFrees       = m_NumFrees.exchange(0);
+    Stats.BytesAllocated = m_BytesAllocated.exchange(0);
+    return Stats;
+}
+
+void DefaultRawMemoryAllocator::SetCallSiteRecordThreshold(Uint32 Threshold)
+{
+    m_CallSiteRecordThreshold.store(Threshold);
+}
+
+std::vector<DefaultRawMemoryAllocator::AllocationCallSite> DefaultRawMemoryAllocator::TakeRecordedCallSites()
+{
+    std::vector<AllocationCallSite> CallSites;
+    {
+        std::lock_guard<std::mutex> Lock{m_CallSitesMtx};
+        CallSites.swap(m_CallSites);
+    }
+    return CallSites;
+}
+
 DefaultRawMemoryAllocator& DefaultRawMemoryAllocator::GetAllocator()
 {
     static DefaultRawMemoryAllocator Allocator;
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <atomic>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
@@ -47,7 +48,10 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
     m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
     m_RawMemoryAllocator{RawMemoryAllocator        },
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_NumBlocksInPage   {NumBlocksInPage           },
+    // Do not fetch more than one page worth of blocks at a time to avoid
+    // creating pages just to fill the magazine
+    m_MagazineRefillSize{std::max(std::min(MagazineSize / 2, NumBlocksInPage), 1u)}
 // clang-format on
 {
     // Allocate one page
@@ -56,6 +60,9 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    for (auto& Mag : m_Magazines)
+        FlushMagazine(Mag, Mag.NumBlocks);
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -72,20 +79,16 @@ void FixedBlockMemoryAllocator::CreateNewPage()
     m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+Uint32 FixedBlockMemoryAllocator::GetThreadMagazineIndex()
 {
-    VERIFY_EXPR(Size > 0);
-
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-
-    if (m_AvailablePages.empty())
-    {
-        CreateNewPage();
-    }
+    static std::atomic<Uint32> NextMagazineIdx{0};
+    // Threads are assigned to magazines in round-robin order the first time they use any allocator
+    thread_local const Uint32 ThreadMagazineIdx = NextMagazineIdx.fetch_add(1, std::memory_order_relaxed) % NumMagazines;
+    return ThreadMagazineIdx;
+}
 
+void* FixedBlockMemoryAllocator::AllocateFromPages()
+{
     auto  PageId = *m_AvailablePages.begin();
     auto& Page   = m_PagePool[PageId];
     auto* Ptr    = Page.Allocate();
@@ -94,14 +97,12 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     {
         m_AvailablePages.erase(m_AvailablePages.begin());
     }
-
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeToPages(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
+    auto PageIdIt = m_AddrToPageId.find(Ptr);
     if (PageIdIt != m_AddrToPageId.end())
     {
         auto PageId = PageIdIt->second;
@@ -124,4 +125,108 @@ void FixedBlockMemoryAllocator::Free(void* Ptr)
     }
 }
 
+void FixedBlockMemoryAllocator::RefillMagazine(Magazine& Mag)
+{
+    VERIFY_EXPR(Mag.NumBlocks == 0);
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+
+    void* Blocks[MagazineSize];
+    for (Uint32 i = 0; i < m_MagazineRefillSize; ++i)
+    {
+        if (m_AvailablePages.empty())
+        {
+            // Only create a new page if the magazine would otherwise stay empty
+            if (i > 0)
+                break;
+            CreateNewPage();
+        }
+        Blocks[Mag.NumBlocks++] = AllocateFromPages();
+    }
+
+    // Put the blocks in reverse order so that they are handed out in the order they were allocated from the page
+    for (Uint32 i = 0; i < Mag.NumBlocks; ++i)
+        Mag.Blocks[i] = Blocks[Mag.NumBlocks - 1 - i];
+}
+
+void FixedBlockMemoryAllocator::FlushMagazine(Magazine& Mag, Uint32 NumBlocks)
+{
+    VERIFY_EXPR(NumBlocks <= Mag.NumBlocks);
+    if (NumBlocks == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        // Return the coldest blocks at the bottom of the magazine
+        for (Uint32 i = 0; i < NumBlocks; ++i)
+            FreeToPages(Mag.Blocks[i]);
+    }
+
+    Mag.NumBlocks -= NumBlocks;
+    for (Uint32 i = 0; i < Mag.NumBlocks; ++i)
+        Mag.Blocks[i] = Mag.Blocks[NumBlocks + i];
+}
+
+void FixedBlockMemoryAllocator::GetStatistics(Uint32& NumAllocatedBlocks, Uint32& NumReservedBlocks)
+{
+    // Magazines are always locked before the pages, so count the magazine blocks first
+    Uint32 NumFreeBlocks = 0;
+    for (auto& Mag : m_Magazines)
+    {
+        std::lock_guard<std::mutex> MagLock{Mag.Mtx};
+        NumFreeBlocks += Mag.NumBlocks;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    for (const auto& Page : m_PagePool)
+        NumFreeBlocks += Page.GetNumFreeBlocks();
+
+    NumReservedBlocks  = static_cast<Uint32>(m_PagePool.size()) * m_NumBlocksInPage;
+    NumAllocatedBlocks = NumReservedBlocks - std::min(NumFreeBlocks, NumReservedBlocks);
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    auto& Mag = m_Magazines[GetThreadMagazineIndex()];
+
+    std::lock_guard<std::mutex> MagLock(Mag.Mtx);
+    if (Mag.NumBlocks == 0)
+        RefillMagazine(Mag);
+
+    VERIFY_EXPR(Mag.NumBlocks > 0);
+    auto* Ptr = Mag.Blocks[--Mag.NumBlocks];
+    FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+
+    return Ptr;
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+#ifdef DILIGENT_DEBUG
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        VERIFY(m_AddrToPageId.find(Ptr) != m_AddrToPageId.end(), "Address not found in the allocations list - double freeing memory?");
+    }
+#endif
+
+    auto& Mag = m_Magazines[GetThreadMagazineIndex()];
+
+    std::lock_guard<std::mutex> MagLock(Mag.Mtx);
+#ifdef DILIGENT_DEBUG
+    for (Uint32 i = 0; i < Mag.NumBlocks; ++i)
+        VERIFY(Mag.Blocks[i] != Ptr, "Block is already in the free list - double freeing memory?");
+#endif
+
+    if (Mag.NumBlocks == MagazineSize)
+        FlushMagazine(Mag, MagazineSize / 2);
+
+    FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+    Mag.Blocks[Mag.NumBlocks++] = Ptr;
+}
+
 } // namespace Diligent
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "InternedStringTable.hpp"
+
+#include <cstring>
+
+namespace Diligent
+{
+
+InternedStringTable::InternedStringTable(IMemoryAllocator& Allocator) noexcept :
+    m_Allocator{Allocator}
+{
+}
+
+InternedStringTable::~InternedStringTable()
+{
+    for (auto& Shard : m_Shards)
+    {
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+        DEV_CHECK_ERR(Shard.Map.empty(), Shard.Map.size(), " interned string(s) have not been released. This indicates a reference leak.");
+        for (auto& it : Shard.Map)
+            m_Allocator.Free(it.second);
+        Shard.Map.clear();
+    }
+}
+
+const Char* InternedStringTable::Intern(const Char* Str) noexcept(false)
+{
+    if (Str == nullptr)
+        return nullptr;
+
+    // The key does not copy the string, we only use it to look up the table
+    HashMapStringKey Key{Str};
+
+    auto& Shard = m_Shards[GetShardIndex(Key.GetHash())];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+    auto it = Shard.Map.find(Key);
+    if (it != Shard.Map.end())
+    {
+        ++it->second->RefCount;
+        return reinterpret_cast<const Char*>(it->second + 1);
+    }
+
+    const auto LenWithZeroTerm = strlen(Str) + 1;
+
+    auto* pHeader = reinterpret_cast<EntryHeader*>(m_Allocator.Allocate(sizeof(EntryHeader) + LenWithZeroTerm, "Interned string", __FILE__, __LINE__));
+    if (pHeader == nullptr)
+        LOG_ERROR_AND_THROW("Failed to allocate memory for interned string");
+
+    pHeader->RefCount = 1;
+    pHeader->ShardIdx = GetShardIndex(Key.GetHash());
+
+    auto* InternedStr = reinterpret_cast<Char*>(pHeader + 1);
+    memcpy(InternedStr, Str, LenWithZeroTerm);
+
+    try
+    {
+        // The key references the string stored in the entry itself
+        Shard.Map.emplace(HashMapStringKey{InternedStr}, pHeader);
+    }
+    catch (...)
+    {
+        m_Allocator.Free(pHeader);
+        throw;
+    }
+
+    return InternedStr;
+}
+
+void InternedStringTable::AddRef(const Char* InternedStr)
+{
+    if (InternedStr == nullptr)
+        return;
+
+    auto* pHeader = GetEntryHeader(InternedStr);
+    VERIFY_EXPR(pHeader->ShardIdx < NumShards);
+
+    auto& Shard = m_Shards[pHeader->ShardIdx];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+    VERIFY(pHeader->RefCount > 0, "Adding a reference to a string that has already been released");
+    ++pHeader->RefCount;
+}
+
+void InternedStringTable::Release(const Char* InternedStr)
+{
+    if (InternedStr == nullptr)
+        return;
+
+    auto* pHeader = GetEntryHeader(InternedStr);
+    VERIFY_EXPR(pHeader->ShardIdx < NumShards);
+
+    auto& Shard = m_Shards[pHeader->ShardIdx];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+    VERIFY(pHeader->RefCount > 0, "Releasing a string that has already been released");
+    if (--pHeader->RefCount == 0)
+    {
+        auto it = Shard.Map.find(HashMapStringKey{InternedStr});
+        VERIFY(it != Shard.Map.end() && it->second == pHeader, "String '", InternedStr, "' was not found in the table");
+        Shard.Map.erase(it);
+        m_Allocator.Free(pHeader);
+    }
+}
+
+size_t InternedStringTable::GetSize() const
+{
+    size_t Size = 0;
+    for (const auto& Shard : m_Shards)
+    {
+        std::lock_guard<std::mutex> Lock{Shard.Mtx};
+        Size += Shard.Map.size();
+    }
+    return Size;
+}
+
+bool InternedStringTable::IsInterned(const Char* Str) const
+{
+    if (Str == nullptr)
+        return false;
+
+    HashMapStringKey Key{Str};
+
+    const auto& Shard = m_Shards[GetShardIndex(Key.GetHash())];
+
+    std::lock_guard<std::mutex> Lock{Shard.Mtx};
+
+    auto it = Shard.Map.find(Key);
+    return it != Shard.Map.end() && reinterpret_cast<const Char*>(it->second + 1) == Str;
+}
+
+} // namespace Diligent
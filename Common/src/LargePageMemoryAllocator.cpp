@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "LargePageMemoryAllocator.hpp"
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "PlatformMisc.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+// Every block starts with the header, which keeps the user memory 16-byte aligned
+struct LargePageMemoryAllocator::BlockHeader
+{
+    // Size class of the block, or FallbackSizeClass for the blocks allocated by the fallback allocator
+    Uint32 SizeClass;
+    Uint32 Padding[3];
+
+    static constexpr Uint32 FallbackSizeClass = ~0u;
+
+    // Free blocks are linked through the first bytes after the header
+    BlockHeader*& NextFree()
+    {
+        return *reinterpret_cast<BlockHeader**>(this + 1);
+    }
+};
+
+namespace
+{
+
+// Size classes are 32, 48 and 64 bytes, followed by four classes per power of two: 80, 96, 112, 128, 160, 192, ...
+// All sizes are multiples of 16.
+Uint32 GetSizeClass(size_t BlockSize)
+{
+    if (BlockSize <= 64)
+        return static_cast<Uint32>((std::max(BlockSize, size_t{32}) + 15) / 16 - 2);
+
+    // 2^Log2 < BlockSize <= 2^(Log2 + 1)
+    const auto Log2     = PlatformMisc::GetMSB(Uint64{BlockSize - 1});
+    const auto SubClass = static_cast<Uint32>((BlockSize - 1 - (size_t{1} << Log2)) >> (Log2 - 2));
+    return 3 + (Log2 - 6) * 4 + SubClass;
+}
+
+size_t GetSizeClassBlockSize(Uint32 SizeClass)
+{
+    if (SizeClass < 3)
+        return 32 + size_t{16} * SizeClass;
+
+    const auto Base = size_t{64} << ((SizeClass - 3) / 4);
+    return Base + (Base / 4) * ((SizeClass - 3) % 4 + 1);
+}
+
+Uint32 GetNumSizeClasses(const LargePageMemoryAllocatorCreateInfo& CI, Uint32 MaxSizeClasses)
+{
+    if (!IsPowerOfTwo(CI.MaxBlockSize) || CI.MaxBlockSize < 64)
+        LOG_ERROR_AND_THROW("Max block size (", CI.MaxBlockSize, ") must be a power of two not less than 64");
+    if (CI.MaxBlockSize > CI.ArenaSize)
+        LOG_ERROR_AND_THROW("Max block size (", CI.MaxBlockSize, ") must not exceed the arena size (", CI.ArenaSize, ")");
+
+    const auto NumSizeClasses = GetSizeClass(CI.MaxBlockSize) + 1;
+    if (NumSizeClasses > MaxSizeClasses)
+        LOG_ERROR_AND_THROW("Max block size (", CI.MaxBlockSize, ") is too large");
+    VERIFY_EXPR(GetSizeClassBlockSize(NumSizeClasses - 1) == CI.MaxBlockSize);
+
+    return NumSizeClasses;
+}
+
+} // namespace
+
+LargePageMemoryAllocator::LargePageMemoryAllocator(const LargePageMemoryAllocatorCreateInfo& CI) :
+    // clang-format off
+    m_FallbackAllocator{CI.pFallbackAllocator != nullptr ? *CI.pFallbackAllocator : DefaultRawMemoryAllocator::GetAllocator()},
+    m_NumSizeClasses   {GetNumSizeClasses(CI, MaxSizeClasses)}
+// clang-format on
+{
+    static_assert(sizeof(BlockHeader) == 16, "Block header must keep the memory 16-byte aligned");
+
+    const auto LargePageSize = CI.UseLargePages ? PlatformMisc::GetLargePageSize() : 0;
+
+    m_UseLargePages = LargePageSize != 0;
+    // Blocks are carved from the arenas without gaps, so the arena size is also aligned by the max block size
+    m_ArenaSize = AlignUp(CI.ArenaSize, std::max(LargePageSize, CI.MaxBlockSize));
+}
+
+LargePageMemoryAllocator::~LargePageMemoryAllocator()
+{
+    for (const auto& Arena : m_Arenas)
+    {
+        if (Arena.IsLargePage)
+            PlatformMisc::FreeLargePages(Arena.pMemory, m_ArenaSize);
+        else
+            m_FallbackAllocator.Free(Arena.pMemory);
+    }
+}
+
+bool LargePageMemoryAllocator::CreateArena()
+{
+    Arena NewArena;
+    if (m_UseLargePages)
+    {
+        NewArena.pMemory     = PlatformMisc::AllocateLargePages(m_ArenaSize);
+        NewArena.IsLargePage = NewArena.pMemory != nullptr;
+        if (NewArena.pMemory == nullptr)
+        {
+            LOG_WARNING_MESSAGE("Failed to allocate ", m_ArenaSize, " bytes of large pages. The remaining arenas will use regular pages.");
+            m_UseLargePages = false;
+        }
+    }
+
+    if (NewArena.pMemory == nullptr)
+        NewArena.pMemory = m_FallbackAllocator.Allocate(m_ArenaSize, "Large page allocator arena", __FILE__, __LINE__);
+
+    if (NewArena.pMemory == nullptr)
+        return false;
+
+    m_Arenas.emplace_back(NewArena);
+    m_pArenaCurr = static_cast<Uint8*>(NewArena.pMemory);
+    m_pArenaEnd  = m_pArenaCurr + m_ArenaSize;
+
+    return true;
+}
+
+LargePageMemoryAllocator::BlockHeader* LargePageMemoryAllocator::AllocateFromArena(Uint32 SizeClass)
+{
+    const auto BlockSize = GetSizeClassBlockSize(SizeClass);
+    if (static_cast<size_t>(m_pArenaEnd - m_pArenaCurr) < BlockSize)
+    {
+        // Put the rest of the arena into the free lists of the smaller classes so that it is not wasted.
+        // All block sizes are multiples of 16, so at most 16 bytes are left.
+        for (auto Class = SizeClass; Class-- > 0;)
+        {
+            const auto ClassBlockSize = GetSizeClassBlockSize(Class);
+            while (static_cast<size_t>(m_pArenaEnd - m_pArenaCurr) >= ClassBlockSize)
+            {
+                auto* pFreeBlock = reinterpret_cast<BlockHeader*>(m_pArenaCurr);
+                m_pArenaCurr += ClassBlockSize;
+
+                pFreeBlock->NextFree() = m_FreeLists[Class];
+                m_FreeLists[Class]     = pFreeBlock;
+            }
+        }
+
+        if (!CreateArena())
+            return nullptr;
+    }
+
+    auto* pBlock = reinterpret_cast<BlockHeader*>(m_pArenaCurr);
+    m_pArenaCurr += BlockSize;
+    return pBlock;
+}
+
+void* LargePageMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    const auto BlockSize = Size + sizeof(BlockHeader);
+
+    BlockHeader* pHeader   = nullptr;
+    Uint32       SizeClass = BlockHeader::FallbackSizeClass;
+    if (BlockSize <= GetSizeClassBlockSize(m_NumSizeClasses - 1))
+    {
+        SizeClass = GetSizeClass(BlockSize);
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        pHeader = m_FreeLists[SizeClass];
+        if (pHeader != nullptr)
+            m_FreeLists[SizeClass] = pHeader->NextFree();
+        else
+            pHeader = AllocateFromArena(SizeClass);
+    }
+
+    if (pHeader == nullptr)
+    {
+        SizeClass = BlockHeader::FallbackSizeClass;
+        pHeader   = static_cast<BlockHeader*>(m_FallbackAllocator.Allocate(BlockSize, dbgDescription, dbgFileName, dbgLineNumber));
+        if (pHeader == nullptr)
+            return nullptr;
+    }
+
+    pHeader->SizeClass = SizeClass;
+    return pHeader + 1;
+}
+
+void LargePageMemoryAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    auto* pHeader = static_cast<BlockHeader*>(Ptr) - 1;
+    if (pHeader->SizeClass == BlockHeader::FallbackSizeClass)
+    {
+        m_FallbackAllocator.Free(pHeader);
+        return;
+    }
+
+    VERIFY(pHeader->SizeClass < m_NumSizeClasses, "Invalid block size class. The memory may have been corrupted or was not allocated by this allocator.");
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    pHeader->NextFree()             = m_FreeLists[pHeader->SizeClass];
+    m_FreeLists[pHeader->SizeClass] = pHeader;
+}
+
+bool LargePageMemoryAllocator::IsUsingLargePages() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_UseLargePages;
+}
+
+void LargePageMemoryAllocator::GetArenaStatistics(Uint32& NumArenas, size_t& TotalSize) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    NumArenas = static_cast<Uint32>(m_Arenas.size());
+    TotalSize = m_Arenas.size() * m_ArenaSize;
+}
+
+} // namespace Diligent
@@ -31,7 +31,7 @@
 namespace ThreadingTools
 {
 
-void LockHelper::YieldThread() noexcept
+void SpinBackoff::YieldThread() noexcept
 {
     std::this_thread::yield();
 }
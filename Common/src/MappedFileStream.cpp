@@ -0,0 +1,103 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "MappedFileStream.hpp"
+#include "ProxyDataBlob.hpp"
+
+namespace Diligent
+{
+
+MappedFileStream::MappedFileStream(IReferenceCounters* pRefCounters,
+                                   const Char*         Path) :
+    TBase{pRefCounters},
+    m_pView{FileSystem::MapFile(Path)}
+{
+}
+
+IMPLEMENT_QUERY_INTERFACE(MappedFileStream, IID_FileStream, TBase)
+
+bool MappedFileStream::Read(void* Data, size_t Size)
+{
+    VERIFY(m_pView, "File is not mapped");
+    if (!m_pView)
+        return false;
+
+    VERIFY_EXPR(m_CurrentOffset <= m_pView->GetSize());
+    auto  BytesLeft   = m_pView->GetSize() - m_CurrentOffset;
+    auto  BytesToRead = std::min(BytesLeft, Size);
+    auto* pSrcData    = static_cast<const Uint8*>(m_pView->GetData()) + m_CurrentOffset;
+    memcpy(Data, pSrcData, BytesToRead);
+    m_CurrentOffset += BytesToRead;
+    return Size == BytesToRead;
+}
+
+void MappedFileStream::ReadBlob(IDataBlob* pData)
+{
+    VERIFY_EXPR(pData != nullptr);
+    pData->Resize(m_pView ? m_pView->GetSize() - m_CurrentOffset : 0);
+    auto res = Read(pData->GetDataPtr(), pData->GetSize());
+    VERIFY_EXPR(res);
+    (void)res;
+}
+
+void MappedFileStream::ReadBlob2(IDataBlob** ppData)
+{
+    VERIFY_EXPR(ppData != nullptr && *ppData == nullptr);
+    VERIFY(m_pView, "File is not mapped");
+    if (!m_pView)
+        return;
+
+    const auto* pData = static_cast<const Uint8*>(m_pView->GetData()) + m_CurrentOffset;
+    const auto  Size  = m_pView->GetSize() - m_CurrentOffset;
+    m_CurrentOffset += Size;
+
+    // The blob keeps the stream, and thus the mapping, alive
+    auto* pDataBlob = MakeNewRCObj<ProxyDataBlob>{}(pData, Size, this);
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
+bool MappedFileStream::Write(const void* Data, size_t Size)
+{
+    UNSUPPORTED("Mapped file stream is read-only");
+    return false;
+}
+
+bool MappedFileStream::IsValid()
+{
+    return m_pView != nullptr;
+}
+
+size_t MappedFileStream::GetSize()
+{
+    return m_pView ? m_pView->GetSize() : 0;
+}
+
+} // namespace Diligent
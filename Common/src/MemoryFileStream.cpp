@@ -29,6 +29,7 @@
 #include "pch.h"
 
 #include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
@@ -62,6 +63,14 @@ void MemoryFileStream::ReadBlob(IDataBlob* pData)
     (void)res;
 }
 
+void MemoryFileStream::ReadBlob2(IDataBlob** ppData)
+{
+    VERIFY_EXPR(ppData != nullptr && *ppData == nullptr);
+    auto* pDataBlob = MakeNewRCObj<DataBlobImpl>{}(0);
+    ReadBlob(pDataBlob);
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+}
+
 bool MemoryFileStream::Write(const void* Data, size_t Size)
 {
     if (m_CurrentOffset + Size > m_DataBlob->GetSize())
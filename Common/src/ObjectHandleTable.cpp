@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ObjectHandleTable.hpp"
+
+#include "Errors.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32       ObjectHandleTable::SlotIndexBits;
+constexpr Uint32       ObjectHandleTable::GenerationBits;
+constexpr Uint32       ObjectHandleTable::MaxSlots;
+constexpr Uint32       ObjectHandleTable::MinFreeSlots;
+constexpr ObjectHandle ObjectHandleTable::NullHandle;
+constexpr Uint32       ObjectHandleTable::AliveFlag;
+
+ObjectHandleTable::~ObjectHandleTable()
+{
+    DEV_CHECK_ERR(m_Slots.size() == m_FreeSlots.size(), m_Slots.size() - m_FreeSlots.size(),
+                  " object handle(s) have not been released. This indicates an object leak.");
+}
+
+ObjectHandle ObjectHandleTable::Allocate() noexcept(false)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    Uint32 SlotIdx = 0;
+    if (m_FreeSlots.size() > MinFreeSlots || (!m_FreeSlots.empty() && m_Slots.size() >= MaxSlots))
+    {
+        SlotIdx = m_FreeSlots.front();
+        m_FreeSlots.pop_front();
+    }
+    else
+    {
+        if (m_Slots.size() >= MaxSlots)
+            LOG_ERROR_AND_THROW("All ", MaxSlots, " object handles are in use.");
+
+        SlotIdx = static_cast<Uint32>(m_Slots.size());
+        // Generations start from 1 so that a valid handle is never zero
+        m_Slots.push_back(1);
+    }
+
+    auto& Slot = m_Slots[SlotIdx];
+    VERIFY_EXPR((Slot & AliveFlag) == 0);
+    Slot |= AliveFlag;
+    return ((Slot & ~AliveFlag) << SlotIndexBits) | SlotIdx;
+}
+
+void ObjectHandleTable::Release(ObjectHandle Handle)
+{
+    if (Handle == NullHandle)
+        return;
+
+    const auto SlotIdx = GetSlotIndex(Handle);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    if (SlotIdx >= m_Slots.size() || m_Slots[SlotIdx] != (GetGeneration(Handle) | AliveFlag))
+    {
+        UNEXPECTED("Handle 0x", std::hex, Handle, " is not alive. This may indicate that the handle is released twice.");
+        return;
+    }
+
+    auto Generation = GetGeneration(Handle) + 1;
+    if (Generation >= (1u << GenerationBits))
+        Generation = 1;
+    m_Slots[SlotIdx] = Generation;
+    m_FreeSlots.push_back(SlotIdx);
+}
+
+bool ObjectHandleTable::IsAlive(ObjectHandle Handle) const
+{
+    if (Handle == NullHandle)
+        return false;
+
+    const auto SlotIdx = GetSlotIndex(Handle);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return SlotIdx < m_Slots.size() && m_Slots[SlotIdx] == (GetGeneration(Handle) | AliveFlag);
+}
+
+Uint32 ObjectHandleTable::GetSlotCount() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_Slots.size());
+}
+
+Uint32 ObjectHandleTable::GetNumAliveHandles() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_Slots.size() - m_FreeSlots.size());
+}
+
+} // namespace Diligent
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ProxyDataBlob.hpp"
+
+namespace Diligent
+{
+
+ProxyDataBlob::ProxyDataBlob(IReferenceCounters* pRefCounters,
+                             const void*         pData,
+                             size_t              Size,
+                             IObject*            pOwner) :
+    TBase{pRefCounters},
+    m_pExternalData{pData},
+    m_ExternalSize{Size},
+    m_pOwner{pOwner}
+{
+    VERIFY_EXPR(pData != nullptr || Size == 0);
+}
+
+ProxyDataBlob::ProxyDataBlob(IReferenceCounters* pRefCounters,
+                             const void*         pData,
+                             size_t              Size,
+                             ReleaseCallbackType ReleaseCallback,
+                             void*               pUserData) :
+    TBase{pRefCounters},
+    m_pExternalData{pData},
+    m_ExternalSize{Size},
+    m_ReleaseCallback{ReleaseCallback},
+    m_pUserData{pUserData}
+{
+    VERIFY_EXPR(pData != nullptr || Size == 0);
+}
+
+ProxyDataBlob::~ProxyDataBlob()
+{
+    ReleaseExternalData();
+}
+
+void ProxyDataBlob::ReleaseExternalData()
+{
+    if (m_ReleaseCallback != nullptr)
+        m_ReleaseCallback(m_pExternalData, m_pUserData);
+
+    m_ReleaseCallback = nullptr;
+    m_pUserData       = nullptr;
+    m_pOwner.Release();
+    m_pExternalData = nullptr;
+    m_ExternalSize  = 0;
+}
+
+void ProxyDataBlob::MakeCopy()
+{
+    if (!IsExternal())
+        return;
+
+    const auto* pSrcData = static_cast<const Uint8*>(m_pExternalData);
+    m_DataBuff.assign(pSrcData, pSrcData + m_ExternalSize);
+    ReleaseExternalData();
+}
+
+void ProxyDataBlob::Resize(size_t NewSize)
+{
+    MakeCopy();
+    m_DataBuff.resize(NewSize);
+}
+
+size_t ProxyDataBlob::GetSize() const
+{
+    return IsExternal() ? m_ExternalSize : m_DataBuff.size();
+}
+
+void* ProxyDataBlob::GetDataPtr()
+{
+    MakeCopy();
+    return m_DataBuff.data();
+}
+
+const void* ProxyDataBlob::GetConstDataPtr() const
+{
+    return IsExternal() ? m_pExternalData : m_DataBuff.data();
+}
+
+} // namespace Diligent
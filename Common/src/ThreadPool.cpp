@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "ThreadPool.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+class ThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    ThreadPoolImpl(IReferenceCounters* pRefCounters, const ThreadPoolCreateInfo& CreateInfo) :
+        TBase{pRefCounters},
+        m_Pool{CreateInfo.NumThreads}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
+
+    virtual void DILIGENT_CALL_TYPE EnqueueTask(ThreadPoolTaskCallbackType Callback, void* pUserData) override final
+    {
+        VERIFY_EXPR(Callback != nullptr);
+        m_Pool.EnqueueTask([Callback, pUserData]() {
+            Callback(pUserData);
+        });
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
+    {
+        m_Pool.WaitForAllTasks();
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetThreadCount() const override final
+    {
+        return m_Pool.GetThreadCount();
+    }
+
+private:
+    ThreadPool m_Pool;
+};
+
+} // namespace
+
+void CreateThreadPool(const ThreadPoolCreateInfo& CreateInfo, IThreadPool** ppThreadPool)
+{
+    DEV_CHECK_ERR(ppThreadPool != nullptr, "ppThreadPool must not be null");
+    DEV_CHECK_ERR(*ppThreadPool == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+    RefCntAutoPtr<IThreadPool> pThreadPool{MakeNewRCObj<ThreadPoolImpl>()(CreateInfo)};
+    *ppThreadPool = pThreadPool.Detach();
+}
+
+} // namespace Diligent
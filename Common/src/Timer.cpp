@@ -39,13 +39,13 @@ Timer::Timer()
 
 void Timer::Restart()
 {
-    m_StartTime = high_resolution_clock().now();
+    m_StartTime = steady_clock().now();
 }
 
 template <typename T>
-T GetElapsedTime(high_resolution_clock::time_point StartTime)
+T GetElapsedTime(steady_clock::time_point StartTime)
 {
-    auto CurrTime  = high_resolution_clock::now();
+    auto CurrTime  = steady_clock::now();
     auto time_span = duration_cast<duration<T>>(CurrTime - StartTime);
     return time_span.count();
 }
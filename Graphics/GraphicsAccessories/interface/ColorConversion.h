@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include "../../../Primitives/interface/BasicTypes.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -57,4 +58,21 @@ inline float FastSRGBToLinear(float x)
     return x * (x * (x * 0.305306011f + 0.682171111f) + 0.012522878f);
 }
 
+/// Converts Count 8-bit sRGB values to linear floating-point values in [0, 1].
+/// The results are identical to SRGBToLinear(Uint8).
+void ConvertSRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count);
+
+/// Converts Count linear floating-point values to 8-bit sRGB values.
+/// The inputs are clamped to [0, 1] (NaNs are converted to 0), and the results
+/// are correctly rounded, i.e. they are the nearest 8-bit values to the exact sRGB curve.
+void ConvertLinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count);
+
+/// Converts NumTexels RGBA8 texels from sRGB to linear color space.
+/// Alpha is copied as is. The source and destination may be the same.
+void ConvertRGBA8SRGBToLinear(const Uint8* pSRGB, Uint8* pLinear, size_t NumTexels);
+
+/// Converts NumTexels RGBA8 texels from linear to sRGB color space.
+/// Alpha is copied as is. The source and destination may be the same.
+void ConvertRGBA8LinearToSRGB(const Uint8* pLinear, Uint8* pSRGB, size_t NumTexels);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+
+#include <atomic>
+#include <vector>
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+/// Implementation of a ring buffer that supports lock-free allocation from multiple threads.
+
+/// Allocate() may be called by any number of threads simultaneously. FinishCurrentFrame() and
+/// ReleaseCompletedFrames() must be called by a single thread, but may run concurrently with Allocate().
+///
+/// Head and tail are tracked as monotonically increasing virtual offsets, so that a single atomic
+/// compare-exchange of the head reserves the space. Physical offset is the virtual offset modulo
+/// the buffer size. Frame heads are kept in a fixed-capacity circular array.
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    /// \param [in] MaxSize        - Ring buffer size.
+    /// \param [in] Allocator      - Allocator for the frame head array.
+    /// \param [in] MaxFrameCount  - The maximum number of frames that can be in flight.
+    ///                              When there are more frames, the two newest frames are merged,
+    ///                              which delays releasing the space until the newest fence completes.
+    ConcurrentRingBuffer(OffsetType MaxSize, IMemoryAllocator& Allocator, Uint32 MaxFrameCount = 64) :
+        m_FrameHeads(MaxFrameCount, FrameHeadAttribs{}, STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for vector<FrameHeadAttribs>")),
+        m_MaxSize{MaxSize}
+    {
+        VERIFY(MaxFrameCount > 0, "Max frame count must not be zero");
+    }
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(IsEmpty(), "All space in the ring buffer must be released");
+    }
+
+    /// Allocates space in the ring buffer. This method is lock-free and thread-safe.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+
+        if (Size > m_MaxSize)
+            return InvalidOffset;
+
+        auto Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto HeadOffset = static_cast<OffsetType>(Head % m_MaxSize);
+
+            auto Offset = AlignUp(HeadOffset, Alignment);
+            // Virtual offset of the allocation start
+            auto Start = Head + (Offset - HeadOffset);
+            if (Offset + Size > m_MaxSize)
+            {
+                // Allocate from the beginning of the buffer
+                //
+                //  Offset              Tail          Head               MaxSize
+                //  |                  |                |<--skipped--->|
+                //  [                  xxxxxxxxxxxxxxxxx++++++++++++++++]
+                //
+                Offset = 0;
+                Start  = Head + (m_MaxSize - HeadOffset);
+            }
+
+            const auto NewHead = Start + Size;
+            // Tail only moves forward, so checking against a stale value is conservative
+            if (NewHead - m_Tail.load(std::memory_order_acquire) > m_MaxSize)
+                return InvalidOffset;
+
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_relaxed))
+                return Offset;
+        }
+    }
+
+    /// Marks the end of the current frame. All allocations made before this call are assigned to the frame.
+
+    /// \param [in] FenceValue - Fence value associated with the command list in which the allocations
+    ///                          could have been referenced last time.
+    ///
+    /// \remarks    This method must only be called by the thread that releases the frames.
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+        const auto Head = m_Head.load(std::memory_order_relaxed);
+
+        const auto LastHead = m_NumFrames > 0 ? GetFrameHead(m_NumFrames - 1).Head : m_Tail.load(std::memory_order_relaxed);
+        // Ignore zero-size frames
+        if (Head == LastHead)
+            return;
+
+        if (m_NumFrames > 0)
+        {
+            VERIFY(FenceValue >= GetFrameHead(m_NumFrames - 1).FenceValue, "Current frame fence value (", FenceValue,
+                   ") is lower than the fence value of the previous frame (", GetFrameHead(m_NumFrames - 1).FenceValue, ")");
+        }
+
+        if (m_NumFrames == m_FrameHeads.size())
+        {
+            // Frame head array is full: extend the last frame
+            auto& LastFrame      = GetFrameHead(m_NumFrames - 1);
+            LastFrame.FenceValue = FenceValue;
+            LastFrame.Head       = Head;
+            return;
+        }
+
+        auto& Frame      = GetFrameHead(m_NumFrames++);
+        Frame.FenceValue = FenceValue;
+        Frame.Head       = Head;
+    }
+
+    /// Releases all frames whose fence value is less than or equal to CompletedFenceValue.
+
+    /// \remarks    This method must only be called by the thread that finishes the frames.
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        while (m_NumFrames > 0 && GetFrameHead(0).FenceValue <= CompletedFenceValue)
+        {
+            m_Tail.store(GetFrameHead(0).Head, std::memory_order_release);
+            m_FirstFrame = (m_FirstFrame + 1) % m_FrameHeads.size();
+            --m_NumFrames;
+        }
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize()  const { return m_MaxSize; }
+    bool       IsFull()      const { return GetUsedSize() == m_MaxSize; };
+    bool       IsEmpty()     const { return GetUsedSize() == 0; };
+    OffsetType GetUsedSize() const { return static_cast<OffsetType>(m_Head.load() - m_Tail.load()); }
+    // clang-format on
+
+private:
+    struct FrameHeadAttribs
+    {
+        // Fence value associated with the command list in which
+        // the allocation could have been referenced last time
+        Uint64 FenceValue = 0;
+        // Virtual head offset at the end of the frame
+        Uint64 Head = 0;
+    };
+
+    FrameHeadAttribs& GetFrameHead(size_t Idx)
+    {
+        VERIFY_EXPR(Idx < m_NumFrames);
+        return m_FrameHeads[(m_FirstFrame + Idx) % m_FrameHeads.size()];
+    }
+
+    std::vector<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs>> m_FrameHeads;
+
+    size_t m_FirstFrame = 0;
+    size_t m_NumFrames  = 0;
+
+    const OffsetType m_MaxSize;
+
+    // Virtual offsets that only increase
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+};
+} // namespace Diligent
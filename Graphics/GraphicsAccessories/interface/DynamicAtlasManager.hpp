@@ -33,6 +33,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
@@ -44,6 +45,26 @@ namespace Diligent
 class DynamicAtlasManager
 {
 public:
+    /// Region packing strategy
+    enum class PACKING_STRATEGY : Uint8
+    {
+        /// Regions are allocated by recursively splitting free regions in a tree.
+        /// Adjacent free regions are merged back when their allocations are released.
+        TREE = 0,
+
+        /// Regions are placed at the lowest position of the skyline (bottom-left rule).
+        /// Space wasted under the skyline as well as released regions are reused before
+        /// the skyline grows. Gives better occupancy than the tree for many small regions
+        /// of varying sizes, e.g. glyphs.
+        SKYLINE,
+
+        /// Maximal rectangles: free space is tracked as a set of maximal (possibly overlapping)
+        /// free rectangles, and a region is placed in the rectangle that leaves the shortest side.
+        /// Gives the best occupancy at the cost of slower allocation and is intended for offline use.
+        /// Released regions are reused, but free rectangles are not coalesced back into maximal ones.
+        MAX_RECTS
+    };
+
     struct Region
     {
         Uint32 x = 0;
@@ -98,7 +119,7 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, PACKING_STRATEGY Strategy = PACKING_STRATEGY::TREE);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -111,15 +132,13 @@ public:
     Region Allocate(Uint32 Width, Uint32 Height);
     void   Free(Region&& R);
 
-    Uint32 GetFreeRegionCount() const
-    {
-        VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
-        return static_cast<Uint32>(m_FreeRegionsByWidth.size());
-    }
+    Uint32 GetFreeRegionCount() const;
 
     Uint32 GetWidth() const { return m_Width; }
     Uint32 GetHeight() const { return m_Height; }
 
+    PACKING_STRATEGY GetPackingStrategy() const { return m_Strategy; }
+
 #define CMP(Member)                 \
     if (R0.Member < R1.Member)      \
         return true;                \
@@ -158,8 +177,17 @@ private:
     void DbgRecursiveVerifyConsistency(const Node& N, Uint32& Area) const;
 #endif
 
-    const Uint32 m_Width;
-    const Uint32 m_Height;
+    Region AllocateSkyline(Uint32 Width, Uint32 Height);
+    Region AllocateMaxRects(Uint32 Width, Uint32 Height);
+    Region AllocateFromFreeRects(Uint32 Width, Uint32 Height);
+    void   AddFreeRect(Region R);
+    void   SplitFreeRects(const Region& R);
+    void   PruneFreeRects();
+    void   ResetPacker();
+
+    const Uint32           m_Width;
+    const Uint32           m_Height;
+    const PACKING_STRATEGY m_Strategy;
 
     struct Node
     {
@@ -217,8 +245,22 @@ private:
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
-    // Allocated regions
+    // Allocated regions. Nodes are null for skyline and max-rects strategies.
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
+
+    // Skyline segment: columns [x, x + width) are occupied up to y.
+    struct SkylineSegment
+    {
+        Uint32 x;
+        Uint32 y;
+        Uint32 width;
+    };
+    // Skyline segments ordered by x (skyline strategy only)
+    std::vector<SkylineSegment> m_Skyline;
+
+    // Free rectangles: reusable space below the skyline (skyline strategy, disjoint),
+    // or maximal free rectangles (max-rects strategy, may overlap).
+    std::vector<Region> m_FreeRects;
 };
 
 } // namespace Diligent
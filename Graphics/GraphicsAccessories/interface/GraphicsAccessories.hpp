@@ -129,7 +129,7 @@ template <> struct VALUE_TYPE2CType<VT_FLOAT32>
 };
 
 
-static const Uint32 ValueTypeToSizeMap[] =
+static constexpr Uint32 ValueTypeToSizeMap[] =
     // clang-format off
 {
     0,
@@ -193,6 +193,34 @@ inline TEXTURE_FORMAT GetDefaultTextureViewFormat(const TextureDesc& TexDesc, TE
     return GetDefaultTextureViewFormat(TexDesc.Format, ViewType, TexDesc.BindFlags);
 }
 
+/// Returns the uncompressed format whose texel size equals the block size of the given block-compressed format.
+
+/// The returned format is TEX_FORMAT_RG32_UINT for formats with 8-byte blocks (BC1, BC4) and
+/// TEX_FORMAT_RGBA32_UINT for formats with 16-byte blocks (BC2, BC3, BC5, BC6H, BC7).
+/// A compute shader may write compressed blocks to a texture of this format through an unordered
+/// access view, after which the texture may be copied to the compressed texture with
+/// IDeviceContext::CopyTexture(). Every texel of the source texture then becomes one block of the
+/// destination texture.
+///
+/// \param [in] CompressedFormat - Block-compressed texture format.
+/// \return  Copy-compatible uncompressed format, or TEX_FORMAT_UNKNOWN if the format is not block-compressed.
+TEXTURE_FORMAT GetBlockCopyCompatibleFormat(TEXTURE_FORMAT CompressedFormat);
+
+/// Checks if IDeviceContext::CopyTexture() may copy texels between textures of the given formats.
+
+/// The formats are copy-compatible if
+/// * They are the same
+/// * Both are uncompressed non-depth formats with the same number and size of components
+///   (e.g. RGBA8_UNORM and RGBA8_UINT)
+/// * Both are block-compressed formats of the same family (e.g. BC3_UNORM and BC3_UNORM_SRGB)
+/// * One of them is block-compressed and the texel size of the other one is equal to the block size.
+///   In this case, one texel of the uncompressed texture corresponds to one block of the compressed texture.
+///
+/// \param [in] SrcFormat - Format of the source texture.
+/// \param [in] DstFormat - Format of the destination texture.
+/// \return  true if the formats are copy-compatible, and false otherwise.
+bool IsCopyCompatibleFormat(TEXTURE_FORMAT SrcFormat, TEXTURE_FORMAT DstFormat);
+
 /// Returns the literal name of a texture view type. For instance,
 /// for a shader resource view, "TEXTURE_VIEW_SHADER_RESOURCE" will be returned.
 
@@ -34,16 +34,83 @@
 /// Implementation of Diligent::ResourceReleaseQueue class
 
 #include <mutex>
-#include <deque>
+#include <atomic>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
-#include "../../../Common/interface/STDAllocator.hpp"
+#include "../../../Common/interface/LockFreeBlockPool.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+/// Pool of memory blocks for the stale resource objects created by DynamicStaleResourceWrapper
+
+/// Objects are grouped into size classes that are served by lock-free block pools.
+/// Objects larger than the largest size class are allocated from the raw memory allocator.
+/// All memory is returned to the allocator when the pool is destroyed.
+class StaleResourcePool
+{
+public:
+    static constexpr size_t NumSizeClasses   = 4;
+    static constexpr size_t MinSizeClass     = 32;
+    static constexpr Uint32 NumBlocksInChunk = 256;
+
+    StaleResourcePool(IMemoryAllocator& Allocator) :
+        // clang-format off
+        m_Allocator{Allocator},
+        m_Pools
+        {
+            {Allocator, MinSizeClass << 0, NumBlocksInChunk},
+            {Allocator, MinSizeClass << 1, NumBlocksInChunk},
+            {Allocator, MinSizeClass << 2, NumBlocksInChunk},
+            {Allocator, MinSizeClass << 3, NumBlocksInChunk}
+        }
+    // clang-format on
+    {
+        static_assert(NumSizeClasses == 4, "Please update the initializer list above");
+    }
+
+    // clang-format off
+    StaleResourcePool             (const StaleResourcePool&) = delete;
+    StaleResourcePool             (StaleResourcePool&&)      = delete;
+    StaleResourcePool& operator = (const StaleResourcePool&) = delete;
+    StaleResourcePool& operator = (StaleResourcePool&&)      = delete;
+    // clang-format on
+
+    /// Allocates a block of the given size. The method is thread-safe.
+    void* Allocate(size_t Size)
+    {
+        const auto SizeClass = GetSizeClass(Size);
+        return SizeClass < NumSizeClasses ?
+            m_Pools[SizeClass].Allocate() :
+            m_Allocator.Allocate(Size, "Stale resource", __FILE__, __LINE__);
+    }
+
+    /// Frees the block that was allocated with the same size. The method is thread-safe.
+    void Free(void* pBlock, size_t Size)
+    {
+        const auto SizeClass = GetSizeClass(Size);
+        if (SizeClass < NumSizeClasses)
+            m_Pools[SizeClass].Free(pBlock);
+        else
+            m_Allocator.Free(pBlock);
+    }
+
+private:
+    static size_t GetSizeClass(size_t Size)
+    {
+        size_t SizeClass = 0;
+        while (SizeClass < NumSizeClasses && Size > (MinSizeClass << SizeClass))
+            ++SizeClass;
+        return SizeClass;
+    }
+
+    IMemoryAllocator& m_Allocator;
+
+    LockFreeBlockPool m_Pools[NumSizeClasses];
+};
+
 /// Helper class that wraps stale resources of different types
 class DynamicStaleResourceWrapper final
 {
@@ -63,16 +130,19 @@ public:
     //  |  AtomicLong          m_RefCounter                |         |______________________________________________|
     //  |__________________________________________________|
     //
+    // Stale resource objects are allocated from the pool owned by the release queue
+    // and keep a reference to it to free their memory.
 
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
-    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
+    static DynamicStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences, StaleResourcePool& Pool)
     {
         VERIFY_EXPR(NumReferences >= 1);
 
         class SpecificStaleResource final : public StaleResourceBase
         {
         public:
-            SpecificStaleResource(ResourceType&& SpecificResource) :
+            SpecificStaleResource(StaleResourcePool& Pool, ResourceType&& SpecificResource) :
+                StaleResourceBase{Pool},
                 m_SpecificResource(std::move(SpecificResource))
             {}
 
@@ -85,7 +155,7 @@ public:
 
             virtual void Release() override final
             {
-                delete this;
+                DestroyStaleResource(this);
             }
 
         private:
@@ -95,7 +165,8 @@ public:
         class SpecificSharedStaleResource final : public StaleResourceBase
         {
         public:
-            SpecificSharedStaleResource(ResourceType&& SpecificResource, Atomics::Long NumReferences) :
+            SpecificSharedStaleResource(StaleResourcePool& Pool, ResourceType&& SpecificResource, Atomics::Long NumReferences) :
+                StaleResourceBase{Pool},
                 m_SpecificResource(std::move(SpecificResource))
             {
                 m_RefCounter = NumReferences;
@@ -112,7 +183,7 @@ public:
             {
                 if (Atomics::AtomicDecrement(m_RefCounter) == 0)
                 {
-                    delete this;
+                    DestroyStaleResource(this);
                 }
             }
 
@@ -123,8 +194,8 @@ public:
 
         return DynamicStaleResourceWrapper{
             NumReferences == 1 ?
-                static_cast<StaleResourceBase*>(new SpecificStaleResource{std::move(Resource)}) :
-                static_cast<StaleResourceBase*>(new SpecificSharedStaleResource{std::move(Resource), NumReferences})};
+                static_cast<StaleResourceBase*>(CreateStaleResource<SpecificStaleResource>(Pool, std::move(Resource))) :
+                static_cast<StaleResourceBase*>(CreateStaleResource<SpecificSharedStaleResource>(Pool, std::move(Resource), NumReferences))};
     }
 
     DynamicStaleResourceWrapper(DynamicStaleResourceWrapper&& rhs) noexcept :
@@ -158,14 +229,50 @@ private:
     class StaleResourceBase
     {
     public:
+        explicit StaleResourceBase(StaleResourcePool& Pool) :
+            m_Pool{Pool}
+        {}
+
         virtual ~StaleResourceBase() = 0;
         virtual void Release()       = 0;
+
+        StaleResourcePool& GetPool() const
+        {
+            return m_Pool;
+        }
+
+    private:
+        StaleResourcePool& m_Pool;
     };
 
     DynamicStaleResourceWrapper(StaleResourceBase* pStaleResource) :
         m_pStaleResource(pStaleResource)
     {}
 
+    template <typename StaleResourceType, typename... ArgTypes>
+    static StaleResourceType* CreateStaleResource(StaleResourcePool& Pool, ArgTypes&&... Args)
+    {
+        static_assert(alignof(StaleResourceType) <= LockFreeBlockPool::BlockAlignment, "Stale resource type is overaligned");
+        void* pMem = Pool.Allocate(sizeof(StaleResourceType));
+        try
+        {
+            return new (pMem) StaleResourceType{Pool, std::forward<ArgTypes>(Args)...};
+        }
+        catch (...)
+        {
+            Pool.Free(pMem, sizeof(StaleResourceType));
+            throw;
+        }
+    }
+
+    template <typename StaleResourceType>
+    static void DestroyStaleResource(StaleResourceType* pStaleResource)
+    {
+        auto& Pool = pStaleResource->GetPool();
+        pStaleResource->~StaleResourceType();
+        Pool.Free(pStaleResource, sizeof(StaleResourceType));
+    }
+
     StaleResourceBase* m_pStaleResource;
 };
 
@@ -178,7 +285,7 @@ template <typename ResourceType>
 class StaticStaleResourceWrapper
 {
 public:
-    static StaticStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences)
+    static StaticStaleResourceWrapper Create(ResourceType&& Resource, Atomics::Long NumReferences, StaleResourcePool& /*Pool*/)
     {
         VERIFY(NumReferences == 1, "Number of references must be 1 for StaticStaleResourceWrapper");
         return StaticStaleResourceWrapper{std::move(Resource)};
@@ -216,6 +323,11 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// SafeReleaseResource() and DiscardResource() never take a lock: resources are pushed to
+/// intrusive lock-free lists and queue nodes are allocated from the lock-free pool. The lists are
+/// drained in batches by DiscardStaleResources() and Purge(), which are serialized with
+/// each other. Purge() destroys the resources after the lock is released.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -223,24 +335,32 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_NodePool   {Allocator, sizeof(QueueNode), 4096},
+        m_WrapperPool{Allocator}
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
-        DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DrainPendingList(m_PendingStaleResources, m_StaleResources);
+        DrainPendingList(m_PendingReleaseQueue, m_ReleaseQueue);
+        DEV_CHECK_ERR(m_StaleResources.IsEmpty(), "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(m_ReleaseQueue.IsEmpty(), "Release queue is not empty");
+
+        DestroyNodes(m_StaleResources.pHead);
+        DestroyNodes(m_ReleaseQueue.pHead);
     }
 
     /// Creates a resource wrapper for the specific resource type
     /// \param [in] Resource      - Resource to be released
     /// \param [in] NumReferences - Number of references to the resource
+    ///
+    /// \remarks   The wrapper memory is owned by this queue. A wrapper shared by several
+    ///            queues must be released by all of them before this queue is destroyed.
     template <typename ResourceType, typename = typename std::enable_if<std::is_object<ResourceType>::value>::type>
-    static ResourceWrapperType CreateWrapper(ResourceType&& Resource, Atomics::Long NumReferences)
+    ResourceWrapperType CreateWrapper(ResourceType&& Resource, Atomics::Long NumReferences)
     {
-        return ResourceWrapperType::Create(std::move(Resource), NumReferences);
+        return ResourceWrapperType::Create(std::move(Resource), NumReferences, m_WrapperPool);
     }
 
     /// Moves a resource to the stale resources queue
@@ -257,8 +377,9 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        auto* pNode = CreateNode(NextCommandListNumber, std::move(Wrapper));
+        PushPendingList(m_PendingStaleResources, pNode, pNode);
+        m_NumStaleResources.fetch_add(1);
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -266,8 +387,9 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        auto* pNode = CreateNode(NextCommandListNumber, Wrapper);
+        PushPendingList(m_PendingStaleResources, pNode, pNode);
+        m_NumStaleResources.fetch_add(1);
     }
 
     /// Adds a resource directly to the release queue
@@ -284,8 +406,9 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        auto* pNode = CreateNode(FenceValue, std::move(Wrapper));
+        PushPendingList(m_PendingReleaseQueue, pNode, pNode);
+        m_NumPendingReleaseResources.fetch_add(1);
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -293,21 +416,40 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        auto* pNode = CreateNode(FenceValue, Wrapper);
+        PushPendingList(m_PendingReleaseQueue, pNode, pNode);
+        m_NumPendingReleaseResources.fetch_add(1);
     }
 
     /// Adds multiple resources directly to the release queue
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     /// \param [in] Iterator    - Iterator that returns resources to be released.
+    ///
+    /// \remarks    All resources are added to the release queue with a single atomic operation.
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
+        // Pending lists are stored in reverse order, so the first node
+        // of the chain is the last discarded resource.
+        QueueNode* pFirst = nullptr;
+        QueueNode* pLast  = nullptr;
+        size_t     Count  = 0;
+
+        ResourceType Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            auto* pNode  = CreateNode(FenceValue, CreateWrapper(std::move(Resource), 1));
+            pNode->pNext = pFirst;
+            pFirst       = pNode;
+            if (pLast == nullptr)
+                pLast = pNode;
+            ++Count;
+        }
+
+        if (pFirst != nullptr)
+        {
+            PushPendingList(m_PendingReleaseQueue, pFirst, pLast);
+            m_NumPendingReleaseResources.fetch_add(Count);
         }
     }
 
@@ -320,20 +462,28 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        // Resources that were discarded directly must precede the stale resources
+        // that are moved to the release queue now.
+        DrainPendingList(m_PendingReleaseQueue, m_ReleaseQueue);
+        DrainPendingList(m_PendingStaleResources, m_StaleResources);
+
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
+        size_t NumMoved = 0;
+        while (m_StaleResources.pHead != nullptr && m_StaleResources.pHead->Value <= SubmittedCmdBuffNumber)
         {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
-            {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
-            }
-            else
-                break;
+            auto* pNode  = m_StaleResources.PopFront();
+            pNode->Value = FenceValue;
+            m_ReleaseQueue.PushBack(pNode, pNode);
+            ++NumMoved;
+        }
+
+        if (NumMoved != 0)
+        {
+            m_NumPendingReleaseResources.fetch_add(NumMoved);
+            m_NumStaleResources.fetch_sub(NumMoved);
         }
     }
 
@@ -343,39 +493,202 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        auto* pReleasedNodes = DetachCompletedResources(CompletedFenceValue);
+        DestroyReleasedNodes(pReleasedNodes);
+    }
 
-        // Release all objects whose associated fence value is at most CompletedFenceValue
-        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
+    /// Removes all objects from the release queue whose fence value is
+    /// less than or equal to CompletedFenceValue, and lets the executor destroy them
+    /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    /// \param [in] Executor             -  Function that is called with a task object (void() callable)
+    ///                                     that destroys the removed resources. The task must be run
+    ///                                     exactly once before the queue is destroyed, and may be
+    ///                                     run from any thread. The executor is not called if
+    ///                                     no resources were removed.
+    template <typename ExecutorType>
+    void Purge(Uint64 CompletedFenceValue, ExecutorType&& Executor)
+    {
+        auto* pReleasedNodes = DetachCompletedResources(CompletedFenceValue);
+        if (pReleasedNodes != nullptr)
         {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
+            Executor([this, pReleasedNodes]() {
+                DestroyReleasedNodes(pReleasedNodes);
+            });
         }
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_NumStaleResources.load();
     }
 
-    /// Returns the number of resources pending release
+    /// Returns the number of resources pending release.
+    /// Resources removed from the queue by Purge() are counted until they are destroyed.
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        return m_NumPendingReleaseResources.load();
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    struct QueueNode;
+
+    // Detaches all objects whose associated fence value is at most CompletedFenceValue.
+    // The objects are destroyed by DestroyReleasedNodes() outside of the lock so that
+    // destruction does not block other threads that discard or purge resources.
+    QueueNode* DetachCompletedResources(Uint64 CompletedFenceValue)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        DrainPendingList(m_PendingReleaseQueue, m_ReleaseQueue);
+
+        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        QueueNode* pLastReleased = nullptr;
+        for (auto* pNode = m_ReleaseQueue.pHead; pNode != nullptr && pNode->Value <= CompletedFenceValue; pNode = pNode->pNext)
+            pLastReleased = pNode;
+
+        if (pLastReleased == nullptr)
+            return nullptr;
+
+        auto* pReleasedNodes = m_ReleaseQueue.pHead;
+        m_ReleaseQueue.pHead = pLastReleased->pNext;
+        pLastReleased->pNext = nullptr;
+        if (m_ReleaseQueue.pHead == nullptr)
+            m_ReleaseQueue.pTail = nullptr;
+
+        return pReleasedNodes;
+    }
+
+    void DestroyReleasedNodes(QueueNode* pNodes)
+    {
+        if (const auto NumReleased = DestroyNodes(pNodes))
+            m_NumPendingReleaseResources.fetch_sub(NumReleased);
+    }
+
+    struct QueueNode
+    {
+        template <typename WrapperType>
+        QueueNode(Uint64 _Value, WrapperType&& _Wrapper) :
+            Value{_Value},
+            Wrapper{std::forward<WrapperType>(_Wrapper)}
+        {}
+
+        QueueNode* pNext = nullptr;
+
+        // Command list number for stale resources, fence value for resources in the release queue
+        Uint64 Value;
+
+        ResourceWrapperType Wrapper;
+    };
+    static_assert(alignof(QueueNode) <= LockFreeBlockPool::BlockAlignment, "Queue node is overaligned");
+
+    struct NodeList
+    {
+        QueueNode* pHead = nullptr;
+        QueueNode* pTail = nullptr;
+
+        bool IsEmpty() const
+        {
+            return pHead == nullptr;
+        }
+
+        void PushBack(QueueNode* pFirst, QueueNode* pLast)
+        {
+            VERIFY_EXPR(pFirst != nullptr && pLast != nullptr && pLast->pNext == nullptr);
+            if (pTail != nullptr)
+                pTail->pNext = pFirst;
+            else
+                pHead = pFirst;
+            pTail = pLast;
+        }
+
+        QueueNode* PopFront()
+        {
+            auto* pNode = pHead;
+            VERIFY_EXPR(pNode != nullptr);
+            pHead = pNode->pNext;
+            if (pHead == nullptr)
+                pTail = nullptr;
+            pNode->pNext = nullptr;
+            return pNode;
+        }
+    };
+
+    template <typename WrapperType>
+    QueueNode* CreateNode(Uint64 Value, WrapperType&& Wrapper)
+    {
+        void* pMem = m_NodePool.Allocate();
+        try
+        {
+            return new (pMem) QueueNode{Value, std::forward<WrapperType>(Wrapper)};
+        }
+        catch (...)
+        {
+            m_NodePool.Free(pMem);
+            throw;
+        }
+    }
+
+    size_t DestroyNodes(QueueNode* pNode)
+    {
+        size_t NumNodes = 0;
+        while (pNode != nullptr)
+        {
+            auto* pNext = pNode->pNext;
+            pNode->~QueueNode();
+            m_NodePool.Free(pNode);
+            pNode = pNext;
+            ++NumNodes;
+        }
+        return NumNodes;
+    }
+
+    // Pushes the chain pFirst -> ... -> pLast to the front of the lock-free pending list.
+    static void PushPendingList(std::atomic<QueueNode*>& PendingList, QueueNode* pFirst, QueueNode* pLast)
+    {
+        pLast->pNext = PendingList.load(std::memory_order_relaxed);
+        while (!PendingList.compare_exchange_weak(pLast->pNext, pFirst, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Takes all nodes from the pending list and appends them to the end of the list in the order they were pushed.
+    static void DrainPendingList(std::atomic<QueueNode*>& PendingList, NodeList& List)
+    {
+        auto* pNode = PendingList.exchange(nullptr, std::memory_order_acquire);
+        if (pNode == nullptr)
+            return;
+
+        // The pending list is in reverse order
+        QueueNode* pReversed = nullptr;
+        QueueNode* pLast     = pNode;
+        while (pNode != nullptr)
+        {
+            auto* pNext  = pNode->pNext;
+            pNode->pNext = pReversed;
+            pReversed    = pNode;
+            pNode        = pNext;
+        }
+        List.PushBack(pReversed, pLast);
+    }
+
+    LockFreeBlockPool m_NodePool;
+
+    // Memory for the stale resources created by CreateWrapper()
+    StaleResourcePool m_WrapperPool;
+
+    // Lists of the resources that have been released, but not yet seen by DiscardStaleResources() or Purge().
+    // Most recently released resources are at the front.
+    std::atomic<QueueNode*> m_PendingStaleResources{nullptr};
+    std::atomic<QueueNode*> m_PendingReleaseQueue{nullptr};
+
+    // Serializes DiscardStaleResources() and Purge()
+    std::mutex m_Mtx;
+    NodeList   m_StaleResources;
+    NodeList   m_ReleaseQueue;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    std::atomic<size_t> m_NumStaleResources{0};
+    std::atomic<size_t> m_NumPendingReleaseResources{0};
 };
 
 } // namespace Diligent
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
 #include "../../../Common/interface/FixedBlockMemoryAllocator.hpp"
 
 namespace Diligent
@@ -61,6 +62,9 @@ public:
         return m_DataAllocators != nullptr ? m_DataAllocators[m_ShaderVariableDataAllocatorCount + Ind] : m_RawMemAllocator;
     }
 
+    // Adds the occupancy of all fixed-block allocators to Stats
+    void GetStatistics(ObjectPoolStatistics& Stats);
+
 private:
     IMemoryAllocator& m_RawMemAllocator;
 
@@ -0,0 +1,662 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Two-level segregated fit (TLSF) free block manager that handles variable-size allocation requests.
+// The class is a drop-in replacement for VariableSizeAllocationsManager: it has the same interface and
+// uses the same Allocation struct, but every Allocate() and Free() operation takes constant time and
+// does not allocate memory once the internal tables have grown to fit the working set.
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+
+// Free blocks are distributed between size classes. The first level splits sizes by their most
+// significant bit (power-of-two ranges), and the second level linearly subdivides every range into
+// SLCount classes. Every class keeps a doubly-linked list of its free blocks, and two bitmaps keep
+// track of non-empty classes, so that a suitable class is found with two bit scans.
+//
+//   m_FLBitmap     0 0 1 0 1 ...
+//                      |   |
+//   m_SLBitmap[2]      |   '--> 0 1 0 0 ... 1   m_FreeListHeads[4][1] -> Block -> Block
+//                      |
+//   m_SLBitmap[4]      '------> 1 0 0 0 ... 0   m_FreeListHeads[2][0] -> Block
+//
+// As the managed memory is not accessible, block information is stored out-of-band. Two open-addressing
+// hash tables map start and end offsets of free blocks to block indices, which allows finding and merging
+// adjacent free blocks in Free().
+//
+// Similar to VariableSizeAllocationsManager, the offset returned by Allocate() may not be aligned,
+// but the size of the allocation is sufficient to properly align it.
+class TLSFAllocationsManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+private:
+    static constexpr Uint32 SLBits  = 4;
+    static constexpr Uint32 SLCount = 1u << SLBits;
+    static constexpr Uint32 FLCount = sizeof(OffsetType) * 8 - SLBits + 1;
+
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct BlockInfo
+    {
+        OffsetType Offset   = 0;
+        OffsetType Size     = 0;
+        Uint32     PrevFree = InvalidIndex;
+        Uint32     NextFree = InvalidIndex; // Also links unused block slots
+    };
+
+    // Open-addressing hash table with linear probing that maps offsets to block indices
+    class OffsetHashTable
+    {
+    public:
+        explicit OffsetHashTable(IMemoryAllocator& Allocator) :
+            m_Entries(InitialCapacity, Entry{}, STD_ALLOCATOR_RAW_MEM(Entry, Allocator, "Allocator for vector<TLSFAllocationsManager::OffsetHashTable::Entry>"))
+        {}
+
+        // clang-format off
+        OffsetHashTable             (OffsetHashTable&&)      = default;
+        OffsetHashTable& operator = (OffsetHashTable&&)      = default;
+        OffsetHashTable             (const OffsetHashTable&) = delete;
+        OffsetHashTable& operator = (const OffsetHashTable&) = delete;
+        // clang-format on
+
+        void Insert(OffsetType Key, Uint32 Value)
+        {
+            VERIFY_EXPR(Key != InvalidKey);
+            if ((m_Size + 1) * 2 > m_Entries.size())
+                Grow();
+
+            const auto Mask = m_Entries.size() - 1;
+            for (auto i = GetHomeSlot(Key);; i = (i + 1) & Mask)
+            {
+                auto& Slot = m_Entries[i];
+                VERIFY(Slot.Key != Key, "Key ", Key, " is already in the table");
+                if (Slot.Key == InvalidKey)
+                {
+                    Slot.Key   = Key;
+                    Slot.Value = Value;
+                    ++m_Size;
+                    return;
+                }
+            }
+        }
+
+        Uint32 Find(OffsetType Key) const
+        {
+            const auto Slot = FindSlot(Key);
+            if (Slot == InvalidSlot)
+                return InvalidIndex;
+            return m_Entries[Slot].Value;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            auto i = FindSlot(Key);
+            VERIFY(i != InvalidSlot, "Key ", Key, " is not found in the table");
+            if (i == InvalidSlot)
+                return;
+
+            // Backward-shift deletion: move subsequent entries of the probe sequence into the freed
+            // slot unless their home slot lies cyclically in (i, j].
+            const auto Mask = m_Entries.size() - 1;
+            for (auto j = (i + 1) & Mask; m_Entries[j].Key != InvalidKey; j = (j + 1) & Mask)
+            {
+                const auto k = GetHomeSlot(m_Entries[j].Key);
+
+                const bool KeepInPlace = (i < j) ? (i < k && k <= j) : (i < k || k <= j);
+                if (!KeepInPlace)
+                {
+                    m_Entries[i] = m_Entries[j];
+                    i            = j;
+                }
+            }
+            m_Entries[i] = Entry{};
+            --m_Size;
+        }
+
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        static constexpr OffsetType InvalidKey      = ~OffsetType{0};
+        static constexpr size_t     InvalidSlot     = ~size_t{0};
+        static constexpr size_t     InitialCapacity = 16;
+
+        struct Entry
+        {
+            OffsetType Key   = InvalidKey;
+            Uint32     Value = InvalidIndex;
+        };
+
+        size_t GetHomeSlot(OffsetType Key) const
+        {
+            // Fibonacci hashing
+            return static_cast<size_t>((static_cast<Uint64>(Key) * Uint64{0x9E3779B97F4A7C15}) >> m_Shift);
+        }
+
+        size_t FindSlot(OffsetType Key) const
+        {
+            if (m_Entries.empty())
+                return InvalidSlot; // Moved-from table
+
+            const auto Mask = m_Entries.size() - 1;
+            for (auto i = GetHomeSlot(Key);; i = (i + 1) & Mask)
+            {
+                const auto& Slot = m_Entries[i];
+                if (Slot.Key == Key)
+                    return i;
+                if (Slot.Key == InvalidKey)
+                    return InvalidSlot;
+            }
+        }
+
+        void Grow()
+        {
+            const size_t NewCapacity = !m_Entries.empty() ? m_Entries.size() * 2 : InitialCapacity;
+
+            decltype(m_Entries) OldEntries(NewCapacity, Entry{}, m_Entries.get_allocator());
+            std::swap(OldEntries, m_Entries);
+            m_Shift = 64 - PlatformMisc::GetMSB(static_cast<Uint64>(NewCapacity));
+            m_Size  = 0;
+            for (const auto& OldEntry : OldEntries)
+            {
+                if (OldEntry.Key != InvalidKey)
+                    Insert(OldEntry.Key, OldEntry.Value);
+            }
+        }
+
+        std::vector<Entry, STDAllocatorRawMem<Entry>> m_Entries;
+
+        size_t m_Size  = 0;
+        Uint32 m_Shift = 64 - 4; // 64 - log2(InitialCapacity)
+    };
+
+public:
+    TLSFAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+        m_Blocks(STD_ALLOCATOR_RAW_MEM(BlockInfo, Allocator, "Allocator for vector<TLSFAllocationsManager::BlockInfo>")),
+        m_BlocksByStart{Allocator},
+        m_BlocksByEnd{Allocator},
+        m_MaxSize{MaxSize},
+        m_FreeSize{MaxSize}
+    {
+        ResetFreeLists();
+
+        // Insert single maximum-size block
+        if (m_MaxSize > 0)
+            InsertFreeBlock(CreateBlock(0, m_MaxSize));
+        ResetCurrAlignment();
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    ~TLSFAllocationsManager()
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_NumFreeBlocks != 0)
+        {
+            VERIFY(m_NumFreeBlocks == 1, "Single free block is expected");
+            const auto HeadBlockIdx = m_BlocksByStart.Find(0);
+            VERIFY(HeadBlockIdx != InvalidIndex, "Head chunk offset is expected to be 0");
+            if (HeadBlockIdx != InvalidIndex)
+                VERIFY(m_Blocks[HeadBlockIdx].Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+        }
+#endif
+    }
+
+    // clang-format off
+    TLSFAllocationsManager(TLSFAllocationsManager&& rhs) noexcept :
+        m_Blocks          {std::move(rhs.m_Blocks)       },
+        m_BlocksByStart   {std::move(rhs.m_BlocksByStart)},
+        m_BlocksByEnd     {std::move(rhs.m_BlocksByEnd)  },
+        m_FirstUnusedBlock{rhs.m_FirstUnusedBlock},
+        m_NumFreeBlocks   {rhs.m_NumFreeBlocks   },
+        m_FLBitmap        {rhs.m_FLBitmap        },
+        m_MaxSize         {rhs.m_MaxSize         },
+        m_FreeSize        {rhs.m_FreeSize        },
+        m_CurrAlignment   {rhs.m_CurrAlignment   }
+    {
+        // clang-format on
+        std::copy(std::begin(rhs.m_SLBitmap), std::end(rhs.m_SLBitmap), std::begin(m_SLBitmap));
+        for (Uint32 fl = 0; fl < FLCount; ++fl)
+            std::copy(std::begin(rhs.m_FreeListHeads[fl]), std::end(rhs.m_FreeListHeads[fl]), std::begin(m_FreeListHeads[fl]));
+
+        rhs.ResetFreeLists();
+        rhs.m_FirstUnusedBlock = InvalidIndex;
+        rhs.m_NumFreeBlocks    = 0;
+        rhs.m_MaxSize          = 0;
+        rhs.m_FreeSize         = 0;
+        rhs.m_CurrAlignment    = 0;
+    }
+
+    // clang-format off
+    TLSFAllocationsManager& operator = (TLSFAllocationsManager&& rhs) = default;
+    TLSFAllocationsManager             (const TLSFAllocationsManager&) = delete;
+    TLSFAllocationsManager& operator = (const TLSFAllocationsManager&) = delete;
+    // clang-format on
+
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
+
+        // All free block offsets are m_CurrAlignment-aligned, so this is the maximum
+        // number of bytes required to align any block
+        const auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
+        const auto BlockIdx         = FindFreeBlock(Size + AlignmentReserve);
+        if (BlockIdx == InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        RemoveFreeBlock(BlockIdx);
+
+        auto& Block = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Size + AlignmentReserve <= Block.Size);
+
+        //     Block.Offset
+        //        |                                  |
+        //        |<-----------Block.Size----------->|
+        //        |<------Size------>|<---NewSize--->|
+        //        |                  |
+        //      Offset              NewOffset
+        //
+        const auto Offset = Block.Offset;
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+        const auto AlignedOffset = AlignUp(Offset, Alignment);
+        const auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
+        if (Block.Size > AdjustedSize)
+        {
+            // Reuse the block for the remaining free space
+            Block.Offset += AdjustedSize;
+            Block.Size -= AdjustedSize;
+            InsertFreeBlock(BlockIdx);
+        }
+        else
+        {
+            ReleaseBlock(BlockIdx);
+        }
+
+        m_FreeSize -= AdjustedSize;
+
+        if ((Size & (m_CurrAlignment - 1)) != 0)
+        {
+            if (IsPowerOfTwo(Size))
+            {
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = std::min(m_CurrAlignment, Alignment);
+            }
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void Free(Allocation&& allocation)
+    {
+        VERIFY_EXPR(allocation.IsValid());
+        Free(allocation.UnalignedOffset, allocation.Size);
+        allocation = Allocation{};
+    }
+
+    void Free(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
+        // Block being deallocated must not overlap with other free blocks
+        VERIFY_EXPR(m_BlocksByStart.Find(Offset) == InvalidIndex && m_BlocksByEnd.Find(Offset + Size) == InvalidIndex);
+
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+
+        //   PrevBlock.Offset           Offset            NextBlock.Offset
+        //     |                          |                    |
+        //     |<-----PrevBlock.Size----->|<------Size-------->|<-----NextBlock.Size----->|
+        //
+        auto BlockIdx = m_BlocksByEnd.Find(Offset);
+        if (BlockIdx != InvalidIndex)
+        {
+            RemoveFreeBlock(BlockIdx);
+            NewOffset = m_Blocks[BlockIdx].Offset;
+            NewSize += m_Blocks[BlockIdx].Size;
+        }
+
+        const auto NextBlockIdx = m_BlocksByStart.Find(Offset + Size);
+        if (NextBlockIdx != InvalidIndex)
+        {
+            RemoveFreeBlock(NextBlockIdx);
+            NewSize += m_Blocks[NextBlockIdx].Size;
+            if (BlockIdx == InvalidIndex)
+                BlockIdx = NextBlockIdx;
+            else
+                ReleaseBlock(NextBlockIdx);
+        }
+
+        if (BlockIdx == InvalidIndex)
+            BlockIdx = CreateBlock(NewOffset, NewSize);
+
+        m_Blocks[BlockIdx].Offset = NewOffset;
+        m_Blocks[BlockIdx].Size   = NewSize;
+        InsertFreeBlock(BlockIdx);
+
+        m_FreeSize += Size;
+        if (IsEmpty())
+        {
+            // Reset current alignment
+            VERIFY_EXPR(GetNumFreeBlocks() == 1);
+            ResetCurrAlignment();
+        }
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_NumFreeBlocks;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        auto LastBlockIdx = m_BlocksByEnd.Find(m_MaxSize);
+        if (LastBlockIdx != InvalidIndex)
+        {
+            // Extend the last block
+            RemoveFreeBlock(LastBlockIdx);
+            m_Blocks[LastBlockIdx].Size += ExtraSize;
+        }
+        else
+        {
+            LastBlockIdx = CreateBlock(m_MaxSize, ExtraSize);
+        }
+        InsertFreeBlock(LastBlockIdx);
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
+private:
+    // Returns the first and the second level indices of the class that contains the size
+    static void MapSize(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SLCount)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(static_cast<Uint64>(Size));
+
+            FL = MSB - SLBits + 1;
+            SL = static_cast<Uint32>(Size >> (MSB - SLBits)) ^ SLCount;
+        }
+        VERIFY_EXPR(FL < FLCount && SL < SLCount);
+    }
+
+    Uint32 FindFreeBlock(OffsetType Size) const
+    {
+        Uint32 FL = 0, SL = 0;
+        // Round the size up to the next class boundary so that any block
+        // in the list that is found is large enough (good fit).
+        auto RoundedSize = Size;
+        if (RoundedSize >= SLCount)
+            RoundedSize += (OffsetType{1} << (PlatformMisc::GetMSB(static_cast<Uint64>(RoundedSize)) - SLBits)) - 1;
+
+        if (RoundedSize >= Size) // Check for overflow
+        {
+            MapSize(RoundedSize, FL, SL);
+
+            auto SLMap = m_SLBitmap[FL] & (~Uint32{0} << SL);
+            if (SLMap == 0)
+            {
+                const auto FLMap = (FL + 1 < FLCount) ? m_FLBitmap & (~Uint64{0} << (FL + 1)) : 0;
+                if (FLMap != 0)
+                {
+                    FL    = PlatformMisc::GetLSB(FLMap);
+                    SLMap = m_SLBitmap[FL];
+                    VERIFY_EXPR(SLMap != 0);
+                }
+            }
+
+            if (SLMap != 0)
+            {
+                SL = PlatformMisc::GetLSB(SLMap);
+                VERIFY_EXPR(m_FreeListHeads[FL][SL] != InvalidIndex);
+                return m_FreeListHeads[FL][SL];
+            }
+        }
+
+        // No block in classes above the requested size. The class that contains the size
+        // may still have a large enough block, which can only be found by a linear search.
+        MapSize(Size, FL, SL);
+        for (auto BlockIdx = m_FreeListHeads[FL][SL]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+        {
+            if (m_Blocks[BlockIdx].Size >= Size)
+                return BlockIdx;
+        }
+
+        return InvalidIndex;
+    }
+
+    Uint32 CreateBlock(OffsetType Offset, OffsetType Size)
+    {
+        Uint32 BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+        }
+        else
+        {
+            BlockIdx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        auto& Block  = m_Blocks[BlockIdx];
+        Block.Offset = Offset;
+        Block.Size   = Size;
+        return BlockIdx;
+    }
+
+    void ReleaseBlock(Uint32 BlockIdx)
+    {
+        auto& Block        = m_Blocks[BlockIdx];
+        Block              = BlockInfo{};
+        Block.NextFree     = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = BlockIdx;
+    }
+
+    void InsertFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Block.Size > 0);
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Block.Size, FL, SL);
+
+        auto& Head     = m_FreeListHeads[FL][SL];
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = Head;
+        if (Head != InvalidIndex)
+            m_Blocks[Head].PrevFree = BlockIdx;
+        Head = BlockIdx;
+
+        m_SLBitmap[FL] |= 1u << SL;
+        m_FLBitmap |= Uint64{1} << FL;
+
+        m_BlocksByStart.Insert(Block.Offset, BlockIdx);
+        m_BlocksByEnd.Insert(Block.Offset + Block.Size, BlockIdx);
+        ++m_NumFreeBlocks;
+    }
+
+    void RemoveFreeBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+
+        Uint32 FL = 0, SL = 0;
+        MapSize(Block.Size, FL, SL);
+
+        if (Block.PrevFree != InvalidIndex)
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        auto& Head = m_FreeListHeads[FL][SL];
+        if (Head == BlockIdx)
+        {
+            Head = Block.NextFree;
+            if (Head == InvalidIndex)
+            {
+                m_SLBitmap[FL] &= ~(1u << SL);
+                if (m_SLBitmap[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = InvalidIndex;
+
+        m_BlocksByStart.Erase(Block.Offset);
+        m_BlocksByEnd.Erase(Block.Offset + Block.Size);
+        VERIFY_EXPR(m_NumFreeBlocks > 0);
+        --m_NumFreeBlocks;
+    }
+
+    void ResetFreeLists()
+    {
+        m_FLBitmap = 0;
+        for (Uint32 fl = 0; fl < FLCount; ++fl)
+        {
+            m_SLBitmap[fl] = 0;
+            for (Uint32 sl = 0; sl < SLCount; ++sl)
+                m_FreeListHeads[fl][sl] = InvalidIndex;
+        }
+    }
+
+    void ResetCurrAlignment()
+    {
+        for (m_CurrAlignment = 1; m_CurrAlignment * 2 <= m_MaxSize; m_CurrAlignment *= 2)
+        {}
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyList()
+    {
+        OffsetType TotalFreeSize = 0;
+        size_t     NumBlocks     = 0;
+
+        VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+        for (Uint32 fl = 0; fl < FLCount; ++fl)
+        {
+            VERIFY_EXPR(((m_FLBitmap >> fl) & 1) == (m_SLBitmap[fl] != 0 ? 1 : 0));
+            for (Uint32 sl = 0; sl < SLCount; ++sl)
+            {
+                VERIFY_EXPR(((m_SLBitmap[fl] >> sl) & 1) == (m_FreeListHeads[fl][sl] != InvalidIndex ? 1 : 0));
+
+                auto PrevBlockIdx = InvalidIndex;
+                for (auto BlockIdx = m_FreeListHeads[fl][sl]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+                    VERIFY_EXPR(Block.PrevFree == PrevBlockIdx);
+                    VERIFY_EXPR(Block.Offset + Block.Size <= m_MaxSize);
+                    VERIFY((Block.Offset & (m_CurrAlignment - 1)) == 0, "Block offset (", Block.Offset, ") is not ", m_CurrAlignment, "-aligned");
+                    if (Block.Offset + Block.Size < m_MaxSize)
+                        VERIFY((Block.Size & (m_CurrAlignment - 1)) == 0, "All block sizes except for the last one must be ", m_CurrAlignment, "-aligned");
+
+                    Uint32 FL = 0, SL = 0;
+                    MapSize(Block.Size, FL, SL);
+                    VERIFY(FL == fl && SL == sl, "Block is in the wrong free list");
+                    VERIFY_EXPR(m_BlocksByStart.Find(Block.Offset) == BlockIdx);
+                    VERIFY_EXPR(m_BlocksByEnd.Find(Block.Offset + Block.Size) == BlockIdx);
+                    VERIFY(m_BlocksByStart.Find(Block.Offset + Block.Size) == InvalidIndex, "Unmerged adjacent blocks detected");
+
+                    TotalFreeSize += Block.Size;
+                    ++NumBlocks;
+                    PrevBlockIdx = BlockIdx;
+                }
+            }
+        }
+
+        VERIFY_EXPR(NumBlocks == m_NumFreeBlocks);
+        VERIFY_EXPR(m_BlocksByStart.GetSize() == m_NumFreeBlocks && m_BlocksByEnd.GetSize() == m_NumFreeBlocks);
+        VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+    }
+#endif
+
+    std::vector<BlockInfo, STDAllocatorRawMem<BlockInfo>> m_Blocks;
+
+    OffsetHashTable m_BlocksByStart;
+    OffsetHashTable m_BlocksByEnd;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumFreeBlocks    = 0;
+
+    Uint64 m_FLBitmap = 0;
+    Uint32 m_SLBitmap[FLCount];
+    Uint32 m_FreeListHeads[FLCount][SLCount];
+
+    OffsetType m_MaxSize       = 0;
+    OffsetType m_FreeSize      = 0;
+    OffsetType m_CurrAlignment = 0;
+    // When adding new members, do not forget to update move ctor
+};
+
+} // namespace Diligent
@@ -27,7 +27,20 @@
 
 #include <array>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_COLOR_CONVERSION_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define DILIGENT_COLOR_CONVERSION_NEON 1
+#    include <arm_neon.h>
+#endif
+
 #include "ColorConversion.h"
+#include "DebugUtilities.hpp"
 
 namespace Diligent
 {
@@ -75,6 +88,166 @@ private:
     std::array<float, 256> m_ToLinear;
 };
 
+const SRGBToLinearMap& GetSRGBToLinearMap()
+{
+    static const SRGBToLinearMap map;
+    return map;
+}
+
+// Exact reference conversions computed in double precision
+Uint8 LinearToSRGB8Exact(double x)
+{
+    x = std::min(std::max(x, 0.0), 1.0);
+
+    const auto s = x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055;
+    return static_cast<Uint8>(std::min(std::floor(s * 255.0 + 0.5), 255.0));
+}
+
+Uint8 SRGBToLinear8Exact(Uint8 c)
+{
+    const auto x = static_cast<double>(c) / 255.0;
+    const auto l = x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4);
+    return static_cast<Uint8>(std::min(std::floor(l * 255.0 + 0.5), 255.0));
+}
+
+Uint32 FloatAsUint(float f)
+{
+    Uint32 u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float UintAsFloat(Uint32 u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Float to 8-bit sRGB conversion table.
+//
+// The inputs are clamped to [2^-13, 1 - eps]: all smaller values map to 0.
+// The clamped range is split into buckets by the exponent and the 7 leading mantissa bits.
+// Every bucket spans less than one output unit, so it contains at most one rounding
+// threshold. The result is the code of the bucket's first value, incremented by one
+// if the input is not less than the bucket threshold.
+class LinearToSRGB8Table
+{
+public:
+    static constexpr Uint32 MinValBits    = (127 - 13) << 23;
+    static constexpr Uint32 AlmostOneBits = 0x3F7FFFFF;
+    static constexpr Uint32 BucketShift   = 16;
+    static constexpr Uint32 NumBuckets    = ((AlmostOneBits - MinValBits) >> BucketShift) + 1;
+
+    LinearToSRGB8Table() noexcept
+    {
+        for (Uint32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+        {
+            const Uint32 FirstBits = MinValBits + (Bucket << BucketShift);
+            const Uint32 LastBits  = std::min(FirstBits + (1u << BucketShift) - 1u, AlmostOneBits);
+
+            const auto FirstCode = LinearToSRGB8Exact(UintAsFloat(FirstBits));
+            const auto LastCode  = LinearToSRGB8Exact(UintAsFloat(LastBits));
+            VERIFY(LastCode - FirstCode <= 1, "Bucket spans more than one output unit");
+
+            m_Codes[Bucket] = FirstCode;
+            if (LastCode == FirstCode)
+            {
+                // No threshold in the bucket
+                m_Thresholds[Bucket] = 2.f;
+                continue;
+            }
+
+            // Find the first value that maps to LastCode
+            Uint32 Lo = FirstBits;
+            Uint32 Hi = LastBits;
+            while (Lo < Hi)
+            {
+                const auto Mid = Lo + (Hi - Lo) / 2;
+                if (LinearToSRGB8Exact(UintAsFloat(Mid)) == LastCode)
+                    Hi = Mid;
+                else
+                    Lo = Mid + 1;
+            }
+            m_Thresholds[Bucket] = UintAsFloat(Hi);
+        }
+    }
+
+    static const LinearToSRGB8Table& Get()
+    {
+        static const LinearToSRGB8Table Table;
+        return Table;
+    }
+
+    Uint8 Convert(float x) const
+    {
+        // Written to map NaNs to the minimum value
+        if (!(x > UintAsFloat(MinValBits)))
+            x = UintAsFloat(MinValBits);
+        if (x > UintAsFloat(AlmostOneBits))
+            x = UintAsFloat(AlmostOneBits);
+
+        const auto Bucket = (FloatAsUint(x) - MinValBits) >> BucketShift;
+        return static_cast<Uint8>(m_Codes[Bucket] + (x >= m_Thresholds[Bucket] ? 1 : 0));
+    }
+
+    const float* GetThresholds() const { return m_Thresholds.data(); }
+    const Uint8* GetCodes() const { return m_Codes.data(); }
+
+private:
+    std::array<float, NumBuckets> m_Thresholds;
+    std::array<Uint8, NumBuckets> m_Codes;
+};
+
+// Constants passed by reference (e.g. to std::min) are ODR-used and require definitions in C++14
+constexpr Uint32 LinearToSRGB8Table::MinValBits;
+constexpr Uint32 LinearToSRGB8Table::AlmostOneBits;
+constexpr Uint32 LinearToSRGB8Table::BucketShift;
+constexpr Uint32 LinearToSRGB8Table::NumBuckets;
+
+// 8-bit to 8-bit conversion tables
+class RGBA8ConversionTables
+{
+public:
+    RGBA8ConversionTables() noexcept
+    {
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            m_ToLinear[i] = SRGBToLinear8Exact(static_cast<Uint8>(i));
+            m_ToSRGB[i]   = LinearToSRGB8Exact(static_cast<double>(i) / 255.0);
+        }
+    }
+
+    static const RGBA8ConversionTables& Get()
+    {
+        static const RGBA8ConversionTables Tables;
+        return Tables;
+    }
+
+    const Uint8* GetToLinear() const { return m_ToLinear.data(); }
+    const Uint8* GetToSRGB() const { return m_ToSRGB.data(); }
+
+private:
+    std::array<Uint8, 256> m_ToLinear;
+    std::array<Uint8, 256> m_ToSRGB;
+};
+
+void ConvertRGBA8(const Uint8* pSrc, Uint8* pDst, size_t NumTexels, const Uint8* Table)
+{
+    for (size_t i = 0; i < NumTexels; ++i)
+    {
+        const Uint8 r = Table[pSrc[i * 4 + 0]];
+        const Uint8 g = Table[pSrc[i * 4 + 1]];
+        const Uint8 b = Table[pSrc[i * 4 + 2]];
+        const Uint8 a = pSrc[i * 4 + 3];
+
+        pDst[i * 4 + 0] = r;
+        pDst[i * 4 + 1] = g;
+        pDst[i * 4 + 2] = b;
+        pDst[i * 4 + 3] = a;
+    }
+}
+
 } // namespace
 
 float LinearToSRGB(Uint8 x)
@@ -85,8 +258,107 @@ float LinearToSRGB(Uint8 x)
 
 float SRGBToLinear(Uint8 x)
 {
-    static const SRGBToLinearMap map;
-    return map[x];
+    return GetSRGBToLinearMap()[x];
+}
+
+void ConvertSRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pSRGB != nullptr && pLinear != nullptr));
+
+    // The baseline instruction sets have no gather instructions, so the table is read
+    // one value at a time. The loop is unrolled to hide the load latency.
+    const auto& Map = GetSRGBToLinearMap();
+
+    size_t i = 0;
+    for (; i + 4 <= Count; i += 4)
+    {
+        const float l0 = Map[pSRGB[i + 0]];
+        const float l1 = Map[pSRGB[i + 1]];
+        const float l2 = Map[pSRGB[i + 2]];
+        const float l3 = Map[pSRGB[i + 3]];
+
+        pLinear[i + 0] = l0;
+        pLinear[i + 1] = l1;
+        pLinear[i + 2] = l2;
+        pLinear[i + 3] = l3;
+    }
+    for (; i < Count; ++i)
+        pLinear[i] = Map[pSRGB[i]];
+}
+
+void ConvertLinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t Count)
+{
+    VERIFY_EXPR(Count == 0 || (pLinear != nullptr && pSRGB != nullptr));
+
+    const auto& Table = LinearToSRGB8Table::Get();
+
+    size_t i = 0;
+#if DILIGENT_COLOR_CONVERSION_SSE2 || DILIGENT_COLOR_CONVERSION_NEON
+    // Clamping, bucket index computation and threshold comparison are done for four values at a time.
+    // Table reads are scalar as there are no gather instructions.
+    const float* const Thresholds = Table.GetThresholds();
+    const Uint8* const Codes      = Table.GetCodes();
+
+#    if DILIGENT_COLOR_CONVERSION_SSE2
+    const __m128  MinVal    = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(LinearToSRGB8Table::MinValBits)));
+    const __m128  AlmostOne = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(LinearToSRGB8Table::AlmostOneBits)));
+    const __m128i MinBits   = _mm_set1_epi32(static_cast<int>(LinearToSRGB8Table::MinValBits));
+    for (; i + 4 <= Count; i += 4)
+    {
+        // _mm_max_ps returns the second operand if the first one is NaN
+        const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pLinear + i), MinVal), AlmostOne);
+
+        alignas(16) Uint32 Buckets[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(Buckets), _mm_srli_epi32(_mm_sub_epi32(_mm_castps_si128(x), MinBits), LinearToSRGB8Table::BucketShift));
+
+        const __m128  Threshold = _mm_setr_ps(Thresholds[Buckets[0]], Thresholds[Buckets[1]], Thresholds[Buckets[2]], Thresholds[Buckets[3]]);
+        const __m128i Code      = _mm_setr_epi32(Codes[Buckets[0]], Codes[Buckets[1]], Codes[Buckets[2]], Codes[Buckets[3]]);
+        // The comparison mask is -1 for the values that reach the bucket threshold
+        const __m128i Result = _mm_sub_epi32(Code, _mm_castps_si128(_mm_cmpge_ps(x, Threshold)));
+
+        const __m128i Packed16 = _mm_packs_epi32(Result, Result);
+        const int     Packed8  = _mm_cvtsi128_si32(_mm_packus_epi16(Packed16, Packed16));
+        memcpy(pSRGB + i, &Packed8, 4);
+    }
+#    else
+    const float32x4_t MinVal    = vreinterpretq_f32_u32(vdupq_n_u32(LinearToSRGB8Table::MinValBits));
+    const float32x4_t AlmostOne = vreinterpretq_f32_u32(vdupq_n_u32(LinearToSRGB8Table::AlmostOneBits));
+    const uint32x4_t  MinBits   = vdupq_n_u32(LinearToSRGB8Table::MinValBits);
+    for (; i + 4 <= Count; i += 4)
+    {
+        float32x4_t x = vld1q_f32(pLinear + i);
+        // vmaxq_f32 propagates NaNs, so replace them explicitly
+        x = vbslq_f32(vcgtq_f32(x, MinVal), x, MinVal);
+        x = vminq_f32(x, AlmostOne);
+
+        Uint32 Buckets[4];
+        vst1q_u32(Buckets, vshrq_n_u32(vsubq_u32(vreinterpretq_u32_f32(x), MinBits), LinearToSRGB8Table::BucketShift));
+
+        const float      ThresholdVals[4] = {Thresholds[Buckets[0]], Thresholds[Buckets[1]], Thresholds[Buckets[2]], Thresholds[Buckets[3]]};
+        const Uint32     CodeVals[4]      = {Codes[Buckets[0]], Codes[Buckets[1]], Codes[Buckets[2]], Codes[Buckets[3]]};
+        const uint32x4_t Result           = vsubq_u32(vld1q_u32(CodeVals), vcgeq_f32(x, vld1q_f32(ThresholdVals)));
+
+        const uint16x4_t Packed16 = vmovn_u32(Result);
+        const uint8x8_t  Packed8  = vmovn_u16(vcombine_u16(Packed16, Packed16));
+        vst1_lane_u32(reinterpret_cast<uint32_t*>(pSRGB + i), vreinterpret_u32_u8(Packed8), 0);
+    }
+#    endif
+#endif
+
+    for (; i < Count; ++i)
+        pSRGB[i] = Table.Convert(pLinear[i]);
+}
+
+void ConvertRGBA8SRGBToLinear(const Uint8* pSRGB, Uint8* pLinear, size_t NumTexels)
+{
+    VERIFY_EXPR(NumTexels == 0 || (pSRGB != nullptr && pLinear != nullptr));
+    ConvertRGBA8(pSRGB, pLinear, NumTexels, RGBA8ConversionTables::Get().GetToLinear());
+}
+
+void ConvertRGBA8LinearToSRGB(const Uint8* pLinear, Uint8* pSRGB, size_t NumTexels)
+{
+    VERIFY_EXPR(NumTexels == 0 || (pLinear != nullptr && pSRGB != nullptr));
+    ConvertRGBA8(pLinear, pSRGB, NumTexels, RGBA8ConversionTables::Get().GetToSRGB());
 }
 
 } // namespace Diligent
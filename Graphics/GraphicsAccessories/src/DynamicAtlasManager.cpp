@@ -28,6 +28,7 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
 
 #include "AdvancedMath.hpp"
 
@@ -110,18 +111,30 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, PACKING_STRATEGY Strategy) :
     m_Width{Width},
-    m_Height{Height}
+    m_Height{Height},
+    m_Strategy{Strategy}
 {
-    m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    if (m_Strategy == PACKING_STRATEGY::TREE)
+    {
+        m_Root->R = Region{0, 0, Width, Height};
+        RegisterNode(*m_Root);
+    }
+    else
+    {
+        ResetPacker();
+    }
 }
 
 
 DynamicAtlasManager::~DynamicAtlasManager()
 {
-    if (m_Root)
+    if (m_Strategy != PACKING_STRATEGY::TREE)
+    {
+        DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
+    }
+    else if (m_Root)
     {
 #if DILIGENT_DEBUG
         DbgVerifyConsistency();
@@ -181,8 +194,38 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 
 
+Uint32 DynamicAtlasManager::GetFreeRegionCount() const
+{
+    switch (m_Strategy)
+    {
+        case PACKING_STRATEGY::SKYLINE:
+        {
+            Uint32 Count = static_cast<Uint32>(m_FreeRects.size());
+            for (const auto& Seg : m_Skyline)
+            {
+                if (Seg.y < m_Height)
+                    ++Count;
+            }
+            return Count;
+        }
+
+        case PACKING_STRATEGY::MAX_RECTS:
+            return static_cast<Uint32>(m_FreeRects.size());
+
+        default:
+            VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
+            return static_cast<Uint32>(m_FreeRegionsByWidth.size());
+    }
+}
+
+
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
 {
+    if (m_Strategy == PACKING_STRATEGY::SKYLINE)
+        return AllocateSkyline(Width, Height);
+    else if (m_Strategy == PACKING_STRATEGY::MAX_RECTS)
+        return AllocateMaxRects(Width, Height);
+
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
         ++it_w;
@@ -336,6 +379,25 @@ void DynamicAtlasManager::Free(Region&& R)
         return;
     }
 
+    if (m_Strategy != PACKING_STRATEGY::TREE)
+    {
+        VERIFY_EXPR(node_it->second == nullptr);
+        m_AllocatedRegions.erase(node_it);
+        if (m_AllocatedRegions.empty())
+        {
+            // Start over with the empty atlas
+            ResetPacker();
+        }
+        else
+        {
+            AddFreeRect(R);
+            if (m_Strategy == PACKING_STRATEGY::MAX_RECTS)
+                PruneFreeRects();
+        }
+        R = InvalidRegion;
+        return;
+    }
+
     VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
     auto* N = node_it->second;
     VERIFY_EXPR(N->IsAllocated && !N->HasChildren());
@@ -364,6 +426,268 @@ void DynamicAtlasManager::Free(Region&& R)
 }
 
 
+void DynamicAtlasManager::ResetPacker()
+{
+    VERIFY_EXPR(m_Strategy != PACKING_STRATEGY::TREE);
+    m_Skyline.clear();
+    m_FreeRects.clear();
+    if (m_Strategy == PACKING_STRATEGY::SKYLINE)
+        m_Skyline.push_back({0, 0, m_Width});
+    else
+        m_FreeRects.emplace_back(0, 0, m_Width, m_Height);
+}
+
+
+void DynamicAtlasManager::AddFreeRect(Region R)
+{
+    // Merge the rectangle with free rectangles that share an entire edge with it
+    for (bool Merged = true; Merged;)
+    {
+        Merged = false;
+        for (size_t i = 0; i < m_FreeRects.size(); ++i)
+        {
+            const auto& F = m_FreeRects[i];
+            if (F.x == R.x && F.width == R.width && (F.y + F.height == R.y || R.y + R.height == F.y))
+            {
+                R.y = std::min(R.y, F.y);
+                R.height += F.height;
+                Merged = true;
+            }
+            else if (F.y == R.y && F.height == R.height && (F.x + F.width == R.x || R.x + R.width == F.x))
+            {
+                R.x = std::min(R.x, F.x);
+                R.width += F.width;
+                Merged = true;
+            }
+
+            if (Merged)
+            {
+                m_FreeRects[i] = m_FreeRects.back();
+                m_FreeRects.pop_back();
+                break;
+            }
+        }
+    }
+    m_FreeRects.push_back(R);
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateFromFreeRects(Uint32 Width, Uint32 Height)
+{
+    // Best short side fit: use the free rectangle that leaves the shortest side
+    size_t BestIdx       = m_FreeRects.size();
+    Uint32 BestShortSide = UINT_MAX;
+    Uint32 BestLongSide  = UINT_MAX;
+    for (size_t i = 0; i < m_FreeRects.size(); ++i)
+    {
+        const auto& F = m_FreeRects[i];
+        if (F.width < Width || F.height < Height)
+            continue;
+
+        const auto LeftoverX = F.width - Width;
+        const auto LeftoverY = F.height - Height;
+        const auto ShortSide = std::min(LeftoverX, LeftoverY);
+        const auto LongSide  = std::max(LeftoverX, LeftoverY);
+        if (ShortSide < BestShortSide || (ShortSide == BestShortSide && LongSide < BestLongSide))
+        {
+            BestIdx       = i;
+            BestShortSide = ShortSide;
+            BestLongSide  = LongSide;
+        }
+    }
+
+    if (BestIdx == m_FreeRects.size())
+        return Region{};
+
+    return Region{m_FreeRects[BestIdx].x, m_FreeRects[BestIdx].y, Width, Height};
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateSkyline(Uint32 Width, Uint32 Height)
+{
+    if (Width == 0 || Height == 0 || Width > m_Width || Height > m_Height)
+        return Region{};
+
+    // Reuse the space below the skyline first
+    auto R = AllocateFromFreeRects(Width, Height);
+    if (!R.IsEmpty())
+    {
+        // Free rectangles are disjoint, so only the source rectangle must be split
+        for (size_t i = 0; i < m_FreeRects.size(); ++i)
+        {
+            const auto F = m_FreeRects[i];
+            if (F.x != R.x || F.y != R.y)
+                continue;
+
+            m_FreeRects[i] = m_FreeRects.back();
+            m_FreeRects.pop_back();
+
+            // Split along the shorter leftover axis to keep the larger remainder
+            if (F.width - Width < F.height - Height)
+            {
+                if (F.width > Width)
+                    m_FreeRects.emplace_back(F.x + Width, F.y, F.width - Width, Height);
+                if (F.height > Height)
+                    m_FreeRects.emplace_back(F.x, F.y + Height, F.width, F.height - Height);
+            }
+            else
+            {
+                if (F.width > Width)
+                    m_FreeRects.emplace_back(F.x + Width, F.y, F.width - Width, F.height);
+                if (F.height > Height)
+                    m_FreeRects.emplace_back(F.x, F.y + Height, Width, F.height - Height);
+            }
+            break;
+        }
+    }
+    else
+    {
+        // Bottom-left rule: find the position where the top of the region is the lowest
+        size_t BestSeg = m_Skyline.size();
+        Uint32 BestY   = 0;
+        Uint32 BestTop = UINT_MAX;
+        for (size_t i = 0; i < m_Skyline.size() && m_Skyline[i].x + Width <= m_Width; ++i)
+        {
+            Uint32 y         = 0;
+            Uint32 WidthLeft = Width;
+            for (size_t j = i; WidthLeft > 0; ++j)
+            {
+                VERIFY_EXPR(j < m_Skyline.size());
+                y = std::max(y, m_Skyline[j].y);
+                WidthLeft -= std::min(WidthLeft, m_Skyline[j].width);
+            }
+
+            if (y + Height <= m_Height && y + Height < BestTop)
+            {
+                BestSeg = i;
+                BestY   = y;
+                BestTop = y + Height;
+            }
+        }
+
+        if (BestSeg == m_Skyline.size())
+            return Region{};
+
+        R = Region{m_Skyline[BestSeg].x, BestY, Width, Height};
+
+        // Space between the covered segments and the bottom of the region is not reachable
+        // by the skyline anymore, so it is moved to the free rectangles
+        size_t End = BestSeg;
+        for (; End < m_Skyline.size() && m_Skyline[End].x < R.x + Width; ++End)
+        {
+            const auto& Seg = m_Skyline[End];
+            if (Seg.y < BestY)
+            {
+                const auto Right = std::min(Seg.x + Seg.width, R.x + Width);
+                AddFreeRect(Region{Seg.x, Seg.y, Right - Seg.x, BestY - Seg.y});
+            }
+        }
+
+        // Replace the covered segments with the new one, trimming the last one if it is covered partially
+        auto& Last = m_Skyline[End - 1];
+        if (Last.x + Last.width > R.x + Width)
+        {
+            Last.width = Last.x + Last.width - (R.x + Width);
+            Last.x     = R.x + Width;
+            --End;
+        }
+        m_Skyline.erase(m_Skyline.begin() + BestSeg, m_Skyline.begin() + End);
+        m_Skyline.insert(m_Skyline.begin() + BestSeg, SkylineSegment{R.x, BestTop, Width});
+
+        // Merge with the neighbors at the same height
+        if (BestSeg + 1 < m_Skyline.size() && m_Skyline[BestSeg + 1].y == BestTop)
+        {
+            m_Skyline[BestSeg].width += m_Skyline[BestSeg + 1].width;
+            m_Skyline.erase(m_Skyline.begin() + BestSeg + 1);
+        }
+        if (BestSeg > 0 && m_Skyline[BestSeg - 1].y == BestTop)
+        {
+            m_Skyline[BestSeg - 1].width += m_Skyline[BestSeg].width;
+            m_Skyline.erase(m_Skyline.begin() + BestSeg);
+        }
+    }
+
+#if DILIGENT_DEBUG
+    DbgVerifyRegion(R);
+#endif
+    VERIFY(m_AllocatedRegions.find(R) == m_AllocatedRegions.end(), "New region should not be present in allocated regions hash map");
+    m_AllocatedRegions.emplace(R, nullptr);
+
+    return R;
+}
+
+
+void DynamicAtlasManager::SplitFreeRects(const Region& R)
+{
+    const size_t NumRects = m_FreeRects.size();
+    for (size_t i = 0; i < NumRects; ++i)
+    {
+        const auto F = m_FreeRects[i];
+        if (R.x >= F.x + F.width || R.x + R.width <= F.x || R.y >= F.y + F.height || R.y + R.height <= F.y)
+            continue;
+
+        // Mark the rectangle for removal and add up to four maximal parts that do not intersect the region
+        m_FreeRects[i].width = 0;
+        if (R.x > F.x)
+            m_FreeRects.emplace_back(F.x, F.y, R.x - F.x, F.height);
+        if (R.x + R.width < F.x + F.width)
+            m_FreeRects.emplace_back(R.x + R.width, F.y, F.x + F.width - (R.x + R.width), F.height);
+        if (R.y > F.y)
+            m_FreeRects.emplace_back(F.x, F.y, F.width, R.y - F.y);
+        if (R.y + R.height < F.y + F.height)
+            m_FreeRects.emplace_back(F.x, R.y + R.height, F.width, F.y + F.height - (R.y + R.height));
+    }
+    m_FreeRects.erase(std::remove_if(m_FreeRects.begin(), m_FreeRects.end(), [](const Region& F) { return F.IsEmpty(); }), m_FreeRects.end());
+}
+
+
+void DynamicAtlasManager::PruneFreeRects()
+{
+    // Remove free rectangles that are contained in other free rectangles
+    for (size_t i = 0; i < m_FreeRects.size(); ++i)
+    {
+        for (size_t j = i + 1; j < m_FreeRects.size(); ++j)
+        {
+            const auto& Ri = m_FreeRects[i];
+            const auto& Rj = m_FreeRects[j];
+            if (Ri.x >= Rj.x && Ri.y >= Rj.y && Ri.x + Ri.width <= Rj.x + Rj.width && Ri.y + Ri.height <= Rj.y + Rj.height)
+            {
+                m_FreeRects.erase(m_FreeRects.begin() + i);
+                --i;
+                break;
+            }
+            if (Rj.x >= Ri.x && Rj.y >= Ri.y && Rj.x + Rj.width <= Ri.x + Ri.width && Rj.y + Rj.height <= Ri.y + Ri.height)
+            {
+                m_FreeRects.erase(m_FreeRects.begin() + j);
+                --j;
+            }
+        }
+    }
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateMaxRects(Uint32 Width, Uint32 Height)
+{
+    if (Width == 0 || Height == 0)
+        return Region{};
+
+    auto R = AllocateFromFreeRects(Width, Height);
+    if (R.IsEmpty())
+        return R;
+
+    SplitFreeRects(R);
+    PruneFreeRects();
+
+#if DILIGENT_DEBUG
+    DbgVerifyRegion(R);
+#endif
+    VERIFY(m_AllocatedRegions.find(R) == m_AllocatedRegions.end(), "New region should not be present in allocated regions hash map");
+    m_AllocatedRegions.emplace(R, nullptr);
+
+    return R;
+}
+
+
 #if DILIGENT_DEBUG
 
 void DynamicAtlasManager::DbgVerifyRegion(const Region& R) const
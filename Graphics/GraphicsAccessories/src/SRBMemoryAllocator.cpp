@@ -72,4 +72,21 @@ void SRBMemoryAllocator::Initialize(Uint32              SRBAllocationGranularity
     }
 }
 
+void SRBMemoryAllocator::GetStatistics(ObjectPoolStatistics& Stats)
+{
+    const auto TotalAllocatorCount = m_DataAllocators != nullptr ? m_ShaderVariableDataAllocatorCount + m_ResourceCacheDataAllocatorCount : 0;
+    for (Uint32 s = 0; s < TotalAllocatorCount; ++s)
+    {
+        Uint32 NumAllocatedBlocks = 0;
+        Uint32 NumReservedBlocks  = 0;
+        m_DataAllocators[s].GetStatistics(NumAllocatedBlocks, NumReservedBlocks);
+
+        const auto BlockSize = m_DataAllocators[s].GetBlockSize();
+        Stats.NumAllocatedBlocks += NumAllocatedBlocks;
+        Stats.NumReservedBlocks += NumReservedBlocks;
+        Stats.AllocatedSize += Uint64{NumAllocatedBlocks} * BlockSize;
+        Stats.ReservedSize += Uint64{NumReservedBlocks} * BlockSize;
+    }
+}
+
 } // namespace Diligent
@@ -101,6 +101,10 @@ public:
                       "No bits in the immediate context mask (0x", std::hex, this->m_Desc.ImmediateContextMask,
                       ") correspond to one of ", pDevice->GetCommandQueueCount(), " available software command queues");
         this->m_Desc.ImmediateContextMask &= DeviceQueuesMask;
+
+        // Memory of sparse buffers is bound to memory objects that are not tracked by the buffer
+        if ((this->m_Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) == 0)
+            this->SetLiveObjectSize(this->m_Desc.uiSizeInBytes);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Buffer, TDeviceObjectBase)
@@ -215,6 +219,22 @@ public:
         DvpVerifyInvalidateMappedRangeArguments(StartOffset, Size);
     }
 
+    /// Implementation of IBuffer::GetSparseBlockSize().
+    virtual Uint32 DILIGENT_CALL_TYPE GetSparseBlockSize() const override final
+    {
+        DEV_CHECK_ERR((this->m_Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) != 0,
+                      "Buffer '", this->m_Desc.Name, "' is not a sparse buffer.");
+        return m_SparseBlockSize;
+    }
+
+    /// Implementation of IBuffer::GetDeviceAddress().
+    virtual Uint64 DILIGENT_CALL_TYPE GetDeviceAddress() const override final
+    {
+        DEV_CHECK_ERR((this->m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS) != 0,
+                      "Buffer '", this->m_Desc.Name, "' was not created with MISC_BUFFER_FLAG_DEVICE_ADDRESS flag.");
+        return m_DeviceAddress;
+    }
+
 
     bool IsInKnownState() const
     {
@@ -261,6 +281,13 @@ protected:
 
     MEMORY_PROPERTIES m_MemoryProperties = MEMORY_PROPERTY_UNKNOWN;
 
+    /// Block size of a sparse buffer, set by the engine-specific implementation
+    Uint32 m_SparseBlockSize = 0;
+
+    /// GPU virtual address of a buffer created with MISC_BUFFER_FLAG_DEVICE_ADDRESS flag,
+    /// set by the engine-specific implementation
+    Uint64 m_DeviceAddress = 0;
+
     /// Default UAV addressing the entire buffer
     std::unique_ptr<BufferViewImplType, STDDeleter<BufferViewImplType, TBuffViewObjAllocator>> m_pDefaultUAV;
 
@@ -97,6 +97,12 @@ public:
         return ValidatedCast<BufferType>(m_pBuffer);
     }
 
+    /// Implementation of IBufferView::GetBindlessIndex()
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessIndex() const override final
+    {
+        return m_BindlessIndex;
+    }
+
 protected:
     /// Pointer to the buffer
     IBuffer* const m_pBuffer;
@@ -104,6 +110,9 @@ protected:
     /// Strong reference to the buffer. Used for non-default views
     /// to keep the buffer alive
     RefCntAutoPtr<IBuffer> m_spBuffer;
+
+    /// Index of the view in the bindless descriptor heap, set by the backend
+    Uint32 m_BindlessIndex = INVALID_BINDLESS_INDEX;
 };
 
 } // namespace Diligent
@@ -38,4 +38,50 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 void CreateDefaultShaderSourceStreamFactory(const Char*                       SearchDirectories,
                                             IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory);
 
+
+/// Default shader source stream factory statistics
+
+/// The factory caches the contents of the files it reads. A cached file is served
+/// without reading it again while its modification time and size do not change.
+/// Cached files and the #include directives in them form the include graph.
+struct ShaderSourceStreamFactoryStats
+{
+    /// The number of input streams requested from the factory.
+    Uint32 NumRequests          DEFAULT_INITIALIZER(0);
+
+    /// The number of requests served from the file cache.
+    Uint32 NumCacheHits         DEFAULT_INITIALIZER(0);
+
+    /// The number of cached files that were found modified or deleted.
+    Uint32 NumInvalidations     DEFAULT_INITIALIZER(0);
+
+    /// The number of files read from the file system, including prefetched include files.
+    Uint32 NumFilesRead         DEFAULT_INITIALIZER(0);
+
+    /// Total size of the files read from the file system, in bytes.
+    Uint64 BytesRead            DEFAULT_INITIALIZER(0);
+
+    /// Total size of the data served from the file cache, in bytes.
+    Uint64 BytesServedFromCache DEFAULT_INITIALIZER(0);
+
+    /// The number of files in the cache, i.e. the number of nodes in the include graph.
+    Uint32 NumCachedFiles       DEFAULT_INITIALIZER(0);
+
+    /// The number of #include directives in the cached files, i.e. the number of edges in the include graph.
+    Uint32 NumIncludeDirectives DEFAULT_INITIALIZER(0);
+
+    /// Total size of the cached file data, in bytes.
+    Uint64 CachedDataSize       DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderSourceStreamFactoryStats ShaderSourceStreamFactoryStats;
+
+/// Returns the statistics of the shader source stream factory.
+
+/// \param [in]  pFactory - Shader source stream factory created by CreateDefaultShaderSourceStreamFactory().
+/// \param [out] pStats   - Memory location where the statistics will be written.
+/// \return      true if the statistics were written, and false if the factory was not created by
+///              CreateDefaultShaderSourceStreamFactory().
+bool GetDefaultShaderSourceStreamFactoryStats(IShaderSourceInputStreamFactory* pFactory,
+                                              ShaderSourceStreamFactoryStats*  pStats);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
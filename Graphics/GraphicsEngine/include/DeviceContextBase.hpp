@@ -47,16 +47,25 @@
 #include "IndexWrapper.hpp"
 #include "BasicMath.hpp"
 #include "PlatformMisc.hpp"
+#include "ArenaAllocator.hpp"
+#include "EngineMemory.h"
+#include "FrameObjectReferences.hpp"
 
 namespace Diligent
 {
 
+static constexpr Uint32 DrawIndirectCommandStride        = sizeof(Uint32) * 4; // NumVertices, NumInstances, StartVertexLocation, FirstInstanceLocation
+static constexpr Uint32 DrawIndexedIndirectCommandStride = sizeof(Uint32) * 5; // NumIndices, NumInstances, FirstIndexLocation, BaseVertex, FirstInstanceLocation
+
 // clang-format off
 bool VerifyDrawAttribs               (const DrawAttribs&                Attribs);
 bool VerifyDrawIndexedAttribs        (const DrawIndexedAttribs&         Attribs);
 bool VerifyDrawIndirectAttribs       (const DrawIndirectAttribs&        Attribs, const IBuffer* pAttribsBuffer);
 bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 
+bool VerifyDrawIndirectCountAttribs       (const DrawIndirectCountAttribs&        Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff);
+bool VerifyDrawIndexedIndirectCountAttribs(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff);
+
 bool VerifyDispatchComputeAttribs        (const DispatchComputeAttribs&         Attribs);
 bool VerifyDispatchComputeIndirectAttribs(const DispatchComputeIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer);
 // clang-format on
@@ -72,6 +81,8 @@ bool VerifyResolveTextureSubresourceAttribs(const ResolveTextureSubresourceAttri
                                             const TextureDesc&                      SrcTexDesc,
                                             const TextureDesc&                      DstTexDesc);
 
+bool VerifyUpdateTileMappingsAttribs(const UpdateTileMappingsAttribs& Attribs);
+
 bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs);
 
 // Verifies state transition (resource barrier) description.
@@ -84,6 +95,11 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
 
 bool VerifyBuildBLASAttribs(const BuildBLASAttribs& Attribs);
 bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs);
+bool VerifyBuildBLASBatchAttribs(const IRenderDevice* pDevice, const BuildBLASBatchAttribs& Attribs);
+
+// Returns the size of the shared scratch buffer region used by the build in IDeviceContext::BuildBLASBatch().
+// Regions of consecutive builds are placed back to back starting at BuildBLASBatchAttribs::ScratchBufferOffset.
+Uint64 GetBLASBatchScratchRegionSize(const BuildBLASAttribs& Build, Uint32 ScratchBufferAlignment);
 bool VerifyCopyBLASAttribs(const IRenderDevice* pDevice, const CopyBLASAttribs& Attribs);
 bool VerifyCopyTLASAttribs(const CopyTLASAttribs& Attribs);
 bool VerifyWriteBLASCompactedSizeAttribs(const IRenderDevice* pDevice, const WriteBLASCompactedSizeAttribs& Attribs);
@@ -102,8 +118,9 @@ struct VertexStreamInfo
 {
     VertexStreamInfo() {}
 
-    /// Strong reference to the buffer object
-    RefCntAutoPtr<BufferImplType> pBuffer;
+    /// Raw pointer to the buffer object. The device context keeps the buffer
+    /// alive through per-frame references (see DeviceContextBase::m_BoundObjects).
+    BufferImplType* pBuffer = nullptr;
 
     /// Offset in bytes
     Uint32 Offset = 0;
@@ -114,7 +131,8 @@ struct VertexStreamInfo
 /// \tparam EngineImplTraits     - Engine implementation traits that define specific implementation details
 ///                                 (texture implementation type, buffer implementation type, etc.)
 /// \remarks Device context keeps strong references to all objects currently bound to
-///          the pipeline: buffers, tetxures, states, SRBs, etc.
+///          the pipeline: buffers, tetxures, states, SRBs, etc. Vertex and index buffers
+///          are referenced once per frame rather than by every binding slot.
 ///          The context also keeps strong references to the device and
 ///          the swap chain.
 template <typename EngineImplTraits>
@@ -242,6 +260,12 @@ public:
                                                   RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
                                                   RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override = 0;
 
+    /// Base implementation of IDeviceContext::UpdateTextureRegions(); validates input parameters
+    virtual void DILIGENT_CALL_TYPE UpdateTextureRegions(ITexture*                      pTexture,
+                                                         const TextureRegionUpdate*     pUpdates,
+                                                         Uint32                         NumUpdates,
+                                                         RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override = 0;
+
     /// Base implementation of IDeviceContext::CopyTexture(); validates input parameters
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override = 0;
 
@@ -261,6 +285,8 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override = 0;
 
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews) override = 0;
+
     virtual void DILIGENT_CALL_TYPE ResolveTextureSubresource(ITexture*                               pSrcTexture,
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override = 0;
@@ -270,6 +296,18 @@ public:
         return m_FrameNumber;
     }
 
+    /// Implementation of IDeviceContext::GetStats().
+    virtual const DeviceContextStats& DILIGENT_CALL_TYPE GetStats() const override final
+    {
+        return m_LastFrameStats;
+    }
+
+    /// Implementation of IDeviceContext::GetFrameAllocator().
+    virtual IMemoryAllocator* DILIGENT_CALL_TYPE GetFrameAllocator() override final
+    {
+        return &m_FrameAllocator;
+    }
+
     /// Implementation of IDeviceContext::SetUserData.
     virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override final
     {
@@ -282,12 +320,24 @@ public:
         return m_pUserData.RawPtr<IObject>();
     }
 
+    /// Base implementation of IDeviceContext::SetInlineConstants.
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants) override
+    {
+        UNSUPPORTED("Inline constants are not supported by this device.");
+    }
+
     /// Base implementation of IDeviceContext::DispatchTile.
     virtual void DILIGENT_CALL_TYPE DispatchTile(const DispatchTileAttribs& Attribs) override
     {
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Base implementation of IDeviceContext::UpdateTileMappings.
+    virtual void DILIGENT_CALL_TYPE UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs) override
+    {
+        UNSUPPORTED("Sparse resources are not supported by this device. Please check DeviceFeatures.SparseResources feature.");
+    }
+
     /// Base implementation of IDeviceContext::GetTileSize.
     virtual void DILIGENT_CALL_TYPE GetTileSize(Uint32& TileSizeX, Uint32& TileSizeY) override
     {
@@ -310,6 +360,9 @@ public:
 
     bool IsDeferred() const { return m_Desc.IsDeferred; }
 
+    // Returns true if the deferred context is recording a command list with COMMAND_LIST_FLAG_REUSABLE flag.
+    bool IsRecordingReusableCommandList() const { return (m_CommandListFlags & COMMAND_LIST_FLAG_REUSABLE) != 0; }
+
     /// Checks if a texture is bound as a render target or depth-stencil buffer and
     /// resets render targets if it is.
     bool UnbindTextureFromFramebuffer(TextureImplType* pTexture, bool bShowMessage);
@@ -444,6 +497,9 @@ protected:
 
     inline bool SetStencilRef(Uint32 StencilRef, int Dummy);
 
+    /// Validates dynamic state attributes. Returns true if there are states to set.
+    inline bool SetDynamicStates(const DynamicStateAttribs& Attribs, int Dummy);
+
     inline void SetPipelineState(PipelineStateImplType* pPipelineState, int /*Dummy*/);
 
     /// Clears all cached resources
@@ -466,12 +522,73 @@ protected:
 
     void EndQuery(IQuery* pQuery, int);
 
+    void BeginConditionalRendering(IQuery* pQuery, int);
+
+    void EndConditionalRendering(int);
+
+    bool IsConditionalRenderingActive() const { return m_pConditionalRenderingQuery != nullptr; }
+
     void EnqueueSignal(IFence* pFence, Uint64 Value, int);
     void DeviceWaitForFence(IFence* pFence, Uint64 Value, int);
 
     void EndFrame()
     {
+        DEV_CHECK_ERR(m_pConditionalRenderingQuery == nullptr, "All conditional rendering blocks must be ended when FinishFrame() is called");
+        ResetBoundObjectReferences();
         ++m_FrameNumber;
+        if (!IsDeferred() && GetContextId() == 0)
+            m_pDevice->GetLiveObjectRegistry().SetFrameNumber(m_FrameNumber);
+        m_FrameAllocator.Reset();
+#ifdef DILIGENT_CONTEXT_STATS
+        m_LastFrameStats = m_Stats;
+        m_Stats          = {};
+#endif
+    }
+
+    /// Keeps a strong reference to the object until the end of the frame, unless one is already held.
+    /// Binding slots that hold raw pointers (vertex and index buffers) must call this method.
+    void KeepBoundObjectAlive(IObject* pObject)
+    {
+        if (m_BoundObjects.Add(pObject) && m_BoundObjects.GetSize() > MaxBoundObjectReferences)
+        {
+            // The context may never finish the frame (e.g. immediate context without a swap chain)
+            ResetBoundObjectReferences();
+        }
+    }
+
+    /// Releases references to the objects that are not bound any more.
+    /// Objects that are still bound to the context are referenced again.
+    void ResetBoundObjectReferences()
+    {
+        std::swap(m_BoundObjects, m_StaleBoundObjects);
+        VERIFY_EXPR(m_BoundObjects.GetSize() == 0);
+        for (Uint32 stream = 0; stream < m_NumVertexStreams; ++stream)
+            m_BoundObjects.Add(m_VertexStreams[stream].pBuffer);
+        m_BoundObjects.Add(m_pIndexBuffer);
+        // Release the objects after the bound ones have been referenced again
+        m_StaleBoundObjects.Reset();
+    }
+
+    // Statistics hooks are compiled out entirely when DILIGENT_CONTEXT_STATS is not defined.
+    void CountDrawCommand()
+    {
+#ifdef DILIGENT_CONTEXT_STATS
+        ++m_Stats.DrawCommands;
+#endif
+    }
+
+    void CountDispatchCommand()
+    {
+#ifdef DILIGENT_CONTEXT_STATS
+        ++m_Stats.DispatchCommands;
+#endif
+    }
+
+    void CountStateTransitions(Uint32 BarrierCount)
+    {
+#ifdef DILIGENT_CONTEXT_STATS
+        m_Stats.StateTransitions += BarrierCount;
+#endif
     }
 
     void PrepareCommittedResources(CommittedShaderResources& Resources, Uint32& DvpCompatibleSRBCount);
@@ -482,12 +599,13 @@ protected:
         return m_DstImmediateContextId != INVALID_CONTEXT_ID;
     }
 
-    void Begin(DeviceContextIndex ImmediateContextId, COMMAND_QUEUE_TYPE QueueType)
+    void Begin(DeviceContextIndex ImmediateContextId, COMMAND_QUEUE_TYPE QueueType, COMMAND_LIST_FLAGS Flags = COMMAND_LIST_FLAG_NONE)
     {
         DEV_CHECK_ERR(IsDeferred(), "Begin() is only allowed for deferred contexts.");
         DEV_CHECK_ERR(!IsRecordingDeferredCommands(), "This context is already recording commands. Call FinishCommandList() before beginning new recording.");
         m_DstImmediateContextId = static_cast<Uint8>(ImmediateContextId);
         VERIFY_EXPR(m_DstImmediateContextId == ImmediateContextId);
+        m_CommandListFlags = Flags;
 
         // Set command queue type while commands are being recorded
         m_Desc.QueueType = QueueType;
@@ -500,6 +618,7 @@ protected:
         DEV_CHECK_ERR(IsDeferred(), "FinishCommandList() is only allowed for deferred contexts.");
         DEV_CHECK_ERR(IsRecordingDeferredCommands(), "This context is not recording commands. Call Begin() before finishing the recording.");
         m_DstImmediateContextId = INVALID_CONTEXT_ID;
+        m_CommandListFlags      = COMMAND_LIST_FLAG_NONE;
         m_Desc.QueueType        = COMMAND_QUEUE_TYPE_UNKNOWN;
         for (size_t i = 0; i < _countof(m_Desc.TextureCopyGranularity); ++i)
             m_Desc.TextureCopyGranularity[i] = 0;
@@ -512,6 +631,8 @@ protected:
     void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs) const;
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs, const IBuffer* pAttribsBuffer) const;
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs, const IBuffer* pAttribsBuffer) const;
+    void DvpVerifyDrawIndirectCountArguments    (const DrawIndirectCountAttribs&     Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const;
+    void DvpVerifyDrawIndexedIndirectCountArguments(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const;
     void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs, const IBuffer* pAttribsBuffer) const;
     void DvpVerifyDrawMeshIndirectCountArguments(const DrawMeshIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const;
 
@@ -539,6 +660,8 @@ protected:
     void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs)const {}
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs, const IBuffer* pAttribsBuffer)const {}
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs, const IBuffer* pAttribsBuffer)const {}
+    void DvpVerifyDrawIndirectCountArguments    (const DrawIndirectCountAttribs&     Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const {}
+    void DvpVerifyDrawIndexedIndirectCountArguments(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const {}
     void DvpVerifyDrawMeshIndirectArguments     (const DrawMeshIndirectAttribs&      Attribs, const IBuffer* pAttribsBuffer)const {}
     void DvpVerifyDrawMeshIndirectCountArguments(const DrawMeshIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff) const {}
 
@@ -558,6 +681,7 @@ protected:
 
     void BuildBLAS(const BuildBLASAttribs& Attribs, int) const;
     void BuildTLAS(const BuildTLASAttribs& Attribs, int) const;
+    void BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int) const;
     void CopyBLAS(const CopyBLASAttribs& Attribs, int) const;
     void CopyTLAS(const CopyTLASAttribs& Attribs, int) const;
     void WriteBLASCompactedSize(const WriteBLASCompactedSizeAttribs& Attribs, int) const;
@@ -566,6 +690,8 @@ protected:
     void TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs, IBuffer* pAttribsBuffer, int) const;
     void UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs, int) const;
 
+    void UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs, int) const;
+
     void BeginDebugGroup(const Char* Name, const float* pColor, int);
     void EndDebugGroup(int);
     void InsertDebugLabel(const Char* Label, const float* pColor, int) const;
@@ -580,7 +706,7 @@ protected:
     /// Strong reference to the device.
     RefCntAutoPtr<DeviceImplType> m_pDevice;
 
-    /// Vertex streams. Every stream holds strong reference to the buffer
+    /// Vertex streams. Buffers are kept alive by m_BoundObjects.
     VertexStreamInfo<BufferImplType> m_VertexStreams[MAX_BUFFER_SLOTS];
 
     /// Number of bound vertex streams
@@ -592,13 +718,21 @@ protected:
     /// SetPipelineState()
     RefCntAutoPtr<PipelineStateImplType> m_pPipelineState;
 
-    /// Strong reference to the bound index buffer.
-    /// Use final buffer implementation type to avoid virtual calls to AddRef()/Release()
-    RefCntAutoPtr<BufferImplType> m_pIndexBuffer;
+    /// Bound index buffer. The buffer is kept alive by m_BoundObjects.
+    BufferImplType* m_pIndexBuffer = nullptr;
 
     /// Offset from the beginning of the index buffer to the start of the index data, in bytes.
     Uint32 m_IndexDataStartOffset = 0;
 
+    /// One strong reference per frame to every vertex and index buffer bound to the context.
+    /// Rebinding a buffer within the frame does not touch its reference counter.
+    FrameObjectReferences m_BoundObjects;
+    /// References of the previous period; only used by ResetBoundObjectReferences() to reuse memory.
+    FrameObjectReferences m_StaleBoundObjects;
+
+    /// The maximum number of references before the objects that are not bound any more are released
+    static constexpr size_t MaxBoundObjectReferences = 1024;
+
     /// Current stencil reference value
     Uint32 m_StencilRef = 0;
 
@@ -642,11 +776,24 @@ protected:
     /// Current subpass index.
     Uint32 m_SubpassIndex = 0;
 
+    /// Strong reference to the query that predicates the active conditional rendering block.
+    RefCntAutoPtr<QueryImplType> m_pConditionalRenderingQuery;
+
     /// Render pass attachments transition mode.
     RESOURCE_STATE_TRANSITION_MODE m_RenderPassAttachmentsTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
 
     Uint64 m_FrameNumber = 0;
 
+    /// Linear arena for temporary data that is reset by EndFrame().
+    ArenaAllocator m_FrameAllocator{GetRawAllocator()};
+
+    /// Statistics of the last finished frame.
+    DeviceContextStats m_LastFrameStats;
+#ifdef DILIGENT_CONTEXT_STATS
+    /// Statistics of the frame being recorded.
+    DeviceContextStats m_Stats;
+#endif
+
     RefCntAutoPtr<IObject> m_pUserData;
 
     // Must go before m_Desc!
@@ -659,6 +806,9 @@ protected:
     // will be submitted.
     DeviceContextIndex m_DstImmediateContextId{INVALID_CONTEXT_ID};
 
+    // Flags of the command list that is being recorded by the deferred context
+    COMMAND_LIST_FLAGS m_CommandListFlags = COMMAND_LIST_FLAG_NONE;
+
 #ifdef DILIGENT_DEBUG
     // std::unordered_map is unbelievably slow. Keeping track of mapped buffers
     // in release builds is not feasible
@@ -709,8 +859,6 @@ inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
     if (Flags & SET_VERTEX_BUFFERS_FLAG_RESET)
     {
         // Reset only these buffer slots that are not being set.
-        // It is very important to not reset buffers that stay unchanged
-        // as AddRef()/Release() are not free
         for (Uint32 s = 0; s < StartSlot; ++s)
             m_VertexStreams[s] = VertexStreamInfo<BufferImplType>{};
         for (Uint32 s = StartSlot + NumBuffersSet; s < m_NumVertexStreams; ++s)
@@ -724,6 +872,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetVertexBuffers(
         auto& CurrStream   = m_VertexStreams[StartSlot + Buff];
         CurrStream.pBuffer = ppBuffers ? ValidatedCast<BufferImplType>(ppBuffers[Buff]) : nullptr;
         CurrStream.Offset  = pOffsets ? pOffsets[Buff] : 0;
+        KeepBoundObjectAlive(CurrStream.pBuffer);
 #ifdef DILIGENT_DEVELOPMENT
         if (CurrStream.pBuffer)
         {
@@ -745,9 +894,14 @@ inline void DeviceContextBase<ImplementationTraits>::SetPipelineState(
     int /*Dummy*/)
 {
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "SetPipelineState");
+    DEV_CHECK_ERR(pPipelineState->GetStatus() == PIPELINE_STATE_STATUS_READY,
+                  "PSO '", pPipelineState->GetDesc().Name, "' is not ready. Asynchronously created pipelines must not be bound before IPipelineState::GetStatus() returns PIPELINE_STATE_STATUS_READY.");
     DEV_CHECK_ERR((pPipelineState->GetDesc().ImmediateContextMask & (Uint64{1} << GetExecutionCtxId())) != 0,
                   "PSO '", pPipelineState->GetDesc().Name, "' can't be used in device context '", m_Desc.Name, "'.");
 
+#ifdef DILIGENT_CONTEXT_STATS
+    ++m_Stats.PipelineStateChanges;
+#endif
     m_pPipelineState = pPipelineState;
 }
 
@@ -763,6 +917,10 @@ inline void DeviceContextBase<ImplementationTraits>::CommitShaderResources(
                   "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
 
     DEV_CHECK_ERR(pShaderResourceBinding != nullptr, "pShaderResourceBinding must not be null");
+
+#ifdef DILIGENT_CONTEXT_STATS
+    ++m_Stats.ShaderResourceCommits;
+#endif
 }
 
 template <typename ImplementationTraits>
@@ -781,6 +939,7 @@ inline void DeviceContextBase<ImplementationTraits>::SetIndexBuffer(
 {
     m_pIndexBuffer         = ValidatedCast<BufferImplType>(pIndexBuffer);
     m_IndexDataStartOffset = ByteOffset;
+    KeepBoundObjectAlive(m_pIndexBuffer);
 
 #ifdef DILIGENT_DEVELOPMENT
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetIndexBuffer");
@@ -846,6 +1005,56 @@ inline bool DeviceContextBase<ImplementationTraits>::SetStencilRef(Uint32 Stenci
     return false;
 }
 
+template <typename ImplementationTraits>
+inline bool DeviceContextBase<ImplementationTraits>::SetDynamicStates(const DynamicStateAttribs& Attribs, int)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "SetDynamicStates");
+
+    if (!m_pPipelineState || !m_pPipelineState->GetDesc().IsAnyGraphicsPipeline())
+    {
+        LOG_ERROR_MESSAGE("SetDynamicStates: no graphics pipeline is bound. Dynamic states must be set after SetPipelineState().");
+        return false;
+    }
+
+    const auto& GraphicsPipeline = m_pPipelineState->GetGraphicsPipelineDesc();
+    if ((Attribs.Flags & ~GraphicsPipeline.DynamicStates) != 0)
+    {
+        LOG_ERROR_MESSAGE("SetDynamicStates: states ", Uint32{Attribs.Flags & ~GraphicsPipeline.DynamicStates},
+                          " are not dynamic in pipeline '", m_pPipelineState->GetDesc().Name,
+                          "'. Check GraphicsPipelineDesc::DynamicStates.");
+        return false;
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    if ((Attribs.Flags & DYNAMIC_STATE_FLAG_CULL_MODE) != 0)
+        DEV_CHECK_ERR(Attribs.CullMode != CULL_MODE_UNDEFINED, "SetDynamicStates: CullMode must not be CULL_MODE_UNDEFINED.");
+
+    if ((Attribs.Flags & DYNAMIC_STATE_FLAG_DEPTH) != 0)
+        DEV_CHECK_ERR(!Attribs.DepthEnable || Attribs.DepthFunc != COMPARISON_FUNC_UNKNOWN, "SetDynamicStates: DepthFunc must not be COMPARISON_FUNC_UNKNOWN when depth is enabled.");
+
+    if ((Attribs.Flags & DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0)
+    {
+        // Patch lists are only compatible with patch lists that have the same number of control points
+        auto GetTopologyClass = [](PRIMITIVE_TOPOLOGY Topology) -> Uint32 {
+            switch (Topology)
+            {
+                case PRIMITIVE_TOPOLOGY_POINT_LIST: return 0;
+                case PRIMITIVE_TOPOLOGY_LINE_LIST:
+                case PRIMITIVE_TOPOLOGY_LINE_STRIP: return 1;
+                case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+                case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP: return 2;
+                default: return 3 + static_cast<Uint32>(Topology);
+            }
+        };
+        DEV_CHECK_ERR(GetTopologyClass(Attribs.PrimitiveTopology) == GetTopologyClass(GraphicsPipeline.PrimitiveTopology),
+                      "SetDynamicStates: primitive topology ", Uint32{Attribs.PrimitiveTopology},
+                      " is not of the same class as the pipeline topology ", Uint32{GraphicsPipeline.PrimitiveTopology}, '.');
+    }
+#endif
+
+    return Attribs.Flags != DYNAMIC_STATE_FLAG_NONE;
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::SetViewports(
     Uint32          NumViewports,
@@ -1146,7 +1355,7 @@ inline void DeviceContextBase<ImplementationTraits>::ClearStateCache()
 
     m_pPipelineState.Release();
 
-    m_pIndexBuffer.Release();
+    m_pIndexBuffer         = nullptr;
     m_IndexDataStartOffset = 0;
 
     m_StencilRef = 0;
@@ -1480,6 +1689,8 @@ inline void DeviceContextBase<ImplementationTraits>::BeginQuery(IQuery* pQuery,
 
     const auto QueueType = QueryType == QUERY_TYPE_DURATION ? COMMAND_QUEUE_TYPE_COMPUTE : COMMAND_QUEUE_TYPE_GRAPHICS;
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(QueueType, "BeginQuery for query type ", GetQueryTypeString(QueryType));
+    DEV_CHECK_ERR(m_pConditionalRenderingQuery != pQuery,
+                  "IDeviceContext::BeginQuery: query '", pQuery->GetDesc().Name, "' is being used by the active conditional rendering block");
 
     ValidatedCast<QueryImplType>(pQuery)->OnBeginQuery(static_cast<DeviceContextImplType*>(this));
 }
@@ -1498,6 +1709,35 @@ inline void DeviceContextBase<ImplementationTraits>::EndQuery(IQuery* pQuery, in
     ValidatedCast<QueryImplType>(pQuery)->OnEndQuery(static_cast<DeviceContextImplType*>(this));
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::BeginConditionalRendering(IQuery* pQuery, int)
+{
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().ConditionalRendering, "IDeviceContext::BeginConditionalRendering: conditional rendering is not supported by this device");
+    DEV_CHECK_ERR(pQuery != nullptr, "IDeviceContext::BeginConditionalRendering: pQuery must not be null");
+    DEV_CHECK_ERR(!IsDeferred(), "IDeviceContext::BeginConditionalRendering: deferred contexts do not support conditional rendering");
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "BeginConditionalRendering");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BeginConditionalRendering: conditional rendering must begin outside of a render pass");
+    DEV_CHECK_ERR(m_pConditionalRenderingQuery == nullptr, "IDeviceContext::BeginConditionalRendering: another conditional rendering block is already active. Nested blocks are not allowed.");
+
+    auto* pQueryImpl = ValidatedCast<QueryImplType>(pQuery);
+    DEV_CHECK_ERR(pQueryImpl->GetDesc().Type == QUERY_TYPE_BINARY_OCCLUSION,
+                  "IDeviceContext::BeginConditionalRendering: query '", pQueryImpl->GetDesc().Name,
+                  "' is not a binary occlusion query (", GetQueryTypeString(pQueryImpl->GetDesc().Type), ")");
+    DEV_CHECK_ERR(pQueryImpl->GetState() == QueryImplType::QueryState::Ended,
+                  "IDeviceContext::BeginConditionalRendering: query '", pQueryImpl->GetDesc().Name, "' must be ended before it is used for conditional rendering");
+
+    m_pConditionalRenderingQuery = pQueryImpl;
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::EndConditionalRendering(int)
+{
+    DEV_CHECK_ERR(m_pConditionalRenderingQuery != nullptr, "IDeviceContext::EndConditionalRendering: there is no active conditional rendering block");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::EndConditionalRendering: conditional rendering must end outside of a render pass");
+
+    m_pConditionalRenderingQuery.Release();
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::EnqueueSignal(IFence* pFence, Uint64 Value, int)
 {
@@ -1524,6 +1764,7 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateBuffer(
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_TRANSFER, "UpdateBuffer");
     DEV_CHECK_ERR(pBuffer != nullptr, "Buffer must not be null");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "UpdateBuffer command must be used outside of render pass.");
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(), "UpdateBuffer command can't be recorded into a reusable command list.");
 #ifdef DILIGENT_DEVELOPMENT
     {
         const auto& BuffDesc = ValidatedCast<BufferImplType>(pBuffer)->GetDesc();
@@ -1566,6 +1807,7 @@ inline void DeviceContextBase<ImplementationTraits>::MapBuffer(
     PVoid&    pMappedData)
 {
     DEV_CHECK_ERR(pBuffer, "pBuffer must not be null");
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(), "Buffers can't be mapped while recording a reusable command list.");
 
     const auto& BuffDesc = pBuffer->GetDesc();
 
@@ -1614,6 +1856,11 @@ inline void DeviceContextBase<ImplementationTraits>::MapBuffer(
         DEV_CHECK_ERR(BuffDesc.Usage == USAGE_DYNAMIC || BuffDesc.Usage == USAGE_STAGING, "Only dynamic and staging buffers can be mapped with discard flag");
         DEV_CHECK_ERR(MapType == MAP_WRITE, "MAP_FLAG_DISCARD is only valid when mapping buffer for writing");
     }
+
+#ifdef DILIGENT_CONTEXT_STATS
+    if (BuffDesc.Usage == USAGE_DYNAMIC && MapType == MAP_WRITE)
+        m_Stats.DynamicBytesMapped += BuffDesc.uiSizeInBytes;
+#endif
 }
 
 template <typename ImplementationTraits>
@@ -1644,10 +1891,35 @@ inline void DeviceContextBase<ImplementationTraits>::UpdateTexture(
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_TRANSFER, "UpdateTexture");
     DEV_CHECK_ERR(pTexture != nullptr, "pTexture must not be null");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "UpdateTexture command must be used outside of render pass.");
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(), "UpdateTexture command can't be recorded into a reusable command list.");
 
     ValidateUpdateTextureParams(pTexture->GetDesc(), MipLevel, Slice, DstBox, SubresData);
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::UpdateTextureRegions(
+    ITexture*                      pTexture,
+    const TextureRegionUpdate*     pUpdates,
+    Uint32                         NumUpdates,
+    RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_TRANSFER, "UpdateTextureRegions");
+    DEV_CHECK_ERR(pTexture != nullptr, "pTexture must not be null");
+    DEV_CHECK_ERR(NumUpdates == 0 || pUpdates != nullptr, "pUpdates must not be null when NumUpdates is not zero");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "UpdateTextureRegions command must be used outside of render pass.");
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(), "UpdateTextureRegions command can't be recorded into a reusable command list.");
+
+#ifdef DILIGENT_DEVELOPMENT
+    const auto& TexDesc = pTexture->GetDesc();
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        DEV_CHECK_ERR(Update.SrcData.pSrcBuffer == nullptr, "Region ", i, ": UpdateTextureRegions only supports source data in CPU memory.");
+        ValidateUpdateTextureParams(TexDesc, Update.MipLevel, Update.Slice, Update.DstBox, Update.SrcData);
+    }
+#endif
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
@@ -1670,6 +1942,7 @@ inline void DeviceContextBase<ImplementationTraits>::MapTextureSubresource(
     MappedTextureSubresource& MappedData)
 {
     DEV_CHECK_ERR(pTexture, "pTexture must not be null");
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(), "Textures can't be mapped while recording a reusable command list.");
     ValidateMapTextureParams(pTexture->GetDesc(), MipLevel, ArraySlice, MapType, MapFlags, pMapRegion);
 }
 
@@ -1701,6 +1974,14 @@ inline void DeviceContextBase<ImplementationTraits>::GenerateMips(ITextureView*
 #endif
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews)
+{
+    DEV_CHECK_ERR(NumViews == 0 || ppTexViews != nullptr, "ppTexViews must not be null when NumViews is not zero");
+    for (Uint32 i = 0; i < NumViews; ++i)
+        DeviceContextBase<ImplementationTraits>::GenerateMips(ppTexViews[i]);
+}
+
 
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::ResolveTextureSubresource(
@@ -1737,6 +2018,17 @@ void DeviceContextBase<ImplementationTraits>::BuildTLAS(const BuildTLASAttribs&
     DEV_CHECK_ERR(m_pDevice->GetFeatures().RayTracing, "IDeviceContext::BuildTLAS: ray tracing is not supported by this device");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BuildTLAS command must be performed outside of render pass");
     DEV_CHECK_ERR(VerifyBuildTLASAttribs(Attribs), "BuildTLASAttribs are invalid");
+    DEV_CHECK_ERR(!Attribs.Update || ValidatedCast<TopLevelASType>(Attribs.pTLAS)->UsesGPUInstanceData() == (Attribs.UseGPUInstanceData != False),
+                  "IDeviceContext::BuildTLAS: UseGPUInstanceData must be the same as the one used to build the TLAS when Update is true");
+}
+
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs, int) const
+{
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_COMPUTE, "BuildBLASBatch");
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().RayTracing, "IDeviceContext::BuildBLASBatch: ray tracing is not supported by this device");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::BuildBLASBatch command must be performed outside of render pass");
+    DEV_CHECK_ERR(VerifyBuildBLASBatchAttribs(m_pDevice, Attribs), "BuildBLASBatchAttribs are invalid");
 }
 
 template <typename ImplementationTraits>
@@ -1870,6 +2162,15 @@ void DeviceContextBase<ImplementationTraits>::UpdateSBT(IShaderBindingTable* pSB
     }
 }
 
+template <typename ImplementationTraits>
+void DeviceContextBase<ImplementationTraits>::UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs, int) const
+{
+    DEV_CHECK_ERR(m_pDevice->GetFeatures().SparseResources, "IDeviceContext::UpdateTileMappings: sparse resources are not supported by this device");
+    DEV_CHECK_ERR(!IsDeferred(), "IDeviceContext::UpdateTileMappings: tile mappings can only be updated in immediate contexts");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "IDeviceContext::UpdateTileMappings must be performed outside of render pass");
+    DEV_CHECK_ERR(VerifyUpdateTileMappingsAttribs(Attribs), "UpdateTileMappingsAttribs are invalid");
+}
+
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::BeginDebugGroup(const Char* Name, const float* pColor, int)
 {
@@ -1959,7 +2260,7 @@ inline void DeviceContextBase<ImplementationTraits>::PrepareCommittedResources(C
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawArguments(const DrawAttribs& Attribs) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "Draw");
@@ -1975,7 +2276,7 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawArguments(cons
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedArguments(const DrawIndexedAttribs& Attribs) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawIndexed");
@@ -1994,7 +2295,7 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedArgumen
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshArguments(const DrawMeshAttribs& Attribs) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawMesh");
@@ -2015,7 +2316,7 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndirectArgume
     const DrawIndirectAttribs& Attribs,
     const IBuffer*             pAttribsBuffer) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawIndirect");
@@ -2038,7 +2339,7 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedIndirec
     const DrawIndexedIndirectAttribs& Attribs,
     const IBuffer*                    pAttribsBuffer) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawIndexedIndirect");
@@ -2058,12 +2359,72 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedIndirec
     DEV_CHECK_ERR(VerifyDrawIndexedIndirectAttribs(Attribs, pAttribsBuffer), "DrawIndexedIndirectAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndirectCountArguments(
+    const DrawIndirectCountAttribs& Attribs,
+    const IBuffer*                  pAttribsBuffer,
+    const IBuffer*                  pCountBuff) const
+{
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawIndirectCount");
+
+    DEV_CHECK_ERR((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT) != 0,
+                  "DrawIndirectCount: count buffer is not supported by this device");
+
+    DEV_CHECK_ERR(m_pPipelineState, "DrawIndirectCount command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "DrawIndirectCount command arguments are invalid: pipeline state '",
+                  m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr ||
+                      (Attribs.IndirectAttribsBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION &&
+                       Attribs.CountBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
+                  "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
+                  "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+
+    DEV_CHECK_ERR(VerifyDrawIndirectCountAttribs(Attribs, pAttribsBuffer, pCountBuff), "DrawIndirectCountAttribs are invalid");
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedIndirectCountArguments(
+    const DrawIndexedIndirectCountAttribs& Attribs,
+    const IBuffer*                         pAttribsBuffer,
+    const IBuffer*                         pCountBuff) const
+{
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawIndexedIndirectCount");
+
+    DEV_CHECK_ERR((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT) != 0,
+                  "DrawIndexedIndirectCount: count buffer is not supported by this device");
+
+    DEV_CHECK_ERR(m_pPipelineState, "DrawIndexedIndirectCount command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "DrawIndexedIndirectCount command arguments are invalid: pipeline state '",
+                  m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(m_pIndexBuffer, "DrawIndexedIndirectCount command arguments are invalid: no index buffer is bound.");
+
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr ||
+                      (Attribs.IndirectAttribsBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION &&
+                       Attribs.CountBufferStateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION),
+                  "Resource state transitions are not allowed inside a render pass and may result in an undefined behavior. "
+                  "Do not use RESOURCE_STATE_TRANSITION_MODE_TRANSITION or end the render pass first.");
+
+    DEV_CHECK_ERR(VerifyDrawIndexedIndirectCountAttribs(Attribs, pAttribsBuffer, pCountBuff), "DrawIndexedIndirectCountAttribs are invalid");
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshIndirectArguments(
     const DrawMeshIndirectAttribs& Attribs,
     const IBuffer*                 pAttribsBuffer) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawMeshIndirect");
@@ -2085,7 +2446,7 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshIndirectCo
     const IBuffer*                      pAttribsBuffer,
     const IBuffer*                      pCountBuff) const
 {
-    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW) || (Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
         return;
 
     DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "DrawMeshIndirectCount");
@@ -2105,6 +2466,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshIndirectCo
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyRenderTargets() const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW))
+        return;
+
     DEV_CHECK_ERR(m_pPipelineState, "No pipeline state is bound");
 
     const auto& PSODesc = m_pPipelineState->GetDesc();
@@ -2157,6 +2521,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyRenderTargets() co
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchArguments(const DispatchComputeAttribs& Attribs) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW))
+        return;
+
     DEV_CHECK_ERR(m_pPipelineState, "DispatchCompute command arguments are invalid: no pipeline state is bound.");
 
     DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_COMPUTE,
@@ -2174,6 +2541,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchIndirectAr
     const DispatchComputeIndirectAttribs& Attribs,
     const IBuffer*                        pAttribsBuffer) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW))
+        return;
+
     DEV_CHECK_ERR(m_pPipelineState, "DispatchComputeIndirect command arguments are invalid: no pipeline state is bound.");
 
     DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_COMPUTE,
@@ -2188,6 +2558,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchIndirectAr
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchTileArguments(const DispatchTileAttribs& Attribs) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_DRAW))
+        return;
+
     DEV_CHECK_ERR(m_pPipelineState, "DispatchTile command arguments are invalid: no pipeline state is bound.");
 
     DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_TILE,
@@ -2198,6 +2571,9 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDispatchTileArgume
 template <typename ImplementationTraits>
 void DeviceContextBase<ImplementationTraits>::DvpVerifyStateTransitionDesc(const StateTransitionDesc& Barrier) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_STATE_TRANSITIONS))
+        return;
+
     DEV_CHECK_ERR(VerifyStateTransitionDesc(m_pDevice, Barrier, GetExecutionCtxId(), this->m_Desc), "StateTransitionDesc are invalid");
 }
 
@@ -2207,6 +2583,9 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifyTextureState(
     RESOURCE_STATE         RequiredState,
     const char*            OperationName) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_STATE_TRANSITIONS))
+        return;
+
     if (Texture.IsInKnownState() && !Texture.CheckState(RequiredState))
     {
         LOG_ERROR_MESSAGE(OperationName, " requires texture '", Texture.GetDesc().Name, "' to be transitioned to ", GetResourceStateString(RequiredState),
@@ -2221,6 +2600,9 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifyBufferState(
     RESOURCE_STATE        RequiredState,
     const char*           OperationName) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_STATE_TRANSITIONS))
+        return;
+
     if (Buffer.IsInKnownState() && !Buffer.CheckState(RequiredState))
     {
         LOG_ERROR_MESSAGE(OperationName, " requires buffer '", Buffer.GetDesc().Name, "' to be transitioned to ", GetResourceStateString(RequiredState),
@@ -2235,6 +2617,9 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifyBLASState(
     RESOURCE_STATE           RequiredState,
     const char*              OperationName) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_STATE_TRANSITIONS))
+        return;
+
     if (BLAS.IsInKnownState() && !BLAS.CheckState(RequiredState))
     {
         LOG_ERROR_MESSAGE(OperationName, " requires BLAS '", BLAS.GetDesc().Name, "' to be transitioned to ", GetResourceStateString(RequiredState),
@@ -2249,6 +2634,9 @@ void DeviceContextBase<ImplementationTraits>::DvpVerifyTLASState(
     RESOURCE_STATE        RequiredState,
     const char*           OperationName) const
 {
+    if (!m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_STATE_TRANSITIONS))
+        return;
+
     if (TLAS.IsInKnownState() && !TLAS.CheckState(RequiredState))
     {
         LOG_ERROR_MESSAGE(OperationName, " requires TLAS '", TLAS.GetDesc().Name, "' to be transitioned to ", GetResourceStateString(RequiredState),
@@ -35,6 +35,8 @@
 #include "RefCntAutoPtr.hpp"
 #include "ObjectBase.hpp"
 #include "UniqueIdentifier.hpp"
+#include "ObjectHandleTable.hpp"
+#include "LiveObjectRegistry.hpp"
 #include "EngineMemory.h"
 
 namespace Diligent
@@ -60,6 +62,7 @@ public:
         TBase              {pRefCounters},
         m_pDevice          {pDevice          },
         m_Desc             {ObjDesc          },
+        m_Handle           {pDevice->GetObjectHandleTable().Allocate()},
         m_bIsDeviceInternal{bIsDeviceInternal}
     //clang-format on
     {
@@ -69,21 +72,21 @@ public:
             m_pDevice->AddRef();
         }
 
+        // Object names are interned in the device-wide string table, so objects
+        // with the same name share a single copy of the string.
         if (ObjDesc.Name != nullptr)
         {
-            auto  size     = strlen(ObjDesc.Name) + 1;
-            auto* NameCopy = ALLOCATE(GetStringAllocator(), "Object name copy", char, size);
-            memcpy(NameCopy, ObjDesc.Name, size);
-            m_Desc.Name = NameCopy;
+            m_Desc.Name = m_pDevice->GetStringTable().Intern(ObjDesc.Name);
         }
         else
         {
-            size_t size       = 16 + 2 + 1; // 0x12345678
-            auto*  AddressStr = ALLOCATE(GetStringAllocator(), "Object address string", char, size);
-            snprintf(AddressStr, size, "0x%llX", static_cast<unsigned long long>(reinterpret_cast<size_t>(this)));
-            m_Desc.Name = AddressStr;
+            char AddressStr[16 + 2 + 1]; // 0x12345678
+            snprintf(AddressStr, sizeof(AddressStr), "0x%llX", static_cast<unsigned long long>(reinterpret_cast<size_t>(this)));
+            m_Desc.Name = m_pDevice->GetStringTable().Intern(AddressStr);
         }
 
+        m_LiveObjectId = m_pDevice->GetLiveObjectRegistry().Register(DeviceObjectTypeTraits<ObjectDescType>::Type, m_Desc.Name);
+
         //                        !!!WARNING!!!
         // We cannot add resource to the hash table from here, because the object
         // has not been completely created yet and the reference counters object
@@ -100,7 +103,10 @@ public:
 
     virtual ~DeviceObjectBase()
     {
-        FREE(GetStringAllocator(), const_cast<Char*>(m_Desc.Name));
+        // The registry references the interned name, so the object must be unregistered first
+        m_pDevice->GetLiveObjectRegistry().Unregister(m_LiveObjectId);
+        m_pDevice->GetStringTable().Release(m_Desc.Name);
+        m_pDevice->GetObjectHandleTable().Release(m_Handle);
 
         if (!m_bIsDeviceInternal)
         {
@@ -153,6 +159,13 @@ public:
         return m_UniqueID.GetID();
     }
 
+    /// Returns the dense device-wide handle of the object.
+
+    /// \note
+    /// Unlike the unique ID, the slot index of the handle (ObjectHandleTable::GetSlotIndex())
+    /// is small and is reused after the object is destroyed, so it can index plain arrays.
+    ObjectHandle GetHandle() const { return m_Handle; }
+
     /// Implementation of IDeviceObject::SetUserData.
     virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override final
     {
@@ -175,6 +188,12 @@ public:
     RenderDeviceImplType* GetDevice() const { return m_pDevice; }
 
 protected:
+    /// Sets the estimated memory size of the object that is reported by IRenderDevice::CaptureResourceSnapshot().
+    void SetLiveObjectSize(Uint64 Size)
+    {
+        m_pDevice->GetLiveObjectRegistry().SetSize(m_LiveObjectId, Size);
+    }
+
     /// Pointer to the device
     RenderDeviceImplType* const m_pDevice;
 
@@ -184,7 +203,9 @@ protected:
     // Template argument is only used to separate counters for
     // different groups of objects
     UniqueIdHelper<BaseInterface> m_UniqueID;
+    const ObjectHandle            m_Handle;
     const bool                    m_bIsDeviceInternal;
+    Uint32                        m_LiveObjectId = LiveObjectRegistry::InvalidId;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
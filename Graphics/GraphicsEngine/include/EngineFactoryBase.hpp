@@ -34,6 +34,7 @@
 #include "EngineFactory.h"
 #include "DefaultShaderSourceStreamFactory.h"
 #include "Atomics.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -99,6 +100,12 @@ public:
         Diligent::CreateDefaultShaderSourceStreamFactory(SearchDirectories, ppShaderSourceFactory);
     }
 
+    virtual void DILIGENT_CALL_TYPE CreateThreadPool(const ThreadPoolCreateInfo& CreateInfo,
+                                                     IThreadPool**               ppThreadPool) const override final
+    {
+        Diligent::CreateThreadPool(CreateInfo, ppThreadPool);
+    }
+
 private:
     class DummyReferenceCounters final : public IReferenceCounters
     {
@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::FrameObjectReferences class
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/Object.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Keeps one strong reference per frame to every object added to the set.
+
+/// The device context binds frequently changing objects (vertex and index buffers) through raw pointers
+/// and adds them to this set instead of holding a RefCntAutoPtr in every binding slot.
+/// Rebinding an object that is already referenced in the current frame is a hash lookup and
+/// does not touch the object's reference counter, so there is no atomic traffic on objects shared
+/// between contexts.
+///
+/// The set must be reset (and the currently bound objects added back) by the owner at the end of every
+/// frame. Objects that are not bound any more are released at that point.
+///
+/// \remarks    The class is not thread-safe.
+class FrameObjectReferences
+{
+public:
+    FrameObjectReferences() noexcept {}
+
+    // clang-format off
+    FrameObjectReferences           (const FrameObjectReferences&) = delete;
+    FrameObjectReferences& operator=(const FrameObjectReferences&) = delete;
+    FrameObjectReferences           (FrameObjectReferences&&)      = default;
+    FrameObjectReferences& operator=(FrameObjectReferences&&)      = default;
+    // clang-format on
+
+    /// Adds a strong reference to the object, unless the set already references it.
+    /// Returns true if the reference was added.
+    bool Add(IObject* pObject)
+    {
+        if (pObject == nullptr)
+            return false;
+
+        if ((m_Objects.size() + 1) * 2 > m_Table.size())
+            Rehash(m_Table.empty() ? 64 : m_Table.size() * 2);
+
+        auto& Slot = m_Table[FindSlot(pObject)];
+        if (Slot == pObject)
+            return false;
+
+        VERIFY_EXPR(Slot == nullptr);
+        Slot = pObject;
+        m_Objects.emplace_back(pObject);
+        return true;
+    }
+
+    bool Contains(IObject* pObject) const
+    {
+        return pObject != nullptr && !m_Table.empty() && m_Table[FindSlot(pObject)] == pObject;
+    }
+
+    /// Releases all references
+    void Reset()
+    {
+        if (m_Objects.empty())
+            return;
+        std::fill(m_Table.begin(), m_Table.end(), nullptr);
+        m_Objects.clear();
+    }
+
+    size_t GetSize() const
+    {
+        return m_Objects.size();
+    }
+
+private:
+    static size_t Hash(const IObject* pObject)
+    {
+        // Objects are at least 8-byte aligned: drop the low bits and mix the rest
+        auto Key = reinterpret_cast<size_t>(pObject) >> 3;
+        Key ^= Key >> 17;
+        Key *= static_cast<size_t>(0x9E3779B97F4A7C15ull);
+        return Key ^ (Key >> 29);
+    }
+
+    // Returns the index of the slot that holds the object or of the first empty slot in its probe sequence
+    size_t FindSlot(const IObject* pObject) const
+    {
+        VERIFY_EXPR(!m_Table.empty());
+        const auto Mask = m_Table.size() - 1;
+        for (auto Idx = Hash(pObject) & Mask;; Idx = (Idx + 1) & Mask)
+        {
+            const auto* Slot = m_Table[Idx];
+            if (Slot == pObject || Slot == nullptr)
+                return Idx;
+        }
+    }
+
+    void Rehash(size_t NewSize)
+    {
+        VERIFY_EXPR((NewSize & (NewSize - 1)) == 0);
+        m_Table.assign(NewSize, nullptr);
+        for (auto& pObject : m_Objects)
+            m_Table[FindSlot(pObject)] = pObject;
+    }
+
+    // Open-addressing hash set of raw pointers; the size is a power of two
+    std::vector<IObject*> m_Table;
+    // Strong references in the order they were added
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
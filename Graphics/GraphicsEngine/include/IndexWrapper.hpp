@@ -53,6 +53,9 @@ public:
     IndexWrapper(const IndexWrapper&) = default;
     IndexWrapper(IndexWrapper&&)      = default;
 
+    IndexWrapper& operator=(const IndexWrapper&) = default;
+    IndexWrapper& operator=(IndexWrapper&&) = default;
+
     operator Uint32() const
     {
         return m_Value;
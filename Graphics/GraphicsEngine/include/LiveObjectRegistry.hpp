@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::LiveObjectRegistry class
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "DataBlob.h"
+
+namespace Diligent
+{
+
+// clang-format off
+struct BufferDesc;
+struct BufferViewDesc;
+struct TextureDesc;
+struct TextureViewDesc;
+struct SamplerDesc;
+struct ShaderDesc;
+struct PipelineStateDesc;
+struct PipelineResourceSignatureDesc;
+struct FenceDesc;
+struct QueryDesc;
+struct RenderPassDesc;
+struct FramebufferDesc;
+struct BottomLevelASDesc;
+struct TopLevelASDesc;
+struct ShaderBindingTableDesc;
+struct PipelineStateCacheDesc;
+struct ResourceHeapDesc;
+struct CommandListDesc;
+// clang-format on
+
+/// Maps the object description type to the device object type.
+template <typename ObjectDescType>
+struct DeviceObjectTypeTraits
+{
+    static constexpr DEVICE_OBJECT_TYPE Type = DEVICE_OBJECT_TYPE_UNKNOWN;
+};
+
+#define DEFINE_DEVICE_OBJECT_TYPE_TRAITS(DescType, ObjType) \
+    template <>                                              \
+    struct DeviceObjectTypeTraits<DescType>                  \
+    {                                                        \
+        static constexpr DEVICE_OBJECT_TYPE Type = ObjType;  \
+    }
+
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(BufferDesc, DEVICE_OBJECT_TYPE_BUFFER);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(BufferViewDesc, DEVICE_OBJECT_TYPE_BUFFER_VIEW);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(TextureDesc, DEVICE_OBJECT_TYPE_TEXTURE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(TextureViewDesc, DEVICE_OBJECT_TYPE_TEXTURE_VIEW);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(SamplerDesc, DEVICE_OBJECT_TYPE_SAMPLER);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(ShaderDesc, DEVICE_OBJECT_TYPE_SHADER);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(PipelineStateDesc, DEVICE_OBJECT_TYPE_PIPELINE_STATE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(PipelineResourceSignatureDesc, DEVICE_OBJECT_TYPE_PIPELINE_RESOURCE_SIGNATURE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(FenceDesc, DEVICE_OBJECT_TYPE_FENCE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(QueryDesc, DEVICE_OBJECT_TYPE_QUERY);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(RenderPassDesc, DEVICE_OBJECT_TYPE_RENDER_PASS);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(FramebufferDesc, DEVICE_OBJECT_TYPE_FRAMEBUFFER);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(BottomLevelASDesc, DEVICE_OBJECT_TYPE_BOTTOM_LEVEL_AS);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(TopLevelASDesc, DEVICE_OBJECT_TYPE_TOP_LEVEL_AS);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(ShaderBindingTableDesc, DEVICE_OBJECT_TYPE_SHADER_BINDING_TABLE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(PipelineStateCacheDesc, DEVICE_OBJECT_TYPE_PIPELINE_STATE_CACHE);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(ResourceHeapDesc, DEVICE_OBJECT_TYPE_RESOURCE_HEAP);
+DEFINE_DEVICE_OBJECT_TYPE_TRAITS(CommandListDesc, DEVICE_OBJECT_TYPE_COMMAND_LIST);
+
+#undef DEFINE_DEVICE_OBJECT_TYPE_TRAITS
+
+
+class SRBMemoryAllocator;
+
+/// Thread-safe registry of the live device objects, see IRenderDevice::CaptureResourceSnapshot().
+
+/// Objects register themselves when they are created and unregister when they are destroyed.
+/// The registry only stores the information that is known at registration, so capturing
+/// a snapshot never touches the objects themselves and can't race with their destruction.
+class LiveObjectRegistry
+{
+public:
+    static constexpr Uint32 InvalidId = ~Uint32{0};
+
+    LiveObjectRegistry() noexcept {}
+
+    // clang-format off
+    LiveObjectRegistry           (const LiveObjectRegistry&)  = delete;
+    LiveObjectRegistry           (      LiveObjectRegistry&&) = delete;
+    LiveObjectRegistry& operator=(const LiveObjectRegistry&)  = delete;
+    LiveObjectRegistry& operator=(      LiveObjectRegistry&&) = delete;
+    // clang-format on
+
+    /// Registers a new object and returns its registry id.
+
+    /// \param [in] Type - Object type.
+    /// \param [in] Name - Object name. The string is not copied and must stay valid until
+    ///                    the object is unregistered.
+    Uint32 Register(DEVICE_OBJECT_TYPE Type, const Char* Name);
+
+    /// Sets the estimated memory size of the object, see LiveObjectInfo::Size.
+    void SetSize(Uint32 Id, Uint64 Size);
+
+    /// Unregisters the object. If Id is InvalidId, does nothing.
+    void Unregister(Uint32 Id);
+
+    /// Adds the SRB memory allocator of a pipeline resource signature whose occupancy is reported in
+    /// ResourceSnapshot::SRBDataPools. The allocator must be removed before it is destroyed.
+    void AddSRBAllocator(SRBMemoryAllocator* pAllocator);
+
+    /// Removes the allocator previously added by AddSRBAllocator().
+    void RemoveSRBAllocator(SRBMemoryAllocator* pAllocator);
+
+    /// Sets the number of frames finished by the first immediate context.
+    void SetFrameNumber(Uint64 FrameNumber)
+    {
+        m_FrameNumber.store(FrameNumber);
+    }
+
+    Uint64 GetFrameNumber() const
+    {
+        return m_FrameNumber.load();
+    }
+
+    /// Writes the frame number, object counts and sizes and SRB data pool occupancy to Snapshot and,
+    /// if ppObjects is not null, creates the blob with the sorted LiveObjectInfo array followed by the object names.
+    /// Other members of Snapshot are not modified.
+    void CaptureSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects);
+
+private:
+    std::mutex m_Mtx;
+
+    // Object information indexed by the registry id. SerialNumber is zero for free entries.
+    std::vector<LiveObjectInfo> m_Objects;
+
+    // Ids of the free entries
+    std::vector<Uint32> m_FreeIds;
+
+    Uint64 m_NextSerialNumber = 1;
+
+    std::vector<SRBMemoryAllocator*> m_SRBAllocators;
+
+    std::atomic<Uint64> m_FrameNumber{0};
+};
+
+} // namespace Diligent
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the pipeline archive reader and writer
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "Shader.h"
+#include "PipelineState.h"
+#include "PipelineResourceSignature.h"
+#include "RenderDevice.h"
+#include "DataBlob.h"
+#include "ThreadPool.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+// Pipeline archive stores precompiled shaders, pipeline resource signatures and pipeline
+// descriptions, so that pipelines can be created at run time without invoking the shader
+// compiler. The archive is produced offline by the PipelineArchivePacker tool.
+//
+//   | Header | Shader 0 | ... | Signature 0 | ... | Pipeline 0 | ... |
+//
+// Every record starts with its size in bytes, so that the reader can skip records it is not
+// interested in. Strings are stored as a Uint32 length followed by the null-terminated
+// characters, so that the reader returns pointers directly into the archive data. Arrays are
+// stored as a Uint32 element count followed by the elements. Byte code is aligned by 4 bytes.
+// Blend, rasterizer, depth-stencil and sample descriptions are stored as raw structures, so
+// PipelineArchiveVersion must be bumped whenever these structures change.
+
+static constexpr Uint32 PipelineArchiveMagic   = 0x52415044; // 'DPAR'
+static constexpr Uint32 PipelineArchiveVersion = 2;
+
+
+/// Shader resource reflected by the packer.
+struct PipelineArchiveShaderResource
+{
+    const char*             Name      = nullptr;
+    SHADER_RESOURCE_TYPE    Type      = SHADER_RESOURCE_TYPE_UNKNOWN;
+    Uint32                  ArraySize = 1;
+    PIPELINE_RESOURCE_FLAGS Flags     = PIPELINE_RESOURCE_FLAG_NONE;
+};
+
+/// Compiled shader variant for one device type.
+struct PipelineArchiveShaderDesc
+{
+    const char*        Name       = nullptr;
+    RENDER_DEVICE_TYPE DeviceType = RENDER_DEVICE_TYPE_UNDEFINED;
+    SHADER_TYPE        ShaderType = SHADER_TYPE_UNKNOWN;
+    const char*        EntryPoint = "main";
+
+    bool        UseCombinedTextureSamplers = false;
+    const char* CombinedSamplerSuffix      = "_sampler";
+
+    const void* ByteCode     = nullptr;
+    size_t      ByteCodeSize = 0;
+
+    /// Reflection data of the byte code.
+    const PipelineArchiveShaderResource* Resources    = nullptr;
+    Uint32                               NumResources = 0;
+};
+
+/// Pipeline description that references shaders and resource signatures by name.
+struct PipelineArchivePipelineDesc
+{
+    const char*   Name                     = nullptr;
+    PIPELINE_TYPE PipelineType             = PIPELINE_TYPE_GRAPHICS;
+    Uint32        SRBAllocationGranularity = 1;
+
+    /// Graphics pipeline description. Ignored for compute pipelines.
+    /// Render passes are not supported: pRenderPass must be null.
+    GraphicsPipelineDesc GraphicsPipeline;
+
+    /// Shader names. The stage of every shader is defined by its type.
+    const char* const* ShaderNames = nullptr;
+    Uint32             NumShaders  = 0;
+
+    const char* const* SignatureNames = nullptr;
+    Uint32             NumSignatures  = 0;
+};
+
+
+/// Serializes shaders, resource signatures and pipelines into the archive.
+
+/// All data is copied when it is added, so the pointers in the descriptions
+/// only need to be valid for the duration of the call.
+class PipelineArchiveWriter
+{
+public:
+    /// Adds a shader variant. Returns false if a shader with the same name and device type has already been added.
+    bool AddShader(const PipelineArchiveShaderDesc& ShaderDesc);
+
+    /// Adds a resource signature. Returns false if a signature with the same name has already been added.
+    bool AddResourceSignature(const PipelineResourceSignatureDesc& SignDesc);
+
+    /// Adds a pipeline. Returns false if a pipeline with the same name has already been added.
+    bool AddPipeline(const PipelineArchivePipelineDesc& PipelineDesc);
+
+    /// Writes the archive to Data.
+    void Serialize(std::vector<Uint8>& Data) const;
+
+private:
+    struct Section
+    {
+        std::vector<Uint8>              Data;
+        std::unordered_set<std::string> Keys;
+        Uint32                          Count = 0;
+    };
+    Section m_Shaders;
+    Section m_Signatures;
+    Section m_Pipelines;
+};
+
+
+/// Reads shaders, resource signatures and pipelines from the archive.
+
+/// The reader keeps a strong reference to the archive data. All strings and byte code
+/// pointers returned by the reader point into the archive and are valid as long as the
+/// data blob is alive. Records are looked up by a linear scan that only reads record
+/// headers, so the reader does not allocate memory and is cheap to construct.
+class PipelineArchiveReader
+{
+public:
+    /// Validates the archive header. Throws an exception if the data is not a valid archive.
+    explicit PipelineArchiveReader(IDataBlob* pArchive) noexcept(false);
+
+    /// Finds the shader variant for the given device type and initializes the byte code,
+    /// entry point, shader type and combined sampler members of ShaderCI.
+    /// If pResources is not null, the reflected resources are written to it.
+    /// Returns false if the shader is not found.
+    bool GetShader(const char*                                 Name,
+                   RENDER_DEVICE_TYPE                          DeviceType,
+                   ShaderCreateInfo&                           ShaderCI,
+                   std::vector<PipelineArchiveShaderResource>* pResources = nullptr) const noexcept(false);
+
+    /// Finds the resource signature and initializes its description.
+    /// Desc.Resources and Desc.ImmutableSamplers point to the Resources and ImmutableSamplers vectors.
+    /// Returns false if the signature is not found.
+    bool GetResourceSignature(const char*                        Name,
+                              PipelineResourceSignatureDesc&     Desc,
+                              std::vector<PipelineResourceDesc>& Resources,
+                              std::vector<ImmutableSamplerDesc>& ImmutableSamplers) const noexcept(false);
+
+    struct PipelineInfo
+    {
+        PipelineInfo() = default;
+
+        // GraphicsPipeline.InputLayout references LayoutElements
+        PipelineInfo(const PipelineInfo&) = delete;
+        PipelineInfo& operator=(const PipelineInfo&) = delete;
+
+        const char*                Name                     = nullptr;
+        PIPELINE_TYPE              PipelineType             = PIPELINE_TYPE_GRAPHICS;
+        Uint32                     SRBAllocationGranularity = 1;
+        GraphicsPipelineDesc       GraphicsPipeline;
+        std::vector<LayoutElement> LayoutElements;
+        std::vector<const char*>   ShaderNames;
+        std::vector<const char*>   SignatureNames;
+    };
+
+    /// Finds the pipeline and initializes Info. Returns false if the pipeline is not found.
+    bool GetPipeline(const char* Name, PipelineInfo& Info) const noexcept(false);
+
+    /// Returns the names of all shaders that have byte code for the given device type.
+    std::vector<const char*> GetShaderNames(RENDER_DEVICE_TYPE DeviceType) const noexcept(false);
+
+    /// Returns the names of all resource signatures.
+    std::vector<const char*> GetResourceSignatureNames() const noexcept(false);
+
+    /// Returns the names of all pipelines.
+    std::vector<const char*> GetPipelineNames() const noexcept(false);
+
+    Uint32 GetShaderCount() const { return m_NumShaders; }
+    Uint32 GetResourceSignatureCount() const { return m_NumSignatures; }
+    Uint32 GetPipelineCount() const { return m_NumPipelines; }
+
+private:
+    // Returns the pointer to the data of the record with the given name in the section that
+    // starts at pSection, or null if the record is not found. DeviceType is only compared
+    // for shader records.
+    const Uint8* FindRecord(const Uint8*       pSection,
+                            Uint32             NumRecords,
+                            const char*        Name,
+                            const Uint8**      ppRecordEnd,
+                            RENDER_DEVICE_TYPE DeviceType = RENDER_DEVICE_TYPE_UNDEFINED) const noexcept(false);
+
+    const Uint8* SkipSection(const Uint8* pSection, Uint32 NumRecords) const noexcept(false);
+
+    // Returns the names of the records in the section. DeviceType is only compared for shader records.
+    std::vector<const char*> GetRecordNames(const Uint8*       pSection,
+                                            Uint32             NumRecords,
+                                            RENDER_DEVICE_TYPE DeviceType = RENDER_DEVICE_TYPE_UNDEFINED) const noexcept(false);
+
+    RefCntAutoPtr<IDataBlob> m_pArchive;
+
+    const Uint8* m_pData = nullptr;
+    const Uint8* m_pEnd  = nullptr;
+
+    const Uint8* m_pShaders    = nullptr;
+    const Uint8* m_pSignatures = nullptr;
+    const Uint8* m_pPipelines  = nullptr;
+
+    Uint32 m_NumShaders    = 0;
+    Uint32 m_NumSignatures = 0;
+    Uint32 m_NumPipelines  = 0;
+};
+
+
+/// Creates a pipeline state from the archive using the public device API.
+/// This is the implementation of IRenderDevice::CreatePipelineStateFromArchive().
+void CreatePipelineStateFromArchive(IRenderDevice*                        pDevice,
+                                    const PipelineStateArchiveCreateInfo& CreateInfo,
+                                    IPipelineState**                      ppPipelineState);
+
+/// Creates all pipelines stored in the archive using the worker threads of TaskPool and the calling thread.
+/// Every shader and resource signature is created once and shared by all pipelines that use it.
+/// This is the implementation of IRenderDevice::ReplayPipelineStates().
+Uint32 ReplayPipelineArchive(IRenderDevice*                 pDevice,
+                             IThreadPool&                   TaskPool,
+                             const PipelineStateReplayInfo& ReplayInfo);
+
+} // namespace Diligent
@@ -35,6 +35,10 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include "PrivateConstants.h"
 #include "PipelineResourceSignature.h"
@@ -47,6 +51,7 @@
 #include "SRBMemoryAllocator.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "HashUtils.hpp"
+#include "ShaderVariableNameIndex.hpp"
 
 namespace Diligent
 {
@@ -193,7 +198,11 @@ public:
             return nullptr;
 
         VERIFY_EXPR(static_cast<Uint32>(VarMngrInd) < GetNumStaticResStages());
-        return m_StaticVarsMgrs[VarMngrInd].GetVariable(Name);
+        VERIFY_EXPR(m_StaticVarNameIndices[VarMngrInd]);
+        const auto VarIndex = m_StaticVarNameIndices[VarMngrInd]->Find(Name);
+        return VarIndex != ShaderVariableNameIndex::InvalidIndex ?
+            m_StaticVarsMgrs[VarMngrInd].GetVariable(VarIndex) :
+            nullptr;
     }
 
     /// Implementation of IPipelineResourceSignature::GetStaticVariableByIndex.
@@ -250,6 +259,37 @@ public:
         pResBindingImpl->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
     }
 
+    /// Implementation of IPipelineResourceSignature::CreateShaderResourceBindings.
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32                   NumSRBs,
+                                                                 IShaderResourceBinding** ppSRBs,
+                                                                 bool                     InitStaticResources) override final
+    {
+        DEV_CHECK_ERR(NumSRBs == 0 || ppSRBs != nullptr, "ppSRBs must not be null");
+
+        auto* pThisImpl{static_cast<PipelineResourceSignatureImplType*>(this)};
+
+        std::vector<RefCntAutoPtr<ShaderResourceBindingImplType>> SRBs(NumSRBs);
+        pThisImpl->CreateSRBBatch(NumSRBs, SRBs.data());
+
+        if (InitStaticResources && NumSRBs > 0)
+        {
+            std::vector<ShaderResourceCacheImplType*> Caches(NumSRBs);
+            for (Uint32 i = 0; i < NumSRBs; ++i)
+                Caches[i] = &SRBs[i]->GetResourceCache();
+
+            pThisImpl->CopyStaticResourcesBatch(NumSRBs, Caches.data());
+
+            for (auto& pSRB : SRBs)
+                pSRB->SetStaticResourcesInitialized();
+        }
+
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+        {
+            ppSRBs[i] = nullptr;
+            SRBs[i]->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppSRBs + i));
+        }
+    }
+
     /// Implementation of IPipelineResourceSignature::InitializeStaticSRBResources.
     virtual void DILIGENT_CALL_TYPE InitializeStaticSRBResources(IShaderResourceBinding* pSRB) const override final
     {
@@ -307,6 +347,82 @@ public:
         return true;
     }
 
+    /// Implementation of IPipelineResourceSignature::GetCachedShaderResourceBinding.
+    virtual void DILIGENT_CALL_TYPE GetCachedShaderResourceBinding(const CachedSRBResource* pResources,
+                                                                   Uint32                   NumResources,
+                                                                   IShaderResourceBinding** ppSRB) override final
+    {
+        DEV_CHECK_ERR(NumResources == 0 || pResources != nullptr, "pResources must not be null");
+        DEV_CHECK_ERR(ppSRB != nullptr, "ppSRB must not be null");
+        *ppSRB = nullptr;
+
+        SRBCacheKey Key;
+        Key.Bindings.reserve(NumResources);
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            const auto& Res      = pResources[i];
+            const auto  ResIndex = FindResource(Res.ShaderStages, Res.Name);
+            if (ResIndex == InvalidResourceIndex)
+            {
+                LOG_ERROR_MESSAGE("Unable to find variable '", Res.Name, "' in pipeline resource signature '", this->m_Desc.Name, "'.");
+                return;
+            }
+            if (GetResourceDesc(ResIndex).VarType != SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            {
+                LOG_ERROR_MESSAGE("Variable '", Res.Name, "' in pipeline resource signature '", this->m_Desc.Name,
+                                  "' is not mutable. Only mutable variables can be bound in cached shader resource bindings.");
+                return;
+            }
+            Key.Bindings.push_back({ResIndex, Res.ArrayIndex, Res.pObject != nullptr ? Res.pObject->GetUniqueID() : 0});
+        }
+        // The order in which the resources are given does not matter
+        std::sort(Key.Bindings.begin(), Key.Bindings.end());
+        Key.Hash = Key.Bindings.size();
+        for (const auto& Binding : Key.Bindings)
+            HashCombine(Key.Hash, Binding.ResIndex, Binding.ArrayIndex, Binding.ObjectId);
+
+        std::lock_guard<std::mutex> Lock{m_SRBCacheMtx};
+
+        auto& CachedSRB = m_SRBCache[Key];
+        if (auto pSRB = CachedSRB.Lock())
+        {
+            pSRB->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppSRB));
+            return;
+        }
+
+        // Remove entries whose objects have been released when the cache doubles in size
+        if (m_SRBCache.size() >= m_SRBCachePurgeSize)
+        {
+            for (auto it = m_SRBCache.begin(); it != m_SRBCache.end();)
+            {
+                if (it->second.IsValid() || &it->second == &CachedSRB)
+                    ++it;
+                else
+                    it = m_SRBCache.erase(it);
+            }
+            m_SRBCachePurgeSize = std::max(m_SRBCache.size() * 2, size_t{64});
+        }
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        CreateShaderResourceBinding(&pSRB, true);
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            const auto& Res     = pResources[i];
+            const auto& ResDesc = GetResourceDesc(FindResource(Res.ShaderStages, Res.Name));
+
+            // Variables are shared by all stages of the resource, so any of them can be used
+            auto       Stages = ResDesc.ShaderStages & Res.ShaderStages;
+            const auto Stage  = ExtractLSB(Stages);
+            if (auto* pVar = pSRB->GetVariableByName(Stage, Res.Name))
+                pVar->SetArray(&Res.pObject, Res.ArrayIndex, 1);
+            else
+                UNEXPECTED("Mutable variable '", Res.Name, "' is not found in the SRB");
+        }
+
+        CachedSRB = RefCntWeakPtr<ShaderResourceBindingImplType>{ValidatedCast<ShaderResourceBindingImplType>(pSRB.RawPtr())};
+        *ppSRB    = pSRB.Detach();
+    }
+
     bool IsIncompatibleWith(const PipelineResourceSignatureImplType& Other) const
     {
         return GetHash() != Other.GetHash();
@@ -359,6 +475,36 @@ public:
         return SHADER_TYPE_UNKNOWN;
     }
 
+    /// Returns the mutable or dynamic variable with the given name from the variable manager
+    /// of the active shader stage StageIndex of a shader resource binding object.
+    IShaderResourceVariable* FindSRBVariable(Uint32 StageIndex, const ShaderVariableManagerImplType& VarMgr, const Char* Name) const
+    {
+        VERIFY_EXPR(StageIndex < GetNumActiveShaderStages());
+        auto& AtomicIndex = m_SRBVarNameIndices[StageIndex];
+
+        const auto* pIndex = AtomicIndex.load(std::memory_order_acquire);
+        if (pIndex == nullptr)
+        {
+            // All SRBs of this signature have identical variable lists, so the index built
+            // from any of them is valid for all. If another thread publishes its index first, use that one.
+            auto*                    pNewIndex = CreateVariableNameIndex(VarMgr).release();
+            ShaderVariableNameIndex* pExpected = nullptr;
+            if (AtomicIndex.compare_exchange_strong(pExpected, pNewIndex, std::memory_order_acq_rel))
+            {
+                pIndex = pNewIndex;
+            }
+            else
+            {
+                delete pNewIndex;
+                pIndex = pExpected;
+            }
+        }
+
+        const auto VarIndex = pIndex->Find(Name);
+        VERIFY_EXPR(VarIndex == ShaderVariableNameIndex::InvalidIndex || VarIndex < VarMgr.GetVariableCount());
+        return VarIndex != ShaderVariableNameIndex::InvalidIndex ? VarMgr.GetVariable(VarIndex) : nullptr;
+    }
+
     static constexpr Uint32 InvalidResourceIndex = ~0u;
     /// Finds a resource with the given name in the specified shader stage and returns its
     /// index in m_Desc.Resources[], or InvalidResourceIndex if the resource is not found.
@@ -367,7 +513,9 @@ public:
         for (Uint32 r = 0; r < this->m_Desc.NumResources; ++r)
         {
             const auto& ResDesc = this->m_Desc.Resources[r];
-            if ((ResDesc.ShaderStages & ShaderStage) != 0 && strcmp(ResDesc.Name, ResourceName) == 0)
+            // Resource names are interned in the device string table, so names that come from
+            // the same table (e.g. from another signature) are matched by the pointer comparison.
+            if ((ResDesc.ShaderStages & ShaderStage) != 0 && (ResDesc.Name == ResourceName || strcmp(ResDesc.Name, ResourceName) == 0))
                 return r;
         }
 
@@ -388,6 +536,13 @@ public:
         return this->m_Desc.Resources[ResIndex];
     }
 
+    /// Returns the hash of the resource name computed by CStringHash<Char>.
+    size_t GetResourceNameHash(Uint32 ResIndex) const
+    {
+        VERIFY_EXPR(ResIndex < this->m_Desc.NumResources);
+        return m_pResourceNameHashes[ResIndex];
+    }
+
     const ImmutableSamplerDesc& GetImmutableSamplerDesc(Uint32 SampIndex) const
     {
         VERIFY_EXPR(SampIndex < this->m_Desc.NumImmutableSamplers);
@@ -423,6 +578,25 @@ public:
         return m_SRBMemAllocator;
     }
 
+    // Creates NumSRBs shader resource binding objects. Implementations that can share
+    // the work between the objects (e.g. allocate descriptor sets in bulk) hide this method.
+    void CreateSRBBatch(Uint32 NumSRBs, RefCntAutoPtr<ShaderResourceBindingImplType>* pSRBs)
+    {
+        auto* pThisImpl{static_cast<PipelineResourceSignatureImplType*>(this)};
+        auto& SRBAllocator{pThisImpl->m_pDevice->GetSRBAllocator()};
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+            pSRBs[i] = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingImplType)(pThisImpl);
+    }
+
+    // Copies static resources to NumCaches SRB resource caches. Implementations that can
+    // initialize all caches at once hide this method.
+    void CopyStaticResourcesBatch(Uint32 NumCaches, ShaderResourceCacheImplType* const* ppCaches) const
+    {
+        const auto* const pThisImpl = static_cast<const PipelineResourceSignatureImplType*>(this);
+        for (Uint32 i = 0; i < NumCaches; ++i)
+            pThisImpl->CopyStaticResources(*ppCaches[i]);
+    }
+
     // Processes resources with the allowed variable types in the allowed shader stages
     // and calls user-provided handler for each resource.
     template <typename HandlerType>
@@ -470,6 +644,7 @@ protected:
         ReserveSpaceForDescription(Allocator, Desc);
 
         Allocator.AddSpace<PipelineResourceAttribsType>(Desc.NumResources);
+        Allocator.AddSpace<size_t>(Desc.NumResources);
 
         const auto NumStaticResStages = GetNumStaticResStages();
         if (NumStaticResStages > 0)
@@ -491,6 +666,10 @@ protected:
                       "PipelineResourceAttribsType objects must be constructed to be properly destructed in case an exception is thrown");
         m_pResourceAttribs = Allocator.Allocate<PipelineResourceAttribsType>(Desc.NumResources);
 
+        m_pResourceNameHashes = Allocator.Allocate<size_t>(Desc.NumResources);
+        for (Uint32 i = 0; i < Desc.NumResources; ++i)
+            m_pResourceNameHashes[i] = CStringHash<Char>{}(this->m_Desc.Resources[i].Name);
+
         if (NumStaticResStages > 0)
         {
             m_pStaticResCache = Allocator.Construct<ShaderResourceCacheImplType>(ResourceCacheContentType::Signature);
@@ -517,6 +696,7 @@ protected:
                     VERIFY_EXPR(static_cast<Uint32>(Idx) < NumStaticResStages);
                     const auto ShaderType = GetShaderTypeFromPipelineIndex(i, GetPipelineType());
                     m_StaticVarsMgrs[Idx].Initialize(*pThisImpl, RawAllocator, AllowedVarTypes, _countof(AllowedVarTypes), ShaderType);
+                    m_StaticVarNameIndices[Idx] = CreateVariableNameIndex(m_StaticVarsMgrs[Idx]);
                 }
             }
         }
@@ -532,11 +712,30 @@ protected:
 
             const size_t CacheMemorySize = GetRequiredResourceCacheMemorySize();
             m_SRBMemAllocator.Initialize(Desc.SRBAllocationGranularity, GetNumActiveShaderStages(), ShaderVariableDataSizes.data(), 1, &CacheMemorySize);
+
+            this->GetDevice()->GetLiveObjectRegistry().AddSRBAllocator(&m_SRBMemAllocator);
+            m_IsSRBMemAllocatorRegistered = true;
         }
 
         pThisImpl->CalculateHash();
     }
 
+private:
+    static std::unique_ptr<ShaderVariableNameIndex> CreateVariableNameIndex(const ShaderVariableManagerImplType& VarMgr)
+    {
+        // Variable names point to the resource names in the signature description
+        return std::unique_ptr<ShaderVariableNameIndex>{
+            new ShaderVariableNameIndex{
+                VarMgr.GetVariableCount(),
+                [&VarMgr](Uint32 Index) {
+                    ShaderResourceDesc ResDesc;
+                    VarMgr.GetVariable(Index)->GetResourceDesc(ResDesc);
+                    return ResDesc.Name;
+                } //
+            }     //
+        };
+    }
+
 private:
     static void ReserveSpaceForDescription(FixedLinearAllocator& Allocator, const PipelineResourceSignatureDesc& Desc)
     {
@@ -551,8 +750,6 @@ private:
             VERIFY(Res.Name[0] != '\0', "Name can't be empty. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
             VERIFY(Res.ShaderStages != SHADER_TYPE_UNKNOWN, "ShaderStages can't be SHADER_TYPE_UNKNOWN. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
             VERIFY(Res.ArraySize != 0, "ArraySize can't be 0. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
-
-            Allocator.AddSpaceForString(Res.Name);
         }
 
         for (Uint32 i = 0; i < Desc.NumImmutableSamplers; ++i)
@@ -560,11 +757,10 @@ private:
             const auto* SamOrTexName = Desc.ImmutableSamplers[i].SamplerOrTextureName;
             VERIFY(SamOrTexName != nullptr, "SamplerOrTextureName can't be null. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
             VERIFY(SamOrTexName[0] != '\0', "SamplerOrTextureName can't be empty. This error should've been caught by ValidatePipelineResourceSignatureDesc().");
-            Allocator.AddSpaceForString(SamOrTexName);
         }
 
-        if (Desc.UseCombinedTextureSamplers)
-            Allocator.AddSpaceForString(Desc.CombinedSamplerSuffix);
+        // Resource names, sampler names and the combined sampler suffix are interned
+        // in the device string table by CopyDescription() and take no space here.
     }
 
     void CopyDescription(FixedLinearAllocator& Allocator, const PipelineResourceSignatureDesc& Desc) noexcept(false)
@@ -572,14 +768,23 @@ private:
         PipelineResourceDesc* pResources = Allocator.ConstructArray<PipelineResourceDesc>(Desc.NumResources);
         ImmutableSamplerDesc* pSamplers  = Allocator.ConstructArray<ImmutableSamplerDesc>(Desc.NumImmutableSamplers);
 
+        // Set the arrays right away so that Destruct() releases the names
+        // that have been interned if an exception is thrown.
+        this->m_Desc.Resources         = pResources;
+        this->m_Desc.ImmutableSamplers = pSamplers;
+
+        auto& StringTable = this->GetDevice()->GetStringTable();
+
         for (Uint32 i = 0; i < Desc.NumResources; ++i)
         {
             const auto& SrcRes = Desc.Resources[i];
             auto&       DstRes = pResources[i];
 
-            DstRes = SrcRes;
             VERIFY_EXPR(SrcRes.Name != nullptr && SrcRes.Name[0] != '\0');
-            DstRes.Name = Allocator.CopyString(SrcRes.Name);
+            const auto* Name = StringTable.Intern(SrcRes.Name);
+
+            DstRes      = SrcRes;
+            DstRes.Name = Name;
 
             ++m_ResourceOffsets[DstRes.VarType + 1];
         }
@@ -608,16 +813,15 @@ private:
             const auto& SrcSam = Desc.ImmutableSamplers[i];
             auto&       DstSam = pSamplers[i];
 
-            DstSam = SrcSam;
             VERIFY_EXPR(SrcSam.SamplerOrTextureName != nullptr && SrcSam.SamplerOrTextureName[0] != '\0');
-            DstSam.SamplerOrTextureName = Allocator.CopyString(SrcSam.SamplerOrTextureName);
-        }
+            const auto* SamOrTexName = StringTable.Intern(SrcSam.SamplerOrTextureName);
 
-        this->m_Desc.Resources         = pResources;
-        this->m_Desc.ImmutableSamplers = pSamplers;
+            DstSam                      = SrcSam;
+            DstSam.SamplerOrTextureName = SamOrTexName;
+        }
 
         if (Desc.UseCombinedTextureSamplers)
-            this->m_Desc.CombinedSamplerSuffix = Allocator.CopyString(Desc.CombinedSamplerSuffix);
+            this->m_Desc.CombinedSamplerSuffix = StringTable.Intern(Desc.CombinedSamplerSuffix);
     }
 
 protected:
@@ -625,6 +829,19 @@ protected:
     {
         VERIFY(!m_IsDestructed, "This object has already been destructed");
 
+        auto& StringTable = this->GetDevice()->GetStringTable();
+        if (this->m_Desc.Resources != nullptr)
+        {
+            for (Uint32 i = 0; i < this->m_Desc.NumResources; ++i)
+                StringTable.Release(this->m_Desc.Resources[i].Name);
+        }
+        if (this->m_Desc.ImmutableSamplers != nullptr)
+        {
+            for (Uint32 i = 0; i < this->m_Desc.NumImmutableSamplers; ++i)
+                StringTable.Release(this->m_Desc.ImmutableSamplers[i].SamplerOrTextureName);
+        }
+        StringTable.Release(this->m_Desc.CombinedSamplerSuffix);
+
         this->m_Desc.Resources             = nullptr;
         this->m_Desc.ImmutableSamplers     = nullptr;
         this->m_Desc.CombinedSamplerSuffix = nullptr;
@@ -652,11 +869,23 @@ protected:
 
         m_StaticResStageIndex.fill(-1);
 
+        for (auto& pIndex : m_StaticVarNameIndices)
+            pIndex.reset();
+        for (auto& pIndex : m_SRBVarNameIndices)
+            delete pIndex.exchange(nullptr);
+
         static_assert(std::is_trivially_destructible<PipelineResourceAttribsType>::value, "Destructors for m_pResourceAttribs[] are required");
-        m_pResourceAttribs = nullptr;
+        m_pResourceAttribs    = nullptr;
+        m_pResourceNameHashes = nullptr;
 
         m_pRawMemory.reset();
 
+        if (m_IsSRBMemAllocatorRegistered)
+        {
+            this->GetDevice()->GetLiveObjectRegistry().RemoveSRBAllocator(&m_SRBMemAllocator);
+            m_IsSRBMemAllocatorRegistered = false;
+        }
+
 #if DILIGENT_DEBUG
         m_IsDestructed = true;
 #endif
@@ -709,6 +938,9 @@ protected:
     // Pipeline resource attributes
     PipelineResourceAttribsType* m_pResourceAttribs = nullptr; // [m_Desc.NumResources]
 
+    // Resource name hashes used to look up resources in the resource mapping
+    size_t* m_pResourceNameHashes = nullptr; // [m_Desc.NumResources]
+
     // Static resource cache for all static resources
     ShaderResourceCacheImplType* m_pStaticResCache = nullptr;
 
@@ -736,6 +968,58 @@ protected:
     // Allocator for shader resource binding object instances.
     SRBMemoryAllocator m_SRBMemAllocator;
 
+    // Whether m_SRBMemAllocator is registered in the device live object registry
+    bool m_IsSRBMemAllocatorRegistered = false;
+
+    // Name index of the static variables, for every static variable manager.
+    std::array<std::unique_ptr<ShaderVariableNameIndex>, MAX_SHADERS_IN_PIPELINE> m_StaticVarNameIndices;
+
+    // Name index of the mutable and dynamic variables, for every active shader stage.
+    // The indices are shared by all SRBs and are created by the first lookup in each stage.
+    mutable std::array<std::atomic<ShaderVariableNameIndex*>, MAX_SHADERS_IN_PIPELINE> m_SRBVarNameIndices = {};
+
+    // Key of a shader resource binding object returned by GetCachedShaderResourceBinding():
+    // the mutable variables and the unique ids of the objects bound to them.
+    struct SRBCacheKey
+    {
+        struct Binding
+        {
+            Uint32 ResIndex;
+            Uint32 ArrayIndex;
+            Int32  ObjectId;
+
+            bool operator<(const Binding& rhs) const
+            {
+                return ResIndex != rhs.ResIndex ? ResIndex < rhs.ResIndex : ArrayIndex < rhs.ArrayIndex;
+            }
+            bool operator==(const Binding& rhs) const
+            {
+                return ResIndex == rhs.ResIndex && ArrayIndex == rhs.ArrayIndex && ObjectId == rhs.ObjectId;
+            }
+        };
+        std::vector<Binding> Bindings;
+
+        size_t Hash = 0;
+
+        bool operator==(const SRBCacheKey& rhs) const
+        {
+            return Hash == rhs.Hash && Bindings == rhs.Bindings;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const SRBCacheKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+    };
+
+    // The cache does not keep the SRBs alive; an entry is reused only while its SRB exists.
+    std::mutex                                                                                              m_SRBCacheMtx;
+    std::unordered_map<SRBCacheKey, RefCntWeakPtr<ShaderResourceBindingImplType>, typename SRBCacheKey::Hasher> m_SRBCache;
+    size_t                                                                                                  m_SRBCachePurgeSize = 64;
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
@@ -31,6 +31,9 @@
 /// Implementation of the Diligent::PipelineStateBase template class
 
 #include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <cstring>
@@ -45,6 +48,7 @@
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
 #include "PipelineResourceSignatureBase.hpp"
+#include "PipelineStateCreateInfoCopy.hpp"
 
 namespace Diligent
 {
@@ -339,6 +343,22 @@ public:
         return this->GetResourceSignature(0)->CreateShaderResourceBinding(ppShaderResourceBinding, InitStaticResources);
     }
 
+    virtual void DILIGENT_CALL_TYPE CreateShaderResourceBindings(Uint32                   NumSRBs,
+                                                                 IShaderResourceBinding** ppSRBs,
+                                                                 bool                     InitStaticResources) override final
+    {
+        if (!m_UsingImplicitSignature)
+        {
+            LOG_ERROR_MESSAGE("IPipelineState::CreateShaderResourceBindings is not allowed for pipelines that use explicit "
+                              "resource signatures. Use IPipelineResourceSignature::CreateShaderResourceBindings instead.");
+            for (Uint32 i = 0; i < NumSRBs; ++i)
+                ppSRBs[i] = nullptr;
+            return;
+        }
+
+        return this->GetResourceSignature(0)->CreateShaderResourceBindings(NumSRBs, ppSRBs, InitStaticResources);
+    }
+
     virtual IShaderResourceVariable* DILIGENT_CALL_TYPE GetStaticVariableByName(SHADER_TYPE ShaderType,
                                                                                 const Char* Name) override final
     {
@@ -466,9 +486,125 @@ public:
         return m_ActiveShaderStages;
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus() const override
+    {
+        return m_Status.load(std::memory_order_acquire);
+    }
+
+    /// Implementation of IPipelineState::SwapShaders().
+    virtual bool DILIGENT_CALL_TYPE SwapShaders(IPipelineState* pPipeline) override final
+    {
+        DEV_CHECK_ERR(pPipeline != nullptr, "pPipeline must not be null");
+        if (pPipeline == this)
+            return true;
+
+        auto* const pOther = ValidatedCast<PipelineStateImplType>(pPipeline);
+
+        const auto* Name      = this->m_Desc.Name != nullptr ? this->m_Desc.Name : "";
+        const auto* OtherName = pOther->m_Desc.Name != nullptr ? pOther->m_Desc.Name : "";
+        if (GetStatus() != PIPELINE_STATE_STATUS_READY || pOther->GetStatus() != PIPELINE_STATE_STATUS_READY)
+        {
+            LOG_ERROR_MESSAGE("Unable to swap shaders of pipelines '", Name, "' and '", OtherName, "': both pipelines must be ready.");
+            return false;
+        }
+        if (!this->m_Desc.IsAnyGraphicsPipeline() && !this->m_Desc.IsComputePipeline())
+        {
+            LOG_ERROR_MESSAGE("Unable to swap shaders of pipeline '", Name, "': only graphics and compute pipelines are supported.");
+            return false;
+        }
+        if (this->m_Desc.PipelineType != pOther->m_Desc.PipelineType ||
+            this->m_Desc.ImmediateContextMask != pOther->m_Desc.ImmediateContextMask ||
+            m_ActiveShaderStages != pOther->m_ActiveShaderStages)
+        {
+            LOG_ERROR_MESSAGE("Unable to swap shaders of pipelines '", Name, "' and '", OtherName,
+                              "': pipeline types, immediate context masks and shader stages must be the same.");
+            return false;
+        }
+        if (!IsCompatibleWith(pOther))
+        {
+            LOG_ERROR_MESSAGE("Unable to swap shaders of pipelines '", Name, "' and '", OtherName,
+                              "': resource signatures are not compatible.");
+            return false;
+        }
+
+        static_cast<PipelineStateImplType*>(this)->SwapShaderObjects(*pOther);
+        std::swap(m_Statistics, pOther->m_Statistics);
+        return true;
+    }
+
+    /// Implementation of IPipelineState::GetStatistics().
+    virtual const ShaderStatistics* DILIGENT_CALL_TYPE GetStatistics(Uint32& NumStages) const override final
+    {
+        NumStages = static_cast<Uint32>(m_Statistics.size());
+        return !m_Statistics.empty() ? m_Statistics.data() : nullptr;
+    }
+
+    /// Returns true if the pipeline was created with PSO_CREATE_FLAG_ASYNCHRONOUS flag
+    /// and its initialization has not been run yet.
+    bool HasPendingInitialization() const
+    {
+        return static_cast<bool>(m_AsyncInitializer);
+    }
+
+    /// Runs the deferred pipeline initialization.
+    /// The render device calls this method from one of its worker threads.
+    void RunAsyncInitialization()
+    {
+        VERIFY_EXPR(m_Status.load() == PIPELINE_STATE_STATUS_PENDING);
+        VERIFY_EXPR(HasPendingInitialization());
+
+        auto Status = PIPELINE_STATE_STATUS_FAILED;
+        try
+        {
+            m_AsyncInitializer();
+            Status = PIPELINE_STATE_STATUS_READY;
+        }
+        catch (...)
+        {
+            LOG_ERROR_MESSAGE("Failed to asynchronously create pipeline state '", (this->m_Desc.Name != nullptr ? this->m_Desc.Name : ""), "'");
+        }
+        // Release the create info copy and all references it holds
+        m_AsyncInitializer = nullptr;
+
+        m_Status.store(Status, std::memory_order_release);
+    }
+
 protected:
+    /// Sets the status of the pipeline whose initialization is performed by the backend.
+    void SetStatus(PIPELINE_STATE_STATUS Status)
+    {
+        m_Status.store(Status, std::memory_order_release);
+    }
+
     using TNameToGroupIndexMap = std::unordered_map<HashMapStringKey, Uint32, HashMapStringKey::Hasher>;
 
+    /// Initializes the backend-specific pipeline objects.
+
+    /// \param CreateInfo  - Pipeline state create info.
+    /// \param Initializer - Function that takes the create info and initializes the pipeline.
+    ///
+    /// \remarks If PSO_CREATE_FLAG_ASYNCHRONOUS flag is set, the create info is copied and the
+    ///          initializer is deferred until the render device calls RunAsyncInitialization()
+    ///          from the worker thread. Otherwise the initializer is executed immediately.
+    template <typename PSOCreateInfoType, typename InitializerType>
+    void InitializePipeline(const PSOCreateInfoType& CreateInfo, InitializerType Initializer)
+    {
+        if ((CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0)
+        {
+            auto pCreateInfoCopy = std::make_shared<PipelineStateCreateInfoCopy<PSOCreateInfoType>>(CreateInfo);
+
+            m_AsyncInitializer = [pCreateInfoCopy, Initializer]() {
+                Initializer(pCreateInfoCopy->Get());
+            };
+            m_Status.store(PIPELINE_STATE_STATUS_PENDING);
+        }
+        else
+        {
+            Initializer(CreateInfo);
+        }
+    }
+
     void ReserveSpaceForPipelineDesc(const GraphicsPipelineStateCreateInfo& CreateInfo,
                                      FixedLinearAllocator&                  MemPool) noexcept
     {
@@ -902,6 +1038,19 @@ protected:
         }
     };
 
+#ifdef DILIGENT_DEVELOPMENT
+    // Makes the attributions received from another pipeline by SwapShaderObjects()
+    // reference the compatible resource signatures of this pipeline.
+    void DvpRemapResourceAttributions(std::vector<ResourceAttribution>& Attributions) const
+    {
+        for (auto& Attrib : Attributions)
+        {
+            if (Attrib.pSignature != nullptr)
+                Attrib.pSignature = m_Signatures[Attrib.SignatureIndex];
+        }
+    }
+#endif
+
     ResourceAttribution GetResourceAttribution(const char* Name, SHADER_TYPE Stage) const
     {
         const auto* const pThis = static_cast<const PipelineStateImplType*>(this);
@@ -1111,6 +1260,10 @@ protected:
     using SignatureAutoPtrType         = RefCntAutoPtr<PipelineResourceSignatureImplType>;
     SignatureAutoPtrType* m_Signatures = nullptr; // [m_SignatureCount]
 
+    /// Shader compiler statistics, see PSO_CREATE_FLAG_CAPTURE_STATISTICS.
+    /// The backend fills the array when the pipeline is initialized.
+    std::vector<ShaderStatistics> m_Statistics;
+
     struct GraphicsPipelineData
     {
         GraphicsPipelineDesc Desc;
@@ -1154,6 +1307,12 @@ protected:
         void*                   m_pPipelineDataRawMem = nullptr;
     };
 
+private:
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    /// Deferred initialization of the asynchronously created pipeline.
+    std::function<void()> m_AsyncInitializer;
+
 #ifdef DILIGENT_DEBUG
     bool m_IsDestructed = false;
 #endif
@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::PipelineStateCreateInfoCopy template class
+
+#include <vector>
+#include <cstring>
+
+#include "PipelineState.h"
+#include "DynamicLinearAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "EngineMemory.h"
+
+namespace Diligent
+{
+
+/// Deep copy of the pipeline state create info.
+
+/// The copy owns all strings and arrays referenced by the create info and keeps strong
+/// references to all objects (shaders, resource signatures, render pass, etc.), so that
+/// it can be safely used after the original create info structure has gone out of scope,
+/// e.g. when the pipeline is initialized asynchronously.
+///
+/// \tparam PSOCreateInfoType - Pipeline state create info type (GraphicsPipelineStateCreateInfo,
+///                             ComputePipelineStateCreateInfo, etc.)
+template <typename PSOCreateInfoType>
+class PipelineStateCreateInfoCopy
+{
+public:
+    explicit PipelineStateCreateInfoCopy(const PSOCreateInfoType& CreateInfo) :
+        m_Allocator{GetRawAllocator()},
+        m_CreateInfo{CreateInfo}
+    {
+        CopyCommonData(m_CreateInfo);
+        CopyPipelineData(m_CreateInfo);
+    }
+
+    // clang-format off
+    PipelineStateCreateInfoCopy           (const PipelineStateCreateInfoCopy&)  = delete;
+    PipelineStateCreateInfoCopy           (      PipelineStateCreateInfoCopy&&) = delete;
+    PipelineStateCreateInfoCopy& operator=(const PipelineStateCreateInfoCopy&)  = delete;
+    PipelineStateCreateInfoCopy& operator=(      PipelineStateCreateInfoCopy&&) = delete;
+    // clang-format on
+
+    const PSOCreateInfoType& Get() const { return m_CreateInfo; }
+
+private:
+    void AddObjectRef(IObject* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+    }
+
+    void CopyCommonData(PipelineStateCreateInfo& CI)
+    {
+        CI.PSODesc.Name = m_Allocator.CopyString(CI.PSODesc.Name);
+
+        auto& Layout = CI.PSODesc.ResourceLayout;
+        if (Layout.Variables != nullptr)
+        {
+            auto* Variables = m_Allocator.CopyArray(Layout.Variables, Layout.NumVariables);
+            for (Uint32 i = 0; i < Layout.NumVariables; ++i)
+                Variables[i].Name = m_Allocator.CopyString(Variables[i].Name);
+            Layout.Variables = Variables;
+        }
+
+        if (Layout.ImmutableSamplers != nullptr)
+        {
+            auto* ImmutableSamplers = m_Allocator.CopyArray(Layout.ImmutableSamplers, Layout.NumImmutableSamplers);
+            for (Uint32 i = 0; i < Layout.NumImmutableSamplers; ++i)
+            {
+                ImmutableSamplers[i].SamplerOrTextureName = m_Allocator.CopyString(ImmutableSamplers[i].SamplerOrTextureName);
+                ImmutableSamplers[i].Desc.Name            = m_Allocator.CopyString(ImmutableSamplers[i].Desc.Name);
+            }
+            Layout.ImmutableSamplers = ImmutableSamplers;
+        }
+
+        if (CI.ppResourceSignatures != nullptr)
+        {
+            CI.ppResourceSignatures = m_Allocator.CopyArray(CI.ppResourceSignatures, CI.ResourceSignaturesCount);
+            for (Uint32 i = 0; i < CI.ResourceSignaturesCount; ++i)
+                AddObjectRef(CI.ppResourceSignatures[i]);
+        }
+
+        if (CI.pSpecializationConstants != nullptr)
+        {
+            auto* pSpecConsts = m_Allocator.CopyArray(CI.pSpecializationConstants, CI.NumSpecializationConstants);
+            for (Uint32 i = 0; i < CI.NumSpecializationConstants; ++i)
+            {
+                auto& Const = pSpecConsts[i];
+                Const.Name  = m_Allocator.CopyString(Const.Name);
+                if (Const.pData != nullptr)
+                {
+                    auto* pData = m_Allocator.Allocate(Const.Size, 8);
+                    memcpy(pData, Const.pData, Const.Size);
+                    Const.pData = pData;
+                }
+            }
+            CI.pSpecializationConstants = pSpecConsts;
+        }
+
+        AddObjectRef(CI.pPSOCache);
+    }
+
+    void CopyPipelineData(GraphicsPipelineStateCreateInfo& CI)
+    {
+        auto& InputLayout = CI.GraphicsPipeline.InputLayout;
+        if (InputLayout.LayoutElements != nullptr)
+        {
+            auto* LayoutElements = m_Allocator.CopyArray(InputLayout.LayoutElements, InputLayout.NumElements);
+            for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+                LayoutElements[i].HLSLSemantic = m_Allocator.CopyString(LayoutElements[i].HLSLSemantic);
+            InputLayout.LayoutElements = LayoutElements;
+        }
+
+        AddObjectRef(CI.GraphicsPipeline.pRenderPass);
+
+        for (auto* pShader : {CI.pVS, CI.pPS, CI.pDS, CI.pHS, CI.pGS, CI.pAS, CI.pMS})
+            AddObjectRef(pShader);
+    }
+
+    void CopyPipelineData(ComputePipelineStateCreateInfo& CI)
+    {
+        AddObjectRef(CI.pCS);
+    }
+
+    void CopyPipelineData(TilePipelineStateCreateInfo& CI)
+    {
+        AddObjectRef(CI.pTS);
+    }
+
+    void CopyPipelineData(RayTracingPipelineStateCreateInfo& CI)
+    {
+        if (CI.pGeneralShaders != nullptr)
+        {
+            auto* pGeneralShaders = m_Allocator.CopyArray(CI.pGeneralShaders, CI.GeneralShaderCount);
+            for (Uint32 i = 0; i < CI.GeneralShaderCount; ++i)
+            {
+                pGeneralShaders[i].Name = m_Allocator.CopyString(pGeneralShaders[i].Name);
+                AddObjectRef(pGeneralShaders[i].pShader);
+            }
+            CI.pGeneralShaders = pGeneralShaders;
+        }
+
+        if (CI.pTriangleHitShaders != nullptr)
+        {
+            auto* pTriangleHitShaders = m_Allocator.CopyArray(CI.pTriangleHitShaders, CI.TriangleHitShaderCount);
+            for (Uint32 i = 0; i < CI.TriangleHitShaderCount; ++i)
+            {
+                pTriangleHitShaders[i].Name = m_Allocator.CopyString(pTriangleHitShaders[i].Name);
+                AddObjectRef(pTriangleHitShaders[i].pClosestHitShader);
+                AddObjectRef(pTriangleHitShaders[i].pAnyHitShader);
+            }
+            CI.pTriangleHitShaders = pTriangleHitShaders;
+        }
+
+        if (CI.pProceduralHitShaders != nullptr)
+        {
+            auto* pProceduralHitShaders = m_Allocator.CopyArray(CI.pProceduralHitShaders, CI.ProceduralHitShaderCount);
+            for (Uint32 i = 0; i < CI.ProceduralHitShaderCount; ++i)
+            {
+                pProceduralHitShaders[i].Name = m_Allocator.CopyString(pProceduralHitShaders[i].Name);
+                AddObjectRef(pProceduralHitShaders[i].pIntersectionShader);
+                AddObjectRef(pProceduralHitShaders[i].pClosestHitShader);
+                AddObjectRef(pProceduralHitShaders[i].pAnyHitShader);
+            }
+            CI.pProceduralHitShaders = pProceduralHitShaders;
+        }
+
+        CI.pShaderRecordName = m_Allocator.CopyString(CI.pShaderRecordName);
+    }
+
+private:
+    DynamicLinearAllocator              m_Allocator;
+    PSOCreateInfoType                   m_CreateInfo;
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of the Diligent::PipelineStateRecorder class
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "PipelineArchive.hpp"
+
+namespace Diligent
+{
+
+/// Records the pipeline states created by the render device into a pipeline archive,
+/// see EngineCreateInfo::RecordPipelineStates.
+
+/// Shaders, resource signatures and pipelines are named after the hash of their contents,
+/// so that every distinct object is stored once no matter how many times it is created.
+/// The implicit resource signatures of the pipelines that use PipelineResourceLayoutDesc
+/// are recorded as explicit signatures. The recorder is thread-safe.
+class PipelineStateRecorder
+{
+public:
+    /// Remembers the shader attributes that the IShader interface does not expose.
+    /// Only the pipelines whose shaders have been recorded can be recorded.
+    void RecordShader(const ShaderCreateInfo& ShaderCI, IShader* pShader);
+
+    /// Records the graphics pipeline that has been created from CreateInfo.
+    void RecordPipeline(RENDER_DEVICE_TYPE DeviceType, const GraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState* pPSO);
+
+    /// Records the compute pipeline that has been created from CreateInfo.
+    void RecordPipeline(RENDER_DEVICE_TYPE DeviceType, const ComputePipelineStateCreateInfo& CreateInfo, IPipelineState* pPSO);
+
+    /// Ray tracing and tile pipelines can't be stored in the archive and are ignored.
+    void RecordPipeline(RENDER_DEVICE_TYPE, const PipelineStateCreateInfo&, IPipelineState*) {}
+
+    /// Writes the recorded pipelines to Data in the pipeline archive format.
+    void Serialize(std::vector<Uint8>& Data) const;
+
+    /// Returns the number of distinct pipelines that have been recorded.
+    Uint32 GetPipelineCount() const;
+
+private:
+    void RecordPipelineImpl(RENDER_DEVICE_TYPE             DeviceType,
+                            const PipelineStateCreateInfo& CreateInfo,
+                            const GraphicsPipelineDesc*    pGraphicsPipeline,
+                            IShader* const*                ppShaders,
+                            Uint32                         NumShaders,
+                            IPipelineState*                pPSO);
+
+    // Adds the shader to the archive if it has not been added yet and returns its record name,
+    // or null if the shader can't be recorded.
+    const std::string* AddShader(RENDER_DEVICE_TYPE DeviceType, IShader* pShader);
+
+    // Adds the resource signature to the archive if it has not been added yet and returns its record name.
+    std::string AddResourceSignature(const PipelineResourceSignatureDesc& Desc);
+
+    struct ShaderInfo
+    {
+        std::string EntryPoint;
+        bool        UseCombinedTextureSamplers = false;
+        std::string CombinedSamplerSuffix;
+
+        // Record name of the shader in the archive; empty until the shader is used by a recorded pipeline
+        std::string RecordName;
+    };
+
+    mutable std::mutex m_Mtx;
+
+    // Shaders are identified by their unique IDs, see IDeviceObject::GetUniqueID()
+    std::unordered_map<Int32, ShaderInfo> m_Shaders;
+
+    std::unordered_set<std::string> m_ShaderRecords;
+    std::unordered_set<std::string> m_SignatureRecords;
+    std::unordered_set<std::string> m_PipelineRecords;
+
+    PipelineArchiveWriter m_Writer;
+};
+
+} // namespace Diligent
@@ -30,6 +30,11 @@
 /// \file
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 #include "RenderDevice.h"
 #include "DeviceObjectBase.hpp"
 #include "Defines.h"
@@ -44,6 +49,15 @@
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
+#include "AsyncFileReader.hpp"
+#include "InternedStringTable.hpp"
+#include "ObjectHandleTable.hpp"
+#include "LiveObjectRegistry.hpp"
+#include "PipelineArchive.hpp"
+#include "PipelineStateRecorder.hpp"
+#include "PipelineStateCreateInfoCopy.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace std
 {
@@ -175,6 +189,19 @@ struct hash<Diligent::TextureViewDesc>
 namespace Diligent
 {
 
+// Validation categories compiled into the engine, see Diligent::VALIDATION_CATEGORY.
+// Checks of the categories that are not in this mask are removed by the compiler regardless of
+// EngineCreateInfo::ValidationCategories. In release builds, no validation checks are compiled in.
+#ifndef DILIGENT_VALIDATION_CATEGORIES
+#    define DILIGENT_VALIDATION_CATEGORIES VALIDATION_CATEGORY_ALL
+#endif
+
+#ifdef DILIGENT_DEVELOPMENT
+static constexpr VALIDATION_CATEGORY CompiledValidationCategories = DILIGENT_VALIDATION_CATEGORIES;
+#else
+static constexpr VALIDATION_CATEGORY CompiledValidationCategories = VALIDATION_CATEGORY_NONE;
+#endif
+
 /// Returns enabled device features based on the supported features and requested features,
 /// and throws an exception in case requested features are missing:
 ///
@@ -246,6 +273,8 @@ public:
         TObjectBase             {pRefCounters},
         m_pEngineFactory        {pEngineFactory},
         m_ValidationFlags       {EngineCI.ValidationFlags},
+        m_ValidationCategories  {EngineCI.ValidationCategories},
+        m_NumAsyncWorkerThreads {EngineCI.NumAsyncWorkerThreads},
         m_AdapterInfo           {AdapterInfo},
         m_SamplersRegistry      {RawMemAllocator, "sampler"},
         m_TextureFormatsInfo    (TEX_FORMAT_NUM_FORMATS, TextureFormatInfoExt(), STD_ALLOCATOR_RAW_MEM(TextureFormatInfoExt, RawMemAllocator, "Allocator for vector<TextureFormatInfoExt>")),
@@ -253,6 +282,7 @@ public:
         m_wpImmediateContexts   (std::max(1u, EngineCI.NumImmediateContexts), RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
         m_wpDeferredContexts    (EngineCI.NumDeferredContexts, RefCntWeakPtr<IDeviceContext>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<IDeviceContext>, RawMemAllocator, "Allocator for vector< RefCntWeakPtr<IDeviceContext> >")),
         m_RawMemAllocator       {RawMemAllocator},
+        m_StringTable           {GetStringAllocator()},
         m_TexObjAllocator       {RawMemAllocator, sizeof(TextureImplType),                    64},
         m_TexViewObjAllocator   {RawMemAllocator, sizeof(TextureViewImplType),                64},
         m_BufObjAllocator       {RawMemAllocator, sizeof(BufferImplType),                    128},
@@ -269,9 +299,19 @@ public:
         m_BLASAllocator         {RawMemAllocator, sizeof(BottomLevelASImplType),              16},
         m_TLASAllocator         {RawMemAllocator, sizeof(TopLevelASImplType),                 16},
         m_SBTAllocator          {RawMemAllocator, sizeof(ShaderBindingTableImplType),         16},
-        m_PipeResSignAllocator  {RawMemAllocator, sizeof(PipelineResourceSignatureImplType), 128}
+        m_PipeResSignAllocator  {RawMemAllocator, sizeof(PipelineResourceSignatureImplType), 128},
+        m_pAsyncTaskPool        {EngineCI.pAsyncTaskPool}
     // clang-format on
     {
+        m_DeviceInfo.NumNodes = std::max(AdapterInfo.NumNodes, 1u);
+
+        if (EngineCI.RecordPipelineStates)
+            m_pPSORecorder.reset(new PipelineStateRecorder{});
+
+        // Shader source stream factories prefetch include files on the application's pool as well
+        if (m_pAsyncTaskPool)
+            AsyncFileReader::GetSharedInstance().SetThreadPool(m_pAsyncTaskPool);
+
         // Initialize texture format info
         for (Uint32 Fmt = TEX_FORMAT_UNKNOWN; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
             static_cast<TextureFormatAttribs&>(m_TextureFormatsInfo[Fmt]) = GetTextureFormatAttribs(static_cast<TEXTURE_FORMAT>(Fmt));
@@ -323,6 +363,8 @@ public:
 
     ~RenderDeviceBase()
     {
+        if (m_pAsyncTaskPool)
+            AsyncFileReader::GetSharedInstance().ResetThreadPool(m_pAsyncTaskPool);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_RenderDevice, ObjectBase<BaseInterface>)
@@ -360,6 +402,12 @@ public:
         return m_DeviceInfo;
     }
 
+    /// Called by the engine factory once the device and its contexts have been created.
+    void SetInitStatistics(const DeviceInitStatistics& InitStats)
+    {
+        m_DeviceInfo.InitStats = InitStats;
+    }
+
     /// Implementation of IRenderDevice::GetAdapterInfo().
     virtual const GraphicsAdapterInfo& DILIGENT_CALL_TYPE GetAdapterInfo() const override final
     {
@@ -402,6 +450,167 @@ public:
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Base implementation of IRenderDevice::GetMemoryStatistics().
+    virtual void DILIGENT_CALL_TYPE GetMemoryStatistics(RenderDeviceMemoryStatistics& Stats) override
+    {
+        // Device memory is not tracked by default
+        Stats = RenderDeviceMemoryStatistics{};
+    }
+
+    /// Base implementation of IRenderDevice::SetMemoryAllocationCallback().
+    virtual void DILIGENT_CALL_TYPE SetMemoryAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData) override
+    {
+    }
+
+    /// Base implementation of IRenderDevice::CaptureResourceSnapshot().
+
+    /// Backends override this method to add the statistics of their caches and release queues.
+    virtual void DILIGENT_CALL_TYPE CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects) override
+    {
+        Snapshot = ResourceSnapshot{};
+
+        auto GetPoolStatistics = [&](DEVICE_OBJECT_TYPE Type, FixedBlockMemoryAllocator& Allocator) //
+        {
+            auto& Stats = Snapshot.ObjectPools[Type];
+            Allocator.GetStatistics(Stats.NumAllocatedBlocks, Stats.NumReservedBlocks);
+            Stats.AllocatedSize = Uint64{Stats.NumAllocatedBlocks} * Allocator.GetBlockSize();
+            Stats.ReservedSize  = Uint64{Stats.NumReservedBlocks} * Allocator.GetBlockSize();
+        };
+        // clang-format off
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_BUFFER,                      m_BufObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_BUFFER_VIEW,                 m_BuffViewObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_TEXTURE,                     m_TexObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_TEXTURE_VIEW,                m_TexViewObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_SAMPLER,                     m_SamplerObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_SHADER,                      m_ShaderObjAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_PIPELINE_STATE,              m_PSOAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_SHADER_RESOURCE_BINDING,     m_SRBAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_PIPELINE_RESOURCE_SIGNATURE, m_PipeResSignAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_FENCE,                       m_FenceAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_QUERY,                       m_QueryAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_RENDER_PASS,                 m_RenderPassAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_FRAMEBUFFER,                 m_FramebufferAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_BOTTOM_LEVEL_AS,             m_BLASAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_TOP_LEVEL_AS,                m_TLASAllocator);
+        GetPoolStatistics(DEVICE_OBJECT_TYPE_SHADER_BINDING_TABLE,        m_SBTAllocator);
+        // clang-format on
+
+        m_LiveObjects.CaptureSnapshot(Snapshot, ppObjects);
+    }
+
+    /// Base implementation of IRenderDevice::CreatePipelineStateCache().
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                             IPipelineStateCache**               ppPSOCache) override
+    {
+        DEV_CHECK_ERR(ppPSOCache != nullptr, "Null pointer provided");
+        if (ppPSOCache != nullptr)
+            *ppPSOCache = nullptr;
+        LOG_WARNING_MESSAGE_ONCE("Pipeline state cache is not supported by this device");
+    }
+
+    /// Base implementation of IRenderDevice::CreateResourceHeap().
+    virtual void DILIGENT_CALL_TYPE CreateResourceHeap(const ResourceHeapDesc& Desc,
+                                                       IResourceHeap**         ppHeap) override
+    {
+        DEV_CHECK_ERR(ppHeap != nullptr, "Null pointer provided");
+        if (ppHeap != nullptr)
+            *ppHeap = nullptr;
+        LOG_WARNING_MESSAGE_ONCE("Resource heaps are not supported by this device");
+    }
+
+    /// Base implementation of IRenderDevice::CreatePipelineStateFromArchive().
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateFromArchive(const PipelineStateArchiveCreateInfo& CreateInfo,
+                                                                   IPipelineState**                      ppPipelineState) override
+    {
+        Diligent::CreatePipelineStateFromArchive(this, CreateInfo, ppPipelineState);
+    }
+
+    /// Base implementation of IRenderDevice::GetRecordedPipelineStates().
+    virtual void DILIGENT_CALL_TYPE GetRecordedPipelineStates(IDataBlob** ppArchive) override
+    {
+        DEV_CHECK_ERR(ppArchive != nullptr, "Null pointer provided");
+        if (ppArchive == nullptr)
+            return;
+
+        *ppArchive = nullptr;
+        if (!m_pPSORecorder)
+        {
+            LOG_WARNING_MESSAGE("Pipeline states are not recorded: EngineCreateInfo::RecordPipelineStates is disabled");
+            return;
+        }
+
+        std::vector<Uint8> Data;
+        m_pPSORecorder->Serialize(Data);
+
+        RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>{}(Data.size())};
+        memcpy(pDataBlob->GetDataPtr(), Data.data(), Data.size());
+        pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppArchive));
+    }
+
+    /// Base implementation of IRenderDevice::ReplayPipelineStates().
+    virtual Uint32 DILIGENT_CALL_TYPE ReplayPipelineStates(const PipelineStateReplayInfo& ReplayInfo) override
+    {
+        return Diligent::ReplayPipelineArchive(this, GetAsyncTaskPool(), ReplayInfo);
+    }
+
+    /// Base implementation of IRenderDevice::CreateShaders().
+
+    /// The shaders are distributed between the worker threads of the asynchronous task pool and
+    /// the calling thread. Every thread takes the next shader from the array until all shaders are created.
+    virtual void DILIGENT_CALL_TYPE CreateShaders(const ShaderCreateInfo* pShaderCIs,
+                                                  Uint32                  NumShaders,
+                                                  IShader**               ppShaders) override
+    {
+        DEV_CHECK_ERR(NumShaders == 0 || (pShaderCIs != nullptr && ppShaders != nullptr), "Null pointer provided");
+        if (NumShaders == 0 || pShaderCIs == nullptr || ppShaders == nullptr)
+            return;
+
+        auto&        TaskPool   = GetAsyncTaskPool();
+        const Uint32 NumWorkers = std::min(NumShaders - 1, TaskPool.GetThreadCount());
+
+        // The state is shared with the tasks, so that the tasks that start
+        // after all shaders have been created can safely exit.
+        struct BatchState
+        {
+            std::atomic<Uint32>     NextShader{0};
+            Uint32                  NumCreated = 0;
+            std::mutex              Mtx;
+            std::condition_variable AllCreatedCV;
+        };
+        auto pState = std::make_shared<BatchState>();
+
+        auto* const pDevice       = static_cast<RenderDeviceImplType*>(this);
+        auto        CreateShadersTask = [pState, pDevice, pShaderCIs, NumShaders, ppShaders]() {
+            Uint32 NumCreatedByThisThread = 0;
+            for (auto Idx = pState->NextShader.fetch_add(1); Idx < NumShaders; Idx = pState->NextShader.fetch_add(1))
+            {
+                pDevice->CreateShader(pShaderCIs[Idx], &ppShaders[Idx]);
+                ++NumCreatedByThisThread;
+            }
+
+            if (NumCreatedByThisThread > 0)
+            {
+                bool AllCreated = false;
+                {
+                    std::lock_guard<std::mutex> Lock{pState->Mtx};
+                    pState->NumCreated += NumCreatedByThisThread;
+                    AllCreated = pState->NumCreated == NumShaders;
+                }
+                if (AllCreated)
+                    pState->AllCreatedCV.notify_all();
+            }
+        };
+
+        for (Uint32 i = 0; i < NumWorkers; ++i)
+            EnqueueTask(&TaskPool, CreateShadersTask);
+
+        // The calling thread creates the shaders too
+        CreateShadersTask();
+
+        std::unique_lock<std::mutex> Lock{pState->Mtx};
+        pState->AllCreatedCV.wait(Lock, [&pState, NumShaders] { return pState->NumCreated == NumShaders; });
+    }
+
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
     /// Set weak reference to the immediate context
@@ -437,14 +646,47 @@ public:
     FixedBlockMemoryAllocator& GetBuffViewObjAllocator() { return m_BuffViewObjAllocator; }
     FixedBlockMemoryAllocator& GetSRBAllocator() { return m_SRBAllocator; }
 
+    /// Returns the device-wide table of interned strings that holds
+    /// object names and pipeline resource signature resource names.
+    InternedStringTable& GetStringTable() { return m_StringTable; }
+
+    /// Returns the device-wide table of dense object handles, see DeviceObjectBase::GetHandle().
+    ObjectHandleTable& GetObjectHandleTable() { return m_ObjectHandles; }
+
+    /// Returns the registry of the live device objects, see IRenderDevice::CaptureResourceSnapshot().
+    LiveObjectRegistry& GetLiveObjectRegistry() { return m_LiveObjects; }
+
     VALIDATION_FLAGS GetValidationFlags() const { return m_ValidationFlags; }
 
+    /// Returns true if the validation checks of the given category are compiled in and enabled.
+
+    /// When the category is not in the compiled validation mask, the function is evaluated at
+    /// compile time and the checks it guards are removed entirely.
+    bool IsValidationEnabled(VALIDATION_CATEGORY Category) const
+    {
+        return (CompiledValidationCategories & Category) != 0 && (m_ValidationCategories & Category) != 0;
+    }
+
     // Convenience function
     const DeviceFeatures& GetFeatures() const
     {
         return m_DeviceInfo.Features;
     }
 
+    /// Returns the pool of worker threads that run asynchronous tasks. If the application has not
+    /// provided the pool through EngineCreateInfo::pAsyncTaskPool, the pool is created on first use.
+    IThreadPool& GetAsyncTaskPool()
+    {
+        std::lock_guard<std::mutex> Lock{m_AsyncTaskPoolMtx};
+        if (!m_pAsyncTaskPool)
+        {
+            ThreadPoolCreateInfo PoolCI;
+            PoolCI.NumThreads = m_NumAsyncWorkerThreads;
+            CreateThreadPool(PoolCI, &m_pAsyncTaskPool);
+        }
+        return *m_pAsyncTaskPool;
+    }
+
 protected:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) = 0;
 
@@ -511,6 +753,28 @@ protected:
                            {
                                auto* pPipelineStateImpl{NEW_RC_OBJ(m_PSOAllocator, "Pipeline State instance", PipelineStateImplType)(static_cast<RenderDeviceImplType*>(this), PSOCreateInfo, ExtraArgs...)};
                                pPipelineStateImpl->QueryInterface(IID_PipelineState, reinterpret_cast<IObject**>(ppPipelineState));
+                               if (pPipelineStateImpl->HasPendingInitialization())
+                               {
+                                   // The task keeps a strong reference to the pipeline, so it is safe
+                                   // to release the object before the initialization is complete.
+                                   RefCntAutoPtr<PipelineStateImplType> pPSO{pPipelineStateImpl};
+
+                                   // Resource signatures of the pipeline are only available after the initialization,
+                                   // so the pipeline is recorded by the task from a copy of the create info.
+                                   std::shared_ptr<PipelineStateCreateInfoCopy<PSOCreateInfoType>> pCICopy;
+                                   if (m_pPSORecorder)
+                                       pCICopy = std::make_shared<PipelineStateCreateInfoCopy<PSOCreateInfoType>>(PSOCreateInfo);
+
+                                   EnqueueTask(&GetAsyncTaskPool(), [this, pPSO, pCICopy]() mutable {
+                                       pPSO->RunAsyncInitialization();
+                                       if (pCICopy && pPSO->GetStatus() == PIPELINE_STATE_STATUS_READY)
+                                           m_pPSORecorder->RecordPipeline(m_DeviceInfo.Type, pCICopy->Get(), pPSO);
+                                   });
+                               }
+                               else if (m_pPSORecorder)
+                               {
+                                   m_pPSORecorder->RecordPipeline(m_DeviceInfo.Type, PSOCreateInfo, pPipelineStateImpl);
+                               }
                            });
     }
 
@@ -546,6 +810,8 @@ protected:
                            {
                                auto* pShaderImpl{NEW_RC_OBJ(m_ShaderObjAllocator, "Shader instance", ShaderImplType)(static_cast<RenderDeviceImplType*>(this), ShaderCI, ExtraArgs...)};
                                pShaderImpl->QueryInterface(IID_Shader, reinterpret_cast<IObject**>(ppShader));
+                               if (m_pPSORecorder)
+                                   m_pPSORecorder->RecordShader(ShaderCI, pShaderImpl);
                            });
     }
 
@@ -651,10 +917,37 @@ protected:
                            });
     }
 
+    template <typename... ExtraArgsType>
+    void CreatePipelineStateCacheImpl(IPipelineStateCache** ppPSOCache, const PipelineStateCacheCreateInfo& CreateInfo, const ExtraArgsType&... ExtraArgs)
+    {
+        using PipelineStateCacheImplType = typename EngineImplTraits::PipelineStateCacheImplType;
+        CreateDeviceObject("PipelineStateCache", CreateInfo.Desc, ppPSOCache,
+                           [&]() //
+                           {
+                               auto* pPSOCacheImpl(NEW_RC_OBJ(GetRawAllocator(), "PipelineStateCache instance", PipelineStateCacheImplType)(static_cast<RenderDeviceImplType*>(this), CreateInfo, ExtraArgs...));
+                               pPSOCacheImpl->QueryInterface(IID_PipelineStateCache, reinterpret_cast<IObject**>(ppPSOCache));
+                           });
+    }
+
+    template <typename... ExtraArgsType>
+    void CreateResourceHeapImpl(IResourceHeap** ppHeap, const ResourceHeapDesc& Desc, const ExtraArgsType&... ExtraArgs)
+    {
+        using ResourceHeapImplType = typename EngineImplTraits::ResourceHeapImplType;
+        CreateDeviceObject("ResourceHeap", Desc, ppHeap,
+                           [&]() //
+                           {
+                               auto* pHeapImpl(NEW_RC_OBJ(GetRawAllocator(), "ResourceHeap instance", ResourceHeapImplType)(static_cast<RenderDeviceImplType*>(this), Desc, ExtraArgs...));
+                               pHeapImpl->QueryInterface(IID_ResourceHeap, reinterpret_cast<IObject**>(ppHeap));
+                           });
+    }
+
 protected:
     RefCntAutoPtr<IEngineFactory> m_pEngineFactory;
 
-    const VALIDATION_FLAGS m_ValidationFlags;
+    const VALIDATION_FLAGS    m_ValidationFlags;
+    const VALIDATION_CATEGORY m_ValidationCategories;
+    const Uint32              m_NumAsyncWorkerThreads; ///< The number of threads in the async task pool, 0 for default
+
     GraphicsAdapterInfo    m_AdapterInfo;
     RenderDeviceInfo       m_DeviceInfo;
 
@@ -673,6 +966,9 @@ protected:
     std::vector<RefCntWeakPtr<IDeviceContext>, STDAllocatorRawMem<RefCntWeakPtr<IDeviceContext>>> m_wpDeferredContexts;
 
     IMemoryAllocator&         m_RawMemAllocator;      ///< Raw memory allocator
+    InternedStringTable       m_StringTable;          ///< Interned object and resource names
+    ObjectHandleTable         m_ObjectHandles;        ///< Dense handles of all device objects
+    LiveObjectRegistry        m_LiveObjects;          ///< Live device objects reported by CaptureResourceSnapshot()
     FixedBlockMemoryAllocator m_TexObjAllocator;      ///< Allocator for texture objects
     FixedBlockMemoryAllocator m_TexViewObjAllocator;  ///< Allocator for texture view objects
     FixedBlockMemoryAllocator m_BufObjAllocator;      ///< Allocator for buffer objects
@@ -690,6 +986,11 @@ protected:
     FixedBlockMemoryAllocator m_TLASAllocator;        ///< Allocator for top-level acceleration structure objects
     FixedBlockMemoryAllocator m_SBTAllocator;         ///< Allocator for shader binding table objects
     FixedBlockMemoryAllocator m_PipeResSignAllocator; ///< Allocator for pipeline resource signature objects
+
+    std::mutex                 m_AsyncTaskPoolMtx;
+    RefCntAutoPtr<IThreadPool> m_pAsyncTaskPool; ///< Worker threads that create asynchronous pipelines
+
+    std::unique_ptr<PipelineStateRecorder> m_pPSORecorder; ///< Records created pipelines, see EngineCreateInfo::RecordPipelineStates
 };
 
 } // namespace Diligent
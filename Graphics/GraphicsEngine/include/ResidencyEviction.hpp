@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::SelectResidencyEvictionCandidates function
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Memory state and frame counters used to select the objects to evict.
+struct ResidencyEvictionAttribs
+{
+    /// Video memory budget, in bytes.
+    Uint64 Budget = 0;
+
+    /// Current video memory usage, in bytes.
+    Uint64 CurrentUsage = 0;
+
+    /// The size of the objects that are about to be made resident, in bytes.
+    Uint64 RequiredSize = 0;
+
+    /// The current frame number.
+    Uint64 CurrentFrame = 0;
+
+    /// The last frame that has been completed by the GPU.
+    Uint64 LastCompletedFrame = 0;
+
+    /// The number of frames an object must stay unused before it can be evicted.
+    Uint32 EvictionFrameCount = 1;
+};
+
+/// Selects the resident objects to evict so that RequiredSize more bytes fit into the budget.
+
+/// \param [in, out] Candidates - On input, the resident objects. On output, the objects to evict,
+///                               least recently used first.
+/// \param [in]      Attribs    - Memory state and frame counters.
+/// \return          The total size of the selected objects.
+///
+/// \remarks ObjectType must have Size and LastUsedFrame members. An object can only be evicted when
+///          it has not been used for EvictionFrameCount frames and all command lists that use it
+///          have been executed, i.e. the frame in which it was last used has been completed.
+///          Objects used in the same frame are selected in their input order.
+///          If evicting all eligible objects is not enough, all of them are selected.
+template <typename ObjectType>
+Uint64 SelectResidencyEvictionCandidates(std::vector<ObjectType*>& Candidates, const ResidencyEvictionAttribs& Attribs)
+{
+    if (Attribs.CurrentUsage + Attribs.RequiredSize <= Attribs.Budget)
+    {
+        Candidates.clear();
+        return 0;
+    }
+
+    auto IsNotEvictable = [&Attribs](const ObjectType* pObject) {
+        return (pObject->LastUsedFrame + Attribs.EvictionFrameCount > Attribs.CurrentFrame ||
+                pObject->LastUsedFrame > Attribs.LastCompletedFrame);
+    };
+    Candidates.erase(std::remove_if(Candidates.begin(), Candidates.end(), IsNotEvictable), Candidates.end());
+
+    std::stable_sort(Candidates.begin(), Candidates.end(),
+                     [](const ObjectType* pObj0, const ObjectType* pObj1) {
+                         return pObj0->LastUsedFrame < pObj1->LastUsedFrame;
+                     });
+
+    const auto ExcessSize = Attribs.CurrentUsage + Attribs.RequiredSize - Attribs.Budget;
+
+    Uint64 EvictedSize = 0;
+    size_t NumToEvict  = 0;
+    while (NumToEvict < Candidates.size() && EvictedSize < ExcessSize)
+        EvictedSize += Candidates[NumToEvict++]->Size;
+    Candidates.resize(NumToEvict);
+
+    return EvictedSize;
+}
+
+} // namespace Diligent
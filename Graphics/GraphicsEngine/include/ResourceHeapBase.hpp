@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::ResourceHeapBase template class
+
+#include "ResourceHeap.h"
+#include "DeviceObjectBase.hpp"
+#include "GraphicsTypes.h"
+
+namespace Diligent
+{
+
+/// Template class implementing base functionality of the resource heap object
+
+/// \tparam EngineImplTraits - Engine implementation type traits.
+template <typename EngineImplTraits>
+class ResourceHeapBase : public DeviceObjectBase<typename EngineImplTraits::ResourceHeapInterface, typename EngineImplTraits::RenderDeviceImplType, ResourceHeapDesc>
+{
+public:
+    // Base interface that this class inherits (IResourceHeapD3D12, IResourceHeapVk, etc.).
+    using BaseInterface = typename EngineImplTraits::ResourceHeapInterface;
+
+    // Render device implementation type (RenderDeviceD3D12Impl, RenderDeviceVkImpl, etc.).
+    using RenderDeviceImplType = typename EngineImplTraits::RenderDeviceImplType;
+
+    using TDeviceObjectBase = DeviceObjectBase<BaseInterface, RenderDeviceImplType, ResourceHeapDesc>;
+
+    /// \param pRefCounters      - Reference counters object that controls the lifetime of this resource heap.
+    /// \param pDevice           - Pointer to the device.
+    /// \param Desc              - Resource heap description.
+    /// \param bIsDeviceInternal - Flag indicating if the heap is an internal device object and
+    ///							   must not keep a strong reference to the device.
+    ResourceHeapBase(IReferenceCounters* pRefCounters, RenderDeviceImplType* pDevice, const ResourceHeapDesc& Desc, bool bIsDeviceInternal = false) :
+        TDeviceObjectBase{pRefCounters, pDevice, Desc, bIsDeviceInternal}
+    {
+        if (this->m_Desc.Size == 0)
+            LOG_ERROR_AND_THROW("Description of resource heap '", this->m_Desc.Name, "' is invalid: heap size must not be zero");
+
+        Uint64 DeviceQueuesMask = pDevice->GetCommandQueueMask();
+        DEV_CHECK_ERR((this->m_Desc.ImmediateContextMask & DeviceQueuesMask) != 0,
+                      "No bits in the immediate context mask (0x", std::hex, this->m_Desc.ImmediateContextMask,
+                      ") correspond to one of ", pDevice->GetCommandQueueCount(), " available software command queues");
+        this->m_Desc.ImmediateContextMask &= DeviceQueuesMask;
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ResourceHeap, TDeviceObjectBase)
+
+protected:
+    // Checks that the resource with the given attributes can be placed at the offset.
+    // Throws an exception if the placement is invalid.
+    void ValidatePlacement(const char*                   ObjectType,
+                           const char*                   Name,
+                           USAGE                         Usage,
+                           Uint64                        ImmediateContextMask,
+                           Uint64                        Offset,
+                           const ResourceAllocationInfo& AllocInfo) const
+    {
+        if (Name == nullptr)
+            Name = "";
+
+        if (Usage != USAGE_DEFAULT)
+            LOG_ERROR_AND_THROW("Failed to place ", ObjectType, " '", Name, "' in resource heap '", this->m_Desc.Name, "': only USAGE_DEFAULT resources may be placed in a heap");
+
+        if ((ImmediateContextMask & ~this->m_Desc.ImmediateContextMask) != 0)
+            LOG_ERROR_AND_THROW("Failed to place ", ObjectType, " '", Name, "' in resource heap '", this->m_Desc.Name, "': ImmediateContextMask of the ", ObjectType,
+                                " must be a subset of the heap's mask");
+
+        if (AllocInfo.Alignment != 0 && (Offset % AllocInfo.Alignment) != 0)
+            LOG_ERROR_AND_THROW("Failed to place ", ObjectType, " '", Name, "' in resource heap '", this->m_Desc.Name, "': offset ", Offset,
+                                " is not a multiple of the required alignment (", AllocInfo.Alignment, ")");
+
+        if (Offset + AllocInfo.Size > this->m_Desc.Size)
+            LOG_ERROR_AND_THROW("Failed to place ", ObjectType, " '", Name, "' in resource heap '", this->m_Desc.Name, "': the range [", Offset, ", ", Offset + AllocInfo.Size,
+                                ") exceeds the heap size (", this->m_Desc.Size, ")");
+    }
+};
+
+} // namespace Diligent
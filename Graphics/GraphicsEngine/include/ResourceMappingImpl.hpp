@@ -31,6 +31,7 @@
 /// Declaration of the Diligent::ResourceMappingImpl class
 
 #include <unordered_map>
+#include <memory>
 
 #include "ResourceMapping.h"
 #include "ObjectBase.hpp"
@@ -43,7 +44,14 @@ namespace Diligent
 
 class FixedBlockMemoryAllocator;
 
+// {2D8E1B7C-5F3A-4C69-9E41-7A0C3D6B8F52}
+static const INTERFACE_ID IID_ResourceMappingImpl =
+    {0x2d8e1b7c, 0x5f3a, 0x4c69, {0x9e, 0x41, 0x7a, 0xc, 0x3d, 0x6b, 0x8f, 0x52}};
+
 /// Implementation of the resource mapping
+
+/// Resources are distributed over NumShards independently locked hash tables selected by
+/// the name hash, so that threads looking up different resources rarely contend for the same lock.
 class ResourceMappingImpl : public ObjectBase<IResourceMapping>
 {
 public:
@@ -52,13 +60,32 @@ public:
     /// \param pRefCounters - reference counters object that controls the lifetime of this resource mapping
     /// \param RawMemAllocator - raw memory allocator that is used by the m_HashTable member
     ResourceMappingImpl(IReferenceCounters* pRefCounters, IMemoryAllocator& RawMemAllocator) :
-        TObjectBase{pRefCounters},
-        m_HashTable{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")}
-    {}
+        TObjectBase{pRefCounters}
+    {
+        for (auto& Shard : m_Shards)
+        {
+            Shard.HashTable.reset(new HashTableType{STD_ALLOCATOR_RAW_MEM(HashTableElem, RawMemAllocator, "Allocator for unordered_map<ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>")});
+        }
+    }
 
     ~ResourceMappingImpl();
 
-    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ResourceMapping, TObjectBase)
+    /// Besides IID_ResourceMapping, the object can be queried for IID_ResourceMappingImpl, which
+    /// the engine uses to detect its own implementation and look up resources by precomputed name hashes.
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        if (ppInterface == nullptr)
+            return;
+        if (IID == IID_ResourceMapping || IID == IID_ResourceMappingImpl)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            TObjectBase::QueryInterface(IID, ppInterface);
+        }
+    }
 
     /// Implementation of IResourceMapping::AddResource()
     virtual void DILIGENT_CALL_TYPE AddResource(const Char*    Name,
@@ -80,6 +107,13 @@ public:
                                                 IDeviceObject** ppResource,
                                                 Uint32          ArrayIndex) override final;
 
+    /// Same as GetResource(), but uses the name hash computed beforehand by CStringHash<Char>,
+    /// so that the lookup does not need to hash the name string.
+    void GetResource(const Char*     Name,
+                     size_t          NameHash,
+                     IDeviceObject** ppResource,
+                     Uint32          ArrayIndex);
+
     /// Returns number of resources in the resource mapping.
     virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
 
@@ -95,6 +129,13 @@ private:
             Ownership_Hash = (ComputeHash(GetHash(), ArrInd) & HashMask) | (Ownership_Hash & StrOwnershipMask);
         }
 
+        ResMappingHashKey(const Char* Str, size_t StrHash, Uint32 ArrInd) noexcept :
+            HashMapStringKey{Str, StrHash},
+            ArrayIndex{ArrInd}
+        {
+            Ownership_Hash = (ComputeHash(GetHash(), ArrInd) & HashMask) | (Ownership_Hash & StrOwnershipMask);
+        }
+
         ResMappingHashKey(ResMappingHashKey&& rhs) noexcept :
             HashMapStringKey{std::move(rhs)},
             ArrayIndex{rhs.ArrayIndex}
@@ -123,17 +164,33 @@ private:
         const Uint32 ArrayIndex;
     };
 
-    ThreadingTools::LockHelper Lock();
+    using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
+    using HashTableType = std::unordered_map<ResMappingHashKey,
+                                             RefCntAutoPtr<IDeviceObject>,
+                                             ResMappingHashKey::Hasher,
+                                             std::equal_to<ResMappingHashKey>,
+                                             STDAllocatorRawMem<HashTableElem>>;
 
-    ThreadingTools::LockFlag m_LockFlag;
+    struct Shard
+    {
+        ThreadingTools::LockFlag       LockFlag;
+        std::unique_ptr<HashTableType> HashTable;
 
-    using HashTableElem = std::pair<const ResMappingHashKey, RefCntAutoPtr<IDeviceObject>>;
-    std::unordered_map<ResMappingHashKey,
-                       RefCntAutoPtr<IDeviceObject>,
-                       ResMappingHashKey::Hasher,
-                       std::equal_to<ResMappingHashKey>,
-                       STDAllocatorRawMem<HashTableElem>>
-        m_HashTable;
+        // Keep locks of different shards in different cache lines
+        Uint8 Padding[64 - sizeof(ThreadingTools::LockFlag) - sizeof(std::unique_ptr<HashTableType>)];
+    };
+
+    static constexpr size_t NumShards = 16;
+
+    void FindResource(const ResMappingHashKey& Key, IDeviceObject** ppResource);
+
+    // The key hash is computed once when the key is constructed
+    Shard& GetShard(const ResMappingHashKey& Key)
+    {
+        return m_Shards[static_cast<size_t>((Uint64{Key.GetHash()} * 0x9E3779B97F4A7C15ull) >> 60) % NumShards];
+    }
+
+    Shard m_Shards[NumShards];
 };
 
 } // namespace Diligent
@@ -30,6 +30,7 @@
 /// \file
 /// Implementation of the Diligent::ShaderBindingTableBase template class
 
+#include <algorithm>
 #include <unordered_map>
 #include <cstring>
 
@@ -108,8 +109,11 @@ public:
         this->m_MissShadersRecord.clear();
         this->m_CallableShadersRecord.clear();
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
-        this->m_pPSO    = nullptr;
+        this->m_RayGenDirty.MarkAll();
+        this->m_MissShadersDirty.MarkAll();
+        this->m_CallableShadersDirty.MarkAll();
+        this->m_HitGroupsDirty.MarkAll();
+        this->m_pPSO = nullptr;
 
         this->m_Desc.pPSO = pPSO;
 
@@ -135,7 +139,7 @@ public:
         this->m_DbgHitGroupBindings.clear();
 #endif
         this->m_HitGroupsRecord.clear();
-        this->m_Changed = true;
+        this->m_HitGroupsDirty.MarkAll();
     }
 
 
@@ -149,7 +153,7 @@ public:
 
         const Uint32 GroupSize = this->m_pDevice->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         std::memcpy(this->m_RayGenShaderRecord.data() + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->m_RayGenDirty.MarkAll();
     }
 
 
@@ -165,7 +169,7 @@ public:
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_MissShadersRecord.data() + Offset, Stride);
         std::memcpy(this->m_MissShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->m_MissShadersDirty.Mark(MissIndex, this->m_MissShadersRecord.size() / Stride);
     }
 
 
@@ -185,7 +189,7 @@ public:
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->m_HitGroupsDirty.Mark(BindingIndex, this->m_HitGroupsRecord.size() / Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
         OnBindHitGroup(nullptr, BindingIndex);
@@ -227,7 +231,7 @@ public:
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
         std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->m_HitGroupsDirty.Mark(Index, this->m_HitGroupsRecord.size() / Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
         VERIFY_EXPR(Index >= Info.FirstContributionToHitGroupIndex && Index <= Info.LastContributionToHitGroupIndex);
@@ -275,7 +279,6 @@ public:
         const size_t Stride     = this->m_ShaderRecordStride;
 
         this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), EndIndex * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
 
         for (Uint32 i = 0; i < GeometryCount; ++i)
         {
@@ -284,6 +287,7 @@ public:
             this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
 
             std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
+            this->m_HitGroupsDirty.Mark(Index, this->m_HitGroupsRecord.size() / Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
             VERIFY_EXPR(Index >= Info.FirstContributionToHitGroupIndex && Index <= Info.LastContributionToHitGroupIndex);
@@ -313,7 +317,6 @@ public:
         const Uint32 GroupSize = this->m_pDevice->GetAdapterInfo().RayTracing.ShaderGroupHandleSize;
         const size_t Stride    = this->m_ShaderRecordStride;
         this->m_HitGroupsRecord.resize(std::max(this->m_HitGroupsRecord.size(), (Info.LastContributionToHitGroupIndex + 1) * Stride), Uint8{EmptyElem});
-        this->m_Changed = true;
 
         for (Uint32 Index = RayOffsetInHitGroupIndex + Info.FirstContributionToHitGroupIndex;
              Index <= Info.LastContributionToHitGroupIndex;
@@ -322,6 +325,7 @@ public:
             const size_t Offset = Index * Stride;
             this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_HitGroupsRecord.data() + Offset, Stride);
             std::memcpy(this->m_HitGroupsRecord.data() + Offset + GroupSize, pData, DataSize);
+            this->m_HitGroupsDirty.Mark(Index, this->m_HitGroupsRecord.size() / Stride);
 
 #ifdef DILIGENT_DEVELOPMENT
             OnBindHitGroup(pTLASImpl, Index);
@@ -344,7 +348,7 @@ public:
 
         this->m_pPSO->CopyShaderHandle(pShaderGroupName, this->m_CallableShadersRecord.data() + Offset, this->m_ShaderRecordStride);
         std::memcpy(this->m_CallableShadersRecord.data() + Offset + GroupSize, pData, DataSize);
-        this->m_Changed = true;
+        this->m_CallableShadersDirty.Mark(CallableIndex, this->m_CallableShadersRecord.size() / this->m_ShaderRecordStride);
     }
 
 
@@ -432,9 +436,25 @@ public:
 #endif // DILIGENT_DEVELOPMENT
     }
 
-    bool                  HasPendingData() const { return this->m_Changed; }
+    bool HasPendingData() const
+    {
+        return m_RayGenDirty.Any() || m_MissShadersDirty.Any() || m_CallableShadersDirty.Any() || m_HitGroupsDirty.Any();
+    }
     const BufferImplType* GetInternalBuffer() const { return this->m_pBuffer; }
 
+    /// Region of the internal buffer that must be updated with the CPU-side shader records
+    struct UploadRange
+    {
+        const void* pData  = nullptr;
+        Uint32      Offset = 0; // Offset in the internal buffer
+        Uint32      Size   = 0;
+    };
+
+    /// Returns the regions of the internal buffer that have been modified since the previous upload.
+    /// The ranges are computed by GetData() and remain valid until the next call to GetData()
+    /// or until any shader record is modified.
+    const std::vector<UploadRange>& GetUploadRanges() const { return m_UploadRanges; }
+
 protected:
     struct BindingTable
     {
@@ -461,11 +481,19 @@ protected:
         const Uint32 CallableShadersOffset = AlignToLarger(HitGroupOffset + m_HitGroupsRecord.size());
         const Uint32 BufSize               = AlignToLarger(CallableShadersOffset + m_CallableShadersRecord.size());
 
+        m_UploadRanges.clear();
+
         // Recreate buffer
         if (m_pBuffer == nullptr || m_pBuffer->GetDesc().uiSizeInBytes < BufSize)
         {
             m_pBuffer = nullptr;
 
+            // The contents of the new buffer are undefined
+            m_RayGenDirty.MarkAll();
+            m_MissShadersDirty.MarkAll();
+            m_CallableShadersDirty.MarkAll();
+            m_HitGroupsDirty.MarkAll();
+
             String     BuffName = String{this->m_Desc.Name} + " - internal buffer";
             BufferDesc BuffDesc;
             BuffDesc.Name          = BuffName.c_str();
@@ -482,41 +510,113 @@ protected:
 
         pSBTBuffer = m_pBuffer;
 
-        if (!m_RayGenShaderRecord.empty())
+        ProcessTable(m_RayGenShaderRecord, RayGenOffset, m_RayGenDirty, m_RayGenUploaded, RaygenShaderBindingTable);
+        ProcessTable(m_MissShadersRecord, MissShaderOffset, m_MissShadersDirty, m_MissShadersUploaded, MissShaderBindingTable);
+        ProcessTable(m_HitGroupsRecord, HitGroupOffset, m_HitGroupsDirty, m_HitGroupsUploaded, HitShaderBindingTable);
+        ProcessTable(m_CallableShadersRecord, CallableShadersOffset, m_CallableShadersDirty, m_CallableShadersUploaded, CallableShaderBindingTable);
+    }
+
+    // Tracks the shader records of a table that have been modified since the last upload
+    struct DirtyRecords
+    {
+        std::vector<Uint32> Indices;
+
+        // The whole table must be uploaded
+        bool All = true;
+
+        void Mark(size_t Index, size_t RecordCount)
         {
-            RaygenShaderBindingTable.pData  = m_Changed ? m_RayGenShaderRecord.data() : nullptr;
-            RaygenShaderBindingTable.Offset = RayGenOffset;
-            RaygenShaderBindingTable.Size   = static_cast<Uint32>(m_RayGenShaderRecord.size());
-            RaygenShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            if (All)
+                return;
+
+            // Once every record may have been modified, tracking individual indices is pointless
+            if (Indices.size() >= RecordCount)
+                MarkAll();
+            else
+                Indices.push_back(static_cast<Uint32>(Index));
         }
 
-        if (!m_MissShadersRecord.empty())
+        void MarkAll()
         {
-            MissShaderBindingTable.pData  = m_Changed ? m_MissShadersRecord.data() : nullptr;
-            MissShaderBindingTable.Offset = MissShaderOffset;
-            MissShaderBindingTable.Size   = static_cast<Uint32>(m_MissShadersRecord.size());
-            MissShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            All = true;
+            Indices.clear();
         }
 
-        if (!m_HitGroupsRecord.empty())
+        bool Any() const { return All || !Indices.empty(); }
+    };
+
+    // Location of the table in the internal buffer at the time of the last upload
+    struct UploadedTable
+    {
+        Uint32 Offset = ~0u;
+        Uint32 Size   = 0;
+    };
+
+private:
+    // Fills the binding table and appends the modified ranges of the table to m_UploadRanges
+    void ProcessTable(const std::vector<Uint8>& Records,
+                      Uint32                    TableOffset,
+                      DirtyRecords&             Dirty,
+                      UploadedTable&            Uploaded,
+                      BindingTable&             Table)
+    {
+        const auto Size   = static_cast<Uint32>(Records.size());
+        const auto Stride = this->m_ShaderRecordStride;
+
+        // Records of a table that has moved or changed its size are all stale
+        if (Uploaded.Offset != TableOffset || Uploaded.Size != Size)
+            Dirty.MarkAll();
+
+        if (Size != 0)
         {
-            HitShaderBindingTable.pData  = m_Changed ? m_HitGroupsRecord.data() : nullptr;
-            HitShaderBindingTable.Offset = HitGroupOffset;
-            HitShaderBindingTable.Size   = static_cast<Uint32>(m_HitGroupsRecord.size());
-            HitShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            Table.pData  = Dirty.Any() ? Records.data() : nullptr;
+            Table.Offset = TableOffset;
+            Table.Size   = Size;
+            Table.Stride = Stride;
         }
 
-        if (!m_CallableShadersRecord.empty())
+        if (Size != 0 && Dirty.Any())
         {
-            CallableShaderBindingTable.pData  = m_Changed ? m_CallableShadersRecord.data() : nullptr;
-            CallableShaderBindingTable.Offset = CallableShadersOffset;
-            CallableShaderBindingTable.Size   = static_cast<Uint32>(m_CallableShadersRecord.size());
-            CallableShaderBindingTable.Stride = this->m_ShaderRecordStride;
+            const auto AddRange = [&](Uint32 FirstRecord, Uint32 RecordCount) {
+                UploadRange Range;
+                Range.pData  = Records.data() + size_t{FirstRecord} * Stride;
+                Range.Offset = TableOffset + FirstRecord * Stride;
+                Range.Size   = RecordCount * Stride;
+                m_UploadRanges.push_back(Range);
+            };
+
+            auto& Indices = Dirty.Indices;
+            std::sort(Indices.begin(), Indices.end());
+            Indices.erase(std::unique(Indices.begin(), Indices.end()), Indices.end());
+
+            // Uploading most of the table as individual ranges is slower than one copy
+            if (Dirty.All || Indices.size() * 2 > Size / Stride)
+            {
+                AddRange(0, Size / Stride);
+            }
+            else
+            {
+                // Merge consecutive records into one range
+                size_t First = 0;
+                for (size_t i = 1; i <= Indices.size(); ++i)
+                {
+                    if (i == Indices.size() || Indices[i] != Indices[i - 1] + 1)
+                    {
+                        AddRange(Indices[First], static_cast<Uint32>(i - First));
+                        First = i;
+                    }
+                }
+            }
         }
 
-        m_Changed = false;
+        Dirty.All = false;
+        Dirty.Indices.clear();
+        Uploaded.Offset = TableOffset;
+        Uploaded.Size   = Size;
     }
 
+protected:
+
 protected:
     std::vector<Uint8> m_RayGenShaderRecord;
     std::vector<Uint8> m_MissShadersRecord;
@@ -528,7 +628,18 @@ protected:
 
     Uint32 m_ShaderRecordSize   = 0;
     Uint32 m_ShaderRecordStride = 0;
-    bool   m_Changed            = true;
+
+    DirtyRecords m_RayGenDirty;
+    DirtyRecords m_MissShadersDirty;
+    DirtyRecords m_CallableShadersDirty;
+    DirtyRecords m_HitGroupsDirty;
+
+    UploadedTable m_RayGenUploaded;
+    UploadedTable m_MissShadersUploaded;
+    UploadedTable m_CallableShadersUploaded;
+    UploadedTable m_HitGroupsUploaded;
+
+    std::vector<UploadRange> m_UploadRanges;
 
 #ifdef DILIGENT_DEVELOPMENT
     static constexpr Uint8 EmptyElem = 0xA7;
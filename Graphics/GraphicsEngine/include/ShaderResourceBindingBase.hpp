@@ -32,6 +32,7 @@
 
 #include <array>
 #include <functional>
+#include <utility>
 
 #include "PrivateConstants.h"
 #include "ShaderResourceBinding.h"
@@ -42,6 +43,7 @@
 #include "GraphicsAccessories.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "FixedLinearAllocator.hpp"
+#include "LiveObjectRegistry.hpp"
 #include "EngineMemory.h"
 
 namespace Diligent
@@ -68,9 +70,12 @@ public:
 
     using TObjectBase = ObjectBase<BaseInterface>;
 
-    /// \param pRefCounters - Reference counters object that controls the lifetime of this SRB.
-    /// \param pPRS         - Pipeline resource signature that this SRB belongs to.
-    ShaderResourceBindingBase(IReferenceCounters* pRefCounters, ResourceSignatureType* pPRS) :
+    /// \param pRefCounters  - Reference counters object that controls the lifetime of this SRB.
+    /// \param pPRS          - Pipeline resource signature that this SRB belongs to.
+    /// \param CacheInitArgs - Additional implementation-specific arguments that are passed to
+    ///                        ResourceSignatureType::InitSRBResourceCache().
+    template <typename... CacheInitArgsType>
+    ShaderResourceBindingBase(IReferenceCounters* pRefCounters, ResourceSignatureType* pPRS, CacheInitArgsType&&... CacheInitArgs) :
         TObjectBase{pRefCounters},
         m_pPRS{pPRS},
         m_ShaderResourceCache{ResourceCacheContentType::SRB}
@@ -105,7 +110,7 @@ public:
             // It is important to construct all objects before initializing them because if an exception is thrown,
             // Destruct() will call destructors for all non-null objects.
 
-            pPRS->InitSRBResourceCache(m_ShaderResourceCache);
+            pPRS->InitSRBResourceCache(m_ShaderResourceCache, std::forward<CacheInitArgsType>(CacheInitArgs)...);
 
             auto& SRBMemAllocator = pPRS->GetSRBMemoryAllocator();
             for (Uint32 s = 0; s < NumShaders; ++s)
@@ -122,6 +127,9 @@ public:
                 const SHADER_RESOURCE_VARIABLE_TYPE VarTypes[] = {SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC};
                 m_pShaderVarMgrs[MgrInd].Initialize(*pPRS, VarDataAllocator, VarTypes, _countof(VarTypes), ShaderType);
             }
+
+            // SRBs have no names of their own and are reported with the name of the signature
+            m_LiveObjectId = pPRS->GetDevice()->GetLiveObjectRegistry().Register(DEVICE_OBJECT_TYPE_SHADER_RESOURCE_BINDING, pPRS->GetDesc().Name);
         }
         catch (...)
         {
@@ -133,6 +141,7 @@ public:
 
     ~ShaderResourceBindingBase()
     {
+        m_pPRS->GetDevice()->GetLiveObjectRegistry().Unregister(m_LiveObjectId);
         Destruct();
     }
 
@@ -192,7 +201,7 @@ public:
             return nullptr;
 
         VERIFY_EXPR(static_cast<Uint32>(MgrInd) < GetNumShaders());
-        return m_pShaderVarMgrs[MgrInd].GetVariable(Name);
+        return GetSignature()->FindSRBVariable(MgrInd, m_pShaderVarMgrs[MgrInd], Name);
     }
 
     /// Implementation of IShaderResourceBinding::GetVariableCount().
@@ -290,6 +299,8 @@ protected:
     ShaderVariableManagerImplType* m_pShaderVarMgrs = nullptr; // [GetNumShaders()]
 
     bool m_bStaticResourcesInitialized = false;
+
+    Uint32 m_LiveObjectId = LiveObjectRegistry::InvalidId;
 };
 
 } // namespace Diligent
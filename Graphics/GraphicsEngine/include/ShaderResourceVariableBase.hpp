@@ -39,6 +39,7 @@
 #include "GraphicsAccessories.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
+#include "ResourceMappingImpl.hpp"
 
 namespace Diligent
 {
@@ -713,7 +714,9 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
         return m_ParentManager.GetVariableIndex(*static_cast<const ThisImplType*>(this));
     }
 
-    void BindResources(IResourceMapping* pResourceMapping, Uint32 Flags)
+    /// Binds resources from the resource mapping. If pMappingImpl is not null, it must be the engine's
+    /// implementation of pResourceMapping; resources are then looked up by precomputed name hashes.
+    void BindResources(IResourceMapping* pResourceMapping, ResourceMappingImpl* pMappingImpl, Uint32 Flags)
     {
         auto* const pThis = static_cast<ThisImplType*>(this);
 
@@ -728,7 +731,10 @@ struct ShaderVariableBase : public ResourceVariableBaseInterface
                 continue;
 
             RefCntAutoPtr<IDeviceObject> pObj;
-            pResourceMapping->GetResource(ResDesc.Name, &pObj, ArrInd);
+            if (pMappingImpl != nullptr)
+                pMappingImpl->GetResource(ResDesc.Name, m_ParentManager.GetResourceNameHash(m_ResIndex), &pObj, ArrInd);
+            else
+                pResourceMapping->GetResource(ResDesc.Name, &pObj, ArrInd);
             if (pObj)
             {
                 pThis->BindResource(BindResourceInfo{ArrInd, pObj});
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the Diligent::ShaderVariableNameIndex class
+
+#include <vector>
+#include <cstring>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Common/interface/HashUtils.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Maps shader variable names to variable indices.
+
+/// The index is an open-addressing hash table with linear probing that is built once from
+/// the variables of a shader variable manager. A pipeline resource signature keeps one index for every
+/// shader stage and shares it between all shader resource bindings it creates, since their variable
+/// managers contain the same variables in the same order. Variable names are not copied and must
+/// outlive the index; they are owned by the signature description.
+class ShaderVariableNameIndex
+{
+public:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    /// \param [in] NumVariables - The number of variables.
+    /// \param [in] GetName      - Function that returns the name of the variable with the given index.
+    template <typename GetNameType>
+    ShaderVariableNameIndex(Uint32 NumVariables, GetNameType GetName)
+    {
+        // Keep the load factor at or below 1/2 so that probe sequences stay short
+        size_t TableSize = 4;
+        while (TableSize < size_t{NumVariables} * 2)
+            TableSize *= 2;
+        m_Table.resize(TableSize);
+        m_Mask = TableSize - 1;
+
+        for (Uint32 i = 0; i < NumVariables; ++i)
+        {
+            const char* Name = GetName(i);
+            VERIFY_EXPR(Name != nullptr);
+
+            const auto Hash = CStringHash<Char>{}(Name);
+            for (size_t Slot = Hash & m_Mask;; Slot = (Slot + 1) & m_Mask)
+            {
+                auto& Entry = m_Table[Slot];
+                if (Entry.Name == nullptr)
+                {
+                    Entry.Hash  = Hash;
+                    Entry.Name  = Name;
+                    Entry.Index = i;
+                    break;
+                }
+                // Variable names are unique within a shader stage, but keep the first
+                // variable if they are not, which matches the linear search.
+                if (Entry.Hash == Hash && strcmp(Entry.Name, Name) == 0)
+                    break;
+            }
+        }
+    }
+
+    /// Returns the index of the variable with the given name, or InvalidIndex if there is no such variable.
+    Uint32 Find(const char* Name) const
+    {
+        const auto Hash = CStringHash<Char>{}(Name);
+        for (size_t Slot = Hash & m_Mask;; Slot = (Slot + 1) & m_Mask)
+        {
+            const auto& Entry = m_Table[Slot];
+            if (Entry.Name == nullptr)
+                return InvalidIndex;
+            if (Entry.Hash == Hash && strcmp(Entry.Name, Name) == 0)
+                return Entry.Index;
+        }
+    }
+
+private:
+    struct Entry
+    {
+        size_t      Hash  = 0;
+        const char* Name  = nullptr;
+        Uint32      Index = InvalidIndex;
+    };
+    // The table always has empty slots, so every probe sequence terminates
+    std::vector<Entry> m_Table;
+
+    size_t m_Mask = 0;
+};
+
+} // namespace Diligent
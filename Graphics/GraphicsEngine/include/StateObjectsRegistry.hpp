@@ -30,9 +30,13 @@
 /// \file
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
-#include "DeviceObject.h"
 #include <unordered_map>
+#include <memory>
+
+#include "DeviceObject.h"
 #include "STDAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "LockHelper.hpp"
 
 namespace Diligent
 {
@@ -58,6 +62,11 @@ namespace Diligent
 /// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
 /// If after that this thread locks the registry first, it will be waiting for the object to unlock in
 /// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+/// \remarks
+/// The registry is split into NumShards independently locked shards selected by the
+/// description hash, so that threads looking up different objects rarely contend for
+/// the same lock. The hash is computed once per call and is stored with the description,
+/// so it is never recomputed when the shard's hash map is searched or rehashed.
 template <typename ResourceDescType>
 class StateObjectsRegistry
 {
@@ -65,11 +74,18 @@ public:
     /// Number of outstanding deleted objects to purge the registry.
     static constexpr int DeletedObjectsToPurge = 32;
 
+    /// Number of independently locked shards.
+    static constexpr size_t NumShards = 16;
+
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
         m_NumDeletedObjects{0},
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
         m_RegistryName{RegistryName}
-    {}
+    {
+        for (auto& Shard : m_Shards)
+        {
+            Shard.DescToObjHashMap.reset(new HashMapType{STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")});
+        }
+    }
 
     ~StateObjectsRegistry()
     {
@@ -79,7 +95,10 @@ public:
         // may only be expired references in the registry. After we
         // purge it, the registry must be empty.
         Purge();
-        VERIFY(m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty");
+#ifdef DILIGENT_DEBUG
+        for (const auto& Shard : m_Shards)
+            VERIFY(Shard.DescToObjHashMap->empty(), "DescToObjHashMap is not empty");
+#endif
     }
 
     /// Adds a new object to the registry
@@ -95,19 +114,25 @@ public:
     /// cost to it.
     void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
     {
-        ThreadingTools::LockHelper Lock(m_LockFlag);
-
         // If the number of outstanding deleted objects reached the threshold value,
-        // purge the registry. Since we have exclusive access now, it is safe
-        // to do.
-        if (m_NumDeletedObjects >= DeletedObjectsToPurge)
+        // purge the registry. Only one thread resets the counter and performs the purge.
+        auto NumDeletedObjects = m_NumDeletedObjects.load();
+        while (NumDeletedObjects >= DeletedObjectsToPurge)
         {
-            Purge();
-            m_NumDeletedObjects = 0;
+            if (m_NumDeletedObjects.compare_exchange_weak(NumDeletedObjects, 0))
+            {
+                Purge();
+                break;
+            }
         }
 
+        const DescKey Key{ObjectDesc};
+        auto&         Shard = GetShard(Key.Hash);
+
+        ThreadingTools::LockHelper Lock(Shard.LockFlag);
+
         // Try to construct the new element in place
-        auto Elems = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
+        auto Elems = Shard.DescToObjHashMap->emplace(Key, Diligent::RefCntWeakPtr<IDeviceObject>(pObject));
         // It is theorertically possible that the same object can be found
         // in the registry. This might happen if two threads try to create
         // the same object at the same time. They both will not find the
@@ -123,8 +148,8 @@ public:
         // object.
         if (!Elems.second)
         {
-            VERIFY(Elems.first->first == ObjectDesc, "Incorrect object description");
-            LOG_WARNING_MESSAGE("Object named '", Elems.first->first.Name,
+            VERIFY(Elems.first->first.Desc == ObjectDesc, "Incorrect object description");
+            LOG_WARNING_MESSAGE("Object named '", Elems.first->first.Desc.Name,
                                 "' with the same description already exists in the registry."
                                 "Replacing with the new object named '",
                                 ObjectDesc.Name ? ObjectDesc.Name : "", "'.");
@@ -137,10 +162,14 @@ public:
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
         *ppObject = nullptr;
-        ThreadingTools::LockHelper Lock(m_LockFlag);
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
+        const DescKey Key{Desc};
+        auto&         Shard = GetShard(Key.Hash);
+
+        ThreadingTools::LockHelper Lock(Shard.LockFlag);
+
+        auto It = Shard.DescToObjHashMap->find(Key);
+        if (It != Shard.DescToObjHashMap->end())
         {
             // Try to obtain strong reference to the object.
             // This is an atomic operation and we either get
@@ -155,7 +184,7 @@ public:
             else
             {
                 // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
+                Shard.DescToObjHashMap->erase(It);
                 Atomics::AtomicDecrement(m_NumDeletedObjects);
             }
         }
@@ -165,26 +194,32 @@ public:
     void Purge()
     {
         Uint32 NumPurgedObjects = 0;
-        auto   It               = m_DescToObjHashMap.begin();
-        while (It != m_DescToObjHashMap.end())
+        for (auto& Shard : m_Shards)
         {
-            auto NextIt = It;
-            ++NextIt;
-            // Note that IsValid() is not a thread-safe function in the sense that it
-            // can give false positive results. The only thread-safe way to check if the
-            // object is alive is to lock the weak pointer, but that requires thread
-            // synchronization. We will immediately unlock the pointer anyway, so we
-            // want to detect 100% expired pointers. IsValid() does provide that information
-            // because once a weak pointer becomes invalid, it will be invalid
-            // until it is destroyed. It is not a problem if we miss an expired weak
-            // pointer as it will definitiely be removed next time.
-            if (!It->second.IsValid())
+            ThreadingTools::LockHelper Lock(Shard.LockFlag);
+
+            auto& HashMap = *Shard.DescToObjHashMap;
+            auto  It      = HashMap.begin();
+            while (It != HashMap.end())
             {
-                m_DescToObjHashMap.erase(It);
-                ++NumPurgedObjects;
-            }
+                auto NextIt = It;
+                ++NextIt;
+                // Note that IsValid() is not a thread-safe function in the sense that it
+                // can give false positive results. The only thread-safe way to check if the
+                // object is alive is to lock the weak pointer, but that requires thread
+                // synchronization. We will immediately unlock the pointer anyway, so we
+                // want to detect 100% expired pointers. IsValid() does provide that information
+                // because once a weak pointer becomes invalid, it will be invalid
+                // until it is destroyed. It is not a problem if we miss an expired weak
+                // pointer as it will definitiely be removed next time.
+                if (!It->second.IsValid())
+                {
+                    HashMap.erase(It);
+                    ++NumPurgedObjects;
+                }
 
-            It = NextIt;
+                It = NextIt;
+            }
         }
         LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
     }
@@ -198,15 +233,57 @@ public:
     }
 
 private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    ThreadingTools::LockFlag m_LockFlag;
+    /// Resource description with the precomputed hash
+    struct DescKey
+    {
+        explicit DescKey(const ResourceDescType& _Desc) :
+            Desc{_Desc},
+            Hash{std::hash<ResourceDescType>{}(_Desc)}
+        {}
 
-    /// Nmber of outstanding deleted objects that have not been purged
-    Atomics::AtomicLong m_NumDeletedObjects;
+        bool operator==(const DescKey& RHS) const
+        {
+            return Hash == RHS.Hash && Desc == RHS.Desc;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const DescKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+
+        const ResourceDescType Desc;
+        const size_t           Hash;
+    };
 
     /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    typedef std::pair<const DescKey, RefCntWeakPtr<IDeviceObject>>                                                                                       HashMapElem;
+    typedef std::unordered_map<DescKey, RefCntWeakPtr<IDeviceObject>, typename DescKey::Hasher, std::equal_to<DescKey>, STDAllocatorRawMem<HashMapElem>> HashMapType;
+
+    struct Shard
+    {
+        /// Lock flag to protect the DescToObjHashMap
+        ThreadingTools::LockFlag LockFlag;
+
+        std::unique_ptr<HashMapType> DescToObjHashMap;
+
+        // Keep locks of different shards in different cache lines
+        Uint8 Padding[64 - sizeof(ThreadingTools::LockFlag) - sizeof(std::unique_ptr<HashMapType>)];
+    };
+
+    Shard& GetShard(size_t Hash)
+    {
+        // Description hashes are combinations of few small values, so mix all bits
+        // before taking the top ones (Fibonacci hashing).
+        return m_Shards[static_cast<size_t>((Uint64{Hash} * 0x9E3779B97F4A7C15ull) >> 60) % NumShards];
+    }
+
+    Shard m_Shards[NumShards];
+
+    /// Nmber of outstanding deleted objects that have not been purged
+    Atomics::AtomicLong m_NumDeletedObjects;
 
     /// Registry name used for debug output
     const String m_RegistryName;
@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::TextureBase template class
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "Texture.h"
 #include "GraphicsTypes.h"
@@ -38,6 +40,7 @@
 #include "GraphicsAccessories.hpp"
 #include "STDAllocator.hpp"
 #include "FormatString.hpp"
+#include "RenderDeviceBase.hpp"
 
 namespace Diligent
 {
@@ -140,13 +143,31 @@ public:
         if ((this->m_Desc.BindFlags & BIND_INPUT_ATTACHMENT) != 0)
             this->m_Desc.BindFlags |= BIND_SHADER_RESOURCE;
 
+        if ((this->m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0 && !pDevice->GetFeatures().SparseResources)
+        {
+            LOG_ERROR_AND_THROW("Texture '", (this->m_Desc.Name ? this->m_Desc.Name : ""),
+                                "': MISC_TEXTURE_FLAG_SPARSE requires SparseResources device feature.");
+        }
+
         // Validate correctness of texture description
         ValidateTextureDesc(this->m_Desc);
+
+        // Memory of sparse textures is bound to memory objects that are not tracked by the texture
+        if ((this->m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) == 0)
+        {
+            Uint64 Size = 0;
+            for (Uint32 Mip = 0; Mip < this->m_Desc.MipLevels; ++Mip)
+                Size += GetMipLevelProperties(this->m_Desc, Mip).MipSize;
+            if (this->m_Desc.Type != RESOURCE_DIM_TEX_3D)
+                Size *= this->m_Desc.ArraySize;
+            this->SetLiveObjectSize(Size * this->m_Desc.SampleCount);
+        }
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Texture, TDeviceObjectBase)
 
-    /// Implementation of ITexture::CreateView(); calls CreateViewInternal() virtual function that
+    /// Implementation of ITexture::CreateView(); returns a cached view if a view with the
+    /// same description is still alive, and otherwise calls CreateViewInternal() virtual function that
     /// creates texture view for the specific engine implementation.
     virtual void DILIGENT_CALL_TYPE CreateView(const struct TextureViewDesc& ViewDesc, ITextureView** ppView) override
     {
@@ -162,7 +183,36 @@ public:
         else
             UNEXPECTED("Unexpected texture view type.");
 
+        DEV_CHECK_ERR(ppView != nullptr, "Null pointer provided");
+        DEV_CHECK_ERR(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+        // The name does not affect the view and the pointer may not outlive the call
+        TextureViewDesc Key = ViewDesc;
+        Key.Name            = nullptr;
+
+        {
+            std::lock_guard<std::mutex> Lock{m_ViewCacheMtx};
+
+            auto It = m_ViewCache.find(Key);
+            if (It != m_ViewCache.end())
+            {
+                if (auto pView = It->second.Lock())
+                {
+                    *ppView = pView.Detach();
+                    return;
+                }
+            }
+        }
+
         CreateViewInternal(ViewDesc, ppView, false);
+
+        if (*ppView != nullptr)
+        {
+            std::lock_guard<std::mutex> Lock{m_ViewCacheMtx};
+
+            // Entries of released views are overwritten by the new views with the same description
+            m_ViewCache[Key] = RefCntWeakPtr<ITextureView>{*ppView};
+        }
     }
 
     /// Creates default texture views.
@@ -257,6 +307,14 @@ public:
         return this->m_State;
     }
 
+    /// Implementation of ITexture::GetSparseProperties().
+    virtual const SparseTextureProperties& DILIGENT_CALL_TYPE GetSparseProperties() const override final
+    {
+        DEV_CHECK_ERR((this->m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0,
+                      "Texture '", this->m_Desc.Name, "' is not a sparse texture.");
+        return m_SparseProps;
+    }
+
     bool IsInKnownState() const
     {
         return this->m_State != RESOURCE_STATE_UNKNOWN;
@@ -308,6 +366,23 @@ protected:
     std::unique_ptr<TextureViewImplType, STDDeleter<TextureViewImplType, TexViewObjAllocatorType>> m_pDefaultUAV;
 
     RESOURCE_STATE m_State = RESOURCE_STATE_UNKNOWN;
+
+    struct ViewDescEqual
+    {
+        bool operator()(const TextureViewDesc& LHS, const TextureViewDesc& RHS) const
+        {
+            // TextureViewDesc::operator== ignores the flags
+            return LHS == RHS && LHS.Flags == RHS.Flags;
+        }
+    };
+
+    /// Views created by CreateView(). The views hold strong references to the texture,
+    /// so the cache holds weak references to avoid reference cycles.
+    std::unordered_map<TextureViewDesc, RefCntWeakPtr<ITextureView>, std::hash<TextureViewDesc>, ViewDescEqual> m_ViewCache;
+    std::mutex                                                                                                   m_ViewCacheMtx;
+
+    /// Tile layout of a sparse texture; initialized by the backend implementation.
+    SparseTextureProperties m_SparseProps;
 };
 
 } // namespace Diligent
@@ -121,6 +121,12 @@ public:
         return m_pSampler.RawPtr<SamplerType>();
     }
 
+    /// Implementation of ITextureView::GetBindlessIndex()
+    virtual Uint32 DILIGENT_CALL_TYPE GetBindlessIndex() const override final
+    {
+        return m_BindlessIndex;
+    }
+
 protected:
     /// Strong reference to the sampler
     RefCntAutoPtr<ISampler> m_pSampler;
@@ -131,6 +137,9 @@ protected:
     /// Strong reference to the texture. Used for non-default views
     /// to keep the texture alive
     RefCntAutoPtr<ITexture> m_spTexture;
+
+    /// Index of the view in the bindless descriptor heap, set by the backend
+    Uint32 m_BindlessIndex = INVALID_BINDLESS_INDEX;
 };
 
 } // namespace Diligent
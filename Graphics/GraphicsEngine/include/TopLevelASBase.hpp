@@ -31,6 +31,7 @@
 /// Implementation of the Diligent::TopLevelASBase template class
 
 #include <unordered_map>
+#include <vector>
 #include <atomic>
 
 #include "TopLevelAS.h"
@@ -64,6 +65,9 @@ private:
 
     struct InstanceDesc
     {
+        // Optional instance name allocated in m_StringPool.
+        // Unnamed instances are only addressed by their index.
+        const char*                          Name                        = nullptr;
         Uint32                               ContributionToHitGroupIndex = 0;
         Uint32                               InstanceIndex               = 0;
         RefCntAutoPtr<BottomLevelASImplType> pBLAS;
@@ -109,21 +113,26 @@ public:
             ClearInstanceData();
 
             size_t StringPoolSize = 0;
+            size_t NumNamedInsts  = 0;
             for (Uint32 i = 0; i < InstanceCount; ++i)
             {
-                VERIFY_EXPR(pInstances[i].InstanceName != nullptr);
-                StringPoolSize += StringPool::GetRequiredReserveSize(pInstances[i].InstanceName);
+                if (pInstances[i].InstanceName != nullptr)
+                {
+                    StringPoolSize += StringPool::GetRequiredReserveSize(pInstances[i].InstanceName);
+                    ++NumNamedInsts;
+                }
             }
 
             this->m_StringPool.Reserve(StringPoolSize, GetRawAllocator());
+            this->m_Instances.resize(InstanceCount);
+            this->m_NameToIndex.reserve(NumNamedInsts);
 
             Uint32 InstanceOffset = BaseContributionToHitGroupIndex;
 
             for (Uint32 i = 0; i < InstanceCount; ++i)
             {
-                const auto&  Inst     = pInstances[i];
-                const char*  NameCopy = this->m_StringPool.CopyString(Inst.InstanceName);
-                InstanceDesc Desc     = {};
+                const auto& Inst = pInstances[i];
+                auto&       Desc = this->m_Instances[i];
 
                 Desc.pBLAS                       = ValidatedCast<BottomLevelASImplType>(Inst.pBLAS);
                 Desc.ContributionToHitGroupIndex = Inst.ContributionToHitGroupIndex;
@@ -133,9 +142,13 @@ public:
 #ifdef DILIGENT_DEVELOPMENT
                 Desc.dvpVersion = Desc.pBLAS->DvpGetVersion();
 #endif
-                bool IsUniqueName = this->m_Instances.emplace(NameCopy, Desc).second;
-                if (!IsUniqueName)
-                    LOG_ERROR_AND_THROW("Instance name must be unique!");
+                if (Inst.InstanceName != nullptr)
+                {
+                    Desc.Name         = this->m_StringPool.CopyString(Inst.InstanceName);
+                    bool IsUniqueName = this->m_NameToIndex.emplace(Desc.Name, i).second;
+                    if (!IsUniqueName)
+                        LOG_ERROR_AND_THROW("Instance name must be unique!");
+                }
             }
 
             VERIFY_EXPR(this->m_StringPool.GetRemainingSize() == 0);
@@ -177,16 +190,16 @@ public:
 
         for (Uint32 i = 0; i < InstanceCount; ++i)
         {
-            const auto& Inst = pInstances[i];
-            auto        Iter = this->m_Instances.find(Inst.InstanceName);
+            const auto& Inst  = pInstances[i];
+            const auto  Index = GetBuildInstanceIndex(Inst, i);
 
-            if (Iter == this->m_Instances.end())
+            if (Index == INVALID_INDEX)
             {
-                UNEXPECTED("Failed to find instance with name '", Inst.InstanceName, "' in instances from the previous build");
+                UNEXPECTED("Failed to find instance ", i, " in instances from the previous build");
                 return false;
             }
 
-            auto&      Desc      = Iter->second;
+            auto&      Desc      = this->m_Instances[Index];
             const auto PrevIndex = Desc.ContributionToHitGroupIndex;
             const auto pPrevBLAS = Desc.pBLAS;
 
@@ -220,17 +233,50 @@ public:
         return true;
     }
 
+    /// Sets the build parameters of the TLAS whose instances were written to the instance buffer
+    /// by the GPU (see BuildTLASAttribs::UseGPUInstanceData). Such instances are not tracked.
+    void SetGPUInstanceData(const Uint32 InstanceCount,
+                            const Uint32 HitGroupStride) noexcept
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        const bool Changed = !this->m_GPUInstanceData || this->m_BuildInfo.InstanceCount != InstanceCount || this->m_BuildInfo.HitGroupStride != HitGroupStride;
+#endif
+        ClearInstanceData();
+
+        this->m_BuildInfo.HitGroupStride = HitGroupStride;
+        this->m_BuildInfo.BindingMode    = HIT_GROUP_BINDING_MODE_USER_DEFINED;
+        this->m_BuildInfo.InstanceCount  = InstanceCount;
+        this->m_GPUInstanceData          = true;
+
+#ifdef DILIGENT_DEVELOPMENT
+        if (Changed)
+            this->m_DvpVersion.fetch_add(1);
+#endif
+    }
+
+    /// Returns true if the TLAS was built from the instances written by the GPU.
+    bool UsesGPUInstanceData() const
+    {
+        return this->m_GPUInstanceData;
+    }
+
     void CopyInstancceData(const TopLevelASBase& Src) noexcept
     {
         ClearInstanceData();
 
         this->m_StringPool.Reserve(Src.m_StringPool.GetReservedSize(), GetRawAllocator());
-        this->m_BuildInfo = Src.m_BuildInfo;
+        this->m_BuildInfo       = Src.m_BuildInfo;
+        this->m_GPUInstanceData = Src.m_GPUInstanceData;
 
-        for (auto& SrcInst : Src.m_Instances)
+        this->m_Instances = Src.m_Instances;
+        this->m_NameToIndex.reserve(Src.m_NameToIndex.size());
+        for (auto& Inst : this->m_Instances)
         {
-            const char* NameCopy = this->m_StringPool.CopyString(SrcInst.first.GetStr());
-            this->m_Instances.emplace(NameCopy, SrcInst.second);
+            if (Inst.Name != nullptr)
+            {
+                Inst.Name = this->m_StringPool.CopyString(Inst.Name);
+                this->m_NameToIndex.emplace(Inst.Name, Inst.InstanceIndex);
+            }
         }
 
         VERIFY_EXPR(this->m_StringPool.GetRemainingSize() == 0);
@@ -245,24 +291,35 @@ public:
     {
         VERIFY_EXPR(Name != nullptr && Name[0] != '\0');
 
-        TLASInstanceDesc Result = {};
-
-        auto Iter = this->m_Instances.find(Name);
-        if (Iter != this->m_Instances.end())
+        auto Iter = this->m_NameToIndex.find(Name);
+        if (Iter == this->m_NameToIndex.end())
         {
-            const auto& Inst                   = Iter->second;
-            Result.ContributionToHitGroupIndex = Inst.ContributionToHitGroupIndex;
-            Result.InstanceIndex               = Inst.InstanceIndex;
-            Result.pBLAS                       = Inst.pBLAS.template RawPtr<IBottomLevelAS>();
+            LOG_ERROR_MESSAGE("Can't find instance with the specified name ('", Name, "')");
+            return GetInvalidInstanceDesc();
         }
-        else
+
+        return GetInstanceDescImpl(this->m_Instances[Iter->second]);
+    }
+
+    /// Implementation of ITopLevelAS::GetInstanceDescByIndex().
+    virtual TLASInstanceDesc DILIGENT_CALL_TYPE GetInstanceDescByIndex(Uint32 Index) const override final
+    {
+        if (Index >= this->m_Instances.size())
         {
-            Result.ContributionToHitGroupIndex = INVALID_INDEX;
-            Result.InstanceIndex               = INVALID_INDEX;
-            LOG_ERROR_MESSAGE("Can't find instance with the specified name ('", Name, "')");
+            LOG_ERROR_MESSAGE("Instance index (", Index, ") is out of range: the TLAS contains ", this->m_Instances.size(), " instance(s)");
+            return GetInvalidInstanceDesc();
         }
 
-        return Result;
+        return GetInstanceDescImpl(this->m_Instances[Index]);
+    }
+
+    /// Returns the description of the instance that pInstances[BuildIndex] passed to the last
+    /// SetInstanceData() or UpdateInstances() refers to: the instance with the given name,
+    /// or the instance with index BuildIndex if the name is null.
+    TLASInstanceDesc GetBuildInstanceDesc(const TLASBuildInstanceData& Inst, Uint32 BuildIndex) const
+    {
+        const auto Index = GetBuildInstanceIndex(Inst, BuildIndex);
+        return Index != INVALID_INDEX ? GetInstanceDescImpl(this->m_Instances[Index]) : GetInvalidInstanceDesc();
     }
 
     /// Implementation of ITopLevelAS::GetBuildInfo().
@@ -308,27 +365,27 @@ public:
     {
         bool result = true;
 
-        if (this->m_Instances.empty())
+        if (this->m_Instances.empty() && !this->m_GPUInstanceData)
         {
             LOG_ERROR_MESSAGE("TLAS with name ('", this->m_Desc.Name, "') doesn't have instances, use IDeviceContext::BuildTLAS() or IDeviceContext::CopyTLAS() to initialize TLAS content");
             result = false;
         }
 
         // Validate instances
-        for (const auto& NameAndInst : this->m_Instances)
+        for (const auto& Inst : this->m_Instances)
         {
-            const InstanceDesc& Inst = NameAndInst.second;
+            const char* InstName = Inst.Name != nullptr ? Inst.Name : "<unnamed>";
 
             if (Inst.dvpVersion != Inst.pBLAS->DvpGetVersion())
             {
-                LOG_ERROR_MESSAGE("Instance with name '", NameAndInst.first.GetStr(), "' contains BLAS with name '", Inst.pBLAS->GetDesc().Name,
+                LOG_ERROR_MESSAGE("Instance ", Inst.InstanceIndex, " ('", InstName, "') contains BLAS with name '", Inst.pBLAS->GetDesc().Name,
                                   "' that was changed after TLAS build, you must rebuild TLAS");
                 result = false;
             }
 
             if (Inst.pBLAS->IsInKnownState() && Inst.pBLAS->GetState() != RESOURCE_STATE_BUILD_AS_READ)
             {
-                LOG_ERROR_MESSAGE("Instance with name '", NameAndInst.first.GetStr(), "' contains BLAS with name '", Inst.pBLAS->GetDesc().Name,
+                LOG_ERROR_MESSAGE("Instance ", Inst.InstanceIndex, " ('", InstName, "') contains BLAS with name '", Inst.pBLAS->GetDesc().Name,
                                   "' that must be in BUILD_AS_READ state, but current state is ",
                                   GetResourceStateFlagString(Inst.pBLAS->GetState()));
                 result = false;
@@ -347,7 +404,9 @@ private:
     void ClearInstanceData()
     {
         this->m_Instances.clear();
+        this->m_NameToIndex.clear();
         this->m_StringPool.Clear();
+        this->m_GPUInstanceData = false;
 
         this->m_BuildInfo.BindingMode                      = HIT_GROUP_BINDING_MODE_LAST;
         this->m_BuildInfo.HitGroupStride                   = 0;
@@ -355,6 +414,33 @@ private:
         this->m_BuildInfo.LastContributionToHitGroupIndex  = INVALID_INDEX;
     }
 
+    // Named instances are looked up by name, unnamed instances are addressed by their index in the build data.
+    Uint32 GetBuildInstanceIndex(const TLASBuildInstanceData& Inst, Uint32 BuildIndex) const
+    {
+        if (Inst.InstanceName == nullptr)
+            return BuildIndex < this->m_Instances.size() ? BuildIndex : INVALID_INDEX;
+
+        auto Iter = this->m_NameToIndex.find(Inst.InstanceName);
+        return Iter != this->m_NameToIndex.end() ? Iter->second : INVALID_INDEX;
+    }
+
+    static TLASInstanceDesc GetInstanceDescImpl(const InstanceDesc& Inst)
+    {
+        TLASInstanceDesc Result;
+        Result.ContributionToHitGroupIndex = Inst.ContributionToHitGroupIndex;
+        Result.InstanceIndex               = Inst.InstanceIndex;
+        Result.pBLAS                       = Inst.pBLAS.template RawPtr<IBottomLevelAS>();
+        return Result;
+    }
+
+    static TLASInstanceDesc GetInvalidInstanceDesc()
+    {
+        TLASInstanceDesc Result;
+        Result.ContributionToHitGroupIndex = INVALID_INDEX;
+        Result.InstanceIndex               = INVALID_INDEX;
+        return Result;
+    }
+
     static void CalculateHitGroupIndex(InstanceDesc& Desc, Uint32& InstanceOffset, const Uint32 HitGroupStride, const HIT_GROUP_BINDING_MODE BindingMode)
     {
         static_assert(HIT_GROUP_BINDING_MODE_LAST == HIT_GROUP_BINDING_MODE_USER_DEFINED, "Please update the switch below to handle the new shader binding mode");
@@ -387,10 +473,17 @@ protected:
     TLASBuildInfo      m_BuildInfo;
     ScratchBufferSizes m_ScratchSize;
 
-    std::unordered_map<HashMapStringKey, InstanceDesc, HashMapStringKey::Hasher> m_Instances;
+    // Instances indexed by TLASInstanceDesc::InstanceIndex
+    std::vector<InstanceDesc> m_Instances;
+
+    // Indices of the named instances
+    std::unordered_map<HashMapStringKey, Uint32, HashMapStringKey::Hasher> m_NameToIndex;
 
     StringPool m_StringPool;
 
+    // True if the instances were written to the instance buffer by the GPU and are not tracked
+    bool m_GPUInstanceData = false;
+
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Uint32> m_DvpVersion{0};
 #endif
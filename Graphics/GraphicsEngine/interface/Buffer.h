@@ -70,6 +70,27 @@ DILIGENT_TYPED_ENUM(BUFFER_MODE, Uint8)
     BUFFER_MODE_NUM_MODES
 };
 
+/// Miscellaneous buffer flags
+
+/// The enumeration is used by BufferDesc to describe misc buffer flags
+DILIGENT_TYPED_ENUM(MISC_BUFFER_FLAGS, Uint8)
+{
+    MISC_BUFFER_FLAG_NONE   = 0x00,
+
+    /// The buffer is sparse (reserved). Only the virtual address range is allocated
+    /// when the buffer is created; memory is mapped to the blocks of the buffer
+    /// by IDeviceContext::UpdateTileMappings(). The block size is returned by IBuffer::GetSparseBlockSize().
+    /// Sparse buffers must use USAGE_DEFAULT and require SparseResources device feature.
+    MISC_BUFFER_FLAG_SPARSE = 0x01,
+
+    /// The GPU virtual address of the buffer can be queried by IBuffer::GetDeviceAddress()
+    /// and used by shaders to access the buffer data without binding it.
+    /// The flag requires BufferDeviceAddress device feature and can't be used
+    /// with USAGE_DYNAMIC and USAGE_STAGING buffers.
+    MISC_BUFFER_FLAG_DEVICE_ADDRESS = 0x02
+};
+DEFINE_FLAG_ENUM_OPERATORS(MISC_BUFFER_FLAGS)
+
 /// Buffer description
 struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 
@@ -114,6 +135,12 @@ struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     ///             will actually be used. Do not set unncessary bits as this will result in extra overhead.
     Uint64 ImmediateContextMask     DEFAULT_INITIALIZER(1);
 
+    /// Miscellaneous flags, see Diligent::MISC_BUFFER_FLAGS for details.
+    MISC_BUFFER_FLAGS MiscFlags     DEFAULT_INITIALIZER(MISC_BUFFER_FLAG_NONE);
+
+    /// Memory priority hint, see Diligent::MEMORY_PRIORITY.
+    MEMORY_PRIORITY MemoryPriority  DEFAULT_INITIALIZER(MEMORY_PRIORITY_DEFAULT);
+
 
 #if DILIGENT_CPP_INTERFACE
     // We have to explicitly define constructors because otherwise the following initialization fails on Apple's clang:
@@ -127,14 +154,16 @@ struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                CPU_ACCESS_FLAGS _CPUAccessFlags       = BufferDesc{}.CPUAccessFlags,
                BUFFER_MODE      _Mode                 = BufferDesc{}.Mode,
                Uint32           _ElementByteStride    = BufferDesc{}.ElementByteStride,
-               Uint64           _ImmediateContextMask = BufferDesc{}.ImmediateContextMask) noexcept : 
+               Uint64           _ImmediateContextMask = BufferDesc{}.ImmediateContextMask,
+               MISC_BUFFER_FLAGS _MiscFlags           = BufferDesc{}.MiscFlags) noexcept : 
         uiSizeInBytes        {_uiSizeInBytes    },
         BindFlags            {_BindFlags        },
         Usage                {_Usage            },
         CPUAccessFlags       {_CPUAccessFlags   },
         Mode                 {_Mode             },
         ElementByteStride    {_ElementByteStride},
-        ImmediateContextMask {_ImmediateContextMask}
+        ImmediateContextMask {_ImmediateContextMask},
+        MiscFlags            {_MiscFlags        }
     {
     }
 
@@ -157,7 +186,9 @@ struct BufferDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                 CPUAccessFlags       == RHS.CPUAccessFlags    &&
                 Mode                 == RHS.Mode              &&
                 ElementByteStride    == RHS.ElementByteStride && 
-                ImmediateContextMask == RHS.ImmediateContextMask;
+                ImmediateContextMask == RHS.ImmediateContextMask &&
+                MiscFlags            == RHS.MiscFlags         &&
+                MemoryPriority       == RHS.MemoryPriority;
     }
 #endif
 };
@@ -306,11 +337,31 @@ DILIGENT_BEGIN_INTERFACE(IBuffer, IDeviceObject)
     ///
     /// \note   This method must never be used for USAGE_DYNAMIC buffers.
     ///
-    ///         When a mapped buffer is unmapped it is automatically invalidated by
+    ///         When a buffer is mapped for reading it is automatically invalidated by
     ///         the engine if necessary.
     VIRTUAL void METHOD(InvalidateMappedRange)(THIS_
                                                Uint32 StartOffset,
                                                Uint32 Size) PURE;
+
+
+    /// Returns the size, in bytes, of a sparse buffer block.
+
+    /// \remarks The buffer must have been created with Diligent::MISC_BUFFER_FLAG_SPARSE flag.
+    ///          Offsets and sizes of the ranges mapped by IDeviceContext::UpdateTileMappings()
+    ///          are expressed in blocks of this size.
+    VIRTUAL Uint32 METHOD(GetSparseBlockSize)(THIS) CONST PURE;
+
+
+    /// Returns the GPU virtual address of the buffer.
+
+    /// \remarks The buffer must have been created with Diligent::MISC_BUFFER_FLAG_DEVICE_ADDRESS flag.
+    ///          The address remains valid for the lifetime of the buffer and may be written
+    ///          to other buffers to let shaders access the buffer data through a pointer
+    ///          (e.g. buffer_reference in GLSL or vk::RawBufferLoad in HLSL).
+    ///
+    ///          Vulkan backend:     returns vkGetBufferDeviceAddress().
+    ///          Direct3D12 backend: returns ID3D12Resource::GetGPUVirtualAddress().
+    VIRTUAL Uint64 METHOD(GetDeviceAddress)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -330,6 +381,8 @@ DILIGENT_END_INTERFACE
 #    define IBuffer_GetMemoryProperties(This)        CALL_IFACE_METHOD(Buffer, GetMemoryProperties,   This)
 #    define IBuffer_FlushMappedRange(This, ...)      CALL_IFACE_METHOD(Buffer, FlushMappedRange,      This, __VA_ARGS__)
 #    define IBuffer_InvalidateMappedRange(This, ...) CALL_IFACE_METHOD(Buffer, InvalidateMappedRange, This, __VA_ARGS__)
+#    define IBuffer_GetSparseBlockSize(This)         CALL_IFACE_METHOD(Buffer, GetSparseBlockSize,    This)
+#    define IBuffer_GetDeviceAddress(This)           CALL_IFACE_METHOD(Buffer, GetDeviceAddress,      This)
 
 // clang-format on
 
@@ -164,6 +164,12 @@ DILIGENT_BEGIN_INTERFACE(IBufferView, IDeviceObject)
     /// The method does *NOT* call AddRef() on the returned interface,
     /// so Release() must not be called.
     VIRTUAL struct IBuffer* METHOD(GetBuffer)(THIS) CONST PURE;
+
+
+    /// Returns the index of the view in the device-wide bindless descriptor heap.
+
+    /// \remarks   See ITextureView::GetBindlessIndex().
+    VIRTUAL Uint32 METHOD(GetBindlessIndex)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -175,7 +181,8 @@ DILIGENT_END_INTERFACE
 
 #    define IBufferView_GetDesc(This) (const struct BufferViewDesc*)IDeviceObject_GetDesc(This)
 
-#    define IBufferView_GetBuffer(This) CALL_IFACE_METHOD(BufferView, GetBuffer, This)
+#    define IBufferView_GetBuffer(This)        CALL_IFACE_METHOD(BufferView, GetBuffer,        This)
+#    define IBufferView_GetBindlessIndex(This) CALL_IFACE_METHOD(BufferView, GetBindlessIndex, This)
 
 // clang-format on
 
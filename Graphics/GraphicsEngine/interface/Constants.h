@@ -50,12 +50,21 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 /// The maximim number of queues in graphics adapter description.
 #define DILIGENT_MAX_ADAPTER_QUEUES 16
 
+/// The maximum number of memory heaps in device memory statistics.
+#define DILIGENT_MAX_MEMORY_HEAPS 16
+
+/// The maximum number of memory types in device memory statistics.
+#define DILIGENT_MAX_MEMORY_TYPES 32
+
 static const Uint32 MAX_BUFFER_SLOTS        = DILIGENT_MAX_BUFFER_SLOTS;
 static const Uint32 MAX_RENDER_TARGETS      = DILIGENT_MAX_RENDER_TARGETS;
 static const Uint32 MAX_VIEWPORTS           = DILIGENT_MAX_VIEWPORTS;
 static const Uint32 MAX_RESOURCE_SIGNATURES = DILIGENT_MAX_RESOURCE_SIGNATURES;
 static const Uint32 MAX_ADAPTER_QUEUES      = DILIGENT_MAX_ADAPTER_QUEUES;
+static const Uint32 MAX_MEMORY_HEAPS        = DILIGENT_MAX_MEMORY_HEAPS;
+static const Uint32 MAX_MEMORY_TYPES        = DILIGENT_MAX_MEMORY_TYPES;
 static const Uint32 DEFAULT_ADAPTER_ID      = 0xFFFFFFFFU;
 static const Uint8  DEFAULT_QUEUE_ID        = 0xFF;
+static const Uint32 INVALID_BINDLESS_INDEX  = 0xFFFFFFFFU;
 
 DILIGENT_END_NAMESPACE // namespace Diligent
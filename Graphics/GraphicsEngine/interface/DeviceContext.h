@@ -34,6 +34,7 @@
 
 #include "../../../Primitives/interface/Object.h"
 #include "../../../Primitives/interface/FlagEnum.h"
+#include "../../../Primitives/interface/MemoryAllocator.h"
 #include "GraphicsTypes.h"
 #include "Constants.h"
 #include "Buffer.h"
@@ -57,6 +58,7 @@
 #include "TopLevelAS.h"
 #include "ShaderBindingTable.h"
 #include "CommandQueue.h"
+#include "ResourceHeap.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -146,6 +148,33 @@ struct DeviceContextDesc
 typedef struct DeviceContextDesc DeviceContextDesc;
 
 
+/// Device context CPU-side command statistics.
+
+/// \remarks The counters are only collected when the engine is built with
+///          DILIGENT_CONTEXT_STATS option enabled. Otherwise all values are zero.
+struct DeviceContextStats
+{
+    /// The number of draw commands (including indirect and mesh draws).
+    Uint32 DrawCommands          DEFAULT_INITIALIZER(0);
+
+    /// The number of dispatch commands (including indirect dispatches).
+    Uint32 DispatchCommands      DEFAULT_INITIALIZER(0);
+
+    /// The number of SetPipelineState() calls.
+    Uint32 PipelineStateChanges  DEFAULT_INITIALIZER(0);
+
+    /// The number of CommitShaderResources() calls.
+    Uint32 ShaderResourceCommits DEFAULT_INITIALIZER(0);
+
+    /// The number of resource barriers passed to TransitionResourceStates().
+    Uint32 StateTransitions      DEFAULT_INITIALIZER(0);
+
+    /// The total size, in bytes, of dynamic buffers mapped for writing.
+    Uint64 DynamicBytesMapped    DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceContextStats DeviceContextStats;
+
+
 /// Draw command flags
 DILIGENT_TYPED_ENUM(DRAW_FLAGS, Uint8)
 {
@@ -386,6 +415,18 @@ struct DrawIndirectAttribs
     /// Offset from the beginning of the buffer to the location of draw command attributes.
     Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
 
+    /// The number of draw commands to execute. The commands are read from the
+    /// arguments buffer starting at IndirectDrawArgsOffset, DrawArgsStride bytes apart.
+    /// If DrawCount is 0, nothing is drawn.
+    ///
+    /// \remarks If DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT capability flag is not set,
+    ///          multiple draw commands are emulated by a sequence of indirect draw calls.
+    Uint32 DrawCount                DEFAULT_INITIALIZER(1);
+
+    /// The byte stride between successive sets of draw arguments.
+    /// Must be a multiple of 4 and no less than 16 bytes (the size of the arguments).
+    Uint32 DrawArgsStride           DEFAULT_INITIALIZER(16);
+
 
 #if DILIGENT_CPP_INTERFACE
     /// Initializes the structure members with default values
@@ -396,15 +437,21 @@ struct DrawIndirectAttribs
     /// Flags                                    | DRAW_FLAG_NONE
     /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
     /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// DrawArgsStride                           | 16
     DrawIndirectAttribs()noexcept{}
 
     /// Initializes the structure members with user-specified values.
     DrawIndirectAttribs(DRAW_FLAGS                     _Flags,
                         RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
-                        Uint32                         _IndirectDrawArgsOffset = 0)noexcept :
+                        Uint32                         _IndirectDrawArgsOffset = 0,
+                        Uint32                         _DrawCount              = 1,
+                        Uint32                         _DrawArgsStride         = 16)noexcept :
         Flags                                   {_Flags                                   },
         IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
-        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  }
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawCount                               {_DrawCount                               },
+        DrawArgsStride                          {_DrawArgsStride                          }
     {}
 #endif
 };
@@ -429,6 +476,18 @@ struct DrawIndexedIndirectAttribs
     /// Offset from the beginning of the buffer to the location of draw command attributes.
     Uint32 IndirectDrawArgsOffset        DEFAULT_INITIALIZER(0);
 
+    /// The number of draw commands to execute. The commands are read from the
+    /// arguments buffer starting at IndirectDrawArgsOffset, DrawArgsStride bytes apart.
+    /// If DrawCount is 0, nothing is drawn.
+    ///
+    /// \remarks If DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT capability flag is not set,
+    ///          multiple draw commands are emulated by a sequence of indirect draw calls.
+    Uint32 DrawCount                     DEFAULT_INITIALIZER(1);
+
+    /// The byte stride between successive sets of draw arguments.
+    /// Must be a multiple of 4 and no less than 20 bytes (the size of the arguments).
+    Uint32 DrawArgsStride                DEFAULT_INITIALIZER(20);
+
 
 #if DILIGENT_CPP_INTERFACE
     /// Initializes the structure members with default values
@@ -440,23 +499,137 @@ struct DrawIndexedIndirectAttribs
     /// Flags                                    | DRAW_FLAG_NONE
     /// IndirectAttribsBufferStateTransitionMode | RESOURCE_STATE_TRANSITION_MODE_NONE
     /// IndirectDrawArgsOffset                   | 0
+    /// DrawCount                                | 1
+    /// DrawArgsStride                           | 20
     DrawIndexedIndirectAttribs()noexcept{}
 
     /// Initializes the structure members with user-specified values.
     DrawIndexedIndirectAttribs(VALUE_TYPE                     _IndexType,
                                DRAW_FLAGS                     _Flags,
                                RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
-                               Uint32                         _IndirectDrawArgsOffset = 0)noexcept : 
+                               Uint32                         _IndirectDrawArgsOffset = 0,
+                               Uint32                         _DrawCount              = 1,
+                               Uint32                         _DrawArgsStride         = 20)noexcept : 
         IndexType                               {_IndexType                               },
         Flags                                   {_Flags                                   },
         IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
-        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  }
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawCount                               {_DrawCount                               },
+        DrawArgsStride                          {_DrawArgsStride                          }
     {}
 #endif
 };
 typedef struct DrawIndexedIndirectAttribs DrawIndexedIndirectAttribs;
 
 
+/// Defines the indirect draw count command attributes.
+
+/// This structure is used by IDeviceContext::DrawIndirectCount().
+struct DrawIndirectCountAttribs
+{
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The maximum number of commands that will be read from the count buffer.
+    Uint32     MaxCommandCount      DEFAULT_INITIALIZER(1);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of draw command attributes.
+    Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// The byte stride between successive sets of draw arguments.
+    /// Must be a multiple of 4 and no less than 16 bytes (the size of the arguments).
+    Uint32 DrawArgsStride           DEFAULT_INITIALIZER(16);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the command counter.
+    Uint32 CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    DrawIndirectCountAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    DrawIndirectCountAttribs(DRAW_FLAGS                     _Flags,
+                             Uint32                         _MaxCommandCount,
+                             RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                             Uint32                         _IndirectDrawArgsOffset,
+                             RESOURCE_STATE_TRANSITION_MODE _CountBufferStateTransitionMode,
+                             Uint32                         _CountBufferOffset,
+                             Uint32                         _DrawArgsStride = 16)noexcept : 
+        Flags                                   {_Flags                                   },
+        MaxCommandCount                         {_MaxCommandCount                         },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawArgsStride                          {_DrawArgsStride                          },
+        CountBufferStateTransitionMode          {_CountBufferStateTransitionMode          },
+        CountBufferOffset                       {_CountBufferOffset                       }
+    {}
+#endif
+};
+typedef struct DrawIndirectCountAttribs DrawIndirectCountAttribs;
+
+
+/// Defines the indexed indirect draw count command attributes.
+
+/// This structure is used by IDeviceContext::DrawIndexedIndirectCount().
+struct DrawIndexedIndirectCountAttribs
+{
+    /// The type of the elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE IndexType            DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The maximum number of commands that will be read from the count buffer.
+    Uint32     MaxCommandCount      DEFAULT_INITIALIZER(1);
+
+    /// State transition mode for indirect draw arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE IndirectAttribsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of draw command attributes.
+    Uint32 IndirectDrawArgsOffset   DEFAULT_INITIALIZER(0);
+
+    /// The byte stride between successive sets of draw arguments.
+    /// Must be a multiple of 4 and no less than 20 bytes (the size of the arguments).
+    Uint32 DrawArgsStride           DEFAULT_INITIALIZER(20);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Offset from the beginning of the buffer to the location of the command counter.
+    Uint32 CountBufferOffset        DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    DrawIndexedIndirectCountAttribs()noexcept{}
+
+    /// Initializes the structure members with user-specified values.
+    DrawIndexedIndirectCountAttribs(VALUE_TYPE                     _IndexType,
+                                    DRAW_FLAGS                     _Flags,
+                                    Uint32                         _MaxCommandCount,
+                                    RESOURCE_STATE_TRANSITION_MODE _IndirectAttribsBufferStateTransitionMode,
+                                    Uint32                         _IndirectDrawArgsOffset,
+                                    RESOURCE_STATE_TRANSITION_MODE _CountBufferStateTransitionMode,
+                                    Uint32                         _CountBufferOffset,
+                                    Uint32                         _DrawArgsStride = 20)noexcept : 
+        IndexType                               {_IndexType                               },
+        Flags                                   {_Flags                                   },
+        MaxCommandCount                         {_MaxCommandCount                         },
+        IndirectAttribsBufferStateTransitionMode{_IndirectAttribsBufferStateTransitionMode},
+        IndirectDrawArgsOffset                  {_IndirectDrawArgsOffset                  },
+        DrawArgsStride                          {_DrawArgsStride                          },
+        CountBufferStateTransitionMode          {_CountBufferStateTransitionMode          },
+        CountBufferOffset                       {_CountBufferOffset                       }
+    {}
+#endif
+};
+typedef struct DrawIndexedIndirectCountAttribs DrawIndexedIndirectCountAttribs;
+
+
 /// Defines the mesh draw command attributes.
 
 /// This structure is used by IDeviceContext::DrawMesh().
@@ -739,6 +912,36 @@ DILIGENT_TYPED_ENUM(SET_VERTEX_BUFFERS_FLAGS, Uint8)
 DEFINE_FLAG_ENUM_OPERATORS(SET_VERTEX_BUFFERS_FLAGS)
 
 
+/// Defines allowed flags for IDeviceContext::Begin() function.
+DILIGENT_TYPED_ENUM(COMMAND_LIST_FLAGS, Uint8)
+{
+    /// No flags. The command list may only be executed once.
+    COMMAND_LIST_FLAG_NONE     = 0x00,
+
+    /// The command list may be executed any number of times, including while
+    /// previous submissions of the same list are still executed by the GPU.
+    ///
+    /// \remarks    A reusable command list can only be recorded by Direct3D11, Direct3D12 and Vulkan
+    ///             deferred contexts and must satisfy the following requirements:
+    ///             - It must not use memory that is only valid for one frame: it must not map or
+    ///               update buffers and textures, bind dynamic buffers or commit shader resource
+    ///               bindings that have dynamic variables. Data that changes between submissions
+    ///               should be read from the contents of default buffers that the application
+    ///               updates in the immediate context.
+    ///             - Resource states are only updated when the list is recorded. The list should
+    ///               either leave all resources in the states they were in when the recording began,
+    ///               or use RESOURCE_STATE_TRANSITION_MODE_NONE.
+    ///             - All objects used by the list must be kept alive as long as the list is executed.
+    ///
+    ///             The command buffer of the list is released when the list is destroyed and all
+    ///             its submissions have completed.
+    COMMAND_LIST_FLAG_REUSABLE = 0x01,
+
+    COMMAND_LIST_FLAG_LAST     = COMMAND_LIST_FLAG_REUSABLE
+};
+DEFINE_FLAG_ENUM_OPERATORS(COMMAND_LIST_FLAGS)
+
+
 /// Describes the viewport.
 
 /// This structure is used by IDeviceContext::SetViewports().
@@ -877,6 +1080,25 @@ struct CopyTextureAttribs
 typedef struct CopyTextureAttribs CopyTextureAttribs;
 
 
+/// Describes one region updated by IDeviceContext::UpdateTextureRegions().
+struct TextureRegionUpdate
+{
+    /// Mip level of the texture subresource to update.
+    Uint32            MipLevel DEFAULT_INITIALIZER(0);
+
+    /// Array slice. Must be 0 for non-array textures.
+    Uint32            Slice    DEFAULT_INITIALIZER(0);
+
+    /// Destination region on the texture subresource.
+    Box               DstBox;
+
+    /// Source data to copy to the region. The data must be located in CPU memory,
+    /// i.e. pSrcBuffer member must be null.
+    TextureSubResData SrcData;
+};
+typedef struct TextureRegionUpdate TextureRegionUpdate;
+
+
 /// BeginRenderPass command attributes.
 
 /// This structure is used by IDeviceContext::BeginRenderPass().
@@ -915,6 +1137,43 @@ struct BeginRenderPassAttribs
 typedef struct BeginRenderPassAttribs BeginRenderPassAttribs;
 
 
+/// Defines dynamic pipeline state attributes.
+
+/// This structure is used by IDeviceContext::SetDynamicStates().
+struct DynamicStateAttribs
+{
+    /// States to set. Members that correspond to the states not included
+    /// in this mask are ignored. All states in the mask must be dynamic in the
+    /// currently bound pipeline, see GraphicsPipelineDesc::DynamicStates.
+    DYNAMIC_STATE_FLAGS Flags            DEFAULT_INITIALIZER(DYNAMIC_STATE_FLAG_NONE);
+
+    /// Cull mode, see Diligent::DYNAMIC_STATE_FLAG_CULL_MODE.
+    CULL_MODE           CullMode         DEFAULT_INITIALIZER(CULL_MODE_BACK);
+
+    /// Enable depth test, see Diligent::DYNAMIC_STATE_FLAG_DEPTH.
+    Bool                DepthEnable      DEFAULT_INITIALIZER(True);
+
+    /// Enable depth writes, see Diligent::DYNAMIC_STATE_FLAG_DEPTH.
+    Bool                DepthWriteEnable DEFAULT_INITIALIZER(True);
+
+    /// Depth comparison function, see Diligent::DYNAMIC_STATE_FLAG_DEPTH.
+    COMPARISON_FUNCTION DepthFunc        DEFAULT_INITIALIZER(COMPARISON_FUNC_LESS);
+
+    /// Enable stencil test, see Diligent::DYNAMIC_STATE_FLAG_STENCIL.
+    Bool                StencilEnable    DEFAULT_INITIALIZER(False);
+
+    /// Stencil operations for front-facing triangles, see Diligent::DYNAMIC_STATE_FLAG_STENCIL.
+    StencilOpDesc       FrontFace;
+
+    /// Stencil operations for back-facing triangles, see Diligent::DYNAMIC_STATE_FLAG_STENCIL.
+    StencilOpDesc       BackFace;
+
+    /// Primitive topology, see Diligent::DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY.
+    PRIMITIVE_TOPOLOGY  PrimitiveTopology DEFAULT_INITIALIZER(PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+};
+typedef struct DynamicStateAttribs DynamicStateAttribs;
+
+
 /// TLAS instance flags that are used in IDeviceContext::BuildTLAS().
 DILIGENT_TYPED_ENUM(RAYTRACING_INSTANCE_FLAGS, Uint8)
 {
@@ -1113,6 +1372,8 @@ struct BuildBLASAttribs
     /// The buffer that is used for acceleration structure building.
     /// Must be created with BIND_RAY_TRACING.
     /// Call IBottomLevelAS::GetScratchBufferSizes().Build to get the minimal size for the scratch buffer.
+    /// If null, the scratch space is suballocated from the internal scratch ring of the device context,
+    /// and ScratchBufferOffset and ScratchBufferTransitionMode are ignored.
     IBuffer*                        pScratchBuffer              DEFAULT_INITIALIZER(nullptr);
 
     /// Offset from the beginning of the buffer.
@@ -1134,6 +1395,41 @@ struct BuildBLASAttribs
 typedef struct BuildBLASAttribs BuildBLASAttribs;
 
 
+/// This structure is used by IDeviceContext::BuildBLASBatch().
+struct BuildBLASBatchAttribs
+{
+    /// A pointer to an array of BuildCount BuildBLASAttribs structures that describe the builds.
+    /// pScratchBuffer, ScratchBufferOffset and ScratchBufferTransitionMode members of the elements are ignored:
+    /// all builds share the scratch buffer specified by this structure.
+    /// Every bottom-level AS must appear in the batch at most once.
+    BuildBLASAttribs const*         pBuilds                     DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pBuilds.
+    Uint32                          BuildCount                  DEFAULT_INITIALIZER(0);
+
+    /// The scratch buffer that is shared by all builds in the batch.
+    /// Must be created with BIND_RAY_TRACING.
+    /// Build i uses the region that starts at ScratchBufferOffset plus the sizes of the regions of the preceding builds.
+    /// The size of each region is IBottomLevelAS::GetScratchBufferSizes().Build (or .Update if BuildBLASAttribs::Update is true)
+    /// rounded up to RayTracingProperties::ScratchBufferAlignment.
+    /// If null, the scratch space is suballocated from the internal scratch ring of the device context,
+    /// and ScratchBufferOffset and ScratchBufferTransitionMode are ignored.
+    IBuffer*                        pScratchBuffer              DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the buffer.
+    /// Must be a multiple of RayTracingProperties::ScratchBufferAlignment.
+    Uint32                          ScratchBufferOffset         DEFAULT_INITIALIZER(0);
+
+    /// Scratch buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
+    RESOURCE_STATE_TRANSITION_MODE  ScratchBufferTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+#if DILIGENT_CPP_INTERFACE
+    BuildBLASBatchAttribs() noexcept {}
+#endif
+};
+typedef struct BuildBLASBatchAttribs BuildBLASBatchAttribs;
+
+
 /// Can be used to calculate the TLASBuildInstanceData::ContributionToHitGroupIndex depending on instance count,
 /// geometry count in each instance (in TLASBuildInstanceData::pBLAS) and shader binding mode in BuildTLASAttribs::BindingMode.
 /// 
@@ -1194,7 +1490,11 @@ typedef struct InstanceMatrix InstanceMatrix;
 /// This structure is used by BuildTLASAttribs.
 struct TLASBuildInstanceData
 {
-    /// Instance name that is used to map an instance to a hit group in shader binding table.
+    /// Optional instance name that is used to map an instance to a hit group in shader binding table.
+    /// If the name is null, the instance is identified by its index in BuildTLASAttribs::pInstances
+    /// (see ITopLevelAS::GetInstanceDescByIndex()). When the TLAS is updated, an instance with null name
+    /// updates the instance with the same index without a name lookup, which is considerably faster
+    /// for large instance counts.
     const char*               InstanceName    DEFAULT_INITIALIZER(nullptr);
 
     /// Bottom-level AS that represents instance geometry.
@@ -1255,6 +1555,7 @@ struct BuildTLASAttribs
     /// If Update is true:
     ///     - Any instance data can be changed.
     ///     - To disable an instance set TLASBuildInstanceData::Mask to zero or set empty TLASBuildInstanceData::BLAS to pBLAS.
+    /// Must be null if UseGPUInstanceData is true.
     TLASBuildInstanceData const*    pInstances                    DEFAULT_INITIALIZER(nullptr);
 
     /// The number of instances.
@@ -1273,6 +1574,18 @@ struct BuildTLASAttribs
     /// Instance buffer state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE).
     RESOURCE_STATE_TRANSITION_MODE  InstanceBufferTransitionMode  DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
 
+    /// If true, pInstanceBuffer already contains InstanceCount instances written on the GPU
+    /// (for example, by a compute shader), and the instance data is not uploaded from the CPU.
+    ///   - pInstances must be null and BindingMode must be HIT_GROUP_BINDING_MODE_USER_DEFINED.
+    ///   - Every instance must use the native layout of TLAS_INSTANCE_DATA_SIZE bytes
+    ///     (VkAccelerationStructureInstanceKHR in Vulkan, D3D12_RAYTRACING_INSTANCE_DESC in Direct3D12)
+    ///     and reference its BLAS by the device address (IBottomLevelASVk::GetVkDeviceAddress() in Vulkan,
+    ///     GPU virtual address of IBottomLevelASD3D12::GetD3D12BLAS() in Direct3D12).
+    ///   - The TLAS does not keep references to the bottom-level ASes: the application must keep them alive
+    ///     and in RESOURCE_STATE_BUILD_AS_READ state, and BLASTransitionMode is ignored.
+    ///   - ITopLevelAS::GetInstanceDesc() and ITopLevelAS::GetInstanceDescByIndex() do not return instances of such TLAS.
+    Bool                            UseGPUInstanceData            DEFAULT_INITIALIZER(False);
+
     /// The number of hit shaders that can be bound for a single geometry or an instance (depends on BindingMode).
     ///   - Used to calculate TLASBuildInstanceData::ContributionToHitGroupIndex.
     ///   - Ignored if BindingMode is SHADER_BINDING_USER_DEFINED.
@@ -1293,6 +1606,8 @@ struct BuildTLASAttribs
     /// Buffer that is used for acceleration structure building.
     /// Must be created with BIND_RAY_TRACING.
     /// Call ITopLevelAS::GetScratchBufferSizes().Build to get the minimal size for the scratch buffer.
+    /// If null, the scratch space is suballocated from the internal scratch ring of the device context,
+    /// and ScratchBufferOffset and ScratchBufferTransitionMode are ignored.
     /// Access to the TLAS must be externally synchronized.
     IBuffer*                        pScratchBuffer                DEFAULT_INITIALIZER(nullptr);
 
@@ -1536,6 +1851,13 @@ struct StateTransitionDesc
     /// \note When TransitionType is STATE_TRANSITION_TYPE_BEGIN, this member must be false.
     bool UpdateResourceState  DEFAULT_INITIALIZER(false);
 
+    /// For resources placed in a resource heap (see Diligent::IResourceHeap), the resource that
+    /// previously used the memory that pResource now occupies. When not null, an aliasing barrier
+    /// is issued: all accesses to pResourceBefore complete before pResource is accessed, and
+    /// the previous contents of pResource become undefined.
+    /// \note When TransitionType is not STATE_TRANSITION_TYPE_IMMEDIATE, this member must be null.
+    struct IDeviceObject* pResourceBefore DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     StateTransitionDesc()noexcept{}
 
@@ -1611,6 +1933,69 @@ struct StateTransitionDesc
 typedef struct StateTransitionDesc StateTransitionDesc;
 
 
+/// Describes a region of sparse texture tiles and the memory they are mapped to.
+
+/// This structure is used by UpdateTileMappingsAttribs.
+struct TileMappingRange
+{
+    /// Mip level of the region.
+    /// If the mip level is in the mip tail (see SparseTextureProperties::FirstMipInTail),
+    /// the entire mip tail of the array slice is mapped and tile coordinates are ignored.
+    Uint32 MipLevel   DEFAULT_INITIALIZER(0);
+
+    /// Array slice of the region.
+    Uint32 ArraySlice DEFAULT_INITIALIZER(0);
+
+    /// Horizontal coordinate of the first tile in the region, in tiles.
+    /// For a sparse buffer, this is the index of the first block of the region.
+    Uint32 TileX      DEFAULT_INITIALIZER(0);
+
+    /// Vertical coordinate of the first tile in the region, in tiles.
+    Uint32 TileY      DEFAULT_INITIALIZER(0);
+
+    /// Number of tiles in the region in horizontal direction.
+    /// For a sparse buffer, this is the number of blocks in the region.
+    Uint32 NumTilesX  DEFAULT_INITIALIZER(1);
+
+    /// Number of tiles in the region in vertical direction.
+    Uint32 NumTilesY  DEFAULT_INITIALIZER(1);
+
+    /// Resource heap that provides the memory for the tiles, or null to unmap the tiles.
+    /// Reading from unmapped tiles returns undefined values; writes to them are discarded.
+    IResourceHeap* pHeap DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset in the heap, in bytes, of the memory that is mapped to the first tile.
+    /// Must be a multiple of SparseTextureProperties::TileSizeInBytes for a texture, or
+    /// of IBuffer::GetSparseBlockSize() for a buffer.
+    /// Tiles of the region are mapped to consecutive memory in row-major order.
+    Uint64 HeapOffset DEFAULT_INITIALIZER(0);
+};
+typedef struct TileMappingRange TileMappingRange;
+
+
+/// This structure is used by IDeviceContext::UpdateTileMappings().
+
+/// Exactly one of pTexture and pBuffer must be specified.
+/// Ranges of a buffer are one-dimensional: MipLevel, ArraySlice and TileY must be 0, and NumTilesY must be 1.
+struct UpdateTileMappingsAttribs
+{
+    /// Sparse texture whose tile mappings are updated.
+    /// The texture must have been created with Diligent::MISC_TEXTURE_FLAG_SPARSE flag.
+    ITexture*               pTexture  DEFAULT_INITIALIZER(nullptr);
+
+    /// Sparse buffer whose block mappings are updated.
+    /// The buffer must have been created with Diligent::MISC_BUFFER_FLAG_SPARSE flag.
+    IBuffer*                pBuffer   DEFAULT_INITIALIZER(nullptr);
+
+    /// A pointer to an array of NumRanges tile mapping ranges.
+    const TileMappingRange* pRanges   DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pRanges array.
+    Uint32                  NumRanges DEFAULT_INITIALIZER(0);
+};
+typedef struct UpdateTileMappingsAttribs UpdateTileMappingsAttribs;
+
+
 #define DILIGENT_INTERFACE_NAME IDeviceContext
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -1636,11 +2021,13 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     /// \param [in] ImmediateContextId - the ID of the immediate context where commands from this
     ///                                  deferred context will be executed, 
     ///                                  see Diligent::DeviceContextDesc::ContextId.
+    /// \param [in] Flags              - command list flags, see Diligent::COMMAND_LIST_FLAGS.
     /// 
     /// \warning Command list recorded by the context must not be submitted to any other immediate context
     ///          other than one identified by ImmediateContextId.
     VIRTUAL void METHOD(Begin)(THIS_
-                               Uint32 ImmediateContextId) PURE;
+                               Uint32             ImmediateContextId,
+                               COMMAND_LIST_FLAGS Flags DEFAULT_VALUE(COMMAND_LIST_FLAG_NONE)) PURE;
 
     /// Sets the pipeline state.
 
@@ -1712,6 +2099,27 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                IShaderResourceBinding*        pShaderResourceBinding,
                                                RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) PURE;
 
+
+    /// Sets inline constants for the currently bound pipeline state.
+
+    /// \param [in] pConstants    - Pointer to the constant data. The data must contain NumConstants 32-bit values.
+    /// \param [in] FirstConstant - Index of the first 32-bit constant to set.
+    /// \param [in] NumConstants  - The number of 32-bit constants to set.
+    ///
+    /// \remarks Inline constants are defined in the pipeline resource signature by a constant buffer
+    ///          resource with Diligent::PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag. The values are
+    ///          recorded directly into the command buffer and do not require a shader resource binding.\n
+    ///          A pipeline state that uses inline constants must be bound before calling this method.
+    ///          The values remain set until they are overwritten or a pipeline state with a different
+    ///          inline constants layout is bound.\n
+    ///          Inline constants are currently only supported in Vulkan backend.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(SetInlineConstants)(THIS_
+                                            const void* pConstants,
+                                            Uint32      FirstConstant,
+                                            Uint32      NumConstants) PURE;
+
     /// Sets the stencil reference value.
 
     /// \param [in] StencilRef - Stencil reference value.
@@ -1733,6 +2141,22 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                          const float* pBlendFactors DEFAULT_VALUE(nullptr)) PURE;
 
 
+    /// Sets dynamic pipeline states.
+
+    /// \param [in] Attribs - Dynamic state attributes, see Diligent::DynamicStateAttribs.
+    ///
+    /// \remarks The states selected by Attribs.Flags must be dynamic in the currently bound
+    ///          pipeline (see GraphicsPipelineDesc::DynamicStates). When a pipeline is bound,
+    ///          its dynamic states are reset to the values in the pipeline description, so
+    ///          the method must be called after SetPipelineState().
+    ///
+    ///          Dynamic states require Diligent::DeviceFeatures::DynamicPipelineStates feature.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(SetDynamicStates)(THIS_
+                                          const DynamicStateAttribs REF Attribs) PURE;
+
+
     /// Binds vertex buffers to the pipeline.
 
     /// \param [in] StartSlot           - The first input slot for binding. The first vertex buffer is 
@@ -1958,6 +2382,8 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///                                  Uint32 NumInstances;
     ///                                  Uint32 StartVertexLocation;
     ///                                  Uint32 FirstInstanceLocation;
+    ///                              If Attribs.DrawCount is greater than 1, the buffer must contain
+    ///                              Attribs.DrawCount sets of arguments, Attribs.DrawArgsStride bytes apart.
     ///
     /// \remarks  If IndirectAttribsBufferStateTransitionMode member is Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
     ///           the method may transition the state of the indirect draw arguments buffer. This is not a thread safe operation, 
@@ -1986,6 +2412,8 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     ///                                  Uint32 FirstIndexLocation;
     ///                                  Uint32 BaseVertex;
     ///                                  Uint32 FirstInstanceLocation
+    ///                              If Attribs.DrawCount is greater than 1, the buffer must contain
+    ///                              Attribs.DrawCount sets of arguments, Attribs.DrawArgsStride bytes apart.
     ///
     /// \remarks  If IndirectAttribsBufferStateTransitionMode member is Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
     ///           the method may transition the state of the indirect draw arguments buffer. This is not a thread safe operation, 
@@ -2004,6 +2432,69 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                              IBuffer*                             pAttribsBuffer) PURE;
 
 
+    /// Executes an indirect draw command with indirect command count buffer.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::DrawIndirectCountAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///                              The buffer must contain Attribs.MaxCommandCount sets of the following arguments
+    ///                              starting at the specified offset, Attribs.DrawArgsStride bytes apart:
+    ///                                  Uint32 NumVertices;
+    ///                                  Uint32 NumInstances;
+    ///                                  Uint32 StartVertexLocation;
+    ///                                  Uint32 FirstInstanceLocation;
+    /// \param [in] pCountBuffer   - Pointer to the buffer, from which Uint32 value with draw count will be read.
+    ///                              The number of executed commands is the minimum of this value and Attribs.MaxCommandCount.
+    ///
+    /// \remarks  The command requires DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT capability,
+    ///           see Diligent::DrawCommandProperties.
+    ///
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the
+    ///           corresponding buffer. This is not a thread safe operation, so no other thread is allowed to read
+    ///           or write the state of the buffer.
+    ///
+    ///           If the application intends to use the same resources in other threads simultaneously, it needs to 
+    ///           explicitly manage the states using IDeviceContext::TransitionResourceStates() method.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(DrawIndirectCount)(THIS_
+                                           const DrawIndirectCountAttribs REF Attribs,
+                                           IBuffer*                           pAttribsBuffer,
+                                           IBuffer*                           pCountBuffer) PURE;
+
+
+    /// Executes an indexed indirect draw command with indirect command count buffer.
+
+    /// \param [in] Attribs        - Structure describing the command attributes, see Diligent::DrawIndexedIndirectCountAttribs for details.
+    /// \param [in] pAttribsBuffer - Pointer to the buffer, from which indirect draw attributes will be read.
+    ///                              The buffer must contain Attribs.MaxCommandCount sets of the following arguments
+    ///                              starting at the specified offset, Attribs.DrawArgsStride bytes apart:
+    ///                                  Uint32 NumIndices;
+    ///                                  Uint32 NumInstances;
+    ///                                  Uint32 FirstIndexLocation;
+    ///                                  Uint32 BaseVertex;
+    ///                                  Uint32 FirstInstanceLocation
+    /// \param [in] pCountBuffer   - Pointer to the buffer, from which Uint32 value with draw count will be read.
+    ///                              The number of executed commands is the minimum of this value and Attribs.MaxCommandCount.
+    ///
+    /// \remarks  The command requires DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT capability,
+    ///           see Diligent::DrawCommandProperties.
+    ///
+    /// \remarks  If IndirectAttribsBufferStateTransitionMode or CountBufferStateTransitionMode member is
+    ///           Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, the method may transition the state of the
+    ///           corresponding buffer. This is not a thread safe operation, so no other thread is allowed to read
+    ///           or write the state of the buffer.
+    ///
+    ///           If the application intends to use the same resources in other threads simultaneously, it needs to 
+    ///           explicitly manage the states using IDeviceContext::TransitionResourceStates() method.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(DrawIndexedIndirectCount)(THIS_
+                                                  const DrawIndexedIndirectCountAttribs REF Attribs,
+                                                  IBuffer*                                  pAttribsBuffer,
+                                                  IBuffer*                                  pCountBuffer) PURE;
+
+
     /// Executes a mesh draw command.
 
     /// \param [in] Attribs - Draw command attributes, see Diligent::DrawMeshAttribs for details.
@@ -2214,7 +2705,8 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
 
     /// \param [in] NumCommandLists - The number of command lists to execute.
     /// \param [in] ppCommandLists  - Pointer to the array of NumCommandLists command lists to execute.
-    /// \remarks After a command list is executed, it is no longer valid and must be released.
+    /// \remarks After a command list is executed, it is no longer valid and must be released,
+    ///          unless it was recorded with Diligent::COMMAND_LIST_FLAG_REUSABLE flag.
     VIRTUAL void METHOD(ExecuteCommandLists)(THIS_
                                              Uint32               NumCommandLists,
                                              ICommandList* const* ppCommandLists) PURE;
@@ -2318,6 +2810,56 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                   IQuery* pQuery) PURE;
 
 
+    /// Samples the GPU timestamp counter of the context's command queue and the CPU clock at the same moment.
+
+    /// \param [out] Calibration - Calibrated timestamps, see Diligent::TimestampCalibration.
+    ///
+    /// \return     true if the timestamps were sampled, and false otherwise.
+    ///
+    /// \remarks    The calibration lets an application place the results of timestamp queries
+    ///             on the CPU timeline, so that CPU and GPU work can be shown in one trace.
+    ///             The GPU and CPU clocks may drift apart over time, so an application should
+    ///             recalibrate periodically, e.g. once per frame.
+    ///
+    ///             Direct3D12 uses ID3D12CommandQueue::GetClockCalibration(). Vulkan requires
+    ///             VK_EXT_calibrated_timestamps extension with the device and the host time domains.
+    ///             Direct3D11 and OpenGL backends do not support calibrated timestamps and always return false.
+    ///
+    /// \remarks Supported contexts: immediate graphics, compute.
+    VIRTUAL Bool METHOD(GetTimestampCalibration)(THIS_
+                                                 TimestampCalibration REF Calibration) PURE;
+
+
+    /// Begins a conditional rendering block.
+
+    /// \param [in] pQuery - A pointer to a binary occlusion query (QUERY_TYPE_BINARY_OCCLUSION)
+    ///                      that has been ended, but whose data does not need to be available
+    ///                      on the CPU.
+    ///
+    /// \remarks    Draw, dispatch and clear commands issued between BeginConditionalRendering() and
+    ///             EndConditionalRendering() are skipped by the GPU if the query did not
+    ///             pass any samples. This lets an application cull objects based on the
+    ///             results of occlusion queries without reading them back on the CPU.
+    ///             Whether copy commands are affected is backend-specific (Direct3D11 and Direct3D12
+    ///             skip them, OpenGL and Vulkan do not), so they should not be recorded inside the block.
+    ///
+    ///             Conditional rendering blocks can't be nested and must begin and end outside
+    ///             of an explicit render pass (see IDeviceContext::BeginRenderPass()).
+    ///             In Direct3D12 and Vulkan, the query result is resolved on the GPU. An
+    ///             implicit render pass is ended, if necessary.
+    ///             The context must not be flushed while conditional rendering is active.
+    ///
+    ///             The method requires ConditionalRendering device feature.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(BeginConditionalRendering)(THIS_
+                                                   IQuery* pQuery) PURE;
+
+
+    /// Ends the conditional rendering block started by IDeviceContext::BeginConditionalRendering().
+    VIRTUAL void METHOD(EndConditionalRendering)(THIS) PURE;
+
+
     /// Submits all pending commands in the context for execution to the command queue.
 
     /// \remarks    Only immediate contexts can be flushed.\n
@@ -2419,6 +2961,29 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                        RESOURCE_STATE_TRANSITION_MODE   TextureTransitionMode) PURE;
 
 
+    /// Updates multiple regions of the texture.
+
+    /// \param [in] pTexture              - Pointer to the texture to update.
+    /// \param [in] pUpdates              - Array of NumUpdates regions to update, see Diligent::TextureRegionUpdate.
+    /// \param [in] NumUpdates            - The number of elements in pUpdates array.
+    /// \param [in] TextureTransitionMode - Texture state transition mode (see Diligent::RESOURCE_STATE_TRANSITION_MODE)
+    ///
+    /// \remarks Every region must meet the same requirements as the region passed to UpdateTexture().
+    ///          The regions may belong to different mip levels and array slices, but must not overlap.
+    ///
+    ///          Vulkan and Direct3D12 backends pack the data of all regions into one staging allocation
+    ///          and transition the texture state once; Vulkan also copies all regions with one command.
+    ///          This is considerably cheaper than calling UpdateTexture() for every region when many small
+    ///          regions are updated, e.g. in texture atlases.
+    ///
+    /// \remarks Supported contexts: graphics, compute, transfer.
+    VIRTUAL void METHOD(UpdateTextureRegions)(THIS_
+                                              ITexture*                      pTexture,
+                                              const TextureRegionUpdate*     pUpdates,
+                                              Uint32                         NumUpdates,
+                                              RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) PURE;
+
+
     /// Copies data from one texture to another.
 
     /// \param [in] CopyAttribs - Structure describing copy command attributes, see Diligent::CopyTextureAttribs for details.
@@ -2478,6 +3043,23 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                       ITextureView* pTextureView) PURE;
 
 
+    /// Generates mipmap chains for multiple texture views.
+
+    /// \param [in] ppTextureViews - Array of NumViews texture views to generate mip maps for.
+    /// \param [in] NumViews       - The number of elements in ppTextureViews array.
+    /// \remarks Every view must meet the same requirements as the view passed to GenerateMips().
+    ///          The views must not reference overlapping subresources of the same texture.
+    ///
+    ///          Backends that generate mips with compute shaders group the views by format,
+    ///          bind every pipeline once and record the resource barriers for all views together,
+    ///          which is considerably cheaper than calling GenerateMips() for every view.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(GenerateMipsBatch)(THIS_
+                                           ITextureView* ppTextureViews[],
+                                           Uint32        NumViews) PURE;
+
+
     /// Finishes the current frame and releases dynamic resources allocated by the context.
 
     /// For immediate context, this method is called automatically by ISwapChain::Present() of the primary
@@ -2499,6 +3081,27 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     VIRTUAL Uint64 METHOD(GetFrameNumber)(THIS) CONST PURE;
 
 
+    /// Returns the command statistics of the last finished frame.
+
+    /// \note The statistics are accumulated between two consecutive FinishFrame() calls
+    ///       and are only collected when the engine is built with DILIGENT_CONTEXT_STATS
+    ///       option enabled.
+    VIRTUAL const DeviceContextStats REF METHOD(GetStats)(THIS) CONST PURE;
+
+
+    /// Returns the context's frame memory allocator.
+
+    /// The frame allocator is a linear arena that is reset every time FinishFrame() is called.
+    /// It is intended for temporary per-frame data (e.g. arrays of resource barriers) and
+    /// avoids heap allocations once the arena has grown to the peak per-frame usage.
+    ///
+    /// \note   Memory returned by the allocator is aligned by 16 bytes and is only valid until
+    ///         the next FinishFrame() call. IMemoryAllocator::Free() does nothing.
+    ///         Similar to other device context methods, the allocator must not be used
+    ///         from multiple threads simultaneously.
+    VIRTUAL struct IMemoryAllocator* METHOD(GetFrameAllocator)(THIS) PURE;
+
+
     /// Transitions resource states.
 
     /// \param [in] BarrierCount      - Number of barriers in pResourceBarriers array
@@ -2542,6 +3145,22 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                                    ITexture*                                  pSrcTexture,
                                                    ITexture*                                  pDstTexture,
                                                    const ResolveTextureSubresourceAttribs REF ResolveAttribs) PURE;
+
+
+    /// Maps tiles of a sparse texture or blocks of a sparse buffer to resource heap memory, or unmaps them.
+
+    /// \param [in] Attribs - Tile mapping attributes, see Diligent::UpdateTileMappingsAttribs for details.
+    ///
+    /// \remarks The mapping is updated on the command queue. All commands recorded in the context
+    ///          before this call are submitted first and observe the old mappings; commands recorded
+    ///          after the call observe the new ones.
+    ///
+    ///          Tile mapping is a queue operation and is only available in immediate contexts.
+    ///          The method requires SparseResources device feature.
+    ///
+    /// \remarks Supported contexts: graphics, compute, transfer.
+    VIRTUAL void METHOD(UpdateTileMappings)(THIS_
+                                            const UpdateTileMappingsAttribs REF Attribs) PURE;
     
 
     /// Builds a bottom-level acceleration structure with the specified geometries.
@@ -2566,6 +3185,20 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
     /// \remarks Supported contexts: graphics, compute.
     VIRTUAL void METHOD(BuildTLAS)(THIS_
                                    const BuildTLASAttribs REF Attribs) PURE;
+
+
+    /// Builds or updates several bottom-level acceleration structures in one batch.
+
+    /// \param [in] Attribs - Structure describing the batch, see Diligent::BuildBLASBatchAttribs for details.
+    ///
+    /// \note All builds share one scratch buffer and are submitted with a single
+    ///       vkCmdBuildAccelerationStructuresKHR call in Vulkan, and back to back after
+    ///       a single resource barrier flush in Direct3D12. This is more efficient than
+    ///       calling BuildBLAS() for every BLAS.
+    ///
+    /// \remarks Supported contexts: graphics, compute.
+    VIRTUAL void METHOD(BuildBLASBatch)(THIS_
+                                        const BuildBLASBatchAttribs REF Attribs) PURE;
     
 
     /// Copies data from one acceleration structure to another.
@@ -2755,8 +3388,10 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_SetPipelineState(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetPipelineState,          This, __VA_ARGS__)
 #    define IDeviceContext_TransitionShaderResources(This, ...) CALL_IFACE_METHOD(DeviceContext, TransitionShaderResources, This, __VA_ARGS__)
 #    define IDeviceContext_CommitShaderResources(This, ...)     CALL_IFACE_METHOD(DeviceContext, CommitShaderResources,     This, __VA_ARGS__)
+#    define IDeviceContext_SetInlineConstants(This, ...)        CALL_IFACE_METHOD(DeviceContext, SetInlineConstants,        This, __VA_ARGS__)
 #    define IDeviceContext_SetStencilRef(This, ...)             CALL_IFACE_METHOD(DeviceContext, SetStencilRef,             This, __VA_ARGS__)
 #    define IDeviceContext_SetBlendFactors(This, ...)           CALL_IFACE_METHOD(DeviceContext, SetBlendFactors,           This, __VA_ARGS__)
+#    define IDeviceContext_SetDynamicStates(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetDynamicStates,          This, __VA_ARGS__)
 #    define IDeviceContext_SetVertexBuffers(This, ...)          CALL_IFACE_METHOD(DeviceContext, SetVertexBuffers,          This, __VA_ARGS__)
 #    define IDeviceContext_InvalidateState(This)                CALL_IFACE_METHOD(DeviceContext, InvalidateState,           This)
 #    define IDeviceContext_SetIndexBuffer(This, ...)            CALL_IFACE_METHOD(DeviceContext, SetIndexBuffer,            This, __VA_ARGS__)
@@ -2770,6 +3405,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_DrawIndexed(This, ...)               CALL_IFACE_METHOD(DeviceContext, DrawIndexed,               This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndirect(This, ...)              CALL_IFACE_METHOD(DeviceContext, DrawIndirect,              This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)       CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
+#    define IDeviceContext_DrawIndirectCount(This, ...)         CALL_IFACE_METHOD(DeviceContext, DrawIndirectCount,         This, __VA_ARGS__)
+#    define IDeviceContext_DrawIndexedIndirectCount(This, ...)  CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirectCount,  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirect(This, ...)          CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirect,          This, __VA_ARGS__)
 #    define IDeviceContext_DrawMeshIndirectCount(This, ...)     CALL_IFACE_METHOD(DeviceContext, DrawMeshIndirectCount,     This, __VA_ARGS__)
@@ -2786,22 +3423,31 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_WaitForIdle(This)                    CALL_IFACE_METHOD(DeviceContext, WaitForIdle,               This)
 #    define IDeviceContext_BeginQuery(This, ...)                CALL_IFACE_METHOD(DeviceContext, BeginQuery,                This, __VA_ARGS__)
 #    define IDeviceContext_EndQuery(This, ...)                  CALL_IFACE_METHOD(DeviceContext, EndQuery,                  This, __VA_ARGS__)
+#    define IDeviceContext_GetTimestampCalibration(This, ...)   CALL_IFACE_METHOD(DeviceContext, GetTimestampCalibration,   This, __VA_ARGS__)
+#    define IDeviceContext_BeginConditionalRendering(This, ...) CALL_IFACE_METHOD(DeviceContext, BeginConditionalRendering, This, __VA_ARGS__)
+#    define IDeviceContext_EndConditionalRendering(This)       CALL_IFACE_METHOD(DeviceContext, EndConditionalRendering,   This)
 #    define IDeviceContext_Flush(This)                          CALL_IFACE_METHOD(DeviceContext, Flush,                     This)
 #    define IDeviceContext_UpdateBuffer(This, ...)              CALL_IFACE_METHOD(DeviceContext, UpdateBuffer,              This, __VA_ARGS__)
 #    define IDeviceContext_CopyBuffer(This, ...)                CALL_IFACE_METHOD(DeviceContext, CopyBuffer,                This, __VA_ARGS__)
 #    define IDeviceContext_MapBuffer(This, ...)                 CALL_IFACE_METHOD(DeviceContext, MapBuffer,                 This, __VA_ARGS__)
 #    define IDeviceContext_UnmapBuffer(This, ...)               CALL_IFACE_METHOD(DeviceContext, UnmapBuffer,               This, __VA_ARGS__)
 #    define IDeviceContext_UpdateTexture(This, ...)             CALL_IFACE_METHOD(DeviceContext, UpdateTexture,             This, __VA_ARGS__)
+#    define IDeviceContext_UpdateTextureRegions(This, ...)      CALL_IFACE_METHOD(DeviceContext, UpdateTextureRegions,      This, __VA_ARGS__)
 #    define IDeviceContext_CopyTexture(This, ...)               CALL_IFACE_METHOD(DeviceContext, CopyTexture,               This, __VA_ARGS__)
 #    define IDeviceContext_MapTextureSubresource(This, ...)     CALL_IFACE_METHOD(DeviceContext, MapTextureSubresource,     This, __VA_ARGS__)
 #    define IDeviceContext_UnmapTextureSubresource(This, ...)   CALL_IFACE_METHOD(DeviceContext, UnmapTextureSubresource,   This, __VA_ARGS__)
 #    define IDeviceContext_GenerateMips(This, ...)              CALL_IFACE_METHOD(DeviceContext, GenerateMips,              This, __VA_ARGS__)
+#    define IDeviceContext_GenerateMipsBatch(This, ...)         CALL_IFACE_METHOD(DeviceContext, GenerateMipsBatch,         This, __VA_ARGS__)
 #    define IDeviceContext_FinishFrame(This)                    CALL_IFACE_METHOD(DeviceContext, FinishFrame,               This)
 #    define IDeviceContext_GetFrameNumber(This)                 CALL_IFACE_METHOD(DeviceContext, GetFrameNumber,            This)
+#    define IDeviceContext_GetStats(This)                       CALL_IFACE_METHOD(DeviceContext, GetStats,                  This)
+#    define IDeviceContext_GetFrameAllocator(This)              CALL_IFACE_METHOD(DeviceContext, GetFrameAllocator,         This)
 #    define IDeviceContext_TransitionResourceStates(This, ...)  CALL_IFACE_METHOD(DeviceContext, TransitionResourceStates,  This, __VA_ARGS__)
 #    define IDeviceContext_ResolveTextureSubresource(This, ...) CALL_IFACE_METHOD(DeviceContext, ResolveTextureSubresource, This, __VA_ARGS__)
+#    define IDeviceContext_UpdateTileMappings(This, ...)        CALL_IFACE_METHOD(DeviceContext, UpdateTileMappings,        This, __VA_ARGS__)
 #    define IDeviceContext_BuildBLAS(This, ...)                 CALL_IFACE_METHOD(DeviceContext, BuildBLAS,                 This, __VA_ARGS__)
 #    define IDeviceContext_BuildTLAS(This, ...)                 CALL_IFACE_METHOD(DeviceContext, BuildTLAS,                 This, __VA_ARGS__)
+#    define IDeviceContext_BuildBLASBatch(This, ...)            CALL_IFACE_METHOD(DeviceContext, BuildBLASBatch,            This, __VA_ARGS__)
 #    define IDeviceContext_CopyBLAS(This, ...)                  CALL_IFACE_METHOD(DeviceContext, CopyBLAS,                  This, __VA_ARGS__)
 #    define IDeviceContext_CopyTLAS(This, ...)                  CALL_IFACE_METHOD(DeviceContext, CopyTLAS,                  This, __VA_ARGS__)
 #    define IDeviceContext_WriteBLASCompactedSize(This, ...)    CALL_IFACE_METHOD(DeviceContext, WriteBLASCompactedSize,    This, __VA_ARGS__)
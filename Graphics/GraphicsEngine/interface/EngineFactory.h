@@ -31,6 +31,7 @@
 /// Defines Diligent::IEngineFactory interface
 
 #include "../../../Primitives/interface/Object.h"
+#include "../../../Primitives/interface/ThreadPool.h"
 #include "GraphicsTypes.h"
 
 
@@ -91,6 +92,17 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactory, IObject)
                                            Uint32 REF           NumAdapters,
                                            GraphicsAdapterInfo* Adapters) CONST PURE;
 
+    /// Creates a thread pool.
+
+    /// \param [in]  CreateInfo   - Thread pool create info, see Diligent::ThreadPoolCreateInfo.
+    /// \param [out] ppThreadPool - Memory address where the pointer to the thread pool will be written.
+    ///
+    /// \remarks The pool may be passed to the engine through EngineCreateInfo::pAsyncTaskPool
+    ///          and shared with the application's own tasks.
+    VIRTUAL void METHOD(CreateThreadPool)(THIS_
+                                          const ThreadPoolCreateInfo REF CreateInfo,
+                                          IThreadPool**                  ppThreadPool) CONST PURE;
+
 #if PLATFORM_ANDROID
     /// On Android platform, it is necessary to initialize the file system before
     /// CreateDefaultShaderSourceStreamFactory() method can be called.
@@ -119,6 +131,7 @@ DILIGENT_END_INTERFACE
 #    define IEngineFactory_GetAPIInfo(This)                                  CALL_IFACE_METHOD(EngineFactory, GetAPIInfo,                             This)
 #    define IEngineFactory_CreateDefaultShaderSourceStreamFactory(This, ...) CALL_IFACE_METHOD(EngineFactory, CreateDefaultShaderSourceStreamFactory, This, __VA_ARGS__)
 #    define IEngineFactory_EnumerateAdapters(This, ...)                      CALL_IFACE_METHOD(EngineFactory, EnumerateAdapters,                      This, __VA_ARGS__)
+#    define IEngineFactory_CreateThreadPool(This, ...)                       CALL_IFACE_METHOD(EngineFactory, CreateThreadPool,                       This, __VA_ARGS__)
 #    define IEngineFactory_InitAndroidFileSystem(This, ...)                  CALL_IFACE_METHOD(EngineFactory, InitAndroidFileSystem,                  This, __VA_ARGS__)
 
 // clang-format on
@@ -981,7 +981,34 @@ DILIGENT_TYPED_ENUM(MISC_TEXTURE_FLAGS, Uint8)
     /// Allow automatic mipmap generation with ITextureView::GenerateMips()
 
     /// \note A texture must be created with BIND_RENDER_TARGET bind flag
-    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01
+    MISC_TEXTURE_FLAG_GENERATE_MIPS = 0x01,
+
+    /// The texture is created as a sparse (tiled) resource that has no memory backing.
+    /// Memory is bound to individual tiles with IDeviceContext::UpdateTileMappings().
+
+    /// \note Requires SparseResources device feature. Only 2D textures and 2D texture arrays
+    ///       with one sample and USAGE_DEFAULT usage may be sparse.
+    MISC_TEXTURE_FLAG_SPARSE        = 0x02,
+
+    /// The texture is a transient attachment whose contents only live within a render pass
+    /// and is never loaded from or stored to memory.
+
+    /// \remarks On tile-based GPUs, memoryless attachments are kept in the on-chip tile memory,
+    ///          which saves both the memory and the bandwidth. Typical examples are G-buffer
+    ///          targets that are only read as input attachments, or multisampled targets that
+    ///          are resolved at the end of the render pass.
+    ///
+    ///          The texture must use USAGE_DEFAULT and may only be bound as a render target,
+    ///          depth-stencil or input attachment. It can't be initialized with data, copied,
+    ///          or cleared outside of a render pass; render passes must use ATTACHMENT_LOAD_OP_CLEAR
+    ///          or ATTACHMENT_LOAD_OP_DISCARD load and ATTACHMENT_STORE_OP_DISCARD store operations.
+    ///
+    /// Vulkan backend: the image is created with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT and is
+    ///                 bound to lazily allocated memory when the device exposes it, and to
+    ///                 regular device-local memory otherwise.
+    /// Metal backend:  the texture uses MTLStorageModeMemoryless.
+    /// Other backends: the flag is ignored and the texture is created as a regular texture.
+    MISC_TEXTURE_FLAG_MEMORYLESS    = 0x04
 };
 DEFINE_FLAG_ENUM_OPERATORS(MISC_TEXTURE_FLAGS)
 
@@ -1158,7 +1185,16 @@ DILIGENT_TYPED_ENUM(MEMORY_PROPERTIES, Uint32)
     /// being modified by the CPU, or invalidated before being read by the CPU.
     ///
     /// \sa IBuffer::GetMemoryProperties().
-    MEMORY_PROPERTY_HOST_COHERENT = 0x01
+    MEMORY_PROPERTY_HOST_COHERENT = 0x01,
+
+    /// CPU accesses to the memory are cached on the host. Reading from cached
+    /// memory is much faster than from uncached (write-combined) memory, which
+    /// makes it the preferred choice for readback buffers. If cached memory is
+    /// not also coherent, it is invalidated by the engine when the buffer is mapped
+    /// for reading.
+    ///
+    /// \sa IBuffer::GetMemoryProperties().
+    MEMORY_PROPERTY_HOST_CACHED   = 0x02
 };
 DEFINE_FLAG_ENUM_OPERATORS(MEMORY_PROPERTIES)
 
@@ -1679,6 +1715,23 @@ struct DeviceFeatures
     /// Indicates if device supports tile shaders.
     DEVICE_FEATURE_STATE TileShaders                      DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports sparse (tiled) textures, see Diligent::MISC_TEXTURE_FLAG_SPARSE.
+    DEVICE_FEATURE_STATE SparseResources                  DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports specialization constants, see Diligent::SpecializationConstant.
+    DEVICE_FEATURE_STATE SpecializationConstants          DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports dynamic pipeline states, see Diligent::DYNAMIC_STATE_FLAGS.
+    DEVICE_FEATURE_STATE DynamicPipelineStates            DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports querying GPU virtual addresses of buffers,
+    /// see Diligent::MISC_BUFFER_FLAG_DEVICE_ADDRESS.
+    DEVICE_FEATURE_STATE BufferDeviceAddress              DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
+    /// Indicates if device supports skipping rendering commands on the GPU based on
+    /// the result of a binary occlusion query, see IDeviceContext::BeginConditionalRendering().
+    DEVICE_FEATURE_STATE ConditionalRendering             DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 #if DILIGENT_CPP_INTERFACE
     DeviceFeatures() noexcept {}
 
@@ -1719,10 +1772,15 @@ struct DeviceFeatures
         WaveOp                            {State},
         InstanceDataStepRate              {State},
         NativeFence                       {State},
-        TileShaders                       {State}
+        TileShaders                       {State},
+        SparseResources                   {State},
+        SpecializationConstants           {State},
+        DynamicPipelineStates             {State},
+        BufferDeviceAddress               {State},
+        ConditionalRendering              {State}
     {
 #   if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(*this) == 37, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
+        static_assert(sizeof(*this) == 42, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
 #   endif
     }
 #endif
@@ -1995,6 +2053,10 @@ struct RayTracingProperties
     /// The maximum number of geometries in a bottom-level AS.
     Uint32 MaxGeometriesPerBLAS     DEFAULT_INITIALIZER(0);
 
+    /// Required alignment, in bytes, of the scratch buffer offsets used to build acceleration structures.
+    /// IDeviceContext::BuildBLASBatch() rounds the scratch region of every build up to this value.
+    Uint32 ScratchBufferAlignment   DEFAULT_INITIALIZER(0);
+
     /// Ray tracing capability flags, see Diligent::RAY_TRACING_CAP_FLAGS.
     RAY_TRACING_CAP_FLAGS CapFlags  DEFAULT_INITIALIZER(RAY_TRACING_CAP_FLAG_NONE);
 };
@@ -2010,6 +2072,90 @@ struct MeshShaderProperties
 typedef struct MeshShaderProperties MeshShaderProperties;
 
 
+/// Draw command capability flags
+DILIGENT_TYPED_ENUM(DRAW_COMMAND_CAP_FLAGS, Uint8)
+{
+    /// No draw command capabilities
+    DRAW_COMMAND_CAP_FLAG_NONE                       = 0x00,
+
+    /// The device natively executes multiple indirect draw commands in one call
+    /// (see DrawIndirectAttribs::DrawCount and DrawIndexedIndirectAttribs::DrawCount).
+    /// When this flag is not set, multiple commands are emulated by a sequence of indirect draw calls.
+    DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT = 0x01,
+
+    /// The device supports IDeviceContext::DrawIndirectCount() and IDeviceContext::DrawIndexedIndirectCount() commands.
+    DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT        = 0x02
+};
+DEFINE_FLAG_ENUM_OPERATORS(DRAW_COMMAND_CAP_FLAGS)
+
+
+/// Draw command properties
+struct DrawCommandProperties
+{
+    /// Draw command capability flags, see Diligent::DRAW_COMMAND_CAP_FLAGS.
+    DRAW_COMMAND_CAP_FLAGS CapFlags DEFAULT_INITIALIZER(DRAW_COMMAND_CAP_FLAG_NONE);
+
+    /// The maximum number of commands that can be executed by a single indirect draw call
+    /// (see DrawIndirectAttribs::DrawCount and DrawIndirectCountAttribs::MaxCommandCount).
+    Uint32 MaxDrawIndirectCount     DEFAULT_INITIALIZER(0);
+};
+typedef struct DrawCommandProperties DrawCommandProperties;
+
+
+/// Command list capability flags
+DILIGENT_TYPED_ENUM(COMMAND_LIST_CAP_FLAGS, Uint8)
+{
+    /// No command list capabilities
+    COMMAND_LIST_CAP_FLAG_NONE                         = 0x00,
+
+    /// Command lists recorded by deferred contexts are natively supported by the driver.
+    /// When this flag is not set, the graphics API runtime emulates command lists by recording
+    /// commands in software and replaying them in the immediate context, which makes
+    /// multithreaded recording considerably less efficient.
+    COMMAND_LIST_CAP_FLAG_NATIVE_COMMAND_LISTS         = 0x01,
+
+    /// The driver supports creating resources from multiple threads concurrently.
+    /// When this flag is not set, the graphics API runtime serializes resource creation.
+    COMMAND_LIST_CAP_FLAG_CONCURRENT_RESOURCE_CREATION = 0x02
+};
+DEFINE_FLAG_ENUM_OPERATORS(COMMAND_LIST_CAP_FLAGS)
+
+
+/// Command list properties
+struct CommandListProperties
+{
+    /// Command list capability flags, see Diligent::COMMAND_LIST_CAP_FLAGS.
+    COMMAND_LIST_CAP_FLAGS CapFlags DEFAULT_INITIALIZER(COMMAND_LIST_CAP_FLAG_NONE);
+};
+typedef struct CommandListProperties CommandListProperties;
+
+
+/// Time spent in the phases of render device initialization
+
+/// All times are in milliseconds. Phases that were not performed by the engine
+/// (e.g. instance and device creation when the engine is attached to an existing
+/// native device) are zero.
+struct DeviceInitStatistics
+{
+    /// Graphics API instance (or DXGI factory) creation and adapter selection.
+    float InstanceTime      DEFAULT_INITIALIZER(0);
+
+    /// Native logical device and command queue creation.
+    float DeviceTime        DEFAULT_INITIALIZER(0);
+
+    /// Render device object initialization: memory managers, descriptor pools and heaps,
+    /// upload and dynamic heaps. In OpenGL backend, this also includes GL context creation.
+    float RenderDeviceTime  DEFAULT_INITIALIZER(0);
+
+    /// Immediate and deferred device context creation.
+    float ContextsTime      DEFAULT_INITIALIZER(0);
+
+    /// Total initialization time.
+    float TotalTime         DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceInitStatistics DeviceInitStatistics;
+
+
 /// Render device information
 struct RenderDeviceInfo
 {
@@ -2031,6 +2177,17 @@ struct RenderDeviceInfo
     ///       feature, but if it is not enabled, an application must not use it.
     DeviceFeatures Features;
 
+    /// The number of physical GPUs (nodes) driven by the device.
+
+    /// \remarks The value is greater than 1 when the device was created over a Vulkan device
+    ///          group (see EngineVkCreateInfo::EnableDeviceGroup) or a linked Direct3D12 adapter.
+    ///          Immediate contexts may be restricted to a subset of the nodes through
+    ///          ImmediateContextCreateInfo::NodeMask.
+    Uint32 NumNodes DEFAULT_INITIALIZER(1);
+
+    /// Device initialization statistics, see Diligent::DeviceInitStatistics.
+    DeviceInitStatistics InitStats;
+
 #if DILIGENT_CPP_INTERFACE
     bool IsGLDevice()const
     {
@@ -2113,6 +2270,41 @@ DILIGENT_TYPED_ENUM(VALIDATION_FLAGS, Uint32)
 DEFINE_FLAG_ENUM_OPERATORS(VALIDATION_FLAGS)
 
 
+/// Categories of the engine's own validation checks.
+
+/// The checks are only performed in Debug/Development builds. A category can be disabled
+/// at run time through EngineCreateInfo::ValidationCategories, or removed at compile time
+/// by defining DILIGENT_VALIDATION_CATEGORIES (see DILIGENT_VALIDATION_CATEGORIES CMake variable).
+DILIGENT_TYPED_ENUM(VALIDATION_CATEGORY, Uint32)
+{
+    /// No validation checks are performed.
+    VALIDATION_CATEGORY_NONE              = 0x00,
+
+    /// Draw, dispatch and trace rays command arguments as well as bound render targets.
+    VALIDATION_CATEGORY_DRAW              = 0x01,
+
+    /// Compatibility of committed shader resource bindings with the pipeline state
+    /// and validity of the resources bound to them.
+    VALIDATION_CATEGORY_RESOURCE_BINDING  = 0x02,
+
+    /// Resource state transition descriptions and resource states required by commands.
+    VALIDATION_CATEGORY_STATE_TRANSITIONS = 0x04,
+
+    /// Development-only checks performed when pipeline states and other objects are created.
+    ///
+    /// \note  Checks that guard the engine from invalid create info are performed in all builds
+    ///        and are not affected by this flag.
+    VALIDATION_CATEGORY_OBJECT_CREATION   = 0x08,
+
+    /// All validation categories.
+    VALIDATION_CATEGORY_ALL = VALIDATION_CATEGORY_DRAW |
+                              VALIDATION_CATEGORY_RESOURCE_BINDING |
+                              VALIDATION_CATEGORY_STATE_TRANSITIONS |
+                              VALIDATION_CATEGORY_OBJECT_CREATION
+};
+DEFINE_FLAG_ENUM_OPERATORS(VALIDATION_CATEGORY)
+
+
 /// Command queue type
 DILIGENT_TYPED_ENUM(COMMAND_QUEUE_TYPE, Uint8)
 {
@@ -2166,6 +2358,30 @@ DILIGENT_TYPED_ENUM(QUEUE_PRIORITY, Uint8)
 };
 
 
+/// Memory priority hint
+
+/// The priority tells the driver which allocations should stay in device-local memory
+/// when video memory is oversubscribed: memory of lower-priority resources is demoted first.
+/// The hint is only used by the Vulkan backend when VK_EXT_memory_priority is supported,
+/// and is ignored by other backends.
+DILIGENT_TYPED_ENUM(MEMORY_PRIORITY, Uint8)
+{
+    /// Default priority.
+    /// Vulkan backend: 0.5
+    MEMORY_PRIORITY_DEFAULT = 0,
+
+    /// Resources that may be demoted first, e.g. distant LOD textures or streaming data.
+    /// Vulkan backend: 0.25
+    MEMORY_PRIORITY_LOW,
+
+    /// Resources that should stay in video memory, e.g. render targets and depth buffers.
+    /// Vulkan backend: 1.0
+    MEMORY_PRIORITY_HIGH,
+
+    MEMORY_PRIORITY_LAST = MEMORY_PRIORITY_HIGH
+};
+
+
 /// Device memory properties
 struct AdapterMemoryInfo
 {
@@ -2262,6 +2478,12 @@ struct GraphicsAdapterInfo
     /// Mesh shader properties, see Diligent::MeshShaderProperties.
     MeshShaderProperties MeshShader;
 
+    /// Draw command properties, see Diligent::DrawCommandProperties.
+    DrawCommandProperties DrawCommand;
+
+    /// Command list properties, see Diligent::CommandListProperties.
+    CommandListProperties CommandList;
+
     /// Supported device features, see Diligent::DeviceFeatures.
 
     /// \note The feature state indicates:
@@ -2275,10 +2497,392 @@ struct GraphicsAdapterInfo
 
     /// The number of queues in Queues array.
     Uint32     NumQueues DEFAULT_INITIALIZER(0);
+
+    /// The number of physical GPUs (nodes) in the adapter.
+
+    /// \remarks Direct3D12 backend: the node count of a linked adapter.
+    ///          Vulkan backend:     the number of physical devices in the device group
+    ///                              this adapter belongs to.
+    ///          Other backends:     always 1.
+    Uint32     NumNodes  DEFAULT_INITIALIZER(1);
 };
 typedef struct GraphicsAdapterInfo GraphicsAdapterInfo;
 
 
+/// Memory usage of a memory heap or a memory type, see Diligent::RenderDeviceMemoryStatistics.
+struct MemoryUsageStatistics
+{
+    /// The total size of device memory allocated by the engine, in bytes.
+    Uint64 AllocatedSize     DEFAULT_INITIALIZER(0);
+
+    /// The total size of the allocated memory that is used by resources, in bytes.
+    Uint64 UsedSize          DEFAULT_INITIALIZER(0);
+
+    /// The peak value of AllocatedSize.
+    Uint64 PeakAllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// The peak value of UsedSize.
+    Uint64 PeakUsedSize      DEFAULT_INITIALIZER(0);
+
+    /// The number of device memory objects allocated by the engine.
+    Uint32 NumAllocations    DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryUsageStatistics MemoryUsageStatistics;
+
+
+/// Memory usage of a memory heap, see Diligent::RenderDeviceMemoryStatistics.
+struct MemoryHeapStatistics
+{
+    /// Memory used by the engine in this heap, see Diligent::MemoryUsageStatistics.
+    MemoryUsageStatistics Usage;
+
+    /// The amount of memory in this heap that the process can use without
+    /// degrading performance, as reported by the driver, in bytes.
+    /// Zero if the budget is not available.
+    Uint64 Budget       DEFAULT_INITIALIZER(0);
+
+    /// The amount of memory in this heap that is used by the process, as reported
+    /// by the driver, in bytes. Unlike Usage, includes memory allocated outside of the engine.
+    /// Zero if the budget is not available.
+    Uint64 ProcessUsage DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryHeapStatistics MemoryHeapStatistics;
+
+
+/// Objects and memory reserved by the internal helpers of the render device,
+/// see Diligent::RenderDeviceMemoryStatistics.
+
+/// Helpers are created when they are used for the first time, so all values are zero
+/// for a device that has not generated mips, used queries or mapped dynamic resources.
+struct DeviceHelperStatistics
+{
+    /// The number of pipeline states created by the mipmap generation helper.
+    Uint32 NumMipGenerationPSOs    DEFAULT_INITIALIZER(0);
+
+    /// The total size of the buffers created by the mipmap generation helper, in bytes.
+    Uint64 MipGenerationBufferSize DEFAULT_INITIALIZER(0);
+
+    /// The number of query heaps (query pools in Vulkan) created by the query managers.
+    Uint32 NumQueryHeaps           DEFAULT_INITIALIZER(0);
+
+    /// The total number of queries in all created query heaps.
+    Uint32 NumQueries              DEFAULT_INITIALIZER(0);
+
+    /// The size of the buffer that query data is resolved to, in bytes (Direct3D12 only).
+    Uint64 QueryResolveBufferSize  DEFAULT_INITIALIZER(0);
+
+    /// The size of the memory reserved for dynamic resources, in bytes.
+    Uint64 DynamicHeapSize         DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceHelperStatistics DeviceHelperStatistics;
+
+
+/// Render device memory statistics, see IRenderDevice::GetMemoryStatistics().
+struct RenderDeviceMemoryStatistics
+{
+    /// The number of elements in Heaps array.
+    Uint32 NumHeaps       DEFAULT_INITIALIZER(0);
+
+    /// The number of elements in MemoryTypes and MemoryTypeHeaps arrays.
+    Uint32 NumMemoryTypes DEFAULT_INITIALIZER(0);
+
+    /// Per-heap memory statistics, see Diligent::MemoryHeapStatistics.
+    MemoryHeapStatistics  Heaps[DILIGENT_MAX_MEMORY_HEAPS] DEFAULT_INITIALIZER({});
+
+    /// Per-memory-type memory statistics, see Diligent::MemoryUsageStatistics.
+
+    /// \remarks In Vulkan, memory types correspond to VkPhysicalDeviceMemoryProperties::memoryTypes.
+    ///          In Direct3D12, memory type 0 is the upload memory used by dynamic resources (heap 0),
+    ///          and memory type 1 is the default-heap memory of the placed resource heaps (heap 1),
+    ///          see EngineD3D12CreateInfo::PlacedResourceHeapPageSize.
+    MemoryUsageStatistics MemoryTypes[DILIGENT_MAX_MEMORY_TYPES] DEFAULT_INITIALIZER({});
+
+    /// The index of the heap in Heaps array that every memory type belongs to.
+    Uint32 MemoryTypeHeaps[DILIGENT_MAX_MEMORY_TYPES] DEFAULT_INITIALIZER({});
+
+    /// Objects and memory reserved by the internal helpers, see Diligent::DeviceHelperStatistics.
+
+    /// \remarks Only Vulkan and Direct3D12 backends report helper statistics.
+    DeviceHelperStatistics Helpers;
+};
+typedef struct RenderDeviceMemoryStatistics RenderDeviceMemoryStatistics;
+
+
+/// Framebuffer cache statistics, see IRenderDeviceVk::GetFramebufferCacheStatistics()
+/// and IRenderDeviceGL::GetFramebufferCacheStatistics().
+struct FramebufferCacheStatistics
+{
+    /// The number of framebuffers currently in the cache.
+    Uint32 NumFramebuffers DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that found an existing framebuffer.
+    Uint64 NumHits         DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that created a new framebuffer.
+    Uint64 NumMisses       DEFAULT_INITIALIZER(0);
+
+    /// The number of framebuffers removed by the cache eviction policy.
+    /// Framebuffers that are removed because their attachments are destroyed are not counted.
+    Uint64 NumEvictions    DEFAULT_INITIALIZER(0);
+};
+typedef struct FramebufferCacheStatistics FramebufferCacheStatistics;
+
+
+/// Device object type, see Diligent::LiveObjectInfo.
+DILIGENT_TYPED_ENUM(DEVICE_OBJECT_TYPE, Uint8)
+{
+    /// Internal device object of unknown type.
+    DEVICE_OBJECT_TYPE_UNKNOWN = 0,
+
+    /// Buffer, see Diligent::IBuffer.
+    DEVICE_OBJECT_TYPE_BUFFER,
+
+    /// Buffer view, see Diligent::IBufferView.
+    DEVICE_OBJECT_TYPE_BUFFER_VIEW,
+
+    /// Texture, see Diligent::ITexture.
+    DEVICE_OBJECT_TYPE_TEXTURE,
+
+    /// Texture view, see Diligent::ITextureView.
+    DEVICE_OBJECT_TYPE_TEXTURE_VIEW,
+
+    /// Sampler, see Diligent::ISampler.
+    DEVICE_OBJECT_TYPE_SAMPLER,
+
+    /// Shader, see Diligent::IShader.
+    DEVICE_OBJECT_TYPE_SHADER,
+
+    /// Pipeline state, see Diligent::IPipelineState.
+    DEVICE_OBJECT_TYPE_PIPELINE_STATE,
+
+    /// Shader resource binding, see Diligent::IShaderResourceBinding.
+    DEVICE_OBJECT_TYPE_SHADER_RESOURCE_BINDING,
+
+    /// Pipeline resource signature, see Diligent::IPipelineResourceSignature.
+    DEVICE_OBJECT_TYPE_PIPELINE_RESOURCE_SIGNATURE,
+
+    /// Fence, see Diligent::IFence.
+    DEVICE_OBJECT_TYPE_FENCE,
+
+    /// Query, see Diligent::IQuery.
+    DEVICE_OBJECT_TYPE_QUERY,
+
+    /// Render pass, see Diligent::IRenderPass.
+    DEVICE_OBJECT_TYPE_RENDER_PASS,
+
+    /// Framebuffer, see Diligent::IFramebuffer.
+    DEVICE_OBJECT_TYPE_FRAMEBUFFER,
+
+    /// Bottom-level acceleration structure, see Diligent::IBottomLevelAS.
+    DEVICE_OBJECT_TYPE_BOTTOM_LEVEL_AS,
+
+    /// Top-level acceleration structure, see Diligent::ITopLevelAS.
+    DEVICE_OBJECT_TYPE_TOP_LEVEL_AS,
+
+    /// Shader binding table, see Diligent::IShaderBindingTable.
+    DEVICE_OBJECT_TYPE_SHADER_BINDING_TABLE,
+
+    /// Pipeline state cache, see Diligent::IPipelineStateCache.
+    DEVICE_OBJECT_TYPE_PIPELINE_STATE_CACHE,
+
+    /// Resource heap, see Diligent::IResourceHeap.
+    DEVICE_OBJECT_TYPE_RESOURCE_HEAP,
+
+    /// Command list, see Diligent::ICommandList.
+    DEVICE_OBJECT_TYPE_COMMAND_LIST,
+
+    /// Helper value that stores the total number of device object types in the enumeration.
+    DEVICE_OBJECT_TYPE_COUNT
+};
+
+
+/// Live device object information, see IRenderDevice::CaptureResourceSnapshot().
+struct LiveObjectInfo
+{
+    /// Object name.
+    const Char*        Name          DEFAULT_INITIALIZER(nullptr);
+
+    /// Device-wide serial number of the object.
+
+    /// Serial numbers are assigned in the order the objects are created and are never reused,
+    /// so they identify the same object in different snapshots.
+    Uint64             SerialNumber  DEFAULT_INITIALIZER(0);
+
+    /// The frame in which the object was created, see ResourceSnapshot::FrameNumber.
+    Uint64             CreationFrame DEFAULT_INITIALIZER(0);
+
+    /// The estimated size of the object memory, in bytes. Only reported for buffers and
+    /// textures, and does not include the alignment and padding added by the driver.
+    Uint64             Size          DEFAULT_INITIALIZER(0);
+
+    /// Object type, see Diligent::DEVICE_OBJECT_TYPE.
+    DEVICE_OBJECT_TYPE Type          DEFAULT_INITIALIZER(DEVICE_OBJECT_TYPE_UNKNOWN);
+};
+typedef struct LiveObjectInfo LiveObjectInfo;
+
+
+/// Occupancy of a pool of fixed-size memory blocks, see Diligent::ResourceSnapshot.
+struct ObjectPoolStatistics
+{
+    /// The number of blocks that are currently allocated.
+    Uint32 NumAllocatedBlocks DEFAULT_INITIALIZER(0);
+
+    /// The total number of blocks in all pages of the pool.
+    Uint32 NumReservedBlocks  DEFAULT_INITIALIZER(0);
+
+    /// The total size of the allocated blocks, in bytes.
+    Uint64 AllocatedSize      DEFAULT_INITIALIZER(0);
+
+    /// The total size of all pages of the pool, in bytes.
+    Uint64 ReservedSize       DEFAULT_INITIALIZER(0);
+};
+typedef struct ObjectPoolStatistics ObjectPoolStatistics;
+
+
+/// Resource snapshot, see IRenderDevice::CaptureResourceSnapshot().
+
+/// All values are plain counters, so the difference between two snapshots shows
+/// which object types, pools, caches or release queues grow.
+struct ResourceSnapshot
+{
+    /// The number of frames finished by the first immediate context when the snapshot was captured.
+    Uint64 FrameNumber DEFAULT_INITIALIZER(0);
+
+    /// The number of live objects of every type, indexed by Diligent::DEVICE_OBJECT_TYPE.
+    Uint32 NumObjects[DEVICE_OBJECT_TYPE_COUNT]  DEFAULT_INITIALIZER({});
+
+    /// The total estimated memory size of the live objects of every type, in bytes,
+    /// indexed by Diligent::DEVICE_OBJECT_TYPE. See LiveObjectInfo::Size.
+    Uint64 ObjectSizes[DEVICE_OBJECT_TYPE_COUNT] DEFAULT_INITIALIZER({});
+
+    /// Occupancy of the pools that the render device allocates objects of every type from,
+    /// indexed by Diligent::DEVICE_OBJECT_TYPE.
+    ObjectPoolStatistics ObjectPools[DEVICE_OBJECT_TYPE_COUNT] DEFAULT_INITIALIZER({});
+
+    /// Occupancy of the pools that pipeline resource signatures allocate the shader resource
+    /// binding data from, see PipelineResourceSignatureDesc::SRBAllocationGranularity.
+    ObjectPoolStatistics SRBDataPools;
+
+    /// The number of render passes in the implicit render pass cache (Vulkan only).
+    Uint32 NumCachedRenderPasses      DEFAULT_INITIALIZER(0);
+
+    /// The number of framebuffers in the framebuffer cache (Vulkan) or FBOs in the FBO caches (OpenGL).
+    Uint32 NumCachedFramebuffers      DEFAULT_INITIALIZER(0);
+
+    /// The number of vertex array objects in the VAO caches (OpenGL only).
+    Uint32 NumCachedVAOs              DEFAULT_INITIALIZER(0);
+
+    /// The number of resources in the release queues that wait for a command list
+    /// to be submitted (Direct3D12 and Vulkan only).
+    Uint32 NumStaleResources          DEFAULT_INITIALIZER(0);
+
+    /// The number of resources in the release queues that wait for the GPU
+    /// to finish the submitted command lists (Direct3D12 and Vulkan only).
+    Uint32 NumPendingReleaseResources DEFAULT_INITIALIZER(0);
+};
+typedef struct ResourceSnapshot ResourceSnapshot;
+
+
+/// Dynamic heap statistics, see IRenderDeviceVk::GetDynamicHeapStatistics().
+struct DynamicHeapStatistics
+{
+    /// The size of the dynamic heap, in bytes.
+    Uint64 Size                 DEFAULT_INITIALIZER(0);
+
+    /// The size of the memory currently allocated from the heap, in bytes.
+    Uint64 UsedSize             DEFAULT_INITIALIZER(0);
+
+    /// The largest size of the memory allocated from the heap during the last finished frame, in bytes.
+    Uint64 LastFramePeakSize    DEFAULT_INITIALIZER(0);
+
+    /// The largest size of the memory allocated from the heap since the device was created, in bytes.
+    Uint64 PeakSize             DEFAULT_INITIALIZER(0);
+
+    /// The number of frames finished since the device was created.
+    Uint64 NumFrames            DEFAULT_INITIALIZER(0);
+
+    /// The number of allocations that failed because the heap was exhausted.
+    Uint32 NumFailedAllocations DEFAULT_INITIALIZER(0);
+};
+typedef struct DynamicHeapStatistics DynamicHeapStatistics;
+
+
+/// OpenGL state cache counters for one kind of binding, see Diligent::GLStateCacheStatistics.
+struct GLStateCacheCounters
+{
+    /// The number of bindings that changed the GL state and were sent to the driver.
+    Uint32 Issued   DEFAULT_INITIALIZER(0);
+
+    /// The number of bindings that were filtered out because the object was already bound.
+    Uint32 Filtered DEFAULT_INITIALIZER(0);
+};
+typedef struct GLStateCacheCounters GLStateCacheCounters;
+
+
+/// OpenGL context state cache statistics, see IDeviceContextGL::GetStateCacheStatistics().
+struct GLStateCacheStatistics
+{
+    /// Texture bindings.
+    GLStateCacheCounters Textures;
+
+    /// Sampler bindings.
+    GLStateCacheCounters Samplers;
+
+    /// Uniform buffer bindings.
+    GLStateCacheCounters UniformBuffers;
+
+    /// Shader storage block bindings.
+    GLStateCacheCounters StorageBlocks;
+
+    /// Image bindings.
+    GLStateCacheCounters Images;
+
+    /// The number of glBindTextures, glBindSamplers and glBindBuffersRange calls that
+    /// bound several consecutive slots at once. Bindings made by these calls are
+    /// included in the Issued counters.
+    Uint32 NumMultiBindCalls DEFAULT_INITIALIZER(0);
+};
+typedef struct GLStateCacheStatistics GLStateCacheStatistics;
+
+
+/// Memory allocation event type, see Diligent::MemoryAllocationEvent.
+DILIGENT_TYPED_ENUM(MEMORY_ALLOCATION_EVENT_TYPE, Uint8)
+{
+    /// Device memory has been allocated.
+    MEMORY_ALLOCATION_EVENT_TYPE_ALLOCATE = 0,
+
+    /// Device memory has been released.
+    MEMORY_ALLOCATION_EVENT_TYPE_FREE
+};
+
+
+/// Describes a device memory allocation event, see IRenderDevice::SetMemoryAllocationCallback().
+struct MemoryAllocationEvent
+{
+    /// Event type, see Diligent::MEMORY_ALLOCATION_EVENT_TYPE.
+    MEMORY_ALLOCATION_EVENT_TYPE Type DEFAULT_INITIALIZER(MEMORY_ALLOCATION_EVENT_TYPE_ALLOCATE);
+
+    /// Whether the memory is dedicated to a single resource.
+    Bool   IsDedicated     DEFAULT_INITIALIZER(False);
+
+    /// Memory type index, see RenderDeviceMemoryStatistics::MemoryTypes.
+    Uint32 MemoryTypeIndex DEFAULT_INITIALIZER(0);
+
+    /// Memory heap index, see RenderDeviceMemoryStatistics::Heaps.
+    Uint32 HeapIndex       DEFAULT_INITIALIZER(0);
+
+    /// The size of the allocated or released memory, in bytes.
+    Uint64 Size            DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryAllocationEvent MemoryAllocationEvent;
+
+/// Type of the memory allocation callback function, see IRenderDevice::SetMemoryAllocationCallback().
+
+/// \param [in] pEvent    - Memory allocation event, see Diligent::MemoryAllocationEvent.
+/// \param [in] pUserData - User data pointer that was passed to SetMemoryAllocationCallback().
+typedef void (*MemoryAllocationCallbackType)(const MemoryAllocationEvent* pEvent, void* pUserData);
+
+
 /// Immediate device context create info
 struct ImmediateContextCreateInfo
 {
@@ -2300,6 +2904,20 @@ struct ImmediateContextCreateInfo
     /// Other backends:     queue priority is ignored.
     QUEUE_PRIORITY Priority     DEFAULT_INITIALIZER(QUEUE_PRIORITY_MEDIUM);
 
+    /// Bit mask of the nodes (physical GPUs) the context's commands are executed on.
+
+    /// \remarks Bit i corresponds to node i, see RenderDeviceInfo::NumNodes.
+    ///          Zero means all nodes of the device.
+    ///
+    /// Direct3D12 backend: the context's command queue is created on the lowest node in the mask.
+    ///                     Default-heap resources are created on the node of the first context
+    ///                     in their ImmediateContextMask and are visible to all nodes.
+    /// Vulkan backend:     the mask is used as the device mask of the command buffers submitted
+    ///                     by the context. Device-local memory of resources that are only used by
+    ///                     contexts running on a subset of the nodes is allocated on these nodes.
+    /// Other backends:     node mask is ignored.
+    Uint32         NodeMask     DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     ImmediateContextCreateInfo() noexcept {}
 
@@ -2358,6 +2976,62 @@ struct EngineCreateInfo
     ///           deferred contexts to let the engine release stale resources.
     Uint32                   NumDeferredContexts    DEFAULT_INITIALIZER(0);
 
+    /// If set to true and NumImmediateContexts is zero, the default immediate context is created
+    /// for a compute queue (a dedicated compute queue if the adapter has one) rather than for a graphics
+    /// queue, and the device does not request a graphics queue. This is intended for headless servers
+    /// that run no graphics work.
+    ///
+    /// \remarks    This option only has effect in Direct3D12 and Vulkan backends.
+    ///             EngineD3D12CreateInfo::SetComputeOnlyProfile() and EngineVkCreateInfo::SetComputeOnlyProfile()
+    ///             set this member and also reduce the default descriptor and memory budgets.
+    bool                     ComputeOnly            DEFAULT_INITIALIZER(false);
+
+    /// The number of worker threads that the engine uses to create pipeline states
+    /// with PSO_CREATE_FLAG_ASYNCHRONOUS flag and to compile shaders passed to
+    /// IRenderDevice::CreateShaders(). If zero, the number of hardware threads
+    /// minus one is used. The threads are only started when they are first needed.
+    /// This member is ignored if pAsyncTaskPool is not null.
+    Uint32                   NumAsyncWorkerThreads  DEFAULT_INITIALIZER(0);
+
+    /// An optional thread pool that the engine uses to run its asynchronous tasks (see NumAsyncWorkerThreads)
+    /// instead of starting its own worker threads. This way the application and the engine share the same
+    /// threads. The pool can be created with IEngineFactory::CreateThreadPool() or implemented by the application.
+    /// The engine also reads shader include files on this pool (see IEngineFactory::CreateDefaultShaderSourceStreamFactory()).
+    /// The engine keeps a strong reference to the pool until the render device is destroyed.
+    struct IThreadPool*      pAsyncTaskPool         DEFAULT_INITIALIZER(nullptr);
+
+    /// If set to true, resources whose last use has been completed by the GPU are destroyed
+    /// by a dedicated background thread rather than by the thread that purges the release queues
+    /// (e.g. in IDeviceContext::FinishFrame() or IRenderDevice::ReleaseStaleResources()).
+    /// The calling thread then only compares the fence values.
+    /// Resources are always destroyed synchronously when the GPU is idled.
+    ///
+    /// \remarks    This option only has effect in Direct3D12 and Vulkan backends.
+    bool                     AsyncResourceRelease   DEFAULT_INITIALIZER(false);
+
+    /// If set to true, IDeviceContext::ExecuteCommandLists() called on an immediate context does not
+    /// submit the command lists right away. Instead, the lists (together with the commands recorded
+    /// by the immediate context before them) are queued and submitted to the command queue as a single
+    /// batch by the next IDeviceContext::Flush() (which is also called by ISwapChain::Present()).
+    /// This way the submission overhead does not grow with the number of threads that record command lists.
+    ///
+    /// \remarks    Fences enqueued with IDeviceContext::EnqueueSignal() are signaled after the whole batch,
+    ///             so an application that waits for a fence on the CPU must flush the context first.
+    ///
+    ///             This option only has effect in Direct3D12 and Vulkan backends.
+    bool                     BatchCommandListSubmission DEFAULT_INITIALIZER(false);
+
+    /// If set to true, the device records the description of every graphics and compute pipeline state
+    /// it creates, together with the shader byte code and the resource signatures the pipeline uses.
+    /// The recording is retrieved as a pipeline archive with IRenderDevice::GetRecordedPipelineStates(),
+    /// and IRenderDevice::ReplayPipelineStates() recreates the recorded pipelines on the next run,
+    /// for example to fill a pipeline state cache before the pipelines are needed.
+    ///
+    /// \remarks    Only the pipelines whose shaders have byte code are recorded, see IShader::GetBytecode().
+    ///             Recording keeps a copy of all recorded byte code in memory and is intended for
+    ///             test and QA runs rather than for shipping builds.
+    bool                     RecordPipelineStates   DEFAULT_INITIALIZER(false);
+
     /// Requested device features.
 
     /// \remarks    If a feature is requested to be enabled, but is not supported
@@ -2381,13 +3055,29 @@ struct EngineCreateInfo
     /// Validation options, see Diligent::VALIDATION_FLAGS.
     VALIDATION_FLAGS    ValidationFlags             DEFAULT_INITIALIZER(VALIDATION_FLAG_NONE);
 
+    /// Categories of the engine validation checks that are performed in Debug/Development builds,
+    /// see Diligent::VALIDATION_CATEGORY. For instance, profiling builds may keep object creation
+    /// checks while disabling per-draw validation.
+    VALIDATION_CATEGORY ValidationCategories        DEFAULT_INITIALIZER(VALIDATION_CATEGORY_ALL);
+
     /// Pointer to the raw memory allocator that will be used for all memory allocation/deallocation
-    /// operations in the engine
+    /// operations in the engine. Diligent::LargePageMemoryAllocator can be used to back the engine
+    /// heaps with large pages.
     struct IMemoryAllocator* pRawMemAllocator       DEFAULT_INITIALIZER(nullptr);
 
     /// Pointer to the user-specified debug message callback function
     DebugMessageCallbackType DebugMessageCallback   DEFAULT_INITIALIZER(nullptr);
 
+    /// Enables the cache of compiled shader byte code. When the cache is enabled, shaders
+    /// that are created from identical source code with identical macros, compiler and
+    /// compile options are only compiled once. The cache is not used by OpenGL/GLES backend.
+    bool                EnableShaderCache           DEFAULT_INITIALIZER(false);
+
+    /// Optional path to the directory where the shader cache stores compiled byte code, so that
+    /// it can be reused by subsequent runs. If null, the cache is kept in memory only.
+    /// The directory is ignored if EnableShaderCache is false.
+    const Char*         ShaderCacheDirectory        DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     EngineCreateInfo() noexcept
     {
@@ -2411,19 +3101,81 @@ struct EngineCreateInfo
 };
 typedef struct EngineCreateInfo EngineCreateInfo;
 
+/// OpenGL-specific validation options.
+DILIGENT_TYPED_ENUM(GL_VALIDATION_FLAGS, Uint32)
+{
+    /// OpenGL-specific validation is disabled.
+    GL_VALIDATION_FLAG_NONE               = 0x00,
+
+    /// Verify that the bindings tracked by the context state cache match the actual
+    /// OpenGL state every time a redundant binding is filtered out (strict mode).
+    /// This queries the GL state and is very expensive, so it should only be used for engine debugging.
+    /// This option is enabled in validation level 2 (see Diligent::VALIDATION_LEVEL).
+    ///
+    /// \remarks  This flag only has effect in Debug/Development builds.
+    ///           This type of validation is never performed in Release builds.
+    GL_VALIDATION_FLAG_VERIFY_STATE_CACHE = 0x01
+};
+DEFINE_FLAG_ENUM_OPERATORS(GL_VALIDATION_FLAGS)
+
+
 /// Attributes of the OpenGL-based engine implementation
 struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
     /// Native window wrapper
     NativeWindow Window;
 
+    /// The maximum number of framebuffer objects in the FBO cache of every GL context.
+    /// When the limit is reached, the least recently used FBOs that have not been used
+    /// in the current frame are released. When zero, the cache size is not limited.
+    Uint32 FramebufferCacheSize   DEFAULT_INITIALIZER(0);
+
+    /// The number of frames after which an unused framebuffer object is released from the
+    /// FBO cache. Frames are counted by IDeviceContext::FinishFrame().
+    /// When zero, framebuffer objects are only released when their attachments are destroyed
+    /// or the cache size limit is reached.
+    Uint32 FramebufferCacheMaxAge DEFAULT_INITIALIZER(0);
+
+    /// Whether to create a background GL context that shares objects with the main context.
+
+    /// \remarks When the worker context is available, IRenderDevice::CreateBuffer() and
+    ///          IRenderDevice::CreateTexture() may be called from threads that have no current
+    ///          GL context. The worker context is made current in the calling thread for the duration
+    ///          of the call, so concurrent calls are serialized. Before the method returns, it waits
+    ///          on a fence until the GPU has completed the commands that created and initialized
+    ///          the resource, so the resource can be used by the immediate context right away.
+    ///          Other objects must still be created in the thread that owns the main context.
+    ///
+    ///          The worker context is supported on Win32, Linux and Android. The option is
+    ///          ignored on other platforms.
+    Bool CreateWorkerContext DEFAULT_INITIALIZER(False);
+
+    /// OpenGL-specific validation options, see Diligent::GL_VALIDATION_FLAGS.
+    GL_VALIDATION_FLAGS GLValidationFlags DEFAULT_INITIALIZER(GL_VALIDATION_FLAG_NONE);
+
 #if DILIGENT_CPP_INTERFACE
     EngineGLCreateInfo() noexcept : EngineGLCreateInfo{EngineCreateInfo{}}
     {}
 
     explicit EngineGLCreateInfo(const EngineCreateInfo &EngineCI) noexcept :
         EngineCreateInfo{EngineCI}
-    {}
+    {
+#ifdef DILIGENT_DEVELOPMENT
+        SetValidationLevel(VALIDATION_LEVEL_1);
+#endif
+    }
+
+    /// Sets the validation options corresponding to the specified level, see Diligent::VALIDATION_LEVEL.
+    void SetValidationLevel(VALIDATION_LEVEL Level)
+    {
+        EngineCreateInfo::SetValidationLevel(Level);
+
+        GLValidationFlags = GL_VALIDATION_FLAG_NONE;
+        if (Level >= VALIDATION_LEVEL_2)
+        {
+            GLValidationFlags |= GL_VALIDATION_FLAG_VERIFY_STATE_CACHE;
+        }
+    }
 #endif
 };
 typedef struct EngineGLCreateInfo EngineGLCreateInfo;
@@ -2453,6 +3205,20 @@ struct EngineD3D11CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Direct3D11-specific validation options, see Diligent::D3D11_VALIDATION_FLAGS.
     D3D11_VALIDATION_FLAGS D3D11ValidationFlags DEFAULT_INITIALIZER(D3D11_VALIDATION_FLAG_NONE);
 
+    /// Size of the ring buffer that every device context uses to suballocate
+    /// USAGE_DYNAMIC constant buffers. 0 disables suballocation.
+
+    /// \remarks When enabled, mapping a dynamic buffer created with BIND_UNIFORM_BUFFER
+    ///          flag with MAP_FLAG_DISCARD returns a 256-byte aligned region of the context's
+    ///          ring buffer, which is bound with *SSetConstantBuffers1() offsets. The ring
+    ///          buffer is mapped with D3D11_MAP_WRITE_NO_OVERWRITE and is only discarded
+    ///          at the end of the frame, so, similar to Direct3D12 and Vulkan backends,
+    ///          dynamic constant buffers must be mapped in every frame before they are used.
+    ///          When the ring is exhausted, the buffer's own storage is used instead.
+    ///          The option is ignored if the device does not support constant buffer
+    ///          offsetting or no-overwrite maps of dynamic constant buffers.
+    Uint32 DynamicConstantRingSize DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     EngineD3D11CreateInfo() noexcept :
         EngineD3D11CreateInfo{EngineCreateInfo{}}
@@ -2529,6 +3295,14 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// The maximum number of single CPU descriptors that are cached per thread for every CPU descriptor heap.
+
+    /// \remarks Texture and buffer views allocate single CPU descriptors. To reduce contention between
+    ///          threads that create views, every thread allocates descriptors from and frees them to its own
+    ///          cache. The cache is refilled from the heap and trimmed in batches of half this size.
+    ///          0 disables the caches, so that every allocation accesses the heap directly.
+    Uint32 CPUDescriptorThreadCacheSize DEFAULT_INITIALIZER(64);
+
     /// The size of the GPU descriptor heap region designated to static/mutable
     /// shader resource variables.
     /// Every Shader Resource Binding object allocates one descriptor
@@ -2589,6 +3363,13 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// The number of CBV/SRV/UAV descriptors reserved in the static part of the
+    /// shader-visible GPU descriptor heap for the bindless descriptor heap.
+    /// Every texture and buffer SRV and UAV registers a persistent index in this range,
+    /// see ITextureView::GetBindlessIndex(). The value must not exceed GPUDescriptorHeapSize[0].
+    /// When zero, the bindless heap is disabled.
+    Uint32 BindlessHeapSize DEFAULT_INITIALIZER(0);
+
     /// A device context uses dynamic heap when it needs to allocate temporary
     /// CPU-accessible memory to update a resource via IDeviceContext::UpdateBuffer() or
     /// IDeviceContext::UpdateTexture(), or to map dynamic resources.
@@ -2599,8 +3380,37 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 
     /// Number of dynamic heap pages that will be reserved by the
     /// global dynamic heap manager to avoid page creation at run time.
+    /// The pages are reserved when the first page is requested by any context.
     Uint32 NumDynamicHeapPagesToReserve DEFAULT_INITIALIZER(1);
 
+    /// The size of the ID3D12Heap blocks that default-usage buffers and textures are
+    /// placed in. Every block is shared by many placed resources, which avoids the heap
+    /// and kernel allocation that every committed resource requires.
+    /// Render targets, depth-stencil and multisample textures as well as resources larger
+    /// than half of the block are always created as committed resources.
+    /// When zero, all resources are created as committed resources.
+    Uint32 PlacedResourceHeapPageSize    DEFAULT_INITIALIZER(64 << 20);
+
+    /// The amount of memory in placed resource heaps that is kept allocated
+    /// when the heaps become empty.
+    Uint32 PlacedResourceHeapReserveSize DEFAULT_INITIALIZER(256 << 20);
+
+    /// Whether to manage the residency of committed resources and placed resource heaps.
+    /// When enabled, resources used by every command list are made resident before the
+    /// command list is submitted, and resources that have not been used for ResidencyEvictionFrameCount
+    /// frames are evicted when the video memory usage exceeds the budget reported by the OS.
+    /// Frames end when the swap chain is presented or IRenderDevice::ReleaseStaleResources() is called.
+    /// Residency management is not available when the bindless heap is enabled (see BindlessHeapSize),
+    /// because resources accessed through the bindless heap can't be tracked.
+    Bool EnableResidencyManagement DEFAULT_INITIALIZER(False);
+
+    /// The number of frames a resource must stay unused before it can be evicted.
+    Uint32 ResidencyEvictionFrameCount DEFAULT_INITIALIZER(8);
+
+    /// The video memory budget, in bytes, that residency management keeps the usage within.
+    /// When zero, the budget reported by IDXGIAdapter3::QueryVideoMemoryInfo() is used.
+    Uint64 ResidencyMemoryBudget DEFAULT_INITIALIZER(0);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -2647,6 +3457,31 @@ struct EngineD3D12CreateInfo DILIGENT_DERIVE(EngineCreateInfo)
             D3D12ValidationFlags |= D3D12_VALIDATION_FLAG_ENABLE_GPU_BASED_VALIDATION;
         }
     }
+
+    /// Configures a compute-only device with a single compute context (see EngineCreateInfo::ComputeOnly)
+    /// and descriptor and memory budgets that suit compute workloads: render target, depth-stencil
+    /// and sampler descriptor heaps are minimal, and dynamic heaps are smaller.
+    void SetComputeOnlyProfile()
+    {
+        ComputeOnly = true;
+
+        CPUDescriptorHeapAllocationSize[0] = 4096; // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+        CPUDescriptorHeapAllocationSize[1] = 128;  // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
+        CPUDescriptorHeapAllocationSize[2] = 16;   // D3D12_DESCRIPTOR_HEAP_TYPE_RTV
+        CPUDescriptorHeapAllocationSize[3] = 16;   // D3D12_DESCRIPTOR_HEAP_TYPE_DSV
+
+        GPUDescriptorHeapSize[0]        = 8192; // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+        GPUDescriptorHeapSize[1]        = 128;  // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
+        GPUDescriptorHeapDynamicSize[0] = 4096; // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV
+        GPUDescriptorHeapDynamicSize[1] = 128;  // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
+
+        DynamicHeapPageSize           = 256 << 10;
+        PlacedResourceHeapReserveSize = 64 << 20;
+
+        QueryPoolSizes[QUERY_TYPE_OCCLUSION]           = 0;
+        QueryPoolSizes[QUERY_TYPE_BINARY_OCCLUSION]    = 0;
+        QueryPoolSizes[QUERY_TYPE_PIPELINE_STATISTICS] = 16;
+    }
 #endif
 };
 typedef struct EngineD3D12CreateInfo EngineD3D12CreateInfo;
@@ -2745,6 +3580,25 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
 #endif
     ;
 
+    /// The number of descriptors of each type (sampled image, storage image,
+    /// uniform texel buffer, storage texel buffer and storage buffer) in the global
+    /// bindless descriptor set. Every texture and buffer SRV and UAV registers a persistent
+    /// index in the set, see ITextureView::GetBindlessIndex().
+    /// The set is allocated with VK_EXT_descriptor_indexing update-after-bind flags and
+    /// requires BindlessResources and ShaderResourceRuntimeArray features.
+    /// When zero, the bindless heap is disabled.
+    Uint32 BindlessHeapSize DEFAULT_INITIALIZER(0);
+
+    /// The size, in bytes, of the global descriptor buffer.
+    /// When non-zero and the device supports VK_EXT_descriptor_buffer (Vulkan 1.3 is required),
+    /// resource signatures lay out their descriptors in GPU-visible buffers instead of descriptor sets:
+    /// static and mutable descriptors of every SRB are suballocated from the global descriptor buffer,
+    /// dynamic descriptors are written into the dynamic heap on every commit, and descriptors are
+    /// written with vkGetDescriptorEXT directly into mapped memory.
+    /// Descriptor buffers are not used when the bindless heap is enabled (see BindlessHeapSize).
+    /// When zero, descriptor buffers are disabled.
+    Uint32 DescriptorBufferSize DEFAULT_INITIALIZER(0);
+
     /// Allocation granularity for device-local memory
     Uint32 DeviceLocalMemoryPageSize        DEFAULT_INITIALIZER(16 << 20);
 
@@ -2761,6 +3615,15 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// pages when resources are released
     Uint32 HostVisibleMemoryReserveSize     DEFAULT_INITIALIZER(256 << 20);
 
+    /// The maximum amount of memory that every immediate context moves per frame
+    /// to defragment sparsely occupied device-local memory pages.
+    /// Only default and immutable buffers that are used exclusively as vertex, index
+    /// or indirect argument buffers by a single immediate context are relocated.
+    /// Relocation replaces the Vulkan buffer handle, so applications that enable defragmentation
+    /// must not cache the handles returned by IBufferVk::GetVkBuffer() across frames.
+    /// When zero, defragmentation is disabled.
+    Uint32 MemoryDefragmentationBudget      DEFAULT_INITIALIZER(0);
+
     /// Page size of the upload heap that is allocated by immediate/deferred
     /// contexts from the global memory manager to perform lock-free dynamic
     /// suballocations.
@@ -2768,14 +3631,30 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// and IDeviceContext::UpdateTexture().
     Uint32 UploadHeapPageSize               DEFAULT_INITIALIZER(1 << 20);
 
+    /// The maximum total size of upload heap pages that every device context keeps when
+    /// the frame is finished, and reuses in the following frames once the GPU has completed
+    /// the commands that used them, instead of allocating new pages. This avoids re-creating
+    /// large staging buffers when big resources are updated every frame.
+    /// When zero, all pages are released at the end of every frame.
+    Uint32 UploadHeapRetainedSize           DEFAULT_INITIALIZER(0);
+
     /// Size of the dynamic heap (the buffer that is used to suballocate 
     /// memory for dynamic resources) shared by all contexts.
+    /// The buffer is created when the first dynamic allocation is made.
     Uint32 DynamicHeapSize                  DEFAULT_INITIALIZER(8 << 20);
 
     /// Size of the memory chunk suballocated by immediate/deferred context from
     /// the global dynamic heap to perform lock-free dynamic suballocations
     Uint32 DynamicHeapPageSize              DEFAULT_INITIALIZER(256 << 10);
 
+    /// The maximum amount of memory that is both device-local and host-visible (e.g. video memory
+    /// that is exposed to the CPU through resizable BAR) that the engine uses for the dynamic heap
+    /// and the upload heap pages. When such memory is available, the GPU reads dynamic and upload
+    /// data from video memory instead of fetching it from system memory over the bus.
+    /// Data that does not fit into the budget is placed in host-visible system memory.
+    /// When zero, device-local host-visible memory is not used for dynamic and upload data.
+    Uint32 DeviceLocalUploadMemoryBudget    DEFAULT_INITIALIZER(64 << 20);
+
     /// Query pool size for each query type.
     Uint32 QueryPoolSizes[QUERY_TYPE_NUM_TYPES]
 #if DILIGENT_CPP_INTERFACE
@@ -2794,6 +3673,51 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// features when compiling shaders from HLSL.
     const char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
 
+    /// The maximum number of Vulkan framebuffers in the device's framebuffer cache.
+    /// When the limit is reached, the least recently used framebuffers that have not been used
+    /// in the current frame are released through the release queue.
+    /// When zero, the cache size is not limited.
+    Uint32 FramebufferCacheSize   DEFAULT_INITIALIZER(0);
+
+    /// The number of frames after which an unused framebuffer is released from the cache
+    /// through the release queue. Frames are counted by IDeviceContext::FinishFrame()
+    /// of the first immediate context.
+    /// When zero, framebuffers are only released when their attachments are destroyed
+    /// or the cache size limit is reached.
+    Uint32 FramebufferCacheMaxAge DEFAULT_INITIALIZER(0);
+
+    /// Optional initial data for the device's default pipeline state cache, previously retrieved
+    /// with IPipelineStateCache::GetData(). The default cache is used by all pipeline states
+    /// that do not specify PipelineStateCreateInfo::pPSOCache and can be obtained
+    /// through IRenderDeviceVk::GetPipelineStateCache().
+    ///
+    /// \remarks Incompatible data (e.g. produced by a different device or driver version) is ignored.
+    const void* pPipelineCacheData    DEFAULT_INITIALIZER(nullptr);
+
+    /// The size of the data pointed to by pPipelineCacheData, in bytes.
+    Uint32      PipelineCacheDataSize DEFAULT_INITIALIZER(0);
+
+    /// Whether to create the logical device over all physical devices in the
+    /// device group of the selected adapter (requires Vulkan 1.1).
+
+    /// \remarks When the group contains more than one physical device, RenderDeviceInfo::NumNodes
+    ///          reports the number of devices in the group and every immediate context
+    ///          submits its commands to the nodes selected by ImmediateContextCreateInfo::NodeMask.
+    ///          When disabled or when the group has a single device, the device is created
+    ///          over the selected physical device only.
+    Bool        EnableDeviceGroup     DEFAULT_INITIALIZER(False);
+
+    /// Whether the device may coexist with other devices created by the same factory.
+
+    /// \remarks All devices created by the factory at the same time share one Vulkan instance, so
+    ///          they must use the same GraphicsAPIVersion, EnableValidation, instance extensions
+    ///          and pVkAllocator, and every one of them must set this flag.
+    ///          Devices on different adapters may be created from different threads in parallel.
+    ///          Device-level Vulkan functions of such devices are called through the loader
+    ///          dispatch rather than through the entries loaded for a single device, which
+    ///          adds a small overhead to every call.
+    Bool        EnableMultipleDevices DEFAULT_INITIALIZER(False);
+
 #if DILIGENT_CPP_INTERFACE
     EngineVkCreateInfo() noexcept :
         EngineVkCreateInfo{EngineCreateInfo{}}
@@ -2802,6 +3726,27 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     explicit EngineVkCreateInfo(const EngineCreateInfo &EngineCI) noexcept :
         EngineCreateInfo{EngineCI}
     {}
+
+    /// Configures a compute-only device with a single compute context (see EngineCreateInfo::ComputeOnly)
+    /// and descriptor and memory budgets that suit compute workloads: descriptor pools have no
+    /// sampler-heavy or input attachment budgets, and the memory reserves and dynamic heap are smaller.
+    void SetComputeOnlyProfile()
+    {
+        ComputeOnly = true;
+
+        //                         Max  SepSm  CmbSm  SmpImg StrImg   UB     SB    UTxB   StTxB  InptAtt  AccelSt
+        MainDescriptorPoolSize    = {1024,   64,   256,  1024,  1024,   512,  1024,   128,   128,     0,      32};
+        DynamicDescriptorPoolSize = { 256,   16,    64,   256,   256,   128,   256,    32,    32,     0,       8};
+
+        DeviceLocalMemoryReserveSize = 64 << 20;
+        HostVisibleMemoryReserveSize = 32 << 20;
+        DynamicHeapSize              = 2 << 20;
+        DynamicHeapPageSize          = 64 << 10;
+
+        QueryPoolSizes[QUERY_TYPE_OCCLUSION]           = 0;
+        QueryPoolSizes[QUERY_TYPE_BINARY_OCCLUSION]    = 0;
+        QueryPoolSizes[QUERY_TYPE_PIPELINE_STATISTICS] = 16;
+    }
 #endif
 };
 typedef struct EngineVkCreateInfo EngineVkCreateInfo;
@@ -2978,14 +3923,14 @@ struct TextureFormatAttribs
     }
 
     /// Initializes the structure
-    TextureFormatAttribs(const Char*    _Name,
-                         TEXTURE_FORMAT _Format, 
-                         Uint8          _ComponentSize,
-                         Uint8          _NumComponents,
-                         COMPONENT_TYPE _ComponentType,
-                         bool           _IsTypeless,
-                         Uint8          _BlockWidth,
-                         Uint8          _BlockHeight) noexcept : 
+    constexpr TextureFormatAttribs(const Char*    _Name,
+                                   TEXTURE_FORMAT _Format, 
+                                   Uint8          _ComponentSize,
+                                   Uint8          _NumComponents,
+                                   COMPONENT_TYPE _ComponentType,
+                                   bool           _IsTypeless,
+                                   Uint8          _BlockWidth,
+                                   Uint8          _BlockHeight) noexcept : 
         Name         {_Name         },
         Format       {_Format       },
         ComponentSize{_ComponentSize},
@@ -2997,7 +3942,7 @@ struct TextureFormatAttribs
     {
     }
 
-    TextureFormatAttribs()noexcept {}
+    constexpr TextureFormatAttribs()noexcept {}
 #endif
 };
 typedef struct TextureFormatAttribs TextureFormatAttribs;
@@ -110,8 +110,38 @@ DILIGENT_TYPED_ENUM(PIPELINE_RESOURCE_FLAGS, Uint8)
 
     /// Indicates that resource is a run-time sized shader array (e.g. an array without a specific size).
     PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY      = 0x08,
-    
-    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY
+
+    /// Indicates that the resource is a view into the device-wide bindless descriptor heap.
+    /// Applies to SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_TYPE_TEXTURE_UAV,
+    /// SHADER_RESOURCE_TYPE_BUFFER_SRV and SHADER_RESOURCE_TYPE_BUFFER_UAV resources
+    /// and must be combined with PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY.
+    ///
+    /// \remarks   Resources with this flag are not exposed as shader resource variables and
+    ///            take no space in the shader resource binding. Instead, the shader indexes the
+    ///            array with the value returned by ITextureView::GetBindlessIndex() or
+    ///            IBufferView::GetBindlessIndex(). The heap is bound once per pipeline, so
+    ///            committing shader resources does not need to touch these resources.
+    ///            The heap size is defined by EngineVkCreateInfo::BindlessHeapSize.
+    PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP      = 0x10,
+
+    /// Indicates that the constant buffer is a block of inline constants that are set
+    /// directly through the command list rather than bound as a buffer.
+    /// Applies to SHADER_RESOURCE_TYPE_CONSTANT_BUFFER resources only.
+    ///
+    /// \remarks  For inline constants, PipelineResourceDesc::ArraySize defines the number of
+    ///           32-bit constants in the block. The resource is not exposed as a shader resource
+    ///           variable and takes no space in the shader resource binding. Instead, the constants
+    ///           are set by IDeviceContext::SetInlineConstants() and are recorded directly into the
+    ///           command buffer, which avoids allocating and binding a dynamic buffer for small,
+    ///           frequently changing data.
+    ///           In Vulkan backend, the block is mapped to a push constant range and must be declared
+    ///           in the shader as a push_constant block ([[vk::push_constant]] in HLSL). Only one
+    ///           resource with this flag is allowed in all signatures of a pipeline, and its size
+    ///           must not exceed the maxPushConstantsSize device limit.
+    ///           Inline constants are currently only supported in Vulkan backend.
+    PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS   = 0x20,
+
+    PIPELINE_RESOURCE_FLAG_LAST               = PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS
 };
 DEFINE_FLAG_ENUM_OPERATORS(PIPELINE_RESOURCE_FLAGS);
 
@@ -209,6 +239,39 @@ struct PipelineResourceSignatureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
 typedef struct PipelineResourceSignatureDesc PipelineResourceSignatureDesc;
 
 
+/// Resource bound to a mutable variable of a cached shader resource binding object,
+/// see IPipelineResourceSignature::GetCachedShaderResourceBinding().
+struct CachedSRBResource
+{
+    /// Shader stages to search the variable in.
+    SHADER_TYPE           ShaderStages DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// Variable name.
+    const Char*           Name         DEFAULT_INITIALIZER(nullptr);
+
+    /// Array element index.
+    Uint32                ArrayIndex   DEFAULT_INITIALIZER(0);
+
+    /// Object to bind to the variable.
+    struct IDeviceObject* pObject      DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    CachedSRBResource()noexcept{}
+
+    CachedSRBResource(SHADER_TYPE    _ShaderStages,
+                      const Char*    _Name,
+                      IDeviceObject* _pObject,
+                      Uint32         _ArrayIndex = 0)noexcept :
+        ShaderStages{_ShaderStages},
+        Name        {_Name        },
+        ArrayIndex  {_ArrayIndex  },
+        pObject     {_pObject     }
+    {}
+#endif
+};
+typedef struct CachedSRBResource CachedSRBResource;
+
+
 // {DCE499A5-F812-4C93-B108-D684A0B56118}
 static const INTERFACE_ID IID_PipelineResourceSignature = 
     {0xdce499a5, 0xf812, 0x4c93, {0xb1, 0x8, 0xd6, 0x84, 0xa0, 0xb5, 0x61, 0x18}};
@@ -240,6 +303,26 @@ DILIGENT_BEGIN_INTERFACE(IPipelineResourceSignature, IDeviceObject)
     VIRTUAL void METHOD(CreateShaderResourceBinding)(THIS_
                                                      IShaderResourceBinding** ppShaderResourceBinding,
                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
+
+
+    /// Creates multiple shader resource binding objects
+
+    /// \param [in]  NumSRBs             - The number of shader resource binding objects to create.
+    /// \param [out] ppSRBs              - Memory location where pointers to the new shader resource
+    ///                                   binding objects are written. The array must contain at least
+    ///                                   NumSRBs elements.
+    /// \param [in]  InitStaticResources - If set to true, the method will initialize static resources in
+    ///                                   all created objects, which has the exact same effect as calling
+    ///                                   IPipelineResourceSignature::InitializeStaticSRBResources() for each object.
+    ///
+    /// \remarks   The result is the same as calling IPipelineResourceSignature::CreateShaderResourceBinding()
+    ///            NumSRBs times, but the backend may share the work between the objects. For instance,
+    ///            Vulkan backend allocates descriptor sets for all objects at once and initializes static
+    ///            resources in all objects with a single descriptor set update.
+    VIRTUAL void METHOD(CreateShaderResourceBindings)(THIS_
+                                                      Uint32                   NumSRBs,
+                                                      IShaderResourceBinding** ppSRBs,
+                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
     
 
     /// Binds static resources for the specified shader stages in the pipeline resource signature.
@@ -337,6 +420,32 @@ DILIGENT_BEGIN_INTERFACE(IPipelineResourceSignature, IDeviceObject)
     ///             disregarding their names.
     VIRTUAL bool METHOD(IsCompatibleWith)(THIS_
                                           const struct IPipelineResourceSignature* pPRS) CONST PURE;
+
+
+    /// Returns a shader resource binding object shared by all callers that bind the same resources.
+
+    /// \param [in]  pResources   - Resources to bind to the mutable variables of the SRB.
+    /// \param [in]  NumResources - The number of elements in pResources array.
+    /// \param [out] ppSRB        - Memory location where pointer to the shader resource binding
+    ///                             object is written.
+    ///
+    /// \remarks    The signature keeps a cache of shader resource binding objects keyed by the mutable
+    ///             variables and the unique identifiers (IDeviceObject::GetUniqueID()) of the objects bound to
+    ///             them. If an SRB with the same bindings is alive, the method returns it. Otherwise, the method
+    ///             creates a new SRB, initializes its static resources and binds the given resources.
+    ///             The order of the resources does not matter.
+    ///
+    ///             The returned object is shared and must not be modified. Static variables of the signature
+    ///             must be initialized before the first call, and dynamic variables are not part of the key.
+    ///             The cache does not keep the objects alive: the SRB is released when the last
+    ///             caller releases it.
+    ///
+    ///             Sharing the SRB saves the resource cache and the descriptor set allocation of every
+    ///             duplicate object, and draws that use the same bindings commit the same descriptor set.
+    VIRTUAL void METHOD(GetCachedShaderResourceBinding)(THIS_
+                                                        const CachedSRBResource*        pResources,
+                                                        Uint32                          NumResources,
+                                                        struct IShaderResourceBinding** ppSRB) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -349,12 +458,14 @@ DILIGENT_END_INTERFACE
 #    define IPipelineResourceSignature_GetDesc(This) (const struct PipelineResourceSignatureDesc*)IDeviceObject_GetDesc(This)
 
 #    define IPipelineResourceSignature_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBinding, This, __VA_ARGS__)
+#    define IPipelineResourceSignature_CreateShaderResourceBindings(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, CreateShaderResourceBindings,This, __VA_ARGS__)
 #    define IPipelineResourceSignature_BindStaticResources(This, ...)          CALL_IFACE_METHOD(PipelineResourceSignature, BindStaticResources,         This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByName,     This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableByIndex,    This, __VA_ARGS__)
 #    define IPipelineResourceSignature_GetStaticVariableCount(This, ...)       CALL_IFACE_METHOD(PipelineResourceSignature, GetStaticVariableCount,      This, __VA_ARGS__)
 #    define IPipelineResourceSignature_InitializeStaticSRBResources(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, InitializeStaticSRBResources,This, __VA_ARGS__)
 #    define IPipelineResourceSignature_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineResourceSignature, IsCompatibleWith,            This, __VA_ARGS__)
+#    define IPipelineResourceSignature_GetCachedShaderResourceBinding(This, ...) CALL_IFACE_METHOD(PipelineResourceSignature, GetCachedShaderResourceBinding, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -43,6 +43,7 @@
 #include "ShaderResourceVariable.h"
 #include "Shader.h"
 #include "Sampler.h"
+#include "PipelineStateCache.h"
 #include "RenderPass.h"
 #include "PipelineResourceSignature.h"
 
@@ -161,6 +162,43 @@ struct PipelineResourceLayoutDesc
 typedef struct PipelineResourceLayoutDesc PipelineResourceLayoutDesc;
 
 
+/// Dynamic pipeline state flags.
+
+/// Dynamic states are not baked into the pipeline. Their values in the graphics pipeline
+/// description are applied when the pipeline is bound, and may then be changed
+/// with IDeviceContext::SetDynamicStates(). This allows using a single pipeline
+/// instead of one pipeline per combination of the state values.
+/// Dynamic states require Diligent::DeviceFeatures::DynamicPipelineStates feature.
+DILIGENT_TYPED_ENUM(DYNAMIC_STATE_FLAGS, Uint8)
+{
+    /// No dynamic states.
+    DYNAMIC_STATE_FLAG_NONE               = 0x00,
+
+    /// Cull mode (RasterizerStateDesc::CullMode) is dynamic.
+    DYNAMIC_STATE_FLAG_CULL_MODE          = 0x01,
+
+    /// Depth test enable, depth write enable and depth function
+    /// (DepthStencilStateDesc::DepthEnable, DepthWriteEnable and DepthFunc) are dynamic.
+    DYNAMIC_STATE_FLAG_DEPTH              = 0x02,
+
+    /// Stencil test enable and front- and back-face stencil operations
+    /// (DepthStencilStateDesc::StencilEnable, FrontFace and BackFace) are dynamic.
+    DYNAMIC_STATE_FLAG_STENCIL            = 0x04,
+
+    /// Primitive topology is dynamic.
+    ///
+    /// \remarks The topology set by IDeviceContext::SetDynamicStates() must be of the same
+    ///          class (point, line, triangle or patch list) as GraphicsPipelineDesc::PrimitiveTopology.
+    DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY = 0x08,
+
+    DYNAMIC_STATE_FLAG_LAST               = DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY,
+
+    /// All dynamic states.
+    DYNAMIC_STATE_FLAG_ALL                = (DYNAMIC_STATE_FLAG_LAST << 1) - 1
+};
+DEFINE_FLAG_ENUM_OPERATORS(DYNAMIC_STATE_FLAGS);
+
+
 /// Graphics pipeline state description
 
 /// This structure describes the graphics pipeline state and is part of the GraphicsPipelineStateCreateInfo structure.
@@ -200,6 +238,10 @@ struct GraphicsPipelineDesc
     /// When pRenderPass is null, this member must be 0.
     Uint8 SubpassIndex           DEFAULT_INITIALIZER(0);
 
+    /// States that are not baked into the pipeline and are set
+    /// by IDeviceContext::SetDynamicStates(), see Diligent::DYNAMIC_STATE_FLAGS.
+    DYNAMIC_STATE_FLAGS DynamicStates DEFAULT_INITIALIZER(DYNAMIC_STATE_FLAG_NONE);
+
     /// Render target formats.
     /// All formats must be TEX_FORMAT_UNKNOWN when pRenderPass is not null.
     TEXTURE_FORMAT RTVFormats[8] DEFAULT_INITIALIZER({});
@@ -410,10 +452,127 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// that is not found in any of the designated shader stages.
     /// Use this flag to silence these warnings.
     PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS = 0x02,
+
+    /// Create the pipeline asynchronously.
+
+    /// When this flag is set, the create info is validated and copied, the pipeline
+    /// state object is returned immediately, and shader reflection, resource signature
+    /// creation and driver compilation are performed by the engine worker threads.
+    /// Use IPipelineState::GetStatus() to check when the pipeline is ready to be used.
+    ///
+    /// \note   In OpenGL backend, the flag is only supported when the driver exposes GL_KHR_parallel_shader_compile.
+    ///         The driver then links the programs in background threads, and GetStatus() completes the
+    ///         initialization when the links have finished. GetStatus() must be polled from a thread
+    ///         that has a current GL context (e.g. the thread of the immediate context), as it never
+    ///         makes progress in other threads. Without the extension, the flag is ignored and the
+    ///         pipeline is created synchronously.
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 0x04,
+
+    /// Capture the shader compiler statistics of the pipeline, see IPipelineState::GetStatistics().
+
+    /// \note   In Vulkan backend, the statistics are reported by the driver through VK_KHR_pipeline_executable_properties
+    ///         extension, and the flag is ignored if the extension is not supported. Graphics pipelines that capture
+    ///         statistics are never linked from graphics pipeline libraries.
+    ///         In Direct3D11 and Direct3D12 backends, the statistics are read from the shader byte code reflection
+    ///         as the drivers do not expose the statistics of the native code.
+    ///         In OpenGL backend, the flag is ignored.
+    PSO_CREATE_FLAG_CAPTURE_STATISTICS                = 0x08,
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint8)
+{
+    /// The pipeline is being created asynchronously and can't be used yet.
+    PIPELINE_STATE_STATUS_PENDING = 0,
+
+    /// The pipeline has been successfully created and can be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous pipeline creation has failed, the object can't be used and should be released.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
+/// Value of a Diligent::ShaderStatistics member that is not reported by the backend or the driver.
+static const Uint32 SHADER_STATISTIC_UNAVAILABLE = ~0u;
+
+/// Shader compiler statistics of a pipeline stage, see IPipelineState::GetStatistics().
+
+/// Every driver reports its own set of statistics. Members that are not reported are set to
+/// SHADER_STATISTIC_UNAVAILABLE. The values are only comparable between pipelines compiled
+/// by the same driver.
+struct ShaderStatistics
+{
+    /// Shader stage.
+    SHADER_TYPE ShaderType          DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// The number of per-thread (vector) registers, e.g. VGPRs on AMD GPUs.
+    /// In Direct3D backends, the number of temporary registers of the byte code.
+    Uint32      RegisterCount       DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+
+    /// The number of scalar registers, e.g. SGPRs on AMD GPUs.
+    Uint32      ScalarRegisterCount DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+
+    /// The size, in bytes, of the scratch (local) memory that holds the spilled registers.
+    Uint32      SpillSize           DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+
+    /// The number of instructions. In Direct3D backends, the number of byte code instructions.
+    Uint32      InstructionCount    DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+
+    /// The size, in bytes, of the group shared (LDS) memory.
+    Uint32      SharedMemorySize    DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+
+    /// Occupancy: the maximum number of waves (subgroups) that can run concurrently on a SIMD unit.
+    Uint32      Occupancy           DEFAULT_INITIALIZER(SHADER_STATISTIC_UNAVAILABLE);
+};
+typedef struct ShaderStatistics ShaderStatistics;
+
+
+/// Specialization constant.
+
+/// Specialization constants allow setting constant values in the shader byte code
+/// when the pipeline is created. A single shader object can thus be used to create
+/// multiple pipeline variants without compiling a separate permutation for each of them.
+///
+/// \remarks   Requires SpecializationConstants device feature.
+///            In HLSL, specialization constants are declared with the [[vk::constant_id(N)]]
+///            attribute, in GLSL - with the layout(constant_id = N) qualifier. Constants
+///            are matched by name rather than by id.
+struct SpecializationConstant
+{
+    /// Constant name.
+    const Char* Name         DEFAULT_INITIALIZER(nullptr);
+
+    /// Shader stages where the constant is defined, see Diligent::SHADER_TYPE.
+    SHADER_TYPE ShaderStages DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// The size of the constant data, in bytes. Must match the size of
+    /// the constant type in the shader (4 bytes for 32-bit types, including bool,
+    /// or 8 bytes for 64-bit types).
+    Uint32      Size         DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the constant data.
+    const void* pData        DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    SpecializationConstant() noexcept {}
+
+    SpecializationConstant(const Char* _Name,
+                           SHADER_TYPE _ShaderStages,
+                           Uint32      _Size,
+                           const void* _pData) noexcept :
+        Name        {_Name        },
+        ShaderStages{_ShaderStages},
+        Size        {_Size        },
+        pData       {_pData       }
+    {}
+#endif
+};
+typedef struct SpecializationConstant SpecializationConstant;
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -438,11 +597,26 @@ struct PipelineStateCreateInfo
     /// The number of elements in ppResourceSignatures array.
     Uint32 ResourceSignaturesCount DEFAULT_INITIALIZER(0);
 
-    // In 32-bit, there might be a problem that may cause mismatch between C++ and C interfaces:
-    // PSODesc contains a Uint64 member, so the entire structure has 64-bit alignment. When
-    // another struct is derived from PipelineStateCreateInfo, though, the compiler may place
-    // another member in this space. To fix this, we add padding.
-    Uint32 _Padding;
+    /// The number of specialization constants in pSpecializationConstants array.
+    Uint32 NumSpecializationConstants DEFAULT_INITIALIZER(0);
+
+    /// An array of NumSpecializationConstants specialization constants, see Diligent::SpecializationConstant.
+    ///
+    /// \remarks   Requires SpecializationConstants device feature.
+    ///            Constants that are not found in any of the designated shader stages are ignored.
+    const SpecializationConstant* pSpecializationConstants DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional pipeline state cache to use when compiling the pipeline, see Diligent::IPipelineStateCache.
+    ///
+    /// \remarks   When this member is null, the device's default pipeline state cache is used
+    ///             (if the backend provides one).
+    ///
+    /// \note      The member also keeps the structure size a multiple of 8 bytes in 32-bit
+    ///             builds: PSODesc contains a Uint64 member, so the entire structure has 64-bit
+    ///             alignment, and when another struct is derived from PipelineStateCreateInfo, the
+    ///             compiler might otherwise place another member in the tail padding, which would
+    ///             cause mismatch between C++ and C interfaces.
+    IPipelineStateCache* pPSOCache DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCreateInfo PipelineStateCreateInfo;
 
@@ -577,6 +751,52 @@ struct TilePipelineStateCreateInfo DILIGENT_DERIVE(PipelineStateCreateInfo)
 typedef struct TilePipelineStateCreateInfo TilePipelineStateCreateInfo;
 
 
+/// Pipeline state archive create information.
+
+/// The archive is produced offline by the PipelineArchivePacker tool and contains precompiled
+/// shader byte code, pipeline resource signatures and pipeline descriptions.
+struct PipelineStateArchiveCreateInfo
+{
+    /// Archive data.
+    IDataBlob*   pArchive      DEFAULT_INITIALIZER(nullptr);
+
+    /// The name of the pipeline in the archive.
+    const Char*  PipelineName  DEFAULT_INITIALIZER(nullptr);
+
+    /// An optional array of resource signatures to use instead of creating the signatures
+    /// stored in the archive. Signatures are matched by name. Passing the signatures of a
+    /// previously created pipeline allows the pipelines to share compatible SRBs.
+    IPipelineResourceSignature** ppResourceSignatures    DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in ppResourceSignatures array.
+    Uint32                       ResourceSignaturesCount DEFAULT_INITIALIZER(0);
+
+    /// The number of specialization constants in pSpecializationConstants array.
+    Uint32                        NumSpecializationConstants DEFAULT_INITIALIZER(0);
+
+    /// Optional specialization constants, see Diligent::PipelineStateCreateInfo::pSpecializationConstants.
+    const SpecializationConstant* pSpecializationConstants   DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional pipeline state cache, see Diligent::PipelineStateCreateInfo::pPSOCache.
+    IPipelineStateCache*         pPSOCache               DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct PipelineStateArchiveCreateInfo PipelineStateArchiveCreateInfo;
+
+
+/// Pipeline state replay information, see IRenderDevice::ReplayPipelineStates().
+struct PipelineStateReplayInfo
+{
+    /// Pipeline archive, typically retrieved with IRenderDevice::GetRecordedPipelineStates()
+    /// during a previous run.
+    IDataBlob*           pArchive  DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional pipeline state cache that the pipelines are created with, see
+    /// Diligent::PipelineStateCreateInfo::pPSOCache. If null, the device's default cache is used.
+    IPipelineStateCache* pPSOCache DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct PipelineStateReplayInfo PipelineStateReplayInfo;
+
+
 // {06084AE5-6A71-4FE8-84B9-395DD489A28C}
 static const struct INTERFACE_ID IID_PipelineState =
     {0x6084ae5, 0x6a71, 0x4fe8, {0x84, 0xb9, 0x39, 0x5d, 0xd4, 0x89, 0xa2, 0x8c}};
@@ -699,6 +919,24 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
 
 
+    /// Creates multiple shader resource binding objects.
+
+    /// \param [in]  NumSRBs             - The number of shader resource binding objects to create.
+    /// \param [out] ppSRBs              - Memory location where pointers to the new shader resource
+    ///                                   binding objects are written. The array must contain at least
+    ///                                   NumSRBs elements.
+    /// \param [in]  InitStaticResources - If set to true, the method will initialize static resources in
+    ///                                   all created objects.
+    ///
+    /// \remarks    This method is only allowed for pipelines that use implicit resource signature.
+    ///             For pipelines that use explicit resource signatures, use
+    ///             IPipelineResourceSignature::CreateShaderResourceBindings() method.
+    VIRTUAL void METHOD(CreateShaderResourceBindings)(THIS_
+                                                      Uint32                   NumSRBs,
+                                                      IShaderResourceBinding** ppSRBs,
+                                                      bool                     InitStaticResources DEFAULT_VALUE(false)) PURE;
+
+
 
     /// Initializes static resources in the shader binding object.
 
@@ -763,6 +1001,50 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \remarks    Pipelines created without PSO_CREATE_FLAG_ASYNCHRONOUS flag are always ready.
+    ///             For asynchronously created pipelines, all methods except for GetDesc() and
+    ///             GetStatus() must only be called after the status has become PIPELINE_STATE_STATUS_READY,
+    ///             and the pipeline must not be bound to a device context before that.
+    ///
+    ///             The method is thread-safe.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS) CONST PURE;
+
+    /// Exchanges the shaders of this pipeline state with the shaders of another pipeline state.
+
+    /// \param [in] pPipeline - Pointer to the pipeline state object to exchange the shaders with.
+    ///                         The pipeline must be created from the same create info as this pipeline,
+    ///                         except for the shader objects.
+    /// \return     true if the shaders have been exchanged, and false otherwise.
+    ///
+    /// \remarks    The method is intended for shader hot reloading: an application creates a new pipeline
+    ///             from the updated shaders and exchanges its shaders with the pipeline that is in use.
+    ///             All existing references to this pipeline, as well as the shader resource binding objects
+    ///             created by it, remain valid. After the method returns, pPipeline holds the old shaders,
+    ///             which are released together with pPipeline.
+    ///
+    ///             Only graphics and compute pipelines are supported. Both pipelines must be ready,
+    ///             use the same shader stages and have compatible resource signatures (see IsCompatibleWith()).
+    ///
+    ///             The method is not thread-safe: neither pipeline must be used by any device context
+    ///             while the shaders are exchanged. Device contexts that have this pipeline bound
+    ///             must call IDeviceContext::InvalidateState() before the next draw or dispatch command.
+    VIRTUAL bool METHOD(SwapShaders)(THIS_
+                                     struct IPipelineState* pPipeline) PURE;
+
+    /// Returns the shader compiler statistics of the pipeline stages, see Diligent::ShaderStatistics.
+
+    /// \param [out] NumStages - The number of elements in the returned array.
+    /// \return     Pointer to the array of statistics, one element per pipeline stage, or null if
+    ///             the pipeline was created without PSO_CREATE_FLAG_CAPTURE_STATISTICS flag or the
+    ///             backend does not support the statistics.
+    ///
+    /// \remarks    The array is valid during the lifetime of the pipeline. In Vulkan, a stage may
+    ///             be reported as several elements when the driver compiles it into several executables.
+    VIRTUAL const ShaderStatistics* METHOD(GetStatistics)(THIS_
+                                                          Uint32 REF NumStages) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -781,10 +1063,14 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_GetStaticVariableByName(This, ...)      CALL_IFACE_METHOD(PipelineState, GetStaticVariableByName,      This, __VA_ARGS__)
 #    define IPipelineState_GetStaticVariableByIndex(This, ...)     CALL_IFACE_METHOD(PipelineState, GetStaticVariableByIndex,     This, __VA_ARGS__)
 #    define IPipelineState_CreateShaderResourceBinding(This, ...)  CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBinding,  This, __VA_ARGS__)
+#    define IPipelineState_CreateShaderResourceBindings(This, ...) CALL_IFACE_METHOD(PipelineState, CreateShaderResourceBindings, This, __VA_ARGS__)
 #    define IPipelineState_InitializeStaticSRBResources(This, ...) CALL_IFACE_METHOD(PipelineState, InitializeStaticSRBResources, This, __VA_ARGS__)
 #    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
 #    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
 #    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This)                         CALL_IFACE_METHOD(PipelineState, GetStatus,                    This)
+#    define IPipelineState_SwapShaders(This, ...)                  CALL_IFACE_METHOD(PipelineState, SwapShaders,                  This, __VA_ARGS__)
+#    define IPipelineState_GetStatistics(This, ...)                CALL_IFACE_METHOD(PipelineState, GetStatistics,                This, __VA_ARGS__)
 
 // clang-format on
 
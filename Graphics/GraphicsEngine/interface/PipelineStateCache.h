@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IPipelineStateCache interface and related data structures
+
+#include "../../../Primitives/interface/DataBlob.h"
+#include "DeviceObject.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {914BD33E-CFEC-4092-8621-988D093C4916}
+static const INTERFACE_ID IID_PipelineStateCache =
+    {0x914bd33e, 0xcfec, 0x4092, {0x86, 0x21, 0x98, 0x8d, 0x9, 0x3c, 0x49, 0x16}};
+
+// clang-format off
+
+/// Pipeline state cache description
+struct PipelineStateCacheDesc DILIGENT_DERIVE(DeviceObjectAttribs)
+};
+typedef struct PipelineStateCacheDesc PipelineStateCacheDesc;
+
+
+/// Pipeline state cache create information
+struct PipelineStateCacheCreateInfo
+{
+    /// Pipeline state cache description
+    PipelineStateCacheDesc Desc;
+
+    /// Pointer to the initial cache data previously retrieved with
+    /// IPipelineStateCache::GetData(). May be null.
+
+    /// \remarks If the data is not compatible with the device (e.g. it was produced
+    ///          by a different driver version), it is silently ignored and an empty
+    ///          cache is created.
+    const void* pCacheData    DEFAULT_INITIALIZER(nullptr);
+
+    /// Size of the initial cache data, in bytes.
+    Uint32      CacheDataSize DEFAULT_INITIALIZER(0);
+};
+typedef struct PipelineStateCacheCreateInfo PipelineStateCacheCreateInfo;
+
+// clang-format on
+
+#define DILIGENT_INTERFACE_NAME IPipelineStateCache
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IPipelineStateCacheInclusiveMethods \
+    IDeviceObjectInclusiveMethods;          \
+    IPipelineStateCacheMethods PipelineStateCache
+
+// clang-format off
+
+/// Pipeline state cache interface
+
+/// Pipeline state cache accumulates compiled pipeline data that the driver can reuse
+/// when creating new pipeline states. The cache contents can be retrieved with GetData()
+/// and stored on disk to speed up pipeline creation on subsequent runs.
+///
+/// \remarks Pipeline state cache is thread-safe.
+DILIGENT_BEGIN_INTERFACE(IPipelineStateCache, IDeviceObject)
+{
+#if DILIGENT_CPP_INTERFACE
+    /// Returns the pipeline state cache description used to create the object
+    virtual const PipelineStateCacheDesc& METHOD(GetDesc)() const override = 0;
+#endif
+
+    /// Serializes the cache contents into a data blob.
+
+    /// \param [out] ppBlob - Address of the memory location where the pointer to the
+    ///                       data blob will be written. The function calls AddRef(),
+    ///                       so that the blob will have one reference.
+    ///
+    /// \remarks The blob may be passed to IRenderDevice::CreatePipelineStateCache()
+    ///          to restore the cache.
+    VIRTUAL void METHOD(GetData)(THIS_
+                                 IDataBlob** ppBlob) PURE;
+};
+DILIGENT_END_INTERFACE
+
+// clang-format on
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IPipelineStateCache_GetDesc(This) (const struct PipelineStateCacheDesc*)IDeviceObject_GetDesc(This)
+
+#    define IPipelineStateCache_GetData(This, ...) CALL_IFACE_METHOD(PipelineStateCache, GetData, This, __VA_ARGS__)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -81,6 +81,30 @@ struct QueryDataTimestamp
 };
 typedef struct QueryDataTimestamp QueryDataTimestamp;
 
+/// GPU and CPU timestamps sampled at the same moment, see IDeviceContext::GetTimestampCalibration().
+
+/// A GPU timestamp T, returned by a timestamp query executed by the same context,
+/// corresponds to the following CPU time, in seconds:
+///
+///     CPUTime * 1e-9 + (double(T) - double(GPUCounter)) / double(GPUFrequency)
+struct TimestampCalibration
+{
+    /// The value of the GPU timestamp counter, in the same units as QueryDataTimestamp::Counter.
+    Uint64 GPUCounter DEFAULT_INITIALIZER(0);
+
+    /// The GPU counter frequency, in Hz (ticks/second). This is the same value as QueryDataTimestamp::Frequency.
+    Uint64 GPUFrequency DEFAULT_INITIALIZER(0);
+
+    /// The CPU time, in nanoseconds, on the clock of std::chrono::steady_clock
+    /// (QueryPerformanceCounter on Windows, CLOCK_MONOTONIC on Linux and Android).
+    Uint64 CPUTime DEFAULT_INITIALIZER(0);
+
+    /// The maximum deviation, in nanoseconds, between the moments the two timestamps were sampled,
+    /// or 0 if the backend does not report it.
+    Uint64 MaxDeviation DEFAULT_INITIALIZER(0);
+};
+typedef struct TimestampCalibration TimestampCalibration;
+
 /// Pipeline statistics query data.
 /// This structure is filled by IQuery::GetData() for Diligent::QUERY_TYPE_PIPELINE_STATISTICS query type.
 ///
@@ -51,6 +51,8 @@
 #include "TopLevelAS.h"
 #include "ShaderBindingTable.h"
 #include "PipelineResourceSignature.h"
+#include "PipelineStateCache.h"
+#include "ResourceHeap.h"
 
 #include "DepthStencilState.h"
 #include "RasterizerState.h"
@@ -105,6 +107,27 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                       const ShaderCreateInfo REF ShaderCI,
                                       IShader**                   ppShader) PURE;
 
+    /// Creates multiple shader objects in parallel
+
+    /// \param [in]  pShaderCIs - Pointer to the array of NumShaders shader create info structures.
+    /// \param [in]  NumShaders - The number of shaders to create.
+    /// \param [out] ppShaders  - Pointer to the array of NumShaders elements where the pointers to the
+    ///                           shader interfaces will be written. If a shader fails to be created,
+    ///                           the corresponding element is set to null.
+    ///                           The function calls AddRef() for every created shader.
+    ///
+    /// \remarks    The shaders are compiled by the engine's worker threads (see
+    ///             EngineCreateInfo::NumAsyncWorkerThreads and EngineCreateInfo::pAsyncTaskPool)
+    ///             as well as by the calling thread.
+    ///             The method returns when all shaders have been created.
+    ///
+    ///             OpenGL backend creates the shaders sequentially in the calling thread
+    ///             as GL objects can only be created by the thread that owns the context.
+    VIRTUAL void METHOD(CreateShaders)(THIS_
+                                       const ShaderCreateInfo* pShaderCIs,
+                                       Uint32                  NumShaders,
+                                       IShader**               ppShaders) PURE;
+
     /// Creates a new texture object
 
     /// \param [in] TexDesc - Texture description, see Diligent::TextureDesc for details.
@@ -297,6 +320,86 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
                                                          IPipelineResourceSignature**            ppSignature) PURE;
 
 
+    /// Creates a pipeline state cache object.
+
+    /// \param [in]  CreateInfo   - Pipeline state cache create info, see Diligent::PipelineStateCacheCreateInfo for details.
+    /// \param [out] ppPSOCache   - Address of the memory location where the pointer to the
+    ///                             pipeline state cache interface will be stored.
+    ///                             The function calls AddRef(), so that the new object will have
+    ///                             one reference.
+    ///
+    /// \remarks On backends that do not support pipeline state caches, null is returned.
+    VIRTUAL void METHOD(CreatePipelineStateCache)(THIS_
+                                                  const PipelineStateCacheCreateInfo REF CreateInfo,
+                                                  IPipelineStateCache**                  ppPSOCache) PURE;
+
+
+    /// Creates a pipeline state from the precompiled pipeline archive.
+
+    /// \param [in]  CreateInfo      - Archive create information, see Diligent::PipelineStateArchiveCreateInfo.
+    /// \param [out] ppPipelineState - Address of the memory location where the pointer to the
+    ///                               pipeline state interface will be stored.
+    ///                               The function calls AddRef(), so that the new object will have
+    ///                               one reference.
+    ///
+    /// \remarks The shaders are created from the byte code stored for the device type of this device,
+    ///          and the pipeline uses the resource signatures stored in the archive, so neither
+    ///          the shader compiler nor the implicit resource layout are used. If the archive does not
+    ///          contain byte code for this device type, null is returned.
+    VIRTUAL void METHOD(CreatePipelineStateFromArchive)(THIS_
+                                                        const PipelineStateArchiveCreateInfo REF CreateInfo,
+                                                        IPipelineState**                         ppPipelineState) PURE;
+
+
+    /// Returns the pipeline states recorded by the device.
+
+    /// \param [out] ppArchive - Address of the memory location where the pointer to the pipeline archive
+    ///                          will be written. The function calls AddRef(), so that the blob will have
+    ///                          one reference.
+    ///
+    /// \remarks The device records pipeline states when EngineCreateInfo::RecordPipelineStates is true;
+    ///          otherwise null is returned. The archive contains every graphics and compute pipeline created
+    ///          so far, with the shader byte code for this device type and the resource signatures of the
+    ///          pipeline (including the implicit ones). Identical pipelines are recorded once.
+    ///          The archive may be stored on disk and passed to ReplayPipelineStates() or
+    ///          CreatePipelineStateFromArchive() on the next run.
+    VIRTUAL void METHOD(GetRecordedPipelineStates)(THIS_
+                                                   IDataBlob** ppArchive) PURE;
+
+
+    /// Creates all pipeline states stored in the archive in parallel.
+
+    /// \param [in] ReplayInfo - Replay information, see Diligent::PipelineStateReplayInfo.
+    ///
+    /// \return The number of pipeline states that have been created.
+    ///
+    /// \remarks The shaders and pipelines are created by the worker threads of the asynchronous
+    ///          task pool (see EngineCreateInfo::pAsyncTaskPool) and by the calling thread; the method returns
+    ///          when all pipelines have been created. The pipelines are released once they are created:
+    ///          the purpose of the replay is to fill the pipeline state cache (ReplayInfo.pPSOCache or
+    ///          the device's default cache) and the driver caches, so that the pipelines the application
+    ///          creates later are created quickly.
+    ///
+    ///          Pipelines that use byte code of other device types are skipped.
+    VIRTUAL Uint32 METHOD(ReplayPipelineStates)(THIS_
+                                                const PipelineStateReplayInfo REF ReplayInfo) PURE;
+
+
+    /// Creates a resource heap object.
+
+    /// \param [in]  Desc    - Resource heap description, see Diligent::ResourceHeapDesc for details.
+    /// \param [out] ppHeap  - Address of the memory location where the pointer to the
+    ///                        resource heap interface will be stored.
+    ///                        The function calls AddRef(), so that the new object will have
+    ///                        one reference.
+    ///
+    /// \remarks Resource heaps are supported in Direct3D12 and Vulkan backends.
+    ///          On other backends, null is returned.
+    VIRTUAL void METHOD(CreateResourceHeap)(THIS_
+                                            const ResourceHeapDesc REF Desc,
+                                            IResourceHeap**            ppHeap) PURE;
+
+
     /// Returns the device information, see Diligent::RenderDeviceInfo for details.
     VIRTUAL const RenderDeviceInfo REF METHOD(GetDeviceInfo)(THIS) CONST PURE;
 
@@ -345,6 +448,52 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     VIRTUAL void METHOD(IdleGPU)(THIS) PURE;
 
 
+    /// Returns the device memory statistics.
+
+    /// \param [out] Stats - Memory statistics, see Diligent::RenderDeviceMemoryStatistics.
+    ///
+    /// \remarks The statistics only include the memory managed by the engine.
+    ///          Heap budget and process usage are reported when the driver supports it
+    ///          (VK_EXT_memory_budget in Vulkan).
+    ///          Direct3D11 and OpenGL backends do not track device memory and return empty statistics.
+    VIRTUAL void METHOD(GetMemoryStatistics)(THIS_
+                                             RenderDeviceMemoryStatistics REF Stats) PURE;
+
+
+    /// Sets the callback function that is called every time the engine allocates or releases device memory.
+
+    /// \param [in] Callback  - Callback function, or null to remove the current callback.
+    /// \param [in] pUserData - User data pointer that is passed to the callback.
+    ///
+    /// \remarks The callback is only called for device memory objects, not for individual
+    ///          resource suballocations. It may be called from any thread that creates or
+    ///          releases resources, but never from two threads simultaneously.
+    ///          The callback must not call any render device methods.
+    VIRTUAL void METHOD(SetMemoryAllocationCallback)(THIS_
+                                                     MemoryAllocationCallbackType Callback,
+                                                     void*                        pUserData) PURE;
+
+
+    /// Captures the live device objects and the occupancy of the object pools, caches and release queues.
+
+    /// \param [out] Snapshot  - Object counts and sizes, and pool, cache and release queue statistics,
+    ///                          see Diligent::ResourceSnapshot.
+    /// \param [out] ppObjects - Optional address of the memory location where the pointer to the data blob
+    ///                          with the array of Diligent::LiveObjectInfo structures, one for every live object,
+    ///                          will be written. The number of objects is the blob size divided by
+    ///                          sizeof(LiveObjectInfo). Object names are stored in the same blob.
+    ///
+    /// \remarks Objects are sorted by their serial numbers. An object that is present in the
+    ///          second of two snapshots only was created between the snapshots, and an object
+    ///          whose creation frame is far behind the current frame is a candidate leak.
+    ///
+    ///          Shader resource bindings are reported with the name of their pipeline resource signature.
+    ///          Objects that are being created or destroyed by other threads may or may not be included.
+    VIRTUAL void METHOD(CaptureResourceSnapshot)(THIS_
+                                                 ResourceSnapshot REF Snapshot,
+                                                 IDataBlob**          ppObjects) PURE;
+
+
     /// Returns engine factory this device was created from.
     /// \remark This method does not increment the reference counter of the returned interface,
     ///         so the application should not call Release().
@@ -359,6 +508,7 @@ DILIGENT_END_INTERFACE
 // clang-format off
 #    define IRenderDevice_CreateBuffer(This, ...)                    CALL_IFACE_METHOD(RenderDevice, CreateBuffer,                    This, __VA_ARGS__)
 #    define IRenderDevice_CreateShader(This, ...)                    CALL_IFACE_METHOD(RenderDevice, CreateShader,                    This, __VA_ARGS__)
+#    define IRenderDevice_CreateShaders(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateShaders,                   This, __VA_ARGS__)
 #    define IRenderDevice_CreateTexture(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateTexture,                   This, __VA_ARGS__)
 #    define IRenderDevice_CreateSampler(This, ...)                   CALL_IFACE_METHOD(RenderDevice, CreateSampler,                   This, __VA_ARGS__)
 #    define IRenderDevice_CreateResourceMapping(This, ...)           CALL_IFACE_METHOD(RenderDevice, CreateResourceMapping,           This, __VA_ARGS__)
@@ -373,12 +523,20 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_CreateTLAS(This, ...)                      CALL_IFACE_METHOD(RenderDevice, CreateTLAS,                      This, __VA_ARGS__)
 #    define IRenderDevice_CreateSBT(This, ...)                       CALL_IFACE_METHOD(RenderDevice, CreateSBT,                       This, __VA_ARGS__)
 #    define IRenderDevice_CreatePipelineResourceSignature(This, ...) CALL_IFACE_METHOD(RenderDevice, CreatePipelineResourceSignature, This, __VA_ARGS__)
+#    define IRenderDevice_CreatePipelineStateCache(This, ...)        CALL_IFACE_METHOD(RenderDevice, CreatePipelineStateCache,        This, __VA_ARGS__)
+#    define IRenderDevice_CreatePipelineStateFromArchive(This, ...)  CALL_IFACE_METHOD(RenderDevice, CreatePipelineStateFromArchive,  This, __VA_ARGS__)
+#    define IRenderDevice_GetRecordedPipelineStates(This, ...)       CALL_IFACE_METHOD(RenderDevice, GetRecordedPipelineStates,       This, __VA_ARGS__)
+#    define IRenderDevice_ReplayPipelineStates(This, ...)            CALL_IFACE_METHOD(RenderDevice, ReplayPipelineStates,            This, __VA_ARGS__)
+#    define IRenderDevice_CreateResourceHeap(This, ...)              CALL_IFACE_METHOD(RenderDevice, CreateResourceHeap,              This, __VA_ARGS__)
 #    define IRenderDevice_GetAdapterInfo(This)                       CALL_IFACE_METHOD(RenderDevice, GetAdapterInfo,                  This)
 #    define IRenderDevice_GetDeviceInfo(This)                        CALL_IFACE_METHOD(RenderDevice, GetDeviceInfo,                   This)
 #    define IRenderDevice_GetTextureFormatInfo(This, ...)            CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfo,            This, __VA_ARGS__)
 #    define IRenderDevice_GetTextureFormatInfoExt(This, ...)         CALL_IFACE_METHOD(RenderDevice, GetTextureFormatInfoExt,         This, __VA_ARGS__)
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
+#    define IRenderDevice_GetMemoryStatistics(This, ...)             CALL_IFACE_METHOD(RenderDevice, GetMemoryStatistics,             This, __VA_ARGS__)
+#    define IRenderDevice_SetMemoryAllocationCallback(This, ...)     CALL_IFACE_METHOD(RenderDevice, SetMemoryAllocationCallback,     This, __VA_ARGS__)
+#    define IRenderDevice_CaptureResourceSnapshot(This, ...)         CALL_IFACE_METHOD(RenderDevice, CaptureResourceSnapshot,         This, __VA_ARGS__)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
 // clang-format on
 
@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IResourceHeap interface and related data structures
+
+#include "DeviceObject.h"
+#include "Buffer.h"
+#include "Texture.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {5D3C4B6A-2E61-4F0B-9A43-8C1E57D2B0F4}
+static const INTERFACE_ID IID_ResourceHeap =
+    {0x5d3c4b6a, 0x2e61, 0x4f0b, {0x9a, 0x43, 0x8c, 0x1e, 0x57, 0xd2, 0xb0, 0xf4}};
+
+// clang-format off
+
+/// Resource heap description
+struct ResourceHeapDesc DILIGENT_DERIVE(DeviceObjectAttribs)
+
+    /// Heap size, in bytes.
+    Uint64 Size                 DEFAULT_INITIALIZER(0);
+
+    /// Defines which immediate contexts are allowed to use resources placed in the heap.
+
+    /// \remarks Resources placed in the heap must use a subset of the heap's context mask.
+    Uint64 ImmediateContextMask DEFAULT_INITIALIZER(1);
+
+#if DILIGENT_CPP_INTERFACE
+    ResourceHeapDesc() noexcept {}
+
+    explicit ResourceHeapDesc(Uint64 _Size) noexcept :
+        Size{_Size}
+    {}
+#endif
+};
+typedef struct ResourceHeapDesc ResourceHeapDesc;
+
+
+/// Size and alignment of the memory required to place a resource in a resource heap
+struct ResourceAllocationInfo
+{
+    /// Memory size, in bytes.
+    Uint64 Size      DEFAULT_INITIALIZER(0);
+
+    /// Required offset alignment, in bytes.
+    Uint64 Alignment DEFAULT_INITIALIZER(0);
+};
+typedef struct ResourceAllocationInfo ResourceAllocationInfo;
+
+// clang-format on
+
+#define DILIGENT_INTERFACE_NAME IResourceHeap
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IResourceHeapInclusiveMethods \
+    IDeviceObjectInclusiveMethods;    \
+    IResourceHeapMethods ResourceHeap
+
+// clang-format off
+
+/// Resource heap interface
+
+/// Resource heap is a block of device memory in which textures and buffers are placed at
+/// application-defined offsets. Resources whose lifetimes within a frame do not overlap
+/// may be placed at overlapping offsets to reduce the memory footprint (memory aliasing).
+///
+/// When a resource starts using memory that was previously used by another resource, the
+/// application must issue an aliasing barrier by setting StateTransitionDesc::pResourceBefore.
+/// The contents of the resource are undefined after the barrier, so render targets and
+/// depth-stencil buffers must be cleared or fully overwritten before they are read.
+///
+/// A placed resource keeps a strong reference to its heap.
+///
+/// \remarks Only USAGE_DEFAULT resources without initial data may be placed in a heap.
+///          On backends that do not support resource heaps, IRenderDevice::CreateResourceHeap()
+///          returns null.
+DILIGENT_BEGIN_INTERFACE(IResourceHeap, IDeviceObject)
+{
+#if DILIGENT_CPP_INTERFACE
+    /// Returns the resource heap description used to create the object
+    virtual const ResourceHeapDesc& METHOD(GetDesc)() const override = 0;
+#endif
+
+    /// Returns the size and alignment of the memory required to place the texture in the heap.
+    VIRTUAL ResourceAllocationInfo METHOD(GetTextureAllocationInfo)(THIS_
+                                                                    const TextureDesc REF TexDesc) CONST PURE;
+
+    /// Returns the size and alignment of the memory required to place the buffer in the heap.
+    VIRTUAL ResourceAllocationInfo METHOD(GetBufferAllocationInfo)(THIS_
+                                                                   const BufferDesc REF BuffDesc) CONST PURE;
+
+    /// Creates a texture placed in the heap at the given offset.
+
+    /// \param [in]  TexDesc    - Texture description, see Diligent::TextureDesc for details.
+    /// \param [in]  Offset     - Offset from the beginning of the heap, in bytes. Must be a multiple of
+    ///                           the alignment returned by GetTextureAllocationInfo().
+    /// \param [out] ppTexture  - Address of the memory location where the pointer to the
+    ///                           texture interface will be stored.
+    ///                           The function calls AddRef(), so that the new object will have
+    ///                           one reference.
+    VIRTUAL void METHOD(CreateTexture)(THIS_
+                                       const TextureDesc REF TexDesc,
+                                       Uint64                Offset,
+                                       ITexture**            ppTexture) PURE;
+
+    /// Creates a buffer placed in the heap at the given offset.
+
+    /// \param [in]  BuffDesc   - Buffer description, see Diligent::BufferDesc for details.
+    /// \param [in]  Offset     - Offset from the beginning of the heap, in bytes. Must be a multiple of
+    ///                           the alignment returned by GetBufferAllocationInfo().
+    /// \param [out] ppBuffer   - Address of the memory location where the pointer to the
+    ///                           buffer interface will be stored.
+    ///                           The function calls AddRef(), so that the new object will have
+    ///                           one reference.
+    VIRTUAL void METHOD(CreateBuffer)(THIS_
+                                      const BufferDesc REF BuffDesc,
+                                      Uint64               Offset,
+                                      IBuffer**            ppBuffer) PURE;
+};
+DILIGENT_END_INTERFACE
+
+// clang-format on
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IResourceHeap_GetDesc(This) (const struct ResourceHeapDesc*)IDeviceObject_GetDesc(This)
+
+#    define IResourceHeap_GetTextureAllocationInfo(This, ...) CALL_IFACE_METHOD(ResourceHeap, GetTextureAllocationInfo, This, __VA_ARGS__)
+#    define IResourceHeap_GetBufferAllocationInfo(This, ...)  CALL_IFACE_METHOD(ResourceHeap, GetBufferAllocationInfo,  This, __VA_ARGS__)
+#    define IResourceHeap_CreateTexture(This, ...)            CALL_IFACE_METHOD(ResourceHeap, CreateTexture,            This, __VA_ARGS__)
+#    define IResourceHeap_CreateBuffer(This, ...)             CALL_IFACE_METHOD(ResourceHeap, CreateBuffer,             This, __VA_ARGS__)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -193,9 +193,58 @@ DILIGENT_TYPED_ENUM(SHADER_COMPILE_FLAGS, Uint32)
 };
 DEFINE_FLAG_ENUM_OPERATORS(SHADER_COMPILE_FLAGS);
 
+
+/// SPIR-V optimization level
+
+/// The level controls which spirv-opt passes are run on the SPIR-V code
+/// produced by the glslang front-end.
+DILIGENT_TYPED_ENUM(SHADER_OPTIMIZATION_LEVEL, Uint8)
+{
+    /// Use the default level: SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY in development
+    /// builds (fast iteration) and SHADER_OPTIMIZATION_LEVEL_PERFORMANCE otherwise.
+    SHADER_OPTIMIZATION_LEVEL_DEFAULT = 0,
+
+    /// Do not run the optimizer.
+    /// \warning SPIR-V generated from HLSL may not be valid Vulkan SPIR-V without legalization.
+    SHADER_OPTIMIZATION_LEVEL_NONE,
+
+    /// Only run the legalization passes required for HLSL-sourced SPIR-V.
+    /// GLSL-sourced SPIR-V is left unoptimized.
+    SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY,
+
+    /// Run legalization and performance passes.
+    SHADER_OPTIMIZATION_LEVEL_PERFORMANCE,
+
+    /// Run legalization and size-reduction passes.
+    SHADER_OPTIMIZATION_LEVEL_SIZE,
+
+    SHADER_OPTIMIZATION_NUM_LEVELS
+};
+
 // clang-format on
 
 
+/// Shader compilation time breakdown, in seconds.
+
+/// The statistics are currently only reported by the glslang-based compiler.
+/// Stages that were not executed have zero time.
+struct ShaderCompileStatistics
+{
+    /// Time spent preprocessing and parsing the source.
+    double ParseTime        DEFAULT_INITIALIZER(0);
+
+    /// Time spent linking the program and mapping IO.
+    double LinkTime         DEFAULT_INITIALIZER(0);
+
+    /// Time spent generating SPIR-V from the intermediate representation.
+    double CodeGenTime      DEFAULT_INITIALIZER(0);
+
+    /// Time spent in spirv-opt.
+    double OptimizationTime DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderCompileStatistics ShaderCompileStatistics;
+
+
 /// Shader creation attributes
 struct ShaderCreateInfo
 {
@@ -301,6 +350,15 @@ struct ShaderCreateInfo
     /// Shader compile flags (see Diligent::SHADER_COMPILE_FLAGS).
     SHADER_COMPILE_FLAGS CompileFlags DEFAULT_INITIALIZER(SHADER_COMPILE_FLAG_NONE);
 
+    /// SPIR-V optimization level (see Diligent::SHADER_OPTIMIZATION_LEVEL).
+
+    /// \note This member is currently only used by the glslang compiler in Vulkan backend.
+    SHADER_OPTIMIZATION_LEVEL OptimizationLevel DEFAULT_INITIALIZER(SHADER_OPTIMIZATION_LEVEL_DEFAULT);
+
+    /// Optional pointer to the structure that will receive the compile-time breakdown
+    /// (see Diligent::ShaderCompileStatistics).
+    ShaderCompileStatistics* pCompileStats DEFAULT_INITIALIZER(nullptr);
+
     /// Memory address where pointer to the compiler messages data blob will be written
 
     /// The buffer contains two null-terminated strings. The first one is the compiler
@@ -398,6 +456,21 @@ DILIGENT_BEGIN_INTERFACE(IShader, IDeviceObject)
     VIRTUAL void METHOD(GetResourceDesc)(THIS_
                                          Uint32 Index,
                                          ShaderResourceDesc REF ResourceDesc) CONST PURE;
+
+    /// Returns the shader byte code.
+
+    /// \param [out] ppBytecode - Address of the memory location where the pointer to the byte code will be written.
+    /// \param [out] Size       - Byte code size, in bytes.
+    ///
+    /// \remarks   Direct3D11 and Direct3D12 return DXBC or DXIL, Vulkan returns SPIR-V.
+    ///            The byte code may be passed to IRenderDevice::CreateShader() through ShaderCreateInfo::ByteCode
+    ///            to recreate the shader without compiling it. OpenGL shaders have no byte code,
+    ///            in which case null and zero are returned.
+    ///
+    ///            The byte code is owned by the shader and is valid as long as the shader is alive.
+    VIRTUAL void METHOD(GetBytecode)(THIS_
+                                     const void** ppBytecode,
+                                     Uint64 REF   Size) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -411,6 +484,7 @@ DILIGENT_END_INTERFACE
 
 #    define IShader_GetResourceCount(This)     CALL_IFACE_METHOD(Shader, GetResourceCount, This)
 #    define IShader_GetResourceDesc(This, ...) CALL_IFACE_METHOD(Shader, GetResourceDesc,  This, __VA_ARGS__)
+#    define IShader_GetBytecode(This, ...)     CALL_IFACE_METHOD(Shader, GetBytecode,      This, __VA_ARGS__)
 
 // clang-format on
 
@@ -114,8 +114,9 @@ DILIGENT_BEGIN_INTERFACE(IShaderResourceBinding, IObject)
     /// \remark Only mutable and dynamic variables can be accessed through this method.
     ///         Static variables are accessed through the Shader object.
     ///
-    /// \note   This operation may potentially be expensive. If the variable will be used often, it is
-    ///         recommended to store and reuse the pointer as it never changes.
+    /// \note   Variable indices are the same in all SRBs created by the same pipeline resource
+    ///         signature. An application may resolve the index once with IShaderResourceVariable::GetIndex()
+    ///         and use it to access the variable in every SRB without looking it up by name.
     VIRTUAL IShaderResourceVariable* METHOD(GetVariableByIndex)(THIS_
                                                                 SHADER_TYPE ShaderType,
                                                                 Uint32      Index) PURE;
@@ -91,7 +91,7 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
     
     /// Sets the maximum number of frames that the swap chain is allowed to queue for rendering.
 
-    /// This value is only relevant for D3D11 and D3D12 backends and ignored for others.
+    /// This value is only relevant for D3D11, D3D12 and Vulkan backends and ignored for others.
     /// By default it matches the number of buffers in the swap chain. For example, for a 2-buffer
     /// swap chain, the CPU can enqueue frames 0 and 1, but Present command of frame 2
     /// will block until frame 0 is presented. If in the example above the maximum frame latency is set
@@ -99,6 +99,20 @@ DILIGENT_BEGIN_INTERFACE(ISwapChain, IObject)
     VIRTUAL void METHOD(SetMaximumFrameLatency)(THIS_
                                                 Uint32 MaxLatency) PURE;
 
+    /// Blocks the calling thread until the swap chain can accept a new frame without
+    /// exceeding the maximum frame latency (see ISwapChain::SetMaximumFrameLatency).
+
+    /// To minimize input-to-photon latency, call this method at the beginning of the frame,
+    /// before sampling the input and recording commands. If the method has not been called
+    /// since the last Present(), Present() waits for the frame before presenting it.
+    ///
+    /// In D3D11 and D3D12 backends, the method waits for the frame latency waitable object
+    /// of the swap chain. In Vulkan backend, the method waits until the frame that is
+    /// MaxLatency frames behind the next one has been presented if VK_KHR_present_wait
+    /// extension is supported, or until the presentation engine has released its
+    /// image otherwise. In other backends the method does nothing.
+    VIRTUAL void METHOD(WaitForFrame)(THIS) PURE;
+
     /// Returns render target view of the current back buffer in the swap chain
 
     /// \note For Direct3D12 and Vulkan backends, the function returns
@@ -131,6 +145,7 @@ DILIGENT_END_INTERFACE
 #    define ISwapChain_SetFullscreenMode(This, ...)      CALL_IFACE_METHOD(SwapChain, SetFullscreenMode,       This, __VA_ARGS__)
 #    define ISwapChain_SetWindowedMode(This)             CALL_IFACE_METHOD(SwapChain, SetWindowedMode,         This)
 #    define ISwapChain_SetMaximumFrameLatency(This, ...) CALL_IFACE_METHOD(SwapChain, SetMaximumFrameLatency,  This, __VA_ARGS__)
+#    define ISwapChain_WaitForFrame(This)                CALL_IFACE_METHOD(SwapChain, WaitForFrame,            This)
 #    define ISwapChain_GetCurrentBackBufferRTV(This)     CALL_IFACE_METHOD(SwapChain, GetCurrentBackBufferRTV, This)
 #    define ISwapChain_GetDepthBufferDSV(This)           CALL_IFACE_METHOD(SwapChain, GetDepthBufferDSV,       This)
 
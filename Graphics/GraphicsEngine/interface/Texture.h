@@ -106,6 +106,12 @@ struct TextureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
     ///             will actually be used. Do not set unncessary bits as this will result in extra overhead.
     Uint64 ImmediateContextMask         DEFAULT_INITIALIZER(1);
 
+    /// Memory priority hint, see Diligent::MEMORY_PRIORITY.
+
+    /// \remarks   Render targets and depth-stencil textures that use the default priority
+    ///             are allocated with high priority.
+    MEMORY_PRIORITY MemoryPriority      DEFAULT_INITIALIZER(MEMORY_PRIORITY_DEFAULT);
+
 
 #if DILIGENT_CPP_INTERFACE
     TextureDesc()noexcept{}
@@ -163,7 +169,8 @@ struct TextureDesc DILIGENT_DERIVE(DeviceObjectAttribs)
                 CPUAccessFlags       == RHS.CPUAccessFlags &&
                 MiscFlags            == RHS.MiscFlags      &&
                 ClearValue           == RHS.ClearValue     &&
-                ImmediateContextMask == RHS.ImmediateContextMask;
+                ImmediateContextMask == RHS.ImmediateContextMask &&
+                MemoryPriority       == RHS.MemoryPriority;
     }
 #endif
 };
@@ -281,6 +288,36 @@ struct MappedTextureSubresource
 };
 typedef struct MappedTextureSubresource MappedTextureSubresource;
 
+/// Describes the tile layout of a sparse texture, see Diligent::MISC_TEXTURE_FLAG_SPARSE.
+struct SparseTextureProperties
+{
+    /// Tile width, in texels.
+    Uint32 TileWidth        DEFAULT_INITIALIZER(0);
+
+    /// Tile height, in texels.
+    Uint32 TileHeight       DEFAULT_INITIALIZER(0);
+
+    /// Tile depth, in texels.
+    Uint32 TileDepth        DEFAULT_INITIALIZER(0);
+
+    /// Size of one tile, in bytes. Heap offsets passed to IDeviceContext::UpdateTileMappings()
+    /// must be multiples of this value.
+    Uint32 TileSizeInBytes  DEFAULT_INITIALIZER(0);
+
+    /// The first mip level that is packed into the mip tail.
+    /// Mip levels starting from this one can not be mapped tile by tile; the entire
+    /// tail of an array slice is mapped at once.
+    /// If the value is equal to TextureDesc::MipLevels, the texture has no mip tail.
+    Uint32 FirstMipInTail   DEFAULT_INITIALIZER(0);
+
+    /// Size of the mip tail of one array slice, in bytes.
+    Uint64 MipTailSize      DEFAULT_INITIALIZER(0);
+
+    /// The amount of memory required to make the entire texture resident, in bytes.
+    Uint64 MemorySize       DEFAULT_INITIALIZER(0);
+};
+typedef struct SparseTextureProperties SparseTextureProperties;
+
 #define DILIGENT_INTERFACE_NAME ITexture
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -313,6 +350,9 @@ DILIGENT_BEGIN_INTERFACE(ITexture, IDeviceObject)
     ///          For non-array textures, the only allowed values for the number of slices are 0 and 1.\n
     ///          Texture view will contain strong reference to the texture, so the texture will not be destroyed
     ///          until all views are released.\n
+    ///          If a view with the same description (ignoring the name) created by this method is still alive,
+    ///          the method returns that view instead of creating a new one. Note that the views are then shared,
+    ///          so a sampler set by ITextureView::SetSampler() is seen by all users of the view.\n
     ///          The function calls AddRef() for the created interface, so it must be released by
     ///          a call to Release() when it is no longer needed.
     VIRTUAL void METHOD(CreateView)(THIS_
@@ -349,6 +389,11 @@ DILIGENT_BEGIN_INTERFACE(ITexture, IDeviceObject)
 
     /// Returns the internal texture state
     VIRTUAL RESOURCE_STATE METHOD(GetState)(THIS) CONST PURE;
+
+    /// Returns the tile layout of a sparse texture.
+
+    /// \remarks The texture must have been created with Diligent::MISC_TEXTURE_FLAG_SPARSE flag.
+    VIRTUAL const SparseTextureProperties REF METHOD(GetSparseProperties)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -360,11 +405,12 @@ DILIGENT_END_INTERFACE
 
 #    define ITexture_GetDesc(This) (const struct TextureDesc*)IDeviceObject_GetDesc(This)
 
-#    define ITexture_CreateView(This, ...)     CALL_IFACE_METHOD(Texture, CreateView,      This, __VA_ARGS__)
-#    define ITexture_GetDefaultView(This, ...) CALL_IFACE_METHOD(Texture, GetDefaultView,  This, __VA_ARGS__)
-#    define ITexture_GetNativeHandle(This)     CALL_IFACE_METHOD(Texture, GetNativeHandle, This)
-#    define ITexture_SetState(This, ...)       CALL_IFACE_METHOD(Texture, SetState,        This, __VA_ARGS__)
-#    define ITexture_GetState(This)            CALL_IFACE_METHOD(Texture, GetState,        This)
+#    define ITexture_CreateView(This, ...)     CALL_IFACE_METHOD(Texture, CreateView,          This, __VA_ARGS__)
+#    define ITexture_GetDefaultView(This, ...) CALL_IFACE_METHOD(Texture, GetDefaultView,      This, __VA_ARGS__)
+#    define ITexture_GetNativeHandle(This)     CALL_IFACE_METHOD(Texture, GetNativeHandle,     This)
+#    define ITexture_SetState(This, ...)       CALL_IFACE_METHOD(Texture, SetState,            This, __VA_ARGS__)
+#    define ITexture_GetState(This)            CALL_IFACE_METHOD(Texture, GetState,            This)
+#    define ITexture_GetSparseProperties(This) CALL_IFACE_METHOD(Texture, GetSparseProperties, This)
 
 // clang-format on
 
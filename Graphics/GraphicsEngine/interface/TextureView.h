@@ -224,6 +224,17 @@ DILIGENT_BEGIN_INTERFACE(ITextureView, IDeviceObject)
     /// The method does *NOT* call AddRef() on the returned interface,
     /// so Release() must not be called.
     VIRTUAL struct ITexture* METHOD(GetTexture)(THIS) PURE;
+
+
+    /// Returns the index of the view in the device-wide bindless descriptor heap.
+
+    /// \remarks   The index is persistent for the lifetime of the view and may be
+    ///            used to access the resource through a shader variable defined with
+    ///            PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP flag.
+    ///            If the bindless heap is disabled, not supported by the backend or
+    ///            the view type can't be placed in the heap, the method returns
+    ///            INVALID_BINDLESS_INDEX.
+    VIRTUAL Uint32 METHOD(GetBindlessIndex)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -235,9 +246,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define ITextureView_SetSampler(This, ...) CALL_IFACE_METHOD(TextureView, SetSampler, This, __VA_ARGS__)
-#    define ITextureView_GetSampler(This)      CALL_IFACE_METHOD(TextureView, GetSampler, This)
-#    define ITextureView_GetTexture(This)      CALL_IFACE_METHOD(TextureView, GetTexture, This)
+#    define ITextureView_SetSampler(This, ...)  CALL_IFACE_METHOD(TextureView, SetSampler,       This, __VA_ARGS__)
+#    define ITextureView_GetSampler(This)       CALL_IFACE_METHOD(TextureView, GetSampler,       This)
+#    define ITextureView_GetTexture(This)       CALL_IFACE_METHOD(TextureView, GetTexture,       This)
+#    define ITextureView_GetBindlessIndex(This) CALL_IFACE_METHOD(TextureView, GetBindlessIndex, This)
 
 // clang-format on
 
@@ -173,6 +173,20 @@ DILIGENT_BEGIN_INTERFACE(ITopLevelAS, IDeviceObject)
     /// \note Access to the TLAS must be externally synchronized.
     VIRTUAL TLASInstanceDesc METHOD(GetInstanceDesc)(THIS_
                                                      const char* Name) CONST PURE;
+
+
+    /// Returns instance description by the instance index.
+
+    /// \param [in] Index - Instance index, which is the index of the instance in BuildTLASAttribs::pInstances
+    ///                     that was used to build the TLAS.
+    /// \return TLASInstanceDesc object, see Diligent::TLASInstanceDesc.
+    ///         If the index is out of range then TLASInstanceDesc::ContributionToHitGroupIndex
+    ///         and TLASInstanceDesc::InstanceIndex are set to INVALID_INDEX.
+    ///
+    /// \note This is the only way to query instances that were built without a name.
+    ///       Access to the TLAS must be externally synchronized.
+    VIRTUAL TLASInstanceDesc METHOD(GetInstanceDescByIndex)(THIS_
+                                                            Uint32 Index) CONST PURE;
     
 
     /// Returns TLAS state after the last build or update operation.
@@ -218,12 +232,13 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define ITopLevelAS_GetInstanceDesc(This, ...)  CALL_IFACE_METHOD(TopLevelAS, GetInstanceDesc,       This, __VA_ARGS__)
-#    define ITopLevelAS_GetBuildInfo(This)          CALL_IFACE_METHOD(TopLevelAS, GetBuildInfo,          This)
-#    define ITopLevelAS_GetScratchBufferSizes(This) CALL_IFACE_METHOD(TopLevelAS, GetScratchBufferSizes, This)
-#    define ITopLevelAS_GetNativeHandle(This)       CALL_IFACE_METHOD(TopLevelAS, GetNativeHandle,       This)
-#    define ITopLevelAS_SetState(This, ...)         CALL_IFACE_METHOD(TopLevelAS, SetState,              This, __VA_ARGS__)
-#    define ITopLevelAS_GetState(This)              CALL_IFACE_METHOD(TopLevelAS, GetState,              This)
+#    define ITopLevelAS_GetInstanceDesc(This, ...)        CALL_IFACE_METHOD(TopLevelAS, GetInstanceDesc,        This, __VA_ARGS__)
+#    define ITopLevelAS_GetInstanceDescByIndex(This, ...) CALL_IFACE_METHOD(TopLevelAS, GetInstanceDescByIndex, This, __VA_ARGS__)
+#    define ITopLevelAS_GetBuildInfo(This)                CALL_IFACE_METHOD(TopLevelAS, GetBuildInfo,           This)
+#    define ITopLevelAS_GetScratchBufferSizes(This)       CALL_IFACE_METHOD(TopLevelAS, GetScratchBufferSizes,  This)
+#    define ITopLevelAS_GetNativeHandle(This)             CALL_IFACE_METHOD(TopLevelAS, GetNativeHandle,        This)
+#    define ITopLevelAS_SetState(This, ...)               CALL_IFACE_METHOD(TopLevelAS, SetState,               This, __VA_ARGS__)
+#    define ITopLevelAS_GetState(This)                    CALL_IFACE_METHOD(TopLevelAS, GetState,               This)
 
 // clang-format on
 
@@ -78,6 +78,21 @@ void ValidateBufferDesc(const BufferDesc& Desc, const IRenderDevice* pDevice) no
     if ((Desc.BindFlags & BIND_RAY_TRACING) != 0)
         VERIFY_BUFFER(Features.RayTracing, "BIND_RAY_TRACING flag can't be used when RayTracing feature is not enabled.");
 
+    if ((Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) != 0)
+    {
+        VERIFY_BUFFER(Features.SparseResources, "MISC_BUFFER_FLAG_SPARSE flag can't be used when SparseResources feature is not enabled.");
+        VERIFY_BUFFER(Desc.Usage == USAGE_DEFAULT, "sparse buffers must use USAGE_DEFAULT.");
+    }
+
+    if ((Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS) != 0)
+    {
+        VERIFY_BUFFER(Features.BufferDeviceAddress, "MISC_BUFFER_FLAG_DEVICE_ADDRESS flag can't be used when BufferDeviceAddress feature is not enabled.");
+        // Dynamic buffer data is suballocated from a ring buffer every time the buffer is mapped,
+        // so its address is not persistent.
+        VERIFY_BUFFER(Desc.Usage != USAGE_DYNAMIC && Desc.Usage != USAGE_STAGING,
+                      "MISC_BUFFER_FLAG_DEVICE_ADDRESS flag can't be used with USAGE_DYNAMIC or USAGE_STAGING buffers.");
+    }
+
     switch (Desc.Usage)
     {
         case USAGE_IMMUTABLE:
@@ -142,6 +157,9 @@ void ValidateBufferInitData(const BufferDesc& Desc, const BufferData* pBuffData)
     if (Desc.Usage == USAGE_DYNAMIC && pBuffData != nullptr && pBuffData->pData != nullptr)
         LOG_BUFFER_ERROR_AND_THROW("initial data must be null for dynamic buffers.");
 
+    if ((Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) != 0 && pBuffData != nullptr && pBuffData->pData != nullptr)
+        LOG_BUFFER_ERROR_AND_THROW("sparse buffers can not be initialized with data at creation time.");
+
     if (Desc.Usage == USAGE_STAGING)
     {
         if (Desc.CPUAccessFlags == CPU_ACCESS_WRITE)
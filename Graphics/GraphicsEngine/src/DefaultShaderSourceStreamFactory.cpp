@@ -27,33 +27,237 @@
 
 #include "DefaultShaderSourceStreamFactory.h"
 
+#include <algorithm>
+#include <cstring>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
+#include "FileSystem.hpp"
 #include "BasicFileStream.hpp"
+#include "MappedFileStream.hpp"
+#include "AsyncFileReader.hpp"
+#include "ProxyDataBlob.hpp"
+#include "StringTools.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Read-only stream over the file data shared with the factory cache.
+// ReadBlob2() returns blobs that reference the shared data, so the data is never copied.
+class SharedDataFileStream final : public ObjectBase<IFileStream>
+{
+public:
+    using TBase = ObjectBase<IFileStream>;
+
+    SharedDataFileStream(IReferenceCounters* pRefCounters, IDataBlob* pData) :
+        TBase{pRefCounters},
+        m_pData{pData}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_FileStream, TBase)
+
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override final
+    {
+        const auto BytesToRead = std::min(m_pData->GetSize() - m_CurrentOffset, Size);
+        memcpy(Data, static_cast<const Uint8*>(m_pData->GetConstDataPtr()) + m_CurrentOffset, BytesToRead);
+        m_CurrentOffset += BytesToRead;
+        return BytesToRead == Size;
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override final
+    {
+        VERIFY_EXPR(pData != nullptr);
+        pData->Resize(m_pData->GetSize() - m_CurrentOffset);
+        Read(pData->GetDataPtr(), pData->GetSize());
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReadBlob2(IDataBlob** ppData) override final
+    {
+        VERIFY_EXPR(ppData != nullptr && *ppData == nullptr);
+        const auto* pData = static_cast<const Uint8*>(m_pData->GetConstDataPtr()) + m_CurrentOffset;
+        const auto  Size  = m_pData->GetSize() - m_CurrentOffset;
+        m_CurrentOffset += Size;
+
+        auto* pDataBlob = MakeNewRCObj<ProxyDataBlob>{}(pData, Size, m_pData);
+        pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppData));
+    }
+
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override final
+    {
+        UNSUPPORTED("Shared data file stream is read-only");
+        return false;
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override final
+    {
+        return m_pData->GetSize();
+    }
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override final
+    {
+        return true;
+    }
+
+private:
+    RefCntAutoPtr<IDataBlob> m_pData;
+    size_t                   m_CurrentOffset = 0;
+};
+
+// The state is shared between the factory and the file reader tasks, which may outlive the factory.
+struct SourceFileState
+{
+    std::vector<String> SearchDirectories;
+
+    std::mutex Mtx;
+
+    // Include files that are read ahead on the shared file reader threads.
+    // Entries that are never requested (e.g. includes disabled by conditional directives)
+    // are kept until the factory is released.
+    struct PrefetchEntry
+    {
+        bool                     Ready = false;
+        RefCntAutoPtr<IDataBlob> pData;
+    };
+    std::condition_variable                   ReadCompleteCV;
+    std::unordered_map<String, PrefetchEntry> PrefetchEntries;
+
+    // Contents of the files that were read by the factory, keyed by the requested name.
+    // An entry is only used while the status of the file matches the status it was read with.
+    struct CachedFile
+    {
+        String                   Path;
+        FileStatus               Status;
+        RefCntAutoPtr<IDataBlob> pData;
+        Uint32                   NumIncludes = 0;
+    };
+    std::unordered_map<String, CachedFile> FileCache;
+
+    ShaderSourceStreamFactoryStats Stats;
+
+    String GetFullPath(const String& SearchDir, const Char* Name) const
+    {
+        return SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
+    }
+
+    std::vector<std::string> GetCandidatePaths(const Char* Name) const
+    {
+        std::vector<std::string> Paths;
+        Paths.reserve(SearchDirectories.size());
+        for (const auto& SearchDir : SearchDirectories)
+            Paths.emplace_back(GetFullPath(SearchDir, Name));
+        return Paths;
+    }
+};
+
+// Starts reading all files included by the source that are neither cached nor being read yet.
+// Once an include file is read, the files it includes are prefetched in turn.
+void PrefetchIncludes(const std::shared_ptr<SourceFileState>& pState, const char* Source, size_t SourceLength)
+{
+    std::vector<String> NewIncludes;
+    {
+        std::lock_guard<std::mutex> Lock{pState->Mtx};
+        ForEachIncludeDirective(Source, SourceLength, [&](String&& Name) {
+            // Cached files are validated when they are requested
+            if (pState->FileCache.find(Name) != pState->FileCache.end())
+                return;
+            if (pState->PrefetchEntries.emplace(Name, SourceFileState::PrefetchEntry{}).second)
+                NewIncludes.emplace_back(std::move(Name));
+        });
+    }
+
+    for (auto& Name : NewIncludes)
+    {
+        AsyncFileReader::GetSharedInstance().ReadFile(
+            pState->GetCandidatePaths(Name.c_str()),
+            [pState, Name](IDataBlob* pData) {
+                {
+                    std::lock_guard<std::mutex> Lock{pState->Mtx};
+                    auto                        it = pState->PrefetchEntries.find(Name);
+                    if (it != pState->PrefetchEntries.end())
+                    {
+                        it->second.Ready = true;
+                        it->second.pData = pData;
+                    }
+                    if (pData != nullptr)
+                    {
+                        ++pState->Stats.NumFilesRead;
+                        pState->Stats.BytesRead += pData->GetSize();
+                    }
+                }
+                pState->ReadCompleteCV.notify_all();
+
+                if (pData != nullptr)
+                    PrefetchIncludes(pState, static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize());
+            });
+    }
+}
+
+} // namespace
+
+// {8C5F6B5E-3C2A-4F0B-9D4E-6E1A2B7C9D31}
+static const INTERFACE_ID IID_DefaultShaderSourceStreamFactory =
+    {0x8c5f6b5e, 0x3c2a, 0x4f0b, {0x9d, 0x4e, 0x6e, 0x1a, 0x2b, 0x7c, 0x9d, 0x31}};
+
 class DefaultShaderSourceStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
 {
 public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
     DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories);
 
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final
+    {
+        if (ppInterface == nullptr)
+            return;
+
+        if (IID == IID_DefaultShaderSourceStreamFactory || IID == IID_IShaderSourceInputStreamFactory)
+        {
+            *ppInterface = this;
+            (*ppInterface)->AddRef();
+        }
+        else
+        {
+            TBase::QueryInterface(IID, ppInterface);
+        }
+    }
+
     virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
 
     virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
                                                        CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                        IFileStream**                           ppStream) override final;
 
-    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
+    ShaderSourceStreamFactoryStats GetStats() const;
 
 private:
-    std::vector<String> m_SearchDirectories;
+    // Returns the prefetched include file data, if the file is being prefetched
+    bool TakePrefetchedData(const Char* Name, RefCntAutoPtr<IDataBlob>& pData);
+
+    // Returns the cached file data if the file has not been modified since it was read
+    RefCntAutoPtr<IDataBlob> FindCachedData(const Char* Name);
+
+    // Reads the file and adds it to the cache. Returns null if the file can't be read or
+    // the platform can't detect file modifications.
+    RefCntAutoPtr<IDataBlob> ReadAndCacheFile(const Char* Name, const String& FullPath, const FileStatus& Status);
+
+    std::shared_ptr<SourceFileState> m_pState;
+
+    const std::vector<String>& m_SearchDirectories;
 };
 
 DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
-    ObjectBase<IShaderSourceInputStreamFactory>(pRefCounters)
+    TBase{pRefCounters},
+    m_pState{std::make_shared<SourceFileState>()},
+    m_SearchDirectories{m_pState->SearchDirectories}
 {
     while (SearchDirectories)
     {
@@ -74,10 +278,120 @@ DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCou
         {
             if (SearchPath.back() != '\\' && SearchPath.back() != '/')
                 SearchPath.push_back('\\');
-            m_SearchDirectories.push_back(SearchPath);
+            m_pState->SearchDirectories.push_back(SearchPath);
         }
     }
-    m_SearchDirectories.push_back("");
+    m_pState->SearchDirectories.push_back("");
+}
+
+bool DefaultShaderSourceStreamFactory::TakePrefetchedData(const Char* Name, RefCntAutoPtr<IDataBlob>& pData)
+{
+    std::unique_lock<std::mutex> Lock{m_pState->Mtx};
+
+    auto& Entries = m_pState->PrefetchEntries;
+
+    auto it = Entries.find(Name);
+    if (it == Entries.end())
+        return false;
+
+    // Other reads may insert new entries while the mutex is released, which invalidates the iterator
+    m_pState->ReadCompleteCV.wait(Lock, [&] {
+        it = Entries.find(Name);
+        return it->second.Ready;
+    });
+    pData = std::move(it->second.pData);
+    // The data is handed out once: the file status is not known for the prefetched data,
+    // so the file is read and cached next time it is requested.
+    Entries.erase(it);
+    return true;
+}
+
+RefCntAutoPtr<IDataBlob> DefaultShaderSourceStreamFactory::FindCachedData(const Char* Name)
+{
+    String     Path;
+    FileStatus CachedStatus;
+    {
+        std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+
+        auto it = m_pState->FileCache.find(Name);
+        if (it == m_pState->FileCache.end())
+            return {};
+
+        Path         = it->second.Path;
+        CachedStatus = it->second.Status;
+    }
+
+    // Query the file status without holding the lock
+    FileStatus Status;
+    const bool IsValid = FileSystem::GetFileStatus(Path.c_str(), Status) && Status == CachedStatus;
+
+    std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+
+    auto it = m_pState->FileCache.find(Name);
+    if (it == m_pState->FileCache.end())
+        return {};
+
+    if (!IsValid)
+    {
+        // The file has been modified or deleted
+        ++m_pState->Stats.NumInvalidations;
+        m_pState->FileCache.erase(it);
+        return {};
+    }
+
+    ++m_pState->Stats.NumCacheHits;
+    m_pState->Stats.BytesServedFromCache += it->second.pData->GetSize();
+    return it->second.pData;
+}
+
+RefCntAutoPtr<IDataBlob> DefaultShaderSourceStreamFactory::ReadAndCacheFile(const Char* Name, const String& FullPath, const FileStatus& Status)
+{
+    // The file contents are copied into memory rather than mapped, because
+    // the file may be modified by the application while it is in the cache.
+    RefCntAutoPtr<BasicFileStream> pFileStream{MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read)};
+    if (!pFileStream->IsValid())
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pData;
+    pFileStream->ReadBlob2(&pData);
+    if (!pData)
+        return {};
+
+    SourceFileState::CachedFile File;
+    File.Path   = FullPath;
+    File.Status = Status;
+    File.pData  = pData;
+    ForEachIncludeDirective(static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize(), [&File](String&&) { ++File.NumIncludes; });
+
+    // Do not cache the data if the file was modified while it was being read
+    FileStatus StatusAfterRead;
+    const bool IsUnmodified = FileSystem::GetFileStatus(FullPath.c_str(), StatusAfterRead) && StatusAfterRead == Status;
+
+    std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+    ++m_pState->Stats.NumFilesRead;
+    m_pState->Stats.BytesRead += pData->GetSize();
+    if (IsUnmodified)
+        m_pState->FileCache[Name] = std::move(File);
+
+    return pData;
+}
+
+ShaderSourceStreamFactoryStats DefaultShaderSourceStreamFactory::GetStats() const
+{
+    std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+
+    auto Stats = m_pState->Stats;
+
+    Stats.NumCachedFiles       = static_cast<Uint32>(m_pState->FileCache.size());
+    Stats.NumIncludeDirectives = 0;
+    Stats.CachedDataSize       = 0;
+    for (const auto& it : m_pState->FileCache)
+    {
+        Stats.NumIncludeDirectives += it.second.NumIncludes;
+        Stats.CachedDataSize += it.second.pData->GetSize();
+    }
+
+    return Stats;
 }
 
 void DefaultShaderSourceStreamFactory::CreateInputStream(const Char*   Name,
@@ -90,27 +404,84 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
                                                           CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                           IFileStream**                           ppStream)
 {
-    bool                                     bFileCreated = false;
-    Diligent::RefCntAutoPtr<BasicFileStream> pBasicFileStream;
+    {
+        std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+        ++m_pState->Stats.NumRequests;
+    }
+
+    if (auto pCachedData = FindCachedData(Name))
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<SharedDataFileStream>()(pCachedData)};
+        *ppStream = pStream.Detach();
+        return;
+    }
+
+    RefCntAutoPtr<IDataBlob> pPrefetchedData;
+    if (TakePrefetchedData(Name, pPrefetchedData) && pPrefetchedData)
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<SharedDataFileStream>()(pPrefetchedData)};
+        *ppStream = pStream.Detach();
+        return;
+    }
+
+    bool                                 bFileCreated = false;
+    Diligent::RefCntAutoPtr<IFileStream> pFileStream;
     for (const auto& SearchDir : m_SearchDirectories)
     {
-        String FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
+        String FullPath = m_pState->GetFullPath(SearchDir, Name);
+
+        FileStatus Status;
+        if (FileSystem::GetFileStatus(FullPath.c_str(), Status))
+        {
+            if (auto pData = ReadAndCacheFile(Name, FullPath, Status))
+            {
+                // Start reading the files included by this one on the reader threads: compilers
+                // resolve includes one by one, so reading them sequentially on demand is dominated
+                // by the I/O latency.
+                PrefetchIncludes(m_pState, static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize());
+
+                pFileStream = MakeNewRCObj<SharedDataFileStream>()(pData);
+                bFileCreated = true;
+                break;
+            }
+        }
+
+        // The platform can't detect file modifications - read the file without caching it
         if (!FileSystem::FileExists(FullPath.c_str()))
             continue;
-        pBasicFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
-        if (pBasicFileStream->IsValid())
+
+        // Memory-mapped stream avoids copying the file contents when the data is read with ReadBlob2().
+        // Fall back to the basic stream if the platform can't map the file.
+        pFileStream = MakeNewRCObj<MappedFileStream>()(FullPath.c_str());
+        if (!pFileStream->IsValid())
+            pFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
+
+        if (pFileStream->IsValid())
         {
             bFileCreated = true;
+            {
+                std::lock_guard<std::mutex> Lock{m_pState->Mtx};
+                ++m_pState->Stats.NumFilesRead;
+                m_pState->Stats.BytesRead += pFileStream->GetSize();
+            }
+
+            // The stream is handed out unread, so the includes are scanned on the reader thread
+            AsyncFileReader::GetSharedInstance().ReadFile(
+                {FullPath},
+                [pState = m_pState](IDataBlob* pData) {
+                    if (pData != nullptr)
+                        PrefetchIncludes(pState, static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize());
+                });
             break;
         }
         else
         {
-            pBasicFileStream.Release();
+            pFileStream.Release();
         }
     }
     if (bFileCreated)
     {
-        pBasicFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+        pFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
     }
     else
     {
@@ -132,4 +503,18 @@ void CreateDefaultShaderSourceStreamFactory(const Char*                       Se
     pStreamFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppShaderSourceStreamFactory));
 }
 
+bool GetDefaultShaderSourceStreamFactoryStats(IShaderSourceInputStreamFactory* pFactory, ShaderSourceStreamFactoryStats* pStats)
+{
+    DEV_CHECK_ERR(pStats != nullptr, "pStats must not be null");
+    if (pFactory == nullptr || pStats == nullptr)
+        return false;
+
+    RefCntAutoPtr<DefaultShaderSourceStreamFactory> pDefaultFactory{pFactory, IID_DefaultShaderSourceStreamFactory};
+    if (!pDefaultFactory)
+        return false;
+
+    *pStats = pDefaultFactory->GetStats();
+    return true;
+}
+
 } // namespace Diligent
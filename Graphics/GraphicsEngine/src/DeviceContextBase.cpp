@@ -27,7 +27,10 @@
 
 #include "DeviceContextBase.hpp"
 
+#include <unordered_set>
+
 #include "GraphicsAccessories.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -95,6 +98,14 @@ bool VerifyDrawIndirectAttribs(const DrawIndirectAttribs& Attribs, const IBuffer
     CHECK_DRAW_INDIRECT_ATTRIBS(pAttribsBuffer != nullptr, "indirect draw arguments buffer must not be null.");
     CHECK_DRAW_INDIRECT_ATTRIBS((pAttribsBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
                                 "indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    if (Attribs.DrawCount > 1)
+    {
+        CHECK_DRAW_INDIRECT_ATTRIBS(Attribs.DrawArgsStride >= DrawIndirectCommandStride && (Attribs.DrawArgsStride % 4) == 0,
+                                    "DrawArgsStride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and no less than ", DrawIndirectCommandStride, ".");
+    }
+    CHECK_DRAW_INDIRECT_ATTRIBS(Attribs.DrawCount == 0 ||
+                                    Attribs.IndirectDrawArgsOffset + Uint64{Attribs.DrawArgsStride} * (Attribs.DrawCount - 1) + DrawIndirectCommandStride <= pAttribsBuffer->GetDesc().uiSizeInBytes,
+                                "invalid IndirectDrawArgsOffset or indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' is too small.");
 
 #undef CHECK_DRAW_INDIRECT_ATTRIBS
 
@@ -111,12 +122,65 @@ bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs,
     CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS((pAttribsBuffer->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
                                         "indirect draw arguments buffer '",
                                         pAttribsBuffer->GetDesc().Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    if (Attribs.DrawCount > 1)
+    {
+        CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Attribs.DrawArgsStride >= DrawIndexedIndirectCommandStride && (Attribs.DrawArgsStride % 4) == 0,
+                                            "DrawArgsStride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and no less than ", DrawIndexedIndirectCommandStride, ".");
+    }
+    CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS(Attribs.DrawCount == 0 ||
+                                            Attribs.IndirectDrawArgsOffset + Uint64{Attribs.DrawArgsStride} * (Attribs.DrawCount - 1) + DrawIndexedIndirectCommandStride <= pAttribsBuffer->GetDesc().uiSizeInBytes,
+                                        "invalid IndirectDrawArgsOffset or indirect draw arguments buffer '", pAttribsBuffer->GetDesc().Name, "' is too small.");
 
 #undef CHECK_DRAW_INDEXED_INDIRECT_ATTRIBS
 
     return true;
 }
 
+template <typename AttribsType>
+static bool VerifyDrawIndirectCountAttribsImpl(const AttribsType& Attribs,
+                                               const IBuffer*     pAttribsBuffer,
+                                               const IBuffer*     pCountBuff,
+                                               Uint32             ArgsSize,
+                                               const char*        AttribsName)
+{
+#define CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, AttribsName, " are invalid: ", __VA_ARGS__)
+
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(pAttribsBuffer != nullptr, "indirect draw arguments buffer must not be null.");
+
+    const auto& IDesc = pAttribsBuffer->GetDesc();
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS((IDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                      "indirect draw arguments buffer '", IDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(Attribs.DrawArgsStride >= ArgsSize && (Attribs.DrawArgsStride % 4) == 0,
+                                      "DrawArgsStride (", Attribs.DrawArgsStride, ") must be a multiple of 4 and no less than ", ArgsSize, ".");
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(Attribs.MaxCommandCount == 0 ||
+                                          Attribs.IndirectDrawArgsOffset + Uint64{Attribs.DrawArgsStride} * (Attribs.MaxCommandCount - 1) + ArgsSize <= IDesc.uiSizeInBytes,
+                                      "invalid IndirectDrawArgsOffset or indirect draw arguments buffer '", IDesc.Name, "' is too small.");
+
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(pCountBuff != nullptr, "count buffer must not be null.");
+
+    const auto& CDesc = pCountBuff->GetDesc();
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS((CDesc.BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                                      "count buffer '", CDesc.Name, "' was not created with BIND_INDIRECT_DRAW_ARGS flag.");
+    CHECK_DRAW_INDIRECT_COUNT_ATTRIBS(Attribs.CountBufferOffset + 4 <= CDesc.uiSizeInBytes,
+                                      "invalid CountBufferOffset or count buffer '", CDesc.Name, "' is too small.");
+
+#undef CHECK_DRAW_INDIRECT_COUNT_ATTRIBS
+
+    return true;
+}
+
+bool VerifyDrawIndirectCountAttribs(const DrawIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff)
+{
+    return VerifyDrawIndirectCountAttribsImpl(Attribs, pAttribsBuffer, pCountBuff, DrawIndirectCommandStride, "Draw indirect count attribs");
+}
+
+bool VerifyDrawIndexedIndirectCountAttribs(const DrawIndexedIndirectCountAttribs& Attribs, const IBuffer* pAttribsBuffer, const IBuffer* pCountBuff)
+{
+    CHECK_PARAMETER(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                    "Draw indexed indirect count attribs are invalid: IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+    return VerifyDrawIndirectCountAttribsImpl(Attribs, pAttribsBuffer, pCountBuff, DrawIndexedIndirectCommandStride, "Draw indexed indirect count attribs");
+}
+
 bool VerifyDrawMeshIndirectAttribs(const DrawMeshIndirectAttribs& Attribs, const IBuffer* pAttribsBuffer)
 {
 #define CHECK_DRAW_MESH_INDIRECT_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Draw mesh indirect attribs are invalid: ", __VA_ARGS__)
@@ -228,6 +292,85 @@ bool VerifyResolveTextureSubresourceAttribs(const ResolveTextureSubresourceAttri
     return true;
 }
 
+bool VerifyUpdateTileMappingsAttribs(const UpdateTileMappingsAttribs& Attribs)
+{
+#define CHECK_TILE_MAPPINGS_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Update tile mappings attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_TILE_MAPPINGS_ATTRIBS((Attribs.pTexture != nullptr) != (Attribs.pBuffer != nullptr), "exactly one of pTexture and pBuffer must not be null.");
+    CHECK_TILE_MAPPINGS_ATTRIBS(Attribs.NumRanges == 0 || Attribs.pRanges != nullptr, "NumRanges is ", Attribs.NumRanges, ", but pRanges is null.");
+
+    if (Attribs.pBuffer != nullptr)
+    {
+        const auto& BuffDesc = Attribs.pBuffer->GetDesc();
+        CHECK_TILE_MAPPINGS_ATTRIBS((BuffDesc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) != 0,
+                                    "buffer '", BuffDesc.Name, "' was not created with MISC_BUFFER_FLAG_SPARSE flag.");
+
+        const Uint64 BlockSize = Attribs.pBuffer->GetSparseBlockSize();
+        const Uint64 NumBlocks = (Uint64{BuffDesc.uiSizeInBytes} + BlockSize - 1) / BlockSize;
+        for (Uint32 i = 0; i < Attribs.NumRanges; ++i)
+        {
+            const auto& Range = Attribs.pRanges[i];
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.MipLevel == 0 && Range.ArraySlice == 0 && Range.TileY == 0 && Range.NumTilesY == 1,
+                                        "pRanges[", i, "] of a buffer must have zero MipLevel, ArraySlice and TileY, and NumTilesY equal to 1.");
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.NumTilesX > 0, "pRanges[", i, "] is empty.");
+            CHECK_TILE_MAPPINGS_ATTRIBS(Uint64{Range.TileX} + Range.NumTilesX <= NumBlocks,
+                                        "pRanges[", i, "] exceeds the number of blocks (", NumBlocks, ") of buffer '", BuffDesc.Name, "'.");
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.HeapOffset % BlockSize == 0, "pRanges[", i, "].HeapOffset (", Range.HeapOffset,
+                                        ") is not a multiple of the block size (", BlockSize, ").");
+            if (Range.pHeap != nullptr)
+            {
+                const auto&  HeapDesc   = Range.pHeap->GetDesc();
+                const Uint64 MemorySize = Range.NumTilesX * BlockSize;
+                CHECK_TILE_MAPPINGS_ATTRIBS(Range.HeapOffset + MemorySize <= HeapDesc.Size, "pRanges[", i, "] maps ", MemorySize, " bytes at offset ", Range.HeapOffset,
+                                            ", which exceeds the size (", HeapDesc.Size, ") of heap '", HeapDesc.Name, "'.");
+            }
+        }
+        return true;
+    }
+
+    const auto& TexDesc = Attribs.pTexture->GetDesc();
+    CHECK_TILE_MAPPINGS_ATTRIBS((TexDesc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0,
+                                "texture '", TexDesc.Name, "' was not created with MISC_TEXTURE_FLAG_SPARSE flag.");
+
+    const auto& Props = Attribs.pTexture->GetSparseProperties();
+    for (Uint32 i = 0; i < Attribs.NumRanges; ++i)
+    {
+        const auto& Range = Attribs.pRanges[i];
+        CHECK_TILE_MAPPINGS_ATTRIBS(Range.MipLevel < TexDesc.MipLevels, "pRanges[", i, "].MipLevel (", Range.MipLevel,
+                                    ") is out of range [0, ", TexDesc.MipLevels - 1, "].");
+        CHECK_TILE_MAPPINGS_ATTRIBS(Range.ArraySlice < TexDesc.ArraySize, "pRanges[", i, "].ArraySlice (", Range.ArraySlice,
+                                    ") is out of range [0, ", TexDesc.ArraySize - 1, "].");
+        CHECK_TILE_MAPPINGS_ATTRIBS(Range.HeapOffset % Props.TileSizeInBytes == 0, "pRanges[", i, "].HeapOffset (", Range.HeapOffset,
+                                    ") is not a multiple of the tile size (", Props.TileSizeInBytes, ").");
+
+        Uint64 MemorySize = 0;
+        if (Range.MipLevel >= Props.FirstMipInTail)
+        {
+            MemorySize = Props.MipTailSize;
+        }
+        else
+        {
+            const auto MipProps  = GetMipLevelProperties(TexDesc, Range.MipLevel);
+            const auto NumTilesX = (MipProps.LogicalWidth + Props.TileWidth - 1) / Props.TileWidth;
+            const auto NumTilesY = (MipProps.LogicalHeight + Props.TileHeight - 1) / Props.TileHeight;
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.NumTilesX > 0 && Range.NumTilesY > 0, "pRanges[", i, "] is empty.");
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.TileX + Range.NumTilesX <= NumTilesX && Range.TileY + Range.NumTilesY <= NumTilesY,
+                                        "pRanges[", i, "] exceeds the tile grid (", NumTilesX, " x ", NumTilesY, ") of mip level ", Range.MipLevel, ".");
+            MemorySize = Uint64{Range.NumTilesX} * Uint64{Range.NumTilesY} * Props.TileSizeInBytes;
+        }
+
+        if (Range.pHeap != nullptr)
+        {
+            const auto& HeapDesc = Range.pHeap->GetDesc();
+            CHECK_TILE_MAPPINGS_ATTRIBS(Range.HeapOffset + MemorySize <= HeapDesc.Size, "pRanges[", i, "] maps ", MemorySize, " bytes at offset ", Range.HeapOffset,
+                                        ", which exceeds the size (", HeapDesc.Size, ") of heap '", HeapDesc.Name, "'.");
+        }
+    }
+#undef CHECK_TILE_MAPPINGS_ATTRIBS
+
+    return true;
+}
+
 bool VerifyBeginRenderPassAttribs(const BeginRenderPassAttribs& Attribs)
 {
 #define CHECK_BEGIN_RENDER_PASS_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Begin render pass attribs are invalid: ", __VA_ARGS__)
@@ -333,6 +476,13 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
 
     CHECK_STATE_TRANSITION_DESC(Barrier.pResource != nullptr, "pResource must not be null.");
     CHECK_STATE_TRANSITION_DESC(Barrier.NewState != RESOURCE_STATE_UNKNOWN, "NewState state can't be UNKNOWN.");
+    if (Barrier.pResourceBefore != nullptr)
+    {
+        CHECK_STATE_TRANSITION_DESC(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE, "aliasing barriers can't be split.");
+        CHECK_STATE_TRANSITION_DESC(Barrier.pResourceBefore != Barrier.pResource, "pResourceBefore must not be the same as pResource.");
+        CHECK_STATE_TRANSITION_DESC(RefCntAutoPtr<ITexture>(Barrier.pResourceBefore, IID_Texture) || RefCntAutoPtr<IBuffer>(Barrier.pResourceBefore, IID_Buffer),
+                                    "pResourceBefore must be a texture or a buffer.");
+    }
 
     RESOURCE_STATE OldState             = RESOURCE_STATE_UNKNOWN;
     Uint64         ImmediateContextMask = 0;
@@ -344,6 +494,9 @@ bool VerifyStateTransitionDesc(const IRenderDevice*       pDevice,
 
         CHECK_STATE_TRANSITION_DESC(VerifyResourceStates(Barrier.NewState, true), "invalid new state specified for texture '", TexDesc.Name, "'.");
         OldState = Barrier.OldState != RESOURCE_STATE_UNKNOWN ? Barrier.OldState : pTexture->GetState();
+        // The contents of an aliased texture are discarded
+        if (Barrier.pResourceBefore != nullptr)
+            OldState = RESOURCE_STATE_UNDEFINED;
         CHECK_STATE_TRANSITION_DESC(OldState != RESOURCE_STATE_UNKNOWN,
                                     "the state of texture '", TexDesc.Name,
                                     "' is unknown to the engine and is not explicitly specified in the barrier.");
@@ -591,7 +744,16 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs)
 
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pTLAS != nullptr, "pTLAS must not be null.");
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pScratchBuffer != nullptr, "pScratchBuffer must not be null.");
-    CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstances != nullptr, "pInstances must not be null.");
+    if (Attribs.UseGPUInstanceData)
+    {
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstances == nullptr, "pInstances must be null when UseGPUInstanceData is true.");
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED,
+                                 "BindingMode must be HIT_GROUP_BINDING_MODE_USER_DEFINED when UseGPUInstanceData is true.");
+    }
+    else
+    {
+        CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstances != nullptr, "pInstances must not be null.");
+    }
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.pInstanceBuffer != nullptr, "pInstanceBuffer must not be null.");
 
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.BindingMode == HIT_GROUP_BINDING_MODE_USER_DEFINED || Attribs.HitGroupStride != 0,
@@ -617,8 +779,11 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs)
     const auto  InstDataSize      = size_t{Attribs.InstanceCount} * size_t{TLAS_INSTANCE_DATA_SIZE};
     Uint32      AutoOffsetCounter = 0;
 
+    // Instances written by the GPU can not be validated on the CPU
+    const Uint32 NumCPUInstances = Attribs.UseGPUInstanceData ? 0 : Attribs.InstanceCount;
+
     // Calculate instance data size
-    for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
+    for (Uint32 i = 0; i < NumCPUInstances; ++i)
     {
         constexpr Uint32 BitMask = (1u << 24) - 1;
         const auto&      Inst    = Attribs.pInstances[i];
@@ -629,10 +794,10 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs)
                    (Inst.ContributionToHitGroupIndex & ~BitMask) == 0,
                "Only the lower 24 bits are used.");
 
-        CHECK_BUILD_TLAS_ATTRIBS(Inst.InstanceName != nullptr, "pInstances[", i, "].InstanceName must not be null.");
         CHECK_BUILD_TLAS_ATTRIBS(Inst.pBLAS != nullptr, "pInstances[", i, "].pBLAS must not be null.");
 
-        if (Attribs.Update)
+        // Unnamed instances are addressed by index, which is always valid as the instance count is the same
+        if (Attribs.Update && Inst.InstanceName != nullptr)
         {
             const TLASInstanceDesc IDesc = Attribs.pTLAS->GetInstanceDesc(Inst.InstanceName);
             CHECK_BUILD_TLAS_ATTRIBS(IDesc.InstanceIndex != INVALID_INDEX, "Update is true, but pInstances[", i, "].InstanceName does not exists.");
@@ -647,7 +812,7 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs)
                                  "if BindingMode is not HIT_GROUP_BINDING_MODE_USER_DEFINED.");
     }
 
-    CHECK_BUILD_TLAS_ATTRIBS(AutoOffsetCounter == 0 || AutoOffsetCounter == Attribs.InstanceCount,
+    CHECK_BUILD_TLAS_ATTRIBS(AutoOffsetCounter == 0 || AutoOffsetCounter == NumCPUInstances,
                              "all pInstances[i].ContributionToHitGroupIndex must be TLAS_INSTANCE_OFFSET_AUTO, or none of them should.");
 
     CHECK_BUILD_TLAS_ATTRIBS(Attribs.InstanceBufferOffset <= InstDesc.uiSizeInBytes,
@@ -684,6 +849,56 @@ bool VerifyBuildTLASAttribs(const BuildTLASAttribs& Attribs)
 }
 
 
+Uint64 GetBLASBatchScratchRegionSize(const BuildBLASAttribs& Build, Uint32 ScratchBufferAlignment)
+{
+    const auto   ScratchSizes = Build.pBLAS->GetScratchBufferSizes();
+    const Uint64 Size         = Build.Update ? ScratchSizes.Update : ScratchSizes.Build;
+    return AlignUp(Size, Uint64{std::max(ScratchBufferAlignment, 1u)});
+}
+
+bool VerifyBuildBLASBatchAttribs(const IRenderDevice* pDevice, const BuildBLASBatchAttribs& Attribs)
+{
+#define CHECK_BUILD_BLAS_BATCH_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Build BLAS batch attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_BUILD_BLAS_BATCH_ATTRIBS(Attribs.pBuilds != nullptr || Attribs.BuildCount == 0, "BuildCount is ", Attribs.BuildCount, ", but pBuilds is null.");
+    CHECK_BUILD_BLAS_BATCH_ATTRIBS(Attribs.pScratchBuffer != nullptr, "pScratchBuffer must not be null.");
+
+    const Uint32 ScratchAlignment = pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+    CHECK_BUILD_BLAS_BATCH_ATTRIBS(ScratchAlignment == 0 || Attribs.ScratchBufferOffset % ScratchAlignment == 0,
+                                   "ScratchBufferOffset (", Attribs.ScratchBufferOffset, ") must be a multiple of the scratch buffer alignment (", ScratchAlignment, ").");
+
+    std::unordered_set<const IBottomLevelAS*> UniqueBLASes;
+
+    Uint64 ScratchOffset = Attribs.ScratchBufferOffset;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const auto& Build = Attribs.pBuilds[i];
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(Build.pBLAS != nullptr, "pBuilds[", i, "].pBLAS must not be null.");
+        const bool IsUniqueBLAS = UniqueBLASes.insert(Build.pBLAS).second;
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(IsUniqueBLAS, "pBuilds[", i, "].pBLAS is used by more than one build in the batch.");
+        CHECK_BUILD_BLAS_BATCH_ATTRIBS(ScratchOffset <= Attribs.pScratchBuffer->GetDesc().uiSizeInBytes,
+                                       "pScratchBuffer is too small to hold the scratch regions of all builds.");
+
+        // Validate every build as if it used its region of the shared scratch buffer
+        auto RegionBuild                        = Build;
+        RegionBuild.pScratchBuffer              = Attribs.pScratchBuffer;
+        RegionBuild.ScratchBufferOffset         = static_cast<Uint32>(ScratchOffset);
+        RegionBuild.ScratchBufferTransitionMode = Attribs.ScratchBufferTransitionMode;
+        if (!VerifyBuildBLASAttribs(RegionBuild))
+        {
+            LOG_ERROR_MESSAGE("Build BLAS batch attribs are invalid: pBuilds[", i, "] is invalid.");
+            return false;
+        }
+
+        ScratchOffset += GetBLASBatchScratchRegionSize(Build, ScratchAlignment);
+    }
+
+#undef CHECK_BUILD_BLAS_BATCH_ATTRIBS
+
+    return true;
+}
+
+
 bool VerifyCopyBLASAttribs(const IRenderDevice* pDevice, const CopyBLASAttribs& Attribs)
 {
 #define CHECK_COPY_BLAS_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Copy BLAS attribs are invalid: ", __VA_ARGS__)
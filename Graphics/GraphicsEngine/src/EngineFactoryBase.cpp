@@ -84,6 +84,14 @@ void VerifyEngineCreateInfo(const EngineCreateInfo& EngineCI, const GraphicsAdap
             default:
                 LOG_ERROR_AND_THROW("Unknown queue priority");
         }
+
+        VERIFY_EXPR(AdapterInfo.NumNodes > 0 && AdapterInfo.NumNodes <= 32);
+        const Uint32 AllNodesMask = AdapterInfo.NumNodes < 32 ? (1u << AdapterInfo.NumNodes) - 1u : ~0u;
+        if ((ContextInfo.NodeMask & ~AllNodesMask) != 0)
+        {
+            LOG_ERROR_AND_THROW("pContextInfo[", CtxInd, "].NodeMask (", ContextInfo.NodeMask, ") references nodes that are not present in the adapter (",
+                                AdapterInfo.NumNodes, " nodes).");
+        }
     }
 }
 
@@ -0,0 +1,175 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "LiveObjectRegistry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ObjectBase.hpp"
+#include "SRBMemoryAllocator.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+constexpr Uint32 LiveObjectRegistry::InvalidId;
+
+Uint32 LiveObjectRegistry::Register(DEVICE_OBJECT_TYPE Type, const Char* Name)
+{
+    VERIFY_EXPR(Name != nullptr);
+
+    LiveObjectInfo Info;
+    Info.Name          = Name;
+    Info.Type          = Type;
+    Info.CreationFrame = m_FrameNumber.load();
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    Info.SerialNumber = m_NextSerialNumber++;
+
+    Uint32 Id = 0;
+    if (!m_FreeIds.empty())
+    {
+        Id = m_FreeIds.back();
+        m_FreeIds.pop_back();
+        m_Objects[Id] = Info;
+    }
+    else
+    {
+        Id = static_cast<Uint32>(m_Objects.size());
+        m_Objects.push_back(Info);
+    }
+    return Id;
+}
+
+void LiveObjectRegistry::SetSize(Uint32 Id, Uint64 Size)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    VERIFY_EXPR(Id < m_Objects.size() && m_Objects[Id].SerialNumber != 0);
+    m_Objects[Id].Size = Size;
+}
+
+void LiveObjectRegistry::Unregister(Uint32 Id)
+{
+    if (Id == InvalidId)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    VERIFY(Id < m_Objects.size() && m_Objects[Id].SerialNumber != 0, "Object ", Id, " is not registered");
+    m_Objects[Id] = LiveObjectInfo{};
+    m_FreeIds.push_back(Id);
+}
+
+void LiveObjectRegistry::AddSRBAllocator(SRBMemoryAllocator* pAllocator)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    VERIFY_EXPR(std::find(m_SRBAllocators.begin(), m_SRBAllocators.end(), pAllocator) == m_SRBAllocators.end());
+    m_SRBAllocators.push_back(pAllocator);
+}
+
+void LiveObjectRegistry::RemoveSRBAllocator(SRBMemoryAllocator* pAllocator)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = std::find(m_SRBAllocators.begin(), m_SRBAllocators.end(), pAllocator);
+    if (it != m_SRBAllocators.end())
+    {
+        *it = m_SRBAllocators.back();
+        m_SRBAllocators.pop_back();
+    }
+    else
+    {
+        UNEXPECTED("SRB allocator is not registered");
+    }
+}
+
+void LiveObjectRegistry::CaptureSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects)
+{
+    Snapshot.FrameNumber = m_FrameNumber.load();
+
+    std::vector<LiveObjectInfo> Objects;
+    std::vector<Char>           Names;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        for (auto* pAllocator : m_SRBAllocators)
+            pAllocator->GetStatistics(Snapshot.SRBDataPools);
+
+        if (ppObjects != nullptr)
+            Objects.reserve(m_Objects.size() - m_FreeIds.size());
+
+        for (const auto& Info : m_Objects)
+        {
+            if (Info.SerialNumber == 0)
+                continue;
+
+            ++Snapshot.NumObjects[Info.Type];
+            Snapshot.ObjectSizes[Info.Type] += Info.Size;
+
+            if (ppObjects != nullptr)
+            {
+                // Names are interned by the device and are only valid while the object is alive,
+                // so they must be copied before the lock is released. Until the blob is created,
+                // Name holds the offset of the string in the Names array.
+                Objects.push_back(Info);
+                Objects.back().Name = reinterpret_cast<const Char*>(Names.size());
+                Names.insert(Names.end(), Info.Name, Info.Name + strlen(Info.Name) + 1);
+            }
+        }
+    }
+
+    if (ppObjects == nullptr)
+        return;
+
+    DEV_CHECK_ERR(*ppObjects == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+
+    std::sort(Objects.begin(), Objects.end(),
+              [](const LiveObjectInfo& Obj1, const LiveObjectInfo& Obj2) {
+                  return Obj1.SerialNumber < Obj2.SerialNumber;
+              });
+
+    const auto ObjectsSize = Objects.size() * sizeof(LiveObjectInfo);
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>{}(ObjectsSize + Names.size())};
+
+    auto* pDstObjects = reinterpret_cast<LiveObjectInfo*>(pDataBlob->GetDataPtr());
+    auto* pDstNames   = reinterpret_cast<Char*>(pDataBlob->GetDataPtr()) + ObjectsSize;
+    if (!Names.empty())
+        memcpy(pDstNames, Names.data(), Names.size());
+    for (size_t i = 0; i < Objects.size(); ++i)
+    {
+        pDstObjects[i]      = Objects[i];
+        pDstObjects[i].Name = pDstNames + reinterpret_cast<size_t>(Objects[i].Name);
+    }
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppObjects));
+}
+
+} // namespace Diligent
@@ -0,0 +1,997 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PipelineArchive.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ArchiveHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 NumShaders;
+    Uint32 NumSignatures;
+    Uint32 NumPipelines;
+};
+
+// Record offsets and byte code offsets are aligned by this value
+static constexpr size_t ArchiveAlignment = 4;
+
+static_assert(sizeof(ArchiveHeader) % ArchiveAlignment == 0, "Archive header size must be a multiple of the archive alignment");
+
+class ArchiveWriteStream
+{
+public:
+    explicit ArchiveWriteStream(std::vector<Uint8>& Data) :
+        m_Data{Data}
+    {}
+
+    template <typename T>
+    void Write(const T& Val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written to the archive");
+        WriteBytes(&Val, sizeof(Val));
+    }
+
+    void WriteBytes(const void* pData, size_t Size)
+    {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+    }
+
+    void WriteString(const char* Str)
+    {
+        if (Str == nullptr)
+            Str = "";
+        const auto Len = strlen(Str);
+        Write(static_cast<Uint32>(Len));
+        WriteBytes(Str, Len + 1);
+    }
+
+    void Align()
+    {
+        m_Data.resize(AlignUp(m_Data.size(), ArchiveAlignment), 0);
+    }
+
+    // Reserves space for the record size and returns the record offset
+    size_t BeginRecord()
+    {
+        VERIFY_EXPR(m_Data.size() % ArchiveAlignment == 0);
+        const auto Offset = m_Data.size();
+        Write(Uint32{0});
+        return Offset;
+    }
+
+    void EndRecord(size_t Offset)
+    {
+        Align();
+        const auto Size = static_cast<Uint32>(m_Data.size() - Offset - sizeof(Uint32));
+        memcpy(&m_Data[Offset], &Size, sizeof(Size));
+    }
+
+private:
+    std::vector<Uint8>& m_Data;
+};
+
+class ArchiveReadStream
+{
+public:
+    ArchiveReadStream(const Uint8* pBase, const Uint8* pCurr, const Uint8* pEnd) :
+        m_pBase{pBase},
+        m_pCurr{pCurr},
+        m_pEnd{pEnd}
+    {}
+
+    template <typename T>
+    T Read() noexcept(false)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read from the archive");
+        T Val;
+        memcpy(&Val, ReadBytes(sizeof(T)), sizeof(T));
+        return Val;
+    }
+
+    const Uint8* ReadBytes(size_t Size) noexcept(false)
+    {
+        if (Size > static_cast<size_t>(m_pEnd - m_pCurr))
+            LOG_ERROR_AND_THROW("Unexpected end of the pipeline archive data");
+        const auto* pBytes = m_pCurr;
+        m_pCurr += Size;
+        return pBytes;
+    }
+
+    const char* ReadString() noexcept(false)
+    {
+        const auto  Len = Read<Uint32>();
+        const auto* Str = reinterpret_cast<const char*>(ReadBytes(size_t{Len} + 1));
+        if (Str[Len] != '\0')
+            LOG_ERROR_AND_THROW("Pipeline archive string is not null-terminated");
+        return Str;
+    }
+
+    // Reads an element count and verifies that the remaining record data can hold
+    // that many elements of at least MinElementSize bytes each, so that corrupted
+    // counts do not result in huge allocations.
+    Uint32 ReadCount(size_t MinElementSize) noexcept(false)
+    {
+        VERIFY_EXPR(MinElementSize > 0);
+        const auto Count = Read<Uint32>();
+        if (Count > static_cast<size_t>(m_pEnd - m_pCurr) / MinElementSize)
+            LOG_ERROR_AND_THROW("Pipeline archive element count (", Count, ") exceeds the remaining record size");
+        return Count;
+    }
+
+    void Align() noexcept(false)
+    {
+        const auto Offset = static_cast<size_t>(m_pCurr - m_pBase);
+        ReadBytes(AlignUp(Offset, ArchiveAlignment) - Offset);
+    }
+
+    const Uint8* GetCurrent() const { return m_pCurr; }
+
+private:
+    const Uint8* const m_pBase;
+    const Uint8*       m_pCurr;
+    const Uint8* const m_pEnd;
+};
+
+// The smallest serialized string: the length and the null terminator
+static constexpr size_t MinArchiveStringSize = sizeof(Uint32) + 1;
+
+template <typename EnumType>
+void WriteEnum(ArchiveWriteStream& Stream, EnumType Val)
+{
+    Stream.Write(static_cast<Uint32>(Val));
+}
+
+template <typename EnumType>
+EnumType ReadEnum(ArchiveReadStream& Stream) noexcept(false)
+{
+    return static_cast<EnumType>(Stream.Read<Uint32>());
+}
+
+void WriteSamplerDesc(ArchiveWriteStream& Stream, const SamplerDesc& Desc)
+{
+    WriteEnum(Stream, Desc.MinFilter);
+    WriteEnum(Stream, Desc.MagFilter);
+    WriteEnum(Stream, Desc.MipFilter);
+    WriteEnum(Stream, Desc.AddressU);
+    WriteEnum(Stream, Desc.AddressV);
+    WriteEnum(Stream, Desc.AddressW);
+    Stream.Write(Desc.MipLODBias);
+    Stream.Write(Desc.MaxAnisotropy);
+    WriteEnum(Stream, Desc.ComparisonFunc);
+    for (auto Color : Desc.BorderColor)
+        Stream.Write(Color);
+    Stream.Write(Desc.MinLOD);
+    Stream.Write(Desc.MaxLOD);
+}
+
+void ReadSamplerDesc(ArchiveReadStream& Stream, SamplerDesc& Desc) noexcept(false)
+{
+    Desc.MinFilter      = ReadEnum<FILTER_TYPE>(Stream);
+    Desc.MagFilter      = ReadEnum<FILTER_TYPE>(Stream);
+    Desc.MipFilter      = ReadEnum<FILTER_TYPE>(Stream);
+    Desc.AddressU       = ReadEnum<TEXTURE_ADDRESS_MODE>(Stream);
+    Desc.AddressV       = ReadEnum<TEXTURE_ADDRESS_MODE>(Stream);
+    Desc.AddressW       = ReadEnum<TEXTURE_ADDRESS_MODE>(Stream);
+    Desc.MipLODBias     = Stream.Read<Float32>();
+    Desc.MaxAnisotropy  = Stream.Read<Uint32>();
+    Desc.ComparisonFunc = ReadEnum<COMPARISON_FUNCTION>(Stream);
+    for (auto& Color : Desc.BorderColor)
+        Color = Stream.Read<Float32>();
+    Desc.MinLOD = Stream.Read<Float32>();
+    Desc.MaxLOD = Stream.Read<Float32>();
+}
+
+std::string GetShaderKey(const char* Name, RENDER_DEVICE_TYPE DeviceType)
+{
+    std::string Key{Name};
+    Key += '\0';
+    Key += static_cast<char>(DeviceType);
+    return Key;
+}
+
+bool IsGraphicsPipeline(PIPELINE_TYPE PipelineType)
+{
+    return PipelineType == PIPELINE_TYPE_GRAPHICS || PipelineType == PIPELINE_TYPE_MESH;
+}
+
+} // namespace
+
+
+bool PipelineArchiveWriter::AddShader(const PipelineArchiveShaderDesc& ShaderDesc)
+{
+    DEV_CHECK_ERR(ShaderDesc.Name != nullptr, "Shader name must not be null");
+    DEV_CHECK_ERR(ShaderDesc.ByteCode != nullptr && ShaderDesc.ByteCodeSize != 0, "Shader byte code must not be empty");
+
+    if (!m_Shaders.Keys.emplace(GetShaderKey(ShaderDesc.Name, ShaderDesc.DeviceType)).second)
+    {
+        LOG_ERROR_MESSAGE("Shader '", ShaderDesc.Name, "' for this device type has already been added to the archive");
+        return false;
+    }
+
+    ArchiveWriteStream Stream{m_Shaders.Data};
+
+    const auto RecordOffset = Stream.BeginRecord();
+    Stream.WriteString(ShaderDesc.Name);
+    Stream.Write(static_cast<Uint8>(ShaderDesc.DeviceType));
+    WriteEnum(Stream, ShaderDesc.ShaderType);
+    Stream.WriteString(ShaderDesc.EntryPoint);
+    Stream.Write(static_cast<Uint8>(ShaderDesc.UseCombinedTextureSamplers ? 1 : 0));
+    Stream.WriteString(ShaderDesc.CombinedSamplerSuffix);
+
+    Stream.Write(ShaderDesc.NumResources);
+    for (Uint32 i = 0; i < ShaderDesc.NumResources; ++i)
+    {
+        const auto& Res = ShaderDesc.Resources[i];
+        Stream.WriteString(Res.Name);
+        WriteEnum(Stream, Res.Type);
+        Stream.Write(Res.ArraySize);
+        WriteEnum(Stream, Res.Flags);
+    }
+
+    Stream.Write(static_cast<Uint32>(ShaderDesc.ByteCodeSize));
+    Stream.Align();
+    Stream.WriteBytes(ShaderDesc.ByteCode, ShaderDesc.ByteCodeSize);
+    Stream.EndRecord(RecordOffset);
+
+    ++m_Shaders.Count;
+    return true;
+}
+
+bool PipelineArchiveWriter::AddResourceSignature(const PipelineResourceSignatureDesc& SignDesc)
+{
+    DEV_CHECK_ERR(SignDesc.Name != nullptr, "Resource signature name must not be null");
+
+    if (!m_Signatures.Keys.emplace(SignDesc.Name).second)
+    {
+        LOG_ERROR_MESSAGE("Resource signature '", SignDesc.Name, "' has already been added to the archive");
+        return false;
+    }
+
+    ArchiveWriteStream Stream{m_Signatures.Data};
+
+    const auto RecordOffset = Stream.BeginRecord();
+    Stream.WriteString(SignDesc.Name);
+    Stream.Write(SignDesc.BindingIndex);
+    Stream.Write(static_cast<Uint8>(SignDesc.UseCombinedTextureSamplers ? 1 : 0));
+    Stream.WriteString(SignDesc.CombinedSamplerSuffix);
+    Stream.Write(SignDesc.SRBAllocationGranularity);
+
+    Stream.Write(SignDesc.NumResources);
+    for (Uint32 i = 0; i < SignDesc.NumResources; ++i)
+    {
+        const auto& Res = SignDesc.Resources[i];
+        Stream.WriteString(Res.Name);
+        WriteEnum(Stream, Res.ShaderStages);
+        Stream.Write(Res.ArraySize);
+        WriteEnum(Stream, Res.ResourceType);
+        WriteEnum(Stream, Res.VarType);
+        WriteEnum(Stream, Res.Flags);
+    }
+
+    Stream.Write(SignDesc.NumImmutableSamplers);
+    for (Uint32 i = 0; i < SignDesc.NumImmutableSamplers; ++i)
+    {
+        const auto& Sam = SignDesc.ImmutableSamplers[i];
+        WriteEnum(Stream, Sam.ShaderStages);
+        Stream.WriteString(Sam.SamplerOrTextureName);
+        WriteSamplerDesc(Stream, Sam.Desc);
+    }
+    Stream.EndRecord(RecordOffset);
+
+    ++m_Signatures.Count;
+    return true;
+}
+
+bool PipelineArchiveWriter::AddPipeline(const PipelineArchivePipelineDesc& PipelineDesc)
+{
+    DEV_CHECK_ERR(PipelineDesc.Name != nullptr, "Pipeline name must not be null");
+
+    if (PipelineDesc.PipelineType != PIPELINE_TYPE_COMPUTE && !IsGraphicsPipeline(PipelineDesc.PipelineType))
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", PipelineDesc.Name, "': only graphics, mesh and compute pipelines can be stored in the archive");
+        return false;
+    }
+
+    const auto& GraphicsPipeline = PipelineDesc.GraphicsPipeline;
+    if (IsGraphicsPipeline(PipelineDesc.PipelineType) && GraphicsPipeline.pRenderPass != nullptr)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", PipelineDesc.Name, "': render passes are not supported by the pipeline archive");
+        return false;
+    }
+
+    if (!m_Pipelines.Keys.emplace(PipelineDesc.Name).second)
+    {
+        LOG_ERROR_MESSAGE("Pipeline '", PipelineDesc.Name, "' has already been added to the archive");
+        return false;
+    }
+
+    ArchiveWriteStream Stream{m_Pipelines.Data};
+
+    const auto RecordOffset = Stream.BeginRecord();
+    Stream.WriteString(PipelineDesc.Name);
+    WriteEnum(Stream, PipelineDesc.PipelineType);
+    Stream.Write(PipelineDesc.SRBAllocationGranularity);
+
+    Stream.Write(PipelineDesc.NumShaders);
+    for (Uint32 i = 0; i < PipelineDesc.NumShaders; ++i)
+        Stream.WriteString(PipelineDesc.ShaderNames[i]);
+
+    Stream.Write(PipelineDesc.NumSignatures);
+    for (Uint32 i = 0; i < PipelineDesc.NumSignatures; ++i)
+        Stream.WriteString(PipelineDesc.SignatureNames[i]);
+
+    if (IsGraphicsPipeline(PipelineDesc.PipelineType))
+    {
+        Stream.Write(GraphicsPipeline.BlendDesc);
+        Stream.Write(GraphicsPipeline.SampleMask);
+        Stream.Write(GraphicsPipeline.RasterizerDesc);
+        Stream.Write(GraphicsPipeline.DepthStencilDesc);
+
+        const auto& InputLayout = GraphicsPipeline.InputLayout;
+        Stream.Write(InputLayout.NumElements);
+        for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+        {
+            const auto& Elem = InputLayout.LayoutElements[i];
+            Stream.WriteString(Elem.HLSLSemantic);
+            Stream.Write(Elem.InputIndex);
+            Stream.Write(Elem.BufferSlot);
+            Stream.Write(Elem.NumComponents);
+            WriteEnum(Stream, Elem.ValueType);
+            Stream.Write(static_cast<Uint8>(Elem.IsNormalized ? 1 : 0));
+            Stream.Write(Elem.RelativeOffset);
+            Stream.Write(Elem.Stride);
+            WriteEnum(Stream, Elem.Frequency);
+            Stream.Write(Elem.InstanceDataStepRate);
+        }
+
+        WriteEnum(Stream, GraphicsPipeline.PrimitiveTopology);
+        Stream.Write(GraphicsPipeline.NumViewports);
+        Stream.Write(GraphicsPipeline.NumRenderTargets);
+        for (auto Fmt : GraphicsPipeline.RTVFormats)
+            WriteEnum(Stream, Fmt);
+        WriteEnum(Stream, GraphicsPipeline.DSVFormat);
+        Stream.Write(GraphicsPipeline.SmplDesc);
+        Stream.Write(GraphicsPipeline.NodeMask);
+        WriteEnum(Stream, GraphicsPipeline.DynamicStates);
+    }
+    Stream.EndRecord(RecordOffset);
+
+    ++m_Pipelines.Count;
+    return true;
+}
+
+void PipelineArchiveWriter::Serialize(std::vector<Uint8>& Data) const
+{
+    ArchiveHeader Header{};
+    Header.Magic         = PipelineArchiveMagic;
+    Header.Version       = PipelineArchiveVersion;
+    Header.NumShaders    = m_Shaders.Count;
+    Header.NumSignatures = m_Signatures.Count;
+    Header.NumPipelines  = m_Pipelines.Count;
+
+    Data.clear();
+    Data.reserve(sizeof(Header) + m_Shaders.Data.size() + m_Signatures.Data.size() + m_Pipelines.Data.size());
+
+    ArchiveWriteStream Stream{Data};
+    Stream.Write(Header);
+    Stream.WriteBytes(m_Shaders.Data.data(), m_Shaders.Data.size());
+    Stream.WriteBytes(m_Signatures.Data.data(), m_Signatures.Data.size());
+    Stream.WriteBytes(m_Pipelines.Data.data(), m_Pipelines.Data.size());
+}
+
+
+PipelineArchiveReader::PipelineArchiveReader(IDataBlob* pArchive) noexcept(false) :
+    m_pArchive{pArchive}
+{
+    if (m_pArchive == nullptr)
+        LOG_ERROR_AND_THROW("Pipeline archive data must not be null");
+
+    m_pData = static_cast<const Uint8*>(m_pArchive->GetConstDataPtr());
+    m_pEnd  = m_pData + m_pArchive->GetSize();
+
+    ArchiveReadStream Stream{m_pData, m_pData, m_pEnd};
+
+    const auto Header = Stream.Read<ArchiveHeader>();
+    if (Header.Magic != PipelineArchiveMagic)
+        LOG_ERROR_AND_THROW("The data is not a pipeline archive");
+    if (Header.Version != PipelineArchiveVersion)
+        LOG_ERROR_AND_THROW("Pipeline archive version (", Header.Version, ") does not match the expected version (", PipelineArchiveVersion, "). The archive must be rebuilt.");
+
+    m_NumShaders    = Header.NumShaders;
+    m_NumSignatures = Header.NumSignatures;
+    m_NumPipelines  = Header.NumPipelines;
+
+    m_pShaders    = Stream.GetCurrent();
+    m_pSignatures = SkipSection(m_pShaders, m_NumShaders);
+    m_pPipelines  = SkipSection(m_pSignatures, m_NumSignatures);
+    SkipSection(m_pPipelines, m_NumPipelines);
+}
+
+const Uint8* PipelineArchiveReader::SkipSection(const Uint8* pSection, Uint32 NumRecords) const noexcept(false)
+{
+    ArchiveReadStream Stream{m_pData, pSection, m_pEnd};
+    for (Uint32 i = 0; i < NumRecords; ++i)
+    {
+        const auto RecordSize = Stream.Read<Uint32>();
+        Stream.ReadBytes(RecordSize);
+    }
+    return Stream.GetCurrent();
+}
+
+const Uint8* PipelineArchiveReader::FindRecord(const Uint8*       pSection,
+                                               Uint32             NumRecords,
+                                               const char*        Name,
+                                               const Uint8**      ppRecordEnd,
+                                               RENDER_DEVICE_TYPE DeviceType) const noexcept(false)
+{
+    VERIFY_EXPR(Name != nullptr && ppRecordEnd != nullptr);
+
+    const auto* pRecord = pSection;
+    for (Uint32 i = 0; i < NumRecords; ++i)
+    {
+        ArchiveReadStream Stream{m_pData, pRecord, m_pEnd};
+
+        const auto  RecordSize  = Stream.Read<Uint32>();
+        const auto* pRecordData = Stream.GetCurrent();
+        const auto* pRecordEnd  = Stream.ReadBytes(RecordSize) + RecordSize;
+
+        ArchiveReadStream RecordStream{m_pData, pRecordData, pRecordEnd};
+
+        const auto* RecordName = RecordStream.ReadString();
+        if (strcmp(RecordName, Name) == 0 &&
+            (DeviceType == RENDER_DEVICE_TYPE_UNDEFINED || RecordStream.Read<Uint8>() == static_cast<Uint8>(DeviceType)))
+        {
+            *ppRecordEnd = pRecordEnd;
+            return pRecordData;
+        }
+
+        pRecord = pRecordEnd;
+    }
+
+    return nullptr;
+}
+
+std::vector<const char*> PipelineArchiveReader::GetRecordNames(const Uint8*       pSection,
+                                                               Uint32             NumRecords,
+                                                               RENDER_DEVICE_TYPE DeviceType) const noexcept(false)
+{
+    std::vector<const char*> Names;
+    Names.reserve(NumRecords);
+
+    const auto* pRecord = pSection;
+    for (Uint32 i = 0; i < NumRecords; ++i)
+    {
+        ArchiveReadStream Stream{m_pData, pRecord, m_pEnd};
+
+        const auto  RecordSize  = Stream.Read<Uint32>();
+        const auto* pRecordData = Stream.GetCurrent();
+        const auto* pRecordEnd  = Stream.ReadBytes(RecordSize) + RecordSize;
+
+        ArchiveReadStream RecordStream{m_pData, pRecordData, pRecordEnd};
+
+        const auto* RecordName = RecordStream.ReadString();
+        if (DeviceType == RENDER_DEVICE_TYPE_UNDEFINED || RecordStream.Read<Uint8>() == static_cast<Uint8>(DeviceType))
+            Names.push_back(RecordName);
+
+        pRecord = pRecordEnd;
+    }
+
+    return Names;
+}
+
+std::vector<const char*> PipelineArchiveReader::GetShaderNames(RENDER_DEVICE_TYPE DeviceType) const noexcept(false)
+{
+    DEV_CHECK_ERR(DeviceType != RENDER_DEVICE_TYPE_UNDEFINED, "Device type must not be undefined");
+    return GetRecordNames(m_pShaders, m_NumShaders, DeviceType);
+}
+
+std::vector<const char*> PipelineArchiveReader::GetResourceSignatureNames() const noexcept(false)
+{
+    return GetRecordNames(m_pSignatures, m_NumSignatures);
+}
+
+std::vector<const char*> PipelineArchiveReader::GetPipelineNames() const noexcept(false)
+{
+    return GetRecordNames(m_pPipelines, m_NumPipelines);
+}
+
+bool PipelineArchiveReader::GetShader(const char*                                 Name,
+                                      RENDER_DEVICE_TYPE                          DeviceType,
+                                      ShaderCreateInfo&                           ShaderCI,
+                                      std::vector<PipelineArchiveShaderResource>* pResources) const noexcept(false)
+{
+    DEV_CHECK_ERR(DeviceType != RENDER_DEVICE_TYPE_UNDEFINED, "Device type must not be undefined");
+
+    const Uint8* pRecordEnd  = nullptr;
+    const auto*  pRecordData = FindRecord(m_pShaders, m_NumShaders, Name, &pRecordEnd, DeviceType);
+    if (pRecordData == nullptr)
+        return false;
+
+    ArchiveReadStream Stream{m_pData, pRecordData, pRecordEnd};
+
+    ShaderCI.Desc.Name = Stream.ReadString();
+    Stream.Read<Uint8>(); // Device type
+    ShaderCI.Desc.ShaderType            = ReadEnum<SHADER_TYPE>(Stream);
+    ShaderCI.EntryPoint                 = Stream.ReadString();
+    ShaderCI.UseCombinedTextureSamplers = Stream.Read<Uint8>() != 0;
+    ShaderCI.CombinedSamplerSuffix      = Stream.ReadString();
+
+    // Name, type, array size, flags
+    const auto NumResources = Stream.ReadCount(MinArchiveStringSize + 3 * sizeof(Uint32));
+    if (pResources != nullptr)
+    {
+        pResources->clear();
+        pResources->reserve(NumResources);
+    }
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        PipelineArchiveShaderResource Res;
+        Res.Name      = Stream.ReadString();
+        Res.Type      = ReadEnum<SHADER_RESOURCE_TYPE>(Stream);
+        Res.ArraySize = Stream.Read<Uint32>();
+        Res.Flags     = ReadEnum<PIPELINE_RESOURCE_FLAGS>(Stream);
+        if (pResources != nullptr)
+            pResources->push_back(Res);
+    }
+
+    const auto ByteCodeSize = Stream.Read<Uint32>();
+    Stream.Align();
+    ShaderCI.ByteCode     = Stream.ReadBytes(ByteCodeSize);
+    ShaderCI.ByteCodeSize = ByteCodeSize;
+
+    return true;
+}
+
+bool PipelineArchiveReader::GetResourceSignature(const char*                        Name,
+                                                 PipelineResourceSignatureDesc&     Desc,
+                                                 std::vector<PipelineResourceDesc>& Resources,
+                                                 std::vector<ImmutableSamplerDesc>& ImmutableSamplers) const noexcept(false)
+{
+    const Uint8* pRecordEnd  = nullptr;
+    const auto*  pRecordData = FindRecord(m_pSignatures, m_NumSignatures, Name, &pRecordEnd);
+    if (pRecordData == nullptr)
+        return false;
+
+    ArchiveReadStream Stream{m_pData, pRecordData, pRecordEnd};
+
+    Desc.Name                       = Stream.ReadString();
+    Desc.BindingIndex               = Stream.Read<Uint8>();
+    Desc.UseCombinedTextureSamplers = Stream.Read<Uint8>() != 0;
+    Desc.CombinedSamplerSuffix      = Stream.ReadString();
+    Desc.SRBAllocationGranularity   = Stream.Read<Uint32>();
+
+    // Name, shader stages, array size, resource type, variable type, flags
+    Resources.resize(Stream.ReadCount(MinArchiveStringSize + 5 * sizeof(Uint32)));
+    for (auto& Res : Resources)
+    {
+        Res.Name         = Stream.ReadString();
+        Res.ShaderStages = ReadEnum<SHADER_TYPE>(Stream);
+        Res.ArraySize    = Stream.Read<Uint32>();
+        Res.ResourceType = ReadEnum<SHADER_RESOURCE_TYPE>(Stream);
+        Res.VarType      = ReadEnum<SHADER_RESOURCE_VARIABLE_TYPE>(Stream);
+        Res.Flags        = ReadEnum<PIPELINE_RESOURCE_FLAGS>(Stream);
+    }
+
+    // Shader stages, name (the sampler desc only makes the element larger)
+    ImmutableSamplers.resize(Stream.ReadCount(sizeof(Uint32) + MinArchiveStringSize));
+    for (auto& Sam : ImmutableSamplers)
+    {
+        Sam.ShaderStages         = ReadEnum<SHADER_TYPE>(Stream);
+        Sam.SamplerOrTextureName = Stream.ReadString();
+        ReadSamplerDesc(Stream, Sam.Desc);
+    }
+
+    Desc.Resources            = Resources.data();
+    Desc.NumResources         = static_cast<Uint32>(Resources.size());
+    Desc.ImmutableSamplers    = ImmutableSamplers.data();
+    Desc.NumImmutableSamplers = static_cast<Uint32>(ImmutableSamplers.size());
+
+    return true;
+}
+
+bool PipelineArchiveReader::GetPipeline(const char* Name, PipelineInfo& Info) const noexcept(false)
+{
+    const Uint8* pRecordEnd  = nullptr;
+    const auto*  pRecordData = FindRecord(m_pPipelines, m_NumPipelines, Name, &pRecordEnd);
+    if (pRecordData == nullptr)
+        return false;
+
+    ArchiveReadStream Stream{m_pData, pRecordData, pRecordEnd};
+
+    Info.Name                     = Stream.ReadString();
+    Info.PipelineType             = ReadEnum<PIPELINE_TYPE>(Stream);
+    Info.SRBAllocationGranularity = Stream.Read<Uint32>();
+
+    Info.ShaderNames.resize(Stream.ReadCount(MinArchiveStringSize));
+    for (auto& ShaderName : Info.ShaderNames)
+        ShaderName = Stream.ReadString();
+
+    Info.SignatureNames.resize(Stream.ReadCount(MinArchiveStringSize));
+    for (auto& SignName : Info.SignatureNames)
+        SignName = Stream.ReadString();
+
+    Info.GraphicsPipeline = GraphicsPipelineDesc{};
+    Info.LayoutElements.clear();
+    if (IsGraphicsPipeline(Info.PipelineType))
+    {
+        auto& GraphicsPipeline = Info.GraphicsPipeline;
+
+        GraphicsPipeline.BlendDesc        = Stream.Read<BlendStateDesc>();
+        GraphicsPipeline.SampleMask       = Stream.Read<Uint32>();
+        GraphicsPipeline.RasterizerDesc   = Stream.Read<RasterizerStateDesc>();
+        GraphicsPipeline.DepthStencilDesc = Stream.Read<DepthStencilStateDesc>();
+
+        // Semantic, eight 32-bit fields, normalized flag
+        Info.LayoutElements.resize(Stream.ReadCount(MinArchiveStringSize + 8 * sizeof(Uint32) + 1));
+        for (auto& Elem : Info.LayoutElements)
+        {
+            Elem.HLSLSemantic         = Stream.ReadString();
+            Elem.InputIndex           = Stream.Read<Uint32>();
+            Elem.BufferSlot           = Stream.Read<Uint32>();
+            Elem.NumComponents        = Stream.Read<Uint32>();
+            Elem.ValueType            = ReadEnum<VALUE_TYPE>(Stream);
+            Elem.IsNormalized         = Stream.Read<Uint8>() != 0;
+            Elem.RelativeOffset       = Stream.Read<Uint32>();
+            Elem.Stride               = Stream.Read<Uint32>();
+            Elem.Frequency            = ReadEnum<INPUT_ELEMENT_FREQUENCY>(Stream);
+            Elem.InstanceDataStepRate = Stream.Read<Uint32>();
+        }
+        GraphicsPipeline.InputLayout.LayoutElements = Info.LayoutElements.data();
+        GraphicsPipeline.InputLayout.NumElements    = static_cast<Uint32>(Info.LayoutElements.size());
+
+        GraphicsPipeline.PrimitiveTopology = ReadEnum<PRIMITIVE_TOPOLOGY>(Stream);
+        GraphicsPipeline.NumViewports      = Stream.Read<Uint8>();
+        GraphicsPipeline.NumRenderTargets  = Stream.Read<Uint8>();
+        for (auto& Fmt : GraphicsPipeline.RTVFormats)
+            Fmt = ReadEnum<TEXTURE_FORMAT>(Stream);
+        GraphicsPipeline.DSVFormat = ReadEnum<TEXTURE_FORMAT>(Stream);
+        GraphicsPipeline.SmplDesc  = Stream.Read<SampleDesc>();
+        GraphicsPipeline.NodeMask  = Stream.Read<Uint32>();
+
+        GraphicsPipeline.DynamicStates = ReadEnum<DYNAMIC_STATE_FLAGS>(Stream);
+    }
+
+    return true;
+}
+
+
+namespace
+{
+
+// Creates the pipeline from the archived description. ppShaders and ppSignatures contain the objects
+// for every name in Pipeline.ShaderNames and Pipeline.SignatureNames respectively.
+void CreateArchivedPipeline(IRenderDevice*                             pDevice,
+                            const PipelineArchiveReader::PipelineInfo& Pipeline,
+                            IShader* const*                            ppShaders,
+                            IPipelineResourceSignature**               ppSignatures,
+                            const SpecializationConstant*              pSpecializationConstants,
+                            Uint32                                     NumSpecializationConstants,
+                            IPipelineStateCache*                       pPSOCache,
+                            IPipelineState**                           ppPipelineState) noexcept(false)
+{
+    GraphicsPipelineStateCreateInfo GraphicsPSOCreateInfo;
+    ComputePipelineStateCreateInfo  ComputePSOCreateInfo;
+    PipelineStateCreateInfo&        PSOCreateInfo = Pipeline.PipelineType == PIPELINE_TYPE_COMPUTE ?
+        static_cast<PipelineStateCreateInfo&>(ComputePSOCreateInfo) :
+        static_cast<PipelineStateCreateInfo&>(GraphicsPSOCreateInfo);
+
+    for (size_t i = 0; i < Pipeline.ShaderNames.size(); ++i)
+    {
+        auto* const pShader = ppShaders[i];
+        // clang-format off
+        switch (pShader->GetDesc().ShaderType)
+        {
+            case SHADER_TYPE_VERTEX:        GraphicsPSOCreateInfo.pVS = pShader; break;
+            case SHADER_TYPE_PIXEL:         GraphicsPSOCreateInfo.pPS = pShader; break;
+            case SHADER_TYPE_GEOMETRY:      GraphicsPSOCreateInfo.pGS = pShader; break;
+            case SHADER_TYPE_HULL:          GraphicsPSOCreateInfo.pHS = pShader; break;
+            case SHADER_TYPE_DOMAIN:        GraphicsPSOCreateInfo.pDS = pShader; break;
+            case SHADER_TYPE_AMPLIFICATION: GraphicsPSOCreateInfo.pAS = pShader; break;
+            case SHADER_TYPE_MESH:          GraphicsPSOCreateInfo.pMS = pShader; break;
+            case SHADER_TYPE_COMPUTE:       ComputePSOCreateInfo.pCS  = pShader; break;
+            default:
+                LOG_ERROR_AND_THROW("Shader '", Pipeline.ShaderNames[i], "' has unexpected type");
+        }
+        // clang-format on
+    }
+
+    PSOCreateInfo.PSODesc.Name                     = Pipeline.Name;
+    PSOCreateInfo.PSODesc.PipelineType             = Pipeline.PipelineType;
+    PSOCreateInfo.PSODesc.SRBAllocationGranularity = Pipeline.SRBAllocationGranularity;
+    PSOCreateInfo.ppResourceSignatures             = ppSignatures;
+    PSOCreateInfo.ResourceSignaturesCount          = static_cast<Uint32>(Pipeline.SignatureNames.size());
+    PSOCreateInfo.NumSpecializationConstants       = NumSpecializationConstants;
+    PSOCreateInfo.pSpecializationConstants         = pSpecializationConstants;
+    PSOCreateInfo.pPSOCache                        = pPSOCache;
+
+    if (Pipeline.PipelineType == PIPELINE_TYPE_COMPUTE)
+    {
+        pDevice->CreateComputePipelineState(ComputePSOCreateInfo, ppPipelineState);
+    }
+    else
+    {
+        GraphicsPSOCreateInfo.GraphicsPipeline = Pipeline.GraphicsPipeline;
+        pDevice->CreateGraphicsPipelineState(GraphicsPSOCreateInfo, ppPipelineState);
+    }
+}
+
+} // namespace
+
+void CreatePipelineStateFromArchive(IRenderDevice*                        pDevice,
+                                    const PipelineStateArchiveCreateInfo& CreateInfo,
+                                    IPipelineState**                      ppPipelineState)
+{
+    DEV_CHECK_ERR(ppPipelineState != nullptr, "Null pointer provided");
+    if (ppPipelineState == nullptr)
+        return;
+
+    DEV_CHECK_ERR(*ppPipelineState == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    *ppPipelineState = nullptr;
+
+    if (CreateInfo.pArchive == nullptr || CreateInfo.PipelineName == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Pipeline archive and pipeline name must not be null");
+        return;
+    }
+
+    try
+    {
+        PipelineArchiveReader Archive{CreateInfo.pArchive};
+
+        PipelineArchiveReader::PipelineInfo Pipeline;
+        if (!Archive.GetPipeline(CreateInfo.PipelineName, Pipeline))
+            LOG_ERROR_AND_THROW("Pipeline is not found in the archive");
+
+        std::vector<RefCntAutoPtr<IPipelineResourceSignature>> Signatures;
+        std::vector<IPipelineResourceSignature*>               ppSignatures;
+        Signatures.reserve(Pipeline.SignatureNames.size());
+        ppSignatures.reserve(Pipeline.SignatureNames.size());
+        for (const auto* SignName : Pipeline.SignatureNames)
+        {
+            RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+            for (Uint32 i = 0; i < CreateInfo.ResourceSignaturesCount && !pSignature; ++i)
+            {
+                auto* pSign = CreateInfo.ppResourceSignatures[i];
+                if (pSign != nullptr && pSign->GetDesc().Name != nullptr && strcmp(pSign->GetDesc().Name, SignName) == 0)
+                    pSignature = pSign;
+            }
+
+            if (!pSignature)
+            {
+                PipelineResourceSignatureDesc     SignDesc;
+                std::vector<PipelineResourceDesc> Resources;
+                std::vector<ImmutableSamplerDesc> ImmutableSamplers;
+                if (!Archive.GetResourceSignature(SignName, SignDesc, Resources, ImmutableSamplers))
+                    LOG_ERROR_AND_THROW("Resource signature '", SignName, "' is not found in the archive");
+
+                pDevice->CreatePipelineResourceSignature(SignDesc, &pSignature);
+                if (!pSignature)
+                    LOG_ERROR_AND_THROW("Failed to create resource signature '", SignName, "'");
+            }
+
+            ppSignatures.push_back(pSignature);
+            Signatures.emplace_back(std::move(pSignature));
+        }
+
+        const auto DeviceType = pDevice->GetDeviceInfo().Type;
+
+        std::vector<RefCntAutoPtr<IShader>> Shaders;
+        std::vector<IShader*>               ppShaders;
+        Shaders.reserve(Pipeline.ShaderNames.size());
+        ppShaders.reserve(Pipeline.ShaderNames.size());
+        for (const auto* ShaderName : Pipeline.ShaderNames)
+        {
+            ShaderCreateInfo ShaderCI;
+            if (!Archive.GetShader(ShaderName, DeviceType, ShaderCI))
+                LOG_ERROR_AND_THROW("Shader '", ShaderName, "' is not found in the archive or the archive does not contain byte code for this device type");
+
+            RefCntAutoPtr<IShader> pShader;
+            pDevice->CreateShader(ShaderCI, &pShader);
+            if (!pShader)
+                LOG_ERROR_AND_THROW("Failed to create shader '", ShaderName, "'");
+
+            ppShaders.push_back(pShader);
+            Shaders.emplace_back(std::move(pShader));
+        }
+
+        CreateArchivedPipeline(pDevice, Pipeline, ppShaders.data(), ppSignatures.data(),
+                               CreateInfo.pSpecializationConstants, CreateInfo.NumSpecializationConstants,
+                               CreateInfo.pPSOCache, ppPipelineState);
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to create pipeline state '", CreateInfo.PipelineName, "' from the archive");
+    }
+}
+
+Uint32 ReplayPipelineArchive(IRenderDevice*                 pDevice,
+                             IThreadPool&                   TaskPool,
+                             const PipelineStateReplayInfo& ReplayInfo)
+{
+    if (ReplayInfo.pArchive == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Pipeline archive must not be null");
+        return 0;
+    }
+
+    std::unique_ptr<PipelineArchiveReader> pArchive;
+    std::vector<const char*>               PipelineNames;
+
+    std::unordered_map<std::string, RefCntAutoPtr<IPipelineResourceSignature>> Signatures;
+    std::unordered_map<std::string, RefCntAutoPtr<IShader>>                    Shaders;
+    try
+    {
+        pArchive.reset(new PipelineArchiveReader{ReplayInfo.pArchive});
+        PipelineNames = pArchive->GetPipelineNames();
+
+        // Resource signatures are cheap to create and are created by this thread
+        for (const auto* SignName : pArchive->GetResourceSignatureNames())
+        {
+            PipelineResourceSignatureDesc     SignDesc;
+            std::vector<PipelineResourceDesc> Resources;
+            std::vector<ImmutableSamplerDesc> ImmutableSamplers;
+            pArchive->GetResourceSignature(SignName, SignDesc, Resources, ImmutableSamplers);
+
+            RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+            pDevice->CreatePipelineResourceSignature(SignDesc, &pSignature);
+            if (pSignature)
+                Signatures.emplace(SignName, std::move(pSignature));
+        }
+
+        // Shaders are shared by many pipelines, so they are created up front by the parallel shader creation
+        const auto DeviceType  = pDevice->GetDeviceInfo().Type;
+        const auto ShaderNames = pArchive->GetShaderNames(DeviceType);
+
+        std::vector<ShaderCreateInfo> ShaderCIs(ShaderNames.size());
+        for (size_t i = 0; i < ShaderNames.size(); ++i)
+            pArchive->GetShader(ShaderNames[i], DeviceType, ShaderCIs[i]);
+
+        std::vector<IShader*> ppShaders(ShaderNames.size());
+        pDevice->CreateShaders(ShaderCIs.data(), static_cast<Uint32>(ShaderCIs.size()), ppShaders.data());
+        for (size_t i = 0; i < ShaderNames.size(); ++i)
+        {
+            RefCntAutoPtr<IShader> pShader;
+            pShader.Attach(ppShaders[i]);
+            if (pShader)
+                Shaders.emplace(ShaderNames[i], std::move(pShader));
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to read the pipeline archive");
+        return 0;
+    }
+
+    const auto NumPipelines = static_cast<Uint32>(PipelineNames.size());
+    if (NumPipelines == 0)
+        return 0;
+
+    // The state is shared with the tasks, so that the tasks that start
+    // after all pipelines have been processed can safely exit.
+    struct ReplayState
+    {
+        std::atomic<Uint32>     NextPipeline{0};
+        std::atomic<Uint32>     NumCreated{0};
+        Uint32                  NumProcessed = 0;
+        std::mutex              Mtx;
+        std::condition_variable AllProcessedCV;
+    };
+    auto pState = std::make_shared<ReplayState>();
+
+    const auto& Archive         = *pArchive;
+    auto        ReplayPipelines = [&, pState, NumPipelines]() {
+        Uint32 NumProcessedByThisThread = 0;
+        for (auto Idx = pState->NextPipeline.fetch_add(1); Idx < NumPipelines; Idx = pState->NextPipeline.fetch_add(1))
+        {
+            ++NumProcessedByThisThread;
+            try
+            {
+                PipelineArchiveReader::PipelineInfo Pipeline;
+                Archive.GetPipeline(PipelineNames[Idx], Pipeline);
+
+                std::vector<IShader*> ppShaders;
+                for (const auto* ShaderName : Pipeline.ShaderNames)
+                {
+                    auto it = Shaders.find(ShaderName);
+                    if (it == Shaders.end())
+                        break;
+                    ppShaders.push_back(it->second);
+                }
+
+                std::vector<IPipelineResourceSignature*> ppSignatures;
+                for (const auto* SignName : Pipeline.SignatureNames)
+                {
+                    auto it = Signatures.find(SignName);
+                    if (it == Signatures.end())
+                        break;
+                    ppSignatures.push_back(it->second);
+                }
+
+                // Pipelines whose shaders have no byte code for this device type are skipped
+                if (ppShaders.size() != Pipeline.ShaderNames.size() || ppSignatures.size() != Pipeline.SignatureNames.size())
+                    continue;
+
+                RefCntAutoPtr<IPipelineState> pPSO;
+                CreateArchivedPipeline(pDevice, Pipeline, ppShaders.data(), ppSignatures.data(), nullptr, 0, ReplayInfo.pPSOCache, &pPSO);
+                if (pPSO)
+                    pState->NumCreated.fetch_add(1);
+            }
+            catch (...)
+            {
+                LOG_ERROR("Failed to replay pipeline state '", PipelineNames[Idx], "'");
+            }
+        }
+
+        if (NumProcessedByThisThread > 0)
+        {
+            bool AllProcessed = false;
+            {
+                std::lock_guard<std::mutex> Lock{pState->Mtx};
+                pState->NumProcessed += NumProcessedByThisThread;
+                AllProcessed = pState->NumProcessed == NumPipelines;
+            }
+            if (AllProcessed)
+                pState->AllProcessedCV.notify_all();
+        }
+    };
+
+    const auto NumWorkers = std::min(NumPipelines - 1, TaskPool.GetThreadCount());
+    for (Uint32 i = 0; i < NumWorkers; ++i)
+        EnqueueTask(&TaskPool, ReplayPipelines);
+
+    // The calling thread creates the pipelines too
+    ReplayPipelines();
+
+    {
+        std::unique_lock<std::mutex> Lock{pState->Mtx};
+        pState->AllProcessedCV.wait(Lock, [&pState, NumPipelines] { return pState->NumProcessed == NumPipelines; });
+    }
+
+    return pState->NumCreated.load();
+}
+
+} // namespace Diligent
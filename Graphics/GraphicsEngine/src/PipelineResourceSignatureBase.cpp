@@ -58,6 +58,8 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
 
     // Hash map of all resources by name
     std::unordered_multimap<HashMapStringKey, const PipelineResourceDesc&, HashMapStringKey::Hasher> Resources;
+
+    Uint32 InlineConstantsResIndex = ~0u;
     for (Uint32 i = 0; i < Desc.NumResources; ++i)
     {
         const auto& Res = Desc.Resources[i];
@@ -101,6 +103,43 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
             LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (RUNTIME_ARRAY) can only be used if ShaderResourceRuntimeArray device feature is enabled.");
         }
 
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP) != 0)
+        {
+            if (!Features.BindlessResources)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (BINDLESS_HEAP) can only be used if BindlessResources device feature is enabled.");
+            }
+
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY) == 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (", GetPipelineResourceFlagsString(Res.Flags),
+                                        "): BINDLESS_HEAP flag must be combined with RUNTIME_ARRAY flag.");
+            }
+
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER) != 0)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (", GetPipelineResourceFlagsString(Res.Flags),
+                                        "): BINDLESS_HEAP flag is not compatible with COMBINED_SAMPLER flag.");
+            }
+        }
+
+        if ((Res.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+        {
+            if (Res.Flags != PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS)
+            {
+                LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].Flags (", GetPipelineResourceFlagsString(Res.Flags),
+                                        "): INLINE_CONSTANTS flag can't be combined with any other flag.");
+            }
+
+            if (InlineConstantsResIndex != ~0u)
+            {
+                LOG_PRS_ERROR_AND_THROW("Desc.Resources[", i, "] ('", Res.Name, "') and Desc.Resources[", InlineConstantsResIndex, "] ('",
+                                        Desc.Resources[InlineConstantsResIndex].Name,
+                                        "') both use INLINE_CONSTANTS flag. Only one inline constants resource is allowed in a signature.");
+            }
+            InlineConstantsResIndex = i;
+        }
+
         if (Res.ResourceType == SHADER_RESOURCE_TYPE_ACCEL_STRUCT && !Features.RayTracing)
         {
             LOG_PRS_ERROR_AND_THROW("Incorrect Desc.Resources[", i, "].ResourceType (ACCEL_STRUCT): ray tracing is not supported by device.");
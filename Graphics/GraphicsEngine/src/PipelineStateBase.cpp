@@ -158,6 +158,21 @@ void CorrectBlendStateDesc(GraphicsPipelineDesc& GraphicsPipeline) noexcept
     }
 }
 
+void ValidateDynamicStates(const PipelineStateDesc& PSODesc, const GraphicsPipelineDesc& GraphicsPipeline, const DeviceFeatures& Features) noexcept(false)
+{
+    if (GraphicsPipeline.DynamicStates == DYNAMIC_STATE_FLAG_NONE)
+        return;
+
+    if (!Features.DynamicPipelineStates)
+        LOG_PSO_ERROR_AND_THROW("Dynamic states are not supported by this device. Check DeviceFeatures.DynamicPipelineStates feature.");
+
+    if ((GraphicsPipeline.DynamicStates & ~DYNAMIC_STATE_FLAG_ALL) != 0)
+        LOG_PSO_ERROR_AND_THROW("DynamicStates (", Uint32{GraphicsPipeline.DynamicStates}, ") contains unknown flags.");
+
+    if (PSODesc.PipelineType == PIPELINE_TYPE_MESH && (GraphicsPipeline.DynamicStates & DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY) != 0)
+        LOG_PSO_ERROR_AND_THROW("Primitive topology can't be dynamic in a mesh pipeline.");
+}
+
 
 void ValidatePipelineResourceSignatures(const PipelineStateCreateInfo& CreateInfo,
                                         const DeviceFeatures&          Features) noexcept(false)
@@ -362,6 +377,52 @@ void ValidatePipelineResourceLayoutDesc(const PipelineStateDesc& PSODesc, const
     }
 }
 
+void ValidateSpecializationConstants(const PipelineStateCreateInfo& CreateInfo, const DeviceFeatures& Features) noexcept(false)
+{
+    const auto& PSODesc = CreateInfo.PSODesc;
+
+    if (CreateInfo.NumSpecializationConstants != 0 && CreateInfo.pSpecializationConstants == nullptr)
+        LOG_PSO_ERROR_AND_THROW("pSpecializationConstants is null, but NumSpecializationConstants (", CreateInfo.NumSpecializationConstants, ") is not zero.");
+
+    if (CreateInfo.NumSpecializationConstants == 0)
+        return;
+
+    if (!Features.SpecializationConstants)
+        LOG_PSO_ERROR_AND_THROW("Specialization constants are not supported by this device. Check DeviceFeatures.SpecializationConstants feature.");
+
+    std::unordered_multimap<HashMapStringKey, SHADER_TYPE, HashMapStringKey::Hasher> UniqueConstants;
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        const auto& Const = CreateInfo.pSpecializationConstants[i];
+
+        if (Const.Name == nullptr)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Name must not be null.");
+
+        if (Const.Name[0] == '\0')
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Name must not be empty.");
+
+        if (Const.ShaderStages == SHADER_TYPE_UNKNOWN)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].ShaderStages must not be SHADER_TYPE_UNKNOWN.");
+
+        if (Const.pData == nullptr)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].pData must not be null.");
+
+        if (Const.Size == 0)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Size must not be zero.");
+
+        auto range = UniqueConstants.equal_range(Const.Name);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if ((it->second & Const.ShaderStages) != 0)
+            {
+                LOG_PSO_ERROR_AND_THROW("Shader stages of multiple specialization constants with name '", Const.Name,
+                                        "' overlap. Specialization constants that share the same name must use distinct shader stages.");
+            }
+        }
+        UniqueConstants.emplace(Const.Name, Const.ShaderStages);
+    }
+}
+
 
 #define VALIDATE_SHADER_TYPE(Shader, ExpectedType, ShaderName)                                                                           \
     if (Shader != nullptr && Shader->GetDesc().ShaderType != ExpectedType)                                                               \
@@ -377,12 +438,14 @@ void ValidateGraphicsPipelineCreateInfo(const GraphicsPipelineStateCreateInfo& C
         LOG_PSO_ERROR_AND_THROW("Pipeline type must be GRAPHICS or MESH.");
 
     ValidatePipelineResourceSignatures(CreateInfo, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
 
     const auto& GraphicsPipeline = CreateInfo.GraphicsPipeline;
 
     ValidateBlendStateDesc(PSODesc, GraphicsPipeline);
     ValidateRasterizerStateDesc(PSODesc, GraphicsPipeline);
     ValidateDepthStencilDesc(PSODesc, GraphicsPipeline);
+    ValidateDynamicStates(PSODesc, GraphicsPipeline, Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
 
 
@@ -458,6 +521,7 @@ void ValidateComputePipelineCreateInfo(const ComputePipelineStateCreateInfo& Cre
         LOG_PSO_ERROR_AND_THROW("Pipeline type must be COMPUTE.");
 
     ValidatePipelineResourceSignatures(CreateInfo, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
 
     if (CreateInfo.pCS == nullptr)
@@ -479,6 +543,7 @@ void ValidateRayTracingPipelineCreateInfo(IRenderDevice*
         LOG_PSO_ERROR_AND_THROW("Standalone ray tracing shaders are not supported");
 
     ValidatePipelineResourceSignatures(CreateInfo, DeviceInfo.Features);
+    ValidateSpecializationConstants(CreateInfo, DeviceInfo.Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, DeviceInfo.Features);
 
     if (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12)
@@ -564,6 +629,7 @@ void ValidateTilePipelineCreateInfo(const TilePipelineStateCreateInfo& CreateInf
         LOG_PSO_ERROR_AND_THROW("Pipeline type must be TILE.");
 
     ValidatePipelineResourceSignatures(CreateInfo, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
 
     if (CreateInfo.pTS == nullptr)
@@ -0,0 +1,273 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PipelineStateRecorder.hpp"
+
+#include "RenderDeviceBase.hpp"
+#include "HashUtils.hpp"
+#include "FormatString.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+void HashCombineStr(size_t& Seed, const char* Str)
+{
+    HashCombine(Seed, CStringHash<Char>{}(Str != nullptr ? Str : ""));
+}
+
+std::string GetRecordName(const char* Name, size_t Hash)
+{
+    return FormatString(Name != nullptr ? Name : "Unnamed", " #", std::hex, Hash);
+}
+
+size_t ComputeSignatureHash(const PipelineResourceSignatureDesc& Desc)
+{
+    size_t Hash = ComputeHash(Desc.NumResources, Desc.NumImmutableSamplers, Desc.BindingIndex,
+                              Desc.UseCombinedTextureSamplers, Desc.SRBAllocationGranularity);
+    HashCombineStr(Hash, Desc.CombinedSamplerSuffix);
+
+    for (Uint32 i = 0; i < Desc.NumResources; ++i)
+    {
+        const auto& Res = Desc.Resources[i];
+        HashCombineStr(Hash, Res.Name);
+        HashCombine(Hash, Uint32{Res.ShaderStages}, Res.ArraySize, Uint32{Res.ResourceType}, Uint32{Res.VarType}, Uint32{Res.Flags});
+    }
+
+    for (Uint32 i = 0; i < Desc.NumImmutableSamplers; ++i)
+    {
+        const auto& Sam = Desc.ImmutableSamplers[i];
+        HashCombineStr(Hash, Sam.SamplerOrTextureName);
+        HashCombine(Hash, Uint32{Sam.ShaderStages}, Sam.Desc);
+    }
+
+    return Hash;
+}
+
+void HashGraphicsPipelineDesc(size_t& Hash, const GraphicsPipelineDesc& Desc)
+{
+    HashCombine(Hash, Desc.BlendDesc, Desc.SampleMask, Desc.RasterizerDesc, Desc.DepthStencilDesc);
+
+    const auto& InputLayout = Desc.InputLayout;
+    HashCombine(Hash, InputLayout.NumElements);
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& Elem = InputLayout.LayoutElements[i];
+        HashCombineStr(Hash, Elem.HLSLSemantic);
+        HashCombine(Hash, Elem.InputIndex, Elem.BufferSlot, Elem.NumComponents, Uint32{Elem.ValueType}, Elem.IsNormalized,
+                    Elem.RelativeOffset, Elem.Stride, Uint32{Elem.Frequency}, Elem.InstanceDataStepRate);
+    }
+
+    HashCombine(Hash, Uint32{Desc.PrimitiveTopology}, Desc.NumViewports, Desc.NumRenderTargets);
+    for (auto Fmt : Desc.RTVFormats)
+        HashCombine(Hash, Uint32{Fmt});
+    HashCombine(Hash, Uint32{Desc.DSVFormat}, Desc.SmplDesc.Count, Desc.SmplDesc.Quality, Desc.NodeMask, Uint32{Desc.DynamicStates});
+}
+
+} // namespace
+
+void PipelineStateRecorder::RecordShader(const ShaderCreateInfo& ShaderCI, IShader* pShader)
+{
+    VERIFY_EXPR(pShader != nullptr);
+
+    ShaderInfo Info;
+    Info.EntryPoint                 = ShaderCI.EntryPoint != nullptr ? ShaderCI.EntryPoint : "main";
+    Info.UseCombinedTextureSamplers = ShaderCI.UseCombinedTextureSamplers;
+    Info.CombinedSamplerSuffix      = ShaderCI.CombinedSamplerSuffix != nullptr ? ShaderCI.CombinedSamplerSuffix : "_sampler";
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Shaders.emplace(pShader->GetUniqueID(), std::move(Info));
+}
+
+void PipelineStateRecorder::RecordPipeline(RENDER_DEVICE_TYPE DeviceType, const GraphicsPipelineStateCreateInfo& CreateInfo, IPipelineState* pPSO)
+{
+    IShader* ppShaders[7];
+    Uint32   NumShaders = 0;
+    for (auto* pShader : {CreateInfo.pVS, CreateInfo.pPS, CreateInfo.pDS, CreateInfo.pHS, CreateInfo.pGS, CreateInfo.pAS, CreateInfo.pMS})
+    {
+        if (pShader != nullptr)
+            ppShaders[NumShaders++] = pShader;
+    }
+    RecordPipelineImpl(DeviceType, CreateInfo, &CreateInfo.GraphicsPipeline, ppShaders, NumShaders, pPSO);
+}
+
+void PipelineStateRecorder::RecordPipeline(RENDER_DEVICE_TYPE DeviceType, const ComputePipelineStateCreateInfo& CreateInfo, IPipelineState* pPSO)
+{
+    if (CreateInfo.pCS != nullptr)
+        RecordPipelineImpl(DeviceType, CreateInfo, nullptr, &CreateInfo.pCS, 1, pPSO);
+}
+
+const std::string* PipelineStateRecorder::AddShader(RENDER_DEVICE_TYPE DeviceType, IShader* pShader)
+{
+    auto it = m_Shaders.find(pShader->GetUniqueID());
+    if (it == m_Shaders.end())
+        return nullptr;
+
+    auto& Info = it->second;
+    if (!Info.RecordName.empty())
+        return &Info.RecordName;
+
+    const void* pBytecode    = nullptr;
+    Uint64      BytecodeSize = 0;
+    pShader->GetBytecode(&pBytecode, BytecodeSize);
+    if (pBytecode == nullptr || BytecodeSize == 0)
+        return nullptr;
+
+    const auto& Desc = pShader->GetDesc();
+
+    auto Hash = ComputeHashRaw(pBytecode, static_cast<size_t>(BytecodeSize));
+    HashCombine(Hash, Uint32{Desc.ShaderType}, Info.EntryPoint, Info.UseCombinedTextureSamplers, Info.CombinedSamplerSuffix);
+    Info.RecordName = GetRecordName(Desc.Name, Hash);
+
+    if (m_ShaderRecords.insert(Info.RecordName).second)
+    {
+        std::vector<ShaderResourceDesc>            ResourceDescs(pShader->GetResourceCount());
+        std::vector<PipelineArchiveShaderResource> Resources(ResourceDescs.size());
+        for (Uint32 i = 0; i < ResourceDescs.size(); ++i)
+        {
+            pShader->GetResourceDesc(i, ResourceDescs[i]);
+            Resources[i].Name      = ResourceDescs[i].Name;
+            Resources[i].Type      = ResourceDescs[i].Type;
+            Resources[i].ArraySize = ResourceDescs[i].ArraySize;
+        }
+
+        PipelineArchiveShaderDesc ShaderDesc;
+        ShaderDesc.Name                       = Info.RecordName.c_str();
+        ShaderDesc.DeviceType                 = DeviceType;
+        ShaderDesc.ShaderType                 = Desc.ShaderType;
+        ShaderDesc.EntryPoint                 = Info.EntryPoint.c_str();
+        ShaderDesc.UseCombinedTextureSamplers = Info.UseCombinedTextureSamplers;
+        ShaderDesc.CombinedSamplerSuffix      = Info.CombinedSamplerSuffix.c_str();
+        ShaderDesc.ByteCode                   = pBytecode;
+        ShaderDesc.ByteCodeSize               = static_cast<size_t>(BytecodeSize);
+        ShaderDesc.Resources                  = Resources.data();
+        ShaderDesc.NumResources               = static_cast<Uint32>(Resources.size());
+        m_Writer.AddShader(ShaderDesc);
+    }
+
+    return &Info.RecordName;
+}
+
+std::string PipelineStateRecorder::AddResourceSignature(const PipelineResourceSignatureDesc& Desc)
+{
+    auto RecordName = GetRecordName(Desc.Name, ComputeSignatureHash(Desc));
+    if (m_SignatureRecords.insert(RecordName).second)
+    {
+        auto RecordDesc{Desc};
+        RecordDesc.Name = RecordName.c_str();
+        m_Writer.AddResourceSignature(RecordDesc);
+    }
+    return RecordName;
+}
+
+void PipelineStateRecorder::RecordPipelineImpl(RENDER_DEVICE_TYPE             DeviceType,
+                                               const PipelineStateCreateInfo& CreateInfo,
+                                               const GraphicsPipelineDesc*    pGraphicsPipeline,
+                                               IShader* const*                ppShaders,
+                                               Uint32                         NumShaders,
+                                               IPipelineState*                pPSO)
+{
+    VERIFY_EXPR(pPSO != nullptr);
+
+    // Render passes are not supported by the pipeline archive
+    if (pGraphicsPipeline != nullptr && pGraphicsPipeline->pRenderPass != nullptr)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // Check that all shaders can be recorded before anything is added to the archive
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        const void* pBytecode    = nullptr;
+        Uint64      BytecodeSize = 0;
+        ppShaders[i]->GetBytecode(&pBytecode, BytecodeSize);
+        if (BytecodeSize == 0 || m_Shaders.find(ppShaders[i]->GetUniqueID()) == m_Shaders.end())
+            return;
+    }
+
+    const auto& PSODesc = CreateInfo.PSODesc;
+
+    size_t Hash = ComputeHash(Uint32{PSODesc.PipelineType}, PSODesc.SRBAllocationGranularity);
+
+    std::vector<const char*> ShaderNames(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        const auto* pRecordName = AddShader(DeviceType, ppShaders[i]);
+        VERIFY_EXPR(pRecordName != nullptr);
+        ShaderNames[i] = pRecordName->c_str();
+        HashCombine(Hash, *pRecordName);
+    }
+
+    // The pipeline reports its implicit signature when it was created with the resource layout
+    std::vector<std::string> SignatureRecordNames;
+    for (Uint32 i = 0; i < pPSO->GetResourceSignatureCount(); ++i)
+    {
+        if (const auto* pSignature = pPSO->GetResourceSignature(i))
+        {
+            SignatureRecordNames.emplace_back(AddResourceSignature(pSignature->GetDesc()));
+            HashCombine(Hash, SignatureRecordNames.back());
+        }
+    }
+    std::vector<const char*> SignatureNames(SignatureRecordNames.size());
+    for (size_t i = 0; i < SignatureRecordNames.size(); ++i)
+        SignatureNames[i] = SignatureRecordNames[i].c_str();
+
+    if (pGraphicsPipeline != nullptr)
+        HashGraphicsPipelineDesc(Hash, *pGraphicsPipeline);
+
+    const auto RecordName = GetRecordName(PSODesc.Name, Hash);
+    if (!m_PipelineRecords.insert(RecordName).second)
+        return;
+
+    PipelineArchivePipelineDesc PipelineDesc;
+    PipelineDesc.Name                     = RecordName.c_str();
+    PipelineDesc.PipelineType             = PSODesc.PipelineType;
+    PipelineDesc.SRBAllocationGranularity = PSODesc.SRBAllocationGranularity;
+    if (pGraphicsPipeline != nullptr)
+        PipelineDesc.GraphicsPipeline = *pGraphicsPipeline;
+    PipelineDesc.ShaderNames    = ShaderNames.data();
+    PipelineDesc.NumShaders     = NumShaders;
+    PipelineDesc.SignatureNames = SignatureNames.data();
+    PipelineDesc.NumSignatures  = static_cast<Uint32>(SignatureNames.size());
+    m_Writer.AddPipeline(PipelineDesc);
+}
+
+void PipelineStateRecorder::Serialize(std::vector<Uint8>& Data) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Writer.Serialize(Data);
+}
+
+Uint32 PipelineStateRecorder::GetPipelineCount() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return static_cast<Uint32>(m_PipelineRecords.size());
+}
+
+} // namespace Diligent
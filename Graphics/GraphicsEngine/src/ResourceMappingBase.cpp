@@ -35,23 +35,22 @@ ResourceMappingImpl::~ResourceMappingImpl()
 {
 }
 
-ThreadingTools::LockHelper ResourceMappingImpl::Lock()
-{
-    return ThreadingTools::LockHelper(m_LockFlag);
-}
-
 void ResourceMappingImpl::AddResourceArray(const Char* Name, Uint32 StartIndex, IDeviceObject* const* ppObjects, Uint32 NumElements, bool bIsUnique)
 {
     if (Name == nullptr || *Name == 0)
         return;
 
-    auto LockHelper = Lock();
     for (Uint32 Elem = 0; Elem < NumElements; ++Elem)
     {
         auto* pObject = ppObjects[Elem];
 
+        ResMappingHashKey Key{Name, true /*Make copy*/, StartIndex + Elem};
+        auto&             Shard = GetShard(Key);
+
+        ThreadingTools::LockHelper Lock{Shard.LockFlag};
+
         // Try to construct new element in place
-        auto Elems = m_HashTable.emplace(ResMappingHashKey{Name, true /*Make copy*/, StartIndex + Elem}, pObject);
+        auto Elems = Shard.HashTable->emplace(std::move(Key), pObject);
         // If there is already element with the same name, replace it
         if (!Elems.second && Elems.first->second != pObject)
         {
@@ -78,10 +77,13 @@ void ResourceMappingImpl::RemoveResourceByName(const Char* Name, Uint32 ArrayInd
     if (*Name == 0)
         return;
 
-    auto LockHelper = Lock();
     // Remove object with the given name
     // Name will be implicitly converted to HashMapStringKey without making a copy
-    m_HashTable.erase(ResMappingHashKey{Name, false, ArrayIndex});
+    const ResMappingHashKey Key{Name, false, ArrayIndex};
+    auto&                   Shard = GetShard(Key);
+
+    ThreadingTools::LockHelper Lock{Shard.LockFlag};
+    Shard.HashTable->erase(Key);
 }
 
 void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResource, Uint32 ArrayIndex)
@@ -97,12 +99,29 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
     VERIFY(*ppResource == nullptr, "Overwriting reference to existing object may cause memory leaks");
     *ppResource = nullptr;
 
-    auto LockHelper = Lock();
-
     // Find an object with the requested name
     // Name will be implicitly converted to HashMapStringKey without making a copy
-    auto It = m_HashTable.find(ResMappingHashKey{Name, false, ArrayIndex});
-    if (It != m_HashTable.end())
+    const ResMappingHashKey Key{Name, false, ArrayIndex};
+    FindResource(Key, ppResource);
+}
+
+void ResourceMappingImpl::GetResource(const Char* Name, size_t NameHash, IDeviceObject** ppResource, Uint32 ArrayIndex)
+{
+    VERIFY(Name != nullptr && *Name != 0, "Name must not be null or empty");
+    VERIFY(ppResource != nullptr && *ppResource == nullptr, "Null pointer or pointer to an existing object provided");
+
+    const ResMappingHashKey Key{Name, NameHash, ArrayIndex};
+    FindResource(Key, ppResource);
+}
+
+void ResourceMappingImpl::FindResource(const ResMappingHashKey& Key, IDeviceObject** ppResource)
+{
+    auto& Shard = GetShard(Key);
+
+    ThreadingTools::LockHelper Lock{Shard.LockFlag};
+
+    auto It = Shard.HashTable->find(Key);
+    if (It != Shard.HashTable->end())
     {
         *ppResource = It->second.RawPtr();
         if (*ppResource)
@@ -112,7 +131,13 @@ void ResourceMappingImpl::GetResource(const Char* Name, IDeviceObject** ppResour
 
 size_t ResourceMappingImpl::GetSize()
 {
-    return m_HashTable.size();
+    size_t Size = 0;
+    for (auto& Shard : m_Shards)
+    {
+        ThreadingTools::LockHelper Lock{Shard.LockFlag};
+        Size += Shard.HashTable->size();
+    }
+    return Size;
 }
 
 } // namespace Diligent
@@ -149,6 +149,40 @@ void ValidateTextureDesc(const TextureDesc& Desc) noexcept(false)
         LOG_TEXTURE_ERROR_AND_THROW("USAGE_UNIFIED textures are currently not supported.");
     }
 
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE)
+    {
+        if (Desc.Type != RESOURCE_DIM_TEX_2D && Desc.Type != RESOURCE_DIM_TEX_2D_ARRAY)
+            LOG_TEXTURE_ERROR_AND_THROW("Only Texture 2D/Texture 2D Array can be sparse.");
+
+        if (Desc.SampleCount > 1)
+            LOG_TEXTURE_ERROR_AND_THROW("Sparse textures can not be multisampled.");
+
+        if (Desc.Usage != USAGE_DEFAULT)
+            LOG_TEXTURE_ERROR_AND_THROW("Sparse textures must use USAGE_DEFAULT.");
+
+        if (Desc.BindFlags & BIND_DEPTH_STENCIL)
+            LOG_TEXTURE_ERROR_AND_THROW("Sparse depth-stencil textures are not supported.");
+
+        if (Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS)
+            LOG_TEXTURE_ERROR_AND_THROW("Mipmaps can not be autogenerated for sparse textures.");
+    }
+
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS)
+    {
+        if (Desc.Usage != USAGE_DEFAULT)
+            LOG_TEXTURE_ERROR_AND_THROW("Memoryless textures must use USAGE_DEFAULT.");
+
+        constexpr BIND_FLAGS AllowedBindFlags = BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_INPUT_ATTACHMENT;
+        if ((Desc.BindFlags & AllowedBindFlags) == 0)
+            LOG_TEXTURE_ERROR_AND_THROW("Memoryless textures must use at least one of BIND_RENDER_TARGET, BIND_DEPTH_STENCIL or BIND_INPUT_ATTACHMENT flags.");
+
+        if ((Desc.BindFlags & ~AllowedBindFlags) != 0)
+            LOG_TEXTURE_ERROR_AND_THROW("Memoryless textures may only be bound as render target, depth-stencil or input attachment.");
+
+        if (Desc.MiscFlags & (MISC_TEXTURE_FLAG_GENERATE_MIPS | MISC_TEXTURE_FLAG_SPARSE))
+            LOG_TEXTURE_ERROR_AND_THROW("Memoryless textures can't be sparse or use automatic mipmap generation.");
+    }
+
     if (Desc.Usage == USAGE_DYNAMIC &&
         PlatformMisc::CountOneBits(Desc.ImmediateContextMask) > 1)
     {
@@ -276,6 +310,8 @@ void ValidateCopyTextureParams(const CopyTextureAttribs& CopyAttribs)
     const auto& SrcTexDesc = CopyAttribs.pSrcTexture->GetDesc();
     const auto& DstTexDesc = CopyAttribs.pDstTexture->GetDesc();
     auto        pSrcBox    = CopyAttribs.pSrcBox;
+    DEV_CHECK_ERR((SrcTexDesc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0, "Memoryless texture '", SrcTexDesc.Name, "' can't be copied.");
+    DEV_CHECK_ERR((DstTexDesc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0, "Memoryless texture '", DstTexDesc.Name, "' can't be copied.");
     if (pSrcBox == nullptr)
     {
         auto MipLevelAttribs = GetMipLevelProperties(SrcTexDesc, CopyAttribs.SrcMipLevel);
@@ -286,12 +322,34 @@ void ValidateCopyTextureParams(const CopyTextureAttribs& CopyAttribs)
     }
     ValidateTextureRegion(SrcTexDesc, CopyAttribs.SrcMipLevel, CopyAttribs.SrcSlice, *pSrcBox);
 
+    DEV_CHECK_ERR(IsCopyCompatibleFormat(SrcTexDesc.Format, DstTexDesc.Format),
+                  "Format ", GetTextureFormatAttribs(SrcTexDesc.Format).Name, " of texture '", SrcTexDesc.Name,
+                  "' is not copy-compatible with format ", GetTextureFormatAttribs(DstTexDesc.Format).Name, " of texture '", DstTexDesc.Name, "'.");
+
+    Uint32 RegionWidth  = pSrcBox->MaxX - pSrcBox->MinX;
+    Uint32 RegionHeight = pSrcBox->MaxY - pSrcBox->MinY;
+
+    // When an uncompressed texture is copied to a compressed one or vice versa,
+    // one texel of the uncompressed texture corresponds to one block of the compressed texture.
+    const auto& SrcFmtAttribs = GetTextureFormatAttribs(SrcTexDesc.Format);
+    const auto& DstFmtAttribs = GetTextureFormatAttribs(DstTexDesc.Format);
+    if (SrcFmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED && DstFmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        RegionWidth *= DstFmtAttribs.BlockWidth;
+        RegionHeight *= DstFmtAttribs.BlockHeight;
+    }
+    else if (SrcFmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED && DstFmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED)
+    {
+        RegionWidth  = (RegionWidth + SrcFmtAttribs.BlockWidth - 1) / SrcFmtAttribs.BlockWidth;
+        RegionHeight = (RegionHeight + SrcFmtAttribs.BlockHeight - 1) / SrcFmtAttribs.BlockHeight;
+    }
+
     Box DstBox;
     DstBox.MinX = CopyAttribs.DstX;
     DstBox.MinY = CopyAttribs.DstY;
     DstBox.MinZ = CopyAttribs.DstZ;
-    DstBox.MaxX = DstBox.MinX + (pSrcBox->MaxX - pSrcBox->MinX);
-    DstBox.MaxY = DstBox.MinY + (pSrcBox->MaxY - pSrcBox->MinY);
+    DstBox.MaxX = DstBox.MinX + RegionWidth;
+    DstBox.MaxY = DstBox.MinY + RegionHeight;
     DstBox.MaxZ = DstBox.MinZ + (pSrcBox->MaxZ - pSrcBox->MinZ);
     ValidateTextureRegion(DstTexDesc, CopyAttribs.DstMipLevel, CopyAttribs.DstSlice, DstBox);
 }
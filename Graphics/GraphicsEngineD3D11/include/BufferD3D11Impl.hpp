@@ -30,10 +30,13 @@
 /// \file
 /// Declaration of Diligent::BufferD3D11Impl class
 
+#include <vector>
+
 #include <atlbase.h>
 
 #include "EngineD3D11ImplTraits.hpp"
 #include "BufferBase.hpp"
+#include "IndexWrapper.hpp"
 
 namespace Diligent
 {
@@ -81,6 +84,26 @@ public:
             m_State = RESOURCE_STATE_UNDEFINED;
     }
 
+    /// Returns true if the buffer contents may be suballocated from the device context's dynamic constant ring.
+    bool IsRingSuballocated() const { return !m_RingAllocations.empty(); }
+
+    /// Returns the D3D11 buffer that holds the current contents of the buffer in the given context
+    /// and the byte offset of the data in that buffer.
+    ID3D11Buffer* GetD3D11Buffer(DeviceContextIndex CtxId, Uint32& Offset) const
+    {
+        if (!m_RingAllocations.empty())
+        {
+            const auto& RingAlloc = m_RingAllocations[CtxId];
+            if (RingAlloc.pd3d11Buffer != nullptr)
+            {
+                Offset = RingAlloc.Offset;
+                return RingAlloc.pd3d11Buffer;
+            }
+        }
+        Offset = 0;
+        return m_pd3d11Buffer;
+    }
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -89,6 +112,16 @@ private:
 
     friend class DeviceContextD3D11Impl;
     CComPtr<ID3D11Buffer> m_pd3d11Buffer; ///< D3D11 buffer object
+
+    struct RingAllocation
+    {
+        // The ring buffer is owned by the device context
+        ID3D11Buffer* pd3d11Buffer = nullptr;
+        Uint32        Offset       = 0;
+        Uint32        Generation   = 0;
+    };
+    // Per-context suballocations in the dynamic constant ring. Empty if the buffer is not ring-suballocated.
+    std::vector<RingAllocation> m_RingAllocations;
 };
 
 } // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::DeviceContextD3D11Impl class
 
 #include <vector>
+#include <memory>
 
 #include "EngineD3D11ImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -44,6 +45,7 @@
 #include "BottomLevelASBase.hpp"
 #include "TopLevelASBase.hpp"
 #include "ShaderResourceBindingD3D11Impl.hpp"
+#include "DynamicConstantRingD3D11.hpp"
 
 namespace Diligent
 {
@@ -63,7 +65,7 @@ public:
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
     /// Implementation of IDeviceContext::Begin() in Direct3D11 backend.
-    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
+    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags) override final;
 
     /// Implementation of IDeviceContext::SetPipelineState() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
@@ -82,6 +84,9 @@ public:
     /// Implementation of IDeviceContext::SetBlendFactors() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE SetBlendFactors(const float* pBlendFactors = nullptr) override final;
 
+    /// Implementation of IDeviceContext::SetDynamicStates() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicStates(const DynamicStateAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetVertexBuffers() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
                                                      Uint32                         NumBuffersSet,
@@ -133,6 +138,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndirectCount() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh(const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D11 backend.
@@ -186,6 +195,12 @@ public:
                                                   RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
                                                   RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextureRegions() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextureRegions(ITexture*                      pTexture,
+                                                         const TextureRegionUpdate*     pUpdates,
+                                                         Uint32                         NumUpdates,
+                                                         RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
+
     /// Implementation of IDeviceContext::CopyTexture() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
@@ -204,6 +219,9 @@ public:
     /// Implementation of IDeviceContext::GenerateMips() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTextureView) override final;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* ppTextureViews[], Uint32 NumViews) override final;
+
     /// Implementation of IDeviceContext::FinishFrame() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE FinishFrame() override final;
 
@@ -237,6 +255,15 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in Direct3D11 backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final { return False; }
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(IQuery* pQuery) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -246,6 +273,9 @@ public:
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D11 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::CopyBLAS() in Direct3D11 backend.
     virtual void DILIGENT_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final;
 
@@ -435,8 +465,19 @@ private:
 
     std::shared_ptr<DisjointQueryPool::DisjointQueryWrapper> BeginDisjointQuery();
 
+    // The dynamic constant ring must be unmapped before any command that may read from it
+    void UnmapDynamicConstantRing()
+    {
+        if (m_pDynamicConstantRing)
+            m_pDynamicConstantRing->Unmap(m_pd3d11DeviceContext);
+    }
+
     CComPtr<ID3D11DeviceContext1> m_pd3d11DeviceContext; ///< D3D11 device context
 
+    /// Ring buffer that USAGE_DYNAMIC constant buffers are suballocated from.
+    /// Null if suballocation is disabled.
+    std::unique_ptr<DynamicConstantRingD3D11> m_pDynamicConstantRing;
+
     struct BindInfo : CommittedShaderResources
     {
         // Shader stages that are active in current PSO.
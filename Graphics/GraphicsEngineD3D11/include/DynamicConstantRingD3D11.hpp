@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DynamicConstantRingD3D11 class
+
+#include <atlbase.h>
+
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Ring buffer that is used by a device context to suballocate USAGE_DYNAMIC constant buffers.
+
+/// The ring buffer is mapped with D3D11_MAP_WRITE_NO_OVERWRITE and stays mapped while
+/// consecutive allocations are made. It must be unmapped before any command that may
+/// read from it is issued. The ring never wraps within a frame as discarding it would
+/// lose the data of the allocations that have not been used yet. Instead, the first allocation
+/// after Reset() maps the buffer with D3D11_MAP_WRITE_DISCARD, which lets the driver rename
+/// the buffer while the GPU is still reading the old data.
+class DynamicConstantRingD3D11
+{
+public:
+    // Offsets passed to *SSetConstantBuffers1 must be multiples of 16 constants
+    static constexpr Uint32 OffsetAlignment = 256;
+
+    DynamicConstantRingD3D11(ID3D11Device* pd3d11Device, Uint32 Size);
+
+    // clang-format off
+    DynamicConstantRingD3D11             (const DynamicConstantRingD3D11&)  = delete;
+    DynamicConstantRingD3D11             (      DynamicConstantRingD3D11&&) = delete;
+    DynamicConstantRingD3D11& operator = (const DynamicConstantRingD3D11&)  = delete;
+    DynamicConstantRingD3D11& operator = (      DynamicConstantRingD3D11&&) = delete;
+    // clang-format on
+
+    struct Allocation
+    {
+        ID3D11Buffer* pd3d11Buffer = nullptr;
+        Uint32        Offset       = 0;
+        void*         pCPUAddress  = nullptr;
+        Uint32        Generation   = 0;
+    };
+
+    /// Allocates Size bytes from the ring. Returns an empty allocation if the ring is exhausted.
+    Allocation Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size);
+
+    /// Returns the CPU address of the existing allocation, mapping the ring without discarding it if necessary.
+    void* GetCPUAddress(ID3D11DeviceContext* pd3d11Ctx, Uint32 Offset);
+
+    /// Unmaps the ring buffer if it is mapped.
+    void Unmap(ID3D11DeviceContext* pd3d11Ctx)
+    {
+        if (m_pMappedData != nullptr)
+        {
+            pd3d11Ctx->Unmap(m_pd3d11Buffer, 0);
+            m_pMappedData = nullptr;
+        }
+    }
+
+    /// Makes the next allocation discard the ring.
+    /// Must be called at the end of every frame. Deferred contexts must also call it when finishing
+    /// a command list as the first map of a dynamic resource in a command list must use D3D11_MAP_WRITE_DISCARD.
+    void Reset()
+    {
+        VERIFY(m_pMappedData == nullptr, "The ring must be unmapped");
+        m_CurrOffset   = 0;
+        m_NeedsDiscard = true;
+        ++m_Generation;
+    }
+
+    bool IsMapped() const { return m_pMappedData != nullptr; }
+
+    /// Returns the index of the current ring generation, which is incremented by every Reset().
+    /// Allocations from previous generations are no longer valid.
+    Uint32 GetGeneration() const { return m_Generation; }
+
+private:
+    bool Map(ID3D11DeviceContext* pd3d11Ctx, D3D11_MAP MapType);
+
+    CComPtr<ID3D11Buffer> m_pd3d11Buffer;
+
+    const Uint32 m_Size;
+
+    Uint32 m_CurrOffset   = 0;
+    bool   m_NeedsDiscard = true;
+    Uint32 m_Generation   = 0;
+    Uint8* m_pMappedData  = nullptr;
+};
+
+} // namespace Diligent
@@ -58,6 +58,9 @@ public:
     /// Implementation of IPipelineState::IsCompatibleWith() in Direct3D11 backend.
     virtual bool DILIGENT_CALL_TYPE IsCompatibleWith(const IPipelineState* pPSO) const override final;
 
+    // Exchanges the shader objects with another compatible pipeline, see IPipelineState::SwapShaders().
+    void SwapShaderObjects(PipelineStateD3D11Impl& Other);
+
     /// Implementation of IPipelineStateD3D11::GetD3D11BlendState() method.
     virtual ID3D11BlendState* DILIGENT_CALL_TYPE GetD3D11BlendState() override final { return m_pd3d11BlendState; }
 
@@ -113,6 +116,9 @@ private:
     void InitInternalObjects(const PSOCreateInfoType& CreateInfo,
                              CComPtr<ID3DBlob>&       pVSByteCode);
 
+    void InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo);
+    void InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo);
+
     void InitResourceLayouts(const std::vector<ShaderD3D11Impl*>& Shaders,
                              CComPtr<ID3DBlob>&                   pVSByteCode);
 
@@ -146,11 +146,17 @@ public:
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
+    /// Returns the size of the ring buffer used to suballocate dynamic constant buffers,
+    /// or 0 if suballocation is disabled or is not supported by the device.
+    Uint32 GetDynamicConstantRingSize() const { return m_DynamicConstantRingSize; }
+
 private:
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
 
     /// D3D11 device
     CComPtr<ID3D11Device> m_pd3d11Device;
+
+    Uint32 m_DynamicConstantRingSize = 0;
 };
 
 } // namespace Diligent
@@ -128,9 +128,15 @@ public:
         // Returns true if the bound constant buffer allows setting dynamic offset,
         // i.e. the buffer is not bound as a whole (irrespecitve of the variable type or
         // whether the buffer is USAGE_DYNAMIC or not).
+        // Buffers suballocated from the dynamic constant ring are always treated as having
+        // dynamic offset since their location in the ring changes every time they are mapped.
         bool AllowsDynamicOffset() const
         {
-            return pBuff && RangeSize != 0 && RangeSize < pBuff->GetDesc().uiSizeInBytes;
+            if (!pBuff)
+                return false;
+            if (pBuff->IsRingSuballocated())
+                return true;
+            return RangeSize != 0 && RangeSize < pBuff->GetDesc().uiSizeInBytes;
         }
 
         // Returns ID3D11Buffer
@@ -309,41 +315,86 @@ public:
 
     ResourceCacheContentType GetContentType() const { return m_ContentType; }
 
-    struct MinMaxSlot
+    /// Mask of the slots whose committed resources have changed and that need to be set in the D3D11 context.
+    class DirtySlotMask
     {
-        UINT MinSlot = UINT_MAX;
-        UINT MaxSlot = 0;
+    public:
+        static constexpr UINT NumSlots = D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT;
+        static_assert(NumSlots % 64 == 0, "The number of slots must be a multiple of 64");
 
-        void Add(UINT Slot)
-        {
-            MinSlot = std::min(MinSlot, Slot);
+        /// Unchanged slots between two dirty ranges are set again rather than split the range
+        /// when there are no more than this many of them: a D3D11 call costs more than a few slots.
+        static constexpr UINT MaxCleanSlotsInRange = 4;
 
-            VERIFY_EXPR(Slot >= MaxSlot);
-            MaxSlot = Slot;
+        void Set(UINT Slot)
+        {
+            VERIFY_EXPR(Slot < NumSlots);
+            m_Bits[Slot / 64] |= Uint64{1} << (Slot % 64);
         }
 
         explicit operator bool() const
         {
-            return MinSlot <= MaxSlot;
+            for (auto Bits : m_Bits)
+            {
+                if (Bits != 0)
+                    return true;
+            }
+            return false;
         }
+
+        /// Calls Handler(StartSlot, SlotCount) for every range of slots that needs to be set.
+        template <typename HandlerType>
+        void ProcessRanges(HandlerType Handler) const
+        {
+            for (UINT StartSlot = FindNextSlot(0, true); StartSlot < NumSlots;)
+            {
+                UINT EndSlot  = FindNextSlot(StartSlot, false);
+                UINT NextSlot = FindNextSlot(EndSlot, true);
+                while (NextSlot < NumSlots && NextSlot - EndSlot <= MaxCleanSlotsInRange)
+                {
+                    EndSlot  = FindNextSlot(NextSlot, false);
+                    NextSlot = FindNextSlot(EndSlot, true);
+                }
+                Handler(StartSlot, EndSlot - StartSlot);
+                StartSlot = NextSlot;
+            }
+        }
+
+    private:
+        // Returns the first dirty (or clean) slot starting with Slot, or NumSlots if there is no such slot.
+        UINT FindNextSlot(UINT Slot, bool Dirty) const
+        {
+            while (Slot < NumSlots)
+            {
+                auto Bits = Dirty ? m_Bits[Slot / 64] : ~m_Bits[Slot / 64];
+                Bits &= ~Uint64{0} << (Slot % 64);
+                if (Bits != 0)
+                    return (Slot & ~63u) + PlatformMisc::GetLSB(Bits);
+                Slot = (Slot & ~63u) + 64;
+            }
+            return NumSlots;
+        }
+
+        Uint64 m_Bits[NumSlots / 64] = {};
     };
 
     template <D3D11_RESOURCE_RANGE Range>
-    inline MinMaxSlot BindResources(Uint32                                                   ShaderInd,
-                                    typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Resources[],
-                                    const D3D11ShaderResourceCounters&                       BaseBindings) const;
+    inline DirtySlotMask BindResources(Uint32                                                   ShaderInd,
+                                       typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Resources[],
+                                       const D3D11ShaderResourceCounters&                       BaseBindings) const;
 
     template <D3D11_RESOURCE_RANGE Range>
-    inline MinMaxSlot BindResourceViews(Uint32                                                   ShaderInd,
-                                        typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Views[],
-                                        ID3D11Resource*                                          CommittedD3D11Resources[],
-                                        const D3D11ShaderResourceCounters&                       BaseBindings) const;
-
-    inline MinMaxSlot BindCBs(Uint32                             ShaderInd,
-                              ID3D11Buffer*                      CommittedD3D11Resources[],
-                              UINT                               FirstConstants[],
-                              UINT                               NumConstants[],
-                              const D3D11ShaderResourceCounters& BaseBindings) const;
+    inline DirtySlotMask BindResourceViews(Uint32                                                   ShaderInd,
+                                           typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Views[],
+                                           ID3D11Resource*                                          CommittedD3D11Resources[],
+                                           const D3D11ShaderResourceCounters&                       BaseBindings) const;
+
+    inline DirtySlotMask BindCBs(Uint32                             ShaderInd,
+                                 ID3D11Buffer*                      CommittedD3D11Resources[],
+                                 UINT                               FirstConstants[],
+                                 UINT                               NumConstants[],
+                                 const D3D11ShaderResourceCounters& BaseBindings,
+                                 DeviceContextIndex                 CtxId) const;
 
     template <typename BindHandlerType>
     inline void BindDynamicCBs(Uint32                             ShaderInd,
@@ -351,6 +402,7 @@ public:
                                UINT                               FirstConstants[],
                                UINT                               NumConstants[],
                                const D3D11ShaderResourceCounters& BaseBindings,
+                               DeviceContextIndex                 CtxId,
                                BindHandlerType                    BindHandler) const;
 
     enum class StateTransitionMode
@@ -549,7 +601,7 @@ template void ShaderResourceCacheD3D11::TransitionResourceStates<ShaderResourceC
 template void ShaderResourceCacheD3D11::TransitionResourceStates<ShaderResourceCacheD3D11::StateTransitionMode::Verify>(DeviceContextD3D11Impl& Ctx);
 
 template <D3D11_RESOURCE_RANGE Range>
-inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResources(
+inline ShaderResourceCacheD3D11::DirtySlotMask ShaderResourceCacheD3D11::BindResources(
     Uint32                                                   ShaderInd,
     typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Resources[],
     const D3D11ShaderResourceCounters&                       BaseBindings) const
@@ -558,23 +610,23 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResour
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
 
-    MinMaxSlot Slots;
+    DirtySlotMask DirtySlots;
     for (Uint32 res = 0; res < ResCount; ++res)
     {
         const Uint32 Slot = BaseBinding + res;
         if (CommittedD3D11Resources[Slot] != ResArrays.second[res])
-            Slots.Add(Slot);
+            DirtySlots.Set(Slot);
 
         VERIFY_EXPR(ResArrays.second[res] != nullptr);
         CommittedD3D11Resources[Slot] = ResArrays.second[res];
     }
 
-    return Slots;
+    return DirtySlots;
 }
 
 
 template <D3D11_RESOURCE_RANGE Range>
-inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResourceViews(
+inline ShaderResourceCacheD3D11::DirtySlotMask ShaderResourceCacheD3D11::BindResourceViews(
     Uint32                                                   ShaderInd,
     typename CachedResourceTraits<Range>::D3D11ResourceType* CommittedD3D11Views[],
     ID3D11Resource*                                          CommittedD3D11Resources[],
@@ -584,27 +636,28 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindResour
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
 
-    MinMaxSlot Slots;
+    DirtySlotMask DirtySlots;
     for (Uint32 res = 0; res < ResCount; ++res)
     {
         const Uint32 Slot = BaseBinding + res;
         if (CommittedD3D11Views[Slot] != ResArrays.second[res])
-            Slots.Add(Slot);
+            DirtySlots.Set(Slot);
 
         VERIFY_EXPR(ResArrays.second[res] != nullptr);
         CommittedD3D11Resources[Slot] = ResArrays.first[res].pd3d11Resource;
         CommittedD3D11Views[Slot]     = ResArrays.second[res];
     }
 
-    return Slots;
+    return DirtySlots;
 }
 
-inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
+inline ShaderResourceCacheD3D11::DirtySlotMask ShaderResourceCacheD3D11::BindCBs(
     Uint32                             ShaderInd,
     ID3D11Buffer*                      CommittedD3D11Resources[],
     UINT                               FirstConstants[],
     UINT                               NumConstants[],
-    const D3D11ShaderResourceCounters& BaseBindings) const
+    const D3D11ShaderResourceCounters& BaseBindings,
+    DeviceContextIndex                 CtxId) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
 
@@ -612,22 +665,26 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
     const auto   ResArrays   = GetConstResourceArrays<Range>(ShaderInd);
     const Uint32 BaseBinding = BaseBindings[Range][ShaderInd];
 
-    MinMaxSlot Slots;
+    DirtySlotMask DirtySlots;
     for (Uint32 res = 0; res < ResCount; ++res)
     {
-        const Uint32 Slot     = BaseBinding + res;
-        auto* const  pd3d11CB = ResArrays.second[res];
+        const Uint32 Slot       = BaseBinding + res;
+        const auto&  CB         = ResArrays.first[res];
+        Uint32       RingOffset = 0;
+        auto* const  pd3d11CB   = CB.pBuff && CB.pBuff->IsRingSuballocated() ?
+            CB.pBuff->GetD3D11Buffer(CtxId, RingOffset) :
+            ResArrays.second[res];
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = (ResArrays.first[res].BaseOffset + ResArrays.first[res].DynamicOffset) / 16u;
+        const auto FirstCBConstant = (RingOffset + CB.BaseOffset + CB.DynamicOffset) / 16u;
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
-        const auto NumCBConstants = AlignUp(ResArrays.first[res].RangeSize / 16u, 16u);
+        const auto NumCBConstants = AlignUp(CB.RangeSize / 16u, 16u);
         // clang-format off
         if (CommittedD3D11Resources[Slot] != pd3d11CB        ||
             FirstConstants[Slot]          != FirstCBConstant ||
             NumConstants[Slot]            != NumCBConstants)
         // clang-format on
         {
-            Slots.Add(Slot);
+            DirtySlots.Set(Slot);
         }
 
         VERIFY_EXPR(pd3d11CB != nullptr);
@@ -636,7 +693,7 @@ inline ShaderResourceCacheD3D11::MinMaxSlot ShaderResourceCacheD3D11::BindCBs(
         NumConstants[Slot]            = NumCBConstants;
     }
 
-    return Slots;
+    return DirtySlots;
 }
 
 template <typename BindHandlerType>
@@ -645,6 +702,7 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
                                                      UINT                               FirstConstants[],
                                                      UINT                               NumConstants[],
                                                      const D3D11ShaderResourceCounters& BaseBindings,
+                                                     DeviceContextIndex                 CtxId,
                                                      BindHandlerType                    BindHandler) const
 {
     constexpr auto Range = D3D11_RESOURCE_RANGE_CBV;
@@ -660,9 +718,12 @@ inline void ShaderResourceCacheD3D11::BindDynamicCBs(Uint32
         const Uint32 Slot = BaseBinding + Binding;
         const auto&  CB   = ResArrays.first[Binding];
         VERIFY_EXPR(CB.AllowsDynamicOffset() && (m_DynamicCBSlotsMask[ShaderInd] & CBBit) != 0);
-        auto* const pd3d11CB = ResArrays.second[Binding];
+        Uint32      RingOffset = 0;
+        auto* const pd3d11CB   = CB.pBuff->IsRingSuballocated() ?
+            CB.pBuff->GetD3D11Buffer(CtxId, RingOffset) :
+            ResArrays.second[Binding];
         // Offsets in Direct3D11 are measure in float4 constants.
-        const auto FirstCBConstant = (CB.BaseOffset + CB.DynamicOffset) / 16u;
+        const auto FirstCBConstant = (RingOffset + CB.BaseOffset + CB.DynamicOffset) / 16u;
         // The number of constants must be a multiple of 16 constants. It is OK if it is past the end of the buffer.
         const auto NumCBConstants = AlignUp(CB.RangeSize / 16u, 16u);
         // clang-format off
@@ -77,6 +77,7 @@ public:
 
     const PipelineResourceDesc& GetResourceDesc(Uint32 Index) const;
     const ResourceAttribs&      GetResourceAttribs(Uint32 Index) const;
+    size_t                      GetResourceNameHash(Uint32 Index) const;
 
 
     template <typename ThisImplType, D3D11_RESOURCE_RANGE ResRange>
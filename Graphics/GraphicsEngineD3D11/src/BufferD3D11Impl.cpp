@@ -126,6 +126,13 @@ BufferD3D11Impl::BufferD3D11Impl(IReferenceCounters*        pRefCounters,
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to set buffer name");
     }
 
+    if (m_Desc.Usage == USAGE_DYNAMIC && m_Desc.BindFlags == BIND_UNIFORM_BUFFER && pRenderDeviceD3D11->GetDynamicConstantRingSize() != 0)
+    {
+        // Dynamic constant buffers may be suballocated from the device context's ring when mapped with MAP_FLAG_DISCARD.
+        // The buffer's own D3D11 buffer is still used when the allocation does not fit into the ring.
+        m_RingAllocations.resize(pRenderDeviceD3D11->GetNumImmediateContexts() + pRenderDeviceD3D11->GetNumDeferredContexts());
+    }
+
     SetState(RESOURCE_STATE_UNDEFINED);
 
     // The memory is always coherent in Direct3D11
@@ -63,15 +63,20 @@ DeviceContextD3D11Impl::DeviceContextD3D11Impl(IReferenceCounters*          pRef
     m_CmdListAllocator    {GetRawAllocator(), sizeof(CommandListD3D11Impl), 64}
 // clang-format on
 {
+    if (const auto RingSize = pDevice->GetDynamicConstantRingSize())
+    {
+        m_pDynamicConstantRing = std::make_unique<DynamicConstantRingD3D11>(pDevice->GetD3D11Device(), RingSize);
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextD3D11Impl, IID_DeviceContextD3D11, TDeviceContextBase)
 
 
-void DeviceContextD3D11Impl::Begin(Uint32 ImmediateContextId)
+void DeviceContextD3D11Impl::Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags)
 {
     DEV_CHECK_ERR(ImmediateContextId == 0, "Direct3D11 supports only one immediate context");
-    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
+    // ID3D11CommandList can be executed any number of times, so reusable command lists need no special handling
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS, Flags);
 }
 
 void DeviceContextD3D11Impl::SetPipelineState(IPipelineState* pPipelineState)
@@ -253,14 +258,17 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
             auto* d3d11CBs       = m_CommittedRes.d3d11CBs[ShaderInd];
             auto* FirstConstants = m_CommittedRes.CBFirstConstants[ShaderInd];
             auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
-            if (auto Slots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings))
+            if (auto DirtySlots = ResourceCache.BindCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, GetContextId()))
             {
                 auto SetCB1Method = SetCB1Methods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetCB1Method)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1,
-                                                       d3d11CBs + Slots.MinSlot,
-                                                       FirstConstants + Slots.MinSlot,
-                                                       NumConstants + Slots.MinSlot);
-                m_CommittedRes.NumCBs[ShaderInd] = std::max(m_CommittedRes.NumCBs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+                DirtySlots.ProcessRanges([&](UINT StartSlot, UINT SlotCount) //
+                                         {
+                                             (m_pd3d11DeviceContext->*SetCB1Method)(StartSlot, SlotCount,
+                                                                                    d3d11CBs + StartSlot,
+                                                                                    FirstConstants + StartSlot,
+                                                                                    NumConstants + StartSlot);
+                                             m_CommittedRes.NumCBs[ShaderInd] = std::max(m_CommittedRes.NumCBs[ShaderInd], static_cast<Uint8>(StartSlot + SlotCount));
+                                         });
             }
 #ifdef DILIGENT_DEVELOPMENT
             if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -274,11 +282,14 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
         {
             auto* d3d11SRVs   = m_CommittedRes.d3d11SRVs[ShaderInd];
             auto* d3d11SRVRes = m_CommittedRes.d3d11SRVResources[ShaderInd];
-            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings))
+            if (auto DirtySlots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_SRV>(ShaderInd, d3d11SRVs, d3d11SRVRes, BaseBindings))
             {
                 auto SetSRVMethod = SetSRVMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSRVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11SRVs + Slots.MinSlot);
-                m_CommittedRes.NumSRVs[ShaderInd] = std::max(m_CommittedRes.NumSRVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+                DirtySlots.ProcessRanges([&](UINT StartSlot, UINT SlotCount) //
+                                         {
+                                             (m_pd3d11DeviceContext->*SetSRVMethod)(StartSlot, SlotCount, d3d11SRVs + StartSlot);
+                                             m_CommittedRes.NumSRVs[ShaderInd] = std::max(m_CommittedRes.NumSRVs[ShaderInd], static_cast<Uint8>(StartSlot + SlotCount));
+                                         });
             }
 #ifdef DILIGENT_DEVELOPMENT
             if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -291,11 +302,14 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
         if (ResourceCache.GetSamplerCount(ShaderInd) > 0)
         {
             auto* d3d11Samplers = m_CommittedRes.d3d11Samplers[ShaderInd];
-            if (auto Slots = ResourceCache.BindResources<D3D11_RESOURCE_RANGE_SAMPLER>(ShaderInd, d3d11Samplers, BaseBindings))
+            if (auto DirtySlots = ResourceCache.BindResources<D3D11_RESOURCE_RANGE_SAMPLER>(ShaderInd, d3d11Samplers, BaseBindings))
             {
                 auto SetSamplerMethod = SetSamplerMethods[ShaderInd];
-                (m_pd3d11DeviceContext->*SetSamplerMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11Samplers + Slots.MinSlot);
-                m_CommittedRes.NumSamplers[ShaderInd] = std::max(m_CommittedRes.NumSamplers[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+                DirtySlots.ProcessRanges([&](UINT StartSlot, UINT SlotCount) //
+                                         {
+                                             (m_pd3d11DeviceContext->*SetSamplerMethod)(StartSlot, SlotCount, d3d11Samplers + StartSlot);
+                                             m_CommittedRes.NumSamplers[ShaderInd] = std::max(m_CommittedRes.NumSamplers[ShaderInd], static_cast<Uint8>(StartSlot + SlotCount));
+                                         });
             }
 #ifdef DILIGENT_DEVELOPMENT
             if (m_D3D11ValidationFlags & D3D11_VALIDATION_FLAG_VERIFY_COMMITTED_RESOURCE_RELEVANCE)
@@ -312,7 +326,7 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
 
             auto* d3d11UAVs   = m_CommittedRes.d3d11UAVs[ShaderInd];
             auto* d3d11UAVRes = m_CommittedRes.d3d11UAVResources[ShaderInd];
-            if (auto Slots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_UAV>(ShaderInd, d3d11UAVs, d3d11UAVRes, BaseBindings))
+            if (auto DirtySlots = ResourceCache.BindResourceViews<D3D11_RESOURCE_RANGE_UAV>(ShaderInd, d3d11UAVs, d3d11UAVRes, BaseBindings))
             {
                 if (ShaderInd == PSInd)
                 {
@@ -322,8 +336,11 @@ void DeviceContextD3D11Impl::BindCacheResources(const ShaderResourceCacheD3D11&
                 {
                     // This can only be CS
                     auto SetUAVMethod = SetUAVMethods[ShaderInd];
-                    (m_pd3d11DeviceContext->*SetUAVMethod)(Slots.MinSlot, Slots.MaxSlot - Slots.MinSlot + 1, d3d11UAVs + Slots.MinSlot, nullptr);
-                    m_CommittedRes.NumUAVs[ShaderInd] = std::max(m_CommittedRes.NumUAVs[ShaderInd], static_cast<Uint8>(Slots.MaxSlot + 1));
+                    DirtySlots.ProcessRanges([&](UINT StartSlot, UINT SlotCount) //
+                                             {
+                                                 (m_pd3d11DeviceContext->*SetUAVMethod)(StartSlot, SlotCount, d3d11UAVs + StartSlot, nullptr);
+                                                 m_CommittedRes.NumUAVs[ShaderInd] = std::max(m_CommittedRes.NumUAVs[ShaderInd], static_cast<Uint8>(StartSlot + SlotCount));
+                                             });
                 }
                 else
                 {
@@ -357,7 +374,7 @@ void DeviceContextD3D11Impl::BindDynamicCBs(const ShaderResourceCacheD3D11&    R
         auto* NumConstants   = m_CommittedRes.CBNumConstants[ShaderInd];
         auto  SetCB1Method   = SetCB1Methods[ShaderInd];
 
-        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings,
+        ResourceCache.BindDynamicCBs(ShaderInd, d3d11CBs, FirstConstants, NumConstants, BaseBindings, GetContextId(),
                                      [&](Uint32 Slot) //
                                      {
                                          (m_pd3d11DeviceContext->*SetCB1Method)(Slot, 1, d3d11CBs + Slot, FirstConstants + Slot, NumConstants + Slot);
@@ -463,7 +480,7 @@ void DeviceContextD3D11Impl::BindShaderResources(Uint32 BindSRBMask)
 #ifdef DILIGENT_DEVELOPMENT
 void DeviceContextD3D11Impl::DvpValidateCommittedShaderResources()
 {
-    if (m_BindInfo.ResourcesValidated)
+    if (m_BindInfo.ResourcesValidated || !m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_RESOURCE_BINDING))
         return;
 
     DvpVerifySRBCompatibility(m_BindInfo);
@@ -499,6 +516,15 @@ void DeviceContextD3D11Impl::SetBlendFactors(const float* pBlendFactors)
     }
 }
 
+void DeviceContextD3D11Impl::SetDynamicStates(const DynamicStateAttribs& Attribs)
+{
+    if (TDeviceContextBase::SetDynamicStates(Attribs, 0))
+    {
+        // Pipelines with dynamic states can't be created when DynamicPipelineStates feature is disabled
+        UNEXPECTED("Dynamic pipeline states are not supported in this backend");
+    }
+}
+
 void DeviceContextD3D11Impl::CommitD3D11IndexBuffer(VALUE_TYPE IndexType)
 {
     DEV_CHECK_ERR(m_pIndexBuffer, "Index buffer is not set up for indexed draw command");
@@ -537,7 +563,7 @@ void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pP
     for (UINT Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
         auto&         CurrStream     = m_VertexStreams[Slot];
-        auto*         pBuffD3D11Impl = CurrStream.pBuffer.RawPtr();
+        auto*         pBuffD3D11Impl = CurrStream.pBuffer;
         ID3D11Buffer* pd3d11Buffer   = pBuffD3D11Impl ? pBuffD3D11Impl->m_pd3d11Buffer : nullptr;
         auto          Stride         = pPipelineStateD3D11->GetBufferStride(Slot);
         auto          Offset         = CurrStream.Offset;
@@ -579,6 +605,8 @@ void DeviceContextD3D11Impl::CommitD3D11VertexBuffers(PipelineStateD3D11Impl* pP
 
 void DeviceContextD3D11Impl::PrepareForDraw(DRAW_FLAGS Flags)
 {
+    UnmapDynamicConstantRing();
+
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
@@ -601,7 +629,7 @@ void DeviceContextD3D11Impl::PrepareForDraw(DRAW_FLAGS Flags)
     {
         for (UINT Slot = 0; Slot < m_NumVertexStreams; ++Slot)
         {
-            if (auto* pBuffD3D11Impl = m_VertexStreams[Slot].pBuffer.RawPtr())
+            if (auto* pBuffD3D11Impl = m_VertexStreams[Slot].pBuffer)
             {
                 if (pBuffD3D11Impl->IsInKnownState() && pBuffD3D11Impl->CheckState(RESOURCE_STATE_UNORDERED_ACCESS))
                 {
@@ -659,6 +687,7 @@ void DeviceContextD3D11Impl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE
 void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 {
     DvpVerifyDrawArguments(Attribs);
+    CountDrawCommand();
 
     PrepareForDraw(Attribs.Flags);
 
@@ -671,6 +700,7 @@ void DeviceContextD3D11Impl::Draw(const DrawAttribs& Attribs)
 void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
     DvpVerifyDrawIndexedArguments(Attribs);
+    CountDrawCommand();
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
@@ -683,24 +713,43 @@ void DeviceContextD3D11Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 void DeviceContextD3D11Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     PrepareForDraw(Attribs.Flags);
 
     auto*         pIndirectDrawAttribsD3D11 = ValidatedCast<BufferD3D11Impl>(pAttribsBuffer);
     ID3D11Buffer* pd3d11ArgsBuff            = pIndirectDrawAttribsD3D11->m_pd3d11Buffer;
-    m_pd3d11DeviceContext->DrawInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
+    // Direct3D11 has no native multi-draw indirect, so issue one command per draw
+    for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+        m_pd3d11DeviceContext->DrawInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset + draw * Attribs.DrawArgsStride);
 }
 
 
 void DeviceContextD3D11Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
     auto*         pIndirectDrawAttribsD3D11 = ValidatedCast<BufferD3D11Impl>(pAttribsBuffer);
     ID3D11Buffer* pd3d11ArgsBuff            = pIndirectDrawAttribsD3D11->m_pd3d11Buffer;
-    m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset);
+    for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+        m_pd3d11DeviceContext->DrawIndexedInstancedIndirect(pd3d11ArgsBuff, Attribs.IndirectDrawArgsOffset + draw * Attribs.DrawArgsStride);
+}
+
+void DeviceContextD3D11Impl::DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    UNSUPPORTED("DrawIndirectCount is not supported in DirectX 11");
+}
+
+void DeviceContextD3D11Impl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    UNSUPPORTED("DrawIndexedIndirectCount is not supported in DirectX 11");
 }
 
 void DeviceContextD3D11Impl::DrawMesh(const DrawMeshAttribs& Attribs)
@@ -721,6 +770,9 @@ void DeviceContextD3D11Impl::DrawMeshIndirectCount(const DrawMeshIndirectCountAt
 void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     DvpVerifyDispatchArguments(Attribs);
+    CountDispatchCommand();
+
+    UnmapDynamicConstantRing();
 
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
@@ -749,6 +801,9 @@ void DeviceContextD3D11Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 void DeviceContextD3D11Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer);
+    CountDispatchCommand();
+
+    UnmapDynamicConstantRing();
 
     if (Uint32 BindSRBMask = m_BindInfo.GetCommitMask())
     {
@@ -818,6 +873,7 @@ void DeviceContextD3D11Impl::ClearRenderTarget(ITextureView* pView, const float*
 void DeviceContextD3D11Impl::Flush()
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
+    UnmapDynamicConstantRing();
     m_pd3d11DeviceContext->Flush();
 }
 
@@ -862,7 +918,17 @@ void DeviceContextD3D11Impl::CopyBuffer(IBuffer*                       pSrcBuffe
     SrcBox.bottom = 1;
     SrcBox.front  = 0;
     SrcBox.back   = 1;
-    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, DstOffset, 0, 0, pSrcBufferD3D11Impl->m_pd3d11Buffer, 0, &SrcBox);
+
+    // The source data may reside in the dynamic constant ring
+    Uint32 SrcRingOffset = 0;
+    auto*  pd3d11SrcBuff = pSrcBufferD3D11Impl->GetD3D11Buffer(GetContextId(), SrcRingOffset);
+    if (pd3d11SrcBuff != pSrcBufferD3D11Impl->m_pd3d11Buffer)
+    {
+        UnmapDynamicConstantRing();
+        SrcBox.left += SrcRingOffset;
+        SrcBox.right += SrcRingOffset;
+    }
+    m_pd3d11DeviceContext->CopySubresourceRegion(pDstBufferD3D11Impl->m_pd3d11Buffer, 0, DstOffset, 0, 0, pd3d11SrcBuff, 0, &SrcBox);
 }
 
 
@@ -870,7 +936,38 @@ void DeviceContextD3D11Impl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_F
 {
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
 
-    auto*     pBufferD3D11  = ValidatedCast<BufferD3D11Impl>(pBuffer);
+    auto* pBufferD3D11 = ValidatedCast<BufferD3D11Impl>(pBuffer);
+    if (pBufferD3D11->IsRingSuballocated())
+    {
+        VERIFY_EXPR(m_pDynamicConstantRing);
+        VERIFY(MapType == MAP_WRITE, "Dynamic constant buffers can only be mapped for writing");
+        auto& RingAlloc = pBufferD3D11->m_RingAllocations[GetContextId()];
+        if ((MapFlags & MAP_FLAG_NO_OVERWRITE) != 0 && RingAlloc.pd3d11Buffer != nullptr)
+        {
+            DEV_CHECK_ERR(RingAlloc.Generation == m_pDynamicConstantRing->GetGeneration(),
+                          "Dynamic buffer '", pBufferD3D11->GetDesc().Name, "' has not been mapped with MAP_FLAG_DISCARD in this frame");
+            pMappedData = m_pDynamicConstantRing->GetCPUAddress(m_pd3d11DeviceContext, RingAlloc.Offset);
+            return;
+        }
+
+        if ((MapFlags & MAP_FLAG_DISCARD) != 0)
+        {
+            auto Alloc = m_pDynamicConstantRing->Allocate(m_pd3d11DeviceContext, pBufferD3D11->GetDesc().uiSizeInBytes);
+            if (Alloc.pd3d11Buffer != nullptr)
+            {
+                RingAlloc.pd3d11Buffer = Alloc.pd3d11Buffer;
+                RingAlloc.Offset       = Alloc.Offset;
+                RingAlloc.Generation   = Alloc.Generation;
+
+                pMappedData = Alloc.pCPUAddress;
+                return;
+            }
+        }
+
+        // The ring is exhausted - use the buffer's own storage
+        RingAlloc = {};
+    }
+
     D3D11_MAP d3d11MapType  = static_cast<D3D11_MAP>(0);
     UINT      d3d11MapFlags = 0;
     MapParamsToD3D11MapParams(MapType, MapFlags, d3d11MapType, d3d11MapFlags);
@@ -889,6 +986,11 @@ void DeviceContextD3D11Impl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     auto* pBufferD3D11 = ValidatedCast<BufferD3D11Impl>(pBuffer);
+    if (pBufferD3D11->IsRingSuballocated() && pBufferD3D11->m_RingAllocations[GetContextId()].pd3d11Buffer != nullptr)
+    {
+        // The ring stays mapped until the next command that reads from it
+        return;
+    }
     m_pd3d11DeviceContext->Unmap(pBufferD3D11->m_pd3d11Buffer, 0);
 }
 
@@ -937,6 +1039,21 @@ void DeviceContextD3D11Impl::UpdateTexture(ITexture*                      pTextu
     m_pd3d11DeviceContext->UpdateSubresource(pTexD3D11->GetD3D11Texture(), SubresIndex, &D3D11Box, SubresData.pData, SubresData.Stride, SubresData.DepthStride);
 }
 
+void DeviceContextD3D11Impl::UpdateTextureRegions(ITexture*                      pTexture,
+                                                  const TextureRegionUpdate*     pUpdates,
+                                                  Uint32                         NumUpdates,
+                                                  RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TDeviceContextBase::UpdateTextureRegions(pTexture, pUpdates, NumUpdates, TextureTransitionMode);
+
+    // UpdateSubresource() updates one box at a time
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        UpdateTexture(pTexture, Update.MipLevel, Update.Slice, Update.DstBox, Update.SrcData, RESOURCE_STATE_TRANSITION_MODE_NONE, TextureTransitionMode);
+    }
+}
+
 void DeviceContextD3D11Impl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
     TDeviceContextBase::CopyTexture(CopyAttribs);
@@ -1012,6 +1129,13 @@ void DeviceContextD3D11Impl::GenerateMips(ITextureView* pTextureView)
     m_pd3d11DeviceContext->GenerateMips(pd3d11SRV);
 }
 
+void DeviceContextD3D11Impl::GenerateMipsBatch(ITextureView* ppTextureViews[], Uint32 NumViews)
+{
+    // Direct3D11 generates mips for one view at a time
+    for (Uint32 i = 0; i < NumViews; ++i)
+        GenerateMips(ppTextureViews[i]);
+}
+
 void DeviceContextD3D11Impl::FinishFrame()
 {
     if (m_ActiveDisjointQuery)
@@ -1021,6 +1145,13 @@ void DeviceContextD3D11Impl::FinishFrame()
         m_ActiveDisjointQuery.reset();
     }
 
+    if (m_pDynamicConstantRing)
+    {
+        // Contents of dynamic constant buffers is discarded at the end of every frame
+        m_pDynamicConstantRing->Unmap(m_pd3d11DeviceContext);
+        m_pDynamicConstantRing->Reset();
+    }
+
     TDeviceContextBase::EndFrame();
 }
 
@@ -1035,7 +1166,7 @@ void DeviceContextD3D11Impl::SetVertexBuffers(Uint32                         Sta
     for (Uint32 Slot = 0; Slot < m_NumVertexStreams; ++Slot)
     {
         auto& CurrStream = m_VertexStreams[Slot];
-        if (auto* pBuffD3D11Impl = CurrStream.pBuffer.RawPtr())
+        if (auto* pBuffD3D11Impl = CurrStream.pBuffer)
         {
             if (StateTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
             {
@@ -1717,6 +1848,13 @@ void DeviceContextD3D11Impl::FinishCommandList(ICommandList** ppCommandList)
     DEV_CHECK_ERR(IsDeferred(), "Only deferred contexts can record command list");
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
 
+    if (m_pDynamicConstantRing)
+    {
+        // The first map of the ring in the next command list must use D3D11_MAP_WRITE_DISCARD
+        m_pDynamicConstantRing->Unmap(m_pd3d11DeviceContext);
+        m_pDynamicConstantRing->Reset();
+    }
+
     CComPtr<ID3D11CommandList> pd3d11CmdList;
     m_pd3d11DeviceContext->FinishCommandList(
         FALSE, // A Boolean flag that determines whether the runtime saves deferred context state before it
@@ -1761,6 +1899,8 @@ void DeviceContextD3D11Impl::ExecuteCommandLists(Uint32               NumCommand
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
+    UnmapDynamicConstantRing();
+
     for (Uint32 i = 0; i < NumCommandLists; ++i)
     {
         auto* pCmdListD3D11 = ValidatedCast<CommandListD3D11Impl>(ppCommandLists[i]);
@@ -1883,6 +2023,25 @@ void DeviceContextD3D11Impl::EndQuery(IQuery* pQuery)
     m_pd3d11DeviceContext->End(pQueryD3D11Impl->GetD3D11Query(QueryType == QUERY_TYPE_DURATION ? 1 : 0));
 }
 
+void DeviceContextD3D11Impl::BeginConditionalRendering(IQuery* pQuery)
+{
+    TDeviceContextBase::BeginConditionalRendering(pQuery, 0);
+
+    auto* const pQueryD3D11Impl = ValidatedCast<QueryD3D11Impl>(pQuery);
+    // Binary occlusion queries are created as D3D11_QUERY_OCCLUSION_PREDICATE
+    CComQIPtr<ID3D11Predicate> pd3d11Predicate{pQueryD3D11Impl->GetD3D11Query(0)};
+    VERIFY(pd3d11Predicate, "Failed to query ID3D11Predicate interface from the binary occlusion query");
+    // Commands are skipped when the predicate is FALSE, i.e. when no samples passed
+    m_pd3d11DeviceContext->SetPredication(pd3d11Predicate, FALSE);
+}
+
+void DeviceContextD3D11Impl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    m_pd3d11DeviceContext->SetPredication(nullptr, FALSE);
+}
+
 void DeviceContextD3D11Impl::ClearStateCache()
 {
     TDeviceContextBase::ClearStateCache();
@@ -1970,6 +2129,7 @@ void DeviceContextD3D11Impl::InvalidateState()
 void DeviceContextD3D11Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    CountStateTransitions(BarrierCount);
 
     for (Uint32 i = 0; i < BarrierCount; ++i)
     {
@@ -2137,6 +2297,11 @@ void DeviceContextD3D11Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     UNSUPPORTED("BuildTLAS is not supported in DirectX 11");
 }
 
+void DeviceContextD3D11Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in DirectX 11");
+}
+
 void DeviceContextD3D11Impl::CopyBLAS(const CopyBLASAttribs& Attribs)
 {
     UNSUPPORTED("CopyBLAS is not supported in DirectX 11");
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "DynamicConstantRingD3D11.hpp"
+
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+DynamicConstantRingD3D11::DynamicConstantRingD3D11(ID3D11Device* pd3d11Device, Uint32 Size) :
+    m_Size{AlignUp(Size, OffsetAlignment)}
+{
+    D3D11_BUFFER_DESC D3D11BuffDesc{};
+    D3D11BuffDesc.ByteWidth      = m_Size;
+    D3D11BuffDesc.Usage          = D3D11_USAGE_DYNAMIC;
+    D3D11BuffDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    D3D11BuffDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    CHECK_D3D_RESULT_THROW(pd3d11Device->CreateBuffer(&D3D11BuffDesc, nullptr, &m_pd3d11Buffer),
+                           "Failed to create dynamic constant ring buffer");
+}
+
+bool DynamicConstantRingD3D11::Map(ID3D11DeviceContext* pd3d11Ctx, D3D11_MAP MapType)
+{
+    VERIFY_EXPR(m_pMappedData == nullptr);
+
+    D3D11_MAPPED_SUBRESOURCE MappedBuff{};
+
+    auto hr = pd3d11Ctx->Map(m_pd3d11Buffer, 0, MapType, 0, &MappedBuff);
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to map dynamic constant ring buffer");
+        return false;
+    }
+    m_pMappedData = static_cast<Uint8*>(MappedBuff.pData);
+    return true;
+}
+
+DynamicConstantRingD3D11::Allocation DynamicConstantRingD3D11::Allocate(ID3D11DeviceContext* pd3d11Ctx, Uint32 Size)
+{
+    const auto AlignedSize = AlignUp(Size, OffsetAlignment);
+    if (AlignedSize > m_Size - m_CurrOffset)
+        return {};
+
+    if (m_NeedsDiscard)
+    {
+        // Let the driver rename the buffer while the GPU may still be reading the previous frame's data
+        Unmap(pd3d11Ctx);
+        if (!Map(pd3d11Ctx, D3D11_MAP_WRITE_DISCARD))
+            return {};
+        m_NeedsDiscard = false;
+    }
+    else if (m_pMappedData == nullptr)
+    {
+        // The region past the current offset has not been used since the last discard
+        if (!Map(pd3d11Ctx, D3D11_MAP_WRITE_NO_OVERWRITE))
+            return {};
+    }
+
+    Allocation Alloc;
+    Alloc.pd3d11Buffer = m_pd3d11Buffer;
+    Alloc.Offset       = m_CurrOffset;
+    Alloc.pCPUAddress  = m_pMappedData + m_CurrOffset;
+    Alloc.Generation   = m_Generation;
+
+    m_CurrOffset += AlignedSize;
+
+    return Alloc;
+}
+
+void* DynamicConstantRingD3D11::GetCPUAddress(ID3D11DeviceContext* pd3d11Ctx, Uint32 Offset)
+{
+    VERIFY_EXPR(Offset < m_CurrOffset && !m_NeedsDiscard);
+    if (m_pMappedData == nullptr)
+    {
+        if (!Map(pd3d11Ctx, D3D11_MAP_WRITE_NO_OVERWRITE))
+            return nullptr;
+    }
+    return m_pMappedData + Offset;
+}
+
+} // namespace Diligent
@@ -40,6 +40,7 @@
 #include "D3D11TypeConversions.hpp"
 #include "EngineMemory.h"
 #include "EngineFactoryD3DBase.hpp"
+#include "Timer.hpp"
 
 namespace Diligent
 {
@@ -171,6 +172,10 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
     *ppDevice = nullptr;
     memset(ppContexts, 0, sizeof(*ppContexts) * (std::max(1u, EngineCI.NumImmediateContexts) + EngineCI.NumDeferredContexts));
 
+    Timer                InitTimer;
+    Timer                PhaseTimer;
+    DeviceInitStatistics InitStats;
+
     // This flag adds support for surfaces with a different color channel ordering
     // than the API default. It is required for compatibility with Direct2D.
     // D3D11_CREATE_DEVICE_BGRA_SUPPORT;
@@ -196,6 +201,9 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
         }
     }
 
+    InitStats.InstanceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+    PhaseTimer.Restart();
+
     // Create the Direct3D 11 API device object and a corresponding context.
     CComPtr<ID3D11Device>        pd3d11Device;
     CComPtr<ID3D11DeviceContext> pd3d11Context;
@@ -225,7 +233,21 @@ void EngineFactoryD3D11Impl::CreateDeviceAndContextsD3D11(const EngineD3D11Creat
     if (!pd3d11Device)
         LOG_ERROR_AND_THROW("Failed to create d3d11 device and immediate context");
 
+    InitStats.DeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+
     AttachToD3D11Device(pd3d11Device, pd3d11Context, EngineCI, ppDevice, ppContexts);
+
+    if (*ppDevice != nullptr)
+    {
+        // AttachToD3D11Device() only knows the time of the render device and context initialization
+        auto* pRenderDeviceD3D11 = ValidatedCast<RenderDeviceD3D11Impl>(*ppDevice);
+
+        const auto& AttachStats    = pRenderDeviceD3D11->GetDeviceInfo().InitStats;
+        InitStats.RenderDeviceTime = AttachStats.RenderDeviceTime;
+        InitStats.ContextsTime     = AttachStats.ContextsTime;
+        InitStats.TotalTime        = InitTimer.GetElapsedTimef() * 1000.f;
+        pRenderDeviceD3D11->SetInitStatistics(InitStats);
+    }
 }
 
 
@@ -300,12 +322,18 @@ void EngineFactoryD3D11Impl::AttachToD3D11Device(void*                        pd
         SetRawAllocator(EngineCI.pRawMemAllocator);
         auto& RawAlloctor = GetRawAllocator();
 
+        Timer                PhaseTimer;
+        DeviceInitStatistics InitStats;
+
         RenderDeviceD3D11Impl* pRenderDeviceD3D11{
             NEW_RC_OBJ(RawAlloctor, "RenderDeviceD3D11Impl instance", RenderDeviceD3D11Impl)(
                 RawAlloctor, this, EngineCI, AdapterInfo, pd3d11Device) //
         };
         pRenderDeviceD3D11->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        InitStats.RenderDeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         CComQIPtr<ID3D11DeviceContext1> pd3d11ImmediateCtx1{pd3d11ImmediateCtx};
         if (!pd3d11ImmediateCtx1)
             LOG_ERROR_AND_THROW("Failed to get ID3D11DeviceContext1 interface from device context");
@@ -326,6 +354,12 @@ void EngineFactoryD3D11Impl::AttachToD3D11Device(void*                        pd
         pDeviceContextD3D11->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts));
         pRenderDeviceD3D11->SetImmediateContext(0, pDeviceContextD3D11);
 
+        if (EngineCI.NumDeferredContexts > 0 && (AdapterInfo.CommandList.CapFlags & COMMAND_LIST_CAP_FLAG_NATIVE_COMMAND_LISTS) == 0)
+        {
+            LOG_INFO_MESSAGE("The driver does not support native command lists. Deferred contexts will be emulated by the Direct3D11 runtime, "
+                             "which may make multithreaded recording slower than recording in the immediate context.");
+        }
+
         for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
         {
             CComPtr<ID3D11DeviceContext> pd3d11DeferredCtx;
@@ -352,6 +386,10 @@ void EngineFactoryD3D11Impl::AttachToD3D11Device(void*                        pd
             pDeferredCtxD3D11->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + 1 + DeferredCtx));
             pRenderDeviceD3D11->SetDeferredContext(DeferredCtx, pDeferredCtxD3D11);
         }
+
+        InitStats.ContextsTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        InitStats.TotalTime    = InitStats.RenderDeviceTime + InitStats.ContextsTime;
+        pRenderDeviceD3D11->SetInitStatistics(InitStats);
     }
     catch (const std::runtime_error&)
     {
@@ -481,6 +519,36 @@ GraphicsAdapterInfo EngineFactoryD3D11Impl::GetGraphicsAdapterInfo(void*
 #endif
     }
 
+    // Draw command properties
+    {
+        auto& DrawCommandProps{AdapterInfo.DrawCommand};
+        // Multiple indirect draws are emulated by issuing a separate command for every draw
+        DrawCommandProps.CapFlags             = DRAW_COMMAND_CAP_FLAG_NONE;
+        DrawCommandProps.MaxDrawIndirectCount = ~0u;
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(DrawCommandProps) == 8, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
+#endif
+    }
+
+    // Command list properties
+    {
+        auto& CmdListProps{AdapterInfo.CommandList};
+        CmdListProps.CapFlags = COMMAND_LIST_CAP_FLAG_NONE;
+
+        D3D11_FEATURE_DATA_THREADING d3d11ThreadingSupport{};
+        if (SUCCEEDED(pd3d11Device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &d3d11ThreadingSupport, sizeof(d3d11ThreadingSupport))))
+        {
+            // When the driver does not support command lists, the runtime emulates them
+            if (d3d11ThreadingSupport.DriverCommandLists)
+                CmdListProps.CapFlags |= COMMAND_LIST_CAP_FLAG_NATIVE_COMMAND_LISTS;
+            if (d3d11ThreadingSupport.DriverConcurrentCreates)
+                CmdListProps.CapFlags |= COMMAND_LIST_CAP_FLAG_CONCURRENT_RESOURCE_CREATION;
+        }
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(CmdListProps) == 1, "Did you add a new member to CommandListProperties? Please initialize it here.");
+#endif
+    }
+
     return AdapterInfo;
 }
 
@@ -75,6 +75,12 @@ void ValidatePipelineResourceSignatureDescD3D11(const PipelineResourceSignatureD
                                 "Desc.Resources[", i, "].ShaderStages (", GetShaderStagesString(ResDesc.ShaderStages),
                                 ") is not valid in Direct3D11 as UAVs are only supported in pixel and compute shader stages.");
         }
+
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+        {
+            LOG_ERROR_AND_THROW("Description of a pipeline resource signature '", (Desc.Name ? Desc.Name : ""), "' is invalid: ",
+                                "Desc.Resources[", i, "] ('", ResDesc.Name, "') uses PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag that is not supported in Direct3D11.");
+        }
     }
 }
 
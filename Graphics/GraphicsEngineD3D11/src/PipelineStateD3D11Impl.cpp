@@ -36,7 +36,6 @@
 #include "RenderDeviceD3D11Impl.hpp"
 #include "ShaderResourceBindingD3D11Impl.hpp"
 #include "EngineMemory.h"
-#include "DXBCUtils.hpp"
 
 namespace Diligent
 {
@@ -140,25 +139,28 @@ void PipelineStateD3D11Impl::InitResourceLayouts(const std::vector<ShaderD3D11Im
     m_NumPixelUAVs = ResCounters[D3D11_RESOURCE_RANGE_UAV][PSInd];
 
 #ifdef DILIGENT_DEVELOPMENT
-    for (Uint32 s = 0; s < D3D11ResourceBindPoints::NumShaderTypes; ++s)
+    if (GetDevice()->IsValidationEnabled(VALIDATION_CATEGORY_OBJECT_CREATION))
     {
-        const auto ShaderType = GetShaderTypeFromIndex(s);
-        DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_CBV][s] <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                      "Constant buffer count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_CBV][s]},
-                      " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
-                      D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
-        DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_SRV][s] <= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT,
-                      "SRV count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_SRV][s]},
-                      " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
-                      D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT);
-        DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_SAMPLER][s] <= D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT,
-                      "Sampler count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_SAMPLER][s]},
-                      " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
-                      D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT);
-        DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_UAV][s] <= D3D11_PS_CS_UAV_REGISTER_COUNT,
-                      "UAV count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_UAV][s]},
-                      " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
-                      D3D11_PS_CS_UAV_REGISTER_COUNT);
+        for (Uint32 s = 0; s < D3D11ResourceBindPoints::NumShaderTypes; ++s)
+        {
+            const auto ShaderType = GetShaderTypeFromIndex(s);
+            DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_CBV][s] <= D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
+                          "Constant buffer count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_CBV][s]},
+                          " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
+                          D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT);
+            DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_SRV][s] <= D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT,
+                          "SRV count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_SRV][s]},
+                          " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
+                          D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT);
+            DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_SAMPLER][s] <= D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT,
+                          "Sampler count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_SAMPLER][s]},
+                          " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
+                          D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT);
+            DEV_CHECK_ERR(ResCounters[D3D11_RESOURCE_RANGE_UAV][s] <= D3D11_PS_CS_UAV_REGISTER_COUNT,
+                          "UAV count ", Uint32{ResCounters[D3D11_RESOURCE_RANGE_UAV][s]},
+                          " in ", GetShaderTypeLiteralName(ShaderType), " stage exceeds D3D11 limit ",
+                          D3D11_PS_CS_UAV_REGISTER_COUNT);
+        }
     }
 #endif
 
@@ -167,7 +169,6 @@ void PipelineStateD3D11Impl::InitResourceLayouts(const std::vector<ShaderD3D11Im
     {
         auto* const pShader    = Shaders[s];
         auto const  ShaderType = pShader->GetDesc().ShaderType;
-        auto* const pBytecode  = Shaders[s]->GetBytecode();
 
         ResourceBinding::TMap ResourceMap;
         for (Uint32 sign = 0; sign < m_SignatureCount; ++sign)
@@ -182,12 +183,8 @@ void PipelineStateD3D11Impl::InitResourceLayouts(const std::vector<ShaderD3D11Im
 
         ValidateShaderResources(pShader);
 
-        CComPtr<ID3DBlob> pPatchedBytecode;
-        D3DCreateBlob(pBytecode->GetBufferSize(), &pPatchedBytecode);
-        memcpy(pPatchedBytecode->GetBufferPointer(), pBytecode->GetBufferPointer(), pBytecode->GetBufferSize());
-
-        if (!DXBCUtils::RemapResourceBindings(ResourceMap, pPatchedBytecode->GetBufferPointer(), pPatchedBytecode->GetBufferSize()))
-            LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
+        // Direct3D11 shaders are always DXBC and do not need the DXC compiler
+        auto pPatchedBytecode = pShader->GetRemappedBytecode(ResourceMap, nullptr, pShader->GetDesc().Name);
 
         m_ppd3d11Shaders[s] = pShader->GetD3D11Shader(pPatchedBytecode);
         VERIFY_EXPR(m_ppd3d11Shaders[s]); // GetD3D11Shader() throws an exception in case of an error
@@ -228,50 +225,70 @@ void PipelineStateD3D11Impl::InitInternalObjects(const PSOCreateInfoType& Create
     m_BaseBindings   = MemPool.ConstructArray<D3D11ShaderResourceCounters>(SignCount);
 
     InitResourceLayouts(Shaders, pVSByteCode);
+
+    // D3D11 does not expose the statistics of the native code, so the byte code statistics are reported
+    if ((CreateInfo.Flags & PSO_CREATE_FLAG_CAPTURE_STATISTICS) != 0)
+    {
+        m_Statistics.reserve(Shaders.size());
+        for (const auto* pShader : Shaders)
+            m_Statistics.push_back(pShader->GetShaderResources()->GetStatistics());
+    }
 }
 
 
-PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*                    pRefCounters,
-                                               RenderDeviceD3D11Impl*                 pRenderDeviceD3D11,
-                                               const GraphicsPipelineStateCreateInfo& CreateInfo) :
-    TPipelineStateBase{pRefCounters, pRenderDeviceD3D11, CreateInfo}
+void PipelineStateD3D11Impl::InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo)
 {
-    try
-    {
-        CComPtr<ID3DBlob> pVSByteCode;
-        InitInternalObjects(CreateInfo, pVSByteCode);
+    CComPtr<ID3DBlob> pVSByteCode;
+    InitInternalObjects(CreateInfo, pVSByteCode);
 
-        if (GetD3D11VertexShader() == nullptr)
-            LOG_ERROR_AND_THROW("Vertex shader is null");
+    if (GetD3D11VertexShader() == nullptr)
+        LOG_ERROR_AND_THROW("Vertex shader is null");
 
-        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
-        auto* const pDeviceD3D11     = pRenderDeviceD3D11->GetD3D11Device();
+    const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+    auto* const pDeviceD3D11     = GetDevice()->GetD3D11Device();
 
-        D3D11_BLEND_DESC D3D11BSDesc = {};
-        BlendStateDesc_To_D3D11_BLEND_DESC(GraphicsPipeline.BlendDesc, D3D11BSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateBlendState(&D3D11BSDesc, &m_pd3d11BlendState),
-                               "Failed to create D3D11 blend state object");
+    D3D11_BLEND_DESC D3D11BSDesc = {};
+    BlendStateDesc_To_D3D11_BLEND_DESC(GraphicsPipeline.BlendDesc, D3D11BSDesc);
+    CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateBlendState(&D3D11BSDesc, &m_pd3d11BlendState),
+                           "Failed to create D3D11 blend state object");
 
-        D3D11_RASTERIZER_DESC D3D11RSDesc = {};
-        RasterizerStateDesc_To_D3D11_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, D3D11RSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateRasterizerState(&D3D11RSDesc, &m_pd3d11RasterizerState),
-                               "Failed to create D3D11 rasterizer state");
+    D3D11_RASTERIZER_DESC D3D11RSDesc = {};
+    RasterizerStateDesc_To_D3D11_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, D3D11RSDesc);
+    CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateRasterizerState(&D3D11RSDesc, &m_pd3d11RasterizerState),
+                           "Failed to create D3D11 rasterizer state");
 
-        D3D11_DEPTH_STENCIL_DESC D3D11DSSDesc = {};
-        DepthStencilStateDesc_To_D3D11_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, D3D11DSSDesc);
-        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateDepthStencilState(&D3D11DSSDesc, &m_pd3d11DepthStencilState),
-                               "Failed to create D3D11 depth stencil state");
+    D3D11_DEPTH_STENCIL_DESC D3D11DSSDesc = {};
+    DepthStencilStateDesc_To_D3D11_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, D3D11DSSDesc);
+    CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateDepthStencilState(&D3D11DSSDesc, &m_pd3d11DepthStencilState),
+                           "Failed to create D3D11 depth stencil state");
 
-        // Create input layout
-        const auto& InputLayout = GraphicsPipeline.InputLayout;
-        if (InputLayout.NumElements > 0)
-        {
-            std::vector<D3D11_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D11_INPUT_ELEMENT_DESC>> d311InputElements(STD_ALLOCATOR_RAW_MEM(D3D11_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D11_INPUT_ELEMENT_DESC>"));
-            LayoutElements_To_D3D11_INPUT_ELEMENT_DESCs(InputLayout, d311InputElements);
+    // Create input layout
+    const auto& InputLayout = GraphicsPipeline.InputLayout;
+    if (InputLayout.NumElements > 0)
+    {
+        std::vector<D3D11_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D11_INPUT_ELEMENT_DESC>> d311InputElements(STD_ALLOCATOR_RAW_MEM(D3D11_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D11_INPUT_ELEMENT_DESC>"));
+        LayoutElements_To_D3D11_INPUT_ELEMENT_DESCs(InputLayout, d311InputElements);
 
-            CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateInputLayout(d311InputElements.data(), static_cast<UINT>(d311InputElements.size()), pVSByteCode->GetBufferPointer(), pVSByteCode->GetBufferSize(), &m_pd3d11InputLayout),
-                                   "Failed to create the Direct3D11 input layout");
-        }
+        CHECK_D3D_RESULT_THROW(pDeviceD3D11->CreateInputLayout(d311InputElements.data(), static_cast<UINT>(d311InputElements.size()), pVSByteCode->GetBufferPointer(), pVSByteCode->GetBufferSize(), &m_pd3d11InputLayout),
+                               "Failed to create the Direct3D11 input layout");
+    }
+}
+
+void PipelineStateD3D11Impl::InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo)
+{
+    CComPtr<ID3DBlob> pVSByteCode;
+    InitInternalObjects(CreateInfo, pVSByteCode);
+    VERIFY(!pVSByteCode, "There must be no VS in a compute pipeline.");
+}
+
+PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*                    pRefCounters,
+                                               RenderDeviceD3D11Impl*                 pRenderDeviceD3D11,
+                                               const GraphicsPipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pRenderDeviceD3D11, CreateInfo}
+{
+    try
+    {
+        InitializePipeline(CreateInfo, [this](const GraphicsPipelineStateCreateInfo& PSOCreateInfo) { InitializeGraphicsPipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -287,9 +304,7 @@ PipelineStateD3D11Impl::PipelineStateD3D11Impl(IReferenceCounters*
 {
     try
     {
-        CComPtr<ID3DBlob> pVSByteCode;
-        InitInternalObjects(CreateInfo, pVSByteCode);
-        VERIFY(!pVSByteCode, "There must be no VS in a compute pipeline.");
+        InitializePipeline(CreateInfo, [this](const ComputePipelineStateCreateInfo& PSOCreateInfo) { InitializeComputePipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -319,6 +334,23 @@ void PipelineStateD3D11Impl::Destruct()
 
 IMPLEMENT_QUERY_INTERFACE(PipelineStateD3D11Impl, IID_PipelineStateD3D11, TPipelineStateBase)
 
+void PipelineStateD3D11Impl::SwapShaderObjects(PipelineStateD3D11Impl& Other)
+{
+    // Both pipelines use the same shader stages, so the shader arrays are laid out identically
+    VERIFY_EXPR(m_NumShaders == Other.m_NumShaders && m_ShaderIndices == Other.m_ShaderIndices);
+    for (Uint32 s = 0; s < m_NumShaders; ++s)
+        std::swap(m_ppd3d11Shaders[s], Other.m_ppd3d11Shaders[s]);
+    // The input layout is validated against the vertex shader signature
+    std::swap(m_pd3d11InputLayout, Other.m_pd3d11InputLayout);
+
+#ifdef DILIGENT_DEVELOPMENT
+    std::swap(m_ShaderResources, Other.m_ShaderResources);
+    std::swap(m_ResourceAttibutions, Other.m_ResourceAttibutions);
+    DvpRemapResourceAttributions(m_ResourceAttibutions);
+    Other.DvpRemapResourceAttributions(Other.m_ResourceAttibutions);
+#endif
+}
+
 
 bool PipelineStateD3D11Impl::IsCompatibleWith(const IPipelineState* pPSO) const
 {
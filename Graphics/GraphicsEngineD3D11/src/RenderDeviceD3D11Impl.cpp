@@ -88,6 +88,21 @@ RenderDeviceD3D11Impl::RenderDeviceD3D11Impl(IReferenceCounters*          pRefCo
 
     // Initialize device features
     m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
+
+    if (EngineCI.DynamicConstantRingSize != 0)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS d3d11Options{};
+        if (SUCCEEDED(m_pd3d11Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &d3d11Options, sizeof(d3d11Options))) &&
+            d3d11Options.ConstantBufferOffsetting && d3d11Options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            m_DynamicConstantRingSize = EngineCI.DynamicConstantRingSize;
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Dynamic constant buffer suballocation is disabled as the device does not support "
+                                "constant buffer offsetting or no-overwrite maps of dynamic constant buffers");
+        }
+    }
 }
 
 void RenderDeviceD3D11Impl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
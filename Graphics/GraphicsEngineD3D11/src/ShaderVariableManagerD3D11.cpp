@@ -101,6 +101,12 @@ const PipelineResourceDesc& ShaderVariableManagerD3D11::GetResourceDesc(Uint32 I
     return m_pSignature->GetResourceDesc(Index);
 }
 
+size_t ShaderVariableManagerD3D11::GetResourceNameHash(Uint32 Index) const
+{
+    VERIFY_EXPR(m_pSignature);
+    return m_pSignature->GetResourceNameHash(Index);
+}
+
 const PipelineResourceAttribsD3D11& ShaderVariableManagerD3D11::GetResourceAttribs(Uint32 Index) const
 {
     VERIFY_EXPR(m_pSignature);
@@ -462,24 +468,27 @@ void ShaderVariableManagerD3D11::BindResources(IResourceMapping* pResourceMappin
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Variables look up resources in the engine's resource mapping by precomputed name hashes
+    RefCntAutoPtr<ResourceMappingImpl> pMappingImpl{pResourceMapping, IID_ResourceMappingImpl};
+
     HandleResources(
         [&](ConstBuffBindInfo& cb) {
-            cb.BindResources(pResourceMapping, Flags);
+            cb.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](TexSRVBindInfo& ts) {
-            ts.BindResources(pResourceMapping, Flags);
+            ts.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](TexUAVBindInfo& uav) {
-            uav.BindResources(pResourceMapping, Flags);
+            uav.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](BuffSRVBindInfo& srv) {
-            srv.BindResources(pResourceMapping, Flags);
+            srv.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](BuffUAVBindInfo& uav) {
-            uav.BindResources(pResourceMapping, Flags);
+            uav.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](SamplerBindInfo& sam) {
-            sam.BindResources(pResourceMapping, Flags);
+            sam.BindResources(pResourceMapping, pMappingImpl, Flags);
         });
 }
 
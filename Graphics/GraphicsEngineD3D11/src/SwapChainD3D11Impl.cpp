@@ -147,7 +147,9 @@ void SwapChainD3D11Impl::Present(Uint32 SyncInterval)
     // In contrast to MSDN sample, we wait for the frame as late as possible - right
     // before presenting.
     // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
-    WaitForFrame();
+    if (!m_FrameWaited)
+        WaitForFrame();
+    m_FrameWaited = false;
 
     m_pSwapChain->Present(SyncInterval, 0);
 }
@@ -35,6 +35,7 @@
 #include "BufferViewD3D12Impl.hpp" // Required by BufferBase
 #include "D3D12ResourceBase.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12MemoryManager.hpp"
 #include "DescriptorHeap.hpp"
 #include "IndexWrapper.hpp"
 
@@ -47,11 +48,13 @@ class BufferD3D12Impl final : public BufferBase<EngineD3D12ImplTraits>, public D
 public:
     using TBufferBase = BufferBase<EngineD3D12ImplTraits>;
 
-    BufferD3D12Impl(IReferenceCounters*        pRefCounters,
-                    FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
-                    RenderDeviceD3D12Impl*     pDeviceD3D12,
-                    const BufferDesc&          BuffDesc,
-                    const BufferData*          pBuffData = nullptr);
+    BufferD3D12Impl(IReferenceCounters*          pRefCounters,
+                    FixedBlockMemoryAllocator&   BuffViewObjMemAllocator,
+                    RenderDeviceD3D12Impl*       pDeviceD3D12,
+                    const BufferDesc&            BuffDesc,
+                    const BufferData*            pBuffData  = nullptr,
+                    class ResourceHeapD3D12Impl* pHeap      = nullptr,
+                    Uint64                       HeapOffset = 0);
 
     BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                     FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
@@ -111,6 +114,13 @@ public:
 
     void CreateCBV(D3D12_CPU_DESCRIPTOR_HANDLE CBVDescriptor, Uint32 Offset = 0, Uint32 Size = 0) const;
 
+    // Returns the residency object of the committed resource or of the placed resource heap page
+    // that contains the buffer, or null if the buffer is not tracked by the residency manager.
+    D3D12ResidencyObject* GetResidencyObject() const { return m_pResidencyObject; }
+
+    // Returns the D3D12 resource description for the given buffer description.
+    static D3D12_RESOURCE_DESC GetD3D12BufferDesc(const BufferDesc& BuffDesc);
+
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -135,6 +145,16 @@ private:
     friend class DeviceContextD3D12Impl;
     // Array of dynamic allocations for every device context.
     std::vector<CtxDynamicData, STDAllocatorRawMem<D3D12DynamicAllocation>> m_DynamicData;
+
+    // Resource heap the buffer is placed in, if any
+    RefCntAutoPtr<IResourceHeap> m_pHeap;
+
+    // Memory of the placed resource heap page the buffer is suballocated from, if any
+    D3D12MemoryAllocation m_MemoryAllocation;
+
+    // Residency of the committed resource, if it is tracked by the residency manager
+    D3D12ResidencyHandle  m_ResidencyHandle;
+    D3D12ResidencyObject* m_pResidencyObject = nullptr;
 };
 
 } // namespace Diligent
@@ -29,10 +29,14 @@
 #pragma once
 
 #include <vector>
+#include <utility>
+#include <unordered_map>
 
 #include "DeviceContext.h"
+#include "HashUtils.hpp"
 #include "D3D12ResourceBase.hpp"
 #include "DescriptorHeap.hpp"
+#include "D3D12ResidencyManager.hpp"
 
 namespace Diligent
 {
@@ -41,6 +45,7 @@ class TextureD3D12Impl;
 class BufferD3D12Impl;
 class BottomLevelASD3D12Impl;
 class TopLevelASD3D12Impl;
+class QueryManagerD3D12;
 
 struct DWParam
 {
@@ -66,7 +71,7 @@ struct DWParam
 class CommandContext
 {
 public:
-    explicit CommandContext(class CommandListManager& CmdListManager);
+    CommandContext(class CommandListManager& CmdListManager, UINT NodeMask);
 
     // clang-format off
     CommandContext             (const CommandContext&)  = delete;
@@ -91,6 +96,8 @@ public:
     class GraphicsContext6& AsGraphicsContext6();
     class ComputeContext&   AsComputeContext();
 
+    Uint32 GetMaxInterfaceVersion() const { return m_MaxInterfaceVer; }
+
     void ClearUAVFloat(D3D12_GPU_DESCRIPTOR_HANDLE GpuHandle,
                        D3D12_CPU_DESCRIPTOR_HANDLE CpuHandle,
                        ID3D12Resource*             pd3d12Resource,
@@ -111,6 +118,7 @@ public:
 
     void CopyResource(ID3D12Resource* pDstRes, ID3D12Resource* pSrcRes)
     {
+        FlushResourceBarriers();
         m_pCommandList->CopyResource(pDstRes, pSrcRes);
     }
 
@@ -183,6 +191,7 @@ public:
     void                       SetID(const Char* ID) { m_ID = ID; }
     ID3D12GraphicsCommandList* GetCommandList() { return m_pCommandList; }
     D3D12_COMMAND_LIST_TYPE    GetCommandListType() const { return m_pCommandList->GetType(); }
+    UINT                       GetNodeMask() const { return m_NodeMask; }
 
     DescriptorHeapAllocation AllocateDynamicGPUVisibleDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count = 1)
     {
@@ -210,6 +219,32 @@ public:
         m_DynamicGPUDescriptorAllocators = Allocators;
     }
 
+    // Dynamic sampler tables are identified by the CPU descriptor handles of the samplers they contain.
+    // Samplers are immutable and are deduplicated by the device, and dynamic allocations stay valid until
+    // the end of the frame, so identical tables committed while the command list is recorded are allocated
+    // and copied only once.
+    using DynamicSamplerTableKey = std::vector<SIZE_T>;
+
+    // Returns the key object that the caller may reuse to look up the table without allocating memory.
+    DynamicSamplerTableKey& GetDynamicSamplerTableKeyScratch() { return m_DynamicSamplerTableKey; }
+
+    const DescriptorHeapAllocation* FindDynamicSamplerTable(const DynamicSamplerTableKey& Key) const
+    {
+        auto it = m_DynamicSamplerTables.find(Key);
+        return it != m_DynamicSamplerTables.end() ? &it->second : nullptr;
+    }
+
+    const DescriptorHeapAllocation& AddDynamicSamplerTable(const DynamicSamplerTableKey& Key, DescriptorHeapAllocation&& Table)
+    {
+        return m_DynamicSamplerTables.emplace(Key, std::move(Table)).first->second;
+    }
+
+    // Must be called before dynamic descriptor allocations are released
+    void DiscardDynamicSamplerTables()
+    {
+        m_DynamicSamplerTables.clear();
+    }
+
     void BeginQuery(ID3D12QueryHeap* pQueryHeap, D3D12_QUERY_TYPE Type, UINT Index)
     {
         m_pCommandList->BeginQuery(pQueryHeap, Type, Index);
@@ -220,6 +255,27 @@ public:
         m_pCommandList->EndQuery(pQueryHeap, Type, Index);
     }
 
+    // Queries ended in this command list are resolved in bulk by the query manager
+    // when the command list is closed
+    void AddPendingQueryResolve(QueryManagerD3D12& QueryMgr, QUERY_TYPE Type, Uint32 Index)
+    {
+        VERIFY(m_pQueryMgr == nullptr || m_pQueryMgr == &QueryMgr, "All queries must be managed by the same query manager");
+        m_pQueryMgr = &QueryMgr;
+        m_PendingQueryResolves.emplace_back(Type, Index);
+    }
+
+    // Records that the command list uses the object, so that the residency manager
+    // makes it resident before the command list is submitted
+    void AddResidencyUsage(D3D12ResidencyObject* pObject)
+    {
+        // The stamp filters out duplicates. An object that is used by several contexts
+        // recorded in parallel may occasionally be added twice, which is harmless.
+        if (pObject != nullptr && pObject->UsageStamp.exchange(m_ResidencyStamp) != m_ResidencyStamp)
+            m_ResidencyUsage.emplace_back(pObject);
+    }
+
+    const std::vector<D3D12ResidencyObject*>& GetResidencyUsage() const { return m_ResidencyUsage; }
+
     void ResolveQueryData(ID3D12QueryHeap* pQueryHeap,
                           D3D12_QUERY_TYPE Type,
                           UINT             StartIndex,
@@ -230,6 +286,12 @@ public:
         m_pCommandList->ResolveQueryData(pQueryHeap, Type, StartIndex, NumQueries, pDestinationBuffer, AlignedDestinationBufferOffset);
     }
 
+    void SetPredication(ID3D12Resource* pBuffer, UINT64 AlignedBufferOffset, D3D12_PREDICATION_OP Operation)
+    {
+        FlushResourceBarriers();
+        m_pCommandList->SetPredication(pBuffer, AlignedBufferOffset, Operation);
+    }
+
 #ifdef DILIGENT_USE_PIX
     void PixBeginEvent(const Char* Name, const float* pColor);
     void PixEndEvent();
@@ -257,11 +319,34 @@ protected:
 
     DynamicSuballocationsManager* m_DynamicGPUDescriptorAllocators = nullptr;
 
+    struct DynamicSamplerTableKeyHasher
+    {
+        size_t operator()(const DynamicSamplerTableKey& Key) const
+        {
+            size_t Hash = Key.size();
+            for (auto Handle : Key)
+                HashCombine(Hash, Handle);
+            return Hash;
+        }
+    };
+    std::unordered_map<DynamicSamplerTableKey, DescriptorHeapAllocation, DynamicSamplerTableKeyHasher> m_DynamicSamplerTables;
+    DynamicSamplerTableKey                                                                             m_DynamicSamplerTableKey;
+
+    QueryManagerD3D12*                         m_pQueryMgr = nullptr;
+    std::vector<std::pair<QUERY_TYPE, Uint32>> m_PendingQueryResolves;
+
+    // Residency objects used by the command list and the stamp that identifies this recording
+    std::vector<D3D12ResidencyObject*> m_ResidencyUsage;
+    Uint64                             m_ResidencyStamp = 0;
+
     String m_ID;
 
     D3D12_PRIMITIVE_TOPOLOGY m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 
     Uint32 m_MaxInterfaceVer = 0;
+
+    // Node mask the command list was created with
+    const UINT m_NodeMask;
 };
 
 class ComputeContext : public CommandContext
@@ -364,6 +449,14 @@ class GraphicsContext1 : public GraphicsContext
 
 class GraphicsContext2 : public GraphicsContext1
 {
+public:
+    void WriteBufferImmediate(UINT                                        Count,
+                              const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER* pParams,
+                              const D3D12_WRITEBUFFERIMMEDIATE_MODE*      pModes = nullptr)
+    {
+        FlushResourceBarriers();
+        static_cast<ID3D12GraphicsCommandList2*>(m_pCommandList.p)->WriteBufferImmediate(Count, pParams, pModes);
+    }
 };
 
 class GraphicsContext3 : public GraphicsContext2
@@ -32,6 +32,9 @@
 
 #include "EngineD3D12ImplTraits.hpp"
 #include "CommandListBase.hpp"
+#include "RenderDeviceD3D12Impl.hpp"
+#include "DeviceContextD3D12Impl.hpp"
+#include "CommandContext.hpp"
 
 namespace Diligent
 {
@@ -54,15 +57,26 @@ public:
             pDeferredCtx
         },
         m_pDeferredCtx{pDeferredCtx          },
-        m_pCmdContext {std::move(pCmdContext)}
+        m_pCmdContext {std::move(pCmdContext)},
+        m_CmdQueueId  {pDeferredCtx->GetCommandQueueId()}
     // clang-format on
     {
         VERIFY_EXPR(m_pCmdContext);
+        if (IsReusable())
+        {
+            // Reusable command list is closed once and then submitted as is
+            m_pd3d12CmdList = m_pCmdContext->Close(m_pReusableAllocator);
+        }
     }
 
     ~CommandListD3D12Impl()
     {
-        if (m_pCmdContext != nullptr)
+        if (IsReusable())
+        {
+            // The allocator is not reset until the last submission of the command list has completed
+            m_pDevice->ReleaseReusableCommandContext(std::move(m_pCmdContext), std::move(m_pReusableAllocator), m_CmdQueueId, m_LastSubmittedFenceValue);
+        }
+        else if (m_pCmdContext != nullptr)
         {
             LOG_WARNING_MESSAGE("Destroying command list that has not been executed");
             m_pDevice->DisposeCommandContext(std::move(m_pCmdContext));
@@ -75,13 +89,39 @@ public:
 
     RenderDeviceD3D12Impl::PooledCommandContext Close(RefCntAutoPtr<DeviceContextD3D12Impl>& pDeferredCtx)
     {
+        VERIFY(!IsReusable(), "Reusable command lists must never be closed");
         pDeferredCtx = std::move(m_pDeferredCtx);
         return std::move(m_pCmdContext);
     }
 
+    ID3D12CommandList* GetD3D12CommandList() const { return m_pd3d12CmdList; }
+
+    const CommandContext& GetCmdContext() const
+    {
+        VERIFY(IsReusable(), "Only reusable command lists keep the command context after they are executed");
+        return *m_pCmdContext;
+    }
+
+    DeviceContextD3D12Impl* GetDeferredContext() const { return m_pDeferredCtx; }
+
+    /// Records the fence value of the last submission of a reusable command list.
+    void OnSubmitted(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+    {
+        VERIFY(IsReusable(), "Only reusable command lists are kept alive after submission");
+        DEV_CHECK_ERR(CmdQueue == m_CmdQueueId, "Reusable command list recorded for queue ", Uint32{m_CmdQueueId},
+                      " is executed in queue ", Uint32{CmdQueue}, ". Reusable command lists must be executed in the same immediate context.");
+        m_LastSubmittedFenceValue = std::max(m_LastSubmittedFenceValue, FenceValue);
+    }
+
 private:
     RefCntAutoPtr<DeviceContextD3D12Impl>       m_pDeferredCtx;
     RenderDeviceD3D12Impl::PooledCommandContext m_pCmdContext;
+    const SoftwareQueueIndex                    m_CmdQueueId;
+
+    // Reusable command list only
+    ID3D12GraphicsCommandList*      m_pd3d12CmdList = nullptr;
+    CComPtr<ID3D12CommandAllocator> m_pReusableAllocator;
+    Uint64                          m_LastSubmittedFenceValue = 0;
 };
 
 } // namespace Diligent
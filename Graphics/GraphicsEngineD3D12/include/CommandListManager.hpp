@@ -51,8 +51,9 @@ public:
     CommandListManager& operator = (      CommandListManager&&) = delete;
     // clang-format on
 
-    // Returns the maximum supported interface version
-    void CreateNewCommandList(ID3D12GraphicsCommandList** ppList, ID3D12CommandAllocator** ppAllocator, Uint32& IfaceVersion);
+    // Returns the maximum supported interface version.
+    // NodeMask must match the node mask of the queue the list will be executed on.
+    void CreateNewCommandList(ID3D12GraphicsCommandList** ppList, ID3D12CommandAllocator** ppAllocator, Uint32& IfaceVersion, UINT NodeMask);
 
     void RequestAllocator(ID3D12CommandAllocator** ppAllocator);
     void ReleaseAllocator(CComPtr<ID3D12CommandAllocator>&& Allocator, SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
@@ -28,10 +28,12 @@
 #pragma once
 
 #include <mutex>
-#include <map>
-#include <deque>
+#include <array>
+#include <vector>
 #include <atomic>
 
+#include "IndexWrapper.hpp"
+
 namespace Diligent
 {
 
@@ -76,13 +78,14 @@ struct D3D12DynamicAllocation
 class D3D12DynamicPage
 {
 public:
+    D3D12DynamicPage() noexcept {}
     D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size);
 
     // clang-format off
     D3D12DynamicPage            (const D3D12DynamicPage&)  = delete;
     D3D12DynamicPage            (      D3D12DynamicPage&&) = default;
     D3D12DynamicPage& operator= (const D3D12DynamicPage&)  = delete;
-    D3D12DynamicPage& operator= (      D3D12DynamicPage&&) = delete;
+    D3D12DynamicPage& operator= (      D3D12DynamicPage&&) = default;
     // clang-format on
 
     void* GetCPUAddress(Uint64 Offset)
@@ -122,8 +125,7 @@ private:
 class D3D12DynamicMemoryManager
 {
 public:
-    D3D12DynamicMemoryManager(IMemoryAllocator&      Allocator,
-                              RenderDeviceD3D12Impl& DeviceD3D12Impl,
+    D3D12DynamicMemoryManager(RenderDeviceD3D12Impl& DeviceD3D12Impl,
                               Uint32                 NumPagesToReserve,
                               Uint64                 PageSize);
     ~D3D12DynamicMemoryManager();
@@ -141,6 +143,14 @@ public:
 
     D3D12DynamicPage AllocatePage(Uint64 SizeInBytes);
 
+    // Reports upload pages as memory type 0 in heap 0, see IRenderDevice::GetMemoryStatistics().
+    void GetStatistics(RenderDeviceMemoryStatistics& Stats);
+
+    // Sets the callback that is called when a new page is created, see IRenderDevice::SetMemoryAllocationCallback().
+    void SetAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData);
+
+    RenderDeviceD3D12Impl& GetDevice() { return m_DeviceD3D12Impl; }
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t GetAllocatedPageCounter() const
     {
@@ -149,11 +159,33 @@ public:
 #endif
 
 private:
+    // Creates the pages requested by EngineD3D12CreateInfo::NumDynamicHeapPagesToReserve.
+    // Must be called with m_AvailablePagesMtx locked.
+    void ReservePages();
+
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
-    std::mutex m_AvailablePagesMtx;
-    using AvailablePagesMapElemType = std::pair<const Uint64, D3D12DynamicPage>;
-    std::multimap<Uint64, D3D12DynamicPage, std::less<Uint64>, STDAllocatorRawMem<AvailablePagesMapElemType>> m_AvailablePages;
+    // Available pages are grouped by size classes: class N contains the pages whose size is in [2^N, 2^(N+1)).
+    // Page sizes are typically powers of two, so a page is found without searching.
+    static constexpr size_t NumPageSizeClasses = 64;
+    static size_t           GetPageSizeClass(Uint64 Size);
+
+    std::mutex                                                    m_AvailablePagesMtx;
+    std::array<std::vector<D3D12DynamicPage>, NumPageSizeClasses> m_AvailablePages;
+
+    // Protected by m_AvailablePagesMtx
+    Uint64 m_CurrAllocatedSize = 0; // The total size of all pages
+    Uint64 m_PeakAllocatedSize = 0;
+    Uint64 m_CurrUsedSize      = 0; // The total size of pages used by dynamic heaps
+    Uint64 m_PeakUsedSize      = 0;
+    Uint32 m_NumPages          = 0;
+
+    // The number of pages that will be reserved by the first AllocatePage() call, protected by m_AvailablePagesMtx
+    Uint32       m_NumPagesToReserve = 0;
+    const Uint64 m_ReservedPageSize;
+
+    MemoryAllocationCallbackType m_AllocationCallback          = nullptr;
+    void*                        m_pAllocationCallbackUserData = nullptr;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedPageCounter = 0;
@@ -184,14 +216,35 @@ public:
 
     static constexpr Uint64 InvalidOffset = static_cast<Uint64>(-1);
 
+    // The maximum number of released pages the heap keeps for reuse, see m_CachedPages.
+    static constexpr size_t MaxCachedPages = 16;
+
     size_t GetAllocatedPagesCount() const { return m_AllocatedPages.size(); }
 
 private:
+    // Returns a cached page of at least SizeInBytes bytes that is no longer used by the GPU,
+    // or an invalid page if there is none.
+    D3D12DynamicPage AllocateCachedPage(Uint64 SizeInBytes);
+
     D3D12DynamicMemoryManager& m_GlobalDynamicMemMgr;
     const std::string          m_HeapName;
 
     std::vector<D3D12DynamicPage> m_AllocatedPages;
 
+    struct CachedPage
+    {
+        D3D12DynamicPage Page;
+
+        // The page may be reused once the queue completes this fence value
+        SoftwareQueueIndex QueueId;
+        Uint64             FenceValue;
+    };
+    // Pages released by this heap in the previous frames, in the order they were released.
+    // The heap reuses these pages before requesting pages from the global manager, so that
+    // steady-state frames never lock the manager's mutex. Cached pages are counted as used
+    // by the global manager and are returned to it when the heap is destroyed.
+    std::vector<CachedPage> m_CachedPages;
+
     const Uint64 m_PageSize;
 
     Uint64 m_CurrOffset    = InvalidOffset;
@@ -0,0 +1,262 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D12MemoryManager class
+
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include "MemoryAllocator.h"
+#include "GraphicsTypes.h"
+#include "VariableSizeAllocationsManager.hpp"
+#include "HashUtils.hpp"
+#include "D3D12ResidencyManager.hpp"
+
+namespace Diligent
+{
+
+class D3D12MemoryPage;
+class D3D12MemoryManager;
+
+// Range of a placed resource heap page that holds one placed resource
+struct D3D12MemoryAllocation
+{
+    D3D12MemoryAllocation() noexcept {}
+
+    // clang-format off
+    D3D12MemoryAllocation            (const D3D12MemoryAllocation&) = delete;
+    D3D12MemoryAllocation& operator= (const D3D12MemoryAllocation&) = delete;
+
+    D3D12MemoryAllocation(D3D12MemoryPage* _Page, Uint64 _UnalignedOffset, Uint64 _Size) noexcept :
+        Page           {_Page           },
+        UnalignedOffset{_UnalignedOffset},
+        Size           {_Size           }
+    {}
+
+    D3D12MemoryAllocation(D3D12MemoryAllocation&& rhs) noexcept :
+        Page           {rhs.Page           },
+        UnalignedOffset{rhs.UnalignedOffset},
+        Size           {rhs.Size           }
+    {
+        rhs.Page            = nullptr;
+        rhs.UnalignedOffset = 0;
+        rhs.Size            = 0;
+    }
+
+    D3D12MemoryAllocation& operator= (D3D12MemoryAllocation&& rhs) noexcept
+    {
+        Page            = rhs.Page;
+        UnalignedOffset = rhs.UnalignedOffset;
+        Size            = rhs.Size;
+
+        rhs.Page            = nullptr;
+        rhs.UnalignedOffset = 0;
+        rhs.Size            = 0;
+
+        return *this;
+    }
+    // clang-format on
+
+    // Destructor immediately returns the allocation to the parent page.
+    // The allocation must not be in use by the GPU.
+    ~D3D12MemoryAllocation();
+
+    D3D12MemoryPage* Page            = nullptr; // Memory page that contains this allocation
+    Uint64           UnalignedOffset = 0;       // Unaligned offset from the start of the heap
+    Uint64           Size            = 0;       // Reserved size of this allocation
+};
+
+// ID3D12Heap that placed resources are suballocated from
+class D3D12MemoryPage
+{
+public:
+    D3D12MemoryPage(D3D12MemoryManager& ParentMemoryMgr,
+                    Uint64              PageSize,
+                    D3D12_HEAP_TYPE     HeapType,
+                    D3D12_HEAP_FLAGS    HeapFlags,
+                    UINT                CreationNodeMask,
+                    UINT                VisibleNodeMask);
+    ~D3D12MemoryPage();
+
+    // clang-format off
+    D3D12MemoryPage            (const D3D12MemoryPage&)  = delete;
+    D3D12MemoryPage            (      D3D12MemoryPage&&) = delete;
+    D3D12MemoryPage& operator= (const D3D12MemoryPage&)  = delete;
+    D3D12MemoryPage& operator= (      D3D12MemoryPage&&) = delete;
+
+    bool   IsEmpty()     const { return m_AllocationMgr.IsEmpty();     }
+    Uint64 GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
+    Uint64 GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    // clang-format on
+
+    D3D12MemoryAllocation Allocate(Uint64 Size, Uint64 Alignment);
+
+    ID3D12Heap* GetD3D12Heap() const { return m_pd3d12Heap; }
+
+    // Returns the residency object of the heap, or null if residency management is disabled.
+    D3D12ResidencyObject* GetResidencyObject() const { return m_ResidencyHandle.GetObject(); }
+
+private:
+    using AllocationsMgrOffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    friend struct D3D12MemoryAllocation;
+
+    // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
+    void Free(D3D12MemoryAllocation&& Allocation);
+
+    D3D12MemoryManager&            m_ParentMemoryMgr;
+    std::mutex                     m_Mutex;
+    VariableSizeAllocationsManager m_AllocationMgr;
+    CComPtr<ID3D12Heap>            m_pd3d12Heap;
+    D3D12ResidencyHandle           m_ResidencyHandle;
+};
+
+// Suballocates placed resources from large ID3D12Heap blocks, so that creating a resource
+// does not require a separate heap and kernel allocation like a committed resource does.
+// Pages are keyed by heap type, heap flags and node masks. On resource heap tier 1 devices,
+// buffers and textures are placed in separate heaps.
+class D3D12MemoryManager
+{
+public:
+    D3D12MemoryManager(IMemoryAllocator&      Allocator,
+                       ID3D12Device*          pd3d12Device,
+                       D3D12ResidencyManager& ResidencyMgr,
+                       Uint64                 PageSize,
+                       Uint64                 ReserveSize);
+    ~D3D12MemoryManager();
+
+    // clang-format off
+    D3D12MemoryManager            (const D3D12MemoryManager&)  = delete;
+    D3D12MemoryManager            (      D3D12MemoryManager&&) = delete;
+    D3D12MemoryManager& operator= (const D3D12MemoryManager&)  = delete;
+    D3D12MemoryManager& operator= (      D3D12MemoryManager&&) = delete;
+    // clang-format on
+
+    // Creates a placed resource in one of the pages and returns its memory in Allocation.
+    // Resources that can't or should not be placed (upload and readback resources, render targets,
+    // depth-stencil and multisample textures, and resources larger than half of the page) are created
+    // as committed resources, in which case Allocation is left empty.
+    HRESULT CreateResource(const D3D12_HEAP_PROPERTIES& HeapProps,
+                           const D3D12_RESOURCE_DESC&   ResourceDesc,
+                           D3D12_RESOURCE_STATES        InitialState,
+                           const D3D12_CLEAR_VALUE*     pClearValue,
+                           D3D12MemoryAllocation&       Allocation,
+                           ID3D12Resource**             ppd3d12Resource);
+
+    // Releases empty pages that exceed the reserve size.
+    void ShrinkMemory();
+
+    // Reports the placed resource heaps as memory type 1 in heap 1, see IRenderDevice::GetMemoryStatistics().
+    // Memory type 0 and heap 0 are written by D3D12DynamicMemoryManager::GetStatistics().
+    void GetStatistics(RenderDeviceMemoryStatistics& Stats);
+
+    // Sets the callback that is called when a page is created or destroyed,
+    // see IRenderDevice::SetMemoryAllocationCallback().
+    void SetAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData);
+
+    static constexpr Uint32 MemoryTypeIndex = 1;
+    static constexpr Uint32 HeapIndex       = 1;
+
+private:
+    friend class D3D12MemoryPage;
+
+    // Returns the allocation info of the resource. For textures that allow it, sets
+    // ResourceDesc.Alignment to D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT.
+    D3D12_RESOURCE_ALLOCATION_INFO GetAllocationInfo(D3D12_RESOURCE_DESC& ResourceDesc) const;
+
+    D3D12MemoryAllocation Allocate(Uint64 Size, Uint64 Alignment, const D3D12_HEAP_PROPERTIES& HeapProps, D3D12_HEAP_FLAGS HeapFlags);
+
+    // Update the statistics and invoke the allocation callback. m_PagesMtx must be locked.
+    void OnPageCreated(const D3D12MemoryPage& Page);
+    void OnPageReleased(const D3D12MemoryPage& Page);
+
+    void OnFreeAllocation(Uint64 Size);
+
+    ID3D12Device* const    m_pd3d12Device;
+    IMemoryAllocator&      m_Allocator;
+    D3D12ResidencyManager& m_ResidencyMgr;
+
+    const Uint64 m_PageSize;
+    const Uint64 m_ReserveSize;
+
+    D3D12_RESOURCE_HEAP_TIER m_ResourceHeapTier = D3D12_RESOURCE_HEAP_TIER_1;
+
+    std::mutex m_PagesMtx;
+    struct MemoryPageIndex
+    {
+        const D3D12_HEAP_TYPE  HeapType;
+        const D3D12_HEAP_FLAGS HeapFlags;
+        const UINT             CreationNodeMask;
+        const UINT             VisibleNodeMask;
+
+        // clang-format off
+        MemoryPageIndex(D3D12_HEAP_TYPE  _HeapType,
+                        D3D12_HEAP_FLAGS _HeapFlags,
+                        UINT             _CreationNodeMask,
+                        UINT             _VisibleNodeMask) :
+            HeapType        {_HeapType        },
+            HeapFlags       {_HeapFlags       },
+            CreationNodeMask{_CreationNodeMask},
+            VisibleNodeMask {_VisibleNodeMask }
+        {}
+
+        bool operator == (const MemoryPageIndex& rhs)const
+        {
+            return HeapType         == rhs.HeapType         &&
+                   HeapFlags        == rhs.HeapFlags        &&
+                   CreationNodeMask == rhs.CreationNodeMask &&
+                   VisibleNodeMask  == rhs.VisibleNodeMask;
+        }
+        // clang-format on
+
+        struct Hasher
+        {
+            size_t operator()(const MemoryPageIndex& PageIndex) const
+            {
+                return ComputeHash(static_cast<Uint32>(PageIndex.HeapType), static_cast<Uint32>(PageIndex.HeapFlags), PageIndex.CreationNodeMask, PageIndex.VisibleNodeMask);
+            }
+        };
+    };
+    std::unordered_multimap<MemoryPageIndex, D3D12MemoryPage, MemoryPageIndex::Hasher> m_Pages;
+
+    // The used size is updated without locking m_PagesMtx when allocations are freed.
+    // Other members are protected by m_PagesMtx.
+    std::atomic_int64_t m_CurrUsedSize{0};
+    Uint64              m_PeakUsedSize      = 0;
+    Uint64              m_CurrAllocatedSize = 0;
+    Uint64              m_PeakAllocatedSize = 0;
+    Uint32              m_NumPages          = 0;
+
+    MemoryAllocationCallbackType m_AllocationCallback          = nullptr;
+    void*                        m_pAllocationCallbackUserData = nullptr;
+};
+
+} // namespace Diligent
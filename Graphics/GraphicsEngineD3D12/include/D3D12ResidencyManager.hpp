@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::D3D12ResidencyManager class
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <deque>
+
+#include <dxgi1_4.h>
+
+#include "GraphicsTypes.h"
+
+namespace Diligent
+{
+
+class RenderDeviceD3D12Impl;
+class CommandContext;
+class D3D12ResidencyManager;
+
+// Residency state of a committed resource or a placed resource heap
+struct D3D12ResidencyObject
+{
+    D3D12ResidencyObject(ID3D12Pageable* _pd3d12Pageable, Uint64 _Size, Uint64 _LastUsedFrame) noexcept :
+        // clang-format off
+        pd3d12Pageable{_pd3d12Pageable},
+        Size          {_Size          },
+        LastUsedFrame {_LastUsedFrame }
+    // clang-format on
+    {}
+
+    // The object keeps a reference to the pageable, so that it can't be destroyed while the
+    // residency manager may be making it resident or evicting it.
+    const CComPtr<ID3D12Pageable> pd3d12Pageable;
+    const Uint64                  Size;
+
+    // The members below are protected by the residency manager mutex
+
+    // The last frame in which a command list that uses the object was submitted
+    Uint64 LastUsedFrame = 0;
+    // Index of the object in the manager's object list
+    size_t Index = 0;
+    bool   IsResident = true;
+
+    // Stamp of the last command context that recorded the use of the object,
+    // see CommandContext::AddResidencyUsage().
+    std::atomic<Uint64> UsageStamp{0};
+};
+
+// Move-only handle that keeps the residency object registered in the manager.
+// The handle must be released after the GPU has finished using the object,
+// e.g. through RenderDeviceD3D12Impl::SafeReleaseDeviceObject().
+class D3D12ResidencyHandle
+{
+public:
+    D3D12ResidencyHandle() noexcept {}
+
+    D3D12ResidencyHandle(D3D12ResidencyManager& Mgr, D3D12ResidencyObject* pObject) noexcept :
+        // clang-format off
+        m_pMgr   {&Mgr   },
+        m_pObject{pObject}
+    // clang-format on
+    {}
+
+    // clang-format off
+    D3D12ResidencyHandle            (const D3D12ResidencyHandle&) = delete;
+    D3D12ResidencyHandle& operator= (const D3D12ResidencyHandle&) = delete;
+
+    D3D12ResidencyHandle(D3D12ResidencyHandle&& rhs) noexcept :
+        m_pMgr   {rhs.m_pMgr   },
+        m_pObject{rhs.m_pObject}
+    {
+        rhs.m_pMgr    = nullptr;
+        rhs.m_pObject = nullptr;
+    }
+    // clang-format on
+
+    D3D12ResidencyHandle& operator=(D3D12ResidencyHandle&& rhs) noexcept
+    {
+        Release();
+
+        m_pMgr    = rhs.m_pMgr;
+        m_pObject = rhs.m_pObject;
+
+        rhs.m_pMgr    = nullptr;
+        rhs.m_pObject = nullptr;
+
+        return *this;
+    }
+
+    ~D3D12ResidencyHandle()
+    {
+        Release();
+    }
+
+    void Release();
+
+    D3D12ResidencyObject* GetObject() const { return m_pObject; }
+
+    explicit operator bool() const { return m_pObject != nullptr; }
+
+private:
+    D3D12ResidencyManager* m_pMgr    = nullptr;
+    D3D12ResidencyObject*  m_pObject = nullptr;
+};
+
+// Keeps the working set of committed resources and placed resource heaps within the
+// video memory budget reported by IDXGIAdapter3::QueryVideoMemoryInfo().
+//
+// Every command context records the residency objects it uses. Before the contexts are
+// submitted, the objects they use are made resident with ID3D12Device::MakeResident().
+// When the local memory usage exceeds the budget, objects that have not been used
+// for the given number of frames and are not referenced by command lists that may still
+// be executing are evicted with ID3D12Device::Evict(), least recently used first.
+// A frame ends every time the device releases stale resources, which happens when
+// the swap chain is presented.
+class D3D12ResidencyManager
+{
+public:
+    D3D12ResidencyManager(RenderDeviceD3D12Impl&       DeviceD3D12Impl,
+                          ID3D12Device*                pd3d12Device,
+                          const EngineD3D12CreateInfo& EngineCI);
+    ~D3D12ResidencyManager();
+
+    // clang-format off
+    D3D12ResidencyManager            (const D3D12ResidencyManager&)  = delete;
+    D3D12ResidencyManager            (      D3D12ResidencyManager&&) = delete;
+    D3D12ResidencyManager& operator= (const D3D12ResidencyManager&)  = delete;
+    D3D12ResidencyManager& operator= (      D3D12ResidencyManager&&) = delete;
+    // clang-format on
+
+    bool IsEnabled() const { return m_IsEnabled; }
+
+    // Registers the object that is resident at creation. Returns an empty handle
+    // if residency management is disabled.
+    D3D12ResidencyHandle Register(ID3D12Pageable* pd3d12Pageable, Uint64 Size);
+
+    // Registers the committed resource in a default heap.
+    D3D12ResidencyHandle RegisterCommittedResource(ID3D12Resource* pd3d12Resource);
+
+    // Makes all objects used by the command contexts resident. Must be called
+    // right before the command lists are submitted.
+    void MakeResident(Uint32 NumContexts, const CommandContext* const* ppContexts);
+
+    // Ends the current frame and evicts unused objects if the memory usage exceeds the budget.
+    void EndFrame();
+
+private:
+    friend class D3D12ResidencyHandle;
+    void Unregister(D3D12ResidencyObject* pObject);
+
+    // Evicts least recently used objects until RequiredSize bytes fit into the budget.
+    // m_Mtx must be locked.
+    void EvictToBudget(Uint64 RequiredSize);
+
+    // Updates m_LastCompletedFrame. m_Mtx must be locked.
+    void UpdateCompletedFrames();
+
+    RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
+    ID3D12Device* const    m_pd3d12Device;
+
+    // The number of frames an object must stay unused before it can be evicted
+    const Uint32 m_EvictionFrameCount;
+
+    // The budget that overrides the one reported by the OS, or zero
+    const Uint64 m_MemoryBudget;
+
+    bool m_IsEnabled = false;
+
+    CComPtr<IDXGIAdapter3> m_pDXGIAdapter;
+
+    std::mutex m_Mtx;
+
+    std::vector<std::unique_ptr<D3D12ResidencyObject>> m_Objects;
+
+    Uint64 m_CurrentFrame       = 1;
+    Uint64 m_LastCompletedFrame = 0;
+
+    // The last fence value submitted to every command queue by the end of the frame
+    struct FrameFences
+    {
+        Uint64              Frame;
+        std::vector<Uint64> FenceValues;
+    };
+    std::deque<FrameFences> m_PendingFrames;
+
+    // Scratch arrays reused by MakeResident() and EvictToBudget()
+    std::vector<ID3D12Pageable*>       m_ResidentPageables;
+    std::vector<ID3D12Pageable*>       m_EvictedPageables;
+    std::vector<D3D12ResidencyObject*> m_EvictionCandidates;
+
+    Uint64 m_NumEvictedObjects = 0;
+    Uint64 m_EvictedSize       = 0;
+    Uint64 m_NumMadeResident   = 0;
+    Uint64 m_MadeResidentSize  = 0;
+};
+
+} // namespace Diligent
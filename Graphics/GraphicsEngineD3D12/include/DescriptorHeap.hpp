@@ -31,13 +31,16 @@
 #pragma once
 
 #include <mutex>
+#include <array>
 #include <vector>
 #include <queue>
+#include <deque>
 #include <string>
 #include <unordered_set>
 #include <atomic>
 
 #include "VariableSizeAllocationsManager.hpp"
+#include "IndexWrapper.hpp"
 
 namespace Diligent
 {
@@ -394,7 +397,8 @@ public:
                       RenderDeviceD3D12Impl&      DeviceD3D12Impl,
                       Uint32                      NumDescriptorsInHeap,
                       D3D12_DESCRIPTOR_HEAP_TYPE  Type,
-                      D3D12_DESCRIPTOR_HEAP_FLAGS Flags);
+                      D3D12_DESCRIPTOR_HEAP_FLAGS Flags,
+                      Uint32                      ThreadCacheSize = 0);
 
     // clang-format off
     CPUDescriptorHeap             (const CPUDescriptorHeap&) = delete;
@@ -416,9 +420,30 @@ public:
 private:
     void FreeAllocation(DescriptorHeapAllocation&& Allocation);
 
+    // Allocates descriptors from the heap pool. m_HeapPoolMutex must be locked.
+    DescriptorHeapAllocation AllocateFromPool(Uint32 Count);
+    // Returns descriptors to the heap pool. m_HeapPoolMutex must be locked.
+    void FreeToPool(DescriptorHeapAllocation&& Allocation);
+
+    // Cache of single descriptors used by a group of threads. Threads are assigned
+    // to caches by the hash of their ids, so that the caches are rarely contended
+    // and the pool mutex is only locked once per ThreadCacheSize/2 operations.
+    struct ThreadCache
+    {
+        std::mutex                            Mtx;
+        std::vector<DescriptorHeapAllocation> Descriptors;
+    };
+    static constexpr size_t NumThreadCaches = 16;
+
+    ThreadCache& GetThreadCache();
+    void         FlushThreadCaches();
+
     IMemoryAllocator&      m_MemAllocator;
     RenderDeviceD3D12Impl& m_DeviceD3D12Impl;
 
+    const Uint32                             m_ThreadCacheSize;
+    std::array<ThreadCache, NumThreadCaches> m_ThreadCaches;
+
     // Pool of descriptor heap managers
     std::mutex                                                                                        m_HeapPoolMutex;
     std::vector<DescriptorHeapAllocationManager, STDAllocatorRawMem<DescriptorHeapAllocationManager>> m_HeapPool;
@@ -507,6 +532,7 @@ public:
     const D3D12_DESCRIPTOR_HEAP_DESC& GetHeapDesc() const { return m_HeapDesc; }
     Uint32                            GetMaxStaticDescriptors() const { return m_HeapAllocationManager.GetMaxDescriptors(); }
     Uint32                            GetMaxDynamicDescriptors() const { return m_DynamicAllocationsManager.GetMaxDescriptors(); }
+    RenderDeviceD3D12Impl&            GetDevice() const { return m_DeviceD3D12Impl; }
 
 #ifdef DILIGENT_DEVELOPMENT
     int32_t DvpGetTotalAllocationCount() const
@@ -534,7 +560,9 @@ protected:
 
 // The class facilitates allocation of dynamic descriptor handles. It requests a chunk of heap
 // from the master GPU descriptor heap and then performs linear suballocation within the chunk
-// At the end of the frame all allocations are disposed.
+// At the end of the frame all allocations are disposed, but the chunks are kept by the manager
+// and are reused once the GPU has finished all command buffers that referenced them. This way
+// the master heap (and its mutex) is only accessed when the pool of the manager is exhausted.
 
 //     static and mutable handles     ||                 dynamic space
 //                                    ||    chunk 0                 chunk 2
@@ -574,6 +602,12 @@ public:
     size_t GetSuballocationCount() const { return m_Suballocations.size(); }
 
 private:
+    // Returns a chunk that can hold at least Count descriptors, either from the pool or from the parent heap
+    DescriptorHeapAllocation AcquireChunk(Uint32 Count);
+
+    // Moves the retired chunks that are no longer used by the GPU to the free list
+    void ReclaimRetiredChunks();
+
     // Parent GPU descriptor heap that is used to allocate chunks
     GPUDescriptorHeap& m_ParentGPUHeap;
     const String       m_ManagerName;
@@ -582,13 +616,32 @@ private:
     // of the frame
     std::vector<DescriptorHeapAllocation, STDAllocatorRawMem<DescriptorHeapAllocation>> m_Suballocations;
 
+    // Chunks that were used in the previous frames. A chunk can be reused once all queues in QueueMask
+    // have completed the fence values that were pending when the chunk was retired.
+    struct RetiredChunkList
+    {
+        std::vector<std::pair<SoftwareQueueIndex, Uint64>> FenceValues;
+        std::vector<DescriptorHeapAllocation>              Chunks;
+    };
+    std::deque<RetiredChunkList> m_RetiredChunks;
+
+    // Chunks that are not used by the GPU and can be reused right away
+    std::vector<DescriptorHeapAllocation> m_FreeChunks;
+
     Uint32 m_CurrentSuballocationOffset = 0;
     Uint32 m_DynamicChunkSize           = 0;
 
+    // The size of the next chunk requested from the parent heap. The size grows when a frame
+    // needs more than one chunk to reduce the number of requests to the parent heap.
+    Uint32 m_NextChunkSize = 0;
+    Uint32 m_MaxChunkSize  = 0;
+
     Uint32 m_CurrDescriptorCount         = 0;
     Uint32 m_PeakDescriptorCount         = 0;
     Uint32 m_CurrSuballocationsTotalSize = 0;
     Uint32 m_PeakSuballocationsTotalSize = 0;
+
+    Uint32 m_ParentHeapRequestCount = 0;
 };
 
 } // namespace Diligent
@@ -70,7 +70,7 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceContextD3D12, TDeviceContextBase)
 
     /// Implementation of IDeviceContext::Begin() in Direct3D12 backend.
-    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
+    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags) override final;
 
     /// Implementation of IDeviceContext::SetPipelineState() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
@@ -89,6 +89,9 @@ public:
     /// Implementation of IDeviceContext::SetBlendFactors() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetBlendFactors(const float* pBlendFactors = nullptr) override final;
 
+    /// Implementation of IDeviceContext::SetDynamicStates() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicStates(const DynamicStateAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetVertexBuffers() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
                                                      Uint32                         NumBuffersSet,
@@ -141,6 +144,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndirectCount() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Direct3D12 backend.
@@ -201,6 +208,12 @@ public:
                                                   RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
                                                   RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextureRegions() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextureRegions(ITexture*                      pTexture,
+                                                         const TextureRegionUpdate*     pUpdates,
+                                                         Uint32                         NumUpdates,
+                                                         RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
+
     /// Implementation of IDeviceContext::CopyTexture() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
@@ -227,6 +240,9 @@ public:
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    /// Implementation of IDeviceContext::UpdateTileMappings() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::FinishCommandList() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE FinishCommandList(ICommandList** ppCommandList) override final;
 
@@ -249,6 +265,15 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in Direct3D12 backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(IQuery* pQuery) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -264,6 +289,9 @@ public:
     /// Implementation of IDeviceContext::BuildTLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::CopyBLAS() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final;
 
@@ -297,6 +325,9 @@ public:
     /// Implementation of IDeviceContextD3D12::ID3D12GraphicsCommandList() in Direct3D12 backend.
     virtual ID3D12GraphicsCommandList* DILIGENT_CALL_TYPE GetD3D12CommandList() override final;
 
+    /// Implementation of IDeviceContextD3D12::ExecuteIndirect() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE ExecuteIndirect(const ExecuteIndirectAttribsD3D12& Attribs) override final;
+
     void UpdateBufferRegion(class BufferD3D12Impl*         pBuffD3D12,
                             D3D12DynamicAllocation&        Allocation,
                             Uint64                         DstOffset,
@@ -343,6 +374,8 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews) override final;
+
     D3D12DynamicAllocation AllocateDynamicSpace(size_t NumBytes, size_t Alignment);
 
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
@@ -359,6 +392,12 @@ private:
                Uint32               NumCommandLists = 0,
                ICommandList* const* ppCommandLists  = nullptr);
 
+    // Moves the current command context to the pending submission batch
+    void EnqueueCurrentCmdContext();
+    // Adds command lists to the pending submission batch
+    void EnqueueCommandLists(Uint32               NumCommandLists,
+                             ICommandList* const* ppCommandLists);
+
     __forceinline void RequestCommandContext();
 
     __forceinline void TransitionOrVerifyBufferState(CommandContext&                CmdCtx,
@@ -389,6 +428,15 @@ private:
     __forceinline void PrepareForDispatchCompute(ComputeContext& GraphCtx);
     __forceinline void PrepareForDispatchRays(GraphicsContext& GraphCtx);
 
+    // Transitions the BLAS and the geometry buffers and fills the build description.
+    // pGeometries must have space for TriangleDataCount or BoxDataCount elements.
+    void PrepareBLASBuild(CommandContext&                                     CmdCtx,
+                          const BuildBLASAttribs&                             Attribs,
+                          D3D12_GPU_VIRTUAL_ADDRESS                           ScratchAddress,
+                          D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC& d3d12BuildASDesc,
+                          D3D12_RAYTRACING_GEOMETRY_DESC*                     pGeometries,
+                          const char*                                         OpName);
+
     __forceinline void PrepareIndirectAttribsBuffer(CommandContext&                CmdCtx,
                                                     IBuffer*                       pAttribsBuffer,
                                                     RESOURCE_STATE_TRANSITION_MODE BufferStateTransitionMode,
@@ -396,6 +444,12 @@ private:
                                                     Uint64&                        BuffDataStartByteOffset,
                                                     const char*                    OpName);
 
+    // Returns the command signature for the given argument stride, creating it if necessary
+    ID3D12CommandSignature* GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE ArgType, Uint32 Stride);
+
+    // Returns the user-defined command signature, creating it if necessary
+    ID3D12CommandSignature* GetCustomCommandSignature(const ExecuteIndirectAttribsD3D12& Attribs, ID3D12RootSignature* pd3d12RootSig);
+
     struct RootTableInfo : CommittedShaderResources
     {
         ID3D12RootSignature* pd3d12RootSig = nullptr;
@@ -457,6 +511,27 @@ private:
     CComPtr<ID3D12CommandSignature> m_pDrawMeshIndirectSignature;
     CComPtr<ID3D12CommandSignature> m_pTraceRaysIndirectSignature;
 
+    // Draw and draw indexed command signatures with non-default argument strides, keyed by
+    // (ArgType << 32 | Stride)
+    std::unordered_map<Uint64, CComPtr<ID3D12CommandSignature>> m_CustomStrideDrawSignatures;
+
+    struct CustomCommandSignatureKey
+    {
+        // Keep the root signature alive so that its address is never reused by another one
+        CComPtr<ID3D12RootSignature>              pd3d12RootSig;
+        Uint32                                    ByteStride = 0;
+        std::vector<D3D12_INDIRECT_ARGUMENT_DESC> Arguments;
+
+        bool operator==(const CustomCommandSignatureKey& rhs) const;
+
+        struct Hasher
+        {
+            size_t operator()(const CustomCommandSignatureKey& Key) const;
+        };
+    };
+    // Command signatures created by ExecuteIndirect()
+    std::unordered_map<CustomCommandSignatureKey, CComPtr<ID3D12CommandSignature>, CustomCommandSignatureKey::Hasher> m_CustomCommandSignatures;
+
     D3D12DynamicHeap m_DynamicHeap;
 
     // Every context must use its own allocator that maintains individual list of retired descriptor heaps to
@@ -469,6 +544,17 @@ private:
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_SignalFences;
     std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>> m_WaitFences;
 
+    // Command contexts waiting to be submitted by the next Flush(), in submission order.
+    // Reusable command lists are represented by null contexts and the corresponding elements
+    // of m_PendingD3D12CmdLists; the lists themselves are kept alive by m_PendingReusableCmdLists.
+    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> m_PendingCmdContexts;
+    std::vector<ID3D12CommandList*>                          m_PendingD3D12CmdLists;
+    std::vector<RefCntAutoPtr<ICommandList>>                 m_PendingReusableCmdLists;
+
+    // If true, ExecuteCommandLists() only adds command lists to the pending batch,
+    // see EngineCreateInfo::BatchCommandListSubmission.
+    bool m_BatchCommandListSubmission = false;
+
     struct MappedTextureKey
     {
         TextureD3D12Impl* const Texture;
@@ -490,6 +576,10 @@ private:
 
     Int32 m_ActiveQueriesCounter = 0;
 
+    // Default-heap buffer the binary occlusion query is resolved into for conditional rendering.
+    // The buffer is created on first use and is kept in COMMON state between the blocks.
+    CComPtr<ID3D12Resource> m_pd3d12PredicationBuffer;
+
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
 
     std::vector<D3D12_RENDER_PASS_ENDING_ACCESS_RESOLVE_SUBRESOURCE_PARAMETERS> m_AttachmentResolveInfo;
@@ -48,6 +48,8 @@
 #include "TopLevelASD3D12.h"
 #include "ShaderBindingTableD3D12.h"
 #include "PipelineResourceSignature.h"
+#include "PipelineStateCacheD3D12.h"
+#include "ResourceHeapD3D12.h"
 #include "CommandQueueD3D12.h"
 #include "DeviceContextD3D12.h"
 
@@ -73,6 +75,8 @@ class BottomLevelASD3D12Impl;
 class TopLevelASD3D12Impl;
 class ShaderBindingTableD3D12Impl;
 class PipelineResourceSignatureD3D12Impl;
+class PipelineStateCacheD3D12Impl;
+class ResourceHeapD3D12Impl;
 
 class FixedBlockMemoryAllocator;
 
@@ -103,6 +107,8 @@ struct EngineD3D12ImplTraits
     using ShaderBindingTableInterface        = IShaderBindingTableD3D12;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
     using CommandQueueInterface              = ICommandQueueD3D12;
+    using PipelineStateCacheInterface        = IPipelineStateCacheD3D12;
+    using ResourceHeapInterface              = IResourceHeapD3D12;
 
     using RenderDeviceImplType              = RenderDeviceD3D12Impl;
     using DeviceContextImplType             = DeviceContextD3D12Impl;
@@ -123,6 +129,8 @@ struct EngineD3D12ImplTraits
     using TopLevelASImplType                = TopLevelASD3D12Impl;
     using ShaderBindingTableImplType        = ShaderBindingTableD3D12Impl;
     using PipelineResourceSignatureImplType = PipelineResourceSignatureD3D12Impl;
+    using PipelineStateCacheImplType        = PipelineStateCacheD3D12Impl;
+    using ResourceHeapImplType              = ResourceHeapD3D12Impl;
 
     using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
     using TexViewObjAllocatorType  = FixedBlockMemoryAllocator;
@@ -48,6 +48,9 @@
 /// \file
 /// Implementation of mipmap generation routines
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 namespace Diligent
 {
@@ -55,14 +58,50 @@ namespace Diligent
 class GenerateMipsHelper
 {
 public:
-    GenerateMipsHelper(ID3D12Device* pd3d12Device);
+    explicit GenerateMipsHelper(Uint32 NumContexts);
 
-    void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx) const;
+    // Creates the root signatures, PSOs and counter buffer when it is called for the first time
+    void GenerateMips(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx, Uint32 ContextId);
+
+    // Adds the number of created PSOs and the counter buffer size to Stats
+    void GetStatistics(DeviceHelperStatistics& Stats) const;
+
+    // Maximum number of mip levels generated by a single-pass dispatch
+    static constexpr Uint32 MaxSPDMips = 12;
+    // Maximum number of array slices that single-pass mip generation can process
+    static constexpr Uint32 MaxSPDArraySlices = 2048;
 
 private:
+    void CreateResources(ID3D12Device* pd3d12Device);
+
+    void GenerateMipsCS(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx, RESOURCE_STATE OriginalState, RESOURCE_STATE FinalState) const;
+    void GenerateMipsSPD(ID3D12Device* pd3d12Device, class TextureViewD3D12Impl* pTexView, class CommandContext& Ctx, Uint32 ContextId, RESOURCE_STATE OriginalState, RESOURCE_STATE FinalState) const;
+
+    bool IsSPDSupported(ID3D12Device* pd3d12Device, const class TextureViewD3D12Impl& TexView) const;
+
+    const Uint32 m_NumContexts;
+
+    // Resources are created by the first GenerateMips() call from any context
+    std::once_flag    m_ResourcesCreatedFlag;
+    std::atomic<bool> m_ResourcesCreated{false};
+
     CComPtr<ID3D12RootSignature> m_pGenerateMipsRS;
     CComPtr<ID3D12PipelineState> m_pGenerateMipsLinearPSO[4];
     CComPtr<ID3D12PipelineState> m_pGenerateMipsGammaPSO[4];
+
+    CComPtr<ID3D12RootSignature> m_pGenerateMipsSPDRS;
+    CComPtr<ID3D12PipelineState> m_pGenerateMipsSPDLinearPSO;
+    CComPtr<ID3D12PipelineState> m_pGenerateMipsSPDGammaPSO;
+
+    // Thread group counters, MaxSPDArraySlices per device context
+    CComPtr<ID3D12Resource>       m_pSPDCounter;
+    CComPtr<ID3D12DescriptorHeap> m_pSPDCounterUAVs;
+    UINT                          m_CounterUAVDescriptorSize = 0;
+
+    // Single-pass mip generation reads back mip 6, which requires typed UAV load support
+    // for the format when more than six mip levels are generated.
+    mutable std::mutex                            m_TypedUAVLoadSupportMtx;
+    mutable std::unordered_map<DXGI_FORMAT, bool> m_TypedUAVLoadSupport;
 };
 
 } // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineResourceSignatureD3D12Impl class
 
 #include <array>
+#include <vector>
 
 #include "EngineD3D12ImplTraits.hpp"
 #include "PipelineResourceAttribsD3D12.hpp"
@@ -165,6 +166,11 @@ private:
 
     void Destruct();
 
+    // Writes the CPU descriptor handles of the dynamic samplers in the order they are laid out
+    // in the dynamic sampler allocation. Returns false if any sampler is not bound.
+    bool GetDynamicSamplerTableKey(const ShaderResourceCacheD3D12& ResourceCache,
+                                   std::vector<SIZE_T>&            Key) const;
+
 private:
     ImmutableSamplerAttribs* m_ImmutableSamplers = nullptr; // [m_Desc.NumImmutableSamplers]
 
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheD3D12Impl class
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "EngineD3D12ImplTraits.hpp"
+#include "DeviceObjectBase.hpp"
+
+namespace Diligent
+{
+
+/// Pipeline state cache implementation in Direct3D12 backend.
+class PipelineStateCacheD3D12Impl final : public DeviceObjectBase<IPipelineStateCacheD3D12, RenderDeviceD3D12Impl, PipelineStateCacheDesc>
+{
+public:
+    using TDeviceObjectBase = DeviceObjectBase<IPipelineStateCacheD3D12, RenderDeviceD3D12Impl, PipelineStateCacheDesc>;
+
+    PipelineStateCacheD3D12Impl(IReferenceCounters*                 pRefCounters,
+                                RenderDeviceD3D12Impl*              pDeviceD3D12,
+                                const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheD3D12Impl();
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineStateCacheD3D12, TDeviceObjectBase)
+
+    /// Implementation of IPipelineStateCache::GetData() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    /// Implementation of IPipelineStateCacheD3D12::GetD3D12PipelineLibrary().
+    virtual ID3D12PipelineLibrary* DILIGENT_CALL_TYPE GetD3D12PipelineLibrary() override final { return m_pLibrary; }
+
+    // Returns the pipeline previously stored under the given name, or null if the
+    // library does not contain the pipeline or the description does not match.
+    CComPtr<ID3D12PipelineState> LoadGraphicsPipeline(const wchar_t* Name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc);
+    CComPtr<ID3D12PipelineState> LoadComputePipeline(const wchar_t* Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc);
+
+    void StorePipeline(const wchar_t* Name, ID3D12PipelineState* pd3d12PSO);
+
+    // Returns the root signature created from the serialized blob stored for the given
+    // root signature description key, or null if the cache does not contain the blob.
+    // The key is produced by RootSignatureD3D12 and uniquely identifies the description.
+    CComPtr<ID3D12RootSignature> LoadRootSignature(const std::vector<Uint8>& DescKey);
+
+    void StoreRootSignature(const std::vector<Uint8>& DescKey, const void* pBlob, size_t BlobSize);
+
+private:
+    // Splits the initial data into the pipeline library data and root signature blobs.
+    // Returns the range of the pipeline library data.
+    std::pair<const Uint8*, size_t> ParseInitialData(const Uint8* pData, size_t DataSize);
+
+    // The library references the initial data, so it must be kept alive
+    // for the lifetime of the object.
+    std::vector<Uint8> m_InitialData;
+
+    CComPtr<ID3D12PipelineLibrary> m_pLibrary;
+
+    // Loading the same pipeline from multiple threads must be synchronized by the application.
+    std::mutex m_LibraryMtx;
+
+    // Pipeline libraries only store pipeline states, so serialized root signatures are kept
+    // separately and written to the cache data after the library.
+    struct RootSignatureBlob
+    {
+        std::vector<Uint8> DescKey;
+        std::vector<Uint8> Blob;
+    };
+    std::mutex                                         m_RootSigBlobsMtx;
+    std::unordered_multimap<size_t, RootSignatureBlob> m_RootSigBlobs;
+};
+
+} // namespace Diligent
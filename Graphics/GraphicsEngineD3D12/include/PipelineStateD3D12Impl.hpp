@@ -69,6 +69,9 @@ public:
 
     const RootSignatureD3D12& GetRootSignature() const { return *m_RootSig; }
 
+    // Exchanges the shader objects with another compatible pipeline, see IPipelineState::SwapShaders().
+    void SwapShaderObjects(PipelineStateD3D12Impl& Other);
+
 #ifdef DILIGENT_DEVELOPMENT
     using ShaderResourceCacheArrayType = std::array<ShaderResourceCacheD3D12*, MAX_RESOURCE_SIGNATURES>;
     void DvpVerifySRBResources(const ShaderResourceCacheArrayType& ResourceCaches) const;
@@ -96,8 +99,13 @@ private:
                              TShaderStages&           ShaderStages,
                              LocalRootSignatureD3D12* pLocalRootSig = nullptr);
 
-    void InitRootSignature(TShaderStages&           ShaderStages,
-                           LocalRootSignatureD3D12* pLocalRootSig);
+    void InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo);
+    void InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo);
+    void InitializeRayTracingPipeline(const RayTracingPipelineStateCreateInfo& CreateInfo);
+
+    void InitRootSignature(TShaderStages&               ShaderStages,
+                           LocalRootSignatureD3D12*     pLocalRootSig,
+                           PipelineStateCacheD3D12Impl* pPSOCache);
 
     RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> CreateDefaultResourceSignature(
         TShaderStages&           ShaderStages,
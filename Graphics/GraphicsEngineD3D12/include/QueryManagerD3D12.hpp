@@ -31,8 +31,10 @@
 #include <array>
 #include <deque>
 #include <vector>
+#include <utility>
 
 #include "Query.h"
+#include "GraphicsTypes.h"
 
 namespace Diligent
 {
@@ -69,7 +71,19 @@ public:
     void EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 Index);
     void ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const;
 
+    // Resolves the queries ended in the command context into the readback buffer.
+    // Consecutive heap slots of the same type are resolved with a single ResolveQueryData command.
+    void ResolveQueries(CommandContext& Ctx, std::vector<std::pair<QUERY_TYPE, Uint32>>& Queries) const;
+
+    // Adds the number of created query heaps and the resolve buffer size to Stats
+    void GetStatistics(DeviceHelperStatistics& Stats);
+
 private:
+    void CreateQueryHeap(QUERY_TYPE Type);
+    void CreateResolveBuffer();
+
+    ID3D12Device* const m_pd3d12Device;
+
     struct QueryHeapInfo
     {
         CComPtr<ID3D12QueryHeap> pd3d12QueryHeap;
@@ -85,6 +99,10 @@ private:
 
     // Readback buffer that will contain the query data.
     CComPtr<ID3D12Resource> m_pd3d12ResolveBuffer;
+    Uint64                  m_ResolveBufferSize = 0;
+
+    // The readback buffer is persistently mapped
+    const Uint8* m_pResolveBufferData = nullptr;
 };
 
 } // namespace Diligent
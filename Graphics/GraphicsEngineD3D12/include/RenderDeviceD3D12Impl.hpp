@@ -35,10 +35,13 @@
 #include "EngineD3D12ImplTraits.hpp"
 #include "RenderDeviceD3DBase.hpp"
 #include "RenderDeviceNextGenBase.hpp"
+#include "BindlessIndexAllocator.hpp"
 #include "DescriptorHeap.hpp"
 #include "CommandListManager.hpp"
 #include "CommandContext.hpp"
 #include "D3D12DynamicHeap.hpp"
+#include "D3D12MemoryManager.hpp"
+#include "D3D12ResidencyManager.hpp"
 #include "GenerateMips.hpp"
 #include "QueryManagerD3D12.hpp"
 #include "DXCompiler.hpp"
@@ -150,6 +153,17 @@ public:
                                          IPipelineResourceSignature**         ppSignature,
                                          bool                                 IsDeviceInternal);
 
+    /// Implementation of IRenderDevice::CreatePipelineStateCache() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                             IPipelineStateCache**               ppPSOCache) override final;
+
+    /// Implementation of IRenderDevice::CreateResourceHeap() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateResourceHeap(const ResourceHeapDesc& Desc,
+                                                       IResourceHeap**         ppHeap) override final;
+
+    void CreatePlacedTexture(const TextureDesc& TexDesc, ResourceHeapD3D12Impl* pHeap, Uint64 Offset, ITexture** ppTexture);
+    void CreatePlacedBuffer(const BufferDesc& BuffDesc, ResourceHeapD3D12Impl* pHeap, Uint64 Offset, IBuffer** ppBuffer);
+
     /// Implementation of IRenderDeviceD3D12::GetD3D12Device().
     virtual ID3D12Device* DILIGENT_CALL_TYPE GetD3D12Device() override final { return m_pd3d12Device; }
 
@@ -176,7 +190,17 @@ public:
                                                               RESOURCE_STATE        InitialState,
                                                               ITopLevelAS**         ppTLAS) override final;
 
-    void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig);
+    /// Implementation of IRenderDeviceD3D12::GetRootSignatureCacheStatistics().
+    virtual void DILIGENT_CALL_TYPE GetRootSignatureCacheStatistics(RootSignatureCacheStatistics& Stats) override final
+    {
+        m_RootSignatureCache.GetStatistics(Stats);
+    }
+
+    void CreateRootSignature(const RefCntAutoPtr<class PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                             Uint32                                                         SignatureCount,
+                             size_t                                                         Hash,
+                             class PipelineStateCacheD3D12Impl*                             pPSOCache,
+                             RootSignatureD3D12**                                           ppRootSig);
 
     RootSignatureCacheD3D12& GetRootSignatureCache() { return m_RootSignatureCache; }
 
@@ -186,11 +210,32 @@ public:
     /// Implementation of IRenderDevice::IdleGPU() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::GetMemoryStatistics() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStatistics(RenderDeviceMemoryStatistics& Stats) override final
+    {
+        m_DynamicMemoryManager.GetStatistics(Stats);
+        m_PlacedResourceMgr.GetStatistics(Stats);
+        m_MipsGenerator.GetStatistics(Stats.Helpers);
+        m_QueryMgr.GetStatistics(Stats.Helpers);
+    }
+
+    /// Implementation of IRenderDevice::SetMemoryAllocationCallback() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE SetMemoryAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData) override final
+    {
+        m_DynamicMemoryManager.SetAllocationCallback(Callback, pUserData);
+        m_PlacedResourceMgr.SetAllocationCallback(Callback, pUserData);
+    }
+
     D3D12_COMMAND_LIST_TYPE GetCommandQueueType(SoftwareQueueIndex CmdQueueInd) const
     {
         return GetCommandQueue(CmdQueueInd).GetD3D12CommandQueueDesc().Type;
     }
 
+    // Returns heap node masks for a default-heap resource used by the contexts in ImmediateContextMask.
+    // On a multi-node adapter, the resource is created on the node of the first context's queue
+    // and is visible to all nodes so that other nodes can access it through cross-node copies.
+    void GetResourceNodeMasks(Uint64 ImmediateContextMask, UINT& CreationNodeMask, UINT& VisibleNodeMask) const;
+
     using PooledCommandContext = std::unique_ptr<CommandContext, STDDeleterRawMem<CommandContext>>;
     PooledCommandContext AllocateCommandContext(SoftwareQueueIndex CommandQueueId, const Char* ID = "");
 
@@ -201,7 +246,8 @@ public:
                                           PooledCommandContext                                   pContexts[],
                                           bool                                                   DiscardStaleObjects,
                                           std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences,
-                                          std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences);
+                                          std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences,
+                                          ID3D12CommandList* const*                              ppReusableCmdLists = nullptr);
 
     void SignalFences(SoftwareQueueIndex CommandQueueId, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>& SignalFences);
     void WaitFences(SoftwareQueueIndex CommandQueueId, std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>& WaitFences);
@@ -209,12 +255,21 @@ public:
     // Disposes an unused command context
     void DisposeCommandContext(PooledCommandContext&& Ctx);
 
+    // Returns the closed command context of a reusable command list and its allocator to the pools
+    // once the last submission of the command list has completed.
+    void ReleaseReusableCommandContext(PooledCommandContext&&            Ctx,
+                                       CComPtr<ID3D12CommandAllocator>&& pAllocator,
+                                       SoftwareQueueIndex                CommandQueueId,
+                                       Uint64                            FenceValue);
+
     void FlushStaleResources(SoftwareQueueIndex CommandQueueId);
 
     /// Implementation of IRenderDevice::() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
 
     D3D12DynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
+    D3D12MemoryManager&        GetPlacedResourceManager() { return m_PlacedResourceMgr; }
+    D3D12ResidencyManager&     GetResidencyManager() { return m_ResidencyMgr; }
 
     GPUDescriptorHeap& GetGPUDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE Type)
     {
@@ -222,8 +277,18 @@ public:
         return m_GPUDescriptorHeaps[Type];
     }
 
-    const GenerateMipsHelper& GetMipsGenerator() const { return m_MipsGenerator; }
-    QueryManagerD3D12&        GetQueryManager() { return m_QueryMgr; }
+    // Copies the descriptor into the bindless range of the shader-visible CBV/SRV/UAV heap
+    // and returns its persistent index, or INVALID_BINDLESS_INDEX if the heap is disabled or full.
+    Uint32 AddBindlessDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE CPUHandle);
+
+    // Releases the index once the GPU is done with all command lists submitted to the queues in CmdQueueMask
+    void RemoveBindlessDescriptor(Uint32 Index, Uint64 CmdQueueMask);
+
+    // Returns the GPU handle of the first descriptor in the bindless range
+    D3D12_GPU_DESCRIPTOR_HANDLE GetBindlessHeapGPUHandle() const { return m_BindlessHeap.GetGpuHandle(); }
+
+    GenerateMipsHelper& GetMipsGenerator() { return m_MipsGenerator; }
+    QueryManagerD3D12&  GetQueryManager() { return m_QueryMgr; }
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
@@ -260,6 +325,10 @@ private:
     GPUDescriptorHeap m_GPUDescriptorHeaps[2]; // D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV == 0
                                                // D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER	 == 1
 
+    // Range of the static part of the shader-visible CBV/SRV/UAV heap reserved for bindless descriptors
+    DescriptorHeapAllocation                m_BindlessHeap;
+    std::unique_ptr<BindlessIndexAllocator> m_pBindlessIndexAllocator;
+
     CommandListManager m_CmdListManagers[3];
 
     std::mutex                                                                  m_ContextPoolMutex;
@@ -270,6 +339,14 @@ private:
 
     D3D12DynamicMemoryManager m_DynamicMemoryManager;
 
+    // Placed resource heap pages register in the residency manager, so it
+    // must be destroyed after the placed resource manager.
+    D3D12ResidencyManager m_ResidencyMgr;
+
+    // Placed resource heaps for buffers and textures. Must be destroyed after
+    // all resources have been released by ReleaseStaleResources().
+    D3D12MemoryManager m_PlacedResourceMgr;
+
     // Note: mips generator must be released after the device has been idled
     GenerateMipsHelper m_MipsGenerator;
 
@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ResourceHeapD3D12Impl class
+
+#include "EngineD3D12ImplTraits.hpp"
+#include "ResourceHeapBase.hpp"
+
+namespace Diligent
+{
+
+/// Resource heap implementation in Direct3D12 backend.
+class ResourceHeapD3D12Impl final : public ResourceHeapBase<EngineD3D12ImplTraits>
+{
+public:
+    using TResourceHeapBase = ResourceHeapBase<EngineD3D12ImplTraits>;
+
+    ResourceHeapD3D12Impl(IReferenceCounters*     pRefCounters,
+                          RenderDeviceD3D12Impl*  pDeviceD3D12,
+                          const ResourceHeapDesc& Desc);
+    ~ResourceHeapD3D12Impl();
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ResourceHeapD3D12, TResourceHeapBase)
+
+    /// Implementation of IResourceHeap::GetTextureAllocationInfo() in Direct3D12 backend.
+    virtual ResourceAllocationInfo DILIGENT_CALL_TYPE GetTextureAllocationInfo(const TextureDesc& TexDesc) const override final;
+
+    /// Implementation of IResourceHeap::GetBufferAllocationInfo() in Direct3D12 backend.
+    virtual ResourceAllocationInfo DILIGENT_CALL_TYPE GetBufferAllocationInfo(const BufferDesc& BuffDesc) const override final;
+
+    /// Implementation of IResourceHeap::CreateTexture() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateTexture(const TextureDesc& TexDesc, Uint64 Offset, ITexture** ppTexture) override final;
+
+    /// Implementation of IResourceHeap::CreateBuffer() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE CreateBuffer(const BufferDesc& BuffDesc, Uint64 Offset, IBuffer** ppBuffer) override final;
+
+    /// Implementation of IResourceHeapD3D12::GetD3D12Heap().
+    virtual ID3D12Heap* DILIGENT_CALL_TYPE GetD3D12Heap() const override final { return m_pd3d12Heap; }
+
+private:
+    CComPtr<ID3D12Heap> m_pd3d12Heap;
+    D3D12_HEAP_FLAGS    m_d3d12HeapFlags = D3D12_HEAP_FLAG_NONE;
+};
+
+} // namespace Diligent
@@ -50,11 +50,13 @@
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "PrivateConstants.h"
 #include "ShaderResources.hpp"
 #include "ObjectBase.hpp"
 #include "ResourceBindingMap.hpp"
+#include "RenderDeviceD3D12.h"
 
 namespace Diligent
 {
@@ -62,6 +64,7 @@ namespace Diligent
 class RenderDeviceD3D12Impl;
 class RootSignatureCacheD3D12;
 class PipelineResourceSignatureD3D12Impl;
+class PipelineStateCacheD3D12Impl;
 
 /// Implementation of the Diligent::RootSignature class
 class RootSignatureD3D12 final : public ObjectBase<IObject>
@@ -71,7 +74,8 @@ public:
                        RenderDeviceD3D12Impl*                                  pDeviceD3D12Impl,
                        const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[],
                        Uint32                                                  SignatureCount,
-                       size_t                                                  Hash);
+                       size_t                                                  Hash,
+                       PipelineStateCacheD3D12Impl*                            pPSOCache);
     ~RootSignatureD3D12();
 
     size_t GetHash() const { return m_Hash; }
@@ -110,6 +114,15 @@ public:
 
     bool IsCompatibleWith(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[], Uint32 SignatureCount) const noexcept;
 
+    // Returns true if the root signature was created from a serialized blob found in the pipeline state cache
+    bool IsLoadedFromPSOCache() const { return m_LoadedFromPSOCache; }
+
+    // Stores the serialized root signature in the pipeline state cache
+    void StoreInPSOCache(PipelineStateCacheD3D12Impl& PSOCache) const;
+
+    // Returns the key that identifies the root signature description in pipeline state caches
+    const std::vector<Uint8>& GetDescKey() const { return m_DescKey; }
+
 private:
     // The number of pipeline resource signatures used to initialize this root signature.
     const Uint32 m_SignatureCount;
@@ -122,6 +135,14 @@ private:
 
     CComPtr<ID3D12RootSignature> m_pd3d12RootSignature;
 
+    // Key that identifies the root signature description in pipeline state caches
+    std::vector<Uint8> m_DescKey;
+
+    // Serialized root signature. Empty if the root signature was loaded from a pipeline state cache.
+    std::vector<Uint8> m_SerializedBlob;
+
+    bool m_LoadedFromPSOCache = false;
+
     struct ResourceSignatureInfo
     {
         RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> pSignature;
@@ -179,7 +200,14 @@ public:
 
     ~RootSignatureCacheD3D12();
 
-    RefCntAutoPtr<RootSignatureD3D12> GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount);
+    // Returns the root signature for the given combination of resource signatures. If a new root signature
+    // needs to be created and pPSOCache is not null, the serialized root signature is loaded from
+    // or stored in the pipeline state cache.
+    RefCntAutoPtr<RootSignatureD3D12> GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                 Uint32                                                   SignatureCount,
+                                                 PipelineStateCacheD3D12Impl*                             pPSOCache);
+
+    void GetStatistics(RootSignatureCacheStatistics& Stats);
 
     void OnDestroyRootSig(RootSignatureD3D12* pRootSig);
 
@@ -188,6 +216,9 @@ private:
 
     std::mutex                                                         m_RootSigCacheMtx;
     std::unordered_multimap<size_t, RefCntWeakPtr<RootSignatureD3D12>> m_RootSigCache;
+
+    // Protected by m_RootSigCacheMtx
+    RootSignatureCacheStatistics m_Stats;
 };
 
 } // namespace Diligent
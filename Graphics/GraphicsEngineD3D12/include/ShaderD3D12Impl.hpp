@@ -63,6 +63,13 @@ public:
         ResourceDesc = m_pShaderResources->GetHLSLShaderResourceDesc(Index);
     }
 
+    /// Implementation of IShader::GetBytecode() in Direct3D12 backend.
+    virtual void DILIGENT_CALL_TYPE GetBytecode(const void** ppBytecode, Uint64& Size) const override final
+    {
+        *ppBytecode = m_pShaderByteCode->GetBufferPointer();
+        Size        = m_pShaderByteCode->GetBufferSize();
+    }
+
     /// Implementation of IShaderD3D::GetHLSLResource() in Direct3D12 backend.
     virtual void DILIGENT_CALL_TYPE GetHLSLResource(Uint32 Index, HLSLShaderResourceDesc& ResourceDesc) const override final
     {
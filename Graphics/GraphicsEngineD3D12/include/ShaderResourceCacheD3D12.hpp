@@ -331,6 +331,10 @@ public:
     // Transitions all resources in the cache
     void TransitionResourceStates(CommandContext& Ctx, StateTransitionMode Mode);
 
+    // Records the use of all buffers and textures in the cache by the command context,
+    // see D3D12ResidencyManager.
+    void AddResidencyUsage(CommandContext& Ctx);
+
     ResourceCacheContentType GetContentType() const { return m_ContentType; }
 
     // Returns the bitmask indicating root views with bound dynamic buffers (including buffer ranges)
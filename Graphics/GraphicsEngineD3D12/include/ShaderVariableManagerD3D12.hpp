@@ -131,6 +131,7 @@ private:
     // These methods can't be defined in the header due to dependency on PipelineResourceSignatureD3D12Impl
     const PipelineResourceDesc& GetResourceDesc(Uint32 Index) const;
     const ResourceAttribs&      GetResourceAttribs(Uint32 Index) const;
+    size_t                      GetResourceNameHash(Uint32 Index) const;
 
 private:
     Uint32 m_NumVariables = 0;
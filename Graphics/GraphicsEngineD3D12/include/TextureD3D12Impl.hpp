@@ -34,6 +34,7 @@
 #include "TextureBase.hpp"
 #include "TextureViewD3D12Impl.hpp"
 #include "D3D12ResourceBase.hpp"
+#include "D3D12MemoryManager.hpp"
 
 namespace Diligent
 {
@@ -46,11 +47,13 @@ public:
     using ViewImplType = TextureViewD3D12Impl;
 
     // Creates a new D3D12 resource
-    TextureD3D12Impl(IReferenceCounters*        pRefCounters,
-                     FixedBlockMemoryAllocator& TexViewObjAllocator,
-                     RenderDeviceD3D12Impl*     pDeviceD3D12,
-                     const TextureDesc&         TexDesc,
-                     const TextureData*         pInitData = nullptr);
+    TextureD3D12Impl(IReferenceCounters*          pRefCounters,
+                     FixedBlockMemoryAllocator&   TexViewObjAllocator,
+                     RenderDeviceD3D12Impl*       pDeviceD3D12,
+                     const TextureDesc&           TexDesc,
+                     const TextureData*           pInitData  = nullptr,
+                     class ResourceHeapD3D12Impl* pHeap      = nullptr,
+                     Uint64                       HeapOffset = 0);
 
     // Attaches to an existing D3D12 resource
     TextureD3D12Impl(IReferenceCounters*          pRefCounters,
@@ -75,7 +78,11 @@ public:
     /// Implementation of ITextureD3D12::GetD3D12ResourceState().
     virtual D3D12_RESOURCE_STATES DILIGENT_CALL_TYPE GetD3D12ResourceState() const override final;
 
-    D3D12_RESOURCE_DESC GetD3D12TextureDesc() const;
+    static D3D12_RESOURCE_DESC GetD3D12TextureDesc(const TextureDesc& TexDesc);
+
+    // Returns the residency object of the committed resource or of the placed resource heap page
+    // that contains the texture, or null if the texture is not tracked by the residency manager.
+    D3D12ResidencyObject* GetResidencyObject() const { return m_pResidencyObject; }
 
     const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& GetStagingFootprint(Uint32 Subresource)
     {
@@ -93,7 +100,20 @@ protected:
     void CreateDSV(TextureViewDesc& DSVDesc, D3D12_CPU_DESCRIPTOR_HANDLE DSVHandle);
     void CreateUAV(TextureViewDesc& UAVDesc, D3D12_CPU_DESCRIPTOR_HANDLE UAVHandle);
 
+    // Initializes m_SparseProps from the tiling of the reserved resource
+    void InitSparseProperties();
+
     D3D12_PLACED_SUBRESOURCE_FOOTPRINT* m_StagingFootprints = nullptr;
+
+    // Resource heap the texture is placed in, if any
+    RefCntAutoPtr<IResourceHeap> m_pHeap;
+
+    // Memory of the placed resource heap page the texture is suballocated from, if any
+    D3D12MemoryAllocation m_MemoryAllocation;
+
+    // Residency of the committed resource, if it is tracked by the residency manager
+    D3D12ResidencyHandle  m_ResidencyHandle;
+    D3D12ResidencyObject* m_pResidencyObject = nullptr;
 };
 
 } // namespace Diligent
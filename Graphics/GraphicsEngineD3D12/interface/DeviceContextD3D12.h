@@ -39,6 +39,62 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextD3D12 =
     {0xdde9e3ab, 0x5109, 0x4026, {0x92, 0xb7, 0xf5, 0xe7, 0xec, 0x83, 0xe2, 0x1e}};
 
+// clang-format off
+
+/// Attributes of the IDeviceContextD3D12::ExecuteIndirect() command.
+struct ExecuteIndirectAttribsD3D12
+{
+    /// A pointer to the array of NumArguments indirect argument descriptions that
+    /// define the layout of a single command in the arguments buffer.
+
+    /// The last argument must be one of D3D12_INDIRECT_ARGUMENT_TYPE_DRAW,
+    /// D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH or
+    /// D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH. The preceding arguments may change
+    /// vertex and index buffer views as well as root constants and root descriptors.
+    /// Root parameter indices refer to the root signature of the currently bound pipeline state,
+    /// see IPipelineStateD3D12::GetD3D12RootSignature().
+    const D3D12_INDIRECT_ARGUMENT_DESC* pArguments DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pArguments array.
+    Uint32     NumArguments         DEFAULT_INITIALIZER(0);
+
+    /// The size of a single command in the arguments buffer, in bytes.
+    Uint32     ByteStride           DEFAULT_INITIALIZER(0);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS. Ignored for dispatch commands.
+    DRAW_FLAGS Flags                DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The type of the elements in the index buffer bound by IDeviceContext::SetIndexBuffer().
+    /// Only used by indexed draw commands that do not change the index buffer view.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE IndexType            DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// The maximum number of commands to execute. If pCountBuffer is null,
+    /// exactly this number of commands is executed.
+    Uint32     MaxCommandCount      DEFAULT_INITIALIZER(1);
+
+    /// The buffer that contains the command arguments.
+    IBuffer*   pArgsBuffer          DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the arguments buffer to the first command.
+    Uint64     ArgsBufferOffset     DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the arguments buffer.
+    RESOURCE_STATE_TRANSITION_MODE ArgsBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    /// Optional buffer that contains the number of commands to execute.
+    IBuffer*   pCountBuffer         DEFAULT_INITIALIZER(nullptr);
+
+    /// Offset from the beginning of the count buffer to the command counter.
+    Uint64     CountBufferOffset    DEFAULT_INITIALIZER(0);
+
+    /// State transition mode for the count buffer.
+    RESOURCE_STATE_TRANSITION_MODE CountBufferStateTransitionMode DEFAULT_INITIALIZER(RESOURCE_STATE_TRANSITION_MODE_NONE);
+};
+typedef struct ExecuteIndirectAttribsD3D12 ExecuteIndirectAttribsD3D12;
+
+// clang-format on
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextD3D12
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -85,6 +141,24 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextD3D12, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL ID3D12GraphicsCommandList* METHOD(GetD3D12CommandList)(THIS) PURE;
+
+    /// Executes indirect commands with a user-defined command signature.
+
+    /// \param [in] Attribs - Command attributes, see Diligent::ExecuteIndirectAttribsD3D12.
+    ///
+    /// \remarks Unlike IDeviceContext::DrawIndirect() and similar methods, every command may change
+    ///          vertex and index buffer views, root constants and root descriptors before
+    ///          issuing a draw or a dispatch, which allows encoding a whole pass with a single call.\n
+    ///          The engine creates and caches the D3D12 command signature. Vertex buffers, index buffer and
+    ///          root arguments that are changed by the command signature are re-committed by the engine
+    ///          before the next draw or dispatch command.\n
+    ///          Vertex buffers required by the pipeline state must still be bound by IDeviceContext::SetVertexBuffers();
+    ///          the command signature overrides the views in the slots it changes. The same applies to the index
+    ///          buffer for indexed draw commands that do not change the index buffer view.
+    ///
+    /// \remarks Supported contexts: graphics, compute (dispatch commands only).
+    VIRTUAL void METHOD(ExecuteIndirect)(THIS_
+                                         const ExecuteIndirectAttribsD3D12 REF Attribs) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -97,6 +171,7 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContextD3D12_TransitionTextureState(This, ...) CALL_IFACE_METHOD(DeviceContextD3D12, TransitionTextureState,This, __VA_ARGS__)
 #    define IDeviceContextD3D12_TransitionBufferState(This, ...)  CALL_IFACE_METHOD(DeviceContextD3D12, TransitionBufferState, This, __VA_ARGS__)
 #    define IDeviceContextD3D12_GetD3D12CommandList(This)         CALL_IFACE_METHOD(DeviceContextD3D12, GetD3D12CommandList,   This)
+#    define IDeviceContextD3D12_ExecuteIndirect(This, ...)        CALL_IFACE_METHOD(DeviceContextD3D12, ExecuteIndirect,       This, __VA_ARGS__)
 
 // clang-format on
 
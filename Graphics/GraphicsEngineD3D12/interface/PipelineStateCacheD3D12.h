@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Definition of the Diligent::IPipelineStateCacheD3D12 interface
+
+#include "../../GraphicsEngine/interface/PipelineStateCache.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {D948C970-9B3E-4CB3-8094-B4DC4ECDFED7}
+static const INTERFACE_ID IID_PipelineStateCacheD3D12 =
+    {0xd948c970, 0x9b3e, 0x4cb3, {0x80, 0x94, 0xb4, 0xdc, 0x4e, 0xcd, 0xfe, 0xd7}};
+
+#define DILIGENT_INTERFACE_NAME IPipelineStateCacheD3D12
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+// clang-format off
+
+#define IPipelineStateCacheD3D12InclusiveMethods \
+    IPipelineStateCacheInclusiveMethods;         \
+    IPipelineStateCacheD3D12Methods PipelineStateCacheD3D12
+
+/// Exposes Direct3D12-specific functionality of a pipeline state cache object.
+DILIGENT_BEGIN_INTERFACE(IPipelineStateCacheD3D12, IPipelineStateCache)
+{
+    /// Returns a pointer to the ID3D12PipelineLibrary interface of the internal Direct3D12 object.
+
+    /// The method does *NOT* call AddRef() on the returned interface,
+    /// so Release() must not be called.
+    VIRTUAL ID3D12PipelineLibrary* METHOD(GetD3D12PipelineLibrary)(THIS) PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IPipelineStateCacheD3D12_GetD3D12PipelineLibrary(This) CALL_IFACE_METHOD(PipelineStateCacheD3D12, GetD3D12PipelineLibrary, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
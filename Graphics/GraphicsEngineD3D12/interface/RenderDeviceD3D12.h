@@ -38,6 +38,28 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceD3D12 =
     {0xc7987c98, 0x87fe, 0x4309, {0xae, 0x88, 0xe9, 0x8f, 0x4, 0x4b, 0x0, 0xf6}};
 
+// clang-format off
+
+/// Root signature cache statistics, see IRenderDeviceD3D12::GetRootSignatureCacheStatistics().
+struct RootSignatureCacheStatistics
+{
+    /// The number of root signatures currently in the cache.
+    Uint32 NumRootSignatures DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that shared an existing root signature.
+    Uint64 NumHits           DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline states that required a new root signature.
+    Uint64 NumMisses         DEFAULT_INITIALIZER(0);
+
+    /// The number of new root signatures that were created from a serialized blob
+    /// found in the pipeline state cache rather than serialized from scratch.
+    Uint64 NumBlobsLoaded    DEFAULT_INITIALIZER(0);
+};
+typedef struct RootSignatureCacheStatistics RootSignatureCacheStatistics;
+
+// clang-format on
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceD3D12
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -117,6 +139,17 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceD3D12, IRenderDevice)
                                                    const TopLevelASDesc REF Desc,
                                                    RESOURCE_STATE           InitialState,
                                                    ITopLevelAS**            ppTLAS) PURE;
+
+    /// Returns the statistics of the device's root signature cache.
+
+    /// \param [out] Stats - Root signature cache statistics, see Diligent::RootSignatureCacheStatistics.
+    ///
+    /// \remarks Pipeline states with compatible resource signatures share the same root signature.
+    ///          When a new root signature is required and the pipeline is created with a pipeline
+    ///          state cache (see PipelineStateCreateInfo::pPSOCache), the serialized root signature
+    ///          is stored in the cache and loaded from it next time the cache data is used.
+    VIRTUAL void METHOD(GetRootSignatureCacheStatistics)(THIS_
+                                                         RootSignatureCacheStatistics REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -126,11 +159,12 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IRenderDeviceD3D12_GetD3D12Device(This)                    CALL_IFACE_METHOD(RenderDeviceD3D12, GetD3D12Device,               This)
-#    define IRenderDeviceD3D12_CreateTextureFromD3DResource(This, ...) CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTextureFromD3DResource, This, __VA_ARGS__)
-#    define IRenderDeviceD3D12_CreateBufferFromD3DResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBufferFromD3DResource,  This, __VA_ARGS__)
-#    define IRenderDeviceD3D12_CreateBLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBLASFromD3DResource,    This, __VA_ARGS__)
-#    define IRenderDeviceD3D12_CreateTLASFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTLASFromD3DResource,    This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_GetD3D12Device(This)                       CALL_IFACE_METHOD(RenderDeviceD3D12, GetD3D12Device,                  This)
+#    define IRenderDeviceD3D12_CreateTextureFromD3DResource(This, ...)    CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTextureFromD3DResource,    This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_CreateBufferFromD3DResource(This, ...)     CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBufferFromD3DResource,     This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_CreateBLASFromD3DResource(This, ...)       CALL_IFACE_METHOD(RenderDeviceD3D12, CreateBLASFromD3DResource,       This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_CreateTLASFromD3DResource(This, ...)       CALL_IFACE_METHOD(RenderDeviceD3D12, CreateTLASFromD3DResource,       This, __VA_ARGS__)
+#    define IRenderDeviceD3D12_GetRootSignatureCacheStatistics(This, ...) CALL_IFACE_METHOD(RenderDeviceD3D12, GetRootSignatureCacheStatistics, This, __VA_ARGS__)
 
 // clang-format on
 
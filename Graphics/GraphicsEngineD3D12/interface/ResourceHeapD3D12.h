@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Definition of the Diligent::IResourceHeapD3D12 interface
+
+#include "../../GraphicsEngine/interface/ResourceHeap.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {0E7A2C58-93D1-4B6F-A4E2-7C5B19F8D306}
+static const INTERFACE_ID IID_ResourceHeapD3D12 =
+    {0x0e7a2c58, 0x93d1, 0x4b6f, {0xa4, 0xe2, 0x7c, 0x5b, 0x19, 0xf8, 0xd3, 0x06}};
+
+#define DILIGENT_INTERFACE_NAME IResourceHeapD3D12
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+// clang-format off
+
+#define IResourceHeapD3D12InclusiveMethods \
+    IResourceHeapInclusiveMethods;         \
+    IResourceHeapD3D12Methods ResourceHeapD3D12
+
+/// Exposes Direct3D12-specific functionality of a resource heap object.
+DILIGENT_BEGIN_INTERFACE(IResourceHeapD3D12, IResourceHeap)
+{
+    /// Returns a pointer to the ID3D12Heap interface of the internal Direct3D12 object.
+
+    /// The method does *NOT* call AddRef() on the returned interface,
+    /// so Release() must not be called.
+    VIRTUAL ID3D12Heap* METHOD(GetD3D12Heap)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IResourceHeapD3D12_GetD3D12Heap(This) CALL_IFACE_METHOD(ResourceHeapD3D12, GetD3D12Heap, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -0,0 +1,225 @@
+// Single-pass mip generation.
+// Every thread group downsamples a 64x64 tile of the source mip level to a single texel of mip 6.
+// The last group to finish an array slice then downsamples mip 6 to generate mips 7 through 12.
+// Every downsampling step must be exactly 2:1 (or 1:1 when the dimension is already 1), so the
+// source mip dimensions must be powers of two.
+
+#define RootSig \
+	"RootFlags(0), " \
+	"RootConstants(b0, num32BitConstants = 4), " \
+	"DescriptorTable(SRV(t0, numDescriptors = 1))," \
+	"DescriptorTable(UAV(u0, numDescriptors = 13))," \
+	"StaticSampler(s0," \
+		"addressU = TEXTURE_ADDRESS_CLAMP," \
+		"addressV = TEXTURE_ADDRESS_CLAMP," \
+		"addressW = TEXTURE_ADDRESS_CLAMP," \
+		"filter = FILTER_MIN_MAG_MIP_LINEAR)"
+
+// Mip levels are relative to the source mip level
+RWTexture2DArray<float4> OutMip1  : register(u0);
+RWTexture2DArray<float4> OutMip2  : register(u1);
+RWTexture2DArray<float4> OutMip3  : register(u2);
+RWTexture2DArray<float4> OutMip4  : register(u3);
+RWTexture2DArray<float4> OutMip5  : register(u4);
+// Mip 6 is read by the last thread group
+globallycoherent RWTexture2DArray<float4> OutMip6 : register(u5);
+RWTexture2DArray<float4> OutMip7  : register(u6);
+RWTexture2DArray<float4> OutMip8  : register(u7);
+RWTexture2DArray<float4> OutMip9  : register(u8);
+RWTexture2DArray<float4> OutMip10 : register(u9);
+RWTexture2DArray<float4> OutMip11 : register(u10);
+RWTexture2DArray<float4> OutMip12 : register(u11);
+
+// The number of thread groups that have finished each array slice.
+// The last group resets the counter, so it is zero at the beginning of every dispatch.
+globallycoherent RWBuffer<uint> SPDCounter : register(u12);
+
+Texture2DArray<float4> SrcTex : register(t0);
+SamplerState BilinearClamp : register(s0);
+
+cbuffer CB : register(b0)
+{
+	int2 SrcMipSize;   // Dimensions of the source mip level
+	int  NumMipLevels; // Number of mip levels to generate: [1, 12]
+	int  NumGroups;    // Number of thread groups per array slice
+}
+
+// 32x32 tile of the current mip level.
+// The reason for separating channels is to reduce bank conflicts in the
+// local data memory controller.  A large stride will cause more threads
+// to collide on the same memory bank.
+groupshared float gs_R[1024];
+groupshared float gs_G[1024];
+groupshared float gs_B[1024];
+groupshared float gs_A[1024];
+
+groupshared uint gs_Counter;
+
+void StoreColor( int2 Pos, float4 Color )
+{
+	int Index = Pos.y * 32 + Pos.x;
+	gs_R[Index] = Color.r;
+	gs_G[Index] = Color.g;
+	gs_B[Index] = Color.b;
+	gs_A[Index] = Color.a;
+}
+
+float4 LoadColor( int2 Pos )
+{
+	int Index = Pos.y * 32 + Pos.x;
+	return float4( gs_R[Index], gs_G[Index], gs_B[Index], gs_A[Index]);
+}
+
+float3 LinearToSRGB(float3 x)
+{
+	// This is exactly the sRGB curve
+	//return x < 0.0031308 ? 12.92 * x : 1.055 * pow(abs(x), 1.0 / 2.4) - 0.055;
+	 
+	// This is cheaper but nearly equivalent
+	return x < 0.0031308 ? 12.92 * x : 1.13005 * sqrt(abs(x - 0.00228)) - 0.13448 * x + 0.005719;
+}
+
+float3 SRGBToLinear(float3 x)
+{
+	return x <= 0.04045 ? x / 12.92 : pow((x + 0.055) / 1.055, 2.4);
+}
+
+float4 PackColor(float4 Linear)
+{
+#ifdef CONVERT_TO_SRGB
+	return float4(LinearToSRGB(Linear.rgb), Linear.a);
+#else
+	return Linear;
+#endif
+}
+
+float4 UnpackColor(float4 Packed)
+{
+#ifdef CONVERT_TO_SRGB
+	return float4(SRGBToLinear(Packed.rgb), Packed.a);
+#else
+	return Packed;
+#endif
+}
+
+void StoreMip(int Mip, uint3 Coord, float4 Color)
+{
+	Color = PackColor(Color);
+	switch (Mip)
+	{
+		case 1:  OutMip1[Coord]  = Color; break;
+		case 2:  OutMip2[Coord]  = Color; break;
+		case 3:  OutMip3[Coord]  = Color; break;
+		case 4:  OutMip4[Coord]  = Color; break;
+		case 5:  OutMip5[Coord]  = Color; break;
+		case 6:  OutMip6[Coord]  = Color; break;
+		case 7:  OutMip7[Coord]  = Color; break;
+		case 8:  OutMip8[Coord]  = Color; break;
+		case 9:  OutMip9[Coord]  = Color; break;
+		case 10: OutMip10[Coord] = Color; break;
+		case 11: OutMip11[Coord] = Color; break;
+		case 12: OutMip12[Coord] = Color; break;
+	}
+}
+
+int2 GetMipSize(int Mip)
+{
+	return max(SrcMipSize >> Mip, int2(1, 1));
+}
+
+// Generates up to five mip levels from the 32x32 tile of TileMip level stored in the shared memory.
+// Texels outside of the mip level are clamped to the edge, so that every texel of the next
+// level is the average of four texels of the current one.
+void DownsampleTile(uint GI, int2 TileId, uint ArraySlice, int TileMip)
+{
+	int LastMip = min(TileMip + 5, NumMipLevels);
+	for (int Mip = TileMip + 1; Mip <= LastMip; ++Mip)
+	{
+		int   TileSize = 32 >> (Mip - TileMip);
+		int2  Origin   = TileId * TileSize;
+		int2  MipSize  = GetMipSize(Mip);
+		bool  IsActive = GI < uint(TileSize * TileSize);
+		int2  Pos      = int2(int(GI) % TileSize, int(GI) / TileSize);
+
+		GroupMemoryBarrierWithGroupSync();
+
+		float4 Color = 0;
+		if (IsActive)
+		{
+			int2 SrcPos = (min(Origin + Pos, MipSize - 1) - Origin) * 2;
+			Color = 0.25 * (LoadColor(SrcPos) + LoadColor(SrcPos + int2(1, 0)) +
+			                LoadColor(SrcPos + int2(0, 1)) + LoadColor(SrcPos + int2(1, 1)));
+		}
+
+		GroupMemoryBarrierWithGroupSync();
+
+		if (IsActive)
+		{
+			StoreColor(Pos, Color);
+			if (all(Origin + Pos < MipSize))
+				StoreMip(Mip, uint3(Origin + Pos, ArraySlice), Color);
+		}
+	}
+}
+
+[RootSignature(RootSig)]
+[numthreads( 256, 1, 1 )]
+void main( uint GI : SV_GroupIndex, uint3 Gid : SV_GroupID )
+{
+	int2 TileId     = int2(Gid.xy);
+	uint ArraySlice = Gid.z;
+
+	// Every thread computes four texels of the 32x32 tile of mip 1. Every texel of mip 1
+	// is the bilinear sample at the shared corner of the four source texels.
+	int2 Mip1Size = GetMipSize(1);
+	[unroll]
+	for (int i = 0; i < 4; ++i)
+	{
+		int2   Pos   = int2(int(GI) % 32, int(GI) / 32 + i * 8);
+		int2   Coord = TileId * 32 + Pos;
+		float2 UV    = (float2(min(Coord, Mip1Size - 1)) * 2.0 + 1.0) / float2(SrcMipSize);
+		float4 Color = SrcTex.SampleLevel(BilinearClamp, float3(UV, ArraySlice), 0);
+		StoreColor(Pos, Color);
+		if (all(Coord < Mip1Size))
+			StoreMip(1, uint3(Coord, ArraySlice), Color);
+	}
+
+	DownsampleTile(GI, TileId, ArraySlice, 1);
+
+	// A scalar (constant) branch can exit all threads coherently.
+	if (NumMipLevels <= 6)
+		return;
+
+	// Make mip 6 texel visible to the last group and count the finished groups
+	DeviceMemoryBarrierWithGroupSync();
+	if (GI == 0)
+		InterlockedAdd(SPDCounter[ArraySlice], 1, gs_Counter);
+	GroupMemoryBarrierWithGroupSync();
+
+	if (gs_Counter != uint(NumGroups - 1))
+		return;
+
+	// This is the last group: reset the counter for the next dispatch
+	if (GI == 0)
+		SPDCounter[ArraySlice] = 0;
+
+	// Mip 6 is at most 64x64, so the entire mip 7 fits into a single tile
+	int2 Mip6Size = GetMipSize(6);
+	int2 Mip7Size = GetMipSize(7);
+	[unroll]
+	for (int j = 0; j < 4; ++j)
+	{
+		int2   Pos    = int2(int(GI) % 32, int(GI) / 32 + j * 8);
+		int2   SrcPos = min(Pos, Mip7Size - 1) * 2;
+		int2   MaxPos = Mip6Size - 1;
+		float4 Color  = 0.25 * (UnpackColor(OutMip6[uint3(min(SrcPos,               MaxPos), ArraySlice)]) +
+		                        UnpackColor(OutMip6[uint3(min(SrcPos + int2(1, 0), MaxPos), ArraySlice)]) +
+		                        UnpackColor(OutMip6[uint3(min(SrcPos + int2(0, 1), MaxPos), ArraySlice)]) +
+		                        UnpackColor(OutMip6[uint3(min(SrcPos + int2(1, 1), MaxPos), ArraySlice)]));
+		StoreColor(Pos, Color);
+		if (all(Pos < Mip7Size))
+			StoreMip(7, uint3(Pos, ArraySlice), Color);
+	}
+
+	DownsampleTile(GI, int2(0, 0), ArraySlice, 7);
+}
@@ -0,0 +1 @@
+#include "GenerateMipsSPDCS.hlsli"
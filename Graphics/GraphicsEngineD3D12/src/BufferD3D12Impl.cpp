@@ -31,6 +31,7 @@
 
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
+#include "ResourceHeapD3D12Impl.hpp"
 
 #include "D3D12TypeConversions.hpp"
 #include "GraphicsAccessories.hpp"
@@ -41,11 +42,39 @@
 namespace Diligent
 {
 
+D3D12_RESOURCE_DESC BufferD3D12Impl::GetD3D12BufferDesc(const BufferDesc& BuffDesc)
+{
+    D3D12_RESOURCE_DESC D3D12BuffDesc{};
+    D3D12BuffDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    D3D12BuffDesc.Alignment = 0;
+    D3D12BuffDesc.Width     = (BuffDesc.BindFlags & BIND_UNIFORM_BUFFER) ?
+        AlignUp(BuffDesc.uiSizeInBytes, Uint32{D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT}) :
+        BuffDesc.uiSizeInBytes;
+    D3D12BuffDesc.Height             = 1;
+    D3D12BuffDesc.DepthOrArraySize   = 1;
+    D3D12BuffDesc.MipLevels          = 1;
+    D3D12BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
+    D3D12BuffDesc.SampleDesc.Count   = 1;
+    D3D12BuffDesc.SampleDesc.Quality = 0;
+    // Layout must be D3D12_TEXTURE_LAYOUT_ROW_MAJOR, as buffer memory layouts are
+    // understood by applications and row-major texture data is commonly marshaled through buffers.
+    D3D12BuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    D3D12BuffDesc.Flags  = D3D12_RESOURCE_FLAG_NONE;
+    if ((BuffDesc.BindFlags & BIND_UNORDERED_ACCESS) || (BuffDesc.BindFlags & BIND_RAY_TRACING))
+        D3D12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+    if (!(BuffDesc.BindFlags & BIND_SHADER_RESOURCE) && !(BuffDesc.BindFlags & BIND_RAY_TRACING))
+        D3D12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+
+    return D3D12BuffDesc;
+}
+
 BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
                                  FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                                  RenderDeviceD3D12Impl*     pRenderDeviceD3D12,
                                  const BufferDesc&          BuffDesc,
-                                 const BufferData*          pBuffData /*= nullptr*/) :
+                                 const BufferData*          pBuffData /*= nullptr*/,
+                                 ResourceHeapD3D12Impl*     pHeap /*= nullptr*/,
+                                 Uint64                     HeapOffset /*= 0*/) :
     // clang-format off
     TBufferBase
     {
@@ -91,6 +120,17 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
         }
     }
 
+    const bool IsSparse = (m_Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE) != 0;
+    if (IsSparse)
+    {
+        if (pHeap != nullptr)
+            LOG_ERROR_AND_THROW("Sparse buffers can not be placed in a resource heap");
+
+        // Reserved buffers are mapped in 64KB tiles
+        BufferAlignment   = std::max(BufferAlignment, Uint32{D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES});
+        m_SparseBlockSize = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    }
+
     m_Desc.uiSizeInBytes = AlignUp(m_Desc.uiSizeInBytes, BufferAlignment);
 
 
@@ -110,24 +150,7 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
         VERIFY(m_Desc.Usage != USAGE_DYNAMIC || PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) <= 1,
                "ImmediateContextMask must contain single set bit, this error should've been handled in ValidateBufferDesc()");
 
-        D3D12_RESOURCE_DESC D3D12BuffDesc{};
-        D3D12BuffDesc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
-        D3D12BuffDesc.Alignment          = 0;
-        D3D12BuffDesc.Width              = m_Desc.uiSizeInBytes;
-        D3D12BuffDesc.Height             = 1;
-        D3D12BuffDesc.DepthOrArraySize   = 1;
-        D3D12BuffDesc.MipLevels          = 1;
-        D3D12BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
-        D3D12BuffDesc.SampleDesc.Count   = 1;
-        D3D12BuffDesc.SampleDesc.Quality = 0;
-        // Layout must be D3D12_TEXTURE_LAYOUT_ROW_MAJOR, as buffer memory layouts are
-        // understood by applications and row-major texture data is commonly marshaled through buffers.
-        D3D12BuffDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        D3D12BuffDesc.Flags  = D3D12_RESOURCE_FLAG_NONE;
-        if ((m_Desc.BindFlags & BIND_UNORDERED_ACCESS) || (m_Desc.BindFlags & BIND_RAY_TRACING))
-            D3D12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-        if (!(m_Desc.BindFlags & BIND_SHADER_RESOURCE) && !(m_Desc.BindFlags & BIND_RAY_TRACING))
-            D3D12BuffDesc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
+        D3D12_RESOURCE_DESC D3D12BuffDesc = GetD3D12BufferDesc(m_Desc);
 
         auto* pd3d12Device = pRenderDeviceD3D12->GetD3D12Device();
 
@@ -145,6 +168,8 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
         HeapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
         HeapProps.CreationNodeMask     = 1;
         HeapProps.VisibleNodeMask      = 1;
+        if (HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT)
+            pRenderDeviceD3D12->GetResourceNodeMasks(m_Desc.ImmediateContextMask, HeapProps.CreationNodeMask, HeapProps.VisibleNodeMask);
 
         const bool bInitializeBuffer = (pBuffData != nullptr && pBuffData->pData != nullptr && pBuffData->DataSize > 0);
         if (bInitializeBuffer)
@@ -161,17 +186,52 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
             GetSupportedD3D12ResourceStatesForCommandList(pRenderDeviceD3D12->GetCommandQueueType(CmdQueueInd)) :
             static_cast<D3D12_RESOURCE_STATES>(~0u);
 
-        auto D3D12State = ResourceStateFlagsToD3D12ResourceStates(GetState()) & StateMask;
-        auto hr         = pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE,
-                                                        &D3D12BuffDesc, D3D12State, nullptr,
-                                                        __uuidof(m_pd3d12Resource),
-                                                        reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+        auto    D3D12State = ResourceStateFlagsToD3D12ResourceStates(GetState()) & StateMask;
+        HRESULT hr         = S_OK;
+        if (IsSparse)
+        {
+            // Reserved resource only allocates the virtual address range; the memory is
+            // mapped to the tiles by IDeviceContext::UpdateTileMappings().
+            hr = pd3d12Device->CreateReservedResource(&D3D12BuffDesc, D3D12State, nullptr,
+                                                      __uuidof(m_pd3d12Resource),
+                                                      reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+        }
+        else if (pHeap != nullptr)
+        {
+            // The buffer is placed in the heap memory that may be aliased by other resources.
+            // Placement range and alignment are validated by the heap.
+            VERIFY(HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT, "Only default buffers can be placed in a heap, this error should've been handled by the heap");
+            hr = pd3d12Device->CreatePlacedResource(pHeap->GetD3D12Heap(), HeapOffset,
+                                                    &D3D12BuffDesc, D3D12State, nullptr,
+                                                    __uuidof(m_pd3d12Resource),
+                                                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            m_pHeap = pHeap;
+        }
+        else
+        {
+            // Default buffers are suballocated from the placed resource heaps, staging buffers are committed
+            hr = pRenderDeviceD3D12->GetPlacedResourceManager().CreateResource(HeapProps, D3D12BuffDesc, D3D12State, nullptr, m_MemoryAllocation,
+                                                                               static_cast<ID3D12Resource**>(&m_pd3d12Resource));
+        }
         if (FAILED(hr))
             LOG_ERROR_AND_THROW("Failed to create D3D12 buffer");
 
+        if (m_MemoryAllocation.Page != nullptr)
+        {
+            m_pResidencyObject = m_MemoryAllocation.Page->GetResidencyObject();
+        }
+        else if (!IsSparse && pHeap == nullptr && HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT)
+        {
+            m_ResidencyHandle  = pRenderDeviceD3D12->GetResidencyManager().RegisterCommittedResource(m_pd3d12Resource);
+            m_pResidencyObject = m_ResidencyHandle.GetObject();
+        }
+
         if (*m_Desc.Name != 0)
             m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
 
+        if (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS)
+            m_DeviceAddress = m_pd3d12Resource->GetGPUVirtualAddress();
+
         if (bInitializeBuffer)
         {
             D3D12_HEAP_PROPERTIES UploadHeapProps{};
@@ -239,6 +299,9 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
     }
 
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
+    // Readback heap is write-back cached on the CPU
+    if (m_Desc.Usage == USAGE_STAGING && m_Desc.CPUAccessFlags == CPU_ACCESS_READ)
+        m_MemoryProperties |= MEMORY_PROPERTY_HOST_CACHED;
 }
 
 static BufferDesc BufferDescFromD3D12Resource(BufferDesc BuffDesc, ID3D12Resource* pd3d12Buffer)
@@ -306,6 +369,9 @@ BufferD3D12Impl::BufferD3D12Impl(IReferenceCounters*        pRefCounters,
     m_pd3d12Resource = pd3d12Buffer;
     SetState(InitialState);
 
+    if (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS)
+        m_DeviceAddress = m_pd3d12Resource->GetGPUVirtualAddress();
+
     if (m_Desc.BindFlags & BIND_UNIFORM_BUFFER)
     {
         m_CBVDescriptorAllocation = pRenderDeviceD3D12->AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -319,6 +385,10 @@ BufferD3D12Impl::~BufferD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    if (m_MemoryAllocation.Page != nullptr)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+    if (m_ResidencyHandle)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_ResidencyHandle), m_Desc.ImmediateContextMask);
 }
 
 void BufferD3D12Impl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
@@ -53,10 +53,17 @@ BufferViewD3D12Impl::BufferViewD3D12Impl(IReferenceCounters*        pRefCounters
     m_DescriptorHandle{std::move(HandleAlloc)}
 // clang-format on
 {
+    // Dynamic buffers are suballocated from the dynamic heap and have no persistent descriptors
+    if (pBuffer->GetDesc().Usage != USAGE_DYNAMIC &&
+        (ViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE || ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS))
+    {
+        m_BindlessIndex = pDevice->AddBindlessDescriptor(m_DescriptorHandle.GetCpuHandle());
+    }
 }
 
 BufferViewD3D12Impl::~BufferViewD3D12Impl()
 {
+    m_pDevice->RemoveBindlessDescriptor(m_BindlessIndex, m_pBuffer->GetDesc().ImmediateContextMask);
 }
 
 } // namespace Diligent
@@ -38,6 +38,7 @@
 #include "TopLevelASD3D12Impl.hpp"
 
 #include "CommandListManager.hpp"
+#include "QueryManagerD3D12.hpp"
 #include "D3D12TypeConversions.hpp"
 
 #ifdef DILIGENT_USE_PIX
@@ -54,11 +55,20 @@
 namespace Diligent
 {
 
-CommandContext::CommandContext(CommandListManager& CmdListManager) :
-    m_PendingResourceBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_RESOURCE_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_RESOURCE_BARRIER>"))
+static Uint64 GetNextResidencyStamp()
+{
+    // Stamp 0 is never used, so that new residency objects are not considered recorded
+    static std::atomic<Uint64> NextStamp{1};
+    return NextStamp.fetch_add(1);
+}
+
+CommandContext::CommandContext(CommandListManager& CmdListManager, UINT NodeMask) :
+    m_PendingResourceBarriers(STD_ALLOCATOR_RAW_MEM(D3D12_RESOURCE_BARRIER, GetRawAllocator(), "Allocator for vector<D3D12_RESOURCE_BARRIER>")),
+    m_ResidencyStamp{GetNextResidencyStamp()},
+    m_NodeMask{NodeMask}
 {
     m_PendingResourceBarriers.reserve(32);
-    CmdListManager.CreateNewCommandList(&m_pCommandList, &m_pCurrentAllocator, m_MaxInterfaceVer);
+    CmdListManager.CreateNewCommandList(&m_pCommandList, &m_pCurrentAllocator, m_MaxInterfaceVer, NodeMask);
 }
 
 CommandContext::~CommandContext(void)
@@ -87,6 +97,13 @@ void CommandContext::Reset(CommandListManager& CmdListManager)
     m_BoundDescriptorHeaps = ShaderDescriptorHeaps{};
 
     m_DynamicGPUDescriptorAllocators = nullptr;
+    VERIFY(m_DynamicSamplerTables.empty(), "Dynamic sampler tables must have been discarded when the command list was closed");
+
+    VERIFY(m_PendingQueryResolves.empty(), "Pending query resolves must have been recorded when the command list was closed");
+    m_PendingQueryResolves.clear();
+
+    m_ResidencyUsage.clear();
+    m_ResidencyStamp = GetNextResidencyStamp();
 
     m_PrimitiveTopology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 #if 0
@@ -98,6 +115,15 @@ ID3D12GraphicsCommandList* CommandContext::Close(CComPtr<ID3D12CommandAllocator>
 {
     FlushResourceBarriers();
 
+    if (!m_PendingQueryResolves.empty())
+    {
+        m_pQueryMgr->ResolveQueries(*this, m_PendingQueryResolves);
+        m_PendingQueryResolves.clear();
+    }
+
+    // Tables reference dynamic descriptors that are released at the end of the frame
+    DiscardDynamicSamplerTables();
+
     //if (m_ID.length() > 0)
     //  EngineProfiling::EndBlock(this);
 
@@ -163,6 +189,7 @@ public:
                           D3D12_COMMAND_LIST_TYPE                                                          CmdListType) :
         m_Barrier{Barrier},
         m_d3d12PendingBarriers{d3d12PendingBarriers},
+        m_CmdListType{CmdListType},
         m_ResStateMask{GetSupportedD3D12ResourceStatesForCommandList(CmdListType)}
     {
         DEV_CHECK_ERR(m_Barrier.NewState != RESOURCE_STATE_UNKNOWN, "New resource state can't be unknown");
@@ -182,6 +209,8 @@ public:
     void operator()(ResourceType& Resource);
 
 private:
+    void AddTransitionBarrier(const D3D12_RESOURCE_BARRIER& d3d12Barrier);
+
     const StateTransitionDesc& m_Barrier;
 
     std::vector<D3D12_RESOURCE_BARRIER, STDAllocatorRawMem<D3D12_RESOURCE_BARRIER>>& m_d3d12PendingBarriers;
@@ -191,9 +220,73 @@ private:
 
     bool m_RequireUAVBarrier = false;
 
-    const D3D12_RESOURCE_STATES m_ResStateMask;
+    const D3D12_COMMAND_LIST_TYPE m_CmdListType;
+    const D3D12_RESOURCE_STATES   m_ResStateMask;
 };
 
+static bool BarrierReferencesResource(const D3D12_RESOURCE_BARRIER& d3d12Barrier, ID3D12Resource* pd3d12Resource)
+{
+    switch (d3d12Barrier.Type)
+    {
+        case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+            return d3d12Barrier.Transition.pResource == pd3d12Resource;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+            // Null resources in aliasing barrier mean that any placed resource may be affected
+            return d3d12Barrier.Aliasing.pResourceBefore == nullptr || d3d12Barrier.Aliasing.pResourceBefore == pd3d12Resource ||
+                d3d12Barrier.Aliasing.pResourceAfter == nullptr || d3d12Barrier.Aliasing.pResourceAfter == pd3d12Resource;
+
+        case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+            // Null resource in UAV barrier means that any UAV access may be affected
+            return d3d12Barrier.UAV.pResource == nullptr || d3d12Barrier.UAV.pResource == pd3d12Resource;
+
+        default:
+            UNEXPECTED("Unexpected barrier type");
+            return true;
+    }
+}
+
+void StateTransitionHelper::AddTransitionBarrier(const D3D12_RESOURCE_BARRIER& d3d12Barrier)
+{
+    VERIFY_EXPR(d3d12Barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION);
+    const auto& Transition = d3d12Barrier.Transition;
+
+    if (d3d12Barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE)
+    {
+        // Pending barriers are always flushed before any command that accesses resources is recorded,
+        // so no work may be executed between a pending transition and this one. If the pending
+        // transition of the same subresource ends in the state this one starts from, the two
+        // can be merged (A -> B, B -> C  =>  A -> C). If the merged transition is a no-op, it is removed.
+        for (auto it = m_d3d12PendingBarriers.rbegin(); it != m_d3d12PendingBarriers.rend(); ++it)
+        {
+            if (!BarrierReferencesResource(*it, Transition.pResource))
+                continue;
+
+            if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && it->Transition.Subresource != Transition.Subresource)
+            {
+                // Transitions of other individual subresources are independent
+                if (it->Transition.Subresource != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES &&
+                    Transition.Subresource != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+                    continue;
+            }
+            else if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+                     it->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+                     it->Transition.StateAfter == Transition.StateBefore)
+            {
+                it->Transition.StateAfter = Transition.StateAfter;
+                if (it->Transition.StateBefore == it->Transition.StateAfter)
+                    m_d3d12PendingBarriers.erase(std::next(it).base());
+                return;
+            }
+
+            // Any other barrier that references the resource must be preserved in order
+            break;
+        }
+    }
+
+    m_d3d12PendingBarriers.emplace_back(d3d12Barrier);
+}
+
 template <typename ResourceType>
 void StateTransitionHelper::GetD3D12ResourceAndState(ResourceType& Resource)
 {
@@ -240,7 +333,7 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(TextureD3D12Impl& Tex, D3D1
             m_Barrier.FirstArraySlice == 0 && (m_Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES || m_Barrier.ArraySliceCount == TexDesc.ArraySize))
         {
             d3d12Barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            m_d3d12PendingBarriers.emplace_back(d3d12Barrier);
+            AddTransitionBarrier(d3d12Barrier);
         }
         else
         {
@@ -251,7 +344,7 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(TextureD3D12Impl& Tex, D3D1
                 for (Uint32 slice = m_Barrier.FirstArraySlice; slice < EndSlice; ++slice)
                 {
                     d3d12Barrier.Transition.Subresource = D3D12CalcSubresource(mip, slice, 0, TexDesc.MipLevels, TexDesc.ArraySize);
-                    m_d3d12PendingBarriers.emplace_back(d3d12Barrier);
+                    AddTransitionBarrier(d3d12Barrier);
                 }
             }
         }
@@ -262,7 +355,7 @@ void StateTransitionHelper::AddD3D12ResourceBarriers(BufferD3D12Impl& Buff, D3D1
 {
     if (d3d12Barrier.Transition.StateBefore != d3d12Barrier.Transition.StateAfter)
     {
-        m_d3d12PendingBarriers.emplace_back(d3d12Barrier);
+        AddTransitionBarrier(d3d12Barrier);
     }
 }
 
@@ -335,7 +428,15 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
         d3d12Barrier.Transition.StateBefore = ResourceStateFlagsToD3D12ResourceStates(m_OldState) & m_ResStateMask;
         d3d12Barrier.Transition.StateAfter  = ResourceStateFlagsToD3D12ResourceStates(NewState) & m_ResStateMask;
 
-        AddD3D12ResourceBarriers(Resource, d3d12Barrier);
+        // On copy queues, all resources in D3D12_RESOURCE_STATE_COMMON state are implicitly promoted to
+        // COPY_SOURCE or COPY_DEST state on first access, and decay back to COMMON when ExecuteCommandLists
+        // completes. No explicit barrier is required in this case.
+        const bool IsImplicitPromotion =
+            m_CmdListType == D3D12_COMMAND_LIST_TYPE_COPY &&
+            ResourceStateFlagsToD3D12ResourceStates(m_OldState) == D3D12_RESOURCE_STATE_COMMON &&
+            (d3d12Barrier.Transition.StateAfter & ~(D3D12_RESOURCE_STATE_COPY_SOURCE | D3D12_RESOURCE_STATE_COPY_DEST)) == 0;
+        if (!IsImplicitPromotion)
+            AddD3D12ResourceBarriers(Resource, d3d12Barrier);
 
         if (m_Barrier.UpdateResourceState)
         {
@@ -360,12 +461,14 @@ void StateTransitionHelper::operator()(ResourceType& Resource)
 
 void CommandContext::TransitionResource(TextureD3D12Impl& Texture, const StateTransitionDesc& Barrier)
 {
+    AddResidencyUsage(Texture.GetResidencyObject());
     StateTransitionHelper Helper{Barrier, m_PendingResourceBarriers, GetCommandListType()};
     Helper(Texture);
 }
 
 void CommandContext::TransitionResource(BufferD3D12Impl& Buffer, const StateTransitionDesc& Barrier)
 {
+    AddResidencyUsage(Buffer.GetResidencyObject());
     StateTransitionHelper Helper{Barrier, m_PendingResourceBarriers, GetCommandListType()};
     Helper(Buffer);
 }
@@ -47,7 +47,7 @@ CommandListManager::~CommandListManager()
     LOG_INFO_MESSAGE("Command list manager: created ", m_FreeAllocators.size(), " allocators");
 }
 
-void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List, ID3D12CommandAllocator** Allocator, Uint32& IfaceVersion)
+void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List, ID3D12CommandAllocator** Allocator, Uint32& IfaceVersion, UINT NodeMask)
 {
     RequestAllocator(Allocator);
     auto* pd3d12Device = m_DeviceD3D12Impl.GetD3D12Device();
@@ -68,7 +68,7 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
     HRESULT hr = E_FAIL;
     for (Uint32 i = 0; i < _countof(CmdListIIDs); ++i)
     {
-        hr = pd3d12Device->CreateCommandList(1, m_CmdListType, *Allocator, nullptr, CmdListIIDs[i], reinterpret_cast<void**>(List));
+        hr = pd3d12Device->CreateCommandList(NodeMask, m_CmdListType, *Allocator, nullptr, CmdListIIDs[i], reinterpret_cast<void**>(List));
         if (SUCCEEDED(hr))
         {
             IfaceVersion = _countof(CmdListIIDs) - 1 - i;
@@ -83,17 +83,25 @@ void CommandListManager::CreateNewCommandList(ID3D12GraphicsCommandList** List,
 
 void CommandListManager::RequestAllocator(ID3D12CommandAllocator** ppAllocator)
 {
-    std::lock_guard<std::mutex> LockGuard{m_AllocatorMutex};
-
     VERIFY((*ppAllocator) == nullptr, "Allocator pointer is not null");
     (*ppAllocator) = nullptr;
 
-    if (!m_FreeAllocators.empty())
     {
-        *ppAllocator = m_FreeAllocators.back().Detach();
-        auto hr      = (*ppAllocator)->Reset();
+        // The mutex only protects the list. Resetting or creating the allocator, which may take
+        // a while, is done outside of the lock so that other threads are not blocked.
+        std::lock_guard<std::mutex> LockGuard{m_AllocatorMutex};
+        if (!m_FreeAllocators.empty())
+        {
+            *ppAllocator = m_FreeAllocators.back().Detach();
+            m_FreeAllocators.pop_back();
+        }
+    }
+
+    if ((*ppAllocator) != nullptr)
+    {
+        // The GPU has finished using the allocator (see ReleaseAllocator), so it can be safely reset
+        auto hr = (*ppAllocator)->Reset();
         DEV_CHECK_ERR(SUCCEEDED(hr), "Failed to reset command allocator");
-        m_FreeAllocators.pop_back();
     }
 
     // If no allocators were ready to be reused, create a new one
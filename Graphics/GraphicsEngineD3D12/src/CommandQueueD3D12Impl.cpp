@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include "CommandQueueD3D12Impl.hpp"
+#include "ProfilerHooks.hpp"
 
 namespace Diligent
 {
@@ -55,6 +56,8 @@ CommandQueueD3D12Impl::~CommandQueueD3D12Impl()
 Uint64 CommandQueueD3D12Impl::Submit(Uint32                    NumCommandLists,
                                      ID3D12CommandList* const* ppCommandLists)
 {
+    DILIGENT_PROFILE_SCOPE("CommandQueueD3D12::Submit");
+
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
 
     // Increment the value before submitting the list
@@ -81,6 +84,8 @@ Uint64 CommandQueueD3D12Impl::Submit(Uint32                    NumCommandLists,
 
 Uint64 CommandQueueD3D12Impl::WaitForIdle()
 {
+    DILIGENT_PROFILE_SCOPE("CommandQueueD3D12::WaitForIdle");
+
     std::lock_guard<std::mutex> Lock{m_QueueMtx};
 
     Uint64 LastSignaledFenceValue = m_NextFenceValue.fetch_add(1);
@@ -75,39 +75,117 @@ D3D12DynamicPage::D3D12DynamicPage(ID3D12Device* pd3d12Device, Uint64 Size)
     LOG_INFO_MESSAGE("Created dynamic memory page. Size: ", FormatMemorySize(Size, 2), "; GPU virtual address 0x", std::hex, m_GPUVirtualAddress);
 }
 
-D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(IMemoryAllocator&      Allocator,
-                                                     RenderDeviceD3D12Impl& DeviceD3D12Impl,
+D3D12DynamicMemoryManager::D3D12DynamicMemoryManager(RenderDeviceD3D12Impl& DeviceD3D12Impl,
                                                      Uint32                 NumPagesToReserve,
                                                      Uint64                 PageSize) :
     m_DeviceD3D12Impl{DeviceD3D12Impl},
-    m_AvailablePages(STD_ALLOCATOR_RAW_MEM(AvailablePagesMapElemType, Allocator, "Allocator for multimap<AvailablePagesMapElemType>"))
+    m_NumPagesToReserve{NumPagesToReserve},
+    m_ReservedPageSize{PageSize}
 {
-    for (Uint32 i = 0; i < NumPagesToReserve; ++i)
+    // Pages are reserved by the first AllocatePage() call, so that devices
+    // that never use dynamic resources do not allocate upload memory.
+}
+
+size_t D3D12DynamicMemoryManager::GetPageSizeClass(Uint64 Size)
+{
+    VERIFY_EXPR(Size > 0);
+    return PlatformMisc::GetMSB(Size);
+}
+
+void D3D12DynamicMemoryManager::ReservePages()
+{
+    for (Uint32 i = 0; i < m_NumPagesToReserve; ++i)
     {
-        D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), PageSize);
+        D3D12DynamicPage Page(m_DeviceD3D12Impl.GetD3D12Device(), m_ReservedPageSize);
         auto             Size = Page.GetSize();
-        m_AvailablePages.emplace(Size, std::move(Page));
+        m_AvailablePages[GetPageSizeClass(Size)].emplace_back(std::move(Page));
+        m_CurrAllocatedSize += Size;
+        ++m_NumPages;
     }
+    m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_CurrAllocatedSize);
+    m_NumPagesToReserve = 0;
 }
 
 D3D12DynamicPage D3D12DynamicMemoryManager::AllocatePage(Uint64 SizeInBytes)
 {
     std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+    if (m_NumPagesToReserve != 0)
+        ReservePages();
 #ifdef DILIGENT_DEVELOPMENT
     ++m_AllocatedPageCounter;
 #endif
-    auto PageIt = m_AvailablePages.lower_bound(SizeInBytes); // Returns an iterator pointing to the first element that is not less than key
-    if (PageIt != m_AvailablePages.end())
+
+    // Pages in the requested size class may be smaller than the requested size,
+    // while any page in the larger classes is large enough.
+    const auto RequestedClass = GetPageSizeClass(SizeInBytes);
+    for (size_t SizeClass = RequestedClass; SizeClass < NumPageSizeClasses; ++SizeClass)
     {
-        VERIFY_EXPR(PageIt->first >= SizeInBytes);
-        D3D12DynamicPage Page(std::move(PageIt->second));
-        m_AvailablePages.erase(PageIt);
+        auto& Pages  = m_AvailablePages[SizeClass];
+        auto  PageIt = Pages.end();
+        if (SizeClass == RequestedClass)
+            PageIt = std::find_if(Pages.begin(), Pages.end(), [SizeInBytes](const D3D12DynamicPage& Page) { return Page.GetSize() >= SizeInBytes; });
+        else if (!Pages.empty())
+            PageIt = Pages.end() - 1;
+        if (PageIt == Pages.end())
+            continue;
+
+        D3D12DynamicPage Page{std::move(*PageIt)};
+        if (PageIt != Pages.end() - 1)
+            *PageIt = std::move(Pages.back());
+        Pages.pop_back();
+
+        m_CurrUsedSize += Page.GetSize();
+        m_PeakUsedSize = std::max(m_PeakUsedSize, m_CurrUsedSize);
         return Page;
     }
-    else
+
+    DILIGENT_PROFILE_SCOPE("D3D12DynamicMemoryManager::CreatePage");
+
+    D3D12DynamicPage Page{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+
+    const auto Size = Page.GetSize();
+    m_CurrAllocatedSize += Size;
+    m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_CurrAllocatedSize);
+    m_CurrUsedSize += Size;
+    m_PeakUsedSize = std::max(m_PeakUsedSize, m_CurrUsedSize);
+    ++m_NumPages;
+
+    if (m_AllocationCallback != nullptr)
     {
-        return D3D12DynamicPage{m_DeviceD3D12Impl.GetD3D12Device(), SizeInBytes};
+        MemoryAllocationEvent Event;
+        Event.Type = MEMORY_ALLOCATION_EVENT_TYPE_ALLOCATE;
+        Event.Size = Size;
+        m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
     }
+
+    return Page;
+}
+
+void D3D12DynamicMemoryManager::GetStatistics(RenderDeviceMemoryStatistics& Stats)
+{
+    Stats                = {};
+    Stats.NumHeaps       = 1;
+    Stats.NumMemoryTypes = 1;
+
+    std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+
+    auto& UploadStats             = Stats.MemoryTypes[0];
+    UploadStats.AllocatedSize     = m_CurrAllocatedSize;
+    UploadStats.UsedSize          = m_CurrUsedSize;
+    UploadStats.PeakAllocatedSize = m_PeakAllocatedSize;
+    UploadStats.PeakUsedSize      = m_PeakUsedSize;
+    UploadStats.NumAllocations    = m_NumPages;
+
+    Stats.Heaps[0].Usage = UploadStats;
+
+    Stats.Helpers.DynamicHeapSize = m_CurrAllocatedSize;
+}
+
+void D3D12DynamicMemoryManager::SetAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData)
+{
+    std::lock_guard<std::mutex> AvailablePagesLock{m_AvailablePagesMtx};
+    m_AllocationCallback          = Callback;
+    m_pAllocationCallbackUserData = pUserData;
 }
 
 void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Pages, Uint64 QueueMask)
@@ -145,7 +223,9 @@ void D3D12DynamicMemoryManager::ReleasePages(std::vector<D3D12DynamicPage>& Page
                 --Mgr->m_AllocatedPageCounter;
 #endif
                 auto PageSize = Page.GetSize();
-                Mgr->m_AvailablePages.emplace(PageSize, std::move(Page));
+                VERIFY_EXPR(Mgr->m_CurrUsedSize >= PageSize);
+                Mgr->m_CurrUsedSize -= PageSize;
+                Mgr->m_AvailablePages[GetPageSizeClass(PageSize)].emplace_back(std::move(Page));
             }
         }
     };
@@ -159,20 +239,39 @@ void D3D12DynamicMemoryManager::Destroy()
 {
     DEV_CHECK_ERR(m_AllocatedPageCounter == 0, m_AllocatedPageCounter, " page(s) have not been returned to the manager.");
     Uint64 TotalAllocatedSize = 0;
-    for (const auto& Page : m_AvailablePages)
-        TotalAllocatedSize += Page.second.GetSize();
+    for (const auto& Pages : m_AvailablePages)
+    {
+        for (const auto& Page : Pages)
+            TotalAllocatedSize += Page.GetSize();
+    }
 
     LOG_INFO_MESSAGE("Dynamic memory manager usage stats:\n"
                      "                       Total allocated memory: ",
                      FormatMemorySize(TotalAllocatedSize, 2));
 
-    m_AvailablePages.clear();
+    for (auto& Pages : m_AvailablePages)
+    {
+        if (m_AllocationCallback != nullptr)
+        {
+            for (const auto& Page : Pages)
+            {
+                MemoryAllocationEvent Event;
+                Event.Type = MEMORY_ALLOCATION_EVENT_TYPE_FREE;
+                Event.Size = Page.GetSize();
+                m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
+            }
+        }
+        Pages.clear();
+    }
+    m_CurrAllocatedSize = 0;
+    m_NumPages          = 0;
 }
 
 D3D12DynamicMemoryManager::~D3D12DynamicMemoryManager()
 {
     DEV_CHECK_ERR(m_AllocatedPageCounter == 0, m_AllocatedPageCounter, " page(s) have not been released. If there are outstanding references to the pages in release queues, the app will crash when the page is returned to the manager.");
-    VERIFY(m_AvailablePages.empty(), "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
+    VERIFY(std::all_of(m_AvailablePages.begin(), m_AvailablePages.end(), [](const std::vector<D3D12DynamicPage>& Pages) { return Pages.empty(); }),
+           "Not all pages are destroyed. Dynamic memory manager must be explicitly destroyed with Destroy() method");
 }
 
 
@@ -180,6 +279,15 @@ D3D12DynamicHeap::~D3D12DynamicHeap()
 {
     VERIFY(m_AllocatedPages.empty(), "Allocated pages have not been released which indicates FinishFrame() has not been called");
 
+    // Cached pages may still be used by the GPU, so they are returned to the global manager through the release queues
+    for (auto& Cached : m_CachedPages)
+    {
+        m_AllocatedPages.emplace_back(std::move(Cached.Page));
+        m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, Uint64{1} << Uint64{Cached.QueueId});
+        m_AllocatedPages.clear();
+    }
+    m_CachedPages.clear();
+
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName,
                      " usage stats:\n"
@@ -203,7 +311,9 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
         while (NewPageSize < SizeInBytes)
             NewPageSize *= 2;
 
-        auto NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize);
+        auto NewPage = AllocateCachedPage(NewPageSize);
+        if (!NewPage.IsValid())
+            NewPage = m_GlobalDynamicMemMgr.AllocatePage(NewPageSize);
         if (NewPage.IsValid())
         {
             m_CurrOffset    = 0;
@@ -249,9 +359,53 @@ D3D12DynamicAllocation D3D12DynamicHeap::Allocate(Uint64 SizeInBytes, Uint64 Ali
         return D3D12DynamicAllocation{};
 }
 
+D3D12DynamicPage D3D12DynamicHeap::AllocateCachedPage(Uint64 SizeInBytes)
+{
+    auto& Device = m_GlobalDynamicMemMgr.GetDevice();
+
+    // Pages are cached in the order they were released, so the search stops at the first page still used by the GPU
+    Uint64             CompletedFenceValue = 0;
+    SoftwareQueueIndex CompletedFenceQueue{MAX_COMMAND_QUEUES};
+    for (auto it = m_CachedPages.begin(); it != m_CachedPages.end(); ++it)
+    {
+        if (it->QueueId != CompletedFenceQueue)
+        {
+            CompletedFenceQueue = it->QueueId;
+            CompletedFenceValue = Device.GetCompletedFenceValue(it->QueueId);
+        }
+        if (it->FenceValue > CompletedFenceValue)
+            break;
+
+        if (it->Page.GetSize() >= SizeInBytes)
+        {
+            D3D12DynamicPage Page{std::move(it->Page)};
+            m_CachedPages.erase(it);
+            return Page;
+        }
+    }
+
+    return D3D12DynamicPage{};
+}
+
 void D3D12DynamicHeap::ReleaseAllocatedPages(Uint64 QueueMask)
 {
-    m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, QueueMask);
+    // Pages used by a single queue are kept by the heap and reused once the queue completes the
+    // next submission, which is when the release queue would have returned them to the global manager.
+    // Pages used by several queues go through the release queues.
+    if (PlatformMisc::CountOneBits(QueueMask) == 1)
+    {
+        const SoftwareQueueIndex QueueId{PlatformMisc::GetLSB(QueueMask)};
+        const auto               FenceValue = m_GlobalDynamicMemMgr.GetDevice().GetNextFenceValue(QueueId);
+
+        const size_t NumFreeSlots    = m_CachedPages.size() < MaxCachedPages ? MaxCachedPages - m_CachedPages.size() : 0;
+        const size_t NumPagesToCache = std::min(m_AllocatedPages.size(), NumFreeSlots);
+        for (size_t i = 0; i < NumPagesToCache; ++i)
+            m_CachedPages.emplace_back(CachedPage{std::move(m_AllocatedPages[i]), QueueId, FenceValue});
+        m_AllocatedPages.erase(m_AllocatedPages.begin(), m_AllocatedPages.begin() + static_cast<ptrdiff_t>(NumPagesToCache));
+    }
+
+    if (!m_AllocatedPages.empty())
+        m_GlobalDynamicMemMgr.ReleasePages(m_AllocatedPages, QueueMask);
     m_AllocatedPages.clear();
 
     m_CurrOffset        = InvalidOffset;
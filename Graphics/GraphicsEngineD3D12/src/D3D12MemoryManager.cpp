@@ -0,0 +1,354 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <tuple>
+
+#include "D3D12MemoryManager.hpp"
+#include "Align.hpp"
+#include "StringTools.hpp"
+
+namespace Diligent
+{
+
+D3D12MemoryAllocation::~D3D12MemoryAllocation()
+{
+    if (Page != nullptr)
+    {
+        Page->Free(std::move(*this));
+    }
+}
+
+D3D12MemoryPage::D3D12MemoryPage(D3D12MemoryManager& ParentMemoryMgr,
+                                 Uint64              PageSize,
+                                 D3D12_HEAP_TYPE     HeapType,
+                                 D3D12_HEAP_FLAGS    HeapFlags,
+                                 UINT                CreationNodeMask,
+                                 UINT                VisibleNodeMask) :
+    // clang-format off
+    m_ParentMemoryMgr{ParentMemoryMgr},
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+// clang-format on
+{
+    VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
+           "PageSize (", PageSize, ") exceeds maximum allowed value ",
+           std::numeric_limits<AllocationsMgrOffsetType>::max());
+
+    D3D12_HEAP_DESC d3d12HeapDesc{};
+    d3d12HeapDesc.SizeInBytes                     = PageSize;
+    d3d12HeapDesc.Properties.Type                 = HeapType;
+    d3d12HeapDesc.Properties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    d3d12HeapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    d3d12HeapDesc.Properties.CreationNodeMask     = CreationNodeMask;
+    d3d12HeapDesc.Properties.VisibleNodeMask      = VisibleNodeMask;
+    // Multisample resources are never placed in the pages
+    d3d12HeapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    d3d12HeapDesc.Flags     = HeapFlags;
+
+    auto hr = ParentMemoryMgr.m_pd3d12Device->CreateHeap(&d3d12HeapDesc, __uuidof(m_pd3d12Heap), reinterpret_cast<void**>(static_cast<ID3D12Heap**>(&m_pd3d12Heap)));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create placed resource heap page. Size: ", FormatMemorySize(PageSize, 2));
+
+    m_pd3d12Heap->SetName(L"Placed resource heap page");
+
+    // The heap is made resident and evicted as a whole with all resources placed in it
+    m_ResidencyHandle = ParentMemoryMgr.m_ResidencyMgr.Register(m_pd3d12Heap, PageSize);
+}
+
+D3D12MemoryPage::~D3D12MemoryPage()
+{
+    VERIFY(IsEmpty(), "Destroying a page with not all allocations released");
+}
+
+D3D12MemoryAllocation D3D12MemoryPage::Allocate(Uint64 Size, Uint64 Alignment)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    VERIFY(Size <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
+           "Allocation size (", Size, ") exceeds maximum allowed value ",
+           std::numeric_limits<AllocationsMgrOffsetType>::max());
+    auto Allocation = m_AllocationMgr.Allocate(static_cast<AllocationsMgrOffsetType>(Size), static_cast<AllocationsMgrOffsetType>(Alignment));
+    if (Allocation.IsValid())
+    {
+        // Offset may not necessarily be aligned, but the allocation is guaranteed to be large enough
+        // to accommodate requested alignment
+        VERIFY_EXPR(AlignUp(Uint64{Allocation.UnalignedOffset}, Alignment) - Allocation.UnalignedOffset + Size <= Allocation.Size);
+        return D3D12MemoryAllocation{this, Allocation.UnalignedOffset, Allocation.Size};
+    }
+    else
+    {
+        return D3D12MemoryAllocation{};
+    }
+}
+
+void D3D12MemoryPage::Free(D3D12MemoryAllocation&& Allocation)
+{
+    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size);
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
+    VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
+    m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+    Allocation = D3D12MemoryAllocation{};
+}
+
+
+D3D12MemoryManager::D3D12MemoryManager(IMemoryAllocator&      Allocator,
+                                       ID3D12Device*          pd3d12Device,
+                                       D3D12ResidencyManager& ResidencyMgr,
+                                       Uint64                 PageSize,
+                                       Uint64                 ReserveSize) :
+    // clang-format off
+    m_pd3d12Device{pd3d12Device},
+    m_Allocator   {Allocator   },
+    m_ResidencyMgr{ResidencyMgr},
+    m_PageSize    {AlignUp(PageSize, Uint64{D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT})},
+    m_ReserveSize {ReserveSize }
+// clang-format on
+{
+    D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Options{};
+    if (SUCCEEDED(m_pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Options, sizeof(d3d12Options))))
+        m_ResourceHeapTier = d3d12Options.ResourceHeapTier;
+}
+
+D3D12MemoryManager::~D3D12MemoryManager()
+{
+    LOG_INFO_MESSAGE("D3D12MemoryManager stats: peak used/allocated placed resource memory size: ",
+                     FormatMemorySize(m_PeakUsedSize, 2, m_PeakAllocatedSize), " / ",
+                     FormatMemorySize(m_PeakAllocatedSize, 2, m_PeakAllocatedSize));
+
+    for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
+        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    VERIFY(m_CurrUsedSize == 0, "Not all allocations have been released");
+}
+
+D3D12_RESOURCE_ALLOCATION_INFO D3D12MemoryManager::GetAllocationInfo(D3D12_RESOURCE_DESC& ResourceDesc) const
+{
+    if (ResourceDesc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        // Small textures may use 4KB alignment. The runtime only allows this when the most detailed mip
+        // level is not larger than 64KB, and otherwise returns the alignment the texture requires.
+        ResourceDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+
+        const auto AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &ResourceDesc);
+        if (AllocInfo.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+            return AllocInfo;
+    }
+
+    ResourceDesc.Alignment = 0;
+    return m_pd3d12Device->GetResourceAllocationInfo(0, 1, &ResourceDesc);
+}
+
+HRESULT D3D12MemoryManager::CreateResource(const D3D12_HEAP_PROPERTIES& HeapProps,
+                                           const D3D12_RESOURCE_DESC&   ResourceDesc,
+                                           D3D12_RESOURCE_STATES        InitialState,
+                                           const D3D12_CLEAR_VALUE*     pClearValue,
+                                           D3D12MemoryAllocation&       Allocation,
+                                           ID3D12Resource**             ppd3d12Resource)
+{
+    VERIFY(Allocation.Page == nullptr, "Overwriting an existing allocation");
+
+    // Placed render targets and depth-stencil buffers must be initialized with a clear, discard or copy
+    // operation before they are used, while committed resources do not have this requirement.
+    // Keeping them committed also lets the driver choose the best placement for compressed surfaces.
+    const auto CanBePlaced =
+        m_PageSize != 0 &&
+        HeapProps.Type == D3D12_HEAP_TYPE_DEFAULT &&
+        (ResourceDesc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) == 0 &&
+        ResourceDesc.SampleDesc.Count <= 1;
+
+    if (CanBePlaced)
+    {
+        auto d3d12Desc = ResourceDesc;
+
+        const auto AllocInfo = GetAllocationInfo(d3d12Desc);
+        if (AllocInfo.SizeInBytes <= m_PageSize / 2 && AllocInfo.Alignment <= D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT)
+        {
+            // Resource heap tier 1 requires that a heap only contains resources of a single category
+            const auto HeapFlags = m_ResourceHeapTier >= D3D12_RESOURCE_HEAP_TIER_2 ?
+                D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES :
+                (d3d12Desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER ? D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES);
+
+            Allocation = Allocate(AllocInfo.SizeInBytes, AllocInfo.Alignment, HeapProps, HeapFlags);
+            if (Allocation.Page != nullptr)
+            {
+                const auto Offset = AlignUp(Allocation.UnalignedOffset, AllocInfo.Alignment);
+
+                auto hr = m_pd3d12Device->CreatePlacedResource(Allocation.Page->GetD3D12Heap(), Offset, &d3d12Desc, InitialState, pClearValue,
+                                                               __uuidof(ID3D12Resource), reinterpret_cast<void**>(ppd3d12Resource));
+                if (SUCCEEDED(hr))
+                    return hr;
+
+                LOG_WARNING_MESSAGE("Failed to create placed resource. Falling back to committed resource.");
+
+                // Return the memory to the page
+                D3D12MemoryAllocation FailedAllocation{std::move(Allocation)};
+            }
+        }
+    }
+
+    return m_pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE, &ResourceDesc, InitialState, pClearValue,
+                                                   __uuidof(ID3D12Resource), reinterpret_cast<void**>(ppd3d12Resource));
+}
+
+D3D12MemoryAllocation D3D12MemoryManager::Allocate(Uint64 Size, Uint64 Alignment, const D3D12_HEAP_PROPERTIES& HeapProps, D3D12_HEAP_FLAGS HeapFlags)
+{
+    D3D12MemoryAllocation Allocation;
+
+    MemoryPageIndex             PageIdx{HeapProps.Type, HeapFlags, HeapProps.CreationNodeMask, HeapProps.VisibleNodeMask};
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    auto range = m_Pages.equal_range(PageIdx);
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        Allocation = page_it->second.Allocate(Size, Alignment);
+        if (Allocation.Page != nullptr)
+            break;
+    }
+
+    if (Allocation.Page == nullptr)
+    {
+        try
+        {
+            auto it = m_Pages.emplace(std::piecewise_construct,
+                                      std::forward_as_tuple(PageIdx),
+                                      std::forward_as_tuple(*this, m_PageSize, HeapProps.Type, HeapFlags, HeapProps.CreationNodeMask, HeapProps.VisibleNodeMask));
+            OnPageCreated(it->second);
+            LOG_INFO_MESSAGE("D3D12MemoryManager: created new placed resource heap page (", FormatMemorySize(m_PageSize, 2),
+                             "). Current allocated size: ", FormatMemorySize(m_CurrAllocatedSize, 2));
+
+            Allocation = it->second.Allocate(Size, Alignment);
+            DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate memory from the new page");
+        }
+        catch (...)
+        {
+            return D3D12MemoryAllocation{};
+        }
+    }
+
+    if (Allocation.Page != nullptr)
+    {
+        const auto UsedSize = m_CurrUsedSize.fetch_add(static_cast<int64_t>(Allocation.Size)) + static_cast<int64_t>(Allocation.Size);
+        m_PeakUsedSize      = std::max(m_PeakUsedSize, static_cast<Uint64>(UsedSize));
+    }
+
+    return Allocation;
+}
+
+void D3D12MemoryManager::OnFreeAllocation(Uint64 Size)
+{
+    m_CurrUsedSize.fetch_add(-static_cast<int64_t>(Size));
+}
+
+void D3D12MemoryManager::ShrinkMemory()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    if (m_CurrAllocatedSize <= m_ReserveSize)
+        return;
+
+    auto it = m_Pages.begin();
+    while (it != m_Pages.end() && m_CurrAllocatedSize > m_ReserveSize)
+    {
+        auto curr_it = it;
+        ++it;
+        auto& Page = curr_it->second;
+        if (!Page.IsEmpty())
+            continue;
+
+        OnPageReleased(Page);
+        LOG_INFO_MESSAGE("D3D12MemoryManager: destroying placed resource heap page (", FormatMemorySize(Page.GetPageSize(), 2),
+                         "). Current allocated size: ", FormatMemorySize(m_CurrAllocatedSize, 2));
+        // Allocations are only released after the GPU is done with the resources, so the heap is not in use
+        m_Pages.erase(curr_it);
+    }
+}
+
+void D3D12MemoryManager::OnPageCreated(const D3D12MemoryPage& Page)
+{
+    const auto Size = Page.GetPageSize();
+
+    m_CurrAllocatedSize += Size;
+    m_PeakAllocatedSize = std::max(m_PeakAllocatedSize, m_CurrAllocatedSize);
+    m_NumPages += 1;
+
+    if (m_AllocationCallback != nullptr)
+    {
+        MemoryAllocationEvent Event;
+        Event.Type            = MEMORY_ALLOCATION_EVENT_TYPE_ALLOCATE;
+        Event.IsDedicated     = false;
+        Event.MemoryTypeIndex = MemoryTypeIndex;
+        Event.HeapIndex       = HeapIndex;
+        Event.Size            = Size;
+        m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
+    }
+}
+
+void D3D12MemoryManager::OnPageReleased(const D3D12MemoryPage& Page)
+{
+    const auto Size = Page.GetPageSize();
+
+    VERIFY_EXPR(m_CurrAllocatedSize >= Size && m_NumPages > 0);
+    m_CurrAllocatedSize -= Size;
+    m_NumPages -= 1;
+
+    if (m_AllocationCallback != nullptr)
+    {
+        MemoryAllocationEvent Event;
+        Event.Type            = MEMORY_ALLOCATION_EVENT_TYPE_FREE;
+        Event.IsDedicated     = false;
+        Event.MemoryTypeIndex = MemoryTypeIndex;
+        Event.HeapIndex       = HeapIndex;
+        Event.Size            = Size;
+        m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
+    }
+}
+
+void D3D12MemoryManager::GetStatistics(RenderDeviceMemoryStatistics& Stats)
+{
+    Stats.NumHeaps       = std::max(Stats.NumHeaps, HeapIndex + 1);
+    Stats.NumMemoryTypes = std::max(Stats.NumMemoryTypes, MemoryTypeIndex + 1);
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    auto& PlacedStats             = Stats.MemoryTypes[MemoryTypeIndex];
+    PlacedStats.AllocatedSize     = m_CurrAllocatedSize;
+    PlacedStats.UsedSize          = static_cast<Uint64>(std::max(m_CurrUsedSize.load(), int64_t{0}));
+    PlacedStats.PeakAllocatedSize = m_PeakAllocatedSize;
+    PlacedStats.PeakUsedSize      = m_PeakUsedSize;
+    PlacedStats.NumAllocations    = m_NumPages;
+
+    Stats.MemoryTypeHeaps[MemoryTypeIndex] = HeapIndex;
+    Stats.Heaps[HeapIndex].Usage           = PlacedStats;
+}
+
+void D3D12MemoryManager::SetAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData)
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    m_AllocationCallback          = Callback;
+    m_pAllocationCallbackUserData = pUserData;
+}
+
+} // namespace Diligent
@@ -0,0 +1,272 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "D3D12ResidencyManager.hpp"
+#include "ResidencyEviction.hpp"
+#include "RenderDeviceD3D12Impl.hpp"
+#include "CommandContext.hpp"
+#include "StringTools.hpp"
+
+namespace Diligent
+{
+
+void D3D12ResidencyHandle::Release()
+{
+    if (m_pObject != nullptr)
+    {
+        VERIFY_EXPR(m_pMgr != nullptr);
+        m_pMgr->Unregister(m_pObject);
+        m_pMgr    = nullptr;
+        m_pObject = nullptr;
+    }
+}
+
+
+D3D12ResidencyManager::D3D12ResidencyManager(RenderDeviceD3D12Impl&       DeviceD3D12Impl,
+                                             ID3D12Device*                pd3d12Device,
+                                             const EngineD3D12CreateInfo& EngineCI) :
+    // clang-format off
+    m_DeviceD3D12Impl   {DeviceD3D12Impl},
+    m_pd3d12Device      {pd3d12Device   },
+    m_EvictionFrameCount{std::max(EngineCI.ResidencyEvictionFrameCount, 1u)},
+    m_MemoryBudget      {EngineCI.ResidencyMemoryBudget}
+// clang-format on
+{
+    if (!EngineCI.EnableResidencyManagement)
+        return;
+
+    if (EngineCI.BindlessHeapSize > 0)
+    {
+        LOG_WARNING_MESSAGE("Residency management is disabled because resources accessed through the bindless heap can't be tracked");
+        return;
+    }
+
+    CComPtr<IDXGIFactory4> pDXGIFactory;
+    if (FAILED(CreateDXGIFactory1(__uuidof(pDXGIFactory), reinterpret_cast<void**>(static_cast<IDXGIFactory4**>(&pDXGIFactory)))) ||
+        FAILED(pDXGIFactory->EnumAdapterByLuid(m_pd3d12Device->GetAdapterLuid(), __uuidof(m_pDXGIAdapter), reinterpret_cast<void**>(static_cast<IDXGIAdapter3**>(&m_pDXGIAdapter)))))
+    {
+        LOG_WARNING_MESSAGE("Residency management is disabled because IDXGIAdapter3 is not available");
+        return;
+    }
+
+    m_IsEnabled = true;
+}
+
+D3D12ResidencyManager::~D3D12ResidencyManager()
+{
+    if (m_IsEnabled)
+    {
+        LOG_INFO_MESSAGE("D3D12ResidencyManager stats: evicted ", m_NumEvictedObjects, " objects (", FormatMemorySize(m_EvictedSize, 2),
+                         "), made resident ", m_NumMadeResident, " objects (", FormatMemorySize(m_MadeResidentSize, 2), ")");
+    }
+    VERIFY(m_Objects.empty(), "Not all residency objects have been released");
+}
+
+D3D12ResidencyHandle D3D12ResidencyManager::Register(ID3D12Pageable* pd3d12Pageable, Uint64 Size)
+{
+    if (!m_IsEnabled)
+        return D3D12ResidencyHandle{};
+
+    VERIFY_EXPR(pd3d12Pageable != nullptr);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // The object is resident at creation and may not be evicted until the
+    // frame in which it was created has been completed by the GPU.
+    m_Objects.emplace_back(new D3D12ResidencyObject{pd3d12Pageable, Size, m_CurrentFrame});
+    auto* pObject  = m_Objects.back().get();
+    pObject->Index = m_Objects.size() - 1;
+
+    return D3D12ResidencyHandle{*this, pObject};
+}
+
+D3D12ResidencyHandle D3D12ResidencyManager::RegisterCommittedResource(ID3D12Resource* pd3d12Resource)
+{
+    if (!m_IsEnabled)
+        return D3D12ResidencyHandle{};
+
+    const auto d3d12Desc = pd3d12Resource->GetDesc();
+    const auto AllocInfo = m_pd3d12Device->GetResourceAllocationInfo(0, 1, &d3d12Desc);
+    return Register(pd3d12Resource, AllocInfo.SizeInBytes);
+}
+
+void D3D12ResidencyManager::Unregister(D3D12ResidencyObject* pObject)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto Index = pObject->Index;
+    VERIFY_EXPR(Index < m_Objects.size() && m_Objects[Index].get() == pObject);
+    if (Index != m_Objects.size() - 1)
+    {
+        std::swap(m_Objects[Index], m_Objects.back());
+        m_Objects[Index]->Index = Index;
+    }
+    m_Objects.pop_back();
+}
+
+void D3D12ResidencyManager::MakeResident(Uint32 NumContexts, const CommandContext* const* ppContexts)
+{
+    VERIFY_EXPR(m_IsEnabled);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    m_ResidentPageables.clear();
+    Uint64 RequiredSize = 0;
+    for (Uint32 i = 0; i < NumContexts; ++i)
+    {
+        for (auto* pObject : ppContexts[i]->GetResidencyUsage())
+        {
+            pObject->LastUsedFrame = m_CurrentFrame;
+            if (!pObject->IsResident)
+            {
+                // Set the flag now to skip the object if it is used by other contexts
+                pObject->IsResident = true;
+                m_ResidentPageables.emplace_back(pObject->pd3d12Pageable);
+                RequiredSize += pObject->Size;
+            }
+        }
+    }
+
+    if (m_ResidentPageables.empty())
+        return;
+
+    // Objects used by the command lists being submitted have LastUsedFrame == m_CurrentFrame
+    // and will not be evicted.
+    EvictToBudget(RequiredSize);
+
+    // MakeResident blocks until the objects are resident, so that the command lists can be submitted right away.
+    auto hr = m_pd3d12Device->MakeResident(static_cast<UINT>(m_ResidentPageables.size()), m_ResidentPageables.data());
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to make ", m_ResidentPageables.size(), " objects (", FormatMemorySize(RequiredSize, 2), ") resident");
+        return;
+    }
+
+    m_NumMadeResident += m_ResidentPageables.size();
+    m_MadeResidentSize += RequiredSize;
+}
+
+void D3D12ResidencyManager::UpdateCompletedFrames()
+{
+    const auto NumQueues = m_DeviceD3D12Impl.GetCommandQueueCount();
+    while (!m_PendingFrames.empty())
+    {
+        const auto& Frame = m_PendingFrames.front();
+        VERIFY_EXPR(Frame.FenceValues.size() == NumQueues);
+
+        bool IsCompleted = true;
+        for (Uint32 q = 0; q < NumQueues && IsCompleted; ++q)
+            IsCompleted = m_DeviceD3D12Impl.GetCompletedFenceValue(SoftwareQueueIndex{q}) >= Frame.FenceValues[q];
+        if (!IsCompleted)
+            break;
+
+        m_LastCompletedFrame = Frame.Frame;
+        m_PendingFrames.pop_front();
+    }
+}
+
+void D3D12ResidencyManager::EndFrame()
+{
+    if (!m_IsEnabled)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    const auto NumQueues = m_DeviceD3D12Impl.GetCommandQueueCount();
+
+    FrameFences Frame;
+    Frame.Frame = m_CurrentFrame;
+    Frame.FenceValues.resize(NumQueues);
+    for (Uint32 q = 0; q < NumQueues; ++q)
+    {
+        // The last fence value that has been signaled by the queue or will be signaled
+        // once the command lists submitted so far have been executed
+        Frame.FenceValues[q] = m_DeviceD3D12Impl.GetNextFenceValue(SoftwareQueueIndex{q}) - 1;
+    }
+    m_PendingFrames.emplace_back(std::move(Frame));
+
+    ++m_CurrentFrame;
+
+    EvictToBudget(0);
+}
+
+void D3D12ResidencyManager::EvictToBudget(Uint64 RequiredSize)
+{
+    DXGI_QUERY_VIDEO_MEMORY_INFO MemoryInfo{};
+    if (FAILED(m_pDXGIAdapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &MemoryInfo)))
+        return;
+
+    if (m_MemoryBudget != 0)
+        MemoryInfo.Budget = m_MemoryBudget;
+
+    if (MemoryInfo.CurrentUsage + RequiredSize <= MemoryInfo.Budget)
+        return;
+
+    UpdateCompletedFrames();
+
+    m_EvictionCandidates.clear();
+    for (auto& pObject : m_Objects)
+    {
+        if (pObject->IsResident)
+            m_EvictionCandidates.emplace_back(pObject.get());
+    }
+
+    ResidencyEvictionAttribs Attribs;
+    Attribs.Budget             = MemoryInfo.Budget;
+    Attribs.CurrentUsage       = MemoryInfo.CurrentUsage;
+    Attribs.RequiredSize       = RequiredSize;
+    Attribs.CurrentFrame       = m_CurrentFrame;
+    Attribs.LastCompletedFrame = m_LastCompletedFrame;
+    Attribs.EvictionFrameCount = m_EvictionFrameCount;
+
+    const auto EvictedSize = SelectResidencyEvictionCandidates(m_EvictionCandidates, Attribs);
+    if (m_EvictionCandidates.empty())
+        return;
+
+    m_EvictedPageables.clear();
+    for (auto* pObject : m_EvictionCandidates)
+    {
+        pObject->IsResident = false;
+        m_EvictedPageables.emplace_back(pObject->pd3d12Pageable);
+    }
+
+    if (FAILED(m_pd3d12Device->Evict(static_cast<UINT>(m_EvictedPageables.size()), m_EvictedPageables.data())))
+    {
+        LOG_ERROR_MESSAGE("Failed to evict ", m_EvictedPageables.size(), " objects");
+        for (size_t i = 0; i < m_EvictedPageables.size(); ++i)
+            m_EvictionCandidates[i]->IsResident = true;
+        return;
+    }
+
+    m_NumEvictedObjects += m_EvictedPageables.size();
+    m_EvictedSize += EvictedSize;
+}
+
+} // namespace Diligent
@@ -26,6 +26,9 @@
  */
 
 #include "pch.h"
+
+#include <thread>
+
 #include "DescriptorHeap.hpp"
 #include "RenderDeviceD3D12Impl.hpp"
 #include "D3D12Utils.h"
@@ -261,10 +264,12 @@ CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
                                      RenderDeviceD3D12Impl&      DeviceD3D12Impl,
                                      Uint32                      NumDescriptorsInHeap,
                                      D3D12_DESCRIPTOR_HEAP_TYPE  Type,
-                                     D3D12_DESCRIPTOR_HEAP_FLAGS Flags) :
+                                     D3D12_DESCRIPTOR_HEAP_FLAGS Flags,
+                                     Uint32                      ThreadCacheSize) :
     // clang-format off
     m_MemAllocator   {Allocator      },
     m_DeviceD3D12Impl{DeviceD3D12Impl},
+    m_ThreadCacheSize{ThreadCacheSize},
     m_HeapPool       (STD_ALLOCATOR_RAW_MEM(DescriptorHeapAllocationManager, GetRawAllocator(), "Allocator for vector<DescriptorHeapAllocationManager>")),
     m_AvailableHeaps (STD_ALLOCATOR_RAW_MEM(size_t, GetRawAllocator(), "Allocator for unordered_set<size_t>")),
     m_HeapDesc
@@ -284,6 +289,8 @@ CPUDescriptorHeap::CPUDescriptorHeap(IMemoryAllocator&           Allocator,
 
 CPUDescriptorHeap::~CPUDescriptorHeap()
 {
+    FlushThreadCaches();
+
     DEV_CHECK_ERR(m_CurrentSize == 0, "Not all allocations released");
 
     DEV_CHECK_ERR(m_AvailableHeaps.size() == m_HeapPool.size(), "Not all descriptor heap pools are released");
@@ -304,6 +311,13 @@ int32_t CPUDescriptorHeap::DvpGetTotalAllocationCount()
 {
     int32_t AllocationCount = 0;
 
+    // Descriptors kept in the thread caches are not counted as allocated
+    for (auto& Cache : m_ThreadCaches)
+    {
+        std::lock_guard<std::mutex> CacheGuard{Cache.Mtx};
+        AllocationCount -= static_cast<int32_t>(Cache.Descriptors.size());
+    }
+
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
     for (auto& Heap : m_HeapPool)
         AllocationCount += Heap.DvpGetAllocationsCounter();
@@ -311,9 +325,64 @@ int32_t CPUDescriptorHeap::DvpGetTotalAllocationCount()
 }
 #endif
 
+CPUDescriptorHeap::ThreadCache& CPUDescriptorHeap::GetThreadCache()
+{
+    const auto ThreadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return m_ThreadCaches[ThreadHash % NumThreadCaches];
+}
+
+void CPUDescriptorHeap::FlushThreadCaches()
+{
+    for (auto& Cache : m_ThreadCaches)
+    {
+        // Cache mutex must always be locked before the pool mutex
+        std::lock_guard<std::mutex> CacheGuard{Cache.Mtx};
+        std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+        for (auto& Descriptor : Cache.Descriptors)
+            FreeToPool(std::move(Descriptor));
+        Cache.Descriptors.clear();
+    }
+}
+
 DescriptorHeapAllocation CPUDescriptorHeap::Allocate(uint32_t Count)
 {
+    if (Count == 1 && m_ThreadCacheSize != 0)
+    {
+        // Views allocate single descriptors. Serve them from the thread cache to avoid
+        // locking the pool mutex for every allocation.
+        auto& Cache = GetThreadCache();
+
+        std::lock_guard<std::mutex> CacheGuard{Cache.Mtx};
+        if (Cache.Descriptors.empty())
+        {
+            // Refill the cache with half of its capacity
+            const auto RefillCount = std::max(m_ThreadCacheSize / 2, 1u);
+            Cache.Descriptors.reserve(m_ThreadCacheSize + 1);
+
+            std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+            for (Uint32 i = 0; i < RefillCount; ++i)
+            {
+                auto Descriptor = AllocateFromPool(1);
+                if (Descriptor.IsNull())
+                    break;
+                Cache.Descriptors.emplace_back(std::move(Descriptor));
+            }
+        }
+
+        if (Cache.Descriptors.empty())
+            return DescriptorHeapAllocation{};
+
+        auto Allocation = std::move(Cache.Descriptors.back());
+        Cache.Descriptors.pop_back();
+        return Allocation;
+    }
+
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+    return AllocateFromPool(Count);
+}
+
+DescriptorHeapAllocation CPUDescriptorHeap::AllocateFromPool(Uint32 Count)
+{
     // Note that every DescriptorHeapAllocationManager object instance is itself
     // thread-safe. Nested mutexes cannot cause a deadlock
 
@@ -401,8 +470,33 @@ void CPUDescriptorHeap::Free(DescriptorHeapAllocation&& Allocation, Uint64 CmdQu
 
 void CPUDescriptorHeap::FreeAllocation(DescriptorHeapAllocation&& Allocation)
 {
+    if (Allocation.GetNumHandles() == 1 && m_ThreadCacheSize != 0)
+    {
+        // Return the descriptor to the cache of the thread that releases it
+        auto& Cache = GetThreadCache();
+
+        std::lock_guard<std::mutex> CacheGuard{Cache.Mtx};
+        Cache.Descriptors.emplace_back(std::move(Allocation));
+        if (Cache.Descriptors.size() > m_ThreadCacheSize)
+        {
+            // Trim the cache to half of its capacity
+            std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
+            while (Cache.Descriptors.size() > m_ThreadCacheSize / 2)
+            {
+                FreeToPool(std::move(Cache.Descriptors.back()));
+                Cache.Descriptors.pop_back();
+            }
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> LockGuard(m_HeapPoolMutex);
-    auto                        ManagerId = Allocation.GetAllocationManagerId();
+    FreeToPool(std::move(Allocation));
+}
+
+void CPUDescriptorHeap::FreeToPool(DescriptorHeapAllocation&& Allocation)
+{
+    auto ManagerId = Allocation.GetAllocationManagerId();
     m_CurrentSize -= static_cast<Uint32>(Allocation.GetNumHandles());
     m_HeapPool[ManagerId].FreeAllocation(std::move(Allocation));
     // Return the manager to the pool of available managers
@@ -510,32 +604,141 @@ DynamicSuballocationsManager::DynamicSuballocationsManager(IMemoryAllocator&  Al
     // clang-format off
     m_ParentGPUHeap   {ParentGPUHeap   },
     m_DynamicChunkSize{DynamicChunkSize},
+    m_NextChunkSize   {DynamicChunkSize},
     m_Suballocations  (STD_ALLOCATOR_RAW_MEM(DescriptorHeapAllocation, GetRawAllocator(), "Allocator for vector<DescriptorHeapAllocation>")),
     m_ManagerName     {std::move(ManagerName)}
 // clang-format on
 {
+    // Do not let a single context take more than a small fraction of the dynamic space with one chunk
+    m_MaxChunkSize = std::max(m_DynamicChunkSize, std::min(m_DynamicChunkSize * 8, m_ParentGPUHeap.GetMaxDynamicDescriptors() / 32));
 }
 
 DynamicSuballocationsManager::~DynamicSuballocationsManager()
 {
     DEV_CHECK_ERR(m_Suballocations.empty() && m_CurrDescriptorCount == 0 && m_CurrSuballocationsTotalSize == 0, "All dynamic suballocations must be released!");
-    LOG_INFO_MESSAGE(m_ManagerName, " usage stats: peak descriptor count: ", m_PeakDescriptorCount, '/', m_PeakSuballocationsTotalSize);
+
+    // Return all pooled chunks to the parent heap. Retired chunks may still be in use by the GPU,
+    // so they go through the release queues of all command queues.
+    const auto QueueMask = m_ParentGPUHeap.GetDevice().GetCommandQueueMask();
+    for (auto& Retired : m_RetiredChunks)
+    {
+        for (auto& Chunk : Retired.Chunks)
+            m_ParentGPUHeap.Free(std::move(Chunk), QueueMask);
+    }
+    m_RetiredChunks.clear();
+    for (auto& Chunk : m_FreeChunks)
+        m_ParentGPUHeap.Free(std::move(Chunk), QueueMask);
+    m_FreeChunks.clear();
+
+    LOG_INFO_MESSAGE(m_ManagerName, " usage stats: peak descriptor count: ", m_PeakDescriptorCount, '/', m_PeakSuballocationsTotalSize,
+                     ", parent heap requests: ", m_ParentHeapRequestCount);
 }
 
 void DynamicSuballocationsManager::ReleaseAllocations(Uint64 CmdQueueMask)
 {
-    // Clear the list and dispose all allocated chunks of GPU descriptor heap.
-    // The chunks will be added to release queues and eventually returned to the
-    // parent GPU heap.
-    for (auto& Allocation : m_Suballocations)
+    // Instead of returning the chunks to the parent GPU heap, keep them in the pool
+    // until the GPU has finished all command buffers that may reference them.
+    if (!m_Suballocations.empty())
     {
-        m_ParentGPUHeap.Free(std::move(Allocation), CmdQueueMask);
+        auto& Device = m_ParentGPUHeap.GetDevice();
+
+        RetiredChunkList Retired;
+        for (Uint64 QueueMask = CmdQueueMask & Device.GetCommandQueueMask(); QueueMask != 0;)
+        {
+            const auto QueueInd = PlatformMisc::GetLSB(QueueMask);
+            QueueMask &= ~(Uint64{1} << Uint64{QueueInd});
+
+            const SoftwareQueueIndex QueueId{QueueInd};
+            Retired.FenceValues.emplace_back(QueueId, Device.GetNextFenceValue(QueueId));
+        }
+
+        // Grow the chunk size if one chunk was not enough for the frame
+        if (m_Suballocations.size() > 1)
+            m_NextChunkSize = std::min(m_NextChunkSize * 2, m_MaxChunkSize);
+
+        Retired.Chunks.reserve(m_Suballocations.size());
+        for (auto& Allocation : m_Suballocations)
+            Retired.Chunks.emplace_back(std::move(Allocation));
+        m_RetiredChunks.emplace_back(std::move(Retired));
     }
     m_Suballocations.clear();
+
+    ReclaimRetiredChunks();
+
+    // Return excess free chunks to the parent heap so that the pool does not keep more than
+    // twice the amount of descriptors used in this frame.
+    Uint32 FreeChunksTotalSize = 0;
+    for (const auto& Chunk : m_FreeChunks)
+        FreeChunksTotalSize += Chunk.GetNumHandles();
+    while (!m_FreeChunks.empty() && FreeChunksTotalSize > m_CurrSuballocationsTotalSize * 2)
+    {
+        FreeChunksTotalSize -= m_FreeChunks.back().GetNumHandles();
+        m_ParentGPUHeap.Free(std::move(m_FreeChunks.back()), m_ParentGPUHeap.GetDevice().GetCommandQueueMask());
+        m_FreeChunks.pop_back();
+    }
+
     m_CurrDescriptorCount         = 0;
     m_CurrSuballocationsTotalSize = 0;
 }
 
+void DynamicSuballocationsManager::ReclaimRetiredChunks()
+{
+    auto& Device = m_ParentGPUHeap.GetDevice();
+    while (!m_RetiredChunks.empty())
+    {
+        auto& Retired = m_RetiredChunks.front();
+
+        bool IsCompleted = true;
+        for (const auto& QueueFence : Retired.FenceValues)
+        {
+            if (Device.GetCompletedFenceValue(QueueFence.first) < QueueFence.second)
+            {
+                IsCompleted = false;
+                break;
+            }
+        }
+        // Chunks are retired in order, so if this list is still in use, all subsequent ones are too
+        if (!IsCompleted)
+            break;
+
+        for (auto& Chunk : Retired.Chunks)
+            m_FreeChunks.emplace_back(std::move(Chunk));
+        m_RetiredChunks.pop_front();
+    }
+}
+
+DescriptorHeapAllocation DynamicSuballocationsManager::AcquireChunk(Uint32 Count)
+{
+    auto FindFreeChunk = [&]() {
+        for (auto it = m_FreeChunks.rbegin(); it != m_FreeChunks.rend(); ++it)
+        {
+            if (it->GetNumHandles() >= Count)
+            {
+                auto Chunk = std::move(*it);
+                m_FreeChunks.erase(std::next(it).base());
+                return Chunk;
+            }
+        }
+        return DescriptorHeapAllocation{};
+    };
+
+    auto Chunk = FindFreeChunk();
+    if (Chunk.IsNull() && !m_RetiredChunks.empty())
+    {
+        ReclaimRetiredChunks();
+        Chunk = FindFreeChunk();
+    }
+
+    if (Chunk.IsNull())
+    {
+        // Request a new chunk from the parent GPU descriptor heap
+        Chunk = m_ParentGPUHeap.AllocateDynamic(std::max(m_NextChunkSize, Count));
+        ++m_ParentHeapRequestCount;
+    }
+
+    return Chunk;
+}
+
 DescriptorHeapAllocation DynamicSuballocationsManager::Allocate(Uint32 Count)
 {
     // This method is intentionally lock-free as it is expected to
@@ -545,21 +748,19 @@ DescriptorHeapAllocation DynamicSuballocationsManager::Allocate(Uint32 Count)
     if (m_Suballocations.empty() ||
         m_CurrentSuballocationOffset + Count > m_Suballocations.back().GetNumHandles())
     {
-        // Request a new chunk from the parent GPU descriptor heap
-        auto SuballocationSize       = std::max(m_DynamicChunkSize, Count);
-        auto NewDynamicSubAllocation = m_ParentGPUHeap.AllocateDynamic(SuballocationSize);
+        auto NewDynamicSubAllocation = AcquireChunk(Count);
         if (NewDynamicSubAllocation.IsNull())
         {
             LOG_ERROR("Dynamic space in ", GetD3D12DescriptorHeapTypeLiteralName(m_ParentGPUHeap.GetHeapDesc().Type), " GPU descriptor heap is exhausted.");
             return DescriptorHeapAllocation();
         }
+        const auto SuballocationSize = static_cast<Uint32>(NewDynamicSubAllocation.GetNumHandles());
         m_Suballocations.emplace_back(std::move(NewDynamicSubAllocation));
         m_CurrentSuballocationOffset = 0;
 
         m_CurrSuballocationsTotalSize += SuballocationSize;
         m_PeakSuballocationsTotalSize = std::max(m_PeakSuballocationsTotalSize, m_CurrSuballocationsTotalSize);
     }
-
     // Perform suballocation from the last chunk
     auto& CurrentSuballocation = m_Suballocations.back();
 
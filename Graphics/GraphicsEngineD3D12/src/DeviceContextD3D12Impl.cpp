@@ -40,12 +40,16 @@
 #include "ShaderResourceBindingD3D12Impl.hpp"
 #include "CommandListD3D12Impl.hpp"
 #include "CommandQueueD3D12Impl.hpp"
+#include "ResourceHeapD3D12Impl.hpp"
 
 #include "CommandContext.hpp"
 #include "D3D12TypeConversions.hpp"
 #include "d3dx12_win.h"
 #include "D3D12DynamicHeap.hpp"
 #include "DXGITypeConversions.hpp"
+#include "HashUtils.hpp"
+#include "Align.hpp"
+#include "SmallVector.hpp"
 
 namespace Diligent
 {
@@ -98,6 +102,7 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
 {
     if (!IsDeferred())
     {
+        m_BatchCommandListSubmission = EngineCI.BatchCommandListSubmission;
         RequestCommandContext();
     }
     auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
@@ -109,12 +114,12 @@ DeviceContextD3D12Impl::DeviceContextD3D12Impl(IReferenceCounters*          pRef
     CmdSignatureDesc.NumArgumentDescs = 1;
     CmdSignatureDesc.pArgumentDescs   = &IndirectArg;
 
-    CmdSignatureDesc.ByteStride = sizeof(UINT) * 4;
+    CmdSignatureDesc.ByteStride = DrawIndirectCommandStride;
     IndirectArg.Type            = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
     auto hr                     = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(m_pDrawIndirectSignature), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&m_pDrawIndirectSignature)));
     CHECK_D3D_RESULT_THROW(hr, "Failed to create indirect draw command signature");
 
-    CmdSignatureDesc.ByteStride = sizeof(UINT) * 5;
+    CmdSignatureDesc.ByteStride = DrawIndexedIndirectCommandStride;
     IndirectArg.Type            = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
     hr                          = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(m_pDrawIndexedIndirectSignature), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&m_pDrawIndexedIndirectSignature)));
     CHECK_D3D_RESULT_THROW(hr, "Failed to create draw indexed indirect command signature");
@@ -181,6 +186,9 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
     // In this case there are no resources to release, so there will be no issues.
     FinishFrame();
 
+    if (m_pd3d12PredicationBuffer)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_pd3d12PredicationBuffer), Uint64{1} << GetCommandQueueId());
+
     // Note: as dynamic pages are returned to the global dynamic memory manager hosted by the render device,
     // the dynamic heap can be destroyed before all pages are actually returned to the global manager.
     DEV_CHECK_ERR(m_DynamicHeap.GetAllocatedPagesCount() == 0, "All dynamic pages must have been released by now.");
@@ -194,12 +202,12 @@ DeviceContextD3D12Impl::~DeviceContextD3D12Impl()
     }
 }
 
-void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId)
+void DeviceContextD3D12Impl::Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags)
 {
     DEV_CHECK_ERR(ImmediateContextId < m_pDevice->GetCommandQueueCount(), "ImmediateContextId is out of range");
     const auto d3d12CmdListType = m_pDevice->GetCommandQueueType(SoftwareQueueIndex{ImmediateContextId});
     const auto QueueType        = D3D12CommandListTypeToCmdQueueType(d3d12CmdListType);
-    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, QueueType);
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, QueueType, Flags);
     RequestCommandContext();
 }
 
@@ -342,12 +350,20 @@ void DeviceContextD3D12Impl::CommitRootTablesAndViews(RootTableInfo& RootInfo, U
         {
             // Commit root views for stale SRBs only
             pSignature->CommitRootTables(CommitAttribs);
+
+            // Stale SRBs are committed again in every new command list,
+            // so this is where the command list starts using their resources.
+            if (m_pDevice->GetResidencyManager().IsEnabled())
+                pResourceCache->AddResidencyUsage(CmdCtx);
         }
 
         // Always commit root views. If the root view is up-to-date (e.g. it is not stale and is intact),
         // the bit should not be set in CommitSRBMask.
         if (auto DynamicRootBuffersMask = pResourceCache->GetDynamicRootBuffersMask())
         {
+            DEV_CHECK_ERR(!IsRecordingReusableCommandList(),
+                          "Dynamic buffers bound as root views have their GPU address baked into the command list and can't be used in "
+                          "a reusable command list. Use buffers with USAGE_DEFAULT instead.");
             DEV_CHECK_ERR((RootInfo.DynamicSRBMask & SignBit) != 0,
                           "There are dynamic root buffers in the cache, but the bit in DynamicSRBMask is not set. This may indicate that resources "
                           "in the cache have changed, but the SRB has not been committed before the draw/dispatch command.");
@@ -417,7 +433,7 @@ DeviceContextD3D12Impl::RootTableInfo& DeviceContextD3D12Impl::GetRootTableInfo(
 #ifdef DILIGENT_DEVELOPMENT
 void DeviceContextD3D12Impl::DvpValidateCommittedShaderResources(RootTableInfo& RootInfo)
 {
-    if (RootInfo.ResourcesValidated)
+    if (RootInfo.ResourcesValidated || !m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_RESOURCE_BINDING))
         return;
 
     DvpVerifySRBCompatibility(RootInfo,
@@ -447,6 +463,15 @@ void DeviceContextD3D12Impl::SetBlendFactors(const float* pBlendFactors)
     }
 }
 
+void DeviceContextD3D12Impl::SetDynamicStates(const DynamicStateAttribs& Attribs)
+{
+    if (TDeviceContextBase::SetDynamicStates(Attribs, 0))
+    {
+        // Pipelines with dynamic states can't be created when DynamicPipelineStates feature is disabled
+        UNEXPECTED("Dynamic pipeline states are not supported in this backend");
+    }
+}
+
 void DeviceContextD3D12Impl::CommitD3D12IndexBuffer(GraphicsContext& GraphCtx, VALUE_TYPE IndexType)
 {
     DEV_CHECK_ERR(m_pIndexBuffer != nullptr, "Index buffer is not set up for indexed draw command");
@@ -476,6 +501,8 @@ void DeviceContextD3D12Impl::CommitD3D12IndexBuffer(GraphicsContext& GraphCtx, V
         m_pIndexBuffer->DvpVerifyDynamicAllocation(this);
 #endif
 
+    GraphCtx.AddResidencyUsage(m_pIndexBuffer->GetResidencyObject());
+
     Uint64 BuffDataStartByteOffset;
     auto*  pd3d12Buff = m_pIndexBuffer->GetD3D12Buffer(BuffDataStartByteOffset, this);
 
@@ -508,7 +535,7 @@ void DeviceContextD3D12Impl::CommitD3D12VertexBuffers(GraphicsContext& GraphCtx)
     {
         auto& CurrStream = m_VertexStreams[Buff];
         auto& VBView     = VBViews[Buff];
-        if (auto* pBufferD3D12 = CurrStream.pBuffer.RawPtr())
+        if (auto* pBufferD3D12 = CurrStream.pBuffer)
         {
             if (pBufferD3D12->GetDesc().Usage == USAGE_DYNAMIC)
             {
@@ -523,6 +550,8 @@ void DeviceContextD3D12Impl::CommitD3D12VertexBuffers(GraphicsContext& GraphCtx)
             // so there is no need to reference the resource here
             //GraphicsCtx.AddReferencedObject(pd3d12Resource);
 
+            GraphCtx.AddResidencyUsage(pBufferD3D12->GetResidencyObject());
+
             VBView.BufferLocation = pBufferD3D12->GetGPUAddress(GetContextId(), this) + CurrStream.Offset;
             VBView.StrideInBytes  = m_pPipelineState->GetBufferStride(Buff);
             // Note that for a dynamic buffer, what we use here is the size of the buffer itself, not the upload heap buffer!
@@ -560,7 +589,7 @@ void DeviceContextD3D12Impl::PrepareForDraw(GraphicsContext& GraphCtx, DRAW_FLAG
         for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
         {
             const auto& CurrStream   = m_VertexStreams[Buff];
-            const auto* pBufferD3D12 = CurrStream.pBuffer.RawPtr();
+            const auto* pBufferD3D12 = CurrStream.pBuffer;
             if (pBufferD3D12 != nullptr)
             {
                 DvpVerifyBufferState(*pBufferD3D12, RESOURCE_STATE_VERTEX_BUFFER, "Using vertex buffers (DeviceContextD3D12Impl::Draw())");
@@ -600,6 +629,7 @@ void DeviceContextD3D12Impl::PrepareForIndexedDraw(GraphicsContext& GraphCtx, DR
 void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 {
     DvpVerifyDrawArguments(Attribs);
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -610,6 +640,7 @@ void DeviceContextD3D12Impl::Draw(const DrawAttribs& Attribs)
 void DeviceContextD3D12Impl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
     DvpVerifyDrawIndexedArguments(Attribs);
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
@@ -639,9 +670,229 @@ void DeviceContextD3D12Impl::PrepareIndirectAttribsBuffer(CommandContext&
     pd3d12ArgsBuff = pIndirectDrawAttribsD3D12->GetD3D12Buffer(BuffDataStartByteOffset, this);
 }
 
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE ArgType, Uint32 Stride)
+{
+    VERIFY_EXPR(ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW || ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED);
+    if (ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW && Stride == DrawIndirectCommandStride)
+        return m_pDrawIndirectSignature;
+    if (ArgType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED && Stride == DrawIndexedIndirectCommandStride)
+        return m_pDrawIndexedIndirectSignature;
+
+    const Uint64 Key     = (Uint64{static_cast<Uint32>(ArgType)} << 32u) | Uint64{Stride};
+    auto&        pCmdSig = m_CustomStrideDrawSignatures[Key];
+    if (!pCmdSig)
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC IndirectArg = {};
+        IndirectArg.Type                         = ArgType;
+
+        D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc = {};
+        CmdSignatureDesc.ByteStride                   = Stride;
+        CmdSignatureDesc.NumArgumentDescs             = 1;
+        CmdSignatureDesc.pArgumentDescs               = &IndirectArg;
+        CmdSignatureDesc.NodeMask                     = 0;
+
+        auto* pd3d12Device = m_pDevice->GetD3D12Device();
+        auto  hr           = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, nullptr, __uuidof(pCmdSig), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pCmdSig)));
+        if (FAILED(hr))
+            LOG_ERROR_MESSAGE("Failed to create indirect draw command signature with stride ", Stride);
+    }
+    return pCmdSig;
+}
+
+static bool IndirectArgumentsEqual(const D3D12_INDIRECT_ARGUMENT_DESC& Arg0, const D3D12_INDIRECT_ARGUMENT_DESC& Arg1)
+{
+    if (Arg0.Type != Arg1.Type)
+        return false;
+
+    switch (Arg0.Type)
+    {
+        case D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW:
+            return Arg0.VertexBuffer.Slot == Arg1.VertexBuffer.Slot;
+
+        case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT:
+            return Arg0.Constant.RootParameterIndex == Arg1.Constant.RootParameterIndex &&
+                Arg0.Constant.DestOffsetIn32BitValues == Arg1.Constant.DestOffsetIn32BitValues &&
+                Arg0.Constant.Num32BitValuesToSet == Arg1.Constant.Num32BitValuesToSet;
+
+        case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW:
+            return Arg0.ConstantBufferView.RootParameterIndex == Arg1.ConstantBufferView.RootParameterIndex;
+
+        case D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW:
+            return Arg0.ShaderResourceView.RootParameterIndex == Arg1.ShaderResourceView.RootParameterIndex;
+
+        case D3D12_INDIRECT_ARGUMENT_TYPE_UNORDERED_ACCESS_VIEW:
+            return Arg0.UnorderedAccessView.RootParameterIndex == Arg1.UnorderedAccessView.RootParameterIndex;
+
+        default:
+            return true;
+    }
+}
+
+bool DeviceContextD3D12Impl::CustomCommandSignatureKey::operator==(const CustomCommandSignatureKey& rhs) const
+{
+    if (pd3d12RootSig != rhs.pd3d12RootSig || ByteStride != rhs.ByteStride || Arguments.size() != rhs.Arguments.size())
+        return false;
+
+    for (size_t i = 0; i < Arguments.size(); ++i)
+    {
+        if (!IndirectArgumentsEqual(Arguments[i], rhs.Arguments[i]))
+            return false;
+    }
+    return true;
+}
+
+size_t DeviceContextD3D12Impl::CustomCommandSignatureKey::Hasher::operator()(const CustomCommandSignatureKey& Key) const
+{
+    size_t Hash = ComputeHash(static_cast<ID3D12RootSignature*>(Key.pd3d12RootSig), Key.ByteStride, Key.Arguments.size());
+    for (const auto& Arg : Key.Arguments)
+    {
+        HashCombine(Hash, static_cast<Uint32>(Arg.Type));
+        // All root argument descriptions start with the root parameter index, and
+        // the vertex buffer view description only contains the slot.
+        if (Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_DRAW &&
+            Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED &&
+            Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH &&
+            Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW &&
+            Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_RAYS &&
+            Arg.Type != D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH)
+            HashCombine(Hash, Arg.Constant.RootParameterIndex);
+    }
+    return Hash;
+}
+
+ID3D12CommandSignature* DeviceContextD3D12Impl::GetCustomCommandSignature(const ExecuteIndirectAttribsD3D12& Attribs, ID3D12RootSignature* pd3d12RootSig)
+{
+    CustomCommandSignatureKey Key;
+    Key.pd3d12RootSig = pd3d12RootSig;
+    Key.ByteStride    = Attribs.ByteStride;
+    Key.Arguments.assign(Attribs.pArguments, Attribs.pArguments + Attribs.NumArguments);
+
+    auto it = m_CustomCommandSignatures.find(Key);
+    if (it != m_CustomCommandSignatures.end())
+        return it->second;
+
+    D3D12_COMMAND_SIGNATURE_DESC CmdSignatureDesc = {};
+    CmdSignatureDesc.ByteStride                   = Attribs.ByteStride;
+    CmdSignatureDesc.NumArgumentDescs             = Attribs.NumArguments;
+    CmdSignatureDesc.pArgumentDescs               = Attribs.pArguments;
+    CmdSignatureDesc.NodeMask                     = 0;
+
+    CComPtr<ID3D12CommandSignature> pCmdSig;
+
+    auto* pd3d12Device = m_pDevice->GetD3D12Device();
+    auto  hr           = pd3d12Device->CreateCommandSignature(&CmdSignatureDesc, pd3d12RootSig, __uuidof(pCmdSig), reinterpret_cast<void**>(static_cast<ID3D12CommandSignature**>(&pCmdSig)));
+    if (FAILED(hr))
+    {
+        LOG_ERROR_MESSAGE("Failed to create custom command signature with ", Attribs.NumArguments, " arguments and stride ", Attribs.ByteStride);
+        return nullptr;
+    }
+
+    return m_CustomCommandSignatures.emplace(std::move(Key), std::move(pCmdSig)).first->second;
+}
+
+void DeviceContextD3D12Impl::ExecuteIndirect(const ExecuteIndirectAttribsD3D12& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.pArguments != nullptr && Attribs.NumArguments > 0, "Command signature must contain at least one argument");
+    DEV_CHECK_ERR(Attribs.pArgsBuffer != nullptr, "Indirect arguments buffer must not be null");
+    DEV_CHECK_ERR(m_pPipelineState, "No pipeline state is bound");
+
+    bool ChangesVBs      = false;
+    bool ChangesIB       = false;
+    bool ChangesRootArgs = false;
+    for (Uint32 i = 0; i < Attribs.NumArguments; ++i)
+    {
+        switch (Attribs.pArguments[i].Type)
+        {
+            case D3D12_INDIRECT_ARGUMENT_TYPE_VERTEX_BUFFER_VIEW:
+                ChangesVBs = true;
+                break;
+
+            case D3D12_INDIRECT_ARGUMENT_TYPE_INDEX_BUFFER_VIEW:
+                ChangesIB = true;
+                break;
+
+            case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT_BUFFER_VIEW:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_SHADER_RESOURCE_VIEW:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_UNORDERED_ACCESS_VIEW:
+                ChangesRootArgs = true;
+                break;
+
+            case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH:
+            case D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH:
+                DEV_CHECK_ERR(i == Attribs.NumArguments - 1, "Draw or dispatch argument must be the last argument in the command signature");
+                break;
+
+            default:
+                DEV_ERROR("Indirect argument type ", static_cast<Uint32>(Attribs.pArguments[i].Type), " is not supported by ExecuteIndirect()");
+        }
+    }
+
+    const auto CmdType = Attribs.pArguments[Attribs.NumArguments - 1].Type;
+
+    const bool IsDispatch = CmdType == D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH;
+    DEV_CHECK_ERR(!IsDispatch || m_pPipelineState->GetDesc().IsComputePipeline(),
+                  "Dispatch command signature requires a compute pipeline, but pipeline state '", m_pPipelineState->GetDesc().Name, "' is not");
+    DEV_CHECK_ERR(IsDispatch || m_pPipelineState->GetDesc().IsAnyGraphicsPipeline(),
+                  "Draw command signature requires a graphics pipeline, but pipeline state '", m_pPipelineState->GetDesc().Name, "' is not");
+    DEV_CHECK_ERR(!ChangesVBs && !ChangesIB || CmdType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW || CmdType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED,
+                  "Vertex and index buffer views can only be changed by draw command signatures");
+
+    auto& CmdCtx   = GetCmdContext();
+    auto& RootInfo = GetRootTableInfo(IsDispatch ? PIPELINE_TYPE_COMPUTE : PIPELINE_TYPE_GRAPHICS);
+    if (IsDispatch)
+        PrepareForDispatchCompute(CmdCtx.AsComputeContext());
+    else if (CmdType == D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED && !ChangesIB)
+        PrepareForIndexedDraw(CmdCtx.AsGraphicsContext(), Attribs.Flags, Attribs.IndexType);
+    else
+        PrepareForDraw(CmdCtx.AsGraphicsContext(), Attribs.Flags);
+
+    ID3D12Resource* pd3d12ArgsBuff;
+    Uint64          ArgsBuffDataStartByteOffset;
+    PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pArgsBuffer, Attribs.ArgsBufferStateTransitionMode, pd3d12ArgsBuff, ArgsBuffDataStartByteOffset,
+                                 "Indirect buffer (DeviceContextD3D12Impl::ExecuteIndirect)");
+
+    ID3D12Resource* pd3d12CountBuff              = nullptr;
+    Uint64          CountBuffDataStartByteOffset = 0;
+    if (Attribs.pCountBuffer != nullptr)
+    {
+        PrepareIndirectAttribsBuffer(CmdCtx, Attribs.pCountBuffer, Attribs.CountBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                     "Count buffer (DeviceContextD3D12Impl::ExecuteIndirect)");
+        CountBuffDataStartByteOffset += Attribs.CountBufferOffset;
+    }
+
+    // The root signature is only required when the command signature changes root arguments
+    auto* pCmdSignature = GetCustomCommandSignature(Attribs, ChangesRootArgs ? RootInfo.pd3d12RootSig : nullptr);
+    if (pCmdSignature == nullptr)
+        return;
+
+    CmdCtx.ExecuteIndirect(pCmdSignature, Attribs.MaxCommandCount,
+                           pd3d12ArgsBuff, Attribs.ArgsBufferOffset + ArgsBuffDataStartByteOffset,
+                           pd3d12CountBuff, CountBuffDataStartByteOffset);
+
+    // Bindings changed by the command signature are left in the state set by the last command
+    // and must be re-committed by the next draw or dispatch.
+    if (ChangesVBs)
+        m_State.bCommittedD3D12VBsUpToDate = false;
+    if (ChangesIB)
+    {
+        m_State.bCommittedD3D12IBUpToDate = false;
+        m_State.CommittedD3D12IndexBuffer = nullptr;
+    }
+    if (ChangesRootArgs)
+        RootInfo.MakeAllStale();
+
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -651,13 +902,24 @@ void DeviceContextD3D12Impl::DrawIndirect(const DrawIndirectAttribs& Attribs, IB
     PrepareIndirectAttribsBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
                                  "Indirect draw (DeviceContextD3D12Impl::DrawIndirect)");
 
-    GraphCtx.ExecuteIndirect(m_pDrawIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
+    if (Attribs.DrawCount > 1)
+    {
+        auto* pCmdSignature = GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, Attribs.DrawArgsStride);
+        GraphCtx.ExecuteIndirect(pCmdSignature, Attribs.DrawCount, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset, nullptr, 0);
+    }
+    else
+    {
+        GraphCtx.ExecuteIndirect(m_pDrawIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
+    }
     ++m_State.NumCommands;
 }
 
 void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
@@ -667,13 +929,68 @@ void DeviceContextD3D12Impl::DrawIndexedIndirect(const DrawIndexedIndirectAttrib
     PrepareIndirectAttribsBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, BuffDataStartByteOffset,
                                  "indexed Indirect draw (DeviceContextD3D12Impl::DrawIndexedIndirect)");
 
-    GraphCtx.ExecuteIndirect(m_pDrawIndexedIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
+    if (Attribs.DrawCount > 1)
+    {
+        auto* pCmdSignature = GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, Attribs.DrawArgsStride);
+        GraphCtx.ExecuteIndirect(pCmdSignature, Attribs.DrawCount, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset, nullptr, 0);
+    }
+    else
+    {
+        GraphCtx.ExecuteIndirect(m_pDrawIndexedIndirectSignature, pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + BuffDataStartByteOffset);
+    }
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForDraw(GraphCtx, Attribs.Flags);
+
+    ID3D12Resource* pd3d12ArgsBuff;
+    ID3D12Resource* pd3d12CountBuff;
+    Uint64          ArgsBuffDataStartByteOffset;
+    Uint64          CountBuffDataStartByteOffset;
+    PrepareIndirectAttribsBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, ArgsBuffDataStartByteOffset,
+                                 "Indirect buffer (DeviceContextD3D12Impl::DrawIndirectCount)");
+    PrepareIndirectAttribsBuffer(GraphCtx, pCountBuffer, Attribs.CountBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                 "Count buffer (DeviceContextD3D12Impl::DrawIndirectCount)");
+
+    GraphCtx.ExecuteIndirect(GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW, Attribs.DrawArgsStride), Attribs.MaxCommandCount,
+                             pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + ArgsBuffDataStartByteOffset,
+                             pd3d12CountBuff, Attribs.CountBufferOffset + CountBuffDataStartByteOffset);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+    auto& GraphCtx = GetCmdContext().AsGraphicsContext();
+    PrepareForIndexedDraw(GraphCtx, Attribs.Flags, Attribs.IndexType);
+
+    ID3D12Resource* pd3d12ArgsBuff;
+    ID3D12Resource* pd3d12CountBuff;
+    Uint64          ArgsBuffDataStartByteOffset;
+    Uint64          CountBuffDataStartByteOffset;
+    PrepareIndirectAttribsBuffer(GraphCtx, pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, pd3d12ArgsBuff, ArgsBuffDataStartByteOffset,
+                                 "Indirect buffer (DeviceContextD3D12Impl::DrawIndexedIndirectCount)");
+    PrepareIndirectAttribsBuffer(GraphCtx, pCountBuffer, Attribs.CountBufferStateTransitionMode, pd3d12CountBuff, CountBuffDataStartByteOffset,
+                                 "Count buffer (DeviceContextD3D12Impl::DrawIndexedIndirectCount)");
+
+    GraphCtx.ExecuteIndirect(GetDrawIndirectSignature(D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED, Attribs.DrawArgsStride), Attribs.MaxCommandCount,
+                             pd3d12ArgsBuff, Attribs.IndirectDrawArgsOffset + ArgsBuffDataStartByteOffset,
+                             pd3d12CountBuff, Attribs.CountBufferOffset + CountBuffDataStartByteOffset);
     ++m_State.NumCommands;
 }
 
 void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     DvpVerifyDrawMeshArguments(Attribs);
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext6();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -685,6 +1002,7 @@ void DeviceContextD3D12Impl::DrawMesh(const DrawMeshAttribs& Attribs)
 void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawMeshIndirectArguments(Attribs, pAttribsBuffer);
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -701,6 +1019,7 @@ void DeviceContextD3D12Impl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Att
 void DeviceContextD3D12Impl::DrawMeshIndirectCount(const DrawMeshIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
 {
     DvpVerifyDrawMeshIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
 
     auto& GraphCtx = GetCmdContext().AsGraphicsContext();
     PrepareForDraw(GraphCtx, Attribs.Flags);
@@ -749,6 +1068,7 @@ void DeviceContextD3D12Impl::PrepareForDispatchRays(GraphicsContext& GraphCtx)
 void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     DvpVerifyDispatchArguments(Attribs);
+    CountDispatchCommand();
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
     PrepareForDispatchCompute(ComputeCtx);
@@ -759,6 +1079,7 @@ void DeviceContextD3D12Impl::DispatchCompute(const DispatchComputeAttribs& Attri
 void DeviceContextD3D12Impl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer);
+    CountDispatchCommand();
 
     auto& ComputeCtx = GetCmdContext().AsComputeContext();
     PrepareForDispatchCompute(ComputeCtx);
@@ -825,51 +1146,104 @@ void DeviceContextD3D12Impl::RequestCommandContext()
     m_CurrCmdCtx->SetDynamicGPUDescriptorAllocators(m_DynamicGPUDescriptorAllocator);
 }
 
-void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
-                                   Uint32               NumCommandLists,
-                                   ICommandList* const* ppCommandLists)
+void DeviceContextD3D12Impl::EnqueueCurrentCmdContext()
 {
-    VERIFY(!IsDeferred() || NumCommandLists == 0 && ppCommandLists == nullptr, "Only immediate context can execute command lists");
-
-    DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
-                  "Flushing device context that has ", m_ActiveQueriesCounter,
-                  " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
-
-    // TODO: use small_vector
-    std::vector<RenderDeviceD3D12Impl::PooledCommandContext> Contexts;
-    Contexts.reserve(NumCommandLists + 1);
+    if (!m_CurrCmdCtx)
+        return;
 
-    // First, execute current context
-    if (m_CurrCmdCtx)
+    VERIFY(!IsDeferred(), "Deferred contexts cannot execute command lists directly");
+    if (m_State.NumCommands != 0)
     {
-        VERIFY(!IsDeferred(), "Deferred contexts cannot execute command lists directly");
-        if (m_State.NumCommands != 0)
-            Contexts.emplace_back(std::move(m_CurrCmdCtx));
-        else
-            m_pDevice->DisposeCommandContext(std::move(m_CurrCmdCtx));
+        m_PendingCmdContexts.emplace_back(std::move(m_CurrCmdCtx));
+        m_PendingD3D12CmdLists.emplace_back(nullptr);
+    }
+    else
+    {
+        m_pDevice->DisposeCommandContext(std::move(m_CurrCmdCtx));
     }
+}
 
-    // Next, add extra command lists from deferred contexts
+void DeviceContextD3D12Impl::EnqueueCommandLists(Uint32               NumCommandLists,
+                                                 ICommandList* const* ppCommandLists)
+{
     for (Uint32 i = 0; i < NumCommandLists; ++i)
     {
         auto* const pCmdListD3D12 = ValidatedCast<CommandListD3D12Impl>(ppCommandLists[i]);
 
         RefCntAutoPtr<DeviceContextD3D12Impl> pDeferredCtx;
-        Contexts.emplace_back(pCmdListD3D12->Close(pDeferredCtx));
-        VERIFY(Contexts.back() && pDeferredCtx, "Trying to execute empty command buffer");
-        // Set the bit in the deferred context cmd queue mask corresponding to the cmd queue of this context
+        if (pCmdListD3D12->IsReusable())
+        {
+            // Reusable command lists are closed when recording is finished and remain owned by the command list
+            m_PendingCmdContexts.emplace_back();
+            m_PendingD3D12CmdLists.emplace_back(pCmdListD3D12->GetD3D12CommandList());
+            m_PendingReusableCmdLists.emplace_back(pCmdListD3D12);
+            pDeferredCtx = pCmdListD3D12->GetDeferredContext();
+        }
+        else
+        {
+            m_PendingCmdContexts.emplace_back(pCmdListD3D12->Close(pDeferredCtx));
+            m_PendingD3D12CmdLists.emplace_back(nullptr);
+            VERIFY(m_PendingCmdContexts.back() && pDeferredCtx, "Trying to execute empty command buffer");
+        }
+        // Set the bit in the deferred context cmd queue mask corresponding to the cmd queue of this context.
+        // This must be done before the deferred context finishes the frame, which may happen before
+        // the batch is submitted.
         pDeferredCtx->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
     }
+}
+
+void DeviceContextD3D12Impl::Flush(bool                 RequestNewCmdCtx,
+                                   Uint32               NumCommandLists,
+                                   ICommandList* const* ppCommandLists)
+{
+    VERIFY(!IsDeferred() || NumCommandLists == 0 && ppCommandLists == nullptr, "Only immediate context can execute command lists");
+
+    DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
+                  "Flushing device context that has ", m_ActiveQueriesCounter,
+                  " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(),
+                  "Flushing device context inside an active conditional rendering block. Predication state does not persist across command lists");
 
-    if (!Contexts.empty())
+    // Command lists queued by previous calls to ExecuteCommandLists() go first, followed by
+    // the current context and the command lists passed to this method.
+    EnqueueCurrentCmdContext();
+    EnqueueCommandLists(NumCommandLists, ppCommandLists);
+
+    if (!m_PendingCmdContexts.empty())
     {
-        m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(Contexts.size()), Contexts.data(), true, &m_SignalFences, &m_WaitFences);
+        VERIFY_EXPR(m_PendingCmdContexts.size() == m_PendingD3D12CmdLists.size());
+
+        auto& ResidencyMgr = m_pDevice->GetResidencyManager();
+        if (ResidencyMgr.IsEnabled())
+        {
+            // Reusable command lists keep the contexts they were recorded in
+            std::vector<const CommandContext*> CmdContexts;
+            CmdContexts.reserve(m_PendingCmdContexts.size());
+            for (const auto& pCtx : m_PendingCmdContexts)
+            {
+                if (pCtx)
+                    CmdContexts.emplace_back(pCtx.get());
+            }
+            for (const auto& pCmdList : m_PendingReusableCmdLists)
+                CmdContexts.emplace_back(&pCmdList.RawPtr<CommandListD3D12Impl>()->GetCmdContext());
+            ResidencyMgr.MakeResident(static_cast<Uint32>(CmdContexts.size()), CmdContexts.data());
+        }
+
+        const auto SubmittedFenceValue =
+            m_pDevice->CloseAndExecuteCommandContexts(GetCommandQueueId(), static_cast<Uint32>(m_PendingCmdContexts.size()), m_PendingCmdContexts.data(),
+                                                      true, &m_SignalFences, &m_WaitFences, m_PendingD3D12CmdLists.data());
         m_SignalFences.clear();
 
+        for (auto& pCmdList : m_PendingReusableCmdLists)
+            pCmdList.RawPtr<CommandListD3D12Impl>()->OnSubmitted(GetCommandQueueId(), SubmittedFenceValue);
+
 #ifdef DILIGENT_DEBUG
-        for (Uint32 i = 0; i < NumCommandLists; ++i)
-            VERIFY(!Contexts[i], "All contexts must be disposed by CloseAndExecuteCommandContexts");
+        for (const auto& pCtx : m_PendingCmdContexts)
+            VERIFY(!pCtx, "All contexts must be disposed by CloseAndExecuteCommandContexts");
 #endif
+        m_PendingCmdContexts.clear();
+        m_PendingD3D12CmdLists.clear();
+        m_PendingReusableCmdLists.clear();
     }
 
     m_WaitFences.clear();
@@ -951,6 +1325,8 @@ void DeviceContextD3D12Impl::FinishFrame()
 
     // Dynamic GPU descriptor allocations are returned to the global GPU descriptor heap
     // hosted by the render device.
+    if (m_CurrCmdCtx)
+        m_CurrCmdCtx->DiscardDynamicSamplerTables();
     for (size_t i = 0; i < _countof(m_DynamicGPUDescriptorAllocator); ++i)
         m_DynamicGPUDescriptorAllocator[i].ReleaseAllocations(QueueMask);
 
@@ -970,7 +1346,7 @@ void DeviceContextD3D12Impl::SetVertexBuffers(Uint32                         Sta
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
-        if (auto* pBufferD3D12 = CurrStream.pBuffer.RawPtr())
+        if (auto* pBufferD3D12 = CurrStream.pBuffer)
             TransitionOrVerifyBufferState(CmdCtx, *pBufferD3D12, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, "Setting vertex buffers (DeviceContextD3D12Impl::SetVertexBuffers)");
     }
 
@@ -1426,6 +1802,9 @@ void DeviceContextD3D12Impl::EndRenderPass()
 
 D3D12DynamicAllocation DeviceContextD3D12Impl::AllocateDynamicSpace(size_t NumBytes, size_t Alignment)
 {
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(),
+                  "Dynamic heap allocations are only valid until the end of the frame and can't be used in a reusable command list. "
+                  "Use buffers with USAGE_DEFAULT and update their contents before executing the command list.");
     return m_DynamicHeap.Allocate(NumBytes, Alignment, GetFrameNumber());
 }
 
@@ -1458,6 +1837,35 @@ void DeviceContextD3D12Impl::UpdateBuffer(IBuffer*                       pBuffer
     // be resource barrier issues in the cmd list in the device context
     auto* pBuffD3D12 = ValidatedCast<BufferD3D12Impl>(pBuffer);
     VERIFY(pBuffD3D12->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers must be updated via Map()");
+
+    // Tiny updates are written directly by the command processor with WriteBufferImmediate,
+    // which saves the dynamic heap space and the copy command.
+    constexpr Uint32 MaxImmediateWriteSize = 64;
+    auto&            CmdCtx                = GetCmdContext();
+    if (Size <= MaxImmediateWriteSize && (Offset % 4) == 0 && (Size % 4) == 0 && CmdCtx.GetMaxInterfaceVersion() >= 2)
+    {
+        DEV_CHECK_ERR(Uint64{Offset} + Uint64{Size} <= pBuffD3D12->GetDesc().uiSizeInBytes,
+                      "Update region is out of buffer bounds which will result in an undefined behavior");
+
+        TransitionOrVerifyBufferState(CmdCtx, *pBuffD3D12, StateTransitionMode, RESOURCE_STATE_COPY_DEST, "Updating buffer (DeviceContextD3D12Impl::UpdateBuffer)");
+        Uint64 DstBuffDataStartByteOffset;
+        auto*  pd3d12Buff = pBuffD3D12->GetD3D12Buffer(DstBuffDataStartByteOffset, this);
+        VERIFY(DstBuffDataStartByteOffset == 0, "Dst buffer must not be suballocated");
+
+        const auto GPUAddress = pd3d12Buff->GetGPUVirtualAddress() + Offset;
+
+        D3D12_WRITEBUFFERIMMEDIATE_PARAMETER Params[MaxImmediateWriteSize / 4];
+        const UINT                           NumParams = Size / 4;
+        for (UINT i = 0; i < NumParams; ++i)
+        {
+            Params[i].Dest = GPUAddress + i * 4;
+            memcpy(&Params[i].Value, static_cast<const Uint8*>(pData) + i * 4, 4);
+        }
+        CmdCtx.AsGraphicsContext2().WriteBufferImmediate(NumParams, Params);
+        ++m_State.NumCommands;
+        return;
+    }
+
     constexpr size_t DefaultAlginment = 16;
     auto             TmpSpace         = m_DynamicHeap.Allocate(Size, DefaultAlginment, GetFrameNumber());
     memcpy(TmpSpace.CPUAddress, pData, Size);
@@ -1946,6 +2354,112 @@ void DeviceContextD3D12Impl::UpdateTextureRegion(const void*
                       TextureTransitionMode);
 }
 
+void DeviceContextD3D12Impl::UpdateTextureRegions(ITexture*                      pTexture,
+                                                  const TextureRegionUpdate*     pUpdates,
+                                                  Uint32                         NumUpdates,
+                                                  RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TDeviceContextBase::UpdateTextureRegions(pTexture, pUpdates, NumUpdates, TextureTransitionMode);
+    if (NumUpdates == 0)
+        return;
+
+    auto&       TextureD3D12 = *ValidatedCast<TextureD3D12Impl>(pTexture);
+    const auto& TexDesc      = TextureD3D12.GetDesc();
+    DEV_CHECK_ERR(TexDesc.Usage == USAGE_DEFAULT, "Only USAGE_DEFAULT textures should be updated with UpdateTextureRegions()");
+
+    // Every region is placed at D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT boundary in one dynamic allocation
+    Uint64 UploadSize = 0;
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto CopyInfo = GetBufferToTextureCopyInfo(TexDesc.Format, pUpdates[i].DstBox, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+        UploadSize          = AlignUp(UploadSize, Uint64{D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT}) + CopyInfo.MemorySize;
+    }
+    auto       Allocation    = AllocateDynamicSpace(static_cast<size_t>(UploadSize), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    const auto AlignedOffset = AlignUp(Allocation.Offset, Uint64{D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT});
+
+    auto& CmdCtx   = GetCmdContext();
+    auto* pCmdList = CmdCtx.GetCommandList();
+
+    // Transition all subresources with one barrier and restore the state afterwards, same as UpdateTexture() does
+    bool StateTransitionRequired = false;
+    if (TextureTransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    {
+        StateTransitionRequired = TextureD3D12.IsInKnownState() && !TextureD3D12.CheckState(RESOURCE_STATE_COPY_DEST);
+    }
+#ifdef DILIGENT_DEVELOPMENT
+    else if (TextureTransitionMode == RESOURCE_STATE_TRANSITION_MODE_VERIFY)
+    {
+        DvpVerifyTextureState(TextureD3D12, RESOURCE_STATE_COPY_DEST, "Using texture as copy destination (DeviceContextD3D12Impl::UpdateTextureRegions)");
+    }
+#endif
+    CmdCtx.FlushResourceBarriers();
+
+    D3D12_RESOURCE_BARRIER BarrierDesc;
+    if (StateTransitionRequired)
+    {
+        const auto ResStateMask = GetSupportedD3D12ResourceStatesForCommandList(CmdCtx.GetCommandListType());
+
+        BarrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        BarrierDesc.Transition.pResource   = TextureD3D12.GetD3D12Resource();
+        BarrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        BarrierDesc.Transition.StateBefore = ResourceStateFlagsToD3D12ResourceStates(TextureD3D12.GetState()) & ResStateMask;
+        BarrierDesc.Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
+        BarrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        pCmdList->ResourceBarrier(1, &BarrierDesc);
+    }
+
+    const auto  DXGIFormat = TexFormatToDXGI_Format(TexDesc.Format);
+    const auto& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+
+    auto RegionOffset = AlignedOffset;
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update   = pUpdates[i];
+        const auto  CopyInfo = GetBufferToTextureCopyInfo(TexDesc.Format, Update.DstBox, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+        const auto  Depth    = Update.DstBox.MaxZ - Update.DstBox.MinZ;
+
+        RegionOffset = AlignUp(RegionOffset, Uint64{D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT});
+        CopyTextureSubresource(Update.SrcData, CopyInfo.RowCount, Depth, CopyInfo.RowSize,
+                               reinterpret_cast<Uint8*>(Allocation.CPUAddress) + static_cast<size_t>(RegionOffset - Allocation.Offset),
+                               CopyInfo.RowStride, CopyInfo.DepthStride);
+
+        D3D12_TEXTURE_COPY_LOCATION DstLocation;
+        DstLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        DstLocation.pResource        = TextureD3D12.GetD3D12Resource();
+        DstLocation.SubresourceIndex = D3D12CalcSubresource(Update.MipLevel, Update.Slice, 0, TexDesc.MipLevels, TexDesc.ArraySize);
+
+        // Compressed regions are aligned by the block size
+        D3D12_TEXTURE_COPY_LOCATION SrcLocation;
+        SrcLocation.Type                              = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        SrcLocation.pResource                         = Allocation.pBuffer;
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT& Footprint = SrcLocation.PlacedFootprint;
+        Footprint.Offset                              = RegionOffset;
+        Footprint.Footprint.Width                     = AlignUp(Update.DstBox.MaxX - Update.DstBox.MinX, Uint32{FmtAttribs.BlockWidth});
+        Footprint.Footprint.Height                    = AlignUp(Update.DstBox.MaxY - Update.DstBox.MinY, Uint32{FmtAttribs.BlockHeight});
+        Footprint.Footprint.Depth                     = Depth;
+        Footprint.Footprint.Format                    = DXGIFormat;
+        Footprint.Footprint.RowPitch                  = CopyInfo.RowStride;
+
+        D3D12_BOX D3D12SrcBox;
+        D3D12SrcBox.left   = 0;
+        D3D12SrcBox.right  = Footprint.Footprint.Width;
+        D3D12SrcBox.top    = 0;
+        D3D12SrcBox.bottom = Footprint.Footprint.Height;
+        D3D12SrcBox.front  = 0;
+        D3D12SrcBox.back   = Footprint.Footprint.Depth;
+        pCmdList->CopyTextureRegion(&DstLocation, Update.DstBox.MinX, Update.DstBox.MinY, Update.DstBox.MinZ, &SrcLocation, &D3D12SrcBox);
+
+        RegionOffset += CopyInfo.MemorySize;
+    }
+    ++m_State.NumCommands;
+
+    if (StateTransitionRequired)
+    {
+        std::swap(BarrierDesc.Transition.StateBefore, BarrierDesc.Transition.StateAfter);
+        pCmdList->ResourceBarrier(1, &BarrierDesc);
+    }
+}
+
 void DeviceContextD3D12Impl::MapTextureSubresource(ITexture*                 pTexture,
                                                    Uint32                    MipLevel,
                                                    Uint32                    ArraySlice,
@@ -2102,11 +2616,24 @@ void DeviceContextD3D12Impl::GenerateMips(ITextureView* pTexView)
 
     auto& Ctx = GetCmdContext();
 
-    const auto& MipsGenerator = m_pDevice->GetMipsGenerator();
-    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ValidatedCast<TextureViewD3D12Impl>(pTexView), Ctx);
+    auto& MipsGenerator = m_pDevice->GetMipsGenerator();
+    MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ValidatedCast<TextureViewD3D12Impl>(pTexView), Ctx, GetContextId());
     ++m_State.NumCommands;
 }
 
+void DeviceContextD3D12Impl::GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews)
+{
+    TDeviceContextBase::GenerateMipsBatch(ppTexViews, NumViews);
+
+    auto& Ctx = GetCmdContext();
+
+    // Resource barriers are accumulated by the command context and flushed before every dispatch
+    auto& MipsGenerator = m_pDevice->GetMipsGenerator();
+    for (Uint32 i = 0; i < NumViews; ++i)
+        MipsGenerator.GenerateMips(m_pDevice->GetD3D12Device(), ValidatedCast<TextureViewD3D12Impl>(ppTexViews[i]), Ctx, GetContextId());
+    m_State.NumCommands += NumViews;
+}
+
 void DeviceContextD3D12Impl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
@@ -2133,7 +2660,26 @@ void DeviceContextD3D12Impl::ExecuteCommandLists(Uint32               NumCommand
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
-    Flush(true, NumCommandLists, ppCommandLists);
+    if (m_BatchCommandListSubmission)
+    {
+        DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
+                      "Executing command lists in a device context that has ", m_ActiveQueriesCounter,
+                      " active queries. Direct3D12 requires that queries are begun and ended in the same command list");
+
+        // Command lists are submitted together with all other pending command lists by the next Flush()
+        EnqueueCurrentCmdContext();
+        EnqueueCommandLists(NumCommandLists, ppCommandLists);
+        RequestCommandContext();
+
+        m_State             = State{};
+        m_GraphicsResources = RootTableInfo{};
+        m_ComputeResources  = RootTableInfo{};
+        m_pPipelineState    = nullptr;
+    }
+    else
+    {
+        Flush(true, NumCommandLists, ppCommandLists);
+    }
 
     InvalidateState();
 }
@@ -2193,9 +2739,117 @@ void DeviceContextD3D12Impl::EndQuery(IQuery* pQuery)
     QueryMgr.EndQuery(Ctx, QueryType, Idx);
 }
 
+Bool DeviceContextD3D12Impl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    if (IsDeferred())
+    {
+        DEV_ERROR("Deferred contexts have no command queues and can't calibrate timestamps");
+        return False;
+    }
+
+    const auto& CmdQueue    = m_pDevice->GetCommandQueue(GetCommandQueueId());
+    auto*       pd3d12Queue = const_cast<ICommandQueueD3D12&>(CmdQueue).GetD3D12CommandQueue();
+
+    UINT64 GPUCounter = 0;
+    UINT64 CPUCounter = 0;
+    UINT64 Frequency  = 0;
+    // Copy queues may not support timestamps
+    if (FAILED(pd3d12Queue->GetTimestampFrequency(&Frequency)) || FAILED(pd3d12Queue->GetClockCalibration(&GPUCounter, &CPUCounter)))
+        return False;
+
+    // The CPU timestamp is the value of QueryPerformanceCounter, which is also the clock of std::chrono::steady_clock
+    LARGE_INTEGER QPCFrequency{};
+    QueryPerformanceFrequency(&QPCFrequency);
+    const auto QPCTicksPerSecond = static_cast<Uint64>(QPCFrequency.QuadPart);
+
+    Calibration.GPUCounter   = GPUCounter;
+    Calibration.GPUFrequency = Frequency;
+    Calibration.CPUTime      = (CPUCounter / QPCTicksPerSecond) * 1000000000ull + (CPUCounter % QPCTicksPerSecond) * 1000000000ull / QPCTicksPerSecond;
+    Calibration.MaxDeviation = 0;
+    return True;
+}
+
+void DeviceContextD3D12Impl::BeginConditionalRendering(IQuery* pQuery)
+{
+    TDeviceContextBase::BeginConditionalRendering(pQuery, 0);
+
+    if (!m_pd3d12PredicationBuffer)
+    {
+        D3D12_RESOURCE_DESC BuffDesc{};
+        BuffDesc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
+        BuffDesc.Alignment          = 0;
+        BuffDesc.Width              = sizeof(Uint64); // Binary occlusion query data is a 64-bit value
+        BuffDesc.Height             = 1;
+        BuffDesc.DepthOrArraySize   = 1;
+        BuffDesc.MipLevels          = 1;
+        BuffDesc.Format             = DXGI_FORMAT_UNKNOWN;
+        BuffDesc.SampleDesc.Count   = 1;
+        BuffDesc.SampleDesc.Quality = 0;
+        BuffDesc.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        BuffDesc.Flags              = D3D12_RESOURCE_FLAG_NONE;
+
+        D3D12_HEAP_PROPERTIES HeapProps{};
+        HeapProps.Type                 = D3D12_HEAP_TYPE_DEFAULT;
+        HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        HeapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        HeapProps.CreationNodeMask     = 1;
+        HeapProps.VisibleNodeMask      = 1;
+
+        auto hr = m_pDevice->GetD3D12Device()->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE, &BuffDesc, D3D12_RESOURCE_STATE_COMMON, nullptr,
+                                                                       __uuidof(m_pd3d12PredicationBuffer),
+                                                                       reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12PredicationBuffer)));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create D3D12 predication buffer");
+        m_pd3d12PredicationBuffer->SetName(L"Predication buffer");
+    }
+
+    auto* pQueryD3D12Impl = ValidatedCast<QueryD3D12Impl>(pQuery);
+    auto& QueryMgr        = m_pDevice->GetQueryManager();
+    auto& CmdCtx          = GetCmdContext();
+
+    D3D12_RESOURCE_BARRIER BarrierDesc;
+    BarrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    BarrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    BarrierDesc.Transition.pResource   = m_pd3d12PredicationBuffer;
+    BarrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    BarrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
+    BarrierDesc.Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
+    CmdCtx.ResourceBarrier(BarrierDesc);
+    CmdCtx.FlushResourceBarriers();
+
+    // The query is resolved directly into the predication buffer and never leaves the GPU
+    CmdCtx.ResolveQueryData(QueryMgr.GetQueryHeap(QUERY_TYPE_BINARY_OCCLUSION), QueryTypeToD3D12QueryType(QUERY_TYPE_BINARY_OCCLUSION),
+                            pQueryD3D12Impl->GetQueryHeapIndex(0), 1, m_pd3d12PredicationBuffer, 0);
+
+    BarrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+    BarrierDesc.Transition.StateAfter  = D3D12_RESOURCE_STATE_PREDICATION;
+    CmdCtx.ResourceBarrier(BarrierDesc);
+
+    // Commands are skipped when the query data is zero, i.e. when no samples passed
+    CmdCtx.SetPredication(m_pd3d12PredicationBuffer, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
+}
+
+void DeviceContextD3D12Impl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    auto& CmdCtx = GetCmdContext();
+    CmdCtx.SetPredication(nullptr, 0, D3D12_PREDICATION_OP_EQUAL_ZERO);
+
+    D3D12_RESOURCE_BARRIER BarrierDesc;
+    BarrierDesc.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    BarrierDesc.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+    BarrierDesc.Transition.pResource   = m_pd3d12PredicationBuffer;
+    BarrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    BarrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_PREDICATION;
+    BarrierDesc.Transition.StateAfter  = D3D12_RESOURCE_STATE_COMMON;
+    CmdCtx.ResourceBarrier(BarrierDesc);
+}
+
 void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    CountStateTransitions(BarrierCount);
 
     auto& CmdCtx = GetCmdContext();
     for (Uint32 i = 0; i < BarrierCount; ++i)
@@ -2204,6 +2858,26 @@ void DeviceContextD3D12Impl::TransitionResourceStates(Uint32 BarrierCount, const
         DvpVerifyStateTransitionDesc(pResourceBarriers[i]);
 #endif
         const auto& Barrier = pResourceBarriers[i];
+        if (Barrier.pResourceBefore != nullptr)
+        {
+            const auto GetD3D12Resource = [](IDeviceObject* pResource) -> ID3D12Resource* {
+                if (RefCntAutoPtr<TextureD3D12Impl> pTextureD3D12Impl{pResource, IID_TextureD3D12})
+                    return pTextureD3D12Impl->GetD3D12Resource();
+                else if (RefCntAutoPtr<BufferD3D12Impl> pBufferD3D12Impl{pResource, IID_BufferD3D12})
+                    return pBufferD3D12Impl->GetD3D12Resource();
+                UNEXPECTED("Aliasing barriers are only supported for textures and buffers");
+                return nullptr;
+            };
+
+            // Aliasing barrier must precede the transition of the resource that now uses the memory
+            D3D12_RESOURCE_BARRIER AliasingBarrier{};
+            AliasingBarrier.Type                     = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+            AliasingBarrier.Flags                    = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            AliasingBarrier.Aliasing.pResourceBefore = GetD3D12Resource(Barrier.pResourceBefore);
+            AliasingBarrier.Aliasing.pResourceAfter  = GetD3D12Resource(Barrier.pResource);
+            CmdCtx.ResourceBarrier(AliasingBarrier);
+        }
+
         if (RefCntAutoPtr<TextureD3D12Impl> pTextureD3D12Impl{Barrier.pResource, IID_TextureD3D12})
             CmdCtx.TransitionResource(*pTextureD3D12Impl, Barrier);
         else if (RefCntAutoPtr<BufferD3D12Impl> pBufferD3D12Impl{Barrier.pResource, IID_BufferD3D12})
@@ -2223,6 +2897,8 @@ void DeviceContextD3D12Impl::TransitionOrVerifyBufferState(CommandContext&
                                                            RESOURCE_STATE                 RequiredState,
                                                            const char*                    OperationName)
 {
+    CmdCtx.AddResidencyUsage(Buffer.GetResidencyObject());
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Buffer.IsInKnownState())
@@ -2242,6 +2918,8 @@ void DeviceContextD3D12Impl::TransitionOrVerifyTextureState(CommandContext&
                                                             RESOURCE_STATE                 RequiredState,
                                                             const char*                    OperationName)
 {
+    CmdCtx.AddResidencyUsage(Texture.GetResidencyObject());
+
     if (TransitionMode == RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
     {
         if (Texture.IsInKnownState())
@@ -2354,26 +3032,92 @@ void DeviceContextD3D12Impl::ResolveTextureSubresource(ITexture*
     CmdCtx.ResolveSubresource(pDstTexD3D12->GetD3D12Resource(), DstSubresIndex, pSrcTexD3D12->GetD3D12Resource(), SrcSubresIndex, DXGIFmt);
 }
 
-void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextD3D12Impl::UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
+    TDeviceContextBase::UpdateTileMappings(Attribs, 0);
 
-    auto* const pBLASD3D12    = ValidatedCast<BottomLevelASD3D12Impl>(Attribs.pBLAS);
-    auto* const pScratchD3D12 = ValidatedCast<BufferD3D12Impl>(Attribs.pScratchBuffer);
-    const auto& BLASDesc      = pBLASD3D12->GetDesc();
+    auto* const pTexD3D12  = Attribs.pTexture != nullptr ? ValidatedCast<TextureD3D12Impl>(Attribs.pTexture) : nullptr;
+    auto* const pBuffD3D12 = Attribs.pBuffer != nullptr ? ValidatedCast<BufferD3D12Impl>(Attribs.pBuffer) : nullptr;
+
+    auto* const pd3d12Resource = pTexD3D12 != nullptr ? pTexD3D12->GetD3D12Resource() : pBuffD3D12->GetD3D12Resource();
+
+    // Tile mapping updates are executed by the command queue in order with command list submissions,
+    // so all commands recorded so far must be submitted first.
+    Flush();
+
+    m_pDevice->LockCmdQueueAndRun(
+        GetCommandQueueId(),
+        [&](ICommandQueueD3D12* pCmdQueue) //
+        {
+            auto* pd3d12Queue = pCmdQueue->GetD3D12CommandQueue();
+            for (Uint32 i = 0; i < Attribs.NumRanges; ++i)
+            {
+                const auto& Range = Attribs.pRanges[i];
+
+                D3D12_TILED_RESOURCE_COORDINATE StartCoord{};
+                D3D12_TILE_REGION_SIZE          RegionSize{};
+                if (pBuffD3D12 != nullptr)
+                {
+                    // Buffers have a single subresource whose tiles are addressed by the X coordinate
+                    StartCoord.X        = Range.TileX;
+                    RegionSize.NumTiles = Range.NumTilesX;
+                    RegionSize.UseBox   = FALSE;
+                }
+                else if (Range.MipLevel >= pTexD3D12->GetSparseProperties().FirstMipInTail)
+                {
+                    // Packed mips are addressed by the subresource of the first packed mip starting from tile 0,
+                    // and are always mapped as a whole.
+                    const auto& TexDesc     = pTexD3D12->GetDesc();
+                    const auto& SparseProps = pTexD3D12->GetSparseProperties();
+                    StartCoord.Subresource  = D3D12CalcSubresource(SparseProps.FirstMipInTail, Range.ArraySlice, 0, TexDesc.MipLevels, TexDesc.ArraySize);
+                    RegionSize.NumTiles     = static_cast<UINT>(SparseProps.MipTailSize / D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+                    RegionSize.UseBox       = FALSE;
+                }
+                else
+                {
+                    const auto& TexDesc    = pTexD3D12->GetDesc();
+                    StartCoord.X           = Range.TileX;
+                    StartCoord.Y           = Range.TileY;
+                    StartCoord.Z           = 0;
+                    StartCoord.Subresource = D3D12CalcSubresource(Range.MipLevel, Range.ArraySlice, 0, TexDesc.MipLevels, TexDesc.ArraySize);
+                    RegionSize.NumTiles    = Range.NumTilesX * Range.NumTilesY;
+                    RegionSize.UseBox      = TRUE;
+                    RegionSize.Width       = Range.NumTilesX;
+                    RegionSize.Height      = static_cast<UINT16>(Range.NumTilesY);
+                    RegionSize.Depth       = 1;
+                }
+
+                // Null heap unmaps the tiles
+                auto* const pd3d12Heap     = Range.pHeap != nullptr ? ValidatedCast<ResourceHeapD3D12Impl>(Range.pHeap)->GetD3D12Heap() : nullptr;
+                const auto  RangeFlags     = pd3d12Heap != nullptr ? D3D12_TILE_RANGE_FLAG_NONE : D3D12_TILE_RANGE_FLAG_NULL;
+                const UINT  HeapStartTile  = static_cast<UINT>(Range.HeapOffset / D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+                const UINT  RangeTileCount = RegionSize.NumTiles;
+
+                pd3d12Queue->UpdateTileMappings(pd3d12Resource, 1, &StartCoord, &RegionSize, pd3d12Heap,
+                                                1, &RangeFlags, &HeapStartTile, &RangeTileCount, D3D12_TILE_MAPPING_FLAG_NONE);
+            }
+        } //
+    );
+}
+
+void DeviceContextD3D12Impl::PrepareBLASBuild(CommandContext&                                     CmdCtx,
+                                              const BuildBLASAttribs&                             Attribs,
+                                              D3D12_GPU_VIRTUAL_ADDRESS                           ScratchAddress,
+                                              D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC& d3d12BuildASDesc,
+                                              D3D12_RAYTRACING_GEOMETRY_DESC*                     pGeometries,
+                                              const char*                                         OpName)
+{
+    auto* const pBLASD3D12 = ValidatedCast<BottomLevelASD3D12Impl>(Attribs.pBLAS);
+    const auto& BLASDesc   = pBLASD3D12->GetDesc();
 
-    auto&       CmdCtx = GetCmdContext();
-    const char* OpName = "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)";
     TransitionOrVerifyBLASState(CmdCtx, *pBLASD3D12, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
-    TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
 
-    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC    d3d12BuildASDesc   = {};
     D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& d3d12BuildASInputs = d3d12BuildASDesc.Inputs;
-    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>           Geometries;
 
+    Uint32 GeometryCount = 0;
     if (Attribs.pTriangleData != nullptr)
     {
-        Geometries.resize(Attribs.TriangleDataCount);
+        GeometryCount = Attribs.TriangleDataCount;
         pBLASD3D12->SetActualGeometryCount(Attribs.TriangleDataCount);
 
         for (Uint32 i = 0; i < Attribs.TriangleDataCount; ++i)
@@ -2388,7 +3132,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto&       d3d12Geo  = Geometries[Idx];
+            auto&       d3d12Geo  = pGeometries[Idx];
             auto&       d3d12Tris = d3d12Geo.Triangles;
             const auto& TriDesc   = BLASDesc.pTriangles[GeoIdx];
 
@@ -2445,7 +3189,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     }
     else if (Attribs.pBoxData != nullptr)
     {
-        Geometries.resize(Attribs.BoxDataCount);
+        GeometryCount = Attribs.BoxDataCount;
         pBLASD3D12->SetActualGeometryCount(Attribs.BoxDataCount);
 
         for (Uint32 i = 0; i < Attribs.BoxDataCount; ++i)
@@ -2460,7 +3204,7 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
                 continue;
             }
 
-            auto& d3d12Geo  = Geometries[Idx];
+            auto& d3d12Geo  = pGeometries[Idx];
             auto& d3d12AABs = d3d12Geo.AABBs;
 
             d3d12Geo.Type  = D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS;
@@ -2481,11 +3225,11 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     d3d12BuildASInputs.Type           = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
     d3d12BuildASInputs.Flags          = BuildASFlagsToD3D12ASBuildFlags(BLASDesc.Flags);
     d3d12BuildASInputs.DescsLayout    = D3D12_ELEMENTS_LAYOUT_ARRAY;
-    d3d12BuildASInputs.NumDescs       = static_cast<UINT>(Geometries.size());
-    d3d12BuildASInputs.pGeometryDescs = Geometries.data();
+    d3d12BuildASInputs.NumDescs       = GeometryCount;
+    d3d12BuildASInputs.pGeometryDescs = pGeometries;
 
     d3d12BuildASDesc.DestAccelerationStructureData    = pBLASD3D12->GetGPUAddress();
-    d3d12BuildASDesc.ScratchAccelerationStructureData = pScratchD3D12->GetGPUAddress() + Attribs.ScratchBufferOffset;
+    d3d12BuildASDesc.ScratchAccelerationStructureData = ScratchAddress;
     d3d12BuildASDesc.SourceAccelerationStructureData  = 0;
 
     if (Attribs.Update)
@@ -2497,16 +3241,105 @@ void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
     DEV_CHECK_ERR(d3d12BuildASDesc.ScratchAccelerationStructureData % D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT == 0,
                   "Scratch data address is not properly aligned");
 
-    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
-    ++m_State.NumCommands;
-
 #ifdef DILIGENT_DEVELOPMENT
     pBLASD3D12->DvpUpdateVersion();
 #endif
 }
 
+void DeviceContextD3D12Impl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pBLAS != nullptr)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildBLAS(RingAttribs);
+        return;
+    }
+
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
+    auto* const pScratchD3D12 = ValidatedCast<BufferD3D12Impl>(Attribs.pScratchBuffer);
+
+    auto&       CmdCtx = GetCmdContext();
+    const char* OpName = "Build BottomLevelAS (DeviceContextD3D12Impl::BuildBLAS)";
+    TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
+
+    // Exactly one of the counts is non-zero
+    SmallVector<D3D12_RAYTRACING_GEOMETRY_DESC, 8> Geometries(Attribs.TriangleDataCount + Attribs.BoxDataCount);
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC d3d12BuildASDesc = {};
+    PrepareBLASBuild(CmdCtx, Attribs, pScratchD3D12->GetGPUAddress() + Attribs.ScratchBufferOffset, d3d12BuildASDesc, Geometries.data(), OpName);
+
+    CmdCtx.AsGraphicsContext4().BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextD3D12Impl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pBuilds != nullptr && Attribs.BuildCount != 0)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildBLASBatch(RingAttribs);
+        return;
+    }
+
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    if (Attribs.BuildCount == 0)
+        return;
+
+    auto* const pScratchD3D12 = ValidatedCast<BufferD3D12Impl>(Attribs.pScratchBuffer);
+
+    auto&       CmdCtx = GetCmdContext();
+    const char* OpName = "Build BottomLevelAS batch (DeviceContextD3D12Impl::BuildBLASBatch)";
+    TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
+
+    Uint32 TotalGeometryCount = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+        TotalGeometryCount += Attribs.pBuilds[i].TriangleDataCount + Attribs.pBuilds[i].BoxDataCount;
+
+    std::vector<D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC> d3d12BuildASDescs(Attribs.BuildCount);
+    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>                     Geometries(TotalGeometryCount);
+
+    const Uint32                    ScratchAlignment = m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+    const D3D12_GPU_VIRTUAL_ADDRESS ScratchAddress   = pScratchD3D12->GetGPUAddress();
+
+    // Transition all resources first so that the barriers are flushed once before the first build
+    Uint64 ScratchOffset      = Attribs.ScratchBufferOffset;
+    Uint32 FirstGeometryIndex = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const auto& Build = Attribs.pBuilds[i];
+
+        PrepareBLASBuild(CmdCtx, Build, ScratchAddress + ScratchOffset, d3d12BuildASDescs[i], &Geometries[FirstGeometryIndex], OpName);
+
+        FirstGeometryIndex += Build.TriangleDataCount + Build.BoxDataCount;
+        ScratchOffset += GetBLASBatchScratchRegionSize(Build, ScratchAlignment);
+    }
+    VERIFY_EXPR(FirstGeometryIndex == TotalGeometryCount);
+
+    // All builds use disjoint scratch regions and destination structures,
+    // so no barriers are required between them.
+    auto& CmdCtx4 = CmdCtx.AsGraphicsContext4();
+    for (const auto& d3d12BuildASDesc : d3d12BuildASDescs)
+        CmdCtx4.BuildRaytracingAccelerationStructure(d3d12BuildASDesc, 0, nullptr);
+    ++m_State.NumCommands;
+}
+
 void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pTLAS != nullptr)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildTLAS(RingAttribs);
+        return;
+    }
+
     TDeviceContextBase::BuildTLAS(Attribs, 0);
 
     static_assert(TLAS_INSTANCE_DATA_SIZE == sizeof(D3D12_RAYTRACING_INSTANCE_DESC), "Value in TLAS_INSTANCE_DATA_SIZE doesn't match the actual instance description size");
@@ -2520,7 +3353,12 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     TransitionOrVerifyTLASState(CmdCtx, *pTLASD3D12, Attribs.TLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(CmdCtx, *pScratchD3D12, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
 
-    if (Attribs.Update)
+    if (Attribs.UseGPUInstanceData)
+    {
+        // Instance data has already been written to the instance buffer on the GPU
+        pTLASD3D12->SetGPUInstanceData(Attribs.InstanceCount, Attribs.HitGroupStride);
+    }
+    else if (Attribs.Update)
     {
         if (!pTLASD3D12->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
             return;
@@ -2532,6 +3370,7 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
     }
 
     // copy instance data into instance buffer
+    if (!Attribs.UseGPUInstanceData)
     {
         size_t Size     = Attribs.InstanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
         auto   TmpSpace = m_DynamicHeap.Allocate(Size, 16, m_FrameNumber);
@@ -2539,11 +3378,11 @@ void DeviceContextD3D12Impl::BuildTLAS(const BuildTLASAttribs& Attribs)
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
             const auto& Inst     = Attribs.pInstances[i];
-            const auto  InstDesc = pTLASD3D12->GetInstanceDesc(Inst.InstanceName);
+            const auto  InstDesc = pTLASD3D12->GetBuildInstanceDesc(Inst, i);
 
             if (InstDesc.InstanceIndex >= Attribs.InstanceCount)
             {
-                UNEXPECTED("Failed to find instance by name");
+                UNEXPECTED("Failed to find instance");
                 return;
             }
 
@@ -2738,22 +3577,15 @@ void DeviceContextD3D12Impl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIn
 
     pSBTD3D12->GetData(pSBTBufferD3D12, RayGenShaderRecord, MissShaderTable, HitGroupTable, CallableShaderTable);
 
-    if (RayGenShaderRecord.pData || MissShaderTable.pData || HitGroupTable.pData || CallableShaderTable.pData)
+    const auto& UploadRanges = pSBTD3D12->GetUploadRanges();
+    if (!UploadRanges.empty())
     {
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, OpName);
 
+        // Only the records modified since the previous update are uploaded.
         // Buffer ranges do not intersect, so we don't need to add barriers between them
-        if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferD3D12, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferD3D12, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (const auto& Range : UploadRanges)
+            UpdateBuffer(pSBTBufferD3D12, Range.Offset, Range.Size, Range.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(CmdCtx, *pSBTBufferD3D12, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, OpName);
     }
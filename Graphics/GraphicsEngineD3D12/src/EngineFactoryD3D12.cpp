@@ -44,6 +44,8 @@
 #include "EngineFactoryBase.hpp"
 #include "EngineMemory.h"
 #include "CommandQueueD3D12Impl.hpp"
+#include "Timer.hpp"
+#include "PlatformMisc.hpp"
 
 #ifndef NOMINMAX
 #    define NOMINMAX
@@ -256,8 +258,13 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
     std::vector<RefCntAutoPtr<CommandQueueD3D12Impl>> CmdQueueD3D12Refs;
     CComPtr<ID3D12Device>                             d3d12Device;
     std::vector<ICommandQueueD3D12*>                  CmdQueues;
+
+    Timer                InitTimer;
+    DeviceInitStatistics InitStats;
     try
     {
+        Timer PhaseTimer;
+
         ValidateD3D12CreateInfo(EngineCI);
         SetRawAllocator(EngineCI.pRawMemAllocator);
 
@@ -313,6 +320,9 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
             LOG_INFO_MESSAGE("D3D12-capabale adapter found: ", NarrowString(desc.Description), " (", desc.DedicatedVideoMemory >> 20, " MB)");
         }
 
+        InitStats.InstanceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         const Version FeatureLevelList[] = {{12, 1}, {12, 0}, {11, 1}, {11, 0}};
         for (auto FeatureLevel : FeatureLevelList)
         {
@@ -419,6 +429,8 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
             queueDesc.Flags    = D3D12_COMMAND_QUEUE_FLAG_NONE;
             queueDesc.Priority = QueuePriorityToD3D12QueuePriority(ContextCI.Priority);
             queueDesc.Type     = QueueIdToD3D12CommandListType(HardwareQueueIndex{ContextCI.QueueId});
+            // A queue executes commands on a single node; use the lowest node in the context's mask
+            queueDesc.NodeMask = ContextCI.NodeMask != 0 ? (1u << PlatformMisc::GetLSB(ContextCI.NodeMask)) : 0u;
 
             CComPtr<ID3D12CommandQueue> pd3d12CmdQueue;
             hr = d3d12Device->CreateCommandQueue(&queueDesc, __uuidof(pd3d12CmdQueue), reinterpret_cast<void**>(static_cast<ID3D12CommandQueue**>(&pd3d12CmdQueue)));
@@ -441,10 +453,12 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
         {
             ImmediateContextCreateInfo DefaultContext;
             DefaultContext.Name    = "Default immediate context";
-            DefaultContext.QueueId = 0;
+            DefaultContext.QueueId = EngineCI.ComputeOnly ? 1 : 0; // 1 - D3D12_COMMAND_LIST_TYPE_COMPUTE
 
             CreateQueue(DefaultContext);
         }
+
+        InitStats.DeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
     }
     catch (const std::runtime_error&)
     {
@@ -453,6 +467,18 @@ void EngineFactoryD3D12Impl::CreateDeviceAndContextsD3D12(const EngineD3D12Creat
     }
 
     AttachToD3D12Device(d3d12Device, static_cast<Uint32>(CmdQueues.size()), CmdQueues.data(), EngineCI, ppDevice, ppContexts);
+
+    if (*ppDevice != nullptr)
+    {
+        // AttachToD3D12Device() only knows the time of the render device and context initialization
+        auto* pRenderDeviceD3D12 = ValidatedCast<RenderDeviceD3D12Impl>(*ppDevice);
+
+        const auto& AttachStats    = pRenderDeviceD3D12->GetDeviceInfo().InitStats;
+        InitStats.RenderDeviceTime = AttachStats.RenderDeviceTime;
+        InitStats.ContextsTime     = AttachStats.ContextsTime;
+        InitStats.TotalTime        = InitTimer.GetElapsedTimef() * 1000.f;
+        pRenderDeviceD3D12->SetInitStatistics(InitStats);
+    }
 }
 
 
@@ -549,10 +575,16 @@ void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd
         const auto AdapterInfo = GetGraphicsAdapterInfo(pd3d12NativeDevice, pDXGIAdapter1);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
 
+        Timer                PhaseTimer;
+        DeviceInitStatistics InitStats;
+
         RenderDeviceD3D12Impl* pRenderDeviceD3D12{
             NEW_RC_OBJ(RawMemAllocator, "RenderDeviceD3D12Impl instance", RenderDeviceD3D12Impl)(RawMemAllocator, this, EngineCI, AdapterInfo, d3d12Device, CommandQueueCount, ppCommandQueues)};
         pRenderDeviceD3D12->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        InitStats.RenderDeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         for (Uint32 CtxInd = 0; CtxInd < NumImmediateContexts; ++CtxInd)
         {
             const auto d3d12CmdListType = ppCommandQueues[CtxInd]->GetD3D12CommandQueueDesc().Type;
@@ -594,6 +626,10 @@ void EngineFactoryD3D12Impl::AttachToD3D12Device(void*                        pd
             pDeferredCtxD3D12->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + NumImmediateContexts + DeferredCtx));
             pRenderDeviceD3D12->SetDeferredContext(DeferredCtx, pDeferredCtxD3D12);
         }
+
+        InitStats.ContextsTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        InitStats.TotalTime    = InitStats.RenderDeviceTime + InitStats.ContextsTime;
+        pRenderDeviceD3D12->SetInitStatistics(InitStats);
     }
     catch (const std::runtime_error&)
     {
@@ -718,6 +754,9 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
         }
     }
 
+    // Linked display adapters expose several nodes through a single device
+    AdapterInfo.NumNodes = std::max(d3d12Device->GetNodeCount(), 1u);
+
     // Enable features and set properties
     {
         auto& Features = AdapterInfo.Features;
@@ -758,6 +797,8 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
         }
 
         Features.ShaderResourceRuntimeArray = DEVICE_FEATURE_STATE_ENABLED;
+        // Every buffer resource has a GPU virtual address
+        Features.BufferDeviceAddress = DEVICE_FEATURE_STATE_ENABLED;
 
         {
             D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Features = {};
@@ -767,6 +808,11 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
                 {
                     Features.ShaderFloat16 = DEVICE_FEATURE_STATE_ENABLED;
                 }
+
+                if (d3d12Features.TiledResourcesTier >= D3D12_TILED_RESOURCES_TIER_1)
+                {
+                    Features.SparseResources = DEVICE_FEATURE_STATE_ENABLED;
+                }
             }
 
             D3D12_FEATURE_DATA_D3D12_OPTIONS1 d3d12Features1 = {};
@@ -816,6 +862,7 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
                     RayTracingProps.MaxInstancesPerTLAS      = D3D12_RAYTRACING_MAX_INSTANCES_PER_TOP_LEVEL_ACCELERATION_STRUCTURE;
                     RayTracingProps.MaxPrimitivesPerBLAS     = D3D12_RAYTRACING_MAX_PRIMITIVES_PER_BOTTOM_LEVEL_ACCELERATION_STRUCTURE;
                     RayTracingProps.MaxGeometriesPerBLAS     = D3D12_RAYTRACING_MAX_GEOMETRIES_PER_BOTTOM_LEVEL_ACCELERATION_STRUCTURE;
+                    RayTracingProps.ScratchBufferAlignment   = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT;
                     RayTracingProps.CapFlags |= RAY_TRACING_CAP_FLAG_STANDALONE_SHADERS;
                 }
                 if (d3d12Features5.RaytracingTier >= D3D12_RAYTRACING_TIER_1_1)
@@ -823,7 +870,7 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
                     RayTracingProps.CapFlags |= RAY_TRACING_CAP_FLAG_INLINE_RAY_TRACING | RAY_TRACING_CAP_FLAG_INDIRECT_RAY_TRACING;
                 }
 #if defined(_MSC_VER) && defined(_WIN64)
-                static_assert(sizeof(RayTracingProps) == 36, "Did you add a new member to RayTracingProperites? Please initialize it here.");
+                static_assert(sizeof(RayTracingProps) == 40, "Did you add a new member to RayTracingProperites? Please initialize it here.");
 #endif
             }
         }
@@ -869,8 +916,27 @@ GraphicsAdapterInfo EngineFactoryD3D12Impl::GetGraphicsAdapterInfo(void*
 #endif
     }
 
+    // Draw command properties
+    {
+        auto& DrawCommandProps{AdapterInfo.DrawCommand};
+        DrawCommandProps.CapFlags             = DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT | DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT;
+        DrawCommandProps.MaxDrawIndirectCount = ~0u;
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(DrawCommandProps) == 8, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
+#endif
+    }
+
+    // Command list properties
+    {
+        auto& CmdListProps{AdapterInfo.CommandList};
+        CmdListProps.CapFlags = COMMAND_LIST_CAP_FLAG_NATIVE_COMMAND_LISTS | COMMAND_LIST_CAP_FLAG_CONCURRENT_RESOURCE_CREATION;
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(CmdListProps) == 1, "Did you add a new member to CommandListProperties? Please initialize it here.");
+#endif
+    }
+
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 37, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 42, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
     return AdapterInfo;
@@ -52,6 +52,8 @@
 #include "CommandContext.hpp"
 #include "TextureViewD3D12Impl.hpp"
 #include "TextureD3D12Impl.hpp"
+#include "DXGITypeConversions.hpp"
+#include "Align.hpp"
 
 #include "GenerateMips/GenerateMipsLinearCS.h"
 #include "GenerateMips/GenerateMipsLinearOddCS.h"
@@ -61,10 +63,17 @@
 #include "GenerateMips/GenerateMipsGammaOddCS.h"
 #include "GenerateMips/GenerateMipsGammaOddXCS.h"
 #include "GenerateMips/GenerateMipsGammaOddYCS.h"
+#include "GenerateMips/GenerateMipsSPDLinearCS.h"
+#include "GenerateMips/GenerateMipsSPDGammaCS.h"
 
 namespace Diligent
 {
-GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
+GenerateMipsHelper::GenerateMipsHelper(Uint32 NumContexts) :
+    m_NumContexts{NumContexts}
+{
+}
+
+void GenerateMipsHelper::CreateResources(ID3D12Device* pd3d12Device)
 {
     CD3DX12_ROOT_PARAMETER Params[3];
     Params[0].InitAsConstants(6, 0);
@@ -110,12 +119,129 @@ GenerateMipsHelper::GenerateMipsHelper(ID3D12Device* pd3d12Device)
     CreatePSO(m_pGenerateMipsGammaPSO[1], g_pGenerateMipsGammaOddXCS);
     CreatePSO(m_pGenerateMipsGammaPSO[2], g_pGenerateMipsGammaOddYCS);
     CreatePSO(m_pGenerateMipsGammaPSO[3], g_pGenerateMipsGammaOddCS);
+
+    {
+        CD3DX12_ROOT_PARAMETER SPDParams[3];
+        SPDParams[0].InitAsConstants(4, 0);
+        CD3DX12_DESCRIPTOR_RANGE SPDSRVRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+        SPDParams[1].InitAsDescriptorTable(1, &SPDSRVRange);
+        // Twelve output mip levels followed by the thread group counter
+        CD3DX12_DESCRIPTOR_RANGE SPDUAVRange(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, MaxSPDMips + 1, 0);
+        SPDParams[2].InitAsDescriptorTable(1, &SPDUAVRange);
+        RootSigDesc.NumParameters = _countof(SPDParams);
+        RootSigDesc.pParameters   = SPDParams;
+
+        signature.Release();
+        error.Release();
+        hr = D3D12SerializeRootSignature(&RootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
+        CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature for single-pass mipmap generation");
+
+        hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pGenerateMipsSPDRS), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pGenerateMipsSPDRS)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature for single-pass mipmap generation");
+
+        PSODesc.pRootSignature = m_pGenerateMipsSPDRS;
+        CreatePSO(m_pGenerateMipsSPDLinearPSO, g_pGenerateMipsSPDLinearCS);
+        CreatePSO(m_pGenerateMipsSPDGammaPSO, g_pGenerateMipsSPDGammaCS);
+    }
+#undef CreatePSO
+
+    {
+        // Every device context uses its own range of counters, so that mips can be generated
+        // by command lists that execute concurrently on different queues.
+        // Committed resources are zero-initialized, which is the required initial counter value.
+        const UINT64 CountersPerContext = MaxSPDArraySlices;
+
+        CD3DX12_HEAP_PROPERTIES HeapProps{D3D12_HEAP_TYPE_DEFAULT};
+        auto                    BufferDesc = CD3DX12_RESOURCE_DESC::Buffer(CountersPerContext * m_NumContexts * sizeof(Uint32), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+
+        hr = pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE, &BufferDesc, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr,
+                                                   __uuidof(m_pSPDCounter), reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pSPDCounter)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create counter buffer for single-pass mipmap generation");
+        m_pSPDCounter->SetName(L"Generate mips SPD counter buffer");
+
+        D3D12_DESCRIPTOR_HEAP_DESC HeapDesc{};
+        HeapDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        HeapDesc.NumDescriptors = m_NumContexts;
+        HeapDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        hr                      = pd3d12Device->CreateDescriptorHeap(&HeapDesc, __uuidof(m_pSPDCounterUAVs), reinterpret_cast<void**>(static_cast<ID3D12DescriptorHeap**>(&m_pSPDCounterUAVs)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create descriptor heap for single-pass mipmap generation");
+
+        m_CounterUAVDescriptorSize = pd3d12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        for (Uint32 ctx = 0; ctx < m_NumContexts; ++ctx)
+        {
+            D3D12_UNORDERED_ACCESS_VIEW_DESC UAVDesc{};
+            UAVDesc.Format              = DXGI_FORMAT_R32_UINT;
+            UAVDesc.ViewDimension       = D3D12_UAV_DIMENSION_BUFFER;
+            UAVDesc.Buffer.FirstElement = CountersPerContext * ctx;
+            UAVDesc.Buffer.NumElements  = static_cast<UINT>(CountersPerContext);
+
+            auto CPUHandle = m_pSPDCounterUAVs->GetCPUDescriptorHandleForHeapStart();
+            CPUHandle.ptr += SIZE_T{m_CounterUAVDescriptorSize} * ctx;
+            pd3d12Device->CreateUnorderedAccessView(m_pSPDCounter, nullptr, &UAVDesc, CPUHandle);
+        }
+    }
+
+    m_ResourcesCreated.store(true);
 }
 
-void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx) const
+void GenerateMipsHelper::GetStatistics(DeviceHelperStatistics& Stats) const
 {
-    auto& ComputeCtx = Ctx.AsComputeContext();
-    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
+    if (!m_ResourcesCreated.load())
+        return;
+
+    // Eight multi-pass PSOs and two single-pass PSOs
+    Stats.NumMipGenerationPSOs += _countof(m_pGenerateMipsLinearPSO) + _countof(m_pGenerateMipsGammaPSO) + 2;
+    Stats.MipGenerationBufferSize += m_pSPDCounter->GetDesc().Width;
+}
+
+bool GenerateMipsHelper::IsSPDSupported(ID3D12Device* pd3d12Device, const TextureViewD3D12Impl& TexView) const
+{
+    const auto& TexDesc  = TexView.GetTexture<TextureD3D12Impl>()->GetDesc();
+    const auto& ViewDesc = TexView.GetDesc();
+
+    // Single-pass mip generation requires every downsampling step to be exactly 2:1.
+    // Mips 7 and below are generated by a single thread group, so mip 6 must not
+    // exceed 64x64.
+    const auto SrcWidth  = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const auto SrcHeight = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    const auto NumMips   = ViewDesc.NumMipLevels - 1;
+    if (!IsPowerOfTwo(SrcWidth) || !IsPowerOfTwo(SrcHeight) ||
+        NumMips > MaxSPDMips ||
+        ViewDesc.NumArraySlices > MaxSPDArraySlices)
+        return false;
+
+    if (NumMips <= 6)
+        return true;
+
+    if (std::max(SrcWidth, SrcHeight) > 4096)
+        return false;
+
+    // Mip level UAVs of sRGB textures use the UNORM format
+    auto UAVFormat = ViewDesc.Format;
+    if (UAVFormat == TEX_FORMAT_RGBA8_UNORM_SRGB)
+        UAVFormat = TEX_FORMAT_RGBA8_UNORM;
+    else if (UAVFormat == TEX_FORMAT_BGRA8_UNORM_SRGB)
+        UAVFormat = TEX_FORMAT_BGRA8_UNORM;
+    const auto DXGIFormat = TexFormatToDXGI_Format(UAVFormat);
+
+    std::lock_guard<std::mutex> Lock{m_TypedUAVLoadSupportMtx};
+
+    auto it = m_TypedUAVLoadSupport.find(DXGIFormat);
+    if (it == m_TypedUAVLoadSupport.end())
+    {
+        D3D12_FEATURE_DATA_FORMAT_SUPPORT FormatSupport = {DXGIFormat};
+
+        bool IsSupported = SUCCEEDED(pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &FormatSupport, sizeof(FormatSupport))) &&
+            (FormatSupport.Support2 & D3D12_FORMAT_SUPPORT2_UAV_TYPED_LOAD) != 0;
+        it = m_TypedUAVLoadSupport.emplace(DXGIFormat, IsSupported).first;
+    }
+    return it->second;
+}
+
+void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx, Uint32 ContextId)
+{
+    std::call_once(m_ResourcesCreatedFlag, &GenerateMipsHelper::CreateResources, this, pd3d12Device);
+
     auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
     const auto& TexDesc   = pTexD3D12->GetDesc();
     const auto& ViewDesc  = pTexView->GetDesc();
@@ -127,8 +253,6 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
         TexDesc.ArraySize == ViewDesc.NumArraySlices;
     bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
 
-    auto SRVDescriptorHandle = pTexView->GetTexArraySRV();
-
     if (!pTexD3D12->IsInKnownState())
     {
         LOG_ERROR_MESSAGE("Unable to generate mips for texture '", TexDesc.Name, "' because the texture state is unknown");
@@ -149,6 +273,25 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
     // Otherwise we will transition affected subresources back to original layout.
     const auto FinalState = (IsAllSlices && IsAllMips) ? RESOURCE_STATE_SHADER_RESOURCE : OriginalState;
 
+    if (IsSPDSupported(pd3d12Device, *pTexView))
+        GenerateMipsSPD(pd3d12Device, pTexView, Ctx, ContextId, OriginalState, FinalState);
+    else
+        GenerateMipsCS(pd3d12Device, pTexView, Ctx, OriginalState, FinalState);
+
+    // Set state
+    pTexD3D12->SetState(FinalState);
+}
+
+void GenerateMipsHelper::GenerateMipsCS(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx, RESOURCE_STATE OriginalState, RESOURCE_STATE FinalState) const
+{
+    auto& ComputeCtx = Ctx.AsComputeContext();
+    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsRS);
+    auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
+    const auto& TexDesc   = pTexD3D12->GetDesc();
+    const auto& ViewDesc  = pTexView->GetDesc();
+
+    auto SRVDescriptorHandle = pTexView->GetTexArraySRV();
+
     auto BottomMip = ViewDesc.NumMipLevels - 1;
     for (uint32_t TopMip = 0; TopMip < BottomMip;)
     {
@@ -270,8 +413,100 @@ void GenerateMipsHelper::GenerateMips(ID3D12Device* pd3d12Device, TextureViewD3D
 
         TopMip += NumMips;
     }
+}
 
-    // Set state
-    pTexD3D12->SetState(FinalState);
+void GenerateMipsHelper::GenerateMipsSPD(ID3D12Device* pd3d12Device, TextureViewD3D12Impl* pTexView, CommandContext& Ctx, Uint32 ContextId, RESOURCE_STATE OriginalState, RESOURCE_STATE FinalState) const
+{
+    auto& ComputeCtx = Ctx.AsComputeContext();
+    ComputeCtx.SetComputeRootSignature(m_pGenerateMipsSPDRS);
+    auto*       pTexD3D12 = pTexView->GetTexture<TextureD3D12Impl>();
+    const auto& TexDesc   = pTexD3D12->GetDesc();
+    const auto& ViewDesc  = pTexView->GetDesc();
+
+    if (TexDesc.Format == TEX_FORMAT_RGBA8_UNORM_SRGB)
+        ComputeCtx.SetPipelineState(m_pGenerateMipsSPDGammaPSO);
+    else
+        ComputeCtx.SetPipelineState(m_pGenerateMipsSPDLinearPSO);
+
+    // Mip levels are relative to the view's most detailed mip
+    const Uint32 NumMips    = ViewDesc.NumMipLevels - 1;
+    const Uint32 SrcWidth   = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const Uint32 SrcHeight  = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    const Uint32 Mip1Width  = std::max(SrcWidth >> 1, 1u);
+    const Uint32 Mip1Height = std::max(SrcHeight >> 1, 1u);
+
+    // Every thread group produces a 32x32 tile of mip 1
+    const Uint32 GroupsX = (Mip1Width + 31) / 32;
+    const Uint32 GroupsY = (Mip1Height + 31) / 32;
+
+    constexpr UINT NumDescriptors  = 1 + MaxSPDMips + 1;
+    auto           DescriptorAlloc = Ctx.AllocateDynamicGPUVisibleDescriptor(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, NumDescriptors);
+
+    CommandContext::ShaderDescriptorHeaps Heaps{DescriptorAlloc.GetDescriptorHeap(), nullptr};
+    ComputeCtx.SetDescriptorHeaps(Heaps);
+    Ctx.GetCommandList()->SetComputeRootDescriptorTable(1, DescriptorAlloc.GetGpuHandle(0));
+    Ctx.GetCommandList()->SetComputeRootDescriptorTable(2, DescriptorAlloc.GetGpuHandle(1));
+
+    struct RootCBData
+    {
+        Uint32 SrcMipSize[2]; // Dimensions of the source mip level
+        Uint32 NumMipLevels;  // Number of mip levels to generate: [1, 12]
+        Uint32 NumGroups;     // Number of thread groups per array slice
+    };
+    RootCBData CBData{{SrcWidth, SrcHeight}, NumMips, GroupsX * GroupsY};
+    Ctx.GetCommandList()->SetComputeRoot32BitConstants(0, 4, &CBData, 0);
+
+    D3D12_CPU_DESCRIPTOR_HANDLE DstDescriptorRange = DescriptorAlloc.GetCpuHandle();
+    UINT                        DstRangeSize       = NumDescriptors;
+    D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRanges[NumDescriptors] = {};
+    UINT                        SrcRangeSizes[NumDescriptors]       = {};
+
+    SrcDescriptorRanges[0] = pTexView->GetTexArraySRV();
+    // All descriptor tables must be fully populated, so bind the last mip level to all unused slots
+    for (Uint32 Mip = 1; Mip <= MaxSPDMips; ++Mip)
+        SrcDescriptorRanges[Mip] = pTexView->GetMipLevelUAV(std::min(Mip, NumMips));
+    SrcDescriptorRanges[NumDescriptors - 1] = m_pSPDCounterUAVs->GetCPUDescriptorHandleForHeapStart();
+    SrcDescriptorRanges[NumDescriptors - 1].ptr += SIZE_T{m_CounterUAVDescriptorSize} * ContextId;
+    for (auto& RangeSize : SrcRangeSizes)
+        RangeSize = 1;
+
+    pd3d12Device->CopyDescriptors(1, &DstDescriptorRange, &DstRangeSize, NumDescriptors, SrcDescriptorRanges, SrcRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    // Transition the source mip level to the shader resource state
+    StateTransitionDesc SrcMipBarrier{pTexD3D12, OriginalState, RESOURCE_STATE_SHADER_RESOURCE, false};
+    SrcMipBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip;
+    SrcMipBarrier.MipLevelsCount  = 1;
+    SrcMipBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+    SrcMipBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
+    if (SrcMipBarrier.OldState != SrcMipBarrier.NewState)
+        Ctx.TransitionResource(*pTexD3D12, SrcMipBarrier);
+
+    // All mip levels are generated by a single dispatch
+    StateTransitionDesc DstMipsBarrier{pTexD3D12, OriginalState, RESOURCE_STATE_UNORDERED_ACCESS, false};
+    DstMipsBarrier.FirstMipLevel   = ViewDesc.MostDetailedMip + 1;
+    DstMipsBarrier.MipLevelsCount  = NumMips;
+    DstMipsBarrier.FirstArraySlice = ViewDesc.FirstArraySlice;
+    DstMipsBarrier.ArraySliceCount = ViewDesc.NumArraySlices;
+    if (DstMipsBarrier.OldState != DstMipsBarrier.NewState)
+        Ctx.TransitionResource(*pTexD3D12, DstMipsBarrier);
+
+    ComputeCtx.Dispatch(GroupsX, GroupsY, ViewDesc.NumArraySlices);
+
+    // The last thread group resets the counters, and the next dispatch must see the reset values
+    Ctx.ResourceBarrier(CD3DX12_RESOURCE_BARRIER::UAV(m_pSPDCounter));
+
+    if (SrcMipBarrier.NewState != FinalState)
+    {
+        SrcMipBarrier.OldState = SrcMipBarrier.NewState;
+        SrcMipBarrier.NewState = FinalState;
+        Ctx.TransitionResource(*pTexD3D12, SrcMipBarrier);
+    }
+
+    if (DstMipsBarrier.NewState != FinalState)
+    {
+        DstMipsBarrier.OldState = DstMipsBarrier.NewState;
+        DstMipsBarrier.NewState = FinalState;
+        Ctx.TransitionResource(*pTexD3D12, DstMipsBarrier);
+    }
 }
 } // namespace Diligent
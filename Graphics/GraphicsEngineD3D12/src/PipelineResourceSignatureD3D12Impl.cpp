@@ -54,6 +54,23 @@ void ValidatePipelineResourceSignatureDescD3D12(const PipelineResourceSignatureD
         {
             const auto& Res = Desc.Resources[i];
 
+            // Views register their descriptors in the bindless range of the GPU heap
+            // (see RenderDeviceD3D12Impl::AddBindlessDescriptor()), but root signatures
+            // can't reference the range yet.
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP) != 0)
+            {
+                LOG_ERROR_AND_THROW("Pipeline resource signature '", (Desc.Name != nullptr ? Desc.Name : ""),
+                                    "': resource '", Res.Name, "' uses PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP flag that is not yet supported in Direct3D12 backend.");
+            }
+
+            // Inline constants map to root constants (SetGraphicsRoot32BitConstants), which
+            // the root signature builder does not allocate yet.
+            if ((Res.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+            {
+                LOG_ERROR_AND_THROW("Pipeline resource signature '", (Desc.Name != nullptr ? Desc.Name : ""),
+                                    "': resource '", Res.Name, "' uses PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag that is not yet supported in Direct3D12 backend.");
+            }
+
             ResNameToShaderStages.emplace(Res.Name, Res.ShaderStages);
             auto range          = ResNameToShaderStages.equal_range(Res.Name);
             auto multi_stage_it = ResNameToShaderStages.end();
@@ -489,6 +506,32 @@ void PipelineResourceSignatureD3D12Impl::CommitRootViews(const CommitCacheResour
     }
 }
 
+bool PipelineResourceSignatureD3D12Impl::GetDynamicSamplerTableKey(const ShaderResourceCacheD3D12& ResourceCache,
+                                                                   std::vector<SIZE_T>&            Key) const
+{
+    Key.resize(m_RootParams.GetParameterGroupSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, ROOT_PARAMETER_GROUP_DYNAMIC));
+
+    for (Uint32 rt = 0, NumRootTables = m_RootParams.GetNumRootTables(); rt < NumRootTables; ++rt)
+    {
+        const auto& RootTable = m_RootParams.GetRootTable(rt);
+        if (RootTable.Group != ROOT_PARAMETER_GROUP_DYNAMIC ||
+            RootTable.d3d12RootParam.DescriptorTable.pDescriptorRanges[0].RangeType != D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER)
+            continue;
+
+        const auto& CacheTable = ResourceCache.GetRootTable(RootTable.RootIndex);
+        VERIFY_EXPR(RootTable.TableOffsetInGroupAllocation + CacheTable.GetSize() <= Key.size());
+        for (Uint32 i = 0; i < CacheTable.GetSize(); ++i)
+        {
+            const auto Handle = CacheTable.GetResource(i).CPUDescriptorHandle;
+            if (Handle.ptr == 0)
+                return false;
+            Key[RootTable.TableOffsetInGroupAllocation + i] = Handle.ptr;
+        }
+    }
+
+    return true;
+}
+
 void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResourcesAttribs& CommitAttribs) const
 {
     const auto& ResourceCache = CommitAttribs.ResourceCache;
@@ -501,6 +544,8 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
     // there are no dynamic variables as constructors and desctructors are always called. To avoid this
     // overhead we will construct DescriptorHeapAllocation in-place only when they are really needed.
     std::array<DescriptorHeapAllocation*, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> pDynamicDescriptorAllocations{};
+    // Dynamic sampler tables may also be owned by the command context
+    std::array<const DescriptorHeapAllocation*, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1> pDynamicTables{};
 
     // Reserve space for DescriptorHeapAllocation objects (do NOT zero-out!)
     alignas(DescriptorHeapAllocation) uint8_t DynamicDescriptorAllocationsRawMem[sizeof(DescriptorHeapAllocation) * (D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER + 1)];
@@ -512,6 +557,25 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
         auto NumDynamicDescriptors = m_RootParams.GetParameterGroupSize(d3d12HeapType, ROOT_PARAMETER_GROUP_DYNAMIC);
         if (NumDynamicDescriptors > 0)
         {
+            CommandContext::DynamicSamplerTableKey* pSamplerTableKey = nullptr;
+            if (d3d12HeapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+            {
+                // Different SRBs and repeated commits of the same SRB often reference the same samplers.
+                // Reuse the table that was already copied to the GPU-visible heap instead of allocating
+                // new descriptors every time, which quickly exhausts the 2048-entry sampler heap.
+                pSamplerTableKey = &CmdCtx.GetDynamicSamplerTableKeyScratch();
+                if (GetDynamicSamplerTableKey(ResourceCache, *pSamplerTableKey))
+                {
+                    pDynamicTables[d3d12HeapType] = CmdCtx.FindDynamicSamplerTable(*pSamplerTableKey);
+                    if (pDynamicTables[d3d12HeapType] != nullptr)
+                        continue;
+                }
+                else
+                {
+                    pSamplerTableKey = nullptr;
+                }
+            }
+
             auto& pAllocation = pDynamicDescriptorAllocations[d3d12HeapType];
 
             // Create new DescriptorHeapAllocation in-place
@@ -529,11 +593,16 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
             const auto& SrcDynamicAllocation = ResourceCache.GetDescriptorAllocation(d3d12HeapType, ROOT_PARAMETER_GROUP_DYNAMIC);
             VERIFY_EXPR(SrcDynamicAllocation.GetNumHandles() == NumDynamicDescriptors);
             pd3d12Device->CopyDescriptorsSimple(NumDynamicDescriptors, pAllocation->GetCpuHandle(), SrcDynamicAllocation.GetCpuHandle(), d3d12HeapType);
+
+            if (pSamplerTableKey != nullptr && !pAllocation->IsNull())
+                pDynamicTables[d3d12HeapType] = &CmdCtx.AddDynamicSamplerTable(*pSamplerTableKey, std::move(*pAllocation));
+            else
+                pDynamicTables[d3d12HeapType] = pAllocation;
         }
     }
 
-    auto* const pSrvCbvUavDynamicAllocation = pDynamicDescriptorAllocations[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
-    auto* const pSamplerDynamicAllocation   = pDynamicDescriptorAllocations[D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER];
+    const auto* const pSrvCbvUavDynamicAllocation = pDynamicTables[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
+    const auto* const pSamplerDynamicAllocation   = pDynamicTables[D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER];
 
     CommandContext::ShaderDescriptorHeaps Heaps{
         ResourceCache.GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, ROOT_PARAMETER_GROUP_STATIC_MUTABLE),
@@ -571,7 +640,7 @@ void PipelineResourceSignatureD3D12Impl::CommitRootTables(const CommitCacheResou
         D3D12_GPU_DESCRIPTOR_HANDLE RootTableGPUDescriptorHandle{};
         if (RootTable.Group == ROOT_PARAMETER_GROUP_DYNAMIC)
         {
-            auto& DynamicAllocation      = *pDynamicDescriptorAllocations[d3d12HeapType];
+            auto& DynamicAllocation      = *pDynamicTables[d3d12HeapType];
             RootTableGPUDescriptorHandle = DynamicAllocation.GetGpuHandle(TableOffsetInGroupAllocation);
         }
         else
@@ -0,0 +1,306 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineStateCacheD3D12Impl.hpp"
+#include "RenderDeviceD3D12Impl.hpp"
+#include "DataBlobImpl.hpp"
+#include "StringTools.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Layout of the data returned by GetData():
+//
+//   | CacheDataHeader | Pipeline library | Root signature 0 | Root signature 1 | ... |
+//
+// Every root signature entry is a RootSignatureEntryHeader followed by the root signature
+// description key and the serialized root signature. Data that does not start with the
+// header is treated as pipeline library data.
+struct CacheDataHeader
+{
+    static constexpr Uint32 ExpectedMagic = 0x47495352; // 'RSIG'
+
+    Uint32 Magic;
+    Uint32 NumRootSignatures;
+    Uint64 LibrarySize;
+};
+
+struct RootSignatureEntryHeader
+{
+    Uint32 DescKeySize;
+    Uint32 BlobSize;
+};
+
+} // namespace
+
+PipelineStateCacheD3D12Impl::PipelineStateCacheD3D12Impl(IReferenceCounters*                 pRefCounters,
+                                                         RenderDeviceD3D12Impl*              pDeviceD3D12,
+                                                         const PipelineStateCacheCreateInfo& CreateInfo) :
+    // clang-format off
+    TDeviceObjectBase
+    {
+        pRefCounters,
+        pDeviceD3D12,
+        CreateInfo.Desc
+    }
+// clang-format on
+{
+    CComPtr<ID3D12Device1> pd3d12Device1;
+    if (FAILED(pDeviceD3D12->GetD3D12Device()->QueryInterface(IID_PPV_ARGS(&pd3d12Device1))))
+        LOG_ERROR_AND_THROW("Pipeline libraries require ID3D12Device1 interface");
+
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0)
+    {
+        const auto LibraryData = ParseInitialData(static_cast<const Uint8*>(CreateInfo.pCacheData), CreateInfo.CacheDataSize);
+        m_InitialData.assign(LibraryData.first, LibraryData.first + LibraryData.second);
+    }
+
+    if (!m_InitialData.empty())
+    {
+        auto hr = pd3d12Device1->CreatePipelineLibrary(m_InitialData.data(), m_InitialData.size(), IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+        {
+            // D3D12_ERROR_DRIVER_VERSION_MISMATCH, D3D12_ERROR_ADAPTER_NOT_FOUND or E_INVALIDARG
+            LOG_WARNING_MESSAGE("Pipeline library data of pipeline state cache '", m_Desc.Name,
+                                "' is not compatible with the device and will be ignored.");
+            m_InitialData.clear();
+        }
+    }
+
+    if (!m_pLibrary)
+    {
+        auto hr = pd3d12Device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+    }
+
+    if (*m_Desc.Name != 0)
+    {
+        m_pLibrary->SetName(WidenString(m_Desc.Name).c_str());
+    }
+}
+
+std::pair<const Uint8*, size_t> PipelineStateCacheD3D12Impl::ParseInitialData(const Uint8* pData, size_t DataSize)
+{
+    CacheDataHeader Header{};
+    if (DataSize < sizeof(Header))
+        return {pData, DataSize};
+
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != CacheDataHeader::ExpectedMagic || Header.LibrarySize > DataSize - sizeof(Header))
+        return {pData, DataSize};
+
+    const auto* const pLibraryData = pData + sizeof(Header);
+    const auto* const pEnd         = pData + DataSize;
+
+    const auto* pCurr = pLibraryData + Header.LibrarySize;
+    for (Uint32 i = 0; i < Header.NumRootSignatures; ++i)
+    {
+        RootSignatureEntryHeader Entry{};
+        if (static_cast<size_t>(pEnd - pCurr) < sizeof(Entry))
+        {
+            LOG_WARNING_MESSAGE("Root signature data of pipeline state cache '", m_Desc.Name, "' is truncated.");
+            break;
+        }
+        memcpy(&Entry, pCurr, sizeof(Entry));
+        pCurr += sizeof(Entry);
+
+        if (static_cast<size_t>(pEnd - pCurr) < size_t{Entry.DescKeySize} + size_t{Entry.BlobSize})
+        {
+            LOG_WARNING_MESSAGE("Root signature data of pipeline state cache '", m_Desc.Name, "' is truncated.");
+            break;
+        }
+
+        RootSignatureBlob RootSig;
+        RootSig.DescKey.assign(pCurr, pCurr + Entry.DescKeySize);
+        pCurr += Entry.DescKeySize;
+        RootSig.Blob.assign(pCurr, pCurr + Entry.BlobSize);
+        pCurr += Entry.BlobSize;
+
+        const auto Hash = ComputeHashRaw(RootSig.DescKey.data(), RootSig.DescKey.size());
+        m_RootSigBlobs.emplace(Hash, std::move(RootSig));
+    }
+
+    return {pLibraryData, static_cast<size_t>(Header.LibrarySize)};
+}
+
+PipelineStateCacheD3D12Impl::~PipelineStateCacheD3D12Impl()
+{
+    // The library is not referenced by command lists, so it can be released immediately.
+    m_pLibrary.Release();
+}
+
+CComPtr<ID3D12PipelineState> PipelineStateCacheD3D12Impl::LoadGraphicsPipeline(const wchar_t* Name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc)
+{
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+
+    CComPtr<ID3D12PipelineState> pd3d12PSO;
+    if (FAILED(m_pLibrary->LoadGraphicsPipeline(Name, &Desc, IID_PPV_ARGS(&pd3d12PSO))))
+        pd3d12PSO.Release();
+    return pd3d12PSO;
+}
+
+CComPtr<ID3D12PipelineState> PipelineStateCacheD3D12Impl::LoadComputePipeline(const wchar_t* Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc)
+{
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+
+    CComPtr<ID3D12PipelineState> pd3d12PSO;
+    if (FAILED(m_pLibrary->LoadComputePipeline(Name, &Desc, IID_PPV_ARGS(&pd3d12PSO))))
+        pd3d12PSO.Release();
+    return pd3d12PSO;
+}
+
+void PipelineStateCacheD3D12Impl::StorePipeline(const wchar_t* Name, ID3D12PipelineState* pd3d12PSO)
+{
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+
+    auto hr = m_pLibrary->StorePipeline(Name, pd3d12PSO);
+    if (hr == E_INVALIDARG)
+    {
+        // A pipeline with the same name already exists in the library. Pipeline names are hashes of the full
+        // description, so this only happens when identical pipelines are created concurrently or on a hash collision.
+        LOG_WARNING_MESSAGE("Pipeline '", NarrowString(Name), "' was not stored in pipeline state cache '", m_Desc.Name,
+                            "' because a pipeline with the same name already exists");
+    }
+    else if (FAILED(hr))
+    {
+        LOG_WARNING_MESSAGE("Failed to store pipeline in pipeline state cache '", m_Desc.Name, "'");
+    }
+}
+
+CComPtr<ID3D12RootSignature> PipelineStateCacheD3D12Impl::LoadRootSignature(const std::vector<Uint8>& DescKey)
+{
+    const auto Hash = ComputeHashRaw(DescKey.data(), DescKey.size());
+
+    const std::vector<Uint8>* pBlob = nullptr;
+    {
+        std::lock_guard<std::mutex> Lock{m_RootSigBlobsMtx};
+
+        auto Range = m_RootSigBlobs.equal_range(Hash);
+        for (auto Iter = Range.first; Iter != Range.second; ++Iter)
+        {
+            if (Iter->second.DescKey == DescKey)
+            {
+                // Blobs are never removed, so the pointer remains valid after the lock is released
+                pBlob = &Iter->second.Blob;
+                break;
+            }
+        }
+    }
+
+    CComPtr<ID3D12RootSignature> pd3d12RootSig;
+    if (pBlob != nullptr)
+    {
+        auto hr = GetDevice()->GetD3D12Device()->CreateRootSignature(0, pBlob->data(), pBlob->size(), IID_PPV_ARGS(&pd3d12RootSig));
+        if (FAILED(hr))
+            pd3d12RootSig.Release();
+    }
+    return pd3d12RootSig;
+}
+
+void PipelineStateCacheD3D12Impl::StoreRootSignature(const std::vector<Uint8>& DescKey, const void* pBlob, size_t BlobSize)
+{
+    const auto Hash = ComputeHashRaw(DescKey.data(), DescKey.size());
+
+    std::lock_guard<std::mutex> Lock{m_RootSigBlobsMtx};
+
+    auto Range = m_RootSigBlobs.equal_range(Hash);
+    for (auto Iter = Range.first; Iter != Range.second; ++Iter)
+    {
+        if (Iter->second.DescKey == DescKey)
+            return;
+    }
+
+    RootSignatureBlob RootSig;
+    RootSig.DescKey = DescKey;
+    RootSig.Blob.assign(static_cast<const Uint8*>(pBlob), static_cast<const Uint8*>(pBlob) + BlobSize);
+    m_RootSigBlobs.emplace(Hash, std::move(RootSig));
+}
+
+void PipelineStateCacheD3D12Impl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "Null pointer provided");
+    if (ppBlob == nullptr)
+        return;
+    DEV_CHECK_ERR(*ppBlob == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    *ppBlob = nullptr;
+
+    std::lock_guard<std::mutex> Lock{m_LibraryMtx};
+    std::lock_guard<std::mutex> RootSigLock{m_RootSigBlobsMtx};
+
+    const auto LibrarySize = m_pLibrary->GetSerializedSize();
+
+    auto DataSize = sizeof(CacheDataHeader) + LibrarySize;
+    for (const auto& it : m_RootSigBlobs)
+        DataSize += sizeof(RootSignatureEntryHeader) + it.second.DescKey.size() + it.second.Blob.size();
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>{}(DataSize)};
+
+    auto* pData = static_cast<Uint8*>(pDataBlob->GetDataPtr());
+
+    CacheDataHeader Header{};
+    Header.Magic             = CacheDataHeader::ExpectedMagic;
+    Header.NumRootSignatures = static_cast<Uint32>(m_RootSigBlobs.size());
+    Header.LibrarySize       = LibrarySize;
+    memcpy(pData, &Header, sizeof(Header));
+    pData += sizeof(Header);
+
+    if (FAILED(m_pLibrary->Serialize(pData, LibrarySize)))
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize pipeline state cache '", m_Desc.Name, "'");
+        return;
+    }
+    pData += LibrarySize;
+
+    for (const auto& it : m_RootSigBlobs)
+    {
+        const auto& RootSig = it.second;
+
+        RootSignatureEntryHeader Entry{};
+        Entry.DescKeySize = static_cast<Uint32>(RootSig.DescKey.size());
+        Entry.BlobSize    = static_cast<Uint32>(RootSig.Blob.size());
+        memcpy(pData, &Entry, sizeof(Entry));
+        pData += sizeof(Entry);
+
+        memcpy(pData, RootSig.DescKey.data(), RootSig.DescKey.size());
+        pData += RootSig.DescKey.size();
+        memcpy(pData, RootSig.Blob.data(), RootSig.Blob.size());
+        pData += RootSig.Blob.size();
+    }
+    VERIFY_EXPR(pData == static_cast<Uint8*>(pDataBlob->GetDataPtr()) + DataSize);
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppBlob));
+}
+
+} // namespace Diligent
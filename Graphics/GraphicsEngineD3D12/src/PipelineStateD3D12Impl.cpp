@@ -41,6 +41,7 @@
 #include "RenderDeviceD3D12Impl.hpp"
 #include "ShaderD3D12Impl.hpp"
 #include "ShaderResourceBindingD3D12Impl.hpp"
+#include "PipelineStateCacheD3D12Impl.hpp"
 
 #include "D3D12TypeConversions.hpp"
 #include "DXGITypeConversions.hpp"
@@ -48,8 +49,8 @@
 #include "EngineMemory.h"
 #include "StringTools.hpp"
 #include "DynamicLinearAllocator.hpp"
-#include "DXBCUtils.hpp"
 #include "DXCompiler.hpp"
+#include "HashUtils.hpp"
 #include "dxc/dxcapi.h"
 
 namespace Diligent
@@ -293,6 +294,114 @@ void GetShaderIdentifiers(ID3D12DeviceChild*                       pSO,
     }
 }
 
+void HashD3D12ShaderBytecode(size_t& Hash, const D3D12_SHADER_BYTECODE& ByteCode)
+{
+    HashCombine(Hash, ByteCode.BytecodeLength);
+    if (ByteCode.pShaderBytecode != nullptr)
+        HashCombine(Hash, ComputeHashRaw(ByteCode.pShaderBytecode, ByteCode.BytecodeLength));
+}
+
+void HashD3D12StreamOutputDesc(size_t& Hash, const D3D12_STREAM_OUTPUT_DESC& Desc)
+{
+    HashCombine(Hash, Desc.NumEntries, Desc.NumStrides, Desc.RasterizedStream);
+    for (UINT i = 0; i < Desc.NumEntries; ++i)
+    {
+        const auto& Entry = Desc.pSODeclaration[i];
+        HashCombine(Hash, Entry.Stream, Entry.SemanticIndex, Uint32{Entry.StartComponent}, Uint32{Entry.ComponentCount}, Uint32{Entry.OutputSlot});
+        if (Entry.SemanticName != nullptr)
+            HashCombine(Hash, CStringHash<char>{}(Entry.SemanticName));
+    }
+    for (UINT i = 0; i < Desc.NumStrides; ++i)
+        HashCombine(Hash, Desc.pBufferStrides[i]);
+}
+
+void HashD3D12BlendDesc(size_t& Hash, const D3D12_BLEND_DESC& Desc)
+{
+    HashCombine(Hash, Desc.AlphaToCoverageEnable, Desc.IndependentBlendEnable);
+    for (const auto& RT : Desc.RenderTarget)
+    {
+        HashCombine(Hash, RT.BlendEnable, RT.LogicOpEnable,
+                    static_cast<Uint32>(RT.SrcBlend), static_cast<Uint32>(RT.DestBlend), static_cast<Uint32>(RT.BlendOp),
+                    static_cast<Uint32>(RT.SrcBlendAlpha), static_cast<Uint32>(RT.DestBlendAlpha), static_cast<Uint32>(RT.BlendOpAlpha),
+                    static_cast<Uint32>(RT.LogicOp), Uint32{RT.RenderTargetWriteMask});
+    }
+}
+
+void HashD3D12RasterizerDesc(size_t& Hash, const D3D12_RASTERIZER_DESC& Desc)
+{
+    HashCombine(Hash, static_cast<Uint32>(Desc.FillMode), static_cast<Uint32>(Desc.CullMode), Desc.FrontCounterClockwise,
+                Desc.DepthBias, Desc.DepthBiasClamp, Desc.SlopeScaledDepthBias, Desc.DepthClipEnable, Desc.MultisampleEnable,
+                Desc.AntialiasedLineEnable, Desc.ForcedSampleCount, static_cast<Uint32>(Desc.ConservativeRaster));
+}
+
+void HashD3D12DepthStencilOpDesc(size_t& Hash, const D3D12_DEPTH_STENCILOP_DESC& Desc)
+{
+    HashCombine(Hash, static_cast<Uint32>(Desc.StencilFailOp), static_cast<Uint32>(Desc.StencilDepthFailOp),
+                static_cast<Uint32>(Desc.StencilPassOp), static_cast<Uint32>(Desc.StencilFunc));
+}
+
+void HashD3D12DepthStencilDesc(size_t& Hash, const D3D12_DEPTH_STENCIL_DESC& Desc)
+{
+    HashCombine(Hash, Desc.DepthEnable, static_cast<Uint32>(Desc.DepthWriteMask), static_cast<Uint32>(Desc.DepthFunc),
+                Desc.StencilEnable, Uint32{Desc.StencilReadMask}, Uint32{Desc.StencilWriteMask});
+    HashD3D12DepthStencilOpDesc(Hash, Desc.FrontFace);
+    HashD3D12DepthStencilOpDesc(Hash, Desc.BackFace);
+}
+
+void HashD3D12InputLayoutDesc(size_t& Hash, const D3D12_INPUT_LAYOUT_DESC& Desc)
+{
+    HashCombine(Hash, Desc.NumElements);
+    for (UINT i = 0; i < Desc.NumElements; ++i)
+    {
+        const auto& Elem = Desc.pInputElementDescs[i];
+        HashCombine(Hash, CStringHash<char>{}(Elem.SemanticName), Elem.SemanticIndex, static_cast<Uint32>(Elem.Format),
+                    Elem.InputSlot, Elem.AlignedByteOffset, static_cast<Uint32>(Elem.InputSlotClass), Elem.InstanceDataStepRate);
+    }
+}
+
+std::wstring MakePipelineLibraryKey(const wchar_t* Prefix, size_t Hash)
+{
+    std::wstringstream ss;
+    ss << Prefix << L'_' << std::hex << Hash;
+    return ss.str();
+}
+
+// Pipeline library entries are identified by name. The key is the hash of the full D3D12 pipeline
+// description: the root signature, the shader byte code and all fixed-function state. The PSO name
+// is not used because unnamed pipelines are given a different name in every run, and pipelines
+// with the same name may differ in state, in which case the library would fail to load them.
+std::wstring GetPipelineLibraryKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& Desc, const RootSignatureD3D12& RootSig)
+{
+    const auto& RootSigKey = RootSig.GetDescKey();
+
+    size_t Hash = ComputeHashRaw(RootSigKey.data(), RootSigKey.size());
+    for (const auto* pByteCode : {&Desc.VS, &Desc.PS, &Desc.DS, &Desc.HS, &Desc.GS})
+        HashD3D12ShaderBytecode(Hash, *pByteCode);
+    HashD3D12StreamOutputDesc(Hash, Desc.StreamOutput);
+    HashD3D12BlendDesc(Hash, Desc.BlendState);
+    HashCombine(Hash, Desc.SampleMask);
+    HashD3D12RasterizerDesc(Hash, Desc.RasterizerState);
+    HashD3D12DepthStencilDesc(Hash, Desc.DepthStencilState);
+    HashD3D12InputLayoutDesc(Hash, Desc.InputLayout);
+    HashCombine(Hash, static_cast<Uint32>(Desc.IBStripCutValue), static_cast<Uint32>(Desc.PrimitiveTopologyType), Desc.NumRenderTargets);
+    for (const auto RTVFormat : Desc.RTVFormats)
+        HashCombine(Hash, static_cast<Uint32>(RTVFormat));
+    HashCombine(Hash, static_cast<Uint32>(Desc.DSVFormat), Desc.SampleDesc.Count, Desc.SampleDesc.Quality, Desc.NodeMask, static_cast<Uint32>(Desc.Flags));
+
+    return MakePipelineLibraryKey(L"Graphics", Hash);
+}
+
+std::wstring GetPipelineLibraryKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc, const RootSignatureD3D12& RootSig)
+{
+    const auto& RootSigKey = RootSig.GetDescKey();
+
+    size_t Hash = ComputeHashRaw(RootSigKey.data(), RootSigKey.size());
+    HashD3D12ShaderBytecode(Hash, Desc.CS);
+    HashCombine(Hash, Desc.NodeMask, static_cast<Uint32>(Desc.Flags));
+
+    return MakePipelineLibraryKey(L"Compute", Hash);
+}
+
 } // namespace
 
 
@@ -408,8 +517,9 @@ RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> PipelineStateD3D12Impl::Create
     return TPipelineStateBase::CreateDefaultSignature(Resources, pCombinedSamplerSuffix, pImmutableSamplers, bIsDeviceInternal);
 }
 
-void PipelineStateD3D12Impl::InitRootSignature(TShaderStages&           ShaderStages,
-                                               LocalRootSignatureD3D12* pLocalRootSig)
+void PipelineStateD3D12Impl::InitRootSignature(TShaderStages&               ShaderStages,
+                                               LocalRootSignatureD3D12*     pLocalRootSig,
+                                               PipelineStateCacheD3D12Impl* pPSOCache)
 {
     if (m_UsingImplicitSignature)
     {
@@ -418,7 +528,7 @@ void PipelineStateD3D12Impl::InitRootSignature(TShaderStages&           ShaderSt
         VERIFY_EXPR(!m_Signatures[0] || m_Signatures[0]->GetDesc().BindingIndex == 0);
     }
 
-    m_RootSig = GetDevice()->GetRootSignatureCache().GetRootSig(m_Signatures, m_SignatureCount);
+    m_RootSig = GetDevice()->GetRootSignatureCache().GetRootSig(m_Signatures, m_SignatureCount, pPSOCache);
     if (!m_RootSig)
         LOG_ERROR_AND_THROW("Failed to create root signature for pipeline '", m_Desc.Name, "'.");
 
@@ -471,8 +581,8 @@ void PipelineStateD3D12Impl::InitRootSignature(TShaderStages&           ShaderSt
 
         for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            const auto* const pShader   = Shaders[i];
-            auto&             pBytecode = ByteCodes[i];
+            auto* const pShader   = Shaders[i];
+            auto&       pBytecode = ByteCodes[i];
 
             Uint32 VerMajor, VerMinor;
             pShader->GetShaderResources()->GetShaderModel(VerMajor, VerMinor);
@@ -493,24 +603,8 @@ void PipelineStateD3D12Impl::InitRootSignature(TShaderStages&           ShaderSt
             // Validate resources before remapping
             ValidateShaderResources(pShader, pLocalRootSig);
 
-            CComPtr<ID3DBlob> pBlob;
-            if (IsDXILBytecode(pBytecode->GetBufferPointer(), pBytecode->GetBufferSize()))
-            {
-                if (!compiler)
-                    LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
-
-                if (!compiler->RemapResourceBindings(ResourceMap, reinterpret_cast<IDxcBlob*>(pBytecode.p), reinterpret_cast<IDxcBlob**>(&pBlob)))
-                    LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-            }
-            else
-            {
-                D3DCreateBlob(pBytecode->GetBufferSize(), &pBlob);
-                memcpy(pBlob->GetBufferPointer(), pBytecode->GetBufferPointer(), pBytecode->GetBufferSize());
-
-                if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBlob->GetBufferPointer(), pBlob->GetBufferSize()))
-                    LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", pShader->GetDesc().Name, "'.");
-            }
-            pBytecode = pBlob;
+            VERIFY_EXPR(pBytecode == pShader->GetShaderByteCode());
+            pBytecode = pShader->GetRemappedBytecode(ResourceMap, compiler, pShader->GetDesc().Name);
         }
     }
 }
@@ -628,245 +722,333 @@ void PipelineStateD3D12Impl::InitInternalObjects(const PSOCreateInfoType& Create
     // It is important to construct all objects before initializing them because if an exception is thrown,
     // destructors will be called for all objects
 
-    InitRootSignature(ShaderStages, pLocalRootSig);
+    InitRootSignature(ShaderStages, pLocalRootSig, ValidatedCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache));
+
+    // D3D12 does not expose the statistics of the native code, so the byte code statistics are reported
+    if ((CreateInfo.Flags & PSO_CREATE_FLAG_CAPTURE_STATISTICS) != 0)
+    {
+        for (const auto& Stage : ShaderStages)
+        {
+            for (const auto* pShader : Stage.Shaders)
+                m_Statistics.push_back(pShader->GetShaderResources()->GetStatistics());
+        }
+    }
 }
 
 
-PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*                    pRefCounters,
-                                               RenderDeviceD3D12Impl*                 pDeviceD3D12,
-                                               const GraphicsPipelineStateCreateInfo& CreateInfo) :
-    TPipelineStateBase{pRefCounters, pDeviceD3D12, CreateInfo}
+void PipelineStateD3D12Impl::InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo)
 {
-    try
+    TShaderStages ShaderStages;
+    InitInternalObjects(CreateInfo, ShaderStages);
+
+    auto* pd3d12Device = GetDevice()->GetD3D12Device();
+    if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
     {
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
+        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
 
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
-        if (m_Desc.PipelineType == PIPELINE_TYPE_GRAPHICS)
-        {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
 
-            D3D12_GRAPHICS_PIPELINE_STATE_DESC d3d12PSODesc = {};
+        for (const auto& Stage : ShaderStages)
+        {
+            VERIFY_EXPR(Stage.Count() == 1);
+            const auto& pByteCode = Stage.ByteCodes[0];
 
-            for (const auto& Stage : ShaderStages)
+            D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+            switch (Stage.Type)
             {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
+                // clang-format off
+                case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
+                case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
+                case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
+                case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
+                // clang-format on
+                default: UNEXPECTED("Unexpected shader type");
+            }
 
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_VERTEX:   pd3d12ShaderBytecode = &d3d12PSODesc.VS; break;
-                    case SHADER_TYPE_PIXEL:    pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    case SHADER_TYPE_GEOMETRY: pd3d12ShaderBytecode = &d3d12PSODesc.GS; break;
-                    case SHADER_TYPE_HULL:     pd3d12ShaderBytecode = &d3d12PSODesc.HS; break;
-                    case SHADER_TYPE_DOMAIN:   pd3d12ShaderBytecode = &d3d12PSODesc.DS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
+            pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+            pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+        }
 
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
-            }
+        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
 
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+        memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
 
-            memset(&d3d12PSODesc.StreamOutput, 0, sizeof(d3d12PSODesc.StreamOutput));
+        BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
+        // The sample mask for the blend state.
+        d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
 
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, d3d12PSODesc.BlendState);
-            // The sample mask for the blend state.
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+        RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
+        DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
 
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, d3d12PSODesc.DepthStencilState);
+        std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
 
-            std::vector<D3D12_INPUT_ELEMENT_DESC, STDAllocatorRawMem<D3D12_INPUT_ELEMENT_DESC>> d312InputElements(STD_ALLOCATOR_RAW_MEM(D3D12_INPUT_ELEMENT_DESC, GetRawAllocator(), "Allocator for vector<D3D12_INPUT_ELEMENT_DESC>"));
+        const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
+        if (InputLayout.NumElements > 0)
+        {
+            LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
+            d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
+            d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
+        }
+        else
+        {
+            d3d12PSODesc.InputLayout.NumElements        = 0;
+            d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
+        }
 
-            const auto& InputLayout = GetGraphicsPipelineDesc().InputLayout;
-            if (InputLayout.NumElements > 0)
-            {
-                LayoutElements_To_D3D12_INPUT_ELEMENT_DESCs(InputLayout, d312InputElements);
-                d3d12PSODesc.InputLayout.NumElements        = static_cast<UINT>(d312InputElements.size());
-                d3d12PSODesc.InputLayout.pInputElementDescs = d312InputElements.data();
-            }
-            else
-            {
-                d3d12PSODesc.InputLayout.NumElements        = 0;
-                d3d12PSODesc.InputLayout.pInputElementDescs = nullptr;
-            }
+        d3d12PSODesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+        static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
+        d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
 
-            d3d12PSODesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
-            static const PrimitiveTopology_To_D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimTopologyToD3D12TopologyType;
-            d3d12PSODesc.PrimitiveTopologyType = PrimTopologyToD3D12TopologyType[GraphicsPipeline.PrimitiveTopology];
+        d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+        for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
+            d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
+        d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
 
-            d3d12PSODesc.NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormats); ++rt)
-                d3d12PSODesc.RTVFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+        d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
+        d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
 
-            d3d12PSODesc.SampleDesc.Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc.Quality = GraphicsPipeline.SmplDesc.Quality;
+        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+        // set bits to identify the nodes (the device's physical adapters) for which the
+        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+        d3d12PSODesc.NodeMask = 0;
 
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
+        d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+        d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
 
-            d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+        auto* pPSOCacheD3D12 = ValidatedCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
 
+        std::wstring LibraryKey;
+        if (pPSOCacheD3D12 != nullptr)
+        {
+            LibraryKey  = GetPipelineLibraryKey(d3d12PSODesc, *m_RootSig);
+            m_pd3d12PSO = pPSOCacheD3D12->LoadGraphicsPipeline(LibraryKey.c_str(), d3d12PSODesc).p;
+        }
+
+        if (!m_pd3d12PSO)
+        {
             HRESULT hr = pd3d12Device->CreateGraphicsPipelineState(&d3d12PSODesc, IID_PPV_ARGS(&m_pd3d12PSO));
             if (FAILED(hr))
                 LOG_ERROR_AND_THROW("Failed to create pipeline state");
+
+            if (pPSOCacheD3D12 != nullptr)
+                pPSOCacheD3D12->StorePipeline(LibraryKey.c_str(), static_cast<ID3D12PipelineState*>(m_pd3d12PSO.p));
         }
+    }
 #ifdef D3D12_H_HAS_MESH_SHADER
-        else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
+    else if (m_Desc.PipelineType == PIPELINE_TYPE_MESH)
+    {
+        const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+
+        struct MESH_SHADER_PIPELINE_STATE_DESC
         {
-            const auto& GraphicsPipeline = GetGraphicsPipelineDesc();
+            PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
+            PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
+            PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
+            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
+            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
+            PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
+            PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
+            PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
+            PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
+            PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
+            PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
+            PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
+            PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
+            PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
+        };
+        MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
+
+        for (const auto& Stage : ShaderStages)
+        {
+            VERIFY_EXPR(Stage.Count() == 1);
+            const auto& pByteCode = Stage.ByteCodes[0];
 
-            struct MESH_SHADER_PIPELINE_STATE_DESC
-            {
-                PSS_SubObject<D3D12_PIPELINE_STATE_FLAGS, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_FLAGS>            Flags;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_NODE_MASK>                              NodeMask;
-                PSS_SubObject<ID3D12RootSignature*, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE>         pRootSignature;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS>                    PS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS>                    AS;
-                PSS_SubObject<D3D12_SHADER_BYTECODE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS>                    MS;
-                PSS_SubObject<D3D12_BLEND_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND>                      BlendState;
-                PSS_SubObject<D3D12_DEPTH_STENCIL_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL>      DepthStencilState;
-                PSS_SubObject<D3D12_RASTERIZER_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER>            RasterizerState;
-                PSS_SubObject<DXGI_SAMPLE_DESC, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC>                SampleDesc;
-                PSS_SubObject<UINT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK>                            SampleMask;
-                PSS_SubObject<DXGI_FORMAT, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT>            DSVFormat;
-                PSS_SubObject<D3D12_RT_FORMAT_ARRAY, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS> RTVFormatArray;
-                PSS_SubObject<D3D12_CACHED_PIPELINE_STATE, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO>      CachedPSO;
-            };
-            MESH_SHADER_PIPELINE_STATE_DESC d3d12PSODesc = {};
-
-            for (const auto& Stage : ShaderStages)
+            D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
+            switch (Stage.Type)
             {
-                VERIFY_EXPR(Stage.Count() == 1);
-                const auto& pByteCode = Stage.ByteCodes[0];
-
-                D3D12_SHADER_BYTECODE* pd3d12ShaderBytecode = nullptr;
-                switch (Stage.Type)
-                {
-                    // clang-format off
-                    case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
-                    case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
-                    case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
-                    // clang-format on
-                    default: UNEXPECTED("Unexpected shader type");
-                }
-
-                pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
-                pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+                // clang-format off
+                case SHADER_TYPE_AMPLIFICATION: pd3d12ShaderBytecode = &d3d12PSODesc.AS; break;
+                case SHADER_TYPE_MESH:          pd3d12ShaderBytecode = &d3d12PSODesc.MS; break;
+                case SHADER_TYPE_PIXEL:         pd3d12ShaderBytecode = &d3d12PSODesc.PS; break;
+                // clang-format on
+                default: UNEXPECTED("Unexpected shader type");
             }
 
-            d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+            pd3d12ShaderBytecode->pShaderBytecode = pByteCode->GetBufferPointer();
+            pd3d12ShaderBytecode->BytecodeLength  = pByteCode->GetBufferSize();
+        }
+
+        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
 
-            BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
-            d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
+        BlendStateDesc_To_D3D12_BLEND_DESC(GraphicsPipeline.BlendDesc, *d3d12PSODesc.BlendState);
+        d3d12PSODesc.SampleMask = GraphicsPipeline.SampleMask;
 
-            RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
-            DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
+        RasterizerStateDesc_To_D3D12_RASTERIZER_DESC(GraphicsPipeline.RasterizerDesc, *d3d12PSODesc.RasterizerState);
+        DepthStencilStateDesc_To_D3D12_DEPTH_STENCIL_DESC(GraphicsPipeline.DepthStencilDesc, *d3d12PSODesc.DepthStencilState);
 
-            d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
-            for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
-            for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
-                d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
-            d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
+        d3d12PSODesc.RTVFormatArray->NumRenderTargets = GraphicsPipeline.NumRenderTargets;
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            d3d12PSODesc.RTVFormatArray->RTFormats[rt] = TexFormatToDXGI_Format(GraphicsPipeline.RTVFormats[rt]);
+        for (Uint32 rt = GraphicsPipeline.NumRenderTargets; rt < _countof(d3d12PSODesc.RTVFormatArray->RTFormats); ++rt)
+            d3d12PSODesc.RTVFormatArray->RTFormats[rt] = DXGI_FORMAT_UNKNOWN;
+        d3d12PSODesc.DSVFormat = TexFormatToDXGI_Format(GraphicsPipeline.DSVFormat);
 
-            d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
-            d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
+        d3d12PSODesc.SampleDesc->Count   = GraphicsPipeline.SmplDesc.Count;
+        d3d12PSODesc.SampleDesc->Quality = GraphicsPipeline.SmplDesc.Quality;
 
-            // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-            // set bits to identify the nodes (the device's physical adapters) for which the
-            // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-            d3d12PSODesc.NodeMask = 0;
+        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+        // set bits to identify the nodes (the device's physical adapters) for which the
+        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+        d3d12PSODesc.NodeMask = 0;
 
-            d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
-            d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
+        d3d12PSODesc.CachedPSO->pCachedBlob           = nullptr;
+        d3d12PSODesc.CachedPSO->CachedBlobSizeInBytes = 0;
 
-            // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-            d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-            D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
-            streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
-            streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
+        D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+        streamDesc.SizeInBytes                   = sizeof(d3d12PSODesc);
+        streamDesc.pPipelineStateSubobjectStream = &d3d12PSODesc;
 
-            auto*   device2 = pDeviceD3D12->GetD3D12Device2();
-            HRESULT hr      = device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&m_pd3d12PSO));
-            if (FAILED(hr))
-                LOG_ERROR_AND_THROW("Failed to create pipeline state");
-        }
+        auto*   device2 = GetDevice()->GetD3D12Device2();
+        HRESULT hr      = device2->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&m_pd3d12PSO));
+        if (FAILED(hr))
+            LOG_ERROR_AND_THROW("Failed to create pipeline state");
+    }
 #endif // D3D12_H_HAS_MESH_SHADER
-        else
-        {
-            LOG_ERROR_AND_THROW("Unsupported pipeline type");
-        }
-
-        if (*m_Desc.Name != 0)
-        {
-            m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
-        }
+    else
+    {
+        LOG_ERROR_AND_THROW("Unsupported pipeline type");
     }
-    catch (...)
+
+    if (*m_Desc.Name != 0)
     {
-        Destruct();
-        throw;
+        m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
     }
 }
 
-PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*                   pRefCounters,
-                                               RenderDeviceD3D12Impl*                pDeviceD3D12,
-                                               const ComputePipelineStateCreateInfo& CreateInfo) :
-    TPipelineStateBase{pRefCounters, pDeviceD3D12, CreateInfo}
+void PipelineStateD3D12Impl::InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo)
 {
-    try
-    {
-        TShaderStages ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages);
+    TShaderStages ShaderStages;
+    InitInternalObjects(CreateInfo, ShaderStages);
 
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
+    auto* pd3d12Device = GetDevice()->GetD3D12Device();
 
-        D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
+    D3D12_COMPUTE_PIPELINE_STATE_DESC d3d12PSODesc = {};
 
-        VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
-        VERIFY_EXPR(ShaderStages[0].Count() == 1);
-        const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
-        d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
-        d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
+    VERIFY_EXPR(ShaderStages[0].Type == SHADER_TYPE_COMPUTE);
+    VERIFY_EXPR(ShaderStages[0].Count() == 1);
+    const auto& pByteCode           = ShaderStages[0].ByteCodes[0];
+    d3d12PSODesc.CS.pShaderBytecode = pByteCode->GetBufferPointer();
+    d3d12PSODesc.CS.BytecodeLength  = pByteCode->GetBufferSize();
 
-        // For single GPU operation, set this to zero. If there are multiple GPU nodes,
-        // set bits to identify the nodes (the device's physical adapters) for which the
-        // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
-        d3d12PSODesc.NodeMask = 0;
+    // For single GPU operation, set this to zero. If there are multiple GPU nodes,
+    // set bits to identify the nodes (the device's physical adapters) for which the
+    // graphics pipeline state is to apply. Each bit in the mask corresponds to a single node.
+    d3d12PSODesc.NodeMask = 0;
 
-        d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
-        d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
+    d3d12PSODesc.CachedPSO.pCachedBlob           = nullptr;
+    d3d12PSODesc.CachedPSO.CachedBlobSizeInBytes = 0;
 
-        // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
-        d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+    // The only valid bit is D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG, which can only be set on WARP devices.
+    d3d12PSODesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
 
-        d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
+    d3d12PSODesc.pRootSignature = m_RootSig->GetD3D12RootSignature();
 
+    auto* pPSOCacheD3D12 = ValidatedCast<PipelineStateCacheD3D12Impl>(CreateInfo.pPSOCache);
+
+    std::wstring LibraryKey;
+    if (pPSOCacheD3D12 != nullptr)
+    {
+        LibraryKey  = GetPipelineLibraryKey(d3d12PSODesc, *m_RootSig);
+        m_pd3d12PSO = pPSOCacheD3D12->LoadComputePipeline(LibraryKey.c_str(), d3d12PSODesc).p;
+    }
+
+    if (!m_pd3d12PSO)
+    {
         HRESULT hr = pd3d12Device->CreateComputePipelineState(&d3d12PSODesc, IID_PPV_ARGS(&m_pd3d12PSO));
         if (FAILED(hr))
             LOG_ERROR_AND_THROW("Failed to create pipeline state");
 
-        if (*m_Desc.Name != 0)
-        {
-            m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
-        }
+        if (pPSOCacheD3D12 != nullptr)
+            pPSOCacheD3D12->StorePipeline(LibraryKey.c_str(), static_cast<ID3D12PipelineState*>(m_pd3d12PSO.p));
+    }
+
+    if (*m_Desc.Name != 0)
+    {
+        m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
+    }
+}
+
+void PipelineStateD3D12Impl::InitializeRayTracingPipeline(const RayTracingPipelineStateCreateInfo& CreateInfo)
+{
+    LocalRootSignatureD3D12 LocalRootSig{CreateInfo.pShaderRecordName, CreateInfo.RayTracingPipeline.ShaderRecordSize};
+    TShaderStages           ShaderStages;
+    InitInternalObjects(CreateInfo, ShaderStages, &LocalRootSig);
+
+    auto* pd3d12Device = GetDevice()->GetD3D12Device5();
+
+    DynamicLinearAllocator             TempPool{GetRawAllocator(), 4 << 10};
+    std::vector<D3D12_STATE_SUBOBJECT> Subobjects;
+    BuildRTPipelineDescription(CreateInfo, Subobjects, TempPool, ShaderStages);
+
+    D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
+    Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
+
+    D3D12_LOCAL_ROOT_SIGNATURE LocalRoot = {LocalRootSig.GetD3D12RootSignature()};
+    if (LocalRoot.pLocalRootSignature)
+        Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_LOCAL_ROOT_SIGNATURE, &LocalRoot});
+
+    D3D12_STATE_OBJECT_DESC RTPipelineDesc = {};
+    RTPipelineDesc.Type                    = D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE;
+    RTPipelineDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
+    RTPipelineDesc.pSubobjects             = Subobjects.data();
+
+    HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, IID_PPV_ARGS(&m_pd3d12PSO));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
+
+    // Extract shader identifiers from ray tracing pipeline and store them in ShaderHandles
+    GetShaderIdentifiers(m_pd3d12PSO, CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex,
+                         m_pRayTracingPipelineData->ShaderHandles, m_pRayTracingPipelineData->ShaderHandleSize);
+
+    if (*m_Desc.Name != 0)
+    {
+        m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
+    }
+}
+
+PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*                    pRefCounters,
+                                               RenderDeviceD3D12Impl*                 pDeviceD3D12,
+                                               const GraphicsPipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pDeviceD3D12, CreateInfo}
+{
+    try
+    {
+        InitializePipeline(CreateInfo, [this](const GraphicsPipelineStateCreateInfo& PSOCreateInfo) { InitializeGraphicsPipeline(PSOCreateInfo); });
+    }
+    catch (...)
+    {
+        Destruct();
+        throw;
+    }
+}
+
+PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*                   pRefCounters,
+                                               RenderDeviceD3D12Impl*                pDeviceD3D12,
+                                               const ComputePipelineStateCreateInfo& CreateInfo) :
+    TPipelineStateBase{pRefCounters, pDeviceD3D12, CreateInfo}
+{
+    try
+    {
+        InitializePipeline(CreateInfo, [this](const ComputePipelineStateCreateInfo& PSOCreateInfo) { InitializeComputePipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -882,40 +1064,7 @@ PipelineStateD3D12Impl::PipelineStateD3D12Impl(IReferenceCounters*
 {
     try
     {
-        LocalRootSignatureD3D12 LocalRootSig{CreateInfo.pShaderRecordName, CreateInfo.RayTracingPipeline.ShaderRecordSize};
-        TShaderStages           ShaderStages;
-        InitInternalObjects(CreateInfo, ShaderStages, &LocalRootSig);
-
-        auto* pd3d12Device = pDeviceD3D12->GetD3D12Device5();
-
-        DynamicLinearAllocator             TempPool{GetRawAllocator(), 4 << 10};
-        std::vector<D3D12_STATE_SUBOBJECT> Subobjects;
-        BuildRTPipelineDescription(CreateInfo, Subobjects, TempPool, ShaderStages);
-
-        D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
-        Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
-
-        D3D12_LOCAL_ROOT_SIGNATURE LocalRoot = {LocalRootSig.GetD3D12RootSignature()};
-        if (LocalRoot.pLocalRootSignature)
-            Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_LOCAL_ROOT_SIGNATURE, &LocalRoot});
-
-        D3D12_STATE_OBJECT_DESC RTPipelineDesc = {};
-        RTPipelineDesc.Type                    = D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE;
-        RTPipelineDesc.NumSubobjects           = static_cast<UINT>(Subobjects.size());
-        RTPipelineDesc.pSubobjects             = Subobjects.data();
-
-        HRESULT hr = pd3d12Device->CreateStateObject(&RTPipelineDesc, IID_PPV_ARGS(&m_pd3d12PSO));
-        if (FAILED(hr))
-            LOG_ERROR_AND_THROW("Failed to create ray tracing state object");
-
-        // Extract shader identifiers from ray tracing pipeline and store them in ShaderHandles
-        GetShaderIdentifiers(m_pd3d12PSO, CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex,
-                             m_pRayTracingPipelineData->ShaderHandles, m_pRayTracingPipelineData->ShaderHandleSize);
-
-        if (*m_Desc.Name != 0)
-        {
-            m_pd3d12PSO->SetName(WidenString(m_Desc.Name).c_str());
-        }
+        InitializePipeline(CreateInfo, [this](const RayTracingPipelineStateCreateInfo& PSOCreateInfo) { InitializeRayTracingPipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -929,6 +1078,21 @@ PipelineStateD3D12Impl::~PipelineStateD3D12Impl()
     Destruct();
 }
 
+void PipelineStateD3D12Impl::SwapShaderObjects(PipelineStateD3D12Impl& Other)
+{
+    // Keep the D3D12 pipeline together with the root signature it was created with.
+    // Root signatures of pipelines with compatible resource signatures are identical.
+    std::swap(m_pd3d12PSO, Other.m_pd3d12PSO);
+    std::swap(m_RootSig, Other.m_RootSig);
+
+#ifdef DILIGENT_DEVELOPMENT
+    std::swap(m_ShaderResources, Other.m_ShaderResources);
+    std::swap(m_ResourceAttibutions, Other.m_ResourceAttibutions);
+    DvpRemapResourceAttributions(m_ResourceAttibutions);
+    Other.DvpRemapResourceAttributions(Other.m_ResourceAttibutions);
+#endif
+}
+
 void PipelineStateD3D12Impl::Destruct()
 {
     m_RootSig.Release();
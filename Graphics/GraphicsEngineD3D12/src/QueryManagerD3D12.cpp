@@ -65,8 +65,11 @@ static Uint32 GetQueryDataSize(QUERY_TYPE QueryType)
 }
 
 QueryManagerD3D12::QueryManagerD3D12(ID3D12Device* pd3d12Device,
-                                     const Uint32  QueryHeapSizes[])
+                                     const Uint32  QueryHeapSizes[]) :
+    m_pd3d12Device{pd3d12Device}
 {
+    // Query heaps and the resolve buffer are created when the first query is allocated,
+    // see AllocateQuery(). Only the heap slots and resolve buffer offsets are set up here.
     Uint32 ResolveBufferOffset = 0;
     for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
     {
@@ -80,20 +83,13 @@ QueryManagerD3D12::QueryManagerD3D12(ID3D12Device* pd3d12Device,
         // clang-format on
         auto& HeapInfo = m_Heaps[QueryType];
 
-        D3D12_QUERY_HEAP_DESC d3d12HeapDesc = {};
-
-        HeapInfo.HeapSize   = QueryHeapSizes[QueryType];
-        d3d12HeapDesc.Type  = QueryTypeToD3D12QueryHeapType(static_cast<QUERY_TYPE>(QueryType));
-        d3d12HeapDesc.Count = HeapInfo.HeapSize;
-        if (QueryType == QUERY_TYPE_DURATION)
-            d3d12HeapDesc.Count *= 2;
-
-        auto hr = pd3d12Device->CreateQueryHeap(&d3d12HeapDesc, __uuidof(HeapInfo.pd3d12QueryHeap), reinterpret_cast<void**>(&HeapInfo.pd3d12QueryHeap));
-        CHECK_D3D_RESULT_THROW(hr, "Failed to create D3D12 query heap of type");
+        HeapInfo.HeapSize = QueryHeapSizes[QueryType];
 
         // AlignedDestinationBufferOffset must be a multiple of 8 bytes.
         // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
         Uint32 AlignedQueryDataSize = AlignUp(GetQueryDataSize(static_cast<QUERY_TYPE>(QueryType)), Uint32{8});
+        // ResolveQueries() relies on the data of consecutive queries being tightly packed
+        VERIFY(AlignedQueryDataSize == GetQueryDataSize(static_cast<QUERY_TYPE>(QueryType)), "Query data size must be a multiple of 8");
         HeapInfo.AvailableQueries.resize(HeapInfo.HeapSize);
         HeapInfo.ResolveBufferOffsets.resize(HeapInfo.HeapSize);
         for (Uint32 i = 0; i < HeapInfo.HeapSize; ++i)
@@ -104,10 +100,33 @@ QueryManagerD3D12::QueryManagerD3D12(ID3D12Device* pd3d12Device,
         }
     }
 
+    m_ResolveBufferSize = ResolveBufferOffset;
+}
+
+void QueryManagerD3D12::CreateQueryHeap(QUERY_TYPE Type)
+{
+    auto& HeapInfo = m_Heaps[Type];
+    VERIFY_EXPR(!HeapInfo.pd3d12QueryHeap);
+
+    D3D12_QUERY_HEAP_DESC d3d12HeapDesc = {};
+
+    d3d12HeapDesc.Type  = QueryTypeToD3D12QueryHeapType(Type);
+    d3d12HeapDesc.Count = HeapInfo.HeapSize;
+    if (Type == QUERY_TYPE_DURATION)
+        d3d12HeapDesc.Count *= 2;
+
+    auto hr = m_pd3d12Device->CreateQueryHeap(&d3d12HeapDesc, __uuidof(HeapInfo.pd3d12QueryHeap), reinterpret_cast<void**>(&HeapInfo.pd3d12QueryHeap));
+    CHECK_D3D_RESULT_THROW_EX(hr, "Failed to create D3D12 query heap of type ", GetQueryTypeString(Type));
+}
+
+void QueryManagerD3D12::CreateResolveBuffer()
+{
+    VERIFY_EXPR(!m_pd3d12ResolveBuffer);
+
     D3D12_RESOURCE_DESC D3D12BuffDesc = {};
     D3D12BuffDesc.Dimension           = D3D12_RESOURCE_DIMENSION_BUFFER;
     D3D12BuffDesc.Alignment           = 0;
-    D3D12BuffDesc.Width               = ResolveBufferOffset;
+    D3D12BuffDesc.Width               = m_ResolveBufferSize;
     D3D12BuffDesc.Height              = 1;
     D3D12BuffDesc.DepthOrArraySize    = 1;
     D3D12BuffDesc.MipLevels           = 1;
@@ -129,22 +148,40 @@ QueryManagerD3D12::QueryManagerD3D12(ID3D12Device* pd3d12Device,
     // The destination buffer of a query resolve operation must be in the D3D12_RESOURCE_USAGE_COPY_DEST state.
     // ResolveQueryData works with all heap types (default, upload, readback).
     // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
-    auto hr = pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE,
-                                                    &D3D12BuffDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
-                                                    __uuidof(m_pd3d12ResolveBuffer),
-                                                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12ResolveBuffer)));
+    auto hr = m_pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE,
+                                                      &D3D12BuffDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                      __uuidof(m_pd3d12ResolveBuffer),
+                                                      reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12ResolveBuffer)));
     if (FAILED(hr))
         LOG_ERROR_AND_THROW("Failed to create D3D12 resolve buffer");
+
+    // Readback heaps may stay mapped while the GPU writes to them. The data is only read
+    // after the fence that follows the resolve command has completed.
+    void* pBufferData = nullptr;
+    hr                = m_pd3d12ResolveBuffer->Map(0, nullptr, &pBufferData);
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to map D3D12 resolve buffer");
+    m_pResolveBufferData = static_cast<const Uint8*>(pBufferData);
 }
 
 QueryManagerD3D12::~QueryManagerD3D12()
 {
+    if (m_pd3d12ResolveBuffer)
+    {
+        // An empty written range indicates that the CPU did not write any data
+        D3D12_RANGE WrittenRange{0, 0};
+        m_pd3d12ResolveBuffer->Unmap(0, &WrittenRange);
+    }
+
     std::stringstream QueryUsageSS;
     QueryUsageSS << "D3D12 query manager peak usage:";
 
     for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
     {
         auto& HeapInfo = m_Heaps[QueryType];
+        if (!HeapInfo.pd3d12QueryHeap)
+            continue;
+
         if (HeapInfo.AvailableQueries.size() != HeapInfo.HeapSize)
         {
             auto OutstandingQueries = HeapInfo.HeapSize - HeapInfo.AvailableQueries.size();
@@ -177,6 +214,11 @@ Uint32 QueryManagerD3D12::AllocateQuery(QUERY_TYPE Type)
     auto&  AvailableQueries = HeapInfo.AvailableQueries;
     if (!AvailableQueries.empty())
     {
+        if (!m_pd3d12ResolveBuffer)
+            CreateResolveBuffer();
+        if (!HeapInfo.pd3d12QueryHeap)
+            CreateQueryHeap(Type);
+
         Index = AvailableQueries.front();
         AvailableQueries.pop_front();
         HeapInfo.MaxAllocatedQueries = std::max(HeapInfo.MaxAllocatedQueries, HeapInfo.HeapSize - static_cast<Uint32>(AvailableQueries.size()));
@@ -212,8 +254,36 @@ void QueryManagerD3D12::EndQuery(CommandContext& Ctx, QUERY_TYPE Type, Uint32 In
     auto& HeapInfo       = m_Heaps[Type];
     Ctx.EndQuery(HeapInfo.pd3d12QueryHeap, d3d12QueryType, Index);
 
-    // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
-    Ctx.ResolveQueryData(HeapInfo.pd3d12QueryHeap, d3d12QueryType, Index, 1, m_pd3d12ResolveBuffer, HeapInfo.ResolveBufferOffsets[Index]);
+    // The query data is resolved together with all other queries when the command list is closed
+    Ctx.AddPendingQueryResolve(*this, Type, Index);
+}
+
+void QueryManagerD3D12::ResolveQueries(CommandContext& Ctx, std::vector<std::pair<QUERY_TYPE, Uint32>>& Queries) const
+{
+    // Sort the queries by type and heap index so that runs of consecutive heap slots can be
+    // resolved with a single command. Resolve buffer offsets of consecutive slots of the same
+    // type are also consecutive, with the stride equal to the query data size.
+    std::sort(Queries.begin(), Queries.end());
+
+    size_t i = 0;
+    while (i < Queries.size())
+    {
+        const auto   Type       = Queries[i].first;
+        const Uint32 StartIndex = Queries[i].second;
+        Uint32       NumQueries = 1;
+        // Skip duplicates, e.g. when the same query was ended several times in the command list
+        for (++i; i < Queries.size() && Queries[i].first == Type && Queries[i].second <= StartIndex + NumQueries; ++i)
+        {
+            if (Queries[i].second == StartIndex + NumQueries)
+                ++NumQueries;
+        }
+
+        const auto& HeapInfo = m_Heaps[Type];
+        VERIFY_EXPR(StartIndex + NumQueries <= HeapInfo.HeapSize);
+        // https://microsoft.github.io/DirectX-Specs/d3d/CountersAndQueries.html#resolvequerydata
+        Ctx.ResolveQueryData(HeapInfo.pd3d12QueryHeap, QueryTypeToD3D12QueryType(Type), StartIndex, NumQueries,
+                             m_pd3d12ResolveBuffer, HeapInfo.ResolveBufferOffsets[StartIndex]);
+    }
 }
 
 void QueryManagerD3D12::ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pDataPtr, Uint32 DataSize) const
@@ -221,16 +291,25 @@ void QueryManagerD3D12::ReadQueryData(QUERY_TYPE Type, Uint32 Index, void* pData
     auto& HeapInfo      = m_Heaps[Type];
     auto  QueryDataSize = GetQueryDataSize(Type);
     VERIFY_EXPR(QueryDataSize == DataSize);
-    auto        Offset = HeapInfo.ResolveBufferOffsets[Index];
-    D3D12_RANGE ReadRange;
-    ReadRange.Begin = Offset;
-    ReadRange.End   = Offset + QueryDataSize;
+    auto Offset = HeapInfo.ResolveBufferOffsets[Index];
+    memcpy(pDataPtr, m_pResolveBufferData + Offset, QueryDataSize);
+}
 
-    void* pBufferData = nullptr;
-    // The pointer returned by Map is never offset by any values in pReadRange.
-    m_pd3d12ResolveBuffer->Map(0, &ReadRange, &pBufferData);
-    memcpy(pDataPtr, reinterpret_cast<const Uint8*>(pBufferData) + Offset, QueryDataSize);
-    m_pd3d12ResolveBuffer->Unmap(0, nullptr);
+void QueryManagerD3D12::GetStatistics(DeviceHelperStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock(m_HeapMutex);
+
+    for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
+    {
+        const auto& HeapInfo = m_Heaps[QueryType];
+        if (!HeapInfo.pd3d12QueryHeap)
+            continue;
+
+        ++Stats.NumQueryHeaps;
+        Stats.NumQueries += HeapInfo.HeapSize * (QueryType == QUERY_TYPE_DURATION ? 2 : 1);
+    }
+    if (m_pd3d12ResolveBuffer)
+        Stats.QueryResolveBufferSize += m_ResolveBufferSize;
 }
 
 } // namespace Diligent
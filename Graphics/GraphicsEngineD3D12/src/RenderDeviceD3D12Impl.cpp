@@ -47,6 +47,8 @@
 #include "TopLevelASD3D12Impl.hpp"
 #include "ShaderBindingTableD3D12Impl.hpp"
 #include "PipelineResourceSignatureD3D12Impl.hpp"
+#include "PipelineStateCacheD3D12Impl.hpp"
+#include "ResourceHeapD3D12Impl.hpp"
 
 #include "EngineMemory.h"
 #include "D3D12TypeConversions.hpp"
@@ -102,10 +104,10 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
     },
     m_CPUDescriptorHeaps
     {
-        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[0], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE},
-        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[1], D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_NONE},
-        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[2], D3D12_DESCRIPTOR_HEAP_TYPE_RTV,         D3D12_DESCRIPTOR_HEAP_FLAG_NONE},
-        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[3], D3D12_DESCRIPTOR_HEAP_TYPE_DSV,         D3D12_DESCRIPTOR_HEAP_FLAG_NONE}
+        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[0], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE, EngineCI.CPUDescriptorThreadCacheSize},
+        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[1], D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_NONE, EngineCI.CPUDescriptorThreadCacheSize},
+        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[2], D3D12_DESCRIPTOR_HEAP_TYPE_RTV,         D3D12_DESCRIPTOR_HEAP_FLAG_NONE, EngineCI.CPUDescriptorThreadCacheSize},
+        {RawMemAllocator, *this, EngineCI.CPUDescriptorHeapAllocationSize[3], D3D12_DESCRIPTOR_HEAP_TYPE_DSV,         D3D12_DESCRIPTOR_HEAP_FLAG_NONE, EngineCI.CPUDescriptorThreadCacheSize}
     },
     m_GPUDescriptorHeaps
     {
@@ -113,8 +115,10 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
         {RawMemAllocator, *this, EngineCI.GPUDescriptorHeapSize[1], EngineCI.GPUDescriptorHeapDynamicSize[1], D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE}
     },
     m_ContextPool           (STD_ALLOCATOR_RAW_MEM(PooledCommandContext, GetRawAllocator(), "Allocator for vector<PooledCommandContext>")),
-    m_DynamicMemoryManager  {GetRawAllocator(), *this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
-    m_MipsGenerator         {pd3d12Device},
+    m_DynamicMemoryManager  {*this, EngineCI.NumDynamicHeapPagesToReserve, EngineCI.DynamicHeapPageSize},
+    m_ResidencyMgr          {*this, pd3d12Device, EngineCI},
+    m_PlacedResourceMgr     {GetRawAllocator(), pd3d12Device, m_ResidencyMgr, EngineCI.PlacedResourceHeapPageSize, EngineCI.PlacedResourceHeapReserveSize},
+    m_MipsGenerator         {std::max(1u, EngineCI.NumImmediateContexts) + EngineCI.NumDeferredContexts},
     m_QueryMgr              {pd3d12Device, EngineCI.QueryPoolSizes},
     m_pDxCompiler           {CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath)},
     m_RootSignatureAllocator{GetRawAllocator(), sizeof(RootSignatureD3D12), 128},
@@ -171,6 +175,22 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
             LOG_INFO_MESSAGE("Max device shader model: ", Uint32{m_MaxShaderVersion.Major}, '_', Uint32{m_MaxShaderVersion.Minor} & 0xF);
         }
 
+        if (EngineCI.BindlessHeapSize > 0)
+        {
+            auto& GPUHeap = m_GPUDescriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV];
+            if (EngineCI.BindlessHeapSize > GPUHeap.GetMaxStaticDescriptors())
+            {
+                LOG_ERROR_AND_THROW("Bindless heap size (", EngineCI.BindlessHeapSize, ") exceeds the number of static descriptors (",
+                                    GPUHeap.GetMaxStaticDescriptors(), ") in the GPU CBV/SRV/UAV descriptor heap.");
+            }
+
+            m_BindlessHeap = GPUHeap.Allocate(EngineCI.BindlessHeapSize);
+            if (m_BindlessHeap.IsNull())
+                LOG_ERROR_AND_THROW("Failed to allocate ", EngineCI.BindlessHeapSize, " descriptors for the bindless heap.");
+
+            m_pBindlessIndexAllocator = std::make_unique<BindlessIndexAllocator>(EngineCI.BindlessHeapSize);
+        }
+
 #ifdef DILIGENT_DEVELOPMENT
 #    define CHECK_D3D12_DEVICE_VERSION(Version)               \
         if (CComQIPtr<ID3D12Device##Version>{m_pd3d12Device}) \
@@ -192,6 +212,26 @@ RenderDeviceD3D12Impl::RenderDeviceD3D12Impl(IReferenceCounters*          pRefCo
     }
 }
 
+void RenderDeviceD3D12Impl::GetResourceNodeMasks(Uint64 ImmediateContextMask, UINT& CreationNodeMask, UINT& VisibleNodeMask) const
+{
+    CreationNodeMask = 1;
+    VisibleNodeMask  = 1;
+
+    const auto NumNodes = m_DeviceInfo.NumNodes;
+    if (NumNodes <= 1)
+        return;
+
+    VisibleNodeMask = NumNodes < 32 ? (1u << NumNodes) - 1u : ~0u;
+
+    ImmediateContextMask &= GetCommandQueueMask();
+    if (ImmediateContextMask != 0)
+    {
+        const auto QueueNodeMask = GetCommandQueue(SoftwareQueueIndex{PlatformMisc::GetLSB(ImmediateContextMask)}).GetD3D12CommandQueueDesc().NodeMask;
+        if (QueueNodeMask != 0)
+            CreationNodeMask = QueueNodeMask;
+    }
+}
+
 CommandListManager& RenderDeviceD3D12Impl::GetCmdListManager(SoftwareQueueIndex CommandQueueId)
 {
     return GetCmdListManager(GetCommandQueueType(CommandQueueId));
@@ -204,6 +244,11 @@ CommandListManager& RenderDeviceD3D12Impl::GetCmdListManager(D3D12_COMMAND_LIST_
 
 RenderDeviceD3D12Impl::~RenderDeviceD3D12Impl()
 {
+    // Move the bindless range into the release queue
+    {
+        auto BindlessHeap = std::move(m_BindlessHeap);
+    }
+
     // Wait for the GPU to complete all its operations
     IdleGPU();
     ReleaseStaleResources(true);
@@ -230,6 +275,32 @@ RenderDeviceD3D12Impl::~RenderDeviceD3D12Impl()
     DestroyCommandQueues();
 }
 
+Uint32 RenderDeviceD3D12Impl::AddBindlessDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE CPUHandle)
+{
+    if (!m_pBindlessIndexAllocator)
+        return INVALID_BINDLESS_INDEX;
+
+    const auto Index = m_pBindlessIndexAllocator->Allocate();
+    if (Index == INVALID_BINDLESS_INDEX)
+    {
+        LOG_ERROR_MESSAGE("Bindless descriptor heap is full: all ", m_pBindlessIndexAllocator->GetCapacity(),
+                          " descriptors are in use. Increase EngineD3D12CreateInfo::BindlessHeapSize.");
+        return INVALID_BINDLESS_INDEX;
+    }
+
+    m_pd3d12Device->CopyDescriptorsSimple(1, m_BindlessHeap.GetCpuHandle(Index), CPUHandle, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    return Index;
+}
+
+void RenderDeviceD3D12Impl::RemoveBindlessDescriptor(Uint32 Index, Uint64 CmdQueueMask)
+{
+    if (Index == INVALID_BINDLESS_INDEX)
+        return;
+
+    VERIFY_EXPR(m_pBindlessIndexAllocator);
+    SafeReleaseDeviceObject(BindlessIndexAllocator::StaleIndex{*m_pBindlessIndexAllocator, Index}, CmdQueueMask);
+}
+
 void RenderDeviceD3D12Impl::DisposeCommandContext(PooledCommandContext&& Ctx)
 {
     CComPtr<ID3D12CommandAllocator> pAllocator;
@@ -241,6 +312,17 @@ void RenderDeviceD3D12Impl::DisposeCommandContext(PooledCommandContext&& Ctx)
     FreeCommandContext(std::move(Ctx));
 }
 
+void RenderDeviceD3D12Impl::ReleaseReusableCommandContext(PooledCommandContext&&            Ctx,
+                                                          CComPtr<ID3D12CommandAllocator>&& pAllocator,
+                                                          SoftwareQueueIndex                CommandQueueId,
+                                                          Uint64                            FenceValue)
+{
+    auto& CmdListMngr = GetCmdListManager(CommandQueueId);
+    VERIFY_EXPR(CmdListMngr.GetCommandListType() == Ctx->GetCommandListType());
+    CmdListMngr.ReleaseAllocator(std::move(pAllocator), CommandQueueId, FenceValue);
+    FreeCommandContext(std::move(Ctx));
+}
+
 void RenderDeviceD3D12Impl::FreeCommandContext(PooledCommandContext&& Ctx)
 {
     std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
@@ -252,12 +334,20 @@ void RenderDeviceD3D12Impl::FreeCommandContext(PooledCommandContext&& Ctx)
 
 void RenderDeviceD3D12Impl::CloseAndExecuteTransientCommandContext(SoftwareQueueIndex CommandQueueId, PooledCommandContext&& Ctx)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CloseAndExecuteTransientCommandContext");
+
     auto& CmdListMngr = GetCmdListManager(CommandQueueId);
     VERIFY_EXPR(CmdListMngr.GetCommandListType() == Ctx->GetCommandListType());
 
     CComPtr<ID3D12CommandAllocator> pAllocator;
     ID3D12CommandList* const        pCmdList = Ctx->Close(pAllocator);
     VERIFY(pCmdList != nullptr, "Command list must not be null");
+    if (m_ResidencyMgr.IsEnabled())
+    {
+        // The resource being initialized may be placed in a heap page that has been evicted
+        const CommandContext* pCtx = Ctx.get();
+        m_ResidencyMgr.MakeResident(1, &pCtx);
+    }
     Uint64 FenceValue = 0;
     // Execute command list directly through the queue to avoid interference with command list numbers in the queue
     LockCmdQueueAndRun(CommandQueueId,
@@ -274,8 +364,11 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
                                                              PooledCommandContext                                   pContexts[],
                                                              bool                                                   DiscardStaleObjects,
                                                              std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pSignalFences,
-                                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences)
+                                                             std::vector<std::pair<Uint64, RefCntAutoPtr<IFence>>>* pWaitFences,
+                                                             ID3D12CommandList* const*                              ppReusableCmdLists)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CloseAndExecuteCommandContexts");
+
     VERIFY_EXPR(NumContexts > 0 && pContexts != 0);
 
     // TODO: use small_vector
@@ -288,7 +381,14 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
         auto& pCtx = pContexts[i];
-        VERIFY_EXPR(pCtx);
+        if (!pCtx)
+        {
+            // Reusable command lists are already closed and are owned by the caller
+            VERIFY(ppReusableCmdLists != nullptr && ppReusableCmdLists[i] != nullptr, "Null context must correspond to a reusable command list");
+            d3d12CmdLists.emplace_back(ppReusableCmdLists[i]);
+            CmdAllocators.emplace_back();
+            continue;
+        }
         VERIFY_EXPR(CmdListMngr.GetCommandListType() == pCtx->GetCommandListType());
         CComPtr<ID3D12CommandAllocator> pAllocator;
         d3d12CmdLists.emplace_back(pCtx->Close(pAllocator));
@@ -325,6 +425,8 @@ Uint64 RenderDeviceD3D12Impl::CloseAndExecuteCommandContexts(SoftwareQueueIndex
 
     for (Uint32 i = 0; i < NumContexts; ++i)
     {
+        if (!pContexts[i])
+            continue;
         CmdListMngr.ReleaseAllocator(std::move(CmdAllocators[i]), CommandQueueId, FenceValue);
         FreeCommandContext(std::move(pContexts[i]));
     }
@@ -360,6 +462,8 @@ void RenderDeviceD3D12Impl::WaitFences(SoftwareQueueIndex CommandQueueId, std::v
 
 void RenderDeviceD3D12Impl::IdleGPU()
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::IdleGPU");
+
     IdleAllCommandQueues(true);
     ReleaseStaleResources();
 }
@@ -373,19 +477,31 @@ void RenderDeviceD3D12Impl::FlushStaleResources(SoftwareQueueIndex CommandQueueI
 
 void RenderDeviceD3D12Impl::ReleaseStaleResources(bool ForceRelease)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::ReleaseStaleResources");
+
     PurgeReleaseQueues(ForceRelease);
+    // Release the pages that have become empty when the stale resources were released
+    m_PlacedResourceMgr.ShrinkMemory();
+    m_ResidencyMgr.EndFrame();
 }
 
 
 RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateCommandContext(SoftwareQueueIndex CommandQueueId, const Char* ID)
 {
     auto& CmdListMngr = GetCmdListManager(CommandQueueId);
+    // Command lists must be created for the node of the queue they are executed on
+    const auto NodeMask = GetCommandQueue(CommandQueueId).GetD3D12CommandQueueDesc().NodeMask;
     {
         std::lock_guard<std::mutex> LockGuard(m_ContextPoolMutex);
-        if (!m_ContextPool.empty())
+
+        auto ctx_it = m_ContextPool.rbegin();
+        while (ctx_it != m_ContextPool.rend() && (*ctx_it)->GetNodeMask() != NodeMask)
+            ++ctx_it;
+
+        if (ctx_it != m_ContextPool.rend())
         {
-            PooledCommandContext Ctx = std::move(m_ContextPool.back());
-            m_ContextPool.pop_back();
+            PooledCommandContext Ctx = std::move(*ctx_it);
+            m_ContextPool.erase(std::next(ctx_it).base());
             Ctx->Reset(CmdListMngr);
             Ctx->SetID(ID);
 #ifdef DILIGENT_DEVELOPMENT
@@ -397,7 +513,7 @@ RenderDeviceD3D12Impl::PooledCommandContext RenderDeviceD3D12Impl::AllocateComma
 
     auto& CmdCtxAllocator = GetRawAllocator();
     auto* pRawMem         = ALLOCATE(CmdCtxAllocator, "CommandContext instance", CommandContext, 1);
-    auto  pCtx            = new (pRawMem) CommandContext(CmdListMngr);
+    auto  pCtx            = new (pRawMem) CommandContext(CmdListMngr, NodeMask);
     pCtx->SetID(ID);
 #ifdef DILIGENT_DEVELOPMENT
     m_AllocatedCtxCounter.fetch_add(1);
@@ -456,16 +572,22 @@ void RenderDeviceD3D12Impl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 
 void RenderDeviceD3D12Impl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CreateGraphicsPipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceD3D12Impl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CreateComputePipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceD3D12Impl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CreateRayTracingPipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
@@ -482,6 +604,8 @@ void RenderDeviceD3D12Impl::CreateBuffer(const BufferDesc& BuffDesc, const Buffe
 
 void RenderDeviceD3D12Impl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CreateShader");
+
     CreateShaderImpl(ppShader, ShaderCI);
 }
 
@@ -579,21 +703,53 @@ void RenderDeviceD3D12Impl::CreatePipelineResourceSignature(const PipelineResour
     CreatePipelineResourceSignatureImpl(ppSignature, Desc, IsDeviceInternal);
 }
 
+void RenderDeviceD3D12Impl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                     IPipelineStateCache**               ppPSOCache)
+{
+    CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
+}
+
+void RenderDeviceD3D12Impl::CreateResourceHeap(const ResourceHeapDesc& Desc,
+                                               IResourceHeap**         ppHeap)
+{
+    CreateResourceHeapImpl(ppHeap, Desc);
+}
+
+void RenderDeviceD3D12Impl::CreatePlacedTexture(const TextureDesc& TexDesc, ResourceHeapD3D12Impl* pHeap, Uint64 Offset, ITexture** ppTexture)
+{
+    CreateTextureImpl(ppTexture, TexDesc, static_cast<const TextureData*>(nullptr), pHeap, Offset);
+}
+
+void RenderDeviceD3D12Impl::CreatePlacedBuffer(const BufferDesc& BuffDesc, ResourceHeapD3D12Impl* pHeap, Uint64 Offset, IBuffer** ppBuffer)
+{
+    CreateBufferImpl(ppBuffer, BuffDesc, static_cast<const BufferData*>(nullptr), pHeap, Offset);
+}
+
 DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count /*= 1*/)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::AllocateDescriptors");
+
     VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type < D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES, "Invalid heap type");
     return m_CPUDescriptorHeaps[Type].Allocate(Count);
 }
 
 DescriptorHeapAllocation RenderDeviceD3D12Impl::AllocateGPUDescriptors(D3D12_DESCRIPTOR_HEAP_TYPE Type, UINT Count /*= 1*/)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::AllocateGPUDescriptors");
+
     VERIFY(Type >= D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV && Type <= D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, "Invalid heap type");
     return m_GPUDescriptorHeaps[Type].Allocate(Count);
 }
 
-void RenderDeviceD3D12Impl::CreateRootSignature(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount, size_t Hash, RootSignatureD3D12** ppRootSig)
+void RenderDeviceD3D12Impl::CreateRootSignature(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                Uint32                                                   SignatureCount,
+                                                size_t                                                   Hash,
+                                                PipelineStateCacheD3D12Impl*                             pPSOCache,
+                                                RootSignatureD3D12**                                     ppRootSig)
 {
-    RootSignatureD3D12* pRootSigD3D12{NEW_RC_OBJ(m_RootSignatureAllocator, "RootSignatureD3D12 instance", RootSignatureD3D12)(this, ppSignatures, SignatureCount, Hash)};
+    DILIGENT_PROFILE_SCOPE("RenderDeviceD3D12::CreateRootSignature");
+
+    RootSignatureD3D12* pRootSigD3D12{NEW_RC_OBJ(m_RootSignatureAllocator, "RootSignatureD3D12 instance", RootSignatureD3D12)(this, ppSignatures, SignatureCount, Hash, pPSOCache)};
     pRootSigD3D12->AddRef();
     *ppRootSig = pRootSigD3D12;
 }
@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "pch.h"
+
+#include "ResourceHeapD3D12Impl.hpp"
+#include "RenderDeviceD3D12Impl.hpp"
+#include "TextureD3D12Impl.hpp"
+#include "BufferD3D12Impl.hpp"
+#include "StringTools.hpp"
+
+namespace Diligent
+{
+
+ResourceHeapD3D12Impl::ResourceHeapD3D12Impl(IReferenceCounters*     pRefCounters,
+                                             RenderDeviceD3D12Impl*  pDeviceD3D12,
+                                             const ResourceHeapDesc& Desc) :
+    // clang-format off
+    TResourceHeapBase
+    {
+        pRefCounters,
+        pDeviceD3D12,
+        Desc
+    }
+// clang-format on
+{
+    auto* pd3d12Device = pDeviceD3D12->GetD3D12Device();
+
+    D3D12_FEATURE_DATA_D3D12_OPTIONS d3d12Options{};
+    if (FAILED(pd3d12Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &d3d12Options, sizeof(d3d12Options))))
+        d3d12Options.ResourceHeapTier = D3D12_RESOURCE_HEAP_TIER_1;
+
+    // Resource heap tier 1 requires that a heap only contains resources of a single category.
+    // Render targets and depth-stencil buffers are the most common transient resources, so these
+    // are the ones that are allowed in that case.
+    m_d3d12HeapFlags = d3d12Options.ResourceHeapTier >= D3D12_RESOURCE_HEAP_TIER_2 ?
+        D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES :
+        D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+    D3D12_HEAP_DESC d3d12HeapDesc{};
+    d3d12HeapDesc.SizeInBytes                     = m_Desc.Size;
+    d3d12HeapDesc.Properties.Type                 = D3D12_HEAP_TYPE_DEFAULT;
+    d3d12HeapDesc.Properties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    d3d12HeapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    d3d12HeapDesc.Properties.CreationNodeMask     = 1;
+    d3d12HeapDesc.Properties.VisibleNodeMask      = 1;
+    // Use the largest alignment so that multisampled textures can be placed in the heap
+    d3d12HeapDesc.Alignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+    d3d12HeapDesc.Flags     = m_d3d12HeapFlags;
+
+    auto hr = pd3d12Device->CreateHeap(&d3d12HeapDesc, __uuidof(m_pd3d12Heap), reinterpret_cast<void**>(static_cast<ID3D12Heap**>(&m_pd3d12Heap)));
+    if (FAILED(hr))
+        LOG_ERROR_AND_THROW("Failed to create D3D12 heap for resource heap '", m_Desc.Name, '\'');
+
+    if (*m_Desc.Name != 0)
+        m_pd3d12Heap->SetName(WidenString(m_Desc.Name).c_str());
+}
+
+ResourceHeapD3D12Impl::~ResourceHeapD3D12Impl()
+{
+    // D3D12 object can only be destroyed when it is no longer used by the GPU
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_pd3d12Heap), m_Desc.ImmediateContextMask);
+}
+
+ResourceAllocationInfo ResourceHeapD3D12Impl::GetTextureAllocationInfo(const TextureDesc& TexDesc) const
+{
+    const auto d3d12TexDesc   = TextureD3D12Impl::GetD3D12TextureDesc(TexDesc);
+    const auto d3d12AllocInfo = m_pDevice->GetD3D12Device()->GetResourceAllocationInfo(0, 1, &d3d12TexDesc);
+    return ResourceAllocationInfo{d3d12AllocInfo.SizeInBytes, d3d12AllocInfo.Alignment};
+}
+
+ResourceAllocationInfo ResourceHeapD3D12Impl::GetBufferAllocationInfo(const BufferDesc& BuffDesc) const
+{
+    const auto d3d12BuffDesc  = BufferD3D12Impl::GetD3D12BufferDesc(BuffDesc);
+    const auto d3d12AllocInfo = m_pDevice->GetD3D12Device()->GetResourceAllocationInfo(0, 1, &d3d12BuffDesc);
+    return ResourceAllocationInfo{d3d12AllocInfo.SizeInBytes, d3d12AllocInfo.Alignment};
+}
+
+void ResourceHeapD3D12Impl::CreateTexture(const TextureDesc& TexDesc, Uint64 Offset, ITexture** ppTexture)
+{
+    DEV_CHECK_ERR(ppTexture != nullptr, "Null pointer provided");
+    if (ppTexture == nullptr)
+        return;
+    *ppTexture = nullptr;
+
+    try
+    {
+        if (m_d3d12HeapFlags == D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES && (TexDesc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL)) == 0)
+        {
+            LOG_ERROR_AND_THROW("Failed to place texture '", (TexDesc.Name != nullptr ? TexDesc.Name : ""), "' in resource heap '", m_Desc.Name,
+                                "': this device only supports placing render targets and depth-stencil buffers in a heap (resource heap tier 1)");
+        }
+        ValidatePlacement("texture", TexDesc.Name, TexDesc.Usage, TexDesc.ImmediateContextMask, Offset, GetTextureAllocationInfo(TexDesc));
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    m_pDevice->CreatePlacedTexture(TexDesc, this, Offset, ppTexture);
+}
+
+void ResourceHeapD3D12Impl::CreateBuffer(const BufferDesc& BuffDesc, Uint64 Offset, IBuffer** ppBuffer)
+{
+    DEV_CHECK_ERR(ppBuffer != nullptr, "Null pointer provided");
+    if (ppBuffer == nullptr)
+        return;
+    *ppBuffer = nullptr;
+
+    try
+    {
+        if (m_d3d12HeapFlags == D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES)
+        {
+            LOG_ERROR_AND_THROW("Failed to place buffer '", (BuffDesc.Name != nullptr ? BuffDesc.Name : ""), "' in resource heap '", m_Desc.Name,
+                                "': this device only supports placing render targets and depth-stencil buffers in a heap (resource heap tier 1)");
+        }
+        ValidatePlacement("buffer", BuffDesc.Name, BuffDesc.Usage, BuffDesc.ImmediateContextMask, Offset, GetBufferAllocationInfo(BuffDesc));
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    m_pDevice->CreatePlacedBuffer(BuffDesc, this, Offset, ppBuffer);
+}
+
+} // namespace Diligent
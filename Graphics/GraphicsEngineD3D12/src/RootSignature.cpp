@@ -34,15 +34,65 @@
 #include "CommandContext.hpp"
 #include "D3D12TypeConversions.hpp"
 #include "HashUtils.hpp"
+#include "PipelineStateCacheD3D12Impl.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Writes the root signature description into a byte array that uniquely identifies it.
+// The key contains no pointers, so it is stable between runs and can be persisted
+// in the pipeline state cache together with the serialized root signature.
+std::vector<Uint8> GetRootSignatureDescKey(const D3D12_ROOT_SIGNATURE_DESC& Desc, D3D_ROOT_SIGNATURE_VERSION Version)
+{
+    std::vector<Uint8> Key;
+
+    const auto Append = [&Key](const void* pData, size_t Size) {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        Key.insert(Key.end(), pBytes, pBytes + Size);
+    };
+
+    Append(&Version, sizeof(Version));
+    Append(&Desc.Flags, sizeof(Desc.Flags));
+    Append(&Desc.NumParameters, sizeof(Desc.NumParameters));
+    for (UINT p = 0; p < Desc.NumParameters; ++p)
+    {
+        const auto& Param = Desc.pParameters[p];
+        Append(&Param.ParameterType, sizeof(Param.ParameterType));
+        Append(&Param.ShaderVisibility, sizeof(Param.ShaderVisibility));
+        switch (Param.ParameterType)
+        {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                Append(&Param.DescriptorTable.NumDescriptorRanges, sizeof(Param.DescriptorTable.NumDescriptorRanges));
+                Append(Param.DescriptorTable.pDescriptorRanges, sizeof(D3D12_DESCRIPTOR_RANGE) * Param.DescriptorTable.NumDescriptorRanges);
+                break;
+
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                Append(&Param.Constants, sizeof(Param.Constants));
+                break;
+
+            default:
+                Append(&Param.Descriptor, sizeof(Param.Descriptor));
+        }
+    }
+
+    Append(&Desc.NumStaticSamplers, sizeof(Desc.NumStaticSamplers));
+    if (Desc.NumStaticSamplers > 0)
+        Append(Desc.pStaticSamplers, sizeof(D3D12_STATIC_SAMPLER_DESC) * Desc.NumStaticSamplers);
+
+    return Key;
+}
+
+} // namespace
+
 RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*                                     pRefCounters,
                                        RenderDeviceD3D12Impl*                                  pDeviceD3D12Impl,
                                        const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl> ppSignatures[],
                                        Uint32                                                  SignatureCount,
-                                       size_t                                                  Hash) :
+                                       size_t                                                  Hash,
+                                       PipelineStateCacheD3D12Impl*                            pPSOCache) :
     ObjectBase<IObject>{pRefCounters},
     m_SignatureCount{SignatureCount},
     m_Hash{Hash},
@@ -224,20 +274,49 @@ RootSignatureD3D12::RootSignatureD3D12(IReferenceCounters*
         VERIFY_EXPR(d3d12StaticSamplers.size() == TotalImmutableSamplers);
     }
 
-    CComPtr<ID3DBlob> signature;
-    CComPtr<ID3DBlob> error;
+    constexpr auto RootSignatureVersion = D3D_ROOT_SIGNATURE_VERSION_1;
+
+    m_DescKey = GetRootSignatureDescKey(rootSignatureDesc, RootSignatureVersion);
+
+    // Serializing the root signature is expensive, so try the blob from the pipeline state cache first.
+    if (pPSOCache != nullptr)
+    {
+        m_pd3d12RootSignature = pPSOCache->LoadRootSignature(m_DescKey);
+        m_LoadedFromPSOCache  = m_pd3d12RootSignature != nullptr;
+    }
 
-    HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signature, &error);
-    if (error)
+    CComPtr<ID3DBlob> signature;
+    if (!m_pd3d12RootSignature)
     {
-        LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
+        CComPtr<ID3DBlob> error;
+
+        HRESULT hr = D3D12SerializeRootSignature(&rootSignatureDesc, RootSignatureVersion, &signature, &error);
+        if (error)
+        {
+            LOG_ERROR_MESSAGE("Error: ", (const char*)error->GetBufferPointer());
+        }
+        CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
+
+        auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
+
+        hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
+        CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
+
+        const auto* pBlobData = static_cast<const Uint8*>(signature->GetBufferPointer());
+        m_SerializedBlob.assign(pBlobData, pBlobData + signature->GetBufferSize());
     }
-    CHECK_D3D_RESULT_THROW(hr, "Failed to serialize root signature");
 
-    auto* pd3d12Device = pDeviceD3D12Impl->GetD3D12Device();
+    if (pPSOCache != nullptr && !m_LoadedFromPSOCache)
+        StoreInPSOCache(*pPSOCache);
+}
 
-    hr = pd3d12Device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), __uuidof(m_pd3d12RootSignature), reinterpret_cast<void**>(static_cast<ID3D12RootSignature**>(&m_pd3d12RootSignature)));
-    CHECK_D3D_RESULT_THROW(hr, "Failed to create root signature");
+void RootSignatureD3D12::StoreInPSOCache(PipelineStateCacheD3D12Impl& PSOCache) const
+{
+    // Root signatures loaded from a cache do not keep the blob, but the cache they were loaded
+    // from already contains it. Other caches will get the blob when the root signature is
+    // recreated after it has been released.
+    if (!m_SerializedBlob.empty())
+        PSOCache.StoreRootSignature(m_DescKey, m_SerializedBlob.data(), m_SerializedBlob.size());
 }
 
 RootSignatureD3D12::~RootSignatureD3D12()
@@ -326,7 +405,9 @@ RootSignatureCacheD3D12::~RootSignatureCacheD3D12()
     VERIFY(m_RootSigCache.empty(), "All pipeline resource signatures must be released before the cache is destroyed.");
 }
 
-RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures, Uint32 SignatureCount)
+RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefCntAutoPtr<PipelineResourceSignatureD3D12Impl>* ppSignatures,
+                                                                      Uint32                                                   SignatureCount,
+                                                                      PipelineStateCacheD3D12Impl*                             pPSOCache)
 {
     size_t Hash = 0;
     if (SignatureCount > 0)
@@ -352,17 +433,35 @@ RefCntAutoPtr<RootSignatureD3D12> RootSignatureCacheD3D12::GetRootSig(const RefC
         if (auto Ptr = Iter->second.Lock())
         {
             if (Ptr->IsCompatibleWith(ppSignatures, SignatureCount))
+            {
+                ++m_Stats.NumHits;
+                // The root signature may have been created for a pipeline that used another cache
+                if (pPSOCache != nullptr)
+                    Ptr->StoreInPSOCache(*pPSOCache);
                 return Ptr;
+            }
         }
     }
 
     RefCntAutoPtr<RootSignatureD3D12> pNewRootSig;
-    m_DeviceD3D12Impl.CreateRootSignature(ppSignatures, SignatureCount, Hash, &pNewRootSig);
+    m_DeviceD3D12Impl.CreateRootSignature(ppSignatures, SignatureCount, Hash, pPSOCache, &pNewRootSig);
+
+    ++m_Stats.NumMisses;
+    if (pNewRootSig && pNewRootSig->IsLoadedFromPSOCache())
+        ++m_Stats.NumBlobsLoaded;
 
     m_RootSigCache.emplace(Hash, pNewRootSig);
     return pNewRootSig;
 }
 
+void RootSignatureCacheD3D12::GetStatistics(RootSignatureCacheStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_RootSigCacheMtx};
+
+    Stats                   = m_Stats;
+    Stats.NumRootSignatures = static_cast<Uint32>(m_RootSigCache.size());
+}
+
 void RootSignatureCacheD3D12::OnDestroyRootSig(RootSignatureD3D12* pRootSig)
 {
     std::lock_guard<std::mutex> Lock{m_RootSigCacheMtx};
@@ -693,4 +693,41 @@ void ShaderResourceCacheD3D12::TransitionResourceStates(CommandContext& Ctx, Sta
     }
 }
 
+void ShaderResourceCacheD3D12::AddResidencyUsage(CommandContext& Ctx)
+{
+    static_assert(SHADER_RESOURCE_TYPE_LAST == 8, "Please update this function to handle the new resource type");
+    for (Uint32 r = 0; r < m_TotalResourceCount; ++r)
+    {
+        const auto& Res = GetResource(r);
+        if (!Res.pObject)
+            continue;
+
+        switch (Res.Type)
+        {
+            case SHADER_RESOURCE_TYPE_CONSTANT_BUFFER:
+                Ctx.AddResidencyUsage(Res.pObject.RawPtr<const BufferD3D12Impl>()->GetResidencyObject());
+                break;
+
+            case SHADER_RESOURCE_TYPE_BUFFER_SRV:
+            case SHADER_RESOURCE_TYPE_BUFFER_UAV:
+                Ctx.AddResidencyUsage(Res.pObject.RawPtr<const BufferViewD3D12Impl>()->GetBuffer<const BufferD3D12Impl>()->GetResidencyObject());
+                break;
+
+            case SHADER_RESOURCE_TYPE_TEXTURE_SRV:
+            case SHADER_RESOURCE_TYPE_INPUT_ATTACHMENT:
+            case SHADER_RESOURCE_TYPE_TEXTURE_UAV:
+                Ctx.AddResidencyUsage(Res.pObject.RawPtr<const TextureViewD3D12Impl>()->GetTexture<const TextureD3D12Impl>()->GetResidencyObject());
+                break;
+
+            case SHADER_RESOURCE_TYPE_SAMPLER:
+            case SHADER_RESOURCE_TYPE_ACCEL_STRUCT:
+                // Samplers have no memory, acceleration structures are not tracked
+                break;
+
+            default:
+                UNEXPECTED("Unexpected resource type");
+        }
+    }
+}
+
 } // namespace Diligent
@@ -126,6 +126,12 @@ const PipelineResourceDesc& ShaderVariableManagerD3D12::GetResourceDesc(Uint32 I
     return m_pSignature->GetResourceDesc(Index);
 }
 
+size_t ShaderVariableManagerD3D12::GetResourceNameHash(Uint32 Index) const
+{
+    VERIFY_EXPR(m_pSignature != nullptr);
+    return m_pSignature->GetResourceNameHash(Index);
+}
+
 const ShaderVariableManagerD3D12::ResourceAttribs& ShaderVariableManagerD3D12::GetResourceAttribs(Uint32 Index) const
 {
     VERIFY_EXPR(m_pSignature != nullptr);
@@ -183,9 +189,12 @@ void ShaderVariableManagerD3D12::BindResources(IResourceMapping* pResourceMappin
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Variables look up resources in the engine's resource mapping by precomputed name hashes
+    RefCntAutoPtr<ResourceMappingImpl> pMappingImpl{pResourceMapping, IID_ResourceMappingImpl};
+
     for (Uint32 v = 0; v < m_NumVariables; ++v)
     {
-        m_pVariables[v].BindResources(pResourceMapping, Flags);
+        m_pVariables[v].BindResources(pResourceMapping, pMappingImpl, Flags);
     }
 }
 
@@ -32,6 +32,7 @@
 #include "RenderDeviceD3D12Impl.hpp"
 #include "DeviceContextD3D12Impl.hpp"
 #include "TextureViewD3D12Impl.hpp"
+#include "ResourceHeapD3D12Impl.hpp"
 
 #include "D3D12TypeConversions.hpp"
 #include "DXGITypeConversions.hpp"
@@ -80,23 +81,23 @@ static DXGI_FORMAT GetClearFormat(DXGI_FORMAT Fmt, D3D12_RESOURCE_FLAGS Flags)
     return Fmt;
 }
 
-D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc() const
+D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc(const TextureDesc& TexDesc)
 {
     D3D12_RESOURCE_DESC Desc = {};
 
     Desc.Alignment = 0;
-    if (m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY || m_Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY || m_Desc.Type == RESOURCE_DIM_TEX_CUBE || m_Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
-        Desc.DepthOrArraySize = (UINT16)m_Desc.ArraySize;
-    else if (m_Desc.Type == RESOURCE_DIM_TEX_3D)
-        Desc.DepthOrArraySize = (UINT16)m_Desc.Depth;
+    if (TexDesc.Type == RESOURCE_DIM_TEX_1D_ARRAY || TexDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY || TexDesc.Type == RESOURCE_DIM_TEX_CUBE || TexDesc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+        Desc.DepthOrArraySize = (UINT16)TexDesc.ArraySize;
+    else if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
+        Desc.DepthOrArraySize = (UINT16)TexDesc.Depth;
     else
         Desc.DepthOrArraySize = 1;
 
-    if (m_Desc.Type == RESOURCE_DIM_TEX_1D || m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY)
+    if (TexDesc.Type == RESOURCE_DIM_TEX_1D || TexDesc.Type == RESOURCE_DIM_TEX_1D_ARRAY)
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE1D;
-    else if (m_Desc.Type == RESOURCE_DIM_TEX_2D || m_Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY || m_Desc.Type == RESOURCE_DIM_TEX_CUBE || m_Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+    else if (TexDesc.Type == RESOURCE_DIM_TEX_2D || TexDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY || TexDesc.Type == RESOURCE_DIM_TEX_CUBE || TexDesc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-    else if (m_Desc.Type == RESOURCE_DIM_TEX_3D)
+    else if (TexDesc.Type == RESOURCE_DIM_TEX_3D)
         Desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE3D;
     else
     {
@@ -104,27 +105,28 @@ D3D12_RESOURCE_DESC TextureD3D12Impl::GetD3D12TextureDesc() const
     }
 
     Desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-    if (m_Desc.BindFlags & BIND_RENDER_TARGET)
+    if (TexDesc.BindFlags & BIND_RENDER_TARGET)
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-    if (m_Desc.BindFlags & BIND_DEPTH_STENCIL)
+    if (TexDesc.BindFlags & BIND_DEPTH_STENCIL)
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-    if ((m_Desc.BindFlags & BIND_UNORDERED_ACCESS) || (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS))
+    if ((TexDesc.BindFlags & BIND_UNORDERED_ACCESS) || (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS))
         Desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-    if ((m_Desc.BindFlags & BIND_SHADER_RESOURCE) == 0 && (m_Desc.BindFlags & BIND_DEPTH_STENCIL) != 0)
+    if ((TexDesc.BindFlags & BIND_SHADER_RESOURCE) == 0 && (TexDesc.BindFlags & BIND_DEPTH_STENCIL) != 0)
         Desc.Flags |= D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE;
 
-    auto Format = TexFormatToDXGI_Format(m_Desc.Format, m_Desc.BindFlags);
+    auto Format = TexFormatToDXGI_Format(TexDesc.Format, TexDesc.BindFlags);
     if (Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB && (Desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS))
         Desc.Format = DXGI_FORMAT_R8G8B8A8_TYPELESS;
     else
         Desc.Format = Format;
 
-    Desc.Height             = UINT{m_Desc.Height};
-    Desc.Layout             = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-    Desc.MipLevels          = static_cast<UINT16>(m_Desc.MipLevels);
-    Desc.SampleDesc.Count   = m_Desc.SampleCount;
+    Desc.Height             = UINT{TexDesc.Height};
+    // Reserved resources must use the standard 64KB tile swizzle
+    Desc.Layout             = (TexDesc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0 ? D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE : D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    Desc.MipLevels          = static_cast<UINT16>(TexDesc.MipLevels);
+    Desc.SampleDesc.Count   = TexDesc.SampleCount;
     Desc.SampleDesc.Quality = 0;
-    Desc.Width              = UINT64{m_Desc.Width};
+    Desc.Width              = UINT64{TexDesc.Width};
 
     return Desc;
 }
@@ -133,7 +135,9 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
                                    FixedBlockMemoryAllocator& TexViewObjAllocator,
                                    RenderDeviceD3D12Impl*     pRenderDeviceD3D12,
                                    const TextureDesc&         TexDesc,
-                                   const TextureData*         pInitData /*= nullptr*/) :
+                                   const TextureData*         pInitData /*= nullptr*/,
+                                   ResourceHeapD3D12Impl*     pHeap /*= nullptr*/,
+                                   Uint64                     HeapOffset /*= 0*/) :
     TTextureBase{pRefCounters, TexViewObjAllocator, pRenderDeviceD3D12, TexDesc}
 {
     if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
@@ -147,7 +151,16 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
         }
     }
 
-    D3D12_RESOURCE_DESC d3d12TexDesc       = GetD3D12TextureDesc();
+    const bool IsSparse = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0;
+    if (IsSparse)
+    {
+        if (pInitData != nullptr && pInitData->pSubResources != nullptr)
+            LOG_ERROR_AND_THROW("Sparse textures can't be initialized with data at creation time as they have no memory bound");
+        if (pHeap != nullptr)
+            LOG_ERROR_AND_THROW("Sparse textures can't be placed in a resource heap. Use IDeviceContext::UpdateTileMappings() to bind heap memory to tiles");
+    }
+
+    D3D12_RESOURCE_DESC d3d12TexDesc       = GetD3D12TextureDesc(m_Desc);
     const bool          bInitializeTexture = (pInitData != nullptr && pInitData->pSubResources != nullptr && pInitData->NumSubresources > 0);
 
     const auto CmdQueueInd = pInitData != nullptr && pInitData->pContext != nullptr ?
@@ -193,22 +206,53 @@ TextureD3D12Impl::TextureD3D12Impl(IReferenceCounters*        pRefCounters,
         HeapProps.Type                 = D3D12_HEAP_TYPE_DEFAULT;
         HeapProps.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
         HeapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        HeapProps.CreationNodeMask     = 1;
-        HeapProps.VisibleNodeMask      = 1;
+        pRenderDeviceD3D12->GetResourceNodeMasks(m_Desc.ImmediateContextMask, HeapProps.CreationNodeMask, HeapProps.VisibleNodeMask);
 
         auto InitialState = bInitializeTexture ? RESOURCE_STATE_COPY_DEST : RESOURCE_STATE_UNDEFINED;
         SetState(InitialState);
 
-        auto d3d12State = ResourceStateFlagsToD3D12ResourceStates(InitialState) & d3d12StateMask;
-        auto hr =
-            pd3d12Device->CreateCommittedResource(&HeapProps, D3D12_HEAP_FLAG_NONE, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
-                                                  reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+        auto    d3d12State = ResourceStateFlagsToD3D12ResourceStates(InitialState) & d3d12StateMask;
+        HRESULT hr         = S_OK;
+        if (IsSparse)
+        {
+            // Reserved resource only allocates the virtual address range; the memory is
+            // mapped to the tiles by IDeviceContext::UpdateTileMappings().
+            hr = pd3d12Device->CreateReservedResource(&d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                                                      reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+        }
+        else if (pHeap != nullptr)
+        {
+            // The texture is placed in the heap memory that may be aliased by other resources.
+            // Placement range and alignment are validated by the heap.
+            hr = pd3d12Device->CreatePlacedResource(pHeap->GetD3D12Heap(), HeapOffset, &d3d12TexDesc, d3d12State, pClearValue, __uuidof(m_pd3d12Resource),
+                                                    reinterpret_cast<void**>(static_cast<ID3D12Resource**>(&m_pd3d12Resource)));
+            m_pHeap = pHeap;
+        }
+        else
+        {
+            // Small textures are suballocated from the placed resource heaps, other textures are committed
+            hr = pRenderDeviceD3D12->GetPlacedResourceManager().CreateResource(HeapProps, d3d12TexDesc, d3d12State, pClearValue, m_MemoryAllocation,
+                                                                               static_cast<ID3D12Resource**>(&m_pd3d12Resource));
+        }
         if (FAILED(hr))
             LOG_ERROR_AND_THROW("Failed to create D3D12 texture");
 
+        if (m_MemoryAllocation.Page != nullptr)
+        {
+            m_pResidencyObject = m_MemoryAllocation.Page->GetResidencyObject();
+        }
+        else if (!IsSparse && pHeap == nullptr)
+        {
+            m_ResidencyHandle  = pRenderDeviceD3D12->GetResidencyManager().RegisterCommittedResource(m_pd3d12Resource);
+            m_pResidencyObject = m_ResidencyHandle.GetObject();
+        }
+
         if (*m_Desc.Name != 0)
             m_pd3d12Resource->SetName(WidenString(m_Desc.Name).c_str());
 
+        if (IsSparse)
+            InitSparseProperties();
+
         if (bInitializeTexture)
         {
             Uint32 ExpectedNumSubresources = Uint32{d3d12TexDesc.MipLevels} * (d3d12TexDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1 : Uint32{d3d12TexDesc.DepthOrArraySize});
@@ -554,10 +598,34 @@ void TextureD3D12Impl::CreateViewInternal(const struct TextureViewDesc& ViewDesc
     }
 }
 
+void TextureD3D12Impl::InitSparseProperties()
+{
+    auto* pd3d12Device = GetDevice()->GetD3D12Device();
+
+    UINT                  NumTilesForEntireResource = 0;
+    D3D12_PACKED_MIP_INFO PackedMipDesc{};
+    D3D12_TILE_SHAPE      StandardTileShape{};
+    UINT                  NumSubresourceTilings = 0;
+    pd3d12Device->GetResourceTiling(m_pd3d12Resource, &NumTilesForEntireResource, &PackedMipDesc, &StandardTileShape, &NumSubresourceTilings, 0, nullptr);
+
+    m_SparseProps.TileWidth       = StandardTileShape.WidthInTexels;
+    m_SparseProps.TileHeight      = StandardTileShape.HeightInTexels;
+    m_SparseProps.TileDepth       = StandardTileShape.DepthInTexels;
+    m_SparseProps.TileSizeInBytes = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    // Packed mips of every array slice are mapped as a single tile range
+    m_SparseProps.FirstMipInTail = std::min(Uint32{PackedMipDesc.NumStandardMips}, m_Desc.MipLevels);
+    m_SparseProps.MipTailSize    = Uint64{PackedMipDesc.NumTilesForPackedMips} * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    m_SparseProps.MemorySize     = Uint64{NumTilesForEntireResource} * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+}
+
 TextureD3D12Impl::~TextureD3D12Impl()
 {
     // D3D12 object can only be destroyed when it is no longer used by the GPU
     GetDevice()->SafeReleaseDeviceObject(std::move(m_pd3d12Resource), m_Desc.ImmediateContextMask);
+    if (m_MemoryAllocation.Page != nullptr)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+    if (m_ResidencyHandle)
+        GetDevice()->SafeReleaseDeviceObject(std::move(m_ResidencyHandle), m_Desc.ImmediateContextMask);
     if (m_StagingFootprints != nullptr)
     {
         FREE(GetRawAllocator(), m_StagingFootprints);
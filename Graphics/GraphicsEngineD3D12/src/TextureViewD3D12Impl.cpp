@@ -60,10 +60,15 @@ TextureViewD3D12Impl::TextureViewD3D12Impl(IReferenceCounters*        pRefCounte
         new (&m_MipGenerationDescriptors[0]) DescriptorHeapAllocation{std::move(TexArraySRVDescriptor)};
         new (&m_MipGenerationDescriptors[1]) DescriptorHeapAllocation{std::move(MipLevelUAVDescriptors)};
     }
+
+    if (ViewDesc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE || ViewDesc.ViewType == TEXTURE_VIEW_UNORDERED_ACCESS)
+        m_BindlessIndex = pDevice->AddBindlessDescriptor(m_Descriptor.GetCpuHandle());
 }
 
 TextureViewD3D12Impl::~TextureViewD3D12Impl()
 {
+    m_pDevice->RemoveBindlessDescriptor(m_BindlessIndex, m_pTexture->GetDesc().ImmediateContextMask);
+
     if (m_MipGenerationDescriptors != nullptr)
     {
         for (Uint32 i = 0; i < 2; ++i)
@@ -210,6 +210,11 @@ public:
             Features.TextureUAVExtendedFormats     = DEVICE_FEATURE_STATE_ENABLED;
             Features.InstanceDataStepRate          = DEVICE_FEATURE_STATE_ENABLED;
             Features.TileShaders                   = DEVICE_FEATURE_STATE_DISABLED;
+            Features.SparseResources               = DEVICE_FEATURE_STATE_DISABLED;
+            Features.SpecializationConstants       = DEVICE_FEATURE_STATE_DISABLED;
+            Features.DynamicPipelineStates         = DEVICE_FEATURE_STATE_DISABLED;
+            Features.BufferDeviceAddress           = DEVICE_FEATURE_STATE_DISABLED;
+            Features.ConditionalRendering          = DEVICE_FEATURE_STATE_ENABLED;
         }
 
         // Set memory properties
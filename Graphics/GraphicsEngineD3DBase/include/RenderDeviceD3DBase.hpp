@@ -31,8 +31,10 @@
 /// Implementation of the Diligent::RenderDeviceBase template class and related structures
 
 #include <dxgi.h>
+#include <memory>
 
 #include "RenderDeviceBase.hpp"
+#include "ShaderCache.hpp"
 
 namespace Diligent
 {
@@ -48,7 +50,8 @@ public:
                         IEngineFactory*            pEngineFactory,
                         const EngineCreateInfo&    EngineCI,
                         const GraphicsAdapterInfo& AdapterInfo) :
-        RenderDeviceBase<EngineImplTraits>{pRefCounters, RawMemAllocator, pEngineFactory, EngineCI, AdapterInfo}
+        RenderDeviceBase<EngineImplTraits>{pRefCounters, RawMemAllocator, pEngineFactory, EngineCI, AdapterInfo},
+        m_pShaderCache{EngineCI.EnableShaderCache ? std::make_unique<ShaderCache>(EngineCI.ShaderCacheDirectory) : nullptr}
     {
         // Flag texture formats always supported in D3D11 and D3D12
 
@@ -157,6 +160,12 @@ public:
 #undef FLAG_FORMAT
         // clang-format on
     }
+
+    /// Returns the compiled shader cache or null if the cache is disabled
+    ShaderCache* GetShaderCache() const { return m_pShaderCache.get(); }
+
+private:
+    std::unique_ptr<ShaderCache> m_pShaderCache;
 };
 
 } // namespace Diligent
@@ -27,8 +27,12 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include <d3dcommon.h>
 #include "Shader.h"
+#include "ResourceBindingMap.hpp"
 
 /// \file
 /// Base implementation of a D3D shader
@@ -40,10 +44,49 @@ namespace Diligent
 class ShaderD3DBase
 {
 public:
-    ShaderD3DBase(const ShaderCreateInfo& ShaderCI, ShaderVersion ShaderModel, class IDXCompiler* DxCompiler);
+    ShaderD3DBase(const ShaderCreateInfo& ShaderCI, ShaderVersion ShaderModel, class IDXCompiler* DxCompiler, class ShaderCache* pShaderCache);
+
+    /// Returns the shader byte code with resource bindings remapped according to the resource map.
+
+    /// \param [in] ResourceMap - Resource binding map.
+    /// \param [in] DxCompiler  - DXC compiler that is used to remap DXIL byte code.
+    ///                           May be null if the byte code is DXBC.
+    /// \param [in] ShaderName  - Shader name that is used in error messages.
+    ///
+    /// 
+emarks    The remapped byte code is cached for every distinct resource map, so pipelines
+    ///             that share the shader and use the same resource signatures do not repeat the work.
+    ///             The method is thread-safe; the remapping itself is performed outside of the lock,
+    ///             so pipelines that are initialized on different threads remap shaders in parallel.
+    ///             The method throws an exception in case of an error.
+    CComPtr<ID3DBlob> GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap,
+                                          class IDXCompiler*           DxCompiler,
+                                          const char*                  ShaderName) noexcept(false);
 
 protected:
     CComPtr<ID3DBlob> m_pShaderByteCode;
+
+private:
+    struct ResourceMapHashKey
+    {
+        explicit ResourceMapHashKey(const ResourceBinding::TMap& _Map);
+
+        bool operator==(const ResourceMapHashKey& rhs) const;
+
+        struct Hasher
+        {
+            size_t operator()(const ResourceMapHashKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+
+        ResourceBinding::TMap Map;
+        const size_t          Hash;
+    };
+
+    std::mutex                                                                          m_RemappedBytecodeMtx;
+    std::unordered_map<ResourceMapHashKey, CComPtr<ID3DBlob>, ResourceMapHashKey::Hasher> m_RemappedBytecode;
 };
 
 } // namespace Diligent
@@ -325,6 +325,9 @@ public:
 
     SHADER_TYPE GetShaderType() const noexcept { return m_ShaderType; }
 
+    /// Returns the shader statistics reported by the byte code reflection.
+    ShaderStatistics GetStatistics() const noexcept;
+
     HLSLShaderResourceDesc GetHLSLShaderResourceDesc(Uint32 Index) const;
 
     template <typename THandleCB,
@@ -476,6 +479,11 @@ private:
     const SHADER_TYPE m_ShaderType;
 
     Uint32 m_ShaderVersion = 0;
+
+    // Byte code statistics reported by the shader reflection.
+    // DXIL reflection does not report them and leaves the values zero.
+    Uint32 m_InstructionCount  = 0;
+    Uint32 m_TempRegisterCount = 0;
 };
 
 
@@ -498,7 +506,9 @@ void ShaderResources::Initialize(TShaderReflection*  pShaderReflection,
 
         [&](const D3D_SHADER_DESC& d3dShaderDesc) //
         {
-            m_ShaderVersion = d3dShaderDesc.Version;
+            m_ShaderVersion     = d3dShaderDesc.Version;
+            m_InstructionCount  = d3dShaderDesc.InstructionCount;
+            m_TempRegisterCount = d3dShaderDesc.TempRegisterCount;
         },
 
         [&](const D3DShaderResourceCounters& ResCounters, size_t ResourceNamesPoolSize) //
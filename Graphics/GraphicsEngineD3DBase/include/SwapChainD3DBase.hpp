@@ -277,8 +277,10 @@ protected:
         }
     }
 
-    void WaitForFrame()
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override final
     {
+        m_FrameWaited = true;
+
         // https://docs.microsoft.com/en-us/windows/uwp/gaming/reduce-latency-with-dxgi-1-3-swap-chains#step-4-wait-before-rendering-each-frame
         if (m_FrameLatencyWaitableObject != NULL)
         {
@@ -366,6 +368,9 @@ protected:
 
     HANDLE m_FrameLatencyWaitableObject = NULL;
 
+    // Whether WaitForFrame() has been called since the last Present()
+    bool m_FrameWaited = false;
+
     Uint32 m_MaxFrameLatency = 0;
 };
 
@@ -39,10 +39,14 @@
 
 #include "D3DErrors.hpp"
 #include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderD3DBase.hpp"
 #include "DXCompiler.hpp"
+#include "DXBCUtils.hpp"
 #include "HLSLUtils.hpp"
+#include "ShaderCache.hpp"
+#include "HashUtils.hpp"
 #include "BasicMath.hpp"
 
 #ifndef D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES
@@ -71,9 +75,9 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>{}(0));
-        pSourceStream->ReadBlob(pFileData);
-        *ppData = pFileData->GetDataPtr();
+        RefCntAutoPtr<IDataBlob> pFileData;
+        pSourceStream->ReadBlob2(&pFileData);
+        *ppData = pFileData->GetConstDataPtr();
         *pBytes = static_cast<UINT>(pFileData->GetSize());
 
         m_DataBlobs.insert(std::make_pair(*ppData, pFileData));
@@ -134,7 +138,7 @@ static HRESULT CompileShader(const char*             Source,
     return D3DCompile(Source, SourceLength, nullptr, Macros, &IncludeImpl, ShaderCI.EntryPoint, profile, dwShaderFlags, 0, ppBlobOut, ppCompilerOutput);
 }
 
-ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersion ShaderModel, IDXCompiler* DxCompiler)
+ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersion ShaderModel, IDXCompiler* DxCompiler, ShaderCache* pShaderCache)
 {
     if (ShaderCI.Source || ShaderCI.FilePath)
     {
@@ -164,6 +168,39 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
             default: UNEXPECTED("Unsupported shader compiler");
         }
 
+        String ShaderSource;
+        if (!UseDXC || pShaderCache != nullptr)
+            ShaderSource = BuildHLSLSourceString(ShaderCI);
+
+        ShaderCache::Key CacheKey;
+        if (pShaderCache != nullptr)
+        {
+            if (UseDXC)
+            {
+                Uint32 MajorVersion = 0, MinorVersion = 0;
+                DxCompiler->GetVersion(MajorVersion, MinorVersion);
+                CacheKey = ShaderCache::ComputeKey(ShaderCI, ShaderSource.c_str(), ShaderSource.length(), "DXC",
+                                                   {ShaderModel.Major, ShaderModel.Minor, MajorVersion, MinorVersion});
+            }
+            else
+            {
+#if defined(DILIGENT_DEBUG)
+                constexpr Uint32 IsDebug = 1;
+#else
+                constexpr Uint32 IsDebug = 0;
+#endif
+                CacheKey = ShaderCache::ComputeKey(ShaderCI, ShaderSource.c_str(), ShaderSource.length(), "FXC",
+                                                   {ShaderModel.Major, ShaderModel.Minor, Uint32{D3D_COMPILER_VERSION}, IsDebug});
+            }
+
+            if (auto pCachedByteCode = pShaderCache->Find(CacheKey, ShaderCI.ppCompilerOutput))
+            {
+                CHECK_D3D_RESULT_THROW(D3DCreateBlob(pCachedByteCode->GetSize(), &m_pShaderByteCode), "Failed to create D3D blob");
+                memcpy(m_pShaderByteCode->GetBufferPointer(), pCachedByteCode->GetConstDataPtr(), pCachedByteCode->GetSize());
+                return;
+            }
+        }
+
         if (UseDXC)
         {
             VERIFY_EXPR(__uuidof(ID3DBlob) == __uuidof(IDxcBlob));
@@ -173,13 +210,23 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
         {
             std::string strShaderProfile = GetHLSLProfileString(ShaderCI.Desc.ShaderType, ShaderModel);
 
-            String ShaderSource = BuildHLSLSourceString(ShaderCI);
-
             CComPtr<ID3DBlob> CompilerOutput;
 
             auto hr = CompileShader(ShaderSource.c_str(), ShaderSource.length(), ShaderCI, strShaderProfile.c_str(), &m_pShaderByteCode, &CompilerOutput);
             HandleHLSLCompilerResult(SUCCEEDED(hr), CompilerOutput.p, ShaderSource, ShaderCI.Desc.Name, ShaderCI.ppCompilerOutput);
         }
+
+        if (pShaderCache != nullptr && m_pShaderByteCode)
+        {
+            // Share the compiled byte code with the cache instead of copying it.
+            // The proxy blob holds a reference to the D3D blob and releases it in the callback.
+            m_pShaderByteCode.p->AddRef();
+            RefCntAutoPtr<IDataBlob> pByteCode{
+                MakeNewRCObj<ProxyDataBlob>{}(m_pShaderByteCode->GetBufferPointer(), m_pShaderByteCode->GetBufferSize(),
+                                              [](const void*, void* pUserData) { static_cast<ID3DBlob*>(pUserData)->Release(); },
+                                              m_pShaderByteCode.p)};
+            pShaderCache->Add(CacheKey, pByteCode);
+        }
     }
     else if (ShaderCI.ByteCode)
     {
@@ -193,4 +240,73 @@ ShaderD3DBase::ShaderD3DBase(const ShaderCreateInfo& ShaderCI, const ShaderVersi
     }
 }
 
+ShaderD3DBase::ResourceMapHashKey::ResourceMapHashKey(const ResourceBinding::TMap& _Map) :
+    Map{_Map},
+    Hash{[](const ResourceBinding::TMap& Map) {
+        // The hash must not depend on the iteration order of the map
+        size_t Hash = Map.size();
+        for (const auto& it : Map)
+            Hash += ComputeHash(it.first.GetHash(), it.second.BindPoint, it.second.Space, it.second.ArraySize);
+        return Hash;
+    }(_Map)}
+{
+}
+
+bool ShaderD3DBase::ResourceMapHashKey::operator==(const ResourceMapHashKey& rhs) const
+{
+    if (Hash != rhs.Hash || Map.size() != rhs.Map.size())
+        return false;
+
+    for (const auto& it : Map)
+    {
+        auto rhs_it = rhs.Map.find(it.first);
+        if (rhs_it == rhs.Map.end())
+            return false;
+
+        const auto& Info0 = it.second;
+        const auto& Info1 = rhs_it->second;
+        if (Info0.BindPoint != Info1.BindPoint || Info0.Space != Info1.Space || Info0.ArraySize != Info1.ArraySize)
+            return false;
+    }
+
+    return true;
+}
+
+CComPtr<ID3DBlob> ShaderD3DBase::GetRemappedBytecode(const ResourceBinding::TMap& ResourceMap,
+                                                     IDXCompiler*                 DxCompiler,
+                                                     const char*                  ShaderName) noexcept(false)
+{
+    ResourceMapHashKey Key{ResourceMap};
+    {
+        std::lock_guard<std::mutex> Lock{m_RemappedBytecodeMtx};
+
+        auto it = m_RemappedBytecode.find(Key);
+        if (it != m_RemappedBytecode.end())
+            return it->second;
+    }
+
+    CComPtr<ID3DBlob> pBlob;
+    if (IsDXILBytecode(m_pShaderByteCode->GetBufferPointer(), m_pShaderByteCode->GetBufferSize()))
+    {
+        if (DxCompiler == nullptr)
+            LOG_ERROR_AND_THROW("DXC compiler does not exists, can not remap resource bindings");
+
+        if (!DxCompiler->RemapResourceBindings(ResourceMap, reinterpret_cast<IDxcBlob*>(m_pShaderByteCode.p), reinterpret_cast<IDxcBlob**>(&pBlob)))
+            LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", ShaderName, "'.");
+    }
+    else
+    {
+        CHECK_D3D_RESULT_THROW(D3DCreateBlob(m_pShaderByteCode->GetBufferSize(), &pBlob), "Failed to create D3D blob");
+        memcpy(pBlob->GetBufferPointer(), m_pShaderByteCode->GetBufferPointer(), m_pShaderByteCode->GetBufferSize());
+
+        if (!DXBCUtils::RemapResourceBindings(ResourceMap, pBlob->GetBufferPointer(), pBlob->GetBufferSize()))
+            LOG_ERROR_AND_THROW("Failed to remap resource bindings in shader '", ShaderName, "'.");
+    }
+
+    std::lock_guard<std::mutex> Lock{m_RemappedBytecodeMtx};
+    // Another thread may have remapped the byte code for the same map while the lock was released.
+    // Use the blob that is already in the cache so that all pipelines share the same byte code.
+    return m_RemappedBytecode.emplace(std::move(Key), std::move(pBlob)).first->second;
+}
+
 } // namespace Diligent
@@ -389,6 +389,17 @@ HLSLShaderResourceDesc ShaderResources::GetHLSLShaderResourceDesc(Uint32 Index)
     return HLSLResourceDesc;
 }
 
+ShaderStatistics ShaderResources::GetStatistics() const noexcept
+{
+    ShaderStatistics Stats;
+    Stats.ShaderType = m_ShaderType;
+    if (m_InstructionCount != 0)
+        Stats.InstructionCount = m_InstructionCount;
+    if (m_TempRegisterCount != 0 || m_InstructionCount != 0)
+        Stats.RegisterCount = m_TempRegisterCount;
+    return Stats;
+}
+
 size_t ShaderResources::GetHash() const
 {
     size_t hash = ComputeHash(GetNumCBs(), GetNumTexSRV(), GetNumTexUAV(), GetNumBufSRV(), GetNumBufUAV(), GetNumSamplers());
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessIndexAllocator class
+
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+#include "BasicTypes.h"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+/// Allocates persistent indices in a bindless descriptor heap.
+
+/// Indices are handed out from a free list first and then linearly until capacity is reached.
+/// Released indices must not be reused while the GPU may still access the descriptor,
+/// so views should free their indices through RenderDeviceNextGenBase::SafeReleaseDeviceObject()
+/// by wrapping them in BindlessIndexAllocator::StaleIndex.
+class BindlessIndexAllocator
+{
+public:
+    explicit BindlessIndexAllocator(Uint32 Capacity) noexcept :
+        m_Capacity{Capacity}
+    {}
+
+    // clang-format off
+    BindlessIndexAllocator             (const BindlessIndexAllocator&) = delete;
+    BindlessIndexAllocator             (BindlessIndexAllocator&&)      = delete;
+    BindlessIndexAllocator& operator = (const BindlessIndexAllocator&) = delete;
+    BindlessIndexAllocator& operator = (BindlessIndexAllocator&&)      = delete;
+    // clang-format on
+
+    ~BindlessIndexAllocator()
+    {
+        VERIFY(m_FreeIndices.size() == m_NextIndex, "Not all bindless indices have been released");
+    }
+
+    /// Returns INVALID_BINDLESS_INDEX if the heap is full
+    Uint32 Allocate()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_FreeIndices.empty())
+        {
+            auto Index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+            return Index;
+        }
+
+        if (m_NextIndex < m_Capacity)
+            return m_NextIndex++;
+
+        return INVALID_BINDLESS_INDEX;
+    }
+
+    void Free(Uint32 Index)
+    {
+        if (Index == INVALID_BINDLESS_INDEX)
+            return;
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        VERIFY(Index < m_NextIndex, "Index ", Index, " has never been allocated");
+        m_FreeIndices.push_back(Index);
+    }
+
+    Uint32 GetCapacity() const { return m_Capacity; }
+
+    /// Returns the index to the allocator when destroyed by the release queue
+    struct StaleIndex
+    {
+        BindlessIndexAllocator* Allocator;
+        Uint32                  Index;
+
+        // clang-format off
+        StaleIndex(BindlessIndexAllocator& _Allocator, Uint32 _Index) noexcept :
+            Allocator{&_Allocator},
+            Index    {_Index     }
+        {}
+
+        StaleIndex            (const StaleIndex&)  = delete;
+        StaleIndex& operator= (const StaleIndex&)  = delete;
+        StaleIndex& operator= (      StaleIndex&&) = delete;
+
+        StaleIndex(StaleIndex&& rhs) noexcept :
+            Allocator{rhs.Allocator},
+            Index    {rhs.Index    }
+        {
+            rhs.Allocator = nullptr;
+            rhs.Index     = INVALID_BINDLESS_INDEX;
+        }
+        // clang-format on
+
+        ~StaleIndex()
+        {
+            if (Allocator != nullptr)
+                Allocator->Free(Index);
+        }
+    };
+
+private:
+    std::mutex          m_Mtx;
+    std::vector<Uint32> m_FreeIndices;
+    Uint32              m_NextIndex = 0;
+    const Uint32        m_Capacity;
+};
+
+} // namespace Diligent
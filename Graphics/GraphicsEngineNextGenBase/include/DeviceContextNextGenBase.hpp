@@ -35,6 +35,7 @@
 #include "DeviceContextBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "IndexWrapper.hpp"
+#include "ScratchBufferRing.hpp"
 
 namespace Diligent
 {
@@ -54,6 +55,7 @@ public:
                              const DeviceContextDesc& Desc) :
         // clang-format off
         TBase{pRefCounters, pRenderDevice, Desc},
+        m_ASScratchRing{*pRenderDevice, ASScratchRingPageSize, ASScratchRingMaxRetainedSize},
         m_SubmittedBuffersCmdQueueMask{Desc.IsDeferred ? 0 : Uint64{1} << Uint64{Desc.ContextId}}
     // clang-format on
     {
@@ -88,6 +90,8 @@ protected:
     // Should be called at the end of FinishFrame()
     void EndFrame()
     {
+        m_ASScratchRing.ReleasePages(GetSubmittedBuffersCmdQueueMask());
+
         if (this->IsDeferred())
         {
             // For deferred context, reset submitted cmd queue mask
@@ -105,7 +109,59 @@ protected:
         m_SubmittedBuffersCmdQueueMask.fetch_or(Uint64{1} << QueueId);
     }
 
+    // The following methods suballocate the scratch space for the build from the scratch ring
+    // when the application has not provided a scratch buffer. They return false if the
+    // allocation has failed.
+    bool AllocateASScratchSpace(BuildBLASAttribs& Attribs)
+    {
+        const auto ScratchSizes = Attribs.pBLAS->GetScratchBufferSizes();
+        return AllocateASScratchSpace(Attribs.Update ? ScratchSizes.Update : ScratchSizes.Build,
+                                      Attribs.pScratchBuffer, Attribs.ScratchBufferOffset, Attribs.ScratchBufferTransitionMode);
+    }
+
+    bool AllocateASScratchSpace(BuildTLASAttribs& Attribs)
+    {
+        const auto ScratchSizes = Attribs.pTLAS->GetScratchBufferSizes();
+        return AllocateASScratchSpace(Attribs.Update ? ScratchSizes.Update : ScratchSizes.Build,
+                                      Attribs.pScratchBuffer, Attribs.ScratchBufferOffset, Attribs.ScratchBufferTransitionMode);
+    }
+
+    bool AllocateASScratchSpace(BuildBLASBatchAttribs& Attribs)
+    {
+        const Uint32 ScratchAlignment = this->m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+
+        Uint64 TotalSize = 0;
+        for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+        {
+            // Invalid builds are reported by the validation
+            if (Attribs.pBuilds[i].pBLAS != nullptr)
+                TotalSize += GetBLASBatchScratchRegionSize(Attribs.pBuilds[i], ScratchAlignment);
+        }
+        return AllocateASScratchSpace(TotalSize, Attribs.pScratchBuffer, Attribs.ScratchBufferOffset, Attribs.ScratchBufferTransitionMode);
+    }
+
 private:
+    bool AllocateASScratchSpace(Uint64                          Size,
+                                IBuffer*&                       pScratchBuffer,
+                                Uint32&                         ScratchBufferOffset,
+                                RESOURCE_STATE_TRANSITION_MODE& TransitionMode)
+    {
+        const auto Allocation = m_ASScratchRing.Allocate(Size, this->m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment);
+        if (Allocation.pBuffer == nullptr)
+            return false;
+
+        pScratchBuffer      = Allocation.pBuffer;
+        ScratchBufferOffset = static_cast<Uint32>(Allocation.Offset);
+        // Ring pages are only used as scratch buffers, so the transition is a no-op after the first build
+        TransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        return true;
+    }
+
+    static constexpr Uint64 ASScratchRingPageSize        = Uint64{4} << 20;
+    static constexpr Uint64 ASScratchRingMaxRetainedSize = Uint64{32} << 20;
+
+    ScratchBufferRing<DeviceImplType> m_ASScratchRing;
+
     // This mask indicates which command queues command buffers from this context were submitted to.
     // For immediate context, this will always be 1 << GetCommandQueueId().
     // For deferred contexts, this will accumulate bits of the queues to which command buffers
@@ -35,7 +35,7 @@
 #include <vector>
 #include <atomic>
 #include "VariableSizeAllocationsManager.hpp"
-#include "RingBuffer.hpp"
+#include "ConcurrentRingBuffer.hpp"
 
 namespace Diligent
 {
@@ -51,9 +51,9 @@ namespace DynamicHeap
 class MasterBlockRingBufferBasedManager
 {
 public:
-    using OffsetType                                = RingBuffer::OffsetType;
-    using MasterBlock                               = RingBuffer::OffsetType;
-    static constexpr const OffsetType InvalidOffset = RingBuffer::InvalidOffset;
+    using OffsetType                                = ConcurrentRingBuffer::OffsetType;
+    using MasterBlock                               = ConcurrentRingBuffer::OffsetType;
+    static constexpr const OffsetType InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
 
     MasterBlockRingBufferBasedManager(IMemoryAllocator& Allocator,
                                       Uint32            Size) :
@@ -67,15 +67,16 @@ public:
     MasterBlockRingBufferBasedManager& operator= (      MasterBlockRingBufferBasedManager&&) = delete;
     // clang-format on
 
+    // Frames must be finished and released by a single thread
     void DiscardMasterBlocks(std::vector<MasterBlock>& /*Blocks*/, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
         m_RingBuffer.FinishCurrentFrame(FenceValue);
     }
 
     void ReleaseStaleBlocks(Uint64 LastCompletedFenceValue)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
         m_RingBuffer.ReleaseCompletedFrames(LastCompletedFenceValue);
     }
 
@@ -83,15 +84,16 @@ public:
     OffsetType GetUsedSize() const { return m_RingBuffer.GetUsedSize(); }
 
 protected:
+    // Lock-free
     MasterBlock AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
     {
-        std::lock_guard<std::mutex> Lock{m_RingBufferMtx};
         return m_RingBuffer.Allocate(SizeInBytes, Alignment);
     }
 
 private:
-    std::mutex m_RingBufferMtx;
-    RingBuffer m_RingBuffer;
+    // Serializes frame management only; allocations never take this mutex
+    std::mutex           m_FramesMtx;
+    ConcurrentRingBuffer m_RingBuffer;
 };
 
 
@@ -30,17 +30,21 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <memory>
 
 #include "PrivateConstants.h"
 #include "EngineFactory.h"
 #include "BasicTypes.h"
 #include "ReferenceCounters.h"
 #include "MemoryAllocator.h"
+#include "DataBlob.h"
 #include "RefCntAutoPtr.hpp"
 #include "PlatformMisc.hpp"
 #include "ResourceReleaseQueue.hpp"
 #include "EngineMemory.h"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
+#include "ProfilerHooks.hpp"
 
 namespace Diligent
 {
@@ -68,6 +72,9 @@ public:
         m_CommandQueues = ALLOCATE(this->m_RawMemAllocator, "Raw memory for the device command/release queues", CommandQueue, m_CmdQueueCount);
         for (size_t q = 0; q < m_CmdQueueCount; ++q)
             new (m_CommandQueues + q) CommandQueue{RefCntAutoPtr<CommandQueueType>(Queues[q]), this->m_RawMemAllocator};
+
+        if (EngineCI.AsyncResourceRelease)
+            m_pResourceReleaseThread.reset(new ThreadPool{1});
     }
 
     ~RenderDeviceNextGenBase()
@@ -113,7 +120,8 @@ public:
             return;
 
         Atomics::Long NumReferences = PlatformMisc::CountOneBits(QueueMask);
-        auto          Wrapper       = DynamicStaleResourceWrapper::Create(std::move(Object), NumReferences);
+        // The wrapper is allocated from the pool of the first queue. All queues are destroyed together.
+        auto Wrapper = m_CommandQueues[PlatformMisc::GetLSB(QueueMask)].ReleaseQueue.CreateWrapper(std::move(Object), NumReferences);
 
         while (QueueMask != 0)
         {
@@ -141,18 +149,48 @@ public:
         return (m_CmdQueueCount < MAX_COMMAND_QUEUES) ? ((Uint64{1} << Uint64{m_CmdQueueCount}) - 1) : ~Uint64{0};
     }
 
+    /// Implementation of IRenderDevice::CaptureResourceSnapshot() that adds the release queue statistics.
+    virtual void DILIGENT_CALL_TYPE CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects) override
+    {
+        TBase::CaptureResourceSnapshot(Snapshot, ppObjects);
+
+        for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
+        {
+            const auto& ReleaseQueue = m_CommandQueues[q].ReleaseQueue;
+            Snapshot.NumStaleResources += static_cast<Uint32>(ReleaseQueue.GetStaleResourceCount());
+            Snapshot.NumPendingReleaseResources += static_cast<Uint32>(ReleaseQueue.GetPendingReleaseResourceCount());
+        }
+    }
+
     void PurgeReleaseQueues(bool ForceRelease = false)
     {
         for (Uint32 q = 0; q < m_CmdQueueCount; ++q)
             PurgeReleaseQueue(SoftwareQueueIndex{q}, ForceRelease);
     }
 
+    // When the asynchronous resource release is enabled, resources are destroyed by the background
+    // thread, and the calling thread only compares the fence values. Force-release is always synchronous
+    // and also waits for the background thread to finish destroying previously purged resources.
     void PurgeReleaseQueue(SoftwareQueueIndex QueueInd, bool ForceRelease = false)
     {
+        DILIGENT_PROFILE_SCOPE("PurgeReleaseQueue");
+
         VERIFY_EXPR(QueueInd < m_CmdQueueCount);
         auto& Queue               = m_CommandQueues[QueueInd];
         auto  CompletedFenceValue = ForceRelease ? std::numeric_limits<Uint64>::max() : Queue.CmdQueue->GetCompletedFenceValue();
-        Queue.ReleaseQueue.Purge(CompletedFenceValue);
+        if (m_pResourceReleaseThread && !ForceRelease)
+        {
+            Queue.ReleaseQueue.Purge(CompletedFenceValue,
+                                     [this](ThreadPool::TaskType&& ReleaseTask) {
+                                         m_pResourceReleaseThread->EnqueueTask(std::move(ReleaseTask));
+                                     });
+        }
+        else
+        {
+            Queue.ReleaseQueue.Purge(CompletedFenceValue);
+            if (m_pResourceReleaseThread)
+                m_pResourceReleaseThread->WaitForAllTasks();
+        }
     }
 
     void IdleCommandQueue(SoftwareQueueIndex QueueInd, bool ReleaseResources)
@@ -181,6 +219,8 @@ public:
         {
             Queue.ReleaseQueue.DiscardStaleResources(CmdBufferNumber, FenceValue);
             Queue.ReleaseQueue.Purge(Queue.CmdQueue->GetCompletedFenceValue());
+            if (m_pResourceReleaseThread)
+                m_pResourceReleaseThread->WaitForAllTasks();
         }
     }
 
@@ -283,6 +323,9 @@ public:
 protected:
     void DestroyCommandQueues()
     {
+        // Release tasks reference the release queues, so the thread must be stopped first
+        m_pResourceReleaseThread.reset();
+
         if (m_CommandQueues != nullptr)
         {
             for (size_t q = 0; q < m_CmdQueueCount; ++q)
@@ -320,6 +363,9 @@ protected:
     };
     const size_t  m_CmdQueueCount = 0;
     CommandQueue* m_CommandQueues = nullptr;
+
+    // Background thread that destroys purged resources when EngineCreateInfo::AsyncResourceRelease is enabled
+    std::unique_ptr<ThreadPool> m_pResourceReleaseThread;
 };
 
 } // namespace Diligent
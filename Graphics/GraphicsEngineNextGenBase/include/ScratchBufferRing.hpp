@@ -0,0 +1,235 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ScratchBufferRing class
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "BasicTypes.h"
+#include "Buffer.h"
+#include "RefCntAutoPtr.hpp"
+#include "IndexWrapper.hpp"
+#include "PlatformMisc.hpp"
+#include "DebugUtilities.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+/// Suballocates acceleration structure build scratch space for a device context.
+
+/// The ring allocates scratch buffers (pages) through the render device and suballocates them linearly.
+/// All pages used during the frame are released by ReleasePages() when the context finishes the frame.
+/// If the pages were used by a single command queue, up to MaxRetainedSize bytes of them are retained
+/// and reused once the GPU has completed the command buffers that reference them, so that applications
+/// that build or refit acceleration structures every frame do not create scratch buffers every frame.
+/// Other pages are simply released; the device keeps the buffers alive until the GPU is done with them.
+template <typename RenderDeviceImplType>
+class ScratchBufferRing
+{
+public:
+    struct Allocation
+    {
+        IBuffer* pBuffer = nullptr;
+        Uint64   Offset  = 0;
+    };
+
+    ScratchBufferRing(RenderDeviceImplType& Device,
+                      Uint64                PageSize,
+                      Uint64                MaxRetainedSize) noexcept :
+        // clang-format off
+        m_Device         {Device         },
+        m_PageSize       {PageSize       },
+        m_MaxRetainedSize{MaxRetainedSize}
+    // clang-format on
+    {
+    }
+
+    // clang-format off
+    ScratchBufferRing            (const ScratchBufferRing&)  = delete;
+    ScratchBufferRing            (      ScratchBufferRing&&) = delete;
+    ScratchBufferRing& operator= (const ScratchBufferRing&)  = delete;
+    ScratchBufferRing& operator= (      ScratchBufferRing&&) = delete;
+    // clang-format on
+
+    ~ScratchBufferRing()
+    {
+        DEV_CHECK_ERR(m_Pages.empty(), "Not all scratch pages have been released");
+    }
+
+    /// Returns an allocation with null buffer if the page could not be created
+    Allocation Allocate(Uint64 SizeInBytes, Uint32 Alignment)
+    {
+        const Uint64 AlignmentU64 = std::max(Alignment, 1u);
+        VERIFY(IsPowerOfTwo(AlignmentU64), "Alignment (", AlignmentU64, ") must be power of two");
+
+        if (!m_Pages.empty())
+        {
+            auto&        CurrPage      = m_Pages.back();
+            const Uint64 AlignedOffset = AlignUp(m_CurrOffset, AlignmentU64);
+            if (AlignedOffset + SizeInBytes <= CurrPage.Size)
+            {
+                m_CurrOffset = AlignedOffset + SizeInBytes;
+                return Allocation{CurrPage.pBuffer, AlignedOffset};
+            }
+        }
+
+        auto Page = AcquirePage(AlignUp(SizeInBytes, AlignmentU64));
+        if (!Page.pBuffer)
+            return Allocation{};
+
+        m_Pages.emplace_back(std::move(Page));
+        m_CurrOffset = SizeInBytes;
+        return Allocation{m_Pages.back().pBuffer, 0};
+    }
+
+    /// Releases all pages used since the last call. All command buffers that use
+    /// the pages must have been submitted to the queues in CmdQueueMask at this point.
+    void ReleasePages(Uint64 CmdQueueMask)
+    {
+        if (m_Pages.empty())
+            return;
+
+        // Pages can only be retained if they were used by a single queue, in which case
+        // the last command buffer that references them has the last submitted fence value.
+        const bool RetainPages = m_MaxRetainedSize != 0 && PlatformMisc::CountOneBits(CmdQueueMask) == 1;
+
+        SoftwareQueueIndex QueueId{0};
+        Uint64             FenceValue = 0;
+        if (RetainPages)
+        {
+            QueueId    = SoftwareQueueIndex{PlatformMisc::GetLSB(CmdQueueMask)};
+            FenceValue = m_Device.GetNextFenceValue(QueueId) - 1;
+        }
+
+        for (auto& Page : m_Pages)
+        {
+            if (RetainPages && m_RetainedSize + Page.Size <= m_MaxRetainedSize)
+            {
+                m_RetainedSize += Page.Size;
+                m_RetainedPages.emplace_back(std::move(Page), QueueId, FenceValue);
+            }
+            // Otherwise the buffer is destroyed here, and the device defers the release
+            // of its resources until the GPU has finished the commands that use it.
+        }
+
+        m_Pages.clear();
+        m_CurrOffset = 0;
+    }
+
+    size_t GetPageCount() const { return m_Pages.size(); }
+    size_t GetRetainedPageCount() const { return m_RetainedPages.size(); }
+
+private:
+    struct PageInfo
+    {
+        RefCntAutoPtr<IBuffer> pBuffer;
+        Uint64                 Size = 0;
+    };
+
+    struct RetainedPageInfo
+    {
+        // clang-format off
+        RetainedPageInfo(PageInfo&&         _Page,
+                         SoftwareQueueIndex _QueueId,
+                         Uint64             _FenceValue) :
+            Page      {std::move(_Page)},
+            QueueId   {_QueueId        },
+            FenceValue{_FenceValue     }
+        {
+        }
+        // clang-format on
+
+        PageInfo           Page;
+        SoftwareQueueIndex QueueId;
+        // The page can be reused when this fence value is completed by the queue
+        Uint64 FenceValue = 0;
+    };
+
+    PageInfo AcquirePage(Uint64 SizeInBytes)
+    {
+        auto BestFit = m_RetainedPages.end();
+        for (auto it = m_RetainedPages.begin(); it != m_RetainedPages.end(); ++it)
+        {
+            if (it->Page.Size < SizeInBytes || (BestFit != m_RetainedPages.end() && it->Page.Size >= BestFit->Page.Size))
+                continue;
+
+            if (it->FenceValue <= m_Device.GetCompletedFenceValue(it->QueueId))
+                BestFit = it;
+        }
+
+        if (BestFit != m_RetainedPages.end())
+        {
+            auto Page = std::move(BestFit->Page);
+            m_RetainedPages.erase(BestFit);
+            m_RetainedSize -= Page.Size;
+            return Page;
+        }
+
+        PageInfo Page;
+        Page.Size = std::max(SizeInBytes, m_PageSize);
+        if (Page.Size > std::numeric_limits<Uint32>::max())
+        {
+            LOG_ERROR_MESSAGE("Requested scratch space size (", SizeInBytes, ") exceeds the maximum buffer size");
+            return PageInfo{};
+        }
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Acceleration structure scratch ring page";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = static_cast<Uint32>(Page.Size);
+        // Deferred contexts may be executed by any immediate context
+        const auto QueueCount         = m_Device.GetCommandQueueCount();
+        BuffDesc.ImmediateContextMask = QueueCount < 64 ? (Uint64{1} << QueueCount) - 1 : ~Uint64{0};
+
+        m_Device.CreateBuffer(BuffDesc, nullptr, &Page.pBuffer);
+        if (!Page.pBuffer)
+            LOG_ERROR_MESSAGE("Failed to create acceleration structure scratch ring page of size ", Page.Size);
+
+        return Page;
+    }
+
+    RenderDeviceImplType& m_Device;
+    const Uint64          m_PageSize;
+    const Uint64          m_MaxRetainedSize;
+
+    // Pages used since the last call to ReleasePages(); the last one is the current page
+    std::vector<PageInfo> m_Pages;
+    Uint64                m_CurrOffset = 0;
+
+    // Released pages that are kept for reuse
+    std::vector<RetainedPageInfo> m_RetainedPages;
+    Uint64                        m_RetainedSize = 0;
+};
+
+} // namespace Diligent
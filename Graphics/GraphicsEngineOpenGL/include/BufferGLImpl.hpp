@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "EngineGLImplTraits.hpp"
 #include "BufferBase.hpp"
 #include "BufferViewGLImpl.hpp" // Required by BufferBase
@@ -74,6 +76,17 @@ public:
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle() const { return m_GlBuffer; }
 
+    /// Implementation of IBufferGL::IsPersistentlyMapped().
+
+    /// Storage of a persistently mapped dynamic buffer is split into regions that are
+    /// cycled through when the buffer is mapped with MAP_FLAG_DISCARD. Staging buffers
+    /// always use a single region.
+    virtual Bool DILIGENT_CALL_TYPE IsPersistentlyMapped() const override final { return m_pPersistentData != nullptr; }
+
+    /// Returns the offset of the persistently mapped region that holds the current buffer contents.
+    /// The offset must be added to all offsets that are used to bind the buffer.
+    Uint32 GetPersistentRegionOffset() const { return m_CurrentRegion * m_PersistentRegionSize; }
+
     /// Implementation of IBufferGL::GetGLBufferHandle().
     virtual GLuint DILIGENT_CALL_TYPE GetGLBufferHandle() override final { return GetGLHandle(); }
 
@@ -86,12 +99,31 @@ public:
 private:
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
+    void InitPersistentStorage();
+    void MapPersistent(MAP_FLAGS MapFlags, Uint32 Offset, PVoid& pMappedData);
+
     friend class DeviceContextGLImpl;
     friend class VAOCache;
 
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+
+    // Dynamic buffers are allocated with glBufferStorage() and persistently mapped when
+    // the device supports it. The storage is a ring of regions, each large enough to hold
+    // the whole buffer. MAP_FLAG_DISCARD moves to the next region. The ring is split into
+    // NumPersistentChunks chunks; when the ring enters a new chunk, the previous chunk is
+    // protected with a fence, and the CPU waits for the fence of the chunk being entered.
+    // Staging buffers with CPU write access are persistently mapped the same way, but use
+    // a single region and are never synchronized by the engine.
+    static constexpr Uint32 NumPersistentChunks = 3;
+
+    Uint8* m_pPersistentData      = nullptr;
+    Uint32 m_PersistentRegionSize = 0;
+    Uint32 m_RegionsPerChunk      = 0;
+    Uint32 m_CurrentRegion        = 0;
+
+    std::array<GLObjectWrappers::GLSyncObj, NumPersistentChunks> m_ChunkFences;
 };
 
 void BufferGLImpl::BufferMemoryBarrier(MEMORY_BARRIER RequiredBarriers, GLContextState& GLState)
@@ -61,7 +61,7 @@ public:
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
     /// Implementation of IDeviceContext::Begin() in OpenGL backend.
-    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
+    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags) override final;
 
     /// Implementation of IDeviceContext::SetPipelineState() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
@@ -79,6 +79,9 @@ public:
     /// Implementation of IDeviceContext::SetBlendFactors() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE SetBlendFactors(const float* pBlendFactors = nullptr) override final;
 
+    /// Implementation of IDeviceContext::SetDynamicStates() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicStates(const DynamicStateAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetVertexBuffers() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
                                                      Uint32                         NumBuffersSet,
@@ -132,6 +135,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndirectCount() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in OpenGL backend.
@@ -189,6 +196,12 @@ public:
                                                   RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                                   RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextureRegions() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextureRegions(ITexture*                      pTexture,
+                                                         const TextureRegionUpdate*     pUpdates,
+                                                         Uint32                         NumUpdates,
+                                                         RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
+
     /// Implementation of IDeviceContext::CopyTexture() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
@@ -207,6 +220,9 @@ public:
     /// Implementation of IDeviceContext::GenerateMips() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override;
 
+    /// Implementation of IDeviceContext::GenerateMipsBatch() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews) override;
+
     /// Implementation of IDeviceContext::FinishFrame() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE FinishFrame() override final;
 
@@ -240,6 +256,15 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in OpenGL backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final { return False; }
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(IQuery* pQuery) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -249,6 +274,9 @@ public:
     /// Implementation of IDeviceContext::BuildTLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::CopyBLAS() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final;
 
@@ -294,6 +322,18 @@ public:
 
     virtual void DILIGENT_CALL_TYPE SetSwapChain(ISwapChainGL* pSwapChain) override final;
 
+    /// Implementation of IDeviceContextGL::GetStateCacheStatistics().
+    virtual void DILIGENT_CALL_TYPE GetStateCacheStatistics(GLStateCacheStatistics& Stats) override final
+    {
+        Stats = m_LastFrameStateCacheStats;
+    }
+
+    /// Implementation of IDeviceContextGL::BeginTextureCopyBatch().
+    virtual void DILIGENT_CALL_TYPE BeginTextureCopyBatch() override final;
+
+    /// Implementation of IDeviceContextGL::EndTextureCopyBatch().
+    virtual void DILIGENT_CALL_TYPE EndTextureCopyBatch() override final;
+
     virtual void ResetRenderTargets() override final;
 
 
@@ -308,6 +348,7 @@ private:
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, Uint32& FirstIndexByteOffset);
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
+    __forceinline void PrepareForIndirectDrawCount(IBuffer* pCountBuffer);
     __forceinline void PostDraw();
 
     using TBindings = PipelineResourceSignatureGLImpl::TBindings;
@@ -348,6 +389,9 @@ private:
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
+
+    // Context state cache statistics collected during the last finished frame
+    GLStateCacheStatistics m_LastFrameStateCacheStats;
 };
 
 } // namespace Diligent
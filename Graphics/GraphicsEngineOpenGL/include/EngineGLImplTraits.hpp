@@ -44,6 +44,7 @@
 #include "RenderPass.h"
 #include "Framebuffer.h"
 #include "PipelineResourceSignature.h"
+#include "PipelineStateCache.h"
 #include "DeviceContextGL.h"
 #include "BaseInterfacesGL.h"
 
@@ -68,6 +69,7 @@ class BottomLevelASGLImpl;
 class TopLevelASGLImpl;
 class ShaderBindingTableGLImpl;
 class PipelineResourceSignatureGLImpl;
+class PipelineStateCacheGLImpl;
 
 class FixedBlockMemoryAllocator;
 
@@ -93,6 +95,7 @@ struct EngineGLImplTraits
     using RenderPassInterface                = IRenderPass;
     using FramebufferInterface               = IFramebuffer;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
+    using PipelineStateCacheInterface        = IPipelineStateCache;
 
     using RenderDeviceImplType              = RenderDeviceGLImpl;
     using DeviceContextImplType             = DeviceContextGLImpl;
@@ -112,6 +115,7 @@ struct EngineGLImplTraits
     using TopLevelASImplType                = TopLevelASGLImpl;
     using ShaderBindingTableImplType        = ShaderBindingTableGLImpl;
     using PipelineResourceSignatureImplType = PipelineResourceSignatureGLImpl;
+    using PipelineStateCacheImplType        = PipelineStateCacheGLImpl;
 
     using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
     using TexViewObjAllocatorType  = FixedBlockMemoryAllocator;
@@ -27,10 +27,14 @@
 
 #pragma once
 
+#include <vector>
+
 #include "GraphicsTypes.h"
 #include "TextureView.h"
 #include "LockHelper.hpp"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
+#include "ObjectHandleTable.hpp"
 #include "GLObjectWrapper.hpp"
 
 namespace Diligent
@@ -42,7 +46,9 @@ class GLContextState;
 class FBOCache
 {
 public:
-    FBOCache();
+    // MaxSize - the maximum number of FBOs in the cache, or 0 if the size is not limited.
+    // MaxAge  - the number of frames after which an unused FBO is released, or 0 to disable age-based eviction.
+    FBOCache(Uint32 MaxSize = 0, Uint32 MaxAge = 0);
     ~FBOCache();
 
     // clang-format off
@@ -64,6 +70,12 @@ public:
 
     void OnReleaseTexture(ITexture* pTexture);
 
+    // Advances the frame counter and releases FBOs that have not been used for MaxAge frames.
+    void OnFinishFrame(GLContextState& ContextState);
+
+    // Adds the statistics of this cache to Stats
+    void GetStatistics(FramebufferCacheStatistics& Stats);
+
 private:
     // This structure is used as the key to find FBO
     struct FBOCacheKey
@@ -72,13 +84,13 @@ private:
 
         Uint32 NumRenderTargets = 0;
 
-        // Unique IDs of textures bound as render targets
-        UniqueIdentifier RTIds[MAX_RENDER_TARGETS] = {};
-        TextureViewDesc  RTVDescs[MAX_RENDER_TARGETS];
+        // Handles of textures bound as render targets
+        ObjectHandle    RTHandles[MAX_RENDER_TARGETS] = {};
+        TextureViewDesc RTVDescs[MAX_RENDER_TARGETS];
 
-        // Unique IDs of texture bound as depth stencil
-        UniqueIdentifier DSId    = 0;
-        TextureViewDesc  DSVDesc = {};
+        // Handle of texture bound as depth stencil
+        ObjectHandle    DSHandle = ObjectHandleTable::NullHandle;
+        TextureViewDesc DSVDesc  = {};
 
         mutable size_t Hash = 0;
 
@@ -91,13 +103,42 @@ private:
     };
 
 
+    struct FBOCacheEntry
+    {
+        FBOCacheEntry(GLObjectWrappers::GLFrameBufferObj&& _FBO, Uint64 Frame) :
+            FBO{std::move(_FBO)},
+            LastUsedFrame{Frame}
+        {}
+
+        GLObjectWrappers::GLFrameBufferObj FBO;
+
+        // The last frame in which the FBO was returned by GetFBO()
+        Uint64 LastUsedFrame;
+    };
+
+    using CacheType = FlatHashMap<FBOCacheKey, FBOCacheEntry, FBOCacheKeyHashFunc>;
+
+    bool CanEvict(const FBOCacheEntry& Entry, Uint64 MinAge, const GLContextState& ContextState) const;
+    void Evict(CacheType::iterator It);
+    void EvictLeastRecentlyUsed(size_t NumToEvict, const GLContextState& ContextState);
+
     friend class RenderDeviceGLImpl;
-    ThreadingTools::LockFlag                                                                 m_CacheLockFlag;
-    std::unordered_map<FBOCacheKey, GLObjectWrappers::GLFrameBufferObj, FBOCacheKeyHashFunc> m_Cache;
+    ThreadingTools::LockFlag m_CacheLockFlag;
+    CacheType                m_Cache;
+
+    // Keys of all FBOs that a texture is used in, indexed by the slot index of the texture handle.
+    // A texture removes its keys before its handle is released, so a slot never holds stale keys.
+    std::vector<std::vector<FBOCacheKey>> m_TexSlotToKeys;
+
+    std::vector<FBOCacheKey>& GetTextureKeys(ObjectHandle TexHandle);
+
+    const Uint32 m_MaxSize;
+    const Uint32 m_MaxAge;
 
-    // Multimap that sets up correspondence between unique texture id and all
-    // FBOs it is used in
-    std::unordered_multimap<UniqueIdentifier, FBOCacheKey> m_TexIdToKey;
+    Uint64 m_CurrentFrame = 0;
+    Uint64 m_NumHits      = 0;
+    Uint64 m_NumMisses    = 0;
+    Uint64 m_NumEvictions = 0;
 };
 
 } // namespace Diligent
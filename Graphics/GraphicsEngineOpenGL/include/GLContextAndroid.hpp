@@ -60,6 +60,12 @@ public:
     int32_t GetScreenWidth() const { return screen_width_; }
     int32_t GetScreenHeight() const { return screen_height_; }
 
+    // Worker context shares objects with the main context and may be made current in any thread
+    bool                HasWorkerContext() const { return worker_context_ != EGL_NO_CONTEXT; }
+    NativeGLContextType GetWorkerNativeGLContext() const { return worker_context_; }
+    bool                MakeWorkerContextCurrent();
+    void                ReleaseWorkerContext();
+
 private:
     //EGL configurations
     ANativeWindow* window_  = nullptr;
@@ -68,6 +74,10 @@ private:
     EGLContext     context_ = EGL_NO_CONTEXT;
     EGLConfig      config_;
 
+    EGLDisplay worker_display_ = EGL_NO_DISPLAY;
+    EGLSurface worker_surface_ = EGL_NO_SURFACE;
+    EGLContext worker_context_ = EGL_NO_CONTEXT;
+
     EGLint egl_major_version_ = 0;
     EGLint egl_minor_version_ = 0;
 
@@ -92,6 +102,8 @@ private:
     bool InitEGLSurface();
     bool InitEGLContext();
     void AttachToCurrentEGLContext();
+    void InitWorkerContext();
+    void DestroyWorkerContext();
 };
 
 } // namespace Diligent
@@ -44,9 +44,21 @@ public:
 
     NativeGLContextType GetCurrentNativeGLContext();
 
+    // Worker context shares objects with the main context and may be made current in any thread
+    bool                HasWorkerContext() const { return m_WorkerContext != nullptr; }
+    NativeGLContextType GetWorkerNativeGLContext() const { return m_WorkerContext; }
+    bool                MakeWorkerContextCurrent();
+    void                ReleaseWorkerContext();
+
 private:
+    void InitWorkerContext();
+
     Uint32 m_WindowId = 0;
     void*  m_pDisplay = nullptr;
+
+    NativeGLContextType m_WorkerContext  = nullptr;
+    GLXPbuffer          m_WorkerPbuffer  = 0;
+    void*               m_pWorkerDisplay = nullptr;
 };
 
 } // namespace Diligent
@@ -41,6 +41,12 @@ public:
               const struct SwapChainDesc*      pSCDesc);
 
     NativeGLContextType GetCurrentNativeGLContext();
+
+    // Worker context is not supported on this platform
+    bool                HasWorkerContext() const { return false; }
+    NativeGLContextType GetWorkerNativeGLContext() const { return nullptr; }
+    bool                MakeWorkerContextCurrent() { return false; }
+    void                ReleaseWorkerContext() {}
 };
 
 } // namespace Diligent
@@ -91,6 +91,16 @@ public:
     void SetNumPatchVertices(Int32 NumVertices);
     void Invalidate();
 
+    // When multi-bind is supported, texture, sampler, uniform buffer and storage block bindings
+    // made between BeginBindingBatch() and EndBindingBatch() are deferred. Runs of consecutive
+    // slots are then bound with a single glBindTextures/glBindSamplers/glBindBuffersRange call.
+    // Bindings that do not change the state are filtered out as usual.
+    void BeginBindingBatch();
+    void EndBindingBatch();
+
+    const GLStateCacheStatistics& GetStatistics() const { return m_Stats; }
+    void                          ResetStatistics() { m_Stats = {}; }
+
     void InvalidateVAO()
     {
         m_VAOId = -1;
@@ -104,6 +114,11 @@ public:
     }
     bool IsValidVAOBound() const { return m_VAOId > 0; }
 
+    bool IsFBOBound(const GLObjectWrappers::GLFrameBufferObj& FBO) const
+    {
+        return static_cast<GLuint>(FBO) != 0 && m_FBOId == FBO.GetUniqueID();
+    }
+
     void SetCurrentGLContext(GLContext::NativeGLContextType Context) { m_CurrentGLContext = Context; }
 
     GLContext::NativeGLContextType GetCurrentGLContext() const { return m_CurrentGLContext; }
@@ -114,6 +129,7 @@ public:
         GLint m_iMaxCombinedTexUnits      = 0;
         GLint m_iMaxDrawBuffers           = 0;
         GLint m_iMaxUniformBufferBindings = 0;
+        bool  bMultiBindSupported         = false;
     };
     const ContextCaps& GetContextCaps() { return m_Caps; }
 
@@ -206,6 +222,37 @@ private:
     std::vector<BoundImageInfo>   m_BoundImages;
     std::vector<BoundBufferInfo>  m_BoundStorageBlocks;
 
+    struct PendingBinding
+    {
+        Uint32     Index  = 0;
+        GLuint     Handle = 0;
+        GLenum     Target = 0;
+        GLintptr   Offset = 0;
+        GLsizeiptr Size   = 0;
+    };
+    void FlushPendingTextures();
+    void FlushPendingSamplers();
+    void FlushPendingBuffers(std::vector<PendingBinding>& PendingBuffers, GLenum Target);
+
+    bool                        m_BindingBatchActive = false;
+    std::vector<PendingBinding> m_PendingTextures;
+    std::vector<PendingBinding> m_PendingSamplers;
+    std::vector<PendingBinding> m_PendingUniformBuffers;
+    std::vector<PendingBinding> m_PendingStorageBlocks;
+
+    // Scratch arrays for multi-bind calls
+    std::vector<GLuint>     m_MultiBindHandles;
+    std::vector<GLintptr>   m_MultiBindOffsets;
+    std::vector<GLsizeiptr> m_MultiBindSizes;
+
+    GLStateCacheStatistics m_Stats;
+
+#ifdef DILIGENT_DEVELOPMENT
+    // Strict mode: verify filtered bindings against the actual GL state (see GL_VALIDATION_FLAG_VERIFY_STATE_CACHE)
+    bool m_VerifyStateCache = false;
+    void DvpVerifyBoundObject(GLenum Query, GLint Index, GLuint ExpectedHandle, const char* ObjectName);
+#endif
+
     MEMORY_BARRIER m_PendingMemoryBarriers = MEMORY_BARRIER_NONE;
 
     class EnableStateHelper
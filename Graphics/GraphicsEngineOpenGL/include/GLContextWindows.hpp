@@ -44,9 +44,20 @@ public:
 
     NativeGLContextType GetCurrentNativeGLContext();
 
+    // Worker context shares objects with the main context and may be made current in any thread
+    bool                HasWorkerContext() const { return m_WorkerContext != NULL; }
+    NativeGLContextType GetWorkerNativeGLContext() const { return m_WorkerContext; }
+    bool                MakeWorkerContextCurrent();
+    void                ReleaseWorkerContext();
+
 private:
+    void InitWorkerContext();
+
     HGLRC m_Context                     = NULL;
     HDC   m_WindowHandleToDeviceContext = NULL;
+
+    HGLRC m_WorkerContext = NULL;
+    HDC   m_WorkerDC      = NULL;
 };
 
 } // namespace Diligent
@@ -1173,6 +1173,38 @@ extern PFNGLFRAMEBUFFERTEXTURE3DPROC glFramebufferTexture3D;
 typedef void (GL_APIENTRY* PFNGLCOPYIMAGESUBDATAPROC) (GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth);
 extern PFNGLCOPYIMAGESUBDATAPROC glCopyImageSubData;
 
+#ifndef GL_ARB_buffer_storage
+#   define GL_ARB_buffer_storage 1
+#endif
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#   define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#   define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#define LOAD_GL_BUFFER_STORAGE
+typedef void (GL_APIENTRY* PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC glBufferStorage;
+
+#ifndef GL_ARB_vertex_attrib_binding
+#   define GL_ARB_vertex_attrib_binding 1
+#endif
+
+#define LOAD_GL_VERTEX_ATTRIB_BINDING
+typedef void (GL_APIENTRY* PFNGLBINDVERTEXBUFFERPROC) (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
+extern PFNGLBINDVERTEXBUFFERPROC glBindVertexBuffer;
+typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBFORMATPROC) (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset);
+extern PFNGLVERTEXATTRIBFORMATPROC glVertexAttribFormat;
+typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBIFORMATPROC) (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset);
+extern PFNGLVERTEXATTRIBIFORMATPROC glVertexAttribIFormat;
+typedef void (GL_APIENTRY* PFNGLVERTEXATTRIBBINDINGPROC) (GLuint attribindex, GLuint bindingindex);
+extern PFNGLVERTEXATTRIBBINDINGPROC glVertexAttribBinding;
+typedef void (GL_APIENTRY* PFNGLVERTEXBINDINGDIVISORPROC) (GLuint bindingindex, GLuint divisor);
+extern PFNGLVERTEXBINDINGDIVISORPROC glVertexBindingDivisor;
+
 #define LOAD_GL_TEX_STORAGE_3D_MULTISAMPLE
 typedef void (GL_APIENTRY* PFNGLTEXSTORAGE3DMULTISAMPLEPROC) (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations);
 extern PFNGLTEXSTORAGE3DMULTISAMPLEPROC glTexStorage3DMultisample;
@@ -54,6 +54,8 @@
 #define GL_PROGRAM_PIPELINE_BINDING GL_PROGRAM_PIPELINE_BINDING_EXT
 
 #define GL_ARB_shader_image_load_store      0
+#define GL_ARB_buffer_storage               0
+#define GL_ARB_vertex_attrib_binding        0
 #define GL_ARB_shader_storage_buffer_object 0
 #define GL_ARB_tessellation_shader          0
 #define GL_ARB_draw_indirect                0
@@ -0,0 +1,87 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheGLImpl class
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "EngineGLImplTraits.hpp"
+#include "DeviceObjectBase.hpp"
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+/// Pipeline state cache implementation in OpenGL backend.
+
+/// The cache stores program binaries retrieved with glGetProgramBinary(), keyed by the hash
+/// of the linked shader set, and restores them with glProgramBinary().
+class PipelineStateCacheGLImpl final : public DeviceObjectBase<IPipelineStateCache, RenderDeviceGLImpl, PipelineStateCacheDesc>
+{
+public:
+    using TDeviceObjectBase = DeviceObjectBase<IPipelineStateCache, RenderDeviceGLImpl, PipelineStateCacheDesc>;
+
+    PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceGLImpl*                 pDeviceGL,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheGLImpl();
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineStateCache, TDeviceObjectBase)
+
+    /// Implementation of IPipelineStateCache::GetData() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    // Creates the program from the binary stored under the given key.
+    // Returns null program if there is no such binary or if the driver rejected it.
+    GLObjectWrappers::GLProgramObj LoadProgram(size_t Key, bool IsSeparableProgram);
+
+    // Retrieves the binary of the linked program and stores it under the given key.
+    void StoreProgram(size_t Key, const GLObjectWrappers::GLProgramObj& GLProg);
+
+private:
+    bool Deserialize(const void* pData, size_t DataSize);
+
+    // Identifies the driver that produced the binaries
+    static size_t GetDriverHash();
+
+    struct ProgramBinary
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+
+    std::mutex                                m_BinariesMtx;
+    std::unordered_map<size_t, ProgramBinary> m_Binaries;
+};
+
+} // namespace Diligent
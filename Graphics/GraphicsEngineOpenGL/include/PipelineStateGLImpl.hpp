@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "EngineGLImplTraits.hpp"
@@ -37,6 +39,7 @@
 
 #include "GLObjectWrapper.hpp"
 #include "GLContext.hpp"
+#include "SeparableProgramCache.hpp"
 
 namespace Diligent
 {
@@ -60,8 +63,18 @@ public:
     /// Queries the specific interface, see IObject::QueryInterface() for details
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
 
+    /// Implementation of IPipelineState::GetStatus() in OpenGL backend.
+
+    /// For pipelines created with PSO_CREATE_FLAG_ASYNCHRONOUS flag, polls the driver and completes
+    /// the initialization when the programs have been linked. The initialization can only make progress
+    /// when the method is called from a thread that has a current GL context.
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus() const override final;
+
     void CommitProgram(GLContextState& State);
 
+    // Exchanges the shader objects with another compatible pipeline, see IPipelineState::SwapShaders().
+    void SwapShaderObjects(PipelineStateGLImpl& Other);
+
     using TBindings = PipelineResourceSignatureGLImpl::TBindings;
     const TBindings& GetBaseBindings(Uint32 Index) const
     {
@@ -84,8 +97,36 @@ private:
     template <typename PSOCreateInfoType>
     void InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages);
 
-    void InitResourceLayout(const TShaderStages& ShaderStages,
-                            SHADER_TYPE          ActiveStages);
+    void InitResourceLayout(const TShaderStages&      ShaderStages,
+                            SHADER_TYPE               ActiveStages,
+                            PipelineStateCacheGLImpl* pPSOCache);
+
+    // Creates the default signature, if necessary, and assigns the base bindings
+    void InitSignatures(const TShaderStages& ShaderStages,
+                        SHADER_TYPE          ActiveStages);
+
+    void ValidateResources(const TShaderStages& ShaderStages,
+                           SHADER_TYPE          ActiveStages);
+
+    // Takes the separable programs from the device cache and starts linking the missing ones
+    void BeginSeparablePrograms(const TShaderStages&                       ShaderStages,
+                                PipelineStateCacheGLImpl*                  pPSOCache,
+                                std::vector<size_t>&                       Keys,
+                                std::vector<ShaderGLImpl::PendingProgram>& PendingPrograms);
+
+    void FinishSeparablePrograms(const std::vector<size_t>&                 Keys,
+                                 std::vector<ShaderGLImpl::PendingProgram>& PendingPrograms);
+
+    // Completes the link of the non-separable program
+    void FinishProgram(ShaderGLImpl::PendingProgram&& Pending);
+
+    // Runs the next steps of the asynchronous initialization whose programs have been linked.
+    // Returns true when the initialization is complete.
+    bool AdvanceAsyncInitialization();
+
+    size_t ComputeSeparableProgramKey(const ShaderGLImpl& Shader) const;
+
+    void ApplyBindings(GLObjectWrappers::GLProgramObj& GLProgram, SHADER_TYPE Stages, GLContextState& CtxState);
 
     RefCntAutoPtr<PipelineResourceSignatureGLImpl> CreateDefaultSignature(
         const TShaderStages& ShaderStages,
@@ -99,11 +140,13 @@ private:
     void ValidateShaderResources(std::shared_ptr<const ShaderResourcesGL> pShaderResources, const char* ShaderName, SHADER_TYPE ShaderStages);
 
 private:
-    // Linked GL programs for every shader stage. Every pipeline needs to have its own programs
-    // because resource bindings assigned by PipelineResourceSignatureGLImpl::ApplyBindings depend on other
-    // shader stages.
-    using GLProgramObj         = GLObjectWrappers::GLProgramObj;
-    GLProgramObj* m_GLPrograms = nullptr; // [m_NumPrograms]
+    // Linked GL programs for every shader stage. Resource bindings assigned by
+    // PipelineResourceSignatureGLImpl::ApplyBindings depend on the pipeline's resource signatures,
+    // so separable programs are only shared through the device's SeparableProgramCache with
+    // pipelines that use the same shaders and resource bindings.
+    using GLProgramObj       = GLObjectWrappers::GLProgramObj;
+    using SharedGLProgramObj = SeparableProgramCache::SharedGLProgramObj;
+    SharedGLProgramObj* m_GLPrograms = nullptr; // [m_NumPrograms]
 
     ThreadingTools::LockFlag m_ProgPipelineLockFlag;
 
@@ -115,6 +158,20 @@ private:
 
     TBindings* m_BaseBindings = nullptr; // [m_SignatureCount]
 
+    enum class AsyncInitStep : Uint8
+    {
+        // Waiting for the shader programs that are used to load the shader resources
+        WaitShaderResources,
+
+        // Waiting for the pipeline programs
+        WaitPrograms
+    };
+    struct AsyncInitData;
+
+    // Initialization state of the pipeline created with PSO_CREATE_FLAG_ASYNCHRONOUS flag
+    std::unique_ptr<AsyncInitData> m_pAsyncInit;
+    mutable std::mutex             m_AsyncInitMtx;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages in the pipeline.
     std::vector<std::shared_ptr<const ShaderResourcesGL>> m_ShaderResources;
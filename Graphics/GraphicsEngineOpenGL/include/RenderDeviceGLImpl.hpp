@@ -28,6 +28,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "EngineGLImplTraits.hpp"
 #include "RenderDeviceBase.hpp"
@@ -35,11 +36,14 @@
 #include "VAOCache.hpp"
 #include "BaseInterfacesGL.h"
 #include "FBOCache.hpp"
+#include "SeparableProgramCache.hpp"
 #include "TexRegionRender.hpp"
 
 namespace Diligent
 {
 
+class GLContextState;
+
 /// Render device implementation in OpenGL backend.
 // RenderDeviceGLESImpl is inherited from RenderDeviceGLImpl
 class RenderDeviceGLImpl : public RenderDeviceBase<EngineGLImplTraits>
@@ -72,6 +76,11 @@ public:
     virtual void DILIGENT_CALL_TYPE CreateShader(const ShaderCreateInfo& ShaderCreateInfo,
                                                  IShader**               ppShader) override final;
 
+    /// Implementation of IRenderDevice::CreateShaders() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE CreateShaders(const ShaderCreateInfo* pShaderCIs,
+                                                  Uint32                  NumShaders,
+                                                  IShader**               ppShaders) override final;
+
     /// Implementation of IRenderDevice::CreateTexture() in OpenGL backend.
     void                            CreateTexture(const TextureDesc& TexDesc,
                                                   const TextureData* pData,
@@ -141,6 +150,10 @@ public:
                                          IPipelineResourceSignature**         ppSignature,
                                          bool                                 IsDeviceInternal);
 
+    /// Implementation of IRenderDevice::CreatePipelineStateCache() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                             IPipelineStateCache**               ppPSOCache) override final;
+
     /// Implementation of IRenderDeviceGL::CreateTextureFromGLHandle().
     virtual void DILIGENT_CALL_TYPE CreateTextureFromGLHandle(Uint32             GLHandle,
                                                               Uint32             GLBindTarget,
@@ -159,6 +172,12 @@ public:
                                                        RESOURCE_STATE     InitialState,
                                                        ITexture**         ppTexture) override final;
 
+    /// Implementation of IRenderDeviceGL::GetFramebufferCacheStatistics().
+    virtual void DILIGENT_CALL_TYPE GetFramebufferCacheStatistics(FramebufferCacheStatistics& Stats) override final;
+
+    /// Implementation of IRenderDevice::CaptureResourceSnapshot() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects) override final;
+
     /// Implementation of IRenderDevice::ReleaseStaleResources() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final {}
 
@@ -172,6 +191,8 @@ public:
     void      OnDestroyPSO(PipelineStateGLImpl& PSO);
     void      OnDestroyBuffer(BufferGLImpl& Buffer);
 
+    SeparableProgramCache& GetSeparableProgramCache() { return m_SeparableProgramCache; }
+
     size_t GetCommandQueueCount() const { return 1; }
     Uint64 GetCommandQueueMask() const { return Uint64{1}; }
 
@@ -183,11 +204,27 @@ public:
         GLint MaxTextureUnits;
         GLint MaxStorageBlock;
         GLint MaxImagesUnits;
+        // GL_ARB_buffer_storage or GL_EXT_buffer_storage is supported
+        bool BufferStorage;
+        // Separate vertex formats and buffer bindings are supported (GL4.3, GLES3.1 or GL_ARB_vertex_attrib_binding)
+        bool VertexAttribBinding;
+        // Shaders are compiled and programs are linked in background threads (GL_KHR_parallel_shader_compile)
+        bool ParallelShaderCompile;
     };
     const GLDeviceLimits& GetDeviceLimits() const { return m_DeviceLimits; }
 
+    GL_VALIDATION_FLAGS GetGLValidationFlags() const { return m_GLValidationFlags; }
+
     RefCntAutoPtr<IDeviceContext> GetImmediateContext() { return TRenderDeviceBase::GetImmediateContext(0); }
 
+    /// Returns the state of the GL context that is current in the calling thread: the worker
+    /// context state if the thread has acquired the worker context, and the immediate context
+    /// state otherwise.
+    GLContextState& GetActiveGLContextState();
+
+    /// Returns the native GL context that is current in the calling thread, or null if there is none.
+    GLContext::NativeGLContextType GetCurrentNativeGLContext() { return m_GLContext.GetCurrentNativeGLContext(); }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -209,9 +246,37 @@ protected:
     ThreadingTools::LockFlag                                     m_FBOCacheLockFlag;
     std::unordered_map<GLContext::NativeGLContextType, FBOCache> m_FBOCache;
 
+    SeparableProgramCache m_SeparableProgramCache;
+
+    const Uint32 m_FBOCacheMaxSize;
+    const Uint32 m_FBOCacheMaxAge;
+
+    const GL_VALIDATION_FLAGS m_GLValidationFlags;
+
     std::unique_ptr<TexRegionRender> m_pTexRegionRender;
 
 private:
+    // Makes the worker context current in the calling thread if the thread has no current
+    // GL context. When the scope ends, waits until the commands issued through the worker
+    // context have completed and releases the context.
+    class WorkerContextScope
+    {
+    public:
+        explicit WorkerContextScope(RenderDeviceGLImpl& Device);
+        ~WorkerContextScope();
+
+        // clang-format off
+        WorkerContextScope           (const WorkerContextScope&)  = delete;
+        WorkerContextScope           (      WorkerContextScope&&) = delete;
+        WorkerContextScope& operator=(const WorkerContextScope&)  = delete;
+        WorkerContextScope& operator=(      WorkerContextScope&&) = delete;
+        // clang-format on
+
+    private:
+        RenderDeviceGLImpl&          m_Device;
+        std::unique_lock<std::mutex> m_Lock;
+    };
+
     virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
     bool         CheckExtension(const Char* ExtensionString) const;
     void         FlagSupportedTexFormats();
@@ -220,6 +285,10 @@ private:
     int m_ShowDebugGLOutput = 1;
 
     GLDeviceLimits m_DeviceLimits = {};
+
+    // The worker context may only be current in one thread at a time
+    std::mutex                      m_WorkerContextMtx;
+    std::unique_ptr<GLContextState> m_pWorkerContextState;
 };
 
 } // namespace Diligent
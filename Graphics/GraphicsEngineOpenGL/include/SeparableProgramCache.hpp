@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+/// Device-wide cache of linked separable programs.
+
+/// A separable program is keyed by the hash of its shader source and the resource bindings
+/// that were applied to it, so pipelines that use the same shader with the same resource
+/// signatures share one program instead of linking their own copy.
+/// The cache does not keep the programs alive: a program is destroyed when the last pipeline
+/// that uses it is released. GL programs are shared between contexts, so one cache serves all of them.
+class SeparableProgramCache
+{
+public:
+    using SharedGLProgramObj = std::shared_ptr<GLObjectWrappers::GLProgramObj>;
+
+    SeparableProgramCache() = default;
+
+    // clang-format off
+    SeparableProgramCache             (const SeparableProgramCache&)  = delete;
+    SeparableProgramCache             (      SeparableProgramCache&&) = delete;
+    SeparableProgramCache& operator = (const SeparableProgramCache&)  = delete;
+    SeparableProgramCache& operator = (      SeparableProgramCache&&) = delete;
+    // clang-format on
+
+    /// Returns the program with the given key, or null if there is no such program in the cache.
+    SharedGLProgramObj Find(size_t Key);
+
+    /// Adds the program to the cache and returns the shared program object.
+    /// If another thread has added a program with the same key in the meantime,
+    /// that program is returned and the new one is released.
+    SharedGLProgramObj Add(size_t Key, GLObjectWrappers::GLProgramObj&& Program);
+
+private:
+    void PurgeExpired();
+
+    std::mutex m_Mtx;
+
+    std::unordered_map<size_t, std::weak_ptr<GLObjectWrappers::GLProgramObj>> m_Programs;
+
+    // The number of programs added since the last purge of the expired entries
+    size_t m_NumAddedSincePurge = 0;
+};
+
+} // namespace Diligent
@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <mutex>
+#include <vector>
+
 #include "EngineGLImplTraits.hpp"
 #include "ShaderBase.hpp"
 #include "GLObjectWrapper.hpp"
@@ -35,6 +38,8 @@
 namespace Diligent
 {
 
+class PipelineStateCacheGLImpl;
+
 /// Shader object implementation in OpenGL backend.
 class ShaderGLImpl final : public ShaderBase<EngineGLImplTraits>
 {
@@ -55,13 +60,82 @@ public:
     /// Implementation of IShader::GetResource() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
-    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+    /// Implementation of IShader::GetBytecode() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE GetBytecode(const void** ppBytecode, Uint64& Size) const override final
+    {
+        // OpenGL shaders are compiled from source and have no byte code
+        *ppBytecode = nullptr;
+        Size        = 0;
+    }
+
+    /// Program whose linking has been started by BeginLinkProgram().
+    struct PendingProgram
+    {
+        GLObjectWrappers::GLProgramObj Program{false};
+
+        // Shaders attached to the program; they are detached when the link completes
+        std::vector<const ShaderGLImpl*> Shaders;
+
+        PipelineStateCacheGLImpl* pPSOCache = nullptr;
+        size_t                    CacheKey  = 0;
+
+        // True if the program has been loaded from the PSO cache and is ready to use
+        bool IsFromCache = false;
+    };
+
+    /// Starts linking the program from the given shaders, but does not wait for the link to complete.
+    /// If pPSOCache is not null, the program binary is first looked up in the cache.
+    ///
+    /// \remarks When KHR_parallel_shader_compile is supported, the driver links the program in the
+    ///          background until the link status is queried by FinishLinkProgram(). Starting several
+    ///          links before finishing any of them lets the driver process them in parallel.
+    static PendingProgram BeginLinkProgram(ShaderGLImpl* const*      ppShaders,
+                                           Uint32                    NumShaders,
+                                           bool                      IsSeparableProgram,
+                                           PipelineStateCacheGLImpl* pPSOCache = nullptr);
+
+    /// Waits for the link started by BeginLinkProgram() to complete, checks the link status and
+    /// stores the newly linked program in the PSO cache, if one was given.
+    static GLObjectWrappers::GLProgramObj FinishLinkProgram(PendingProgram&& Pending);
 
-    const std::shared_ptr<const ShaderResourcesGL>& GetShaderResources() const { return m_pShaderResources; }
+    /// Returns true if the link started by BeginLinkProgram() has completed, so that
+    /// FinishLinkProgram() will not block. Requires KHR_parallel_shader_compile; returns
+    /// true if the extension is not supported.
+    static bool IsLinkComplete(const PendingProgram& Pending);
+
+    /// Links the program from the given shaders. If pPSOCache is not null, the program binary
+    /// is first looked up in the cache, and the newly linked program is stored in it otherwise.
+    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                      Uint32                    NumShaders,
+                                                      bool                      IsSeparableProgram,
+                                                      PipelineStateCacheGLImpl* pPSOCache = nullptr)
+    {
+        return FinishLinkProgram(BeginLinkProgram(ppShaders, NumShaders, IsSeparableProgram, pPSOCache));
+    }
+
+    /// Returns the hash of the full shader source that was passed to the driver.
+    size_t GetSourceHash() const { return m_SourceHash; }
+
+    /// Returns the shader resources. When separable programs are supported, the resources are
+    /// loaded from the program linked by the constructor the first time this method is called.
+    const std::shared_ptr<const ShaderResourcesGL>& GetShaderResources() const;
+
+    /// Returns true if GetShaderResources() will not block waiting for the driver.
+    bool AreShaderResourcesReady() const;
 
 private:
-    GLObjectWrappers::GLShaderObj            m_GLShaderObj;
-    std::shared_ptr<const ShaderResourcesGL> m_pShaderResources;
+    // Throws an exception if the shader has failed to compile
+    void VerifyCompileStatus() const;
+
+    GLObjectWrappers::GLShaderObj m_GLShaderObj;
+    size_t                        m_SourceHash = 0;
+
+    // True if the compile status has not been checked yet, see VerifyCompileStatus().
+    mutable bool m_IsCompileStatusPending = false;
+
+    mutable std::mutex                               m_ResourcesMtx;
+    mutable PendingProgram                           m_ResourcesProgram;
+    mutable std::shared_ptr<const ShaderResourcesGL> m_pShaderResources;
 };
 
 } // namespace Diligent
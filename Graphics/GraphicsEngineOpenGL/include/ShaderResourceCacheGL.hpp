@@ -71,12 +71,12 @@ public:
         Uint32 RangeSize     = 0;
         Uint32 DynamicOffset = 0;
 
-        // In OpenGL dynamic buffers are only those that are not bound as a whole and
-        // can use a dynamic offset, irrespective of the variable type or whether the
-        // buffer is USAGE_DYNAMIC or not.
+        // In OpenGL dynamic buffers are those that are not bound as a whole and
+        // can use a dynamic offset, irrespective of the variable type, as well as
+        // persistently mapped USAGE_DYNAMIC buffers whose region changes on every discard.
         bool IsDynamic() const
         {
-            return pBuffer && RangeSize < pBuffer->GetDesc().uiSizeInBytes;
+            return pBuffer && (RangeSize < pBuffer->GetDesc().uiSizeInBytes || pBuffer->IsPersistentlyMapped());
         }
     };
 
@@ -27,15 +27,23 @@
 
 #pragma once
 
+#include <unordered_map>
+
 namespace Diligent
 {
 
-// Helper class to facilitate texture copying by rendering
+// Helper class to facilitate texture copying by rendering or by a compute shader
 class TexRegionRender
 {
 public:
     TexRegionRender(class RenderDeviceGLImpl* pDeviceGL);
-    void SetStates(class DeviceContextGLImpl* pCtxGL);
+
+    // Saves the context states that are modified by the copy operations. Calls may be nested,
+    // in which case the states are only saved by the outermost call and restored by the matching
+    // RestoreStates() call. This allows batching multiple copies into a single save/restore pair.
+    // If SaveRenderTargets is false, only the pipeline state is saved. Render targets and viewports
+    // will then be saved by the first nested call that requests them.
+    void SetStates(class DeviceContextGLImpl* pCtxGL, bool SaveRenderTargets = true);
     void RestoreStates(class DeviceContextGLImpl* pCtxGL);
 
     void Render(class DeviceContextGLImpl* pCtxGL,
@@ -47,7 +55,49 @@ public:
                 Int32                      SrcZ,
                 Int32                      SrcMipLevel);
 
+    // Returns true if the region can be copied by the compute shader
+    bool IsComputeCopySupported(RESOURCE_DIMENSION SrcTexType,
+                                TEXTURE_FORMAT     SrcFormat,
+                                RESOURCE_DIMENSION DstTexType,
+                                TEXTURE_FORMAT     DstFormat) const;
+
+    // Copies the region to the destination image using the compute shader.
+    // The destination view must address a single slice of the destination mip level.
+    void Dispatch(class DeviceContextGLImpl* pCtxGL,
+                  ITextureView*              pSrcSRV,
+                  ITextureView*              pDstUAV,
+                  RESOURCE_DIMENSION         SrcTexType,
+                  TEXTURE_FORMAT             DstFormat,
+                  Int32                      SrcX,
+                  Int32                      SrcY,
+                  Int32                      SrcZ,
+                  Int32                      SrcMipLevel,
+                  Int32                      DstX,
+                  Int32                      DstY,
+                  Uint32                     Width,
+                  Uint32                     Height);
+
 private:
+    struct ComputeCopyPSO
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        IShaderResourceVariable*              pSrcTexVar = nullptr;
+        IShaderResourceVariable*              pDstImgVar = nullptr;
+    };
+    ComputeCopyPSO& GetComputeCopyPSO(RESOURCE_DIMENSION SrcTexType, TEXTURE_FORMAT DstFormat);
+
+    RenderDeviceGLImpl* const m_pDeviceGL;
+    const bool                m_ComputeCopySupported;
+
+    RefCntAutoPtr<IBuffer> m_pComputeConstantBuffer;
+
+    // Compute copy PSOs are created on first use, keyed by source dimension and destination format
+    std::unordered_map<Uint32, ComputeCopyPSO> m_ComputeCopyPSOs;
+
+    Uint32 m_StateSaveDepth     = 0;
+    bool   m_RenderTargetsSaved = false;
+
     RefCntAutoPtr<IShader> m_pVertexShader;
     RefCntAutoPtr<IShader> m_pFragmentShaders[RESOURCE_DIM_NUM_DIMENSIONS * 3];
     RefCntAutoPtr<IBuffer> m_pConstantBuffer;
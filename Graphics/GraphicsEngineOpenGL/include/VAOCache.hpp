@@ -28,6 +28,7 @@
 #pragma once
 
 #include <cstring>
+#include <array>
 #include <vector>
 #include <unordered_map>
 
@@ -36,6 +37,7 @@
 #include "InputLayout.h"
 #include "LockHelper.hpp"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
 #include "DeviceContextBase.hpp"
 
 namespace Diligent
@@ -47,7 +49,10 @@ class BufferGLImpl;
 class VAOCache
 {
 public:
-    VAOCache();
+    // When UseVertexAttribBinding is true (requires GL4.3, GLES3.1 or GL_ARB_vertex_attrib_binding),
+    // the cache creates one VAO per input layout, and vertex and index buffers are bound to the VAO
+    // when it is requested. Otherwise, every combination of PSO and buffers gets its own VAO.
+    explicit VAOCache(bool UseVertexAttribBinding);
     ~VAOCache();
 
     // clang-format off
@@ -71,6 +76,9 @@ public:
     void OnDestroyBuffer(const BufferGLImpl& Buffer);
     void OnDestroyPSO(const PipelineStateGLImpl& PSO);
 
+    // Returns the number of VAOs in the cache, including the layout VAOs
+    Uint32 GetNumVAOs();
+
 private:
     // This structure is used as the key to find VAO
     struct VAOHashKey
@@ -120,11 +128,87 @@ private:
     // Clears stale entries from m_PSOToKey and m_BuffToKey when a VAO is removed from m_Cache
     void ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys);
 
-    ThreadingTools::LockFlag                                                               m_CacheLockFlag;
-    std::unordered_map<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
+    const GLObjectWrappers::GLVertexArrayObj& GetLayoutVAO(const VAOAttribs&     Attribs,
+                                                           class GLContextState& GLContextState);
+
+    // Key that identifies the vertex attribute format of an input layout.
+    // Buffer strides are not part of the format as they are set by glBindVertexBuffer().
+    struct LayoutKey
+    {
+        explicit LayoutKey(const InputLayoutDesc& InputLayout);
+
+        struct Element
+        {
+            Uint32     InputIndex;
+            Uint32     BufferSlot;
+            Uint32     NumComponents;
+            VALUE_TYPE ValueType;
+            bool       IsNormalized;
+            Uint32     RelativeOffset;
+            Uint32     InstanceDataStepRate; // 0 for per-vertex elements
+
+            bool operator==(const Element& rhs) const
+            {
+                // clang-format off
+                return InputIndex           == rhs.InputIndex     &&
+                       BufferSlot           == rhs.BufferSlot     &&
+                       NumComponents        == rhs.NumComponents  &&
+                       ValueType            == rhs.ValueType      &&
+                       IsNormalized         == rhs.IsNormalized   &&
+                       RelativeOffset       == rhs.RelativeOffset &&
+                       InstanceDataStepRate == rhs.InstanceDataStepRate;
+                // clang-format on
+            }
+        };
+        std::vector<Element> Elements;
+
+        size_t Hash = 0;
+
+        bool operator==(const LayoutKey& Key) const
+        {
+            return Hash == Key.Hash && Elements == Key.Elements;
+        }
+
+        struct Hasher
+        {
+            std::size_t operator()(const LayoutKey& Key) const
+            {
+                return Key.Hash;
+            }
+        };
+    };
+
+    // VAO shared by all PSOs with the same input layout, and
+    // the buffers that are currently bound to its binding points.
+    struct LayoutVAO
+    {
+        GLObjectWrappers::GLVertexArrayObj VAO{true};
+
+        struct BoundStream
+        {
+            UniqueIdentifier BufferUId = -1;
+            Uint32           Offset    = 0;
+            Uint32           Stride    = 0;
+        };
+        std::array<BoundStream, MAX_BUFFER_SLOTS> Streams;
+
+        UniqueIdentifier IndexBufferUId = -1;
+    };
+
+    const bool m_UseVertexAttribBinding;
+
+    ThreadingTools::LockFlag                                                        m_CacheLockFlag;
+    FlatHashMap<VAOHashKey, GLObjectWrappers::GLVertexArrayObj, VAOHashKey::Hasher> m_Cache;
+
+    // Keys of all VAOs that use the given PSO or buffer
+    using IdToKeysMapType = FlatHashMap<UniqueIdentifier, std::vector<VAOHashKey>>;
+    IdToKeysMapType m_PSOToKey;
+    IdToKeysMapType m_BuffToKey;
 
-    std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_PSOToKey;
-    std::unordered_multimap<UniqueIdentifier, VAOHashKey> m_BuffToKey;
+    // Layout VAOs are never released as their number is bounded by the number of distinct input layouts
+    std::unordered_map<LayoutKey, LayoutVAO, LayoutKey::Hasher> m_LayoutCache;
+    // PSO -> layout VAO shortcut that avoids hashing the input layout on every request
+    FlatHashMap<UniqueIdentifier, LayoutVAO*> m_PSOToLayoutVAO;
 
     // Any draw command fails if no VAO is bound. We will use this empty
     // VAO for draw commands with null input layout, such as these that
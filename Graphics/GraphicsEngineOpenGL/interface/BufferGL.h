@@ -50,6 +50,16 @@ DILIGENT_BEGIN_INTERFACE(IBufferGL, IBuffer)
 {
     /// Returns OpenGL buffer handle
     VIRTUAL GLuint METHOD(GetGLBufferHandle)(THIS) PURE;
+
+    /// Returns true if the buffer storage is persistently mapped.
+
+    /// \remarks Dynamic buffers and staging buffers with CPU_ACCESS_WRITE flag are allocated with
+    ///          glBufferStorage() and persistently mapped when the device supports it.
+    ///          MapBuffer() always returns the same pointer for a persistently mapped staging
+    ///          buffer, and the pointer remains valid after UnmapBuffer(). The engine does not
+    ///          synchronize the CPU writes with the GPU: the application must use fences to make
+    ///          sure the GPU is done reading the data it overwrites.
+    VIRTUAL Bool METHOD(IsPersistentlyMapped)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -57,7 +67,8 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define IBufferGL_GetGLBufferHandle(This) CALL_IFACE_METHOD(BufferGL, GetGLBufferHandle, This)
+#    define IBufferGL_GetGLBufferHandle(This)    CALL_IFACE_METHOD(BufferGL, GetGLBufferHandle,    This)
+#    define IBufferGL_IsPersistentlyMapped(This) CALL_IFACE_METHOD(BufferGL, IsPersistentlyMapped, This)
 
 #endif
 
@@ -65,6 +65,30 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextGL, IDeviceContext)
     /// to obtain the default FBO handle.
     VIRTUAL void METHOD(SetSwapChain)(THIS_
                                       struct ISwapChainGL* pSwapChain) PURE;
+
+    /// Returns the context state cache statistics for the last finished frame.
+
+    /// \param [out] Stats - State cache statistics, see Diligent::GLStateCacheStatistics.
+    ///
+    /// \remarks Frames are counted by IDeviceContext::FinishFrame(). The statistics show
+    ///          how many texture, sampler, buffer and image bindings were sent to the driver
+    ///          and how many were filtered out as redundant.
+    VIRTUAL void METHOD(GetStateCacheStatistics)(THIS_
+                                                 GLStateCacheStatistics REF Stats) PURE;
+
+    /// Begins a batch of texture copy operations.
+
+    /// \remarks When glCopyImageSubData is not available, IDeviceContext::CopyTexture() copies
+    ///          texture regions by rendering or by a compute shader, and has to save and restore
+    ///          the pipeline state, render targets and viewports for every copy. Within a batch,
+    ///          the states are saved once and restored by EndTextureCopyBatch().
+    ///          Only texture copy commands may be recorded between BeginTextureCopyBatch()
+    ///          and EndTextureCopyBatch(). Batches may be nested.
+    VIRTUAL void METHOD(BeginTextureCopyBatch)(THIS) PURE;
+
+    /// Ends the batch of texture copy operations started by BeginTextureCopyBatch()
+    /// and restores the context states.
+    VIRTUAL void METHOD(EndTextureCopyBatch)(THIS) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -74,8 +98,11 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IDeviceContextGL_UpdateCurrentGLContext(This) CALL_IFACE_METHOD(DeviceContextGL, UpdateCurrentGLContext, This)
-#    define IDeviceContextGL_SetSwapChain(This, ...)      CALL_IFACE_METHOD(DeviceContextGL, SetSwapChain,           This, __VA_ARGS__)
+#    define IDeviceContextGL_UpdateCurrentGLContext(This)       CALL_IFACE_METHOD(DeviceContextGL, UpdateCurrentGLContext,  This)
+#    define IDeviceContextGL_SetSwapChain(This, ...)            CALL_IFACE_METHOD(DeviceContextGL, SetSwapChain,            This, __VA_ARGS__)
+#    define IDeviceContextGL_GetStateCacheStatistics(This, ...) CALL_IFACE_METHOD(DeviceContextGL, GetStateCacheStatistics, This, __VA_ARGS__)
+#    define IDeviceContextGL_BeginTextureCopyBatch(This)        CALL_IFACE_METHOD(DeviceContextGL, BeginTextureCopyBatch,   This)
+#    define IDeviceContextGL_EndTextureCopyBatch(This)          CALL_IFACE_METHOD(DeviceContextGL, EndTextureCopyBatch,     This)
 
 // clang-format on
 
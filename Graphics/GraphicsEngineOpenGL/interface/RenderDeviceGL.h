@@ -113,6 +113,17 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceGL, IRenderDevice)
                                             const TextureDesc REF TexDesc,
                                             RESOURCE_STATE        InitialState,
                                             ITexture**            ppTexture) PURE;
+
+
+    /// Returns the combined statistics of the FBO caches of all GL contexts.
+
+    /// \param [out] Stats - Framebuffer cache statistics, see Diligent::FramebufferCacheStatistics.
+    ///
+    /// \remarks The cache size and the frame age after which unused FBOs are released
+    ///          are controlled by EngineGLCreateInfo::FramebufferCacheSize and
+    ///          EngineGLCreateInfo::FramebufferCacheMaxAge.
+    VIRTUAL void METHOD(GetFramebufferCacheStatistics)(THIS_
+                                                       FramebufferCacheStatistics REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -125,6 +136,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceGL_CreateTextureFromGLHandle(This, ...)CALL_IFACE_METHOD(RenderDeviceGL, CreateTextureFromGLHandle, This, __VA_ARGS__)
 #    define IRenderDeviceGL_CreateBufferFromGLHandle(This, ...) CALL_IFACE_METHOD(RenderDeviceGL, CreateBufferFromGLHandle,  This, __VA_ARGS__)
 #    define IRenderDeviceGL_CreateDummyTexture(This, ...)       CALL_IFACE_METHOD(RenderDeviceGL, CreateDummyTexture,        This, __VA_ARGS__)
+#    define IRenderDeviceGL_GetFramebufferCacheStatistics(This, ...) CALL_IFACE_METHOD(RenderDeviceGL, GetFramebufferCacheStatistics, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -27,6 +27,8 @@
 
 #include "pch.h"
 
+#include <limits>
+
 #include "BufferGLImpl.hpp"
 
 #include "RenderDeviceGLImpl.hpp"
@@ -34,6 +36,7 @@
 
 #include "GLTypeConversions.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -69,6 +72,22 @@ static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 
     return Target;
 }
+
+static bool UsePersistentStorage(const RenderDeviceGLImpl* pDeviceGL, const BufferDesc& Desc, const BufferData* pBuffData)
+{
+    // Buffers bound through views or used as indirect arguments can't be offset
+    // by the persistent region, so only vertex, index and uniform buffers are eligible.
+    constexpr BIND_FLAGS AllowedBindFlags = BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER | BIND_UNIFORM_BUFFER;
+
+    const bool IsEligibleDynamic = Desc.Usage == USAGE_DYNAMIC && (Desc.BindFlags & ~AllowedBindFlags) == 0;
+    // Upload staging buffers are written by the CPU and are only read by the GPU through copies
+    const bool IsEligibleStaging = Desc.Usage == USAGE_STAGING && Desc.CPUAccessFlags == CPU_ACCESS_WRITE;
+
+    return ((IsEligibleDynamic || IsEligibleStaging) &&
+            (pBuffData == nullptr || pBuffData->pData == nullptr) &&
+            pDeviceGL->GetDeviceLimits().BufferStorage);
+}
+
 BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
                            FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                            RenderDeviceGLImpl*        pDeviceGL,
@@ -153,8 +172,15 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
 
     // All buffer bind targets (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER etc.) relate to the same
     // kind of objects. As a result they are all equivalent from a transfer point of view.
-    glBufferData(m_BindTarget, DataSize, pData, m_GLUsageHint);
-    CHECK_GL_ERROR_AND_THROW("glBufferData() failed");
+    if (UsePersistentStorage(pDeviceGL, m_Desc, pBuffData))
+    {
+        InitPersistentStorage();
+    }
+    else
+    {
+        glBufferData(m_BindTarget, DataSize, pData, m_GLUsageHint);
+        CHECK_GL_ERROR_AND_THROW("glBufferData() failed");
+    }
     GLState.BindBuffer(m_BindTarget, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
 
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
@@ -216,6 +242,38 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
 }
 
+void BufferGLImpl::InitPersistentStorage()
+{
+#if GL_ARB_buffer_storage
+    // Small buffers (typically constant buffers updated for every draw call) get many regions
+    // per chunk, so that the CPU only synchronizes with the GPU once per chunk rather than
+    // on every discard.
+    static constexpr Uint32 MinPersistentChunkSize = 16 << 10;
+
+    const auto& BufferProps = GetDevice()->GetAdapterInfo().Buffer;
+
+    const bool IsStaging = m_Desc.Usage == USAGE_STAGING;
+
+    m_PersistentRegionSize = AlignUp(m_Desc.uiSizeInBytes, BufferProps.ConstantBufferOffsetAlignment);
+    m_RegionsPerChunk      = IsStaging ? 1 : std::max(MinPersistentChunkSize / m_PersistentRegionSize, 1u);
+    m_CurrentRegion        = 0;
+
+    const auto StorageSize = static_cast<GLsizeiptr>(m_PersistentRegionSize) * m_RegionsPerChunk * (IsStaging ? 1 : NumPersistentChunks);
+
+    constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(m_BindTarget, StorageSize, nullptr, StorageFlags);
+    CHECK_GL_ERROR_AND_THROW("glBufferStorage() failed");
+
+    // Coherent mapping makes CPU writes visible to the GPU without explicit flushes or barriers
+    m_pPersistentData = static_cast<Uint8*>(glMapBufferRange(m_BindTarget, 0, StorageSize, StorageFlags));
+    CHECK_GL_ERROR_AND_THROW("Failed to persistently map buffer '", m_Desc.Name, "'");
+    if (m_pPersistentData == nullptr)
+        LOG_ERROR_AND_THROW("glMapBufferRange() returned null pointer for buffer '", m_Desc.Name, "'");
+#else
+    LOG_ERROR_AND_THROW("Persistent buffer mapping is not supported");
+#endif
+}
+
 BufferGLImpl::~BufferGLImpl()
 {
     GetDevice()->OnDestroyBuffer(*this);
@@ -263,7 +321,7 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
-    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, SrcOffset, DstOffset, Size);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, SrcOffset + SrcBufferGL.GetPersistentRegionOffset(), DstOffset, Size);
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -274,8 +332,56 @@ void BufferGLImpl::Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFla
     MapRange(CtxState, MapType, MapFlags, 0, m_Desc.uiSizeInBytes, pMappedData);
 }
 
+void BufferGLImpl::MapPersistent(MAP_FLAGS MapFlags, Uint32 Offset, PVoid& pMappedData)
+{
+    if (m_Desc.Usage == USAGE_STAGING)
+    {
+        // Similar to other backends, staging buffers are not synchronized: the application
+        // must use fences to make sure the GPU has finished reading the data.
+    }
+    else if (MapFlags & MAP_FLAG_DISCARD)
+    {
+        const auto TotalRegions = m_RegionsPerChunk * NumPersistentChunks;
+        const auto NextRegion   = (m_CurrentRegion + 1) % TotalRegions;
+        if ((NextRegion % m_RegionsPerChunk) == 0)
+        {
+            // Protect all regions of the current chunk that may still be used by the GPU
+            m_ChunkFences[m_CurrentRegion / m_RegionsPerChunk] = GLObjectWrappers::GLSyncObj{glFenceSync(
+                GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+                0                              // Flags, must be 0
+                )};
+            DEV_CHECK_GL_ERROR("Failed to create gl fence");
+
+            // Wait until the GPU is done with the chunk we are about to overwrite.
+            // This only blocks when the CPU is more than two chunks ahead of the GPU.
+            auto& ChunkFence = m_ChunkFences[NextRegion / m_RegionsPerChunk];
+            if (ChunkFence != GLsync{})
+            {
+                auto res = glClientWaitSync(ChunkFence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+                VERIFY_EXPR(res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED);
+                (void)res;
+                ChunkFence.Release();
+            }
+        }
+        m_CurrentRegion = NextRegion;
+    }
+    else
+    {
+        VERIFY((MapFlags & MAP_FLAG_NO_OVERWRITE) != 0, "Persistently mapped buffers can only be mapped with MAP_FLAG_DISCARD or MAP_FLAG_NO_OVERWRITE flag");
+    }
+
+    pMappedData = m_pPersistentData + GetPersistentRegionOffset() + Offset;
+}
+
 void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, Uint32 Offset, Uint32 Length, PVoid& pMappedData)
 {
+    if (IsPersistentlyMapped())
+    {
+        VERIFY(MapType == MAP_WRITE, "Persistently mapped buffers can only be mapped for writing");
+        MapPersistent(static_cast<MAP_FLAGS>(MapFlags), Offset, pMappedData);
+        return;
+    }
+
     BufferMemoryBarrier(
         MEMORY_BARRIER_CLIENT_MAPPED_BUFFER, // Access by the client to persistent mapped regions of buffer
                                              // objects will reflect data written by shaders prior to the barrier.
@@ -337,6 +443,12 @@ void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 M
 
 void BufferGLImpl::Unmap(GLContextState& CtxState)
 {
+    if (IsPersistentlyMapped())
+    {
+        // Persistently mapped buffers are never unmapped
+        return;
+    }
+
     constexpr bool ResetVAO = true;
     CtxState.BindBuffer(m_BindTarget, m_GlBuffer, ResetVAO);
     auto Result = glUnmapBuffer(m_BindTarget);
@@ -370,9 +482,7 @@ void BufferGLImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBuffe
         auto& BuffViewAllocator = pDeviceGLImpl->GetBuffViewObjAllocator();
         VERIFY(&BuffViewAllocator == &m_dbgBuffViewAllocator, "Buff view allocator does not match allocator provided at buffer initialization");
 
-        auto pContext = pDeviceGLImpl->GetImmediateContext();
-        VERIFY(pContext, "Immediate context has been released");
-        auto& CtxState = pContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+        auto& CtxState = pDeviceGLImpl->GetActiveGLContextState();
 
         *ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewGLImpl instance", BufferViewGLImpl, bIsDefaultView ? this : nullptr)(pDeviceGLImpl, CtxState, ViewDesc, this, bIsDefaultView);
 
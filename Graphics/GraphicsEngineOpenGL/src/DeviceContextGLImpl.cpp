@@ -79,10 +79,11 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
 IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
 
 
-void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
+void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags)
 {
     UNEXPECTED("OpenGL does not support deferred contexts");
     (void)(ImmediateContextId);
+    (void)(Flags);
 }
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
@@ -204,6 +205,15 @@ void DeviceContextGLImpl::SetBlendFactors(const float* pBlendFactors)
     }
 }
 
+void DeviceContextGLImpl::SetDynamicStates(const DynamicStateAttribs& Attribs)
+{
+    if (TDeviceContextBase::SetDynamicStates(Attribs, 0))
+    {
+        // Pipelines with dynamic states can't be created when DynamicPipelineStates feature is disabled
+        UNEXPECTED("Dynamic pipeline states are not supported in this backend");
+    }
+}
+
 void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartSlot,
                                            Uint32                         NumBuffersSet,
                                            IBuffer**                      ppBuffers,
@@ -640,7 +650,7 @@ void DeviceContextGLImpl::EndRenderPass()
 #ifdef DILIGENT_DEVELOPMENT
 void DeviceContextGLImpl::DvpValidateCommittedShaderResources()
 {
-    if (m_BindInfo.ResourcesValidated)
+    if (m_BindInfo.ResourcesValidated || !m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_RESOURCE_BINDING))
         return;
 
     DvpVerifySRBCompatibility(m_BindInfo);
@@ -737,7 +747,7 @@ void DeviceContextGLImpl::PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenu
     if (!m_ContextState.IsValidVAOBound())
     {
         auto& VaoCache     = m_pDevice->GetVAOCache(CurrNativeGLContext);
-        auto* pIndexBuffer = IsIndexed ? m_pIndexBuffer.RawPtr() : nullptr;
+        auto* pIndexBuffer = IsIndexed ? m_pIndexBuffer : nullptr;
         if (PipelineDesc.InputLayout.NumElements > 0 || pIndexBuffer != nullptr)
         {
             VAOCache::VAOAttribs vaoAttribs //
@@ -783,7 +793,7 @@ void DeviceContextGLImpl::PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 Fir
     VERIFY(GLIndexType == GL_UNSIGNED_BYTE || GLIndexType == GL_UNSIGNED_SHORT || GLIndexType == GL_UNSIGNED_INT,
            "Unsupported index type");
     VERIFY(m_pIndexBuffer, "Index Buffer is not bound to the pipeline");
-    FirstIndexByteOffset = static_cast<Uint32>(GetValueSize(IndexType)) * FirstIndexLocation + m_IndexDataStartOffset;
+    FirstIndexByteOffset = static_cast<Uint32>(GetValueSize(IndexType)) * FirstIndexLocation + m_IndexDataStartOffset + m_pIndexBuffer->GetPersistentRegionOffset();
 }
 
 void DeviceContextGLImpl::PostDraw()
@@ -799,6 +809,7 @@ void DeviceContextGLImpl::PostDraw()
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 {
     DvpVerifyDrawArguments(Attribs);
+    CountDrawCommand();
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, false, GlTopology);
@@ -822,6 +833,7 @@ void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
     DvpVerifyDrawIndexedArguments(Attribs);
+    CountDrawCommand();
 
     GLenum GlTopology;
     PrepareForDraw(Attribs.Flags, true, GlTopology);
@@ -885,6 +897,9 @@ void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer)
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
 #if GL_ARB_draw_indirect
     GLenum GlTopology;
@@ -899,9 +914,31 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
     //   GLuint  first;
     //   GLuint  baseInstance;
     //} DrawArraysIndirectCommand;
-    glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
-    // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
-    DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+    if (Attribs.DrawCount > 1)
+    {
+#if GL_ARB_multi_draw_indirect
+        if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) != 0)
+        {
+            glMultiDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)), Attribs.DrawCount, Attribs.DrawArgsStride);
+            DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirect() failed");
+        }
+        else
+#endif
+        {
+            for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+            {
+                const auto Offset = Attribs.IndirectDrawArgsOffset + size_t{draw} * size_t{Attribs.DrawArgsStride};
+                glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(Offset));
+                DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+            }
+        }
+    }
+    else
+    {
+        glDrawArraysIndirect(GlTopology, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
+        // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
+        DEV_CHECK_GL_ERROR("glDrawArraysIndirect() failed");
+    }
 
     constexpr bool ResetVAO = false; // GL_DRAW_INDIRECT_BUFFER does not affect VAO
     m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -915,6 +952,9 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
 void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
 #if GL_ARB_draw_indirect
     GLenum GlTopology;
@@ -933,9 +973,31 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
     //    GLuint  baseVertex;
     //    GLuint  baseInstance;
     //} DrawElementsIndirectCommand;
-    glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
-    // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
-    DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+    if (Attribs.DrawCount > 1)
+    {
+#if GL_ARB_multi_draw_indirect
+        if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) != 0)
+        {
+            glMultiDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)), Attribs.DrawCount, Attribs.DrawArgsStride);
+            DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirect() failed");
+        }
+        else
+#endif
+        {
+            for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+            {
+                const auto Offset = Attribs.IndirectDrawArgsOffset + size_t{draw} * size_t{Attribs.DrawArgsStride};
+                glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(Offset));
+                DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+            }
+        }
+    }
+    else
+    {
+        glDrawElementsIndirect(GlTopology, GLIndexType, reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)));
+        // Note that on GLES 3.1, baseInstance is present but reserved and must be zero
+        DEV_CHECK_GL_ERROR("glDrawElementsIndirect() failed");
+    }
 
     constexpr bool ResetVAO = false; // GL_DISPATCH_INDIRECT_BUFFER does not affect VAO
     m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
@@ -946,6 +1008,79 @@ void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 #endif
 }
 
+void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
+{
+#if GL_ARB_indirect_parameters
+    auto* pCountBufferGL = ValidatedCast<BufferGLImpl>(pCountBuffer);
+    // The draw count is sourced from the buffer bound to the GL_PARAMETER_BUFFER_ARB binding
+    pCountBufferGL->BufferMemoryBarrier(MEMORY_BARRIER_INDIRECT_BUFFER, m_ContextState);
+    constexpr bool ResetVAO = false; // GL_PARAMETER_BUFFER_ARB does not affect VAO
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, pCountBufferGL->m_GlBuffer, ResetVAO);
+#endif
+}
+
+void DeviceContextGLImpl::DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+#if GL_ARB_draw_indirect && GL_ARB_indirect_parameters
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+
+    PrepareForIndirectDraw(pAttribsBuffer);
+    PrepareForIndirectDrawCount(pCountBuffer);
+
+    glMultiDrawArraysIndirectCountARB(GlTopology,
+                                      reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)),
+                                      static_cast<GLintptr>(Attribs.CountBufferOffset),
+                                      Attribs.MaxCommandCount,
+                                      Attribs.DrawArgsStride);
+    DEV_CHECK_GL_ERROR("glMultiDrawArraysIndirectCountARB() failed");
+
+    constexpr bool ResetVAO = false;
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    LOG_ERROR_MESSAGE("DrawIndirectCount is not supported");
+#endif
+}
+
+void DeviceContextGLImpl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+#if GL_ARB_draw_indirect && GL_ARB_indirect_parameters
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    Uint32 FirstIndexByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, FirstIndexByteOffset);
+
+    PrepareForIndirectDraw(pAttribsBuffer);
+    PrepareForIndirectDrawCount(pCountBuffer);
+
+    glMultiDrawElementsIndirectCountARB(GlTopology,
+                                        GLIndexType,
+                                        reinterpret_cast<const void*>(static_cast<size_t>(Attribs.IndirectDrawArgsOffset)),
+                                        static_cast<GLintptr>(Attribs.CountBufferOffset),
+                                        Attribs.MaxCommandCount,
+                                        Attribs.DrawArgsStride);
+    DEV_CHECK_GL_ERROR("glMultiDrawElementsIndirectCountARB() failed");
+
+    constexpr bool ResetVAO = false;
+    m_ContextState.BindBuffer(GL_DRAW_INDIRECT_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+    m_ContextState.BindBuffer(GL_PARAMETER_BUFFER_ARB, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    PostDraw();
+#else
+    LOG_ERROR_MESSAGE("DrawIndexedIndirectCount is not supported");
+#endif
+}
+
 void DeviceContextGLImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     UNSUPPORTED("DrawMesh is not supported in OpenGL");
@@ -965,6 +1100,7 @@ void DeviceContextGLImpl::DrawMeshIndirectCount(const DrawMeshIndirectCountAttri
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     DvpVerifyDispatchArguments(Attribs);
+    CountDispatchCommand();
 
 #if GL_ARB_compute_shader
     // The program might have changed since the last SetPipelineState call if a shader was
@@ -991,6 +1127,7 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer);
+    CountDispatchCommand();
 
 #if GL_ARB_compute_shader
     // The program might have changed since the last SetPipelineState call if a shader was
@@ -1127,6 +1264,11 @@ void DeviceContextGLImpl::Flush()
 
 void DeviceContextGLImpl::FinishFrame()
 {
+    m_pDevice->GetFBOCache(m_ContextState.GetCurrentGLContext()).OnFinishFrame(m_ContextState);
+
+    m_LastFrameStateCacheStats = m_ContextState.GetStatistics();
+    m_ContextState.ResetStatistics();
+
     TDeviceContextBase::EndFrame();
 }
 
@@ -1272,6 +1414,32 @@ void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
     }
 }
 
+void DeviceContextGLImpl::BeginConditionalRendering(IQuery* pQuery)
+{
+    TDeviceContextBase::BeginConditionalRendering(pQuery, 0);
+
+#if GL_QUERY_WAIT
+    auto* pQueryGLImpl = ValidatedCast<QueryGLImpl>(pQuery);
+    // The GPU waits for the query result, so that the commands are never executed speculatively
+    glBeginConditionalRender(pQueryGLImpl->GetGlQueryHandle(), GL_QUERY_WAIT);
+    DEV_CHECK_GL_ERROR("Failed to begin conditional rendering");
+#else
+    UNSUPPORTED("Conditional rendering is not supported in this OpenGL implementation");
+#endif
+}
+
+void DeviceContextGLImpl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+#if GL_QUERY_WAIT
+    glEndConditionalRender();
+    DEV_CHECK_GL_ERROR("Failed to end conditional rendering");
+#else
+    UNSUPPORTED("Conditional rendering is not supported in this OpenGL implementation");
+#endif
+}
+
 bool DeviceContextGLImpl::UpdateCurrentGLContext()
 {
     auto NativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
@@ -1314,6 +1482,13 @@ void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ValidatedCast<BufferGLImpl>(pBuffer);
     pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
+
+    if (pBufferGL->IsPersistentlyMapped() && (MapFlags & MAP_FLAG_DISCARD) != 0 && (pBufferGL->GetDesc().BindFlags & BIND_VERTEX_BUFFER) != 0)
+    {
+        // Vertex attribute offsets are baked into the VAO, so the VAO must be
+        // re-fetched from the cache to pick up the new persistent region.
+        m_ContextState.InvalidateVAO();
+    }
 }
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
@@ -1336,6 +1511,34 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
     pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, SubresData);
 }
 
+void DeviceContextGLImpl::UpdateTextureRegions(ITexture*                      pTexture,
+                                               const TextureRegionUpdate*     pUpdates,
+                                               Uint32                         NumUpdates,
+                                               RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TDeviceContextBase::UpdateTextureRegions(pTexture, pUpdates, NumUpdates, TextureTransitionMode);
+
+    // glTexSubImage*() updates one region at a time
+    auto* pTexGL = ValidatedCast<TextureBaseGL>(pTexture);
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update = pUpdates[i];
+        pTexGL->UpdateData(m_ContextState, Update.MipLevel, Update.Slice, Update.DstBox, Update.SrcData);
+    }
+}
+
+void DeviceContextGLImpl::BeginTextureCopyBatch()
+{
+    // Render targets are saved by the first copy that renders to the texture
+    constexpr bool SaveRenderTargets = false;
+    m_pDevice->m_pTexRegionRender->SetStates(this, SaveRenderTargets);
+}
+
+void DeviceContextGLImpl::EndTextureCopyBatch()
+{
+    m_pDevice->m_pTexRegionRender->RestoreStates(this);
+}
+
 void DeviceContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
     TDeviceContextBase::CopyTexture(CopyAttribs);
@@ -1495,9 +1698,17 @@ void DeviceContextGLImpl::GenerateMips(ITextureView* pTexView)
     m_ContextState.BindTexture(-1, BindTarget, GLObjectWrappers::GLTextureObj::Null());
 }
 
+void DeviceContextGLImpl::GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews)
+{
+    // glGenerateMipmap processes one texture at a time
+    for (Uint32 i = 0; i < NumViews; ++i)
+        GenerateMips(ppTexViews[i]);
+}
+
 void DeviceContextGLImpl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    CountStateTransitions(BarrierCount);
 }
 
 void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*                               pSrcTexture,
@@ -1586,6 +1797,11 @@ void DeviceContextGLImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     UNSUPPORTED("BuildTLAS is not supported in OpenGL");
 }
 
+void DeviceContextGLImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    UNSUPPORTED("BuildBLASBatch is not supported in OpenGL");
+}
+
 void DeviceContextGLImpl::CopyBLAS(const CopyBLASAttribs& Attribs)
 {
     UNSUPPORTED("CopyBLAS is not supported in OpenGL");
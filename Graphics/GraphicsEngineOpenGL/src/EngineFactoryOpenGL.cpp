@@ -34,6 +34,7 @@
 #include "DeviceContextGLImpl.hpp"
 #include "EngineFactoryBase.hpp"
 #include "EngineMemory.h"
+#include "Timer.hpp"
 
 #if !DILIGENT_NO_HLSL
 #    include "HLSL2GLSLConverterObject.hpp"
@@ -190,6 +191,10 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 
     try
     {
+        Timer                InitTimer;
+        Timer                PhaseTimer;
+        DeviceInitStatistics InitStats;
+
         GraphicsAdapterInfo AdapterInfo;
         SetDefaultGraphicsAdapterInfo(AdapterInfo);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
@@ -204,6 +209,10 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         };
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        // GL context is created by the render device
+        InitStats.RenderDeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
                 pRenderDeviceOpenGL,
@@ -223,10 +232,15 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         // Need to create immediate context first
         pRenderDeviceOpenGL->InitTexRegionRender();
 
+        InitStats.ContextsTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+
         TSwapChain* pSwapChainGL = NEW_RC_OBJ(RawMemAllocator, "SwapChainGLImpl instance", TSwapChain)(EngineCI, SCDesc, pRenderDeviceOpenGL, pDeviceContextOpenGL);
         pSwapChainGL->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
 
         pDeviceContextOpenGL->SetSwapChain(pSwapChainGL);
+
+        InitStats.TotalTime = InitTimer.GetElapsedTimef() * 1000.f;
+        pRenderDeviceOpenGL->SetInitStatistics(InitStats);
     }
     catch (const std::runtime_error&)
     {
@@ -294,6 +308,10 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
 
     try
     {
+        Timer                InitTimer;
+        Timer                PhaseTimer;
+        DeviceInitStatistics InitStats;
+
         GraphicsAdapterInfo AdapterInfo;
         SetDefaultGraphicsAdapterInfo(AdapterInfo);
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
@@ -308,6 +326,10 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         };
         pRenderDeviceOpenGL->QueryInterface(IID_RenderDevice, reinterpret_cast<IObject**>(ppDevice));
 
+        // GL context is created by the render device
+        InitStats.RenderDeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         DeviceContextGLImpl* pDeviceContextOpenGL{
             NEW_RC_OBJ(RawMemAllocator, "DeviceContextGLImpl instance", DeviceContextGLImpl)(
                 pRenderDeviceOpenGL,
@@ -323,6 +345,10 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         // keep a weak reference to the context
         pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
+
+        InitStats.ContextsTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        InitStats.TotalTime    = InitTimer.GetElapsedTimef() * 1000.f;
+        pRenderDeviceOpenGL->SetInitStatistics(InitStats);
     }
     catch (const std::runtime_error&)
     {
@@ -32,6 +32,9 @@
 #include "TextureBaseGL.hpp"
 #include "GLContextState.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace Diligent
 {
 
@@ -44,17 +47,17 @@ bool FBOCache::FBOCacheKey::operator==(const FBOCacheKey& Key) const
         return false;
     for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
     {
-        if (RTIds[rt] != Key.RTIds[rt])
+        if (RTHandles[rt] != Key.RTHandles[rt])
             return false;
-        if (RTIds[rt])
+        if (RTHandles[rt])
         {
             if (!(RTVDescs[rt] == Key.RTVDescs[rt]))
                 return false;
         }
     }
-    if (DSId != Key.DSId)
+    if (DSHandle != Key.DSHandle)
         return false;
-    if (DSId)
+    if (DSHandle)
     {
         if (!(DSVDesc == Key.DSVDesc))
             return false;
@@ -71,28 +74,40 @@ std::size_t FBOCache::FBOCacheKeyHashFunc::operator()(const FBOCacheKey& Key) co
         HashCombine(Key.Hash, Key.NumRenderTargets);
         for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
         {
-            HashCombine(Key.Hash, Key.RTIds[rt]);
-            if (Key.RTIds[rt])
+            HashCombine(Key.Hash, Key.RTHandles[rt]);
+            if (Key.RTHandles[rt])
                 HashCombine(Key.Hash, TexViewDescHasher(Key.RTVDescs[rt]));
         }
-        HashCombine(Key.Hash, Key.DSId);
-        if (Key.DSId)
+        HashCombine(Key.Hash, Key.DSHandle);
+        if (Key.DSHandle)
             HashCombine(Key.Hash, TexViewDescHasher(Key.DSVDesc));
     }
     return Key.Hash;
 }
 
 
-FBOCache::FBOCache()
+FBOCache::FBOCache(Uint32 MaxSize, Uint32 MaxAge) :
+    m_MaxSize{MaxSize},
+    m_MaxAge{MaxAge}
 {
-    m_Cache.max_load_factor(0.5f);
-    m_TexIdToKey.max_load_factor(0.5f);
 }
 
 FBOCache::~FBOCache()
 {
     VERIFY(m_Cache.empty(), "FBO cache is not empty. Are there any unreleased objects?");
-    VERIFY(m_TexIdToKey.empty(), "TexIdToKey cache is not empty.");
+#ifdef DILIGENT_DEBUG
+    for (const auto& Keys : m_TexSlotToKeys)
+        VERIFY(Keys.empty(), "Texture-to-FBO keys are not empty.");
+#endif
+}
+
+std::vector<FBOCache::FBOCacheKey>& FBOCache::GetTextureKeys(ObjectHandle TexHandle)
+{
+    VERIFY_EXPR(TexHandle != ObjectHandleTable::NullHandle);
+    const auto SlotIdx = ObjectHandleTable::GetSlotIndex(TexHandle);
+    if (SlotIdx >= m_TexSlotToKeys.size())
+        m_TexSlotToKeys.resize(SlotIdx + 1);
+    return m_TexSlotToKeys[SlotIdx];
 }
 
 void FBOCache::OnReleaseTexture(ITexture* pTexture)
@@ -101,12 +116,16 @@ void FBOCache::OnReleaseTexture(ITexture* pTexture)
 
     auto* pTexGL = ValidatedCast<TextureBaseGL>(pTexture);
     // Find all FBOs that this texture used in
-    auto EqualRange = m_TexIdToKey.equal_range(pTexGL->GetUniqueID());
-    for (auto It = EqualRange.first; It != EqualRange.second; ++It)
-    {
-        m_Cache.erase(It->second);
-    }
-    m_TexIdToKey.erase(EqualRange.first, EqualRange.second);
+    const auto SlotIdx = ObjectHandleTable::GetSlotIndex(pTexGL->GetHandle());
+    if (SlotIdx >= m_TexSlotToKeys.size())
+        return;
+
+    // Keys of the FBOs that use other textures as well remain in m_TexSlotToKeys
+    // until these textures are released.
+    auto& Keys = m_TexSlotToKeys[SlotIdx];
+    for (const auto& Key : Keys)
+        m_Cache.erase(Key);
+    Keys.clear();
 }
 
 GLObjectWrappers::GLFrameBufferObj FBOCache::CreateFBO(GLContextState&    ContextState,
@@ -252,7 +271,7 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             Nu
                                         // on the completion of all shader writes issued prior to the barrier.
             ContextState);
 
-        Key.RTIds[rt]    = pColorTexGL->GetUniqueID();
+        Key.RTHandles[rt]    = pColorTexGL->GetHandle();
         Key.RTVDescs[rt] = pRTView->GetDesc();
     }
 
@@ -260,7 +279,7 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             Nu
     {
         auto* pDepthTexGL = pDSV->GetTexture<TextureBaseGL>();
         pDepthTexGL->TextureMemoryBarrier(MEMORY_BARRIER_FRAMEBUFFER, ContextState);
-        Key.DSId    = pDepthTexGL->GetUniqueID();
+        Key.DSHandle    = pDepthTexGL->GetHandle();
         Key.DSVDesc = pDSV->GetDesc();
     }
 
@@ -268,26 +287,110 @@ const GLObjectWrappers::GLFrameBufferObj& FBOCache::GetFBO(Uint32             Nu
     auto It = m_Cache.find(Key);
     if (It != m_Cache.end())
     {
-        return It->second;
+        It->second.LastUsedFrame = m_CurrentFrame;
+        ++m_NumHits;
+        return It->second.FBO;
     }
     else
     {
+        if (m_MaxSize != 0 && m_Cache.size() >= m_MaxSize)
+            EvictLeastRecentlyUsed(m_Cache.size() - m_MaxSize + 1, ContextState);
+
         // Create a new FBO
         auto NewFBO = CreateFBO(ContextState, NumRenderTargets, ppRTVs, pDSV);
 
-        auto NewElems = m_Cache.emplace(std::make_pair(Key, std::move(NewFBO)));
+        auto NewElems = m_Cache.emplace(Key, FBOCacheEntry{std::move(NewFBO), m_CurrentFrame});
         // New element must be actually inserted
         VERIFY(NewElems.second, "New element was not inserted");
-        if (Key.DSId != 0)
-            m_TexIdToKey.insert(std::make_pair(Key.DSId, Key));
+        if (Key.DSHandle != ObjectHandleTable::NullHandle)
+            GetTextureKeys(Key.DSHandle).push_back(Key);
         for (Uint32 rt = 0; rt < NumRenderTargets; ++rt)
         {
-            if (Key.RTIds[rt] != 0)
-                m_TexIdToKey.insert(std::make_pair(Key.RTIds[rt], Key));
+            if (Key.RTHandles[rt] != ObjectHandleTable::NullHandle)
+                GetTextureKeys(Key.RTHandles[rt]).push_back(Key);
         }
 
-        return NewElems.first->second;
+        ++m_NumMisses;
+
+        return NewElems.first->second.FBO;
+    }
+}
+
+bool FBOCache::CanEvict(const FBOCacheEntry& Entry, Uint64 MinAge, const GLContextState& ContextState) const
+{
+    // FBOs used in the current frame may still be referenced by the caller, e.g. when
+    // copying between textures, and the bound FBO must not be deleted behind the context state.
+    return Entry.LastUsedFrame + MinAge <= m_CurrentFrame && !ContextState.IsFBOBound(Entry.FBO);
+}
+
+void FBOCache::Evict(CacheType::iterator It)
+{
+    const auto& Key = It->first;
+
+    auto RemoveKey = [this, &Key](ObjectHandle TexHandle) {
+        auto& Keys = GetTextureKeys(TexHandle);
+        Keys.erase(std::remove(Keys.begin(), Keys.end(), Key), Keys.end());
+    };
+
+    if (Key.DSHandle != ObjectHandleTable::NullHandle)
+        RemoveKey(Key.DSHandle);
+    for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
+    {
+        if (Key.RTHandles[rt] != ObjectHandleTable::NullHandle)
+            RemoveKey(Key.RTHandles[rt]);
+    }
+
+    m_Cache.erase(It);
+    ++m_NumEvictions;
+}
+
+void FBOCache::EvictLeastRecentlyUsed(size_t NumToEvict, const GLContextState& ContextState)
+{
+    std::vector<std::pair<Uint64, const FBOCacheKey*>> Candidates;
+    Candidates.reserve(m_Cache.size());
+    for (const auto& It : m_Cache)
+    {
+        if (CanEvict(It.second, 1, ContextState))
+            Candidates.emplace_back(It.second.LastUsedFrame, &It.first);
     }
+
+    NumToEvict = std::min(NumToEvict, Candidates.size());
+    std::partial_sort(Candidates.begin(), Candidates.begin() + NumToEvict, Candidates.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    // The cache is allowed to grow beyond the limit if all FBOs are in use
+    for (size_t i = 0; i < NumToEvict; ++i)
+        Evict(m_Cache.find(*Candidates[i].second));
+}
+
+void FBOCache::OnFinishFrame(GLContextState& ContextState)
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+
+    ++m_CurrentFrame;
+    if (m_MaxAge == 0)
+        return;
+
+    for (auto It = m_Cache.begin(); It != m_Cache.end();)
+    {
+        if (CanEvict(It->second, m_MaxAge, ContextState))
+        {
+            auto EvictIt = It++;
+            Evict(EvictIt);
+        }
+        else
+            ++It;
+    }
+}
+
+void FBOCache::GetStatistics(FramebufferCacheStatistics& Stats)
+{
+    ThreadingTools::LockHelper CacheLock(m_CacheLockFlag);
+
+    Stats.NumFramebuffers += static_cast<Uint32>(m_Cache.size());
+    Stats.NumHits += m_NumHits;
+    Stats.NumMisses += m_NumMisses;
+    Stats.NumEvictions += m_NumEvictions;
 }
 
 } // namespace Diligent
@@ -26,6 +26,7 @@
  */
 
 #include "pch.h"
+#include <cstring>
 #include <utility>
 #include <vector>
 
@@ -274,6 +275,9 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
     auto* NativeWindow = reinterpret_cast<ANativeWindow*>(InitAttribs.Window.pAWindow);
     Init(NativeWindow);
 
+    if (InitAttribs.CreateWorkerContext)
+        InitWorkerContext();
+
     DevType          = RENDER_DEVICE_TYPE_GLES;
     APIVersion.Major = static_cast<Uint8>(major_version_);
     APIVersion.Minor = static_cast<Uint8>(minor_version_);
@@ -325,8 +329,89 @@ void GLContext::SwapBuffers(int SwapInterval)
     //return EGL_SUCCESS;
 }
 
+void GLContext::InitWorkerContext()
+{
+    auto   display      = eglGetCurrentDisplay();
+    auto   main_context = eglGetCurrentContext();
+    EGLint config_id    = 0;
+    if (display == EGL_NO_DISPLAY || eglQueryContext(display, main_context, EGL_CONFIG_ID, &config_id) == EGL_FALSE)
+    {
+        LOG_WARNING_MESSAGE("Failed to query the configuration of the current EGL context. Worker context will not be created.");
+        return;
+    }
+
+    const EGLint config_attribs[] = {EGL_CONFIG_ID, config_id, EGL_NONE};
+    EGLConfig    config;
+    EGLint       num_configs = 0;
+    if (eglChooseConfig(display, config_attribs, &config, 1, &num_configs) == EGL_FALSE || num_configs == 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to find the configuration of the current EGL context. Worker context will not be created.");
+        return;
+    }
+
+    // clang-format off
+    const EGLint context_attribs[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION, major_version_,
+        EGL_CONTEXT_MINOR_VERSION, minor_version_,
+        EGL_NONE
+    };
+    // clang-format on
+    worker_context_ = eglCreateContext(display, config, main_context, context_attribs);
+    if (worker_context_ == EGL_NO_CONTEXT)
+    {
+        LOG_WARNING_MESSAGE("Failed to create worker EGL context");
+        return;
+    }
+
+    // The worker context never renders, so it is made current without a surface when
+    // EGL_KHR_surfaceless_context is supported, and with a 1x1 pbuffer otherwise.
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr || strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr)
+    {
+        const EGLint pbuffer_attribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        worker_surface_                = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+        if (worker_surface_ == EGL_NO_SURFACE)
+        {
+            LOG_WARNING_MESSAGE("Failed to create pbuffer surface for the worker EGL context");
+            eglDestroyContext(display, worker_context_);
+            worker_context_ = EGL_NO_CONTEXT;
+            return;
+        }
+    }
+
+    worker_display_ = display;
+    LOG_INFO_MESSAGE("Created worker EGL context");
+}
+
+void GLContext::DestroyWorkerContext()
+{
+    if (worker_context_ != EGL_NO_CONTEXT)
+    {
+        eglDestroyContext(worker_display_, worker_context_);
+        if (worker_surface_ != EGL_NO_SURFACE)
+            eglDestroySurface(worker_display_, worker_surface_);
+    }
+    worker_display_ = EGL_NO_DISPLAY;
+    worker_surface_ = EGL_NO_SURFACE;
+    worker_context_ = EGL_NO_CONTEXT;
+}
+
+bool GLContext::MakeWorkerContextCurrent()
+{
+    VERIFY(worker_context_ != EGL_NO_CONTEXT, "Worker context has not been created");
+    return eglMakeCurrent(worker_display_, worker_surface_, worker_surface_, worker_context_) == EGL_TRUE;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    eglMakeCurrent(worker_display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
 void GLContext::Terminate()
 {
+    DestroyWorkerContext();
+
     if (display_ != EGL_NO_DISPLAY)
     {
         eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
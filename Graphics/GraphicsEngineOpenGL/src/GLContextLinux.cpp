@@ -81,10 +81,104 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
 
     DevType    = RENDER_DEVICE_TYPE_GL;
     APIVersion = Version{MajorVersion, MinorVersion};
+
+    if (InitAttribs.CreateWorkerContext)
+        InitWorkerContext();
 }
 
 GLContext::~GLContext()
 {
+    if (m_WorkerContext != nullptr)
+    {
+        auto* display = reinterpret_cast<Display*>(m_pWorkerDisplay);
+        glXDestroyContext(display, m_WorkerContext);
+        if (m_WorkerPbuffer != 0)
+            glXDestroyPbuffer(display, m_WorkerPbuffer);
+    }
+}
+
+void GLContext::InitWorkerContext()
+{
+    auto* display = glXGetCurrentDisplay();
+    auto  MainCtx = glXGetCurrentContext();
+
+    int FBConfigId = 0;
+    if (display == nullptr || glXQueryContext(display, MainCtx, GLX_FBCONFIG_ID, &FBConfigId) != 0 /*Success*/)
+    {
+        LOG_WARNING_MESSAGE("Failed to query the frame buffer configuration of the current GL context. Worker context will not be created.");
+        return;
+    }
+
+    const int ConfigAttribs[] = {GLX_FBCONFIG_ID, FBConfigId, 0 /*None*/};
+    int       NumConfigs      = 0;
+    auto*     pConfigs        = glXChooseFBConfig(display, DefaultScreen(display), ConfigAttribs, &NumConfigs);
+    if (pConfigs == nullptr || NumConfigs == 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to find the frame buffer configuration of the current GL context. Worker context will not be created.");
+        return;
+    }
+    auto Config = pConfigs[0];
+    XFree(pConfigs);
+
+    // Use the same version and profile as the main context so that objects can be shared
+    if (GLXEW_ARB_create_context)
+    {
+        GLint MajorVersion = 0, MinorVersion = 0, ProfileMask = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &MajorVersion);
+        glGetIntegerv(GL_MINOR_VERSION, &MinorVersion);
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &ProfileMask);
+        glGetError();
+
+        std::vector<int> ContextAttribs =
+            {
+                GLX_CONTEXT_MAJOR_VERSION_ARB, MajorVersion,
+                GLX_CONTEXT_MINOR_VERSION_ARB, MinorVersion //
+            };
+        if (ProfileMask != 0)
+        {
+            ContextAttribs.push_back(GLX_CONTEXT_PROFILE_MASK_ARB);
+            ContextAttribs.push_back(ProfileMask);
+        }
+        ContextAttribs.push_back(0); // None
+
+        m_WorkerContext = glXCreateContextAttribsARB(display, Config, MainCtx, True, ContextAttribs.data());
+    }
+    else
+    {
+        m_WorkerContext = glXCreateNewContext(display, Config, GLX_RGBA_TYPE, MainCtx, True);
+    }
+
+    if (m_WorkerContext == nullptr)
+    {
+        LOG_WARNING_MESSAGE("Failed to create worker GL context");
+        return;
+    }
+
+    // The worker context never renders, so a 1x1 pbuffer is enough to make it current.
+    // If the configuration does not support pbuffers, the context is made current without a drawable (GL 3.0+).
+    int DrawableType = 0;
+    glXGetFBConfigAttrib(display, Config, GLX_DRAWABLE_TYPE, &DrawableType);
+    if ((DrawableType & GLX_PBUFFER_BIT) != 0)
+    {
+        const int PbufferAttribs[] = {GLX_PBUFFER_WIDTH, 1, GLX_PBUFFER_HEIGHT, 1, 0 /*None*/};
+        m_WorkerPbuffer            = glXCreatePbuffer(display, Config, PbufferAttribs);
+    }
+
+    m_pWorkerDisplay = display;
+    LOG_INFO_MESSAGE("Created worker GL context");
+}
+
+bool GLContext::MakeWorkerContextCurrent()
+{
+    VERIFY(m_WorkerContext != nullptr, "Worker context has not been created");
+    auto* display = reinterpret_cast<Display*>(m_pWorkerDisplay);
+    return glXMakeContextCurrent(display, m_WorkerPbuffer, m_WorkerPbuffer, m_WorkerContext) == True;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    auto* display = reinterpret_cast<Display*>(m_pWorkerDisplay);
+    glXMakeContextCurrent(display, 0 /*None*/, 0 /*None*/, nullptr);
 }
 
 void GLContext::SwapBuffers(int SwapInterval)
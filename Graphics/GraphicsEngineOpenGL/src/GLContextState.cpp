@@ -63,12 +63,33 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
         VERIFY_EXPR(m_Caps.m_iMaxUniformBufferBindings > 0);
     }
 
+#if GL_ARB_multi_bind
+    {
+        const auto& DeviceInfo = pDeviceGL->GetDeviceInfo();
+        m_Caps.bMultiBindSupported =
+            DeviceInfo.Type == RENDER_DEVICE_TYPE_GL &&
+            (DeviceInfo.APIVersion >= Version{4, 4} || pDeviceGL->CheckExtension("GL_ARB_multi_bind"));
+    }
+#endif
+
+#ifdef DILIGENT_DEVELOPMENT
+    m_VerifyStateCache = (pDeviceGL->GetGLValidationFlags() & GL_VALIDATION_FLAG_VERIFY_STATE_CACHE) != 0;
+#endif
+
     m_BoundTextures.reserve(m_Caps.m_iMaxCombinedTexUnits);
     m_BoundSamplers.reserve(32);
     m_BoundImages.reserve(32);
     m_BoundUniformBuffers.reserve(m_Caps.m_iMaxUniformBufferBindings);
     m_BoundStorageBlocks.reserve(16);
 
+    if (m_Caps.bMultiBindSupported)
+    {
+        m_PendingTextures.reserve(32);
+        m_PendingSamplers.reserve(32);
+        m_PendingUniformBuffers.reserve(16);
+        m_PendingStorageBlocks.reserve(16);
+    }
+
     Invalidate();
 
     m_CurrentGLContext = pDeviceGL->m_GLContext.GetCurrentNativeGLContext();
@@ -99,6 +120,8 @@ void GLContextState::Invalidate()
     m_VAOId        = -1;
     m_FBOId        = -1;
 
+    VERIFY(!m_BindingBatchActive, "Invalidating the state in the middle of a binding batch");
+
     m_BoundTextures.clear();
     m_BoundSamplers.clear();
     m_BoundImages.clear();
@@ -136,6 +159,35 @@ bool UpdateBoundObject(UniqueIdentifier& CurrentObjectID, const ObjectType& NewO
     return false;
 }
 
+#ifdef DILIGENT_DEVELOPMENT
+void GLContextState::DvpVerifyBoundObject(GLenum Query, GLint Index, GLuint ExpectedHandle, const char* ObjectName)
+{
+    GLint BoundHandle = 0;
+    if (Index >= 0)
+        glGetIntegeri_v(Query, Index, &BoundHandle);
+    else
+        glGetIntegerv(Query, &BoundHandle);
+    DEV_CHECK_GL_ERROR("Failed to query the bound ", ObjectName);
+
+    DEV_CHECK_ERR(static_cast<GLuint>(BoundHandle) == ExpectedHandle,
+                  "GL state cache is out of sync: ", ObjectName, " ", ExpectedHandle, " is expected to be bound",
+                  (Index >= 0 ? " to slot " : ""), (Index >= 0 ? std::to_string(Index) : std::string{}),
+                  ", but the actual handle is ", BoundHandle,
+                  ". This may indicate that the GL state was changed outside of the engine without calling IDeviceContext::InvalidateState().");
+}
+
+template <typename PendingBindingType>
+static bool IsBindingPending(const std::vector<PendingBindingType>& PendingBindings, Uint32 Index)
+{
+    for (const auto& Pending : PendingBindings)
+    {
+        if (Pending.Index == Index)
+            return true;
+    }
+    return false;
+}
+#endif
+
 void GLContextState::SetProgram(const GLProgramObj& GLProgram)
 {
     GLuint GLProgHandle = 0;
@@ -144,6 +196,12 @@ void GLContextState::SetProgram(const GLProgramObj& GLProgram)
         glUseProgram(GLProgHandle);
         DEV_CHECK_GL_ERROR("Failed to set GL program");
     }
+#ifdef DILIGENT_DEVELOPMENT
+    else if (m_VerifyStateCache)
+    {
+        DvpVerifyBoundObject(GL_CURRENT_PROGRAM, -1, GLProgHandle, "program");
+    }
+#endif
 }
 
 void GLContextState::SetPipeline(const GLPipelineObj& GLPipeline)
@@ -164,6 +222,12 @@ void GLContextState::BindVAO(const GLVertexArrayObj& VAO)
         glBindVertexArray(VAOHandle);
         DEV_CHECK_GL_ERROR("Failed to set VAO");
     }
+#ifdef DILIGENT_DEVELOPMENT
+    else if (m_VerifyStateCache)
+    {
+        DvpVerifyBoundObject(GL_VERTEX_ARRAY_BINDING, -1, VAOHandle, "VAO");
+    }
+#endif
 }
 
 void GLContextState::BindFBO(const GLFrameBufferObj& FBO)
@@ -210,6 +274,18 @@ void GLContextState::SetActiveTexture(Int32 Index)
     }
 }
 
+#ifdef DILIGENT_DEVELOPMENT
+static GLenum GetTextureBindingQuery(GLenum BindTarget)
+{
+    // Only check the targets that are available on all platforms
+    if (BindTarget == GL_TEXTURE_2D) return GL_TEXTURE_BINDING_2D;
+    if (BindTarget == GL_TEXTURE_2D_ARRAY) return GL_TEXTURE_BINDING_2D_ARRAY;
+    if (BindTarget == GL_TEXTURE_3D) return GL_TEXTURE_BINDING_3D;
+    if (BindTarget == GL_TEXTURE_CUBE_MAP) return GL_TEXTURE_BINDING_CUBE_MAP;
+    return 0;
+}
+#endif
+
 void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectWrappers::GLTextureObj& Tex)
 {
     if (Index < 0)
@@ -218,14 +294,42 @@ void GLContextState::BindTexture(Int32 Index, GLenum BindTarget, const GLObjectW
     }
     VERIFY(0 <= Index && Index < m_Caps.m_iMaxCombinedTexUnits, "Texture unit is out of range");
 
-    // Always update active texture unit
-    SetActiveTexture(Index);
+    // Always update active texture unit, unless the binding is deferred:
+    // glBindTextures() does not use active texture unit.
+    if (!m_BindingBatchActive)
+        SetActiveTexture(Index);
 
     GLuint GLTexHandle = 0;
     if (UpdateBoundObjectsArr(m_BoundTextures, Index, Tex, GLTexHandle))
     {
-        glBindTexture(BindTarget, GLTexHandle);
-        DEV_CHECK_GL_ERROR("Failed to bind texture to slot ", Index);
+        ++m_Stats.Textures.Issued;
+        if (m_BindingBatchActive)
+        {
+            PendingBinding Pending;
+            Pending.Index  = static_cast<Uint32>(Index);
+            Pending.Handle = GLTexHandle;
+            Pending.Target = BindTarget;
+            m_PendingTextures.push_back(Pending);
+        }
+        else
+        {
+            glBindTexture(BindTarget, GLTexHandle);
+            DEV_CHECK_GL_ERROR("Failed to bind texture to slot ", Index);
+        }
+    }
+    else
+    {
+        ++m_Stats.Textures.Filtered;
+#ifdef DILIGENT_DEVELOPMENT
+        if (m_VerifyStateCache && !IsBindingPending(m_PendingTextures, static_cast<Uint32>(Index)))
+        {
+            if (auto Query = GetTextureBindingQuery(BindTarget))
+            {
+                SetActiveTexture(Index);
+                DvpVerifyBoundObject(Query, -1, GLTexHandle, "texture");
+            }
+        }
+#endif
     }
 }
 
@@ -234,9 +338,31 @@ void GLContextState::BindSampler(Uint32 Index, const GLObjectWrappers::GLSampler
     GLuint GLSamplerHandle = 0;
     if (UpdateBoundObjectsArr(m_BoundSamplers, Index, GLSampler, GLSamplerHandle))
     {
+        ++m_Stats.Samplers.Issued;
+        if (m_BindingBatchActive)
+        {
+            PendingBinding Pending;
+            Pending.Index  = Index;
+            Pending.Handle = GLSamplerHandle;
+            m_PendingSamplers.push_back(Pending);
+            return;
+        }
+
         glBindSampler(Index, GLSamplerHandle);
         DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", Index);
     }
+    else
+    {
+        ++m_Stats.Samplers.Filtered;
+#ifdef DILIGENT_DEVELOPMENT
+        if (m_VerifyStateCache && !IsBindingPending(m_PendingSamplers, Index))
+        {
+            // GL_SAMPLER_BINDING refers to the active texture unit
+            SetActiveTexture(static_cast<Int32>(Index));
+            DvpVerifyBoundObject(GL_SAMPLER_BINDING, -1, GLSamplerHandle, "sampler");
+        }
+#endif
+    }
 }
 
 void GLContextState::BindImage(Uint32             Index,
@@ -265,6 +391,11 @@ void GLContextState::BindImage(Uint32             Index,
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, MipLevel, IsLayered, Layer, Access, Format);
         DEV_CHECK_GL_ERROR("glBindImageTexture() failed");
+        ++m_Stats.Images.Issued;
+    }
+    else
+    {
+        ++m_Stats.Images.Filtered;
     }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
@@ -291,6 +422,11 @@ void GLContextState::BindImage(Uint32 Index, BufferViewGLImpl* pBuffView, GLenum
         m_BoundImages[Index] = NewImageInfo;
         glBindImageTexture(Index, NewImageInfo.GLHandle, 0, GL_FALSE, 0, Access, Format);
         DEV_CHECK_GL_ERROR("glBindImageTexture() failed");
+        ++m_Stats.Images.Issued;
+    }
+    else
+    {
+        ++m_Stats.Images.Filtered;
     }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
@@ -339,11 +475,31 @@ void GLContextState::BindUniformBuffer(Int32 Index, const GLObjectWrappers::GLBu
     {
         m_BoundUniformBuffers[Index] = NewUBOInfo;
         GLuint GLBufferHandle        = Buff;
+        ++m_Stats.UniformBuffers.Issued;
+        if (m_BindingBatchActive)
+        {
+            PendingBinding Pending;
+            Pending.Index  = static_cast<Uint32>(Index);
+            Pending.Handle = GLBufferHandle;
+            Pending.Offset = Offset;
+            Pending.Size   = Size;
+            m_PendingUniformBuffers.push_back(Pending);
+            return;
+        }
+
         // In addition to binding buffer to the indexed buffer binding target, glBindBufferBase also binds
         // buffer to the generic buffer binding point specified by target.
         glBindBufferRange(GL_UNIFORM_BUFFER, Index, GLBufferHandle, Offset, Size);
         DEV_CHECK_GL_ERROR("Failed to bind uniform buffer to slot ", Index);
     }
+    else
+    {
+        ++m_Stats.UniformBuffers.Filtered;
+#ifdef DILIGENT_DEVELOPMENT
+        if (m_VerifyStateCache && !IsBindingPending(m_PendingUniformBuffers, static_cast<Uint32>(Index)))
+            DvpVerifyBoundObject(GL_UNIFORM_BUFFER_BINDING, Index, Buff, "uniform buffer");
+#endif
+    }
 }
 
 void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBufferObj& Buff, GLintptr Offset, GLsizeiptr Size)
@@ -357,16 +513,167 @@ void GLContextState::BindStorageBlock(Int32 Index, const GLObjectWrappers::GLBuf
     {
         m_BoundStorageBlocks[Index] = NewSSBOInfo;
         GLuint GLBufferHandle       = Buff;
+        ++m_Stats.StorageBlocks.Issued;
+        if (m_BindingBatchActive)
+        {
+            PendingBinding Pending;
+            Pending.Index  = static_cast<Uint32>(Index);
+            Pending.Handle = GLBufferHandle;
+            Pending.Offset = Offset;
+            Pending.Size   = Size;
+            m_PendingStorageBlocks.push_back(Pending);
+            return;
+        }
+
         // In addition to binding buffer to the indexed buffer binding target, glBindBufferRange also binds
         // buffer to the generic buffer binding point specified by target.
         glBindBufferRange(GL_SHADER_STORAGE_BUFFER, Index, GLBufferHandle, Offset, Size);
         DEV_CHECK_GL_ERROR("Failed to bind shader storage block to slot ", Index);
     }
+    else
+    {
+        ++m_Stats.StorageBlocks.Filtered;
+#    ifdef DILIGENT_DEVELOPMENT
+        if (m_VerifyStateCache && !IsBindingPending(m_PendingStorageBlocks, static_cast<Uint32>(Index)))
+            DvpVerifyBoundObject(GL_SHADER_STORAGE_BUFFER_BINDING, Index, Buff, "shader storage block");
+#    endif
+    }
 #else
     UNSUPPORTED("GL_ARB_shader_image_load_store is not supported");
 #endif
 }
 
+void GLContextState::BeginBindingBatch()
+{
+    VERIFY(!m_BindingBatchActive, "Binding batch has already been started");
+    // Without multi-bind support, bindings are issued immediately
+    m_BindingBatchActive = m_Caps.bMultiBindSupported;
+}
+
+void GLContextState::EndBindingBatch()
+{
+    if (!m_BindingBatchActive)
+        return;
+
+    m_BindingBatchActive = false;
+
+    FlushPendingTextures();
+    FlushPendingSamplers();
+    FlushPendingBuffers(m_PendingUniformBuffers, GL_UNIFORM_BUFFER);
+#if GL_ARB_shader_storage_buffer_object
+    FlushPendingBuffers(m_PendingStorageBlocks, GL_SHADER_STORAGE_BUFFER);
+#endif
+}
+
+// Calls Handler(Start, Count) for every run of consecutive slots in PendingBindings.
+// Bindings are expected to be recorded in the order of increasing slot indices.
+template <typename PendingBindingType, typename HandlerType>
+static void ProcessConsecutiveBindings(const std::vector<PendingBindingType>& PendingBindings, HandlerType&& Handler)
+{
+    size_t RunStart = 0;
+    for (size_t i = 1; i <= PendingBindings.size(); ++i)
+    {
+        if (i == PendingBindings.size() || PendingBindings[i].Index != PendingBindings[i - 1].Index + 1)
+        {
+            Handler(RunStart, i - RunStart);
+            RunStart = i;
+        }
+    }
+}
+
+void GLContextState::FlushPendingTextures()
+{
+    if (m_PendingTextures.empty())
+        return;
+
+    ProcessConsecutiveBindings(m_PendingTextures, [&](size_t Start, size_t Count) {
+        const auto& First = m_PendingTextures[Start];
+        if (Count == 1)
+        {
+            SetActiveTexture(static_cast<Int32>(First.Index));
+            glBindTexture(First.Target, First.Handle);
+            DEV_CHECK_GL_ERROR("Failed to bind texture to slot ", First.Index);
+            return;
+        }
+
+#if GL_ARB_multi_bind
+        m_MultiBindHandles.clear();
+        for (size_t i = Start; i < Start + Count; ++i)
+            m_MultiBindHandles.push_back(m_PendingTextures[i].Handle);
+        // glBindTextures binds every texture to the target it was created with
+        glBindTextures(First.Index, static_cast<GLsizei>(Count), m_MultiBindHandles.data());
+        DEV_CHECK_GL_ERROR("glBindTextures() failed");
+        ++m_Stats.NumMultiBindCalls;
+#else
+        UNEXPECTED("Multi-bind is not supported");
+#endif
+    });
+    m_PendingTextures.clear();
+}
+
+void GLContextState::FlushPendingSamplers()
+{
+    if (m_PendingSamplers.empty())
+        return;
+
+    ProcessConsecutiveBindings(m_PendingSamplers, [&](size_t Start, size_t Count) {
+        const auto& First = m_PendingSamplers[Start];
+        if (Count == 1)
+        {
+            glBindSampler(First.Index, First.Handle);
+            DEV_CHECK_GL_ERROR("Failed to bind sampler to slot ", First.Index);
+            return;
+        }
+
+#if GL_ARB_multi_bind
+        m_MultiBindHandles.clear();
+        for (size_t i = Start; i < Start + Count; ++i)
+            m_MultiBindHandles.push_back(m_PendingSamplers[i].Handle);
+        glBindSamplers(First.Index, static_cast<GLsizei>(Count), m_MultiBindHandles.data());
+        DEV_CHECK_GL_ERROR("glBindSamplers() failed");
+        ++m_Stats.NumMultiBindCalls;
+#else
+        UNEXPECTED("Multi-bind is not supported");
+#endif
+    });
+    m_PendingSamplers.clear();
+}
+
+void GLContextState::FlushPendingBuffers(std::vector<PendingBinding>& PendingBuffers, GLenum Target)
+{
+    if (PendingBuffers.empty())
+        return;
+
+    ProcessConsecutiveBindings(PendingBuffers, [&](size_t Start, size_t Count) {
+        const auto& First = PendingBuffers[Start];
+        if (Count == 1)
+        {
+            glBindBufferRange(Target, First.Index, First.Handle, First.Offset, First.Size);
+            DEV_CHECK_GL_ERROR("Failed to bind buffer to slot ", First.Index);
+            return;
+        }
+
+#if GL_ARB_multi_bind
+        m_MultiBindHandles.clear();
+        m_MultiBindOffsets.clear();
+        m_MultiBindSizes.clear();
+        for (size_t i = Start; i < Start + Count; ++i)
+        {
+            const auto& Pending = PendingBuffers[i];
+            m_MultiBindHandles.push_back(Pending.Handle);
+            m_MultiBindOffsets.push_back(Pending.Offset);
+            m_MultiBindSizes.push_back(Pending.Size);
+        }
+        glBindBuffersRange(Target, First.Index, static_cast<GLsizei>(Count), m_MultiBindHandles.data(), m_MultiBindOffsets.data(), m_MultiBindSizes.data());
+        DEV_CHECK_GL_ERROR("glBindBuffersRange() failed");
+        ++m_Stats.NumMultiBindCalls;
+#else
+        UNEXPECTED("Multi-bind is not supported");
+#endif
+    });
+    PendingBuffers.clear();
+}
+
 void GLContextState::BindBuffer(GLenum BindTarget, const GLObjectWrappers::GLBufferObj& Buff, bool ResetVAO)
 {
     // Binding ARRAY_BUFFER or ELEMENT_ARRAY_BUFFER affects currently bound VAO
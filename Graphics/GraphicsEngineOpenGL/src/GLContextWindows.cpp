@@ -219,10 +219,16 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
     APIVersion = Version{MajorVersion, MinorVersion};
     VERIFY(static_cast<int>(APIVersion.Major) == MajorVersion && static_cast<int>(APIVersion.Minor) == MinorVersion,
            "Not enought bits to store version number");
+
+    if (InitAttribs.CreateWorkerContext)
+        InitWorkerContext();
 }
 
 GLContext::~GLContext()
 {
+    if (m_WorkerContext)
+        wglDeleteContext(m_WorkerContext);
+
     // Do not destroy context if it was created by the app.
     if (m_Context)
     {
@@ -255,4 +261,64 @@ GLContext::NativeGLContextType GLContext::GetCurrentNativeGLContext()
     return wglGetCurrentContext();
 }
 
+void GLContext::InitWorkerContext()
+{
+    // The worker context uses the device context of the main context, which has the required pixel format
+    HDC   hDC     = wglGetCurrentDC();
+    HGLRC MainCtx = wglGetCurrentContext();
+
+    if (wglewIsSupported("WGL_ARB_create_context") == 1)
+    {
+        // Use the same version and profile as the main context so that objects can be shared
+        GLint MajorVersion = 0, MinorVersion = 0, ProfileMask = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &MajorVersion);
+        glGetIntegerv(GL_MINOR_VERSION, &MinorVersion);
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &ProfileMask);
+        glGetError();
+
+        std::vector<int> attribs =
+            {
+                WGL_CONTEXT_MAJOR_VERSION_ARB, MajorVersion,
+                WGL_CONTEXT_MINOR_VERSION_ARB, MinorVersion //
+            };
+        if (ProfileMask != 0)
+        {
+            attribs.push_back(WGL_CONTEXT_PROFILE_MASK_ARB);
+            attribs.push_back(ProfileMask);
+        }
+        attribs.push_back(0);
+
+        m_WorkerContext = wglCreateContextAttribsARB(hDC, MainCtx, attribs.data());
+    }
+    else
+    {
+        m_WorkerContext = wglCreateContext(hDC);
+        if (m_WorkerContext != NULL && !wglShareLists(MainCtx, m_WorkerContext))
+        {
+            wglDeleteContext(m_WorkerContext);
+            m_WorkerContext = NULL;
+        }
+    }
+
+    if (m_WorkerContext == NULL)
+    {
+        LOG_WARNING_MESSAGE("Failed to create worker GL context");
+        return;
+    }
+
+    m_WorkerDC = hDC;
+    LOG_INFO_MESSAGE("Created worker GL context");
+}
+
+bool GLContext::MakeWorkerContextCurrent()
+{
+    VERIFY(m_WorkerContext != NULL, "Worker context has not been created");
+    return wglMakeCurrent(m_WorkerDC, m_WorkerContext) != FALSE;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    wglMakeCurrent(NULL, NULL);
+}
+
 } // namespace Diligent
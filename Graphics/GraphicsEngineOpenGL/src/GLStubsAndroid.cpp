@@ -159,6 +159,18 @@
     DECLARE_GL_FUNCTION( glCopyImageSubData, PFNGLCOPYIMAGESUBDATAPROC, GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth )
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    DECLARE_GL_FUNCTION( glBufferStorage, PFNGLBUFFERSTORAGEPROC, GLenum target, GLsizeiptr size, const void *data, GLbitfield flags )
+#endif
+
+#ifdef LOAD_GL_VERTEX_ATTRIB_BINDING
+    DECLARE_GL_FUNCTION( glBindVertexBuffer, PFNGLBINDVERTEXBUFFERPROC, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride )
+    DECLARE_GL_FUNCTION( glVertexAttribFormat, PFNGLVERTEXATTRIBFORMATPROC, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset )
+    DECLARE_GL_FUNCTION( glVertexAttribIFormat, PFNGLVERTEXATTRIBIFORMATPROC, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset )
+    DECLARE_GL_FUNCTION( glVertexAttribBinding, PFNGLVERTEXATTRIBBINDINGPROC, GLuint attribindex, GLuint bindingindex )
+    DECLARE_GL_FUNCTION( glVertexBindingDivisor, PFNGLVERTEXBINDINGDIVISORPROC, GLuint bindingindex, GLuint divisor )
+#endif
+
 #ifdef LOAD_GL_PATCH_PARAMTER_I
     DECLARE_GL_FUNCTION( glPatchParameteri, PFNGLPATCHPARAMETERIPROC, GLenum pname, GLint value )
 #endif
@@ -356,6 +368,20 @@ Func = (FuncType)eglGetProcAddress( #Func );\
     LOAD_GL_FUNCTION(glCopyImageSubData, PFNGLCOPYIMAGESUBDATAPROC)
 #endif
 
+#ifdef LOAD_GL_BUFFER_STORAGE
+    // GLES only exposes the function through GL_EXT_buffer_storage
+    glBufferStorage = (PFNGLBUFFERSTORAGEPROC)eglGetProcAddress( "glBufferStorageEXT" );
+    if( !glBufferStorage )glBufferStorage = glBufferStorageStub;
+#endif
+
+#ifdef LOAD_GL_VERTEX_ATTRIB_BINDING
+    LOAD_GL_FUNCTION(glBindVertexBuffer, PFNGLBINDVERTEXBUFFERPROC)
+    LOAD_GL_FUNCTION(glVertexAttribFormat, PFNGLVERTEXATTRIBFORMATPROC)
+    LOAD_GL_FUNCTION(glVertexAttribIFormat, PFNGLVERTEXATTRIBIFORMATPROC)
+    LOAD_GL_FUNCTION(glVertexAttribBinding, PFNGLVERTEXATTRIBBINDINGPROC)
+    LOAD_GL_FUNCTION(glVertexBindingDivisor, PFNGLVERTEXBINDINGDIVISORPROC)
+#endif
+
 #ifdef LOAD_GL_PATCH_PARAMTER_I
     LOAD_GL_FUNCTION(glPatchParameteri, PFNGLPATCHPARAMETERIPROC)
 #endif
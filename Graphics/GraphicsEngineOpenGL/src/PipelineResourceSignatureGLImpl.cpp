@@ -112,6 +112,12 @@ void PipelineResourceSignatureGLImpl::CreateLayout()
         const auto& ResDesc = m_Desc.Resources[i];
         VERIFY(i == 0 || ResDesc.VarType >= m_Desc.Resources[i - 1].VarType, "Resources must be sorted by variable type");
 
+        if ((ResDesc.Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0)
+        {
+            LOG_ERROR_AND_THROW("Pipeline resource signature '", m_Desc.Name, "': resource '", ResDesc.Name,
+                                "' uses PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS flag that is not supported in OpenGL backend.");
+        }
+
         if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER)
         {
             const auto ImtblSamplerIdx = FindImmutableSampler(ResDesc.ShaderStages, ResDesc.Name);
@@ -0,0 +1,236 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineStateCacheGLImpl.hpp"
+#include "RenderDeviceGLImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+struct CacheHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint64 DriverHash;
+    Uint32 NumBinaries;
+    Uint32 Padding;
+};
+
+struct BinaryHeader
+{
+    Uint64 Key;
+    Uint32 Format;
+    Uint32 Size;
+};
+// clang-format on
+
+static constexpr Uint32 CacheMagic   = 0x43505344; // 'DSPC'
+static constexpr Uint32 CacheVersion = 1;
+
+} // namespace
+
+PipelineStateCacheGLImpl::PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceGLImpl*                 pDeviceGL,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    // clang-format off
+    TDeviceObjectBase
+    {
+        pRefCounters,
+        pDeviceGL,
+        CreateInfo.Desc
+    }
+// clang-format on
+{
+    GLint NumBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumBinaryFormats);
+    if (glGetError() != GL_NO_ERROR || NumBinaryFormats == 0)
+        LOG_ERROR_AND_THROW("Program binaries are not supported by the driver");
+
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0)
+    {
+        if (!Deserialize(CreateInfo.pCacheData, CreateInfo.CacheDataSize))
+        {
+            LOG_WARNING_MESSAGE("Initial data of pipeline state cache '", m_Desc.Name,
+                                "' is not compatible with the device and will be ignored.");
+            m_Binaries.clear();
+        }
+    }
+}
+
+PipelineStateCacheGLImpl::~PipelineStateCacheGLImpl()
+{
+}
+
+size_t PipelineStateCacheGLImpl::GetDriverHash()
+{
+    size_t Hash = 0;
+    for (auto Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const auto* Str = reinterpret_cast<const char*>(glGetString(Name));
+        if (Str != nullptr)
+            HashCombine(Hash, CStringHash<Char>{}(Str));
+    }
+    return Hash;
+}
+
+bool PipelineStateCacheGLImpl::Deserialize(const void* pData, size_t DataSize)
+{
+    const auto* pSrc    = static_cast<const Uint8*>(pData);
+    const auto* pSrcEnd = pSrc + DataSize;
+
+    CacheHeader Header;
+    if (DataSize < sizeof(Header))
+        return false;
+    memcpy(&Header, pSrc, sizeof(Header));
+    pSrc += sizeof(Header);
+
+    if (Header.Magic != CacheMagic || Header.Version != CacheVersion || Header.DriverHash != static_cast<Uint64>(GetDriverHash()))
+        return false;
+
+    for (Uint32 i = 0; i < Header.NumBinaries; ++i)
+    {
+        BinaryHeader BinHeader;
+        if (static_cast<size_t>(pSrcEnd - pSrc) < sizeof(BinHeader))
+            return false;
+        memcpy(&BinHeader, pSrc, sizeof(BinHeader));
+        pSrc += sizeof(BinHeader);
+
+        if (static_cast<size_t>(pSrcEnd - pSrc) < BinHeader.Size)
+            return false;
+
+        auto& Binary  = m_Binaries[static_cast<size_t>(BinHeader.Key)];
+        Binary.Format = BinHeader.Format;
+        Binary.Data.assign(pSrc, pSrc + BinHeader.Size);
+        pSrc += BinHeader.Size;
+    }
+
+    return true;
+}
+
+GLObjectWrappers::GLProgramObj PipelineStateCacheGLImpl::LoadProgram(size_t Key, bool IsSeparableProgram)
+{
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+
+    auto it = m_Binaries.find(Key);
+    if (it == m_Binaries.end())
+        return GLObjectWrappers::GLProgramObj{false};
+
+    const auto& Binary = it->second;
+
+    GLObjectWrappers::GLProgramObj GLProg{true};
+    if (IsSeparableProgram)
+        glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    glProgramBinary(GLProg, Binary.Format, Binary.Data.data(), static_cast<GLsizei>(Binary.Data.size()));
+
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+    if (glGetError() != GL_NO_ERROR || !IsLinked)
+    {
+        // The binary may be rejected by the driver at any time, e.g. after a driver update
+        m_Binaries.erase(it);
+        return GLObjectWrappers::GLProgramObj{false};
+    }
+
+    return GLProg;
+}
+
+void PipelineStateCacheGLImpl::StoreProgram(size_t Key, const GLObjectWrappers::GLProgramObj& GLProg)
+{
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProg, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+        return;
+
+    ProgramBinary Binary;
+    Binary.Data.resize(static_cast<size_t>(BinaryLength));
+
+    GLsizei Length = 0;
+    glGetProgramBinary(GLProg, BinaryLength, &Length, &Binary.Format, Binary.Data.data());
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to get program binary for pipeline state cache '", m_Desc.Name, "'");
+        return;
+    }
+    Binary.Data.resize(static_cast<size_t>(Length));
+
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+    m_Binaries[Key] = std::move(Binary);
+}
+
+void PipelineStateCacheGLImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "Null pointer provided");
+    if (ppBlob == nullptr)
+        return;
+    DEV_CHECK_ERR(*ppBlob == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    *ppBlob = nullptr;
+
+    std::lock_guard<std::mutex> Lock{m_BinariesMtx};
+
+    size_t DataSize = sizeof(CacheHeader);
+    for (const auto& it : m_Binaries)
+        DataSize += sizeof(BinaryHeader) + it.second.Data.size();
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>{}(DataSize)};
+
+    auto* pDst = static_cast<Uint8*>(pDataBlob->GetDataPtr());
+
+    CacheHeader Header{};
+    Header.Magic       = CacheMagic;
+    Header.Version     = CacheVersion;
+    Header.DriverHash  = static_cast<Uint64>(GetDriverHash());
+    Header.NumBinaries = static_cast<Uint32>(m_Binaries.size());
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+
+    for (const auto& it : m_Binaries)
+    {
+        BinaryHeader BinHeader{};
+        BinHeader.Key    = static_cast<Uint64>(it.first);
+        BinHeader.Format = static_cast<Uint32>(it.second.Format);
+        BinHeader.Size   = static_cast<Uint32>(it.second.Data.size());
+        memcpy(pDst, &BinHeader, sizeof(BinHeader));
+        pDst += sizeof(BinHeader);
+
+        memcpy(pDst, it.second.Data.data(), it.second.Data.size());
+        pDst += it.second.Data.size();
+    }
+    VERIFY_EXPR(pDst == static_cast<Uint8*>(pDataBlob->GetDataPtr()) + DataSize);
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppBlob));
+}
+
+} // namespace Diligent
@@ -34,17 +34,34 @@
 #include "PipelineStateGLImpl.hpp"
 
 #include <unordered_map>
+#include <vector>
 
 #include "RenderDeviceGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "EngineMemory.h"
 
 namespace Diligent
 {
 
+struct PipelineStateGLImpl::AsyncInitData
+{
+    AsyncInitStep Step = AsyncInitStep::WaitPrograms;
+
+    TShaderStages                            Shaders;
+    std::vector<RefCntAutoPtr<ShaderGLImpl>> ShaderRefs;
+    SHADER_TYPE                              ActiveStages = SHADER_TYPE_UNKNOWN;
+
+    RefCntAutoPtr<PipelineStateCacheGLImpl> pPSOCache;
+
+    // Programs whose links the current step waits for, and the separable program cache keys
+    std::vector<ShaderGLImpl::PendingProgram> PendingPrograms;
+    std::vector<size_t>                       Keys;
+};
+
 static void VerifyResourceMerge(const PipelineStateDesc&                    PSODesc,
                                 const ShaderResourcesGL::GLResourceAttribs& ExistingRes,
                                 const ShaderResourcesGL::GLResourceAttribs& NewResAttribs)
@@ -114,9 +131,9 @@ RefCntAutoPtr<PipelineResourceSignatureGLImpl> PipelineStateGLImpl::CreateDefaul
     {
         auto pImmediateCtx = m_pDevice->GetImmediateContext();
         VERIFY_EXPR(pImmediateCtx);
-        VERIFY_EXPR(m_GLPrograms[0] != 0);
+        VERIFY_EXPR(m_GLPrograms[0] && *m_GLPrograms[0] != 0);
 
-        ProgramResources.LoadUniforms(ActiveStages, m_GLPrograms[0], pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState());
+        ProgramResources.LoadUniforms(ActiveStages, *m_GLPrograms[0], pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState());
         ProgramResources.ProcessConstResources(HandleUB, HandleTexture, HandleImage, HandleSB);
     }
 
@@ -142,8 +159,78 @@ RefCntAutoPtr<PipelineResourceSignatureGLImpl> PipelineStateGLImpl::CreateDefaul
     return TPipelineStateBase::CreateDefaultSignature(Resources, PipelineResourceSignatureDesc{}.CombinedSamplerSuffix, pImmutableSamplers, bIsDeviceInternal);
 }
 
-void PipelineStateGLImpl::InitResourceLayout(const TShaderStages& ShaderStages,
-                                             SHADER_TYPE          ActiveStages)
+void PipelineStateGLImpl::ApplyBindings(GLProgramObj& GLProgram, SHADER_TYPE Stages, GLContextState& CtxState)
+{
+    for (Uint32 s = 0; s < m_SignatureCount; ++s)
+    {
+        const auto& pSignature = m_Signatures[s];
+        if (pSignature != nullptr)
+            pSignature->ApplyBindings(GLProgram, CtxState, Stages, m_BaseBindings[s]);
+    }
+}
+
+size_t PipelineStateGLImpl::ComputeSeparableProgramKey(const ShaderGLImpl& Shader) const
+{
+    // The key must identify all bindings that ApplyBindings() assigns to the program.
+    // Signature hash does not include resource names, so hash them separately.
+    size_t Key = ComputeHash(Shader.GetSourceHash());
+    for (Uint32 s = 0; s < m_SignatureCount; ++s)
+    {
+        const auto& pSignature = m_Signatures[s];
+        if (pSignature == nullptr)
+            continue;
+
+        HashCombine(Key, s, pSignature->GetHash());
+        for (Uint32 r = 0; r < pSignature->GetTotalResourceCount(); ++r)
+            HashCombine(Key, CStringHash<Char>{}(pSignature->GetResourceDesc(r).Name));
+
+        for (Uint32 range = 0; range < BINDING_RANGE_COUNT; ++range)
+            HashCombine(Key, m_BaseBindings[s][range]);
+    }
+    return Key;
+}
+
+void PipelineStateGLImpl::BeginSeparablePrograms(const TShaderStages&                       ShaderStages,
+                                                 PipelineStateCacheGLImpl*                  pPSOCache,
+                                                 std::vector<size_t>&                       Keys,
+                                                 std::vector<ShaderGLImpl::PendingProgram>& PendingPrograms)
+{
+    auto& ProgramCache = GetDevice()->GetSeparableProgramCache();
+
+    Keys.resize(ShaderStages.size());
+    PendingPrograms.resize(ShaderStages.size());
+
+    // Start linking all programs that are not found in the cache before waiting
+    // for any of them, so that the driver may link them in parallel.
+    for (size_t i = 0; i < ShaderStages.size(); ++i)
+    {
+        Keys[i]         = ComputeSeparableProgramKey(*ShaderStages[i]);
+        m_GLPrograms[i] = ProgramCache.Find(Keys[i]);
+        if (!m_GLPrograms[i])
+            PendingPrograms[i] = ShaderGLImpl::BeginLinkProgram(&ShaderStages[i], 1, true, pPSOCache);
+    }
+}
+
+void PipelineStateGLImpl::FinishSeparablePrograms(const std::vector<size_t>&                 Keys,
+                                                  std::vector<ShaderGLImpl::PendingProgram>& PendingPrograms)
+{
+    VERIFY_EXPR(Keys.size() == m_NumPrograms && PendingPrograms.size() == m_NumPrograms);
+
+    auto& ProgramCache = GetDevice()->GetSeparableProgramCache();
+    auto& CtxState     = m_pDevice->GetImmediateContext().RawPtr<DeviceContextGLImpl>()->GetContextState();
+    for (Uint32 i = 0; i < m_NumPrograms; ++i)
+    {
+        if (m_GLPrograms[i])
+            continue;
+
+        auto GLProg = ShaderGLImpl::FinishLinkProgram(std::move(PendingPrograms[i]));
+        ApplyBindings(GLProg, m_ShaderTypes[i], CtxState);
+        m_GLPrograms[i] = ProgramCache.Add(Keys[i], std::move(GLProg));
+    }
+}
+
+void PipelineStateGLImpl::InitSignatures(const TShaderStages& ShaderStages,
+                                         SHADER_TYPE          ActiveStages)
 {
     if (m_UsingImplicitSignature)
     {
@@ -152,9 +239,6 @@ void PipelineStateGLImpl::InitResourceLayout(const TShaderStages& ShaderStages,
         VERIFY_EXPR(!m_Signatures[0] || m_Signatures[0]->GetDesc().BindingIndex == 0);
     }
 
-    // Apply resource bindings to programs.
-    auto& CtxState = m_pDevice->GetImmediateContext().RawPtr<DeviceContextGLImpl>()->GetContextState();
-
     PipelineResourceSignatureGLImpl::TBindings Bindings = {};
     for (Uint32 s = 0; s < m_SignatureCount; ++s)
     {
@@ -163,9 +247,6 @@ void PipelineStateGLImpl::InitResourceLayout(const TShaderStages& ShaderStages,
             continue;
 
         m_BaseBindings[s] = Bindings;
-        for (Uint32 p = 0; p < m_NumPrograms; ++p)
-            pSignature->ApplyBindings(m_GLPrograms[p], CtxState, GetShaderStageType(p), Bindings);
-
         pSignature->ShiftBindings(Bindings);
     }
 
@@ -179,7 +260,11 @@ void PipelineStateGLImpl::InitResourceLayout(const TShaderStages& ShaderStages,
         LOG_ERROR_AND_THROW("The number of bindings in range '", GetBindingRangeName(BINDING_RANGE_STORAGE_BUFFER), "' is greater than the maximum allowed (", Limits.MaxStorageBlock, ").");
     if (Bindings[BINDING_RANGE_IMAGE] > static_cast<Uint32>(Limits.MaxImagesUnits))
         LOG_ERROR_AND_THROW("The number of bindings in range '", GetBindingRangeName(BINDING_RANGE_IMAGE), "' is greater than the maximum allowed (", Limits.MaxImagesUnits, ").");
+}
 
+void PipelineStateGLImpl::ValidateResources(const TShaderStages& ShaderStages,
+                                            SHADER_TYPE          ActiveStages)
+{
     if (m_IsProgramPipelineSupported)
     {
         for (size_t i = 0; i < ShaderStages.size(); ++i)
@@ -192,14 +277,44 @@ void PipelineStateGLImpl::InitResourceLayout(const TShaderStages& ShaderStages,
     {
         auto* pImmediateCtx = m_pDevice->GetImmediateContext().RawPtr<DeviceContextGLImpl>();
         VERIFY_EXPR(pImmediateCtx != nullptr);
-        VERIFY_EXPR(m_GLPrograms[0] != 0);
+        VERIFY_EXPR(m_GLPrograms[0] && *m_GLPrograms[0] != 0);
 
         std::shared_ptr<ShaderResourcesGL> pResources{new ShaderResourcesGL{}};
-        pResources->LoadUniforms(ActiveStages, m_GLPrograms[0], pImmediateCtx->GetContextState());
+        pResources->LoadUniforms(ActiveStages, *m_GLPrograms[0], pImmediateCtx->GetContextState());
         ValidateShaderResources(std::move(pResources), m_Desc.Name, ActiveStages);
     }
 }
 
+void PipelineStateGLImpl::FinishProgram(ShaderGLImpl::PendingProgram&& Pending)
+{
+    VERIFY_EXPR(!m_IsProgramPipelineSupported);
+    m_GLPrograms[0] = std::make_shared<GLProgramObj>(ShaderGLImpl::FinishLinkProgram(std::move(Pending)));
+    m_GLPrograms[0]->SetName(m_Desc.Name);
+}
+
+void PipelineStateGLImpl::InitResourceLayout(const TShaderStages&      ShaderStages,
+                                             SHADER_TYPE               ActiveStages,
+                                             PipelineStateCacheGLImpl* pPSOCache)
+{
+    InitSignatures(ShaderStages, ActiveStages);
+
+    // Apply resource bindings to programs.
+    if (m_IsProgramPipelineSupported)
+    {
+        std::vector<size_t>                       Keys;
+        std::vector<ShaderGLImpl::PendingProgram> PendingPrograms;
+        BeginSeparablePrograms(ShaderStages, pPSOCache, Keys, PendingPrograms);
+        FinishSeparablePrograms(Keys, PendingPrograms);
+    }
+    else
+    {
+        auto& CtxState = m_pDevice->GetImmediateContext().RawPtr<DeviceContextGLImpl>()->GetContextState();
+        ApplyBindings(*m_GLPrograms[0], ActiveStages, CtxState);
+    }
+
+    ValidateResources(ShaderStages, ActiveStages);
+}
+
 template <typename PSOCreateInfoType>
 void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInfo, const TShaderStages& ShaderStages)
 {
@@ -212,7 +327,7 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
     FixedLinearAllocator MemPool{GetRawAllocator()};
 
     ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
-    MemPool.AddSpace<GLProgramObj>(m_NumPrograms);
+    MemPool.AddSpace<SharedGLProgramObj>(m_NumPrograms);
     const auto SignCount = GetResourceSignatureCount(); // Must be called after ReserveSpaceForPipelineDesc()
     MemPool.AddSpace<TBindings>(SignCount);
     MemPool.AddSpace<SHADER_TYPE>(m_NumPrograms);
@@ -220,7 +335,7 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
     MemPool.Reserve();
 
     InitializePipelineDesc(CreateInfo, MemPool);
-    m_GLPrograms   = MemPool.ConstructArray<GLProgramObj>(m_NumPrograms, false);
+    m_GLPrograms   = MemPool.ConstructArray<SharedGLProgramObj>(m_NumPrograms);
     m_BaseBindings = MemPool.ConstructArray<TBindings>(SignCount);
     m_ShaderTypes  = MemPool.ConstructArray<SHADER_TYPE>(m_NumPrograms, SHADER_TYPE_UNKNOWN);
 
@@ -233,25 +348,130 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
         ActiveStages |= ShaderType;
     }
 
-    // Create programs.
+    auto* pPSOCacheGL = ValidatedCast<PipelineStateCacheGLImpl>(CreateInfo.pPSOCache);
+
     if (m_IsProgramPipelineSupported)
     {
+        // Separable programs are created once the resource bindings are known
         for (size_t i = 0; i < ShaderStages.size(); ++i)
+            m_ShaderTypes[i] = ShaderStages[i]->GetDesc().ShaderType;
+    }
+    else
+    {
+        m_ShaderTypes[0] = ActiveStages;
+    }
+
+    if ((CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 && GetDevice()->GetDeviceLimits().ParallelShaderCompile)
+    {
+        // The driver links the programs in background threads, and GetStatus() completes
+        // the initialization when the links are finished, see AdvanceAsyncInitialization().
+        std::unique_ptr<AsyncInitData> pAsyncInit{new AsyncInitData{}};
+        pAsyncInit->Shaders = ShaderStages;
+        for (auto* pShaderGL : ShaderStages)
+            pAsyncInit->ShaderRefs.emplace_back(pShaderGL);
+        pAsyncInit->ActiveStages = ActiveStages;
+        pAsyncInit->pPSOCache    = pPSOCacheGL;
+        if (m_IsProgramPipelineSupported)
         {
-            auto* pShaderGL  = ShaderStages[i];
-            m_GLPrograms[i]  = GLProgramObj{ShaderGLImpl::LinkProgram(&ShaderStages[i], 1, true)};
-            m_ShaderTypes[i] = pShaderGL->GetDesc().ShaderType;
+            // Resource signatures can only be created after the shader resources have been loaded
+            pAsyncInit->Step = AsyncInitStep::WaitShaderResources;
         }
+        else
+        {
+            pAsyncInit->PendingPrograms.emplace_back(ShaderGLImpl::BeginLinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false, pPSOCacheGL));
+            pAsyncInit->Step = AsyncInitStep::WaitPrograms;
+        }
+        m_pAsyncInit = std::move(pAsyncInit);
+        SetStatus(PIPELINE_STATE_STATUS_PENDING);
+        return;
+    }
+
+    if (!m_IsProgramPipelineSupported)
+    {
+        // The program is required to create the default resource signature
+        FinishProgram(ShaderGLImpl::BeginLinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false, pPSOCacheGL));
+    }
+
+    InitResourceLayout(ShaderStages, ActiveStages, pPSOCacheGL);
+}
+
+bool PipelineStateGLImpl::AdvanceAsyncInitialization()
+{
+    VERIFY_EXPR(m_pAsyncInit);
+    auto& Init = *m_pAsyncInit;
+
+    if (Init.Step == AsyncInitStep::WaitShaderResources)
+    {
+        for (const auto* pShaderGL : Init.Shaders)
+        {
+            if (!pShaderGL->AreShaderResourcesReady())
+                return false;
+        }
+
+        InitSignatures(Init.Shaders, Init.ActiveStages);
+        BeginSeparablePrograms(Init.Shaders, Init.pPSOCache, Init.Keys, Init.PendingPrograms);
+        Init.Step = AsyncInitStep::WaitPrograms;
+    }
+
+    VERIFY_EXPR(Init.Step == AsyncInitStep::WaitPrograms);
+    for (const auto& Pending : Init.PendingPrograms)
+    {
+        if (!ShaderGLImpl::IsLinkComplete(Pending))
+            return false;
+    }
+
+    if (m_IsProgramPipelineSupported)
+    {
+        FinishSeparablePrograms(Init.Keys, Init.PendingPrograms);
     }
     else
     {
-        m_GLPrograms[0]  = ShaderGLImpl::LinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false);
-        m_ShaderTypes[0] = ActiveStages;
+        VERIFY_EXPR(Init.PendingPrograms.size() == 1);
+        FinishProgram(std::move(Init.PendingPrograms[0]));
+        InitSignatures(Init.Shaders, Init.ActiveStages);
 
-        m_GLPrograms[0].SetName(m_Desc.Name);
+        auto& CtxState = m_pDevice->GetImmediateContext().RawPtr<DeviceContextGLImpl>()->GetContextState();
+        ApplyBindings(*m_GLPrograms[0], Init.ActiveStages, CtxState);
     }
 
-    InitResourceLayout(ShaderStages, ActiveStages);
+    ValidateResources(Init.Shaders, Init.ActiveStages);
+    return true;
+}
+
+PIPELINE_STATE_STATUS PipelineStateGLImpl::GetStatus() const
+{
+    const auto Status = TPipelineStateBase::GetStatus();
+    if (Status != PIPELINE_STATE_STATUS_PENDING)
+        return Status;
+
+    // Programs can only be queried from a thread that has a current GL context
+    if (m_pDevice->GetCurrentNativeGLContext() == GLContext::NativeGLContextType{})
+        return Status;
+
+    std::unique_lock<std::mutex> Lock{m_AsyncInitMtx, std::try_to_lock};
+    if (!Lock || !m_pAsyncInit)
+        return TPipelineStateBase::GetStatus();
+
+    // The status query is logically const: it only completes the initialization that was started by the constructor
+    auto* const pThis = const_cast<PipelineStateGLImpl*>(this);
+
+    auto NewStatus = PIPELINE_STATE_STATUS_FAILED;
+    try
+    {
+        if (!pThis->AdvanceAsyncInitialization())
+            return PIPELINE_STATE_STATUS_PENDING;
+
+        NewStatus = PIPELINE_STATE_STATUS_READY;
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to asynchronously create pipeline state '", (m_Desc.Name != nullptr ? m_Desc.Name : ""), "'");
+    }
+    // Release the shaders and pending programs
+    pThis->m_pAsyncInit.reset();
+
+    pThis->SetStatus(NewStatus);
+    return NewStatus;
 }
 
 PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                    pRefCounters,
@@ -334,11 +554,13 @@ void PipelineStateGLImpl::Destruct()
 {
     GetDevice()->OnDestroyPSO(*this);
 
+    m_pAsyncInit.reset();
+
     if (m_GLPrograms)
     {
         for (Uint32 i = 0; i < m_NumPrograms; ++i)
         {
-            m_GLPrograms[i].~GLProgramObj();
+            m_GLPrograms[i].~SharedGLProgramObj();
         }
         m_GLPrograms = nullptr;
     }
@@ -358,6 +580,31 @@ SHADER_TYPE PipelineStateGLImpl::GetShaderStageType(Uint32 Index) const
 }
 
 
+void PipelineStateGLImpl::SwapShaderObjects(PipelineStateGLImpl& Other)
+{
+    VERIFY_EXPR(m_NumPrograms == Other.m_NumPrograms);
+    for (Uint32 i = 0; i < m_NumPrograms; ++i)
+    {
+        VERIFY_EXPR(m_ShaderTypes[i] == Other.m_ShaderTypes[i]);
+        std::swap(m_GLPrograms[i], Other.m_GLPrograms[i]);
+    }
+
+    {
+        // Program pipelines reference the programs, so they are exchanged as well
+        ThreadingTools::LockHelper Lock{m_ProgPipelineLockFlag};
+        ThreadingTools::LockHelper OtherLock{Other.m_ProgPipelineLockFlag};
+        std::swap(m_GLProgPipelines, Other.m_GLProgPipelines);
+    }
+
+#ifdef DILIGENT_DEVELOPMENT
+    std::swap(m_ShaderResources, Other.m_ShaderResources);
+    std::swap(m_ShaderNames, Other.m_ShaderNames);
+    std::swap(m_ResourceAttibutions, Other.m_ResourceAttibutions);
+    DvpRemapResourceAttributions(m_ResourceAttibutions);
+    Other.DvpRemapResourceAttributions(Other.m_ResourceAttibutions);
+#endif
+}
+
 void PipelineStateGLImpl::CommitProgram(GLContextState& State)
 {
     if (m_IsProgramPipelineSupported)
@@ -373,7 +620,7 @@ void PipelineStateGLImpl::CommitProgram(GLContextState& State)
     else
     {
         VERIFY_EXPR(m_GLPrograms != nullptr);
-        State.SetProgram(m_GLPrograms[0]);
+        State.SetProgram(*m_GLPrograms[0]);
     }
 }
 
@@ -396,7 +643,7 @@ GLObjectWrappers::GLPipelineObj& PipelineStateGLImpl::GetGLProgramPipeline(GLCon
         // If the program has an active code for each stage mentioned in set flags,
         // then that code will be used by the pipeline. If program is 0, then the given
         // stages are cleared from the pipeline.
-        glUseProgramStages(Pipeline, GLShaderBit, m_GLPrograms[i]);
+        glUseProgramStages(Pipeline, GLShaderBit, *m_GLPrograms[i]);
         CHECK_GL_ERROR("glUseProgramStages() failed");
     }
 
@@ -47,12 +47,15 @@
 #include "RenderPassGLImpl.hpp"
 #include "FramebufferGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
 
+#include <limits>
+
 namespace Diligent
 {
 
@@ -172,7 +175,10 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
         GraphicsAdapterInfo{} // Adapter properties can only be queried after GL context is initialized
     },
     // Device caps must be filled in before the constructor of Pipeline Cache is called!
-    m_GLContext{EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc}
+    m_GLContext        {EngineCI, m_DeviceInfo.Type, m_DeviceInfo.APIVersion, pSCDesc},
+    m_FBOCacheMaxSize  {EngineCI.FramebufferCacheSize  },
+    m_FBOCacheMaxAge   {EngineCI.FramebufferCacheMaxAge},
+    m_GLValidationFlags{EngineCI.GLValidationFlags     }
 // clang-format on
 {
     VerifyEngineGLCreateInfo(EngineCI);
@@ -256,6 +262,36 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
             CHECK_GL_ERROR("glGetIntegerv(GL_MAX_IMAGE_UNITS) failed");
 #endif
         }
+
+#if GL_ARB_buffer_storage
+        m_DeviceLimits.BufferStorage =
+            (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && m_DeviceInfo.APIVersion >= Version{4, 4}) ||
+            CheckExtension("GL_ARB_buffer_storage") ||
+            CheckExtension("GL_EXT_buffer_storage");
+#endif
+
+#if GL_ARB_vertex_attrib_binding
+        m_DeviceLimits.VertexAttribBinding =
+            (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && m_DeviceInfo.APIVersion >= Version{4, 3}) ||
+            (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GLES && m_DeviceInfo.APIVersion >= Version{3, 1}) ||
+            CheckExtension("GL_ARB_vertex_attrib_binding");
+#endif
+
+#if GL_KHR_parallel_shader_compile
+        // Let the driver compile shaders and link programs in background threads.
+        // The work is overlapped with the application until the compile or link status is queried.
+        m_DeviceLimits.ParallelShaderCompile = CheckExtension("GL_KHR_parallel_shader_compile");
+        if (m_DeviceLimits.ParallelShaderCompile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            CHECK_GL_ERROR("glMaxShaderCompilerThreadsKHR() failed");
+        }
+#endif
+    }
+
+    if (EngineCI.CreateWorkerContext && !m_GLContext.HasWorkerContext())
+    {
+        LOG_WARNING_MESSAGE("Worker GL context is not available: buffers and textures can only be created in the thread that owns the GL context");
     }
 }
 
@@ -270,12 +306,68 @@ void RenderDeviceGLImpl::InitTexRegionRender()
     m_pTexRegionRender.reset(new TexRegionRender(this));
 }
 
-void RenderDeviceGLImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer, bool bIsDeviceInternal)
+RenderDeviceGLImpl::WorkerContextScope::WorkerContextScope(RenderDeviceGLImpl& Device) :
+    m_Device{Device}
+{
+    auto& GLCtx = m_Device.m_GLContext;
+    if (!GLCtx.HasWorkerContext() || GLCtx.GetCurrentNativeGLContext() != GLContext::NativeGLContextType{})
+    {
+        // The calling thread owns a GL context or there is no worker context
+        return;
+    }
+
+    m_Lock = std::unique_lock<std::mutex>{m_Device.m_WorkerContextMtx};
+    if (!GLCtx.MakeWorkerContextCurrent())
+    {
+        m_Lock.unlock();
+        LOG_ERROR_AND_THROW("Failed to make the worker GL context current");
+    }
+
+    if (!m_Device.m_pWorkerContextState)
+        m_Device.m_pWorkerContextState.reset(new GLContextState{&m_Device});
+}
+
+RenderDeviceGLImpl::WorkerContextScope::~WorkerContextScope()
+{
+    if (!m_Lock.owns_lock())
+        return;
+
+    // Objects created in one context may only be used by another context after the
+    // commands that created and initialized them have completed.
+    {
+        GLObjectWrappers::GLSyncObj Fence{glFenceSync(
+            GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+            0                              // Flags, must be 0
+            )};
+        if (Fence != GLsync{})
+        {
+            auto res = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max());
+            VERIFY_EXPR(res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED);
+            (void)res;
+        }
+        else
+        {
+            glFinish();
+        }
+        // The fence must be deleted while the worker context is current
+    }
+    m_Device.m_GLContext.ReleaseWorkerContext();
+}
+
+GLContextState& RenderDeviceGLImpl::GetActiveGLContextState()
 {
+    if (m_pWorkerContextState && m_GLContext.GetCurrentNativeGLContext() == m_GLContext.GetWorkerNativeGLContext())
+        return *m_pWorkerContextState;
+
     auto spDeviceContext = GetImmediateContext();
     VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-    auto* pDeviceContextGL = spDeviceContext.RawPtr<DeviceContextGLImpl>();
-    CreateBufferImpl(ppBuffer, BuffDesc, std::ref(pDeviceContextGL->GetContextState()), pBuffData, bIsDeviceInternal);
+    return spDeviceContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+}
+
+void RenderDeviceGLImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer, bool bIsDeviceInternal)
+{
+    WorkerContextScope WorkerCtxScope{*this};
+    CreateBufferImpl(ppBuffer, BuffDesc, std::ref(GetActiveGLContextState()), pBuffData, bIsDeviceInternal);
 }
 
 void RenderDeviceGLImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* BuffData, IBuffer** ppBuffer)
@@ -304,15 +396,25 @@ void RenderDeviceGLImpl::CreateShader(const ShaderCreateInfo& ShaderCreateInfo,
     CreateShader(ShaderCreateInfo, ppShader, false);
 }
 
+void RenderDeviceGLImpl::CreateShaders(const ShaderCreateInfo* pShaderCIs, Uint32 NumShaders, IShader** ppShaders)
+{
+    DEV_CHECK_ERR(NumShaders == 0 || (pShaderCIs != nullptr && ppShaders != nullptr), "Null pointer provided");
+    if (pShaderCIs == nullptr || ppShaders == nullptr)
+        return;
+
+    // GL objects can only be created in the thread that owns the context
+    for (Uint32 i = 0; i < NumShaders; ++i)
+        CreateShader(pShaderCIs[i], &ppShaders[i], false);
+}
+
 void RenderDeviceGLImpl::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture, bool bIsDeviceInternal)
 {
     CreateDeviceObject(
         "texture", TexDesc, ppTexture,
         [&]() //
         {
-            auto spDeviceContext = GetImmediateContext();
-            VERIFY(spDeviceContext, "Immediate device context has been destroyed");
-            auto& GLState = spDeviceContext.RawPtr<DeviceContextGLImpl>()->GetContextState();
+            WorkerContextScope WorkerCtxScope{*this};
+            auto&              GLState = GetActiveGLContextState();
 
             const auto& FmtInfo = GetTextureFormatInfo(TexDesc.Format);
             if (!FmtInfo.Supported)
@@ -515,6 +617,12 @@ void RenderDeviceGLImpl::CreatePipelineResourceSignature(const PipelineResourceS
     CreatePipelineResourceSignatureImpl(ppSignature, Desc, IsDeviceInternal);
 }
 
+void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                  IPipelineStateCache**               ppPSOCache)
+{
+    CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
+}
+
 void RenderDeviceGLImpl::CreateBLAS(const BottomLevelASDesc& Desc,
                                     IBottomLevelAS**         ppBLAS)
 {
@@ -658,6 +766,10 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         Features.InstanceDataStepRate       = DEVICE_FEATURE_STATE_ENABLED;
         Features.NativeFence                = DEVICE_FEATURE_STATE_DISABLED;
         Features.TileShaders                = DEVICE_FEATURE_STATE_DISABLED;
+        Features.SparseResources            = DEVICE_FEATURE_STATE_DISABLED;
+        Features.SpecializationConstants    = DEVICE_FEATURE_STATE_DISABLED;
+        Features.DynamicPipelineStates      = DEVICE_FEATURE_STATE_DISABLED;
+        Features.BufferDeviceAddress        = DEVICE_FEATURE_STATE_DISABLED;
 
         {
             bool WireframeFillSupported = (glPolygonMode != nullptr);
@@ -731,6 +843,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             ENABLE_FEATURE(ShaderInt8,                    CheckExtension("GL_EXT_shader_explicit_arithmetic_types_int8"));
             ENABLE_FEATURE(ResourceBuffer8BitAccess,      CheckExtension("GL_EXT_shader_8bit_storage"));
             ENABLE_FEATURE(UniformBuffer8BitAccess,       CheckExtension("GL_EXT_shader_8bit_storage"));
+            ENABLE_FEATURE(ConditionalRendering,          true); // Core since OpenGL 3.0
             // clang-format on
 
             TexProps.MaxTexture1DDimension     = MaxTextureSize;
@@ -753,6 +866,24 @@ void RenderDeviceGLImpl::InitAdapterInfo()
 #if defined(_MSC_VER) && defined(_WIN64)
             static_assert(sizeof(SamProps) == 3, "Did you add a new member to SamplerProperites? Please initialize it here.");
 #endif
+
+            auto& DrawCommandProps{m_AdapterInfo.DrawCommand};
+            DrawCommandProps.CapFlags = DRAW_COMMAND_CAP_FLAG_NONE;
+            if (IsGL43OrAbove || CheckExtension("GL_ARB_multi_draw_indirect"))
+                DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT;
+            if (CheckExtension("GL_ARB_indirect_parameters"))
+                DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT;
+            DrawCommandProps.MaxDrawIndirectCount = ~0u;
+#if defined(_MSC_VER) && defined(_WIN64)
+            static_assert(sizeof(DrawCommandProps) == 8, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
+#endif
+
+            // Deferred contexts are not supported in OpenGL
+            auto& CmdListProps{m_AdapterInfo.CommandList};
+            CmdListProps.CapFlags = COMMAND_LIST_CAP_FLAG_NONE;
+#if defined(_MSC_VER) && defined(_WIN64)
+            static_assert(sizeof(CmdListProps) == 1, "Did you add a new member to CommandListProperties? Please initialize it here.");
+#endif
         }
         else
         {
@@ -801,6 +932,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             ENABLE_FEATURE(ShaderInt8,                strstr(Extensions, "shader_explicit_arithmetic_types_int8"));
             ENABLE_FEATURE(ResourceBuffer8BitAccess,  strstr(Extensions, "shader_8bit_storage"));
             ENABLE_FEATURE(UniformBuffer8BitAccess,   strstr(Extensions, "shader_8bit_storage"));
+            ENABLE_FEATURE(ConditionalRendering,      false); // Not supported in GLES
             // clang-format on
 
             TexProps.MaxTexture1DDimension     = 0; // Not supported in GLES 3.2
@@ -823,6 +955,14 @@ void RenderDeviceGLImpl::InitAdapterInfo()
 #if defined(_MSC_VER) && defined(_WIN64)
             static_assert(sizeof(SamProps) == 3, "Did you add a new member to SamplerProperites? Please initialize it here.");
 #endif
+
+            // Multiple indirect draws are emulated with a loop in OpenGLES
+            auto& DrawCommandProps{m_AdapterInfo.DrawCommand};
+            DrawCommandProps.CapFlags             = DRAW_COMMAND_CAP_FLAG_NONE;
+            DrawCommandProps.MaxDrawIndirectCount = ~0u;
+#if defined(_MSC_VER) && defined(_WIN64)
+            static_assert(sizeof(DrawCommandProps) == 8, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
+#endif
         }
 
 #ifdef GL_KHR_shader_subgroup
@@ -890,7 +1030,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
     }
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 37, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 42, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 }
 
@@ -1347,7 +1487,38 @@ void RenderDeviceGLImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 FBOCache& RenderDeviceGLImpl::GetFBOCache(GLContext::NativeGLContextType Context)
 {
     ThreadingTools::LockHelper FBOCacheLock{m_FBOCacheLockFlag};
-    return m_FBOCache[Context];
+
+    auto It = m_FBOCache.find(Context);
+    if (It == m_FBOCache.end())
+    {
+        It = m_FBOCache.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(Context),
+                                std::forward_as_tuple(m_FBOCacheMaxSize, m_FBOCacheMaxAge))
+                 .first;
+    }
+    return It->second;
+}
+
+void RenderDeviceGLImpl::GetFramebufferCacheStatistics(FramebufferCacheStatistics& Stats)
+{
+    Stats = {};
+
+    ThreadingTools::LockHelper FBOCacheLock{m_FBOCacheLockFlag};
+    for (auto& FBOCacheIt : m_FBOCache)
+        FBOCacheIt.second.GetStatistics(Stats);
+}
+
+void RenderDeviceGLImpl::CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects)
+{
+    TRenderDeviceBase::CaptureResourceSnapshot(Snapshot, ppObjects);
+
+    FramebufferCacheStatistics FBOCacheStats;
+    GetFramebufferCacheStatistics(FBOCacheStats);
+    Snapshot.NumCachedFramebuffers = FBOCacheStats.NumFramebuffers;
+
+    ThreadingTools::LockHelper VAOCacheLock{m_VAOCacheLockFlag};
+    for (auto& VAOCacheIt : m_VAOCache)
+        Snapshot.NumCachedVAOs += VAOCacheIt.second.GetNumVAOs();
 }
 
 void RenderDeviceGLImpl::OnReleaseTexture(ITexture* pTexture)
@@ -1360,7 +1531,16 @@ void RenderDeviceGLImpl::OnReleaseTexture(ITexture* pTexture)
 VAOCache& RenderDeviceGLImpl::GetVAOCache(GLContext::NativeGLContextType Context)
 {
     ThreadingTools::LockHelper VAOCacheLock{m_VAOCacheLockFlag};
-    return m_VAOCache[Context];
+
+    auto It = m_VAOCache.find(Context);
+    if (It == m_VAOCache.end())
+    {
+        It = m_VAOCache.emplace(std::piecewise_construct,
+                                std::forward_as_tuple(Context),
+                                std::forward_as_tuple(m_DeviceLimits.VertexAttribBinding))
+                 .first;
+    }
+    return It->second;
 }
 
 void RenderDeviceGLImpl::OnDestroyPSO(PipelineStateGLImpl& PSO)
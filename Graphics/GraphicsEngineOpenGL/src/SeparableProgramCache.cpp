@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "SeparableProgramCache.hpp"
+
+namespace Diligent
+{
+
+SeparableProgramCache::SharedGLProgramObj SeparableProgramCache::Find(size_t Key)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Programs.find(Key);
+    if (it != m_Programs.end())
+    {
+        if (auto pProgram = it->second.lock())
+            return pProgram;
+
+        m_Programs.erase(it);
+    }
+
+    return {};
+}
+
+SeparableProgramCache::SharedGLProgramObj SeparableProgramCache::Add(size_t Key, GLObjectWrappers::GLProgramObj&& Program)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto& WeakProgram = m_Programs[Key];
+    if (auto pExistingProgram = WeakProgram.lock())
+        return pExistingProgram;
+
+    SharedGLProgramObj pProgram{new GLObjectWrappers::GLProgramObj{std::move(Program)}};
+    WeakProgram = pProgram;
+
+    // Entries of released programs are only removed when they are looked up,
+    // so purge them periodically to keep the map from growing indefinitely.
+    if (++m_NumAddedSincePurge >= 256)
+        PurgeExpired();
+
+    return pProgram;
+}
+
+void SeparableProgramCache::PurgeExpired()
+{
+    for (auto it = m_Programs.begin(); it != m_Programs.end();)
+    {
+        if (it->second.expired())
+            it = m_Programs.erase(it);
+        else
+            ++it;
+    }
+    m_NumAddedSincePurge = 0;
+}
+
+} // namespace Diligent
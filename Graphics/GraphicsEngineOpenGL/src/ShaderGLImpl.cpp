@@ -37,6 +37,8 @@
 #include "GLSLUtils.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
+#include "HashUtils.hpp"
 
 using namespace Diligent;
 
@@ -106,14 +108,27 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
     }
 
 
+    m_SourceHash = ComputeHash(static_cast<Uint32>(m_Desc.ShaderType));
+    for (size_t i = 0; i < ShaderStrings.size(); ++i)
+        HashCombine(m_SourceHash, ComputeHashRaw(ShaderStrings[i], static_cast<size_t>(Lengths[i])));
+
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lengths.data());
     // When the shader is compiled, it will be compiled as if all of the given strings were concatenated end-to-end.
     glCompileShader(m_GLShaderObj);
+
+    // Querying the compile status waits for the compilation to complete. When the driver compiles
+    // shaders in background threads, defer the check until the shader is linked into a program,
+    // unless the application requested the compiler output.
+    m_IsCompileStatusPending = pDeviceGL->GetDeviceLimits().ParallelShaderCompile && ShaderCI.ppCompilerOutput == nullptr;
+
     GLint compiled = GL_FALSE;
-    // Get compilation status
-    glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
-    if (!compiled)
+    if (!m_IsCompileStatusPending)
+    {
+        // Get compilation status
+        glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
+    }
+    if (!m_IsCompileStatusPending && !compiled)
     {
         std::string FullSource;
         for (const auto* str : ShaderStrings)
@@ -161,15 +176,11 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
 
     if (DeviceInfo.Features.SeparablePrograms)
     {
-        ShaderGLImpl* const            ThisShader[]  = {this};
-        GLObjectWrappers::GLProgramObj Program       = LinkProgram(ThisShader, 1, true);
-        auto                           pImmediateCtx = m_pDevice->GetImmediateContext();
-        VERIFY_EXPR(pImmediateCtx);
-        auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
-
-        std::unique_ptr<ShaderResourcesGL> pResources{new ShaderResourcesGL{}};
-        pResources->LoadUniforms(m_Desc.ShaderType, Program, GLState);
-        m_pShaderResources.reset(pResources.release());
+        // Only start linking the program that is used to query the shader resources.
+        // The link status is checked when the resources are requested, so that the driver
+        // can link the program while the application creates other objects.
+        ShaderGLImpl* const ThisShader[] = {this};
+        m_ResourcesProgram               = BeginLinkProgram(ThisShader, 1, true);
     }
 }
 
@@ -180,16 +191,116 @@ ShaderGLImpl::~ShaderGLImpl()
 IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
 
 
-GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+void ShaderGLImpl::VerifyCompileStatus() const
+{
+    if (!m_IsCompileStatusPending)
+        return;
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(m_GLShaderObj, GL_COMPILE_STATUS, &compiled);
+    if (compiled)
+    {
+        m_IsCompileStatusPending = false;
+        return;
+    }
+
+    // Keep the status pending so that every program that uses this shader fails
+    std::stringstream ErrorMsgSS;
+    ErrorMsgSS << "Failed to compile shader '" << (m_Desc.Name != nullptr ? m_Desc.Name : "") << '\'' << std::endl;
+
+    int infoLogLen = 0;
+    glGetShaderiv(m_GLShaderObj, GL_INFO_LOG_LENGTH, &infoLogLen);
+    if (infoLogLen > 0)
+    {
+        std::vector<GLchar> infoLog(infoLogLen);
+        glGetShaderInfoLog(m_GLShaderObj, infoLogLen, nullptr, infoLog.data());
+        ErrorMsgSS << "InfoLog:" << std::endl
+                   << infoLog.data() << std::endl;
+    }
+    LOG_ERROR_AND_THROW(ErrorMsgSS.str().c_str());
+}
+
+const std::shared_ptr<const ShaderResourcesGL>& ShaderGLImpl::GetShaderResources() const
+{
+    std::lock_guard<std::mutex> Lock{m_ResourcesMtx};
+    if (!m_pShaderResources && m_ResourcesProgram.Program)
+    {
+        std::unique_ptr<ShaderResourcesGL> pResources{new ShaderResourcesGL{}};
+        try
+        {
+            GLObjectWrappers::GLProgramObj Program = FinishLinkProgram(std::move(m_ResourcesProgram));
+
+            auto pImmediateCtx = m_pDevice->GetImmediateContext();
+            VERIFY_EXPR(pImmediateCtx);
+            auto& GLState = pImmediateCtx.RawPtr<DeviceContextGLImpl>()->GetContextState();
+
+            pResources->LoadUniforms(m_Desc.ShaderType, Program, GLState);
+        }
+        catch (...)
+        {
+            // The shader failed to compile. The error has been logged, and it will be
+            // reported again by any pipeline that uses this shader.
+        }
+        m_pShaderResources.reset(pResources.release());
+    }
+    return m_pShaderResources;
+}
+
+bool ShaderGLImpl::AreShaderResourcesReady() const
+{
+    std::lock_guard<std::mutex> Lock{m_ResourcesMtx};
+    return m_pShaderResources || IsLinkComplete(m_ResourcesProgram);
+}
+
+bool ShaderGLImpl::IsLinkComplete(const PendingProgram& Pending)
+{
+    if (Pending.IsFromCache || !Pending.Program)
+        return true;
+
+#if GL_KHR_parallel_shader_compile
+    GLint IsComplete = GL_TRUE;
+    glGetProgramiv(Pending.Program, GL_COMPLETION_STATUS_KHR, &IsComplete);
+    CHECK_GL_ERROR("glGetProgramiv(GL_COMPLETION_STATUS_KHR) failed");
+    return IsComplete != GL_FALSE;
+#else
+    return true;
+#endif
+}
+
+ShaderGLImpl::PendingProgram ShaderGLImpl::BeginLinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                            Uint32                    NumShaders,
+                                                            bool                      IsSeparableProgram,
+                                                            PipelineStateCacheGLImpl* pPSOCache)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
+    PendingProgram Pending;
+    if (pPSOCache != nullptr)
+    {
+        Pending.pPSOCache = pPSOCache;
+        Pending.CacheKey  = ComputeHash(IsSeparableProgram);
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            HashCombine(Pending.CacheKey, ppShaders[i]->GetSourceHash());
+
+        auto CachedProg = pPSOCache->LoadProgram(Pending.CacheKey, IsSeparableProgram);
+        if (CachedProg)
+        {
+            Pending.Program     = std::move(CachedProg);
+            Pending.IsFromCache = true;
+            return Pending;
+        }
+    }
+
     GLObjectWrappers::GLProgramObj GLProg(true);
 
     // GL_PROGRAM_SEPARABLE parameter must be set before linking!
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+    // Binary retrievable hint must also be set before linking
+    if (pPSOCache != nullptr)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
@@ -209,6 +320,25 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
     //of the inputs on the interface will be undefined.
     glLinkProgram(GLProg);
     CHECK_GL_ERROR("glLinkProgram() failed");
+
+    Pending.Program = std::move(GLProg);
+    Pending.Shaders.assign(ppShaders, ppShaders + NumShaders);
+    return Pending;
+}
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::FinishLinkProgram(PendingProgram&& Pending)
+{
+    GLObjectWrappers::GLProgramObj GLProg{std::move(Pending.Program)};
+    if (Pending.IsFromCache)
+        return GLProg;
+
+    VERIFY(GLProg, "The program is null. Was it already finished?");
+
+    // Report compilation errors that were not checked when the shaders were created
+    for (const auto* pShader : Pending.Shaders)
+        pShader->VerifyCompileStatus();
+
+    // Querying the link status waits for the link to complete
     int IsLinked = GL_FALSE;
     glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
     CHECK_GL_ERROR("glGetProgramiv() failed");
@@ -228,13 +358,17 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
         LOG_ERROR_MESSAGE("Failed to link shader program:\n", shaderProgramInfoLog.data(), '\n');
         UNEXPECTED("glLinkProgram failed");
     }
+    else if (Pending.pPSOCache != nullptr)
+    {
+        Pending.pPSOCache->StoreProgram(Pending.CacheKey, GLProg);
+    }
 
-    for (Uint32 i = 0; i < NumShaders; ++i)
+    for (const auto* pCurrShader : Pending.Shaders)
     {
-        auto* pCurrShader = ValidatedCast<const ShaderGLImpl>(ppShaders[i]);
         glDetachShader(GLProg, pCurrShader->m_GLShaderObj);
         CHECK_GL_ERROR("glDetachShader() failed");
     }
+    Pending.Shaders.clear();
 
     return GLProg;
 }
@@ -243,7 +377,7 @@ Uint32 ShaderGLImpl::GetResourceCount() const
 {
     if (m_pDevice->GetFeatures().SeparablePrograms)
     {
-        return m_pShaderResources->GetVariableCount();
+        return GetShaderResources()->GetVariableCount();
     }
     else
     {
@@ -257,7 +391,7 @@ void ShaderGLImpl::GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDes
     if (m_pDevice->GetFeatures().SeparablePrograms)
     {
         DEV_CHECK_ERR(Index < GetResourceCount(), "Index is out of range");
-        ResourceDesc = m_pShaderResources->GetResourceDesc(Index);
+        ResourceDesc = GetShaderResources()->GetResourceDesc(Index);
     }
     else
     {
@@ -125,6 +125,10 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
                                           std::vector<TextureBaseGL*>& WritableTextures,
                                           std::vector<BufferGLImpl*>&  WritableBuffers) const
 {
+    // Uniform buffers, textures and samplers are bound to consecutive slots
+    // and can be committed with multi-bind calls
+    GLState.BeginBindingBatch();
+
     for (Uint32 ub = 0, binding = BaseBindings[BINDING_RANGE_UNIFORM_BUFFER]; ub < GetUBCount(); ++ub, ++binding)
     {
         const auto& UB = GetConstUB(ub);
@@ -137,7 +141,7 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
                                            // will reflect data written by shaders prior to the barrier
             GLState);
 
-        GLState.BindUniformBuffer(binding, pBufferGL->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset, UB.RangeSize);
+        GLState.BindUniformBuffer(binding, pBufferGL->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset + pBufferGL->GetPersistentRegionOffset(), UB.RangeSize);
     }
 
     for (Uint32 s = 0, binding = BaseBindings[BINDING_RANGE_TEXTURE]; s < GetTextureCount(); ++s, ++binding)
@@ -186,6 +190,10 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
         }
     }
 
+    // Images are bound individually. Note that in debug mode the image loop binds
+    // textures to query their parameters, which requires immediate bindings.
+    GLState.EndBindingBatch();
+
 #if GL_ARB_shader_image_load_store
     for (Uint32 img = 0, binding = BaseBindings[BINDING_RANGE_IMAGE]; img < GetImageCount(); ++img, ++binding)
     {
@@ -275,11 +283,12 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
 
 
 #if GL_ARB_shader_storage_buffer_object
+    GLState.BeginBindingBatch();
     for (Uint32 ssbo = 0, binding = BaseBindings[BINDING_RANGE_STORAGE_BUFFER]; ssbo < GetSSBOCount(); ++ssbo, ++binding)
     {
         const auto& SSBO = GetConstSSBO(ssbo);
         if (!SSBO.pBufferView)
-            return;
+            continue;
 
         auto* const pBufferViewGL = SSBO.pBufferView.RawPtr<BufferViewGLImpl>();
         const auto& ViewDesc      = pBufferViewGL->GetDesc();
@@ -296,12 +305,15 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
         if (ViewDesc.ViewType == BUFFER_VIEW_UNORDERED_ACCESS)
             WritableBuffers.push_back(pBufferGL);
     }
+    GLState.EndBindingBatch();
 #endif
 }
 
 void ShaderResourceCacheGL::BindDynamicBuffers(GLContextState&              GLState,
                                                const std::array<Uint16, 4>& BaseBindings) const
 {
+    GLState.BeginBindingBatch();
+
     const auto BaseUBOBinding = BaseBindings[BINDING_RANGE_UNIFORM_BUFFER];
     for (Uint64 DynamicUBOMask = m_DynamicUBOMask; DynamicUBOMask != 0;)
     {
@@ -309,7 +321,7 @@ void ShaderResourceCacheGL::BindDynamicBuffers(GLContextState&              GLSt
         const auto  UBOIdx = PlatformMisc::GetLSB(UBOBit);
         const auto& UB     = GetConstUB(UBOIdx);
         VERIFY_EXPR(UB.IsDynamic());
-        GLState.BindUniformBuffer(BaseUBOBinding + UBOIdx, UB.pBuffer->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset, UB.RangeSize);
+        GLState.BindUniformBuffer(BaseUBOBinding + UBOIdx, UB.pBuffer->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset + UB.pBuffer->GetPersistentRegionOffset(), UB.RangeSize);
     }
 
 
@@ -327,6 +339,8 @@ void ShaderResourceCacheGL::BindDynamicBuffers(GLContextState&              GLSt
 
         GLState.BindStorageBlock(BaseSSBOBinding + SSBOIdx, pBufferGL->GetGLHandle(), ViewDesc.ByteOffset + SSBO.DynamicOffset, ViewDesc.ByteWidth);
     }
+
+    GLState.EndBindingBatch();
 }
 
 #ifdef DILIGENT_DEBUG
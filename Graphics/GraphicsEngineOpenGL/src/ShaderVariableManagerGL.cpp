@@ -400,18 +400,21 @@ void ShaderVariableManagerGL::BindResources(IResourceMapping* pResourceMapping,
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Variables look up resources in the engine's resource mapping by precomputed name hashes
+    RefCntAutoPtr<ResourceMappingImpl> pMappingImpl{pResourceMapping, IID_ResourceMappingImpl};
+
     HandleResources(
         [&](UniformBuffBindInfo& ub) {
-            ub.BindResources(pResourceMapping, Flags);
+            ub.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](TextureBindInfo& tex) {
-            tex.BindResources(pResourceMapping, Flags);
+            tex.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](ImageBindInfo& img) {
-            img.BindResources(pResourceMapping, Flags);
+            img.BindResources(pResourceMapping, pMappingImpl, Flags);
         },
         [&](StorageBufferBindInfo& ssbo) {
-            ssbo.BindResources(pResourceMapping, Flags);
+            ssbo.BindResources(pResourceMapping, pMappingImpl, Flags);
         });
 }
 
@@ -573,6 +576,12 @@ const PipelineResourceDesc& ShaderVariableManagerGL::GetResourceDesc(Uint32 Inde
     return m_pSignature->GetResourceDesc(Index);
 }
 
+size_t ShaderVariableManagerGL::GetResourceNameHash(Uint32 Index) const
+{
+    VERIFY_EXPR(m_pSignature);
+    return m_pSignature->GetResourceNameHash(Index);
+}
+
 const ShaderVariableManagerGL::ResourceAttribs& ShaderVariableManagerGL::GetResourceAttribs(Uint32 Index) const
 {
     VERIFY_EXPR(m_pSignature);
@@ -64,7 +64,47 @@ static const Char* VertexShaderSource =
 };
 // clang-format on
 
-TexRegionRender::TexRegionRender(class RenderDeviceGLImpl* pDeviceGL)
+// Image format layout qualifiers supported by both GLSL 4.30 and GLSL ES 3.10
+static const char* GetImageFormatQualifier(TEXTURE_FORMAT Fmt)
+{
+    switch (Fmt)
+    {
+        // clang-format off
+        case TEX_FORMAT_RGBA32_FLOAT: return "rgba32f";
+        case TEX_FORMAT_RGBA16_FLOAT: return "rgba16f";
+        case TEX_FORMAT_R32_FLOAT:    return "r32f";
+        case TEX_FORMAT_RGBA8_UNORM:  return "rgba8";
+        case TEX_FORMAT_RGBA8_SNORM:  return "rgba8_snorm";
+        case TEX_FORMAT_RGBA32_SINT:  return "rgba32i";
+        case TEX_FORMAT_RGBA16_SINT:  return "rgba16i";
+        case TEX_FORMAT_RGBA8_SINT:   return "rgba8i";
+        case TEX_FORMAT_R32_SINT:     return "r32i";
+        case TEX_FORMAT_RGBA32_UINT:  return "rgba32ui";
+        case TEX_FORMAT_RGBA16_UINT:  return "rgba16ui";
+        case TEX_FORMAT_RGBA8_UINT:   return "rgba8ui";
+        case TEX_FORMAT_R32_UINT:     return "r32ui";
+        default: return nullptr;
+            // clang-format on
+    }
+}
+
+// Returns 0 for float/normalized formats, 1 for signed integer and 2 for unsigned integer formats
+static Uint32 GetComponentTypeClass(TEXTURE_FORMAT Fmt)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_SINT)
+        return 1;
+    else if (FmtAttribs.ComponentType == COMPONENT_TYPE_UINT)
+        return 2;
+    else
+        return 0;
+}
+
+static constexpr Uint32 ComputeCopyGroupSize = 8;
+
+TexRegionRender::TexRegionRender(class RenderDeviceGLImpl* pDeviceGL) :
+    m_pDeviceGL{pDeviceGL},
+    m_ComputeCopySupported{pDeviceGL->GetDeviceInfo().Features.ComputeShaders != DEVICE_FEATURE_STATE_DISABLED}
 {
     ShaderCreateInfo ShaderAttrs;
     ShaderAttrs.Desc.Name                 = "TexRegionRender : Vertex shader";
@@ -167,32 +207,63 @@ TexRegionRender::TexRegionRender(class RenderDeviceGLImpl* pDeviceGL)
     m_pPSO[RESOURCE_DIM_TEX_2D * 3]->CreateShaderResourceBinding(&m_pSRB);
     m_pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "cbConstants")->Set(m_pConstantBuffer);
     m_pSrcTexVar = m_pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "gSourceTex");
+
+    if (m_ComputeCopySupported)
+    {
+        CBDesc.Name          = "TexRegionRender: CS constants CB";
+        CBDesc.uiSizeInBytes = sizeof(Int32) * 8;
+        pDeviceGL->CreateBuffer(CBDesc, nullptr, &m_pComputeConstantBuffer, IsInternalDeviceObject);
+    }
 }
 
-void TexRegionRender::SetStates(DeviceContextGLImpl* pCtxGL)
+void TexRegionRender::SetStates(DeviceContextGLImpl* pCtxGL, bool SaveRenderTargets)
 {
-    pCtxGL->GetRenderTargets(m_NumRenderTargets, m_pOrigRTVs, &m_pOrigDSV);
+    if (m_StateSaveDepth++ == 0)
+    {
+        pCtxGL->GetPipelineState(&m_pOrigPSO, m_OrigBlendFactors, m_OrigStencilRef);
+    }
+
+    // Render targets are not modified by compute copies, so they can be saved lazily
+    if (SaveRenderTargets && !m_RenderTargetsSaved)
+    {
+        pCtxGL->GetRenderTargets(m_NumRenderTargets, m_pOrigRTVs, &m_pOrigDSV);
 
-    Uint32 NumViewports = 0;
-    pCtxGL->GetViewports(NumViewports, nullptr);
-    m_OrigViewports.resize(NumViewports);
-    pCtxGL->GetViewports(NumViewports, m_OrigViewports.data());
+        Uint32 NumViewports = 0;
+        pCtxGL->GetViewports(NumViewports, nullptr);
+        m_OrigViewports.resize(NumViewports);
+        pCtxGL->GetViewports(NumViewports, m_OrigViewports.data());
 
-    pCtxGL->GetPipelineState(&m_pOrigPSO, m_OrigBlendFactors, m_OrigStencilRef);
+        m_RenderTargetsSaved = true;
+    }
 }
 
 void TexRegionRender::RestoreStates(DeviceContextGLImpl* pCtxGL)
 {
-    pCtxGL->SetRenderTargets(m_NumRenderTargets, m_pOrigRTVs, m_pOrigDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    for (Uint32 rt = 0; rt < _countof(m_pOrigRTVs); ++rt)
+    VERIFY(m_StateSaveDepth > 0, "Unbalanced RestoreStates() call");
+    if (--m_StateSaveDepth > 0)
     {
-        if (m_pOrigRTVs[rt])
-            m_pOrigRTVs[rt]->Release();
-        m_pOrigRTVs[rt] = nullptr;
+        // Render target views used by the copy are temporary objects and must not stay
+        // bound to the context until the outermost call restores the original targets.
+        if (m_RenderTargetsSaved)
+            pCtxGL->ResetRenderTargets();
+        return;
     }
-    m_pOrigDSV.Release();
 
-    pCtxGL->SetViewports((Uint32)m_OrigViewports.size(), m_OrigViewports.data(), 0, 0);
+    if (m_RenderTargetsSaved)
+    {
+        pCtxGL->SetRenderTargets(m_NumRenderTargets, m_pOrigRTVs, m_pOrigDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        for (Uint32 rt = 0; rt < _countof(m_pOrigRTVs); ++rt)
+        {
+            if (m_pOrigRTVs[rt])
+                m_pOrigRTVs[rt]->Release();
+            m_pOrigRTVs[rt] = nullptr;
+        }
+        m_pOrigDSV.Release();
+
+        pCtxGL->SetViewports((Uint32)m_OrigViewports.size(), m_OrigViewports.data(), 0, 0);
+
+        m_RenderTargetsSaved = false;
+    }
 
     if (m_pOrigPSO)
         pCtxGL->SetPipelineState(m_pOrigPSO);
@@ -244,4 +315,175 @@ void TexRegionRender::Render(DeviceContextGLImpl* pCtxGL,
     m_pSrcTexVar->Set(nullptr);
 }
 
+bool TexRegionRender::IsComputeCopySupported(RESOURCE_DIMENSION SrcTexType,
+                                             TEXTURE_FORMAT     SrcFormat,
+                                             RESOURCE_DIMENSION DstTexType,
+                                             TEXTURE_FORMAT     DstFormat) const
+{
+    if (!m_ComputeCopySupported)
+        return false;
+
+    if (SrcTexType != RESOURCE_DIM_TEX_2D && SrcTexType != RESOURCE_DIM_TEX_2D_ARRAY && SrcTexType != RESOURCE_DIM_TEX_3D)
+        return false;
+
+    // Destination slices are bound as 2D images, which is not possible for 3D textures
+    if (DstTexType != RESOURCE_DIM_TEX_2D && DstTexType != RESOURCE_DIM_TEX_2D_ARRAY)
+        return false;
+
+    if (GetImageFormatQualifier(DstFormat) == nullptr)
+        return false;
+
+    // texelFetch() result must be convertible to the imageStore() argument
+    return GetComponentTypeClass(SrcFormat) == GetComponentTypeClass(DstFormat);
+}
+
+TexRegionRender::ComputeCopyPSO& TexRegionRender::GetComputeCopyPSO(RESOURCE_DIMENSION SrcTexType, TEXTURE_FORMAT DstFormat)
+{
+    const Uint32 Key = (static_cast<Uint32>(SrcTexType) << 16u) | static_cast<Uint32>(DstFormat);
+
+    auto It = m_ComputeCopyPSOs.find(Key);
+    if (It != m_ComputeCopyPSOs.end())
+        return It->second;
+
+    auto& CopyPSO = m_ComputeCopyPSOs[Key];
+
+    static const char* CmpTypePrefix[3] = {"", "i", "u"};
+
+    const auto* Prefix          = CmpTypePrefix[GetComponentTypeClass(DstFormat)];
+    const auto* FormatQualifier = GetImageFormatQualifier(DstFormat);
+    VERIFY_EXPR(FormatQualifier != nullptr);
+
+    const char* SamplerDim  = nullptr;
+    const char* SrcLocation = nullptr;
+    switch (SrcTexType)
+    {
+        // clang-format off
+        case RESOURCE_DIM_TEX_2D:       SamplerDim = "sampler2D";      SrcLocation = "SrcXY";                       break;
+        case RESOURCE_DIM_TEX_2D_ARRAY: SamplerDim = "sampler2DArray"; SrcLocation = "ivec3(SrcXY, SrcConstants.z)"; break;
+        case RESOURCE_DIM_TEX_3D:       SamplerDim = "sampler3D";      SrcLocation = "ivec3(SrcXY, SrcConstants.z)"; break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected source texture type");
+            return CopyPSO;
+    }
+
+    std::stringstream SourceSS;
+    SourceSS << "layout(local_size_x = " << ComputeCopyGroupSize << ", local_size_y = " << ComputeCopyGroupSize << ", local_size_z = 1) in;\n"
+             << "uniform " << Prefix << SamplerDim << " gSourceTex;\n"
+             << "layout(" << FormatQualifier << ") uniform writeonly " << Prefix << "image2D gDstImage;\n"
+             << "uniform cbConstants\n"
+                "{\n"
+                "    ivec4 SrcConstants; // Src X, Src Y, Src Z, Src mip\n"
+                "    ivec4 DstConstants; // Dst X, Dst Y, Width, Height\n"
+                "};\n"
+                "void main()\n"
+                "{\n"
+                "    ivec2 Pos = ivec2(gl_GlobalInvocationID.xy);\n"
+                "    if (Pos.x >= DstConstants.z || Pos.y >= DstConstants.w)\n"
+                "        return;\n"
+                "    ivec2 SrcXY = Pos + SrcConstants.xy;\n"
+                "    imageStore(gDstImage, Pos + DstConstants.xy, texelFetch(gSourceTex, "
+             << SrcLocation
+             << ", SrcConstants.w));\n"
+                "}\n";
+
+    String Name = "TexRegionRender : Compute shader ";
+    Name.append(Prefix);
+    Name.append(SamplerDim);
+    Name.append(" -> ");
+    Name.append(FormatQualifier);
+
+    auto Source = SourceSS.str();
+
+    ShaderCreateInfo ShaderAttrs;
+    ShaderAttrs.Desc.Name       = Name.c_str();
+    ShaderAttrs.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderAttrs.Source          = Source.c_str();
+
+    constexpr bool         IsInternalDeviceObject = true;
+    RefCntAutoPtr<IShader> pCS;
+    m_pDeviceGL->CreateShader(ShaderAttrs, &pCS, IsInternalDeviceObject);
+    if (!pCS)
+    {
+        LOG_ERROR_MESSAGE("Failed to create texture copy compute shader '", Name, "'");
+        return CopyPSO;
+    }
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = ShaderAttrs.Desc.Name;
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    auto& ResourceLayout = PSOCreateInfo.PSODesc.ResourceLayout;
+
+    ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE} //
+        };
+    ResourceLayout.NumVariables = _countof(Vars);
+    ResourceLayout.Variables    = Vars;
+
+    m_pDeviceGL->CreateComputePipelineState(PSOCreateInfo, &CopyPSO.pPSO, IsInternalDeviceObject);
+    if (!CopyPSO.pPSO)
+    {
+        LOG_ERROR_MESSAGE("Failed to create texture copy compute pipeline '", Name, "'");
+        return CopyPSO;
+    }
+
+    CopyPSO.pPSO->CreateShaderResourceBinding(&CopyPSO.pSRB);
+    CopyPSO.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pComputeConstantBuffer);
+    CopyPSO.pSrcTexVar = CopyPSO.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gSourceTex");
+    CopyPSO.pDstImgVar = CopyPSO.pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "gDstImage");
+
+    return CopyPSO;
+}
+
+void TexRegionRender::Dispatch(DeviceContextGLImpl* pCtxGL,
+                               ITextureView*        pSrcSRV,
+                               ITextureView*        pDstUAV,
+                               RESOURCE_DIMENSION   SrcTexType,
+                               TEXTURE_FORMAT       DstFormat,
+                               Int32                SrcX,
+                               Int32                SrcY,
+                               Int32                SrcZ,
+                               Int32                SrcMipLevel,
+                               Int32                DstX,
+                               Int32                DstY,
+                               Uint32               Width,
+                               Uint32               Height)
+{
+    auto& CopyPSO = GetComputeCopyPSO(SrcTexType, DstFormat);
+    if (!CopyPSO.pPSO || CopyPSO.pSrcTexVar == nullptr || CopyPSO.pDstImgVar == nullptr)
+    {
+        UNEXPECTED("Texture copy compute pipeline is not initialized");
+        return;
+    }
+
+    {
+        MapHelper<int> pConstant(pCtxGL, m_pComputeConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        pConstant[0] = SrcX;
+        pConstant[1] = SrcY;
+        pConstant[2] = SrcZ;
+        pConstant[3] = SrcMipLevel;
+        pConstant[4] = DstX;
+        pConstant[5] = DstY;
+        pConstant[6] = static_cast<int>(Width);
+        pConstant[7] = static_cast<int>(Height);
+    }
+
+    pCtxGL->SetPipelineState(CopyPSO.pPSO);
+    CopyPSO.pSrcTexVar->Set(pSrcSRV);
+    CopyPSO.pDstImgVar->Set(pDstUAV);
+    pCtxGL->CommitShaderResources(CopyPSO.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttrs;
+    DispatchAttrs.ThreadGroupCountX = (Width + ComputeCopyGroupSize - 1) / ComputeCopyGroupSize;
+    DispatchAttrs.ThreadGroupCountY = (Height + ComputeCopyGroupSize - 1) / ComputeCopyGroupSize;
+    pCtxGL->DispatchCompute(DispatchAttrs);
+
+    CopyPSO.pSrcTexVar->Set(nullptr);
+    CopyPSO.pDstImgVar->Set(nullptr);
+}
+
 } // namespace Diligent
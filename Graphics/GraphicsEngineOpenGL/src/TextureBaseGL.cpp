@@ -578,13 +578,6 @@ void TextureBaseGL::CopyData(DeviceContextGLImpl* pDeviceCtxGL,
     else
 #endif
     {
-        const auto& FmtAttribs = GetDevice()->GetTextureFormatInfoExt(m_Desc.Format);
-        if ((FmtAttribs.BindFlags & BIND_RENDER_TARGET) == 0)
-        {
-            LOG_ERROR_MESSAGE("Unable to perform copy operation because ", FmtAttribs.Name, " is not a color renderable format");
-            return;
-        }
-
         auto* pRenderDeviceGL = GetDevice();
 #ifdef DILIGENT_DEBUG
         {
@@ -593,7 +586,26 @@ void TextureBaseGL::CopyData(DeviceContextGLImpl* pDeviceCtxGL,
         }
 #endif
         auto& TexRegionRender = *pRenderDeviceGL->m_pTexRegionRender;
-        TexRegionRender.SetStates(pDeviceCtxGL);
+
+        // The compute path does not touch render targets and viewports, and only
+        // requires the pipeline state to be restored. Default framebuffer can't be
+        // bound as an image.
+        const bool IsDefaultBackBuffer = GetGLHandle() == 0;
+        const bool UseCompute =
+            !IsDefaultBackBuffer &&
+            TexRegionRender.IsComputeCopySupported(SrcTexDesc.Type, SrcTexDesc.Format, m_Desc.Type, m_Desc.Format);
+
+        if (!UseCompute)
+        {
+            const auto& FmtAttribs = pRenderDeviceGL->GetTextureFormatInfoExt(m_Desc.Format);
+            if ((FmtAttribs.BindFlags & BIND_RENDER_TARGET) == 0)
+            {
+                LOG_ERROR_MESSAGE("Unable to perform copy operation because ", FmtAttribs.Name, " is not a color renderable format");
+                return;
+            }
+        }
+
+        TexRegionRender.SetStates(pDeviceCtxGL, !UseCompute);
 
         // Create temporary SRV for the entire source texture
         TextureViewDesc SRVDesc;
@@ -609,6 +621,44 @@ void TextureBaseGL::CopyData(DeviceContextGLImpl* pDeviceCtxGL,
                                      // keep strong reference to the texture
         );
 
+        if (UseCompute)
+        {
+            for (Uint32 DepthSlice = 0; DepthSlice < pSrcBox->MaxZ - pSrcBox->MinZ; ++DepthSlice)
+            {
+                // Create temporary UAV for the target slice. 2D array slices are bound as 2D images.
+                TextureViewDesc UAVDesc;
+                UAVDesc.TextureDim      = RESOURCE_DIM_TEX_2D;
+                UAVDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+                UAVDesc.FirstArraySlice = DepthSlice + DstSlice;
+                UAVDesc.NumArraySlices  = 1;
+                UAVDesc.MostDetailedMip = DstMipLevel;
+                UAVDesc.AccessFlags     = UAV_ACCESS_FLAG_WRITE;
+                ValidatedAndCorrectTextureViewDesc(m_Desc, UAVDesc);
+                TextureViewGLImpl UAV(GetReferenceCounters(), GetDevice(), UAVDesc, this,
+                                      false, // Do NOT create texture view OpenGL object
+                                      true   // The view, like default view, should not
+                                             // keep strong reference to the texture
+                );
+
+                TexRegionRender.Dispatch(pDeviceCtxGL,
+                                         &SRV,
+                                         &UAV,
+                                         SrcTexDesc.Type,
+                                         m_Desc.Format,
+                                         static_cast<Int32>(pSrcBox->MinX),
+                                         static_cast<Int32>(pSrcBox->MinY),
+                                         SrcSlice + pSrcBox->MinZ + DepthSlice,
+                                         SrcMipLevel,
+                                         static_cast<Int32>(DstX),
+                                         static_cast<Int32>(DstY),
+                                         pSrcBox->MaxX - pSrcBox->MinX,
+                                         pSrcBox->MaxY - pSrcBox->MinY);
+            }
+
+            TexRegionRender.RestoreStates(pDeviceCtxGL);
+            return;
+        }
+
         for (Uint32 DepthSlice = 0; DepthSlice < pSrcBox->MaxZ - pSrcBox->MinZ; ++DepthSlice)
         {
             // Create temporary RTV for the target subresource
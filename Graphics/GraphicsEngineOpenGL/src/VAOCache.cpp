@@ -44,12 +44,10 @@
 namespace Diligent
 {
 
-VAOCache::VAOCache() :
+VAOCache::VAOCache(bool UseVertexAttribBinding) :
+    m_UseVertexAttribBinding{UseVertexAttribBinding},
     m_EmptyVAO{true}
 {
-    m_Cache.max_load_factor(0.5f);
-    m_PSOToKey.max_load_factor(0.5f);
-    m_BuffToKey.max_load_factor(0.5f);
 }
 
 VAOCache::~VAOCache()
@@ -66,13 +64,14 @@ void VAOCache::OnDestroyBuffer(const BufferGLImpl& Buffer)
 
     ThreadingTools::LockHelper CacheLock{m_CacheLockFlag};
 
-    const auto range = m_BuffToKey.equal_range(Buffer.GetUniqueID());
-    for (auto it = range.first; it != range.second; ++it)
+    auto it = m_BuffToKey.find(Buffer.GetUniqueID());
+    if (it != m_BuffToKey.end())
     {
-        StaleKeys.push_back(it->second);
-        m_Cache.erase(it->second);
+        StaleKeys = std::move(it->second);
+        for (const auto& Key : StaleKeys)
+            m_Cache.erase(Key);
+        m_BuffToKey.erase(it);
     }
-    m_BuffToKey.erase(range.first, range.second);
 
     // Clear stale entries in m_PSOToKey and m_BuffToKey that refer to dead VAOs
     // to avoid memory leaks.
@@ -86,13 +85,16 @@ void VAOCache::OnDestroyPSO(const PipelineStateGLImpl& PSO)
 
     ThreadingTools::LockHelper CacheLock{m_CacheLockFlag};
 
-    const auto range = m_PSOToKey.equal_range(PSO.GetUniqueID());
-    for (auto it = range.first; it != range.second; ++it)
+    m_PSOToLayoutVAO.erase(PSO.GetUniqueID());
+
+    auto it = m_PSOToKey.find(PSO.GetUniqueID());
+    if (it != m_PSOToKey.end())
     {
-        StaleKeys.push_back(it->second);
-        m_Cache.erase(it->second);
+        StaleKeys = std::move(it->second);
+        for (const auto& Key : StaleKeys)
+            m_Cache.erase(Key);
+        m_PSOToKey.erase(it);
     }
-    m_PSOToKey.erase(range.first, range.second);
 
     // Clear stale entries in m_PSOToKey and m_BuffToKey that refer to dead VAOs
     // to avoid memory leaks.
@@ -120,20 +122,29 @@ void VAOCache::ClearStaleKeys(const std::vector<VAOHashKey>& StaleKeys)
         }
     }
 
-    auto RemoveStaleEntries = [this](const std::unordered_set<UniqueIdentifier>&            CandidateIds,
-                                     std::unordered_multimap<UniqueIdentifier, VAOHashKey>& IdToKey) //
+    auto RemoveStaleEntries = [this](const std::unordered_set<UniqueIdentifier>& CandidateIds,
+                                     IdToKeysMapType&                            IdToKeys) //
     {
         // Delete stale entries that reference dead keys
         for (const auto Id : CandidateIds)
         {
-            const auto range = IdToKey.equal_range(Id);
-            for (auto it = range.first; it != range.second;)
+            auto it = IdToKeys.find(Id);
+            if (it == IdToKeys.end())
+                continue;
+
+            // VAOHashKey is not assignable, so live keys are copied into a new vector
+            std::vector<VAOHashKey> LiveKeys;
+            for (const auto& Key : it->second)
             {
-                if (m_Cache.find(it->second) == m_Cache.end())
-                    it = IdToKey.erase(it); // There is no more VAO with this key
-                else
-                    ++it;
+                // Skip keys for which there is no more VAO
+                if (m_Cache.find(Key) != m_Cache.end())
+                    LiveKeys.push_back(Key);
             }
+
+            if (LiveKeys.empty())
+                IdToKeys.erase(it);
+            else
+                it->second.swap(LiveKeys);
         }
     };
     RemoveStaleEntries(CandidatePSOs, m_PSOToKey);
@@ -171,7 +182,7 @@ VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
         {
             auto& DstStream     = Streams[BufferSlot];
             DstStream.BufferUId = BuffId;
-            DstStream.Offset    = SrcStream.Offset;
+            DstStream.Offset    = SrcStream.Offset + (SrcStream.pBuffer ? SrcStream.pBuffer->GetPersistentRegionOffset() : 0);
             UsedSlotsMask |= SlotBit;
             HashCombine(Hash, DstStream.BufferUId, DstStream.Offset);
         }
@@ -180,7 +191,7 @@ VAOCache::VAOHashKey::VAOHashKey(const VAOAttribs& Attribs) :
             const auto& DstStream = Streams[BufferSlot];
             // The slot has already been initialized
             VERIFY_EXPR(DstStream.BufferUId == BuffId);
-            VERIFY_EXPR(DstStream.Offset == SrcStream.Offset);
+            VERIFY_EXPR(DstStream.Offset == SrcStream.Offset + (SrcStream.pBuffer ? SrcStream.pBuffer->GetPersistentRegionOffset() : 0));
         }
     }
     HashCombine(Hash, UsedSlotsMask);
@@ -210,6 +221,148 @@ bool VAOCache::VAOHashKey::operator==(const VAOHashKey& Key) const
     return true;
 }
 
+VAOCache::LayoutKey::LayoutKey(const InputLayoutDesc& InputLayout)
+{
+    Elements.reserve(InputLayout.NumElements);
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& LayoutElem = InputLayout.LayoutElements[i];
+
+        Element Elem;
+        Elem.InputIndex           = LayoutElem.InputIndex;
+        Elem.BufferSlot           = LayoutElem.BufferSlot;
+        Elem.NumComponents        = LayoutElem.NumComponents;
+        Elem.ValueType            = LayoutElem.ValueType;
+        Elem.IsNormalized         = LayoutElem.IsNormalized;
+        Elem.RelativeOffset       = LayoutElem.RelativeOffset;
+        Elem.InstanceDataStepRate = LayoutElem.Frequency == INPUT_ELEMENT_FREQUENCY_PER_INSTANCE ? LayoutElem.InstanceDataStepRate : 0;
+        Elements.push_back(Elem);
+
+        HashCombine(Hash, Elem.InputIndex, Elem.BufferSlot, Elem.NumComponents, static_cast<Uint32>(Elem.ValueType),
+                    Elem.IsNormalized, Elem.RelativeOffset, Elem.InstanceDataStepRate);
+    }
+}
+
+const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetLayoutVAO(const VAOAttribs& Attribs,
+                                                                 GLContextState&   GLState)
+{
+#if GL_ARB_vertex_attrib_binding
+    // The cache must be locked by the caller
+
+    LayoutVAO* pLayoutVAO = nullptr;
+
+    const auto PsoUId = Attribs.PSO.GetUniqueID();
+
+    auto PSOIt = m_PSOToLayoutVAO.find(PsoUId);
+    if (PSOIt != m_PSOToLayoutVAO.end())
+    {
+        pLayoutVAO = PSOIt->second;
+        GLState.BindVAO(pLayoutVAO->VAO);
+    }
+    else
+    {
+        const auto& InputLayout = Attribs.PSO.GetGraphicsPipelineDesc().InputLayout;
+
+        LayoutKey Key{InputLayout};
+
+        auto LayoutIt = m_LayoutCache.find(Key);
+        if (LayoutIt == m_LayoutCache.end())
+        {
+            LayoutIt = m_LayoutCache.emplace(std::move(Key), LayoutVAO{}).first;
+
+            // Set up the vertex format. Buffers are bound to the binding points separately.
+            GLState.BindVAO(LayoutIt->second.VAO);
+            for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+            {
+                const auto& LayoutElem = InputLayout.LayoutElements[i];
+                VERIFY_EXPR(LayoutElem.BufferSlot < MAX_BUFFER_SLOTS);
+
+                const auto GlType = TypeToGLType(LayoutElem.ValueType);
+                if (!LayoutElem.IsNormalized &&
+                    (LayoutElem.ValueType == VT_INT8 ||
+                     LayoutElem.ValueType == VT_INT16 ||
+                     LayoutElem.ValueType == VT_INT32 ||
+                     LayoutElem.ValueType == VT_UINT8 ||
+                     LayoutElem.ValueType == VT_UINT16 ||
+                     LayoutElem.ValueType == VT_UINT32))
+                    glVertexAttribIFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.RelativeOffset);
+                else
+                    glVertexAttribFormat(LayoutElem.InputIndex, LayoutElem.NumComponents, GlType, LayoutElem.IsNormalized, LayoutElem.RelativeOffset);
+
+                glVertexAttribBinding(LayoutElem.InputIndex, LayoutElem.BufferSlot);
+                if (LayoutElem.Frequency == INPUT_ELEMENT_FREQUENCY_PER_INSTANCE)
+                    glVertexBindingDivisor(LayoutElem.BufferSlot, LayoutElem.InstanceDataStepRate);
+                glEnableVertexAttribArray(LayoutElem.InputIndex);
+            }
+            DEV_CHECK_GL_ERROR("Failed to initialize vertex format");
+        }
+        else
+        {
+            GLState.BindVAO(LayoutIt->second.VAO);
+        }
+
+        pLayoutVAO = &LayoutIt->second;
+        // Pointers to unordered_map elements remain valid after rehashing
+        m_PSOToLayoutVAO.emplace(PsoUId, pLayoutVAO);
+    }
+
+    // Update the buffer bindings of the VAO that differ from the requested ones
+    const auto& InputLayout = Attribs.PSO.GetGraphicsPipelineDesc().InputLayout;
+    Uint32      BoundSlots  = 0;
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto BuffSlot = InputLayout.LayoutElements[i].BufferSlot;
+        const auto SlotBit  = 1u << BuffSlot;
+        if ((BoundSlots & SlotBit) != 0)
+            continue;
+        BoundSlots |= SlotBit;
+
+        DEV_CHECK_ERR(BuffSlot < Attribs.NumVertexStreams, "Input layout requires at least ", BuffSlot + 1, " buffer(s), but only ", Attribs.NumVertexStreams, " are bound.");
+        const auto&   CurrStream = Attribs.VertexStreams[BuffSlot];
+        BufferGLImpl* pBuffer    = Attribs.VertexStreams[BuffSlot].pBuffer;
+        DEV_CHECK_ERR(pBuffer, "VAO requires buffer at slot ", BuffSlot, ", but none is bound in the context.");
+        if (pBuffer == nullptr)
+            continue;
+
+        const auto BuffUId = pBuffer->GetUniqueID();
+        const auto Offset  = CurrStream.Offset + pBuffer->GetPersistentRegionOffset();
+        const auto Stride  = Attribs.PSO.GetBufferStride(BuffSlot);
+
+        auto& BoundStream = pLayoutVAO->Streams[BuffSlot];
+        if (BoundStream.BufferUId != BuffUId || BoundStream.Offset != Offset || BoundStream.Stride != Stride)
+        {
+            glBindVertexBuffer(BuffSlot, pBuffer->m_GlBuffer, static_cast<GLintptr>(Offset), static_cast<GLsizei>(Stride));
+            DEV_CHECK_GL_ERROR("Failed to bind vertex buffer to slot ", BuffSlot);
+            BoundStream.BufferUId = BuffUId;
+            BoundStream.Offset    = Offset;
+            BoundStream.Stride    = Stride;
+        }
+    }
+
+    if (Attribs.pIndexBuffer)
+    {
+        const auto IndexBuffUId = Attribs.pIndexBuffer->GetUniqueID();
+        if (pLayoutVAO->IndexBufferUId != IndexBuffUId)
+        {
+            constexpr bool ResetVAO = false;
+            GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->m_GlBuffer, ResetVAO);
+            pLayoutVAO->IndexBufferUId = IndexBuffUId;
+        }
+    }
+
+    return pLayoutVAO->VAO;
+#else
+    UNEXPECTED("Vertex attrib binding is not supported");
+    return m_EmptyVAO;
+#endif
+}
+
+Uint32 VAOCache::GetNumVAOs()
+{
+    ThreadingTools::LockHelper CacheLock{m_CacheLockFlag};
+    return static_cast<Uint32>(m_Cache.size() + m_LayoutCache.size());
+}
+
 const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Attribs,
                                                            GLContextState&   GLState)
 {
@@ -246,6 +399,9 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             GLState);
     }
 
+    if (m_UseVertexAttribBinding)
+        return GetLayoutVAO(Attribs, GLState);
+
     // Try to find VAO in the map
     auto It = m_Cache.find(Key);
     if (It != m_Cache.end())
@@ -276,7 +432,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
 
             constexpr bool ResetVAO = false;
             GLState.BindBuffer(GL_ARRAY_BUFFER, pBuffer->m_GlBuffer, ResetVAO);
-            GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>(static_cast<size_t>(CurrStream.Offset) + static_cast<size_t>(LayoutElem.RelativeOffset));
+            GLvoid* DataStartOffset = reinterpret_cast<GLvoid*>(static_cast<size_t>(CurrStream.Offset + pBuffer->GetPersistentRegionOffset()) + static_cast<size_t>(LayoutElem.RelativeOffset));
 
             const auto GlType = TypeToGLType(LayoutElem.ValueType);
             if (!LayoutElem.IsNormalized &&
@@ -305,16 +461,16 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             GLState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, Attribs.pIndexBuffer->m_GlBuffer, ResetVAO);
         }
 
-        auto NewElems = m_Cache.emplace(std::make_pair(Key, std::move(NewVAO)));
+        auto NewElems = m_Cache.emplace(Key, std::move(NewVAO));
         // New element must be actually inserted
         VERIFY(NewElems.second, "New element was not inserted into the cache");
         VERIFY_EXPR(Key.PsoUId == Attribs.PSO.GetUniqueID());
-        m_PSOToKey.emplace(Key.PsoUId, Key);
+        m_PSOToKey[Key.PsoUId].push_back(Key);
 
         if (Attribs.pIndexBuffer)
         {
             VERIFY_EXPR(Key.IndexBufferUId == Attribs.pIndexBuffer->GetUniqueID());
-            m_BuffToKey.emplace(Key.IndexBufferUId, Key);
+            m_BuffToKey[Key.IndexBufferUId].push_back(Key);
         }
 
         for (auto SlotMask = Key.UsedSlotsMask; SlotMask != 0;)
@@ -330,7 +486,7 @@ const GLObjectWrappers::GLVertexArrayObj& VAOCache::GetVAO(const VAOAttribs& Att
             }
 #endif
 
-            m_BuffToKey.emplace(Key.Streams[Slot].BufferUId, Key);
+            m_BuffToKey[Key.Streams[Slot].BufferUId].push_back(Key);
         }
         return NewElems.first->second;
     }
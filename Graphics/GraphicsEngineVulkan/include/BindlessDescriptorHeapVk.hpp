@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::BindlessDescriptorHeapVk class
+
+#include <array>
+#include <memory>
+
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "BindlessIndexAllocator.hpp"
+#include "PipelineResourceAttribsVk.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Global descriptor set that holds descriptors of all texture and buffer views
+/// registered in the bindless heap.
+
+/// The set is allocated once from an update-after-bind pool and every view writes its
+/// descriptor at a persistent index when it is created. Pipelines that use resources with
+/// PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP flag append the set layout to their pipeline layout,
+/// and the device context binds the set once per pipeline.
+class BindlessDescriptorHeapVk
+{
+public:
+    // Binding index of each descriptor array in the set
+    enum BINDING : Uint32
+    {
+        BINDING_SAMPLED_IMAGE = 0,
+        BINDING_STORAGE_IMAGE,
+        BINDING_UNIFORM_TEXEL_BUFFER,
+        BINDING_STORAGE_TEXEL_BUFFER,
+        BINDING_STORAGE_BUFFER,
+        BINDING_COUNT,
+        BINDING_UNKNOWN = ~0u
+    };
+
+    BindlessDescriptorHeapVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 HeapSize);
+
+    // clang-format off
+    BindlessDescriptorHeapVk             (const BindlessDescriptorHeapVk&) = delete;
+    BindlessDescriptorHeapVk             (BindlessDescriptorHeapVk&&)      = delete;
+    BindlessDescriptorHeapVk& operator = (const BindlessDescriptorHeapVk&) = delete;
+    BindlessDescriptorHeapVk& operator = (BindlessDescriptorHeapVk&&)      = delete;
+    // clang-format on
+
+    ~BindlessDescriptorHeapVk();
+
+    // Returns the binding that holds descriptors of the given type in the bindless set,
+    // or BINDING_UNKNOWN if the descriptor type can't be placed in the heap.
+    static BINDING GetBinding(DescriptorType Type);
+
+    Uint32 AllocateIndex(BINDING Binding);
+
+    // Defers the index release until the GPU is done with all command buffers
+    // submitted to the queues in CmdQueueMask.
+    void ReleaseIndex(BINDING Binding, Uint32 Index, Uint64 CmdQueueMask);
+
+    void WriteImage(BINDING Binding, Uint32 Index, VkImageView vkImageView, VkImageLayout vkLayout) const;
+    void WriteTexelBuffer(BINDING Binding, Uint32 Index, VkBufferView vkBufferView) const;
+    void WriteBuffer(Uint32 Index, VkBuffer vkBuffer, VkDeviceSize Offset, VkDeviceSize Range) const;
+
+    VkDescriptorSetLayout GetVkDescriptorSetLayout() const { return m_vkSetLayout; }
+    VkDescriptorSet       GetVkDescriptorSet() const { return m_vkDescriptorSet; }
+
+private:
+    void WriteDescriptor(VkWriteDescriptorSet& WriteDescrSet, BINDING Binding, Uint32 Index) const;
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    VulkanUtilities::DescriptorSetLayoutWrapper m_vkSetLayout;
+    VulkanUtilities::DescriptorPoolWrapper      m_vkPool;
+    VkDescriptorSet                             m_vkDescriptorSet = VK_NULL_HANDLE;
+
+    std::array<std::unique_ptr<BindlessIndexAllocator>, BINDING_COUNT> m_IndexAllocators;
+};
+
+} // namespace Diligent
@@ -33,6 +33,7 @@
 #include "EngineVkImplTraits.hpp"
 #include "BufferViewBase.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "BindlessDescriptorHeapVk.hpp"
 
 namespace Diligent
 {
@@ -58,6 +59,9 @@ public:
 
 protected:
     VulkanUtilities::BufferViewWrapper m_BuffView;
+
+    // Binding of the view descriptor in the bindless heap
+    BindlessDescriptorHeapVk::BINDING m_BindlessBinding = BindlessDescriptorHeapVk::BINDING_UNKNOWN;
 };
 
 } // namespace Diligent
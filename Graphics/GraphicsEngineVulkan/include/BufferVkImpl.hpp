@@ -52,7 +52,9 @@ public:
                  FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                  RenderDeviceVkImpl*        pDeviceVk,
                  const BufferDesc&          BuffDesc,
-                 const BufferData*          pBuffData = nullptr);
+                 const BufferData*          pBuffData  = nullptr,
+                 class ResourceHeapVkImpl*  pHeap      = nullptr,
+                 Uint64                     HeapOffset = 0);
 
     BufferVkImpl(IReferenceCounters*        pRefCounters,
                  FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
@@ -86,6 +88,10 @@ public:
         }
     }
 
+    // Returns the device address that is written to descriptor buffers (see EngineVkCreateInfo::DescriptorBufferSize).
+    // Dynamic buffers without a backing VkBuffer are addressed through the dynamic memory manager.
+    VkDeviceAddress GetDescriptorAddress(DeviceContextIndex CtxId, DeviceContextVkImpl* pCtx) const;
+
     /// Implementation of IBufferVk::GetVkBuffer().
     virtual VkBuffer DILIGENT_CALL_TYPE GetVkBuffer() const override final;
 
@@ -124,8 +130,19 @@ public:
         return reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory()) + m_BufferMemoryAlignedOffset;
     }
 
+    // Returns true if the buffer memory may be relocated by memory defragmentation,
+    // see RenderDeviceVkImpl::DefragmentMemory().
+    bool IsRelocatable() const;
+
+    // Initializes the buffer create info for the given buffer description.
+    // QueueFamilyIndices provides the storage for the pQueueFamilyIndices member of the returned structure.
+    static VkBufferCreateInfo GetBufferCreateInfo(const RenderDeviceVkImpl* pDevice,
+                                                  const BufferDesc&         Desc,
+                                                  std::vector<uint32_t>&    QueueFamilyIndices);
+
 private:
     friend class DeviceContextVkImpl;
+    friend class RenderDeviceVkImpl;
 
     virtual void CreateViewInternal(const struct BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override;
 
@@ -154,6 +171,18 @@ private:
 
     VulkanUtilities::BufferWrapper          m_VulkanBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
+
+    VkBufferUsageFlags m_VkUsageFlags = 0;
+
+    // Whether the initial data copy was recorded into the device's upload batch
+    bool m_bInitialDataUploadRecorded = false;
+
+    // Resource heap the buffer is placed in, if any
+    RefCntAutoPtr<IResourceHeap> m_pHeap;
+
+    // Index in the render device's list of relocatable buffers
+    static constexpr Uint32 InvalidRelocatableBufferIdx = ~0u;
+    Uint32                  m_RelocatableBufferIdx      = InvalidRelocatableBufferIdx;
 };
 
 } // namespace Diligent
@@ -33,6 +33,7 @@
 #include "EngineVkImplTraits.hpp"
 #include "VulkanUtilities/VulkanHeaders.h"
 #include "CommandListBase.hpp"
+#include "DeviceContextVkImpl.hpp"
 
 namespace Diligent
 {
@@ -46,30 +47,65 @@ public:
     CommandListVkImpl(IReferenceCounters*  pRefCounters,
                       RenderDeviceVkImpl*  pDevice,
                       DeviceContextVkImpl* pDeferredCtx,
-                      VkCommandBuffer      vkCmdBuff) :
+                      VkCommandBuffer      vkCmdBuff,
+                      bool                 IsSecondary = false) :
         // clang-format off
         TCommandListBase {pRefCounters, pDevice, pDeferredCtx},
         m_pDeferredCtx   {pDeferredCtx},
-        m_vkCmdBuff      {vkCmdBuff   }
+        m_vkCmdBuff      {vkCmdBuff   },
+        m_IsSecondary    {IsSecondary },
+        m_CmdQueueId     {pDeferredCtx->GetCommandQueueId()}
     // clang-format on
     {
     }
 
     ~CommandListVkImpl()
     {
-        VERIFY(m_vkCmdBuff == VK_NULL_HANDLE && !m_pDeferredCtx, "Destroying command list that was never executed");
+        if (IsReusable())
+        {
+            // The command buffer may still be in use by the GPU, so it is returned to the pool
+            // through the release queue once the last submission has completed.
+            if (m_vkCmdBuff != VK_NULL_HANDLE)
+                m_pDeferredCtx.RawPtr<DeviceContextVkImpl>()->DisposeVkCmdBuffer(m_CmdQueueId, m_vkCmdBuff, m_LastSubmittedFenceValue);
+        }
+        else
+        {
+            VERIFY(m_vkCmdBuff == VK_NULL_HANDLE && !m_pDeferredCtx, "Destroying command list that was never executed");
+        }
     }
 
     void Close(RefCntAutoPtr<IDeviceContext>& outDeferredCtx, VkCommandBuffer& outVkCmdBuff)
     {
+        VERIFY(!IsReusable(), "Reusable command lists must never be closed");
         outVkCmdBuff   = m_vkCmdBuff;
         outDeferredCtx = std::move(m_pDeferredCtx);
         m_vkCmdBuff    = VK_NULL_HANDLE;
     }
 
+    /// Returns true if the command list was recorded into a secondary command buffer
+    /// by IDeviceContextVk::BeginSecondaryCommandBuffer().
+    bool IsSecondary() const { return m_IsSecondary; }
+
+    VkCommandBuffer GetVkCmdBuffer() const { return m_vkCmdBuff; }
+
+    DeviceContextVkImpl* GetDeferredContext() const { return m_pDeferredCtx.RawPtr<DeviceContextVkImpl>(); }
+
+    /// Records the fence value of the last submission of a reusable command list.
+    /// The command buffer is not recycled until this value is reached.
+    void OnSubmitted(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
+    {
+        VERIFY(IsReusable(), "Only reusable command lists are kept alive after submission");
+        DEV_CHECK_ERR(CmdQueue == m_CmdQueueId, "Reusable command list recorded for queue ", Uint32{m_CmdQueueId},
+                      " is executed in queue ", Uint32{CmdQueue}, ". Reusable command lists must be executed in the same immediate context.");
+        m_LastSubmittedFenceValue = std::max(m_LastSubmittedFenceValue, FenceValue);
+    }
+
 private:
     RefCntAutoPtr<IDeviceContext> m_pDeferredCtx;
     VkCommandBuffer               m_vkCmdBuff;
+    const bool                    m_IsSecondary;
+    const SoftwareQueueIndex      m_CmdQueueId;
+    Uint64                        m_LastSubmittedFenceValue = 0;
 };
 
 } // namespace Diligent
@@ -59,8 +59,10 @@ public:
 
     ~CommandPoolManager();
 
-    // Allocates Vulkan command pool.
-    VulkanUtilities::CommandPoolWrapper AllocateCommandPool(const char* DebugName = nullptr);
+    // Allocates Vulkan command pool and a primary command buffer from this pool.
+    // If the pool has been recycled, it is reset together with its command buffer, which
+    // is reused instead of allocating a new one.
+    VulkanUtilities::CommandPoolWrapper AllocateCommandPool(VkCommandBuffer& vkCmdBuff, const char* DebugName = nullptr);
 
     void DestroyPools();
 
@@ -71,8 +73,8 @@ public:
     }
 #endif
 
-    // Returns command pool to the list of available pools. The GPU must have finished using the pool
-    void RecycleCommandPool(VulkanUtilities::CommandPoolWrapper&& CmdPool);
+    // Returns command pool and its command buffer to the list of available pools. The GPU must have finished using the pool
+    void RecycleCommandPool(VulkanUtilities::CommandPoolWrapper&& CmdPool, VkCommandBuffer vkCmdBuff);
 
 private:
     const VulkanUtilities::VulkanLogicalDevice& m_LogicalDevice;
@@ -81,8 +83,15 @@ private:
     const HardwareQueueIndex       m_QueueFamilyIndex;
     const VkCommandPoolCreateFlags m_CmdPoolFlags;
 
-    std::mutex                                                                                               m_Mutex;
-    std::deque<VulkanUtilities::CommandPoolWrapper, STDAllocatorRawMem<VulkanUtilities::CommandPoolWrapper>> m_CmdPools;
+    struct PooledCmdPool
+    {
+        VulkanUtilities::CommandPoolWrapper Pool;
+        VkCommandBuffer                     vkCmdBuff = VK_NULL_HANDLE;
+    };
+
+    // The mutex only protects the deque. Vulkan calls to create or reset pools are made outside of the lock.
+    std::mutex                                                   m_Mutex;
+    std::deque<PooledCmdPool, STDAllocatorRawMem<PooledCmdPool>> m_CmdPools;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedPoolCounter{0};
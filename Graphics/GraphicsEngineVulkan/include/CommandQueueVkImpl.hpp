@@ -54,7 +54,8 @@ private:
                 Uint32                                    NumContexts,
                 VulkanUtilities::VulkanSyncObjectManager& SyncObjectMngr,
                 VkDevice                                  LogicalDevice,
-                Uint64                                    dbgValue);
+                VkSemaphore                               vkTimelineSemaphore,
+                Uint64                                    Value);
 
     void GetSemaphores(std::vector<VkSemaphore>& Semaphores);
 
@@ -73,12 +74,14 @@ public:
         return std::move(m_Semaphores[CommandQueueId]);
     }
 
-    // vkGetFenceStatus and vkWaitForFences with same fence can be used in multiple threads.
-    // Other functions requires external synchronization.
-    VkFence GetFence() const
-    {
-        return m_Fence;
-    }
+    // Returns VK_SUCCESS if the commands associated with the sync point have been completed,
+    // and VK_NOT_READY otherwise.
+    // vkGetFenceStatus and vkGetSemaphoreCounterValue can be used in multiple threads.
+    VkResult GetStatus(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice) const;
+
+    // Waits until the commands associated with the sync point are completed.
+    // vkWaitForFences and vkWaitSemaphores can be used in multiple threads.
+    VkResult Wait(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint64 Timeout) const;
 
     SoftwareQueueIndex GetCommandQueueId() const
     {
@@ -88,7 +91,9 @@ public:
 private:
     const SoftwareQueueIndex                 m_CommandQueueId;
     const Uint8                              m_NumSemaphores; // same as NumContexts
-    VulkanUtilities::VulkanRecycledFence     m_Fence;
+    const Uint64                             m_Value;
+    const VkSemaphore                        m_vkTimelineSemaphore; // Command queue timeline semaphore, or null if binary fence is used
+    VulkanUtilities::VulkanRecycledFence     m_Fence;               // Binary fence, or null if timeline semaphore is used
     VulkanUtilities::VulkanRecycledSemaphore m_Semaphores[1]; // [m_NumSemaphores]
 };
 
@@ -104,6 +109,7 @@ public:
                        SoftwareQueueIndex                                    CommandQueueId,
                        Uint32                                                NumCommandQueues,
                        Uint32                                                vkQueueIndex,
+                       Uint32                                                NumNodes,
                        const ImmediateContextCreateInfo&                     CreateInfo);
     ~CommandQueueVkImpl();
 
@@ -127,6 +133,9 @@ public:
     /// Implementation of ICommandQueueVk::Present().
     virtual VkResult DILIGENT_CALL_TYPE Present(const VkPresentInfoKHR& PresentInfo) override final;
 
+    /// Implementation of ICommandQueueVk::BindSparse().
+    virtual void DILIGENT_CALL_TYPE BindSparse(const VkBindSparseInfo& BindInfo) override final;
+
     /// Implementation of ICommandQueueVk::GetVkQueue().
     virtual VkQueue DILIGENT_CALL_TYPE GetVkQueue() override final { return m_VkQueue; }
 
@@ -153,7 +162,7 @@ public:
     }
 
 private:
-    SyncPointVkPtr CreateSyncPoint(Uint64 dbgValue);
+    SyncPointVkPtr CreateSyncPoint(Uint64 Value);
 
     void InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore, Uint64 Value);
 
@@ -165,21 +174,34 @@ private:
     const bool               m_SupportedTimelineSemaphore;
     const Uint8              m_NumCommandQueues;
 
+    // Device mask of the submitted command buffers, or 0 if the logical device
+    // was not created over a device group.
+    const Uint32 m_DeviceMask;
+
     // Fence is signaled right after a command buffer has been
     // submitted to the command queue for execution.
     // All command buffers with fence value less than or equal to the signaled value
-    // are guaranteed to be finished by the GPU
+    // are guaranteed to be finished by the GPU.
+    // The fence is not used when the queue owns a timeline semaphore.
     RefCntAutoPtr<FenceVkImpl> m_pFence;
 
     // A value that will be signaled by the command queue next
     std::atomic_uint64_t m_NextFenceValue{1};
 
+    // When timeline semaphores are supported, the queue signals this semaphore with the fence value
+    // of every submission. This replaces the VkFence allocated for every submit and polled with vkGetFenceStatus.
+    VulkanUtilities::SemaphoreWrapper m_TimelineSemaphore;
+
     // Protects access to the m_VkQueue internal data.
     std::mutex m_QueueMutex;
 
     // Array used to merge semaphores from SubmitInfo and from SyncPointVk
     std::vector<VkSemaphore> m_TempSignalSemaphores;
 
+    // Arrays referenced by VkDeviceGroupSubmitInfo when m_DeviceMask is not zero
+    std::vector<Uint32> m_TempCmdBufferDeviceMasks;
+    std::vector<Uint32> m_TempSemaphoreDeviceIndices;
+
     // Protects access to the m_LastSyncPoint
     ThreadingTools::LockFlag m_LastSyncPointGuard;
 
@@ -0,0 +1,205 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::DescriptorBufferVk class
+
+#include <mutex>
+
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+class DescriptorBufferVk;
+
+// Range of the global descriptor buffer that holds the descriptors of one descriptor set.
+// The class destructor returns the range to the descriptor buffer through the release queue.
+class DescriptorBufferAllocation
+{
+public:
+    // clang-format off
+    DescriptorBufferAllocation(DescriptorBufferVk& _Owner,
+                               VkDeviceSize        _Offset,
+                               VkDeviceSize        _Size,
+                               Uint8*              _pCPUAddress,
+                               Uint64              _CmdQueueMask)noexcept :
+        pOwner      {&_Owner       },
+        pCPUAddress {_pCPUAddress  },
+        Offset      {_Offset       },
+        Size        {_Size         },
+        CmdQueueMask{_CmdQueueMask }
+    {}
+    DescriptorBufferAllocation()noexcept{}
+
+    DescriptorBufferAllocation             (const DescriptorBufferAllocation&) = delete;
+    DescriptorBufferAllocation& operator = (const DescriptorBufferAllocation&) = delete;
+
+    DescriptorBufferAllocation(DescriptorBufferAllocation&& rhs)noexcept :
+        pOwner      {rhs.pOwner      },
+        pCPUAddress {rhs.pCPUAddress },
+        Offset      {rhs.Offset      },
+        Size        {rhs.Size        },
+        CmdQueueMask{rhs.CmdQueueMask}
+    {
+        rhs.Reset();
+    }
+    // clang-format on
+
+    DescriptorBufferAllocation& operator=(DescriptorBufferAllocation&& rhs) noexcept
+    {
+        Release();
+
+        pOwner       = rhs.pOwner;
+        pCPUAddress  = rhs.pCPUAddress;
+        Offset       = rhs.Offset;
+        Size         = rhs.Size;
+        CmdQueueMask = rhs.CmdQueueMask;
+
+        rhs.Reset();
+
+        return *this;
+    }
+
+    explicit operator bool() const
+    {
+        return pOwner != nullptr;
+    }
+
+    void Reset()
+    {
+        pOwner       = nullptr;
+        pCPUAddress  = nullptr;
+        Offset       = 0;
+        Size         = 0;
+        CmdQueueMask = 0;
+    }
+
+    void Release();
+
+    ~DescriptorBufferAllocation()
+    {
+        Release();
+    }
+
+    // Offset of the range from the start of the descriptor buffer
+    VkDeviceSize GetOffset() const { return Offset; }
+    VkDeviceSize GetSize() const { return Size; }
+    Uint8*       GetCPUAddress() const { return pCPUAddress; }
+
+private:
+    DescriptorBufferVk* pOwner       = nullptr;
+    Uint8*              pCPUAddress  = nullptr;
+    VkDeviceSize        Offset       = 0;
+    VkDeviceSize        Size         = 0;
+    Uint64              CmdQueueMask = 0;
+};
+
+
+/// Global descriptor buffer (VK_EXT_descriptor_buffer).
+
+/// The buffer is allocated in host-visible memory and is persistently mapped.
+/// Every shader resource binding suballocates the range for its static and mutable
+/// descriptor set from the buffer, and descriptors are written directly into the mapped
+/// memory with vkGetDescriptorEXT. Dynamic descriptor sets are written into the dynamic heap
+/// by the device context. The device context binds the global descriptor buffer and the dynamic
+/// heap once per command buffer and selects descriptor sets with vkCmdSetDescriptorBufferOffsetsEXT.
+class DescriptorBufferVk
+{
+public:
+    // Descriptor buffer binding indices used by the device context
+    enum BUFFER_INDEX : Uint32
+    {
+        BUFFER_INDEX_GLOBAL = 0,
+        BUFFER_INDEX_DYNAMIC_HEAP,
+        BUFFER_INDEX_COUNT
+    };
+
+    DescriptorBufferVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 Size);
+
+    // clang-format off
+    DescriptorBufferVk             (const DescriptorBufferVk&) = delete;
+    DescriptorBufferVk             (DescriptorBufferVk&&)      = delete;
+    DescriptorBufferVk& operator = (const DescriptorBufferVk&) = delete;
+    DescriptorBufferVk& operator = (DescriptorBufferVk&&)      = delete;
+    // clang-format on
+
+    ~DescriptorBufferVk();
+
+    DescriptorBufferAllocation Allocate(VkDeviceSize Size, Uint64 CmdQueueMask);
+
+    // Defers the release of the range until the GPU is done with all command buffers
+    // submitted to the queues in CmdQueueMask.
+    void Free(VkDeviceSize Offset, VkDeviceSize Size, Uint64 CmdQueueMask);
+
+    // Returns the size of a descriptor of the given type
+    Uint32 GetDescriptorSize(VkDescriptorType Type) const;
+
+    // Dynamic descriptor types can't be used with descriptor buffers; dynamic buffers
+    // are addressed directly and their descriptors are written at every commit.
+    static VkDescriptorType GetDescriptorBufferType(VkDescriptorType Type)
+    {
+        switch (Type)
+        {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            default: return Type;
+        }
+    }
+
+    // Returns the required alignment of descriptor set offsets
+    VkDeviceSize GetOffsetAlignment() const { return m_OffsetAlignment; }
+
+    VkBuffer        GetVkBuffer() const { return m_VkBuffer; }
+    VkDeviceAddress GetDeviceAddress() const { return m_DeviceAddress; }
+
+    static constexpr VkBufferUsageFlags DescriptorBufferUsage =
+        VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+        VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+
+private:
+    struct StaleRange;
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    VulkanUtilities::BufferWrapper       m_VkBuffer;
+    VulkanUtilities::DeviceMemoryWrapper m_BufferMemory;
+
+    Uint8*             m_CPUAddress      = nullptr;
+    VkDeviceAddress    m_DeviceAddress   = 0;
+    const VkDeviceSize m_OffsetAlignment = 0;
+
+    std::mutex                     m_AllocationMtx;
+    VariableSizeAllocationsManager m_AllocationMgr;
+};
+
+} // namespace Diligent
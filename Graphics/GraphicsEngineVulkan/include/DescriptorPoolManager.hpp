@@ -34,6 +34,7 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <array>
 
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 
@@ -46,7 +47,7 @@ class RenderDeviceVkImpl;
 // This class manages descriptor set allocation.
 // The class destructor calls DescriptorSetAllocator::FreeDescriptorSet() that moves
 // the set into the release queue.
-// sizeof(DescriptorSetAllocation) == 32 (x64)
+// sizeof(DescriptorSetAllocation) == 40 (x64)
 class DescriptorSetAllocation
 {
 public:
@@ -54,11 +55,13 @@ public:
     DescriptorSetAllocation(VkDescriptorSet         _Set,
                             VkDescriptorPool        _Pool,
                             Uint64                  _CmdQueueMask,
-                            DescriptorSetAllocator& _DescrSetAllocator)noexcept :
+                            DescriptorSetAllocator& _DescrSetAllocator,
+                            Uint32                  _ShardIdx)noexcept :
         Set              {_Set               },
         Pool             {_Pool              },
         CmdQueueMask     {_CmdQueueMask      },
-        DescrSetAllocator{&_DescrSetAllocator}
+        DescrSetAllocator{&_DescrSetAllocator},
+        ShardIdx         {_ShardIdx          }
     {}
     DescriptorSetAllocation()noexcept{}
 
@@ -69,7 +72,8 @@ public:
         Set              {rhs.Set              },
         Pool             {rhs.Pool             },
         CmdQueueMask     {rhs.CmdQueueMask     },
-        DescrSetAllocator{rhs.DescrSetAllocator}
+        DescrSetAllocator{rhs.DescrSetAllocator},
+        ShardIdx         {rhs.ShardIdx         }
     {
         rhs.Reset();
     }
@@ -83,6 +87,7 @@ public:
         CmdQueueMask      = rhs.CmdQueueMask;
         Pool              = rhs.Pool;
         DescrSetAllocator = rhs.DescrSetAllocator;
+        ShardIdx          = rhs.ShardIdx;
 
         rhs.Reset();
 
@@ -100,6 +105,7 @@ public:
         Pool              = VK_NULL_HANDLE;
         CmdQueueMask      = 0;
         DescrSetAllocator = nullptr;
+        ShardIdx          = 0;
     }
 
     void Release();
@@ -116,6 +122,7 @@ private:
     VkDescriptorPool        Pool              = VK_NULL_HANDLE;
     Uint64                  CmdQueueMask      = 0;
     DescriptorSetAllocator* DescrSetAllocator = nullptr;
+    Uint32                  ShardIdx          = 0; // Index of the allocator shard that owns the pool
 };
 
 
@@ -183,7 +190,20 @@ private:
 
 
 // The class allocates descriptor sets from the main descriptor pool.
-// Descriptors sets can be released and returned to the pool
+// Descriptors sets can be released and returned to the pool.
+//
+// Vulkan descriptor pools are externally synchronized, so every pool is owned by one of
+// the allocator shards and is only accessed under the shard mutex. Every thread is
+// bound to a shard when it first allocates a set. As long as there are no more threads
+// than shards, allocations from different threads never contend for the same mutex.
+// A set is always returned to the shard that allocated it.
+//
+//      Thread 0     Thread 1     Thread 2                 Release queue
+//         |            |            |                           |
+//         V            V            V                           V
+//   | Shard[0]   | Shard[1]   | Shard[2]   | ... |    FreeDescriptorSet(ShardIdx)
+//   |  Pool Pool |  Pool      |  Pool Pool |
+//
 class DescriptorSetAllocator : public DescriptorPoolManager
 {
 public:
@@ -213,6 +233,14 @@ public:
 
     DescriptorSetAllocation Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "");
 
+    // Allocates NumSets descriptor sets with the same layout under a single shard lock.
+    // The sets are allocated from a pool with as few vkAllocateDescriptorSets calls as possible.
+    void Allocate(Uint64                   CommandQueueMask,
+                  VkDescriptorSetLayout    SetLayout,
+                  Uint32                   NumSets,
+                  DescriptorSetAllocation* pAllocations,
+                  const char*              DebugName = "");
+
 #ifdef DILIGENT_DEVELOPMENT
     int32_t GetAllocatedDescriptorSetCounter() const
     {
@@ -220,8 +248,38 @@ public:
     }
 #endif
 
+    struct Statistics
+    {
+        // The total number of allocated descriptor sets
+        Uint64 NumAllocations = 0;
+
+        // The number of allocations that had to create a new descriptor pool
+        Uint64 NumPoolCreations = 0;
+
+        // The number of times a thread found its shard mutex locked by another thread
+        Uint64 NumContendedLocks = 0;
+    };
+    Statistics GetStatistics() const;
+
+    static constexpr Uint32 NumShards = 16;
+
 private:
-    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
+    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask, Uint32 ShardIdx);
+
+    static Uint32 GetThreadShardIndex();
+
+    struct Shard
+    {
+        std::mutex                                         Mtx;
+        std::deque<VulkanUtilities::DescriptorPoolWrapper> Pools;
+
+        std::unique_lock<std::mutex> Lock(std::atomic<Uint64>& NumContendedLocks);
+    };
+    std::array<Shard, NumShards> m_Shards;
+
+    std::atomic<Uint64> m_NumAllocations{0};
+    std::atomic<Uint64> m_NumPoolCreations{0};
+    std::atomic<Uint64> m_NumContendedLocks{0};
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_AllocatedSetCounter;
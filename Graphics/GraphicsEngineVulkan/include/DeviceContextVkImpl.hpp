@@ -80,7 +80,7 @@ public:
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceContextVk, TDeviceContextBase)
 
     /// Implementation of IDeviceContext::Begin() in Vulkan backend.
-    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId) override final;
+    virtual void DILIGENT_CALL_TYPE Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags) override final;
 
     /// Implementation of IDeviceContext::SetPipelineState() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
@@ -93,12 +93,18 @@ public:
     virtual void DILIGENT_CALL_TYPE CommitShaderResources(IShaderResourceBinding*        pShaderResourceBinding,
                                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
 
+    /// Implementation of IDeviceContext::SetInlineConstants() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetInlineConstants(const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants) override final;
+
     /// Implementation of IDeviceContext::SetStencilRef() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetStencilRef(Uint32 StencilRef) override final;
 
     /// Implementation of IDeviceContext::SetBlendFactors() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetBlendFactors(const float* pBlendFactors = nullptr) override final;
 
+    /// Implementation of IDeviceContext::SetDynamicStates() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetDynamicStates(const DynamicStateAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::SetVertexBuffers() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetVertexBuffers(Uint32                         StartSlot,
                                                      Uint32                         NumBuffersSet,
@@ -151,6 +157,10 @@ public:
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndirectCount() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
+    /// Implementation of IDeviceContext::DrawIndexedIndirectCount() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer) override final;
     /// Implementation of IDeviceContext::DrawMesh() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawMesh           (const DrawMeshAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawMeshIndirect() in Vulkan backend.
@@ -213,6 +223,12 @@ public:
                                                   RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                                   RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionModee) override final;
 
+    /// Implementation of IDeviceContext::UpdateTextureRegions() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTextureRegions(ITexture*                      pTexture,
+                                                         const TextureRegionUpdate*     pUpdates,
+                                                         Uint32                         NumUpdates,
+                                                         RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
+
     /// Implementation of IDeviceContext::CopyTexture() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
 
@@ -250,6 +266,15 @@ public:
     /// Implementation of IDeviceContext::EndQuery() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE EndQuery(IQuery* pQuery) override final;
 
+    /// Implementation of IDeviceContext::GetTimestampCalibration() in Vulkan backend.
+    virtual Bool DILIGENT_CALL_TYPE GetTimestampCalibration(TimestampCalibration& Calibration) override final;
+
+    /// Implementation of IDeviceContext::BeginConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BeginConditionalRendering(IQuery* pQuery) override final;
+
+    /// Implementation of IDeviceContext::EndConditionalRendering() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE EndConditionalRendering() override final;
+
     /// Implementation of IDeviceContext::Flush() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE Flush() override final;
 
@@ -259,6 +284,9 @@ public:
     /// Implementation of IDeviceContext::BuildTLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
 
+    /// Implementation of IDeviceContext::BuildBLASBatch() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE BuildBLASBatch(const BuildBLASBatchAttribs& Attribs) override final;
+
     /// Implementation of IDeviceContext::CopyBLAS() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final;
 
@@ -315,12 +343,27 @@ public:
                                RESOURCE_STATE NewState,
                                bool           UpdateBufferState);
 
+    // Moves the buffer memory into a more densely occupied memory page, see VulkanMemoryManager::AllocateForRelocation().
+    // The buffer handle is replaced with a new one, and the contents are copied by the GPU.
+    // The original handle and memory are released when the GPU is done with them.
+    // Returns the size of the relocated buffer, or zero if the buffer has not been relocated.
+    VkDeviceSize RelocateBufferMemory(BufferVkImpl& BufferVk, double MaxSrcPageOccupancy);
+
     /// Implementation of IDeviceContextVk::BufferMemoryBarrier().
     virtual void DILIGENT_CALL_TYPE BufferMemoryBarrier(IBuffer* pBuffer, VkAccessFlags NewAccessFlags) override final;
 
     /// Implementation of IDeviceContextVk::GetVkCommandBuffer().
     virtual VkCommandBuffer DILIGENT_CALL_TYPE GetVkCommandBuffer() override final;
 
+    /// Implementation of IDeviceContextVk::BeginSecondaryCommandBuffer().
+    virtual void DILIGENT_CALL_TYPE BeginSecondaryCommandBuffer(Uint32        ImmediateContextId,
+                                                                IRenderPass*  pRenderPass,
+                                                                Uint32        SubpassIndex,
+                                                                IFramebuffer* pFramebuffer) override final;
+
+    /// Implementation of IDeviceContextVk::BeginRenderPassWithSecondaryCommandBuffers().
+    virtual void DILIGENT_CALL_TYPE BeginRenderPassWithSecondaryCommandBuffers(const BeginRenderPassAttribs& Attribs) override final;
+
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
     void TransitionBLASState(BottomLevelASVkImpl& BLAS,
@@ -376,6 +419,8 @@ public:
 
     virtual void DILIGENT_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
 
+    virtual void DILIGENT_CALL_TYPE GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews) override final;
+
     size_t GetNumCommandsInCtx() const { return m_State.NumCommands; }
 
     __forceinline VulkanUtilities::VulkanCommandBuffer& GetCommandBuffer()
@@ -393,8 +438,14 @@ public:
                                                               ITexture*                               pDstTexture,
                                                               const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
 
+    /// Implementation of IDeviceContext::UpdateTileMappings() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs) override final;
+
     VkDescriptorSet AllocateDynamicDescriptorSet(VkDescriptorSetLayout SetLayout, const char* DebugName = "")
     {
+        DEV_CHECK_ERR(!IsRecordingReusableCommandList(),
+                      "Dynamic descriptor sets are only valid for one frame and can't be used in a reusable command list. "
+                      "Use shader resource bindings that have no dynamic variables.");
         // Descriptor pools are externally synchronized, meaning that the application must not allocate
         // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
         return m_DynamicDescrSetAllocator.Allocate(SetLayout, DebugName);
@@ -402,6 +453,13 @@ public:
 
     VulkanDynamicAllocation AllocateDynamicSpace(Uint32 SizeInBytes, Uint32 Alignment);
 
+    // Returns the command buffer to the command pool of this context once the GPU has
+    // reached the fence value. Can be called from any thread.
+    void DisposeVkCmdBuffer(SoftwareQueueIndex   CmdQueue,
+                            VkCommandBuffer      vkCmdBuff,
+                            Uint64               FenceValue,
+                            VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
     virtual void ResetRenderTargets() override final;
 
     GenerateMipsVkHelper& GetGenerateMipsHelper() { return *m_GenerateMipsHelper; }
@@ -410,13 +468,35 @@ public:
 private:
     void               TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
     __forceinline void CommitRenderPassAndFramebuffer(bool VerifyStates);
+    void               BeginDynamicRendering();
+    bool               IsFramebufferBound() const;
     void               CommitVkVertexBuffers();
     void               CommitViewports();
     void               CommitScissorRects();
+    void               CommitDynamicStates(const DynamicStateAttribs& Attribs);
 
     void Flush(Uint32               NumCommandLists,
                ICommandList* const* ppCommandLists);
 
+    // Ends the current command buffer and adds it to the pending submission batch
+    void EndCurrentCmdBuffer();
+    // Adds command buffers of the command lists to the pending submission batch
+    void EnqueueCommandLists(Uint32               NumCommandLists,
+                             ICommandList* const* ppCommandLists);
+
+    void BeginRenderPass(const BeginRenderPassAttribs& Attribs, VkSubpassContents SubpassContents);
+    void ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                      ICommandList* const* ppCommandLists);
+
+    // Resource state transitions record pipeline barriers, which are not allowed in a secondary
+    // command buffer that continues a render pass (see BeginSecondaryCommandBuffer()).
+    bool CheckStateTransitionAllowed() const
+    {
+        DEV_CHECK_ERR(!m_IsSecondaryCmdBuffer, "Resource state transitions are not allowed in a secondary command buffer. "
+                                               "Transition the resources in the immediate context before the render pass is begun.");
+        return !m_IsSecondaryCmdBuffer;
+    }
+
     __forceinline void TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                      RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                      RESOURCE_STATE                 RequiredState,
@@ -439,6 +519,13 @@ private:
                                                    RESOURCE_STATE                 RequiredState,
                                                    const char*                    OperationName);
 
+    // Records the first half of a split transition by setting an event.
+    // Begin barriers for acceleration structures are ignored.
+    void BeginSplitBarrier(const StateTransitionDesc& Barrier);
+
+    // Returns the index of the pending split barrier that matches the end barrier, or -1 if there is none.
+    int FindPendingSplitBarrier(const StateTransitionDesc& Barrier) const;
+
     __forceinline void EnsureVkCmdBuffer()
     {
         VERIFY_EXPR(m_CmdPool != nullptr);
@@ -448,14 +535,13 @@ private:
         m_State.NumCommands = m_State.NumCommands != 0 ? m_State.NumCommands : 1;
         if (m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE)
         {
-            auto vkCmdBuff = m_CmdPool->GetCommandBuffer();
+            auto vkCmdBuff = IsRecordingReusableCommandList() ?
+                m_CmdPool->GetCommandBuffer("", VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT) :
+                m_CmdPool->GetCommandBuffer();
             m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask());
         }
     }
 
-    inline void DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue);
-    inline void DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue);
-
     void CopyBufferToTexture(VkBuffer                       vkSrcBuffer,
                              Uint32                         SrcBufferOffset,
                              Uint32                         SrcBufferRowStrideInTexels,
@@ -480,6 +566,15 @@ private:
     __forceinline void          PrepareForDispatchCompute();
     __forceinline void          PrepareForRayTracing();
 
+    // Transitions the BLAS and the geometry buffers and fills the build info, geometries and build ranges.
+    // vkGeometries and vkRanges must have space for TriangleDataCount or BoxDataCount elements.
+    void PrepareBLASBuild(const BuildBLASAttribs&                      Attribs,
+                          VkDeviceAddress                              ScratchAddress,
+                          VkAccelerationStructureBuildGeometryInfoKHR& vkASBuildInfo,
+                          VkAccelerationStructureGeometryKHR*          vkGeometries,
+                          VkAccelerationStructureBuildRangeInfoKHR*    vkRanges,
+                          const char*                                  OpName);
+
     void DvpLogRenderPass_PSOMismatch();
 
     void CreateASCompactedSizeQueryPool();
@@ -499,6 +594,10 @@ private:
         Uint32 NumCommands = 0;
 
         VkPipelineBindPoint vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+
+        /// Flag indicating if the global descriptor buffer and the dynamic heap are bound
+        /// as descriptor buffers in the current command buffer
+        bool DescriptorBuffersBound = false;
     } m_State;
 
     // Graphics/mesh, compute, ray tracing
@@ -520,6 +619,32 @@ private:
             // Note that this is not the actual number of dynamic buffers in the resource cache.
             Uint32 DynamicOffsetCount = 0;
 
+            // Descriptor info of dynamic resources captured by CommitShaderResources() for signatures
+            // that support push descriptors (see PipelineResourceSignatureVkImpl::SupportsPushDescriptors()).
+            // The dynamic set is then pushed or allocated and written by CommitDescriptorSets().
+            std::vector<ShaderResourceCacheVk::DescriptorWriteInfo> DynamicDescrData;
+
+            // Whether dynamic resources are in DynamicDescrData rather than in vkSets
+            bool DeferredDynamicSet = false;
+
+            // Whether the pipeline layout of the current pipeline uses push descriptors for the dynamic set
+            bool PushDynamicSet = false;
+
+            // Descriptor sets and dynamic offsets that are currently bound at BaseInd in the command buffer.
+            // A pushed set is recorded as VK_NULL_HANDLE. Sets that are already bound are not bound again.
+            std::array<VkDescriptorSet, MAX_DESCR_SET_PER_SIGNATURE> vkBoundSets = {};
+            std::vector<Uint32>                                      BoundDynamicOffsets;
+
+            // Compatibility hash (see PipelineLayoutVk::GetSetCompatibilityHash()) of the pipeline layout
+            // that the sets were bound with, or 0 if the sets have been disturbed.
+            size_t BoundLayoutHash = 0;
+
+            void InvalidateBoundSets()
+            {
+                vkBoundSets.fill(VK_NULL_HANDLE);
+                BoundLayoutHash = 0;
+            }
+
 #ifdef DILIGENT_DEVELOPMENT
             // The descriptor set base index that was used in the last BindDescriptorSets() call
             Uint32 LastBoundBaseInd = ~0u;
@@ -537,6 +662,17 @@ private:
     __forceinline ResourceBindInfo& GetBindInfo(PIPELINE_TYPE Type);
 
     __forceinline void CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint32 CommitSRBMask);
+
+    // Binds the descriptor sets [0, SetCount) of the SRB that differ from the sets that are already bound,
+    // as a single range. SetOffsetCounts contains the number of dynamic offsets of every set in m_DynamicBufferOffsets.
+    void BindChangedDescriptorSets(ResourceBindInfo& BindInfo, Uint32 SRBIndex, Uint32 SetCount, const Uint32* SetOffsetCounts);
+
+    // Updates the bound set tracking after the sets of the SRB at the given index have been bound with the
+    // current pipeline layout. SRBIndex equal to the signature count stands for the bindless heap set.
+    void OnDescriptorSetsBound(ResourceBindInfo& BindInfo, Uint32 SRBIndex);
+
+    // Sets the descriptor buffer offsets of the SRB's descriptor sets (see EngineVkCreateInfo::DescriptorBufferSize)
+    void CommitDescriptorBufferSets(ResourceBindInfo& BindInfo, Uint32 SRBIndex);
 #ifdef DILIGENT_DEVELOPMENT
     void DvpValidateCommittedShaderResources(ResourceBindInfo& BindInfo);
 #endif
@@ -547,8 +683,12 @@ private:
     /// Memory to store dynamic buffer offsets for descriptor sets.
     std::vector<Uint32> m_DynamicBufferOffsets;
 
+    /// Scratch memory for descriptor update template data of dynamic descriptor sets.
+    std::vector<ShaderResourceCacheVk::DescriptorWriteInfo> m_DescriptorTemplateData;
+
     /// Render pass that matches currently bound render targets.
-    /// This render pass may or may not be currently set in the command buffer
+    /// This render pass may or may not be currently set in the command buffer.
+    /// Null for render targets set by SetRenderTargets() when dynamic rendering is used.
     VkRenderPass m_vkRenderPass = VK_NULL_HANDLE;
 
     /// Framebuffer that matches currently bound render targets.
@@ -612,8 +752,8 @@ private:
     VulkanDynamicHeap             m_DynamicHeap;
     DynamicDescriptorSetAllocator m_DynamicDescrSetAllocator;
 
-    std::shared_ptr<GenerateMipsVkHelper> m_GenerateMipsHelper;
-    RefCntAutoPtr<IShaderResourceBinding> m_GenerateMipsSRB;
+    std::shared_ptr<GenerateMipsVkHelper>  m_GenerateMipsHelper;
+    GenerateMipsVkHelper::ContextResources m_GenerateMipsResources;
 
     // In Vulkan we can't bind null vertex buffer, so we have to create a dummy VB
     RefCntAutoPtr<BufferVkImpl> m_DummyVB;
@@ -621,9 +761,66 @@ private:
     std::unique_ptr<QueryManagerVk> m_QueryMgr;
     Int32                           m_ActiveQueriesCounter = 0;
 
+    // Device-local buffer the binary occlusion query result is copied into for conditional rendering.
+    // The buffer is created on first use.
+    VulkanUtilities::BufferWrapper          m_PredicateBuffer;
+    VulkanUtilities::VulkanMemoryAllocation m_PredicateBufferMemory;
+
     std::vector<VkClearValue> m_vkClearValues;
 
+    // Copy regions recorded by UpdateTextureRegions()
+    std::vector<VkBufferImageCopy> m_BufferImageCopies;
+
     VulkanUtilities::QueryPoolWrapper m_ASQueryPool;
+
+    /// Contents of the subpasses of the active render pass.
+    /// If VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, the subpasses are recorded by deferred contexts.
+    VkSubpassContents m_vkSubpassContents = VK_SUBPASS_CONTENTS_INLINE;
+
+    /// Indicates that the deferred context records a secondary command buffer,
+    /// see IDeviceContextVk::BeginSecondaryCommandBuffer().
+    bool m_IsSecondaryCmdBuffer = false;
+
+    /// Secondary command buffers executed in the current primary command buffer.
+    /// They are disposed by Flush() when the primary command buffer is submitted.
+    std::vector<std::pair<RefCntAutoPtr<IDeviceContext>, VkCommandBuffer>> m_ExecutedSecondaryCmdBuffs;
+
+    /// Command buffer waiting to be submitted by the next Flush().
+    struct PendingCmdBuffer
+    {
+        VkCommandBuffer vkCmdBuff = VK_NULL_HANDLE;
+
+        // Deferred context that recorded the command buffer, or null for the command buffer of this context
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+
+        // Reusable command list that owns the command buffer
+        RefCntAutoPtr<ICommandList> pReusableCmdList;
+    };
+    /// Command buffers are submitted in the order they are added to this list.
+    std::vector<PendingCmdBuffer> m_PendingCmdBuffers;
+
+    /// If true, ExecuteCommandLists() only adds command lists to m_PendingCmdBuffers,
+    /// see EngineCreateInfo::BatchCommandListSubmission.
+    bool m_BatchCommandListSubmission = false;
+
+    /// Split barriers that have been started with STATE_TRANSITION_TYPE_BEGIN and not yet ended.
+    /// The begin barrier sets the event, and the end barrier waits for it with vkCmdWaitEvents.
+    struct PendingSplitBarrier
+    {
+        RefCntAutoPtr<IDeviceObject> pResource;
+
+        Uint32 FirstMipLevel   = 0;
+        Uint32 MipLevelsCount  = 0;
+        Uint32 FirstArraySlice = 0;
+        Uint32 ArraySliceCount = 0;
+
+        VkPipelineStageFlags          SrcStages = 0;
+        VulkanUtilities::EventWrapper Event;
+    };
+    std::vector<PendingSplitBarrier> m_PendingSplitBarriers;
+
+    /// Events of ended split barriers. They are released by FinishFrame().
+    std::vector<VulkanUtilities::EventWrapper> m_UsedSplitBarrierEvents;
 };
 
 } // namespace Diligent
@@ -48,6 +48,8 @@
 #include "TopLevelASVk.h"
 #include "ShaderBindingTableVk.h"
 #include "PipelineResourceSignature.h"
+#include "PipelineStateCacheVk.h"
+#include "ResourceHeapVk.h"
 #include "CommandQueueVk.h"
 #include "DeviceContextVk.h"
 
@@ -73,6 +75,8 @@ class BottomLevelASVkImpl;
 class TopLevelASVkImpl;
 class ShaderBindingTableVkImpl;
 class PipelineResourceSignatureVkImpl;
+class PipelineStateCacheVkImpl;
+class ResourceHeapVkImpl;
 
 class FixedBlockMemoryAllocator;
 
@@ -103,6 +107,8 @@ struct EngineVkImplTraits
     using ShaderBindingTableInterface        = IShaderBindingTableVk;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
     using CommandQueueInterface              = ICommandQueueVk;
+    using PipelineStateCacheInterface        = IPipelineStateCacheVk;
+    using ResourceHeapInterface              = IResourceHeapVk;
 
     using RenderDeviceImplType              = RenderDeviceVkImpl;
     using DeviceContextImplType             = DeviceContextVkImpl;
@@ -123,6 +129,8 @@ struct EngineVkImplTraits
     using TopLevelASImplType                = TopLevelASVkImpl;
     using ShaderBindingTableImplType        = ShaderBindingTableVkImpl;
     using PipelineResourceSignatureImplType = PipelineResourceSignatureVkImpl;
+    using PipelineStateCacheImplType        = PipelineStateCacheVkImpl;
+    using ResourceHeapImplType              = ResourceHeapVkImpl;
 
     using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
     using TexViewObjAllocatorType  = FixedBlockMemoryAllocator;
@@ -32,8 +32,12 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <memory>
+#include <atomic>
 
+#include "GraphicsTypes.h"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "ReadMostlyHashMap.hpp"
 
 namespace Diligent
 {
@@ -42,9 +46,16 @@ class RenderDeviceVkImpl;
 class FramebufferCache
 {
 public:
-    FramebufferCache(RenderDeviceVkImpl& DeviceVKImpl) :
-        m_DeviceVk{DeviceVKImpl}
-    {}
+    // MaxSize - the maximum number of framebuffers in the cache, or 0 if the size is not limited.
+    // MaxAge  - the number of frames after which an unused framebuffer is evicted, or 0 to disable age-based eviction.
+    FramebufferCache(RenderDeviceVkImpl& DeviceVKImpl, Uint32 MaxSize = 0, Uint32 MaxAge = 0) :
+        m_DeviceVk{DeviceVKImpl},
+        m_MaxSize{MaxSize},
+        m_MaxAge{MaxAge}
+    {
+        for (auto& Counter : m_HitCounters)
+            Counter.NumHits.store(0, std::memory_order_relaxed);
+    }
 
     // clang-format off
     FramebufferCache             (const FramebufferCache&) = delete;
@@ -76,9 +87,48 @@ public:
     void          OnDestroyImageView(VkImageView ImgView);
     void          OnDestroyRenderPass(VkRenderPass Pass);
 
+    // Advances the frame counter and evicts framebuffers that have not been used for MaxAge frames.
+    // Must be called once per frame.
+    void OnFinishFrame();
+
+    void GetStatistics(FramebufferCacheStatistics& Stats);
+
 private:
+    // Framebuffer shared by m_Cache and m_Lookup. Lock-free readers may access the entry
+    // after it has been evicted, until the lookup table node that references it is deleted.
+    struct FramebufferEntry
+    {
+        FramebufferEntry(VulkanUtilities::FramebufferWrapper&& _Framebuffer, Uint64 Frame) :
+            Framebuffer{std::move(_Framebuffer)},
+            vkFramebuffer{Framebuffer},
+            LastUsedFrame{Frame},
+            Evicted{false}
+        {}
+
+        VulkanUtilities::FramebufferWrapper Framebuffer;
+
+        const VkFramebuffer vkFramebuffer;
+
+        // The last frame in which the framebuffer was returned by GetFramebuffer()
+        std::atomic<Uint64> LastUsedFrame;
+
+        // Set by the eviction before the framebuffer is released, see TryEvict()
+        std::atomic<bool> Evicted;
+    };
+    using FramebufferEntryPtr = std::shared_ptr<FramebufferEntry>;
+
+    void MarkUsed(FramebufferEntry& Entry) const;
+    bool TryEvict(const FramebufferCacheKey& Key, FramebufferEntry& Entry, Uint64 MinAge);
+    void EvictLeastRecentlyUsed(size_t NumToEvict);
+    void RemoveKeyReferences(const FramebufferCacheKey& Key);
+
     RenderDeviceVkImpl& m_DeviceVk;
 
+    const Uint32 m_MaxSize;
+    const Uint32 m_MaxAge;
+
+    std::atomic<Uint64> m_CurrentFrame{0};
+
     struct FramebufferCacheKeyHash
     {
         std::size_t operator()(const FramebufferCacheKey& Key) const
@@ -87,11 +137,28 @@ private:
         }
     };
 
-    std::mutex                                                                                            m_Mutex;
-    std::unordered_map<FramebufferCacheKey, VulkanUtilities::FramebufferWrapper, FramebufferCacheKeyHash> m_Cache;
+    // The mutex protects m_Cache, the reverse maps and the miss and eviction counters,
+    // and serializes modifications of m_Lookup
+    std::mutex                                                                            m_Mutex;
+    std::unordered_map<FramebufferCacheKey, FramebufferEntryPtr, FramebufferCacheKeyHash> m_Cache;
+
+    // Lock-free lookup table for the framebuffers owned by m_Cache
+    ReadMostlyHashMap<FramebufferCacheKey, FramebufferEntryPtr, FramebufferCacheKeyHash> m_Lookup;
 
     std::unordered_multimap<VkImageView, FramebufferCacheKey>  m_ViewToKeyMap;
     std::unordered_multimap<VkRenderPass, FramebufferCacheKey> m_RenderPassToKeyMap;
+
+    Uint64 m_NumMisses    = 0;
+    Uint64 m_NumEvictions = 0;
+
+    // Lock-free hits are counted per thread group so that readers do not contend for the same cache line
+    static constexpr size_t NumHitCounters = 16;
+    struct HitCounter
+    {
+        std::atomic<Uint64> NumHits;
+        Uint8               Padding[64 - sizeof(std::atomic<Uint64>)];
+    };
+    HitCounter m_HitCounters[NumHitCounters];
 };
 
 } // namespace Diligent
@@ -32,6 +32,7 @@
 
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
@@ -55,15 +56,57 @@ public:
     GenerateMipsVkHelper& operator = (      GenerateMipsVkHelper&&) = delete;
     // clang-format on
 
-    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB);
-    void CreateSRB(IShaderResourceBinding** ppSRB);
-    void WarmUpCache(TEXTURE_FORMAT Fmt);
+    // The maximum number of mip levels that single-pass mip generation can produce
+    static constexpr Uint32 MaxSPDMips = 12;
+    // The maximum number of array slices processed by single-pass mip generation
+    static constexpr Uint32 MaxSPDArraySlices = 2048;
+
+    // Resources that are used by one device context
+    struct ContextResources
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        RefCntAutoPtr<IShaderResourceBinding> pSPDSRB;
+        // Counters of thread groups that have finished every array slice
+        RefCntAutoPtr<IBuffer> pSPDCounter;
+
+        struct SPDBatchItem
+        {
+            TextureViewVkImpl* pTexView;
+            IPipelineState*    pPSO;
+            RESOURCE_STATE     OriginalState;
+            VkImageLayout      OriginalLayout;
+        };
+        // Views processed by single-pass mip generation. The array is reused to avoid allocations.
+        std::vector<SPDBatchItem> SPDBatch;
+    };
+
+    void GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, ContextResources& Resources);
+    void GenerateMips(ITextureView* ppTexViews[], Uint32 NumViews, DeviceContextVkImpl& Ctx, ContextResources& Resources);
+    void CreateContextResources(ContextResources& Resources);
+
+    // Adds the number of created PSOs and the size of the counter buffers to Stats
+    void GetStatistics(DeviceHelperStatistics& Stats);
 
 private:
     std::array<RefCntAutoPtr<IPipelineState>, 4>  CreatePSOs(TEXTURE_FORMAT Fmt);
     std::array<RefCntAutoPtr<IPipelineState>, 4>& FindPSOs(TEXTURE_FORMAT Fmt);
 
+    RefCntAutoPtr<IPipelineState> CreateSPDPSO(TEXTURE_FORMAT Fmt);
+    IPipelineState*               FindSPDPSO(TEXTURE_FORMAT Fmt);
+    // Returns null if single-pass mip generation can't be used for the view
+    IPipelineState* FindSPDPSO(const TextureViewVkImpl& TexView, const ContextResources& Resources);
+
+    static VkImageSubresourceRange GetSubresourceRange(const TextureViewVkImpl& TexView);
+    static void                    RestoreLayout(TextureViewVkImpl&       TexView,
+                                                 DeviceContextVkImpl&     Ctx,
+                                                 VkImageLayout            AffectedMipLevelLayout,
+                                                 VkImageLayout            OriginalLayout,
+                                                 VkImageSubresourceRange& SubresRange);
+
+    void          GenerateMipsMultiPass(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, ContextResources& Resources);
     VkImageLayout GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange);
+    // Generates mips for all views in Resources.SPDBatch
+    void          GenerateMipsSPD(DeviceContextVkImpl& Ctx, ContextResources& Resources);
     VkImageLayout GenerateMipsBlit(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, VkImageSubresourceRange& SubresRange) const;
 
 #if !DILIGENT_NO_GLSLANG
@@ -72,6 +115,10 @@ private:
 
     std::mutex                                                                       m_PSOMutex;
     std::unordered_map<TEXTURE_FORMAT, std::array<RefCntAutoPtr<IPipelineState>, 4>> m_PSOHash;
+    // Null PSOs are stored for formats that single-pass mip generation does not support
+    std::unordered_map<TEXTURE_FORMAT, RefCntAutoPtr<IPipelineState>> m_SPDPSOHash;
+    // The total size of the SPD counter buffers of all contexts, protected by m_PSOMutex
+    Uint64 m_SPDCounterBuffersSize = 0;
 
     static void GetGlImageFormat(const TextureFormatAttribs& FmtAttribs, std::array<char, 16>& GlFmt);
 
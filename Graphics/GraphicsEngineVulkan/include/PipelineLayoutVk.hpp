@@ -59,6 +59,38 @@ public:
         return m_FirstDescrSetIndex[Index];
     }
 
+    static constexpr Uint32 InvalidDescrSetIndex = 0xFF;
+
+    // Returns the index of the bindless heap descriptor set, or InvalidDescrSetIndex
+    // if none of the signatures uses the bindless heap
+    Uint32 GetBindlessDescrSetIndex() const { return m_BindlessDescrSetIndex; }
+
+    static constexpr Uint32 InvalidSignatureIndex = 0xFF;
+
+    // Returns the binding index of the resource signature whose dynamic descriptor set
+    // uses push descriptors, or InvalidSignatureIndex if there is no such signature
+    Uint32 GetPushDescrSetSignatureIndex() const { return m_PushDescrSetSignatureIndex; }
+
+    // Returns the shader stages of the push constant range that holds inline constants,
+    // or 0 if none of the signatures defines inline constants
+    VkShaderStageFlags GetPushConstantStages() const { return m_PushConstantStages; }
+
+    // Returns the size of the push constant range in bytes
+    Uint32 GetPushConstantSize() const { return m_PushConstantSize; }
+
+    // Returns the hash of the layout definition. Layouts created from compatible signatures
+    // with the same binding indices have equal hashes.
+    size_t GetHash() const { return m_Hash; }
+
+    // Returns the hash of the descriptor set layouts of signatures [0, Index] and of the push constant range.
+    // Descriptor sets of the signature at the given index that were bound with one pipeline layout remain
+    // valid for another layout with the same hash (14.2.2, Pipeline Layout Compatibility).
+    size_t GetSetCompatibilityHash(Uint32 Index) const
+    {
+        VERIFY_EXPR(Index < MAX_RESOURCE_SIGNATURES);
+        return m_SetCompatibilityHashes[Index];
+    }
+
 private:
     VulkanUtilities::PipelineLayoutWrapper m_VkPipelineLayout;
 
@@ -70,6 +102,20 @@ private:
     // (Maximum is MAX_RESOURCE_SIGNATURES * 2)
     Uint8 m_DescrSetCount = 0;
 
+    // The bindless heap set always goes after the sets of all signatures
+    Uint8 m_BindlessDescrSetIndex = InvalidDescrSetIndex;
+
+    // Binding index of the signature whose dynamic set is a push descriptor set
+    Uint8 m_PushDescrSetSignatureIndex = InvalidSignatureIndex;
+
+    // Inline constants are mapped to a single push constant range at offset 0
+    VkShaderStageFlags m_PushConstantStages = 0;
+    Uint32             m_PushConstantSize   = 0;
+
+    size_t m_Hash = 0;
+
+    std::array<size_t, MAX_RESOURCE_SIGNATURES> m_SetCompatibilityHashes = {};
+
 #ifdef DILIGENT_DEBUG
     Uint32 m_DbgMaxBindIndex = 0;
 #endif
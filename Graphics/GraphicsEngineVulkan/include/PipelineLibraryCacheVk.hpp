@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineLibraryCacheVk class
+
+#include <array>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "BasicTypes.h"
+#include "HashUtils.hpp"
+#include "VulkanUtilities/VulkanObjectWrappers.hpp"
+
+namespace Diligent
+{
+
+class RenderDeviceVkImpl;
+
+/// Cache of graphics pipeline libraries (VK_EXT_graphics_pipeline_library).
+
+/// A graphics pipeline is split into four parts: vertex input interface, pre-rasterization shaders,
+/// fragment shader and fragment output interface. Every part is compiled into a pipeline library
+/// that is cached independently, so that pipelines that share, for example, the same vertex shader
+/// or the same blend state only compile it once. A complete pipeline is then linked from the libraries,
+/// which is much faster than compiling a monolithic pipeline.
+///
+/// Libraries are identified by the state they are created from, so libraries created by different
+/// pipeline state objects are interchangeable. Libraries are never removed from the cache until
+/// the device is destroyed.
+class PipelineLibraryCacheVk
+{
+public:
+    enum LIBRARY_TYPE : Uint8
+    {
+        LIBRARY_TYPE_VERTEX_INPUT = 0,
+        LIBRARY_TYPE_PRE_RASTERIZATION,
+        LIBRARY_TYPE_FRAGMENT_SHADER,
+        LIBRARY_TYPE_FRAGMENT_OUTPUT,
+        LIBRARY_TYPE_COUNT
+    };
+
+    struct LibrarySet
+    {
+        std::array<VkPipeline, LIBRARY_TYPE_COUNT> Libraries{};
+
+        // Create flags that must be used by the pipelines linked from the libraries
+        VkPipelineCreateFlags Flags = 0;
+    };
+
+    PipelineLibraryCacheVk(RenderDeviceVkImpl& DeviceVk) noexcept;
+
+    // clang-format off
+    PipelineLibraryCacheVk             (const PipelineLibraryCacheVk&) = delete;
+    PipelineLibraryCacheVk             (PipelineLibraryCacheVk&&)      = delete;
+    PipelineLibraryCacheVk& operator = (const PipelineLibraryCacheVk&) = delete;
+    PipelineLibraryCacheVk& operator = (PipelineLibraryCacheVk&&)      = delete;
+    // clang-format on
+
+    ~PipelineLibraryCacheVk();
+
+    /// Finds or creates the libraries for all parts of the graphics pipeline.
+
+    /// \param [in] PipelineCI  - Create info of the complete graphics pipeline.
+    /// \param [in] StageSPIRVs - SPIRV byte code of every shader stage in PipelineCI.pStages.
+    ///                           Shader modules are created per pipeline state, so the byte code
+    ///                           rather than the module handle identifies the shader.
+    /// \param [in] LayoutHash  - Hash of the pipeline layout, see PipelineLayoutVk::GetHash().
+    ///                           Libraries may be linked with any identically defined layout.
+    /// \param [in] vkPSOCache  - Vulkan pipeline cache.
+    /// \param [in] Name        - Debug name.
+    LibrarySet GetLibraries(const VkGraphicsPipelineCreateInfo&               PipelineCI,
+                              const std::vector<const std::vector<uint32_t>*>& StageSPIRVs,
+                              size_t                                           LayoutHash,
+                              VkPipelineCache                                  vkPSOCache,
+                              const char*                                      Name);
+
+    /// Links the libraries into a complete graphics pipeline.
+
+    /// \param [in] Libraries  - Libraries returned by GetLibraries().
+    /// \param [in] vkLayout   - Pipeline layout.
+    /// \param [in] Optimize   - Whether to perform link time optimization. Optimized linking
+    ///                          produces a pipeline that is as fast as a monolithic one, but takes
+    ///                          about as long as compiling the monolithic pipeline.
+    /// \param [in] vkPSOCache - Vulkan pipeline cache.
+    /// \param [in] Name       - Debug name.
+    VulkanUtilities::PipelineWrapper LinkPipeline(const LibrarySet& Libraries,
+                                                  VkPipelineLayout  vkLayout,
+                                                  bool              Optimize,
+                                                  VkPipelineCache   vkPSOCache,
+                                                  const char*       Name) const;
+
+    /// Serialized state that a library is created from
+    struct LibraryKey
+    {
+        std::vector<Uint8> Data;
+
+        template <typename... ArgsType>
+        void Add(const ArgsType&... Args)
+        {
+            using expander = int[];
+            (void)expander{0, (AddValue(Args), 0)...};
+        }
+
+        void AddBytes(const void* pData, size_t Size);
+
+        bool operator==(const LibraryKey& rhs) const
+        {
+            return GetHash() == rhs.GetHash() && Data == rhs.Data;
+        }
+
+        size_t GetHash() const
+        {
+            if (Hash == 0)
+                Hash = ComputeHashRaw(Data.data(), Data.size());
+            return Hash;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const LibraryKey& Key) const
+            {
+                return Key.GetHash();
+            }
+        };
+
+    private:
+        template <typename T>
+        void AddValue(const T& Value)
+        {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+                          "Only scalar values can be added to the key as structures may contain padding");
+            AddBytes(&Value, sizeof(Value));
+        }
+
+        mutable size_t Hash = 0;
+    };
+
+private:
+    VkPipeline GetLibrary(LIBRARY_TYPE                        Type,
+                          LibraryKey&&                        Key,
+                          const VkGraphicsPipelineCreateInfo& LibraryCI,
+                          VkPipelineCache                     vkPSOCache,
+                          const char*                         Name);
+
+    RenderDeviceVkImpl& m_DeviceVkImpl;
+
+    using LibraryMapType = std::unordered_map<LibraryKey, VulkanUtilities::PipelineWrapper, LibraryKey::Hasher>;
+
+    // The mutex only protects the maps. Libraries are created without holding the lock,
+    // so that threads that create different pipelines do not wait for each other.
+    std::mutex                                     m_Mtx;
+    std::array<LibraryMapType, LIBRARY_TYPE_COUNT> m_Libraries;
+};
+
+} // namespace Diligent
@@ -31,6 +31,7 @@
 /// Declaration of Diligent::PipelineResourceSignatureVkImpl class
 
 #include <array>
+#include <vector>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineResourceSignatureBase.hpp"
@@ -45,6 +46,11 @@
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "SRBMemoryAllocator.hpp"
 
+namespace VulkanUtilities
+{
+class VulkanCommandBuffer;
+}
+
 namespace Diligent
 {
 
@@ -108,14 +114,108 @@ public:
 
     bool HasDescriptorSet(DESCRIPTOR_SET_ID SetId) const { return m_VkDescrSetLayouts[SetId] != VK_NULL_HANDLE; }
 
-    void InitSRBResourceCache(ShaderResourceCacheVk& ResourceCache);
+    // The maximum number of descriptors in a dynamic set that may be pushed with vkCmdPushDescriptorSetKHR
+    static constexpr Uint32 MaxPushDescriptorCount = 32;
+
+    // Returns true if the dynamic descriptor set is small enough to be written with push descriptors.
+    // In this case, the signature also has an alternative push descriptor set layout for the dynamic set.
+    bool SupportsPushDescriptors() const { return m_VkPushDescrSetLayout != VK_NULL_HANDLE; }
+
+    VkDescriptorSetLayout GetVkPushDescriptorSetLayout() const { return m_VkPushDescrSetLayout; }
+
+    // Returns true if the descriptor sets of this signature live in descriptor buffers rather than
+    // in descriptor pools (see EngineVkCreateInfo::DescriptorBufferSize).
+    bool UsesDescriptorBuffer() const { return m_UsesDescriptorBuffer; }
+
+    // Returns the size of the descriptor set data in the descriptor buffer
+    Uint32 GetDescriptorBufferSetSize(DESCRIPTOR_SET_ID SetId) const
+    {
+        VERIFY_EXPR(m_UsesDescriptorBuffer);
+        return m_DescriptorBufferSetSizes[SetId];
+    }
+
+    // Returns true if the set data must be written to the dynamic heap every time the SRB is committed.
+    // This is the case for the dynamic set and for the static/mutable set that contains dynamic buffers.
+    bool IsTransientDescriptorBufferSet(DESCRIPTOR_SET_ID SetId, const ShaderResourceCacheVk& ResourceCache) const
+    {
+        return SetId == DESCRIPTOR_SET_ID_DYNAMIC || ResourceCache.HasDynamicResources();
+    }
+
+    // Writes the descriptor buffer data of the given set to pDst. For the static/mutable set, the persistent
+    // data is copied and only descriptors of buffers with dynamic offsets are rewritten; for the dynamic set,
+    // all descriptors are written.
+    void WriteDescriptorBufferSet(DESCRIPTOR_SET_ID            SetId,
+                                  const ShaderResourceCacheVk& ResourceCache,
+                                  Uint8*                       pDst,
+                                  DeviceContextIndex           CtxId,
+                                  DeviceContextVkImpl*         pCtx) const;
+
+    // Returns true if the signature has resources that live in the bindless descriptor heap
+    bool UsesBindlessHeap() const { return m_UsesBindlessHeap; }
+
+    bool IsBindlessHeapResource(Uint32 ResIndex) const
+    {
+        return (GetResourceDesc(ResIndex).Flags & PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP) != 0;
+    }
+
+    bool IsInlineConstantsResource(Uint32 ResIndex) const
+    {
+        return (GetResourceDesc(ResIndex).Flags & PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS) != 0;
+    }
+
+    // Returns true if the resource has no descriptor in the signature's descriptor sets and takes
+    // no space in the resource caches (bindless heap resources and inline constants).
+    bool IsOutOfSetResource(Uint32 ResIndex) const
+    {
+        return (GetResourceDesc(ResIndex).Flags & (PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP | PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS)) != 0;
+    }
+
+    static constexpr Uint32 InvalidResourceIndex = ~0u;
+
+    // Returns the index of the inline constants resource, or InvalidResourceIndex if there is none.
+    // Inline constants are mapped to the push constant range of the pipeline layout.
+    Uint32 GetInlineConstantsResourceIndex() const { return m_InlineConstantsResIndex; }
+
+    // Initializes the SRB resource cache. If pStaticMutableSetAllocation is not null, the cache takes
+    // the preallocated static/mutable descriptor set instead of allocating a new one.
+    void InitSRBResourceCache(ShaderResourceCacheVk&   ResourceCache,
+                              DescriptorSetAllocation* pStaticMutableSetAllocation = nullptr);
 
     // Copies static resources from the static resource cache to the destination cache
     void CopyStaticResources(ShaderResourceCacheVk& ResourceCache) const;
 
-    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet
-    void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                VkDescriptorSet              vkDynamicDescriptorSet) const;
+    // Creates NumSRBs SRBs and allocates static/mutable descriptor sets for all of them at once
+    void CreateSRBBatch(Uint32 NumSRBs, RefCntAutoPtr<ShaderResourceBindingVkImpl>* pSRBs);
+
+    // Copies static resources to NumCaches caches and writes descriptors to all
+    // static/mutable descriptor sets with a single vkUpdateDescriptorSets call
+    void CopyStaticResourcesBatch(Uint32 NumCaches, ShaderResourceCacheVk* const* ppCaches) const;
+
+    // Commits dynamic resources from ResourceCache to vkDynamicDescriptorSet.
+    // If the signature has a descriptor update template for the dynamic set, all descriptors are
+    // written with a single vkUpdateDescriptorSetWithTemplate call, and TemplateData is used as
+    // the scratch space for the template data.
+    // Captures the descriptor info of all dynamic resources in ResourceCache. Data is laid out as resources
+    // in the cache and is consumed by PushDynamicResources() and WriteDynamicDescriptorSet().
+    void PrepareDynamicDescriptorData(const ShaderResourceCacheVk&                             ResourceCache,
+                                      std::vector<ShaderResourceCacheVk::DescriptorWriteInfo>& Data) const;
+
+    // Pushes dynamic resources captured by PrepareDynamicDescriptorData() to the dynamic set with the given index.
+    // The signature must support push descriptors.
+    void PushDynamicResources(VulkanUtilities::VulkanCommandBuffer&             CmdBuffer,
+                              VkPipelineBindPoint                               BindPoint,
+                              VkPipelineLayout                                  vkLayout,
+                              Uint32                                            SetIndex,
+                              const ShaderResourceCacheVk::DescriptorWriteInfo* pData) const;
+
+    // Writes dynamic resources captured by PrepareDynamicDescriptorData() to vkDynamicDescriptorSet.
+    // The signature must support push descriptors.
+    void WriteDynamicDescriptorSet(VkDescriptorSet                                   vkDynamicDescriptorSet,
+                                   const ShaderResourceCacheVk::DescriptorWriteInfo* pData) const;
+
+    void CommitDynamicResources(const ShaderResourceCacheVk&                             ResourceCache,
+                                VkDescriptorSet                                          vkDynamicDescriptorSet,
+                                std::vector<ShaderResourceCacheVk::DescriptorWriteInfo>& TemplateData) const;
 
 #ifdef DILIGENT_DEVELOPMENT
     /// Verifies committed resource using the SPIRV resource attributes from the PSO.
@@ -157,6 +257,16 @@ private:
     void Destruct();
 
     void CreateSetLayouts();
+    void CreateDynamicSetUpdateTemplate();
+
+    // Writes descriptors of separate immutable samplers of the set in descriptor buffer mode
+    void WriteImmutableSamplerDescriptors(DESCRIPTOR_SET_ID SetId, Uint8* pDst) const;
+
+    // Initializes one VkWriteDescriptorSet per dynamic descriptor from the data prepared by PrepareDynamicDescriptorData().
+    // Returns the number of writes; pWrites must have space for at least MaxPushDescriptorCount elements.
+    Uint32 GetDynamicDescriptorWrites(VkDescriptorSet                                   vkSet,
+                                      const ShaderResourceCacheVk::DescriptorWriteInfo* pData,
+                                      VkWriteDescriptorSet*                             pWrites) const;
 
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
@@ -164,6 +274,14 @@ private:
 private:
     std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
 
+    // Descriptor update template that writes all dynamic resources from the SRB resource cache
+    // (null if the device does not support descriptor update templates).
+    VulkanUtilities::DescrUpdateTemplateWrapper m_VkDynamicSetUpdateTemplate;
+
+    // Push descriptor version of the dynamic set layout (null if the dynamic set can't be pushed).
+    // A pipeline layout may have only one push descriptor set, see PipelineLayoutVk.
+    VulkanUtilities::DescriptorSetLayoutWrapper m_VkPushDescrSetLayout;
+
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
@@ -174,6 +292,17 @@ private:
     // accounting for array size.
     Uint16 m_DynamicStorageBufferCount = 0;
 
+    bool m_UsesBindlessHeap = false;
+
+    bool m_UsesDescriptorBuffer = false;
+
+    // Descriptor buffer set sizes and binding locations indexed by DESCRIPTOR_SET_ID (descriptor buffer mode only).
+    // Bindings are indexed by the binding index in the set layout.
+    std::array<Uint32, DESCRIPTOR_SET_ID_NUM_SETS>                                                      m_DescriptorBufferSetSizes = {};
+    std::array<std::vector<ShaderResourceCacheVk::DescriptorBufferBinding>, DESCRIPTOR_SET_ID_NUM_SETS> m_DescriptorBufferBindings;
+
+    Uint32 m_InlineConstantsResIndex = InvalidResourceIndex;
+
     ImmutableSamplerAttribs* m_ImmutableSamplers = nullptr; // [m_Desc.NumImmutableSamplers]
 };
 
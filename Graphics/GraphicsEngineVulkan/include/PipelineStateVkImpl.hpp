@@ -31,7 +31,10 @@
 /// Declaration of Diligent::PipelineStateVkImpl class
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include "EngineVkImplTraits.hpp"
 #include "PipelineStateBase.hpp"
@@ -41,6 +44,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "SRBMemoryAllocator.hpp"
 #include "PipelineLayoutVk.hpp"
+#include "PipelineLibraryCacheVk.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
@@ -64,10 +68,19 @@ public:
     virtual IRenderPassVk* DILIGENT_CALL_TYPE GetRenderPass() const override final { return GetRenderPassPtr().RawPtr<IRenderPassVk>(); }
 
     /// Implementation of IPipelineStateVk::GetVkPipeline().
-    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final { return m_Pipeline; }
+    virtual VkPipeline DILIGENT_CALL_TYPE GetVkPipeline() const override final
+    {
+        // Once the optimized pipeline has been linked in the background, it replaces the fast-linked one
+        if (m_pOptimizedLink && m_pOptimizedLink->Ready.load(std::memory_order_acquire))
+            return m_pOptimizedLink->Pipeline;
+        return m_Pipeline;
+    }
 
     const PipelineLayoutVk& GetPipelineLayout() const { return m_PipelineLayout; }
 
+    // Exchanges the shader objects with another compatible pipeline, see IPipelineState::SwapShaders().
+    void SwapShaderObjects(PipelineStateVkImpl& Other);
+
     static RenderPassDesc GetImplicitRenderPassDesc(Uint32                                                        NumRenderTargets,
                                                     const TEXTURE_FORMAT                                          RTVFormats[],
                                                     TEXTURE_FORMAT                                                DSVFormat,
@@ -96,6 +109,16 @@ public:
     };
     using TShaderStages = std::vector<ShaderStageInfo>;
 
+    // Specialization constant data of a single shader module.
+    // The data must be kept alive until the pipeline is created.
+    struct ShaderSpecializationInfo
+    {
+        std::vector<VkSpecializationMapEntry> MapEntries;
+        std::vector<Uint8>                    Data;
+        VkSpecializationInfo                  Info{};
+    };
+    using TShaderSpecializations = std::vector<ShaderSpecializationInfo>;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Performs validation of SRB resource parameters that are not possible to validate
     // when resource is bound.
@@ -109,7 +132,12 @@ private:
     template <typename PSOCreateInfoType>
     TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
                                       std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules);
+                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
+                                      TShaderSpecializations&                            Specializations);
+
+    void InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo);
+    void InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo);
+    void InitializeRayTracingPipeline(const RayTracingPipelineStateCreateInfo& CreateInfo);
 
     void InitPipelineLayout(TShaderStages& ShaderStages);
 
@@ -117,9 +145,40 @@ private:
 
     void Destruct();
 
+    // Links the optimized pipeline from the libraries on the asynchronous task pool
+    void EnqueueOptimizedLink(const PipelineLibraryCacheVk::LibrarySet& Libraries, IPipelineStateCache* pPSOCache);
+
+    // Cancels the optimized link if it has not started yet, or waits until it is complete
+    void FinishOptimizedLink();
+
     VulkanUtilities::PipelineWrapper m_Pipeline;
     PipelineLayoutVk                 m_PipelineLayout;
 
+    // State of the optimized pipeline that is linked from graphics pipeline libraries in the background.
+    // The state is shared with the link task, so the task never accesses the pipeline state object
+    // after the link is complete or cancelled.
+    struct OptimizedPipelineLink
+    {
+        enum class STATUS : Uint8
+        {
+            Pending,
+            Running,
+            Complete,
+            Cancelled
+        };
+        std::mutex              Mtx;
+        std::condition_variable CompleteCV;
+        STATUS                  Status = STATUS::Pending;
+
+        // Keeps the pipeline state cache alive until the link is finished
+        RefCntAutoPtr<IPipelineStateCache> pPSOCache;
+
+        // Set when Pipeline may be used by the device contexts
+        std::atomic<bool>                Ready{false};
+        VulkanUtilities::PipelineWrapper Pipeline;
+    };
+    std::shared_ptr<OptimizedPipelineLink> m_pOptimizedLink;
+
 #ifdef DILIGENT_DEVELOPMENT
     // Shader resources for all shaders in all shader stages
     std::vector<std::shared_ptr<const SPIRVShaderResources>> m_ShaderResources;
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Query.h"
+#include "GraphicsTypes.h"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
@@ -74,10 +75,15 @@ public:
 
     Uint32 ResetStaleQueries(VulkanUtilities::VulkanCommandBuffer& CmdBuff);
 
+    // Adds the number of created query pools and queries to Stats
+    void GetStatistics(DeviceHelperStatistics& Stats);
+
 private:
     struct QueryHeapInfo
     {
         VulkanUtilities::QueryPoolWrapper vkQueryPool;
+        // Query pools are created when the first query of the type is allocated
+        VkQueryPoolCreateInfo vkPoolCI{};
 
         std::vector<Uint32> AvailableQueries;
         std::vector<Uint32> StaleQueries;
@@ -86,6 +92,11 @@ private:
         Uint32 MaxAllocatedQueries = 0;
     };
 
+    void CreateQueryPool(QueryHeapInfo& HeapInfo);
+
+    RenderDeviceVkImpl* const m_pRenderDeviceVk;
+    const SoftwareQueueIndex  m_CmdQueueInd;
+
     std::mutex                                      m_HeapMutex;
     std::array<QueryHeapInfo, QUERY_TYPE_NUM_TYPES> m_Heaps;
 
@@ -30,6 +30,7 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -46,12 +47,17 @@
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 #include "DescriptorPoolManager.hpp"
+#include "BindlessDescriptorHeapVk.hpp"
+#include "DescriptorBufferVk.hpp"
+#include "PipelineLibraryCacheVk.hpp"
 #include "VulkanDynamicHeap.hpp"
 #include "VulkanUploadHeap.hpp"
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
+#include "ShaderCache.hpp"
+#include "VulkanTypeConversions.hpp"
 
 namespace Diligent
 {
@@ -142,6 +148,17 @@ public:
                                          IPipelineResourceSignature**         ppSignature,
                                          bool                                 IsDeviceInternal);
 
+    /// Implementation of IRenderDevice::CreatePipelineStateCache() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                             IPipelineStateCache**               ppPSOCache) override final;
+
+    /// Implementation of IRenderDevice::CreateResourceHeap() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CreateResourceHeap(const ResourceHeapDesc& Desc,
+                                                       IResourceHeap**         ppHeap) override final;
+
+    void CreatePlacedTexture(const TextureDesc& TexDesc, ResourceHeapVkImpl* pHeap, Uint64 Offset, ITexture** ppTexture);
+    void CreatePlacedBuffer(const BufferDesc& BuffDesc, ResourceHeapVkImpl* pHeap, Uint64 Offset, IBuffer** ppBuffer);
+
     /// Implementation of IRenderDeviceVk::GetVkDevice().
     virtual VkDevice DILIGENT_CALL_TYPE GetVkDevice() override final { return m_LogicalVkDevice->GetVkDevice(); }
 
@@ -183,9 +200,36 @@ public:
                                                                   const FenceDesc& Desc,
                                                                   IFence**         ppFence) override final;
 
+    /// Implementation of IRenderDeviceVk::GetPipelineStateCache().
+    virtual IPipelineStateCache* DILIGENT_CALL_TYPE GetPipelineStateCache() override final { return m_pDefaultPSOCache; }
+
+    /// Implementation of IRenderDeviceVk::GetFramebufferCacheStatistics().
+    virtual void DILIGENT_CALL_TYPE GetFramebufferCacheStatistics(FramebufferCacheStatistics& Stats) override final
+    {
+        m_FramebufferCache.GetStatistics(Stats);
+    }
+
+    /// Implementation of IRenderDeviceVk::GetDynamicHeapStatistics().
+    virtual void DILIGENT_CALL_TYPE GetDynamicHeapStatistics(DynamicHeapStatistics& Stats) override final
+    {
+        m_DynamicMemoryManager.GetStatistics(Stats);
+    }
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
+    /// Implementation of IRenderDevice::GetMemoryStatistics() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetMemoryStatistics(RenderDeviceMemoryStatistics& Stats) override final;
+
+    /// Implementation of IRenderDevice::SetMemoryAllocationCallback() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetMemoryAllocationCallback(MemoryAllocationCallbackType Callback, void* pUserData) override final
+    {
+        m_MemoryMgr.SetAllocationCallback(Callback, pUserData);
+    }
+
+    /// Implementation of IRenderDevice::CaptureResourceSnapshot() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects) override final;
+
     // pImmediateCtx parameter is only used to make sure the command buffer is submitted from the immediate context
     // The method returns fence value associated with the submitted command buffer
     Uint64 ExecuteCommandBuffer(SoftwareQueueIndex CommandQueueId, const VkSubmitInfo& SubmitInfo, std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pSignalFences);
@@ -194,7 +238,39 @@ public:
                                   VulkanUtilities::CommandPoolWrapper& CmdPool,
                                   VkCommandBuffer&                     vkCmdBuff,
                                   const Char*                          DebugPoolName = nullptr);
-    void ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex CommandQueueId, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
+    // Submits the transient command buffer to the queue and returns the fence value associated with it
+    Uint64 ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex CommandQueueId, VkCommandBuffer vkCmdBuff, VulkanUtilities::CommandPoolWrapper&& CmdPool);
+
+    // Records commands that copy initial data of a buffer or a texture from the staging buffer
+    // into the shared transient command buffer of the given queue. Handler is called with the
+    // command buffer while the batch is locked. The staging buffer and its memory are owned by
+    // the batch and are released when the GPU completes it.
+    // The batch is submitted when it becomes large enough, before any command buffer is submitted
+    // through a device context and by IdleGPU().
+    template <typename HandlerType>
+    void RecordInitialDataUpload(SoftwareQueueIndex                        CommandQueueId,
+                                 VulkanUtilities::BufferWrapper&&          StagingBuffer,
+                                 VulkanUtilities::VulkanMemoryAllocation&& StagingMemory,
+                                 HandlerType&&                             Handler)
+    {
+        VERIFY_EXPR(CommandQueueId < GetCommandQueueCount());
+        auto& Batch = m_InitialDataUploads[CommandQueueId];
+
+        std::lock_guard<std::mutex> Lock{Batch.Mtx};
+        if (Batch.vkCmdBuff == VK_NULL_HANDLE)
+            AllocateTransientCmdPool(CommandQueueId, Batch.CmdPool, Batch.vkCmdBuff, "Transient command pool to copy initial data to device resources");
+
+        Handler(Batch.vkCmdBuff);
+
+        Batch.StagingSize += StagingMemory.Size;
+        Batch.Staging.Buffers.emplace_back(std::move(StagingBuffer));
+        Batch.Staging.Memory.emplace_back(std::move(StagingMemory));
+        if (++Batch.NumUploads >= MaxInitialDataUploadsPerBatch || Batch.StagingSize >= MaxInitialDataUploadBatchSize)
+            SubmitInitialDataUploads(CommandQueueId, Batch);
+    }
+
+    // Submits all pending initial data uploads
+    void FlushInitialDataUploads();
 
     /// Implementation of IRenderDevice::ReleaseStaleResources() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final;
@@ -203,35 +279,92 @@ public:
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
     }
+    void AllocateDescriptorSets(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, Uint32 NumSets, DescriptorSetAllocation* pAllocations, const char* DebugName = "")
+    {
+        m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, NumSets, pAllocations, DebugName);
+    }
     DescriptorPoolManager& GetDynamicDescriptorPool() { return m_DynamicDescriptorPool; }
 
+    // Returns the bindless descriptor heap or null if the heap is disabled
+    BindlessDescriptorHeapVk* GetBindlessHeap() const { return m_pBindlessHeap.get(); }
+
+    // Returns the global descriptor buffer, or null if descriptor buffers are not used
+    DescriptorBufferVk* GetDescriptorBuffer() const { return m_pDescriptorBuffer.get(); }
+
+    // Returns the graphics pipeline library cache, or null if VK_EXT_graphics_pipeline_library is not supported
+    PipelineLibraryCacheVk* GetPipelineLibraryCache() const { return m_pPipelineLibraryCache.get(); }
+
     std::shared_ptr<const VulkanUtilities::VulkanInstance> GetVulkanInstance() const { return m_VulkanInstance; }
 
     const VulkanUtilities::VulkanPhysicalDevice& GetPhysicalDevice() const { return *m_PhysicalDevice; }
-    const VulkanUtilities::VulkanLogicalDevice&  GetLogicalDevice() { return *m_LogicalVkDevice; }
+    const VulkanUtilities::VulkanLogicalDevice&  GetLogicalDevice() const { return *m_LogicalVkDevice; }
 
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
+    // Returns true if implicit render passes defined by SetRenderTargets() are implemented with
+    // dynamic rendering (VK_KHR_dynamic_rendering) rather than with render pass and framebuffer objects.
+    bool UseDynamicRendering() const { return m_UseDynamicRendering; }
+
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements&                     MemReqs,
+                                                           VkMemoryPropertyFlags                           MemoryProperties,
+                                                           VkMemoryAllocateFlags                           AllocateFlags     = 0,
+                                                           const VulkanUtilities::VulkanDedicatedResource& DedicatedResource = {},
+                                                           uint32_t                                        DeviceMask        = 0,
+                                                           MEMORY_PRIORITY                                 Priority          = MEMORY_PRIORITY_DEFAULT)
     {
-        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
+        return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags, DedicatedResource, DeviceMask, MemoryPriorityToVkMemoryPriority(Priority));
     }
-    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, VkMemoryAllocateFlags AllocateFlags = 0)
+    VulkanUtilities::VulkanMemoryAllocation AllocateMemory(VkDeviceSize                                    Size,
+                                                           VkDeviceSize                                    Alignment,
+                                                           uint32_t                                        MemoryTypeIndex,
+                                                           VkMemoryAllocateFlags                           AllocateFlags     = 0,
+                                                           const VulkanUtilities::VulkanDedicatedResource& DedicatedResource = {},
+                                                           uint32_t                                        DeviceMask        = 0,
+                                                           MEMORY_PRIORITY                                 Priority          = MEMORY_PRIORITY_DEFAULT)
     {
         const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
         VERIFY_EXPR(MemoryTypeIndex < MemoryProps.memoryTypeCount);
         const auto MemoryFlags = MemoryProps.memoryTypes[MemoryTypeIndex].propertyFlags;
-        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags);
+        return m_MemoryMgr.Allocate(Size, Alignment, MemoryTypeIndex, (MemoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0, AllocateFlags, DedicatedResource, DeviceMask, MemoryPriorityToVkMemoryPriority(Priority));
     }
+
+    // Returns the device mask of the physical devices that execute the commands of the immediate
+    // contexts in ImmediateContextMask (see ImmediateContextCreateInfo::NodeMask).
+    // Returns 0 if the device was not created over a device group or if the contexts use all devices,
+    // in which case the memory is allocated on every device.
+    uint32_t GetMemoryDeviceMask(Uint64 ImmediateContextMask) const;
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
+    Uint32 GetMemoryDefragmentationBudget() const { return m_MemoryDefragmentationBudget; }
+
+    // Returns the memory type for the CPU-written data of the dynamic heap and the upload heaps.
+    // Device-local host-visible memory is preferred while its usage, including Size bytes, stays within
+    // EngineVkCreateInfo::DeviceLocalUploadMemoryBudget. Otherwise, host-visible coherent memory is selected.
+    uint32_t GetUploadMemoryTypeIndex(uint32_t MemoryTypeBits, VkDeviceSize Size);
+
+    // Relocatable buffers are the buffers whose memory may be moved by DefragmentMemory(), see BufferVkImpl::IsRelocatable().
+    void RegisterRelocatableBuffer(BufferVkImpl& Buffer);
+    void UnregisterRelocatableBuffer(BufferVkImpl& Buffer);
+
+    // Moves the memory of relocatable buffers used by the immediate context Ctx from sparsely occupied
+    // memory pages into denser ones, up to EngineVkCreateInfo::MemoryDefragmentationBudget bytes.
+    // The copy commands are recorded into the context. Returns the total size of relocated buffers.
+    VkDeviceSize DefragmentMemory(DeviceContextVkImpl& Ctx);
+
     void FlushStaleResources(SoftwareQueueIndex CmdQueueIndex);
 
     IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
 
+    // Returns the compiled shader cache or null if the cache is disabled
+    ShaderCache* GetShaderCache() const { return m_pShaderCache.get(); }
+
+    // Returns the pipeline cache that should be used to create a pipeline:
+    // the cache from the create info, if any, and the device's default cache otherwise.
+    VkPipelineCache GetVkPipelineCache(IPipelineStateCache* pPSOCache) const;
+
     struct Properties
     {
         const Uint32 ShaderGroupHandleSize;
@@ -263,25 +396,73 @@ private:
                              Uint64&                                                     SubmittedFenceValue,
                              std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pFences);
 
+    // Staging resources of the initial data uploads recorded into one batch
+    struct InitialDataStagingResources
+    {
+        // Buffers are destroyed before the memory they are bound to
+        std::vector<VulkanUtilities::VulkanMemoryAllocation> Memory;
+        std::vector<VulkanUtilities::BufferWrapper>          Buffers;
+    };
+
+    struct InitialDataUploadBatch
+    {
+        std::mutex Mtx;
+
+        VulkanUtilities::CommandPoolWrapper CmdPool;
+        VkCommandBuffer                     vkCmdBuff   = VK_NULL_HANDLE;
+        Uint32                              NumUploads  = 0;
+        VkDeviceSize                        StagingSize = 0;
+        InitialDataStagingResources         Staging;
+    };
+
+    // The batch mutex must be locked by the caller
+    void SubmitInitialDataUploads(SoftwareQueueIndex CommandQueueId, InitialDataUploadBatch& Batch);
+
+    static constexpr Uint32       MaxInitialDataUploadsPerBatch = 256;
+    static constexpr VkDeviceSize MaxInitialDataUploadBatchSize = VkDeviceSize{64} << 20;
+
     std::shared_ptr<VulkanUtilities::VulkanInstance>       m_VulkanInstance;
     std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> m_PhysicalDevice;
     std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  m_LogicalVkDevice;
 
+    // Node masks of the immediate contexts, see ImmediateContextCreateInfo::NodeMask
+    std::vector<Uint32> m_ContextNodeMasks;
+
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_ImplicitRenderPassCache;
+    bool                   m_UseDynamicRendering = false;
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
-    // These one-time command pools are used by buffer and texture constructors to
-    // issue copy commands. Vulkan requires that every command pool is used by one thread
-    // at a time, so every constructor must allocate command buffer from its own pool.
+    std::unique_ptr<BindlessDescriptorHeapVk> m_pBindlessHeap;
+    std::unique_ptr<DescriptorBufferVk>       m_pDescriptorBuffer;
+    std::unique_ptr<PipelineLibraryCacheVk>   m_pPipelineLibraryCache;
+
+    // These one-time command pools are used by initial data upload batches and other
+    // transient command buffers. Vulkan requires that every command pool is used by one thread
+    // at a time, so every batch must allocate command buffer from its own pool.
     std::unordered_map<HardwareQueueIndex, CommandPoolManager, HardwareQueueIndex::Hasher> m_TransientCmdPoolMgrs;
 
+    // Pending initial data uploads, one batch per software command queue
+    std::unique_ptr<InitialDataUploadBatch[]> m_InitialDataUploads;
+
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
+    const Uint32 m_MemoryDefragmentationBudget;
+    const Uint32 m_DeviceLocalUploadMemoryBudget;
+
+    std::mutex                 m_RelocatableBuffersMtx;
+    std::vector<BufferVkImpl*> m_RelocatableBuffers;
+    size_t                     m_NextRelocatableBuffer = 0;
+
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
+
+    std::unique_ptr<ShaderCache> m_pShaderCache;
+
+    // Default pipeline cache shared by all pipelines that do not specify a cache explicitly
+    RefCntAutoPtr<IPipelineStateCacheVk> m_pDefaultPSOCache;
 };
 
 } // namespace Diligent
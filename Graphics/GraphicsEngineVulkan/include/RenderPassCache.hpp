@@ -30,12 +30,13 @@
 /// \file
 /// Declaration of Diligent::RenderPassCache class
 
-#include <unordered_map>
 #include <mutex>
 
 #include "GraphicsTypes.h"
 #include "Constants.h"
 #include "HashUtils.hpp"
+#include "ReadMostlyHashMap.hpp"
+#include "FlatHashMap.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "RefCntAutoPtr.hpp"
 
@@ -127,6 +128,9 @@ public:
 
     RenderPassVkImpl* GetRenderPass(const RenderPassCacheKey& Key);
 
+    // Returns the number of render passes in the cache
+    Uint32 GetSize();
+
     void Destroy();
 
 private:
@@ -140,8 +144,12 @@ private:
 
     RenderDeviceVkImpl& m_DeviceVkImpl;
 
+    // The mutex protects m_Cache and serializes modifications of m_Lookup
     std::mutex                                                                                      m_Mutex;
-    std::unordered_map<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
+    FlatHashMap<RenderPassCacheKey, RefCntAutoPtr<RenderPassVkImpl>, RenderPassCacheKeyHash> m_Cache;
+
+    // Lock-free lookup table for the render passes owned by m_Cache
+    ReadMostlyHashMap<RenderPassCacheKey, RenderPassVkImpl*, RenderPassCacheKeyHash> m_Lookup;
 };
 
 } // namespace Diligent
@@ -50,8 +50,11 @@ class ShaderResourceBindingVkImpl final : public ShaderResourceBindingBase<Engin
 public:
     using TBase = ShaderResourceBindingBase<EngineVkImplTraits>;
 
+    /// \param pStaticMutableSetAllocation - Optional preallocated static/mutable descriptor set, see
+    ///                                      PipelineResourceSignatureVkImpl::InitSRBResourceCache().
     ShaderResourceBindingVkImpl(IReferenceCounters*              pRefCounters,
-                                PipelineResourceSignatureVkImpl* pPRS);
+                                PipelineResourceSignatureVkImpl* pPRS,
+                                DescriptorSetAllocation*         pStaticMutableSetAllocation = nullptr);
     ~ShaderResourceBindingVkImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderResourceBindingVk, TBase)
@@ -61,6 +61,7 @@
 #include "BufferVkImpl.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "PipelineResourceAttribsVk.hpp"
+#include "DescriptorBufferVk.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 
 namespace Diligent
@@ -93,6 +94,29 @@ public:
     void InitializeSets(IMemoryAllocator& MemAllocator, Uint32 NumSets, const Uint32* SetSizes);
     void InitializeResources(Uint32 Set, Uint32 Offset, Uint32 ArraySize, DescriptorType Type, bool HasImmutableSampler);
 
+    // Storage for the descriptor info referenced by VkWriteDescriptorSet
+    union DescriptorWriteInfo
+    {
+        VkDescriptorImageInfo                        ImageInfo;
+        VkDescriptorBufferInfo                       BufferInfo;
+        VkBufferView                                 BufferView;
+        VkWriteDescriptorSetAccelerationStructureKHR AccelStructInfo;
+        VkAccelerationStructureKHR                   AccelStruct; // Used by descriptor update templates
+    };
+
+    // Location of a descriptor set layout binding in the descriptor buffer (see EngineVkCreateInfo::DescriptorBufferSize)
+    struct DescriptorBufferBinding
+    {
+        Uint32           Offset    = 0; // Offset of the first array element from the start of the set
+        Uint32           Stride    = 0; // Descriptor size
+        Uint32           ArraySize = 0;
+        VkDescriptorType Type      = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+
+        // Immutable samplers are not applied by the layout in descriptor buffer mode
+        // and must be written together with the descriptor.
+        VkSampler ImmutableSampler = VK_NULL_HANDLE;
+    };
+
     // sizeof(Resource) == 24 (x64, msvc, Release)
     struct Resource
     {
@@ -129,13 +153,25 @@ public:
         VkWriteDescriptorSetAccelerationStructureKHR GetAccelerationStructureWriteInfo() const;
         // clang-format on
 
+        // Initializes the descriptor type and info of WriteDescrSet. The info is stored in WriteInfo
+        // that must stay alive until the descriptor set is updated.
+        void GetDescriptorWriteInfo(VkWriteDescriptorSet& WriteDescrSet, DescriptorWriteInfo& WriteInfo) const;
+
+        // Writes the descriptor data to pDst in the descriptor buffer. CtxId and pCtx are only
+        // used to get the offsets of dynamic buffers and may be null for other resources.
+        void WriteDescriptorBufferData(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                       const DescriptorBufferBinding&              Binding,
+                                       void*                                       pDst,
+                                       DeviceContextIndex                          CtxId,
+                                       DeviceContextVkImpl*                        pCtx) const;
+
         void SetUniformBuffer(RefCntAutoPtr<IDeviceObject>&& _pBuffer, Uint32 _RangeOffset, Uint32 _RangeSize);
         void SetStorageBuffer(RefCntAutoPtr<IDeviceObject>&& _pBufferView);
 
         bool IsNull() const { return pObject == nullptr; }
     };
 
-    // sizeof(DescriptorSet) == 48 (x64, msvc, Release)
+    // sizeof(DescriptorSet) == 96 (x64, msvc, Release)
     class DescriptorSet
     {
     public:
@@ -164,12 +200,32 @@ public:
             return m_DescriptorSetAllocation.GetVkDescriptorSet();
         }
 
+        // Returns the persistent descriptor buffer data of the set, or null if the set does not use descriptor buffers
+        Uint8* GetDescriptorBufferCPUAddress() const
+        {
+            return static_cast<Uint8*>(m_DescriptorBufferAllocation.GetCPUAddress());
+        }
+
+        // Returns the offset of the set data in the global descriptor buffer
+        VkDeviceSize GetDescriptorBufferOffset() const
+        {
+            return m_DescriptorBufferAllocation.GetOffset();
+        }
+
+        const DescriptorBufferBinding& GetDescriptorBufferBinding(Uint32 BindingIndex) const
+        {
+            VERIFY_EXPR(m_pDescrBufferBindings != nullptr);
+            return m_pDescrBufferBindings[BindingIndex];
+        }
+
         // clang-format off
 /* 0 */ const Uint32 m_NumResources = 0;
     private:
 /* 8 */ Resource* const m_pResources = nullptr;
 /*16 */ DescriptorSetAllocation m_DescriptorSetAllocation;
-/*48 */ // End of structure
+/*48 */ DescriptorBufferAllocation m_DescriptorBufferAllocation;
+/*88 */ const DescriptorBufferBinding* m_pDescrBufferBindings = nullptr; // Indexed by the binding index
+/*96 */ // End of structure
         // clang-format on
 
     private:
@@ -195,6 +251,18 @@ public:
         DescrSet.m_DescriptorSetAllocation = std::move(Allocation);
     }
 
+    // Assigns the descriptor buffer space and the binding locations of the set in descriptor buffer mode.
+    // Bindings must stay alive as long as the cache.
+    void AssignDescriptorBufferAllocation(Uint32 SetIndex, DescriptorBufferAllocation&& Allocation, const DescriptorBufferBinding* pBindings)
+    {
+        auto& DescrSet = GetDescriptorSet(SetIndex);
+        VERIFY(DescrSet.GetSize() > 0, "Descriptor set is empty");
+        VERIFY(!DescrSet.m_DescriptorBufferAllocation, "Descriptor buffer alloction has already been initialized");
+        VERIFY_EXPR(pBindings != nullptr);
+        DescrSet.m_DescriptorBufferAllocation = std::move(Allocation);
+        DescrSet.m_pDescrBufferBindings       = pBindings;
+    }
+
     struct SetResourceInfo
     {
         const Uint32 BindingIndex = 0;
@@ -224,7 +292,9 @@ public:
         {
         }
     };
-    // Sets the resource at the given descriptor set index and offset
+    // Sets the resource at the given descriptor set index and offset.
+    // If pLogicalDevice is null, the descriptor is not written to the Vulkan descriptor set
+    // and the caller is responsible for updating it.
     const Resource& SetResource(const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
                                 Uint32                                      DescrSetIndex,
                                 Uint32                                      CacheOffset,
@@ -255,7 +325,12 @@ public:
     template <bool VerifyOnly>
     void TransitionResources(DeviceContextVkImpl* pCtxVkImpl);
 
-    __forceinline Uint32 GetDynamicBufferOffsets(DeviceContextIndex CtxId, DeviceContextVkImpl* pCtxVkImpl, std::vector<uint32_t>& Offsets) const;
+    // Writes the dynamic offsets of all descriptor sets to Offsets and returns the total number of offsets.
+    // If pSetOffsetCounts is not null, the number of offsets of every descriptor set is written to it.
+    __forceinline Uint32 GetDynamicBufferOffsets(DeviceContextIndex     CtxId,
+                                                 DeviceContextVkImpl*   pCtxVkImpl,
+                                                 std::vector<uint32_t>& Offsets,
+                                                 Uint32*                pSetOffsetCounts = nullptr) const;
 
 private:
     Resource* GetFirstResourcePtr()
@@ -293,7 +368,8 @@ private:
 
 __forceinline Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContextIndex     CtxId,
                                                                     DeviceContextVkImpl*   pCtxVkImpl,
-                                                                    std::vector<uint32_t>& Offsets) const
+                                                                    std::vector<uint32_t>& Offsets,
+                                                                    Uint32*                pSetOffsetCounts) const
 {
     // If any of the sets being bound include dynamic uniform or storage buffers, then
     // pDynamicOffsets includes one element for each array element in each dynamic descriptor
@@ -309,8 +385,9 @@ __forceinline Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContex
     Uint32 OffsetInd = 0;
     for (Uint32 set = 0; set < m_NumSets; ++set)
     {
-        const auto& DescrSet = GetDescriptorSet(set);
-        const auto  SetSize  = DescrSet.GetSize();
+        const auto& DescrSet       = GetDescriptorSet(set);
+        const auto  SetSize        = DescrSet.GetSize();
+        const auto  FirstOffsetInd = OffsetInd;
 
         Uint32 res = 0;
         while (res < SetSize)
@@ -359,6 +436,9 @@ __forceinline Uint32 ShaderResourceCacheVk::GetDynamicBufferOffsets(DeviceContex
                    "All dynamic uniform and storage buffers are expected to go first in the beginning of each descriptor set");
         }
 #endif
+
+        if (pSetOffsetCounts != nullptr)
+            pSetOffsetCounts[set] = OffsetInd - FirstOffsetInd;
     }
     return OffsetInd;
 }
@@ -57,6 +57,13 @@ public:
     /// Implementation of IShader::GetResource() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
+    /// Implementation of IShader::GetBytecode() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE GetBytecode(const void** ppBytecode, Uint64& Size) const override final
+    {
+        *ppBytecode = m_SPIRV.data();
+        Size        = m_SPIRV.size() * sizeof(m_SPIRV[0]);
+    }
+
     /// Implementation of IShaderVk::GetSPIRV().
     virtual const std::vector<uint32_t>& DILIGENT_CALL_TYPE GetSPIRV() const override final
     {
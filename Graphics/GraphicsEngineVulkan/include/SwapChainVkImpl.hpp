@@ -67,6 +67,12 @@ public:
     /// Implementation of ISwapChain::SetWindowedMode() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE SetWindowedMode() override final;
 
+    /// Implementation of ISwapChain::SetMaximumFrameLatency() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE SetMaximumFrameLatency(Uint32 MaxLatency) override final;
+
+    /// Implementation of ISwapChain::WaitForFrame() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE WaitForFrame() override final;
+
     /// Implementation of ISwapChainVk::GetVkSwapChain().
     virtual VkSwapchainKHR DILIGENT_CALL_TYPE GetVkSwapChain() override final { return m_VkSwapChain; }
 
@@ -124,6 +130,15 @@ private:
     uint32_t m_BackBufferIndex = 0;
     bool     m_IsMinimized     = false;
     bool     m_VSyncEnabled    = true;
+
+    // The maximum number of frames that may be queued for presentation, see SetMaximumFrameLatency()
+    Uint32 m_MaxFrameLatency = 0;
+
+    // Id of the last presented frame (VK_KHR_present_id). Ids are reset when the swap chain is recreated.
+    Uint64 m_LastPresentId = 0;
+
+    // Whether WaitForFrame() has been called since the last Present()
+    bool m_FrameWaited = false;
 };
 
 } // namespace Diligent
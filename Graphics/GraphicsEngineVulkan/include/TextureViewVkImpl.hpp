@@ -33,6 +33,7 @@
 #include "EngineVkImplTraits.hpp"
 #include "TextureViewBase.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "BindlessDescriptorHeapVk.hpp"
 
 namespace Diligent
 {
@@ -86,6 +87,9 @@ protected:
 
     /// Individual mip level views used for mipmap generation
     MipLevelViewAutoPtrType* m_MipLevelViews = nullptr;
+
+    /// Binding of the view descriptor in the bindless heap
+    BindlessDescriptorHeapVk::BINDING m_BindlessBinding = BindlessDescriptorHeapVk::BINDING_UNKNOWN;
 };
 
 } // namespace Diligent
@@ -50,7 +50,9 @@ public:
                   FixedBlockMemoryAllocator& TexViewObjAllocator,
                   RenderDeviceVkImpl*        pDeviceVk,
                   const TextureDesc&         TexDesc,
-                  const TextureData*         pInitData = nullptr);
+                  const TextureData*         pInitData  = nullptr,
+                  class ResourceHeapVkImpl*  pHeap      = nullptr,
+                  Uint64                     HeapOffset = 0);
 
     // Attaches to an existing Vk resource
     TextureVkImpl(IReferenceCounters*        pRefCounters,
@@ -95,6 +97,21 @@ public:
 
     void InvalidateStagingRange(VkDeviceSize Offset, VkDeviceSize Size);
 
+    // Initializes the image create info for the given texture description.
+    // QueueFamilyIndices provides the storage for the pQueueFamilyIndices member of the returned structure.
+    static VkImageCreateInfo GetImageCreateInfo(const RenderDeviceVkImpl* pDevice,
+                                                const TextureDesc&        Desc,
+                                                std::vector<uint32_t>&    QueueFamilyIndices,
+                                                bool*                     pCSBasedMipGenerationSupported = nullptr);
+
+    // Returns the offset of the mip tail of the given array slice in the opaque
+    // memory range of a sparse image, see UpdateTileMappings().
+    VkDeviceSize GetSparseMipTailOffset(Uint32 ArraySlice) const
+    {
+        VERIFY_EXPR((m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0);
+        return m_SparseMipTailOffset + m_SparseMipTailStride * ArraySlice;
+    }
+
     // Buffer offset must be a multiple of 4 (18.4)
     static constexpr Uint32 StagingBufferOffsetAlignment = 4;
 
@@ -102,13 +119,16 @@ protected:
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
     //void PrepareVkInitData(const TextureData &InitData, Uint32 NumSubresources, std::vector<Vk_SUBRESOURCE_DATA> &VkInitData);
 
-    bool CheckCSBasedMipGenerationSupport(VkFormat vkFmt) const;
+    static bool CheckCSBasedMipGenerationSupport(const TextureDesc&                           Desc,
+                                                 const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice,
+                                                 VkFormat                                     vkFmt);
 
     void InitializeTextureContent(const TextureData&          InitData,
                                   const TextureFormatAttribs& FmtAttribs,
                                   const VkImageCreateInfo&    ImageCI);
     void CreateStagingTexture(const TextureData*          pInitData,
                               const TextureFormatAttribs& FmtAttribs);
+    void InitSparseProperties();
 
     VulkanUtilities::ImageViewWrapper CreateImageView(TextureViewDesc& ViewDesc);
 
@@ -117,6 +137,16 @@ protected:
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset;
     bool                                    m_bCSBasedMipGenerationSupported = false;
+
+    // Whether the initial data copy was recorded into the device's upload batch
+    bool m_bInitialDataUploadRecorded = false;
+
+    // Resource heap the texture is placed in, if any
+    RefCntAutoPtr<IResourceHeap> m_pHeap;
+
+    // Mip tail location of a sparse image. The stride is zero when all array slices share one mip tail.
+    VkDeviceSize m_SparseMipTailOffset = 0;
+    VkDeviceSize m_SparseMipTailStride = 0;
 };
 
 } // namespace Diligent
@@ -28,10 +28,12 @@
 #pragma once
 
 #include <mutex>
+#include <atomic>
 #include "VulkanUtilities/VulkanHeaders.h"
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "GraphicsTypes.h"
 #include "DynamicHeap.hpp"
 
 namespace Diligent
@@ -137,19 +139,57 @@ public:
     Uint8*   GetCPUAddress()const{return m_CPUAddress;}
     // clang-format on
 
+    // Returns the device address of the dynamic buffer. The address is only available
+    // in descriptor buffer mode, where the buffer is also bound as a descriptor buffer.
+    VkDeviceAddress GetDeviceAddress() const
+    {
+        VERIFY(m_DeviceAddress != 0, "Dynamic buffer has not been created or does not have a device address");
+        return m_DeviceAddress;
+    }
+
     void Destroy();
 
     static constexpr const Uint32 MasterBlockAlignment = 1024;
     MasterBlock                   AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment);
 
+    // Records the peak size of the frame that has just finished
+    void OnFinishFrame();
+
+    void GetStatistics(DynamicHeapStatistics& Stats);
+
+    // Returns the size of the dynamic buffer, or zero if it has not been created yet
+    Uint64 GetReservedSize() const
+    {
+        return m_VkBuffer != VK_NULL_HANDLE ? GetSize() : 0;
+    }
+
+    // Returns the size of the buffer memory if it has been placed in device-local host-visible
+    // memory (see RenderDeviceVkImpl::GetUploadMemoryTypeIndex()), and zero otherwise.
+    VkDeviceSize GetDeviceLocalSize() const
+    {
+        return m_DeviceLocalSize.load();
+    }
+
 private:
+    void CreateBuffer();
+
     RenderDeviceVkImpl&                  m_DeviceVk;
+    std::once_flag                       m_BufferCreatedFlag;
     VulkanUtilities::BufferWrapper       m_VkBuffer;
     VulkanUtilities::DeviceMemoryWrapper m_BufferMemory;
-    Uint8*                               m_CPUAddress;
+    Uint8*                               m_CPUAddress    = nullptr;
+    VkDeviceAddress                      m_DeviceAddress = 0;
+    std::atomic<VkDeviceSize>            m_DeviceLocalSize{0};
     const VkDeviceSize                   m_DefaultAlignment;
     const Uint64                         m_CommandQueueMask;
-    OffsetType                           m_TotalPeakSize = 0;
+
+    // Usage statistics, updated by multiple contexts
+    std::mutex m_StatsMtx;
+    OffsetType m_TotalPeakSize        = 0;
+    OffsetType m_FramePeakSize        = 0;
+    OffsetType m_LastFramePeakSize    = 0;
+    Uint64     m_NumFrames            = 0;
+    Uint32     m_NumFailedAllocations = 0;
 };
 
 
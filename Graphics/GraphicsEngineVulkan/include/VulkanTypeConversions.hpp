@@ -62,6 +62,8 @@ void PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(PRIMITIVE_TOPOLOGY
                                                              VkPrimitiveTopology& VkPrimTopology,
                                                              uint32_t&            PatchControlPoints);
 
+VkCullModeFlagBits   CullModeToVkCullMode(CULL_MODE CullMode);
+VkStencilOp          StencilOpToVkStencilOp(STENCIL_OP StencilOp);
 VkCompareOp          ComparisonFuncToVkCompareOp(COMPARISON_FUNCTION CmpFunc);
 VkFilter             FilterTypeToVkFilter(FILTER_TYPE FilterType);
 VkSamplerMipmapMode  FilterTypeToVkMipmapMode(FILTER_TYPE FilterType);
@@ -104,6 +106,8 @@ ADAPTER_TYPE VkPhysicalDeviceTypeToAdapterType(VkPhysicalDeviceType DeviceType);
 COMMAND_QUEUE_TYPE       VkQueueFlagsToCmdQueueType(VkQueueFlags QueueFlags);
 VkQueueGlobalPriorityEXT QueuePriorityToVkQueueGlobalPriority(QUEUE_PRIORITY Priority);
 
+float MemoryPriorityToVkMemoryPriority(MEMORY_PRIORITY Priority);
+
 DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t                                                          vkVersion,
                                           const VkPhysicalDeviceFeatures&                                   vkFeatures,
                                           const VulkanUtilities::VulkanPhysicalDevice::ExtensionFeatures&   ExtFeatures,
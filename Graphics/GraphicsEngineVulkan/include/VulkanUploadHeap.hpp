@@ -28,8 +28,10 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "IndexWrapper.hpp"
 
 namespace Diligent
 {
@@ -39,6 +41,9 @@ namespace Diligent
 //
 // The heap allocates pages from the global memory manager.
 // The pages are released and returned to the manager at the end of every frame.
+// When all pages were used by a single command queue, up to MaxRetainedSize bytes of them
+// are instead retained by the heap and reused once the GPU has finished the command buffers
+// that referenced them. This avoids re-creating large staging buffers every frame.
 //
 //   _______________________________________________________________________________________________________________________________
 //  |                                                                                                                               |
@@ -89,7 +94,8 @@ class VulkanUploadHeap
 public:
     VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
                      std::string         HeapName,
-                     VkDeviceSize        PageSize);
+                     VkDeviceSize        PageSize,
+                     VkDeviceSize        MaxRetainedSize = 0);
 
     // clang-format off
     VulkanUploadHeap            (const VulkanUploadHeap&)  = delete;
@@ -105,6 +111,8 @@ public:
     // Releases all allocated pages that are later returned to the global memory manager by the release queues.
     // As global memory manager is hosted by the render device, the upload heap can be destroyed before the
     // pages are actually returned to the manager.
+    // If CmdQueueMask contains a single queue, the pages that fit into the retained size budget are kept
+    // for reuse. All command buffers that use the pages must have been submitted at this point.
     void ReleaseAllocatedPages(Uint64 CmdQueueMask);
 
     size_t GetStalePagesCount() const
@@ -116,26 +124,52 @@ private:
     RenderDeviceVkImpl& m_RenderDevice;
     std::string         m_HeapName;
     const VkDeviceSize  m_PageSize;
+    const VkDeviceSize  m_MaxRetainedSize;
 
     struct UploadPageInfo
     {
         // clang-format off
         UploadPageInfo(VulkanUtilities::VulkanMemoryAllocation&& _MemAllocation, 
                        VulkanUtilities::BufferWrapper&&          _Buffer,
-                       Uint8*                                    _CPUAddress) :
+                       Uint8*                                    _CPUAddress,
+                       VkDeviceSize                              _Size) :
             MemAllocation{std::move(_MemAllocation)},
             Buffer       {std::move(_Buffer)       },
-            CPUAddress   {_CPUAddress              }
+            CPUAddress   {_CPUAddress              },
+            Size         {_Size                    }
         {
         }
         // clang-format on
 
         VulkanUtilities::VulkanMemoryAllocation MemAllocation;
         VulkanUtilities::BufferWrapper          Buffer;
-        Uint8* const                            CPUAddress = nullptr;
+        Uint8*                                  CPUAddress = nullptr;
+        VkDeviceSize                            Size       = 0; // Buffer size
     };
     std::vector<UploadPageInfo> m_Pages;
 
+    struct RetainedPageInfo
+    {
+        // clang-format off
+        RetainedPageInfo(UploadPageInfo&&   _Page,
+                         SoftwareQueueIndex _QueueId,
+                         Uint64             _FenceValue) :
+            Page      {std::move(_Page)},
+            QueueId   {_QueueId        },
+            FenceValue{_FenceValue     }
+        {
+        }
+        // clang-format on
+
+        UploadPageInfo     Page;
+        SoftwareQueueIndex QueueId;
+        // The page can be reused when this fence value is completed by the queue
+        Uint64 FenceValue = 0;
+    };
+    // Released pages that are kept for reuse
+    std::vector<RetainedPageInfo> m_RetainedPages;
+    VkDeviceSize                  m_RetainedSize = 0;
+
     struct CurrPageInfo
     {
         VkBuffer     vkBuffer       = VK_NULL_HANDLE;
@@ -165,6 +199,10 @@ private:
     VkDeviceSize m_PeakAllocatedSize = 0;
 
     UploadPageInfo CreateNewPage(VkDeviceSize SizeInBytes) const;
+
+    // Returns the smallest retained page of at least SizeInBytes bytes that is no longer used
+    // by the GPU, or creates a new page if there is no such page.
+    UploadPageInfo AcquirePage(VkDeviceSize SizeInBytes);
 };
 
 } // namespace Diligent
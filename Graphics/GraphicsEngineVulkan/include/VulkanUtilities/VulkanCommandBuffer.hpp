@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "VulkanHeaders.h"
 #include "DebugUtilities.hpp"
 
@@ -51,7 +53,8 @@ public:
                                        const VkImageSubresourceRange& Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearColorImage() must be called outside of render pass (17.1)");
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "vkCmdClearColorImage() must be called outside of render pass (17.1)");
         VERIFY(Subresource.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT, "The aspectMask of all image subresource ranges must only include VK_IMAGE_ASPECT_COLOR_BIT (17.1)");
 
         vkCmdClearColorImage(
@@ -68,7 +71,8 @@ public:
                                               const VkImageSubresourceRange&  Subresource)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "vkCmdClearDepthStencilImage() must be called outside of render pass (17.1)");
         // clang-format off
         VERIFY((Subresource.aspectMask &  (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0 &&
                (Subresource.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) == 0,
@@ -87,7 +91,7 @@ public:
     __forceinline void ClearAttachment(const VkClearAttachment& Attachment, const VkClearRect& ClearRect)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdClearAttachments() must be called inside render pass (17.2)");
+        VERIFY(IsInsideRenderPass(), "vkCmdClearAttachments() must be called inside render pass (17.2)");
 
         vkCmdClearAttachments(
             m_VkCmdBuffer,
@@ -102,7 +106,7 @@ public:
     __forceinline void Draw(uint32_t VertexCount, uint32_t InstanceCount, uint32_t FirstVertex, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDraw() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDraw() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDraw(m_VkCmdBuffer, VertexCount, InstanceCount, FirstVertex, FirstInstance);
@@ -111,7 +115,7 @@ public:
     __forceinline void DrawIndexed(uint32_t IndexCount, uint32_t InstanceCount, uint32_t FirstIndex, int32_t VertexOffset, uint32_t FirstInstance)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndexed() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndexed() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
@@ -121,7 +125,7 @@ public:
     __forceinline void DrawIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -130,18 +134,45 @@ public:
     __forceinline void DrawIndexedIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawIndirect() must be called inside render pass (19.3)");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirect() must be called inside render pass (19.3)");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
         VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
 
         vkCmdDrawIndexedIndirect(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
     }
 
+    __forceinline void DrawIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+
+        vkCmdDrawIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+#else
+        UNSUPPORTED("DrawIndirectCount is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void DrawIndexedIndirectCount(VkBuffer Buffer, VkDeviceSize Offset, VkBuffer CountBuffer, VkDeviceSize CountBufferOffset, uint32_t MaxDrawCount, uint32_t Stride)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawIndexedIndirectCountKHR() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+
+        vkCmdDrawIndexedIndirectCountKHR(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
+#else
+        UNSUPPORTED("DrawIndexedIndirectCount is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void DrawMesh(uint32_t TaskCount, uint32_t FirstTask)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksNV(m_VkCmdBuffer, TaskCount, FirstTask);
@@ -154,7 +185,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksNV() must be called inside render pass");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawMeshTasksNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectNV(m_VkCmdBuffer, Buffer, Offset, DrawCount, Stride);
@@ -167,7 +198,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMeshTasksIndirectCountNV() must be called inside render pass");
+        VERIFY(IsInsideRenderPass(), "vkCmdDrawMeshTasksIndirectCountNV() must be called inside render pass");
         VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
 
         vkCmdDrawMeshTasksIndirectCountNV(m_VkCmdBuffer, Buffer, Offset, CountBuffer, CountBufferOffset, MaxDrawCount, Stride);
@@ -179,7 +210,8 @@ public:
     __forceinline void Dispatch(uint32_t GroupCountX, uint32_t GroupCountY, uint32_t GroupCountZ)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatch() must be called outside of render pass (27)");
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "vkCmdDispatch() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         vkCmdDispatch(m_VkCmdBuffer, GroupCountX, GroupCountY, GroupCountZ);
@@ -188,7 +220,8 @@ public:
     __forceinline void DispatchIndirect(VkBuffer Buffer, VkDeviceSize Offset)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "vkCmdDispatchIndirect() must be called outside of render pass (27)");
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "vkCmdDispatchIndirect() must be called outside of render pass (27)");
         VERIFY(m_State.ComputePipeline != VK_NULL_HANDLE, "No compute pipeline bound");
 
         vkCmdDispatchIndirect(m_VkCmdBuffer, Buffer, Offset);
@@ -199,10 +232,12 @@ public:
                                        uint32_t            FramebufferWidth,
                                        uint32_t            FramebufferHeight,
                                        uint32_t            ClearValueCount = 0,
-                                       const VkClearValue* pClearValues    = nullptr)
+                                       const VkClearValue* pClearValues    = nullptr,
+                                       VkSubpassContents   Contents        = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        VERIFY(m_State.RenderPass == VK_NULL_HANDLE, "Current pass has not been ended");
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "Current pass has not been ended");
 
         if (m_State.RenderPass != RenderPass || m_State.Framebuffer != Framebuffer)
         {
@@ -221,11 +256,11 @@ public:
                                                       // corresponding to cleared attachments are used. Other elements of pClearValues are
                                                       // ignored (7.4)
 
-            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo,
-                                 VK_SUBPASS_CONTENTS_INLINE // the contents of the subpass will be recorded inline in the
-                                                            // primary command buffer, and secondary command buffers must not
-                                                            // be executed within the subpass
-            );
+            // VK_SUBPASS_CONTENTS_INLINE - the contents of the subpass will be recorded inline in the primary command
+            //                              buffer, and secondary command buffers must not be executed within the subpass.
+            // VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS - the contents are recorded in secondary command buffers,
+            //                              and vkCmdExecuteCommands is the only valid command in the subpass (7.4)
+            vkCmdBeginRenderPass(m_VkCmdBuffer, &BeginInfo, Contents);
             m_State.RenderPass        = RenderPass;
             m_State.Framebuffer       = Framebuffer;
             m_State.FramebufferWidth  = FramebufferWidth;
@@ -233,11 +268,30 @@ public:
         }
     }
 
+    // Begins a dynamic rendering instance (VK_KHR_dynamic_rendering) that does not require
+    // render pass and framebuffer objects. The instance is ended by EndRenderPass().
+    __forceinline void BeginRendering(const VkRenderingInfoKHR& RenderingInfo)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
+        VERIFY(!IsInsideRenderPass(), "Current pass has not been ended");
+
+        vkCmdBeginRenderingKHR(m_VkCmdBuffer, &RenderingInfo);
+        m_State.DynamicRendering  = true;
+        m_State.FramebufferWidth  = RenderingInfo.renderArea.extent.width;
+        m_State.FramebufferHeight = RenderingInfo.renderArea.extent.height;
+    }
+
+    // Ends the active render pass or dynamic rendering instance
     __forceinline void EndRenderPass()
     {
-        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
+        VERIFY(IsInsideRenderPass(), "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdEndRenderPass(m_VkCmdBuffer);
+        if (m_State.DynamicRendering)
+            vkCmdEndRenderingKHR(m_VkCmdBuffer);
+        else
+            vkCmdEndRenderPass(m_VkCmdBuffer);
+        m_State.DynamicRendering  = false;
         m_State.RenderPass        = VK_NULL_HANDLE;
         m_State.Framebuffer       = VK_NULL_HANDLE;
         m_State.FramebufferWidth  = 0;
@@ -251,21 +305,56 @@ public:
         }
     }
 
-    __forceinline void NextSubpass()
+    __forceinline void NextSubpass(VkSubpassContents Contents = VK_SUBPASS_CONTENTS_INLINE)
     {
         VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Render pass has not been started");
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        vkCmdNextSubpass(m_VkCmdBuffer, VK_SUBPASS_CONTENTS_INLINE);
+        vkCmdNextSubpass(m_VkCmdBuffer, Contents);
+    }
+
+    // Sets the render pass state inherited by a secondary command buffer from the primary command buffer.
+    // No commands are recorded as the render pass is begun and ended by the primary command buffer.
+    __forceinline void SetInheritedRenderPass(VkRenderPass  RenderPass,
+                                              VkFramebuffer Framebuffer,
+                                              uint32_t      FramebufferWidth,
+                                              uint32_t      FramebufferHeight)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(!IsInsideRenderPass(), "Current pass has not been ended");
+        m_State.RenderPass        = RenderPass;
+        m_State.Framebuffer       = Framebuffer;
+        m_State.FramebufferWidth  = FramebufferWidth;
+        m_State.FramebufferHeight = FramebufferHeight;
+    }
+
+    __forceinline void ExecuteCommands(uint32_t               CommandBufferCount,
+                                       const VkCommandBuffer* pCommandBuffers)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "Secondary command buffers must be executed inside a render pass");
+        VERIFY_EXPR(CommandBufferCount > 0 && pCommandBuffers != nullptr);
+        vkCmdExecuteCommands(m_VkCmdBuffer, CommandBufferCount, pCommandBuffers);
+
+        // After vkCmdExecuteCommands, all state bound in the primary command buffer becomes undefined,
+        // except for the render pass instance (6.6)
+        m_State.GraphicsPipeline   = VK_NULL_HANDLE;
+        m_State.ComputePipeline    = VK_NULL_HANDLE;
+        m_State.RayTracingPipeline = VK_NULL_HANDLE;
+        m_State.IndexBuffer        = VK_NULL_HANDLE;
+        m_State.IndexBufferOffset  = 0;
+        m_State.IndexType          = VK_INDEX_TYPE_MAX_ENUM;
     }
 
     __forceinline void EndCommandBuffer()
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkEndCommandBuffer(m_VkCmdBuffer);
     }
 
     __forceinline void Reset()
     {
+        ClearPendingBarriers();
         m_VkCmdBuffer = VK_NULL_HANDLE;
         m_State       = StateCache{};
     }
@@ -327,6 +416,44 @@ public:
         vkCmdSetBlendConstants(m_VkCmdBuffer, BlendConstants);
     }
 
+    // The following commands require VK_EXT_extended_dynamic_state
+
+    __forceinline void SetCullMode(VkCullModeFlags CullMode)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetCullModeEXT(m_VkCmdBuffer, CullMode);
+    }
+
+    __forceinline void SetDepthTestState(VkBool32 DepthTestEnable, VkBool32 DepthWriteEnable, VkCompareOp DepthCompareOp)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetDepthTestEnableEXT(m_VkCmdBuffer, DepthTestEnable);
+        vkCmdSetDepthWriteEnableEXT(m_VkCmdBuffer, DepthWriteEnable);
+        vkCmdSetDepthCompareOpEXT(m_VkCmdBuffer, DepthCompareOp);
+    }
+
+    __forceinline void SetStencilTestEnable(VkBool32 StencilTestEnable)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetStencilTestEnableEXT(m_VkCmdBuffer, StencilTestEnable);
+    }
+
+    __forceinline void SetStencilOp(VkStencilFaceFlags FaceMask,
+                                    VkStencilOp        FailOp,
+                                    VkStencilOp        PassOp,
+                                    VkStencilOp        DepthFailOp,
+                                    VkCompareOp        CompareOp)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetStencilOpEXT(m_VkCmdBuffer, FaceMask, FailOp, PassOp, DepthFailOp, CompareOp);
+    }
+
+    __forceinline void SetPrimitiveTopology(VkPrimitiveTopology Topology)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetPrimitiveTopologyEXT(m_VkCmdBuffer, Topology);
+    }
+
     __forceinline void BindIndexBuffer(VkBuffer Buffer, VkDeviceSize Offset, VkIndexType IndexType)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
@@ -358,22 +485,14 @@ public:
                                       VkPipelineStageFlags           SrcStages  = 0,
                                       VkPipelineStageFlags           DestStages = 0);
 
-    __forceinline void TransitionImageLayout(VkImage                        Image,
-                                             VkImageLayout                  OldLayout,
-                                             VkImageLayout                  NewLayout,
-                                             const VkImageSubresourceRange& SubresRange,
-                                             VkPipelineStageFlags           SrcStages  = 0,
-                                             VkPipelineStageFlags           DestStages = 0)
-    {
-        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
-        {
-            // Image layout transitions within a render pass execute
-            // dependencies between attachments
-            EndRenderPass();
-        }
-        TransitionImageLayout(m_VkCmdBuffer, Image, OldLayout, NewLayout, SubresRange, m_SupportedStagesMask, SrcStages, DestStages);
-    }
+    // Adds the barrier to the pending barrier list. All pending barriers are recorded by
+    // a single vkCmdPipelineBarrier command when the next command is recorded or FlushBarriers() is called.
+    void TransitionImageLayout(VkImage                        Image,
+                               VkImageLayout                  OldLayout,
+                               VkImageLayout                  NewLayout,
+                               const VkImageSubresourceRange& SubresRange,
+                               VkPipelineStageFlags           SrcStages  = 0,
+                               VkPipelineStageFlags           DestStages = 0);
 
 
     static void BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
@@ -384,21 +503,11 @@ public:
                                     VkPipelineStageFlags SrcStages  = 0,
                                     VkPipelineStageFlags DestStages = 0);
 
-    __forceinline void BufferMemoryBarrier(VkBuffer             Buffer,
-                                           VkAccessFlags        srcAccessMask,
-                                           VkAccessFlags        dstAccessMask,
-                                           VkPipelineStageFlags SrcStages  = 0,
-                                           VkPipelineStageFlags DestStages = 0)
-    {
-        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
-        {
-            // Image layout transitions within a render pass execute
-            // dependencies between attachments
-            EndRenderPass();
-        }
-        BufferMemoryBarrier(m_VkCmdBuffer, Buffer, srcAccessMask, dstAccessMask, m_SupportedStagesMask, SrcStages, DestStages);
-    }
+    void BufferMemoryBarrier(VkBuffer             Buffer,
+                             VkAccessFlags        srcAccessMask,
+                             VkAccessFlags        dstAccessMask,
+                             VkPipelineStageFlags SrcStages  = 0,
+                             VkPipelineStageFlags DestStages = 0);
 
 
     // for Acceleration structures
@@ -409,21 +518,31 @@ public:
                                 VkPipelineStageFlags SrcStages  = 0,
                                 VkPipelineStageFlags DestStages = 0);
 
-    __forceinline void ASMemoryBarrier(VkAccessFlags        srcAccessMask,
-                                       VkAccessFlags        dstAccessMask,
-                                       VkPipelineStageFlags SrcStages  = 0,
-                                       VkPipelineStageFlags DestStages = 0)
+    void ASMemoryBarrier(VkAccessFlags        srcAccessMask,
+                         VkAccessFlags        dstAccessMask,
+                         VkPipelineStageFlags SrcStages  = 0,
+                         VkPipelineStageFlags DestStages = 0);
+
+    // Adds a global memory barrier that applies to all resources, e.g. to
+    // resources that alias the same memory. The barrier is merged with pending barriers.
+    void GlobalMemoryBarrier(VkAccessFlags        srcAccessMask,
+                             VkAccessFlags        dstAccessMask,
+                             VkPipelineStageFlags SrcStages,
+                             VkPipelineStageFlags DestStages);
+
+    // Records the first half of a split barrier. Pending barriers are flushed first.
+    __forceinline void SetEvent(VkEvent Event, VkPipelineStageFlags StageMask)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
-        {
-            // Image layout transitions within a render pass execute
-            // dependencies between attachments
-            EndRenderPass();
-        }
-        ASMemoryBarrier(m_VkCmdBuffer, srcAccessMask, dstAccessMask, m_SupportedStagesMask, SrcStages, DestStages);
+        VERIFY(!IsInsideRenderPass(), "vkCmdSetEvent() must be called outside of render pass");
+        FlushBarriers();
+        vkCmdSetEvent(m_VkCmdBuffer, Event, StageMask & m_SupportedStagesMask);
     }
 
+    // Records all pending barriers as the second half of split barriers started with SetEvent().
+    // SrcStages must be the bitwise OR of the stage masks used to set the events.
+    void WaitEvents(uint32_t EventCount, const VkEvent* pEvents, VkPipelineStageFlags SrcStages);
+
     __forceinline void BindDescriptorSets(VkPipelineBindPoint    pipelineBindPoint,
                                           VkPipelineLayout       layout,
                                           uint32_t               firstSet,
@@ -436,13 +555,64 @@ public:
         vkCmdBindDescriptorSets(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, pDescriptorSets, dynamicOffsetCount, pDynamicOffsets);
     }
 
+    __forceinline void PushDescriptorSet(VkPipelineBindPoint         pipelineBindPoint,
+                                         VkPipelineLayout            layout,
+                                         uint32_t                    set,
+                                         uint32_t                    descriptorWriteCount,
+                                         const VkWriteDescriptorSet* pDescriptorWrites)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdPushDescriptorSetKHR(m_VkCmdBuffer, pipelineBindPoint, layout, set, descriptorWriteCount, pDescriptorWrites);
+#else
+        UNSUPPORTED("Push descriptors are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void BindDescriptorBuffers(uint32_t                                bufferCount,
+                                             const VkDescriptorBufferBindingInfoEXT* pBindingInfos)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdBindDescriptorBuffersEXT(m_VkCmdBuffer, bufferCount, pBindingInfos);
+#else
+        UNSUPPORTED("Descriptor buffers are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void SetDescriptorBufferOffsets(VkPipelineBindPoint pipelineBindPoint,
+                                                  VkPipelineLayout    layout,
+                                                  uint32_t            firstSet,
+                                                  uint32_t            setCount,
+                                                  const uint32_t*     pBufferIndices,
+                                                  const VkDeviceSize* pOffsets)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdSetDescriptorBufferOffsetsEXT(m_VkCmdBuffer, pipelineBindPoint, layout, firstSet, setCount, pBufferIndices, pOffsets);
+#else
+        UNSUPPORTED("Descriptor buffers are not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void PushConstants(VkPipelineLayout   layout,
+                                     VkShaderStageFlags stageFlags,
+                                     uint32_t           offset,
+                                     uint32_t           size,
+                                     const void*        pValues)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        vkCmdPushConstants(m_VkCmdBuffer, layout, stageFlags, offset, size, pValues);
+    }
+
     __forceinline void CopyBuffer(VkBuffer            srcBuffer,
                                   VkBuffer            dstBuffer,
                                   uint32_t            regionCount,
                                   const VkBufferCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy buffer operation must be performed outside of render pass.
             EndRenderPass();
@@ -450,6 +620,21 @@ public:
         vkCmdCopyBuffer(m_VkCmdBuffer, srcBuffer, dstBuffer, regionCount, pRegions);
     }
 
+    __forceinline void UpdateBuffer(VkBuffer     dstBuffer,
+                                    VkDeviceSize dstOffset,
+                                    VkDeviceSize dataSize,
+                                    const void*  pData)
+    {
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
+        if (IsInsideRenderPass())
+        {
+            // Update buffer operation must be performed outside of render pass.
+            EndRenderPass();
+        }
+        vkCmdUpdateBuffer(m_VkCmdBuffer, dstBuffer, dstOffset, dataSize, pData);
+    }
+
     __forceinline void CopyImage(VkImage            srcImage,
                                  VkImageLayout      srcImageLayout,
                                  VkImage            dstImage,
@@ -458,7 +643,8 @@ public:
                                  const VkImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -474,7 +660,8 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -490,7 +677,8 @@ public:
                                          const VkBufferImageCopy* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy operations must be performed outside of render pass.
             EndRenderPass();
@@ -508,7 +696,8 @@ public:
                                  VkFilter           filter)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Blit must be performed outside of render pass.
             EndRenderPass();
@@ -525,7 +714,8 @@ public:
                                     const VkImageResolve* pRegions)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Resolve must be performed outside of render pass.
             EndRenderPass();
@@ -553,8 +743,9 @@ public:
         // begin and end outside of a render pass instance (i.e. contain entire render pass instances) (17.2).
 
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdBeginQuery(m_VkCmdBuffer, queryPool, query, flags);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
             m_State.InsidePassQueries |= queryFlag;
         else
             m_State.OutsidePassQueries |= queryFlag;
@@ -565,8 +756,9 @@ public:
                                 uint32_t    queryFlag)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdEndQuery(m_VkCmdBuffer, queryPool, query);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        if (IsInsideRenderPass())
         {
             VERIFY((m_State.InsidePassQueries & queryFlag) != 0, "No active inside-pass queries found.");
             m_State.InsidePassQueries &= ~queryFlag;
@@ -583,6 +775,7 @@ public:
                                       uint32_t                query)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         vkCmdWriteTimestamp(m_VkCmdBuffer, pipelineStage, queryPool, query);
     }
 
@@ -591,7 +784,8 @@ public:
                                       uint32_t    queryCount)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Query pool reset must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -608,7 +802,8 @@ public:
                                             VkQueryResultFlags flags)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy query results must be performed outside of render pass (17.2).
             EndRenderPass();
@@ -617,13 +812,51 @@ public:
                                   dstBuffer, dstOffset, stride, flags);
     }
 
+    __forceinline void BeginConditionalRendering(VkBuffer Buffer, VkDeviceSize Offset)
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
+        if (IsInsideRenderPass())
+        {
+            // Conditional rendering that begins outside of a render pass instance must also end outside of it.
+            EndRenderPass();
+        }
+
+        VkConditionalRenderingBeginInfoEXT BeginInfo{};
+        BeginInfo.sType  = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+        BeginInfo.pNext  = nullptr;
+        BeginInfo.buffer = Buffer;
+        BeginInfo.offset = Offset;
+        BeginInfo.flags  = 0; // Commands are discarded if the 32-bit predicate value is zero
+        vkCmdBeginConditionalRenderingEXT(m_VkCmdBuffer, &BeginInfo);
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
+    __forceinline void EndConditionalRendering()
+    {
+#if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        if (IsInsideRenderPass())
+        {
+            EndRenderPass();
+        }
+        vkCmdEndConditionalRenderingEXT(m_VkCmdBuffer);
+#else
+        UNSUPPORTED("Conditional rendering is not supported when vulkan library is linked statically");
+#endif
+    }
+
     __forceinline void BuildAccelerationStructure(uint32_t                                               infoCount,
                                                   const VkAccelerationStructureBuildGeometryInfoKHR*     pInfos,
                                                   const VkAccelerationStructureBuildRangeInfoKHR* const* ppBuildRangeInfos)
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Build AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -638,7 +871,8 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Copy AS operations must be performed outside of render pass.
             EndRenderPass();
@@ -653,7 +887,8 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
-        if (m_State.RenderPass != VK_NULL_HANDLE)
+        FlushBarriers();
+        if (IsInsideRenderPass())
         {
             // Write AS properties operations must be performed outside of render pass.
             EndRenderPass();
@@ -674,6 +909,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
 
         vkCmdTraceRaysKHR(m_VkCmdBuffer, &RaygenShaderBindingTable, &MissShaderBindingTable, &HitShaderBindingTable, &CallableShaderBindingTable, width, height, depth);
@@ -690,6 +926,7 @@ public:
     {
 #if DILIGENT_USE_VOLK
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        FlushBarriers();
         VERIFY(m_State.RayTracingPipeline != VK_NULL_HANDLE, "No ray tracing pipeline bound");
 
         vkCmdTraceRaysIndirectKHR(m_VkCmdBuffer, &RaygenShaderBindingTable, &MissShaderBindingTable, &HitShaderBindingTable, &CallableShaderBindingTable, indirectDeviceAddress);
@@ -731,7 +968,14 @@ public:
 #endif
     }
 
-    void FlushBarriers();
+    // Records all pending barriers with a single vkCmdPipelineBarrier command
+    __forceinline void FlushBarriers()
+    {
+        if (m_BarrierSrcStages != 0)
+            RecordPendingBarriers();
+    }
+
+    bool HasPendingBarriers() const { return m_BarrierSrcStages != 0; }
 
     __forceinline void SetVkCmdBuffer(VkCommandBuffer VkCmdBuffer, VkPipelineStageFlags StageMask)
     {
@@ -756,14 +1000,31 @@ public:
         uint32_t      FramebufferHeight  = 0;
         uint32_t      InsidePassQueries  = 0;
         uint32_t      OutsidePassQueries = 0;
+        bool          DynamicRendering   = false;
     };
 
     const StateCache& GetState() const { return m_State; }
 
+    // Returns true if either a render pass or a dynamic rendering instance is active
+    bool IsInsideRenderPass() const
+    {
+        return m_State.RenderPass != VK_NULL_HANDLE || m_State.DynamicRendering;
+    }
+
 private:
+    void RecordPendingBarriers(uint32_t EventCount = 0, const VkEvent* pEvents = nullptr, VkPipelineStageFlags EventSrcStages = 0);
+    void ClearPendingBarriers();
+
     StateCache           m_State;
     VkCommandBuffer      m_VkCmdBuffer         = VK_NULL_HANDLE;
     VkPipelineStageFlags m_SupportedStagesMask = ~0u;
+
+    // Barriers that have not been recorded yet
+    std::vector<VkImageMemoryBarrier>  m_ImageBarriers;
+    std::vector<VkBufferMemoryBarrier> m_BufferBarriers;
+    VkMemoryBarrier                    m_MemoryBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+    VkPipelineStageFlags               m_BarrierSrcStages = 0;
+    VkPipelineStageFlags               m_BarrierDstStages = 0;
 };
 
 } // namespace VulkanUtilities
@@ -27,7 +27,7 @@
 
 #pragma once
 
-#include <deque>
+#include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -38,6 +38,12 @@
 namespace VulkanUtilities
 {
 
+// Command buffer pool owned by a single device context.
+// Command buffers are requested by the thread that records commands into the context, while they
+// are returned by release queues from arbitrary threads once the GPU has finished using them.
+// To avoid contention between the two, the recording thread takes command buffers from its own
+// free lists that require no synchronization, and only takes the lock to grab all returned buffers
+// when its free list runs out.
 class VulkanCommandBufferPool
 {
 public:
@@ -54,21 +60,45 @@ public:
 
     ~VulkanCommandBufferPool();
 
-    VkCommandBuffer GetCommandBuffer(const char* DebugName = "");
-    // The GPU must have finished with the command buffer being returned to the pool
-    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer);
+    // Returns a primary command buffer in the recording state. Must only be called by the thread that owns the pool.
+    // By default, the buffer can only be submitted once. Command buffers of reusable
+    // command lists use VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT instead.
+    VkCommandBuffer GetCommandBuffer(const char* DebugName = "", VkCommandBufferUsageFlags UsageFlags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    // Returns a secondary command buffer that continues the render pass subpass specified by the inheritance info
+    VkCommandBuffer GetSecondaryCommandBuffer(const VkCommandBufferInheritanceInfo& InheritanceInfo);
+    // The GPU must have finished with the command buffer being returned to the pool.
+    // This method is thread-safe.
+    void RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     VkPipelineStageFlags GetSupportedStagesMask() const { return m_SupportedStagesMask; }
 
 private:
+    VkCommandBuffer AllocateCommandBuffer(VkCommandBufferLevel Level);
+
     // Shared point to logical device must be defined before the command pool
     std::shared_ptr<const VulkanLogicalDevice> m_LogicalDevice;
 
     CommandPoolWrapper m_CmdPool;
 
-    std::mutex                  m_Mutex;
-    std::deque<VkCommandBuffer> m_CmdBuffers;
-    const VkPipelineStageFlags  m_SupportedStagesMask;
+    struct CmdBufferLists
+    {
+        std::vector<VkCommandBuffer> Primary;
+        std::vector<VkCommandBuffer> Secondary;
+
+        std::vector<VkCommandBuffer>& Get(VkCommandBufferLevel Level)
+        {
+            return Level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? Primary : Secondary;
+        }
+    };
+
+    // Command buffers available to the owning thread. Accessed without synchronization.
+    CmdBufferLists m_FreeCmdBuffers;
+
+    // Command buffers returned by release queues, protected by m_ReturnedCmdBuffersMtx
+    std::mutex     m_ReturnedCmdBuffersMtx;
+    CmdBufferLists m_ReturnedCmdBuffers;
+
+    const VkPipelineStageFlags m_SupportedStagesMask;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic_int32_t m_BuffCounter{0};
@@ -68,6 +68,11 @@ public:
 
     VkPhysicalDevice SelectPhysicalDevice(uint32_t AdapterId)const;
 
+    // Returns all physical devices in the device group that contains PhysicalDevice.
+    // PhysicalDevice is always the first element. If device groups are not supported
+    // by the instance, the returned array only contains PhysicalDevice.
+    std::vector<VkPhysicalDevice> GetPhysicalDeviceGroup(VkPhysicalDevice PhysicalDevice)const;
+
     VkAllocationCallbacks* GetVkAllocator() const {return m_pVkAllocator;}
     VkInstance             GetVkInstance()  const {return m_VkInstance;  }
     uint32_t               GetVersion()     const {return m_VkVersion;   } // Warning: instance version may be greater than physical device version
@@ -58,7 +58,9 @@ enum class VulkanHandleTypeId : uint32_t
     Queue,
     Event,
     QueryPool,
-    AccelerationStructureKHR
+    AccelerationStructureKHR,
+    PipelineCache,
+    DescriptorUpdateTemplate
 };
 
 template <typename VulkanObjectType, VulkanHandleTypeId>
@@ -81,8 +83,11 @@ using FramebufferWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(Framebuffer);
 using DescriptorPoolWrapper      = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorPool);
 using DescriptorSetLayoutWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorSetLayout);
 using SemaphoreWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(Semaphore);
+using EventWrapper               = DEFINE_VULKAN_OBJECT_WRAPPER(Event);
 using QueryPoolWrapper           = DEFINE_VULKAN_OBJECT_WRAPPER(QueryPool);
 using AccelStructWrapper         = DEFINE_VULKAN_OBJECT_WRAPPER(AccelerationStructureKHR);
+using PipelineCacheWrapper       = DEFINE_VULKAN_OBJECT_WRAPPER(PipelineCache);
+using DescrUpdateTemplateWrapper = DEFINE_VULKAN_OBJECT_WRAPPER(DescriptorUpdateTemplate);
 #undef DEFINE_VULKAN_OBJECT_WRAPPER
 
 class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDevice>
@@ -90,10 +95,14 @@ class VulkanLogicalDevice : public std::enable_shared_from_this<VulkanLogicalDev
 public:
     using ExtensionFeatures = VulkanPhysicalDevice::ExtensionFeatures;
 
+    // When LoadDeviceEntries is true, global Vulkan device functions are loaded directly
+    // for this device, which bypasses the loader dispatch. This must only be done when the
+    // process uses a single device.
     static std::shared_ptr<VulkanLogicalDevice> Create(const VulkanPhysicalDevice&  PhysicalDevice,
                                                        const VkDeviceCreateInfo&    DeviceCI,
                                                        const ExtensionFeatures&     EnabledExtFeatures,
-                                                       const VkAllocationCallbacks* vkAllocator);
+                                                       const VkAllocationCallbacks* vkAllocator,
+                                                       bool                         LoadDeviceEntries = true);
 
     // clang-format off
     VulkanLogicalDevice             (const VulkanLogicalDevice&) = delete;
@@ -146,11 +155,16 @@ public:
 
     SemaphoreWrapper    CreateSemaphore(const VkSemaphoreCreateInfo& SemaphoreCI, const char* DebugName = "") const;
     SemaphoreWrapper    CreateTimelineSemaphore(uint64_t InitialValue, const char* DebugName = "") const;
+    EventWrapper        CreateEvent(const VkEventCreateInfo& EventCI, const char* DebugName = "") const;
     QueryPoolWrapper    CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName = "") const;
     AccelStructWrapper  CreateAccelStruct(const VkAccelerationStructureCreateInfoKHR& CI, const char* DebugName = "") const;
+    PipelineCacheWrapper CreatePipelineCache(const VkPipelineCacheCreateInfo& CI, const char* DebugName = "") const;
+    DescrUpdateTemplateWrapper CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName = "") const;
 
     VkCommandBuffer     AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName = "") const;
     VkDescriptorSet     AllocateVkDescriptorSet(const VkDescriptorSetAllocateInfo& AllocInfo, const char* DebugName = "") const;
+    // Allocates AllocInfo.descriptorSetCount sets at once. Returns false if the pool does not have enough space.
+    bool                AllocateVkDescriptorSets(const VkDescriptorSetAllocateInfo& AllocInfo, VkDescriptorSet* pSets, const char* DebugName = "") const;
 
     void ReleaseVulkanObject(CommandPoolWrapper&&  CmdPool) const;
     void ReleaseVulkanObject(BufferWrapper&&       Buffer) const;
@@ -168,15 +182,25 @@ public:
     void ReleaseVulkanObject(DescriptorPoolWrapper&& DescriptorPool) const;
     void ReleaseVulkanObject(DescriptorSetLayoutWrapper&& DescriptorSetLayout) const;
     void ReleaseVulkanObject(SemaphoreWrapper&&     Semaphore) const;
+    void ReleaseVulkanObject(EventWrapper&&         Event) const;
     void ReleaseVulkanObject(QueryPoolWrapper&&     QueryPool) const;
     void ReleaseVulkanObject(AccelStructWrapper&&   AccelStruct) const;
+    void ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const;
+    void ReleaseVulkanObject(DescrUpdateTemplateWrapper&& DescrUpdateTemplate) const;
 
     void FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const;
     void FreeCommandBuffer(VkCommandPool Pool, VkCommandBuffer CmdBuffer) const;
 
     VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer) const;
     VkMemoryRequirements GetImageMemoryRequirements (VkImage  vkImage ) const;
+
+    // Same as above, but also reports whether the implementation prefers or requires a dedicated
+    // allocation for the resource. If VK_KHR_dedicated_allocation is not enabled, DedicatedAllocation is set to false.
+    VkMemoryRequirements GetBufferMemoryRequirements(VkBuffer vkBuffer, bool& DedicatedAllocation) const;
+    VkMemoryRequirements GetImageMemoryRequirements (VkImage  vkImage,  bool& DedicatedAllocation) const;
+    std::vector<VkSparseImageMemoryRequirements> GetImageSparseMemoryRequirements(VkImage vkImage) const;
     VkDeviceAddress      GetAccelerationStructureDeviceAddress(VkAccelerationStructureKHR AS) const;
+    VkDeviceAddress      GetBufferDeviceAddress(VkBuffer vkBuffer) const;
 
     VkResult BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
     VkResult BindImageMemory (VkImage image,   VkDeviceMemory memory, VkDeviceSize memoryOffset) const;
@@ -204,6 +228,15 @@ public:
                               uint32_t                    descriptorCopyCount,
                               const VkCopyDescriptorSet*  pDescriptorCopies) const;
 
+    void UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                         VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                         const void*                pData) const;
+
+    // VK_EXT_descriptor_buffer
+    VkDeviceSize GetDescriptorSetLayoutSize(VkDescriptorSetLayout vkLayout) const;
+    VkDeviceSize GetDescriptorSetLayoutBindingOffset(VkDescriptorSetLayout vkLayout, uint32_t Binding) const;
+    void         GetDescriptor(const VkDescriptorGetInfoEXT& DescriptorInfo, size_t DataSize, void* pDescriptor) const;
+
     VkResult ResetCommandPool(VkCommandPool           vkCmdPool,
                               VkCommandPoolResetFlags flags = 0) const;
 
@@ -226,6 +259,13 @@ public:
 
     VkResult GetRayTracingShaderGroupHandles(VkPipeline pipeline, uint32_t firstGroup, uint32_t groupCount, size_t dataSize, void* pData) const;
 
+    VkResult GetPipelineCacheData(VkPipelineCache pipelineCache, size_t* pDataSize, void* pData) const;
+
+    VkResult GetPipelineExecutableProperties(VkPipeline pipeline, uint32_t* pExecutableCount, VkPipelineExecutablePropertiesKHR* pProperties) const;
+    VkResult GetPipelineExecutableStatistics(VkPipeline pipeline, uint32_t executableIndex, uint32_t* pStatisticCount, VkPipelineExecutableStatisticKHR* pStatistics) const;
+
+    VkResult GetCalibratedTimestamps(uint32_t timestampCount, const VkCalibratedTimestampInfoEXT* pTimestampInfos, uint64_t* pTimestamps, uint64_t* pMaxDeviation) const;
+
     VkPipelineStageFlags GetSupportedStagesMask(HardwareQueueIndex QueueFamilyIndex) const { return m_SupportedStagesMask[QueueFamilyIndex]; }
 
     const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_EnabledFeatures; }
@@ -235,7 +275,8 @@ private:
     VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDevice,
                         const VkDeviceCreateInfo&    DeviceCI,
                         const ExtensionFeatures&     EnabledExtFeatures,
-                        const VkAllocationCallbacks* vkAllocator);
+                        const VkAllocationCallbacks* vkAllocator,
+                        bool                         LoadDeviceEntries);
 
     template <typename VkObjectType,
               VulkanHandleTypeId VkTypeId,
@@ -37,6 +37,7 @@
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
+#include "GraphicsTypes.h"
 #include "HashUtils.hpp"
 
 namespace VulkanUtilities
@@ -45,6 +46,16 @@ namespace VulkanUtilities
 class VulkanMemoryPage;
 class VulkanMemoryManager;
 
+// Resource that receives its own device memory object (VK_KHR_dedicated_allocation).
+// Only one of the members may be non-null.
+struct VulkanDedicatedResource
+{
+    VkImage  Image  = VK_NULL_HANDLE;
+    VkBuffer Buffer = VK_NULL_HANDLE;
+
+    bool IsValid() const { return Image != VK_NULL_HANDLE || Buffer != VK_NULL_HANDLE; }
+};
+
 struct VulkanMemoryAllocation
 {
     VulkanMemoryAllocation() noexcept {}
@@ -95,11 +106,14 @@ struct VulkanMemoryAllocation
 class VulkanMemoryPage
 {
 public:
-    VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                     VkDeviceSize          PageSize,
-                     uint32_t              MemoryTypeIndex,
-                     bool                  IsHostVisible,
-                     VkMemoryAllocateFlags AllocateFlags) noexcept;
+    VulkanMemoryPage(VulkanMemoryManager&           ParentMemoryMgr,
+                     VkDeviceSize                   PageSize,
+                     uint32_t                       MemoryTypeIndex,
+                     bool                           IsHostVisible,
+                     VkMemoryAllocateFlags          AllocateFlags,
+                     uint32_t                       DeviceMask,
+                     float                          Priority,
+                     const VulkanDedicatedResource& DedicatedResource = {}) noexcept;
     ~VulkanMemoryPage();
 
     // clang-format off
@@ -107,7 +121,11 @@ public:
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_MemoryTypeIndex {rhs.m_MemoryTypeIndex         },
+        m_Priority        {rhs.m_Priority                },
+        m_IsDedicated     {rhs.m_IsDedicated             },
+        m_IsRelocationSrc {rhs.m_IsRelocationSrc         }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -120,7 +138,11 @@ public:
     bool IsFull()  const { return m_AllocationMgr.IsFull();  }
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
+    bool         IsDedicated() const { return m_IsDedicated; }
+    uint32_t     GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+    float        GetPriority()        const { return m_Priority; }
 
+    double GetOccupancy() const { return static_cast<double>(GetUsedSize()) / static_cast<double>(GetPageSize()); }
     // clang-format on
 
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
@@ -132,6 +154,7 @@ private:
     using AllocationsMgrOffsetType = Diligent::VariableSizeAllocationsManager::OffsetType;
 
     friend struct VulkanMemoryAllocation;
+    friend class VulkanMemoryManager;
 
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
@@ -140,7 +163,11 @@ private:
     std::mutex                               m_Mutex;
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
-    void*                                    m_CPUMemory = nullptr;
+    void*                                    m_CPUMemory       = nullptr;
+    uint32_t                                 m_MemoryTypeIndex = 0;
+    float                                    m_Priority        = 0.5f;
+    bool                                     m_IsDedicated     = false; // The page holds a single dedicated allocation
+    bool                                     m_IsRelocationSrc = false; // Allocations have been relocated from this page
 };
 
 class VulkanMemoryManager
@@ -184,11 +211,24 @@ public:
         //m_CurrUsedSize      {rhs.m_CurrUsedSize},
         m_PeakUsedSize      {rhs.m_PeakUsedSize     },
         m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize},
+        m_CurrDedicatedSize {rhs.m_CurrDedicatedSize},
+        m_PeakDedicatedSize {rhs.m_PeakDedicatedSize},
+        m_DefragStats       {rhs.m_DefragStats      },
+
+        m_TypeStats         {rhs.m_TypeStats        },
+        m_HeapStats         {rhs.m_HeapStats        },
+        m_AllocationCallback{rhs.m_AllocationCallback},
+        m_pAllocationCallbackUserData{rhs.m_pAllocationCallbackUserData}
     {
         // clang-format on
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+        for (size_t i = 0; i < m_TypeUsedSize.size(); ++i)
+            m_TypeUsedSize[i].store(rhs.m_TypeUsedSize[i].load());
+        for (size_t i = 0; i < m_HeapUsedSize.size(); ++i)
+            m_HeapUsedSize[i].store(rhs.m_HeapUsedSize[i].load());
+        m_NumReleasedDedicatedPages.store(rhs.m_NumReleasedDedicatedPages.load());
     }
 
     ~VulkanMemoryManager();
@@ -199,9 +239,53 @@ public:
     VulkanMemoryManager& operator= (VulkanMemoryManager&&)      = delete;
     // clang-format on
 
-    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
-    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
-    void                   ShrinkMemory();
+    // If DedicatedResource is valid, the allocation gets its own device memory object that is released
+    // by ShrinkMemory() after the allocation is freed. Otherwise, the memory is suballocated from a page.
+    // When the logical device was created over a device group, non-zero DeviceMask selects the physical
+    // devices the memory is allocated on (VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT). Zero DeviceMask allocates
+    // the memory on all devices in the group.
+    // Priority is the VK_EXT_memory_priority value in [0, 1] range. Allocations with different priorities
+    // are never placed in the same page, so that the driver can demote memory of low-priority pages first
+    // when device-local memory is oversubscribed. The priority is ignored if the extension is not enabled.
+    VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedResource& DedicatedResource = {}, uint32_t DeviceMask = 0, float Priority = 0.5f);
+    VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedResource& DedicatedResource = {}, uint32_t DeviceMask = 0, float Priority = 0.5f);
+
+    // Releases empty pages that exceed the reserve size and all released dedicated allocations.
+    // If VK_EXT_memory_budget is enabled and the usage of a memory heap is close to its budget,
+    // all empty pages in this heap are released regardless of the reserve size.
+    void ShrinkMemory();
+
+    // Allocates memory to relocate Allocation to. The memory is suballocated from a page of the same type
+    // that is more densely occupied than the page that contains Allocation. New pages are never created.
+    // Returns an empty allocation if the occupancy of the Allocation's page exceeds MaxSrcPageOccupancy,
+    // or if no suitable page has enough space.
+    // The caller is responsible for copying the data and releasing the original allocation.
+    VulkanMemoryAllocation AllocateForRelocation(const VulkanMemoryAllocation& Allocation,
+                                                 VkDeviceSize                  Size,
+                                                 VkDeviceSize                  Alignment,
+                                                 double                        MaxSrcPageOccupancy);
+
+    struct DefragmentationStats
+    {
+        Diligent::Uint64 NumRelocations = 0; // The number of relocated allocations
+        VkDeviceSize     RelocatedSize  = 0; // The total size of relocated allocations
+        VkDeviceSize     ReclaimedSize  = 0; // The total size of released pages that allocations have been relocated from
+    };
+    DefragmentationStats GetDefragmentationStats();
+
+    // Returns the total size of live allocations from the given memory type.
+    VkDeviceSize GetMemoryTypeUsedSize(uint32_t MemoryTypeIndex) const
+    {
+        VERIFY_EXPR(MemoryTypeIndex < m_TypeUsedSize.size());
+        return static_cast<VkDeviceSize>(m_TypeUsedSize[MemoryTypeIndex].load());
+    }
+
+    // Returns per-heap and per-memory-type statistics, see IRenderDevice::GetMemoryStatistics().
+    void GetStatistics(Diligent::RenderDeviceMemoryStatistics& Stats);
+
+    // Sets the callback that is called when a memory page is created or destroyed,
+    // see IRenderDevice::SetMemoryAllocationCallback().
+    void SetAllocationCallback(Diligent::MemoryAllocationCallbackType Callback, void* pUserData);
 
 protected:
     friend class VulkanMemoryPage;
@@ -209,6 +293,22 @@ protected:
     virtual void OnNewPageCreated(VulkanMemoryPage& NewPage) {}
     virtual void OnPageDestroy(VulkanMemoryPage& Page) {}
 
+    VulkanMemoryAllocation AllocateDedicated(VkDeviceSize Size, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, uint32_t DeviceMask, float Priority, const VulkanDedicatedResource& DedicatedResource);
+
+    // Returns the bit mask of memory heaps whose usage is close to the budget.
+    // Returns 0 if VK_EXT_memory_budget is not enabled.
+    uint32_t GetOverBudgetHeaps() const;
+
+    // Destroys empty pages. m_PagesMtx must be locked.
+    void DestroyEmptyPages(uint32_t OverBudgetHeaps);
+
+    // Update the statistics and invoke the allocation callback. m_PagesMtx must be locked.
+    void OnPageCreated(VulkanMemoryPage& Page);
+    void OnPageReleased(VulkanMemoryPage& Page);
+
+    // Updates the used memory statistics. m_PagesMtx must be locked.
+    void OnNewAllocation(const VulkanMemoryAllocation& Allocation);
+
     std::string m_MgrName;
 
     const VulkanLogicalDevice&  m_LogicalDevice;
@@ -221,22 +321,34 @@ protected:
     {
         const uint32_t              MemoryTypeIndex;
         const VkMemoryAllocateFlags AllocateFlags;
+        const uint32_t              DeviceMask; // Physical devices of the device group the memory is allocated on
+        const float                 Priority;   // Memory priority of the page
         const bool                  IsHostVisible;
+        const bool                  IsDedicated; // Dedicated pages are never used for suballocations
 
         // clang-format off
         MemoryPageIndex(uint32_t              _MemoryTypeIndex,
                         bool                  _IsHostVisible,
-                        VkMemoryAllocateFlags _AllocateFlags) : 
+                        VkMemoryAllocateFlags _AllocateFlags,
+                        uint32_t              _DeviceMask,
+                        float                 _Priority,
+                        bool                  _IsDedicated = false) : 
             MemoryTypeIndex{_MemoryTypeIndex},
             AllocateFlags  {_AllocateFlags},
-            IsHostVisible  {_IsHostVisible}
+            DeviceMask     {_DeviceMask},
+            Priority       {_Priority},
+            IsHostVisible  {_IsHostVisible},
+            IsDedicated    {_IsDedicated}
         {}
 
         bool operator == (const MemoryPageIndex& rhs)const
         {
             return MemoryTypeIndex == rhs.MemoryTypeIndex &&
                    AllocateFlags   == rhs.AllocateFlags   &&
-                   IsHostVisible   == rhs.IsHostVisible;
+                   DeviceMask      == rhs.DeviceMask      &&
+                   Priority        == rhs.Priority        &&
+                   IsHostVisible   == rhs.IsHostVisible   &&
+                   IsDedicated     == rhs.IsDedicated;
         }
         // clang-format on
 
@@ -244,7 +356,7 @@ protected:
         {
             size_t operator()(const MemoryPageIndex& PageIndex) const
             {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible);
+                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.DeviceMask, PageIndex.Priority, PageIndex.IsHostVisible, PageIndex.IsDedicated);
             }
         };
     };
@@ -255,13 +367,38 @@ protected:
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
-    void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble);
+    void OnFreeAllocation(const VulkanMemoryPage& Page, VkDeviceSize Size);
 
     // 0 == Device local, 1 == Host-visible
     std::array<std::atomic_int64_t, 2> m_CurrUsedSize      = {};
     std::array<VkDeviceSize, 2>        m_PeakUsedSize      = {};
-    std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {};
+    std::array<VkDeviceSize, 2>        m_CurrAllocatedSize = {}; // Does not include dedicated allocations
     std::array<VkDeviceSize, 2>        m_PeakAllocatedSize = {};
+    std::array<VkDeviceSize, 2>        m_CurrDedicatedSize = {};
+    std::array<VkDeviceSize, 2>        m_PeakDedicatedSize = {};
+
+    // The number of dedicated pages whose allocation has been freed, but that have not been destroyed yet
+    std::atomic_int32_t m_NumReleasedDedicatedPages{0};
+
+    // Protected by m_PagesMtx
+    DefragmentationStats m_DefragStats;
+
+    // Per-memory-type and per-heap statistics. Used sizes are updated without
+    // locking m_PagesMtx when allocations are freed. Other members are protected by m_PagesMtx.
+    struct MemoryStats
+    {
+        VkDeviceSize PeakUsedSize      = 0;
+        VkDeviceSize AllocatedSize     = 0;
+        VkDeviceSize PeakAllocatedSize = 0;
+        uint32_t     NumPages          = 0;
+    };
+    std::array<std::atomic_int64_t, VK_MAX_MEMORY_TYPES> m_TypeUsedSize = {};
+    std::array<std::atomic_int64_t, VK_MAX_MEMORY_HEAPS> m_HeapUsedSize = {};
+    std::array<MemoryStats, VK_MAX_MEMORY_TYPES>         m_TypeStats    = {};
+    std::array<MemoryStats, VK_MAX_MEMORY_HEAPS>         m_HeapStats    = {};
+
+    Diligent::MemoryAllocationCallbackType m_AllocationCallback          = nullptr;
+    void*                                  m_pAllocationCallbackUserData = nullptr;
 
     // If adding new member, do not forget to update move ctor
 };
@@ -53,10 +53,26 @@ public:
         VkPhysicalDevicePortabilitySubsetFeaturesKHR      PortabilitySubset      = {};
         VkPhysicalDeviceVertexAttributeDivisorFeaturesEXT VertexAttributeDivisor = {};
         VkPhysicalDeviceTimelineSemaphoreFeaturesKHR      TimelineSemaphore      = {};
+        VkPhysicalDevicePresentIdFeaturesKHR              PresentId              = {};
+        VkPhysicalDevicePresentWaitFeaturesKHR            PresentWait            = {};
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR       DynamicRendering       = {};
+        VkPhysicalDeviceExtendedDynamicStateFeaturesEXT   ExtendedDynamicState   = {};
+        VkPhysicalDeviceConditionalRenderingFeaturesEXT   ConditionalRendering   = {};
+        VkPhysicalDeviceMemoryPriorityFeaturesEXT         MemoryPriority         = {};
+        VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT PageableDeviceLocalMemory = {};
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT       DescriptorBuffer       = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT GraphicsPipelineLibrary = {};
+        VkPhysicalDevicePipelineExecutablePropertiesFeaturesKHR PipelineExecutableProperties = {};
         bool                                              Spirv14                = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
         bool                                              Spirv15                = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
         bool                                              SubgroupOps            = false; // Requires Vulkan 1.1
         bool                                              HasPortabilitySubset   = false;
+        bool                                              DrawIndirectCount      = false; // VK_KHR_draw_indirect_count
+        bool                                              DedicatedAllocation    = false; // VK_KHR_dedicated_allocation and VK_KHR_get_memory_requirements2
+        bool                                              MemoryBudget           = false; // VK_EXT_memory_budget
+        bool                                              DescriptorUpdateTemplate = false; // Vulkan 1.1 or VK_KHR_descriptor_update_template
+        bool                                              PushDescriptor         = false; // VK_KHR_push_descriptor
+        bool                                              CalibratedTimestamps   = false; // VK_EXT_calibrated_timestamps with the device and the host time domains
     };
 
     struct ExtensionProperties
@@ -69,6 +85,9 @@ public:
         VkPhysicalDeviceSubgroupProperties                  Subgroup               = {};
         VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT VertexAttributeDivisor = {};
         VkPhysicalDeviceTimelineSemaphorePropertiesKHR      TimelineSemaphore      = {};
+        VkPhysicalDevicePushDescriptorPropertiesKHR         PushDescriptor         = {};
+        VkPhysicalDeviceDescriptorBufferPropertiesEXT       DescriptorBuffer       = {};
+        VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT GraphicsPipelineLibrary = {};
     };
 
 public:
@@ -79,6 +98,13 @@ public:
     VulkanPhysicalDevice& operator = (VulkanPhysicalDevice&&)      = delete;
     // clang-format on
 
+#if PLATFORM_WIN32
+    // Host time domain that is sampled by std::chrono::steady_clock
+    static constexpr VkTimeDomainEXT HostTimeDomain = VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#elif PLATFORM_LINUX || PLATFORM_ANDROID
+    static constexpr VkTimeDomainEXT HostTimeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#endif
+
     static std::unique_ptr<VulkanPhysicalDevice> Create(VkPhysicalDevice      vkDevice,
                                                         const VulkanInstance& Instance);
 
@@ -99,6 +125,10 @@ public:
     const ExtensionProperties&                  GetExtProperties() const { return m_ExtProperties; }
     const VkPhysicalDeviceMemoryProperties&     GetMemoryProperties() const { return m_MemoryProperties; }
     VkFormatProperties                          GetPhysicalDeviceFormatProperties(VkFormat imageFormat) const;
+
+    // Queries current budget and usage of every memory heap. Requires VK_EXT_memory_budget extension
+    // to be enabled for the logical device. Returns false if the budget can't be queried.
+    bool GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget) const;
     const std::vector<VkQueueFamilyProperties>& GetQueueProperties() const { return m_QueueFamilyProperties; }
 
 private:
@@ -66,6 +66,13 @@ DILIGENT_BEGIN_INTERFACE(ICommandQueueVk, ICommandQueue)
     VIRTUAL VkResult METHOD(Present)(THIS_
                                      const VkPresentInfoKHR REF PresentInfo) PURE;
 
+    /// Submits a sparse memory binding operation to the internal Vulkan command queue
+
+    /// \remarks Sparse binding operations are not ordered with command buffer submissions,
+    ///          the caller must use semaphores in BindInfo to synchronize them.
+    VIRTUAL void METHOD(BindSparse)(THIS_
+                                    const VkBindSparseInfo REF BindInfo) PURE;
+
     /// Returns Vulkan command queue handle. May return VK_NULL_HANDLE if queue is anavailable
     ///
     /// \warning  Access to the VkQueue must be externally synchronized.
@@ -98,6 +105,7 @@ DILIGENT_END_INTERFACE
 #    define ICommandQueueVk_SubmitCmdBuffer(This, ...)        CALL_IFACE_METHOD(CommandQueueVk, SubmitCmdBuffer,        This, __VA_ARGS__)
 #    define ICommandQueueVk_Submit(This, ...)                 CALL_IFACE_METHOD(CommandQueueVk, Submit,                 This, __VA_ARGS__)
 #    define ICommandQueueVk_Present(This, ...)                CALL_IFACE_METHOD(CommandQueueVk, Present,                This, __VA_ARGS__)
+#    define ICommandQueueVk_BindSparse(This, ...)             CALL_IFACE_METHOD(CommandQueueVk, BindSparse,             This, __VA_ARGS__)
 #    define ICommandQueueVk_GetVkQueue(This)                  CALL_IFACE_METHOD(CommandQueueVk, GetVkQueue,             This)
 #    define ICommandQueueVk_GetQueueFamilyIndex(This)         CALL_IFACE_METHOD(CommandQueueVk, GetQueueFamilyIndex,    This)
 #    define ICommandQueueVk_EnqueueSignalFence(This, ...)     CALL_IFACE_METHOD(CommandQueueVk, EnqueueSignalFence,     This, __VA_ARGS__)
@@ -84,6 +84,43 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL VkCommandBuffer METHOD(GetVkCommandBuffer)(THIS) PURE;
+
+    /// Begins recording commands into a secondary Vulkan command buffer that continues the given render pass subpass
+
+    /// \param [in] ImmediateContextId - Index of the immediate context where the command list will be executed.
+    /// \param [in] pRenderPass        - Render pass that the command buffer will be executed in.
+    /// \param [in] SubpassIndex       - Index of the subpass that the command buffer will be executed in.
+    /// \param [in] pFramebuffer       - Framebuffer that the command buffer will be executed with.
+    ///
+    /// \remarks  This method must only be called for deferred contexts and replaces IDeviceContext::Begin().
+    ///           The context behaves as if the render pass was active, so draw commands may be recorded right away.
+    ///           The recording is finished by IDeviceContext::FinishCommandList(). The resulting command list
+    ///           must be executed by IDeviceContext::ExecuteCommandLists() inside the same subpass of a render pass
+    ///           begun with IDeviceContextVk::BeginRenderPassWithSecondaryCommandBuffers().
+    ///
+    ///           Resource state transitions are not allowed inside a render pass, so all commands recorded into
+    ///           a secondary command buffer must use RESOURCE_STATE_TRANSITION_MODE_VERIFY or
+    ///           RESOURCE_STATE_TRANSITION_MODE_NONE modes. Required transitions must be performed by the
+    ///           immediate context before the render pass is begun.
+    VIRTUAL void METHOD(BeginSecondaryCommandBuffer)(THIS_
+                                                     Uint32        ImmediateContextId,
+                                                     IRenderPass*  pRenderPass,
+                                                     Uint32        SubpassIndex,
+                                                     IFramebuffer* pFramebuffer) PURE;
+
+    /// Begins a render pass whose subpasses are recorded into secondary command buffers
+
+    /// \param [in] Attribs - The command attributes, see Diligent::BeginRenderPassAttribs for details.
+    ///
+    /// \remarks  This method must only be called for immediate contexts. The only command allowed
+    ///           inside the render pass is IDeviceContext::ExecuteCommandLists() with command lists that
+    ///           were recorded by IDeviceContextVk::BeginSecondaryCommandBuffer() for the current subpass.
+    ///           IDeviceContext::NextSubpass() and IDeviceContext::EndRenderPass() are used as usual.
+    ///
+    ///           Executing secondary command buffers resets all states bound in the context except for
+    ///           the render pass and the framebuffer.
+    VIRTUAL void METHOD(BeginRenderPassWithSecondaryCommandBuffers)(THIS_
+                                                                    const BeginRenderPassAttribs REF Attribs) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -95,6 +132,8 @@ DILIGENT_END_INTERFACE
 
 #    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
 #    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
+#    define IDeviceContextVk_BeginSecondaryCommandBuffer(This, ...)                CALL_IFACE_METHOD(DeviceContextVk, BeginSecondaryCommandBuffer,                This, __VA_ARGS__)
+#    define IDeviceContextVk_BeginRenderPassWithSecondaryCommandBuffers(This, ...) CALL_IFACE_METHOD(DeviceContextVk, BeginRenderPassWithSecondaryCommandBuffers, This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,71 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Definition of the Diligent::IPipelineStateCacheVk interface
+
+#include "../../GraphicsEngine/interface/PipelineStateCache.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {677B4DBC-730D-4296-8CAB-9DAA4EB9F4EE}
+static const INTERFACE_ID IID_PipelineStateCacheVk =
+    {0x677b4dbc, 0x730d, 0x4296, {0x8c, 0xab, 0x9d, 0xaa, 0x4e, 0xb9, 0xf4, 0xee}};
+
+#define DILIGENT_INTERFACE_NAME IPipelineStateCacheVk
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IPipelineStateCacheVkInclusiveMethods \
+    IPipelineStateCacheInclusiveMethods;      \
+    IPipelineStateCacheVkMethods PipelineStateCacheVk
+
+// clang-format off
+
+/// Exposes Vulkan-specific functionality of a pipeline state cache object.
+DILIGENT_BEGIN_INTERFACE(IPipelineStateCacheVk, IPipelineStateCache)
+{
+    /// Returns the Vulkan pipeline cache handle.
+    VIRTUAL VkPipelineCache METHOD(GetVkPipelineCache)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IPipelineStateCacheVk_GetVkPipelineCache(This) CALL_IFACE_METHOD(PipelineStateCacheVk, GetVkPipelineCache, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -50,6 +50,10 @@ static const INTERFACE_ID IID_PipelineStateVk =
 DILIGENT_BEGIN_INTERFACE(IPipelineStateVk, IPipelineState)
 {
     /// Returns a pointer to the internal render pass object.
+
+    /// \remarks When the device supports dynamic rendering (VK_KHR_dynamic_rendering), graphics pipelines
+    ///          that use implicit render passes are created without a render pass object, and the method
+    ///          returns null for them.
     VIRTUAL IRenderPassVk* METHOD(GetRenderPass)(THIS) CONST PURE;
 
     /// Returns a Vulkan handle of the internal pipeline state object.
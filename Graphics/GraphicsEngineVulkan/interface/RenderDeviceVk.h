@@ -157,6 +157,40 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                        VkSemaphore         vkTimelineSemaphore,
                                                        const FenceDesc REF Desc,
                                                        IFence**            ppFence) PURE;
+
+
+    /// Returns the device's default pipeline state cache.
+
+    /// The default cache is created from EngineVkCreateInfo::pPipelineCacheData and is used by all
+    /// pipeline states that do not specify PipelineStateCreateInfo::pPSOCache. An application
+    /// may call IPipelineStateCache::GetData() to serialize the cache contents and pass them
+    /// to EngineVkCreateInfo next time the engine is initialized.
+    ///
+    /// \remarks This method does not increment the reference counter of the returned interface,
+    ///          so the application should not call Release().
+    VIRTUAL IPipelineStateCache* METHOD(GetPipelineStateCache)(THIS) PURE;
+
+
+    /// Returns the statistics of the device's framebuffer cache.
+
+    /// \param [out] Stats - Framebuffer cache statistics, see Diligent::FramebufferCacheStatistics.
+    ///
+    /// \remarks The cache size and the frame age after which unused framebuffers are released
+    ///          are controlled by EngineVkCreateInfo::FramebufferCacheSize and
+    ///          EngineVkCreateInfo::FramebufferCacheMaxAge.
+    VIRTUAL void METHOD(GetFramebufferCacheStatistics)(THIS_
+                                                       FramebufferCacheStatistics REF Stats) PURE;
+
+
+    /// Returns the usage statistics of the dynamic heap that is shared by all device contexts.
+
+    /// \param [out] Stats - Dynamic heap statistics, see Diligent::DynamicHeapStatistics.
+    ///
+    /// \remarks Frames are counted by IDeviceContext::FinishFrame() of the first immediate context.
+    ///          The per-frame peak size can be used to choose EngineVkCreateInfo::DynamicHeapSize:
+    ///          the heap can't grow at run time, as all dynamic resources share a single Vulkan buffer.
+    VIRTUAL void METHOD(GetDynamicHeapStatistics)(THIS_
+                                                  DynamicHeapStatistics REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -174,6 +208,9 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetPipelineStateCache(This)               CALL_IFACE_METHOD(RenderDeviceVk, GetPipelineStateCache,          This)
+#    define IRenderDeviceVk_GetFramebufferCacheStatistics(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, GetFramebufferCacheStatistics,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDynamicHeapStatistics(This, ...)       CALL_IFACE_METHOD(RenderDeviceVk, GetDynamicHeapStatistics,       This, __VA_ARGS__)
 
 // clang-format on
 
@@ -0,0 +1,69 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Definition of the Diligent::IResourceHeapVk interface
+
+#include "../../GraphicsEngine/interface/ResourceHeap.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+// {B3E1D0A4-6C2F-4A8D-9E57-1F0C4B6A2D93}
+static const INTERFACE_ID IID_ResourceHeapVk =
+    {0xb3e1d0a4, 0x6c2f, 0x4a8d, {0x9e, 0x57, 0x1f, 0x0c, 0x4b, 0x6a, 0x2d, 0x93}};
+
+#define DILIGENT_INTERFACE_NAME IResourceHeapVk
+#include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
+
+#define IResourceHeapVkInclusiveMethods \
+    IResourceHeapInclusiveMethods;      \
+    IResourceHeapVkMethods ResourceHeapVk
+
+// clang-format off
+
+/// Exposes Vulkan-specific functionality of a resource heap object.
+DILIGENT_BEGIN_INTERFACE(IResourceHeapVk, IResourceHeap)
+{
+    /// Returns the Vulkan device memory object that backs the heap.
+    VIRTUAL VkDeviceMemory METHOD(GetVkDeviceMemory)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "../../../Primitives/interface/UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IResourceHeapVk_GetVkDeviceMemory(This) CALL_IFACE_METHOD(ResourceHeapVk, GetVkDeviceMemory, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
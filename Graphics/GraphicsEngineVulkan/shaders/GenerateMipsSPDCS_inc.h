@@ -0,0 +1,244 @@
+"// Single-pass mip generation.\n"
+"// Every thread group downsamples a 64x64 tile of the source mip level to a single texel of mip 6.\n"
+"// The last group to finish an array slice then downsamples mip 6 to generate mips 7 through 12.\n"
+"// Every downsampling step must be exactly 2:1 (or 1:1 when the dimension is already 1), so the\n"
+"// source mip dimensions must be powers of two.\n"
+"\n"
+"#ifndef CONVERT_TO_SRGB\n"
+"#define CONVERT_TO_SRGB 0\n"
+"#endif\n"
+"\n"
+"#ifndef IMG_FORMAT\n"
+"#define IMG_FORMAT rgba8\n"
+"#endif\n"
+"\n"
+"// Mip levels are relative to the source mip level\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip1;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip2;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip3;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip4;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip5;\n"
+"// Mip 6 is read by the last thread group\n"
+"layout(IMG_FORMAT) uniform coherent image2DArray OutMip6;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip7;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip8;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip9;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip10;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip11;\n"
+"layout(IMG_FORMAT) uniform writeonly image2DArray OutMip12;\n"
+"\n"
+"uniform sampler2DArray SrcMip;\n"
+"\n"
+"// The number of thread groups that have finished each array slice.\n"
+"// The last group resets the counter, so it is zero at the beginning of every dispatch.\n"
+"layout(std430) buffer SPDCounterBuffer\n"
+"{\n"
+"    uint SPDCounter[];\n"
+"};\n"
+"\n"
+"uniform CB\n"
+"{\n"
+"    ivec2 SrcMipSize;    // Dimensions of the source mip level\n"
+"    int   NumMipLevels;  // Number of mip levels to generate: [1, 12]\n"
+"    int   NumGroups;     // Number of thread groups per array slice\n"
+"    int   CounterOffset; // Index of the counter of the first array slice\n"
+"};\n"
+"\n"
+"// 32x32 tile of the current mip level.\n"
+"// The reason for separating channels is to reduce bank conflicts in the\n"
+"// local data memory controller.  A large stride will cause more threads\n"
+"// to collide on the same memory bank.\n"
+"shared float gs_R[1024];\n"
+"shared float gs_G[1024];\n"
+"shared float gs_B[1024];\n"
+"shared float gs_A[1024];\n"
+"\n"
+"shared uint gs_Counter;\n"
+"\n"
+"void StoreColor( ivec2 Pos, vec4 Color )\n"
+"{\n"
+"    int Index = Pos.y * 32 + Pos.x;\n"
+"    gs_R[Index] = Color.r;\n"
+"    gs_G[Index] = Color.g;\n"
+"    gs_B[Index] = Color.b;\n"
+"    gs_A[Index] = Color.a;\n"
+"}\n"
+"\n"
+"vec4 LoadColor( ivec2 Pos )\n"
+"{\n"
+"    int Index = Pos.y * 32 + Pos.x;\n"
+"    return vec4( gs_R[Index], gs_G[Index], gs_B[Index], gs_A[Index]);\n"
+"}\n"
+"\n"
+"float LinearToSRGB(float x)\n"
+"{\n"
+"    // This is exactly the sRGB curve\n"
+"    //return x < 0.0031308 ? 12.92 * x : 1.055 * pow(abs(x), 1.0 / 2.4) - 0.055;\n"
+"     \n"
+"    // This is cheaper but nearly equivalent\n"
+"    return x < 0.0031308 ? 12.92 * x : 1.13005 * sqrt(abs(x - 0.00228)) - 0.13448 * x + 0.005719;\n"
+"}\n"
+"\n"
+"float SRGBToLinear(float x)\n"
+"{\n"
+"    return x <= 0.04045 ? x / 12.92 : pow((x + 0.055) / 1.055, 2.4);\n"
+"}\n"
+"\n"
+"vec4 PackColor(vec4 Linear)\n"
+"{\n"
+"#if CONVERT_TO_SRGB\n"
+"    return vec4(LinearToSRGB(Linear.r), LinearToSRGB(Linear.g), LinearToSRGB(Linear.b), Linear.a);\n"
+"#else\n"
+"    return Linear;\n"
+"#endif\n"
+"}\n"
+"\n"
+"vec4 UnpackColor(vec4 Packed)\n"
+"{\n"
+"#if CONVERT_TO_SRGB\n"
+"    return vec4(SRGBToLinear(Packed.r), SRGBToLinear(Packed.g), SRGBToLinear(Packed.b), Packed.a);\n"
+"#else\n"
+"    return Packed;\n"
+"#endif\n"
+"}\n"
+"\n"
+"void StoreMip(int Mip, ivec3 Coord, vec4 Color)\n"
+"{\n"
+"    Color = PackColor(Color);\n"
+"    switch (Mip)\n"
+"    {\n"
+"        case 1:  imageStore(OutMip1,  Coord, Color); break;\n"
+"        case 2:  imageStore(OutMip2,  Coord, Color); break;\n"
+"        case 3:  imageStore(OutMip3,  Coord, Color); break;\n"
+"        case 4:  imageStore(OutMip4,  Coord, Color); break;\n"
+"        case 5:  imageStore(OutMip5,  Coord, Color); break;\n"
+"        case 6:  imageStore(OutMip6,  Coord, Color); break;\n"
+"        case 7:  imageStore(OutMip7,  Coord, Color); break;\n"
+"        case 8:  imageStore(OutMip8,  Coord, Color); break;\n"
+"        case 9:  imageStore(OutMip9,  Coord, Color); break;\n"
+"        case 10: imageStore(OutMip10, Coord, Color); break;\n"
+"        case 11: imageStore(OutMip11, Coord, Color); break;\n"
+"        case 12: imageStore(OutMip12, Coord, Color); break;\n"
+"    }\n"
+"}\n"
+"\n"
+"ivec2 GetMipSize(int Mip)\n"
+"{\n"
+"    return max(SrcMipSize >> Mip, ivec2(1, 1));\n"
+"}\n"
+"\n"
+"void GroupMemoryBarrierWithGroupSync()\n"
+"{\n"
+"    // OpenGL.org: groupMemoryBarrier() waits on the completion of all memory accesses \n"
+"    // performed by an invocation of a compute shader relative to the same access performed \n"
+"    // by other invocations in the same work group and then returns with no other effect.\n"
+"\n"
+"    // groupMemoryBarrier() acts like memoryBarrier(), ordering memory writes for all kinds \n"
+"    // of variables, but it only orders read/writes for the current work group.\n"
+"    groupMemoryBarrier();\n"
+"\n"
+"    // OpenGL.org: memoryBarrierShared() waits on the completion of \n"
+"    // all memory accesses resulting from the use of SHARED variables\n"
+"    // and then returns with no other effect. \n"
+"    memoryBarrierShared();\n"
+"\n"
+"    // Thread execution barrier\n"
+"    barrier();\n"
+"}\n"
+"\n"
+"// Generates up to five mip levels from the 32x32 tile of TileMip level stored in the shared memory.\n"
+"// Texels outside of the mip level are clamped to the edge, so that every texel of the next\n"
+"// level is the average of four texels of the current one.\n"
+"void DownsampleTile(uint LocalInd, ivec2 TileId, int ArraySlice, int TileMip)\n"
+"{\n"
+"    int LastMip = min(TileMip + 5, NumMipLevels);\n"
+"    for (int Mip = TileMip + 1; Mip <= LastMip; ++Mip)\n"
+"    {\n"
+"        int   TileSize = 32 >> (Mip - TileMip);\n"
+"        ivec2 Origin   = TileId * TileSize;\n"
+"        ivec2 MipSize  = GetMipSize(Mip);\n"
+"        bool  IsActive = LocalInd < uint(TileSize * TileSize);\n"
+"        ivec2 Pos      = ivec2(int(LocalInd) % TileSize, int(LocalInd) / TileSize);\n"
+"\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"        vec4 Color = vec4(0.0, 0.0, 0.0, 0.0);\n"
+"        if (IsActive)\n"
+"        {\n"
+"            ivec2 SrcPos = (min(Origin + Pos, MipSize - ivec2(1, 1)) - Origin) * 2;\n"
+"            Color = 0.25 * (LoadColor(SrcPos) + LoadColor(SrcPos + ivec2(1, 0)) +\n"
+"                            LoadColor(SrcPos + ivec2(0, 1)) + LoadColor(SrcPos + ivec2(1, 1)));\n"
+"        }\n"
+"\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"        if (IsActive)\n"
+"        {\n"
+"            StoreColor(Pos, Color);\n"
+"            if (all(lessThan(Origin + Pos, MipSize)))\n"
+"                StoreMip(Mip, ivec3(Origin + Pos, ArraySlice), Color);\n"
+"        }\n"
+"    }\n"
+"}\n"
+"\n"
+"layout (local_size_x = 256, local_size_y = 1, local_size_z = 1) in;\n"
+"void main()\n"
+"{\n"
+"    uint  LocalInd   = gl_LocalInvocationIndex;\n"
+"    ivec2 TileId     = ivec2(gl_WorkGroupID.xy);\n"
+"    int   ArraySlice = int(gl_WorkGroupID.z);\n"
+"\n"
+"    // Every thread computes four texels of the 32x32 tile of mip 1. Every texel of mip 1\n"
+"    // is the bilinear sample at the shared corner of the four source texels.\n"
+"    ivec2 Mip1Size = GetMipSize(1);\n"
+"    for (int i = 0; i < 4; ++i)\n"
+"    {\n"
+"        ivec2 Pos   = ivec2(int(LocalInd) % 32, int(LocalInd) / 32 + i * 8);\n"
+"        ivec2 Coord = TileId * 32 + Pos;\n"
+"        vec2  UV    = (vec2(min(Coord, Mip1Size - ivec2(1, 1))) * 2.0 + vec2(1.0, 1.0)) / vec2(SrcMipSize);\n"
+"        vec4  Color = textureLod(SrcMip, vec3(UV, ArraySlice), 0.0); // SrcMip is the view of the source mip level\n"
+"        StoreColor(Pos, Color);\n"
+"        if (all(lessThan(Coord, Mip1Size)))\n"
+"            StoreMip(1, ivec3(Coord, ArraySlice), Color);\n"
+"    }\n"
+"\n"
+"    DownsampleTile(LocalInd, TileId, ArraySlice, 1);\n"
+"\n"
+"    // A scalar (constant) branch can exit all threads coherently.\n"
+"    if (NumMipLevels <= 6)\n"
+"        return;\n"
+"\n"
+"    // Make mip 6 texel visible to the last group and count the finished groups\n"
+"    memoryBarrierImage();\n"
+"    memoryBarrier();\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    if (LocalInd == 0u)\n"
+"        gs_Counter = atomicAdd(SPDCounter[CounterOffset + ArraySlice], 1u);\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    if (gs_Counter != uint(NumGroups - 1))\n"
+"        return;\n"
+"\n"
+"    // This is the last group: reset the counter for the next dispatch\n"
+"    if (LocalInd == 0u)\n"
+"        SPDCounter[CounterOffset + ArraySlice] = 0u;\n"
+"\n"
+"    // Mip 6 is at most 64x64, so the entire mip 7 fits into a single tile\n"
+"    ivec2 Mip6Size = GetMipSize(6);\n"
+"    ivec2 Mip7Size = GetMipSize(7);\n"
+"    for (int i = 0; i < 4; ++i)\n"
+"    {\n"
+"        ivec2 Pos    = ivec2(int(LocalInd) % 32, int(LocalInd) / 32 + i * 8);\n"
+"        ivec2 SrcPos = min(Pos, Mip7Size - ivec2(1, 1)) * 2;\n"
+"        ivec2 MaxPos = Mip6Size - ivec2(1, 1);\n"
+"        vec4  Color  = 0.25 * (UnpackColor(imageLoad(OutMip6, ivec3(min(SrcPos,               MaxPos), ArraySlice))) +\n"
+"                               UnpackColor(imageLoad(OutMip6, ivec3(min(SrcPos + ivec2(1, 0), MaxPos), ArraySlice))) +\n"
+"                               UnpackColor(imageLoad(OutMip6, ivec3(min(SrcPos + ivec2(0, 1), MaxPos), ArraySlice))) +\n"
+"                               UnpackColor(imageLoad(OutMip6, ivec3(min(SrcPos + ivec2(1, 1), MaxPos), ArraySlice))));\n"
+"        StoreColor(Pos, Color);\n"
+"        if (all(lessThan(Pos, Mip7Size)))\n"
+"            StoreMip(7, ivec3(Pos, ArraySlice), Color);\n"
+"    }\n"
+"\n"
+"    DownsampleTile(LocalInd, ivec2(0, 0), ArraySlice, 7);\n"
+"}\n"
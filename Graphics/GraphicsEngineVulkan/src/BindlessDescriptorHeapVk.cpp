@@ -0,0 +1,251 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "BindlessDescriptorHeapVk.hpp"
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+static constexpr VkDescriptorType BindingToVkDescriptorType[] =
+    {
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,        // BINDING_SAMPLED_IMAGE
+        VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,        // BINDING_STORAGE_IMAGE
+        VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, // BINDING_UNIFORM_TEXEL_BUFFER
+        VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, // BINDING_STORAGE_TEXEL_BUFFER
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER        // BINDING_STORAGE_BUFFER
+};
+static_assert(_countof(BindingToVkDescriptorType) == BindlessDescriptorHeapVk::BINDING_COUNT, "Please update the array above");
+
+BindlessDescriptorHeapVk::BindlessDescriptorHeapVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 HeapSize) :
+    m_DeviceVkImpl{DeviceVkImpl}
+{
+    VERIFY_EXPR(HeapSize > 0);
+
+    const auto& LogicalDevice    = DeviceVkImpl.GetLogicalDevice();
+    const auto& DescrIndexing    = LogicalDevice.GetEnabledExtFeatures().DescriptorIndexing;
+    const auto& DescrIndexingPrs = DeviceVkImpl.GetPhysicalDevice().GetExtProperties().DescriptorIndexing;
+
+    // clang-format off
+    if (DescrIndexing.descriptorBindingPartiallyBound                    == VK_FALSE ||
+        DescrIndexing.descriptorBindingSampledImageUpdateAfterBind       == VK_FALSE ||
+        DescrIndexing.descriptorBindingStorageImageUpdateAfterBind       == VK_FALSE ||
+        DescrIndexing.descriptorBindingUniformTexelBufferUpdateAfterBind == VK_FALSE ||
+        DescrIndexing.descriptorBindingStorageTexelBufferUpdateAfterBind == VK_FALSE ||
+        DescrIndexing.descriptorBindingStorageBufferUpdateAfterBind      == VK_FALSE)
+    // clang-format on
+    {
+        LOG_ERROR_AND_THROW("Bindless descriptor heap requires partially bound and update-after-bind descriptor indexing features");
+    }
+
+    // clang-format off
+    const Uint32 MaxDescriptors[] =
+    {
+        DescrIndexingPrs.maxPerStageDescriptorUpdateAfterBindSampledImages,
+        DescrIndexingPrs.maxPerStageDescriptorUpdateAfterBindStorageImages,
+        DescrIndexingPrs.maxPerStageDescriptorUpdateAfterBindSampledImages,
+        DescrIndexingPrs.maxPerStageDescriptorUpdateAfterBindStorageImages,
+        DescrIndexingPrs.maxPerStageDescriptorUpdateAfterBindStorageBuffers
+    };
+    // clang-format on
+    static_assert(_countof(MaxDescriptors) == BINDING_COUNT, "Please update the array above");
+
+    std::array<VkDescriptorSetLayoutBinding, BINDING_COUNT> Bindings     = {};
+    std::array<VkDescriptorBindingFlagsEXT, BINDING_COUNT>  BindingFlags = {};
+    std::array<VkDescriptorPoolSize, BINDING_COUNT>         PoolSizes    = {};
+    for (Uint32 b = 0; b < BINDING_COUNT; ++b)
+    {
+        const auto Count = std::min(HeapSize, MaxDescriptors[b]);
+        if (Count < HeapSize)
+        {
+            LOG_WARNING_MESSAGE("Bindless heap size (", HeapSize, ") exceeds the maximum number of update-after-bind ",
+                                "descriptors of this type (", MaxDescriptors[b], ") supported by the device. The number will be clamped.");
+        }
+
+        Bindings[b].binding            = b;
+        Bindings[b].descriptorType     = BindingToVkDescriptorType[b];
+        Bindings[b].descriptorCount    = Count;
+        Bindings[b].stageFlags         = VK_SHADER_STAGE_ALL;
+        Bindings[b].pImmutableSamplers = nullptr;
+
+        BindingFlags[b] = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+
+        PoolSizes[b].type            = BindingToVkDescriptorType[b];
+        PoolSizes[b].descriptorCount = Count;
+
+        m_IndexAllocators[b] = std::make_unique<BindlessIndexAllocator>(Count);
+    }
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT BindingFlagsCI = {};
+
+    BindingFlagsCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    BindingFlagsCI.pNext         = nullptr;
+    BindingFlagsCI.bindingCount  = static_cast<uint32_t>(BindingFlags.size());
+    BindingFlagsCI.pBindingFlags = BindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo SetLayoutCI = {};
+
+    SetLayoutCI.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    SetLayoutCI.pNext        = &BindingFlagsCI;
+    SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    SetLayoutCI.bindingCount = static_cast<uint32_t>(Bindings.size());
+    SetLayoutCI.pBindings    = Bindings.data();
+
+    m_vkSetLayout = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI, "Bindless descriptor set layout");
+
+    VkDescriptorPoolCreateInfo PoolCI = {};
+
+    PoolCI.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    PoolCI.pNext         = nullptr;
+    PoolCI.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    PoolCI.maxSets       = 1;
+    PoolCI.poolSizeCount = static_cast<uint32_t>(PoolSizes.size());
+    PoolCI.pPoolSizes    = PoolSizes.data();
+
+    m_vkPool = LogicalDevice.CreateDescriptorPool(PoolCI, "Bindless descriptor pool");
+
+    const VkDescriptorSetLayout vkSetLayout = m_vkSetLayout;
+
+    VkDescriptorSetAllocateInfo AllocInfo = {};
+
+    AllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    AllocInfo.pNext              = nullptr;
+    AllocInfo.descriptorPool     = m_vkPool;
+    AllocInfo.descriptorSetCount = 1;
+    AllocInfo.pSetLayouts        = &vkSetLayout;
+
+    m_vkDescriptorSet = LogicalDevice.AllocateVkDescriptorSet(AllocInfo, "Bindless descriptor set");
+    if (m_vkDescriptorSet == VK_NULL_HANDLE)
+        LOG_ERROR_AND_THROW("Failed to allocate bindless descriptor set");
+}
+
+BindlessDescriptorHeapVk::~BindlessDescriptorHeapVk()
+{
+    // The set is implicitly freed when the pool is destroyed
+}
+
+BindlessDescriptorHeapVk::BINDING BindlessDescriptorHeapVk::GetBinding(DescriptorType Type)
+{
+    switch (Type)
+    {
+        // clang-format off
+        case DescriptorType::SeparateImage:               return BINDING_SAMPLED_IMAGE;
+        case DescriptorType::StorageImage:                return BINDING_STORAGE_IMAGE;
+        case DescriptorType::UniformTexelBuffer:          return BINDING_UNIFORM_TEXEL_BUFFER;
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly: return BINDING_STORAGE_TEXEL_BUFFER;
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:      return BINDING_STORAGE_BUFFER;
+        // clang-format on
+        default:
+            return BINDING_UNKNOWN;
+    }
+}
+
+Uint32 BindlessDescriptorHeapVk::AllocateIndex(BINDING Binding)
+{
+    VERIFY_EXPR(Binding < BINDING_COUNT);
+    const auto Index = m_IndexAllocators[Binding]->Allocate();
+    if (Index == INVALID_BINDLESS_INDEX)
+    {
+        LOG_ERROR_MESSAGE("Bindless descriptor heap is full: all ", m_IndexAllocators[Binding]->GetCapacity(),
+                          " descriptors of this type are in use. Increase EngineVkCreateInfo::BindlessHeapSize.");
+    }
+    return Index;
+}
+
+void BindlessDescriptorHeapVk::ReleaseIndex(BINDING Binding, Uint32 Index, Uint64 CmdQueueMask)
+{
+    if (Index == INVALID_BINDLESS_INDEX)
+        return;
+
+    VERIFY_EXPR(Binding < BINDING_COUNT);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(BindlessIndexAllocator::StaleIndex{*m_IndexAllocators[Binding], Index}, CmdQueueMask);
+}
+
+void BindlessDescriptorHeapVk::WriteDescriptor(VkWriteDescriptorSet& WriteDescrSet, BINDING Binding, Uint32 Index) const
+{
+    VERIFY_EXPR(Binding < BINDING_COUNT);
+    VERIFY_EXPR(Index != INVALID_BINDLESS_INDEX);
+
+    WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    WriteDescrSet.pNext           = nullptr;
+    WriteDescrSet.dstSet          = m_vkDescriptorSet;
+    WriteDescrSet.dstBinding      = Binding;
+    WriteDescrSet.dstArrayElement = Index;
+    WriteDescrSet.descriptorCount = 1;
+    WriteDescrSet.descriptorType  = BindingToVkDescriptorType[Binding];
+
+    // Update-after-bind descriptors may be written while the set is bound
+    // in command buffers that are being recorded or executed.
+    m_DeviceVkImpl.GetLogicalDevice().UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+}
+
+void BindlessDescriptorHeapVk::WriteImage(BINDING Binding, Uint32 Index, VkImageView vkImageView, VkImageLayout vkLayout) const
+{
+    VERIFY_EXPR(Binding == BINDING_SAMPLED_IMAGE || Binding == BINDING_STORAGE_IMAGE);
+
+    VkDescriptorImageInfo ImageInfo = {};
+
+    ImageInfo.sampler     = VK_NULL_HANDLE;
+    ImageInfo.imageView   = vkImageView;
+    ImageInfo.imageLayout = vkLayout;
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+
+    WriteDescrSet.pImageInfo = &ImageInfo;
+    WriteDescriptor(WriteDescrSet, Binding, Index);
+}
+
+void BindlessDescriptorHeapVk::WriteTexelBuffer(BINDING Binding, Uint32 Index, VkBufferView vkBufferView) const
+{
+    VERIFY_EXPR(Binding == BINDING_UNIFORM_TEXEL_BUFFER || Binding == BINDING_STORAGE_TEXEL_BUFFER);
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+
+    WriteDescrSet.pTexelBufferView = &vkBufferView;
+    WriteDescriptor(WriteDescrSet, Binding, Index);
+}
+
+void BindlessDescriptorHeapVk::WriteBuffer(Uint32 Index, VkBuffer vkBuffer, VkDeviceSize Offset, VkDeviceSize Range) const
+{
+    VkDescriptorBufferInfo BufferInfo = {};
+
+    BufferInfo.buffer = vkBuffer;
+    BufferInfo.offset = Offset;
+    BufferInfo.range  = Range;
+
+    VkWriteDescriptorSet WriteDescrSet = {};
+
+    WriteDescrSet.pBufferInfo = &BufferInfo;
+    WriteDescriptor(WriteDescrSet, BINDING_STORAGE_BUFFER, Index);
+}
+
+} // namespace Diligent
@@ -51,11 +51,48 @@ BufferViewVkImpl::BufferViewVkImpl(IReferenceCounters*                  pRefCoun
     m_BuffView{std::move(BuffView)}
 // clang-format on
 {
+    auto* pBindlessHeap = pDevice->GetBindlessHeap();
+    if (pBindlessHeap == nullptr)
+        return;
+
+    // Dynamic buffers are accessed through dynamic offsets and can't be placed in the bindless heap
+    auto*       pBufferVk = ValidatedCast<BufferVkImpl>(pBuffer);
+    const auto& BuffDesc  = pBufferVk->GetDesc();
+    if (BuffDesc.Usage == USAGE_DYNAMIC)
+        return;
+
+    const bool IsFormatted = (BuffDesc.Mode == BUFFER_MODE_FORMATTED);
+    switch (ViewDesc.ViewType)
+    {
+        case BUFFER_VIEW_SHADER_RESOURCE:
+            m_BindlessBinding = IsFormatted ? BindlessDescriptorHeapVk::BINDING_UNIFORM_TEXEL_BUFFER : BindlessDescriptorHeapVk::BINDING_STORAGE_BUFFER;
+            break;
+
+        case BUFFER_VIEW_UNORDERED_ACCESS:
+            m_BindlessBinding = IsFormatted ? BindlessDescriptorHeapVk::BINDING_STORAGE_TEXEL_BUFFER : BindlessDescriptorHeapVk::BINDING_STORAGE_BUFFER;
+            break;
+
+        default:
+            return;
+    }
+
+    m_BindlessIndex = pBindlessHeap->AllocateIndex(m_BindlessBinding);
+    if (m_BindlessIndex == INVALID_BINDLESS_INDEX)
+        return;
+
+    if (IsFormatted)
+        pBindlessHeap->WriteTexelBuffer(m_BindlessBinding, m_BindlessIndex, m_BuffView);
+    else
+        pBindlessHeap->WriteBuffer(m_BindlessIndex, pBufferVk->GetVkBuffer(), m_Desc.ByteOffset, m_Desc.ByteWidth);
 }
 
 BufferViewVkImpl::~BufferViewVkImpl()
 {
-    m_pDevice->SafeReleaseDeviceObject(std::move(m_BuffView), m_pBuffer->GetDesc().ImmediateContextMask);
+    const auto ImmediateContextMask = m_pBuffer->GetDesc().ImmediateContextMask;
+    if (m_BindlessIndex != INVALID_BINDLESS_INDEX)
+        m_pDevice->GetBindlessHeap()->ReleaseIndex(m_BindlessBinding, m_BindlessIndex, ImmediateContextMask);
+
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_BuffView), ImmediateContextMask);
 }
 
 } // namespace Diligent
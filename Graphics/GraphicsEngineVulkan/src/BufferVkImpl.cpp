@@ -31,6 +31,7 @@
 #include "DeviceContextVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "BufferViewVkImpl.hpp"
+#include "ResourceHeapVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
@@ -44,7 +45,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                            FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                            RenderDeviceVkImpl*        pRenderDeviceVk,
                            const BufferDesc&          BuffDesc,
-                           const BufferData*          pBuffData /*= nullptr*/) :
+                           const BufferData*          pBuffData /*= nullptr*/,
+                           ResourceHeapVkImpl*        pHeap /*= nullptr*/,
+                           Uint64                     HeapOffset /*= 0*/) :
     // clang-format off
     TBufferBase
     {
@@ -78,97 +81,29 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
     const auto& DeviceLimits   = PhysicalDevice.GetProperties().limits;
     m_DynamicOffsetAlignment   = std::max(Uint32{4}, static_cast<Uint32>(DeviceLimits.optimalBufferCopyOffsetAlignment));
 
-    VkBufferCreateInfo VkBuffCI{};
-    VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    VkBuffCI.pNext = nullptr;
-    VkBuffCI.flags = 0; // VK_BUFFER_CREATE_SPARSE_BINDING_BIT, VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT, VK_BUFFER_CREATE_SPARSE_ALIASED_BIT
-    VkBuffCI.size  = m_Desc.uiSizeInBytes;
-    VkBuffCI.usage =
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | // The buffer can be used as the source of a transfer command
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT;  // The buffer can be used as the destination of a transfer command
-
-    static_assert(BIND_FLAGS_LAST == 0x400, "Please update this function to handle the new bind flags");
-
-    for (auto BindFlags = m_Desc.BindFlags; BindFlags != 0;)
+    if (m_Desc.BindFlags & (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS))
     {
-        auto BindFlag = ExtractLSB(BindFlags);
-        switch (BindFlag)
+        if (m_Desc.Mode == BUFFER_MODE_FORMATTED)
         {
-            case BIND_SHADER_RESOURCE:
-            {
-                if (m_Desc.Mode == BUFFER_MODE_FORMATTED)
-                {
-                    // Formatted buffers are mapped to uniform texel buffers in Vulkan.
-                    VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minTexelBufferOffsetAlignment));
-                }
-                else
-                {
-                    // Structured and ByteAddress buffers are mapped to read-only storage buffers in Vulkan.
-                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minStorageBufferOffsetAlignment));
-                }
-
-                break;
-            }
-            case BIND_UNORDERED_ACCESS:
-            {
-                if (m_Desc.Mode == BUFFER_MODE_FORMATTED)
-                {
-                    // RW formatted buffers are mapped to storage texel buffers in Vulkan.
-                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minTexelBufferOffsetAlignment));
-                }
-                else
-                {
-                    // RWStructured and RWByteAddress buffers are mapped to storage buffers in Vulkan.
-                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-                    // Each element of pDynamicOffsets of vkCmdBindDescriptorSets function which corresponds to a descriptor
-                    // binding with type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC must be a multiple of
-                    // VkPhysicalDeviceLimits::minStorageBufferOffsetAlignment (13.2.5)
-                    m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minStorageBufferOffsetAlignment));
-                }
-
-                break;
-            }
-            case BIND_VERTEX_BUFFER:
-            {
-                VkBuffCI.usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-                break;
-            }
-            case BIND_INDEX_BUFFER:
-            {
-                VkBuffCI.usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-                break;
-            }
-            case BIND_INDIRECT_DRAW_ARGS:
-            {
-                VkBuffCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
-                break;
-            }
-            case BIND_UNIFORM_BUFFER:
-            {
-                VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-
-                // Each element of pDynamicOffsets parameter of vkCmdBindDescriptorSets function which corresponds to a descriptor
-                // binding with type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC must be a multiple of
-                // VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment (13.2.5)
-                m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minUniformBufferOffsetAlignment));
-                break;
-            }
-            case BIND_RAY_TRACING:
-            {
-                VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; // for scratch buffer
-                VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-                VkBuffCI.usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR; // acceleration structure build inputs such as vertex, index, transform, aabb, and instance data
-                VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR;
-                break;
-            }
-            default:
-                UNEXPECTED("unsupported buffer binding type");
-                break;
+            // Formatted buffers are mapped to uniform or storage texel buffers in Vulkan.
+            m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minTexelBufferOffsetAlignment));
+        }
+        else
+        {
+            // Structured and ByteAddress buffers are mapped to storage buffers in Vulkan.
+            // Each element of pDynamicOffsets of vkCmdBindDescriptorSets function which corresponds to a descriptor
+            // binding with type VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC must be a multiple of
+            // VkPhysicalDeviceLimits::minStorageBufferOffsetAlignment (13.2.5)
+            m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minStorageBufferOffsetAlignment));
         }
     }
+    if (m_Desc.BindFlags & BIND_UNIFORM_BUFFER)
+    {
+        // Each element of pDynamicOffsets parameter of vkCmdBindDescriptorSets function which corresponds to a descriptor
+        // binding with type VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC must be a multiple of
+        // VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment (13.2.5)
+        m_DynamicOffsetAlignment = std::max(m_DynamicOffsetAlignment, static_cast<Uint32>(DeviceLimits.minUniformBufferOffsetAlignment));
+    }
 
     if (m_Desc.Usage == USAGE_DYNAMIC)
     {
@@ -176,21 +111,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         m_DynamicData.resize(CtxCount);
     }
 
-    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode of the buffer when it is accessed by multiple queue families.
-    VkBuffCI.queueFamilyIndexCount = 0;                         // The number of entries in the pQueueFamilyIndices array.
-    VkBuffCI.pQueueFamilyIndices   = nullptr;                   // The list of queue families that will access this buffer
-                                                                // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+    std::vector<uint32_t> QueueFamilyIndices;
 
-    const auto QueueFamilyIndices = PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) > 1 ?
-        GetDevice()->ConvertCmdQueueIdsToQueueFamilies(m_Desc.ImmediateContextMask) :
-        std::vector<uint32_t>{};
-    if (QueueFamilyIndices.size() > 1)
-    {
-        // If sharingMode is VK_SHARING_MODE_CONCURRENT, queueFamilyIndexCount must be greater than 1
-        VkBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
-        VkBuffCI.pQueueFamilyIndices   = QueueFamilyIndices.data();
-        VkBuffCI.queueFamilyIndexCount = static_cast<uint32_t>(QueueFamilyIndices.size());
-    }
+    const auto VkBuffCI = GetBufferCreateInfo(pRenderDeviceVk, m_Desc, QueueFamilyIndices);
 
     constexpr VkBufferUsageFlags UsageThatRequiresBackingBuffer =
         VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT |
@@ -229,6 +152,20 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         // Dynamic buffer memory is always host-coherent
         m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
     }
+    else if (m_Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE)
+    {
+        if (pHeap != nullptr)
+            LOG_ERROR_AND_THROW("Sparse buffers can not be placed in a resource heap");
+
+        m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+
+        // Sparse buffer has no memory backing. Memory is bound to its blocks by IDeviceContext::UpdateTileMappings().
+        // The alignment of the memory requirements is the sparse block size (32.7.1).
+        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+        m_SparseBlockSize            = static_cast<Uint32>(MemReqs.alignment);
+
+        SetState(RESOURCE_STATE_UNDEFINED);
+    }
     else
     {
         VERIFY(m_Desc.Usage != USAGE_DYNAMIC || PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) <= 1,
@@ -236,7 +173,8 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
 
-        VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
+        bool                 DedicatedAllocation = false;
+        VkMemoryRequirements MemReqs             = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer, DedicatedAllocation);
 
         static constexpr auto InvalidMemoryTypeIndex = VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex;
 
@@ -253,23 +191,35 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
                 case USAGE_UNIFIED:
                 case USAGE_STAGING:
+                {
                     vkMemoryFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
 
                     if (m_Desc.Usage == USAGE_UNIFIED)
                         vkMemoryFlags |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-                    if ((m_Desc.CPUAccessFlags & CPU_ACCESS_READ) != 0)
-                        vkMemoryFlags |= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
-
-                    // Try to find coherent memory first
-                    vkMemoryFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-                    MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, vkMemoryFlags);
-                    if (MemoryTypeIndex == InvalidMemoryTypeIndex)
-                    {
-                        // Use non-coherent memory
-                        vkMemoryFlags &= ~VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-                    }
+                    // Reading uncached memory on the CPU is very slow, so for readback buffers we prefer
+                    // cached memory, even if it is not coherent. Buffers that are only written by the CPU
+                    // do not benefit from caching and use coherent memory when it is available.
+                    const VkMemoryPropertyFlags ReadbackFlags[] =
+                        {
+                            VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                            VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT //
+                        };
+                    const VkMemoryPropertyFlags UploadFlags[] =
+                        {
+                            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT //
+                        };
+
+                    const bool IsReadback = (m_Desc.CPUAccessFlags & CPU_ACCESS_READ) != 0;
+
+                    const auto* pExtraFlags   = IsReadback ? ReadbackFlags : UploadFlags;
+                    const auto  NumExtraFlags = IsReadback ? _countof(ReadbackFlags) : _countof(UploadFlags);
+                    for (size_t i = 0; i < NumExtraFlags && MemoryTypeIndex == InvalidMemoryTypeIndex; ++i)
+                        MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, vkMemoryFlags | pExtraFlags[i]);
+                    // If none of the preferred types is available, plain host-visible memory is used below
                     break;
+                }
 
                 default:
                     UNEXPECTED("Unexpected usage");
@@ -277,8 +227,15 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
             if (MemoryTypeIndex == InvalidMemoryTypeIndex)
                 MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, vkMemoryFlags);
 
-            if (vkMemoryFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
-                m_MemoryProperties |= MEMORY_PROPERTY_HOST_COHERENT;
+            if (MemoryTypeIndex != InvalidMemoryTypeIndex)
+            {
+                // The selected memory type may have more properties than requested
+                const auto MemTypeFlags = PhysicalDevice.GetMemoryProperties().memoryTypes[MemoryTypeIndex].propertyFlags;
+                if (MemTypeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+                    m_MemoryProperties |= MEMORY_PROPERTY_HOST_COHERENT;
+                if (MemTypeFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT)
+                    m_MemoryProperties |= MEMORY_PROPERTY_HOST_CACHED;
+            }
         }
 
         VkMemoryAllocateFlags AllocateFlags = 0;
@@ -309,13 +266,41 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
 
         VERIFY(IsPowerOfTwo(RequiredAlignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags);
+        if (pHeap != nullptr)
+        {
+            // The buffer is placed in the heap memory that may be aliased by other resources.
+            VERIFY(m_Desc.Usage == USAGE_DEFAULT, "Only default buffers can be placed in a heap, this error should've been handled by the heap");
+            if ((MemReqs.memoryTypeBits & (1u << pHeap->GetMemoryTypeIndex())) == 0)
+                LOG_ERROR_AND_THROW("Memory type of resource heap '", pHeap->GetDesc().Name, "' is not compatible with buffer '", m_Desc.Name, "'");
+            if ((HeapOffset % RequiredAlignment) != 0)
+                LOG_ERROR_AND_THROW("Heap offset ", HeapOffset, " of buffer '", m_Desc.Name, "' is not a multiple of the required alignment (", RequiredAlignment, ")");
 
-        m_BufferMemoryAlignedOffset = AlignUp(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, RequiredAlignment);
-        VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+            m_BufferMemoryAlignedOffset = HeapOffset;
+
+            auto err = LogicalDevice.BindBufferMemory(m_VulkanBuffer, pHeap->GetVkDeviceMemory(), m_BufferMemoryAlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+
+            m_pHeap = pHeap;
+        }
+        else
+        {
+            VulkanUtilities::VulkanDedicatedResource DedicatedResource;
+            if (DedicatedAllocation)
+                DedicatedResource.Buffer = m_VulkanBuffer;
+
+            // Device-local buffers used only by contexts that run on a subset of the device group nodes are allocated on these nodes
+            const auto DeviceMask = (m_Desc.Usage != USAGE_STAGING && m_Desc.Usage != USAGE_UNIFIED) ?
+                pRenderDeviceVk->GetMemoryDeviceMask(m_Desc.ImmediateContextMask) :
+                0u;
+
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs.size, RequiredAlignment, MemoryTypeIndex, AllocateFlags, DedicatedResource, DeviceMask, m_Desc.MemoryPriority);
+
+            m_BufferMemoryAlignedOffset = AlignUp(VkDeviceSize{m_MemoryAllocation.UnalignedOffset}, RequiredAlignment);
+            VERIFY(m_MemoryAllocation.Size >= MemReqs.size + (m_BufferMemoryAlignedOffset - m_MemoryAllocation.UnalignedOffset), "Size of memory allocation is too small");
+            auto Memory = m_MemoryAllocation.Page->GetVkMemory();
+            auto err    = LogicalDevice.BindBufferMemory(m_VulkanBuffer, Memory, m_BufferMemoryAlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+        }
 
 #ifdef DILIGENT_DEBUG
         if ((m_Desc.BindFlags & BIND_RAY_TRACING) != 0)
@@ -388,63 +373,65 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                     ValidatedCast<DeviceContextVkImpl>(pBuffData->pContext)->GetCommandQueueId() :
                     SoftwareQueueIndex{PlatformMisc::GetLSB(m_Desc.ImmediateContextMask)};
 
-                VulkanUtilities::CommandPoolWrapper CmdPool;
-                VkCommandBuffer                     vkCmdBuff;
-                pRenderDeviceVk->AllocateTransientCmdPool(CmdQueueInd, CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
-                const auto SupportedStagesMask = ~0u;
-                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, SupportedStagesMask);
                 InitialState              = RESOURCE_STATE_COPY_DEST;
                 VkAccessFlags AccessFlags = ResourceStateFlagsToVkAccessFlags(InitialState);
                 VERIFY_EXPR(AccessFlags == VK_ACCESS_TRANSFER_WRITE_BIT);
-                VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, m_VulkanBuffer, 0, AccessFlags, SupportedStagesMask);
-
-                // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-                // as copy will be the only command in the cmd buffer
-                VkBufferCopy BuffCopy{};
-                BuffCopy.srcOffset = 0;
-                BuffCopy.dstOffset = 0;
-                BuffCopy.size      = VkBuffCI.size;
-                vkCmdCopyBuffer(vkCmdBuff, StagingBuffer, m_VulkanBuffer, 1, &BuffCopy);
-
-                pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, vkCmdBuff, std::move(CmdPool));
-
-
-                // After command buffer is submitted, safe-release staging resources. This strategy
-                // is little overconservative as the resources will only be released after the
-                // first command buffer submitted through the immediate context is complete
-
-                // Next Cmd Buff| Next Fence |               This Thread                      |           Immediate Context
-                //              |            |                                                |
-                //      N       |     F      |                                                |
-                //              |            |                                                |
-                //              |            |  ExecuteAndDisposeTransientCmdBuff(vkCmdBuff)  |
-                //              |            |  - SubmittedCmdBuffNumber = N                  |
-                //              |            |  - SubmittedFenceValue = F                     |
-                //     N+1 -  - | -  F+1  -  |                                                |
-                //              |            |  Release(StagingBuffer)                        |
-                //              |            |  - {N+1, StagingBuffer} -> Stale Objects       |
-                //              |            |                                                |
-                //              |            |                                                |
-                //              |            |                                                | ExecuteCommandBuffer()
-                //              |            |                                                | - SubmittedCmdBuffNumber = N+1
-                //              |            |                                                | - SubmittedFenceValue = F+1
-                //     N+2 -  - | -  F+2  -  |  -   -   -   -   -   -   -   -   -   -   -   - |
-                //              |            |                                                | - DiscardStaleVkObjects(N+1, F+1)
-                //              |            |                                                |   - {F+1, StagingBuffer} -> Release Queue
-                //              |            |                                                |
-
-                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{CmdQueueInd});
-                pRenderDeviceVk->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{CmdQueueInd});
+
+                // The copy is recorded into the shared command buffer that is submitted together with
+                // initial data uploads of other resources. The batch takes ownership of the staging
+                // resources and releases them once the GPU completes the copy.
+                const VkBuffer vkStagingBuffer = StagingBuffer;
+                const VkBuffer vkDstBuffer     = m_VulkanBuffer;
+                const auto     BufferSize      = VkBuffCI.size;
+                pRenderDeviceVk->RecordInitialDataUpload(
+                    CmdQueueInd, std::move(StagingBuffer), std::move(StagingMemoryAllocation),
+                    [&](VkCommandBuffer vkCmdBuff) //
+                    {
+                        const auto SupportedStagesMask = ~0u;
+                        VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkStagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, SupportedStagesMask);
+                        VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkDstBuffer, 0, AccessFlags, SupportedStagesMask);
+
+                        // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+                        // as the batch command buffer only contains copy commands
+                        VkBufferCopy BuffCopy{};
+                        BuffCopy.srcOffset = 0;
+                        BuffCopy.dstOffset = 0;
+                        BuffCopy.size      = BufferSize;
+                        vkCmdCopyBuffer(vkCmdBuff, vkStagingBuffer, vkDstBuffer, 1, &BuffCopy);
+                    });
+                m_bInitialDataUploadRecorded = true;
             }
         }
 
         SetState(InitialState);
     }
 
+    m_VkUsageFlags = VkBuffCI.usage;
+
+    // In descriptor buffer mode, the address is also used to write buffer descriptors
+    if (m_VkUsageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        m_DeviceAddress = GetVkDeviceAddress();
+    if (pRenderDeviceVk->GetMemoryDefragmentationBudget() != 0 && IsRelocatable())
+        pRenderDeviceVk->RegisterRelocatableBuffer(*this);
+
     VERIFY_EXPR(IsInKnownState());
 }
 
+bool BufferVkImpl::IsRelocatable() const
+{
+    // Vertex, index and indirect argument buffers are never written to descriptor sets
+    // and their handles are requested by the device context every time they are bound.
+    // Device addresses may be stored by the application, so buffers that expose them are never relocated.
+    constexpr BIND_FLAGS RelocatableBindFlags = BIND_VERTEX_BUFFER | BIND_INDEX_BUFFER | BIND_INDIRECT_DRAW_ARGS;
+
+    return (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+        (m_Desc.BindFlags & ~RelocatableBindFlags) == 0 &&
+        (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS) == 0 &&
+        PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) == 1 &&
+        m_MemoryAllocation.Page != nullptr &&
+        !m_MemoryAllocation.Page->IsDedicated();
+}
+
 
 BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                            FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
@@ -466,10 +453,143 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 // clang-format on
 {
     SetState(InitialState);
+
+    // The buffer must have been created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+    if (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS)
+        m_DeviceAddress = GetVkDeviceAddress();
+}
+
+VkBufferCreateInfo BufferVkImpl::GetBufferCreateInfo(const RenderDeviceVkImpl* pDevice,
+                                                    const BufferDesc&         Desc,
+                                                    std::vector<uint32_t>&    QueueFamilyIndices)
+{
+    VkBufferCreateInfo VkBuffCI{};
+    VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext = nullptr;
+    VkBuffCI.flags = 0;
+    if (Desc.MiscFlags & MISC_BUFFER_FLAG_SPARSE)
+        VkBuffCI.flags |= VK_BUFFER_CREATE_SPARSE_BINDING_BIT | VK_BUFFER_CREATE_SPARSE_RESIDENCY_BIT;
+    VkBuffCI.size  = Desc.uiSizeInBytes;
+    VkBuffCI.usage =
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | // The buffer can be used as the source of a transfer command
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT;  // The buffer can be used as the destination of a transfer command
+    if (Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS)
+        VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+    static_assert(BIND_FLAGS_LAST == 0x400, "Please update this function to handle the new bind flags");
+
+    for (auto BindFlags = Desc.BindFlags; BindFlags != 0;)
+    {
+        auto BindFlag = ExtractLSB(BindFlags);
+        switch (BindFlag)
+        {
+            case BIND_SHADER_RESOURCE:
+            {
+                if (Desc.Mode == BUFFER_MODE_FORMATTED)
+                {
+                    // Formatted buffers are mapped to uniform texel buffers in Vulkan.
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT;
+                }
+                else
+                {
+                    // Structured and ByteAddress buffers are mapped to read-only storage buffers in Vulkan.
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+                }
+
+                break;
+            }
+            case BIND_UNORDERED_ACCESS:
+            {
+                if (Desc.Mode == BUFFER_MODE_FORMATTED)
+                {
+                    // RW formatted buffers are mapped to storage texel buffers in Vulkan.
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+                }
+                else
+                {
+                    // RWStructured and RWByteAddress buffers are mapped to storage buffers in Vulkan.
+                    VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+                }
+
+                break;
+            }
+            case BIND_VERTEX_BUFFER:
+            {
+                VkBuffCI.usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+                break;
+            }
+            case BIND_INDEX_BUFFER:
+            {
+                VkBuffCI.usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+                break;
+            }
+            case BIND_INDIRECT_DRAW_ARGS:
+            {
+                VkBuffCI.usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+                break;
+            }
+            case BIND_UNIFORM_BUFFER:
+            {
+                VkBuffCI.usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+                break;
+            }
+            case BIND_RAY_TRACING:
+            {
+                VkBuffCI.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; // for scratch buffer
+                VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+                VkBuffCI.usage |= VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR; // acceleration structure build inputs such as vertex, index, transform, aabb, and instance data
+                VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_BINDING_TABLE_BIT_KHR;
+                break;
+            }
+            default:
+                UNEXPECTED("unsupported buffer binding type");
+                break;
+        }
+    }
+
+    if (pDevice->GetDescriptorBuffer() != nullptr)
+    {
+        // Descriptors in descriptor buffers reference buffers by device address.
+        // Dynamic uniform buffers are suballocated from the dynamic heap, which has its own address.
+        constexpr VkBufferUsageFlags DescriptorUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT |
+            VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT;
+        if ((VkBuffCI.usage & DescriptorUsage) != 0 ||
+            ((VkBuffCI.usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) != 0 && Desc.Usage != USAGE_DYNAMIC))
+            VkBuffCI.usage |= VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
+
+    VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE; // Sharing mode of the buffer when it is accessed by multiple queue families.
+    VkBuffCI.queueFamilyIndexCount = 0;                         // The number of entries in the pQueueFamilyIndices array.
+    VkBuffCI.pQueueFamilyIndices   = nullptr;                   // The list of queue families that will access this buffer
+                                                                // (ignored if sharingMode is not VK_SHARING_MODE_CONCURRENT).
+
+    QueueFamilyIndices.clear();
+    if (PlatformMisc::CountOneBits(Desc.ImmediateContextMask) > 1)
+        QueueFamilyIndices = pDevice->ConvertCmdQueueIdsToQueueFamilies(Desc.ImmediateContextMask);
+    if (QueueFamilyIndices.size() > 1)
+    {
+        // If sharingMode is VK_SHARING_MODE_CONCURRENT, queueFamilyIndexCount must be greater than 1
+        VkBuffCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        VkBuffCI.pQueueFamilyIndices   = QueueFamilyIndices.data();
+        VkBuffCI.queueFamilyIndexCount = static_cast<uint32_t>(QueueFamilyIndices.size());
+    }
+
+    return VkBuffCI;
 }
 
 BufferVkImpl::~BufferVkImpl()
 {
+    // Make sure the buffer is not relocated while it is being destroyed
+    if (m_RelocatableBufferIdx != InvalidRelocatableBufferIdx)
+        m_pDevice->UnregisterRelocatableBuffer(*this);
+
+    // The copy may still be pending in the upload batch. Submit the batch so that the buffer
+    // is released with a fence value that is greater than the one of the batch.
+    if (m_bInitialDataUploadRecorded)
+        m_pDevice->FlushInitialDataUploads();
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.ImmediateContextMask);
@@ -547,6 +667,19 @@ VkBuffer BufferVkImpl::GetVkBuffer() const
     }
 }
 
+VkDeviceAddress BufferVkImpl::GetDescriptorAddress(DeviceContextIndex CtxId, DeviceContextVkImpl* pCtx) const
+{
+    if (m_VulkanBuffer != VK_NULL_HANDLE)
+    {
+        VERIFY(m_DeviceAddress != 0, "Buffer '", m_Desc.Name, "' was not created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT");
+        return m_DeviceAddress;
+    }
+    else
+    {
+        return m_pDevice->GetDynamicMemoryManager().GetDeviceAddress() + GetDynamicOffset(CtxId, pCtx);
+    }
+}
+
 void BufferVkImpl::SetAccessFlags(VkAccessFlags AccessFlags)
 {
     SetState(VkAccessFlagsToResourceStates(AccessFlags));
@@ -561,7 +694,10 @@ VkDeviceAddress BufferVkImpl::GetVkDeviceAddress() const
 {
     constexpr auto DeviceAddressFlags = BIND_RAY_TRACING;
 
-    if (m_VulkanBuffer != VK_NULL_HANDLE && (m_Desc.BindFlags & DeviceAddressFlags) != 0)
+    if (m_VulkanBuffer != VK_NULL_HANDLE &&
+        ((m_Desc.BindFlags & DeviceAddressFlags) != 0 ||
+         (m_Desc.MiscFlags & MISC_BUFFER_FLAG_DEVICE_ADDRESS) != 0 ||
+         (m_VkUsageFlags & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) != 0))
     {
 #if DILIGENT_USE_VOLK
         VkBufferDeviceAddressInfoKHR BufferInfo = {};
@@ -39,25 +39,31 @@ CommandPoolManager::CommandPoolManager(const CreateInfo& CI) noexcept :
     m_Name            {std::move(CI.Name)  },
     m_QueueFamilyIndex{CI.queueFamilyIndex },
     m_CmdPoolFlags    {CI.flags            },
-    m_CmdPools        (STD_ALLOCATOR_RAW_MEM(VulkanUtilities::CommandPoolWrapper, GetRawAllocator(), "Allocator for deque<VulkanUtilities::CommandPoolWrapper>"))
+    m_CmdPools        (STD_ALLOCATOR_RAW_MEM(PooledCmdPool, GetRawAllocator(), "Allocator for deque<PooledCmdPool>"))
 // clang-format on
 {
 }
 
-VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(const char* DebugName)
+VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(VkCommandBuffer& vkCmdBuff, const char* DebugName)
 {
-    std::lock_guard<std::mutex> LockGuard{m_Mutex};
-
     VulkanUtilities::CommandPoolWrapper CmdPool;
-    if (!m_CmdPools.empty())
+    vkCmdBuff = VK_NULL_HANDLE;
     {
-        CmdPool = std::move(m_CmdPools.front());
-        m_CmdPools.pop_front();
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+        if (!m_CmdPools.empty())
+        {
+            CmdPool   = std::move(m_CmdPools.front().Pool);
+            vkCmdBuff = m_CmdPools.front().vkCmdBuff;
+            m_CmdPools.pop_front();
+        }
+    }
 
+    if (CmdPool != VK_NULL_HANDLE)
+    {
+        // Resetting the pool moves all its command buffers to the initial state
         m_LogicalDevice.ResetCommandPool(CmdPool);
     }
-
-    if (CmdPool == VK_NULL_HANDLE)
+    else
     {
         VkCommandPoolCreateInfo CmdPoolCI = {};
 
@@ -70,6 +76,19 @@ VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(cons
         DEV_CHECK_ERR(CmdPool != VK_NULL_HANDLE, "Failed to create Vulkan command pool");
     }
 
+    if (vkCmdBuff == VK_NULL_HANDLE)
+    {
+        VkCommandBufferAllocateInfo BuffAllocInfo{};
+        BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        BuffAllocInfo.pNext              = nullptr;
+        BuffAllocInfo.commandPool        = CmdPool;
+        BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        BuffAllocInfo.commandBufferCount = 1;
+
+        vkCmdBuff = m_LogicalDevice.AllocateVkCommandBuffer(BuffAllocInfo);
+        DEV_CHECK_ERR(vkCmdBuff != VK_NULL_HANDLE, "Failed to allocate Vulkan command buffer");
+    }
+
     VulkanUtilities::SetCommandPoolName(m_LogicalDevice.GetVkDevice(), CmdPool, DebugName);
 
 #ifdef DILIGENT_DEVELOPMENT
@@ -78,13 +97,15 @@ VulkanUtilities::CommandPoolWrapper CommandPoolManager::AllocateCommandPool(cons
     return CmdPool;
 }
 
-void CommandPoolManager::RecycleCommandPool(VulkanUtilities::CommandPoolWrapper&& CmdPool)
+void CommandPoolManager::RecycleCommandPool(VulkanUtilities::CommandPoolWrapper&& CmdPool, VkCommandBuffer vkCmdBuff)
 {
     std::lock_guard<std::mutex> LockGuard{m_Mutex};
 #ifdef DILIGENT_DEVELOPMENT
     --m_AllocatedPoolCounter;
 #endif
-    m_CmdPools.emplace_back(std::move(CmdPool));
+    m_CmdPools.emplace_back();
+    m_CmdPools.back().Pool      = std::move(CmdPool);
+    m_CmdPools.back().vkCmdBuff = vkCmdBuff;
 }
 
 void CommandPoolManager::DestroyPools()
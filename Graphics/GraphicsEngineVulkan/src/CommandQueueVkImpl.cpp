@@ -29,8 +29,10 @@
 #include <thread>
 
 #include "CommandQueueVkImpl.hpp"
+#include "ProfilerHooks.hpp"
 #include "RenderDeviceVkImpl.hpp"
 #include "VulkanUtilities/VulkanDebug.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -40,6 +42,7 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
                                        SoftwareQueueIndex                                    CommandQueueId,
                                        Uint32                                                NumCommandQueues,
                                        Uint32                                                vkQueueIndex,
+                                       Uint32                                                NumNodes,
                                        const ImmediateContextCreateInfo&                     CreateInfo) :
     // clang-format off
     TBase{pRefCounters},
@@ -49,6 +52,7 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
     m_CommandQueueId            {static_cast<Uint8>(CommandQueueId)},
     m_SupportedTimelineSemaphore{LogicalDevice->GetEnabledExtFeatures().TimelineSemaphore.timelineSemaphore == VK_TRUE},
     m_NumCommandQueues          {static_cast<Uint8>(m_SupportedTimelineSemaphore ? 1u : NumCommandQueues)},
+    m_DeviceMask                {NumNodes > 1 ? (CreateInfo.NodeMask != 0 ? CreateInfo.NodeMask : (1u << NumNodes) - 1u) : 0u},
     m_NextFenceValue            {1},
     m_SyncObjectManager         {std::make_shared<VulkanUtilities::VulkanSyncObjectManager>(*LogicalDevice)},
     m_SyncPointAllocator        {GetRawAllocator(), SyncPointVk::SizeOf(m_NumCommandQueues), 16}
@@ -60,6 +64,12 @@ CommandQueueVkImpl::CommandQueueVkImpl(IReferenceCounters*
     if (CreateInfo.Name != nullptr)
         VulkanUtilities::SetQueueName(m_LogicalDevice->GetVkDevice(), m_VkQueue, CreateInfo.Name);
 
+    if (m_SupportedTimelineSemaphore)
+    {
+        // Fence value 0 is never signaled, so semaphore counter value 0 means that no submissions have been completed
+        m_TimelineSemaphore = m_LogicalDevice->CreateTimelineSemaphore(0, "Command queue timeline semaphore");
+    }
+
     m_TempSignalSemaphores.reserve(16);
 }
 
@@ -72,6 +82,7 @@ CommandQueueVkImpl::~CommandQueueVkImpl()
 
     m_pFence.Release();
     m_LastSyncPoint.reset();
+    m_TimelineSemaphore.Release();
 
     // Queues are created along with the logical device during vkCreateDevice.
     // All queues associated with the logical device are destroyed when vkDestroyDevice
@@ -82,10 +93,15 @@ SyncPointVk::SyncPointVk(SoftwareQueueIndex                        CommandQueueI
                          Uint32                                    NumContexts,
                          VulkanUtilities::VulkanSyncObjectManager& SyncObjectMngr,
                          VkDevice                                  LogicalDevice,
-                         Uint64                                    dbgValue) :
-    m_CommandQueueId{CommandQueueId},
-    m_NumSemaphores{static_cast<Uint8>(NumContexts)},
-    m_Fence{SyncObjectMngr.CreateFence()}
+                         VkSemaphore                               vkTimelineSemaphore,
+                         Uint64                                    Value) :
+    // clang-format off
+    m_CommandQueueId     {CommandQueueId},
+    m_NumSemaphores      {static_cast<Uint8>(NumContexts)},
+    m_Value              {Value},
+    m_vkTimelineSemaphore{vkTimelineSemaphore},
+    m_Fence              {vkTimelineSemaphore == VK_NULL_HANDLE ? SyncObjectMngr.CreateFence() : VulkanUtilities::VulkanRecycledFence{}}
+// clang-format on
 {
     VERIFY(m_CommandQueueId == CommandQueueId, "Not enough bits to store command queue index");
     VERIFY(m_NumSemaphores == NumContexts, "Not enough bits to store command queue count");
@@ -104,14 +120,15 @@ SyncPointVk::SyncPointVk(SoftwareQueueIndex                        CommandQueueI
     }
 
 #ifdef DILIGENT_DEBUG
-    String Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(dbgValue) + ")";
-    VulkanUtilities::SetFenceName(LogicalDevice, m_Fence, Name.c_str());
+    String Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(Value) + ")";
+    if (m_Fence)
+        VulkanUtilities::SetFenceName(LogicalDevice, m_Fence, Name.c_str());
 
     for (Uint32 s = 0; s < m_NumSemaphores; ++s)
     {
         if (m_Semaphores[s])
         {
-            Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(dbgValue) + ") Ctx (" + std::to_string(s) + ")";
+            Name = String{"Queue ("} + std::to_string(CommandQueueId) + ") Value (" + std::to_string(Value) + ") Ctx (" + std::to_string(s) + ")";
             VulkanUtilities::SetSemaphoreName(LogicalDevice, m_Semaphores[s], Name.c_str());
         }
     }
@@ -125,6 +142,42 @@ SyncPointVk::~SyncPointVk()
         m_Semaphores[s].~RecycledSyncObject();
 }
 
+VkResult SyncPointVk::GetStatus(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice) const
+{
+    if (m_vkTimelineSemaphore != VK_NULL_HANDLE)
+    {
+        Uint64 SemaphoreCounter = 0;
+        auto   err              = LogicalDevice.GetSemaphoreCounter(m_vkTimelineSemaphore, &SemaphoreCounter);
+        if (err != VK_SUCCESS)
+            return err;
+        return SemaphoreCounter >= m_Value ? VK_SUCCESS : VK_NOT_READY;
+    }
+    else
+    {
+        return LogicalDevice.GetFenceStatus(m_Fence);
+    }
+}
+
+VkResult SyncPointVk::Wait(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, Uint64 Timeout) const
+{
+    if (m_vkTimelineSemaphore != VK_NULL_HANDLE)
+    {
+        VkSemaphoreWaitInfo WaitInfo{};
+        WaitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        WaitInfo.pNext          = nullptr;
+        WaitInfo.flags          = 0;
+        WaitInfo.semaphoreCount = 1;
+        WaitInfo.pSemaphores    = &m_vkTimelineSemaphore;
+        WaitInfo.pValues        = &m_Value;
+        return LogicalDevice.WaitSemaphores(WaitInfo, Timeout);
+    }
+    else
+    {
+        VkFence vkFence = m_Fence;
+        return LogicalDevice.WaitForFences(1, &vkFence, VK_TRUE, Timeout);
+    }
+}
+
 __forceinline void SyncPointVk::GetSemaphores(std::vector<VkSemaphore>& Semaphores)
 {
     for (Uint32 s = 0; s < m_NumSemaphores; ++s)
@@ -134,7 +187,7 @@ __forceinline void SyncPointVk::GetSemaphores(std::vector<VkSemaphore>& Semaphor
     }
 }
 
-__forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue)
+__forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 Value)
 {
     auto* pAllocator = &m_SyncPointAllocator;
     void* ptr        = pAllocator->Allocate(SyncPointVk::SizeOf(m_NumCommandQueues), "SyncPointVk", __FILE__, __LINE__);
@@ -144,11 +197,13 @@ __forceinline SyncPointVkPtr CommandQueueVkImpl::CreateSyncPoint(Uint64 dbgValue
         pAllocator->Free(ptr);
     };
 
-    return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), dbgValue}, std::move(Deleter)};
+    return {new (ptr) SyncPointVk{m_CommandQueueId, m_NumCommandQueues, *m_SyncObjectManager, m_LogicalDevice->GetVkDevice(), m_TimelineSemaphore, Value}, std::move(Deleter)};
 }
 
 Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
 {
+    DILIGENT_PROFILE_SCOPE("CommandQueueVk::Submit");
+
     std::lock_guard<std::mutex> Lock{m_QueueMutex};
 
     // Increment the value before submitting the buffer to be overly safe
@@ -179,18 +234,82 @@ Uint64 CommandQueueVkImpl::Submit(const VkSubmitInfo& InSubmitInfo)
     SubmitInfo.signalSemaphoreCount = static_cast<Uint32>(m_TempSignalSemaphores.size());
     SubmitInfo.pSignalSemaphores    = m_TempSignalSemaphores.data();
 
-    const uint32_t SubmitCount =
+    // Execute the command buffers on the context's nodes unless the caller has provided the device masks
+    VkDeviceGroupSubmitInfo DeviceGroupSubmitInfo{};
+    if (m_DeviceMask != 0)
+    {
+        bool HasDeviceGroupInfo = false;
+        for (const auto* pNext = static_cast<const VkBaseInStructure*>(InSubmitInfo.pNext); pNext != nullptr; pNext = pNext->pNext)
+        {
+            if (pNext->sType == VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO)
+            {
+                HasDeviceGroupInfo = true;
+                break;
+            }
+        }
+
+        if (!HasDeviceGroupInfo)
+        {
+            // Semaphores are waited on and signaled by the lowest node in the mask
+            const Uint32 DeviceIndex = PlatformMisc::GetLSB(m_DeviceMask);
+
+            m_TempCmdBufferDeviceMasks.assign(SubmitInfo.commandBufferCount, m_DeviceMask);
+            m_TempSemaphoreDeviceIndices.assign(std::max(SubmitInfo.waitSemaphoreCount, SubmitInfo.signalSemaphoreCount), DeviceIndex);
+
+            DeviceGroupSubmitInfo.sType                         = VK_STRUCTURE_TYPE_DEVICE_GROUP_SUBMIT_INFO;
+            DeviceGroupSubmitInfo.pNext                         = SubmitInfo.pNext;
+            DeviceGroupSubmitInfo.waitSemaphoreCount            = SubmitInfo.waitSemaphoreCount;
+            DeviceGroupSubmitInfo.pWaitSemaphoreDeviceIndices   = m_TempSemaphoreDeviceIndices.data();
+            DeviceGroupSubmitInfo.commandBufferCount            = SubmitInfo.commandBufferCount;
+            DeviceGroupSubmitInfo.pCommandBufferDeviceMasks     = m_TempCmdBufferDeviceMasks.data();
+            DeviceGroupSubmitInfo.signalSemaphoreCount          = SubmitInfo.signalSemaphoreCount;
+            DeviceGroupSubmitInfo.pSignalSemaphoreDeviceIndices = m_TempSemaphoreDeviceIndices.data();
+
+            SubmitInfo.pNext = &DeviceGroupSubmitInfo;
+        }
+    }
+
+    const bool HasCommands =
         (SubmitInfo.waitSemaphoreCount != 0 ||
          SubmitInfo.commandBufferCount != 0 ||
-         SubmitInfo.signalSemaphoreCount != 0) ?
-        1 :
-        0;
+         SubmitInfo.signalSemaphoreCount != 0);
 
-    auto err = vkQueueSubmit(m_VkQueue, SubmitCount, &SubmitInfo, NewSyncPoint->GetFence());
-    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
-    (void)err;
+    if (m_TimelineSemaphore)
+    {
+        // Signal the queue timeline semaphore in a separate batch to avoid merging
+        // VkTimelineSemaphoreSubmitInfo with the one that may be provided by the caller.
+        // The first synchronization scope of the semaphore signal operation includes all
+        // commands that occur earlier in submission order, including the first batch.
+        VkTimelineSemaphoreSubmitInfo TimelineSemaphoreSubmitInfo{};
+        TimelineSemaphoreSubmitInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        TimelineSemaphoreSubmitInfo.pNext                     = nullptr;
+        TimelineSemaphoreSubmitInfo.signalSemaphoreValueCount = 1;
+        TimelineSemaphoreSubmitInfo.pSignalSemaphoreValues    = &FenceValue;
+
+        VkSemaphore vkTimelineSemaphore = m_TimelineSemaphore;
+
+        VkSubmitInfo SubmitInfos[2] = {SubmitInfo, {}};
+
+        auto& SignalInfo                = SubmitInfos[1];
+        SignalInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        SignalInfo.pNext                = &TimelineSemaphoreSubmitInfo;
+        SignalInfo.signalSemaphoreCount = 1;
+        SignalInfo.pSignalSemaphores    = &vkTimelineSemaphore;
+
+        auto err = HasCommands ?
+            vkQueueSubmit(m_VkQueue, 2, SubmitInfos, VK_NULL_HANDLE) :
+            vkQueueSubmit(m_VkQueue, 1, &SignalInfo, VK_NULL_HANDLE);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
+        (void)err;
+    }
+    else
+    {
+        auto err = vkQueueSubmit(m_VkQueue, HasCommands ? 1 : 0, &SubmitInfo, NewSyncPoint->m_Fence);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to submit command buffer to the command queue");
+        (void)err;
 
-    m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+        m_pFence->AddPendingSyncPoint(m_CommandQueueId, FenceValue, NewSyncPoint);
+    }
 
     // Update last sync point
     {
@@ -223,22 +342,54 @@ Uint64 CommandQueueVkImpl::SubmitCmdBuffer(VkCommandBuffer cmdBuffer)
 
 Uint64 CommandQueueVkImpl::WaitForIdle()
 {
+    DILIGENT_PROFILE_SCOPE("CommandQueueVk::WaitForIdle");
+
     std::lock_guard<std::mutex> Lock{m_QueueMutex};
 
     // Update last completed fence value to unlock all waiting events.
     const auto FenceValue = m_NextFenceValue.fetch_add(1);
 
     vkQueueWaitIdle(m_VkQueue);
-    // For some reason after idling the queue not all fences are signaled
-    m_pFence->Wait(UINT64_MAX);
-    m_pFence->Reset(FenceValue);
+
+    if (m_TimelineSemaphore)
+    {
+        // All previous submissions signal values less than FenceValue and have been completed,
+        // so the semaphore can be signaled from the host.
+        VkSemaphoreSignalInfo SignalInfo{};
+        SignalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        SignalInfo.pNext     = nullptr;
+        SignalInfo.semaphore = m_TimelineSemaphore;
+        SignalInfo.value     = FenceValue;
+
+        auto err = m_LogicalDevice->SignalSemaphore(SignalInfo);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to signal command queue timeline semaphore");
+        (void)err;
+    }
+    else
+    {
+        // For some reason after idling the queue not all fences are signaled
+        m_pFence->Wait(UINT64_MAX);
+        m_pFence->Reset(FenceValue);
+    }
 
     return FenceValue;
 }
 
 Uint64 CommandQueueVkImpl::GetCompletedFenceValue()
 {
-    return m_pFence->GetCompletedValue();
+    if (m_TimelineSemaphore)
+    {
+        // vkGetSemaphoreCounterValue is thread safe
+        Uint64 SemaphoreCounter = 0;
+        auto   err              = m_LogicalDevice->GetSemaphoreCounter(m_TimelineSemaphore, &SemaphoreCounter);
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get command queue timeline semaphore counter");
+        (void)err;
+        return SemaphoreCounter;
+    }
+    else
+    {
+        return m_pFence->GetCompletedValue();
+    }
 }
 
 void CommandQueueVkImpl::EnqueueSignalFence(VkFence vkFence)
@@ -286,8 +437,21 @@ void CommandQueueVkImpl::InternalSignalSemaphore(VkSemaphore vkTimelineSemaphore
 
 VkResult CommandQueueVkImpl::Present(const VkPresentInfoKHR& PresentInfo)
 {
+    DILIGENT_PROFILE_SCOPE("CommandQueueVk::Present");
+
     std::lock_guard<std::mutex> Lock{m_QueueMutex};
     return vkQueuePresentKHR(m_VkQueue, &PresentInfo);
 }
 
+void CommandQueueVkImpl::BindSparse(const VkBindSparseInfo& BindInfo)
+{
+    DILIGENT_PROFILE_SCOPE("CommandQueueVk::BindSparse");
+
+    std::lock_guard<std::mutex> Lock{m_QueueMutex};
+
+    auto err = vkQueueBindSparse(m_VkQueue, 1, &BindInfo, VK_NULL_HANDLE);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to bind sparse memory");
+    (void)err;
+}
+
 } // namespace Diligent
@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "DescriptorBufferVk.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+void DescriptorBufferAllocation::Release()
+{
+    if (pOwner != nullptr)
+    {
+        pOwner->Free(Offset, Size, CmdQueueMask);
+        Reset();
+    }
+}
+
+// The range is returned to the allocator when the release queue destroys the object
+struct DescriptorBufferVk::StaleRange
+{
+    // clang-format off
+    StaleRange(DescriptorBufferVk& _Owner, VkDeviceSize _Offset, VkDeviceSize _Size) :
+        pOwner{&_Owner },
+        Offset{_Offset },
+        Size  {_Size   }
+    {}
+
+    StaleRange             (const StaleRange&) = delete;
+    StaleRange& operator = (const StaleRange&) = delete;
+    StaleRange& operator = (      StaleRange&&)= delete;
+
+    StaleRange(StaleRange&& rhs)noexcept :
+        pOwner{rhs.pOwner},
+        Offset{rhs.Offset},
+        Size  {rhs.Size  }
+    {
+        rhs.pOwner = nullptr;
+    }
+    // clang-format on
+
+    ~StaleRange()
+    {
+        if (pOwner != nullptr)
+        {
+            std::lock_guard<std::mutex> Lock{pOwner->m_AllocationMtx};
+            pOwner->m_AllocationMgr.Free(Offset, Size);
+        }
+    }
+
+    DescriptorBufferVk* pOwner;
+    VkDeviceSize        Offset;
+    VkDeviceSize        Size;
+};
+
+DescriptorBufferVk::DescriptorBufferVk(RenderDeviceVkImpl& DeviceVkImpl, Uint32 Size) :
+    // clang-format off
+    m_DeviceVkImpl   {DeviceVkImpl},
+    m_OffsetAlignment{std::max(DeviceVkImpl.GetPhysicalDevice().GetExtProperties().DescriptorBuffer.descriptorBufferOffsetAlignment, VkDeviceSize{1})},
+    m_AllocationMgr  {Size, GetRawAllocator()}
+// clang-format on
+{
+    VERIFY_EXPR(Size > 0);
+
+    const auto& LogicalDevice  = DeviceVkImpl.GetLogicalDevice();
+    const auto& PhysicalDevice = DeviceVkImpl.GetPhysicalDevice();
+    const auto& DescrBufProps  = PhysicalDevice.GetExtProperties().DescriptorBuffer;
+
+    if (Size > DescrBufProps.maxResourceDescriptorBufferRange || Size > DescrBufProps.maxSamplerDescriptorBufferRange)
+    {
+        LOG_ERROR_AND_THROW("Descriptor buffer size (", Size, ") exceeds the maximum descriptor buffer range supported by the device (",
+                            std::min(DescrBufProps.maxResourceDescriptorBufferRange, DescrBufProps.maxSamplerDescriptorBufferRange), ").");
+    }
+
+    VkBufferCreateInfo VkBuffCI{};
+    VkBuffCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext       = nullptr;
+    VkBuffCI.flags       = 0;
+    VkBuffCI.size        = Size;
+    VkBuffCI.usage       = DescriptorBufferUsage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    m_VkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, "Global descriptor buffer");
+
+    const auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VkBuffer);
+
+    VkMemoryAllocateFlagsInfo FlagsInfo{};
+    FlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    FlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+    VkMemoryAllocateInfo MemAlloc{};
+    MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    MemAlloc.pNext           = &FlagsInfo;
+    MemAlloc.allocationSize  = MemReqs.size;
+    MemAlloc.memoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (MemAlloc.memoryTypeIndex == VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        LOG_ERROR_AND_THROW("Failed to find host-visible coherent memory type for the descriptor buffer");
+
+    m_BufferMemory = LogicalDevice.AllocateDeviceMemory(MemAlloc, "Global descriptor buffer memory");
+
+    void* pData = nullptr;
+
+    auto err = LogicalDevice.MapMemory(m_BufferMemory, 0, MemAlloc.allocationSize, 0, &pData);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to map descriptor buffer memory");
+    m_CPUAddress = static_cast<Uint8*>(pData);
+
+    err = LogicalDevice.BindBufferMemory(m_VkBuffer, m_BufferMemory, 0 /*offset*/);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind descriptor buffer memory");
+
+    m_DeviceAddress = LogicalDevice.GetBufferDeviceAddress(m_VkBuffer);
+    VERIFY((m_DeviceAddress % m_OffsetAlignment) == 0, "Descriptor buffer address is not properly aligned");
+
+    LOG_INFO_MESSAGE("Global descriptor buffer created. Total buffer size: ", FormatMemorySize(Size, 2));
+}
+
+DescriptorBufferVk::~DescriptorBufferVk()
+{
+    DEV_CHECK_ERR(m_AllocationMgr.GetUsedSize() == 0, m_AllocationMgr.GetUsedSize(),
+                  " bytes of the descriptor buffer have not been released. If there are outstanding references to the ranges in release queues, the app will crash when they are freed.");
+
+    if (m_BufferMemory)
+        m_DeviceVkImpl.GetLogicalDevice().UnmapMemory(m_BufferMemory);
+    m_CPUAddress = nullptr;
+}
+
+DescriptorBufferAllocation DescriptorBufferVk::Allocate(VkDeviceSize Size, Uint64 CmdQueueMask)
+{
+    VERIFY_EXPR(Size > 0);
+
+    // All allocation sizes are multiples of the offset alignment, so all offsets are aligned
+    Size = AlignUp(Size, m_OffsetAlignment);
+
+    VariableSizeAllocationsManager::Allocation Allocation;
+    {
+        std::lock_guard<std::mutex> Lock{m_AllocationMtx};
+        Allocation = m_AllocationMgr.Allocate(Size, m_OffsetAlignment);
+    }
+
+    if (!Allocation.IsValid())
+    {
+        LOG_ERROR_MESSAGE("Failed to allocate ", Size, " bytes from the global descriptor buffer. Increase EngineVkCreateInfo::DescriptorBufferSize.");
+        return DescriptorBufferAllocation{};
+    }
+    VERIFY((Allocation.UnalignedOffset % m_OffsetAlignment) == 0 && Allocation.Size == Size, "Descriptor buffer allocation is expected to be aligned");
+
+    return DescriptorBufferAllocation{*this, Allocation.UnalignedOffset, Allocation.Size, m_CPUAddress + Allocation.UnalignedOffset, CmdQueueMask};
+}
+
+void DescriptorBufferVk::Free(VkDeviceSize Offset, VkDeviceSize Size, Uint64 CmdQueueMask)
+{
+    m_DeviceVkImpl.SafeReleaseDeviceObject(StaleRange{*this, Offset, Size}, CmdQueueMask);
+}
+
+Uint32 DescriptorBufferVk::GetDescriptorSize(VkDescriptorType Type) const
+{
+    // Robust buffer access is never enabled, so non-robust descriptor sizes are used
+    const auto& Props = m_DeviceVkImpl.GetPhysicalDevice().GetExtProperties().DescriptorBuffer;
+    switch (Type)
+    {
+        // clang-format off
+        case VK_DESCRIPTOR_TYPE_SAMPLER:                    return static_cast<Uint32>(Props.samplerDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:     return static_cast<Uint32>(Props.combinedImageSamplerDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:              return static_cast<Uint32>(Props.sampledImageDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:              return static_cast<Uint32>(Props.storageImageDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:       return static_cast<Uint32>(Props.uniformTexelBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:       return static_cast<Uint32>(Props.storageTexelBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:             return static_cast<Uint32>(Props.uniformBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:             return static_cast<Uint32>(Props.storageBufferDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:           return static_cast<Uint32>(Props.inputAttachmentDescriptorSize);
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: return static_cast<Uint32>(Props.accelerationStructureDescriptorSize);
+        // clang-format on
+        default:
+            UNEXPECTED("Descriptor type ", Type, " can't be placed in a descriptor buffer");
+            return 0;
+    }
+}
+
+} // namespace Diligent
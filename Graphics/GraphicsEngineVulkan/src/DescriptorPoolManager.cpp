@@ -37,7 +37,7 @@ void DescriptorSetAllocation::Release()
     if (Set != VK_NULL_HANDLE)
     {
         VERIFY_EXPR(DescrSetAllocator != nullptr && Pool != VK_NULL_HANDLE);
-        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask);
+        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask, ShardIdx);
 
         Reset();
     }
@@ -64,6 +64,13 @@ static std::vector<VkDescriptorPoolSize> PrunePoolSizes(RenderDeviceVkImpl& Devi
     const auto& Feats = DeviceVkImpl.GetLogicalDevice().GetEnabledExtFeatures();
     for (auto iter = PoolSizes.begin(); iter != PoolSizes.end();)
     {
+        // descriptorCount must be greater than 0
+        if (iter->descriptorCount == 0)
+        {
+            iter = PoolSizes.erase(iter);
+            continue;
+        }
+
         switch (iter->type)
         {
             case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
@@ -193,40 +200,84 @@ static VkDescriptorSet AllocateDescriptorSet(const VulkanUtilities::VulkanLogica
 DescriptorSetAllocator::~DescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
+
+    size_t TotalPoolCount = 0;
+    for (const auto& shard : m_Shards)
+        TotalPoolCount += shard.Pools.size();
+
+    const auto Stats = GetStatistics();
+    LOG_INFO_MESSAGE(m_PoolName, " stats: allocated ", Stats.NumAllocations, " descriptor set(s) from ", TotalPoolCount,
+                     " pool(s); new pools created: ", Stats.NumPoolCreations, "; contended shard locks: ", Stats.NumContendedLocks);
+}
+
+Uint32 DescriptorSetAllocator::GetThreadShardIndex()
+{
+    static std::atomic<Uint32> NextShardIdx{0};
+    // Threads are assigned to shards in round-robin order the first time they allocate a set
+    thread_local const Uint32 ThreadShardIdx = NextShardIdx.fetch_add(1, std::memory_order_relaxed) % NumShards;
+    return ThreadShardIdx;
+}
+
+std::unique_lock<std::mutex> DescriptorSetAllocator::Shard::Lock(std::atomic<Uint64>& NumContendedLocks)
+{
+    std::unique_lock<std::mutex> ShardLock{Mtx, std::try_to_lock};
+    if (!ShardLock.owns_lock())
+    {
+        NumContendedLocks.fetch_add(1, std::memory_order_relaxed);
+        ShardLock.lock();
+    }
+    return ShardLock;
+}
+
+DescriptorSetAllocator::Statistics DescriptorSetAllocator::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.NumAllocations    = m_NumAllocations.load(std::memory_order_relaxed);
+    Stats.NumPoolCreations  = m_NumPoolCreations.load(std::memory_order_relaxed);
+    Stats.NumContendedLocks = m_NumContendedLocks.load(std::memory_order_relaxed);
+    return Stats;
 }
 
 DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    DILIGENT_PROFILE_SCOPE("DescriptorSetAllocator::Allocate");
+
+    m_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    const auto ShardIdx = GetThreadShardIndex();
+    auto&      shard    = m_Shards[ShardIdx];
+
     // Descriptor pools are externally synchronized, meaning that the application must not allocate
     // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    auto Lock = shard.Lock(m_NumContendedLocks);
 
     const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
-    // Try all pools starting from the frontmost
-    for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
+    // Try all pools of this shard starting from the frontmost
+    for (auto it = shard.Pools.begin(); it != shard.Pools.end(); ++it)
     {
         auto& Pool = *it;
         auto  Set  = AllocateDescriptorSet(LogicalDevice, Pool, SetLayout, DebugName);
         if (Set != VK_NULL_HANDLE)
         {
             // Move the pool to the front
-            if (it != m_Pools.begin())
+            if (it != shard.Pools.begin())
             {
-                std::swap(*it, m_Pools.front());
+                std::swap(*it, shard.Pools.front());
             }
 
 #ifdef DILIGENT_DEVELOPMENT
             ++m_AllocatedSetCounter;
 #endif
-            return {Set, Pool, CommandQueueMask, *this};
+            return {Set, Pool, CommandQueueMask, *this, ShardIdx};
         }
     }
 
     // Failed to allocate descriptor from existing pools -> create a new one
     LOG_INFO_MESSAGE("Allocated new descriptor pool");
-    m_Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+    m_NumPoolCreations.fetch_add(1, std::memory_order_relaxed);
+    shard.Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
 
-    auto& NewPool = m_Pools.front();
+    auto& NewPool = shard.Pools.front();
     auto  Set     = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
     DEV_CHECK_ERR(Set != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
@@ -234,10 +285,90 @@ DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask
     ++m_AllocatedSetCounter;
 #endif
 
-    return {Set, NewPool, CommandQueueMask, *this};
+    return {Set, NewPool, CommandQueueMask, *this, ShardIdx};
 }
 
-void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
+void DescriptorSetAllocator::Allocate(Uint64                   CommandQueueMask,
+                                      VkDescriptorSetLayout    SetLayout,
+                                      Uint32                   NumSets,
+                                      DescriptorSetAllocation* pAllocations,
+                                      const char*              DebugName)
+{
+    DILIGENT_PROFILE_SCOPE("DescriptorSetAllocator::Allocate");
+
+    if (NumSets == 0)
+        return;
+
+    VERIFY_EXPR(pAllocations != nullptr);
+    m_NumAllocations.fetch_add(NumSets, std::memory_order_relaxed);
+
+    const auto ShardIdx = GetThreadShardIndex();
+    auto&      shard    = m_Shards[ShardIdx];
+
+    const std::vector<VkDescriptorSetLayout> Layouts(NumSets, SetLayout);
+    std::vector<VkDescriptorSet>             Sets(NumSets);
+
+    const auto& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+
+    Uint32 NumAllocated = 0;
+    // Allocates as many of the remaining sets as possible from the pool
+    auto AllocateFromPool = [&](VkDescriptorPool Pool) {
+        VkDescriptorSetAllocateInfo DescrSetAllocInfo = {};
+
+        DescrSetAllocInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        DescrSetAllocInfo.pNext              = nullptr;
+        DescrSetAllocInfo.descriptorPool     = Pool;
+        DescrSetAllocInfo.descriptorSetCount = NumSets - NumAllocated;
+        DescrSetAllocInfo.pSetLayouts        = Layouts.data();
+
+        Uint32 NumNewSets = 0;
+        if (LogicalDevice.AllocateVkDescriptorSets(DescrSetAllocInfo, &Sets[NumAllocated], DebugName))
+        {
+            NumNewSets = DescrSetAllocInfo.descriptorSetCount;
+        }
+        else
+        {
+            // vkAllocateDescriptorSets is all-or-nothing. Fill the rest of the pool one set at a time.
+            while (NumAllocated + NumNewSets < NumSets)
+            {
+                auto Set = AllocateDescriptorSet(LogicalDevice, Pool, SetLayout, DebugName);
+                if (Set == VK_NULL_HANDLE)
+                    break;
+                Sets[NumAllocated + NumNewSets++] = Set;
+            }
+        }
+
+        for (Uint32 i = 0; i < NumNewSets; ++i, ++NumAllocated)
+            pAllocations[NumAllocated] = DescriptorSetAllocation{Sets[NumAllocated], Pool, CommandQueueMask, *this, ShardIdx};
+
+#ifdef DILIGENT_DEVELOPMENT
+        m_AllocatedSetCounter += static_cast<int32_t>(NumNewSets);
+#endif
+        return NumNewSets;
+    };
+
+    // Descriptor pools are externally synchronized, meaning that the application must not allocate
+    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+    auto Lock = shard.Lock(m_NumContendedLocks);
+
+    for (auto it = shard.Pools.begin(); it != shard.Pools.end() && NumAllocated < NumSets; ++it)
+        AllocateFromPool(*it);
+
+    while (NumAllocated < NumSets)
+    {
+        // Failed to allocate descriptors from existing pools -> create a new one
+        LOG_INFO_MESSAGE("Allocated new descriptor pool");
+        m_NumPoolCreations.fetch_add(1, std::memory_order_relaxed);
+        shard.Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+        if (AllocateFromPool(shard.Pools.front()) == 0)
+        {
+            DEV_ERROR("Failed to allocate descriptor set");
+            break;
+        }
+    }
+}
+
+void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask, Uint32 ShardIdx)
 {
     class DescriptorSetDeleter
     {
@@ -245,10 +376,12 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         // clang-format off
         DescriptorSetDeleter(DescriptorSetAllocator& _Allocator,
                              VkDescriptorSet         _Set,
-                             VkDescriptorPool        _Pool) : 
+                             VkDescriptorPool        _Pool,
+                             Uint32                  _ShardIdx) : 
             Allocator {&_Allocator},
             Set       {_Set       },
-            Pool      {_Pool      }
+            Pool      {_Pool      },
+            ShardIdx  {_ShardIdx  }
         {}
 
         DescriptorSetDeleter             (const DescriptorSetDeleter&) = delete;
@@ -258,7 +391,8 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetDeleter(DescriptorSetDeleter&& rhs)noexcept : 
             Allocator {rhs.Allocator},
             Set       {rhs.Set      },
-            Pool      {rhs.Pool     }
+            Pool      {rhs.Pool     },
+            ShardIdx  {rhs.ShardIdx }
         {
             rhs.Allocator = nullptr;
             rhs.Set       = VK_NULL_HANDLE;
@@ -270,7 +404,8 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
+                // The set must be returned to the pool under the lock of the shard that owns the pool
+                auto Lock = Allocator->m_Shards[ShardIdx].Lock(Allocator->m_NumContendedLocks);
                 Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
@@ -282,13 +417,17 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetAllocator* Allocator;
         VkDescriptorSet         Set;
         VkDescriptorPool        Pool;
+        Uint32                  ShardIdx;
     };
-    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool}, QueueMask);
+    VERIFY_EXPR(ShardIdx < NumShards);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool, ShardIdx}, QueueMask);
 }
 
 
 VkDescriptorSet DynamicDescriptorSetAllocator::Allocate(VkDescriptorSetLayout SetLayout, const char* DebugName)
 {
+    DILIGENT_PROFILE_SCOPE("DynamicDescriptorSetAllocator::Allocate");
+
     VkDescriptorSet set           = VK_NULL_HANDLE;
     const auto&     LogicalDevice = m_GlobalPoolMgr.GetDeviceVkImpl().GetLogicalDevice();
     if (!m_AllocatedPools.empty())
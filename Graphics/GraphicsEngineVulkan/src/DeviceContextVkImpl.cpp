@@ -31,6 +31,8 @@
 
 #include <sstream>
 #include <vector>
+#include <array>
+#include <algorithm>
 
 #include "RenderDeviceVkImpl.hpp"
 #include "PipelineStateVkImpl.hpp"
@@ -38,10 +40,12 @@
 #include "BufferVkImpl.hpp"
 #include "RenderPassVkImpl.hpp"
 #include "FenceVkImpl.hpp"
+#include "ResourceHeapVkImpl.hpp"
 
 #include "VulkanTypeConversions.hpp"
 #include "CommandListVkImpl.hpp"
 #include "GraphicsAccessories.hpp"
+#include "SmallVector.hpp"
 
 namespace Diligent
 {
@@ -83,7 +87,8 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
     {
         *pDeviceVkImpl,
         GetContextObjectName("Upload heap", Desc.IsDeferred, Desc.ContextId),
-        EngineCI.UploadHeapPageSize
+        EngineCI.UploadHeapPageSize,
+        EngineCI.UploadHeapRetainedSize
     },
     m_DynamicHeap
     {
@@ -101,12 +106,11 @@ DeviceContextVkImpl::DeviceContextVkImpl(IReferenceCounters*                   p
 {
     if (!IsDeferred())
     {
+        m_BatchCommandListSubmission = EngineCI.BatchCommandListSubmission;
         PrepareCommandPool(GetCommandQueueId());
         m_QueryMgr.reset(new QueryManagerVk{pDeviceVkImpl, EngineCI.QueryPoolSizes, GetCommandQueueId()});
     }
 
-    m_GenerateMipsHelper->CreateSRB(&m_GenerateMipsSRB);
-
     BufferDesc DummyVBDesc;
     DummyVBDesc.Name          = "Dummy vertex buffer";
     DummyVBDesc.BindFlags     = BIND_VERTEX_BUFFER;
@@ -147,6 +151,14 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
         Flush();
     }
 
+    if (!m_PendingSplitBarriers.empty())
+    {
+        LOG_WARNING_MESSAGE(m_PendingSplitBarriers.size(), " split barrier(s) in the device context being destroyed have not been ended.");
+        for (auto& Split : m_PendingSplitBarriers)
+            m_UsedSplitBarrierEvents.emplace_back(std::move(Split.Event));
+        m_PendingSplitBarriers.clear();
+    }
+
     // For deferred contexts, m_SubmittedBuffersCmdQueueMask is reset to 0 after every call to FinishFrame().
     // In this case there are no resources to release, so there will be no issues.
     FinishFrame();
@@ -164,6 +176,11 @@ DeviceContextVkImpl::~DeviceContextVkImpl()
     //     Also note that command buffers are disposed directly into the release queue, but
     //     the command pool goes into the stale objects queue and is moved into the release queue
     //     when the next command buffer is submitted.
+    if (m_PredicateBuffer != VK_NULL_HANDLE)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_PredicateBuffer), Uint64{1} << GetCommandQueueId());
+    if (m_PredicateBufferMemory.Page != nullptr)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_PredicateBufferMemory), Uint64{1} << GetCommandQueueId());
+
     if (m_QueueFamilyCmdPools)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_QueueFamilyCmdPools), ~Uint64{0});
 
@@ -200,16 +217,62 @@ void DeviceContextVkImpl::PrepareCommandPool(SoftwareQueueIndex CommandQueueId)
     m_Desc.TextureCopyGranularity[2] = QueueInfo.minImageTransferGranularity.depth;
 }
 
-void DeviceContextVkImpl::Begin(Uint32 ImmediateContextId)
+void DeviceContextVkImpl::Begin(Uint32 ImmediateContextId, COMMAND_LIST_FLAGS Flags)
 {
     DEV_CHECK_ERR(IsDeferred(), "Begin() should only be called for deferred contexts.");
     DEV_CHECK_ERR(!IsRecordingDeferredCommands(), "This context is already recording commands. Call FinishCommandList() before beginning new recording.");
     PrepareCommandPool(SoftwareQueueIndex{ImmediateContextId});
     m_DstImmediateContextId = static_cast<Uint8>(ImmediateContextId);
     VERIFY_EXPR(m_DstImmediateContextId == ImmediateContextId);
+    // Reusable command buffers are begun without VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT (see EnsureVkCmdBuffer)
+    m_CommandListFlags = Flags;
+}
+
+void DeviceContextVkImpl::BeginSecondaryCommandBuffer(Uint32        ImmediateContextId,
+                                                      IRenderPass*  pRenderPass,
+                                                      Uint32        SubpassIndex,
+                                                      IFramebuffer* pFramebuffer)
+{
+    DEV_CHECK_ERR(pRenderPass != nullptr, "Render pass must not be null");
+    DEV_CHECK_ERR(pFramebuffer != nullptr, "Framebuffer must not be null");
+    DEV_CHECK_ERR(SubpassIndex < pRenderPass->GetDesc().SubpassCount, "Subpass index (", SubpassIndex, ") exceeds the number of subpasses (",
+                  pRenderPass->GetDesc().SubpassCount, ") in render pass '", pRenderPass->GetDesc().Name, "'");
+
+    Begin(ImmediateContextId, COMMAND_LIST_FLAG_NONE);
+
+    // The render pass is begun by the primary command buffer, so we only set the
+    // state here and do not update the attachment states.
+    m_pActiveRenderPass = ValidatedCast<RenderPassVkImpl>(pRenderPass);
+    m_pBoundFramebuffer = ValidatedCast<FramebufferVkImpl>(pFramebuffer);
+    m_SubpassIndex      = SubpassIndex;
+    SetSubpassRenderTargets();
+
+    m_vkRenderPass         = m_pActiveRenderPass->GetVkRenderPass();
+    m_vkFramebuffer        = m_pBoundFramebuffer->GetVkFramebuffer();
+    m_IsSecondaryCmdBuffer = true;
+
+    VkCommandBufferInheritanceInfo InheritanceInfo{};
+    InheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    InheritanceInfo.pNext                = nullptr;
+    InheritanceInfo.renderPass           = m_vkRenderPass;
+    InheritanceInfo.subpass              = SubpassIndex;
+    InheritanceInfo.framebuffer          = m_vkFramebuffer;
+    InheritanceInfo.occlusionQueryEnable = VK_FALSE;
+
+    VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() == VK_NULL_HANDLE);
+    auto vkCmdBuff = m_CmdPool->GetSecondaryCommandBuffer(InheritanceInfo);
+    m_CommandBuffer.SetVkCmdBuffer(vkCmdBuff, m_CmdPool->GetSupportedStagesMask());
+    m_CommandBuffer.SetInheritedRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight);
+    EnsureVkCmdBuffer();
+
+    // Secondary command buffers do not inherit dynamic states from the primary command buffer
+    SetViewports(1, nullptr, 0, 0);
 }
 
-void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkCommandBuffer vkCmdBuff, Uint64 FenceValue)
+void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex   CmdQueue,
+                                             VkCommandBuffer      vkCmdBuff,
+                                             Uint64               FenceValue,
+                                             VkCommandBufferLevel Level)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
     VERIFY_EXPR(m_CmdPool != nullptr);
@@ -218,9 +281,11 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
     public:
         // clang-format off
         CmdBufferRecycler(VkCommandBuffer                           _vkCmdBuff, 
-                         VulkanUtilities::VulkanCommandBufferPool& _Pool) noexcept :
+                          VulkanUtilities::VulkanCommandBufferPool& _Pool,
+                          VkCommandBufferLevel                      _Level) noexcept :
             vkCmdBuff {_vkCmdBuff},
-            Pool      {&_Pool    }
+            Pool      {&_Pool    },
+            Level     {_Level    }
         {
             VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
         }
@@ -231,7 +296,8 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
 
         CmdBufferRecycler(CmdBufferRecycler&& rhs) noexcept : 
             vkCmdBuff {rhs.vkCmdBuff},
-            Pool      {rhs.Pool     }
+            Pool      {rhs.Pool     },
+            Level     {rhs.Level    }
         {
             rhs.vkCmdBuff = VK_NULL_HANDLE;
             rhs.Pool      = nullptr;
@@ -242,30 +308,20 @@ void DeviceContextVkImpl::DisposeVkCmdBuffer(SoftwareQueueIndex CmdQueue, VkComm
         {
             if (Pool != nullptr)
             {
-                Pool->RecycleCommandBuffer(std::move(vkCmdBuff));
+                Pool->RecycleCommandBuffer(std::move(vkCmdBuff), Level);
             }
         }
 
     private:
         VkCommandBuffer                           vkCmdBuff = VK_NULL_HANDLE;
         VulkanUtilities::VulkanCommandBufferPool* Pool      = nullptr;
+        VkCommandBufferLevel                      Level     = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     };
 
     // Discard command buffer directly to the release queue since we know exactly which queue it was submitted to
     // as well as the associated FenceValue.
     auto& ReleaseQueue = m_pDevice->GetReleaseQueue(CmdQueue);
-    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool}, FenceValue);
-}
-
-inline void DeviceContextVkImpl::DisposeCurrentCmdBuffer(SoftwareQueueIndex CmdQueue, Uint64 FenceValue)
-{
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Disposing command buffer with unifinished render pass");
-    auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
-    if (vkCmdBuff != VK_NULL_HANDLE)
-    {
-        DisposeVkCmdBuffer(CmdQueue, vkCmdBuff, FenceValue);
-        m_CommandBuffer.Reset();
-    }
+    ReleaseQueue.DiscardResource(CmdBufferRecycler{vkCmdBuff, *m_CmdPool, Level}, FenceValue);
 }
 
 
@@ -324,6 +380,23 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
             {
                 CommitScissorRects();
             }
+
+            if (GraphicsPipeline.DynamicStates != DYNAMIC_STATE_FLAG_NONE)
+            {
+                // Dynamic states are undefined after the pipeline is bound, so set the values
+                // from the pipeline description. They may be overridden by SetDynamicStates().
+                DynamicStateAttribs PSOStates;
+                PSOStates.Flags             = GraphicsPipeline.DynamicStates;
+                PSOStates.CullMode          = GraphicsPipeline.RasterizerDesc.CullMode;
+                PSOStates.DepthEnable       = GraphicsPipeline.DepthStencilDesc.DepthEnable;
+                PSOStates.DepthWriteEnable  = GraphicsPipeline.DepthStencilDesc.DepthWriteEnable;
+                PSOStates.DepthFunc         = GraphicsPipeline.DepthStencilDesc.DepthFunc;
+                PSOStates.StencilEnable     = GraphicsPipeline.DepthStencilDesc.StencilEnable;
+                PSOStates.FrontFace         = GraphicsPipeline.DepthStencilDesc.FrontFace;
+                PSOStates.BackFace          = GraphicsPipeline.DepthStencilDesc.BackFace;
+                PSOStates.PrimitiveTopology = GraphicsPipeline.PrimitiveTopology;
+                CommitDynamicStates(PSOStates);
+            }
             m_State.vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
             break;
         }
@@ -374,6 +447,23 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
 
         SetInfo.BaseInd            = Layout.GetFirstDescrSetIndex(pSignature->GetDesc().BindingIndex);
         SetInfo.DynamicOffsetCount = pSignature->GetDynamicOffsetCount();
+        SetInfo.PushDynamicSet     = Layout.GetPushDescrSetSignatureIndex() == i;
+
+        // Descriptor sets that were bound with a compatible pipeline layout remain valid, so the SRB
+        // only needs to be committed again if its sets were bound with an incompatible layout.
+        // This includes layouts with a different push constant range or a different kind of dynamic set.
+        if (SetInfo.BoundLayoutHash != Layout.GetSetCompatibilityHash(i) && BindInfo.ResourceCaches[i] != nullptr)
+            BindInfo.StaleSRBMask |= static_cast<ResourceBindInfo::SRBMaskType>(1u << i);
+    }
+
+    // The bindless set is the last set in the layout and is never changed by SRB commits,
+    // so binding it once per pipeline is sufficient.
+    const auto BindlessSetInd = Layout.GetBindlessDescrSetIndex();
+    if (BindlessSetInd != PipelineLayoutVk::InvalidDescrSetIndex)
+    {
+        const auto vkBindlessSet = m_pDevice->GetBindlessHeap()->GetVkDescriptorSet();
+        m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, BindlessSetInd, 1, &vkBindlessSet);
+        OnDescriptorSetsBound(BindInfo, SignCount);
     }
 }
 
@@ -412,19 +502,24 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
         auto* pResourceCache = BindInfo.ResourceCaches[sign];
         DEV_CHECK_ERR(pResourceCache != nullptr, "Resource cache at index ", sign, " is null");
 
+        if (m_pPipelineState->GetResourceSignature(sign)->UsesDescriptorBuffer())
+        {
+            CommitDescriptorBufferSets(BindInfo, sign);
+            continue;
+        }
+
         auto& SetInfo = BindInfo.SetInfo[sign];
-        VERIFY(SetInfo.vkSets[0] != VK_NULL_HANDLE,
+        VERIFY(SetInfo.vkSets[0] != VK_NULL_HANDLE || SetInfo.DeferredDynamicSet,
                "At least one descriptor set in the stale SRB must not be NULL. Empty SRBs should not be marked as stale by CommitShaderResources()");
-        const Uint32 SetCount = 1 + (SetInfo.vkSets[1] != VK_NULL_HANDLE ? 1 : 0);
-
-        VERIFY_EXPR(SetCount == pResourceCache->GetNumDescriptorSets());
+        const Uint32 SetCount = pResourceCache->GetNumDescriptorSets();
 
+        std::array<Uint32, MAX_DESCR_SET_PER_SIGNATURE> SetOffsetCounts = {};
         if (SetInfo.DynamicOffsetCount > 0)
         {
             VERIFY(m_DynamicBufferOffsets.size() >= SetInfo.DynamicOffsetCount,
                    "m_DynamicBufferOffsets must've been resized by CommitShaderResources() to have enough space");
 
-            auto NumOffsetsWritten = pResourceCache->GetDynamicBufferOffsets(GetContextId(), this, m_DynamicBufferOffsets);
+            auto NumOffsetsWritten = pResourceCache->GetDynamicBufferOffsets(GetContextId(), this, m_DynamicBufferOffsets, SetOffsetCounts.data());
             VERIFY_EXPR(NumOffsetsWritten == SetInfo.DynamicOffsetCount);
         }
 
@@ -436,8 +531,44 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
         // (either compute or graphics, according to the pipelineBindPoint). Any bindings that were previously
         // applied via these sets are no longer valid (13.2.5)
         VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
-        m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, SetInfo.BaseInd, SetCount,
-                                           SetInfo.vkSets.data(), SetInfo.DynamicOffsetCount, m_DynamicBufferOffsets.data());
+        if (SetInfo.DeferredDynamicSet)
+        {
+            const auto* pSignature = m_pPipelineState->GetResourceSignature(sign);
+            VERIFY_EXPR(pSignature != nullptr && pSignature->SupportsPushDescriptors());
+
+            const auto DynSetIdx = pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC>();
+            VERIFY_EXPR(DynSetIdx + 1 == SetCount);
+            if (SetInfo.PushDynamicSet)
+            {
+                // Bind the static/mutable set, if it has changed, and push the dynamic set. This records descriptors
+                // directly into the command buffer and requires no descriptor pool allocations.
+                if (DynSetIdx > 0)
+                    BindChangedDescriptorSets(BindInfo, sign, DynSetIdx, SetOffsetCounts.data());
+                pSignature->PushDynamicResources(m_CommandBuffer, m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout,
+                                                 SetInfo.BaseInd + DynSetIdx, SetInfo.DynamicDescrData.data());
+                OnDescriptorSetsBound(BindInfo, sign);
+                SetInfo.vkBoundSets[DynSetIdx] = VK_NULL_HANDLE;
+#ifdef DILIGENT_DEVELOPMENT
+                SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
+#endif
+                continue;
+            }
+
+            if (SetInfo.vkSets[DynSetIdx] == VK_NULL_HANDLE)
+            {
+                // The push set in the current pipeline layout is used by another signature
+                auto vkDynamicDescrSet = AllocateDynamicDescriptorSet(pSignature->GetVkDescriptorSetLayout(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC),
+                                                                      "Dynamic Descriptor Set");
+                pSignature->WriteDynamicDescriptorSet(vkDynamicDescrSet, SetInfo.DynamicDescrData.data());
+                SetInfo.vkSets[DynSetIdx] = vkDynamicDescrSet;
+            }
+        }
+        else
+        {
+            VERIFY(!SetInfo.PushDynamicSet, "The pipeline layout uses push descriptors, but the SRB's signature does not support them");
+        }
+
+        BindChangedDescriptorSets(BindInfo, sign, SetCount, SetOffsetCounts.data());
 
 #ifdef DILIGENT_DEVELOPMENT
         SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
@@ -448,10 +579,161 @@ void DeviceContextVkImpl::CommitDescriptorSets(ResourceBindInfo& BindInfo, Uint3
     BindInfo.StaleSRBMask &= ~BindInfo.ActiveSRBMask;
 }
 
+void DeviceContextVkImpl::BindChangedDescriptorSets(ResourceBindInfo& BindInfo, Uint32 SRBIndex, Uint32 SetCount, const Uint32* SetOffsetCounts)
+{
+    auto&       SetInfo        = BindInfo.SetInfo[SRBIndex];
+    const bool  LayoutMatches  = SetInfo.BoundLayoutHash == m_pPipelineState->GetPipelineLayout().GetSetCompatibilityHash(SRBIndex);
+    const auto* DynamicOffsets = m_DynamicBufferOffsets.data();
+
+    // Find the range of sets that are not bound yet. Typically, only the last set of the
+    // SRB (e.g. the dynamic set) or only its dynamic offsets change between draw calls.
+    Uint32 FirstSet    = SetCount;
+    Uint32 EndSet      = 0;
+    Uint32 FirstOffset = 0;
+    Uint32 EndOffset   = 0;
+    Uint32 OffsetInd   = 0;
+    for (Uint32 set = 0; set < SetCount; ++set)
+    {
+        const auto OffsetCount = SetOffsetCounts[set];
+        VERIFY_EXPR(OffsetInd + OffsetCount <= SetInfo.DynamicOffsetCount);
+
+        const bool IsBound =
+            LayoutMatches &&
+            SetInfo.vkSets[set] != VK_NULL_HANDLE &&
+            SetInfo.vkBoundSets[set] == SetInfo.vkSets[set] &&
+            SetInfo.BoundDynamicOffsets.size() >= OffsetInd + OffsetCount &&
+            std::equal(DynamicOffsets + OffsetInd, DynamicOffsets + OffsetInd + OffsetCount, SetInfo.BoundDynamicOffsets.begin() + OffsetInd);
+        if (!IsBound)
+        {
+            if (FirstSet == SetCount)
+            {
+                FirstSet    = set;
+                FirstOffset = OffsetInd;
+            }
+            EndSet    = set + 1;
+            EndOffset = OffsetInd + OffsetCount;
+        }
+
+        OffsetInd += OffsetCount;
+    }
+
+    if (FirstSet == SetCount)
+        return;
+
+    m_CommandBuffer.BindDescriptorSets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, SetInfo.BaseInd + FirstSet, EndSet - FirstSet,
+                                       SetInfo.vkSets.data() + FirstSet, EndOffset - FirstOffset, DynamicOffsets + FirstOffset);
+    OnDescriptorSetsBound(BindInfo, SRBIndex);
+
+    std::copy(SetInfo.vkSets.begin() + FirstSet, SetInfo.vkSets.begin() + EndSet, SetInfo.vkBoundSets.begin() + FirstSet);
+    SetInfo.BoundDynamicOffsets.assign(DynamicOffsets, DynamicOffsets + SetInfo.DynamicOffsetCount);
+}
+
+void DeviceContextVkImpl::OnDescriptorSetsBound(ResourceBindInfo& BindInfo, Uint32 SRBIndex)
+{
+    // When binding a descriptor set to set number N, a previously bound descriptor set bound with lower index M
+    // than N is disturbed if the pipeline layouts for set M and N are not compatible for set M. If the previous
+    // bound descriptor set in set N was bound using a pipeline layout compatible for set N, then the bindings in
+    // sets numbered greater than N are also not disturbed. (14.2.2)
+    const auto& Layout    = m_pPipelineState->GetPipelineLayout();
+    const auto  SignCount = m_pPipelineState->GetResourceSignatureCount();
+    VERIFY_EXPR(SRBIndex <= SignCount);
+
+    for (Uint32 i = 0; i < SRBIndex; ++i)
+    {
+        auto& SetInfo = BindInfo.SetInfo[i];
+        if (SetInfo.BoundLayoutHash != Layout.GetSetCompatibilityHash(i))
+            SetInfo.InvalidateBoundSets();
+    }
+
+    Uint32 FirstDisturbedSRB = SRBIndex;
+    if (SRBIndex < SignCount)
+    {
+        auto&      SetInfo    = BindInfo.SetInfo[SRBIndex];
+        const auto LayoutHash = Layout.GetSetCompatibilityHash(SRBIndex);
+        if (SetInfo.BoundLayoutHash != LayoutHash)
+        {
+            // Sets of the SRB itself are updated by the caller
+            SetInfo.InvalidateBoundSets();
+            SetInfo.BoundLayoutHash = LayoutHash;
+            FirstDisturbedSRB       = SRBIndex + 1;
+        }
+        else
+        {
+            FirstDisturbedSRB = MAX_RESOURCE_SIGNATURES;
+        }
+    }
+
+    for (Uint32 i = FirstDisturbedSRB; i < MAX_RESOURCE_SIGNATURES; ++i)
+        BindInfo.SetInfo[i].InvalidateBoundSets();
+}
+
+void DeviceContextVkImpl::CommitDescriptorBufferSets(ResourceBindInfo& BindInfo, Uint32 SRBIndex)
+{
+    const auto* pSignature    = m_pPipelineState->GetResourceSignature(SRBIndex);
+    const auto& ResourceCache = *BindInfo.ResourceCaches[SRBIndex];
+    auto&       SetInfo       = BindInfo.SetInfo[SRBIndex];
+    const auto& DescrBuffer   = *m_pDevice->GetDescriptorBuffer();
+    VERIFY_EXPR(pSignature != nullptr && pSignature->UsesDescriptorBuffer());
+
+    if (!m_State.DescriptorBuffersBound)
+    {
+        // Changing descriptor buffer bindings may be expensive, so both buffers are bound once per
+        // command buffer and descriptor sets are selected with vkCmdSetDescriptorBufferOffsetsEXT.
+        std::array<VkDescriptorBufferBindingInfoEXT, DescriptorBufferVk::BUFFER_INDEX_COUNT> BindingInfos{};
+        for (auto& Info : BindingInfos)
+        {
+            Info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+            Info.usage = DescriptorBufferVk::DescriptorBufferUsage;
+        }
+        BindingInfos[DescriptorBufferVk::BUFFER_INDEX_GLOBAL].address       = DescrBuffer.GetDeviceAddress();
+        BindingInfos[DescriptorBufferVk::BUFFER_INDEX_DYNAMIC_HEAP].address = m_pDevice->GetDynamicMemoryManager().GetDeviceAddress();
+        m_CommandBuffer.BindDescriptorBuffers(static_cast<uint32_t>(BindingInfos.size()), BindingInfos.data());
+        m_State.DescriptorBuffersBound = true;
+    }
+
+    const Uint32 SetCount = ResourceCache.GetNumDescriptorSets();
+
+    std::array<uint32_t, MAX_DESCR_SET_PER_SIGNATURE>     BufferIndices{};
+    std::array<VkDeviceSize, MAX_DESCR_SET_PER_SIGNATURE> Offsets{};
+    for (Uint32 s = 0; s < SetCount; ++s)
+    {
+        const auto SetId = (s == 0 && pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE)) ?
+            PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE :
+            PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC;
+        if (!pSignature->IsTransientDescriptorBufferSet(SetId, ResourceCache))
+        {
+            BufferIndices[s] = DescriptorBufferVk::BUFFER_INDEX_GLOBAL;
+            Offsets[s]       = ResourceCache.GetDescriptorSet(s).GetDescriptorBufferOffset();
+            continue;
+        }
+
+        DEV_CHECK_ERR(!IsRecordingReusableCommandList(),
+                      "Descriptor buffer data of dynamic variables and dynamic buffers is only valid for one frame and can't be used in a reusable command list. "
+                      "Use shader resource bindings that have no dynamic variables or dynamic buffers.");
+
+        // The set data is written to the dynamic heap that is bound as the second descriptor buffer
+        auto  Allocation  = AllocateDynamicSpace(pSignature->GetDescriptorBufferSetSize(SetId), static_cast<Uint32>(DescrBuffer.GetOffsetAlignment()));
+        auto* pCPUAddress = reinterpret_cast<Uint8*>(Allocation.pDynamicMemMgr->GetCPUAddress()) + Allocation.AlignedOffset;
+        pSignature->WriteDescriptorBufferSet(SetId, ResourceCache, pCPUAddress, GetContextId(), this);
+
+        BufferIndices[s] = DescriptorBufferVk::BUFFER_INDEX_DYNAMIC_HEAP;
+        Offsets[s]       = Allocation.AlignedOffset;
+    }
+
+    VERIFY_EXPR(m_State.vkPipelineBindPoint != VK_PIPELINE_BIND_POINT_MAX_ENUM);
+    m_CommandBuffer.SetDescriptorBufferOffsets(m_State.vkPipelineBindPoint, BindInfo.vkPipelineLayout, SetInfo.BaseInd, SetCount,
+                                               BufferIndices.data(), Offsets.data());
+    OnDescriptorSetsBound(BindInfo, SRBIndex);
+
+#ifdef DILIGENT_DEVELOPMENT
+    SetInfo.LastBoundBaseInd = SetInfo.BaseInd;
+#endif
+}
+
 #ifdef DILIGENT_DEVELOPMENT
 void DeviceContextVkImpl::DvpValidateCommittedShaderResources(ResourceBindInfo& BindInfo)
 {
-    if (BindInfo.ResourcesValidated)
+    if (BindInfo.ResourcesValidated || !m_pDevice->IsValidationEnabled(VALIDATION_CATEGORY_RESOURCE_BINDING))
         return;
 
     DvpVerifySRBCompatibility(BindInfo);
@@ -469,6 +751,10 @@ void DeviceContextVkImpl::DvpValidateCommittedShaderResources(ResourceBindInfo&
         const auto  DSCount = pSign->GetNumDescriptorSets();
         for (Uint32 s = 0; s < DSCount; ++s)
         {
+            // Pushed dynamic set and descriptor buffer sets have no descriptor set handles
+            if (pSign->UsesDescriptorBuffer() || (SetInfo.PushDynamicSet && s + 1 == DSCount))
+                continue;
+
             DEV_CHECK_ERR(SetInfo.vkSets[s] != VK_NULL_HANDLE,
                           "descriptor set with index ", s, " is not bound for resource signature '",
                           pSign->GetDesc().Name, "', binding index ", i, ".");
@@ -530,9 +816,16 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     auto&       SetInfo    = BindInfo.SetInfo[SRBIndex];
 
     BindInfo.Set(SRBIndex, pResBindingVkImpl);
-    // We must not clear entire ResInfo as DescriptorSetBaseInd and DynamicOffsetCount
+    // We must not clear entire ResInfo as DescriptorSetBaseInd, DynamicOffsetCount and PushDynamicSet
     // are set by SetPipelineState().
-    SetInfo.vkSets = {};
+    SetInfo.vkSets             = {};
+    SetInfo.DeferredDynamicSet = false;
+
+    if (pSignature->UsesDescriptorBuffer())
+    {
+        // Descriptor buffer offsets are set by CommitDescriptorSets()
+        return;
+    }
 
     Uint32 DSIndex = 0;
     if (pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE))
@@ -544,7 +837,17 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
         ++DSIndex;
     }
 
-    if (pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC))
+    if (pSignature->SupportsPushDescriptors())
+    {
+        VERIFY_EXPR(DSIndex == pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC>());
+
+        // Capture dynamic resources now; the set is pushed or allocated by CommitDescriptorSets()
+        // depending on the pipeline layout used for drawing.
+        pSignature->PrepareDynamicDescriptorData(ResourceCache, SetInfo.DynamicDescrData);
+        SetInfo.DeferredDynamicSet = true;
+        ++DSIndex;
+    }
+    else if (pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC))
     {
         VERIFY_EXPR(DSIndex == pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC>());
         VERIFY_EXPR(const_cast<const ShaderResourceCacheVk&>(ResourceCache).GetDescriptorSet(DSIndex).GetVkDescriptorSet() == VK_NULL_HANDLE);
@@ -564,7 +867,7 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
         vkDynamicDescrSet = AllocateDynamicDescriptorSet(vkLayout, DynamicDescrSetName);
 
         // Write all dynamic resource descriptors
-        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet);
+        pSignature->CommitDynamicResources(ResourceCache, vkDynamicDescrSet, m_DescriptorTemplateData);
 
         SetInfo.vkSets[DSIndex] = vkDynamicDescrSet;
         ++DSIndex;
@@ -575,6 +878,24 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     m_DynamicBufferOffsets.resize(std::max<size_t>(m_DynamicBufferOffsets.size(), pSignature->GetDynamicOffsetCount()));
 }
 
+void DeviceContextVkImpl::SetInlineConstants(const void* pConstants, Uint32 FirstConstant, Uint32 NumConstants)
+{
+    DEV_CHECK_ERR(m_pPipelineState, "No pipeline state is bound. Call SetPipelineState() before setting inline constants.");
+    DEV_CHECK_ERR(pConstants != nullptr || NumConstants == 0, "pConstants must not be null");
+
+    const auto& Layout = m_pPipelineState->GetPipelineLayout();
+    DEV_CHECK_ERR(Layout.GetPushConstantSize() != 0, "Pipeline state '", m_pPipelineState->GetDesc().Name, "' does not use inline constants.");
+    DEV_CHECK_ERR((FirstConstant + NumConstants) * sizeof(Uint32) <= Layout.GetPushConstantSize(),
+                  "Inline constant range [", FirstConstant, ", ", FirstConstant + NumConstants, ") is out of bounds of the inline constants block (",
+                  Layout.GetPushConstantSize() / sizeof(Uint32), " constants) used by pipeline state '", m_pPipelineState->GetDesc().Name, "'.");
+    if (NumConstants == 0)
+        return;
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.PushConstants(Layout.GetVkPipelineLayout(), Layout.GetPushConstantStages(),
+                                  FirstConstant * sizeof(Uint32), NumConstants * sizeof(Uint32), pConstants);
+}
+
 void DeviceContextVkImpl::SetStencilRef(Uint32 StencilRef)
 {
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
@@ -593,6 +914,57 @@ void DeviceContextVkImpl::SetBlendFactors(const float* pBlendFactors)
     }
 }
 
+void DeviceContextVkImpl::SetDynamicStates(const DynamicStateAttribs& Attribs)
+{
+    if (TDeviceContextBase::SetDynamicStates(Attribs, 0))
+    {
+        EnsureVkCmdBuffer();
+        CommitDynamicStates(Attribs);
+    }
+}
+
+void DeviceContextVkImpl::CommitDynamicStates(const DynamicStateAttribs& Attribs)
+{
+    VERIFY(m_pDevice->GetFeatures().DynamicPipelineStates, "Dynamic pipeline states are not enabled");
+
+    if (Attribs.Flags & DYNAMIC_STATE_FLAG_CULL_MODE)
+    {
+        m_CommandBuffer.SetCullMode(CullModeToVkCullMode(Attribs.CullMode));
+    }
+
+    if (Attribs.Flags & DYNAMIC_STATE_FLAG_DEPTH)
+    {
+        m_CommandBuffer.SetDepthTestState(Attribs.DepthEnable ? VK_TRUE : VK_FALSE,
+                                          Attribs.DepthWriteEnable ? VK_TRUE : VK_FALSE,
+                                          Attribs.DepthEnable ? ComparisonFuncToVkCompareOp(Attribs.DepthFunc) : VK_COMPARE_OP_ALWAYS);
+    }
+
+    if (Attribs.Flags & DYNAMIC_STATE_FLAG_STENCIL)
+    {
+        m_CommandBuffer.SetStencilTestEnable(Attribs.StencilEnable ? VK_TRUE : VK_FALSE);
+        if (Attribs.StencilEnable)
+        {
+            const auto SetFaceOp = [this](VkStencilFaceFlags FaceMask, const StencilOpDesc& Face) {
+                m_CommandBuffer.SetStencilOp(FaceMask,
+                                             StencilOpToVkStencilOp(Face.StencilFailOp),
+                                             StencilOpToVkStencilOp(Face.StencilPassOp),
+                                             StencilOpToVkStencilOp(Face.StencilDepthFailOp),
+                                             ComparisonFuncToVkCompareOp(Face.StencilFunc));
+            };
+            SetFaceOp(VK_STENCIL_FACE_FRONT_BIT, Attribs.FrontFace);
+            SetFaceOp(VK_STENCIL_FACE_BACK_BIT, Attribs.BackFace);
+        }
+    }
+
+    if (Attribs.Flags & DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY)
+    {
+        VkPrimitiveTopology vkTopology         = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        uint32_t            PatchControlPoints = 0;
+        PrimitiveTopology_To_VkPrimitiveTopologyAndPatchCPCount(Attribs.PrimitiveTopology, vkTopology, PatchControlPoints);
+        m_CommandBuffer.SetPrimitiveTopology(vkTopology);
+    }
+}
+
 void DeviceContextVkImpl::CommitVkVertexBuffers()
 {
 #ifdef DILIGENT_DEVELOPMENT
@@ -607,7 +979,7 @@ void DeviceContextVkImpl::CommitVkVertexBuffers()
     for (Uint32 slot = 0; slot < m_NumVertexStreams; ++slot)
     {
         auto& CurrStream = m_VertexStreams[slot];
-        if (auto* pBufferVk = CurrStream.pBuffer.RawPtr())
+        if (auto* pBufferVk = CurrStream.pBuffer)
         {
             if (pBufferVk->GetDesc().Usage == USAGE_DYNAMIC)
             {
@@ -688,8 +1060,10 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
         DvpVerifyRenderTargets();
 
-    VERIFY(m_vkRenderPass != VK_NULL_HANDLE, "No render pass is active while executing draw command");
-    VERIFY(m_vkFramebuffer != VK_NULL_HANDLE, "No framebuffer is bound while executing draw command");
+    VERIFY(IsFramebufferBound(), "No render pass is active while executing draw command");
+    DEV_CHECK_ERR(m_vkSubpassContents == VK_SUBPASS_CONTENTS_INLINE,
+                  "Draw commands are not allowed in a render pass begun with BeginRenderPassWithSecondaryCommandBuffers(). "
+                  "Record them into a secondary command buffer with BeginSecondaryCommandBuffer().");
 #endif
 
     EnsureVkCmdBuffer();
@@ -704,7 +1078,7 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     {
         for (Uint32 slot = 0; slot < m_NumVertexStreams; ++slot)
         {
-            if (auto* pBufferVk = m_VertexStreams[slot].pBuffer.RawPtr())
+            if (auto* pBufferVk = m_VertexStreams[slot].pBuffer)
             {
                 DvpVerifyBufferState(*pBufferVk, RESOURCE_STATE_VERTEX_BUFFER, "Using vertex buffers (DeviceContextVkImpl::Draw)");
             }
@@ -724,7 +1098,9 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
     if (m_pPipelineState->GetGraphicsPipelineDesc().pRenderPass == nullptr)
     {
 #ifdef DILIGENT_DEVELOPMENT
-        if (m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
+        // With dynamic rendering, pipelines have no implicit render pass, and render target formats
+        // are verified by DvpVerifyRenderTargets()
+        if (!m_pDevice->UseDynamicRendering() && m_pPipelineState->GetRenderPass()->GetVkRenderPass() != m_vkRenderPass)
         {
             // Note that different Vulkan render passes may still be compatible,
             // so we should only verify implicit render passes
@@ -776,6 +1152,7 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
     DvpVerifyDrawArguments(Attribs);
+    CountDrawCommand();
 
     PrepareForDraw(Attribs.Flags);
 
@@ -786,6 +1163,7 @@ void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
     DvpVerifyDrawIndexedArguments(Attribs);
+    CountDrawCommand();
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
@@ -796,6 +1174,9 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -803,13 +1184,26 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuff
 
     PrepareForDraw(Attribs.Flags);
 
-    m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    const auto ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset;
+    if (Attribs.DrawCount <= 1 || (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) != 0)
+    {
+        m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, Attribs.DrawCount > 1 ? Attribs.DrawArgsStride : 0);
+    }
+    else
+    {
+        // multiDrawIndirect feature is not supported: issue one command per draw
+        for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+            m_CommandBuffer.DrawIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{draw} * Attribs.DrawArgsStride, 1, 0);
+    }
     ++m_State.NumCommands;
 }
 
 void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawIndexedIndirectArguments(Attribs, pAttribsBuffer);
+    if (Attribs.DrawCount == 0)
+        return;
+    CountDrawCommand();
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -817,13 +1211,63 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
 
     PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
 
-    m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset, 1, 0);
+    const auto ArgsOffset = pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset;
+    if (Attribs.DrawCount <= 1 || (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) != 0)
+    {
+        m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset, Attribs.DrawCount, Attribs.DrawCount > 1 ? Attribs.DrawArgsStride : 0);
+    }
+    else
+    {
+        for (Uint32 draw = 0; draw < Attribs.DrawCount; ++draw)
+            m_CommandBuffer.DrawIndexedIndirect(pIndirectDrawAttribsVk->GetVkBuffer(), ArgsOffset + VkDeviceSize{draw} * Attribs.DrawArgsStride, 1, 0);
+    }
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::DrawIndirectCount(const DrawIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+    // We must prepare indirect draw attribs buffer first because state transitions must
+    // be performed outside of render pass, and PrepareForDraw commits render pass
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, "Indirect buffer (DeviceContextVkImpl::DrawIndirectCount)");
+    BufferVkImpl* pCountBufferVk         = PrepareIndirectAttribsBuffer(pCountBuffer, Attribs.CountBufferStateTransitionMode, "Count buffer (DeviceContextVkImpl::DrawIndirectCount)");
+
+    PrepareForDraw(Attribs.Flags);
+
+    m_CommandBuffer.DrawIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(),
+                                      pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset,
+                                      pCountBufferVk->GetVkBuffer(),
+                                      pCountBufferVk->GetDynamicOffset(GetContextId(), this) + Attribs.CountBufferOffset,
+                                      Attribs.MaxCommandCount,
+                                      Attribs.DrawArgsStride);
+    ++m_State.NumCommands;
+}
+
+void DeviceContextVkImpl::DrawIndexedIndirectCount(const DrawIndexedIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
+{
+    DvpVerifyDrawIndexedIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
+
+    BufferVkImpl* pIndirectDrawAttribsVk = PrepareIndirectAttribsBuffer(pAttribsBuffer, Attribs.IndirectAttribsBufferStateTransitionMode, "Indirect buffer (DeviceContextVkImpl::DrawIndexedIndirectCount)");
+    BufferVkImpl* pCountBufferVk         = PrepareIndirectAttribsBuffer(pCountBuffer, Attribs.CountBufferStateTransitionMode, "Count buffer (DeviceContextVkImpl::DrawIndexedIndirectCount)");
+
+    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+
+    m_CommandBuffer.DrawIndexedIndirectCount(pIndirectDrawAttribsVk->GetVkBuffer(),
+                                             pIndirectDrawAttribsVk->GetDynamicOffset(GetContextId(), this) + Attribs.IndirectDrawArgsOffset,
+                                             pCountBufferVk->GetVkBuffer(),
+                                             pCountBufferVk->GetDynamicOffset(GetContextId(), this) + Attribs.CountBufferOffset,
+                                             Attribs.MaxCommandCount,
+                                             Attribs.DrawArgsStride);
     ++m_State.NumCommands;
 }
 
 void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     DvpVerifyDrawMeshArguments(Attribs);
+    CountDrawCommand();
 
     PrepareForDraw(Attribs.Flags);
 
@@ -834,6 +1278,7 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDrawMeshIndirectArguments(Attribs, pAttribsBuffer);
+    CountDrawCommand();
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -848,6 +1293,7 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 void DeviceContextVkImpl::DrawMeshIndirectCount(const DrawMeshIndirectCountAttribs& Attribs, IBuffer* pAttribsBuffer, IBuffer* pCountBuffer)
 {
     DvpVerifyDrawMeshIndirectCountArguments(Attribs, pAttribsBuffer, pCountBuffer);
+    CountDrawCommand();
 
     // We must prepare indirect draw attribs buffer first because state transitions must
     // be performed outside of render pass, and PrepareForDraw commits render pass
@@ -871,7 +1317,7 @@ void DeviceContextVkImpl::PrepareForDispatchCompute()
     EnsureVkCmdBuffer();
 
     // Dispatch commands must be executed outside of render pass
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.IsInsideRenderPass())
         m_CommandBuffer.EndRenderPass();
 
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_COMPUTE);
@@ -903,6 +1349,7 @@ void DeviceContextVkImpl::PrepareForRayTracing()
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     DvpVerifyDispatchArguments(Attribs);
+    CountDispatchCommand();
 
     PrepareForDispatchCompute();
     m_CommandBuffer.Dispatch(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
@@ -912,6 +1359,7 @@ void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
 {
     DvpVerifyDispatchIndirectArguments(Attribs, pAttribsBuffer);
+    CountDispatchCommand();
 
     PrepareForDispatchCompute();
 
@@ -968,7 +1416,7 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
            "checks if the DSV is bound as a framebuffer attachment and triggers an assert otherwise (in development mode).");
     if (ClearAsAttachment)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(IsFramebufferBound());
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -1000,11 +1448,13 @@ void DeviceContextVkImpl::ClearDepthStencil(ITextureView*                  pView
     else
     {
         // End render pass to clear the buffer with vkCmdClearDepthStencilImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkDSV->GetTexture();
         auto* pTextureVk = ValidatedCast<TextureVkImpl>(pTexture);
+        DEV_CHECK_ERR((pTextureVk->GetDesc().MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0,
+                      "Memoryless texture '", pTextureVk->GetDesc().Name, "' can't be cleared outside of a render pass: bind it as a depth-stencil buffer or use ATTACHMENT_LOAD_OP_CLEAR.");
 
         // Image layout must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL (17.1)
         TransitionOrVerifyTextureState(*pTextureVk, StateTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -1086,7 +1536,7 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
 
     if (attachmentIndex != InvalidAttachmentIndex)
     {
-        VERIFY_EXPR(m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE);
+        VERIFY_EXPR(IsFramebufferBound());
         if (m_pActiveRenderPass == nullptr)
         {
             // Render pass may not be currently committed
@@ -1120,11 +1570,13 @@ void DeviceContextVkImpl::ClearRenderTarget(ITextureView* pView, const float* RG
         VERIFY(m_pActiveRenderPass == nullptr, "This branch should never execute inside a render pass.");
 
         // End current render pass and clear the image with vkCmdClearColorImage
-        if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         auto* pTexture   = pVkRTV->GetTexture();
         auto* pTextureVk = ValidatedCast<TextureVkImpl>(pTexture);
+        DEV_CHECK_ERR((pTextureVk->GetDesc().MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) == 0,
+                      "Memoryless texture '", pTextureVk->GetDesc().Name, "' can't be cleared outside of a render pass: bind it as a render target or use ATTACHMENT_LOAD_OP_CLEAR.");
 
         // Image layout must be VK_IMAGE_LAYOUT_GENERAL or VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL (17.1)
         TransitionOrVerifyTextureState(*pTextureVk, StateTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
@@ -1191,6 +1643,15 @@ void DeviceContextVkImpl::FinishFrame()
     if (!m_MappedTextures.empty())
         LOG_ERROR_MESSAGE("There are mapped textures in the device context when finishing the frame. All dynamic resources must be used in the same frame in which they are mapped.");
 
+    if (!IsDeferred() && m_pDevice->GetMemoryDefragmentationBudget() != 0 &&
+        GetNumCommandsInCtx() == 0 && m_ActiveQueriesCounter == 0 && m_pActiveRenderPass == nullptr)
+    {
+        // Move buffers from sparsely occupied memory pages into denser ones so that
+        // the emptied pages can be released by the memory manager.
+        if (m_pDevice->DefragmentMemory(*this) != 0)
+            Flush();
+    }
+
     const Uint64 QueueMask = GetSubmittedBuffersCmdQueueMask();
     VERIFY_EXPR(IsDeferred() || QueueMask == (Uint64{1} << GetCommandQueueId()));
 
@@ -1211,6 +1672,21 @@ void DeviceContextVkImpl::FinishFrame()
     // be destroyed before the pools are actually returned to the global pool manager.
     m_DynamicDescrSetAllocator.ReleasePools(QueueMask);
 
+    // Events of ended split barriers are destroyed when the command buffers that use them are complete.
+    if (QueueMask != 0)
+    {
+        for (auto& Event : m_UsedSplitBarrierEvents)
+            m_pDevice->SafeReleaseDeviceObject(std::move(Event), QueueMask);
+        m_UsedSplitBarrierEvents.clear();
+    }
+
+    // Framebuffer cache and dynamic heap frames are counted by the first immediate context only
+    if (!IsDeferred() && GetContextId() == 0)
+    {
+        m_pDevice->GetFramebufferCache().OnFinishFrame();
+        m_pDevice->GetDynamicMemoryManager().OnFinishFrame();
+    }
+
     EndFrame();
 }
 
@@ -1219,63 +1695,92 @@ void DeviceContextVkImpl::Flush()
     Flush(0, nullptr);
 }
 
-void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
-                                ICommandList* const* ppCommandLists)
+void DeviceContextVkImpl::EndCurrentCmdBuffer()
 {
-    DEV_CHECK_ERR(!IsDeferred(), "Flush() should only be called for immediate contexts.");
-
-    DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
-                  "Flushing device context that has ", m_ActiveQueriesCounter,
-                  " active queries. Vulkan requires that queries are begun and ended in the same command buffer.");
-
-    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
-                  "Flushing device context inside an active render pass.");
-
-    // TODO: replace with small_vector
-    std::vector<VkCommandBuffer>               vkCmdBuffs;
-    std::vector<RefCntAutoPtr<IDeviceContext>> DeferredCtxs;
-    vkCmdBuffs.reserve(NumCommandLists + 1);
-    DeferredCtxs.reserve(NumCommandLists + 1);
-
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
-    if (vkCmdBuff != VK_NULL_HANDLE)
+    if (vkCmdBuff == VK_NULL_HANDLE)
+        return;
+
+    if (m_QueryMgr)
     {
-        if (m_QueryMgr)
-        {
-            m_State.NumCommands += m_QueryMgr->ResetStaleQueries(m_CommandBuffer);
-        }
+        m_State.NumCommands += m_QueryMgr->ResetStaleQueries(m_CommandBuffer);
+    }
 
-        if (m_State.NumCommands != 0)
-        {
-            if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
-            {
-                m_CommandBuffer.EndRenderPass();
-            }
+    if (m_CommandBuffer.IsInsideRenderPass())
+    {
+        m_CommandBuffer.EndRenderPass();
+    }
 
 #ifdef DILIGENT_DEVELOPMENT
-            DEV_CHECK_ERR(m_DvpDebugGroupCount == 0, "Not all debug groups have been ended");
-            m_DvpDebugGroupCount = 0;
+    DEV_CHECK_ERR(m_DvpDebugGroupCount == 0, "Not all debug groups have been ended");
+    m_DvpDebugGroupCount = 0;
 #endif
 
-            m_CommandBuffer.FlushBarriers();
-            m_CommandBuffer.EndCommandBuffer();
+    m_CommandBuffer.FlushBarriers();
+    m_CommandBuffer.EndCommandBuffer();
 
-            vkCmdBuffs.push_back(vkCmdBuff);
-        }
-    }
+    m_PendingCmdBuffers.emplace_back();
+    m_PendingCmdBuffers.back().vkCmdBuff = vkCmdBuff;
+    m_CommandBuffer.Reset();
+}
 
-    // Add command buffers from deferred contexts
+void DeviceContextVkImpl::EnqueueCommandLists(Uint32               NumCommandLists,
+                                              ICommandList* const* ppCommandLists)
+{
     for (Uint32 i = 0; i < NumCommandLists; ++i)
     {
         auto* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
         DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
         DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
-        DeferredCtxs.emplace_back();
-        vkCmdBuffs.emplace_back();
-        pCmdListVk->Close(DeferredCtxs.back(), vkCmdBuffs.back());
-        VERIFY(vkCmdBuffs.back() != VK_NULL_HANDLE, "Trying to execute empty command buffer");
-        VERIFY_EXPR(DeferredCtxs.back() != nullptr);
+        DEV_CHECK_ERR(!pCmdListVk->IsSecondary(), "Secondary command lists must be executed inside a render pass begun with BeginRenderPassWithSecondaryCommandBuffers().");
+
+        m_PendingCmdBuffers.emplace_back();
+        auto& Pending = m_PendingCmdBuffers.back();
+        if (pCmdListVk->IsReusable())
+        {
+            // Reusable command buffers are recorded with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+            // and remain owned by the command list.
+            Pending.pDeferredCtx     = pCmdListVk->GetDeferredContext();
+            Pending.vkCmdBuff        = pCmdListVk->GetVkCmdBuffer();
+            Pending.pReusableCmdList = pCmdListVk;
+        }
+        else
+        {
+            pCmdListVk->Close(Pending.pDeferredCtx, Pending.vkCmdBuff);
+        }
+        VERIFY(Pending.vkCmdBuff != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(Pending.pDeferredCtx != nullptr);
+
+        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context.
+        // This must be done before the deferred context finishes the frame, which may happen before
+        // the batch is submitted.
+        Pending.pDeferredCtx.RawPtr<DeviceContextVkImpl>()->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
     }
+}
+
+void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
+                                ICommandList* const* ppCommandLists)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Flush() should only be called for immediate contexts.");
+
+    DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
+                  "Flushing device context that has ", m_ActiveQueriesCounter,
+                  " active queries. Vulkan requires that queries are begun and ended in the same command buffer.");
+    DEV_CHECK_ERR(!IsConditionalRenderingActive(),
+                  "Flushing device context inside an active conditional rendering block. Vulkan requires that conditional rendering begins and ends in the same command buffer.");
+
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr,
+                  "Flushing device context inside an active render pass.");
+
+    // Command buffers queued by previous calls to ExecuteCommandLists() go first, followed by
+    // the current command buffer of this context and the command lists passed to this method.
+    EndCurrentCmdBuffer();
+    EnqueueCommandLists(NumCommandLists, ppCommandLists);
+
+    SmallVector<VkCommandBuffer, 8> vkCmdBuffs;
+    vkCmdBuffs.reserve(m_PendingCmdBuffers.size());
+    for (const auto& Pending : m_PendingCmdBuffers)
+        vkCmdBuffs.push_back(Pending.vkCmdBuff);
 
     VERIFY_EXPR(m_VkWaitSemaphores.size() == m_WaitManagedSemaphores.size() + m_WaitRecycledSemaphores.size());
     VERIFY_EXPR(m_VkSignalSemaphores.size() == m_SignalManagedSemaphores.size());
@@ -1380,24 +1885,37 @@ void DeviceContextVkImpl::Flush(Uint32               NumCommandLists,
     m_WaitSemaphoreValues.clear();
     m_SignalSemaphoreValues.clear();
 
-    size_t buff_idx = 0;
-    if (vkCmdBuff != VK_NULL_HANDLE)
+    for (auto& Pending : m_PendingCmdBuffers)
     {
-        VERIFY_EXPR(vkCmdBuffs[buff_idx] == vkCmdBuff);
-        DisposeCurrentCmdBuffer(GetCommandQueueId(), SubmittedFenceValue);
-        ++buff_idx;
+        if (!Pending.pDeferredCtx)
+        {
+            // Command buffer of this context
+            DisposeVkCmdBuffer(GetCommandQueueId(), Pending.vkCmdBuff, SubmittedFenceValue);
+            continue;
+        }
+
+        if (Pending.pReusableCmdList)
+        {
+            // The command buffer will be disposed when the command list is released
+            Pending.pReusableCmdList.RawPtr<CommandListVkImpl>()->OnSubmitted(GetCommandQueueId(), SubmittedFenceValue);
+            continue;
+        }
+
+        // It is OK to dispose command buffer from another thread. We are not going to
+        // record any commands and only need to add the buffer to the queue
+        Pending.pDeferredCtx.RawPtr<DeviceContextVkImpl>()->DisposeVkCmdBuffer(GetCommandQueueId(), Pending.vkCmdBuff, SubmittedFenceValue);
     }
+    m_PendingCmdBuffers.clear();
 
-    for (Uint32 i = 0; i < NumCommandLists; ++i, ++buff_idx)
+    // Secondary command buffers have been submitted as part of the primary command buffer
+    VERIFY(m_ExecutedSecondaryCmdBuffs.empty() || !vkCmdBuffs.empty(), "Secondary command buffers have been executed without primary command buffer");
+    for (auto& CtxAndCmdBuff : m_ExecutedSecondaryCmdBuffs)
     {
-        auto pDeferredCtxVkImpl = DeferredCtxs[i].RawPtr<DeviceContextVkImpl>();
-        // Set the bit in the deferred context cmd queue mask corresponding to cmd queue of this context
+        auto pDeferredCtxVkImpl = CtxAndCmdBuff.first.RawPtr<DeviceContextVkImpl>();
         pDeferredCtxVkImpl->UpdateSubmittedBuffersCmdQueueMask(GetCommandQueueId());
-        // It is OK to dispose command buffer from another thread. We are not going to
-        // record any commands and only need to add the buffer to the queue
-        pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), std::move(vkCmdBuffs[buff_idx]), SubmittedFenceValue);
+        pDeferredCtxVkImpl->DisposeVkCmdBuffer(GetCommandQueueId(), CtxAndCmdBuff.second, SubmittedFenceValue, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
     }
-    VERIFY_EXPR(buff_idx == vkCmdBuffs.size());
+    m_ExecutedSecondaryCmdBuffs.clear();
 
     m_State    = {};
     m_BindInfo = {};
@@ -1418,7 +1936,7 @@ void DeviceContextVkImpl::SetVertexBuffers(Uint32                         StartS
     for (Uint32 Buff = 0; Buff < m_NumVertexStreams; ++Buff)
     {
         auto& CurrStream = m_VertexStreams[Buff];
-        if (auto* pBufferVk = CurrStream.pBuffer.RawPtr())
+        if (auto* pBufferVk = CurrStream.pBuffer)
         {
             TransitionOrVerifyBufferState(*pBufferVk, StateTransitionMode, RESOURCE_STATE_VERTEX_BUFFER, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
                                           "Setting vertex buffers (DeviceContextVkImpl::SetVertexBuffers)");
@@ -1438,7 +1956,7 @@ void DeviceContextVkImpl::InvalidateState()
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
 
-    VERIFY(m_CommandBuffer.GetState().RenderPass == VK_NULL_HANDLE, "Invalidating context with unifinished render pass");
+    VERIFY(!m_CommandBuffer.IsInsideRenderPass(), "Invalidating context with unifinished render pass");
     m_CommandBuffer.Reset();
 }
 
@@ -1572,9 +2090,28 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     VERIFY(m_pActiveRenderPass == nullptr, "This method must not be called inside an active render pass.");
 
     const auto& CmdBufferState = m_CommandBuffer.GetState();
+    if (m_pDevice->UseDynamicRendering())
+    {
+        // SetRenderTargets() ends the dynamic rendering instance when render targets change,
+        // so an active instance always matches the bound render targets.
+        if (!CmdBufferState.DynamicRendering && (m_NumBoundRenderTargets > 0 || m_pBoundDepthStencil))
+        {
+            if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+                m_CommandBuffer.EndRenderPass();
+#ifdef DILIGENT_DEVELOPMENT
+            if (VerifyStates)
+            {
+                TransitionRenderTargets(RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            }
+#endif
+            BeginDynamicRendering();
+        }
+        return;
+    }
+
     if (CmdBufferState.Framebuffer != m_vkFramebuffer)
     {
-        if (CmdBufferState.RenderPass != VK_NULL_HANDLE)
+        if (m_CommandBuffer.IsInsideRenderPass())
             m_CommandBuffer.EndRenderPass();
 
         if (m_vkFramebuffer != VK_NULL_HANDLE)
@@ -1591,59 +2128,124 @@ void DeviceContextVkImpl::CommitRenderPassAndFramebuffer(bool VerifyStates)
     }
 }
 
-void DeviceContextVkImpl::SetRenderTargets(Uint32                         NumRenderTargets,
-                                           ITextureView*                  ppRenderTargets[],
-                                           ITextureView*                  pDepthStencil,
-                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+void DeviceContextVkImpl::BeginDynamicRendering()
 {
-    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
+    VERIFY_EXPR(m_pDevice->UseDynamicRendering());
 
-    if (TDeviceContextBase::SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil))
+    // Attachment load and store operations as well as layouts match the implicit render pass,
+    // see PipelineStateVkImpl::GetImplicitRenderPassDesc().
+    std::array<VkRenderingAttachmentInfoKHR, MAX_RENDER_TARGETS> ColorAttachments{};
+    for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
     {
-        FramebufferCache::FramebufferCacheKey FBKey;
-        RenderPassCache::RenderPassCacheKey   RenderPassKey;
-        if (m_pBoundDepthStencil)
-        {
-            auto* pDepthBuffer        = m_pBoundDepthStencil->GetTexture();
-            FBKey.DSV                 = m_pBoundDepthStencil->GetVulkanImageView();
-            RenderPassKey.DSVFormat   = m_pBoundDepthStencil->GetDesc().Format;
-            RenderPassKey.SampleCount = static_cast<Uint8>(pDepthBuffer->GetDesc().SampleCount);
-        }
-        else
+        auto& Attachment = ColorAttachments[rt];
+        Attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        if (auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr())
         {
-            FBKey.DSV               = VK_NULL_HANDLE;
-            RenderPassKey.DSVFormat = TEX_FORMAT_UNKNOWN;
+            Attachment.imageView   = pRTVVk->GetVulkanImageView();
+            Attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
         }
+        Attachment.loadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
+        Attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    }
+
+    VkRenderingInfoKHR RenderingInfo{};
+    RenderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    RenderingInfo.renderArea           = {{0, 0}, {m_FramebufferWidth, m_FramebufferHeight}};
+    RenderingInfo.layerCount           = m_FramebufferSlices;
+    RenderingInfo.colorAttachmentCount = m_NumBoundRenderTargets;
+    RenderingInfo.pColorAttachments    = ColorAttachments.data();
 
-        FBKey.NumRenderTargets         = m_NumBoundRenderTargets;
-        RenderPassKey.NumRenderTargets = static_cast<Uint8>(m_NumBoundRenderTargets);
+    VkRenderingAttachmentInfoKHR DepthAttachment{};
+    if (m_pBoundDepthStencil)
+    {
+        DepthAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        DepthAttachment.imageView   = m_pBoundDepthStencil->GetVulkanImageView();
+        DepthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        DepthAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_LOAD;
+        DepthAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+
+        RenderingInfo.pDepthAttachment = &DepthAttachment;
+        if (GetTextureFormatAttribs(m_pBoundDepthStencil->GetDesc().Format).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+            RenderingInfo.pStencilAttachment = &DepthAttachment;
+    }
+
+    m_CommandBuffer.BeginRendering(RenderingInfo);
+}
+
+bool DeviceContextVkImpl::IsFramebufferBound() const
+{
+    // Implicit render passes have no render pass and framebuffer objects when dynamic rendering is used
+    if (m_pActiveRenderPass == nullptr && m_pDevice->UseDynamicRendering())
+        return m_NumBoundRenderTargets > 0 || m_pBoundDepthStencil != nullptr;
+    else
+        return m_vkRenderPass != VK_NULL_HANDLE && m_vkFramebuffer != VK_NULL_HANDLE;
+}
+
+void DeviceContextVkImpl::SetRenderTargets(Uint32                         NumRenderTargets,
+                                           ITextureView*                  ppRenderTargets[],
+                                           ITextureView*                  pDepthStencil,
+                                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
-        for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+    if (TDeviceContextBase::SetRenderTargets(NumRenderTargets, ppRenderTargets, pDepthStencil))
+    {
+        if (m_pDevice->UseDynamicRendering())
+        {
+            // Dynamic rendering does not use render pass and framebuffer objects. The rendering
+            // instance for the new render targets is begun by CommitRenderPassAndFramebuffer().
+            m_vkRenderPass  = VK_NULL_HANDLE;
+            m_vkFramebuffer = VK_NULL_HANDLE;
+            if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInsideRenderPass())
+                m_CommandBuffer.EndRenderPass();
+        }
+        else
         {
-            if (auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr())
+            FramebufferCache::FramebufferCacheKey FBKey;
+            RenderPassCache::RenderPassCacheKey   RenderPassKey;
+            if (m_pBoundDepthStencil)
             {
-                auto* pRenderTarget          = pRTVVk->GetTexture();
-                FBKey.RTVs[rt]               = pRTVVk->GetVulkanImageView();
-                RenderPassKey.RTVFormats[rt] = pRenderTarget->GetDesc().Format;
-                if (RenderPassKey.SampleCount == 0)
-                    RenderPassKey.SampleCount = static_cast<Uint8>(pRenderTarget->GetDesc().SampleCount);
-                else
-                    VERIFY(RenderPassKey.SampleCount == pRenderTarget->GetDesc().SampleCount, "Inconsistent sample count");
+                auto* pDepthBuffer        = m_pBoundDepthStencil->GetTexture();
+                FBKey.DSV                 = m_pBoundDepthStencil->GetVulkanImageView();
+                RenderPassKey.DSVFormat   = m_pBoundDepthStencil->GetDesc().Format;
+                RenderPassKey.SampleCount = static_cast<Uint8>(pDepthBuffer->GetDesc().SampleCount);
             }
             else
             {
-                FBKey.RTVs[rt]               = VK_NULL_HANDLE;
-                RenderPassKey.RTVFormats[rt] = TEX_FORMAT_UNKNOWN;
+                FBKey.DSV               = VK_NULL_HANDLE;
+                RenderPassKey.DSVFormat = TEX_FORMAT_UNKNOWN;
+            }
+
+            FBKey.NumRenderTargets         = m_NumBoundRenderTargets;
+            RenderPassKey.NumRenderTargets = static_cast<Uint8>(m_NumBoundRenderTargets);
+
+            for (Uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+            {
+                if (auto* pRTVVk = m_pBoundRenderTargets[rt].RawPtr())
+                {
+                    auto* pRenderTarget          = pRTVVk->GetTexture();
+                    FBKey.RTVs[rt]               = pRTVVk->GetVulkanImageView();
+                    RenderPassKey.RTVFormats[rt] = pRenderTarget->GetDesc().Format;
+                    if (RenderPassKey.SampleCount == 0)
+                        RenderPassKey.SampleCount = static_cast<Uint8>(pRenderTarget->GetDesc().SampleCount);
+                    else
+                        VERIFY(RenderPassKey.SampleCount == pRenderTarget->GetDesc().SampleCount, "Inconsistent sample count");
+                }
+                else
+                {
+                    FBKey.RTVs[rt]               = VK_NULL_HANDLE;
+                    RenderPassKey.RTVFormats[rt] = TEX_FORMAT_UNKNOWN;
+                }
             }
-        }
 
-        auto& FBCache = m_pDevice->GetFramebufferCache();
-        auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
+            auto& FBCache = m_pDevice->GetFramebufferCache();
+            auto& RPCache = m_pDevice->GetImplicitRenderPassCache();
 
-        m_vkRenderPass         = RPCache.GetRenderPass(RenderPassKey)->GetVkRenderPass();
-        FBKey.Pass             = m_vkRenderPass;
-        FBKey.CommandQueueMask = ~Uint64{0};
-        m_vkFramebuffer        = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+            m_vkRenderPass         = RPCache.GetRenderPass(RenderPassKey)->GetVkRenderPass();
+            FBKey.Pass             = m_vkRenderPass;
+            FBKey.CommandQueueMask = ~Uint64{0};
+            m_vkFramebuffer        = FBCache.GetFramebuffer(FBKey, m_FramebufferWidth, m_FramebufferHeight, m_FramebufferSlices);
+        }
 
         // Set the viewport to match the render target size
         SetViewports(1, nullptr, 0, 0);
@@ -1661,12 +2263,25 @@ void DeviceContextVkImpl::ResetRenderTargets()
     TDeviceContextBase::ResetRenderTargets();
     m_vkRenderPass  = VK_NULL_HANDLE;
     m_vkFramebuffer = VK_NULL_HANDLE;
-    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.IsInsideRenderPass())
         m_CommandBuffer.EndRenderPass();
 }
 
 void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    BeginRenderPass(Attribs, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void DeviceContextVkImpl::BeginRenderPassWithSecondaryCommandBuffers(const BeginRenderPassAttribs& Attribs)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Render passes with secondary command buffers can only be begun by immediate contexts.");
+    BeginRenderPass(Attribs, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+}
+
+void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs, VkSubpassContents SubpassContents)
+{
+    DEV_CHECK_ERR(!m_IsSecondaryCmdBuffer, "Render passes can't be begun in a secondary command buffer.");
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     VERIFY_EXPR(m_pActiveRenderPass != nullptr);
@@ -1706,24 +2321,30 @@ void DeviceContextVkImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
     }
 
     EnsureVkCmdBuffer();
-    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues);
+    m_CommandBuffer.BeginRenderPass(m_vkRenderPass, m_vkFramebuffer, m_FramebufferWidth, m_FramebufferHeight, Attribs.ClearValueCount, pVkClearValues, SubpassContents);
+    m_vkSubpassContents = SubpassContents;
 
-    // Set the viewport to match the framebuffer size
-    SetViewports(1, nullptr, 0, 0);
+    // Set the viewport to match the framebuffer size.
+    // Subpasses recorded into secondary command buffers must set their own viewports.
+    if (SubpassContents == VK_SUBPASS_CONTENTS_INLINE)
+        SetViewports(1, nullptr, 0, 0);
 }
 
 void DeviceContextVkImpl::NextSubpass()
 {
+    DEV_CHECK_ERR(!m_IsSecondaryCmdBuffer, "NextSubpass() can't be called in a secondary command buffer.");
     TDeviceContextBase::NextSubpass();
     VERIFY_EXPR(m_CommandBuffer.GetVkCmdBuffer() != VK_NULL_HANDLE && m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE);
-    m_CommandBuffer.NextSubpass();
+    m_CommandBuffer.NextSubpass(m_vkSubpassContents);
 }
 
 void DeviceContextVkImpl::EndRenderPass()
 {
+    DEV_CHECK_ERR(!m_IsSecondaryCmdBuffer, "EndRenderPass() can't be called in a secondary command buffer. Call FinishCommandList() instead.");
     TDeviceContextBase::EndRenderPass();
     // TDeviceContextBase::EndRenderPass calls ResetRenderTargets() that in turn
     // calls m_CommandBuffer.EndRenderPass()
+    m_vkSubpassContents = VK_SUBPASS_CONTENTS_INLINE;
 }
 
 void DeviceContextVkImpl::UpdateBufferRegion(BufferVkImpl*                  pBuffVk,
@@ -1762,6 +2383,23 @@ void DeviceContextVkImpl::UpdateBuffer(IBuffer*                       pBuffer,
 
     DEV_CHECK_ERR(pBuffVk->GetDesc().Usage != USAGE_DYNAMIC, "Dynamic buffers must be updated via Map()");
 
+    // Small updates are recorded inline into the command buffer with vkCmdUpdateBuffer, which saves
+    // the upload heap space and the copy command. The offset and the size must be multiples of 4
+    // and the size must not exceed 65536 bytes.
+    constexpr Uint32 MaxInlineUpdateSize = 65536;
+    if (Size <= MaxInlineUpdateSize && (Offset % 4) == 0 && (Size % 4) == 0)
+    {
+        DEV_CHECK_ERR(Uint64{Offset} + Uint64{Size} <= pBuffVk->GetDesc().uiSizeInBytes,
+                      "Update region is out of buffer bounds which will result in an undefined behavior");
+
+        EnsureVkCmdBuffer();
+        TransitionOrVerifyBufferState(*pBuffVk, StateTransitionMode, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, "Updating buffer (DeviceContextVkImpl::UpdateBuffer)");
+        VERIFY(pBuffVk->m_VulkanBuffer != VK_NULL_HANDLE, "Updated buffer must not be suballocated");
+        m_CommandBuffer.UpdateBuffer(pBuffVk->GetVkBuffer(), Offset, Size, pData);
+        ++m_State.NumCommands;
+        return;
+    }
+
     constexpr size_t Alignment = 4;
     // Source buffer offset must be multiple of 4 (18.4)
     auto TmpSpace = m_UploadHeap.Allocate(Size, Alignment);
@@ -1818,6 +2456,13 @@ void DeviceContextVkImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
                                 "access and use MAP_FLAG_DO_NOT_WAIT flag.");
         }
 
+        // Readback buffers prefer cached memory that may not be coherent. GPU writes must be
+        // made visible to the host before the application reads the data, i.e. when the buffer is mapped.
+        if ((pBufferVk->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) == 0)
+        {
+            pBufferVk->InvalidateMappedRange(0, BuffDesc.uiSizeInBytes);
+        }
+
         pMappedData = pBufferVk->GetCPUAddress();
     }
     else if (MapType == MAP_WRITE)
@@ -1885,13 +2530,7 @@ void DeviceContextVkImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 
     if (MapType == MAP_READ)
     {
-        if (BuffDesc.Usage == USAGE_STAGING || BuffDesc.Usage == USAGE_UNIFIED)
-        {
-            if ((pBufferVk->GetMemoryProperties() & MEMORY_PROPERTY_HOST_COHERENT) == 0)
-            {
-                pBufferVk->InvalidateMappedRange(0, BuffDesc.uiSizeInBytes);
-            }
-        }
+        // Non-coherent memory is invalidated when the buffer is mapped
     }
     else if (MapType == MAP_WRITE)
     {
@@ -2157,7 +2796,13 @@ void DeviceContextVkImpl::UpdateTextureRegion(const void*                    pSr
 void DeviceContextVkImpl::GenerateMips(ITextureView* pTexView)
 {
     TDeviceContextBase::GenerateMips(pTexView);
-    m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsSRB);
+    m_GenerateMipsHelper->GenerateMips(*ValidatedCast<TextureViewVkImpl>(pTexView), *this, m_GenerateMipsResources);
+}
+
+void DeviceContextVkImpl::GenerateMipsBatch(ITextureView* ppTexViews[], Uint32 NumViews)
+{
+    TDeviceContextBase::GenerateMipsBatch(ppTexViews, NumViews);
+    m_GenerateMipsHelper->GenerateMips(ppTexViews, NumViews, *this, m_GenerateMipsResources);
 }
 
 static VkBufferImageCopy GetBufferImageCopyInfo(Uint32             BufferOffset,
@@ -2244,6 +2889,68 @@ void DeviceContextVkImpl::CopyBufferToTexture(VkBuffer                       vkS
         &BuffImgCopy);
 }
 
+void DeviceContextVkImpl::UpdateTextureRegions(ITexture*                      pTexture,
+                                               const TextureRegionUpdate*     pUpdates,
+                                               Uint32                         NumUpdates,
+                                               RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+{
+    TDeviceContextBase::UpdateTextureRegions(pTexture, pUpdates, NumUpdates, TextureTransitionMode);
+    if (NumUpdates == 0)
+        return;
+
+    auto&       TextureVk = *ValidatedCast<TextureVkImpl>(pTexture);
+    const auto& TexDesc   = TextureVk.GetDesc();
+    DEV_CHECK_ERR(TexDesc.Usage == USAGE_DEFAULT, "Only USAGE_DEFAULT textures should be updated with UpdateTextureRegions()");
+
+    const auto& DeviceLimits       = m_pDevice->GetPhysicalDevice().GetProperties().limits;
+    const auto  RowStrideAlignment = static_cast<Uint32>(DeviceLimits.optimalBufferCopyRowPitchAlignment);
+    // Source buffer offset must be multiple of 4 and, for compressed images, of the texel block size (18.4)
+    auto        BufferOffsetAlignment = std::max(DeviceLimits.optimalBufferCopyOffsetAlignment, VkDeviceSize{4});
+    const auto& FmtAttribs            = GetTextureFormatAttribs(TexDesc.Format);
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+        BufferOffsetAlignment = std::max(BufferOffsetAlignment, VkDeviceSize{FmtAttribs.ComponentSize});
+
+    // Place all regions into one upload heap allocation. Buffer offsets are first
+    // computed relative to the start of the allocation.
+    m_BufferImageCopies.resize(NumUpdates);
+    VkDeviceSize UploadSize = 0;
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update   = pUpdates[i];
+        const auto  CopyInfo = GetBufferToTextureCopyInfo(TexDesc.Format, Update.DstBox, RowStrideAlignment);
+
+        UploadSize             = AlignUp(UploadSize, BufferOffsetAlignment);
+        m_BufferImageCopies[i] = GetBufferImageCopyInfo(static_cast<Uint32>(UploadSize), CopyInfo.RowStrideInTexels, TexDesc, CopyInfo.Region, Update.MipLevel, Update.Slice);
+        UploadSize += CopyInfo.MemorySize;
+    }
+
+    auto Allocation = m_UploadHeap.Allocate(UploadSize, BufferOffsetAlignment);
+    VERIFY((Allocation.AlignedOffset % BufferOffsetAlignment) == 0, "Allocation offset must be properly aligned");
+
+    for (Uint32 i = 0; i < NumUpdates; ++i)
+    {
+        const auto& Update   = pUpdates[i];
+        const auto  CopyInfo = GetBufferToTextureCopyInfo(TexDesc.Format, Update.DstBox, RowStrideAlignment);
+        auto&       Copy     = m_BufferImageCopies[i];
+
+        CopyTextureSubresource(Update.SrcData, CopyInfo.RowCount, Update.DstBox.MaxZ - Update.DstBox.MinZ, CopyInfo.RowSize,
+                               reinterpret_cast<Uint8*>(Allocation.CPUAddress) + Copy.bufferOffset,
+                               CopyInfo.RowStride, CopyInfo.DepthStride);
+        Copy.bufferOffset += Allocation.AlignedOffset;
+    }
+
+    // One state transition and one copy command for all regions
+    EnsureVkCmdBuffer();
+    TransitionOrVerifyTextureState(TextureVk, TextureTransitionMode, RESOURCE_STATE_COPY_DEST, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   "Using texture as copy destination (DeviceContextVkImpl::UpdateTextureRegions)");
+    m_CommandBuffer.CopyBufferToImage(
+        Allocation.vkBuffer,
+        TextureVk.GetVkImage(),
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, // must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+        NumUpdates,
+        m_BufferImageCopies.data());
+}
+
 void DeviceContextVkImpl::CopyTextureToBuffer(TextureVkImpl&                 SrcTextureVk,
                                               const Box&                     SrcRegion,
                                               Uint32                         SrcMipLevel,
@@ -2425,21 +3132,32 @@ void DeviceContextVkImpl::UnmapTextureSubresource(ITexture* pTexture,
 void DeviceContextVkImpl::FinishCommandList(ICommandList** ppCommandList)
 {
     DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
-    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr || m_IsSecondaryCmdBuffer, "Finishing command list inside an active render pass.");
 
-    if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
+    if (m_IsSecondaryCmdBuffer)
+    {
+        // The render pass is ended by the primary command buffer
+        m_pActiveRenderPass = nullptr;
+        m_pBoundFramebuffer = nullptr;
+        m_SubpassIndex      = 0;
+    }
+    else if (m_CommandBuffer.IsInsideRenderPass())
     {
         m_CommandBuffer.EndRenderPass();
     }
 
+    m_CommandBuffer.FlushBarriers();
+
     auto vkCmdBuff = m_CommandBuffer.GetVkCmdBuffer();
     auto err       = vkEndCommandBuffer(vkCmdBuff);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to end command buffer");
     (void)err;
 
-    CommandListVkImpl* pCmdListVk(NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff));
+    CommandListVkImpl* pCmdListVk(NEW_RC_OBJ(m_CmdListAllocator, "CommandListVkImpl instance", CommandListVkImpl)(m_pDevice, this, vkCmdBuff, m_IsSecondaryCmdBuffer));
     pCmdListVk->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
 
+    m_IsSecondaryCmdBuffer = false;
+
     m_CommandBuffer.Reset();
     m_State          = ContextState{};
     m_pPipelineState = nullptr;
@@ -2458,11 +3176,69 @@ void DeviceContextVkImpl::ExecuteCommandLists(Uint32               NumCommandLis
         return;
     DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
 
-    Flush(NumCommandLists, ppCommandLists);
+    if (m_pActiveRenderPass != nullptr)
+    {
+        ExecuteSecondaryCommandLists(NumCommandLists, ppCommandLists);
+        return;
+    }
+
+    if (m_BatchCommandListSubmission)
+    {
+        DEV_CHECK_ERR(m_ActiveQueriesCounter == 0,
+                      "Executing command lists in a device context that has ", m_ActiveQueriesCounter,
+                      " active queries. Vulkan requires that queries are begun and ended in the same command buffer.");
+
+        // Command lists are submitted together with all other pending command buffers by the next Flush()
+        EndCurrentCmdBuffer();
+        EnqueueCommandLists(NumCommandLists, ppCommandLists);
+
+        m_State    = {};
+        m_BindInfo = {};
+        m_pPipelineState    = nullptr;
+        m_pActiveRenderPass = nullptr;
+        m_pBoundFramebuffer = nullptr;
+    }
+    else
+    {
+        Flush(NumCommandLists, ppCommandLists);
+    }
 
     InvalidateState();
 }
 
+void DeviceContextVkImpl::ExecuteSecondaryCommandLists(Uint32               NumCommandLists,
+                                                       ICommandList* const* ppCommandLists)
+{
+    DEV_CHECK_ERR(m_vkSubpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+                  "Command lists can only be executed inside a render pass begun with BeginRenderPassWithSecondaryCommandBuffers().");
+
+    auto* vkCmdBuffs = m_FrameAllocator.Allocate<VkCommandBuffer>(NumCommandLists);
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        auto* pCmdListVk = ValidatedCast<CommandListVkImpl>(ppCommandLists[i]);
+        DEV_CHECK_ERR(pCmdListVk != nullptr, "Command list must not be null");
+        DEV_CHECK_ERR(pCmdListVk->GetQueueId() == GetDesc().QueueId, "Command list recorded for QueueId ", pCmdListVk->GetQueueId(), ", but executed on QueueId ", GetDesc().QueueId, ".");
+        DEV_CHECK_ERR(pCmdListVk->IsSecondary(), "Only command lists recorded with BeginSecondaryCommandBuffer() can be executed inside a render pass.");
+
+        RefCntAutoPtr<IDeviceContext> pDeferredCtx;
+        pCmdListVk->Close(pDeferredCtx, vkCmdBuffs[i]);
+        VERIFY(vkCmdBuffs[i] != VK_NULL_HANDLE, "Trying to execute empty command buffer");
+        VERIFY_EXPR(pDeferredCtx != nullptr);
+        m_ExecutedSecondaryCmdBuffs.emplace_back(std::move(pDeferredCtx), vkCmdBuffs[i]);
+    }
+
+    EnsureVkCmdBuffer();
+    m_CommandBuffer.ExecuteCommands(NumCommandLists, vkCmdBuffs);
+    ++m_State.NumCommands;
+
+    // All states except for the render pass become undefined after secondary command buffers are executed
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+    m_State.vkPipelineBindPoint  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+    m_BindInfo                   = {};
+    m_pPipelineState             = nullptr;
+}
+
 void DeviceContextVkImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
 {
     TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
@@ -2554,12 +3330,12 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
                "No query flag is set which indicates there was no matching BeginQuery call or there was an error while beginning the query.");
         if (CmdBuffState.OutsidePassQueries & (1 << QueryType))
         {
-            if (m_CommandBuffer.GetState().RenderPass)
+            if (m_CommandBuffer.IsInsideRenderPass())
                 m_CommandBuffer.EndRenderPass();
         }
         else
         {
-            if (!m_CommandBuffer.GetState().RenderPass)
+            if (!m_CommandBuffer.IsInsideRenderPass())
                 LOG_ERROR_MESSAGE("The query was started inside render pass, but is being ended oustside of render pass. "
                                   "Vulkan requires that a query must either begin and end inside the same "
                                   "subpass of a render pass instance, or must both begin and end outside of a render pass "
@@ -2572,6 +3348,113 @@ void DeviceContextVkImpl::EndQuery(IQuery* pQuery)
 }
 
 
+Bool DeviceContextVkImpl::GetTimestampCalibration(TimestampCalibration& Calibration)
+{
+    if (IsDeferred())
+    {
+        DEV_ERROR("Deferred contexts have no command queues and can't calibrate timestamps");
+        return False;
+    }
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    if (!LogicalDevice.GetEnabledExtFeatures().CalibratedTimestamps || !m_QueryMgr)
+        return False;
+
+#if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID
+    std::array<VkCalibratedTimestampInfoEXT, 2> TimestampInfos{};
+    TimestampInfos[0].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    TimestampInfos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    TimestampInfos[1].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+    TimestampInfos[1].timeDomain = VulkanUtilities::VulkanPhysicalDevice::HostTimeDomain;
+
+    std::array<uint64_t, 2> Timestamps{};
+    uint64_t                MaxDeviation = 0;
+    if (LogicalDevice.GetCalibratedTimestamps(static_cast<uint32_t>(TimestampInfos.size()), TimestampInfos.data(), Timestamps.data(), &MaxDeviation) != VK_SUCCESS)
+        return False;
+
+    Calibration.GPUCounter   = Timestamps[0];
+    Calibration.GPUFrequency = m_QueryMgr->GetCounterFrequency();
+#    if PLATFORM_WIN32
+    // The host timestamp is the value of QueryPerformanceCounter
+    LARGE_INTEGER QPCFrequency{};
+    QueryPerformanceFrequency(&QPCFrequency);
+    const auto QPCTicksPerSecond = static_cast<Uint64>(QPCFrequency.QuadPart);
+    Calibration.CPUTime          = (Timestamps[1] / QPCTicksPerSecond) * 1000000000ull + (Timestamps[1] % QPCTicksPerSecond) * 1000000000ull / QPCTicksPerSecond;
+#    else
+    // CLOCK_MONOTONIC is in nanoseconds
+    Calibration.CPUTime = Timestamps[1];
+#    endif
+    Calibration.MaxDeviation = MaxDeviation;
+    return True;
+#else
+    return False;
+#endif
+}
+
+void DeviceContextVkImpl::BeginConditionalRendering(IQuery* pQuery)
+{
+    TDeviceContextBase::BeginConditionalRendering(pQuery, 0);
+
+    if (m_PredicateBuffer == VK_NULL_HANDLE)
+    {
+        const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+        VkBufferCreateInfo BuffCI{};
+        BuffCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        BuffCI.pNext                 = nullptr;
+        BuffCI.flags                 = 0;
+        BuffCI.size                  = sizeof(Uint32); // Conditional rendering reads a 32-bit predicate
+        BuffCI.usage                 = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+        BuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+        BuffCI.queueFamilyIndexCount = 0;
+        BuffCI.pQueueFamilyIndices   = nullptr;
+        m_PredicateBuffer            = LogicalDevice.CreateBuffer(BuffCI, "Predicate buffer");
+
+        const auto MemReqs      = LogicalDevice.GetBufferMemoryRequirements(m_PredicateBuffer);
+        m_PredicateBufferMemory = m_pDevice->AllocateMemory(MemReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        const auto AlignedOffset = AlignUp(m_PredicateBufferMemory.UnalignedOffset, MemReqs.alignment);
+        VERIFY_EXPR(m_PredicateBufferMemory.Size >= MemReqs.size + (AlignedOffset - m_PredicateBufferMemory.UnalignedOffset));
+
+        auto err = LogicalDevice.BindBufferMemory(m_PredicateBuffer, m_PredicateBufferMemory.Page->GetVkMemory(), AlignedOffset);
+        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind predicate buffer memory");
+    }
+
+    auto* pQueryVkImpl = ValidatedCast<QueryVkImpl>(pQuery);
+    auto  vkQueryPool  = m_QueryMgr->GetQueryPool(QUERY_TYPE_BINARY_OCCLUSION);
+    VERIFY(vkQueryPool != VK_NULL_HANDLE, "Query pool is not initialized for binary occlusion queries");
+
+    EnsureVkCmdBuffer();
+
+    // Wait for the previous conditional rendering block that used the buffer
+    m_CommandBuffer.BufferMemoryBarrier(m_PredicateBuffer,
+                                        VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+                                        VK_ACCESS_TRANSFER_WRITE_BIT,
+                                        VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT);
+    // The result is copied as a 32-bit value that is non-zero if any samples passed.
+    // The copy waits for the query to become available and ends the render pass, if necessary.
+    m_CommandBuffer.CopyQueryPoolResults(vkQueryPool, pQueryVkImpl->GetQueryPoolIndex(0), 1,
+                                         m_PredicateBuffer, 0, sizeof(Uint32), VK_QUERY_RESULT_WAIT_BIT);
+    m_CommandBuffer.BufferMemoryBarrier(m_PredicateBuffer,
+                                        VK_ACCESS_TRANSFER_WRITE_BIT,
+                                        VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT,
+                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                        VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT);
+
+    m_CommandBuffer.BeginConditionalRendering(m_PredicateBuffer, 0);
+}
+
+void DeviceContextVkImpl::EndConditionalRendering()
+{
+    TDeviceContextBase::EndConditionalRendering(0);
+
+    EnsureVkCmdBuffer();
+    // Conditional rendering began outside of a render pass, so it must also end outside of it
+    m_CommandBuffer.EndConditionalRendering();
+}
+
+
 void DeviceContextVkImpl::TransitionImageLayout(ITexture* pTexture, VkImageLayout NewLayout)
 {
     VERIFY_EXPR(pTexture != nullptr);
@@ -2611,6 +3494,9 @@ void DeviceContextVkImpl::TransitionTextureState(TextureVkImpl&           Textur
                                                  bool                     UpdateTextureState,
                                                  VkImageSubresourceRange* pSubresRange /* = nullptr*/)
 {
+    if (!CheckStateTransitionAllowed())
+        return;
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
@@ -2716,6 +3602,9 @@ void DeviceContextVkImpl::TransitionImageLayout(TextureVkImpl& TextureVk, VkImag
     // VERIFY(!TextureVk.IsInKnownState() || TextureVk.GetLayout() != NewLayout, "The texture is already transitioned to correct layout");
 
     VERIFY(OldLayout != NewLayout, "Old and new layouts are the same");
+    if (!CheckStateTransitionAllowed())
+        return;
+
     EnsureVkCmdBuffer();
     auto vkImg = TextureVk.GetVkImage();
     m_CommandBuffer.TransitionImageLayout(vkImg, OldLayout, NewLayout, SubresRange);
@@ -2746,6 +3635,9 @@ VkCommandBuffer DeviceContextVkImpl::GetVkCommandBuffer()
 
 void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE_STATE OldState, RESOURCE_STATE NewState, bool UpdateBufferState)
 {
+    if (!CheckStateTransitionAllowed())
+        return;
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
@@ -2791,6 +3683,68 @@ void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE
     }
 }
 
+VkDeviceSize DeviceContextVkImpl::RelocateBufferMemory(BufferVkImpl& BufferVk, double MaxSrcPageOccupancy)
+{
+    VERIFY(m_pActiveRenderPass == nullptr, "Buffers can't be relocated inside a render pass");
+    VERIFY_EXPR(!IsDeferred() && BufferVk.GetDesc().ImmediateContextMask == (Uint64{1} << GetContextId()));
+    VERIFY_EXPR(BufferVk.IsRelocatable());
+
+    if (!BufferVk.IsInKnownState())
+        return 0;
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    const auto& BuffDesc      = BufferVk.GetDesc();
+
+    // Buffers created with the same parameters have the same memory requirements
+    const auto MemReqs       = LogicalDevice.GetBufferMemoryRequirements(BufferVk.m_VulkanBuffer);
+    auto       NewAllocation = m_pDevice->GetGlobalMemoryManager().AllocateForRelocation(BufferVk.m_MemoryAllocation, MemReqs.size, MemReqs.alignment, MaxSrcPageOccupancy);
+    if (NewAllocation.Page == nullptr)
+        return 0;
+
+    VkBufferCreateInfo VkBuffCI{};
+    VkBuffCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.size        = BuffDesc.uiSizeInBytes;
+    VkBuffCI.usage       = BufferVk.m_VkUsageFlags;
+    VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    auto NewBuffer     = LogicalDevice.CreateBuffer(VkBuffCI, BuffDesc.Name);
+    auto AlignedOffset = AlignUp(NewAllocation.UnalignedOffset, MemReqs.alignment);
+    auto err           = LogicalDevice.BindBufferMemory(NewBuffer, NewAllocation.Page->GetVkMemory(), AlignedOffset);
+    if (err != VK_SUCCESS)
+    {
+        // The new buffer has never been used by the GPU, so it is safe to release it immediately
+        LOG_ERROR_MESSAGE("Failed to bind memory to the relocated buffer '", BuffDesc.Name, '\'');
+        return 0;
+    }
+
+    EnsureVkCmdBuffer();
+    const auto OrigState = BufferVk.GetState();
+    TransitionBufferState(BufferVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, true);
+
+    VkBufferCopy CopyRegion;
+    CopyRegion.srcOffset = 0;
+    CopyRegion.dstOffset = 0;
+    CopyRegion.size      = BuffDesc.uiSizeInBytes;
+    m_CommandBuffer.CopyBuffer(BufferVk.m_VulkanBuffer, NewBuffer, 1, &CopyRegion);
+    ++m_State.NumCommands;
+
+    m_pDevice->SafeReleaseDeviceObject(std::move(BufferVk.m_VulkanBuffer), BuffDesc.ImmediateContextMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(BufferVk.m_MemoryAllocation), BuffDesc.ImmediateContextMask);
+    BufferVk.m_VulkanBuffer              = std::move(NewBuffer);
+    BufferVk.m_MemoryAllocation          = std::move(NewAllocation);
+    BufferVk.m_BufferMemoryAlignedOffset = AlignedOffset;
+
+    // The new buffer has been written by the copy command
+    BufferVk.SetState(RESOURCE_STATE_COPY_DEST);
+    TransitionBufferState(BufferVk, RESOURCE_STATE_UNKNOWN, OrigState, true);
+
+    // Vertex and index buffer handles must be bound again
+    m_State.CommittedVBsUpToDate = false;
+    m_State.CommittedIBUpToDate  = false;
+
+    return BuffDesc.uiSizeInBytes;
+}
+
 void DeviceContextVkImpl::TransitionOrVerifyBufferState(BufferVkImpl&                  Buffer,
                                                         RESOURCE_STATE_TRANSITION_MODE TransitionMode,
                                                         RESOURCE_STATE                 RequiredState,
@@ -2819,6 +3773,9 @@ void DeviceContextVkImpl::TransitionBLASState(BottomLevelASVkImpl& BLAS,
                                               RESOURCE_STATE       NewState,
                                               bool                 UpdateInternalState)
 {
+    if (!CheckStateTransitionAllowed())
+        return;
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
@@ -2865,6 +3822,9 @@ void DeviceContextVkImpl::TransitionTLASState(TopLevelASVkImpl& TLAS,
                                               RESOURCE_STATE    NewState,
                                               bool              UpdateInternalState)
 {
+    if (!CheckStateTransitionAllowed())
+        return;
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
     if (OldState == RESOURCE_STATE_UNKNOWN)
     {
@@ -2955,6 +3915,9 @@ void DeviceContextVkImpl::TransitionOrVerifyTLASState(TopLevelASVkImpl&
 
 VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint32 SizeInBytes, Uint32 Alignment)
 {
+    DEV_CHECK_ERR(!IsRecordingReusableCommandList(),
+                  "Dynamic heap allocations are only valid until the end of the frame and can't be used in a reusable command list. "
+                  "Use buffers with USAGE_DEFAULT and update their contents before executing the command list.");
     auto DynAlloc = m_DynamicHeap.Allocate(SizeInBytes, Alignment);
 #ifdef DILIGENT_DEVELOPMENT
     DynAlloc.dvpFrameNumber = GetFrameNumber();
@@ -2962,28 +3925,97 @@ VulkanDynamicAllocation DeviceContextVkImpl::AllocateDynamicSpace(Uint32 SizeInB
     return DynAlloc;
 }
 
+int DeviceContextVkImpl::FindPendingSplitBarrier(const StateTransitionDesc& Barrier) const
+{
+    for (size_t i = 0; i < m_PendingSplitBarriers.size(); ++i)
+    {
+        const auto& Split = m_PendingSplitBarriers[i];
+        if (Split.pResource == Barrier.pResource &&
+            Split.FirstMipLevel == Barrier.FirstMipLevel &&
+            Split.MipLevelsCount == Barrier.MipLevelsCount &&
+            Split.FirstArraySlice == Barrier.FirstArraySlice &&
+            Split.ArraySliceCount == Barrier.ArraySliceCount)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void DeviceContextVkImpl::BeginSplitBarrier(const StateTransitionDesc& Barrier)
+{
+    RESOURCE_STATE OldState = Barrier.OldState;
+    if (RefCntAutoPtr<TextureVkImpl> pTexture{Barrier.pResource, IID_TextureVk})
+    {
+        if (OldState == RESOURCE_STATE_UNKNOWN && pTexture->IsInKnownState())
+            OldState = pTexture->GetState();
+    }
+    else if (RefCntAutoPtr<BufferVkImpl> pBuffer{Barrier.pResource, IID_BufferVk})
+    {
+        if (OldState == RESOURCE_STATE_UNKNOWN && pBuffer->IsInKnownState())
+            OldState = pBuffer->GetState();
+    }
+    else
+    {
+        // Acceleration structures are transitioned by the end barrier only
+        return;
+    }
+
+    if (OldState == RESOURCE_STATE_UNKNOWN)
+    {
+        LOG_ERROR_MESSAGE("Failed to begin split transition because the resource state is unknown and is not explicitly specified.");
+        return;
+    }
+
+    if (FindPendingSplitBarrier(Barrier) >= 0)
+    {
+        LOG_ERROR_MESSAGE("Split transition for the same resource and subresource range has already been started.");
+        return;
+    }
+
+    auto SrcStages = ResourceStateFlagsToVkPipelineStageFlags(OldState) & m_CommandBuffer.GetSupportedStagesMask();
+    if (SrcStages == 0)
+    {
+        // The resource was not accessed by any stage, so there is nothing to wait for
+        SrcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    }
+
+    VkEventCreateInfo EventCI{};
+    EventCI.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+
+    PendingSplitBarrier Split;
+    Split.pResource       = Barrier.pResource;
+    Split.FirstMipLevel   = Barrier.FirstMipLevel;
+    Split.MipLevelsCount  = Barrier.MipLevelsCount;
+    Split.FirstArraySlice = Barrier.FirstArraySlice;
+    Split.ArraySliceCount = Barrier.ArraySliceCount;
+    Split.SrcStages       = SrcStages;
+    Split.Event           = m_pDevice->GetLogicalDevice().CreateEvent(EventCI);
+
+    // The event is signaled once all preceding commands complete the source stages
+    m_CommandBuffer.SetEvent(Split.Event, SrcStages);
+    m_PendingSplitBarriers.emplace_back(std::move(Split));
+}
+
 void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
 {
+    if (!CheckStateTransitionAllowed())
+        return;
+
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+    CountStateTransitions(BarrierCount);
 
     if (BarrierCount == 0)
         return;
 
     EnsureVkCmdBuffer();
 
-    for (Uint32 i = 0; i < BarrierCount; ++i)
-    {
-        const auto& Barrier = pResourceBarriers[i];
-#ifdef DILIGENT_DEVELOPMENT
-        DvpVerifyStateTransitionDesc(Barrier);
-#endif
-        if (Barrier.TransitionType == STATE_TRANSITION_TYPE_BEGIN)
+    const auto TransitionResource = [this](const StateTransitionDesc& Barrier) {
+        if (Barrier.pResourceBefore != nullptr)
         {
-            // Skip begin-split barriers
-            VERIFY(!Barrier.UpdateResourceState, "Resource state can't be updated in begin-split barrier");
-            continue;
+            // Aliasing barrier: all writes to the shared memory made through the previous
+            // resource must be complete and visible before the new resource is accessed.
+            m_CommandBuffer.GlobalMemoryBarrier(VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+                                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
         }
-        VERIFY(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || Barrier.TransitionType == STATE_TRANSITION_TYPE_END, "Unexpected barrier type");
 
         if (RefCntAutoPtr<TextureVkImpl> pTexture{Barrier.pResource, IID_TextureVk})
         {
@@ -2993,7 +4025,16 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
             SubResRange.levelCount     = (Barrier.MipLevelsCount == REMAINING_MIP_LEVELS) ? VK_REMAINING_MIP_LEVELS : Barrier.MipLevelsCount;
             SubResRange.baseArrayLayer = Barrier.FirstArraySlice;
             SubResRange.layerCount     = (Barrier.ArraySliceCount == REMAINING_ARRAY_SLICES) ? VK_REMAINING_ARRAY_LAYERS : Barrier.ArraySliceCount;
-            TransitionTextureState(*pTexture, Barrier.OldState, Barrier.NewState, Barrier.UpdateResourceState, &SubResRange);
+
+            auto OldState = Barrier.OldState;
+            if (Barrier.pResourceBefore != nullptr)
+            {
+                // The contents of an aliased image are undefined, so it is always transitioned from the undefined layout
+                if (pTexture->IsInKnownState())
+                    pTexture->SetState(RESOURCE_STATE_UNDEFINED);
+                OldState = RESOURCE_STATE_UNDEFINED;
+            }
+            TransitionTextureState(*pTexture, OldState, Barrier.NewState, Barrier.UpdateResourceState, &SubResRange);
         }
         else if (RefCntAutoPtr<BufferVkImpl> pBuffer{Barrier.pResource, IID_BufferVk})
         {
@@ -3011,6 +4052,70 @@ void DeviceContextVkImpl::TransitionResourceStates(Uint32 BarrierCount, const St
         {
             UNEXPECTED("unsupported resource type");
         }
+    };
+
+    // Immediate barriers and end barriers without a matching begin barrier are accumulated
+    // by the command buffer and recorded by a single vkCmdPipelineBarrier.
+    // End barriers of split transitions are recorded by a single vkCmdWaitEvents.
+    // Begin barriers set their events after all other barriers have been recorded.
+    bool HasSplitBarriers = false;
+    for (Uint32 i = 0; i < BarrierCount; ++i)
+    {
+        const auto& Barrier = pResourceBarriers[i];
+#ifdef DILIGENT_DEVELOPMENT
+        DvpVerifyStateTransitionDesc(Barrier);
+#endif
+        if (Barrier.TransitionType == STATE_TRANSITION_TYPE_BEGIN)
+        {
+            VERIFY(!Barrier.UpdateResourceState, "Resource state can't be updated in begin-split barrier");
+            HasSplitBarriers = true;
+            continue;
+        }
+        VERIFY(Barrier.TransitionType == STATE_TRANSITION_TYPE_IMMEDIATE || Barrier.TransitionType == STATE_TRANSITION_TYPE_END, "Unexpected barrier type");
+
+        if (Barrier.TransitionType == STATE_TRANSITION_TYPE_END && FindPendingSplitBarrier(Barrier) >= 0)
+        {
+            HasSplitBarriers = true;
+            continue;
+        }
+
+        TransitionResource(Barrier);
+    }
+
+    if (!HasSplitBarriers)
+        return;
+
+    m_CommandBuffer.FlushBarriers();
+
+    auto*                vkEvents       = m_FrameAllocator.Allocate<VkEvent>(BarrierCount);
+    Uint32               NumEvents      = 0;
+    VkPipelineStageFlags EventSrcStages = 0;
+    for (Uint32 i = 0; i < BarrierCount; ++i)
+    {
+        const auto& Barrier = pResourceBarriers[i];
+        if (Barrier.TransitionType != STATE_TRANSITION_TYPE_END)
+            continue;
+
+        const auto SplitIdx = FindPendingSplitBarrier(Barrier);
+        if (SplitIdx < 0)
+            continue;
+
+        auto& Split = m_PendingSplitBarriers[SplitIdx];
+        TransitionResource(Barrier);
+        vkEvents[NumEvents++] = Split.Event;
+        EventSrcStages |= Split.SrcStages;
+        m_UsedSplitBarrierEvents.emplace_back(std::move(Split.Event));
+        m_PendingSplitBarriers.erase(m_PendingSplitBarriers.begin() + SplitIdx);
+    }
+
+    if (m_CommandBuffer.HasPendingBarriers())
+        m_CommandBuffer.WaitEvents(NumEvents, vkEvents, EventSrcStages);
+
+    for (Uint32 i = 0; i < BarrierCount; ++i)
+    {
+        const auto& Barrier = pResourceBarriers[i];
+        if (Barrier.TransitionType == STATE_TRANSITION_TYPE_BEGIN)
+            BeginSplitBarrier(Barrier);
     }
 }
 
@@ -3069,28 +4174,160 @@ void DeviceContextVkImpl::ResolveTextureSubresource(ITexture*
                                  1, &ResolveRegion);
 }
 
-void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+void DeviceContextVkImpl::UpdateTileMappings(const UpdateTileMappingsAttribs& Attribs)
 {
-    TDeviceContextBase::BuildBLAS(Attribs, 0);
+    TDeviceContextBase::UpdateTileMappings(Attribs, 0);
 
-    auto* pBLASVk    = ValidatedCast<BottomLevelASVkImpl>(Attribs.pBLAS);
-    auto* pScratchVk = ValidatedCast<BufferVkImpl>(Attribs.pScratchBuffer);
-    auto& BLASDesc   = pBLASVk->GetDesc();
+    DEV_CHECK_ERR((GetDesc().QueueType & COMMAND_QUEUE_TYPE_SPARSE_BINDING) == COMMAND_QUEUE_TYPE_SPARSE_BINDING,
+                  "UpdateTileMappings: command queue of context '", GetDesc().Name, "' does not support sparse binding operations");
 
-    EnsureVkCmdBuffer();
+    std::vector<VkSparseMemoryBind>      BufferBinds;
+    std::vector<VkSparseImageMemoryBind> ImageBinds;
+    std::vector<VkSparseMemoryBind>      MipTailBinds;
 
-    const char* OpName = "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)";
-    TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
-    TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
+    VkSparseBufferMemoryBindInfo      BufferBindInfo{};
+    VkSparseImageMemoryBindInfo       ImageBindInfo{};
+    VkSparseImageOpaqueMemoryBindInfo MipTailBindInfo{};
 
-    VkAccelerationStructureBuildGeometryInfoKHR           vkASBuildInfo = {};
-    std::vector<VkAccelerationStructureBuildRangeInfoKHR> vkRanges;
-    std::vector<VkAccelerationStructureGeometryKHR>       vkGeometries;
+    if (Attribs.pBuffer != nullptr)
+    {
+        auto* const pBuffVk   = ValidatedCast<BufferVkImpl>(Attribs.pBuffer);
+        const auto& BuffDesc  = pBuffVk->GetDesc();
+        const auto  BlockSize = VkDeviceSize{pBuffVk->GetSparseBlockSize()};
 
+        BufferBinds.reserve(Attribs.NumRanges);
+        for (Uint32 i = 0; i < Attribs.NumRanges; ++i)
+        {
+            const auto& Range = Attribs.pRanges[i];
+
+            VkSparseMemoryBind BufferBind{};
+            BufferBind.resourceOffset = Range.TileX * BlockSize;
+            // The size must be a multiple of the block size unless the range reaches the end of the buffer
+            BufferBind.size         = std::min(Range.NumTilesX * BlockSize, VkDeviceSize{BuffDesc.uiSizeInBytes} - BufferBind.resourceOffset);
+            BufferBind.memory       = Range.pHeap != nullptr ? ValidatedCast<ResourceHeapVkImpl>(Range.pHeap)->GetVkDeviceMemory() : VK_NULL_HANDLE;
+            BufferBind.memoryOffset = Range.pHeap != nullptr ? static_cast<VkDeviceSize>(Range.HeapOffset) : VkDeviceSize{0};
+            BufferBinds.push_back(BufferBind);
+        }
+
+        BufferBindInfo.buffer    = pBuffVk->GetVkBuffer();
+        BufferBindInfo.bindCount = static_cast<uint32_t>(BufferBinds.size());
+        BufferBindInfo.pBinds    = BufferBinds.data();
+    }
+    else
+    {
+        auto* const pTexVk      = ValidatedCast<TextureVkImpl>(Attribs.pTexture);
+        const auto& TexDesc     = pTexVk->GetDesc();
+        const auto& SparseProps = pTexVk->GetSparseProperties();
+
+        ImageBinds.reserve(Attribs.NumRanges);
+        for (Uint32 i = 0; i < Attribs.NumRanges; ++i)
+        {
+            const auto& Range = Attribs.pRanges[i];
+            // Null heap unbinds the memory from the tiles
+            const auto vkMemory     = Range.pHeap != nullptr ? ValidatedCast<ResourceHeapVkImpl>(Range.pHeap)->GetVkDeviceMemory() : VK_NULL_HANDLE;
+            const auto MemoryOffset = Range.pHeap != nullptr ? static_cast<VkDeviceSize>(Range.HeapOffset) : VkDeviceSize{0};
+
+            if (Range.MipLevel >= SparseProps.FirstMipInTail)
+            {
+                // Mip tail is not tiled and must be bound through opaque memory binding (32.4.3)
+                VkSparseMemoryBind MipTailBind{};
+                MipTailBind.resourceOffset = pTexVk->GetSparseMipTailOffset(Range.ArraySlice);
+                MipTailBind.size           = SparseProps.MipTailSize;
+                MipTailBind.memory         = vkMemory;
+                MipTailBind.memoryOffset   = MemoryOffset;
+                MipTailBinds.push_back(MipTailBind);
+            }
+            else
+            {
+                const auto MipProps = GetMipLevelProperties(TexDesc, Range.MipLevel);
+
+                VkSparseImageMemoryBind ImageBind{};
+                ImageBind.subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                ImageBind.subresource.mipLevel   = Range.MipLevel;
+                ImageBind.subresource.arrayLayer = Range.ArraySlice;
+
+                const auto OffsetX = Range.TileX * SparseProps.TileWidth;
+                const auto OffsetY = Range.TileY * SparseProps.TileHeight;
+                ImageBind.offset   = VkOffset3D{static_cast<int32_t>(OffsetX), static_cast<int32_t>(OffsetY), 0};
+                // The extent must either be a multiple of the sparse block size or reach the edge of the subresource
+                ImageBind.extent = VkExtent3D{
+                    std::min(Range.NumTilesX * SparseProps.TileWidth, MipProps.LogicalWidth - OffsetX),
+                    std::min(Range.NumTilesY * SparseProps.TileHeight, MipProps.LogicalHeight - OffsetY),
+                    1};
+                ImageBind.memory       = vkMemory;
+                ImageBind.memoryOffset = MemoryOffset;
+                ImageBinds.push_back(ImageBind);
+            }
+        }
+
+        ImageBindInfo.image     = pTexVk->GetVkImage();
+        ImageBindInfo.bindCount = static_cast<uint32_t>(ImageBinds.size());
+        ImageBindInfo.pBinds    = ImageBinds.data();
+
+        MipTailBindInfo.image     = pTexVk->GetVkImage();
+        MipTailBindInfo.bindCount = static_cast<uint32_t>(MipTailBinds.size());
+        MipTailBindInfo.pBinds    = MipTailBinds.data();
+    }
+
+    // Sparse binding operations are not ordered with command buffer submissions, so
+    // we chain them with semaphores: all commands recorded so far signal the semaphore
+    // the binding waits for, and the next submission waits for the binding to complete.
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    VkSemaphoreCreateInfo SemaphoreCI{};
+    SemaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    RefCntAutoPtr<ManagedSemaphore> pBindWaitSemaphore;
+    RefCntAutoPtr<ManagedSemaphore> pBindSignalSemaphore;
+    ManagedSemaphore::Create(m_pDevice, LogicalDevice.CreateSemaphore(SemaphoreCI, "Sparse bind wait semaphore"),
+                             "Sparse bind wait semaphore", &pBindWaitSemaphore);
+    ManagedSemaphore::Create(m_pDevice, LogicalDevice.CreateSemaphore(SemaphoreCI, "Sparse bind signal semaphore"),
+                             "Sparse bind signal semaphore", &pBindSignalSemaphore);
+
+    AddSignalSemaphore(pBindWaitSemaphore);
+    Flush();
+
+    const VkSemaphore vkWaitSemaphore   = pBindWaitSemaphore->Get();
+    const VkSemaphore vkSignalSemaphore = pBindSignalSemaphore->Get();
+
+    VkBindSparseInfo BindInfo{};
+    BindInfo.sType                = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+    BindInfo.waitSemaphoreCount   = 1;
+    BindInfo.pWaitSemaphores      = &vkWaitSemaphore;
+    BindInfo.bufferBindCount      = BufferBinds.empty() ? 0 : 1;
+    BindInfo.pBufferBinds         = &BufferBindInfo;
+    BindInfo.imageOpaqueBindCount = MipTailBinds.empty() ? 0 : 1;
+    BindInfo.pImageOpaqueBinds    = &MipTailBindInfo;
+    BindInfo.imageBindCount       = ImageBinds.empty() ? 0 : 1;
+    BindInfo.pImageBinds          = &ImageBindInfo;
+    BindInfo.signalSemaphoreCount = 1;
+    BindInfo.pSignalSemaphores    = &vkSignalSemaphore;
+
+    m_pDevice->LockCmdQueueAndRun(GetCommandQueueId(),
+                                  [&BindInfo](ICommandQueueVk* pCmdQueueVk) //
+                                  {
+                                      pCmdQueueVk->BindSparse(BindInfo);
+                                  });
+
+    AddWaitSemaphore(pBindSignalSemaphore, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+}
+
+void DeviceContextVkImpl::PrepareBLASBuild(const BuildBLASAttribs&                      Attribs,
+                                           VkDeviceAddress                              ScratchAddress,
+                                           VkAccelerationStructureBuildGeometryInfoKHR& vkASBuildInfo,
+                                           VkAccelerationStructureGeometryKHR*          vkGeometries,
+                                           VkAccelerationStructureBuildRangeInfoKHR*    vkRanges,
+                                           const char*                                  OpName)
+{
+    auto* pBLASVk  = ValidatedCast<BottomLevelASVkImpl>(Attribs.pBLAS);
+    auto& BLASDesc = pBLASVk->GetDesc();
+
+    TransitionOrVerifyBLASState(*pBLASVk, Attribs.BLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
+
+    Uint32 GeometryCount = 0;
     if (Attribs.pTriangleData != nullptr)
     {
-        vkGeometries.resize(Attribs.TriangleDataCount);
-        vkRanges.resize(Attribs.TriangleDataCount);
+        GeometryCount = Attribs.TriangleDataCount;
         pBLASVk->SetActualGeometryCount(Attribs.TriangleDataCount);
 
         for (Uint32 i = 0; i < Attribs.TriangleDataCount; ++i)
@@ -3172,8 +4409,7 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
     }
     else if (Attribs.pBoxData != nullptr)
     {
-        vkGeometries.resize(Attribs.BoxDataCount);
-        vkRanges.resize(Attribs.BoxDataCount);
+        GeometryCount = Attribs.BoxDataCount;
         pBLASVk->SetActualGeometryCount(Attribs.BoxDataCount);
 
         for (Uint32 i = 0; i < Attribs.BoxDataCount; ++i)
@@ -3215,33 +4451,128 @@ void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
         }
     }
 
-    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
-
     vkASBuildInfo.sType                     = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
     vkASBuildInfo.type                      = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;                 // type must be compatible with create info
     vkASBuildInfo.flags                     = BuildASFlagsToVkBuildAccelerationStructureFlags(BLASDesc.Flags); // flags must be compatible with create info
     vkASBuildInfo.mode                      = Attribs.Update ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
     vkASBuildInfo.srcAccelerationStructure  = Attribs.Update ? pBLASVk->GetVkBLAS() : VK_NULL_HANDLE;
     vkASBuildInfo.dstAccelerationStructure  = pBLASVk->GetVkBLAS();
-    vkASBuildInfo.geometryCount             = static_cast<uint32_t>(vkGeometries.size());
-    vkASBuildInfo.pGeometries               = vkGeometries.data();
+    vkASBuildInfo.geometryCount             = GeometryCount;
+    vkASBuildInfo.pGeometries               = vkGeometries;
     vkASBuildInfo.ppGeometries              = nullptr;
-    vkASBuildInfo.scratchData.deviceAddress = pScratchVk->GetVkDeviceAddress() + Attribs.ScratchBufferOffset;
+    vkASBuildInfo.scratchData.deviceAddress = ScratchAddress;
 
     const auto& ASLimits = m_pDevice->GetPhysicalDevice().GetExtProperties().AccelStruct;
     VERIFY(vkASBuildInfo.scratchData.deviceAddress % ASLimits.minAccelerationStructureScratchOffsetAlignment == 0, "Scratch buffer start address is not properly aligned");
 
+#ifdef DILIGENT_DEVELOPMENT
+    pBLASVk->DvpUpdateVersion();
+#endif
+}
+
+void DeviceContextVkImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+{
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pBLAS != nullptr)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildBLAS(RingAttribs);
+        return;
+    }
+
+    TDeviceContextBase::BuildBLAS(Attribs, 0);
+
+    auto* pScratchVk = ValidatedCast<BufferVkImpl>(Attribs.pScratchBuffer);
+
     EnsureVkCmdBuffer();
+
+    const char* OpName = "Build BottomLevelAS (DeviceContextVkImpl::BuildBLAS)";
+    TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
+
+    // Exactly one of the counts is non-zero
+    const Uint32 GeometryCount = Attribs.TriangleDataCount + Attribs.BoxDataCount;
+
+    VkAccelerationStructureBuildGeometryInfoKHR              vkASBuildInfo = {};
+    SmallVector<VkAccelerationStructureBuildRangeInfoKHR, 8> vkRanges(GeometryCount);
+    SmallVector<VkAccelerationStructureGeometryKHR, 8>       vkGeometries(GeometryCount);
+
+    PrepareBLASBuild(Attribs, pScratchVk->GetVkDeviceAddress() + Attribs.ScratchBufferOffset, vkASBuildInfo, vkGeometries.data(), vkRanges.data(), OpName);
+
+    VkAccelerationStructureBuildRangeInfoKHR const* VkRangePtr = vkRanges.data();
+
     m_CommandBuffer.BuildAccelerationStructure(1, &vkASBuildInfo, &VkRangePtr);
     ++m_State.NumCommands;
+}
 
-#ifdef DILIGENT_DEVELOPMENT
-    pBLASVk->DvpUpdateVersion();
-#endif
+void DeviceContextVkImpl::BuildBLASBatch(const BuildBLASBatchAttribs& Attribs)
+{
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pBuilds != nullptr && Attribs.BuildCount != 0)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildBLASBatch(RingAttribs);
+        return;
+    }
+
+    TDeviceContextBase::BuildBLASBatch(Attribs, 0);
+
+    if (Attribs.BuildCount == 0)
+        return;
+
+    auto* pScratchVk = ValidatedCast<BufferVkImpl>(Attribs.pScratchBuffer);
+
+    EnsureVkCmdBuffer();
+
+    const char* OpName = "Build BottomLevelAS batch (DeviceContextVkImpl::BuildBLASBatch)";
+    TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
+
+    Uint32 TotalGeometryCount = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+        TotalGeometryCount += Attribs.pBuilds[i].TriangleDataCount + Attribs.pBuilds[i].BoxDataCount;
+
+    // Geometries and ranges of all builds are stored in shared arrays that must not be reallocated
+    // after the pointers to them have been written to the build infos.
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR>     vkASBuildInfos(Attribs.BuildCount);
+    std::vector<VkAccelerationStructureBuildRangeInfoKHR const*> vkRangePtrs(Attribs.BuildCount);
+    std::vector<VkAccelerationStructureBuildRangeInfoKHR>        vkRanges(TotalGeometryCount);
+    std::vector<VkAccelerationStructureGeometryKHR>              vkGeometries(TotalGeometryCount);
+
+    const Uint32          ScratchAlignment = m_pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+    const VkDeviceAddress ScratchAddress   = pScratchVk->GetVkDeviceAddress();
+
+    Uint64 ScratchOffset      = Attribs.ScratchBufferOffset;
+    Uint32 FirstGeometryIndex = 0;
+    for (Uint32 i = 0; i < Attribs.BuildCount; ++i)
+    {
+        const auto& Build = Attribs.pBuilds[i];
+
+        PrepareBLASBuild(Build, ScratchAddress + ScratchOffset, vkASBuildInfos[i], &vkGeometries[FirstGeometryIndex], &vkRanges[FirstGeometryIndex], OpName);
+        vkRangePtrs[i] = &vkRanges[FirstGeometryIndex];
+
+        FirstGeometryIndex += Build.TriangleDataCount + Build.BoxDataCount;
+        ScratchOffset += GetBLASBatchScratchRegionSize(Build, ScratchAlignment);
+    }
+    VERIFY_EXPR(FirstGeometryIndex == TotalGeometryCount);
+
+    // All builds use disjoint scratch regions and destination structures, so they can be
+    // executed by a single command without barriers between them.
+    m_CommandBuffer.BuildAccelerationStructure(Attribs.BuildCount, vkASBuildInfos.data(), vkRangePtrs.data());
+    ++m_State.NumCommands;
 }
 
 void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
 {
+    if (Attribs.pScratchBuffer == nullptr && Attribs.pTLAS != nullptr)
+    {
+        // Suballocate the scratch space from the context's scratch ring
+        auto RingAttribs = Attribs;
+        if (AllocateASScratchSpace(RingAttribs))
+            BuildTLAS(RingAttribs);
+        return;
+    }
+
     TDeviceContextBase::BuildTLAS(Attribs, 0);
 
     static_assert(TLAS_INSTANCE_DATA_SIZE == sizeof(VkAccelerationStructureInstanceKHR), "Value in TLAS_INSTANCE_DATA_SIZE doesn't match the actual instance description size");
@@ -3257,7 +4588,12 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     TransitionOrVerifyTLASState(*pTLASVk, Attribs.TLASTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, OpName);
     TransitionOrVerifyBufferState(*pScratchVk, Attribs.ScratchBufferTransitionMode, RESOURCE_STATE_BUILD_AS_WRITE, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, OpName);
 
-    if (Attribs.Update)
+    if (Attribs.UseGPUInstanceData)
+    {
+        // Instance data has already been written to the instance buffer on the GPU
+        pTLASVk->SetGPUInstanceData(Attribs.InstanceCount, Attribs.HitGroupStride);
+    }
+    else if (Attribs.Update)
     {
         if (!pTLASVk->UpdateInstances(Attribs.pInstances, Attribs.InstanceCount, Attribs.BaseContributionToHitGroupIndex, Attribs.HitGroupStride, Attribs.BindingMode))
             return;
@@ -3269,6 +4605,7 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
     }
 
     // copy instance data into instance buffer
+    if (!Attribs.UseGPUInstanceData)
     {
         size_t Size     = Attribs.InstanceCount * sizeof(VkAccelerationStructureInstanceKHR);
         auto   TmpSpace = m_UploadHeap.Allocate(Size, 16);
@@ -3276,11 +4613,11 @@ void DeviceContextVkImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
         for (Uint32 i = 0; i < Attribs.InstanceCount; ++i)
         {
             const auto& Inst     = Attribs.pInstances[i];
-            const auto  InstDesc = pTLASVk->GetInstanceDesc(Inst.InstanceName);
+            const auto  InstDesc = pTLASVk->GetBuildInstanceDesc(Inst, i);
 
             if (InstDesc.InstanceIndex >= Attribs.InstanceCount)
             {
-                UNEXPECTED("Failed to find instance by name");
+                UNEXPECTED("Failed to find instance");
                 return;
             }
 
@@ -3503,22 +4840,15 @@ void DeviceContextVkImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndir
 
     const char* OpName = "Update shader binding table (DeviceContextVkImpl::UpdateSBT)";
 
-    if (RayGenShaderRecord.pData || MissShaderTable.pData || HitGroupTable.pData || CallableShaderTable.pData)
+    const auto& UploadRanges = pSBTVk->GetUploadRanges();
+    if (!UploadRanges.empty())
     {
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_COPY_DEST, VK_ACCESS_TRANSFER_WRITE_BIT, OpName);
 
+        // Only the records modified since the previous update are uploaded.
         // Buffer ranges do not intersect, so we don't need to add barriers between them
-        if (RayGenShaderRecord.pData)
-            UpdateBuffer(pSBTBufferVk, RayGenShaderRecord.Offset, RayGenShaderRecord.Size, RayGenShaderRecord.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (MissShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, MissShaderTable.Offset, MissShaderTable.Size, MissShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (HitGroupTable.pData)
-            UpdateBuffer(pSBTBufferVk, HitGroupTable.Offset, HitGroupTable.Size, HitGroupTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-
-        if (CallableShaderTable.pData)
-            UpdateBuffer(pSBTBufferVk, CallableShaderTable.Offset, CallableShaderTable.Size, CallableShaderTable.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (const auto& Range : UploadRanges)
+            UpdateBuffer(pSBTBufferVk, Range.Offset, Range.Size, Range.pData, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
         TransitionOrVerifyBufferState(*pSBTBufferVk, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_RAY_TRACING, VK_ACCESS_SHADER_READ_BIT, OpName);
     }
@@ -30,6 +30,9 @@
 
 #include "pch.h"
 #include <array>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "EngineFactoryVk.h"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
@@ -40,6 +43,7 @@
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "EngineFactoryBase.hpp"
 #include "VulkanTypeConversions.hpp"
+#include "Timer.hpp"
 
 #if PLATFORM_ANDROID
 #    include "FileSystem.hpp"
@@ -85,6 +89,8 @@ public:
     ///                                  the contexts will be written. Immediate context goes at
     ///                                  position 0. If EngineCI.NumDeferredContexts > 0,
     ///                                  pointers to the deferred contexts are written afterwards.
+    /// \param [in]  OnRenderDeviceCreated - Optional callback that is called right after the render
+    ///                                      device object has been created.
     void AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::VulkanInstance>       Instance,
                               std::unique_ptr<VulkanUtilities::VulkanPhysicalDevice> PhysicalDevice,
                               std::shared_ptr<VulkanUtilities::VulkanLogicalDevice>  LogicalDevice,
@@ -93,7 +99,8 @@ public:
                               const EngineVkCreateInfo&                              EngineCI,
                               const GraphicsAdapterInfo&                             AdapterInfo,
                               IRenderDevice**                                        ppDevice,
-                              IDeviceContext**                                       ppContexts);
+                              IDeviceContext**                                       ppContexts,
+                              const std::function<void(RenderDeviceVkImpl*)>&        OnRenderDeviceCreated = nullptr);
 
     virtual void DILIGENT_CALL_TYPE CreateSwapChainVk(IRenderDevice*       pDevice,
                                                       IDeviceContext*      pImmediateContext,
@@ -112,10 +119,26 @@ public:
 #endif
 
 private:
-    std::function<void(RenderDeviceVkImpl*)> OnRenderDeviceCreated = nullptr;
+    // Returns the instance shared by all devices of the factory, creating it if necessary,
+    // or null if the device can not use the instance.
+    std::shared_ptr<VulkanUtilities::VulkanInstance> AcquireSharedInstance(const EngineVkCreateInfo& EngineCI);
 
-    // To track that there is only one render device
-    RefCntWeakPtr<IRenderDevice> m_wpDevice;
+    struct SharedInstanceAttribs
+    {
+        uint32_t                 APIVersion       = 0;
+        bool                     EnableValidation = false;
+        bool                     MultipleDevices  = false;
+        std::vector<std::string> Extensions;
+        void*                    pVkAllocator = nullptr;
+    };
+
+    // Protects the shared instance and its attributes
+    mutable std::mutex m_SharedInstanceMtx;
+
+    // Devices keep the shared instance alive, so it is released together with the last device.
+    // Since Vulkan functions are global, there may only be one instance at a time.
+    std::weak_ptr<VulkanUtilities::VulkanInstance> m_wpSharedInstance;
+    SharedInstanceAttribs                          m_SharedInstanceAttribs;
 };
 
 
@@ -200,6 +223,7 @@ GraphicsAdapterInfo GetPhysicalDeviceGraphicsAdapterInfo(const VulkanUtilities::
         RayTracingProps.MaxInstancesPerTLAS      = static_cast<Uint32>(vkASLimits.maxInstanceCount);
         RayTracingProps.MaxPrimitivesPerBLAS     = static_cast<Uint32>(vkASLimits.maxPrimitiveCount);
         RayTracingProps.MaxGeometriesPerBLAS     = static_cast<Uint32>(vkASLimits.maxGeometryCount);
+        RayTracingProps.ScratchBufferAlignment   = vkASLimits.minAccelerationStructureScratchOffsetAlignment;
         if (vkExtFeatures.RayTracingPipeline.rayTracingPipeline)
             RayTracingProps.CapFlags |= RAY_TRACING_CAP_FLAG_STANDALONE_SHADERS;
         if (vkExtFeatures.RayQuery.rayQuery)
@@ -207,7 +231,7 @@ GraphicsAdapterInfo GetPhysicalDeviceGraphicsAdapterInfo(const VulkanUtilities::
         if (vkExtFeatures.RayTracingPipeline.rayTracingPipelineTraceRaysIndirect)
             RayTracingProps.CapFlags |= RAY_TRACING_CAP_FLAG_INDIRECT_RAY_TRACING;
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(RayTracingProps) == 36, "Did you add a new member to RayTracingProperites? Please initialize it here.");
+        static_assert(sizeof(RayTracingProps) == 40, "Did you add a new member to RayTracingProperites? Please initialize it here.");
 #endif
     }
 
@@ -256,6 +280,29 @@ GraphicsAdapterInfo GetPhysicalDeviceGraphicsAdapterInfo(const VulkanUtilities::
 #endif
     }
 
+    // Draw command properties
+    {
+        auto& DrawCommandProps{AdapterInfo.DrawCommand};
+        DrawCommandProps.CapFlags = DRAW_COMMAND_CAP_FLAG_NONE;
+        if (vkFeatures.multiDrawIndirect != VK_FALSE)
+            DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT;
+        if (vkExtFeatures.DrawIndirectCount)
+            DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNT;
+        DrawCommandProps.MaxDrawIndirectCount = vkDeviceLimits.maxDrawIndirectCount;
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(DrawCommandProps) == 8, "Did you add a new member to DrawCommandProperties? Please initialize it here.");
+#endif
+    }
+
+    // Command list properties
+    {
+        auto& CmdListProps{AdapterInfo.CommandList};
+        CmdListProps.CapFlags = COMMAND_LIST_CAP_FLAG_NATIVE_COMMAND_LISTS | COMMAND_LIST_CAP_FLAG_CONCURRENT_RESOURCE_CREATION;
+#if defined(_MSC_VER) && defined(_WIN64)
+        static_assert(sizeof(CmdListProps) == 1, "Did you add a new member to CommandListProperties? Please initialize it here.");
+#endif
+    }
+
     // Set memory properties
     {
         auto& Mem{AdapterInfo.Memory};
@@ -329,18 +376,20 @@ void EngineFactoryVkImpl::EnumerateAdapters(Version              MinVersion,
                                             Uint32&              NumAdapters,
                                             GraphicsAdapterInfo* Adapters) const
 {
-    if (m_wpDevice.IsValid())
+    // Hold the lock so that no other instance is created while the temporary instance exists
+    std::lock_guard<std::mutex> Lock{m_SharedInstanceMtx};
+
+    // Use the shared instance if there is one: we use global pointers to Vulkan functions
+    // and can not simultaneously create more than one instance.
+    auto Instance = m_wpSharedInstance.lock();
+    if (!Instance)
     {
-        LOG_ERROR_MESSAGE("We use global pointers to Vulkan functions and can not simultaneously create more than one instance and logical device.");
-        NumAdapters = 0;
-        return;
+        // Create instance with maximum available version.
+        // If Volk is not enabled then version will be 1.0
+        const uint32_t APIVersion = VK_MAKE_VERSION(0xFF, 0xFF, 0);
+        Instance                  = VulkanUtilities::VulkanInstance::Create(APIVersion, false, 0, nullptr, nullptr);
     }
 
-    // Create instance with maximum available version.
-    // If Volk is not enabled then version will be 1.0
-    const uint32_t APIVersion = VK_MAKE_VERSION(0xFF, 0xFF, 0);
-    auto           Instance   = VulkanUtilities::VulkanInstance::Create(APIVersion, false, 0, nullptr, nullptr);
-
     if (Adapters == nullptr)
     {
         NumAdapters = static_cast<Uint32>(Instance->GetVkPhysicalDevices().size());
@@ -350,9 +399,64 @@ void EngineFactoryVkImpl::EnumerateAdapters(Version              MinVersion,
     NumAdapters = std::min(NumAdapters, static_cast<Uint32>(Instance->GetVkPhysicalDevices().size()));
     for (Uint32 i = 0; i < NumAdapters; ++i)
     {
-        auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(Instance->GetVkPhysicalDevices()[i], *Instance);
-        Adapters[i]         = GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
+        const auto vkDevice       = Instance->GetVkPhysicalDevices()[i];
+        auto       PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice, *Instance);
+        Adapters[i]               = GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
+        Adapters[i].NumNodes      = static_cast<Uint32>(Instance->GetPhysicalDeviceGroup(vkDevice).size());
+    }
+}
+
+std::shared_ptr<VulkanUtilities::VulkanInstance> EngineFactoryVkImpl::AcquireSharedInstance(const EngineVkCreateInfo& EngineCI)
+{
+    const auto GraphicsAPIVersion = EngineCI.GraphicsAPIVersion == Version{0, 0} ?
+        Version{0xFF, 0xFF} : // Instance will use the maximum available version
+        EngineCI.GraphicsAPIVersion;
+
+    SharedInstanceAttribs Attribs;
+    Attribs.APIVersion       = VK_MAKE_VERSION(GraphicsAPIVersion.Major, GraphicsAPIVersion.Minor, 0);
+    Attribs.EnableValidation = EngineCI.EnableValidation;
+    Attribs.MultipleDevices  = EngineCI.EnableMultipleDevices;
+    Attribs.pVkAllocator     = EngineCI.pVkAllocator;
+    for (Uint32 i = 0; i < EngineCI.InstanceExtensionCount; ++i)
+        Attribs.Extensions.emplace_back(EngineCI.ppInstanceExtensionNames[i]);
+
+    // Other threads wait until the instance is created, which is only done once
+    std::lock_guard<std::mutex> Lock{m_SharedInstanceMtx};
+
+    if (auto Instance = m_wpSharedInstance.lock())
+    {
+        const auto& SharedAttribs = m_SharedInstanceAttribs;
+        if (!SharedAttribs.MultipleDevices || !Attribs.MultipleDevices)
+        {
+            LOG_ERROR_MESSAGE("We use global pointers to Vulkan functions and can not simultaneously create more than one "
+                              "logical device unless EngineVkCreateInfo::EnableMultipleDevices is set for all of them.");
+            return nullptr;
+        }
+
+        if (SharedAttribs.APIVersion != Attribs.APIVersion ||
+            SharedAttribs.EnableValidation != Attribs.EnableValidation ||
+            SharedAttribs.Extensions != Attribs.Extensions ||
+            SharedAttribs.pVkAllocator != Attribs.pVkAllocator)
+        {
+            LOG_ERROR_MESSAGE("All devices that exist at the same time share the Vulkan instance and must use the same GraphicsAPIVersion, "
+                              "EnableValidation, instance extensions and pVkAllocator.");
+            return nullptr;
+        }
+
+        return Instance;
     }
+
+    auto Instance = VulkanUtilities::VulkanInstance::Create(
+        Attribs.APIVersion,
+        EngineCI.EnableValidation,
+        EngineCI.InstanceExtensionCount,
+        EngineCI.ppInstanceExtensionNames,
+        reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator));
+
+    m_wpSharedInstance      = Instance;
+    m_SharedInstanceAttribs = std::move(Attribs);
+
+    return Instance;
 }
 
 void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& EngineCI,
@@ -375,35 +479,40 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
     *ppDevice = nullptr;
     memset(ppContexts, 0, sizeof(*ppContexts) * (std::max(1u, EngineCI.NumImmediateContexts) + EngineCI.NumDeferredContexts));
 
-    if (m_wpDevice.IsValid())
-    {
-        LOG_ERROR_MESSAGE("We use global pointers to Vulkan functions and can not simultaneously create more than one instance and logical device.");
-        return;
-    }
-
     SetRawAllocator(EngineCI.pRawMemAllocator);
 
     try
     {
-        const auto GraphicsAPIVersion = EngineCI.GraphicsAPIVersion == Version{0, 0} ?
-            Version{0xFF, 0xFF} : // Instance will use the maximum available version
-            EngineCI.GraphicsAPIVersion;
+        Timer InitTimer;
+        Timer PhaseTimer;
 
-        auto Instance = VulkanUtilities::VulkanInstance::Create(
-            VK_MAKE_VERSION(GraphicsAPIVersion.Major, GraphicsAPIVersion.Minor, 0),
-            EngineCI.EnableValidation,
-            EngineCI.InstanceExtensionCount,
-            EngineCI.ppInstanceExtensionNames,
-            reinterpret_cast<VkAllocationCallbacks*>(EngineCI.pVkAllocator));
+        DeviceInitStatistics InitStats;
+
+        auto Instance = AcquireSharedInstance(EngineCI);
+        if (!Instance)
+            return;
 
         auto vkDevice       = Instance->SelectPhysicalDevice(EngineCI.AdapterId);
         auto PhysicalDevice = VulkanUtilities::VulkanPhysicalDevice::Create(vkDevice, *Instance);
 
+        // The first device in the group is the selected physical device
+        std::vector<VkPhysicalDevice> DeviceGroup{vkDevice};
+        if (EngineCI.EnableDeviceGroup)
+        {
+            DeviceGroup = Instance->GetPhysicalDeviceGroup(vkDevice);
+            if (DeviceGroup.size() == 1)
+                LOG_INFO_MESSAGE("Device group is requested, but the selected physical device is not a part of a multi-device group");
+        }
+
         // Enable device features if they are supported and throw an error if not supported, but required by user.
-        const auto AdapterInfo = GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
+        auto AdapterInfo     = GetPhysicalDeviceGraphicsAdapterInfo(*PhysicalDevice);
+        AdapterInfo.NumNodes = static_cast<Uint32>(DeviceGroup.size());
         VerifyEngineCreateInfo(EngineCI, AdapterInfo);
         const auto EnabledFeatures = EnableDeviceFeatures(AdapterInfo.Features, EngineCI.Features);
 
+        InitStats.InstanceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         std::vector<VkDeviceQueueGlobalPriorityCreateInfoEXT> QueueGlobalPriority;
         std::vector<VkDeviceQueueCreateInfo>                  QueueInfos;
         std::vector<float>                                    QueuePriorities;
@@ -473,10 +582,11 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
             // If an implementation exposes any queue family that supports graphics operations,
             // at least one queue family of at least one physical device exposed by the implementation
             // must support both graphics and compute operations.
+            // Compute-only devices prefer a dedicated compute queue family.
 
             QueueCI.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
             QueueCI.flags            = 0; // reserved for future use
-            QueueCI.queueFamilyIndex = PhysicalDevice->FindQueueFamily(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+            QueueCI.queueFamilyIndex = PhysicalDevice->FindQueueFamily(EngineCI.ComputeOnly ? VK_QUEUE_COMPUTE_BIT : (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT));
             QueueCI.queueCount       = 1;
             QueueCI.pQueuePriorities = QueuePriorities.data();
         }
@@ -516,6 +626,9 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         ENABLE_VKFEATURE(vertexPipelineStoresAndAtomics,    EnabledFeatures.VertexPipelineUAVWritesAndAtomics);
         ENABLE_VKFEATURE(fragmentStoresAndAtomics,          EnabledFeatures.PixelUAVWritesAndAtomics);
         ENABLE_VKFEATURE(shaderStorageImageExtendedFormats, EnabledFeatures.TextureUAVExtendedFormats);
+        ENABLE_VKFEATURE(sparseBinding,                     EnabledFeatures.SparseResources);
+        ENABLE_VKFEATURE(sparseResidencyImage2D,            EnabledFeatures.SparseResources);
+        ENABLE_VKFEATURE(sparseResidencyBuffer,             EnabledFeatures.SparseResources);
         // clang-format on
 #undef ENABLE_VKFEATURE
 
@@ -678,6 +791,59 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 NextExt  = &EnabledExtFeats.DescriptorIndexing.pNext;
             }
 
+            bool UseDescriptorBuffer = false;
+            if (EngineCI.DescriptorBufferSize > 0)
+            {
+                const auto& DescrBufferProps = PhysicalDevice->GetExtProperties().DescriptorBuffer;
+                if (EngineCI.BindlessHeapSize > 0)
+                {
+                    LOG_WARNING_MESSAGE("Descriptor buffer is not used because the bindless heap is enabled.");
+                }
+                else if (DeviceExtFeatures.DescriptorBuffer.descriptorBuffer == VK_FALSE ||
+                         DeviceExtFeatures.BufferDeviceAddress.bufferDeviceAddress == VK_FALSE)
+                {
+                    LOG_WARNING_MESSAGE("Descriptor buffer is not used because VK_EXT_descriptor_buffer is not supported by the device.");
+                }
+                else if (DescrBufferProps.maxResourceDescriptorBufferBindings < 2 ||
+                         DescrBufferProps.maxSamplerDescriptorBufferBindings < 2)
+                {
+                    // Resource signatures use the global descriptor buffer and the dynamic heap
+                    LOG_WARNING_MESSAGE("Descriptor buffer is not used because the device supports less than two descriptor buffer bindings.");
+                }
+                else
+                {
+                    UseDescriptorBuffer = true;
+                }
+            }
+
+            // Buffer device address is required for ray tracing and descriptor buffers
+            if (EnabledFeatures.BufferDeviceAddress != DEVICE_FEATURE_STATE_DISABLED ||
+                EnabledFeatures.RayTracing != DEVICE_FEATURE_STATE_DISABLED ||
+                UseDescriptorBuffer)
+            {
+                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME), "VK_KHR_buffer_device_address extension must be supported");
+                DeviceExtensions.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+                EnabledExtFeats.BufferDeviceAddress = DeviceExtFeatures.BufferDeviceAddress;
+
+                *NextExt = &EnabledExtFeats.BufferDeviceAddress;
+                NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
+            }
+
+            if (UseDescriptorBuffer)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+
+                EnabledExtFeats.DescriptorBuffer = DeviceExtFeatures.DescriptorBuffer;
+                // Capture and replay and push descriptors are not used
+                EnabledExtFeats.DescriptorBuffer.descriptorBufferCaptureReplay      = VK_FALSE;
+                EnabledExtFeats.DescriptorBuffer.descriptorBufferPushDescriptors    = VK_FALSE;
+                EnabledExtFeats.DescriptorBuffer.descriptorBufferImageLayoutIgnored = VK_FALSE;
+
+                *NextExt = &EnabledExtFeats.DescriptorBuffer;
+                NextExt  = &EnabledExtFeats.DescriptorBuffer.pNext;
+            }
+
             // Ray tracing
             if (EnabledFeatures.RayTracing != DEVICE_FEATURE_STATE_DISABLED)
             {
@@ -695,15 +861,12 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 // SPIRV 1.5 is in Vulkan 1.2 core
                 EnabledExtFeats.Spirv15 = DeviceExtFeatures.Spirv15;
 
-                VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME), "VK_KHR_buffer_device_address extension must be supported");
                 VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME), "VK_KHR_deferred_host_operations extension must be supported");
                 VERIFY(PhysicalDevice->IsExtensionSupported(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME), "VK_KHR_acceleration_structure extension must be supported");
-                DeviceExtensions.push_back(VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);    // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME); // required for VK_KHR_acceleration_structure
                 DeviceExtensions.push_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);   // required for ray tracing
 
-                EnabledExtFeats.AccelStruct         = DeviceExtFeatures.AccelStruct;
-                EnabledExtFeats.BufferDeviceAddress = DeviceExtFeatures.BufferDeviceAddress;
+                EnabledExtFeats.AccelStruct = DeviceExtFeatures.AccelStruct;
 
                 // disable unused features
                 EnabledExtFeats.AccelStruct.accelerationStructureCaptureReplay                    = false;
@@ -713,8 +876,6 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
 
                 *NextExt = &EnabledExtFeats.AccelStruct;
                 NextExt  = &EnabledExtFeats.AccelStruct.pNext;
-                *NextExt = &EnabledExtFeats.BufferDeviceAddress;
-                NextExt  = &EnabledExtFeats.BufferDeviceAddress.pNext;
 
                 // Ray tracing shader.
                 if (PhysicalDevice->IsExtensionSupported(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME) &&
@@ -759,6 +920,163 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 EnabledExtFeats.SubgroupOps = true;
             }
 
+            if (DeviceExtFeatures.DrawIndirectCount)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+                EnabledExtFeats.DrawIndirectCount = true;
+            }
+
+            if (DeviceExtFeatures.DedicatedAllocation)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME); // required for VK_KHR_dedicated_allocation
+                DeviceExtensions.push_back(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
+                EnabledExtFeats.DedicatedAllocation = true;
+            }
+
+            if (DeviceExtFeatures.MemoryBudget)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+                EnabledExtFeats.MemoryBudget = true;
+            }
+
+            // Memory priorities are used as hints when device-local memory is oversubscribed,
+            // see BufferDesc::MemoryPriority and TextureDesc::MemoryPriority.
+            if (DeviceExtFeatures.MemoryPriority.memoryPriority != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+                EnabledExtFeats.MemoryPriority = DeviceExtFeatures.MemoryPriority;
+
+                *NextExt = &EnabledExtFeats.MemoryPriority;
+                NextExt  = &EnabledExtFeats.MemoryPriority.pNext;
+
+                // With pageable device local memory, the driver may transparently move allocations
+                // to system memory based on their priorities instead of failing the allocation.
+                if (DeviceExtFeatures.PageableDeviceLocalMemory.pageableDeviceLocalMemory != VK_FALSE)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+                    EnabledExtFeats.PageableDeviceLocalMemory = DeviceExtFeatures.PageableDeviceLocalMemory;
+
+                    *NextExt = &EnabledExtFeats.PageableDeviceLocalMemory;
+                    NextExt  = &EnabledExtFeats.PageableDeviceLocalMemory.pNext;
+                }
+            }
+
+            // See IDeviceContext::GetTimestampCalibration()
+            if (DeviceExtFeatures.CalibratedTimestamps)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+                EnabledExtFeats.CalibratedTimestamps = true;
+            }
+
+            // Shader compiler statistics, see PSO_CREATE_FLAG_CAPTURE_STATISTICS
+            if (DeviceExtFeatures.PipelineExecutableProperties.pipelineExecutableInfo != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME);
+                EnabledExtFeats.PipelineExecutableProperties = DeviceExtFeatures.PipelineExecutableProperties;
+
+                *NextExt = &EnabledExtFeats.PipelineExecutableProperties;
+                NextExt  = &EnabledExtFeats.PipelineExecutableProperties.pNext;
+            }
+
+            if (DeviceExtFeatures.DescriptorUpdateTemplate)
+            {
+                if (PhysicalDevice->GetVkVersion() < VK_API_VERSION_1_1)
+                {
+                    VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME));
+                    DeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+                }
+                EnabledExtFeats.DescriptorUpdateTemplate = true;
+            }
+
+            if (DeviceExtFeatures.PushDescriptor)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+                EnabledExtFeats.PushDescriptor = true;
+            }
+
+            if (DeviceExtFeatures.PresentId.presentId != VK_FALSE && DeviceExtFeatures.PresentWait.presentWait != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME); // required for VK_KHR_present_wait
+                DeviceExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+
+                EnabledExtFeats.PresentId   = DeviceExtFeatures.PresentId;
+                EnabledExtFeats.PresentWait = DeviceExtFeatures.PresentWait;
+
+                *NextExt = &EnabledExtFeats.PresentId;
+                NextExt  = &EnabledExtFeats.PresentId.pNext;
+
+                *NextExt = &EnabledExtFeats.PresentWait;
+                NextExt  = &EnabledExtFeats.PresentWait.pNext;
+            }
+
+            // Dynamic rendering is used for implicit render passes defined by SetRenderTargets() instead of
+            // render pass and framebuffer objects. Explicit render passes always use VkRenderPass.
+            if (DeviceExtFeatures.DynamicRendering.dynamicRendering != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME));
+                if (PhysicalDevice->GetVkVersion() < VK_API_VERSION_1_2)
+                {
+                    DeviceExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);    // required for VK_KHR_depth_stencil_resolve
+                    DeviceExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME); // required for VK_KHR_dynamic_rendering
+                }
+                DeviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.DynamicRendering = DeviceExtFeatures.DynamicRendering;
+
+                *NextExt = &EnabledExtFeats.DynamicRendering;
+                NextExt  = &EnabledExtFeats.DynamicRendering.pNext;
+            }
+
+            // Graphics pipeline libraries let graphics pipelines be linked from independently
+            // compiled and cached parts, see PipelineLibraryCacheVk.
+            if (DeviceExtFeatures.GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME));
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME); // required for VK_EXT_graphics_pipeline_library
+                DeviceExtensions.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+
+                EnabledExtFeats.GraphicsPipelineLibrary = DeviceExtFeatures.GraphicsPipelineLibrary;
+
+                *NextExt = &EnabledExtFeats.GraphicsPipelineLibrary;
+                NextExt  = &EnabledExtFeats.GraphicsPipelineLibrary.pNext;
+            }
+
+            if (EnabledFeatures.DynamicPipelineStates != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+
+                EnabledExtFeats.ExtendedDynamicState = DeviceExtFeatures.ExtendedDynamicState;
+
+                *NextExt = &EnabledExtFeats.ExtendedDynamicState;
+                NextExt  = &EnabledExtFeats.ExtendedDynamicState.pNext;
+            }
+
+            if (EnabledFeatures.ConditionalRendering != DEVICE_FEATURE_STATE_DISABLED)
+            {
+                VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME));
+                DeviceExtensions.push_back(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME);
+
+                EnabledExtFeats.ConditionalRendering = DeviceExtFeatures.ConditionalRendering;
+                // Conditional rendering inside secondary command buffers is not used
+                EnabledExtFeats.ConditionalRendering.inheritedConditionalRendering = VK_FALSE;
+
+                *NextExt = &EnabledExtFeats.ConditionalRendering;
+                NextExt  = &EnabledExtFeats.ConditionalRendering.pNext;
+            }
+
             if (EnabledFeatures.InstanceDataStepRate != DEVICE_FEATURE_STATE_DISABLED)
             {
                 VERIFY_EXPR(PhysicalDevice->IsExtensionSupported(VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME));
@@ -791,7 +1109,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         }
 
 #if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(Diligent::DeviceFeatures) == 37, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+        static_assert(sizeof(Diligent::DeviceFeatures) == 42, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 
         for (Uint32 i = 0; i < EngineCI.DeviceExtensionCount; ++i)
@@ -820,8 +1138,20 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         vkDeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensions.empty() ? nullptr : DeviceExtensions.data();
         vkDeviceCreateInfo.enabledExtensionCount   = static_cast<uint32_t>(DeviceExtensions.size());
 
+        // Create the logical device over all physical devices in the group (core in Vulkan 1.1).
+        // The device index of every physical device is its index in the DeviceGroup array.
+        VkDeviceGroupDeviceCreateInfo DeviceGroupCI{};
+        if (DeviceGroup.size() > 1)
+        {
+            DeviceGroupCI.sType               = VK_STRUCTURE_TYPE_DEVICE_GROUP_DEVICE_CREATE_INFO;
+            DeviceGroupCI.pNext               = vkDeviceCreateInfo.pNext;
+            DeviceGroupCI.physicalDeviceCount = static_cast<uint32_t>(DeviceGroup.size());
+            DeviceGroupCI.pPhysicalDevices    = DeviceGroup.data();
+            vkDeviceCreateInfo.pNext          = &DeviceGroupCI;
+        }
+
         auto vkAllocator   = Instance->GetVkAllocator();
-        auto LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(*PhysicalDevice, vkDeviceCreateInfo, EnabledExtFeats, vkAllocator);
+        auto LogicalDevice = VulkanUtilities::VulkanLogicalDevice::Create(*PhysicalDevice, vkDeviceCreateInfo, EnabledExtFeats, vkAllocator, !EngineCI.EnableMultipleDevices);
 
         auto& RawMemAllocator = GetRawAllocator();
 
@@ -840,7 +1170,7 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
                 VERIFY_EXPR(QueueIndex != DEFAULT_QUEUE_ID);
                 auto& QueueCI = QueueInfos[QueueIndex];
 
-                CommandQueuesVk[CtxInd] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{CtxInd}, EngineCI.NumImmediateContexts, QueueCI.queueCount, ContextInfo);
+                CommandQueuesVk[CtxInd] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{CtxInd}, EngineCI.NumImmediateContexts, QueueCI.queueCount, AdapterInfo.NumNodes, ContextInfo);
                 CommandQueues[CtxInd]   = CommandQueuesVk[CtxInd];
                 QueueCI.queueCount += 1;
             }
@@ -849,14 +1179,16 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
         {
             VERIFY_EXPR(CommandQueuesVk.size() == 1);
             ImmediateContextCreateInfo DefaultContextInfo{};
-            DefaultContextInfo.Name    = "Graphics context";
+            DefaultContextInfo.Name    = EngineCI.ComputeOnly ? "Compute context" : "Graphics context";
             DefaultContextInfo.QueueId = static_cast<Uint8>(QueueInfos[0].queueFamilyIndex);
 
-            CommandQueuesVk[0] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{0}, 1, 1, DefaultContextInfo);
+            CommandQueuesVk[0] = NEW_RC_OBJ(RawMemAllocator, "CommandQueueVk instance", CommandQueueVkImpl)(LogicalDevice, SoftwareQueueIndex{0}, 1, 1, AdapterInfo.NumNodes, DefaultContextInfo);
             CommandQueues[0]   = CommandQueuesVk[0];
         }
 
-        OnRenderDeviceCreated = [&](RenderDeviceVkImpl* pRenderDeviceVk) //
+        InitStats.DeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+
+        auto OnRenderDeviceCreated = [&](RenderDeviceVkImpl* pRenderDeviceVk) //
         {
             FenceDesc Desc;
             Desc.Name = "Command queue internal fence";
@@ -870,9 +1202,19 @@ void EngineFactoryVkImpl::CreateDeviceAndContextsVk(const EngineVkCreateInfo& En
             }
         };
 
-        AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, static_cast<Uint32>(CommandQueues.size()), CommandQueues.data(), EngineCI, AdapterInfo, ppDevice, ppContexts);
+        AttachToVulkanDevice(Instance, std::move(PhysicalDevice), LogicalDevice, static_cast<Uint32>(CommandQueues.size()), CommandQueues.data(), EngineCI, AdapterInfo, ppDevice, ppContexts, OnRenderDeviceCreated);
 
-        m_wpDevice = *ppDevice;
+        if (*ppDevice != nullptr)
+        {
+            // AttachToVulkanDevice() only knows the time of the render device and context initialization
+            auto* pRenderDeviceVk = ValidatedCast<RenderDeviceVkImpl>(*ppDevice);
+
+            const auto& AttachStats    = pRenderDeviceVk->GetDeviceInfo().InitStats;
+            InitStats.RenderDeviceTime = AttachStats.RenderDeviceTime;
+            InitStats.ContextsTime     = AttachStats.ContextsTime;
+            InitStats.TotalTime        = InitTimer.GetElapsedTimef() * 1000.f;
+            pRenderDeviceVk->SetInitStatistics(InitStats);
+        }
     }
     catch (std::runtime_error&)
     {
@@ -888,7 +1230,8 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
                                                const EngineVkCreateInfo&                              EngineCI,
                                                const GraphicsAdapterInfo&                             AdapterInfo,
                                                IRenderDevice**                                        ppDevice,
-                                               IDeviceContext**                                       ppContexts)
+                                               IDeviceContext**                                       ppContexts,
+                                               const std::function<void(RenderDeviceVkImpl*)>&        OnRenderDeviceCreated)
 {
     if (EngineCI.DebugMessageCallback != nullptr)
         SetDebugMessageCallback(EngineCI.DebugMessageCallback);
@@ -917,6 +1260,9 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
     {
         auto& RawMemAllocator = GetRawAllocator();
 
+        Timer                PhaseTimer;
+        DeviceInitStatistics InitStats;
+
         RenderDeviceVkImpl* pRenderDeviceVk{
             NEW_RC_OBJ(RawMemAllocator, "RenderDeviceVkImpl instance", RenderDeviceVkImpl)(
                 RawMemAllocator, this, EngineCI, AdapterInfo, CommandQueueCount, ppCommandQueues, Instance, std::move(PhysicalDevice), LogicalDevice) //
@@ -926,6 +1272,9 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
         if (OnRenderDeviceCreated != nullptr)
             OnRenderDeviceCreated(pRenderDeviceVk);
 
+        InitStats.RenderDeviceTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        PhaseTimer.Restart();
+
         std::shared_ptr<GenerateMipsVkHelper> GenerateMipsHelper(new GenerateMipsVkHelper(*pRenderDeviceVk));
 
         for (Uint32 CtxInd = 0; CtxInd < NumImmediateContexts; ++CtxInd)
@@ -971,6 +1320,10 @@ void EngineFactoryVkImpl::AttachToVulkanDevice(std::shared_ptr<VulkanUtilities::
             pDeferredCtxVk->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts + NumImmediateContexts + DeferredCtx));
             pRenderDeviceVk->SetDeferredContext(DeferredCtx, pDeferredCtxVk);
         }
+
+        InitStats.ContextsTime = PhaseTimer.GetElapsedTimef() * 1000.f;
+        InitStats.TotalTime    = InitStats.RenderDeviceTime + InitStats.ContextsTime;
+        pRenderDeviceVk->SetInitStatistics(InitStats);
     }
     catch (const std::runtime_error&)
     {
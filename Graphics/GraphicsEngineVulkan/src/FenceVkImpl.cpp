@@ -132,7 +132,7 @@ Uint64 FenceVkImpl::InternalGetCompletedValue()
     {
         auto& Item = m_SyncPoints.front();
 
-        auto status = LogicalDevice.GetFenceStatus(Item.SyncPoint->GetFence());
+        auto status = Item.SyncPoint->GetStatus(LogicalDevice);
         if (status == VK_SUCCESS)
         {
             UpdateLastCompletedFenceValue(Item.Value);
@@ -216,11 +216,10 @@ void FenceVkImpl::Wait(Uint64 Value)
             if (Item.Value > Value)
                 break;
 
-            VkFence Fence  = Item.SyncPoint->GetFence();
-            auto    status = LogicalDevice.GetFenceStatus(Fence);
+            auto status = Item.SyncPoint->GetStatus(LogicalDevice);
             if (status == VK_NOT_READY)
             {
-                status = LogicalDevice.WaitForFences(1, &Fence, VK_TRUE, UINT64_MAX);
+                status = Item.SyncPoint->Wait(LogicalDevice, UINT64_MAX);
             }
 
             DEV_CHECK_ERR(status == VK_SUCCESS, "All pending fences must now be complete!");
@@ -30,6 +30,9 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "HashUtils.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace Diligent
 {
 
@@ -65,16 +68,50 @@ size_t FramebufferCache::FramebufferCacheKey::GetHash() const
     return Hash;
 }
 
+void FramebufferCache::MarkUsed(FramebufferEntry& Entry) const
+{
+    const auto CurrFrame = m_CurrentFrame.load(std::memory_order_relaxed);
+    // Avoid writing to the shared cache line if the framebuffer has already been used in this frame
+    if (Entry.LastUsedFrame.load(std::memory_order_relaxed) != CurrFrame)
+        Entry.LastUsedFrame.store(CurrFrame);
+}
+
 VkFramebuffer FramebufferCache::GetFramebuffer(const FramebufferCacheKey& Key, uint32_t width, uint32_t height, uint32_t layers)
 {
+    static std::atomic<Uint32> NextHitCounterIdx{0};
+    thread_local const Uint32  HitCounterIdx = NextHitCounterIdx.fetch_add(1, std::memory_order_relaxed) % NumHitCounters;
+
+    // A framebuffer found here may be concurrently removed by OnDestroyImageView() or OnDestroyRenderPass().
+    // This is no different from removing it right after the lookup, and the framebuffer itself is
+    // released through the release queue.
+    VkFramebuffer CachedFB = VK_NULL_HANDLE;
+    if (m_Lookup.Find(Key, [&](const FramebufferEntryPtr& pEntry) {
+            MarkUsed(*pEntry);
+            // The framebuffer is being evicted. Take the locked path that will either find it
+            // in m_Cache if the eviction is cancelled, or create a new one.
+            if (pEntry->Evicted.load())
+                return false;
+            CachedFB = pEntry->vkFramebuffer;
+            return true;
+        }))
+    {
+        m_HitCounters[HitCounterIdx].NumHits.fetch_add(1, std::memory_order_relaxed);
+        return CachedFB;
+    }
+
     std::lock_guard<std::mutex> Lock{m_Mutex};
     auto                        it = m_Cache.find(Key);
     if (it != m_Cache.end())
     {
-        return it->second;
+        MarkUsed(*it->second);
+        m_HitCounters[HitCounterIdx].NumHits.fetch_add(1, std::memory_order_relaxed);
+        return it->second->vkFramebuffer;
     }
     else
     {
+        if (m_MaxSize != 0 && m_Cache.size() >= m_MaxSize)
+            EvictLeastRecentlyUsed(m_Cache.size() - m_MaxSize + 1);
+
         VkFramebufferCreateInfo FramebufferCI = {};
 
         FramebufferCI.sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -96,9 +133,12 @@ VkFramebuffer FramebufferCache::GetFramebuffer(const FramebufferCacheKey& Key, u
         auto          Framebuffer  = m_DeviceVk.GetLogicalDevice().CreateFramebuffer(FramebufferCI);
         VkFramebuffer fb           = Framebuffer;
 
-        auto new_it = m_Cache.insert(std::make_pair(Key, std::move(Framebuffer)));
+        auto pEntry = std::make_shared<FramebufferEntry>(std::move(Framebuffer), m_CurrentFrame.load(std::memory_order_relaxed));
+        auto new_it = m_Cache.emplace(Key, pEntry);
         VERIFY(new_it.second, "New framebuffer must be inserted into the map");
         (void)new_it;
+        m_Lookup.Insert(Key, std::move(pEntry));
+        ++m_NumMisses;
 
         m_RenderPassToKeyMap.emplace(Key.Pass, Key);
         if (Key.DSV != VK_NULL_HANDLE)
@@ -134,7 +174,8 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
         // The framebuffer is deleted whenever any of the image views is deleted
         if (fb_it != m_Cache.end())
         {
-            m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second), it->second.CommandQueueMask);
+            m_Lookup.Erase(fb_it->first);
+            m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second->Framebuffer), it->second.CommandQueueMask);
             m_Cache.erase(fb_it);
         }
     }
@@ -156,11 +197,117 @@ void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
         // The framebuffer is deleted whenever any of the image views or render pass is destroyed
         if (fb_it != m_Cache.end())
         {
-            m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second), it->second.CommandQueueMask);
+            m_Lookup.Erase(fb_it->first);
+            m_DeviceVk.SafeReleaseDeviceObject(std::move(fb_it->second->Framebuffer), it->second.CommandQueueMask);
             m_Cache.erase(fb_it);
         }
     }
     m_RenderPassToKeyMap.erase(equal_range.first, equal_range.second);
 }
 
+void FramebufferCache::RemoveKeyReferences(const FramebufferCacheKey& Key)
+{
+    auto RemoveKey = [&Key](auto& Map, const auto& Handle) {
+        auto equal_range = Map.equal_range(Handle);
+        for (auto it = equal_range.first; it != equal_range.second;)
+        {
+            if (it->second == Key)
+                it = Map.erase(it);
+            else
+                ++it;
+        }
+    };
+
+    RemoveKey(m_RenderPassToKeyMap, Key.Pass);
+    if (Key.DSV != VK_NULL_HANDLE)
+        RemoveKey(m_ViewToKeyMap, Key.DSV);
+    for (Uint32 rt = 0; rt < Key.NumRenderTargets; ++rt)
+    {
+        if (Key.RTVs[rt] != VK_NULL_HANDLE)
+            RemoveKey(m_ViewToKeyMap, Key.RTVs[rt]);
+    }
+}
+
+bool FramebufferCache::TryEvict(const FramebufferCacheKey& Key, FramebufferEntry& Entry, Uint64 MinAge)
+{
+    // A lock-free reader may have read the previous frame index, so a framebuffer
+    // that was used in the current or the previous frame is never evicted.
+    VERIFY_EXPR(MinAge >= 1);
+    const auto CurrFrame = m_CurrentFrame.load(std::memory_order_relaxed);
+    if (Entry.LastUsedFrame.load(std::memory_order_relaxed) + MinAge >= CurrFrame)
+        return false;
+
+    // Lock-free readers update LastUsedFrame before checking Evicted, while we set Evicted before
+    // checking LastUsedFrame. Either the reader sees the flag and takes the locked path, or we see
+    // that the framebuffer has just been used and cancel the eviction.
+    Entry.Evicted.store(true);
+    if (Entry.LastUsedFrame.load() + MinAge >= CurrFrame)
+    {
+        Entry.Evicted.store(false);
+        return false;
+    }
+
+    m_Lookup.Erase(Key);
+    RemoveKeyReferences(Key);
+    m_DeviceVk.SafeReleaseDeviceObject(std::move(Entry.Framebuffer), Key.CommandQueueMask);
+    ++m_NumEvictions;
+
+    return true;
+}
+
+void FramebufferCache::EvictLeastRecentlyUsed(size_t NumToEvict)
+{
+    std::vector<std::pair<Uint64, const FramebufferCacheKey*>> Candidates;
+    Candidates.reserve(m_Cache.size());
+    for (const auto& it : m_Cache)
+        Candidates.emplace_back(it.second->LastUsedFrame.load(std::memory_order_relaxed), &it.first);
+
+    std::sort(Candidates.begin(), Candidates.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    for (const auto& Candidate : Candidates)
+    {
+        if (NumToEvict == 0)
+            break;
+
+        auto it = m_Cache.find(*Candidate.second);
+        VERIFY_EXPR(it != m_Cache.end());
+        // Other candidates were used more recently, so stop at the first one that can't be evicted.
+        // The cache is allowed to grow beyond the limit if all framebuffers are in use.
+        if (!TryEvict(it->first, *it->second, 1))
+            break;
+
+        m_Cache.erase(it);
+        --NumToEvict;
+    }
+}
+
+void FramebufferCache::OnFinishFrame()
+{
+    m_CurrentFrame.fetch_add(1);
+    if (m_MaxAge == 0)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    for (auto it = m_Cache.begin(); it != m_Cache.end();)
+    {
+        if (TryEvict(it->first, *it->second, m_MaxAge))
+            it = m_Cache.erase(it);
+        else
+            ++it;
+    }
+}
+
+void FramebufferCache::GetStatistics(FramebufferCacheStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    Stats.NumFramebuffers = static_cast<Uint32>(m_Cache.size());
+    Stats.NumMisses       = m_NumMisses;
+    Stats.NumEvictions    = m_NumEvictions;
+    Stats.NumHits         = 0;
+    for (const auto& Counter : m_HitCounters)
+        Stats.NumHits += Counter.NumHits.load(std::memory_order_relaxed);
+}
+
 } // namespace Diligent
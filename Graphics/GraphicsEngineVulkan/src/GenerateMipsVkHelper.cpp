@@ -30,13 +30,16 @@
 #include "GenerateMipsVkHelper.hpp"
 
 #include <sstream>
+#include <vector>
 
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "TextureViewVkImpl.hpp"
 #include "TextureVkImpl.hpp"
+#include "BufferVkImpl.hpp"
 
 #include "PlatformMisc.hpp"
+#include "Align.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "../../GraphicsTools/interface/ShaderMacroHelper.hpp"
 #include "../../GraphicsTools/interface/CommonlyUsedStates.h"
@@ -48,6 +51,10 @@ static const char* g_GenerateMipsCSSource =
 {
     #include "../shaders/GenerateMipsCS_inc.h"
 };
+static const char* g_GenerateMipsSPDCSSource =
+{
+    #include "../shaders/GenerateMipsSPDCS_inc.h"
+};
 // clang-format on
 #endif
 
@@ -183,6 +190,72 @@ std::array<RefCntAutoPtr<IPipelineState>, 4> GenerateMipsVkHelper::CreatePSOs(TE
     return PSOs;
 }
 
+RefCntAutoPtr<IPipelineState> GenerateMipsVkHelper::CreateSPDPSO(TEXTURE_FORMAT Fmt)
+{
+    RefCntAutoPtr<IPipelineState> pPSO;
+
+#if !DILIGENT_NO_GLSLANG
+    const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
+    // Single-pass downsampler reads back mip 6 through the image, which is only
+    // supported for formats that are filtered as floating-point values
+    if (FmtAttribs.ComponentType != COMPONENT_TYPE_UNORM &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_UNORM_SRGB &&
+        FmtAttribs.ComponentType != COMPONENT_TYPE_FLOAT)
+        return pPSO;
+
+    std::array<char, 16> GlFmt;
+    GetGlImageFormat(FmtAttribs, GlFmt);
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("CONVERT_TO_SRGB", FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB);
+    Macros.AddShaderMacro("IMG_FORMAT", GlFmt.data());
+    Macros.Finalize();
+
+    const auto Name = std::string{"Generate mips SPD "} + GlFmt.data();
+
+    ShaderCreateInfo CSCreateInfo;
+    CSCreateInfo.Source          = g_GenerateMipsSPDCSSource;
+    CSCreateInfo.EntryPoint      = "main";
+    CSCreateInfo.SourceLanguage  = SHADER_SOURCE_LANGUAGE_GLSL;
+    CSCreateInfo.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    CSCreateInfo.Desc.Name       = Name.c_str();
+    CSCreateInfo.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_DeviceVkImpl.CreateShader(CSCreateInfo, &pCS);
+    if (!pCS)
+        return pPSO;
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PipelineStateDesc&             PSODesc = PSOCreateInfo.PSODesc;
+
+    PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSODesc.Name         = Name.c_str();
+    PSOCreateInfo.pCS    = pCS;
+
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+    // clang-format off
+    const ShaderResourceVariableDesc Vars[] =
+    {
+        {SHADER_TYPE_COMPUTE, "CB",               SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_COMPUTE, "SPDCounterBuffer", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+    };
+    // clang-format on
+    PSODesc.ResourceLayout.Variables    = Vars;
+    PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+    const ImmutableSamplerDesc ImtblSampler{SHADER_TYPE_COMPUTE, "SrcMip", Sam_LinearClamp};
+    PSODesc.ResourceLayout.ImmutableSamplers    = &ImtblSampler;
+    PSODesc.ResourceLayout.NumImmutableSamplers = 1;
+
+    m_DeviceVkImpl.CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (pPSO)
+        pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "CB")->Set(m_ConstantsCB);
+#endif
+
+    return pPSO;
+}
+
 GenerateMipsVkHelper::GenerateMipsVkHelper(RenderDeviceVkImpl& DeviceVkImpl)
 #if !DILIGENT_NO_GLSLANG
     // clang-format off
@@ -198,21 +271,66 @@ GenerateMipsVkHelper::GenerateMipsVkHelper(RenderDeviceVkImpl& DeviceVkImpl)
     ConstantsCBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
     ConstantsCBDesc.uiSizeInBytes  = 32;
     DeviceVkImpl.CreateBuffer(ConstantsCBDesc, nullptr, &m_ConstantsCB);
-
-    FindPSOs(TEX_FORMAT_RGBA8_UNORM);
-    FindPSOs(TEX_FORMAT_BGRA8_UNORM);
+    // PSOs are created when mips are generated for the first time for every format
 #endif
 }
 
-void GenerateMipsVkHelper::CreateSRB(IShaderResourceBinding** ppSRB)
+void GenerateMipsVkHelper::CreateContextResources(ContextResources& Resources)
 {
 #if !DILIGENT_NO_GLSLANG
     // All PSOs are compatible
     auto& PSO = FindPSOs(TEX_FORMAT_RGBA8_UNORM);
-    PSO[0]->CreateShaderResourceBinding(ppSRB, true);
+    PSO[0]->CreateShaderResourceBinding(&Resources.pSRB, true);
+
+    auto* pSPDPSO = FindSPDPSO(TEX_FORMAT_RGBA8_UNORM);
+    if (pSPDPSO == nullptr)
+        return;
+
+    BufferDesc CounterDesc;
+    CounterDesc.Name              = "Generate mips SPD counter buffer";
+    CounterDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    CounterDesc.Usage             = USAGE_DEFAULT;
+    CounterDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    CounterDesc.ElementByteStride = sizeof(Uint32);
+    CounterDesc.uiSizeInBytes     = MaxSPDArraySlices * sizeof(Uint32);
+
+    // The counters must be zero before the first dispatch
+    std::vector<Uint32> ZeroCounters(MaxSPDArraySlices);
+    BufferData          InitData{ZeroCounters.data(), CounterDesc.uiSizeInBytes};
+    m_DeviceVkImpl.CreateBuffer(CounterDesc, &InitData, &Resources.pSPDCounter);
+    if (!Resources.pSPDCounter)
+        return;
+
+    {
+        std::lock_guard<std::mutex> Lock{m_PSOMutex};
+        m_SPDCounterBuffersSize += CounterDesc.uiSizeInBytes;
+    }
+
+    pSPDPSO->CreateShaderResourceBinding(&Resources.pSPDSRB, true);
+    Resources.pSPDSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "SPDCounterBuffer")->Set(Resources.pSPDCounter->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
 #endif
 }
 
+void GenerateMipsVkHelper::GetStatistics(DeviceHelperStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_PSOMutex};
+
+    for (const auto& it : m_PSOHash)
+    {
+        for (const auto& pPSO : it.second)
+        {
+            if (pPSO)
+                ++Stats.NumMipGenerationPSOs;
+        }
+    }
+    for (const auto& it : m_SPDPSOHash)
+    {
+        if (it.second)
+            ++Stats.NumMipGenerationPSOs;
+    }
+    Stats.MipGenerationBufferSize += m_SPDCounterBuffersSize;
+}
+
 std::array<RefCntAutoPtr<IPipelineState>, 4>& GenerateMipsVkHelper::FindPSOs(TEXTURE_FORMAT Fmt)
 {
     std::lock_guard<std::mutex> Lock{m_PSOMutex};
@@ -223,32 +341,46 @@ std::array<RefCntAutoPtr<IPipelineState>, 4>& GenerateMipsVkHelper::FindPSOs(TEX
     return it->second;
 }
 
-void GenerateMipsVkHelper::WarmUpCache(TEXTURE_FORMAT Fmt)
+IPipelineState* GenerateMipsVkHelper::FindSPDPSO(TEXTURE_FORMAT Fmt)
 {
-    FindPSOs(Fmt);
+    std::lock_guard<std::mutex> Lock{m_PSOMutex};
+
+    auto it = m_SPDPSOHash.find(Fmt);
+    if (it == m_SPDPSOHash.end())
+        it = m_SPDPSOHash.emplace(Fmt, CreateSPDPSO(Fmt)).first;
+    return it->second;
 }
 
-void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding* pSRB)
+IPipelineState* GenerateMipsVkHelper::FindSPDPSO(const TextureViewVkImpl& TexView, const ContextResources& Resources)
 {
-    auto* pTexVk = TexView.GetTexture<TextureVkImpl>();
-    if (!pTexVk->IsInKnownState())
-    {
-        LOG_ERROR_MESSAGE("Unable to generate mips for texture '", pTexVk->GetDesc().Name, "' because the texture state is unknown");
-        return;
-    }
+#if !DILIGENT_NO_GLSLANG
+    if (Resources.pSPDSRB == nullptr || !TexView.HasMipLevelViews())
+        return nullptr;
 
-    const auto  OriginalState  = pTexVk->GetState();
-    const auto  OriginalLayout = pTexVk->GetLayout();
-    const auto& TexDesc        = pTexVk->GetDesc();
-    const auto& ViewDesc       = TexView.GetDesc();
+    const auto& TexDesc  = TexView.GetTexture<TextureVkImpl>()->GetDesc();
+    const auto& ViewDesc = TexView.GetDesc();
 
-    DEV_CHECK_ERR(ViewDesc.NumMipLevels > 1, "Number of mip levels in the view must be greater than 1");
-    DEV_CHECK_ERR(OriginalState != RESOURCE_STATE_UNDEFINED,
-                  "Attempting to generate mipmaps for texture '", TexDesc.Name,
-                  "' which is in RESOURCE_STATE_UNDEFINED state ."
-                  "This is not expected in Vulkan backend as textures are transition to a defined state when created.");
-    (void)OriginalState;
+    // Single-pass mip generation requires every downsampling step to be exactly 2:1.
+    // Mips 7 and below are generated by a single thread group, so mip 6 must not
+    // exceed 64x64.
+    const auto SrcWidth  = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+    const auto SrcHeight = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+    const auto NumMips   = ViewDesc.NumMipLevels - 1;
+    if (!IsPowerOfTwo(SrcWidth) || !IsPowerOfTwo(SrcHeight) ||
+        NumMips > MaxSPDMips ||
+        (NumMips > 6 && std::max(SrcWidth, SrcHeight) > 4096) ||
+        ViewDesc.NumArraySlices > MaxSPDArraySlices)
+        return nullptr;
+
+    return FindSPDPSO(ViewDesc.Format);
+#else
+    return nullptr;
+#endif
+}
 
+VkImageSubresourceRange GenerateMipsVkHelper::GetSubresourceRange(const TextureViewVkImpl& TexView)
+{
+    const auto& ViewDesc   = TexView.GetDesc();
     const auto& FmtAttribs = GetTextureFormatAttribs(ViewDesc.Format);
 
     VkImageSubresourceRange SubresRange = {};
@@ -267,13 +399,96 @@ void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContex
     SubresRange.layerCount     = ViewDesc.NumArraySlices;
     SubresRange.baseMipLevel   = ViewDesc.MostDetailedMip;
     SubresRange.levelCount     = 1;
+    return SubresRange;
+}
+
+void GenerateMipsVkHelper::RestoreLayout(TextureViewVkImpl&       TexView,
+                                         DeviceContextVkImpl&     Ctx,
+                                         VkImageLayout            AffectedMipLevelLayout,
+                                         VkImageLayout            OriginalLayout,
+                                         VkImageSubresourceRange& SubresRange)
+{
+    if (AffectedMipLevelLayout == OriginalLayout)
+        return;
+
+    auto*       pTexVk   = TexView.GetTexture<TextureVkImpl>();
+    const auto& TexDesc  = pTexVk->GetDesc();
+    const auto& ViewDesc = TexView.GetDesc();
+
+    bool IsAllSlices = (TexDesc.Type != RESOURCE_DIM_TEX_1D_ARRAY &&
+                        TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
+                        TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY) ||
+        TexDesc.ArraySize == ViewDesc.NumArraySlices;
+    bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
+    if (IsAllSlices && IsAllMips)
+    {
+        pTexVk->SetLayout(AffectedMipLevelLayout);
+    }
+    else
+    {
+        VERIFY(OriginalLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Original layout must not be undefined");
+        SubresRange.baseMipLevel = ViewDesc.MostDetailedMip;
+        SubresRange.levelCount   = ViewDesc.NumMipLevels;
+        // Transition all affected subresources back to original layout
+        Ctx.TransitionImageLayout(*pTexVk, AffectedMipLevelLayout, OriginalLayout, SubresRange);
+        VERIFY_EXPR(pTexVk->GetLayout() == OriginalLayout);
+    }
+}
+
+void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, ContextResources& Resources)
+{
+    ITextureView* pTexView = &TexView;
+    GenerateMips(&pTexView, 1, Ctx, Resources);
+}
+
+void GenerateMipsVkHelper::GenerateMips(ITextureView* ppTexViews[], Uint32 NumViews, DeviceContextVkImpl& Ctx, ContextResources& Resources)
+{
+    // Context resources require compiling the PSOs, so they are only created
+    // when the context generates mips for the first time.
+    if (!Resources.pSRB)
+        CreateContextResources(Resources);
+
+    auto& SPDBatch = Resources.SPDBatch;
+    SPDBatch.clear();
+
+    for (Uint32 i = 0; i < NumViews; ++i)
+    {
+        auto& TexView = *ValidatedCast<TextureViewVkImpl>(ppTexViews[i]);
+        auto* pTexVk  = TexView.GetTexture<TextureVkImpl>();
+        if (!pTexVk->IsInKnownState())
+        {
+            LOG_ERROR_MESSAGE("Unable to generate mips for texture '", pTexVk->GetDesc().Name, "' because the texture state is unknown");
+            continue;
+        }
+
+        DEV_CHECK_ERR(TexView.GetDesc().NumMipLevels > 1, "Number of mip levels in the view must be greater than 1");
+        DEV_CHECK_ERR(pTexVk->GetState() != RESOURCE_STATE_UNDEFINED,
+                      "Attempting to generate mipmaps for texture '", pTexVk->GetDesc().Name,
+                      "' which is in RESOURCE_STATE_UNDEFINED state ."
+                      "This is not expected in Vulkan backend as textures are transition to a defined state when created.");
+
+        if (auto* pSPDPSO = FindSPDPSO(TexView, Resources))
+            SPDBatch.push_back({&TexView, pSPDPSO, pTexVk->GetState(), pTexVk->GetLayout()});
+        else
+            GenerateMipsMultiPass(TexView, Ctx, Resources);
+    }
+
+    if (!SPDBatch.empty())
+        GenerateMipsSPD(Ctx, Resources);
+}
+
+void GenerateMipsVkHelper::GenerateMipsMultiPass(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, ContextResources& Resources)
+{
+    const auto OriginalLayout = TexView.GetTexture<TextureVkImpl>()->GetLayout();
+
+    auto SubresRange = GetSubresourceRange(TexView);
 
     VkImageLayout AffectedMipLevelLayout;
 #if !DILIGENT_NO_GLSLANG
     if (TexView.HasMipLevelViews())
     {
-        VERIFY_EXPR(pSRB != nullptr);
-        AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *pSRB, SubresRange);
+        VERIFY_EXPR(Resources.pSRB != nullptr);
+        AffectedMipLevelLayout = GenerateMipsCS(TexView, Ctx, *Resources.pSRB, SubresRange);
     }
     else
 #endif
@@ -282,27 +497,7 @@ void GenerateMipsVkHelper::GenerateMips(TextureViewVkImpl& TexView, DeviceContex
     }
 
     // All affected mip levels are now in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL state
-    if (AffectedMipLevelLayout != OriginalLayout)
-    {
-        bool IsAllSlices = (TexDesc.Type != RESOURCE_DIM_TEX_1D_ARRAY &&
-                            TexDesc.Type != RESOURCE_DIM_TEX_2D_ARRAY &&
-                            TexDesc.Type != RESOURCE_DIM_TEX_CUBE_ARRAY) ||
-            TexDesc.ArraySize == ViewDesc.NumArraySlices;
-        bool IsAllMips = ViewDesc.NumMipLevels == TexDesc.MipLevels;
-        if (IsAllSlices && IsAllMips)
-        {
-            pTexVk->SetLayout(AffectedMipLevelLayout);
-        }
-        else
-        {
-            VERIFY(OriginalLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Original layout must not be undefined");
-            SubresRange.baseMipLevel = ViewDesc.MostDetailedMip;
-            SubresRange.levelCount   = ViewDesc.NumMipLevels;
-            // Transition all affected subresources back to original layout
-            Ctx.TransitionImageLayout(*pTexVk, AffectedMipLevelLayout, OriginalLayout, SubresRange);
-            VERIFY_EXPR(pTexVk->GetLayout() == OriginalLayout);
-        }
-    }
+    RestoreLayout(TexView, Ctx, AffectedMipLevelLayout, OriginalLayout, SubresRange);
 }
 
 VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, IShaderResourceBinding& SRB, VkImageSubresourceRange& SubresRange)
@@ -421,6 +616,128 @@ VkImageLayout GenerateMipsVkHelper::GenerateMipsCS(TextureViewVkImpl& TexView, D
     return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 }
 
+void GenerateMipsVkHelper::GenerateMipsSPD(DeviceContextVkImpl& Ctx, ContextResources& Resources)
+{
+    auto& SPDBatch = Resources.SPDBatch;
+    auto& SRB      = *Resources.pSPDSRB;
+
+    // Group the views that use the same pipeline
+    std::stable_sort(SPDBatch.begin(), SPDBatch.end(),
+                     [](const ContextResources::SPDBatchItem& lhs, const ContextResources::SPDBatchItem& rhs) {
+                         return lhs.pPSO < rhs.pPSO;
+                     });
+
+    // Transition source and destination mip levels of all views. The command buffer accumulates
+    // the barriers and records them with a single vkCmdPipelineBarrier before the first dispatch.
+    for (const auto& Item : SPDBatch)
+    {
+        auto*       pTexVk   = Item.pTexView->GetTexture<TextureVkImpl>();
+        const auto& ViewDesc = Item.pTexView->GetDesc();
+
+        auto SubresRange = GetSubresourceRange(*Item.pTexView);
+        if (Item.OriginalState != RESOURCE_STATE_SHADER_RESOURCE)
+            Ctx.TransitionTextureState(*pTexVk, Item.OriginalState, RESOURCE_STATE_SHADER_RESOURCE, false /*UpdateTextureState*/, &SubresRange);
+
+        // All mip levels are generated by a single dispatch
+        SubresRange.baseMipLevel = ViewDesc.MostDetailedMip + 1;
+        SubresRange.levelCount   = ViewDesc.NumMipLevels - 1;
+        if (Item.OriginalLayout != VK_IMAGE_LAYOUT_GENERAL)
+            Ctx.TransitionImageLayout(*pTexVk, Item.OriginalLayout, VK_IMAGE_LAYOUT_GENERAL, SubresRange);
+    }
+
+    auto& CounterVk = *Resources.pSPDCounter.RawPtr<BufferVkImpl>();
+    // Wait for the previous dispatches that used the counters
+    Ctx.TransitionBufferState(CounterVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, true /*UpdateBufferState*/);
+
+    static constexpr const char* OutMipNames[MaxSPDMips] = {
+        "OutMip1", "OutMip2", "OutMip3", "OutMip4", "OutMip5", "OutMip6",
+        "OutMip7", "OutMip8", "OutMip9", "OutMip10", "OutMip11", "OutMip12" //
+    };
+
+    // Every view uses its own range of counters, so that dispatches do not need to wait for each other
+    Uint32          CounterOffset = 0;
+    IPipelineState* pCurrPSO      = nullptr;
+    for (const auto& Item : SPDBatch)
+    {
+        auto&       TexView  = *Item.pTexView;
+        const auto& TexDesc  = TexView.GetTexture<TextureVkImpl>()->GetDesc();
+        const auto& ViewDesc = TexView.GetDesc();
+
+        if (CounterOffset + ViewDesc.NumArraySlices > MaxSPDArraySlices)
+        {
+            // All counters are in use: wait until previous dispatches reset them
+            Ctx.TransitionBufferState(CounterVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, true /*UpdateBufferState*/);
+            CounterOffset = 0;
+        }
+
+        if (Item.pPSO != pCurrPSO)
+        {
+            pCurrPSO = Item.pPSO;
+            Ctx.SetPipelineState(pCurrPSO);
+        }
+
+        SRB.GetVariableByName(SHADER_TYPE_COMPUTE, "SrcMip")->Set(TexView.GetMipLevelSRV(0));
+
+        // Mip levels are relative to the view's most detailed mip
+        const Uint32 NumMips = ViewDesc.NumMipLevels - 1;
+        for (Uint32 Mip = 1; Mip <= MaxSPDMips; ++Mip)
+        {
+            // Bind the last mip level to all unused variables
+            SRB.GetVariableByName(SHADER_TYPE_COMPUTE, OutMipNames[Mip - 1])->Set(TexView.GetMipLevelUAV(std::min(Mip, NumMips)));
+        }
+
+        const Uint32 SrcWidth   = std::max(TexDesc.Width >> ViewDesc.MostDetailedMip, 1u);
+        const Uint32 SrcHeight  = std::max(TexDesc.Height >> ViewDesc.MostDetailedMip, 1u);
+        const Uint32 Mip1Width  = std::max(SrcWidth >> 1, 1u);
+        const Uint32 Mip1Height = std::max(SrcHeight >> 1, 1u);
+
+        // Every thread group produces a 32x32 tile of mip 1
+        DispatchComputeAttribs DispatchAttrs((Mip1Width + 31) / 32, (Mip1Height + 31) / 32, ViewDesc.NumArraySlices);
+
+        {
+            struct CBData
+            {
+                Int32 SrcMipSize[2]; // Dimensions of the source mip level
+                Int32 NumMipLevels;  // Number of mip levels to generate: [1, 12]
+                Int32 NumGroups;     // Number of thread groups per array slice
+                Int32 CounterOffset; // Index of the counter of the first array slice
+                Int32 Padding[3];
+            };
+            MapHelper<CBData> MappedData(&Ctx, m_ConstantsCB, MAP_WRITE, MAP_FLAG_DISCARD);
+
+            *MappedData =
+                {
+                    {static_cast<Int32>(SrcWidth), static_cast<Int32>(SrcHeight)},
+                    static_cast<Int32>(NumMips),
+                    static_cast<Int32>(DispatchAttrs.ThreadGroupCountX * DispatchAttrs.ThreadGroupCountY),
+                    static_cast<Int32>(CounterOffset),
+                    {} //
+                };
+        }
+
+        Ctx.CommitShaderResources(&SRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+        Ctx.DispatchCompute(DispatchAttrs);
+
+        CounterOffset += ViewDesc.NumArraySlices;
+    }
+
+    for (const auto& Item : SPDBatch)
+    {
+        auto*       pTexVk   = Item.pTexView->GetTexture<TextureVkImpl>();
+        const auto& ViewDesc = Item.pTexView->GetDesc();
+
+        auto SubresRange         = GetSubresourceRange(*Item.pTexView);
+        SubresRange.baseMipLevel = ViewDesc.MostDetailedMip + 1;
+        SubresRange.levelCount   = ViewDesc.NumMipLevels - 1;
+        Ctx.TransitionImageLayout(*pTexVk, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, SubresRange);
+
+        // All affected mip levels are now in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL state
+        RestoreLayout(*Item.pTexView, Ctx, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, Item.OriginalLayout, SubresRange);
+    }
+
+    SPDBatch.clear();
+}
+
 VkImageLayout GenerateMipsVkHelper::GenerateMipsBlit(TextureViewVkImpl& TexView, DeviceContextVkImpl& Ctx, VkImageSubresourceRange& SubresRange) const
 {
     auto*       pTexVk   = TexView.GetTexture<TextureVkImpl>();
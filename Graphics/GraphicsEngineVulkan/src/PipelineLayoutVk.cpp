@@ -37,6 +37,7 @@
 
 #include "VulkanTypeConversions.hpp"
 #include "StringTools.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -63,17 +64,27 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
 {
     VERIFY(m_DescrSetCount == 0 && !m_VkPipelineLayout, "This pipeline layout is already initialized");
 
-    std::array<VkDescriptorSetLayout, MAX_RESOURCE_SIGNATURES * PipelineResourceSignatureVkImpl::MAX_DESCRIPTOR_SETS> DescSetLayouts;
+    // Reserve one extra slot for the bindless heap set
+    std::array<VkDescriptorSetLayout, MAX_RESOURCE_SIGNATURES * PipelineResourceSignatureVkImpl::MAX_DESCRIPTOR_SETS + 1> DescSetLayouts;
 
     Uint32 DescSetLayoutCount        = 0;
     Uint32 DynamicUniformBufferCount = 0;
     Uint32 DynamicStorageBufferCount = 0;
+    bool   UsesBindlessHeap          = false;
 
+    VkPushConstantRange PushConstantRange{};
+    Uint32              InlineConstantsSignature = InvalidSignatureIndex;
+
+    size_t SetCompatibilityHash = 0;
     for (Uint32 i = 0; i < SignatureCount; ++i)
     {
         const auto& pSignature = ppSignatures[i];
         if (pSignature == nullptr)
+        {
+            HashCombine(SetCompatibilityHash, i);
+            m_SetCompatibilityHashes[i] = SetCompatibilityHash;
             continue;
+        }
 
         VERIFY(DescSetLayoutCount <= std::numeric_limits<FirstDescrSetIndexArrayType::value_type>::max(),
                "Descriptor set layout count (", DescSetLayoutCount, ") exceeds the maximum representable value");
@@ -81,18 +92,71 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
 
         for (auto SetId : {PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE, PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC})
         {
-            if (pSignature->HasDescriptorSet(SetId))
+            if (!pSignature->HasDescriptorSet(SetId))
+                continue;
+
+            // Only one descriptor set in the pipeline layout may use push descriptors,
+            // so the first signature that supports them gets the push set.
+            if (SetId == PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_DYNAMIC &&
+                m_PushDescrSetSignatureIndex == InvalidSignatureIndex &&
+                pSignature->SupportsPushDescriptors())
+            {
+                m_PushDescrSetSignatureIndex         = static_cast<Uint8>(i);
+                DescSetLayouts[DescSetLayoutCount++] = pSignature->GetVkPushDescriptorSetLayout();
+            }
+            else
+            {
                 DescSetLayouts[DescSetLayoutCount++] = pSignature->GetVkDescriptorSetLayout(SetId);
+            }
         }
 
+        HashCombine(m_Hash, i, pSignature->GetHash());
+
+        // Push descriptor set layouts are not compatible with regular set layouts
+        HashCombine(SetCompatibilityHash, i, pSignature->GetHash(), m_PushDescrSetSignatureIndex == i);
+        m_SetCompatibilityHashes[i] = SetCompatibilityHash;
+
         DynamicUniformBufferCount += pSignature->GetDynamicUniformBufferCount();
         DynamicStorageBufferCount += pSignature->GetDynamicStorageBufferCount();
+        UsesBindlessHeap = UsesBindlessHeap || pSignature->UsesBindlessHeap();
+
+        const auto InlineConstantsResIndex = pSignature->GetInlineConstantsResourceIndex();
+        if (InlineConstantsResIndex != PipelineResourceSignatureVkImpl::InvalidResourceIndex)
+        {
+            // The pipeline layout has a single push constant range that starts at offset 0
+            const auto& ResDesc = pSignature->GetResourceDesc(InlineConstantsResIndex);
+            if (InlineConstantsSignature != InvalidSignatureIndex)
+            {
+                LOG_ERROR_AND_THROW("Inline constants '", ResDesc.Name, "' in signature '", pSignature->GetDesc().Name,
+                                    "' conflict with inline constants in signature '", ppSignatures[InlineConstantsSignature]->GetDesc().Name,
+                                    "'. Only one inline constants resource is allowed in a pipeline.");
+            }
+            InlineConstantsSignature = i;
+
+            PushConstantRange.stageFlags = ShaderTypesToVkShaderStageFlags(ResDesc.ShaderStages);
+            PushConstantRange.offset     = 0;
+            PushConstantRange.size       = ResDesc.ArraySize * sizeof(Uint32);
+        }
 #ifdef DILIGENT_DEBUG
         m_DbgMaxBindIndex = std::max(m_DbgMaxBindIndex, Uint32{pSignature->GetDesc().BindingIndex});
 #endif
     }
     VERIFY_EXPR(DescSetLayoutCount <= MAX_RESOURCE_SIGNATURES * 2);
 
+    // Signature sets must be counted before the bindless set is appended
+    const auto SignatureDescrSetCount = DescSetLayoutCount;
+    if (UsesBindlessHeap)
+    {
+        const auto* pBindlessHeap = pDeviceVk->GetBindlessHeap();
+        if (pBindlessHeap == nullptr)
+        {
+            LOG_ERROR_AND_THROW("The pipeline layout uses resources with PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP flag, "
+                                "but the bindless heap is disabled. Set EngineVkCreateInfo::BindlessHeapSize to a non-zero value.");
+        }
+        m_BindlessDescrSetIndex              = static_cast<Uint8>(DescSetLayoutCount);
+        DescSetLayouts[DescSetLayoutCount++] = pBindlessHeap->GetVkDescriptorSetLayout();
+    }
+
     const auto& Limits = pDeviceVk->GetPhysicalDevice().GetProperties().limits;
     if (DescSetLayoutCount > Limits.maxBoundDescriptorSets)
     {
@@ -112,8 +176,14 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
                             ") used by the pipeline layout exceeds device limit (", Limits.maxDescriptorSetStorageBuffersDynamic, ")");
     }
 
-    VERIFY(m_DescrSetCount <= std::numeric_limits<decltype(m_DescrSetCount)>::max(),
-           "Descriptor set count (", DescSetLayoutCount, ") exceeds the maximum representable value");
+    if (PushConstantRange.size > Limits.maxPushConstantsSize)
+    {
+        LOG_ERROR_AND_THROW("The size of inline constants (", PushConstantRange.size,
+                            " bytes) used by the pipeline layout exceeds device limit (", Limits.maxPushConstantsSize, ")");
+    }
+
+    VERIFY(SignatureDescrSetCount <= std::numeric_limits<decltype(m_DescrSetCount)>::max(),
+           "Descriptor set count (", SignatureDescrSetCount, ") exceeds the maximum representable value");
 
     VkPipelineLayoutCreateInfo PipelineLayoutCI = {};
 
@@ -122,11 +192,18 @@ void PipelineLayoutVk::Create(RenderDeviceVkImpl* pDeviceVk, RefCntAutoPtr<Pipel
     PipelineLayoutCI.flags                  = 0; // reserved for future use
     PipelineLayoutCI.setLayoutCount         = DescSetLayoutCount;
     PipelineLayoutCI.pSetLayouts            = DescSetLayoutCount ? DescSetLayouts.data() : nullptr;
-    PipelineLayoutCI.pushConstantRangeCount = 0;
-    PipelineLayoutCI.pPushConstantRanges    = nullptr;
+    PipelineLayoutCI.pushConstantRangeCount = PushConstantRange.size != 0 ? 1 : 0;
+    PipelineLayoutCI.pPushConstantRanges    = PushConstantRange.size != 0 ? &PushConstantRange : nullptr;
     m_VkPipelineLayout                      = pDeviceVk->GetLogicalDevice().CreatePipelineLayout(PipelineLayoutCI);
 
-    m_DescrSetCount = static_cast<Uint8>(DescSetLayoutCount);
+    m_DescrSetCount = static_cast<Uint8>(SignatureDescrSetCount);
+
+    // Layouts with different push constant ranges are not compatible for any set
+    for (Uint32 i = 0; i < SignatureCount; ++i)
+        HashCombine(m_SetCompatibilityHashes[i], PushConstantRange.stageFlags, PushConstantRange.size);
+
+    m_PushConstantStages = PushConstantRange.stageFlags;
+    m_PushConstantSize   = PushConstantRange.size;
 }
 
 } // namespace Diligent
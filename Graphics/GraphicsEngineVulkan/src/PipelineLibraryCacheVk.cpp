@@ -0,0 +1,385 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineLibraryCacheVk.hpp"
+
+#include <cstring>
+
+#include "RenderDeviceVkImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+using LibraryKey = PipelineLibraryCacheVk::LibraryKey;
+
+const VkPipelineRenderingCreateInfoKHR* FindRenderingCI(const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    const auto* pRenderingCI = static_cast<const VkPipelineRenderingCreateInfoKHR*>(PipelineCI.pNext);
+    VERIFY(pRenderingCI == nullptr || pRenderingCI->sType == VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+           "The only structure that graphics pipelines may chain is VkPipelineRenderingCreateInfoKHR");
+    return pRenderingCI;
+}
+
+void AddShaderStages(LibraryKey&                                      Key,
+                     const VkGraphicsPipelineCreateInfo&              PipelineCI,
+                     const std::vector<const std::vector<uint32_t>*>& StageSPIRVs,
+                     bool                                             FragmentStage,
+                     std::vector<VkPipelineShaderStageCreateInfo>&    Stages)
+{
+    VERIFY_EXPR(StageSPIRVs.size() == PipelineCI.stageCount);
+    for (uint32_t i = 0; i < PipelineCI.stageCount; ++i)
+    {
+        const auto& Stage = PipelineCI.pStages[i];
+        if ((Stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT) != FragmentStage)
+            continue;
+
+        Stages.push_back(Stage);
+
+        const auto& SPIRV = *StageSPIRVs[i];
+        Key.Add(Stage.stage, Stage.flags, SPIRV.size());
+        Key.AddBytes(SPIRV.data(), SPIRV.size() * sizeof(uint32_t));
+        Key.AddBytes(Stage.pName, strlen(Stage.pName) + 1);
+        if (const auto* pSpecInfo = Stage.pSpecializationInfo)
+        {
+            Key.Add(pSpecInfo->mapEntryCount);
+            for (uint32_t e = 0; e < pSpecInfo->mapEntryCount; ++e)
+            {
+                const auto& Entry = pSpecInfo->pMapEntries[e];
+                Key.Add(Entry.constantID, Entry.offset, Entry.size);
+            }
+            Key.Add(pSpecInfo->dataSize);
+            Key.AddBytes(pSpecInfo->pData, pSpecInfo->dataSize);
+        }
+        else
+        {
+            Key.Add(uint32_t{0});
+        }
+    }
+    // Separate the stages from the rest of the state
+    Key.Add(static_cast<uint32_t>(Stages.size()));
+}
+
+void AddRenderPassState(LibraryKey& Key, const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    Key.Add(PipelineCI.renderPass, PipelineCI.subpass);
+    if (const auto* pRenderingCI = FindRenderingCI(PipelineCI))
+    {
+        Key.Add(pRenderingCI->viewMask, pRenderingCI->colorAttachmentCount);
+        for (uint32_t rt = 0; rt < pRenderingCI->colorAttachmentCount; ++rt)
+            Key.Add(pRenderingCI->pColorAttachmentFormats[rt]);
+        Key.Add(pRenderingCI->depthAttachmentFormat, pRenderingCI->stencilAttachmentFormat);
+    }
+}
+
+void AddDynamicState(LibraryKey& Key, const VkGraphicsPipelineCreateInfo& PipelineCI)
+{
+    // Dynamic states that are not relevant to the library are ignored by the implementation,
+    // so all libraries use the same list.
+    const auto* pDynamicState = PipelineCI.pDynamicState;
+    Key.Add(pDynamicState != nullptr ? pDynamicState->dynamicStateCount : 0u);
+    if (pDynamicState != nullptr)
+    {
+        for (uint32_t i = 0; i < pDynamicState->dynamicStateCount; ++i)
+            Key.Add(pDynamicState->pDynamicStates[i]);
+    }
+}
+
+void AddMultisampleState(LibraryKey& Key, const VkPipelineMultisampleStateCreateInfo& MSStateCI)
+{
+    Key.Add(MSStateCI.rasterizationSamples, MSStateCI.sampleShadingEnable, MSStateCI.minSampleShading,
+            MSStateCI.alphaToCoverageEnable, MSStateCI.alphaToOneEnable);
+    if (MSStateCI.pSampleMask != nullptr)
+    {
+        for (uint32_t i = 0; i < (MSStateCI.rasterizationSamples + 31) / 32; ++i)
+            Key.Add(MSStateCI.pSampleMask[i]);
+    }
+}
+
+void AddStencilOpState(LibraryKey& Key, const VkStencilOpState& StencilOp)
+{
+    Key.Add(StencilOp.failOp, StencilOp.passOp, StencilOp.depthFailOp, StencilOp.compareOp,
+            StencilOp.compareMask, StencilOp.writeMask, StencilOp.reference);
+}
+
+} // namespace
+
+void PipelineLibraryCacheVk::LibraryKey::AddBytes(const void* pData, size_t Size)
+{
+    if (Size == 0)
+        return;
+
+    VERIFY_EXPR(pData != nullptr);
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+    Data.insert(Data.end(), pBytes, pBytes + Size);
+    Hash = 0;
+}
+
+PipelineLibraryCacheVk::PipelineLibraryCacheVk(RenderDeviceVkImpl& DeviceVk) noexcept :
+    m_DeviceVkImpl{DeviceVk}
+{}
+
+PipelineLibraryCacheVk::~PipelineLibraryCacheVk()
+{
+    // Pipelines linked from the libraries do not reference them, so the libraries
+    // are destroyed directly rather than through the release queues.
+}
+
+VkPipeline PipelineLibraryCacheVk::GetLibrary(LIBRARY_TYPE                        Type,
+                                              LibraryKey&&                        Key,
+                                              const VkGraphicsPipelineCreateInfo& LibraryCI,
+                                              VkPipelineCache                     vkPSOCache,
+                                              const char*                         Name)
+{
+    auto& Libraries = m_Libraries[Type];
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = Libraries.find(Key);
+        if (it != Libraries.end())
+            return it->second;
+    }
+
+    auto Library = m_DeviceVkImpl.GetLogicalDevice().CreateGraphicsPipeline(LibraryCI, vkPSOCache, Name);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    // If another thread has created the same library in the meantime, the new one is discarded.
+    return Libraries.emplace(std::move(Key), std::move(Library)).first->second;
+}
+
+PipelineLibraryCacheVk::LibrarySet PipelineLibraryCacheVk::GetLibraries(const VkGraphicsPipelineCreateInfo&               PipelineCI,
+                                                                        const std::vector<const std::vector<uint32_t>*>& StageSPIRVs,
+                                                                        size_t                                           LayoutHash,
+                                                                        VkPipelineCache                                  vkPSOCache,
+                                                                        const char*                                      Name)
+{
+    VERIFY(PipelineCI.pVertexInputState != nullptr && PipelineCI.pInputAssemblyState != nullptr,
+           "Pipeline libraries are only used for pipelines with vertex input");
+    VERIFY_EXPR(PipelineCI.pViewportState != nullptr && PipelineCI.pRasterizationState != nullptr &&
+                PipelineCI.pMultisampleState != nullptr && PipelineCI.pDepthStencilState != nullptr &&
+                PipelineCI.pColorBlendState != nullptr);
+
+    VkGraphicsPipelineLibraryCreateInfoEXT LibraryInfo{};
+    LibraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+
+    VkGraphicsPipelineCreateInfo LibraryCI{};
+    LibraryCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    LibraryCI.pNext = &LibraryInfo;
+    // Link time optimization information must be retained to allow optimized linking
+    LibraryCI.flags              = PipelineCI.flags | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR | VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
+    LibraryCI.pDynamicState      = PipelineCI.pDynamicState;
+    LibraryCI.basePipelineHandle = VK_NULL_HANDLE;
+    LibraryCI.basePipelineIndex  = -1;
+
+    LibrarySet Set;
+    Set.Flags = PipelineCI.flags;
+
+    auto& Libraries = Set.Libraries;
+
+    // Vertex input interface
+    {
+        LibraryKey Key;
+        Key.Add(LibraryCI.flags);
+        AddDynamicState(Key, PipelineCI);
+
+        const auto& VertexInput = *PipelineCI.pVertexInputState;
+        Key.Add(VertexInput.vertexBindingDescriptionCount);
+        for (uint32_t i = 0; i < VertexInput.vertexBindingDescriptionCount; ++i)
+        {
+            const auto& Binding = VertexInput.pVertexBindingDescriptions[i];
+            Key.Add(Binding.binding, Binding.stride, Binding.inputRate);
+        }
+        Key.Add(VertexInput.vertexAttributeDescriptionCount);
+        for (uint32_t i = 0; i < VertexInput.vertexAttributeDescriptionCount; ++i)
+        {
+            const auto& Attrib = VertexInput.pVertexAttributeDescriptions[i];
+            Key.Add(Attrib.location, Attrib.binding, Attrib.format, Attrib.offset);
+        }
+        if (const auto* pDivisorCI = static_cast<const VkPipelineVertexInputDivisorStateCreateInfoEXT*>(VertexInput.pNext))
+        {
+            VERIFY_EXPR(pDivisorCI->sType == VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT);
+            Key.Add(pDivisorCI->vertexBindingDivisorCount);
+            for (uint32_t i = 0; i < pDivisorCI->vertexBindingDivisorCount; ++i)
+                Key.Add(pDivisorCI->pVertexBindingDivisors[i].binding, pDivisorCI->pVertexBindingDivisors[i].divisor);
+        }
+        Key.Add(PipelineCI.pInputAssemblyState->topology, PipelineCI.pInputAssemblyState->primitiveRestartEnable);
+
+        LibraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT;
+        LibraryInfo.pNext = nullptr;
+
+        LibraryCI.pVertexInputState   = PipelineCI.pVertexInputState;
+        LibraryCI.pInputAssemblyState = PipelineCI.pInputAssemblyState;
+
+        Libraries[LIBRARY_TYPE_VERTEX_INPUT] = GetLibrary(LIBRARY_TYPE_VERTEX_INPUT, std::move(Key), LibraryCI, vkPSOCache, Name);
+
+        LibraryCI.pVertexInputState   = nullptr;
+        LibraryCI.pInputAssemblyState = nullptr;
+    }
+
+    // Dynamic rendering state is required by all other libraries
+    LibraryInfo.pNext = PipelineCI.pNext;
+
+    // Pre-rasterization shaders
+    {
+        LibraryKey Key;
+        Key.Add(LibraryCI.flags, LayoutHash);
+        AddDynamicState(Key, PipelineCI);
+        AddRenderPassState(Key, PipelineCI);
+
+        std::vector<VkPipelineShaderStageCreateInfo> Stages;
+        AddShaderStages(Key, PipelineCI, StageSPIRVs, false, Stages);
+
+        const auto& ViewportState = *PipelineCI.pViewportState;
+        Key.Add(ViewportState.viewportCount, ViewportState.scissorCount);
+        if (ViewportState.pScissors != nullptr)
+        {
+            for (uint32_t i = 0; i < ViewportState.scissorCount; ++i)
+            {
+                const auto& Rect = ViewportState.pScissors[i];
+                Key.Add(Rect.offset.x, Rect.offset.y, Rect.extent.width, Rect.extent.height);
+            }
+        }
+
+        const auto& RSState = *PipelineCI.pRasterizationState;
+        Key.Add(RSState.depthClampEnable, RSState.rasterizerDiscardEnable, RSState.polygonMode, RSState.cullMode, RSState.frontFace,
+                RSState.depthBiasEnable, RSState.depthBiasConstantFactor, RSState.depthBiasClamp, RSState.depthBiasSlopeFactor, RSState.lineWidth);
+
+        if (PipelineCI.pTessellationState != nullptr)
+            Key.Add(PipelineCI.pTessellationState->patchControlPoints);
+
+        LibraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+
+        LibraryCI.stageCount          = static_cast<uint32_t>(Stages.size());
+        LibraryCI.pStages             = Stages.data();
+        LibraryCI.layout              = PipelineCI.layout;
+        LibraryCI.pViewportState      = PipelineCI.pViewportState;
+        LibraryCI.pRasterizationState = PipelineCI.pRasterizationState;
+        LibraryCI.pTessellationState  = PipelineCI.pTessellationState;
+        LibraryCI.renderPass          = PipelineCI.renderPass;
+        LibraryCI.subpass             = PipelineCI.subpass;
+
+        Libraries[LIBRARY_TYPE_PRE_RASTERIZATION] = GetLibrary(LIBRARY_TYPE_PRE_RASTERIZATION, std::move(Key), LibraryCI, vkPSOCache, Name);
+
+        LibraryCI.stageCount          = 0;
+        LibraryCI.pStages             = nullptr;
+        LibraryCI.pViewportState      = nullptr;
+        LibraryCI.pRasterizationState = nullptr;
+        LibraryCI.pTessellationState  = nullptr;
+    }
+
+    // Fragment shader
+    {
+        LibraryKey Key;
+        Key.Add(LibraryCI.flags, LayoutHash);
+        AddDynamicState(Key, PipelineCI);
+        AddRenderPassState(Key, PipelineCI);
+
+        // Pipelines without a pixel shader use a fragment shader library with no stages
+        std::vector<VkPipelineShaderStageCreateInfo> Stages;
+        AddShaderStages(Key, PipelineCI, StageSPIRVs, true, Stages);
+
+        AddMultisampleState(Key, *PipelineCI.pMultisampleState);
+
+        const auto& DSState = *PipelineCI.pDepthStencilState;
+        Key.Add(DSState.depthTestEnable, DSState.depthWriteEnable, DSState.depthCompareOp, DSState.depthBoundsTestEnable,
+                DSState.stencilTestEnable, DSState.minDepthBounds, DSState.maxDepthBounds);
+        AddStencilOpState(Key, DSState.front);
+        AddStencilOpState(Key, DSState.back);
+
+        LibraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT;
+
+        LibraryCI.stageCount         = static_cast<uint32_t>(Stages.size());
+        LibraryCI.pStages            = !Stages.empty() ? Stages.data() : nullptr;
+        LibraryCI.pMultisampleState  = PipelineCI.pMultisampleState;
+        LibraryCI.pDepthStencilState = PipelineCI.pDepthStencilState;
+
+        Libraries[LIBRARY_TYPE_FRAGMENT_SHADER] = GetLibrary(LIBRARY_TYPE_FRAGMENT_SHADER, std::move(Key), LibraryCI, vkPSOCache, Name);
+
+        LibraryCI.stageCount         = 0;
+        LibraryCI.pStages            = nullptr;
+        LibraryCI.layout             = VK_NULL_HANDLE;
+        LibraryCI.pDepthStencilState = nullptr;
+    }
+
+    // Fragment output interface
+    {
+        LibraryKey Key;
+        Key.Add(LibraryCI.flags);
+        AddDynamicState(Key, PipelineCI);
+        AddRenderPassState(Key, PipelineCI);
+        AddMultisampleState(Key, *PipelineCI.pMultisampleState);
+
+        const auto& BlendState = *PipelineCI.pColorBlendState;
+        Key.Add(BlendState.logicOpEnable, BlendState.logicOp, BlendState.attachmentCount);
+        for (uint32_t i = 0; i < BlendState.attachmentCount; ++i)
+        {
+            const auto& RTBlend = BlendState.pAttachments[i];
+            Key.Add(RTBlend.blendEnable, RTBlend.srcColorBlendFactor, RTBlend.dstColorBlendFactor, RTBlend.colorBlendOp,
+                    RTBlend.srcAlphaBlendFactor, RTBlend.dstAlphaBlendFactor, RTBlend.alphaBlendOp, RTBlend.colorWriteMask);
+        }
+        Key.Add(BlendState.blendConstants[0], BlendState.blendConstants[1], BlendState.blendConstants[2], BlendState.blendConstants[3]);
+
+        LibraryInfo.flags = VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT;
+
+        LibraryCI.pColorBlendState = PipelineCI.pColorBlendState;
+
+        Libraries[LIBRARY_TYPE_FRAGMENT_OUTPUT] = GetLibrary(LIBRARY_TYPE_FRAGMENT_OUTPUT, std::move(Key), LibraryCI, vkPSOCache, Name);
+    }
+
+    return Set;
+}
+
+VulkanUtilities::PipelineWrapper PipelineLibraryCacheVk::LinkPipeline(const LibrarySet& Libraries,
+                                                                      VkPipelineLayout  vkLayout,
+                                                                      bool              Optimize,
+                                                                      VkPipelineCache   vkPSOCache,
+                                                                      const char*       Name) const
+{
+    VkPipelineLibraryCreateInfoKHR LibraryCI{};
+    LibraryCI.sType        = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    LibraryCI.libraryCount = static_cast<uint32_t>(Libraries.Libraries.size());
+    LibraryCI.pLibraries   = Libraries.Libraries.data();
+
+    VkGraphicsPipelineCreateInfo PipelineCI{};
+    PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    PipelineCI.pNext = &LibraryCI;
+    PipelineCI.flags = Libraries.Flags;
+    if (Optimize)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT;
+    PipelineCI.layout             = vkLayout;
+    PipelineCI.basePipelineHandle = VK_NULL_HANDLE;
+    PipelineCI.basePipelineIndex  = -1;
+
+    return m_DeviceVkImpl.GetLogicalDevice().CreateGraphicsPipeline(PipelineCI, vkPSOCache, Name);
+}
+
+} // namespace Diligent
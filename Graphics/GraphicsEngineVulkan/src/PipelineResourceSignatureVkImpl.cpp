@@ -36,6 +36,7 @@
 #include "VulkanTypeConversions.hpp"
 #include "DynamicLinearAllocator.hpp"
 #include "SPIRVShaderResources.hpp"
+#include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
 namespace Diligent
 {
@@ -165,6 +166,8 @@ PipelineResourceSignatureVkImpl::PipelineResourceSignatureVkImpl(IReferenceCount
 
 void PipelineResourceSignatureVkImpl::CreateSetLayouts()
 {
+    m_UsesDescriptorBuffer = GetDevice()->GetDescriptorBuffer() != nullptr;
+
     // Initialize static resource cache first
     if (auto NumStaticResStages = GetNumStaticResStages())
     {
@@ -173,7 +176,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
         for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
         {
             const auto& ResDesc = m_Desc.Resources[i];
-            if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC && !IsOutOfSetResource(i))
                 StaticResourceCount += ResDesc.ArraySize;
         }
         m_pStaticResCache->InitializeSets(GetRawAllocator(), 1, &StaticResourceCount);
@@ -183,8 +186,11 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
     BindingCountType BindingCount    = {}; // Binding count in each cache group
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
     {
-        const auto& ResDesc    = m_Desc.Resources[i];
-        const auto  CacheGroup = GetResourceCacheGroup(ResDesc);
+        const auto& ResDesc = m_Desc.Resources[i];
+        if (IsOutOfSetResource(i))
+            continue;
+
+        const auto CacheGroup = GetResourceCacheGroup(ResDesc);
 
         BindingCount[CacheGroup] += 1;
         // Note that we may reserve space for separate immutable samplers, which will never be used, but this is OK.
@@ -257,6 +263,51 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
 
         VERIFY(i == 0 || ResDesc.VarType >= m_Desc.Resources[i - 1].VarType, "Resources must be sorted by variable type");
 
+        if (IsInlineConstantsResource(i))
+        {
+            // Inline constants are mapped to the push constant range of the pipeline layout,
+            // see PipelineLayoutVk. ArraySize is the number of 32-bit constants.
+            new (m_pResourceAttribs + i) ResourceAttribs //
+                {
+                    0,
+                    ResourceAttribs::InvalidSamplerInd,
+                    ResDesc.ArraySize,
+                    DescrType,
+                    0,
+                    false,
+                    ~0u,
+                    ~0u //
+                };
+            m_InlineConstantsResIndex = i;
+            continue;
+        }
+
+        if (IsBindlessHeapResource(i))
+        {
+            // Bindless heap resources take no space in the signature descriptor sets and resource caches.
+            // The binding index refers to the array in the global bindless set, see BindlessDescriptorHeapVk.
+            const auto Binding = BindlessDescriptorHeapVk::GetBinding(DescrType);
+            if (Binding == BindlessDescriptorHeapVk::BINDING_UNKNOWN)
+            {
+                LOG_ERROR_AND_THROW("Resource '", ResDesc.Name, "' of type ", GetShaderResourceTypeLiteralName(ResDesc.ResourceType),
+                                    " can't be placed in the bindless heap. Buffer resources must use PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS flag.");
+            }
+
+            new (m_pResourceAttribs + i) ResourceAttribs //
+                {
+                    Binding,
+                    ResourceAttribs::InvalidSamplerInd,
+                    ResDesc.ArraySize,
+                    DescrType,
+                    0,
+                    false,
+                    ~0u,
+                    ~0u //
+                };
+            m_UsesBindlessHeap = true;
+            continue;
+        }
+
         // If all resources are dynamic, then the signature contains only one descriptor set layout with index 0,
         // so remap SetId to the actual descriptor set index.
         VERIFY_EXPR(DSMapping[SetId] < MAX_DESCRIPTOR_SETS);
@@ -309,6 +360,8 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
         vkSetLayoutBinding.stageFlags         = ShaderTypesToVkShaderStageFlags(ResDesc.ShaderStages);
         vkSetLayoutBinding.pImmutableSamplers = pVkImmutableSamplers;
         vkSetLayoutBinding.descriptorType     = DescriptorTypeToVkDescriptorType(pAttribs->GetDescriptorType());
+        if (m_UsesDescriptorBuffer)
+            vkSetLayoutBinding.descriptorType = DescriptorBufferVk::GetDescriptorBufferType(vkSetLayoutBinding.descriptorType);
 
         if (ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
         {
@@ -326,10 +379,15 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
     }
 #endif
 
-    m_DynamicUniformBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
-    m_DynamicStorageBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR]);
-    VERIFY_EXPR(m_DynamicUniformBufferCount == CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
-    VERIFY_EXPR(m_DynamicStorageBufferCount == CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR]);
+    if (!m_UsesDescriptorBuffer)
+    {
+        m_DynamicUniformBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
+        m_DynamicStorageBufferCount = static_cast<Uint16>(CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR]);
+        VERIFY_EXPR(m_DynamicUniformBufferCount == CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR]);
+        VERIFY_EXPR(m_DynamicStorageBufferCount == CacheGroupSizes[CACHE_GROUP_DYN_SB_STAT_VAR] + CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR]);
+    }
+    // In descriptor buffer mode there are no descriptors with dynamic offsets: buffer addresses
+    // are written to the descriptor data when the SRB is committed (see WriteDescriptorBufferSet).
 
     VERIFY_EXPR(m_pStaticResCache == nullptr || const_cast<const ShaderResourceCacheVk*>(m_pStaticResCache)->GetDescriptorSet(0).GetSize() == StaticCacheOffset);
     VERIFY_EXPR(CacheGroupOffsets[CACHE_GROUP_DYN_UB_STAT_VAR] == CacheGroupSizes[CACHE_GROUP_DYN_UB_STAT_VAR]);
@@ -418,7 +476,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
 
     SetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
     SetLayoutCI.pNext = nullptr;
-    SetLayoutCI.flags = 0;
+    SetLayoutCI.flags = m_UsesDescriptorBuffer ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0;
 
     const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
 
@@ -434,6 +492,113 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
     }
 
     VERIFY_EXPR(NumSets == GetNumDescriptorSets());
+
+    if (m_UsesDescriptorBuffer)
+    {
+        // Query the set layout sizes and binding offsets. Descriptor buffer sets are written directly,
+        // so neither update templates nor push descriptors are used in this mode.
+        const auto& DescriptorBuffer = *GetDevice()->GetDescriptorBuffer();
+        for (size_t SetId = 0; SetId < vkSetLayoutBindings.size(); ++SetId)
+        {
+            const VkDescriptorSetLayout vkLayout = m_VkDescrSetLayouts[SetId];
+            if (vkLayout == VK_NULL_HANDLE)
+                continue;
+
+            m_DescriptorBufferSetSizes[SetId] = static_cast<Uint32>(LogicalDevice.GetDescriptorSetLayoutSize(vkLayout));
+
+            auto& Bindings = m_DescriptorBufferBindings[SetId];
+            Bindings.resize(vkSetLayoutBindings[SetId].size());
+            for (const auto& vkBinding : vkSetLayoutBindings[SetId])
+            {
+                VERIFY_EXPR(vkBinding.binding < Bindings.size());
+                auto& Binding     = Bindings[vkBinding.binding];
+                Binding.Offset    = static_cast<Uint32>(LogicalDevice.GetDescriptorSetLayoutBindingOffset(vkLayout, vkBinding.binding));
+                Binding.Stride    = DescriptorBuffer.GetDescriptorSize(vkBinding.descriptorType);
+                Binding.ArraySize = vkBinding.descriptorCount;
+                Binding.Type      = vkBinding.descriptorType;
+                // All array elements use the same immutable sampler
+                Binding.ImmutableSampler = vkBinding.pImmutableSamplers != nullptr ? vkBinding.pImmutableSamplers[0] : VK_NULL_HANDLE;
+            }
+        }
+        return;
+    }
+
+    if (m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_DYNAMIC] && LogicalDevice.GetEnabledExtFeatures().DescriptorUpdateTemplate)
+        CreateDynamicSetUpdateTemplate();
+
+    // Push descriptor set layouts must not contain descriptors with dynamic offsets
+    if (m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_DYNAMIC] && LogicalDevice.GetEnabledExtFeatures().PushDescriptor &&
+        CacheGroupSizes[CACHE_GROUP_DYN_UB_DYN_VAR] == 0 && CacheGroupSizes[CACHE_GROUP_DYN_SB_DYN_VAR] == 0)
+    {
+        const auto& DynSetBindings = vkSetLayoutBindings[DESCRIPTOR_SET_ID_DYNAMIC];
+
+        Uint32 NumDescriptors  = 0;
+        bool   HasAccelStructs = false;
+        for (const auto& Binding : DynSetBindings)
+        {
+            NumDescriptors += Binding.descriptorCount;
+            HasAccelStructs = HasAccelStructs || Binding.descriptorType == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        }
+
+        const auto MaxPushDescriptors = std::min(Uint32{MaxPushDescriptorCount}, GetDevice()->GetPhysicalDevice().GetExtProperties().PushDescriptor.maxPushDescriptors);
+        if (NumDescriptors <= MaxPushDescriptors && !HasAccelStructs)
+        {
+            SetLayoutCI.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+            SetLayoutCI.bindingCount = static_cast<Uint32>(DynSetBindings.size());
+            SetLayoutCI.pBindings    = DynSetBindings.data();
+            m_VkPushDescrSetLayout   = LogicalDevice.CreateDescriptorSetLayout(SetLayoutCI);
+        }
+    }
+}
+
+void PipelineResourceSignatureVkImpl::CreateDynamicSetUpdateTemplate()
+{
+    // Template data is the array of DescriptorWriteInfo structures laid out exactly
+    // as resources in the SRB cache, so every entry is located by its cache offset.
+    constexpr auto CacheType       = ResourceCacheContentType::SRB;
+    constexpr auto DescrInfoStride = sizeof(ShaderResourceCacheVk::DescriptorWriteInfo);
+
+    const auto DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+    std::vector<VkDescriptorUpdateTemplateEntry> Entries;
+    Entries.reserve(DynResIdxRange.second - DynResIdxRange.first);
+    for (Uint32 ResIdx = DynResIdxRange.first; ResIdx < DynResIdxRange.second; ++ResIdx)
+    {
+        // Bindless heap resources live in the global bindless set, inline constants are pushed
+        if (IsOutOfSetResource(ResIdx))
+            continue;
+
+        const auto& Attr      = GetResourceAttribs(ResIdx);
+        const auto  DescrType = Attr.GetDescriptorType();
+        // Immutable samplers are permanently bound into the set layout
+        if (DescrType == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        VkDescriptorUpdateTemplateEntry Entry{};
+        Entry.dstBinding      = Attr.BindingIndex;
+        Entry.dstArrayElement = 0;
+        Entry.descriptorCount = Attr.ArraySize;
+        Entry.descriptorType  = DescriptorTypeToVkDescriptorType(DescrType);
+        Entry.offset          = Attr.CacheOffset(CacheType) * DescrInfoStride;
+        Entry.stride          = DescrInfoStride;
+        Entries.push_back(Entry);
+    }
+
+    if (Entries.empty())
+        return;
+
+    VkDescriptorUpdateTemplateCreateInfo TemplateCI{};
+    TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    TemplateCI.pNext                      = nullptr;
+    TemplateCI.flags                      = 0;
+    TemplateCI.descriptorUpdateEntryCount = static_cast<Uint32>(Entries.size());
+    TemplateCI.pDescriptorUpdateEntries   = Entries.data();
+    TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    TemplateCI.descriptorSetLayout        = m_VkDescrSetLayouts[DESCRIPTOR_SET_ID_DYNAMIC];
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    m_VkDynamicSetUpdateTemplate = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI, m_Desc.Name);
 }
 
 PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
@@ -443,6 +608,12 @@ PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 
 void PipelineResourceSignatureVkImpl::Destruct()
 {
+    if (m_VkDynamicSetUpdateTemplate)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_VkDynamicSetUpdateTemplate), ~0ull);
+
+    if (m_VkPushDescrSetLayout)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_VkPushDescrSetLayout), ~0ull);
+
     for (auto& Layout : m_VkDescrSetLayouts)
     {
         if (Layout)
@@ -461,7 +632,8 @@ void PipelineResourceSignatureVkImpl::Destruct()
     TPipelineResourceSignatureBase::Destruct();
 }
 
-void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk& ResourceCache)
+void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk&   ResourceCache,
+                                                           DescriptorSetAllocation* pStaticMutableSetAllocation)
 {
     const auto NumSets = GetNumDescriptorSets();
 #ifdef DILIGENT_DEBUG
@@ -476,6 +648,9 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
     const auto CacheType      = ResourceCache.GetContentType();
     for (Uint32 r = 0; r < TotalResources; ++r)
     {
+        if (IsOutOfSetResource(r))
+            continue;
+
         const auto& ResDesc = GetResourceDesc(r);
         const auto& Attr    = GetResourceAttribs(r);
         ResourceCache.InitializeResources(Attr.DescrSet, Attr.CacheOffset(CacheType), ResDesc.ArraySize,
@@ -486,7 +661,31 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
     ResourceCache.DbgVerifyResourceInitialization();
 #endif
 
-    if (auto vkLayout = GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID_STATIC_MUTABLE))
+    if (m_UsesDescriptorBuffer)
+    {
+        VERIFY(pStaticMutableSetAllocation == nullptr || !*pStaticMutableSetAllocation,
+               "Descriptor sets must not be preallocated in descriptor buffer mode");
+        if (HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE))
+        {
+            // The static/mutable set lives in the global descriptor buffer for the lifetime of the SRB.
+            // The dynamic set is written to the dynamic heap every time the SRB is committed.
+            auto Allocation = GetDevice()->GetDescriptorBuffer()->Allocate(m_DescriptorBufferSetSizes[DESCRIPTOR_SET_ID_STATIC_MUTABLE], ~Uint64{0});
+            if (!Allocation)
+                LOG_ERROR_AND_THROW("Failed to allocate descriptor buffer space for the static/mutable set of signature '", m_Desc.Name, "'.");
+
+            WriteImmutableSamplerDescriptors(DESCRIPTOR_SET_ID_STATIC_MUTABLE, Allocation.GetCPUAddress());
+            ResourceCache.AssignDescriptorBufferAllocation(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>(), std::move(Allocation),
+                                                           m_DescriptorBufferBindings[DESCRIPTOR_SET_ID_STATIC_MUTABLE].data());
+        }
+        return;
+    }
+
+    if (pStaticMutableSetAllocation != nullptr && *pStaticMutableSetAllocation)
+    {
+        VERIFY_EXPR(HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE));
+        ResourceCache.AssignDescriptorSetAllocation(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>(), std::move(*pStaticMutableSetAllocation));
+    }
+    else if (auto vkLayout = GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID_STATIC_MUTABLE))
     {
         const char* DescrSetName = "Static/Mutable Descriptor Set";
 #ifdef DILIGENT_DEVELOPMENT
@@ -499,6 +698,33 @@ void PipelineResourceSignatureVkImpl::InitSRBResourceCache(ShaderResourceCacheVk
     }
 }
 
+void PipelineResourceSignatureVkImpl::CreateSRBBatch(Uint32 NumSRBs, RefCntAutoPtr<ShaderResourceBindingVkImpl>* pSRBs)
+{
+    std::vector<DescriptorSetAllocation> SetAllocations;
+    // In descriptor buffer mode, every SRB allocates its set from the descriptor buffer in InitSRBResourceCache()
+    const VkDescriptorSetLayout vkLayout = !m_UsesDescriptorBuffer ? GetVkDescriptorSetLayout(DESCRIPTOR_SET_ID_STATIC_MUTABLE) : VK_NULL_HANDLE;
+    if (vkLayout != VK_NULL_HANDLE)
+    {
+        const char* DescrSetName = "Static/Mutable Descriptor Set";
+#ifdef DILIGENT_DEVELOPMENT
+        std::string _DescrSetName{m_Desc.Name};
+        _DescrSetName.append(" - static/mutable set");
+        DescrSetName = _DescrSetName.c_str();
+#endif
+        SetAllocations.resize(NumSRBs);
+        GetDevice()->AllocateDescriptorSets(~Uint64{0}, vkLayout, NumSRBs, SetAllocations.data(), DescrSetName);
+    }
+
+    auto& SRBAllocator = m_pDevice->GetSRBAllocator();
+    for (Uint32 i = 0; i < NumSRBs; ++i)
+    {
+        // The SRB takes ownership of the preallocated set. Sets that were not taken because
+        // an exception was thrown are released by the SetAllocations destructor.
+        auto* pSetAllocation = !SetAllocations.empty() ? &SetAllocations[i] : nullptr;
+        pSRBs[i]             = NEW_RC_OBJ(SRBAllocator, "ShaderResourceBinding instance", ShaderResourceBindingVkImpl)(this, pSetAllocation);
+    }
+}
+
 void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk& DstResourceCache) const
 {
     if (!HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) || m_pStaticResCache == nullptr)
@@ -523,6 +749,9 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
         if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER && Attr.IsImmutableSamplerAssigned())
             continue; // Skip immutable separate samplers
 
+        if (IsOutOfSetResource(r))
+            continue;
+
         for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
         {
             const auto     SrcCacheOffset = Attr.CacheOffset(SrcCacheType) + ArrInd;
@@ -558,6 +787,125 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
 #endif
 }
 
+void PipelineResourceSignatureVkImpl::CopyStaticResourcesBatch(Uint32 NumCaches, ShaderResourceCacheVk* const* ppCaches) const
+{
+    if (NumCaches == 0 || !HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) || m_pStaticResCache == nullptr)
+        return;
+
+    const auto& SrcResourceCache = *m_pStaticResCache;
+    const auto  StaticSetIdx     = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>();
+    const auto& SrcDescrSet      = SrcResourceCache.GetDescriptorSet(StaticSetIdx);
+    const auto  ResIdxRange      = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+    const auto  SrcCacheType     = SrcResourceCache.GetContentType();
+    const auto  DstCacheType     = ResourceCacheContentType::SRB;
+
+    // All caches receive the same resources, so the descriptor info is only computed once
+    // and is shared by the writes to all descriptor sets.
+    size_t MaxWrites = 0;
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+        MaxWrites += GetResourceDesc(r).ArraySize;
+
+    std::vector<VkWriteDescriptorSet> WriteTemplates;
+    WriteTemplates.reserve(MaxWrites);
+    // Write infos must not be reallocated as the templates reference them
+    std::vector<ShaderResourceCacheVk::DescriptorWriteInfo> WriteInfos(MaxWrites);
+
+    for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+    {
+        const auto& ResDesc = GetResourceDesc(r);
+        const auto& Attr    = GetResourceAttribs(r);
+        VERIFY_EXPR(ResDesc.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+
+        if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER && Attr.IsImmutableSamplerAssigned())
+            continue; // Skip immutable separate samplers
+
+        if (IsOutOfSetResource(r))
+            continue;
+
+        for (Uint32 ArrInd = 0; ArrInd < ResDesc.ArraySize; ++ArrInd)
+        {
+            const auto& SrcCachedRes = SrcDescrSet.GetResource(Attr.CacheOffset(SrcCacheType) + ArrInd);
+            if (!SrcCachedRes.pObject)
+            {
+                LOG_ERROR_MESSAGE("No resource is assigned to static shader variable '", GetShaderResourcePrintName(ResDesc, ArrInd), "' in pipeline resource signature '", m_Desc.Name, "'.");
+                continue;
+            }
+
+            const auto DstCacheOffset = Attr.CacheOffset(DstCacheType) + ArrInd;
+            for (Uint32 c = 0; c < NumCaches; ++c)
+            {
+                VERIFY(const_cast<const ShaderResourceCacheVk*>(ppCaches[c])->GetDescriptorSet(StaticSetIdx).GetResource(DstCacheOffset).pObject == nullptr,
+                       "Static resources must not be initialized in a new SRB");
+                // Do not write the descriptor - all descriptors are written below with a single call.
+                // In descriptor buffer mode, descriptors are only written to the first cache and are copied to the others.
+                ppCaches[c]->SetResource(c == 0 && m_UsesDescriptorBuffer ? &GetDevice()->GetLogicalDevice() : nullptr,
+                                         StaticSetIdx,
+                                         DstCacheOffset,
+                                         {
+                                             Attr.BindingIndex,
+                                             ArrInd,
+                                             RefCntAutoPtr<IDeviceObject>{SrcCachedRes.pObject},
+                                             SrcCachedRes.BufferBaseOffset,
+                                             SrcCachedRes.BufferRangeSize //
+                                         });
+            }
+
+            const auto& DstRes = const_cast<const ShaderResourceCacheVk*>(ppCaches[0])->GetDescriptorSet(StaticSetIdx).GetResource(DstCacheOffset);
+            VERIFY_EXPR(SrcCachedRes.Type == DstRes.Type);
+            if (m_UsesDescriptorBuffer)
+                continue;
+
+            VkWriteDescriptorSet WriteDescrSet;
+            WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            WriteDescrSet.pNext           = nullptr;
+            WriteDescrSet.dstSet          = VK_NULL_HANDLE;
+            WriteDescrSet.dstBinding      = Attr.BindingIndex;
+            WriteDescrSet.dstArrayElement = ArrInd;
+            WriteDescrSet.descriptorCount = 1;
+            DstRes.GetDescriptorWriteInfo(WriteDescrSet, WriteInfos[WriteTemplates.size()]);
+            WriteTemplates.push_back(WriteDescrSet);
+        }
+    }
+
+    if (m_UsesDescriptorBuffer)
+    {
+        // New SRBs contain no other static/mutable descriptors than static resources and immutable samplers,
+        // so the whole set data can be copied.
+        const auto* pSrcData = const_cast<const ShaderResourceCacheVk*>(ppCaches[0])->GetDescriptorSet(StaticSetIdx).GetDescriptorBufferCPUAddress();
+        VERIFY_EXPR(pSrcData != nullptr);
+        for (Uint32 c = 1; c < NumCaches; ++c)
+        {
+#ifdef DILIGENT_DEBUG
+            ppCaches[c]->DbgVerifyDynamicBuffersCounter();
+#endif
+            auto* pDstData = const_cast<const ShaderResourceCacheVk*>(ppCaches[c])->GetDescriptorSet(StaticSetIdx).GetDescriptorBufferCPUAddress();
+            memcpy(pDstData, pSrcData, m_DescriptorBufferSetSizes[DESCRIPTOR_SET_ID_STATIC_MUTABLE]);
+        }
+        return;
+    }
+
+    std::vector<VkWriteDescriptorSet> Writes;
+    Writes.reserve(WriteTemplates.size() * NumCaches);
+    for (Uint32 c = 0; c < NumCaches; ++c)
+    {
+#ifdef DILIGENT_DEBUG
+        ppCaches[c]->DbgVerifyDynamicBuffersCounter();
+#endif
+        const auto vkSet = const_cast<const ShaderResourceCacheVk*>(ppCaches[c])->GetDescriptorSet(StaticSetIdx).GetVkDescriptorSet();
+        if (vkSet == VK_NULL_HANDLE)
+            continue;
+
+        for (const auto& Template : WriteTemplates)
+        {
+            Writes.push_back(Template);
+            Writes.back().dstSet = vkSet;
+        }
+    }
+
+    if (!Writes.empty())
+        GetDevice()->GetLogicalDevice().UpdateDescriptorSets(static_cast<uint32_t>(Writes.size()), Writes.data(), 0, nullptr);
+}
+
 template <>
 Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE>() const
 {
@@ -572,13 +920,281 @@ Uint32 PipelineResourceSignatureVkImpl::GetDescriptorSetIndex<PipelineResourceSi
     return HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE) ? 1 : 0;
 }
 
-void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
-                                                             VkDescriptorSet              vkDynamicDescriptorSet) const
+void PipelineResourceSignatureVkImpl::WriteImmutableSamplerDescriptors(DESCRIPTOR_SET_ID SetId, Uint8* pDst) const
+{
+    VERIFY_EXPR(m_UsesDescriptorBuffer && pDst != nullptr);
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    for (const auto& Binding : m_DescriptorBufferBindings[SetId])
+    {
+        // Immutable samplers of combined image samplers are written together with the image
+        if (Binding.Type != VK_DESCRIPTOR_TYPE_SAMPLER || Binding.ImmutableSampler == VK_NULL_HANDLE)
+            continue;
+
+        VkDescriptorGetInfoEXT GetInfo{};
+        GetInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+        GetInfo.type          = VK_DESCRIPTOR_TYPE_SAMPLER;
+        GetInfo.data.pSampler = &Binding.ImmutableSampler;
+        for (Uint32 ArrElem = 0; ArrElem < Binding.ArraySize; ++ArrElem)
+            LogicalDevice.GetDescriptor(GetInfo, Binding.Stride, pDst + Binding.Offset + ArrElem * Binding.Stride);
+    }
+}
+
+void PipelineResourceSignatureVkImpl::WriteDescriptorBufferSet(DESCRIPTOR_SET_ID            SetId,
+                                                               const ShaderResourceCacheVk& ResourceCache,
+                                                               Uint8*                       pDst,
+                                                               DeviceContextIndex           CtxId,
+                                                               DeviceContextVkImpl*         pCtx) const
+{
+    VERIFY(m_UsesDescriptorBuffer, "This signature does not use descriptor buffers");
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+    VERIFY_EXPR(HasDescriptorSet(SetId));
+
+    const bool IsStaticSet = SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE;
+
+    const auto& DescrSet = ResourceCache.GetDescriptorSet(IsStaticSet ?
+                                                              GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>() :
+                                                              GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>());
+    const auto& Bindings = m_DescriptorBufferBindings[SetId];
+
+    // Resources are sorted by variable type, so the static/mutable set contains a contiguous range of resources
+    const auto ResIdxRange = IsStaticSet ?
+        std::make_pair(GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC).first, GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE).second) :
+        GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+    if (IsStaticSet)
+    {
+        // Copy persistent descriptors; only buffers with dynamic offsets need to be rewritten
+        VERIFY_EXPR(DescrSet.GetDescriptorBufferCPUAddress() != nullptr);
+        memcpy(pDst, DescrSet.GetDescriptorBufferCPUAddress(), m_DescriptorBufferSetSizes[SetId]);
+    }
+    else
+    {
+        WriteImmutableSamplerDescriptors(SetId, pDst);
+    }
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    for (Uint32 ResIdx = ResIdxRange.first; ResIdx < ResIdxRange.second; ++ResIdx)
+    {
+        if (IsOutOfSetResource(ResIdx))
+            continue;
+
+        const auto& Attr      = GetResourceAttribs(ResIdx);
+        const auto  DescrType = Attr.GetDescriptorType();
+        if (IsStaticSet &&
+            DescrType != DescriptorType::UniformBufferDynamic &&
+            DescrType != DescriptorType::StorageBufferDynamic &&
+            DescrType != DescriptorType::StorageBufferDynamic_ReadOnly)
+            continue;
+
+        const auto  CacheOffset = Attr.CacheOffset(ResourceCacheContentType::SRB);
+        const auto& Binding     = Bindings[Attr.BindingIndex];
+        VERIFY_EXPR(CacheOffset + Attr.ArraySize <= DescrSet.GetSize() && Attr.ArraySize == Binding.ArraySize);
+        for (Uint32 ArrElem = 0; ArrElem < Attr.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = DescrSet.GetResource(CacheOffset + ArrElem);
+            if (CachedRes.IsNull())
+                continue;
+
+            CachedRes.WriteDescriptorBufferData(LogicalDevice, Binding, pDst + Binding.Offset + ArrElem * Binding.Stride, CtxId, pCtx);
+        }
+    }
+}
+
+void PipelineResourceSignatureVkImpl::PrepareDynamicDescriptorData(const ShaderResourceCacheVk&                             ResourceCache,
+                                                                   std::vector<ShaderResourceCacheVk::DescriptorWriteInfo>& Data) const
+{
+    VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+
+    const auto& SetResources   = ResourceCache.GetDescriptorSet(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>());
+    const auto  DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
+
+    // The buffer only grows; every entry referenced by the descriptor writes is initialized below
+    if (Data.size() < SetResources.GetSize())
+        Data.resize(SetResources.GetSize());
+
+    for (Uint32 ResIdx = DynResIdxRange.first; ResIdx < DynResIdxRange.second; ++ResIdx)
+    {
+        if (IsOutOfSetResource(ResIdx))
+            continue;
+
+        const auto& Attr        = GetResourceAttribs(ResIdx);
+        const auto  CacheOffset = Attr.CacheOffset(ResourceCacheContentType::SRB);
+        const auto  DescrType   = Attr.GetDescriptorType();
+        VERIFY_EXPR(CacheOffset + Attr.ArraySize <= SetResources.GetSize());
+
+        static_assert(static_cast<Uint32>(DescriptorType::Count) == 15, "Please update the switch below to handle the new descriptor type");
+        for (Uint32 ArrElem = 0; ArrElem < Attr.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = SetResources.GetResource(CacheOffset + ArrElem);
+            auto&       DstInfo   = Data[CacheOffset + ArrElem];
+            switch (DescrType)
+            {
+                case DescriptorType::UniformBuffer:
+                case DescriptorType::UniformBufferDynamic:
+                    DstInfo.BufferInfo = CachedRes.GetUniformBufferDescriptorWriteInfo();
+                    break;
+
+                case DescriptorType::StorageBuffer:
+                case DescriptorType::StorageBufferDynamic:
+                case DescriptorType::StorageBuffer_ReadOnly:
+                case DescriptorType::StorageBufferDynamic_ReadOnly:
+                    DstInfo.BufferInfo = CachedRes.GetStorageBufferDescriptorWriteInfo();
+                    break;
+
+                case DescriptorType::UniformTexelBuffer:
+                case DescriptorType::StorageTexelBuffer:
+                case DescriptorType::StorageTexelBuffer_ReadOnly:
+                    DstInfo.BufferView = CachedRes.GetBufferViewWriteInfo();
+                    break;
+
+                case DescriptorType::CombinedImageSampler:
+                case DescriptorType::SeparateImage:
+                case DescriptorType::StorageImage:
+                case DescriptorType::InputAttachment:
+                    DstInfo.ImageInfo = CachedRes.GetImageDescriptorWriteInfo();
+                    break;
+
+                case DescriptorType::Sampler:
+                    // Immutable samplers are permanently bound into the set layout
+                    if (!Attr.IsImmutableSamplerAssigned())
+                        DstInfo.ImageInfo = CachedRes.GetSamplerDescriptorWriteInfo();
+                    break;
+
+                case DescriptorType::AccelerationStructure:
+                    // Templates take acceleration structure handles directly
+                    DstInfo.AccelStruct = *CachedRes.GetAccelerationStructureWriteInfo().pAccelerationStructures;
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected resource type");
+            }
+        }
+    }
+}
+
+Uint32 PipelineResourceSignatureVkImpl::GetDynamicDescriptorWrites(VkDescriptorSet                                   vkSet,
+                                                                   const ShaderResourceCacheVk::DescriptorWriteInfo* pData,
+                                                                   VkWriteDescriptorSet*                             pWrites) const
+{
+    // Data stride does not match the layout of Vulkan info arrays, so every array element is written separately.
+    // This is fine as only signatures with at most MaxPushDescriptorCount dynamic descriptors use this path.
+    const auto DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+    Uint32 NumWrites = 0;
+    for (Uint32 ResIdx = DynResIdxRange.first; ResIdx < DynResIdxRange.second; ++ResIdx)
+    {
+        if (IsOutOfSetResource(ResIdx))
+            continue;
+
+        const auto& Attr      = GetResourceAttribs(ResIdx);
+        const auto  DescrType = Attr.GetDescriptorType();
+        if (DescrType == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue;
+
+        const auto CacheOffset = Attr.CacheOffset(ResourceCacheContentType::SRB);
+        for (Uint32 ArrElem = 0; ArrElem < Attr.ArraySize; ++ArrElem)
+        {
+            VERIFY(NumWrites < MaxPushDescriptorCount, "Too many dynamic descriptors");
+            const auto& Info  = pData[CacheOffset + ArrElem];
+            auto&       Write = pWrites[NumWrites++];
+
+            Write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            Write.pNext            = nullptr;
+            Write.dstSet           = vkSet;
+            Write.dstBinding       = Attr.BindingIndex;
+            Write.dstArrayElement  = ArrElem;
+            Write.descriptorCount  = 1;
+            Write.descriptorType   = DescriptorTypeToVkDescriptorType(DescrType);
+            Write.pImageInfo       = nullptr;
+            Write.pBufferInfo      = nullptr;
+            Write.pTexelBufferView = nullptr;
+
+            switch (DescrType)
+            {
+                case DescriptorType::UniformBuffer:
+                case DescriptorType::StorageBuffer:
+                case DescriptorType::StorageBuffer_ReadOnly:
+                    Write.pBufferInfo = &Info.BufferInfo;
+                    break;
+
+                case DescriptorType::UniformTexelBuffer:
+                case DescriptorType::StorageTexelBuffer:
+                case DescriptorType::StorageTexelBuffer_ReadOnly:
+                    Write.pTexelBufferView = &Info.BufferView;
+                    break;
+
+                case DescriptorType::CombinedImageSampler:
+                case DescriptorType::SeparateImage:
+                case DescriptorType::StorageImage:
+                case DescriptorType::InputAttachment:
+                case DescriptorType::Sampler:
+                    Write.pImageInfo = &Info.ImageInfo;
+                    break;
+
+                default:
+                    UNEXPECTED("Descriptors of this type can't be written by this method");
+            }
+        }
+    }
+
+    return NumWrites;
+}
+
+void PipelineResourceSignatureVkImpl::PushDynamicResources(VulkanUtilities::VulkanCommandBuffer&             CmdBuffer,
+                                                           VkPipelineBindPoint                               BindPoint,
+                                                           VkPipelineLayout                                  vkLayout,
+                                                           Uint32                                            SetIndex,
+                                                           const ShaderResourceCacheVk::DescriptorWriteInfo* pData) const
+{
+    VERIFY(SupportsPushDescriptors(), "This signature does not support push descriptors");
+
+    // Do not zero-initialize the array!
+    std::array<VkWriteDescriptorSet, MaxPushDescriptorCount> Writes;
+
+    const auto NumWrites = GetDynamicDescriptorWrites(VK_NULL_HANDLE, pData, Writes.data());
+    if (NumWrites > 0)
+        CmdBuffer.PushDescriptorSet(BindPoint, vkLayout, SetIndex, NumWrites, Writes.data());
+}
+
+void PipelineResourceSignatureVkImpl::WriteDynamicDescriptorSet(VkDescriptorSet                                   vkDynamicDescriptorSet,
+                                                                const ShaderResourceCacheVk::DescriptorWriteInfo* pData) const
+{
+    VERIFY(SupportsPushDescriptors(), "This signature does not support push descriptors");
+    VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
+
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    if (m_VkDynamicSetUpdateTemplate)
+    {
+        LogicalDevice.UpdateDescriptorSetWithTemplate(vkDynamicDescriptorSet, m_VkDynamicSetUpdateTemplate, pData);
+        return;
+    }
+
+    // Do not zero-initialize the array!
+    std::array<VkWriteDescriptorSet, MaxPushDescriptorCount> Writes;
+
+    const auto NumWrites = GetDynamicDescriptorWrites(vkDynamicDescriptorSet, pData, Writes.data());
+    if (NumWrites > 0)
+        LogicalDevice.UpdateDescriptorSets(NumWrites, Writes.data(), 0, nullptr);
+}
+
+void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourceCacheVk&                             ResourceCache,
+                                                             VkDescriptorSet                                          vkDynamicDescriptorSet,
+                                                             std::vector<ShaderResourceCacheVk::DescriptorWriteInfo>& TemplateData) const
 {
     VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
+    if (m_VkDynamicSetUpdateTemplate)
+    {
+        PrepareDynamicDescriptorData(ResourceCache, TemplateData);
+        GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(vkDynamicDescriptorSet, m_VkDynamicSetUpdateTemplate, TemplateData.data());
+        return;
+    }
+
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
     static constexpr size_t BuffUpdateBatchSize         = 2;
@@ -615,6 +1231,14 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
 
     for (Uint32 ResIdx = DynResIdxRange.first, ArrElem = 0; ResIdx < DynResIdxRange.second;)
     {
+        if (IsOutOfSetResource(ResIdx))
+        {
+            // Bindless heap resources live in the global bindless set, inline constants are pushed
+            VERIFY_EXPR(ArrElem == 0);
+            ++ResIdx;
+            continue;
+        }
+
         const auto& Attr        = GetResourceAttribs(ResIdx);
         const auto  CacheOffset = Attr.CacheOffset(CacheType);
         const auto  ArraySize   = Attr.ArraySize;
@@ -784,6 +1408,9 @@ bool PipelineResourceSignatureVkImpl::DvpValidateCommittedResource(const SPIRVSh
     if (ResDesc.ResourceType == SHADER_RESOURCE_TYPE_SAMPLER && ResAttribs.IsImmutableSamplerAssigned())
         return true; // Skip immutable separate samplers
 
+    if ((ResDesc.Flags & (PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP | PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS)) != 0)
+        return true; // Bindless heap resources and inline constants are not tracked by the resource cache
+
     const auto& DescrSetResources = ResourceCache.GetDescriptorSet(ResAttribs.DescrSet);
     const auto  CacheType         = ResourceCache.GetContentType();
     const auto  CacheOffset       = ResAttribs.CacheOffset(CacheType);
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineStateCacheVkImpl.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "DataBlobImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Checks that the cache data was produced by the same device and driver.
+// See VkPipelineCacheHeaderVersionOne in the Vulkan specification.
+bool IsCompatibleCacheData(const void* pData, size_t DataSize, const VkPhysicalDeviceProperties& DeviceProps)
+{
+    struct CacheHeader
+    {
+        uint32_t HeaderSize;
+        uint32_t HeaderVersion;
+        uint32_t VendorID;
+        uint32_t DeviceID;
+        uint8_t  UUID[VK_UUID_SIZE];
+    };
+    static_assert(sizeof(CacheHeader) == 16 + VK_UUID_SIZE, "Unexpected pipeline cache header size");
+
+    if (DataSize < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+
+    // clang-format off
+    return Header.HeaderSize    >= sizeof(CacheHeader)                 &&
+           Header.HeaderVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           Header.VendorID      == DeviceProps.vendorID                &&
+           Header.DeviceID      == DeviceProps.deviceID                &&
+           memcmp(Header.UUID, DeviceProps.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    // clang-format on
+}
+
+} // namespace
+
+PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceVkImpl*                 pRenderDeviceVk,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo,
+                                                   bool                                IsDeviceInternal) :
+    // clang-format off
+    TDeviceObjectBase
+    {
+        pRefCounters,
+        pRenderDeviceVk,
+        CreateInfo.Desc,
+        IsDeviceInternal
+    }
+// clang-format on
+{
+    VkPipelineCacheCreateInfo PipelineCacheCI{};
+    PipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCI.flags = 0;
+
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0)
+    {
+        const auto& DeviceProps = pRenderDeviceVk->GetPhysicalDevice().GetProperties();
+        if (IsCompatibleCacheData(CreateInfo.pCacheData, CreateInfo.CacheDataSize, DeviceProps))
+        {
+            PipelineCacheCI.initialDataSize = CreateInfo.CacheDataSize;
+            PipelineCacheCI.pInitialData    = CreateInfo.pCacheData;
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Initial data of pipeline state cache '", m_Desc.Name,
+                                "' is not compatible with the device and will be ignored.");
+        }
+    }
+
+    const auto& LogicalDevice = pRenderDeviceVk->GetLogicalDevice();
+    m_VkPipelineCache         = LogicalDevice.CreatePipelineCache(PipelineCacheCI, m_Desc.Name);
+}
+
+PipelineStateCacheVkImpl::~PipelineStateCacheVkImpl()
+{
+    // Pipeline cache is only accessed by vkCreate*Pipelines, so it can be destroyed immediately.
+    m_VkPipelineCache.Release();
+}
+
+void PipelineStateCacheVkImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "Null pointer provided");
+    if (ppBlob == nullptr)
+        return;
+    DEV_CHECK_ERR(*ppBlob == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    *ppBlob = nullptr;
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    size_t DataSize = 0;
+    auto   err      = LogicalDevice.GetPipelineCacheData(m_VkPipelineCache, &DataSize, nullptr);
+    if (err != VK_SUCCESS)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the data size of pipeline state cache '", m_Desc.Name, "'");
+        return;
+    }
+
+    RefCntAutoPtr<DataBlobImpl> pDataBlob{MakeNewRCObj<DataBlobImpl>{}(DataSize)};
+    // The size may be reduced if the cache has changed between the two calls
+    err = LogicalDevice.GetPipelineCacheData(m_VkPipelineCache, &DataSize, pDataBlob->GetDataPtr());
+    if (err != VK_SUCCESS && err != VK_INCOMPLETE)
+    {
+        LOG_ERROR_MESSAGE("Failed to get the data of pipeline state cache '", m_Desc.Name, "'");
+        return;
+    }
+    pDataBlob->Resize(DataSize);
+
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppBlob));
+}
+
+} // namespace Diligent
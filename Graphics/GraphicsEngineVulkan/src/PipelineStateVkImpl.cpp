@@ -30,6 +30,7 @@
 #include "PipelineStateVkImpl.hpp"
 
 #include <array>
+#include <algorithm>
 #include <unordered_map>
 
 #include "RenderDeviceVkImpl.hpp"
@@ -85,11 +86,175 @@ bool StripReflection(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
 #endif
 }
 
+struct SPIRVSpecializationConstant
+{
+    const char* Name   = nullptr;
+    uint32_t    SpecId = 0;
+    uint32_t    Size   = 0;
+};
+
+// Finds all specialization constants in the SPIR-V byte code that have
+// both a name and a SpecId decoration.
+std::vector<SPIRVSpecializationConstant> FindSPIRVSpecializationConstants(const std::vector<uint32_t>& SPIRV)
+{
+    std::vector<SPIRVSpecializationConstant> SpecConstants;
+
+    constexpr uint32_t SPIRVMagicNumber = 0x07230203;
+    constexpr size_t   SPIRVHeaderSize  = 5;
+    if (SPIRV.size() < SPIRVHeaderSize || SPIRV[0] != SPIRVMagicNumber)
+        return SpecConstants;
+
+    // clang-format off
+    constexpr uint32_t OpName              = 5;
+    constexpr uint32_t OpTypeBool          = 20;
+    constexpr uint32_t OpTypeInt           = 21;
+    constexpr uint32_t OpTypeFloat         = 22;
+    constexpr uint32_t OpSpecConstantTrue  = 48;
+    constexpr uint32_t OpSpecConstantFalse = 49;
+    constexpr uint32_t OpSpecConstant      = 50;
+    constexpr uint32_t OpDecorate          = 71;
+    constexpr uint32_t DecorationSpecId    = 1;
+    // clang-format on
+
+    std::unordered_map<uint32_t, const char*> Names;
+    std::unordered_map<uint32_t, uint32_t>    SpecIds;
+    std::unordered_map<uint32_t, uint32_t>    TypeSizes;
+    // Specialization constant id -> type id
+    std::vector<std::pair<uint32_t, uint32_t>> Constants;
+
+    for (size_t i = SPIRVHeaderSize; i < SPIRV.size();)
+    {
+        const uint32_t OpCode    = SPIRV[i] & 0xFFFFu;
+        const uint32_t WordCount = SPIRV[i] >> 16u;
+        if (WordCount == 0 || i + WordCount > SPIRV.size())
+            break;
+
+        const uint32_t* Operands = &SPIRV[i + 1];
+        switch (OpCode)
+        {
+            case OpName:
+                if (WordCount > 2)
+                    Names.emplace(Operands[0], reinterpret_cast<const char*>(&Operands[1]));
+                break;
+
+            case OpDecorate:
+                if (WordCount > 3 && Operands[1] == DecorationSpecId)
+                    SpecIds.emplace(Operands[0], Operands[2]);
+                break;
+
+            case OpTypeBool:
+                // Boolean specialization constants are set through VkBool32
+                TypeSizes.emplace(Operands[0], uint32_t{sizeof(VkBool32)});
+                break;
+
+            case OpTypeInt:
+            case OpTypeFloat:
+                if (WordCount > 2)
+                    TypeSizes.emplace(Operands[0], Operands[1] / 8);
+                break;
+
+            case OpSpecConstantTrue:
+            case OpSpecConstantFalse:
+            case OpSpecConstant:
+                if (WordCount > 2)
+                    Constants.emplace_back(Operands[1], Operands[0]);
+                break;
+
+            default:
+                break;
+        }
+
+        i += WordCount;
+    }
+
+    for (const auto& Const : Constants)
+    {
+        auto name_it = Names.find(Const.first);
+        auto id_it   = SpecIds.find(Const.first);
+        auto size_it = TypeSizes.find(Const.second);
+        if (name_it == Names.end() || id_it == SpecIds.end() || size_it == TypeSizes.end())
+            continue;
+
+        SPIRVSpecializationConstant SpecConst;
+        SpecConst.Name   = name_it->second;
+        SpecConst.SpecId = id_it->second;
+        SpecConst.Size   = size_it->second;
+        SpecConstants.push_back(SpecConst);
+    }
+
+    return SpecConstants;
+}
+
+void InitShaderSpecializationInfo(const PipelineStateCreateInfo&                 CreateInfo,
+                                  SHADER_TYPE                                    ShaderType,
+                                  const ShaderVkImpl&                            Shader,
+                                  const std::vector<uint32_t>&                   SPIRV,
+                                  PipelineStateVkImpl::ShaderSpecializationInfo& Specialization,
+                                  std::vector<bool>&                             ConstantFound) noexcept(false)
+{
+    const auto SPIRVConstants = FindSPIRVSpecializationConstants(SPIRV);
+    if (SPIRVConstants.empty())
+        return;
+
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        const auto& Const = CreateInfo.pSpecializationConstants[i];
+        if ((Const.ShaderStages & ShaderType) == 0)
+            continue;
+
+        for (const auto& SPIRVConst : SPIRVConstants)
+        {
+            if (strcmp(SPIRVConst.Name, Const.Name) != 0)
+                continue;
+
+            if (Const.Size != SPIRVConst.Size)
+            {
+                LOG_ERROR_AND_THROW("Description of PSO '", (CreateInfo.PSODesc.Name != nullptr ? CreateInfo.PSODesc.Name : ""),
+                                    "' is invalid: the size of specialization constant '", Const.Name, "' (", Const.Size,
+                                    ") does not match the size of the constant in shader '", Shader.GetDesc().Name, "' (", SPIRVConst.Size, ").");
+            }
+
+            VkSpecializationMapEntry Entry{};
+            Entry.constantID = SPIRVConst.SpecId;
+            Entry.offset     = static_cast<uint32_t>(Specialization.Data.size());
+            Entry.size       = Const.Size;
+            Specialization.MapEntries.push_back(Entry);
+
+            const auto* pData = static_cast<const Uint8*>(Const.pData);
+            Specialization.Data.insert(Specialization.Data.end(), pData, pData + Const.Size);
+
+            ConstantFound[i] = true;
+            break;
+        }
+    }
+
+    if (!Specialization.MapEntries.empty())
+    {
+        Specialization.Info.mapEntryCount = static_cast<uint32_t>(Specialization.MapEntries.size());
+        Specialization.Info.pMapEntries   = Specialization.MapEntries.data();
+        Specialization.Info.dataSize      = Specialization.Data.size();
+        Specialization.Info.pData         = Specialization.Data.data();
+    }
+}
+
 void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
+                              const PipelineStateCreateInfo&                     CreateInfo,
                               PipelineStateVkImpl::TShaderStages&                ShaderStages,
                               std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
-                              std::vector<VkPipelineShaderStageCreateInfo>&      Stages)
+                              std::vector<VkPipelineShaderStageCreateInfo>&      Stages,
+                              PipelineStateVkImpl::TShaderSpecializations&       Specializations) noexcept(false)
 {
+    std::vector<bool> ConstantFound(CreateInfo.NumSpecializationConstants);
+    if (CreateInfo.NumSpecializationConstants != 0)
+    {
+        size_t NumShaders = 0;
+        for (const auto& Stage : ShaderStages)
+            NumShaders += Stage.Shaders.size();
+        // Stage create infos keep pointers to the specialization info, so the
+        // array must not be reallocated.
+        Specializations.resize(NumShaders);
+    }
+
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const auto& Shaders    = ShaderStages[s].Shaders;
@@ -114,6 +279,15 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
             auto* pShader = Shaders[i];
             auto& SPIRV   = SPIRVs[i];
 
+            StageCI.pSpecializationInfo = nullptr;
+            if (CreateInfo.NumSpecializationConstants != 0)
+            {
+                auto& Specialization = Specializations[Stages.size()];
+                InitShaderSpecializationInfo(CreateInfo, ShaderType, *pShader, SPIRV, Specialization, ConstantFound);
+                if (!Specialization.MapEntries.empty())
+                    StageCI.pSpecializationInfo = &Specialization.Info;
+            }
+
             // We have to strip reflection instructions to fix the follownig validation error:
             //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
             // Optimizer also performs validation and may catch problems with the byte code.
@@ -125,15 +299,111 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
 
             ShaderModules.push_back(LogicalDevice.CreateShaderModule(ShaderModuleCI, pShader->GetDesc().Name));
 
-            StageCI.module              = ShaderModules.back();
-            StageCI.pName               = pShader->GetEntryPoint();
-            StageCI.pSpecializationInfo = nullptr;
+            StageCI.module = ShaderModules.back();
+            StageCI.pName  = pShader->GetEntryPoint();
 
             Stages.push_back(StageCI);
         }
     }
 
     VERIFY_EXPR(ShaderModules.size() == Stages.size());
+
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        if (!ConstantFound[i])
+        {
+            const auto& Const = CreateInfo.pSpecializationConstants[i];
+            LOG_WARNING_MESSAGE("Specialization constant '", Const.Name, "' is not found in any of the designated shader stages (",
+                                GetShaderStagesString(Const.ShaderStages), ") of PSO '", (CreateInfo.PSODesc.Name != nullptr ? CreateInfo.PSODesc.Name : ""), "'.");
+        }
+    }
+}
+
+
+bool IsStatisticsCaptureEnabled(const RenderDeviceVkImpl* pDeviceVk, PSO_CREATE_FLAGS Flags)
+{
+    return (Flags & PSO_CREATE_FLAG_CAPTURE_STATISTICS) != 0 &&
+        pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().PipelineExecutableProperties.pipelineExecutableInfo != VK_FALSE;
+}
+
+// Returns the member of Stats that corresponds to the statistic reported by the driver, or null.
+// Every driver uses its own names, e.g. "VGPRs" (AMD), "Register Count" (NVIDIA) or "Instruction Count" (Intel).
+Uint32* GetShaderStatisticMember(ShaderStatistics& Stats, const char* Name)
+{
+    const auto LowerName = StrToLower(Name);
+    const auto Contains  = [&LowerName](const char* Str) { return LowerName.find(Str) != std::string::npos; };
+
+    // Spill counts, e.g. "Spilled VGPRs" or "Spill Count", are not the sizes of the spilled data
+    if (Contains("spill"))
+        return nullptr;
+    if (Contains("sgpr"))
+        return &Stats.ScalarRegisterCount;
+    if (Contains("vgpr") || Contains("register"))
+        return &Stats.RegisterCount;
+    if (Contains("scratch") || Contains("local memory"))
+        return &Stats.SpillSize;
+    if (Contains("instruction"))
+        return &Stats.InstructionCount;
+    if (LowerName.compare(0, 3, "lds") == 0 || Contains("shared memory") || Contains("workgroup memory"))
+        return &Stats.SharedMemorySize;
+    if (Contains("per simd") || Contains("occupancy"))
+        return &Stats.Occupancy;
+    return nullptr;
+}
+
+Uint32 GetShaderStatisticValue(const VkPipelineExecutableStatisticKHR& Stat)
+{
+    // SHADER_STATISTIC_UNAVAILABLE is reserved
+    constexpr Uint64 MaxValue = Uint64{SHADER_STATISTIC_UNAVAILABLE} - 1;
+    switch (Stat.format)
+    {
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_BOOL32_KHR: return Stat.value.b32 != VK_FALSE ? 1 : 0;
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_INT64_KHR: return static_cast<Uint32>(std::min(static_cast<Uint64>(std::max(Stat.value.i64, Int64{0})), MaxValue));
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_UINT64_KHR: return static_cast<Uint32>(std::min(Stat.value.u64, MaxValue));
+        case VK_PIPELINE_EXECUTABLE_STATISTIC_FORMAT_FLOAT64_KHR: return static_cast<Uint32>(std::min(std::max(Stat.value.f64 + 0.5, 0.0), static_cast<double>(MaxValue)));
+        default: return SHADER_STATISTIC_UNAVAILABLE;
+    }
+}
+
+// Reads the statistics of every executable of a pipeline created with VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR.
+std::vector<ShaderStatistics> GetPipelineStatistics(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice, VkPipeline vkPipeline, const char* PSOName)
+{
+    std::vector<ShaderStatistics> Statistics;
+
+    uint32_t NumExecutables = 0;
+    if (LogicalDevice.GetPipelineExecutableProperties(vkPipeline, &NumExecutables, nullptr) != VK_SUCCESS)
+    {
+        LOG_WARNING_MESSAGE("Failed to get the executable properties of pipeline '", PSOName, "'");
+        return Statistics;
+    }
+    std::vector<VkPipelineExecutablePropertiesKHR> Executables(NumExecutables, VkPipelineExecutablePropertiesKHR{VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_PROPERTIES_KHR});
+    if (LogicalDevice.GetPipelineExecutableProperties(vkPipeline, &NumExecutables, Executables.data()) != VK_SUCCESS)
+    {
+        LOG_WARNING_MESSAGE("Failed to get the executable properties of pipeline '", PSOName, "'");
+        return Statistics;
+    }
+
+    Statistics.resize(NumExecutables);
+    for (uint32_t e = 0; e < NumExecutables; ++e)
+    {
+        auto& Stats      = Statistics[e];
+        Stats.ShaderType = VkShaderStageFlagsToShaderTypes(Executables[e].stages);
+
+        uint32_t NumStats = 0;
+        if (LogicalDevice.GetPipelineExecutableStatistics(vkPipeline, e, &NumStats, nullptr) != VK_SUCCESS)
+            continue;
+        std::vector<VkPipelineExecutableStatisticKHR> VkStats(NumStats, VkPipelineExecutableStatisticKHR{VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_STATISTIC_KHR});
+        if (LogicalDevice.GetPipelineExecutableStatistics(vkPipeline, e, &NumStats, VkStats.data()) != VK_SUCCESS)
+            continue;
+
+        for (uint32_t i = 0; i < NumStats; ++i)
+        {
+            if (auto* pMember = GetShaderStatisticMember(Stats, VkStats[i].name))
+                *pMember = GetShaderStatisticValue(VkStats[i]);
+        }
+    }
+
+    return Statistics;
 }
 
 
@@ -141,6 +411,8 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
                            const PipelineLayoutVk&                       Layout,
                            const PipelineStateDesc&                      PSODesc,
+                           VkPipelineCache                               vkPSOCache,
+                           bool                                          CaptureStatistics,
                            VulkanUtilities::PipelineWrapper&             Pipeline)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
@@ -151,44 +423,79 @@ void CreateComputePipeline(RenderDeviceVkImpl*                           pDevice
 #ifdef DILIGENT_DEBUG
     PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    // Set layouts in descriptor buffer mode can only be used by pipelines created with this flag
+    if (pDeviceVk->GetDescriptorBuffer() != nullptr)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    if (CaptureStatistics)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
     PipelineCI.stage  = Stages[0];
     PipelineCI.layout = Layout.GetVkPipelineLayout();
 
-    Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = LogicalDevice.CreateComputePipeline(PipelineCI, vkPSOCache, PSODesc.Name);
 }
 
 
-void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDeviceVk,
-                            std::vector<VkPipelineShaderStageCreateInfo>& Stages,
-                            const PipelineLayoutVk&                       Layout,
-                            const PipelineStateDesc&                      PSODesc,
-                            const GraphicsPipelineDesc&                   GraphicsPipeline,
-                            VulkanUtilities::PipelineWrapper&             Pipeline,
-                            RefCntAutoPtr<IRenderPass>&                   pRenderPass)
+// Returns true if the pipeline has been linked from graphics pipeline libraries, in which case
+// Libraries contains the libraries to link the optimized pipeline from.
+bool CreateGraphicsPipeline(RenderDeviceVkImpl*                              pDeviceVk,
+                            std::vector<VkPipelineShaderStageCreateInfo>&    Stages,
+                            const std::vector<const std::vector<uint32_t>*>& StageSPIRVs,
+                            const PipelineLayoutVk&                          Layout,
+                            const PipelineStateDesc&                         PSODesc,
+                            const GraphicsPipelineDesc&                      GraphicsPipeline,
+                            VkPipelineCache                                  vkPSOCache,
+                            bool                                             CaptureStatistics,
+                            VulkanUtilities::PipelineWrapper&                Pipeline,
+                            RefCntAutoPtr<IRenderPass>&                      pRenderPass,
+                            PipelineLibraryCacheVk::LibrarySet&              Libraries)
 {
     const auto& LogicalDevice  = pDeviceVk->GetLogicalDevice();
     const auto& PhysicalDevice = pDeviceVk->GetPhysicalDevice();
-    auto&       RPCache        = pDeviceVk->GetImplicitRenderPassCache();
 
-    if (pRenderPass == nullptr)
+    // With dynamic rendering, pipelines that use implicit render passes are created
+    // with the attachment formats only and do not need a render pass object.
+    const bool UseDynamicRendering = pRenderPass == nullptr && pDeviceVk->UseDynamicRendering();
+
+    VkPipelineRenderingCreateInfoKHR         RenderingCI{};
+    std::array<VkFormat, MAX_RENDER_TARGETS> ColorAttachmentFormats{};
+    if (UseDynamicRendering)
+    {
+        RenderingCI.sType                = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        RenderingCI.colorAttachmentCount = GraphicsPipeline.NumRenderTargets;
+        for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+            ColorAttachmentFormats[rt] = TexFormatToVkFormat(GraphicsPipeline.RTVFormats[rt]);
+        RenderingCI.pColorAttachmentFormats = ColorAttachmentFormats.data();
+        if (GraphicsPipeline.DSVFormat != TEX_FORMAT_UNKNOWN)
+        {
+            RenderingCI.depthAttachmentFormat = TexFormatToVkFormat(GraphicsPipeline.DSVFormat);
+            if (GetTextureFormatAttribs(GraphicsPipeline.DSVFormat).ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+                RenderingCI.stencilAttachmentFormat = RenderingCI.depthAttachmentFormat;
+        }
+    }
+    else if (pRenderPass == nullptr)
     {
         RenderPassCache::RenderPassCacheKey Key{
             GraphicsPipeline.NumRenderTargets,
             GraphicsPipeline.SmplDesc.Count,
             GraphicsPipeline.RTVFormats,
             GraphicsPipeline.DSVFormat};
-        pRenderPass = RPCache.GetRenderPass(Key);
+        pRenderPass = pDeviceVk->GetImplicitRenderPassCache().GetRenderPass(Key);
     }
 
     VkGraphicsPipelineCreateInfo PipelineCI{};
     PipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    PipelineCI.pNext = nullptr;
+    PipelineCI.pNext = UseDynamicRendering ? &RenderingCI : nullptr;
 #ifdef DILIGENT_DEBUG
     PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    // Set layouts in descriptor buffer mode can only be used by pipelines created with this flag
+    if (pDeviceVk->GetDescriptorBuffer() != nullptr)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    if (CaptureStatistics)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
 
     PipelineCI.stageCount = static_cast<Uint32>(Stages.size());
     PipelineCI.pStages    = Stages.data();
@@ -294,8 +601,9 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         DepthStencilStateDesc_To_VkDepthStencilStateCI(GraphicsPipeline.DepthStencilDesc);
     PipelineCI.pDepthStencilState = &DepthStencilStateCI;
 
-    const auto& RPDesc           = pRenderPass->GetDesc();
-    const auto  NumRTAttachments = RPDesc.pSubpasses[GraphicsPipeline.SubpassIndex].RenderTargetAttachmentCount;
+    const auto NumRTAttachments = UseDynamicRendering ?
+        GraphicsPipeline.NumRenderTargets :
+        pRenderPass->GetDesc().pSubpasses[GraphicsPipeline.SubpassIndex].RenderTargetAttachmentCount;
     VERIFY_EXPR(GraphicsPipeline.pRenderPass != nullptr || GraphicsPipeline.NumRenderTargets == NumRTAttachments);
     std::vector<VkPipelineColorBlendAttachmentState> ColorBlendAttachmentStates(NumRTAttachments);
 
@@ -334,17 +642,54 @@ void CreateGraphicsPipeline(RenderDeviceVkImpl*                           pDevic
         // VkPipelineViewportStateCreateInfo.
         DynamicStates.push_back(VK_DYNAMIC_STATE_SCISSOR);
     }
+
+    // States set through IDeviceContext::SetDynamicStates (VK_EXT_extended_dynamic_state).
+    // The values in the create info structures are ignored; the context sets them from
+    // the pipeline description when the pipeline is bound.
+    if (GraphicsPipeline.DynamicStates & DYNAMIC_STATE_FLAG_CULL_MODE)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+    }
+    if (GraphicsPipeline.DynamicStates & DYNAMIC_STATE_FLAG_DEPTH)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+    }
+    if (GraphicsPipeline.DynamicStates & DYNAMIC_STATE_FLAG_STENCIL)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+        DynamicStates.push_back(VK_DYNAMIC_STATE_STENCIL_OP_EXT);
+    }
+    if (GraphicsPipeline.DynamicStates & DYNAMIC_STATE_FLAG_PRIMITIVE_TOPOLOGY)
+    {
+        DynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+    }
     DynamicStateCI.dynamicStateCount = static_cast<uint32_t>(DynamicStates.size());
     DynamicStateCI.pDynamicStates    = DynamicStates.data();
     PipelineCI.pDynamicState         = &DynamicStateCI;
 
 
-    PipelineCI.renderPass         = pRenderPass.RawPtr<IRenderPassVk>()->GetVkRenderPass();
+    PipelineCI.renderPass         = UseDynamicRendering ? VK_NULL_HANDLE : pRenderPass.RawPtr<IRenderPassVk>()->GetVkRenderPass();
     PipelineCI.subpass            = GraphicsPipeline.SubpassIndex;
     PipelineCI.basePipelineHandle = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex  = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    // Explicit render pass handles may be reused after the render pass objects are destroyed, so only
+    // pipelines with implicit render passes, which live as long as the device, are linked from libraries.
+    // Mesh pipelines have no vertex input interface and are always compiled as a whole.
+    // The statistics of the linked pipelines are not reliable, so these pipelines are compiled as a whole too.
+    auto* pLibraryCache = pDeviceVk->GetPipelineLibraryCache();
+    if (pLibraryCache != nullptr && GraphicsPipeline.pRenderPass == nullptr && PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS && !CaptureStatistics)
+    {
+        Libraries = pLibraryCache->GetLibraries(PipelineCI, StageSPIRVs, Layout.GetHash(), vkPSOCache, PSODesc.Name);
+        // Linking without link time optimization only takes a fraction of the time needed to compile the pipeline
+        Pipeline = pLibraryCache->LinkPipeline(Libraries, PipelineCI.layout, /*Optimize = */ false, vkPSOCache, PSODesc.Name);
+        return true;
+    }
+
+    Pipeline = LogicalDevice.CreateGraphicsPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
+    return false;
 }
 
 
@@ -354,6 +699,8 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
                               const PipelineLayoutVk&                                  Layout,
                               const PipelineStateDesc&                                 PSODesc,
                               const RayTracingPipelineDesc&                            RayTracingPipeline,
+                              VkPipelineCache                                          vkPSOCache,
+                              bool                                                     CaptureStatistics,
                               VulkanUtilities::PipelineWrapper&                        Pipeline)
 {
     const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
@@ -364,6 +711,11 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
 #ifdef DILIGENT_DEBUG
     PipelineCI.flags = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT;
 #endif
+    // Set layouts in descriptor buffer mode can only be used by pipelines created with this flag
+    if (pDeviceVk->GetDescriptorBuffer() != nullptr)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    if (CaptureStatistics)
+        PipelineCI.flags |= VK_PIPELINE_CREATE_CAPTURE_STATISTICS_BIT_KHR;
 
     PipelineCI.stageCount                   = static_cast<Uint32>(vkStages.size());
     PipelineCI.pStages                      = vkStages.data();
@@ -377,7 +729,7 @@ void CreateRayTracingPipeline(RenderDeviceVkImpl*
     PipelineCI.basePipelineHandle           = VK_NULL_HANDLE; // a pipeline to derive from
     PipelineCI.basePipelineIndex            = -1;             // an index into the pCreateInfos parameter to use as a pipeline to derive from
 
-    Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, VK_NULL_HANDLE, PSODesc.Name);
+    Pipeline = LogicalDevice.CreateRayTracingPipeline(PipelineCI, vkPSOCache, PSODesc.Name);
 }
 
 
@@ -742,7 +1094,8 @@ void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
     }
 
 #ifdef DILIGENT_DEVELOPMENT
-    DvpValidateResourceLimits();
+    if (GetDevice()->IsValidationEnabled(VALIDATION_CATEGORY_OBJECT_CREATION))
+        DvpValidateResourceLimits();
 #endif
 
     m_PipelineLayout.Create(GetDevice(), m_Signatures, m_SignatureCount);
@@ -787,12 +1140,32 @@ void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
                     if (ResAttribution.ResourceIndex != ResourceAttribution::InvalidResourceIndex)
                     {
                         const auto& ResDesc = ResAttribution.pSignature->GetResourceDesc(ResAttribution.ResourceIndex);
+                        if (ResAttribution.pSignature->IsInlineConstantsResource(ResAttribution.ResourceIndex))
+                        {
+                            // Push constant blocks are not reflected as shader resources, so the shader
+                            // must have declared the block as a regular uniform buffer.
+                            LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' declares resource '", SPIRVAttribs.Name,
+                                                "' as a uniform buffer, but pipeline resource signature '", SignDesc.Name,
+                                                "' defines it as inline constants. Inline constants must be declared as a push constant block.");
+                        }
                         ValidatePipelineResourceCompatibility(ResDesc, ResType, Flags, SPIRVAttribs.ArraySize,
                                                               pShader->GetDesc().Name, SignDesc.Name);
 
                         const auto& ResAttribs{ResAttribution.pSignature->GetResourceAttribs(ResAttribution.ResourceIndex)};
                         ResourceBinding = ResAttribs.BindingIndex;
                         DescriptorSet   = ResAttribs.DescrSet;
+
+                        if (ResAttribution.pSignature->IsBindlessHeapResource(ResAttribution.ResourceIndex))
+                        {
+                            // Bindless heap resources are remapped to the global bindless set
+                            VERIFY_EXPR(m_PipelineLayout.GetBindlessDescrSetIndex() != PipelineLayoutVk::InvalidDescrSetIndex);
+                            SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
+                            SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = m_PipelineLayout.GetBindlessDescrSetIndex();
+#ifdef DILIGENT_DEVELOPMENT
+                            m_ResourceAttibutions.emplace_back(ResAttribution);
+#endif
+                            return;
+                        }
                     }
                     else if (ResAttribution.ImmutableSamplerIndex != ResourceAttribution::InvalidResourceIndex)
                     {
@@ -828,7 +1201,8 @@ template <typename PSOCreateInfoType>
 PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
     const PSOCreateInfoType&                           CreateInfo,
     std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules)
+    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
+    TShaderSpecializations&                            Specializations)
 {
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages);
@@ -846,22 +1220,157 @@ PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
     InitPipelineLayout(ShaderStages);
 
     // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+    InitPipelineShaderStages(LogicalDevice, CreateInfo, ShaderStages, ShaderModules, vkShaderStages, Specializations);
 
     return ShaderStages;
 }
 
+void PipelineStateVkImpl::InitializeGraphicsPipeline(const GraphicsPipelineStateCreateInfo& CreateInfo)
+{
+    auto* pDeviceVk = GetDevice();
+
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+    TShaderSpecializations                            Specializations;
+
+    const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
+
+    // Shader modules are created by every pipeline, so the byte code identifies the shaders in the library cache
+    std::vector<const std::vector<uint32_t>*> StageSPIRVs;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto& SPIRV : Stage.SPIRVs)
+            StageSPIRVs.push_back(&SPIRV);
+    }
+    VERIFY_EXPR(StageSPIRVs.size() == vkShaderStages.size());
+
+    const bool CaptureStatistics = IsStatisticsCaptureEnabled(pDeviceVk, CreateInfo.Flags);
+
+    PipelineLibraryCacheVk::LibrarySet Libraries;
+    if (CreateGraphicsPipeline(pDeviceVk, vkShaderStages, StageSPIRVs, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(),
+                               pDeviceVk->GetVkPipelineCache(CreateInfo.pPSOCache), CaptureStatistics, m_Pipeline, GetRenderPassPtr(), Libraries))
+    {
+        EnqueueOptimizedLink(Libraries, CreateInfo.pPSOCache);
+    }
+
+    if (CaptureStatistics)
+        m_Statistics = GetPipelineStatistics(pDeviceVk->GetLogicalDevice(), m_Pipeline, m_Desc.Name);
+}
+
+void PipelineStateVkImpl::EnqueueOptimizedLink(const PipelineLibraryCacheVk::LibrarySet& Libraries, IPipelineStateCache* pPSOCache)
+{
+    VERIFY(!m_pOptimizedLink, "Optimized link has already been enqueued");
+    m_pOptimizedLink            = std::make_shared<OptimizedPipelineLink>();
+    m_pOptimizedLink->pPSOCache = pPSOCache;
+
+    // The task accesses the device, the pipeline layout and the name only while the link is running.
+    // FinishOptimizedLink() waits for the running link before the pipeline state object is destroyed.
+    auto* const       pDeviceVk = GetDevice();
+    const auto        vkLayout  = m_PipelineLayout.GetVkPipelineLayout();
+    const char* const Name      = m_Desc.Name;
+    EnqueueTask(&pDeviceVk->GetAsyncTaskPool(), [pLink = m_pOptimizedLink, Libraries, pDeviceVk, vkLayout, Name]() {
+        using STATUS = OptimizedPipelineLink::STATUS;
+        {
+            std::lock_guard<std::mutex> Lock{pLink->Mtx};
+            if (pLink->Status == STATUS::Cancelled)
+                return;
+            VERIFY_EXPR(pLink->Status == STATUS::Pending);
+            pLink->Status = STATUS::Running;
+        }
+
+        VulkanUtilities::PipelineWrapper Pipeline;
+        try
+        {
+            Pipeline = pDeviceVk->GetPipelineLibraryCache()->LinkPipeline(Libraries, vkLayout, /*Optimize = */ true,
+                                                                         pDeviceVk->GetVkPipelineCache(pLink->pPSOCache), Name);
+        }
+        catch (...)
+        {
+            // The fast-linked pipeline remains in use
+            LOG_ERROR_MESSAGE("Failed to link optimized pipeline '", Name, "' from graphics pipeline libraries.");
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{pLink->Mtx};
+            if (Pipeline != VK_NULL_HANDLE)
+            {
+                pLink->Pipeline = std::move(Pipeline);
+                pLink->Ready.store(true, std::memory_order_release);
+            }
+            pLink->Status = STATUS::Complete;
+        }
+        pLink->CompleteCV.notify_all();
+    });
+}
+
+void PipelineStateVkImpl::FinishOptimizedLink()
+{
+    if (!m_pOptimizedLink)
+        return;
+
+    using STATUS = OptimizedPipelineLink::STATUS;
+
+    auto&                        Link = *m_pOptimizedLink;
+    std::unique_lock<std::mutex> Lock{Link.Mtx};
+    if (Link.Status == STATUS::Pending)
+        Link.Status = STATUS::Cancelled;
+    Link.CompleteCV.wait(Lock, [&Link]() { return Link.Status != STATUS::Running; });
+    Link.pPSOCache.Release();
+}
+
+void PipelineStateVkImpl::InitializeComputePipeline(const ComputePipelineStateCreateInfo& CreateInfo)
+{
+    auto* pDeviceVk = GetDevice();
+
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+    TShaderSpecializations                            Specializations;
+
+    InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
+
+    const bool CaptureStatistics = IsStatisticsCaptureEnabled(pDeviceVk, CreateInfo.Flags);
+
+    CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, pDeviceVk->GetVkPipelineCache(CreateInfo.pPSOCache), CaptureStatistics, m_Pipeline);
+
+    if (CaptureStatistics)
+        m_Statistics = GetPipelineStatistics(pDeviceVk->GetLogicalDevice(), m_Pipeline, m_Desc.Name);
+}
+
+void PipelineStateVkImpl::InitializeRayTracingPipeline(const RayTracingPipelineStateCreateInfo& CreateInfo)
+{
+    auto* pDeviceVk = GetDevice();
+
+    const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+
+    std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
+    std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+    TShaderSpecializations                            Specializations;
+
+    const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules, Specializations);
+
+    const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
+
+    const bool CaptureStatistics = IsStatisticsCaptureEnabled(pDeviceVk, CreateInfo.Flags);
+
+    CreateRayTracingPipeline(pDeviceVk, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), pDeviceVk->GetVkPipelineCache(CreateInfo.pPSOCache), CaptureStatistics, m_Pipeline);
+
+    if (CaptureStatistics)
+        m_Statistics = GetPipelineStatistics(LogicalDevice, m_Pipeline, m_Desc.Name);
+
+    VERIFY(m_pRayTracingPipelineData->NameToGroupIndex.size() == vkShaderGroups.size(),
+           "The size of NameToGroupIndex map does not match the actual number of groups in the pipeline. This is a bug.");
+    // Get shader group handles from the PSO.
+    auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(vkShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
+    (void)err;
+}
+
 PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const GraphicsPipelineStateCreateInfo& CreateInfo) :
     TPipelineStateBase{pRefCounters, pDeviceVk, CreateInfo}
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr());
+        InitializePipeline(CreateInfo, [this](const GraphicsPipelineStateCreateInfo& PSOCreateInfo) { InitializeGraphicsPipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -875,12 +1384,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline);
+        InitializePipeline(CreateInfo, [this](const ComputePipelineStateCreateInfo& PSOCreateInfo) { InitializeComputePipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -894,23 +1398,7 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
-
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        const auto ShaderStages = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
-
-        CreateRayTracingPipeline(pDeviceVk, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline);
-
-        VERIFY(m_pRayTracingPipelineData->NameToGroupIndex.size() == vkShaderGroups.size(),
-               "The size of NameToGroupIndex map does not match the actual number of groups in the pipeline. This is a bug.");
-        // Get shader group handles from the PSO.
-        auto err = LogicalDevice.GetRayTracingShaderGroupHandles(m_Pipeline, 0, static_cast<uint32_t>(vkShaderGroups.size()), m_pRayTracingPipelineData->ShaderDataSize, m_pRayTracingPipelineData->ShaderHandles);
-        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to get shader group handles");
-        (void)err;
+        InitializePipeline(CreateInfo, [this](const RayTracingPipelineStateCreateInfo& PSOCreateInfo) { InitializeRayTracingPipeline(PSOCreateInfo); });
     }
     catch (...)
     {
@@ -924,8 +1412,31 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
     Destruct();
 }
 
+void PipelineStateVkImpl::SwapShaderObjects(PipelineStateVkImpl& Other)
+{
+    // Optimized links use the layouts and the names of their pipeline state objects,
+    // so they must not be running when the pipelines are exchanged.
+    FinishOptimizedLink();
+    Other.FinishOptimizedLink();
+
+    // Pipeline layouts created from compatible signatures are compatible, so the
+    // new pipeline can be used with the layout of this pipeline.
+    std::swap(m_Pipeline, Other.m_Pipeline);
+    std::swap(m_pOptimizedLink, Other.m_pOptimizedLink);
+
+#ifdef DILIGENT_DEVELOPMENT
+    std::swap(m_ShaderResources, Other.m_ShaderResources);
+    std::swap(m_ResourceAttibutions, Other.m_ResourceAttibutions);
+    DvpRemapResourceAttributions(m_ResourceAttibutions);
+    Other.DvpRemapResourceAttributions(Other.m_ResourceAttibutions);
+#endif
+}
+
 void PipelineStateVkImpl::Destruct()
 {
+    FinishOptimizedLink();
+    if (m_pOptimizedLink)
+        m_pDevice->SafeReleaseDeviceObject(std::move(m_pOptimizedLink->Pipeline), m_Desc.ImmediateContextMask);
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.ImmediateContextMask);
     m_PipelineLayout.Release(m_pDevice, m_Desc.ImmediateContextMask);
 
@@ -977,6 +1488,11 @@ void PipelineStateVkImpl::DvpValidateResourceLimits() const
 
         for (Uint32 r = 0; r < pSignature->GetTotalResourceCount(); ++r)
         {
+            // Bindless heap resources are validated against the device limits when the heap is created,
+            // inline constants are validated by the pipeline layout.
+            if (pSignature->IsOutOfSetResource(r))
+                continue;
+
             const auto& ResDesc   = pSignature->GetResourceDesc(r);
             const auto& ResAttr   = pSignature->GetResourceAttribs(r);
             const auto  DescIndex = static_cast<Uint32>(ResAttr.DescrType);
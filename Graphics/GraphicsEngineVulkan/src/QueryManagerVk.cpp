@@ -40,7 +40,11 @@ namespace Diligent
 
 QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl*      pRenderDeviceVk,
                                const Uint32             QueryHeapSizes[],
-                               const SoftwareQueueIndex CmdQueueInd)
+                               const SoftwareQueueIndex CmdQueueInd) :
+    // clang-format off
+    m_pRenderDeviceVk{pRenderDeviceVk},
+    m_CmdQueueInd    {CmdQueueInd    }
+// clang-format on
 {
     const auto& LogicalDevice  = pRenderDeviceVk->GetLogicalDevice();
     const auto& PhysicalDevice = pRenderDeviceVk->GetPhysicalDevice();
@@ -57,10 +61,6 @@ QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl*      pRenderDeviceVk,
     if ((QueueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0)
         return;
 
-    VulkanUtilities::CommandPoolWrapper CmdPool;
-    VkCommandBuffer                     vkCmdBuff;
-    pRenderDeviceVk->AllocateTransientCmdPool(CmdQueueInd, CmdPool, vkCmdBuff, "Transient command pool to reset queries before first use");
-
     for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
     {
         if ((QueryType == QUERY_TYPE_OCCLUSION && !EnabledFeatures.occlusionQueryPrecise) ||
@@ -83,7 +83,7 @@ QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl*      pRenderDeviceVk,
         auto& HeapInfo    = m_Heaps[QueryType];
         HeapInfo.PoolSize = QueryHeapSizes[QueryType];
 
-        VkQueryPoolCreateInfo QueryPoolCI = {};
+        auto& QueryPoolCI = HeapInfo.vkPoolCI;
 
         QueryPoolCI.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
         QueryPoolCI.pNext = nullptr;
@@ -135,20 +135,32 @@ QueryManagerVk::QueryManagerVk(RenderDeviceVkImpl*      pRenderDeviceVk,
         if (QueryType == QUERY_TYPE_DURATION)
             QueryPoolCI.queryCount *= 2;
 
-        HeapInfo.vkQueryPool = LogicalDevice.CreateQueryPool(QueryPoolCI, "QueryManagerVk: query pool");
+        // The pool is created when the first query of this type is allocated, see CreateQueryPool().
+    }
+}
+
+void QueryManagerVk::CreateQueryPool(QueryHeapInfo& HeapInfo)
+{
+    VERIFY_EXPR(HeapInfo.vkQueryPool == VK_NULL_HANDLE && HeapInfo.PoolSize != 0);
 
-        // After query pool creation, each query must be reset before it is used.
-        // Queries must also be reset between uses (17.2).
-        vkCmdResetQueryPool(vkCmdBuff, HeapInfo.vkQueryPool, 0, QueryPoolCI.queryCount);
+    const auto& LogicalDevice = m_pRenderDeviceVk->GetLogicalDevice();
+    HeapInfo.vkQueryPool      = LogicalDevice.CreateQueryPool(HeapInfo.vkPoolCI, "QueryManagerVk: query pool");
 
-        HeapInfo.AvailableQueries.resize(HeapInfo.PoolSize);
-        for (Uint32 i = 0; i < HeapInfo.PoolSize; ++i)
-        {
-            HeapInfo.AvailableQueries[i] = i;
-        }
-    }
+    // After query pool creation, each query must be reset before it is used.
+    // Queries must also be reset between uses (17.2).
+    // The transient command buffer is submitted to the same queue before any command buffer
+    // of the context that may use the queries.
+    VulkanUtilities::CommandPoolWrapper CmdPool;
+    VkCommandBuffer                     vkCmdBuff;
+    m_pRenderDeviceVk->AllocateTransientCmdPool(m_CmdQueueInd, CmdPool, vkCmdBuff, "Transient command pool to reset queries before first use");
+    vkCmdResetQueryPool(vkCmdBuff, HeapInfo.vkQueryPool, 0, HeapInfo.vkPoolCI.queryCount);
+    m_pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(m_CmdQueueInd, vkCmdBuff, std::move(CmdPool));
 
-    pRenderDeviceVk->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, vkCmdBuff, std::move(CmdPool));
+    HeapInfo.AvailableQueries.resize(HeapInfo.PoolSize);
+    for (Uint32 i = 0; i < HeapInfo.PoolSize; ++i)
+    {
+        HeapInfo.AvailableQueries[i] = i;
+    }
 }
 
 QueryManagerVk::~QueryManagerVk()
@@ -158,7 +170,7 @@ QueryManagerVk::~QueryManagerVk()
     for (Uint32 QueryType = QUERY_TYPE_UNDEFINED + 1; QueryType < QUERY_TYPE_NUM_TYPES; ++QueryType)
     {
         auto& HeapInfo = m_Heaps[QueryType];
-        if (HeapInfo.PoolSize == 0)
+        if (HeapInfo.vkQueryPool == VK_NULL_HANDLE)
             continue;
 
         auto OutstandingQueries = HeapInfo.PoolSize - (HeapInfo.AvailableQueries.size() + HeapInfo.StaleQueries.size());
@@ -191,6 +203,8 @@ Uint32 QueryManagerVk::AllocateQuery(QUERY_TYPE Type)
     Uint32 Index            = InvalidIndex;
     auto&  HeapInfo         = m_Heaps[Type];
     auto&  AvailableQueries = HeapInfo.AvailableQueries;
+    if (HeapInfo.vkQueryPool == VK_NULL_HANDLE && HeapInfo.PoolSize != 0)
+        CreateQueryPool(HeapInfo);
     if (!AvailableQueries.empty())
     {
         Index = HeapInfo.AvailableQueries.back();
@@ -242,4 +256,18 @@ Uint32 QueryManagerVk::ResetStaleQueries(VulkanUtilities::VulkanCommandBuffer& C
     return NumQueriesReset;
 }
 
+void QueryManagerVk::GetStatistics(DeviceHelperStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock(m_HeapMutex);
+
+    for (const auto& HeapInfo : m_Heaps)
+    {
+        if (HeapInfo.vkQueryPool == VK_NULL_HANDLE)
+            continue;
+
+        ++Stats.NumQueryHeaps;
+        Stats.NumQueries += HeapInfo.vkPoolCI.queryCount;
+    }
+}
+
 } // namespace Diligent
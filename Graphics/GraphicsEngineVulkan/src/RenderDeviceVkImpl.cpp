@@ -44,6 +44,8 @@
 #include "TopLevelASVkImpl.hpp"
 #include "ShaderBindingTableVkImpl.hpp"
 #include "PipelineResourceSignatureVkImpl.hpp"
+#include "PipelineStateCacheVkImpl.hpp"
+#include "ResourceHeapVkImpl.hpp"
 #include "CommandQueueVkImpl.hpp"
 
 #include "VulkanTypeConversions.hpp"
@@ -76,7 +78,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     m_VulkanInstance         {Instance                 },
     m_PhysicalDevice         {std::move(PhysicalDevice)},
     m_LogicalVkDevice        {std::move(LogicalDevice) },
-    m_FramebufferCache       {*this                    },
+    m_FramebufferCache       {*this, EngineCI.FramebufferCacheSize, EngineCI.FramebufferCacheMaxAge},
     m_ImplicitRenderPassCache{*this                    },
     m_DescriptorSetAllocator
     {
@@ -133,6 +135,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DeviceLocalMemoryReserveSize,
         EngineCI.HostVisibleMemoryReserveSize
     },
+    m_MemoryDefragmentationBudget{EngineCI.MemoryDefragmentationBudget},
+    m_DeviceLocalUploadMemoryBudget{EngineCI.DeviceLocalUploadMemoryBudget},
     m_DynamicMemoryManager
     {
         GetRawAllocator(),
@@ -140,7 +144,8 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
         EngineCI.DynamicHeapSize,
         ~Uint64{0}
     },
-    m_pDxCompiler{CreateDXCompiler(DXCompilerTarget::Vulkan, m_PhysicalDevice->GetVkVersion(), EngineCI.pDxCompilerPath)}
+    m_pDxCompiler{CreateDXCompiler(DXCompilerTarget::Vulkan, m_PhysicalDevice->GetVkVersion(), EngineCI.pDxCompilerPath)},
+    m_pShaderCache{EngineCI.EnableShaderCache ? std::make_unique<ShaderCache>(EngineCI.ShaderCacheDirectory) : nullptr}
 // clang-format on
 {
     static_assert(sizeof(VulkanDescriptorPoolSize) == sizeof(Uint32) * 11, "Please add new descriptors to m_DescriptorSetAllocator and m_DynamicDescriptorPool constructors");
@@ -154,6 +159,14 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
                                                        m_LogicalVkDevice->GetEnabledExtFeatures(),
                                                        m_PhysicalDevice->GetExtProperties());
 
+    m_ContextNodeMasks.resize(CommandQueueCount);
+    for (Uint32 CtxInd = 0; CtxInd < EngineCI.NumImmediateContexts && CtxInd < CommandQueueCount; ++CtxInd)
+        m_ContextNodeMasks[CtxInd] = EngineCI.pImmediateContextInfo[CtxInd].NodeMask;
+
+    m_UseDynamicRendering = m_LogicalVkDevice->GetEnabledExtFeatures().DynamicRendering.dynamicRendering != VK_FALSE;
+    if (m_UseDynamicRendering)
+        LOG_INFO_MESSAGE("Vulkan dynamic rendering is supported: implicit render passes will not use render pass and framebuffer objects");
+
     // Every queue family needs its own command pool
     for (Uint32 q = 0; q < CommandQueueCount; ++q)
     {
@@ -172,9 +185,45 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
                 });
         }
     }
+    m_InitialDataUploads.reset(new InitialDataUploadBatch[CommandQueueCount]);
 
     for (Uint32 fmt = 1; fmt < m_TextureFormatsInfo.size(); ++fmt)
         m_TextureFormatsInfo[fmt].Supported = true; // We will test every format on a specific hardware device
+
+    if (EngineCI.BindlessHeapSize > 0)
+    {
+        if (m_DeviceInfo.Features.BindlessResources && m_DeviceInfo.Features.ShaderResourceRuntimeArray)
+        {
+            m_pBindlessHeap = std::make_unique<BindlessDescriptorHeapVk>(*this, EngineCI.BindlessHeapSize);
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Bindless descriptor heap requires BindlessResources and ShaderResourceRuntimeArray features. The heap will be disabled.");
+        }
+    }
+
+    // The descriptor buffer extension is only enabled by the engine factory when EngineCI.DescriptorBufferSize is not zero
+    if (GetLogicalDevice().GetEnabledExtFeatures().DescriptorBuffer.descriptorBuffer != VK_FALSE)
+    {
+        VERIFY_EXPR(EngineCI.DescriptorBufferSize > 0 && !m_pBindlessHeap);
+        m_pDescriptorBuffer = std::make_unique<DescriptorBufferVk>(*this, EngineCI.DescriptorBufferSize);
+    }
+
+    if (GetLogicalDevice().GetEnabledExtFeatures().GraphicsPipelineLibrary.graphicsPipelineLibrary != VK_FALSE)
+    {
+        m_pPipelineLibraryCache = std::make_unique<PipelineLibraryCacheVk>(*this);
+    }
+
+    {
+        PipelineStateCacheCreateInfo PSOCacheCI;
+        PSOCacheCI.Desc.Name     = "Default pipeline state cache";
+        PSOCacheCI.pCacheData    = EngineCI.pPipelineCacheData;
+        PSOCacheCI.CacheDataSize = EngineCI.PipelineCacheDataSize;
+
+        RefCntAutoPtr<IPipelineStateCache> pPSOCache;
+        CreatePipelineStateCacheImpl(&pPSOCache, PSOCacheCI, true);
+        m_pDefaultPSOCache = RefCntAutoPtr<IPipelineStateCacheVk>{pPSOCache, IID_PipelineStateCacheVk};
+    }
 }
 
 RenderDeviceVkImpl::~RenderDeviceVkImpl()
@@ -191,6 +240,14 @@ RenderDeviceVkImpl::~RenderDeviceVkImpl()
 
     ReleaseStaleResources(true);
 
+    // All views have been destroyed and their bindless indices have been returned
+    m_pBindlessHeap.reset();
+
+    // All descriptor buffer ranges have been returned by the release queues
+    m_pDescriptorBuffer.reset();
+
+    m_pPipelineLibraryCache.reset();
+
     DEV_CHECK_ERR(m_DescriptorSetAllocator.GetAllocatedDescriptorSetCounter() == 0, "All allocated descriptor sets must have been released now.");
     DEV_CHECK_ERR(m_DynamicDescriptorPool.GetAllocatedPoolCounter() == 0, "All allocated dynamic descriptor pools must have been released now.");
     DEV_CHECK_ERR(m_DynamicMemoryManager.GetMasterBlockCounter() == 0, "All allocated dynamic master blocks must have been returned to the pool.");
@@ -224,19 +281,8 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(SoftwareQueueIndex
     VERIFY(CmdPoolMgrIter != m_TransientCmdPoolMgrs.end(),
            "Con not find transiend command pool manager for queue family index (", Uint32{QueueFamilyIndex}, ")");
 
-    CmdPool = CmdPoolMgrIter->second.AllocateCommandPool(DebugPoolName);
-
-    // Allocate command buffer from the cmd pool
-    VkCommandBufferAllocateInfo BuffAllocInfo{};
-    BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    BuffAllocInfo.pNext              = nullptr;
-    BuffAllocInfo.commandPool        = CmdPool;
-    BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    BuffAllocInfo.commandBufferCount = 1;
-
-    vkCmdBuff = m_LogicalVkDevice->AllocateVkCommandBuffer(BuffAllocInfo);
-    DEV_CHECK_ERR(vkCmdBuff != VK_NULL_HANDLE, "Failed to allocate Vulkan command buffer");
-
+    // The command buffer is reused together with the pool
+    CmdPool = CmdPoolMgrIter->second.AllocateCommandPool(vkCmdBuff, DebugPoolName);
 
     VkCommandBufferBeginInfo CmdBuffBeginInfo{};
     CmdBuffBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -252,9 +298,9 @@ void RenderDeviceVkImpl::AllocateTransientCmdPool(SoftwareQueueIndex
 }
 
 
-void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex                    CommandQueueId,
-                                                           VkCommandBuffer                       vkCmdBuff,
-                                                           VulkanUtilities::CommandPoolWrapper&& CmdPool)
+Uint64 RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex                    CommandQueueId,
+                                                             VkCommandBuffer                       vkCmdBuff,
+                                                             VulkanUtilities::CommandPoolWrapper&& CmdPool)
 {
     VERIFY_EXPR(vkCmdBuff != VK_NULL_HANDLE);
 
@@ -298,12 +344,10 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex
     class TransientCmdPoolRecycler
     {
     public:
-        TransientCmdPoolRecycler(const VulkanUtilities::VulkanLogicalDevice& _LogicalDevice,
-                                 CommandPoolManager&                         _CmdPoolMgr,
-                                 VulkanUtilities::CommandPoolWrapper&&       _Pool,
-                                 VkCommandBuffer&&                           _vkCmdBuffer) :
+        TransientCmdPoolRecycler(CommandPoolManager&                   _CmdPoolMgr,
+                                 VulkanUtilities::CommandPoolWrapper&& _Pool,
+                                 VkCommandBuffer&&                     _vkCmdBuffer) :
             // clang-format off
-            LogicalDevice{_LogicalDevice         },
             CmdPoolMgr   {&_CmdPoolMgr           },
             Pool         {std::move(_Pool)       },
             vkCmdBuffer  {std::move(_vkCmdBuffer)}
@@ -319,7 +363,6 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex
         TransientCmdPoolRecycler& operator = (      TransientCmdPoolRecycler&&) = delete;
 
         TransientCmdPoolRecycler(TransientCmdPoolRecycler&& rhs) :
-            LogicalDevice{rhs.LogicalDevice         },
             CmdPoolMgr   {rhs.CmdPoolMgr            },
             Pool         {std::move(rhs.Pool)       },
             vkCmdBuffer  {std::move(rhs.vkCmdBuffer)}
@@ -333,14 +376,12 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex
         {
             if (CmdPoolMgr != nullptr)
             {
-                LogicalDevice.FreeCommandBuffer(Pool, vkCmdBuffer);
-                CmdPoolMgr->RecycleCommandPool(std::move(Pool));
+                // The command buffer is not freed and will be reused with the pool
+                CmdPoolMgr->RecycleCommandPool(std::move(Pool), vkCmdBuffer);
             }
         }
 
     private:
-        const VulkanUtilities::VulkanLogicalDevice& LogicalDevice;
-
         CommandPoolManager*                 CmdPoolMgr = nullptr;
         VulkanUtilities::CommandPoolWrapper Pool;
         VkCommandBuffer                     vkCmdBuffer = VK_NULL_HANDLE;
@@ -357,13 +398,44 @@ void RenderDeviceVkImpl::ExecuteAndDisposeTransientCmdBuff(SoftwareQueueIndex
     GetReleaseQueue(CommandQueueId).DiscardResource(
         TransientCmdPoolRecycler
         {
-            GetLogicalDevice(),
             CmdPoolMgrIter->second,
             std::move(CmdPool),
             std::move(vkCmdBuff)
         },
         FenceValue);
     // clang-format on
+
+    return FenceValue;
+}
+
+void RenderDeviceVkImpl::SubmitInitialDataUploads(SoftwareQueueIndex CommandQueueId, InitialDataUploadBatch& Batch)
+{
+    if (Batch.vkCmdBuff == VK_NULL_HANDLE)
+        return;
+
+    const auto FenceValue = ExecuteAndDisposeTransientCmdBuff(CommandQueueId, Batch.vkCmdBuff, std::move(Batch.CmdPool));
+
+    // Staging resources are discarded with the fence value of the batch rather than released through
+    // the stale resource list: another thread may record new copies and submit the next batch before
+    // the immediate context submits its command buffer, so the command buffer number is not a reliable
+    // indicator of when the copies complete.
+    GetReleaseQueue(CommandQueueId).DiscardResource(std::move(Batch.Staging), FenceValue);
+
+    Batch.vkCmdBuff   = VK_NULL_HANDLE;
+    Batch.NumUploads  = 0;
+    Batch.StagingSize = 0;
+    Batch.Staging     = {};
+}
+
+void RenderDeviceVkImpl::FlushInitialDataUploads()
+{
+    for (Uint32 q = 0; q < GetCommandQueueCount(); ++q)
+    {
+        auto& Batch = m_InitialDataUploads[q];
+
+        std::lock_guard<std::mutex> Lock{Batch.Mtx};
+        SubmitInitialDataUploads(SoftwareQueueIndex{q}, Batch);
+    }
 }
 
 void RenderDeviceVkImpl::SubmitCommandBuffer(SoftwareQueueIndex                                          CommandQueueId,
@@ -373,6 +445,13 @@ void RenderDeviceVkImpl::SubmitCommandBuffer(SoftwareQueueIndex
                                              std::vector<std::pair<Uint64, RefCntAutoPtr<FenceVkImpl>>>* pSignalFences           // List of fences to signal
 )
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::SubmitCommandBuffer");
+
+    // Resources created since the last submission may be used by the command buffer,
+    // so their initial data must be uploaded first. The uploads of all queues are submitted
+    // as the resource may also be used by the queue other than the one it was initialized on.
+    FlushInitialDataUploads();
+
     // Submit the command list to the queue
     auto CmbBuffInfo       = TRenderDeviceBase::SubmitCommandBuffer(CommandQueueId, true, SubmitInfo);
     SubmittedFenceValue    = CmbBuffInfo.FenceValue;
@@ -407,11 +486,50 @@ Uint64 RenderDeviceVkImpl::ExecuteCommandBuffer(SoftwareQueueIndex CommandQueueI
 
 void RenderDeviceVkImpl::IdleGPU()
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::IdleGPU");
+
+    FlushInitialDataUploads();
     IdleAllCommandQueues(true);
     m_LogicalVkDevice->WaitIdle();
     ReleaseStaleResources();
 }
 
+void RenderDeviceVkImpl::GetMemoryStatistics(RenderDeviceMemoryStatistics& Stats)
+{
+    m_MemoryMgr.GetStatistics(Stats);
+
+    auto& Helpers           = Stats.Helpers;
+    Helpers.DynamicHeapSize = m_DynamicMemoryManager.GetReservedSize();
+
+    // Query managers belong to immediate contexts, while the mipmap generation helper is shared by all contexts
+    bool MipsHelperCounted = false;
+    for (size_t ctx = 0; ctx < GetNumImmediateContexts(); ++ctx)
+    {
+        auto pCtx = GetImmediateContext(ctx);
+        if (!pCtx)
+            continue;
+
+        auto* pCtxVk = pCtx.RawPtr<DeviceContextVkImpl>();
+        if (auto* pQueryMgr = pCtxVk->GetQueryManager())
+            pQueryMgr->GetStatistics(Helpers);
+        if (!MipsHelperCounted)
+        {
+            pCtxVk->GetGenerateMipsHelper().GetStatistics(Helpers);
+            MipsHelperCounted = true;
+        }
+    }
+}
+
+void RenderDeviceVkImpl::CaptureResourceSnapshot(ResourceSnapshot& Snapshot, IDataBlob** ppObjects)
+{
+    TRenderDeviceBase::CaptureResourceSnapshot(Snapshot, ppObjects);
+
+    FramebufferCacheStatistics FBCacheStats;
+    m_FramebufferCache.GetStatistics(FBCacheStats);
+    Snapshot.NumCachedFramebuffers = FBCacheStats.NumFramebuffers;
+    Snapshot.NumCachedRenderPasses = m_ImplicitRenderPassCache.GetSize();
+}
+
 void RenderDeviceVkImpl::FlushStaleResources(SoftwareQueueIndex CmdQueueIndex)
 {
     // Submit empty command buffer to the queue. This will effectively signal the fence and
@@ -423,10 +541,69 @@ void RenderDeviceVkImpl::FlushStaleResources(SoftwareQueueIndex CmdQueueIndex)
 
 void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::ReleaseStaleResources");
+
     m_MemoryMgr.ShrinkMemory();
     PurgeReleaseQueues(ForceRelease);
 }
 
+void RenderDeviceVkImpl::RegisterRelocatableBuffer(BufferVkImpl& Buffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+    VERIFY(Buffer.m_RelocatableBufferIdx == BufferVkImpl::InvalidRelocatableBufferIdx, "The buffer is already registered");
+    Buffer.m_RelocatableBufferIdx = static_cast<Uint32>(m_RelocatableBuffers.size());
+    m_RelocatableBuffers.push_back(&Buffer);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableBuffer(BufferVkImpl& Buffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+
+    const auto Idx = Buffer.m_RelocatableBufferIdx;
+    VERIFY_EXPR(Idx < m_RelocatableBuffers.size() && m_RelocatableBuffers[Idx] == &Buffer);
+
+    // Move the last buffer into the released slot
+    m_RelocatableBuffers[Idx]                         = m_RelocatableBuffers.back();
+    m_RelocatableBuffers[Idx]->m_RelocatableBufferIdx = Idx;
+    m_RelocatableBuffers.pop_back();
+    Buffer.m_RelocatableBufferIdx = BufferVkImpl::InvalidRelocatableBufferIdx;
+}
+
+VkDeviceSize RenderDeviceVkImpl::DefragmentMemory(DeviceContextVkImpl& Ctx)
+{
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::DefragmentMemory");
+
+    // Only allocations from pages that are less than half occupied are relocated
+    constexpr double MaxSrcPageOccupancy = 0.5;
+    // The maximum number of buffers that are checked every time the method is called
+    constexpr size_t MaxBuffersToCheck = 256;
+
+    VERIFY_EXPR(!Ctx.IsDeferred());
+    const Uint64 CtxMask = Uint64{1} << Ctx.GetContextId();
+
+    // Buffers doing the destruction will wait until relocation is complete
+    std::lock_guard<std::mutex> Lock{m_RelocatableBuffersMtx};
+
+    VkDeviceSize RelocatedSize = 0;
+
+    const auto NumBuffersToCheck = std::min(m_RelocatableBuffers.size(), MaxBuffersToCheck);
+    for (size_t i = 0; i < NumBuffersToCheck && RelocatedSize < m_MemoryDefragmentationBudget; ++i)
+    {
+        if (m_NextRelocatableBuffer >= m_RelocatableBuffers.size())
+            m_NextRelocatableBuffer = 0;
+
+        auto& Buffer = *m_RelocatableBuffers[m_NextRelocatableBuffer++];
+
+        const auto& BuffDesc = Buffer.GetDesc();
+        if (BuffDesc.ImmediateContextMask != CtxMask || BuffDesc.uiSizeInBytes > m_MemoryDefragmentationBudget - RelocatedSize)
+            continue;
+
+        RelocatedSize += Ctx.RelocateBufferMemory(Buffer, MaxSrcPageOccupancy);
+    }
+
+    return RelocatedSize;
+}
+
 
 void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 {
@@ -542,16 +719,22 @@ void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 
 void RenderDeviceVkImpl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::CreateGraphicsPipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceVkImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::CreateComputePipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
 void RenderDeviceVkImpl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::CreateRayTracingPipelineState");
+
     CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
 }
 
@@ -568,6 +751,8 @@ void RenderDeviceVkImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferDa
 
 void RenderDeviceVkImpl::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::CreateShader");
+
     CreateShaderImpl(ppShader, ShaderCI);
 }
 
@@ -672,6 +857,8 @@ void RenderDeviceVkImpl::CreateSBT(const ShaderBindingTableDesc& Desc,
 void RenderDeviceVkImpl::CreatePipelineResourceSignature(const PipelineResourceSignatureDesc& Desc,
                                                          IPipelineResourceSignature**         ppSignature)
 {
+    DILIGENT_PROFILE_SCOPE("RenderDeviceVk::CreatePipelineResourceSignature");
+
     CreatePipelineResourceSignature(Desc, ppSignature, false);
 }
 
@@ -682,6 +869,40 @@ void RenderDeviceVkImpl::CreatePipelineResourceSignature(const PipelineResourceS
     CreatePipelineResourceSignatureImpl(ppSignature, Desc, IsDeviceInternal);
 }
 
+void RenderDeviceVkImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
+                                                  IPipelineStateCache**               ppPSOCache)
+{
+    CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo, false);
+}
+
+void RenderDeviceVkImpl::CreateResourceHeap(const ResourceHeapDesc& Desc,
+                                            IResourceHeap**         ppHeap)
+{
+    CreateResourceHeapImpl(ppHeap, Desc);
+}
+
+void RenderDeviceVkImpl::CreatePlacedTexture(const TextureDesc& TexDesc, ResourceHeapVkImpl* pHeap, Uint64 Offset, ITexture** ppTexture)
+{
+    CreateTextureImpl(ppTexture, TexDesc, static_cast<const TextureData*>(nullptr), pHeap, Offset);
+}
+
+void RenderDeviceVkImpl::CreatePlacedBuffer(const BufferDesc& BuffDesc, ResourceHeapVkImpl* pHeap, Uint64 Offset, IBuffer** ppBuffer)
+{
+    CreateBufferImpl(ppBuffer, BuffDesc, static_cast<const BufferData*>(nullptr), pHeap, Offset);
+}
+
+VkPipelineCache RenderDeviceVkImpl::GetVkPipelineCache(IPipelineStateCache* pPSOCache) const
+{
+    if (pPSOCache != nullptr)
+    {
+        RefCntAutoPtr<IPipelineStateCacheVk> pPSOCacheVk{pPSOCache, IID_PipelineStateCacheVk};
+        DEV_CHECK_ERR(pPSOCacheVk, "Pipeline state cache '", pPSOCache->GetDesc().Name, "' was not created by Vulkan device");
+        if (pPSOCacheVk)
+            return pPSOCacheVk->GetVkPipelineCache();
+    }
+    return m_pDefaultPSOCache ? m_pDefaultPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
+}
+
 std::vector<uint32_t> RenderDeviceVkImpl::ConvertCmdQueueIdsToQueueFamilies(Uint64 CommandQueueMask) const
 {
     std::bitset<MAX_COMMAND_QUEUES> QueueFamilyBits{};
@@ -703,6 +924,58 @@ std::vector<uint32_t> RenderDeviceVkImpl::ConvertCmdQueueIdsToQueueFamilies(Uint
     return QueueFamilyIndices;
 }
 
+uint32_t RenderDeviceVkImpl::GetMemoryDeviceMask(Uint64 ImmediateContextMask) const
+{
+    const auto NumNodes = m_DeviceInfo.NumNodes;
+    if (NumNodes <= 1)
+        return 0;
+
+    const Uint32 AllNodesMask = NumNodes < 32 ? (1u << NumNodes) - 1u : ~0u;
+
+    Uint32 DeviceMask = 0;
+    while (ImmediateContextMask != 0)
+    {
+        const auto CtxInd = PlatformMisc::GetLSB(ImmediateContextMask);
+        ImmediateContextMask &= ~(Uint64{1} << Uint64{CtxInd});
+
+        const auto NodeMask = CtxInd < m_ContextNodeMasks.size() ? m_ContextNodeMasks[CtxInd] : 0u;
+        if (NodeMask == 0)
+            return 0; // The context uses all nodes
+
+        DeviceMask |= NodeMask;
+    }
+
+    return DeviceMask != AllNodesMask ? DeviceMask : 0;
+}
+
+uint32_t RenderDeviceVkImpl::GetUploadMemoryTypeIndex(uint32_t MemoryTypeBits, VkDeviceSize Size)
+{
+    if (Size <= m_DeviceLocalUploadMemoryBudget)
+    {
+        constexpr VkMemoryPropertyFlags DeviceLocalUploadFlags =
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        const auto MemoryTypeIndex = m_PhysicalDevice->GetMemoryTypeIndex(MemoryTypeBits, DeviceLocalUploadFlags);
+        if (MemoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        {
+            // Without resizable BAR, the host-visible part of video memory is typically only 256 MB,
+            // and it is also used by the driver. Never take more than half of the heap.
+            const auto& MemoryProps = m_PhysicalDevice->GetMemoryProperties();
+            const auto  HeapSize    = MemoryProps.memoryHeaps[MemoryProps.memoryTypes[MemoryTypeIndex].heapIndex].size;
+            const auto  Budget      = std::min(VkDeviceSize{m_DeviceLocalUploadMemoryBudget}, HeapSize / 2);
+
+            // The check is not atomic with the allocation, so concurrent allocations may slightly exceed the budget
+            const auto UsedSize = m_MemoryMgr.GetMemoryTypeUsedSize(MemoryTypeIndex) + m_DynamicMemoryManager.GetDeviceLocalSize();
+            if (UsedSize + Size <= Budget)
+                return MemoryTypeIndex;
+        }
+    }
+
+    return m_PhysicalDevice->GetMemoryTypeIndex(MemoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
 HardwareQueueIndex RenderDeviceVkImpl::GetQueueFamilyIndex(SoftwareQueueIndex CmdQueueInd) const
 {
     const auto& CmdQueue = GetCommandQueue(SoftwareQueueIndex{CmdQueueInd});
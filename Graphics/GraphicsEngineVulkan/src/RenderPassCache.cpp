@@ -51,8 +51,16 @@ RenderPassCache::~RenderPassCache()
     VERIFY(m_Cache.empty(), "Render pass cache is not empty. Did you call Destroy?");
 }
 
+Uint32 RenderPassCache::GetSize()
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    return static_cast<Uint32>(m_Cache.size());
+}
+
 void RenderPassCache::Destroy()
 {
+    m_Lookup.Clear();
+
     auto& FBCache = m_DeviceVkImpl.GetFramebufferCache();
     for (auto it = m_Cache.begin(); it != m_Cache.end(); ++it)
     {
@@ -64,6 +72,12 @@ void RenderPassCache::Destroy()
 
 RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
 {
+    // Render passes are never removed from the cache until it is destroyed,
+    // so cache hits do not need to take the lock.
+    RenderPassVkImpl* pCachedPass = nullptr;
+    if (m_Lookup.Find(Key, pCachedPass))
+        return pCachedPass;
+
     std::lock_guard<std::mutex> Lock{m_Mutex};
     auto                        it = m_Cache.find(Key);
     if (it == m_Cache.end())
@@ -93,6 +107,7 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
         m_DeviceVkImpl.CreateRenderPass(RPDesc, pRenderPass.RawDblPtr<IRenderPass>(), /* IsDeviceInternal = */ true);
         VERIFY_EXPR(pRenderPass != nullptr);
         it = m_Cache.emplace(Key, std::move(pRenderPass)).first;
+        m_Lookup.Insert(Key, it->second.RawPtr());
     }
 
     return it->second;
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "pch.h"
+
+#include "ResourceHeapVkImpl.hpp"
+#include "RenderDeviceVkImpl.hpp"
+#include "TextureVkImpl.hpp"
+#include "BufferVkImpl.hpp"
+
+namespace Diligent
+{
+
+ResourceHeapVkImpl::ResourceHeapVkImpl(IReferenceCounters*     pRefCounters,
+                                       RenderDeviceVkImpl*     pRenderDeviceVk,
+                                       const ResourceHeapDesc& Desc) :
+    // clang-format off
+    TResourceHeapBase
+    {
+        pRefCounters,
+        pRenderDeviceVk,
+        Desc
+    }
+// clang-format on
+{
+    const auto& LogicalDevice  = pRenderDeviceVk->GetLogicalDevice();
+    const auto& PhysicalDevice = pRenderDeviceVk->GetPhysicalDevice();
+
+    // Placed images and buffers may only be bound to memory types that are allowed by their
+    // memory requirements, which is checked when resources are created in the heap.
+    m_MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(~uint32_t{0}, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (m_MemoryTypeIndex == VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+        LOG_ERROR_AND_THROW("Failed to find device-local memory type for resource heap '", m_Desc.Name, '\'');
+
+    VkMemoryAllocateInfo      MemAlloc{};
+    VkMemoryAllocateFlagsInfo MemFlagInfo{};
+
+    MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    MemAlloc.pNext           = nullptr;
+    MemAlloc.allocationSize  = m_Desc.Size;
+    MemAlloc.memoryTypeIndex = m_MemoryTypeIndex;
+
+    if (LogicalDevice.GetEnabledExtFeatures().BufferDeviceAddress.bufferDeviceAddress != VK_FALSE)
+    {
+        // Buffers placed in the heap may require device address (e.g. ray tracing buffers)
+        MemFlagInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        MemFlagInfo.pNext = nullptr;
+        MemFlagInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        MemAlloc.pNext    = &MemFlagInfo;
+    }
+
+    m_VkMemory = LogicalDevice.AllocateDeviceMemory(MemAlloc, m_Desc.Name);
+}
+
+ResourceHeapVkImpl::~ResourceHeapVkImpl()
+{
+    // Memory can only be released when it is no longer used by the GPU
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_VkMemory), m_Desc.ImmediateContextMask);
+}
+
+ResourceAllocationInfo ResourceHeapVkImpl::GetTextureAllocationInfo(const TextureDesc& TexDesc) const
+{
+    std::vector<uint32_t> QueueFamilyIndices;
+
+    const auto ImageCI = TextureVkImpl::GetImageCreateInfo(m_pDevice, TexDesc, QueueFamilyIndices);
+
+    // Memory requirements can only be queried from the image object
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    auto        TmpImage      = LogicalDevice.CreateImage(ImageCI, "Temporary image for allocation info query");
+    const auto  MemReqs       = LogicalDevice.GetImageMemoryRequirements(TmpImage);
+
+    return ResourceAllocationInfo{MemReqs.size, MemReqs.alignment};
+}
+
+ResourceAllocationInfo ResourceHeapVkImpl::GetBufferAllocationInfo(const BufferDesc& BuffDesc) const
+{
+    std::vector<uint32_t> QueueFamilyIndices;
+
+    const auto BuffCI = BufferVkImpl::GetBufferCreateInfo(m_pDevice, BuffDesc, QueueFamilyIndices);
+
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+    auto        TmpBuffer     = LogicalDevice.CreateBuffer(BuffCI, "Temporary buffer for allocation info query");
+    const auto  MemReqs       = LogicalDevice.GetBufferMemoryRequirements(TmpBuffer);
+
+    ResourceAllocationInfo AllocInfo{MemReqs.size, MemReqs.alignment};
+    if ((BuffDesc.BindFlags & BIND_RAY_TRACING) != 0)
+    {
+        // Same alignment as in BufferVkImpl constructor
+        const VkDeviceSize ScratchBufferAlign = m_pDevice->GetPhysicalDevice().GetExtProperties().AccelStruct.minAccelerationStructureScratchOffsetAlignment;
+        AllocInfo.Alignment                   = std::max(AllocInfo.Alignment, std::max(Uint64{ScratchBufferAlign}, Uint64{16}));
+    }
+    return AllocInfo;
+}
+
+void ResourceHeapVkImpl::CreateTexture(const TextureDesc& TexDesc, Uint64 Offset, ITexture** ppTexture)
+{
+    DEV_CHECK_ERR(ppTexture != nullptr, "Null pointer provided");
+    if (ppTexture == nullptr)
+        return;
+    *ppTexture = nullptr;
+
+    try
+    {
+        ValidatePlacement("texture", TexDesc.Name, TexDesc.Usage, TexDesc.ImmediateContextMask, Offset, GetTextureAllocationInfo(TexDesc));
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    m_pDevice->CreatePlacedTexture(TexDesc, this, Offset, ppTexture);
+}
+
+void ResourceHeapVkImpl::CreateBuffer(const BufferDesc& BuffDesc, Uint64 Offset, IBuffer** ppBuffer)
+{
+    DEV_CHECK_ERR(ppBuffer != nullptr, "Null pointer provided");
+    if (ppBuffer == nullptr)
+        return;
+    *ppBuffer = nullptr;
+
+    try
+    {
+        ValidatePlacement("buffer", BuffDesc.Name, BuffDesc.Usage, BuffDesc.ImmediateContextMask, Offset, GetBufferAllocationInfo(BuffDesc));
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    m_pDevice->CreatePlacedBuffer(BuffDesc, this, Offset, ppBuffer);
+}
+
+} // namespace Diligent
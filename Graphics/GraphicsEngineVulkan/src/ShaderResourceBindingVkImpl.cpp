@@ -34,8 +34,9 @@ namespace Diligent
 {
 
 ShaderResourceBindingVkImpl::ShaderResourceBindingVkImpl(IReferenceCounters*              pRefCounters,
-                                                         PipelineResourceSignatureVkImpl* pPRS) :
-    TBase{pRefCounters, pPRS}
+                                                         PipelineResourceSignatureVkImpl* pPRS,
+                                                         DescriptorSetAllocation*         pStaticMutableSetAllocation) :
+    TBase{pRefCounters, pPRS, pStaticMutableSetAllocation}
 {
 }
 
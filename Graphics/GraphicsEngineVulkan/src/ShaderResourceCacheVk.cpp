@@ -288,6 +288,170 @@ void ShaderResourceCacheVk::Resource::SetStorageBuffer(RefCntAutoPtr<IDeviceObje
 #endif
 }
 
+void ShaderResourceCacheVk::Resource::GetDescriptorWriteInfo(VkWriteDescriptorSet& WriteDescrSet, DescriptorWriteInfo& WriteInfo) const
+{
+    // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
+    // The type of the descriptor also controls which array the descriptors are taken from. (13.2.4)
+    WriteDescrSet.descriptorType   = DescriptorTypeToVkDescriptorType(Type);
+    WriteDescrSet.pImageInfo       = nullptr;
+    WriteDescrSet.pBufferInfo      = nullptr;
+    WriteDescrSet.pTexelBufferView = nullptr;
+
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 15, "Please update the switch below to handle the new descriptor type");
+    switch (Type)
+    {
+        case DescriptorType::Sampler:
+            WriteInfo.ImageInfo      = GetSamplerDescriptorWriteInfo();
+            WriteDescrSet.pImageInfo = &WriteInfo.ImageInfo;
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+            WriteInfo.ImageInfo      = GetImageDescriptorWriteInfo();
+            WriteDescrSet.pImageInfo = &WriteInfo.ImageInfo;
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            WriteInfo.BufferView           = GetBufferViewWriteInfo();
+            WriteDescrSet.pTexelBufferView = &WriteInfo.BufferView;
+            break;
+
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            WriteInfo.BufferInfo      = GetUniformBufferDescriptorWriteInfo();
+            WriteDescrSet.pBufferInfo = &WriteInfo.BufferInfo;
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            WriteInfo.BufferInfo      = GetStorageBufferDescriptorWriteInfo();
+            WriteDescrSet.pBufferInfo = &WriteInfo.BufferInfo;
+            break;
+
+        case DescriptorType::InputAttachment:
+            WriteInfo.ImageInfo      = GetInputAttachmentDescriptorWriteInfo();
+            WriteDescrSet.pImageInfo = &WriteInfo.ImageInfo;
+            break;
+
+        case DescriptorType::AccelerationStructure:
+            WriteInfo.AccelStructInfo = GetAccelerationStructureWriteInfo();
+            WriteDescrSet.pNext       = &WriteInfo.AccelStructInfo;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+    }
+}
+
+void ShaderResourceCacheVk::Resource::WriteDescriptorBufferData(const VulkanUtilities::VulkanLogicalDevice& LogicalDevice,
+                                                                const DescriptorBufferBinding&              Binding,
+                                                                void*                                       pDst,
+                                                                DeviceContextIndex                          CtxId,
+                                                                DeviceContextVkImpl*                        pCtx) const
+{
+    VERIFY_EXPR(Binding.Type == DescriptorBufferVk::GetDescriptorBufferType(DescriptorTypeToVkDescriptorType(Type)));
+
+    VkDescriptorGetInfoEXT GetInfo{};
+    GetInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+    GetInfo.type  = Binding.Type;
+
+    // Storage for the data referenced by GetInfo.data
+    VkDescriptorImageInfo      ImageInfo{};
+    VkDescriptorAddressInfoEXT AddressInfo{};
+    AddressInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+
+    VkSampler vkSampler = VK_NULL_HANDLE;
+
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 15, "Please update the switch below to handle the new descriptor type");
+    switch (Type)
+    {
+        case DescriptorType::Sampler:
+            vkSampler             = HasImmutableSampler ? Binding.ImmutableSampler : GetSamplerDescriptorWriteInfo().sampler;
+            GetInfo.data.pSampler = &vkSampler;
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+            ImageInfo = GetImageDescriptorWriteInfo();
+            if (HasImmutableSampler)
+                ImageInfo.sampler = Binding.ImmutableSampler;
+            GetInfo.data.pCombinedImageSampler = &ImageInfo;
+            break;
+
+        case DescriptorType::SeparateImage:
+            ImageInfo                  = GetImageDescriptorWriteInfo();
+            GetInfo.data.pSampledImage = &ImageInfo;
+            break;
+
+        case DescriptorType::StorageImage:
+            ImageInfo                  = GetImageDescriptorWriteInfo();
+            GetInfo.data.pStorageImage = &ImageInfo;
+            break;
+
+        case DescriptorType::InputAttachment:
+            ImageInfo                          = GetInputAttachmentDescriptorWriteInfo();
+            GetInfo.data.pInputAttachmentImage = &ImageInfo;
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+        {
+            DEV_CHECK_ERR(pObject != nullptr, "Unable to get texel buffer descriptor data: cached object is null");
+            const auto* pBuffViewVk = pObject.RawPtr<const BufferViewVkImpl>();
+            const auto& ViewDesc    = pBuffViewVk->GetDesc();
+            AddressInfo.address     = pBuffViewVk->GetBuffer<const BufferVkImpl>()->GetDescriptorAddress(CtxId, pCtx) + ViewDesc.ByteOffset;
+            AddressInfo.range       = ViewDesc.ByteWidth;
+            AddressInfo.format      = TypeToVkFormat(ViewDesc.Format.ValueType, ViewDesc.Format.NumComponents, ViewDesc.Format.IsNormalized);
+            if (Type == DescriptorType::UniformTexelBuffer)
+                GetInfo.data.pUniformTexelBuffer = &AddressInfo;
+            else
+                GetInfo.data.pStorageTexelBuffer = &AddressInfo;
+            break;
+        }
+
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+        {
+            DEV_CHECK_ERR(pObject != nullptr, "Unable to get uniform buffer descriptor data: cached object is null");
+            const auto* pBuffVk = pObject.RawPtr<const BufferVkImpl>();
+            // There are no dynamic offsets in descriptor buffer mode, so the offset is baked into the address
+            AddressInfo.address         = pBuffVk->GetDescriptorAddress(CtxId, pCtx) + BufferBaseOffset + BufferDynamicOffset;
+            AddressInfo.range           = BufferRangeSize;
+            GetInfo.data.pUniformBuffer = &AddressInfo;
+            break;
+        }
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+        {
+            DEV_CHECK_ERR(pObject != nullptr, "Unable to get storage buffer descriptor data: cached object is null");
+            const auto* pBuffVk = pObject.RawPtr<const BufferViewVkImpl>()->GetBuffer<const BufferVkImpl>();
+            AddressInfo.address         = pBuffVk->GetDescriptorAddress(CtxId, pCtx) + BufferBaseOffset + BufferDynamicOffset;
+            AddressInfo.range           = BufferRangeSize;
+            GetInfo.data.pStorageBuffer = &AddressInfo;
+            break;
+        }
+
+        case DescriptorType::AccelerationStructure:
+            DEV_CHECK_ERR(pObject != nullptr, "Unable to get acceleration structure descriptor data: cached object is null");
+            GetInfo.data.accelerationStructure = pObject.RawPtr<const TopLevelASVkImpl>()->GetVkDeviceAddress();
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+            return;
+    }
+
+    LogicalDevice.GetDescriptor(GetInfo, Binding.Stride, pDst);
+}
+
 const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
     const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
     Uint32                                      DescrSetIndex,
@@ -328,10 +492,8 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
     }
 
     auto vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (vkSet != VK_NULL_HANDLE && DstRes.pObject && pLogicalDevice != nullptr)
     {
-        VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
-
         VkWriteDescriptorSet WriteDescrSet;
         WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         WriteDescrSet.pNext           = nullptr;
@@ -339,73 +501,23 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
         WriteDescrSet.dstBinding      = SrcRes.BindingIndex;
         WriteDescrSet.dstArrayElement = SrcRes.ArrayIndex;
         WriteDescrSet.descriptorCount = 1;
-        // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
-        // The type of the descriptor also controls which array the descriptors are taken from. (13.2.4)
-        WriteDescrSet.descriptorType   = DescriptorTypeToVkDescriptorType(DstRes.Type);
-        WriteDescrSet.pImageInfo       = nullptr;
-        WriteDescrSet.pBufferInfo      = nullptr;
-        WriteDescrSet.pTexelBufferView = nullptr;
 
         // Do not zero-initialize!
-        union
-        {
-            VkDescriptorImageInfo                        vkDescrImageInfo;
-            VkDescriptorBufferInfo                       vkDescrBufferInfo;
-            VkBufferView                                 vkDescrBufferView;
-            VkWriteDescriptorSetAccelerationStructureKHR vkDescrAccelStructInfo;
-        };
+        DescriptorWriteInfo WriteInfo;
+        DstRes.GetDescriptorWriteInfo(WriteDescrSet, WriteInfo);
 
-        static_assert(static_cast<Uint32>(DescriptorType::Count) == 15, "Please update the switch below to handle the new descriptor type");
-        switch (DstRes.Type)
+        pLogicalDevice->UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+    }
+    else if (auto* pDescrBufferData = DescrSet.GetDescriptorBufferCPUAddress())
+    {
+        // In descriptor buffer mode, the descriptor is written directly into the set's range of the
+        // global descriptor buffer. Descriptors of dynamic buffers are written when the SRB is committed.
+        if (DstRes.pObject && pLogicalDevice != nullptr && !IsDynamicBuffer(DstRes))
         {
-            case DescriptorType::Sampler:
-                vkDescrImageInfo         = DstRes.GetSamplerDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::CombinedImageSampler:
-            case DescriptorType::SeparateImage:
-            case DescriptorType::StorageImage:
-                vkDescrImageInfo         = DstRes.GetImageDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::UniformTexelBuffer:
-            case DescriptorType::StorageTexelBuffer:
-            case DescriptorType::StorageTexelBuffer_ReadOnly:
-                vkDescrBufferView              = DstRes.GetBufferViewWriteInfo();
-                WriteDescrSet.pTexelBufferView = &vkDescrBufferView;
-                break;
-
-            case DescriptorType::UniformBuffer:
-            case DescriptorType::UniformBufferDynamic:
-                vkDescrBufferInfo         = DstRes.GetUniformBufferDescriptorWriteInfo();
-                WriteDescrSet.pBufferInfo = &vkDescrBufferInfo;
-                break;
-
-            case DescriptorType::StorageBuffer:
-            case DescriptorType::StorageBuffer_ReadOnly:
-            case DescriptorType::StorageBufferDynamic:
-            case DescriptorType::StorageBufferDynamic_ReadOnly:
-                vkDescrBufferInfo         = DstRes.GetStorageBufferDescriptorWriteInfo();
-                WriteDescrSet.pBufferInfo = &vkDescrBufferInfo;
-                break;
-
-            case DescriptorType::InputAttachment:
-                vkDescrImageInfo         = DstRes.GetInputAttachmentDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::AccelerationStructure:
-                vkDescrAccelStructInfo = DstRes.GetAccelerationStructureWriteInfo();
-                WriteDescrSet.pNext    = &vkDescrAccelStructInfo;
-                break;
-
-            default:
-                UNEXPECTED("Unexpected descriptor type");
+            const auto& Binding = DescrSet.GetDescriptorBufferBinding(SrcRes.BindingIndex);
+            VERIFY_EXPR(SrcRes.ArrayIndex < Binding.ArraySize);
+            DstRes.WriteDescriptorBufferData(*pLogicalDevice, Binding, pDescrBufferData + Binding.Offset + SrcRes.ArrayIndex * Binding.Stride, 0, nullptr);
         }
-
-        pLogicalDevice->UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
     }
 
     UpdateRevision();
@@ -56,6 +56,10 @@ void ProcessSignatureResources(const PipelineResourceSignatureVkImpl& Signature,
                                        (!UsingSeparateSamplers || ResAttr.IsImmutableSamplerAssigned()))
                                        return;
 
+                                   // Bindless heap resources and inline constants are not exposed as shader variables
+                                   if ((ResDesc.Flags & (PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP | PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS)) != 0)
+                                       return;
+
                                    Handler(Index);
                                });
 }
@@ -163,6 +167,12 @@ const PipelineResourceDesc& ShaderVariableManagerVk::GetResourceDesc(Uint32 Inde
     return m_pSignature->GetResourceDesc(Index);
 }
 
+size_t ShaderVariableManagerVk::GetResourceNameHash(Uint32 Index) const
+{
+    VERIFY_EXPR(m_pSignature);
+    return m_pSignature->GetResourceNameHash(Index);
+}
+
 const ShaderVariableManagerVk::ResourceAttribs& ShaderVariableManagerVk::GetResourceAttribs(Uint32 Index) const
 {
     VERIFY_EXPR(m_pSignature);
@@ -181,9 +191,12 @@ void ShaderVariableManagerVk::BindResources(IResourceMapping* pResourceMapping,
     if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
         Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
 
+    // Variables look up resources in the engine's resource mapping by precomputed name hashes
+    RefCntAutoPtr<ResourceMappingImpl> pMappingImpl{pResourceMapping, IID_ResourceMappingImpl};
+
     for (Uint32 v = 0; v < m_NumVariables; ++v)
     {
-        m_pVariables[v].BindResources(pResourceMapping, Flags);
+        m_pVariables[v].BindResources(pResourceMapping, pMappingImpl, Flags);
     }
 }
 
@@ -37,6 +37,8 @@
 #include "GLSLUtils.hpp"
 #include "DXCompiler.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "HLSLUtils.hpp"
+#include "HashUtils.hpp"
 
 #if !DILIGENT_NO_GLSLANG
 #    include "GLSLangUtils.hpp"
@@ -57,6 +59,10 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    auto* const pShaderCache = pRenderDeviceVk->GetShaderCache();
+
+    ShaderCache::Key CacheKey;
+
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
@@ -84,13 +90,37 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
             }
         }
 
+        bool LoadedFromCache = false;
+
+        // Looks up the SPIRV in the shader cache and copies it to m_SPIRV, if found
+        auto LoadFromCache = [&](const char* Source, size_t SourceLength, const char* CompilerName, std::initializer_list<Uint32> CompilerInfo) {
+            VERIFY_EXPR(pShaderCache != nullptr);
+            CacheKey = ShaderCache::ComputeKey(ShaderCI, Source, SourceLength, CompilerName, CompilerInfo);
+            if (auto pByteCode = pShaderCache->Find(CacheKey, ShaderCI.ppCompilerOutput))
+            {
+                VERIFY_EXPR(pByteCode->GetSize() % sizeof(uint32_t) == 0);
+                // Use the const pointer so that a blob referencing a mapped cache file is not copied twice
+                const auto* pWords = static_cast<const uint32_t*>(pByteCode->GetConstDataPtr());
+                m_SPIRV.assign(pWords, pWords + pByteCode->GetSize() / sizeof(uint32_t));
+                LoadedFromCache = !m_SPIRV.empty();
+            }
+        };
+
         switch (ShaderCompiler)
         {
             case SHADER_COMPILER_DXC:
             {
                 auto* pDXComiler = pRenderDeviceVk->GetDxCompiler();
                 VERIFY_EXPR(pDXComiler != nullptr && pDXComiler->IsLoaded());
-                pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
+                if (pShaderCache != nullptr)
+                {
+                    Uint32 MajorVersion = 0, MinorVersion = 0;
+                    pDXComiler->GetVersion(MajorVersion, MinorVersion);
+                    const auto HLSLSource = BuildHLSLSourceString(ShaderCI, VulkanDefine);
+                    LoadFromCache(HLSLSource.c_str(), HLSLSource.length(), "DXC", {MajorVersion, MinorVersion});
+                }
+                if (m_SPIRV.empty())
+                    pDXComiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
             }
             break;
 
@@ -102,7 +132,13 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
 #else
                 if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
                 {
-                    m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
+                    if (pShaderCache != nullptr)
+                    {
+                        const auto HLSLSource = BuildHLSLSourceString(ShaderCI, VulkanDefine);
+                        LoadFromCache(HLSLSource.c_str(), HLSLSource.length(), "glslang", {});
+                    }
+                    if (m_SPIRV.empty())
+                        m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
                 }
                 else
                 {
@@ -143,13 +179,18 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                     Attribs.AssignBindings             = true;
                     Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
                     Attribs.ppCompilerOutput           = ShaderCI.ppCompilerOutput;
+                    Attribs.OptimizationLevel          = ShaderCI.OptimizationLevel;
+                    Attribs.pCompileStats              = ShaderCI.pCompileStats;
 
                     if (VkVersion >= VK_API_VERSION_1_2)
                         Attribs.Version = GLSLangUtils::SpirvVersion::Vk120;
                     else if (VkVersion >= VK_API_VERSION_1_1)
                         Attribs.Version = ExtFeats.Spirv14 ? GLSLangUtils::SpirvVersion::Vk110_Spirv14 : GLSLangUtils::SpirvVersion::Vk110;
 
-                    m_SPIRV = GLSLangUtils::GLSLtoSPIRV(Attribs);
+                    if (pShaderCache != nullptr)
+                        LoadFromCache(ShaderSource, SourceLength, "glslang", {static_cast<Uint32>(Attribs.Version)});
+                    if (m_SPIRV.empty())
+                        m_SPIRV = GLSLangUtils::GLSLtoSPIRV(Attribs);
                 }
 #endif
                 break;
@@ -163,13 +204,18 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
         {
             LOG_ERROR_AND_THROW("Failed to compile shader '", ShaderCI.Desc.Name, '\'');
         }
+
+        if (pShaderCache != nullptr && !LoadedFromCache)
+            pShaderCache->Add(CacheKey, m_SPIRV.data(), m_SPIRV.size() * sizeof(uint32_t));
     }
     else if (ShaderCI.ByteCode != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCodeSize != 0, "ByteCodeSize must not be 0");
         DEV_CHECK_ERR(ShaderCI.ByteCodeSize % 4 == 0, "Byte code size (", ShaderCI.ByteCodeSize, ") is not multiple of 4");
-        m_SPIRV.resize(ShaderCI.ByteCodeSize / 4);
-        memcpy(m_SPIRV.data(), ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
+        const auto* pWords = static_cast<const uint32_t*>(ShaderCI.ByteCode);
+        m_SPIRV.assign(pWords, pWords + ShaderCI.ByteCodeSize / 4);
+        if (pShaderCache != nullptr)
+            CacheKey.AppendData(ShaderCI.ByteCode, ShaderCI.ByteCodeSize);
     }
     else
     {
@@ -180,18 +226,65 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     // pipeline state is created
 
     // Load shader resources
-    auto& Allocator        = GetRawAllocator();
-    auto* pRawMem          = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
-    auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources       = new (pRawMem) SPIRVShaderResources //
+    auto&       Allocator             = GetRawAllocator();
+    auto*       pRawMem               = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
+    auto        LoadShaderInputs      = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
+    const auto* CombinedSamplerSuffix = ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr;
+
+    // Reflection data is stored in the shader cache next to the byte code, so that
+    // SPIRV-Cross does not run again for the shaders that are found in the cache.
+    auto ReflectionKey = std::move(CacheKey);
+    if (pShaderCache != nullptr)
+    {
+        ReflectionKey.AppendString("Reflection");
+        ReflectionKey.AppendValues(static_cast<Uint32>(m_Desc.ShaderType), Uint32{LoadShaderInputs}, Uint32{SPIRVShaderResources::SerializationVersion});
+    }
+
+    SPIRVShaderResources* pResources = nullptr;
+    if (pShaderCache != nullptr)
+    {
+        if (auto pReflection = pShaderCache->Find(ReflectionKey))
         {
-            Allocator,
-            m_SPIRV,
-            m_Desc,
-            ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
-            LoadShaderInputs,
-            m_EntryPoint //
-        };
+            try
+            {
+                pResources = new (pRawMem) SPIRVShaderResources //
+                    {
+                        Allocator,
+                        pReflection->GetConstDataPtr(),
+                        pReflection->GetSize(),
+                        m_SPIRV,
+                        m_Desc,
+                        CombinedSamplerSuffix,
+                        m_EntryPoint //
+                    };
+            }
+            catch (...)
+            {
+                LOG_WARNING_MESSAGE("Failed to load cached reflection data of shader '", m_Desc.Name, "'. Resources will be reflected from SPIRV.");
+                m_EntryPoint.clear();
+            }
+        }
+    }
+
+    if (pResources == nullptr)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                m_SPIRV,
+                m_Desc,
+                CombinedSamplerSuffix,
+                LoadShaderInputs,
+                m_EntryPoint //
+            };
+
+        if (pShaderCache != nullptr)
+        {
+            std::vector<Uint8> Reflection;
+            pResources->Serialize(m_EntryPoint, Reflection);
+            pShaderCache->Add(ReflectionKey, Reflection.data(), Reflection.size());
+        }
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
     if (LoadShaderInputs && m_pShaderResources->IsHLSLSource())
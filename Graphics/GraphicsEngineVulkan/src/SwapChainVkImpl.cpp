@@ -46,6 +46,7 @@ SwapChainVkImpl::SwapChainVkImpl(IReferenceCounters*  pRefCounters,
     m_Window                     {Window},
     m_VulkanInstance             {pRenderDeviceVk->GetVulkanInstance()},
     m_DesiredBufferCount         {SCDesc.BufferCount},
+    m_MaxFrameLatency            {SCDesc.BufferCount},
     m_pBackBufferRTV             (STD_ALLOCATOR_RAW_MEM(RefCntAutoPtr<ITextureView>, GetRawAllocator(), "Allocator for vector<RefCntAutoPtr<ITextureView>>")),
     m_SwapChainImagesInitialized (STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>")),
     m_ImageAcquiredFenceSubmitted(STD_ALLOCATOR_RAW_MEM(bool, GetRawAllocator(), "Allocator for vector<bool>"))
@@ -469,6 +470,9 @@ void SwapChainVkImpl::CreateVulkanSwapChain()
     err = vkCreateSwapchainKHR(vkDevice, &swapchain_ci, NULL, &m_VkSwapChain);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to create Vulkan swapchain");
 
+    // Present ids are per swap chain
+    m_LastPresentId = 0;
+
     if (oldSwapchain != VK_NULL_HANDLE)
     {
         vkDestroySwapchainKHR(vkDevice, oldSwapchain, NULL);
@@ -706,12 +710,29 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
 
     pImmediateCtxVk->Flush();
 
+    // Similar to Direct3D, wait for the frame as late as possible if the application
+    // has not done this explicitly. By default, the latency is only limited by the number
+    // of swap chain images (see AcquireNextImage()).
+    if (!m_FrameWaited && m_MaxFrameLatency < m_SwapChainDesc.BufferCount)
+        WaitForFrame();
+    m_FrameWaited = false;
+
     if (!m_IsMinimized)
     {
         VkPresentInfoKHR PresentInfo = {};
 
         PresentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
         PresentInfo.pNext              = nullptr;
+
+        VkPresentIdKHR PresentId{};
+        if (pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().PresentWait.presentWait != VK_FALSE)
+        {
+            ++m_LastPresentId;
+            PresentId.sType          = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+            PresentId.swapchainCount = 1;
+            PresentId.pPresentIds    = &m_LastPresentId;
+            PresentInfo.pNext        = &PresentId;
+        }
         PresentInfo.waitSemaphoreCount = 1;
         // Unlike fences or events, the act of waiting for a semaphore also unsignals that semaphore (6.4.2)
         VkSemaphore WaitSemaphore[] = {m_DrawCompleteSemaphores[m_SemaphoreIndex]->Get()};
@@ -767,6 +788,63 @@ void SwapChainVkImpl::Present(Uint32 SyncInterval)
     }
 }
 
+void SwapChainVkImpl::SetMaximumFrameLatency(Uint32 MaxLatency)
+{
+    DEV_CHECK_ERR(MaxLatency > 0, "Maximum frame latency must not be zero");
+    m_MaxFrameLatency = std::max(MaxLatency, 1u);
+}
+
+void SwapChainVkImpl::WaitForFrame()
+{
+    m_FrameWaited = true;
+    if (m_IsMinimized || m_VkSwapChain == VK_NULL_HANDLE)
+        return;
+
+    const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
+    const auto  MaxLatency    = std::min(m_MaxFrameLatency, m_SwapChainDesc.BufferCount);
+
+    if (LogicalDevice.GetEnabledExtFeatures().PresentWait.presentWait != VK_FALSE)
+    {
+        // The next frame may be started when the frame that is MaxLatency frames behind it
+        // has been presented to the user.
+        //
+        //   MaxLatency = 2
+        //
+        //     N-2          N-1           N (Next frame)
+        //      |            |            |
+        //      |
+        //   Wait until this frame is presented
+        if (m_LastPresentId >= MaxLatency)
+        {
+            const auto WaitPresentId = m_LastPresentId + 1 - MaxLatency;
+
+            // 0.5 second timeout (shouldn't ever occur)
+            auto res = vkWaitForPresentKHR(LogicalDevice.GetVkDevice(), m_VkSwapChain, WaitPresentId, Uint64{500000000});
+            if (res == VK_TIMEOUT)
+                LOG_ERROR_MESSAGE("Timeout elapsed while waiting for the frame to be presented. This is a strong indication of a synchronization error.");
+            // VK_ERROR_OUT_OF_DATE_KHR and VK_ERROR_SURFACE_LOST_KHR are handled by the next Present()
+        }
+    }
+    else
+    {
+        // Without VK_KHR_present_wait, wait until the presentation engine has released the image
+        // of the frame that is MaxLatency - 1 frames behind the current one. The image for
+        // the current frame has already been requested at the end of the previous Present().
+        const auto NumFences = static_cast<Uint32>(m_ImageAcquiredFences.size());
+        const auto FenceInd  = (m_SemaphoreIndex + NumFences - (MaxLatency - 1)) % NumFences;
+        if (m_ImageAcquiredFenceSubmitted[FenceInd])
+        {
+            VkFence vkFence = m_ImageAcquiredFences[FenceInd];
+            if (LogicalDevice.GetFenceStatus(vkFence) == VK_NOT_READY)
+            {
+                auto res = LogicalDevice.WaitForFences(1, &vkFence, VK_TRUE, UINT64_MAX);
+                VERIFY_EXPR(res == VK_SUCCESS);
+                (void)res;
+            }
+        }
+    }
+}
+
 void SwapChainVkImpl::WaitForImageAcquiredFences()
 {
     const auto& LogicalDevice = m_pRenderDevice.RawPtr<RenderDeviceVkImpl>()->GetLogicalDevice();
@@ -51,6 +51,34 @@ TextureViewVkImpl::TextureViewVkImpl(IReferenceCounters*                 pRefCou
     m_ImageView{std::move(ImgView)}
 // clang-format on
 {
+    auto* pBindlessHeap = pDevice->GetBindlessHeap();
+    if (pBindlessHeap == nullptr)
+        return;
+
+    VkImageLayout vkLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    switch (ViewDesc.ViewType)
+    {
+        case TEXTURE_VIEW_SHADER_RESOURCE:
+            m_BindlessBinding = BindlessDescriptorHeapVk::BINDING_SAMPLED_IMAGE;
+            // The descriptor is written once, so the texture must be transitioned to
+            // RESOURCE_STATE_SHADER_RESOURCE before it is accessed through the heap.
+            vkLayout = (pTexture->GetDesc().BindFlags & BIND_DEPTH_STENCIL) ?
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL :
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            break;
+
+        case TEXTURE_VIEW_UNORDERED_ACCESS:
+            m_BindlessBinding = BindlessDescriptorHeapVk::BINDING_STORAGE_IMAGE;
+            vkLayout          = VK_IMAGE_LAYOUT_GENERAL;
+            break;
+
+        default:
+            return;
+    }
+
+    m_BindlessIndex = pBindlessHeap->AllocateIndex(m_BindlessBinding);
+    if (m_BindlessIndex != INVALID_BINDLESS_INDEX)
+        pBindlessHeap->WriteImage(m_BindlessBinding, m_BindlessIndex, m_ImageView, vkLayout);
 }
 
 TextureViewVkImpl::~TextureViewVkImpl()
@@ -67,7 +95,12 @@ TextureViewVkImpl::~TextureViewVkImpl()
 
     if (m_Desc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL || m_Desc.ViewType == TEXTURE_VIEW_RENDER_TARGET)
         m_pDevice->GetFramebufferCache().OnDestroyImageView(m_ImageView);
-    m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), m_pTexture->GetDesc().ImmediateContextMask);
+
+    const auto ImmediateContextMask = m_pTexture->GetDesc().ImmediateContextMask;
+    if (m_BindlessIndex != INVALID_BINDLESS_INDEX)
+        m_pDevice->GetBindlessHeap()->ReleaseIndex(m_BindlessBinding, m_BindlessIndex, ImmediateContextMask);
+
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), ImmediateContextMask);
 }
 
 } // namespace Diligent
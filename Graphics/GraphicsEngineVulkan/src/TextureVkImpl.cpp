@@ -30,6 +30,7 @@
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
 #include "TextureViewVkImpl.hpp"
+#include "ResourceHeapVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
 #include "EngineMemory.h"
 #include "StringTools.hpp"
@@ -42,7 +43,9 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                              FixedBlockMemoryAllocator& TexViewObjAllocator,
                              RenderDeviceVkImpl*        pRenderDeviceVk,
                              const TextureDesc&         TexDesc,
-                             const TextureData*         pInitData /*= nullptr*/) :
+                             const TextureData*         pInitData /*= nullptr*/,
+                             ResourceHeapVkImpl*        pHeap /*= nullptr*/,
+                             Uint64                     HeapOffset /*= 0*/) :
     // clang-format off
     TTextureBase
     {
@@ -56,162 +59,81 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
         LOG_ERROR_AND_THROW("Immutable textures must be initialized with data at creation time: pInitData can't be null");
 
+    const bool IsSparse = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE) != 0;
+    if (IsSparse && pInitData != nullptr && pInitData->pSubResources != nullptr)
+        LOG_ERROR_AND_THROW("Sparse textures can not be initialized with data at creation time");
+    if (IsSparse && pHeap != nullptr)
+        LOG_ERROR_AND_THROW("Sparse textures can not be placed in a resource heap");
+
+    const bool IsMemoryless = (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS) != 0;
+    if (IsMemoryless && pInitData != nullptr && pInitData->pSubResources != nullptr)
+        LOG_ERROR_AND_THROW("Memoryless textures can not be initialized with data at creation time");
+
     const auto& FmtAttribs    = GetTextureFormatAttribs(m_Desc.Format);
     const auto& LogicalDevice = pRenderDeviceVk->GetLogicalDevice();
 
-    const bool ImageView2DSupported =
-        (m_Desc.Type == RESOURCE_DIM_TEX_3D && LogicalDevice.GetEnabledExtFeatures().HasPortabilitySubset) ?
-        LogicalDevice.GetEnabledExtFeatures().PortabilitySubset.imageView2DOn3DImage == VK_TRUE :
-        true;
-
     if (m_Desc.Usage == USAGE_IMMUTABLE || m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_DYNAMIC)
     {
         VERIFY(m_Desc.Usage != USAGE_DYNAMIC || PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) <= 1,
                "ImmediateContextMask must contain single set bit, this error should've been handled in ValidateTextureDesc()");
 
-        VkImageCreateInfo ImageCI = {};
-
-        ImageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        ImageCI.pNext = nullptr;
-        ImageCI.flags = 0;
-        if (m_Desc.Type == RESOURCE_DIM_TEX_CUBE || m_Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
-            ImageCI.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
-        if (FmtAttribs.IsTypeless)
-            ImageCI.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT; // Specifies that the image can be used to create a
-                                                                 // VkImageView with a different format from the image.
-
-        if (m_Desc.Type == RESOURCE_DIM_TEX_1D || m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY)
-            ImageCI.imageType = VK_IMAGE_TYPE_1D;
-        else if (m_Desc.Type == RESOURCE_DIM_TEX_2D || m_Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY || m_Desc.Type == RESOURCE_DIM_TEX_CUBE || m_Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
-            ImageCI.imageType = VK_IMAGE_TYPE_2D;
-        else if (m_Desc.Type == RESOURCE_DIM_TEX_3D)
-        {
-            ImageCI.imageType = VK_IMAGE_TYPE_3D;
-            if (ImageView2DSupported)
-                ImageCI.flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
-        }
-        else
-        {
-            LOG_ERROR_AND_THROW("Unknown texture type");
-        }
-
-        TEXTURE_FORMAT InternalTexFmt = m_Desc.Format;
-        if (FmtAttribs.IsTypeless)
-        {
-            TEXTURE_VIEW_TYPE PrimaryViewType;
-            if (m_Desc.BindFlags & BIND_DEPTH_STENCIL)
-                PrimaryViewType = TEXTURE_VIEW_DEPTH_STENCIL;
-            else if (m_Desc.BindFlags & BIND_UNORDERED_ACCESS)
-                PrimaryViewType = TEXTURE_VIEW_UNORDERED_ACCESS;
-            else if (m_Desc.BindFlags & BIND_RENDER_TARGET)
-                PrimaryViewType = TEXTURE_VIEW_RENDER_TARGET;
-            else
-                PrimaryViewType = TEXTURE_VIEW_SHADER_RESOURCE;
-            InternalTexFmt = GetDefaultTextureViewFormat(m_Desc, PrimaryViewType);
-        }
-
-        ImageCI.format = TexFormatToVkFormat(InternalTexFmt);
+        std::vector<uint32_t> QueueFamilyIndices;
 
-        ImageCI.extent.width  = m_Desc.Width;
-        ImageCI.extent.height = (m_Desc.Type == RESOURCE_DIM_TEX_1D || m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY) ? 1 : m_Desc.Height;
-        ImageCI.extent.depth  = (m_Desc.Type == RESOURCE_DIM_TEX_3D) ? m_Desc.Depth : 1;
-
-        ImageCI.mipLevels = m_Desc.MipLevels;
-        if (m_Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY ||
-            m_Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ||
-            m_Desc.Type == RESOURCE_DIM_TEX_CUBE ||
-            m_Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
-            ImageCI.arrayLayers = m_Desc.ArraySize;
-        else
-            ImageCI.arrayLayers = 1;
+        const auto ImageCI = GetImageCreateInfo(pRenderDeviceVk, m_Desc, QueueFamilyIndices, &m_bCSBasedMipGenerationSupported);
 
-        ImageCI.samples = static_cast<VkSampleCountFlagBits>(m_Desc.SampleCount);
-        ImageCI.tiling  = VK_IMAGE_TILING_OPTIMAL;
+        m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
 
-        ImageCI.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        if (m_Desc.BindFlags & BIND_RENDER_TARGET)
-        {
-            // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearColorImage()
-            ImageCI.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-            DEV_CHECK_ERR(ImageView2DSupported, "imageView2DOn3DImage in VkPhysicalDevicePortabilitySubsetFeaturesKHR is not enabled, can not create render target with 2D image view");
-        }
-        if (m_Desc.BindFlags & BIND_DEPTH_STENCIL)
+        if (IsSparse)
         {
-            // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearDepthStencilImage()
-            ImageCI.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-            DEV_CHECK_ERR(ImageView2DSupported, "imageView2DOn3DImage in VkPhysicalDevicePortabilitySubsetFeaturesKHR is not enabled, can not create depth-stencil target with 2D image view");
+            // Sparse image has no memory backing. Memory is bound to its tiles by IDeviceContext::UpdateTileMappings().
+            InitSparseProperties();
         }
-        if (m_Desc.BindFlags & BIND_UNORDERED_ACCESS)
+        else if (pHeap != nullptr)
         {
-            ImageCI.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
-        }
-        if (m_Desc.BindFlags & BIND_SHADER_RESOURCE)
-        {
-            ImageCI.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+            // The image is placed in the heap memory that may be aliased by other resources.
+            // Placement range and alignment are validated by the heap.
+            VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+            if ((MemReqs.memoryTypeBits & (1u << pHeap->GetMemoryTypeIndex())) == 0)
+                LOG_ERROR_AND_THROW("Memory type of resource heap '", pHeap->GetDesc().Name, "' is not compatible with texture '", m_Desc.Name, "'");
+
+            auto err = LogicalDevice.BindImageMemory(m_VulkanImage, pHeap->GetVkDeviceMemory(), HeapOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
+
+            m_pHeap = pHeap;
         }
-        if (m_Desc.BindFlags & BIND_INPUT_ATTACHMENT)
+        else
         {
-            ImageCI.usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
-        }
+            bool                 DedicatedAllocation = false;
+            VkMemoryRequirements MemReqs             = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage, DedicatedAllocation);
 
-        if (m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS)
-        {
-            if (CheckCSBasedMipGenerationSupport(ImageCI.format) && ImageView2DSupported)
-            {
-                ImageCI.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
-                m_bCSBasedMipGenerationSupported = true;
-            }
-            else
+            VulkanUtilities::VulkanDedicatedResource DedicatedResource;
+            if (DedicatedAllocation)
+                DedicatedResource.Image = m_VulkanImage;
+
+            VkMemoryPropertyFlags ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            if (IsMemoryless)
             {
-                const auto& PhysicalDevice = pRenderDeviceVk->GetPhysicalDevice();
-                auto        FmtProperties  = PhysicalDevice.GetPhysicalDeviceFormatProperties(ImageCI.format);
-                (void)FmtProperties;
-                DEV_CHECK_ERR((FmtProperties.optimalTilingFeatures & (VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT)) == (VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT),
-                              "Texture format ", GetTextureFormatAttribs(InternalTexFmt).Name,
-                              " does not support blitting. Automatic mipmap generation can't be done neither by CS nor by blitting.");
-
-                DEV_CHECK_ERR((FmtProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0,
-                              "Texture format ", GetTextureFormatAttribs(InternalTexFmt).Name,
-                              " does not support linear filtering. Automatic mipmap generation can't be "
-                              "done neither by CS nor by blitting.");
+                // Use lazily allocated memory that tile-based GPUs never back with physical pages.
+                // Not all devices expose such memory type, in which case regular device-local memory is used.
+                constexpr VkMemoryPropertyFlags LazyMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+                if (pRenderDeviceVk->GetPhysicalDevice().GetMemoryTypeIndex(MemReqs.memoryTypeBits, LazyMemoryFlags) != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex)
+                    ImageMemoryFlags = LazyMemoryFlags;
             }
+            VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
+            // Images used only by contexts that run on a subset of the device group nodes are allocated on these nodes
+            const auto DeviceMask = pRenderDeviceVk->GetMemoryDeviceMask(m_Desc.ImmediateContextMask);
+            // Render targets and depth buffers are the last resources that should be demoted from video memory
+            auto MemoryPriority = m_Desc.MemoryPriority;
+            if (MemoryPriority == MEMORY_PRIORITY_DEFAULT && (m_Desc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL)) != 0)
+                MemoryPriority = MEMORY_PRIORITY_HIGH;
+            m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags, 0, DedicatedResource, DeviceMask, MemoryPriority);
+            auto AlignedOffset = AlignUp(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
+            VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
+            auto Memory = m_MemoryAllocation.Page->GetVkMemory();
+            auto err    = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
+            CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
         }
 
-        ImageCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
-        ImageCI.queueFamilyIndexCount = 0;
-        ImageCI.pQueueFamilyIndices   = nullptr;
-
-        const auto QueueFamilyIndices = PlatformMisc::CountOneBits(m_Desc.ImmediateContextMask) > 1 ?
-            GetDevice()->ConvertCmdQueueIdsToQueueFamilies(m_Desc.ImmediateContextMask) :
-            std::vector<uint32_t>{};
-        if (QueueFamilyIndices.size() > 1)
-        {
-            // If sharingMode is VK_SHARING_MODE_CONCURRENT, queueFamilyIndexCount must be greater than 1
-            ImageCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
-            ImageCI.pQueueFamilyIndices   = QueueFamilyIndices.data();
-            ImageCI.queueFamilyIndexCount = static_cast<uint32_t>(QueueFamilyIndices.size());
-        }
-
-        // initialLayout must be either VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED (11.4)
-        // If it is VK_IMAGE_LAYOUT_PREINITIALIZED, then the image data can be preinitialized by the host
-        // while using this layout, and the transition away from this layout will preserve that data.
-        // If it is VK_IMAGE_LAYOUT_UNDEFINED, then the contents of the data are considered to be undefined,
-        // and the transition away from this layout is not guaranteed to preserve that data.
-        ImageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-
-        m_VulkanImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
-
-        VkMemoryRequirements MemReqs = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
-
-        constexpr auto ImageMemoryFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-        VERIFY(IsPowerOfTwo(MemReqs.alignment), "Alignment is not power of 2!");
-        m_MemoryAllocation = pRenderDeviceVk->AllocateMemory(MemReqs, ImageMemoryFlags);
-        auto AlignedOffset = AlignUp(m_MemoryAllocation.UnalignedOffset, MemReqs.alignment);
-        VERIFY_EXPR(m_MemoryAllocation.Size >= MemReqs.size + (AlignedOffset - m_MemoryAllocation.UnalignedOffset));
-        auto Memory = m_MemoryAllocation.Page->GetVkMemory();
-        auto err    = LogicalDevice.BindImageMemory(m_VulkanImage, Memory, AlignedOffset);
-        CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
-
         if (pInitData != nullptr && pInitData->pSubResources != nullptr && pInitData->NumSubresources > 0)
             InitializeTextureContent(*pInitData, FmtAttribs, ImageCI);
         else
@@ -229,6 +151,197 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
     VERIFY_EXPR(IsInKnownState());
 }
 
+VkImageCreateInfo TextureVkImpl::GetImageCreateInfo(const RenderDeviceVkImpl* pDevice,
+                                                    const TextureDesc&        Desc,
+                                                    std::vector<uint32_t>&    QueueFamilyIndices,
+                                                    bool*                     pCSBasedMipGenerationSupported)
+{
+    const auto& FmtAttribs     = GetTextureFormatAttribs(Desc.Format);
+    const auto& LogicalDevice  = pDevice->GetLogicalDevice();
+    const auto& PhysicalDevice = pDevice->GetPhysicalDevice();
+
+    const bool ImageView2DSupported =
+        (Desc.Type == RESOURCE_DIM_TEX_3D && LogicalDevice.GetEnabledExtFeatures().HasPortabilitySubset) ?
+        LogicalDevice.GetEnabledExtFeatures().PortabilitySubset.imageView2DOn3DImage == VK_TRUE :
+        true;
+
+    if (pCSBasedMipGenerationSupported != nullptr)
+        *pCSBasedMipGenerationSupported = false;
+
+    VkImageCreateInfo ImageCI = {};
+
+    ImageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    ImageCI.pNext = nullptr;
+    ImageCI.flags = 0;
+    if (Desc.Type == RESOURCE_DIM_TEX_CUBE || Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+        ImageCI.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_SPARSE)
+        ImageCI.flags |= VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+    if (FmtAttribs.IsTypeless)
+        ImageCI.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT; // Specifies that the image can be used to create a
+                                                             // VkImageView with a different format from the image.
+
+    if (Desc.Type == RESOURCE_DIM_TEX_1D || Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY)
+        ImageCI.imageType = VK_IMAGE_TYPE_1D;
+    else if (Desc.Type == RESOURCE_DIM_TEX_2D || Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY || Desc.Type == RESOURCE_DIM_TEX_CUBE || Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+        ImageCI.imageType = VK_IMAGE_TYPE_2D;
+    else if (Desc.Type == RESOURCE_DIM_TEX_3D)
+    {
+        ImageCI.imageType = VK_IMAGE_TYPE_3D;
+        if (ImageView2DSupported)
+            ImageCI.flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+    }
+    else
+    {
+        LOG_ERROR_AND_THROW("Unknown texture type");
+    }
+
+    TEXTURE_FORMAT InternalTexFmt = Desc.Format;
+    if (FmtAttribs.IsTypeless)
+    {
+        TEXTURE_VIEW_TYPE PrimaryViewType;
+        if (Desc.BindFlags & BIND_DEPTH_STENCIL)
+            PrimaryViewType = TEXTURE_VIEW_DEPTH_STENCIL;
+        else if (Desc.BindFlags & BIND_UNORDERED_ACCESS)
+            PrimaryViewType = TEXTURE_VIEW_UNORDERED_ACCESS;
+        else if (Desc.BindFlags & BIND_RENDER_TARGET)
+            PrimaryViewType = TEXTURE_VIEW_RENDER_TARGET;
+        else
+            PrimaryViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+        InternalTexFmt = GetDefaultTextureViewFormat(Desc, PrimaryViewType);
+    }
+
+    ImageCI.format = TexFormatToVkFormat(InternalTexFmt);
+
+    ImageCI.extent.width  = Desc.Width;
+    ImageCI.extent.height = (Desc.Type == RESOURCE_DIM_TEX_1D || Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY) ? 1 : Desc.Height;
+    ImageCI.extent.depth  = (Desc.Type == RESOURCE_DIM_TEX_3D) ? Desc.Depth : 1;
+
+    ImageCI.mipLevels = Desc.MipLevels;
+    if (Desc.Type == RESOURCE_DIM_TEX_1D_ARRAY ||
+        Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ||
+        Desc.Type == RESOURCE_DIM_TEX_CUBE ||
+        Desc.Type == RESOURCE_DIM_TEX_CUBE_ARRAY)
+        ImageCI.arrayLayers = Desc.ArraySize;
+    else
+        ImageCI.arrayLayers = 1;
+
+    ImageCI.samples = static_cast<VkSampleCountFlagBits>(Desc.SampleCount);
+    ImageCI.tiling  = VK_IMAGE_TILING_OPTIMAL;
+
+    ImageCI.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (Desc.BindFlags & BIND_RENDER_TARGET)
+    {
+        // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearColorImage()
+        ImageCI.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        DEV_CHECK_ERR(ImageView2DSupported, "imageView2DOn3DImage in VkPhysicalDevicePortabilitySubsetFeaturesKHR is not enabled, can not create render target with 2D image view");
+    }
+    if (Desc.BindFlags & BIND_DEPTH_STENCIL)
+    {
+        // VK_IMAGE_USAGE_TRANSFER_DST_BIT is required for vkCmdClearDepthStencilImage()
+        ImageCI.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        DEV_CHECK_ERR(ImageView2DSupported, "imageView2DOn3DImage in VkPhysicalDevicePortabilitySubsetFeaturesKHR is not enabled, can not create depth-stencil target with 2D image view");
+    }
+    if (Desc.BindFlags & BIND_UNORDERED_ACCESS)
+    {
+        ImageCI.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+    if (Desc.BindFlags & BIND_SHADER_RESOURCE)
+    {
+        ImageCI.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    }
+    if (Desc.BindFlags & BIND_INPUT_ATTACHMENT)
+    {
+        ImageCI.usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    }
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_MEMORYLESS)
+    {
+        // Transient attachments can't be used with any other usage, including transfer operations,
+        // so memoryless textures can only be cleared by render pass load operations.
+        ImageCI.usage &= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        ImageCI.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
+
+    if (Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS)
+    {
+        if (CheckCSBasedMipGenerationSupport(Desc, PhysicalDevice, ImageCI.format) && ImageView2DSupported)
+        {
+            ImageCI.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+            if (pCSBasedMipGenerationSupported != nullptr)
+                *pCSBasedMipGenerationSupported = true;
+        }
+        else
+        {
+            auto FmtProperties = PhysicalDevice.GetPhysicalDeviceFormatProperties(ImageCI.format);
+            (void)FmtProperties;
+            DEV_CHECK_ERR((FmtProperties.optimalTilingFeatures & (VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT)) == (VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT),
+                          "Texture format ", GetTextureFormatAttribs(InternalTexFmt).Name,
+                          " does not support blitting. Automatic mipmap generation can't be done neither by CS nor by blitting.");
+
+            DEV_CHECK_ERR((FmtProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0,
+                          "Texture format ", GetTextureFormatAttribs(InternalTexFmt).Name,
+                          " does not support linear filtering. Automatic mipmap generation can't be "
+                          "done neither by CS nor by blitting.");
+        }
+    }
+
+    ImageCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    ImageCI.queueFamilyIndexCount = 0;
+    ImageCI.pQueueFamilyIndices   = nullptr;
+
+    QueueFamilyIndices.clear();
+    if (PlatformMisc::CountOneBits(Desc.ImmediateContextMask) > 1)
+        QueueFamilyIndices = pDevice->ConvertCmdQueueIdsToQueueFamilies(Desc.ImmediateContextMask);
+    if (QueueFamilyIndices.size() > 1)
+    {
+        // If sharingMode is VK_SHARING_MODE_CONCURRENT, queueFamilyIndexCount must be greater than 1
+        ImageCI.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+        ImageCI.pQueueFamilyIndices   = QueueFamilyIndices.data();
+        ImageCI.queueFamilyIndexCount = static_cast<uint32_t>(QueueFamilyIndices.size());
+    }
+
+    // initialLayout must be either VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED (11.4)
+    // If it is VK_IMAGE_LAYOUT_PREINITIALIZED, then the image data can be preinitialized by the host
+    // while using this layout, and the transition away from this layout will preserve that data.
+    // If it is VK_IMAGE_LAYOUT_UNDEFINED, then the contents of the data are considered to be undefined,
+    // and the transition away from this layout is not guaranteed to preserve that data.
+    ImageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    return ImageCI;
+}
+
+void TextureVkImpl::InitSparseProperties()
+{
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+
+    const auto MemReqs    = LogicalDevice.GetImageMemoryRequirements(m_VulkanImage);
+    const auto SparseReqs = LogicalDevice.GetImageSparseMemoryRequirements(m_VulkanImage);
+
+    const VkSparseImageMemoryRequirements* pColorReqs = nullptr;
+    for (const auto& Reqs : SparseReqs)
+    {
+        if (Reqs.formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+            pColorReqs = &Reqs;
+        else if (Reqs.formatProperties.aspectMask & VK_IMAGE_ASPECT_METADATA_BIT)
+            LOG_ERROR_AND_THROW("Sparse texture '", m_Desc.Name, "' requires metadata aspect, which is not supported");
+    }
+    if (pColorReqs == nullptr)
+        LOG_ERROR_AND_THROW("Format ", GetTextureFormatAttribs(m_Desc.Format).Name, " does not support sparse residency");
+
+    const auto& Granularity = pColorReqs->formatProperties.imageGranularity;
+
+    m_SparseProps.TileWidth       = Granularity.width;
+    m_SparseProps.TileHeight      = Granularity.height;
+    m_SparseProps.TileDepth       = Granularity.depth;
+    m_SparseProps.TileSizeInBytes = static_cast<Uint32>(MemReqs.alignment);
+    m_SparseProps.FirstMipInTail  = std::min(pColorReqs->imageMipTailFirstLod, m_Desc.MipLevels);
+    m_SparseProps.MipTailSize     = pColorReqs->imageMipTailSize;
+    m_SparseProps.MemorySize      = MemReqs.size;
+
+    m_SparseMipTailOffset = pColorReqs->imageMipTailOffset;
+    m_SparseMipTailStride = (pColorReqs->formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) ? 0 : pColorReqs->imageMipTailStride;
+}
+
 void TextureVkImpl::InitializeTextureContent(const TextureData&          InitData,
                                              const TextureFormatAttribs& FmtAttribs,
                                              const VkImageCreateInfo&    ImageCI)
@@ -242,10 +355,6 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     // Vulkan validation layers do not like uninitialized memory, so if no initial data
     // is provided, we will clear the memory
 
-    VulkanUtilities::CommandPoolWrapper CmdPool;
-    VkCommandBuffer                     vkCmdBuff;
-    GetDevice()->AllocateTransientCmdPool(CmdQueueInd, CmdPool, vkCmdBuff, "Transient command pool to copy staging data to a device buffer");
-
     VkImageAspectFlags aspectMask = 0;
     if (FmtAttribs.ComponentType == COMPONENT_TYPE_DEPTH)
         aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
@@ -266,8 +375,6 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     SubresRange.layerCount         = VK_REMAINING_ARRAY_LAYERS;
     SubresRange.baseMipLevel       = 0;
     SubresRange.levelCount         = VK_REMAINING_MIP_LEVELS;
-    const auto SupportedStagesMask = ~0u;
-    VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, SupportedStagesMask);
     SetState(RESOURCE_STATE_COPY_DEST);
     const auto CurrentLayout = GetLayout();
     VERIFY_EXPR(CurrentLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
@@ -386,21 +493,26 @@ void TextureVkImpl::InitializeTextureContent(const TextureData&          InitDat
     auto err = LogicalDevice.BindBufferMemory(StagingBuffer, StagingBufferMemory, AlignedStagingMemOffset);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind staging buffer memory");
 
-    VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, StagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, SupportedStagesMask);
-
-    // Copy commands MUST be recorded outside of a render pass instance. This is OK here
-    // as copy will be the only command in the cmd buffer
-    vkCmdCopyBufferToImage(vkCmdBuff, StagingBuffer, m_VulkanImage,
-                           CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
-                           static_cast<uint32_t>(Regions.size()), Regions.data());
-
-    GetDevice()->ExecuteAndDisposeTransientCmdBuff(CmdQueueInd, vkCmdBuff, std::move(CmdPool));
-
-    // After command buffer is submitted, safe-release resources. This strategy
-    // is little overconservative as the resources will be released after the first
-    // command buffer submitted through the immediate context will be completed
-    GetDevice()->SafeReleaseDeviceObject(std::move(StagingBuffer), Uint64{1} << Uint64{CmdQueueInd});
-    GetDevice()->SafeReleaseDeviceObject(std::move(StagingMemoryAllocation), Uint64{1} << Uint64{CmdQueueInd});
+    // All commands are recorded into the shared command buffer that is submitted together with
+    // initial data uploads of other resources. The staging data is prepared beforehand to keep
+    // the batch locked only while the commands are recorded. The batch takes ownership of the
+    // staging resources and releases them once the GPU completes the copy.
+    const VkBuffer vkStagingBuffer = StagingBuffer;
+    GetDevice()->RecordInitialDataUpload(
+        CmdQueueInd, std::move(StagingBuffer), std::move(StagingMemoryAllocation),
+        [&](VkCommandBuffer vkCmdBuff) //
+        {
+            const auto SupportedStagesMask = ~0u;
+            VulkanUtilities::VulkanCommandBuffer::TransitionImageLayout(vkCmdBuff, m_VulkanImage, ImageCI.initialLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange, SupportedStagesMask);
+            VulkanUtilities::VulkanCommandBuffer::BufferMemoryBarrier(vkCmdBuff, vkStagingBuffer, 0, VK_ACCESS_TRANSFER_READ_BIT, SupportedStagesMask);
+
+            // Copy commands MUST be recorded outside of a render pass instance. This is OK here
+            // as the batch command buffer only contains copy commands
+            vkCmdCopyBufferToImage(vkCmdBuff, vkStagingBuffer, m_VulkanImage,
+                                   CurrentLayout, // dstImageLayout must be VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL or VK_IMAGE_LAYOUT_GENERAL (18.4)
+                                   static_cast<uint32_t>(Regions.size()), Regions.data());
+        });
+    m_bInitialDataUploadRecorded = true;
 }
 
 void TextureVkImpl::CreateStagingTexture(const TextureData* pInitData, const TextureFormatAttribs& FmtAttribs)
@@ -537,7 +649,7 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
         if ((UpdatedViewDesc.Flags & TEXTURE_VIEW_FLAG_ALLOW_MIP_MAP_GENERATION) != 0 &&
             m_bCSBasedMipGenerationSupported &&
-            CheckCSBasedMipGenerationSupport(TexFormatToVkFormat(pViewVk->GetDesc().Format)))
+            CheckCSBasedMipGenerationSupport(m_Desc, m_pDevice->GetPhysicalDevice(), TexFormatToVkFormat(pViewVk->GetDesc().Format)))
         {
             auto* pMipLevelViews = ALLOCATE(GetRawAllocator(), "Raw memory for mip level views", TextureViewVkImpl::MipLevelViewAutoPtrType, UpdatedViewDesc.NumMipLevels * 2);
             for (Uint32 MipLevel = 0; MipLevel < UpdatedViewDesc.NumMipLevels; ++MipLevel)
@@ -571,12 +683,6 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
                 CreateMipLevelView(TEXTURE_VIEW_UNORDERED_ACCESS, MipLevel, &pMipLevelViews[MipLevel * 2 + 1]);
             }
 
-            if (auto pImmediateCtx = m_pDevice->GetImmediateContext(PlatformMisc::GetLSB(m_Desc.ImmediateContextMask)))
-            {
-                auto& GenerateMipsHelper = pImmediateCtx.RawPtr<DeviceContextVkImpl>()->GetGenerateMipsHelper();
-                GenerateMipsHelper.WarmUpCache(pViewVk->GetDesc().Format);
-            }
-
             pViewVk->AssignMipLevelViews(pMipLevelViews);
         }
     }
@@ -589,6 +695,11 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
 TextureVkImpl::~TextureVkImpl()
 {
+    // The copy may still be pending in the upload batch. Submit the batch so that the image
+    // is released with a fence value that is greater than the one of the batch.
+    if (m_bInitialDataUploadRecorded)
+        m_pDevice->FlushInitialDataUploads();
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     // Wrappers for external texture will not be destroyed as they are created with null device pointer
     if (m_VulkanImage)
@@ -750,14 +861,15 @@ VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc
     return LogicalDevice.CreateImageView(ImageViewCI, ViewName.c_str());
 }
 
-bool TextureVkImpl::CheckCSBasedMipGenerationSupport(VkFormat vkFmt) const
+bool TextureVkImpl::CheckCSBasedMipGenerationSupport(const TextureDesc&                           Desc,
+                                                     const VulkanUtilities::VulkanPhysicalDevice& PhysicalDevice,
+                                                     VkFormat                                     vkFmt)
 {
 #if !DILIGENT_NO_GLSLANG
-    VERIFY_EXPR(m_Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS);
-    if (m_Desc.Type == RESOURCE_DIM_TEX_2D || m_Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY)
+    VERIFY_EXPR(Desc.MiscFlags & MISC_TEXTURE_FLAG_GENERATE_MIPS);
+    if (Desc.Type == RESOURCE_DIM_TEX_2D || Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY)
     {
-        const auto& PhysicalDevice = m_pDevice->GetPhysicalDevice();
-        auto        FmtProperties  = PhysicalDevice.GetPhysicalDeviceFormatProperties(vkFmt);
+        auto FmtProperties = PhysicalDevice.GetPhysicalDeviceFormatProperties(vkFmt);
         if ((FmtProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0)
         {
             return true;
@@ -31,6 +31,7 @@
 
 #include <chrono>
 #include <thread>
+#include <string>
 
 #include "RenderDeviceVkImpl.hpp"
 
@@ -56,6 +57,13 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
 // clang-format on
 {
     VERIFY((Size & (MasterBlockAlignment - 1)) == 0, "Heap size (", Size, " is not aligned by the master block alignment (", Uint32{MasterBlockAlignment}, ")");
+    // The buffer is created by the first AllocateMasterBlock() call, so that devices
+    // that never use dynamic resources do not reserve the memory.
+}
+
+void VulkanDynamicMemoryManager::CreateBuffer()
+{
+    const auto Size = GetSize();
 
     VkBufferCreateInfo VkBuffCI{};
     VkBuffCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -69,25 +77,47 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+    const auto& LogicalDevice = m_DeviceVk.GetLogicalDevice();
+
+    // In descriptor buffer mode, dynamic descriptor sets are written to the dynamic heap
+    // and the buffer is bound as a descriptor buffer.
+    const bool UseDescriptorBuffer = LogicalDevice.GetEnabledExtFeatures().DescriptorBuffer.descriptorBuffer != VK_FALSE;
+    if (UseDescriptorBuffer)
+    {
+        VkBuffCI.usage |=
+            VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
+            VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    }
     VkBuffCI.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
     VkBuffCI.queueFamilyIndexCount = 0;
     VkBuffCI.pQueueFamilyIndices   = nullptr;
 
-    const auto& LogicalDevice    = DeviceVk.GetLogicalDevice();
     m_VkBuffer                   = LogicalDevice.CreateBuffer(VkBuffCI, "Dynamic heap buffer");
     VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VkBuffer);
 
-    const auto& PhysicalDevice = DeviceVk.GetPhysicalDevice();
+    const auto& PhysicalDevice = m_DeviceVk.GetPhysicalDevice();
 
     VkMemoryAllocateInfo MemAlloc{};
     MemAlloc.pNext          = nullptr;
     MemAlloc.sType          = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize = MemReqs.size;
 
+    VkMemoryAllocateFlagsInfo FlagsInfo{};
+    if (UseDescriptorBuffer)
+    {
+        FlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        FlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        MemAlloc.pNext  = &FlagsInfo;
+    }
+
     // VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit specifies that the host cache management commands vkFlushMappedMemoryRanges
     // and vkInvalidateMappedMemoryRanges are NOT needed to flush host writes to the device or make device writes visible
     // to the host (10.2)
-    MemAlloc.memoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    // If the budget allows, the buffer is placed in device-local host-visible memory, so that the GPU
+    // reads dynamic constants and vertices from video memory. The CPU only writes to the buffer.
+    MemAlloc.memoryTypeIndex = m_DeviceVk.GetUploadMemoryTypeIndex(MemReqs.memoryTypeBits, MemReqs.size);
 
     VERIFY(MemAlloc.memoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
            "Vulkan spec requires that for a VkBuffer not created with the "
@@ -95,7 +125,9 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
            "corresponding to a VkMemoryType with a propertyFlags that has both the VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT bit "
            "and the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT bit set(11.6)");
 
-    m_BufferMemory = LogicalDevice.AllocateDeviceMemory(MemAlloc, "Host-visible memory for upload buffer");
+    const bool IsDeviceLocal = (PhysicalDevice.GetMemoryProperties().memoryTypes[MemAlloc.memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0;
+
+    m_BufferMemory = LogicalDevice.AllocateDeviceMemory(MemAlloc, IsDeviceLocal ? "Device-local host-visible memory for dynamic buffer" : "Host-visible memory for dynamic buffer");
 
     void* Data = nullptr;
 
@@ -111,7 +143,14 @@ VulkanDynamicMemoryManager::VulkanDynamicMemoryManager(IMemoryAllocator&   Alloc
     err = LogicalDevice.BindBufferMemory(m_VkBuffer, m_BufferMemory, 0 /*offset*/);
     CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
 
-    LOG_INFO_MESSAGE("GPU dynamic heap created. Total buffer size: ", FormatMemorySize(Size, 2));
+    if (UseDescriptorBuffer)
+        m_DeviceAddress = LogicalDevice.GetBufferDeviceAddress(m_VkBuffer);
+
+    if (IsDeviceLocal)
+        m_DeviceLocalSize.store(MemAlloc.allocationSize);
+
+    LOG_INFO_MESSAGE("GPU dynamic heap created. Total buffer size: ", FormatMemorySize(Size, 2),
+                     (IsDeviceLocal ? " (device-local memory)" : " (host memory)"));
 }
 
 void VulkanDynamicMemoryManager::Destroy()
@@ -122,7 +161,9 @@ void VulkanDynamicMemoryManager::Destroy()
         m_DeviceVk.SafeReleaseDeviceObject(std::move(m_VkBuffer), m_CommandQueueMask);
         m_DeviceVk.SafeReleaseDeviceObject(std::move(m_BufferMemory), m_CommandQueueMask);
     }
-    m_CPUAddress = nullptr;
+    m_CPUAddress    = nullptr;
+    m_DeviceAddress = 0;
+    m_DeviceLocalSize.store(0);
 }
 
 VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
@@ -134,12 +175,16 @@ VulkanDynamicMemoryManager::~VulkanDynamicMemoryManager()
                      FormatMemorySize(Size, 2),
                      ". Peak allocated size: ", FormatMemorySize(m_TotalPeakSize, 2, Size),
                      ". Peak utilization: ",
-                     std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize) / static_cast<double>(std::max(Size, size_t{1})) * 100.0, '%');
+                     std::fixed, std::setprecision(1), static_cast<double>(m_TotalPeakSize) / static_cast<double>(std::max(Size, size_t{1})) * 100.0, '%',
+                     (m_NumFailedAllocations > 0 ? ". Failed allocations: " : ""),
+                     (m_NumFailedAllocations > 0 ? std::to_string(m_NumFailedAllocations) : std::string{}));
 }
 
 
 VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMasterBlock(OffsetType SizeInBytes, OffsetType Alignment)
 {
+    std::call_once(m_BufferCreatedFlag, &VulkanDynamicMemoryManager::CreateBuffer, this);
+
     if (Alignment == 0)
         Alignment = MasterBlockAlignment;
 
@@ -211,14 +256,43 @@ VulkanDynamicMemoryManager::MasterBlock VulkanDynamicMemoryManager::AllocateMast
         }
     }
 
-    if (Block.IsValid())
     {
-        m_TotalPeakSize = std::max(m_TotalPeakSize, GetUsedSize());
+        std::lock_guard<std::mutex> Lock{m_StatsMtx};
+        if (Block.IsValid())
+        {
+            const auto UsedSize = GetUsedSize();
+            m_TotalPeakSize     = std::max(m_TotalPeakSize, UsedSize);
+            m_FramePeakSize     = std::max(m_FramePeakSize, UsedSize);
+        }
+        else
+        {
+            ++m_NumFailedAllocations;
+        }
     }
 
     return Block;
 }
 
+void VulkanDynamicMemoryManager::OnFinishFrame()
+{
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    m_LastFramePeakSize = m_FramePeakSize;
+    // Blocks of the previous frames that are still used by the GPU count towards the next frame
+    m_FramePeakSize = GetUsedSize();
+    ++m_NumFrames;
+}
+
+void VulkanDynamicMemoryManager::GetStatistics(DynamicHeapStatistics& Stats)
+{
+    std::lock_guard<std::mutex> Lock{m_StatsMtx};
+    Stats.Size                 = GetSize();
+    Stats.UsedSize             = GetUsedSize();
+    Stats.LastFramePeakSize    = m_LastFramePeakSize;
+    Stats.PeakSize             = m_TotalPeakSize;
+    Stats.NumFrames            = m_NumFrames;
+    Stats.NumFailedAllocations = m_NumFailedAllocations;
+}
+
 
 VulkanDynamicAllocation VulkanDynamicHeap::Allocate(Uint32 SizeInBytes, Uint32 Alignment)
 {
@@ -1870,6 +1870,22 @@ VkQueueGlobalPriorityEXT QueuePriorityToVkQueueGlobalPriority(QUEUE_PRIORITY Pri
     }
 }
 
+float MemoryPriorityToVkMemoryPriority(MEMORY_PRIORITY Priority)
+{
+    static_assert(MEMORY_PRIORITY_LAST == 2, "Please update the switch below to handle the new memory priority");
+    switch (Priority)
+    {
+        // clang-format off
+        case MEMORY_PRIORITY_DEFAULT: return 0.5f;
+        case MEMORY_PRIORITY_LOW:     return 0.25f;
+        case MEMORY_PRIORITY_HIGH:    return 1.0f;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected memory priority");
+            return 0.5f;
+    }
+}
+
 DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t                                                          vkVersion,
                                           const VkPhysicalDeviceFeatures&                                   vkFeatures,
                                           const VulkanUtilities::VulkanPhysicalDevice::ExtensionFeatures&   ExtFeatures,
@@ -1894,6 +1910,7 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
     Features.BinaryOcclusionQueries        = DEVICE_FEATURE_STATE_ENABLED;
     Features.TimestampQueries              = DEVICE_FEATURE_STATE_ENABLED;
     Features.DurationQueries               = DEVICE_FEATURE_STATE_ENABLED;
+    Features.SpecializationConstants       = DEVICE_FEATURE_STATE_ENABLED;
 
     // clang-format off
     INIT_FEATURE(GeometryShaders,                   vkFeatures.geometryShader);
@@ -1910,6 +1927,7 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
     INIT_FEATURE(VertexPipelineUAVWritesAndAtomics, vkFeatures.vertexPipelineStoresAndAtomics);
     INIT_FEATURE(PixelUAVWritesAndAtomics,          vkFeatures.fragmentStoresAndAtomics);
     INIT_FEATURE(TextureUAVExtendedFormats,         vkFeatures.shaderStorageImageExtendedFormats);
+    INIT_FEATURE(SparseResources,                   vkFeatures.sparseBinding != VK_FALSE && vkFeatures.sparseResidencyImage2D != VK_FALSE && vkFeatures.sparseResidencyBuffer != VK_FALSE);
     // clang-format on
 
     const auto& MeshShaderFeats = ExtFeatures.MeshShader;
@@ -1965,11 +1983,20 @@ DeviceFeatures VkFeaturesToDeviceFeatures(uint32_t
     INIT_FEATURE(NativeFence,
                  TimelineSemaphoreFeats.timelineSemaphore != VK_FALSE);
 
+    INIT_FEATURE(DynamicPipelineStates,
+                 ExtFeatures.ExtendedDynamicState.extendedDynamicState != VK_FALSE);
+
+    INIT_FEATURE(BufferDeviceAddress,
+                 ExtFeatures.BufferDeviceAddress.bufferDeviceAddress != VK_FALSE);
+
+    INIT_FEATURE(ConditionalRendering,
+                 ExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE);
+
     INIT_FEATURE(TileShaders, false); // Not currently supported
 #undef INIT_FEATURE
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 37, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
+    static_assert(sizeof(DeviceFeatures) == 42, "Did you add a new feature to DeviceFeatures? Please handle its satus here (if necessary).");
 #endif
 
     return Features;
@@ -34,11 +34,13 @@ namespace Diligent
 
 VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
                                    std::string         HeapName,
-                                   VkDeviceSize        PageSize) :
+                                   VkDeviceSize        PageSize,
+                                   VkDeviceSize        MaxRetainedSize) :
     // clang-format off
-    m_RenderDevice {RenderDevice       },
-    m_HeapName     {std::move(HeapName)},
-    m_PageSize     {PageSize           }
+    m_RenderDevice   {RenderDevice       },
+    m_HeapName       {std::move(HeapName)},
+    m_PageSize       {PageSize           },
+    m_MaxRetainedSize{MaxRetainedSize    }
 // clang-format on
 {
 }
@@ -46,6 +48,13 @@ VulkanUploadHeap::VulkanUploadHeap(RenderDeviceVkImpl& RenderDevice,
 VulkanUploadHeap::~VulkanUploadHeap()
 {
     DEV_CHECK_ERR(m_Pages.empty(), "Upload heap '", m_HeapName, "' not all pages are released");
+    for (auto& Retained : m_RetainedPages)
+    {
+        const auto QueueMask = Uint64{1} << Uint64{Retained.QueueId};
+        m_RenderDevice.SafeReleaseDeviceObject(std::move(Retained.Page.MemAllocation), QueueMask);
+        m_RenderDevice.SafeReleaseDeviceObject(std::move(Retained.Page.Buffer), QueueMask);
+    }
+
     auto PeakAllocatedPages = m_PeakAllocatedSize / m_PageSize;
     LOG_INFO_MESSAGE(m_HeapName, " peak used/allocated frame size: ", FormatMemorySize(m_PeakFrameSize, 2, m_PeakAllocatedSize),
                      " / ", FormatMemorySize(m_PeakAllocatedSize, 2),
@@ -54,6 +63,8 @@ VulkanUploadHeap::~VulkanUploadHeap()
 
 VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize SizeInBytes) const
 {
+    DILIGENT_PROFILE_SCOPE("VulkanUploadHeap::CreateNewPage");
+
     VkBufferCreateInfo StagingBufferCI{};
     StagingBufferCI.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     StagingBufferCI.pNext                 = nullptr;
@@ -65,12 +76,12 @@ VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize Si
     StagingBufferCI.pQueueFamilyIndices   = nullptr;
 
     const auto& LogicalDevice   = m_RenderDevice.GetLogicalDevice();
-    const auto& PhysicalDevice  = m_RenderDevice.GetPhysicalDevice();
     auto&       GlobalMemoryMgr = m_RenderDevice.GetGlobalMemoryManager();
 
     auto NewBuffer       = LogicalDevice.CreateBuffer(StagingBufferCI, "Upload buffer");
     auto MemReqs         = LogicalDevice.GetBufferMemoryRequirements(NewBuffer);
-    auto MemoryTypeIndex = PhysicalDevice.GetMemoryTypeIndex(MemReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    // When the page is placed in device-local memory, copies to the destination resources do not read system memory
+    auto MemoryTypeIndex = m_RenderDevice.GetUploadMemoryTypeIndex(MemReqs.memoryTypeBits, MemReqs.size);
     DEV_CHECK_ERR(MemoryTypeIndex != VulkanUtilities::VulkanPhysicalDevice::InvalidMemoryTypeIndex,
                   "Vulkan spec requires that for a VkBuffer not created with the VK_BUFFER_CREATE_SPARSE_BINDING_BIT "
                   "bit set, or for a VkImage that was created with a VK_IMAGE_TILING_LINEAR value in the tiling member "
@@ -86,7 +97,28 @@ VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::CreateNewPage(VkDeviceSize Si
     (void)err;
     auto CPUAddress = reinterpret_cast<Uint8*>(MemAllocation.Page->GetCPUMemory()) + AlignedOffset;
 
-    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress};
+    return UploadPageInfo{std::move(MemAllocation), std::move(NewBuffer), CPUAddress, SizeInBytes};
+}
+
+VulkanUploadHeap::UploadPageInfo VulkanUploadHeap::AcquirePage(VkDeviceSize SizeInBytes)
+{
+    auto BestFit = m_RetainedPages.end();
+    for (auto it = m_RetainedPages.begin(); it != m_RetainedPages.end(); ++it)
+    {
+        if (it->Page.Size < SizeInBytes || (BestFit != m_RetainedPages.end() && it->Page.Size >= BestFit->Page.Size))
+            continue;
+
+        if (it->FenceValue <= m_RenderDevice.GetCompletedFenceValue(it->QueueId))
+            BestFit = it;
+    }
+
+    if (BestFit == m_RetainedPages.end())
+        return CreateNewPage(SizeInBytes);
+
+    auto Page = std::move(BestFit->Page);
+    m_RetainedPages.erase(BestFit);
+    m_RetainedSize -= Page.Size;
+    return Page;
 }
 
 VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDeviceSize Alignment)
@@ -96,8 +128,8 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
     VulkanUploadAllocation Allocation;
     if (SizeInBytes >= m_PageSize / 2)
     {
-        // Allocate large chunk directly from the memory manager
-        auto NewPage          = CreateNewPage(SizeInBytes);
+        // Allocate large chunk directly from the memory manager, or reuse a retained page
+        auto NewPage          = AcquirePage(SizeInBytes);
         Allocation.vkBuffer   = NewPage.Buffer;
         Allocation.CPUAddress = NewPage.CPUAddress;
         Allocation.Size       = SizeInBytes;
@@ -112,8 +144,8 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
         if (m_CurrPage.AvailableSize < SizeInBytes + AlignmentOffset)
         {
             // Allocate new page
-            auto NewPage = CreateNewPage(m_PageSize);
-            m_CurrPage.Reset(NewPage, m_PageSize);
+            auto NewPage = AcquirePage(m_PageSize);
+            m_CurrPage.Reset(NewPage, NewPage.Size);
             m_CurrAllocatedSize += NewPage.MemAllocation.Size;
             m_Pages.emplace_back(std::move(NewPage));
             VERIFY_EXPR((m_CurrPage.CurrOffset & (Alignment - 1)) == 0);
@@ -138,10 +170,29 @@ VulkanUploadAllocation VulkanUploadHeap::Allocate(VkDeviceSize SizeInBytes, VkDe
 
 void VulkanUploadHeap::ReleaseAllocatedPages(Uint64 CmdQueueMask)
 {
+    // Pages can only be retained if they were used by a single queue, in which case
+    // the last command buffer that references them has the last submitted fence value.
+    const bool RetainPages = m_MaxRetainedSize != 0 && PlatformMisc::CountOneBits(CmdQueueMask) == 1;
+
+    SoftwareQueueIndex QueueId{0};
+    Uint64             FenceValue = 0;
+    if (RetainPages)
+    {
+        QueueId    = SoftwareQueueIndex{PlatformMisc::GetLSB(CmdQueueMask)};
+        FenceValue = m_RenderDevice.GetNextFenceValue(QueueId) - 1;
+    }
+
     // The pages will go into the stale resources queue first, however they will move into the release
     // queue rightaway when RenderDeviceVkImpl::FlushStaleResources() is called by the DeviceContextVkImpl::FinishFrame()
     for (auto& Page : m_Pages)
     {
+        if (RetainPages && m_RetainedSize + Page.Size <= m_MaxRetainedSize)
+        {
+            m_RetainedSize += Page.Size;
+            m_RetainedPages.emplace_back(std::move(Page), QueueId, FenceValue);
+            continue;
+        }
+
         m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.MemAllocation), CmdQueueMask);
         m_RenderDevice.SafeReleaseDeviceObject(std::move(Page.Buffer), CmdQueueMask);
     }
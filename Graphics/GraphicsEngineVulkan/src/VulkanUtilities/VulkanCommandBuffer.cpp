@@ -146,6 +146,11 @@ static VkPipelineStageFlags PipelineStageFromAccessFlags(VkAccessFlags AccessFla
                 Stages |= VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
                 break;
 
+            // Read access to a predicate as part of conditional rendering.
+            case VK_ACCESS_CONDITIONAL_RENDERING_READ_BIT_EXT:
+                Stages |= VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
+                break;
+
             default:
                 UNEXPECTED("Unknown memory access flag");
         }
@@ -251,33 +256,26 @@ static VkAccessFlags AccessMaskFromImageLayout(VkImageLayout Layout,
     return AccessMask;
 }
 
-} // namespace
-
-
-void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
-                                                VkImage                        Image,
-                                                VkImageLayout                  OldLayout,
-                                                VkImageLayout                  NewLayout,
-                                                const VkImageSubresourceRange& SubresRange,
-                                                VkPipelineStageFlags           SupportedStagesMask,
-                                                VkPipelineStageFlags           SrcStages,
-                                                VkPipelineStageFlags           DestStages)
+void InitImageMemoryBarrier(VkImageMemoryBarrier&          ImgBarrier,
+                            VkImage                        Image,
+                            VkImageLayout                  OldLayout,
+                            VkImageLayout                  NewLayout,
+                            const VkImageSubresourceRange& SubresRange,
+                            VkPipelineStageFlags           SupportedStagesMask,
+                            VkPipelineStageFlags&          SrcStages,
+                            VkPipelineStageFlags&          DestStages)
 {
-    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
-
-    VkImageMemoryBarrier ImgBarrier = {};
-    ImgBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    ImgBarrier.pNext                = nullptr;
-    ImgBarrier.srcAccessMask        = 0;
-    ImgBarrier.dstAccessMask        = 0;
-    ImgBarrier.oldLayout            = OldLayout;
-    ImgBarrier.newLayout            = NewLayout;
-    ImgBarrier.srcQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED; // source queue family for a queue family ownership transfer.
-    ImgBarrier.dstQueueFamilyIndex  = VK_QUEUE_FAMILY_IGNORED; // destination queue family for a queue family ownership transfer.
-    ImgBarrier.image                = Image;
-    ImgBarrier.subresourceRange     = SubresRange;
-    ImgBarrier.srcAccessMask        = AccessMaskFromImageLayout(OldLayout, false);
-    ImgBarrier.dstAccessMask        = AccessMaskFromImageLayout(NewLayout, true);
+    ImgBarrier                     = {};
+    ImgBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    ImgBarrier.pNext               = nullptr;
+    ImgBarrier.oldLayout           = OldLayout;
+    ImgBarrier.newLayout           = NewLayout;
+    ImgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // source queue family for a queue family ownership transfer.
+    ImgBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // destination queue family for a queue family ownership transfer.
+    ImgBarrier.image               = Image;
+    ImgBarrier.subresourceRange    = SubresRange;
+    ImgBarrier.srcAccessMask       = AccessMaskFromImageLayout(OldLayout, false);
+    ImgBarrier.dstAccessMask       = AccessMaskFromImageLayout(NewLayout, true);
 
     if (SrcStages == 0)
     {
@@ -332,44 +330,26 @@ void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                C
     // synchronization scope includes logically later pipeline stages.
     // However, note that access scopes are not affected in this way - only the precise stages specified
     // are considered part of each access scope.  (6.1.2)
-
-    vkCmdPipelineBarrier(CmdBuffer,
-                         SrcStages,  // must not be 0
-                         DestStages, // must not be 0
-                         0,          // a bitmask specifying how execution and memory dependencies are formed
-                         0,          // memoryBarrierCount
-                         nullptr,    // pMemoryBarriers
-                         0,          // bufferMemoryBarrierCount
-                         nullptr,    // pBufferMemoryBarriers
-                         1,
-                         &ImgBarrier);
-    // Each element of pMemoryBarriers, pBufferMemoryBarriers and pImageMemoryBarriers must not
-    // have any access flag included in its srcAccessMask member if that bit is not supported by
-    // any of the pipeline stages in srcStageMask.
-    // Each element of pMemoryBarriers, pBufferMemoryBarriers and pImageMemoryBarriers must not
-    // have any access flag included in its dstAccessMask member if that bit is not supported by any
-    // of the pipeline stages in dstStageMask (6.6)
 }
 
-
-void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
-                                              VkBuffer             Buffer,
-                                              VkAccessFlags        srcAccessMask,
-                                              VkAccessFlags        dstAccessMask,
-                                              VkPipelineStageFlags SupportedStagesMask,
-                                              VkPipelineStageFlags SrcStages,
-                                              VkPipelineStageFlags DestStages)
+void InitBufferMemoryBarrier(VkBufferMemoryBarrier& BuffBarrier,
+                             VkBuffer               Buffer,
+                             VkAccessFlags          srcAccessMask,
+                             VkAccessFlags          dstAccessMask,
+                             VkPipelineStageFlags   SupportedStagesMask,
+                             VkPipelineStageFlags&  SrcStages,
+                             VkPipelineStageFlags&  DestStages)
 {
-    VkBufferMemoryBarrier BuffBarrier = {};
-    BuffBarrier.sType                 = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    BuffBarrier.pNext                 = nullptr;
-    BuffBarrier.srcAccessMask         = srcAccessMask;
-    BuffBarrier.dstAccessMask         = dstAccessMask;
-    BuffBarrier.srcQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.dstQueueFamilyIndex   = VK_QUEUE_FAMILY_IGNORED;
-    BuffBarrier.buffer                = Buffer;
-    BuffBarrier.offset                = 0;
-    BuffBarrier.size                  = VK_WHOLE_SIZE;
+    BuffBarrier                     = {};
+    BuffBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    BuffBarrier.pNext               = nullptr;
+    BuffBarrier.srcAccessMask       = srcAccessMask;
+    BuffBarrier.dstAccessMask       = dstAccessMask;
+    BuffBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    BuffBarrier.buffer              = Buffer;
+    BuffBarrier.offset              = 0;
+    BuffBarrier.size                = VK_WHOLE_SIZE;
     if (SrcStages == 0)
     {
         if (BuffBarrier.srcAccessMask != 0)
@@ -391,31 +371,20 @@ void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
     SrcStages &= SupportedStagesMask;
     DestStages &= SupportedStagesMask;
     VERIFY(SrcStages != 0 && DestStages != 0, "Stage mask must not be 0");
-
-    vkCmdPipelineBarrier(CmdBuffer,
-                         SrcStages,    // must not be 0
-                         DestStages,   // must not be 0
-                         0,            // a bitmask specifying how execution and memory dependencies are formed
-                         0,            // memoryBarrierCount
-                         nullptr,      // pMemoryBarriers
-                         1,            // bufferMemoryBarrierCount
-                         &BuffBarrier, // pBufferMemoryBarriers
-                         0,
-                         nullptr);
 }
 
-void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
-                                          VkAccessFlags        srcAccessMask,
-                                          VkAccessFlags        dstAccessMask,
-                                          VkPipelineStageFlags SupportedStagesMask,
-                                          VkPipelineStageFlags SrcStages,
-                                          VkPipelineStageFlags DestStages)
+void InitASMemoryBarrier(VkMemoryBarrier&      Barrier,
+                         VkAccessFlags         srcAccessMask,
+                         VkAccessFlags         dstAccessMask,
+                         VkPipelineStageFlags  SupportedStagesMask,
+                         VkPipelineStageFlags& SrcStages,
+                         VkPipelineStageFlags& DestStages)
 {
-    VkMemoryBarrier Barrier = {};
-    Barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-    Barrier.pNext           = nullptr;
-    Barrier.srcAccessMask   = srcAccessMask;
-    Barrier.dstAccessMask   = dstAccessMask;
+    Barrier               = {};
+    Barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    Barrier.pNext         = nullptr;
+    Barrier.srcAccessMask = srcAccessMask;
+    Barrier.dstAccessMask = dstAccessMask;
 
     if (SrcStages == 0)
     {
@@ -441,6 +410,153 @@ void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
     SrcStages &= (SupportedStagesMask & RayTracingStagesMask);
     DestStages &= (SupportedStagesMask & RayTracingStagesMask);
     VERIFY(SrcStages != 0 && DestStages != 0, "Stage mask must not be 0");
+}
+
+inline bool SubresourceRangesOverlap(const VkImageSubresourceRange& Range0, const VkImageSubresourceRange& Range1)
+{
+    if ((Range0.aspectMask & Range1.aspectMask) == 0)
+        return false;
+
+    const auto RangeEnd = [](uint32_t Base, uint32_t Count) {
+        return Count == VK_REMAINING_MIP_LEVELS ? ~0u : Base + Count;
+    };
+    static_assert(VK_REMAINING_MIP_LEVELS == VK_REMAINING_ARRAY_LAYERS, "Range end computation relies on equal values");
+
+    return Range0.baseMipLevel < RangeEnd(Range1.baseMipLevel, Range1.levelCount) &&
+        Range1.baseMipLevel < RangeEnd(Range0.baseMipLevel, Range0.levelCount) &&
+        Range0.baseArrayLayer < RangeEnd(Range1.baseArrayLayer, Range1.layerCount) &&
+        Range1.baseArrayLayer < RangeEnd(Range0.baseArrayLayer, Range0.layerCount);
+}
+
+} // namespace
+
+
+void VulkanCommandBuffer::TransitionImageLayout(VkCommandBuffer                CmdBuffer,
+                                                VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           SupportedStagesMask,
+                                                VkPipelineStageFlags           SrcStages,
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(CmdBuffer != VK_NULL_HANDLE);
+
+    VkImageMemoryBarrier ImgBarrier;
+    InitImageMemoryBarrier(ImgBarrier, Image, OldLayout, NewLayout, SubresRange, SupportedStagesMask, SrcStages, DestStages);
+
+    vkCmdPipelineBarrier(CmdBuffer,
+                         SrcStages,  // must not be 0
+                         DestStages, // must not be 0
+                         0,          // a bitmask specifying how execution and memory dependencies are formed
+                         0,          // memoryBarrierCount
+                         nullptr,    // pMemoryBarriers
+                         0,          // bufferMemoryBarrierCount
+                         nullptr,    // pBufferMemoryBarriers
+                         1,
+                         &ImgBarrier);
+    // Each element of pMemoryBarriers, pBufferMemoryBarriers and pImageMemoryBarriers must not
+    // have any access flag included in its srcAccessMask member if that bit is not supported by
+    // any of the pipeline stages in srcStageMask.
+    // Each element of pMemoryBarriers, pBufferMemoryBarriers and pImageMemoryBarriers must not
+    // have any access flag included in its dstAccessMask member if that bit is not supported by any
+    // of the pipeline stages in dstStageMask (6.6)
+}
+
+void VulkanCommandBuffer::TransitionImageLayout(VkImage                        Image,
+                                                VkImageLayout                  OldLayout,
+                                                VkImageLayout                  NewLayout,
+                                                const VkImageSubresourceRange& SubresRange,
+                                                VkPipelineStageFlags           SrcStages,
+                                                VkPipelineStageFlags           DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (IsInsideRenderPass())
+    {
+        // Image layout transitions within a render pass execute
+        // dependencies between attachments
+        EndRenderPass();
+    }
+
+    // Barriers recorded by a single vkCmdPipelineBarrier are not ordered with respect to each other,
+    // so a pending barrier that affects the same subresources must be recorded first.
+    for (const auto& PendingBarrier : m_ImageBarriers)
+    {
+        if (PendingBarrier.image == Image && SubresourceRangesOverlap(PendingBarrier.subresourceRange, SubresRange))
+        {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    m_ImageBarriers.emplace_back();
+    InitImageMemoryBarrier(m_ImageBarriers.back(), Image, OldLayout, NewLayout, SubresRange, m_SupportedStagesMask, SrcStages, DestStages);
+    m_BarrierSrcStages |= SrcStages;
+    m_BarrierDstStages |= DestStages;
+}
+
+
+void VulkanCommandBuffer::BufferMemoryBarrier(VkCommandBuffer      CmdBuffer,
+                                              VkBuffer             Buffer,
+                                              VkAccessFlags        srcAccessMask,
+                                              VkAccessFlags        dstAccessMask,
+                                              VkPipelineStageFlags SupportedStagesMask,
+                                              VkPipelineStageFlags SrcStages,
+                                              VkPipelineStageFlags DestStages)
+{
+    VkBufferMemoryBarrier BuffBarrier;
+    InitBufferMemoryBarrier(BuffBarrier, Buffer, srcAccessMask, dstAccessMask, SupportedStagesMask, SrcStages, DestStages);
+
+    vkCmdPipelineBarrier(CmdBuffer,
+                         SrcStages,    // must not be 0
+                         DestStages,   // must not be 0
+                         0,            // a bitmask specifying how execution and memory dependencies are formed
+                         0,            // memoryBarrierCount
+                         nullptr,      // pMemoryBarriers
+                         1,            // bufferMemoryBarrierCount
+                         &BuffBarrier, // pBufferMemoryBarriers
+                         0,
+                         nullptr);
+}
+
+void VulkanCommandBuffer::BufferMemoryBarrier(VkBuffer             Buffer,
+                                              VkAccessFlags        srcAccessMask,
+                                              VkAccessFlags        dstAccessMask,
+                                              VkPipelineStageFlags SrcStages,
+                                              VkPipelineStageFlags DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (IsInsideRenderPass())
+    {
+        // Image layout transitions within a render pass execute
+        // dependencies between attachments
+        EndRenderPass();
+    }
+
+    for (const auto& PendingBarrier : m_BufferBarriers)
+    {
+        if (PendingBarrier.buffer == Buffer)
+        {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    m_BufferBarriers.emplace_back();
+    InitBufferMemoryBarrier(m_BufferBarriers.back(), Buffer, srcAccessMask, dstAccessMask, m_SupportedStagesMask, SrcStages, DestStages);
+    m_BarrierSrcStages |= SrcStages;
+    m_BarrierDstStages |= DestStages;
+}
+
+void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
+                                          VkAccessFlags        srcAccessMask,
+                                          VkAccessFlags        dstAccessMask,
+                                          VkPipelineStageFlags SupportedStagesMask,
+                                          VkPipelineStageFlags SrcStages,
+                                          VkPipelineStageFlags DestStages)
+{
+    VkMemoryBarrier Barrier;
+    InitASMemoryBarrier(Barrier, srcAccessMask, dstAccessMask, SupportedStagesMask, SrcStages, DestStages);
 
     vkCmdPipelineBarrier(CmdBuffer,
                          SrcStages,  // must not be 0
@@ -454,8 +570,109 @@ void VulkanCommandBuffer::ASMemoryBarrier(VkCommandBuffer      CmdBuffer,
                          nullptr);
 }
 
-void VulkanCommandBuffer::FlushBarriers()
+void VulkanCommandBuffer::ASMemoryBarrier(VkAccessFlags        srcAccessMask,
+                                          VkAccessFlags        dstAccessMask,
+                                          VkPipelineStageFlags SrcStages,
+                                          VkPipelineStageFlags DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    if (IsInsideRenderPass())
+    {
+        // Image layout transitions within a render pass execute
+        // dependencies between attachments
+        EndRenderPass();
+    }
+
+    VkMemoryBarrier Barrier;
+    InitASMemoryBarrier(Barrier, srcAccessMask, dstAccessMask, m_SupportedStagesMask, SrcStages, DestStages);
+
+    // Global memory barriers are merged into a single one
+    m_MemoryBarrier.srcAccessMask |= Barrier.srcAccessMask;
+    m_MemoryBarrier.dstAccessMask |= Barrier.dstAccessMask;
+    m_BarrierSrcStages |= SrcStages;
+    m_BarrierDstStages |= DestStages;
+}
+
+void VulkanCommandBuffer::GlobalMemoryBarrier(VkAccessFlags        srcAccessMask,
+                                              VkAccessFlags        dstAccessMask,
+                                              VkPipelineStageFlags SrcStages,
+                                              VkPipelineStageFlags DestStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(!IsInsideRenderPass(), "Global memory barriers are not allowed inside a render pass");
+
+    SrcStages &= m_SupportedStagesMask;
+    DestStages &= m_SupportedStagesMask;
+    VERIFY(SrcStages != 0 && DestStages != 0, "Stage mask must not be 0");
+
+    m_MemoryBarrier.srcAccessMask |= srcAccessMask;
+    m_MemoryBarrier.dstAccessMask |= dstAccessMask;
+    m_BarrierSrcStages |= SrcStages;
+    m_BarrierDstStages |= DestStages;
+}
+
+void VulkanCommandBuffer::RecordPendingBarriers(uint32_t EventCount, const VkEvent* pEvents, VkPipelineStageFlags EventSrcStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY(!IsInsideRenderPass(), "Barriers must not be pending inside a render pass");
+
+    const bool     HasMemoryBarrier = (m_MemoryBarrier.srcAccessMask | m_MemoryBarrier.dstAccessMask) != 0;
+    const uint32_t NumBuffBarriers  = static_cast<uint32_t>(m_BufferBarriers.size());
+    const uint32_t NumImgBarriers   = static_cast<uint32_t>(m_ImageBarriers.size());
+
+    if (EventCount == 0)
+    {
+        VERIFY_EXPR(m_BarrierSrcStages != 0 && m_BarrierDstStages != 0);
+        vkCmdPipelineBarrier(m_VkCmdBuffer,
+                             m_BarrierSrcStages,
+                             m_BarrierDstStages,
+                             0,
+                             HasMemoryBarrier ? 1 : 0,
+                             HasMemoryBarrier ? &m_MemoryBarrier : nullptr,
+                             NumBuffBarriers,
+                             NumBuffBarriers != 0 ? m_BufferBarriers.data() : nullptr,
+                             NumImgBarriers,
+                             NumImgBarriers != 0 ? m_ImageBarriers.data() : nullptr);
+    }
+    else
+    {
+        // srcStageMask must be the bitwise OR of the stageMask parameter used in previous
+        // calls to vkCmdSetEvent with any of the elements of pEvents (6.5.8)
+        VERIFY_EXPR(EventSrcStages != 0);
+        vkCmdWaitEvents(m_VkCmdBuffer,
+                        EventCount,
+                        pEvents,
+                        EventSrcStages,
+                        m_BarrierDstStages != 0 ? m_BarrierDstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                        HasMemoryBarrier ? 1 : 0,
+                        HasMemoryBarrier ? &m_MemoryBarrier : nullptr,
+                        NumBuffBarriers,
+                        NumBuffBarriers != 0 ? m_BufferBarriers.data() : nullptr,
+                        NumImgBarriers,
+                        NumImgBarriers != 0 ? m_ImageBarriers.data() : nullptr);
+    }
+
+    ClearPendingBarriers();
+}
+
+void VulkanCommandBuffer::WaitEvents(uint32_t EventCount, const VkEvent* pEvents, VkPipelineStageFlags SrcStages)
+{
+    VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+    VERIFY_EXPR(EventCount > 0 && pEvents != nullptr);
+    if (IsInsideRenderPass())
+        EndRenderPass();
+
+    RecordPendingBarriers(EventCount, pEvents, SrcStages & m_SupportedStagesMask);
+}
+
+void VulkanCommandBuffer::ClearPendingBarriers()
 {
+    m_ImageBarriers.clear();
+    m_BufferBarriers.clear();
+    m_MemoryBarrier.srcAccessMask = 0;
+    m_MemoryBarrier.dstAccessMask = 0;
+    m_BarrierSrcStages            = 0;
+    m_BarrierDstStages            = 0;
 }
 
 } // namespace VulkanUtilities
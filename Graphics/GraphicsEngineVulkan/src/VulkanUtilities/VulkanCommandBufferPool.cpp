@@ -58,30 +58,42 @@ VulkanCommandBufferPool::~VulkanCommandBufferPool()
                   "buffers in release queues, VulkanCommandBufferPool::RecycleCommandBuffer() will crash when attempting to "
                   "return the buffer to the pool.");
 
-    for (auto CmdBuff : m_CmdBuffers)
-        m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+    for (auto* pLists : {&m_FreeCmdBuffers, &m_ReturnedCmdBuffers})
+    {
+        for (auto CmdBuff : pLists->Primary)
+            m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+        for (auto CmdBuff : pLists->Secondary)
+            m_LogicalDevice->FreeCommandBuffer(m_CmdPool, CmdBuff);
+    }
     m_CmdPool.Release();
 }
 
-VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
+VkCommandBuffer VulkanCommandBufferPool::AllocateCommandBuffer(VkCommandBufferLevel Level)
 {
     VkCommandBuffer CmdBuffer = VK_NULL_HANDLE;
 
+    auto& FreeCmdBuffers = m_FreeCmdBuffers.Get(Level);
+    if (FreeCmdBuffers.empty())
     {
-        std::lock_guard<std::mutex> Lock{m_Mutex};
-
-        if (!m_CmdBuffers.empty())
-        {
-            CmdBuffer = m_CmdBuffers.front();
-            auto err  = vkResetCommandBuffer(
-                CmdBuffer,
-                0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
-                  // owned by the command buffer should be returned to the parent command pool.
-            );
-            DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
-            (void)err;
-            m_CmdBuffers.pop_front();
-        }
+        // Take all command buffers returned since the last time. The lock is only held for the swap.
+        std::lock_guard<std::mutex> Lock{m_ReturnedCmdBuffersMtx};
+        FreeCmdBuffers.swap(m_ReturnedCmdBuffers.Get(Level));
+    }
+
+    if (!FreeCmdBuffers.empty())
+    {
+        CmdBuffer = FreeCmdBuffers.back();
+        FreeCmdBuffers.pop_back();
+
+        // The pool is created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, so the buffer
+        // keeps the memory it used last time and recording into it does not allocate.
+        auto err = vkResetCommandBuffer(
+            CmdBuffer,
+            0 // VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT -  specifies that most or all memory resources currently
+              // owned by the command buffer should be returned to the parent command pool.
+        );
+        DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to reset command buffer");
+        (void)err;
     }
 
     // If no cmd buffers were ready to be reused, create a new one
@@ -92,21 +104,30 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
         BuffAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         BuffAllocInfo.pNext              = nullptr;
         BuffAllocInfo.commandPool        = m_CmdPool;
-        BuffAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        BuffAllocInfo.level              = Level;
         BuffAllocInfo.commandBufferCount = 1;
 
         CmdBuffer = m_LogicalDevice->AllocateVkCommandBuffer(BuffAllocInfo);
         DEV_CHECK_ERR(CmdBuffer != VK_NULL_HANDLE, "Failed to allocate vulkan command buffer");
     }
 
+    return CmdBuffer;
+}
+
+VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName, VkCommandBufferUsageFlags UsageFlags)
+{
+    auto CmdBuffer = AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
     VkCommandBufferBeginInfo CmdBuffBeginInfo = {};
 
     CmdBuffBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     CmdBuffBeginInfo.pNext = nullptr;
-    CmdBuffBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT; // Each recording of the command buffer will only be
-                                                                          // submitted once, and the command buffer will be reset
-                                                                          // and recorded again between each submission.
-    CmdBuffBeginInfo.pInheritanceInfo = nullptr;                          // Ignored for a primary command buffer
+    CmdBuffBeginInfo.flags = UsageFlags; // VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT: each recording of the command buffer
+                                         // will only be submitted once, and the command buffer will be reset and recorded
+                                         // again between each submission.
+                                         // VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT: the command buffer can be resubmitted
+                                         // while it is in the pending state.
+    CmdBuffBeginInfo.pInheritanceInfo = nullptr; // Ignored for a primary command buffer
 
     auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
     DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin command buffer");
@@ -117,10 +138,35 @@ VkCommandBuffer VulkanCommandBufferPool::GetCommandBuffer(const char* DebugName)
     return CmdBuffer;
 }
 
-void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer)
+VkCommandBuffer VulkanCommandBufferPool::GetSecondaryCommandBuffer(const VkCommandBufferInheritanceInfo& InheritanceInfo)
+{
+    VERIFY_EXPR(InheritanceInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    VERIFY(InheritanceInfo.renderPass != VK_NULL_HANDLE, "Secondary command buffers must continue a render pass");
+
+    auto CmdBuffer = AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+    VkCommandBufferBeginInfo CmdBuffBeginInfo = {};
+
+    CmdBuffBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    CmdBuffBeginInfo.pNext = nullptr;
+    CmdBuffBeginInfo.flags =
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |     // The command buffer will only be executed once
+        VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT; // The command buffer is entirely inside a render pass
+    CmdBuffBeginInfo.pInheritanceInfo = &InheritanceInfo;
+
+    auto err = vkBeginCommandBuffer(CmdBuffer, &CmdBuffBeginInfo);
+    DEV_CHECK_ERR(err == VK_SUCCESS, "Failed to begin secondary command buffer");
+    (void)err;
+#ifdef DILIGENT_DEVELOPMENT
+    ++m_BuffCounter;
+#endif
+    return CmdBuffer;
+}
+
+void VulkanCommandBufferPool::RecycleCommandBuffer(VkCommandBuffer&& CmdBuffer, VkCommandBufferLevel Level)
 {
-    std::lock_guard<std::mutex> Lock{m_Mutex};
-    m_CmdBuffers.emplace_back(CmdBuffer);
+    std::lock_guard<std::mutex> Lock{m_ReturnedCmdBuffersMtx};
+    m_ReturnedCmdBuffers.Get(Level).emplace_back(CmdBuffer);
     CmdBuffer = VK_NULL_HANDLE;
 #ifdef DILIGENT_DEVELOPMENT
     --m_BuffCounter;
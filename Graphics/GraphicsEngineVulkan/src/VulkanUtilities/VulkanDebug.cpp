@@ -425,6 +425,16 @@ void SetAccelStructName(VkDevice device, VkAccelerationStructureKHR accelStruct,
     SetObjectName(device, (uint64_t)accelStruct, VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, name);
 }
 
+void SetPipelineCacheName(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetObjectName(device, (uint64_t)pipelineCache, VK_OBJECT_TYPE_PIPELINE_CACHE, name);
+}
+
+void SetDescrUpdateTemplateName(VkDevice device, VkDescriptorUpdateTemplate descrUpdateTemplate, const char* name)
+{
+    SetObjectName(device, (uint64_t)descrUpdateTemplate, VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, name);
+}
+
 
 template <>
 void SetVulkanObjectName<VkCommandPool, VulkanHandleTypeId::CommandPool>(VkDevice device, VkCommandPool cmdPool, const char* name)
@@ -558,6 +568,18 @@ void SetVulkanObjectName<VkAccelerationStructureKHR, VulkanHandleTypeId::Acceler
     SetAccelStructName(device, accelStruct, name);
 }
 
+template <>
+void SetVulkanObjectName<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(VkDevice device, VkPipelineCache pipelineCache, const char* name)
+{
+    SetPipelineCacheName(device, pipelineCache, name);
+}
+
+template <>
+void SetVulkanObjectName<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(VkDevice device, VkDescriptorUpdateTemplate descrUpdateTemplate, const char* name)
+{
+    SetDescrUpdateTemplateName(device, descrUpdateTemplate, name);
+}
+
 
 const char* VkResultToString(VkResult errorCode)
 {
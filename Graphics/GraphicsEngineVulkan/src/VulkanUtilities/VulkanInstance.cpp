@@ -398,4 +398,48 @@ VkPhysicalDevice VulkanInstance::SelectPhysicalDevice(uint32_t AdapterId) const
     return SelectedPhysicalDevice;
 }
 
+std::vector<VkPhysicalDevice> VulkanInstance::GetPhysicalDeviceGroup(VkPhysicalDevice PhysicalDevice) const
+{
+    std::vector<VkPhysicalDevice> GroupDevices{PhysicalDevice};
+
+#if DILIGENT_USE_VOLK
+    if (m_VkVersion < VK_API_VERSION_1_1 || vkEnumeratePhysicalDeviceGroups == nullptr)
+        return GroupDevices;
+
+    uint32_t GroupCount = 0;
+
+    auto err = vkEnumeratePhysicalDeviceGroups(m_VkInstance, &GroupCount, nullptr);
+    CHECK_VK_ERROR(err, "Failed to get physical device group count");
+    if (err != VK_SUCCESS || GroupCount == 0)
+        return GroupDevices;
+
+    std::vector<VkPhysicalDeviceGroupProperties> Groups(GroupCount);
+    for (auto& Group : Groups)
+        Group.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GROUP_PROPERTIES;
+
+    err = vkEnumeratePhysicalDeviceGroups(m_VkInstance, &GroupCount, Groups.data());
+    CHECK_VK_ERROR(err, "Failed to enumerate physical device groups");
+    if (err != VK_SUCCESS)
+        return GroupDevices;
+
+    for (uint32_t g = 0; g < GroupCount; ++g)
+    {
+        const auto& Group = Groups[g];
+
+        const auto* const DevicesEnd = Group.physicalDevices + Group.physicalDeviceCount;
+        if (std::find(Group.physicalDevices, DevicesEnd, PhysicalDevice) == DevicesEnd)
+            continue;
+
+        for (uint32_t d = 0; d < Group.physicalDeviceCount; ++d)
+        {
+            if (Group.physicalDevices[d] != PhysicalDevice)
+                GroupDevices.push_back(Group.physicalDevices[d]);
+        }
+        break;
+    }
+#endif
+
+    return GroupDevices;
+}
+
 } // namespace VulkanUtilities
@@ -37,9 +37,10 @@ namespace VulkanUtilities
 std::shared_ptr<VulkanLogicalDevice> VulkanLogicalDevice::Create(const VulkanPhysicalDevice&  PhysicalDevice,
                                                                  const VkDeviceCreateInfo&    DeviceCI,
                                                                  const ExtensionFeatures&     EnabledExtFeatures,
-                                                                 const VkAllocationCallbacks* vkAllocator)
+                                                                 const VkAllocationCallbacks* vkAllocator,
+                                                                 bool                         LoadDeviceEntries)
 {
-    auto* LogicalDevice = new VulkanLogicalDevice{PhysicalDevice, DeviceCI, EnabledExtFeatures, vkAllocator};
+    auto* LogicalDevice = new VulkanLogicalDevice{PhysicalDevice, DeviceCI, EnabledExtFeatures, vkAllocator, LoadDeviceEntries};
     return std::shared_ptr<VulkanLogicalDevice>{LogicalDevice};
 }
 
@@ -51,7 +52,8 @@ VulkanLogicalDevice::~VulkanLogicalDevice()
 VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDevice,
                                          const VkDeviceCreateInfo&    DeviceCI,
                                          const ExtensionFeatures&     EnabledExtFeatures,
-                                         const VkAllocationCallbacks* vkAllocator) :
+                                         const VkAllocationCallbacks* vkAllocator,
+                                         bool                         LoadDeviceEntries) :
     m_VkAllocator{vkAllocator},
     m_EnabledFeatures{*DeviceCI.pEnabledFeatures},
     m_EnabledExtFeatures{EnabledExtFeatures}
@@ -60,9 +62,13 @@ VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDe
     CHECK_VK_ERROR_AND_THROW(res, "Failed to create logical device");
 
 #if DILIGENT_USE_VOLK
-    // Since we only use one device at this time, load device function entries
+    // When only one device is used, load device function entries.
+    // Otherwise, device functions go through the loader dispatch that works for all devices.
     // https://github.com/zeux/volk#optimizing-device-calls
-    volkLoadDevice(m_VkDevice);
+    if (LoadDeviceEntries)
+        volkLoadDevice(m_VkDevice);
+#else
+    (void)LoadDeviceEntries;
 #endif
 
     auto GraphicsStages =
@@ -85,6 +91,8 @@ VulkanLogicalDevice::VulkanLogicalDevice(const VulkanPhysicalDevice&  PhysicalDe
         GraphicsStages |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_NV | VK_PIPELINE_STAGE_MESH_SHADER_BIT_NV;
     if (m_EnabledExtFeatures.RayTracingPipeline.rayTracingPipeline != VK_FALSE)
         ComputeStages |= VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR | VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR;
+    if (m_EnabledExtFeatures.ConditionalRendering.conditionalRendering != VK_FALSE)
+        GraphicsStages |= VK_PIPELINE_STAGE_CONDITIONAL_RENDERING_BIT_EXT;
 
     const auto QueueCount = PhysicalDevice.GetQueueProperties().size();
     m_SupportedStagesMask.resize(QueueCount, 0);
@@ -330,6 +338,12 @@ SemaphoreWrapper VulkanLogicalDevice::CreateTimelineSemaphore(uint64_t InitialVa
     return CreateVulkanObject<VkSemaphore, VulkanHandleTypeId::Semaphore>(vkCreateSemaphore, SemaphoreCI, DebugName, "timeline semaphore");
 }
 
+EventWrapper VulkanLogicalDevice::CreateEvent(const VkEventCreateInfo& EventCI, const char* DebugName) const
+{
+    VERIFY_EXPR(EventCI.sType == VK_STRUCTURE_TYPE_EVENT_CREATE_INFO);
+    return CreateVulkanObject<VkEvent, VulkanHandleTypeId::Event>(vkCreateEvent, EventCI, DebugName, "event");
+}
+
 QueryPoolWrapper VulkanLogicalDevice::CreateQueryPool(const VkQueryPoolCreateInfo& QueryPoolCI, const char* DebugName) const
 {
     VERIFY_EXPR(QueryPoolCI.sType == VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO);
@@ -347,6 +361,26 @@ AccelStructWrapper VulkanLogicalDevice::CreateAccelStruct(const VkAccelerationSt
 #endif
 }
 
+PipelineCacheWrapper VulkanLogicalDevice::CreatePipelineCache(const VkPipelineCacheCreateInfo& CI, const char* DebugName) const
+{
+    VERIFY_EXPR(CI.sType == VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO);
+    return CreateVulkanObject<VkPipelineCache, VulkanHandleTypeId::PipelineCache>(vkCreatePipelineCache, CI, DebugName, "pipeline cache");
+}
+
+DescrUpdateTemplateWrapper VulkanLogicalDevice::CreateDescriptorUpdateTemplate(const VkDescriptorUpdateTemplateCreateInfo& CI, const char* DebugName) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY_EXPR(CI.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO);
+    VERIFY(m_EnabledExtFeatures.DescriptorUpdateTemplate, "Descriptor update templates are not enabled");
+    // The function is core in Vulkan 1.1; fall back to the KHR entry point otherwise
+    auto CreateFunc = vkCreateDescriptorUpdateTemplate != nullptr ? vkCreateDescriptorUpdateTemplate : vkCreateDescriptorUpdateTemplateKHR;
+    return CreateVulkanObject<VkDescriptorUpdateTemplate, VulkanHandleTypeId::DescriptorUpdateTemplate>(CreateFunc, CI, DebugName, "descriptor update template");
+#else
+    UNSUPPORTED("vkCreateDescriptorUpdateTemplate is only available through Volk");
+    return DescrUpdateTemplateWrapper{};
+#endif
+}
+
 VkCommandBuffer VulkanLogicalDevice::AllocateVkCommandBuffer(const VkCommandBufferAllocateInfo& AllocInfo, const char* DebugName) const
 {
     VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO);
@@ -386,6 +420,27 @@ VkDescriptorSet VulkanLogicalDevice::AllocateVkDescriptorSet(const VkDescriptorS
     return DescrSet;
 }
 
+bool VulkanLogicalDevice::AllocateVkDescriptorSets(const VkDescriptorSetAllocateInfo& AllocInfo, VkDescriptorSet* pSets, const char* DebugName) const
+{
+    VERIFY_EXPR(AllocInfo.sType == VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO);
+    VERIFY_EXPR(pSets != nullptr);
+
+    if (DebugName == nullptr)
+        DebugName = "";
+
+    auto err = vkAllocateDescriptorSets(m_VkDevice, &AllocInfo, pSets);
+    if (err != VK_SUCCESS)
+        return false;
+
+    if (*DebugName != 0)
+    {
+        for (uint32_t i = 0; i < AllocInfo.descriptorSetCount; ++i)
+            SetDescriptorSetName(m_VkDevice, pSets[i], DebugName);
+    }
+
+    return true;
+}
+
 void VulkanLogicalDevice::ReleaseVulkanObject(CommandPoolWrapper&& CmdPool) const
 {
     vkDestroyCommandPool(m_VkDevice, CmdPool.m_VkObject, m_VkAllocator);
@@ -482,6 +537,12 @@ void VulkanLogicalDevice::ReleaseVulkanObject(SemaphoreWrapper&& Semaphore) cons
     Semaphore.m_VkObject = VK_NULL_HANDLE;
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(EventWrapper&& Event) const
+{
+    vkDestroyEvent(m_VkDevice, Event.m_VkObject, m_VkAllocator);
+    Event.m_VkObject = VK_NULL_HANDLE;
+}
+
 void VulkanLogicalDevice::ReleaseVulkanObject(QueryPoolWrapper&& QueryPool) const
 {
     vkDestroyQueryPool(m_VkDevice, QueryPool.m_VkObject, m_VkAllocator);
@@ -498,6 +559,23 @@ void VulkanLogicalDevice::ReleaseVulkanObject(AccelStructWrapper&& AccelStruct)
 #endif
 }
 
+void VulkanLogicalDevice::ReleaseVulkanObject(PipelineCacheWrapper&& PipelineCache) const
+{
+    vkDestroyPipelineCache(m_VkDevice, PipelineCache.m_VkObject, m_VkAllocator);
+    PipelineCache.m_VkObject = VK_NULL_HANDLE;
+}
+
+void VulkanLogicalDevice::ReleaseVulkanObject(DescrUpdateTemplateWrapper&& DescrUpdateTemplate) const
+{
+#if DILIGENT_USE_VOLK
+    auto DestroyFunc = vkDestroyDescriptorUpdateTemplate != nullptr ? vkDestroyDescriptorUpdateTemplate : vkDestroyDescriptorUpdateTemplateKHR;
+    DestroyFunc(m_VkDevice, DescrUpdateTemplate.m_VkObject, m_VkAllocator);
+    DescrUpdateTemplate.m_VkObject = VK_NULL_HANDLE;
+#else
+    UNSUPPORTED("vkDestroyDescriptorUpdateTemplate is only available through Volk");
+#endif
+}
+
 void VulkanLogicalDevice::FreeDescriptorSet(VkDescriptorPool Pool, VkDescriptorSet Set) const
 {
     VERIFY_EXPR(Pool != VK_NULL_HANDLE && Set != VK_NULL_HANDLE);
@@ -526,6 +604,68 @@ VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkI
     return MemReqs;
 }
 
+VkMemoryRequirements VulkanLogicalDevice::GetBufferMemoryRequirements(VkBuffer vkBuffer, bool& DedicatedAllocation) const
+{
+    DedicatedAllocation = false;
+#if DILIGENT_USE_VOLK
+    if (m_EnabledExtFeatures.DedicatedAllocation)
+    {
+        VkBufferMemoryRequirementsInfo2 ReqsInfo{};
+        ReqsInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+        ReqsInfo.buffer = vkBuffer;
+
+        VkMemoryDedicatedRequirements DedicatedReqs{};
+        DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 MemReqs2{};
+        MemReqs2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        MemReqs2.pNext = &DedicatedReqs;
+
+        vkGetBufferMemoryRequirements2KHR(m_VkDevice, &ReqsInfo, &MemReqs2);
+
+        DedicatedAllocation = DedicatedReqs.prefersDedicatedAllocation != VK_FALSE || DedicatedReqs.requiresDedicatedAllocation != VK_FALSE;
+        return MemReqs2.memoryRequirements;
+    }
+#endif
+    return GetBufferMemoryRequirements(vkBuffer);
+}
+
+VkMemoryRequirements VulkanLogicalDevice::GetImageMemoryRequirements(VkImage vkImage, bool& DedicatedAllocation) const
+{
+    DedicatedAllocation = false;
+#if DILIGENT_USE_VOLK
+    if (m_EnabledExtFeatures.DedicatedAllocation)
+    {
+        VkImageMemoryRequirementsInfo2 ReqsInfo{};
+        ReqsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        ReqsInfo.image = vkImage;
+
+        VkMemoryDedicatedRequirements DedicatedReqs{};
+        DedicatedReqs.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 MemReqs2{};
+        MemReqs2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        MemReqs2.pNext = &DedicatedReqs;
+
+        vkGetImageMemoryRequirements2KHR(m_VkDevice, &ReqsInfo, &MemReqs2);
+
+        DedicatedAllocation = DedicatedReqs.prefersDedicatedAllocation != VK_FALSE || DedicatedReqs.requiresDedicatedAllocation != VK_FALSE;
+        return MemReqs2.memoryRequirements;
+    }
+#endif
+    return GetImageMemoryRequirements(vkImage);
+}
+
+std::vector<VkSparseImageMemoryRequirements> VulkanLogicalDevice::GetImageSparseMemoryRequirements(VkImage vkImage) const
+{
+    uint32_t Count = 0;
+    vkGetImageSparseMemoryRequirements(m_VkDevice, vkImage, &Count, nullptr);
+    std::vector<VkSparseImageMemoryRequirements> SparseReqs(Count);
+    if (Count != 0)
+        vkGetImageSparseMemoryRequirements(m_VkDevice, vkImage, &Count, SparseReqs.data());
+    return SparseReqs;
+}
+
 VkResult VulkanLogicalDevice::BindBufferMemory(VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize memoryOffset) const
 {
     return vkBindBufferMemory(m_VkDevice, buffer, memory, memoryOffset);
@@ -551,6 +691,19 @@ VkDeviceAddress VulkanLogicalDevice::GetAccelerationStructureDeviceAddress(VkAcc
 #endif
 }
 
+VkDeviceAddress VulkanLogicalDevice::GetBufferDeviceAddress(VkBuffer vkBuffer) const
+{
+#if DILIGENT_USE_VOLK
+    VkBufferDeviceAddressInfoKHR Info{};
+    Info.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO_KHR;
+    Info.buffer = vkBuffer;
+    return vkGetBufferDeviceAddressKHR(m_VkDevice, &Info);
+#else
+    UNSUPPORTED("vkGetBufferDeviceAddressKHR is only available through Volk");
+    return VkDeviceAddress{};
+#endif
+}
+
 void VulkanLogicalDevice::GetAccelerationStructureBuildSizes(const VkAccelerationStructureBuildGeometryInfoKHR& BuildInfo, const uint32_t* pMaxPrimitiveCounts, VkAccelerationStructureBuildSizesInfoKHR& SizeInfo) const
 {
 #if DILIGENT_USE_VOLK
@@ -640,6 +793,54 @@ void VulkanLogicalDevice::UpdateDescriptorSets(uint32_t                    descr
     vkUpdateDescriptorSets(m_VkDevice, descriptorWriteCount, pDescriptorWrites, descriptorCopyCount, pDescriptorCopies);
 }
 
+void VulkanLogicalDevice::UpdateDescriptorSetWithTemplate(VkDescriptorSet            descriptorSet,
+                                                          VkDescriptorUpdateTemplate descriptorUpdateTemplate,
+                                                          const void*                pData) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY_EXPR(descriptorSet != VK_NULL_HANDLE && descriptorUpdateTemplate != VK_NULL_HANDLE);
+    if (vkUpdateDescriptorSetWithTemplate != nullptr)
+        vkUpdateDescriptorSetWithTemplate(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+    else
+        vkUpdateDescriptorSetWithTemplateKHR(m_VkDevice, descriptorSet, descriptorUpdateTemplate, pData);
+#else
+    UNSUPPORTED("vkUpdateDescriptorSetWithTemplate is only available through Volk");
+#endif
+}
+
+VkDeviceSize VulkanLogicalDevice::GetDescriptorSetLayoutSize(VkDescriptorSetLayout vkLayout) const
+{
+#if DILIGENT_USE_VOLK
+    VkDeviceSize Size = 0;
+    vkGetDescriptorSetLayoutSizeEXT(m_VkDevice, vkLayout, &Size);
+    return Size;
+#else
+    UNSUPPORTED("vkGetDescriptorSetLayoutSizeEXT is only available through Volk");
+    return 0;
+#endif
+}
+
+VkDeviceSize VulkanLogicalDevice::GetDescriptorSetLayoutBindingOffset(VkDescriptorSetLayout vkLayout, uint32_t Binding) const
+{
+#if DILIGENT_USE_VOLK
+    VkDeviceSize Offset = 0;
+    vkGetDescriptorSetLayoutBindingOffsetEXT(m_VkDevice, vkLayout, Binding, &Offset);
+    return Offset;
+#else
+    UNSUPPORTED("vkGetDescriptorSetLayoutBindingOffsetEXT is only available through Volk");
+    return 0;
+#endif
+}
+
+void VulkanLogicalDevice::GetDescriptor(const VkDescriptorGetInfoEXT& DescriptorInfo, size_t DataSize, void* pDescriptor) const
+{
+#if DILIGENT_USE_VOLK
+    vkGetDescriptorEXT(m_VkDevice, &DescriptorInfo, DataSize, pDescriptor);
+#else
+    UNSUPPORTED("vkGetDescriptorEXT is only available through Volk");
+#endif
+}
+
 VkResult VulkanLogicalDevice::ResetCommandPool(VkCommandPool           vkCmdPool,
                                                VkCommandPoolResetFlags flags) const
 {
@@ -666,4 +867,47 @@ VkResult VulkanLogicalDevice::GetRayTracingShaderGroupHandles(VkPipeline pipelin
 #endif
 }
 
+VkResult VulkanLogicalDevice::GetPipelineCacheData(VkPipelineCache pipelineCache, size_t* pDataSize, void* pData) const
+{
+    return vkGetPipelineCacheData(m_VkDevice, pipelineCache, pDataSize, pData);
+}
+
+VkResult VulkanLogicalDevice::GetPipelineExecutableProperties(VkPipeline pipeline, uint32_t* pExecutableCount, VkPipelineExecutablePropertiesKHR* pProperties) const
+{
+#if DILIGENT_USE_VOLK
+    VkPipelineInfoKHR PipelineInfo{};
+    PipelineInfo.sType    = VK_STRUCTURE_TYPE_PIPELINE_INFO_KHR;
+    PipelineInfo.pipeline = pipeline;
+    return vkGetPipelineExecutablePropertiesKHR(m_VkDevice, &PipelineInfo, pExecutableCount, pProperties);
+#else
+    UNSUPPORTED("vkGetPipelineExecutablePropertiesKHR is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
+VkResult VulkanLogicalDevice::GetPipelineExecutableStatistics(VkPipeline pipeline, uint32_t executableIndex, uint32_t* pStatisticCount, VkPipelineExecutableStatisticKHR* pStatistics) const
+{
+#if DILIGENT_USE_VOLK
+    VkPipelineExecutableInfoKHR ExecutableInfo{};
+    ExecutableInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_EXECUTABLE_INFO_KHR;
+    ExecutableInfo.pipeline        = pipeline;
+    ExecutableInfo.executableIndex = executableIndex;
+    return vkGetPipelineExecutableStatisticsKHR(m_VkDevice, &ExecutableInfo, pStatisticCount, pStatistics);
+#else
+    UNSUPPORTED("vkGetPipelineExecutableStatisticsKHR is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
+VkResult VulkanLogicalDevice::GetCalibratedTimestamps(uint32_t timestampCount, const VkCalibratedTimestampInfoEXT* pTimestampInfos, uint64_t* pTimestamps, uint64_t* pMaxDeviation) const
+{
+#if DILIGENT_USE_VOLK
+    VERIFY_EXPR(m_EnabledExtFeatures.CalibratedTimestamps);
+    return vkGetCalibratedTimestampsEXT(m_VkDevice, timestampCount, pTimestampInfos, pTimestamps, pMaxDeviation);
+#else
+    UNSUPPORTED("vkGetCalibratedTimestampsEXT is only available through Volk");
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+}
+
 } // namespace VulkanUtilities
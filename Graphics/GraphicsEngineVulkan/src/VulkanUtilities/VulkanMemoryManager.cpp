@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <sstream>
+#include <algorithm>
+#include <vector>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -40,37 +42,75 @@ VulkanMemoryAllocation::~VulkanMemoryAllocation()
     }
 }
 
-VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
-                                   VkDeviceSize          PageSize,
-                                   uint32_t              MemoryTypeIndex,
-                                   bool                  IsHostVisible,
-                                   VkMemoryAllocateFlags AllocateFlags) noexcept :
+VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&           ParentMemoryMgr,
+                                   VkDeviceSize                   PageSize,
+                                   uint32_t                       MemoryTypeIndex,
+                                   bool                           IsHostVisible,
+                                   VkMemoryAllocateFlags          AllocateFlags,
+                                   uint32_t                       DeviceMask,
+                                   float                          Priority,
+                                   const VulkanDedicatedResource& DedicatedResource) noexcept :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
-    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
+    m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator},
+    m_MemoryTypeIndex{MemoryTypeIndex},
+    m_Priority       {Priority},
+    m_IsDedicated    {DedicatedResource.IsValid()}
 // clang-format on
 {
     VERIFY(PageSize <= std::numeric_limits<AllocationsMgrOffsetType>::max(),
            "PageSize (", PageSize, ") exceeds maximum allowed value ",
            std::numeric_limits<AllocationsMgrOffsetType>::max());
 
-    VkMemoryAllocateInfo      MemAlloc    = {};
-    VkMemoryAllocateFlagsInfo MemFlagInfo = {};
+    VkMemoryAllocateInfo            MemAlloc      = {};
+    VkMemoryAllocateFlagsInfo       MemFlagInfo   = {};
+    VkMemoryDedicatedAllocateInfo   DedicatedInfo = {};
+    VkMemoryPriorityAllocateInfoEXT PriorityInfo  = {};
 
     MemAlloc.pNext           = nullptr;
     MemAlloc.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     MemAlloc.allocationSize  = PageSize;
     MemAlloc.memoryTypeIndex = MemoryTypeIndex;
 
+    if (DeviceMask != 0)
+        AllocateFlags |= VK_MEMORY_ALLOCATE_DEVICE_MASK_BIT;
+
+    const void** NextExt = &MemAlloc.pNext;
     if (AllocateFlags)
     {
-        MemAlloc.pNext    = &MemFlagInfo;
-        MemFlagInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
-        MemFlagInfo.pNext = nullptr;
-        MemFlagInfo.flags = AllocateFlags;
+        *NextExt               = &MemFlagInfo;
+        NextExt                = &MemFlagInfo.pNext;
+        MemFlagInfo.sType      = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+        MemFlagInfo.pNext      = nullptr;
+        MemFlagInfo.flags      = AllocateFlags;
+        MemFlagInfo.deviceMask = DeviceMask;
+    }
+
+    if (m_IsDedicated)
+    {
+        VERIFY(DedicatedResource.Image == VK_NULL_HANDLE || DedicatedResource.Buffer == VK_NULL_HANDLE,
+               "Dedicated allocation can't be made for an image and a buffer at the same time");
+
+        *NextExt             = &DedicatedInfo;
+        NextExt              = &DedicatedInfo.pNext;
+        DedicatedInfo.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        DedicatedInfo.pNext  = nullptr;
+        DedicatedInfo.image  = DedicatedResource.Image;
+        DedicatedInfo.buffer = DedicatedResource.Buffer;
+    }
+
+    if (ParentMemoryMgr.m_LogicalDevice.GetEnabledExtFeatures().MemoryPriority.memoryPriority != VK_FALSE)
+    {
+        VERIFY(Priority >= 0.f && Priority <= 1.f, "Memory priority (", Priority, ") must be in [0, 1] range");
+
+        *NextExt              = &PriorityInfo;
+        PriorityInfo.sType    = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT;
+        PriorityInfo.pNext    = nullptr;
+        PriorityInfo.priority = Priority;
     }
 
-    auto MemoryName = Diligent::FormatString("Device memory page. Size: ", Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
+    auto MemoryName = Diligent::FormatString(m_IsDedicated ? "Dedicated device memory. Size: " : "Device memory page. Size: ",
+                                             Diligent::FormatMemorySize(PageSize, 2), ", type: ", MemoryTypeIndex);
     m_VkMemory      = ParentMemoryMgr.m_LogicalDevice.AllocateDeviceMemory(MemAlloc, MemoryName.c_str());
 
     if (IsHostVisible)
@@ -118,7 +158,7 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
 
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
-    m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
+    m_ParentMemoryMgr.OnFreeAllocation(*this, Allocation.Size);
     std::lock_guard<std::mutex> Lock{m_Mutex};
     VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
     VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
@@ -126,7 +166,7 @@ void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
     Allocation = VulkanMemoryAllocation{};
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedResource& DedicatedResource, uint32_t DeviceMask, float Priority)
 {
     // memoryTypeBits is a bitmask and contains one bit set for every supported memory type for the resource.
     // Bit i is set if and only if the memory type i in the VkPhysicalDeviceMemoryProperties structure for the
@@ -155,11 +195,35 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     }
 
     bool HostVisible = (MemoryProps & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
-    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
+    return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags, DedicatedResource, DeviceMask, Priority);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+VulkanMemoryAllocation VulkanMemoryManager::AllocateDedicated(VkDeviceSize Size, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, uint32_t DeviceMask, float Priority, const VulkanDedicatedResource& DedicatedResource)
 {
+    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags, DeviceMask, Priority, true};
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    const size_t stat_ind = HostVisible ? 1 : 0;
+
+    // Dedicated memory is placed at offset 0, which satisfies any alignment
+    auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, Size, MemoryTypeIndex, HostVisible, AllocateFlags, DeviceMask, Priority, DedicatedResource});
+    OnPageCreated(it->second);
+    auto Allocation = it->second.Allocate(Size, 1);
+    DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate dedicated memory");
+
+    m_CurrDedicatedSize[stat_ind] += Size;
+    m_PeakDedicatedSize[stat_ind] = std::max(m_PeakDedicatedSize[stat_ind], m_CurrDedicatedSize[stat_ind]);
+
+    OnNewAllocation(Allocation);
+
+    return Allocation;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags, const VulkanDedicatedResource& DedicatedResource, uint32_t DeviceMask, float Priority)
+{
+    if (DedicatedResource.IsValid())
+        return AllocateDedicated(Size, MemoryTypeIndex, HostVisible, AllocateFlags, DeviceMask, Priority, DedicatedResource);
+
     VulkanMemoryAllocation Allocation;
 
     // On integrated GPUs, there is no difference between host-visible and GPU-only
@@ -169,7 +233,9 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
+    // Allocations with different priorities are kept in separate pages since the priority
+    // is a property of the device memory object.
+    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags, DeviceMask, Priority};
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
 
     auto range = m_Pages.equal_range(PageIdx);
@@ -183,6 +249,10 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     size_t stat_ind = HostVisible ? 1 : 0;
     if (Allocation.Page == nullptr)
     {
+        // Release empty pages in heaps that are close to their budget before allocating more memory
+        if (const auto OverBudgetHeaps = GetOverBudgetHeaps())
+            DestroyEmptyPages(OverBudgetHeaps);
+
         auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
         while (PageSize < Size)
             PageSize *= 2;
@@ -190,11 +260,11 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
         m_CurrAllocatedSize[stat_ind] += PageSize;
         m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
 
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
+        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags, DeviceMask, Priority});
         LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
                          " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
                          "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
+        OnPageCreated(it->second);
         Allocation = it->second.Allocate(Size, Alignment);
         DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
     }
@@ -204,43 +274,286 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
         VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    OnNewAllocation(Allocation);
 
     return Allocation;
 }
 
-void VulkanMemoryManager::ShrinkMemory()
+uint32_t VulkanMemoryManager::GetOverBudgetHeaps() const
 {
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
-        return;
+    if (!m_LogicalDevice.GetEnabledExtFeatures().MemoryBudget)
+        return 0;
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudget{};
+    if (!m_PhysicalDevice.GetMemoryBudget(MemoryBudget))
+        return 0;
+
+    uint32_t OverBudgetHeaps = 0;
+
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+    for (uint32_t heap = 0; heap < MemoryProps.memoryHeapCount; ++heap)
+    {
+        // Start releasing memory when the usage exceeds 90% of the budget
+        const auto Budget = MemoryBudget.heapBudget[heap];
+        if (Budget != 0 && MemoryBudget.heapUsage[heap] > Budget - Budget / 10)
+            OverBudgetHeaps |= 1u << heap;
+    }
+
+    return OverBudgetHeaps;
+}
+
+void VulkanMemoryManager::DestroyEmptyPages(uint32_t OverBudgetHeaps)
+{
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
 
     auto it = m_Pages.begin();
     while (it != m_Pages.end())
     {
         auto curr_it = it;
         ++it;
-        auto& Page          = curr_it->second;
-        bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto& Page = curr_it->second;
+        if (!Page.IsEmpty())
+            continue;
+
+        const bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+        const auto stat_ind      = IsHostVisible ? 1 : 0;
+        const auto PageSize      = Page.GetPageSize();
+        if (Page.IsDedicated())
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
+            // Dedicated memory can't be reused by other resources
+            VERIFY_EXPR(m_CurrDedicatedSize[stat_ind] >= PageSize);
+            m_CurrDedicatedSize[stat_ind] -= PageSize;
+            m_NumReleasedDedicatedPages.fetch_add(-1);
+        }
+        else
+        {
+            const auto HeapIndex    = MemoryProps.memoryTypes[curr_it->first.MemoryTypeIndex].heapIndex;
+            const bool IsOverBudget = (OverBudgetHeaps & (1u << HeapIndex)) != 0;
+            const auto ReserveSize  = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+            if (!IsOverBudget && m_CurrAllocatedSize[stat_ind] <= ReserveSize)
+                continue;
+
+            m_CurrAllocatedSize[stat_ind] -= PageSize;
+            if (Page.m_IsRelocationSrc)
+                m_DefragStats.ReclaimedSize += PageSize;
             LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
-                             " page (", Diligent::FormatMemorySize(PageSize, 2),
-                             "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+                             " page (", Diligent::FormatMemorySize(PageSize, 2), ")",
+                             (IsOverBudget ? " as memory heap usage is close to the budget" : ""),
+                             ". Current allocated size: ",
+                             Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
+        }
+        OnPageReleased(Page);
+        m_Pages.erase(curr_it);
+    }
+}
+
+void VulkanMemoryManager::ShrinkMemory()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    const auto OverBudgetHeaps = GetOverBudgetHeaps();
+    if (OverBudgetHeaps == 0 &&
+        m_NumReleasedDedicatedPages.load() == 0 &&
+        m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize &&
+        m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+        return;
+
+    DestroyEmptyPages(OverBudgetHeaps);
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateForRelocation(const VulkanMemoryAllocation& Allocation,
+                                                                 VkDeviceSize                  Size,
+                                                                 VkDeviceSize                  Alignment,
+                                                                 double                        MaxSrcPageOccupancy)
+{
+    VERIFY_EXPR(Allocation.Page != nullptr);
+    if (Allocation.Page->IsDedicated())
+        return {};
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+
+    const auto SrcOccupancy = Allocation.Page->GetOccupancy();
+    if (SrcOccupancy > MaxSrcPageOccupancy)
+        return {};
+
+    auto src_it = m_Pages.begin();
+    while (src_it != m_Pages.end() && &src_it->second != Allocation.Page)
+        ++src_it;
+    if (src_it == m_Pages.end())
+    {
+        UNEXPECTED("The allocation's page is not found in this memory manager");
+        return {};
+    }
+
+    // Try the most densely occupied pages first
+    std::vector<VulkanMemoryPage*> DstPages;
+    auto range = m_Pages.equal_range(src_it->first);
+    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    {
+        auto& Page = page_it->second;
+        if (&Page != Allocation.Page && !Page.IsFull() && Page.GetOccupancy() > SrcOccupancy)
+            DstPages.push_back(&Page);
+    }
+    std::sort(DstPages.begin(), DstPages.end(),
+              [](const VulkanMemoryPage* lhs, const VulkanMemoryPage* rhs) {
+                  return lhs->GetOccupancy() > rhs->GetOccupancy();
+              });
+
+    for (auto* pPage : DstPages)
+    {
+        auto NewAllocation = pPage->Allocate(Size, Alignment);
+        if (NewAllocation.Page == nullptr)
+            continue;
+
+        OnNewAllocation(NewAllocation);
+
+        Allocation.Page->m_IsRelocationSrc = true;
+        m_DefragStats.NumRelocations += 1;
+        m_DefragStats.RelocatedSize += Allocation.Size;
+
+        return NewAllocation;
+    }
+
+    return {};
+}
+
+VulkanMemoryManager::DefragmentationStats VulkanMemoryManager::GetDefragmentationStats()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    return m_DefragStats;
+}
+
+void VulkanMemoryManager::OnPageCreated(VulkanMemoryPage& Page)
+{
+    const auto TypeIdx = Page.GetMemoryTypeIndex();
+    const auto HeapIdx = m_PhysicalDevice.GetMemoryProperties().memoryTypes[TypeIdx].heapIndex;
+    const auto Size    = Page.GetPageSize();
+
+    for (auto* pStats : {&m_TypeStats[TypeIdx], &m_HeapStats[HeapIdx]})
+    {
+        pStats->AllocatedSize += Size;
+        pStats->PeakAllocatedSize = std::max(pStats->PeakAllocatedSize, pStats->AllocatedSize);
+        pStats->NumPages += 1;
+    }
+
+    if (m_AllocationCallback != nullptr)
+    {
+        Diligent::MemoryAllocationEvent Event;
+        Event.Type            = Diligent::MEMORY_ALLOCATION_EVENT_TYPE_ALLOCATE;
+        Event.IsDedicated     = Page.IsDedicated();
+        Event.MemoryTypeIndex = TypeIdx;
+        Event.HeapIndex       = HeapIdx;
+        Event.Size            = Size;
+        m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
+    }
+
+    OnNewPageCreated(Page);
+}
+
+void VulkanMemoryManager::OnPageReleased(VulkanMemoryPage& Page)
+{
+    OnPageDestroy(Page);
+
+    const auto TypeIdx = Page.GetMemoryTypeIndex();
+    const auto HeapIdx = m_PhysicalDevice.GetMemoryProperties().memoryTypes[TypeIdx].heapIndex;
+    const auto Size    = Page.GetPageSize();
+
+    for (auto* pStats : {&m_TypeStats[TypeIdx], &m_HeapStats[HeapIdx]})
+    {
+        VERIFY_EXPR(pStats->AllocatedSize >= Size && pStats->NumPages > 0);
+        pStats->AllocatedSize -= Size;
+        pStats->NumPages -= 1;
+    }
+
+    if (m_AllocationCallback != nullptr)
+    {
+        Diligent::MemoryAllocationEvent Event;
+        Event.Type            = Diligent::MEMORY_ALLOCATION_EVENT_TYPE_FREE;
+        Event.IsDedicated     = Page.IsDedicated();
+        Event.MemoryTypeIndex = TypeIdx;
+        Event.HeapIndex       = HeapIdx;
+        Event.Size            = Size;
+        m_AllocationCallback(&Event, m_pAllocationCallbackUserData);
+    }
+}
+
+void VulkanMemoryManager::OnNewAllocation(const VulkanMemoryAllocation& Allocation)
+{
+    if (Allocation.Page == nullptr)
+        return;
+
+    const auto& Page     = *Allocation.Page;
+    const auto  stat_ind = Page.GetCPUMemory() != nullptr ? 1 : 0;
+    const auto  TypeIdx  = Page.GetMemoryTypeIndex();
+    const auto  HeapIdx  = m_PhysicalDevice.GetMemoryProperties().memoryTypes[TypeIdx].heapIndex;
+    const auto  Size     = static_cast<int64_t>(Allocation.Size);
+
+    m_CurrUsedSize[stat_ind].fetch_add(Size);
+    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+
+    const auto TypeUsedSize = m_TypeUsedSize[TypeIdx].fetch_add(Size) + Size;
+    m_TypeStats[TypeIdx].PeakUsedSize = std::max(m_TypeStats[TypeIdx].PeakUsedSize, static_cast<VkDeviceSize>(TypeUsedSize));
+
+    const auto HeapUsedSize = m_HeapUsedSize[HeapIdx].fetch_add(Size) + Size;
+    m_HeapStats[HeapIdx].PeakUsedSize = std::max(m_HeapStats[HeapIdx].PeakUsedSize, static_cast<VkDeviceSize>(HeapUsedSize));
+}
+
+void VulkanMemoryManager::OnFreeAllocation(const VulkanMemoryPage& Page, VkDeviceSize Size)
+{
+    const auto TypeIdx = Page.GetMemoryTypeIndex();
+    const auto HeapIdx = m_PhysicalDevice.GetMemoryProperties().memoryTypes[TypeIdx].heapIndex;
+
+    m_CurrUsedSize[Page.GetCPUMemory() != nullptr ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
+    m_TypeUsedSize[TypeIdx].fetch_add(-static_cast<int64_t>(Size));
+    m_HeapUsedSize[HeapIdx].fetch_add(-static_cast<int64_t>(Size));
+    if (Page.IsDedicated())
+        m_NumReleasedDedicatedPages.fetch_add(1);
+}
+
+void VulkanMemoryManager::GetStatistics(Diligent::RenderDeviceMemoryStatistics& Stats)
+{
+    Stats = {};
+
+    const auto& MemoryProps = m_PhysicalDevice.GetMemoryProperties();
+    Stats.NumHeaps          = std::min(MemoryProps.memoryHeapCount, Diligent::Uint32{DILIGENT_MAX_MEMORY_HEAPS});
+    Stats.NumMemoryTypes    = std::min(MemoryProps.memoryTypeCount, Diligent::Uint32{DILIGENT_MAX_MEMORY_TYPES});
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudget{};
+
+    const bool HasBudget = m_LogicalDevice.GetEnabledExtFeatures().MemoryBudget && m_PhysicalDevice.GetMemoryBudget(MemoryBudget);
+
+    auto WriteStats = [](Diligent::MemoryUsageStatistics& Dst, const MemoryStats& Src, int64_t UsedSize) {
+        Dst.AllocatedSize     = Src.AllocatedSize;
+        Dst.UsedSize          = static_cast<Diligent::Uint64>(std::max(UsedSize, int64_t{0}));
+        Dst.PeakAllocatedSize = Src.PeakAllocatedSize;
+        Dst.PeakUsedSize      = Src.PeakUsedSize;
+        Dst.NumAllocations    = Src.NumPages;
+    };
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    for (Diligent::Uint32 heap = 0; heap < Stats.NumHeaps; ++heap)
+    {
+        auto& HeapStats = Stats.Heaps[heap];
+        WriteStats(HeapStats.Usage, m_HeapStats[heap], m_HeapUsedSize[heap].load());
+        if (HasBudget)
+        {
+            HeapStats.Budget       = MemoryBudget.heapBudget[heap];
+            HeapStats.ProcessUsage = MemoryBudget.heapUsage[heap];
         }
     }
+
+    for (Diligent::Uint32 type = 0; type < Stats.NumMemoryTypes; ++type)
+    {
+        WriteStats(Stats.MemoryTypes[type], m_TypeStats[type], m_TypeUsedSize[type].load());
+        Stats.MemoryTypeHeaps[type] = MemoryProps.memoryTypes[type].heapIndex;
+    }
 }
 
-void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisble)
+void VulkanMemoryManager::SetAllocationCallback(Diligent::MemoryAllocationCallbackType Callback, void* pUserData)
 {
-    m_CurrUsedSize[IsHostVisble ? 1 : 0].fetch_add(-static_cast<int64_t>(Size));
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    m_AllocationCallback          = Callback;
+    m_pAllocationCallbackUserData = pUserData;
 }
 
 VulkanMemoryManager::~VulkanMemoryManager()
@@ -255,7 +568,17 @@ VulkanMemoryManager::~VulkanMemoryManager()
                      "\n                       Peak used/allocated host-visible memory size: ",
                      Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
                      Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
-                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"));
+                     " (", PeakHostVisisblePages, (PeakHostVisisblePages == 1 ? " page)" : " pages)"),
+                     "\n                       Peak dedicated device-local/host-visible memory size: ",
+                     Diligent::FormatMemorySize(m_PeakDedicatedSize[0], 2), " / ",
+                     Diligent::FormatMemorySize(m_PeakDedicatedSize[1], 2));
+
+    if (m_DefragStats.NumRelocations > 0)
+    {
+        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "' defragmentation stats: ", m_DefragStats.NumRelocations,
+                         " allocations (", Diligent::FormatMemorySize(m_DefragStats.RelocatedSize, 2), ") relocated, ",
+                         Diligent::FormatMemorySize(m_DefragStats.ReclaimedSize, 2), " reclaimed");
+    }
 
     for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
         VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
@@ -250,6 +250,157 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
             m_ExtProperties.TimelineSemaphore.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_PROPERTIES;
         }
 
+        // Present wait is used to limit the frame latency of swap chains
+        if (IsExtensionSupported(VK_KHR_PRESENT_ID_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PresentId;
+            NextFeat  = &m_ExtFeatures.PresentId.pNext;
+
+            m_ExtFeatures.PresentId.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+
+            *NextFeat = &m_ExtFeatures.PresentWait;
+            NextFeat  = &m_ExtFeatures.PresentWait.pNext;
+
+            m_ExtFeatures.PresentWait.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        }
+
+        // Dynamic rendering requires VK_KHR_depth_stencil_resolve and VK_KHR_create_renderpass2 that are
+        // core in Vulkan 1.2. VK_KHR_create_renderpass2 in turn depends on Vulkan 1.1 functionality.
+        if (IsExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+            (m_VkVersion >= VK_API_VERSION_1_2 ||
+             (m_VkVersion >= VK_API_VERSION_1_1 &&
+              IsExtensionSupported(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) &&
+              IsExtensionSupported(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME))))
+        {
+            *NextFeat = &m_ExtFeatures.DynamicRendering;
+            NextFeat  = &m_ExtFeatures.DynamicRendering.pNext;
+
+            m_ExtFeatures.DynamicRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+        }
+
+        if (IsExtensionSupported(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ExtendedDynamicState;
+            NextFeat  = &m_ExtFeatures.ExtendedDynamicState.pNext;
+
+            m_ExtFeatures.ExtendedDynamicState.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.ConditionalRendering;
+            NextFeat  = &m_ExtFeatures.ConditionalRendering.pNext;
+
+            m_ExtFeatures.ConditionalRendering.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+        }
+
+        if (IsExtensionSupported(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DrawIndirectCount = true;
+        }
+
+        if (IsExtensionSupported(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DedicatedAllocation = true;
+        }
+
+        if (IsExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        {
+            m_ExtFeatures.MemoryBudget = true;
+        }
+
+#if DILIGENT_USE_VOLK && (PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID)
+        // Calibrated timestamps are only useful if the device clock can be sampled together
+        // with the host clock used by std::chrono::steady_clock.
+        if (IsExtensionSupported(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) && vkGetPhysicalDeviceCalibrateableTimeDomainsEXT != nullptr)
+        {
+            uint32_t TimeDomainCount = 0;
+            vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &TimeDomainCount, nullptr);
+            std::vector<VkTimeDomainEXT> TimeDomains(TimeDomainCount);
+            vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(m_VkDevice, &TimeDomainCount, TimeDomains.data());
+            TimeDomains.resize(TimeDomainCount);
+
+            const auto HasTimeDomain = [&TimeDomains](VkTimeDomainEXT Domain) {
+                return std::find(TimeDomains.begin(), TimeDomains.end(), Domain) != TimeDomains.end();
+            };
+            m_ExtFeatures.CalibratedTimestamps = HasTimeDomain(VK_TIME_DOMAIN_DEVICE_EXT) && HasTimeDomain(HostTimeDomain);
+        }
+#endif
+
+        if (IsExtensionSupported(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.MemoryPriority;
+            NextFeat  = &m_ExtFeatures.MemoryPriority.pNext;
+
+            m_ExtFeatures.MemoryPriority.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+
+            // Pageable device local memory requires memory priority
+            if (IsExtensionSupported(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME))
+            {
+                *NextFeat = &m_ExtFeatures.PageableDeviceLocalMemory;
+                NextFeat  = &m_ExtFeatures.PageableDeviceLocalMemory.pNext;
+
+                m_ExtFeatures.PageableDeviceLocalMemory.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+            }
+        }
+
+        // Pipeline executable properties are used to capture the shader compiler statistics
+        if (IsExtensionSupported(VK_KHR_PIPELINE_EXECUTABLE_PROPERTIES_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.PipelineExecutableProperties;
+            NextFeat  = &m_ExtFeatures.PipelineExecutableProperties.pNext;
+
+            m_ExtFeatures.PipelineExecutableProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PIPELINE_EXECUTABLE_PROPERTIES_FEATURES_KHR;
+        }
+
+        if (IsExtensionSupported(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+        {
+            m_ExtFeatures.PushDescriptor = true;
+
+            *NextProp = &m_ExtProperties.PushDescriptor;
+            NextProp  = &m_ExtProperties.PushDescriptor.pNext;
+
+            m_ExtProperties.PushDescriptor.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        }
+
+        // Descriptor update templates are core in Vulkan 1.1
+        if (m_VkVersion >= VK_API_VERSION_1_1 || IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DescriptorUpdateTemplate = true;
+        }
+
+        // Descriptor buffers require buffer device address, descriptor indexing and synchronization2,
+        // which are all core in Vulkan 1.3
+        if (m_VkVersion >= VK_API_VERSION_1_3 && IsExtensionSupported(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.DescriptorBuffer;
+            NextFeat  = &m_ExtFeatures.DescriptorBuffer.pNext;
+
+            m_ExtFeatures.DescriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.DescriptorBuffer;
+            NextProp  = &m_ExtProperties.DescriptorBuffer.pNext;
+
+            m_ExtProperties.DescriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+        }
+
+        // Graphics pipeline library requires VK_KHR_pipeline_library
+        if (IsExtensionSupported(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+            IsExtensionSupported(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.GraphicsPipelineLibrary;
+            NextFeat  = &m_ExtFeatures.GraphicsPipelineLibrary.pNext;
+
+            m_ExtFeatures.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.GraphicsPipelineLibrary;
+            NextProp  = &m_ExtProperties.GraphicsPipelineLibrary.pNext;
+
+            m_ExtProperties.GraphicsPipelineLibrary.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+        }
+
         // make sure that last pNext is null
         *NextFeat = nullptr;
         *NextProp = nullptr;
@@ -400,4 +551,24 @@ VkFormatProperties VulkanPhysicalDevice::GetPhysicalDeviceFormatProperties(VkFor
     return formatProperties;
 }
 
+bool VulkanPhysicalDevice::GetMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& MemoryBudget) const
+{
+#if DILIGENT_USE_VOLK
+    if (!m_ExtFeatures.MemoryBudget || vkGetPhysicalDeviceMemoryProperties2KHR == nullptr)
+        return false;
+
+    MemoryBudget       = {};
+    MemoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 MemProps2{};
+    MemProps2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    MemProps2.pNext = &MemoryBudget;
+
+    vkGetPhysicalDeviceMemoryProperties2KHR(m_VkDevice, &MemProps2);
+    return true;
+#else
+    return false;
+#endif
+}
+
 } // namespace VulkanUtilities
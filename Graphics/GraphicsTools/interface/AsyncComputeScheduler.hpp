@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of an AsyncComputeScheduler class
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Fence.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Async compute scheduler statistics, updated by Execute()
+struct AsyncComputeSchedulerStatistics
+{
+    /// The number of submissions executed by the last Execute() call
+    Uint32 NumSubmissions = 0;
+
+    /// The number of fence signals enqueued by the last Execute() call
+    Uint32 NumSignals = 0;
+
+    /// The number of cross-queue fence waits enqueued by the last Execute() call
+    Uint32 NumWaits = 0;
+
+    /// The number of state transitions issued by the last Execute() call
+    Uint32 NumBarriers = 0;
+
+    /// The number of state transitions that were recorded on the queue that previously used
+    /// the resource because the consuming queue does not support the resource's current state
+    /// (e.g. a render target consumed by a compute queue).
+    Uint32 NumHandoffBarriers = 0;
+
+    /// The number of resources that are currently tracked by the scheduler
+    Uint32 NumTrackedResources = 0;
+};
+
+/// Schedules work on multiple immediate contexts (command queues) and synchronizes them automatically
+
+/// The scheduler takes a list of submissions, where every submission is a callback that is executed on
+/// one of the immediate contexts together with the list of resources that the callback reads and writes.
+/// Submissions are recorded in the order they were added, and before every submission the scheduler
+/// - makes the target queue wait for the submissions on other queues that the submission depends on
+///   (read-after-write, write-after-read and write-after-write hazards), using one fence per queue and
+///   IDeviceContext::EnqueueSignal() / IDeviceContext::DeviceWaitForFence(),
+/// - transitions the resources to the declared states. If the target queue does not support the
+///   current state of a resource (for instance, a compute queue cannot transition a texture out of
+///   the render target state), the transition is recorded on the queue that used the resource last.
+///
+/// Dependencies are tracked across Execute() calls, so work of the next frame on one queue waits for
+/// the work of the previous frame on another queue that accesses the same resources. A resource
+/// stops being tracked once all accesses to it have completed on the GPU.
+///
+/// Typical usage:
+///
+///     auto Compute = Scheduler.FindQueue(COMMAND_QUEUE_TYPE_COMPUTE);
+///     Scheduler.AddSubmission("GBuffer", 0, DrawGBuffer).Write(pDepth, RESOURCE_STATE_DEPTH_WRITE);
+///     Scheduler.AddSubmission("SSAO", Compute, ComputeSSAO).Read(pDepth).Write(pSSAO);
+///     Scheduler.AddSubmission("Particles", Compute, SimulateParticles).Write(pParticles);
+///     Scheduler.AddSubmission("Shadows", 0, DrawShadows).Write(pShadowMap, RESOURCE_STATE_DEPTH_WRITE);
+///     Scheduler.AddSubmission("Lighting", 0, DrawLighting).Read(pSSAO).Read(pParticles).Read(pShadowMap);
+///     Scheduler.Execute();
+///
+/// Here the SSAO and particle submissions overlap with the shadow pass on the graphics queue.
+///
+/// \remarks    Resources that are used by several queues must be created with ImmediateContextMask
+///             that includes all these queues. In Vulkan such resources use concurrent sharing
+///             mode, so no queue family ownership transfers are required.
+///
+///             Callbacks must not transition the declared resources and should use
+///             RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE.
+///
+///             At the end of Execute() all queues except the first one are flushed. The first queue
+///             is left open so that the application can continue recording commands, e.g. to present
+///             the frame. The application must still call IDeviceContext::FinishFrame() for every
+///             context, which can be done with FinishFrame().
+class AsyncComputeScheduler
+{
+public:
+    /// Queue index, which is the index of the context in the array passed to the constructor
+    using QueueIndex = Uint32;
+
+    static constexpr QueueIndex InvalidQueueIndex = ~0u;
+
+    /// Submission execution callback
+    using ExecuteCallbackType = std::function<void(IDeviceContext* pContext)>;
+
+    /// Helper class that declares the resources used by a submission
+    class SubmissionBuilder
+    {
+    public:
+        /// Declares that the submission reads the texture in the given state.
+        SubmissionBuilder& Read(ITexture* pTexture, RESOURCE_STATE State = RESOURCE_STATE_SHADER_RESOURCE);
+
+        /// Declares that the submission reads the buffer in the given state.
+        SubmissionBuilder& Read(IBuffer* pBuffer, RESOURCE_STATE State = RESOURCE_STATE_SHADER_RESOURCE);
+
+        /// Declares that the submission writes the texture in the given state.
+        SubmissionBuilder& Write(ITexture* pTexture, RESOURCE_STATE State = RESOURCE_STATE_UNORDERED_ACCESS);
+
+        /// Declares that the submission writes the buffer in the given state.
+        SubmissionBuilder& Write(IBuffer* pBuffer, RESOURCE_STATE State = RESOURCE_STATE_UNORDERED_ACCESS);
+
+    private:
+        friend class AsyncComputeScheduler;
+        SubmissionBuilder(AsyncComputeScheduler& Scheduler, size_t Index) :
+            m_Scheduler{Scheduler},
+            m_Index{Index}
+        {}
+
+        SubmissionBuilder& AddAccess(IDeviceObject* pResource, ITexture* pTexture, IBuffer* pBuffer, RESOURCE_STATE State, bool Write);
+
+        AsyncComputeScheduler& m_Scheduler;
+        const size_t           m_Index;
+    };
+
+    /// Initializes the scheduler.
+
+    /// \param[in] pDevice     - Render device.
+    /// \param[in] ppContexts  - Immediate contexts that submissions can be executed on.
+    ///                          Every context must use a different command queue.
+    /// \param[in] NumContexts - The number of contexts in ppContexts array.
+    AsyncComputeScheduler(IRenderDevice* pDevice, IDeviceContext* const* ppContexts, Uint32 NumContexts);
+
+    // clang-format off
+    AsyncComputeScheduler           (const AsyncComputeScheduler&)  = delete;
+    AsyncComputeScheduler& operator=(const AsyncComputeScheduler&)  = delete;
+    AsyncComputeScheduler           (      AsyncComputeScheduler&&) = delete;
+    AsyncComputeScheduler& operator=(      AsyncComputeScheduler&&) = delete;
+    // clang-format on
+
+    ~AsyncComputeScheduler();
+
+    /// Returns the index of the first queue whose type exactly matches the given type,
+    /// or the first queue that supports all operations of the given type if there is no exact match.
+    /// Returns InvalidQueueIndex if no queue supports the type.
+    QueueIndex FindQueue(COMMAND_QUEUE_TYPE Type) const;
+
+    /// Adds a submission that will be executed on the given queue.
+    SubmissionBuilder AddSubmission(const char* Name, QueueIndex Queue, ExecuteCallbackType Execute);
+
+    /// Executes all submissions added since the last call and removes them from the list.
+    void Execute();
+
+    /// Calls IDeviceContext::FinishFrame() for all contexts.
+    void FinishFrame();
+
+    /// Blocks until all work enqueued by the scheduler has completed on the GPU.
+    void WaitForIdle();
+
+    Uint32 GetNumQueues() const { return static_cast<Uint32>(m_Queues.size()); }
+
+    IDeviceContext* GetContext(QueueIndex Queue) const { return m_Queues[Queue].pContext.RawPtr<IDeviceContext>(); }
+
+    const AsyncComputeSchedulerStatistics& GetStatistics() const { return m_Stats; }
+
+private:
+    struct ResourceAccess
+    {
+        IDeviceObject* pResource = nullptr;
+        ITexture*      pTexture  = nullptr;
+        IBuffer*       pBuffer   = nullptr;
+        RESOURCE_STATE State     = RESOURCE_STATE_UNKNOWN;
+        bool           Write     = false;
+    };
+
+    struct SubmissionInfo
+    {
+        std::string                 Name;
+        QueueIndex                  Queue = InvalidQueueIndex;
+        ExecuteCallbackType         Execute;
+        std::vector<ResourceAccess> Accesses;
+    };
+
+    struct QueueInfo
+    {
+        RefCntAutoPtr<IDeviceContext> pContext;
+        RefCntAutoPtr<IFence>         pFence;
+        COMMAND_QUEUE_TYPE            Type = COMMAND_QUEUE_TYPE_UNKNOWN;
+
+        // The fence value assigned to the last work recorded on the queue
+        Uint64 LastValue = 0;
+        // The last fence value that was passed to EnqueueSignal()
+        Uint64 LastEnqueuedValue = 0;
+        // The last fence value that is known to be pending, i.e. the context has been flushed after the signal
+        Uint64 LastSignaledValue = 0;
+        // The last fence value of every other queue that this queue waited for
+        std::vector<Uint64> LastWaitedValues;
+        // Whether commands have been recorded since the last flush
+        bool HasPendingWork = false;
+    };
+
+    struct TrackedResource
+    {
+        RefCntAutoPtr<IDeviceObject> pResource;
+        ITexture*                    pTexture = nullptr;
+        IBuffer*                     pBuffer  = nullptr;
+
+        // The fence value of the last access on every queue, zero if the queue has never accessed the resource
+        std::vector<Uint64> LastAccessValues;
+        // The queue that last wrote or transitioned the resource and the fence value of that access
+        QueueIndex LastWriteQueue = InvalidQueueIndex;
+        Uint64     LastWriteValue = 0;
+    };
+
+    TrackedResource& GetTrackedResource(const ResourceAccess& Access);
+    RESOURCE_STATE   GetResourceState(const TrackedResource& Res) const;
+    bool             IsStateSupported(QueueIndex Queue, RESOURCE_STATE State) const;
+
+    void WaitForQueue(QueueIndex Queue, QueueIndex SrcQueue, Uint64 Value);
+    void WaitForOtherAccesses(QueueIndex Queue, const TrackedResource& Res, bool WaitForReaders);
+    void SignalAndFlush(QueueIndex Queue);
+
+    static StateTransitionDesc GetBarrier(const TrackedResource& Res, RESOURCE_STATE NewState);
+    void ReleaseCompletedResources();
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    std::vector<QueueInfo>      m_Queues;
+    std::vector<SubmissionInfo> m_Submissions;
+
+    std::unordered_map<IDeviceObject*, TrackedResource> m_Resources;
+    std::vector<StateTransitionDesc>                    m_Barriers;
+
+    AsyncComputeSchedulerStatistics m_Stats;
+};
+
+} // namespace Diligent
@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of an AsyncScreenCapture class
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/SwapChain.h"
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Pixel format of the frames produced by AsyncScreenCapture
+enum ASYNC_SCREEN_CAPTURE_FORMAT : Uint8
+{
+    /// One plane of tightly packed 8-bit RGBA pixels
+    ASYNC_SCREEN_CAPTURE_FORMAT_RGBA8 = 0,
+
+    /// Three planes (Y, U, V) of 8-bit samples with 2x2 chroma subsampling (I420),
+    /// BT.709 limited range
+    ASYNC_SCREEN_CAPTURE_FORMAT_YUV420,
+
+    ASYNC_SCREEN_CAPTURE_FORMAT_COUNT
+};
+
+/// A frame that has been read back from the GPU
+struct AsyncScreenCaptureFrame
+{
+    /// Frame id passed to AsyncScreenCapture::Capture()
+    Uint32 Id = 0;
+
+    /// Frame width and height in pixels
+    Uint32 Width  = 0;
+    Uint32 Height = 0;
+
+    ASYNC_SCREEN_CAPTURE_FORMAT Format = ASYNC_SCREEN_CAPTURE_FORMAT_RGBA8;
+
+    /// The number of planes: 1 for RGBA8, 3 for YUV420
+    Uint32 NumPlanes = 0;
+
+    /// Plane data and row strides in bytes.
+    /// For YUV420 frames, the luma plane width is padded to a multiple of 8 and its height
+    /// to a multiple of 2; chroma planes have half the padded luma dimensions.
+    const Uint8* pPlanes[3] = {};
+    Uint32       Strides[3] = {};
+};
+
+/// Async screen capture create information
+struct AsyncScreenCaptureCreateInfo
+{
+    /// The number of readback buffers in the ring, i.e. the maximum number of frames
+    /// that may be in flight on the GPU or processed by the workers at the same time.
+    /// When all buffers are busy, new frames are dropped.
+    Uint32 RingSize = 3;
+
+    /// Optional thread pool that runs the frame callback, e.g. the pool shared with
+    /// the engine (see EngineCreateInfo::pAsyncTaskPool). If null, the object creates
+    /// its own pool with NumWorkerThreads threads.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of worker threads that run the frame callback when pThreadPool is null.
+    /// If it is 0, ThreadPool::GetDefaultThreadCount() threads are used.
+    Uint32 NumWorkerThreads = 1;
+
+    /// Format of the captured frames
+    ASYNC_SCREEN_CAPTURE_FORMAT Format = ASYNC_SCREEN_CAPTURE_FORMAT_YUV420;
+
+    /// Callback that receives the captured frames, e.g. to encode them.
+    /// The callback is executed by one of the worker threads. Frame data is only valid
+    /// until the callback returns. With one worker thread in the own pool, frames are delivered in the order they were captured.
+    std::function<void(const AsyncScreenCaptureFrame& Frame)> Callback;
+};
+
+/// Captures frames without stalling the render thread.
+
+/// Frames are converted to the requested format by a compute shader and copied into a ring of staging
+/// buffers. Update() polls the fence, maps the buffers whose copies have completed (this never waits for
+/// the GPU) and hands them over to the worker threads that run the callback. Buffers are unmapped
+/// and returned to the ring by subsequent calls to Update().
+///
+/// Capture() and Update() must be called from the thread that owns the device context, and
+/// Update() must be called regularly (e.g. once per frame). Before the object is destroyed,
+/// Finish() must be called to wait for all pending frames and release the mapped buffers.
+class AsyncScreenCapture
+{
+public:
+    AsyncScreenCapture(IRenderDevice* pDevice, const AsyncScreenCaptureCreateInfo& CI);
+    ~AsyncScreenCapture();
+
+    // clang-format off
+    AsyncScreenCapture           (const AsyncScreenCapture&)  = delete;
+    AsyncScreenCapture           (      AsyncScreenCapture&&) = delete;
+    AsyncScreenCapture& operator=(const AsyncScreenCapture&)  = delete;
+    AsyncScreenCapture& operator=(      AsyncScreenCapture&&) = delete;
+    // clang-format on
+
+    /// Records commands that capture the texture.
+
+    /// \param [in] pContext - Device context to record the commands to.
+    /// \param [in] pTexture - 2D texture to capture. Textures that cannot be used as shader resources
+    ///                        are first copied to an intermediate texture. sRGB textures
+    ///                        are converted back to gamma space.
+    /// \param [in] FrameId  - Frame id that is passed to the callback.
+    /// \return     true if the capture was recorded, and false if the frame was dropped
+    ///             because all readback buffers are busy.
+    bool Capture(IDeviceContext* pContext, ITexture* pTexture, Uint32 FrameId);
+
+    /// Captures the current back buffer of the swap chain, see Capture().
+    bool CaptureSwapChain(IDeviceContext* pContext, ISwapChain* pSwapChain, Uint32 FrameId);
+
+    /// Dispatches completed captures to the worker threads and recycles the buffers
+    /// that have been processed. Never waits for the GPU or the workers.
+    void Update(IDeviceContext* pContext);
+
+    /// Waits until all pending frames have been processed by the workers and unmaps all buffers.
+    void Finish(IDeviceContext* pContext);
+
+    /// Returns the number of frames that have been dropped because all readback buffers were busy.
+    Uint32 GetNumDroppedFrames() const
+    {
+        return m_NumDroppedFrames;
+    }
+
+private:
+    enum SLOT_STATE : Uint32
+    {
+        SLOT_STATE_FREE = 0,
+        SLOT_STATE_PENDING,
+        SLOT_STATE_PROCESSING,
+        SLOT_STATE_PROCESSED
+    };
+
+    struct ReadbackSlot
+    {
+        RefCntAutoPtr<IBuffer>  pStagingBuffer;
+        AsyncScreenCaptureFrame Frame;
+        Uint32                  PlaneOffsets[3] = {};
+        Uint64                  FenceValue      = 0;
+
+        // Written by the worker thread when the callback returns
+        std::atomic<Uint32> State{SLOT_STATE_FREE};
+    };
+
+    void RecycleProcessedSlots(IDeviceContext* pContext);
+    void WaitForCallbacks();
+    void DispatchCompletedSlots(IDeviceContext* pContext);
+    void PrepareFrame(ReadbackSlot& Slot, Uint32 Width, Uint32 Height, Uint32 FrameId);
+    bool CreatePipeline(bool ConvertToSRGB);
+
+    const AsyncScreenCaptureCreateInfo m_CI;
+
+    RefCntAutoPtr<IRenderDevice>          m_pDevice;
+    RefCntAutoPtr<IFence>                 m_pFence;
+    RefCntAutoPtr<IBuffer>                m_pConstants;
+    RefCntAutoPtr<IPipelineState>         m_pPSO[2];
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB[2];
+
+    // Intermediate texture for the textures that cannot be used as shader resources
+    RefCntAutoPtr<ITexture> m_pIntermediateTexture;
+
+    // Conversion output that is copied into the staging buffers
+    RefCntAutoPtr<IBuffer>     m_pOutputBuffer;
+    RefCntAutoPtr<IBufferView> m_pOutputUAV;
+
+    std::vector<ReadbackSlot> m_Slots;
+    // Indices of the slots that wait for the GPU, in the order of capture
+    std::deque<Uint32> m_PendingSlots;
+
+    Uint64 m_NextFenceValue   = 1;
+    Uint32 m_NumDroppedFrames = 0;
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
+    // The number of frames enqueued into the pool whose callbacks have not returned yet
+    std::mutex              m_CallbacksMtx;
+    std::condition_variable m_CallbacksDoneCV;
+    Uint32                  m_NumPendingCallbacks = 0;
+};
+
+} // namespace Diligent
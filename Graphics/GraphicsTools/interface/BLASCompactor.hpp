@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a BLASCompactor class
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// BLAS compactor create information
+struct BLASCompactorCreateInfo
+{
+    /// The maximum number of BLASes whose compacted sizes are queried in one batch.
+    Uint32 MaxBatchSize = 256;
+
+    /// The number of Update() calls to wait after a BLAS has been enqueued before
+    /// its compacted size is queried, so that the query does not stall the frame that built the BLAS.
+    Uint32 FrameDelay = 1;
+
+    /// Callback that is called for every compacted BLAS right after the compacting copy has been recorded.
+    /// The application must replace all references to pOriginal (e.g. in TLAS instances) with pCompacted
+    /// and rebuild the affected top-level ASes. The compactor releases its reference to pOriginal
+    /// when the callback returns.
+    std::function<void(IBottomLevelAS* pOriginal, IBottomLevelAS* pCompacted)> Callback;
+};
+
+/// Compacts bottom-level acceleration structures a few frames after they have been built.
+
+/// Enqueue() takes a BLAS that was built with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag.
+/// Update() writes the compacted sizes of the queued BLASes in batches into one query buffer and
+/// copies them to a staging buffer. Once the fence shows that a batch has completed (Update() never
+/// waits for the GPU), it creates the compacted BLASes, records COPY_AS_MODE_COMPACT copies and
+/// reports the results through the callback. The original BLASes are not destroyed immediately:
+/// when their last reference is released, the device keeps them in the release queue until the GPU
+/// has finished the copies.
+///
+/// Enqueue() and Update() must be called from the thread that owns the device context.
+/// Enqueued BLASes must not be rebuilt or updated until they have been compacted.
+class BLASCompactor
+{
+public:
+    BLASCompactor(IRenderDevice* pDevice, const BLASCompactorCreateInfo& CI);
+
+    // clang-format off
+    BLASCompactor           (const BLASCompactor&)  = delete;
+    BLASCompactor           (      BLASCompactor&&) = delete;
+    BLASCompactor& operator=(const BLASCompactor&)  = delete;
+    BLASCompactor& operator=(      BLASCompactor&&) = delete;
+    // clang-format on
+
+    /// Enqueues the BLAS for compaction.
+
+    /// \param [in] pBLAS - Bottom-level AS to compact. It must have been built with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag.
+    /// \return     true if the BLAS has been enqueued, and false if it does not allow compaction.
+    bool Enqueue(IBottomLevelAS* pBLAS);
+
+    /// Queries the compacted sizes of the BLASes enqueued at least FrameDelay calls ago
+    /// and compacts the BLASes whose sizes have been read back.
+
+    /// \param [in] pContext - Device context to record the commands to.
+    /// \return     The number of BLASes compacted by this call.
+    Uint32 Update(IDeviceContext* pContext);
+
+    /// Returns the number of BLASes that have been enqueued but not compacted yet.
+    size_t GetNumPendingBLASes() const;
+
+    /// Returns the total size, in bytes, of all compacted BLASes created by this object.
+    Uint64 GetTotalCompactedSize() const
+    {
+        return m_TotalCompactedSize;
+    }
+
+private:
+    struct QueuedBLAS
+    {
+        RefCntAutoPtr<IBottomLevelAS> pBLAS;
+        Uint64                        Frame = 0;
+    };
+
+    struct QueryBatch
+    {
+        RefCntAutoPtr<IBuffer>                     pStagingBuffer;
+        std::vector<RefCntAutoPtr<IBottomLevelAS>> BLASes;
+        Uint64                                     FenceValue = 0;
+    };
+
+    Uint32 CompactCompletedBatches(IDeviceContext* pContext);
+    void   QueryCompactedSizes(IDeviceContext* pContext);
+
+    const BLASCompactorCreateInfo m_CI;
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    // Destination of the compacted size queries; MaxBatchSize 64-bit values
+    RefCntAutoPtr<IBuffer> m_pSizeBuffer;
+
+    // Staging buffers that are not used by any pending batch
+    std::vector<RefCntAutoPtr<IBuffer>> m_FreeStagingBuffers;
+
+    std::deque<QueuedBLAS> m_Queue;
+    // Batches that wait for the GPU, in the order of submission
+    std::deque<QueryBatch> m_PendingBatches;
+
+    Uint64 m_NextFenceValue     = 1;
+    Uint64 m_FrameCounter       = 0;
+    Uint64 m_TotalCompactedSize = 0;
+};
+
+} // namespace Diligent
@@ -53,6 +53,9 @@ static const INTERFACE_ID IID_BufferSuballocator =
 struct IBufferSuballocation : public IObject
 {
     /// Returns the start offset of the suballocation.
+
+    /// \remarks    The offset may change when the parent allocator is compacted,
+    ///             see IBufferSuballocator::Compact().
     virtual Uint32 GetOffset() const = 0;
 
     /// Returns the suballocation size.
@@ -103,6 +106,8 @@ struct IBufferSuballocator : public IObject
     ///                               stored.
     ///
     /// \remarks    The method is thread-safe and can be called from multiple threads simultaneously.
+    ///             When BufferSuballocatorCreateInfo::SlabSize is not zero, small allocations
+    ///             do not take the allocator lock, see Diligent::BufferSuballocatorCreateInfo.
     virtual void Allocate(Uint32                 Size,
                           Uint32                 Alignment,
                           IBufferSuballocation** ppSuballocation) = 0;
@@ -111,13 +116,33 @@ struct IBufferSuballocator : public IObject
     /// Returns the total remaining free size.
 
     /// \note   Due to fragmentation, total free size may be split between
-    ///         multiple free chunks.
+    ///         multiple free chunks. Slab ranges are counted as used in their
+    ///         entirety.
     virtual Uint32 GetFreeSize() = 0;
 
 
     /// Returns internal buffer version. The version is incremented every time
-    /// the buffer is expanded.
+    /// the buffer is expanded or compacted.
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Moves all live suballocations into a dense layout and shrinks the buffer.
+
+    /// \param[in]  pDevice  - Pointer to the render device that will be used to create
+    ///                        the compacted buffer.
+    /// \param[in]  pContext - Pointer to the device context that will be used to copy
+    ///                        live suballocations to the compacted buffer.
+    ///
+    /// \remarks    Live suballocations are copied to a new buffer on the GPU timeline of pContext,
+    ///             and their offsets are updated. The buffer is shrunk to the total size of live
+    ///             suballocations, but not below the initial size. If the layout is already dense,
+    ///             the method does nothing. Otherwise the version is incremented, and an application
+    ///             should use GetVersion() to detect that it needs to re-read the offsets and the buffer.
+    ///
+    ///             The method is not thread-safe: Allocate() and GetBuffer() must not be called
+    ///             simultaneously with it. Suballocations may be released from other threads, in
+    ///             which case the release waits for the compaction to complete.
+    virtual void Compact(IRenderDevice* pDevice, IDeviceContext* pContext) = 0;
 };
 
 /// Buffer suballocator create information.
@@ -141,6 +166,38 @@ struct BufferSuballocatorCreateInfo
     /// of IBufferSuballocation implementation class. This member defines
     /// the number of objects in one page.
     Uint32 SuballocationObjAllocationGranularity = 64;
+
+
+    /// Slab size, in bytes.
+
+    /// When non-zero, small allocations are served from per-thread slabs without
+    /// taking the allocator lock. Every slab is a range of SlabSize bytes suballocated
+    /// from the buffer for one size class (a power of two). Allocations from a slab
+    /// are never reused individually: the slab range is returned to the buffer when
+    /// all allocations from it are released and the owning thread has moved to a new slab.
+    /// If zero, all allocations are performed under the lock.
+    Uint32 SlabSize = 0;
+
+
+    /// The maximum size of an allocation that is served from a slab.
+
+    /// Larger allocations are always performed under the lock.
+    /// The value is rounded up to a power of two and clamped by SlabSize.
+    Uint32 MaxSlabAllocationSize = 1024;
+
+
+    /// The maximum number of threads that may allocate from their own slabs at the same time.
+
+    /// Additional threads perform all allocations under the lock.
+    Uint32 MaxSlabThreads = 32;
+
+
+    /// Whether to manage the buffer space with TLSFAllocationsManager.
+
+    /// The two-level segregated fit manager allocates and frees in constant time and keeps
+    /// fragmentation low under a mix of short- and long-lived allocations of varying sizes.
+    /// If false, VariableSizeAllocationsManager is used.
+    bool UseTLSFManager = false;
 };
 
 /// Creates a new buffer suballocator.
@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a CommandStream class
+
+#include <functional>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/ArenaAllocator.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Backend-agnostic stream of device context commands.
+
+/// The command stream mirrors a subset of IDeviceContext methods. Recording a command only
+/// copies its arguments into a linear memory arena and adds references to the objects it uses,
+/// so commands can be recorded on any thread, even with backends that do not support
+/// deferred contexts (OpenGL) or whose drivers do not record command lists natively (Direct3D11).
+/// The stream is then decoded and executed on a device context by Replay().
+///
+/// A command stream is not thread-safe: every recording thread should use its own stream,
+/// and the application must synchronize recording with Replay(). A stream may be replayed
+/// any number of times until it is reset. All arena memory and object references are kept until
+/// Reset() is called; after a few frames the arena grows to the peak size and recording stops
+/// allocating memory altogether.
+class CommandStream
+{
+public:
+    /// \param [in] InitialArenaSize - Initial size of the memory arena, in bytes.
+    explicit CommandStream(size_t InitialArenaSize = 64 << 10);
+
+    // clang-format off
+    CommandStream           (const CommandStream&)  = delete;
+    CommandStream           (      CommandStream&&) = delete;
+    CommandStream& operator=(const CommandStream&)  = delete;
+    CommandStream& operator=(      CommandStream&&) = delete;
+    // clang-format on
+
+    // clang-format off
+    /// Records IDeviceContext::SetPipelineState().
+    void SetPipelineState     (IPipelineState* pPSO);
+
+    /// Records IDeviceContext::CommitShaderResources().
+    void CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records IDeviceContext::SetStencilRef().
+    void SetStencilRef        (Uint32 StencilRef);
+
+    /// Records IDeviceContext::SetBlendFactors().
+    void SetBlendFactors      (const float* pBlendFactors = nullptr);
+    // clang-format on
+
+    /// Records IDeviceContext::SetVertexBuffers().
+    void SetVertexBuffers(Uint32                         StartSlot,
+                          Uint32                         NumBuffersSet,
+                          IBuffer**                      ppBuffers,
+                          const Uint32*                  pOffsets,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                          SET_VERTEX_BUFFERS_FLAGS       Flags);
+
+    /// Records IDeviceContext::SetIndexBuffer().
+    void SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records IDeviceContext::SetViewports().
+    void SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight);
+
+    /// Records IDeviceContext::SetScissorRects().
+    void SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight);
+
+    /// Records IDeviceContext::SetRenderTargets().
+    void SetRenderTargets(Uint32                         NumRenderTargets,
+                          ITextureView*                  ppRenderTargets[],
+                          ITextureView*                  pDepthStencil,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records IDeviceContext::ClearRenderTarget().
+    void ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records IDeviceContext::ClearDepthStencil().
+    void ClearDepthStencil(ITextureView*                  pView,
+                           CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                           float                          fDepth,
+                           Uint8                          Stencil,
+                           RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    // clang-format off
+    /// Records IDeviceContext::Draw().
+    void Draw                   (const DrawAttribs& Attribs);
+
+    /// Records IDeviceContext::DrawIndexed().
+    void DrawIndexed            (const DrawIndexedAttribs& Attribs);
+
+    /// Records IDeviceContext::DrawIndirect().
+    void DrawIndirect           (const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer);
+
+    /// Records IDeviceContext::DrawIndexedIndirect().
+    void DrawIndexedIndirect    (const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer);
+
+    /// Records IDeviceContext::DispatchCompute().
+    void DispatchCompute        (const DispatchComputeAttribs& Attribs);
+
+    /// Records IDeviceContext::DispatchComputeIndirect().
+    void DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer);
+    // clang-format on
+
+    /// Records IDeviceContext::UpdateBuffer(). The data is copied into the stream.
+    void UpdateBuffer(IBuffer* pBuffer, Uint32 Offset, Uint32 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records IDeviceContext::CopyBuffer().
+    void CopyBuffer(IBuffer*                       pSrcBuffer,
+                    Uint32                         SrcOffset,
+                    RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                    IBuffer*                       pDstBuffer,
+                    Uint32                         DstOffset,
+                    Uint32                         Size,
+                    RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode);
+
+    /// Records IDeviceContext::TransitionResourceStates().
+    void TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers);
+
+    /// Executes all recorded commands in the device context.
+    void Replay(IDeviceContext* pContext) const;
+
+    /// Discards all recorded commands and releases the object references.
+    void Reset();
+
+    /// Returns the non-zero id of an object, or zero if the object can't be serialized, see Serialize().
+    using GetObjectIdType = std::function<Uint32(IObject*)>;
+
+    /// Returns the object with the given id, or null if the id is unknown, see Deserialize().
+    using GetObjectType = std::function<IObject*(Uint32)>;
+
+    /// Appends the binary encoding of all recorded commands to Data.
+
+    /// Objects are encoded by the ids returned by GetObjectId, so the encoding only stays meaningful while
+    /// the application can map the ids back to equivalent objects. Command arguments, including the
+    /// UpdateBuffer() data, are written field by field, so the encoding does not depend on the structure layouts.
+    /// Returns false if an object has no id, in which case Data is left unchanged.
+    bool Serialize(std::vector<Uint8>& Data, const GetObjectIdType& GetObjectId) const;
+
+    /// Decodes the commands encoded by Serialize() and appends them to the stream.
+
+    /// Returns false if the data is malformed or an object id can't be resolved to an object
+    /// of the expected type, in which case the stream is left unchanged.
+    bool Deserialize(const void* pData, size_t Size, const GetObjectType& GetObject);
+
+    /// Returns the number of recorded commands.
+    Uint32 GetCommandCount() const
+    {
+        return m_CommandCount;
+    }
+
+    /// Returns true if no commands have been recorded since the last reset.
+    bool IsEmpty() const
+    {
+        return m_pFirstCmd == nullptr;
+    }
+
+    // Recorded command header, defined in the implementation file
+    struct Command;
+
+private:
+    template <typename CmdType>
+    CmdType* AddCommand();
+
+    template <typename T>
+    T* CopyArray(const T* pSrc, Uint32 Count)
+    {
+        return (pSrc != nullptr && Count > 0) ? m_Arena.CopyArray(pSrc, Count) : nullptr;
+    }
+
+    template <typename ObjectType>
+    ObjectType* AddRef(ObjectType* pObject)
+    {
+        if (pObject != nullptr)
+            m_Objects.emplace_back(pObject);
+        return pObject;
+    }
+
+    ArenaAllocator m_Arena;
+
+    Command* m_pFirstCmd    = nullptr;
+    Command* m_pLastCmd     = nullptr;
+    Uint32   m_CommandCount = 0;
+
+    // References to all objects used by the recorded commands
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+};
+
+} // namespace Diligent
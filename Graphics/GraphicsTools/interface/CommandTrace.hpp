@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of CommandTraceRecorder and CommandTracePlayer classes
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "CommandStream.hpp"
+
+namespace Diligent
+{
+
+/// Records frames of command streams into a compact binary trace, see Diligent::CommandTracePlayer.
+
+/// The trace stores command arguments and buffer update data, but not the objects themselves:
+/// every object used by the recorded commands must be given an id with SetObjectId(). To replay the trace,
+/// the application creates equivalent objects (typically from the same assets) and registers them
+/// with the same ids in the player.
+class CommandTraceRecorder
+{
+public:
+    /// Assigns the trace id to an object. The id must not be zero.
+    /// The recorder keeps a reference to the object until it is destroyed.
+    void SetObjectId(IObject* pObject, Uint32 Id);
+
+    /// Appends a frame that contains all commands of the stream.
+    /// Returns false if the stream uses an object that has no id, in which case the frame is not recorded.
+    bool RecordFrame(const CommandStream& Stream);
+
+    /// Returns the number of recorded frames.
+    Uint32 GetFrameCount() const
+    {
+        return m_FrameCount;
+    }
+
+    /// Creates a data blob that contains the trace.
+    void GetTrace(IDataBlob** ppTrace) const;
+
+    /// Writes the trace to a file. Returns false if the file could not be written.
+    bool Save(const Char* FilePath) const;
+
+    /// Discards all recorded frames. Object ids are kept.
+    void Reset();
+
+private:
+    std::unordered_map<IObject*, Uint32> m_ObjectIds;
+    std::vector<RefCntAutoPtr<IObject>>  m_Objects;
+
+    // Encoded frames, each prefixed with its size
+    std::vector<Uint8> m_Frames;
+    Uint32             m_FrameCount = 0;
+};
+
+/// Replays the traces recorded by Diligent::CommandTraceRecorder and measures the frame times.
+class CommandTracePlayer
+{
+public:
+    /// Frame statistics, see ReplayFrame().
+    struct FrameStats
+    {
+        /// Time, in seconds, the CPU spent executing the frame commands in the device context.
+        double CPUTime = 0;
+
+        /// Time, in seconds, the GPU spent executing the frame, or zero if timestamp queries are not supported.
+        double GPUTime = 0;
+    };
+
+    /// \param [in] pDevice - Render device that is used to create the timestamp queries.
+    explicit CommandTracePlayer(IRenderDevice* pDevice);
+
+    // clang-format off
+    CommandTracePlayer           (const CommandTracePlayer&) = delete;
+    CommandTracePlayer& operator=(const CommandTracePlayer&) = delete;
+    // clang-format on
+
+    /// Registers the object that replaces the object with the given id in the trace.
+    /// All objects must be registered before the trace is loaded.
+    void SetObject(Uint32 Id, IObject* pObject);
+
+    /// Loads the trace from memory and decodes all frames, replacing the previously loaded trace.
+    /// Returns false if the trace is malformed or uses an object that is not registered.
+    bool Load(const void* pData, size_t Size);
+
+    /// Loads the trace from a file, see Load(const void*, size_t). The file is memory-mapped when the platform supports it.
+    bool Load(const Char* FilePath);
+
+    /// Returns the number of frames in the loaded trace.
+    Uint32 GetFrameCount() const
+    {
+        return static_cast<Uint32>(m_Frames.size());
+    }
+
+    /// Replays the frame in the device context and returns its statistics.
+
+    /// \param [in] pContext   - Device context to execute the commands in.
+    /// \param [in] FrameIndex - Index of the frame, from 0 to GetFrameCount() - 1.
+    ///
+    /// \remarks    The method waits for the GPU to finish the frame so that the frames do not overlap
+    ///             and the times of every frame are measured in isolation.
+    FrameStats ReplayFrame(IDeviceContext* pContext, Uint32 FrameIndex);
+
+private:
+    std::unordered_map<Uint32, RefCntAutoPtr<IObject>> m_Objects;
+    std::vector<std::unique_ptr<CommandStream>>        m_Frames;
+
+    RefCntAutoPtr<IQuery> m_pStartTimestamp;
+    RefCntAutoPtr<IQuery> m_pEndTimestamp;
+};
+
+} // namespace Diligent
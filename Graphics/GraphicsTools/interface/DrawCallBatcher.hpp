@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a DrawCallBatcher class
+
+#include <array>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Draw call batcher create information
+struct DrawCallBatcherCreateInfo
+{
+    /// The maximum number of draw commands that are combined into one multi-draw indirect call.
+    Uint32 MaxDrawsPerBatch = 1024;
+
+    /// Whether to combine non-contiguous draws into multi-draw indirect calls.
+    /// The flag is ignored if the device does not support native multi-draw indirect
+    /// (see DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT).
+    bool UseMultiDrawIndirect = true;
+};
+
+/// Draw call batcher statistics
+struct DrawCallBatcherStats
+{
+    /// The number of Draw() and DrawIndexed() calls recorded by the application.
+    Uint32 NumRecordedDraws = 0;
+
+    /// The number of recorded draws that were appended to the previous draw
+    /// because their vertex or index ranges were contiguous.
+    Uint32 NumMergedDraws = 0;
+
+    /// The number of direct draw calls issued to the device context.
+    Uint32 NumDrawCalls = 0;
+
+    /// The number of multi-draw indirect calls issued to the device context.
+    Uint32 NumMultiDrawCalls = 0;
+
+    /// The number of redundant state changes that were not forwarded to the device context.
+    Uint32 NumSkippedStateChanges = 0;
+};
+
+/// Coalesces consecutive draw commands that use the same state.
+
+/// The batcher wraps a device context and records pipeline state, shader resource,
+/// vertex buffer and index buffer changes as well as draw commands. Redundant state changes
+/// are dropped. Consecutive draws with the same flags whose vertex (or index) ranges are
+/// contiguous are merged into a single draw; for strip topologies this is never done, and
+/// for list topologies the previous draw must contain a whole number of primitives.
+/// When the device natively supports multi-draw indirect, the remaining draws are accumulated
+/// and issued by one DrawIndirect() or DrawIndexedIndirect() call with the arguments
+/// written to an internal dynamic buffer.
+///
+/// Any state change that is not a no-op flushes the pending draws. The application must call
+/// Flush() before it uses the device context directly (e.g. to set render targets, map or
+/// update buffers, or dispatch compute work), and InvalidateState() after it has changed
+/// the context state without going through the batcher.
+///
+/// Instances are never merged since SV_InstanceID does not include the first instance
+/// location in Direct3D, so draws that differ only in FirstInstanceLocation would not
+/// be equivalent to one instanced draw.
+class DrawCallBatcher
+{
+public:
+    DrawCallBatcher(IRenderDevice* pDevice, IDeviceContext* pContext, const DrawCallBatcherCreateInfo& CI);
+    ~DrawCallBatcher();
+
+    // clang-format off
+    DrawCallBatcher           (const DrawCallBatcher&)  = delete;
+    DrawCallBatcher           (      DrawCallBatcher&&) = delete;
+    DrawCallBatcher& operator=(const DrawCallBatcher&)  = delete;
+    DrawCallBatcher& operator=(      DrawCallBatcher&&) = delete;
+    // clang-format on
+
+    /// Sets the pipeline state, see IDeviceContext::SetPipelineState().
+    void SetPipelineState(IPipelineState* pPSO);
+
+    /// Commits shader resources, see IDeviceContext::CommitShaderResources().
+
+    /// \remarks Committing the same SRB again is skipped unless its signature
+    ///          contains dynamic variables or the pipeline state has been changed.
+    void CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Binds vertex buffers, see IDeviceContext::SetVertexBuffers().
+    void SetVertexBuffers(Uint32                         StartSlot,
+                          Uint32                         NumBuffersSet,
+                          IBuffer**                      ppBuffers,
+                          const Uint32*                  pOffsets,
+                          RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                          SET_VERTEX_BUFFERS_FLAGS       Flags);
+
+    /// Binds an index buffer, see IDeviceContext::SetIndexBuffer().
+    void SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode);
+
+    /// Records a non-indexed draw command.
+    void Draw(const DrawAttribs& Attribs);
+
+    /// Records an indexed draw command.
+    void DrawIndexed(const DrawIndexedAttribs& Attribs);
+
+    /// Issues all pending draw commands to the device context.
+    void Flush();
+
+    /// Flushes pending draws and forgets the cached state, so that the next
+    /// state change is always forwarded to the device context.
+    void InvalidateState();
+
+    /// Returns the statistics accumulated since the last ResetStats() call.
+    const DrawCallBatcherStats& GetStats() const
+    {
+        return m_Stats;
+    }
+
+    void ResetStats()
+    {
+        m_Stats = {};
+    }
+
+private:
+    bool CanAppendDraw(const DrawAttribs& Attribs) const;
+    bool CanAppendDrawIndexed(const DrawIndexedAttribs& Attribs) const;
+
+    RefCntAutoPtr<IRenderDevice>  m_pDevice;
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+
+    Uint32 m_MaxDrawsPerBatch;
+    bool   m_UseMultiDrawIndirect;
+
+    // Dynamic buffer that holds the arguments of multi-draw indirect calls
+    RefCntAutoPtr<IBuffer> m_pIndirectArgsBuffer;
+
+    // Cached state
+    RefCntAutoPtr<IPipelineState>                       m_pPSO;
+    RefCntAutoPtr<IShaderResourceBinding>               m_pSRB;
+    bool                                                m_SRBHasDynamicVars = false;
+    std::array<RefCntAutoPtr<IBuffer>, MAX_BUFFER_SLOTS> m_VertexBuffers;
+    std::array<Uint32, MAX_BUFFER_SLOTS>                m_VertexBufferOffsets = {};
+    Uint32                                              m_NumVertexBuffers    = 0;
+    RefCntAutoPtr<IBuffer>                              m_pIndexBuffer;
+    Uint32                                              m_IndexBufferOffset = 0;
+
+    // The number of vertices per primitive of the current pipeline's list topology,
+    // or zero if contiguous draws can't be merged.
+    Uint32 m_VerticesPerPrimitive = 0;
+
+    // Pending draws; only one of the arrays may be non-empty at a time
+    std::vector<DrawAttribs>        m_PendingDraws;
+    std::vector<DrawIndexedAttribs> m_PendingIndexedDraws;
+
+    DrawCallBatcherStats m_Stats;
+};
+
+} // namespace Diligent
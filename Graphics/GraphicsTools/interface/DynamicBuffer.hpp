@@ -33,11 +33,43 @@
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../GraphicsEngine/interface/ResourceHeap.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
 
+#include <vector>
+
 namespace Diligent
 {
 
+/// Dynamic buffer create information
+struct DynamicBufferCreateInfo
+{
+    /// Buffer description.
+    BufferDesc Desc;
+
+    /// The size of the virtual address range to reserve, in bytes.
+
+    /// If the value is not zero and the device supports SparseResources feature,
+    /// the dynamic buffer uses a sparse buffer of this size and commits memory pages
+    /// as the buffer grows, so that the buffer object and its contents are preserved
+    /// without a copy. If the value is zero, sparse resources are not supported, or
+    /// the buffer grows beyond this size, the buffer is resized by creating a new
+    /// buffer and copying the contents.
+    ///
+    /// \remarks Sparse buffers must use USAGE_DEFAULT.
+    Uint32 VirtualSize = 0;
+
+    /// The size of one memory page committed to the sparse buffer, in bytes.
+    /// The value is rounded up to a multiple of the sparse block size.
+    Uint32 MemoryPageSize = 1 << 20;
+
+    DynamicBufferCreateInfo() noexcept {}
+
+    explicit DynamicBufferCreateInfo(const BufferDesc& _Desc) noexcept :
+        Desc{_Desc}
+    {}
+};
+
 /// Dynamically resizable buffer
 class DynamicBuffer
 {
@@ -52,6 +84,16 @@ public:
     ///                     until GetBuffer() or Resize() is called.
     DynamicBuffer(IRenderDevice* pDevice, const BufferDesc& Desc);
 
+    /// Initialies the dynamic buffer.
+
+    /// \param[in] pDevice    - Render device that will be used to create the buffer.
+    ///                         This parameter may be null (see remarks).
+    /// \param[in] CreateInfo - Dynamic buffer create information, see Diligent::DynamicBufferCreateInfo.
+    ///
+    /// \remarks               If pDevice is null, internal buffer creation will be postponed
+    ///                        until GetBuffer() or Resize() is called.
+    DynamicBuffer(IRenderDevice* pDevice, const DynamicBufferCreateInfo& CreateInfo);
+
     // clang-format off
     DynamicBuffer           (const DynamicBuffer&)  = delete;
     DynamicBuffer& operator=(const DynamicBuffer&)  = delete;
@@ -84,11 +126,46 @@ public:
     ///             Typically pDevice and pContext should be null when the method is called from a worker thread.
     ///
     ///             If NewSize is zero, internal buffer will be released.
+    ///
+    ///             If the buffer is backed by a sparse buffer (see DynamicBufferCreateInfo::VirtualSize)
+    ///             and NewSize does not exceed the virtual size, the internal buffer is not replaced.
+    ///             Instead, memory pages are committed to cover the new size, which requires non-null
+    ///             device and immediate device context. Memory that is no longer used after the
+    ///             buffer shrinks remains committed.
     IBuffer* Resize(IRenderDevice*  pDevice,
                     IDeviceContext* pContext,
                     Uint32          NewSize);
 
 
+    /// Describes a range that is copied by Remap().
+    struct CopyRange
+    {
+        Uint32 SrcOffset = 0;
+        Uint32 DstOffset = 0;
+        Uint32 Size      = 0;
+    };
+
+    /// Replaces the buffer with a new buffer of the given size and copies the specified
+    /// ranges from the existing buffer to the new one.
+
+    /// \param[in] pDevice    - Render device that will be used to create the new buffer.
+    /// \param[in] pContext   - Device context that will be used to copy the ranges.
+    /// \param[in] NewSize    - New buffer size.
+    /// \param[in] pRanges    - Ranges to copy. Source ranges refer to the existing buffer,
+    ///                         destination ranges refer to the new buffer.
+    /// \param[in] NumRanges  - The number of ranges.
+    /// \return                 Pointer to the new buffer.
+    ///
+    /// \remarks    Contents of the existing buffer outside of the specified ranges is discarded.
+    ///             Unlike Resize(), the ranges may be moved to different offsets, which is used
+    ///             to compact the buffer. The version is incremented.
+    IBuffer* Remap(IRenderDevice*   pDevice,
+                   IDeviceContext*  pContext,
+                   Uint32           NewSize,
+                   const CopyRange* pRanges,
+                   Uint32           NumRanges);
+
+
     /// Returns the pointer to the buffer object, initializing it if necessary.
 
     /// \param[in] pDevice  - Render device that will be used to create the new buffer,
@@ -111,7 +188,7 @@ public:
     /// When update is not pending, GetBuffer() may be called with null device and context.
     bool PendingUpdate() const
     {
-        return (m_Desc.uiSizeInBytes > 0) && (!m_pBuffer || m_pStaleBuffer);
+        return (m_Desc.uiSizeInBytes > 0) && (!m_pBuffer || m_pStaleBuffer || (IsSparse() && GetCommittedSize() < m_Desc.uiSizeInBytes));
     }
 
 
@@ -129,16 +206,42 @@ public:
         return m_Version;
     }
 
+
+    /// Returns true if the internal buffer is a sparse buffer that grows by committing memory pages.
+    bool IsSparse() const
+    {
+        return m_pBuffer && m_VirtualSize != 0;
+    }
+
 private:
+    void CreateBuffer(IRenderDevice* pDevice);
+
     void CommitResize(IRenderDevice*  pDevice,
                       IDeviceContext* pContext);
 
+    void CommitMemoryPages(IRenderDevice*  pDevice,
+                           IDeviceContext* pContext);
+
+    Uint64 GetCommittedSize() const
+    {
+        return Uint64{m_MemoryPageSize} * m_MemoryPages.size();
+    }
+
     BufferDesc        m_Desc;
     const std::string m_Name;
     Uint32            m_Version = 0;
 
     RefCntAutoPtr<IBuffer> m_pBuffer;
     RefCntAutoPtr<IBuffer> m_pStaleBuffer;
+
+    // Virtual size of the sparse buffer, or zero if the buffer is resized by copying
+    Uint32 m_VirtualSize    = 0;
+    Uint32 m_MemoryPageSize = 0;
+
+    // Memory pages mapped to the sparse buffer, in the order of virtual addresses
+    std::vector<RefCntAutoPtr<IResourceHeap>> m_MemoryPages;
+    // Memory pages of the stale sparse buffer that must be kept alive until the contents is copied
+    std::vector<RefCntAutoPtr<IResourceHeap>> m_StaleMemoryPages;
 };
 
 } // namespace Diligent
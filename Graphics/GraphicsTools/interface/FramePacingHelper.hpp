@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a FramePacingHelper class
+
+#include <deque>
+#include <memory>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/SwapChain.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Timer.hpp"
+#include "DurationQueryHelper.hpp"
+
+namespace Diligent
+{
+
+/// Frame timing statistics, all values are in seconds
+struct FramePacingStats
+{
+    /// Time between BeginFrame() and EndFrame() on the CPU, excluding the frame latency wait
+    double CPUFrameTime = 0;
+
+    /// Time between the GPU timestamps recorded by BeginFrame() and EndFrame().
+    /// GPU times become available a few frames later, so this value lags behind the CPU values.
+    /// It is zero if the device does not support timestamp queries.
+    double GPUFrameTime = 0;
+
+    /// Time spent in ISwapChain::WaitForFrame() by BeginFrame()
+    double LatencyWaitTime = 0;
+
+    /// Time between two consecutive BeginFrame() calls
+    double FrameInterval = 0;
+};
+
+/// Paces frames with the swap chain frame latency wait and measures CPU and GPU frame times.
+
+/// Typical usage:
+///
+///     FramePacer.BeginFrame(pContext, pSwapChain); // Waits for the swap chain
+///     // Sample input, update and render the frame
+///     FramePacer.EndFrame(pContext);
+///     pSwapChain->Present();
+///
+/// Waiting at the beginning of the frame rather than in Present() reduces input-to-photon
+/// latency, because the input is sampled as late as possible. Use ISwapChain::SetMaximumFrameLatency()
+/// to control how many frames may be queued.
+class FramePacingHelper
+{
+public:
+    /// \param [in] pDevice            - Render device.
+    /// \param [in] NumFramesToAverage - The number of frames to average statistics over.
+    FramePacingHelper(IRenderDevice* pDevice, Uint32 NumFramesToAverage = 60);
+
+    // clang-format off
+    FramePacingHelper           (const FramePacingHelper&) = delete;
+    FramePacingHelper& operator=(const FramePacingHelper&) = delete;
+    FramePacingHelper           (FramePacingHelper&&)      = delete;
+    FramePacingHelper& operator=(FramePacingHelper&&)      = delete;
+    // clang-format on
+
+    /// Begins the frame.
+
+    /// \param [in] pContext   - Immediate device context.
+    /// \param [in] pSwapChain - Swap chain to wait for (see ISwapChain::WaitForFrame()).
+    ///                          May be null, in which case the method does not wait.
+    void BeginFrame(IDeviceContext* pContext, ISwapChain* pSwapChain);
+
+    /// Ends the frame. Must be called before ISwapChain::Present().
+    void EndFrame(IDeviceContext* pContext);
+
+    /// Returns the statistics of the last completed frame.
+    const FramePacingStats& GetLastFrameStats() const
+    {
+        return m_LastFrameStats;
+    }
+
+    /// Returns the statistics averaged over the last NumFramesToAverage frames.
+    const FramePacingStats& GetAverageStats() const
+    {
+        return m_AverageStats;
+    }
+
+private:
+    void AddFrameStats(const FramePacingStats& Stats);
+
+    const Uint32 m_NumFramesToAverage;
+
+    std::unique_ptr<DurationQueryHelper> m_pGPUTimer;
+
+    Timer  m_Timer;
+    double m_FrameStartTime     = 0;
+    double m_PrevFrameStartTime = -1;
+    bool   m_FrameStarted       = false;
+
+    FramePacingStats m_CurrentFrameStats;
+    FramePacingStats m_LastFrameStats;
+    FramePacingStats m_AverageStats;
+
+    // Statistics of the last NumFramesToAverage frames and their sum
+    std::deque<FramePacingStats> m_History;
+    FramePacingStats             m_HistorySum;
+
+    // The GPU time of the frame becomes available later than the CPU times,
+    // so it is averaged separately.
+    std::deque<double> m_GPUHistory;
+    double             m_GPUHistorySum = 0;
+};
+
+} // namespace Diligent
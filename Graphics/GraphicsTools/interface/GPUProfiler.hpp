@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <ostream>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Query.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Frame-level GPU profiler that records nested named scopes with timestamp queries.
+
+/// The profiler records a timestamp at the beginning and at the end of every scope and reads
+/// the results of all scopes of a frame at once, FrameLatency frames after the frame was recorded,
+/// so that the CPU never waits for the GPU. Resolved frames can be inspected or exported in
+/// Chrome trace event format (chrome://tracing, Perfetto).
+///
+/// If the context supports calibrated timestamps (see IDeviceContext::GetTimestampCalibration()),
+/// every frame is also placed on the CPU timeline, which lets the GPU scopes be shown in one trace
+/// with CPU events, so that submission bubbles are directly visible.
+///
+/// One profiler instance must only be used with one device context.
+/// When the profiler is disabled, BeginScope() and EndScope() only test a flag and do not
+/// record any commands.
+class GPUProfiler
+{
+public:
+    struct CreateInfo
+    {
+        /// The number of frames between recording the timestamps and reading them back.
+        /// If the results are not available after this number of frames, the frame is dropped.
+        Uint32 FrameLatency = 3;
+
+        /// The number of scopes per frame to reserve queries for.
+        Uint32 NumScopesToReserve = 64;
+
+        /// The maximum number of resolved frames that are kept for trace export.
+        Uint32 MaxTraceFrames = 120;
+
+        /// Whether to also pass scope names to IDeviceContext::BeginDebugGroup()
+        /// so that they appear in graphics debuggers.
+        bool EmitDebugGroups = true;
+
+        /// Whether the profiler is initially enabled.
+        bool Enabled = true;
+    };
+
+    GPUProfiler(IRenderDevice* pDevice, const CreateInfo& CI);
+
+    // clang-format off
+    GPUProfiler           (const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+    GPUProfiler           (GPUProfiler&&)      = delete;
+    GPUProfiler& operator=(GPUProfiler&&)      = delete;
+    // clang-format on
+
+
+    /// Enables or disables the profiler. The change takes effect at the next BeginFrame() call.
+    void SetEnabled(bool Enabled) { m_EnableRequested = Enabled; }
+
+    /// Returns true if the profiler records the current frame.
+    bool IsEnabled() const { return m_Enabled; }
+
+
+    /// Begins a new frame and reads back the results of the frame recorded FrameLatency frames ago.
+    void BeginFrame(IDeviceContext* pCtx);
+
+    /// Ends the current frame.
+
+    /// \remarks    All scopes begun in the frame must be ended before this call.
+    void EndFrame(IDeviceContext* pCtx);
+
+
+    /// Begins a named scope. Scopes may be nested.
+
+    /// \param [in] pCtx - Context to record the timestamp command.
+    /// \param [in] Name - Scope name. The string is copied.
+    void BeginScope(IDeviceContext* pCtx, const Char* Name)
+    {
+        if (m_Enabled)
+            BeginScopeImpl(pCtx, Name);
+    }
+
+    /// Ends the innermost scope.
+    void EndScope(IDeviceContext* pCtx)
+    {
+        if (m_Enabled)
+            EndScopeImpl(pCtx);
+    }
+
+
+    struct ScopeTiming
+    {
+        std::string Name;
+
+        /// Nesting level, 0 for top-level scopes.
+        Uint32 Depth = 0;
+
+        /// Scope start time, in seconds, relative to the frame start.
+        double StartTime = 0;
+
+        /// Scope duration, in seconds.
+        double Duration = 0;
+    };
+
+    struct FrameTiming
+    {
+        /// Frame number as counted by BeginFrame().
+        Uint64 FrameNumber = 0;
+
+        /// Frame start time, in seconds, relative to the first resolved frame.
+        double StartTime = 0;
+
+        /// Frame start time on the CPU timeline, in seconds, see GPUProfiler::GetCPUTime().
+        /// Negative if the timestamps of the frame could not be calibrated.
+        double CPUStartTime = -1;
+
+        /// GPU time between BeginFrame() and EndFrame(), in seconds.
+        double Duration = 0;
+
+        /// Scopes in the order they were begun.
+        std::vector<ScopeTiming> Scopes;
+    };
+
+    /// Returns the most recently resolved frame, or null if no frame has been resolved yet.
+    const FrameTiming* GetLastResolvedFrame() const
+    {
+        return !m_ResolvedFrames.empty() ? &m_ResolvedFrames.back() : nullptr;
+    }
+
+    /// Returns up to MaxTraceFrames most recently resolved frames, oldest first.
+    const std::deque<FrameTiming>& GetResolvedFrames() const { return m_ResolvedFrames; }
+
+    /// Writes all resolved frames to the stream in Chrome trace event JSON format.
+
+    /// \param [in] Stream      - Output stream.
+    /// \param [in] CPUTimeline - If false, the time is counted from the start of the first resolved frame.
+    ///                           If true, the events are placed on the CPU timeline, so that the trace can be
+    ///                           merged with CPU events whose timestamps are GetCPUTime() in microseconds.
+    ///                           Frames whose timestamps could not be calibrated are skipped.
+    void WriteChromeTrace(std::ostream& Stream, bool CPUTimeline = false) const;
+
+    /// Returns the current time on the CPU timeline, in seconds, measured by std::chrono::steady_clock.
+    static double GetCPUTime();
+
+
+    /// RAII helper that begins a scope in the constructor and ends it in the destructor.
+    class Scope
+    {
+    public:
+        Scope(GPUProfiler& Profiler, IDeviceContext* pCtx, const Char* Name) :
+            m_Profiler{Profiler},
+            m_pCtx{pCtx}
+        {
+            m_Profiler.BeginScope(m_pCtx, Name);
+        }
+
+        ~Scope()
+        {
+            m_Profiler.EndScope(m_pCtx);
+        }
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        // clang-format on
+
+    private:
+        GPUProfiler&          m_Profiler;
+        IDeviceContext* const m_pCtx;
+    };
+
+private:
+    void BeginScopeImpl(IDeviceContext* pCtx, const Char* Name);
+    void EndScopeImpl(IDeviceContext* pCtx);
+
+    // Records a timestamp into the next free query of the current frame and returns the query index
+    Uint32 WriteTimestamp(IDeviceContext* pCtx);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    const CreateInfo             m_CI;
+
+    bool m_EnableRequested = false;
+    bool m_Enabled         = false;
+
+    struct ScopeRecord
+    {
+        std::string Name;
+        Uint32      Depth      = 0;
+        Uint32      BeginQuery = 0;
+        Uint32      EndQuery   = ~0u;
+    };
+
+    struct FrameData
+    {
+        Uint64 FrameNumber = 0;
+
+        // Timestamp queries. The first one is written by BeginFrame(), the last used one by EndFrame().
+        std::vector<RefCntAutoPtr<IQuery>> Queries;
+        Uint32                             NumQueriesUsed = 0;
+
+        std::vector<ScopeRecord> Scopes;
+
+        // GPU and CPU timestamps sampled when the frame began
+        TimestampCalibration Calibration;
+        bool                 IsCalibrated = false;
+
+        // Indicates that the frame has been recorded and its results have not been read yet
+        bool Pending = false;
+    };
+    void ResolveFrame(FrameData& Frame);
+
+    std::vector<FrameData> m_Frames;
+    FrameData*             m_pCurrFrame = nullptr;
+
+    // Indices of the currently open scopes in m_pCurrFrame->Scopes
+    std::vector<Uint32> m_ScopeStack;
+
+    Uint64 m_FrameNumber = 0;
+
+    // Timestamp of the first resolved frame, in seconds
+    double m_BaseTime = -1;
+
+    std::deque<FrameTiming> m_ResolvedFrames;
+};
+
+} // namespace Diligent
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a GPUReadback class
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Data that has been read back from the GPU
+struct GPUReadbackData
+{
+    /// Id returned by GPUReadback::ReadbackBuffer() or GPUReadback::ReadbackTexture()
+    Uint64 Id = 0;
+
+    /// Pointer to the data. The data is only valid until the callback returns.
+    const void* pData = nullptr;
+
+    /// Data size in bytes. For textures, this is DepthStride * Depth.
+    Uint64 Size = 0;
+
+    /// Texture region dimensions. For buffers, Width is the data size and Height and Depth are 1.
+    Uint32 Width  = 0;
+    Uint32 Height = 0;
+    Uint32 Depth  = 0;
+
+    /// Row and depth slice strides in bytes. Both are 0 for buffers.
+    Uint32 Stride      = 0;
+    Uint32 DepthStride = 0;
+
+    /// Texture format, or TEX_FORMAT_UNKNOWN for buffers
+    TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+};
+
+/// GPU readback create information
+struct GPUReadbackCreateInfo
+{
+    /// The maximum total size, in bytes, of the idle staging buffers kept in the pool.
+    /// Staging buffers that do not fit are released when their readback completes.
+    Uint64 MaxPooledBufferSize = Uint64{16} << 20;
+
+    /// The maximum number of idle staging textures kept in the pool.
+    Uint32 MaxPooledTextures = 8;
+};
+
+/// Reads back buffers and textures without stalling the render thread.
+
+/// ReadbackBuffer() and ReadbackTexture() record a copy into a pooled staging resource
+/// and signal a fence. Staging resources are allocated in CPU-readable memory that is
+/// cached by the host where the backend supports it (e.g. VK_MEMORY_PROPERTY_HOST_CACHED_BIT
+/// in Vulkan). Update() polls the fence, maps the staging resources whose copies have
+/// completed (this never waits for the GPU), runs the completion callbacks, and returns the
+/// staging resources to the pool.
+///
+/// All methods must be called from the thread that owns the device context, and
+/// Update() must be called regularly (e.g. once per frame after IDeviceContext::FinishFrame()).
+class GPUReadback
+{
+public:
+    /// Callback that receives the data when the readback completes.
+    using CallbackType = std::function<void(const GPUReadbackData& Data)>;
+
+    GPUReadback(IRenderDevice* pDevice, const GPUReadbackCreateInfo& CI = {});
+
+    // clang-format off
+    GPUReadback           (const GPUReadback&)  = delete;
+    GPUReadback           (      GPUReadback&&) = delete;
+    GPUReadback& operator=(const GPUReadback&)  = delete;
+    GPUReadback& operator=(      GPUReadback&&) = delete;
+    // clang-format on
+
+    /// Records the commands that read back the buffer region.
+
+    /// \param [in] pContext - Device context to record the commands to.
+    /// \param [in] pBuffer  - Buffer to read back.
+    /// \param [in] Offset   - Offset of the region, in bytes.
+    /// \param [in] Size     - Size of the region, in bytes.
+    /// \param [in] Callback - Callback that is run by Update() or Finish() when the data is available.
+    /// \return     Readback id that can be passed to IsCompleted(), or 0 if the readback failed.
+    Uint64 ReadbackBuffer(IDeviceContext* pContext,
+                          IBuffer*        pBuffer,
+                          Uint32          Offset,
+                          Uint32          Size,
+                          CallbackType    Callback);
+
+    /// Records the commands that read back the texture subresource region.
+
+    /// \param [in] pContext   - Device context to record the commands to.
+    /// \param [in] pTexture   - Texture to read back.
+    /// \param [in] MipLevel   - Mip level to read back.
+    /// \param [in] ArraySlice - Array slice to read back.
+    /// \param [in] pRegion    - Region to read back. If null, the entire mip level is read back.
+    /// \param [in] Callback   - Callback that is run by Update() or Finish() when the data is available.
+    /// \return     Readback id that can be passed to IsCompleted(), or 0 if the readback failed.
+    Uint64 ReadbackTexture(IDeviceContext* pContext,
+                           ITexture*       pTexture,
+                           Uint32          MipLevel,
+                           Uint32          ArraySlice,
+                           const Box*      pRegion,
+                           CallbackType    Callback);
+
+    /// Runs the callbacks of the readbacks that have completed and recycles their staging resources.
+    /// Never waits for the GPU.
+
+    /// \return The number of readbacks that have completed.
+    Uint32 Update(IDeviceContext* pContext);
+
+    /// Flushes the context, waits for all pending readbacks and runs their callbacks.
+    void Finish(IDeviceContext* pContext);
+
+    /// Returns true if the readback with the given id has completed and its callback has returned.
+    bool IsCompleted(Uint64 Id) const
+    {
+        return Id != 0 && Id <= m_LastCompletedId;
+    }
+
+    /// Returns the number of readbacks that have not completed yet.
+    size_t GetNumPendingReadbacks() const
+    {
+        return m_PendingReadbacks.size();
+    }
+
+private:
+    struct PendingReadback
+    {
+        RefCntAutoPtr<IBuffer>  pStagingBuffer;
+        RefCntAutoPtr<ITexture> pStagingTexture;
+        GPUReadbackData         Data;
+        CallbackType            Callback;
+    };
+
+    RefCntAutoPtr<IBuffer>  AllocateStagingBuffer(Uint32 Size);
+    RefCntAutoPtr<ITexture> AllocateStagingTexture(const TextureDesc& Desc);
+    void                    RecycleStagingResources(PendingReadback& Readback);
+    Uint64                  EnqueueReadback(IDeviceContext* pContext, PendingReadback&& Readback);
+
+    const GPUReadbackCreateInfo m_CI;
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IFence>        m_pFence;
+
+    // Idle staging buffers bucketed by the power-of-two size
+    std::unordered_map<Uint32, std::vector<RefCntAutoPtr<IBuffer>>> m_FreeBuffers;
+    Uint64                                                          m_FreeBuffersSize = 0;
+
+    // Idle staging textures, in the order of release
+    std::deque<RefCntAutoPtr<ITexture>> m_FreeTextures;
+
+    // Readbacks that wait for the GPU, in the order of submission. The id of a readback is its fence value.
+    std::deque<PendingReadback> m_PendingReadbacks;
+
+    Uint64 m_NextId          = 1;
+    Uint64 m_LastCompletedId = 0;
+};
+
+} // namespace Diligent
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a GPUTextureCompressor class
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Compresses textures into block-compressed formats on the GPU.
+
+/// A compute shader encodes one 4x4 block per thread and writes the blocks to an intermediate
+/// texture of the uncompressed format returned by GetBlockCopyCompatibleFormat() (RG32_UINT or RGBA32_UINT),
+/// one texel per block. The texture is then copied to the compressed texture with IDeviceContext::CopyTexture().
+/// The encoders are the same as in CompressTexture() (see TextureCompressor.hpp) and produce the same blocks
+/// up to floating-point rounding, which makes the compressor suitable for textures that are generated
+/// on the GPU at run time, e.g. virtual texture pages, without a readback.
+///
+/// The device must support compute shaders. In OpenGL, copies between compressed and uncompressed
+/// textures require glCopyImageSubData (OpenGL 4.3 or OpenGLES 3.2).
+///
+/// Compress() must be called from the thread that owns the device context.
+class GPUTextureCompressor
+{
+public:
+    explicit GPUTextureCompressor(IRenderDevice* pDevice);
+
+    // clang-format off
+    GPUTextureCompressor           (const GPUTextureCompressor&)  = delete;
+    GPUTextureCompressor           (      GPUTextureCompressor&&) = delete;
+    GPUTextureCompressor& operator=(const GPUTextureCompressor&)  = delete;
+    GPUTextureCompressor& operator=(      GPUTextureCompressor&&) = delete;
+    // clang-format on
+
+    /// Returns true if the compressor can encode textures in the given format.
+
+    /// Supported formats are BC1, BC3, BC7 (in UNORM and UNORM_SRGB flavors), BC4_UNORM and BC5_UNORM.
+    /// BC7 blocks are encoded in mode 6.
+    static bool IsFormatSupported(TEXTURE_FORMAT Format);
+
+    /// Records commands that compress the texture into the mip level of the destination texture.
+
+    /// \param [in] pContext    - Device context to record the commands to.
+    /// \param [in] pSrcSRV     - Shader resource view of the source 2D texture. The view's most detailed
+    ///                           mip level is compressed, and its dimensions must be equal to the
+    ///                           dimensions of the destination mip level. If the view has an sRGB format,
+    ///                           the texels are converted back to gamma space, so that the compressed texture
+    ///                           has the same encoding as the source texture.
+    /// \param [in] pDstTexture - Destination 2D texture or 2D texture array in one of the supported formats.
+    /// \param [in] DstMipLevel - Destination mip level. Its width and height must be multiples of 4.
+    /// \param [in] DstSlice    - Destination array slice.
+    /// \return     true if the commands have been recorded, and false otherwise.
+    bool Compress(IDeviceContext* pContext,
+                  ITextureView*   pSrcSRV,
+                  ITexture*       pDstTexture,
+                  Uint32          DstMipLevel = 0,
+                  Uint32          DstSlice    = 0);
+
+private:
+    enum KERNEL : Uint32
+    {
+        KERNEL_BC1 = 0,
+        KERNEL_BC3,
+        KERNEL_BC4,
+        KERNEL_BC5,
+        KERNEL_BC7,
+        KERNEL_COUNT
+    };
+
+    static bool GetKernel(TEXTURE_FORMAT Format, KERNEL& Kernel);
+
+    bool      CreatePipeline(KERNEL Kernel, bool ConvertToSRGB);
+    ITexture* GetBlockTexture(TEXTURE_FORMAT Format, Uint32 NumBlocksX, Uint32 NumBlocksY);
+
+    RefCntAutoPtr<IRenderDevice>          m_pDevice;
+    RefCntAutoPtr<IBuffer>                m_pConstants;
+    RefCntAutoPtr<IPipelineState>         m_pPSO[KERNEL_COUNT][2];
+    RefCntAutoPtr<IShaderResourceBinding> m_pSRB[KERNEL_COUNT][2];
+
+    // Intermediate textures that the blocks are written to: RG32_UINT for 8-byte blocks
+    // and RGBA32_UINT for 16-byte blocks
+    RefCntAutoPtr<ITexture> m_pBlockTextures[2];
+};
+
+} // namespace Diligent
@@ -34,6 +34,8 @@
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 
+#include "../../../Primitives/interface/DefineGlobalFuncHelperMacros.h"
+
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
 void DILIGENT_GLOBAL_FUNCTION(CreateUniformBuffer)(IRenderDevice*                  pDevice,
@@ -61,4 +63,41 @@ void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(Uint32         FineLevelWidth,
                                                void*          pCoarseLevelData,
                                                Uint32         CoarseDataStrideInBytes);
 
+/// Attributes of the ComputeMipChain function
+struct ComputeMipChainAttribs
+{
+    /// Width of the most detailed mip level
+    Uint32         Width        DEFAULT_INITIALIZER(0);
+
+    /// Height of the most detailed mip level
+    Uint32         Height       DEFAULT_INITIALIZER(0);
+
+    /// Texture format
+    TEXTURE_FORMAT Format       DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// The number of mip levels, including the most detailed level
+    Uint32         NumMipLevels DEFAULT_INITIALIZER(0);
+
+    /// Array of NumMipLevels pointers to the mip level data.
+    /// Level 0 is the source data and is not modified.
+    void* const*   ppMipData    DEFAULT_INITIALIZER(nullptr);
+
+    /// Array of NumMipLevels row strides, in bytes
+    const Uint32*  pMipStrides  DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional thread pool used to compute rows of large levels in parallel.
+    /// The calling thread also computes the rows, so the function may be called
+    /// from a worker thread of the same pool. If null, all levels are computed by the calling thread.
+    /// Levels that are too small to benefit from threading are always computed by the calling thread.
+    struct IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
+
+/// Computes mip levels 1 to NumMipLevels-1 from the most detailed level using
+/// the same 2x2 box filter as ComputeMipLevel. Large levels are split between
+/// the worker threads of ComputeMipChainAttribs::pThreadPool.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
+
+#include "../../../Primitives/interface/UndefGlobalFuncHelperMacros.h"
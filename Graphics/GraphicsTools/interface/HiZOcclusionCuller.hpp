@@ -0,0 +1,229 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a HiZOcclusionCuller class
+
+#include <array>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/BasicMath.hpp"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "ParallelPrimitives.hpp"
+
+namespace Diligent
+{
+
+/// Hi-Z occlusion culler create information
+struct HiZOcclusionCullerCreateInfo
+{
+    /// Whether the depth buffer uses reverse depth, i.e. the near plane is at depth 1
+    /// and the far plane is at depth 0.
+    bool ReverseDepth = false;
+};
+
+/// Bounding box and draw arguments of an object culled by HiZOcclusionCuller.
+
+/// The objects are read from a structured buffer whose element stride is sizeof(HiZCullObject).
+struct HiZCullObject
+{
+    /// World-space bounding box minimum.
+    float3 BoundsMin;
+
+    /// The number of indices to draw.
+    Uint32 IndexCount = 0;
+
+    /// World-space bounding box maximum.
+    float3 BoundsMax;
+
+    /// The location of the first index in the index buffer.
+    Uint32 FirstIndexLocation = 0;
+
+    /// The value added to each index before reading a vertex from the vertex buffer.
+    Int32 BaseVertex = 0;
+
+    /// The number of instances to draw. Objects with zero indices or instances are always culled.
+    Uint32 NumInstances = 1;
+
+    /// The value added to each index before reading per-instance data from a vertex buffer.
+    Uint32 FirstInstanceLocation = 0;
+
+    Uint32 Padding = 0;
+};
+static_assert(sizeof(HiZCullObject) == 48, "The size of HiZCullObject must match the size of ObjectData in HiZOcclusionCuller.csh");
+
+/// Hi-Z culling attributes, see HiZOcclusionCuller::Cull().
+struct HiZCullAttribs
+{
+    /// Shader resource view of the structured buffer that contains HiZCullObject elements.
+    IBufferView* pObjectsSRV = nullptr;
+
+    /// The number of objects to cull.
+    Uint32 NumObjects = 0;
+
+    /// View-projection matrix of the camera the objects are culled for.
+    /// The objects are tested against the view frustum extracted from this matrix.
+    float4x4 ViewProj;
+
+    /// View-projection matrix of the camera the Hi-Z pyramid was built for, typically
+    /// the camera of the previous frame. The objects are tested against the pyramid
+    /// after being projected with this matrix.
+    float4x4 HiZViewProj;
+
+    /// Whether to test the objects against the Hi-Z pyramid. The test is also skipped
+    /// if the pyramid has not been built yet.
+    bool TestOcclusion = true;
+
+    /// Unordered access view of the buffer to write indexed indirect draw arguments to.
+    /// The buffer must be created with BUFFER_MODE_FORMATTED mode and BIND_INDIRECT_DRAW_ARGS flag,
+    /// the view must use VT_UINT32 x 1 format and must have room for 5 * NumObjects elements.
+    /// The arguments of the visible objects are written tightly packed, 20 bytes each.
+    IBufferView* pDrawArgsUAV = nullptr;
+
+    /// Unordered access view of the buffer to write the number of visible objects to.
+    /// The view must use VT_UINT32 x 1 format.
+    IBufferView* pCountUAV = nullptr;
+};
+
+/// Culls objects on the GPU against the view frustum and a hierarchical depth (Hi-Z) pyramid
+/// and writes indexed indirect draw arguments of the visible objects.
+
+/// BuildHiZ() copies a depth buffer, typically the one rendered in the previous frame, to the most
+/// detailed level of an R32_FLOAT texture and reduces every level to the next one, keeping the farthest
+/// depth, so that every texel of the pyramid bounds the depth of the pixels it covers. Cull() then tests
+/// the bounding box of every object against the frustum planes of the current camera (the same test as
+/// GetBoxVisibility() in AdvancedMath.hpp) and projects the box to the pyramid: if the nearest point of the
+/// box is behind the farthest depth in the up to 2x2 texels covering its screen-space rectangle, the object
+/// is occluded. The indices of the visible objects are compacted with ParallelPrimitives::Compact(), which
+/// preserves their order, and their draw arguments are written to the buffer provided by the application.
+/// The arguments and the count can be passed directly to IDeviceContext::DrawIndexedIndirectCount()
+/// with DrawArgsStride equal to 20, or the count can be read back to issue DrawIndexedIndirect() calls.
+///
+/// The device must support compute shaders. The commands are recorded into the given device context, and
+/// all resources are transitioned to the required states automatically. Internal buffers are allocated on demand
+/// and are reused by subsequent calls, so the object must not be used from multiple threads simultaneously.
+class HiZOcclusionCuller
+{
+public:
+    HiZOcclusionCuller(IRenderDevice* pDevice, const HiZOcclusionCullerCreateInfo& CI = HiZOcclusionCullerCreateInfo{});
+    ~HiZOcclusionCuller();
+
+    // clang-format off
+    HiZOcclusionCuller           (const HiZOcclusionCuller&)  = delete;
+    HiZOcclusionCuller           (      HiZOcclusionCuller&&) = delete;
+    HiZOcclusionCuller& operator=(const HiZOcclusionCuller&)  = delete;
+    HiZOcclusionCuller& operator=(      HiZOcclusionCuller&&) = delete;
+    // clang-format on
+
+    /// Builds the Hi-Z pyramid from the depth buffer.
+
+    /// \param [in] pContext  - Device context to record the commands to.
+    /// \param [in] pDepthSRV - Shader resource view of the single-sampled 2D depth texture, e.g. a D32_FLOAT
+    ///                         texture viewed as R32_FLOAT. The view's most detailed mip level is used.
+    ///                         The pyramid is recreated when the dimensions of the depth buffer change.
+    void BuildHiZ(IDeviceContext* pContext, ITextureView* pDepthSRV);
+
+    /// Culls the objects and writes draw arguments of the visible ones, see HiZCullAttribs.
+    void Cull(IDeviceContext* pContext, const HiZCullAttribs& Attribs);
+
+    /// Returns true if the Hi-Z pyramid has been built.
+    bool IsHiZReady() const
+    {
+        return m_HiZReady;
+    }
+
+    /// Discards the Hi-Z pyramid, e.g. after a camera cut, so that the following
+    /// Cull() calls only perform frustum culling until BuildHiZ() is called again.
+    void InvalidateHiZ()
+    {
+        m_HiZReady = false;
+    }
+
+    /// Returns the Hi-Z pyramid texture, or null if it has not been created yet.
+    ITexture* GetHiZTexture() const
+    {
+        return m_pHiZTexture.RawPtr<ITexture>();
+    }
+
+private:
+    enum KERNEL : Uint32
+    {
+        KERNEL_HIZ_COPY,
+        KERNEL_HIZ_DOWNSAMPLE,
+        KERNEL_CULL_OBJECTS,
+        KERNEL_WRITE_DRAW_ARGS,
+        KERNEL_COUNT
+    };
+
+    enum SCRATCH_BUFFER : Uint32
+    {
+        SCRATCH_BUFFER_FLAGS,
+        SCRATCH_BUFFER_INDICES,
+        SCRATCH_BUFFER_VISIBLE_INDICES,
+        SCRATCH_BUFFER_COUNT
+    };
+
+    struct Kernel
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    };
+
+    struct ScratchBuffer
+    {
+        RefCntAutoPtr<IBuffer>     pBuffer;
+        RefCntAutoPtr<IBufferView> pSRV;
+        RefCntAutoPtr<IBufferView> pUAV;
+    };
+
+    struct ShaderConstants;
+
+    bool           CreateKernels(bool ReverseDepth);
+    bool           CreateHiZTexture(Uint32 Width, Uint32 Height);
+    ScratchBuffer& GetScratchBuffer(SCRATCH_BUFFER Slot, Uint32 NumElements);
+
+    void SetVariable(KERNEL Kernel, const Char* Name, IDeviceObject* pObject);
+    void Dispatch(IDeviceContext* pContext, KERNEL Kernel, const ShaderConstants& Constants, Uint32 NumGroupsX, Uint32 NumGroupsY = 1);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IBuffer>       m_pConstants;
+
+    std::array<Kernel, KERNEL_COUNT>                m_Kernels;
+    std::array<ScratchBuffer, SCRATCH_BUFFER_COUNT> m_ScratchBuffers;
+
+    ParallelPrimitives m_Compactor;
+
+    RefCntAutoPtr<ITexture>                  m_pHiZTexture;
+    std::vector<RefCntAutoPtr<ITextureView>> m_HiZMipUAVs;
+    bool                                     m_HiZReady = false;
+};
+
+} // namespace Diligent
@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Meshlet builder and meshlet culling helpers for mesh shader pipelines
+
+#include <vector>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/ThreadPool.h"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Meshlet, see Diligent::BuildMeshlets().
+
+/// The layout of the structure is suitable for a structured buffer read by a mesh shader.
+struct Meshlet
+{
+    /// Offset of the first vertex of the meshlet in MeshletData::VertexIndices.
+    Uint32 VertexOffset = 0;
+
+    /// Offset of the first triangle of the meshlet in MeshletData::PrimitiveIndices.
+    Uint32 TriangleOffset = 0;
+
+    /// The number of unique vertices referenced by the meshlet.
+    Uint32 VertexCount = 0;
+
+    /// The number of triangles in the meshlet.
+    Uint32 TriangleCount = 0;
+};
+static_assert(sizeof(Meshlet) == 16, "Meshlet structure must be tightly packed");
+
+/// Meshlet culling bounds, see Diligent::BuildMeshlets().
+
+/// The bounds are given in the space of the mesh positions. The layout of the structure
+/// matches MeshletBounds in the meshlet culling shader, see Diligent::GetMeshletCullingShaderSource().
+struct MeshletBounds
+{
+    /// The center of the bounding sphere.
+    float3 Center;
+
+    /// The radius of the bounding sphere.
+    float Radius = 0;
+
+    /// The apex of the normal cone.
+    float3 ConeApex;
+
+    /// The cutoff of the normal cone.
+
+    /// All triangles of the meshlet are back-facing and the meshlet can be culled if
+    ///
+    ///     dot(normalize(ConeApex - CameraPos), ConeAxis) >= ConeCutoff
+    ///
+    /// When the normals of the triangles are spread too widely, the cutoff is set to 2
+    /// so that the test always fails.
+    float ConeCutoff = 2;
+
+    /// The axis of the normal cone.
+    float3 ConeAxis;
+
+    float Padding = 0;
+};
+static_assert(sizeof(MeshletBounds) == 48, "The size of MeshletBounds must match the size of MeshletBounds in MeshletCulling.ash");
+
+/// Meshlet build attributes, see Diligent::BuildMeshlets().
+struct MeshletBuildAttribs
+{
+    /// Pointer to the triangle list indices.
+    const Uint32* pIndices = nullptr;
+
+    /// The number of indices, must be a multiple of 3.
+    Uint32 NumIndices = 0;
+
+    /// Pointer to the first vertex position, three floats per vertex.
+    const void* pPositions = nullptr;
+
+    /// The stride, in bytes, between vertex positions.
+    Uint32 PositionStride = sizeof(float3);
+
+    /// The number of vertices. All indices must be less than this value.
+    Uint32 NumVertices = 0;
+
+    /// The maximum number of vertices in a meshlet, from 3 to 256.
+
+    /// The default values of MaxVertices and MaxTriangles fit the output of a mesh shader
+    /// thread group on all GPUs that support mesh shaders.
+    Uint32 MaxVertices = 64;
+
+    /// The maximum number of triangles in a meshlet, from 1 to 256.
+    Uint32 MaxTriangles = 124;
+
+    /// Whether to reorder the triangles for the post-transform vertex cache before
+    /// grouping them into meshlets, see Diligent::OptimizeVertexCache().
+    bool OptimizeVertexCache = true;
+
+    /// Optional thread pool used to build the meshlets in parallel.
+
+    /// The triangles are split into fixed-size chunks that are optimized and grouped into
+    /// meshlets independently, so the result does not depend on the number of threads.
+    /// The calling thread also processes the chunks and returns as soon as all of them are
+    /// done, so the function may be called from a worker thread of the same pool.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Meshlets built by Diligent::BuildMeshlets().
+struct MeshletData
+{
+    /// Meshlets.
+    std::vector<Meshlet> Meshlets;
+
+    /// Culling bounds, one element for each meshlet.
+    std::vector<MeshletBounds> Bounds;
+
+    /// Mesh vertex indices referenced by the meshlets. The vertices of every
+    /// meshlet occupy a contiguous range starting at Meshlet::VertexOffset.
+    std::vector<Uint32> VertexIndices;
+
+    /// Meshlet triangles, one element for each triangle. Every element packs three 8-bit
+    /// indices into the meshlet's range of VertexIndices: i0 | (i1 << 8) | (i2 << 16).
+    std::vector<Uint32> PrimitiveIndices;
+};
+
+/// Builds meshlets for the triangle list.
+
+/// The triangles are optionally reordered for the vertex cache and are then added to the current
+/// meshlet in order until the meshlet runs out of vertices or triangles. Since the optimized order
+/// keeps neighboring triangles together, the meshlets reuse most of their vertices and are compact
+/// in space, which makes their bounds tight. The winding of the triangles is preserved.
+///
+/// \param [in]  Attribs - Meshlet build attributes.
+/// \param [out] Data    - Meshlets and their culling bounds. The previous contents are replaced.
+/// \return     true if the meshlets have been built, and false if the attributes are invalid.
+bool BuildMeshlets(const MeshletBuildAttribs& Attribs, MeshletData& Data);
+
+/// Reorders the triangles to improve the post-transform vertex cache hit rate.
+
+/// The function implements the linear-speed vertex cache optimization algorithm by Tom Forsyth
+/// for a 32-entry LRU cache. The winding of the triangles is preserved.
+///
+/// \param [in]  pIndices    - Triangle list indices.
+/// \param [in]  NumIndices  - The number of indices, must be a multiple of 3.
+/// \param [in]  NumVertices - The number of vertices. All indices must be less than this value.
+/// \param [out] pDstIndices - Reordered indices. Must not overlap with pIndices.
+void OptimizeVertexCache(const Uint32* pIndices, Uint32 NumIndices, Uint32 NumVertices, Uint32* pDstIndices);
+
+
+/// Meshlet culling shader constants, see Diligent::GetMeshletCullingShaderSource().
+struct MeshletCullingConstants
+{
+    /// Normalized frustum planes in the space of the mesh positions,
+    /// in the same order as in Diligent::ViewFrustum.
+    float4 FrustumPlanes[6];
+
+    /// Camera position in the space of the mesh positions.
+    float3 CameraPos;
+
+    /// The number of meshlets to cull.
+    Uint32 NumMeshlets = 0;
+};
+static_assert(sizeof(MeshletCullingConstants) == 112, "The size of MeshletCullingConstants must match the size of cbMeshletCulling in MeshletCulling.ash");
+
+/// Computes the meshlet culling shader constants.
+
+/// \param [in]  WorldViewProj - Matrix that transforms the mesh positions to the clip space.
+/// \param [in]  CameraPos     - Camera position in the space of the mesh positions.
+/// \param [in]  NumMeshlets   - The number of meshlets.
+/// \param [in]  IsGL          - Whether the clip space depth range is [-1, 1], see ExtractViewFrustumPlanesFromMatrix().
+/// \param [out] Constants     - Shader constants.
+///
+/// \remarks    The cone test is only exact when the world transform of the mesh has uniform scale.
+void ComputeMeshletCullingConstants(const float4x4&          WorldViewProj,
+                                    const float3&            CameraPos,
+                                    Uint32                   NumMeshlets,
+                                    bool                     IsGL,
+                                    MeshletCullingConstants& Constants);
+
+/// Returns the HLSL source of the reference amplification shader that culls meshlets.
+
+/// Every thread of the shader tests one meshlet against the view frustum (bounding sphere) and
+/// the camera position (normal cone), and the group launches one mesh shader thread group for every
+/// visible meshlet. The shader uses the following resources:
+///
+///     cbuffer cbMeshletCulling                           - MeshletCullingConstants
+///     StructuredBuffer<MeshletBounds> g_MeshletBounds    - MeshletData::Bounds
+///
+/// The number of threads in a group is defined by the AS_GROUP_SIZE macro (32 by default), so the draw
+/// command must launch (NumMeshlets + AS_GROUP_SIZE - 1) / AS_GROUP_SIZE groups. The mesh shader receives
+/// the indices of the visible meshlets in the payload and must declare the same structure:
+///
+///     struct MeshletPayload
+///     {
+///         uint MeshletIndices[AS_GROUP_SIZE];
+///     };
+///
+///     void main(in uint GroupId : SV_GroupID, in payload MeshletPayload Payload, ...)
+///     {
+///         uint MeshletIndex = Payload.MeshletIndices[GroupId];
+///         ...
+///     }
+///
+/// The shader must be compiled with DXC, and the device must support mesh shaders.
+const char* GetMeshletCullingShaderSource();
+
+} // namespace Diligent
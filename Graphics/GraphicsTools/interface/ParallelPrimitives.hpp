@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ParallelPrimitives class
+
+#include <array>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Parallel primitives create information
+struct ParallelPrimitivesCreateInfo
+{
+    /// Whether to use wave (subgroup) intrinsics when the device supports them.
+    /// Wave intrinsics are used on Direct3D12 and Vulkan devices that support basic and
+    /// arithmetic wave operations in compute shaders. Other devices use group shared memory.
+    bool EnableWaveOps = true;
+};
+
+/// Reduction operation
+enum PARALLEL_REDUCE_OP : Uint8
+{
+    /// Sum of all elements
+    PARALLEL_REDUCE_OP_SUM = 0,
+
+    /// Minimum of all elements
+    PARALLEL_REDUCE_OP_MIN,
+
+    /// Maximum of all elements
+    PARALLEL_REDUCE_OP_MAX,
+
+    PARALLEL_REDUCE_OP_COUNT
+};
+
+/// Implements common data-parallel algorithms on the GPU: reduction, exclusive prefix sum,
+/// stream compaction and radix sort of 32-bit unsigned integers.
+
+/// All buffers are accessed through formatted buffer views with VT_UINT32 x 1 format,
+/// so the buffers must be created with BUFFER_MODE_FORMATTED mode. The commands are recorded
+/// into the given device context; all resources are transitioned to the required states automatically.
+/// All kernels are compiled when the object is created. Temporary buffers are allocated on demand and are reused by subsequent calls, so the object must
+/// not be used from multiple threads simultaneously.
+class ParallelPrimitives
+{
+public:
+    ParallelPrimitives(IRenderDevice* pDevice, const ParallelPrimitivesCreateInfo& CI = ParallelPrimitivesCreateInfo{});
+    ~ParallelPrimitives();
+
+    // clang-format off
+    ParallelPrimitives           (const ParallelPrimitives&)  = delete;
+    ParallelPrimitives           (      ParallelPrimitives&&) = delete;
+    ParallelPrimitives& operator=(const ParallelPrimitives&)  = delete;
+    ParallelPrimitives& operator=(      ParallelPrimitives&&) = delete;
+    // clang-format on
+
+    /// Reduces NumElements elements of the input buffer and writes the result to the first element of the output buffer.
+
+    /// \param [in] pContext    - Device context to record the commands to.
+    /// \param [in] pInputSRV   - Shader resource view of the input buffer.
+    /// \param [in] pResultUAV  - Unordered access view of the buffer to write the result to.
+    /// \param [in] NumElements - The number of elements to reduce. If it is zero, nothing is written.
+    /// \param [in] Op          - Reduction operation.
+    void Reduce(IDeviceContext*    pContext,
+                IBufferView*       pInputSRV,
+                IBufferView*       pResultUAV,
+                Uint32             NumElements,
+                PARALLEL_REDUCE_OP Op = PARALLEL_REDUCE_OP_SUM);
+
+    /// Computes exclusive prefix sum of NumElements elements of the input buffer.
+
+    /// \param [in] pContext    - Device context to record the commands to.
+    /// \param [in] pInputSRV   - Shader resource view of the input buffer.
+    /// \param [in] pOutputUAV  - Unordered access view of the output buffer. It must not reference the input buffer.
+    /// \param [in] NumElements - The number of elements to scan.
+    void ExclusiveScan(IDeviceContext* pContext,
+                       IBufferView*    pInputSRV,
+                       IBufferView*    pOutputUAV,
+                       Uint32          NumElements);
+
+    /// Writes the elements of the input buffer whose flags are 1 to consecutive locations of the
+    /// output buffer, preserving their relative order, and writes their count to the first element
+    /// of the count buffer.
+
+    /// \param [in] pContext    - Device context to record the commands to.
+    /// \param [in] pInputSRV   - Shader resource view of the input buffer.
+    /// \param [in] pFlagsSRV   - Shader resource view of the flags buffer. Every flag must be 0 or 1.
+    /// \param [in] pOutputUAV  - Unordered access view of the output buffer.
+    /// \param [in] pCountUAV   - Unordered access view of the buffer to write the number of selected elements to.
+    /// \param [in] NumElements - The number of elements in the input buffer.
+    void Compact(IDeviceContext* pContext,
+                 IBufferView*    pInputSRV,
+                 IBufferView*    pFlagsSRV,
+                 IBufferView*    pOutputUAV,
+                 IBufferView*    pCountUAV,
+                 Uint32          NumElements);
+
+    /// Sorts NumElements keys in ascending order, optionally reordering the values along with the keys.
+    /// The sort is stable and is performed in place.
+
+    /// \param [in] pContext    - Device context to record the commands to.
+    /// \param [in] pKeysUAV    - Unordered access view of the keys buffer.
+    /// \param [in] pValuesUAV  - Unordered access view of the values buffer. May be null.
+    /// \param [in] NumElements - The number of keys to sort.
+    /// \param [in] NumKeyBits  - The number of low bits of the keys to sort by. Sorting
+    ///                           by fewer bits requires fewer passes.
+    void RadixSort(IDeviceContext* pContext,
+                   IBufferView*    pKeysUAV,
+                   IBufferView*    pValuesUAV,
+                   Uint32          NumElements,
+                   Uint32          NumKeyBits = 32);
+
+    /// Returns true if the kernels use wave intrinsics.
+    bool UsesWaveOps() const
+    {
+        return m_UseWaveOps;
+    }
+
+private:
+    enum KERNEL : Uint32
+    {
+        KERNEL_REDUCE_SUM,
+        KERNEL_REDUCE_MIN,
+        KERNEL_REDUCE_MAX,
+        KERNEL_SCAN_BLOCKS,
+        KERNEL_ADD_BLOCK_OFFSETS,
+        KERNEL_COMPACT,
+        KERNEL_RADIX_HISTOGRAM,
+        KERNEL_RADIX_SCATTER_KEYS,
+        KERNEL_RADIX_SCATTER_PAIRS,
+        KERNEL_COUNT
+    };
+
+    struct Kernel
+    {
+        RefCntAutoPtr<IPipelineState>         pPSO;
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    };
+
+    struct ScratchBuffer
+    {
+        RefCntAutoPtr<IBuffer>     pBuffer;
+        RefCntAutoPtr<IBufferView> pSRV;
+        RefCntAutoPtr<IBufferView> pUAV;
+    };
+
+    bool          CreateKernels(bool UseWaveOps);
+    ScratchBuffer GetScratchBuffer(Uint32 Slot, Uint32 NumElements);
+
+    void SetVariable(KERNEL Kernel, const Char* Name, IBufferView* pView);
+    void Dispatch(IDeviceContext* pContext, KERNEL Kernel, Uint32 NumGroups, Uint32 NumElements, Uint32 RadixShift = 0, Uint32 NumBlocks = 0);
+    void ScanInternal(IDeviceContext* pContext, IBufferView* pInputSRV, IBufferView* pOutputUAV, Uint32 NumElements, Uint32 Level);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    RefCntAutoPtr<IBuffer>       m_pConstants;
+
+    bool m_UseWaveOps = false;
+
+    std::array<Kernel, KERNEL_COUNT> m_Kernels;
+    std::vector<ScratchBuffer>       m_ScratchBuffers;
+};
+
+} // namespace Diligent
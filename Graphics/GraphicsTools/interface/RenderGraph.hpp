@@ -0,0 +1,352 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a RenderGraph class
+
+#include <vector>
+#include <array>
+#include <string>
+#include <functional>
+#include <map>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/RenderPass.h"
+#include "../../GraphicsEngine/interface/Framebuffer.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Render graph create information
+struct RenderGraphCreateInfo
+{
+    /// Whether consecutive raster passes with compatible attachments should be merged
+    /// into subpasses of a single render pass. This is primarily beneficial on tile-based GPUs
+    /// where intermediate attachments then never leave the on-chip memory.
+    bool MergeRenderPasses = true;
+
+    /// The number of Compile() calls a pooled transient texture may stay unused
+    /// before it is released.
+    Uint32 MaxUnusedTextureAge = 4;
+};
+
+/// Render graph statistics, updated by Compile() and Execute()
+struct RenderGraphStatistics
+{
+    /// The total number of passes added to the graph
+    Uint32 NumPasses = 0;
+
+    /// The number of passes that were culled because their results are never used
+    Uint32 NumCulledPasses = 0;
+
+    /// The number of render passes that raster passes were grouped into
+    Uint32 NumRenderPasses = 0;
+
+    /// The number of raster passes that were merged into a preceding render pass as subpasses
+    Uint32 NumMergedPasses = 0;
+
+    /// The number of transient textures used by non-culled passes
+    Uint32 NumTransientTextures = 0;
+
+    /// The number of texture objects that back transient textures.
+    /// Transient textures with identical descriptions and non-overlapping lifetimes share the same object.
+    Uint32 NumTextureObjects = 0;
+
+    /// The number of state transitions issued by the last Execute() call
+    Uint32 NumBarriers = 0;
+};
+
+/// Render graph
+
+/// The render graph takes the list of passes together with the resources that every pass reads and writes,
+/// and then
+/// - culls passes whose results do not contribute to the graph outputs,
+/// - allocates transient textures, reusing the same texture objects for resources with non-overlapping lifetimes,
+/// - groups raster passes into render passes, merging compatible consecutive passes into subpasses,
+/// - issues the minimal set of resource state transitions before every pass using
+///   IDeviceContext::TransitionResourceStates().
+///
+/// Passes are executed in the order they were added. Typical usage:
+///
+///     Graph.Reset();
+///     auto GBuffer = Graph.CreateTexture(GBufferDesc);
+///     auto BackBuffer = Graph.ImportTexture(pBackBuffer);
+///     Graph.AddPass("GBuffer", DrawGBuffer).SetRenderTarget(0, GBuffer, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue);
+///     Graph.AddPass("Lighting", DrawLighting).ReadInputAttachment(GBuffer).SetRenderTarget(0, BackBuffer);
+///     Graph.Compile();
+///     Graph.Execute(pContext);
+///
+/// \remarks    Raster passes are executed inside a render pass. Execute callbacks must therefore
+///             not transition resource states and should use RESOURCE_STATE_TRANSITION_MODE_VERIFY
+///             or RESOURCE_STATE_TRANSITION_MODE_NONE. Pipeline states used by a raster pass must be
+///             created with the render pass and subpass index returned by GetRenderPass().
+///             Render passes are cached, so the same render pass object is returned as long as
+///             the pass configuration does not change.
+class RenderGraph
+{
+public:
+    /// Resource identifier
+    using ResourceId = Uint32;
+
+    /// Pass identifier
+    using PassId = Uint32;
+
+    static constexpr ResourceId InvalidResourceId = ~0u;
+
+    /// Pass execution callback
+    using ExecuteCallbackType = std::function<void(const RenderGraph& Graph, IDeviceContext* pContext)>;
+
+    /// Helper class that declares the resources used by a pass
+    class PassBuilder
+    {
+    public:
+        /// Declares that the pass reads the resource in the given state.
+        PassBuilder& Read(ResourceId Id, RESOURCE_STATE State = RESOURCE_STATE_SHADER_RESOURCE);
+
+        /// Declares that the pass writes the resource in the given state.
+        PassBuilder& Write(ResourceId Id, RESOURCE_STATE State = RESOURCE_STATE_UNORDERED_ACCESS);
+
+        /// Sets the render target at the given index.
+
+        /// \param[in] Index       - Render target index.
+        /// \param[in] Id          - Texture resource identifier.
+        /// \param[in] LoadOp      - Load operation. ATTACHMENT_LOAD_OP_LOAD makes the pass read the previous contents.
+        /// \param[in] pClearValue - Clear value, used when LoadOp is ATTACHMENT_LOAD_OP_CLEAR.
+        PassBuilder& SetRenderTarget(Uint32                     Index,
+                                     ResourceId                 Id,
+                                     ATTACHMENT_LOAD_OP         LoadOp      = ATTACHMENT_LOAD_OP_LOAD,
+                                     const OptimizedClearValue* pClearValue = nullptr);
+
+        /// Sets the depth-stencil attachment.
+
+        /// \param[in] Id          - Texture resource identifier.
+        /// \param[in] LoadOp      - Load operation for both depth and stencil components.
+        /// \param[in] pClearValue - Clear value, used when LoadOp is ATTACHMENT_LOAD_OP_CLEAR.
+        /// \param[in] ReadOnly    - Whether the pass only reads the depth-stencil buffer.
+        PassBuilder& SetDepthStencil(ResourceId                 Id,
+                                     ATTACHMENT_LOAD_OP         LoadOp      = ATTACHMENT_LOAD_OP_LOAD,
+                                     const OptimizedClearValue* pClearValue = nullptr,
+                                     bool                       ReadOnly    = false);
+
+        /// Adds an input attachment. Input attachments are indexed in the order they are added.
+        PassBuilder& ReadInputAttachment(ResourceId Id);
+
+        /// Marks the pass as having side effects that are not expressed through its outputs,
+        /// which prevents the pass from being culled.
+        PassBuilder& SetSideEffects();
+
+        PassId GetId() const { return m_Id; }
+
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph& Graph, PassId Id) :
+            m_Graph{Graph},
+            m_Id{Id}
+        {}
+
+        RenderGraph& m_Graph;
+        const PassId m_Id;
+    };
+
+    explicit RenderGraph(IRenderDevice* pDevice, const RenderGraphCreateInfo& CI = RenderGraphCreateInfo{});
+
+    // clang-format off
+    RenderGraph           (const RenderGraph&)  = delete;
+    RenderGraph& operator=(const RenderGraph&)  = delete;
+    RenderGraph           (      RenderGraph&&) = delete;
+    RenderGraph& operator=(      RenderGraph&&) = delete;
+    // clang-format on
+
+    ~RenderGraph();
+
+    /// Removes all passes and resources from the graph.
+    /// Pooled textures, render passes and framebuffers are kept and reused by the next Compile().
+    void Reset();
+
+    /// Declares a transient texture that is allocated by the graph.
+    /// Bind flags required by the passes are added to Desc.BindFlags automatically.
+    ResourceId CreateTexture(const TextureDesc& Desc);
+
+    /// Imports an external texture. Imported resources are graph outputs.
+    ResourceId ImportTexture(ITexture* pTexture);
+
+    /// Imports an external buffer. Imported resources are graph outputs.
+    ResourceId ImportBuffer(IBuffer* pBuffer);
+
+    /// Marks the resource as a graph output, so that the passes that produce it are not culled.
+    void MarkOutput(ResourceId Id);
+
+    /// Adds a pass to the graph.
+    PassBuilder AddPass(const char* Name, ExecuteCallbackType Execute);
+
+    /// Culls unused passes, allocates transient textures and creates render passes and framebuffers.
+    void Compile();
+
+    /// Executes all passes that have not been culled.
+    void Execute(IDeviceContext* pContext);
+
+    /// Returns the texture object of the resource. Transient textures are available after Compile().
+    ITexture* GetTexture(ResourceId Id) const;
+
+    /// Returns the buffer object of the resource.
+    IBuffer* GetBuffer(ResourceId Id) const;
+
+    /// Returns the render pass that the raster pass is executed in and the subpass index, or null
+    /// if the pass is not a raster pass or has been culled. Available after Compile().
+    IRenderPass* GetRenderPass(PassId Id, Uint32* pSubpassIndex = nullptr) const;
+
+    /// Returns true if the pass has been culled by Compile().
+    bool IsPassCulled(PassId Id) const;
+
+    const RenderGraphStatistics& GetStatistics() const { return m_Stats; }
+
+private:
+    static constexpr Uint32 InvalidIndex = ~0u;
+
+    struct ResourceAccess
+    {
+        ResourceId     Id    = InvalidResourceId;
+        RESOURCE_STATE State = RESOURCE_STATE_UNKNOWN;
+        bool           Write = false;
+    };
+
+    struct AttachmentInfo
+    {
+        ResourceId          Id       = InvalidResourceId;
+        ATTACHMENT_LOAD_OP  LoadOp   = ATTACHMENT_LOAD_OP_LOAD;
+        bool                ReadOnly = false;
+        OptimizedClearValue ClearValue;
+    };
+
+    struct PassInfo
+    {
+        std::string         Name;
+        ExecuteCallbackType Execute;
+
+        // Resources accessed outside of attachments
+        std::vector<ResourceAccess> Accesses;
+
+        std::array<AttachmentInfo, MAX_RENDER_TARGETS> RenderTargets;
+
+        Uint32                  NumRenderTargets = 0;
+        AttachmentInfo          DepthStencil;
+        std::vector<ResourceId> InputAttachments;
+        bool                    HasSideEffects = false;
+
+        // Compile-time data
+        Uint32 RefCount     = 0;
+        bool   Culled       = false;
+        Uint32 GroupIndex   = InvalidIndex;
+        Uint32 SubpassIndex = 0;
+
+        bool IsRasterPass() const
+        {
+            return NumRenderTargets > 0 || DepthStencil.Id != InvalidResourceId || !InputAttachments.empty();
+        }
+    };
+
+    struct ResourceInfo
+    {
+        TextureDesc TexDesc;
+        std::string Name;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        RefCntAutoPtr<IBuffer>  pBuffer;
+
+        bool IsTransient = false;
+        bool IsOutput    = false;
+
+        // Compile-time data
+        Uint32 RefCount  = 0;
+        Uint32 FirstPass = InvalidIndex;
+        Uint32 LastPass  = 0;
+    };
+
+    // Consecutive passes that are executed together. Raster passes in a group are subpasses of one render pass.
+    struct PassGroup
+    {
+        std::vector<PassId>              Passes;
+        std::vector<ResourceId>          Attachments;
+        std::vector<OptimizedClearValue> ClearValues;
+
+        // Resources accessed by the passes of the group outside of attachments
+        std::vector<ResourceAccess> Accesses;
+
+        IRenderPass*                pRenderPass = nullptr;
+        RefCntAutoPtr<IFramebuffer> pFramebuffer;
+
+        bool IsRaster = false;
+    };
+
+    struct PooledTexture
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+
+        Uint32 UnusedAge = 0;
+        // Index of the last pass that uses the texture during the current compilation
+        Uint32 BusyUntilPass = InvalidIndex;
+    };
+
+    ResourceInfo&       GetResource(ResourceId Id);
+    const ResourceInfo& GetResource(ResourceId Id) const;
+    AttachmentInfo MakeAttachment(ResourceId Id, ATTACHMENT_LOAD_OP LoadOp, const OptimizedClearValue* pClearValue, bool ReadOnly) const;
+
+    void CullPasses();
+    void ComputeLifetimes();
+    void AllocateTransientTextures();
+    void GroupPasses();
+    void AddPassToGroup(PassGroup& Group, PassId Id);
+    bool CanMergePass(const PassGroup& Group, const PassInfo& Pass) const;
+    void CreateRenderPass(PassGroup& Group);
+    void CreateFramebuffer(PassGroup& Group, std::map<std::vector<void*>, RefCntAutoPtr<IFramebuffer>>& FramebufferCache);
+
+    template <typename HandlerType>
+    static void ProcessPassResources(const PassInfo& Pass, HandlerType&& Handler);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+    const RenderGraphCreateInfo  m_CreateInfo;
+
+    std::vector<PassInfo>     m_Passes;
+    std::vector<ResourceInfo> m_Resources;
+    std::vector<PassGroup>    m_Groups;
+
+    std::vector<PooledTexture> m_TexturePool;
+
+    // Render passes and framebuffers are cached across compilations
+    std::map<std::vector<Uint32>, RefCntAutoPtr<IRenderPass>>    m_RenderPassCache;
+    std::map<std::vector<void*>, RefCntAutoPtr<IFramebuffer>>    m_FramebufferCache;
+    std::vector<StateTransitionDesc>                             m_Barriers;
+
+    bool                  m_IsCompiled = false;
+    RenderGraphStatistics m_Stats;
+};
+
+} // namespace Diligent
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a ShaderHotReloader class
+
+#include <future>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Shader hot reloader create information
+struct ShaderHotReloaderCreateInfo
+{
+    /// Semicolon-separated list of directories to watch for shader source file modifications,
+    /// typically the same directories that the shader source stream factory searches.
+    /// Subdirectories are watched as well.
+    const Char* WatchDirectories = nullptr;
+
+    /// On platforms that do not support directory change notifications, the reloader
+    /// polls the status of shader source files. This is the minimal interval between
+    /// two polls, in milliseconds.
+    Uint32 PollingInterval = 500;
+};
+
+/// Shader hot reloader statistics
+struct ShaderHotReloaderStatistics
+{
+    /// The number of shaders that have been recompiled
+    Uint32 NumReloadedShaders = 0;
+
+    /// The number of shaders that have failed to compile
+    Uint32 NumFailedShaders = 0;
+
+    /// The number of pipelines whose shaders have been replaced
+    Uint32 NumUpdatedPipelines = 0;
+
+    /// The number of pipelines that have failed to be rebuilt or whose
+    /// new shaders are not compatible with the existing pipeline
+    Uint32 NumFailedPipelines = 0;
+};
+
+/// Recompiles shaders when their source files are modified and updates the pipelines that use them.
+
+/// Shaders and pipelines must be created through the reloader. While compiling a shader, the reloader
+/// records all files the shader source stream factory opens, including the files included by the shader,
+/// so that modification of any of them triggers recompilation.
+///
+/// Only the shaders that depend on the modified files and the pipelines that use these shaders are rebuilt.
+/// The rebuilt pipelines exchange their shaders with the existing pipeline objects (see IPipelineState::SwapShaders()),
+/// so the application keeps using the same pipeline and shader resource binding objects.
+/// Resource layouts of the new shaders must be compatible with the existing pipelines, otherwise the pipeline
+/// is not updated and an error is reported.
+///
+/// The reloader keeps strong references to the shaders it created. Pipelines are referenced weakly.
+/// Shader objects returned by CreateShader() are not updated; only the pipelines that use them are.
+class ShaderHotReloader
+{
+public:
+    ShaderHotReloader(IRenderDevice* pDevice, const ShaderHotReloaderCreateInfo& CI);
+    ~ShaderHotReloader();
+
+    // clang-format off
+    ShaderHotReloader           (const ShaderHotReloader&)  = delete;
+    ShaderHotReloader           (      ShaderHotReloader&&) = delete;
+    ShaderHotReloader& operator=(const ShaderHotReloader&)  = delete;
+    ShaderHotReloader& operator=(      ShaderHotReloader&&) = delete;
+    // clang-format on
+
+    /// Creates a shader and records the files it depends on, see IRenderDevice::CreateShader().
+    void CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+
+    /// Creates a graphics pipeline that is updated when its shaders are reloaded, see IRenderDevice::CreateGraphicsPipelineState().
+    void CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+
+    /// Creates a compute pipeline that is updated when its shaders are reloaded, see IRenderDevice::CreateComputePipelineState().
+    void CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState);
+
+    /// Checks for modified shader source files and updates the affected pipelines.
+
+    /// \param [in] pContext - Device context that is used for rendering with the pipelines.
+    ///                        The context state is invalidated when any pipeline is updated.
+    /// \return     The number of pipelines that have been updated.
+    ///
+    /// \remarks    The method should be called once per frame, between frames: no device context may
+    ///             be recording commands with the reloaded pipelines while they are updated.
+    ///             Contexts other than pContext must be invalidated by the application.
+    ///
+    ///             Shaders and pipelines are rebuilt by a background thread, and the pipelines are updated
+    ///             by one of the subsequent calls once the rebuild has completed. In OpenGL backend, objects
+    ///             can only be created by the thread that owns the context, so the rebuild is performed
+    ///             by the calling thread.
+    Uint32 Update(IDeviceContext* pContext);
+
+    /// Returns the reloader statistics
+    const ShaderHotReloaderStatistics& GetStatistics() const { return m_Stats; }
+
+private:
+    struct ShaderInfo;
+    struct PipelineInfo;
+    struct RebuildBatch;
+    class FileTracker;
+
+    void AddPipeline(IPipelineState* pPSO, const GraphicsPipelineStateCreateInfo* pGraphicsCI, const ComputePipelineStateCreateInfo* pComputeCI);
+
+    void   StartRebuild();
+    Uint32 ApplyRebuild(IDeviceContext* pContext);
+
+    static void Rebuild(IRenderDevice* pDevice, RebuildBatch& Result);
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    // GL objects can only be created by the thread that owns the context
+    const bool m_RebuildInBackground;
+
+    std::unique_ptr<FileTracker> m_pFileTracker;
+
+    std::vector<std::unique_ptr<ShaderInfo>>   m_Shaders;
+    std::vector<std::unique_ptr<PipelineInfo>> m_Pipelines;
+
+    // Modified files that have not been processed yet
+    std::unordered_set<String> m_ModifiedFiles;
+
+    std::unique_ptr<RebuildBatch> m_pRebuild;
+    std::future<void>              m_RebuildTask;
+
+    ShaderHotReloaderStatistics m_Stats;
+};
+
+} // namespace Diligent
@@ -39,20 +39,31 @@
 // WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.  Intel does not
 // assume any responsibility for any errors which may appear in this software nor any
 // responsibility to update it.
-//--------------------------------------------------------------------------------------
 #pragma once
 
-#include <set>
 #include <vector>
+#include <memory>
 #include <sstream>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include "../../GraphicsEngine/interface/Shader.h"
+#include "../../../Common/interface/ArenaAllocator.hpp"
+#include "../../../Common/interface/DefaultRawMemoryAllocator.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
 
 namespace Diligent
 {
 
+/// Builds a null-terminated array of shader macros.
+
+/// Macro names and definitions are copied into a memory arena that is reused after Clear(),
+/// and numbers are formatted without going through streams, so that building many shader
+/// permutations with the same helper does not allocate memory once the arena has grown.
+///
+/// The helper also maintains a 64-bit hash of the macro set that is updated as macros are added
+/// and removed. The hash does not depend on the order of the macros, does not use std::hash and
+/// is the same on all platforms and in all runs, so it may be used as a shader cache key.
 class ShaderMacroHelper
 {
 public:
@@ -75,18 +86,19 @@ public:
 
     ShaderMacroHelper() = default;
 
-    // NB: we need to make sure that string pointers in m_Macros don't become invalid
-    //     after the copy or move due to short string optimization in std::string
+    // Names and definitions are copied into the new arena so that
+    // the copy does not reference the memory owned by rhs.
     ShaderMacroHelper(const ShaderMacroHelper& rhs) :
         m_Macros{rhs.m_Macros},
+        m_Hash{rhs.m_Hash},
         m_bIsFinalized{rhs.m_bIsFinalized}
     {
-        for (auto& Macros : m_Macros)
+        for (auto& Macro : m_Macros)
         {
-            if (Macros.Definition != nullptr)
-                Macros.Definition = m_StringPool.insert(Macros.Definition).first->c_str();
-            if (Macros.Name != nullptr)
-                Macros.Name = m_StringPool.insert(Macros.Name).first->c_str();
+            if (Macro.Definition != nullptr)
+                Macro.Definition = CopyString(Macro.Definition);
+            if (Macro.Name != nullptr)
+                Macro.Name = CopyString(Macro.Name);
         }
     }
 
@@ -96,6 +108,7 @@ public:
         return *this;
     }
 
+    // The arena is moved by pointer, so string pointers in m_Macros remain valid
     ShaderMacroHelper(ShaderMacroHelper&&) = default;
     ShaderMacroHelper& operator=(ShaderMacroHelper&&) = default;
 
@@ -118,10 +131,13 @@ public:
         }
     }
 
+    /// Removes all macros. The memory is kept and reused by the macros added next.
     void Clear()
     {
         m_Macros.clear();
-        m_StringPool.clear();
+        if (m_pArena)
+            m_pArena->Reset();
+        m_Hash         = 0;
         m_bIsFinalized = false;
     }
 
@@ -139,6 +155,7 @@ public:
         {
             if (strcmp(m_Macros[i].Name, Name) == 0)
             {
+                m_Hash -= ComputeMacroHash(m_Macros[i].Name, m_Macros[i].Definition);
                 m_Macros.erase(m_Macros.begin() + i);
                 break;
             }
@@ -156,19 +173,83 @@ public:
         AddShaderMacro(Name, Definition);
     }
 
+    /// Returns the hash of the current macro set.
+    Uint64 GetHash() const
+    {
+        return m_Hash;
+    }
+
 private:
+    const Char* CopyString(const Char* Str)
+    {
+        return CopyString(Str, strlen(Str));
+    }
+
+    const Char* CopyString(const Char* Str, size_t Len)
+    {
+        if (!m_pArena)
+            m_pArena.reset(new ArenaAllocator{DefaultRawMemoryAllocator::GetAllocator(), 4 << 10});
+
+        auto* Copy = m_pArena->Allocate<Char>(Len + 1);
+        memcpy(Copy, Str, Len);
+        Copy[Len] = '\0';
+        return Copy;
+    }
+
+    // Writes the decimal digits of Value to the buffer that ends at pEnd and returns the pointer to the first digit.
+    static Char* FormatDecimal(Char* pEnd, Uint64 Value)
+    {
+        do
+        {
+            *(--pEnd) = static_cast<Char>('0' + Value % 10);
+            Value /= 10;
+        } while (Value != 0);
+        return pEnd;
+    }
+
+    // 64-bit FNV-1a hash of the name and the definition, with the final mixing step of MurmurHash3
+    // that spreads the bits, so that the sum of the macro hashes is well distributed.
+    static Uint64 ComputeMacroHash(const Char* Name, const Char* Definition)
+    {
+        Uint64 Hash = 0xcbf29ce484222325ull;
+
+        const auto HashString = [&Hash](const Char* Str) {
+            // Include the null terminator to separate the name from the definition
+            do
+            {
+                Hash = (Hash ^ static_cast<Uint8>(*Str)) * 0x100000001b3ull;
+            } while (*(Str++) != '\0');
+        };
+        HashString(Name);
+        HashString(Definition);
+
+        Hash ^= Hash >> 33;
+        Hash *= 0xff51afd7ed558ccdull;
+        Hash ^= Hash >> 33;
+        Hash *= 0xc4ceb9fe1a85ec53ull;
+        Hash ^= Hash >> 33;
+        return Hash;
+    }
+
     std::vector<ShaderMacro> m_Macros;
-    std::set<std::string>    m_StringPool;
-    bool                     m_bIsFinalized = false;
+
+    // Arena that holds names and definitions
+    std::unique_ptr<ArenaAllocator> m_pArena;
+
+    // Sum of the hashes of all macros, which does not depend on the macro order
+    Uint64 m_Hash = 0;
+
+    bool m_bIsFinalized = false;
 };
 
 template <>
 inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, const Char* Definition)
 {
     Reopen();
-    const auto* PooledDefinition = m_StringPool.insert(Definition).first->c_str();
-    const auto* PooledName       = m_StringPool.insert(Name).first->c_str();
-    m_Macros.emplace_back(PooledName, PooledDefinition);
+    const auto* ArenaDefinition = CopyString(Definition);
+    const auto* ArenaName       = CopyString(Name);
+    m_Macros.emplace_back(ArenaName, ArenaDefinition);
+    m_Hash += ComputeMacroHash(Name, Definition);
 }
 
 template <>
@@ -180,25 +261,42 @@ inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, bool Definition)
 template <>
 inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, float Definition)
 {
-    std::ostringstream ss;
-
     // Make sure that when floating point represents integer, it is still
     // written as float: 1024.0, but not 1024. This is essnetial to
     // avoid type conversion issues in GLES.
-    if (Definition == static_cast<float>(static_cast<int>(Definition)))
-        ss << std::fixed << std::setprecision(1);
+    // The formats match the output of std::ostream with std::fixed/std::setprecision(1) and default settings.
+    const bool IsIntegral = Definition == static_cast<float>(static_cast<int>(Definition));
+
+    Char Buffer[64];
+    snprintf(Buffer, sizeof(Buffer), IsIntegral ? "%.1f" : "%g", static_cast<double>(Definition));
+    AddShaderMacro<const Char*>(Name, Buffer);
+}
+
+template <>
+inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, Int32 Definition)
+{
+    Char  Buffer[16];
+    Char* pEnd = Buffer + _countof(Buffer);
+    *(--pEnd)  = '\0';
+
+    // Negate in unsigned arithmetic to handle the minimum value
+    const auto Magnitude = Definition < 0 ? Uint64{0} - static_cast<Uint64>(static_cast<Int64>(Definition)) : static_cast<Uint64>(Definition);
 
-    ss << Definition;
-    AddShaderMacro<const Char*>(Name, ss.str().c_str());
+    auto* pStart = FormatDecimal(pEnd, Magnitude);
+    if (Definition < 0)
+        *(--pStart) = '-';
+    AddShaderMacro<const Char*>(Name, pStart);
 }
 
 template <>
 inline void ShaderMacroHelper::AddShaderMacro(const Char* Name, Uint32 Definition)
 {
     // Make sure that uint constants have the 'u' suffix to avoid problems in GLES.
-    std::ostringstream ss;
-    ss << Definition << 'u';
-    AddShaderMacro<const Char*>(Name, ss.str().c_str());
+    Char  Buffer[16];
+    Char* pEnd = Buffer + _countof(Buffer);
+    *(--pEnd)  = '\0';
+    *(--pEnd)  = 'u';
+    AddShaderMacro<const Char*>(Name, FormatDecimal(pEnd, Definition));
 }
 
 template <>
@@ -30,11 +30,13 @@
 #include <functional>
 #include <vector>
 #include <string>
+#include <atomic>
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
 #include "../../GraphicsEngine/interface/DeviceContext.h"
 #include "../../GraphicsEngine/interface/Buffer.h"
 #include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/Align.hpp"
 #include "MapHelper.hpp"
 
 namespace Diligent
@@ -80,9 +82,12 @@ public:
         for (const auto& mapInfo : m_MapInfo)
         {
             VERIFY(!mapInfo.m_MappedData, "Destroying streaming buffer that is still mapped");
+            VERIFY(mapInfo.m_ConcurrentEnd == 0, "Destroying streaming buffer with unfinished concurrent reservations");
         }
     }
 
+    static constexpr Uint32 InvalidOffset = ~Uint32{0};
+
     // Returns offset of the allocated region
     Uint32 Map(IDeviceContext* pCtx, IRenderDevice* pDevice, Uint32 Size, size_t CtxNum = 0)
     {
@@ -146,6 +151,70 @@ public:
         return Offset;
     }
 
+    /// Maps the buffer and opens a window of Size bytes in which worker threads may reserve ranges
+    /// with ReserveConcurrent(). Must be called by the thread that owns the context.
+
+    /// \return     Offset of the window in the buffer.
+    ///
+    /// \remarks    The mapped CPU address returned by GetMappedCPUAddress() stays valid until
+    ///             EndConcurrentReservations() is called. Worker threads must not call any other method.
+    Uint32 BeginConcurrentReservations(IDeviceContext* pCtx, IRenderDevice* pDevice, Uint32 Size, size_t CtxNum = 0)
+    {
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(MapInfo.m_ConcurrentEnd == 0, "Concurrent reservations have already been started for this context");
+
+        const auto WindowOffset = Map(pCtx, pDevice, Size, CtxNum);
+        MapInfo.m_ConcurrentOffset.store(WindowOffset);
+        MapInfo.m_ConcurrentEnd = WindowOffset + Size;
+        return WindowOffset;
+    }
+
+    /// Reserves Size bytes in the window opened by BeginConcurrentReservations().
+    /// This method is lock-free and may be called by any number of threads simultaneously.
+
+    /// \return     Offset of the reserved range in the buffer, or InvalidOffset if there is not
+    ///             enough space left in the window.
+    Uint32 ReserveConcurrent(Uint32 Size, Uint32 Alignment = 1, size_t CtxNum = 0)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(MapInfo.m_ConcurrentEnd != 0, "Concurrent reservations have not been started for this context");
+
+        auto CurrOffset = MapInfo.m_ConcurrentOffset.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto Offset = AlignUp(CurrOffset, Alignment);
+            if (Offset > MapInfo.m_ConcurrentEnd || Size > MapInfo.m_ConcurrentEnd - Offset)
+                return InvalidOffset;
+
+            // Compare-exchange rather than fetch-add: a failed reservation must not advance the offset
+            // past the window end, or it would have to be rolled back while other threads keep reserving.
+            if (MapInfo.m_ConcurrentOffset.compare_exchange_weak(CurrOffset, Offset + Size, std::memory_order_relaxed))
+                return Offset;
+        }
+    }
+
+    /// Closes the window opened by BeginConcurrentReservations() and unmaps the buffer.
+    /// Unused space at the end of the window is returned to the buffer.
+    /// Must be called by the thread that owns the context after all worker threads have finished writing.
+
+    /// \return     The offset of the end of the reserved data in the buffer.
+    Uint32 EndConcurrentReservations(size_t CtxNum = 0)
+    {
+        auto& MapInfo = m_MapInfo[CtxNum];
+        VERIFY(MapInfo.m_ConcurrentEnd != 0, "Concurrent reservations have not been started for this context");
+
+        const auto EndOffset = MapInfo.m_ConcurrentOffset.load();
+        VERIFY_EXPR(EndOffset <= MapInfo.m_ConcurrentEnd && MapInfo.m_CurrOffset == MapInfo.m_ConcurrentEnd);
+        MapInfo.m_CurrOffset    = EndOffset;
+        MapInfo.m_ConcurrentEnd = 0;
+        Unmap(CtxNum);
+
+        return EndOffset;
+    }
+
     void Unmap(size_t CtxNum = 0)
     {
         if (!m_UsePersistentMap)
@@ -186,6 +255,21 @@ private:
     {
         MapHelper<Uint8> m_MappedData;
         Uint32           m_CurrOffset = 0;
+
+        // Window opened by BeginConcurrentReservations()
+        std::atomic<Uint32> m_ConcurrentOffset{0};
+        Uint32              m_ConcurrentEnd = 0;
+
+        MapInfo() noexcept {}
+
+        // clang-format off
+        MapInfo(MapInfo&& rhs) noexcept :
+            m_MappedData      {std::move(rhs.m_MappedData)},
+            m_CurrOffset      {rhs.m_CurrOffset},
+            m_ConcurrentOffset{rhs.m_ConcurrentOffset.load()},
+            m_ConcurrentEnd   {rhs.m_ConcurrentEnd}
+        {}
+        // clang-format on
     };
     // We need to keep track of mapped data for every context
     std::vector<MapInfo> m_MapInfo;
@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// CPU block-compression encoder
+
+#include "../../GraphicsEngine/interface/GraphicsTypes.h"
+#include "../../../Primitives/interface/ThreadPool.h"
+#include "TextureUploader.hpp"
+
+namespace Diligent
+{
+
+/// Texture compression attributes, see Diligent::CompressTexture().
+struct TextureCompressionAttribs
+{
+    /// Texture width, in texels.
+    Uint32 Width = 0;
+
+    /// Texture height, in texels.
+    Uint32 Height = 0;
+
+    /// Source data format.
+
+    /// The format must have 8-bit UNORM components: R8, RG8, RGBA8, BGRA8 or BGRX8, including the sRGB variants.
+    /// Missing green and blue components are treated as 0, missing alpha is treated as 255.
+    TEXTURE_FORMAT SrcFormat = TEX_FORMAT_RGBA8_UNORM;
+
+    /// Pointer to the source data.
+    const void* pSrcData = nullptr;
+
+    /// Source data row stride, in bytes.
+    Uint64 SrcStride = 0;
+
+    /// Compressed format, see Diligent::IsTextureCompressionSupported().
+    TEXTURE_FORMAT DstFormat = TEX_FORMAT_UNKNOWN;
+
+    /// Pointer to the destination memory.
+    void* pDstData = nullptr;
+
+    /// The stride, in bytes, between rows of compressed blocks.
+    Uint64 DstStride = 0;
+
+    /// Optional thread pool used to compress rows of blocks in parallel.
+
+    /// The calling thread also compresses the data and returns as soon as all blocks are written.
+    /// It does not wait for the tasks that did not get any work, so the function may be called
+    /// from a worker thread of the same pool.
+    IThreadPool* pThreadPool = nullptr;
+};
+
+/// Returns true if Diligent::CompressTexture() can encode the given format.
+
+/// Supported formats are BC1, BC2, BC3 and BC7 (UNORM and UNORM_SRGB), BC4_UNORM and BC5_UNORM.
+/// sRGB formats are encoded the same way as the UNORM ones, i.e. the error is measured in sRGB space.
+bool IsTextureCompressionSupported(TEXTURE_FORMAT Format);
+
+/// Compresses the texture data on the CPU.
+
+/// The encoders fit the block endpoints along the principal axis of the block colors and refine them
+/// with least squares. BC7 blocks are encoded in mode 6 (single subset, RGBA endpoints with 4-bit indices).
+/// Partial blocks at the right and bottom edges are padded by replicating the edge texels.
+///
+/// \return     true if the data has been compressed, and false if the formats are not supported.
+bool CompressTexture(const TextureCompressionAttribs& Attribs);
+
+/// Compresses the texture data into the subresource of the upload buffer, see Diligent::ITextureUploader.
+
+/// \param [in] pUploadBuffer - Upload buffer whose format is one of the formats supported by CompressTexture().
+/// \param [in] Mip           - Mip level of the upload buffer to write to.
+/// \param [in] Slice         - Array slice of the upload buffer to write to.
+/// \param [in] SrcFormat     - Source data format, see Diligent::TextureCompressionAttribs::SrcFormat.
+/// \param [in] pSrcData      - Source data for the whole mip level.
+/// \param [in] SrcStride     - Source data row stride, in bytes.
+/// \param [in] pThreadPool   - Optional thread pool, see Diligent::TextureCompressionAttribs::pThreadPool.
+/// \return     true if the data has been compressed, and false otherwise.
+bool CompressTextureToUploadBuffer(IUploadBuffer* pUploadBuffer,
+                                   Uint32         Mip,
+                                   Uint32         Slice,
+                                   TEXTURE_FORMAT SrcFormat,
+                                   const void*    pSrcData,
+                                   Uint64         SrcStride,
+                                   IThreadPool*   pThreadPool = nullptr);
+
+} // namespace Diligent
@@ -47,10 +47,12 @@ struct UploadBufferDesc
 
     bool operator == (const UploadBufferDesc &rhs) const
     {
-        return Width  == rhs.Width  && 
-                Height == rhs.Height &&
-                Depth  == rhs.Depth  &&
-                Format == rhs.Format;
+        return Width     == rhs.Width     &&
+               Height    == rhs.Height    &&
+               Depth     == rhs.Depth     &&
+               MipLevels == rhs.MipLevels &&
+               ArraySize == rhs.ArraySize &&
+               Format    == rhs.Format;
     }
 };
 // clang-format on
@@ -66,6 +68,24 @@ public:
 /// Texture uploader description.
 struct TextureUploaderDesc
 {
+    /// Optional immediate context that the uploader uses to execute copy operations.
+
+    /// When not null, all copies are recorded into this context and submitted to its queue,
+    /// which is normally a transfer queue, so that streaming does not take graphics queue time.
+    /// The context passed to ITextureUploader::RenderThreadUpdate() is then made to wait for
+    /// the copies on the GPU using a fence.
+    ///
+    /// \remarks    The context must only be used by the thread that calls RenderThreadUpdate().
+    ///             Destination textures must include the copy context in their ImmediateContextMask.
+    ///             The member is only used in Direct3D12 and Vulkan backends and is ignored otherwise.
+    IDeviceContext* pCopyContext = nullptr;
+
+    /// Maximum total size, in bytes, of the idle upload buffers kept in the pool for reuse.
+
+    /// When recycling a buffer makes the pool exceed the budget, the uploader releases
+    /// idle buffers, starting from the largest bucket. Zero means no limit.
+    /// The member is only used in Direct3D12 and Vulkan backends.
+    Uint64 MaxPoolSize = 0;
 };
 
 
@@ -73,6 +93,12 @@ struct TextureUploaderDesc
 struct TextureUploaderStats
 {
     Uint32 NumPendingOperations = 0;
+
+    /// The number of idle upload buffers kept in the pool for reuse.
+    Uint32 NumPooledBuffers = 0;
+
+    /// The total size, in bytes, of idle upload buffers kept in the pool.
+    Uint64 PooledBuffersSize = 0;
 };
 
 /// Asynchronous texture uploader
@@ -42,7 +42,7 @@ struct hash<Diligent::UploadBufferDesc>
 {
     size_t operator()(const Diligent::UploadBufferDesc& Desc) const
     {
-        return Diligent::ComputeHash(Desc.Width, Desc.Height, Desc.Depth, static_cast<Diligent::Int32>(Desc.Format));
+        return Diligent::ComputeHash(Desc.Width, Desc.Height, Desc.Depth, Desc.MipLevels, Desc.ArraySize, static_cast<Diligent::Int32>(Desc.Format));
     }
 };
 
@@ -88,7 +88,7 @@ public:
     }
 
 protected:
-    const UploadBufferDesc                m_Desc;
+    UploadBufferDesc                      m_Desc;
     std::vector<MappedTextureSubresource> m_MappedData;
 };
 
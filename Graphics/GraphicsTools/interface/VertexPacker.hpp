@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of a VertexPacker class
+
+#include <vector>
+
+#include "../../GraphicsEngine/interface/InputLayout.h"
+#include "../../../Primitives/interface/ThreadPool.h"
+#include "../../../Common/interface/BasicMath.hpp"
+
+namespace Diligent
+{
+
+/// Vertex attribute packing, see Diligent::VertexAttributePackInfo.
+
+/// 16-bit formats are padded to an even number of components so that every attribute is 4-byte aligned.
+/// The padding components are filled with the defaults of the vertex fetch, i.e. (0, 0, 0, 1).
+enum VERTEX_PACKING : Uint8
+{
+    /// 32-bit floats, VT_FLOAT32. The data is copied as is.
+    VERTEX_PACKING_FLOAT32 = 0,
+
+    /// 16-bit floats, VT_FLOAT16. The values are rounded to the nearest representable value,
+    /// the values that are too large become infinities.
+    VERTEX_PACKING_FLOAT16,
+
+    /// Normalized signed 16-bit integers, VT_INT16. The values are clamped to [-1, 1].
+    VERTEX_PACKING_SNORM16,
+
+    /// Normalized unsigned 16-bit integers, VT_UINT16. The values are clamped to [0, 1].
+    VERTEX_PACKING_UNORM16,
+
+    /// Unit vector encoded with the octahedral mapping into two normalized signed 16-bit integers, VT_INT16 x 2.
+    /// The attribute must have three components. The vector does not need to be normalized.
+    /// The shader decodes the vector as follows:
+    ///
+    ///     float3 DecodeOctahedral(float2 e)
+    ///     {
+    ///         float3 n = float3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    ///         float  t = saturate(-n.z);
+    ///         n.xy += float2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    ///         return normalize(n);
+    ///     }
+    VERTEX_PACKING_OCT_SNORM16,
+
+    /// Three 10-bit and one 2-bit normalized unsigned integers, packed into a single VT_UINT32 as
+    /// x | (y << 10) | (z << 20) | (w << 30). The values are clamped to [0, 1]; a missing fourth component is 1.
+    /// The input layout has no packed formats, so the shader reads the attribute as uint and decodes it as follows:
+    ///
+    ///     float4 DecodeUnorm10_10_10_2(uint p)
+    ///     {
+    ///         return float4(uint4(p, p >> 10u, p >> 20u, p >> 30u) & uint4(1023u, 1023u, 1023u, 3u)) / float4(1023.0, 1023.0, 1023.0, 3.0);
+    ///     }
+    ///
+    /// Use Scale = 0.5 and Bias = 0.5 to pack normals and tangents.
+    VERTEX_PACKING_UNORM10_10_10_2,
+
+    /// Helper value that stores the total number of packings in the enumeration.
+    VERTEX_PACKING_COUNT
+};
+
+/// Vertex attribute packing information.
+struct VertexAttributePackInfo
+{
+    /// Input index of the attribute in the input layout.
+    Uint32 InputIndex = 0;
+
+    /// The number of float components of the source attribute, from 1 to 4.
+    Uint32 NumComponents = 3;
+
+    /// Attribute packing.
+    VERTEX_PACKING Packing = VERTEX_PACKING_FLOAT32;
+
+    /// Every component is transformed as Value * Scale + Bias before it is packed,
+    /// for example to map the positions of a mesh to the [-1, 1] range of SNORM16.
+    /// The inverse transform is typically folded into the world matrix.
+    float4 Scale = float4{1, 1, 1, 1};
+
+    /// See Scale.
+    float4 Bias = float4{0, 0, 0, 0};
+};
+
+/// Source data of a vertex attribute, see Diligent::VertexPacker::Pack().
+struct VertexAttributeSource
+{
+    /// Pointer to the first float component of the attribute of the first vertex.
+    const void* pData = nullptr;
+
+    /// The stride, in bytes, between the attributes of two vertices.
+    /// 0 means the attributes are tightly packed.
+    Uint32 Stride = 0;
+};
+
+/// Packs float vertex attributes into a single interleaved vertex buffer using compact formats.
+
+/// The packer computes the offsets of the packed attributes and the vertex stride, and
+/// provides the input layout that matches the packed data. Conversions are vectorized with
+/// SSE2/NEON when available. Typical savings are 2x for positions (SNORM16 with a bounding box
+/// scale and bias), 3x for normals (octahedral SNORM16) and 2x for texture coordinates (FLOAT16 or UNORM16).
+class VertexPacker
+{
+public:
+    /// Creates the packer for the given attributes.
+
+    /// \param [in] pAttribs   - Attribute packing information.
+    /// \param [in] NumAttribs - The number of attributes, up to MAX_LAYOUT_ELEMENTS.
+    /// \param [in] BufferSlot - Buffer slot of all layout elements.
+    VertexPacker(const VertexAttributePackInfo* pAttribs, Uint32 NumAttribs, Uint32 BufferSlot = 0);
+
+    /// Returns the size, in bytes, of a packed vertex.
+    Uint32 GetStride() const
+    {
+        return m_Stride;
+    }
+
+    /// Returns the input layout of the packed vertices. The layout references
+    /// the elements stored in the packer and is valid during its lifetime.
+    InputLayoutDesc GetInputLayout() const
+    {
+        return InputLayoutDesc{m_Elements.data(), static_cast<Uint32>(m_Elements.size())};
+    }
+
+    /// Packs the vertices.
+
+    /// \param [in]  pSources    - Source data of every attribute, in the order the attributes were given to the constructor.
+    /// \param [in]  NumVertices - The number of vertices to pack.
+    /// \param [out] pDstData    - Pointer to the destination memory, which must have room for NumVertices * GetStride() bytes.
+    /// \param [in]  pThreadPool - Optional thread pool used to pack ranges of vertices in parallel. The calling thread
+    ///                            also packs the vertices and does not wait for the tasks that did not get any work.
+    void Pack(const VertexAttributeSource* pSources, Uint32 NumVertices, void* pDstData, IThreadPool* pThreadPool = nullptr) const;
+
+private:
+    void PackRange(const VertexAttributeSource* pSources, Uint32 FirstVertex, Uint32 NumVertices, void* pDstData) const;
+
+    std::vector<VertexAttributePackInfo> m_Attribs;
+    std::vector<LayoutElement>           m_Elements;
+    Uint32                               m_Stride = 0;
+};
+
+} // namespace Diligent
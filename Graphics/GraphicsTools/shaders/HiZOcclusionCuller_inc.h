@@ -0,0 +1,249 @@
+"// Hi-Z occlusion culling compute kernels.\n"
+"// The kernel is enabled by one of the following macros and uses its own entry point:\n"
+"//   HIZ_COPY        (CopyDepthCS)     - copies the depth buffer to the most detailed level of the Hi-Z pyramid\n"
+"//   HIZ_DOWNSAMPLE  (DownsampleCS)    - reduces the texels of the previous pyramid level to the farthest depth\n"
+"//   CULL_OBJECTS    (CullObjectsCS)   - tests object bounding boxes against the view frustum and the Hi-Z pyramid\n"
+"//   WRITE_DRAW_ARGS (WriteDrawArgsCS) - writes indexed indirect draw arguments of the visible objects\n"
+"\n"
+"#ifndef THREAD_GROUP_SIZE\n"
+"#   define THREAD_GROUP_SIZE 64\n"
+"#endif\n"
+"\n"
+"#ifndef HIZ_GROUP_SIZE\n"
+"#   define HIZ_GROUP_SIZE 8\n"
+"#endif\n"
+"\n"
+"// When reverse depth is used, the near plane is at depth 1 and the far plane is at depth 0\n"
+"#ifndef REVERSE_DEPTH\n"
+"#   define REVERSE_DEPTH 0\n"
+"#endif\n"
+"\n"
+"#if REVERSE_DEPTH\n"
+"#   define FARTHEST_DEPTH(d0, d1) min(d0, d1)\n"
+"#   define NEAREST_DEPTH(d0, d1)  max(d0, d1)\n"
+"#   define FAR_PLANE_DEPTH 0.0\n"
+"#else\n"
+"#   define FARTHEST_DEPTH(d0, d1) max(d0, d1)\n"
+"#   define NEAREST_DEPTH(d0, d1)  min(d0, d1)\n"
+"#   define FAR_PLANE_DEPTH 1.0\n"
+"#endif\n"
+"\n"
+"cbuffer cbConstants\n"
+"{\n"
+"    // View-projection matrix of the camera the Hi-Z pyramid was built for\n"
+"    float4x4 g_HiZViewProj;\n"
+"    // Frustum planes of the current camera, see ExtractViewFrustumPlanesFromMatrix()\n"
+"    float4   g_FrustumPlanes[6];\n"
+"\n"
+"    uint g_NumObjects;\n"
+"    uint g_HiZMipLevels;\n"
+"    uint g_HiZWidth;\n"
+"    uint g_HiZHeight;\n"
+"\n"
+"    uint g_SrcMipWidth;\n"
+"    uint g_SrcMipHeight;\n"
+"    uint g_DstMipWidth;\n"
+"    uint g_DstMipHeight;\n"
+"\n"
+"    // NDC to texture coordinates and depth transform, see RenderDeviceInfo::GetNDCAttribs()\n"
+"    float g_YtoVScale;\n"
+"    float g_ZtoDepthScale;\n"
+"    float g_ZtoDepthBias;\n"
+"    uint  g_TestOcclusion;\n"
+"}\n"
+"\n"
+"// Must match HiZCullObject structure in HiZOcclusionCuller.hpp\n"
+"struct ObjectData\n"
+"{\n"
+"    float3 BoundsMin;\n"
+"    uint   IndexCount;\n"
+"    float3 BoundsMax;\n"
+"    uint   FirstIndexLocation;\n"
+"    int    BaseVertex;\n"
+"    uint   NumInstances;\n"
+"    uint   FirstInstanceLocation;\n"
+"    uint   Padding;\n"
+"};\n"
+"\n"
+"\n"
+"#ifdef HIZ_COPY\n"
+"\n"
+"Texture2D<float>                       g_Depth;\n"
+"RWTexture2D</* format = r32f */ float> g_DstMip;\n"
+"\n"
+"[numthreads(HIZ_GROUP_SIZE, HIZ_GROUP_SIZE, 1)]\n"
+"void CopyDepthCS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    if (DTid.x < g_DstMipWidth && DTid.y < g_DstMipHeight)\n"
+"        g_DstMip[DTid.xy] = g_Depth.Load(int3(int2(DTid.xy), 0));\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#ifdef HIZ_DOWNSAMPLE\n"
+"\n"
+"RWTexture2D</* format = r32f */ float> g_SrcMip;\n"
+"RWTexture2D</* format = r32f */ float> g_DstMip;\n"
+"\n"
+"[numthreads(HIZ_GROUP_SIZE, HIZ_GROUP_SIZE, 1)]\n"
+"void DownsampleCS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    if (DTid.x >= g_DstMipWidth || DTid.y >= g_DstMipHeight)\n"
+"        return;\n"
+"\n"
+"    uint2 Src0 = DTid.xy * 2u;\n"
+"    uint2 Src1 = min(Src0 + uint2(1u, 1u), uint2(g_SrcMipWidth, g_SrcMipHeight) - uint2(1u, 1u));\n"
+"\n"
+"    float Depth = FARTHEST_DEPTH(FARTHEST_DEPTH(g_SrcMip[Src0], g_SrcMip[uint2(Src1.x, Src0.y)]),\n"
+"                                 FARTHEST_DEPTH(g_SrcMip[uint2(Src0.x, Src1.y)], g_SrcMip[Src1]));\n"
+"\n"
+"    // When the source dimension is odd, the last texel of the destination level also covers\n"
+"    // the extra column (row) of the source level, so that the pyramid remains conservative.\n"
+"    bool ExtraColumn = g_SrcMipWidth > 1u && (g_SrcMipWidth & 1u) != 0u && DTid.x == g_DstMipWidth - 1u;\n"
+"    bool ExtraRow    = g_SrcMipHeight > 1u && (g_SrcMipHeight & 1u) != 0u && DTid.y == g_DstMipHeight - 1u;\n"
+"    if (ExtraColumn)\n"
+"    {\n"
+"        uint x = Src0.x + 2u;\n"
+"        Depth  = FARTHEST_DEPTH(Depth, FARTHEST_DEPTH(g_SrcMip[uint2(x, Src0.y)], g_SrcMip[uint2(x, Src1.y)]));\n"
+"    }\n"
+"    if (ExtraRow)\n"
+"    {\n"
+"        uint y = Src0.y + 2u;\n"
+"        Depth  = FARTHEST_DEPTH(Depth, FARTHEST_DEPTH(g_SrcMip[uint2(Src0.x, y)], g_SrcMip[uint2(Src1.x, y)]));\n"
+"    }\n"
+"    if (ExtraColumn && ExtraRow)\n"
+"    {\n"
+"        Depth = FARTHEST_DEPTH(Depth, g_SrcMip[Src0 + uint2(2u, 2u)]);\n"
+"    }\n"
+"\n"
+"    g_DstMip[DTid.xy] = Depth;\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#ifdef CULL_OBJECTS\n"
+"\n"
+"StructuredBuffer<ObjectData>        g_Objects;\n"
+"Texture2D<float>                    g_HiZ;\n"
+"RWBuffer</* format = r32ui */ uint> g_Flags;\n"
+"RWBuffer</* format = r32ui */ uint> g_Indices;\n"
+"\n"
+"// Same test as GetBoxVisibility() in AdvancedMath.hpp: the box is invisible if\n"
+"// the corner that is farthest along the normal is behind any of the planes.\n"
+"bool IsInsideFrustum(float3 BoxMin, float3 BoxMax)\n"
+"{\n"
+"    for (int i = 0; i < 6; ++i)\n"
+"    {\n"
+"        float4 Plane = g_FrustumPlanes[i];\n"
+"        float3 MaxPoint;\n"
+"        MaxPoint.x = Plane.x > 0.0 ? BoxMax.x : BoxMin.x;\n"
+"        MaxPoint.y = Plane.y > 0.0 ? BoxMax.y : BoxMin.y;\n"
+"        MaxPoint.z = Plane.z > 0.0 ? BoxMax.z : BoxMin.z;\n"
+"        if (dot(MaxPoint, Plane.xyz) + Plane.w < 0.0)\n"
+"            return false;\n"
+"    }\n"
+"    return true;\n"
+"}\n"
+"\n"
+"bool IsOccluded(float3 BoxMin, float3 BoxMax)\n"
+"{\n"
+"    float2 MinUV        = float2(+1e+10, +1e+10);\n"
+"    float2 MaxUV        = float2(-1e+10, -1e+10);\n"
+"    float  NearestDepth = FAR_PLANE_DEPTH;\n"
+"    for (uint i = 0u; i < 8u; ++i)\n"
+"    {\n"
+"        float3 Corner;\n"
+"        Corner.x = (i & 1u) != 0u ? BoxMax.x : BoxMin.x;\n"
+"        Corner.y = (i & 2u) != 0u ? BoxMax.y : BoxMin.y;\n"
+"        Corner.z = (i & 4u) != 0u ? BoxMax.z : BoxMin.z;\n"
+"\n"
+"        float4 ClipPos = mul(float4(Corner, 1.0), g_HiZViewProj);\n"
+"        // The box crosses the camera plane, so its projection is unbounded\n"
+"        if (ClipPos.w <= 0.0)\n"
+"            return false;\n"
+"\n"
+"        float3 NDC = ClipPos.xyz / ClipPos.w;\n"
+"        float2 UV  = float2(NDC.x * 0.5 + 0.5, NDC.y * g_YtoVScale + 0.5);\n"
+"        MinUV      = min(MinUV, UV);\n"
+"        MaxUV      = max(MaxUV, UV);\n"
+"\n"
+"        NearestDepth = NEAREST_DEPTH(NearestDepth, NDC.z * g_ZtoDepthScale + g_ZtoDepthBias);\n"
+"    }\n"
+"\n"
+"    float2 HiZSize  = float2(float(g_HiZWidth), float(g_HiZHeight));\n"
+"    float2 MinTexel = saturate(MinUV) * HiZSize;\n"
+"    float2 MaxTexel = saturate(MaxUV) * HiZSize;\n"
+"\n"
+"    // Select the level where the screen-space rectangle of the box covers at most 2x2 texels\n"
+"    float2 Extent   = MaxTexel - MinTexel;\n"
+"    uint   MipLevel = uint(ceil(log2(max(max(Extent.x, Extent.y), 1.0))));\n"
+"    MipLevel        = min(MipLevel, g_HiZMipLevels - 1u);\n"
+"\n"
+"    uint2 MipSize = max(uint2(g_HiZWidth, g_HiZHeight) >> MipLevel, uint2(1u, 1u));\n"
+"    int2  Coord0  = int2(min(uint2(MinTexel) >> MipLevel, MipSize - uint2(1u, 1u)));\n"
+"    int2  Coord1  = int2(min(uint2(MaxTexel) >> MipLevel, MipSize - uint2(1u, 1u)));\n"
+"    int   Lod     = int(MipLevel);\n"
+"\n"
+"    float HiZDepth = FARTHEST_DEPTH(FARTHEST_DEPTH(g_HiZ.Load(int3(Coord0.x, Coord0.y, Lod)),\n"
+"                                                   g_HiZ.Load(int3(Coord1.x, Coord0.y, Lod))),\n"
+"                                    FARTHEST_DEPTH(g_HiZ.Load(int3(Coord0.x, Coord1.y, Lod)),\n"
+"                                                   g_HiZ.Load(int3(Coord1.x, Coord1.y, Lod))));\n"
+"\n"
+"    // The box is occluded if its nearest point is behind the farthest occluder in the rectangle\n"
+"#if REVERSE_DEPTH\n"
+"    return NearestDepth < HiZDepth;\n"
+"#else\n"
+"    return NearestDepth > HiZDepth;\n"
+"#endif\n"
+"}\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void CullObjectsCS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    uint Idx = DTid.x;\n"
+"    if (Idx >= g_NumObjects)\n"
+"        return;\n"
+"\n"
+"    ObjectData Obj = g_Objects[Idx];\n"
+"\n"
+"    bool Visible = Obj.IndexCount > 0u && Obj.NumInstances > 0u && IsInsideFrustum(Obj.BoundsMin, Obj.BoundsMax);\n"
+"    if (Visible && g_TestOcclusion != 0u)\n"
+"        Visible = !IsOccluded(Obj.BoundsMin, Obj.BoundsMax);\n"
+"\n"
+"    g_Flags[Idx]   = Visible ? 1u : 0u;\n"
+"    g_Indices[Idx] = Idx;\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#ifdef WRITE_DRAW_ARGS\n"
+"\n"
+"StructuredBuffer<ObjectData>        g_Objects;\n"
+"Buffer<uint>                        g_VisibleIndices;\n"
+"RWBuffer</* format = r32ui */ uint> g_VisibleCount;\n"
+"RWBuffer</* format = r32ui */ uint> g_DrawArgs;\n"
+"\n"
+"// The number of visible objects is only known on the GPU, so the kernel is dispatched\n"
+"// for all objects and the threads past the count exit immediately.\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void WriteDrawArgsCS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    uint Idx = DTid.x;\n"
+"    if (Idx >= g_NumObjects || Idx >= g_VisibleCount[0])\n"
+"        return;\n"
+"\n"
+"    ObjectData Obj = g_Objects[g_VisibleIndices[Idx]];\n"
+"\n"
+"    // Arguments are laid out as expected by DrawIndexedIndirect()\n"
+"    uint Offset = Idx * 5u;\n"
+"    g_DrawArgs[Offset + 0u] = Obj.IndexCount;\n"
+"    g_DrawArgs[Offset + 1u] = Obj.NumInstances;\n"
+"    g_DrawArgs[Offset + 2u] = Obj.FirstIndexLocation;\n"
+"    g_DrawArgs[Offset + 3u] = asuint(Obj.BaseVertex);\n"
+"    g_DrawArgs[Offset + 4u] = Obj.FirstInstanceLocation;\n"
+"}\n"
+"\n"
+"#endif\n"
@@ -0,0 +1,76 @@
+"// Reference meshlet culling amplification shader.\n"
+"// Every thread tests one meshlet against the view frustum and the camera position,\n"
+"// and the group launches one mesh shader thread group for every visible meshlet.\n"
+"\n"
+"#ifndef AS_GROUP_SIZE\n"
+"#   define AS_GROUP_SIZE 32\n"
+"#endif\n"
+"\n"
+"// Must match MeshletCullingConstants structure in MeshletBuilder.hpp\n"
+"cbuffer cbMeshletCulling\n"
+"{\n"
+"    // Normalized frustum planes in the mesh space\n"
+"    float4 g_FrustumPlanes[6];\n"
+"    // Camera position in the mesh space\n"
+"    float3 g_CameraPos;\n"
+"    uint   g_NumMeshlets;\n"
+"}\n"
+"\n"
+"// Must match MeshletBounds structure in MeshletBuilder.hpp\n"
+"struct MeshletBounds\n"
+"{\n"
+"    float3 Center;\n"
+"    float  Radius;\n"
+"    float3 ConeApex;\n"
+"    float  ConeCutoff;\n"
+"    float3 ConeAxis;\n"
+"    float  Padding;\n"
+"};\n"
+"\n"
+"StructuredBuffer<MeshletBounds> g_MeshletBounds;\n"
+"\n"
+"// The mesh shader must declare the same structure\n"
+"struct MeshletPayload\n"
+"{\n"
+"    uint MeshletIndices[AS_GROUP_SIZE];\n"
+"};\n"
+"\n"
+"groupshared MeshletPayload s_Payload;\n"
+"groupshared uint           s_NumVisible;\n"
+"\n"
+"bool IsMeshletVisible(MeshletBounds Bounds)\n"
+"{\n"
+"    for (int i = 0; i < 6; ++i)\n"
+"    {\n"
+"        float4 Plane = g_FrustumPlanes[i];\n"
+"        if (dot(Bounds.Center, Plane.xyz) + Plane.w < -Bounds.Radius)\n"
+"            return false;\n"
+"    }\n"
+"\n"
+"    // All triangles are back-facing if the camera is inside the negative cone\n"
+"    // whose apex is behind the planes of all triangles\n"
+"    if (dot(normalize(Bounds.ConeApex - g_CameraPos), Bounds.ConeAxis) >= Bounds.ConeCutoff)\n"
+"        return false;\n"
+"\n"
+"    return true;\n"
+"}\n"
+"\n"
+"[numthreads(AS_GROUP_SIZE, 1, 1)]\n"
+"void main(uint GroupThreadId : SV_GroupIndex,\n"
+"          uint MeshletIndex  : SV_DispatchThreadID)\n"
+"{\n"
+"    if (GroupThreadId == 0u)\n"
+"        s_NumVisible = 0u;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    // Group shared atomics do not depend on the wave size, unlike wave intrinsics\n"
+"    if (MeshletIndex < g_NumMeshlets && IsMeshletVisible(g_MeshletBounds[MeshletIndex]))\n"
+"    {\n"
+"        uint Slot;\n"
+"        InterlockedAdd(s_NumVisible, 1u, Slot);\n"
+"        s_Payload.MeshletIndices[Slot] = MeshletIndex;\n"
+"    }\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    DispatchMesh(s_NumVisible, 1, 1, s_Payload);\n"
+"}\n"
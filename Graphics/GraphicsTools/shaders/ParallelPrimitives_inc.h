@@ -0,0 +1,385 @@
+"// Parallel primitives compute kernels.\n"
+"// The kernel is enabled by one of the following macros and uses its own entry point:\n"
+"//   REDUCE            (ReduceCS)          - reduces a block of elements to a single value\n"
+"//   SCAN_BLOCKS       (ScanBlocksCS)      - computes exclusive prefix sums of the elements in each block and the block sums\n"
+"//   ADD_BLOCK_OFFSETS (AddBlockOffsetsCS) - adds scanned block sums to the elements of each block\n"
+"//   COMPACT           (CompactCS)         - writes the elements whose flags are non-zero to consecutive locations\n"
+"//   RADIX_HISTOGRAM   (RadixHistogramCS)  - counts radix digits in each block\n"
+"//   RADIX_SCATTER     (RadixScatterCS)    - writes keys (and values) to their sorted locations for the current digit\n"
+"\n"
+"#ifndef THREAD_GROUP_SIZE\n"
+"#   define THREAD_GROUP_SIZE 256\n"
+"#endif\n"
+"\n"
+"// The number of elements processed by each thread in REDUCE, SCAN_BLOCKS, ADD_BLOCK_OFFSETS and COMPACT kernels\n"
+"#ifndef ITEMS_PER_THREAD\n"
+"#   define ITEMS_PER_THREAD 4\n"
+"#endif\n"
+"\n"
+"#ifndef USE_WAVE_OPS\n"
+"#   define USE_WAVE_OPS 0\n"
+"#endif\n"
+"\n"
+"// Minimal wave size. The maximum number of waves in a group (THREAD_GROUP_SIZE / MIN_WAVE_SIZE)\n"
+"// must not exceed the wave size, so that the per-wave results can be processed by a single wave.\n"
+"#ifndef MIN_WAVE_SIZE\n"
+"#   define MIN_WAVE_SIZE 16\n"
+"#endif\n"
+"\n"
+"#define REDUCE_OP_SUM 0\n"
+"#define REDUCE_OP_MIN 1\n"
+"#define REDUCE_OP_MAX 2\n"
+"\n"
+"#ifndef REDUCE_OP\n"
+"#   define REDUCE_OP REDUCE_OP_SUM\n"
+"#endif\n"
+"\n"
+"#define RADIX_BITS  4\n"
+"#define RADIX_SIZE  16\n"
+"#define RADIX_MASK  15\n"
+"\n"
+"#define BLOCK_SIZE (THREAD_GROUP_SIZE * ITEMS_PER_THREAD)\n"
+"\n"
+"cbuffer cbConstants\n"
+"{\n"
+"    uint g_NumElements;\n"
+"    // The number of thread groups in X dimension. Large dispatches are split into\n"
+"    // two dimensions, and the flat group index is computed from the group id.\n"
+"    uint g_NumGroupsX;\n"
+"    // The bit shift of the current radix digit\n"
+"    uint g_RadixShift;\n"
+"    // The number of blocks in the radix sort pass\n"
+"    uint g_NumBlocks;\n"
+"}\n"
+"\n"
+"uint GetGroupIndex(uint3 Gid)\n"
+"{\n"
+"    return Gid.x + Gid.y * g_NumGroupsX;\n"
+"}\n"
+"\n"
+"\n"
+"#if USE_WAVE_OPS\n"
+"#   define MAX_WAVES (THREAD_GROUP_SIZE / MIN_WAVE_SIZE)\n"
+"// Per-wave partial results followed by the group total\n"
+"groupshared uint g_WaveData[MAX_WAVES + 1];\n"
+"#else\n"
+"groupshared uint g_SharedData[THREAD_GROUP_SIZE];\n"
+"#endif\n"
+"\n"
+"// Computes exclusive prefix sum of Value across the thread group.\n"
+"// Must be called by all threads in the group.\n"
+"uint GroupExclusiveScan(uint Value, uint GI, out uint Total)\n"
+"{\n"
+"#if USE_WAVE_OPS\n"
+"    uint LaneCount  = WaveGetLaneCount();\n"
+"    uint WaveIdx    = GI / LaneCount;\n"
+"    uint NumWaves   = (THREAD_GROUP_SIZE + LaneCount - 1u) / LaneCount;\n"
+"    uint WavePrefix = WavePrefixSum(Value);\n"
+"    if (WaveGetLaneIndex() == LaneCount - 1u)\n"
+"        g_WaveData[WaveIdx] = WavePrefix + Value;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    if (WaveIdx == 0u)\n"
+"    {\n"
+"        // The number of waves never exceeds the wave size\n"
+"        uint WaveSum    = GI < NumWaves ? g_WaveData[GI] : 0u;\n"
+"        uint WaveOffset = WavePrefixSum(WaveSum);\n"
+"        if (GI < NumWaves)\n"
+"            g_WaveData[GI] = WaveOffset;\n"
+"        if (GI == NumWaves - 1u)\n"
+"            g_WaveData[MAX_WAVES] = WaveOffset + WaveSum;\n"
+"    }\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    uint Prefix = g_WaveData[WaveIdx] + WavePrefix;\n"
+"    Total       = g_WaveData[MAX_WAVES];\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    return Prefix;\n"
+"#else\n"
+"    g_SharedData[GI] = Value;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    for (uint Offset = 1u; Offset < uint(THREAD_GROUP_SIZE); Offset *= 2u)\n"
+"    {\n"
+"        uint Addend = GI >= Offset ? g_SharedData[GI - Offset] : 0u;\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"        g_SharedData[GI] += Addend;\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"    }\n"
+"    uint Inclusive = g_SharedData[GI];\n"
+"    Total          = g_SharedData[THREAD_GROUP_SIZE - 1];\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    return Inclusive - Value;\n"
+"#endif\n"
+"}\n"
+"\n"
+"\n"
+"#ifdef REDUCE\n"
+"\n"
+"#if REDUCE_OP == REDUCE_OP_MIN\n"
+"#   define REDUCE_IDENTITY     0xFFFFFFFFu\n"
+"#   define REDUCE_COMBINE(A,B) min(A, B)\n"
+"#   define WAVE_REDUCE(X)      WaveActiveMin(X)\n"
+"#elif REDUCE_OP == REDUCE_OP_MAX\n"
+"#   define REDUCE_IDENTITY     0u\n"
+"#   define REDUCE_COMBINE(A,B) max(A, B)\n"
+"#   define WAVE_REDUCE(X)      WaveActiveMax(X)\n"
+"#else\n"
+"#   define REDUCE_IDENTITY     0u\n"
+"#   define REDUCE_COMBINE(A,B) ((A) + (B))\n"
+"#   define WAVE_REDUCE(X)      WaveActiveSum(X)\n"
+"#endif\n"
+"\n"
+"Buffer<uint>                        g_Input;\n"
+"RWBuffer</* format = r32ui */ uint> g_Output;\n"
+"\n"
+"uint GroupReduce(uint Value, uint GI)\n"
+"{\n"
+"#if USE_WAVE_OPS\n"
+"    uint LaneCount = WaveGetLaneCount();\n"
+"    uint NumWaves  = (THREAD_GROUP_SIZE + LaneCount - 1u) / LaneCount;\n"
+"    uint WaveValue = WAVE_REDUCE(Value);\n"
+"    if (WaveGetLaneIndex() == 0u)\n"
+"        g_WaveData[GI / LaneCount] = WaveValue;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    if (GI == 0u)\n"
+"    {\n"
+"        uint Result = g_WaveData[0];\n"
+"        for (uint i = 1u; i < NumWaves; ++i)\n"
+"            Result = REDUCE_COMBINE(Result, g_WaveData[i]);\n"
+"        g_WaveData[MAX_WAVES] = Result;\n"
+"    }\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    return g_WaveData[MAX_WAVES];\n"
+"#else\n"
+"    g_SharedData[GI] = Value;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"    for (uint Stride = uint(THREAD_GROUP_SIZE) / 2u; Stride > 0u; Stride /= 2u)\n"
+"    {\n"
+"        if (GI < Stride)\n"
+"            g_SharedData[GI] = REDUCE_COMBINE(g_SharedData[GI], g_SharedData[GI + Stride]);\n"
+"        GroupMemoryBarrierWithGroupSync();\n"
+"    }\n"
+"    return g_SharedData[0];\n"
+"#endif\n"
+"}\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void ReduceCS(uint3 Gid : SV_GroupID,\n"
+"              uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    // Extra groups of a two-dimensional dispatch have no elements to process\n"
+"    if (GroupIdx * uint(BLOCK_SIZE) >= g_NumElements)\n"
+"        return;\n"
+"    uint Value    = REDUCE_IDENTITY;\n"
+"    // Consecutive threads read consecutive elements\n"
+"    for (uint i = 0u; i < uint(ITEMS_PER_THREAD); ++i)\n"
+"    {\n"
+"        uint Idx = GroupIdx * uint(BLOCK_SIZE) + i * uint(THREAD_GROUP_SIZE) + GI;\n"
+"        if (Idx < g_NumElements)\n"
+"            Value = REDUCE_COMBINE(Value, g_Input.Load(int(Idx)));\n"
+"    }\n"
+"\n"
+"    Value = GroupReduce(Value, GI);\n"
+"    if (GI == 0u)\n"
+"        g_Output[GroupIdx] = Value;\n"
+"}\n"
+"\n"
+"#endif // REDUCE\n"
+"\n"
+"\n"
+"#ifdef SCAN_BLOCKS\n"
+"\n"
+"Buffer<uint>                        g_Input;\n"
+"RWBuffer</* format = r32ui */ uint> g_Output;\n"
+"RWBuffer</* format = r32ui */ uint> g_BlockSums;\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void ScanBlocksCS(uint3 Gid : SV_GroupID,\n"
+"                  uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    // Extra groups of a two-dimensional dispatch have no elements to process\n"
+"    if (GroupIdx * uint(BLOCK_SIZE) >= g_NumElements)\n"
+"        return;\n"
+"    // Every thread scans ITEMS_PER_THREAD consecutive elements\n"
+"    uint FirstIdx = GroupIdx * uint(BLOCK_SIZE) + GI * uint(ITEMS_PER_THREAD);\n"
+"\n"
+"    uint Items[ITEMS_PER_THREAD];\n"
+"    uint ThreadSum = 0u;\n"
+"    for (uint i = 0u; i < uint(ITEMS_PER_THREAD); ++i)\n"
+"    {\n"
+"        uint Idx = FirstIdx + i;\n"
+"        Items[i] = Idx < g_NumElements ? g_Input.Load(int(Idx)) : 0u;\n"
+"        ThreadSum += Items[i];\n"
+"    }\n"
+"\n"
+"    uint BlockSum     = 0u;\n"
+"    uint ThreadOffset = GroupExclusiveScan(ThreadSum, GI, BlockSum);\n"
+"\n"
+"    for (uint j = 0u; j < uint(ITEMS_PER_THREAD); ++j)\n"
+"    {\n"
+"        uint Idx = FirstIdx + j;\n"
+"        if (Idx < g_NumElements)\n"
+"            g_Output[Idx] = ThreadOffset;\n"
+"        ThreadOffset += Items[j];\n"
+"    }\n"
+"\n"
+"    if (GI == 0u)\n"
+"        g_BlockSums[GroupIdx] = BlockSum;\n"
+"}\n"
+"\n"
+"#endif // SCAN_BLOCKS\n"
+"\n"
+"\n"
+"#ifdef ADD_BLOCK_OFFSETS\n"
+"\n"
+"Buffer<uint>                        g_BlockOffsets;\n"
+"RWBuffer</* format = r32ui */ uint> g_Output;\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void AddBlockOffsetsCS(uint3 Gid : SV_GroupID,\n"
+"                       uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    // Extra groups of a two-dimensional dispatch have no elements to process\n"
+"    if (GroupIdx * uint(BLOCK_SIZE) >= g_NumElements)\n"
+"        return;\n"
+"    uint Offset   = g_BlockOffsets.Load(int(GroupIdx));\n"
+"    for (uint i = 0u; i < uint(ITEMS_PER_THREAD); ++i)\n"
+"    {\n"
+"        uint Idx = GroupIdx * uint(BLOCK_SIZE) + i * uint(THREAD_GROUP_SIZE) + GI;\n"
+"        if (Idx < g_NumElements)\n"
+"            g_Output[Idx] = g_Output.Load(int(Idx)) + Offset;\n"
+"    }\n"
+"}\n"
+"\n"
+"#endif // ADD_BLOCK_OFFSETS\n"
+"\n"
+"\n"
+"#ifdef COMPACT\n"
+"\n"
+"Buffer<uint>                        g_Input;\n"
+"Buffer<uint>                        g_Flags;\n"
+"Buffer<uint>                        g_ScannedFlags;\n"
+"RWBuffer</* format = r32ui */ uint> g_Output;\n"
+"RWBuffer</* format = r32ui */ uint> g_Count;\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void CompactCS(uint3 Gid : SV_GroupID,\n"
+"               uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    // Extra groups of a two-dimensional dispatch have no elements to process\n"
+"    if (GroupIdx * uint(BLOCK_SIZE) >= g_NumElements)\n"
+"        return;\n"
+"    for (uint i = 0u; i < uint(ITEMS_PER_THREAD); ++i)\n"
+"    {\n"
+"        uint Idx = GroupIdx * uint(BLOCK_SIZE) + i * uint(THREAD_GROUP_SIZE) + GI;\n"
+"        if (Idx < g_NumElements)\n"
+"        {\n"
+"            uint Flag     = g_Flags.Load(int(Idx));\n"
+"            uint DstIndex = g_ScannedFlags.Load(int(Idx));\n"
+"            if (Flag != 0u)\n"
+"                g_Output[DstIndex] = g_Input.Load(int(Idx));\n"
+"\n"
+"            if (Idx == g_NumElements - 1u)\n"
+"                g_Count[0] = DstIndex + (Flag != 0u ? 1u : 0u);\n"
+"        }\n"
+"    }\n"
+"}\n"
+"\n"
+"#endif // COMPACT\n"
+"\n"
+"\n"
+"#ifdef RADIX_HISTOGRAM\n"
+"\n"
+"RWBuffer</* format = r32ui */ uint> g_KeysIn;\n"
+"RWBuffer</* format = r32ui */ uint> g_BlockHistogram;\n"
+"\n"
+"groupshared uint g_Histogram[RADIX_SIZE];\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void RadixHistogramCS(uint3 Gid : SV_GroupID,\n"
+"                      uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    if (GroupIdx >= g_NumBlocks)\n"
+"        return;\n"
+"    if (GI < uint(RADIX_SIZE))\n"
+"        g_Histogram[GI] = 0u;\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    uint Idx = GroupIdx * uint(THREAD_GROUP_SIZE) + GI;\n"
+"    if (Idx < g_NumElements)\n"
+"    {\n"
+"        uint Digit = (g_KeysIn.Load(int(Idx)) >> g_RadixShift) & uint(RADIX_MASK);\n"
+"        InterlockedAdd(g_Histogram[Digit], 1u);\n"
+"    }\n"
+"    GroupMemoryBarrierWithGroupSync();\n"
+"\n"
+"    // Digit-major layout: scanning the histogram gives the global offset of every digit in every block\n"
+"    if (GI < uint(RADIX_SIZE))\n"
+"        g_BlockHistogram[GI * g_NumBlocks + GroupIdx] = g_Histogram[GI];\n"
+"}\n"
+"\n"
+"#endif // RADIX_HISTOGRAM\n"
+"\n"
+"\n"
+"#ifdef RADIX_SCATTER\n"
+"\n"
+"#ifndef HAS_VALUES\n"
+"#   define HAS_VALUES 0\n"
+"#endif\n"
+"\n"
+"RWBuffer</* format = r32ui */ uint> g_KeysIn;\n"
+"RWBuffer</* format = r32ui */ uint> g_KeysOut;\n"
+"#if HAS_VALUES\n"
+"RWBuffer</* format = r32ui */ uint> g_ValuesIn;\n"
+"RWBuffer</* format = r32ui */ uint> g_ValuesOut;\n"
+"#endif\n"
+"Buffer<uint>                        g_ScannedHistogram;\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, 1, 1)]\n"
+"void RadixScatterCS(uint3 Gid : SV_GroupID,\n"
+"                    uint  GI  : SV_GroupIndex)\n"
+"{\n"
+"    uint GroupIdx = GetGroupIndex(Gid);\n"
+"    if (GroupIdx >= g_NumBlocks)\n"
+"        return;\n"
+"    uint Idx      = GroupIdx * uint(THREAD_GROUP_SIZE) + GI;\n"
+"    bool IsValid  = Idx < g_NumElements;\n"
+"    uint Key      = IsValid ? g_KeysIn.Load(int(Idx)) : 0u;\n"
+"    uint Digit    = (Key >> g_RadixShift) & uint(RADIX_MASK);\n"
+"\n"
+"    // Stable rank of the key among the keys with the same digit in this block.\n"
+"    // Two digits are processed by every scan: the counts of the even digit are\n"
+"    // accumulated in the low 16 bits, and the counts of the odd digit - in the high 16 bits.\n"
+"    uint LocalRank = 0u;\n"
+"    for (uint d = 0u; d < uint(RADIX_SIZE); d += 2u)\n"
+"    {\n"
+"        uint Flags = 0u;\n"
+"        if (IsValid && Digit == d)\n"
+"            Flags = 1u;\n"
+"        else if (IsValid && Digit == d + 1u)\n"
+"            Flags = 0x10000u;\n"
+"\n"
+"        uint Total  = 0u;\n"
+"        uint Prefix = GroupExclusiveScan(Flags, GI, Total);\n"
+"        if (Digit == d)\n"
+"            LocalRank = Prefix & 0xFFFFu;\n"
+"        else if (Digit == d + 1u)\n"
+"            LocalRank = Prefix >> 16u;\n"
+"    }\n"
+"\n"
+"    if (IsValid)\n"
+"    {\n"
+"        uint DstIdx = g_ScannedHistogram.Load(int(Digit * g_NumBlocks + GroupIdx)) + LocalRank;\n"
+"        g_KeysOut[DstIdx] = Key;\n"
+"#if HAS_VALUES\n"
+"        g_ValuesOut[DstIdx] = g_ValuesIn.Load(int(Idx));\n"
+"#endif\n"
+"    }\n"
+"}\n"
+"\n"
+"#endif // RADIX_SCATTER\n"
@@ -0,0 +1,153 @@
+"// Screen capture conversion kernels.\n"
+"// The kernel is selected by one of the following macros and uses its own entry point:\n"
+"//   CONVERT_RGBA8  (ConvertRGBA8CS)  - packs every pixel into a 32-bit RGBA8 value\n"
+"//   CONVERT_YUV420 (ConvertYUV420CS) - converts pixels to planar 8-bit Y, U, V (I420), BT.709 limited range\n"
+"//\n"
+"// The output buffer is accessed through a formatted r32ui view. Byte offsets and strides\n"
+"// in the constant buffer are always multiples of 4.\n"
+"\n"
+"#ifndef THREAD_GROUP_SIZE\n"
+"#   define THREAD_GROUP_SIZE 8\n"
+"#endif\n"
+"\n"
+"// Set to 1 when the source texture has an sRGB format, so that the values returned by\n"
+"// the texture load are linear and must be converted back to gamma space.\n"
+"#ifndef CONVERT_TO_SRGB\n"
+"#   define CONVERT_TO_SRGB 0\n"
+"#endif\n"
+"\n"
+"cbuffer cbConstants\n"
+"{\n"
+"    uint g_Width;\n"
+"    uint g_Height;\n"
+"    // Byte stride of the first plane (RGBA8 or Y)\n"
+"    uint g_Stride0;\n"
+"    // Byte stride of the U and V planes\n"
+"    uint g_ChromaStride;\n"
+"    // Byte offsets of the U and V planes\n"
+"    uint g_UOffset;\n"
+"    uint g_VOffset;\n"
+"    uint g_Padding0;\n"
+"    uint g_Padding1;\n"
+"}\n"
+"\n"
+"Texture2D<float4> g_Source;\n"
+"\n"
+"RWBuffer</* format = r32ui */ uint> g_Output;\n"
+"\n"
+"float3 LinearToSRGB(float3 Linear)\n"
+"{\n"
+"    float3 Lo = Linear * 12.92;\n"
+"    float3 Hi = 1.055 * pow(max(Linear, float3(0.0, 0.0, 0.0)), float3(1.0 / 2.4, 1.0 / 2.4, 1.0 / 2.4)) - 0.055;\n"
+"    return float3(Linear.r <= 0.0031308 ? Lo.r : Hi.r,\n"
+"                  Linear.g <= 0.0031308 ? Lo.g : Hi.g,\n"
+"                  Linear.b <= 0.0031308 ? Lo.b : Hi.b);\n"
+"}\n"
+"\n"
+"float4 LoadPixel(uint x, uint y)\n"
+"{\n"
+"    // Pixels outside of the source texture replicate the edge\n"
+"    int3   Location = int3(int(min(x, g_Width - 1u)), int(min(y, g_Height - 1u)), 0);\n"
+"    float4 Color    = saturate(g_Source.Load(Location));\n"
+"#if CONVERT_TO_SRGB\n"
+"    Color.rgb = LinearToSRGB(Color.rgb);\n"
+"#endif\n"
+"    return Color;\n"
+"}\n"
+"\n"
+"uint ToUNorm8(float Value)\n"
+"{\n"
+"    return uint(saturate(Value) * 255.0 + 0.5);\n"
+"}\n"
+"\n"
+"uint PackBytes(uint b0, uint b1, uint b2, uint b3)\n"
+"{\n"
+"    return b0 | (b1 << 8u) | (b2 << 16u) | (b3 << 24u);\n"
+"}\n"
+"\n"
+"\n"
+"#ifdef CONVERT_RGBA8\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]\n"
+"void ConvertRGBA8CS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    if (DTid.x >= g_Width || DTid.y >= g_Height)\n"
+"        return;\n"
+"\n"
+"    float4 Color = LoadPixel(DTid.x, DTid.y);\n"
+"    g_Output[(DTid.y * g_Stride0) / 4u + DTid.x] =\n"
+"        PackBytes(ToUNorm8(Color.r), ToUNorm8(Color.g), ToUNorm8(Color.b), ToUNorm8(Color.a));\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#ifdef CONVERT_YUV420\n"
+"\n"
+"// BT.709 luma coefficients\n"
+"#define KR 0.2126\n"
+"#define KB 0.0722\n"
+"#define KG (1.0 - KR - KB)\n"
+"\n"
+"float GetLuma(float3 RGB)\n"
+"{\n"
+"    return dot(RGB, float3(KR, KG, KB));\n"
+"}\n"
+"\n"
+"// Limited range: Y is in [16, 235], U and V are in [16, 240]\n"
+"uint LumaToByte(float Y)\n"
+"{\n"
+"    return uint(16.0 + Y * 219.0 + 0.5);\n"
+"}\n"
+"\n"
+"uint2 ChromaToBytes(float3 RGB)\n"
+"{\n"
+"    float Y = GetLuma(RGB);\n"
+"    float U = (RGB.b - Y) / (2.0 * (1.0 - KB));\n"
+"    float V = (RGB.r - Y) / (2.0 * (1.0 - KR));\n"
+"    return uint2(uint(128.0 + U * 224.0 + 0.5), uint(128.0 + V * 224.0 + 0.5));\n"
+"}\n"
+"\n"
+"// Every thread processes an 8x2 block of pixels, so that it writes whole 32-bit words:\n"
+"// two words in each of the two luma rows and one word in each of the chroma planes.\n"
+"// The luma plane width is padded to a multiple of 8 and its height to a multiple of 2.\n"
+"[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]\n"
+"void ConvertYUV420CS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    uint x0 = DTid.x * 8u;\n"
+"    uint y0 = DTid.y * 2u;\n"
+"    if (x0 >= g_Width || y0 >= g_Height)\n"
+"        return;\n"
+"\n"
+"    uint Luma[16];\n"
+"    uint Chroma[8];\n"
+"    for (uint i = 0u; i < 4u; ++i)\n"
+"    {\n"
+"        float3 c00 = LoadPixel(x0 + i * 2u,      y0     ).rgb;\n"
+"        float3 c10 = LoadPixel(x0 + i * 2u + 1u, y0     ).rgb;\n"
+"        float3 c01 = LoadPixel(x0 + i * 2u,      y0 + 1u).rgb;\n"
+"        float3 c11 = LoadPixel(x0 + i * 2u + 1u, y0 + 1u).rgb;\n"
+"\n"
+"        Luma[i * 2u]           = LumaToByte(GetLuma(c00));\n"
+"        Luma[i * 2u + 1u]      = LumaToByte(GetLuma(c10));\n"
+"        Luma[8u + i * 2u]      = LumaToByte(GetLuma(c01));\n"
+"        Luma[8u + i * 2u + 1u] = LumaToByte(GetLuma(c11));\n"
+"\n"
+"        uint2 UV = ChromaToBytes((c00 + c10 + c01 + c11) * 0.25);\n"
+"        Chroma[i]      = UV.x;\n"
+"        Chroma[4u + i] = UV.y;\n"
+"    }\n"
+"\n"
+"    uint Row0 = (y0 * g_Stride0 + x0) / 4u;\n"
+"    uint Row1 = Row0 + g_Stride0 / 4u;\n"
+"    g_Output[Row0]      = PackBytes(Luma[0],  Luma[1],  Luma[2],  Luma[3]);\n"
+"    g_Output[Row0 + 1u] = PackBytes(Luma[4],  Luma[5],  Luma[6],  Luma[7]);\n"
+"    g_Output[Row1]      = PackBytes(Luma[8],  Luma[9],  Luma[10], Luma[11]);\n"
+"    g_Output[Row1 + 1u] = PackBytes(Luma[12], Luma[13], Luma[14], Luma[15]);\n"
+"\n"
+"    uint ChromaOffset = DTid.y * g_ChromaStride + DTid.x * 4u;\n"
+"    g_Output[(g_UOffset + ChromaOffset) / 4u] = PackBytes(Chroma[0], Chroma[1], Chroma[2], Chroma[3]);\n"
+"    g_Output[(g_VOffset + ChromaOffset) / 4u] = PackBytes(Chroma[4], Chroma[5], Chroma[6], Chroma[7]);\n"
+"}\n"
+"\n"
+"#endif\n"
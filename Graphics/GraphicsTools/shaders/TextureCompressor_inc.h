@@ -0,0 +1,536 @@
+"// Block-compression kernels. Every thread encodes one 4x4 block.\n"
+"// The kernel is selected by one of the following macros, the entry point is always CompressCS:\n"
+"//   COMPRESS_BC1 - BC1 with 1-bit transparency, 8-byte blocks\n"
+"//   COMPRESS_BC3 - BC3, 16-byte blocks\n"
+"//   COMPRESS_BC4 - BC4 from the red channel, 8-byte blocks\n"
+"//   COMPRESS_BC5 - BC5 from the red and green channels, 16-byte blocks\n"
+"//   COMPRESS_BC7 - BC7 mode 6, 16-byte blocks\n"
+"//\n"
+"// The algorithms mirror the CPU encoder in TextureCompressor.cpp. The blocks are written to\n"
+"// an rg32ui or rgba32ui texture with one texel per block that is then copied to the compressed texture.\n"
+"\n"
+"#ifndef THREAD_GROUP_SIZE\n"
+"#   define THREAD_GROUP_SIZE 8\n"
+"#endif\n"
+"\n"
+"// Set to 1 when the source texture has an sRGB format, so that the values returned by\n"
+"// the texture load are linear and must be converted back to gamma space.\n"
+"#ifndef CONVERT_TO_SRGB\n"
+"#   define CONVERT_TO_SRGB 0\n"
+"#endif\n"
+"\n"
+"#if defined(COMPRESS_BC1) || defined(COMPRESS_BC4)\n"
+"#   define BLOCK_SIZE 8\n"
+"#else\n"
+"#   define BLOCK_SIZE 16\n"
+"#endif\n"
+"\n"
+"#define FLT_LARGE 1e+30\n"
+"\n"
+"cbuffer cbConstants\n"
+"{\n"
+"    uint g_Width;\n"
+"    uint g_Height;\n"
+"    uint g_NumBlocksX;\n"
+"    uint g_NumBlocksY;\n"
+"}\n"
+"\n"
+"Texture2D<float4> g_Source;\n"
+"\n"
+"#if BLOCK_SIZE == 8\n"
+"RWTexture2D</* format = rg32ui */ uint2> g_Output;\n"
+"#else\n"
+"RWTexture2D</* format = rgba32ui */ uint4> g_Output;\n"
+"#endif\n"
+"\n"
+"float3 LinearToSRGB(float3 Linear)\n"
+"{\n"
+"    float3 Lo = Linear * 12.92;\n"
+"    float3 Hi = 1.055 * pow(max(Linear, float3(0.0, 0.0, 0.0)), float3(1.0 / 2.4, 1.0 / 2.4, 1.0 / 2.4)) - 0.055;\n"
+"    return float3(Linear.r <= 0.0031308 ? Lo.r : Hi.r,\n"
+"                  Linear.g <= 0.0031308 ? Lo.g : Hi.g,\n"
+"                  Linear.b <= 0.0031308 ? Lo.b : Hi.b);\n"
+"}\n"
+"\n"
+"// Loads the block texels in [0, 255] range, replicating the edge texels for partial blocks\n"
+"void LoadBlock(uint2 BlockIdx, out float4 Block[16])\n"
+"{\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        uint   x     = min(BlockIdx.x * 4u + (i & 3u), g_Width - 1u);\n"
+"        uint   y     = min(BlockIdx.y * 4u + (i >> 2u), g_Height - 1u);\n"
+"        float4 Color = saturate(g_Source.Load(int3(int(x), int(y), 0)));\n"
+"#if CONVERT_TO_SRGB\n"
+"        Color.rgb = LinearToSRGB(Color.rgb);\n"
+"#endif\n"
+"        // Round to 8 bits, which is what the CPU encoder works with\n"
+"        Block[i] = floor(Color * 255.0 + float4(0.5, 0.5, 0.5, 0.5));\n"
+"    }\n"
+"}\n"
+"\n"
+"// Writes the value to the given bit position of the block. The value must fit into NumBits bits,\n"
+"// and the bits must not have been set.\n"
+"void WriteBits(inout uint4 Block, uint Pos, uint Value, uint NumBits)\n"
+"{\n"
+"    uint Word  = Pos >> 5u;\n"
+"    uint Shift = Pos & 31u;\n"
+"    Block[Word] |= Value << Shift;\n"
+"    if (Shift + NumBits > 32u)\n"
+"        Block[Word + 1u] |= Value >> (32u - Shift);\n"
+"}\n"
+"\n"
+"// Returns the end points of the segment along the principal axis of the texels that covers all texels\n"
+"// with non-zero weight. Unused channels of the texels must be zero.\n"
+"void FitPrincipalAxis(float4 Texels[16], float Weights[16], out float4 E0, out float4 E1)\n"
+"{\n"
+"    float4 Mean        = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    float  TotalWeight = 0.0;\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        TotalWeight += Weights[i];\n"
+"        Mean += Weights[i] * Texels[i];\n"
+"    }\n"
+"    if (TotalWeight > 0.0)\n"
+"        Mean /= TotalWeight;\n"
+"\n"
+"    E0 = Mean;\n"
+"    E1 = Mean;\n"
+"    if (TotalWeight == 0.0)\n"
+"        return;\n"
+"\n"
+"    float4 Cov[4];\n"
+"    Cov[0] = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    Cov[1] = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    Cov[2] = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    Cov[3] = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        float4 d = Texels[i] - Mean;\n"
+"        Cov[0] += Weights[i] * d.x * d;\n"
+"        Cov[1] += Weights[i] * d.y * d;\n"
+"        Cov[2] += Weights[i] * d.z * d;\n"
+"        Cov[3] += Weights[i] * d.w * d;\n"
+"    }\n"
+"\n"
+"    // Power iteration starting from the covariance matrix row with the largest variance,\n"
+"    // which is never orthogonal to the principal axis\n"
+"    float4 Axis   = Cov[0];\n"
+"    float  MaxVar = Cov[0].x;\n"
+"    if (Cov[1].y > MaxVar)\n"
+"    {\n"
+"        Axis   = Cov[1];\n"
+"        MaxVar = Cov[1].y;\n"
+"    }\n"
+"    if (Cov[2].z > MaxVar)\n"
+"    {\n"
+"        Axis   = Cov[2];\n"
+"        MaxVar = Cov[2].z;\n"
+"    }\n"
+"    if (Cov[3].w > MaxVar)\n"
+"    {\n"
+"        Axis   = Cov[3];\n"
+"        MaxVar = Cov[3].w;\n"
+"    }\n"
+"    if (MaxVar == 0.0)\n"
+"        return;\n"
+"\n"
+"    for (uint Iter = 0u; Iter < 8u; ++Iter)\n"
+"    {\n"
+"        float4 NewAxis = float4(dot(Cov[0], Axis), dot(Cov[1], Axis), dot(Cov[2], Axis), dot(Cov[3], Axis));\n"
+"        float4 AbsAxis = abs(NewAxis);\n"
+"        float  MaxComp = max(max(AbsAxis.x, AbsAxis.y), max(AbsAxis.z, AbsAxis.w));\n"
+"        if (MaxComp == 0.0)\n"
+"            break;\n"
+"        Axis = NewAxis / MaxComp;\n"
+"    }\n"
+"\n"
+"    float Len2 = dot(Axis, Axis);\n"
+"    if (Len2 == 0.0)\n"
+"        return;\n"
+"    Axis *= rsqrt(Len2);\n"
+"\n"
+"    float MinT = +FLT_LARGE;\n"
+"    float MaxT = -FLT_LARGE;\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        if (Weights[i] > 0.0)\n"
+"        {\n"
+"            float t = dot(Texels[i] - Mean, Axis);\n"
+"            MinT    = min(MinT, t);\n"
+"            MaxT    = max(MaxT, t);\n"
+"        }\n"
+"    }\n"
+"\n"
+"    E0 = clamp(Mean + Axis * MinT, 0.0, 255.0);\n"
+"    E1 = clamp(Mean + Axis * MaxT, 0.0, 255.0);\n"
+"}\n"
+"\n"
+"// Finds the least-squares end points for the given interpolation factors of E1 of every texel.\n"
+"// Returns false if the system is degenerate, e.g. when all texels use the same factor.\n"
+"bool RefineEndpoints(float4 Texels[16], float Weights[16], float Factors[16], inout float4 E0, inout float4 E1)\n"
+"{\n"
+"    float  A  = 0.0;\n"
+"    float  B  = 0.0;\n"
+"    float  C  = 0.0;\n"
+"    float4 X0 = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    float4 X1 = float4(0.0, 0.0, 0.0, 0.0);\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        float w = Weights[i];\n"
+"        float b = Factors[i];\n"
+"        float a = 1.0 - b;\n"
+"\n"
+"        A += w * a * a;\n"
+"        B += w * a * b;\n"
+"        C += w * b * b;\n"
+"        X0 += w * a * Texels[i];\n"
+"        X1 += w * b * Texels[i];\n"
+"    }\n"
+"\n"
+"    float Det = A * C - B * B;\n"
+"    if (abs(Det) < 1e-6)\n"
+"        return false;\n"
+"\n"
+"    E0 = clamp((C * X0 - B * X1) / Det, 0.0, 255.0);\n"
+"    E1 = clamp((A * X1 - B * X0) / Det, 0.0, 255.0);\n"
+"    return true;\n"
+"}\n"
+"\n"
+"\n"
+"#if defined(COMPRESS_BC1) || defined(COMPRESS_BC3)\n"
+"\n"
+"uint QuantizeRGB565(float4 Color)\n"
+"{\n"
+"    uint3 q = uint3(Color.rgb * float3(31.0 / 255.0, 63.0 / 255.0, 31.0 / 255.0) + float3(0.5, 0.5, 0.5));\n"
+"    return (q.r << 11u) | (q.g << 5u) | q.b;\n"
+"}\n"
+"\n"
+"float4 UnpackRGB565(uint Color)\n"
+"{\n"
+"    uint r = (Color >> 11u) & 31u;\n"
+"    uint g = (Color >> 5u) & 63u;\n"
+"    uint b = Color & 31u;\n"
+"    return float4(float((r << 3u) | (r >> 2u)), float((g << 2u) | (g >> 4u)), float((b << 3u) | (b >> 2u)), 0.0);\n"
+"}\n"
+"\n"
+"// Encodes the color block of BC1 and BC3 formats.\n"
+"// When AllowTransparency is true, texels with alpha below 128 are encoded as transparent\n"
+"// using the 3-color mode, which is only available in BC1.\n"
+"uint2 EncodeBC1ColorBlock(float4 Block[16], bool AllowTransparency)\n"
+"{\n"
+"    float4 Texels[16];\n"
+"    float  Weights[16];\n"
+"    bool   HasTransparent = false;\n"
+"    bool   AllTransparent = true;\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        bool IsTransparent = AllowTransparency && Block[i].a < 128.0;\n"
+"        Texels[i]          = float4(Block[i].rgb, 0.0);\n"
+"        Weights[i]         = IsTransparent ? 0.0 : 1.0;\n"
+"        HasTransparent     = HasTransparent || IsTransparent;\n"
+"        AllTransparent     = AllTransparent && IsTransparent;\n"
+"    }\n"
+"\n"
+"    uint c0 = 0u;\n"
+"    uint c1 = 0u;\n"
+"    uint Indices[16];\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"        Indices[i] = 3u;\n"
+"\n"
+"    if (!AllTransparent)\n"
+"    {\n"
+"        // Interpolation factors of the second end point for every palette entry\n"
+"        float4 Factors    = HasTransparent ? float4(0.0, 1.0, 0.5, 0.0) : float4(0.0, 1.0, 1.0 / 3.0, 2.0 / 3.0);\n"
+"        uint   NumEntries = HasTransparent ? 3u : 4u;\n"
+"\n"
+"        float4 E0;\n"
+"        float4 E1;\n"
+"        FitPrincipalAxis(Texels, Weights, E0, E1);\n"
+"\n"
+"        float BestError = FLT_LARGE;\n"
+"        for (uint Iter = 0u; Iter < 3u; ++Iter)\n"
+"        {\n"
+"            uint q0 = QuantizeRGB565(E0);\n"
+"            uint q1 = QuantizeRGB565(E1);\n"
+"\n"
+"            float4 Palette[4];\n"
+"            Palette[0] = UnpackRGB565(q0);\n"
+"            Palette[1] = UnpackRGB565(q1);\n"
+"            Palette[2] = Palette[0] * (1.0 - Factors.z) + Palette[1] * Factors.z;\n"
+"            Palette[3] = Palette[0] * (1.0 - Factors.w) + Palette[1] * Factors.w;\n"
+"\n"
+"            uint  IterIndices[16];\n"
+"            float Error = 0.0;\n"
+"            for (uint i = 0u; i < 16u; ++i)\n"
+"            {\n"
+"                float BestDist = FLT_LARGE;\n"
+"                uint  BestIdx  = 0u;\n"
+"                for (uint k = 0u; k < NumEntries; ++k)\n"
+"                {\n"
+"                    float4 d    = Texels[i] - Palette[k];\n"
+"                    float  Dist = dot(d, d);\n"
+"                    if (Dist < BestDist)\n"
+"                    {\n"
+"                        BestDist = Dist;\n"
+"                        BestIdx  = k;\n"
+"                    }\n"
+"                }\n"
+"                IterIndices[i] = BestIdx;\n"
+"                Error += Weights[i] * BestDist;\n"
+"            }\n"
+"\n"
+"            if (Error < BestError)\n"
+"            {\n"
+"                BestError = Error;\n"
+"                c0        = q0;\n"
+"                c1        = q1;\n"
+"                for (uint i = 0u; i < 16u; ++i)\n"
+"                    Indices[i] = IterIndices[i];\n"
+"            }\n"
+"            if (Error == 0.0)\n"
+"                break;\n"
+"\n"
+"            float TexelFactors[16];\n"
+"            for (uint i = 0u; i < 16u; ++i)\n"
+"                TexelFactors[i] = Factors[IterIndices[i]];\n"
+"            if (!RefineEndpoints(Texels, Weights, TexelFactors, E0, E1))\n"
+"                break;\n"
+"        }\n"
+"\n"
+"        if (HasTransparent)\n"
+"        {\n"
+"            // The 3-color mode requires c0 <= c1\n"
+"            bool Swap = c0 > c1;\n"
+"            if (Swap)\n"
+"            {\n"
+"                uint Tmp = c0;\n"
+"                c0       = c1;\n"
+"                c1       = Tmp;\n"
+"            }\n"
+"            for (uint i = 0u; i < 16u; ++i)\n"
+"            {\n"
+"                if (Weights[i] == 0.0)\n"
+"                    Indices[i] = 3u;\n"
+"                else if (Swap && Indices[i] < 2u)\n"
+"                    Indices[i] ^= 1u;\n"
+"            }\n"
+"        }\n"
+"        else\n"
+"        {\n"
+"            // The 4-color mode requires c0 > c1. If the end points are equal, all entries are the same\n"
+"            // color and index 0 must be used as the decoder selects the 3-color mode.\n"
+"            if (c0 < c1)\n"
+"            {\n"
+"                uint Tmp = c0;\n"
+"                c0       = c1;\n"
+"                c1       = Tmp;\n"
+"                for (uint i = 0u; i < 16u; ++i)\n"
+"                    Indices[i] ^= 1u;\n"
+"            }\n"
+"            else if (c0 == c1)\n"
+"            {\n"
+"                for (uint i = 0u; i < 16u; ++i)\n"
+"                    Indices[i] = 0u;\n"
+"            }\n"
+"        }\n"
+"    }\n"
+"\n"
+"    uint IndexBits = 0u;\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"        IndexBits |= Indices[i] << (i * 2u);\n"
+"\n"
+"    return uint2(c0 | (c1 << 16u), IndexBits);\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#if defined(COMPRESS_BC3) || defined(COMPRESS_BC4) || defined(COMPRESS_BC5)\n"
+"\n"
+"// Encodes the given channel of the block as a BC4 block (also used for BC3 alpha and BC5)\n"
+"uint2 EncodeBC4Channel(float4 Block[16], uint Channel)\n"
+"{\n"
+"    float MaxVal = 0.0;\n"
+"    float MinVal = 255.0;\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"    {\n"
+"        MaxVal = max(MaxVal, Block[i][Channel]);\n"
+"        MinVal = min(MinVal, Block[i][Channel]);\n"
+"    }\n"
+"\n"
+"    uint a0 = uint(MaxVal);\n"
+"    uint a1 = uint(MinVal);\n"
+"\n"
+"    uint4 Bits = uint4(a0 | (a1 << 8u), 0u, 0u, 0u);\n"
+"    // The 8-value mode (a0 > a1) evenly spaces six interpolated values between a0 and a1.\n"
+"    // When a0 == a1, all indices are 0.\n"
+"    if (a0 > a1)\n"
+"    {\n"
+"        float Scale = 7.0 / float(a0 - a1);\n"
+"        for (uint i = 0u; i < 16u; ++i)\n"
+"        {\n"
+"            // Position on the a0 -> a1 ramp\n"
+"            uint Pos = uint((MaxVal - Block[i][Channel]) * Scale + 0.5);\n"
+"            uint Idx = Pos == 0u ? 0u : (Pos == 7u ? 1u : Pos + 1u);\n"
+"            WriteBits(Bits, 16u + i * 3u, Idx, 3u);\n"
+"        }\n"
+"    }\n"
+"    return Bits.xy;\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"#ifdef COMPRESS_BC7\n"
+"\n"
+"static const uint Mode6Weights[16] = {0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u};\n"
+"\n"
+"// Quantizes the BC7 mode 6 end point to 7 bits per channel and selects the p-bit shared by all channels\n"
+"void QuantizeBC7Mode6Endpoint(float4 E, out uint4 Q, out uint PBit)\n"
+"{\n"
+"    float BestError = FLT_LARGE;\n"
+"    Q               = uint4(0u, 0u, 0u, 0u);\n"
+"    PBit            = 0u;\n"
+"    for (uint p = 0u; p < 2u; ++p)\n"
+"    {\n"
+"        uint4  q     = uint4(clamp((E - float(p)) * 0.5 + 0.5, 0.0, 127.0));\n"
+"        float4 d     = float4(q * 2u + p) - E;\n"
+"        float  Error = dot(d, d);\n"
+"        if (Error < BestError)\n"
+"        {\n"
+"            BestError = Error;\n"
+"            Q         = q;\n"
+"            PBit      = p;\n"
+"        }\n"
+"    }\n"
+"}\n"
+"\n"
+"// Encodes the block in BC7 mode 6: one subset, RGBA end points with 7 bits per channel plus\n"
+"// a p-bit per end point, and 4-bit indices.\n"
+"uint4 EncodeBC7Block(float4 Block[16])\n"
+"{\n"
+"    float Weights[16];\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"        Weights[i] = 1.0;\n"
+"\n"
+"    float4 E0;\n"
+"    float4 E1;\n"
+"    FitPrincipalAxis(Block, Weights, E0, E1);\n"
+"\n"
+"    uint4 Q0 = uint4(0u, 0u, 0u, 0u);\n"
+"    uint4 Q1 = uint4(0u, 0u, 0u, 0u);\n"
+"    uint  P0 = 0u;\n"
+"    uint  P1 = 0u;\n"
+"    uint  Indices[16];\n"
+"    for (uint i = 0u; i < 16u; ++i)\n"
+"        Indices[i] = 0u;\n"
+"\n"
+"    float BestError = FLT_LARGE;\n"
+"    for (uint Iter = 0u; Iter < 3u; ++Iter)\n"
+"    {\n"
+"        uint4 q0;\n"
+"        uint4 q1;\n"
+"        uint  p0;\n"
+"        uint  p1;\n"
+"        QuantizeBC7Mode6Endpoint(E0, q0, p0);\n"
+"        QuantizeBC7Mode6Endpoint(E1, q1, p1);\n"
+"\n"
+"        uint4 v0 = q0 * 2u + p0;\n"
+"        uint4 v1 = q1 * 2u + p1;\n"
+"\n"
+"        float4 Palette[16];\n"
+"        for (uint k = 0u; k < 16u; ++k)\n"
+"            Palette[k] = float4(((64u - Mode6Weights[k]) * v0 + Mode6Weights[k] * v1 + 32u) >> 6u);\n"
+"\n"
+"        uint  IterIndices[16];\n"
+"        float Error = 0.0;\n"
+"        for (uint i = 0u; i < 16u; ++i)\n"
+"        {\n"
+"            float BestDist = FLT_LARGE;\n"
+"            uint  BestIdx  = 0u;\n"
+"            for (uint k = 0u; k < 16u; ++k)\n"
+"            {\n"
+"                float4 d    = Block[i] - Palette[k];\n"
+"                float  Dist = dot(d, d);\n"
+"                if (Dist < BestDist)\n"
+"                {\n"
+"                    BestDist = Dist;\n"
+"                    BestIdx  = k;\n"
+"                }\n"
+"            }\n"
+"            IterIndices[i] = BestIdx;\n"
+"            Error += BestDist;\n"
+"        }\n"
+"\n"
+"        if (Error < BestError)\n"
+"        {\n"
+"            BestError = Error;\n"
+"            Q0        = q0;\n"
+"            Q1        = q1;\n"
+"            P0        = p0;\n"
+"            P1        = p1;\n"
+"            for (uint i = 0u; i < 16u; ++i)\n"
+"                Indices[i] = IterIndices[i];\n"
+"        }\n"
+"        if (Error == 0.0)\n"
+"            break;\n"
+"\n"
+"        float TexelFactors[16];\n"
+"        for (uint i = 0u; i < 16u; ++i)\n"
+"            TexelFactors[i] = float(Mode6Weights[IterIndices[i]]) / 64.0;\n"
+"        if (!RefineEndpoints(Block, Weights, TexelFactors, E0, E1))\n"
+"            break;\n"
+"    }\n"
+"\n"
+"    // The most significant bit of the anchor index is implicitly zero\n"
+"    if (Indices[0] >= 8u)\n"
+"    {\n"
+"        uint4 TmpQ = Q0;\n"
+"        Q0         = Q1;\n"
+"        Q1         = TmpQ;\n"
+"        uint TmpP  = P0;\n"
+"        P0         = P1;\n"
+"        P1         = TmpP;\n"
+"        for (uint i = 0u; i < 16u; ++i)\n"
+"            Indices[i] = 15u - Indices[i];\n"
+"    }\n"
+"\n"
+"    // Mode 6 is encoded as six zero bits followed by a one\n"
+"    uint4 Bits = uint4(1u << 6u, 0u, 0u, 0u);\n"
+"    for (uint c = 0u; c < 4u; ++c)\n"
+"    {\n"
+"        WriteBits(Bits, 7u + c * 14u, Q0[c], 7u);\n"
+"        WriteBits(Bits, 14u + c * 14u, Q1[c], 7u);\n"
+"    }\n"
+"    WriteBits(Bits, 63u, P0, 1u);\n"
+"    WriteBits(Bits, 64u, P1, 1u);\n"
+"    WriteBits(Bits, 65u, Indices[0], 3u);\n"
+"    for (uint i = 1u; i < 16u; ++i)\n"
+"        WriteBits(Bits, 68u + (i - 1u) * 4u, Indices[i], 4u);\n"
+"    return Bits;\n"
+"}\n"
+"\n"
+"#endif\n"
+"\n"
+"\n"
+"[numthreads(THREAD_GROUP_SIZE, THREAD_GROUP_SIZE, 1)]\n"
+"void CompressCS(uint3 DTid : SV_DispatchThreadID)\n"
+"{\n"
+"    if (DTid.x >= g_NumBlocksX || DTid.y >= g_NumBlocksY)\n"
+"        return;\n"
+"\n"
+"    float4 Block[16];\n"
+"    LoadBlock(DTid.xy, Block);\n"
+"\n"
+"#if defined(COMPRESS_BC1)\n"
+"    g_Output[DTid.xy] = EncodeBC1ColorBlock(Block, true);\n"
+"#elif defined(COMPRESS_BC3)\n"
+"    g_Output[DTid.xy] = uint4(EncodeBC4Channel(Block, 3u), EncodeBC1ColorBlock(Block, false));\n"
+"#elif defined(COMPRESS_BC4)\n"
+"    g_Output[DTid.xy] = EncodeBC4Channel(Block, 0u);\n"
+"#elif defined(COMPRESS_BC5)\n"
+"    g_Output[DTid.xy] = uint4(EncodeBC4Channel(Block, 0u), EncodeBC4Channel(Block, 1u));\n"
+"#elif defined(COMPRESS_BC7)\n"
+"    g_Output[DTid.xy] = EncodeBC7Block(Block);\n"
+"#endif\n"
+"}\n"
@@ -0,0 +1,437 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncComputeScheduler.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// States that can be used on compute queues in all backends. Graphics-specific states
+// (e.g. render target or pixel shader resource in Direct3D12) can only be transitioned by graphics queues.
+constexpr RESOURCE_STATE ComputeQueueStates =
+    RESOURCE_STATE_UNDEFINED |
+    RESOURCE_STATE_CONSTANT_BUFFER |
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_SHADER_RESOURCE |
+    RESOURCE_STATE_INDIRECT_ARGUMENT |
+    RESOURCE_STATE_COPY_DEST |
+    RESOURCE_STATE_COPY_SOURCE |
+    RESOURCE_STATE_BUILD_AS_READ |
+    RESOURCE_STATE_BUILD_AS_WRITE |
+    RESOURCE_STATE_RAY_TRACING;
+
+constexpr RESOURCE_STATE TransferQueueStates =
+    RESOURCE_STATE_UNDEFINED |
+    RESOURCE_STATE_COPY_DEST |
+    RESOURCE_STATE_COPY_SOURCE;
+
+} // namespace
+
+AsyncComputeScheduler::SubmissionBuilder& AsyncComputeScheduler::SubmissionBuilder::Read(ITexture* pTexture, RESOURCE_STATE State)
+{
+    return AddAccess(pTexture, pTexture, nullptr, State, false);
+}
+
+AsyncComputeScheduler::SubmissionBuilder& AsyncComputeScheduler::SubmissionBuilder::Read(IBuffer* pBuffer, RESOURCE_STATE State)
+{
+    return AddAccess(pBuffer, nullptr, pBuffer, State, false);
+}
+
+AsyncComputeScheduler::SubmissionBuilder& AsyncComputeScheduler::SubmissionBuilder::Write(ITexture* pTexture, RESOURCE_STATE State)
+{
+    return AddAccess(pTexture, pTexture, nullptr, State, true);
+}
+
+AsyncComputeScheduler::SubmissionBuilder& AsyncComputeScheduler::SubmissionBuilder::Write(IBuffer* pBuffer, RESOURCE_STATE State)
+{
+    return AddAccess(pBuffer, nullptr, pBuffer, State, true);
+}
+
+AsyncComputeScheduler::SubmissionBuilder& AsyncComputeScheduler::SubmissionBuilder::AddAccess(IDeviceObject* pResource, ITexture* pTexture, IBuffer* pBuffer, RESOURCE_STATE State, bool Write)
+{
+    DEV_CHECK_ERR(pResource != nullptr, "Resource must not be null");
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN, "Resource state must not be unknown");
+
+    auto& Submission = m_Scheduler.m_Submissions[m_Index];
+#ifdef DILIGENT_DEVELOPMENT
+    {
+        const auto ContextId = m_Scheduler.m_Queues[Submission.Queue].pContext->GetDesc().ContextId;
+        const auto CtxMask   = pTexture != nullptr ? pTexture->GetDesc().ImmediateContextMask : pBuffer->GetDesc().ImmediateContextMask;
+        DEV_CHECK_ERR((CtxMask & (Uint64{1} << ContextId)) != 0,
+                      "Resource '", pResource->GetDesc().Name, "' is used by submission '", Submission.Name,
+                      "', but its ImmediateContextMask does not include the context ", Uint32{ContextId});
+    }
+#endif
+
+    // Every resource is accessed at most once per submission
+    for (auto& Access : Submission.Accesses)
+    {
+        if (Access.pResource == pResource)
+        {
+            DEV_CHECK_ERR(Access.State == State, "Resource '", pResource->GetDesc().Name, "' is declared in different states by submission '",
+                          Submission.Name, "': ", GetResourceStateString(Access.State), " and ", GetResourceStateString(State));
+            Access.State = State;
+            Access.Write = Access.Write || Write;
+            return *this;
+        }
+    }
+
+    ResourceAccess Access;
+    Access.pResource = pResource;
+    Access.pTexture  = pTexture;
+    Access.pBuffer   = pBuffer;
+    Access.State     = State;
+    Access.Write     = Write;
+    Submission.Accesses.emplace_back(Access);
+    return *this;
+}
+
+
+AsyncComputeScheduler::AsyncComputeScheduler(IRenderDevice* pDevice, IDeviceContext* const* ppContexts, Uint32 NumContexts) :
+    m_pDevice{pDevice}
+{
+    if (m_pDevice == nullptr)
+        LOG_ERROR_AND_THROW("Render device must not be null");
+    if (ppContexts == nullptr || NumContexts == 0)
+        LOG_ERROR_AND_THROW("At least one immediate context is required");
+
+    m_Queues.resize(NumContexts);
+    for (Uint32 i = 0; i < NumContexts; ++i)
+    {
+        auto* pContext = ppContexts[i];
+        if (pContext == nullptr)
+            LOG_ERROR_AND_THROW("Context ", i, " is null");
+
+        const auto& CtxDesc = pContext->GetDesc();
+        if (CtxDesc.IsDeferred)
+            LOG_ERROR_AND_THROW("Context ", i, " is a deferred context. Only immediate contexts can be used by the scheduler");
+        for (Uint32 j = 0; j < i; ++j)
+        {
+            if (m_Queues[j].pContext->GetDesc().ContextId == CtxDesc.ContextId)
+                LOG_ERROR_AND_THROW("Contexts ", j, " and ", i, " are the same immediate context");
+        }
+
+        auto& Queue{m_Queues[i]};
+        Queue.pContext = pContext;
+        Queue.Type     = CtxDesc.QueueType;
+        Queue.LastWaitedValues.resize(NumContexts);
+
+        const auto FenceName = std::string{"AsyncComputeScheduler fence for context '"} + (CtxDesc.Name != nullptr ? CtxDesc.Name : "") + '\'';
+
+        FenceDesc Desc;
+        Desc.Name = FenceName.c_str();
+        Desc.Type = FENCE_TYPE_GENERAL;
+        m_pDevice->CreateFence(Desc, &Queue.pFence);
+        if (!Queue.pFence)
+            LOG_ERROR_AND_THROW("Failed to create the fence for context ", i);
+    }
+}
+
+AsyncComputeScheduler::~AsyncComputeScheduler()
+{
+    DEV_CHECK_ERR(m_Submissions.empty(), "There are submissions that have never been executed");
+}
+
+AsyncComputeScheduler::QueueIndex AsyncComputeScheduler::FindQueue(COMMAND_QUEUE_TYPE Type) const
+{
+    for (QueueIndex q = 0; q < m_Queues.size(); ++q)
+    {
+        if ((m_Queues[q].Type & COMMAND_QUEUE_TYPE_PRIMARY_MASK) == Type)
+            return q;
+    }
+    for (QueueIndex q = 0; q < m_Queues.size(); ++q)
+    {
+        if ((m_Queues[q].Type & Type) == Type)
+            return q;
+    }
+    return InvalidQueueIndex;
+}
+
+AsyncComputeScheduler::SubmissionBuilder AsyncComputeScheduler::AddSubmission(const char* Name, QueueIndex Queue, ExecuteCallbackType Execute)
+{
+    DEV_CHECK_ERR(Queue < m_Queues.size(), "Queue index (", Queue, ") is out of range");
+
+    m_Submissions.emplace_back();
+    auto& Submission{m_Submissions.back()};
+    Submission.Name    = Name != nullptr ? Name : "";
+    Submission.Queue   = Queue;
+    Submission.Execute = std::move(Execute);
+    return SubmissionBuilder{*this, m_Submissions.size() - 1};
+}
+
+AsyncComputeScheduler::TrackedResource& AsyncComputeScheduler::GetTrackedResource(const ResourceAccess& Access)
+{
+    auto it = m_Resources.find(Access.pResource);
+    if (it == m_Resources.end())
+    {
+        it = m_Resources.emplace(Access.pResource, TrackedResource{}).first;
+
+        auto& Res{it->second};
+        Res.pResource = Access.pResource;
+        Res.pTexture  = Access.pTexture;
+        Res.pBuffer   = Access.pBuffer;
+        Res.LastAccessValues.resize(m_Queues.size());
+    }
+    return it->second;
+}
+
+RESOURCE_STATE AsyncComputeScheduler::GetResourceState(const TrackedResource& Res) const
+{
+    return Res.pTexture != nullptr ? Res.pTexture->GetState() : Res.pBuffer->GetState();
+}
+
+bool AsyncComputeScheduler::IsStateSupported(QueueIndex Queue, RESOURCE_STATE State) const
+{
+    const auto Type = m_Queues[Queue].Type & COMMAND_QUEUE_TYPE_PRIMARY_MASK;
+    if (Type == COMMAND_QUEUE_TYPE_GRAPHICS)
+        return true;
+    else if (Type == COMMAND_QUEUE_TYPE_COMPUTE)
+        return (State & ~ComputeQueueStates) == 0;
+    else
+        return (State & ~TransferQueueStates) == 0;
+}
+
+void AsyncComputeScheduler::SignalAndFlush(QueueIndex Queue)
+{
+    auto& Dst{m_Queues[Queue]};
+    if (Dst.LastEnqueuedValue < Dst.LastValue)
+    {
+        Dst.pContext->EnqueueSignal(Dst.pFence, Dst.LastValue);
+        Dst.LastEnqueuedValue = Dst.LastValue;
+        ++m_Stats.NumSignals;
+    }
+    Dst.pContext->Flush();
+    Dst.LastSignaledValue = Dst.LastEnqueuedValue;
+    Dst.HasPendingWork    = false;
+}
+
+void AsyncComputeScheduler::WaitForQueue(QueueIndex Queue, QueueIndex SrcQueue, Uint64 Value)
+{
+    if (Queue == SrcQueue || Value == 0)
+        return;
+
+    auto& Dst{m_Queues[Queue]};
+    if (Dst.LastWaitedValues[SrcQueue] >= Value)
+        return;
+
+    // The fence value must be pending before the wait is enqueued
+    if (m_Queues[SrcQueue].LastSignaledValue < Value)
+        SignalAndFlush(SrcQueue);
+
+    // The wait applies to all commands that are submitted after it, so the work that
+    // has already been recorded is submitted first and does not wait.
+    if (Dst.HasPendingWork)
+    {
+        Dst.pContext->Flush();
+        Dst.HasPendingWork = false;
+    }
+
+    Dst.pContext->DeviceWaitForFence(m_Queues[SrcQueue].pFence, Value);
+    Dst.LastWaitedValues[SrcQueue] = Value;
+    ++m_Stats.NumWaits;
+}
+
+void AsyncComputeScheduler::WaitForOtherAccesses(QueueIndex Queue, const TrackedResource& Res, bool WaitForReaders)
+{
+    if (WaitForReaders)
+    {
+        for (QueueIndex q = 0; q < m_Queues.size(); ++q)
+            WaitForQueue(Queue, q, Res.LastAccessValues[q]);
+    }
+    else if (Res.LastWriteQueue != InvalidQueueIndex)
+    {
+        WaitForQueue(Queue, Res.LastWriteQueue, Res.LastWriteValue);
+    }
+}
+
+StateTransitionDesc AsyncComputeScheduler::GetBarrier(const TrackedResource& Res, RESOURCE_STATE NewState)
+{
+    return Res.pTexture != nullptr ?
+        StateTransitionDesc{Res.pTexture, RESOURCE_STATE_UNKNOWN, NewState, true} :
+        StateTransitionDesc{Res.pBuffer, RESOURCE_STATE_UNKNOWN, NewState, true};
+}
+
+void AsyncComputeScheduler::Execute()
+{
+    m_Stats = {};
+
+    // Commands that the application recorded outside of the scheduler may be pending in any context
+    for (auto& Queue : m_Queues)
+        Queue.HasPendingWork = true;
+
+    for (auto& Submission : m_Submissions)
+    {
+        const auto q = Submission.Queue;
+        auto&      Queue{m_Queues[q]};
+
+        // The fence value of the submission. It is assigned to the queue only when the submission
+        // is recorded, so that signals enqueued while resolving dependencies do not cover it.
+        const auto Value = Queue.LastValue + 1;
+
+        m_Barriers.clear();
+        for (const auto& Access : Submission.Accesses)
+        {
+            auto& Res = GetTrackedResource(Access);
+
+            const auto CurrState = GetResourceState(Res);
+            // Resources whose states are not tracked by the engine are transitioned by the application.
+            // UAV to UAV transitions make sure that previous writes on the same queue are visible.
+            bool NeedTransition = CurrState != RESOURCE_STATE_UNKNOWN &&
+                (CurrState != Access.State || Access.State == RESOURCE_STATE_UNORDERED_ACCESS);
+
+            if (NeedTransition && !IsStateSupported(q, CurrState))
+            {
+                // The queue cannot transition the resource out of its current state. Transition it on
+                // the queue that used the resource last or on any graphics queue, and hand it over.
+                auto HandoffQueue = Res.LastWriteQueue;
+                if (HandoffQueue == InvalidQueueIndex || !IsStateSupported(HandoffQueue, CurrState) || !IsStateSupported(HandoffQueue, Access.State))
+                    HandoffQueue = FindQueue(COMMAND_QUEUE_TYPE_GRAPHICS);
+
+                if (HandoffQueue != InvalidQueueIndex)
+                {
+                    auto& Handoff{m_Queues[HandoffQueue]};
+                    WaitForOtherAccesses(HandoffQueue, Res, true);
+
+                    ++Handoff.LastValue;
+                    const auto Barrier = GetBarrier(Res, Access.State);
+                    Handoff.pContext->TransitionResourceStates(1, &Barrier);
+                    Handoff.HasPendingWork = true;
+
+                    Res.LastAccessValues[HandoffQueue] = Handoff.LastValue;
+                    Res.LastWriteQueue                 = HandoffQueue;
+                    Res.LastWriteValue                 = Handoff.LastValue;
+
+                    ++m_Stats.NumBarriers;
+                    ++m_Stats.NumHandoffBarriers;
+                    NeedTransition = false;
+                }
+                else
+                {
+                    LOG_ERROR_MESSAGE("Submission '", Submission.Name, "' uses resource '", Res.pResource->GetDesc().Name,
+                                      "' that is in state ", GetResourceStateString(CurrState),
+                                      ", which is not supported by the submission queue, and there is no graphics queue to transition it");
+                }
+            }
+
+            const auto Exclusive = Access.Write || NeedTransition;
+            WaitForOtherAccesses(q, Res, Exclusive);
+
+            if (NeedTransition)
+                m_Barriers.emplace_back(GetBarrier(Res, Access.State));
+
+            Res.LastAccessValues[q] = Value;
+            if (Exclusive)
+            {
+                Res.LastWriteQueue = q;
+                Res.LastWriteValue = Value;
+            }
+        }
+
+        Queue.LastValue = Value;
+        if (!m_Barriers.empty())
+        {
+            Queue.pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+            m_Stats.NumBarriers += static_cast<Uint32>(m_Barriers.size());
+        }
+        if (Submission.Execute)
+            Submission.Execute(Queue.pContext);
+        Queue.HasPendingWork = true;
+
+        ++m_Stats.NumSubmissions;
+    }
+    m_Submissions.clear();
+
+    // Submit the work of all queues except the first one, which the application keeps using.
+    // The signal on the first queue is only enqueued and becomes pending when the application
+    // flushes the context. It lets the scheduler release resources that are no longer in use.
+    for (QueueIndex q = 0; q < m_Queues.size(); ++q)
+    {
+        auto& Queue{m_Queues[q]};
+        if (q > 0)
+        {
+            if (Queue.LastSignaledValue < Queue.LastValue)
+                SignalAndFlush(q);
+        }
+        else if (Queue.LastEnqueuedValue < Queue.LastValue)
+        {
+            Queue.pContext->EnqueueSignal(Queue.pFence, Queue.LastValue);
+            Queue.LastEnqueuedValue = Queue.LastValue;
+            ++m_Stats.NumSignals;
+        }
+    }
+
+    ReleaseCompletedResources();
+    m_Stats.NumTrackedResources = static_cast<Uint32>(m_Resources.size());
+}
+
+void AsyncComputeScheduler::ReleaseCompletedResources()
+{
+    std::vector<Uint64> CompletedValues(m_Queues.size());
+    for (QueueIndex q = 0; q < m_Queues.size(); ++q)
+        CompletedValues[q] = m_Queues[q].pFence->GetCompletedValue();
+
+    for (auto it = m_Resources.begin(); it != m_Resources.end();)
+    {
+        const auto& Res = it->second;
+
+        bool IsCompleted = true;
+        for (QueueIndex q = 0; q < m_Queues.size() && IsCompleted; ++q)
+            IsCompleted = Res.LastAccessValues[q] <= CompletedValues[q];
+
+        if (IsCompleted)
+            it = m_Resources.erase(it);
+        else
+            ++it;
+    }
+}
+
+void AsyncComputeScheduler::FinishFrame()
+{
+    for (auto& Queue : m_Queues)
+        Queue.pContext->FinishFrame();
+}
+
+void AsyncComputeScheduler::WaitForIdle()
+{
+    for (auto& Queue : m_Queues)
+    {
+        Queue.pContext->WaitForIdle();
+        Queue.HasPendingWork = false;
+    }
+    // There are no accesses in flight
+    m_Resources.clear();
+}
+
+} // namespace Diligent
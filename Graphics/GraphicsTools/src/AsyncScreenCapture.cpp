@@ -0,0 +1,454 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncScreenCapture.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+// clang-format off
+static const char* g_ScreenCaptureConvertSource =
+{
+    #include "../shaders/ScreenCaptureConvert_inc.h"
+};
+// clang-format on
+
+namespace
+{
+
+// Must match the value in ScreenCaptureConvert.csh
+constexpr Uint32 ThreadGroupSize = 8;
+
+struct ShaderConstants
+{
+    Uint32 Width;
+    Uint32 Height;
+    Uint32 Stride0;
+    Uint32 ChromaStride;
+    Uint32 UOffset;
+    Uint32 VOffset;
+    Uint32 Padding0;
+    Uint32 Padding1;
+};
+
+inline Uint32 DivCeil(Uint32 Num, Uint32 Denom)
+{
+    return (Num + Denom - 1) / Denom;
+}
+
+} // namespace
+
+AsyncScreenCapture::AsyncScreenCapture(IRenderDevice* pDevice, const AsyncScreenCaptureCreateInfo& CI) :
+    m_CI{CI},
+    m_pDevice{pDevice},
+    m_Slots(std::max(CI.RingSize, 1u))
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_CI.Format < ASYNC_SCREEN_CAPTURE_FORMAT_COUNT, "Unexpected capture format");
+    DEV_CHECK_ERR(m_CI.Callback, "Frame callback must not be null");
+
+    FenceDesc fenceDesc;
+    fenceDesc.Name = "Async screen capture fence";
+    m_pDevice->CreateFence(fenceDesc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create async screen capture fence");
+
+    BufferDesc CBDesc;
+    CBDesc.Name           = "Async screen capture constants";
+    CBDesc.uiSizeInBytes  = sizeof(ShaderConstants);
+    CBDesc.Usage          = USAGE_DYNAMIC;
+    CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create async screen capture constant buffer");
+
+    m_pThreadPool = m_CI.pThreadPool;
+    if (!m_pThreadPool)
+    {
+        ThreadPoolCreateInfo PoolCI;
+        PoolCI.NumThreads = m_CI.NumWorkerThreads;
+        CreateThreadPool(PoolCI, &m_pThreadPool);
+        if (!m_pThreadPool)
+            LOG_ERROR_AND_THROW("Failed to create async screen capture thread pool");
+    }
+}
+
+AsyncScreenCapture::~AsyncScreenCapture()
+{
+    // Wait for the callbacks that are still running
+    WaitForCallbacks();
+
+    for (const auto& Slot : m_Slots)
+    {
+        if (Slot.State.load() != SLOT_STATE_FREE && Slot.State.load() != SLOT_STATE_PENDING)
+        {
+            LOG_ERROR_MESSAGE("Async screen capture is destroyed while readback buffers are mapped. Call Finish() before destroying the object.");
+            break;
+        }
+    }
+}
+
+bool AsyncScreenCapture::CreatePipeline(bool ConvertToSRGB)
+{
+    const auto IsYUV = m_CI.Format == ASYNC_SCREEN_CAPTURE_FORMAT_YUV420;
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro(IsYUV ? "CONVERT_YUV420" : "CONVERT_RGBA8", 1);
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
+    Macros.AddShaderMacro("CONVERT_TO_SRGB", ConvertToSRGB ? 1 : 0);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name       = "Async screen capture conversion CS";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source          = g_ScreenCaptureConvertSource;
+    ShaderCI.EntryPoint      = IsYUV ? "ConvertYUV420CS" : "ConvertRGBA8CS";
+    ShaderCI.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return false;
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Async screen capture conversion PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    // Source texture and output buffer may change between captures
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+    ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}};
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+    auto& pPSO = m_pPSO[ConvertToSRGB ? 1 : 0];
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+        return false;
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pConstants);
+    pPSO->CreateShaderResourceBinding(&m_pSRB[ConvertToSRGB ? 1 : 0], true);
+    return m_pSRB[ConvertToSRGB ? 1 : 0] != nullptr;
+}
+
+void AsyncScreenCapture::PrepareFrame(ReadbackSlot& Slot, Uint32 Width, Uint32 Height, Uint32 FrameId)
+{
+    auto& Frame = Slot.Frame;
+
+    Frame.Id     = FrameId;
+    Frame.Width  = Width;
+    Frame.Height = Height;
+    Frame.Format = m_CI.Format;
+
+    Uint32 DataSize = 0;
+    if (m_CI.Format == ASYNC_SCREEN_CAPTURE_FORMAT_YUV420)
+    {
+        const auto PaddedWidth  = AlignUp(Width, 8u);
+        const auto PaddedHeight = AlignUp(Height, 2u);
+        const auto LumaSize     = PaddedWidth * PaddedHeight;
+        const auto ChromaSize   = (PaddedWidth / 2) * (PaddedHeight / 2);
+
+        Frame.NumPlanes  = 3;
+        Frame.Strides[0] = PaddedWidth;
+        Frame.Strides[1] = PaddedWidth / 2;
+        Frame.Strides[2] = PaddedWidth / 2;
+        Slot.PlaneOffsets[0] = 0;
+        Slot.PlaneOffsets[1] = LumaSize;
+        Slot.PlaneOffsets[2] = LumaSize + ChromaSize;
+
+        DataSize = LumaSize + ChromaSize * 2;
+    }
+    else
+    {
+        Frame.NumPlanes  = 1;
+        Frame.Strides[0] = Width * 4;
+        Frame.Strides[1] = 0;
+        Frame.Strides[2] = 0;
+        Slot.PlaneOffsets[0] = 0;
+        Slot.PlaneOffsets[1] = 0;
+        Slot.PlaneOffsets[2] = 0;
+
+        DataSize = Width * 4 * Height;
+    }
+
+    if (!m_pOutputBuffer || m_pOutputBuffer->GetDesc().uiSizeInBytes < DataSize)
+    {
+        // The old buffer is released when the GPU is done with it
+        m_pOutputBuffer.Release();
+        m_pOutputUAV.Release();
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Async screen capture output buffer";
+        BuffDesc.uiSizeInBytes     = DataSize;
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+        m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pOutputBuffer);
+        VERIFY_EXPR(m_pOutputBuffer);
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.Name                 = "Async screen capture output buffer UAV";
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+        m_pOutputBuffer->CreateView(ViewDesc, &m_pOutputUAV);
+    }
+
+    if (!Slot.pStagingBuffer || Slot.pStagingBuffer->GetDesc().uiSizeInBytes != DataSize)
+    {
+        Slot.pStagingBuffer.Release();
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Async screen capture readback buffer";
+        BuffDesc.uiSizeInBytes  = DataSize;
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        m_pDevice->CreateBuffer(BuffDesc, nullptr, &Slot.pStagingBuffer);
+        VERIFY_EXPR(Slot.pStagingBuffer);
+    }
+}
+
+bool AsyncScreenCapture::Capture(IDeviceContext* pContext, ITexture* pTexture, Uint32 FrameId)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pTexture != nullptr, "Texture must not be null");
+
+    const auto& TexDesc = pTexture->GetDesc();
+    DEV_CHECK_ERR(TexDesc.Type == RESOURCE_DIM_TEX_2D, "Only 2D textures can be captured");
+    DEV_CHECK_ERR(TexDesc.SampleCount == 1, "Multisampled textures must be resolved before they are captured");
+
+    Update(pContext);
+
+    auto SlotIt = std::find_if(m_Slots.begin(), m_Slots.end(),
+                               [](const ReadbackSlot& Slot) { return Slot.State.load(std::memory_order_acquire) == SLOT_STATE_FREE; });
+    if (SlotIt == m_Slots.end())
+    {
+        ++m_NumDroppedFrames;
+        return false;
+    }
+    auto& Slot = *SlotIt;
+
+    const auto ConvertToSRGB = GetTextureFormatAttribs(TexDesc.Format).ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+    const auto PSOIdx        = ConvertToSRGB ? 1 : 0;
+    if (!m_pPSO[PSOIdx] && !CreatePipeline(ConvertToSRGB))
+    {
+        LOG_ERROR_MESSAGE("Failed to create async screen capture conversion pipeline");
+        return false;
+    }
+
+    ITextureView* pSourceSRV = nullptr;
+    if ((TexDesc.BindFlags & BIND_SHADER_RESOURCE) != 0 && TexDesc.MipLevels == 1 && TexDesc.ArraySize == 1)
+    {
+        pSourceSRV = pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    }
+    else
+    {
+        if (m_pIntermediateTexture)
+        {
+            const auto& InterDesc = m_pIntermediateTexture->GetDesc();
+            if (InterDesc.Width != TexDesc.Width || InterDesc.Height != TexDesc.Height || InterDesc.Format != TexDesc.Format)
+                m_pIntermediateTexture.Release();
+        }
+        if (!m_pIntermediateTexture)
+        {
+            TextureDesc InterDesc;
+            InterDesc.Name      = "Async screen capture intermediate texture";
+            InterDesc.Type      = RESOURCE_DIM_TEX_2D;
+            InterDesc.Width     = TexDesc.Width;
+            InterDesc.Height    = TexDesc.Height;
+            InterDesc.Format    = TexDesc.Format;
+            InterDesc.Usage     = USAGE_DEFAULT;
+            InterDesc.BindFlags = BIND_SHADER_RESOURCE;
+            m_pDevice->CreateTexture(InterDesc, nullptr, &m_pIntermediateTexture);
+            if (!m_pIntermediateTexture)
+            {
+                LOG_ERROR_MESSAGE("Failed to create async screen capture intermediate texture");
+                return false;
+            }
+        }
+
+        CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, m_pIntermediateTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pSourceSRV = m_pIntermediateTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    }
+    VERIFY_EXPR(pSourceSRV != nullptr);
+
+    PrepareFrame(Slot, TexDesc.Width, TexDesc.Height, FrameId);
+    const auto& Frame = Slot.Frame;
+
+    DispatchComputeAttribs DispatchAttribs;
+    {
+        MapHelper<ShaderConstants> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->Width   = Frame.Width;
+        Constants->Height  = Frame.Height;
+        Constants->Stride0 = Frame.Strides[0];
+        if (Frame.Format == ASYNC_SCREEN_CAPTURE_FORMAT_YUV420)
+        {
+            Constants->ChromaStride = Frame.Strides[1];
+            Constants->UOffset      = Slot.PlaneOffsets[1];
+            Constants->VOffset      = Slot.PlaneOffsets[2];
+
+            // Every thread processes an 8x2 block of pixels
+            DispatchAttribs.ThreadGroupCountX = DivCeil(DivCeil(Frame.Width, 8), ThreadGroupSize);
+            DispatchAttribs.ThreadGroupCountY = DivCeil(DivCeil(Frame.Height, 2), ThreadGroupSize);
+        }
+        else
+        {
+            Constants->ChromaStride = 0;
+            Constants->UOffset      = 0;
+            Constants->VOffset      = 0;
+
+            DispatchAttribs.ThreadGroupCountX = DivCeil(Frame.Width, ThreadGroupSize);
+            DispatchAttribs.ThreadGroupCountY = DivCeil(Frame.Height, ThreadGroupSize);
+        }
+        Constants->Padding0 = 0;
+        Constants->Padding1 = 0;
+    }
+
+    auto* pSRB = m_pSRB[PSOIdx].RawPtr();
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Source")->Set(pSourceSRV);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(m_pOutputUAV);
+
+    pContext->SetPipelineState(m_pPSO[PSOIdx]);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchAttribs);
+
+    pContext->CopyBuffer(m_pOutputBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         Slot.pStagingBuffer, 0, Slot.pStagingBuffer->GetDesc().uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Slot.FenceValue = m_NextFenceValue++;
+    pContext->EnqueueSignal(m_pFence, Slot.FenceValue);
+
+    Slot.State.store(SLOT_STATE_PENDING, std::memory_order_relaxed);
+    m_PendingSlots.push_back(static_cast<Uint32>(SlotIt - m_Slots.begin()));
+
+    return true;
+}
+
+bool AsyncScreenCapture::CaptureSwapChain(IDeviceContext* pContext, ISwapChain* pSwapChain, Uint32 FrameId)
+{
+    DEV_CHECK_ERR(pSwapChain != nullptr, "Swap chain must not be null");
+    auto* pCurrentRTV = pSwapChain->GetCurrentBackBufferRTV();
+    return Capture(pContext, pCurrentRTV->GetTexture(), FrameId);
+}
+
+void AsyncScreenCapture::RecycleProcessedSlots(IDeviceContext* pContext)
+{
+    for (auto& Slot : m_Slots)
+    {
+        if (Slot.State.load(std::memory_order_acquire) == SLOT_STATE_PROCESSED)
+        {
+            pContext->UnmapBuffer(Slot.pStagingBuffer, MAP_READ);
+            for (auto& pPlane : Slot.Frame.pPlanes)
+                pPlane = nullptr;
+            Slot.State.store(SLOT_STATE_FREE, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncScreenCapture::DispatchCompletedSlots(IDeviceContext* pContext)
+{
+    const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+    while (!m_PendingSlots.empty())
+    {
+        auto& Slot = m_Slots[m_PendingSlots.front()];
+        if (Slot.FenceValue > CompletedFenceValue)
+            break;
+
+        // The copy has completed, so mapping does not stall. Direct3D11 may still report
+        // the buffer as busy, in which case we will try again on the next update.
+        void* pData = nullptr;
+        pContext->MapBuffer(Slot.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        if (pData == nullptr)
+            break;
+
+        auto& Frame = Slot.Frame;
+        for (Uint32 p = 0; p < _countof(Frame.pPlanes); ++p)
+            Frame.pPlanes[p] = p < Frame.NumPlanes ? static_cast<const Uint8*>(pData) + Slot.PlaneOffsets[p] : nullptr;
+
+        Slot.State.store(SLOT_STATE_PROCESSING, std::memory_order_relaxed);
+        m_PendingSlots.pop_front();
+
+        {
+            std::lock_guard<std::mutex> Lock{m_CallbacksMtx};
+            ++m_NumPendingCallbacks;
+        }
+
+        // Thread pool synchronization makes the frame data visible to the worker
+        EnqueueTask(m_pThreadPool,
+                    [this, &Slot]() {
+                        m_CI.Callback(Slot.Frame);
+                        Slot.State.store(SLOT_STATE_PROCESSED, std::memory_order_release);
+
+                        // Notify under the lock as the object may be destroyed as soon as the counter reaches zero
+                        std::lock_guard<std::mutex> Lock{m_CallbacksMtx};
+                        if (--m_NumPendingCallbacks == 0)
+                            m_CallbacksDoneCV.notify_all();
+                    });
+    }
+}
+
+void AsyncScreenCapture::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    RecycleProcessedSlots(pContext);
+    DispatchCompletedSlots(pContext);
+}
+
+void AsyncScreenCapture::Finish(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    pContext->Flush();
+    m_pFence->Wait(m_NextFenceValue - 1);
+
+    DispatchCompletedSlots(pContext);
+    VERIFY(m_PendingSlots.empty(), "All pending slots are expected to be dispatched after the fence has been signaled");
+
+    WaitForCallbacks();
+    RecycleProcessedSlots(pContext);
+}
+
+void AsyncScreenCapture::WaitForCallbacks()
+{
+    // Other tasks of a shared pool are not waited for
+    std::unique_lock<std::mutex> Lock{m_CallbacksMtx};
+    m_CallbacksDoneCV.wait(Lock, [this]() { return m_NumPendingCallbacks == 0; });
+}
+
+} // namespace Diligent
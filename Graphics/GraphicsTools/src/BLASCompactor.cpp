@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "BLASCompactor.hpp"
+
+#include <limits>
+#include <string>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+BLASCompactor::BLASCompactor(IRenderDevice* pDevice, const BLASCompactorCreateInfo& CI) :
+    m_CI{CI},
+    m_pDevice{pDevice}
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_CI.Callback, "Compaction callback must not be null");
+    DEV_CHECK_ERR(m_CI.MaxBatchSize != 0, "MaxBatchSize must not be zero");
+
+    if (m_pDevice->GetDeviceInfo().Features.RayTracing == DEVICE_FEATURE_STATE_DISABLED)
+        LOG_ERROR_AND_THROW("Ray tracing is not supported by this device");
+
+    FenceDesc fenceDesc;
+    fenceDesc.Name = "BLAS compactor fence";
+    m_pDevice->CreateFence(fenceDesc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create BLAS compactor fence");
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "BLAS compacted size buffer";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.BindFlags     = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode          = BUFFER_MODE_RAW;
+    BuffDesc.uiSizeInBytes = m_CI.MaxBatchSize * Uint32{sizeof(Uint64)};
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pSizeBuffer);
+    if (!m_pSizeBuffer)
+        LOG_ERROR_AND_THROW("Failed to create BLAS compacted size buffer");
+}
+
+bool BLASCompactor::Enqueue(IBottomLevelAS* pBLAS)
+{
+    DEV_CHECK_ERR(pBLAS != nullptr, "BLAS must not be null");
+
+    const auto& Desc = pBLAS->GetDesc();
+    if ((Desc.Flags & RAYTRACING_BUILD_AS_ALLOW_COMPACTION) == 0)
+    {
+        LOG_WARNING_MESSAGE("BLAS '", Desc.Name, "' can't be compacted as it was not created with RAYTRACING_BUILD_AS_ALLOW_COMPACTION flag");
+        return false;
+    }
+
+    QueuedBLAS Queued;
+    Queued.pBLAS = pBLAS;
+    Queued.Frame = m_FrameCounter;
+    m_Queue.emplace_back(std::move(Queued));
+    return true;
+}
+
+size_t BLASCompactor::GetNumPendingBLASes() const
+{
+    size_t NumPending = m_Queue.size();
+    for (const auto& Batch : m_PendingBatches)
+        NumPending += Batch.BLASes.size();
+    return NumPending;
+}
+
+Uint32 BLASCompactor::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    const auto NumCompacted = CompactCompletedBatches(pContext);
+    QueryCompactedSizes(pContext);
+    ++m_FrameCounter;
+
+    return NumCompacted;
+}
+
+Uint32 BLASCompactor::CompactCompletedBatches(IDeviceContext* pContext)
+{
+    Uint32     NumCompacted        = 0;
+    const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+    while (!m_PendingBatches.empty() && m_PendingBatches.front().FenceValue <= CompletedFenceValue)
+    {
+        auto Batch = std::move(m_PendingBatches.front());
+        m_PendingBatches.pop_front();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(Batch.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        if (pData == nullptr)
+        {
+            UNEXPECTED("Failed to map the staging buffer whose fence has completed");
+            m_PendingBatches.emplace_front(std::move(Batch));
+            break;
+        }
+
+        // Copy the sizes so that the buffer can be unmapped before recording other commands
+        const auto*         pSizes = static_cast<const Uint64*>(pData);
+        std::vector<Uint64> CompactedSizes{pSizes, pSizes + Batch.BLASes.size()};
+        pContext->UnmapBuffer(Batch.pStagingBuffer, MAP_READ);
+
+        for (size_t i = 0; i < Batch.BLASes.size(); ++i)
+        {
+            auto&       pOriginal = Batch.BLASes[i];
+            const auto& SrcDesc   = pOriginal->GetDesc();
+
+            if (CompactedSizes[i] == 0 || CompactedSizes[i] > Uint64{std::numeric_limits<Uint32>::max()})
+            {
+                LOG_ERROR_MESSAGE("Unexpected compacted size (", CompactedSizes[i], ") of BLAS '", SrcDesc.Name, "'");
+                continue;
+            }
+
+            const std::string Name = std::string{SrcDesc.Name} + " (compacted)";
+
+            BottomLevelASDesc DstDesc;
+            DstDesc.Name                 = Name.c_str();
+            DstDesc.CompactedSize        = static_cast<Uint32>(CompactedSizes[i]);
+            DstDesc.ImmediateContextMask = SrcDesc.ImmediateContextMask;
+
+            RefCntAutoPtr<IBottomLevelAS> pCompacted;
+            m_pDevice->CreateBLAS(DstDesc, &pCompacted);
+            if (!pCompacted)
+            {
+                LOG_ERROR_MESSAGE("Failed to create compacted copy of BLAS '", SrcDesc.Name, "'");
+                continue;
+            }
+
+            CopyBLASAttribs CopyAttribs;
+            CopyAttribs.pSrc              = pOriginal;
+            CopyAttribs.pDst              = pCompacted;
+            CopyAttribs.Mode              = COPY_AS_MODE_COMPACT;
+            CopyAttribs.SrcTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            CopyAttribs.DstTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            pContext->CopyBLAS(CopyAttribs);
+
+            m_CI.Callback(pOriginal, pCompacted);
+
+            // The device keeps the original BLAS alive until the GPU has finished the copy
+            pOriginal.Release();
+
+            m_TotalCompactedSize += DstDesc.CompactedSize;
+            ++NumCompacted;
+        }
+
+        m_FreeStagingBuffers.emplace_back(std::move(Batch.pStagingBuffer));
+    }
+
+    return NumCompacted;
+}
+
+void BLASCompactor::QueryCompactedSizes(IDeviceContext* pContext)
+{
+    while (!m_Queue.empty() && m_Queue.front().Frame + m_CI.FrameDelay <= m_FrameCounter)
+    {
+        QueryBatch Batch;
+        if (!m_FreeStagingBuffers.empty())
+        {
+            Batch.pStagingBuffer = std::move(m_FreeStagingBuffers.back());
+            m_FreeStagingBuffers.pop_back();
+        }
+        else
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = "BLAS compacted size staging buffer";
+            BuffDesc.Usage          = USAGE_STAGING;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+            BuffDesc.uiSizeInBytes  = m_CI.MaxBatchSize * Uint32{sizeof(Uint64)};
+            m_pDevice->CreateBuffer(BuffDesc, nullptr, &Batch.pStagingBuffer);
+            if (!Batch.pStagingBuffer)
+            {
+                LOG_ERROR_MESSAGE("Failed to create BLAS compacted size staging buffer");
+                return;
+            }
+        }
+
+        while (!m_Queue.empty() && m_Queue.front().Frame + m_CI.FrameDelay <= m_FrameCounter && Batch.BLASes.size() < m_CI.MaxBatchSize)
+        {
+            WriteBLASCompactedSizeAttribs Attribs;
+            Attribs.pBLAS                = m_Queue.front().pBLAS;
+            Attribs.pDestBuffer          = m_pSizeBuffer;
+            Attribs.DestBufferOffset     = static_cast<Uint32>(Batch.BLASes.size() * sizeof(Uint64));
+            Attribs.BLASTransitionMode   = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            Attribs.BufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            pContext->WriteBLASCompactedSize(Attribs);
+
+            Batch.BLASes.emplace_back(std::move(m_Queue.front().pBLAS));
+            m_Queue.pop_front();
+        }
+
+        const auto CopySize = static_cast<Uint32>(Batch.BLASes.size() * sizeof(Uint64));
+        pContext->CopyBuffer(m_pSizeBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             Batch.pStagingBuffer, 0, CopySize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        Batch.FenceValue = m_NextFenceValue++;
+        pContext->EnqueueSignal(m_pFence, Batch.FenceValue);
+        m_PendingBatches.emplace_back(std::move(Batch));
+    }
+}
+
+} // namespace Diligent
@@ -28,42 +28,210 @@
 #include "BufferSuballocator.h"
 
 #include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <unordered_set>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "DynamicBuffer.hpp"
 #include "VariableSizeAllocationsManager.hpp"
+#include "TLSFAllocationsManager.hpp"
 #include "Align.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Assigns every thread a small index that is unique among the running threads.
+// Indices of finished threads are reused, so that thread pools that are recreated
+// do not exhaust the slab lanes of the suballocators.
+class ThreadSlotRegistry
+{
+public:
+    static ThreadSlotRegistry& Get()
+    {
+        static ThreadSlotRegistry Registry;
+        return Registry;
+    }
+
+    Uint32 Acquire()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (!m_FreeSlots.empty())
+        {
+            auto Slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+            return Slot;
+        }
+        return m_NextSlot++;
+    }
+
+    void Release(Uint32 Slot)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_FreeSlots.push_back(Slot);
+    }
+
+private:
+    std::mutex          m_Mtx;
+    std::vector<Uint32> m_FreeSlots;
+    Uint32              m_NextSlot = 0;
+};
+
+struct ThreadSlot
+{
+    ThreadSlot() :
+        Index{ThreadSlotRegistry::Get().Acquire()}
+    {}
+
+    ~ThreadSlot()
+    {
+        ThreadSlotRegistry::Get().Release(Index);
+    }
+
+    const Uint32 Index;
+};
+
+Uint32 GetThreadSlot()
+{
+    static thread_local ThreadSlot Slot;
+    return Slot.Index;
+}
+
+// Forwards calls to the allocations manager selected by BufferSuballocatorCreateInfo::UseTLSFManager.
+// Both managers use the same Allocation type, so the rest of the suballocator does not depend on the choice.
+// The manager that is not selected is created empty.
+class SubregionManager
+{
+public:
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    SubregionManager(bool UseTLSF, OffsetType MaxSize) :
+        // clang-format off
+        m_UseTLSF   {UseTLSF},
+        m_VarSizeMgr{UseTLSF ? 0 : MaxSize, DefaultRawMemoryAllocator::GetAllocator()},
+        m_TLSFMgr   {UseTLSF ? MaxSize : 0, DefaultRawMemoryAllocator::GetAllocator()}
+    // clang-format on
+    {}
+
+    Allocation Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        return m_UseTLSF ? m_TLSFMgr.Allocate(Size, Alignment) : m_VarSizeMgr.Allocate(Size, Alignment);
+    }
+
+    void Free(Allocation&& Subregion)
+    {
+        if (m_UseTLSF)
+            m_TLSFMgr.Free(std::move(Subregion));
+        else
+            m_VarSizeMgr.Free(std::move(Subregion));
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        if (m_UseTLSF)
+            m_TLSFMgr.Extend(ExtraSize);
+        else
+            m_VarSizeMgr.Extend(ExtraSize);
+    }
+
+    OffsetType GetMaxSize() const { return m_UseTLSF ? m_TLSFMgr.GetMaxSize() : m_VarSizeMgr.GetMaxSize(); }
+    OffsetType GetFreeSize() const { return m_UseTLSF ? m_TLSFMgr.GetFreeSize() : m_VarSizeMgr.GetFreeSize(); }
+
+    bool IsTLSF() const { return m_UseTLSF; }
+
+private:
+    bool                           m_UseTLSF = false;
+    VariableSizeAllocationsManager m_VarSizeMgr;
+    TLSFAllocationsManager         m_TLSFMgr;
+};
+
+// The smallest slab size class
+constexpr Uint32 MinSlabClassBits = 4;
+constexpr Uint32 MinSlabClassSize = 1u << MinSlabClassBits;
+
+} // namespace
+
 class BufferSuballocatorImpl;
 
+// A range of the buffer that serves allocations of a single size class.
+// Only the thread that owns the slab lane allocates from the slab, so the used size
+// is not atomic. Allocations may be released by any thread.
+struct BufferSlab
+{
+    BufferSlab(SubregionManager::Allocation&& _Region, Uint32 _Offset, Uint32 _Size, Uint32 _SlotSize) :
+        // clang-format off
+        Region  {std::move(_Region)},
+        Offset  {_Offset},
+        Size    {_Size},
+        SlotSize{_SlotSize}
+    // clang-format on
+    {}
+
+    SubregionManager::Allocation Region;
+
+    // Slab offset in the buffer. Changes when the buffer is compacted.
+    std::atomic<Uint32> Offset;
+
+    const Uint32 Size;
+    const Uint32 SlotSize;
+
+    Uint32 UsedSize = 0;
+
+    // The number of live allocations plus one for the owning lane
+    std::atomic<Uint32> RefCount{1};
+};
+
 class BufferSuballocationImpl final : public ObjectBase<IBufferSuballocation>
 {
 public:
     using TBase = ObjectBase<IBufferSuballocation>;
-    BufferSuballocationImpl(IReferenceCounters*                          pRefCounters,
-                            BufferSuballocatorImpl*                      pParentAllocator,
-                            Uint32                                       Offset,
-                            Uint32                                       Size,
-                            VariableSizeAllocationsManager::Allocation&& Subregion) :
+    BufferSuballocationImpl(IReferenceCounters*            pRefCounters,
+                            BufferSuballocatorImpl*        pParentAllocator,
+                            Uint32                         Offset,
+                            Uint32                         Size,
+                            Uint32                         Alignment,
+                            SubregionManager::Allocation&& Subregion) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
         VERIFY_EXPR(m_Subregion.IsValid());
     }
 
+    BufferSuballocationImpl(IReferenceCounters*     pRefCounters,
+                            BufferSuballocatorImpl* pParentAllocator,
+                            Uint32                  OffsetInSlab,
+                            Uint32                  Size,
+                            BufferSlab*             pSlab) :
+        // clang-format off
+        TBase             {pRefCounters},
+        m_pParentAllocator{pParentAllocator},
+        m_pSlab           {pSlab},
+        m_Offset          {OffsetInSlab},
+        m_Size            {Size},
+        m_Alignment       {pSlab->SlotSize}
+    // clang-format on
+    {
+        VERIFY_EXPR(m_pParentAllocator);
+        VERIFY_EXPR(m_pSlab != nullptr);
+    }
+
     ~BufferSuballocationImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_BufferSuballocation, TBase)
@@ -82,7 +250,9 @@ public:
 
     virtual Uint32 GetOffset() const override final
     {
-        return m_Offset;
+        return m_pSlab != nullptr ?
+            m_pSlab->Offset.load(std::memory_order_relaxed) + m_Offset.load(std::memory_order_relaxed) :
+            m_Offset.load(std::memory_order_relaxed);
     }
 
     virtual Uint32 GetSize() const override final
@@ -92,6 +262,19 @@ public:
 
     virtual IBufferSuballocator* GetAllocator() override final;
 
+    Uint32 GetAlignment() const
+    {
+        return m_Alignment;
+    }
+
+    // Called by the parent allocator under its lock when the buffer is compacted
+    void Relocate(SubregionManager::Allocation&& NewSubregion, Uint32 NewOffset)
+    {
+        VERIFY_EXPR(m_pSlab == nullptr);
+        m_Subregion = std::move(NewSubregion);
+        m_Offset.store(NewOffset, std::memory_order_relaxed);
+    }
+
     virtual void SetUserData(IObject* pUserData) override final
     {
         m_pUserData = pUserData;
@@ -105,10 +288,16 @@ public:
 private:
     RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
 
-    VariableSizeAllocationsManager::Allocation m_Subregion;
+    SubregionManager::Allocation m_Subregion;
+
+    // Slab the suballocation belongs to, or null if the suballocation owns m_Subregion
+    BufferSlab* const m_pSlab = nullptr;
+
+    // Offset in the buffer, or in the slab if m_pSlab is not null
+    std::atomic<Uint32> m_Offset;
 
-    const Uint32 m_Offset;
     const Uint32 m_Size;
+    const Uint32 m_Alignment;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -125,8 +314,9 @@ public:
                            const BufferSuballocatorCreateInfo& CreateInfo) :
         // clang-format off
         TBase                    {pRefCounters},
-        m_Mgr                    {CreateInfo.Desc.uiSizeInBytes, DefaultRawMemoryAllocator::GetAllocator()},
+        m_Mgr                    {CreateInfo.UseTLSFManager, CreateInfo.Desc.uiSizeInBytes},
         m_Buffer                 {pDevice, CreateInfo.Desc},
+        m_InitialSize            {CreateInfo.Desc.uiSizeInBytes},
         m_ExpansionSize          {CreateInfo.ExpansionSize},
         m_SuballocationsAllocator
         {
@@ -135,7 +325,32 @@ public:
             CreateInfo.SuballocationObjAllocationGranularity
         }
     // clang-format on
-    {}
+    {
+        if (CreateInfo.SlabSize != 0 && CreateInfo.MaxSlabThreads != 0)
+        {
+            const auto MaxAllocSize = std::min(std::max(CreateInfo.MaxSlabAllocationSize, MinSlabClassSize), CreateInfo.SlabSize);
+            if (MaxAllocSize >= MinSlabClassSize)
+            {
+                m_SlabSize       = CreateInfo.SlabSize;
+                m_NumSlabClasses = GetSlabClass(MaxAllocSize);
+                // Drop the last class if its slot size (MaxAllocSize rounded up to a power of two) exceeds the slab size
+                if ((MinSlabClassSize << m_NumSlabClasses) <= m_SlabSize)
+                    ++m_NumSlabClasses;
+                m_NumSlabLanes = CreateInfo.MaxSlabThreads;
+                m_LaneSlabs.resize(size_t{m_NumSlabLanes} * m_NumSlabClasses);
+            }
+        }
+    }
+
+    ~BufferSuballocatorImpl()
+    {
+        // All suballocations keep the allocator alive, so only the lane references remain
+        for (auto* pSlab : m_LaneSlabs)
+        {
+            if (pSlab != nullptr)
+                ReleaseSlab(pSlab);
+        }
+    }
 
     virtual IBuffer* GetBuffer(IRenderDevice* pDevice, IDeviceContext* pContext) override final
     {
@@ -168,43 +383,157 @@ public:
             return;
         }
 
-        VariableSizeAllocationsManager::Allocation Subregion;
+        if (m_NumSlabLanes != 0 && std::max(Size, Alignment) <= (MinSlabClassSize << (m_NumSlabClasses - 1)))
         {
-            std::lock_guard<std::mutex> Lock{m_MgrMtx};
-            Subregion = m_Mgr.Allocate(Size, Alignment);
-
-            while (!Subregion.IsValid())
+            const auto Lane = GetThreadSlot();
+            if (Lane < m_NumSlabLanes)
             {
-                auto ExtraSize = m_ExpansionSize != 0 ?
-                    std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
-                    m_Mgr.GetMaxSize();
-
-                m_Mgr.Extend(ExtraSize);
-                Subregion = m_Mgr.Allocate(Size, Alignment);
+                AllocateFromSlab(Lane, Size, Alignment, ppSuballocation);
+                return;
             }
         }
 
-        // clang-format off
-        BufferSuballocationImpl* pSuballocation{
-            NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
-            (
-                this, 
-                AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
-                Size,
-                std::move(Subregion)
-            )
-        };
-        // clang-format on
+        BufferSuballocationImpl* pSuballocation = nullptr;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            auto Subregion = AllocateFromMgr(Size, Alignment);
+
+            // clang-format off
+            pSuballocation =
+                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+                (
+                    this,
+                    AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
+                    Size,
+                    Alignment,
+                    std::move(Subregion)
+                );
+            // clang-format on
+
+            // Live suballocations are tracked so that Compact() can move them
+            m_Suballocations.insert(pSuballocation);
+        }
 
         pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Subregion)
+    void Free(BufferSuballocationImpl* pSuballocation, SubregionManager::Allocation& Subregion)
     {
+        // The subregion is read under the lock as Compact() may have moved it
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
+        m_Suballocations.erase(pSuballocation);
         m_Mgr.Free(std::move(Subregion));
     }
 
+    void ReleaseSlab(BufferSlab* pSlab)
+    {
+        if (pSlab->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            {
+                std::lock_guard<std::mutex> Lock{m_MgrMtx};
+                m_Slabs.erase(pSlab);
+                m_Mgr.Free(std::move(pSlab->Region));
+            }
+            delete pSlab;
+        }
+    }
+
+    virtual void Compact(IRenderDevice* pDevice, IDeviceContext* pContext) override final
+    {
+        DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr, "Compaction requires non-null device and context");
+
+        // Releases wait for the compaction to complete
+        std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+        struct LiveBlock
+        {
+            BufferSuballocationImpl* pSuballocation;
+            BufferSlab*              pSlab;
+
+            Uint32 Offset;
+            Uint32 Size;
+            Uint32 Alignment;
+
+            SubregionManager::Allocation NewRegion;
+        };
+        std::vector<LiveBlock> Blocks;
+        Blocks.reserve(m_Suballocations.size() + m_Slabs.size());
+        for (auto* pSuballocation : m_Suballocations)
+            Blocks.push_back({pSuballocation, nullptr, pSuballocation->GetOffset(), pSuballocation->GetSize(), pSuballocation->GetAlignment(), {}});
+        for (auto* pSlab : m_Slabs)
+            Blocks.push_back({nullptr, pSlab, pSlab->Offset.load(std::memory_order_relaxed), pSlab->Size, pSlab->SlotSize, {}});
+
+        // Place blocks with larger alignment first, so that every block starts at the end of the previous one
+        // without padding. Blocks with the same alignment keep their relative order.
+        std::sort(Blocks.begin(), Blocks.end(),
+                  [](const LiveBlock& lhs, const LiveBlock& rhs) {
+                      return lhs.Alignment != rhs.Alignment ? lhs.Alignment > rhs.Alignment : lhs.Offset < rhs.Offset;
+                  });
+
+        Uint32 UsedSize = 0;
+        for (const auto& Block : Blocks)
+            UsedSize += AlignUp(Block.Size, Block.Alignment);
+        const auto NewSize = std::max(UsedSize, m_InitialSize);
+
+        SubregionManager NewMgr{m_Mgr.IsTLSF(), NewSize};
+
+        bool IsMoved = NewSize != m_Mgr.GetMaxSize();
+
+        std::vector<DynamicBuffer::CopyRange> CopyRanges;
+        CopyRanges.reserve(Blocks.size());
+        for (auto& Block : Blocks)
+        {
+            Block.NewRegion = NewMgr.Allocate(Block.Size, Block.Alignment);
+            VERIFY_EXPR(Block.NewRegion.IsValid());
+            const auto NewOffset = static_cast<Uint32>(Block.NewRegion.UnalignedOffset);
+            VERIFY(NewOffset % Block.Alignment == 0, "The layout is expected to require no padding");
+            if (NewOffset != Block.Offset)
+                IsMoved = true;
+
+            // All blocks are copied as the compacted buffer is a new buffer.
+            // Merge with the previous range if both source and destination are contiguous.
+            if (!CopyRanges.empty() &&
+                CopyRanges.back().SrcOffset + CopyRanges.back().Size == Block.Offset &&
+                CopyRanges.back().DstOffset + CopyRanges.back().Size == NewOffset)
+            {
+                CopyRanges.back().Size += Block.Size;
+            }
+            else
+            {
+                CopyRanges.push_back({Block.Offset, NewOffset, Block.Size});
+            }
+        }
+
+        if (!IsMoved)
+        {
+            // The buffer is already compact
+            for (auto& Block : Blocks)
+                NewMgr.Free(std::move(Block.NewRegion));
+            return;
+        }
+
+        m_Buffer.Remap(pDevice, pContext, NewSize, CopyRanges.data(), static_cast<Uint32>(CopyRanges.size()));
+
+        // Publish new offsets. The buffer version has been incremented by Remap().
+        for (auto& Block : Blocks)
+        {
+            const auto NewOffset = static_cast<Uint32>(Block.NewRegion.UnalignedOffset);
+            if (Block.pSuballocation != nullptr)
+            {
+                Block.pSuballocation->Relocate(std::move(Block.NewRegion), NewOffset);
+            }
+            else
+            {
+                Block.pSlab->Region = std::move(Block.NewRegion);
+                Block.pSlab->Offset.store(NewOffset, std::memory_order_relaxed);
+            }
+        }
+
+        // All live regions now belong to the new manager, so the old one is discarded as is
+        m_Mgr = std::move(NewMgr);
+    }
+
     virtual Uint32 GetVersion() const override final
     {
         return m_Buffer.GetVersion();
@@ -217,20 +546,102 @@ public:
     }
 
 private:
-    std::mutex                     m_MgrMtx;
-    VariableSizeAllocationsManager m_Mgr;
+    // The allocation is performed under m_MgrMtx
+    SubregionManager::Allocation AllocateFromMgr(Uint32 Size, Uint32 Alignment)
+    {
+        auto Subregion = m_Mgr.Allocate(Size, Alignment);
+        while (!Subregion.IsValid())
+        {
+            auto ExtraSize = m_ExpansionSize != 0 ?
+                std::max(m_ExpansionSize, AlignUp(Size, Alignment)) :
+                m_Mgr.GetMaxSize();
+
+            m_Mgr.Extend(ExtraSize);
+            Subregion = m_Mgr.Allocate(Size, Alignment);
+        }
+        return Subregion;
+    }
+
+    static Uint32 GetSlabClass(Uint32 Size)
+    {
+        // Class 0 is MinSlabClassSize, class 1 is 2 * MinSlabClassSize, etc.
+        return Size <= MinSlabClassSize ? 0 : PlatformMisc::GetMSB(Size - 1) + 1 - MinSlabClassBits;
+    }
+
+    void AllocateFromSlab(Uint32 Lane, Uint32 Size, Uint32 Alignment, IBufferSuballocation** ppSuballocation)
+    {
+        // Slot size is a power of two that is not smaller than the alignment, and the slab
+        // offset is aligned by the slot size, so every slot is properly aligned.
+        const auto Class    = GetSlabClass(std::max(Size, Alignment));
+        const auto SlotSize = MinSlabClassSize << Class;
+        VERIFY_EXPR(Class < m_NumSlabClasses && SlotSize <= m_SlabSize);
+
+        // The lane is only accessed by the thread that owns it
+        auto*& pSlab = m_LaneSlabs[size_t{Lane} * m_NumSlabClasses + Class];
+        if (pSlab == nullptr || pSlab->UsedSize + SlotSize > pSlab->Size)
+        {
+            if (pSlab != nullptr)
+            {
+                ReleaseSlab(pSlab);
+                pSlab = nullptr;
+            }
+
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            auto       Region = AllocateFromMgr(m_SlabSize, SlotSize);
+            const auto Offset = AlignUp(static_cast<Uint32>(Region.UnalignedOffset), SlotSize);
+            pSlab             = new BufferSlab{std::move(Region), Offset, m_SlabSize, SlotSize};
+            m_Slabs.insert(pSlab);
+        }
+
+        const auto OffsetInSlab = pSlab->UsedSize;
+        pSlab->UsedSize += SlotSize;
+        pSlab->RefCount.fetch_add(1, std::memory_order_relaxed);
+
+        // clang-format off
+        BufferSuballocationImpl* pSuballocation{
+            NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+            (
+                this,
+                OffsetInSlab,
+                Size,
+                pSlab
+            )
+        };
+        // clang-format on
+
+        pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
+    }
+
+    std::mutex       m_MgrMtx;
+    SubregionManager m_Mgr;
 
     DynamicBuffer m_Buffer;
 
+    const Uint32 m_InitialSize;
     const Uint32 m_ExpansionSize;
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
+
+    Uint32 m_SlabSize       = 0;
+    Uint32 m_NumSlabClasses = 0;
+    Uint32 m_NumSlabLanes   = 0;
+
+    // Current slab of every size class, for every lane
+    std::vector<BufferSlab*> m_LaneSlabs;
+
+    // Live suballocations that do not belong to slabs and all slabs, protected by m_MgrMtx
+    std::unordered_set<BufferSuballocationImpl*> m_Suballocations;
+    std::unordered_set<BufferSlab*>              m_Slabs;
 };
 
 
 BufferSuballocationImpl::~BufferSuballocationImpl()
 {
-    m_pParentAllocator->Free(std::move(m_Subregion));
+    if (m_pSlab != nullptr)
+        m_pParentAllocator->ReleaseSlab(m_pSlab);
+    else
+        m_pParentAllocator->Free(this, m_Subregion);
 }
 
 IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
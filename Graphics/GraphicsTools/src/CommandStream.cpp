@@ -0,0 +1,1173 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CommandStream.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+enum class CMD_TYPE : Uint8
+{
+    SetPipelineState,
+    CommitShaderResources,
+    SetStencilRef,
+    SetBlendFactors,
+    SetVertexBuffers,
+    SetIndexBuffer,
+    SetViewports,
+    SetScissorRects,
+    SetRenderTargets,
+    ClearRenderTarget,
+    ClearDepthStencil,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    DispatchCompute,
+    DispatchComputeIndirect,
+    UpdateBuffer,
+    CopyBuffer,
+    TransitionResourceStates
+};
+
+} // namespace
+
+// Commands are linked into a list since the arena may place them in different blocks
+struct CommandStream::Command
+{
+    Command* pNext = nullptr;
+    CMD_TYPE Type  = CMD_TYPE::SetPipelineState;
+};
+
+namespace
+{
+
+struct CmdSetPipelineState : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetPipelineState;
+
+    IPipelineState* pPSO;
+};
+
+struct CmdCommitShaderResources : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::CommitShaderResources;
+
+    IShaderResourceBinding*        pSRB;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdSetStencilRef : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetStencilRef;
+
+    Uint32 StencilRef;
+};
+
+struct CmdSetBlendFactors : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetBlendFactors;
+
+    float BlendFactors[4];
+    bool  Default;
+};
+
+struct CmdSetVertexBuffers : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetVertexBuffers;
+
+    Uint32                         StartSlot;
+    Uint32                         NumBuffersSet;
+    IBuffer**                      ppBuffers;
+    const Uint32*                  pOffsets;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+    SET_VERTEX_BUFFERS_FLAGS       Flags;
+};
+
+struct CmdSetIndexBuffer : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetIndexBuffer;
+
+    IBuffer*                       pIndexBuffer;
+    Uint32                         ByteOffset;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdSetViewports : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetViewports;
+
+    Uint32          NumViewports;
+    const Viewport* pViewports;
+    Uint32          RTWidth;
+    Uint32          RTHeight;
+};
+
+struct CmdSetScissorRects : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetScissorRects;
+
+    Uint32      NumRects;
+    const Rect* pRects;
+    Uint32      RTWidth;
+    Uint32      RTHeight;
+};
+
+struct CmdSetRenderTargets : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::SetRenderTargets;
+
+    Uint32                         NumRenderTargets;
+    ITextureView**                 ppRenderTargets;
+    ITextureView*                  pDepthStencil;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdClearRenderTarget : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::ClearRenderTarget;
+
+    ITextureView*                  pView;
+    float                          RGBA[4];
+    bool                           Default;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdClearDepthStencil : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::ClearDepthStencil;
+
+    ITextureView*                  pView;
+    CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags;
+    float                          fDepth;
+    Uint8                          Stencil;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdDraw : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::Draw;
+
+    DrawAttribs Attribs;
+};
+
+struct CmdDrawIndexed : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::DrawIndexed;
+
+    DrawIndexedAttribs Attribs;
+};
+
+struct CmdDrawIndirect : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::DrawIndirect;
+
+    DrawIndirectAttribs Attribs;
+    IBuffer*            pAttribsBuffer;
+};
+
+struct CmdDrawIndexedIndirect : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::DrawIndexedIndirect;
+
+    DrawIndexedIndirectAttribs Attribs;
+    IBuffer*                   pAttribsBuffer;
+};
+
+struct CmdDispatchCompute : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::DispatchCompute;
+
+    DispatchComputeAttribs Attribs;
+};
+
+struct CmdDispatchComputeIndirect : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::DispatchComputeIndirect;
+
+    DispatchComputeIndirectAttribs Attribs;
+    IBuffer*                       pAttribsBuffer;
+};
+
+struct CmdUpdateBuffer : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::UpdateBuffer;
+
+    IBuffer*                       pBuffer;
+    Uint32                         Offset;
+    Uint32                         Size;
+    const void*                    pData;
+    RESOURCE_STATE_TRANSITION_MODE Mode;
+};
+
+struct CmdCopyBuffer : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::CopyBuffer;
+
+    IBuffer*                       pSrcBuffer;
+    Uint32                         SrcOffset;
+    RESOURCE_STATE_TRANSITION_MODE SrcMode;
+    IBuffer*                       pDstBuffer;
+    Uint32                         DstOffset;
+    Uint32                         Size;
+    RESOURCE_STATE_TRANSITION_MODE DstMode;
+};
+
+struct CmdTransitionResourceStates : CommandStream::Command
+{
+    static constexpr CMD_TYPE CmdType = CMD_TYPE::TransitionResourceStates;
+
+    Uint32                     BarrierCount;
+    const StateTransitionDesc* pBarriers;
+};
+
+
+// Serialization.
+// The same field lists are used for writing and reading; the archive defines the direction.
+
+inline const INTERFACE_ID& GetObjectIID(IPipelineState*) { return IID_PipelineState; }
+inline const INTERFACE_ID& GetObjectIID(IShaderResourceBinding*) { return IID_ShaderResourceBinding; }
+inline const INTERFACE_ID& GetObjectIID(IBuffer*) { return IID_Buffer; }
+inline const INTERFACE_ID& GetObjectIID(ITextureView*) { return IID_TextureView; }
+inline const INTERFACE_ID& GetObjectIID(IDeviceObject*) { return IID_DeviceObject; }
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, Uint32& Value)
+{
+    Ar(Value);
+}
+
+template <typename ArchiveType, typename ObjectType>
+void SerializeFields(ArchiveType& Ar, ObjectType*& pObject)
+{
+    Ar.Object(pObject);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, Viewport& VP)
+{
+    Ar(VP.TopLeftX, VP.TopLeftY, VP.Width, VP.Height, VP.MinDepth, VP.MaxDepth);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, Rect& R)
+{
+    Ar(R.left, R.top, R.right, R.bottom);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, StateTransitionDesc& Barrier)
+{
+    Ar.Object(Barrier.pResourceBefore);
+    Ar.Object(Barrier.pResource);
+    Ar(Barrier.FirstMipLevel, Barrier.MipLevelsCount, Barrier.FirstArraySlice, Barrier.ArraySliceCount,
+       Barrier.OldState, Barrier.NewState, Barrier.TransitionType, Barrier.UpdateResourceState);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DrawAttribs& Attribs)
+{
+    Ar(Attribs.NumVertices, Attribs.Flags, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DrawIndexedAttribs& Attribs)
+{
+    Ar(Attribs.NumIndices, Attribs.IndexType, Attribs.Flags, Attribs.NumInstances,
+       Attribs.FirstIndexLocation, Attribs.BaseVertex, Attribs.FirstInstanceLocation);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DrawIndirectAttribs& Attribs)
+{
+    Ar(Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset,
+       Attribs.DrawCount, Attribs.DrawArgsStride);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DrawIndexedIndirectAttribs& Attribs)
+{
+    Ar(Attribs.IndexType, Attribs.Flags, Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.IndirectDrawArgsOffset,
+       Attribs.DrawCount, Attribs.DrawArgsStride);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DispatchComputeAttribs& Attribs)
+{
+    Ar(Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ,
+       Attribs.MtlThreadGroupSizeX, Attribs.MtlThreadGroupSizeY, Attribs.MtlThreadGroupSizeZ);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, DispatchComputeIndirectAttribs& Attribs)
+{
+    Ar(Attribs.IndirectAttribsBufferStateTransitionMode, Attribs.DispatchArgsByteOffset,
+       Attribs.MtlThreadGroupSizeX, Attribs.MtlThreadGroupSizeY, Attribs.MtlThreadGroupSizeZ);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetPipelineState& Cmd)
+{
+    Ar.Object(Cmd.pPSO);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdCommitShaderResources& Cmd)
+{
+    Ar.Object(Cmd.pSRB);
+    Ar(Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetStencilRef& Cmd)
+{
+    Ar(Cmd.StencilRef);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetBlendFactors& Cmd)
+{
+    Ar(Cmd.BlendFactors[0], Cmd.BlendFactors[1], Cmd.BlendFactors[2], Cmd.BlendFactors[3], Cmd.Default);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetVertexBuffers& Cmd)
+{
+    Ar(Cmd.StartSlot, Cmd.NumBuffersSet);
+    Ar.Array(Cmd.ppBuffers, Cmd.NumBuffersSet);
+    Ar.Array(Cmd.pOffsets, Cmd.NumBuffersSet);
+    Ar(Cmd.Mode, Cmd.Flags);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetIndexBuffer& Cmd)
+{
+    Ar.Object(Cmd.pIndexBuffer);
+    Ar(Cmd.ByteOffset, Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetViewports& Cmd)
+{
+    Ar(Cmd.NumViewports);
+    Ar.Array(Cmd.pViewports, Cmd.NumViewports);
+    Ar(Cmd.RTWidth, Cmd.RTHeight);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetScissorRects& Cmd)
+{
+    Ar(Cmd.NumRects);
+    Ar.Array(Cmd.pRects, Cmd.NumRects);
+    Ar(Cmd.RTWidth, Cmd.RTHeight);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdSetRenderTargets& Cmd)
+{
+    Ar(Cmd.NumRenderTargets);
+    Ar.Array(Cmd.ppRenderTargets, Cmd.NumRenderTargets);
+    Ar.Object(Cmd.pDepthStencil);
+    Ar(Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdClearRenderTarget& Cmd)
+{
+    Ar.Object(Cmd.pView);
+    Ar(Cmd.RGBA[0], Cmd.RGBA[1], Cmd.RGBA[2], Cmd.RGBA[3], Cmd.Default, Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdClearDepthStencil& Cmd)
+{
+    Ar.Object(Cmd.pView);
+    Ar(Cmd.ClearFlags, Cmd.fDepth, Cmd.Stencil, Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDraw& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDrawIndexed& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDrawIndirect& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+    Ar.Object(Cmd.pAttribsBuffer);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDrawIndexedIndirect& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+    Ar.Object(Cmd.pAttribsBuffer);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDispatchCompute& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdDispatchComputeIndirect& Cmd)
+{
+    SerializeFields(Ar, Cmd.Attribs);
+    Ar.Object(Cmd.pAttribsBuffer);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdUpdateBuffer& Cmd)
+{
+    Ar.Object(Cmd.pBuffer);
+    Ar(Cmd.Offset, Cmd.Size);
+    Ar.Bytes(Cmd.pData, Cmd.Size);
+    Ar(Cmd.Mode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdCopyBuffer& Cmd)
+{
+    Ar.Object(Cmd.pSrcBuffer);
+    Ar(Cmd.SrcOffset, Cmd.SrcMode);
+    Ar.Object(Cmd.pDstBuffer);
+    Ar(Cmd.DstOffset, Cmd.Size, Cmd.DstMode);
+}
+
+template <typename ArchiveType>
+void SerializeFields(ArchiveType& Ar, CmdTransitionResourceStates& Cmd)
+{
+    Ar(Cmd.BarrierCount);
+    Ar.Array(Cmd.pBarriers, Cmd.BarrierCount);
+}
+
+// Calls the handler with a null pointer to the command structure that corresponds to the type
+template <typename HandlerType>
+bool DispatchCommandType(CMD_TYPE Type, HandlerType&& Handler)
+{
+    // clang-format off
+    switch (Type)
+    {
+        case CMD_TYPE::SetPipelineState:         return Handler(static_cast<CmdSetPipelineState*>(nullptr));
+        case CMD_TYPE::CommitShaderResources:    return Handler(static_cast<CmdCommitShaderResources*>(nullptr));
+        case CMD_TYPE::SetStencilRef:            return Handler(static_cast<CmdSetStencilRef*>(nullptr));
+        case CMD_TYPE::SetBlendFactors:          return Handler(static_cast<CmdSetBlendFactors*>(nullptr));
+        case CMD_TYPE::SetVertexBuffers:         return Handler(static_cast<CmdSetVertexBuffers*>(nullptr));
+        case CMD_TYPE::SetIndexBuffer:           return Handler(static_cast<CmdSetIndexBuffer*>(nullptr));
+        case CMD_TYPE::SetViewports:             return Handler(static_cast<CmdSetViewports*>(nullptr));
+        case CMD_TYPE::SetScissorRects:          return Handler(static_cast<CmdSetScissorRects*>(nullptr));
+        case CMD_TYPE::SetRenderTargets:         return Handler(static_cast<CmdSetRenderTargets*>(nullptr));
+        case CMD_TYPE::ClearRenderTarget:        return Handler(static_cast<CmdClearRenderTarget*>(nullptr));
+        case CMD_TYPE::ClearDepthStencil:        return Handler(static_cast<CmdClearDepthStencil*>(nullptr));
+        case CMD_TYPE::Draw:                     return Handler(static_cast<CmdDraw*>(nullptr));
+        case CMD_TYPE::DrawIndexed:              return Handler(static_cast<CmdDrawIndexed*>(nullptr));
+        case CMD_TYPE::DrawIndirect:             return Handler(static_cast<CmdDrawIndirect*>(nullptr));
+        case CMD_TYPE::DrawIndexedIndirect:      return Handler(static_cast<CmdDrawIndexedIndirect*>(nullptr));
+        case CMD_TYPE::DispatchCompute:          return Handler(static_cast<CmdDispatchCompute*>(nullptr));
+        case CMD_TYPE::DispatchComputeIndirect:  return Handler(static_cast<CmdDispatchComputeIndirect*>(nullptr));
+        case CMD_TYPE::UpdateBuffer:             return Handler(static_cast<CmdUpdateBuffer*>(nullptr));
+        case CMD_TYPE::CopyBuffer:               return Handler(static_cast<CmdCopyBuffer*>(nullptr));
+        case CMD_TYPE::TransitionResourceStates: return Handler(static_cast<CmdTransitionResourceStates*>(nullptr));
+        default:                                 return false;
+    }
+    // clang-format on
+}
+
+class CommandWriter
+{
+public:
+    CommandWriter(std::vector<Uint8>& Data, const CommandStream::GetObjectIdType& GetObjectId) :
+        m_Data{Data},
+        m_GetObjectId{GetObjectId}
+    {}
+
+    template <typename... ArgsType>
+    void operator()(const ArgsType&... Args)
+    {
+        // Write the arguments in order
+        int Dummy[] = {0, (Write(Args), 0)...};
+        (void)Dummy;
+    }
+
+    template <typename ObjectType>
+    void Object(ObjectType* pObject)
+    {
+        Uint32 Id = 0;
+        if (pObject != nullptr)
+        {
+            Id = m_GetObjectId(pObject);
+            if (Id == 0)
+                m_Failed = true;
+        }
+        Write(Id);
+    }
+
+    template <typename ElementType>
+    void Array(ElementType* pElements, Uint32 Count)
+    {
+        Write(pElements != nullptr);
+        if (pElements == nullptr)
+            return;
+
+        // The field lists are shared with the reader and take non-const references, but do not modify the values
+        using ValueType = typename std::remove_const<ElementType>::type;
+        for (Uint32 i = 0; i < Count; ++i)
+            SerializeFields(*this, const_cast<ValueType&>(pElements[i]));
+    }
+
+    void Bytes(const void* pData, Uint32 Size)
+    {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + Size);
+    }
+
+    bool IsFailed() const
+    {
+        return m_Failed;
+    }
+
+private:
+    template <typename T>
+    void Write(const T& Value)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalar values can be written");
+        const auto* pBytes = reinterpret_cast<const Uint8*>(&Value);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + sizeof(T));
+    }
+
+    void Write(bool Value)
+    {
+        Write(static_cast<Uint8>(Value ? 1 : 0));
+    }
+
+    std::vector<Uint8>&                   m_Data;
+    const CommandStream::GetObjectIdType& m_GetObjectId;
+    bool                                  m_Failed = false;
+};
+
+class CommandReader
+{
+public:
+    CommandReader(const void*                          pData,
+                  size_t                               Size,
+                  const CommandStream::GetObjectType&  GetObject,
+                  ArenaAllocator&                      Arena,
+                  std::vector<RefCntAutoPtr<IObject>>& Objects) :
+        m_pCurr{static_cast<const Uint8*>(pData)},
+        m_pEnd{static_cast<const Uint8*>(pData) + Size},
+        m_GetObject{GetObject},
+        m_Arena{Arena},
+        m_Objects{Objects}
+    {}
+
+    template <typename... ArgsType>
+    void operator()(ArgsType&... Args)
+    {
+        // Read the arguments in order
+        int Dummy[] = {0, (Read(Args), 0)...};
+        (void)Dummy;
+    }
+
+    template <typename ObjectType>
+    void Object(ObjectType*& pObject)
+    {
+        pObject = nullptr;
+
+        Uint32 Id = 0;
+        Read(Id);
+        if (Id == 0 || m_Failed)
+            return;
+
+        RefCntAutoPtr<ObjectType> pTypedObject{m_GetObject(Id), GetObjectIID(pObject)};
+        if (!pTypedObject)
+        {
+            m_Failed = true;
+            return;
+        }
+        pObject = pTypedObject;
+        m_Objects.emplace_back(pObject);
+    }
+
+    template <typename ElementType>
+    void Array(ElementType*& pElements, Uint32 Count)
+    {
+        pElements = nullptr;
+
+        bool IsPresent = false;
+        Read(IsPresent);
+        if (!IsPresent || m_Failed)
+            return;
+
+        // Every element takes at least one byte, which rejects malformed counts before allocating the memory
+        if (Count == 0 || Count > GetRemainingSize())
+        {
+            m_Failed = true;
+            return;
+        }
+
+        using ValueType = typename std::remove_const<ElementType>::type;
+
+        auto* pValues = m_Arena.Allocate<ValueType>(Count);
+        for (Uint32 i = 0; i < Count; ++i)
+        {
+            new (pValues + i) ValueType{};
+            SerializeFields(*this, pValues[i]);
+        }
+        pElements = pValues;
+    }
+
+    void Bytes(const void*& pData, Uint32 Size)
+    {
+        pData = nullptr;
+        if (Size == 0 || m_Failed)
+            return;
+
+        if (Size > GetRemainingSize())
+        {
+            m_Failed = true;
+            return;
+        }
+        pData = m_Arena.CopyArray(m_pCurr, Size);
+        m_pCurr += Size;
+    }
+
+    bool IsEnd() const
+    {
+        return m_pCurr == m_pEnd;
+    }
+
+    bool IsFailed() const
+    {
+        return m_Failed;
+    }
+
+private:
+    size_t GetRemainingSize() const
+    {
+        return static_cast<size_t>(m_pEnd - m_pCurr);
+    }
+
+    template <typename T>
+    void Read(T& Value)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Only scalar values can be read");
+        if (m_Failed || sizeof(T) > GetRemainingSize())
+        {
+            m_Failed = true;
+            Value    = T{};
+            return;
+        }
+        memcpy(&Value, m_pCurr, sizeof(T));
+        m_pCurr += sizeof(T);
+    }
+
+    void Read(bool& Value)
+    {
+        Uint8 Byte = 0;
+        Read(Byte);
+        Value = Byte != 0;
+    }
+
+    const Uint8*       m_pCurr;
+    const Uint8* const m_pEnd;
+
+    const CommandStream::GetObjectType&  m_GetObject;
+    ArenaAllocator&                      m_Arena;
+    std::vector<RefCntAutoPtr<IObject>>& m_Objects;
+
+    bool m_Failed = false;
+};
+
+} // namespace
+
+CommandStream::CommandStream(size_t InitialArenaSize) :
+    m_Arena{DefaultRawMemoryAllocator::GetAllocator(), InitialArenaSize}
+{
+}
+
+template <typename CmdType>
+CmdType* CommandStream::AddCommand()
+{
+    auto* pCmd = m_Arena.Allocate<CmdType>();
+    new (pCmd) CmdType{};
+    pCmd->Type = CmdType::CmdType;
+
+    if (m_pLastCmd != nullptr)
+        m_pLastCmd->pNext = pCmd;
+    else
+        m_pFirstCmd = pCmd;
+    m_pLastCmd = pCmd;
+    ++m_CommandCount;
+
+    return pCmd;
+}
+
+void CommandStream::SetPipelineState(IPipelineState* pPSO)
+{
+    auto* pCmd = AddCommand<CmdSetPipelineState>();
+    pCmd->pPSO = AddRef(pPSO);
+}
+
+void CommandStream::CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto* pCmd = AddCommand<CmdCommitShaderResources>();
+    pCmd->pSRB = AddRef(pSRB);
+    pCmd->Mode = StateTransitionMode;
+}
+
+void CommandStream::SetStencilRef(Uint32 StencilRef)
+{
+    auto* pCmd       = AddCommand<CmdSetStencilRef>();
+    pCmd->StencilRef = StencilRef;
+}
+
+void CommandStream::SetBlendFactors(const float* pBlendFactors)
+{
+    auto* pCmd    = AddCommand<CmdSetBlendFactors>();
+    pCmd->Default = pBlendFactors == nullptr;
+    if (pBlendFactors != nullptr)
+        memcpy(pCmd->BlendFactors, pBlendFactors, sizeof(pCmd->BlendFactors));
+}
+
+void CommandStream::SetVertexBuffers(Uint32                         StartSlot,
+                                     Uint32                         NumBuffersSet,
+                                     IBuffer**                      ppBuffers,
+                                     const Uint32*                  pOffsets,
+                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                     SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    auto* pCmd          = AddCommand<CmdSetVertexBuffers>();
+    pCmd->StartSlot     = StartSlot;
+    pCmd->NumBuffersSet = NumBuffersSet;
+    pCmd->ppBuffers     = CopyArray(ppBuffers, NumBuffersSet);
+    pCmd->pOffsets      = CopyArray(pOffsets, NumBuffersSet);
+    pCmd->Mode          = StateTransitionMode;
+    pCmd->Flags         = Flags;
+    if (pCmd->ppBuffers != nullptr)
+    {
+        for (Uint32 i = 0; i < NumBuffersSet; ++i)
+            AddRef(pCmd->ppBuffers[i]);
+    }
+}
+
+void CommandStream::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto* pCmd         = AddCommand<CmdSetIndexBuffer>();
+    pCmd->pIndexBuffer = AddRef(pIndexBuffer);
+    pCmd->ByteOffset   = ByteOffset;
+    pCmd->Mode         = StateTransitionMode;
+}
+
+void CommandStream::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
+{
+    auto* pCmd         = AddCommand<CmdSetViewports>();
+    pCmd->NumViewports = NumViewports;
+    pCmd->pViewports   = CopyArray(pViewports, NumViewports);
+    pCmd->RTWidth      = RTWidth;
+    pCmd->RTHeight     = RTHeight;
+}
+
+void CommandStream::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
+{
+    auto* pCmd     = AddCommand<CmdSetScissorRects>();
+    pCmd->NumRects = NumRects;
+    pCmd->pRects   = CopyArray(pRects, NumRects);
+    pCmd->RTWidth  = RTWidth;
+    pCmd->RTHeight = RTHeight;
+}
+
+void CommandStream::SetRenderTargets(Uint32                         NumRenderTargets,
+                                     ITextureView*                  ppRenderTargets[],
+                                     ITextureView*                  pDepthStencil,
+                                     RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto* pCmd             = AddCommand<CmdSetRenderTargets>();
+    pCmd->NumRenderTargets = NumRenderTargets;
+    pCmd->ppRenderTargets  = CopyArray(ppRenderTargets, NumRenderTargets);
+    pCmd->pDepthStencil    = AddRef(pDepthStencil);
+    pCmd->Mode             = StateTransitionMode;
+    if (pCmd->ppRenderTargets != nullptr)
+    {
+        for (Uint32 i = 0; i < NumRenderTargets; ++i)
+            AddRef(pCmd->ppRenderTargets[i]);
+    }
+}
+
+void CommandStream::ClearRenderTarget(ITextureView* pView, const float* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto* pCmd    = AddCommand<CmdClearRenderTarget>();
+    pCmd->pView   = AddRef(pView);
+    pCmd->Default = RGBA == nullptr;
+    if (RGBA != nullptr)
+        memcpy(pCmd->RGBA, RGBA, sizeof(pCmd->RGBA));
+    pCmd->Mode = StateTransitionMode;
+}
+
+void CommandStream::ClearDepthStencil(ITextureView*                  pView,
+                                      CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags,
+                                      float                          fDepth,
+                                      Uint8                          Stencil,
+                                      RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    auto* pCmd       = AddCommand<CmdClearDepthStencil>();
+    pCmd->pView      = AddRef(pView);
+    pCmd->ClearFlags = ClearFlags;
+    pCmd->fDepth     = fDepth;
+    pCmd->Stencil    = Stencil;
+    pCmd->Mode       = StateTransitionMode;
+}
+
+void CommandStream::Draw(const DrawAttribs& Attribs)
+{
+    AddCommand<CmdDraw>()->Attribs = Attribs;
+}
+
+void CommandStream::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    AddCommand<CmdDrawIndexed>()->Attribs = Attribs;
+}
+
+void CommandStream::DrawIndirect(const DrawIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    auto* pCmd           = AddCommand<CmdDrawIndirect>();
+    pCmd->Attribs        = Attribs;
+    pCmd->pAttribsBuffer = AddRef(pAttribsBuffer);
+}
+
+void CommandStream::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    auto* pCmd           = AddCommand<CmdDrawIndexedIndirect>();
+    pCmd->Attribs        = Attribs;
+    pCmd->pAttribsBuffer = AddRef(pAttribsBuffer);
+}
+
+void CommandStream::DispatchCompute(const DispatchComputeAttribs& Attribs)
+{
+    AddCommand<CmdDispatchCompute>()->Attribs = Attribs;
+}
+
+void CommandStream::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs, IBuffer* pAttribsBuffer)
+{
+    auto* pCmd           = AddCommand<CmdDispatchComputeIndirect>();
+    pCmd->Attribs        = Attribs;
+    pCmd->pAttribsBuffer = AddRef(pAttribsBuffer);
+}
+
+void CommandStream::UpdateBuffer(IBuffer* pBuffer, Uint32 Offset, Uint32 Size, const void* pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    DEV_CHECK_ERR(pData != nullptr || Size == 0, "Update data must not be null");
+
+    auto* pCmd    = AddCommand<CmdUpdateBuffer>();
+    pCmd->pBuffer = AddRef(pBuffer);
+    pCmd->Offset  = Offset;
+    pCmd->Size    = Size;
+    pCmd->pData   = CopyArray(static_cast<const Uint8*>(pData), Size);
+    pCmd->Mode    = StateTransitionMode;
+}
+
+void CommandStream::CopyBuffer(IBuffer*                       pSrcBuffer,
+                               Uint32                         SrcOffset,
+                               RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+                               IBuffer*                       pDstBuffer,
+                               Uint32                         DstOffset,
+                               Uint32                         Size,
+                               RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+{
+    auto* pCmd       = AddCommand<CmdCopyBuffer>();
+    pCmd->pSrcBuffer = AddRef(pSrcBuffer);
+    pCmd->SrcOffset  = SrcOffset;
+    pCmd->SrcMode    = SrcBufferTransitionMode;
+    pCmd->pDstBuffer = AddRef(pDstBuffer);
+    pCmd->DstOffset  = DstOffset;
+    pCmd->Size       = Size;
+    pCmd->DstMode    = DstBufferTransitionMode;
+}
+
+void CommandStream::TransitionResourceStates(Uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
+{
+    auto* pCmd         = AddCommand<CmdTransitionResourceStates>();
+    pCmd->BarrierCount = BarrierCount;
+    pCmd->pBarriers    = CopyArray(pResourceBarriers, BarrierCount);
+    for (Uint32 i = 0; i < BarrierCount; ++i)
+    {
+        AddRef(pResourceBarriers[i].pResource);
+        AddRef(pResourceBarriers[i].pResourceBefore);
+    }
+}
+
+void CommandStream::Replay(IDeviceContext* pContext) const
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    for (const auto* pCmd = m_pFirstCmd; pCmd != nullptr; pCmd = pCmd->pNext)
+    {
+        switch (pCmd->Type)
+        {
+            case CMD_TYPE::SetPipelineState:
+            {
+                const auto& Cmd = static_cast<const CmdSetPipelineState&>(*pCmd);
+                pContext->SetPipelineState(Cmd.pPSO);
+                break;
+            }
+
+            case CMD_TYPE::CommitShaderResources:
+            {
+                const auto& Cmd = static_cast<const CmdCommitShaderResources&>(*pCmd);
+                pContext->CommitShaderResources(Cmd.pSRB, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::SetStencilRef:
+            {
+                const auto& Cmd = static_cast<const CmdSetStencilRef&>(*pCmd);
+                pContext->SetStencilRef(Cmd.StencilRef);
+                break;
+            }
+
+            case CMD_TYPE::SetBlendFactors:
+            {
+                const auto& Cmd = static_cast<const CmdSetBlendFactors&>(*pCmd);
+                pContext->SetBlendFactors(Cmd.Default ? nullptr : Cmd.BlendFactors);
+                break;
+            }
+
+            case CMD_TYPE::SetVertexBuffers:
+            {
+                const auto& Cmd = static_cast<const CmdSetVertexBuffers&>(*pCmd);
+                pContext->SetVertexBuffers(Cmd.StartSlot, Cmd.NumBuffersSet, Cmd.ppBuffers, Cmd.pOffsets, Cmd.Mode, Cmd.Flags);
+                break;
+            }
+
+            case CMD_TYPE::SetIndexBuffer:
+            {
+                const auto& Cmd = static_cast<const CmdSetIndexBuffer&>(*pCmd);
+                pContext->SetIndexBuffer(Cmd.pIndexBuffer, Cmd.ByteOffset, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::SetViewports:
+            {
+                const auto& Cmd = static_cast<const CmdSetViewports&>(*pCmd);
+                pContext->SetViewports(Cmd.NumViewports, Cmd.pViewports, Cmd.RTWidth, Cmd.RTHeight);
+                break;
+            }
+
+            case CMD_TYPE::SetScissorRects:
+            {
+                const auto& Cmd = static_cast<const CmdSetScissorRects&>(*pCmd);
+                pContext->SetScissorRects(Cmd.NumRects, Cmd.pRects, Cmd.RTWidth, Cmd.RTHeight);
+                break;
+            }
+
+            case CMD_TYPE::SetRenderTargets:
+            {
+                const auto& Cmd = static_cast<const CmdSetRenderTargets&>(*pCmd);
+                pContext->SetRenderTargets(Cmd.NumRenderTargets, Cmd.ppRenderTargets, Cmd.pDepthStencil, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::ClearRenderTarget:
+            {
+                const auto& Cmd = static_cast<const CmdClearRenderTarget&>(*pCmd);
+                pContext->ClearRenderTarget(Cmd.pView, Cmd.Default ? nullptr : Cmd.RGBA, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::ClearDepthStencil:
+            {
+                const auto& Cmd = static_cast<const CmdClearDepthStencil&>(*pCmd);
+                pContext->ClearDepthStencil(Cmd.pView, Cmd.ClearFlags, Cmd.fDepth, Cmd.Stencil, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::Draw:
+            {
+                const auto& Cmd = static_cast<const CmdDraw&>(*pCmd);
+                pContext->Draw(Cmd.Attribs);
+                break;
+            }
+
+            case CMD_TYPE::DrawIndexed:
+            {
+                const auto& Cmd = static_cast<const CmdDrawIndexed&>(*pCmd);
+                pContext->DrawIndexed(Cmd.Attribs);
+                break;
+            }
+
+            case CMD_TYPE::DrawIndirect:
+            {
+                const auto& Cmd = static_cast<const CmdDrawIndirect&>(*pCmd);
+                pContext->DrawIndirect(Cmd.Attribs, Cmd.pAttribsBuffer);
+                break;
+            }
+
+            case CMD_TYPE::DrawIndexedIndirect:
+            {
+                const auto& Cmd = static_cast<const CmdDrawIndexedIndirect&>(*pCmd);
+                pContext->DrawIndexedIndirect(Cmd.Attribs, Cmd.pAttribsBuffer);
+                break;
+            }
+
+            case CMD_TYPE::DispatchCompute:
+            {
+                const auto& Cmd = static_cast<const CmdDispatchCompute&>(*pCmd);
+                pContext->DispatchCompute(Cmd.Attribs);
+                break;
+            }
+
+            case CMD_TYPE::DispatchComputeIndirect:
+            {
+                const auto& Cmd = static_cast<const CmdDispatchComputeIndirect&>(*pCmd);
+                pContext->DispatchComputeIndirect(Cmd.Attribs, Cmd.pAttribsBuffer);
+                break;
+            }
+
+            case CMD_TYPE::UpdateBuffer:
+            {
+                const auto& Cmd = static_cast<const CmdUpdateBuffer&>(*pCmd);
+                pContext->UpdateBuffer(Cmd.pBuffer, Cmd.Offset, Cmd.Size, Cmd.pData, Cmd.Mode);
+                break;
+            }
+
+            case CMD_TYPE::CopyBuffer:
+            {
+                const auto& Cmd = static_cast<const CmdCopyBuffer&>(*pCmd);
+                pContext->CopyBuffer(Cmd.pSrcBuffer, Cmd.SrcOffset, Cmd.SrcMode, Cmd.pDstBuffer, Cmd.DstOffset, Cmd.Size, Cmd.DstMode);
+                break;
+            }
+
+            case CMD_TYPE::TransitionResourceStates:
+            {
+                const auto& Cmd = static_cast<const CmdTransitionResourceStates&>(*pCmd);
+                pContext->TransitionResourceStates(Cmd.BarrierCount, Cmd.pBarriers);
+                break;
+            }
+            default:
+                UNEXPECTED("Unexpected command type");
+        }
+    }
+}
+
+bool CommandStream::Serialize(std::vector<Uint8>& Data, const GetObjectIdType& GetObjectId) const
+{
+    const auto InitialSize = Data.size();
+
+    CommandWriter Writer{Data, GetObjectId};
+    for (const auto* pCmd = m_pFirstCmd; pCmd != nullptr && !Writer.IsFailed(); pCmd = pCmd->pNext)
+    {
+        Writer(pCmd->Type);
+        DispatchCommandType(pCmd->Type, [&](auto* pTypeTag) {
+            using CmdType = typename std::remove_pointer<decltype(pTypeTag)>::type;
+            // The field lists take non-const references, but the writer does not modify the command
+            SerializeFields(Writer, const_cast<CmdType&>(static_cast<const CmdType&>(*pCmd)));
+            return true;
+        });
+    }
+
+    if (Writer.IsFailed())
+    {
+        LOG_ERROR_MESSAGE("Failed to serialize the command stream: one of the objects has no id");
+        Data.resize(InitialSize);
+        return false;
+    }
+
+    return true;
+}
+
+bool CommandStream::Deserialize(const void* pData, size_t Size, const GetObjectType& GetObject)
+{
+    DEV_CHECK_ERR(pData != nullptr || Size == 0, "Serialized data must not be null");
+
+    auto* const  pLastCmd     = m_pLastCmd;
+    const auto   CommandCount = m_CommandCount;
+    const size_t NumObjects   = m_Objects.size();
+
+    CommandReader Reader{pData, Size, GetObject, m_Arena, m_Objects};
+
+    bool IsValid = true;
+    while (IsValid && !Reader.IsEnd())
+    {
+        CMD_TYPE Type{};
+        Reader(Type);
+        if (Reader.IsFailed())
+        {
+            IsValid = false;
+            break;
+        }
+
+        // Returns false for unknown command types
+        IsValid = DispatchCommandType(Type, [&](auto* pTypeTag) {
+            using CmdType = typename std::remove_pointer<decltype(pTypeTag)>::type;
+            SerializeFields(Reader, *AddCommand<CmdType>());
+            return !Reader.IsFailed();
+        });
+    }
+
+    if (!IsValid)
+    {
+        // Unlink the decoded commands. Their arena memory is reclaimed by Reset().
+        m_pLastCmd = pLastCmd;
+        if (m_pLastCmd != nullptr)
+            m_pLastCmd->pNext = nullptr;
+        else
+            m_pFirstCmd = nullptr;
+        m_CommandCount = CommandCount;
+        m_Objects.erase(m_Objects.begin() + NumObjects, m_Objects.end());
+        return false;
+    }
+
+    return true;
+}
+
+void CommandStream::Reset()
+{
+    // All commands are trivially destructible, so the arena can simply be reset
+    m_pFirstCmd    = nullptr;
+    m_pLastCmd     = nullptr;
+    m_CommandCount = 0;
+    m_Arena.Reset();
+    m_Objects.clear();
+}
+
+} // namespace Diligent
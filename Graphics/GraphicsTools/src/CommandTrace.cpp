@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "CommandTrace.hpp"
+
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "BasicFileStream.hpp"
+#include "MappedFileStream.hpp"
+#include "Timer.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct CommandTraceHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x52544344; // 'DCTR'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32 Magic      = ExpectedMagic;
+    Uint32 Version    = ExpectedVersion;
+    Uint32 FrameCount = 0;
+    Uint32 Reserved   = 0;
+};
+
+} // namespace
+
+void CommandTraceRecorder::SetObjectId(IObject* pObject, Uint32 Id)
+{
+    DEV_CHECK_ERR(pObject != nullptr, "Object must not be null");
+    DEV_CHECK_ERR(Id != 0, "Zero id is reserved for null objects");
+
+    auto it = m_ObjectIds.find(pObject);
+    if (it == m_ObjectIds.end())
+    {
+        m_ObjectIds.emplace(pObject, Id);
+        m_Objects.emplace_back(pObject);
+    }
+    else
+    {
+        it->second = Id;
+    }
+}
+
+bool CommandTraceRecorder::RecordFrame(const CommandStream& Stream)
+{
+    const auto FrameStart = m_Frames.size();
+
+    // Reserve the space for the frame size
+    m_Frames.resize(FrameStart + sizeof(Uint64));
+    const auto Serialized = Stream.Serialize(m_Frames, [this](IObject* pObject) {
+        auto it = m_ObjectIds.find(pObject);
+        return it != m_ObjectIds.end() ? it->second : Uint32{0};
+    });
+    if (!Serialized)
+    {
+        m_Frames.resize(FrameStart);
+        return false;
+    }
+
+    const Uint64 FrameSize = m_Frames.size() - FrameStart - sizeof(Uint64);
+    memcpy(&m_Frames[FrameStart], &FrameSize, sizeof(FrameSize));
+    ++m_FrameCount;
+
+    return true;
+}
+
+void CommandTraceRecorder::GetTrace(IDataBlob** ppTrace) const
+{
+    DEV_CHECK_ERR(ppTrace != nullptr && *ppTrace == nullptr, "Trace blob pointer must not be null and must not point to an existing object");
+
+    CommandTraceHeader Header;
+    Header.FrameCount = m_FrameCount;
+
+    RefCntAutoPtr<DataBlobImpl> pTrace{MakeNewRCObj<DataBlobImpl>{}(sizeof(Header) + m_Frames.size())};
+
+    auto* pData = static_cast<Uint8*>(pTrace->GetDataPtr());
+    memcpy(pData, &Header, sizeof(Header));
+    if (!m_Frames.empty())
+        memcpy(pData + sizeof(Header), m_Frames.data(), m_Frames.size());
+
+    pTrace->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppTrace));
+}
+
+bool CommandTraceRecorder::Save(const Char* FilePath) const
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+
+    FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open command trace file '", FilePath, "' for writing.");
+        return false;
+    }
+
+    CommandTraceHeader Header;
+    Header.FrameCount = m_FrameCount;
+    if (!File->Write(&Header, sizeof(Header)) || (!m_Frames.empty() && !File->Write(m_Frames.data(), m_Frames.size())))
+    {
+        LOG_ERROR_MESSAGE("Failed to write command trace file '", FilePath, "'.");
+        return false;
+    }
+
+    return true;
+}
+
+void CommandTraceRecorder::Reset()
+{
+    m_Frames.clear();
+    m_FrameCount = 0;
+}
+
+
+
+CommandTracePlayer::CommandTracePlayer(IRenderDevice* pDevice)
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+
+    if (pDevice->GetDeviceInfo().Features.TimestampQueries != DEVICE_FEATURE_STATE_DISABLED)
+    {
+        QueryDesc Desc{QUERY_TYPE_TIMESTAMP};
+        Desc.Name = "Command trace player start timestamp";
+        pDevice->CreateQuery(Desc, &m_pStartTimestamp);
+        Desc.Name = "Command trace player end timestamp";
+        pDevice->CreateQuery(Desc, &m_pEndTimestamp);
+    }
+}
+
+void CommandTracePlayer::SetObject(Uint32 Id, IObject* pObject)
+{
+    DEV_CHECK_ERR(Id != 0, "Zero id is reserved for null objects");
+    m_Objects[Id] = pObject;
+}
+
+bool CommandTracePlayer::Load(const void* pData, size_t Size)
+{
+    m_Frames.clear();
+
+    CommandTraceHeader Header;
+    if (pData == nullptr || Size < sizeof(Header))
+    {
+        LOG_ERROR_MESSAGE("Command trace is too small");
+        return false;
+    }
+
+    memcpy(&Header, pData, sizeof(Header));
+    if (Header.Magic != CommandTraceHeader::ExpectedMagic || Header.Version != CommandTraceHeader::ExpectedVersion)
+    {
+        LOG_ERROR_MESSAGE("The data is not a command trace or the trace was recorded by a different version of the engine");
+        return false;
+    }
+
+    const auto GetObject = [this](Uint32 Id) -> IObject* {
+        auto it = m_Objects.find(Id);
+        return it != m_Objects.end() ? it->second.RawPtr() : nullptr;
+    };
+
+    const auto* pCurr = static_cast<const Uint8*>(pData) + sizeof(Header);
+    const auto* pEnd  = static_cast<const Uint8*>(pData) + Size;
+    for (Uint32 Frame = 0; Frame < Header.FrameCount; ++Frame)
+    {
+        Uint64 FrameSize = 0;
+        if (static_cast<size_t>(pEnd - pCurr) < sizeof(FrameSize))
+            break;
+        memcpy(&FrameSize, pCurr, sizeof(FrameSize));
+        pCurr += sizeof(FrameSize);
+        if (FrameSize > static_cast<Uint64>(pEnd - pCurr))
+            break;
+
+        std::unique_ptr<CommandStream> pStream{new CommandStream{}};
+        if (!pStream->Deserialize(pCurr, static_cast<size_t>(FrameSize), GetObject))
+        {
+            LOG_ERROR_MESSAGE("Failed to decode frame ", Frame, " of the command trace. The data is malformed or the trace uses an object that is not registered.");
+            m_Frames.clear();
+            return false;
+        }
+        pCurr += FrameSize;
+        m_Frames.emplace_back(std::move(pStream));
+    }
+
+    if (m_Frames.size() != Header.FrameCount || pCurr != pEnd)
+    {
+        LOG_ERROR_MESSAGE("Command trace is truncated or malformed");
+        m_Frames.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool CommandTracePlayer::Load(const Char* FilePath)
+{
+    DEV_CHECK_ERR(FilePath != nullptr, "File path must not be null");
+
+    // Decoding copies the commands, so the mapping is only needed while the trace is loaded
+    RefCntAutoPtr<IFileStream> pFile{MakeNewRCObj<MappedFileStream>()(FilePath)};
+    if (!pFile->IsValid())
+        pFile = MakeNewRCObj<BasicFileStream>()(FilePath, EFileAccessMode::Read);
+    if (!pFile->IsValid())
+    {
+        LOG_ERROR_MESSAGE("Failed to open command trace file '", FilePath, "'.");
+        return false;
+    }
+
+    RefCntAutoPtr<IDataBlob> pTrace;
+    pFile->ReadBlob2(&pTrace);
+    if (!pTrace)
+    {
+        LOG_ERROR_MESSAGE("Failed to read command trace file '", FilePath, "'.");
+        return false;
+    }
+
+    return Load(pTrace->GetConstDataPtr(), pTrace->GetSize());
+}
+
+CommandTracePlayer::FrameStats CommandTracePlayer::ReplayFrame(IDeviceContext* pContext, Uint32 FrameIndex)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(FrameIndex < m_Frames.size(), "Frame index (", FrameIndex, ") is out of range. The trace contains ", m_Frames.size(), " frames.");
+
+    FrameStats Stats;
+
+    const auto UseTimestamps = m_pStartTimestamp && m_pEndTimestamp;
+    if (UseTimestamps)
+        pContext->EndQuery(m_pStartTimestamp);
+
+    Timer CPUTimer;
+    m_Frames[FrameIndex]->Replay(pContext);
+    Stats.CPUTime = CPUTimer.GetElapsedTime();
+
+    if (UseTimestamps)
+        pContext->EndQuery(m_pEndTimestamp);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+
+    if (UseTimestamps)
+    {
+        QueryDataTimestamp StartData;
+        QueryDataTimestamp EndData;
+        if (m_pStartTimestamp->GetData(&StartData, sizeof(StartData)) &&
+            m_pEndTimestamp->GetData(&EndData, sizeof(EndData)) &&
+            StartData.Frequency != 0 && EndData.Frequency != 0)
+        {
+            Stats.GPUTime =
+                static_cast<double>(EndData.Counter) / static_cast<double>(EndData.Frequency) -
+                static_cast<double>(StartData.Counter) / static_cast<double>(StartData.Frequency);
+        }
+    }
+
+    return Stats;
+}
+
+} // namespace Diligent
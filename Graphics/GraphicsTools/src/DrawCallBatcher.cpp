@@ -0,0 +1,394 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DrawCallBatcher.hpp"
+
+#include <algorithm>
+
+#include "MapHelper.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Layouts of the indirect draw arguments, see DrawIndirectAttribs and DrawIndexedIndirectAttribs
+struct DrawIndirectArgs
+{
+    Uint32 NumVertices;
+    Uint32 NumInstances;
+    Uint32 StartVertexLocation;
+    Uint32 FirstInstanceLocation;
+};
+static_assert(sizeof(DrawIndirectArgs) == 16, "Unexpected size of indirect draw arguments");
+
+struct DrawIndexedIndirectArgs
+{
+    Uint32 NumIndices;
+    Uint32 NumInstances;
+    Uint32 FirstIndexLocation;
+    Uint32 BaseVertex;
+    Uint32 FirstInstanceLocation;
+};
+static_assert(sizeof(DrawIndexedIndirectArgs) == 20, "Unexpected size of indexed indirect draw arguments");
+
+Uint32 GetVerticesPerPrimitive(PRIMITIVE_TOPOLOGY Topology)
+{
+    switch (Topology)
+    {
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_LIST: return 3;
+        case PRIMITIVE_TOPOLOGY_POINT_LIST: return 1;
+        case PRIMITIVE_TOPOLOGY_LINE_LIST: return 2;
+
+        case PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+        case PRIMITIVE_TOPOLOGY_LINE_STRIP:
+        case PRIMITIVE_TOPOLOGY_UNDEFINED:
+            return 0;
+
+        default:
+            if (Topology >= PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST && Topology <= PRIMITIVE_TOPOLOGY_32_CONTROL_POINT_PATCHLIST)
+                return 1 + (Topology - PRIMITIVE_TOPOLOGY_1_CONTROL_POINT_PATCHLIST);
+            return 0;
+    }
+}
+
+bool HasDynamicVariables(IShaderResourceBinding* pSRB)
+{
+    const auto* pSignature = pSRB->GetPipelineResourceSignature();
+    if (pSignature == nullptr)
+        return true;
+
+    const auto& SignDesc = pSignature->GetDesc();
+    for (Uint32 r = 0; r < SignDesc.NumResources; ++r)
+    {
+        if (SignDesc.Resources[r].VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+DrawCallBatcher::DrawCallBatcher(IRenderDevice* pDevice, IDeviceContext* pContext, const DrawCallBatcherCreateInfo& CI) :
+    // clang-format off
+    m_pDevice             {pDevice},
+    m_pContext            {pContext},
+    m_MaxDrawsPerBatch    {CI.MaxDrawsPerBatch},
+    m_UseMultiDrawIndirect{CI.UseMultiDrawIndirect && m_MaxDrawsPerBatch > 1}
+// clang-format on
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    DEV_CHECK_ERR(m_pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(m_MaxDrawsPerBatch != 0, "MaxDrawsPerBatch must not be zero");
+
+    if (!m_UseMultiDrawIndirect)
+        return;
+
+    const auto& DrawCmdProps = m_pDevice->GetAdapterInfo().DrawCommand;
+    if ((DrawCmdProps.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT) == 0)
+    {
+        // Emulated multi-draw is no better than individual draw calls
+        m_UseMultiDrawIndirect = false;
+        return;
+    }
+    if (DrawCmdProps.MaxDrawIndirectCount != 0)
+        m_MaxDrawsPerBatch = std::min(m_MaxDrawsPerBatch, DrawCmdProps.MaxDrawIndirectCount);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Draw call batcher indirect args buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.BindFlags      = BIND_INDIRECT_DRAW_ARGS;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    BuffDesc.uiSizeInBytes  = m_MaxDrawsPerBatch * Uint32{sizeof(DrawIndexedIndirectArgs)};
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_pIndirectArgsBuffer);
+    if (!m_pIndirectArgsBuffer)
+        LOG_ERROR_AND_THROW("Failed to create draw call batcher indirect args buffer");
+}
+
+DrawCallBatcher::~DrawCallBatcher()
+{
+    DEV_CHECK_ERR(m_PendingDraws.empty() && m_PendingIndexedDraws.empty(),
+                  "Draw call batcher is destroyed with pending draws. Call Flush() to issue them.");
+}
+
+void DrawCallBatcher::SetPipelineState(IPipelineState* pPSO)
+{
+    if (m_pPSO == pPSO)
+    {
+        ++m_Stats.NumSkippedStateChanges;
+        return;
+    }
+
+    Flush();
+    m_pContext->SetPipelineState(pPSO);
+    m_pPSO = pPSO;
+    // Resources must be committed again after the pipeline has been changed
+    m_pSRB.Release();
+
+    m_VerticesPerPrimitive = 0;
+    if (pPSO != nullptr && pPSO->GetDesc().IsAnyGraphicsPipeline())
+        m_VerticesPerPrimitive = GetVerticesPerPrimitive(pPSO->GetGraphicsPipelineDesc().PrimitiveTopology);
+}
+
+void DrawCallBatcher::CommitShaderResources(IShaderResourceBinding* pSRB, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (pSRB != nullptr && m_pSRB == pSRB && !m_SRBHasDynamicVars)
+    {
+        ++m_Stats.NumSkippedStateChanges;
+        return;
+    }
+
+    Flush();
+    m_pContext->CommitShaderResources(pSRB, StateTransitionMode);
+    m_pSRB              = pSRB;
+    m_SRBHasDynamicVars = pSRB != nullptr && HasDynamicVariables(pSRB);
+}
+
+void DrawCallBatcher::SetVertexBuffers(Uint32                         StartSlot,
+                                       Uint32                         NumBuffersSet,
+                                       IBuffer**                      ppBuffers,
+                                       const Uint32*                  pOffsets,
+                                       RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+                                       SET_VERTEX_BUFFERS_FLAGS       Flags)
+{
+    DEV_CHECK_ERR(StartSlot + NumBuffersSet <= MAX_BUFFER_SLOTS, "Too many vertex buffer slots");
+
+    const bool Reset = (Flags & SET_VERTEX_BUFFERS_FLAG_RESET) != 0;
+
+    std::array<IBuffer*, MAX_BUFFER_SLOTS> NewBuffers = {};
+    std::array<Uint32, MAX_BUFFER_SLOTS>   NewOffsets = {};
+
+    Uint32 NumBuffers = StartSlot + NumBuffersSet;
+    if (!Reset)
+    {
+        for (Uint32 slot = 0; slot < m_NumVertexBuffers; ++slot)
+        {
+            NewBuffers[slot] = m_VertexBuffers[slot];
+            NewOffsets[slot] = m_VertexBufferOffsets[slot];
+        }
+        NumBuffers = std::max(NumBuffers, m_NumVertexBuffers);
+    }
+    for (Uint32 i = 0; i < NumBuffersSet; ++i)
+    {
+        NewBuffers[StartSlot + i] = ppBuffers != nullptr ? ppBuffers[i] : nullptr;
+        NewOffsets[StartSlot + i] = pOffsets != nullptr ? pOffsets[i] : 0;
+    }
+
+    // Buffers whose state must be transitioned are always forwarded to the context
+    bool IsRedundant = NumBuffers == m_NumVertexBuffers && StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    for (Uint32 slot = 0; slot < NumBuffers && IsRedundant; ++slot)
+        IsRedundant = m_VertexBuffers[slot] == NewBuffers[slot] && m_VertexBufferOffsets[slot] == NewOffsets[slot];
+
+    if (IsRedundant)
+    {
+        ++m_Stats.NumSkippedStateChanges;
+        return;
+    }
+
+    Flush();
+    m_pContext->SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
+    for (Uint32 slot = 0; slot < std::max(NumBuffers, m_NumVertexBuffers); ++slot)
+    {
+        m_VertexBuffers[slot]       = NewBuffers[slot];
+        m_VertexBufferOffsets[slot] = NewOffsets[slot];
+    }
+    m_NumVertexBuffers = NumBuffers;
+}
+
+void DrawCallBatcher::SetIndexBuffer(IBuffer* pIndexBuffer, Uint32 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+{
+    if (m_pIndexBuffer == pIndexBuffer && m_IndexBufferOffset == ByteOffset &&
+        StateTransitionMode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+    {
+        ++m_Stats.NumSkippedStateChanges;
+        return;
+    }
+
+    Flush();
+    m_pContext->SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+    m_pIndexBuffer      = pIndexBuffer;
+    m_IndexBufferOffset = ByteOffset;
+}
+
+bool DrawCallBatcher::CanAppendDraw(const DrawAttribs& Attribs) const
+{
+    if (m_PendingDraws.empty())
+        return false;
+
+    const auto& Last = m_PendingDraws.back();
+    // clang-format off
+    return m_VerticesPerPrimitive != 0                                               &&
+           Last.Flags                 == Attribs.Flags                                &&
+           Last.NumInstances          == Attribs.NumInstances                         &&
+           Last.FirstInstanceLocation == Attribs.FirstInstanceLocation                &&
+           Last.StartVertexLocation + Last.NumVertices == Attribs.StartVertexLocation &&
+           (Last.NumVertices % m_VerticesPerPrimitive) == 0;
+    // clang-format on
+}
+
+bool DrawCallBatcher::CanAppendDrawIndexed(const DrawIndexedAttribs& Attribs) const
+{
+    if (m_PendingIndexedDraws.empty())
+        return false;
+
+    const auto& Last = m_PendingIndexedDraws.back();
+    // clang-format off
+    return m_VerticesPerPrimitive != 0                                               &&
+           Last.Flags                 == Attribs.Flags                                &&
+           Last.IndexType             == Attribs.IndexType                            &&
+           Last.BaseVertex            == Attribs.BaseVertex                           &&
+           Last.NumInstances          == Attribs.NumInstances                         &&
+           Last.FirstInstanceLocation == Attribs.FirstInstanceLocation                &&
+           Last.FirstIndexLocation + Last.NumIndices == Attribs.FirstIndexLocation    &&
+           (Last.NumIndices % m_VerticesPerPrimitive) == 0;
+    // clang-format on
+}
+
+void DrawCallBatcher::Draw(const DrawAttribs& Attribs)
+{
+    ++m_Stats.NumRecordedDraws;
+
+    if (!m_PendingIndexedDraws.empty())
+        Flush();
+
+    if (CanAppendDraw(Attribs))
+    {
+        m_PendingDraws.back().NumVertices += Attribs.NumVertices;
+        ++m_Stats.NumMergedDraws;
+        return;
+    }
+
+    // Draws with different flags can't be issued by one indirect call
+    if (!m_PendingDraws.empty() &&
+        (!m_UseMultiDrawIndirect || m_PendingDraws.size() >= m_MaxDrawsPerBatch || m_PendingDraws.back().Flags != Attribs.Flags))
+    {
+        Flush();
+    }
+    m_PendingDraws.push_back(Attribs);
+}
+
+void DrawCallBatcher::DrawIndexed(const DrawIndexedAttribs& Attribs)
+{
+    ++m_Stats.NumRecordedDraws;
+
+    if (!m_PendingDraws.empty())
+        Flush();
+
+    if (CanAppendDrawIndexed(Attribs))
+    {
+        m_PendingIndexedDraws.back().NumIndices += Attribs.NumIndices;
+        ++m_Stats.NumMergedDraws;
+        return;
+    }
+
+    if (!m_PendingIndexedDraws.empty())
+    {
+        const auto& Last = m_PendingIndexedDraws.back();
+        if (!m_UseMultiDrawIndirect || m_PendingIndexedDraws.size() >= m_MaxDrawsPerBatch ||
+            Last.Flags != Attribs.Flags || Last.IndexType != Attribs.IndexType)
+        {
+            Flush();
+        }
+    }
+    m_PendingIndexedDraws.push_back(Attribs);
+}
+
+void DrawCallBatcher::Flush()
+{
+    if (m_PendingDraws.size() == 1)
+    {
+        m_pContext->Draw(m_PendingDraws[0]);
+        ++m_Stats.NumDrawCalls;
+    }
+    else if (m_PendingDraws.size() > 1)
+    {
+        VERIFY_EXPR(m_pIndirectArgsBuffer && m_PendingDraws.size() <= m_MaxDrawsPerBatch);
+
+        const auto NumDraws = static_cast<Uint32>(m_PendingDraws.size());
+        {
+            MapHelper<DrawIndirectArgs> Args{m_pContext, m_pIndirectArgsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            for (Uint32 i = 0; i < NumDraws; ++i)
+            {
+                const auto& Draw = m_PendingDraws[i];
+                Args[i]          = {Draw.NumVertices, Draw.NumInstances, Draw.StartVertexLocation, Draw.FirstInstanceLocation};
+            }
+        }
+        // Dynamic buffers are always in the indirect argument state
+        DrawIndirectAttribs IndirectAttribs{m_PendingDraws[0].Flags, RESOURCE_STATE_TRANSITION_MODE_VERIFY, 0, NumDraws, Uint32{sizeof(DrawIndirectArgs)}};
+        m_pContext->DrawIndirect(IndirectAttribs, m_pIndirectArgsBuffer);
+        ++m_Stats.NumMultiDrawCalls;
+    }
+    m_PendingDraws.clear();
+
+    if (m_PendingIndexedDraws.size() == 1)
+    {
+        m_pContext->DrawIndexed(m_PendingIndexedDraws[0]);
+        ++m_Stats.NumDrawCalls;
+    }
+    else if (m_PendingIndexedDraws.size() > 1)
+    {
+        VERIFY_EXPR(m_pIndirectArgsBuffer && m_PendingIndexedDraws.size() <= m_MaxDrawsPerBatch);
+
+        const auto NumDraws = static_cast<Uint32>(m_PendingIndexedDraws.size());
+        {
+            MapHelper<DrawIndexedIndirectArgs> Args{m_pContext, m_pIndirectArgsBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            for (Uint32 i = 0; i < NumDraws; ++i)
+            {
+                const auto& Draw = m_PendingIndexedDraws[i];
+                Args[i]          = {Draw.NumIndices, Draw.NumInstances, Draw.FirstIndexLocation, Draw.BaseVertex, Draw.FirstInstanceLocation};
+            }
+        }
+        const auto&                First = m_PendingIndexedDraws[0];
+        DrawIndexedIndirectAttribs IndirectAttribs{First.IndexType, First.Flags, RESOURCE_STATE_TRANSITION_MODE_VERIFY, 0, NumDraws, Uint32{sizeof(DrawIndexedIndirectArgs)}};
+        m_pContext->DrawIndexedIndirect(IndirectAttribs, m_pIndirectArgsBuffer);
+        ++m_Stats.NumMultiDrawCalls;
+    }
+    m_PendingIndexedDraws.clear();
+}
+
+void DrawCallBatcher::InvalidateState()
+{
+    Flush();
+
+    m_pPSO.Release();
+    m_pSRB.Release();
+    m_SRBHasDynamicVars = false;
+    for (Uint32 slot = 0; slot < m_NumVertexBuffers; ++slot)
+    {
+        m_VertexBuffers[slot].Release();
+        m_VertexBufferOffsets[slot] = 0;
+    }
+    m_NumVertexBuffers = 0;
+    m_pIndexBuffer.Release();
+    m_IndexBufferOffset    = 0;
+    m_VerticesPerPrimitive = 0;
+}
+
+} // namespace Diligent
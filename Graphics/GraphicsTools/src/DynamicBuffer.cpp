@@ -30,19 +30,106 @@
 #include <algorithm>
 
 #include "DebugUtilities.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
 
 DynamicBuffer::DynamicBuffer(IRenderDevice* pDevice, const BufferDesc& Desc) :
-    m_Desc{Desc},
-    m_Name{Desc.Name != nullptr ? Desc.Name : "Dynamic buffer"}
+    DynamicBuffer{pDevice, DynamicBufferCreateInfo{Desc}}
+{
+}
+
+DynamicBuffer::DynamicBuffer(IRenderDevice* pDevice, const DynamicBufferCreateInfo& CreateInfo) :
+    m_Desc{CreateInfo.Desc},
+    m_Name{CreateInfo.Desc.Name != nullptr ? CreateInfo.Desc.Name : "Dynamic buffer"},
+    m_VirtualSize{CreateInfo.VirtualSize},
+    m_MemoryPageSize{CreateInfo.MemoryPageSize}
 {
     m_Desc.Name = m_Name.c_str();
     if (m_Desc.uiSizeInBytes > 0 && pDevice != nullptr)
+        CreateBuffer(pDevice);
+}
+
+void DynamicBuffer::CreateBuffer(IRenderDevice* pDevice)
+{
+    VERIFY_EXPR(!m_pBuffer && m_MemoryPages.empty());
+
+    if (m_VirtualSize != 0)
     {
-        pDevice->CreateBuffer(Desc, nullptr, &m_pBuffer);
-        VERIFY_EXPR(m_pBuffer);
+        // Fall back to resizing by copy when the sparse buffer can't be used
+        if (!pDevice->GetDeviceInfo().Features.SparseResources || m_Desc.Usage != USAGE_DEFAULT || m_Desc.uiSizeInBytes > m_VirtualSize)
+            m_VirtualSize = 0;
+    }
+
+    if (m_VirtualSize != 0)
+    {
+        auto SparseDesc          = m_Desc;
+        SparseDesc.uiSizeInBytes = m_VirtualSize;
+        SparseDesc.MiscFlags |= MISC_BUFFER_FLAG_SPARSE;
+        pDevice->CreateBuffer(SparseDesc, nullptr, &m_pBuffer);
+        if (m_pBuffer)
+        {
+            const auto BlockSize = m_pBuffer->GetSparseBlockSize();
+            VERIFY_EXPR(BlockSize > 0);
+            m_MemoryPageSize = AlignUp(std::max(m_MemoryPageSize, BlockSize), BlockSize);
+        }
+        else
+        {
+            LOG_WARNING_MESSAGE("Failed to create sparse buffer for dynamic buffer '", m_Name, "'. The buffer will be resized by copying the contents.");
+            m_VirtualSize = 0;
+        }
+    }
+
+    if (!m_pBuffer)
+        pDevice->CreateBuffer(m_Desc, nullptr, &m_pBuffer);
+    VERIFY_EXPR(m_pBuffer);
+}
+
+void DynamicBuffer::CommitMemoryPages(IRenderDevice*  pDevice,
+                                      IDeviceContext* pContext)
+{
+    if (!IsSparse() || GetCommittedSize() >= m_Desc.uiSizeInBytes || pDevice == nullptr || pContext == nullptr)
+        return;
+
+    const auto BlockSize     = m_pBuffer->GetSparseBlockSize();
+    const auto NumBlocks     = (m_pBuffer->GetDesc().uiSizeInBytes + BlockSize - 1) / BlockSize;
+    const auto BlocksPerPage = m_MemoryPageSize / BlockSize;
+    const auto NumPages      = static_cast<size_t>((m_Desc.uiSizeInBytes + m_MemoryPageSize - 1) / m_MemoryPageSize);
+
+    std::vector<TileMappingRange> Ranges;
+    Ranges.reserve(NumPages - m_MemoryPages.size());
+    while (m_MemoryPages.size() < NumPages)
+    {
+        ResourceHeapDesc HeapDesc;
+        HeapDesc.Name                 = "Dynamic buffer memory page";
+        HeapDesc.Size                 = m_MemoryPageSize;
+        HeapDesc.ImmediateContextMask = m_Desc.ImmediateContextMask;
+
+        RefCntAutoPtr<IResourceHeap> pPage;
+        pDevice->CreateResourceHeap(HeapDesc, &pPage);
+        if (!pPage)
+        {
+            LOG_ERROR_MESSAGE("Failed to allocate memory page for dynamic buffer '", m_Name, "'.");
+            break;
+        }
+
+        TileMappingRange Range;
+        Range.TileX     = static_cast<Uint32>(m_MemoryPages.size()) * BlocksPerPage;
+        Range.NumTilesX = std::min(BlocksPerPage, NumBlocks - Range.TileX);
+        Range.pHeap     = pPage;
+        Ranges.push_back(Range);
+
+        m_MemoryPages.emplace_back(std::move(pPage));
+    }
+
+    if (!Ranges.empty())
+    {
+        UpdateTileMappingsAttribs Attribs;
+        Attribs.pBuffer   = m_pBuffer;
+        Attribs.pRanges   = Ranges.data();
+        Attribs.NumRanges = static_cast<Uint32>(Ranges.size());
+        pContext->UpdateTileMappings(Attribs);
     }
 }
 
@@ -51,17 +138,20 @@ void DynamicBuffer::CommitResize(IRenderDevice*  pDevice,
 {
     if (!m_pBuffer && m_Desc.uiSizeInBytes > 0 && pDevice != nullptr)
     {
-        pDevice->CreateBuffer(m_Desc, nullptr, &m_pBuffer);
-        VERIFY_EXPR(m_pBuffer);
+        CreateBuffer(pDevice);
         ++m_Version;
     }
 
+    // Memory of a new sparse buffer must be committed before the contents is copied
+    CommitMemoryPages(pDevice, pContext);
+
     if (m_pStaleBuffer && m_pBuffer && pContext != nullptr)
     {
         auto CopySize = std::min(m_Desc.uiSizeInBytes, m_pStaleBuffer->GetDesc().uiSizeInBytes);
         pContext->CopyBuffer(m_pStaleBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
                              m_pBuffer, 0, CopySize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
         m_pStaleBuffer.Release();
+        m_StaleMemoryPages.clear();
     }
 }
 
@@ -69,10 +159,26 @@ IBuffer* DynamicBuffer::Resize(IRenderDevice*  pDevice,
                                IDeviceContext* pContext,
                                Uint32          NewSize)
 {
-    if (m_Desc.uiSizeInBytes != NewSize)
+    if (m_Desc.uiSizeInBytes != NewSize && IsSparse() && NewSize > 0 && NewSize <= m_VirtualSize)
     {
+        // The virtual range is already reserved: the buffer object and its contents are preserved,
+        // and memory for the new size is committed by CommitResize().
+        m_Desc.uiSizeInBytes = NewSize;
+    }
+    else if (m_Desc.uiSizeInBytes != NewSize)
+    {
+        if (NewSize > m_VirtualSize)
+        {
+            // The buffer outgrows the virtual range, so the contents must be copied to a new buffer
+            m_VirtualSize = 0;
+        }
+
         if (!m_pStaleBuffer)
-            m_pStaleBuffer = std::move(m_pBuffer);
+        {
+            m_pStaleBuffer     = std::move(m_pBuffer);
+            m_StaleMemoryPages = std::move(m_MemoryPages);
+            m_MemoryPages.clear();
+        }
         else
         {
             DEV_CHECK_ERR(!m_pBuffer || NewSize == 0,
@@ -88,6 +194,8 @@ IBuffer* DynamicBuffer::Resize(IRenderDevice*  pDevice,
         {
             m_pStaleBuffer.Release();
             m_pBuffer.Release();
+            m_StaleMemoryPages.clear();
+            m_MemoryPages.clear();
         }
     }
 
@@ -96,6 +204,48 @@ IBuffer* DynamicBuffer::Resize(IRenderDevice*  pDevice,
     return m_pBuffer;
 }
 
+IBuffer* DynamicBuffer::Remap(IRenderDevice*   pDevice,
+                              IDeviceContext*  pContext,
+                              Uint32           NewSize,
+                              const CopyRange* pRanges,
+                              Uint32           NumRanges)
+{
+    DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr, "Remap requires non-null device and context");
+
+    // Complete pending resize first, so that the existing buffer holds actual contents
+    CommitResize(pDevice, pContext);
+    VERIFY_EXPR(!m_pStaleBuffer);
+
+    RefCntAutoPtr<IBuffer> pSrcBuffer = std::move(m_pBuffer);
+    // Source memory pages must stay alive until the copy commands are recorded
+    auto SrcMemoryPages = std::move(m_MemoryPages);
+    m_MemoryPages.clear();
+
+    m_Desc.uiSizeInBytes = NewSize;
+    if (NewSize > m_VirtualSize)
+        m_VirtualSize = 0;
+    if (NewSize > 0)
+    {
+        CreateBuffer(pDevice);
+        CommitMemoryPages(pDevice, pContext);
+    }
+    ++m_Version;
+
+    if (pSrcBuffer && m_pBuffer)
+    {
+        for (Uint32 i = 0; i < NumRanges; ++i)
+        {
+            const auto& Range = pRanges[i];
+            VERIFY_EXPR(Range.SrcOffset + Range.Size <= pSrcBuffer->GetDesc().uiSizeInBytes);
+            VERIFY_EXPR(Range.DstOffset + Range.Size <= NewSize);
+            pContext->CopyBuffer(pSrcBuffer, Range.SrcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                 m_pBuffer, Range.DstOffset, Range.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+
+    return m_pBuffer;
+}
+
 IBuffer* DynamicBuffer::GetBuffer(IRenderDevice*  pDevice,
                                   IDeviceContext* pContext)
 {
@@ -104,6 +254,9 @@ IBuffer* DynamicBuffer::GetBuffer(IRenderDevice*  pDevice,
     DEV_CHECK_ERR(!m_pStaleBuffer || pContext != nullptr,
                   "An existing contents of the buffer must be copied to the new buffer, but pContext is null. "
                   "Use PendingUpdate() to check if the buffer must be updated.");
+    DEV_CHECK_ERR(!IsSparse() || GetCommittedSize() >= m_Desc.uiSizeInBytes || (pDevice != nullptr && pContext != nullptr),
+                  "Memory pages must be committed to the sparse buffer, but pDevice or pContext is null. "
+                  "Use PendingUpdate() to check if the buffer must be updated.");
     CommitResize(pDevice, pContext);
 
     return m_pBuffer;
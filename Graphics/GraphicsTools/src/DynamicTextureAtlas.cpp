@@ -30,6 +30,8 @@
 #include <mutex>
 #include <algorithm>
 #include <atomic>
+#include <array>
+#include <bitset>
 
 #include "DynamicAtlasManager.hpp"
 #include "ObjectBase.hpp"
@@ -38,6 +40,7 @@
 #include "DefaultRawMemoryAllocator.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -133,7 +136,7 @@ public:
         m_Name            {CreateInfo.Desc.Name != nullptr ? CreateInfo.Desc.Name : "Dynamic texture atlas"},
         m_Granularity     {CreateInfo.TextureGranularity},
         m_ExtraSliceCount {CreateInfo.ExtraSliceCount},
-        m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
+        m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{MaxSliceCount}) : 1},
         m_SuballocationsAllocator
         {
             DefaultRawMemoryAllocator::GetAllocator(),
@@ -168,10 +171,16 @@ public:
 
         m_Desc.Name = m_Name.c_str();
 
+        // Slice managers are never relocated, so that they can be accessed without locking the slice list
+        m_Slices.resize(std::max(m_Desc.ArraySize, m_MaxSliceCount));
         for (Uint32 slice = 0; slice < m_Desc.ArraySize; ++slice)
         {
-            m_Slices.emplace_back(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
+            m_Slices[slice].reset(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
         }
+        m_SliceCount.store(m_Desc.ArraySize);
+
+        for (auto& Hint : m_FirstSliceHints)
+            Hint.store(0);
 
         if (pDevice == nullptr)
             m_Desc.ArraySize = 0;
@@ -189,11 +198,7 @@ public:
 
     virtual ITexture* GetTexture(IRenderDevice* pDevice, IDeviceContext* pContext) override final
     {
-        Uint32 ArraySize = 0;
-        {
-            std::lock_guard<std::mutex> Lock{m_SlicesMtx};
-            ArraySize = static_cast<Uint32>(m_Slices.size());
-        }
+        const Uint32 ArraySize = m_SliceCount.load();
         if (m_Desc.ArraySize != ArraySize)
         {
             DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr,
@@ -255,35 +260,11 @@ public:
             return;
         }
 
-        DynamicAtlasManager::Region Subregion;
+        const Uint32 AlignedWidth  = (Width + m_Granularity - 1) / m_Granularity;
+        const Uint32 AlignedHeight = (Height + m_Granularity - 1) / m_Granularity;
 
-        Uint32 Slice = 0;
-        while (Slice < m_MaxSliceCount)
-        {
-            SliceManager* pSliceMgr = nullptr;
-            {
-                std::lock_guard<std::mutex> Lock{m_SlicesMtx};
-                if (Slice == m_Slices.size())
-                {
-                    const auto ExtraSliceCount = m_ExtraSliceCount != 0 ?
-                        m_ExtraSliceCount :
-                        static_cast<Uint32>(m_Slices.size());
-
-                    for (Uint32 ExtraSlice = 0; ExtraSlice < ExtraSliceCount && Slice + ExtraSlice < m_MaxSliceCount; ++ExtraSlice)
-                    {
-                        m_Slices.emplace_back(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
-                    }
-                }
-                pSliceMgr = m_Slices[Slice].get();
-            }
-
-            Subregion = pSliceMgr->Allocate((Width + m_Granularity - 1) / m_Granularity,
-                                            (Height + m_Granularity - 1) / m_Granularity);
-            if (!Subregion.IsEmpty())
-                break;
-            else
-                ++Slice;
-        }
+        Uint32 Slice     = 0;
+        auto   Subregion = AllocateFromSlices(AlignedWidth, AlignedHeight, Slice);
 
         if (Subregion.IsEmpty())
         {
@@ -308,12 +289,17 @@ public:
 
     virtual void Free(Uint32 Slice, DynamicAtlasManager::Region&& Subregion)
     {
-        SliceManager* pSliceMgr = nullptr;
+        VERIFY_EXPR(Slice < m_SliceCount.load());
+        m_Slices[Slice]->Free(std::move(Subregion));
+
+        // The slice may now have space for any size class
+        for (auto& Hint : m_FirstSliceHints)
         {
-            std::lock_guard<std::mutex> Lock{m_SlicesMtx};
-            pSliceMgr = m_Slices[Slice].get();
+            auto CurrHint = Hint.load();
+            while (!Hint.compare_exchange_weak(CurrHint, PackSliceHint(std::min(UnpackSliceHint(CurrHint), Slice), UnpackHintGeneration(CurrHint) + 1)))
+            {
+            }
         }
-        pSliceMgr->Free(std::move(Subregion));
     }
 
     virtual const TextureDesc& GetAtlasDesc() const override final
@@ -332,6 +318,111 @@ public:
     }
 
 private:
+    // Size classes are defined by the larger region dimension in granularity units, rounded up to the power of two
+    static constexpr Uint32 NumSizeClasses = 16;
+    static constexpr Uint32 MaxSliceCount  = 2048;
+
+    static Uint32 GetSizeClass(Uint32 AlignedWidth, Uint32 AlignedHeight)
+    {
+        const auto MaxDim = std::max(AlignedWidth, AlignedHeight);
+        return std::min(MaxDim > 1 ? PlatformMisc::GetMSB(MaxDim - 1) + 1 : 0, NumSizeClasses - 1);
+    }
+
+    // Slice hints pack the first slice index in the low 16 bits and the generation counter in the high 16 bits.
+    // The generation is incremented every time the hint is moved back, so that a thread that has scanned
+    // the slices using a stale hint can't advance it past a slice where space has just been released.
+    static Uint32 PackSliceHint(Uint32 Slice, Uint32 Generation)
+    {
+        return (Slice & 0xFFFFu) | (Generation << 16u);
+    }
+    static Uint32 UnpackSliceHint(Uint32 Hint)
+    {
+        return Hint & 0xFFFFu;
+    }
+    static Uint32 UnpackHintGeneration(Uint32 Hint)
+    {
+        return Hint >> 16u;
+    }
+
+    DynamicAtlasManager::Region AllocateFromSlices(Uint32 AlignedWidth, Uint32 AlignedHeight, Uint32& Slice)
+    {
+        const auto SizeClass = GetSizeClass(AlignedWidth, AlignedHeight);
+        auto&      FirstHint = m_FirstSliceHints[SizeClass];
+
+        // Fast path: start from the first slice that may have space for this size class
+        // and skip slices that are known to be full. No global lock is taken.
+        const auto StartHint  = FirstHint.load();
+        const auto SliceCount = m_SliceCount.load();
+
+        std::bitset<MaxSliceCount> TriedSlices;
+        for (Slice = UnpackSliceHint(StartHint); Slice < SliceCount; ++Slice)
+        {
+            auto& SliceMgr = *m_Slices[Slice];
+            if (!SliceMgr.MayHaveSpace(SizeClass))
+                continue;
+
+            if (Slice < MaxSliceCount)
+                TriedSlices.set(Slice);
+            auto Subregion = SliceMgr.Allocate(AlignedWidth, AlignedHeight, SizeClass);
+            if (!Subregion.IsEmpty())
+            {
+                // All slices before this one are full for this size class
+                auto Expected = StartHint;
+                FirstHint.compare_exchange_strong(Expected, PackSliceHint(Slice, UnpackHintGeneration(StartHint)));
+                return Subregion;
+            }
+        }
+        {
+            auto Expected = StartHint;
+            FirstHint.compare_exchange_strong(Expected, PackSliceHint(SliceCount, UnpackHintGeneration(StartHint)));
+        }
+
+        // Full hints are conservative per size class (e.g. a failed 16x1 request does not mean
+        // that 1x16 does not fit), so check the skipped slices before growing the array.
+        for (Slice = 0; Slice < SliceCount; ++Slice)
+        {
+            if (Slice < MaxSliceCount && TriedSlices[Slice])
+                continue;
+
+            auto Subregion = m_Slices[Slice]->Allocate(AlignedWidth, AlignedHeight, SizeClass);
+            if (!Subregion.IsEmpty())
+                return Subregion;
+        }
+
+        // Slow path: grow the array
+        while (Slice < m_MaxSliceCount)
+        {
+            if (Slice == m_SliceCount.load())
+            {
+                std::lock_guard<std::mutex> Lock{m_SlicesMtx};
+
+                const auto CurrSliceCount = m_SliceCount.load();
+                if (Slice == CurrSliceCount)
+                {
+                    const auto ExtraSliceCount = m_ExtraSliceCount != 0 ?
+                        m_ExtraSliceCount :
+                        std::max(CurrSliceCount, Uint32{1});
+
+                    Uint32 NewSliceCount = CurrSliceCount;
+                    for (; NewSliceCount < CurrSliceCount + ExtraSliceCount && NewSliceCount < m_MaxSliceCount; ++NewSliceCount)
+                    {
+                        m_Slices[NewSliceCount].reset(new SliceManager{m_Desc.Width / m_Granularity, m_Desc.Height / m_Granularity});
+                    }
+                    // Publish new slices
+                    m_SliceCount.store(NewSliceCount);
+                }
+            }
+
+            auto Subregion = m_Slices[Slice]->Allocate(AlignedWidth, AlignedHeight, SizeClass);
+            if (!Subregion.IsEmpty())
+                return Subregion;
+
+            ++Slice;
+        }
+
+        return {};
+    }
+
     TextureDesc       m_Desc;
     const std::string m_Name;
 
@@ -352,23 +443,45 @@ private:
             Mgr{Width, Height}
         {}
 
-        DynamicAtlasManager::Region Allocate(Uint32 Width, Uint32 Height)
+        // Lock-free occupancy hint: returns false if an allocation of this size class
+        // has failed since the last time a region was released in this slice.
+        bool MayHaveSpace(Uint32 SizeClass) const
+        {
+            return (FullSizeClasses.load(std::memory_order_relaxed) & (1u << SizeClass)) == 0;
+        }
+
+        DynamicAtlasManager::Region Allocate(Uint32 Width, Uint32 Height, Uint32 SizeClass)
         {
             std::lock_guard<std::mutex> Lock{Mtx};
-            return Mgr.Allocate(Width, Height);
+
+            auto Region = Mgr.Allocate(Width, Height);
+            if (Region.IsEmpty())
+                FullSizeClasses.fetch_or(1u << SizeClass, std::memory_order_relaxed);
+            return Region;
         }
         void Free(DynamicAtlasManager::Region&& Region)
         {
             std::lock_guard<std::mutex> Lock{Mtx};
             Mgr.Free(std::move(Region));
+            FullSizeClasses.store(0, std::memory_order_relaxed);
         }
 
     private:
         std::mutex          Mtx;
         DynamicAtlasManager Mgr;
+
+        std::atomic_uint32_t FullSizeClasses{0};
     };
-    std::mutex                                 m_SlicesMtx;
+
+    // Protects slice array growth only
+    std::mutex m_SlicesMtx;
+    // Slice managers are allocated up to m_MaxSliceCount when the array grows.
+    // Slices below m_SliceCount are immutable and can be accessed without locking.
     std::vector<std::unique_ptr<SliceManager>> m_Slices;
+    std::atomic_uint32_t                       m_SliceCount{0};
+
+    // First slice that may have space for each size class
+    std::array<std::atomic_uint32_t, NumSizeClasses> m_FirstSliceHints;
 };
 
 
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "FramePacingHelper.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+FramePacingHelper::FramePacingHelper(IRenderDevice* pDevice, Uint32 NumFramesToAverage) :
+    m_NumFramesToAverage{std::max(NumFramesToAverage, 1u)}
+{
+    DEV_CHECK_ERR(pDevice != nullptr, "Render device must not be null");
+    if (pDevice->GetDeviceInfo().Features.TimestampQueries)
+    {
+        // Queries of a few frames are in flight at any time
+        m_pGPUTimer.reset(new DurationQueryHelper{pDevice, 4});
+    }
+}
+
+void FramePacingHelper::BeginFrame(IDeviceContext* pContext, ISwapChain* pSwapChain)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(!m_FrameStarted, "BeginFrame() has already been called for this frame");
+
+    m_CurrentFrameStats = {};
+
+    const auto WaitStartTime = m_Timer.GetElapsedTime();
+    if (pSwapChain != nullptr)
+        pSwapChain->WaitForFrame();
+    m_FrameStartTime = m_Timer.GetElapsedTime();
+
+    m_CurrentFrameStats.LatencyWaitTime = m_FrameStartTime - WaitStartTime;
+    if (m_PrevFrameStartTime >= 0)
+        m_CurrentFrameStats.FrameInterval = m_FrameStartTime - m_PrevFrameStartTime;
+    m_PrevFrameStartTime = m_FrameStartTime;
+
+    if (m_pGPUTimer)
+        m_pGPUTimer->Begin(pContext);
+
+    m_FrameStarted = true;
+}
+
+void FramePacingHelper::EndFrame(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(m_FrameStarted, "BeginFrame() has not been called for this frame");
+    m_FrameStarted = false;
+
+    m_CurrentFrameStats.CPUFrameTime = m_Timer.GetElapsedTime() - m_FrameStartTime;
+
+    double GPUFrameTime = 0;
+    if (m_pGPUTimer && m_pGPUTimer->End(pContext, GPUFrameTime))
+    {
+        m_GPUHistory.push_back(GPUFrameTime);
+        m_GPUHistorySum += GPUFrameTime;
+        if (m_GPUHistory.size() > m_NumFramesToAverage)
+        {
+            m_GPUHistorySum -= m_GPUHistory.front();
+            m_GPUHistory.pop_front();
+        }
+    }
+    // Report the latest available GPU time
+    m_CurrentFrameStats.GPUFrameTime = !m_GPUHistory.empty() ? m_GPUHistory.back() : 0;
+
+    AddFrameStats(m_CurrentFrameStats);
+}
+
+void FramePacingHelper::AddFrameStats(const FramePacingStats& Stats)
+{
+    m_LastFrameStats = Stats;
+
+    m_History.push_back(Stats);
+    m_HistorySum.CPUFrameTime += Stats.CPUFrameTime;
+    m_HistorySum.LatencyWaitTime += Stats.LatencyWaitTime;
+    m_HistorySum.FrameInterval += Stats.FrameInterval;
+    if (m_History.size() > m_NumFramesToAverage)
+    {
+        const auto& Oldest = m_History.front();
+        m_HistorySum.CPUFrameTime -= Oldest.CPUFrameTime;
+        m_HistorySum.LatencyWaitTime -= Oldest.LatencyWaitTime;
+        m_HistorySum.FrameInterval -= Oldest.FrameInterval;
+        m_History.pop_front();
+    }
+
+    const auto NumFrames = static_cast<double>(m_History.size());
+
+    m_AverageStats.CPUFrameTime    = m_HistorySum.CPUFrameTime / NumFrames;
+    m_AverageStats.LatencyWaitTime = m_HistorySum.LatencyWaitTime / NumFrames;
+    m_AverageStats.FrameInterval   = m_HistorySum.FrameInterval / NumFrames;
+    m_AverageStats.GPUFrameTime    = !m_GPUHistory.empty() ? m_GPUHistorySum / static_cast<double>(m_GPUHistory.size()) : 0;
+}
+
+} // namespace Diligent
@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GPUProfiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+GPUProfiler::GPUProfiler(IRenderDevice* pDevice, const CreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_CI{CI},
+    m_EnableRequested{CI.Enabled}
+{
+    VERIFY_EXPR(m_pDevice != nullptr);
+    if (m_pDevice->GetDeviceInfo().Features.TimestampQueries == DEVICE_FEATURE_STATE_DISABLED)
+    {
+        LOG_WARNING_MESSAGE("Timestamp queries are not supported by this device. GPU profiler will be disabled.");
+    }
+
+    // Frame N is read back when frame N + FrameLatency begins and reuses the same slot
+    m_Frames.resize(std::max(m_CI.FrameLatency, 1u));
+    for (auto& Frame : m_Frames)
+    {
+        Frame.Queries.reserve(size_t{m_CI.NumScopesToReserve} * 2 + 2);
+        Frame.Scopes.reserve(m_CI.NumScopesToReserve);
+    }
+}
+
+void GPUProfiler::BeginFrame(IDeviceContext* pCtx)
+{
+    DEV_CHECK_ERR(m_pCurrFrame == nullptr, "BeginFrame() is called twice without EndFrame()");
+
+    ++m_FrameNumber;
+    auto& Frame = m_Frames[m_FrameNumber % m_Frames.size()];
+    if (Frame.Pending)
+        ResolveFrame(Frame);
+
+    m_Enabled = m_EnableRequested && m_pDevice->GetDeviceInfo().Features.TimestampQueries != DEVICE_FEATURE_STATE_DISABLED;
+    if (!m_Enabled)
+        return;
+
+    Frame.FrameNumber    = m_FrameNumber;
+    Frame.NumQueriesUsed = 0;
+    Frame.Scopes.clear();
+    // Recalibrate every frame as the GPU and CPU clocks drift apart
+    Frame.IsCalibrated = !pCtx->GetDesc().IsDeferred && pCtx->GetTimestampCalibration(Frame.Calibration);
+    m_pCurrFrame       = &Frame;
+
+    WriteTimestamp(pCtx);
+}
+
+void GPUProfiler::EndFrame(IDeviceContext* pCtx)
+{
+    if (m_pCurrFrame == nullptr)
+        return;
+
+    if (!m_ScopeStack.empty())
+    {
+        LOG_ERROR_MESSAGE("GPU profiler: ", m_ScopeStack.size(), " scope(s) have not been ended before the end of the frame. This indicates inconsistent BeginScope()/EndScope() calls.");
+        while (!m_ScopeStack.empty())
+            EndScopeImpl(pCtx);
+    }
+
+    WriteTimestamp(pCtx);
+    m_pCurrFrame->Pending = true;
+    m_pCurrFrame          = nullptr;
+}
+
+Uint32 GPUProfiler::WriteTimestamp(IDeviceContext* pCtx)
+{
+    auto& Frame = *m_pCurrFrame;
+    if (Frame.NumQueriesUsed == Frame.Queries.size())
+    {
+        QueryDesc queryDesc{QUERY_TYPE_TIMESTAMP};
+        queryDesc.Name = "GPU profiler timestamp query";
+
+        RefCntAutoPtr<IQuery> pQuery;
+        m_pDevice->CreateQuery(queryDesc, &pQuery);
+        VERIFY(pQuery, "Failed to create timestamp query");
+        Frame.Queries.emplace_back(std::move(pQuery));
+    }
+
+    pCtx->EndQuery(Frame.Queries[Frame.NumQueriesUsed]);
+    return Frame.NumQueriesUsed++;
+}
+
+void GPUProfiler::BeginScopeImpl(IDeviceContext* pCtx, const Char* Name)
+{
+    if (m_pCurrFrame == nullptr)
+    {
+        DEV_ERROR("BeginScope() must be called between BeginFrame() and EndFrame()");
+        return;
+    }
+
+    if (m_CI.EmitDebugGroups)
+        pCtx->BeginDebugGroup(Name, nullptr);
+
+    auto& Frame = *m_pCurrFrame;
+    m_ScopeStack.push_back(static_cast<Uint32>(Frame.Scopes.size()));
+    Frame.Scopes.emplace_back();
+
+    auto& ScopeRec      = Frame.Scopes.back();
+    ScopeRec.Name       = Name != nullptr ? Name : "";
+    ScopeRec.Depth      = static_cast<Uint32>(m_ScopeStack.size() - 1);
+    ScopeRec.BeginQuery = WriteTimestamp(pCtx);
+}
+
+void GPUProfiler::EndScopeImpl(IDeviceContext* pCtx)
+{
+    if (m_pCurrFrame == nullptr)
+    {
+        DEV_ERROR("EndScope() must be called between BeginFrame() and EndFrame()");
+        return;
+    }
+    if (m_ScopeStack.empty())
+    {
+        LOG_ERROR_MESSAGE("GPU profiler: there are no open scopes, which likely indicates inconsistent BeginScope()/EndScope() calls");
+        return;
+    }
+
+    m_pCurrFrame->Scopes[m_ScopeStack.back()].EndQuery = WriteTimestamp(pCtx);
+    m_ScopeStack.pop_back();
+
+    if (m_CI.EmitDebugGroups)
+        pCtx->EndDebugGroup();
+}
+
+void GPUProfiler::ResolveFrame(FrameData& Frame)
+{
+    VERIFY_EXPR(Frame.Pending && Frame.NumQueriesUsed >= 2);
+    Frame.Pending = false;
+
+    // Read all timestamps of the frame at once. If any of them is not available yet,
+    // the whole frame is dropped rather than stalling the CPU.
+    std::vector<double> Timestamps(Frame.NumQueriesUsed);
+    for (Uint32 i = 0; i < Frame.NumQueriesUsed; ++i)
+    {
+        QueryDataTimestamp TimestampData;
+        if (!Frame.Queries[i]->GetData(&TimestampData, sizeof(TimestampData), false) || TimestampData.Frequency == 0)
+        {
+            LOG_WARNING_MESSAGE("GPU profiler: timestamps of frame ", Frame.FrameNumber, " are not available after ", m_Frames.size(),
+                                " frame(s). The frame is dropped. Consider increasing the frame latency.");
+            for (Uint32 q = 0; q < Frame.NumQueriesUsed; ++q)
+                Frame.Queries[q]->Invalidate();
+            return;
+        }
+        Timestamps[i] = static_cast<double>(TimestampData.Counter) / static_cast<double>(TimestampData.Frequency);
+    }
+    for (Uint32 i = 0; i < Frame.NumQueriesUsed; ++i)
+        Frame.Queries[i]->Invalidate();
+
+    const auto FrameStart = Timestamps.front();
+    if (m_BaseTime < 0)
+        m_BaseTime = FrameStart;
+
+    if (m_ResolvedFrames.size() >= std::max(m_CI.MaxTraceFrames, 1u))
+        m_ResolvedFrames.pop_front();
+    m_ResolvedFrames.emplace_back();
+
+    auto& Timing       = m_ResolvedFrames.back();
+    Timing.FrameNumber = Frame.FrameNumber;
+    Timing.StartTime   = FrameStart - m_BaseTime;
+    Timing.Duration    = Timestamps[Frame.NumQueriesUsed - 1] - FrameStart;
+    if (Frame.IsCalibrated && Frame.Calibration.GPUFrequency != 0)
+    {
+        const auto& Calib   = Frame.Calibration;
+        Timing.CPUStartTime = static_cast<double>(Calib.CPUTime) * 1e-9 + FrameStart - static_cast<double>(Calib.GPUCounter) / static_cast<double>(Calib.GPUFrequency);
+    }
+    Timing.Scopes.reserve(Frame.Scopes.size());
+    for (auto& ScopeRec : Frame.Scopes)
+    {
+        VERIFY_EXPR(ScopeRec.EndQuery < Frame.NumQueriesUsed);
+
+        Timing.Scopes.emplace_back();
+        auto& DstScope     = Timing.Scopes.back();
+        DstScope.Name      = std::move(ScopeRec.Name);
+        DstScope.Depth     = ScopeRec.Depth;
+        DstScope.StartTime = Timestamps[ScopeRec.BeginQuery] - FrameStart;
+        DstScope.Duration  = Timestamps[ScopeRec.EndQuery] - Timestamps[ScopeRec.BeginQuery];
+    }
+}
+
+static void WriteJSONString(std::ostream& Stream, const std::string& Str)
+{
+    Stream << '"';
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            case '"': Stream << "\\\""; break;
+            case '\\': Stream << "\\\\"; break;
+            case '\n': Stream << "\\n"; break;
+            case '\r': Stream << "\\r"; break;
+            case '\t': Stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    Stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    Stream << c;
+        }
+    }
+    Stream << '"';
+}
+
+double GPUProfiler::GetCPUTime()
+{
+    // Calibrated CPU timestamps are sampled on the clock of steady_clock, see TimestampCalibration::CPUTime
+    const auto Now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::duration<double>>(Now).count();
+}
+
+void GPUProfiler::WriteChromeTrace(std::ostream& Stream, bool CPUTimeline) const
+{
+    const auto Flags     = Stream.flags();
+    const auto Precision = Stream.precision();
+    Stream << std::fixed << std::setprecision(3);
+
+    // Complete events ("ph":"X") on the same thread are nested by the viewer based on their time ranges.
+    // Timestamps and durations are in microseconds.
+    bool IsFirstEvent = true;
+    auto WriteEvent   = [&](const std::string& Name, double StartTime, double Duration) {
+        Stream << (IsFirstEvent ? "\n" : ",\n") << "{\"name\":";
+        WriteJSONString(Stream, Name);
+        Stream << ",\"cat\":\"GPU\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << StartTime * 1e6 << ",\"dur\":" << Duration * 1e6 << '}';
+        IsFirstEvent = false;
+    };
+
+    Stream << "{\"traceEvents\":[";
+    for (const auto& Frame : m_ResolvedFrames)
+    {
+        if (CPUTimeline && Frame.CPUStartTime < 0)
+            continue;
+
+        const auto FrameStart = CPUTimeline ? Frame.CPUStartTime : Frame.StartTime;
+        WriteEvent("Frame " + std::to_string(Frame.FrameNumber), FrameStart, Frame.Duration);
+        for (const auto& FrameScope : Frame.Scopes)
+            WriteEvent(FrameScope.Name, FrameStart + FrameScope.StartTime, FrameScope.Duration);
+    }
+    Stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    Stream.flags(Flags);
+    Stream.precision(Precision);
+}
+
+} // namespace Diligent
@@ -0,0 +1,323 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GPUReadback.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Staging buffers are bucketed by power-of-two sizes so that they can be reused for readbacks of different sizes
+Uint32 GetStagingBufferBucketSize(Uint32 Size)
+{
+    constexpr Uint32 MinBucketSize = 256;
+    if (Size <= MinBucketSize)
+        return MinBucketSize;
+    if (IsPowerOfTwo(Size) || Size > (1u << 31u))
+        return Size;
+    return 1u << (PlatformMisc::GetMSB(Size) + 1);
+}
+
+} // namespace
+
+GPUReadback::GPUReadback(IRenderDevice* pDevice, const GPUReadbackCreateInfo& CI) :
+    m_CI{CI},
+    m_pDevice{pDevice}
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+
+    FenceDesc fenceDesc;
+    fenceDesc.Name = "GPU readback fence";
+    m_pDevice->CreateFence(fenceDesc, &m_pFence);
+    if (!m_pFence)
+        LOG_ERROR_AND_THROW("Failed to create GPU readback fence");
+}
+
+RefCntAutoPtr<IBuffer> GPUReadback::AllocateStagingBuffer(Uint32 Size)
+{
+    const auto BucketSize = GetStagingBufferBucketSize(Size);
+
+    auto it = m_FreeBuffers.find(BucketSize);
+    if (it != m_FreeBuffers.end() && !it->second.empty())
+    {
+        auto pBuffer = std::move(it->second.back());
+        it->second.pop_back();
+        m_FreeBuffersSize -= BucketSize;
+        return pBuffer;
+    }
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "GPU readback staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = BucketSize;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    return pBuffer;
+}
+
+RefCntAutoPtr<ITexture> GPUReadback::AllocateStagingTexture(const TextureDesc& Desc)
+{
+    for (auto it = m_FreeTextures.begin(); it != m_FreeTextures.end(); ++it)
+    {
+        const auto& FreeDesc = (*it)->GetDesc();
+        if (FreeDesc.Type == Desc.Type &&
+            FreeDesc.Width == Desc.Width &&
+            FreeDesc.Height == Desc.Height &&
+            FreeDesc.Depth == Desc.Depth &&
+            FreeDesc.Format == Desc.Format)
+        {
+            auto pTexture = std::move(*it);
+            m_FreeTextures.erase(it);
+            return pTexture;
+        }
+    }
+
+    RefCntAutoPtr<ITexture> pTexture;
+    m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+    return pTexture;
+}
+
+void GPUReadback::RecycleStagingResources(PendingReadback& Readback)
+{
+    if (Readback.pStagingBuffer)
+    {
+        const auto BucketSize = Readback.pStagingBuffer->GetDesc().uiSizeInBytes;
+        if (m_FreeBuffersSize + BucketSize <= m_CI.MaxPooledBufferSize)
+        {
+            m_FreeBuffers[BucketSize].emplace_back(std::move(Readback.pStagingBuffer));
+            m_FreeBuffersSize += BucketSize;
+        }
+        Readback.pStagingBuffer.Release();
+    }
+
+    if (Readback.pStagingTexture)
+    {
+        if (m_CI.MaxPooledTextures > 0)
+        {
+            // Release the least recently used texture
+            if (m_FreeTextures.size() >= m_CI.MaxPooledTextures)
+                m_FreeTextures.pop_front();
+            m_FreeTextures.emplace_back(std::move(Readback.pStagingTexture));
+        }
+        Readback.pStagingTexture.Release();
+    }
+}
+
+Uint64 GPUReadback::EnqueueReadback(IDeviceContext* pContext, PendingReadback&& Readback)
+{
+    Readback.Data.Id = m_NextId++;
+    pContext->EnqueueSignal(m_pFence, Readback.Data.Id);
+
+    const auto Id = Readback.Data.Id;
+    m_PendingReadbacks.emplace_back(std::move(Readback));
+    return Id;
+}
+
+Uint64 GPUReadback::ReadbackBuffer(IDeviceContext* pContext,
+                                   IBuffer*        pBuffer,
+                                   Uint32          Offset,
+                                   Uint32          Size,
+                                   CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pBuffer != nullptr, "Buffer must not be null");
+    DEV_CHECK_ERR(Callback, "Readback callback must not be null");
+    DEV_CHECK_ERR(Size != 0, "Readback size must not be zero");
+    DEV_CHECK_ERR(Uint64{Offset} + Uint64{Size} <= Uint64{pBuffer->GetDesc().uiSizeInBytes},
+                  "Readback region [", Offset, ", ", Uint64{Offset} + Uint64{Size}, ") is out of bounds of buffer '",
+                  pBuffer->GetDesc().Name, "' (", pBuffer->GetDesc().uiSizeInBytes, " bytes)");
+
+    PendingReadback Readback;
+    Readback.pStagingBuffer = AllocateStagingBuffer(Size);
+    if (!Readback.pStagingBuffer)
+    {
+        LOG_ERROR_MESSAGE("Failed to create staging buffer to read back buffer '", pBuffer->GetDesc().Name, "'");
+        return 0;
+    }
+
+    pContext->CopyBuffer(pBuffer, Offset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         Readback.pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Readback.Data.Size   = Size;
+    Readback.Data.Width  = Size;
+    Readback.Data.Height = 1;
+    Readback.Data.Depth  = 1;
+    Readback.Callback    = std::move(Callback);
+
+    return EnqueueReadback(pContext, std::move(Readback));
+}
+
+Uint64 GPUReadback::ReadbackTexture(IDeviceContext* pContext,
+                                    ITexture*       pTexture,
+                                    Uint32          MipLevel,
+                                    Uint32          ArraySlice,
+                                    const Box*      pRegion,
+                                    CallbackType    Callback)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pTexture != nullptr, "Texture must not be null");
+    DEV_CHECK_ERR(Callback, "Readback callback must not be null");
+
+    const auto& SrcDesc = pTexture->GetDesc();
+    DEV_CHECK_ERR(MipLevel < SrcDesc.MipLevels, "Mip level ", MipLevel, " is out of range for texture '", SrcDesc.Name, "'");
+    DEV_CHECK_ERR(SrcDesc.SampleCount == 1, "Multisample texture '", SrcDesc.Name, "' can't be read back");
+
+    const auto MipProps = GetMipLevelProperties(SrcDesc, MipLevel);
+
+    Box Region{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight, 0, MipProps.Depth};
+    if (pRegion != nullptr)
+    {
+        DEV_CHECK_ERR(pRegion->MaxX > pRegion->MinX && pRegion->MaxY > pRegion->MinY && pRegion->MaxZ > pRegion->MinZ,
+                      "Readback region of texture '", SrcDesc.Name, "' is empty");
+        DEV_CHECK_ERR(pRegion->MaxX <= MipProps.LogicalWidth && pRegion->MaxY <= MipProps.LogicalHeight && pRegion->MaxZ <= MipProps.Depth,
+                      "Readback region is out of bounds of mip level ", MipLevel, " of texture '", SrcDesc.Name, "'");
+        Region = *pRegion;
+    }
+
+    const bool Is3D = SrcDesc.Type == RESOURCE_DIM_TEX_3D;
+
+    TextureDesc StagingDesc;
+    StagingDesc.Name           = "GPU readback staging texture";
+    StagingDesc.Type           = Is3D ? RESOURCE_DIM_TEX_3D : RESOURCE_DIM_TEX_2D;
+    StagingDesc.Width          = Region.MaxX - Region.MinX;
+    StagingDesc.Height         = Region.MaxY - Region.MinY;
+    StagingDesc.Depth          = Is3D ? Region.MaxZ - Region.MinZ : 1;
+    StagingDesc.Format         = SrcDesc.Format;
+    StagingDesc.MipLevels      = 1;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    PendingReadback Readback;
+    Readback.pStagingTexture = AllocateStagingTexture(StagingDesc);
+    if (!Readback.pStagingTexture)
+    {
+        LOG_ERROR_MESSAGE("Failed to create staging texture to read back texture '", SrcDesc.Name, "'");
+        return 0;
+    }
+
+    CopyTextureAttribs CopyAttribs;
+    CopyAttribs.pSrcTexture              = pTexture;
+    CopyAttribs.SrcMipLevel              = MipLevel;
+    CopyAttribs.SrcSlice                 = Is3D ? 0 : ArraySlice;
+    CopyAttribs.pSrcBox                  = &Region;
+    CopyAttribs.SrcTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    CopyAttribs.pDstTexture              = Readback.pStagingTexture;
+    CopyAttribs.DstTextureTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->CopyTexture(CopyAttribs);
+
+    Readback.Data.Width  = StagingDesc.Width;
+    Readback.Data.Height = StagingDesc.Height;
+    Readback.Data.Depth  = StagingDesc.Depth;
+    Readback.Data.Format = StagingDesc.Format;
+    Readback.Callback    = std::move(Callback);
+
+    return EnqueueReadback(pContext, std::move(Readback));
+}
+
+Uint32 GPUReadback::Update(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    Uint32     NumCompleted        = 0;
+    const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+    while (!m_PendingReadbacks.empty() && m_PendingReadbacks.front().Data.Id <= CompletedFenceValue)
+    {
+        auto& Readback = m_PendingReadbacks.front();
+        auto& Data     = Readback.Data;
+
+        if (Readback.pStagingBuffer)
+        {
+            void* pData = nullptr;
+            pContext->MapBuffer(Readback.pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+            if (pData == nullptr)
+            {
+                UNEXPECTED("Failed to map the staging buffer whose fence has completed");
+                break;
+            }
+            Data.pData = pData;
+            Readback.Callback(Data);
+            pContext->UnmapBuffer(Readback.pStagingBuffer, MAP_READ);
+        }
+        else
+        {
+            VERIFY_EXPR(Readback.pStagingTexture);
+            MappedTextureSubresource MappedData;
+            pContext->MapTextureSubresource(Readback.pStagingTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+            if (MappedData.pData == nullptr)
+            {
+                UNEXPECTED("Failed to map the staging texture whose fence has completed");
+                break;
+            }
+
+            const auto& FmtAttribs = GetTextureFormatAttribs(Data.Format);
+            const auto  NumRows    = FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED ?
+                AlignUp(Data.Height, Uint32{FmtAttribs.BlockHeight}) / FmtAttribs.BlockHeight :
+                Data.Height;
+
+            Data.pData       = MappedData.pData;
+            Data.Stride      = MappedData.Stride;
+            Data.DepthStride = MappedData.DepthStride != 0 ? MappedData.DepthStride : MappedData.Stride * NumRows;
+            Data.Size        = Uint64{Data.DepthStride} * Data.Depth;
+            Readback.Callback(Data);
+            pContext->UnmapTextureSubresource(Readback.pStagingTexture, 0, 0);
+        }
+
+        m_LastCompletedId = Data.Id;
+        RecycleStagingResources(Readback);
+        m_PendingReadbacks.pop_front();
+        ++NumCompleted;
+    }
+
+    return NumCompleted;
+}
+
+void GPUReadback::Finish(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+
+    if (m_PendingReadbacks.empty())
+        return;
+
+    pContext->Flush();
+    m_pFence->Wait(m_NextId - 1);
+
+    Update(pContext);
+    VERIFY(m_PendingReadbacks.empty(), "All pending readbacks are expected to complete after the fence has been signaled");
+}
+
+} // namespace Diligent
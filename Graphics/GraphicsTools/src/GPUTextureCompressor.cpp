@@ -0,0 +1,283 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTextureCompressor.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+// clang-format off
+static const char* g_TextureCompressorSource =
+{
+    #include "../shaders/TextureCompressor_inc.h"
+};
+// clang-format on
+
+namespace
+{
+
+// Must match the value in TextureCompressor.csh
+constexpr Uint32 ThreadGroupSize = 8;
+
+struct ShaderConstants
+{
+    Uint32 Width;
+    Uint32 Height;
+    Uint32 NumBlocksX;
+    Uint32 NumBlocksY;
+};
+
+inline Uint32 DivCeil(Uint32 Num, Uint32 Denom)
+{
+    return (Num + Denom - 1) / Denom;
+}
+
+} // namespace
+
+GPUTextureCompressor::GPUTextureCompressor(IRenderDevice* pDevice) :
+    m_pDevice{pDevice}
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+    if (!m_pDevice->GetDeviceInfo().Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("GPU texture compressor requires compute shaders");
+
+    BufferDesc CBDesc;
+    CBDesc.Name           = "GPU texture compressor constants";
+    CBDesc.uiSizeInBytes  = sizeof(ShaderConstants);
+    CBDesc.Usage          = USAGE_DYNAMIC;
+    CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create GPU texture compressor constant buffer");
+}
+
+bool GPUTextureCompressor::GetKernel(TEXTURE_FORMAT Format, KERNEL& Kernel)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            Kernel = KERNEL_BC1;
+            return true;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            Kernel = KERNEL_BC3;
+            return true;
+
+        case TEX_FORMAT_BC4_UNORM:
+            Kernel = KERNEL_BC4;
+            return true;
+
+        case TEX_FORMAT_BC5_UNORM:
+            Kernel = KERNEL_BC5;
+            return true;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            Kernel = KERNEL_BC7;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool GPUTextureCompressor::IsFormatSupported(TEXTURE_FORMAT Format)
+{
+    KERNEL Kernel;
+    return GetKernel(Format, Kernel);
+}
+
+bool GPUTextureCompressor::CreatePipeline(KERNEL Kernel, bool ConvertToSRGB)
+{
+    static constexpr const char* KernelMacros[] = {"COMPRESS_BC1", "COMPRESS_BC3", "COMPRESS_BC4", "COMPRESS_BC5", "COMPRESS_BC7"};
+    static_assert(_countof(KernelMacros) == KERNEL_COUNT, "Please update the kernel macro list");
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro(KernelMacros[Kernel], 1);
+    Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
+    Macros.AddShaderMacro("CONVERT_TO_SRGB", ConvertToSRGB ? 1 : 0);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.Name       = "GPU texture compressor CS";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source          = g_TextureCompressorSource;
+    ShaderCI.EntryPoint      = "CompressCS";
+    ShaderCI.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pCS;
+    m_pDevice->CreateShader(ShaderCI, &pCS);
+    if (!pCS)
+        return false;
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "GPU texture compressor PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    // Source and output textures change between calls
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+    ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}};
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+    auto& pPSO = m_pPSO[Kernel][ConvertToSRGB ? 1 : 0];
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+        return false;
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pConstants);
+    auto& pSRB = m_pSRB[Kernel][ConvertToSRGB ? 1 : 0];
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    return pSRB != nullptr;
+}
+
+ITexture* GPUTextureCompressor::GetBlockTexture(TEXTURE_FORMAT Format, Uint32 NumBlocksX, Uint32 NumBlocksY)
+{
+    VERIFY_EXPR(Format == TEX_FORMAT_RG32_UINT || Format == TEX_FORMAT_RGBA32_UINT);
+    auto& pTexture = m_pBlockTextures[Format == TEX_FORMAT_RG32_UINT ? 0 : 1];
+    if (pTexture)
+    {
+        const auto& Desc = pTexture->GetDesc();
+        if (Desc.Width >= NumBlocksX && Desc.Height >= NumBlocksY)
+            return pTexture;
+
+        // The texture only grows, so that compressing textures of different sizes does not recreate it every time
+        NumBlocksX = std::max(NumBlocksX, Desc.Width);
+        NumBlocksY = std::max(NumBlocksY, Desc.Height);
+        // The old texture is released when the GPU is done with it
+        pTexture.Release();
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU texture compressor block texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = NumBlocksX;
+    TexDesc.Height    = NumBlocksY;
+    TexDesc.Format    = Format;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_UNORDERED_ACCESS;
+    m_pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    return pTexture;
+}
+
+bool GPUTextureCompressor::Compress(IDeviceContext* pContext,
+                                    ITextureView*   pSrcSRV,
+                                    ITexture*       pDstTexture,
+                                    Uint32          DstMipLevel,
+                                    Uint32          DstSlice)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pSrcSRV != nullptr, "Source texture view must not be null");
+    DEV_CHECK_ERR(pDstTexture != nullptr, "Destination texture must not be null");
+
+    const auto& SrcViewDesc = pSrcSRV->GetDesc();
+    DEV_CHECK_ERR(SrcViewDesc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE, "Source texture view must be a shader resource view");
+    DEV_CHECK_ERR(SrcViewDesc.TextureDim == RESOURCE_DIM_TEX_2D, "Source texture view must be a 2D texture view");
+
+    const auto& DstDesc = pDstTexture->GetDesc();
+    DEV_CHECK_ERR(DstDesc.Type == RESOURCE_DIM_TEX_2D || DstDesc.Type == RESOURCE_DIM_TEX_2D_ARRAY,
+                  "Destination texture '", DstDesc.Name, "' must be a 2D texture or a 2D texture array");
+    DEV_CHECK_ERR(DstMipLevel < DstDesc.MipLevels, "Destination mip level (", DstMipLevel, ") is out of range");
+
+    KERNEL Kernel;
+    if (!GetKernel(DstDesc.Format, Kernel))
+    {
+        LOG_ERROR_MESSAGE("GPU texture compression to ", GetTextureFormatAttribs(DstDesc.Format).Name, " format is not supported");
+        return false;
+    }
+
+    const auto SrcMipProps = GetMipLevelProperties(pSrcSRV->GetTexture()->GetDesc(), SrcViewDesc.MostDetailedMip);
+    const auto DstMipProps = GetMipLevelProperties(DstDesc, DstMipLevel);
+    DEV_CHECK_ERR(SrcMipProps.LogicalWidth == DstMipProps.LogicalWidth && SrcMipProps.LogicalHeight == DstMipProps.LogicalHeight,
+                  "Source texture dimensions (", SrcMipProps.LogicalWidth, "x", SrcMipProps.LogicalHeight,
+                  ") must be equal to the destination mip level dimensions (", DstMipProps.LogicalWidth, "x", DstMipProps.LogicalHeight, ")");
+    // Copies from an uncompressed texture cover whole blocks, which Vulkan only allows within the mip level
+    DEV_CHECK_ERR((DstMipProps.LogicalWidth % 4) == 0 && (DstMipProps.LogicalHeight % 4) == 0,
+                  "Destination mip level dimensions (", DstMipProps.LogicalWidth, "x", DstMipProps.LogicalHeight, ") must be multiples of 4");
+
+    const auto ConvertToSRGB = GetTextureFormatAttribs(SrcViewDesc.Format).ComponentType == COMPONENT_TYPE_UNORM_SRGB;
+    const auto PSOIdx        = ConvertToSRGB ? 1 : 0;
+    if (!m_pPSO[Kernel][PSOIdx] && !CreatePipeline(Kernel, ConvertToSRGB))
+    {
+        LOG_ERROR_MESSAGE("Failed to create GPU texture compressor pipeline");
+        return false;
+    }
+
+    const auto NumBlocksX = DivCeil(DstMipProps.LogicalWidth, 4);
+    const auto NumBlocksY = DivCeil(DstMipProps.LogicalHeight, 4);
+
+    auto* pBlockTexture = GetBlockTexture(GetBlockCopyCompatibleFormat(DstDesc.Format), NumBlocksX, NumBlocksY);
+    if (pBlockTexture == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create GPU texture compressor block texture");
+        return false;
+    }
+
+    {
+        MapHelper<ShaderConstants> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->Width      = DstMipProps.LogicalWidth;
+        Constants->Height     = DstMipProps.LogicalHeight;
+        Constants->NumBlocksX = NumBlocksX;
+        Constants->NumBlocksY = NumBlocksY;
+    }
+
+    auto* pSRB = m_pSRB[Kernel][PSOIdx].RawPtr();
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Source")->Set(pSrcSRV);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pBlockTexture->GetDefaultView(TEXTURE_VIEW_UNORDERED_ACCESS));
+
+    pContext->SetPipelineState(m_pPSO[Kernel][PSOIdx]);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX = DivCeil(NumBlocksX, ThreadGroupSize);
+    DispatchAttribs.ThreadGroupCountY = DivCeil(NumBlocksY, ThreadGroupSize);
+    pContext->DispatchCompute(DispatchAttribs);
+
+    // Every texel of the block texture becomes one block of the destination texture
+    Box                SrcBox{0, NumBlocksX, 0, NumBlocksY};
+    CopyTextureAttribs CopyAttribs{pBlockTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pDstTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    CopyAttribs.pSrcBox     = &SrcBox;
+    CopyAttribs.DstMipLevel = DstMipLevel;
+    CopyAttribs.DstSlice    = DstSlice;
+    pContext->CopyTexture(CopyAttribs);
+
+    return true;
+}
+
+} // namespace Diligent
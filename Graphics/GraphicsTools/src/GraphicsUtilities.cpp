@@ -26,13 +26,27 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_MIP_KERNELS_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define DILIGENT_MIP_KERNELS_NEON 1
+#    include <arm_neon.h>
+#endif
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
+#include "ThreadPool.hpp"
 
 #define PI_F 3.1415926f
 
@@ -133,27 +147,53 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
 
 
 
-template <typename ChannelType>
-ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3)
+Uint8 SRGBAverage(Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3)
 {
-    static_assert(std::numeric_limits<ChannelType>::is_integer && !std::numeric_limits<ChannelType>::is_signed, "Unsigned integers are expected");
+    const float fLinearAverage = (SRGBToLinear(c0) + SRGBToLinear(c1) + SRGBToLinear(c2) + SRGBToLinear(c3)) * 0.25f;
 
-    static constexpr float MaxVal    = static_cast<float>(std::numeric_limits<ChannelType>::max());
-    static constexpr float MaxValInv = 1.f / MaxVal;
+    Uint8 SRGBAverage = 0;
+    ConvertLinearToSRGB(&fLinearAverage, &SRGBAverage, 1);
+    return SRGBAverage;
+}
 
-    float fc0 = static_cast<float>(c0) * MaxValInv;
-    float fc1 = static_cast<float>(c1) * MaxValInv;
-    float fc2 = static_cast<float>(c2) * MaxValInv;
-    float fc3 = static_cast<float>(c3) * MaxValInv;
+// Computes the sRGB 2x2 box filter for one row of the coarse mip level. Fine texels are converted
+// to linear space and the averages are converted back to sRGB in batches using the bulk conversion
+// functions. The results are identical to SRGBAverage().
+// Like the linear SIMD kernels, the function requires that the fine level width is at least 2.
+Uint32 SRGBAverageRow(const Uint8* pRow0, const Uint8* pRow1, Uint8* pDst, Uint32 CoarseWidth, Uint32 NumChannels)
+{
+    constexpr Uint32 MaxTexelsPerBatch = 64;
+    constexpr Uint32 MaxChannels       = 4;
+    if (NumChannels > MaxChannels)
+        return 0;
+
+    float Row0Linear[MaxTexelsPerBatch * 2 * MaxChannels];
+    float Row1Linear[MaxTexelsPerBatch * 2 * MaxChannels];
+    float LinearAverage[MaxTexelsPerBatch * MaxChannels];
+    for (Uint32 StartCol = 0; StartCol < CoarseWidth; StartCol += MaxTexelsPerBatch)
+    {
+        const auto NumTexels       = std::min(MaxTexelsPerBatch, CoarseWidth - StartCol);
+        const auto NumFineValues   = NumTexels * 2 * NumChannels;
+        const auto FineStartOffset = StartCol * 2 * NumChannels;
+        ConvertSRGBToLinear(pRow0 + FineStartOffset, Row0Linear, NumFineValues);
+        ConvertSRGBToLinear(pRow1 + FineStartOffset, Row1Linear, NumFineValues);
 
-    float fLinearAverage = (FastSRGBToLinear(fc0) + FastSRGBToLinear(fc1) + FastSRGBToLinear(fc2) + FastSRGBToLinear(fc3)) * 0.25f;
-    float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * MaxVal;
+        for (Uint32 col = 0; col < NumTexels; ++col)
+        {
+            const auto* pRow0Texel = Row0Linear + col * 2 * NumChannels;
+            const auto* pRow1Texel = Row1Linear + col * 2 * NumChannels;
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                // Use the same summation order as SRGBAverage() to get identical results
+                LinearAverage[col * NumChannels + c] =
+                    (pRow0Texel[c] + pRow0Texel[NumChannels + c] + pRow1Texel[c] + pRow1Texel[NumChannels + c]) * 0.25f;
+            }
+        }
 
-    // Clamping on both ends is essential because fast SRGB math is imprecise
-    fSRGBAverage = std::max(fSRGBAverage, 0.f);
-    fSRGBAverage = std::min(fSRGBAverage, MaxVal);
+        ConvertLinearToSRGB(LinearAverage, pDst + StartCol * NumChannels, NumTexels * NumChannels);
+    }
 
-    return static_cast<ChannelType>(fSRGBAverage);
+    return CoarseWidth;
 }
 
 template <typename ChannelType>
@@ -201,6 +241,221 @@ float LinearAverage<float>(float c0, float c1, float c2, float c3)
     return (c0 + c1 + c2 + c3) * 0.25f;
 }
 
+#if DILIGENT_MIP_KERNELS_SSE2 || DILIGENT_MIP_KERNELS_NEON
+
+// SIMD kernels that compute the linear 2x2 box filter for one row of the coarse mip level.
+// The kernels require that both fine level columns (2 * col and 2 * col + 1) exist for every
+// coarse column, which is the case when the fine level width is at least 2.
+// The kernels return the number of processed coarse level texels; the remaining texels are
+// processed by the scalar code. The results are bit-identical to LinearAverage().
+
+Uint32 LinearAverageRowSIMD(const Uint8* pRow0, const Uint8* pRow1, Uint8* pDst, Uint32 CoarseWidth, Uint32 NumChannels)
+{
+    // Every iteration reads 16 bytes from each fine row and writes 8 bytes
+    Uint32 TexelsPerIter = 0;
+    switch (NumChannels)
+    {
+        case 1: TexelsPerIter = 8; break;
+        case 2: TexelsPerIter = 4; break;
+        case 4: TexelsPerIter = 2; break;
+        default: return 0;
+    }
+
+    Uint32 col = 0;
+#    if DILIGENT_MIP_KERNELS_SSE2
+    const __m128i Zero       = _mm_setzero_si128();
+    const __m128i LowByteMsk = _mm_set1_epi16(0x00FF);
+    for (; col + TexelsPerIter <= CoarseWidth; col += TexelsPerIter)
+    {
+        const auto SrcOffset = col * 2 * NumChannels;
+
+        const __m128i Row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + SrcOffset));
+        const __m128i Row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + SrcOffset));
+
+        __m128i Sum;
+        if (NumChannels == 1)
+        {
+            // Even texels are in the low bytes of 16-bit lanes, odd texels are in the high bytes
+            Sum = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(Row0, LowByteMsk), _mm_srli_epi16(Row0, 8)),
+                                _mm_add_epi16(_mm_and_si128(Row1, LowByteMsk), _mm_srli_epi16(Row1, 8)));
+        }
+        else
+        {
+            const __m128i Row0Lo = _mm_unpacklo_epi8(Row0, Zero);
+            const __m128i Row0Hi = _mm_unpackhi_epi8(Row0, Zero);
+            const __m128i Row1Lo = _mm_unpacklo_epi8(Row1, Zero);
+            const __m128i Row1Hi = _mm_unpackhi_epi8(Row1, Zero);
+            if (NumChannels == 2)
+            {
+                // Every texel occupies one 32-bit lane
+                auto Even = [](__m128i Lo, __m128i Hi) {
+                    return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(Lo), _mm_castsi128_ps(Hi), _MM_SHUFFLE(2, 0, 2, 0)));
+                };
+                auto Odd = [](__m128i Lo, __m128i Hi) {
+                    return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(Lo), _mm_castsi128_ps(Hi), _MM_SHUFFLE(3, 1, 3, 1)));
+                };
+                Sum = _mm_add_epi16(_mm_add_epi16(Even(Row0Lo, Row0Hi), Odd(Row0Lo, Row0Hi)),
+                                    _mm_add_epi16(Even(Row1Lo, Row1Hi), Odd(Row1Lo, Row1Hi)));
+            }
+            else
+            {
+                // Every texel occupies one 64-bit lane
+                Sum = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi64(Row0Lo, Row0Hi), _mm_unpackhi_epi64(Row0Lo, Row0Hi)),
+                                    _mm_add_epi16(_mm_unpacklo_epi64(Row1Lo, Row1Hi), _mm_unpackhi_epi64(Row1Lo, Row1Hi)));
+            }
+        }
+        Sum = _mm_srli_epi16(Sum, 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + col * NumChannels), _mm_packus_epi16(Sum, Sum));
+    }
+#    else
+    for (; col + TexelsPerIter <= CoarseWidth; col += TexelsPerIter)
+    {
+        const auto SrcOffset = col * 2 * NumChannels;
+
+        // Deinterleave even and odd texels
+        uint8x8_t Row0Even, Row0Odd, Row1Even, Row1Odd;
+        if (NumChannels == 1)
+        {
+            const auto Row0 = vld2_u8(pRow0 + SrcOffset);
+            const auto Row1 = vld2_u8(pRow1 + SrcOffset);
+
+            Row0Even = Row0.val[0];
+            Row0Odd  = Row0.val[1];
+            Row1Even = Row1.val[0];
+            Row1Odd  = Row1.val[1];
+        }
+        else if (NumChannels == 2)
+        {
+            const auto Row0 = vld2_u16(reinterpret_cast<const uint16_t*>(pRow0 + SrcOffset));
+            const auto Row1 = vld2_u16(reinterpret_cast<const uint16_t*>(pRow1 + SrcOffset));
+
+            Row0Even = vreinterpret_u8_u16(Row0.val[0]);
+            Row0Odd  = vreinterpret_u8_u16(Row0.val[1]);
+            Row1Even = vreinterpret_u8_u16(Row1.val[0]);
+            Row1Odd  = vreinterpret_u8_u16(Row1.val[1]);
+        }
+        else
+        {
+            const auto Row0 = vld2_u32(reinterpret_cast<const uint32_t*>(pRow0 + SrcOffset));
+            const auto Row1 = vld2_u32(reinterpret_cast<const uint32_t*>(pRow1 + SrcOffset));
+
+            Row0Even = vreinterpret_u8_u32(Row0.val[0]);
+            Row0Odd  = vreinterpret_u8_u32(Row0.val[1]);
+            Row1Even = vreinterpret_u8_u32(Row1.val[0]);
+            Row1Odd  = vreinterpret_u8_u32(Row1.val[1]);
+        }
+
+        const uint16x8_t Sum = vaddq_u16(vaddl_u8(Row0Even, Row0Odd), vaddl_u8(Row1Even, Row1Odd));
+        vst1_u8(pDst + col * NumChannels, vshrn_n_u16(Sum, 2));
+    }
+#    endif
+
+    return col;
+}
+
+Uint32 LinearAverageRowSIMD(const Float32* pRow0, const Float32* pRow1, Float32* pDst, Uint32 CoarseWidth, Uint32 NumChannels)
+{
+    // Every iteration reads 8 floats from each fine row and writes 4 floats
+    Uint32 TexelsPerIter = 0;
+    switch (NumChannels)
+    {
+        case 1: TexelsPerIter = 4; break;
+        case 2: TexelsPerIter = 2; break;
+        case 4: TexelsPerIter = 1; break;
+        default: return 0;
+    }
+
+    Uint32 col = 0;
+#    if DILIGENT_MIP_KERNELS_SSE2
+    const __m128 Quarter = _mm_set1_ps(0.25f);
+    for (; col + TexelsPerIter <= CoarseWidth; col += TexelsPerIter)
+    {
+        const auto SrcOffset = col * 2 * NumChannels;
+
+        const __m128 Row0A = _mm_loadu_ps(pRow0 + SrcOffset);
+        const __m128 Row0B = _mm_loadu_ps(pRow0 + SrcOffset + 4);
+        const __m128 Row1A = _mm_loadu_ps(pRow1 + SrcOffset);
+        const __m128 Row1B = _mm_loadu_ps(pRow1 + SrcOffset + 4);
+
+        __m128 Row0Even, Row0Odd, Row1Even, Row1Odd;
+        if (NumChannels == 1)
+        {
+            Row0Even = _mm_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(2, 0, 2, 0));
+            Row0Odd  = _mm_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(3, 1, 3, 1));
+            Row1Even = _mm_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(2, 0, 2, 0));
+            Row1Odd  = _mm_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        else if (NumChannels == 2)
+        {
+            Row0Even = _mm_movelh_ps(Row0A, Row0B);
+            Row0Odd  = _mm_movehl_ps(Row0B, Row0A);
+            Row1Even = _mm_movelh_ps(Row1A, Row1B);
+            Row1Odd  = _mm_movehl_ps(Row1B, Row1A);
+        }
+        else
+        {
+            Row0Even = Row0A;
+            Row0Odd  = Row0B;
+            Row1Even = Row1A;
+            Row1Odd  = Row1B;
+        }
+
+        // Use the same summation order as LinearAverage() to get identical results
+        const __m128 Sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(Row0Even, Row0Odd), Row1Even), Row1Odd);
+        _mm_storeu_ps(pDst + col * NumChannels, _mm_mul_ps(Sum, Quarter));
+    }
+#    else
+    for (; col + TexelsPerIter <= CoarseWidth; col += TexelsPerIter)
+    {
+        const auto SrcOffset = col * 2 * NumChannels;
+
+        float32x4_t Row0Even, Row0Odd, Row1Even, Row1Odd;
+        if (NumChannels == 1)
+        {
+            const auto Row0 = vld2q_f32(pRow0 + SrcOffset);
+            const auto Row1 = vld2q_f32(pRow1 + SrcOffset);
+
+            Row0Even = Row0.val[0];
+            Row0Odd  = Row0.val[1];
+            Row1Even = Row1.val[0];
+            Row1Odd  = Row1.val[1];
+        }
+        else
+        {
+            const float32x4_t Row0A = vld1q_f32(pRow0 + SrcOffset);
+            const float32x4_t Row0B = vld1q_f32(pRow0 + SrcOffset + 4);
+            const float32x4_t Row1A = vld1q_f32(pRow1 + SrcOffset);
+            const float32x4_t Row1B = vld1q_f32(pRow1 + SrcOffset + 4);
+            if (NumChannels == 2)
+            {
+                Row0Even = vcombine_f32(vget_low_f32(Row0A), vget_low_f32(Row0B));
+                Row0Odd  = vcombine_f32(vget_high_f32(Row0A), vget_high_f32(Row0B));
+                Row1Even = vcombine_f32(vget_low_f32(Row1A), vget_low_f32(Row1B));
+                Row1Odd  = vcombine_f32(vget_high_f32(Row1A), vget_high_f32(Row1B));
+            }
+            else
+            {
+                Row0Even = Row0A;
+                Row0Odd  = Row0B;
+                Row1Even = Row1A;
+                Row1Odd  = Row1B;
+            }
+        }
+
+        // Use the same summation order as LinearAverage() to get identical results
+        const float32x4_t Sum = vaddq_f32(vaddq_f32(vaddq_f32(Row0Even, Row0Odd), Row1Even), Row1Odd);
+        vst1q_f32(pDst + col * NumChannels, vmulq_n_f32(Sum, 0.25f));
+    }
+#    endif
+
+    return col;
+}
+
+#    define LINEAR_AVERAGE_ROW_SIMD LinearAverageRowSIMD
+#else
+#    define LINEAR_AVERAGE_ROW_SIMD nullptr
+#endif
+
 struct ComputeCoarseMipHelper
 {
     const Uint32 FineMipWidth;
@@ -214,9 +469,17 @@ struct ComputeCoarseMipHelper
 
     const Uint32 NumChannels;
 
+    // Range of the coarse mip level rows to compute
+    const Uint32 StartRow;
+    const Uint32 EndRow;
+
+    // Function that processes the leading texels of one coarse row and returns their number
+    template <typename ChannelType>
+    using RowKernelType = Uint32 (*)(const ChannelType* pRow0, const ChannelType* pRow1, ChannelType* pDst, Uint32 CoarseWidth, Uint32 NumChannels);
+
     template <typename ChannelType,
               typename AverageFuncType>
-    void Run(AverageFuncType ComputeAverage) const
+    void Run(AverageFuncType ComputeAverage, RowKernelType<ChannelType> RowKernel = nullptr) const
     {
         VERIFY_EXPR(FineMipWidth > 0 && FineMipHeight > 0);
         VERIFY(FineMipHeight == 1 || FineMipStride >= FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
@@ -226,15 +489,22 @@ struct ComputeCoarseMipHelper
 
         VERIFY(CoarseMipHeight == 1 || CoarseMipStride >= CoarseMipWidth * sizeof(ChannelType) * NumChannels, "Coarse mip level stride is too small");
 
-        for (Uint32 row = 0; row < CoarseMipHeight; ++row)
+        // The kernel requires two fine texels for every coarse texel
+        if (FineMipWidth < 2)
+            RowKernel = nullptr;
+
+        const auto LastRow = std::min(EndRow, CoarseMipHeight);
+        for (Uint32 row = StartRow; row < LastRow; ++row)
         {
             auto src_row0 = row * 2;
             auto src_row1 = std::min(row * 2 + 1, FineMipHeight - 1);
 
             auto pSrcRow0 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(pFineMip) + src_row0 * FineMipStride);
             auto pSrcRow1 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(pFineMip) + src_row1 * FineMipStride);
+            auto pDstRow  = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(pCoarseMip) + row * CoarseMipStride);
 
-            for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+            Uint32 col = RowKernel != nullptr ? RowKernel(pSrcRow0, pSrcRow1, pDstRow, CoarseMipWidth, NumChannels) : 0;
+            for (; col < CoarseMipWidth; ++col)
             {
                 auto src_col0 = col * 2;
                 auto src_col1 = std::min(col * 2 + 1, FineMipWidth - 1);
@@ -246,13 +516,72 @@ struct ComputeCoarseMipHelper
                     const auto Chnl10 = pSrcRow1[src_col0 * NumChannels + c];
                     const auto Chnl11 = pSrcRow1[src_col1 * NumChannels + c];
 
-                    auto& DstCol = reinterpret_cast<ChannelType*>(reinterpret_cast<Uint8*>(pCoarseMip) + row * CoarseMipStride)[col * NumChannels + c];
-
-                    DstCol = ComputeAverage(Chnl00, Chnl01, Chnl10, Chnl11);
+                    pDstRow[col * NumChannels + c] = ComputeAverage(Chnl00, Chnl01, Chnl10, Chnl11);
                 }
             }
         }
     }
+
+    void Run(const TextureFormatAttribs& FmtAttribs) const
+    {
+        switch (FmtAttribs.ComponentType)
+        {
+            case COMPONENT_TYPE_UNORM_SRGB:
+                VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
+                Run<Uint8>(SRGBAverage, SRGBAverageRow);
+                break;
+
+            case COMPONENT_TYPE_UNORM:
+            case COMPONENT_TYPE_UINT:
+                switch (FmtAttribs.ComponentSize)
+                {
+                    case 1:
+                        Run<Uint8>(LinearAverage<Uint8>, LINEAR_AVERAGE_ROW_SIMD);
+                        break;
+
+                    case 2:
+                        Run<Uint16>(LinearAverage<Uint16>);
+                        break;
+
+                    case 4:
+                        Run<Uint32>(LinearAverage<Uint32>);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UNORM/UINT texture format");
+                }
+                break;
+
+            case COMPONENT_TYPE_SNORM:
+            case COMPONENT_TYPE_SINT:
+                switch (FmtAttribs.ComponentSize)
+                {
+                    case 1:
+                        Run<Int8>(LinearAverage<Int8>);
+                        break;
+
+                    case 2:
+                        Run<Int16>(LinearAverage<Int16>);
+                        break;
+
+                    case 4:
+                        Run<Int32>(LinearAverage<Int32>);
+                        break;
+
+                    default:
+                        UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UINT/SINT texture format");
+                }
+                break;
+
+            case COMPONENT_TYPE_FLOAT:
+                VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
+                Run<Float32>(LinearAverage<Float32>, LINEAR_AVERAGE_ROW_SIMD);
+                break;
+
+            default:
+                UNEXPECTED("Unsupported component type");
+        }
+    }
 };
 
 void ComputeMipLevel(Uint32         FineLevelWidth,
@@ -273,65 +602,92 @@ void ComputeMipLevel(Uint32         FineLevelWidth,
             FineDataStrideInBytes,
             pCoarseLevelData,
             CoarseDataStrideInBytes,
-            FmtAttribs.NumComponents //
+            FmtAttribs.NumComponents,
+            0,
+            ~Uint32{0} //
         };
+    ComputeMipHelper.Run(FmtAttribs);
+}
 
-    switch (FmtAttribs.ComponentType)
-    {
-        case COMPONENT_TYPE_UNORM_SRGB:
-            VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            ComputeMipHelper.Run<Uint8>(SRGBAverage<Uint8>);
-            break;
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Width > 0 && Attribs.Height > 0, "Texture dimensions must not be zero");
+    DEV_CHECK_ERR(Attribs.NumMipLevels <= ComputeMipLevelsCount(Attribs.Width, Attribs.Height), "Too many mip levels");
+    DEV_CHECK_ERR(Attribs.NumMipLevels <= 1 || (Attribs.ppMipData != nullptr && Attribs.pMipStrides != nullptr), "Mip level data and strides must not be null");
 
-        case COMPONENT_TYPE_UNORM:
-        case COMPONENT_TYPE_UINT:
-            switch (FmtAttribs.ComponentSize)
-            {
-                case 1:
-                    ComputeMipHelper.Run<Uint8>(LinearAverage<Uint8>);
-                    break;
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
 
-                case 2:
-                    ComputeMipHelper.Run<Uint16>(LinearAverage<Uint16>);
-                    break;
+    // Rows of mip levels smaller than this are not split between threads
+    constexpr Uint32 MinTexelsPerTask = 16384;
 
-                case 4:
-                    ComputeMipHelper.Run<Uint32>(LinearAverage<Uint32>);
-                    break;
+    const auto NumThreads = Attribs.pThreadPool != nullptr ? Attribs.pThreadPool->GetThreadCount() : 0;
 
-                default:
-                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UNORM/UINT texture format");
-            }
-            break;
+    for (Uint32 mip = 1; mip < Attribs.NumMipLevels; ++mip)
+    {
+        const auto FineMipWidth    = std::max(Attribs.Width >> (mip - 1), 1u);
+        const auto FineMipHeight   = std::max(Attribs.Height >> (mip - 1), 1u);
+        const auto CoarseMipWidth  = std::max(FineMipWidth / 2u, 1u);
+        const auto CoarseMipHeight = std::max(FineMipHeight / 2u, 1u);
 
-        case COMPONENT_TYPE_SNORM:
-        case COMPONENT_TYPE_SINT:
-            switch (FmtAttribs.ComponentSize)
-            {
-                case 1:
-                    ComputeMipHelper.Run<Int8>(LinearAverage<Int8>);
-                    break;
+        auto GetHelper = [&](Uint32 StartRow, Uint32 EndRow) {
+            return ComputeCoarseMipHelper //
+                {
+                    FineMipWidth,
+                    FineMipHeight,
+                    Attribs.ppMipData[mip - 1],
+                    Attribs.pMipStrides[mip - 1],
+                    Attribs.ppMipData[mip],
+                    Attribs.pMipStrides[mip],
+                    FmtAttribs.NumComponents,
+                    StartRow,
+                    EndRow //
+                };
+        };
 
-                case 2:
-                    ComputeMipHelper.Run<Int16>(LinearAverage<Int16>);
-                    break;
+        // The calling thread processes one of the chunks
+        const auto RowsPerTask = std::max(MinTexelsPerTask / CoarseMipWidth, 1u);
+        const auto NumChunks   = std::min((CoarseMipHeight + RowsPerTask - 1) / RowsPerTask, NumThreads + 1);
+        if (NumChunks <= 1)
+        {
+            GetHelper(0, CoarseMipHeight).Run(FmtAttribs);
+            continue;
+        }
 
-                case 4:
-                    ComputeMipHelper.Run<Int32>(LinearAverage<Int32>);
-                    break;
+        // The state is shared with the tasks that may start after the level has been computed.
+        // Such tasks find no chunks left and do not touch the data.
+        struct ParallelState
+        {
+            std::function<void(Uint32)> ProcessChunk;
+            std::atomic<Uint32>         NextChunk{0};
+            std::atomic<Uint32>         NumChunksDone{0};
+            std::mutex                  Mtx;
+            std::condition_variable     ChunksDoneCV;
+        };
+        auto pState          = std::make_shared<ParallelState>();
+        pState->ProcessChunk = [&](Uint32 Chunk) {
+            GetHelper(CoarseMipHeight * Chunk / NumChunks, CoarseMipHeight * (Chunk + 1) / NumChunks).Run(FmtAttribs);
+        };
 
-                default:
-                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for UINT/SINT texture format");
+        auto ProcessChunks = [pState, NumChunks]() {
+            for (auto Chunk = pState->NextChunk.fetch_add(1); Chunk < NumChunks; Chunk = pState->NextChunk.fetch_add(1))
+            {
+                pState->ProcessChunk(Chunk);
+                if (pState->NumChunksDone.fetch_add(1) + 1 == NumChunks)
+                {
+                    std::lock_guard<std::mutex> Lock{pState->Mtx};
+                    pState->ChunksDoneCV.notify_all();
+                }
             }
-            break;
+        };
 
-        case COMPONENT_TYPE_FLOAT:
-            VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipHelper.Run<Float32>(LinearAverage<Float32>);
-            break;
+        for (Uint32 task = 1; task < NumChunks; ++task)
+            EnqueueTask(Attribs.pThreadPool, ProcessChunks);
 
-        default:
-            UNEXPECTED("Unsupported component type");
+        ProcessChunks();
+
+        // Next level reads the data of this level
+        std::unique_lock<std::mutex> Lock{pState->Mtx};
+        pState->ChunksDoneCV.wait(Lock, [&]() { return pState->NumChunksDone.load() == NumChunks; });
     }
 }
 
@@ -374,4 +730,9 @@ extern "C"
         ComputeMipLevel(FineLevelWidth, FineLevelHeight, Fmt, pFineLevelData,
                         FineDataStrideInBytes, pCoarseLevelData, CoarseDataStrideInBytes);
     }
+
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs& Attribs)
+    {
+        Diligent::ComputeMipChain(Attribs);
+    }
 }
@@ -0,0 +1,428 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HiZOcclusionCuller.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+// clang-format off
+static const char* g_HiZOcclusionCullerSource =
+{
+    #include "../shaders/HiZOcclusionCuller_inc.h"
+};
+// clang-format on
+
+// Must match cbConstants in HiZOcclusionCuller.csh
+struct HiZOcclusionCuller::ShaderConstants
+{
+    float4x4 HiZViewProj;
+    float4   FrustumPlanes[ViewFrustum::NUM_PLANES];
+
+    Uint32 NumObjects   = 0;
+    Uint32 HiZMipLevels = 0;
+    Uint32 HiZWidth     = 0;
+    Uint32 HiZHeight    = 0;
+
+    Uint32 SrcMipWidth  = 0;
+    Uint32 SrcMipHeight = 0;
+    Uint32 DstMipWidth  = 0;
+    Uint32 DstMipHeight = 0;
+
+    float  YtoVScale     = 0;
+    float  ZtoDepthScale = 0;
+    float  ZtoDepthBias  = 0;
+    Uint32 TestOcclusion = 0;
+};
+
+namespace
+{
+
+// Must match the values in HiZOcclusionCuller.csh
+constexpr Uint32 ThreadGroupSize = 64;
+constexpr Uint32 HiZGroupSize    = 8;
+
+// The number of 32-bit values in indexed indirect draw arguments
+constexpr Uint32 DrawArgsSize = 5;
+
+// The maximum number of thread groups in one dispatch dimension
+constexpr Uint32 MaxGroupsPerDim = 65535;
+
+inline Uint32 DivCeil(Uint32 Num, Uint32 Denom)
+{
+    return (Num + Denom - 1) / Denom;
+}
+
+#ifdef DILIGENT_DEVELOPMENT
+void VerifyBufferView(IBufferView* pView, BUFFER_VIEW_TYPE ExpectedType, Uint32 NumElements, const char* Name)
+{
+    DEV_CHECK_ERR(pView != nullptr, Name, " must not be null");
+    const auto& ViewDesc = pView->GetDesc();
+    DEV_CHECK_ERR(ViewDesc.ViewType == ExpectedType, Name, " must be ",
+                  (ExpectedType == BUFFER_VIEW_SHADER_RESOURCE ? "a shader resource view" : "an unordered access view"));
+    DEV_CHECK_ERR(ViewDesc.Format.ValueType == VT_UINT32 && ViewDesc.Format.NumComponents == 1,
+                  Name, " must be a formatted view with VT_UINT32 x 1 format");
+    DEV_CHECK_ERR(ViewDesc.ByteWidth / sizeof(Uint32) >= NumElements, Name, " is too small: ", NumElements,
+                  " elements are required, but the view contains only ", ViewDesc.ByteWidth / sizeof(Uint32));
+}
+#endif
+
+} // namespace
+
+HiZOcclusionCuller::HiZOcclusionCuller(IRenderDevice* pDevice, const HiZOcclusionCullerCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_Compactor{pDevice}
+{
+    if (!m_pDevice->GetDeviceInfo().Features.ComputeShaders)
+        LOG_ERROR_AND_THROW("Hi-Z occlusion culler requires compute shaders");
+
+    BufferDesc CBDesc;
+    CBDesc.Name           = "Hi-Z occlusion culler constants";
+    CBDesc.uiSizeInBytes  = sizeof(ShaderConstants);
+    CBDesc.Usage          = USAGE_DYNAMIC;
+    CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create Hi-Z occlusion culler constant buffer");
+
+    if (!CreateKernels(CI.ReverseDepth))
+        LOG_ERROR_AND_THROW("Failed to create Hi-Z occlusion culler kernels");
+}
+
+HiZOcclusionCuller::~HiZOcclusionCuller()
+{
+}
+
+bool HiZOcclusionCuller::CreateKernels(bool ReverseDepth)
+{
+    struct KernelInfo
+    {
+        const Char* Name;
+        const Char* Define;
+        const Char* EntryPoint;
+    };
+    // clang-format off
+    static constexpr KernelInfo Kernels[] =
+    {
+        {"Hi-Z occlusion culler - copy depth",      "HIZ_COPY",        "CopyDepthCS"    },
+        {"Hi-Z occlusion culler - downsample",      "HIZ_DOWNSAMPLE",  "DownsampleCS"   },
+        {"Hi-Z occlusion culler - cull objects",    "CULL_OBJECTS",    "CullObjectsCS"  },
+        {"Hi-Z occlusion culler - write draw args", "WRITE_DRAW_ARGS", "WriteDrawArgsCS"}
+    };
+    // clang-format on
+    static_assert(_countof(Kernels) == KERNEL_COUNT, "Please update the kernel list");
+
+    for (Uint32 k = 0; k < KERNEL_COUNT; ++k)
+    {
+        const auto& Info = Kernels[k];
+
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro(Info.Define, 1);
+        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
+        Macros.AddShaderMacro("HIZ_GROUP_SIZE", HiZGroupSize);
+        Macros.AddShaderMacro("REVERSE_DEPTH", ReverseDepth ? 1 : 0);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc.Name       = Info.Name;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Source          = g_HiZOcclusionCullerSource;
+        ShaderCI.EntryPoint      = Info.EntryPoint;
+        ShaderCI.Macros          = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return false;
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = Info.Name;
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.pCS                  = pCS;
+
+        // Resources are set before every dispatch
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}};
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        auto& Kern = m_Kernels[k];
+        m_pDevice->CreateComputePipelineState(PSOCreateInfo, &Kern.pPSO);
+        if (!Kern.pPSO)
+            return false;
+
+        Kern.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pConstants);
+        Kern.pPSO->CreateShaderResourceBinding(&Kern.pSRB, true);
+        if (!Kern.pSRB)
+            return false;
+    }
+
+    return true;
+}
+
+bool HiZOcclusionCuller::CreateHiZTexture(Uint32 Width, Uint32 Height)
+{
+    if (m_pHiZTexture)
+    {
+        const auto& Desc = m_pHiZTexture->GetDesc();
+        if (Desc.Width == Width && Desc.Height == Height)
+            return true;
+
+        // The old texture is released when the GPU is done with it
+        m_pHiZTexture.Release();
+        m_HiZMipUAVs.clear();
+        m_HiZReady = false;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Hi-Z pyramid";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.MipLevels = ComputeMipLevelsCount(Width, Height);
+    TexDesc.Format    = TEX_FORMAT_R32_FLOAT;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    m_pDevice->CreateTexture(TexDesc, nullptr, &m_pHiZTexture);
+    if (!m_pHiZTexture)
+        return false;
+
+    // Every level is written through its own view, and the downsampling kernel reads the previous level
+    // through an unordered access view as well, so that the whole texture stays in the same state.
+    m_HiZMipUAVs.resize(TexDesc.MipLevels);
+    for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
+    {
+        TextureViewDesc ViewDesc;
+        ViewDesc.Name            = "Hi-Z pyramid mip UAV";
+        ViewDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+        ViewDesc.TextureDim      = RESOURCE_DIM_TEX_2D;
+        ViewDesc.MostDetailedMip = Mip;
+        ViewDesc.NumMipLevels    = 1;
+        m_pHiZTexture->CreateView(ViewDesc, &m_HiZMipUAVs[Mip]);
+        if (!m_HiZMipUAVs[Mip])
+        {
+            m_pHiZTexture.Release();
+            m_HiZMipUAVs.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+HiZOcclusionCuller::ScratchBuffer& HiZOcclusionCuller::GetScratchBuffer(SCRATCH_BUFFER Slot, Uint32 NumElements)
+{
+    auto& Scratch = m_ScratchBuffers[Slot];
+    if (Scratch.pBuffer && Scratch.pBuffer->GetDesc().uiSizeInBytes >= NumElements * sizeof(Uint32))
+        return Scratch;
+
+    // Buffers that are still in use by the GPU are released when the GPU is done with them
+    Scratch = ScratchBuffer{};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Hi-Z occlusion culler scratch buffer";
+    BuffDesc.uiSizeInBytes     = NumElements * Uint32{sizeof(Uint32)};
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &Scratch.pBuffer);
+    VERIFY_EXPR(Scratch.pBuffer);
+
+    BufferViewDesc ViewDesc;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+
+    ViewDesc.Name     = "Hi-Z occlusion culler scratch buffer SRV";
+    ViewDesc.ViewType = BUFFER_VIEW_SHADER_RESOURCE;
+    Scratch.pBuffer->CreateView(ViewDesc, &Scratch.pSRV);
+
+    ViewDesc.Name     = "Hi-Z occlusion culler scratch buffer UAV";
+    ViewDesc.ViewType = BUFFER_VIEW_UNORDERED_ACCESS;
+    Scratch.pBuffer->CreateView(ViewDesc, &Scratch.pUAV);
+
+    return Scratch;
+}
+
+void HiZOcclusionCuller::SetVariable(KERNEL Kernel, const Char* Name, IDeviceObject* pObject)
+{
+    auto* pVar = m_Kernels[Kernel].pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, Name);
+    VERIFY(pVar != nullptr, "Variable '", Name, "' is not found");
+    pVar->Set(pObject);
+}
+
+void HiZOcclusionCuller::Dispatch(IDeviceContext* pContext, KERNEL Kernel, const ShaderConstants& Constants, Uint32 NumGroupsX, Uint32 NumGroupsY)
+{
+    {
+        MapHelper<ShaderConstants> MappedConstants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        *MappedConstants = Constants;
+    }
+
+    auto& Kern = m_Kernels[Kernel];
+    pContext->SetPipelineState(Kern.pPSO);
+    pContext->CommitShaderResources(Kern.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX = NumGroupsX;
+    DispatchAttribs.ThreadGroupCountY = NumGroupsY;
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+void HiZOcclusionCuller::BuildHiZ(IDeviceContext* pContext, ITextureView* pDepthSRV)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(pDepthSRV != nullptr, "Depth buffer view must not be null");
+
+    const auto& ViewDesc  = pDepthSRV->GetDesc();
+    const auto& DepthDesc = pDepthSRV->GetTexture()->GetDesc();
+    DEV_CHECK_ERR(ViewDesc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE, "Depth buffer view must be a shader resource view");
+    DEV_CHECK_ERR(ViewDesc.TextureDim == RESOURCE_DIM_TEX_2D, "Depth buffer view must be a 2D texture view");
+    DEV_CHECK_ERR(DepthDesc.SampleCount == 1, "Multisampled depth buffers are not supported");
+
+    const auto MipProps = GetMipLevelProperties(DepthDesc, ViewDesc.MostDetailedMip);
+    if (!CreateHiZTexture(MipProps.LogicalWidth, MipProps.LogicalHeight))
+    {
+        LOG_ERROR_MESSAGE("Failed to create Hi-Z pyramid texture");
+        m_HiZReady = false;
+        return;
+    }
+
+    const auto& HiZDesc = m_pHiZTexture->GetDesc();
+
+    ShaderConstants Constants;
+    Constants.DstMipWidth  = HiZDesc.Width;
+    Constants.DstMipHeight = HiZDesc.Height;
+    SetVariable(KERNEL_HIZ_COPY, "g_Depth", pDepthSRV);
+    SetVariable(KERNEL_HIZ_COPY, "g_DstMip", m_HiZMipUAVs[0]);
+    Dispatch(pContext, KERNEL_HIZ_COPY, Constants, DivCeil(Constants.DstMipWidth, HiZGroupSize), DivCeil(Constants.DstMipHeight, HiZGroupSize));
+
+    for (Uint32 Mip = 1; Mip < HiZDesc.MipLevels; ++Mip)
+    {
+        Constants.SrcMipWidth  = Constants.DstMipWidth;
+        Constants.SrcMipHeight = Constants.DstMipHeight;
+        Constants.DstMipWidth  = std::max(HiZDesc.Width >> Mip, 1u);
+        Constants.DstMipHeight = std::max(HiZDesc.Height >> Mip, 1u);
+        SetVariable(KERNEL_HIZ_DOWNSAMPLE, "g_SrcMip", m_HiZMipUAVs[Mip - 1]);
+        SetVariable(KERNEL_HIZ_DOWNSAMPLE, "g_DstMip", m_HiZMipUAVs[Mip]);
+        Dispatch(pContext, KERNEL_HIZ_DOWNSAMPLE, Constants, DivCeil(Constants.DstMipWidth, HiZGroupSize), DivCeil(Constants.DstMipHeight, HiZGroupSize));
+    }
+
+    m_HiZReady = true;
+}
+
+void HiZOcclusionCuller::Cull(IDeviceContext* pContext, const HiZCullAttribs& Attribs)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+#ifdef DILIGENT_DEVELOPMENT
+    DEV_CHECK_ERR(Attribs.pObjectsSRV != nullptr, "Objects buffer view must not be null");
+    {
+        const auto& ObjViewDesc = Attribs.pObjectsSRV->GetDesc();
+        const auto& ObjBuffDesc = Attribs.pObjectsSRV->GetBuffer()->GetDesc();
+        DEV_CHECK_ERR(ObjViewDesc.ViewType == BUFFER_VIEW_SHADER_RESOURCE, "Objects buffer view must be a shader resource view");
+        DEV_CHECK_ERR(ObjBuffDesc.Mode == BUFFER_MODE_STRUCTURED && ObjBuffDesc.ElementByteStride == sizeof(HiZCullObject),
+                      "Objects buffer '", ObjBuffDesc.Name, "' must be a structured buffer with element stride equal to sizeof(HiZCullObject)");
+        DEV_CHECK_ERR(ObjViewDesc.ByteWidth / sizeof(HiZCullObject) >= Attribs.NumObjects, "Objects buffer view is too small: ",
+                      Attribs.NumObjects, " objects are required, but the view contains only ", ObjViewDesc.ByteWidth / sizeof(HiZCullObject));
+    }
+    VerifyBufferView(Attribs.pDrawArgsUAV, BUFFER_VIEW_UNORDERED_ACCESS, Attribs.NumObjects * DrawArgsSize, "Draw arguments buffer view");
+    DEV_CHECK_ERR((Attribs.pDrawArgsUAV->GetBuffer()->GetDesc().BindFlags & BIND_INDIRECT_DRAW_ARGS) != 0,
+                  "Draw arguments buffer must be created with BIND_INDIRECT_DRAW_ARGS flag");
+    VerifyBufferView(Attribs.pCountUAV, BUFFER_VIEW_UNORDERED_ACCESS, 1, "Count buffer view");
+#endif
+    DEV_CHECK_ERR(DivCeil(Attribs.NumObjects, ThreadGroupSize) <= MaxGroupsPerDim,
+                  "The number of objects (", Attribs.NumObjects, ") exceeds the maximum supported number (", MaxGroupsPerDim * ThreadGroupSize, ")");
+
+    if (Attribs.NumObjects == 0)
+    {
+        // Compaction does not write the count when there are no elements
+        const Uint32 Zero = 0;
+        pContext->UpdateBuffer(Attribs.pCountUAV->GetBuffer(), Attribs.pCountUAV->GetDesc().ByteOffset, sizeof(Zero), &Zero, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        return;
+    }
+
+    const auto& DeviceInfo = m_pDevice->GetDeviceInfo();
+    const auto& NDCAttribs = DeviceInfo.GetNDCAttribs();
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(Attribs.ViewProj, Frustum, DeviceInfo.IsGLDevice());
+
+    ShaderConstants Constants;
+    Constants.HiZViewProj = Attribs.HiZViewProj.Transpose();
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+        Constants.FrustumPlanes[i] = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+
+    Constants.NumObjects    = Attribs.NumObjects;
+    Constants.YtoVScale     = NDCAttribs.YtoVScale;
+    Constants.ZtoDepthScale = NDCAttribs.ZtoDepthScale;
+    Constants.ZtoDepthBias  = NDCAttribs.GetZtoDepthBias();
+    Constants.TestOcclusion = (Attribs.TestOcclusion && m_HiZReady) ? 1 : 0;
+
+    // The kernel does not read the pyramid when the occlusion test is disabled, but the variable
+    // must be initialized, so a placeholder texture is created if the pyramid has never been built
+    if (!m_pHiZTexture && !CreateHiZTexture(1, 1))
+    {
+        LOG_ERROR_MESSAGE("Failed to create Hi-Z pyramid texture");
+        return;
+    }
+    const auto& HiZDesc    = m_pHiZTexture->GetDesc();
+    Constants.HiZMipLevels = HiZDesc.MipLevels;
+    Constants.HiZWidth     = HiZDesc.Width;
+    Constants.HiZHeight    = HiZDesc.Height;
+
+    const auto NumGroups = DivCeil(Attribs.NumObjects, ThreadGroupSize);
+
+    auto& Flags          = GetScratchBuffer(SCRATCH_BUFFER_FLAGS, Attribs.NumObjects);
+    auto& Indices        = GetScratchBuffer(SCRATCH_BUFFER_INDICES, Attribs.NumObjects);
+    auto& VisibleIndices = GetScratchBuffer(SCRATCH_BUFFER_VISIBLE_INDICES, Attribs.NumObjects);
+
+    SetVariable(KERNEL_CULL_OBJECTS, "g_Objects", Attribs.pObjectsSRV);
+    SetVariable(KERNEL_CULL_OBJECTS, "g_HiZ", m_pHiZTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    SetVariable(KERNEL_CULL_OBJECTS, "g_Flags", Flags.pUAV);
+    SetVariable(KERNEL_CULL_OBJECTS, "g_Indices", Indices.pUAV);
+    Dispatch(pContext, KERNEL_CULL_OBJECTS, Constants, NumGroups);
+
+    m_Compactor.Compact(pContext, Indices.pSRV, Flags.pSRV, VisibleIndices.pUAV, Attribs.pCountUAV, Attribs.NumObjects);
+
+    SetVariable(KERNEL_WRITE_DRAW_ARGS, "g_Objects", Attribs.pObjectsSRV);
+    SetVariable(KERNEL_WRITE_DRAW_ARGS, "g_VisibleIndices", VisibleIndices.pSRV);
+    SetVariable(KERNEL_WRITE_DRAW_ARGS, "g_VisibleCount", Attribs.pCountUAV);
+    SetVariable(KERNEL_WRITE_DRAW_ARGS, "g_DrawArgs", Attribs.pDrawArgsUAV);
+    Dispatch(pContext, KERNEL_WRITE_DRAW_ARGS, Constants, NumGroups);
+}
+
+} // namespace Diligent
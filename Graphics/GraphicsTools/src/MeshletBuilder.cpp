@@ -0,0 +1,553 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MeshletBuilder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "DebugUtilities.hpp"
+#include "AdvancedMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+// clang-format off
+static const char* g_MeshletCullingSource =
+{
+    #include "../shaders/MeshletCulling_inc.h"
+};
+// clang-format on
+
+namespace
+{
+
+constexpr Uint32 VertexCacheSize = 32;
+
+// The number of triangles that are optimized and grouped into meshlets independently
+constexpr Uint32 TrianglesPerChunk = 16384;
+
+// Vertex scores of the Forsyth algorithm, see
+// https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+class VertexScoreTable
+{
+public:
+    VertexScoreTable()
+    {
+        constexpr float CacheDecayPower   = 1.5f;
+        constexpr float LastTriScore      = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        for (Uint32 CachePos = 0; CachePos < VertexCacheSize; ++CachePos)
+        {
+            // The vertices of the last triangle get a fixed score so that the next triangle
+            // does not depend on the order in which they were added
+            m_CacheScores[CachePos] = CachePos < 3 ?
+                LastTriScore :
+                std::pow(1.f - static_cast<float>(CachePos - 3) / static_cast<float>(VertexCacheSize - 3), CacheDecayPower);
+        }
+
+        // Vertices with few remaining triangles are boosted so that they are
+        // finished off and do not leave isolated triangles behind
+        for (Uint32 Valence = 1; Valence < MaxTableValence; ++Valence)
+            m_ValenceScores[Valence] = ValenceBoostScale * std::pow(static_cast<float>(Valence), -ValenceBoostPower);
+    }
+
+    float Get(Int32 CachePos, Uint32 NumActiveTris) const
+    {
+        if (NumActiveTris == 0)
+            return -1.f;
+
+        float Score = CachePos >= 0 ? m_CacheScores[CachePos] : 0.f;
+        Score += NumActiveTris < MaxTableValence ?
+            m_ValenceScores[NumActiveTris] :
+            2.0f / std::sqrt(static_cast<float>(NumActiveTris));
+        return Score;
+    }
+
+private:
+    static constexpr Uint32 MaxTableValence = 64;
+
+    float m_CacheScores[VertexCacheSize]   = {};
+    float m_ValenceScores[MaxTableValence] = {};
+};
+
+void OptimizeVertexCacheImpl(const Uint32* pIndices, Uint32 NumTriangles, Uint32 NumVertices, Uint32* pDstIndices)
+{
+    static const VertexScoreTable Scores;
+
+    // Lists of the triangles that use every vertex and have not been emitted yet.
+    // Emitted triangles are swapped to the end of the list, past NumActiveTris.
+    std::vector<Uint32> AdjOffsets(size_t{NumVertices} + 1, 0);
+    for (size_t i = 0; i < size_t{NumTriangles} * 3; ++i)
+        ++AdjOffsets[pIndices[i] + 1];
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        AdjOffsets[v + 1] += AdjOffsets[v];
+
+    std::vector<Uint32> NumActiveTris(NumVertices, 0);
+    std::vector<Uint32> AdjTris(size_t{NumTriangles} * 3);
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        for (Uint32 k = 0; k < 3; ++k)
+        {
+            const auto v = pIndices[t * 3 + k];
+            AdjTris[AdjOffsets[v] + NumActiveTris[v]++] = t;
+        }
+    }
+
+    std::vector<Int32> CachePos(NumVertices, -1);
+    std::vector<float> VertexScores(NumVertices);
+    for (Uint32 v = 0; v < NumVertices; ++v)
+        VertexScores[v] = Scores.Get(-1, NumActiveTris[v]);
+
+    auto GetTriScore = [&](Uint32 t) {
+        const auto* Tri = pIndices + size_t{t} * 3;
+        return VertexScores[Tri[0]] + VertexScores[Tri[1]] + VertexScores[Tri[2]];
+    };
+
+    std::vector<float> TriScores(NumTriangles);
+    std::vector<bool>  TriEmitted(NumTriangles, false);
+
+    Uint32 BestTri   = NumTriangles;
+    float  BestScore = -1.f;
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        TriScores[t] = GetTriScore(t);
+        if (TriScores[t] > BestScore)
+        {
+            BestScore = TriScores[t];
+            BestTri   = t;
+        }
+    }
+
+    Uint32 Cache[VertexCacheSize + 3];
+    Uint32 CacheSize = 0;
+    // The first triangle that may not have been emitted, used when none of the
+    // triangles that share vertices with the cache is left
+    Uint32 NextCandidate = 0;
+    for (Uint32 n = 0; n < NumTriangles; ++n)
+    {
+        if (BestTri == NumTriangles)
+        {
+            while (TriEmitted[NextCandidate])
+                ++NextCandidate;
+            BestTri = NextCandidate;
+        }
+
+        const auto* Tri = pIndices + size_t{BestTri} * 3;
+        for (Uint32 k = 0; k < 3; ++k)
+            pDstIndices[size_t{n} * 3 + k] = Tri[k];
+        TriEmitted[BestTri] = true;
+
+        for (Uint32 k = 0; k < 3; ++k)
+        {
+            const auto v       = Tri[k];
+            auto*      pVtxAdj = &AdjTris[AdjOffsets[v]];
+            auto*      pEnd    = pVtxAdj + NumActiveTris[v];
+            auto       It      = std::find(pVtxAdj, pEnd, BestTri);
+            VERIFY_EXPR(It != pEnd);
+            std::swap(*It, pEnd[-1]);
+            --NumActiveTris[v];
+        }
+
+        // Move the vertices of the triangle to the front of the cache. The vertices
+        // that are pushed past the cache size are evicted, but are still rescored.
+        Uint32 NewCache[VertexCacheSize + 3];
+        Uint32 NewCacheSize = 0;
+        for (Uint32 k = 0; k < 3; ++k)
+        {
+            if (std::find(NewCache, NewCache + NewCacheSize, Tri[k]) == NewCache + NewCacheSize)
+                NewCache[NewCacheSize++] = Tri[k];
+        }
+        for (Uint32 i = 0; i < CacheSize; ++i)
+        {
+            const auto v = Cache[i];
+            if (v != Tri[0] && v != Tri[1] && v != Tri[2])
+                NewCache[NewCacheSize++] = v;
+        }
+
+        for (Uint32 i = 0; i < NewCacheSize; ++i)
+        {
+            const auto v    = NewCache[i];
+            CachePos[v]     = i < VertexCacheSize ? static_cast<Int32>(i) : -1;
+            VertexScores[v] = Scores.Get(CachePos[v], NumActiveTris[v]);
+        }
+
+        BestTri   = NumTriangles;
+        BestScore = -1.f;
+        for (Uint32 i = 0; i < NewCacheSize; ++i)
+        {
+            const auto  v       = NewCache[i];
+            const auto* pVtxAdj = &AdjTris[AdjOffsets[v]];
+            for (Uint32 j = 0; j < NumActiveTris[v]; ++j)
+            {
+                const auto t = pVtxAdj[j];
+                TriScores[t] = GetTriScore(t);
+                if (TriScores[t] > BestScore)
+                {
+                    BestScore = TriScores[t];
+                    BestTri   = t;
+                }
+            }
+        }
+
+        CacheSize = std::min(NewCacheSize, VertexCacheSize);
+        std::copy(NewCache, NewCache + CacheSize, Cache);
+    }
+}
+
+const float3& GetPosition(const MeshletBuildAttribs& Attribs, Uint32 Index)
+{
+    return *reinterpret_cast<const float3*>(static_cast<const Uint8*>(Attribs.pPositions) + size_t{Index} * Attribs.PositionStride);
+}
+
+MeshletBounds ComputeMeshletBounds(const MeshletBuildAttribs& Attribs, const MeshletData& Data, const Meshlet& M)
+{
+    MeshletBounds Bounds;
+
+    const auto* pVertices = &Data.VertexIndices[M.VertexOffset];
+
+    float3 BoxMin = GetPosition(Attribs, pVertices[0]);
+    float3 BoxMax = BoxMin;
+    for (Uint32 i = 1; i < M.VertexCount; ++i)
+    {
+        const auto& Pos = GetPosition(Attribs, pVertices[i]);
+        BoxMin          = std::min(BoxMin, Pos);
+        BoxMax          = std::max(BoxMax, Pos);
+    }
+    Bounds.Center = (BoxMin + BoxMax) * 0.5f;
+
+    float MaxDistSq = 0;
+    for (Uint32 i = 0; i < M.VertexCount; ++i)
+    {
+        const auto Offset = GetPosition(Attribs, pVertices[i]) - Bounds.Center;
+        MaxDistSq         = std::max(MaxDistSq, dot(Offset, Offset));
+    }
+    Bounds.Radius = std::sqrt(MaxDistSq);
+
+    // Normal cone, see Zeux A., "Meshlet cone culling"
+    std::vector<float3> Normals;
+    std::vector<float3> Points;
+    Normals.reserve(M.TriangleCount);
+    Points.reserve(M.TriangleCount);
+    float3 AxisSum;
+    for (Uint32 t = 0; t < M.TriangleCount; ++t)
+    {
+        const auto   Packed = Data.PrimitiveIndices[M.TriangleOffset + t];
+        const auto&  P0     = GetPosition(Attribs, pVertices[Packed & 0xFFu]);
+        const auto&  P1     = GetPosition(Attribs, pVertices[(Packed >> 8u) & 0xFFu]);
+        const auto&  P2     = GetPosition(Attribs, pVertices[(Packed >> 16u) & 0xFFu]);
+        const float3 N      = cross(P1 - P0, P2 - P0);
+        const float  Len    = length(N);
+        // Degenerate triangles are not rasterized and do not affect the cone
+        if (Len == 0)
+            continue;
+
+        Normals.push_back(N / Len);
+        Points.push_back(P0);
+        AxisSum += Normals.back();
+    }
+
+    const float AxisLen = length(AxisSum);
+    if (Normals.empty() || AxisLen < 1e-6f)
+    {
+        Bounds.ConeApex = Bounds.Center;
+        return Bounds;
+    }
+    Bounds.ConeAxis = AxisSum / AxisLen;
+
+    float MinDot = 1;
+    for (const auto& N : Normals)
+        MinDot = std::min(MinDot, dot(N, Bounds.ConeAxis));
+
+    // The cone is too wide to ever cull the meshlet
+    if (MinDot <= 0.1f)
+    {
+        Bounds.ConeApex = Bounds.Center;
+        return Bounds;
+    }
+
+    // Move the apex back along the axis until it is behind the planes of all triangles
+    float MaxT = 0;
+    for (size_t i = 0; i < Normals.size(); ++i)
+    {
+        const float T = dot(Bounds.Center - Points[i], Normals[i]) / dot(Bounds.ConeAxis, Normals[i]);
+        MaxT          = std::max(MaxT, T);
+    }
+    Bounds.ConeApex   = Bounds.Center - Bounds.ConeAxis * MaxT;
+    Bounds.ConeCutoff = std::sqrt(1.f - MinDot * MinDot);
+
+    return Bounds;
+}
+
+void BuildChunkMeshlets(const MeshletBuildAttribs& Attribs, Uint32 FirstTriangle, Uint32 NumTriangles, MeshletData& Data)
+{
+    // Remap the vertices of the chunk to a compact range so that the per-vertex
+    // arrays do not depend on the size of the whole mesh
+    std::vector<Uint32>                LocalIndices(size_t{NumTriangles} * 3);
+    std::vector<Uint32>                LocalToGlobal;
+    std::unordered_map<Uint32, Uint32> GlobalToLocal;
+    GlobalToLocal.reserve(size_t{NumTriangles} * 3 / 2);
+    for (size_t i = 0; i < LocalIndices.size(); ++i)
+    {
+        const auto GlobalIdx = Attribs.pIndices[size_t{FirstTriangle} * 3 + i];
+        const auto it_ins    = GlobalToLocal.emplace(GlobalIdx, static_cast<Uint32>(LocalToGlobal.size()));
+        if (it_ins.second)
+            LocalToGlobal.push_back(GlobalIdx);
+        LocalIndices[i] = it_ins.first->second;
+    }
+    const auto NumLocalVertices = static_cast<Uint32>(LocalToGlobal.size());
+
+    if (Attribs.OptimizeVertexCache)
+    {
+        std::vector<Uint32> Optimized(LocalIndices.size());
+        OptimizeVertexCacheImpl(LocalIndices.data(), NumTriangles, NumLocalVertices, Optimized.data());
+        LocalIndices.swap(Optimized);
+    }
+
+    // The index of the meshlet that last referenced the vertex, and the vertex index in that meshlet
+    std::vector<Uint32> VertexMeshlet(NumLocalVertices, ~0u);
+    std::vector<Uint8>  VertexSlot(NumLocalVertices, 0);
+
+    Meshlet CurrMeshlet;
+    auto    CurrMeshletId = static_cast<Uint32>(Data.Meshlets.size());
+
+    auto CountNewVertices = [&](const Uint32* Tri) {
+        Uint32 NumNew = 0;
+        for (Uint32 k = 0; k < 3; ++k)
+        {
+            if (VertexMeshlet[Tri[k]] != CurrMeshletId && (k == 0 || Tri[k] != Tri[0]) && (k < 2 || Tri[k] != Tri[1]))
+                ++NumNew;
+        }
+        return NumNew;
+    };
+
+    auto FlushMeshlet = [&]() {
+        Data.Meshlets.push_back(CurrMeshlet);
+        CurrMeshlet.VertexOffset   = static_cast<Uint32>(Data.VertexIndices.size());
+        CurrMeshlet.TriangleOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+        CurrMeshlet.VertexCount    = 0;
+        CurrMeshlet.TriangleCount  = 0;
+        ++CurrMeshletId;
+    };
+
+    for (Uint32 t = 0; t < NumTriangles; ++t)
+    {
+        const auto* Tri = &LocalIndices[size_t{t} * 3];
+        if (CurrMeshlet.TriangleCount > 0 &&
+            (CurrMeshlet.VertexCount + CountNewVertices(Tri) > Attribs.MaxVertices || CurrMeshlet.TriangleCount == Attribs.MaxTriangles))
+        {
+            FlushMeshlet();
+        }
+
+        Uint32 Packed = 0;
+        for (Uint32 k = 0; k < 3; ++k)
+        {
+            const auto v = Tri[k];
+            if (VertexMeshlet[v] != CurrMeshletId)
+            {
+                VertexMeshlet[v] = CurrMeshletId;
+                VertexSlot[v]    = static_cast<Uint8>(CurrMeshlet.VertexCount++);
+                Data.VertexIndices.push_back(LocalToGlobal[v]);
+            }
+            Packed |= Uint32{VertexSlot[v]} << (k * 8u);
+        }
+        Data.PrimitiveIndices.push_back(Packed);
+        ++CurrMeshlet.TriangleCount;
+    }
+    if (CurrMeshlet.TriangleCount > 0)
+        Data.Meshlets.push_back(CurrMeshlet);
+
+    Data.Bounds.reserve(Data.Meshlets.size());
+    for (const auto& M : Data.Meshlets)
+        Data.Bounds.push_back(ComputeMeshletBounds(Attribs, Data, M));
+}
+
+} // namespace
+
+
+void OptimizeVertexCache(const Uint32* pIndices, Uint32 NumIndices, Uint32 NumVertices, Uint32* pDstIndices)
+{
+    DEV_CHECK_ERR(NumIndices % 3 == 0, "The number of indices (", NumIndices, ") must be a multiple of 3");
+    DEV_CHECK_ERR(NumIndices == 0 || (pIndices != nullptr && pDstIndices != nullptr), "Index pointers must not be null");
+    DEV_CHECK_ERR(pIndices != pDstIndices, "Source and destination indices must not overlap");
+#ifdef DILIGENT_DEVELOPMENT
+    for (Uint32 i = 0; i < NumIndices; ++i)
+        DEV_CHECK_ERR(pIndices[i] < NumVertices, "Index ", pIndices[i], " is out of range");
+#endif
+
+    OptimizeVertexCacheImpl(pIndices, NumIndices / 3, NumVertices, pDstIndices);
+}
+
+bool BuildMeshlets(const MeshletBuildAttribs& Attribs, MeshletData& Data)
+{
+    Data = MeshletData{};
+
+    if (Attribs.MaxVertices < 3 || Attribs.MaxVertices > 256)
+    {
+        LOG_ERROR_MESSAGE("The maximum number of meshlet vertices (", Attribs.MaxVertices, ") must be in range [3, 256]");
+        return false;
+    }
+    if (Attribs.MaxTriangles < 1 || Attribs.MaxTriangles > 256)
+    {
+        LOG_ERROR_MESSAGE("The maximum number of meshlet triangles (", Attribs.MaxTriangles, ") must be in range [1, 256]");
+        return false;
+    }
+    if (Attribs.NumIndices % 3 != 0)
+    {
+        LOG_ERROR_MESSAGE("The number of indices (", Attribs.NumIndices, ") must be a multiple of 3");
+        return false;
+    }
+    if (Attribs.NumIndices == 0)
+        return true;
+
+    DEV_CHECK_ERR(Attribs.pIndices != nullptr, "Indices must not be null");
+    DEV_CHECK_ERR(Attribs.pPositions != nullptr, "Positions must not be null");
+    DEV_CHECK_ERR(Attribs.PositionStride >= sizeof(float3), "Position stride (", Attribs.PositionStride, ") is too small");
+#ifdef DILIGENT_DEVELOPMENT
+    for (Uint32 i = 0; i < Attribs.NumIndices; ++i)
+        DEV_CHECK_ERR(Attribs.pIndices[i] < Attribs.NumVertices, "Index ", Attribs.pIndices[i], " is out of range");
+#endif
+
+    const auto NumTriangles = Attribs.NumIndices / 3;
+    const auto NumChunks    = (NumTriangles + TrianglesPerChunk - 1) / TrianglesPerChunk;
+
+    std::vector<MeshletData> Chunks(NumChunks);
+
+    auto ProcessChunk = [&Attribs, &Chunks, NumTriangles](Uint32 Chunk) {
+        const auto FirstTriangle = Chunk * TrianglesPerChunk;
+        BuildChunkMeshlets(Attribs, FirstTriangle, std::min(TrianglesPerChunk, NumTriangles - FirstTriangle), Chunks[Chunk]);
+    };
+
+    const auto NumTasks = Attribs.pThreadPool != nullptr ? std::min(Attribs.pThreadPool->GetThreadCount(), NumChunks - 1) : 0;
+    if (NumTasks == 0)
+    {
+        for (Uint32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+            ProcessChunk(Chunk);
+    }
+    else
+    {
+        // The state is shared with the tasks that may start after this function has returned.
+        // Such tasks find no chunks left and do not touch the data.
+        struct ParallelState
+        {
+            std::atomic<Uint32>     NextChunk{0};
+            std::atomic<Uint32>     NumChunksDone{0};
+            std::mutex              Mtx;
+            std::condition_variable ChunksDoneCV;
+        };
+        auto pState = std::make_shared<ParallelState>();
+
+        auto ProcessChunks = [pState, ProcessChunk, NumChunks]() {
+            for (auto Chunk = pState->NextChunk.fetch_add(1); Chunk < NumChunks; Chunk = pState->NextChunk.fetch_add(1))
+            {
+                ProcessChunk(Chunk);
+                if (pState->NumChunksDone.fetch_add(1) + 1 == NumChunks)
+                {
+                    std::lock_guard<std::mutex> Lock{pState->Mtx};
+                    pState->ChunksDoneCV.notify_all();
+                }
+            }
+        };
+
+        for (Uint32 i = 0; i < NumTasks; ++i)
+            EnqueueTask(Attribs.pThreadPool, ProcessChunks);
+
+        ProcessChunks();
+
+        std::unique_lock<std::mutex> Lock{pState->Mtx};
+        pState->ChunksDoneCV.wait(Lock, [&]() { return pState->NumChunksDone.load() == NumChunks; });
+    }
+
+    if (NumChunks == 1)
+    {
+        Data = std::move(Chunks[0]);
+        return true;
+    }
+
+    size_t NumMeshlets = 0, NumVertexIndices = 0, NumPrimitives = 0;
+    for (const auto& Chunk : Chunks)
+    {
+        NumMeshlets += Chunk.Meshlets.size();
+        NumVertexIndices += Chunk.VertexIndices.size();
+        NumPrimitives += Chunk.PrimitiveIndices.size();
+    }
+    Data.Meshlets.reserve(NumMeshlets);
+    Data.Bounds.reserve(NumMeshlets);
+    Data.VertexIndices.reserve(NumVertexIndices);
+    Data.PrimitiveIndices.reserve(NumPrimitives);
+
+    for (const auto& Chunk : Chunks)
+    {
+        const auto VertexOffset   = static_cast<Uint32>(Data.VertexIndices.size());
+        const auto TriangleOffset = static_cast<Uint32>(Data.PrimitiveIndices.size());
+        for (auto M : Chunk.Meshlets)
+        {
+            M.VertexOffset += VertexOffset;
+            M.TriangleOffset += TriangleOffset;
+            Data.Meshlets.push_back(M);
+        }
+        Data.Bounds.insert(Data.Bounds.end(), Chunk.Bounds.begin(), Chunk.Bounds.end());
+        Data.VertexIndices.insert(Data.VertexIndices.end(), Chunk.VertexIndices.begin(), Chunk.VertexIndices.end());
+        Data.PrimitiveIndices.insert(Data.PrimitiveIndices.end(), Chunk.PrimitiveIndices.begin(), Chunk.PrimitiveIndices.end());
+    }
+
+    return true;
+}
+
+void ComputeMeshletCullingConstants(const float4x4&          WorldViewProj,
+                                    const float3&            CameraPos,
+                                    Uint32                   NumMeshlets,
+                                    bool                     IsGL,
+                                    MeshletCullingConstants& Constants)
+{
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(WorldViewProj, Frustum, IsGL);
+    for (Uint32 i = 0; i < ViewFrustum::NUM_PLANES; ++i)
+    {
+        const auto& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(i));
+        // The planes are normalized so that the sphere radius can be compared with the distance
+        const auto InvLen          = 1.f / length(Plane.Normal);
+        Constants.FrustumPlanes[i] = float4{Plane.Normal * InvLen, Plane.Distance * InvLen};
+    }
+    Constants.CameraPos   = CameraPos;
+    Constants.NumMeshlets = NumMeshlets;
+}
+
+const char* GetMeshletCullingShaderSource()
+{
+    return g_MeshletCullingSource;
+}
+
+} // namespace Diligent
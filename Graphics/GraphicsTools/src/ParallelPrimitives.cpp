@@ -0,0 +1,486 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelPrimitives.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "DebugUtilities.hpp"
+#include "ShaderMacroHelper.hpp"
+#include "MapHelper.hpp"
+
+namespace Diligent
+{
+
+// clang-format off
+static const char* g_ParallelPrimitivesSource =
+{
+    #include "../shaders/ParallelPrimitives_inc.h"
+};
+// clang-format on
+
+namespace
+{
+
+// Must match the values in ParallelPrimitives.csh
+constexpr Uint32 ThreadGroupSize = 256;
+constexpr Uint32 ItemsPerThread  = 4;
+constexpr Uint32 BlockSize       = ThreadGroupSize * ItemsPerThread;
+constexpr Uint32 RadixBits       = 4;
+constexpr Uint32 RadixSize       = 1u << RadixBits;
+
+// The maximum number of thread groups in one dispatch dimension
+constexpr Uint32 MaxGroupsPerDim = 65535;
+
+// Per-wave results of a thread group must fit into a single wave,
+// so the wave size must be at least sqrt(ThreadGroupSize)
+constexpr Uint32 MinWaveSize = 16;
+static_assert(ThreadGroupSize / MinWaveSize <= MinWaveSize, "Per-wave results of a thread group do not fit into a single wave");
+
+enum SCRATCH_BUFFER : Uint32
+{
+    SCRATCH_BUFFER_COMPACT_INDICES,
+    SCRATCH_BUFFER_RADIX_KEYS,
+    SCRATCH_BUFFER_RADIX_VALUES,
+    SCRATCH_BUFFER_RADIX_HISTOGRAM,
+    SCRATCH_BUFFER_RADIX_SCANNED_HISTOGRAM,
+    SCRATCH_BUFFER_REDUCE0,
+    SCRATCH_BUFFER_REDUCE1,
+    // Every level of the recursive scan uses two buffers: block sums and scanned block sums
+    SCRATCH_BUFFER_SCAN_LEVELS
+};
+
+struct ShaderConstants
+{
+    Uint32 NumElements;
+    Uint32 NumGroupsX;
+    Uint32 RadixShift;
+    Uint32 NumBlocks;
+};
+
+inline Uint32 DivCeil(Uint32 Num, Uint32 Denom)
+{
+    return (Num + Denom - 1) / Denom;
+}
+
+#ifdef DILIGENT_DEVELOPMENT
+void VerifyBufferView(IBufferView* pView, BUFFER_VIEW_TYPE ExpectedType, Uint32 NumElements, const char* Name)
+{
+    DEV_CHECK_ERR(pView != nullptr, Name, " must not be null");
+    const auto& ViewDesc = pView->GetDesc();
+    DEV_CHECK_ERR(ViewDesc.ViewType == ExpectedType, Name, " must be ",
+                  (ExpectedType == BUFFER_VIEW_SHADER_RESOURCE ? "a shader resource view" : "an unordered access view"));
+    DEV_CHECK_ERR(ViewDesc.Format.ValueType == VT_UINT32 && ViewDesc.Format.NumComponents == 1,
+                  Name, " must be a formatted view with VT_UINT32 x 1 format");
+    DEV_CHECK_ERR(ViewDesc.ByteWidth / sizeof(Uint32) >= NumElements, Name, " is too small: ", NumElements,
+                  " elements are required, but the view contains only ", ViewDesc.ByteWidth / sizeof(Uint32));
+}
+#endif
+
+} // namespace
+
+ParallelPrimitives::ParallelPrimitives(IRenderDevice* pDevice, const ParallelPrimitivesCreateInfo& CI) :
+    m_pDevice{pDevice}
+{
+    DEV_CHECK_ERR(m_pDevice != nullptr, "Render device must not be null");
+
+    BufferDesc CBDesc;
+    CBDesc.Name           = "Parallel primitives constants";
+    CBDesc.uiSizeInBytes  = sizeof(ShaderConstants);
+    CBDesc.Usage          = USAGE_DYNAMIC;
+    CBDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    m_pDevice->CreateBuffer(CBDesc, nullptr, &m_pConstants);
+    if (!m_pConstants)
+        LOG_ERROR_AND_THROW("Failed to create parallel primitives constant buffer");
+
+    if (CI.EnableWaveOps)
+    {
+        const auto& DeviceInfo = m_pDevice->GetDeviceInfo();
+        const auto& WaveOpInfo = m_pDevice->GetAdapterInfo().WaveOp;
+        // The GLSL converter does not support wave intrinsics, and Direct3D11 does not support them at all
+        m_UseWaveOps =
+            DeviceInfo.Features.WaveOp &&
+            (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 || DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN) &&
+            (WaveOpInfo.SupportedStages & SHADER_TYPE_COMPUTE) != 0 &&
+            (WaveOpInfo.Features & WAVE_FEATURE_BASIC) != 0 &&
+            (WaveOpInfo.Features & WAVE_FEATURE_ARITHMETIC) != 0 &&
+            WaveOpInfo.MinSize >= MinWaveSize;
+    }
+
+    if (m_UseWaveOps && !CreateKernels(true))
+    {
+        LOG_WARNING_MESSAGE("Failed to create parallel primitives kernels that use wave operations. Group shared memory implementation will be used instead.");
+        m_UseWaveOps = false;
+    }
+
+    if (!m_UseWaveOps && !CreateKernels(false))
+        LOG_ERROR_AND_THROW("Failed to create parallel primitives kernels");
+}
+
+ParallelPrimitives::~ParallelPrimitives()
+{
+}
+
+bool ParallelPrimitives::CreateKernels(bool UseWaveOps)
+{
+    struct KernelInfo
+    {
+        const Char* Name;
+        const Char* Define;
+        const Char* EntryPoint;
+        Int32       ReduceOp;
+        bool        HasValues;
+    };
+    // clang-format off
+    static constexpr KernelInfo Kernels[] =
+    {
+        {"Parallel primitives - reduce sum",          "REDUCE",            "ReduceCS",          0, false},
+        {"Parallel primitives - reduce min",          "REDUCE",            "ReduceCS",          1, false},
+        {"Parallel primitives - reduce max",          "REDUCE",            "ReduceCS",          2, false},
+        {"Parallel primitives - scan blocks",         "SCAN_BLOCKS",       "ScanBlocksCS",      0, false},
+        {"Parallel primitives - add block offsets",   "ADD_BLOCK_OFFSETS", "AddBlockOffsetsCS", 0, false},
+        {"Parallel primitives - compact",             "COMPACT",           "CompactCS",         0, false},
+        {"Parallel primitives - radix histogram",     "RADIX_HISTOGRAM",   "RadixHistogramCS",  0, false},
+        {"Parallel primitives - radix scatter keys",  "RADIX_SCATTER",     "RadixScatterCS",    0, false},
+        {"Parallel primitives - radix scatter pairs", "RADIX_SCATTER",     "RadixScatterCS",    0, true}
+    };
+    // clang-format on
+    static_assert(_countof(Kernels) == KERNEL_COUNT, "Please update the kernel list");
+    static_assert(PARALLEL_REDUCE_OP_COUNT == 3, "Please update the reduce kernels");
+
+    const auto& DeviceInfo = m_pDevice->GetDeviceInfo();
+
+    std::array<Kernel, KERNEL_COUNT> NewKernels;
+    for (Uint32 k = 0; k < KERNEL_COUNT; ++k)
+    {
+        const auto& Info = Kernels[k];
+
+        ShaderMacroHelper Macros;
+        Macros.AddShaderMacro(Info.Define, 1);
+        Macros.AddShaderMacro("THREAD_GROUP_SIZE", ThreadGroupSize);
+        Macros.AddShaderMacro("ITEMS_PER_THREAD", ItemsPerThread);
+        Macros.AddShaderMacro("USE_WAVE_OPS", UseWaveOps ? 1 : 0);
+        Macros.AddShaderMacro("MIN_WAVE_SIZE", MinWaveSize);
+        Macros.AddShaderMacro("REDUCE_OP", Info.ReduceOp);
+        Macros.AddShaderMacro("HAS_VALUES", Info.HasValues ? 1 : 0);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Desc.Name       = Info.Name;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+        ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.Source          = g_ParallelPrimitivesSource;
+        ShaderCI.EntryPoint      = Info.EntryPoint;
+        ShaderCI.Macros          = Macros;
+        if (UseWaveOps && DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12)
+        {
+            // Wave intrinsics require shader model 6.0
+            ShaderCI.ShaderCompiler = SHADER_COMPILER_DXC;
+            ShaderCI.HLSLVersion    = {6, 0};
+        }
+
+        RefCntAutoPtr<IShader> pCS;
+        m_pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return false;
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name         = Info.Name;
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.pCS                  = pCS;
+
+        // Buffers are set before every dispatch
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_COMPUTE, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC}};
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        auto& NewKernel = NewKernels[k];
+        m_pDevice->CreateComputePipelineState(PSOCreateInfo, &NewKernel.pPSO);
+        if (!NewKernel.pPSO)
+            return false;
+
+        NewKernel.pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbConstants")->Set(m_pConstants);
+        NewKernel.pPSO->CreateShaderResourceBinding(&NewKernel.pSRB, true);
+        if (!NewKernel.pSRB)
+            return false;
+    }
+
+    m_Kernels = std::move(NewKernels);
+    return true;
+}
+
+// Returns a copy, so that the buffers remain valid when the scratch buffer list grows
+ParallelPrimitives::ScratchBuffer ParallelPrimitives::GetScratchBuffer(Uint32 Slot, Uint32 NumElements)
+{
+    if (Slot >= m_ScratchBuffers.size())
+        m_ScratchBuffers.resize(Slot + 1);
+
+    auto& Scratch = m_ScratchBuffers[Slot];
+    if (Scratch.pBuffer && Scratch.pBuffer->GetDesc().uiSizeInBytes >= NumElements * sizeof(Uint32))
+        return Scratch;
+
+    // Buffers that are still in use by the GPU are released when the GPU is done with them
+    Scratch = ScratchBuffer{};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Parallel primitives scratch buffer";
+    BuffDesc.uiSizeInBytes     = std::max(NumElements, BlockSize) * Uint32{sizeof(Uint32)};
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &Scratch.pBuffer);
+    VERIFY_EXPR(Scratch.pBuffer);
+
+    BufferViewDesc ViewDesc;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+
+    ViewDesc.Name     = "Parallel primitives scratch buffer SRV";
+    ViewDesc.ViewType = BUFFER_VIEW_SHADER_RESOURCE;
+    Scratch.pBuffer->CreateView(ViewDesc, &Scratch.pSRV);
+
+    ViewDesc.Name     = "Parallel primitives scratch buffer UAV";
+    ViewDesc.ViewType = BUFFER_VIEW_UNORDERED_ACCESS;
+    Scratch.pBuffer->CreateView(ViewDesc, &Scratch.pUAV);
+
+    return Scratch;
+}
+
+void ParallelPrimitives::SetVariable(KERNEL Kernel, const Char* Name, IBufferView* pView)
+{
+    auto* pVar = m_Kernels[Kernel].pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, Name);
+    VERIFY(pVar != nullptr, "Variable '", Name, "' is not found");
+    pVar->Set(pView);
+}
+
+void ParallelPrimitives::Dispatch(IDeviceContext* pContext, KERNEL Kernel, Uint32 NumGroups, Uint32 NumElements, Uint32 RadixShift, Uint32 NumBlocks)
+{
+    if (NumGroups == 0)
+        return;
+
+    // Large dispatches are split into two dimensions; the kernels skip extra groups
+    DispatchComputeAttribs DispatchAttribs;
+    DispatchAttribs.ThreadGroupCountX = std::min(NumGroups, MaxGroupsPerDim);
+    DispatchAttribs.ThreadGroupCountY = DivCeil(NumGroups, DispatchAttribs.ThreadGroupCountX);
+
+    {
+        MapHelper<ShaderConstants> Constants{pContext, m_pConstants, MAP_WRITE, MAP_FLAG_DISCARD};
+        Constants->NumElements = NumElements;
+        Constants->NumGroupsX  = DispatchAttribs.ThreadGroupCountX;
+        Constants->RadixShift  = RadixShift;
+        Constants->NumBlocks   = NumBlocks;
+    }
+
+    auto& Kern = m_Kernels[Kernel];
+    pContext->SetPipelineState(Kern.pPSO);
+    pContext->CommitShaderResources(Kern.pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->DispatchCompute(DispatchAttribs);
+}
+
+void ParallelPrimitives::Reduce(IDeviceContext*    pContext,
+                                IBufferView*       pInputSRV,
+                                IBufferView*       pResultUAV,
+                                Uint32             NumElements,
+                                PARALLEL_REDUCE_OP Op)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(Op < PARALLEL_REDUCE_OP_COUNT, "Unexpected reduce operation");
+#ifdef DILIGENT_DEVELOPMENT
+    VerifyBufferView(pInputSRV, BUFFER_VIEW_SHADER_RESOURCE, NumElements, "Input buffer view");
+    VerifyBufferView(pResultUAV, BUFFER_VIEW_UNORDERED_ACCESS, 1, "Result buffer view");
+#endif
+    if (NumElements == 0)
+        return;
+
+    const auto Kernel = static_cast<KERNEL>(KERNEL_REDUCE_SUM + Op);
+
+    // Every pass reduces each block to a single value until one value is left
+    auto*  pInput = pInputSRV;
+    Uint32 Pass   = 0;
+    while (true)
+    {
+        const auto NumGroups = DivCeil(NumElements, BlockSize);
+        SetVariable(Kernel, "g_Input", pInput);
+        if (NumGroups == 1)
+        {
+            SetVariable(Kernel, "g_Output", pResultUAV);
+            Dispatch(pContext, Kernel, NumGroups, NumElements);
+            break;
+        }
+
+        auto Partial = GetScratchBuffer(SCRATCH_BUFFER_REDUCE0 + (Pass & 0x01), NumGroups);
+        SetVariable(Kernel, "g_Output", Partial.pUAV);
+        Dispatch(pContext, Kernel, NumGroups, NumElements);
+
+        pInput      = Partial.pSRV;
+        NumElements = NumGroups;
+        ++Pass;
+    }
+}
+
+void ParallelPrimitives::ScanInternal(IDeviceContext* pContext, IBufferView* pInputSRV, IBufferView* pOutputUAV, Uint32 NumElements, Uint32 Level)
+{
+    const auto NumBlocks = DivCeil(NumElements, BlockSize);
+
+    auto BlockSums = GetScratchBuffer(SCRATCH_BUFFER_SCAN_LEVELS + Level * 2, NumBlocks);
+    SetVariable(KERNEL_SCAN_BLOCKS, "g_Input", pInputSRV);
+    SetVariable(KERNEL_SCAN_BLOCKS, "g_Output", pOutputUAV);
+    SetVariable(KERNEL_SCAN_BLOCKS, "g_BlockSums", BlockSums.pUAV);
+    Dispatch(pContext, KERNEL_SCAN_BLOCKS, NumBlocks, NumElements);
+
+    if (NumBlocks > 1)
+    {
+        // Scan block sums to get the offset of every block
+        auto BlockOffsets = GetScratchBuffer(SCRATCH_BUFFER_SCAN_LEVELS + Level * 2 + 1, NumBlocks);
+        ScanInternal(pContext, BlockSums.pSRV, BlockOffsets.pUAV, NumBlocks, Level + 1);
+
+        SetVariable(KERNEL_ADD_BLOCK_OFFSETS, "g_BlockOffsets", BlockOffsets.pSRV);
+        SetVariable(KERNEL_ADD_BLOCK_OFFSETS, "g_Output", pOutputUAV);
+        Dispatch(pContext, KERNEL_ADD_BLOCK_OFFSETS, NumBlocks, NumElements);
+    }
+}
+
+void ParallelPrimitives::ExclusiveScan(IDeviceContext* pContext,
+                                       IBufferView*    pInputSRV,
+                                       IBufferView*    pOutputUAV,
+                                       Uint32          NumElements)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+#ifdef DILIGENT_DEVELOPMENT
+    VerifyBufferView(pInputSRV, BUFFER_VIEW_SHADER_RESOURCE, NumElements, "Input buffer view");
+    VerifyBufferView(pOutputUAV, BUFFER_VIEW_UNORDERED_ACCESS, NumElements, "Output buffer view");
+    DEV_CHECK_ERR(pInputSRV->GetBuffer() != pOutputUAV->GetBuffer(), "Input and output buffer views must reference different buffers");
+#endif
+    if (NumElements == 0)
+        return;
+
+    ScanInternal(pContext, pInputSRV, pOutputUAV, NumElements, 0);
+}
+
+void ParallelPrimitives::Compact(IDeviceContext* pContext,
+                                 IBufferView*    pInputSRV,
+                                 IBufferView*    pFlagsSRV,
+                                 IBufferView*    pOutputUAV,
+                                 IBufferView*    pCountUAV,
+                                 Uint32          NumElements)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+#ifdef DILIGENT_DEVELOPMENT
+    VerifyBufferView(pInputSRV, BUFFER_VIEW_SHADER_RESOURCE, NumElements, "Input buffer view");
+    VerifyBufferView(pFlagsSRV, BUFFER_VIEW_SHADER_RESOURCE, NumElements, "Flags buffer view");
+    VerifyBufferView(pOutputUAV, BUFFER_VIEW_UNORDERED_ACCESS, 0, "Output buffer view");
+    VerifyBufferView(pCountUAV, BUFFER_VIEW_UNORDERED_ACCESS, 1, "Count buffer view");
+#endif
+    if (NumElements == 0)
+        return;
+
+    // The scanned flags are the destination indices of the selected elements
+    auto Indices = GetScratchBuffer(SCRATCH_BUFFER_COMPACT_INDICES, NumElements);
+    ScanInternal(pContext, pFlagsSRV, Indices.pUAV, NumElements, 0);
+
+    SetVariable(KERNEL_COMPACT, "g_Input", pInputSRV);
+    SetVariable(KERNEL_COMPACT, "g_Flags", pFlagsSRV);
+    SetVariable(KERNEL_COMPACT, "g_ScannedFlags", Indices.pSRV);
+    SetVariable(KERNEL_COMPACT, "g_Output", pOutputUAV);
+    SetVariable(KERNEL_COMPACT, "g_Count", pCountUAV);
+    Dispatch(pContext, KERNEL_COMPACT, DivCeil(NumElements, BlockSize), NumElements);
+}
+
+void ParallelPrimitives::RadixSort(IDeviceContext* pContext,
+                                   IBufferView*    pKeysUAV,
+                                   IBufferView*    pValuesUAV,
+                                   Uint32          NumElements,
+                                   Uint32          NumKeyBits)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(NumKeyBits > 0 && NumKeyBits <= 32, "The number of key bits (", NumKeyBits, ") must be in the range [1, 32]");
+#ifdef DILIGENT_DEVELOPMENT
+    VerifyBufferView(pKeysUAV, BUFFER_VIEW_UNORDERED_ACCESS, NumElements, "Keys buffer view");
+    if (pValuesUAV != nullptr)
+        VerifyBufferView(pValuesUAV, BUFFER_VIEW_UNORDERED_ACCESS, NumElements, "Values buffer view");
+#endif
+    if (NumElements <= 1)
+        return;
+
+    const auto NumBlocks = DivCeil(NumElements, ThreadGroupSize);
+    const auto NumPasses = DivCeil(NumKeyBits, RadixBits);
+    const auto Scatter   = pValuesUAV != nullptr ? KERNEL_RADIX_SCATTER_PAIRS : KERNEL_RADIX_SCATTER_KEYS;
+
+    auto ScratchKeys      = GetScratchBuffer(SCRATCH_BUFFER_RADIX_KEYS, NumElements);
+    auto Histogram        = GetScratchBuffer(SCRATCH_BUFFER_RADIX_HISTOGRAM, NumBlocks * RadixSize);
+    auto ScannedHistogram = GetScratchBuffer(SCRATCH_BUFFER_RADIX_SCANNED_HISTOGRAM, NumBlocks * RadixSize);
+    auto ScratchValues    = pValuesUAV != nullptr ? GetScratchBuffer(SCRATCH_BUFFER_RADIX_VALUES, NumElements) : ScratchBuffer{};
+
+    IBufferView* pSrcKeys   = pKeysUAV;
+    IBufferView* pDstKeys   = ScratchKeys.pUAV;
+    IBufferView* pSrcValues = pValuesUAV;
+    IBufferView* pDstValues = ScratchValues.pUAV;
+    for (Uint32 Pass = 0; Pass < NumPasses; ++Pass)
+    {
+        const auto RadixShift = Pass * RadixBits;
+
+        SetVariable(KERNEL_RADIX_HISTOGRAM, "g_KeysIn", pSrcKeys);
+        SetVariable(KERNEL_RADIX_HISTOGRAM, "g_BlockHistogram", Histogram.pUAV);
+        Dispatch(pContext, KERNEL_RADIX_HISTOGRAM, NumBlocks, NumElements, RadixShift, NumBlocks);
+
+        // The histogram is stored digit-major, so its prefix sum gives the global
+        // offset of every digit in every block
+        ScanInternal(pContext, Histogram.pSRV, ScannedHistogram.pUAV, NumBlocks * RadixSize, 0);
+
+        SetVariable(Scatter, "g_KeysIn", pSrcKeys);
+        SetVariable(Scatter, "g_KeysOut", pDstKeys);
+        if (pValuesUAV != nullptr)
+        {
+            SetVariable(Scatter, "g_ValuesIn", pSrcValues);
+            SetVariable(Scatter, "g_ValuesOut", pDstValues);
+        }
+        SetVariable(Scatter, "g_ScannedHistogram", ScannedHistogram.pSRV);
+        Dispatch(pContext, Scatter, NumBlocks, NumElements, RadixShift, NumBlocks);
+
+        std::swap(pSrcKeys, pDstKeys);
+        std::swap(pSrcValues, pDstValues);
+    }
+
+    if (pSrcKeys != pKeysUAV)
+    {
+        // Odd number of passes: the sorted data are in the scratch buffers
+        const auto DataSize = NumElements * Uint32{sizeof(Uint32)};
+        pContext->CopyBuffer(pSrcKeys->GetBuffer(), 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pKeysUAV->GetBuffer(), pKeysUAV->GetDesc().ByteOffset, DataSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        if (pValuesUAV != nullptr)
+        {
+            pContext->CopyBuffer(pSrcValues->GetBuffer(), 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                                 pValuesUAV->GetBuffer(), pValuesUAV->GetDesc().ByteOffset, DataSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,930 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr RESOURCE_STATE WriteResourceStates =
+    RESOURCE_STATE_RENDER_TARGET |
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_DEPTH_WRITE |
+    RESOURCE_STATE_STREAM_OUT |
+    RESOURCE_STATE_COPY_DEST |
+    RESOURCE_STATE_RESOLVE_DEST |
+    RESOURCE_STATE_BUILD_AS_WRITE;
+
+BIND_FLAGS ResourceStateToBindFlags(RESOURCE_STATE State)
+{
+    BIND_FLAGS BindFlags = BIND_NONE;
+    if (State & RESOURCE_STATE_RENDER_TARGET)
+        BindFlags |= BIND_RENDER_TARGET;
+    if (State & (RESOURCE_STATE_DEPTH_WRITE | RESOURCE_STATE_DEPTH_READ))
+        BindFlags |= BIND_DEPTH_STENCIL;
+    if (State & RESOURCE_STATE_SHADER_RESOURCE)
+        BindFlags |= BIND_SHADER_RESOURCE;
+    if (State & RESOURCE_STATE_UNORDERED_ACCESS)
+        BindFlags |= BIND_UNORDERED_ACCESS;
+    if (State & RESOURCE_STATE_INPUT_ATTACHMENT)
+        BindFlags |= BIND_INPUT_ATTACHMENT;
+    return BindFlags;
+}
+
+bool IsDepthFormat(TEXTURE_FORMAT Format)
+{
+    const auto ComponentType = GetTextureFormatAttribs(Format).ComponentType;
+    return ComponentType == COMPONENT_TYPE_DEPTH || ComponentType == COMPONENT_TYPE_DEPTH_STENCIL;
+}
+
+} // namespace
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(ResourceId Id, RESOURCE_STATE State)
+{
+    DEV_CHECK_ERR((State & WriteResourceStates) == 0, "Read access is declared with a writable state");
+    m_Graph.m_Passes[m_Id].Accesses.push_back({Id, State, false});
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(ResourceId Id, RESOURCE_STATE State)
+{
+    m_Graph.m_Passes[m_Id].Accesses.push_back({Id, State, true});
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SetRenderTarget(Uint32                     Index,
+                                                                    ResourceId                 Id,
+                                                                    ATTACHMENT_LOAD_OP         LoadOp,
+                                                                    const OptimizedClearValue* pClearValue)
+{
+    DEV_CHECK_ERR(Index < MAX_RENDER_TARGETS, "Render target index (", Index, ") is out of range");
+    auto& Pass = m_Graph.m_Passes[m_Id];
+
+    Pass.RenderTargets[Index] = m_Graph.MakeAttachment(Id, LoadOp, pClearValue, false);
+    Pass.NumRenderTargets     = std::max(Pass.NumRenderTargets, Index + 1);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SetDepthStencil(ResourceId                 Id,
+                                                                    ATTACHMENT_LOAD_OP         LoadOp,
+                                                                    const OptimizedClearValue* pClearValue,
+                                                                    bool                       ReadOnly)
+{
+    DEV_CHECK_ERR(!ReadOnly || LoadOp == ATTACHMENT_LOAD_OP_LOAD, "Read-only depth-stencil attachment must be loaded");
+    m_Graph.m_Passes[m_Id].DepthStencil = m_Graph.MakeAttachment(Id, LoadOp, pClearValue, ReadOnly);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::ReadInputAttachment(ResourceId Id)
+{
+    m_Graph.GetResource(Id); // Validate the id
+    m_Graph.m_Passes[m_Id].InputAttachments.push_back(Id);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::SetSideEffects()
+{
+    m_Graph.m_Passes[m_Id].HasSideEffects = true;
+    return *this;
+}
+
+
+RenderGraph::RenderGraph(IRenderDevice* pDevice, const RenderGraphCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_CreateInfo{CI}
+{
+    VERIFY_EXPR(m_pDevice);
+}
+
+RenderGraph::~RenderGraph()
+{
+}
+
+void RenderGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Groups.clear();
+    m_Barriers.clear();
+    m_IsCompiled = false;
+    m_Stats      = {};
+}
+
+RenderGraph::ResourceId RenderGraph::CreateTexture(const TextureDesc& Desc)
+{
+    ResourceInfo Res;
+    Res.TexDesc      = Desc;
+    Res.Name         = Desc.Name != nullptr ? Desc.Name : "Render graph transient texture";
+    Res.TexDesc.Name = nullptr;
+    Res.IsTransient  = true;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<ResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::ImportTexture(ITexture* pTexture)
+{
+    DEV_CHECK_ERR(pTexture != nullptr, "Imported texture must not be null");
+    ResourceInfo Res;
+    Res.TexDesc      = pTexture->GetDesc();
+    Res.Name         = Res.TexDesc.Name != nullptr ? Res.TexDesc.Name : "";
+    Res.TexDesc.Name = nullptr;
+    Res.pTexture     = pTexture;
+    Res.IsOutput     = true;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<ResourceId>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceId RenderGraph::ImportBuffer(IBuffer* pBuffer)
+{
+    DEV_CHECK_ERR(pBuffer != nullptr, "Imported buffer must not be null");
+    ResourceInfo Res;
+    Res.Name     = pBuffer->GetDesc().Name != nullptr ? pBuffer->GetDesc().Name : "";
+    Res.pBuffer  = pBuffer;
+    Res.IsOutput = true;
+    m_Resources.emplace_back(std::move(Res));
+    m_IsCompiled = false;
+    return static_cast<ResourceId>(m_Resources.size() - 1);
+}
+
+void RenderGraph::MarkOutput(ResourceId Id)
+{
+    GetResource(Id).IsOutput = true;
+    m_IsCompiled             = false;
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const char* Name, ExecuteCallbackType Execute)
+{
+    PassInfo Pass;
+    Pass.Name    = Name != nullptr ? Name : "";
+    Pass.Execute = std::move(Execute);
+    m_Passes.emplace_back(std::move(Pass));
+    m_IsCompiled = false;
+    return PassBuilder{*this, static_cast<PassId>(m_Passes.size() - 1)};
+}
+
+RenderGraph::ResourceInfo& RenderGraph::GetResource(ResourceId Id)
+{
+    DEV_CHECK_ERR(Id < m_Resources.size(), "Resource id (", Id, ") is out of range");
+    return m_Resources[Id];
+}
+
+const RenderGraph::ResourceInfo& RenderGraph::GetResource(ResourceId Id) const
+{
+    DEV_CHECK_ERR(Id < m_Resources.size(), "Resource id (", Id, ") is out of range");
+    return m_Resources[Id];
+}
+
+RenderGraph::AttachmentInfo RenderGraph::MakeAttachment(ResourceId Id, ATTACHMENT_LOAD_OP LoadOp, const OptimizedClearValue* pClearValue, bool ReadOnly) const
+{
+    DEV_CHECK_ERR(Id < m_Resources.size(), "Resource id (", Id, ") is out of range");
+    DEV_CHECK_ERR(m_Resources[Id].pBuffer == nullptr, "Buffer '", m_Resources[Id].Name, "' can't be used as an attachment");
+    DEV_CHECK_ERR(LoadOp != ATTACHMENT_LOAD_OP_CLEAR || pClearValue != nullptr, "Clear value must be provided when load operation is ATTACHMENT_LOAD_OP_CLEAR");
+
+    AttachmentInfo Attachment;
+    Attachment.Id       = Id;
+    Attachment.LoadOp   = LoadOp;
+    Attachment.ReadOnly = ReadOnly;
+    if (pClearValue != nullptr)
+        Attachment.ClearValue = *pClearValue;
+    return Attachment;
+}
+
+ITexture* RenderGraph::GetTexture(ResourceId Id) const
+{
+    return GetResource(Id).pTexture.RawPtr<ITexture>();
+}
+
+IBuffer* RenderGraph::GetBuffer(ResourceId Id) const
+{
+    return GetResource(Id).pBuffer.RawPtr<IBuffer>();
+}
+
+IRenderPass* RenderGraph::GetRenderPass(PassId Id, Uint32* pSubpassIndex) const
+{
+    DEV_CHECK_ERR(Id < m_Passes.size(), "Pass id (", Id, ") is out of range");
+    DEV_CHECK_ERR(m_IsCompiled, "The graph must be compiled");
+
+    const auto& Pass = m_Passes[Id];
+    if (Pass.Culled || Pass.GroupIndex == InvalidIndex)
+        return nullptr;
+
+    if (pSubpassIndex != nullptr)
+        *pSubpassIndex = Pass.SubpassIndex;
+    return m_Groups[Pass.GroupIndex].pRenderPass;
+}
+
+bool RenderGraph::IsPassCulled(PassId Id) const
+{
+    DEV_CHECK_ERR(Id < m_Passes.size(), "Pass id (", Id, ") is out of range");
+    return m_Passes[Id].Culled;
+}
+
+// Calls Handler(ResourceId Id, RESOURCE_STATE State, bool Reads, bool Writes, bool IsAttachment)
+// for every resource used by the pass.
+template <typename HandlerType>
+void RenderGraph::ProcessPassResources(const PassInfo& Pass, HandlerType&& Handler)
+{
+    for (const auto& Access : Pass.Accesses)
+        Handler(Access.Id, Access.State, !Access.Write, Access.Write, false);
+
+    for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+    {
+        const auto& RT = Pass.RenderTargets[rt];
+        if (RT.Id != InvalidResourceId)
+            Handler(RT.Id, RESOURCE_STATE_RENDER_TARGET, RT.LoadOp == ATTACHMENT_LOAD_OP_LOAD, true, true);
+    }
+
+    const auto& DS = Pass.DepthStencil;
+    if (DS.Id != InvalidResourceId)
+    {
+        if (DS.ReadOnly)
+            Handler(DS.Id, RESOURCE_STATE_DEPTH_READ, true, false, true);
+        else
+            Handler(DS.Id, RESOURCE_STATE_DEPTH_WRITE, DS.LoadOp == ATTACHMENT_LOAD_OP_LOAD, true, true);
+    }
+
+    for (auto Id : Pass.InputAttachments)
+        Handler(Id, RESOURCE_STATE_INPUT_ATTACHMENT, true, false, true);
+}
+
+void RenderGraph::CullPasses()
+{
+    for (auto& Res : m_Resources)
+        Res.RefCount = 0;
+
+    for (auto& Pass : m_Passes)
+    {
+        Pass.RefCount = 0;
+        Pass.Culled   = false;
+        ProcessPassResources(Pass, [&](ResourceId Id, RESOURCE_STATE, bool Reads, bool Writes, bool) {
+            if (Writes)
+                ++Pass.RefCount;
+            if (Reads)
+                ++m_Resources[Id].RefCount;
+        });
+    }
+
+    std::vector<ResourceId> UnusedResources;
+
+    auto CullPass = [&](PassInfo& Pass) {
+        Pass.Culled = true;
+        ProcessPassResources(Pass, [&](ResourceId Id, RESOURCE_STATE, bool Reads, bool, bool) {
+            if (!Reads)
+                return;
+            auto& Res = m_Resources[Id];
+            VERIFY_EXPR(Res.RefCount > 0);
+            if (--Res.RefCount == 0 && !Res.IsOutput)
+                UnusedResources.push_back(Id);
+        });
+    };
+
+    // Passes that produce nothing are culled right away
+    for (auto& Pass : m_Passes)
+    {
+        if (Pass.RefCount == 0 && !Pass.HasSideEffects)
+            CullPass(Pass);
+    }
+
+    for (ResourceId Id = 0; Id < m_Resources.size(); ++Id)
+    {
+        const auto& Res = m_Resources[Id];
+        if (Res.RefCount == 0 && !Res.IsOutput)
+            UnusedResources.push_back(Id);
+    }
+
+    while (!UnusedResources.empty())
+    {
+        const auto UnusedId = UnusedResources.back();
+        UnusedResources.pop_back();
+
+        // Release the writers of the unused resource
+        for (auto& Pass : m_Passes)
+        {
+            if (Pass.Culled)
+                continue;
+
+            ProcessPassResources(Pass, [&](ResourceId Id, RESOURCE_STATE, bool, bool Writes, bool) {
+                if (Writes && Id == UnusedId)
+                {
+                    VERIFY_EXPR(Pass.RefCount > 0);
+                    --Pass.RefCount;
+                }
+            });
+
+            if (Pass.RefCount == 0 && !Pass.HasSideEffects)
+                CullPass(Pass);
+        }
+    }
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+    for (auto& Res : m_Resources)
+    {
+        Res.FirstPass = InvalidIndex;
+        Res.LastPass  = 0;
+    }
+
+    for (Uint32 p = 0; p < m_Passes.size(); ++p)
+    {
+        const auto& Pass = m_Passes[p];
+        if (Pass.Culled)
+            continue;
+
+        ProcessPassResources(Pass, [&](ResourceId Id, RESOURCE_STATE State, bool, bool, bool) {
+            auto& Res = m_Resources[Id];
+            if (Res.FirstPass == InvalidIndex)
+                Res.FirstPass = p;
+            Res.LastPass = p;
+            if (Res.IsTransient)
+                Res.TexDesc.BindFlags |= ResourceStateToBindFlags(State);
+        });
+    }
+}
+
+void RenderGraph::AllocateTransientTextures()
+{
+    for (auto& Pooled : m_TexturePool)
+        Pooled.BusyUntilPass = InvalidIndex;
+
+    std::vector<ResourceId> TransientResources;
+    for (ResourceId Id = 0; Id < m_Resources.size(); ++Id)
+    {
+        auto& Res = m_Resources[Id];
+        if (!Res.IsTransient)
+            continue;
+
+        Res.pTexture.Release();
+        if (Res.FirstPass != InvalidIndex)
+            TransientResources.push_back(Id);
+    }
+
+    std::sort(TransientResources.begin(), TransientResources.end(),
+              [this](ResourceId Id0, ResourceId Id1) {
+                  return m_Resources[Id0].FirstPass < m_Resources[Id1].FirstPass;
+              });
+
+    Uint32 NumTextureObjects = 0;
+    for (auto Id : TransientResources)
+    {
+        auto& Res = m_Resources[Id];
+
+        // Find a pooled texture with the same description that is no longer used by the preceding passes
+        auto It = std::find_if(m_TexturePool.begin(), m_TexturePool.end(),
+                               [&Res](const PooledTexture& Pooled) {
+                                   return (Pooled.BusyUntilPass == InvalidIndex || Pooled.BusyUntilPass < Res.FirstPass) &&
+                                       Pooled.pTexture->GetDesc() == Res.TexDesc;
+                               });
+        if (It == m_TexturePool.end())
+        {
+            auto Desc = Res.TexDesc;
+            Desc.Name = Res.Name.c_str();
+
+            PooledTexture Pooled;
+            m_pDevice->CreateTexture(Desc, nullptr, &Pooled.pTexture);
+            if (!Pooled.pTexture)
+            {
+                LOG_ERROR_MESSAGE("Failed to create transient texture '", Res.Name, "'");
+                continue;
+            }
+            It = m_TexturePool.emplace(m_TexturePool.end(), std::move(Pooled));
+        }
+
+        if (It->BusyUntilPass == InvalidIndex)
+            ++NumTextureObjects;
+        It->BusyUntilPass = Res.LastPass;
+        It->UnusedAge     = 0;
+        Res.pTexture      = It->pTexture;
+    }
+
+    // Release textures that have not been used for a while
+    m_TexturePool.erase(std::remove_if(m_TexturePool.begin(), m_TexturePool.end(),
+                                       [this](PooledTexture& Pooled) {
+                                           if (Pooled.BusyUntilPass != InvalidIndex)
+                                               return false;
+                                           return ++Pooled.UnusedAge > m_CreateInfo.MaxUnusedTextureAge;
+                                       }),
+                        m_TexturePool.end());
+
+    m_Stats.NumTransientTextures = static_cast<Uint32>(TransientResources.size());
+    m_Stats.NumTextureObjects    = NumTextureObjects;
+}
+
+void RenderGraph::AddPassToGroup(PassGroup& Group, PassId Id)
+{
+    auto& Pass = m_Passes[Id];
+
+    Pass.GroupIndex   = static_cast<Uint32>(m_Groups.size() - 1);
+    Pass.SubpassIndex = static_cast<Uint32>(Group.Passes.size());
+    Group.Passes.push_back(Id);
+
+    ProcessPassResources(Pass, [&](ResourceId ResId, RESOURCE_STATE State, bool, bool Writes, bool IsAttachment) {
+        if (IsAttachment)
+        {
+            if (std::find(Group.Attachments.begin(), Group.Attachments.end(), ResId) == Group.Attachments.end())
+                Group.Attachments.push_back(ResId);
+        }
+        else
+        {
+            auto It = std::find_if(Group.Accesses.begin(), Group.Accesses.end(),
+                                   [ResId](const ResourceAccess& Access) { return Access.Id == ResId; });
+            if (It == Group.Accesses.end())
+            {
+                Group.Accesses.push_back({ResId, State, Writes});
+            }
+            else
+            {
+                It->State |= State;
+                It->Write = It->Write || Writes;
+            }
+        }
+    });
+}
+
+bool RenderGraph::CanMergePass(const PassGroup& Group, const PassInfo& Pass) const
+{
+    VERIFY_EXPR(Group.IsRaster && !Group.Attachments.empty());
+
+    const auto* pRefTexture = GetResource(Group.Attachments.front()).pTexture.RawPtr();
+    if (pRefTexture == nullptr)
+        return false;
+    const auto& RefDesc = pRefTexture->GetDesc();
+
+    bool CanMerge = true;
+    ProcessPassResources(Pass, [&](ResourceId Id, RESOURCE_STATE State, bool, bool Writes, bool IsAttachment) {
+        if (!CanMerge)
+            return;
+
+        auto AccessIt = std::find_if(Group.Accesses.begin(), Group.Accesses.end(),
+                                     [Id](const ResourceAccess& Access) { return Access.Id == Id; });
+        if (IsAttachment)
+        {
+            const auto* pTexture = GetResource(Id).pTexture.RawPtr();
+            if (pTexture == nullptr)
+            {
+                CanMerge = false;
+                return;
+            }
+
+            // All subpasses must render to the same area with the same sample count
+            const auto& Desc = pTexture->GetDesc();
+            if (Desc.Width != RefDesc.Width || Desc.Height != RefDesc.Height || Desc.SampleCount != RefDesc.SampleCount)
+                CanMerge = false;
+
+            // The resource is bound as a shader resource or UAV by another subpass
+            if (AccessIt != Group.Accesses.end())
+                CanMerge = false;
+        }
+        else
+        {
+            // Attachments can't be accessed through other views within the same render pass
+            if (std::find(Group.Attachments.begin(), Group.Attachments.end(), Id) != Group.Attachments.end())
+                CanMerge = false;
+
+            // State transitions are not allowed inside a render pass
+            if (AccessIt != Group.Accesses.end() && (Writes || AccessIt->Write || AccessIt->State != State))
+                CanMerge = false;
+        }
+    });
+
+    // Attachments that are already used by the render pass can't be cleared or discarded again
+    auto IsLoadedAttachment = [&](const AttachmentInfo& Attachment) {
+        return Attachment.Id == InvalidResourceId ||
+            Attachment.LoadOp == ATTACHMENT_LOAD_OP_LOAD ||
+            std::find(Group.Attachments.begin(), Group.Attachments.end(), Attachment.Id) == Group.Attachments.end();
+    };
+    for (Uint32 rt = 0; rt < Pass.NumRenderTargets && CanMerge; ++rt)
+        CanMerge = IsLoadedAttachment(Pass.RenderTargets[rt]);
+    if (CanMerge)
+        CanMerge = IsLoadedAttachment(Pass.DepthStencil);
+
+    return CanMerge;
+}
+
+void RenderGraph::CreateRenderPass(PassGroup& Group)
+{
+    const auto NumAttachments = static_cast<Uint32>(Group.Attachments.size());
+    const auto NumSubpasses   = static_cast<Uint32>(Group.Passes.size());
+
+    Group.pRenderPass = nullptr;
+    for (auto Id : Group.Attachments)
+    {
+        // The texture failed to be created
+        if (!GetResource(Id).pTexture)
+            return;
+    }
+
+    std::vector<RenderPassAttachmentDesc> Attachments(NumAttachments);
+    std::vector<Uint32>                   FirstSubpass(NumAttachments, InvalidIndex);
+    std::vector<Uint32>                   LastSubpass(NumAttachments, 0);
+
+    Group.ClearValues.clear();
+    Group.ClearValues.resize(NumAttachments);
+
+    std::vector<std::vector<AttachmentReference>> RenderTargetRefs(NumSubpasses);
+    std::vector<std::vector<AttachmentReference>> InputRefs(NumSubpasses);
+    std::vector<AttachmentReference>              DepthStencilRefs(NumSubpasses);
+    std::vector<std::vector<Uint32>>              PreserveRefs(NumSubpasses);
+    // Attachments used by each subpass and whether they are written
+    std::vector<std::vector<std::pair<Uint32, bool>>> SubpassUses(NumSubpasses);
+
+    for (Uint32 s = 0; s < NumSubpasses; ++s)
+    {
+        const auto& Pass = m_Passes[Group.Passes[s]];
+
+        auto UseAttachment = [&](const AttachmentInfo* pInfo, ResourceId Id, RESOURCE_STATE State, bool Writes) {
+            const auto Idx = static_cast<Uint32>(std::find(Group.Attachments.begin(), Group.Attachments.end(), Id) - Group.Attachments.begin());
+            VERIFY_EXPR(Idx < NumAttachments);
+
+            auto& Attachment = Attachments[Idx];
+            if (FirstSubpass[Idx] == InvalidIndex)
+            {
+                const auto& TexDesc = GetResource(Id).pTexture->GetDesc();
+
+                FirstSubpass[Idx]        = s;
+                Attachment.Format        = TexDesc.Format;
+                Attachment.SampleCount   = static_cast<Uint8>(TexDesc.SampleCount);
+                Attachment.LoadOp        = pInfo != nullptr ? pInfo->LoadOp : ATTACHMENT_LOAD_OP_LOAD;
+                Attachment.StencilLoadOp = Attachment.LoadOp;
+                Attachment.InitialState  = State;
+                if (pInfo != nullptr && pInfo->LoadOp == ATTACHMENT_LOAD_OP_CLEAR)
+                    Group.ClearValues[Idx] = pInfo->ClearValue;
+            }
+            LastSubpass[Idx]      = s;
+            Attachment.FinalState = State;
+            SubpassUses[s].emplace_back(Idx, Writes);
+            return Idx;
+        };
+
+        auto& RTRefs = RenderTargetRefs[s];
+        RTRefs.resize(Pass.NumRenderTargets);
+        for (Uint32 rt = 0; rt < Pass.NumRenderTargets; ++rt)
+        {
+            const auto& RT = Pass.RenderTargets[rt];
+            if (RT.Id != InvalidResourceId)
+                RTRefs[rt] = {UseAttachment(&RT, RT.Id, RESOURCE_STATE_RENDER_TARGET, true), RESOURCE_STATE_RENDER_TARGET};
+            else
+                RTRefs[rt] = {ATTACHMENT_UNUSED, RESOURCE_STATE_UNKNOWN};
+        }
+
+        const auto& DS = Pass.DepthStencil;
+        if (DS.Id != InvalidResourceId)
+        {
+            const auto State    = DS.ReadOnly ? RESOURCE_STATE_DEPTH_READ : RESOURCE_STATE_DEPTH_WRITE;
+            DepthStencilRefs[s] = {UseAttachment(&DS, DS.Id, State, !DS.ReadOnly), State};
+        }
+
+        for (auto Id : Pass.InputAttachments)
+            InputRefs[s].push_back({UseAttachment(nullptr, Id, RESOURCE_STATE_INPUT_ATTACHMENT, false), RESOURCE_STATE_INPUT_ATTACHMENT});
+    }
+
+    const auto LastGroupPass = Group.Passes.back();
+    for (Uint32 i = 0; i < NumAttachments; ++i)
+    {
+        // Contents only need to be stored if they are used after the render pass
+        const auto& Res    = GetResource(Group.Attachments[i]);
+        const auto  Store  = Res.IsOutput || Res.LastPass > LastGroupPass;
+        auto&       Att    = Attachments[i];
+        Att.StoreOp        = Store ? ATTACHMENT_STORE_OP_STORE : ATTACHMENT_STORE_OP_DISCARD;
+        Att.StencilStoreOp = Att.StoreOp;
+
+        // Preserve the attachment in subpasses that do not use it
+        for (Uint32 s = FirstSubpass[i] + 1; s < NumSubpasses; ++s)
+        {
+            if (s > LastSubpass[i] && !Store)
+                break;
+
+            const auto& Uses = SubpassUses[s];
+            if (std::find_if(Uses.begin(), Uses.end(), [i](const std::pair<Uint32, bool>& Use) { return Use.first == i; }) == Uses.end())
+                PreserveRefs[s].push_back(i);
+        }
+    }
+
+    std::vector<SubpassDesc> Subpasses(NumSubpasses);
+    for (Uint32 s = 0; s < NumSubpasses; ++s)
+    {
+        auto& Subpass = Subpasses[s];
+
+        Subpass.RenderTargetAttachmentCount = static_cast<Uint32>(RenderTargetRefs[s].size());
+        Subpass.pRenderTargetAttachments    = RenderTargetRefs[s].data();
+        Subpass.InputAttachmentCount        = static_cast<Uint32>(InputRefs[s].size());
+        Subpass.pInputAttachments           = InputRefs[s].data();
+        Subpass.PreserveAttachmentCount     = static_cast<Uint32>(PreserveRefs[s].size());
+        Subpass.pPreserveAttachments        = PreserveRefs[s].data();
+        if (DepthStencilRefs[s].State != RESOURCE_STATE_UNKNOWN)
+            Subpass.pDepthStencilAttachment = &DepthStencilRefs[s];
+    }
+
+    // Add a dependency between every pair of subpasses where the first one writes an attachment
+    // that the second one uses
+    std::vector<SubpassDependencyDesc> Dependencies;
+    for (Uint32 dst = 1; dst < NumSubpasses; ++dst)
+    {
+        for (Uint32 src = 0; src < dst; ++src)
+        {
+            bool HasDependency = false;
+            for (const auto& SrcUse : SubpassUses[src])
+            {
+                if (!SrcUse.second)
+                    continue;
+                for (const auto& DstUse : SubpassUses[dst])
+                    HasDependency = HasDependency || DstUse.first == SrcUse.first;
+            }
+            if (!HasDependency)
+                continue;
+
+            SubpassDependencyDesc Dependency;
+            Dependency.SrcSubpass    = src;
+            Dependency.DstSubpass    = dst;
+            Dependency.SrcStageMask  = PIPELINE_STAGE_FLAG_RENDER_TARGET | PIPELINE_STAGE_FLAG_LATE_FRAGMENT_TESTS;
+            Dependency.DstStageMask  = PIPELINE_STAGE_FLAG_PIXEL_SHADER | PIPELINE_STAGE_FLAG_EARLY_FRAGMENT_TESTS | PIPELINE_STAGE_FLAG_LATE_FRAGMENT_TESTS | PIPELINE_STAGE_FLAG_RENDER_TARGET;
+            Dependency.SrcAccessMask = ACCESS_FLAG_RENDER_TARGET_WRITE | ACCESS_FLAG_DEPTH_STENCIL_WRITE;
+            Dependency.DstAccessMask = ACCESS_FLAG_INPUT_ATTACHMENT_READ | ACCESS_FLAG_SHADER_READ |
+                ACCESS_FLAG_RENDER_TARGET_READ | ACCESS_FLAG_RENDER_TARGET_WRITE |
+                ACCESS_FLAG_DEPTH_STENCIL_READ | ACCESS_FLAG_DEPTH_STENCIL_WRITE;
+            Dependencies.push_back(Dependency);
+        }
+    }
+
+    // Render passes with identical descriptions are shared
+    std::vector<Uint32> Key;
+    Key.push_back(NumAttachments);
+    for (const auto& Att : Attachments)
+    {
+        Key.insert(Key.end(),
+                   {
+                       static_cast<Uint32>(Att.Format),
+                       static_cast<Uint32>(Att.SampleCount),
+                       static_cast<Uint32>(Att.LoadOp),
+                       static_cast<Uint32>(Att.StoreOp),
+                       static_cast<Uint32>(Att.InitialState),
+                       static_cast<Uint32>(Att.FinalState),
+                   });
+    }
+    Key.push_back(NumSubpasses);
+    for (Uint32 s = 0; s < NumSubpasses; ++s)
+    {
+        auto AddRefs = [&Key](const std::vector<AttachmentReference>& Refs) {
+            Key.push_back(static_cast<Uint32>(Refs.size()));
+            for (const auto& Ref : Refs)
+                Key.insert(Key.end(), {Ref.AttachmentIndex, static_cast<Uint32>(Ref.State)});
+        };
+        AddRefs(RenderTargetRefs[s]);
+        AddRefs(InputRefs[s]);
+        Key.insert(Key.end(), {DepthStencilRefs[s].AttachmentIndex, static_cast<Uint32>(DepthStencilRefs[s].State)});
+        Key.push_back(static_cast<Uint32>(PreserveRefs[s].size()));
+        Key.insert(Key.end(), PreserveRefs[s].begin(), PreserveRefs[s].end());
+    }
+    // Dependency masks are the same for all dependencies
+    for (const auto& Dependency : Dependencies)
+        Key.push_back(Dependency.SrcSubpass | (Dependency.DstSubpass << 16u));
+
+    auto& pRenderPass = m_RenderPassCache[Key];
+    if (!pRenderPass)
+    {
+        const auto Name = std::string{"Render graph render pass: "} + m_Passes[Group.Passes.front()].Name;
+
+        RenderPassDesc RPDesc;
+        RPDesc.Name            = Name.c_str();
+        RPDesc.AttachmentCount = NumAttachments;
+        RPDesc.pAttachments    = Attachments.data();
+        RPDesc.SubpassCount    = NumSubpasses;
+        RPDesc.pSubpasses      = Subpasses.data();
+        RPDesc.DependencyCount = static_cast<Uint32>(Dependencies.size());
+        RPDesc.pDependencies   = Dependencies.data();
+        m_pDevice->CreateRenderPass(RPDesc, &pRenderPass);
+        if (!pRenderPass)
+            LOG_ERROR_MESSAGE("Failed to create render pass '", Name, "'");
+    }
+    Group.pRenderPass = pRenderPass;
+}
+
+void RenderGraph::CreateFramebuffer(PassGroup& Group, std::map<std::vector<void*>, RefCntAutoPtr<IFramebuffer>>& FramebufferCache)
+{
+    if (Group.pRenderPass == nullptr)
+        return;
+
+    std::vector<ITextureView*> Views;
+    Views.reserve(Group.Attachments.size());
+    for (auto Id : Group.Attachments)
+    {
+        auto*       pTexture = GetResource(Id).pTexture.RawPtr();
+        const auto& TexDesc  = pTexture->GetDesc();
+
+        TEXTURE_VIEW_TYPE ViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+        if (IsDepthFormat(TexDesc.Format))
+            ViewType = TEXTURE_VIEW_DEPTH_STENCIL;
+        else if (TexDesc.BindFlags & BIND_RENDER_TARGET)
+            ViewType = TEXTURE_VIEW_RENDER_TARGET;
+
+        auto* pView = pTexture->GetDefaultView(ViewType);
+        DEV_CHECK_ERR(pView != nullptr, "Texture '", GetResource(Id).Name, "' does not have a default view that can be used as an attachment");
+        Views.push_back(pView);
+    }
+
+    std::vector<void*> Key;
+    Key.reserve(Views.size() + 1);
+    Key.push_back(Group.pRenderPass);
+    Key.insert(Key.end(), Views.begin(), Views.end());
+
+    auto& pFramebuffer = FramebufferCache[Key];
+    if (!pFramebuffer)
+    {
+        auto It = m_FramebufferCache.find(Key);
+        if (It != m_FramebufferCache.end())
+        {
+            pFramebuffer = It->second;
+        }
+        else
+        {
+            const auto Name = std::string{"Render graph framebuffer: "} + m_Passes[Group.Passes.front()].Name;
+
+            FramebufferDesc FBDesc;
+            FBDesc.Name            = Name.c_str();
+            FBDesc.pRenderPass     = Group.pRenderPass;
+            FBDesc.AttachmentCount = static_cast<Uint32>(Views.size());
+            FBDesc.ppAttachments   = Views.data();
+            m_pDevice->CreateFramebuffer(FBDesc, &pFramebuffer);
+            if (!pFramebuffer)
+                LOG_ERROR_MESSAGE("Failed to create framebuffer '", Name, "'");
+        }
+    }
+    Group.pFramebuffer = pFramebuffer;
+}
+
+void RenderGraph::GroupPasses()
+{
+    m_Groups.clear();
+
+    for (PassId Id = 0; Id < m_Passes.size(); ++Id)
+    {
+        auto& Pass = m_Passes[Id];
+
+        Pass.GroupIndex   = InvalidIndex;
+        Pass.SubpassIndex = 0;
+        if (Pass.Culled)
+            continue;
+
+        const auto IsRaster = Pass.IsRasterPass();
+        if (IsRaster && m_CreateInfo.MergeRenderPasses && !m_Groups.empty() && m_Groups.back().IsRaster && CanMergePass(m_Groups.back(), Pass))
+        {
+            AddPassToGroup(m_Groups.back(), Id);
+            ++m_Stats.NumMergedPasses;
+        }
+        else
+        {
+            m_Groups.emplace_back();
+            m_Groups.back().IsRaster = IsRaster;
+            AddPassToGroup(m_Groups.back(), Id);
+        }
+    }
+
+    // Framebuffers that are no longer used are released
+    std::map<std::vector<void*>, RefCntAutoPtr<IFramebuffer>> FramebufferCache;
+    for (auto& Group : m_Groups)
+    {
+        if (!Group.IsRaster)
+            continue;
+
+        ++m_Stats.NumRenderPasses;
+        CreateRenderPass(Group);
+        CreateFramebuffer(Group, FramebufferCache);
+    }
+    m_FramebufferCache.swap(FramebufferCache);
+}
+
+void RenderGraph::Compile()
+{
+    m_Stats = {};
+
+    for (const auto& Pass : m_Passes)
+    {
+        ProcessPassResources(Pass, [this](ResourceId Id, RESOURCE_STATE, bool, bool, bool IsAttachment) {
+            DEV_CHECK_ERR(Id < m_Resources.size(), "Resource id (", Id, ") is out of range");
+            DEV_CHECK_ERR(!IsAttachment || m_Resources[Id].pBuffer == nullptr, "Buffers can't be used as attachments");
+        });
+    }
+
+    CullPasses();
+    ComputeLifetimes();
+    AllocateTransientTextures();
+    GroupPasses();
+
+    m_Stats.NumPasses = static_cast<Uint32>(m_Passes.size());
+    for (const auto& Pass : m_Passes)
+    {
+        if (Pass.Culled)
+            ++m_Stats.NumCulledPasses;
+    }
+
+    m_IsCompiled = true;
+}
+
+void RenderGraph::Execute(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    if (!m_IsCompiled)
+        Compile();
+
+    m_Stats.NumBarriers = 0;
+    for (const auto& Group : m_Groups)
+    {
+        // Transition resources that are not attachments. Attachments are transitioned by the render pass.
+        m_Barriers.clear();
+        for (const auto& Access : Group.Accesses)
+        {
+            const auto& Res = m_Resources[Access.Id];
+            if (std::find(Group.Attachments.begin(), Group.Attachments.end(), Access.Id) != Group.Attachments.end())
+                continue;
+
+            const auto CurrState = Res.pTexture ? Res.pTexture->GetState() : (Res.pBuffer ? Res.pBuffer->GetState() : RESOURCE_STATE_UNKNOWN);
+            // Resources in unknown state are managed by the application
+            if (CurrState == RESOURCE_STATE_UNKNOWN)
+                continue;
+
+            // Read-only states can be combined, writes always require a barrier
+            if (!Access.Write && (CurrState & Access.State) == Access.State && (CurrState & WriteResourceStates) == 0)
+                continue;
+
+            if (Res.pTexture)
+                m_Barriers.emplace_back(Res.pTexture.RawPtr<ITexture>(), RESOURCE_STATE_UNKNOWN, Access.State, true);
+            else
+                m_Barriers.emplace_back(Res.pBuffer.RawPtr<IBuffer>(), RESOURCE_STATE_UNKNOWN, Access.State, true);
+        }
+
+        if (!m_Barriers.empty())
+        {
+            pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size()), m_Barriers.data());
+            m_Stats.NumBarriers += static_cast<Uint32>(m_Barriers.size());
+        }
+
+        if (Group.IsRaster)
+        {
+            if (Group.pRenderPass == nullptr || Group.pFramebuffer == nullptr)
+                continue;
+
+            BeginRenderPassAttribs BeginInfo;
+            BeginInfo.pRenderPass         = Group.pRenderPass;
+            BeginInfo.pFramebuffer        = Group.pFramebuffer.RawPtr<IFramebuffer>();
+            BeginInfo.ClearValueCount     = static_cast<Uint32>(Group.ClearValues.size());
+            BeginInfo.pClearValues        = const_cast<OptimizedClearValue*>(Group.ClearValues.data());
+            BeginInfo.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+            pContext->BeginRenderPass(BeginInfo);
+
+            for (size_t s = 0; s < Group.Passes.size(); ++s)
+            {
+                if (s > 0)
+                    pContext->NextSubpass();
+
+                const auto& Pass = m_Passes[Group.Passes[s]];
+                if (Pass.Execute)
+                    Pass.Execute(*this, pContext);
+            }
+
+            pContext->EndRenderPass();
+        }
+        else
+        {
+            VERIFY_EXPR(Group.Passes.size() == 1);
+            const auto& Pass = m_Passes[Group.Passes.front()];
+            if (Pass.Execute)
+                Pass.Execute(*this, pContext);
+        }
+    }
+}
+
+} // namespace Diligent
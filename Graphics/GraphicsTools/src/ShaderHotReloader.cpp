@@ -0,0 +1,670 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderHotReloader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "FileSystem.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "DebugUtilities.hpp"
+#include "PipelineStateCreateInfoCopy.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Converts the path to the form that is used to match modified files with shader dependencies
+String NormalizePath(const Char* Path)
+{
+    String NormPath{Path};
+    std::replace(NormPath.begin(), NormPath.end(), '\\', '/');
+    while (NormPath.compare(0, 2, "./") == 0)
+        NormPath.erase(0, 2);
+    return NormPath;
+}
+
+// Returns true if one path is the tail of the other one. The watched directories and
+// the directories the shader source stream factory searches are not necessarily the same,
+// so e.g. the modified file 'shaders/common.fxh' matches the dependency 'common.fxh'.
+bool PathsMatch(const String& Path1, const String& Path2)
+{
+    const auto& Longer  = Path1.length() >= Path2.length() ? Path1 : Path2;
+    const auto& Shorter = Path1.length() >= Path2.length() ? Path2 : Path1;
+    if (Shorter.empty() || Longer.compare(Longer.length() - Shorter.length(), Shorter.length(), Shorter) != 0)
+        return false;
+    return Longer.length() == Shorter.length() || Longer[Longer.length() - Shorter.length() - 1] == '/';
+}
+
+// Forwards all requests to the application's stream factory and records the names of
+// all files the compiler has requested, including the files that could not be opened.
+class DependencyRecorder final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    DependencyRecorder(IReferenceCounters* pRefCounters, IShaderSourceInputStreamFactory* pFactory) :
+        TBase{pRefCounters},
+        m_pFactory{pFactory}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        if (Name != nullptr)
+        {
+            auto Path = NormalizePath(Name);
+
+            std::lock_guard<std::mutex> Lock{m_DependenciesMtx};
+            if (std::find(m_Dependencies.begin(), m_Dependencies.end(), Path) == m_Dependencies.end())
+                m_Dependencies.emplace_back(std::move(Path));
+        }
+        m_pFactory->CreateInputStream2(Name, Flags, ppStream);
+    }
+
+    std::vector<String> GetDependencies()
+    {
+        std::lock_guard<std::mutex> Lock{m_DependenciesMtx};
+        return m_Dependencies;
+    }
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+
+    std::mutex          m_DependenciesMtx;
+    std::vector<String> m_Dependencies;
+};
+
+} // namespace
+
+
+struct ShaderHotReloader::ShaderInfo
+{
+    explicit ShaderInfo(const ShaderCreateInfo& CI) :
+        CreateInfo{CI},
+        Name{CI.Desc.Name != nullptr ? CI.Desc.Name : ""},
+        FilePath{CI.FilePath != nullptr ? CI.FilePath : ""},
+        Source{CI.Source != nullptr ? CI.Source : ""},
+        EntryPoint{CI.EntryPoint != nullptr ? CI.EntryPoint : ""},
+        CombinedSamplerSuffix{CI.CombinedSamplerSuffix != nullptr ? CI.CombinedSamplerSuffix : ""},
+        pFactory{CI.pShaderSourceStreamFactory}
+    {
+        // Make the create info reference the copies of all strings and arrays
+        CreateInfo.Desc.Name             = Name.c_str();
+        CreateInfo.FilePath              = CI.FilePath != nullptr ? FilePath.c_str() : nullptr;
+        CreateInfo.Source                = CI.Source != nullptr ? Source.c_str() : nullptr;
+        CreateInfo.EntryPoint            = CI.EntryPoint != nullptr ? EntryPoint.c_str() : nullptr;
+        CreateInfo.CombinedSamplerSuffix = CI.CombinedSamplerSuffix != nullptr ? CombinedSamplerSuffix.c_str() : nullptr;
+
+        if (CI.ByteCode != nullptr)
+        {
+            const auto* pByteCode = static_cast<const Uint8*>(CI.ByteCode);
+            ByteCode.assign(pByteCode, pByteCode + CI.ByteCodeSize);
+            CreateInfo.ByteCode = ByteCode.data();
+        }
+
+        if (CI.Macros != nullptr)
+        {
+            for (const auto* pMacro = CI.Macros; pMacro->Name != nullptr && pMacro->Definition != nullptr; ++pMacro)
+                MacroStrings.emplace_back(pMacro->Name, pMacro->Definition);
+            for (const auto& Macro : MacroStrings)
+                Macros.emplace_back(Macro.first.c_str(), Macro.second.c_str());
+            Macros.emplace_back(nullptr, nullptr);
+            CreateInfo.Macros = Macros.data();
+        }
+
+        // Output parameters only make sense for the initial compilation
+        CreateInfo.ppConversionStream = nullptr;
+        CreateInfo.pCompileStats      = nullptr;
+        CreateInfo.ppCompilerOutput   = nullptr;
+    }
+
+    // clang-format off
+    ShaderInfo           (const ShaderInfo&)  = delete;
+    ShaderInfo           (      ShaderInfo&&) = delete;
+    ShaderInfo& operator=(const ShaderInfo&)  = delete;
+    ShaderInfo& operator=(      ShaderInfo&&) = delete;
+    // clang-format on
+
+    bool DependsOn(const String& ModifiedFile) const
+    {
+        for (const auto& Dependency : Dependencies)
+        {
+            if (PathsMatch(Dependency, ModifiedFile))
+                return true;
+        }
+        return false;
+    }
+
+    // Create info that references the strings and arrays below
+    ShaderCreateInfo CreateInfo;
+
+    const String Name;
+    const String FilePath;
+    const String Source;
+    const String EntryPoint;
+    const String CombinedSamplerSuffix;
+
+    std::vector<Uint8>                    ByteCode;
+    std::vector<std::pair<String, String>> MacroStrings;
+    std::vector<ShaderMacro>              Macros;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+
+    // The most recent successfully compiled shader
+    RefCntAutoPtr<IShader> pShader;
+
+    // Files the shader depends on, as requested from the stream factory
+    std::vector<String> Dependencies;
+};
+
+
+struct ShaderHotReloader::PipelineInfo
+{
+    RefCntWeakPtr<IPipelineState> wpPSO;
+
+    std::unique_ptr<PipelineStateCreateInfoCopy<GraphicsPipelineStateCreateInfo>> pGraphicsCI;
+    std::unique_ptr<PipelineStateCreateInfoCopy<ComputePipelineStateCreateInfo>>  pComputeCI;
+
+    struct ShaderSlot
+    {
+        // Index of the shader in the array returned by GetShaderSlots()
+        Uint32      Index = 0;
+        ShaderInfo* pInfo = nullptr;
+    };
+    // Shaders created by the reloader
+    std::vector<ShaderSlot> Shaders;
+
+    template <typename PSOCreateInfoType>
+    static std::vector<IShader**> GetShaderSlots(PSOCreateInfoType& CI);
+
+    bool UsesShader(const ShaderInfo* pInfo) const
+    {
+        return std::find_if(Shaders.begin(), Shaders.end(), [pInfo](const ShaderSlot& Slot) { return Slot.pInfo == pInfo; }) != Shaders.end();
+    }
+};
+
+template <>
+std::vector<IShader**> ShaderHotReloader::PipelineInfo::GetShaderSlots<GraphicsPipelineStateCreateInfo>(GraphicsPipelineStateCreateInfo& CI)
+{
+    return {&CI.pVS, &CI.pPS, &CI.pDS, &CI.pHS, &CI.pGS, &CI.pAS, &CI.pMS};
+}
+
+template <>
+std::vector<IShader**> ShaderHotReloader::PipelineInfo::GetShaderSlots<ComputePipelineStateCreateInfo>(ComputePipelineStateCreateInfo& CI)
+{
+    return {&CI.pCS};
+}
+
+
+struct ShaderHotReloader::RebuildBatch
+{
+    struct ShaderEntry
+    {
+        ShaderInfo* pInfo = nullptr;
+
+        RefCntAutoPtr<IShader> pShader;
+        std::vector<String>    Dependencies;
+    };
+    std::vector<ShaderEntry> Shaders;
+
+    struct PipelineEntry
+    {
+        PipelineInfo* pInfo = nullptr;
+
+        // Strong reference that keeps the pipeline alive while it is being rebuilt
+        RefCntAutoPtr<IPipelineState> pPSO;
+        RefCntAutoPtr<IPipelineState> pNewPSO;
+        bool                          ShadersReady = true;
+    };
+    std::vector<PipelineEntry> Pipelines;
+};
+
+
+class ShaderHotReloader::FileTracker
+{
+public:
+    FileTracker(const Char* WatchDirectories, Uint32 PollingInterval) :
+        m_PollingInterval{PollingInterval}
+    {
+        while (WatchDirectories != nullptr)
+        {
+            const char* Semicolon = strchr(WatchDirectories, ';');
+            String      Dir;
+            if (Semicolon == nullptr)
+            {
+                Dir              = WatchDirectories;
+                WatchDirectories = nullptr;
+            }
+            else
+            {
+                Dir              = String(WatchDirectories, Semicolon);
+                WatchDirectories = Semicolon + 1;
+            }
+
+            while (!Dir.empty() && (Dir.back() == '\\' || Dir.back() == '/'))
+                Dir.pop_back();
+            if (Dir.empty())
+                continue;
+
+            WatchedDirectory WatchedDir;
+            WatchedDir.pWatcher = FileSystem::WatchDirectory(Dir.c_str());
+            if (!WatchedDir.pWatcher)
+                LOG_INFO_MESSAGE("Directory change notifications are not available for '", Dir, "'. Shader source files will be polled.");
+            WatchedDir.Path = std::move(Dir);
+            m_WatchedDirs.emplace_back(std::move(WatchedDir));
+        }
+    }
+
+    // Starts tracking the files the shader depends on
+    void AddDependencies(const std::vector<String>& Dependencies)
+    {
+        for (const auto& Dir : m_WatchedDirs)
+        {
+            if (Dir.pWatcher)
+                continue;
+
+            for (const auto& Dependency : Dependencies)
+            {
+                const auto FullPath = Dir.Path + FileSystem::GetSlashSymbol() + Dependency;
+                if (m_PolledFiles.find(FullPath) == m_PolledFiles.end())
+                    m_PolledFiles.emplace(FullPath, PolledFileInfo{Dependency, GetStatus(FullPath)});
+            }
+        }
+    }
+
+    void GetModifiedFiles(std::unordered_set<String>& ModifiedFiles)
+    {
+        std::vector<String> Files;
+        for (auto& Dir : m_WatchedDirs)
+        {
+            if (Dir.pWatcher)
+                Dir.pWatcher->GetModifiedFiles(Files);
+        }
+        for (const auto& File : Files)
+            ModifiedFiles.emplace(NormalizePath(File.c_str()));
+
+        if (m_PolledFiles.empty())
+            return;
+
+        const auto CurrTime = std::chrono::steady_clock::now();
+        if (CurrTime - m_LastPollTime < m_PollingInterval)
+            return;
+        m_LastPollTime = CurrTime;
+
+        for (auto& it : m_PolledFiles)
+        {
+            const auto Status = GetStatus(it.first);
+            if (Status != it.second.Status)
+            {
+                it.second.Status = Status;
+                ModifiedFiles.emplace(it.second.Dependency);
+            }
+        }
+    }
+
+private:
+    static FileStatus GetStatus(const String& Path)
+    {
+        FileStatus Status;
+        if (!FileSystem::GetFileStatus(Path.c_str(), Status))
+        {
+            // The file does not exist
+            Status.ModificationTime = ~Uint64{0};
+            Status.Size             = ~Uint64{0};
+        }
+        return Status;
+    }
+
+    struct WatchedDirectory
+    {
+        String                            Path;
+        std::unique_ptr<DirectoryWatcher> pWatcher;
+    };
+    std::vector<WatchedDirectory> m_WatchedDirs;
+
+    struct PolledFileInfo
+    {
+        String     Dependency;
+        FileStatus Status;
+    };
+    // Full path -> polled file info
+    std::unordered_map<String, PolledFileInfo> m_PolledFiles;
+
+    const std::chrono::milliseconds       m_PollingInterval;
+    std::chrono::steady_clock::time_point m_LastPollTime;
+};
+
+
+ShaderHotReloader::ShaderHotReloader(IRenderDevice* pDevice, const ShaderHotReloaderCreateInfo& CI) :
+    m_pDevice{pDevice},
+    m_RebuildInBackground{!pDevice->GetDeviceInfo().IsGLDevice()},
+    m_pFileTracker{new FileTracker{CI.WatchDirectories, CI.PollingInterval}}
+{
+}
+
+ShaderHotReloader::~ShaderHotReloader()
+{
+    if (m_RebuildTask.valid())
+        m_RebuildTask.wait();
+}
+
+void ShaderHotReloader::CreateShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+{
+    DEV_CHECK_ERR(ppShader != nullptr && *ppShader == nullptr, "ppShader must not be null and must point to a null pointer");
+
+    std::unique_ptr<ShaderInfo> pInfo{new ShaderInfo{ShaderCI}};
+
+    RefCntAutoPtr<DependencyRecorder> pRecorder;
+    auto                              CI = ShaderCI;
+    if (ShaderCI.pShaderSourceStreamFactory != nullptr)
+    {
+        pRecorder                     = MakeNewRCObj<DependencyRecorder>()(ShaderCI.pShaderSourceStreamFactory);
+        CI.pShaderSourceStreamFactory = pRecorder;
+    }
+
+    m_pDevice->CreateShader(CI, &pInfo->pShader);
+    if (!pInfo->pShader)
+        return;
+
+    if (pRecorder)
+    {
+        pInfo->Dependencies = pRecorder->GetDependencies();
+        m_pFileTracker->AddDependencies(pInfo->Dependencies);
+    }
+
+    *ppShader = pInfo->pShader;
+    (*ppShader)->AddRef();
+
+    m_Shaders.emplace_back(std::move(pInfo));
+}
+
+void ShaderHotReloader::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateGraphicsPipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState != nullptr)
+        AddPipeline(*ppPipelineState, &PSOCreateInfo, nullptr);
+}
+
+void ShaderHotReloader::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+{
+    m_pDevice->CreateComputePipelineState(PSOCreateInfo, ppPipelineState);
+    if (*ppPipelineState != nullptr)
+        AddPipeline(*ppPipelineState, nullptr, &PSOCreateInfo);
+}
+
+void ShaderHotReloader::AddPipeline(IPipelineState* pPSO, const GraphicsPipelineStateCreateInfo* pGraphicsCI, const ComputePipelineStateCreateInfo* pComputeCI)
+{
+    std::unique_ptr<PipelineInfo> pInfo{new PipelineInfo};
+    pInfo->wpPSO = RefCntWeakPtr<IPipelineState>{pPSO};
+
+    auto AddShaders = [&](auto CI) {
+        const auto Slots = PipelineInfo::GetShaderSlots(CI);
+        for (Uint32 i = 0; i < Slots.size(); ++i)
+        {
+            const auto* pShader = *Slots[i];
+            if (pShader == nullptr)
+                continue;
+
+            auto it = std::find_if(m_Shaders.begin(), m_Shaders.end(), [pShader](const std::unique_ptr<ShaderInfo>& pShaderInfo) { return pShaderInfo->pShader.RawPtr() == pShader; });
+            if (it != m_Shaders.end())
+                pInfo->Shaders.push_back({i, it->get()});
+        }
+    };
+
+    if (pGraphicsCI != nullptr)
+    {
+        AddShaders(*pGraphicsCI);
+        pInfo->pGraphicsCI.reset(new PipelineStateCreateInfoCopy<GraphicsPipelineStateCreateInfo>{*pGraphicsCI});
+    }
+    else
+    {
+        VERIFY_EXPR(pComputeCI != nullptr);
+        AddShaders(*pComputeCI);
+        pInfo->pComputeCI.reset(new PipelineStateCreateInfoCopy<ComputePipelineStateCreateInfo>{*pComputeCI});
+    }
+
+    // Pipelines that do not use any shaders created by the reloader never need to be rebuilt
+    if (!pInfo->Shaders.empty())
+        m_Pipelines.emplace_back(std::move(pInfo));
+}
+
+Uint32 ShaderHotReloader::Update(IDeviceContext* pContext)
+{
+    m_pFileTracker->GetModifiedFiles(m_ModifiedFiles);
+
+    Uint32 NumUpdatedPipelines = 0;
+    if (m_pRebuild)
+    {
+        if (m_RebuildTask.valid())
+        {
+            if (m_RebuildTask.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+                return 0;
+            m_RebuildTask.get();
+        }
+        NumUpdatedPipelines += ApplyRebuild(pContext);
+    }
+
+    if (!m_ModifiedFiles.empty())
+    {
+        StartRebuild();
+        if (m_pRebuild && !m_RebuildTask.valid())
+            NumUpdatedPipelines += ApplyRebuild(pContext);
+    }
+
+    return NumUpdatedPipelines;
+}
+
+void ShaderHotReloader::StartRebuild()
+{
+    VERIFY_EXPR(!m_pRebuild && !m_RebuildTask.valid());
+
+    std::unique_ptr<RebuildBatch> pBatch{new RebuildBatch};
+    for (auto& pShaderInfo : m_Shaders)
+    {
+        for (const auto& File : m_ModifiedFiles)
+        {
+            if (pShaderInfo->DependsOn(File))
+            {
+                pBatch->Shaders.emplace_back();
+                pBatch->Shaders.back().pInfo = pShaderInfo.get();
+                break;
+            }
+        }
+    }
+    m_ModifiedFiles.clear();
+
+    if (pBatch->Shaders.empty())
+        return;
+
+    // Drop the pipelines that have been released by the application
+    m_Pipelines.erase(std::remove_if(m_Pipelines.begin(), m_Pipelines.end(), [](const std::unique_ptr<PipelineInfo>& pInfo) { return !pInfo->wpPSO.IsValid(); }),
+                      m_Pipelines.end());
+
+    for (auto& pPipelineInfo : m_Pipelines)
+    {
+        for (const auto& Shader : pBatch->Shaders)
+        {
+            if (pPipelineInfo->UsesShader(Shader.pInfo))
+            {
+                auto pPSO = pPipelineInfo->wpPSO.Lock();
+                if (pPSO)
+                {
+                    pBatch->Pipelines.emplace_back();
+                    pBatch->Pipelines.back().pInfo = pPipelineInfo.get();
+                    pBatch->Pipelines.back().pPSO  = std::move(pPSO);
+                }
+                break;
+            }
+        }
+    }
+
+    m_pRebuild = std::move(pBatch);
+    if (m_RebuildInBackground)
+        m_RebuildTask = std::async(std::launch::async, &ShaderHotReloader::Rebuild, m_pDevice.RawPtr(), std::ref(*m_pRebuild));
+    else
+        Rebuild(m_pDevice, *m_pRebuild);
+}
+
+void ShaderHotReloader::Rebuild(IRenderDevice* pDevice, RebuildBatch& Batch)
+{
+    // Compile all shaders in parallel
+    std::vector<ShaderCreateInfo>                  ShaderCIs;
+    std::vector<RefCntAutoPtr<DependencyRecorder>> Recorders;
+    ShaderCIs.reserve(Batch.Shaders.size());
+    Recorders.reserve(Batch.Shaders.size());
+    for (const auto& Shader : Batch.Shaders)
+    {
+        ShaderCIs.push_back(Shader.pInfo->CreateInfo);
+        Recorders.emplace_back();
+        if (Shader.pInfo->pFactory)
+        {
+            Recorders.back()                         = MakeNewRCObj<DependencyRecorder>()(Shader.pInfo->pFactory.RawPtr());
+            ShaderCIs.back().pShaderSourceStreamFactory = Recorders.back();
+        }
+    }
+
+    std::vector<IShader*> pShaders(Batch.Shaders.size());
+    pDevice->CreateShaders(ShaderCIs.data(), static_cast<Uint32>(ShaderCIs.size()), pShaders.data());
+
+    std::unordered_map<const ShaderInfo*, IShader*> NewShaders;
+    for (size_t i = 0; i < Batch.Shaders.size(); ++i)
+    {
+        auto& Shader = Batch.Shaders[i];
+        Shader.pShader.Attach(pShaders[i]);
+        if (Recorders[i])
+            Shader.Dependencies = Recorders[i]->GetDependencies();
+        NewShaders.emplace(Shader.pInfo, Shader.pShader.RawPtr());
+    }
+
+    auto GetShaders = [&](PipelineInfo& Info, auto& CI) {
+        const auto Slots = PipelineInfo::GetShaderSlots(CI);
+        for (const auto& Slot : Info.Shaders)
+        {
+            auto it = NewShaders.find(Slot.pInfo);
+            if (it == NewShaders.end())
+            {
+                *Slots[Slot.Index] = Slot.pInfo->pShader;
+            }
+            else if (it->second != nullptr)
+            {
+                *Slots[Slot.Index] = it->second;
+            }
+            else
+            {
+                // The shader has failed to compile
+                return false;
+            }
+        }
+        // The pipeline is updated by the next Update() call and must be ready by then
+        CI.Flags &= ~PSO_CREATE_FLAG_ASYNCHRONOUS;
+        return true;
+    };
+
+    for (auto& Pipeline : Batch.Pipelines)
+    {
+        if (Pipeline.pInfo->pGraphicsCI)
+        {
+            auto CI               = Pipeline.pInfo->pGraphicsCI->Get();
+            Pipeline.ShadersReady = GetShaders(*Pipeline.pInfo, CI);
+            if (Pipeline.ShadersReady)
+                pDevice->CreateGraphicsPipelineState(CI, &Pipeline.pNewPSO);
+        }
+        else
+        {
+            auto CI               = Pipeline.pInfo->pComputeCI->Get();
+            Pipeline.ShadersReady = GetShaders(*Pipeline.pInfo, CI);
+            if (Pipeline.ShadersReady)
+                pDevice->CreateComputePipelineState(CI, &Pipeline.pNewPSO);
+        }
+    }
+}
+
+Uint32 ShaderHotReloader::ApplyRebuild(IDeviceContext* pContext)
+{
+    VERIFY_EXPR(m_pRebuild);
+    auto pBatch = std::move(m_pRebuild);
+
+    for (auto& Shader : pBatch->Shaders)
+    {
+        if (Shader.pShader)
+        {
+            Shader.pInfo->pShader = std::move(Shader.pShader);
+            // Dependencies may have changed if include directives were modified
+            Shader.pInfo->Dependencies = std::move(Shader.Dependencies);
+            m_pFileTracker->AddDependencies(Shader.pInfo->Dependencies);
+            ++m_Stats.NumReloadedShaders;
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE("Failed to reload shader '", Shader.pInfo->Name, "'. The previous version of the shader will be used.");
+            ++m_Stats.NumFailedShaders;
+        }
+    }
+
+    Uint32 NumUpdatedPipelines = 0;
+    for (auto& Pipeline : pBatch->Pipelines)
+    {
+        if (!Pipeline.ShadersReady)
+            continue;
+
+        if (Pipeline.pNewPSO && Pipeline.pPSO->SwapShaders(Pipeline.pNewPSO))
+        {
+            ++NumUpdatedPipelines;
+        }
+        else
+        {
+            const auto* Name = Pipeline.pPSO->GetDesc().Name;
+            LOG_ERROR_MESSAGE("Failed to update pipeline '", (Name != nullptr ? Name : ""), "' with the reloaded shaders.");
+            ++m_Stats.NumFailedPipelines;
+        }
+    }
+    m_Stats.NumUpdatedPipelines += NumUpdatedPipelines;
+
+    // The pipelines may be bound to the context, and the context must not skip binding them
+    if (NumUpdatedPipelines > 0 && pContext != nullptr)
+        pContext->InvalidateState();
+
+    return NumUpdatedPipelines;
+}
+
+} // namespace Diligent
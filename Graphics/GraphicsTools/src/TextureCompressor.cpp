@@ -0,0 +1,803 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TextureCompressor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 NumBlockTexels = 16;
+
+// Block texels in AoS layout, RGBA
+using BlockRGBA8 = Uint8[NumBlockTexels][4];
+
+// Block texels in SoA layout: Texels[Channel][Texel]
+using BlockTexels = float[4][NumBlockTexels];
+
+using BlockEncoderType = void (*)(const BlockRGBA8& Block, Uint8* pDst);
+
+struct SrcFormatInfo
+{
+    Uint32 TexelSize     = 0;
+    Uint32 NumComponents = 0;
+    bool   SwapRB        = false;
+};
+
+bool GetSrcFormatInfo(TEXTURE_FORMAT Format, SrcFormatInfo& Info)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_R8_UNORM:
+        case TEX_FORMAT_RG8_UNORM:
+        case TEX_FORMAT_RGBA8_UNORM:
+        case TEX_FORMAT_RGBA8_UNORM_SRGB:
+        case TEX_FORMAT_BGRA8_UNORM:
+        case TEX_FORMAT_BGRA8_UNORM_SRGB:
+        case TEX_FORMAT_BGRX8_UNORM:
+        case TEX_FORMAT_BGRX8_UNORM_SRGB:
+            break;
+
+        default:
+            return false;
+    }
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    VERIFY_EXPR(FmtAttribs.ComponentSize == 1);
+    Info.TexelSize     = FmtAttribs.GetElementSize();
+    Info.NumComponents = (Format == TEX_FORMAT_BGRX8_UNORM || Format == TEX_FORMAT_BGRX8_UNORM_SRGB) ? 3 : FmtAttribs.NumComponents;
+    Info.SwapRB        = (Format == TEX_FORMAT_BGRA8_UNORM || Format == TEX_FORMAT_BGRA8_UNORM_SRGB ||
+                   Format == TEX_FORMAT_BGRX8_UNORM || Format == TEX_FORMAT_BGRX8_UNORM_SRGB);
+    return true;
+}
+
+// Loads the 4x4 block replicating the edge texels for partial blocks
+void LoadBlock(const TextureCompressionAttribs& Attribs, const SrcFormatInfo& SrcFmt, Uint32 BlockX, Uint32 BlockY, BlockRGBA8& Block)
+{
+    for (Uint32 y = 0; y < 4; ++y)
+    {
+        const auto  Row  = std::min(BlockY * 4 + y, Attribs.Height - 1);
+        const auto* pRow = static_cast<const Uint8*>(Attribs.pSrcData) + Row * Attribs.SrcStride;
+        for (Uint32 x = 0; x < 4; ++x)
+        {
+            const auto  Col    = std::min(BlockX * 4 + x, Attribs.Width - 1);
+            const auto* pTexel = pRow + size_t{Col} * SrcFmt.TexelSize;
+
+            auto& Dst = Block[y * 4 + x];
+            for (Uint32 c = 0; c < 3; ++c)
+                Dst[c] = c < SrcFmt.NumComponents ? pTexel[c] : 0;
+            Dst[3] = SrcFmt.NumComponents == 4 ? pTexel[3] : 255;
+            if (SrcFmt.SwapRB)
+                std::swap(Dst[0], Dst[2]);
+        }
+    }
+}
+
+void ToBlockTexels(const BlockRGBA8& Block, Uint32 NumChannels, BlockTexels& Texels)
+{
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        for (Uint32 i = 0; i < NumBlockTexels; ++i)
+            Texels[c][i] = c < NumChannels ? static_cast<float>(Block[i][c]) : 0.f;
+    }
+}
+
+void ClampEndpoint(float (&E)[4])
+{
+    for (auto& c : E)
+        c = clamp(c, 0.f, 255.f);
+}
+
+// Returns the end points of the segment along the principal axis of the texels that covers all texels with non-zero weight
+void FitPrincipalAxis(const BlockTexels& Texels, const float* Weights, Uint32 NumChannels, float (&E0)[4], float (&E1)[4])
+{
+    float Mean[4]     = {};
+    float TotalWeight = 0;
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        TotalWeight += Weights[i];
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Mean[c] += Weights[i] * Texels[c][i];
+    }
+
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Mean[c] = (c < NumChannels && TotalWeight > 0) ? Mean[c] / TotalWeight : 0;
+        E0[c] = E1[c] = Mean[c];
+    }
+    if (TotalWeight == 0)
+        return;
+
+    float Cov[4][4] = {};
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = 0; c1 < NumChannels; ++c1)
+                Cov[c0][c1] += Weights[i] * (Texels[c0][i] - Mean[c0]) * (Texels[c1][i] - Mean[c1]);
+        }
+    }
+
+    // Power iteration starting from the covariance matrix row with the largest variance,
+    // which is never orthogonal to the principal axis
+    Uint32 MaxVarChannel = 0;
+    for (Uint32 c = 1; c < NumChannels; ++c)
+    {
+        if (Cov[c][c] > Cov[MaxVarChannel][MaxVarChannel])
+            MaxVarChannel = c;
+    }
+    if (Cov[MaxVarChannel][MaxVarChannel] == 0)
+        return;
+
+    float Axis[4] = {};
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] = Cov[MaxVarChannel][c];
+
+    for (Uint32 Iter = 0; Iter < 8; ++Iter)
+    {
+        float NewAxis[4] = {};
+        float MaxComp    = 0;
+        for (Uint32 c0 = 0; c0 < NumChannels; ++c0)
+        {
+            for (Uint32 c1 = 0; c1 < NumChannels; ++c1)
+                NewAxis[c0] += Cov[c0][c1] * Axis[c1];
+            MaxComp = std::max(MaxComp, std::abs(NewAxis[c0]));
+        }
+        if (MaxComp == 0)
+            break;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            Axis[c] = NewAxis[c] / MaxComp;
+    }
+
+    float Len2 = 0;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Len2 += Axis[c] * Axis[c];
+    if (Len2 == 0)
+        return;
+    for (Uint32 c = 0; c < NumChannels; ++c)
+        Axis[c] /= std::sqrt(Len2);
+
+    float MinT = +FLT_MAX;
+    float MaxT = -FLT_MAX;
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        if (Weights[i] == 0)
+            continue;
+
+        float t = 0;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            t += (Texels[c][i] - Mean[c]) * Axis[c];
+        MinT = std::min(MinT, t);
+        MaxT = std::max(MaxT, t);
+    }
+
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = Mean[c] + Axis[c] * MinT;
+        E1[c] = Mean[c] + Axis[c] * MaxT;
+    }
+    ClampEndpoint(E0);
+    ClampEndpoint(E1);
+}
+
+// Finds the least-squares end points for the given interpolation factors of E1 of every texel.
+// Returns false if the system is degenerate, e.g. when all texels use the same factor.
+bool RefineEndpoints(const BlockTexels& Texels, const float* Weights, const float* Factors, Uint32 NumChannels, float (&E0)[4], float (&E1)[4])
+{
+    float A = 0, B = 0, C = 0;
+    float X0[4] = {};
+    float X1[4] = {};
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        const auto w = Weights[i];
+        const auto b = Factors[i];
+        const auto a = 1.f - b;
+
+        A += w * a * a;
+        B += w * a * b;
+        C += w * b * b;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            X0[c] += w * a * Texels[c][i];
+            X1[c] += w * b * Texels[c][i];
+        }
+    }
+
+    const auto Det = A * C - B * B;
+    if (std::abs(Det) < 1e-6f)
+        return false;
+
+    for (Uint32 c = 0; c < NumChannels; ++c)
+    {
+        E0[c] = (C * X0[c] - B * X1[c]) / Det;
+        E1[c] = (A * X1[c] - B * X0[c]) / Det;
+    }
+    ClampEndpoint(E0);
+    ClampEndpoint(E1);
+    return true;
+}
+
+// Finds the nearest palette entry for every texel and writes the squared distances to Dist.
+// Unused channels must be zero in both the texels and the palette.
+void FindNearestEntries(const BlockTexels& Texels, const float (*Palette)[4], Uint32 NumEntries, Uint8 (&Indices)[NumBlockTexels], float (&Dist)[NumBlockTexels])
+{
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+    using namespace BasicMathSIMD;
+    for (Uint32 i = 0; i < NumBlockTexels; i += 4)
+    {
+        const VecType R = Load(&Texels[0][i]);
+        const VecType G = Load(&Texels[1][i]);
+        const VecType B = Load(&Texels[2][i]);
+        const VecType A = Load(&Texels[3][i]);
+
+        VecType BestDist = Set1(FLT_MAX);
+        VecType BestIdx  = Set1(0.f);
+        for (Uint32 k = 0; k < NumEntries; ++k)
+        {
+            const VecType dR = Sub(R, Set1(Palette[k][0]));
+            const VecType dG = Sub(G, Set1(Palette[k][1]));
+            const VecType dB = Sub(B, Set1(Palette[k][2]));
+            const VecType dA = Sub(A, Set1(Palette[k][3]));
+            const VecType d  = Add(Add(Mul(dR, dR), Mul(dG, dG)), Add(Mul(dB, dB), Mul(dA, dA)));
+
+            const VecType Closer = CmpLT(d, BestDist);
+            BestDist             = Select(Closer, d, BestDist);
+            BestIdx              = Select(Closer, Set1(static_cast<float>(k)), BestIdx);
+        }
+        Store(&Dist[i], BestDist);
+
+        Int32 Idx[4];
+        StoreInt(Idx, BestIdx);
+        for (Uint32 j = 0; j < 4; ++j)
+            Indices[i + j] = static_cast<Uint8>(Idx[j]);
+    }
+#else
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        Dist[i] = FLT_MAX;
+        for (Uint32 k = 0; k < NumEntries; ++k)
+        {
+            const float dR = Texels[0][i] - Palette[k][0];
+            const float dG = Texels[1][i] - Palette[k][1];
+            const float dB = Texels[2][i] - Palette[k][2];
+            const float dA = Texels[3][i] - Palette[k][3];
+            const float d  = (dR * dR + dG * dG) + (dB * dB + dA * dA);
+            if (d < Dist[i])
+            {
+                Dist[i]    = d;
+                Indices[i] = static_cast<Uint8>(k);
+            }
+        }
+    }
+#endif
+}
+
+Uint16 QuantizeRGB565(const float (&Color)[4])
+{
+    const auto r = static_cast<Uint32>(Color[0] * (31.f / 255.f) + 0.5f);
+    const auto g = static_cast<Uint32>(Color[1] * (63.f / 255.f) + 0.5f);
+    const auto b = static_cast<Uint32>(Color[2] * (31.f / 255.f) + 0.5f);
+    return static_cast<Uint16>((r << 11u) | (g << 5u) | b);
+}
+
+void UnpackRGB565(Uint32 Color, float (&RGB)[4])
+{
+    const auto r = (Color >> 11u) & 31u;
+    const auto g = (Color >> 5u) & 63u;
+    const auto b = Color & 31u;
+
+    RGB[0] = static_cast<float>((r << 3u) | (r >> 2u));
+    RGB[1] = static_cast<float>((g << 2u) | (g >> 4u));
+    RGB[2] = static_cast<float>((b << 3u) | (b >> 2u));
+    RGB[3] = 0;
+}
+
+// Encodes the color block of BC1, BC2 and BC3 formats.
+// When AllowTransparency is true, texels with alpha below 128 are encoded as transparent
+// using the 3-color mode, which is only available in BC1.
+void EncodeBC1ColorBlock(const BlockRGBA8& Block, bool AllowTransparency, Uint8* pDst)
+{
+    BlockTexels Texels;
+    ToBlockTexels(Block, 3, Texels);
+
+    float Weights[NumBlockTexels];
+    bool  HasTransparent = false;
+    bool  AllTransparent = true;
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        const bool IsTransparent = AllowTransparency && Block[i][3] < 128;
+        Weights[i]               = IsTransparent ? 0.f : 1.f;
+        HasTransparent           = HasTransparent || IsTransparent;
+        AllTransparent           = AllTransparent && IsTransparent;
+    }
+
+    Uint32 c0 = 0;
+    Uint32 c1 = 0;
+    Uint8  Indices[NumBlockTexels];
+    if (AllTransparent)
+    {
+        std::fill(std::begin(Indices), std::end(Indices), Uint8{3});
+    }
+    else
+    {
+        // Interpolation factors of the second end point for every palette entry
+        static constexpr float FourColorFactors[]  = {0, 1, 1.f / 3.f, 2.f / 3.f};
+        static constexpr float ThreeColorFactors[] = {0, 1, 0.5f, 0};
+
+        const auto* Factors    = HasTransparent ? ThreeColorFactors : FourColorFactors;
+        const auto  NumEntries = HasTransparent ? 3u : 4u;
+
+        float E0[4], E1[4];
+        FitPrincipalAxis(Texels, Weights, 3, E0, E1);
+
+        float BestError = FLT_MAX;
+        for (Uint32 Iter = 0; Iter < 3; ++Iter)
+        {
+            const auto q0 = QuantizeRGB565(E0);
+            const auto q1 = QuantizeRGB565(E1);
+
+            float Palette[4][4];
+            UnpackRGB565(q0, Palette[0]);
+            UnpackRGB565(q1, Palette[1]);
+            for (Uint32 k = 2; k < 4; ++k)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                    Palette[k][c] = Palette[0][c] * (1.f - Factors[k]) + Palette[1][c] * Factors[k];
+            }
+
+            Uint8 IterIndices[NumBlockTexels];
+            float Dist[NumBlockTexels];
+            FindNearestEntries(Texels, Palette, NumEntries, IterIndices, Dist);
+
+            float Error = 0;
+            for (Uint32 i = 0; i < NumBlockTexels; ++i)
+                Error += Weights[i] * Dist[i];
+
+            if (Error < BestError)
+            {
+                BestError = Error;
+                c0        = q0;
+                c1        = q1;
+                std::copy(std::begin(IterIndices), std::end(IterIndices), Indices);
+            }
+            if (Error == 0)
+                break;
+
+            float TexelFactors[NumBlockTexels];
+            for (Uint32 i = 0; i < NumBlockTexels; ++i)
+                TexelFactors[i] = Factors[IterIndices[i]];
+            if (!RefineEndpoints(Texels, Weights, TexelFactors, 3, E0, E1))
+                break;
+        }
+
+        if (HasTransparent)
+        {
+            // The 3-color mode requires c0 <= c1
+            if (c0 > c1)
+            {
+                std::swap(c0, c1);
+                for (auto& Idx : Indices)
+                    Idx = static_cast<Uint8>(Idx < 2 ? Idx ^ 1 : Idx);
+            }
+            for (Uint32 i = 0; i < NumBlockTexels; ++i)
+            {
+                if (Weights[i] == 0)
+                    Indices[i] = 3;
+            }
+        }
+        else
+        {
+            // The 4-color mode requires c0 > c1. If the end points are equal, all entries are the same
+            // color and index 0 must be used as the decoder selects the 3-color mode.
+            if (c0 < c1)
+            {
+                std::swap(c0, c1);
+                for (auto& Idx : Indices)
+                    Idx ^= 1;
+            }
+            else if (c0 == c1)
+            {
+                std::fill(std::begin(Indices), std::end(Indices), Uint8{0});
+            }
+        }
+    }
+
+    Uint32 IndexBits = 0;
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+        IndexBits |= Uint32{Indices[i]} << (i * 2);
+
+    pDst[0] = static_cast<Uint8>(c0);
+    pDst[1] = static_cast<Uint8>(c0 >> 8u);
+    pDst[2] = static_cast<Uint8>(c1);
+    pDst[3] = static_cast<Uint8>(c1 >> 8u);
+    for (Uint32 b = 0; b < 4; ++b)
+        pDst[4 + b] = static_cast<Uint8>(IndexBits >> (b * 8));
+}
+
+// Encodes the given channel of the block as a BC4 block (also used for BC3 alpha and BC5)
+void EncodeBC4Channel(const BlockRGBA8& Block, Uint32 Channel, Uint8* pDst)
+{
+    Uint32 a0 = 0;
+    Uint32 a1 = 255;
+    for (Uint32 i = 0; i < NumBlockTexels; ++i)
+    {
+        a0 = std::max(a0, Uint32{Block[i][Channel]});
+        a1 = std::min(a1, Uint32{Block[i][Channel]});
+    }
+
+    // The 8-value mode (a0 > a1) evenly spaces six interpolated values between a0 and a1.
+    // When a0 == a1, all indices are 0.
+    Uint64 IndexBits = 0;
+    if (a0 > a1)
+    {
+        const float Scale = 7.f / static_cast<float>(a0 - a1);
+        for (Uint32 i = 0; i < NumBlockTexels; ++i)
+        {
+            // Position on the a0 -> a1 ramp
+            const auto Pos = static_cast<Uint32>(static_cast<float>(a0 - Block[i][Channel]) * Scale + 0.5f);
+            const auto Idx = Pos == 0 ? 0u : (Pos == 7 ? 1u : Pos + 1u);
+            IndexBits |= Uint64{Idx} << (i * 3);
+        }
+    }
+
+    pDst[0] = static_cast<Uint8>(a0);
+    pDst[1] = static_cast<Uint8>(a1);
+    for (Uint32 b = 0; b < 6; ++b)
+        pDst[2 + b] = static_cast<Uint8>(IndexBits >> (b * 8));
+}
+
+void EncodeBC1Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    EncodeBC1ColorBlock(Block, true, pDst);
+}
+
+void EncodeBC2Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    for (Uint32 i = 0; i < NumBlockTexels; i += 2)
+    {
+        const auto a0 = (Uint32{Block[i + 0][3]} * 15u + 127u) / 255u;
+        const auto a1 = (Uint32{Block[i + 1][3]} * 15u + 127u) / 255u;
+        pDst[i / 2]   = static_cast<Uint8>(a0 | (a1 << 4u));
+    }
+    EncodeBC1ColorBlock(Block, false, pDst + 8);
+}
+
+void EncodeBC3Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    EncodeBC4Channel(Block, 3, pDst);
+    EncodeBC1ColorBlock(Block, false, pDst + 8);
+}
+
+void EncodeBC4Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    EncodeBC4Channel(Block, 0, pDst);
+}
+
+void EncodeBC5Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    EncodeBC4Channel(Block, 0, pDst);
+    EncodeBC4Channel(Block, 1, pDst + 8);
+}
+
+// Quantizes the BC7 mode 6 end point to 7 bits per channel and selects the p-bit shared by all channels
+void QuantizeBC7Mode6Endpoint(const float (&E)[4], Uint8 (&Q)[4], Uint8& PBit)
+{
+    float BestError = FLT_MAX;
+    for (Uint8 p = 0; p < 2; ++p)
+    {
+        Uint8 q[4];
+        float Error = 0;
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            q[c]           = static_cast<Uint8>(clamp((E[c] - p) * 0.5f + 0.5f, 0.f, 127.f));
+            const float dc = static_cast<float>(q[c] * 2 + p) - E[c];
+            Error += dc * dc;
+        }
+        if (Error < BestError)
+        {
+            BestError = Error;
+            PBit      = p;
+            std::copy(std::begin(q), std::end(q), Q);
+        }
+    }
+}
+
+class BitWriter
+{
+public:
+    explicit BitWriter(Uint8* pDst) :
+        m_pDst{pDst}
+    {}
+
+    void Write(Uint32 Value, Uint32 NumBits)
+    {
+        for (Uint32 b = 0; b < NumBits; ++b, ++m_Pos)
+        {
+            if ((Value >> b) & 1u)
+                m_pDst[m_Pos / 8] |= static_cast<Uint8>(1u << (m_Pos % 8));
+        }
+    }
+
+private:
+    Uint8* const m_pDst;
+    Uint32       m_Pos = 0;
+};
+
+// Encodes the block in BC7 mode 6: one subset, RGBA end points with 7 bits per channel plus
+// a p-bit per end point, and 4-bit indices.
+void EncodeBC7Block(const BlockRGBA8& Block, Uint8* pDst)
+{
+    static constexpr Uint32 Mode6Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    BlockTexels Texels;
+    ToBlockTexels(Block, 4, Texels);
+
+    float Weights[NumBlockTexels];
+    std::fill(std::begin(Weights), std::end(Weights), 1.f);
+
+    float E0[4], E1[4];
+    FitPrincipalAxis(Texels, Weights, 4, E0, E1);
+
+    Uint8 Q[2][4]  = {};
+    Uint8 P[2]     = {};
+    Uint8 Indices[NumBlockTexels];
+    float BestError = FLT_MAX;
+    for (Uint32 Iter = 0; Iter < 3; ++Iter)
+    {
+        Uint8 q[2][4], p[2];
+        QuantizeBC7Mode6Endpoint(E0, q[0], p[0]);
+        QuantizeBC7Mode6Endpoint(E1, q[1], p[1]);
+
+        float Palette[16][4];
+        for (Uint32 k = 0; k < 16; ++k)
+        {
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                const Uint32 v0 = q[0][c] * 2u + p[0];
+                const Uint32 v1 = q[1][c] * 2u + p[1];
+                Palette[k][c]   = static_cast<float>(((64u - Mode6Weights[k]) * v0 + Mode6Weights[k] * v1 + 32u) >> 6u);
+            }
+        }
+
+        Uint8 IterIndices[NumBlockTexels];
+        float Dist[NumBlockTexels];
+        FindNearestEntries(Texels, Palette, 16, IterIndices, Dist);
+
+        float Error = 0;
+        for (auto d : Dist)
+            Error += d;
+
+        if (Error < BestError)
+        {
+            BestError = Error;
+            std::copy(&q[0][0], &q[0][0] + 8, &Q[0][0]);
+            P[0] = p[0];
+            P[1] = p[1];
+            std::copy(std::begin(IterIndices), std::end(IterIndices), Indices);
+        }
+        if (Error == 0)
+            break;
+
+        float TexelFactors[NumBlockTexels];
+        for (Uint32 i = 0; i < NumBlockTexels; ++i)
+            TexelFactors[i] = static_cast<float>(Mode6Weights[IterIndices[i]]) / 64.f;
+        if (!RefineEndpoints(Texels, Weights, TexelFactors, 4, E0, E1))
+            break;
+    }
+
+    // The most significant bit of the anchor index is implicitly zero
+    if (Indices[0] >= 8)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            std::swap(Q[0][c], Q[1][c]);
+        std::swap(P[0], P[1]);
+        for (auto& Idx : Indices)
+            Idx = static_cast<Uint8>(15 - Idx);
+    }
+
+    std::fill(pDst, pDst + 16, Uint8{0});
+    BitWriter Writer{pDst};
+    Writer.Write(1u << 6u, 7);
+    for (Uint32 c = 0; c < 4; ++c)
+    {
+        Writer.Write(Q[0][c], 7);
+        Writer.Write(Q[1][c], 7);
+    }
+    Writer.Write(P[0], 1);
+    Writer.Write(P[1], 1);
+    Writer.Write(Indices[0], 3);
+    for (Uint32 i = 1; i < NumBlockTexels; ++i)
+        Writer.Write(Indices[i], 4);
+}
+
+BlockEncoderType GetBlockEncoder(TEXTURE_FORMAT Format)
+{
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+        case TEX_FORMAT_BC1_UNORM_SRGB:
+            return EncodeBC1Block;
+
+        case TEX_FORMAT_BC2_UNORM:
+        case TEX_FORMAT_BC2_UNORM_SRGB:
+            return EncodeBC2Block;
+
+        case TEX_FORMAT_BC3_UNORM:
+        case TEX_FORMAT_BC3_UNORM_SRGB:
+            return EncodeBC3Block;
+
+        case TEX_FORMAT_BC4_UNORM:
+            return EncodeBC4Block;
+
+        case TEX_FORMAT_BC5_UNORM:
+            return EncodeBC5Block;
+
+        case TEX_FORMAT_BC7_UNORM:
+        case TEX_FORMAT_BC7_UNORM_SRGB:
+            return EncodeBC7Block;
+
+        default:
+            return nullptr;
+    }
+}
+
+} // namespace
+
+bool IsTextureCompressionSupported(TEXTURE_FORMAT Format)
+{
+    return GetBlockEncoder(Format) != nullptr;
+}
+
+bool CompressTexture(const TextureCompressionAttribs& Attribs)
+{
+    const auto EncodeBlock = GetBlockEncoder(Attribs.DstFormat);
+    if (EncodeBlock == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Texture compression to ", GetTextureFormatAttribs(Attribs.DstFormat).Name, " format is not supported");
+        return false;
+    }
+
+    SrcFormatInfo SrcFmt;
+    if (!GetSrcFormatInfo(Attribs.SrcFormat, SrcFmt))
+    {
+        LOG_ERROR_MESSAGE(GetTextureFormatAttribs(Attribs.SrcFormat).Name, " is not a valid source format for texture compression");
+        return false;
+    }
+
+    if (Attribs.Width == 0 || Attribs.Height == 0)
+        return true;
+
+    const auto& DstFmtAttribs = GetTextureFormatAttribs(Attribs.DstFormat);
+    VERIFY_EXPR(DstFmtAttribs.BlockWidth == 4 && DstFmtAttribs.BlockHeight == 4);
+    const auto BlockSize    = DstFmtAttribs.GetElementSize();
+    const auto NumBlocksX   = (Attribs.Width + DstFmtAttribs.BlockWidth - 1) / DstFmtAttribs.BlockWidth;
+    const auto NumBlockRows = (Attribs.Height + DstFmtAttribs.BlockHeight - 1) / DstFmtAttribs.BlockHeight;
+
+    DEV_CHECK_ERR(Attribs.pSrcData != nullptr, "Source data must not be null");
+    DEV_CHECK_ERR(Attribs.pDstData != nullptr, "Destination data must not be null");
+    DEV_CHECK_ERR(Attribs.SrcStride >= Uint64{Attribs.Width} * SrcFmt.TexelSize, "Source stride (", Attribs.SrcStride, ") is too small");
+    DEV_CHECK_ERR(Attribs.DstStride >= Uint64{NumBlocksX} * BlockSize, "Destination stride (", Attribs.DstStride, ") is too small");
+
+    auto CompressRow = [Attribs, SrcFmt, EncodeBlock, BlockSize, NumBlocksX](Uint32 BlockY) {
+        auto* pDstRow = static_cast<Uint8*>(Attribs.pDstData) + BlockY * Attribs.DstStride;
+        for (Uint32 BlockX = 0; BlockX < NumBlocksX; ++BlockX)
+        {
+            BlockRGBA8 Block;
+            LoadBlock(Attribs, SrcFmt, BlockX, BlockY, Block);
+            EncodeBlock(Block, pDstRow + size_t{BlockX} * BlockSize);
+        }
+    };
+
+    const auto NumTasks = Attribs.pThreadPool != nullptr ? std::min(Attribs.pThreadPool->GetThreadCount(), NumBlockRows - 1) : 0;
+    if (NumTasks == 0)
+    {
+        for (Uint32 BlockY = 0; BlockY < NumBlockRows; ++BlockY)
+            CompressRow(BlockY);
+        return true;
+    }
+
+    // The state is shared with the tasks that may start after this function has returned.
+    // Such tasks find no rows left and do not touch the data.
+    struct ParallelState
+    {
+        std::atomic<Uint32>     NextRow{0};
+        std::atomic<Uint32>     NumRowsDone{0};
+        std::mutex              Mtx;
+        std::condition_variable RowsDoneCV;
+    };
+    auto pState = std::make_shared<ParallelState>();
+
+    auto ProcessRows = [pState, CompressRow, NumBlockRows]() {
+        for (auto BlockY = pState->NextRow.fetch_add(1); BlockY < NumBlockRows; BlockY = pState->NextRow.fetch_add(1))
+        {
+            CompressRow(BlockY);
+            if (pState->NumRowsDone.fetch_add(1) + 1 == NumBlockRows)
+            {
+                std::lock_guard<std::mutex> Lock{pState->Mtx};
+                pState->RowsDoneCV.notify_all();
+            }
+        }
+    };
+
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        EnqueueTask(Attribs.pThreadPool, ProcessRows);
+
+    ProcessRows();
+
+    std::unique_lock<std::mutex> Lock{pState->Mtx};
+    pState->RowsDoneCV.wait(Lock, [&]() { return pState->NumRowsDone.load() == NumBlockRows; });
+
+    return true;
+}
+
+bool CompressTextureToUploadBuffer(IUploadBuffer* pUploadBuffer,
+                                   Uint32         Mip,
+                                   Uint32         Slice,
+                                   TEXTURE_FORMAT SrcFormat,
+                                   const void*    pSrcData,
+                                   Uint64         SrcStride,
+                                   IThreadPool*   pThreadPool)
+{
+    DEV_CHECK_ERR(pUploadBuffer != nullptr, "Upload buffer must not be null");
+
+    const auto& Desc = pUploadBuffer->GetDesc();
+    DEV_CHECK_ERR(Mip < Desc.MipLevels, "Mip level ", Mip, " is out of range");
+    DEV_CHECK_ERR(Slice < Desc.ArraySize, "Array slice ", Slice, " is out of range");
+    DEV_CHECK_ERR(Desc.Depth == 1, "Only 2D upload buffers are supported");
+
+    const auto MappedData = pUploadBuffer->GetMappedData(Mip, Slice);
+
+    TextureCompressionAttribs Attribs;
+    Attribs.Width       = std::max(Desc.Width >> Mip, 1u);
+    Attribs.Height      = std::max(Desc.Height >> Mip, 1u);
+    Attribs.SrcFormat   = SrcFormat;
+    Attribs.pSrcData    = pSrcData;
+    Attribs.SrcStride   = SrcStride;
+    Attribs.DstFormat   = Desc.Format;
+    Attribs.pDstData    = MappedData.pData;
+    Attribs.DstStride   = MappedData.Stride;
+    Attribs.pThreadPool = pThreadPool;
+    return CompressTexture(Attribs);
+}
+
+} // namespace Diligent
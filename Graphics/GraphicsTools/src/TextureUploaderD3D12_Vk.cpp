@@ -29,10 +29,12 @@
 #include <unordered_map>
 #include <deque>
 #include <vector>
+#include <algorithm>
 
 #include "TextureUploaderD3D12_Vk.hpp"
 #include "ThreadSignal.hpp"
 #include "GraphicsAccessories.hpp"
+#include "Align.hpp"
 
 namespace Diligent
 {
@@ -40,17 +42,46 @@ namespace Diligent
 namespace
 {
 
+// Rounds the dimension up to one of four buckets per power of two, so that
+// a pooled staging texture is at most 25% wider or taller than requested.
+Uint32 GetBucketDimension(Uint32 Dim)
+{
+    if (Dim <= 8)
+        return Dim;
+
+    const Uint32 Step = 1u << (PlatformMisc::GetMSB(Dim) - 2);
+    return AlignUp(Dim, Step);
+}
+
+// Returns the description of the staging texture that serves upload buffers with the given description.
+// Staging textures of compressed formats are not bucketed as copy regions must be block-aligned.
+UploadBufferDesc GetBucketDesc(const UploadBufferDesc& Desc)
+{
+    UploadBufferDesc BucketDesc = Desc;
+    if (GetTextureFormatAttribs(Desc.Format).ComponentType != COMPONENT_TYPE_COMPRESSED)
+    {
+        BucketDesc.Width  = GetBucketDimension(Desc.Width);
+        BucketDesc.Height = GetBucketDimension(Desc.Height);
+    }
+    return BucketDesc;
+}
+
 class UploadTexture : public UploadBufferBase
 {
 public:
     UploadTexture(IReferenceCounters*     pRefCounters,
                   const UploadBufferDesc& Desc,
+                  const UploadBufferDesc& StagingDesc,
                   ITexture*               pStagingTexture) :
         // clang-format off
         UploadBufferBase {pRefCounters, Desc},
+        m_StagingDesc    {StagingDesc},
         m_pStagingTexture{pStagingTexture}
     // clang-format on
     {
+        const auto& TexDesc = m_pStagingTexture->GetDesc();
+        for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
+            m_StagingDataSize += Uint64{GetMipLevelProperties(TexDesc, Mip).MipSize} * TexDesc.ArraySize;
     }
 
     ~UploadTexture()
@@ -95,8 +126,11 @@ public:
         SetMappedData(Mip, Slice, MappedData);
     }
 
-    void Reset()
+    // Resets the buffer to serve the new request from the same bucket
+    void Reset(const UploadBufferDesc& Desc)
     {
+        VERIFY(GetBucketDesc(Desc) == m_StagingDesc, "The upload buffer description does not belong to this bucket");
+        m_Desc = Desc;
         m_CopyScheduledSignal.Reset();
         m_TextureMappedSignal.Reset();
         m_CopyScheduledFenceValue = 0;
@@ -110,6 +144,10 @@ public:
 
     ITexture* GetStagingTexture() { return m_pStagingTexture; }
 
+    const UploadBufferDesc& GetStagingDesc() const { return m_StagingDesc; }
+
+    Uint64 GetStagingDataSize() const { return m_StagingDataSize; }
+
     bool DbgIsCopyScheduled() const
     {
         return m_CopyScheduledSignal.IsTriggered();
@@ -130,7 +168,9 @@ private:
     ThreadingTools::Signal m_CopyScheduledSignal;
     ThreadingTools::Signal m_TextureMappedSignal;
 
+    const UploadBufferDesc  m_StagingDesc;
     RefCntAutoPtr<ITexture> m_pStagingTexture;
+    Uint64                  m_StagingDataSize         = 0;
     Uint64                  m_CopyScheduledFenceValue = 0;
 };
 
@@ -166,10 +206,18 @@ struct TextureUploaderD3D12_Vk::InternalData
         // clang-format on
     };
 
-    InternalData(IRenderDevice* pDevice)
+    InternalData(IRenderDevice* pDevice, const TextureUploaderDesc& Desc) :
+        m_pCopyContext{Desc.pCopyContext},
+        m_MaxPoolSize{Desc.MaxPoolSize}
     {
         FenceDesc fenceDesc;
         fenceDesc.Name = "Texture uploader sync fence";
+        if (m_pCopyContext)
+        {
+            DEV_CHECK_ERR(!m_pCopyContext->GetDesc().IsDeferred, "Texture uploader copy context must be an immediate context");
+            // Render-thread context waits for the fence on the GPU
+            fenceDesc.Type = FENCE_TYPE_GENERAL;
+        }
         pDevice->CreateFence(fenceDesc, &m_pFence);
     }
 
@@ -212,10 +260,27 @@ struct TextureUploaderD3D12_Vk::InternalData
         // Fences can't be accessed from multiple threads simultaneously even
         // when protected by mutex
         auto FenceValue = m_NextFenceValue++;
-        pContext->EnqueueSignal(m_pFence, FenceValue);
+        if (m_pCopyContext)
+        {
+            // Submit the copies to the copy queue and make the render-thread context's
+            // queue wait until they are complete before any commands that use the textures.
+            m_pCopyContext->EnqueueSignal(m_pFence, FenceValue);
+            m_pCopyContext->Flush();
+            pContext->DeviceWaitForFence(m_pFence, FenceValue);
+        }
+        else
+        {
+            pContext->EnqueueSignal(m_pFence, FenceValue);
+        }
         return FenceValue;
     }
 
+    // Returns the context that executes map, unmap and copy operations
+    IDeviceContext* GetCommandContext(IDeviceContext* pContext)
+    {
+        return m_pCopyContext ? m_pCopyContext.RawPtr() : pContext;
+    }
+
     void UpdatedCompletedFenceValue()
     {
         // Fences can't be accessed from multiple threads simultaneously even
@@ -227,7 +292,7 @@ struct TextureUploaderD3D12_Vk::InternalData
     {
         RefCntAutoPtr<UploadTexture> pUploadTexture;
         std::lock_guard<std::mutex>  CacheLock(m_UploadTexturesCacheMtx);
-        auto                         DequeIt = m_UploadTexturesCache.find(Desc);
+        auto                         DequeIt = m_UploadTexturesCache.find(GetBucketDesc(Desc));
         if (DequeIt != m_UploadTexturesCache.end())
         {
             auto& Deque = DequeIt->second;
@@ -238,7 +303,8 @@ struct TextureUploaderD3D12_Vk::InternalData
                 {
                     pUploadTexture = std::move(FrontBuff);
                     Deque.pop_front();
-                    pUploadTexture->Reset();
+                    m_PooledBytes -= pUploadTexture->GetStagingDataSize();
+                    pUploadTexture->Reset(Desc);
                 }
             }
         }
@@ -249,8 +315,20 @@ struct TextureUploaderD3D12_Vk::InternalData
     void RecycleUploadTexture(UploadTexture* pUploadTexture)
     {
         std::lock_guard<std::mutex> CacheLock(m_UploadTexturesCacheMtx);
-        auto&                       Deque = m_UploadTexturesCache[pUploadTexture->GetDesc()];
+        auto&                       Deque = m_UploadTexturesCache[pUploadTexture->GetStagingDesc()];
         Deque.emplace_back(pUploadTexture);
+        m_PooledBytes += pUploadTexture->GetStagingDataSize();
+
+        if (m_MaxPoolSize != 0)
+            EvictUploadTextures();
+    }
+
+    void GetPoolStats(TextureUploaderStats& Stats)
+    {
+        std::lock_guard<std::mutex> CacheLock(m_UploadTexturesCacheMtx);
+        for (const auto& it : m_UploadTexturesCache)
+            Stats.NumPooledBuffers += static_cast<Uint32>(it.second.size());
+        Stats.PooledBuffersSize = m_PooledBytes;
     }
 
     Uint32 GetNumPendingOperations()
@@ -262,6 +340,36 @@ struct TextureUploaderD3D12_Vk::InternalData
     void Execute(IDeviceContext* pContext, PendingBufferOperation& OperationInfo);
 
 private:
+    // Releases the oldest upload textures from the largest buckets until the pool fits the budget.
+    // Staging textures that may still be used by the GPU are safely released by the engine.
+    void EvictUploadTextures()
+    {
+        while (m_PooledBytes > m_MaxPoolSize)
+        {
+            std::deque<RefCntAutoPtr<UploadTexture>>* pLargestDeque = nullptr;
+            Uint64                                    LargestSize   = 0;
+            for (auto& it : m_UploadTexturesCache)
+            {
+                auto& Deque = it.second;
+                if (Deque.empty())
+                    continue;
+
+                const auto BucketSize = Deque.front()->GetStagingDataSize() * Deque.size();
+                if (BucketSize > LargestSize)
+                {
+                    LargestSize   = BucketSize;
+                    pLargestDeque = &Deque;
+                }
+            }
+            VERIFY(pLargestDeque != nullptr, "Pooled size is not zero, but there are no pooled upload textures");
+            if (pLargestDeque == nullptr)
+                break;
+
+            m_PooledBytes -= pLargestDeque->front()->GetStagingDataSize();
+            pLargestDeque->pop_front();
+        }
+    }
+
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
@@ -269,6 +377,12 @@ private:
     std::mutex                                                                     m_UploadTexturesCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadTexture>>> m_UploadTexturesCache;
 
+    // Total size of the staging textures in m_UploadTexturesCache
+    Uint64       m_PooledBytes = 0;
+    const Uint64 m_MaxPoolSize;
+
+    RefCntAutoPtr<IDeviceContext> m_pCopyContext;
+
     RefCntAutoPtr<IFence> m_pFence;
     Uint64                m_NextFenceValue      = 1;
     Uint64                m_CompletedFenceValue = 0;
@@ -276,7 +390,7 @@ private:
 
 TextureUploaderD3D12_Vk::TextureUploaderD3D12_Vk(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData(pDevice)}
+    m_pInternalData{new InternalData(pDevice, Desc)}
 {
 }
 
@@ -330,17 +444,18 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
                                                     PendingBufferOperation& OperationInfo)
 {
     auto&       pUploadTex     = OperationInfo.pUploadTexture;
-    const auto& StagingTexDesc = pUploadTex->GetDesc();
+    const auto& UploadBuffDesc = pUploadTex->GetDesc();
+    auto* const pCmdContext    = GetCommandContext(pContext);
 
     switch (OperationInfo.operation)
     {
         case InternalData::PendingBufferOperation::Map:
         {
-            for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
+            for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
             {
-                for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
+                for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
                 {
-                    pUploadTex->Map(pContext, Mip, Slice);
+                    pUploadTex->Map(pCmdContext, Mip, Slice);
                 }
             }
             pUploadTex->SignalMapped();
@@ -350,11 +465,11 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
         case InternalData::PendingBufferOperation::Copy:
         {
             VERIFY(pUploadTex->DbgIsMapped(), "Upload texture must be copied only after it has been mapped");
-            for (Uint32 Slice = 0; Slice < StagingTexDesc.ArraySize; ++Slice)
+            for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
             {
-                for (Uint32 Mip = 0; Mip < StagingTexDesc.MipLevels; ++Mip)
+                for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
                 {
-                    pUploadTex->Unmap(pContext, Mip, Slice);
+                    pUploadTex->Unmap(pCmdContext, Mip, Slice);
 
                     CopyTextureAttribs CopyInfo //
                         {
@@ -367,7 +482,16 @@ void TextureUploaderD3D12_Vk::InternalData::Execute(IDeviceContext*         pCon
                     CopyInfo.SrcSlice    = Slice;
                     CopyInfo.DstMipLevel = OperationInfo.DstMip + Mip;
                     CopyInfo.DstSlice    = OperationInfo.DstSlice + Slice;
-                    pContext->CopyTexture(CopyInfo);
+
+                    // Staging texture from a size bucket may be larger than the uploaded data
+                    Box SrcBox;
+                    if (!(pUploadTex->GetStagingDesc() == UploadBuffDesc))
+                    {
+                        SrcBox.MaxX      = std::max(UploadBuffDesc.Width >> Mip, 1u);
+                        SrcBox.MaxY      = std::max(UploadBuffDesc.Height >> Mip, 1u);
+                        CopyInfo.pSrcBox = &SrcBox;
+                    }
+                    pCmdContext->CopyTexture(CopyInfo);
                 }
             }
         }
@@ -384,10 +508,12 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
     // No available buffer found in the cache
     if (!pUploadTexture)
     {
+        const auto BucketDesc = GetBucketDesc(Desc);
+
         TextureDesc StagingTexDesc;
         StagingTexDesc.Type           = Desc.ArraySize == 1 ? RESOURCE_DIM_TEX_2D : RESOURCE_DIM_TEX_2D_ARRAY;
-        StagingTexDesc.Width          = Desc.Width;
-        StagingTexDesc.Height         = Desc.Height;
+        StagingTexDesc.Width          = BucketDesc.Width;
+        StagingTexDesc.Height         = BucketDesc.Height;
         StagingTexDesc.Format         = Desc.Format;
         StagingTexDesc.MipLevels      = Desc.MipLevels;
         StagingTexDesc.ArraySize      = Desc.ArraySize;
@@ -397,11 +523,11 @@ void TextureUploaderD3D12_Vk::AllocateUploadBuffer(IDeviceContext*         pCont
         RefCntAutoPtr<ITexture> pStagingTexture;
         m_pDevice->CreateTexture(StagingTexDesc, nullptr, &pStagingTexture);
 
-        LOG_INFO_MESSAGE("Created ", Desc.Width, "x", Desc.Height, 'x', Desc.Depth, ' ', Desc.MipLevels, "-mip ",
+        LOG_INFO_MESSAGE("Created ", BucketDesc.Width, "x", BucketDesc.Height, 'x', BucketDesc.Depth, ' ', Desc.MipLevels, "-mip ",
                          Desc.ArraySize, "-slice ",
                          GetTextureFormatAttribs(Desc.Format).Name, " staging texture");
 
-        pUploadTexture = MakeNewRCObj<UploadTexture>()(Desc, pStagingTexture);
+        pUploadTexture = MakeNewRCObj<UploadTexture>()(Desc, BucketDesc, pStagingTexture);
     }
 
     if (pContext != nullptr)
@@ -465,6 +591,7 @@ TextureUploaderStats TextureUploaderD3D12_Vk::GetStats()
 {
     TextureUploaderStats Stats;
     Stats.NumPendingOperations = static_cast<Uint32>(m_pInternalData->GetNumPendingOperations());
+    m_pInternalData->GetPoolStats(Stats);
     return Stats;
 }
 
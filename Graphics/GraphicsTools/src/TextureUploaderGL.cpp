@@ -31,7 +31,31 @@
 #include <vector>
 #include <algorithm>
 
+#if PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_MACOS
+
+#    ifndef GLEW_STATIC
+#        define GLEW_STATIC // Must be defined to use static version of glew
+#    endif
+#    ifndef GLEW_NO_GLU
+#        define GLEW_NO_GLU
+#    endif
+
+#    include "GL/glew.h"
+
+#elif PLATFORM_ANDROID
+
+#    include <GLES3/gl3.h>
+
+#elif PLATFORM_IOS
+
+#    include <OpenGLES/ES3/gl.h>
+
+#else
+#    error Unsupported platform
+#endif
+
 #include "TextureUploaderGL.hpp"
+#include "BufferGL.h"
 #include "ThreadSignal.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
@@ -87,11 +111,22 @@ public:
         m_BufferMappedSignal.Trigger();
     }
 
-    void SignalCopyScheduled()
+    void SignalCopyScheduled(Uint64 FenceValue)
     {
+        m_CopyScheduledFenceValue = FenceValue;
         m_CopyScheduledSignal.Trigger();
     }
 
+    Uint64 GetCopyScheduledFenceValue() const
+    {
+        return m_CopyScheduledFenceValue;
+    }
+
+    bool IsPersistentlyMapped() const
+    {
+        return m_pPersistentData != nullptr;
+    }
+
     virtual void WaitForCopyScheduled() override final
     {
         m_CopyScheduledSignal.Wait();
@@ -141,6 +176,13 @@ private:
     RefCntAutoPtr<IBuffer> m_pStagingBuffer;
     std::vector<Uint32>    m_SubresourceOffsets;
     std::vector<Uint32>    m_SubresourceStrides;
+
+    // CPU address of the persistently mapped staging buffer. Such buffers are mapped once
+    // and can be written by worker threads without a round trip to the render thread.
+    Uint8* m_pPersistentData = nullptr;
+
+    // The fence value that is signaled when the GPU has finished reading the buffer
+    Uint64 m_CopyScheduledFenceValue = 0;
 };
 
 } // namespace
@@ -148,6 +190,13 @@ private:
 
 struct TextureUploaderGL::InternalData
 {
+    InternalData(IRenderDevice* pDevice)
+    {
+        FenceDesc fenceDesc;
+        fenceDesc.Name = "Texture uploader GL sync fence";
+        pDevice->CreateFence(fenceDesc, &m_pFence);
+    }
+
     void SwapMapQueues()
     {
         std::lock_guard<std::mutex> QueueLock(m_PendingOperationsMtx);
@@ -198,17 +247,63 @@ struct TextureUploaderGL::InternalData
                  IDeviceContext*         pContext,
                  PendingBufferOperation& OperationInfo);
 
+    Uint64 SignalFence(IDeviceContext* pContext)
+    {
+        // Fences can't be accessed from multiple threads simultaneously even
+        // when protected by mutex
+        auto FenceValue = m_NextFenceValue++;
+        pContext->EnqueueSignal(m_pFence, FenceValue);
+        return FenceValue;
+    }
+
+    void UpdateCompletedFenceValue()
+    {
+        // Fences can't be accessed from multiple threads simultaneously even
+        // when protected by mutex
+        const auto CompletedFenceValue = m_pFence->GetCompletedValue();
+
+        std::lock_guard<std::mutex> CacheLock(m_UploadBuffCacheMtx);
+        m_CompletedFenceValue = CompletedFenceValue;
+    }
+
+    RefCntAutoPtr<UploadBufferGL> FindCachedUploadBuffer(const UploadBufferDesc& Desc)
+    {
+        RefCntAutoPtr<UploadBufferGL> pUploadBuffer;
+        std::lock_guard<std::mutex>   CacheLock(m_UploadBuffCacheMtx);
+        auto                          DequeIt = m_UploadBufferCache.find(Desc);
+        if (DequeIt != m_UploadBufferCache.end())
+        {
+            auto& Deque = DequeIt->second;
+            if (!Deque.empty())
+            {
+                // Mapping a regular staging buffer with MAP_FLAG_DISCARD orphans its storage, but a persistently
+                // mapped buffer may only be reused after the GPU has finished reading it.
+                auto& FrontBuff = Deque.front();
+                if (!FrontBuff->IsPersistentlyMapped() || FrontBuff->GetCopyScheduledFenceValue() <= m_CompletedFenceValue)
+                {
+                    pUploadBuffer = std::move(FrontBuff);
+                    Deque.pop_front();
+                }
+            }
+        }
+        return pUploadBuffer;
+    }
+
     std::mutex                          m_PendingOperationsMtx;
     std::vector<PendingBufferOperation> m_PendingOperations;
     std::vector<PendingBufferOperation> m_InWorkOperations;
 
     std::mutex                                                                      m_UploadBuffCacheMtx;
     std::unordered_map<UploadBufferDesc, std::deque<RefCntAutoPtr<UploadBufferGL>>> m_UploadBufferCache;
+
+    RefCntAutoPtr<IFence> m_pFence;
+    Uint64                m_NextFenceValue      = 1;
+    Uint64                m_CompletedFenceValue = 0;
 };
 
 TextureUploaderGL::TextureUploaderGL(IReferenceCounters* pRefCounters, IRenderDevice* pDevice, const TextureUploaderDesc Desc) :
     TextureUploaderBase{pRefCounters, pDevice, Desc},
-    m_pInternalData{new InternalData{}}
+    m_pInternalData{new InternalData{pDevice}}
 {
 }
 
@@ -246,6 +341,7 @@ void TextureUploaderGL::RenderThreadUpdate(IDeviceContext* pContext)
         }
         m_pInternalData->m_InWorkOperations.clear();
     }
+    m_pInternalData->UpdateCompletedFenceValue();
 }
 
 void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
@@ -272,6 +368,14 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
 
             PVoid CpuAddress = nullptr;
             pContext->MapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE, MAP_FLAG_DISCARD, CpuAddress);
+
+            RefCntAutoPtr<IBufferGL> pStagingBufferGL{pBuffer->m_pStagingBuffer, IID_BufferGL};
+            if (pStagingBufferGL && pStagingBufferGL->IsPersistentlyMapped())
+            {
+                // The pointer remains valid after the buffer is unmapped, so the buffer never needs to be mapped again
+                pBuffer->m_pPersistentData = reinterpret_cast<Uint8*>(CpuAddress);
+                pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
+            }
             pBuffer->SetDataPtr(reinterpret_cast<Uint8*>(CpuAddress));
 
             pBuffer->SignalMapped();
@@ -281,7 +385,8 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
         case InternalData::PendingBufferOperation::Copy:
         {
             const auto& TexDesc = OperationInfo.pDstTexture->GetDesc();
-            pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
+            if (!pBuffer->IsPersistentlyMapped())
+                pContext->UnmapBuffer(pBuffer->m_pStagingBuffer, MAP_WRITE);
             for (Uint32 Slice = 0; Slice < UploadBuffDesc.ArraySize; ++Slice)
             {
                 for (Uint32 Mip = 0; Mip < UploadBuffDesc.MipLevels; ++Mip)
@@ -299,7 +404,9 @@ void TextureUploaderGL::InternalData::Execute(IRenderDevice*          pDevice,
                                             SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
                 }
             }
-            pBuffer->SignalCopyScheduled();
+            // The buffer may be recycled immediately after the copy scheduled is signaled,
+            // so we must signal the fence first.
+            pBuffer->SignalCopyScheduled(SignalFence(pContext));
         }
         break;
     }
@@ -310,25 +417,7 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
                                              IUploadBuffer**         ppBuffer)
 {
     *ppBuffer = nullptr;
-    RefCntAutoPtr<UploadBufferGL> pUploadBuffer;
-
-    {
-        std::lock_guard<std::mutex> CacheLock(m_pInternalData->m_UploadBuffCacheMtx);
-        auto&                       Cache = m_pInternalData->m_UploadBufferCache;
-        if (!Cache.empty())
-        {
-            auto DequeIt = Cache.find(Desc);
-            if (DequeIt != Cache.end())
-            {
-                auto& Deque = DequeIt->second;
-                if (!Deque.empty())
-                {
-                    pUploadBuffer.Attach(Deque.front().Detach());
-                    Deque.pop_front();
-                }
-            }
-        }
-    }
+    RefCntAutoPtr<UploadBufferGL> pUploadBuffer = m_pInternalData->FindCachedUploadBuffer(Desc);
 
     if (!pUploadBuffer)
     {
@@ -338,7 +427,13 @@ void TextureUploaderGL::AllocateUploadBuffer(IDeviceContext*         pContext,
                          m_pDevice->GetTextureFormatInfo(Desc.Format).Name, " texture");
     }
 
-    if (pContext != nullptr)
+    if (pUploadBuffer->IsPersistentlyMapped())
+    {
+        // Persistently mapped buffer can be used right away by any thread
+        pUploadBuffer->SetDataPtr(pUploadBuffer->m_pPersistentData);
+        pUploadBuffer->SignalMapped();
+    }
+    else if (pContext != nullptr)
     {
         // Render thread
         InternalData::PendingBufferOperation MapOp{InternalData::PendingBufferOperation::Operation::Map, pUploadBuffer};
@@ -372,6 +467,8 @@ void TextureUploaderGL::ScheduleGPUCopy(IDeviceContext* pContext,
                 MipLevel //
             };
         m_pInternalData->Execute(m_pDevice, pContext, CopyOp);
+        // This must be called by the same thread that signals the fence
+        m_pInternalData->UpdateCompletedFenceValue();
     }
     else
     {
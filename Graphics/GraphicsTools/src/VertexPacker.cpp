@@ -0,0 +1,475 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VertexPacker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+#include "BasicMathSIMD.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Vertices are converted in blocks of 4, one vertex per SIMD lane
+constexpr Uint32 BlockSize = 4;
+
+// The number of vertices packed by a single task
+constexpr Uint32 VerticesPerTask = 4096;
+
+// Block components in SoA layout: Comps[Component][Vertex]
+using BlockComponents = float[4][BlockSize];
+
+struct PackingInfo
+{
+    VALUE_TYPE ValueType;
+    bool       IsNormalized;
+};
+
+const PackingInfo& GetPackingInfo(VERTEX_PACKING Packing)
+{
+    static const PackingInfo PackingInfos[] =
+        {
+            {VT_FLOAT32, false}, // VERTEX_PACKING_FLOAT32
+            {VT_FLOAT16, false}, // VERTEX_PACKING_FLOAT16
+            {VT_INT16, true},    // VERTEX_PACKING_SNORM16
+            {VT_UINT16, true},   // VERTEX_PACKING_UNORM16
+            {VT_INT16, true},    // VERTEX_PACKING_OCT_SNORM16
+            {VT_UINT32, false},  // VERTEX_PACKING_UNORM10_10_10_2
+        };
+    static_assert(_countof(PackingInfos) == VERTEX_PACKING_COUNT, "Please update the table to handle the new vertex packing");
+    VERIFY_EXPR(Packing < VERTEX_PACKING_COUNT);
+    return PackingInfos[Packing];
+}
+
+Uint32 GetNumPackedComponents(const VertexAttributePackInfo& Attrib)
+{
+    switch (Attrib.Packing)
+    {
+        case VERTEX_PACKING_FLOAT32: return Attrib.NumComponents;
+        // Odd numbers of 16-bit components are padded to keep attributes 4-byte aligned
+        case VERTEX_PACKING_FLOAT16:
+        case VERTEX_PACKING_SNORM16:
+        case VERTEX_PACKING_UNORM16: return (Attrib.NumComponents + 1) & ~1u;
+        case VERTEX_PACKING_OCT_SNORM16: return 2;
+        case VERTEX_PACKING_UNORM10_10_10_2: return 1;
+        default:
+            UNEXPECTED("Unexpected vertex packing");
+            return 0;
+    }
+}
+
+#if DILIGENT_BASIC_MATH_SSE2
+#    define DILIGENT_FLOAT_TO_HALF_SSE2 1
+#elif DILIGENT_BASIC_MATH_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+#    define DILIGENT_FLOAT_TO_HALF_NEON 1
+#endif
+
+#if !DILIGENT_FLOAT_TO_HALF_SSE2 && !DILIGENT_FLOAT_TO_HALF_NEON
+// Converts the float to half with round-to-nearest-even, see Giesen F., "Half to float done quick".
+// The SSE2 version of FloatToHalf4() implements the same algorithm.
+Uint16 FloatToHalf(float f)
+{
+    constexpr Uint32 F32Infinity = 255u << 23u;
+    constexpr Uint32 F16Max      = (127u + 16u) << 23u;
+    constexpr Uint32 DenormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23u;
+
+    Uint32 u;
+    std::memcpy(&u, &f, sizeof(u));
+
+    const Uint32 Sign = u & 0x80000000u;
+    u ^= Sign;
+
+    Uint32 h;
+    if (u >= F16Max)
+    {
+        // Infinity or NaN
+        h = u > F32Infinity ? 0x7E00u : 0x7C00u;
+    }
+    else if (u < (113u << 23u))
+    {
+        // The result is a denormal or zero: let the float addition align and round the mantissa
+        float Magic;
+        std::memcpy(&Magic, &DenormMagic, sizeof(Magic));
+        float Denorm;
+        std::memcpy(&Denorm, &u, sizeof(Denorm));
+        Denorm += Magic;
+        std::memcpy(&h, &Denorm, sizeof(h));
+        h -= DenormMagic;
+    }
+    else
+    {
+        const Uint32 MantissaOdd = (u >> 13u) & 1u;
+        // Rebias the exponent and round the mantissa to nearest even
+        u += ((15u - 127u) << 23u) + 0xFFFu;
+        u += MantissaOdd;
+        h = u >> 13u;
+    }
+    return static_cast<Uint16>(h | (Sign >> 16u));
+}
+#endif
+
+void FloatToHalf4(const float (&Src)[BlockSize], Uint16 (&Dst)[BlockSize])
+{
+#if DILIGENT_FLOAT_TO_HALF_SSE2
+    const __m128i F32Infinity = _mm_set1_epi32(255 << 23);
+    const __m128i F16Max      = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i DenormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i MinNormal   = _mm_set1_epi32(113 << 23);
+
+    __m128i       u    = _mm_castps_si128(_mm_loadu_ps(Src));
+    const __m128i Sign = _mm_and_si128(u, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    u                  = _mm_xor_si128(u, Sign);
+
+    // Without the sign, the values fit into signed 32-bit integers and can be compared as such
+    const __m128i IsNaN  = _mm_cmpgt_epi32(u, F32Infinity);
+    const __m128i InfNaN = _mm_or_si128(_mm_and_si128(IsNaN, _mm_set1_epi32(0x7E00)), _mm_andnot_si128(IsNaN, _mm_set1_epi32(0x7C00)));
+
+    const __m128i Denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), _mm_castsi128_ps(DenormMagic))), DenormMagic);
+
+    const __m128i MantissaOdd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+    __m128i       Normal      = _mm_add_epi32(u, _mm_set1_epi32(static_cast<int>(((15u - 127u) << 23u) + 0xFFFu)));
+    Normal                    = _mm_srli_epi32(_mm_add_epi32(Normal, MantissaOdd), 13);
+
+    const __m128i IsFinite = _mm_cmpgt_epi32(F16Max, u);
+    const __m128i IsDenorm = _mm_cmplt_epi32(u, MinNormal);
+
+    __m128i h = _mm_or_si128(_mm_and_si128(IsDenorm, Denorm), _mm_andnot_si128(IsDenorm, Normal));
+    h         = _mm_or_si128(_mm_and_si128(IsFinite, h), _mm_andnot_si128(IsFinite, InfNaN));
+    h         = _mm_or_si128(h, _mm_srli_epi32(Sign, 16));
+
+    Int32 Halfs[BlockSize];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(Halfs), h);
+    for (Uint32 i = 0; i < BlockSize; ++i)
+        Dst[i] = static_cast<Uint16>(Halfs[i]);
+#elif DILIGENT_FLOAT_TO_HALF_NEON
+    vst1_u16(Dst, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(Src))));
+#else
+    for (Uint32 i = 0; i < BlockSize; ++i)
+        Dst[i] = FloatToHalf(Src[i]);
+#endif
+}
+
+// Clamps the values to [MinValue, 1], multiplies them by Scale and rounds to the nearest integer
+void Quantize4(const float (&Src)[BlockSize], float MinValue, float Scale, Int32 (&Dst)[BlockSize])
+{
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+    using namespace BasicMathSIMD;
+    VecType v = Mul(Min(Max(Load(Src), Set1(MinValue)), Set1(1.f)), Set1(Scale));
+    v         = Add(v, Select(CmpGE(v, Set1(0.f)), Set1(0.5f), Set1(-0.5f)));
+    StoreInt(Dst, v);
+#else
+    for (Uint32 i = 0; i < BlockSize; ++i)
+    {
+        const float v = std::min(std::max(Src[i], MinValue), 1.f) * Scale;
+        Dst[i]        = static_cast<Int32>(v >= 0 ? v + 0.5f : v - 0.5f);
+    }
+#endif
+}
+
+// Encodes the vectors in components 0-2 with the octahedral mapping and writes the result to components 0-1
+void EncodeOctahedral4(BlockComponents& Comps)
+{
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+    using namespace BasicMathSIMD;
+    const VecType Zero = Set1(0.f);
+    const VecType One  = Set1(1.f);
+    auto          Abs  = [Zero](VecType v) { return Max(v, Sub(Zero, v)); };
+
+    const VecType X = Load(Comps[0]);
+    const VecType Y = Load(Comps[1]);
+    const VecType Z = Load(Comps[2]);
+
+    // Project to the octahedron; zero vectors are mapped to (0, 0)
+    const VecType L1 = Max(Add(Add(Abs(X), Abs(Y)), Abs(Z)), Set1(1e-30f));
+    const VecType PX = Div(X, L1);
+    const VecType PY = Div(Y, L1);
+
+    // Fold the lower hemisphere over the diagonals
+    const VecType FX = Mul(Sub(One, Abs(PY)), Select(CmpGE(PX, Zero), One, Set1(-1.f)));
+    const VecType FY = Mul(Sub(One, Abs(PX)), Select(CmpGE(PY, Zero), One, Set1(-1.f)));
+
+    const VecType Lower = CmpLT(Z, Zero);
+    Store(Comps[0], Select(Lower, FX, PX));
+    Store(Comps[1], Select(Lower, FY, PY));
+#else
+    for (Uint32 i = 0; i < BlockSize; ++i)
+    {
+        const float L1 = std::max(std::abs(Comps[0][i]) + std::abs(Comps[1][i]) + std::abs(Comps[2][i]), 1e-30f);
+        const float PX = Comps[0][i] / L1;
+        const float PY = Comps[1][i] / L1;
+        if (Comps[2][i] < 0)
+        {
+            Comps[0][i] = (1.f - std::abs(PY)) * (PX >= 0 ? 1.f : -1.f);
+            Comps[1][i] = (1.f - std::abs(PX)) * (PY >= 0 ? 1.f : -1.f);
+        }
+        else
+        {
+            Comps[0][i] = PX;
+            Comps[1][i] = PY;
+        }
+    }
+#endif
+}
+
+template <typename T>
+void WriteComponents(const T (&Values)[4][BlockSize], Uint32 NumComponents, Uint32 NumVertices, Uint8* pDst, Uint32 DstStride)
+{
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        T Vertex[4];
+        for (Uint32 c = 0; c < NumComponents; ++c)
+            Vertex[c] = Values[c][v];
+        std::memcpy(pDst + size_t{v} * DstStride, Vertex, sizeof(T) * NumComponents);
+    }
+}
+
+void PackBlock(const VertexAttributePackInfo& Attrib,
+               Uint32                         NumPackedComps,
+               BlockComponents&               Comps,
+               Uint32                         NumVertices,
+               Uint8*                         pDst,
+               Uint32                         DstStride)
+{
+    switch (Attrib.Packing)
+    {
+        case VERTEX_PACKING_FLOAT32:
+        {
+            WriteComponents(Comps, NumPackedComps, NumVertices, pDst, DstStride);
+            break;
+        }
+
+        case VERTEX_PACKING_FLOAT16:
+        {
+            Uint16 Halfs[4][BlockSize];
+            for (Uint32 c = 0; c < NumPackedComps; ++c)
+                FloatToHalf4(Comps[c], Halfs[c]);
+            WriteComponents(Halfs, NumPackedComps, NumVertices, pDst, DstStride);
+            break;
+        }
+
+        case VERTEX_PACKING_SNORM16:
+        case VERTEX_PACKING_UNORM16:
+        case VERTEX_PACKING_OCT_SNORM16:
+        {
+            if (Attrib.Packing == VERTEX_PACKING_OCT_SNORM16)
+                EncodeOctahedral4(Comps);
+
+            Int32 Quantized[4][BlockSize];
+            for (Uint32 c = 0; c < NumPackedComps; ++c)
+            {
+                if (Attrib.Packing == VERTEX_PACKING_UNORM16)
+                    Quantize4(Comps[c], 0.f, 65535.f, Quantized[c]);
+                else
+                    Quantize4(Comps[c], -1.f, 32767.f, Quantized[c]);
+            }
+
+            Uint16 Values[4][BlockSize];
+            for (Uint32 c = 0; c < NumPackedComps; ++c)
+            {
+                for (Uint32 v = 0; v < BlockSize; ++v)
+                    Values[c][v] = static_cast<Uint16>(Quantized[c][v]);
+            }
+            WriteComponents(Values, NumPackedComps, NumVertices, pDst, DstStride);
+            break;
+        }
+
+        case VERTEX_PACKING_UNORM10_10_10_2:
+        {
+            Int32 Quantized[4][BlockSize];
+            for (Uint32 c = 0; c < 3; ++c)
+                Quantize4(Comps[c], 0.f, 1023.f, Quantized[c]);
+            Quantize4(Comps[3], 0.f, 3.f, Quantized[3]);
+
+            Uint32 Packed[4][BlockSize] = {};
+            for (Uint32 v = 0; v < BlockSize; ++v)
+            {
+                Packed[0][v] = static_cast<Uint32>(Quantized[0][v]) |
+                    (static_cast<Uint32>(Quantized[1][v]) << 10u) |
+                    (static_cast<Uint32>(Quantized[2][v]) << 20u) |
+                    (static_cast<Uint32>(Quantized[3][v]) << 30u);
+            }
+            WriteComponents(Packed, 1, NumVertices, pDst, DstStride);
+            break;
+        }
+
+        default:
+            UNEXPECTED("Unexpected vertex packing");
+    }
+}
+
+} // namespace
+
+
+VertexPacker::VertexPacker(const VertexAttributePackInfo* pAttribs, Uint32 NumAttribs, Uint32 BufferSlot) :
+    m_Attribs{pAttribs, pAttribs + NumAttribs}
+{
+    if (NumAttribs > MAX_LAYOUT_ELEMENTS)
+        LOG_ERROR_AND_THROW("The number of attributes (", NumAttribs, ") exceeds the maximum number of layout elements (", MAX_LAYOUT_ELEMENTS, ")");
+
+    m_Elements.reserve(NumAttribs);
+    for (Uint32 i = 0; i < NumAttribs; ++i)
+    {
+        const auto& Attrib = m_Attribs[i];
+        if (Attrib.NumComponents < 1 || Attrib.NumComponents > 4)
+            LOG_ERROR_AND_THROW("Attribute ", i, ": the number of components (", Attrib.NumComponents, ") must be between 1 and 4");
+        if (Attrib.Packing >= VERTEX_PACKING_COUNT)
+            LOG_ERROR_AND_THROW("Attribute ", i, ": unknown vertex packing (", Uint32{Attrib.Packing}, ")");
+        if (Attrib.Packing == VERTEX_PACKING_OCT_SNORM16 && Attrib.NumComponents != 3)
+            LOG_ERROR_AND_THROW("Attribute ", i, ": octahedral encoding requires three components");
+        if (Attrib.Packing == VERTEX_PACKING_UNORM10_10_10_2 && Attrib.NumComponents < 3)
+            LOG_ERROR_AND_THROW("Attribute ", i, ": 10:10:10:2 packing requires three or four components");
+
+        const auto& Info = GetPackingInfo(Attrib.Packing);
+
+        LayoutElement Elem;
+        Elem.InputIndex     = Attrib.InputIndex;
+        Elem.BufferSlot     = BufferSlot;
+        Elem.NumComponents  = GetNumPackedComponents(Attrib);
+        Elem.ValueType      = Info.ValueType;
+        Elem.IsNormalized   = Info.IsNormalized;
+        Elem.RelativeOffset = m_Stride;
+        m_Elements.push_back(Elem);
+
+        m_Stride += Elem.NumComponents * GetValueSize(Elem.ValueType);
+        VERIFY(m_Stride % 4 == 0, "Packed attributes must be 4-byte aligned");
+    }
+
+    for (auto& Elem : m_Elements)
+        Elem.Stride = m_Stride;
+}
+
+void VertexPacker::PackRange(const VertexAttributeSource* pSources, Uint32 FirstVertex, Uint32 NumVertices, void* pDstData) const
+{
+    auto* const pDstRange = static_cast<Uint8*>(pDstData) + size_t{FirstVertex} * m_Stride;
+
+    for (Uint32 BlockStart = 0; BlockStart < NumVertices; BlockStart += BlockSize)
+    {
+        const auto NumBlockVertices = std::min(BlockSize, NumVertices - BlockStart);
+        for (size_t a = 0; a < m_Attribs.size(); ++a)
+        {
+            const auto& Attrib    = m_Attribs[a];
+            const auto& Src       = pSources[a];
+            const auto  SrcStride = Src.Stride != 0 ? Src.Stride : Attrib.NumComponents * Uint32{sizeof(float)};
+            const auto* pSrc      = static_cast<const Uint8*>(Src.pData) + size_t{FirstVertex + BlockStart} * SrcStride;
+
+            // Missing components get the defaults of the vertex fetch and are not transformed
+            BlockComponents Comps;
+            for (Uint32 c = 0; c < 4; ++c)
+            {
+                for (Uint32 v = 0; v < BlockSize; ++v)
+                    Comps[c][v] = c == 3 ? 1.f : 0.f;
+            }
+            for (Uint32 v = 0; v < NumBlockVertices; ++v)
+            {
+                float Vertex[4];
+                std::memcpy(Vertex, pSrc + size_t{v} * SrcStride, sizeof(float) * Attrib.NumComponents);
+                for (Uint32 c = 0; c < Attrib.NumComponents; ++c)
+                    Comps[c][v] = Vertex[c] * Attrib.Scale[c] + Attrib.Bias[c];
+            }
+
+            PackBlock(Attrib, m_Elements[a].NumComponents, Comps, NumBlockVertices,
+                      pDstRange + size_t{BlockStart} * m_Stride + m_Elements[a].RelativeOffset, m_Stride);
+        }
+    }
+}
+
+void VertexPacker::Pack(const VertexAttributeSource* pSources, Uint32 NumVertices, void* pDstData, IThreadPool* pThreadPool) const
+{
+    if (NumVertices == 0)
+        return;
+
+    DEV_CHECK_ERR(pSources != nullptr || m_Attribs.empty(), "Attribute sources must not be null");
+    DEV_CHECK_ERR(pDstData != nullptr, "Destination data must not be null");
+#ifdef DILIGENT_DEVELOPMENT
+    for (size_t a = 0; a < m_Attribs.size(); ++a)
+    {
+        DEV_CHECK_ERR(pSources[a].pData != nullptr, "Source data of attribute ", a, " must not be null");
+        DEV_CHECK_ERR(pSources[a].Stride == 0 || pSources[a].Stride >= m_Attribs[a].NumComponents * sizeof(float),
+                      "Source stride (", pSources[a].Stride, ") of attribute ", a, " is too small");
+    }
+#endif
+
+    const auto NumRanges = (NumVertices + VerticesPerTask - 1) / VerticesPerTask;
+
+    auto PackTaskRange = [this, pSources, NumVertices, pDstData](Uint32 Range) {
+        const auto FirstVertex = Range * VerticesPerTask;
+        PackRange(pSources, FirstVertex, std::min(VerticesPerTask, NumVertices - FirstVertex), pDstData);
+    };
+
+    const auto NumTasks = pThreadPool != nullptr ? std::min(pThreadPool->GetThreadCount(), NumRanges - 1) : 0;
+    if (NumTasks == 0)
+    {
+        for (Uint32 Range = 0; Range < NumRanges; ++Range)
+            PackTaskRange(Range);
+        return;
+    }
+
+    // The state is shared with the tasks that may start after this function has returned.
+    // Such tasks find no ranges left and do not touch the data.
+    struct ParallelState
+    {
+        std::atomic<Uint32>     NextRange{0};
+        std::atomic<Uint32>     NumRangesDone{0};
+        std::mutex              Mtx;
+        std::condition_variable RangesDoneCV;
+    };
+    auto pState = std::make_shared<ParallelState>();
+
+    auto ProcessRanges = [pState, PackTaskRange, NumRanges]() {
+        for (auto Range = pState->NextRange.fetch_add(1); Range < NumRanges; Range = pState->NextRange.fetch_add(1))
+        {
+            PackTaskRange(Range);
+            if (pState->NumRangesDone.fetch_add(1) + 1 == NumRanges)
+            {
+                std::lock_guard<std::mutex> Lock{pState->Mtx};
+                pState->RangesDoneCV.notify_all();
+            }
+        }
+    };
+
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        EnqueueTask(pThreadPool, ProcessRanges);
+
+    ProcessRanges();
+
+    std::unique_lock<std::mutex> Lock{pState->Mtx};
+    pState->RangesDoneCV.wait(Lock, [&]() { return pState->NumRangesDone.load() == NumRanges; });
+}
+
+} // namespace Diligent
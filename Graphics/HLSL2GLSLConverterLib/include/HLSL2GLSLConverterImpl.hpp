@@ -32,12 +32,17 @@
 #include <unordered_map>
 #include <vector>
 #include <array>
+#include <memory>
+#include <mutex>
 
 #include "HLSL2GLSLConverter.h"
 #include "ObjectBase.hpp"
 #include "HLSLKeywords.h"
 #include "Shader.h"
 #include "HashUtils.hpp"
+#include "FlatHashMap.hpp"
+#include "DynamicLinearAllocator.hpp"
+#include "STDAllocator.hpp"
 #include "HLSLKeywords.h"
 #include "Constants.h"
 
@@ -214,7 +219,7 @@ private:
     // Hash map that maps GLSL object, method and number of arguments
     // passed to the original function, to the GLSL stub function
     // Example: {"sampler2D", "Sample", 2} -> {"Sample_2", "_SWIZZLE"}
-    std::unordered_map<FunctionStubHashKey, GLSLStubInfo, FunctionStubHashKey::Hasher> m_GLSLStubs;
+    FlatHashMap<FunctionStubHashKey, GLSLStubInfo, FunctionStubHashKey::Hasher> m_GLSLStubs;
 
     // clang-format off
     enum class TokenType
@@ -276,7 +281,31 @@ private:
             Delimiter{_Delimiter}
         {}
     };
-    typedef std::list<TokenInfo> TokenListType;
+
+    // Linear allocator for token list nodes. A conversion creates and erases tokens
+    // all the time, so nodes are never freed individually: all memory is released at once
+    // when the allocator is destroyed together with the token list that uses it.
+    class TokenAllocator final : public IMemoryAllocator
+    {
+    public:
+        explicit TokenAllocator(IMemoryAllocator& RawAllocator) :
+            m_Allocator{RawAllocator, 64 << 10}
+        {}
+
+        virtual void* Allocate(size_t Size, const Char* /*dbgDescription*/, const char* /*dbgFileName*/, const Int32 /*dbgLineNumber*/) override final
+        {
+            return m_Allocator.Allocate(Size, alignof(std::max_align_t));
+        }
+
+        virtual void Free(void* /*Ptr*/) override final
+        {
+        }
+
+    private:
+        DynamicLinearAllocator m_Allocator;
+    };
+
+    typedef std::list<TokenInfo, STDAllocatorRawMem<TokenInfo>> TokenListType;
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -325,8 +354,13 @@ private:
         const String& GetInputFileName() const { return m_InputFileName; }
 
     private:
-        void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
-        void Tokenize(const String& Source);
+        void ExpandIncludes(const String&                    Source,
+                            bool                             IsIncludeFile,
+                            IShaderSourceInputStreamFactory* pSourceStreamFactory,
+                            std::unordered_set<String>&      ProcessedIncludes);
+        void AddSourceChunk(String::const_iterator Start, String::const_iterator End, bool IsIncludeFile);
+        void BuildTokens();
+        void Tokenize(const String& Source, TokenListType& Tokens, String& TrailingDelimiter) const;
 
         typedef std::unordered_map<String, bool> SamplerHashType;
 
@@ -510,8 +544,25 @@ private:
 
         String BuildGLSLSource();
 
-        // Tokenized source code
-        TokenListType m_Tokens;
+        // Source code with all #include directives expanded, split into chunks at the directives,
+        // so that the chunks of common include files are only tokenized once by all streams.
+        // The chunks are released when the source is tokenized.
+        struct SourceChunk
+        {
+            String Text;
+            size_t Hash          = 0;
+            bool   IsIncludeFile = false;
+        };
+        std::vector<SourceChunk> m_SourceChunks;
+
+        // Hash of the expanded source code
+        size_t m_SourceHash = 0;
+
+        // Tokenized source code. The source is only tokenized when the converted
+        // code is not found in the converter cache.
+        TokenAllocator m_TokenAllocator;
+        TokenListType  m_Tokens;
+        bool          m_bTokenized = false;
 
         // List of tokens defining structs
         std::unordered_map<HashMapStringKey, TokenListType::iterator, HashMapStringKey::Hasher> m_StructDefinitions;
@@ -552,6 +603,31 @@ private:
     static constexpr int MaxShaderStages = 6; // Maximum supported shader stages: VS, GS, PS, DS, HS, CS
 
     std::array<std::array<std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher>, 2>, MaxShaderStages> m_HLSLSemanticToGLSLVar;
+
+    struct TokenizedChunk
+    {
+        explicit TokenizedChunk(IMemoryAllocator& RawAllocator) :
+            Allocator{RawAllocator},
+            Tokens{STD_ALLOCATOR_RAW_MEM(TokenInfo, Allocator, "Allocator for std::list<TokenInfo>")}
+        {}
+
+        TokenAllocator Allocator;
+        TokenListType  Tokens;
+        // Delimiter after the last token that is prepended to the first token of the next chunk
+        String TrailingDelimiter;
+    };
+
+    mutable std::mutex m_CacheMtx;
+
+    // Tokenized include file chunks, keyed by the hash of the chunk text
+    mutable FlatHashMap<size_t, std::shared_ptr<const TokenizedChunk>> m_TokenizedChunks;
+
+    // Converted GLSL source code, keyed by the hash of the expanded HLSL source and the conversion
+    // attributes. The cache is cleared when the total size exceeds MaxConvertedSourcesSize.
+    mutable FlatHashMap<size_t, String> m_ConvertedSources;
+    mutable size_t                      m_ConvertedSourcesSize = 0;
+
+    static constexpr size_t MaxConvertedSourcesSize = size_t{32} << 20;
 };
 
 } // namespace Diligent
@@ -533,7 +533,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
         const auto& Pref = Prefixes[i];
         const auto& Suff = Suffixes[i];
         // GetDimensions() does not return anything, so swizzle should be empty
-#define DEFINE_GET_DIM_STUB(Name, Obj, NumArgs) m_GLSLStubs.emplace(make_pair(FunctionStubHashKey(Pref + Obj + Suff, "GetDimensions", NumArgs), GLSLStubInfo(Name, "")))
+#define DEFINE_GET_DIM_STUB(Name, Obj, NumArgs) m_GLSLStubs.emplace(FunctionStubHashKey(Pref + Obj + Suff, "GetDimensions", NumArgs), GLSLStubInfo(Name, ""))
 
         DEFINE_GET_DIM_STUB("GetTex1DDimensions_1", "sampler1D", 1); // GetDimensions( Width )
         DEFINE_GET_DIM_STUB("GetTex1DDimensions_3", "sampler1D", 3); // GetDimensions( Mip, Width, NumberOfMips )
@@ -601,7 +601,7 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
             // Tex2D.Sample(Tex2D_sampler, f2UV) -> Sample_2(Tex2D, Tex2D_sampler, f2UV)_SWIZZLE3
             const Char* Swizzle = "_SWIZZLE";
 
-#define DEFINE_STUB(Name, Obj, Func, NumArgs) m_GLSLStubs.emplace(make_pair(FunctionStubHashKey(Obj, Func, NumArgs), GLSLStubInfo(Name, Swizzle)))
+#define DEFINE_STUB(Name, Obj, Func, NumArgs) m_GLSLStubs.emplace(FunctionStubHashKey(Obj, Func, NumArgs), GLSLStubInfo(Name, Swizzle))
 
             // clang-format off
             DEFINE_STUB("Sample_2",      GLSLSampler, "Sample",      2); // Sample     ( Sampler, Location )
@@ -968,24 +968,26 @@ bool SkipPrefix(const Char* RefStr, IterType& begin, IterType end)
     return false;
 }
 
-// The method scans the source code and replaces
-// all #include directives with the contents of the
-// file. It maintains a set of already parsed includes
-// to avoid double inclusion
-void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory)
+// The method scans the source code for #include directives and splits it into chunks
+// at the directives. The contents of every included file is recursively expanded in
+// place of the directive, so that the chunks follow in the same order as the text of
+// the fully expanded source. It maintains a set of already parsed includes to avoid
+// double inclusion
+void HLSL2GLSLConverterImpl::ConversionStream::ExpandIncludes(const String&                    Source,
+                                                              bool                             IsIncludeFile,
+                                                              IShaderSourceInputStreamFactory* pSourceStreamFactory,
+                                                              std::unordered_set<String>&      ProcessedIncludes)
 {
-    // Put all the includes into the set to avoid multiple inclusion
-    std::unordered_set<String> ProcessedIncludes;
-
+    auto ChunkStart = Source.begin();
+    auto Pos        = Source.begin();
     do
     {
-        // Find the first #include statement
-        auto Pos             = GLSLSource.begin();
-        auto IncludeStartPos = GLSLSource.end();
-        while (Pos != GLSLSource.end())
+        // Find the next #include statement
+        auto IncludeStartPos = Source.end();
+        while (Pos != Source.end())
         {
             // #   include "TestFile.fxh"
-            if (SkipDelimetersAndComments(GLSLSource, Pos))
+            if (SkipDelimetersAndComments(Source, Pos))
                 break;
             if (*Pos == '#')
             {
@@ -995,14 +997,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
                 ++Pos;
                 // #   include "TestFile.fxh"
                 //  ^
-                if (SkipDelimetersAndComments(GLSLSource, Pos))
+                if (SkipDelimetersAndComments(Source, Pos))
                 {
                     // End of the file reached - break
                     break;
                 }
                 // #   include "TestFile.fxh"
                 //     ^
-                if (SkipPrefix("include", Pos, GLSLSource.end()))
+                if (SkipPrefix("include", Pos, Source.end()))
                 {
                     // #   include "TestFile.fxh"
                     //            ^
@@ -1020,11 +1022,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         }
 
         // No more #include found
-        if (Pos == GLSLSource.end())
+        if (Pos == Source.end())
             break;
 
         // Find open quotes
-        if (SkipDelimetersAndComments(GLSLSource, Pos))
+        if (SkipDelimetersAndComments(Source, Pos))
             LOG_ERROR_AND_THROW("Unexpected EOF after #include directive");
         // #   include "TestFile.fxh"
         //             ^
@@ -1035,10 +1037,10 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         //              ^
         auto IncludeNameStartPos = Pos;
         // Find closing quotes
-        while (Pos != GLSLSource.end() && *Pos != '\"' && *Pos != '>') ++Pos;
+        while (Pos != Source.end() && *Pos != '\"' && *Pos != '>') ++Pos;
         // #   include "TestFile.fxh"
         //                          ^
-        if (Pos == GLSLSource.end())
+        if (Pos == Source.end())
             LOG_ERROR_AND_THROW("Missing closing quotes or \'>\' after #include directive");
 
         // Get the name of the include file
@@ -1047,31 +1049,115 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         // #   include "TestFile.fxh"
         // ^                         ^
         // IncludeStartPos           Pos
-        GLSLSource.erase(IncludeStartPos, Pos);
+        AddSourceChunk(ChunkStart, IncludeStartPos, IsIncludeFile);
+        ChunkStart = Pos;
 
         // Convert the name to lower case
         String IncludeFileLowercase = StrToLower(IncludeName);
         // Insert the lower-case name into the set
         auto It = ProcessedIncludes.insert(IncludeFileLowercase);
         // If the name was actually inserted, which means the include encountered for the first time,
-        // replace the text with the file content
+        // replace the directive with the file content
         if (It.second)
         {
             RefCntAutoPtr<IFileStream> pIncludeDataStream;
             pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
             if (!pIncludeDataStream)
                 LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
-            RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
-            pIncludeDataStream->ReadBlob(pIncludeData);
+            RefCntAutoPtr<IDataBlob> pIncludeData;
+            pIncludeDataStream->ReadBlob2(&pIncludeData);
 
             // Get include text
-            auto   IncludeText = reinterpret_cast<const Char*>(pIncludeData->GetDataPtr());
+            auto   IncludeText = reinterpret_cast<const Char*>(pIncludeData->GetConstDataPtr());
             size_t NumSymbols  = pIncludeData->GetSize();
 
-            // Insert the text into source
-            GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+            ExpandIncludes(String{IncludeText, NumSymbols}, true, pSourceStreamFactory, ProcessedIncludes);
         }
     } while (true);
+
+    AddSourceChunk(ChunkStart, Source.end(), IsIncludeFile);
+}
+
+void HLSL2GLSLConverterImpl::ConversionStream::AddSourceChunk(String::const_iterator Start, String::const_iterator End, bool IsIncludeFile)
+{
+    if (Start == End)
+        return;
+
+    SourceChunk Chunk;
+    Chunk.Text.assign(Start, End);
+    Chunk.Hash          = ComputeHashRaw(Chunk.Text.data(), Chunk.Text.length());
+    Chunk.IsIncludeFile = IsIncludeFile;
+    HashCombine(m_SourceHash, Chunk.Hash);
+    m_SourceChunks.emplace_back(std::move(Chunk));
+}
+
+// Tokenizes all source chunks and concatenates the tokens.
+// Tokens of include file chunks are cached by the converter.
+//
+// Note that tokens are never merged across chunk boundaries (e.g. '+' and '=' into '+='), but
+// the boundaries are at #include directives that occupy the whole line in any valid source.
+void HLSL2GLSLConverterImpl::ConversionStream::BuildTokens()
+{
+    VERIFY_EXPR(!m_bTokenized);
+
+    // Push empty node in the beginning of the list to facilitate
+    // backwards searching
+    m_Tokens.push_back(TokenInfo());
+
+    // Delimiters of the chunks are glued together: the trailing delimiter of a chunk
+    // goes to the first token of the next non-empty chunk
+    String PendingDelimiter;
+    auto   ProcessDelimiters = [&](TokenListType::iterator FirstToken, const String& TrailingDelimiter) {
+        if (FirstToken != m_Tokens.end())
+        {
+            FirstToken->Delimiter.insert(0, PendingDelimiter);
+            PendingDelimiter.clear();
+        }
+        PendingDelimiter.append(TrailingDelimiter);
+    };
+
+    for (const auto& Chunk : m_SourceChunks)
+    {
+        if (Chunk.IsIncludeFile)
+        {
+            std::shared_ptr<const TokenizedChunk> pChunk;
+            {
+                std::lock_guard<std::mutex> Lock{m_Converter.m_CacheMtx};
+
+                auto It = m_Converter.m_TokenizedChunks.find(Chunk.Hash);
+                if (It != m_Converter.m_TokenizedChunks.end())
+                    pChunk = It->second;
+            }
+
+            if (!pChunk)
+            {
+                auto pNewChunk = std::make_shared<TokenizedChunk>(GetRawAllocator());
+                Tokenize(Chunk.Text, pNewChunk->Tokens, pNewChunk->TrailingDelimiter);
+
+                std::lock_guard<std::mutex> Lock{m_Converter.m_CacheMtx};
+                pChunk = m_Converter.m_TokenizedChunks.emplace(Chunk.Hash, std::move(pNewChunk)).first->second;
+            }
+
+            auto LastToken = std::prev(m_Tokens.end());
+            m_Tokens.insert(m_Tokens.end(), pChunk->Tokens.begin(), pChunk->Tokens.end());
+            ProcessDelimiters(std::next(LastToken), pChunk->TrailingDelimiter);
+        }
+        else
+        {
+            // Tokenize directly into the stream's allocator so that the nodes can be spliced
+            TokenListType Tokens{m_Tokens.get_allocator()};
+            String        TrailingDelimiter;
+            Tokenize(Chunk.Text, Tokens, TrailingDelimiter);
+
+            auto LastToken = std::prev(m_Tokens.end());
+            m_Tokens.splice(m_Tokens.end(), Tokens);
+            ProcessDelimiters(std::next(LastToken), TrailingDelimiter);
+        }
+    }
+
+    m_SourceChunks.clear();
+    m_SourceChunks.shrink_to_fit();
+    m_bTokenized = true;
 }
 
 
@@ -1114,8 +1200,9 @@ void ReadNumericConstant(const String& Source, String::const_iterator& Pos, Stri
 }
 
 
-// The function convertes source code into a token list
-void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
+// The function convertes source code into a token list. The delimiter after the last token
+// is written to TrailingDelimiter.
+void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source, TokenListType& Tokens, String& TrailingDelimiter) const
 {
 #define CHECK_END(...)                      \
     do                                      \
@@ -1131,10 +1218,6 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
     int OpenBraceCount   = 0;
     int OpenStapleCount  = 0;
 
-    // Push empty node in the beginning of the list to facilitate
-    // backwards searching
-    m_Tokens.push_back(TokenInfo());
-
     // https://msdn.microsoft.com/en-us/library/windows/desktop/bb509638(v=vs.85).aspx
 
     // Notes:
@@ -1154,7 +1237,10 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
             NewToken.Delimiter.append(DelimStart, SrcPos);
         }
         if (SrcPos == Source.end())
+        {
+            TrailingDelimiter = std::move(NewToken.Delimiter);
             break;
+        }
 
         switch (*SrcPos)
         {
@@ -1178,9 +1264,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 break;
 
             case '=':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "")
+                if (!Tokens.empty() && NewToken.Delimiter.empty())
                 {
-                    auto& LastToken = m_Tokens.back();
+                    auto& LastToken = Tokens.back();
                     // +=, -=, *=, /=, %=, <<=, >>=, &=, |=, ^=
                     if (LastToken.Literal == "+" ||
                         LastToken.Literal == "-" ||
@@ -1214,11 +1300,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '|':
             case '&':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!Tokens.empty() && NewToken.Delimiter.empty() &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BooleanOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    Tokens.back().Type = TokenType::BooleanOp;
+                    Tokens.back().Literal.push_back(*(SrcPos++));
                     continue;
                 }
                 else
@@ -1230,11 +1316,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '<':
             case '>':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!Tokens.empty() && NewToken.Delimiter.empty() &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::BitwiseOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    Tokens.back().Type = TokenType::BitwiseOp;
+                    Tokens.back().Literal.push_back(*(SrcPos++));
                     continue;
                 }
                 else
@@ -1249,11 +1335,11 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
 
             case '+':
             case '-':
-                if (m_Tokens.size() > 0 && NewToken.Delimiter == "" &&
-                    m_Tokens.back().Literal.length() == 1 && m_Tokens.back().Literal[0] == *SrcPos)
+                if (!Tokens.empty() && NewToken.Delimiter.empty() &&
+                    Tokens.back().Literal.length() == 1 && Tokens.back().Literal[0] == *SrcPos)
                 {
-                    m_Tokens.back().Type = TokenType::IncDecOp;
-                    m_Tokens.back().Literal.push_back(*(SrcPos++));
+                    Tokens.back().Type = TokenType::IncDecOp;
+                    Tokens.back().Literal.push_back(*(SrcPos++));
                     continue;
                 }
                 else
@@ -1366,7 +1452,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
             }
         }
 
-        m_Tokens.push_back(NewToken);
+        Tokens.emplace_back(std::move(NewToken));
     }
 #undef CHECK_END
 }
@@ -4809,8 +4895,10 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            size_t                           NumSymbols,
                                                            bool                             bPreserveTokens) :
     // clang-format off
-    TBase            {pRefCounters   },
-    m_bPreserveTokens{bPreserveTokens},
+    TBase            {pRefCounters      },
+    m_TokenAllocator {GetRawAllocator() },
+    m_Tokens         {STD_ALLOCATOR_RAW_MEM(TokenInfo, m_TokenAllocator, "Allocator for std::list<TokenInfo>")},
+    m_bPreserveTokens{bPreserveTokens   },
     m_Converter      {Converter      },
     m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
 // clang-format on
@@ -4829,17 +4917,13 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         if (pSourceStream == nullptr)
             LOG_ERROR_AND_THROW("Failed to open shader source file ", InputFileName);
 
-        pFileData = MakeNewRCObj<DataBlobImpl>()(0);
-        pSourceStream->ReadBlob(pFileData);
-        HLSLSource = reinterpret_cast<char*>(pFileData->GetDataPtr());
+        pSourceStream->ReadBlob2(&pFileData);
+        HLSLSource = reinterpret_cast<const char*>(pFileData->GetConstDataPtr());
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
-
-    InsertIncludes(Source, pInputStreamFactory);
-
-    Tokenize(Source);
+    std::unordered_set<String> ProcessedIncludes;
+    ExpandIncludes(String{HLSLSource, NumSymbols}, false, pInputStreamFactory, ProcessedIncludes);
 }
 
 
@@ -4925,8 +5009,23 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          const char* SamplerSuffix,
                                                          bool        UseInOutLocationQualifiers)
 {
+    // The same source may be converted many times (e.g. by different pipelines that
+    // share the shader), so look up the result of a previous conversion first
+    const auto ConversionKey = ComputeHash(m_SourceHash, String{EntryPoint}, ShaderType, IncludeDefintions,
+                                           String{SamplerSuffix != nullptr ? SamplerSuffix : ""}, UseInOutLocationQualifiers);
+    {
+        std::lock_guard<std::mutex> Lock{m_Converter.m_CacheMtx};
+
+        auto It = m_Converter.m_ConvertedSources.find(ConversionKey);
+        if (It != m_Converter.m_ConvertedSources.end())
+            return It->second;
+    }
+
+    if (!m_bTokenized)
+        BuildTokens();
+
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType{m_Tokens.get_allocator()});
 
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
@@ -5167,6 +5266,19 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     if (IncludeDefintions)
         GLSLSource.insert(0, g_GLSLDefinitions);
 
+    {
+        std::lock_guard<std::mutex> Lock{m_Converter.m_CacheMtx};
+
+        // Bound the memory used by the cache: when the limit is exceeded, start over
+        if (m_Converter.m_ConvertedSourcesSize + GLSLSource.length() > MaxConvertedSourcesSize)
+        {
+            m_Converter.m_ConvertedSources.clear();
+            m_Converter.m_ConvertedSourcesSize = 0;
+        }
+        if (m_Converter.m_ConvertedSources.emplace(ConversionKey, GLSLSource).second)
+            m_Converter.m_ConvertedSourcesSize += GLSLSource.length();
+    }
+
     return GLSLSource;
 }
 
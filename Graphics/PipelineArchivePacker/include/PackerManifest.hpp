@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Pipeline archive packer manifest
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GraphicsTypes.h"
+#include "Shader.h"
+#include "PipelineState.h"
+#include "Sampler.h"
+
+namespace Diligent
+{
+
+/// Packer manifest that lists the shaders, resource signatures and pipelines to put into the archive.
+
+/// The manifest is a text file with one directive per line. Tokens are separated by white
+/// space, and everything after '#' is a comment. Named options have the form key=value,
+/// lists are comma-separated. See readme.md for the full description of the directives.
+struct PackerManifest
+{
+    struct Shader
+    {
+        std::string                                      Name;
+        SHADER_TYPE                                      Type = SHADER_TYPE_UNKNOWN;
+        std::string                                      FilePath;
+        std::string                                      EntryPoint     = "main";
+        SHADER_SOURCE_LANGUAGE                           SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        std::vector<std::pair<std::string, std::string>> Macros;
+        bool                                             UseCombinedTextureSamplers = false;
+        std::string                                      CombinedSamplerSuffix      = "_sampler";
+    };
+
+    struct Signature
+    {
+        std::string                   Name;
+        Uint8                         BindingIndex   = 0;
+        SHADER_RESOURCE_VARIABLE_TYPE DefaultVarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        std::vector<std::string>      Shaders;
+
+        std::vector<std::pair<std::string, SHADER_RESOURCE_VARIABLE_TYPE>> Variables;
+        std::vector<std::pair<std::string, SamplerDesc>>                   ImmutableSamplers;
+    };
+
+    struct Pipeline
+    {
+        std::string                Name;
+        PIPELINE_TYPE              Type = PIPELINE_TYPE_GRAPHICS;
+        std::vector<std::string>   Shaders;
+        std::vector<std::string>   Signatures;
+        GraphicsPipelineDesc       GraphicsPipeline;
+        std::vector<LayoutElement> LayoutElements;
+    };
+
+    std::vector<Shader>    Shaders;
+    std::vector<Signature> Signatures;
+    std::vector<Pipeline>  Pipelines;
+
+    /// Parses the manifest file. Returns false and logs the error if the file can't be read or parsed.
+    bool Load(const char* FilePath);
+
+    const Shader*    FindShader(const std::string& Name) const;
+    const Signature* FindSignature(const std::string& Name) const;
+
+private:
+    bool ParseLine(const std::vector<std::string>& Tokens);
+
+    Signature* FindSignature(const std::string& Name);
+};
+
+} // namespace Diligent
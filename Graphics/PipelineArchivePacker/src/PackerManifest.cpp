@@ -0,0 +1,567 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PackerManifest.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "GraphicsAccessories.hpp"
+#include "StringTools.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+std::vector<std::string> SplitList(const std::string& List, char Delimiter = ',')
+{
+    std::vector<std::string> Items;
+    std::stringstream        Stream{List};
+    std::string              Item;
+    while (std::getline(Stream, Item, Delimiter))
+    {
+        if (!Item.empty())
+            Items.emplace_back(std::move(Item));
+    }
+    return Items;
+}
+
+// Splits the "key=value" token. Returns false if the token has no '='.
+bool SplitOption(const std::string& Token, std::string& Key, std::string& Value)
+{
+    const auto Pos = Token.find('=');
+    if (Pos == std::string::npos)
+        return false;
+    Key   = Token.substr(0, Pos);
+    Value = Token.substr(Pos + 1);
+    return true;
+}
+
+template <typename ValueType, size_t N>
+bool ParseEnum(const std::string& Str, const std::pair<const char*, ValueType> (&Values)[N], ValueType& Value)
+{
+    for (const auto& Val : Values)
+    {
+        if (StrCmpNoCase(Str.c_str(), Val.first) == 0)
+        {
+            Value = Val.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseShaderType(const std::string& Str, SHADER_TYPE& Type)
+{
+    static const std::pair<const char*, SHADER_TYPE> ShaderTypes[] =
+        {
+            {"vs", SHADER_TYPE_VERTEX},
+            {"ps", SHADER_TYPE_PIXEL},
+            {"gs", SHADER_TYPE_GEOMETRY},
+            {"hs", SHADER_TYPE_HULL},
+            {"ds", SHADER_TYPE_DOMAIN},
+            {"cs", SHADER_TYPE_COMPUTE},
+            {"as", SHADER_TYPE_AMPLIFICATION},
+            {"ms", SHADER_TYPE_MESH},
+        };
+    return ParseEnum(Str, ShaderTypes, Type);
+}
+
+bool ParseVarType(const std::string& Str, SHADER_RESOURCE_VARIABLE_TYPE& VarType)
+{
+    static const std::pair<const char*, SHADER_RESOURCE_VARIABLE_TYPE> VarTypes[] =
+        {
+            {"static", SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {"mutable", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {"dynamic", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        };
+    return ParseEnum(Str, VarTypes, VarType);
+}
+
+bool ParseBool(const std::string& Str, bool& Value)
+{
+    static const std::pair<const char*, bool> Values[] =
+        {
+            {"on", true},
+            {"off", false},
+            {"true", true},
+            {"false", false},
+        };
+    return ParseEnum(Str, Values, Value);
+}
+
+bool ParseComparisonFunc(const std::string& Str, COMPARISON_FUNCTION& Func)
+{
+    static const std::pair<const char*, COMPARISON_FUNCTION> Funcs[] =
+        {
+            {"never", COMPARISON_FUNC_NEVER},
+            {"less", COMPARISON_FUNC_LESS},
+            {"equal", COMPARISON_FUNC_EQUAL},
+            {"less_equal", COMPARISON_FUNC_LESS_EQUAL},
+            {"greater", COMPARISON_FUNC_GREATER},
+            {"not_equal", COMPARISON_FUNC_NOT_EQUAL},
+            {"greater_equal", COMPARISON_FUNC_GREATER_EQUAL},
+            {"always", COMPARISON_FUNC_ALWAYS},
+        };
+    return ParseEnum(Str, Funcs, Func);
+}
+
+// Accepts both full ("TEX_FORMAT_RGBA8_UNORM") and short ("RGBA8_UNORM") format names
+bool ParseTextureFormat(const std::string& Str, TEXTURE_FORMAT& Format)
+{
+    static constexpr char Prefix[] = "TEX_FORMAT_";
+    for (int Fmt = TEX_FORMAT_UNKNOWN + 1; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
+    {
+        const auto* Name = GetTextureFormatAttribs(static_cast<TEXTURE_FORMAT>(Fmt)).Name;
+        if (StrCmpNoCase(Str.c_str(), Name) == 0 || StrCmpNoCase(Str.c_str(), Name + sizeof(Prefix) - 1) == 0)
+        {
+            Format = static_cast<TEXTURE_FORMAT>(Fmt);
+            return true;
+        }
+    }
+    return false;
+}
+
+// <InputIndex>:<BufferSlot>:<NumComponents>:<ValueType>[:norm][:instance]
+bool ParseLayoutElement(const std::string& Str, LayoutElement& Elem)
+{
+    static const std::pair<const char*, VALUE_TYPE> ValueTypes[] =
+        {
+            {"f32", VT_FLOAT32},
+            {"f16", VT_FLOAT16},
+            {"u32", VT_UINT32},
+            {"s32", VT_INT32},
+            {"u16", VT_UINT16},
+            {"s16", VT_INT16},
+            {"u8", VT_UINT8},
+            {"s8", VT_INT8},
+        };
+
+    const auto Parts = SplitList(Str, ':');
+    if (Parts.size() < 4)
+        return false;
+
+    Elem.InputIndex    = static_cast<Uint32>(std::atoi(Parts[0].c_str()));
+    Elem.BufferSlot    = static_cast<Uint32>(std::atoi(Parts[1].c_str()));
+    Elem.NumComponents = static_cast<Uint32>(std::atoi(Parts[2].c_str()));
+    if (!ParseEnum(Parts[3], ValueTypes, Elem.ValueType))
+        return false;
+
+    Elem.IsNormalized = False;
+    for (size_t i = 4; i < Parts.size(); ++i)
+    {
+        if (Parts[i] == "norm")
+            Elem.IsNormalized = True;
+        else if (Parts[i] == "instance")
+            Elem.Frequency = INPUT_ELEMENT_FREQUENCY_PER_INSTANCE;
+        else
+            return false;
+    }
+    return Elem.NumComponents >= 1 && Elem.NumComponents <= 4;
+}
+
+bool ParseSamplerOption(const std::string& Key, const std::string& Value, SamplerDesc& Desc)
+{
+    if (Key == "filter")
+    {
+        static const std::pair<const char*, FILTER_TYPE> Filters[] =
+            {
+                {"point", FILTER_TYPE_POINT},
+                {"linear", FILTER_TYPE_LINEAR},
+                {"anisotropic", FILTER_TYPE_ANISOTROPIC},
+                {"comparison_linear", FILTER_TYPE_COMPARISON_LINEAR},
+            };
+        FILTER_TYPE Filter = FILTER_TYPE_UNKNOWN;
+        if (!ParseEnum(Value, Filters, Filter))
+            return false;
+        Desc.MinFilter = Desc.MagFilter = Desc.MipFilter = Filter;
+        if (Filter == FILTER_TYPE_COMPARISON_LINEAR)
+            Desc.ComparisonFunc = COMPARISON_FUNC_LESS;
+    }
+    else if (Key == "address")
+    {
+        static const std::pair<const char*, TEXTURE_ADDRESS_MODE> Modes[] =
+            {
+                {"wrap", TEXTURE_ADDRESS_WRAP},
+                {"mirror", TEXTURE_ADDRESS_MIRROR},
+                {"clamp", TEXTURE_ADDRESS_CLAMP},
+                {"border", TEXTURE_ADDRESS_BORDER},
+            };
+        TEXTURE_ADDRESS_MODE Mode = TEXTURE_ADDRESS_UNKNOWN;
+        if (!ParseEnum(Value, Modes, Mode))
+            return false;
+        Desc.AddressU = Desc.AddressV = Desc.AddressW = Mode;
+    }
+    else if (Key == "anisotropy")
+    {
+        Desc.MaxAnisotropy = static_cast<Uint32>(std::atoi(Value.c_str()));
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool ParseGraphicsOption(const std::string& Key, const std::string& Value, PackerManifest::Pipeline& Pipeline)
+{
+    auto& GraphicsPipeline = Pipeline.GraphicsPipeline;
+    if (Key == "rtv")
+    {
+        const auto Formats = SplitList(Value);
+        if (Formats.size() > _countof(GraphicsPipeline.RTVFormats))
+            return false;
+        GraphicsPipeline.NumRenderTargets = static_cast<Uint8>(Formats.size());
+        for (size_t i = 0; i < Formats.size(); ++i)
+        {
+            if (!ParseTextureFormat(Formats[i], GraphicsPipeline.RTVFormats[i]))
+                return false;
+        }
+    }
+    else if (Key == "dsv")
+    {
+        return ParseTextureFormat(Value, GraphicsPipeline.DSVFormat);
+    }
+    else if (Key == "topology")
+    {
+        static const std::pair<const char*, PRIMITIVE_TOPOLOGY> Topologies[] =
+            {
+                {"triangle_list", PRIMITIVE_TOPOLOGY_TRIANGLE_LIST},
+                {"triangle_strip", PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP},
+                {"line_list", PRIMITIVE_TOPOLOGY_LINE_LIST},
+                {"line_strip", PRIMITIVE_TOPOLOGY_LINE_STRIP},
+                {"point_list", PRIMITIVE_TOPOLOGY_POINT_LIST},
+            };
+        return ParseEnum(Value, Topologies, GraphicsPipeline.PrimitiveTopology);
+    }
+    else if (Key == "cull")
+    {
+        static const std::pair<const char*, CULL_MODE> CullModes[] =
+            {
+                {"none", CULL_MODE_NONE},
+                {"front", CULL_MODE_FRONT},
+                {"back", CULL_MODE_BACK},
+            };
+        return ParseEnum(Value, CullModes, GraphicsPipeline.RasterizerDesc.CullMode);
+    }
+    else if (Key == "fill")
+    {
+        static const std::pair<const char*, FILL_MODE> FillModes[] =
+            {
+                {"solid", FILL_MODE_SOLID},
+                {"wireframe", FILL_MODE_WIREFRAME},
+            };
+        return ParseEnum(Value, FillModes, GraphicsPipeline.RasterizerDesc.FillMode);
+    }
+    else if (Key == "depth" || Key == "depth_write")
+    {
+        bool Enable = false;
+        if (!ParseBool(Value, Enable))
+            return false;
+        (Key == "depth" ? GraphicsPipeline.DepthStencilDesc.DepthEnable : GraphicsPipeline.DepthStencilDesc.DepthWriteEnable) = Enable ? True : False;
+    }
+    else if (Key == "depth_func")
+    {
+        return ParseComparisonFunc(Value, GraphicsPipeline.DepthStencilDesc.DepthFunc);
+    }
+    else if (Key == "blend")
+    {
+        auto& RT0 = GraphicsPipeline.BlendDesc.RenderTargets[0];
+        if (Value == "off")
+        {
+            RT0.BlendEnable = False;
+        }
+        else if (Value == "alpha")
+        {
+            RT0.BlendEnable    = True;
+            RT0.SrcBlend       = BLEND_FACTOR_SRC_ALPHA;
+            RT0.DestBlend      = BLEND_FACTOR_INV_SRC_ALPHA;
+            RT0.SrcBlendAlpha  = BLEND_FACTOR_ONE;
+            RT0.DestBlendAlpha = BLEND_FACTOR_INV_SRC_ALPHA;
+        }
+        else if (Value == "additive")
+        {
+            RT0.BlendEnable    = True;
+            RT0.SrcBlend       = BLEND_FACTOR_ONE;
+            RT0.DestBlend      = BLEND_FACTOR_ONE;
+            RT0.SrcBlendAlpha  = BLEND_FACTOR_ONE;
+            RT0.DestBlendAlpha = BLEND_FACTOR_ONE;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else if (Key == "samples")
+    {
+        GraphicsPipeline.SmplDesc.Count = static_cast<Uint8>(std::atoi(Value.c_str()));
+        return GraphicsPipeline.SmplDesc.Count > 0;
+    }
+    else if (Key == "attrib")
+    {
+        LayoutElement Elem;
+        if (!ParseLayoutElement(Value, Elem))
+            return false;
+        Pipeline.LayoutElements.push_back(Elem);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+
+bool PackerManifest::Load(const char* FilePath)
+{
+    std::ifstream File{FilePath};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to open manifest file '", FilePath, "'");
+        return false;
+    }
+
+    std::string Line;
+    for (int LineNum = 1; std::getline(File, Line); ++LineNum)
+    {
+        const auto CommentPos = Line.find('#');
+        if (CommentPos != std::string::npos)
+            Line.erase(CommentPos);
+
+        std::vector<std::string> Tokens;
+        std::istringstream       LineStream{Line};
+        for (std::string Token; LineStream >> Token;)
+            Tokens.emplace_back(std::move(Token));
+
+        if (Tokens.empty())
+            continue;
+
+        if (!ParseLine(Tokens))
+        {
+            LOG_ERROR_MESSAGE(FilePath, '(', LineNum, "): failed to parse '", Tokens[0], "' directive");
+            return false;
+        }
+    }
+
+    for (auto& Pipeline : Pipelines)
+    {
+        auto& InputLayout          = Pipeline.GraphicsPipeline.InputLayout;
+        InputLayout.LayoutElements = Pipeline.LayoutElements.data();
+        InputLayout.NumElements    = static_cast<Uint32>(Pipeline.LayoutElements.size());
+    }
+
+    return true;
+}
+
+bool PackerManifest::ParseLine(const std::vector<std::string>& Tokens)
+{
+    const auto& Directive = Tokens[0];
+    std::string Key, Value;
+
+    if (Directive == "shader")
+    {
+        // shader <Name> <Type> <FilePath> [options]
+        if (Tokens.size() < 4)
+            return false;
+
+        Shader Sh;
+        Sh.Name     = Tokens[1];
+        Sh.FilePath = Tokens[3];
+        if (!ParseShaderType(Tokens[2], Sh.Type) || FindShader(Sh.Name) != nullptr)
+            return false;
+
+        for (size_t i = 4; i < Tokens.size(); ++i)
+        {
+            if (!SplitOption(Tokens[i], Key, Value))
+                return false;
+
+            if (Key == "entry")
+            {
+                Sh.EntryPoint = Value;
+            }
+            else if (Key == "lang")
+            {
+                static const std::pair<const char*, SHADER_SOURCE_LANGUAGE> Languages[] =
+                    {
+                        {"hlsl", SHADER_SOURCE_LANGUAGE_HLSL},
+                        {"glsl", SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM},
+                    };
+                if (!ParseEnum(Value, Languages, Sh.SourceLanguage))
+                    return false;
+            }
+            else if (Key == "define")
+            {
+                std::string MacroName, MacroDef;
+                if (!SplitOption(Value, MacroName, MacroDef))
+                {
+                    MacroName = Value;
+                    MacroDef  = "1";
+                }
+                Sh.Macros.emplace_back(std::move(MacroName), std::move(MacroDef));
+            }
+            else if (Key == "combined_samplers")
+            {
+                Sh.UseCombinedTextureSamplers = true;
+                Sh.CombinedSamplerSuffix      = Value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        Shaders.emplace_back(std::move(Sh));
+    }
+    else if (Directive == "signature")
+    {
+        // signature <Name> <BindingIndex> shaders=<Shader>,... [vars=<VarType>]
+        if (Tokens.size() < 4 || FindSignature(Tokens[1]) != nullptr)
+            return false;
+
+        Signature Sign;
+        Sign.Name         = Tokens[1];
+        Sign.BindingIndex = static_cast<Uint8>(std::atoi(Tokens[2].c_str()));
+        for (size_t i = 3; i < Tokens.size(); ++i)
+        {
+            if (!SplitOption(Tokens[i], Key, Value))
+                return false;
+
+            if (Key == "shaders")
+                Sign.Shaders = SplitList(Value);
+            else if (Key != "vars" || !ParseVarType(Value, Sign.DefaultVarType))
+                return false;
+        }
+        if (Sign.Shaders.empty())
+            return false;
+        Signatures.emplace_back(std::move(Sign));
+    }
+    else if (Directive == "variable")
+    {
+        // variable <Signature> <ResourceName> <VarType>
+        auto* pSign = Tokens.size() == 4 ? FindSignature(Tokens[1]) : nullptr;
+        if (pSign == nullptr)
+            return false;
+
+        SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        if (!ParseVarType(Tokens[3], VarType))
+            return false;
+        pSign->Variables.emplace_back(Tokens[2], VarType);
+    }
+    else if (Directive == "sampler")
+    {
+        // sampler <Signature> <SamplerOrTextureName> [options]
+        auto* pSign = Tokens.size() >= 3 ? FindSignature(Tokens[1]) : nullptr;
+        if (pSign == nullptr)
+            return false;
+
+        SamplerDesc Desc;
+        for (size_t i = 3; i < Tokens.size(); ++i)
+        {
+            if (!SplitOption(Tokens[i], Key, Value) || !ParseSamplerOption(Key, Value, Desc))
+                return false;
+        }
+        pSign->ImmutableSamplers.emplace_back(Tokens[2], Desc);
+    }
+    else if (Directive == "graphics" || Directive == "compute")
+    {
+        // graphics <Name> shaders=<Shader>,... [signatures=<Signature>,...] [states]
+        // compute <Name> shader=<Shader> [signatures=<Signature>,...]
+        if (Tokens.size() < 3)
+            return false;
+
+        Pipeline Pipe;
+        Pipe.Name = Tokens[1];
+        Pipe.Type = Directive == "compute" ? PIPELINE_TYPE_COMPUTE : PIPELINE_TYPE_GRAPHICS;
+        for (size_t i = 2; i < Tokens.size(); ++i)
+        {
+            if (!SplitOption(Tokens[i], Key, Value))
+                return false;
+
+            if (Key == "shaders" || Key == "shader")
+                Pipe.Shaders = SplitList(Value);
+            else if (Key == "signatures")
+                Pipe.Signatures = SplitList(Value);
+            else if (Pipe.Type == PIPELINE_TYPE_COMPUTE || !ParseGraphicsOption(Key, Value, Pipe))
+                return false;
+        }
+
+        if (Pipe.Shaders.empty())
+            return false;
+        for (const auto& ShaderName : Pipe.Shaders)
+        {
+            const auto* pShader = FindShader(ShaderName);
+            if (pShader == nullptr)
+                return false;
+            if (pShader->Type == SHADER_TYPE_MESH)
+                Pipe.Type = PIPELINE_TYPE_MESH;
+        }
+        for (const auto& SignName : Pipe.Signatures)
+        {
+            if (FindSignature(SignName) == nullptr)
+                return false;
+        }
+        Pipelines.emplace_back(std::move(Pipe));
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+const PackerManifest::Shader* PackerManifest::FindShader(const std::string& Name) const
+{
+    for (const auto& Sh : Shaders)
+    {
+        if (Sh.Name == Name)
+            return &Sh;
+    }
+    return nullptr;
+}
+
+const PackerManifest::Signature* PackerManifest::FindSignature(const std::string& Name) const
+{
+    for (const auto& Sign : Signatures)
+    {
+        if (Sign.Name == Name)
+            return &Sign;
+    }
+    return nullptr;
+}
+
+PackerManifest::Signature* PackerManifest::FindSignature(const std::string& Name)
+{
+    return const_cast<Signature*>(static_cast<const PackerManifest*>(this)->FindSignature(Name));
+}
+
+} // namespace Diligent
@@ -0,0 +1,508 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// Offline pipeline archive packer.
+//
+// Compiles the shaders listed in the manifest for the requested backends, reflects their
+// resources, builds the pipeline resource signatures and writes everything into the archive
+// that can be loaded at run time with IRenderDevice::CreatePipelineStateFromArchive().
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PackerManifest.hpp"
+#include "PipelineArchive.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "GLSLangUtils.hpp"
+#include "SPIRVShaderResources.hpp"
+#include "DXCompiler.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FileWrapper.hpp"
+#include "StringTools.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct PackerOptions
+{
+    std::string ManifestPath;
+    std::string OutputPath;
+    std::string SearchDirectories;
+    std::string DXCompilerPath;
+
+    std::vector<RENDER_DEVICE_TYPE> DeviceTypes;
+    SHADER_OPTIMIZATION_LEVEL       OptimizationLevel = SHADER_OPTIMIZATION_LEVEL_DEFAULT;
+};
+
+void PrintUsage()
+{
+    std::cout << "Usage: PipelineArchivePacker -m <manifest> -o <archive> [options]\n"
+                 "Options:\n"
+                 "  -t <backends>  Comma-separated list of target backends: vulkan, d3d12 (default: vulkan)\n"
+                 "  -I <dir>       Add shader include search directory\n"
+                 "  -O <level>     Shader optimization level: none, legalize, performance, size\n"
+                 "  --dxc <path>   Path to the DirectX Shader Compiler library\n";
+}
+
+bool ParseCommandLine(int argc, char** argv, PackerOptions& Options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg = argv[i];
+        if (Arg == "-h" || Arg == "--help" || i + 1 >= argc)
+            return false;
+
+        const char* Value = argv[++i];
+        if (Arg == "-m")
+        {
+            Options.ManifestPath = Value;
+        }
+        else if (Arg == "-o")
+        {
+            Options.OutputPath = Value;
+        }
+        else if (Arg == "-I")
+        {
+            if (!Options.SearchDirectories.empty())
+                Options.SearchDirectories += ';';
+            Options.SearchDirectories += Value;
+        }
+        else if (Arg == "--dxc")
+        {
+            Options.DXCompilerPath = Value;
+        }
+        else if (Arg == "-t")
+        {
+            std::string Backends = Value;
+            for (size_t Start = 0; Start < Backends.length();)
+            {
+                auto End = Backends.find(',', Start);
+                if (End == std::string::npos)
+                    End = Backends.length();
+
+                const auto Backend = Backends.substr(Start, End - Start);
+                if (StrCmpNoCase(Backend.c_str(), "vulkan") == 0)
+                    Options.DeviceTypes.push_back(RENDER_DEVICE_TYPE_VULKAN);
+                else if (StrCmpNoCase(Backend.c_str(), "d3d12") == 0)
+                    Options.DeviceTypes.push_back(RENDER_DEVICE_TYPE_D3D12);
+                else
+                {
+                    std::cerr << "Unsupported backend '" << Backend << "'\n";
+                    return false;
+                }
+                Start = End + 1;
+            }
+        }
+        else if (Arg == "-O")
+        {
+            if (strcmp(Value, "none") == 0)
+                Options.OptimizationLevel = SHADER_OPTIMIZATION_LEVEL_NONE;
+            else if (strcmp(Value, "legalize") == 0)
+                Options.OptimizationLevel = SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY;
+            else if (strcmp(Value, "performance") == 0)
+                Options.OptimizationLevel = SHADER_OPTIMIZATION_LEVEL_PERFORMANCE;
+            else if (strcmp(Value, "size") == 0)
+                Options.OptimizationLevel = SHADER_OPTIMIZATION_LEVEL_SIZE;
+            else
+            {
+                std::cerr << "Unknown optimization level '" << Value << "'\n";
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown option '" << Arg << "'\n";
+            return false;
+        }
+    }
+
+    if (Options.DeviceTypes.empty())
+        Options.DeviceTypes.push_back(RENDER_DEVICE_TYPE_VULKAN);
+
+    return !Options.ManifestPath.empty() && !Options.OutputPath.empty();
+}
+
+
+struct CompiledShader
+{
+    const PackerManifest::Shader* pShader = nullptr;
+
+    // Byte code for every requested device type
+    std::unordered_map<int, std::vector<Uint32>> ByteCode;
+
+    // Resources are always reflected from SPIR-V: the names and types are the same for all
+    // backends, and SPIR-V reflection does not require platform-specific libraries.
+    std::unique_ptr<SPIRVShaderResources>       pSPIRVResources;
+    std::vector<PipelineArchiveShaderResource> Resources;
+};
+
+class Packer
+{
+public:
+    explicit Packer(const PackerOptions& Options) :
+        m_Options{Options}
+    {
+        CreateDefaultShaderSourceStreamFactory(m_Options.SearchDirectories.c_str(), &m_pStreamFactory);
+        for (auto DeviceType : m_Options.DeviceTypes)
+        {
+            if (DeviceType == RENDER_DEVICE_TYPE_D3D12)
+            {
+                m_pDXC = CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, !m_Options.DXCompilerPath.empty() ? m_Options.DXCompilerPath.c_str() : nullptr);
+                if (!m_pDXC || !m_pDXC->IsLoaded())
+                    LOG_ERROR_AND_THROW("Failed to load DirectX Shader Compiler required to compile shaders for Direct3D12");
+            }
+        }
+        GLSLangUtils::InitializeGlslang();
+    }
+
+    ~Packer()
+    {
+        GLSLangUtils::FinalizeGlslang();
+    }
+
+    // clang-format off
+    Packer           (const Packer&)  = delete;
+    Packer           (      Packer&&) = delete;
+    Packer& operator=(const Packer&)  = delete;
+    Packer& operator=(      Packer&&) = delete;
+    // clang-format on
+
+    void Run(const PackerManifest& Manifest) noexcept(false)
+    {
+        for (const auto& Shader : Manifest.Shaders)
+            CompileShader(Shader);
+
+        for (const auto& Sign : Manifest.Signatures)
+            AddSignature(Sign);
+
+        for (const auto& Pipeline : Manifest.Pipelines)
+            AddPipeline(Pipeline);
+
+        std::vector<Uint8> Data;
+        m_Writer.Serialize(Data);
+
+        FileWrapper File{m_Options.OutputPath.c_str(), EFileAccessMode::Overwrite};
+        if (!File || !File->Write(Data.data(), Data.size()))
+            LOG_ERROR_AND_THROW("Failed to write the archive to '", m_Options.OutputPath, "'");
+
+        std::cout << "Packed " << Manifest.Shaders.size() << " shader(s), " << Manifest.Signatures.size()
+                  << " signature(s) and " << Manifest.Pipelines.size() << " pipeline(s) into '"
+                  << m_Options.OutputPath << "' (" << Data.size() << " bytes)\n";
+    }
+
+private:
+    void InitShaderCreateInfo(const PackerManifest::Shader& Shader, std::vector<ShaderMacro>& Macros, ShaderCreateInfo& ShaderCI)
+    {
+        for (const auto& Macro : Shader.Macros)
+            Macros.emplace_back(Macro.first.c_str(), Macro.second.c_str());
+        Macros.emplace_back(nullptr, nullptr);
+
+        ShaderCI.Desc.Name                  = Shader.Name.c_str();
+        ShaderCI.Desc.ShaderType            = Shader.Type;
+        ShaderCI.FilePath                   = Shader.FilePath.c_str();
+        ShaderCI.EntryPoint                 = Shader.EntryPoint.c_str();
+        ShaderCI.SourceLanguage             = Shader.SourceLanguage;
+        ShaderCI.Macros                     = Macros.data();
+        ShaderCI.pShaderSourceStreamFactory = m_pStreamFactory;
+        ShaderCI.UseCombinedTextureSamplers = Shader.UseCombinedTextureSamplers;
+        ShaderCI.CombinedSamplerSuffix      = Shader.CombinedSamplerSuffix.c_str();
+        ShaderCI.OptimizationLevel          = m_Options.OptimizationLevel;
+    }
+
+    std::vector<Uint32> CompileSPIRV(const PackerManifest::Shader& Shader, IDataBlob** ppCompilerOutput) noexcept(false)
+    {
+        static constexpr char VulkanDefine[] =
+            "#ifndef VULKAN\n"
+            "#   define VULKAN 1\n"
+            "#endif\n";
+
+        std::vector<ShaderMacro> Macros;
+        ShaderCreateInfo         ShaderCI;
+        InitShaderCreateInfo(Shader, Macros, ShaderCI);
+
+        if (Shader.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+            return GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ppCompilerOutput);
+
+        RefCntAutoPtr<IDataBlob> pSourceFileData;
+        size_t                   SourceLength = 0;
+        const auto*              ShaderSource = ReadShaderSourceFile(nullptr, m_pStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+
+        GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
+        Attribs.ShaderType                 = Shader.Type;
+        Attribs.ShaderSource               = ShaderSource;
+        Attribs.SourceCodeLen              = static_cast<int>(SourceLength);
+        Attribs.Macros                     = ShaderCI.Macros;
+        Attribs.pShaderSourceStreamFactory = m_pStreamFactory;
+        Attribs.ppCompilerOutput           = ppCompilerOutput;
+        Attribs.OptimizationLevel          = m_Options.OptimizationLevel;
+        return GLSLangUtils::GLSLtoSPIRV(Attribs);
+    }
+
+    std::vector<Uint32> CompileDXIL(const PackerManifest::Shader& Shader, IDataBlob** ppCompilerOutput) noexcept(false)
+    {
+        if (Shader.SourceLanguage != SHADER_SOURCE_LANGUAGE_HLSL)
+            LOG_ERROR_AND_THROW("Shader '", Shader.Name, "' can't be compiled for Direct3D12: only HLSL shaders are supported");
+
+        std::vector<ShaderMacro> Macros;
+        ShaderCreateInfo         ShaderCI;
+        InitShaderCreateInfo(Shader, Macros, ShaderCI);
+
+        std::vector<Uint32> ByteCode;
+        m_pDXC->Compile(ShaderCI, ShaderVersion{6, 0}, nullptr, nullptr, &ByteCode, ppCompilerOutput);
+        return ByteCode;
+    }
+
+    void CompileShader(const PackerManifest::Shader& Shader) noexcept(false)
+    {
+        auto& Compiled   = m_Shaders[Shader.Name];
+        Compiled.pShader = &Shader;
+
+        RefCntAutoPtr<IDataBlob> pCompilerOutput;
+
+        auto SPIRV = CompileSPIRV(Shader, &pCompilerOutput);
+        if (SPIRV.empty())
+        {
+            LOG_ERROR_AND_THROW("Failed to compile shader '", Shader.Name, "' to SPIR-V",
+                                (pCompilerOutput ? ":\n" : ""),
+                                (pCompilerOutput ? static_cast<const char*>(pCompilerOutput->GetConstDataPtr()) : ""));
+        }
+
+        ShaderDesc Desc;
+        Desc.Name       = Shader.Name.c_str();
+        Desc.ShaderType = Shader.Type;
+
+        std::string EntryPoint = Shader.EntryPoint;
+        Compiled.pSPIRVResources.reset(new SPIRVShaderResources{
+            DefaultRawMemoryAllocator::GetAllocator(),
+            SPIRV,
+            Desc,
+            Shader.UseCombinedTextureSamplers ? Shader.CombinedSamplerSuffix.c_str() : nullptr,
+            false, // LoadShaderStageInputs
+            EntryPoint //
+        });
+
+        const auto& Resources = *Compiled.pSPIRVResources;
+        Compiled.Resources.reserve(Resources.GetTotalResources());
+        for (Uint32 n = 0; n < Resources.GetTotalResources(); ++n)
+        {
+            const auto& Attribs = Resources.GetResource(n);
+
+            PipelineArchiveShaderResource Res;
+            Res.Name      = Attribs.Name;
+            Res.Type      = SPIRVShaderResourceAttribs::GetShaderResourceType(Attribs.Type);
+            Res.ArraySize = Attribs.ArraySize;
+            Res.Flags     = SPIRVShaderResourceAttribs::GetPipelineResourceFlags(Attribs.Type);
+            if (Res.ArraySize == 0)
+            {
+                Res.ArraySize = 1;
+                Res.Flags |= PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY;
+            }
+            Compiled.Resources.push_back(Res);
+        }
+
+        for (auto DeviceType : m_Options.DeviceTypes)
+        {
+            auto& ByteCode = Compiled.ByteCode[DeviceType];
+            if (DeviceType == RENDER_DEVICE_TYPE_VULKAN)
+            {
+                ByteCode = std::move(SPIRV);
+            }
+            else
+            {
+                pCompilerOutput.Release();
+                ByteCode = CompileDXIL(Shader, &pCompilerOutput);
+                if (ByteCode.empty())
+                    LOG_ERROR_AND_THROW("Failed to compile shader '", Shader.Name, "' to DXIL");
+            }
+
+            PipelineArchiveShaderDesc ArchiveDesc;
+            ArchiveDesc.Name                       = Shader.Name.c_str();
+            ArchiveDesc.DeviceType                 = DeviceType;
+            ArchiveDesc.ShaderType                 = Shader.Type;
+            ArchiveDesc.EntryPoint                 = Shader.EntryPoint.c_str();
+            ArchiveDesc.UseCombinedTextureSamplers = Shader.UseCombinedTextureSamplers;
+            ArchiveDesc.CombinedSamplerSuffix      = Shader.CombinedSamplerSuffix.c_str();
+            ArchiveDesc.ByteCode                   = ByteCode.data();
+            ArchiveDesc.ByteCodeSize               = ByteCode.size() * sizeof(ByteCode[0]);
+            ArchiveDesc.Resources                  = Compiled.Resources.data();
+            ArchiveDesc.NumResources               = static_cast<Uint32>(Compiled.Resources.size());
+            m_Writer.AddShader(ArchiveDesc);
+        }
+    }
+
+    void AddSignature(const PackerManifest::Signature& Sign) noexcept(false)
+    {
+        std::vector<PipelineResourceDesc> Resources;
+        std::vector<ImmutableSamplerDesc> ImmutableSamplers;
+
+        PipelineResourceSignatureDesc Desc;
+        Desc.Name         = Sign.Name.c_str();
+        Desc.BindingIndex = Sign.BindingIndex;
+
+        for (const auto& ShaderName : Sign.Shaders)
+        {
+            auto it = m_Shaders.find(ShaderName);
+            if (it == m_Shaders.end())
+                LOG_ERROR_AND_THROW("Signature '", Sign.Name, "' references unknown shader '", ShaderName, "'");
+
+            const auto& Shader = *it->second.pShader;
+            if (Shader.UseCombinedTextureSamplers)
+            {
+                Desc.UseCombinedTextureSamplers = true;
+                Desc.CombinedSamplerSuffix      = Shader.CombinedSamplerSuffix.c_str();
+            }
+
+            for (const auto& Res : it->second.Resources)
+            {
+                if (Res.Type == SHADER_RESOURCE_TYPE_SAMPLER && IsImmutableSampler(Sign, Res.Name, Desc.CombinedSamplerSuffix, Desc.UseCombinedTextureSamplers))
+                    continue;
+
+                auto ResIt = std::find_if(Resources.begin(), Resources.end(),
+                                          [&](const PipelineResourceDesc& Other) { return strcmp(Other.Name, Res.Name) == 0; });
+                if (ResIt == Resources.end())
+                {
+                    Resources.emplace_back(Shader.Type, Res.Name, Res.ArraySize, Res.Type, GetVariableType(Sign, Res.Name), Res.Flags);
+                }
+                else
+                {
+                    if (ResIt->ResourceType != Res.Type)
+                    {
+                        LOG_ERROR_AND_THROW("Resource '", Res.Name, "' in signature '", Sign.Name,
+                                            "' has different types in different shader stages");
+                    }
+                    ResIt->ShaderStages |= Shader.Type;
+                    ResIt->ArraySize = std::max(ResIt->ArraySize, Res.ArraySize);
+                    ResIt->Flags |= Res.Flags;
+                }
+            }
+
+            for (const auto& Sam : Sign.ImmutableSamplers)
+            {
+                auto SamIt = std::find_if(ImmutableSamplers.begin(), ImmutableSamplers.end(),
+                                          [&](const ImmutableSamplerDesc& Other) { return Sam.first == Other.SamplerOrTextureName; });
+                if (SamIt == ImmutableSamplers.end())
+                    ImmutableSamplers.emplace_back(Shader.Type, Sam.first.c_str(), Sam.second);
+                else
+                    SamIt->ShaderStages |= Shader.Type;
+            }
+        }
+
+        Desc.Resources            = Resources.data();
+        Desc.NumResources         = static_cast<Uint32>(Resources.size());
+        Desc.ImmutableSamplers    = ImmutableSamplers.data();
+        Desc.NumImmutableSamplers = static_cast<Uint32>(ImmutableSamplers.size());
+        m_Writer.AddResourceSignature(Desc);
+    }
+
+    void AddPipeline(const PackerManifest::Pipeline& Pipeline) noexcept(false)
+    {
+        std::vector<const char*> ShaderNames;
+        for (const auto& Name : Pipeline.Shaders)
+            ShaderNames.push_back(Name.c_str());
+
+        std::vector<const char*> SignatureNames;
+        for (const auto& Name : Pipeline.Signatures)
+            SignatureNames.push_back(Name.c_str());
+
+        PipelineArchivePipelineDesc Desc;
+        Desc.Name             = Pipeline.Name.c_str();
+        Desc.PipelineType     = Pipeline.Type;
+        Desc.GraphicsPipeline = Pipeline.GraphicsPipeline;
+        Desc.ShaderNames      = ShaderNames.data();
+        Desc.NumShaders       = static_cast<Uint32>(ShaderNames.size());
+        Desc.SignatureNames   = SignatureNames.data();
+        Desc.NumSignatures    = static_cast<Uint32>(SignatureNames.size());
+        if (!m_Writer.AddPipeline(Desc))
+            LOG_ERROR_AND_THROW("Pipeline '", Pipeline.Name, "' is defined more than once");
+    }
+
+    static bool IsImmutableSampler(const PackerManifest::Signature& Sign, const char* SamplerName, const char* Suffix, bool UseCombinedSamplers)
+    {
+        for (const auto& Sam : Sign.ImmutableSamplers)
+        {
+            if (Sam.first == SamplerName)
+                return true;
+            if (UseCombinedSamplers && Sam.first + Suffix == SamplerName)
+                return true;
+        }
+        return false;
+    }
+
+    static SHADER_RESOURCE_VARIABLE_TYPE GetVariableType(const PackerManifest::Signature& Sign, const char* ResourceName)
+    {
+        for (const auto& Var : Sign.Variables)
+        {
+            if (Var.first == ResourceName)
+                return Var.second;
+        }
+        return Sign.DefaultVarType;
+    }
+
+    const PackerOptions&                            m_Options;
+    RefCntAutoPtr<IShaderSourceInputStreamFactory>  m_pStreamFactory;
+    std::unique_ptr<IDXCompiler>                    m_pDXC;
+    std::unordered_map<std::string, CompiledShader> m_Shaders;
+    PipelineArchiveWriter                           m_Writer;
+};
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    PackerOptions Options;
+    if (!ParseCommandLine(argc, argv, Options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    PackerManifest Manifest;
+    if (!Manifest.Load(Options.ManifestPath.c_str()))
+        return 1;
+
+    try
+    {
+        Packer ArchivePacker{Options};
+        ArchivePacker.Run(Manifest);
+    }
+    catch (...)
+    {
+        std::cerr << "Failed to create pipeline archive '" << Options.OutputPath << "'\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -58,10 +58,14 @@ struct GLSLtoSPIRVAttribs
     SpirvVersion                     Version                    = SpirvVersion::Vk100;
     IDataBlob**                      ppCompilerOutput           = nullptr;
     bool                             AssignBindings             = true;
+    SHADER_OPTIMIZATION_LEVEL        OptimizationLevel          = SHADER_OPTIMIZATION_LEVEL_DEFAULT;
+    ShaderCompileStatistics*         pCompileStats              = nullptr;
 };
 
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs);
 
+/// Compiles HLSL source to SPIR-V using ShaderCI.OptimizationLevel and
+/// writes the compile-time breakdown to ShaderCI.pCompileStats, if it is not null.
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
                                       IDataBlob**             ppCompilerOutput);
@@ -105,6 +105,17 @@ struct SPIRVShaderResourceAttribs
                                Uint32                                _BufferStaticSize = 0,
                                Uint32                                _BufferStride     = 0) noexcept;
 
+    // Initializes the attributes from the values previously reflected by SPIRV-Cross
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept;
+
     ShaderResourceDesc GetResourceDesc() const
     {
         return ShaderResourceDesc{Name, GetShaderResourceType(Type), ArraySize};
@@ -148,6 +159,32 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    /// Loads the resources from the data written by Serialize() without running SPIRV-Cross.
+
+    /// \param [in]  Allocator             - Allocator for the resource memory.
+    /// \param [in]  pData                 - Serialized reflection data.
+    /// \param [in]  DataSize              - Size of the data, in bytes.
+    /// \param [in]  spirv_binary          - SPIRV byte code the data was reflected from. It is only used to
+    ///                                      validate the decoration offsets.
+    /// \param [in]  shaderDesc            - Shader description.
+    /// \param [in]  CombinedSamplerSuffix - Combined sampler suffix, or null if combined samplers are not used.
+    /// \param [out] EntryPoint            - Entry point name.
+    ///
+    /// \remarks Throws an exception if the data is not valid, so that the caller can fall back to reflection.
+    SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                         const void*                  pData,
+                         size_t                       DataSize,
+                         const std::vector<uint32_t>& spirv_binary,
+                         const ShaderDesc&            shaderDesc,
+                         const char*                  CombinedSamplerSuffix,
+                         std::string&                 EntryPoint) noexcept(false);
+
+    /// Writes the reflection data to Data so that it can be stored next to the byte code.
+    void Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const;
+
+    /// Serialization format version. Change it whenever the format changes.
+    static constexpr Uint32 SerializationVersion = 1;
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
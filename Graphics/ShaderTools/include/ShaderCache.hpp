@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Compiled shader byte code cache
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <initializer_list>
+
+#include "Shader.h"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Thread-safe cache of compiled shader byte code.
+
+/// The cache keeps the byte code in memory and, if the directory is given,
+/// also stores it on disk so that it can be reused by subsequent runs.
+class ShaderCache
+{
+public:
+    /// Shader cache key.
+
+    /// The key keeps all data that affects the byte code, not only its hash. Keys are equal only
+    /// if their data is identical, so a hash collision results in a cache miss rather than in wrong byte code.
+    class Key
+    {
+    public:
+        /// Appends a block of raw data to the key.
+        void AppendData(const void* pData, size_t Size);
+
+        /// Appends a null-terminated string to the key. A null string is different from an empty one.
+        void AppendString(const char* Str);
+
+        /// Appends the values to the key.
+        template <typename... ArgsType>
+        void AppendValues(const ArgsType&... Args)
+        {
+            // Expand the pack in an initializer list to process the arguments in order
+            const int Dummy[] = {(AppendData(&Args, sizeof(Args)), 0)...};
+            (void)Dummy;
+        }
+
+        /// Returns the 64-bit hash of the key data.
+        Uint64 GetHash() const { return m_Hash; }
+
+        /// Returns the key data.
+        const std::string& GetData() const { return m_Data; }
+
+        bool operator==(const Key& Other) const
+        {
+            return m_Hash == Other.m_Hash && m_Data == Other.m_Data;
+        }
+        bool operator!=(const Key& Other) const
+        {
+            return !(*this == Other);
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const
+            {
+                return static_cast<size_t>(K.m_Hash);
+            }
+        };
+
+    private:
+        std::string m_Data;
+        Uint64      m_Hash = 0;
+    };
+
+    /// Creates the shader cache.
+
+    /// \param [in] Directory - Optional path to the directory where the byte code is persisted.
+    ///                         If the directory does not exist, it is created.
+    ///                         If null, the cache is memory-only.
+    explicit ShaderCache(const char* Directory = nullptr);
+
+    // clang-format off
+    ShaderCache           (const ShaderCache&)  = delete;
+    ShaderCache           (      ShaderCache&&) = delete;
+    ShaderCache& operator=(const ShaderCache&)  = delete;
+    ShaderCache& operator=(      ShaderCache&&) = delete;
+    // clang-format on
+
+    /// Computes the cache key of the shader.
+
+    /// \param [in] ShaderCI      - Shader create info.
+    /// \param [in] Source        - Full source string that is passed to the compiler, e.g. the
+    ///                             string returned by BuildHLSLSourceString() or BuildGLSLSourceString().
+    /// \param [in] SourceLength  - Source string length.
+    /// \param [in] CompilerName  - Compiler name, e.g. "FXC", "DXC" or "glslang".
+    /// \param [in] CompilerInfo  - Compiler version, target (shader model, SPIRV version, etc.)
+    ///                             and any other compiler options.
+    ///
+    /// \remarks The key includes the shader type, entry point, macros, compile flags and the effective
+    ///          optimization level as well as
+    ///          the contents of all files referenced by #include directives that can be resolved
+    ///          through ShaderCI.pShaderSourceStreamFactory.
+    static Key ComputeKey(const ShaderCreateInfo&       ShaderCI,
+                          const char*                   Source,
+                          size_t                        SourceLength,
+                          const char*                   CompilerName,
+                          std::initializer_list<Uint32> CompilerInfo);
+
+    /// Returns the byte code for the given key or null if the key is not in the cache.
+
+    /// \param [in]  CacheKey         - Cache key.
+    /// \param [out] ppCompilerOutput - Optional pointer to the compiler output, see ShaderCreateInfo::ppCompilerOutput.
+    ///                                 If the byte code is found, no compilation takes place and the
+    ///                                 output is set to null.
+    RefCntAutoPtr<IDataBlob> Find(const Key& CacheKey, IDataBlob** ppCompilerOutput = nullptr);
+
+    /// Adds a copy of the byte code to the cache.
+    void Add(const Key& CacheKey, const void* pByteCode, size_t Size);
+
+    /// Adds the byte code blob to the cache without copying the data.
+    void Add(const Key& CacheKey, IDataBlob* pByteCode);
+
+private:
+    std::string GetFilePath(const Key& CacheKey) const;
+
+    RefCntAutoPtr<IDataBlob> LoadFromDisk(const Key& CacheKey) const;
+    void                     StoreToDisk(const Key& CacheKey, IDataBlob* pByteCode) const;
+
+    std::string m_Directory;
+
+    std::mutex                                                     m_ByteCodeMtx;
+    std::unordered_map<Key, RefCntAutoPtr<IDataBlob>, Key::Hasher> m_ByteCode;
+};
+
+} // namespace Diligent
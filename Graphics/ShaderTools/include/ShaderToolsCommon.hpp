@@ -68,6 +68,12 @@ void AppendShaderMacros(std::string& Source, const ShaderMacro* Macros);
 void AppendShaderTypeDefinitions(std::string& Source, SHADER_TYPE Type);
 
 
+/// Resolves SHADER_OPTIMIZATION_LEVEL_DEFAULT to the level used by the current build:
+/// SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY in development builds and
+/// SHADER_OPTIMIZATION_LEVEL_PERFORMANCE otherwise. Other values are returned as is.
+SHADER_OPTIMIZATION_LEVEL GetEffectiveOptimizationLevel(SHADER_OPTIMIZATION_LEVEL Level);
+
+
 /// Reads shader source code from a file or uses the one from the shader create info
 const char* ReadShaderSourceFile(const char*                      SourceCode,
                                  IShaderSourceInputStreamFactory* pShaderSourceStreamFactory,
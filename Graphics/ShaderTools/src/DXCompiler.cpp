@@ -236,12 +236,12 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData{MakeNewRCObj<DataBlobImpl>()(0)};
-        pSourceStream->ReadBlob(pFileData);
+        RefCntAutoPtr<IDataBlob> pFileData;
+        pSourceStream->ReadBlob2(&pFileData);
 
         CComPtr<IDxcBlobEncoding> sourceBlob;
 
-        HRESULT hr = m_pLibrary->CreateBlobWithEncodingFromPinned(pFileData->GetDataPtr(), static_cast<UINT32>(pFileData->GetSize()), CP_UTF8, &sourceBlob);
+        HRESULT hr = m_pLibrary->CreateBlobWithEncodingFromPinned(pFileData->GetConstDataPtr(), static_cast<UINT32>(pFileData->GetSize()), CP_UTF8, &sourceBlob);
         if (FAILED(hr))
         {
             LOG_ERROR("Failed to allocate space for shader include file ", fileName, ".");
@@ -41,6 +41,7 @@
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "Timer.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
 
@@ -243,20 +244,25 @@ std::vector<unsigned int> CompileShaderInternal(::glslang::TShader&           Sh
                                                 const char*                   ShaderSource,
                                                 size_t                        SourceCodeLen,
                                                 bool                          AssignBindings,
-                                                IDataBlob**                   ppCompilerOutput)
+                                                IDataBlob**                   ppCompilerOutput,
+                                                ShaderCompileStatistics&      Stats)
 {
     Shader.setAutoMapBindings(true);
     TBuiltInResource Resources = InitResources();
 
+    Timer StageTimer;
+
     auto ParseResult = pIncluder != nullptr ?
         Shader.parse(&Resources, 100, false, messages, *pIncluder) :
         Shader.parse(&Resources, 100, false, messages);
+    Stats.ParseTime = StageTimer.GetElapsedTime();
     if (!ParseResult)
     {
         LogCompilerError("Failed to parse shader source: \n", Shader.getInfoLog(), Shader.getInfoDebugLog(), ShaderSource, SourceCodeLen, ppCompilerOutput);
         return {};
     }
 
+    StageTimer.Restart();
     ::glslang::TProgram Program;
     Program.addShader(&Shader);
     if (!Program.link(messages))
@@ -268,13 +274,71 @@ std::vector<unsigned int> CompileShaderInternal(::glslang::TShader&           Sh
     // This step is essential to set bindings and descriptor sets
     if (AssignBindings)
         Program.mapIO();
+    Stats.LinkTime = StageTimer.GetElapsedTime();
 
+    StageTimer.Restart();
     std::vector<unsigned int> spirv;
     ::glslang::GlslangToSpv(*Program.getIntermediate(Shader.getStage()), spirv);
+    Stats.CodeGenTime = StageTimer.GetElapsedTime();
 
     return spirv;
 }
 
+// Runs spirv-opt passes selected by the optimization level. SPIR-V generated from HLSL
+// must be legalized to turn it into a valid vulkan SPIR-V shader, so legalization passes
+// are always registered for HLSL unless the optimizer is disabled altogether.
+void OptimizeSPIRV(std::vector<unsigned int>& SPIRV,
+                   spv_target_env             spvTarget,
+                   SHADER_OPTIMIZATION_LEVEL  OptimizationLevel,
+                   bool                       IsHLSL,
+                   ShaderCompileStatistics&   Stats)
+{
+    OptimizationLevel = GetEffectiveOptimizationLevel(OptimizationLevel);
+    if (OptimizationLevel == SHADER_OPTIMIZATION_LEVEL_NONE)
+        return;
+    if (OptimizationLevel == SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY && !IsHLSL)
+        return;
+
+    Timer OptTimer;
+
+    spvtools::Optimizer SpirvOptimizer{spvTarget};
+    SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
+    if (IsHLSL)
+        SpirvOptimizer.RegisterLegalizationPasses();
+
+    switch (OptimizationLevel)
+    {
+        case SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY:
+            break;
+
+        case SHADER_OPTIMIZATION_LEVEL_PERFORMANCE:
+            SpirvOptimizer.RegisterPerformancePasses();
+            break;
+
+        case SHADER_OPTIMIZATION_LEVEL_SIZE:
+            SpirvOptimizer.RegisterSizePasses();
+            break;
+
+        default:
+            UNEXPECTED("Unexpected optimization level");
+    }
+
+    std::vector<uint32_t> OptimizedSPIRV;
+    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
+    {
+        SPIRV = std::move(OptimizedSPIRV);
+    }
+    else
+    {
+        if (IsHLSL)
+            LOG_ERROR("Failed to legalize SPIR-V shader generated by HLSL front-end. This may result in undefined behavior.");
+        else
+            LOG_ERROR("Failed to optimize SPIR-V.");
+    }
+
+    Stats.OptimizationTime = OptTimer.GetElapsedTime();
+}
+
 
 class IncluderImpl : public ::glslang::TShader::Includer
 {
@@ -297,12 +361,12 @@ public:
             return nullptr;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
-        pSourceStream->ReadBlob(pFileData);
+        RefCntAutoPtr<IDataBlob> pFileData;
+        pSourceStream->ReadBlob2(&pFileData);
         auto* pNewInclude =
             new IncludeResult{
                 headerName,
-                reinterpret_cast<const char*>(pFileData->GetDataPtr()),
+                reinterpret_cast<const char*>(pFileData->GetConstDataPtr()),
                 pFileData->GetSize(),
                 nullptr};
 
@@ -384,26 +448,16 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     IncluderImpl Includer{ShaderCI.pShaderSourceStreamFactory};
 
-    auto SPIRV = CompileShaderInternal(Shader, messages, &Includer, SourceCode, SourceCodeLen, true, ppCompilerOutput);
-    if (SPIRV.empty())
-        return SPIRV;
+    ShaderCompileStatistics Stats;
 
-    // SPIR-V bytecode generated from HLSL must be legalized to
-    // turn it into a valid vulkan SPIR-V shader
-    spvtools::Optimizer SpirvOptimizer{SPV_ENV_VULKAN_1_0};
-    SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
-    SpirvOptimizer.RegisterLegalizationPasses();
-    SpirvOptimizer.RegisterPerformancePasses();
-    std::vector<uint32_t> LegalizedSPIRV;
-    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &LegalizedSPIRV))
-    {
-        return LegalizedSPIRV;
-    }
-    else
-    {
-        LOG_ERROR("Failed to legalize SPIR-V shader generated by HLSL front-end. This may result in undefined behavior.");
-        return SPIRV;
-    }
+    auto SPIRV = CompileShaderInternal(Shader, messages, &Includer, SourceCode, SourceCodeLen, true, ppCompilerOutput, Stats);
+    if (!SPIRV.empty())
+        OptimizeSPIRV(SPIRV, SPV_ENV_VULKAN_1_0, ShaderCI.OptimizationLevel, true, Stats);
+
+    if (ShaderCI.pCompileStats != nullptr)
+        *ShaderCI.pCompileStats = Stats;
+
+    return SPIRV;
 }
 
 std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
@@ -456,23 +510,16 @@ std::vector<unsigned int> GLSLtoSPIRV(const GLSLtoSPIRVAttribs& Attribs)
 
     IncluderImpl Includer{Attribs.pShaderSourceStreamFactory};
 
-    auto SPIRV = CompileShaderInternal(Shader, messages, &Includer, Attribs.ShaderSource, Attribs.SourceCodeLen, Attribs.AssignBindings, Attribs.ppCompilerOutput);
-    if (SPIRV.empty())
-        return SPIRV;
+    ShaderCompileStatistics Stats;
 
-    spvtools::Optimizer SpirvOptimizer(spvTarget);
-    SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
-    SpirvOptimizer.RegisterPerformancePasses();
-    std::vector<uint32_t> OptimizedSPIRV;
-    if (SpirvOptimizer.Run(SPIRV.data(), SPIRV.size(), &OptimizedSPIRV))
-    {
-        return OptimizedSPIRV;
-    }
-    else
-    {
-        LOG_ERROR("Failed to optimize SPIR-V.");
-        return SPIRV;
-    }
+    auto SPIRV = CompileShaderInternal(Shader, messages, &Includer, Attribs.ShaderSource, Attribs.SourceCodeLen, Attribs.AssignBindings, Attribs.ppCompilerOutput, Stats);
+    if (!SPIRV.empty())
+        OptimizeSPIRV(SPIRV, spvTarget, Attribs.OptimizationLevel, false, Stats);
+
+    if (Attribs.pCompileStats != nullptr)
+        *Attribs.pCompileStats = Stats;
+
+    return SPIRV;
 }
 
 } // namespace GLSLangUtils
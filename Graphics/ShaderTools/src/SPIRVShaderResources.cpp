@@ -124,6 +124,28 @@ SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const diligent_spirv_cros
 // clang-format on
 {}
 
+SPIRVShaderResourceAttribs::SPIRVShaderResourceAttribs(const char*        _Name,
+                                                       Uint16             _ArraySize,
+                                                       ResourceType       _Type,
+                                                       RESOURCE_DIMENSION _ResourceDim,
+                                                       bool               _IsMS,
+                                                       uint32_t           _BindingDecorationOffset,
+                                                       uint32_t           _DescriptorSetDecorationOffset,
+                                                       Uint32             _BufferStaticSize,
+                                                       Uint32             _BufferStride) noexcept :
+    // clang-format off
+    Name                          {_Name},
+    ArraySize                     {_ArraySize},
+    Type                          {_Type},
+    ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+    IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+    BindingDecorationOffset       {_BindingDecorationOffset},
+    DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+    BufferStaticSize              {_BufferStaticSize},
+    BufferStride                  {_BufferStride}
+// clang-format on
+{}
+
 
 SHADER_RESOURCE_TYPE SPIRVShaderResourceAttribs::GetShaderResourceType(ResourceType Type)
 {
@@ -652,6 +674,250 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
     }
 }
 
+namespace
+{
+
+// Serialized reflection data layout:
+//
+//   | Version | Resource counts | Stage input count | Compute group size | IsHLSL | Entry point | Resources | Stage inputs |
+//
+// All values are stored as Uint32, strings are stored as the length followed by the characters.
+class ReflectionWriter
+{
+public:
+    explicit ReflectionWriter(std::vector<Uint8>& Data) :
+        m_Data{Data}
+    {}
+
+    void Write(Uint32 Val)
+    {
+        const auto* pBytes = reinterpret_cast<const Uint8*>(&Val);
+        m_Data.insert(m_Data.end(), pBytes, pBytes + sizeof(Val));
+    }
+
+    void Write(const char* Str)
+    {
+        const auto Len = strlen(Str);
+        Write(static_cast<Uint32>(Len));
+        m_Data.insert(m_Data.end(), Str, Str + Len);
+    }
+
+private:
+    std::vector<Uint8>& m_Data;
+};
+
+class ReflectionReader
+{
+public:
+    ReflectionReader(const void* pData, size_t Size) :
+        m_pCurr{static_cast<const Uint8*>(pData)},
+        m_pEnd{static_cast<const Uint8*>(pData) + Size}
+    {}
+
+    Uint32 Read() noexcept(false)
+    {
+        Uint32 Val = 0;
+        CheckSize(sizeof(Val));
+        memcpy(&Val, m_pCurr, sizeof(Val));
+        m_pCurr += sizeof(Val);
+        return Val;
+    }
+
+    // Returns the string that is not null-terminated
+    std::pair<const char*, size_t> ReadString() noexcept(false)
+    {
+        const auto Len = Read();
+        CheckSize(Len);
+        const auto* Str = reinterpret_cast<const char*>(m_pCurr);
+        m_pCurr += Len;
+        return {Str, Len};
+    }
+
+    // Skips the string and returns its length
+    size_t SkipString() noexcept(false)
+    {
+        return ReadString().second;
+    }
+
+    bool IsEnd() const { return m_pCurr == m_pEnd; }
+
+private:
+    void CheckSize(size_t Size) const noexcept(false)
+    {
+        if (static_cast<size_t>(m_pEnd - m_pCurr) < Size)
+            LOG_ERROR_AND_THROW("Serialized SPIRV reflection data is truncated");
+    }
+
+    const Uint8* m_pCurr;
+    const Uint8* m_pEnd;
+};
+
+// Number of Uint32 values in the serialized resource that follow its name
+constexpr Uint32 SerializedResourceValues = 5;
+
+} // namespace
+
+constexpr Uint32 SPIRVShaderResources::SerializationVersion;
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&            Allocator,
+                                           const void*                  pData,
+                                           size_t                       DataSize,
+                                           const std::vector<uint32_t>& spirv_binary,
+                                           const ShaderDesc&            shaderDesc,
+                                           const char*                  CombinedSamplerSuffix,
+                                           std::string&                 EntryPoint) noexcept(false) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    ReflectionReader Reader{pData, DataSize};
+    if (Reader.Read() != SerializationVersion)
+        LOG_ERROR_AND_THROW("Serialized SPIRV reflection data version mismatch");
+
+    ResourceCounters ResCounters;
+    ResCounters.NumUBs          = Reader.Read();
+    ResCounters.NumSBs          = Reader.Read();
+    ResCounters.NumImgs         = Reader.Read();
+    ResCounters.NumSmpldImgs    = Reader.Read();
+    ResCounters.NumACs          = Reader.Read();
+    ResCounters.NumSepSmplrs    = Reader.Read();
+    ResCounters.NumSepImgs      = Reader.Read();
+    ResCounters.NumInptAtts     = Reader.Read();
+    ResCounters.NumAccelStructs = Reader.Read();
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please read the new resource type counter here");
+
+    const auto NumShaderStageInputs = Reader.Read();
+    for (auto& GroupSize : m_ComputeGroupSize)
+        GroupSize = Reader.Read();
+    m_IsHLSLSource = Reader.Read() != 0;
+
+    const auto EntryPointName = Reader.ReadString();
+    EntryPoint.assign(EntryPointName.first, EntryPointName.second);
+
+    const auto TotalResources = ResCounters.NumUBs + ResCounters.NumSBs + ResCounters.NumImgs + ResCounters.NumSmpldImgs +
+        ResCounters.NumACs + ResCounters.NumSepSmplrs + ResCounters.NumSepImgs + ResCounters.NumInptAtts + ResCounters.NumAccelStructs;
+    // Every resource takes at least its name length and the values, so this also
+    // rejects the counters that would overflow the resource offsets.
+    if (TotalResources + NumShaderStageInputs > DataSize / sizeof(Uint32) ||
+        TotalResources > std::numeric_limits<OffsetType>::max() ||
+        NumShaderStageInputs > std::numeric_limits<OffsetType>::max())
+        LOG_ERROR_AND_THROW("Serialized SPIRV reflection data is corrupted");
+
+    // The first pass validates the data and computes the size of the names pool
+    auto   ResourcesReader       = Reader;
+    size_t ResourceNamesPoolSize = strlen(shaderDesc.Name) + 1;
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+    for (Uint32 i = 0; i < TotalResources; ++i)
+    {
+        ResourceNamesPoolSize += Reader.SkipString() + 1;
+        for (Uint32 v = 0; v < SerializedResourceValues; ++v)
+            Reader.Read();
+    }
+    for (Uint32 i = 0; i < NumShaderStageInputs; ++i)
+    {
+        ResourceNamesPoolSize += Reader.SkipString() + 1;
+        Reader.Read();
+    }
+    if (!Reader.IsEnd())
+        LOG_ERROR_AND_THROW("Serialized SPIRV reflection data is corrupted");
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+
+    auto ReadOffset = [&]() {
+        const auto Offset = ResourcesReader.Read();
+        if (Offset >= spirv_binary.size())
+            LOG_ERROR_AND_THROW("Serialized decoration offset is out of range of the SPIRV byte code");
+        return Offset;
+    };
+
+    for (Uint32 n = 0; n < TotalResources; ++n)
+    {
+        const auto Name         = ResourcesReader.ReadString();
+        const auto TypeAndDim   = ResourcesReader.Read();
+        const auto Type         = static_cast<SPIRVShaderResourceAttribs::ResourceType>(TypeAndDim & 0xFF);
+        const auto ResourceDim  = static_cast<RESOURCE_DIMENSION>((TypeAndDim >> 8) & 0x7F);
+        const auto IsMS         = ((TypeAndDim >> 15) & 0x01) != 0;
+        const auto ArraySize    = static_cast<Uint16>(TypeAndDim >> 16);
+        const auto BindingOff   = ReadOffset();
+        const auto DescrSetOff  = ReadOffset();
+        const auto StaticSize   = ResourcesReader.Read();
+        const auto BufferStride = ResourcesReader.Read();
+        if (Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes || ResourceDim >= RESOURCE_DIM_NUM_DIMENSIONS)
+            LOG_ERROR_AND_THROW("Serialized SPIRV reflection data is corrupted");
+
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                ResourceNamesPool.CopyString(std::string{Name.first, Name.second}),
+                ArraySize,
+                Type,
+                ResourceDim,
+                IsMS,
+                BindingOff,
+                DescrSetOff,
+                StaticSize,
+                BufferStride //
+            };
+    }
+
+    for (Uint32 n = 0; n < NumShaderStageInputs; ++n)
+    {
+        const auto Semantic = ResourcesReader.ReadString();
+        new (&GetShaderStageInputAttribs(n)) SPIRVShaderStageInputAttribs //
+            {
+                ResourceNamesPool.CopyString(std::string{Semantic.first, Semantic.second}),
+                ReadOffset() //
+            };
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+}
+
+void SPIRVShaderResources::Serialize(const std::string& EntryPoint, std::vector<Uint8>& Data) const
+{
+    ReflectionWriter Writer{Data};
+    Writer.Write(SerializationVersion);
+
+    Writer.Write(GetNumUBs());
+    Writer.Write(GetNumSBs());
+    Writer.Write(GetNumImgs());
+    Writer.Write(GetNumSmpldImgs());
+    Writer.Write(GetNumACs());
+    Writer.Write(GetNumSepSmplrs());
+    Writer.Write(GetNumSepImgs());
+    Writer.Write(GetNumInptAtts());
+    Writer.Write(GetNumAccelStructs());
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please write the new resource type counter here");
+
+    Writer.Write(GetNumShaderStageInputs());
+    for (auto GroupSize : m_ComputeGroupSize)
+        Writer.Write(GroupSize);
+    Writer.Write(m_IsHLSLSource ? 1u : 0u);
+    Writer.Write(EntryPoint.c_str());
+
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto& Res = GetResource(n);
+        Writer.Write(Res.Name);
+        Writer.Write(Uint32{Res.Type} | (Uint32{Res.ResourceDim} << 8) | (Uint32{Res.IsMS} << 15) | (Uint32{Res.ArraySize} << 16));
+        Writer.Write(Res.BindingDecorationOffset);
+        Writer.Write(Res.DescriptorSetDecorationOffset);
+        Writer.Write(Res.BufferStaticSize);
+        Writer.Write(Res.BufferStride);
+    }
+
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+    {
+        const auto& Input = GetShaderStageInputAttribs(n);
+        Writer.Write(Input.Semantic);
+        Writer.Write(Input.LocationDecorationOffset);
+    }
+}
+
 SPIRVShaderResources::~SPIRVShaderResources()
 {
     for (Uint32 n = 0; n < GetNumUBs(); ++n)
@@ -0,0 +1,303 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderCache.hpp"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "BasicFileStream.hpp"
+#include "MappedFileStream.hpp"
+#include "FileSystem.hpp"
+#include "HashUtils.hpp"
+#include "StringTools.hpp"
+#include "DebugUtilities.hpp"
+#include "ShaderToolsCommon.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct ShaderCacheFileHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43485344; // 'DSHC'
+    static constexpr Uint32 ExpectedVersion = 3;
+
+    Uint32 Magic   = ExpectedMagic;
+    Uint32 Version = ExpectedVersion;
+    Uint64 KeyHash = 0;
+    // The key data immediately follows the header, and the byte code follows the key data
+    Uint64 KeySize = 0;
+    Uint64 Size    = 0;
+};
+
+// Appends the contents of all files referenced by #include directives to the key.
+// Conditional directives are not evaluated, so the key may depend on files that
+// are not actually included by the compiler, which can only result in a cache miss.
+void AppendIncludes(ShaderCache::Key&                CacheKey,
+                    const char*                      Source,
+                    size_t                           SourceLength,
+                    IShaderSourceInputStreamFactory* pStreamFactory,
+                    std::unordered_set<std::string>& ProcessedIncludes)
+{
+    ForEachIncludeDirective(Source, SourceLength, [&](std::string&& Name) {
+        if (!ProcessedIncludes.insert(Name).second)
+            return;
+
+        CacheKey.AppendString(Name.c_str());
+
+        RefCntAutoPtr<IFileStream> pIncludeStream;
+        pStreamFactory->CreateInputStream2(Name.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pIncludeStream);
+        if (pIncludeStream)
+        {
+            RefCntAutoPtr<IDataBlob> pIncludeData;
+            pIncludeStream->ReadBlob2(&pIncludeData);
+
+            const auto* IncludeSource = static_cast<const char*>(pIncludeData->GetConstDataPtr());
+            const auto  IncludeLength = pIncludeData->GetSize();
+            CacheKey.AppendData(IncludeSource, IncludeLength);
+            AppendIncludes(CacheKey, IncludeSource, IncludeLength, pStreamFactory, ProcessedIncludes);
+        }
+    });
+}
+
+} // namespace
+
+void ShaderCache::Key::AppendData(const void* pData, size_t Size)
+{
+    VERIFY_EXPR(pData != nullptr || Size == 0);
+
+    // The size is stored before the data so that the key is not ambiguous:
+    // e.g. "ab" followed by "c" is different from "a" followed by "bc".
+    const Uint64 Size64 = Size;
+    m_Data.append(reinterpret_cast<const char*>(&Size64), sizeof(Size64));
+    m_Data.append(static_cast<const char*>(pData), Size);
+
+    m_Hash = WyHash::Hash(&Size64, sizeof(Size64), m_Hash);
+    m_Hash = WyHash::Hash(pData, Size, m_Hash);
+}
+
+void ShaderCache::Key::AppendString(const char* Str)
+{
+    const Uint8 IsNull = Str == nullptr ? 1 : 0;
+    AppendData(&IsNull, sizeof(IsNull));
+    if (Str != nullptr)
+        AppendData(Str, strlen(Str));
+}
+
+ShaderCache::ShaderCache(const char* Directory)
+{
+    if (Directory == nullptr || *Directory == '\0')
+        return;
+
+    m_Directory = Directory;
+    if (!FileSystem::PathExists(m_Directory.c_str()) && !FileSystem::CreateDirectory(m_Directory.c_str()))
+    {
+        LOG_WARNING_MESSAGE("Failed to create shader cache directory '", m_Directory, "'. Compiled shaders will only be cached in memory.");
+        m_Directory.clear();
+        return;
+    }
+
+    const auto SlashSymbol = FileSystem::GetSlashSymbol();
+    if (m_Directory.back() != '/' && m_Directory.back() != '\\')
+        m_Directory += SlashSymbol;
+}
+
+ShaderCache::Key ShaderCache::ComputeKey(const ShaderCreateInfo&       ShaderCI,
+                                         const char*                   Source,
+                                         size_t                        SourceLength,
+                                         const char*                   CompilerName,
+                                         std::initializer_list<Uint32> CompilerInfo)
+{
+    VERIFY_EXPR(Source != nullptr && CompilerName != nullptr);
+
+    Key CacheKey;
+    CacheKey.AppendData(Source, SourceLength);
+    CacheKey.AppendString(CompilerName);
+    CacheKey.AppendData(CompilerInfo.begin(), CompilerInfo.size() * sizeof(Uint32));
+    CacheKey.AppendValues(static_cast<Uint32>(ShaderCI.Desc.ShaderType),
+                          static_cast<Uint32>(ShaderCI.SourceLanguage),
+                          static_cast<Uint32>(ShaderCI.CompileFlags),
+                          static_cast<Uint32>(GetEffectiveOptimizationLevel(ShaderCI.OptimizationLevel)));
+    CacheKey.AppendString(ShaderCI.EntryPoint);
+
+    if (ShaderCI.Macros != nullptr)
+    {
+        for (const auto* pMacro = ShaderCI.Macros; pMacro->Name != nullptr; ++pMacro)
+        {
+            CacheKey.AppendString(pMacro->Name);
+            CacheKey.AppendString(pMacro->Definition != nullptr ? pMacro->Definition : "");
+        }
+    }
+
+    if (ShaderCI.pShaderSourceStreamFactory != nullptr)
+    {
+        std::unordered_set<std::string> ProcessedIncludes;
+        AppendIncludes(CacheKey, Source, SourceLength, ShaderCI.pShaderSourceStreamFactory, ProcessedIncludes);
+    }
+
+    return CacheKey;
+}
+
+RefCntAutoPtr<IDataBlob> ShaderCache::Find(const Key& CacheKey, IDataBlob** ppCompilerOutput)
+{
+    RefCntAutoPtr<IDataBlob> pByteCode;
+    {
+        std::lock_guard<std::mutex> Lock{m_ByteCodeMtx};
+
+        auto it = m_ByteCode.find(CacheKey);
+        if (it != m_ByteCode.end())
+            pByteCode = it->second;
+    }
+
+    if (!pByteCode && !m_Directory.empty())
+    {
+        pByteCode = LoadFromDisk(CacheKey);
+        if (pByteCode)
+        {
+            std::lock_guard<std::mutex> Lock{m_ByteCodeMtx};
+            m_ByteCode.emplace(CacheKey, pByteCode);
+        }
+    }
+
+    if (pByteCode && ppCompilerOutput != nullptr)
+    {
+        // The shader is not compiled, so there is no compiler output
+        if (*ppCompilerOutput != nullptr)
+            (*ppCompilerOutput)->Release();
+        *ppCompilerOutput = nullptr;
+    }
+
+    return pByteCode;
+}
+
+void ShaderCache::Add(const Key& CacheKey, const void* pByteCode, size_t Size)
+{
+    VERIFY_EXPR(pByteCode != nullptr && Size > 0);
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>{}(Size)};
+    memcpy(pData->GetDataPtr(), pByteCode, Size);
+    Add(CacheKey, pData);
+}
+
+void ShaderCache::Add(const Key& CacheKey, IDataBlob* pByteCode)
+{
+    VERIFY_EXPR(pByteCode != nullptr && pByteCode->GetSize() > 0);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_ByteCodeMtx};
+        if (!m_ByteCode.emplace(CacheKey, pByteCode).second)
+            return;
+    }
+
+    if (!m_Directory.empty())
+        StoreToDisk(CacheKey, pByteCode);
+}
+
+std::string ShaderCache::GetFilePath(const Key& CacheKey) const
+{
+    std::stringstream ss;
+    ss << m_Directory << std::hex << std::setw(16) << std::setfill('0') << CacheKey.GetHash() << ".bin";
+    return ss.str();
+}
+
+RefCntAutoPtr<IDataBlob> ShaderCache::LoadFromDisk(const Key& CacheKey) const
+{
+    const auto FilePath = GetFilePath(CacheKey);
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return {};
+
+    // The byte code blob references the file mapping directly
+    RefCntAutoPtr<IFileStream> pFile{MakeNewRCObj<MappedFileStream>()(FilePath.c_str())};
+    if (!pFile->IsValid())
+        pFile = MakeNewRCObj<BasicFileStream>()(FilePath.c_str(), EFileAccessMode::Read);
+    if (!pFile->IsValid())
+        return {};
+
+    ShaderCacheFileHeader Header;
+
+    const auto FileSize = pFile->GetSize();
+    if (FileSize <= sizeof(Header) || !pFile->Read(&Header, sizeof(Header)))
+        return {};
+
+    if (Header.Magic != ShaderCacheFileHeader::ExpectedMagic ||
+        Header.Version != ShaderCacheFileHeader::ExpectedVersion ||
+        Header.KeyHash != CacheKey.GetHash() ||
+        Header.KeySize > FileSize - sizeof(Header) ||
+        Header.Size != FileSize - sizeof(Header) - Header.KeySize)
+    {
+        LOG_WARNING_MESSAGE("Shader cache file '", FilePath, "' is invalid or was created by a different version of the engine and will be ignored.");
+        return {};
+    }
+
+    // Different keys may have the same hash, in which case the file holds the byte code of another shader
+    const auto& KeyData = CacheKey.GetData();
+    if (Header.KeySize != KeyData.size())
+        return {};
+    std::vector<char> FileKeyData(KeyData.size());
+    if (!KeyData.empty() && (!pFile->Read(FileKeyData.data(), FileKeyData.size()) || memcmp(FileKeyData.data(), KeyData.data(), KeyData.size()) != 0))
+        return {};
+
+    RefCntAutoPtr<IDataBlob> pByteCode;
+    pFile->ReadBlob2(&pByteCode);
+    if (!pByteCode || pByteCode->GetSize() != Header.Size)
+        return {};
+
+    return pByteCode;
+}
+
+void ShaderCache::StoreToDisk(const Key& CacheKey, IDataBlob* pByteCode) const
+{
+    const auto FilePath = GetFilePath(CacheKey);
+
+    FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_WARNING_MESSAGE("Failed to open shader cache file '", FilePath, "' for writing.");
+        return;
+    }
+
+    const auto& KeyData = CacheKey.GetData();
+
+    ShaderCacheFileHeader Header;
+    Header.KeyHash = CacheKey.GetHash();
+    Header.KeySize = KeyData.size();
+    Header.Size    = pByteCode->GetSize();
+    if (!File->Write(&Header, sizeof(Header)) ||
+        !File->Write(KeyData.data(), KeyData.size()) ||
+        !File->Write(pByteCode->GetConstDataPtr(), pByteCode->GetSize()))
+        LOG_WARNING_MESSAGE("Failed to write shader cache file '", FilePath, "'.");
+}
+
+} // namespace Diligent
@@ -102,6 +102,19 @@ void AppendShaderTypeDefinitions(std::string& Source, SHADER_TYPE Type)
     AppendShaderMacros(Source, GetShaderTypeMacros(Type));
 }
 
+SHADER_OPTIMIZATION_LEVEL GetEffectiveOptimizationLevel(SHADER_OPTIMIZATION_LEVEL Level)
+{
+    VERIFY(Level < SHADER_OPTIMIZATION_NUM_LEVELS, "Unexpected optimization level");
+    if (Level != SHADER_OPTIMIZATION_LEVEL_DEFAULT)
+        return Level;
+
+#ifdef DILIGENT_DEVELOPMENT
+    return SHADER_OPTIMIZATION_LEVEL_LEGALIZE_ONLY;
+#else
+    return SHADER_OPTIMIZATION_LEVEL_PERFORMANCE;
+#endif
+}
+
 
 const char* ReadShaderSourceFile(const char*                      SourceCode,
                                  IShaderSourceInputStreamFactory* pShaderSourceStreamFactory,
@@ -126,9 +139,9 @@ const char* ReadShaderSourceFile(const char*                      SourceCode,
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                pFileData = MakeNewRCObj<DataBlobImpl>{}(0);
-                pSourceStream->ReadBlob(pFileData);
-                SourceCode    = reinterpret_cast<char*>(pFileData->GetDataPtr());
+                pFileData.Release();
+                pSourceStream->ReadBlob2(&pFileData);
+                SourceCode    = reinterpret_cast<const char*>(pFileData->GetConstDataPtr());
                 SourceCodeLen = pFileData->GetSize();
             }
             else
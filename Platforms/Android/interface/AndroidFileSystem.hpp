@@ -88,6 +88,15 @@ public:
     static AndroidFile*          OpenFile(const FileOpenAttribs& OpenAttribs);
     static inline Diligent::Char GetSlashSymbol() { return '/'; }
 
+    /// Maps the file into memory for reading.
+    ///
+    /// Files in the external files directory are mapped with mmap(). Uncompressed assets
+    /// are mapped directly from the APK, so no data is copied. Compressed assets are
+    /// decompressed once by the asset manager, and the view references its buffer.
+    /// Store shader archives and pipeline caches uncompressed (e.g. with aaptOptions noCompress)
+    /// to load them without copies.
+    static std::unique_ptr<MappedFileView> MapFile(const Diligent::Char* strFilePath);
+
     static bool FileExists(const Diligent::Char* strFilePath);
     static bool PathExists(const Diligent::Char* strPath);
 
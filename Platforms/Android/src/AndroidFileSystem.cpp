@@ -28,7 +28,10 @@
 #include <string>
 #include <android/native_activity.h>
 
+#include <unistd.h>
+
 #include "AndroidFileSystem.hpp"
+#include "PosixMappedFileView.hpp"
 #include "Errors.hpp"
 #include "DebugUtilities.hpp"
 
@@ -62,40 +65,10 @@ public:
 
     bool OpenFile(const char* fileName, std::ifstream& IFS, AAsset*& AssetFile, size_t& FileSize)
     {
-        if (activity_ == nullptr && asset_manager_ == nullptr)
-        {
-            LOG_ERROR_MESSAGE("JNIMiniHelper has not been initialized. Call init() to initialize the helper");
-            return false;
-        }
-
-        // Lock mutex
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        if (activity_ != nullptr)
-        {
-            // First, try reading from externalFileDir;
-            std::string ExternalFilesPath;
-            {
-                JNIEnv* env          = nullptr;
-                bool    DetachThread = AttachCurrentThread(env);
-                if (jstring jstr_path = GetExternalFilesDirJString(env))
-                {
-                    const char* path  = env->GetStringUTFChars(jstr_path, nullptr);
-                    ExternalFilesPath = std::string(path);
-                    if (fileName[0] != '/')
-                    {
-                        ExternalFilesPath.append("/");
-                    }
-                    ExternalFilesPath.append(fileName);
-                    env->ReleaseStringUTFChars(jstr_path, path);
-                    env->DeleteLocalRef(jstr_path);
-                }
-                if (DetachThread)
-                    DetachCurrentThread();
-            }
-
+        // First, try reading from externalFileDir
+        std::string ExternalFilesPath;
+        if (GetExternalFilePath(fileName, ExternalFilesPath))
             IFS.open(ExternalFilesPath.c_str(), std::ios::binary);
-        }
 
         if (IFS && IFS.is_open())
         {
@@ -104,29 +77,65 @@ public:
             IFS.seekg(0, std::ifstream::beg);
             return true;
         }
-        else if (asset_manager_ != nullptr)
+
+        // Fallback to assetManager
+        AssetFile = OpenAsset(fileName, AASSET_MODE_BUFFER);
+        if (!AssetFile)
         {
-            // Fallback to assetManager
-            AssetFile = AAssetManager_open(asset_manager_, fileName, AASSET_MODE_BUFFER);
-            if (!AssetFile)
-            {
-                return false;
-            }
-            uint8_t* data = (uint8_t*)AAsset_getBuffer(AssetFile);
-            if (data == nullptr)
-            {
-                AAsset_close(AssetFile);
+            return false;
+        }
+        uint8_t* data = (uint8_t*)AAsset_getBuffer(AssetFile);
+        if (data == nullptr)
+        {
+            AAsset_close(AssetFile);
+            AssetFile = nullptr;
 
-                LOG_ERROR_MESSAGE("Failed to open: ", fileName);
-                return false;
-            }
-            FileSize = AAsset_getLength(AssetFile);
-            return true;
+            LOG_ERROR_MESSAGE("Failed to open: ", fileName);
+            return false;
         }
-        else
+        FileSize = AAsset_getLength(AssetFile);
+        return true;
+    }
+
+    // Returns the path of the file in the external files directory
+    bool GetExternalFilePath(const char* fileName, std::string& ExternalFilesPath)
+    {
+        if (activity_ == nullptr && asset_manager_ == nullptr)
         {
+            LOG_ERROR_MESSAGE("JNIMiniHelper has not been initialized. Call init() to initialize the helper");
             return false;
         }
+
+        if (activity_ == nullptr)
+            return false;
+
+        // Lock mutex
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        JNIEnv* env          = nullptr;
+        bool    DetachThread = AttachCurrentThread(env);
+        if (jstring jstr_path = GetExternalFilesDirJString(env))
+        {
+            const char* path  = env->GetStringUTFChars(jstr_path, nullptr);
+            ExternalFilesPath = std::string(path);
+            if (fileName[0] != '/')
+            {
+                ExternalFilesPath.append("/");
+            }
+            ExternalFilesPath.append(fileName);
+            env->ReleaseStringUTFChars(jstr_path, path);
+            env->DeleteLocalRef(jstr_path);
+        }
+        if (DetachThread)
+            DetachCurrentThread();
+
+        return !ExternalFilesPath.empty();
+    }
+
+    AAsset* OpenAsset(const char* fileName, int Mode)
+    {
+        // Asset manager is thread-safe, but AAsset objects are not
+        return asset_manager_ != nullptr ? AAssetManager_open(asset_manager_, fileName, Mode) : nullptr;
     }
 
     /*
@@ -310,6 +319,71 @@ AndroidFile* AndroidFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
     return pFile;
 }
 
+namespace
+{
+
+class AndroidAssetView final : public MappedFileView
+{
+public:
+    AndroidAssetView(AAsset* pAsset, const void* pData, size_t Size) :
+        MappedFileView{pData, Size},
+        m_pAsset{pAsset}
+    {}
+
+    ~AndroidAssetView() override
+    {
+        AAsset_close(m_pAsset);
+    }
+
+private:
+    AAsset* const m_pAsset;
+};
+
+} // namespace
+
+std::unique_ptr<MappedFileView> AndroidFileSystem::MapFile(const Diligent::Char* strFilePath)
+{
+    auto& Helper = JNIMiniHelper::GetInstance();
+
+    // Files in the external files directory take precedence over the assets
+    std::string ExternalFilePath;
+    if (Helper.GetExternalFilePath(strFilePath, ExternalFilePath))
+    {
+        if (auto pView = PosixMappedFileView::Create(ExternalFilePath.c_str()))
+            return pView;
+    }
+
+    AAsset* pAsset = Helper.OpenAsset(strFilePath, AASSET_MODE_RANDOM);
+    if (pAsset == nullptr)
+        return nullptr;
+
+    // Uncompressed assets are stored in the APK as is and can be mapped directly from the package file.
+    // The file descriptor is only available for such assets.
+    off64_t   Start  = 0;
+    off64_t   Length = 0;
+    const int fd     = AAsset_openFileDescriptor64(pAsset, &Start, &Length);
+    if (fd >= 0)
+    {
+        auto pView = PosixMappedFileView::Create(fd, static_cast<Diligent::Uint64>(Start), static_cast<size_t>(Length));
+        close(fd);
+        if (pView)
+        {
+            AAsset_close(pAsset);
+            return pView;
+        }
+    }
+
+    // Compressed assets are decompressed by the asset manager into its own buffer, which is
+    // still exposed without an extra copy. The buffer lives as long as the asset is open.
+    const void* pData = AAsset_getBuffer(pAsset);
+    if (pData == nullptr)
+    {
+        AAsset_close(pAsset);
+        return nullptr;
+    }
+    return std::unique_ptr<MappedFileView>{new AndroidAssetView{pAsset, pData, static_cast<size_t>(AAsset_getLength64(pAsset))}};
+}
+
 
 bool AndroidFileSystem::FileExists(const Diligent::Char* strFilePath)
 {
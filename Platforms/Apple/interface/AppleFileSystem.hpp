@@ -40,6 +40,10 @@ struct AppleFileSystem : public BasicFileSystem
 public:
     static AppleFile* OpenFile(const FileOpenAttribs& OpenAttribs);
 
+    static std::unique_ptr<MappedFileView> MapFile(const Diligent::Char* strFilePath);
+
+    static bool GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status);
+
     static inline Diligent::Char GetSlashSymbol() { return '/'; }
 
     static bool FileExists(const Diligent::Char* strFilePath);
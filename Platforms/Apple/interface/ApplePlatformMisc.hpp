@@ -33,4 +33,9 @@
 
 struct AppleMisc : public LinuxMisc
 {
+    static CPUInfo GetCPUInfo();
+
+    static Diligent::Uint64 SetCurrentThreadAffinity(Diligent::Uint64 Mask);
+
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
 };
@@ -27,12 +27,14 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <cstdio>
 #include <CoreFoundation/CoreFoundation.h>
 
 #include "CFObjectWrapper.hpp"
 
 #include "AppleFileSystem.hpp"
+#include "PosixMappedFileView.hpp"
 #include "Errors.hpp"
 #include "DebugUtilities.hpp"
 
@@ -107,6 +109,37 @@ AppleFile* AppleFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
     return pFile;
 }
 
+std::unique_ptr<MappedFileView> AppleFileSystem::MapFile(const Diligent::Char* strFilePath)
+{
+    // Try to find the file in the bundle first
+    std::string path(strFilePath);
+    CorrectSlashes(path, AppleFileSystem::GetSlashSymbol());
+    auto resource_path = FindResource(path);
+
+    std::unique_ptr<MappedFileView> pView;
+    if (!resource_path.empty())
+        pView = PosixMappedFileView::Create(resource_path.c_str());
+
+    if (!pView)
+        pView = PosixMappedFileView::Create(path.c_str());
+
+    return pView;
+}
+
+bool AppleFileSystem::GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status)
+{
+    std::string path(strFilePath);
+    CorrectSlashes(path, AppleFileSystem::GetSlashSymbol());
+    auto resource_path = FindResource(path);
+
+    struct stat FileStat;
+    if (stat(!resource_path.empty() ? resource_path.c_str() : path.c_str(), &FileStat) != 0 || !S_ISREG(FileStat.st_mode))
+        return false;
+
+    Status.ModificationTime = static_cast<Diligent::Uint64>(FileStat.st_mtimespec.tv_sec) * 1000000000ull + static_cast<Diligent::Uint64>(FileStat.st_mtimespec.tv_nsec);
+    Status.Size             = static_cast<Diligent::Uint64>(FileStat.st_size);
+    return true;
+}
 
 bool AppleFileSystem::FileExists(const Diligent::Char* strFilePath)
 {
@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ApplePlatformMisc.hpp"
+
+#include <cstring>
+#include <string>
+
+#include <pthread.h>
+#include <sys/qos.h>
+#include <sys/sysctl.h>
+
+using namespace Diligent;
+
+namespace
+{
+
+// Integer sysctl values are either 32- or 64-bit
+bool GetSysctlValue(const char* Name, Uint64& Value)
+{
+    Uint64 Buffer = 0;
+    size_t Size   = sizeof(Buffer);
+    if (sysctlbyname(Name, &Buffer, &Size, nullptr, 0) != 0)
+        return false;
+
+    if (Size == sizeof(Uint32))
+    {
+        Uint32 Value32 = 0;
+        memcpy(&Value32, &Buffer, sizeof(Value32));
+        Value = Value32;
+    }
+    else if (Size == sizeof(Uint64))
+    {
+        Value = Buffer;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+Uint32 GetSysctlValue(const char* Name)
+{
+    Uint64 Value = 0;
+    return GetSysctlValue(Name, Value) ? static_cast<Uint32>(Value) : 0;
+}
+
+} // namespace
+
+AppleMisc::CPUInfo AppleMisc::GetCPUInfo()
+{
+    CPUInfo Info;
+    Info.NumLogicalProcessors = GetSysctlValue("hw.logicalcpu");
+    Info.NumCores             = GetSysctlValue("hw.physicalcpu");
+    if (Info.NumLogicalProcessors == 0 || Info.NumCores == 0)
+        return BasicPlatformMisc::GetCPUInfo();
+
+    Info.CacheLineSize = GetSysctlValue("hw.cachelinesize");
+
+    // Apple Silicon reports performance levels starting with the fastest one.
+    // Processor indices are not exposed, so cluster masks are left zero.
+    const auto NumPerfLevels = GetSysctlValue("hw.nperflevels");
+    for (Uint32 Level = 0; Level < NumPerfLevels; ++Level)
+    {
+        const auto Prefix = "hw.perflevel" + std::to_string(Level) + ".";
+
+        CPUCluster Cluster;
+        Cluster.NumLogicalProcessors = GetSysctlValue((Prefix + "logicalcpu").c_str());
+        Cluster.NumCores             = GetSysctlValue((Prefix + "physicalcpu").c_str());
+        Cluster.Performance          = NumPerfLevels - Level;
+        if (Cluster.NumLogicalProcessors == 0)
+            continue;
+        Info.Clusters.emplace_back(Cluster);
+
+        if (Level == 0)
+        {
+            Info.L1DataCacheSize = GetSysctlValue((Prefix + "l1dcachesize").c_str());
+            Info.L2CacheSize     = GetSysctlValue((Prefix + "l2cachesize").c_str());
+            Info.L3CacheSize     = GetSysctlValue((Prefix + "l3cachesize").c_str());
+        }
+    }
+
+    if (Info.Clusters.empty())
+    {
+        CPUCluster Cluster;
+        Cluster.NumLogicalProcessors = Info.NumLogicalProcessors;
+        Cluster.NumCores             = Info.NumCores;
+        Info.Clusters.emplace_back(Cluster);
+
+        Info.L1DataCacheSize = GetSysctlValue("hw.l1dcachesize");
+        Info.L2CacheSize     = GetSysctlValue("hw.l2cachesize");
+        Info.L3CacheSize     = GetSysctlValue("hw.l3cachesize");
+    }
+
+    return Info;
+}
+
+Uint64 AppleMisc::SetCurrentThreadAffinity(Uint64 Mask)
+{
+    // Darwin does not support binding threads to processors. Use thread priorities
+    // (quality-of-service classes) to steer the threads to the performance cores.
+    return BasicPlatformMisc::SetCurrentThreadAffinity(Mask);
+}
+
+AppleMisc::ThreadPriority AppleMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    // Quality-of-service classes control both the scheduling priority and
+    // the type of the cores the thread runs on.
+    qos_class_t QoSClass = QOS_CLASS_DEFAULT;
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:      QoSClass = QOS_CLASS_BACKGROUND;       break;
+        case ThreadPriority::BelowNormal: QoSClass = QOS_CLASS_UTILITY;          break;
+        case ThreadPriority::Normal:      QoSClass = QOS_CLASS_DEFAULT;          break;
+        case ThreadPriority::AboveNormal: QoSClass = QOS_CLASS_USER_INITIATED;   break;
+        case ThreadPriority::Highest:     QoSClass = QOS_CLASS_USER_INTERACTIVE; break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected thread priority");
+            return ThreadPriority::Unknown;
+    }
+
+    const auto PrevQoSClass = qos_class_self();
+    if (pthread_set_qos_class_self_np(QoSClass, 0) != 0)
+        return ThreadPriority::Unknown;
+
+    switch (PrevQoSClass)
+    {
+        // clang-format off
+        case QOS_CLASS_BACKGROUND:       return ThreadPriority::Lowest;
+        case QOS_CLASS_UTILITY:          return ThreadPriority::BelowNormal;
+        case QOS_CLASS_USER_INITIATED:   return ThreadPriority::AboveNormal;
+        case QOS_CLASS_USER_INTERACTIVE: return ThreadPriority::Highest;
+        // Threads that have never been assigned a class run with the default priority
+        default:                         return ThreadPriority::Normal;
+        // clang-format on
+    }
+}
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include "../../../Primitives/interface/BasicTypes.h"
 
 enum class EFileAccessMode
@@ -71,6 +72,62 @@ protected:
     Diligent::String m_Path;
 };
 
+/// Read-only view of a file mapped into the address space of the process.
+
+/// The view is unmapped when the object is destroyed.
+/// The file must not be modified or truncated while the view is alive.
+class MappedFileView
+{
+public:
+    virtual ~MappedFileView() {}
+
+    const void* GetData() const { return m_pData; }
+    size_t      GetSize() const { return m_Size; }
+
+protected:
+    MappedFileView(const void* pData, size_t Size) :
+        m_pData{pData},
+        m_Size{Size}
+    {}
+
+    const void* const m_pData;
+    const size_t      m_Size;
+};
+
+/// File attributes that are used to detect file modifications
+struct FileStatus
+{
+    /// Last modification time. The units and the epoch are platform-specific,
+    /// so the value should only be compared with other values returned by the same platform.
+    Diligent::Uint64 ModificationTime = 0;
+
+    /// File size, in bytes.
+    Diligent::Uint64 Size = 0;
+
+    bool operator==(const FileStatus& rhs) const
+    {
+        return ModificationTime == rhs.ModificationTime && Size == rhs.Size;
+    }
+    bool operator!=(const FileStatus& rhs) const
+    {
+        return !(*this == rhs);
+    }
+};
+
+/// Watches a directory and its subdirectories for file modifications.
+/// The watch is stopped when the object is destroyed.
+class DirectoryWatcher
+{
+public:
+    virtual ~DirectoryWatcher() {}
+
+    /// Appends the paths of the files that have been created, modified, renamed or deleted
+    /// since the previous call to GetModifiedFiles(). The paths are relative to the watched directory
+    /// and use the platform slash symbol. The same file may be reported more than once.
+    /// The method does not block.
+    virtual void GetModifiedFiles(std::vector<Diligent::String>& ModifiedFiles) = 0;
+};
+
 struct FindFileData
 {
     virtual const Diligent::Char* Name() const        = 0;
@@ -89,6 +146,21 @@ public:
 
     static bool FileExists(const Diligent::Char* strFilePath);
 
+    /// Maps the file into memory for reading. Returns null if the platform does not support
+    /// memory-mapped files or the file can't be mapped, in which case the file should be read
+    /// through the regular file interface.
+    static std::unique_ptr<MappedFileView> MapFile(const Diligent::Char* strFilePath);
+
+    /// Queries the modification time and the size of the file. Returns false if the file
+    /// does not exist or the platform does not support file status queries, in which case
+    /// the caller can't detect modifications of the file.
+    static bool GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status);
+
+    /// Starts watching the directory and its subdirectories for file modifications.
+    /// Returns null if the platform does not support directory change notifications or
+    /// the directory can't be watched, in which case the caller should poll file status instead.
+    static std::unique_ptr<DirectoryWatcher> WatchDirectory(const Diligent::Char* strDirPath);
+
     static void SetWorkingDirectory(const Diligent::Char* strWorkingDir) { m_strWorkingDirectory = strWorkingDir; }
 
     static const Diligent::String& GetWorkingDirectory() { return m_strWorkingDirectory; }
@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "../../../Primitives/interface/BasicTypes.h"
 
 struct BasicPlatformMisc
@@ -66,4 +68,116 @@ struct BasicPlatformMisc
         }
         return bits;
     }
+
+    /// Thread priority levels, see SetCurrentThreadPriority().
+    enum class ThreadPriority : Diligent::Uint8
+    {
+        Unknown,
+        Lowest,
+        BelowNormal,
+        Normal,
+        AboveNormal,
+        Highest
+    };
+
+    /// Group of logical processors with identical performance characteristics,
+    /// e.g. the big or the LITTLE cores of an ARM big.LITTLE CPU, or the P- or E-cores
+    /// of a hybrid x86 CPU.
+    struct CPUCluster
+    {
+        /// Logical processors that belong to the cluster, one bit per processor index.
+        /// Only the first 64 processors are represented. Zero if the platform does not
+        /// expose processor indices (macOS and iOS).
+        Diligent::Uint64 ProcessorMask = 0;
+
+        /// The number of logical processors in the cluster.
+        Diligent::Uint32 NumLogicalProcessors = 0;
+
+        /// The number of physical cores in the cluster.
+        Diligent::Uint32 NumCores = 0;
+
+        /// Relative performance of the cluster's cores (larger is faster).
+        /// The values are only meaningful when compared with other clusters of the same CPU.
+        Diligent::Uint32 Performance = 0;
+    };
+
+    /// CPU topology information, see GetCPUInfo().
+    struct CPUInfo
+    {
+        /// The total number of logical processors.
+        Diligent::Uint32 NumLogicalProcessors = 0;
+
+        /// The total number of physical cores.
+        Diligent::Uint32 NumCores = 0;
+
+        /// Cache line size, in bytes, or 0 if unknown.
+        Diligent::Uint32 CacheLineSize = 0;
+
+        /// Cache sizes, in bytes, as seen by a core of the fastest cluster, or 0 if unknown.
+        Diligent::Uint32 L1DataCacheSize = 0;
+        Diligent::Uint32 L2CacheSize     = 0;
+        Diligent::Uint32 L3CacheSize     = 0;
+
+        /// Processor clusters sorted by decreasing performance.
+        /// CPUs with identical cores have a single cluster.
+        std::vector<CPUCluster> Clusters;
+
+        /// Returns the mask of the logical processors of the fastest cluster.
+        Diligent::Uint64 GetPerformanceProcessorMask() const
+        {
+            return !Clusters.empty() ? Clusters.front().ProcessorMask : 0;
+        }
+
+        /// Returns true if the CPU has cores with different performance characteristics.
+        bool IsHeterogeneous() const
+        {
+            return Clusters.size() > 1;
+        }
+    };
+
+    /// Returns the CPU topology information.
+
+    /// \remarks   The basic implementation only knows the number of logical processors and
+    ///             reports each of them as a separate core of a single cluster.
+    static CPUInfo GetCPUInfo();
+
+    /// Restricts the calling thread to the logical processors in the mask.
+
+    /// \param [in] Mask - Logical processor mask, one bit per processor index.
+    /// \return     The previous affinity mask of the thread, or 0 if the
+    ///             affinity could not be set or is not supported by the platform.
+    ///
+    /// \remarks   A typical use is pinning the render and submit threads to the
+    ///             performance cores (see CPUInfo::GetPerformanceProcessorMask()).
+    static Diligent::Uint64 SetCurrentThreadAffinity(Diligent::Uint64 Mask);
+
+    /// Sets the priority of the calling thread.
+
+    /// \param [in] Priority - New thread priority; must not be ThreadPriority::Unknown.
+    /// \return     The previous priority of the thread, or ThreadPriority::Unknown if
+    ///             the priority could not be set or is not supported by the platform.
+    ///
+    /// \remarks   On Linux and Android, raising the priority above ThreadPriority::Normal
+    ///             may require elevated privileges.
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    /// Returns the size, in bytes, of a large memory page, or 0 if large pages are not supported.
+    static size_t GetLargePageSize();
+
+    /// Allocates memory backed by large pages.
+
+    /// \param [in] Size - Allocation size, in bytes; must be a multiple of GetLargePageSize().
+    /// \return     Pointer to the memory aligned by the large page size, or null if
+    ///             the large pages could not be allocated.
+    ///
+    /// \remarks   On Linux, the pages are taken from the reserved huge page pool when it has enough pages.
+    ///             Otherwise, transparent huge pages are requested unless they are disabled in the system.
+    ///             On Windows, the process must have the SeLockMemoryPrivilege ("Lock pages in memory") privilege.
+    static void* AllocateLargePages(size_t Size);
+
+    /// Releases the memory allocated by AllocateLargePages().
+
+    /// \param [in] Ptr  - Pointer returned by AllocateLargePages().
+    /// \param [in] Size - Size that was passed to AllocateLargePages().
+    static void FreeLargePages(void* Ptr, size_t Size);
 };
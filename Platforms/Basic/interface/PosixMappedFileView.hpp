@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "BasicFileSystem.hpp"
+
+/// Memory-mapped file view implemented with POSIX mmap().
+class PosixMappedFileView final : public MappedFileView
+{
+public:
+    ~PosixMappedFileView() override;
+
+    /// Maps the file at the given path. Returns null if the file can't be opened,
+    /// is empty or the mapping fails.
+    static std::unique_ptr<MappedFileView> Create(const Diligent::Char* strFilePath);
+
+    /// Maps Size bytes starting at Offset of the open file. The offset does not need to be
+    /// page-aligned, which allows mapping files embedded in archives (e.g. uncompressed
+    /// Android assets). The caller retains the ownership of the file descriptor and may close
+    /// it once the view has been created. Returns null if the mapping fails.
+    static std::unique_ptr<MappedFileView> Create(int fd, Diligent::Uint64 Offset, size_t Size);
+
+private:
+    PosixMappedFileView(void* pMapping, size_t MappingSize, size_t DataOffset, size_t Size) :
+        MappedFileView{static_cast<const Diligent::Uint8*>(pMapping) + DataOffset, Size},
+        m_pMapping{pMapping},
+        m_MappingSize{MappingSize}
+    {}
+
+    void* const  m_pMapping;
+    const size_t m_MappingSize;
+};
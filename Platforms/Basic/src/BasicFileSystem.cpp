@@ -92,6 +92,21 @@ bool BasicFileSystem::FileExists(const Diligent::Char* strFilePath)
     return false;
 }
 
+std::unique_ptr<MappedFileView> BasicFileSystem::MapFile(const Diligent::Char* strFilePath)
+{
+    return nullptr;
+}
+
+bool BasicFileSystem::GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status)
+{
+    return false;
+}
+
+std::unique_ptr<DirectoryWatcher> BasicFileSystem::WatchDirectory(const Diligent::Char* strDirPath)
+{
+    return nullptr;
+}
+
 Diligent::Char BasicFileSystem::GetSlashSymbol()
 {
     UNSUPPORTED("Unsupported");
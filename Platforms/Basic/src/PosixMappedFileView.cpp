@@ -0,0 +1,74 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "PosixMappedFileView.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+PosixMappedFileView::~PosixMappedFileView()
+{
+    munmap(m_pMapping, m_MappingSize);
+}
+
+std::unique_ptr<MappedFileView> PosixMappedFileView::Create(const Diligent::Char* strFilePath)
+{
+    const int fd = open(strFilePath, O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    std::unique_ptr<MappedFileView> pView;
+
+    struct stat FileStat;
+    if (fstat(fd, &FileStat) == 0 && FileStat.st_size > 0)
+        pView = Create(fd, 0, static_cast<size_t>(FileStat.st_size));
+
+    // The mapping keeps its own reference to the file
+    close(fd);
+
+    return pView;
+}
+
+std::unique_ptr<MappedFileView> PosixMappedFileView::Create(int fd, Diligent::Uint64 Offset, size_t Size)
+{
+    if (fd < 0 || Size == 0)
+        return nullptr;
+
+    // mmap() requires the offset to be a multiple of the page size
+    const auto PageSize      = static_cast<Diligent::Uint64>(sysconf(_SC_PAGE_SIZE));
+    const auto MappingOffset = Offset - Offset % PageSize;
+    const auto DataOffset    = static_cast<size_t>(Offset - MappingOffset);
+    const auto MappingSize   = DataOffset + Size;
+
+    void* pMapping = mmap(nullptr, MappingSize, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(MappingOffset));
+    if (pMapping == MAP_FAILED)
+        return nullptr;
+
+    return std::unique_ptr<MappedFileView>{new PosixMappedFileView{pMapping, MappingSize, DataOffset, Size}};
+}
@@ -99,4 +99,16 @@ struct LinuxMisc : public BasicPlatformMisc
         VERIFY_EXPR(bits == BasicPlatformMisc::CountOneBits(Val));
         return bits;
     }
+
+    static CPUInfo GetCPUInfo();
+
+    static Diligent::Uint64 SetCurrentThreadAffinity(Diligent::Uint64 Mask);
+
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    static size_t GetLargePageSize();
+
+    static void* AllocateLargePages(size_t Size);
+
+    static void FreeLargePages(void* Ptr, size_t Size);
 };
@@ -26,10 +26,16 @@
  */
 
 #include <stdio.h>
+#include <errno.h>
 #include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
 #include <cstdio>
+#include <unordered_map>
 
 #include "LinuxFileSystem.hpp"
+#include "PosixMappedFileView.hpp"
 #include "Errors.hpp"
 #include "DebugUtilities.hpp"
 
@@ -46,6 +52,174 @@ LinuxFile* LinuxFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
     return pFile;
 }
 
+std::unique_ptr<MappedFileView> LinuxFileSystem::MapFile(const Diligent::Char* strFilePath)
+{
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.strFilePath = strFilePath;
+    BasicFile   DummyFile(OpenAttribs, LinuxFileSystem::GetSlashSymbol());
+    const auto& Path = DummyFile.GetPath(); // This is necessary to correct slashes
+    return PosixMappedFileView::Create(Path.c_str());
+}
+
+bool LinuxFileSystem::GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status)
+{
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.strFilePath = strFilePath;
+    BasicFile   DummyFile(OpenAttribs, LinuxFileSystem::GetSlashSymbol());
+    const auto& Path = DummyFile.GetPath(); // This is necessary to correct slashes
+
+    struct stat FileStat;
+    if (stat(Path.c_str(), &FileStat) != 0 || !S_ISREG(FileStat.st_mode))
+        return false;
+
+    Status.ModificationTime = static_cast<Diligent::Uint64>(FileStat.st_mtim.tv_sec) * 1000000000ull + static_cast<Diligent::Uint64>(FileStat.st_mtim.tv_nsec);
+    Status.Size             = static_cast<Diligent::Uint64>(FileStat.st_size);
+    return true;
+}
+
+namespace
+{
+
+class InotifyDirectoryWatcher final : public DirectoryWatcher
+{
+public:
+    static std::unique_ptr<DirectoryWatcher> Create(const Diligent::String& DirPath)
+    {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+
+        std::unique_ptr<InotifyDirectoryWatcher> pWatcher{new InotifyDirectoryWatcher{fd, DirPath}};
+        if (!pWatcher->AddWatch("", nullptr))
+            return nullptr;
+
+        return pWatcher;
+    }
+
+    ~InotifyDirectoryWatcher()
+    {
+        // Closing the descriptor removes all watches
+        close(m_fd);
+    }
+
+    virtual void GetModifiedFiles(std::vector<Diligent::String>& ModifiedFiles) override final
+    {
+        alignas(inotify_event) char Buffer[4096];
+        for (;;)
+        {
+            const auto Len = read(m_fd, Buffer, sizeof(Buffer));
+            if (Len <= 0)
+                break; // EAGAIN - no more events
+
+            for (const char* pEventData = Buffer; pEventData < Buffer + Len;)
+            {
+                const auto& Event = *reinterpret_cast<const inotify_event*>(pEventData);
+                pEventData += sizeof(inotify_event) + Event.len;
+
+                if (Event.mask & IN_Q_OVERFLOW)
+                {
+                    LOG_WARNING_MESSAGE("Directory change notification queue for '", m_RootPath, "' has overflowed. Some file modifications may be missed.");
+                    continue;
+                }
+
+                if (Event.mask & IN_IGNORED)
+                {
+                    // The watched directory has been deleted
+                    m_WatchedDirs.erase(Event.wd);
+                    continue;
+                }
+
+                auto dir_it = m_WatchedDirs.find(Event.wd);
+                if (dir_it == m_WatchedDirs.end() || Event.len == 0)
+                    continue;
+
+                auto RelPath = dir_it->second;
+                if (!RelPath.empty())
+                    RelPath += '/';
+                RelPath += Event.name;
+
+                if (Event.mask & IN_ISDIR)
+                {
+                    // Files may have been added to the new directory before the watch was set up,
+                    // so report all of them.
+                    if (Event.mask & (IN_CREATE | IN_MOVED_TO))
+                        AddWatch(RelPath, &ModifiedFiles);
+                }
+                else if ((Event.mask & IN_CREATE) == 0)
+                {
+                    ModifiedFiles.emplace_back(std::move(RelPath));
+                }
+            }
+        }
+    }
+
+private:
+    InotifyDirectoryWatcher(int fd, const Diligent::String& RootPath) :
+        m_fd{fd},
+        m_RootPath{RootPath}
+    {}
+
+    // Watches the directory and all its subdirectories.
+    // If pFiles is not null, appends the files found in the directories.
+    bool AddWatch(const Diligent::String& RelDirPath, std::vector<Diligent::String>* pFiles)
+    {
+        const auto DirPath = RelDirPath.empty() ? m_RootPath : m_RootPath + '/' + RelDirPath;
+
+        // IN_CREATE is only needed for new directories: new files are reported by
+        // IN_CLOSE_WRITE once they have been written.
+        const auto wd = inotify_add_watch(m_fd, DirPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE | IN_ONLYDIR);
+        if (wd < 0)
+            return false;
+        m_WatchedDirs[wd] = RelDirPath;
+
+        DIR* pDir = opendir(DirPath.c_str());
+        if (pDir == nullptr)
+            return true;
+
+        while (const dirent* pEntry = readdir(pDir))
+        {
+            const Diligent::String Name = pEntry->d_name;
+            if (Name == "." || Name == "..")
+                continue;
+
+            const auto RelPath = RelDirPath.empty() ? Name : RelDirPath + '/' + Name;
+
+            bool IsDir = pEntry->d_type == DT_DIR;
+            if (pEntry->d_type == DT_UNKNOWN)
+            {
+                struct stat EntryStat;
+                IsDir = stat((m_RootPath + '/' + RelPath).c_str(), &EntryStat) == 0 && S_ISDIR(EntryStat.st_mode);
+            }
+
+            if (IsDir)
+                AddWatch(RelPath, pFiles);
+            else if (pFiles != nullptr)
+                pFiles->push_back(RelPath);
+        }
+        closedir(pDir);
+
+        return true;
+    }
+
+    const int              m_fd;
+    const Diligent::String m_RootPath;
+
+    // Watch descriptor -> directory path relative to the root
+    std::unordered_map<int, Diligent::String> m_WatchedDirs;
+};
+
+} // namespace
+
+std::unique_ptr<DirectoryWatcher> LinuxFileSystem::WatchDirectory(const Diligent::Char* strDirPath)
+{
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.strFilePath = strDirPath;
+    BasicFile DummyFile(OpenAttribs, LinuxFileSystem::GetSlashSymbol());
+    auto      Path = DummyFile.GetPath(); // This is necessary to correct slashes
+    while (Path.size() > 1 && Path.back() == '/')
+        Path.pop_back();
+    return InotifyDirectoryWatcher::Create(Path);
+}
 
 bool LinuxFileSystem::FileExists(const Diligent::Char* strFilePath)
 {
@@ -62,14 +236,31 @@ bool LinuxFileSystem::FileExists(const Diligent::Char* strFilePath)
 
 bool LinuxFileSystem::PathExists(const Diligent::Char* strPath)
 {
-    UNSUPPORTED("Not implemented");
-    return false;
+    Diligent::String Path{strPath};
+    CorrectSlashes(Path, GetSlashSymbol());
+
+    struct stat PathStat;
+    return stat(Path.c_str(), &PathStat) == 0;
 }
 
 bool LinuxFileSystem::CreateDirectory(const Diligent::Char* strPath)
 {
-    UNSUPPORTED("Not implemented");
-    return false;
+    Diligent::String Path{strPath};
+    CorrectSlashes(Path, GetSlashSymbol());
+
+    // Create all intermediate directories
+    for (auto SlashPos = Path.find('/', 1); SlashPos != Diligent::String::npos; SlashPos = Path.find('/', SlashPos + 1))
+    {
+        const auto SubPath = Path.substr(0, SlashPos);
+        if (mkdir(SubPath.c_str(), 0755) != 0 && errno != EEXIST)
+            return false;
+    }
+
+    if (mkdir(Path.c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+
+    struct stat PathStat;
+    return stat(Path.c_str(), &PathStat) == 0 && S_ISDIR(PathStat.st_mode);
 }
 
 void LinuxFileSystem::ClearDirectory(const Diligent::Char* strPath)
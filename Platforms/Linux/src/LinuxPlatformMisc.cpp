@@ -0,0 +1,367 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+// The file is also compiled by the Android platform library
+#include "../interface/LinuxPlatformMisc.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace Diligent;
+
+namespace
+{
+
+// Reads the first line of a sysfs file
+bool ReadSysFile(const std::string& Path, std::string& Value)
+{
+    auto* pFile = fopen(Path.c_str(), "r");
+    if (pFile == nullptr)
+        return false;
+
+    char Buffer[64] = {};
+    const bool Res  = fgets(Buffer, sizeof(Buffer), pFile) != nullptr;
+    fclose(pFile);
+    if (!Res)
+        return false;
+
+    Value = Buffer;
+    while (!Value.empty() && (Value.back() == '\n' || Value.back() == ' '))
+        Value.pop_back();
+    return !Value.empty();
+}
+
+bool ReadSysFile(const std::string& Path, Uint64& Value)
+{
+    std::string Str;
+    if (!ReadSysFile(Path, Str))
+        return false;
+
+    char* pEnd = nullptr;
+    Value      = strtoull(Str.c_str(), &pEnd, 10);
+    // Cache sizes are reported with a suffix, e.g. "32K"
+    if (*pEnd == 'K')
+        Value *= 1024;
+    else if (*pEnd == 'M')
+        Value *= 1024 * 1024;
+    return pEnd != Str.c_str();
+}
+
+std::string GetCPUPath(Uint32 CPU)
+{
+    return "/sys/devices/system/cpu/cpu" + std::to_string(CPU);
+}
+
+// Returns the relative performance of the logical processor
+Uint64 GetCPUPerformance(Uint32 CPU)
+{
+    const auto CPUPath = GetCPUPath(CPU);
+
+    Uint64 Performance = 0;
+    // cpu_capacity is exposed by ARM kernels with energy-aware scheduling and is the most
+    // reliable way to tell big cores from LITTLE ones.
+    if (ReadSysFile(CPUPath + "/cpu_capacity", Performance))
+        return Performance;
+    // Maximum frequency distinguishes clusters on most other heterogeneous CPUs
+    if (ReadSysFile(CPUPath + "/cpufreq/cpuinfo_max_freq", Performance))
+        return Performance;
+    return 0;
+}
+
+int ThreadPriorityToNice(LinuxMisc::ThreadPriority Priority)
+{
+    switch (Priority)
+    {
+        // clang-format off
+        case LinuxMisc::ThreadPriority::Lowest:      return  19;
+        case LinuxMisc::ThreadPriority::BelowNormal: return  10;
+        case LinuxMisc::ThreadPriority::Normal:      return   0;
+        // Android display threads use -4 and -8
+        case LinuxMisc::ThreadPriority::AboveNormal: return  -4;
+        case LinuxMisc::ThreadPriority::Highest:     return  -8;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected thread priority");
+            return 0;
+    }
+}
+
+LinuxMisc::ThreadPriority NiceToThreadPriority(int Nice)
+{
+    if (Nice >= 15)
+        return LinuxMisc::ThreadPriority::Lowest;
+    else if (Nice >= 5)
+        return LinuxMisc::ThreadPriority::BelowNormal;
+    else if (Nice > -3)
+        return LinuxMisc::ThreadPriority::Normal;
+    else if (Nice > -7)
+        return LinuxMisc::ThreadPriority::AboveNormal;
+    else
+        return LinuxMisc::ThreadPriority::Highest;
+}
+
+} // namespace
+
+LinuxMisc::CPUInfo LinuxMisc::GetCPUInfo()
+{
+    const auto NumCPUs = sysconf(_SC_NPROCESSORS_CONF);
+    if (NumCPUs <= 0)
+        return BasicPlatformMisc::GetCPUInfo();
+
+    struct ClusterInfo
+    {
+        CPUCluster Cluster;
+        Uint32     FirstCPU = ~0u;
+
+        std::set<std::pair<Uint64, Uint64>> Cores;
+    };
+    // Clusters keyed by performance
+    std::map<Uint64, ClusterInfo> Clusters;
+
+    CPUInfo Info;
+
+    std::set<std::pair<Uint64, Uint64>> Cores;
+    for (Uint32 CPU = 0; CPU < static_cast<Uint32>(NumCPUs); ++CPU)
+    {
+        const auto CPUPath = GetCPUPath(CPU);
+
+        // Offline processors may have no topology information. Their logical index is
+        // used as the core id, so that each of them is counted as a separate core.
+        Uint64 PackageId = 0;
+        Uint64 CoreId    = 0;
+        if (!ReadSysFile(CPUPath + "/topology/physical_package_id", PackageId) ||
+            !ReadSysFile(CPUPath + "/topology/core_id", CoreId))
+        {
+            PackageId = ~Uint64{0};
+            CoreId    = CPU;
+        }
+        const auto Core = std::make_pair(PackageId, CoreId);
+
+        auto& Cluster = Clusters[GetCPUPerformance(CPU)];
+        if (CPU < 64)
+            Cluster.Cluster.ProcessorMask |= Uint64{1} << CPU;
+        ++Cluster.Cluster.NumLogicalProcessors;
+        Cluster.Cores.emplace(Core);
+        Cluster.FirstCPU = std::min(Cluster.FirstCPU, CPU);
+
+        ++Info.NumLogicalProcessors;
+        Cores.emplace(Core);
+    }
+    Info.NumCores = static_cast<Uint32>(Cores.size());
+
+    // std::map is sorted by increasing performance
+    for (auto it = Clusters.rbegin(); it != Clusters.rend(); ++it)
+    {
+        auto Cluster        = it->second.Cluster;
+        Cluster.NumCores    = static_cast<Uint32>(it->second.Cores.size());
+        Cluster.Performance = static_cast<Uint32>(std::min(it->first, Uint64{~0u}));
+        Info.Clusters.emplace_back(Cluster);
+    }
+
+    // Caches of the first processor of the fastest cluster
+    const auto CachePath = GetCPUPath(Clusters.rbegin()->second.FirstCPU) + "/cache/index";
+    for (Uint32 Index = 0;; ++Index)
+    {
+        const auto IndexPath = CachePath + std::to_string(Index);
+
+        Uint64      Level = 0;
+        Uint64      Size  = 0;
+        std::string Type;
+        if (!ReadSysFile(IndexPath + "/level", Level) ||
+            !ReadSysFile(IndexPath + "/size", Size) ||
+            !ReadSysFile(IndexPath + "/type", Type))
+            break;
+
+        if (Type == "Instruction")
+            continue;
+
+        if (Level == 1)
+        {
+            Info.L1DataCacheSize = static_cast<Uint32>(Size);
+
+            Uint64 LineSize = 0;
+            if (ReadSysFile(IndexPath + "/coherency_line_size", LineSize))
+                Info.CacheLineSize = static_cast<Uint32>(LineSize);
+        }
+        else if (Level == 2)
+            Info.L2CacheSize = static_cast<Uint32>(Size);
+        else if (Level == 3)
+            Info.L3CacheSize = static_cast<Uint32>(Size);
+    }
+
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+    if (Info.CacheLineSize == 0)
+    {
+        const auto LineSize = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+        if (LineSize > 0)
+            Info.CacheLineSize = static_cast<Uint32>(LineSize);
+    }
+#endif
+
+    return Info;
+}
+
+Uint64 LinuxMisc::SetCurrentThreadAffinity(Uint64 Mask)
+{
+    cpu_set_t PrevSet;
+    CPU_ZERO(&PrevSet);
+    // Pid 0 refers to the calling thread
+    if (sched_getaffinity(0, sizeof(PrevSet), &PrevSet) != 0)
+        return 0;
+
+    cpu_set_t NewSet;
+    CPU_ZERO(&NewSet);
+    for (Uint32 CPU = 0; CPU < 64; ++CPU)
+    {
+        if (Mask & (Uint64{1} << CPU))
+            CPU_SET(CPU, &NewSet);
+    }
+    if (sched_setaffinity(0, sizeof(NewSet), &NewSet) != 0)
+        return 0;
+
+    Uint64 PrevMask = 0;
+    for (Uint32 CPU = 0; CPU < 64; ++CPU)
+    {
+        if (CPU_ISSET(CPU, &PrevSet))
+            PrevMask |= Uint64{1} << CPU;
+    }
+    return PrevMask;
+}
+
+LinuxMisc::ThreadPriority LinuxMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    if (Priority == ThreadPriority::Unknown)
+    {
+        UNEXPECTED("Thread priority must not be unknown");
+        return ThreadPriority::Unknown;
+    }
+
+    // Linux threads use normal scheduling policy that ignores pthread priorities.
+    // The nice value, however, is a per-thread attribute when addressed by the thread id.
+    const auto ThreadId = static_cast<id_t>(syscall(SYS_gettid));
+
+    // getpriority() may legitimately return -1, so errno must be checked
+    errno               = 0;
+    const auto PrevNice = getpriority(PRIO_PROCESS, ThreadId);
+    if (PrevNice == -1 && errno != 0)
+        return ThreadPriority::Unknown;
+
+    if (setpriority(PRIO_PROCESS, ThreadId, ThreadPriorityToNice(Priority)) != 0)
+        return ThreadPriority::Unknown;
+
+    return NiceToThreadPriority(PrevNice);
+}
+
+size_t LinuxMisc::GetLargePageSize()
+{
+    static const size_t LargePageSize = []() -> size_t {
+        Uint64 Size = 0;
+        // The size of transparent huge pages, which is also the default
+        // size of the reserved huge pages on all common architectures
+        if (ReadSysFile("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", Size) && Size != 0)
+            return static_cast<size_t>(Size);
+
+        // Kernels without transparent huge pages may still have the reserved pool
+        auto* pMemInfo = fopen("/proc/meminfo", "r");
+        if (pMemInfo == nullptr)
+            return 0;
+
+        char Line[128] = {};
+        while (fgets(Line, sizeof(Line), pMemInfo) != nullptr)
+        {
+            unsigned long long SizeKB = 0;
+            if (sscanf(Line, "Hugepagesize: %llu kB", &SizeKB) == 1)
+            {
+                Size = SizeKB * 1024;
+                break;
+            }
+        }
+        fclose(pMemInfo);
+        return static_cast<size_t>(Size);
+    }();
+    return LargePageSize;
+}
+
+void* LinuxMisc::AllocateLargePages(size_t Size)
+{
+    const auto LargePageSize = GetLargePageSize();
+    if (LargePageSize == 0 || Size == 0 || Size % LargePageSize != 0)
+        return nullptr;
+
+#ifdef MAP_HUGETLB
+    // Reserved huge pages are guaranteed to be large, but the pool is empty unless the administrator configured it
+    void* pHugeTLBMemory = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (pHugeTLBMemory != MAP_FAILED)
+        return pHugeTLBMemory;
+#endif
+
+#ifdef MADV_HUGEPAGE
+    std::string THPMode;
+    if (!ReadSysFile("/sys/kernel/mm/transparent_hugepage/enabled", THPMode) || THPMode.find("[never]") != std::string::npos)
+        return nullptr;
+
+    // Transparent huge pages only back the ranges that are aligned by the large page size,
+    // so map one extra page and trim the unaligned head and tail.
+    const auto MappingSize = Size + LargePageSize;
+
+    auto* pMapping = static_cast<Uint8*>(mmap(nullptr, MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (pMapping == MAP_FAILED)
+        return nullptr;
+
+    const auto Head = (LargePageSize - reinterpret_cast<size_t>(pMapping) % LargePageSize) % LargePageSize;
+    const auto Tail = MappingSize - Head - Size;
+    if (Head != 0)
+        munmap(pMapping, Head);
+    if (Tail != 0)
+        munmap(pMapping + Head + Size, Tail);
+
+    auto* pMemory = pMapping + Head;
+    // In the "madvise" mode the kernel only uses huge pages for the advised ranges
+    madvise(pMemory, Size, MADV_HUGEPAGE);
+    return pMemory;
+#else
+    return nullptr;
+#endif
+}
+
+void LinuxMisc::FreeLargePages(void* Ptr, size_t Size)
+{
+    if (Ptr != nullptr)
+        munmap(Ptr, Size);
+}
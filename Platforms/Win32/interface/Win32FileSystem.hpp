@@ -95,6 +95,12 @@ struct WindowsFileSystem : public BasicFileSystem
 public:
     static WindowsFile* OpenFile(const FileOpenAttribs& OpenAttribs);
 
+    static std::unique_ptr<MappedFileView> MapFile(const Diligent::Char* strFilePath);
+
+    static bool GetFileStatus(const Diligent::Char* strFilePath, FileStatus& Status);
+
+    static std::unique_ptr<DirectoryWatcher> WatchDirectory(const Diligent::Char* strDirPath);
+
     static inline Diligent::Char GetSlashSymbol() { return '\\'; }
 
     static bool FileExists(const Diligent::Char* strFilePath);
@@ -138,4 +138,16 @@ struct WindowsMisc : public BasicPlatformMisc
         VERIFY_EXPR(Bits == BasicPlatformMisc::CountOneBits(Val));
         return static_cast<Diligent::Uint32>(Bits);
     }
+
+    static CPUInfo GetCPUInfo();
+
+    static Diligent::Uint64 SetCurrentThreadAffinity(Diligent::Uint64 Mask);
+
+    static ThreadPriority SetCurrentThreadPriority(ThreadPriority Priority);
+
+    static size_t GetLargePageSize();
+
+    static void* AllocateLargePages(size_t Size);
+
+    static void FreeLargePages(void* Ptr, size_t Size);
 };
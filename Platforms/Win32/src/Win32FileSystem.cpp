@@ -118,6 +118,177 @@ WindowsFile* WindowsFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
     return pFile;
 }
 
+namespace
+{
+
+class WindowsMappedFileView final : public MappedFileView
+{
+public:
+    WindowsMappedFileView(const void* pData, size_t Size) :
+        MappedFileView{pData, Size}
+    {}
+
+    ~WindowsMappedFileView() override
+    {
+        UnmapViewOfFile(m_pData);
+    }
+};
+
+} // namespace
+
+std::unique_ptr<MappedFileView> WindowsFileSystem::MapFile(const Char* strFilePath)
+{
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.strFilePath = strFilePath;
+    BasicFile DummyFile(OpenAttribs, WindowsFileSystem::GetSlashSymbol());
+
+    auto   UTF16FilePath = UTF8ToUTF16(DummyFile.GetPath().c_str());
+    HANDLE hFile         = CreateFileW(UTF16FilePath.data(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    const void*   pData    = nullptr;
+    LARGE_INTEGER FileSize = {};
+    if (GetFileSizeEx(hFile, &FileSize) && FileSize.QuadPart > 0 && static_cast<Uint64>(FileSize.QuadPart) <= SIZE_MAX)
+    {
+        if (HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL))
+        {
+            pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+            // The view keeps its own reference to the mapping object
+            CloseHandle(hMapping);
+        }
+    }
+    CloseHandle(hFile);
+
+    if (pData == nullptr)
+        return nullptr;
+
+    return std::unique_ptr<MappedFileView>{new WindowsMappedFileView{pData, static_cast<size_t>(FileSize.QuadPart)}};
+}
+
+bool WindowsFileSystem::GetFileStatus(const Char* strFilePath, FileStatus& Status)
+{
+    WIN32_FILE_ATTRIBUTE_DATA FileAttribs;
+    if (!GetFileAttributesExA(strFilePath, GetFileExInfoStandard, &FileAttribs))
+        return false;
+
+    if ((FileAttribs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        return false;
+
+    Status.ModificationTime = (Uint64{FileAttribs.ftLastWriteTime.dwHighDateTime} << 32u) | Uint64{FileAttribs.ftLastWriteTime.dwLowDateTime};
+    Status.Size             = (Uint64{FileAttribs.nFileSizeHigh} << 32u) | Uint64{FileAttribs.nFileSizeLow};
+    return true;
+}
+
+namespace
+{
+
+class WindowsDirectoryWatcher final : public DirectoryWatcher
+{
+public:
+    static std::unique_ptr<DirectoryWatcher> Create(const Char* strDirPath)
+    {
+        HANDLE hDir = CreateFileW(UTF8ToUTF16(strDirPath).data(), FILE_LIST_DIRECTORY,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                                  FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        if (hDir == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        HANDLE hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (hEvent == NULL)
+        {
+            CloseHandle(hDir);
+            return nullptr;
+        }
+
+        std::unique_ptr<WindowsDirectoryWatcher> pWatcher{new WindowsDirectoryWatcher{hDir, hEvent}};
+        if (!pWatcher->RequestChanges())
+            return nullptr;
+
+        return std::move(pWatcher);
+    }
+
+    ~WindowsDirectoryWatcher()
+    {
+        if (m_RequestPending)
+        {
+            // The buffer must stay alive until the pending request is canceled
+            CancelIo(m_hDir);
+            DWORD BytesTransferred = 0;
+            GetOverlappedResult(m_hDir, &m_Overlapped, &BytesTransferred, TRUE);
+        }
+        CloseHandle(m_Overlapped.hEvent);
+        CloseHandle(m_hDir);
+    }
+
+    virtual void GetModifiedFiles(std::vector<String>& ModifiedFiles) override final
+    {
+        while (m_RequestPending)
+        {
+            DWORD BytesTransferred = 0;
+            if (!GetOverlappedResult(m_hDir, &m_Overlapped, &BytesTransferred, FALSE))
+            {
+                if (GetLastError() == ERROR_IO_INCOMPLETE)
+                    break; // No changes yet
+
+                m_RequestPending = false;
+                break;
+            }
+
+            if (BytesTransferred == 0)
+            {
+                LOG_WARNING_MESSAGE("Directory change notification buffer has overflowed. Some file modifications may be missed.");
+            }
+            else
+            {
+                const BYTE* pData = m_Buffer;
+                for (;;)
+                {
+                    const auto& Info = *reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(pData);
+                    if (Info.Action != FILE_ACTION_RENAMED_OLD_NAME)
+                        ModifiedFiles.emplace_back(NarrowString(std::wstring{Info.FileName, Info.FileNameLength / sizeof(WCHAR)}));
+
+                    if (Info.NextEntryOffset == 0)
+                        break;
+                    pData += Info.NextEntryOffset;
+                }
+            }
+
+            RequestChanges();
+        }
+    }
+
+private:
+    WindowsDirectoryWatcher(HANDLE hDir, HANDLE hEvent) :
+        m_hDir{hDir}
+    {
+        m_Overlapped.hEvent = hEvent;
+    }
+
+    bool RequestChanges()
+    {
+        ResetEvent(m_Overlapped.hEvent);
+        m_RequestPending = ReadDirectoryChangesW(m_hDir, m_Buffer, sizeof(m_Buffer), TRUE,
+                                                 FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+                                                 NULL, &m_Overlapped, NULL) != FALSE;
+        return m_RequestPending;
+    }
+
+    const HANDLE m_hDir;
+    OVERLAPPED   m_Overlapped     = {};
+    bool         m_RequestPending = false;
+
+    // The buffer must be DWORD-aligned
+    alignas(DWORD) BYTE m_Buffer[16384];
+};
+
+} // namespace
+
+std::unique_ptr<DirectoryWatcher> WindowsFileSystem::WatchDirectory(const Char* strDirPath)
+{
+    return WindowsDirectoryWatcher::Create(strDirPath);
+}
+
 bool WindowsFileSystem::FileExists(const Char* strFilePath)
 {
     if (!PathExists(strFilePath))
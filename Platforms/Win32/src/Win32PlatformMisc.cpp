@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "Win32PlatformMisc.hpp"
+
+#include <map>
+#include <vector>
+
+#include <Windows.h>
+
+using namespace Diligent;
+
+WindowsMisc::CPUInfo WindowsMisc::GetCPUInfo()
+{
+    DWORD Length = 0;
+    if (GetLogicalProcessorInformationEx(RelationAll, nullptr, &Length) || GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return BasicPlatformMisc::GetCPUInfo();
+
+    std::vector<Uint8> Buffer(Length);
+    if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(Buffer.data()), &Length))
+        return BasicPlatformMisc::GetCPUInfo();
+
+    const auto ForEachRelation = [&](LOGICAL_PROCESSOR_RELATIONSHIP Relation, auto&& Handler) {
+        for (DWORD Offset = 0; Offset < Length;)
+        {
+            const auto& ProcInfo = *reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(Buffer.data() + Offset);
+            if (ProcInfo.Relationship == Relation)
+                Handler(ProcInfo);
+            Offset += ProcInfo.Size;
+        }
+    };
+
+    CPUInfo Info;
+
+    // Clusters keyed by efficiency class. Higher classes have higher performance.
+    std::map<Uint32, CPUCluster> Clusters;
+    ForEachRelation(RelationProcessorCore, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX& ProcInfo) {
+        auto& Cluster = Clusters[ProcInfo.Processor.EfficiencyClass];
+        ++Cluster.NumCores;
+        ++Info.NumCores;
+        for (WORD i = 0; i < ProcInfo.Processor.GroupCount; ++i)
+        {
+            const auto& GroupMask = ProcInfo.Processor.GroupMask[i];
+
+            const auto NumProcessors = CountOneBits(static_cast<Uint64>(GroupMask.Mask));
+            Cluster.NumLogicalProcessors += NumProcessors;
+            Info.NumLogicalProcessors += NumProcessors;
+            // Thread affinity masks only address processors of the thread's group,
+            // so only the first group is represented.
+            if (GroupMask.Group == 0)
+                Cluster.ProcessorMask |= static_cast<Uint64>(GroupMask.Mask);
+        }
+    });
+
+    for (auto it = Clusters.rbegin(); it != Clusters.rend(); ++it)
+    {
+        it->second.Performance = it->first;
+        Info.Clusters.emplace_back(it->second);
+    }
+
+    const auto PerfMask = Info.GetPerformanceProcessorMask();
+    ForEachRelation(RelationCache, [&](const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX& ProcInfo) {
+        const auto& Cache = ProcInfo.Cache;
+        if (Cache.Type == CacheInstruction || Cache.Type == CacheTrace)
+            return;
+        // Only use the caches accessible from the fastest cluster
+        if (Cache.GroupMask.Group != 0 || (static_cast<Uint64>(Cache.GroupMask.Mask) & PerfMask) == 0)
+            return;
+
+        if (Cache.Level == 1)
+        {
+            Info.L1DataCacheSize = Cache.CacheSize;
+            Info.CacheLineSize   = Cache.LineSize;
+        }
+        else if (Cache.Level == 2)
+            Info.L2CacheSize = Cache.CacheSize;
+        else if (Cache.Level == 3)
+            Info.L3CacheSize = Cache.CacheSize;
+    });
+
+    return Info;
+}
+
+Uint64 WindowsMisc::SetCurrentThreadAffinity(Uint64 Mask)
+{
+#if PLATFORM_WIN32
+    return static_cast<Uint64>(SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(Mask)));
+#else
+    // Thread affinity is not available to UWP applications
+    return BasicPlatformMisc::SetCurrentThreadAffinity(Mask);
+#endif
+}
+
+WindowsMisc::ThreadPriority WindowsMisc::SetCurrentThreadPriority(ThreadPriority Priority)
+{
+    int WinPriority = THREAD_PRIORITY_NORMAL;
+    switch (Priority)
+    {
+        // clang-format off
+        case ThreadPriority::Lowest:      WinPriority = THREAD_PRIORITY_LOWEST;       break;
+        case ThreadPriority::BelowNormal: WinPriority = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case ThreadPriority::Normal:      WinPriority = THREAD_PRIORITY_NORMAL;       break;
+        case ThreadPriority::AboveNormal: WinPriority = THREAD_PRIORITY_ABOVE_NORMAL; break;
+        case ThreadPriority::Highest:     WinPriority = THREAD_PRIORITY_HIGHEST;      break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected thread priority");
+            return ThreadPriority::Unknown;
+    }
+
+    const auto hThread      = GetCurrentThread();
+    const auto PrevPriority = GetThreadPriority(hThread);
+    if (PrevPriority == THREAD_PRIORITY_ERROR_RETURN || !SetThreadPriority(hThread, WinPriority))
+        return ThreadPriority::Unknown;
+
+    if (PrevPriority <= THREAD_PRIORITY_LOWEST)
+        return ThreadPriority::Lowest;
+    else if (PrevPriority == THREAD_PRIORITY_BELOW_NORMAL)
+        return ThreadPriority::BelowNormal;
+    else if (PrevPriority == THREAD_PRIORITY_NORMAL)
+        return ThreadPriority::Normal;
+    else if (PrevPriority == THREAD_PRIORITY_ABOVE_NORMAL)
+        return ThreadPriority::AboveNormal;
+    else
+        return ThreadPriority::Highest;
+}
+
+#if PLATFORM_WIN32
+namespace
+{
+
+// Large pages can only be allocated by processes that have the privilege enabled in their token.
+// The privilege must be granted to the user by the administrator.
+bool EnableLockMemoryPrivilege()
+{
+    HANDLE hToken = NULL;
+    if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &hToken))
+        return false;
+
+    TOKEN_PRIVILEGES Privileges = {};
+
+    Privileges.PrivilegeCount           = 1;
+    Privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    bool Enabled = false;
+    if (LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &Privileges.Privileges[0].Luid))
+    {
+        // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED if the user does not have the privilege
+        Enabled = AdjustTokenPrivileges(hToken, FALSE, &Privileges, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS;
+    }
+    CloseHandle(hToken);
+
+    return Enabled;
+}
+
+} // namespace
+#endif
+
+size_t WindowsMisc::GetLargePageSize()
+{
+#if PLATFORM_WIN32
+    static const size_t LargePageSize = EnableLockMemoryPrivilege() ? GetLargePageMinimum() : 0;
+    return LargePageSize;
+#else
+    // Large pages are not available to UWP applications
+    return BasicPlatformMisc::GetLargePageSize();
+#endif
+}
+
+void* WindowsMisc::AllocateLargePages(size_t Size)
+{
+#if PLATFORM_WIN32
+    const auto LargePageSize = GetLargePageSize();
+    if (LargePageSize == 0 || Size == 0 || Size % LargePageSize != 0)
+        return nullptr;
+
+    // Large pages must be reserved and committed at once. The allocation fails when
+    // the physical memory is too fragmented to find enough contiguous large pages.
+    return VirtualAlloc(nullptr, Size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+#else
+    return BasicPlatformMisc::AllocateLargePages(Size);
+#endif
+}
+
+void WindowsMisc::FreeLargePages(void* Ptr, size_t Size)
+{
+#if PLATFORM_WIN32
+    if (Ptr != nullptr)
+        VirtualFree(Ptr, 0, MEM_RELEASE);
+#else
+    BasicPlatformMisc::FreeLargePages(Ptr, Size);
+#endif
+}
@@ -60,6 +60,18 @@ DILIGENT_BEGIN_INTERFACE(IFileStream, IObject)
     VIRTUAL void METHOD(ReadBlob)(THIS_
                                   IDataBlob* pData) PURE;
 
+    /// Reads the remaining data from the stream into a new data blob
+
+    /// \param [out] ppData - Address of the memory location where the pointer to the
+    ///                       data blob will be written. The function calls AddRef(),
+    ///                       so the blob will have one reference.
+    ///
+    /// \remarks Unlike ReadBlob(), the blob is created by the stream, which allows
+    ///          implementations backed by a memory-mapped file to return a blob that
+    ///          references the mapping instead of copying the data.
+    VIRTUAL void METHOD(ReadBlob2)(THIS_
+                                   IDataBlob** ppData) PURE;
+
     /// Writes data to the stream
     VIRTUAL bool METHOD(Write)(THIS_
                                const void* Data, 
@@ -77,11 +89,12 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IFileStream_Read(This, ...)     CALL_IFACE_METHOD(FileStream, Read,     This, __VA_ARGS__)
-#    define IFileStream_ReadBlob(This, ...) CALL_IFACE_METHOD(FileStream, ReadBlob, This, __VA_ARGS__)
-#    define IFileStream_Write(This, ...)    CALL_IFACE_METHOD(FileStream, Write,    This, __VA_ARGS__)
-#    define IFileStream_GetSize(This)       CALL_IFACE_METHOD(FileStream, GetSize,  This)
-#    define IFileStream_IsValid(This)       CALL_IFACE_METHOD(FileStream, IsValid,  This)
+#    define IFileStream_Read(This, ...)      CALL_IFACE_METHOD(FileStream, Read,      This, __VA_ARGS__)
+#    define IFileStream_ReadBlob(This, ...)  CALL_IFACE_METHOD(FileStream, ReadBlob,  This, __VA_ARGS__)
+#    define IFileStream_ReadBlob2(This, ...) CALL_IFACE_METHOD(FileStream, ReadBlob2, This, __VA_ARGS__)
+#    define IFileStream_Write(This, ...)     CALL_IFACE_METHOD(FileStream, Write,     This, __VA_ARGS__)
+#    define IFileStream_GetSize(This)        CALL_IFACE_METHOD(FileStream, GetSize,   This)
+#    define IFileStream_IsValid(This)        CALL_IFACE_METHOD(FileStream, IsValid,   This)
 
 // clang-format on
 
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Pluggable CPU profiling hooks used to mark engine-internal work
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Profiler callback interface.
+
+/// An application implements this interface to route engine-internal CPU zones
+/// to an external profiler (Tracy, ETW, Perfetto, etc.).
+/// All methods may be called from any thread simultaneously.
+class IProfilerCallback
+{
+public:
+    /// Called when a zone is entered.
+
+    /// \param [in] Name     - Zone name. The string has static storage duration.
+    /// \param [in] Function - Name of the function the zone is located in.
+    /// \param [in] File     - Source file name.
+    /// \param [in] Line     - Source line number.
+    virtual void BeginZone(const Char* Name, const Char* Function, const Char* File, int Line) = 0;
+
+    /// Called when the innermost zone on the calling thread is exited.
+    virtual void EndZone() = 0;
+
+protected:
+    ~IProfilerCallback() {}
+};
+
+/// Current profiler callback; null if profiling is not enabled.
+extern IProfilerCallback* ProfilerCallback;
+
+/// Sets the profiler callback.
+
+/// \note The callback must be set before any engine objects are created and must stay alive
+///       until all of them are destroyed. Similar to SetDebugMessageCallback(), this function
+///       needs to be called for every executable module that should report its zones.
+///       Zones are only emitted when the engine is built with DILIGENT_PROFILING option enabled.
+void SetProfilerCallback(IProfilerCallback* pCallback);
+
+
+/// RAII helper that reports a zone to the profiler callback.
+class ProfileZone
+{
+public:
+    ProfileZone(const Char* Name, const Char* Function, const Char* File, int Line) :
+        m_pCallback{ProfilerCallback}
+    {
+        if (m_pCallback != nullptr)
+            m_pCallback->BeginZone(Name, Function, File, Line);
+    }
+
+    ~ProfileZone()
+    {
+        if (m_pCallback != nullptr)
+            m_pCallback->EndZone();
+    }
+
+    // clang-format off
+    ProfileZone           (const ProfileZone&)  = delete;
+    ProfileZone           (      ProfileZone&&) = delete;
+    ProfileZone& operator=(const ProfileZone&)  = delete;
+    ProfileZone& operator=(      ProfileZone&&) = delete;
+    // clang-format on
+
+private:
+    // Keep the callback captured at zone entry so that Begin/End calls are always balanced
+    IProfilerCallback* const m_pCallback;
+};
+
+} // namespace Diligent
+
+
+#ifdef DILIGENT_PROFILING
+
+// Two levels of indirection are required to concatenate expanded macros
+#    define DILIGENT_PROFILE_ZONE_NAME0(X, Y) X##Y
+#    define DILIGENT_PROFILE_ZONE_NAME(X, Y)  DILIGENT_PROFILE_ZONE_NAME0(X, Y)
+
+/// Marks the enclosing scope as a named profiler zone.
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        Diligent::ProfileZone DILIGENT_PROFILE_ZONE_NAME(_DiligentProfileZone, __LINE__)(Name, __FUNCTION__, __FILE__, __LINE__)
+
+#else
+
+#    define DILIGENT_PROFILE_SCOPE(Name) \
+        do                               \
+        {                                \
+        } while (false)
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IThreadPool interface
+
+#include "Object.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+
+/// Thread pool task callback. pUserData is the pointer passed to IThreadPool::EnqueueTask().
+typedef void (*ThreadPoolTaskCallbackType)(void* pUserData);
+
+/// Thread pool create information
+struct ThreadPoolCreateInfo
+{
+    /// The number of worker threads. If zero, the number of hardware threads minus one is used.
+    Uint32 NumThreads DEFAULT_INITIALIZER(0);
+};
+typedef struct ThreadPoolCreateInfo ThreadPoolCreateInfo;
+
+// {8AF6A9A4-C5C5-4D4B-9F1C-0B5C2E3D7A61}
+static const struct INTERFACE_ID IID_ThreadPool =
+    {0x8af6a9a4, 0xc5c5, 0x4d4b, {0x9f, 0x1c, 0xb, 0x5c, 0x2e, 0x3d, 0x7a, 0x61}};
+
+// clang-format off
+
+#define DILIGENT_INTERFACE_NAME IThreadPool
+#include "DefineInterfaceHelperMacros.h"
+
+#define IThreadPoolInclusiveMethods \
+    IObjectInclusiveMethods;        \
+    IThreadPoolMethods ThreadPool
+
+/// Pool of worker threads that the engine and the application share
+
+/// The pool uses work stealing: every worker thread owns a task queue, and a thread that
+/// runs out of work takes tasks from the other threads' queues. An application may create
+/// the pool with IEngineFactory::CreateThreadPool() and pass it to the engine through
+/// EngineCreateInfo::pAsyncTaskPool, so that the engine does not start its own worker threads.
+DILIGENT_BEGIN_INTERFACE(IThreadPool, IObject)
+{
+    /// Adds the task to the pool.
+
+    /// \param [in] Callback  - Function that will be called by one of the worker threads.
+    ///                         The function must not throw exceptions.
+    /// \param [in] pUserData - User data pointer that will be passed to the callback.
+    ///
+    /// \remarks    Tasks enqueued by a thread that is not a worker thread of the pool are started
+    ///             in FIFO order. Tasks enqueued by a worker thread are placed into that thread's
+    ///             own queue and may be stolen by other idle threads.
+    VIRTUAL void METHOD(EnqueueTask)(THIS_
+                                     ThreadPoolTaskCallbackType Callback,
+                                     void*                      pUserData) PURE;
+
+    /// Blocks until all tasks enqueued into the pool have finished executing.
+
+    /// \remarks    This method must not be called from a worker thread of the pool.
+    VIRTUAL void METHOD(WaitForAllTasks)(THIS) PURE;
+
+    /// Returns the number of worker threads in the pool.
+    VIRTUAL Uint32 METHOD(GetThreadCount)(THIS) CONST PURE;
+};
+DILIGENT_END_INTERFACE
+
+#include "UndefInterfaceHelperMacros.h"
+
+#if DILIGENT_C_INTERFACE
+
+// clang-format off
+
+#    define IThreadPool_EnqueueTask(This, ...)  CALL_IFACE_METHOD(ThreadPool, EnqueueTask,     This, __VA_ARGS__)
+#    define IThreadPool_WaitForAllTasks(This)   CALL_IFACE_METHOD(ThreadPool, WaitForAllTasks, This)
+#    define IThreadPool_GetThreadCount(This)    CALL_IFACE_METHOD(ThreadPool, GetThreadCount,  This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -56,6 +57,7 @@ public:
         Uint32             AdapterId                 = DEFAULT_ADAPTER_ID;
         Uint32             NumDeferredContexts       = 4;
         bool               ForceNonSeparablePrograms = false;
+        bool               UseVkDescriptorBuffer     = false;
     };
     TestingEnvironment(const CreateInfo& CI, const SwapChainDesc& SCDesc);
 
@@ -138,6 +140,17 @@ public:
 
     static void PushExpectedErrorSubstring(const char* Str, bool ClearStack = true);
 
+    // Modifies the create info of a dedicated device. The argument is EngineD3D11CreateInfo,
+    // EngineD3D12CreateInfo, EngineVkCreateInfo or EngineMtlCreateInfo depending on the device type.
+    using ModifyEngineCreateInfoType = std::function<void(EngineCreateInfo& EngineCI)>;
+
+    // Creates a separate device of the same type and on the same adapter as the testing device,
+    // with one immediate context. This is used to test engine create options that should not
+    // affect the other tests. OpenGL is not supported as the GL device is bound to the window.
+    void CreateDedicatedDevice(const ModifyEngineCreateInfoType& ModifyEngineCI,
+                               IRenderDevice**                   ppDevice,
+                               IDeviceContext**                  ppContext);
+
 protected:
     NativeWindow CreateNativeWindow();
 
@@ -154,6 +167,7 @@ protected:
     const RENDER_DEVICE_TYPE m_DeviceType;
 
     ADAPTER_TYPE m_AdapterType = ADAPTER_TYPE_UNKNOWN;
+    Uint32       m_AdapterId   = DEFAULT_ADAPTER_ID;
 
     // Any platform-specific data (e.g. window handle) that should
     // be cleaned-up when the testing environment object is destroyed.
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <sstream>
+
+#include "DefaultRawMemoryAllocator.hpp"
+#include "MapHelper.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Renders a number of frames after warm-up and verifies that none of them
+// allocates memory through the engine's raw memory allocator.
+// Note that the test can only detect allocations made by the engine when it shares
+// the allocator instance with the test executable (i.e. when the engine is linked statically).
+TEST(AllocationFreeFrameTest, SteadyState)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Allocation-free frame test buffer";
+    BuffDesc.uiSizeInBytes  = 256;
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    auto RenderFrame = [&](Uint32 Frame) {
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {static_cast<float>(Frame % 8) / 8.f, 0.25f, 0.5f, 1.0f};
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            MapHelper<Uint32> BuffData{pContext, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+            *BuffData = Frame;
+        }
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    };
+
+    // Let the engine allocate all pages, pools and queues it needs in the steady state
+    constexpr Uint32 NumWarmUpFrames = 16;
+    for (Uint32 Frame = 0; Frame < NumWarmUpFrames; ++Frame)
+        RenderFrame(Frame);
+
+    constexpr Uint32 NumFrames             = 32;
+    constexpr Uint64 FrameAllocationBudget = 0;
+
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+    RawAllocator.TakeRecordedCallSites();
+    RawAllocator.SetCallSiteRecordThreshold(static_cast<Uint32>(FrameAllocationBudget));
+    RawAllocator.EnableTracking(true);
+    RawAllocator.ResetTrackingPeriod();
+
+    for (Uint32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        RenderFrame(NumWarmUpFrames + Frame);
+
+        const auto Stats = RawAllocator.ResetTrackingPeriod();
+        EXPECT_LE(Stats.NumAllocations, FrameAllocationBudget)
+            << "Frame " << Frame << " made " << Stats.NumAllocations << " allocations (" << Stats.BytesAllocated << " bytes)";
+    }
+
+    RawAllocator.EnableTracking(false);
+    RawAllocator.SetCallSiteRecordThreshold(0);
+
+    const auto CallSites = RawAllocator.TakeRecordedCallSites();
+    if (!CallSites.empty())
+    {
+        std::stringstream ss;
+        ss << "Allocations made in the steady-state frame loop:";
+        for (const auto& CallSite : CallSites)
+        {
+            ss << "\n    " << CallSite.Size << " bytes: '" << CallSite.Description << "' at "
+               << CallSite.FileName << '(' << CallSite.LineNumber << ')';
+        }
+        ADD_FAILURE() << ss.str();
+    }
+}
+
+} // namespace
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "AsyncComputeScheduler.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(AsyncComputeSchedulerTest, GraphicsComputeDependencies)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    std::vector<IDeviceContext*> Contexts;
+    for (Uint32 i = 0; i < pEnv->GetNumImmediateContexts(); ++i)
+        Contexts.push_back(pEnv->GetDeviceContext(i));
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    AsyncComputeScheduler Scheduler{pDevice, Contexts.data(), static_cast<Uint32>(Contexts.size())};
+
+    const auto Graphics = Scheduler.FindQueue(COMMAND_QUEUE_TYPE_GRAPHICS);
+    const auto Compute  = Scheduler.FindQueue(COMMAND_QUEUE_TYPE_COMPUTE);
+    if (Graphics == AsyncComputeScheduler::InvalidQueueIndex || Compute == AsyncComputeScheduler::InvalidQueueIndex ||
+        Graphics == Compute)
+    {
+        GTEST_SKIP() << "Separate graphics and compute queues are not available";
+    }
+
+    constexpr Uint32 NumElements = 1024;
+
+    std::vector<Uint32> RefData(NumElements);
+    for (Uint32 i = 0; i < NumElements; ++i)
+        RefData[i] = i * 7 + 3;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name                 = "Async compute scheduler test buffer";
+    BuffDesc.BindFlags            = BIND_VERTEX_BUFFER;
+    BuffDesc.uiSizeInBytes        = NumElements * sizeof(Uint32);
+    BuffDesc.ImmediateContextMask = (Uint64{1} << Scheduler.GetContext(Graphics)->GetDesc().ContextId) |
+        (Uint64{1} << Scheduler.GetContext(Compute)->GetDesc().ContextId);
+
+    RefCntAutoPtr<IBuffer> pSrcBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pSrcBuffer);
+    ASSERT_NE(pSrcBuffer, nullptr);
+
+    RefCntAutoPtr<IBuffer> pDstBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pDstBuffer);
+    ASSERT_NE(pDstBuffer, nullptr);
+
+    BuffDesc.Name                 = "Async compute scheduler test staging buffer";
+    BuffDesc.BindFlags            = BIND_NONE;
+    BuffDesc.Usage                = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags       = CPU_ACCESS_READ;
+    BuffDesc.ImmediateContextMask = Uint64{1} << Scheduler.GetContext(Graphics)->GetDesc().ContextId;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    // Graphics: |- upload -|            |- readback -|
+    // Compute:              |- copy -|
+    Scheduler
+        .AddSubmission("Upload", Graphics,
+                       [&](IDeviceContext* pCtx) {
+                           pCtx->UpdateBuffer(pSrcBuffer, 0, BuffDesc.uiSizeInBytes, RefData.data(), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                       })
+        .Write(pSrcBuffer, RESOURCE_STATE_COPY_DEST);
+
+    Scheduler
+        .AddSubmission("Copy", Compute,
+                       [&](IDeviceContext* pCtx) {
+                           pCtx->CopyBuffer(pSrcBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                                            pDstBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                       })
+        .Read(pSrcBuffer, RESOURCE_STATE_COPY_SOURCE)
+        .Write(pDstBuffer, RESOURCE_STATE_COPY_DEST);
+
+    Scheduler
+        .AddSubmission("Readback", Graphics,
+                       [&](IDeviceContext* pCtx) {
+                           pCtx->CopyBuffer(pDstBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY,
+                                            pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                       })
+        .Read(pDstBuffer, RESOURCE_STATE_COPY_SOURCE);
+
+    Scheduler.Execute();
+
+    const auto& Stats = Scheduler.GetStatistics();
+    EXPECT_EQ(Stats.NumSubmissions, 3u);
+    // Copy waits for the upload, readback waits for the copy
+    EXPECT_EQ(Stats.NumWaits, 2u);
+    EXPECT_EQ(Stats.NumHandoffBarriers, 0u);
+
+    Scheduler.WaitForIdle();
+
+    auto* pGraphicsCtx = Scheduler.GetContext(Graphics);
+
+    void* pData = nullptr;
+    pGraphicsCtx->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    const auto* pValues = static_cast<const Uint32*>(pData);
+    for (Uint32 i = 0; i < NumElements; ++i)
+    {
+        if (pValues[i] != RefData[i])
+        {
+            ADD_FAILURE() << "Incorrect value at index " << i << ": " << pValues[i] << " (expected " << RefData[i] << ")";
+            break;
+        }
+    }
+    pGraphicsCtx->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    Scheduler.FinishFrame();
+}
+
+} // namespace
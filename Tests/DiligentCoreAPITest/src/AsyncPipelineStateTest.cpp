@@ -0,0 +1,216 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main() : SV_Position
+{
+    return float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+static const char* PSSource = R"(
+cbuffer Constants
+{
+    float4 g_Color;
+};
+
+float4 main() : SV_Target
+{
+    return g_Color;
+}
+)";
+
+static const char* CSSource = R"(
+RWTexture2D<float/* format=r32f */> g_RWTex;
+
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex[int2(0,0)] = 0.0;
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(SHADER_TYPE ShaderType, const char* Name, const char* Source)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = ShaderType;
+    ShaderCI.Desc.Name                  = Name;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+PIPELINE_STATE_STATUS WaitForPipeline(IPipelineState* pPSO)
+{
+    auto Status = pPSO->GetStatus();
+    while (Status == PIPELINE_STATE_STATUS_PENDING)
+    {
+        std::this_thread::yield();
+        Status = pPSO->GetStatus();
+    }
+    return Status;
+}
+
+TEST(AsyncPipelineStateTest, Graphics)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, "Async PSO test VS", VSSource);
+    ASSERT_NE(pVS, nullptr);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, "Async PSO test PS", PSSource);
+    ASSERT_NE(pPS, nullptr);
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        // The create info and all strings it references go out of scope before the pipeline is ready
+        std::string PSOName{"Async graphics PSO test"};
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = PSOName.c_str();
+        PSOCreateInfo.Flags        = PSO_CREATE_FLAG_ASYNCHRONOUS;
+
+        auto& GraphicsPipeline                        = PSOCreateInfo.GraphicsPipeline;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        std::string                VarName{"Constants"};
+        ShaderResourceVariableDesc Vars[] = {{SHADER_TYPE_PIXEL, VarName.c_str(), SHADER_RESOURCE_VARIABLE_TYPE_STATIC}};
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+    pVS.Release();
+    pPS.Release();
+
+    EXPECT_EQ(WaitForPipeline(pPSO), PIPELINE_STATE_STATUS_READY);
+    EXPECT_STREQ(pPSO->GetDesc().Name, "Async graphics PSO test");
+    EXPECT_EQ(pPSO->GetStaticVariableCount(SHADER_TYPE_PIXEL), 1u);
+    EXPECT_NE(pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "Constants"), nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB);
+    EXPECT_NE(pSRB, nullptr);
+}
+
+TEST(AsyncPipelineStateTest, Compute)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pCS = CreateTestShader(SHADER_TYPE_COMPUTE, "Async PSO test CS", CSSource);
+    ASSERT_NE(pCS, nullptr);
+
+    constexpr Uint32 NumPSOs = 16;
+
+    RefCntAutoPtr<IPipelineState> pPSOs[NumPSOs];
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Async compute PSO test";
+        PSOCreateInfo.Flags        = PSO_CREATE_FLAG_ASYNCHRONOUS;
+        PSOCreateInfo.pCS          = pCS;
+
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSOs[i]);
+        ASSERT_NE(pPSOs[i], nullptr);
+    }
+
+    // Release some of the pipelines before they are ready
+    for (Uint32 i = 0; i < NumPSOs; i += 2)
+        pPSOs[i].Release();
+
+    for (Uint32 i = 1; i < NumPSOs; i += 2)
+    {
+        EXPECT_EQ(WaitForPipeline(pPSOs[i]), PIPELINE_STATE_STATUS_READY);
+        EXPECT_GT(pPSOs[i]->GetResourceSignatureCount(), 0u);
+    }
+}
+
+TEST(AsyncPipelineStateTest, SynchronousIsAlwaysReady)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, "Async PSO test VS", VSSource);
+    ASSERT_NE(pVS, nullptr);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, "Async PSO test PS", PSSource);
+    ASSERT_NE(pPS, nullptr);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name = "Sync graphics PSO test";
+
+    auto& GraphicsPipeline                        = PSOCreateInfo.GraphicsPipeline;
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+    EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+}
+
+} // namespace
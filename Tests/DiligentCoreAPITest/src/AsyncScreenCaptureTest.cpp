@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "AsyncScreenCapture.hpp"
+
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct CapturedFrame
+{
+    Uint32                          Id = 0;
+    std::vector<std::vector<Uint8>> Planes;
+    std::vector<Uint32>             Strides;
+};
+
+// Collects the frames delivered by the worker threads
+class FrameCollector
+{
+public:
+    std::function<void(const AsyncScreenCaptureFrame&)> GetCallback()
+    {
+        return [this](const AsyncScreenCaptureFrame& Frame) {
+            CapturedFrame Captured;
+            Captured.Id = Frame.Id;
+            for (Uint32 p = 0; p < Frame.NumPlanes; ++p)
+            {
+                // Chroma planes have half the height of the padded luma plane
+                const auto NumRows = Frame.Format == ASYNC_SCREEN_CAPTURE_FORMAT_YUV420 ?
+                    (p == 0 ? (Frame.Height + 1) / 2 * 2 : (Frame.Height + 1) / 2) :
+                    Frame.Height;
+                Captured.Planes.emplace_back(Frame.pPlanes[p], Frame.pPlanes[p] + size_t{Frame.Strides[p]} * NumRows);
+                Captured.Strides.push_back(Frame.Strides[p]);
+            }
+
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            m_Frames.emplace_back(std::move(Captured));
+        };
+    }
+
+    std::vector<CapturedFrame> GetFrames()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        return m_Frames;
+    }
+
+private:
+    std::mutex                 m_Mtx;
+    std::vector<CapturedFrame> m_Frames;
+};
+
+RefCntAutoPtr<ITexture> CreateSourceTexture(Uint32 Width, Uint32 Height, BIND_FLAGS BindFlags, const std::vector<Uint32>& Pixels)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Async screen capture test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BindFlags;
+
+    TextureSubResData Mip0Data{Pixels.data(), Width * Uint32{sizeof(Uint32)}};
+    TextureData       InitData{&Mip0Data, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+class AsyncScreenCaptureTest : public testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+            GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+};
+
+TEST_F(AsyncScreenCaptureTest, RGBA8)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width  = 37;
+    constexpr Uint32 Height = 21;
+
+    FastRand            Rnd{0};
+    std::vector<Uint32> Pixels(Width * Height);
+    for (auto& Pixel : Pixels)
+        Pixel = (Rnd() << 16u) ^ Rnd();
+
+    auto pTexture = CreateSourceTexture(Width, Height, BIND_SHADER_RESOURCE, Pixels);
+    ASSERT_TRUE(pTexture);
+
+    FrameCollector Collector;
+
+    // The callback runs on a pool that may be shared with other tasks
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    pEnv->GetDevice()->GetEngineFactory()->CreateThreadPool(ThreadPoolCreateInfo{}, &pThreadPool);
+    ASSERT_TRUE(pThreadPool);
+
+    AsyncScreenCaptureCreateInfo CI;
+    CI.Format      = ASYNC_SCREEN_CAPTURE_FORMAT_RGBA8;
+    CI.Callback    = Collector.GetCallback();
+    CI.pThreadPool = pThreadPool;
+    AsyncScreenCapture Capture{pEnv->GetDevice(), CI};
+
+    EXPECT_TRUE(Capture.Capture(pContext, pTexture, 7));
+    Capture.Finish(pContext);
+
+    const auto Frames = Collector.GetFrames();
+    ASSERT_EQ(Frames.size(), size_t{1});
+    EXPECT_EQ(Frames[0].Id, 7u);
+    ASSERT_EQ(Frames[0].Planes.size(), size_t{1});
+    EXPECT_EQ(Frames[0].Strides[0], Width * 4);
+    ASSERT_EQ(Frames[0].Planes[0].size(), Pixels.size() * sizeof(Uint32));
+    EXPECT_EQ(memcmp(Frames[0].Planes[0].data(), Pixels.data(), Frames[0].Planes[0].size()), 0);
+}
+
+TEST_F(AsyncScreenCaptureTest, YUV420)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // The texture is not a shader resource, so it is copied to the intermediate texture.
+    // The size is not a multiple of the YUV block size to test padding.
+    constexpr Uint32 Width  = 30;
+    constexpr Uint32 Height = 15;
+
+    // Pure red
+    std::vector<Uint32> Pixels(Width * Height, 0xFF0000FFu);
+
+    auto pTexture = CreateSourceTexture(Width, Height, BIND_RENDER_TARGET, Pixels);
+    ASSERT_TRUE(pTexture);
+
+    FrameCollector Collector;
+
+    AsyncScreenCaptureCreateInfo CI;
+    CI.Format   = ASYNC_SCREEN_CAPTURE_FORMAT_YUV420;
+    CI.Callback = Collector.GetCallback();
+    AsyncScreenCapture Capture{pEnv->GetDevice(), CI};
+
+    EXPECT_TRUE(Capture.Capture(pContext, pTexture, 0));
+    Capture.Finish(pContext);
+
+    const auto Frames = Collector.GetFrames();
+    ASSERT_EQ(Frames.size(), size_t{1});
+    const auto& Frame = Frames[0];
+    ASSERT_EQ(Frame.Planes.size(), size_t{3});
+    EXPECT_EQ(Frame.Strides[0], 32u);
+    EXPECT_EQ(Frame.Strides[1], 16u);
+    EXPECT_EQ(Frame.Strides[2], 16u);
+
+    // BT.709 limited range values of pure red
+    constexpr int RefY = 63;
+    constexpr int RefU = 102;
+    constexpr int RefV = 240;
+
+    // Padded samples replicate the edge, so all samples must match
+    for (size_t p = 0; p < 3; ++p)
+    {
+        const int RefValue = p == 0 ? RefY : (p == 1 ? RefU : RefV);
+        for (size_t i = 0; i < Frame.Planes[p].size(); ++i)
+        {
+            const int Value = Frame.Planes[p][i];
+            ASSERT_NEAR(Value, RefValue, 1) << "Plane " << p << ", sample " << i;
+        }
+    }
+}
+
+TEST_F(AsyncScreenCaptureTest, MultipleFrames)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width     = 64;
+    constexpr Uint32 Height    = 32;
+    constexpr Uint32 NumFrames = 5;
+
+    std::vector<Uint32> Pixels(Width * Height, 0xFF808080u);
+
+    auto pTexture = CreateSourceTexture(Width, Height, BIND_SHADER_RESOURCE, Pixels);
+    ASSERT_TRUE(pTexture);
+
+    FrameCollector Collector;
+
+    AsyncScreenCaptureCreateInfo CI;
+    CI.RingSize         = NumFrames;
+    CI.NumWorkerThreads = 1;
+    CI.Callback         = Collector.GetCallback();
+    AsyncScreenCapture Capture{pEnv->GetDevice(), CI};
+
+    for (Uint32 i = 0; i < NumFrames; ++i)
+    {
+        EXPECT_TRUE(Capture.Capture(pContext, pTexture, i));
+        Capture.Update(pContext);
+    }
+    Capture.Finish(pContext);
+    EXPECT_EQ(Capture.GetNumDroppedFrames(), 0u);
+
+    // With a single worker thread, frames are delivered in capture order
+    const auto Frames = Collector.GetFrames();
+    ASSERT_EQ(Frames.size(), size_t{NumFrames});
+    for (Uint32 i = 0; i < NumFrames; ++i)
+        EXPECT_EQ(Frames[i].Id, i);
+}
+
+} // namespace
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "BLASCompactor.hpp"
+
+#include "TestingEnvironment.hpp"
+#include "RayTracingTestConstants.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(BLASCompactorTest, CompactTriangleBLAS)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Triangle vertices";
+        BuffDesc.Usage         = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = sizeof(Vertices);
+
+        BufferData BufData;
+        BufData.pData    = Vertices;
+        BufData.DataSize = sizeof(Vertices);
+
+        pDevice->CreateBuffer(BuffDesc, &BufData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangle";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = _countof(Vertices) / 3;
+
+    BottomLevelASDesc ASDesc;
+    ASDesc.Name          = "Compactable BLAS";
+    ASDesc.Flags         = RAYTRACING_BUILD_AS_ALLOW_COMPACTION;
+    ASDesc.pTriangles    = &TriangleDesc;
+    ASDesc.TriangleCount = 1;
+
+    RefCntAutoPtr<IBottomLevelAS> pBLAS;
+    pDevice->CreateBLAS(ASDesc, &pBLAS);
+    ASSERT_NE(pBLAS, nullptr);
+
+    RefCntAutoPtr<IBuffer> pScratchBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "BLAS Scratch Buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = static_cast<Uint32>(pBLAS->GetScratchBufferSizes().Build);
+
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pScratchBuffer);
+        ASSERT_NE(pScratchBuffer, nullptr);
+    }
+
+    BLASBuildTriangleData Triangle;
+    Triangle.GeometryName         = TriangleDesc.GeometryName;
+    Triangle.pVertexBuffer        = pVertexBuffer;
+    Triangle.VertexStride         = sizeof(Vertices[0]);
+    Triangle.VertexCount          = _countof(Vertices);
+    Triangle.VertexValueType      = VT_FLOAT32;
+    Triangle.VertexComponentCount = 3;
+    Triangle.PrimitiveCount       = _countof(Vertices) / 3;
+    Triangle.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    BuildBLASAttribs Attribs;
+    Attribs.pBLAS                       = pBLAS;
+    Attribs.BLASTransitionMode          = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.GeometryTransitionMode      = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    Attribs.pTriangleData               = &Triangle;
+    Attribs.TriangleDataCount           = 1;
+    Attribs.pScratchBuffer              = pScratchBuffer;
+    Attribs.ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    pContext->BuildBLAS(Attribs);
+
+    RefCntAutoPtr<IBottomLevelAS> pCompacted;
+
+    BLASCompactorCreateInfo CI;
+    CI.FrameDelay = 1;
+    CI.Callback   = [&](IBottomLevelAS* pOriginal, IBottomLevelAS* pCompactedBLAS) {
+        EXPECT_EQ(pOriginal, pBLAS.RawPtr());
+        pCompacted = pCompactedBLAS;
+    };
+    BLASCompactor Compactor{pDevice, CI};
+
+    EXPECT_TRUE(Compactor.Enqueue(pBLAS));
+    EXPECT_EQ(Compactor.GetNumPendingBLASes(), 1u);
+
+    // The compacted size is not queried until FrameDelay updates have passed
+    EXPECT_EQ(Compactor.Update(pContext), 0u);
+
+    Uint32 NumCompacted = 0;
+    for (Uint32 Frame = 0; Frame < 8 && NumCompacted == 0; ++Frame)
+    {
+        NumCompacted = Compactor.Update(pContext);
+        pContext->Flush();
+        pContext->WaitForIdle();
+    }
+    EXPECT_EQ(NumCompacted, 1u);
+    EXPECT_EQ(Compactor.GetNumPendingBLASes(), 0u);
+
+    ASSERT_NE(pCompacted, nullptr);
+    EXPECT_NE(pCompacted->GetDesc().CompactedSize, 0u);
+    EXPECT_EQ(Compactor.GetTotalCompactedSize(), pCompacted->GetDesc().CompactedSize);
+
+    // BLAS that does not allow compaction must be rejected
+    ASDesc.Name  = "Non-compactable BLAS";
+    ASDesc.Flags = RAYTRACING_BUILD_AS_NONE;
+    RefCntAutoPtr<IBottomLevelAS> pBLAS2;
+    pDevice->CreateBLAS(ASDesc, &pBLAS2);
+    ASSERT_NE(pBLAS2, nullptr);
+    EXPECT_FALSE(Compactor.Enqueue(pBLAS2));
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -126,6 +126,35 @@ TEST(BufferAccessTest, UpdateBufferData)
     VerifyBufferData(pBuffer);
 }
 
+// Small aligned updates may be recorded inline into the command buffer, while unaligned
+// ones go through the upload heap. Both paths must produce the same buffer contents.
+TEST(BufferAccessTest, UpdateBufferDataPartial)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Test default buffer";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.uiSizeInBytes = sizeof(TestBufferData);
+    BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr) << "Buffer desc:\n"
+                                << BuffDesc;
+
+    const auto* pData = reinterpret_cast<const Uint8*>(TestBufferData);
+    pContext->UpdateBuffer(pBuffer, 0, 16, pData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->UpdateBuffer(pBuffer, 16, 2, pData + 16, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->UpdateBuffer(pBuffer, 18, BuffDesc.uiSizeInBytes - 18, pData + 18, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    VerifyBufferData(pBuffer);
+}
+
 TEST(BufferAccessTest, MapWriteDiscard)
 {
     auto* pEnv     = TestingEnvironment::GetInstance();
@@ -425,4 +425,43 @@ TEST_F(BufferCreationTest, CreateUnifiedBuffer)
     }
 }
 
+TEST_F(BufferCreationTest, CreateDeviceAddressBuffer)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    if (!pDevice->GetDeviceInfo().Features.BufferDeviceAddress)
+    {
+        GTEST_SKIP() << "Buffer device address is not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Device address buffer";
+    BuffDesc.uiSizeInBytes     = 256;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode              = BUFFER_MODE_RAW;
+    BuffDesc.ElementByteStride = 4;
+    BuffDesc.MiscFlags         = MISC_BUFFER_FLAG_DEVICE_ADDRESS;
+
+    RefCntAutoPtr<IBuffer> pBuffer0;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer0);
+    ASSERT_NE(pBuffer0, nullptr) << GetObjectDescString(BuffDesc);
+
+    BuffDesc.Usage = USAGE_IMMUTABLE;
+    std::vector<Uint8> DummyData(BuffDesc.uiSizeInBytes);
+    BufferData         InitData{DummyData.data(), BuffDesc.uiSizeInBytes};
+
+    RefCntAutoPtr<IBuffer> pBuffer1;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer1);
+    ASSERT_NE(pBuffer1, nullptr) << GetObjectDescString(BuffDesc);
+
+    const auto Address0 = pBuffer0->GetDeviceAddress();
+    const auto Address1 = pBuffer1->GetDeviceAddress();
+    EXPECT_NE(Address0, Uint64{0});
+    EXPECT_NE(Address1, Uint64{0});
+    EXPECT_NE(Address0, Address1);
+}
+
 } // namespace
@@ -30,9 +30,12 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <atomic>
+#include <utility>
 
 #include "TestingEnvironment.hpp"
 #include "FastRand.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -149,4 +152,184 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, Compact)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    for (bool UseTLSFManager : {false, true})
+    {
+        BufferSuballocatorCreateInfo CI;
+        CI.Desc.Name          = "Buffer Suballocator Compaction Test";
+        CI.Desc.BindFlags     = BIND_VERTEX_BUFFER;
+        CI.Desc.uiSizeInBytes = 1024;
+        CI.UseTLSFManager     = UseTLSFManager;
+
+        RefCntAutoPtr<IBufferSuballocator> pAllocator;
+        CreateBufferSuballocator(pDevice, CI, &pAllocator);
+        ASSERT_TRUE(pAllocator);
+
+        std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(256);
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            pAllocator->Allocate(static_cast<Uint32>(16 + i % 7 * 8), i % 2 == 0 ? 16 : 4, &Allocs[i]);
+            ASSERT_TRUE(Allocs[i]);
+        }
+        EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+
+        // Fragment the buffer
+        Uint32 LiveSize = 0;
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            if (i % 3 != 0)
+                Allocs[i].Release();
+            else
+                LiveSize += Allocs[i]->GetSize();
+        }
+
+        const auto Version  = pAllocator->GetVersion();
+        const auto OrigSize = pAllocator->GetBuffer(pDevice, pContext)->GetDesc().uiSizeInBytes;
+
+        pAllocator->Compact(pDevice, pContext);
+        EXPECT_GT(pAllocator->GetVersion(), Version);
+
+        auto* pBuffer = pAllocator->GetBuffer(pDevice, pContext);
+        ASSERT_NE(pBuffer, nullptr);
+        const auto NewSize = pBuffer->GetDesc().uiSizeInBytes;
+        EXPECT_LT(NewSize, OrigSize);
+        EXPECT_GE(NewSize, LiveSize);
+
+        std::vector<std::pair<Uint32, Uint32>> Ranges;
+        for (size_t i = 0; i < Allocs.size(); ++i)
+        {
+            if (!Allocs[i])
+                continue;
+            EXPECT_EQ(Allocs[i]->GetOffset() % (i % 2 == 0 ? 16 : 4), 0u);
+            EXPECT_LE(Allocs[i]->GetOffset() + Allocs[i]->GetSize(), NewSize);
+            Ranges.emplace_back(Allocs[i]->GetOffset(), Allocs[i]->GetOffset() + Allocs[i]->GetSize());
+        }
+        std::sort(Ranges.begin(), Ranges.end());
+        for (size_t i = 1; i < Ranges.size(); ++i)
+            EXPECT_LE(Ranges[i - 1].second, Ranges[i].first) << "Suballocations overlap";
+
+        // The layout is already dense
+        const auto CompactVersion = pAllocator->GetVersion();
+        pAllocator->Compact(pDevice, pContext);
+        EXPECT_EQ(pAllocator->GetVersion(), CompactVersion);
+
+        // The allocator must still work after compaction
+        RefCntAutoPtr<IBufferSuballocation> pAlloc;
+        pAllocator->Allocate(512, 16, &pAlloc);
+        EXPECT_TRUE(pAlloc);
+        EXPECT_NE(pAllocator->GetBuffer(pDevice, pContext), nullptr);
+    }
+}
+
+// Compares the locked allocation path with the slab front end and verifies
+// that concurrent suballocations are properly aligned and do not overlap
+TEST(BufferSuballocatorTest, SlabStress)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+#ifdef _DEBUG
+    constexpr Uint32 NumAllocationsPerThread = 1024;
+#else
+    constexpr Uint32 NumAllocationsPerThread = 8192;
+#endif
+    const Uint32 NumThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    for (Uint32 SlabSize : {0u, 16384u})
+    {
+        BufferSuballocatorCreateInfo CI;
+        CI.Desc.Name             = "Buffer Suballocator Slab Test";
+        CI.Desc.BindFlags        = BIND_VERTEX_BUFFER;
+        CI.Desc.uiSizeInBytes    = 65536;
+        CI.SlabSize              = SlabSize;
+        CI.MaxSlabAllocationSize = 512;
+        CI.MaxSlabThreads        = NumThreads;
+
+        RefCntAutoPtr<IBufferSuballocator> pAllocator;
+        CreateBufferSuballocator(pDevice, CI, &pAllocator);
+        ASSERT_TRUE(pAllocator);
+
+        std::vector<std::vector<RefCntAutoPtr<IBufferSuballocation>>> pSubAllocations(NumThreads);
+        for (auto& Allocs : pSubAllocations)
+            Allocs.resize(NumAllocationsPerThread);
+
+        std::atomic<bool> Failed{false};
+
+        Timer T;
+        {
+            std::vector<std::thread> Threads;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&](Uint32 thread_id) //
+                    {
+                        // Mostly small allocations with occasional large ones that take the locked path
+                        FastRandInt rnd{thread_id, 1, 1023};
+                        for (auto& Alloc : pSubAllocations[thread_id])
+                        {
+                            const auto Size      = static_cast<Uint32>(rnd() % 64 == 0 ? rnd() * 4 : rnd() / 4 + 1);
+                            const auto Alignment = 1u << (rnd() % 5);
+                            pAllocator->Allocate(Size, Alignment, &Alloc);
+                            if (!Alloc || Alloc->GetSize() != Size || (Alloc->GetOffset() % Alignment) != 0)
+                                Failed.store(true);
+                        }
+                    },
+                    t);
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+        }
+        const auto ElapsedTime = T.GetElapsedTime();
+        ASSERT_FALSE(Failed.load());
+
+        const auto NumAllocations = size_t{NumThreads} * NumAllocationsPerThread;
+        LOG_INFO_MESSAGE(SlabSize != 0 ? "Slab" : "Locked", " allocator, ", NumThreads, " thread(s): ", NumAllocations,
+                         " allocations in ", ElapsedTime * 1000.0, " ms (", ElapsedTime * 1e+9 / static_cast<double>(NumAllocations),
+                         " ns per allocation)");
+
+        {
+            std::vector<std::pair<Uint32, Uint32>> Ranges;
+            Ranges.reserve(NumAllocations);
+            for (const auto& Allocs : pSubAllocations)
+            {
+                for (const auto& Alloc : Allocs)
+                    Ranges.emplace_back(Alloc->GetOffset(), Alloc->GetOffset() + Alloc->GetSize());
+            }
+            std::sort(Ranges.begin(), Ranges.end());
+            for (size_t i = 1; i < Ranges.size(); ++i)
+                EXPECT_LE(Ranges[i - 1].second, Ranges[i].first) << "Suballocations overlap";
+        }
+
+        auto* pBuffer = pAllocator->GetBuffer(pDevice, pContext);
+        EXPECT_NE(pBuffer, nullptr);
+
+        {
+            // Release suballocations from other threads than the ones that allocated them
+            std::vector<std::thread> Threads;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&](Uint32 thread_id) //
+                    {
+                        for (auto& Alloc : pSubAllocations[(thread_id + 1) % NumThreads])
+                            Alloc.Release();
+                    },
+                    t);
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+        }
+    }
+}
+
 } // namespace
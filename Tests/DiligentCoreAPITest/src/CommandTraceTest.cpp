@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "CommandTrace.hpp"
+#include "TestingEnvironment.hpp"
+#include "TestingSwapChainBase.hpp"
+
+#include "gtest/gtest.h"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+void RenderDrawCommandReference(ISwapChain* pSwapChain, const float* pClearColor);
+
+} // namespace Testing
+
+} // namespace Diligent
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#include "InlineShaders/DrawCommandTestHLSL.h"
+
+namespace
+{
+
+TEST(CommandTraceTest, RecordAndReplay)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    constexpr float ClearColor[] = {0.625f, 0.25f, 0.375f, 1.0f};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "Command trace test";
+
+    PSODesc.PipelineType                          = PIPELINE_TYPE_GRAPHICS;
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.EntryPoint      = "main";
+        ShaderCI.Desc.Name       = "Command trace test vertex shader";
+        ShaderCI.Source          = HLSL::DrawTest_ProceduralTriangleVS.c_str();
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.EntryPoint      = "main";
+        ShaderCI.Desc.Name       = "Command trace test pixel shader";
+        ShaderCI.Source          = HLSL::DrawTest_PS.c_str();
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+    }
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    enum OBJECT_ID : Uint32
+    {
+        OBJECT_ID_RTV = 1,
+        OBJECT_ID_PSO
+    };
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+
+    RefCntAutoPtr<IDataBlob> pTrace;
+    {
+        CommandStream Stream;
+        Stream.SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Stream.ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Stream.SetPipelineState(pPSO);
+        Stream.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 0});
+        Stream.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 3});
+
+        CommandTraceRecorder Recorder;
+        // The stream uses the PSO that has no id yet
+        Recorder.SetObjectId(pRTVs[0], OBJECT_ID_RTV);
+        EXPECT_FALSE(Recorder.RecordFrame(Stream));
+        EXPECT_EQ(Recorder.GetFrameCount(), 0u);
+
+        Recorder.SetObjectId(pPSO, OBJECT_ID_PSO);
+        EXPECT_TRUE(Recorder.RecordFrame(Stream));
+        EXPECT_EQ(Recorder.GetFrameCount(), 1u);
+
+        Recorder.GetTrace(&pTrace);
+        ASSERT_NE(pTrace, nullptr);
+    }
+
+    CommandTracePlayer Player{pDevice};
+    Player.SetObject(OBJECT_ID_RTV, pRTVs[0]);
+    // The PSO is not registered
+    EXPECT_FALSE(Player.Load(pTrace->GetConstDataPtr(), pTrace->GetSize()));
+
+    Player.SetObject(OBJECT_ID_PSO, pPSO);
+    // Truncated trace
+    EXPECT_FALSE(Player.Load(pTrace->GetConstDataPtr(), pTrace->GetSize() - 1));
+
+    ASSERT_TRUE(Player.Load(pTrace->GetConstDataPtr(), pTrace->GetSize()));
+    ASSERT_EQ(Player.GetFrameCount(), 1u);
+
+    const auto Stats = Player.ReplayFrame(pContext, 0);
+    EXPECT_GE(Stats.CPUTime, 0.0);
+    EXPECT_GE(Stats.GPUTime, 0.0);
+
+    pSwapChain->Present();
+}
+
+} // namespace
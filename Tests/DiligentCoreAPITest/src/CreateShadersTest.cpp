@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* PSSource = R"(
+float4 main() : SV_Target
+{
+    return float4(COLOR_R, 0.0, 0.0, 1.0);
+}
+)";
+
+TEST(CreateShadersTest, Parallel)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 NumShaders = 64;
+
+    // Every shader is a separate permutation that defines its own COLOR_R value
+    std::vector<std::string>                MacroValues(NumShaders);
+    std::vector<std::array<ShaderMacro, 2>> Macros(NumShaders);
+    std::vector<ShaderCreateInfo>           ShaderCIs(NumShaders);
+    std::vector<RefCntAutoPtr<IShader>>     pShaders(NumShaders);
+    std::vector<IShader*>                   ppShaders(NumShaders);
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        MacroValues[i] = std::to_string(static_cast<float>(i) / static_cast<float>(NumShaders));
+        Macros[i]      = {ShaderMacro{"COLOR_R", MacroValues[i].c_str()}, ShaderMacro{}};
+
+        auto& ShaderCI                      = ShaderCIs[i];
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name                  = "Parallel shader creation test PS";
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Source                     = PSSource;
+        ShaderCI.Macros                     = Macros[i].data();
+    }
+
+    pDevice->CreateShaders(ShaderCIs.data(), NumShaders, ppShaders.data());
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        pShaders[i].Attach(ppShaders[i]);
+        EXPECT_NE(pShaders[i], nullptr) << "Shader " << i << " was not created";
+    }
+}
+
+TEST(CreateShadersTest, Empty)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    // Must be a no-op
+    pDevice->CreateShaders(nullptr, 0, nullptr);
+}
+
+} // namespace
@@ -0,0 +1,192 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position)
+{
+    float2 UV = float2((VertId << 1) & 2, VertId & 2);
+    Pos = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return float4(0.0, 1.0, 0.0, 1.0);
+}
+)";
+
+class PipelineStateCacheD3D12Test : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+            return;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "PSO cache test VS";
+        ShaderCI.Source          = VSSource;
+        pDevice->CreateShader(ShaderCI, &sm_pVS);
+        ASSERT_NE(sm_pVS, nullptr);
+
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "PSO cache test PS";
+        ShaderCI.Source          = PSSource;
+        pDevice->CreateShader(ShaderCI, &sm_pPS);
+        ASSERT_NE(sm_pPS, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pVS.Release();
+        sm_pPS.Release();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+        {
+            GTEST_SKIP() << "This test requires a Direct3D12 device";
+        }
+    }
+
+    static RefCntAutoPtr<IPipelineStateCache> CreateCache(IDataBlob* pData)
+    {
+        PipelineStateCacheCreateInfo CacheCI;
+        CacheCI.Desc.Name = "PSO cache test";
+        if (pData != nullptr)
+        {
+            CacheCI.pCacheData    = pData->GetConstDataPtr();
+            CacheCI.CacheDataSize = static_cast<Uint32>(pData->GetSize());
+        }
+
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        TestingEnvironment::GetInstance()->GetDevice()->CreatePipelineStateCache(CacheCI, &pCache);
+        return pCache;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(IPipelineStateCache* pCache, const char* Name, TEXTURE_FORMAT RTVFormat)
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSOCreateInfo.PSODesc.Name                    = Name;
+        PSOCreateInfo.pPSOCache                       = pCache;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = RTVFormat;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PSOCreateInfo.pVS = sm_pVS;
+        PSOCreateInfo.pPS = sm_pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static RefCntAutoPtr<IDataBlob> GetCacheData(IPipelineStateCache* pCache)
+    {
+        RefCntAutoPtr<IDataBlob> pData;
+        pCache->GetData(&pData);
+        return pData;
+    }
+
+    static RefCntAutoPtr<IShader> sm_pVS;
+    static RefCntAutoPtr<IShader> sm_pPS;
+};
+
+RefCntAutoPtr<IShader> PipelineStateCacheD3D12Test::sm_pVS;
+RefCntAutoPtr<IShader> PipelineStateCacheD3D12Test::sm_pPS;
+
+// Unnamed pipelines are given a unique name in every run. They must be found in
+// the cache restored from the serialized data instead of being stored again.
+TEST_F(PipelineStateCacheD3D12Test, UnnamedPipeline)
+{
+    auto pCache = CreateCache(nullptr);
+    ASSERT_NE(pCache, nullptr);
+    ASSERT_NE(CreatePSO(pCache, nullptr, TEX_FORMAT_RGBA8_UNORM), nullptr);
+    auto pData = GetCacheData(pCache);
+    ASSERT_NE(pData, nullptr);
+
+    auto pRestoredCache = CreateCache(pData);
+    ASSERT_NE(pRestoredCache, nullptr);
+    ASSERT_NE(CreatePSO(pRestoredCache, nullptr, TEX_FORMAT_RGBA8_UNORM), nullptr);
+    auto pRestoredData = GetCacheData(pRestoredCache);
+    ASSERT_NE(pRestoredData, nullptr);
+
+    EXPECT_EQ(pRestoredData->GetSize(), pData->GetSize());
+}
+
+// Pipelines with the same name that differ in state must both be stored in the cache.
+TEST_F(PipelineStateCacheD3D12Test, SameNameDifferentState)
+{
+    static constexpr char PSOName[] = "PSO cache test PSO";
+
+    auto pCache = CreateCache(nullptr);
+    ASSERT_NE(pCache, nullptr);
+    ASSERT_NE(CreatePSO(pCache, PSOName, TEX_FORMAT_RGBA8_UNORM), nullptr);
+    auto pDataA = GetCacheData(pCache);
+    ASSERT_NE(pDataA, nullptr);
+
+    ASSERT_NE(CreatePSO(pCache, PSOName, TEX_FORMAT_RGBA16_FLOAT), nullptr);
+    auto pDataAB = GetCacheData(pCache);
+    ASSERT_NE(pDataAB, nullptr);
+    EXPECT_GT(pDataAB->GetSize(), pDataA->GetSize());
+
+    // Both pipelines must be loaded from the restored cache
+    auto pRestoredCache = CreateCache(pDataAB);
+    ASSERT_NE(pRestoredCache, nullptr);
+    ASSERT_NE(CreatePSO(pRestoredCache, PSOName, TEX_FORMAT_RGBA16_FLOAT), nullptr);
+    ASSERT_NE(CreatePSO(pRestoredCache, PSOName, TEX_FORMAT_RGBA8_UNORM), nullptr);
+    auto pRestoredData = GetCacheData(pRestoredCache);
+    ASSERT_NE(pRestoredData, nullptr);
+    EXPECT_EQ(pRestoredData->GetSize(), pDataAB->GetSize());
+}
+
+} // namespace
@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* CSSource = R"(
+StructuredBuffer<uint>   g_Input;
+RWStructuredBuffer<uint> g_Output;
+
+[numthreads(64, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_Output[DTid.x] = g_Input[DTid.x] + 1;
+}
+)";
+
+static constexpr Uint32 NumValues  = 64;
+static constexpr Uint32 NumBuffers = 4;
+
+RefCntAutoPtr<IBuffer> CreateStructuredBuffer(IRenderDevice* pDevice, const char* Name, BIND_FLAGS BindFlags, const Uint32* pData)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = Name;
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BindFlags;
+    BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+    BuffDesc.uiSizeInBytes     = sizeof(Uint32) * NumValues;
+
+    BufferData InitData{pData, BuffDesc.uiSizeInBytes};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, pData != nullptr ? &InitData : nullptr, &pBuffer);
+    return pBuffer;
+}
+
+void VerifyOutput(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pOutput, Uint32 RefValue)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Residency management test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = sizeof(Uint32) * NumValues;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        EXPECT_EQ(static_cast<const Uint32*>(pData)[i], RefValue + i) << "Value " << i;
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+}
+
+// Runs several frames on a device with residency management enabled and a budget that is
+// always exceeded, so that every resource not used by the last frame is evicted at the end of
+// each frame. Evicted resources must be made resident again when they are used later.
+TEST(ResidencyManagementD3D12Test, EvictAndMakeResident)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (pEnv->GetDevice()->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        GTEST_SKIP() << "This test requires a Direct3D12 device";
+    }
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    pEnv->CreateDedicatedDevice(
+        [](EngineCreateInfo& EngineCI) {
+            auto& EngineD3D12CI                       = static_cast<EngineD3D12CreateInfo&>(EngineCI);
+            EngineD3D12CI.EnableResidencyManagement   = true;
+            EngineD3D12CI.ResidencyEvictionFrameCount = 1;
+            EngineD3D12CI.ResidencyMemoryBudget       = 1;
+        },
+        &pDevice, &pContext);
+    ASSERT_NE(pDevice, nullptr);
+    ASSERT_NE(pContext, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "Residency management test CS";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = CSSource;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    const ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "g_Input", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_COMPUTE, "g_Output", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        };
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                        = "Residency management test PSO";
+    PSOCreateInfo.PSODesc.PipelineType                = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+    PSOCreateInfo.pCS                                 = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IBuffer>                pInputs[NumBuffers];
+    RefCntAutoPtr<IBuffer>                pOutputs[NumBuffers];
+    RefCntAutoPtr<IShaderResourceBinding> pSRBs[NumBuffers];
+    for (Uint32 b = 0; b < NumBuffers; ++b)
+    {
+        Uint32 InputData[NumValues];
+        for (Uint32 i = 0; i < NumValues; ++i)
+            InputData[i] = b * 1000 + i;
+
+        pInputs[b]  = CreateStructuredBuffer(pDevice, "Residency management test input", BIND_SHADER_RESOURCE, InputData);
+        pOutputs[b] = CreateStructuredBuffer(pDevice, "Residency management test output", BIND_UNORDERED_ACCESS, nullptr);
+        ASSERT_TRUE(pInputs[b] && pOutputs[b]);
+
+        pPSO->CreateShaderResourceBinding(&pSRBs[b], true);
+        ASSERT_NE(pSRBs[b], nullptr);
+        pSRBs[b]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Input")->Set(pInputs[b]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        pSRBs[b]->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutputs[b]->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+    }
+
+    auto Dispatch = [&](Uint32 b) //
+    {
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRBs[b], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+
+    // Only the first two buffer pairs are used, so the others are evicted once the frames
+    // in which they were created have been completed by the GPU.
+    for (Uint32 Frame = 0; Frame < 8; ++Frame)
+    {
+        Dispatch(Frame % 2);
+        pContext->Flush();
+        if (Frame % 4 == 3)
+            pContext->WaitForIdle();
+        pDevice->ReleaseStaleResources();
+    }
+
+    // Evicted resources, as well as the resources used by the last frames, must be resident when used
+    for (Uint32 b = 0; b < NumBuffers; ++b)
+        Dispatch(b);
+    for (Uint32 b = 0; b < NumBuffers; ++b)
+        VerifyOutput(pDevice, pContext, pOutputs[b], b * 1000 + 1);
+
+    // The outputs were evicted while unused and must keep their contents when made resident again
+    pContext->Flush();
+    pContext->WaitForIdle();
+    pDevice->ReleaseStaleResources();
+    pContext->WaitForIdle();
+    pDevice->ReleaseStaleResources();
+    for (Uint32 b = 0; b < NumBuffers; ++b)
+        VerifyOutput(pDevice, pContext, pOutputs[b], b * 1000 + 1);
+}
+
+} // namespace
@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+#include "GraphicsAccessories.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Helper objects are created when they are used for the first time. Other tests may have
+// used them already, so the test only checks that they are reported once they are used.
+TEST(DeviceHelperStatisticsTest, CreatedOnFirstUse)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& DevInfo = pDevice->GetDeviceInfo();
+    if (!DevInfo.IsVulkanDevice() && DevInfo.Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        GTEST_SKIP() << "Helper statistics are only reported by Vulkan and Direct3D12 backends";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Helper statistics test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.MipLevels = 4;
+        TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+
+        RefCntAutoPtr<ITexture> pTex;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+        ASSERT_NE(pTex, nullptr);
+        pContext->GenerateMips(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    }
+
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Helper statistics test buffer";
+        BuffDesc.uiSizeInBytes  = 256;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+
+        RefCntAutoPtr<IBuffer> pBuff;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuff);
+        ASSERT_NE(pBuff, nullptr);
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pBuff, MAP_WRITE, MAP_FLAG_DISCARD, pData);
+        ASSERT_NE(pData, nullptr);
+        pContext->UnmapBuffer(pBuff, MAP_WRITE);
+    }
+
+    const bool TestQueries = DevInfo.Features.TimestampQueries;
+    if (TestQueries)
+    {
+        RefCntAutoPtr<IQuery> pQuery;
+        pDevice->CreateQuery(QueryDesc{QUERY_TYPE_TIMESTAMP}, &pQuery);
+        ASSERT_NE(pQuery, nullptr);
+        pContext->EndQuery(pQuery);
+        pContext->Flush();
+    }
+
+    RenderDeviceMemoryStatistics MemStats;
+    pDevice->GetMemoryStatistics(MemStats);
+
+    const auto& Helpers = MemStats.Helpers;
+    EXPECT_GT(Helpers.NumMipGenerationPSOs, 0u);
+    EXPECT_GT(Helpers.DynamicHeapSize, 0u);
+    if (TestQueries)
+    {
+        EXPECT_GT(Helpers.NumQueryHeaps, 0u);
+        EXPECT_GT(Helpers.NumQueries, 0u);
+    }
+
+    LOG_INFO_MESSAGE("Device helper statistics:"
+                     "\n    Mip generation PSOs:    ", Helpers.NumMipGenerationPSOs,
+                     "\n    Mip generation buffers: ", FormatMemorySize(Helpers.MipGenerationBufferSize, 2),
+                     "\n    Query heaps:            ", Helpers.NumQueryHeaps, " (", Helpers.NumQueries, " queries)",
+                     "\n    Query resolve buffer:   ", FormatMemorySize(Helpers.QueryResolveBufferSize, 2),
+                     "\n    Dynamic heap:           ", FormatMemorySize(Helpers.DynamicHeapSize, 2));
+}
+
+} // namespace
@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Reports how long it took to initialize the device that the tests run on.
+// Run the tests with different backends to compare their startup times.
+TEST(DeviceInitStatisticsTest, Phases)
+{
+    auto*       pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    const auto& DevInfo = pDevice->GetDeviceInfo();
+    if (DevInfo.IsMetalDevice())
+    {
+        GTEST_SKIP() << "Device initialization statistics are not supported by Metal backend";
+    }
+
+    const auto& Stats = DevInfo.InitStats;
+    EXPECT_GE(Stats.InstanceTime, 0.f);
+    EXPECT_GE(Stats.DeviceTime, 0.f);
+    EXPECT_GT(Stats.RenderDeviceTime, 0.f);
+    EXPECT_GE(Stats.ContextsTime, 0.f);
+
+    const auto PhasesTime = Stats.InstanceTime + Stats.DeviceTime + Stats.RenderDeviceTime + Stats.ContextsTime;
+    // Allow for rounding errors
+    EXPECT_LE(PhasesTime, Stats.TotalTime * 1.001f + 0.001f);
+
+    LOG_INFO_MESSAGE("Device initialization took ", Stats.TotalTime, " ms:"
+                     "\n    Instance:      ", Stats.InstanceTime, " ms",
+                     "\n    Device:        ", Stats.DeviceTime, " ms",
+                     "\n    Render device: ", Stats.RenderDeviceTime, " ms",
+                     "\n    Contexts:      ", Stats.ContextsTime, " ms",
+                     "\n    Other:         ", Stats.TotalTime - PhasesTime, " ms");
+}
+
+} // namespace
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(DeviceNodesTest, NodeCount)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto& DevInfo     = pDevice->GetDeviceInfo();
+    const auto& AdapterInfo = pDevice->GetAdapterInfo();
+
+    EXPECT_GE(DevInfo.NumNodes, 1u);
+    EXPECT_LE(DevInfo.NumNodes, AdapterInfo.NumNodes);
+    if (!DevInfo.IsVulkanDevice() && DevInfo.Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        EXPECT_EQ(DevInfo.NumNodes, 1u);
+    }
+}
+
+// Resources used by every immediate context must be created on any node configuration
+TEST(DeviceNodesTest, CreateResourcesForAllContexts)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const Uint64 AllContextsMask = (Uint64{1} << pEnv->GetNumImmediateContexts()) - 1;
+
+    const Uint32 Data[64] = {};
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name                 = "Device nodes test buffer";
+    BuffDesc.uiSizeInBytes        = sizeof(Data);
+    BuffDesc.BindFlags            = BIND_SHADER_RESOURCE;
+    BuffDesc.Mode                 = BUFFER_MODE_RAW;
+    BuffDesc.Usage                = USAGE_DEFAULT;
+    BuffDesc.ImmediateContextMask = AllContextsMask;
+
+    BufferData BuffData{Data, sizeof(Data)};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &BuffData, &pBuffer);
+    EXPECT_NE(pBuffer, nullptr);
+
+    TextureDesc TexDesc;
+    TexDesc.Name                 = "Device nodes test texture";
+    TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+    TexDesc.Format               = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width                = 64;
+    TexDesc.Height               = 64;
+    TexDesc.BindFlags            = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+    TexDesc.ImmediateContextMask = AllContextsMask;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    EXPECT_NE(pTexture, nullptr);
+}
+
+} // namespace
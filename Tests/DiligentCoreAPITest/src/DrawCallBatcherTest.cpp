@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "DrawCallBatcher.hpp"
+#include "TestingEnvironment.hpp"
+#include "TestingSwapChainBase.hpp"
+
+#include "gtest/gtest.h"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+void RenderDrawCommandReference(ISwapChain* pSwapChain, const float* pClearColor);
+
+} // namespace Testing
+
+} // namespace Diligent
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+#include "InlineShaders/DrawCommandTestHLSL.h"
+
+namespace
+{
+
+class DrawCallBatcherTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pDevice    = pEnv->GetDevice();
+        auto* pSwapChain = pEnv->GetSwapChain();
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Draw call batcher test - procedural triangles";
+
+        PSODesc.PipelineType                          = PIPELINE_TYPE_GRAPHICS;
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Draw call batcher test vertex shader";
+            ShaderCI.Source          = HLSL::DrawTest_ProceduralTriangleVS.c_str();
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.EntryPoint      = "main";
+            ShaderCI.Desc.Name       = "Draw call batcher test pixel shader";
+            ShaderCI.Source          = HLSL::DrawTest_PS.c_str();
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+
+        auto* pEnv = TestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    static void SetRenderTargets()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pContext   = pEnv->GetDeviceContext();
+        auto* pSwapChain = pEnv->GetSwapChain();
+
+        constexpr float ClearColor[] = {0.125f, 0.25f, 0.375f, 1.0f};
+        RenderDrawCommandReference(pSwapChain, ClearColor);
+
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    static void Present()
+    {
+        auto* pEnv       = TestingEnvironment::GetInstance();
+        auto* pSwapChain = pEnv->GetSwapChain();
+        auto* pContext   = pEnv->GetDeviceContext();
+
+        pSwapChain->Present();
+
+        pContext->Flush();
+        pContext->InvalidateState();
+    }
+
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+};
+
+RefCntAutoPtr<IPipelineState> DrawCallBatcherTest::sm_pPSO;
+
+TEST_F(DrawCallBatcherTest, MergeContiguousDraws)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets();
+
+    DrawCallBatcher Batcher{pDevice, pContext, DrawCallBatcherCreateInfo{}};
+    Batcher.SetPipelineState(sm_pPSO);
+    Batcher.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 0});
+    Batcher.SetPipelineState(sm_pPSO);
+    Batcher.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 3});
+    Batcher.Flush();
+
+    const auto& Stats = Batcher.GetStats();
+    EXPECT_EQ(Stats.NumRecordedDraws, 2u);
+    EXPECT_EQ(Stats.NumMergedDraws, 1u);
+    EXPECT_EQ(Stats.NumDrawCalls, 1u);
+    EXPECT_EQ(Stats.NumMultiDrawCalls, 0u);
+    EXPECT_EQ(Stats.NumSkippedStateChanges, 1u);
+
+    Present();
+}
+
+TEST_F(DrawCallBatcherTest, MultiDrawIndirect)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets();
+
+    DrawCallBatcher Batcher{pDevice, pContext, DrawCallBatcherCreateInfo{}};
+    Batcher.SetPipelineState(sm_pPSO);
+    // The ranges are not contiguous and can't be merged
+    Batcher.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 3});
+    Batcher.Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL, 1, 0});
+    Batcher.Flush();
+
+    const auto& Stats = Batcher.GetStats();
+    EXPECT_EQ(Stats.NumRecordedDraws, 2u);
+    EXPECT_EQ(Stats.NumMergedDraws, 0u);
+    if (pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW_INDIRECT)
+    {
+        EXPECT_EQ(Stats.NumDrawCalls, 0u);
+        EXPECT_EQ(Stats.NumMultiDrawCalls, 1u);
+    }
+    else
+    {
+        EXPECT_EQ(Stats.NumDrawCalls, 2u);
+        EXPECT_EQ(Stats.NumMultiDrawCalls, 0u);
+    }
+
+    Present();
+}
+
+} // namespace
@@ -1715,6 +1715,183 @@ TEST_F(DrawCommandTest, DrawIndexedInstancedIndirect_FirstInstance_BaseVertex_Fi
     Present();
 }
 
+TEST_F(DrawCommandTest, MultiDrawInstancedIndirect_Stride)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawInstancedPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {}, {}, {}, // Skip 4 vertices with VB offset
+        {}, {}, {},     // Skip 3 vertices with StartVertexLocation
+        VertInst[0], VertInst[1], VertInst[2]
+    };
+    const float4 InstancedData[] = 
+    {
+        {}, {}, {}, {}, {}, // Skip 5 instances with VB offset
+        {}, {}, {}, {},     // Skip 4 instances with FirstInstance
+        float4{0.5f,  0.5f,  -0.5f, -0.5f},
+        float4{0.5f,  0.5f,  +0.5f, -0.5f}
+    };
+    // clang-format on
+
+    auto pVB     = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pInstVB = CreateVertexBuffer(InstancedData, sizeof(InstancedData));
+
+    IBuffer* pVBs[]    = {pVB, pInstVB};
+    Uint32   Offsets[] = {4 * sizeof(Vertex), 5 * sizeof(float4)};
+    pContext->SetVertexBuffers(0, _countof(pVBs), pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    // Each instance is drawn by a separate indirect command; commands are padded to 32 bytes
+    Uint32 IndirectDrawData[] =
+        {
+            0, 0, 0, 0, 0, // Offset
+
+            6, // NumVertices
+            1, // NumInstances
+            3, // StartVertexLocation
+            4, // FirstInstanceLocation
+            0, 0, 0, 0, // Padding
+
+            6, // NumVertices
+            1, // NumInstances
+            3, // StartVertexLocation
+            5, // FirstInstanceLocation
+            0, 0, 0, 0, // Padding
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    DrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    drawAttrs.IndirectDrawArgsOffset = 5 * sizeof(Uint32);
+    drawAttrs.DrawCount              = 2;
+    drawAttrs.DrawArgsStride         = 8 * sizeof(Uint32);
+    pContext->DrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, DrawInstancedIndirect_ZeroDrawCount)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawInstancedPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        VertInst[0], VertInst[1], VertInst[2]
+    };
+    const float4 InstancedData[] = 
+    {
+        float4{0.5f,  0.5f,  -0.5f, -0.5f},
+        float4{0.5f,  0.5f,  +0.5f, -0.5f},
+        float4{1.0f,  1.0f,   0.0f,  0.0f} // Must not be drawn
+    };
+    // clang-format on
+
+    auto pVB     = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pInstVB = CreateVertexBuffer(InstancedData, sizeof(InstancedData));
+
+    IBuffer* pVBs[] = {pVB, pInstVB};
+    pContext->SetVertexBuffers(0, _countof(pVBs), pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    Uint32 IndirectDrawData[] =
+        {
+            3, // NumVertices
+            2, // NumInstances
+            0, // StartVertexLocation
+            0, // FirstInstanceLocation
+
+            3, // NumVertices
+            1, // NumInstances
+            0, // StartVertexLocation
+            2, // FirstInstanceLocation
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    DrawIndirectAttribs drawAttrs{DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->DrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    // The second command must be ignored
+    drawAttrs.IndirectDrawArgsOffset = 4 * sizeof(Uint32);
+    drawAttrs.DrawCount              = 0;
+    pContext->DrawIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, DrawIndexedInstancedIndirect_ZeroDrawCount)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.IndirectRendering)
+        GTEST_SKIP() << "Indirect rendering is not supported on this device";
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawInstancedPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        VertInst[0], VertInst[1], VertInst[2]
+    };
+    Uint32 Indices[] = {0, 1, 2};
+    const float4 InstancedData[] = 
+    {
+        float4{0.5f,  0.5f,  -0.5f, -0.5f},
+        float4{0.5f,  0.5f,  +0.5f, -0.5f},
+        float4{1.0f,  1.0f,   0.0f,  0.0f} // Must not be drawn
+    };
+    // clang-format on
+
+    auto pVB     = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pInstVB = CreateVertexBuffer(InstancedData, sizeof(InstancedData));
+    auto pIB     = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer* pVBs[] = {pVB, pInstVB};
+    pContext->SetVertexBuffers(0, _countof(pVBs), pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    Uint32 IndirectDrawData[] =
+        {
+            3, // NumIndices
+            2, // NumInstances
+            0, // FirstIndexLocation
+            0, // BaseVertex
+            0, // FirstInstanceLocation
+
+            3, // NumIndices
+            1, // NumInstances
+            0, // FirstIndexLocation
+            0, // BaseVertex
+            2, // FirstInstanceLocation
+        };
+    auto pIndirectArgsBuff = CreateIndirectDrawArgsBuffer(IndirectDrawData, sizeof(IndirectDrawData));
+
+    DrawIndexedIndirectAttribs drawAttrs{VT_UINT32, DRAW_FLAG_VERIFY_ALL, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+    pContext->DrawIndexedIndirect(drawAttrs, pIndirectArgsBuff);
+
+    // The second command must be ignored
+    drawAttrs.IndirectDrawArgsOffset = 5 * sizeof(Uint32);
+    drawAttrs.DrawCount              = 0;
+    pContext->DrawIndexedIndirect(drawAttrs, pIndirectArgsBuff);
+
+    Present();
+}
+
 TEST_F(DrawCommandTest, Draw_InstanceDataStepRate)
 {
     auto* pEnv    = TestingEnvironment::GetInstance();
@@ -1901,6 +2078,69 @@ TEST_F(DrawCommandTest, DeferredContexts)
 }
 
 
+TEST_F(DrawCommandTest, DeferredContexts_ReusableCommandList)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    auto* pSwapChain    = pEnv->GetSwapChain();
+    auto* pImmediateCtx = pEnv->GetDeviceContext();
+    auto* pDeferredCtx  = pEnv->GetDeferredContext(0);
+
+    const float ClearColor[] = {sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    RenderDrawCommandReference(pSwapChain, ClearColor);
+
+    Uint32 Indices[] = {0, 1, 2, 3, 4, 5};
+    auto   pVB       = CreateVertexBuffer(Vert, sizeof(Vert));
+    auto   pIB       = CreateIndexBuffer(Indices, _countof(Indices));
+
+    StateTransitionDesc Barriers[] = //
+        {
+            {pVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, true},
+            {pIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, true} //
+        };
+    pImmediateCtx->TransitionResourceStates(_countof(Barriers), Barriers);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    RefCntAutoPtr<ICommandList> pCmdList;
+    {
+        pDeferredCtx->Begin(0, COMMAND_LIST_FLAG_REUSABLE);
+        pDeferredCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        IBuffer* pVBs[]    = {pVB};
+        Uint32   Offsets[] = {0};
+        pDeferredCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+        pDeferredCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        pDeferredCtx->SetPipelineState(sm_pDrawPSO);
+
+        DrawIndexedAttribs drawAttrs{6, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+        pDeferredCtx->DrawIndexed(drawAttrs);
+
+        pDeferredCtx->FinishCommandList(&pCmdList);
+    }
+
+    // Execute the same command list several times. Every execution overwrites the result of the previous one.
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        pImmediateCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pImmediateCtx->ClearRenderTarget(pRTVs[0], ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        ICommandList* pCmdLists[] = {pCmdList};
+        pImmediateCtx->ExecuteCommandLists(1, pCmdLists);
+    }
+
+    pDeferredCtx->FinishFrame();
+
+    Present();
+}
+
+
 void DrawCommandTest::TestDynamicBufferUpdates(IShader*                      pVS,
                                                IShader*                      pPS,
                                                IBuffer*                      pDynamicCB0,
@@ -0,0 +1,648 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "BasicMath.hpp"
+#include "MapHelper.hpp"
+#include "GraphicsAccessories.hpp"
+#include "ThreadSignal.hpp"
+#include "ShaderMacroHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+namespace HLSL
+{
+
+// clang-format off
+const std::string DrawThroughputTest_VS{
+R"(
+cbuffer cbInstance
+{
+    float4 g_Offset;
+};
+
+struct PSInput
+{
+    float4 Pos   : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+void main(in  uint    VertId : SV_VertexID,
+          out PSInput PSIn)
+{
+    float2 Pos[3];
+    Pos[0] = float2(-0.05, -0.05);
+    Pos[1] = float2( 0.0,  +0.05);
+    Pos[2] = float2(+0.05, -0.05);
+
+    PSIn.Pos   = float4(Pos[VertId] + g_Offset.xy, 0.0, 1.0);
+    PSIn.Color = float4(g_Offset.zw, 0.5, 1.0);
+}
+)"
+};
+
+const std::string DrawThroughputTest_PS{
+R"(
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+struct PSInput
+{
+    float4 Pos   : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    return PSIn.Color * g_Texture.Sample(g_Texture_sampler, float2(0.5, 0.5));
+}
+)"
+};
+
+const std::string DrawThroughputTest_SparsePS{
+R"(
+Texture2D    g_Textures[NUM_TEXTURES];
+SamplerState g_Sampler;
+
+struct PSInput
+{
+    float4 Pos   : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+float4 main(in PSInput PSIn) : SV_Target
+{
+    float4 Color = PSIn.Color;
+    [unroll]
+    for (int i = 0; i < NUM_TEXTURES; ++i)
+        Color *= g_Textures[i].Sample(g_Sampler, float2(0.5, 0.5));
+    return Color;
+}
+)"
+};
+// clang-format on
+
+} // namespace HLSL
+
+// Measures how many draw calls per second the CPU side of the backend can issue for
+// typical state change patterns. The results are printed to the log and are meant to
+// be compared between backends and between releases; the tests do not fail on low numbers.
+// Every pattern is measured on the immediate context and, if the device supports them,
+// with the draws split between all deferred contexts whose command lists are then
+// executed by the immediate context.
+// The tests are disabled as they only measure performance. Run them with --gtest_also_run_disabled_tests.
+class DrawThroughputTest : public ::testing::Test
+{
+protected:
+    // Records draws [FirstDraw, FirstDraw + DrawCount) into the context. The render target
+    // is already set; the function must bind everything else it needs.
+    using RecordDrawsFunc = std::function<void(IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount)>;
+
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        auto* pCtx    = pEnv->GetDeviceContext();
+
+        sm_pRT = pEnv->CreateTexture("Draw throughput test RT", TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, 256, 256);
+        ASSERT_NE(sm_pRT, nullptr);
+
+        std::array<Uint8, 4 * 4 * 4>     TexData{};
+        std::vector<StateTransitionDesc> Barriers;
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            sm_Textures[i] = pEnv->CreateTexture("Draw throughput test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4, TexData.data());
+            ASSERT_NE(sm_Textures[i], nullptr);
+
+            sm_TransitionTextures[i] = pEnv->CreateTexture("Draw throughput test transition texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4, TexData.data());
+            ASSERT_NE(sm_TransitionTextures[i], nullptr);
+
+            const float4 Offset{(static_cast<float>(i % 8) - 3.5f) * 0.2f, (static_cast<float>(i / 8) - 3.5f) * 0.2f, 1.f, 1.f};
+
+            BufferDesc BuffDesc{sizeof(float4), BIND_UNIFORM_BUFFER, USAGE_IMMUTABLE};
+            BuffDesc.Name = "Draw throughput test constant buffer";
+            BufferData InitData{&Offset, sizeof(Offset)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &sm_ConstBuffers[i]);
+            ASSERT_NE(sm_ConstBuffers[i], nullptr);
+
+            Barriers.emplace_back(sm_Textures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+            Barriers.emplace_back(sm_TransitionTextures[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, true);
+            Barriers.emplace_back(sm_ConstBuffers[i], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, true);
+        }
+        Barriers.emplace_back(sm_pRT, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, true);
+
+        {
+            BufferDesc BuffDesc{sizeof(float4), BIND_UNIFORM_BUFFER, USAGE_DYNAMIC, CPU_ACCESS_WRITE};
+            BuffDesc.Name = "Draw throughput test dynamic buffer";
+            pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pDynamicCB);
+            ASSERT_NE(sm_pDynamicCB, nullptr);
+        }
+
+        pCtx->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+        pCtx->Flush();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "Draw throughput test VS";
+        ShaderCI.Source          = HLSL::DrawThroughputTest_VS.c_str();
+        pDevice->CreateShader(ShaderCI, &sm_pVS);
+        ASSERT_NE(sm_pVS, nullptr);
+
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Draw throughput test PS";
+        ShaderCI.Source          = HLSL::DrawThroughputTest_PS.c_str();
+        pDevice->CreateShader(ShaderCI, &sm_pPS);
+        ASSERT_NE(sm_pPS, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pVS.Release();
+        sm_pPS.Release();
+        sm_pRT.Release();
+        sm_pDynamicCB.Release();
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            sm_Textures[i].Release();
+            sm_TransitionTextures[i].Release();
+            sm_ConstBuffers[i].Release();
+        }
+
+        auto* pEnv = TestingEnvironment::GetInstance();
+        pEnv->Reset();
+    }
+
+    static RefCntAutoPtr<IPipelineResourceSignature> CreateSignature(SHADER_RESOURCE_VARIABLE_TYPE VarType)
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        // clang-format off
+        const PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_VERTEX, "cbInstance", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, VarType},
+            {SHADER_TYPE_PIXEL,  "g_Texture",  1, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     VarType}
+        };
+        const ImmutableSamplerDesc ImmutableSamplers[] =
+        {
+            {SHADER_TYPE_PIXEL, "g_Texture", SamplerDesc{}}
+        };
+        // clang-format on
+
+        PipelineResourceSignatureDesc PRSDesc;
+        PRSDesc.Name                       = "Draw throughput test signature";
+        PRSDesc.Resources                  = Resources;
+        PRSDesc.NumResources               = _countof(Resources);
+        PRSDesc.ImmutableSamplers          = ImmutableSamplers;
+        PRSDesc.NumImmutableSamplers       = _countof(ImmutableSamplers);
+        PRSDesc.UseCombinedTextureSamplers = true;
+
+        RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+        pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+        return pPRS;
+    }
+
+    // Pipelines created with different Variant values differ in rasterizer and blend states,
+    // but share the signature and are thus compatible with the same SRBs.
+    // If pPS is null, the default pixel shader is used.
+    static RefCntAutoPtr<IPipelineState> CreatePSO(IPipelineResourceSignature* pPRS, Uint32 Variant, IShader* pPS = nullptr)
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Draw throughput test PSO";
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = sm_pRT->GetDesc().Format;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = (Variant & 0x01) != 0 ? CULL_MODE_BACK : CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        auto& RT0 = GraphicsPipeline.BlendDesc.RenderTargets[0];
+
+        RT0.BlendEnable           = (Variant & 0x02) != 0;
+        RT0.SrcBlend              = BLEND_FACTOR_SRC_ALPHA;
+        RT0.DestBlend             = BLEND_FACTOR_INV_SRC_ALPHA;
+        RT0.RenderTargetWriteMask = (Variant & 0x04) != 0 ? static_cast<Uint8>(COLOR_MASK_RED | COLOR_MASK_GREEN | COLOR_MASK_BLUE) : Uint8{COLOR_MASK_ALL};
+
+        IPipelineResourceSignature* ppSignatures[] = {pPRS};
+        PSOCreateInfo.ppResourceSignatures         = ppSignatures;
+        PSOCreateInfo.ResourceSignaturesCount      = _countof(ppSignatures);
+
+        PSOCreateInfo.pVS = sm_pVS;
+        PSOCreateInfo.pPS = pPS != nullptr ? pPS : sm_pPS.RawPtr();
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    // Creates NumResources SRBs that reference different resources.
+    // Static resources are bound in the signature and are thus the same in all SRBs.
+    static void CreateSRBs(IPipelineResourceSignature* pPRS, SHADER_RESOURCE_VARIABLE_TYPE VarType, std::vector<RefCntAutoPtr<IShaderResourceBinding>>& SRBs)
+    {
+        if (VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+        {
+            pPRS->GetStaticVariableByName(SHADER_TYPE_VERTEX, "cbInstance")->Set(sm_ConstBuffers[0]);
+            pPRS->GetStaticVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(sm_Textures[0]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+
+        SRBs.resize(NumResources);
+        for (Uint32 i = 0; i < NumResources; ++i)
+        {
+            pPRS->CreateShaderResourceBinding(&SRBs[i], true);
+            ASSERT_NE(SRBs[i], nullptr);
+            if (VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+            {
+                SRBs[i]->GetVariableByName(SHADER_TYPE_VERTEX, "cbInstance")->Set(sm_ConstBuffers[i]);
+                SRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(sm_Textures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+            }
+        }
+    }
+
+    static void SetRenderTarget(IDeviceContext* pCtx)
+    {
+        ITextureView* pRTVs[] = {sm_pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET)};
+        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pCtx->SetViewports(1, nullptr, 0, 0);
+    }
+
+    static void LogResult(const char* Name, const char* Mode, Uint32 DrawCount, double Seconds)
+    {
+        LOG_INFO_MESSAGE("Draw throughput | ", Name, " | ", Mode, ": ",
+                         static_cast<Uint32>(DrawCount / Seconds / 1000.0), "K draws/s (",
+                         DrawCount, " draws in ", Seconds * 1000.0, " ms)");
+    }
+
+    static void RunBenchmark(const char* Name, const RecordDrawsFunc& RecordDraws)
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+        auto* pCtx = pEnv->GetDeviceContext();
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        {
+            // Warm up: create descriptor pools, dynamic heap pages, etc.
+            SetRenderTarget(pCtx);
+            RecordDraws(pCtx, 0, NumResources);
+            pCtx->Flush();
+            pCtx->InvalidateState();
+        }
+
+        {
+            const auto StartTime = Clock::now();
+
+            SetRenderTarget(pCtx);
+            RecordDraws(pCtx, 0, NumDraws);
+            pCtx->Flush();
+
+            const auto Seconds = std::chrono::duration<double>{Clock::now() - StartTime}.count();
+            LogResult(Name, "immediate context", NumDraws, Seconds);
+
+            pCtx->InvalidateState();
+            pEnv->Reset();
+        }
+
+        const auto NumDeferredCtx = static_cast<Uint32>(pEnv->GetNumDeferredContexts());
+        if (NumDeferredCtx == 0)
+            return;
+
+        std::vector<std::thread>                 WorkerThreads(NumDeferredCtx);
+        std::vector<RefCntAutoPtr<ICommandList>> CmdLists(NumDeferredCtx);
+        std::vector<ICommandList*>               CmdListPtrs(NumDeferredCtx);
+
+        std::atomic<Uint32>    NumCmdListsReady{0};
+        ThreadingTools::Signal ExecuteCommandListsSignal;
+        ThreadingTools::Signal FinishFrameSignal;
+
+        const auto StartTime = Clock::now();
+        for (Uint32 i = 0; i < NumDeferredCtx; ++i)
+        {
+            WorkerThreads[i] = std::thread(
+                [&](Uint32 ThreadId) //
+                {
+                    auto* pDeferredCtx = pEnv->GetDeferredContext(ThreadId);
+
+                    const auto FirstDraw = NumDraws * ThreadId / NumDeferredCtx;
+                    const auto EndDraw   = NumDraws * (ThreadId + 1) / NumDeferredCtx;
+
+                    pDeferredCtx->Begin(0);
+                    SetRenderTarget(pDeferredCtx);
+                    RecordDraws(pDeferredCtx, FirstDraw, EndDraw - FirstDraw);
+                    pDeferredCtx->FinishCommandList(&CmdLists[ThreadId]);
+                    CmdListPtrs[ThreadId] = CmdLists[ThreadId];
+
+                    if (NumCmdListsReady.fetch_add(1) + 1 == NumDeferredCtx)
+                        ExecuteCommandListsSignal.Trigger();
+
+                    FinishFrameSignal.Wait(true, NumDeferredCtx);
+
+                    // In Metal backend FinishFrame must be called from the same
+                    // thread that issued rendering commands.
+                    pDeferredCtx->FinishFrame();
+                },
+                i);
+        }
+
+        ExecuteCommandListsSignal.Wait(true, 1);
+
+        pCtx->ExecuteCommandLists(NumDeferredCtx, CmdListPtrs.data());
+        pCtx->Flush();
+
+        const auto Seconds = std::chrono::duration<double>{Clock::now() - StartTime}.count();
+
+        FinishFrameSignal.Trigger(true);
+        for (auto& Thread : WorkerThreads)
+            Thread.join();
+
+        const auto Mode = std::to_string(NumDeferredCtx) + " deferred contexts";
+        LogResult(Name, Mode.c_str(), NumDraws, Seconds);
+
+        CmdLists.clear();
+        pEnv->Reset();
+    }
+
+    static void TestSRBCommit(SHADER_RESOURCE_VARIABLE_TYPE VarType);
+
+#ifdef DILIGENT_DEBUG
+    static constexpr Uint32 NumDraws = 256;
+#else
+    static constexpr Uint32 NumDraws = 16384;
+#endif
+    static constexpr Uint32 NumResources = 64;
+
+    static RefCntAutoPtr<IShader>  sm_pVS;
+    static RefCntAutoPtr<IShader>  sm_pPS;
+    static RefCntAutoPtr<ITexture> sm_pRT;
+    static RefCntAutoPtr<IBuffer>  sm_pDynamicCB;
+
+    static std::array<RefCntAutoPtr<ITexture>, NumResources> sm_Textures;
+    static std::array<RefCntAutoPtr<ITexture>, NumResources> sm_TransitionTextures;
+    static std::array<RefCntAutoPtr<IBuffer>, NumResources>  sm_ConstBuffers;
+};
+
+constexpr Uint32 DrawThroughputTest::NumDraws;
+constexpr Uint32 DrawThroughputTest::NumResources;
+
+RefCntAutoPtr<IShader>  DrawThroughputTest::sm_pVS;
+RefCntAutoPtr<IShader>  DrawThroughputTest::sm_pPS;
+RefCntAutoPtr<ITexture> DrawThroughputTest::sm_pRT;
+RefCntAutoPtr<IBuffer>  DrawThroughputTest::sm_pDynamicCB;
+
+std::array<RefCntAutoPtr<ITexture>, DrawThroughputTest::NumResources> DrawThroughputTest::sm_Textures;
+std::array<RefCntAutoPtr<ITexture>, DrawThroughputTest::NumResources> DrawThroughputTest::sm_TransitionTextures;
+std::array<RefCntAutoPtr<IBuffer>, DrawThroughputTest::NumResources>  DrawThroughputTest::sm_ConstBuffers;
+
+
+// Every draw binds a different pipeline; all pipelines share one SRB.
+TEST_F(DrawThroughputTest, DISABLED_PSOSwitch)
+{
+    constexpr Uint32 NumPSOs = 8;
+
+    auto pPRS = CreateSignature(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    ASSERT_NE(pPRS, nullptr);
+
+    std::array<RefCntAutoPtr<IPipelineState>, NumPSOs> PSOs;
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        PSOs[i] = CreatePSO(pPRS, i);
+        ASSERT_NE(PSOs[i], nullptr);
+    }
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs;
+    CreateSRBs(pPRS, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SRBs);
+
+    RunBenchmark("PSO switch", [&](IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount) {
+        pCtx->SetPipelineState(PSOs[0]);
+        pCtx->CommitShaderResources(SRBs[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (Uint32 i = FirstDraw; i < FirstDraw + DrawCount; ++i)
+        {
+            pCtx->SetPipelineState(PSOs[i % NumPSOs]);
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+    });
+}
+
+
+// Every draw commits a different SRB.
+void DrawThroughputTest::TestSRBCommit(SHADER_RESOURCE_VARIABLE_TYPE VarType)
+{
+    auto pPRS = CreateSignature(VarType);
+    ASSERT_NE(pPRS, nullptr);
+
+    auto pPSO = CreatePSO(pPRS, 0);
+    ASSERT_NE(pPSO, nullptr);
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs;
+    CreateSRBs(pPRS, VarType, SRBs);
+
+    const auto Name = std::string{"SRB commit ("} + GetShaderVariableTypeLiteralName(VarType) + ")";
+    RunBenchmark(Name.c_str(), [&](IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount) {
+        pCtx->SetPipelineState(pPSO);
+        for (Uint32 i = FirstDraw; i < FirstDraw + DrawCount; ++i)
+        {
+            pCtx->CommitShaderResources(SRBs[i % NumResources], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+    });
+}
+
+TEST_F(DrawThroughputTest, DISABLED_SRBCommit_Static)
+{
+    TestSRBCommit(SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+}
+
+TEST_F(DrawThroughputTest, DISABLED_SRBCommit_Mutable)
+{
+    TestSRBCommit(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+}
+
+TEST_F(DrawThroughputTest, DISABLED_SRBCommit_Dynamic)
+{
+    TestSRBCommit(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+}
+
+// Every draw commits a different SRB that only differs from the previous one in the first
+// and the last element of a large texture array, i.e. the changed slots are far apart.
+TEST_F(DrawThroughputTest, DISABLED_SRBCommit_SparseSlots)
+{
+    constexpr Uint32 NumTextures = 32;
+
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("NUM_TEXTURES", NumTextures);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler  = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint      = "main";
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name       = "Draw throughput test sparse PS";
+    ShaderCI.Source          = HLSL::DrawThroughputTest_SparsePS.c_str();
+    ShaderCI.Macros          = Macros;
+
+    RefCntAutoPtr<IShader> pPS;
+    pDevice->CreateShader(ShaderCI, &pPS);
+    ASSERT_NE(pPS, nullptr);
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_VERTEX, "cbInstance", 1,           SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL,  "g_Textures", NumTextures, SHADER_RESOURCE_TYPE_TEXTURE_SRV,     SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+    };
+    const ImmutableSamplerDesc ImmutableSamplers[] =
+    {
+        {SHADER_TYPE_PIXEL, "g_Sampler", SamplerDesc{}}
+    };
+    // clang-format on
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name                 = "Draw throughput test sparse signature";
+    PRSDesc.Resources            = Resources;
+    PRSDesc.NumResources         = _countof(Resources);
+    PRSDesc.ImmutableSamplers    = ImmutableSamplers;
+    PRSDesc.NumImmutableSamplers = _countof(ImmutableSamplers);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_NE(pPRS, nullptr);
+
+    auto pPSO = CreatePSO(pPRS, 0, pPS);
+    ASSERT_NE(pPSO, nullptr);
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumResources);
+    for (Uint32 i = 0; i < NumResources; ++i)
+    {
+        pPRS->CreateShaderResourceBinding(&SRBs[i], true);
+        ASSERT_NE(SRBs[i], nullptr);
+
+        std::array<IDeviceObject*, NumTextures> pViews;
+        pViews.fill(sm_Textures[0]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        pViews.front() = sm_Textures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+        pViews.back()  = sm_Textures[NumResources - 1 - i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+        SRBs[i]->GetVariableByName(SHADER_TYPE_VERTEX, "cbInstance")->Set(sm_ConstBuffers[i]);
+        SRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Textures")->SetArray(pViews.data(), 0, NumTextures);
+    }
+
+    RunBenchmark("SRB commit (sparse slots)", [&](IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount) {
+        pCtx->SetPipelineState(pPSO);
+        for (Uint32 i = FirstDraw; i < FirstDraw + DrawCount; ++i)
+        {
+            pCtx->CommitShaderResources(SRBs[i % NumResources], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+    });
+}
+
+
+// Every draw writes new constants to a dynamic buffer with MAP_FLAG_DISCARD.
+TEST_F(DrawThroughputTest, DISABLED_DynamicBufferMap)
+{
+    auto pPRS = CreateSignature(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    ASSERT_NE(pPRS, nullptr);
+
+    auto pPSO = CreatePSO(pPRS, 0);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+    pSRB->GetVariableByName(SHADER_TYPE_VERTEX, "cbInstance")->Set(sm_pDynamicCB);
+    pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(sm_Textures[0]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+    RunBenchmark("Dynamic buffer map", [&](IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount) {
+        pCtx->SetPipelineState(pPSO);
+        pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (Uint32 i = FirstDraw; i < FirstDraw + DrawCount; ++i)
+        {
+            {
+                MapHelper<float4> Constants{pCtx, sm_pDynamicCB, MAP_WRITE, MAP_FLAG_DISCARD};
+                *Constants = float4{(static_cast<float>(i % 8) - 3.5f) * 0.2f, (static_cast<float>((i / 8) % 8) - 3.5f) * 0.2f, 1.f, 1.f};
+            }
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+    });
+}
+
+
+// Every draw is preceded by two explicit state transitions of a texture that is not used by the draw.
+TEST_F(DrawThroughputTest, DISABLED_StateTransitions)
+{
+    auto pPRS = CreateSignature(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
+    ASSERT_NE(pPRS, nullptr);
+
+    auto pPSO = CreatePSO(pPRS, 0);
+    ASSERT_NE(pPSO, nullptr);
+
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs;
+    CreateSRBs(pPRS, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, SRBs);
+
+    RunBenchmark("State transitions", [&](IDeviceContext* pCtx, Uint32 FirstDraw, Uint32 DrawCount) {
+        pCtx->SetPipelineState(pPSO);
+        pCtx->CommitShaderResources(SRBs[0], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (Uint32 i = FirstDraw; i < FirstDraw + DrawCount; ++i)
+        {
+            // Deferred contexts must not update the global resource state
+            auto* pTexture = sm_TransitionTextures[i % NumResources].RawPtr();
+
+            StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_SHADER_RESOURCE, RESOURCE_STATE_COPY_DEST, false};
+            pCtx->TransitionResourceStates(1, &Barrier);
+
+            Barrier = StateTransitionDesc{pTexture, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_SHADER_RESOURCE, false};
+            pCtx->TransitionResourceStates(1, &Barrier);
+
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+    });
+}
+
+} // namespace
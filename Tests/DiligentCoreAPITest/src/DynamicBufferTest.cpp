@@ -219,4 +219,50 @@ TEST(DynamicBufferTest, Resize)
     }
 }
 
+TEST(DynamicBufferTest, SparseResize)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.SparseResources)
+    {
+        GTEST_SKIP() << "Sparse resources are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    DynamicBufferCreateInfo CI;
+    CI.Desc.Name          = "Dynamic buffer sparse resize test";
+    CI.Desc.BindFlags     = BIND_VERTEX_BUFFER;
+    CI.Desc.uiSizeInBytes = 256;
+    CI.VirtualSize        = 16 << 20;
+    CI.MemoryPageSize     = 1 << 20;
+    DynamicBuffer DynBuff{pDevice, CI};
+    EXPECT_TRUE(DynBuff.IsSparse());
+    EXPECT_TRUE(DynBuff.PendingUpdate());
+
+    auto* pBuffer = DynBuff.GetBuffer(pDevice, pContext);
+    ASSERT_NE(pBuffer, nullptr);
+    EXPECT_FALSE(DynBuff.PendingUpdate());
+
+    // Growing within the virtual range keeps the buffer and its version
+    for (Uint32 Size : {4u << 20, 1u << 20, 16u << 20})
+    {
+        DynBuff.Resize(nullptr, nullptr, Size);
+        EXPECT_EQ(DynBuff.GetDesc().uiSizeInBytes, Size);
+        EXPECT_EQ(DynBuff.PendingUpdate(), Size > (1u << 20));
+        EXPECT_EQ(DynBuff.GetBuffer(pDevice, pContext), pBuffer);
+        EXPECT_FALSE(DynBuff.PendingUpdate());
+        EXPECT_EQ(DynBuff.GetVersion(), Uint32{0});
+    }
+
+    // Growing beyond the virtual range falls back to the copy
+    DynBuff.Resize(pDevice, pContext, (16u << 20) + 256);
+    EXPECT_FALSE(DynBuff.IsSparse());
+    EXPECT_FALSE(DynBuff.PendingUpdate());
+    EXPECT_NE(DynBuff.GetBuffer(nullptr, nullptr), nullptr);
+    EXPECT_EQ(DynBuff.GetVersion(), Uint32{1});
+}
+
 } // namespace
@@ -188,4 +188,54 @@ TEST(DynamicTextureAtlas, Allocate)
     }
 }
 
+TEST(DynamicTextureAtlas, ReuseFreedSpace)
+{
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount    = 1;
+    CI.TextureGranularity = 16;
+    CI.Desc.Format        = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name          = "Dynamic Texture Atlas Test";
+    CI.Desc.Type          = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags     = BIND_SHADER_RESOURCE;
+    CI.Desc.Width         = 256;
+    CI.Desc.Height        = 256;
+    CI.Desc.ArraySize     = 0;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(nullptr, CI, &pAtlas);
+    ASSERT_TRUE(pAtlas);
+
+    constexpr Uint32 NumSlices = 8;
+
+    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> pSubAllocations(NumSlices * 4);
+    for (size_t i = 0; i < pSubAllocations.size(); ++i)
+    {
+        pAtlas->Allocate(128, 128, &pSubAllocations[i]);
+        ASSERT_TRUE(pSubAllocations[i]);
+        EXPECT_EQ(pSubAllocations[i]->GetSlice(), i / 4);
+    }
+
+    // All slices are full for every size
+    {
+        RefCntAutoPtr<ITextureAtlasSuballocation> pSuballoc;
+        pAtlas->Allocate(16, 16, &pSuballoc);
+        ASSERT_TRUE(pSuballoc);
+        EXPECT_EQ(pSuballoc->GetSlice(), NumSlices);
+    }
+
+    // Space released in a slice must be found again by every size class
+    pSubAllocations[4 * 3 + 1].Release();
+    {
+        RefCntAutoPtr<ITextureAtlasSuballocation> pSuballoc;
+        pAtlas->Allocate(128, 16, &pSuballoc);
+        ASSERT_TRUE(pSuballoc);
+        EXPECT_EQ(pSuballoc->GetSlice(), 3u);
+
+        RefCntAutoPtr<ITextureAtlasSuballocation> pSuballoc2;
+        pAtlas->Allocate(16, 112, &pSuballoc2);
+        ASSERT_TRUE(pSuballoc2);
+        EXPECT_EQ(pSuballoc2->GetSlice(), 3u);
+    }
+}
+
 } // namespace
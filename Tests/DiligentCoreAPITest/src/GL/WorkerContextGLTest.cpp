@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <thread>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static constexpr Uint32 NumValues = 64;
+static constexpr Uint32 TexSize   = 8;
+
+// The testing environment creates the GL device with EngineGLCreateInfo::CreateWorkerContext,
+// so buffers and textures can be created in threads that have no current GL context. The resources
+// must be complete and usable by the immediate context as soon as the creating call returns.
+TEST(WorkerContextGLTest, CreateResourcesInWorkerThread)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Worker context is only used by OpenGL backend";
+    }
+#if !(PLATFORM_WIN32 || PLATFORM_LINUX || PLATFORM_ANDROID)
+    GTEST_SKIP() << "Worker GL context is not supported on this platform";
+#endif
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    Uint32 RefBufferData[NumValues];
+    for (Uint32 i = 0; i < NumValues; ++i)
+        RefBufferData[i] = i * 3 + 1;
+
+    Uint32 RefTexData[TexSize * TexSize];
+    for (Uint32 i = 0; i < TexSize * TexSize; ++i)
+        RefTexData[i] = 0xFF000000u | (i * 0x010203u);
+
+    RefCntAutoPtr<IBuffer>  pBuffer;
+    RefCntAutoPtr<ITexture> pTexture;
+    std::thread             WorkerThread{
+        [&]() //
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Worker context test buffer";
+            BuffDesc.Usage         = USAGE_DEFAULT;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+            BuffDesc.uiSizeInBytes = sizeof(RefBufferData);
+
+            BufferData InitData{RefBufferData, sizeof(RefBufferData)};
+            pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+
+            TextureDesc TexDesc;
+            TexDesc.Name      = "Worker context test texture";
+            TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+            TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.Width     = TexSize;
+            TexDesc.Height    = TexSize;
+            TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+            TextureSubResData Mip0Data{RefTexData, TexSize * sizeof(Uint32)};
+            TextureData       InitTexData{&Mip0Data, 1};
+            pDevice->CreateTexture(TexDesc, &InitTexData, &pTexture);
+        } //
+    };
+    WorkerThread.join();
+    ASSERT_NE(pBuffer, nullptr);
+    ASSERT_NE(pTexture, nullptr);
+    EXPECT_NE(pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), nullptr);
+
+    // Read the data back through the immediate context
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Worker context test staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.uiSizeInBytes  = sizeof(RefBufferData);
+
+        RefCntAutoPtr<IBuffer> pStagingBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+
+        pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        for (Uint32 i = 0; i < NumValues; ++i)
+            EXPECT_EQ(static_cast<const Uint32*>(pData)[i], RefBufferData[i]) << "Value " << i;
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+
+    {
+        TextureDesc StagingDesc = pTexture->GetDesc();
+        StagingDesc.Name           = "Worker context test staging texture";
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.BindFlags      = BIND_NONE;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        RefCntAutoPtr<ITexture> pStagingTex;
+        pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+
+        CopyTextureAttribs CopyAttribs{pTexture, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 y = 0; y < TexSize; ++y)
+        {
+            const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride);
+            for (Uint32 x = 0; x < TexSize; ++x)
+                EXPECT_EQ(pRow[x], RefTexData[x + y * TexSize]) << "Texel (" << x << ", " << y << ")";
+        }
+        pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+    }
+}
+
+} // namespace
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GPUReadback.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class GPUReadbackTest : public testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+};
+
+TEST_F(GPUReadbackTest, Buffer)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    std::vector<Uint32> Values(1024);
+    for (size_t i = 0; i < Values.size(); ++i)
+        Values[i] = static_cast<Uint32>(i * 7 + 3);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "GPU readback test buffer";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    BuffDesc.uiSizeInBytes = static_cast<Uint32>(Values.size() * sizeof(Values[0]));
+
+    BufferData InitData{Values.data(), BuffDesc.uiSizeInBytes};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+    ASSERT_TRUE(pBuffer);
+
+    GPUReadback Readback{pDevice};
+
+    constexpr Uint32 FirstValue = 100;
+    constexpr Uint32 NumValues  = 300;
+
+    std::vector<Uint32> ReadValues;
+    Uint64              CallbackId = 0;
+
+    const auto Id = Readback.ReadbackBuffer(
+        pContext, pBuffer, FirstValue * sizeof(Uint32), NumValues * sizeof(Uint32),
+        [&](const GPUReadbackData& Data) {
+            CallbackId = Data.Id;
+            ASSERT_EQ(Data.Size, Uint64{NumValues * sizeof(Uint32)});
+            const auto* pValues = static_cast<const Uint32*>(Data.pData);
+            ReadValues.assign(pValues, pValues + NumValues);
+        });
+    ASSERT_NE(Id, Uint64{0});
+    EXPECT_FALSE(Readback.IsCompleted(Id));
+    EXPECT_EQ(Readback.GetNumPendingReadbacks(), size_t{1});
+
+    Readback.Finish(pContext);
+    EXPECT_TRUE(Readback.IsCompleted(Id));
+    EXPECT_EQ(CallbackId, Id);
+    EXPECT_EQ(Readback.GetNumPendingReadbacks(), size_t{0});
+    ASSERT_EQ(ReadValues.size(), size_t{NumValues});
+    EXPECT_EQ(memcmp(ReadValues.data(), &Values[FirstValue], NumValues * sizeof(Uint32)), 0);
+
+    // The staging buffer must be reused by the next readback of a similar size
+    bool Completed = false;
+    Readback.ReadbackBuffer(pContext, pBuffer, 0, (NumValues - 10) * sizeof(Uint32),
+                            [&](const GPUReadbackData& Data) {
+                                Completed = memcmp(Data.pData, Values.data(), static_cast<size_t>(Data.Size)) == 0;
+                            });
+    Readback.Finish(pContext);
+    EXPECT_TRUE(Completed);
+}
+
+TEST_F(GPUReadbackTest, Texture)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 32;
+
+    std::vector<Uint32> Pixels(Width * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+            Pixels[x + y * Width] = x | (y << 8u) | 0xFF000000u;
+    }
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU readback test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    TextureSubResData Mip0Data{Pixels.data(), Width * Uint32{sizeof(Uint32)}};
+    TextureData       InitData{&Mip0Data, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    ASSERT_TRUE(pTexture);
+
+    GPUReadback Readback{pDevice};
+
+    const Box Region{8, 40, 4, 20, 0, 1};
+
+    bool Completed = false;
+    Readback.ReadbackTexture(
+        pContext, pTexture, 0, 0, &Region,
+        [&](const GPUReadbackData& Data) {
+            Completed = true;
+            ASSERT_EQ(Data.Width, Region.MaxX - Region.MinX);
+            ASSERT_EQ(Data.Height, Region.MaxY - Region.MinY);
+            ASSERT_EQ(Data.Format, TEX_FORMAT_RGBA8_UNORM);
+            ASSERT_GE(Data.Stride, Data.Width * 4);
+            for (Uint32 y = 0; y < Data.Height; ++y)
+            {
+                const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(Data.pData) + size_t{Data.Stride} * y);
+                for (Uint32 x = 0; x < Data.Width; ++x)
+                    ASSERT_EQ(pRow[x], Pixels[(Region.MinX + x) + (Region.MinY + y) * Width]) << "x=" << x << " y=" << y;
+            }
+        });
+
+    // Update() must never block; the callback runs once the GPU has finished the copy
+    Readback.Update(pContext);
+    Readback.Finish(pContext);
+    EXPECT_TRUE(Completed);
+}
+
+} // namespace
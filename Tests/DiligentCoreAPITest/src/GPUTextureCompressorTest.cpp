@@ -0,0 +1,445 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GPUTextureCompressor.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TextureCompressor.hpp"
+#include "GPUReadback.hpp"
+#include "GraphicsAccessories.hpp"
+#include "TestingEnvironment.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using BlockRGBA8 = Uint8[16][4];
+
+class BitReader
+{
+public:
+    explicit BitReader(const Uint8* pData) :
+        m_pData{pData}
+    {}
+
+    Uint32 Read(Uint32 NumBits)
+    {
+        Uint32 Value = 0;
+        for (Uint32 b = 0; b < NumBits; ++b, ++m_Pos)
+            Value |= ((m_pData[m_Pos / 8] >> (m_Pos % 8)) & 1u) << b;
+        return Value;
+    }
+
+private:
+    const Uint8* const m_pData;
+    Uint32             m_Pos = 0;
+};
+
+// Decodes the BC1 color block. BC2 and BC3 always use the 4-color mode.
+void DecodeBC1ColorBlock(const Uint8* pBlock, bool IsBC1, BlockRGBA8& Texels)
+{
+    const Uint32 c[2] = {pBlock[0] | (Uint32{pBlock[1]} << 8u), pBlock[2] | (Uint32{pBlock[3]} << 8u)};
+
+    Uint32 Palette[4][4];
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        const auto r = (c[i] >> 11u) & 31u;
+        const auto g = (c[i] >> 5u) & 63u;
+        const auto b = c[i] & 31u;
+        Palette[i][0] = (r << 3u) | (r >> 2u);
+        Palette[i][1] = (g << 2u) | (g >> 4u);
+        Palette[i][2] = (b << 3u) | (b >> 2u);
+        Palette[i][3] = 255;
+    }
+    for (Uint32 ch = 0; ch < 3; ++ch)
+    {
+        if (c[0] > c[1] || !IsBC1)
+        {
+            Palette[2][ch] = (2 * Palette[0][ch] + Palette[1][ch]) / 3;
+            Palette[3][ch] = (Palette[0][ch] + 2 * Palette[1][ch]) / 3;
+        }
+        else
+        {
+            Palette[2][ch] = (Palette[0][ch] + Palette[1][ch]) / 2;
+            Palette[3][ch] = 0;
+        }
+    }
+    Palette[2][3] = 255;
+    Palette[3][3] = (c[0] > c[1] || !IsBC1) ? 255 : 0;
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto Idx = (pBlock[4 + i / 4] >> ((i % 4) * 2)) & 3u;
+        for (Uint32 ch = 0; ch < 4; ++ch)
+            Texels[i][ch] = static_cast<Uint8>(Palette[Idx][ch]);
+    }
+}
+
+void DecodeBC4Block(const Uint8* pBlock, Uint32 Channel, BlockRGBA8& Texels)
+{
+    Uint32 a[8] = {pBlock[0], pBlock[1]};
+    if (a[0] > a[1])
+    {
+        for (Uint32 i = 1; i < 7; ++i)
+            a[i + 1] = ((7 - i) * a[0] + i * a[1]) / 7;
+    }
+    else
+    {
+        for (Uint32 i = 1; i < 5; ++i)
+            a[i + 1] = ((5 - i) * a[0] + i * a[1]) / 5;
+        a[6] = 0;
+        a[7] = 255;
+    }
+
+    BitReader Reader{pBlock + 2};
+    for (Uint32 i = 0; i < 16; ++i)
+        Texels[i][Channel] = static_cast<Uint8>(a[Reader.Read(3)]);
+}
+
+// Only decodes mode 6, which is the only mode used by the encoders
+void DecodeBC7Block(const Uint8* pBlock, BlockRGBA8& Texels)
+{
+    static constexpr Uint32 Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    BitReader Reader{pBlock};
+    ASSERT_EQ(Reader.Read(7), 1u << 6u) << "Unexpected BC7 mode";
+
+    Uint32 E[2][4];
+    for (Uint32 ch = 0; ch < 4; ++ch)
+    {
+        E[0][ch] = Reader.Read(7) << 1u;
+        E[1][ch] = Reader.Read(7) << 1u;
+    }
+    const auto p0 = Reader.Read(1);
+    const auto p1 = Reader.Read(1);
+    for (Uint32 ch = 0; ch < 4; ++ch)
+    {
+        E[0][ch] |= p0;
+        E[1][ch] |= p1;
+    }
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto w = Weights[Reader.Read(i == 0 ? 3 : 4)];
+        for (Uint32 ch = 0; ch < 4; ++ch)
+            Texels[i][ch] = static_cast<Uint8>(((64 - w) * E[0][ch] + w * E[1][ch] + 32) >> 6u);
+    }
+}
+
+void DecodeBlock(TEXTURE_FORMAT Format, const Uint8* pBlock, BlockRGBA8& Texels)
+{
+    for (auto& Texel : Texels)
+    {
+        Texel[0] = Texel[1] = Texel[2] = 0;
+        Texel[3]                       = 255;
+    }
+
+    switch (Format)
+    {
+        case TEX_FORMAT_BC1_UNORM:
+            DecodeBC1ColorBlock(pBlock, true, Texels);
+            break;
+
+        case TEX_FORMAT_BC3_UNORM:
+            DecodeBC1ColorBlock(pBlock + 8, false, Texels);
+            DecodeBC4Block(pBlock, 3, Texels);
+            break;
+
+        case TEX_FORMAT_BC4_UNORM:
+            DecodeBC4Block(pBlock, 0, Texels);
+            break;
+
+        case TEX_FORMAT_BC5_UNORM:
+            DecodeBC4Block(pBlock, 0, Texels);
+            DecodeBC4Block(pBlock + 8, 1, Texels);
+            break;
+
+        case TEX_FORMAT_BC7_UNORM:
+            DecodeBC7Block(pBlock, Texels);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected format");
+    }
+}
+
+// Returns the root mean square error of the compressed image over the channels of the format
+double ComputeRMSE(TEXTURE_FORMAT Format, const std::vector<Uint8>& Blocks, const std::vector<Uint32>& Pixels, Uint32 Width, Uint32 Height)
+{
+    const auto& FmtAttribs  = GetTextureFormatAttribs(Format);
+    const auto  BlockSize   = Uint32{FmtAttribs.ComponentSize};
+    const auto  NumChannels = Uint32{FmtAttribs.NumComponents};
+    const auto  NumBlocksX  = Width / 4;
+
+    double SqError = 0;
+    for (Uint32 by = 0; by < Height / 4; ++by)
+    {
+        for (Uint32 bx = 0; bx < NumBlocksX; ++bx)
+        {
+            BlockRGBA8 Texels;
+            DecodeBlock(Format, &Blocks[(bx + by * NumBlocksX) * BlockSize], Texels);
+            for (Uint32 i = 0; i < 16; ++i)
+            {
+                const auto Pixel = Pixels[(bx * 4 + i % 4) + (by * 4 + i / 4) * Width];
+                for (Uint32 ch = 0; ch < NumChannels; ++ch)
+                {
+                    const double d = static_cast<double>(Texels[i][ch]) - static_cast<double>((Pixel >> (ch * 8)) & 0xFFu);
+                    SqError += d * d;
+                }
+            }
+        }
+    }
+    return std::sqrt(SqError / (static_cast<double>(Width) * Height * NumChannels));
+}
+
+// Smooth gradients with sharp edges and some noise
+std::vector<Uint32> GenerateTestImage(Uint32 Width, Uint32 Height)
+{
+    FastRand            Rnd{0};
+    std::vector<Uint32> Pixels(Width * Height);
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            // Alpha is at least 128, so that BC1 blocks remain opaque
+            const auto Noise = Rnd() % 8;
+            const auto r     = (x * 255 / Width + Noise) & 0xFFu;
+            const auto g     = (y * 255 / Height + Noise) & 0xFFu;
+            const auto b     = ((x / 16 + y / 16) % 2 != 0) ? 200u : 40u;
+            const auto a     = 128 + (x + y) * 127 / (Width + Height - 2);
+            Pixels[x + y * Width] = r | (g << 8u) | (b << 16u) | (a << 24u);
+        }
+    }
+    return Pixels;
+}
+
+RefCntAutoPtr<ITexture> CreateSourceTexture(Uint32 Width, Uint32 Height, const std::vector<Uint32>& Pixels)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU texture compressor test source texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    TextureSubResData Mip0Data{Pixels.data(), Width * Uint32{sizeof(Uint32)}};
+    TextureData       InitData{&Mip0Data, 1};
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, &InitData, &pTexture);
+    return pTexture;
+}
+
+RefCntAutoPtr<ITexture> CreateCompressedTexture(Uint32 Width, Uint32 Height, Uint32 MipLevels, TEXTURE_FORMAT Format)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "GPU texture compressor test compressed texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.MipLevels = MipLevels;
+    TexDesc.Format    = Format;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    return pTexture;
+}
+
+class GPUTextureCompressorTest : public testing::TestWithParam<TEXTURE_FORMAT>
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        const auto& DeviceInfo = TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
+        if (!DeviceInfo.Features.ComputeShaders)
+            GTEST_SKIP() << "Compute shaders are not supported by this device";
+        if (DeviceInfo.IsGLDevice())
+            GTEST_SKIP() << "Copies between compressed and uncompressed textures are not supported in OpenGL backend";
+    }
+
+    static bool IsFormatSupported(TEXTURE_FORMAT Format)
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        return pDevice->GetTextureFormatInfo(Format).Supported;
+    }
+};
+
+TEST_P(GPUTextureCompressorTest, Quality)
+{
+    const auto Format = GetParam();
+    if (!IsFormatSupported(Format))
+        GTEST_SKIP() << GetTextureFormatAttribs(Format).Name << " format is not supported by this device";
+
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // The source is compressed into mip level 1 of the destination texture
+    constexpr Uint32 Width  = 64;
+    constexpr Uint32 Height = 48;
+
+    const auto Pixels     = GenerateTestImage(Width, Height);
+    auto       pSrcTex    = CreateSourceTexture(Width, Height, Pixels);
+    auto       pDstTex    = CreateCompressedTexture(Width * 2, Height * 2, 2, Format);
+    ASSERT_TRUE(pSrcTex);
+    ASSERT_TRUE(pDstTex);
+
+    GPUTextureCompressor Compressor{pDevice};
+    ASSERT_TRUE(Compressor.Compress(pContext, pSrcTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), pDstTex, 1));
+
+    const auto BlockSize = Uint32{GetTextureFormatAttribs(Format).ComponentSize};
+    const auto RowSize   = Width / 4 * BlockSize;
+
+    std::vector<Uint8> GPUBlocks;
+    GPUReadback        Readback{pDevice};
+    Readback.ReadbackTexture(pContext, pDstTex, 1, 0, nullptr,
+                             [&](const GPUReadbackData& Data) {
+                                 for (Uint32 Row = 0; Row < Height / 4; ++Row)
+                                 {
+                                     const auto* pRow = static_cast<const Uint8*>(Data.pData) + size_t{Data.Stride} * Row;
+                                     GPUBlocks.insert(GPUBlocks.end(), pRow, pRow + RowSize);
+                                 }
+                             });
+    Readback.Finish(pContext);
+    ASSERT_EQ(GPUBlocks.size(), size_t{RowSize} * (Height / 4));
+
+    std::vector<Uint8> CPUBlocks(GPUBlocks.size());
+
+    TextureCompressionAttribs Attribs;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.pSrcData  = Pixels.data();
+    Attribs.SrcStride = Width * 4;
+    Attribs.DstFormat = Format;
+    Attribs.pDstData  = CPUBlocks.data();
+    Attribs.DstStride = RowSize;
+    ASSERT_TRUE(CompressTexture(Attribs));
+
+    const auto GPUError = ComputeRMSE(Format, GPUBlocks, Pixels, Width, Height);
+    const auto CPUError = ComputeRMSE(Format, CPUBlocks, Pixels, Width, Height);
+
+    size_t NumEqualBlocks = 0;
+    for (size_t b = 0; b < GPUBlocks.size(); b += BlockSize)
+        NumEqualBlocks += memcmp(&GPUBlocks[b], &CPUBlocks[b], BlockSize) == 0 ? 1 : 0;
+
+    LOG_INFO_MESSAGE("GPU texture compressor | ", GetTextureFormatAttribs(Format).Name, ": RMSE GPU ", GPUError, ", CPU ", CPUError,
+                     "; ", NumEqualBlocks, " of ", GPUBlocks.size() / BlockSize, " blocks are identical");
+
+    // The encoders are the same, so the results may only differ due to floating-point rounding
+    EXPECT_LE(GPUError, CPUError * 1.05 + 0.1);
+}
+
+// Compares the throughput of the GPU and CPU encoders
+TEST_P(GPUTextureCompressorTest, Throughput)
+{
+    const auto Format = GetParam();
+    if (!IsFormatSupported(Format))
+        GTEST_SKIP() << GetTextureFormatAttribs(Format).Name << " format is not supported by this device";
+
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    constexpr Uint32 Width         = 1024;
+    constexpr Uint32 Height        = 1024;
+    constexpr Uint32 NumIterations = 16;
+
+    const auto Pixels  = GenerateTestImage(Width, Height);
+    auto       pSrcTex = CreateSourceTexture(Width, Height, Pixels);
+    auto       pDstTex = CreateCompressedTexture(Width, Height, 1, Format);
+    ASSERT_TRUE(pSrcTex);
+    ASSERT_TRUE(pDstTex);
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    GPUTextureCompressor Compressor{pDevice};
+    auto*                pSrcSRV = pSrcTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+    // Warm up: create the pipeline and the block texture
+    ASSERT_TRUE(Compressor.Compress(pContext, pSrcSRV, pDstTex));
+    pContext->WaitForIdle();
+
+    auto StartTime = Clock::now();
+    for (Uint32 i = 0; i < NumIterations; ++i)
+        Compressor.Compress(pContext, pSrcSRV, pDstTex);
+    pContext->WaitForIdle();
+    const auto GPUSeconds = std::chrono::duration<double>{Clock::now() - StartTime}.count();
+
+    std::vector<Uint8> CPUBlocks(size_t{Width / 4} * (Height / 4) * GetTextureFormatAttribs(Format).ComponentSize);
+
+    TextureCompressionAttribs Attribs;
+    Attribs.Width     = Width;
+    Attribs.Height    = Height;
+    Attribs.pSrcData  = Pixels.data();
+    Attribs.SrcStride = Width * 4;
+    Attribs.DstFormat = Format;
+    Attribs.pDstData  = CPUBlocks.data();
+    Attribs.DstStride = Width / 4 * GetTextureFormatAttribs(Format).ComponentSize;
+
+    StartTime = Clock::now();
+    ASSERT_TRUE(CompressTexture(Attribs));
+    const auto CPUSeconds = std::chrono::duration<double>{Clock::now() - StartTime}.count();
+
+    const auto MPixels = double{Width} * Height / 1e+6;
+    LOG_INFO_MESSAGE("GPU texture compressor | ", GetTextureFormatAttribs(Format).Name, ": GPU ", MPixels * NumIterations / GPUSeconds,
+                     " MPix/s, CPU (single thread) ", MPixels / CPUSeconds, " MPix/s");
+}
+
+INSTANTIATE_TEST_SUITE_P(GPUTextureCompressor,
+                         GPUTextureCompressorTest,
+                         testing::Values(TEX_FORMAT_BC1_UNORM,
+                                         TEX_FORMAT_BC3_UNORM,
+                                         TEX_FORMAT_BC4_UNORM,
+                                         TEX_FORMAT_BC5_UNORM,
+                                         TEX_FORMAT_BC7_UNORM),
+                         [](const testing::TestParamInfo<TEXTURE_FORMAT>& info) {
+                             return std::string{GetTextureFormatAttribs(info.param).Name};
+                         });
+
+} // namespace
@@ -26,6 +26,7 @@
  */
 
 #include "TestingEnvironment.hpp"
+#include "Align.hpp"
 
 #include "gtest/gtest.h"
 
@@ -130,4 +131,192 @@ TEST(GenerateMipsTest, GenerateMips)
     }
 }
 
+RefCntAutoPtr<ITexture> CreateCheckerboardTexture(TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height, Uint32 ArraySize)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const bool IsFloat = Format == TEX_FORMAT_RGBA32_FLOAT;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Checkerboard mips generation test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Format    = Format;
+    TexDesc.Width     = Width;
+    TexDesc.Height    = Height;
+    TexDesc.ArraySize = ArraySize;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.MipLevels = 0;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+
+    const Uint32 TexelSize = IsFloat ? 16 : 4;
+
+    std::vector<Uint8> Checkerboard(size_t{TexDesc.Width} * TexDesc.Height * TexelSize);
+    for (Uint32 y = 0; y < TexDesc.Height; ++y)
+    {
+        for (Uint32 x = 0; x < TexDesc.Width; ++x)
+        {
+            const bool IsWhite = ((x ^ y) & 0x01) != 0;
+            auto*      pTexel  = &Checkerboard[(size_t{y} * TexDesc.Width + x) * TexelSize];
+            if (IsFloat)
+            {
+                float* pColor = reinterpret_cast<float*>(pTexel);
+                pColor[0] = pColor[1] = pColor[2] = IsWhite ? 1.f : 0.f;
+                pColor[3]                         = 1.f;
+            }
+            else
+            {
+                pTexel[0] = pTexel[1] = pTexel[2] = IsWhite ? 255 : 0;
+                pTexel[3]                         = 255;
+            }
+        }
+    }
+
+    RefCntAutoPtr<ITexture> pTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+    if (!pTex)
+        return pTex;
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        TextureSubResData SubresData{Checkerboard.data(), TexDesc.Width * TexelSize};
+        pContext->UpdateTexture(pTex, 0, slice, Box{0, TexDesc.Width, 0, TexDesc.Height}, SubresData,
+                                RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    return pTex;
+}
+
+// The bottom mip level of a checkerboard pattern must be the average of both colors
+void VerifyCheckerboardBottomMip(ITexture* pTex)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& TexDesc = pTex->GetDesc();
+    const bool  IsFloat = TexDesc.Format == TEX_FORMAT_RGBA32_FLOAT;
+
+    TextureDesc StagingDesc;
+    StagingDesc.Name           = "Mips generation staging texture";
+    StagingDesc.Type           = RESOURCE_DIM_TEX_2D;
+    StagingDesc.Format         = TexDesc.Format;
+    StagingDesc.Width          = 1;
+    StagingDesc.Height         = 1;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr) << "Failed to create staging texture: " << StagingDesc;
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        CopyTextureAttribs CopyAttribs{pTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        CopyAttribs.SrcMipLevel = TexDesc.MipLevels - 1;
+        CopyAttribs.SrcSlice    = slice;
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 c = 0; c < 4; ++c)
+        {
+            const float Expected = c < 3 ? 0.5f : 1.f;
+            const float Actual   = IsFloat ?
+                static_cast<const float*>(MappedData.pData)[c] :
+                static_cast<float>(static_cast<const Uint8*>(MappedData.pData)[c]) / 255.f;
+            EXPECT_NEAR(Actual, Expected, 2.f / 255.f) << "Slice " << slice << ", channel " << c << ": " << TexDesc;
+        }
+        pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+    }
+}
+
+// Power-of-two textures are processed by the single-pass path in D3D12 and Vulkan backends
+TEST(GenerateMipsTest, PowerOfTwoCheckerboard)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    TEXTURE_FORMAT TestFormats[] = //
+        {
+            TEX_FORMAT_RGBA8_UNORM,
+            TEX_FORMAT_RGBA32_FLOAT //
+        };
+
+    for (size_t f = 0; f < _countof(TestFormats); ++f)
+    {
+        auto pTex = CreateCheckerboardTexture(TestFormats[f], 1024, 512, 2);
+        ASSERT_NE(pTex, nullptr) << "Failed to create texture";
+
+        pContext->GenerateMips(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+        VerifyCheckerboardBottomMip(pTex);
+    }
+}
+
+TEST(GenerateMipsTest, Batch)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    struct TexInfo
+    {
+        TEXTURE_FORMAT Format;
+        Uint32         Width;
+        Uint32         Height;
+        Uint32         ArraySize;
+    };
+    const TexInfo TestTextures[] = //
+        {
+            {TEX_FORMAT_RGBA8_UNORM, 512, 512, 1},
+            {TEX_FORMAT_RGBA32_FLOAT, 256, 128, 3},
+            {TEX_FORMAT_RGBA8_UNORM, 128 + 6, 128 + 5, 1}, // Non-power-of-two texture is processed separately
+            {TEX_FORMAT_RGBA8_UNORM, 64, 256, 2},
+            {TEX_FORMAT_RGBA32_FLOAT, 1024, 1024, 1} //
+        };
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures;
+    std::vector<ITextureView*>           Views;
+    for (const auto& Info : TestTextures)
+    {
+        auto pTex = CreateCheckerboardTexture(Info.Format, Info.Width, Info.Height, Info.ArraySize);
+        ASSERT_NE(pTex, nullptr) << "Failed to create texture";
+        Views.push_back(pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        Textures.emplace_back(std::move(pTex));
+    }
+
+    pContext->GenerateMipsBatch(Views.data(), static_cast<Uint32>(Views.size()));
+
+    for (size_t i = 0; i < Textures.size(); ++i)
+    {
+        if (IsPowerOfTwo(TestTextures[i].Width) && IsPowerOfTwo(TestTextures[i].Height))
+            VerifyCheckerboardBottomMip(Textures[i]);
+    }
+}
+
+// Regenerating the full mip chain of a large texture must produce the same result every time,
+// so that mips written by the previous generation do not leak into the next one
+TEST(GenerateMipsTest, RegenerateLargeTexture)
+{
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    auto pTex = CreateCheckerboardTexture(TEX_FORMAT_RGBA8_UNORM, 2048, 2048, 1);
+    ASSERT_NE(pTex, nullptr) << "Failed to create texture";
+    auto* pSRV = pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        pContext->GenerateMips(pSRV);
+        VerifyCheckerboardBottomMip(pTex);
+    }
+}
+
 } // namespace
@@ -0,0 +1,272 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "HiZOcclusionCuller.hpp"
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct UAVBuffer
+{
+    RefCntAutoPtr<IBuffer>     pBuffer;
+    RefCntAutoPtr<IBufferView> pUAV;
+};
+
+UAVBuffer CreateUAVBuffer(Uint32 NumElements, BIND_FLAGS ExtraBindFlags)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Hi-Z culler test buffer";
+    BuffDesc.uiSizeInBytes     = NumElements * Uint32{sizeof(Uint32)};
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS | ExtraBindFlags;
+    BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+
+    UAVBuffer Buff;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &Buff.pBuffer);
+    if (!Buff.pBuffer)
+        return Buff;
+
+    BufferViewDesc ViewDesc;
+    ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+    Buff.pBuffer->CreateView(ViewDesc, &Buff.pUAV);
+
+    return Buff;
+}
+
+std::vector<Uint32> ReadBufferData(IBuffer* pBuffer, size_t NumElements)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Hi-Z culler test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = static_cast<Uint32>(NumElements * sizeof(Uint32));
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    if (!pStagingBuffer)
+    {
+        ADD_FAILURE() << "Failed to create staging buffer";
+        return {};
+    }
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData == nullptr)
+    {
+        ADD_FAILURE() << "Failed to map staging buffer";
+        return {};
+    }
+    const auto* pValues = static_cast<const Uint32*>(pData);
+    std::vector<Uint32> Values{pValues, pValues + NumElements};
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    return Values;
+}
+
+class HiZOcclusionCullerTest : public testing::Test
+{
+protected:
+    static void TearDownTestSuite()
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+            GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+        // The camera looks along +Z, the visible volume is [-1, 1] x [-1, 1] x [0, 10]
+        ViewProj = float4x4::Ortho(2, 2, 0, 10, pDevice->GetDeviceInfo().IsGLDevice());
+
+        Objects.resize(6);
+        // In front of the occluder
+        Objects[0].BoundsMin = float3{-0.2f, -0.2f, 1};
+        Objects[0].BoundsMax = float3{+0.2f, +0.2f, 2};
+        // Behind the occluder
+        Objects[1].BoundsMin = float3{-0.2f, -0.2f, 7};
+        Objects[1].BoundsMax = float3{+0.2f, +0.2f, 8};
+        // Outside of the frustum
+        Objects[2].BoundsMin = float3{3, -0.2f, 1};
+        Objects[2].BoundsMax = float3{4, +0.2f, 2};
+        // Empty draw
+        Objects[3].BoundsMin = float3{-0.2f, -0.2f, 1};
+        Objects[3].BoundsMax = float3{+0.2f, +0.2f, 2};
+        // Intersects the occluder
+        Objects[4].BoundsMin = float3{-0.5f, -0.5f, 4};
+        Objects[4].BoundsMax = float3{+0.5f, +0.5f, 6};
+        // Small object in the corner behind the occluder
+        Objects[5].BoundsMin = float3{0.8f, 0.8f, 8};
+        Objects[5].BoundsMax = float3{0.9f, 0.9f, 9};
+
+        for (Uint32 i = 0; i < Objects.size(); ++i)
+        {
+            auto& Obj                 = Objects[i];
+            Obj.IndexCount            = i != 3 ? 3 * (i + 1) : 0;
+            Obj.NumInstances          = i + 1;
+            Obj.FirstIndexLocation    = 10 * i;
+            Obj.BaseVertex            = -static_cast<Int32>(i);
+            Obj.FirstInstanceLocation = 100 * i;
+        }
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Hi-Z culler test objects";
+        BuffDesc.uiSizeInBytes     = static_cast<Uint32>(Objects.size() * sizeof(HiZCullObject));
+        BuffDesc.Usage             = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(HiZCullObject);
+
+        BufferData InitData{Objects.data(), BuffDesc.uiSizeInBytes};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pObjects);
+        ASSERT_NE(pObjects, nullptr);
+
+        DrawArgs = CreateUAVBuffer(static_cast<Uint32>(Objects.size()) * 5, BIND_INDIRECT_DRAW_ARGS);
+        Count    = CreateUAVBuffer(1, BIND_NONE);
+        ASSERT_TRUE(DrawArgs.pUAV && Count.pUAV);
+    }
+
+    HiZCullAttribs GetCullAttribs()
+    {
+        HiZCullAttribs Attribs;
+        Attribs.pObjectsSRV  = pObjects->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+        Attribs.NumObjects   = static_cast<Uint32>(Objects.size());
+        Attribs.ViewProj     = ViewProj;
+        Attribs.HiZViewProj  = ViewProj;
+        Attribs.pDrawArgsUAV = DrawArgs.pUAV;
+        Attribs.pCountUAV    = Count.pUAV;
+        return Attribs;
+    }
+
+    void VerifyVisibleObjects(const std::vector<Uint32>& RefVisible)
+    {
+        const auto VisibleCount = ReadBufferData(Count.pBuffer, 1);
+        ASSERT_EQ(VisibleCount.size(), 1u);
+        ASSERT_EQ(VisibleCount[0], RefVisible.size());
+
+        const auto Args = ReadBufferData(DrawArgs.pBuffer, RefVisible.size() * 5);
+        for (size_t i = 0; i < RefVisible.size(); ++i)
+        {
+            const auto& Obj = Objects[RefVisible[i]];
+            EXPECT_EQ(Args[i * 5 + 0], Obj.IndexCount) << "Draw " << i;
+            EXPECT_EQ(Args[i * 5 + 1], Obj.NumInstances) << "Draw " << i;
+            EXPECT_EQ(Args[i * 5 + 2], Obj.FirstIndexLocation) << "Draw " << i;
+            EXPECT_EQ(static_cast<Int32>(Args[i * 5 + 3]), Obj.BaseVertex) << "Draw " << i;
+            EXPECT_EQ(Args[i * 5 + 4], Obj.FirstInstanceLocation) << "Draw " << i;
+        }
+    }
+
+    float4x4                   ViewProj;
+    std::vector<HiZCullObject> Objects;
+    RefCntAutoPtr<IBuffer>     pObjects;
+    UAVBuffer                  DrawArgs;
+    UAVBuffer                  Count;
+};
+
+TEST_F(HiZOcclusionCullerTest, FrustumCulling)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    HiZOcclusionCuller Culler{pEnv->GetDevice()};
+    EXPECT_FALSE(Culler.IsHiZReady());
+
+    // Without the pyramid, only the frustum test is performed
+    Culler.Cull(pContext, GetCullAttribs());
+    VerifyVisibleObjects({0, 1, 4, 5});
+}
+
+TEST_F(HiZOcclusionCullerTest, OcclusionCulling)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    // Odd dimensions exercise the extra column and row of the downsampling kernel
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Hi-Z culler test depth buffer";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 67;
+    TexDesc.Height    = 45;
+    TexDesc.Format    = TEX_FORMAT_D32_FLOAT;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_DEPTH_STENCIL | BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pDepth;
+    pDevice->CreateTexture(TexDesc, nullptr, &pDepth);
+    ASSERT_NE(pDepth, nullptr);
+
+    // The occluder covers the whole screen at z = 5
+    auto* pDSV = pDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+    pContext->SetRenderTargets(0, nullptr, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 0.5f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+    HiZOcclusionCuller Culler{pDevice};
+    Culler.BuildHiZ(pContext, pDepth->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+    ASSERT_TRUE(Culler.IsHiZReady());
+    const auto& HiZDesc = Culler.GetHiZTexture()->GetDesc();
+    EXPECT_EQ(HiZDesc.Width, TexDesc.Width);
+    EXPECT_EQ(HiZDesc.Height, TexDesc.Height);
+
+    Culler.Cull(pContext, GetCullAttribs());
+    VerifyVisibleObjects({0, 4});
+
+    auto Attribs          = GetCullAttribs();
+    Attribs.TestOcclusion = false;
+    Culler.Cull(pContext, Attribs);
+    VerifyVisibleObjects({0, 1, 4, 5});
+
+    Culler.InvalidateHiZ();
+    Culler.Cull(pContext, GetCullAttribs());
+    VerifyVisibleObjects({0, 1, 4, 5});
+}
+
+} // namespace
@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<ITexture> CreateMemorylessTexture(TEXTURE_FORMAT Format, BIND_FLAGS BindFlags, const char* Name)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = Name;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.Format    = Format;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BindFlags;
+    TexDesc.MiscFlags = MISC_TEXTURE_FLAG_MEMORYLESS;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    return pTexture;
+}
+
+TEST(MemorylessTextureTest, CreateAndClear)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pRT = CreateMemorylessTexture(TEX_FORMAT_RGBA8_UNORM, BIND_RENDER_TARGET, "Memoryless render target");
+    ASSERT_NE(pRT, nullptr);
+    auto pDS = CreateMemorylessTexture(TEX_FORMAT_D32_FLOAT, BIND_DEPTH_STENCIL, "Memoryless depth buffer");
+    ASSERT_NE(pDS, nullptr);
+
+    ITextureView* pRTV = pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+    ITextureView* pDSV = pDS->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+
+    // Memoryless textures may only be cleared while they are bound as attachments
+    pContext->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const float ClearColor[] = {0.25f, 0.5f, 0.75f, 1.f};
+    pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
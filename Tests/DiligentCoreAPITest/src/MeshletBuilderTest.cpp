@@ -0,0 +1,296 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MeshletBuilder.hpp"
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// The mesh shader marks the meshlets it receives from the culling shader
+const char* MeshletCullingTest_MS = R"(
+struct MeshletPayload
+{
+    uint MeshletIndices[AS_GROUP_SIZE];
+};
+
+struct VSOutput
+{
+    float4 Pos : SV_Position;
+};
+
+RWBuffer</* format = r32ui */ uint> g_Visible;
+
+[numthreads(1, 1, 1)]
+[outputtopology("triangle")]
+void main(in  uint                   GroupId : SV_GroupID,
+          in  payload MeshletPayload Payload,
+          out indices uint3          Tris[1],
+          out vertices VSOutput      Verts[3])
+{
+    SetMeshOutputCounts(0, 0);
+    g_Visible[Payload.MeshletIndices[GroupId]] = 1u;
+}
+)";
+
+const char* MeshletCullingTest_PS = R"(
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return float4(0.0, 0.0, 0.0, 0.0);
+}
+)";
+
+bool IsSphereVisible(const MeshletCullingConstants& Constants, const MeshletBounds& Bounds, float Radius)
+{
+    for (const auto& Plane : Constants.FrustumPlanes)
+    {
+        if (dot(Bounds.Center, float3{Plane.x, Plane.y, Plane.z}) + Plane.w < -Radius)
+            return false;
+    }
+    return true;
+}
+
+TEST(MeshletBuilderTest, AmplificationShaderCulling)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.MeshShaders)
+    {
+        GTEST_SKIP() << "Mesh shader is not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pSwapChain = pEnv->GetSwapChain();
+    auto* pContext   = pEnv->GetDeviceContext();
+
+    // Grid in the XY plane whose triangles face +Z
+    constexpr Uint32    GridSize = 64;
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+    for (Uint32 y = 0; y <= GridSize; ++y)
+    {
+        for (Uint32 x = 0; x <= GridSize; ++x)
+            Positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.f);
+    }
+    for (Uint32 y = 0; y < GridSize; ++y)
+    {
+        for (Uint32 x = 0; x < GridSize; ++x)
+        {
+            const Uint32 v0 = y * (GridSize + 1) + x;
+            const Uint32 v2 = v0 + GridSize + 1;
+            Indices.insert(Indices.end(), {v0, v0 + 1, v2, v2, v0 + 1, v2 + 1});
+        }
+    }
+
+    MeshletBuildAttribs BuildAttribs;
+    BuildAttribs.pIndices    = Indices.data();
+    BuildAttribs.NumIndices  = static_cast<Uint32>(Indices.size());
+    BuildAttribs.pPositions  = Positions.data();
+    BuildAttribs.NumVertices = static_cast<Uint32>(Positions.size());
+
+    MeshletData Meshlets;
+    ASSERT_TRUE(BuildMeshlets(BuildAttribs, Meshlets));
+    const auto NumMeshlets = static_cast<Uint32>(Meshlets.Meshlets.size());
+
+    // The camera above the corner of the grid looks down and only sees a part of it
+    const float3 CameraPos{16, 16, 20};
+    const auto   View = float4x4::Translation(-CameraPos) * float4x4::RotationX(PI_F);
+    const auto   Proj = float4x4::Projection(PI_F / 2.f, 1.f, 0.1f, 100.f, pDevice->GetDeviceInfo().IsGLDevice());
+
+    MeshletCullingConstants Constants;
+    ComputeMeshletCullingConstants(View * Proj, CameraPos, NumMeshlets, pDevice->GetDeviceInfo().IsGLDevice(), Constants);
+
+    RefCntAutoPtr<IBuffer> pConstants;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Meshlet culling constants";
+        BuffDesc.uiSizeInBytes = sizeof(Constants);
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_UNIFORM_BUFFER;
+        BufferData InitData{&Constants, sizeof(Constants)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pConstants);
+        ASSERT_NE(pConstants, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pBounds;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Meshlet bounds";
+        BuffDesc.uiSizeInBytes     = static_cast<Uint32>(sizeof(MeshletBounds) * NumMeshlets);
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_SHADER_RESOURCE;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(MeshletBounds);
+        BufferData InitData{Meshlets.Bounds.data(), BuffDesc.uiSizeInBytes};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pBounds);
+        ASSERT_NE(pBounds, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer>     pVisible;
+    RefCntAutoPtr<IBufferView> pVisibleUAV;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Visible meshlets";
+        BuffDesc.uiSizeInBytes     = NumMeshlets * Uint32{sizeof(Uint32)};
+        BuffDesc.Usage             = USAGE_DEFAULT;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+        std::vector<Uint32> Zeros(NumMeshlets);
+        BufferData          InitData{Zeros.data(), BuffDesc.uiSizeInBytes};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pVisible);
+        ASSERT_NE(pVisible, nullptr);
+
+        BufferViewDesc ViewDesc;
+        ViewDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+        ViewDesc.Format.ValueType     = VT_UINT32;
+        ViewDesc.Format.NumComponents = 1;
+        pVisible->CreateView(ViewDesc, &pVisibleUAV);
+        ASSERT_NE(pVisibleUAV, nullptr);
+    }
+
+    ShaderMacro Macros[] = {{"AS_GROUP_SIZE", "32"}, {}};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = SHADER_COMPILER_DXC;
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Macros                     = Macros;
+
+    RefCntAutoPtr<IShader> pAS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_AMPLIFICATION;
+        ShaderCI.Desc.Name       = "Meshlet culling test - AS";
+        ShaderCI.Source          = GetMeshletCullingShaderSource();
+        pDevice->CreateShader(ShaderCI, &pAS);
+        ASSERT_NE(pAS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pMS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_MESH;
+        ShaderCI.Desc.Name       = "Meshlet culling test - MS";
+        ShaderCI.Source          = MeshletCullingTest_MS;
+        pDevice->CreateShader(ShaderCI, &pMS);
+        ASSERT_NE(pMS, nullptr);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Meshlet culling test - PS";
+        ShaderCI.Source          = MeshletCullingTest_PS;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSOCreateInfo.PSODesc.Name         = "Meshlet culling test";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_MESH;
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_UNDEFINED; // unused
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pAS = pAS;
+    PSOCreateInfo.pMS = pMS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_AMPLIFICATION, "cbMeshletCulling")->Set(pConstants);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_AMPLIFICATION, "g_MeshletBounds")->Set(pBounds->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pPSO->GetStaticVariableByName(SHADER_TYPE_MESH, "g_Visible")->Set(pVisibleUAV);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+    pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    pContext->SetPipelineState(pPSO);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    DrawMeshAttribs DrawAttrs{(NumMeshlets + 31) / 32, DRAW_FLAG_VERIFY_ALL};
+    pContext->DrawMesh(DrawAttrs);
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Visible meshlets staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.uiSizeInBytes  = NumMeshlets * Uint32{sizeof(Uint32)};
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+    }
+    pContext->CopyBuffer(pVisible, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, NumMeshlets * Uint32{sizeof(Uint32)}, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    const std::vector<Uint32> Visible{static_cast<const Uint32*>(pData), static_cast<const Uint32*>(pData) + NumMeshlets};
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    Uint32 NumVisible = 0;
+    for (Uint32 m = 0; m < NumMeshlets; ++m)
+    {
+        const auto& Bounds = Meshlets.Bounds[m];
+        // The camera sees the front faces, so only the frustum test may cull the meshlet.
+        // Meshlets that touch the frustum planes are skipped as the result depends on precision.
+        const auto IsVisible   = IsSphereVisible(Constants, Bounds, Bounds.Radius * 0.99f);
+        const auto IsAmbiguous = IsVisible != IsSphereVisible(Constants, Bounds, Bounds.Radius * 1.01f);
+        if (!IsAmbiguous)
+        {
+            EXPECT_EQ(Visible[m], IsVisible ? 1u : 0u) << "Meshlet " << m;
+        }
+        NumVisible += Visible[m];
+    }
+    EXPECT_GT(NumVisible, 0u);
+    EXPECT_LT(NumVisible, NumMeshlets);
+}
+
+} // namespace
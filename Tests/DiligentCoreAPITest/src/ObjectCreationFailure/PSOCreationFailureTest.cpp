@@ -1511,5 +1511,72 @@ TEST_F(PSOCreationFailureTest, NonSeparablePrograms_SeparateImmutableSamplers)
     TestCreatePSOFailure(PsoCI, "there are separate immutable samplers with the name 'g_Texture_sampler' in shader stages SHADER_TYPE_PIXEL and SHADER_TYPE_VERTEX");
 }
 
+TEST_F(PSOCreationFailureTest, SpecializationConstantsNotSupported)
+{
+    if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - Specialization Constants Not Supported")};
+
+    const Uint32           Value = 1;
+    SpecializationConstant SpecConst{"g_Value", SHADER_TYPE_COMPUTE, sizeof(Value), &Value};
+    PsoCI.pSpecializationConstants   = &SpecConst;
+    PsoCI.NumSpecializationConstants = 1;
+    TestCreatePSOFailure(PsoCI, "Specialization constants are not supported by this device");
+}
+
+TEST_F(PSOCreationFailureTest, NullSpecializationConstantName)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - Null Specialization Constant Name")};
+
+    const Uint32           Value = 1;
+    SpecializationConstant SpecConst{nullptr, SHADER_TYPE_COMPUTE, sizeof(Value), &Value};
+    PsoCI.pSpecializationConstants   = &SpecConst;
+    PsoCI.NumSpecializationConstants = 1;
+    TestCreatePSOFailure(PsoCI, "pSpecializationConstants[0].Name must not be null");
+}
+
+TEST_F(PSOCreationFailureTest, NullSpecializationConstantData)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - Null Specialization Constant Data")};
+
+    SpecializationConstant SpecConst{"g_Value", SHADER_TYPE_COMPUTE, 4, nullptr};
+    PsoCI.pSpecializationConstants   = &SpecConst;
+    PsoCI.NumSpecializationConstants = 1;
+    TestCreatePSOFailure(PsoCI, "pSpecializationConstants[0].pData must not be null");
+}
+
+TEST_F(PSOCreationFailureTest, OverlappingSpecializationConstants)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - Overlapping Specialization Constants")};
+
+    const Uint32           Value = 1;
+    SpecializationConstant SpecConsts[] //
+        {
+            SpecializationConstant{"g_Value", SHADER_TYPE_COMPUTE, sizeof(Value), &Value},
+            SpecializationConstant{"g_Value", SHADER_TYPE_COMPUTE, sizeof(Value), &Value} //
+        };
+    PsoCI.pSpecializationConstants   = SpecConsts;
+    PsoCI.NumSpecializationConstants = _countof(SpecConsts);
+    TestCreatePSOFailure(PsoCI, "Shader stages of multiple specialization constants with name 'g_Value' overlap");
+}
+
 
 } // namespace
@@ -0,0 +1,300 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelPrimitives.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "FastRand.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct TestBuffer
+{
+    RefCntAutoPtr<IBuffer>     pBuffer;
+    RefCntAutoPtr<IBufferView> pSRV;
+    RefCntAutoPtr<IBufferView> pUAV;
+};
+
+TestBuffer CreateTestBuffer(const std::vector<Uint32>& Data)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Parallel primitives test buffer";
+    BuffDesc.uiSizeInBytes     = static_cast<Uint32>(Data.size() * sizeof(Uint32));
+    BuffDesc.Usage             = USAGE_DEFAULT;
+    BuffDesc.BindFlags         = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+    BuffDesc.ElementByteStride = sizeof(Uint32);
+
+    BufferData InitData{Data.data(), BuffDesc.uiSizeInBytes};
+
+    TestBuffer Buff;
+    pDevice->CreateBuffer(BuffDesc, &InitData, &Buff.pBuffer);
+    if (!Buff.pBuffer)
+        return Buff;
+
+    BufferViewDesc ViewDesc;
+    ViewDesc.Format.ValueType     = VT_UINT32;
+    ViewDesc.Format.NumComponents = 1;
+
+    ViewDesc.ViewType = BUFFER_VIEW_SHADER_RESOURCE;
+    Buff.pBuffer->CreateView(ViewDesc, &Buff.pSRV);
+    ViewDesc.ViewType = BUFFER_VIEW_UNORDERED_ACCESS;
+    Buff.pBuffer->CreateView(ViewDesc, &Buff.pUAV);
+
+    return Buff;
+}
+
+std::vector<Uint32> ReadBufferData(IBuffer* pBuffer, size_t NumElements)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Parallel primitives test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = static_cast<Uint32>(NumElements * sizeof(Uint32));
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    if (!pStagingBuffer)
+    {
+        ADD_FAILURE() << "Failed to create staging buffer";
+        return {};
+    }
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    if (pData == nullptr)
+    {
+        ADD_FAILURE() << "Failed to map staging buffer";
+        return {};
+    }
+    const auto* pValues = static_cast<const Uint32*>(pData);
+    std::vector<Uint32> Values{pValues, pValues + NumElements};
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+
+    return Values;
+}
+
+std::vector<Uint32> GenerateData(size_t NumElements, Uint32 Mask, unsigned int Seed)
+{
+    FastRand Rnd{Seed};
+
+    std::vector<Uint32> Data(NumElements);
+    for (auto& Val : Data)
+        Val = ((Rnd() << 17u) ^ (Rnd() << 8u) ^ Rnd()) & Mask;
+    return Data;
+}
+
+class ParallelPrimitivesTest : public testing::TestWithParam<bool>
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+            return;
+
+        ParallelPrimitivesCreateInfo CI;
+        CI.EnableWaveOps = true;
+        pPrimitivesWaveOps.reset(new ParallelPrimitives{pDevice, CI});
+        CI.EnableWaveOps = false;
+        pPrimitivesNoWaveOps.reset(new ParallelPrimitives{pDevice, CI});
+    }
+
+    static void TearDownTestSuite()
+    {
+        pPrimitivesWaveOps.reset();
+        pPrimitivesNoWaveOps.reset();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        if (!pPrimitivesWaveOps)
+            GTEST_SKIP() << "Compute shaders are not supported by this device";
+
+        const auto UseWaveOps = GetParam();
+        if (UseWaveOps && !pPrimitivesWaveOps->UsesWaveOps())
+            GTEST_SKIP() << "Wave operations are not supported by this device";
+
+        pPrimitives = UseWaveOps ? pPrimitivesWaveOps.get() : pPrimitivesNoWaveOps.get();
+    }
+
+    static std::unique_ptr<ParallelPrimitives> pPrimitivesWaveOps;
+    static std::unique_ptr<ParallelPrimitives> pPrimitivesNoWaveOps;
+
+    ParallelPrimitives* pPrimitives = nullptr;
+};
+
+std::unique_ptr<ParallelPrimitives> ParallelPrimitivesTest::pPrimitivesWaveOps;
+std::unique_ptr<ParallelPrimitives> ParallelPrimitivesTest::pPrimitivesNoWaveOps;
+
+// Sizes that exercise a single partial block, several blocks and several scan levels
+const size_t TestSizes[] = {1, 1000, 1024, 4099, 1500007};
+
+TEST_P(ParallelPrimitivesTest, Reduce)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    for (auto NumElements : TestSizes)
+    {
+        // Limit the values so that the sum does not overflow
+        const auto Input  = GenerateData(NumElements, 0x3FF, static_cast<unsigned int>(NumElements));
+        auto       InBuff = CreateTestBuffer(Input);
+        auto       Result = CreateTestBuffer({0xDEADBEEF});
+        ASSERT_TRUE(InBuff.pBuffer && Result.pBuffer);
+
+        const Uint32 RefSum = std::accumulate(Input.begin(), Input.end(), Uint32{0});
+        const Uint32 RefMin = *std::min_element(Input.begin(), Input.end());
+        const Uint32 RefMax = *std::max_element(Input.begin(), Input.end());
+
+        pPrimitives->Reduce(pContext, InBuff.pSRV, Result.pUAV, static_cast<Uint32>(NumElements), PARALLEL_REDUCE_OP_SUM);
+        EXPECT_EQ(ReadBufferData(Result.pBuffer, 1), std::vector<Uint32>{RefSum}) << "Num elements: " << NumElements;
+
+        pPrimitives->Reduce(pContext, InBuff.pSRV, Result.pUAV, static_cast<Uint32>(NumElements), PARALLEL_REDUCE_OP_MIN);
+        EXPECT_EQ(ReadBufferData(Result.pBuffer, 1), std::vector<Uint32>{RefMin}) << "Num elements: " << NumElements;
+
+        pPrimitives->Reduce(pContext, InBuff.pSRV, Result.pUAV, static_cast<Uint32>(NumElements), PARALLEL_REDUCE_OP_MAX);
+        EXPECT_EQ(ReadBufferData(Result.pBuffer, 1), std::vector<Uint32>{RefMax}) << "Num elements: " << NumElements;
+    }
+}
+
+TEST_P(ParallelPrimitivesTest, ExclusiveScan)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    for (auto NumElements : TestSizes)
+    {
+        const auto Input   = GenerateData(NumElements, 0xFF, static_cast<unsigned int>(NumElements));
+        auto       InBuff  = CreateTestBuffer(Input);
+        auto       OutBuff = CreateTestBuffer(std::vector<Uint32>(NumElements));
+        ASSERT_TRUE(InBuff.pBuffer && OutBuff.pBuffer);
+
+        std::vector<Uint32> RefOutput(NumElements);
+        Uint32              Sum = 0;
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            RefOutput[i] = Sum;
+            Sum += Input[i];
+        }
+
+        pPrimitives->ExclusiveScan(pContext, InBuff.pSRV, OutBuff.pUAV, static_cast<Uint32>(NumElements));
+        EXPECT_EQ(ReadBufferData(OutBuff.pBuffer, NumElements), RefOutput) << "Num elements: " << NumElements;
+    }
+}
+
+TEST_P(ParallelPrimitivesTest, Compact)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    for (auto NumElements : TestSizes)
+    {
+        const auto Input = GenerateData(NumElements, 0xFFFFFFFF, static_cast<unsigned int>(NumElements));
+        const auto Flags = GenerateData(NumElements, 0x01, static_cast<unsigned int>(NumElements) + 1);
+
+        auto InBuff    = CreateTestBuffer(Input);
+        auto FlagsBuff = CreateTestBuffer(Flags);
+        auto OutBuff   = CreateTestBuffer(std::vector<Uint32>(NumElements));
+        auto CountBuff = CreateTestBuffer({0xDEADBEEF});
+        ASSERT_TRUE(InBuff.pBuffer && FlagsBuff.pBuffer && OutBuff.pBuffer && CountBuff.pBuffer);
+
+        std::vector<Uint32> RefOutput;
+        for (size_t i = 0; i < NumElements; ++i)
+        {
+            if (Flags[i] != 0)
+                RefOutput.push_back(Input[i]);
+        }
+
+        pPrimitives->Compact(pContext, InBuff.pSRV, FlagsBuff.pSRV, OutBuff.pUAV, CountBuff.pUAV, static_cast<Uint32>(NumElements));
+        EXPECT_EQ(ReadBufferData(CountBuff.pBuffer, 1), std::vector<Uint32>{static_cast<Uint32>(RefOutput.size())}) << "Num elements: " << NumElements;
+        if (!RefOutput.empty())
+        {
+            EXPECT_EQ(ReadBufferData(OutBuff.pBuffer, RefOutput.size()), RefOutput) << "Num elements: " << NumElements;
+        }
+    }
+}
+
+TEST_P(ParallelPrimitivesTest, RadixSort)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    for (auto NumElements : TestSizes)
+    {
+        for (Uint32 NumKeyBits : {32u, 12u})
+        {
+            const auto Keys = GenerateData(NumElements, NumKeyBits < 32 ? (1u << NumKeyBits) - 1u : 0xFFFFFFFF, static_cast<unsigned int>(NumElements));
+
+            std::vector<Uint32> Values(NumElements);
+            std::iota(Values.begin(), Values.end(), 0u);
+
+            auto KeysBuff   = CreateTestBuffer(Keys);
+            auto ValuesBuff = CreateTestBuffer(Values);
+            ASSERT_TRUE(KeysBuff.pBuffer && ValuesBuff.pBuffer);
+
+            // The sort is stable, so the values of equal keys must remain in the original order
+            std::vector<Uint32> RefValues = Values;
+            std::stable_sort(RefValues.begin(), RefValues.end(), [&Keys](Uint32 a, Uint32 b) { return Keys[a] < Keys[b]; });
+            std::vector<Uint32> RefKeys(NumElements);
+            for (size_t i = 0; i < NumElements; ++i)
+                RefKeys[i] = Keys[RefValues[i]];
+
+            pPrimitives->RadixSort(pContext, KeysBuff.pUAV, ValuesBuff.pUAV, static_cast<Uint32>(NumElements), NumKeyBits);
+            EXPECT_EQ(ReadBufferData(KeysBuff.pBuffer, NumElements), RefKeys) << "Num elements: " << NumElements << ", key bits: " << NumKeyBits;
+            EXPECT_EQ(ReadBufferData(ValuesBuff.pBuffer, NumElements), RefValues) << "Num elements: " << NumElements << ", key bits: " << NumKeyBits;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ParallelPrimitives,
+                         ParallelPrimitivesTest,
+                         testing::Values(true, false),
+                         [](const testing::TestParamInfo<bool>& info) {
+                             return info.param ? std::string{"WaveOps"} : std::string{"SharedMemory"};
+                         });
+
+} // namespace
@@ -157,6 +157,8 @@ protected:
     };
     static void TestSRBCompatibility(SRB_COMPAT_MODE Mode);
 
+    static void TestVariableTypes(bool CreateSRBBatch);
+
     static RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
 };
 
@@ -182,7 +184,7 @@ RefCntAutoPtr<IShaderSourceInputStreamFactory> PipelineResourceSignatureTest::pS
             pVar->SetMethod(__VA_ARGS__);                                               \
     } while (false)
 
-TEST_F(PipelineResourceSignatureTest, VariableTypes)
+void PipelineResourceSignatureTest::TestVariableTypes(bool CreateSRBBatch)
 {
     auto* const pEnv     = TestingEnvironment::GetInstance();
     auto* const pDevice  = pEnv->GetDevice();
@@ -290,7 +292,29 @@ TEST_F(PipelineResourceSignatureTest, VariableTypes)
     }
 
     RefCntAutoPtr<IShaderResourceBinding> pSRB;
-    pPRS->CreateShaderResourceBinding(&pSRB, true);
+    if (CreateSRBBatch)
+    {
+        constexpr Uint32        NumSRBs = 16;
+        IShaderResourceBinding* ppSRBs[NumSRBs]{};
+        pPRS->CreateShaderResourceBindings(NumSRBs, ppSRBs, true);
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+        {
+            EXPECT_NE(ppSRBs[i], nullptr);
+            if (ppSRBs[i] != nullptr)
+                EXPECT_TRUE(ppSRBs[i]->StaticResourcesInitialized());
+        }
+        // Render with the last SRB in the batch
+        pSRB = ppSRBs[NumSRBs - 1];
+        for (Uint32 i = 0; i < NumSRBs; ++i)
+        {
+            if (ppSRBs[i] != nullptr)
+                ppSRBs[i]->Release();
+        }
+    }
+    else
+    {
+        pPRS->CreateShaderResourceBinding(&pSRB, true);
+    }
     ASSERT_NE(pSRB, nullptr);
 
     SET_SRB_VAR(pSRB, SHADER_TYPE_VERTEX, "g_Tex2D_Mut", Set, RefTextures.GetViewObjects(Tex2D_MutIdx)[0]);
@@ -313,6 +337,16 @@ TEST_F(PipelineResourceSignatureTest, VariableTypes)
 }
 
 
+TEST_F(PipelineResourceSignatureTest, VariableTypes)
+{
+    TestVariableTypes(false);
+}
+
+TEST_F(PipelineResourceSignatureTest, VariableTypes_SRBBatch)
+{
+    TestVariableTypes(true);
+}
+
 TEST_F(PipelineResourceSignatureTest, MultiSignatures)
 {
     auto* const pEnv     = TestingEnvironment::GetInstance();
@@ -1065,6 +1099,76 @@ TEST_F(PipelineResourceSignatureTest, SRBCompatibility2)
     TestSRBCompatibility(SRB_COMPAT_MODE_INSERT_SIGNATURE_TO_MIDDLE);
 }
 
+TEST_F(PipelineResourceSignatureTest, CachedSRB)
+{
+    auto* const pEnv    = TestingEnvironment::GetInstance();
+    auto* const pDevice = pEnv->GetDevice();
+
+    ReferenceTextures RefTextures{
+        3,
+        64, 64,
+        USAGE_DEFAULT,
+        BIND_SHADER_RESOURCE,
+        TEXTURE_VIEW_SHADER_RESOURCE //
+    };
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name = "Cached SRB test";
+
+    // clang-format off
+    PipelineResourceDesc Resources[]
+    {
+        {SHADER_TYPE_PIXEL, "g_Tex2D_Mut",    1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL, "g_Tex2DArr_Mut", 2, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_PIXEL, "g_Tex2D_Dyn",    1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+    };
+    // clang-format on
+    PRSDesc.Resources    = Resources;
+    PRSDesc.NumResources = _countof(Resources);
+
+    RefCntAutoPtr<IPipelineResourceSignature> pPRS;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pPRS);
+    ASSERT_TRUE(pPRS);
+
+    const CachedSRBResource Bindings0[] = {
+        {SHADER_TYPE_PIXEL, "g_Tex2D_Mut", RefTextures.GetViewObjects(0)[0]},
+        {SHADER_TYPE_PIXEL, "g_Tex2DArr_Mut", RefTextures.GetViewObjects(1)[0], 1},
+    };
+    // Same bindings in a different order
+    const CachedSRBResource Bindings1[] = {
+        {SHADER_TYPE_PIXEL, "g_Tex2DArr_Mut", RefTextures.GetViewObjects(1)[0], 1},
+        {SHADER_TYPE_PIXEL, "g_Tex2D_Mut", RefTextures.GetViewObjects(0)[0]},
+    };
+    const CachedSRBResource Bindings2[] = {
+        {SHADER_TYPE_PIXEL, "g_Tex2D_Mut", RefTextures.GetViewObjects(2)[0]},
+        {SHADER_TYPE_PIXEL, "g_Tex2DArr_Mut", RefTextures.GetViewObjects(1)[0], 1},
+    };
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1, pSRB2;
+    pPRS->GetCachedShaderResourceBinding(Bindings0, _countof(Bindings0), &pSRB0);
+    pPRS->GetCachedShaderResourceBinding(Bindings1, _countof(Bindings1), &pSRB1);
+    pPRS->GetCachedShaderResourceBinding(Bindings2, _countof(Bindings2), &pSRB2);
+    ASSERT_TRUE(pSRB0 && pSRB1 && pSRB2);
+
+    EXPECT_EQ(pSRB0, pSRB1);
+    EXPECT_NE(pSRB0, pSRB2);
+    EXPECT_TRUE(pSRB0->StaticResourcesInitialized());
+
+    auto* pTexVar = pSRB0->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2DArr_Mut");
+    ASSERT_NE(pTexVar, nullptr);
+    EXPECT_FALSE(pTexVar->IsBound(0));
+    EXPECT_TRUE(pTexVar->IsBound(1));
+
+    // The cache does not keep the objects alive
+    RefCntWeakPtr<IShaderResourceBinding> pWeakSRB2{pSRB2};
+    pSRB2.Release();
+    EXPECT_FALSE(pWeakSRB2.IsValid());
+
+    pPRS->GetCachedShaderResourceBinding(Bindings2, _countof(Bindings2), &pSRB2);
+    ASSERT_TRUE(pSRB2);
+    EXPECT_NE(pSRB0, pSRB2);
+}
+
 TEST_F(PipelineResourceSignatureTest, GraphicsAndMeshShader)
 {
     auto* pEnv     = TestingEnvironment::GetInstance();
@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main(uint VertId : SV_VertexID) : SV_Position
+{
+    return float4(float(VertId & 1u), float(VertId >> 1u), 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+cbuffer Constants
+{
+    float4 g_Color;
+}
+
+float4 main() : SV_Target
+{
+    return g_Color;
+}
+)";
+
+static const char* CSSource = R"(
+RWTexture2D<float4> g_tex2DUAV;
+
+[numthreads(8, 8, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_tex2DUAV[DTid.xy] = float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(IRenderDevice* pDevice, SHADER_TYPE ShaderType, const char* Name, const char* Source)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = ShaderType;
+    ShaderCI.Desc.Name                  = Name;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+void CreateTestPipelines(IRenderDevice* pDevice)
+{
+    {
+        auto pVS = CreateTestShader(pDevice, SHADER_TYPE_VERTEX, "PSO recorder test VS", VSSource);
+        auto pPS = CreateTestShader(pDevice, SHADER_TYPE_PIXEL, "PSO recorder test PS", PSSource);
+        ASSERT_NE(pVS, nullptr);
+        ASSERT_NE(pPS, nullptr);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                                  = "PSO recorder test graphics pipeline";
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType    = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+        PSOCreateInfo.pVS                                           = pVS;
+        PSOCreateInfo.pPS                                           = pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    {
+        auto pCS = CreateTestShader(pDevice, SHADER_TYPE_COMPUTE, "PSO recorder test CS", CSSource);
+        ASSERT_NE(pCS, nullptr);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = "PSO recorder test compute pipeline";
+        PSOCreateInfo.PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+        PSOCreateInfo.pCS                                        = pCS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+}
+
+TEST(PipelineStateRecorderTest, RecordAndReplay)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (pEnv->GetDevice()->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "OpenGL shaders have no byte code and are not recorded";
+    }
+
+    // Recording is only enabled for a dedicated device so that it does not affect other tests
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    pEnv->CreateDedicatedDevice(
+        [](EngineCreateInfo& EngineCI) {
+            EngineCI.RecordPipelineStates = true;
+        },
+        &pDevice, &pContext);
+    ASSERT_NE(pDevice, nullptr);
+    ASSERT_NE(pContext, nullptr);
+
+    CreateTestPipelines(pDevice);
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    pDevice->GetRecordedPipelineStates(&pArchive);
+    ASSERT_NE(pArchive, nullptr);
+
+    // Identical pipelines must not grow the archive
+    CreateTestPipelines(pDevice);
+
+    RefCntAutoPtr<IDataBlob> pArchive2;
+    pDevice->GetRecordedPipelineStates(&pArchive2);
+    ASSERT_NE(pArchive2, nullptr);
+    EXPECT_EQ(pArchive->GetSize(), pArchive2->GetSize());
+
+    // The archive contains exactly the pipelines created above
+    PipelineStateReplayInfo ReplayInfo;
+    ReplayInfo.pArchive = pArchive;
+    EXPECT_EQ(pDevice->ReplayPipelineStates(ReplayInfo), 2u);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(PipelineStateRecorderTest, DisabledByDefault)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    RefCntAutoPtr<IDataBlob> pArchive;
+    pDevice->GetRecordedPipelineStates(&pArchive);
+    EXPECT_EQ(pArchive, nullptr);
+}
+
+} // namespace
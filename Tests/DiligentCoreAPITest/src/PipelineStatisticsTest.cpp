@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main(uint VertId : SV_VertexID) : SV_Position
+{
+    return float4(float(VertId & 1u), float(VertId >> 1u), 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+float4 main(float4 Pos : SV_Position) : SV_Target
+{
+    return float4(frac(Pos.xy * 0.01), 0.0, 1.0);
+}
+)";
+
+static const char* CSSource = R"(
+RWTexture2D<float4> g_tex2DUAV;
+
+groupshared float4 g_Colors[64];
+
+[numthreads(8, 8, 1)]
+void main(uint3 DTid : SV_DispatchThreadID, uint GI : SV_GroupIndex)
+{
+    g_Colors[GI] = float4(float2(DTid.xy) * 0.01, 0.0, 1.0);
+    GroupMemoryBarrierWithGroupSync();
+    g_tex2DUAV[DTid.xy] = g_Colors[63 - GI];
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(SHADER_TYPE ShaderType, const char* Name, const char* Source)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = ShaderType;
+    ShaderCI.Desc.Name                  = Name;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pEnv->GetDevice()->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+// The statistics are optional, but when they are reported, every stage must be a shader stage of the pipeline.
+void VerifyStatistics(const IPipelineState* pPSO, SHADER_TYPE PipelineStages)
+{
+    Uint32      NumStages   = 0;
+    const auto* pStatistics = pPSO->GetStatistics(NumStages);
+    if (pStatistics == nullptr)
+    {
+        EXPECT_EQ(NumStages, 0u);
+        return;
+    }
+
+    EXPECT_GT(NumStages, 0u);
+    for (Uint32 i = 0; i < NumStages; ++i)
+    {
+        const auto& Stats = pStatistics[i];
+        EXPECT_NE(Stats.ShaderType, SHADER_TYPE_UNKNOWN);
+        EXPECT_EQ(Stats.ShaderType & ~PipelineStages, SHADER_TYPE_UNKNOWN);
+    }
+}
+
+TEST(PipelineStatisticsTest, Graphics)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, "Pipeline statistics test VS", VSSource);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, "Pipeline statistics test PS", PSSource);
+    ASSERT_NE(pVS, nullptr);
+    ASSERT_NE(pPS, nullptr);
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                                  = "Pipeline statistics test graphics pipeline";
+    PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+    PSOCreateInfo.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+    PSOCreateInfo.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+    PSOCreateInfo.pVS                                           = pVS;
+    PSOCreateInfo.pPS                                           = pPS;
+
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        Uint32 NumStages = ~0u;
+        EXPECT_EQ(pPSO->GetStatistics(NumStages), nullptr);
+        EXPECT_EQ(NumStages, 0u);
+    }
+
+    PSOCreateInfo.Flags = PSO_CREATE_FLAG_CAPTURE_STATISTICS;
+    {
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        VerifyStatistics(pPSO, SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL);
+    }
+}
+
+TEST(PipelineStatisticsTest, Compute)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pCS = CreateTestShader(SHADER_TYPE_COMPUTE, "Pipeline statistics test CS", CSSource);
+    ASSERT_NE(pCS, nullptr);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Pipeline statistics test compute pipeline";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.Flags                = PSO_CREATE_FLAG_CAPTURE_STATISTICS;
+    PSOCreateInfo.pCS                  = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    VerifyStatistics(pPSO, SHADER_TYPE_COMPUTE);
+}
+
+} // namespace
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// In Direct3D12, default-usage buffers and small textures are suballocated from
+// placed resource heaps that are reported as memory type 1.
+TEST(PlacedResourceMemoryTest, D3D12Suballocation)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        GTEST_SKIP() << "Placed resource heaps are only used by Direct3D12 backend";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RenderDeviceMemoryStatistics StatsBefore;
+    pDevice->GetMemoryStatistics(StatsBefore);
+    ASSERT_GE(StatsBefore.NumMemoryTypes, 2u);
+    EXPECT_EQ(StatsBefore.MemoryTypeHeaps[1], 1u);
+
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Placed resource test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 32;
+        TexDesc.Height    = 32;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Placed resource test buffer";
+        BuffDesc.uiSizeInBytes = 1024;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage         = USAGE_DEFAULT;
+
+        std::vector<RefCntAutoPtr<IDeviceObject>> Resources;
+        for (Uint32 i = 0; i < 16; ++i)
+        {
+            RefCntAutoPtr<ITexture> pTex;
+            pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+            ASSERT_NE(pTex, nullptr);
+            Resources.emplace_back(pTex);
+
+            RefCntAutoPtr<IBuffer> pBuff;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pBuff);
+            ASSERT_NE(pBuff, nullptr);
+            Resources.emplace_back(pBuff);
+        }
+
+        RenderDeviceMemoryStatistics Stats;
+        pDevice->GetMemoryStatistics(Stats);
+
+        const auto& PlacedStats = Stats.MemoryTypes[1];
+        // 16 textures with 4KB alignment and 16 buffers with 64KB alignment
+        EXPECT_GE(PlacedStats.UsedSize, StatsBefore.MemoryTypes[1].UsedSize + 16 * (4u << 10) + 16 * (64u << 10));
+        EXPECT_GE(PlacedStats.AllocatedSize, PlacedStats.UsedSize);
+        EXPECT_GT(PlacedStats.NumAllocations, 0u);
+        EXPECT_EQ(Stats.Heaps[1].Usage.AllocatedSize, PlacedStats.AllocatedSize);
+    }
+
+    // Allocations are returned to the pages once the GPU is done with the resources
+    pDevice->IdleGPU();
+
+    RenderDeviceMemoryStatistics StatsAfter;
+    pDevice->GetMemoryStatistics(StatsAfter);
+    EXPECT_LE(StatsAfter.MemoryTypes[1].UsedSize, StatsBefore.MemoryTypes[1].UsedSize);
+}
+
+// Empty placed resource heap pages are released until the allocated size does not exceed
+// EngineD3D12CreateInfo::PlacedResourceHeapReserveSize.
+TEST(PlacedResourceMemoryTest, D3D12ReserveSize)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (pEnv->GetDevice()->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_D3D12)
+    {
+        GTEST_SKIP() << "Placed resource heaps are only used by Direct3D12 backend";
+    }
+
+    constexpr Uint32 PageSize   = 1 << 20;
+    constexpr Uint32 BufferSize = PageSize / 4;
+    constexpr Uint32 NumBuffers = 16;
+
+    for (Uint32 ReserveSize : {0u, 2 * PageSize})
+    {
+        RefCntAutoPtr<IRenderDevice>  pDevice;
+        RefCntAutoPtr<IDeviceContext> pContext;
+        pEnv->CreateDedicatedDevice(
+            [ReserveSize](EngineCreateInfo& EngineCI) {
+                auto& EngineD3D12CI                         = static_cast<EngineD3D12CreateInfo&>(EngineCI);
+                EngineD3D12CI.PlacedResourceHeapPageSize    = PageSize;
+                EngineD3D12CI.PlacedResourceHeapReserveSize = ReserveSize;
+            },
+            &pDevice, &pContext);
+        ASSERT_NE(pDevice, nullptr);
+
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name          = "Placed resource reserve test buffer";
+            BuffDesc.uiSizeInBytes = BufferSize;
+            BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+            BuffDesc.Usage         = USAGE_DEFAULT;
+
+            std::vector<RefCntAutoPtr<IBuffer>> Buffers;
+            for (Uint32 i = 0; i < NumBuffers; ++i)
+            {
+                RefCntAutoPtr<IBuffer> pBuff;
+                pDevice->CreateBuffer(BuffDesc, nullptr, &pBuff);
+                ASSERT_NE(pBuff, nullptr);
+                Buffers.emplace_back(std::move(pBuff));
+            }
+
+            RenderDeviceMemoryStatistics Stats;
+            pDevice->GetMemoryStatistics(Stats);
+            EXPECT_GE(Stats.MemoryTypes[1].UsedSize, Uint64{NumBuffers} * BufferSize) << "Reserve size: " << ReserveSize;
+            // All buffers do not fit into the reserved pages
+            EXPECT_GT(Stats.MemoryTypes[1].AllocatedSize, Uint64{ReserveSize}) << "Reserve size: " << ReserveSize;
+            EXPECT_EQ(Stats.MemoryTypes[1].AllocatedSize % PageSize, 0u) << "Reserve size: " << ReserveSize;
+        }
+
+        // The buffers are released and the empty pages are destroyed once the GPU is idle
+        pDevice->IdleGPU();
+
+        RenderDeviceMemoryStatistics Stats;
+        pDevice->GetMemoryStatistics(Stats);
+        EXPECT_EQ(Stats.MemoryTypes[1].UsedSize, 0u) << "Reserve size: " << ReserveSize;
+        EXPECT_EQ(Stats.MemoryTypes[1].AllocatedSize, Uint64{ReserveSize}) << "Reserve size: " << ReserveSize;
+
+        // The reserved pages are reused by new resources
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Placed resource reserve test buffer";
+        BuffDesc.uiSizeInBytes = BufferSize;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage         = USAGE_DEFAULT;
+
+        RefCntAutoPtr<IBuffer> pBuff;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuff);
+        ASSERT_NE(pBuff, nullptr);
+        pDevice->GetMemoryStatistics(Stats);
+        EXPECT_EQ(Stats.MemoryTypes[1].AllocatedSize, std::max(Uint64{ReserveSize}, Uint64{PageSize})) << "Reserve size: " << ReserveSize;
+    }
+}
+
+} // namespace
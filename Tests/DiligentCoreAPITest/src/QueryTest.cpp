@@ -28,6 +28,7 @@
 #include <sstream>
 #include <vector>
 #include <thread>
+#include <chrono>
 
 #include "TestingEnvironment.hpp"
 
@@ -385,6 +386,67 @@ TEST_F(QueryTest, BinaryOcclusion)
     }
 }
 
+TEST_F(QueryTest, ConditionalRendering)
+{
+    const auto& deviceCaps = TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
+    if (!deviceCaps.Features.ConditionalRendering || !deviceCaps.Features.BinaryOcclusionQueries)
+    {
+        GTEST_SKIP() << "Conditional rendering is not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    for (Uint32 q = 0; q < pEnv->GetNumImmediateContexts(); ++q)
+    {
+        auto* pContext = pEnv->GetDeviceContext(q);
+
+        if ((pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_GRAPHICS) != COMMAND_QUEUE_TYPE_GRAPHICS)
+            continue;
+
+        QueryDesc queryDesc;
+        queryDesc.Name = "Conditional rendering test query";
+        queryDesc.Type = QUERY_TYPE_BINARY_OCCLUSION;
+
+        RefCntAutoPtr<IQuery> pVisibleQuery, pOccludedQuery, pResultQuery;
+        pDevice->CreateQuery(queryDesc, &pVisibleQuery);
+        pDevice->CreateQuery(queryDesc, &pOccludedQuery);
+        pDevice->CreateQuery(queryDesc, &pResultQuery);
+        ASSERT_TRUE(pVisibleQuery && pOccludedQuery && pResultQuery);
+
+        pContext->BeginQuery(pVisibleQuery);
+        DrawQuad(pContext);
+        pContext->EndQuery(pVisibleQuery);
+
+        // No draw commands - no samples pass
+        pContext->BeginQuery(pOccludedQuery);
+        pContext->EndQuery(pOccludedQuery);
+
+        for (auto* pPredicate : {pVisibleQuery.RawPtr(), pOccludedQuery.RawPtr()})
+        {
+            ITextureView* pRTVs[] = {sm_pRTV};
+            pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            // The result query counts the samples of the predicated draw command
+            pContext->BeginConditionalRendering(pPredicate);
+            pContext->BeginQuery(pResultQuery);
+            pContext->SetPipelineState(sm_pPSO);
+            pContext->Draw(DrawAttribs{4, DRAW_FLAG_VERIFY_ALL});
+            pContext->EndQuery(pResultQuery);
+            pContext->EndConditionalRendering();
+
+            pContext->WaitForIdle();
+            if (deviceCaps.IsGLDevice())
+                WaitForQuery(pResultQuery);
+
+            QueryDataBinaryOcclusion QueryData;
+            ASSERT_TRUE(pResultQuery->GetData(&QueryData, sizeof(QueryData))) << "Query data must be available after idling the context";
+            EXPECT_EQ(QueryData.AnySamplePassed, pPredicate == pVisibleQuery);
+        }
+    }
+}
+
 TEST_F(QueryTest, Timestamp)
 {
     auto* pEnv    = TestingEnvironment::GetInstance();
@@ -454,6 +516,75 @@ TEST_F(QueryTest, Timestamp)
 }
 
 
+TEST_F(QueryTest, TimestampCalibration)
+{
+    auto*       pEnv       = TestingEnvironment::GetInstance();
+    auto*       pDevice    = pEnv->GetDevice();
+    const auto& deviceCaps = pDevice->GetDeviceInfo();
+    if (!deviceCaps.Features.TimestampQueries)
+    {
+        GTEST_SKIP() << "Timestamp queries are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    const auto GetCPUTime = []() {
+        return std::chrono::duration<double>{std::chrono::steady_clock::now().time_since_epoch()}.count();
+    };
+    // Allowed error of the GPU timestamps mapped to the CPU timeline, in seconds
+    constexpr double Tolerance = 0.005;
+
+    Uint32 NumCalibratedContexts = 0;
+    for (Uint32 q = 0; q < pEnv->GetNumImmediateContexts(); ++q)
+    {
+        auto* pContext = pEnv->GetDeviceContext(q);
+
+        if ((pContext->GetDesc().QueueType & COMMAND_QUEUE_TYPE_GRAPHICS) != COMMAND_QUEUE_TYPE_GRAPHICS)
+            continue;
+
+        const auto           CPUTimeBefore = GetCPUTime();
+        TimestampCalibration Calibration;
+        if (!pContext->GetTimestampCalibration(Calibration))
+            continue;
+        const auto CPUTimeAfter = GetCPUTime();
+        ++NumCalibratedContexts;
+
+        ASSERT_NE(Calibration.GPUFrequency, 0u);
+        // The calibrated CPU time is on the steady_clock timeline
+        const auto CalibCPUTime = static_cast<double>(Calibration.CPUTime) * 1e-9;
+        EXPECT_GE(CalibCPUTime, CPUTimeBefore - Tolerance);
+        EXPECT_LE(CalibCPUTime, CPUTimeAfter + Tolerance);
+
+        QueryDesc queryDesc;
+        queryDesc.Name = "Timestamp calibration query";
+        queryDesc.Type = QUERY_TYPE_TIMESTAMP;
+
+        RefCntAutoPtr<IQuery> pQuery;
+        pDevice->CreateQuery(queryDesc, &pQuery);
+        ASSERT_NE(pQuery, nullptr) << "Failed to create timestamp query";
+
+        pContext->EndQuery(pQuery);
+        pContext->Flush();
+        pContext->WaitForIdle();
+        const auto CPUTimeIdle = GetCPUTime();
+
+        QueryDataTimestamp QueryData;
+        ASSERT_TRUE(pQuery->GetData(&QueryData, sizeof(QueryData))) << "Query data must be available after idling the context";
+        EXPECT_EQ(QueryData.Frequency, Calibration.GPUFrequency);
+
+        // The timestamp was written after the calibration and before the context became idle
+        const auto QueryCPUTime = CalibCPUTime + (static_cast<double>(QueryData.Counter) - static_cast<double>(Calibration.GPUCounter)) / static_cast<double>(Calibration.GPUFrequency);
+        EXPECT_GE(QueryCPUTime, CalibCPUTime - Tolerance);
+        EXPECT_LE(QueryCPUTime, CPUTimeIdle + Tolerance);
+    }
+
+    if (NumCalibratedContexts == 0)
+    {
+        GTEST_SKIP() << "Calibrated timestamps are not supported by this device";
+    }
+}
+
+
 TEST_F(QueryTest, Duration)
 {
     const auto& deviceCaps = TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
@@ -32,6 +32,7 @@
 #include "TestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
 #include "BasicMath.hpp"
+#include "Align.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1507,6 +1508,241 @@ TEST(RayTracingTest, ResourceBinding)
 }
 
 
+TEST(RayTracingTest, BuildBLASBatch)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Triangle vertices";
+        BuffDesc.Usage         = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = sizeof(Vertices);
+
+        BufferData BufData;
+        BufData.pData    = Vertices;
+        BufData.DataSize = sizeof(Vertices);
+
+        pDevice->CreateBuffer(BuffDesc, &BufData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangle";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = _countof(Vertices) / 3;
+
+    BottomLevelASDesc ASDesc;
+    ASDesc.Name          = "Batched BLAS";
+    ASDesc.pTriangles    = &TriangleDesc;
+    ASDesc.TriangleCount = 1;
+
+    constexpr Uint32 BLASCount = 3;
+
+    const Uint32 ScratchAlignment = pDevice->GetAdapterInfo().RayTracing.ScratchBufferAlignment;
+    EXPECT_NE(ScratchAlignment, 0u);
+
+    RefCntAutoPtr<IBottomLevelAS> pBLASes[BLASCount];
+    Uint64                        ScratchSize = 0;
+    for (auto& pBLAS : pBLASes)
+    {
+        pDevice->CreateBLAS(ASDesc, &pBLAS);
+        ASSERT_NE(pBLAS, nullptr);
+        ScratchSize += AlignUp(pBLAS->GetScratchBufferSizes().Build, Uint64{ScratchAlignment});
+    }
+
+    RefCntAutoPtr<IBuffer> pScratchBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Shared BLAS Scratch Buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = static_cast<Uint32>(ScratchSize);
+
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pScratchBuffer);
+        ASSERT_NE(pScratchBuffer, nullptr);
+    }
+
+    BLASBuildTriangleData Triangle;
+    Triangle.GeometryName         = TriangleDesc.GeometryName;
+    Triangle.pVertexBuffer        = pVertexBuffer;
+    Triangle.VertexStride         = sizeof(Vertices[0]);
+    Triangle.VertexCount          = _countof(Vertices);
+    Triangle.VertexValueType      = VT_FLOAT32;
+    Triangle.VertexComponentCount = 3;
+    Triangle.PrimitiveCount       = _countof(Vertices) / 3;
+    Triangle.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    BuildBLASAttribs Builds[BLASCount];
+    for (Uint32 i = 0; i < BLASCount; ++i)
+    {
+        Builds[i].pBLAS                  = pBLASes[i];
+        Builds[i].BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Builds[i].GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        Builds[i].pTriangleData          = &Triangle;
+        Builds[i].TriangleDataCount      = 1;
+    }
+
+    BuildBLASBatchAttribs Attribs;
+    Attribs.pBuilds                     = Builds;
+    Attribs.BuildCount                  = BLASCount;
+    Attribs.pScratchBuffer              = pScratchBuffer;
+    Attribs.ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    pContext->BuildBLASBatch(Attribs);
+
+    for (const auto& pBLAS : pBLASes)
+        EXPECT_EQ(pBLAS->GetState(), RESOURCE_STATE_BUILD_AS_WRITE);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST(RayTracingTest, BuildWithoutScratchBuffer)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->SupportsRayTracing())
+    {
+        GTEST_SKIP() << "Ray tracing is not supported by this device";
+    }
+
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources EnvironmentAutoReset;
+
+    const auto& Vertices = TestingConstants::TriangleClosestHit::Vertices;
+
+    RefCntAutoPtr<IBuffer> pVertexBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Triangle vertices";
+        BuffDesc.Usage         = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = sizeof(Vertices);
+
+        BufferData BufData;
+        BufData.pData    = Vertices;
+        BufData.DataSize = sizeof(Vertices);
+
+        pDevice->CreateBuffer(BuffDesc, &BufData, &pVertexBuffer);
+        ASSERT_NE(pVertexBuffer, nullptr);
+    }
+
+    BLASTriangleDesc TriangleDesc;
+    TriangleDesc.GeometryName         = "Triangle";
+    TriangleDesc.MaxVertexCount       = _countof(Vertices);
+    TriangleDesc.VertexValueType      = VT_FLOAT32;
+    TriangleDesc.VertexComponentCount = 3;
+    TriangleDesc.MaxPrimitiveCount    = _countof(Vertices) / 3;
+
+    BottomLevelASDesc BLASDesc;
+    BLASDesc.Name          = "BLAS";
+    BLASDesc.Flags         = RAYTRACING_BUILD_AS_ALLOW_UPDATE;
+    BLASDesc.pTriangles    = &TriangleDesc;
+    BLASDesc.TriangleCount = 1;
+
+    RefCntAutoPtr<IBottomLevelAS> pBLASes[2];
+    for (auto& pBLAS : pBLASes)
+    {
+        pDevice->CreateBLAS(BLASDesc, &pBLAS);
+        ASSERT_NE(pBLAS, nullptr);
+    }
+
+    TopLevelASDesc TLASDesc;
+    TLASDesc.Name             = "TLAS";
+    TLASDesc.MaxInstanceCount = 1;
+    TLASDesc.Flags            = RAYTRACING_BUILD_AS_ALLOW_UPDATE;
+
+    RefCntAutoPtr<ITopLevelAS> pTLAS;
+    pDevice->CreateTLAS(TLASDesc, &pTLAS);
+    ASSERT_NE(pTLAS, nullptr);
+
+    RefCntAutoPtr<IBuffer> pInstanceBuffer;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "TLAS Instance Buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_RAY_TRACING;
+        BuffDesc.uiSizeInBytes = TLAS_INSTANCE_DATA_SIZE;
+
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pInstanceBuffer);
+        ASSERT_NE(pInstanceBuffer, nullptr);
+    }
+
+    BLASBuildTriangleData Triangle;
+    Triangle.GeometryName         = TriangleDesc.GeometryName;
+    Triangle.pVertexBuffer        = pVertexBuffer;
+    Triangle.VertexStride         = sizeof(Vertices[0]);
+    Triangle.VertexCount          = _countof(Vertices);
+    Triangle.VertexValueType      = VT_FLOAT32;
+    Triangle.VertexComponentCount = 3;
+    Triangle.PrimitiveCount       = _countof(Vertices) / 3;
+    Triangle.Flags                = RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+    TLASBuildInstanceData Instance;
+    Instance.InstanceName = "Instance";
+    Instance.pBLAS        = pBLASes[0];
+    Instance.Flags        = RAYTRACING_INSTANCE_NONE;
+
+    // Build and refit the structures over several frames so that the scratch ring pages get recycled
+    for (Uint32 Frame = 0; Frame < 4; ++Frame)
+    {
+        const bool Update = Frame > 0;
+
+        BuildBLASAttribs BLASAttribs;
+        BLASAttribs.pBLAS                  = pBLASes[0];
+        BLASAttribs.BLASTransitionMode     = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        BLASAttribs.GeometryTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        BLASAttribs.pTriangleData          = &Triangle;
+        BLASAttribs.TriangleDataCount      = 1;
+        BLASAttribs.Update                 = Update;
+        pContext->BuildBLAS(BLASAttribs);
+        EXPECT_EQ(BLASAttribs.pScratchBuffer, nullptr);
+
+        BLASAttribs.pBLAS = pBLASes[1];
+
+        BuildBLASBatchAttribs BatchAttribs;
+        BatchAttribs.pBuilds    = &BLASAttribs;
+        BatchAttribs.BuildCount = 1;
+        pContext->BuildBLASBatch(BatchAttribs);
+
+        BuildTLASAttribs TLASAttribs;
+        TLASAttribs.pTLAS                        = pTLAS;
+        TLASAttribs.pInstances                   = &Instance;
+        TLASAttribs.InstanceCount                = 1;
+        TLASAttribs.HitGroupStride               = 1;
+        TLASAttribs.BindingMode                  = HIT_GROUP_BINDING_MODE_PER_GEOMETRY;
+        TLASAttribs.TLASTransitionMode           = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        TLASAttribs.BLASTransitionMode           = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        TLASAttribs.pInstanceBuffer              = pInstanceBuffer;
+        TLASAttribs.InstanceBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+        TLASAttribs.Update                       = Update;
+        pContext->BuildTLAS(TLASAttribs);
+
+        EXPECT_EQ(pTLAS->GetState(), RESOURCE_STATE_BUILD_AS_WRITE);
+
+        pContext->Flush();
+        pContext->FinishFrame();
+    }
+
+    pContext->WaitForIdle();
+}
+
 class RT5 : public testing::TestWithParam<int>
 {};
 
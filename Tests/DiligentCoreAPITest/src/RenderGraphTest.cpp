@@ -0,0 +1,227 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "RenderGraph.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TextureDesc GetTestTextureDesc(const char* Name)
+{
+    TextureDesc TexDesc;
+    TexDesc.Name      = Name;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_NONE;
+    return TexDesc;
+}
+
+RefCntAutoPtr<ITexture> CreateOutputTexture(IRenderDevice* pDevice)
+{
+    auto TexDesc      = GetTestTextureDesc("Render graph test output");
+    TexDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    return pTexture;
+}
+
+TEST(RenderGraphTest, CullPasses)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pOutputTex = CreateOutputTexture(pDevice);
+    ASSERT_NE(pOutputTex, nullptr);
+
+    RenderGraphCreateInfo CI;
+    CI.MergeRenderPasses = false;
+    RenderGraph Graph{pDevice, CI};
+
+    const OptimizedClearValue ClearValue{};
+
+    auto Color  = Graph.CreateTexture(GetTestTextureDesc("Color"));
+    auto Unused = Graph.CreateTexture(GetTestTextureDesc("Unused"));
+    auto Output = Graph.ImportTexture(pOutputTex);
+
+    Uint32 ExecutedPasses = 0;
+    auto   CountPass      = [&ExecutedPasses](const RenderGraph&, IDeviceContext*) { ++ExecutedPasses; };
+
+    auto ColorPass = Graph.AddPass("Color", CountPass).SetRenderTarget(0, Color, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue).GetId();
+    // The result of this pass is never read and the pass must be culled
+    auto UnusedPass = Graph.AddPass("Unused", CountPass).Read(Color).SetRenderTarget(0, Unused, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue).GetId();
+    auto OutputPass = Graph.AddPass("Output", CountPass).Read(Color).SetRenderTarget(0, Output).GetId();
+
+    Graph.Compile();
+
+    EXPECT_FALSE(Graph.IsPassCulled(ColorPass));
+    EXPECT_TRUE(Graph.IsPassCulled(UnusedPass));
+    EXPECT_FALSE(Graph.IsPassCulled(OutputPass));
+
+    const auto& Stats = Graph.GetStatistics();
+    EXPECT_EQ(Stats.NumPasses, 3u);
+    EXPECT_EQ(Stats.NumCulledPasses, 1u);
+    EXPECT_EQ(Stats.NumRenderPasses, 2u);
+    EXPECT_EQ(Stats.NumTransientTextures, 1u);
+
+    ASSERT_NE(Graph.GetTexture(Color), nullptr);
+    EXPECT_EQ(Graph.GetTexture(Unused), nullptr);
+    EXPECT_EQ(Graph.GetRenderPass(UnusedPass), nullptr);
+    EXPECT_TRUE((Graph.GetTexture(Color)->GetDesc().BindFlags & (BIND_RENDER_TARGET | BIND_SHADER_RESOURCE)) == (BIND_RENDER_TARGET | BIND_SHADER_RESOURCE));
+
+    Graph.Execute(pContext);
+    EXPECT_EQ(ExecutedPasses, 2u);
+    EXPECT_EQ(pOutputTex->GetState(), RESOURCE_STATE_RENDER_TARGET);
+}
+
+TEST(RenderGraphTest, MergeRenderPasses)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pOutputTex = CreateOutputTexture(pDevice);
+    ASSERT_NE(pOutputTex, nullptr);
+
+    for (Uint32 i = 0; i < 2; ++i)
+    {
+        const bool MergeRenderPasses = i == 0;
+
+        RenderGraphCreateInfo CI;
+        CI.MergeRenderPasses = MergeRenderPasses;
+        RenderGraph Graph{pDevice, CI};
+
+        const OptimizedClearValue ClearValue{};
+
+        auto GBuffer = Graph.CreateTexture(GetTestTextureDesc("GBuffer"));
+        auto Output  = Graph.ImportTexture(pOutputTex);
+
+        auto GBufferPass  = Graph.AddPass("GBuffer", nullptr).SetRenderTarget(0, GBuffer, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue).GetId();
+        auto LightingPass = Graph.AddPass("Lighting", nullptr).ReadInputAttachment(GBuffer).SetRenderTarget(0, Output, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue).GetId();
+
+        Graph.Compile();
+
+        const auto& Stats = Graph.GetStatistics();
+        EXPECT_EQ(Stats.NumCulledPasses, 0u);
+        EXPECT_EQ(Stats.NumRenderPasses, MergeRenderPasses ? 1u : 2u);
+        EXPECT_EQ(Stats.NumMergedPasses, MergeRenderPasses ? 1u : 0u);
+
+        Uint32 GBufferSubpass  = ~0u;
+        Uint32 LightingSubpass = ~0u;
+        auto*  pGBufferRP      = Graph.GetRenderPass(GBufferPass, &GBufferSubpass);
+        auto*  pLightingRP     = Graph.GetRenderPass(LightingPass, &LightingSubpass);
+        ASSERT_NE(pGBufferRP, nullptr);
+        ASSERT_NE(pLightingRP, nullptr);
+        EXPECT_EQ(GBufferSubpass, 0u);
+        if (MergeRenderPasses)
+        {
+            EXPECT_EQ(pGBufferRP, pLightingRP);
+            EXPECT_EQ(LightingSubpass, 1u);
+
+            const auto& RPDesc = pGBufferRP->GetDesc();
+            ASSERT_EQ(RPDesc.AttachmentCount, 2u);
+            ASSERT_EQ(RPDesc.SubpassCount, 2u);
+            // The transient G-buffer is not used after the render pass
+            EXPECT_EQ(RPDesc.pAttachments[0].StoreOp, ATTACHMENT_STORE_OP_DISCARD);
+            EXPECT_EQ(RPDesc.pAttachments[1].StoreOp, ATTACHMENT_STORE_OP_STORE);
+            EXPECT_EQ(RPDesc.DependencyCount, 1u);
+        }
+        else
+        {
+            EXPECT_NE(pGBufferRP, pLightingRP);
+            EXPECT_EQ(LightingSubpass, 0u);
+        }
+
+        Graph.Execute(pContext);
+    }
+}
+
+TEST(RenderGraphTest, ReuseTransientTextures)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pOutputTex = CreateOutputTexture(pDevice);
+    ASSERT_NE(pOutputTex, nullptr);
+
+    RenderGraph Graph{pDevice};
+
+    const OptimizedClearValue ClearValue{};
+
+    ITexture* pTex0 = nullptr;
+    for (Uint32 frame = 0; frame < 2; ++frame)
+    {
+        Graph.Reset();
+
+        auto Tex0   = Graph.CreateTexture(GetTestTextureDesc("Tex0"));
+        auto Tex1   = Graph.CreateTexture(GetTestTextureDesc("Tex1"));
+        auto Tex2   = Graph.CreateTexture(GetTestTextureDesc("Tex2"));
+        auto Output = Graph.ImportTexture(pOutputTex);
+
+        Graph.AddPass("Pass0", nullptr).SetRenderTarget(0, Tex0, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue);
+        Graph.AddPass("Pass1", nullptr).Read(Tex0).SetRenderTarget(0, Tex1, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue);
+        Graph.AddPass("Pass2", nullptr).Read(Tex1).SetRenderTarget(0, Tex2, ATTACHMENT_LOAD_OP_CLEAR, &ClearValue);
+        Graph.AddPass("Pass3", nullptr).Read(Tex2).SetRenderTarget(0, Output);
+
+        Graph.Compile();
+
+        const auto& Stats = Graph.GetStatistics();
+        EXPECT_EQ(Stats.NumTransientTextures, 3u);
+        // Tex0 is not used after Pass1, so Tex2 reuses the same texture object
+        EXPECT_EQ(Stats.NumTextureObjects, 2u);
+        EXPECT_EQ(Graph.GetTexture(Tex0), Graph.GetTexture(Tex2));
+        EXPECT_NE(Graph.GetTexture(Tex0), Graph.GetTexture(Tex1));
+
+        // Pooled textures are reused by the next compilation
+        if (frame == 0)
+            pTex0 = Graph.GetTexture(Tex0);
+        else
+            EXPECT_EQ(Graph.GetTexture(Tex0), pTex0);
+
+        Graph.Execute(pContext);
+        // Shader resources are transitioned by the graph
+        EXPECT_GT(Graph.GetStatistics().NumBarriers, 0u);
+    }
+}
+
+} // namespace
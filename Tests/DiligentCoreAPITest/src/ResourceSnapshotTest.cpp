@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const LiveObjectInfo* FindObject(IDataBlob* pObjects, const char* Name)
+{
+    const auto* pInfos     = reinterpret_cast<const LiveObjectInfo*>(pObjects->GetConstDataPtr());
+    const auto  NumObjects = pObjects->GetSize() / sizeof(LiveObjectInfo);
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        if (strcmp(pInfos[i].Name, Name) == 0)
+            return &pInfos[i];
+    }
+    return nullptr;
+}
+
+TEST(ResourceSnapshotTest, LiveObjects)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ResourceSnapshot         Snapshot0;
+    RefCntAutoPtr<IDataBlob> pObjects0;
+    pDevice->CaptureResourceSnapshot(Snapshot0, &pObjects0);
+    ASSERT_NE(pObjects0, nullptr);
+
+    ResourceSnapshot         Snapshot1;
+    RefCntAutoPtr<IDataBlob> pObjects1;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "Resource snapshot test buffer";
+        BuffDesc.uiSizeInBytes = 1024;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.Usage         = USAGE_DEFAULT;
+
+        RefCntAutoPtr<IBuffer> pBuff;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuff);
+        ASSERT_NE(pBuff, nullptr);
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Resource snapshot test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 64;
+        TexDesc.Height    = 64;
+        TexDesc.MipLevels = 1;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        RefCntAutoPtr<ITexture> pTex;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+        ASSERT_NE(pTex, nullptr);
+
+        pDevice->CaptureResourceSnapshot(Snapshot1, &pObjects1);
+        ASSERT_NE(pObjects1, nullptr);
+
+        EXPECT_EQ(Snapshot1.NumObjects[DEVICE_OBJECT_TYPE_BUFFER], Snapshot0.NumObjects[DEVICE_OBJECT_TYPE_BUFFER] + 1);
+        EXPECT_EQ(Snapshot1.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE], Snapshot0.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE] + 1);
+        EXPECT_GE(Snapshot1.ObjectPools[DEVICE_OBJECT_TYPE_BUFFER].NumAllocatedBlocks, Snapshot1.NumObjects[DEVICE_OBJECT_TYPE_BUFFER]);
+        EXPECT_GE(Snapshot1.ObjectPools[DEVICE_OBJECT_TYPE_BUFFER].NumReservedBlocks, Snapshot1.ObjectPools[DEVICE_OBJECT_TYPE_BUFFER].NumAllocatedBlocks);
+
+        const auto* pBuffInfo = FindObject(pObjects1, BuffDesc.Name);
+        ASSERT_NE(pBuffInfo, nullptr);
+        EXPECT_EQ(pBuffInfo->Type, DEVICE_OBJECT_TYPE_BUFFER);
+        EXPECT_EQ(pBuffInfo->Size, 1024u);
+        EXPECT_EQ(FindObject(pObjects0, BuffDesc.Name), nullptr);
+
+        const auto* pTexInfo = FindObject(pObjects1, TexDesc.Name);
+        ASSERT_NE(pTexInfo, nullptr);
+        EXPECT_EQ(pTexInfo->Type, DEVICE_OBJECT_TYPE_TEXTURE);
+        EXPECT_EQ(pTexInfo->Size, 64u * 64u * 4u);
+        EXPECT_GT(pTexInfo->SerialNumber, pBuffInfo->SerialNumber);
+    }
+
+    ResourceSnapshot         Snapshot2;
+    RefCntAutoPtr<IDataBlob> pObjects2;
+    pDevice->CaptureResourceSnapshot(Snapshot2, &pObjects2);
+    ASSERT_NE(pObjects2, nullptr);
+    EXPECT_EQ(Snapshot2.NumObjects[DEVICE_OBJECT_TYPE_BUFFER], Snapshot0.NumObjects[DEVICE_OBJECT_TYPE_BUFFER]);
+    EXPECT_EQ(Snapshot2.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE], Snapshot0.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE]);
+    EXPECT_EQ(FindObject(pObjects2, "Resource snapshot test buffer"), nullptr);
+    EXPECT_EQ(FindObject(pObjects2, "Resource snapshot test texture"), nullptr);
+
+    // Snapshots own copies of the object names
+    EXPECT_NE(FindObject(pObjects1, "Resource snapshot test buffer"), nullptr);
+}
+
+} // namespace
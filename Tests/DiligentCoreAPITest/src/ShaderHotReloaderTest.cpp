@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "TestingEnvironment.hpp"
+#include "ShaderHotReloader.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+RefCntAutoPtr<IShader> CreateTestCS(const char* Source)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "Shader hot reload test CS";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = Source;
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+RefCntAutoPtr<IPipelineState> CreateTestComputePSO(IShader* pCS)
+{
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name = "Shader hot reload test PSO";
+    PSOCreateInfo.pCS          = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+void WriteTestFile(const char* Path, const char* Content)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Content, strlen(Content)));
+}
+
+TEST(ShaderHotReloaderTest, SwapShaders)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pCS0 = CreateTestCS(R"(
+RWTexture2D<float/* format=r32f */> g_RWTex;
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex[int2(0,0)] = 0.0;
+}
+)");
+    ASSERT_NE(pCS0, nullptr);
+    auto pCS1 = CreateTestCS(R"(
+RWTexture2D<float/* format=r32f */> g_RWTex;
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex[int2(0,0)] = 1.0;
+}
+)");
+    ASSERT_NE(pCS1, nullptr);
+    auto pCS2 = CreateTestCS(R"(
+RWTexture2D<float/* format=r32f */> g_RWTex2;
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex2[int2(0,0)] = 1.0;
+}
+)");
+    ASSERT_NE(pCS2, nullptr);
+
+    auto pPSO0 = CreateTestComputePSO(pCS0);
+    ASSERT_NE(pPSO0, nullptr);
+    auto pPSO1 = CreateTestComputePSO(pCS1);
+    ASSERT_NE(pPSO1, nullptr);
+    auto pPSO2 = CreateTestComputePSO(pCS2);
+    ASSERT_NE(pPSO2, nullptr);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO0->CreateShaderResourceBinding(&pSRB);
+    ASSERT_NE(pSRB, nullptr);
+
+    EXPECT_TRUE(pPSO0->SwapShaders(pPSO1));
+    EXPECT_TRUE(pPSO0->IsCompatibleWith(pPSO1));
+
+    // Resource signatures are not compatible
+    TestingEnvironment::SetErrorAllowance(1);
+    EXPECT_FALSE(pPSO0->SwapShaders(pPSO2));
+    TestingEnvironment::SetErrorAllowance(0);
+
+    // The SRB created before the swap is still compatible with the pipeline
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+    pContext->SetPipelineState(pPSO0);
+    pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
+TEST(ShaderHotReloaderTest, ReloadInclude)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    WriteTestFile("ShaderHotReloaderTest.fxh", "float GetValue() { return 0.0; }\n");
+    WriteTestFile("ShaderHotReloaderTest.csh", R"(
+#include "ShaderHotReloaderTest.fxh"
+RWTexture2D<float/* format=r32f */> g_RWTex;
+[numthreads(1,1,1)]
+void main()
+{
+    g_RWTex[int2(0,0)] = GetValue();
+}
+)");
+
+    {
+        ShaderHotReloaderCreateInfo ReloaderCI;
+        ReloaderCI.WatchDirectories = ".";
+        ReloaderCI.PollingInterval  = 10;
+        ShaderHotReloader Reloader{pDevice, ReloaderCI};
+
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+        pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(nullptr, &pShaderSourceFactory);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+        ShaderCI.Desc.Name                  = "Shader hot reload test CS";
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.FilePath                   = "ShaderHotReloaderTest.csh";
+        ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+
+        RefCntAutoPtr<IShader> pCS;
+        Reloader.CreateShader(ShaderCI, &pCS);
+        ASSERT_NE(pCS, nullptr);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Shader hot reload test PSO";
+        PSOCreateInfo.pCS          = pCS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        Reloader.CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+
+        auto* pContext = pEnv->GetDeviceContext();
+        EXPECT_EQ(Reloader.Update(pContext), 0u);
+
+        // Make sure that the modification time changes on file systems with coarse time stamps
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        WriteTestFile("ShaderHotReloaderTest.fxh", "float GetValue() { return 1.0 + 1.0; }\n");
+
+        Uint32     NumUpdated = 0;
+        const auto StartTime  = std::chrono::steady_clock::now();
+        while (NumUpdated == 0 && std::chrono::steady_clock::now() - StartTime < std::chrono::seconds{10})
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            NumUpdated = Reloader.Update(pContext);
+        }
+        EXPECT_EQ(NumUpdated, 1u);
+
+        const auto& Stats = Reloader.GetStatistics();
+        EXPECT_EQ(Stats.NumReloadedShaders, 1u);
+        EXPECT_EQ(Stats.NumUpdatedPipelines, 1u);
+        EXPECT_EQ(Stats.NumFailedShaders, 0u);
+        EXPECT_EQ(Stats.NumFailedPipelines, 0u);
+    }
+
+    FileSystem::DeleteFile("ShaderHotReloaderTest.fxh");
+    FileSystem::DeleteFile("ShaderHotReloaderTest.csh");
+}
+
+} // namespace
@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <limits>
+
+#include "ShaderMacroHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const Char* FindMacro(const ShaderMacro* pMacros, const Char* Name)
+{
+    for (; pMacros != nullptr && pMacros->Name != nullptr; ++pMacros)
+    {
+        if (strcmp(pMacros->Name, Name) == 0)
+            return pMacros->Definition;
+    }
+    return nullptr;
+}
+
+TEST(ShaderMacroHelperTest, Formatting)
+{
+    ShaderMacroHelper Macros;
+    Macros.AddShaderMacro("BOOL", true);
+    Macros.AddShaderMacro("INT", -42);
+    Macros.AddShaderMacro("INT_MIN", std::numeric_limits<Int32>::min());
+    Macros.AddShaderMacro("UINT", 4096u);
+    Macros.AddShaderMacro("UINT8", Uint8{7});
+    Macros.AddShaderMacro("FLOAT_INTEGRAL", 1024.f);
+    Macros.AddShaderMacro("FLOAT", 0.25f);
+    Macros.AddShaderMacro("STRING", "float4");
+
+    const ShaderMacro* pMacros = Macros;
+    EXPECT_STREQ(FindMacro(pMacros, "BOOL"), "1");
+    EXPECT_STREQ(FindMacro(pMacros, "INT"), "-42");
+    EXPECT_STREQ(FindMacro(pMacros, "INT_MIN"), "-2147483648");
+    EXPECT_STREQ(FindMacro(pMacros, "UINT"), "4096u");
+    EXPECT_STREQ(FindMacro(pMacros, "UINT8"), "7u");
+    EXPECT_STREQ(FindMacro(pMacros, "FLOAT_INTEGRAL"), "1024.0");
+    EXPECT_STREQ(FindMacro(pMacros, "FLOAT"), "0.25");
+    EXPECT_STREQ(FindMacro(pMacros, "STRING"), "float4");
+}
+
+TEST(ShaderMacroHelperTest, Hash)
+{
+    ShaderMacroHelper Macros0;
+    EXPECT_EQ(Macros0.GetHash(), Uint64{0});
+
+    Macros0.AddShaderMacro("A", 1);
+    Macros0.AddShaderMacro("B", 2u);
+
+    // The hash does not depend on the macro order
+    ShaderMacroHelper Macros1;
+    Macros1.AddShaderMacro("B", 2u);
+    Macros1.AddShaderMacro("A", 1);
+    EXPECT_EQ(Macros0.GetHash(), Macros1.GetHash());
+
+    // Name and definition boundaries are part of the hash
+    ShaderMacroHelper Macros2;
+    Macros2.AddShaderMacro("A1", "");
+    Macros2.AddShaderMacro("B", 2u);
+    EXPECT_NE(Macros0.GetHash(), Macros2.GetHash());
+
+    const auto Hash = Macros0.GetHash();
+    Macros0.UpdateMacro("A", 3);
+    EXPECT_NE(Macros0.GetHash(), Hash);
+    Macros0.UpdateMacro("A", 1);
+    EXPECT_EQ(Macros0.GetHash(), Hash);
+
+    Macros0.RemoveMacro("A");
+    Macros0.RemoveMacro("B");
+    EXPECT_EQ(Macros0.GetHash(), Uint64{0});
+
+    ShaderMacroHelper Macros3{Macros1};
+    EXPECT_EQ(Macros3.GetHash(), Hash);
+    Macros3.Clear();
+    EXPECT_EQ(Macros3.GetHash(), Uint64{0});
+    EXPECT_EQ(static_cast<const ShaderMacro*>(Macros3), nullptr);
+}
+
+TEST(ShaderMacroHelperTest, CopyAndMove)
+{
+    ShaderMacroHelper Macros0;
+    Macros0.AddShaderMacro("A", 1);
+    Macros0.AddShaderMacro("B", "x");
+
+    ShaderMacroHelper Macros1{Macros0};
+    Macros0.Clear();
+    Macros0.AddShaderMacro("C", 5);
+
+    ShaderMacroHelper  Macros2{std::move(Macros1)};
+    const ShaderMacro* pMacros = Macros2;
+    EXPECT_STREQ(FindMacro(pMacros, "A"), "1");
+    EXPECT_STREQ(FindMacro(pMacros, "B"), "x");
+    EXPECT_EQ(FindMacro(pMacros, "C"), nullptr);
+}
+
+} // namespace
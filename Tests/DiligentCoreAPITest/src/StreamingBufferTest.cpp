@@ -25,6 +25,10 @@
  *  of the possibility of such damages.
  */
 
+#include <thread>
+#include <vector>
+#include <algorithm>
+
 #include "StreamingBuffer.hpp"
 #include "TestingEnvironment.hpp"
 
@@ -101,4 +105,91 @@ TEST(StreamingBufferTest, MapUnamp)
     StreamBuff.Reset();
 }
 
+TEST(StreamingBufferTest, ConcurrentReservations)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    StreamingBufferCreateInfo CI;
+    CI.pDevice = pDevice;
+
+    CI.BuffDesc.Name           = "Test streaming buffer";
+    CI.BuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+    CI.BuffDesc.Usage          = USAGE_DYNAMIC;
+    CI.BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    CI.BuffDesc.uiSizeInBytes  = 1 << 16;
+
+    StreamingBuffer StreamBuff{CI};
+    ASSERT_TRUE(StreamBuff.GetBuffer() != nullptr);
+
+    {
+        auto Offset = StreamBuff.Map(pContext, pDevice, 100);
+        EXPECT_EQ(Offset, Uint32{0});
+        StreamBuff.Unmap();
+    }
+
+    constexpr Uint32 WindowSize = 1 << 14;
+    constexpr Uint32 RangeSize  = 48;
+    constexpr Uint32 Alignment  = 16;
+
+    const auto WindowOffset = StreamBuff.BeginConcurrentReservations(pContext, pDevice, WindowSize);
+    EXPECT_EQ(WindowOffset, Uint32{100});
+    auto* const pCPUAddress = static_cast<Uint8*>(StreamBuff.GetMappedCPUAddress());
+    ASSERT_NE(pCPUAddress, nullptr);
+
+    const size_t NumThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    std::vector<std::vector<Uint32>> Offsets(NumThreads);
+    {
+        std::vector<std::thread> Threads(NumThreads);
+        for (size_t t = 0; t < Threads.size(); ++t)
+        {
+            Threads[t] = std::thread{
+                [&](size_t thread_id) //
+                {
+                    for (;;)
+                    {
+                        const auto Offset = StreamBuff.ReserveConcurrent(RangeSize, Alignment);
+                        if (Offset == StreamingBuffer::InvalidOffset)
+                            break;
+                        memset(pCPUAddress + Offset, static_cast<int>(thread_id), RangeSize);
+                        Offsets[thread_id].push_back(Offset);
+                    }
+                },
+                t //
+            };
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    std::vector<Uint32> AllOffsets;
+    for (const auto& ThreadOffsets : Offsets)
+        AllOffsets.insert(AllOffsets.end(), ThreadOffsets.begin(), ThreadOffsets.end());
+    std::sort(AllOffsets.begin(), AllOffsets.end());
+
+    // Ranges must be aligned, must not overlap and must fill the window
+    const auto FirstOffset = AlignUp(WindowOffset, Alignment);
+    EXPECT_EQ(AllOffsets.size(), (WindowOffset + WindowSize - FirstOffset) / RangeSize);
+    for (size_t i = 0; i < AllOffsets.size(); ++i)
+        EXPECT_EQ(AllOffsets[i], FirstOffset + i * RangeSize);
+
+    const auto EndOffset = StreamBuff.EndConcurrentReservations();
+    EXPECT_EQ(EndOffset, FirstOffset + AllOffsets.size() * RangeSize);
+    EXPECT_EQ(StreamBuff.GetMappedCPUAddress(), nullptr);
+
+    // Unused space at the end of the window is returned to the buffer
+    {
+        auto Offset = StreamBuff.Map(pContext, pDevice, 16);
+        EXPECT_EQ(Offset, EndOffset);
+        StreamBuff.Unmap();
+    }
+
+    StreamBuff.Reset();
+}
+
 } // namespace
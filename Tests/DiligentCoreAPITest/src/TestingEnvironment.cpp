@@ -259,6 +259,7 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             }
 
             CreateInfo.AdapterId           = FindAdapater(Adapters, CI.AdapterType, CI.AdapterId);
+            m_AdapterId                    = CreateInfo.AdapterId;
             NumDeferredCtx                 = CI.NumDeferredContexts;
             CreateInfo.NumDeferredContexts = NumDeferredCtx;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
@@ -313,6 +314,7 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             }
 
             CreateInfo.AdapterId = FindAdapater(Adapters, CI.AdapterType, CI.AdapterId);
+            m_AdapterId          = CreateInfo.AdapterId;
             AddContext(COMMAND_QUEUE_TYPE_GRAPHICS, "Graphics", CI.AdapterId);
             AddContext(COMMAND_QUEUE_TYPE_COMPUTE, "Compute", CI.AdapterId);
             AddContext(COMMAND_QUEUE_TYPE_TRANSFER, "Transfer", CI.AdapterId);
@@ -364,6 +366,8 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             CreateInfo.Features             = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
             if (CI.ForceNonSeparablePrograms)
                 CreateInfo.Features.SeparablePrograms = DEVICE_FEATURE_STATE_DISABLED;
+            // Required by WorkerContextGLTest
+            CreateInfo.CreateWorkerContext = true;
             NumDeferredCtx = 0;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             RefCntAutoPtr<ISwapChain> pSwapChain; // We will use testing swap chain instead
@@ -398,6 +402,7 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             CreateInfo.SetValidationLevel(VALIDATION_LEVEL_1);
 
             CreateInfo.AdapterId                 = CI.AdapterId;
+            m_AdapterId                          = CreateInfo.AdapterId;
             CreateInfo.NumImmediateContexts      = static_cast<Uint32>(ContextCI.size());
             CreateInfo.pImmediateContextInfo     = CreateInfo.NumImmediateContexts > 0 ? ContextCI.data() : nullptr;
             CreateInfo.DebugMessageCallback      = MessageCallback;
@@ -406,7 +411,10 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             CreateInfo.UploadHeapPageSize        = 32 * 1024;
             //CreateInfo.DeviceLocalMemoryReserveSize = 32 << 20;
             //CreateInfo.HostVisibleMemoryReserveSize = 48 << 20;
-            CreateInfo.Features = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+            CreateInfo.Features              = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+            CreateInfo.EnableMultipleDevices = true; // Required by CreateDedicatedDevice()
+            if (CI.UseVkDescriptorBuffer)
+                CreateInfo.DescriptorBufferSize = 16 << 20;
 
             NumDeferredCtx                 = CI.NumDeferredContexts;
             CreateInfo.NumDeferredContexts = NumDeferredCtx;
@@ -429,6 +437,7 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             AddContext(COMMAND_QUEUE_TYPE_GRAPHICS, "Graphics 2", CI.AdapterId);
 
             CreateInfo.AdapterId             = CI.AdapterId;
+            m_AdapterId                      = CreateInfo.AdapterId;
             CreateInfo.NumImmediateContexts  = static_cast<Uint32>(ContextCI.size());
             CreateInfo.pImmediateContextInfo = CreateInfo.NumImmediateContexts ? ContextCI.data() : nullptr;
             CreateInfo.Features              = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
@@ -610,6 +619,95 @@ RefCntAutoPtr<ISampler> TestingEnvironment::CreateSampler(const SamplerDesc& Des
     return pSampler;
 }
 
+void TestingEnvironment::CreateDedicatedDevice(const ModifyEngineCreateInfoType& ModifyEngineCI,
+                                               IRenderDevice**                   ppDevice,
+                                               IDeviceContext**                  ppContext)
+{
+    VERIFY_EXPR(ppDevice != nullptr && ppContext != nullptr);
+    *ppDevice  = nullptr;
+    *ppContext = nullptr;
+
+    auto* pFactory = m_pDevice->GetEngineFactory();
+
+    // Validation level must be set through the derived create info as SetValidationLevel() is not virtual
+    auto InitEngineCI = [&](EngineCreateInfo& EngineCI) //
+    {
+        EngineCI.AdapterId            = m_AdapterId;
+        EngineCI.DebugMessageCallback = MessageCallback;
+        EngineCI.Features             = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+        if (ModifyEngineCI)
+            ModifyEngineCI(EngineCI);
+    };
+
+    switch (m_DeviceType)
+    {
+#if D3D11_SUPPORTED
+        case RENDER_DEVICE_TYPE_D3D11:
+        {
+            RefCntAutoPtr<IEngineFactoryD3D11> pFactoryD3D11{pFactory, IID_EngineFactoryD3D11};
+            VERIFY_EXPR(pFactoryD3D11);
+
+            EngineD3D11CreateInfo CreateInfo;
+            CreateInfo.GraphicsAPIVersion = Version{11, 0};
+#    ifdef DILIGENT_DEVELOPMENT
+            CreateInfo.SetValidationLevel(VALIDATION_LEVEL_2);
+#    endif
+            InitEngineCI(CreateInfo);
+            pFactoryD3D11->CreateDeviceAndContextsD3D11(CreateInfo, ppDevice, ppContext);
+        }
+        break;
+#endif
+
+#if D3D12_SUPPORTED
+        case RENDER_DEVICE_TYPE_D3D12:
+        {
+            RefCntAutoPtr<IEngineFactoryD3D12> pFactoryD3D12{pFactory, IID_EngineFactoryD3D12};
+            VERIFY_EXPR(pFactoryD3D12);
+
+            EngineD3D12CreateInfo CreateInfo;
+            CreateInfo.GraphicsAPIVersion = Version{11, 0};
+            CreateInfo.SetValidationLevel(VALIDATION_LEVEL_1);
+            InitEngineCI(CreateInfo);
+            pFactoryD3D12->CreateDeviceAndContextsD3D12(CreateInfo, ppDevice, ppContext);
+        }
+        break;
+#endif
+
+#if VULKAN_SUPPORTED
+        case RENDER_DEVICE_TYPE_VULKAN:
+        {
+            RefCntAutoPtr<IEngineFactoryVk> pFactoryVk{pFactory, IID_EngineFactoryVk};
+            VERIFY_EXPR(pFactoryVk);
+
+            EngineVkCreateInfo CreateInfo;
+            // The instance is shared with the testing device and must use the same validation settings
+            CreateInfo.SetValidationLevel(VALIDATION_LEVEL_1);
+            CreateInfo.EnableMultipleDevices = true;
+            InitEngineCI(CreateInfo);
+            pFactoryVk->CreateDeviceAndContextsVk(CreateInfo, ppDevice, ppContext);
+        }
+        break;
+#endif
+
+#if METAL_SUPPORTED
+        case RENDER_DEVICE_TYPE_METAL:
+        {
+            RefCntAutoPtr<IEngineFactoryMtl> pFactoryMtl{pFactory, IID_EngineFactoryMtl};
+            VERIFY_EXPR(pFactoryMtl);
+
+            EngineMtlCreateInfo CreateInfo;
+            CreateInfo.SetValidationLevel(VALIDATION_LEVEL_1);
+            InitEngineCI(CreateInfo);
+            pFactoryMtl->CreateDeviceAndContextsMtl(CreateInfo, ppDevice, ppContext);
+        }
+        break;
+#endif
+
+        default:
+            LOG_WARNING_MESSAGE("Dedicated devices are not supported for this device type");
+    }
+}
+
 void TestingEnvironment::SetDefaultCompiler(SHADER_COMPILER compiler)
 {
     switch (m_pDevice->GetDeviceInfo().Type)
@@ -89,7 +89,7 @@ Uint32 WriteOrVerifyRGBAData(MappedTextureSubresource& MappedData,
     return NumInvalidPixels;
 }
 
-void TextureUploaderTest(bool IsRenderThread)
+void TextureUploaderTest(bool IsRenderThread, bool UseBucketedSize = false)
 {
     auto* pEnv     = TestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -133,6 +133,12 @@ void TextureUploaderTest(bool IsRenderThread)
     UploadBufferDesc UploadBuffDesc;
     UploadBuffDesc.Width     = TexDesc.Width >> StartDstMip;
     UploadBuffDesc.Height    = TexDesc.Height >> StartDstMip;
+    if (UseBucketedSize)
+    {
+        // Upload buffer will be served by a larger staging texture from the size bucket
+        UploadBuffDesc.Width -= 8;
+        UploadBuffDesc.Height -= 4;
+    }
     UploadBuffDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
     UploadBuffDesc.MipLevels = 2;
     UploadBuffDesc.ArraySize = 4;
@@ -208,6 +214,14 @@ void TextureUploaderTest(bool IsRenderThread)
             }
         }
     }
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 || DeviceInfo.IsVulkanDevice())
+    {
+        const auto Stats = pTexUploader->GetStats();
+        EXPECT_GT(Stats.NumPooledBuffers, 0u);
+        EXPECT_GT(Stats.PooledBuffersSize, Uint64{0});
+    }
 }
 
 TEST(TextureUploaderTest, RenderThread)
@@ -220,4 +234,9 @@ TEST(TextureUploaderTest, WorkerThread)
     TextureUploaderTest(false);
 }
 
+TEST(TextureUploaderTest, BucketedSize)
+{
+    TextureUploaderTest(true, true);
+}
+
 } // namespace
@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+TEST(TextureViewCacheTest, IdenticalViewsAreShared)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Texture view cache test";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.ArraySize = 4;
+    TexDesc.MipLevels = 4;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    RefCntAutoPtr<ITexture> pTexture;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+    ASSERT_NE(pTexture, nullptr);
+
+    TextureViewDesc ViewDesc;
+    ViewDesc.Name            = "Mip 1 view";
+    ViewDesc.ViewType        = TEXTURE_VIEW_SHADER_RESOURCE;
+    ViewDesc.MostDetailedMip = 1;
+    ViewDesc.NumMipLevels    = 2;
+
+    RefCntAutoPtr<ITextureView> pView0;
+    pTexture->CreateView(ViewDesc, &pView0);
+    ASSERT_NE(pView0, nullptr);
+
+    // The name does not affect the view
+    ViewDesc.Name = "Another mip 1 view";
+    RefCntAutoPtr<ITextureView> pView1;
+    pTexture->CreateView(ViewDesc, &pView1);
+    EXPECT_EQ(pView0, pView1);
+
+    ViewDesc.FirstArraySlice = 1;
+    RefCntAutoPtr<ITextureView> pView2;
+    pTexture->CreateView(ViewDesc, &pView2);
+    ASSERT_NE(pView2, nullptr);
+    EXPECT_NE(pView0, pView2);
+
+    // Once all references are released, a new view is created
+    ViewDesc.FirstArraySlice = 0;
+    pView0.Release();
+    pView1.Release();
+    RefCntAutoPtr<ITextureView> pView3;
+    pTexture->CreateView(ViewDesc, &pView3);
+    ASSERT_NE(pView3, nullptr);
+    EXPECT_EQ(pView3->GetDesc().MostDetailedMip, 1u);
+}
+
+} // namespace
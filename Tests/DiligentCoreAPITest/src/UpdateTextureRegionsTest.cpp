@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+Uint32 GetRegionColor(Uint32 Region)
+{
+    return 0xFF000000u | ((Region * 40u + 10u) << 16u) | (Region << 8u) | (255u - Region);
+}
+
+TEST(UpdateTextureRegionsTest, MultipleRegionsAndSubresources)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "UpdateTextureRegions test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D_ARRAY;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width     = 64;
+    TexDesc.Height    = 64;
+    TexDesc.ArraySize = 2;
+    TexDesc.MipLevels = 2;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    TexDesc.Usage     = USAGE_DEFAULT;
+
+    RefCntAutoPtr<ITexture> pTex;
+    pDevice->CreateTexture(TexDesc, nullptr, &pTex);
+    ASSERT_NE(pTex, nullptr);
+
+    // clang-format off
+    const TextureRegionUpdate Regions[] =
+    {
+        {0, 0, Box{ 0,  8,  0,  8}, {}},
+        {0, 0, Box{16, 40,  8, 12}, {}},
+        {0, 0, Box{60, 64, 56, 64}, {}},
+        {1, 0, Box{ 4, 12,  4, 20}, {}},
+        {1, 1, Box{ 0, 32,  0, 32}, {}},
+        {0, 1, Box{ 8, 16, 48, 56}, {}}
+    };
+    // clang-format on
+    constexpr Uint32 NumRegions = _countof(Regions);
+
+    std::vector<TextureRegionUpdate> Updates{Regions, Regions + NumRegions};
+    std::vector<std::vector<Uint32>> RegionData(NumRegions);
+    for (Uint32 r = 0; r < NumRegions; ++r)
+    {
+        const auto& DstBox = Updates[r].DstBox;
+        const auto  Width  = DstBox.MaxX - DstBox.MinX;
+        const auto  Height = DstBox.MaxY - DstBox.MinY;
+        RegionData[r].resize(size_t{Width} * Height, GetRegionColor(r));
+        Updates[r].SrcData = TextureSubResData{RegionData[r].data(), Width * 4};
+    }
+    pContext->UpdateTextureRegions(pTex, Updates.data(), NumRegions, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    TextureDesc StagingDesc    = TexDesc;
+    StagingDesc.Name           = "UpdateTextureRegions staging texture";
+    StagingDesc.BindFlags      = BIND_NONE;
+    StagingDesc.Usage          = USAGE_STAGING;
+    StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr);
+
+    for (Uint32 slice = 0; slice < TexDesc.ArraySize; ++slice)
+    {
+        for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+        {
+            CopyTextureAttribs CopyAttribs{pTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+            CopyAttribs.SrcMipLevel = mip;
+            CopyAttribs.SrcSlice    = slice;
+            CopyAttribs.DstMipLevel = mip;
+            CopyAttribs.DstSlice    = slice;
+            pContext->CopyTexture(CopyAttribs);
+        }
+    }
+    pContext->WaitForIdle();
+
+    for (Uint32 r = 0; r < NumRegions; ++r)
+    {
+        const auto& Update = Updates[r];
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTex, Update.MipLevel, Update.Slice, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+
+        Uint32 NumMismatches = 0;
+        for (Uint32 y = Update.DstBox.MinY; y < Update.DstBox.MaxY; ++y)
+        {
+            const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + size_t{MappedData.Stride} * y);
+            for (Uint32 x = Update.DstBox.MinX; x < Update.DstBox.MaxX; ++x)
+            {
+                if (pRow[x] != GetRegionColor(r))
+                    ++NumMismatches;
+            }
+        }
+        EXPECT_EQ(NumMismatches, 0u) << "Region " << r << " (mip " << Update.MipLevel << ", slice " << Update.Slice << ")";
+
+        pContext->UnmapTextureSubresource(pStagingTex, Update.MipLevel, Update.Slice);
+    }
+}
+
+} // namespace
@@ -0,0 +1,266 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+#include "MapHelper.hpp"
+
+#include "volk/volk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* CSSource = R"(
+cbuffer cbStatic
+{
+    uint4 g_StaticValue;
+}
+
+cbuffer cbDynamic
+{
+    uint4 g_DynamicValue;
+}
+
+Texture2D<uint>          g_Texture;
+StructuredBuffer<uint>   g_MutableData;
+RWStructuredBuffer<uint> g_Output;
+
+[numthreads(4, 1, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_Output[DTid.x] = g_StaticValue.x + g_DynamicValue.x + g_Texture.Load(int3(DTid.x, 0, 0)) + g_MutableData[DTid.x];
+}
+)";
+
+static constexpr Uint32 NumValues = 4;
+
+bool IsDescriptorBufferSupported()
+{
+    auto* pEnv = TestingEnvironmentVk::GetInstance();
+
+    uint32_t ExtensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(pEnv->GetVkPhysicalDevice(), nullptr, &ExtensionCount, nullptr);
+    std::vector<VkExtensionProperties> Extensions(ExtensionCount);
+    vkEnumerateDeviceExtensionProperties(pEnv->GetVkPhysicalDevice(), nullptr, &ExtensionCount, Extensions.data());
+    for (const auto& Ext : Extensions)
+    {
+        if (strcmp(Ext.extensionName, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) == 0)
+            return true;
+    }
+    return false;
+}
+
+RefCntAutoPtr<IBuffer> CreateBuffer(IRenderDevice* pDevice, const char* Name, USAGE Usage, BIND_FLAGS BindFlags, const Uint32* pData)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = Name;
+    BuffDesc.Usage         = Usage;
+    BuffDesc.BindFlags     = BindFlags;
+    BuffDesc.uiSizeInBytes = sizeof(Uint32) * NumValues;
+    if (Usage == USAGE_DYNAMIC)
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    if (BindFlags & (BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS))
+    {
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Uint32);
+    }
+
+    BufferData InitData{pData, BuffDesc.uiSizeInBytes};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, pData != nullptr ? &InitData : nullptr, &pBuffer);
+    return pBuffer;
+}
+
+void WriteDynamicValue(IDeviceContext* pContext, IBuffer* pBuffer, Uint32 Value)
+{
+    MapHelper<Uint32> Data{pContext, pBuffer, MAP_WRITE, MAP_FLAG_DISCARD};
+    for (Uint32 i = 0; i < NumValues; ++i)
+        Data[i] = Value;
+}
+
+void VerifyOutput(IRenderDevice* pDevice, IDeviceContext* pContext, IBuffer* pOutput, const Uint32 (&RefValues)[NumValues])
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Descriptor buffer test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    BuffDesc.uiSizeInBytes  = sizeof(RefValues);
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, BuffDesc.uiSizeInBytes, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 0; i < NumValues; ++i)
+        EXPECT_EQ(static_cast<const Uint32*>(pData)[i], RefValues[i]) << "Value " << i;
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+}
+
+// Binds static, mutable and dynamic resources of every kind on a device that lays out
+// descriptor sets in descriptor buffers and checks the values read by the shader.
+TEST(DescriptorBufferVkTest, BindResources)
+{
+    auto* pEnv = TestingEnvironmentVk::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+    if (!IsDescriptorBufferSupported())
+    {
+        GTEST_SKIP() << "VK_EXT_descriptor_buffer is not supported by this device";
+    }
+
+    RefCntAutoPtr<IRenderDevice>  pDevice;
+    RefCntAutoPtr<IDeviceContext> pContext;
+    pEnv->CreateDedicatedDevice(
+        [](EngineCreateInfo& EngineCI) {
+            static_cast<EngineVkCreateInfo&>(EngineCI).DescriptorBufferSize = 1 << 20;
+        },
+        &pDevice, &pContext);
+    ASSERT_NE(pDevice, nullptr);
+    ASSERT_NE(pContext, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "Descriptor buffer test CS";
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Source                     = CSSource;
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_NE(pCS, nullptr);
+
+    // cbStatic and g_Texture use the default static type
+    const ShaderResourceVariableDesc Vars[] =
+        {
+            {SHADER_TYPE_COMPUTE, "cbDynamic", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_COMPUTE, "g_MutableData", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_COMPUTE, "g_Output", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
+        };
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                        = "Descriptor buffer test PSO";
+    PSOCreateInfo.PSODesc.PipelineType                = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.PSODesc.ResourceLayout.Variables    = Vars;
+    PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+    PSOCreateInfo.pCS                                 = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    ASSERT_NE(pPSO, nullptr);
+
+    const Uint32 StaticValues[]   = {1000, 1000, 1000, 1000};
+    const Uint32 TextureValues[]  = {100, 200, 300, 400};
+    const Uint32 MutableValues0[] = {1, 2, 3, 4};
+    const Uint32 MutableValues1[] = {5, 6, 7, 8};
+
+    auto pStaticCB = CreateBuffer(pDevice, "Static CB", USAGE_DEFAULT, BIND_UNIFORM_BUFFER, StaticValues);
+    // Dynamic buffers have no dynamic offsets in descriptor buffer mode, so their descriptors are rewritten on every commit
+    auto pDynamicCB = CreateBuffer(pDevice, "Dynamic CB", USAGE_DYNAMIC, BIND_UNIFORM_BUFFER, nullptr);
+    auto pMutable0  = CreateBuffer(pDevice, "Mutable buffer 0", USAGE_DEFAULT, BIND_SHADER_RESOURCE, MutableValues0);
+    auto pMutable1  = CreateBuffer(pDevice, "Mutable buffer 1", USAGE_DEFAULT, BIND_SHADER_RESOURCE, MutableValues1);
+    auto pOutput0   = CreateBuffer(pDevice, "Output buffer 0", USAGE_DEFAULT, BIND_UNORDERED_ACCESS, nullptr);
+    auto pOutput1   = CreateBuffer(pDevice, "Output buffer 1", USAGE_DEFAULT, BIND_UNORDERED_ACCESS, nullptr);
+    ASSERT_TRUE(pStaticCB && pDynamicCB && pMutable0 && pMutable1 && pOutput0 && pOutput1);
+
+    RefCntAutoPtr<ITexture> pTexture;
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Descriptor buffer test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_R32_UINT;
+        TexDesc.Width     = NumValues;
+        TexDesc.Height    = 1;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureSubResData Mip0Data{TextureValues, sizeof(TextureValues)};
+        TextureData       TexData{&Mip0Data, 1};
+        pDevice->CreateTexture(TexDesc, &TexData, &pTexture);
+        ASSERT_NE(pTexture, nullptr);
+    }
+
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbStatic")->Set(pStaticCB);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Texture")->Set(pTexture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB0, pSRB1;
+    pPSO->CreateShaderResourceBinding(&pSRB0, true);
+    pPSO->CreateShaderResourceBinding(&pSRB1, true);
+    ASSERT_TRUE(pSRB0 && pSRB1);
+
+    pSRB0->GetVariableByName(SHADER_TYPE_COMPUTE, "cbDynamic")->Set(pDynamicCB);
+    pSRB0->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MutableData")->Set(pMutable0->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    pSRB1->GetVariableByName(SHADER_TYPE_COMPUTE, "cbDynamic")->Set(pDynamicCB);
+    pSRB1->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MutableData")->Set(pMutable1->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+
+    auto Dispatch = [&](IShaderResourceBinding* pSRB, IBuffer* pOutput, Uint32 DynamicValue) //
+    {
+        WriteDynamicValue(pContext, pDynamicCB, DynamicValue);
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    };
+
+    // Two SRBs with different mutable and dynamic resources in one command buffer
+    Dispatch(pSRB0, pOutput0, 10000);
+    Dispatch(pSRB1, pOutput1, 20000);
+    VerifyOutput(pDevice, pContext, pOutput0, {11101, 11202, 11303, 11404});
+    VerifyOutput(pDevice, pContext, pOutput1, {21105, 21206, 21307, 21408});
+
+    // New dynamic buffer contents and a rebound dynamic variable must be picked up by the same SRB
+    Dispatch(pSRB0, pOutput1, 30000);
+    VerifyOutput(pDevice, pContext, pOutput1, {31101, 31202, 31303, 31404});
+
+    // An SRB created after the descriptor buffer has been used gets its own descriptor space
+    RefCntAutoPtr<IShaderResourceBinding> pSRB2;
+    pPSO->CreateShaderResourceBinding(&pSRB2, true);
+    ASSERT_NE(pSRB2, nullptr);
+    pSRB2->GetVariableByName(SHADER_TYPE_COMPUTE, "cbDynamic")->Set(pDynamicCB);
+    pSRB2->GetVariableByName(SHADER_TYPE_COMPUTE, "g_MutableData")->Set(pMutable1->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+    Dispatch(pSRB2, pOutput0, 40000);
+    VerifyOutput(pDevice, pContext, pOutput0, {41105, 41206, 41307, 41408});
+}
+
+} // namespace
@@ -0,0 +1,315 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Vulkan/TestingEnvironmentVk.hpp"
+#include "PipelineStateVk.h"
+
+#include "volk/volk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Both vertex shaders output the same interface, so that either can be linked with either pixel shader
+static const char* VSSourceRed = R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position, out float4 Color : COLOR)
+{
+    float2 UV = float2((VertId << 1) & 2, VertId & 2);
+    Pos   = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+    Color = float4(1.0, 0.0, 0.0, 0.0);
+}
+)";
+
+static const char* VSSourceGreen = R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position, out float4 Color : COLOR)
+{
+    float2 UV = float2((VertId << 1) & 2, VertId & 2);
+    Pos   = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+    Color = float4(0.0, 1.0, 0.0, 0.0);
+}
+)";
+
+static const char* PSSourceAlpha = R"(
+float4 main(in float4 Pos : SV_Position, in float4 Color : COLOR) : SV_Target
+{
+    return Color + float4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* PSSourceBlue = R"(
+float4 main(in float4 Pos : SV_Position, in float4 Color : COLOR) : SV_Target
+{
+    return Color + float4(0.0, 0.0, 1.0, 1.0);
+}
+)";
+
+static constexpr TEXTURE_FORMAT RTFormat = TEX_FORMAT_RGBA8_UNORM;
+static constexpr Uint32         RTSize   = 4;
+
+bool IsGraphicsPipelineLibrarySupported()
+{
+    auto* pEnv = TestingEnvironmentVk::GetInstance();
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT GPLFeatures{};
+    GPLFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+
+    VkPhysicalDeviceFeatures2 Features{};
+    Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    Features.pNext = &GPLFeatures;
+
+    uint32_t ExtensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(pEnv->GetVkPhysicalDevice(), nullptr, &ExtensionCount, nullptr);
+    std::vector<VkExtensionProperties> Extensions(ExtensionCount);
+    vkEnumerateDeviceExtensionProperties(pEnv->GetVkPhysicalDevice(), nullptr, &ExtensionCount, Extensions.data());
+    for (const auto& Ext : Extensions)
+    {
+        if (strcmp(Ext.extensionName, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) == 0)
+        {
+            vkGetPhysicalDeviceFeatures2(pEnv->GetVkPhysicalDevice(), &Features);
+            return GPLFeatures.graphicsPipelineLibrary != VK_FALSE;
+        }
+    }
+    return false;
+}
+
+class PipelineLibraryVkTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironmentVk::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Pipeline library test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = RTFormat;
+        TexDesc.Width     = RTSize;
+        TexDesc.Height    = RTSize;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(TexDesc, nullptr, &sm_pRT);
+        ASSERT_NE(sm_pRT, nullptr);
+
+        TexDesc.Name           = "Pipeline library test staging texture";
+        TexDesc.Usage          = USAGE_STAGING;
+        TexDesc.BindFlags      = BIND_NONE;
+        TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateTexture(TexDesc, nullptr, &sm_pStagingTex);
+        ASSERT_NE(sm_pStagingTex, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pRT.Release();
+        sm_pStagingTex.Release();
+
+        auto* pEnv = TestingEnvironmentVk::GetInstance();
+        pEnv->Reset();
+    }
+
+    void SetUp() override
+    {
+        if (!IsGraphicsPipelineLibrarySupported())
+        {
+            GTEST_SKIP() << "VK_EXT_graphics_pipeline_library is not supported by this device";
+        }
+    }
+
+    static RefCntAutoPtr<IShader> CreateShader(SHADER_TYPE ShaderType, const char* Source)
+    {
+        auto* pEnv = TestingEnvironmentVk::GetInstance();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = ShaderType;
+        ShaderCI.Desc.Name                  = "Pipeline library test shader";
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Source                     = Source;
+
+        RefCntAutoPtr<IShader> pShader;
+        pEnv->GetDevice()->CreateShader(ShaderCI, &pShader);
+        return pShader;
+    }
+
+    // Shaders are created for every pipeline, so that the pipelines only share libraries through
+    // the shader byte code.
+    static RefCntAutoPtr<IPipelineState> CreatePSO(const char* VSSource, const char* PSSource, Uint8 WriteMask = COLOR_MASK_ALL)
+    {
+        auto* pEnv = TestingEnvironmentVk::GetInstance();
+
+        auto pVS = CreateShader(SHADER_TYPE_VERTEX, VSSource);
+        auto pPS = CreateShader(SHADER_TYPE_PIXEL, PSSource);
+        if (!pVS || !pPS)
+            return {};
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Pipeline library test PSO";
+
+        GraphicsPipeline.NumRenderTargets                                 = 1;
+        GraphicsPipeline.RTVFormats[0]                                    = RTFormat;
+        GraphicsPipeline.PrimitiveTopology                                = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode                          = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable                     = False;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].RenderTargetWriteMask = WriteMask;
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pEnv->GetDevice()->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static void DrawAndVerify(IPipelineState* pPSO, const Uint8 (&RefColor)[4])
+    {
+        auto* pEnv     = TestingEnvironmentVk::GetInstance();
+        auto* pContext = pEnv->GetDeviceContext();
+
+        ITextureView* pRTV = sm_pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        const float ClearColor[] = {0, 0, 0, 0};
+        pContext->ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        pContext->SetPipelineState(pPSO);
+        pContext->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+        CopyTextureAttribs CopyAttribs{sm_pRT, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, sm_pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(sm_pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 y = 0; y < RTSize; ++y)
+        {
+            const auto* pRow = static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride;
+            for (Uint32 x = 0; x < RTSize; ++x)
+            {
+                for (Uint32 c = 0; c < 4; ++c)
+                    EXPECT_EQ(pRow[x * 4 + c], RefColor[c]) << "Pixel (" << x << ", " << y << "), channel " << c;
+            }
+        }
+        pContext->UnmapTextureSubresource(sm_pStagingTex, 0, 0);
+    }
+
+    static RefCntAutoPtr<ITexture> sm_pRT;
+    static RefCntAutoPtr<ITexture> sm_pStagingTex;
+};
+
+RefCntAutoPtr<ITexture> PipelineLibraryVkTest::sm_pRT;
+RefCntAutoPtr<ITexture> PipelineLibraryVkTest::sm_pStagingTex;
+
+// Pipelines that share vertex shaders, pixel shaders and output states in every combination
+// are linked from the same cached libraries and must each produce their own result.
+TEST_F(PipelineLibraryVkTest, SharedLibraries)
+{
+    auto pRedAlpha   = CreatePSO(VSSourceRed, PSSourceAlpha);
+    auto pRedBlue    = CreatePSO(VSSourceRed, PSSourceBlue);
+    auto pGreenAlpha = CreatePSO(VSSourceGreen, PSSourceAlpha);
+    auto pGreenBlue  = CreatePSO(VSSourceGreen, PSSourceBlue);
+    // Only the fragment output interface is different from pRedBlue
+    auto pRedBlueNoBlue = CreatePSO(VSSourceRed, PSSourceBlue, COLOR_MASK_RED | COLOR_MASK_GREEN | COLOR_MASK_ALPHA);
+    ASSERT_TRUE(pRedAlpha && pRedBlue && pGreenAlpha && pGreenBlue && pRedBlueNoBlue);
+
+    DrawAndVerify(pRedAlpha, {255, 0, 0, 255});
+    DrawAndVerify(pRedBlue, {255, 0, 255, 255});
+    DrawAndVerify(pGreenAlpha, {0, 255, 0, 255});
+    DrawAndVerify(pGreenBlue, {0, 255, 255, 255});
+    DrawAndVerify(pRedBlueNoBlue, {255, 0, 0, 255});
+
+    // A pipeline created after the libraries have been cached is linked from them without compilation
+    auto pRedBlue2 = CreatePSO(VSSourceRed, PSSourceBlue);
+    ASSERT_NE(pRedBlue2, nullptr);
+    DrawAndVerify(pRedBlue2, {255, 0, 255, 255});
+}
+
+// The optimized pipeline that is linked in the background replaces the fast-linked one
+// and must produce the same result.
+TEST_F(PipelineLibraryVkTest, OptimizedLink)
+{
+    auto pPSO = CreatePSO(VSSourceGreen, PSSourceBlue);
+    ASSERT_NE(pPSO, nullptr);
+
+    RefCntAutoPtr<IPipelineStateVk> pPSOVk{pPSO, IID_PipelineStateVk};
+    ASSERT_NE(pPSOVk, nullptr);
+
+    const auto vkFastLinkedPipeline = pPSOVk->GetVkPipeline();
+    EXPECT_NE(vkFastLinkedPipeline, VK_NULL_HANDLE);
+    DrawAndVerify(pPSO, {0, 255, 255, 255});
+
+    const auto StartTime = std::chrono::steady_clock::now();
+    while (pPSOVk->GetVkPipeline() == vkFastLinkedPipeline && std::chrono::steady_clock::now() - StartTime < std::chrono::seconds{30})
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_NE(pPSOVk->GetVkPipeline(), vkFastLinkedPipeline) << "The optimized pipeline has not been linked";
+
+    DrawAndVerify(pPSO, {0, 255, 255, 255});
+}
+
+// Destroys pipelines while their optimized links are still pending on the task pool or running.
+// Pending links must be cancelled, running links must be waited for, and the libraries
+// must remain usable by other pipelines.
+TEST_F(PipelineLibraryVkTest, DestroyWhileLinkPending)
+{
+    // Pipelines created in a row enqueue more links than the task pool can run at once,
+    // so the links of the last pipelines are still pending when they are destroyed.
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        PSOs.emplace_back(CreatePSO((i & 1) ? VSSourceGreen : VSSourceRed, (i & 2) ? PSSourceBlue : PSSourceAlpha));
+        ASSERT_NE(PSOs.back(), nullptr);
+    }
+    while (!PSOs.empty())
+        PSOs.pop_back();
+
+    // A pipeline that is destroyed right after it has been used
+    {
+        auto pPSO = CreatePSO(VSSourceRed, PSSourceBlue);
+        ASSERT_NE(pPSO, nullptr);
+        DrawAndVerify(pPSO, {255, 0, 255, 255});
+    }
+
+    auto pPSO = CreatePSO(VSSourceGreen, PSSourceAlpha);
+    ASSERT_NE(pPSO, nullptr);
+    DrawAndVerify(pPSO, {0, 255, 0, 255});
+}
+
+} // namespace
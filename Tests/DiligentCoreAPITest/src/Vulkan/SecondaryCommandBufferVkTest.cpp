@@ -0,0 +1,308 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include "TestingEnvironment.hpp"
+#include "DeviceContextVk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+void main(in uint VertId : SV_VertexID, out float4 Pos : SV_Position)
+{
+    float2 UV = float2((VertId << 1) & 2, VertId & 2);
+    Pos = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return float4(0.0, 1.0, 0.0, 1.0);
+}
+)";
+
+static constexpr TEXTURE_FORMAT RTFormat = TEX_FORMAT_RGBA8_UNORM;
+static constexpr Uint32         RTSize   = 4;
+
+// Draws a full-screen triangle from a secondary command buffer recorded by a deferred context
+// into a render pass begun by the immediate context.
+class SecondaryCommandBufferVkTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (pDevice->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_VULKAN || pEnv->GetNumDeferredContexts() == 0)
+            return;
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Secondary command buffer test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = RTFormat;
+        TexDesc.Width     = RTSize;
+        TexDesc.Height    = RTSize;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+        pDevice->CreateTexture(TexDesc, nullptr, &sm_pRT);
+        ASSERT_NE(sm_pRT, nullptr);
+
+        TexDesc.Name           = "Secondary command buffer test staging texture";
+        TexDesc.Usage          = USAGE_STAGING;
+        TexDesc.BindFlags      = BIND_NONE;
+        TexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        pDevice->CreateTexture(TexDesc, nullptr, &sm_pStagingTex);
+        ASSERT_NE(sm_pStagingTex, nullptr);
+
+        RenderPassAttachmentDesc Attachments[1];
+        Attachments[0].Format       = RTFormat;
+        Attachments[0].InitialState = RESOURCE_STATE_RENDER_TARGET;
+        Attachments[0].FinalState   = RESOURCE_STATE_RENDER_TARGET;
+        Attachments[0].LoadOp       = ATTACHMENT_LOAD_OP_CLEAR;
+        Attachments[0].StoreOp      = ATTACHMENT_STORE_OP_STORE;
+
+        AttachmentReference RTAttachmentRef{0, RESOURCE_STATE_RENDER_TARGET};
+
+        SubpassDesc Subpasses[1];
+        Subpasses[0].RenderTargetAttachmentCount = 1;
+        Subpasses[0].pRenderTargetAttachments    = &RTAttachmentRef;
+
+        RenderPassDesc RPDesc;
+        RPDesc.Name            = "Secondary command buffer test render pass";
+        RPDesc.AttachmentCount = _countof(Attachments);
+        RPDesc.pAttachments    = Attachments;
+        RPDesc.SubpassCount    = _countof(Subpasses);
+        RPDesc.pSubpasses      = Subpasses;
+        pDevice->CreateRenderPass(RPDesc, &sm_pRenderPass);
+        ASSERT_NE(sm_pRenderPass, nullptr);
+
+        ITextureView* pRTV = sm_pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+        FramebufferDesc FBDesc;
+        FBDesc.Name            = "Secondary command buffer test framebuffer";
+        FBDesc.pRenderPass     = sm_pRenderPass;
+        FBDesc.AttachmentCount = 1;
+        FBDesc.ppAttachments   = &pRTV;
+        pDevice->CreateFramebuffer(FBDesc, &sm_pFramebuffer);
+        ASSERT_NE(sm_pFramebuffer, nullptr);
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "Secondary command buffer test VS";
+        ShaderCI.Source          = VSSource;
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+
+        RefCntAutoPtr<IShader> pPS;
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Secondary command buffer test PS";
+        ShaderCI.Source          = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSOCreateInfo.PSODesc.Name                    = "Secondary command buffer test PSO";
+        GraphicsPipeline.pRenderPass                  = sm_pRenderPass;
+        GraphicsPipeline.SubpassIndex                 = 0;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+        sm_pFramebuffer.Release();
+        sm_pRenderPass.Release();
+        sm_pRT.Release();
+        sm_pStagingTex.Release();
+
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+        if (pEnv->GetDevice()->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_VULKAN)
+        {
+            GTEST_SKIP() << "Secondary command buffers are only available in Vulkan";
+        }
+        if (pEnv->GetNumDeferredContexts() == 0)
+        {
+            GTEST_SKIP() << "Deferred contexts are not supported by this device";
+        }
+    }
+
+    static IDeviceContextVk* BeginSecondaryCommandBuffer()
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+
+        auto* pDeferredCtx = pEnv->GetDeviceContext(pEnv->GetNumImmediateContexts());
+        VERIFY_EXPR(pDeferredCtx->GetDesc().IsDeferred);
+
+        RefCntAutoPtr<IDeviceContextVk> pDeferredCtxVk{pDeferredCtx, IID_DeviceContextVk};
+        pDeferredCtxVk->BeginSecondaryCommandBuffer(0, sm_pRenderPass, 0, sm_pFramebuffer);
+        return pDeferredCtxVk;
+    }
+
+    // Finishes the secondary command buffer, executes it in the render pass and checks the result
+    static void ExecuteAndVerify(IDeviceContextVk* pDeferredCtx)
+    {
+        auto* pEnv     = TestingEnvironment::GetInstance();
+        auto* pContext = pEnv->GetDeviceContext();
+
+        pDeferredCtx->SetPipelineState(sm_pPSO);
+        pDeferredCtx->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+
+        RefCntAutoPtr<ICommandList> pCmdList;
+        pDeferredCtx->FinishCommandList(&pCmdList);
+        ASSERT_NE(pCmdList, nullptr);
+
+        // Transitions must be done before the render pass is begun
+        const StateTransitionDesc Barrier{sm_pRT, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, true};
+        pContext->TransitionResourceStates(1, &Barrier);
+
+        OptimizedClearValue ClearValue;
+
+        BeginRenderPassAttribs RPBeginInfo;
+        RPBeginInfo.pRenderPass         = sm_pRenderPass;
+        RPBeginInfo.pFramebuffer        = sm_pFramebuffer;
+        RPBeginInfo.pClearValues        = &ClearValue;
+        RPBeginInfo.ClearValueCount     = 1;
+        RPBeginInfo.StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+
+        RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+        pContextVk->BeginRenderPassWithSecondaryCommandBuffers(RPBeginInfo);
+        ICommandList* pCmdLists[] = {pCmdList};
+        pContext->ExecuteCommandLists(1, pCmdLists);
+        pContext->EndRenderPass();
+
+        CopyTextureAttribs CopyAttribs{sm_pRT, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, sm_pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+        pDeferredCtx->FinishFrame();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(sm_pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        for (Uint32 y = 0; y < RTSize; ++y)
+        {
+            const auto* pRow = static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride;
+            for (Uint32 x = 0; x < RTSize; ++x)
+            {
+                const Uint8 RefColor[] = {0, 255, 0, 255};
+                for (Uint32 c = 0; c < 4; ++c)
+                    EXPECT_EQ(pRow[x * 4 + c], RefColor[c]) << "Pixel (" << x << ", " << y << "), channel " << c;
+            }
+        }
+        pContext->UnmapTextureSubresource(sm_pStagingTex, 0, 0);
+    }
+
+    static RefCntAutoPtr<ITexture>       sm_pRT;
+    static RefCntAutoPtr<ITexture>       sm_pStagingTex;
+    static RefCntAutoPtr<IRenderPass>    sm_pRenderPass;
+    static RefCntAutoPtr<IFramebuffer>   sm_pFramebuffer;
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+};
+
+RefCntAutoPtr<ITexture>       SecondaryCommandBufferVkTest::sm_pRT;
+RefCntAutoPtr<ITexture>       SecondaryCommandBufferVkTest::sm_pStagingTex;
+RefCntAutoPtr<IRenderPass>    SecondaryCommandBufferVkTest::sm_pRenderPass;
+RefCntAutoPtr<IFramebuffer>   SecondaryCommandBufferVkTest::sm_pFramebuffer;
+RefCntAutoPtr<IPipelineState> SecondaryCommandBufferVkTest::sm_pPSO;
+
+TEST_F(SecondaryCommandBufferVkTest, Draw)
+{
+    auto* pDeferredCtx = BeginSecondaryCommandBuffer();
+    ExecuteAndVerify(pDeferredCtx);
+}
+
+// Resource state transitions in a secondary command buffer are rejected without recording
+// any barriers, so the command buffer remains valid.
+TEST_F(SecondaryCommandBufferVkTest, RejectStateTransitions)
+{
+#if !defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_DEBUG)
+    // The check is disabled in release builds and is an assertion in debug builds
+    GTEST_SKIP() << "This test requires a development build without debug assertions";
+#else
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name          = "Secondary command buffer test vertex buffer";
+    BuffDesc.Usage         = USAGE_DEFAULT;
+    BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+    BuffDesc.uiSizeInBytes = 64;
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pEnv->GetDevice()->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    const StateTransitionDesc Barrier{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, true};
+    pEnv->GetDeviceContext()->TransitionResourceStates(1, &Barrier);
+
+    auto* pDeferredCtx = BeginSecondaryCommandBuffer();
+
+    pEnv->SetErrorAllowance(2, "Errors below are expected: testing state transitions in a secondary command buffer\n");
+    pEnv->PushExpectedErrorSubstring("not allowed in a secondary command buffer");
+    pEnv->PushExpectedErrorSubstring("not allowed in a secondary command buffer", false);
+
+    const StateTransitionDesc VBBarrier{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, true};
+    pDeferredCtx->TransitionResourceStates(1, &VBBarrier);
+
+    IBuffer* pVBs[]    = {pBuffer};
+    Uint32   Offsets[] = {0};
+    pDeferredCtx->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    pEnv->SetErrorAllowance(0);
+    EXPECT_EQ(pBuffer->GetState(), RESOURCE_STATE_COPY_DEST);
+
+    // Unbind the buffer so that the draw command does not verify its state
+    pDeferredCtx->SetVertexBuffers(0, 0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    ExecuteAndVerify(pDeferredCtx);
+#endif
+}
+
+} // namespace
@@ -0,0 +1,318 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Vulkan command buffers batch barriers into a single vkCmdPipelineBarrier and
+// record split transitions with events. The tests check that resources end up
+// in the requested layouts with their contents intact; layout mismatches are
+// also reported by the validation layers.
+class StateTransitionVkTest : public ::testing::Test
+{
+protected:
+    static constexpr Uint32 BufferSize = 256;
+    static constexpr Uint32 TexSize    = 8;
+    static constexpr Uint32 NumMips    = 2;
+
+    void SetUp() override
+    {
+        if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Type != RENDER_DEVICE_TYPE_VULKAN)
+        {
+            GTEST_SKIP() << "This test requires a Vulkan device";
+        }
+    }
+
+    static Uint32 GetBufferValue(Uint32 Seed, Uint32 i)
+    {
+        return Seed * 1000 + i;
+    }
+
+    static Uint32 GetTexelValue(Uint32 Mip, Uint32 i)
+    {
+        return 0x01000000u * (Mip + 1) + i;
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateBuffer(Uint32 Seed)
+    {
+        std::vector<Uint32> Data(BufferSize / sizeof(Uint32));
+        for (Uint32 i = 0; i < Data.size(); ++i)
+            Data[i] = GetBufferValue(Seed, i);
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name          = "State transition test buffer";
+        BuffDesc.Usage         = USAGE_DEFAULT;
+        BuffDesc.BindFlags     = BIND_VERTEX_BUFFER;
+        BuffDesc.uiSizeInBytes = BufferSize;
+
+        BufferData InitData{Data.data(), BufferSize};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return pBuffer;
+    }
+
+    static RefCntAutoPtr<ITexture> CreateTexture()
+    {
+        std::vector<Uint32>            MipData[NumMips];
+        std::vector<TextureSubResData> SubResources(NumMips);
+        for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        {
+            const auto MipSize = TexSize >> Mip;
+            MipData[Mip].resize(MipSize * MipSize);
+            for (Uint32 i = 0; i < MipData[Mip].size(); ++i)
+                MipData[Mip][i] = GetTexelValue(Mip, i);
+            SubResources[Mip] = TextureSubResData{MipData[Mip].data(), MipSize * Uint32{sizeof(Uint32)}};
+        }
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "State transition test texture";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UINT;
+        TexDesc.Width     = TexSize;
+        TexDesc.Height    = TexSize;
+        TexDesc.MipLevels = NumMips;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+        TextureData InitData{SubResources.data(), NumMips};
+
+        RefCntAutoPtr<ITexture> pTexture;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateTexture(TexDesc, &InitData, &pTexture);
+        return pTexture;
+    }
+
+    // Copies the buffer that must be in COPY_SOURCE state to a staging buffer and checks its contents
+    static void VerifyBuffer(IBuffer* pBuffer, Uint32 Seed, RESOURCE_STATE_TRANSITION_MODE TransitionMode)
+    {
+        auto* pEnv     = TestingEnvironment::GetInstance();
+        auto* pContext = pEnv->GetDeviceContext();
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "State transition test staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.uiSizeInBytes  = BufferSize;
+
+        RefCntAutoPtr<IBuffer> pStagingBuffer;
+        pEnv->GetDevice()->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+        ASSERT_NE(pStagingBuffer, nullptr);
+
+        pContext->CopyBuffer(pBuffer, 0, TransitionMode, pStagingBuffer, 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        for (Uint32 i = 0; i < BufferSize / sizeof(Uint32); ++i)
+            EXPECT_EQ(static_cast<const Uint32*>(pData)[i], GetBufferValue(Seed, i)) << "Value " << i;
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+
+    // Copies the mip level that must be in COPY_SOURCE state to a staging texture and checks its contents
+    static void VerifyTexture(ITexture* pTexture, Uint32 Mip, RESOURCE_STATE_TRANSITION_MODE TransitionMode)
+    {
+        auto* pEnv     = TestingEnvironment::GetInstance();
+        auto* pContext = pEnv->GetDeviceContext();
+
+        auto StagingDesc           = pTexture->GetDesc();
+        StagingDesc.Name           = "State transition test staging texture";
+        StagingDesc.Usage          = USAGE_STAGING;
+        StagingDesc.BindFlags      = BIND_NONE;
+        StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+        RefCntAutoPtr<ITexture> pStagingTex;
+        pEnv->GetDevice()->CreateTexture(StagingDesc, nullptr, &pStagingTex);
+        ASSERT_NE(pStagingTex, nullptr);
+
+        CopyTextureAttribs CopyAttribs{pTexture, TransitionMode, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        CopyAttribs.SrcMipLevel = Mip;
+        CopyAttribs.DstMipLevel = Mip;
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTex, Mip, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        const auto MipSize = TexSize >> Mip;
+        for (Uint32 y = 0; y < MipSize; ++y)
+        {
+            const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride);
+            for (Uint32 x = 0; x < MipSize; ++x)
+                EXPECT_EQ(pRow[x], GetTexelValue(Mip, x + y * MipSize)) << "Mip " << Mip << ", texel (" << x << ", " << y << ")";
+        }
+        pContext->UnmapTextureSubresource(pStagingTex, Mip, 0);
+    }
+
+    static StateTransitionDesc MakeBufferBarrier(IBuffer* pBuffer, RESOURCE_STATE NewState, STATE_TRANSITION_TYPE TransitionType, bool UpdateState)
+    {
+        StateTransitionDesc Barrier{pBuffer, RESOURCE_STATE_UNKNOWN, NewState, UpdateState};
+        Barrier.TransitionType = TransitionType;
+        return Barrier;
+    }
+
+    static StateTransitionDesc MakeTextureBarrier(ITexture* pTexture, RESOURCE_STATE NewState, STATE_TRANSITION_TYPE TransitionType, bool UpdateState)
+    {
+        return StateTransitionDesc{pTexture, RESOURCE_STATE_UNKNOWN, NewState, 0, REMAINING_MIP_LEVELS, 0, REMAINING_ARRAY_SLICES, TransitionType, UpdateState};
+    }
+};
+
+// Barriers in one vkCmdPipelineBarrier are not ordered, so a barrier on a subresource range or
+// a buffer that overlaps a pending barrier must be recorded after the pending one.
+TEST_F(StateTransitionVkTest, OverlappingBarriers)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pTexture = CreateTexture();
+    auto pBuffer  = CreateBuffer(1);
+    ASSERT_TRUE(pTexture && pBuffer);
+
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                // The whole texture, then mip level 1 only
+                StateTransitionDesc{pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST, true},
+                StateTransitionDesc{pTexture, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_COPY_SOURCE, 1, 1},
+                // The same buffer twice
+                StateTransitionDesc{pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, true},
+                StateTransitionDesc{pBuffer, RESOURCE_STATE_VERTEX_BUFFER, RESOURCE_STATE_COPY_SOURCE, true},
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    // The internal state of the texture is COPY_DEST, while mip level 1 is in COPY_SOURCE state
+    VerifyTexture(pTexture, 1, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    VerifyBuffer(pBuffer, 1, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    // Mip level 1 is in a different state than the rest of the texture
+    pTexture->SetState(RESOURCE_STATE_UNKNOWN);
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                // Mip level 1 only, then the whole texture
+                StateTransitionDesc{pTexture, RESOURCE_STATE_COPY_SOURCE, RESOURCE_STATE_COPY_DEST, 1, 1},
+                StateTransitionDesc{pTexture, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_COPY_SOURCE, true},
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        VerifyTexture(pTexture, Mip, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+}
+
+// A split transition is recorded with vkCmdSetEvent at the begin barrier and vkCmdWaitEvents
+// at the end barrier. Other commands recorded in between are not affected.
+TEST_F(StateTransitionVkTest, SplitBarriers)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pTexture = CreateTexture();
+    auto pBuffer0 = CreateBuffer(1);
+    auto pBuffer1 = CreateBuffer(2);
+    ASSERT_TRUE(pTexture && pBuffer0 && pBuffer1);
+
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                MakeTextureBarrier(pTexture, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_BEGIN, false),
+                MakeBufferBarrier(pBuffer0, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_BEGIN, false),
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+
+    // Work between the begin and end barriers
+    VerifyBuffer(pBuffer1, 2, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                MakeTextureBarrier(pTexture, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_END, true),
+                MakeBufferBarrier(pBuffer0, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_END, true),
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_COPY_SOURCE);
+    EXPECT_EQ(pBuffer0->GetState(), RESOURCE_STATE_COPY_SOURCE);
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        VerifyTexture(pTexture, Mip, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    VerifyBuffer(pBuffer0, 1, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+}
+
+// An end barrier without a matching begin barrier is recorded as a regular barrier,
+// also when it is mixed with split transitions in the same call.
+TEST_F(StateTransitionVkTest, EndWithoutBegin)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    auto pTexture = CreateTexture();
+    auto pBuffer0 = CreateBuffer(1);
+    auto pBuffer1 = CreateBuffer(2);
+    ASSERT_TRUE(pTexture && pBuffer0 && pBuffer1);
+
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                MakeTextureBarrier(pTexture, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_END, true),
+                MakeBufferBarrier(pBuffer0, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_END, true),
+                MakeBufferBarrier(pBuffer1, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_BEGIN, false),
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    EXPECT_EQ(pTexture->GetState(), RESOURCE_STATE_COPY_SOURCE);
+    EXPECT_EQ(pBuffer0->GetState(), RESOURCE_STATE_COPY_SOURCE);
+    for (Uint32 Mip = 0; Mip < NumMips; ++Mip)
+        VerifyTexture(pTexture, Mip, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    VerifyBuffer(pBuffer0, 1, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    // The split transition of the second buffer is ended together with a new end barrier that has no begin
+    {
+        const StateTransitionDesc Barriers[] = //
+            {
+                MakeBufferBarrier(pBuffer1, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_TYPE_END, true),
+                MakeBufferBarrier(pBuffer0, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_TYPE_END, true),
+            };
+        pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+    }
+    EXPECT_EQ(pBuffer0->GetState(), RESOURCE_STATE_VERTEX_BUFFER);
+    EXPECT_EQ(pBuffer1->GetState(), RESOURCE_STATE_COPY_SOURCE);
+    VerifyBuffer(pBuffer1, 2, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    VerifyBuffer(pBuffer0, 1, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+} // namespace
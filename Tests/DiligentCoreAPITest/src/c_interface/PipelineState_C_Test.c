@@ -43,6 +43,9 @@ int TestPipelineStateCInterface(struct IPipelineState* pPSO)
     Uint32 StaticVarCount = 0;
     bool   IsComptible    = false;
 
+    const ShaderStatistics* pStatistics = NULL;
+    Uint32                  NumStages   = 0;
+
     IShaderResourceVariable* pVar = NULL;
     IShaderResourceBinding*  pSRB = NULL;
 
@@ -99,6 +102,11 @@ int TestPipelineStateCInterface(struct IPipelineState* pPSO)
     if (!IsComptible)
         ++num_errors;
 
+    // The pipeline is created without PSO_CREATE_FLAG_CAPTURE_STATISTICS
+    pStatistics = IPipelineState_GetStatistics(pPSO, &NumStages);
+    if (pStatistics != NULL || NumStages != 0)
+        ++num_errors;
+
     return num_errors;
 }
 
@@ -33,13 +33,16 @@ int TestObjectCInterface(struct IObject* pObject);
 
 int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
 {
-    IObject*                  pUnknown = NULL;
-    ReferenceCounterValueType RefCnt1 = 0, RefCnt2 = 0;
-    RenderDeviceInfo          DeviceInfo;
-    GraphicsAdapterInfo       AdapterInfo;
-    TextureFormatInfo         TexFmtInfo;
-    TextureFormatInfoExt      TexFmtInfoExt;
-    IEngineFactory*           pFactory = NULL;
+    IObject*                     pUnknown = NULL;
+    ReferenceCounterValueType    RefCnt1 = 0, RefCnt2 = 0;
+    RenderDeviceInfo             DeviceInfo;
+    GraphicsAdapterInfo          AdapterInfo;
+    TextureFormatInfo            TexFmtInfo;
+    TextureFormatInfoExt         TexFmtInfoExt;
+    RenderDeviceMemoryStatistics MemStats;
+    ResourceSnapshot             Snapshot;
+    IDataBlob*                   pObjects = NULL;
+    IEngineFactory*              pFactory = NULL;
 
     int num_errors = TestObjectCInterface((struct IObject*)pRenderDevice);
 
@@ -76,6 +79,22 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     IRenderDevice_IdleGPU(pRenderDevice);
     IRenderDevice_ReleaseStaleResources(pRenderDevice, false);
 
+    IRenderDevice_GetMemoryStatistics(pRenderDevice, &MemStats);
+    if (MemStats.NumHeaps > MAX_MEMORY_HEAPS || MemStats.NumMemoryTypes > MAX_MEMORY_TYPES)
+        ++num_errors;
+
+    IRenderDevice_SetMemoryAllocationCallback(pRenderDevice, NULL, NULL);
+
+    IRenderDevice_CaptureResourceSnapshot(pRenderDevice, &Snapshot, &pObjects);
+    if (pObjects != NULL)
+    {
+        if (IDataBlob_GetSize(pObjects) < Snapshot.NumObjects[DEVICE_OBJECT_TYPE_BUFFER] * sizeof(LiveObjectInfo))
+            ++num_errors;
+        IObject_Release(pObjects);
+    }
+    else
+        ++num_errors;
+
     pFactory = IRenderDevice_GetEngineFactory(pRenderDevice);
     if (pFactory == NULL)
         ++num_errors;
@@ -41,6 +41,8 @@ int TestShaderCInterface(struct IShader* pShader)
     ShaderDesc         ShaderDesc;
     Uint32             ResourceCount = 0;
     ShaderResourceDesc ResourceDesc;
+    const void*        pBytecode    = NULL;
+    Uint64             BytecodeSize = 0;
 
     int num_errors =
         TestObjectCInterface((struct IObject*)pShader) +
@@ -81,5 +83,10 @@ int TestShaderCInterface(struct IShader* pShader)
     if (ResourceDesc.ArraySize == 0)
         ++num_errors;
 
+    // OpenGL shaders have no byte code
+    IShader_GetBytecode(pShader, &pBytecode, &BytecodeSize);
+    if ((pBytecode == NULL) != (BytecodeSize == 0))
+        ++num_errors;
+
     return num_errors;
 }
@@ -76,6 +76,7 @@ void TestSwapChainC_API(struct ISwapChain* pSwapChain)
     ISwapChain_Resize(pSwapChain, 1024, 768, SURFACE_TRANSFORM_OPTIMAL);
     ISwapChain_SetFullscreenMode(pSwapChain, pDisplayMode);
     ISwapChain_SetMaximumFrameLatency(pSwapChain, 1);
+    ISwapChain_WaitForFrame(pSwapChain);
     ISwapChain_SetWindowedMode(pSwapChain);
     pDSV = ISwapChain_GetDepthBufferDSV(pSwapChain);
 }
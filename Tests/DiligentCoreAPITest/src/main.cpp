@@ -127,6 +127,10 @@ int main(int argc, char** argv)
         {
             TestEnvCI.ForceNonSeparablePrograms = true;
         }
+        else if (strcmp(arg, "--vk_descriptor_buffer") == 0)
+        {
+            TestEnvCI.UseVkDescriptorBuffer = true;
+        }
     }
 
     if (TestEnvCI.deviceType == RENDER_DEVICE_TYPE_UNDEFINED)
@@ -140,6 +144,11 @@ int main(int argc, char** argv)
         LOG_ERROR_MESSAGE("Non-separable programs can only be forced for OpenGL device.");
     }
 
+    if (TestEnvCI.UseVkDescriptorBuffer && TestEnvCI.deviceType != RENDER_DEVICE_TYPE_VULKAN)
+    {
+        LOG_ERROR_MESSAGE("Descriptor buffer can only be used by Vulkan device.");
+    }
+
     SwapChainDesc SCDesc;
     SCDesc.Width             = 512;
     SCDesc.Height            = 512;
@@ -185,6 +194,8 @@ int main(int argc, char** argv)
 #if VULKAN_SUPPORTED
             case RENDER_DEVICE_TYPE_VULKAN:
                 std::cout << "\n\n\n==================== Testing Diligent Core API in Vulkan mode ====================\n\n";
+                if (TestEnvCI.UseVkDescriptorBuffer)
+                    std::cout << "Using descriptor buffers\n";
                 pEnv = CreateTestingEnvironmentVk(TestEnvCI, SCDesc);
                 break;
 #endif
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void FixedBlockMemoryAllocator_AllocateFree(benchmark::State& State)
+{
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 1024};
+
+    const auto NumBlocks = static_cast<size_t>(State.range(0));
+
+    std::vector<void*> Blocks(NumBlocks);
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Blocks.data());
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(FixedBlockMemoryAllocator_AllocateFree)->Arg(16)->Arg(1024)->Arg(16384);
+
+// Measures how allocation throughput scales with the number of threads
+void FixedBlockMemoryAllocator_AllocateFreeMT(benchmark::State& State)
+{
+    static FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 1024};
+
+    std::vector<void*> Blocks(256);
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Blocks.data());
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Blocks.size()));
+}
+BENCHMARK(FixedBlockMemoryAllocator_AllocateFreeMT)->ThreadRange(1, 32)->UseRealTime();
+
+} // namespace
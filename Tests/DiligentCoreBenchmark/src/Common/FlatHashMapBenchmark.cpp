@@ -0,0 +1,199 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+#include "HashUtils.hpp"
+#include "UniqueIdentifier.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+constexpr size_t NumKeys = 10000;
+
+// Object unique identifiers are allocated sequentially, with gaps left by other object types
+struct UniqueIdKeys
+{
+    using KeyType    = UniqueIdentifier;
+    using HasherType = std::hash<UniqueIdentifier>;
+
+    static void Generate(std::vector<KeyType>& Keys, std::vector<KeyType>& MissKeys)
+    {
+        std::mt19937     Gen{0};
+        UniqueIdentifier Id = 1;
+        for (size_t i = 0; i < NumKeys; ++i)
+        {
+            Keys.push_back(Id);
+            MissKeys.push_back(Id + 1);
+            Id += 2 + static_cast<UniqueIdentifier>(Gen() % 8);
+        }
+        std::shuffle(Keys.begin(), Keys.end(), Gen);
+    }
+};
+
+// Key that mimics the FBO cache key: a POD structure hashed with ComputeHashRaw
+struct PODKey
+{
+    UniqueIdentifier Ids[9];
+    Uint32           Formats[9];
+
+    bool operator==(const PODKey& rhs) const
+    {
+        return memcmp(this, &rhs, sizeof(*this)) == 0;
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const PODKey& Key) const
+        {
+            return ComputeHashRaw(&Key, sizeof(Key));
+        }
+    };
+};
+
+struct PODKeys
+{
+    using KeyType    = PODKey;
+    using HasherType = PODKey::Hasher;
+
+    static void Generate(std::vector<KeyType>& Keys, std::vector<KeyType>& MissKeys)
+    {
+        std::mt19937 Gen{0};
+        Keys.resize(NumKeys);
+        MissKeys.resize(NumKeys);
+        for (size_t i = 0; i < NumKeys; ++i)
+        {
+            auto& Key = Keys[i];
+            memset(&Key, 0, sizeof(Key));
+            for (Uint32 rt = 0; rt < 1 + Gen() % 4; ++rt)
+            {
+                Key.Ids[rt]     = static_cast<UniqueIdentifier>(Gen() % (NumKeys * 4));
+                Key.Formats[rt] = Gen() % 100;
+            }
+            MissKeys[i] = Key;
+            MissKeys[i].Ids[8] += 1;
+        }
+    }
+};
+
+// Identifiers of the kind found in shaders
+struct StringKeys
+{
+    using KeyType    = std::string;
+    using HasherType = std::hash<std::string>;
+
+    static void Generate(std::vector<KeyType>& Keys, std::vector<KeyType>& MissKeys)
+    {
+        const std::string Prefixes[] = {"g_Texture", "g_Sampler", "cbCameraAttribs", "g_tex2DShadowMap", "f4Position"};
+        for (size_t i = 0; i < NumKeys; ++i)
+        {
+            Keys.push_back(Prefixes[i % 5] + std::to_string(i));
+            MissKeys.push_back(Keys.back() + "_");
+        }
+    }
+};
+
+template <typename KeysType>
+using StdMap = std::unordered_map<typename KeysType::KeyType, size_t, typename KeysType::HasherType>;
+
+template <typename KeysType>
+using FlatMap = FlatHashMap<typename KeysType::KeyType, size_t, typename KeysType::HasherType>;
+
+// Looks up every key once and every missing key once per iteration
+template <template <typename> class MapType, typename KeysType>
+void FlatHashMap_Lookup(benchmark::State& State)
+{
+    std::vector<typename KeysType::KeyType> Keys, MissKeys;
+    KeysType::Generate(Keys, MissKeys);
+
+    MapType<KeysType> Map;
+    for (size_t i = 0; i < Keys.size(); ++i)
+        Map.emplace(Keys[i], i);
+
+    for (auto _ : State)
+    {
+        size_t Checksum = 0;
+        for (const auto& Key : Keys)
+        {
+            auto it = Map.find(Key);
+            if (it != Map.end())
+                Checksum += it->second;
+        }
+        for (const auto& Key : MissKeys)
+            Checksum += Map.find(Key) != Map.end() ? 1 : 0;
+        benchmark::DoNotOptimize(Checksum);
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Keys.size() + MissKeys.size()));
+}
+
+// Keeps a sliding window of live entries, the way the caches add and evict objects
+template <template <typename> class MapType, typename KeysType>
+void FlatHashMap_InsertErase(benchmark::State& State)
+{
+    std::vector<typename KeysType::KeyType> Keys, MissKeys;
+    KeysType::Generate(Keys, MissKeys);
+
+    const size_t Window = Keys.size() / 4;
+    for (auto _ : State)
+    {
+        MapType<KeysType> Map;
+        for (size_t i = 0; i < Keys.size(); ++i)
+        {
+            Map.emplace(Keys[i], i);
+            if (i >= Window)
+                Map.erase(Keys[i - Window]);
+        }
+        benchmark::DoNotOptimize(Map.size());
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Keys.size()));
+}
+
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, StdMap, UniqueIdKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, FlatMap, UniqueIdKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, StdMap, PODKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, FlatMap, PODKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, StdMap, StringKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_Lookup, FlatMap, StringKeys);
+
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, StdMap, UniqueIdKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, FlatMap, UniqueIdKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, StdMap, PODKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, FlatMap, PODKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, StdMap, StringKeys);
+BENCHMARK_TEMPLATE(FlatHashMap_InsertErase, FlatMap, StringKeys);
+
+} // namespace
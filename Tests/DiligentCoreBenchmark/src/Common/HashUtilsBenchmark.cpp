@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "HashUtils.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void HashUtils_WyHash(benchmark::State& State)
+{
+    const std::vector<Uint8> Data(static_cast<size_t>(State.range(0)), Uint8{0x5A});
+    for (auto _ : State)
+        benchmark::DoNotOptimize(WyHash::Hash(Data.data(), Data.size()));
+    State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(HashUtils_WyHash)->RangeMultiplier(4)->Range(8, 64 << 10);
+
+void HashUtils_ComputeHashRaw(benchmark::State& State)
+{
+    const std::vector<Uint8> Data(static_cast<size_t>(State.range(0)), Uint8{0x5A});
+    for (auto _ : State)
+        benchmark::DoNotOptimize(ComputeHashRaw(Data.data(), Data.size()));
+    State.SetBytesProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(HashUtils_ComputeHashRaw)->RangeMultiplier(4)->Range(8, 64 << 10);
+
+void HashUtils_ComputeHash(benchmark::State& State)
+{
+    const Uint32 A = 1;
+    const float  B = 2.5f;
+    const Uint64 C = 3;
+    for (auto _ : State)
+        benchmark::DoNotOptimize(ComputeHash(A, B, C, A, B, C));
+}
+BENCHMARK(HashUtils_ComputeHash);
+
+void HashUtils_HashMapStringKey(benchmark::State& State)
+{
+    const std::string Str(static_cast<size_t>(State.range(0)), 'x');
+    for (auto _ : State)
+    {
+        HashMapStringKey Key{Str.c_str()};
+        benchmark::DoNotOptimize(Key.GetHash());
+    }
+}
+BENCHMARK(HashUtils_HashMapStringKey)->Arg(8)->Arg(64)->Arg(512);
+
+} // namespace
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "LargePageMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "FastRand.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Mimics the objects that are visited during command submission: every draw touches
+// a few small objects (resource caches, signatures, pool entries) that are scattered in memory.
+struct SubmissionObject
+{
+    SubmissionObject* pNext;
+    Uint64            Data[15];
+};
+
+// Allocates the objects interleaved with other allocations of random sizes, like the engine does while
+// loading a scene, links them in a random order, and measures the time to visit all of them.
+// The working set is large enough that the visits are dominated by TLB and cache misses.
+void VisitObjects(benchmark::State& State, IMemoryAllocator& Allocator)
+{
+    const auto NumObjects = static_cast<size_t>(State.range(0));
+
+    FastRandInt RndSize{0, 16, 512};
+
+    std::vector<SubmissionObject*> Objects(NumObjects);
+    std::vector<void*>             OtherAllocations(NumObjects);
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        Objects[i]          = static_cast<SubmissionObject*>(Allocator.Allocate(sizeof(SubmissionObject), "Submission object", __FILE__, __LINE__));
+        OtherAllocations[i] = Allocator.Allocate(static_cast<size_t>(RndSize()), "Other allocation", __FILE__, __LINE__);
+    }
+
+    auto Order = Objects;
+    std::shuffle(Order.begin(), Order.end(), std::mt19937{0});
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        Order[i]->pNext   = i + 1 < NumObjects ? Order[i + 1] : nullptr;
+        Order[i]->Data[0] = i;
+    }
+
+    for (auto _ : State)
+    {
+        Uint64 Sum = 0;
+        for (const auto* pObj = Order.front(); pObj != nullptr; pObj = pObj->pNext)
+            Sum += pObj->Data[0];
+        benchmark::DoNotOptimize(Sum);
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+
+    for (size_t i = 0; i < NumObjects; ++i)
+    {
+        Allocator.Free(Objects[i]);
+        Allocator.Free(OtherAllocations[i]);
+    }
+}
+
+void LargePageMemoryAllocator_VisitObjects_Default(benchmark::State& State)
+{
+    VisitObjects(State, DefaultRawMemoryAllocator::GetAllocator());
+}
+
+// Same packing as with large pages, which separates the effect of the pages from the effect of the layout
+void LargePageMemoryAllocator_VisitObjects_RegularPages(benchmark::State& State)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.UseLargePages = false;
+    LargePageMemoryAllocator Allocator{CI};
+    VisitObjects(State, Allocator);
+}
+
+void LargePageMemoryAllocator_VisitObjects_LargePages(benchmark::State& State)
+{
+    LargePageMemoryAllocator Allocator{LargePageMemoryAllocatorCreateInfo{}};
+    if (!Allocator.IsUsingLargePages())
+    {
+        State.SkipWithError("Large pages are not available");
+        return;
+    }
+    VisitObjects(State, Allocator);
+}
+
+BENCHMARK(LargePageMemoryAllocator_VisitObjects_Default)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 18);
+BENCHMARK(LargePageMemoryAllocator_VisitObjects_RegularPages)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 18);
+BENCHMARK(LargePageMemoryAllocator_VisitObjects_LargePages)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 18);
+
+void LargePageMemoryAllocator_AllocateFree(benchmark::State& State)
+{
+    LargePageMemoryAllocator Allocator{LargePageMemoryAllocatorCreateInfo{}};
+
+    std::vector<void*> Blocks(1024);
+    for (auto _ : State)
+    {
+        for (auto& pBlock : Blocks)
+            pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+        benchmark::DoNotOptimize(Blocks.data());
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Blocks.size()));
+}
+BENCHMARK(LargePageMemoryAllocator_AllocateFree);
+
+} // namespace
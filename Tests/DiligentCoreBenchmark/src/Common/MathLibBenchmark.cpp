@@ -0,0 +1,141 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "AdvancedMath.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<BoundBox> CreateBoxes(size_t NumBoxes)
+{
+    std::vector<BoundBox> Boxes(NumBoxes);
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        const auto x = static_cast<float>(i % 32) * 4.f - 64.f;
+        const auto z = static_cast<float>(i / 32) * 4.f;
+
+        Boxes[i].Min = float3{x, -1.f, z};
+        Boxes[i].Max = float3{x + 2.f, 1.f, z + 2.f};
+    }
+    return Boxes;
+}
+
+void BasicMath_MatrixMultiply(benchmark::State& State)
+{
+    const auto A = float4x4::RotationY(0.5f) * float4x4::Translation(1.f, 2.f, 3.f);
+    const auto B = float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false);
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(A * B);
+    }
+}
+BENCHMARK(BasicMath_MatrixMultiply);
+
+void BasicMath_TransformVector(benchmark::State& State)
+{
+    const auto M = float4x4::RotationY(0.5f) * float4x4::Translation(1.f, 2.f, 3.f);
+    const auto v = float4{1.f, 2.f, 3.f, 1.f};
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(v * M);
+    }
+}
+BENCHMARK(BasicMath_TransformVector);
+
+void BasicMath_MatrixInverse(benchmark::State& State)
+{
+    const auto M = float4x4::RotationY(0.5f) * float4x4::Translation(1.f, 2.f, 3.f);
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(M.Inverse());
+    }
+}
+BENCHMARK(BasicMath_MatrixInverse);
+
+void AdvancedMath_ExtractViewFrustumPlanes(benchmark::State& State)
+{
+    const auto ViewProj = float4x4::Translation(0.f, 0.f, 5.f) * float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false);
+    for (auto _ : State)
+    {
+        ViewFrustum Frustum;
+        ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+        benchmark::DoNotOptimize(Frustum);
+    }
+}
+BENCHMARK(AdvancedMath_ExtractViewFrustumPlanes);
+
+void AdvancedMath_GetBoxVisibility(benchmark::State& State)
+{
+    const auto ViewProj = float4x4::Translation(0.f, 0.f, 5.f) * float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false);
+
+    ViewFrustum Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    const auto Boxes = CreateBoxes(static_cast<size_t>(State.range(0)));
+    for (auto _ : State)
+    {
+        Uint32 NumVisible = 0;
+        for (const auto& Box : Boxes)
+        {
+            if (GetBoxVisibility(Frustum, Box) != BoxVisibility::Invisible)
+                ++NumVisible;
+        }
+        benchmark::DoNotOptimize(NumVisible);
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(AdvancedMath_GetBoxVisibility)->Arg(1024)->Arg(16384);
+
+void AdvancedMath_IntersectRayAABB(benchmark::State& State)
+{
+    const auto Boxes = CreateBoxes(static_cast<size_t>(State.range(0)));
+
+    const float3 RayOrigin{0.f, 0.f, -10.f};
+    const float3 RayDirection = normalize(float3{0.1f, 0.f, 1.f});
+    for (auto _ : State)
+    {
+        Uint32 NumHits = 0;
+        for (const auto& Box : Boxes)
+        {
+            float EnterDist = 0, ExitDist = 0;
+            if (IntersectRayAABB(RayOrigin, RayDirection, Box, EnterDist, ExitDist))
+                ++NumHits;
+        }
+        benchmark::DoNotOptimize(NumHits);
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(AdvancedMath_IntersectRayAABB)->Arg(1024)->Arg(16384);
+
+} // namespace
@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "DynamicAtlasManager.hpp"
+#include "FastRand.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void DynamicAtlasManager_AllocateFree(benchmark::State& State)
+{
+    const auto Strategy = static_cast<DynamicAtlasManager::PACKING_STRATEGY>(State.range(0));
+
+    DynamicAtlasManager Mgr{2048, 2048, Strategy};
+
+    std::vector<DynamicAtlasManager::Region> Regions;
+    Regions.reserve(1024);
+    for (auto _ : State)
+    {
+        // Glyph-like regions of varying sizes
+        for (Uint32 i = 0; i < 1024; ++i)
+        {
+            auto R = Mgr.Allocate(8 + (i * 7) % 40, 8 + (i * 13) % 40);
+            if (!R.IsEmpty())
+                Regions.emplace_back(std::move(R));
+        }
+        for (auto& R : Regions)
+            Mgr.Free(std::move(R));
+        Regions.clear();
+    }
+    State.SetItemsProcessed(State.iterations() * 1024);
+}
+BENCHMARK(DynamicAtlasManager_AllocateFree)
+    ->ArgName("Strategy")
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::TREE))
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::SKYLINE))
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::MAX_RECTS));
+
+// Fills the atlas with glyph-like regions until allocations keep failing, then repeatedly
+// releases half of the regions and fills the atlas again.
+// Reports the minimum atlas occupancy observed after filling.
+void DynamicAtlasManager_GlyphTrace(benchmark::State& State)
+{
+    constexpr Uint32 AtlasSize      = 256;
+    constexpr Uint32 NumRounds      = 4;
+    constexpr Uint32 MaxNumFailures = 32;
+
+    const auto Strategy = static_cast<DynamicAtlasManager::PACKING_STRATEGY>(State.range(0));
+
+    double MinOccupancy = 1.0;
+    Uint64 NumAllocs    = 0;
+    for (auto _ : State)
+    {
+        DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Strategy};
+
+        FastRandInt                              rnd{1, 4, 24};
+        std::vector<DynamicAtlasManager::Region> Regions;
+        Uint64                                   AllocatedArea = 0;
+        for (Uint32 round = 0; round < NumRounds; ++round)
+        {
+            for (Uint32 NumFailures = 0; NumFailures < MaxNumFailures;)
+            {
+                auto R = Mgr.Allocate(rnd(), rnd());
+                ++NumAllocs;
+                if (R.IsEmpty())
+                {
+                    ++NumFailures;
+                    continue;
+                }
+                AllocatedArea += Uint64{R.width} * Uint64{R.height};
+                Regions.emplace_back(std::move(R));
+            }
+            MinOccupancy = std::min(MinOccupancy, static_cast<double>(AllocatedArea) / (AtlasSize * AtlasSize));
+
+            for (size_t r = round % 2; r < Regions.size(); r += 2)
+            {
+                AllocatedArea -= Uint64{Regions[r].width} * Uint64{Regions[r].height};
+                Mgr.Free(std::move(Regions[r]));
+            }
+            Regions.erase(std::remove_if(Regions.begin(), Regions.end(), [](const DynamicAtlasManager::Region& R) { return R.IsEmpty(); }), Regions.end());
+        }
+
+        for (auto& R : Regions)
+            Mgr.Free(std::move(R));
+    }
+    State.SetItemsProcessed(static_cast<int64_t>(NumAllocs));
+    State.counters["MinOccupancy"] = MinOccupancy;
+}
+BENCHMARK(DynamicAtlasManager_GlyphTrace)
+    ->ArgName("Strategy")
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::TREE))
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::SKYLINE))
+    ->Arg(static_cast<int>(DynamicAtlasManager::PACKING_STRATEGY::MAX_RECTS));
+
+} // namespace
@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "GraphicsAccessories.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void GraphicsAccessories_ComputeMipLevelsCount(benchmark::State& State)
+{
+    Uint32 Width = 1;
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(ComputeMipLevelsCount(Width, Width / 2 + 1, 4));
+        Width = (Width * 3 + 1) & 0xFFFF;
+    }
+}
+BENCHMARK(GraphicsAccessories_ComputeMipLevelsCount);
+
+void GraphicsAccessories_GetMipLevelProperties(benchmark::State& State)
+{
+    TextureDesc TexDesc;
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 4096;
+    TexDesc.Height    = 2048;
+    TexDesc.Format    = static_cast<TEXTURE_FORMAT>(State.range(0));
+    TexDesc.MipLevels = ComputeMipLevelsCount(TexDesc.Width, TexDesc.Height);
+    for (auto _ : State)
+    {
+        for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
+            benchmark::DoNotOptimize(GetMipLevelProperties(TexDesc, Mip));
+    }
+    State.SetItemsProcessed(State.iterations() * TexDesc.MipLevels);
+}
+BENCHMARK(GraphicsAccessories_GetMipLevelProperties)
+    ->Arg(TEX_FORMAT_RGBA8_UNORM)
+    ->Arg(TEX_FORMAT_BC3_UNORM);
+
+} // namespace
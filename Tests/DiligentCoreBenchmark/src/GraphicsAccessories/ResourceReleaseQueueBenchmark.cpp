@@ -0,0 +1,68 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <memory>
+
+#include "ResourceReleaseQueue.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct Resource
+{
+    Uint64 Data[4] = {};
+};
+
+// Releases a batch of resources every frame the same way the render device does:
+// resources are moved to the stale list, then to the release queue when the command
+// list is submitted, and finally destroyed when the fence is completed.
+void ResourceReleaseQueue_SafeReleasePurge(benchmark::State& State)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue{DefaultRawMemoryAllocator::GetAllocator()};
+
+    const auto NumResources = static_cast<Uint32>(State.range(0));
+
+    Uint64 FenceValue = 0;
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < NumResources; ++i)
+            Queue.SafeReleaseResource(std::unique_ptr<Resource>{new Resource}, FenceValue);
+        Queue.DiscardStaleResources(FenceValue, FenceValue + 1);
+        ++FenceValue;
+        Queue.Purge(FenceValue > 2 ? FenceValue - 2 : 0);
+    }
+    Queue.Purge(FenceValue);
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(ResourceReleaseQueue_SafeReleasePurge)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
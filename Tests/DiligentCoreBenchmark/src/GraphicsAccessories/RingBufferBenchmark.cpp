@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "RingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Simulates a dynamic buffer that is sub-allocated every frame and released
+// once the GPU is FrameDelay frames behind.
+void RingBuffer_AllocateFrames(benchmark::State& State)
+{
+    using OffsetType = RingBuffer::OffsetType;
+
+    constexpr Uint64 FrameDelay = 2;
+
+    const auto NumAllocationsPerFrame = static_cast<Uint32>(State.range(0));
+
+    RingBuffer Ring{static_cast<OffsetType>(NumAllocationsPerFrame) * 256 * (FrameDelay + 1), DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 FenceValue = 0;
+    for (auto _ : State)
+    {
+        for (Uint32 i = 0; i < NumAllocationsPerFrame; ++i)
+        {
+            auto Offset = Ring.Allocate(64 + (i % 4) * 48, 16);
+            benchmark::DoNotOptimize(Offset);
+        }
+        Ring.FinishCurrentFrame(++FenceValue);
+        if (FenceValue > FrameDelay)
+            Ring.ReleaseCompletedFrames(FenceValue - FrameDelay);
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(RingBuffer_AllocateFrames)->Arg(16)->Arg(256)->Arg(4096);
+
+} // namespace
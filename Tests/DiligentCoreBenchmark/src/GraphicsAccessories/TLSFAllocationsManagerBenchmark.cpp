@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+#include <vector>
+
+#include "TLSFAllocationsManager.hpp"
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TraceOp
+{
+    // Allocation size, or zero if this is a free operation
+    size_t Size = 0;
+
+    // Allocation alignment, or index of the allocation to release
+    size_t AlignmentOrIndex = 0;
+};
+
+// Generates a fragmentation-heavy trace: allocations of widely varying sizes
+// and alignments are released in random order while new ones keep coming.
+std::vector<TraceOp> GenerateFragmentationTrace(size_t NumAllocations)
+{
+    Uint32 Seed   = 19;
+    auto   Random = [&Seed]() {
+        Seed = Seed * 1664525u + 1013904223u;
+        return Seed >> 8;
+    };
+
+    std::vector<TraceOp> Trace;
+    Trace.reserve(NumAllocations * 2);
+
+    std::vector<size_t> LiveAllocs;
+    for (size_t i = 0; i < NumAllocations;)
+    {
+        if (!LiveAllocs.empty() && Random() % 100 < 45)
+        {
+            const auto Idx = Random() % LiveAllocs.size();
+            Trace.push_back({0, LiveAllocs[Idx]});
+            LiveAllocs[Idx] = LiveAllocs.back();
+            LiveAllocs.pop_back();
+        }
+        else
+        {
+            // Mostly small allocations with a tail of large ones
+            const auto   R    = Random() % 100;
+            const size_t Size = R < 70 ? 1 + Random() % 256 : (R < 95 ? 256 + Random() % 4096 : 4096 + Random() % 65536);
+            const size_t Alignment = size_t{1} << (Random() % 9);
+
+            LiveAllocs.push_back(Trace.size());
+            Trace.push_back({Size, Alignment});
+            ++i;
+        }
+    }
+
+    for (auto Idx : LiveAllocs)
+        Trace.push_back({0, Idx});
+
+    return Trace;
+}
+
+// Replays the fragmentation trace with VariableSizeAllocationsManager or TLSFAllocationsManager
+template <typename AllocationsManagerType>
+void AllocationsManager_FragmentationTrace(benchmark::State& State)
+{
+    constexpr size_t MaxSize = size_t{64} << 20;
+
+    const auto Trace = GenerateFragmentationTrace(static_cast<size_t>(State.range(0)));
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocs(Trace.size());
+    for (auto _ : State)
+    {
+        AllocationsManagerType Mgr{MaxSize, DefaultRawMemoryAllocator::GetAllocator()};
+        for (size_t i = 0; i < Trace.size(); ++i)
+        {
+            const auto& Op = Trace[i];
+            if (Op.Size != 0)
+            {
+                Allocs[i] = Mgr.Allocate(Op.Size, Op.AlignmentOrIndex);
+            }
+            else
+            {
+                auto& Alloc = Allocs[Op.AlignmentOrIndex];
+                if (Alloc.IsValid())
+                    Mgr.Free(std::move(Alloc));
+            }
+        }
+        benchmark::DoNotOptimize(Mgr.GetFreeSize());
+    }
+    State.SetItemsProcessed(State.iterations() * static_cast<int64_t>(Trace.size()));
+}
+BENCHMARK_TEMPLATE(AllocationsManager_FragmentationTrace, VariableSizeAllocationsManager)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(AllocationsManager_FragmentationTrace, TLSFAllocationsManager)->Arg(10000)->Arg(100000);
+
+} // namespace
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+void VariableSizeAllocationsManager_AllocateFree(benchmark::State& State)
+{
+    const auto NumAllocations = static_cast<size_t>(State.range(0));
+
+    VariableSizeAllocationsManager Mgr{static_cast<OffsetType>(NumAllocations * 1024), DefaultRawMemoryAllocator::GetAllocator()};
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocations(NumAllocations);
+    for (auto _ : State)
+    {
+        for (size_t i = 0; i < NumAllocations; ++i)
+        {
+            // Varying sizes to exercise free block splitting and merging
+            Allocations[i] = Mgr.Allocate(static_cast<OffsetType>(64 + (i % 13) * 32), 16);
+        }
+        // Release every other block first to fragment the free list
+        for (size_t i = 0; i < NumAllocations; i += 2)
+            Mgr.Free(std::move(Allocations[i]));
+        for (size_t i = 1; i < NumAllocations; i += 2)
+            Mgr.Free(std::move(Allocations[i]));
+    }
+    State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK(VariableSizeAllocationsManager_AllocateFree)->Arg(64)->Arg(1024)->Arg(8192);
+
+} // namespace
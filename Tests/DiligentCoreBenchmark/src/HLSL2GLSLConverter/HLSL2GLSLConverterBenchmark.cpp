@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+
+#include "HLSL2GLSLConverterImpl.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Self-contained shader source so that the benchmark does not need a shader source stream factory
+const char* const HLSLSource = R"(
+cbuffer Constants
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Color;
+};
+
+Texture2D    g_Texture;
+SamplerState g_Texture_sampler;
+
+struct VSInput
+{
+    float3 Pos : ATTRIB0;
+    float2 UV  : ATTRIB1;
+};
+
+struct PSInput
+{
+    float4 Pos : SV_POSITION;
+    float2 UV  : TEX_COORD;
+};
+
+void VSMain(in VSInput VSIn, out PSInput PSIn)
+{
+    PSIn.Pos = mul(float4(VSIn.Pos, 1.0), g_WorldViewProj);
+    PSIn.UV  = VSIn.UV;
+}
+
+float4 PSMain(in PSInput PSIn) : SV_Target
+{
+    float4 Color = g_Texture.Sample(g_Texture_sampler, PSIn.UV);
+    for (int i = 0; i < 4; ++i)
+        Color.rgb = Color.rgb * g_Color.rgb + float3(0.1, 0.1, 0.1);
+    return Color;
+}
+)";
+
+// When Uncached is non-zero, every iteration appends a unique comment to the source
+// so that the conversion result is not taken from the converter cache.
+void HLSL2GLSLConverter_Convert(benchmark::State& State)
+{
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    const bool  IsVS       = State.range(0) == 0;
+    const bool  IsUncached = State.range(2) != 0;
+    std::string HLSLString = HLSLSource;
+
+    size_t TotalSize = 0;
+    size_t Iteration = 0;
+    for (auto _ : State)
+    {
+        if (IsUncached)
+            HLSLString = std::string{HLSLSource} + "\n// " + std::to_string(Iteration++) + "\n";
+
+        HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+        Attribs.HLSLSource         = HLSLString.c_str();
+        Attribs.NumSymbols         = HLSLString.length();
+        Attribs.EntryPoint         = IsVS ? "VSMain" : "PSMain";
+        Attribs.ShaderType         = IsVS ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+        Attribs.IncludeDefinitions = State.range(1) != 0;
+
+        const auto GLSLSource = Converter.Convert(Attribs);
+        TotalSize += GLSLSource.length();
+        benchmark::DoNotOptimize(GLSLSource.data());
+    }
+    State.SetBytesProcessed(State.iterations() * static_cast<int64_t>(HLSLString.length()));
+    State.counters["GLSLSize"] = benchmark::Counter(static_cast<double>(TotalSize), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(HLSL2GLSLConverter_Convert)
+    ->ArgNames({"PS", "IncludeDefinitions", "Uncached"})
+    ->Args({0, 0, 0})
+    ->Args({1, 0, 0})
+    ->Args({1, 1, 0})
+    ->Args({0, 0, 1})
+    ->Args({1, 0, 1});
+
+} // namespace
@@ -26,11 +26,18 @@
  */
 
 #include <array>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "ArenaAllocator.hpp"
+#include "LargePageMemoryAllocator.hpp"
+#include "PlatformMisc.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +131,72 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, MagazineOverflow)
+{
+    constexpr Uint32 AllocSize = 16;
+    constexpr Uint32 NumAllocs = FixedBlockMemoryAllocator::MagazineSize * 4 + 3;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, 8);
+
+    std::vector<void*> Allocations(NumAllocs);
+    for (int iter = 0; iter < 2; ++iter)
+    {
+        for (auto& pAlloc : Allocations)
+        {
+            pAlloc = TestAllocator.Allocate(AllocSize, "Magazine overflow test", __FILE__, __LINE__);
+            ASSERT_NE(pAlloc, nullptr);
+            memset(pAlloc, iter, AllocSize);
+        }
+
+        auto SortedAllocations = Allocations;
+        std::sort(SortedAllocations.begin(), SortedAllocations.end());
+        EXPECT_TRUE(std::adjacent_find(SortedAllocations.begin(), SortedAllocations.end()) == SortedAllocations.end());
+
+        for (auto* pAlloc : Allocations)
+            TestAllocator.Free(pAlloc);
+    }
+}
+
+TEST(Common_FixedBlockMemoryAllocator, Statistics)
+{
+    constexpr Uint32 AllocSize       = 24;
+    constexpr Uint32 NumBlocksInPage = 8;
+    constexpr Uint32 NumAllocs       = NumBlocksInPage * 5 + 1;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumBlocksInPage);
+    EXPECT_EQ(TestAllocator.GetBlockSize(), size_t{AllocSize});
+
+    Uint32 NumAllocated = ~0u;
+    Uint32 NumReserved  = 0;
+    TestAllocator.GetStatistics(NumAllocated, NumReserved);
+    EXPECT_EQ(NumAllocated, 0u);
+    EXPECT_EQ(NumReserved, NumBlocksInPage);
+
+    std::vector<void*> Allocations(NumAllocs);
+    for (auto& pAlloc : Allocations)
+        pAlloc = TestAllocator.Allocate(AllocSize, "Statistics test", __FILE__, __LINE__);
+
+    TestAllocator.GetStatistics(NumAllocated, NumReserved);
+    EXPECT_EQ(NumAllocated, NumAllocs);
+    EXPECT_GE(NumReserved, NumAllocs);
+    EXPECT_EQ(NumReserved % NumBlocksInPage, 0u);
+
+    for (Uint32 i = 0; i < NumAllocs / 2; ++i)
+        TestAllocator.Free(Allocations[i]);
+
+    // Released blocks that stay in the magazines are counted as free
+    const auto NumReservedBeforeFree = NumReserved;
+    TestAllocator.GetStatistics(NumAllocated, NumReserved);
+    EXPECT_EQ(NumAllocated, NumAllocs - NumAllocs / 2);
+    EXPECT_EQ(NumReserved, NumReservedBeforeFree);
+
+    for (Uint32 i = NumAllocs / 2; i < NumAllocs; ++i)
+        TestAllocator.Free(Allocations[i]);
+
+    TestAllocator.GetStatistics(NumAllocated, NumReserved);
+    EXPECT_EQ(NumAllocated, 0u);
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -229,4 +302,239 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_ArenaAllocator, ResetAndGrow)
+{
+    ArenaAllocator Arena{DefaultRawMemoryAllocator::GetAllocator(), 256};
+    EXPECT_EQ(Arena.GetCapacity(), size_t{256});
+
+    EXPECT_EQ(Arena.Allocate(0, 16), nullptr);
+
+    auto* Ptr0 = Arena.Allocate(100, 16);
+    EXPECT_EQ(Ptr0, AlignUp(Ptr0, 16));
+    auto* Ptr1 = Arena.Allocate<Uint64>(8);
+    EXPECT_EQ(Ptr1, AlignUp(Ptr1, alignof(Uint64)));
+    EXPECT_LE(Arena.GetUsedSize(), size_t{256});
+
+    // Does not fit into the main block
+    auto* Ptr2 = Arena.Allocate(500, 64);
+    ASSERT_NE(Ptr2, nullptr);
+    EXPECT_EQ(Ptr2, AlignUp(Ptr2, 64));
+    memset(Ptr2, 0xCD, 500);
+
+    Arena.Reset();
+    EXPECT_EQ(Arena.GetUsedSize(), size_t{0});
+    EXPECT_GE(Arena.GetCapacity(), size_t{256 + 500});
+
+    // The same allocations now fit into the main block
+    auto* Ptr3 = Arena.Allocate(100, 16);
+    auto* Ptr4 = Arena.Allocate(500, 64);
+    EXPECT_EQ(Ptr4, AlignUp(Ptr4, 64));
+    EXPECT_GT(Ptr4, Ptr3);
+    EXPECT_LE(Arena.GetUsedSize(), Arena.GetCapacity());
+
+    IMemoryAllocator& Allocator = Arena;
+    auto*             Ptr5      = Allocator.Allocate(24, "Arena allocator test", __FILE__, __LINE__);
+    EXPECT_EQ(Ptr5, AlignUp(Ptr5, ArenaAllocator::DefaultAlignment));
+    Allocator.Free(Ptr5);
+}
+
+TEST(Common_DefaultRawMemoryAllocator, Tracking)
+{
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    RawAllocator.TakeRecordedCallSites();
+    RawAllocator.SetCallSiteRecordThreshold(2);
+    RawAllocator.EnableTracking(true);
+    RawAllocator.ResetTrackingPeriod();
+
+    void* Ptrs[3] = {};
+    for (auto*& Ptr : Ptrs)
+        Ptr = RawAllocator.Allocate(64, "Tracking test", __FILE__, __LINE__);
+    RawAllocator.Free(Ptrs[0]);
+
+    auto Stats = RawAllocator.ResetTrackingPeriod();
+    EXPECT_EQ(Stats.NumAllocations, Uint64{3});
+    EXPECT_EQ(Stats.NumFrees, Uint64{1});
+    EXPECT_EQ(Stats.BytesAllocated, Uint64{3 * 64});
+
+    // Only the allocation above the threshold is recorded
+    auto CallSites = RawAllocator.TakeRecordedCallSites();
+    ASSERT_EQ(CallSites.size(), size_t{1});
+    EXPECT_EQ(CallSites[0].Size, size_t{64});
+    EXPECT_EQ(CallSites[0].Description, "Tracking test");
+
+    RawAllocator.EnableTracking(false);
+    RawAllocator.SetCallSiteRecordThreshold(0);
+    RawAllocator.Free(Ptrs[1]);
+    RawAllocator.Free(Ptrs[2]);
+
+    Stats = RawAllocator.ResetTrackingPeriod();
+    EXPECT_EQ(Stats.NumAllocations, Uint64{0});
+    EXPECT_EQ(Stats.NumFrees, Uint64{0});
+    EXPECT_TRUE(RawAllocator.TakeRecordedCallSites().empty());
+}
+
+TEST(Common_LargePageMemoryAllocator, AllocFree)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.ArenaSize    = 4096;
+    CI.MaxBlockSize = 1024;
+    // The test must not depend on the availability of large pages
+    CI.UseLargePages = false;
+
+    LargePageMemoryAllocator Allocator{CI};
+    EXPECT_FALSE(Allocator.IsUsingLargePages());
+
+    std::vector<void*> Ptrs;
+    for (size_t Size : {1, 16, 17, 100, 1008, 1009, 5000})
+    {
+        auto* Ptr = Allocator.Allocate(Size, "Large page allocator test", __FILE__, __LINE__);
+        ASSERT_NE(Ptr, nullptr);
+        EXPECT_EQ(Ptr, AlignUp(Ptr, 16));
+        memset(Ptr, 0xAB, Size);
+        Ptrs.push_back(Ptr);
+    }
+
+    Uint32 NumArenas = 0;
+    size_t ArenaSize = 0;
+    Allocator.GetArenaStatistics(NumArenas, ArenaSize);
+    EXPECT_EQ(NumArenas, 1u);
+    EXPECT_EQ(ArenaSize, size_t{4096});
+
+    // Freed blocks are reused by the allocations of the same size class
+    Allocator.Free(Ptrs[2]);
+    EXPECT_EQ(Allocator.Allocate(20, "Large page allocator test", __FILE__, __LINE__), Ptrs[2]);
+
+    for (auto* Ptr : Ptrs)
+        Allocator.Free(Ptr);
+    Allocator.Free(nullptr);
+}
+
+TEST(Common_LargePageMemoryAllocator, ArenaTail)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.ArenaSize     = 4096;
+    CI.MaxBlockSize  = 4096;
+    CI.UseLargePages = false;
+
+    LargePageMemoryAllocator Allocator{CI};
+
+    // The second allocation takes a whole new arena, and the rest of the first one goes to the free lists
+    auto* Ptr0 = Allocator.Allocate(16, "Large page allocator test", __FILE__, __LINE__);
+    auto* Ptr1 = Allocator.Allocate(4000, "Large page allocator test", __FILE__, __LINE__);
+
+    Uint32 NumArenas = 0;
+    size_t ArenaSize = 0;
+    Allocator.GetArenaStatistics(NumArenas, ArenaSize);
+    EXPECT_EQ(NumArenas, 2u);
+
+    // The 4064-byte tail of the first arena is split into 3584, 448 and 32-byte blocks,
+    // which are used before a new arena is created
+    std::vector<void*> Ptrs;
+    for (size_t Size : {3500, 400, 16})
+        Ptrs.push_back(Allocator.Allocate(Size, "Large page allocator test", __FILE__, __LINE__));
+    Allocator.GetArenaStatistics(NumArenas, ArenaSize);
+    EXPECT_EQ(NumArenas, 2u);
+
+    for (auto* Ptr : Ptrs)
+        Allocator.Free(Ptr);
+    Allocator.Free(Ptr0);
+    Allocator.Free(Ptr1);
+}
+
+TEST(Common_LargePageMemoryAllocator, SizeClasses)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.ArenaSize     = 1 << 16;
+    CI.UseLargePages = false;
+
+    LargePageMemoryAllocator Allocator{CI};
+
+    // The block size, including the 16-byte header, is rounded up to one of four classes per power of two
+    for (size_t Size : {16, 48, 64, 100, 128, 200, 1000})
+    {
+        auto* Ptr0 = static_cast<Uint8*>(Allocator.Allocate(Size, "Large page allocator test", __FILE__, __LINE__));
+        auto* Ptr1 = static_cast<Uint8*>(Allocator.Allocate(Size, "Large page allocator test", __FILE__, __LINE__));
+
+        const auto BlockSize = static_cast<size_t>(Ptr1 - Ptr0);
+        EXPECT_GE(BlockSize, Size + 16);
+        EXPECT_LE(BlockSize, std::max((Size + 16) * 5 / 4, size_t{32}) + 15) << Size;
+        EXPECT_EQ(BlockSize % 16, 0u);
+
+        Allocator.Free(Ptr0);
+        Allocator.Free(Ptr1);
+    }
+}
+
+TEST(Common_LargePageMemoryAllocator, LargePages)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.ArenaSize = 1 << 20;
+
+    LargePageMemoryAllocator Allocator{CI};
+
+    auto* Ptr = Allocator.Allocate(256, "Large page allocator test", __FILE__, __LINE__);
+    ASSERT_NE(Ptr, nullptr);
+    memset(Ptr, 0xCD, 256);
+
+    Uint32 NumArenas = 0;
+    size_t ArenaSize = 0;
+    Allocator.GetArenaStatistics(NumArenas, ArenaSize);
+    EXPECT_EQ(NumArenas, 1u);
+    // The arena size is rounded up to the large page size
+    EXPECT_GE(ArenaSize, size_t{1} << 20);
+    if (Allocator.IsUsingLargePages())
+    {
+        EXPECT_EQ(ArenaSize % PlatformMisc::GetLargePageSize(), size_t{0});
+    }
+
+    Allocator.Free(Ptr);
+}
+
+TEST(Common_LargePageMemoryAllocator, InvalidCreateInfo)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.MaxBlockSize = 1000;
+    EXPECT_THROW(LargePageMemoryAllocator{CI}, std::runtime_error);
+
+    CI.ArenaSize    = 4096;
+    CI.MaxBlockSize = 8192;
+    EXPECT_THROW(LargePageMemoryAllocator{CI}, std::runtime_error);
+}
+
+TEST(Common_LargePageMemoryAllocator, Multithreaded)
+{
+    LargePageMemoryAllocatorCreateInfo CI;
+    CI.ArenaSize = 1 << 20;
+
+    LargePageMemoryAllocator Allocator{CI};
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Allocator, t]() {
+                std::vector<Uint8*> Ptrs(256);
+                for (int Iter = 0; Iter < 16; ++Iter)
+                {
+                    for (size_t i = 0; i < Ptrs.size(); ++i)
+                    {
+                        const auto Size = 8 + (i * 37) % 2000;
+                        Ptrs[i]         = static_cast<Uint8*>(Allocator.Allocate(Size, "Large page allocator test", __FILE__, __LINE__));
+                        memset(Ptrs[i], static_cast<int>(t), Size);
+                    }
+                    for (size_t i = 0; i < Ptrs.size(); ++i)
+                    {
+                        EXPECT_EQ(Ptrs[i][0], static_cast<Uint8>(t));
+                        Allocator.Free(Ptrs[i]);
+                    }
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
 } // namespace
@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AsyncFileReader.hpp"
+#include "FileWrapper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void WriteTestFile(const char* Path, const std::string& Content)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Content.data(), Content.size()));
+}
+
+TEST(Common_AsyncFileReader, ReadFile)
+{
+    constexpr size_t NumFiles = 8;
+
+    std::vector<std::string> FileNames;
+    for (size_t i = 0; i < NumFiles; ++i)
+    {
+        FileNames.emplace_back("AsyncFileReaderTest" + std::to_string(i) + ".tmp");
+        WriteTestFile(FileNames.back().c_str(), "File " + std::to_string(i));
+    }
+
+    {
+        AsyncFileReader Reader;
+
+        std::vector<std::future<RefCntAutoPtr<IDataBlob>>> Futures;
+        for (const auto& FileName : FileNames)
+            Futures.emplace_back(Reader.ReadFile(FileName));
+
+        for (size_t i = 0; i < NumFiles; ++i)
+        {
+            auto pData = Futures[i].get();
+            ASSERT_NE(pData, nullptr);
+            const auto Expected = "File " + std::to_string(i);
+            ASSERT_EQ(pData->GetSize(), Expected.size());
+            EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Expected.data(), Expected.size()), 0);
+        }
+
+        // The first existing file from the list is read
+        std::atomic<bool> CallbackCalled{false};
+        Reader.ReadFile(std::vector<std::string>{"NonExistentAsyncFile.tmp", FileNames[3]},
+                        [&](IDataBlob* pData) {
+                            EXPECT_NE(pData, nullptr);
+                            if (pData != nullptr)
+                                EXPECT_EQ(memcmp(pData->GetConstDataPtr(), "File 3", 6), 0);
+                            CallbackCalled.store(true);
+                        });
+
+        auto pMissingData = Reader.ReadFile("NonExistentAsyncFile.tmp").get();
+        EXPECT_EQ(pMissingData, nullptr);
+
+        Reader.WaitForAllReads();
+        EXPECT_TRUE(CallbackCalled.load());
+    }
+
+    for (const auto& FileName : FileNames)
+        FileSystem::DeleteFile(FileName.c_str());
+}
+
+TEST(Common_AsyncFileReader, SharedThreadPool)
+{
+    const char* FileName = "AsyncFileReaderSharedPoolTest.tmp";
+    WriteTestFile(FileName, "Shared pool");
+
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    {
+        ThreadPoolCreateInfo PoolCI;
+        PoolCI.NumThreads = 2;
+        CreateThreadPool(PoolCI, &pThreadPool);
+    }
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Occupy one of the threads with a task that does not belong to the reader
+    std::atomic<bool> ReleaseTask{false};
+    EnqueueTask(pThreadPool,
+                [&ReleaseTask]() {
+                    while (!ReleaseTask.load())
+                        std::this_thread::yield();
+                });
+
+    {
+        AsyncFileReader Reader{pThreadPool};
+
+        std::atomic<bool> CallbackCalled{false};
+        Reader.ReadFile(FileName,
+                        [&](IDataBlob* pData) {
+                            EXPECT_NE(pData, nullptr);
+                            CallbackCalled.store(true);
+                        });
+
+        // Only the reads of the reader are waited for
+        Reader.WaitForAllReads();
+        EXPECT_TRUE(CallbackCalled.load());
+        EXPECT_FALSE(ReleaseTask.load());
+    }
+
+    ReleaseTask.store(true);
+    pThreadPool->WaitForAllTasks();
+
+    FileSystem::DeleteFile(FileName);
+}
+
+} // namespace
@@ -27,6 +27,9 @@
 
 #include "FilteringTools.hpp"
 
+#include <random>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -292,4 +295,115 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void TestGetLinearTexFilterSampleInfo4(Uint32 Width, float MinCoord, float MaxCoord)
+{
+    std::mt19937                          Gen{17};
+    std::uniform_real_distribution<float> Dist{MinCoord, MaxCoord};
+
+    for (size_t i = 0; i < 256; ++i)
+    {
+        float u[4];
+        for (auto& c : u)
+        {
+            c = Dist(Gen);
+            // Include texel centers and boundaries
+            if (i % 4 == 0)
+                c = FastFloor(c) + 0.5f * static_cast<float>(i % 8 == 0);
+            if (IsNormalizedCoord)
+                c /= static_cast<float>(Width);
+        }
+
+        Int32 i0[4], i1[4];
+        float w[4];
+        GetLinearTexFilterSampleInfo4<AddressMode, IsNormalizedCoord>(Width, u, i0, i1, w);
+        for (size_t k = 0; k < 4; ++k)
+        {
+            const auto RefSampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, u[k]);
+            EXPECT_EQ(i0[k], RefSampleInfo.i0) << "u=" << u[k] << " width=" << Width;
+            EXPECT_EQ(i1[k], RefSampleInfo.i1) << "u=" << u[k] << " width=" << Width;
+            EXPECT_FLOAT_EQ(w[k], RefSampleInfo.w) << "u=" << u[k] << " width=" << Width;
+        }
+    }
+}
+
+TEST(Common_FilteringTools, GetLinearTexFilterSampleInfo4)
+{
+    for (Uint32 Width : {1u, 4u, 7u, 128u})
+    {
+        const auto fWidth = static_cast<float>(Width);
+
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_UNKNOWN, false>(Width, 0.5f, fWidth - 0.5f);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_UNKNOWN, true>(Width, 0.5f, fWidth - 0.5f);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_CLAMP, false>(Width, -fWidth * 3, fWidth * 3);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_CLAMP, true>(Width, -fWidth * 3, fWidth * 3);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_WRAP, false>(Width, -fWidth * 3, fWidth * 3);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_WRAP, true>(Width, -fWidth * 3, fWidth * 3);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_MIRROR, false>(Width, -fWidth * 3, fWidth * 3);
+        TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_MIRROR, true>(Width, -fWidth * 3, fWidth * 3);
+    }
+    TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_WRAP, false>(1000, -4e6f, 4e6f);
+    TestGetLinearTexFilterSampleInfo4<TEXTURE_ADDRESS_MIRROR, false>(1000, -4e6f, 4e6f);
+}
+
+template <typename SrcType, typename DstType, TEXTURE_ADDRESS_MODE AddressModeU, TEXTURE_ADDRESS_MODE AddressModeV>
+void TestFilterTexture2DBilinearBatch(float MinU, float MaxU, float MinV, float MaxV)
+{
+    constexpr Uint32 Width  = 7;
+    constexpr Uint32 Height = 5;
+    constexpr size_t Stride = 9;
+
+    std::mt19937 Gen{29};
+
+    std::vector<SrcType>               Data(Stride * Height);
+    std::uniform_int_distribution<int> DataDist{0, 255};
+    for (auto& Val : Data)
+        Val = static_cast<SrcType>(DataDist(Gen));
+
+    // Not a multiple of four to test the remainder
+    constexpr size_t   NumSamples = 103;
+    std::vector<float> U(NumSamples), V(NumSamples);
+
+    std::uniform_real_distribution<float> UDist{MinU, MaxU};
+    std::uniform_real_distribution<float> VDist{MinV, MaxV};
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        U[i] = UDist(Gen);
+        V[i] = VDist(Gen);
+    }
+
+    std::vector<DstType> Dst(NumSamples);
+    FilterTexture2DBilinearBatch<SrcType, DstType, AddressModeU, AddressModeV, false>(Width, Height, Data.data(), Stride, U.data(), V.data(), NumSamples, Dst.data());
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        auto Ref = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, false>(Width, Height, Data.data(), Stride, U[i], V[i]);
+        EXPECT_FLOAT_EQ(static_cast<float>(Dst[i]), static_cast<float>(Ref)) << "u=" << U[i] << " v=" << V[i];
+    }
+
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        U[i] /= static_cast<float>(Width);
+        V[i] /= static_cast<float>(Height);
+    }
+    FilterTexture2DBilinearBatch<SrcType, DstType, AddressModeU, AddressModeV, true>(Width, Height, Data.data(), Stride, U.data(), V.data(), NumSamples, Dst.data());
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        auto Ref = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, true>(Width, Height, Data.data(), Stride, U[i], V[i]);
+        EXPECT_FLOAT_EQ(static_cast<float>(Dst[i]), static_cast<float>(Ref)) << "u_norm=" << U[i] << " v_norm=" << V[i];
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearBatch)
+{
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_UNKNOWN, TEXTURE_ADDRESS_UNKNOWN>(0.5f, 6.5f, 0.5f, 4.5f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(-20.f, 20.f, -20.f, 20.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP>(-20.f, 20.f, -20.f, 20.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_MIRROR>(-20.f, 20.f, -20.f, 20.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_CLAMP>(-20.f, 20.f, -20.f, 20.f);
+    TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_MIRROR>(-20.f, 20.f, -20.f, 20.f);
+
+    TestFilterTexture2DBilinearBatch<Uint8, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_MIRROR>(-20.f, 20.f, -20.f, 20.f);
+    TestFilterTexture2DBilinearBatch<float, double, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_WRAP>(-20.f, 20.f, -20.f, 20.f);
+}
+
 } // namespace
@@ -0,0 +1,210 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+#include "HashUtils.hpp"
+#include "STDAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_FlatHashMap, Basic)
+{
+    FlatHashMap<int, std::string> Map;
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.find(1), Map.end());
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.erase(1), size_t{0});
+
+    auto it_ins = Map.emplace(1, "One");
+    EXPECT_TRUE(it_ins.second);
+    EXPECT_EQ(it_ins.first->first, 1);
+    EXPECT_EQ(it_ins.first->second, "One");
+
+    it_ins = Map.emplace(1, "Uno");
+    EXPECT_FALSE(it_ins.second);
+    EXPECT_EQ(it_ins.first->second, "One");
+
+    EXPECT_TRUE(Map.insert(std::make_pair(2, std::string{"Two"})).second);
+    Map[3] = "Three";
+    EXPECT_EQ(Map.size(), size_t{3});
+    EXPECT_EQ(Map[2], "Two");
+    EXPECT_EQ(Map.count(3), size_t{1});
+    EXPECT_EQ(Map.count(4), size_t{0});
+
+    EXPECT_EQ(Map.erase(2), size_t{1});
+    EXPECT_EQ(Map.erase(2), size_t{0});
+    EXPECT_EQ(Map.find(2), Map.end());
+    EXPECT_EQ(Map.size(), size_t{2});
+
+    const auto& ConstMap = Map;
+    auto        it       = ConstMap.find(3);
+    ASSERT_NE(it, ConstMap.end());
+    EXPECT_EQ(it->second, "Three");
+
+    Map.clear();
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map.begin(), Map.end());
+    EXPECT_EQ(Map.find(1), Map.end());
+}
+
+TEST(Common_FlatHashMap, EraseWhileIterating)
+{
+    FlatHashMap<int, int> Map;
+    for (int i = 0; i < 1000; ++i)
+        Map.emplace(i, i * 2);
+
+    for (auto it = Map.begin(); it != Map.end();)
+    {
+        if (it->first % 3 == 0)
+            it = Map.erase(it);
+        else
+            ++it;
+    }
+
+    EXPECT_EQ(Map.size(), size_t{666});
+    size_t Count = 0;
+    for (const auto& it : Map)
+    {
+        EXPECT_NE(it.first % 3, 0);
+        EXPECT_EQ(it.second, it.first * 2);
+        ++Count;
+    }
+    EXPECT_EQ(Count, Map.size());
+}
+
+TEST(Common_FlatHashMap, MoveOnlyTypes)
+{
+    FlatHashMap<HashMapStringKey, std::unique_ptr<int>, HashMapStringKey::Hasher> Map;
+    for (int i = 0; i < 100; ++i)
+        Map.emplace(HashMapStringKey{std::to_string(i)}, std::unique_ptr<int>{new int{i}});
+
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto Str = std::to_string(i);
+
+        auto it = Map.find(Str.c_str());
+        ASSERT_NE(it, Map.end());
+        EXPECT_EQ(*it->second, i);
+    }
+
+    FlatHashMap<HashMapStringKey, std::unique_ptr<int>, HashMapStringKey::Hasher> Map2{std::move(Map)};
+    EXPECT_TRUE(Map.empty());
+    EXPECT_EQ(Map2.size(), size_t{100});
+}
+
+TEST(Common_FlatHashMap, Allocator)
+{
+    using AllocatorType = STDAllocatorRawMem<std::pair<const Uint32, Uint32>>;
+    FlatHashMap<Uint32, Uint32, std::hash<Uint32>, std::equal_to<Uint32>, AllocatorType> Map{
+        STD_ALLOCATOR_RAW_MEM(AllocatorType::value_type, DefaultRawMemoryAllocator::GetAllocator(), "Allocator for FlatHashMap")};
+
+    for (Uint32 i = 0; i < 1000; ++i)
+        Map.emplace(i, i);
+    for (Uint32 i = 0; i < 1000; ++i)
+        EXPECT_EQ(Map[i], i);
+}
+
+TEST(Common_FlatHashMap, Reserve)
+{
+    FlatHashMap<int, int> Map{100};
+    const auto            Capacity = Map.capacity();
+    EXPECT_GE(Capacity, size_t{100});
+    for (int i = 0; i < 100; ++i)
+        Map.emplace(i, i);
+    EXPECT_EQ(Map.capacity(), Capacity);
+
+    // Insert-erase cycles must reuse deleted slots instead of growing the table indefinitely
+    for (int i = 100; i < 100000; ++i)
+    {
+        Map.emplace(i, i);
+        Map.erase(i - 100);
+    }
+    EXPECT_EQ(Map.size(), size_t{100});
+    EXPECT_LE(Map.capacity(), Capacity * 2);
+    for (int i = 100000 - 100; i < 100000; ++i)
+        EXPECT_EQ(Map[i], i);
+}
+
+TEST(Common_FlatHashMap, RandomOperations)
+{
+    std::mt19937                       Gen{42};
+    std::uniform_int_distribution<int> KeyDist{0, 2000};
+    std::uniform_int_distribution<int> OpDist{0, 3};
+
+    FlatHashMap<int, int>        Map;
+    std::unordered_map<int, int> RefMap;
+    for (int i = 0; i < 200000; ++i)
+    {
+        const auto Key = KeyDist(Gen);
+        switch (OpDist(Gen))
+        {
+            case 0:
+            case 1:
+                EXPECT_EQ(Map.emplace(Key, i).second, RefMap.emplace(Key, i).second);
+                break;
+
+            case 2:
+                EXPECT_EQ(Map.erase(Key), RefMap.erase(Key));
+                break;
+
+            case 3:
+            {
+                auto it    = Map.find(Key);
+                auto RefIt = RefMap.find(Key);
+                ASSERT_EQ(it == Map.end(), RefIt == RefMap.end());
+                if (RefIt != RefMap.end())
+                {
+                    EXPECT_EQ(it->second, RefIt->second);
+                }
+                break;
+            }
+        }
+    }
+
+    ASSERT_EQ(Map.size(), RefMap.size());
+    for (const auto& it : Map)
+    {
+        auto RefIt = RefMap.find(it.first);
+        ASSERT_NE(RefIt, RefMap.end());
+        EXPECT_EQ(it.second, RefIt->second);
+    }
+}
+
+} // namespace
@@ -26,6 +26,9 @@
  */
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <string>
 
 #include "HashUtils.hpp"
 
@@ -116,4 +119,66 @@ TEST(Common_HashUtils, HashMapStringKey)
     }
 }
 
+TEST(Common_HashUtils, ComputeHashRaw)
+{
+    const Uint8 Data1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    const Uint8 Data2[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 12};
+
+    EXPECT_EQ(ComputeHashRaw(Data1, sizeof(Data1)), ComputeHashRaw(Data1, sizeof(Data1)));
+    EXPECT_NE(ComputeHashRaw(Data1, sizeof(Data1)), ComputeHashRaw(Data2, sizeof(Data2)));
+    EXPECT_NE(ComputeHashRaw(Data1, sizeof(Data1)), ComputeHashRaw(Data1, sizeof(Data1) - 1));
+    EXPECT_EQ(ComputeHashRaw(Data1, 0), ComputeHashRaw(Data2, 0));
+    EXPECT_NE(ComputeHashRaw(Data1, sizeof(Data1)), ComputeHashRaw(Data1, sizeof(Data1), 1));
+
+    // Hash all prefixes of a buffer that cover every code path (0-3, 4-16, 17-48 and over 48 bytes)
+    std::vector<Uint8> Data(256);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 7 + 3);
+
+    std::unordered_set<size_t> Hashes;
+    for (size_t Size = 0; Size <= Data.size(); ++Size)
+        EXPECT_TRUE(Hashes.insert(ComputeHashRaw(Data.data(), Size)).second) << "Collision for size " << Size;
+
+    // Flipping any single bit must change the hash
+    const auto RefHash = ComputeHashRaw(Data.data(), Data.size());
+    for (size_t Bit = 0; Bit < Data.size() * 8; ++Bit)
+    {
+        Data[Bit / 8] ^= static_cast<Uint8>(1u << (Bit % 8));
+        EXPECT_NE(ComputeHashRaw(Data.data(), Data.size()), RefHash) << "Bit " << Bit;
+        Data[Bit / 8] ^= static_cast<Uint8>(1u << (Bit % 8));
+    }
+}
+
+TEST(Common_HashUtils, CStringHash)
+{
+    const std::string Str = "Test String";
+
+    EXPECT_EQ(CStringHash<Char>{}(Str.c_str()), CStringHash<Char>{}("Test String"));
+    EXPECT_EQ(CStringHash<Char>{}(Str.c_str()), ComputeHashRaw(Str.c_str(), Str.length()));
+    EXPECT_NE(CStringHash<Char>{}("Test String"), CStringHash<Char>{}("Test Strinh"));
+    EXPECT_NE(CStringHash<Char>{}(""), CStringHash<Char>{}("a"));
+
+    std::unordered_set<size_t> Hashes;
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_TRUE(Hashes.insert(CStringHash<Char>{}(("g_Texture" + std::to_string(i)).c_str())).second);
+}
+
+TEST(Common_HashUtils, ComputeHash)
+{
+    EXPECT_EQ(ComputeHash(1, 2, 3), ComputeHash(1, 2, 3));
+    EXPECT_NE(ComputeHash(1, 2, 3), ComputeHash(3, 2, 1));
+    EXPECT_NE(ComputeHash(0), ComputeHash(0, 0));
+
+    // Small sequential integers are the worst case for the identity std::hash
+    std::unordered_set<size_t> Hashes;
+    for (Uint32 x = 0; x < 64; ++x)
+    {
+        for (Uint32 y = 0; y < 64; ++y)
+        {
+            for (Uint32 z = 0; z < 16; ++z)
+                EXPECT_TRUE(Hashes.insert(ComputeHash(x, y, z)).second);
+        }
+    }
+}
+
 } // namespace
@@ -0,0 +1,133 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "InternedStringTable.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_InternedStringTable, Intern)
+{
+    InternedStringTable Table{DefaultRawMemoryAllocator::GetAllocator()};
+
+    EXPECT_EQ(Table.Intern(nullptr), nullptr);
+
+    std::string Str0{"Resource"};
+    std::string Str1{"Resource"};
+
+    const auto* Interned0 = Table.Intern(Str0.c_str());
+    const auto* Interned1 = Table.Intern(Str1.c_str());
+    ASSERT_NE(Interned0, nullptr);
+    EXPECT_EQ(Interned0, Interned1);
+    EXPECT_NE(Interned0, Str0.c_str());
+    EXPECT_STREQ(Interned0, "Resource");
+    EXPECT_EQ(Table.GetSize(), size_t{1});
+    EXPECT_TRUE(Table.IsInterned(Interned0));
+    EXPECT_FALSE(Table.IsInterned(Str0.c_str()));
+
+    const auto* Other = Table.Intern("Other");
+    EXPECT_NE(Other, Interned0);
+    EXPECT_EQ(Table.GetSize(), size_t{2});
+
+    const auto* Empty = Table.Intern("");
+    ASSERT_NE(Empty, nullptr);
+    EXPECT_STREQ(Empty, "");
+    EXPECT_EQ(Table.GetSize(), size_t{3});
+
+    Table.Release(Interned0);
+    EXPECT_EQ(Table.GetSize(), size_t{3});
+    EXPECT_EQ(Table.Intern("Resource"), Interned1);
+    Table.Release(Interned1);
+    Table.Release(Interned1);
+    EXPECT_EQ(Table.GetSize(), size_t{2});
+
+    Table.AddRef(Other);
+    Table.Release(Other);
+    EXPECT_EQ(Table.GetSize(), size_t{2});
+    Table.Release(Other);
+    Table.Release(Empty);
+    Table.Release(nullptr);
+    EXPECT_EQ(Table.GetSize(), size_t{0});
+}
+
+TEST(Common_InternedStringTable, Concurrent)
+{
+    InternedStringTable Table{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr size_t NumThreads = 8;
+    constexpr size_t NumStrings = 256;
+
+    std::vector<std::vector<const Char*>> Results(NumThreads);
+
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Table, &Results, t]() {
+            auto& Interned = Results[t];
+            Interned.resize(NumStrings);
+            for (size_t i = 0; i < NumStrings; ++i)
+            {
+                const auto Str = "String " + std::to_string((i + t * 17) % NumStrings);
+                Interned[(i + t * 17) % NumStrings] = Table.Intern(Str.c_str());
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Table.GetSize(), NumStrings);
+    for (size_t i = 0; i < NumStrings; ++i)
+    {
+        EXPECT_STREQ(Results[0][i], ("String " + std::to_string(i)).c_str());
+        for (size_t t = 1; t < NumThreads; ++t)
+            EXPECT_EQ(Results[t][i], Results[0][i]);
+    }
+
+    Threads.clear();
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Table, &Results, t]() {
+            for (const auto* Str : Results[t])
+                Table.Release(Str);
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Table.GetSize(), size_t{0});
+}
+
+} // namespace
@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include "LockFreeBlockPool.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_LockFreeBlockPool, AllocateFree)
+{
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), 24, 4};
+
+    std::vector<void*> Blocks;
+    for (size_t i = 0; i < 4 * LockFreeBlockPool::MaxChunks + 16; ++i)
+    {
+        auto* pBlock = Pool.Allocate();
+        ASSERT_NE(pBlock, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(pBlock) % LockFreeBlockPool::BlockAlignment, size_t{0});
+        memset(pBlock, 0xCD, 24);
+        Blocks.push_back(pBlock);
+    }
+
+    auto SortedBlocks = Blocks;
+    std::sort(SortedBlocks.begin(), SortedBlocks.end());
+    EXPECT_TRUE(std::adjacent_find(SortedBlocks.begin(), SortedBlocks.end()) == SortedBlocks.end());
+
+    for (auto* pBlock : Blocks)
+        Pool.Free(pBlock);
+
+    // Freed blocks must be reused
+    auto* pBlock = Pool.Allocate();
+    EXPECT_TRUE(std::binary_search(SortedBlocks.begin(), SortedBlocks.end(), pBlock));
+    Pool.Free(pBlock);
+}
+
+TEST(Common_LockFreeBlockPool, MultiThreaded)
+{
+    LockFreeBlockPool Pool{DefaultRawMemoryAllocator::GetAllocator(), sizeof(Uint64), 64};
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::atomic<bool> Failed{false};
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Pool, &Failed, t]() {
+                std::vector<Uint64*> Blocks;
+                for (Uint32 iter = 0; iter < 200; ++iter)
+                {
+                    for (Uint32 i = 0; i < 100; ++i)
+                    {
+                        auto* pBlock = reinterpret_cast<Uint64*>(Pool.Allocate());
+                        *pBlock      = (Uint64{t} << 32u) | i;
+                        Blocks.push_back(pBlock);
+                    }
+                    for (Uint32 i = 0; i < Blocks.size(); ++i)
+                    {
+                        // If the same block was handed out to two threads, the value will be overwritten
+                        if (*Blocks[i] != ((Uint64{t} << 32u) | i))
+                            Failed.store(true);
+                        Pool.Free(Blocks[i]);
+                    }
+                    Blocks.clear();
+                }
+            });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_FALSE(Failed.load());
+}
+
+} // namespace
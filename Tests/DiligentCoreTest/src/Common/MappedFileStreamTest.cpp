@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "MappedFileStream.hpp"
+#include "FileWrapper.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_MappedFileStream, ReadBlob2)
+{
+    const char* FileName = "MappedFileStreamTest.tmp";
+
+    const char Data[] = "Memory-mapped file stream test data";
+    {
+        FileWrapper File{FileName, EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File != nullptr);
+        ASSERT_TRUE(File->Write(Data, sizeof(Data)));
+    }
+
+    {
+        RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()(FileName)};
+        if (!pStream->IsValid())
+        {
+            GTEST_SKIP() << "Memory-mapped files are not supported on this platform";
+        }
+        EXPECT_EQ(pStream->GetSize(), sizeof(Data));
+
+        char Header[7] = {};
+        ASSERT_TRUE(pStream->Read(Header, sizeof(Header)));
+        EXPECT_EQ(memcmp(Header, Data, sizeof(Header)), 0);
+
+        RefCntAutoPtr<IDataBlob> pBlob;
+        pStream->ReadBlob2(&pBlob);
+        ASSERT_NE(pBlob, nullptr);
+        ASSERT_EQ(pBlob->GetSize(), sizeof(Data) - sizeof(Header));
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Data + sizeof(Header), pBlob->GetSize()), 0);
+
+        RefCntAutoPtr<IDataBlob> pEmptyBlob;
+        pStream->ReadBlob2(&pEmptyBlob);
+        ASSERT_NE(pEmptyBlob, nullptr);
+        EXPECT_EQ(pEmptyBlob->GetSize(), size_t{0});
+
+        // The blob must remain valid after the stream is released
+        pStream.Release();
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Data + sizeof(Header), pBlob->GetSize()), 0);
+
+        // Requesting a mutable pointer makes a private copy of the data
+        auto* pMutableData = static_cast<char*>(pBlob->GetDataPtr());
+        pMutableData[0]    = '#';
+        EXPECT_EQ(pBlob->GetConstDataPtr(), pMutableData);
+        EXPECT_EQ(memcmp(pMutableData + 1, Data + sizeof(Header) + 1, pBlob->GetSize() - 1), 0);
+
+        pBlob->Resize(4);
+        EXPECT_EQ(pBlob->GetSize(), size_t{4});
+    }
+
+    FileSystem::DeleteFile(FileName);
+}
+
+TEST(Common_MappedFileStream, MissingFile)
+{
+    RefCntAutoPtr<MappedFileStream> pStream{MakeNewRCObj<MappedFileStream>()("NonExistentMappedFile.tmp")};
+    EXPECT_FALSE(pStream->IsValid());
+    EXPECT_EQ(pStream->GetSize(), size_t{0});
+}
+
+} // namespace
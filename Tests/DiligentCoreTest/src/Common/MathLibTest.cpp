@@ -27,9 +27,13 @@
 
 #include <climits>
 #include <sstream>
+#include <vector>
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "BasicMathSIMD.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1232,6 +1236,86 @@ TEST(Common_BasicMath, HighPrecisionCross)
     }
 }
 
+#if DILIGENT_BASIC_MATH_SSE2 || DILIGENT_BASIC_MATH_NEON
+TEST(Common_BasicMath, SIMDKernels)
+{
+    // This translation unit does not define DILIGENT_BASIC_MATH_SIMD, so
+    // float4x4, float4 and Quaternion operators use the scalar code.
+    FastRandFloat rnd{0, -10.f, 10.f};
+
+    auto RandMatrix = [&rnd]() {
+        float4x4 m;
+        for (int i = 0; i < 16; ++i)
+            m.Data()[i] = rnd();
+        return m;
+    };
+    auto RandVector = [&rnd]() {
+        return float4{rnd(), rnd(), rnd(), rnd()};
+    };
+
+    for (int iter = 0; iter < 256; ++iter)
+    {
+        const auto m1 = RandMatrix();
+        const auto m2 = RandMatrix();
+        const auto v  = RandVector();
+
+        {
+            float4x4 m1_m2;
+            BasicMathSIMD::MulMatMat(m1.Data(), m2.Data(), m1_m2.Data());
+            EXPECT_EQ(m1_m2, m1 * m2);
+        }
+
+        {
+            float4 v_m1;
+            BasicMathSIMD::Store(v_m1.Data(), BasicMathSIMD::MulVecMat(v.Data(), m1.Data()));
+            EXPECT_EQ(v_m1, v * m1);
+
+            float4 m1_v;
+            BasicMathSIMD::Store(m1_v.Data(), BasicMathSIMD::MulMatVec(m1.Data(), v.Data()));
+            EXPECT_EQ(m1_v, m1 * v);
+        }
+
+        {
+            const Quaternion q1{RandVector()};
+            const Quaternion q2{RandVector()};
+
+            Quaternion q1_q2;
+            BasicMathSIMD::Store(q1_q2.q.Data(), BasicMathSIMD::MulQuat(q1.q.Data(), q2.q.Data()));
+            EXPECT_EQ(q1_q2, q1 * q2);
+        }
+
+        {
+            // Diagonally dominant matrix is well-conditioned
+            auto m = m1;
+            m *= 0.1f;
+            m._11 += 5.f;
+            m._22 -= 6.f;
+            m._33 += 7.f;
+            m._44 += 8.f;
+
+            float4x4 Inv;
+            BasicMathSIMD::InverseMat(m.Data(), Inv.Data());
+
+            const auto RefInv = m.Inverse();
+            for (int i = 0; i < 16; ++i)
+                EXPECT_NEAR(Inv.Data()[i], RefInv.Data()[i], 1e-5f * (1.f + std::abs(RefInv.Data()[i])));
+        }
+    }
+
+    {
+        const auto m = float4x4::RotationX(0.5f) * float4x4::RotationZ(-1.25f) * float4x4::Translation(1, 2, 3);
+
+        float4x4 Inv;
+        BasicMathSIMD::InverseMat(m.Data(), Inv.Data());
+
+        const auto Identity = m * Inv;
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                EXPECT_NEAR(Identity[i][j], i == j ? 1.f : 0.f, 1e-6f);
+    }
+}
+#endif
+
 TEST(Common_AdvancedMath, Planes)
 {
     Plane3D plane = {};
@@ -1244,6 +1328,78 @@ TEST(Common_AdvancedMath, Planes)
     EXPECT_NE(std::hash<ViewFrustumExt>{}(frustm_ext), size_t{0});
 }
 
+TEST(Common_AdvancedMath, GetBoxVisibilityBatch)
+{
+    const auto ViewProj = float4x4::RotationY(0.3f) * float4x4::Translation(1.f, -2.f, 10.f) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 50.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+
+    FastRandFloat rnd{0, -60.f, 60.f};
+    FastRandFloat rnd_size{1, 0.f, 20.f};
+
+    // Not a multiple of the SIMD width and of 32
+    constexpr size_t NumBoxes = 1000 + 13;
+
+    std::vector<float> MinX(NumBoxes), MinY(NumBoxes), MinZ(NumBoxes), MaxX(NumBoxes), MaxY(NumBoxes), MaxZ(NumBoxes);
+    for (size_t i = 0; i < NumBoxes; ++i)
+    {
+        MinX[i] = rnd();
+        MinY[i] = rnd();
+        MinZ[i] = rnd();
+        MaxX[i] = MinX[i] + rnd_size();
+        MaxY[i] = MinY[i] + rnd_size();
+        MaxZ[i] = MinZ[i] + rnd_size();
+    }
+
+    BoundBoxBatch Boxes;
+    Boxes.MinX = MinX.data();
+    Boxes.MinY = MinY.data();
+    Boxes.MinZ = MinZ.data();
+    Boxes.MaxX = MaxX.data();
+    Boxes.MaxY = MaxY.data();
+    Boxes.MaxZ = MaxZ.data();
+
+    for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_LEFT_PLANE | FRUSTUM_PLANE_FLAG_TOP_PLANE, FRUSTUM_PLANE_FLAG_NONE})
+    {
+        for (bool UseExt : {false, true})
+        {
+            std::vector<Uint32> VisibleMask((NumBoxes + 31) / 32, ~0u);
+            std::vector<Uint32> FullyVisibleMask(VisibleMask.size(), ~0u);
+            if (UseExt)
+                GetBoxVisibilityBatch(Frustum, Boxes, NumBoxes, VisibleMask.data(), FullyVisibleMask.data(), PlaneFlags);
+            else
+                GetBoxVisibilityBatch(static_cast<const ViewFrustum&>(Frustum), Boxes, NumBoxes, VisibleMask.data(), FullyVisibleMask.data(), PlaneFlags);
+
+            size_t NumVisible = 0;
+            for (size_t i = 0; i < NumBoxes; ++i)
+            {
+                BoundBox Box{float3{MinX[i], MinY[i], MinZ[i]}, float3{MaxX[i], MaxY[i], MaxZ[i]}};
+
+                const auto RefVisibility = UseExt ?
+                    GetBoxVisibility(Frustum, Box, PlaneFlags) :
+                    GetBoxVisibility(static_cast<const ViewFrustum&>(Frustum), Box, PlaneFlags);
+
+                const bool IsVisible      = (VisibleMask[i / 32] & (1u << (i % 32))) != 0;
+                const bool IsFullyVisible = (FullyVisibleMask[i / 32] & (1u << (i % 32))) != 0;
+                EXPECT_EQ(IsVisible, RefVisibility != BoxVisibility::Invisible) << "Box " << i;
+                EXPECT_EQ(IsFullyVisible, RefVisibility == BoxVisibility::FullyVisible) << "Box " << i;
+                if (IsVisible)
+                    ++NumVisible;
+            }
+            if (PlaneFlags != FRUSTUM_PLANE_FLAG_NONE)
+            {
+                EXPECT_GT(NumVisible, size_t{0});
+                EXPECT_LT(NumVisible, NumBoxes);
+            }
+
+            // Unused bits must be zero
+            EXPECT_EQ(VisibleMask.back() >> (NumBoxes % 32), 0u);
+            EXPECT_EQ(FullyVisibleMask.back() >> (NumBoxes % 32), 0u);
+        }
+    }
+}
+
 TEST(Common_AdvancedMath, HermiteSpline)
 {
     EXPECT_NE(HermiteSpline(float3(1, 2, 3), float3(4, 5, 6), float3(7, 8, 9), float3(10, 11, 12), 0.1f), float3(0, 0, 0));
@@ -1489,6 +1645,167 @@ static void TestLineTrace(float2 Start, float2 End, const std::initializer_list<
     }
 }
 
+TEST(Common_AdvancedMath, IntersectRayBatchAABB)
+{
+    FastRandFloat rnd{0, -10.f, 10.f};
+    FastRandFloat rnd_dir{1, -1.f, 1.f};
+
+    // Not a multiple of the SIMD width and of 32
+    constexpr size_t NumRays = 1000 + 13;
+
+    std::vector<float> OX(NumRays), OY(NumRays), OZ(NumRays), DX(NumRays), DY(NumRays), DZ(NumRays);
+    for (size_t i = 0; i < NumRays; ++i)
+    {
+        OX[i] = rnd();
+        OY[i] = rnd();
+        OZ[i] = rnd();
+        // Aim at the box to get a good mix of hits and misses
+        DX[i] = -OX[i] * 0.1f + rnd_dir();
+        DY[i] = -OY[i] * 0.1f + rnd_dir();
+        DZ[i] = -OZ[i] * 0.1f + rnd_dir();
+        // Axis-aligned rays
+        if (i % 7 == 0)
+            DX[i] = 0;
+        if (i % 11 == 0)
+            DY[i] = 0;
+    }
+
+    RayBatch Rays;
+    Rays.OriginX    = OX.data();
+    Rays.OriginY    = OY.data();
+    Rays.OriginZ    = OZ.data();
+    Rays.DirectionX = DX.data();
+    Rays.DirectionY = DY.data();
+    Rays.DirectionZ = DZ.data();
+
+    const BoundBox AABB{float3{-2, -1, -3}, float3{3, 2, 1}};
+
+    std::vector<Uint32> HitMask((NumRays + 31) / 32, ~0u);
+    std::vector<float>  EnterDist(NumRays), ExitDist(NumRays);
+    IntersectRayBatchAABB(Rays, NumRays, AABB, HitMask.data(), EnterDist.data(), ExitDist.data());
+
+    size_t NumHits = 0;
+    for (size_t i = 0; i < NumRays; ++i)
+    {
+        float      RefEnter = 0, RefExit = 0;
+        const bool RefHit = IntersectRayAABB(float3{OX[i], OY[i], OZ[i]}, float3{DX[i], DY[i], DZ[i]}, AABB, RefEnter, RefExit);
+
+        const bool Hit = (HitMask[i / 32] & (1u << (i % 32))) != 0;
+        EXPECT_EQ(Hit, RefHit) << "Ray " << i;
+        EXPECT_EQ(EnterDist[i], RefEnter) << "Ray " << i;
+        EXPECT_EQ(ExitDist[i], RefExit) << "Ray " << i;
+        if (Hit)
+            ++NumHits;
+    }
+    EXPECT_GT(NumHits, size_t{0});
+    EXPECT_LT(NumHits, NumRays);
+    EXPECT_EQ(HitMask.back() >> (NumRays % 32), 0u);
+
+    // Optional outputs
+    IntersectRayBatchAABB(Rays, NumRays, AABB, HitMask.data());
+}
+
+namespace
+{
+
+struct TestTriangles
+{
+    explicit TestTriangles(size_t NumTriangles)
+    {
+        FastRandFloat rnd{0, -5.f, 5.f};
+        for (auto* pCoords : {&V0X, &V0Y, &V0Z, &V1X, &V1Y, &V1Z, &V2X, &V2Y, &V2Z})
+        {
+            pCoords->resize(NumTriangles);
+            for (auto& c : *pCoords)
+                c = rnd();
+        }
+
+        Batch.V0X = V0X.data();
+        Batch.V0Y = V0Y.data();
+        Batch.V0Z = V0Z.data();
+        Batch.V1X = V1X.data();
+        Batch.V1Y = V1Y.data();
+        Batch.V1Z = V1Z.data();
+        Batch.V2X = V2X.data();
+        Batch.V2Y = V2Y.data();
+        Batch.V2Z = V2Z.data();
+    }
+
+    float Intersect(size_t i, const float3& RayOrigin, const float3& RayDirection, bool CullBackFace) const
+    {
+        return IntersectRayTriangle(float3{V0X[i], V0Y[i], V0Z[i]},
+                                    float3{V1X[i], V1Y[i], V1Z[i]},
+                                    float3{V2X[i], V2Y[i], V2Z[i]},
+                                    RayOrigin, RayDirection, CullBackFace);
+    }
+
+    std::vector<float> V0X, V0Y, V0Z, V1X, V1Y, V1Z, V2X, V2Y, V2Z;
+    TriangleBatch      Batch;
+};
+
+} // namespace
+
+TEST(Common_AdvancedMath, IntersectRayTriangleBatch)
+{
+    // Not a multiple of the SIMD width
+    constexpr size_t NumTriangles = 1000 + 13;
+
+    const TestTriangles Triangles{NumTriangles};
+
+    const float3 RayOrigin{0.5f, -0.25f, -10.f};
+    const float3 RayDirection{0.01f, 0.02f, 1.f};
+
+    for (bool CullBackFace : {false, true})
+    {
+        std::vector<float> Distances(NumTriangles);
+        IntersectRayTriangleBatch(RayOrigin, RayDirection, Triangles.Batch, NumTriangles, Distances.data(), CullBackFace);
+
+        size_t NumHits = 0;
+        for (size_t i = 0; i < NumTriangles; ++i)
+        {
+            EXPECT_EQ(Distances[i], Triangles.Intersect(i, RayOrigin, RayDirection, CullBackFace)) << "Triangle " << i;
+            if (Distances[i] != +FLT_MAX)
+                ++NumHits;
+        }
+        EXPECT_GT(NumHits, size_t{0});
+        EXPECT_LT(NumHits, NumTriangles);
+    }
+}
+
+TEST(Common_AdvancedMath, DISABLED_IntersectRayTriangleBatchPerformance)
+{
+    constexpr size_t NumTriangles = 65536;
+
+    const TestTriangles Triangles{NumTriangles};
+
+    const float3 RayOrigin{0.5f, -0.25f, -10.f};
+    const float3 RayDirection{0.01f, 0.02f, 1.f};
+
+    std::vector<float> Distances(NumTriangles);
+    std::vector<float> RefDistances(NumTriangles);
+
+    Timer  T;
+    double ScalarTime = 0;
+    double BatchTime  = 0;
+
+    constexpr int NumIterations = 100;
+    for (int iter = 0; iter < NumIterations; ++iter)
+    {
+        T.Restart();
+        for (size_t i = 0; i < NumTriangles; ++i)
+            RefDistances[i] = Triangles.Intersect(i, RayOrigin, RayDirection, false);
+        ScalarTime += T.GetElapsedTime();
+
+        T.Restart();
+        IntersectRayTriangleBatch(RayOrigin, RayDirection, Triangles.Batch, NumTriangles, Distances.data());
+        BatchTime += T.GetElapsedTime();
+    }
+    EXPECT_EQ(Distances, RefDistances);
+
+    LOG_INFO_MESSAGE(NumTriangles, " ray-triangle tests: IntersectRayTriangle: ", ScalarTime / NumIterations * 1000.0,
+                     " ms, IntersectRayTriangleBatch: ", BatchTime / NumIterations * 1000.0, " ms");
+}
+
 TEST(Common_AdvancedMath, TraceLineThroughGrid)
 {
     // Horizontal direction
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "ObjectHandleTable.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ObjectHandleTable, AllocateRelease)
+{
+    ObjectHandleTable Table;
+    EXPECT_FALSE(Table.IsAlive(ObjectHandleTable::NullHandle));
+
+    auto h0 = Table.Allocate();
+    auto h1 = Table.Allocate();
+    EXPECT_NE(h0, ObjectHandleTable::NullHandle);
+    EXPECT_NE(h1, ObjectHandleTable::NullHandle);
+    EXPECT_NE(h0, h1);
+    EXPECT_EQ(ObjectHandleTable::GetSlotIndex(h0), 0u);
+    EXPECT_EQ(ObjectHandleTable::GetSlotIndex(h1), 1u);
+    EXPECT_TRUE(Table.IsAlive(h0));
+    EXPECT_TRUE(Table.IsAlive(h1));
+    EXPECT_EQ(Table.GetSlotCount(), 2u);
+    EXPECT_EQ(Table.GetNumAliveHandles(), 2u);
+
+    Table.Release(h0);
+    EXPECT_FALSE(Table.IsAlive(h0));
+    EXPECT_TRUE(Table.IsAlive(h1));
+    EXPECT_EQ(Table.GetNumAliveHandles(), 1u);
+
+    Table.Release(h1);
+    Table.Release(ObjectHandleTable::NullHandle);
+    EXPECT_EQ(Table.GetNumAliveHandles(), 0u);
+}
+
+TEST(Common_ObjectHandleTable, SlotReuse)
+{
+    ObjectHandleTable Table;
+
+    // Slots are not reused until more than MinFreeSlots slots have been released
+    std::vector<ObjectHandle> Handles;
+    for (Uint32 i = 0; i < ObjectHandleTable::MinFreeSlots + 1; ++i)
+        Handles.push_back(Table.Allocate());
+    for (auto h : Handles)
+        Table.Release(h);
+    EXPECT_EQ(Table.GetSlotCount(), ObjectHandleTable::MinFreeSlots + 1);
+
+    // The slot released first is reused first, with the next generation
+    auto h = Table.Allocate();
+    EXPECT_EQ(Table.GetSlotCount(), ObjectHandleTable::MinFreeSlots + 1);
+    EXPECT_EQ(ObjectHandleTable::GetSlotIndex(h), ObjectHandleTable::GetSlotIndex(Handles[0]));
+    EXPECT_EQ(ObjectHandleTable::GetGeneration(h), ObjectHandleTable::GetGeneration(Handles[0]) + 1);
+    EXPECT_NE(h, Handles[0]);
+    EXPECT_TRUE(Table.IsAlive(h));
+    EXPECT_FALSE(Table.IsAlive(Handles[0]));
+
+    Table.Release(h);
+}
+
+TEST(Common_ObjectHandleTable, GenerationWrap)
+{
+    ObjectHandleTable Table;
+
+    // Keep MinFreeSlots + 1 slots in the free list so that slots are always reused
+    std::vector<ObjectHandle> Handles;
+    for (Uint32 i = 0; i < ObjectHandleTable::MinFreeSlots + 1; ++i)
+        Handles.push_back(Table.Allocate());
+    for (auto h : Handles)
+        Table.Release(h);
+
+    const Uint32 NumIterations = (ObjectHandleTable::MinFreeSlots + 2) * (1u << ObjectHandleTable::GenerationBits);
+    for (Uint32 i = 0; i < NumIterations; ++i)
+    {
+        auto h = Table.Allocate();
+        ASSERT_NE(h, ObjectHandleTable::NullHandle);
+        ASSERT_NE(ObjectHandleTable::GetGeneration(h), 0u);
+        Table.Release(h);
+    }
+    EXPECT_EQ(Table.GetSlotCount(), ObjectHandleTable::MinFreeSlots + 1);
+}
+
+TEST(Common_ObjectHandleTable, Threading)
+{
+    ObjectHandleTable Table;
+
+    constexpr Uint32 NumThreads       = 4;
+    constexpr Uint32 HandlesPerThread = 4096;
+
+    std::vector<std::vector<ObjectHandle>> ThreadHandles(NumThreads);
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            auto& Handles = ThreadHandles[t];
+            for (Uint32 i = 0; i < HandlesPerThread; ++i)
+            {
+                Handles.push_back(Table.Allocate());
+                if (i % 3 == 0)
+                {
+                    Table.Release(Handles.back());
+                    Handles.pop_back();
+                }
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    std::unordered_set<ObjectHandle> UniqueHandles;
+    for (const auto& Handles : ThreadHandles)
+    {
+        for (auto h : Handles)
+        {
+            EXPECT_TRUE(Table.IsAlive(h));
+            EXPECT_TRUE(UniqueHandles.insert(h).second);
+        }
+    }
+    EXPECT_EQ(Table.GetNumAliveHandles(), UniqueHandles.size());
+
+    for (auto h : UniqueHandles)
+        Table.Release(h);
+    EXPECT_EQ(Table.GetNumAliveHandles(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "ProxyDataBlob.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ProxyDataBlob, ReleaseCallback)
+{
+    const Uint8 Data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    int NumReleases = 0;
+
+    auto ReleaseCallback = [](const void* pData, void* pUserData) {
+        ++*static_cast<int*>(pUserData);
+    };
+
+    {
+        RefCntAutoPtr<ProxyDataBlob> pBlob{MakeNewRCObj<ProxyDataBlob>{}(Data, sizeof(Data), ReleaseCallback, &NumReleases)};
+        EXPECT_TRUE(pBlob->IsExternal());
+        EXPECT_EQ(pBlob->GetSize(), sizeof(Data));
+        EXPECT_EQ(pBlob->GetConstDataPtr(), static_cast<const void*>(Data));
+    }
+    EXPECT_EQ(NumReleases, 1);
+
+    {
+        RefCntAutoPtr<ProxyDataBlob> pBlob{MakeNewRCObj<ProxyDataBlob>{}(Data, sizeof(Data), ReleaseCallback, &NumReleases)};
+
+        // Requesting a mutable pointer makes a copy and releases the external memory
+        auto* pMutableData = static_cast<Uint8*>(pBlob->GetDataPtr());
+        EXPECT_EQ(NumReleases, 2);
+        EXPECT_FALSE(pBlob->IsExternal());
+        EXPECT_NE(pMutableData, Data);
+        EXPECT_EQ(memcmp(pMutableData, Data, sizeof(Data)), 0);
+        EXPECT_EQ(pBlob->GetConstDataPtr(), pMutableData);
+
+        pBlob->Resize(4);
+        EXPECT_EQ(pBlob->GetSize(), size_t{4});
+    }
+    EXPECT_EQ(NumReleases, 2);
+}
+
+TEST(Common_ProxyDataBlob, Owner)
+{
+    RefCntAutoPtr<IDataBlob> pOwner{MakeNewRCObj<DataBlobImpl>{}(16)};
+    memset(pOwner->GetDataPtr(), 0xAB, pOwner->GetSize());
+
+    const auto* pOwnerData = static_cast<const Uint8*>(pOwner->GetConstDataPtr());
+
+    RefCntAutoPtr<IDataBlob> pBlob{MakeNewRCObj<ProxyDataBlob>{}(pOwnerData + 4, size_t{8}, pOwner)};
+    // The blob keeps the owner alive
+    pOwner.Release();
+
+    EXPECT_EQ(pBlob->GetSize(), size_t{8});
+    EXPECT_EQ(pBlob->GetConstDataPtr(), pOwnerData + 4);
+    EXPECT_EQ(static_cast<const Uint8*>(pBlob->GetConstDataPtr())[7], Uint8{0xAB});
+}
+
+} // namespace
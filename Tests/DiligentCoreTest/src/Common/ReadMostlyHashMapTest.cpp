@@ -0,0 +1,176 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+
+#include "ReadMostlyHashMap.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ReadMostlyHashMap, InsertFindErase)
+{
+    ReadMostlyHashMap<Uint32, Uint64> Map{4};
+
+    constexpr Uint32 NumKeys = 1000;
+    for (Uint32 i = 0; i < NumKeys; ++i)
+    {
+        EXPECT_TRUE(Map.Insert(i, Uint64{i} * 3));
+        EXPECT_FALSE(Map.Insert(i, 0));
+    }
+    EXPECT_EQ(Map.Size(), size_t{NumKeys});
+
+    for (Uint32 i = 0; i < NumKeys; ++i)
+    {
+        Uint64 Value = 0;
+        EXPECT_TRUE(Map.Find(i, Value));
+        EXPECT_EQ(Value, Uint64{i} * 3);
+    }
+
+    Uint64 Value = 0;
+    EXPECT_FALSE(Map.Find(NumKeys, Value));
+
+    for (Uint32 i = 0; i < NumKeys; i += 2)
+        EXPECT_TRUE(Map.Erase(i));
+    EXPECT_FALSE(Map.Erase(0));
+    EXPECT_EQ(Map.Size(), size_t{NumKeys / 2});
+
+    for (Uint32 i = 0; i < NumKeys; ++i)
+        EXPECT_EQ(Map.Find(i, Value), (i % 2) != 0);
+
+    // There are no readers, so nothing should be kept alive
+    EXPECT_EQ(Map.GetNumRetiredObjects(), size_t{0});
+
+    Map.Clear();
+    EXPECT_EQ(Map.Size(), size_t{0});
+    EXPECT_FALSE(Map.Find(1, Value));
+    EXPECT_TRUE(Map.Insert(1, 10));
+    EXPECT_TRUE(Map.Find(1, Value));
+    EXPECT_EQ(Value, Uint64{10});
+}
+
+TEST(Common_ReadMostlyHashMap, FindHandlerForEach)
+{
+    ReadMostlyHashMap<Uint32, Uint64> Map{4};
+    for (Uint32 i = 0; i < 100; ++i)
+        Map.Insert(i, Uint64{i} * 2);
+
+    Uint64 Value = 0;
+    EXPECT_TRUE(Map.Find(10u, [&Value](const Uint64& V) { Value = V; return true; }));
+    EXPECT_EQ(Value, Uint64{20});
+    // The handler's result is returned for found keys
+    EXPECT_FALSE(Map.Find(10u, [](const Uint64&) { return false; }));
+    EXPECT_FALSE(Map.Find(100u, [](const Uint64&) { ADD_FAILURE() << "Handler must not be called for missing keys"; return true; }));
+
+    Uint64 KeySum   = 0;
+    Uint64 ValueSum = 0;
+    size_t Count    = 0;
+    Map.ForEach([&](const Uint32& Key, const Uint64& Val) {
+        KeySum += Key;
+        ValueSum += Val;
+        ++Count;
+    });
+    EXPECT_EQ(Count, size_t{100});
+    EXPECT_EQ(KeySum, Uint64{4950});
+    EXPECT_EQ(ValueSum, Uint64{9900});
+}
+
+TEST(Common_ReadMostlyHashMap, ConcurrentReaders)
+{
+    ReadMostlyHashMap<Uint32, Uint64> Map{4};
+
+    // Keys [0, NumStableKeys) are never removed, other keys are constantly inserted and erased
+    constexpr Uint32 NumStableKeys = 256;
+    constexpr Uint32 NumKeys       = 1024;
+    for (Uint32 i = 0; i < NumStableKeys; ++i)
+        Map.Insert(i, Uint64{i} + 1);
+
+    std::atomic<bool>   Stop{false};
+    std::atomic<Uint32> NumErrors{0};
+    std::mutex          WriterMtx;
+
+    auto Reader = [&](Uint32 Seed) {
+        Uint32 Key = Seed;
+        while (!Stop.load())
+        {
+            Key = (Key * 1103515245u + 12345u) % NumKeys;
+
+            Uint64 Value = 0;
+            if (Map.Find(Key, Value))
+            {
+                if (Value != Uint64{Key} + 1)
+                    NumErrors.fetch_add(1);
+            }
+            else if (Key < NumStableKeys)
+            {
+                NumErrors.fetch_add(1);
+            }
+        }
+    };
+
+    auto Writer = [&]() {
+        for (Uint32 iter = 0; iter < 200; ++iter)
+        {
+            for (Uint32 i = NumStableKeys; i < NumKeys; ++i)
+            {
+                std::lock_guard<std::mutex> Lock{WriterMtx};
+                Map.Insert(i, Uint64{i} + 1);
+            }
+            for (Uint32 i = NumStableKeys; i < NumKeys; ++i)
+            {
+                std::lock_guard<std::mutex> Lock{WriterMtx};
+                Map.Erase(i);
+            }
+        }
+    };
+
+    std::vector<std::thread> Threads;
+    for (Uint32 i = 0; i < 4; ++i)
+        Threads.emplace_back(Reader, i);
+
+    std::thread Writer0{Writer};
+    std::thread Writer1{Writer};
+    Writer0.join();
+    Writer1.join();
+
+    Stop.store(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(NumErrors.load(), 0u);
+    EXPECT_EQ(Map.Size(), size_t{NumStableKeys});
+}
+
+} // namespace
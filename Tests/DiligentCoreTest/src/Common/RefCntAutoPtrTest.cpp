@@ -30,11 +30,13 @@
 #include <mutex>
 #include <condition_variable>
 #include <algorithm>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "RefCountedObjectImpl.hpp"
 #include "ThreadSignal.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -904,4 +906,59 @@ TEST(Common_RefCntAutoPtr, Threading)
     ThreadingTest.RunConcurrencyTest();
 }
 
+// Measures how AddRef()/Release() throughput scales with the number of threads when every thread
+// references its own object (the reference counters of consecutively created objects are allocated
+// next to each other and may falsely share a cache line), and when all threads reference the same object.
+// Build with DILIGENT_CACHE_ALIGNED_REF_COUNTERS to compare the padded layout.
+TEST(Common_RefCntAutoPtr, DISABLED_ContentionScaling)
+{
+    constexpr Uint32 CopiesPerThread = 1 << 22;
+
+    const Uint32 MaxThreads = std::max(std::thread::hardware_concurrency(), 4u);
+#ifdef DILIGENT_CACHE_ALIGNED_REF_COUNTERS
+    const char* LayoutName = " (cache-aligned reference counters)";
+#else
+    const char* LayoutName = "";
+#endif
+
+    auto RunThreads = [&](Uint32 NumThreads, const std::vector<SmartPtr>& Objects) {
+        Timer T;
+
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&, t]() {
+                const auto& pObj = Objects[t % Objects.size()];
+                for (Uint32 i = 0; i < CopiesPerThread; ++i)
+                {
+                    SmartPtr pCopy{pObj};
+                    (void)pCopy;
+                }
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        for (const auto& pObj : Objects)
+            EXPECT_EQ(pObj->GetReferenceCounters()->GetNumStrongRefs(), 1);
+
+        return T.GetElapsedTime();
+    };
+
+    for (Uint32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+    {
+        std::vector<SmartPtr> PrivateObjects;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+            PrivateObjects.emplace_back(MakeNewObj<Object>());
+
+        const std::vector<SmartPtr> SharedObject{SmartPtr{MakeNewObj<Object>()}};
+
+        const auto PrivateTime = RunThreads(NumThreads, PrivateObjects);
+        const auto SharedTime  = RunThreads(NumThreads, SharedObject);
+
+        LOG_INFO_MESSAGE(NumThreads, " threads x ", CopiesPerThread, " copies: private objects: ", PrivateTime * 1000.0,
+                         " ms, shared object: ", SharedTime * 1000.0, " ms", LayoutName);
+    }
+}
+
 } // namespace
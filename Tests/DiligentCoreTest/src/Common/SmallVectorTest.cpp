@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <memory>
+#include <string>
+
+#include "SmallVector.hpp"
+#include "STDAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_SmallVector, InPlace)
+{
+    SmallVector<int, 4> Vec;
+    EXPECT_TRUE(Vec.empty());
+    EXPECT_TRUE(Vec.IsInPlace());
+    EXPECT_EQ(Vec.capacity(), size_t{4});
+
+    for (int i = 0; i < 4; ++i)
+        Vec.push_back(i);
+    EXPECT_TRUE(Vec.IsInPlace());
+    EXPECT_EQ(Vec.size(), size_t{4});
+    EXPECT_EQ(Vec.front(), 0);
+    EXPECT_EQ(Vec.back(), 3);
+
+    Vec.push_back(4);
+    EXPECT_FALSE(Vec.IsInPlace());
+    EXPECT_GE(Vec.capacity(), size_t{5});
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(Vec[i], i);
+
+    Vec.pop_back();
+    EXPECT_EQ(Vec.size(), size_t{4});
+
+    auto it = Vec.erase(Vec.begin() + 1);
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(Vec, (SmallVector<int, 4>{0, 2, 3}));
+
+    Vec.clear();
+    EXPECT_TRUE(Vec.empty());
+}
+
+TEST(Common_SmallVector, Resize)
+{
+    SmallVector<std::string, 2> Vec;
+    Vec.resize(3, "abc");
+    EXPECT_EQ(Vec.size(), size_t{3});
+    for (const auto& Str : Vec)
+        EXPECT_EQ(Str, "abc");
+
+    Vec.resize(1);
+    EXPECT_EQ(Vec.size(), size_t{1});
+    Vec.resize(2);
+    EXPECT_EQ(Vec[1], "");
+
+    // Push an element of the vector itself when the vector has to grow
+    SmallVector<std::string, 2> Vec2{"first", "second"};
+    Vec2.push_back(Vec2[0]);
+    EXPECT_EQ(Vec2[2], "first");
+}
+
+TEST(Common_SmallVector, CopyMove)
+{
+    for (size_t Count : {2, 8})
+    {
+        SmallVector<std::unique_ptr<int>, 4> Vec;
+        for (size_t i = 0; i < Count; ++i)
+            Vec.emplace_back(new int{static_cast<int>(i)});
+
+        SmallVector<std::unique_ptr<int>, 4> Vec2{std::move(Vec)};
+        EXPECT_TRUE(Vec.empty());
+        ASSERT_EQ(Vec2.size(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(*Vec2[i], static_cast<int>(i));
+
+        Vec.emplace_back(new int{10});
+        Vec = std::move(Vec2);
+        ASSERT_EQ(Vec.size(), Count);
+        EXPECT_EQ(*Vec.back(), static_cast<int>(Count - 1));
+    }
+
+    SmallVector<std::string, 2> Vec{"a", "b", "c"};
+    SmallVector<std::string, 2> Vec2{Vec};
+    EXPECT_EQ(Vec, Vec2);
+    Vec2 = SmallVector<std::string, 2>{"d"};
+    EXPECT_NE(Vec, Vec2);
+    Vec2 = Vec;
+    EXPECT_EQ(Vec, Vec2);
+}
+
+TEST(Common_SmallVector, Allocator)
+{
+    using AllocatorType = STDAllocatorRawMem<Uint32>;
+    SmallVector<Uint32, 4, AllocatorType> Vec{STD_ALLOCATOR_RAW_MEM(Uint32, DefaultRawMemoryAllocator::GetAllocator(), "Allocator for SmallVector<Uint32>")};
+    for (Uint32 i = 0; i < 100; ++i)
+        Vec.push_back(i);
+    EXPECT_FALSE(Vec.IsInPlace());
+    for (Uint32 i = 0; i < 100; ++i)
+        EXPECT_EQ(Vec[i], i);
+
+    auto Vec2 = std::move(Vec);
+    EXPECT_EQ(Vec2.size(), size_t{100});
+}
+
+} // namespace
@@ -25,6 +25,8 @@
  *  of the possibility of such damages.
  */
 
+#include <vector>
+
 #include "StringTools.hpp"
 
 #include "gtest/gtest.h"
@@ -127,4 +129,35 @@ TEST(Common_StringTools, CountFloatNumberChars)
     EXPECT_EQ(CountFloatNumberChars("0.e+0123456789 "), size_t{14});
 }
 
+TEST(Common_StringTools, ForEachIncludeDirective)
+{
+    auto GetIncludes = [](const char* Source) {
+        std::vector<std::string> Includes;
+        ForEachIncludeDirective(Source, strlen(Source), [&](std::string&& Name) { Includes.emplace_back(std::move(Name)); });
+        return Includes;
+    };
+
+    EXPECT_TRUE(GetIncludes("").empty());
+    EXPECT_TRUE(GetIncludes("#include").empty());
+    EXPECT_TRUE(GetIncludes("#define X\nint x;").empty());
+
+    using Names = std::vector<std::string>;
+    EXPECT_EQ(GetIncludes("#include \"a.h\""), Names({"a.h"}));
+    EXPECT_EQ(GetIncludes("#include <b.h>"), Names({"b.h"}));
+    EXPECT_EQ(GetIncludes("  #  include\t\"a.h\"\n\t#\tinclude <b.h>\n"), Names({"a.h", "b.h"}));
+    EXPECT_EQ(GetIncludes("#include \"a.h\"\nint x;\n#include \"a.h\""), Names({"a.h", "a.h"}));
+    EXPECT_EQ(GetIncludes("#ifdef X\n#include \"a.h\"\n#else\n#include \"b.h\"\n#endif"), Names({"a.h", "b.h"}));
+
+    // Unterminated names are skipped
+    EXPECT_TRUE(GetIncludes("#include \"a.h").empty());
+    EXPECT_TRUE(GetIncludes("#include <b.h").empty());
+    EXPECT_TRUE(GetIncludes("#include <b.h\"").empty());
+
+    // Names may not span lines
+    EXPECT_EQ(GetIncludes("#include \"a.h\n\"b.h\"\n#include \"c.h\""), Names({"c.h"}));
+
+    // Directives must start the line
+    EXPECT_TRUE(GetIncludes("int x; #include \"a.h\"").empty());
+}
+
 } // namespace
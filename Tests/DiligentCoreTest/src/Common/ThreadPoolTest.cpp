@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <atomic>
+
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, EnqueueAndWait)
+{
+    ThreadPool Pool{4};
+    EXPECT_EQ(Pool.GetThreadCount(), 4u);
+
+    constexpr int NumTasks = 1024;
+
+    std::atomic<int> Counter{0};
+    for (int i = 0; i < NumTasks; ++i)
+    {
+        Pool.EnqueueTask([&Counter]() {
+            Counter.fetch_add(1);
+        });
+    }
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), NumTasks);
+
+    // The pool must be reusable after all tasks have finished
+    Pool.EnqueueTask([&Counter]() {
+        Counter.fetch_add(1);
+    });
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), NumTasks + 1);
+}
+
+TEST(Common_ThreadPool, DestroyWithPendingTasks)
+{
+    constexpr int NumTasks = 256;
+
+    std::atomic<int> Counter{0};
+    {
+        ThreadPool Pool{2};
+        for (int i = 0; i < NumTasks; ++i)
+        {
+            Pool.EnqueueTask([&Counter]() {
+                Counter.fetch_add(1);
+            });
+        }
+    }
+    // All enqueued tasks must be executed before the pool is destroyed
+    EXPECT_EQ(Counter.load(), NumTasks);
+}
+
+TEST(Common_ThreadPool, DestroyFromWorkerThread)
+{
+    std::atomic<bool> Destroyed{false};
+
+    auto* pPool = new ThreadPool{1};
+    pPool->EnqueueTask([pPool, &Destroyed]() {
+        delete pPool;
+        Destroyed.store(true);
+    });
+
+    while (!Destroyed.load())
+        std::this_thread::yield();
+}
+
+TEST(Common_ThreadPool, NestedTasks)
+{
+    ThreadPool Pool{4};
+
+    constexpr int NumParentTasks = 16;
+    constexpr int NumChildTasks  = 64;
+
+    std::atomic<int> Counter{0};
+    for (int i = 0; i < NumParentTasks; ++i)
+    {
+        Pool.EnqueueTask([&Pool, &Counter]() {
+            // Tasks enqueued from a worker thread go to its own queue
+            // and are stolen by the other threads
+            for (int j = 0; j < NumChildTasks; ++j)
+            {
+                Pool.EnqueueTask([&Counter]() {
+                    Counter.fetch_add(1);
+                });
+            }
+        });
+    }
+    // The nested tasks are enqueued before their parent task completes,
+    // so they must be waited for too
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), NumParentTasks * NumChildTasks);
+}
+
+TEST(Common_ThreadPool, IThreadPool)
+{
+    ThreadPoolCreateInfo PoolCI;
+    PoolCI.NumThreads = 3;
+
+    RefCntAutoPtr<IThreadPool> pPool;
+    CreateThreadPool(PoolCI, &pPool);
+    ASSERT_NE(pPool, nullptr);
+    EXPECT_EQ(pPool->GetThreadCount(), 3u);
+
+    constexpr int NumTasks = 256;
+
+    std::atomic<int> Counter{0};
+    for (int i = 0; i < NumTasks; ++i)
+    {
+        EnqueueTask(pPool, [&Counter]() {
+            Counter.fetch_add(1);
+        });
+    }
+    pPool->WaitForAllTasks();
+    EXPECT_EQ(Counter.load(), NumTasks);
+}
+
+TEST(Common_ThreadPool, DefaultThreadCount)
+{
+    EXPECT_GE(ThreadPool::GetDefaultThreadCount(), 1u);
+
+    ThreadPool Pool;
+    EXPECT_EQ(Pool.GetThreadCount(), ThreadPool::GetDefaultThreadCount());
+}
+
+} // namespace
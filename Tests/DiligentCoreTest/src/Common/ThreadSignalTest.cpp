@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ThreadSignal.hpp"
+#include "LockHelper.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace ThreadingTools;
+
+namespace
+{
+
+TEST(Common_ThreadSignal, TriggeredBeforeWait)
+{
+    Signal Sig;
+    EXPECT_FALSE(Sig.IsTriggered());
+    Sig.Trigger(false, 5);
+    EXPECT_TRUE(Sig.IsTriggered());
+    EXPECT_EQ(Sig.Wait(), 5);
+    EXPECT_EQ(Sig.Wait(), 5);
+    Sig.Reset();
+    EXPECT_FALSE(Sig.IsTriggered());
+}
+
+TEST(Common_ThreadSignal, AutoReset)
+{
+    constexpr int NumThreads = 4;
+    constexpr int NumIters   = 256;
+
+    Signal           WorkerSignal;
+    Signal           DoneSignal;
+    std::atomic<int> NumDone{0};
+    std::atomic<int> Counter{0};
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumIters; ++i)
+            {
+                Counter.fetch_add(WorkerSignal.Wait(true, NumThreads));
+                if (NumDone.fetch_add(1) + 1 == NumThreads)
+                {
+                    NumDone.store(0);
+                    DoneSignal.Trigger();
+                }
+                // Wait until the main thread starts the next iteration so that
+                // no thread can go through the loop twice
+                while (Counter.load() < (i + 1) * NumThreads * 2)
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for (int i = 0; i < NumIters; ++i)
+    {
+        WorkerSignal.Trigger(true, 1);
+        DoneSignal.Wait(true, 1);
+        EXPECT_FALSE(WorkerSignal.IsTriggered());
+        EXPECT_EQ(Counter.load(), (i * 2 + 1) * NumThreads);
+        Counter.fetch_add(NumThreads);
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
+TEST(Common_LockHelper, Contention)
+{
+    constexpr int NumThreads = 4;
+    constexpr int NumIters   = 10000;
+
+    LockFlag Flag;
+    int      Counter = 0;
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&]() {
+            for (int i = 0; i < NumIters; ++i)
+            {
+                LockHelper Lock{Flag};
+                ++Counter;
+            }
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Counter, NumThreads * NumIters);
+}
+
+} // namespace
@@ -0,0 +1,169 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ColorConversion.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+Uint8 LinearToSRGB8Ref(double x)
+{
+    if (!(x > 0))
+        return 0;
+    if (x >= 1)
+        return 255;
+    const auto s = x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055;
+    return static_cast<Uint8>(std::floor(s * 255.0 + 0.5));
+}
+
+Uint8 SRGBToLinear8Ref(Uint8 c)
+{
+    const auto x = c / 255.0;
+    const auto l = x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4);
+    return static_cast<Uint8>(std::floor(l * 255.0 + 0.5));
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertSRGBToLinear)
+{
+    // Test all values with different offsets to exercise the unrolled loop and the tail
+    std::vector<Uint8> SRGB(256 + 3);
+    for (size_t i = 0; i < SRGB.size(); ++i)
+        SRGB[i] = static_cast<Uint8>(i);
+
+    std::vector<float> Linear(SRGB.size());
+    ConvertSRGBToLinear(SRGB.data(), Linear.data(), SRGB.size());
+    for (size_t i = 0; i < SRGB.size(); ++i)
+        EXPECT_EQ(Linear[i], SRGBToLinear(SRGB[i])) << i;
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertLinearToSRGB)
+{
+    std::vector<float> Linear;
+    // Sample all floats between 2^-16 and 1
+    for (Uint32 Bits = (127 - 16) << 23; Bits < 0x3F800000u; Bits += 61)
+    {
+        float f;
+        memcpy(&f, &Bits, sizeof(f));
+        Linear.push_back(f);
+    }
+    // Exact rounding thresholds and their neighbors
+    for (Uint32 c = 0; c < 255; ++c)
+    {
+        const auto s = (c + 0.5) / 255.0;
+        const auto t = static_cast<float>(s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4));
+        Linear.push_back(t);
+        Linear.push_back(std::nextafter(t, 0.f));
+        Linear.push_back(std::nextafter(t, 1.f));
+    }
+    // Out of range values
+    for (float f : {-1.f, -0.f, 0.f, 1e-30f, 1.f, 1.5f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()})
+        Linear.push_back(f);
+
+    std::vector<Uint8> SRGB(Linear.size());
+    ConvertLinearToSRGB(Linear.data(), SRGB.data(), Linear.size());
+    size_t NumErrors = 0;
+    for (size_t i = 0; i < Linear.size(); ++i)
+    {
+        if (SRGB[i] != LinearToSRGB8Ref(Linear[i]) && NumErrors++ < 10)
+            ADD_FAILURE() << "Incorrect conversion of " << Linear[i] << ": " << int{SRGB[i]} << " vs " << int{LinearToSRGB8Ref(Linear[i])};
+    }
+    EXPECT_EQ(NumErrors, size_t{0});
+
+    // NaNs are converted to 0
+    const float NaNs[] = {std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(), 0.5f, std::numeric_limits<float>::quiet_NaN(), 0.25f};
+    Uint8       NaNResults[5] = {};
+    ConvertLinearToSRGB(NaNs, NaNResults, 5);
+    EXPECT_EQ(NaNResults[0], 0);
+    EXPECT_EQ(NaNResults[1], 0);
+    EXPECT_EQ(NaNResults[2], LinearToSRGB8Ref(0.5));
+    EXPECT_EQ(NaNResults[3], 0);
+    EXPECT_EQ(NaNResults[4], LinearToSRGB8Ref(0.25));
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertLinearToSRGB_RoundTrip)
+{
+    // Decoding every 8-bit sRGB value and encoding it back must give the original value
+    std::vector<float> Linear(256);
+    for (Uint32 c = 0; c < 256; ++c)
+        Linear[c] = SRGBToLinear(static_cast<Uint8>(c));
+
+    std::vector<Uint8> SRGB(Linear.size());
+    ConvertLinearToSRGB(Linear.data(), SRGB.data(), Linear.size());
+    for (Uint32 c = 0; c < 256; ++c)
+        EXPECT_EQ(SRGB[c], c);
+
+    // Zero count is a no-op
+    Uint8 Untouched = 42;
+    ConvertLinearToSRGB(Linear.data(), &Untouched, 0);
+    EXPECT_EQ(Untouched, 42);
+}
+
+TEST(GraphicsAccessories_ColorConversion, ConvertRGBA8)
+{
+    std::vector<Uint8> Src(256 * 4);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        Src[i * 4 + 0] = static_cast<Uint8>(i);
+        Src[i * 4 + 1] = static_cast<Uint8>(255 - i);
+        Src[i * 4 + 2] = static_cast<Uint8>(i * 7);
+        Src[i * 4 + 3] = static_cast<Uint8>(i * 13);
+    }
+
+    std::vector<Uint8> Linear(Src.size());
+    ConvertRGBA8SRGBToLinear(Src.data(), Linear.data(), 256);
+    std::vector<Uint8> SRGB(Src.size());
+    ConvertRGBA8LinearToSRGB(Src.data(), SRGB.data(), 256);
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        if (i % 4 == 3)
+        {
+            EXPECT_EQ(Linear[i], Src[i]);
+            EXPECT_EQ(SRGB[i], Src[i]);
+        }
+        else
+        {
+            EXPECT_EQ(Linear[i], SRGBToLinear8Ref(Src[i]));
+            EXPECT_EQ(SRGB[i], LinearToSRGB8Ref(Src[i] / 255.0));
+        }
+    }
+
+    // In-place conversion
+    auto InPlace = Src;
+    ConvertRGBA8SRGBToLinear(InPlace.data(), InPlace.data(), 256);
+    EXPECT_EQ(InPlace, Linear);
+}
+
+} // namespace
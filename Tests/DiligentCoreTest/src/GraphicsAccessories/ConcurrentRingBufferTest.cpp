@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    {
+        ConcurrentRingBuffer RB(1024, Allocator);
+
+        EXPECT_EQ(RB.Allocate(120, 16), OffsetType{0});
+        EXPECT_EQ(RB.Allocate(10, 1), OffsetType{128});
+        EXPECT_EQ(RB.Allocate(10, 32), OffsetType{160});
+        EXPECT_EQ(RB.Allocate(65, 64), OffsetType{192});
+        //
+        //  t                           h
+        //  |                           |                      |
+        //  0         128    160       320                   1024
+        EXPECT_EQ(RB.GetUsedSize(), OffsetType{320});
+        RB.FinishCurrentFrame(1);
+
+        EXPECT_EQ(RB.Allocate(512, 1), OffsetType{320});
+        RB.FinishCurrentFrame(2);
+        //
+        //  t                          h1                h2,h
+        //  |                           |                  |   |
+        //  0                          320                832 1024
+        EXPECT_EQ(RB.Allocate(256, 1), InvalidOffset);
+
+        RB.ReleaseCompletedFrames(1);
+        //
+        //                              t                h2,h
+        //  |                           |                  |   |
+        //  0                          320                832 1024
+
+        // Does not fit at the end: allocate from the beginning of the buffer
+        EXPECT_EQ(RB.Allocate(256, 1), OffsetType{0});
+        //
+        //             h                t                 h2
+        //  |          |                |                  |   |
+        //  0         256              320                832 1024
+        EXPECT_EQ(RB.GetUsedSize(), OffsetType{512 + 192 + 256});
+
+        EXPECT_EQ(RB.Allocate(65, 1), InvalidOffset);
+        EXPECT_EQ(RB.Allocate(64, 1), OffsetType{256});
+        EXPECT_TRUE(RB.IsFull());
+        EXPECT_EQ(RB.Allocate(1, 1), InvalidOffset);
+        RB.FinishCurrentFrame(3);
+        RB.FinishCurrentFrame(4); // ignored
+
+        RB.ReleaseCompletedFrames(2);
+        EXPECT_EQ(RB.GetUsedSize(), OffsetType{192 + 320});
+        RB.ReleaseCompletedFrames(4);
+        EXPECT_TRUE(RB.IsEmpty());
+
+        // Size exceeds buffer size
+        EXPECT_EQ(RB.Allocate(1025, 1), InvalidOffset);
+    }
+
+    {
+        // Frame head array overflow
+        ConcurrentRingBuffer RB(1024, Allocator, 2);
+
+        EXPECT_EQ(RB.Allocate(256, 1), OffsetType{0});
+        RB.FinishCurrentFrame(1);
+        EXPECT_EQ(RB.Allocate(256, 1), OffsetType{256});
+        RB.FinishCurrentFrame(2);
+        EXPECT_EQ(RB.Allocate(256, 1), OffsetType{512});
+        // Merged with frame 2
+        RB.FinishCurrentFrame(3);
+
+        RB.ReleaseCompletedFrames(1);
+        EXPECT_EQ(RB.GetUsedSize(), OffsetType{512});
+        RB.ReleaseCompletedFrames(2);
+        EXPECT_EQ(RB.GetUsedSize(), OffsetType{512});
+        RB.ReleaseCompletedFrames(3);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, MultipleProducers)
+{
+    using OffsetType = ConcurrentRingBuffer::OffsetType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    const size_t NumThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    // Fill the buffer from multiple threads and check that allocations do not overlap
+    {
+        constexpr OffsetType BufferSize = 1 << 16;
+        ConcurrentRingBuffer RB(BufferSize, Allocator);
+
+        std::vector<std::vector<std::pair<OffsetType, OffsetType>>> Allocations(NumThreads);
+        {
+            std::vector<std::thread> Threads(NumThreads);
+            for (size_t t = 0; t < Threads.size(); ++t)
+            {
+                Threads[t] = std::thread{
+                    [&](size_t thread_id) //
+                    {
+                        OffsetType Size = 1 + thread_id % 7;
+                        for (;;)
+                        {
+                            const auto Offset = RB.Allocate(Size, 4);
+                            if (Offset == ConcurrentRingBuffer::InvalidOffset)
+                                break;
+                            EXPECT_EQ(Offset % 4, OffsetType{0});
+                            Allocations[thread_id].emplace_back(Offset, Size);
+                        }
+                    },
+                    t //
+                };
+            }
+
+            for (auto& Thread : Threads)
+                Thread.join();
+        }
+
+        std::vector<std::pair<OffsetType, OffsetType>> AllAllocations;
+        for (const auto& ThreadAllocations : Allocations)
+            AllAllocations.insert(AllAllocations.end(), ThreadAllocations.begin(), ThreadAllocations.end());
+        std::sort(AllAllocations.begin(), AllAllocations.end());
+
+        for (size_t i = 1; i < AllAllocations.size(); ++i)
+            EXPECT_LE(AllAllocations[i - 1].first + AllAllocations[i - 1].second, AllAllocations[i].first);
+        EXPECT_LE(AllAllocations.back().first + AllAllocations.back().second, BufferSize);
+        EXPECT_TRUE(RB.IsFull());
+
+        RB.FinishCurrentFrame(1);
+        RB.ReleaseCompletedFrames(1);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+
+    // Finish and release frames while other threads are allocating
+    {
+        ConcurrentRingBuffer RB(1 << 12, Allocator, 4);
+
+        std::atomic_bool Done{false};
+        std::atomic_int  NumAllocations{0};
+
+        std::vector<std::thread> Threads(NumThreads);
+        for (size_t t = 0; t < Threads.size(); ++t)
+        {
+            Threads[t] = std::thread{
+                [&](size_t thread_id) //
+                {
+                    while (!Done)
+                    {
+                        const auto Offset = RB.Allocate(16 + thread_id, 16);
+                        if (Offset != ConcurrentRingBuffer::InvalidOffset)
+                        {
+                            EXPECT_LE(Offset + 16 + thread_id, RB.GetMaxSize());
+                            ++NumAllocations;
+                        }
+                    }
+                },
+                t //
+            };
+        }
+
+        Uint64 FenceValue = 0;
+        while (NumAllocations < 10000)
+        {
+            RB.FinishCurrentFrame(++FenceValue);
+            // Emulate two frames in flight
+            if (FenceValue > 2)
+                RB.ReleaseCompletedFrames(FenceValue - 2);
+            std::this_thread::yield();
+        }
+        Done = true;
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        RB.FinishCurrentFrame(++FenceValue);
+        RB.ReleaseCompletedFrames(FenceValue);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+} // namespace
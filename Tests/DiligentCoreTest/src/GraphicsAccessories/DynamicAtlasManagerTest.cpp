@@ -29,6 +29,7 @@
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -461,4 +462,187 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
     }
 }
 
+using PACKING_STRATEGY = DynamicAtlasManager::PACKING_STRATEGY;
+
+const char* GetPackingStrategyName(PACKING_STRATEGY Strategy)
+{
+    switch (Strategy)
+    {
+        case PACKING_STRATEGY::TREE: return "Tree";
+        case PACKING_STRATEGY::SKYLINE: return "Skyline";
+        case PACKING_STRATEGY::MAX_RECTS: return "MaxRects";
+        default: return "Unknown";
+    }
+}
+
+// Tracks texels covered by allocated regions to detect overlaps
+class AtlasOccupancy
+{
+public:
+    AtlasOccupancy(Uint32 Width, Uint32 Height) :
+        m_Width{Width},
+        m_Height{Height},
+        m_Texels(size_t{Width} * size_t{Height})
+    {}
+
+    void Add(const Region& R)
+    {
+        ASSERT_LE(R.x + R.width, m_Width) << R;
+        ASSERT_LE(R.y + R.height, m_Height) << R;
+        for (Uint32 y = R.y; y < R.y + R.height; ++y)
+        {
+            for (Uint32 x = R.x; x < R.x + R.width; ++x)
+            {
+                ASSERT_FALSE(m_Texels[size_t{y} * m_Width + x]) << "Region " << R << " overlaps another region";
+                m_Texels[size_t{y} * m_Width + x] = true;
+            }
+        }
+    }
+
+    void Remove(const Region& R)
+    {
+        for (Uint32 y = R.y; y < R.y + R.height; ++y)
+        {
+            for (Uint32 x = R.x; x < R.x + R.width; ++x)
+                m_Texels[size_t{y} * m_Width + x] = false;
+        }
+    }
+
+private:
+    const Uint32      m_Width;
+    const Uint32      m_Height;
+    std::vector<bool> m_Texels;
+};
+
+class DynamicAtlasManagerStrategyTest : public testing::TestWithParam<PACKING_STRATEGY>
+{};
+
+TEST_P(DynamicAtlasManagerStrategyTest, Allocate)
+{
+    const auto Strategy = GetParam();
+    {
+        DynamicAtlasManager Mgr{16, 8, Strategy};
+        EXPECT_EQ(Mgr.GetPackingStrategy(), Strategy);
+
+        auto R = Mgr.Allocate(16, 8);
+        EXPECT_EQ(R, Region(0, 0, 16, 8));
+        EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+        Mgr.Free(std::move(R));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+
+    {
+        DynamicAtlasManager Mgr{16, 16, Strategy};
+
+        EXPECT_TRUE(Mgr.Allocate(17, 1).IsEmpty());
+        EXPECT_TRUE(Mgr.Allocate(1, 17).IsEmpty());
+
+        auto R0 = Mgr.Allocate(8, 16);
+        auto R1 = Mgr.Allocate(8, 16);
+        EXPECT_FALSE(R0.IsEmpty());
+        EXPECT_FALSE(R1.IsEmpty());
+        EXPECT_TRUE(Mgr.Allocate(1, 1).IsEmpty());
+
+        Mgr.Free(std::move(R0));
+        R0 = Mgr.Allocate(8, 16);
+        EXPECT_FALSE(R0.IsEmpty());
+
+        Mgr.Free(std::move(R0));
+        Mgr.Free(std::move(R1));
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+    }
+}
+
+TEST_P(DynamicAtlasManagerStrategyTest, AllocateRandom)
+{
+    constexpr Uint32 AtlasSize = 128;
+
+    DynamicAtlasManager Mgr{AtlasSize, AtlasSize, GetParam()};
+    AtlasOccupancy      Occupancy{AtlasSize, AtlasSize};
+
+    FastRandInt         rnd{0, 1, 16};
+    std::vector<Region> Regions;
+    for (Uint32 i = 0; i < 20; ++i)
+    {
+        for (Uint32 j = 0; j < 64; ++j)
+        {
+            auto R = Mgr.Allocate(rnd(), rnd());
+            if (!R.IsEmpty())
+            {
+                Occupancy.Add(R);
+                Regions.push_back(R);
+            }
+        }
+        ASSERT_FALSE(HasFatalFailure());
+
+        // Release every other region
+        for (size_t r = i % 2; r < Regions.size(); r += 2)
+        {
+            Occupancy.Remove(Regions[r]);
+            Mgr.Free(std::move(Regions[r]));
+        }
+        Regions.erase(std::remove_if(Regions.begin(), Regions.end(), [](const Region& R) { return R.IsEmpty(); }), Regions.end());
+    }
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+}
+
+// Fills the atlas with glyph-like regions of varying sizes, then repeatedly releases half
+// of the regions and fills the atlas again. Allocated regions must never overlap, and the
+// strategy must keep the atlas reasonably occupied.
+// Allocation timings of the same trace are measured by DynamicAtlasManagerBenchmark.
+TEST_P(DynamicAtlasManagerStrategyTest, PackingOccupancy)
+{
+    constexpr Uint32 AtlasSize      = 128;
+    constexpr Uint32 NumRounds      = 4;
+    constexpr Uint32 MaxNumFailures = 32;
+
+    DynamicAtlasManager Mgr{AtlasSize, AtlasSize, GetParam()};
+    AtlasOccupancy      Occupancy{AtlasSize, AtlasSize};
+
+    FastRandInt         rnd{1, 4, 24};
+    std::vector<Region> Regions;
+    Uint64              AllocatedArea = 0;
+    for (Uint32 round = 0; round < NumRounds; ++round)
+    {
+        // Fill the atlas until allocations keep failing
+        for (Uint32 NumFailures = 0; NumFailures < MaxNumFailures;)
+        {
+            auto R = Mgr.Allocate(rnd(), rnd());
+            if (R.IsEmpty())
+            {
+                ++NumFailures;
+                continue;
+            }
+            Occupancy.Add(R);
+            ASSERT_FALSE(HasFatalFailure());
+            AllocatedArea += Uint64{R.width} * Uint64{R.height};
+            Regions.push_back(R);
+        }
+        EXPECT_GT(static_cast<double>(AllocatedArea) / (AtlasSize * AtlasSize), 0.5) << "Round " << round;
+
+        for (size_t r = round % 2; r < Regions.size(); r += 2)
+        {
+            AllocatedArea -= Uint64{Regions[r].width} * Uint64{Regions[r].height};
+            Occupancy.Remove(Regions[r]);
+            Mgr.Free(std::move(Regions[r]));
+        }
+        Regions.erase(std::remove_if(Regions.begin(), Regions.end(), [](const Region& R) { return R.IsEmpty(); }), Regions.end());
+    }
+
+    for (auto& R : Regions)
+        Mgr.Free(std::move(R));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+}
+
+INSTANTIATE_TEST_SUITE_P(GraphicsAccessories_DynamicAtlasManager,
+                         DynamicAtlasManagerStrategyTest,
+                         testing::Values(PACKING_STRATEGY::TREE, PACKING_STRATEGY::SKYLINE, PACKING_STRATEGY::MAX_RECTS),
+                         [](const testing::TestParamInfo<PACKING_STRATEGY>& info) //
+                         {
+                             return std::string{GetPackingStrategyName(info.param)};
+                         });
+
 } // namespace
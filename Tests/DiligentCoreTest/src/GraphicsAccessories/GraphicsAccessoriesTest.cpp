@@ -697,7 +697,7 @@ TEST(GraphicsAccessories_GraphicsAccessories, PipelineTypeFromShaderStages)
 
 TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
 {
-    static_assert(PIPELINE_RESOURCE_FLAG_LAST == 0x08, "Please add a test for the new flag here");
+    static_assert(PIPELINE_RESOURCE_FLAG_LAST == 0x20, "Please add a test for the new flag here");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE, true).c_str(), "PIPELINE_RESOURCE_FLAG_NONE");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NONE).c_str(), "UNKNOWN");
@@ -705,10 +705,14 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS, true).c_str(), "PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(), "PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER, true).c_str(), "PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP, true).c_str(), "PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS, true).c_str(), "PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS).c_str(), "NO_DYNAMIC_BUFFERS");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER).c_str(), "COMBINED_SAMPLER");
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER).c_str(), "FORMATTED_BUFFER");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_BINDLESS_HEAP).c_str(), "BINDLESS_HEAP");
+    EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_INLINE_CONSTANTS).c_str(), "INLINE_CONSTANTS");
 
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS | PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER, true).c_str(),
                  "PIPELINE_RESOURCE_FLAG_NO_DYNAMIC_BUFFERS|PIPELINE_RESOURCE_FLAG_COMBINED_SAMPLER");
@@ -726,4 +730,36 @@ TEST(GraphicsAccessories_GraphicsAccessories, GetPipelineResourceFlagsString)
     EXPECT_STREQ(GetPipelineResourceFlagsString(PIPELINE_RESOURCE_FLAG_RUNTIME_ARRAY).c_str(), "RUNTIME_ARRAY");
 }
 
+TEST(GraphicsAccessories_GraphicsAccessories, GetBlockCopyCompatibleFormat)
+{
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC1_UNORM), TEX_FORMAT_RG32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC4_SNORM), TEX_FORMAT_RG32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC3_UNORM_SRGB), TEX_FORMAT_RGBA32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC5_UNORM), TEX_FORMAT_RGBA32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC6H_UF16), TEX_FORMAT_RGBA32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_BC7_UNORM), TEX_FORMAT_RGBA32_UINT);
+    EXPECT_EQ(GetBlockCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM), TEX_FORMAT_UNKNOWN);
+}
+
+TEST(GraphicsAccessories_GraphicsAccessories, IsCopyCompatibleFormat)
+{
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM));
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB));
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UINT));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_R32_FLOAT));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_R32_FLOAT, TEX_FORMAT_D32_FLOAT));
+
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC1_UNORM_SRGB));
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_BC7_TYPELESS, TEX_FORMAT_BC7_UNORM));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_BC2_UNORM, TEX_FORMAT_BC3_UNORM));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_BC5_SNORM, TEX_FORMAT_BC6H_TYPELESS));
+
+    // One texel of the uncompressed texture corresponds to one block
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_RG32_UINT, TEX_FORMAT_BC1_UNORM));
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_BC4_UNORM, TEX_FORMAT_RGBA16_UINT));
+    EXPECT_TRUE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA32_UINT, TEX_FORMAT_BC7_UNORM_SRGB));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_RG32_UINT, TEX_FORMAT_BC3_UNORM));
+    EXPECT_FALSE(IsCopyCompatibleFormat(TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BC1_UNORM));
+}
+
 } // namespace
@@ -26,11 +26,17 @@
  */
 
 #include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "Timer.hpp"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
 
-#include <vector>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -476,6 +482,7 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB)
     const Uint32 CoarseHeight = FineHeight / 2;
 
     std::vector<Uint8> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+    std::vector<Uint8> ApproxCoarseData(CoarseWidth * CoarseHeight * NumChannels);
     for (Uint32 y = 0; y < CoarseHeight; ++y)
     {
         for (Uint32 x = 0; x < CoarseWidth; ++x)
@@ -491,7 +498,19 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB)
                 fLinearAverage = std::min(std::max(fLinearAverage, 0.f), 255.f);
                 float fSRGB    = FastLinearToSRGB(fLinearAverage);
 
-                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] = static_cast<Uint8>(fSRGB * 255.f);
+                ApproxCoarseData[(x + y * CoarseWidth) * NumChannels + c] = static_cast<Uint8>(fSRGB * 255.f);
+
+                // Exact reference: the same linear average as ComputeMipLevel, converted back to sRGB in double precision
+                const float fExactLinearAverage =
+                    (SRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c]) +
+                     SRGBToLinear(FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c])) *
+                    0.25f;
+                const double dLinear = fExactLinearAverage;
+                const double dSRGB   = dLinear <= 0.0031308 ? dLinear * 12.92 : 1.055 * std::pow(dLinear, 1.0 / 2.4) - 0.055;
+
+                RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] = static_cast<Uint8>(std::floor(std::min(dSRGB, 1.0) * 255.0 + 0.5));
             }
         }
     }
@@ -499,6 +518,186 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB)
     std::vector<Uint8> CoarseData(RefCoarseData.size());
     ComputeMipLevel(FineWidth, FineHeight, TEX_FORMAT_RGBA8_UNORM_SRGB, FineData.data(), FineWidth * NumChannels, CoarseData.data(), CoarseWidth * NumChannels);
     EXPECT_TRUE(CoarseData == RefCoarseData);
+
+    // ComputeMipLevel is correctly rounded, while the fast approximations are off by several units near zero
+    for (size_t i = 0; i < CoarseData.size(); ++i)
+        EXPECT_NEAR(CoarseData[i], ApproxCoarseData[i], 6) << i;
+}
+
+TEST(GraphicsTools_CalculateMipLevel, FLOAT32_RGBA)
+{
+    for (Uint32 NumChannels = 1; NumChannels <= 4; NumChannels *= 2)
+    {
+        const Uint32 FineWidth  = 37;
+        const Uint32 FineHeight = 15;
+
+        std::vector<Float32> FineData(FineWidth * FineHeight * NumChannels);
+
+        FastRandFloat rnd(0, -1000.f, 1000.f);
+        for (auto& c : FineData)
+            c = rnd();
+
+        const Uint32 CoarseWidth  = FineWidth / 2;
+        const Uint32 CoarseHeight = FineHeight / 2;
+
+        std::vector<Float32> RefCoarseData(CoarseWidth * CoarseHeight * NumChannels);
+        for (Uint32 y = 0; y < CoarseHeight; ++y)
+        {
+            for (Uint32 x = 0; x < CoarseWidth; ++x)
+            {
+                for (Uint32 c = 0; c < NumChannels; ++c)
+                {
+                    RefCoarseData[(x + y * CoarseWidth) * NumChannels + c] =
+                        (FineData[((x * 2 + 0) + (y * 2 + 0) * FineWidth) * NumChannels + c] +
+                         FineData[((x * 2 + 1) + (y * 2 + 0) * FineWidth) * NumChannels + c] +
+                         FineData[((x * 2 + 0) + (y * 2 + 1) * FineWidth) * NumChannels + c] +
+                         FineData[((x * 2 + 1) + (y * 2 + 1) * FineWidth) * NumChannels + c]) *
+                        0.25f;
+                }
+            }
+        }
+
+        TEXTURE_FORMAT Format = TEX_FORMAT_UNKNOWN;
+        switch (NumChannels)
+        {
+            case 1: Format = TEX_FORMAT_R32_FLOAT; break;
+            case 2: Format = TEX_FORMAT_RG32_FLOAT; break;
+            case 4: Format = TEX_FORMAT_RGBA32_FLOAT; break;
+            default:
+                UNEXPECTED("Unexpected number of components");
+        }
+
+        std::vector<Float32> CoarseData(RefCoarseData.size());
+        ComputeMipLevel(FineWidth, FineHeight, Format, FineData.data(), FineWidth * NumChannels * 4, CoarseData.data(), CoarseWidth * NumChannels * 4);
+        EXPECT_TRUE(CoarseData == RefCoarseData);
+    }
+}
+
+class MipChain
+{
+public:
+    MipChain(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Format, IThreadPool* pThreadPool = nullptr)
+    {
+        const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+        const auto  NumMips    = ComputeMipLevelsCount(Width, Height);
+
+        m_Data.resize(NumMips);
+        m_pData.resize(NumMips);
+        m_Strides.resize(NumMips);
+        for (Uint32 mip = 0; mip < NumMips; ++mip)
+        {
+            const auto MipWidth  = std::max(Width >> mip, 1u);
+            const auto MipHeight = std::max(Height >> mip, 1u);
+
+            m_Strides[mip] = MipWidth * Uint32{FmtAttribs.GetElementSize()};
+            m_Data[mip].resize(size_t{m_Strides[mip]} * MipHeight);
+            m_pData[mip] = m_Data[mip].data();
+        }
+
+        FastRandInt rnd(0, 0, 255);
+        for (auto& c : m_Data[0])
+            c = static_cast<Uint8>(rnd());
+        if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT)
+        {
+            // Random bytes may form NaNs, which never compare equal
+            auto* pFloats = reinterpret_cast<Float32*>(m_Data[0].data());
+            for (size_t i = 0; i < m_Data[0].size() / 4; ++i)
+                pFloats[i] = static_cast<Float32>(rnd());
+        }
+
+        m_Attribs.Width        = Width;
+        m_Attribs.Height       = Height;
+        m_Attribs.Format       = Format;
+        m_Attribs.NumMipLevels = NumMips;
+        m_Attribs.ppMipData    = m_pData.data();
+        m_Attribs.pMipStrides  = m_Strides.data();
+        m_Attribs.pThreadPool  = pThreadPool;
+    }
+
+    void ComputeLevelByLevel()
+    {
+        for (Uint32 mip = 1; mip < m_Attribs.NumMipLevels; ++mip)
+        {
+            ComputeMipLevel(std::max(m_Attribs.Width >> (mip - 1), 1u), std::max(m_Attribs.Height >> (mip - 1), 1u), m_Attribs.Format,
+                            m_pData[mip - 1], m_Strides[mip - 1], m_pData[mip], m_Strides[mip]);
+        }
+    }
+
+    void ComputeChain()
+    {
+        ComputeMipChain(m_Attribs);
+    }
+
+    bool operator==(const MipChain& rhs) const
+    {
+        return m_Data == rhs.m_Data;
+    }
+
+private:
+    std::vector<std::vector<Uint8>> m_Data;
+    std::vector<void*>              m_pData;
+    std::vector<Uint32>             m_Strides;
+    ComputeMipChainAttribs          m_Attribs;
+};
+
+TEST(GraphicsTools_ComputeMipChain, MatchesComputeMipLevel)
+{
+    for (auto Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_R8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RG32_FLOAT, TEX_FORMAT_RGBA16_UNORM})
+    {
+        for (Uint32 NumThreads : {0u, 1u, 4u})
+        {
+            RefCntAutoPtr<IThreadPool> pThreadPool;
+            if (NumThreads != 0)
+            {
+                ThreadPoolCreateInfo PoolCI;
+                PoolCI.NumThreads = NumThreads;
+                CreateThreadPool(PoolCI, &pThreadPool);
+                ASSERT_NE(pThreadPool, nullptr);
+            }
+
+            MipChain Ref{1023, 517, Format};
+            Ref.ComputeLevelByLevel();
+
+            MipChain Chain{1023, 517, Format, pThreadPool};
+            Chain.ComputeChain();
+
+            EXPECT_TRUE(Chain == Ref) << GetTextureFormatAttribs(Format).Name << ", " << NumThreads << " threads";
+        }
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(GraphicsTools_ComputeMipChain, DISABLED_Performance)
+{
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    CreateThreadPool(ThreadPoolCreateInfo{}, &pThreadPool);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (auto Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA32_FLOAT})
+    {
+        MipChain Ref{4096, 4096, Format};
+        MipChain Chain{4096, 4096, Format, pThreadPool};
+
+        Timer  T;
+        double LevelByLevelTime = 0;
+        double ChainTime        = 0;
+
+        constexpr int NumIterations = 10;
+        for (int i = 0; i < NumIterations; ++i)
+        {
+            T.Restart();
+            Ref.ComputeLevelByLevel();
+            LevelByLevelTime += T.GetElapsedTime();
+
+            T.Restart();
+            Chain.ComputeChain();
+            ChainTime += T.GetElapsedTime();
+        }
+        EXPECT_TRUE(Chain == Ref);
+
+        LOG_INFO_MESSAGE(GetTextureFormatAttribs(Format).Name, " 4096x4096 full mip chain: ComputeMipLevel: ",
+                         LevelByLevelTime / NumIterations * 1000.0, " ms, ComputeMipChain: ", ChainTime / NumIterations * 1000.0, " ms");
+    }
 }
 
 } // namespace
@@ -0,0 +1,341 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "MeshletBuilder.hpp"
+#include "BasicMath.hpp"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestMesh
+{
+    std::vector<float3> Positions;
+    std::vector<Uint32> Indices;
+};
+
+// Grid in the XY plane whose triangles face +Z
+TestMesh CreateGrid(Uint32 NumQuadsX, Uint32 NumQuadsY)
+{
+    TestMesh Mesh;
+    for (Uint32 y = 0; y <= NumQuadsY; ++y)
+    {
+        for (Uint32 x = 0; x <= NumQuadsX; ++x)
+            Mesh.Positions.emplace_back(static_cast<float>(x), static_cast<float>(y), 0.f);
+    }
+
+    for (Uint32 y = 0; y < NumQuadsY; ++y)
+    {
+        for (Uint32 x = 0; x < NumQuadsX; ++x)
+        {
+            const Uint32 v0 = y * (NumQuadsX + 1) + x;
+            const Uint32 v1 = v0 + 1;
+            const Uint32 v2 = v0 + NumQuadsX + 1;
+            const Uint32 v3 = v2 + 1;
+            Mesh.Indices.insert(Mesh.Indices.end(), {v0, v1, v2, v2, v1, v3});
+        }
+    }
+    return Mesh;
+}
+
+void ShuffleTriangles(std::vector<Uint32>& Indices)
+{
+    std::vector<std::array<Uint32, 3>> Triangles(Indices.size() / 3);
+    for (size_t t = 0; t < Triangles.size(); ++t)
+        Triangles[t] = {Indices[t * 3 + 0], Indices[t * 3 + 1], Indices[t * 3 + 2]};
+
+    std::mt19937 Gen{42};
+    std::shuffle(Triangles.begin(), Triangles.end(), Gen);
+
+    for (size_t t = 0; t < Triangles.size(); ++t)
+        std::copy(Triangles[t].begin(), Triangles[t].end(), &Indices[t * 3]);
+}
+
+// Rotates the triangle so that the smallest index goes first, which preserves the winding
+std::array<Uint32, 3> CanonicalTriangle(Uint32 i0, Uint32 i1, Uint32 i2)
+{
+    if (i1 < i0 && i1 < i2)
+        return {i1, i2, i0};
+    if (i2 < i0 && i2 < i1)
+        return {i2, i0, i1};
+    return {i0, i1, i2};
+}
+
+std::vector<std::array<Uint32, 3>> GetSortedTriangles(const Uint32* pIndices, size_t NumIndices)
+{
+    std::vector<std::array<Uint32, 3>> Triangles;
+    for (size_t i = 0; i < NumIndices; i += 3)
+        Triangles.push_back(CanonicalTriangle(pIndices[i], pIndices[i + 1], pIndices[i + 2]));
+    std::sort(Triangles.begin(), Triangles.end());
+    return Triangles;
+}
+
+// Average number of vertex cache misses per triangle for a 32-entry LRU cache
+float ComputeACMR(const std::vector<Uint32>& Indices)
+{
+    std::vector<Uint32> Cache;
+    Uint32              NumMisses = 0;
+    for (auto Idx : Indices)
+    {
+        auto It = std::find(Cache.begin(), Cache.end(), Idx);
+        if (It != Cache.end())
+        {
+            Cache.erase(It);
+        }
+        else
+        {
+            ++NumMisses;
+            if (Cache.size() == 32)
+                Cache.pop_back();
+        }
+        Cache.insert(Cache.begin(), Idx);
+    }
+    return static_cast<float>(NumMisses) / static_cast<float>(Indices.size() / 3);
+}
+
+MeshletBuildAttribs GetBuildAttribs(const TestMesh& Mesh)
+{
+    MeshletBuildAttribs Attribs;
+    Attribs.pIndices    = Mesh.Indices.data();
+    Attribs.NumIndices  = static_cast<Uint32>(Mesh.Indices.size());
+    Attribs.pPositions  = Mesh.Positions.data();
+    Attribs.NumVertices = static_cast<Uint32>(Mesh.Positions.size());
+    return Attribs;
+}
+
+// Same test as IsMeshletVisible() in MeshletCulling.ash
+bool IsMeshletVisible(const MeshletCullingConstants& Constants, const MeshletBounds& Bounds)
+{
+    for (const auto& Plane : Constants.FrustumPlanes)
+    {
+        if (dot(Bounds.Center, float3{Plane.x, Plane.y, Plane.z}) + Plane.w < -Bounds.Radius)
+            return false;
+    }
+    return dot(normalize(Bounds.ConeApex - Constants.CameraPos), Bounds.ConeAxis) < Bounds.ConeCutoff;
+}
+
+void VerifyMeshlets(const TestMesh& Mesh, const MeshletBuildAttribs& Attribs, const MeshletData& Data)
+{
+    ASSERT_EQ(Data.Meshlets.size(), Data.Bounds.size());
+    ASSERT_EQ(Data.PrimitiveIndices.size(), Mesh.Indices.size() / 3);
+
+    std::vector<Uint32> Triangles;
+    for (size_t m = 0; m < Data.Meshlets.size(); ++m)
+    {
+        const auto& M = Data.Meshlets[m];
+        EXPECT_GT(M.TriangleCount, 0u);
+        EXPECT_LE(M.VertexCount, Attribs.MaxVertices);
+        EXPECT_LE(M.TriangleCount, Attribs.MaxTriangles);
+        ASSERT_LE(M.VertexOffset + M.VertexCount, Data.VertexIndices.size());
+        ASSERT_LE(M.TriangleOffset + M.TriangleCount, Data.PrimitiveIndices.size());
+
+        const auto* pVertices = &Data.VertexIndices[M.VertexOffset];
+
+        std::vector<Uint32> UniqueVertices{pVertices, pVertices + M.VertexCount};
+        std::sort(UniqueVertices.begin(), UniqueVertices.end());
+        EXPECT_EQ(std::unique(UniqueVertices.begin(), UniqueVertices.end()), UniqueVertices.end()) << "Meshlet " << m << " references the same vertex twice";
+
+        const auto& Bounds = Data.Bounds[m];
+        for (Uint32 v = 0; v < M.VertexCount; ++v)
+            EXPECT_LE(length(Mesh.Positions[pVertices[v]] - Bounds.Center), Bounds.Radius * 1.0001f + 1e-5f);
+
+        for (Uint32 t = 0; t < M.TriangleCount; ++t)
+        {
+            const auto Packed = Data.PrimitiveIndices[M.TriangleOffset + t];
+            for (Uint32 k = 0; k < 3; ++k)
+            {
+                const auto LocalIdx = (Packed >> (k * 8u)) & 0xFFu;
+                ASSERT_LT(LocalIdx, M.VertexCount);
+                Triangles.push_back(pVertices[LocalIdx]);
+            }
+        }
+    }
+
+    // Every triangle must be in exactly one meshlet with the original winding
+    EXPECT_EQ(GetSortedTriangles(Triangles.data(), Triangles.size()), GetSortedTriangles(Mesh.Indices.data(), Mesh.Indices.size()));
+}
+
+TEST(GraphicsTools_MeshletBuilder, OptimizeVertexCache)
+{
+    auto Mesh = CreateGrid(64, 64);
+    ShuffleTriangles(Mesh.Indices);
+
+    std::vector<Uint32> Optimized(Mesh.Indices.size());
+    OptimizeVertexCache(Mesh.Indices.data(), static_cast<Uint32>(Mesh.Indices.size()), static_cast<Uint32>(Mesh.Positions.size()), Optimized.data());
+
+    EXPECT_EQ(GetSortedTriangles(Optimized.data(), Optimized.size()), GetSortedTriangles(Mesh.Indices.data(), Mesh.Indices.size()));
+
+    // Every vertex of a regular grid is shared by six triangles, so the best possible ratio is about 0.5
+    const auto SrcACMR = ComputeACMR(Mesh.Indices);
+    const auto DstACMR = ComputeACMR(Optimized);
+    EXPECT_GT(SrcACMR, 2.f);
+    EXPECT_LT(DstACMR, 0.8f);
+}
+
+TEST(GraphicsTools_MeshletBuilder, BuildMeshlets)
+{
+    auto Mesh = CreateGrid(97, 89);
+    ShuffleTriangles(Mesh.Indices);
+
+    for (bool OptimizeCache : {false, true})
+    {
+        for (auto Limits : {std::array<Uint32, 2>{64, 124}, std::array<Uint32, 2>{256, 256}, std::array<Uint32, 2>{3, 1}, std::array<Uint32, 2>{128, 32}})
+        {
+            auto Attribs                = GetBuildAttribs(Mesh);
+            Attribs.MaxVertices         = Limits[0];
+            Attribs.MaxTriangles        = Limits[1];
+            Attribs.OptimizeVertexCache = OptimizeCache;
+
+            MeshletData Data;
+            ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+            VerifyMeshlets(Mesh, Attribs, Data);
+        }
+    }
+
+    // Vertex cache optimization keeps the triangles of a meshlet together,
+    // so the meshlets must reuse most of their vertices
+    auto Attribs = GetBuildAttribs(Mesh);
+
+    MeshletData Data;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+    const auto AvgTriangles = static_cast<float>(Data.PrimitiveIndices.size()) / static_cast<float>(Data.Meshlets.size());
+    EXPECT_GT(AvgTriangles, 60.f);
+}
+
+TEST(GraphicsTools_MeshletBuilder, StridedPositions)
+{
+    const auto Grid = CreateGrid(16, 16);
+
+    std::vector<float4> Positions;
+    for (const auto& Pos : Grid.Positions)
+        Positions.emplace_back(Pos, 1.f);
+
+    auto Attribs           = GetBuildAttribs(Grid);
+    Attribs.pPositions     = Positions.data();
+    Attribs.PositionStride = sizeof(float4);
+
+    MeshletData Data;
+    ASSERT_TRUE(BuildMeshlets(Attribs, Data));
+    VerifyMeshlets(Grid, Attribs, Data);
+}
+
+TEST(GraphicsTools_MeshletBuilder, Culling)
+{
+    const auto Grid = CreateGrid(64, 64);
+
+    MeshletData Data;
+    ASSERT_TRUE(BuildMeshlets(GetBuildAttribs(Grid), Data));
+    ASSERT_FALSE(Data.Meshlets.empty());
+
+    const auto NumMeshlets = static_cast<Uint32>(Data.Meshlets.size());
+    const auto Proj        = float4x4::Projection(PI_F / 2.f, 1.f, 0.1f, 1000.f, false);
+
+    // The grid faces +Z, so the camera above the grid sees the front faces of all meshlets
+    {
+        const float3 CameraPos{32, 32, 100};
+        const auto   View = float4x4::Translation(-CameraPos) * float4x4::RotationX(PI_F);
+
+        MeshletCullingConstants Constants;
+        ComputeMeshletCullingConstants(View * Proj, CameraPos, NumMeshlets, false, Constants);
+        EXPECT_EQ(Constants.NumMeshlets, NumMeshlets);
+        for (const auto& Plane : Constants.FrustumPlanes)
+            EXPECT_NEAR(length(float3{Plane.x, Plane.y, Plane.z}), 1.f, 1e-5f);
+
+        for (const auto& Bounds : Data.Bounds)
+        {
+            EXPECT_LT(Bounds.ConeCutoff, 0.01f);
+            EXPECT_TRUE(IsMeshletVisible(Constants, Bounds));
+        }
+    }
+
+    // The camera below the grid only sees the back faces
+    {
+        const float3 CameraPos{32, 32, -100};
+        const auto   View = float4x4::Translation(-CameraPos);
+
+        MeshletCullingConstants Constants;
+        ComputeMeshletCullingConstants(View * Proj, CameraPos, NumMeshlets, false, Constants);
+        for (const auto& Bounds : Data.Bounds)
+            EXPECT_FALSE(IsMeshletVisible(Constants, Bounds));
+    }
+
+    // The camera above the grid looks away from it
+    {
+        const float3 CameraPos{32, 32, 100};
+        const auto   View = float4x4::Translation(-CameraPos);
+
+        MeshletCullingConstants Constants;
+        ComputeMeshletCullingConstants(View * Proj, CameraPos, NumMeshlets, false, Constants);
+        for (const auto& Bounds : Data.Bounds)
+            EXPECT_FALSE(IsMeshletVisible(Constants, Bounds));
+    }
+}
+
+TEST(GraphicsTools_MeshletBuilder, ThreadPool)
+{
+    // Large enough to be split into several chunks
+    auto Mesh = CreateGrid(256, 200);
+    ShuffleTriangles(Mesh.Indices);
+
+    const auto Attribs = GetBuildAttribs(Mesh);
+
+    MeshletData RefData;
+    ASSERT_TRUE(BuildMeshlets(Attribs, RefData));
+    VerifyMeshlets(Mesh, Attribs, RefData);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    CreateThreadPool(ThreadPoolCreateInfo{4}, &pThreadPool);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    auto MTAttribs        = Attribs;
+    MTAttribs.pThreadPool = pThreadPool;
+
+    MeshletData Data;
+    ASSERT_TRUE(BuildMeshlets(MTAttribs, Data));
+    ASSERT_EQ(Data.Meshlets.size(), RefData.Meshlets.size());
+    for (size_t m = 0; m < Data.Meshlets.size(); ++m)
+    {
+        EXPECT_EQ(Data.Meshlets[m].VertexOffset, RefData.Meshlets[m].VertexOffset);
+        EXPECT_EQ(Data.Meshlets[m].TriangleOffset, RefData.Meshlets[m].TriangleOffset);
+        EXPECT_EQ(Data.Meshlets[m].VertexCount, RefData.Meshlets[m].VertexCount);
+        EXPECT_EQ(Data.Meshlets[m].TriangleCount, RefData.Meshlets[m].TriangleCount);
+    }
+    EXPECT_EQ(Data.VertexIndices, RefData.VertexIndices);
+    EXPECT_EQ(Data.PrimitiveIndices, RefData.PrimitiveIndices);
+}
+
+} // namespace
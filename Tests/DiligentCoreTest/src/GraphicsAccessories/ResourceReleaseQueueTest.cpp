@@ -26,6 +26,10 @@
  */
 
 #include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <functional>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -90,9 +94,9 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
         std::unique_ptr<ResourceB> res1(new ResourceB);
         std::unique_ptr<ResourceC> res2(new ResourceC);
 
-        auto Wrapper0 = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(std::move(res0), 3);
-        auto Wrapper1 = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(std::move(res1), 3);
-        auto Wrapper2 = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(std::move(res2), 1);
+        auto Wrapper0 = Queue0.CreateWrapper(std::move(res0), 3);
+        auto Wrapper1 = Queue0.CreateWrapper(std::move(res1), 3);
+        auto Wrapper2 = Queue0.CreateWrapper(std::move(res2), 1);
 
         Queue0.SafeReleaseResource(Wrapper0, 0);
         Queue0.SafeReleaseResource(Wrapper1, 0);
@@ -112,13 +116,13 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
 
         std::unique_ptr<ResourceC> res3(new ResourceC);
 
-        auto Wrapper3 = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(std::move(res3), 2);
+        auto Wrapper3 = Queue0.CreateWrapper(std::move(res3), 2);
         Queue0.DiscardResource(Wrapper3, 1);
         Queue1.DiscardResource(std::move(Wrapper3), 1);
 
         std::unique_ptr<ResourceA> res4(new ResourceA);
 
-        auto Wrapper4 = ResourceReleaseQueue<DynamicStaleResourceWrapper>::CreateWrapper(std::move(res4), 1);
+        auto Wrapper4 = Queue0.CreateWrapper(std::move(res4), 1);
         Queue2.DiscardResource(Wrapper4, 1);
         Wrapper4.GiveUpOwnership();
 
@@ -128,4 +132,175 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+TEST(GraphicsAccessories_ResourceReleaseQueue, MultiThreaded)
+{
+    struct Resource
+    {
+        explicit Resource(std::atomic<int>& _Counter) :
+            Counter{_Counter}
+        {
+            Counter.fetch_add(1);
+        }
+        ~Resource()
+        {
+            Counter.fetch_sub(1);
+        }
+        std::atomic<int>& Counter;
+    };
+
+    std::atomic<int> NumAlive{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    const auto       NumThreads            = std::max(std::thread::hardware_concurrency(), 4u);
+    constexpr Uint32 NumResourcesPerThread = 5000;
+
+    std::vector<std::thread> Threads;
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&Queue, &NumAlive, t]() {
+                for (Uint32 i = 0; i < NumResourcesPerThread; ++i)
+                {
+                    std::unique_ptr<Resource> pRes{new Resource{NumAlive}};
+                    if ((i + t) % 2 == 0)
+                        Queue.SafeReleaseResource(std::move(pRes), 1);
+                    else
+                        Queue.DiscardResource(std::move(pRes), 1);
+                }
+            });
+    }
+
+    // Purge concurrently with the producer threads
+    for (Uint32 i = 0; i < 100; ++i)
+    {
+        Queue.DiscardStaleResources(0, 1);
+        Queue.Purge(0);
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Queue.GetStaleResourceCount() + Queue.GetPendingReleaseResourceCount(), size_t{NumThreads} * NumResourcesPerThread);
+    EXPECT_EQ(static_cast<size_t>(NumAlive.load()), size_t{NumThreads} * NumResourcesPerThread);
+
+    // Resources released with command list number 1 must not be moved to the release queue
+    Queue.DiscardStaleResources(0, 1);
+    Queue.Purge(1);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+    EXPECT_EQ(static_cast<size_t>(NumAlive.load()), Queue.GetStaleResourceCount());
+
+    Queue.DiscardStaleResources(1, 2);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), size_t{0});
+    Queue.Purge(1);
+    EXPECT_NE(NumAlive.load(), 0);
+    Queue.Purge(2);
+    EXPECT_EQ(NumAlive.load(), 0);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PurgeWithExecutor)
+{
+    struct Resource
+    {
+        explicit Resource(int& _Counter) :
+            Counter{_Counter}
+        {
+            ++Counter;
+        }
+        ~Resource()
+        {
+            --Counter;
+        }
+        int& Counter;
+    };
+
+    int NumAlive = 0;
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+    for (Uint64 i = 0; i < 10; ++i)
+        Queue.DiscardResource(std::unique_ptr<Resource>{new Resource{NumAlive}}, i);
+    EXPECT_EQ(NumAlive, 10);
+
+    std::vector<std::function<void()>> Tasks;
+
+    auto Executor = [&Tasks](std::function<void()>&& Task) {
+        Tasks.emplace_back(std::move(Task));
+    };
+
+    Queue.Purge(4, Executor);
+    ASSERT_EQ(Tasks.size(), size_t{1});
+    // Resources must not be destroyed until the task is executed
+    EXPECT_EQ(NumAlive, 10);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{10});
+
+    Tasks[0]();
+    EXPECT_EQ(NumAlive, 5);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{5});
+
+    // Nothing to release - the executor must not be called
+    Queue.Purge(4, Executor);
+    EXPECT_EQ(Tasks.size(), size_t{1});
+
+    Queue.Purge(9, Executor);
+    ASSERT_EQ(Tasks.size(), size_t{2});
+    Tasks[1]();
+    EXPECT_EQ(NumAlive, 0);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), size_t{0});
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, WrapperMemory)
+{
+    class CountingAllocator final : public IMemoryAllocator
+    {
+    public:
+        virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+        {
+            ++NumAllocations;
+            return DefaultRawMemoryAllocator::GetAllocator().Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+        }
+
+        virtual void Free(void* Ptr) override final
+        {
+            if (Ptr != nullptr)
+                --NumAllocations;
+            DefaultRawMemoryAllocator::GetAllocator().Free(Ptr);
+        }
+
+        int NumAllocations = 0;
+    };
+
+    // Larger than the largest size class of the stale resource pool
+    struct LargeResource
+    {
+        Uint8 Data[1024] = {};
+    };
+
+    CountingAllocator Allocator;
+    {
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue0{Allocator};
+        ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue1{Allocator};
+
+        Queue0.SafeReleaseResource(std::unique_ptr<int>{new int{1}}, 0);
+        Queue0.SafeReleaseResource(LargeResource{}, 0);
+
+        auto Wrapper = Queue0.CreateWrapper(LargeResource{}, 2);
+        Queue0.SafeReleaseResource(Wrapper, 0);
+        Queue1.SafeReleaseResource(Wrapper, 0);
+        Wrapper.GiveUpOwnership();
+
+        // Stale resources are allocated from the queue allocator
+        EXPECT_GT(Allocator.NumAllocations, 0);
+
+        Queue0.DiscardStaleResources(0, 1);
+        Queue1.DiscardStaleResources(0, 1);
+        Queue0.Purge(1);
+        Queue1.Purge(1);
+        EXPECT_EQ(Queue0.GetPendingReleaseResourceCount(), size_t{0});
+        EXPECT_EQ(Queue1.GetPendingReleaseResourceCount(), size_t{0});
+    }
+    // All memory is returned to the allocator when the queues are destroyed
+    EXPECT_EQ(Allocator.NumAllocations, 0);
+}
+
 } // namespace
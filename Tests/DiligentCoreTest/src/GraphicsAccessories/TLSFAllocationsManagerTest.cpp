@@ -0,0 +1,302 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include "TLSFAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "PlatformDefinitions.h"
+#include "Errors.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, AllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    {
+        TLSFAllocationsManager ListMgr(128, Allocator);
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+        auto a1 = ListMgr.Allocate(17, 4);
+        EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+        EXPECT_EQ(a1.Size, OffsetType{20});
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+        auto a2 = ListMgr.Allocate(17, 8);
+        EXPECT_EQ(a2.UnalignedOffset, OffsetType{20});
+        EXPECT_EQ(a2.Size, OffsetType{28});
+
+        auto a3 = ListMgr.Allocate(8, 1);
+        EXPECT_EQ(a3.UnalignedOffset, OffsetType{48});
+        EXPECT_EQ(a3.Size, OffsetType{8});
+
+        auto a4 = ListMgr.Allocate(11, 8);
+        EXPECT_EQ(a4.UnalignedOffset, OffsetType{56});
+        EXPECT_EQ(a4.Size, OffsetType{16});
+
+        auto a5 = ListMgr.Allocate(64, 1);
+        EXPECT_FALSE(a5.IsValid());
+        EXPECT_EQ(a5.Size, OffsetType{0});
+
+        a5 = ListMgr.Allocate(56, 1);
+        EXPECT_EQ(a5.UnalignedOffset, OffsetType{72});
+        EXPECT_EQ(a5.Size, OffsetType{56});
+        EXPECT_TRUE(ListMgr.IsFull());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{0});
+
+        ListMgr.Free(std::move(a2));
+        ListMgr.Free(std::move(a4));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+        EXPECT_EQ(ListMgr.GetFreeSize(), OffsetType{44});
+
+        // Merge with the previous and the next blocks
+        ListMgr.Free(std::move(a3));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(ListMgr.GetFreeSize(), OffsetType{52});
+
+        auto a6 = ListMgr.Allocate(52, 4);
+        EXPECT_EQ(a6.UnalignedOffset, OffsetType{20});
+        EXPECT_EQ(a6.Size, OffsetType{52});
+
+        ListMgr.Free(std::move(a1));
+        ListMgr.Free(std::move(a5));
+        ListMgr.Free(std::move(a6));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    }
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FreeOrder)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    {
+        const auto NumAllocs = 6;
+        int        NumPerms  = 0;
+        size_t     ReleaseOrder[NumAllocs];
+        for (size_t a = 0; a < NumAllocs; ++a)
+            ReleaseOrder[a] = a;
+        do
+        {
+            ++NumPerms;
+            TLSFAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+
+            TLSFAllocationsManager::Allocation allocs[NumAllocs];
+            for (size_t a = 0; a < NumAllocs; ++a)
+            {
+                allocs[a] = ListMgr.Allocate(4, 1);
+                EXPECT_EQ(allocs[a].UnalignedOffset, a * 4);
+                EXPECT_EQ(allocs[a].Size, OffsetType{4});
+            }
+            for (size_t a = 0; a < NumAllocs; ++a)
+            {
+                ListMgr.Free(std::move(allocs[ReleaseOrder[a]]));
+            }
+            EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
+        EXPECT_EQ(NumPerms, 720);
+    }
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, Extend)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    TLSFAllocationsManager ListMgr(64, Allocator);
+
+    auto a1 = ListMgr.Allocate(64, 1);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    ListMgr.Extend(32);
+    EXPECT_EQ(ListMgr.GetMaxSize(), OffsetType{96});
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+    // Extend the last free block
+    ListMgr.Extend(32);
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+    auto a2 = ListMgr.Allocate(64, 1);
+    EXPECT_EQ(a2.UnalignedOffset, OffsetType{64});
+    EXPECT_EQ(a2.Size, OffsetType{64});
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    ListMgr.Free(std::move(a1));
+    ListMgr.Free(std::move(a2));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, LargeAlignment)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = TLSFAllocationsManager::OffsetType;
+
+    TLSFAllocationsManager ListMgr(1 << 20, Allocator);
+
+    auto a1 = ListMgr.Allocate(3, 1);
+    auto a2 = ListMgr.Allocate(100, 256);
+    ASSERT_TRUE(a2.IsValid());
+    EXPECT_EQ(AlignUp(a2.UnalignedOffset, OffsetType{256}) + 100 <= a2.UnalignedOffset + a2.Size, true);
+
+    auto a3 = ListMgr.Allocate(1000, 4096);
+    ASSERT_TRUE(a3.IsValid());
+    EXPECT_EQ(AlignUp(a3.UnalignedOffset, OffsetType{4096}) + 1000 <= a3.UnalignedOffset + a3.Size, true);
+
+    ListMgr.Free(std::move(a2));
+    ListMgr.Free(std::move(a1));
+    ListMgr.Free(std::move(a3));
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+}
+
+
+struct TraceOp
+{
+    // Allocation size, or zero if this is a free operation
+    size_t Size = 0;
+
+    // Allocation alignment, or index of the allocation to release
+    size_t AlignmentOrIndex = 0;
+};
+
+// Generates a fragmentation-heavy trace: allocations of widely varying sizes
+// and alignments are released in random order while new ones keep coming.
+std::vector<TraceOp> GenerateFragmentationTrace(size_t NumAllocations)
+{
+    Uint32 Seed   = 19;
+    auto   Random = [&Seed]() {
+        Seed = Seed * 1664525u + 1013904223u;
+        return Seed >> 8;
+    };
+
+    std::vector<TraceOp> Trace;
+    Trace.reserve(NumAllocations * 2);
+
+    std::vector<size_t> LiveAllocs;
+    for (size_t i = 0; i < NumAllocations;)
+    {
+        if (!LiveAllocs.empty() && Random() % 100 < 45)
+        {
+            const auto Idx = Random() % LiveAllocs.size();
+            Trace.push_back({0, LiveAllocs[Idx]});
+            LiveAllocs[Idx] = LiveAllocs.back();
+            LiveAllocs.pop_back();
+        }
+        else
+        {
+            // Mostly small allocations with a tail of large ones
+            const auto   R    = Random() % 100;
+            const size_t Size = R < 70 ? 1 + Random() % 256 : (R < 95 ? 256 + Random() % 4096 : 4096 + Random() % 65536);
+            const size_t Alignment = size_t{1} << (Random() % 9);
+
+            LiveAllocs.push_back(Trace.size());
+            Trace.push_back({Size, Alignment});
+            ++i;
+        }
+    }
+
+    for (auto Idx : LiveAllocs)
+        Trace.push_back({0, Idx});
+
+    return Trace;
+}
+
+template <typename AllocationsManagerType>
+void ValidateTrace(const std::vector<TraceOp>& Trace, size_t MaxSize)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    AllocationsManagerType Mgr{MaxSize, Allocator};
+
+    std::vector<typename AllocationsManagerType::Allocation> Allocs(Trace.size());
+
+    // Live allocations sorted by offset
+    std::map<size_t, size_t> LiveRanges;
+    for (size_t i = 0; i < Trace.size(); ++i)
+    {
+        const auto& Op = Trace[i];
+        if (Op.Size != 0)
+        {
+            auto& Alloc = Allocs[i];
+            Alloc       = Mgr.Allocate(Op.Size, Op.AlignmentOrIndex);
+            if (!Alloc.IsValid())
+                continue;
+
+            ASSERT_GE(Alloc.Size, Op.Size);
+            ASSERT_LE(AlignUp(Alloc.UnalignedOffset, Op.AlignmentOrIndex) + Op.Size, Alloc.UnalignedOffset + Alloc.Size);
+            ASSERT_LE(Alloc.UnalignedOffset + Alloc.Size, MaxSize);
+
+            auto It = LiveRanges.emplace(Alloc.UnalignedOffset, Alloc.Size).first;
+            if (It != LiveRanges.begin())
+            {
+                auto PrevIt = std::prev(It);
+                ASSERT_LE(PrevIt->first + PrevIt->second, It->first) << "Overlapping allocations";
+            }
+            auto NextIt = std::next(It);
+            if (NextIt != LiveRanges.end())
+            {
+                ASSERT_LE(It->first + It->second, NextIt->first) << "Overlapping allocations";
+            }
+        }
+        else
+        {
+            auto& Alloc = Allocs[Op.AlignmentOrIndex];
+            if (!Alloc.IsValid())
+                continue;
+            LiveRanges.erase(Alloc.UnalignedOffset);
+            Mgr.Free(std::move(Alloc));
+        }
+    }
+
+    EXPECT_TRUE(LiveRanges.empty());
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+}
+
+TEST(GraphicsAccessories_TLSFAllocationsManager, FragmentationTrace)
+{
+    constexpr size_t MaxSize = size_t{16} << 20;
+
+    const auto Trace = GenerateFragmentationTrace(5000);
+
+    ValidateTrace<VariableSizeAllocationsManager>(Trace, MaxSize);
+    ValidateTrace<TLSFAllocationsManager>(Trace, MaxSize);
+}
+
+} // namespace
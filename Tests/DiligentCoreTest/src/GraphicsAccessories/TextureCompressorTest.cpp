@@ -0,0 +1,416 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "TextureCompressor.hpp"
+#include "GraphicsAccessories.hpp"
+#include "BasicMath.hpp"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Texel = std::array<Uint8, 4>;
+
+void DecodeBC1ColorBlock(const Uint8* pBlock, bool AllowThreeColorMode, Texel (&Texels)[16])
+{
+    const Uint32 c[2] = {Uint32{pBlock[0]} | (Uint32{pBlock[1]} << 8u), Uint32{pBlock[2]} | (Uint32{pBlock[3]} << 8u)};
+
+    int Palette[4][4] = {};
+    for (Uint32 e = 0; e < 2; ++e)
+    {
+        const auto r  = (c[e] >> 11u) & 31u;
+        const auto g  = (c[e] >> 5u) & 63u;
+        const auto b  = c[e] & 31u;
+        Palette[e][0] = (r << 3u) | (r >> 2u);
+        Palette[e][1] = (g << 2u) | (g >> 4u);
+        Palette[e][2] = (b << 3u) | (b >> 2u);
+        Palette[e][3] = 255;
+    }
+    const bool ThreeColorMode = AllowThreeColorMode && c[0] <= c[1];
+    for (Uint32 ch = 0; ch < 3; ++ch)
+    {
+        if (ThreeColorMode)
+        {
+            Palette[2][ch] = (Palette[0][ch] + Palette[1][ch]) / 2;
+            Palette[3][ch] = 0;
+        }
+        else
+        {
+            Palette[2][ch] = (2 * Palette[0][ch] + Palette[1][ch]) / 3;
+            Palette[3][ch] = (Palette[0][ch] + 2 * Palette[1][ch]) / 3;
+        }
+    }
+    Palette[2][3] = 255;
+    Palette[3][3] = ThreeColorMode ? 0 : 255;
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto Idx = (pBlock[4 + i / 4] >> ((i % 4) * 2)) & 3u;
+        for (Uint32 ch = 0; ch < 4; ++ch)
+            Texels[i][ch] = static_cast<Uint8>(Palette[Idx][ch]);
+    }
+}
+
+void DecodeBC4Block(const Uint8* pBlock, Uint32 Channel, Texel (&Texels)[16])
+{
+    const int a0 = pBlock[0];
+    const int a1 = pBlock[1];
+
+    int Palette[8] = {a0, a1};
+    if (a0 > a1)
+    {
+        for (int i = 2; i < 8; ++i)
+            Palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+            Palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        Palette[6] = 0;
+        Palette[7] = 255;
+    }
+
+    Uint64 Bits = 0;
+    for (Uint32 b = 0; b < 6; ++b)
+        Bits |= Uint64{pBlock[2 + b]} << (b * 8);
+    for (Uint32 i = 0; i < 16; ++i)
+        Texels[i][Channel] = static_cast<Uint8>(Palette[(Bits >> (i * 3)) & 7u]);
+}
+
+Uint32 ReadBits(const Uint8* pBlock, Uint32& Pos, Uint32 NumBits)
+{
+    Uint32 Value = 0;
+    for (Uint32 b = 0; b < NumBits; ++b, ++Pos)
+        Value |= ((pBlock[Pos / 8] >> (Pos % 8)) & 1u) << b;
+    return Value;
+}
+
+void DecodeBC7Block(const Uint8* pBlock, Texel (&Texels)[16])
+{
+    static constexpr Uint32 Weights[] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    Uint32 Pos = 0;
+    ASSERT_EQ(ReadBits(pBlock, Pos, 7), 1u << 6u) << "Only mode 6 is expected";
+
+    Uint32 E[2][4];
+    for (Uint32 ch = 0; ch < 4; ++ch)
+    {
+        E[0][ch] = ReadBits(pBlock, Pos, 7) << 1u;
+        E[1][ch] = ReadBits(pBlock, Pos, 7) << 1u;
+    }
+    const auto p0 = ReadBits(pBlock, Pos, 1);
+    const auto p1 = ReadBits(pBlock, Pos, 1);
+    for (Uint32 ch = 0; ch < 4; ++ch)
+    {
+        E[0][ch] |= p0;
+        E[1][ch] |= p1;
+    }
+
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        const auto w = Weights[ReadBits(pBlock, Pos, i == 0 ? 3 : 4)];
+        for (Uint32 ch = 0; ch < 4; ++ch)
+            Texels[i][ch] = static_cast<Uint8>(((64 - w) * E[0][ch] + w * E[1][ch] + 32) >> 6);
+    }
+}
+
+std::vector<Texel> DecodeTexture(TEXTURE_FORMAT Format, const std::vector<Uint8>& Data, Uint32 Width, Uint32 Height)
+{
+    const auto& FmtAttribs = GetTextureFormatAttribs(Format);
+    const auto  BlockSize  = FmtAttribs.GetElementSize();
+    const auto  NumBlocksX = (Width + 3) / 4;
+    const auto  NumBlocksY = (Height + 3) / 4;
+
+    std::vector<Texel> Texels(Width * Height);
+    for (Uint32 by = 0; by < NumBlocksY; ++by)
+    {
+        for (Uint32 bx = 0; bx < NumBlocksX; ++bx)
+        {
+            const auto* pBlock = &Data[(by * NumBlocksX + bx) * BlockSize];
+
+            Texel Block[16] = {};
+            for (auto& t : Block)
+                t[3] = 255;
+
+            switch (Format)
+            {
+                case TEX_FORMAT_BC1_UNORM:
+                    DecodeBC1ColorBlock(pBlock, true, Block);
+                    break;
+
+                case TEX_FORMAT_BC2_UNORM:
+                    DecodeBC1ColorBlock(pBlock + 8, false, Block);
+                    for (Uint32 i = 0; i < 16; ++i)
+                        Block[i][3] = static_cast<Uint8>(((pBlock[i / 2] >> ((i % 2) * 4)) & 15u) * 17u);
+                    break;
+
+                case TEX_FORMAT_BC3_UNORM:
+                    DecodeBC1ColorBlock(pBlock + 8, false, Block);
+                    DecodeBC4Block(pBlock, 3, Block);
+                    break;
+
+                case TEX_FORMAT_BC4_UNORM:
+                    DecodeBC4Block(pBlock, 0, Block);
+                    break;
+
+                case TEX_FORMAT_BC5_UNORM:
+                    DecodeBC4Block(pBlock, 0, Block);
+                    DecodeBC4Block(pBlock + 8, 1, Block);
+                    break;
+
+                case TEX_FORMAT_BC7_UNORM:
+                    DecodeBC7Block(pBlock, Block);
+                    break;
+
+                default:
+                    ADD_FAILURE() << "Unexpected format";
+            }
+
+            for (Uint32 y = 0; y < 4 && by * 4 + y < Height; ++y)
+            {
+                for (Uint32 x = 0; x < 4 && bx * 4 + x < Width; ++x)
+                    Texels[(by * 4 + y) * Width + bx * 4 + x] = Block[y * 4 + x];
+            }
+        }
+    }
+    return Texels;
+}
+
+std::vector<Uint8> Compress(TEXTURE_FORMAT DstFormat, TEXTURE_FORMAT SrcFormat, const void* pSrcData, Uint32 Width, Uint32 Height, IThreadPool* pThreadPool = nullptr)
+{
+    const auto& DstFmtAttribs = GetTextureFormatAttribs(DstFormat);
+    const auto  DstStride     = (Width + 3) / 4 * DstFmtAttribs.GetElementSize();
+
+    std::vector<Uint8> Data(DstStride * ((Height + 3) / 4), 0xCD);
+
+    TextureCompressionAttribs Attribs;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.SrcFormat   = SrcFormat;
+    Attribs.pSrcData    = pSrcData;
+    Attribs.SrcStride   = Width * GetTextureFormatAttribs(SrcFormat).GetElementSize();
+    Attribs.DstFormat   = DstFormat;
+    Attribs.pDstData    = Data.data();
+    Attribs.DstStride   = DstStride;
+    Attribs.pThreadPool = pThreadPool;
+    EXPECT_TRUE(CompressTexture(Attribs));
+    return Data;
+}
+
+// Smooth gradients with some noise, which is typical for baked lightmaps
+std::vector<Texel> GenerateTestImage(Uint32 Width, Uint32 Height)
+{
+    std::vector<Texel> Texels(Width * Height);
+    Uint32             Seed = 19;
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            Seed = Seed * 1664525u + 1013904223u;
+
+            const auto Noise = static_cast<int>((Seed >> 24u) % 9u) - 4;
+            auto&      t     = Texels[y * Width + x];
+            t[0]             = static_cast<Uint8>(clamp(static_cast<int>(x * 255 / Width) + Noise, 0, 255));
+            t[1]             = static_cast<Uint8>(clamp(static_cast<int>(y * 255 / Height) - Noise, 0, 255));
+            t[2]             = static_cast<Uint8>(clamp(static_cast<int>((x + y) * 127 / (Width + Height)) + 64, 0, 255));
+            t[3]             = static_cast<Uint8>(255 - (x * y * 255) / (Width * Height));
+        }
+    }
+    return Texels;
+}
+
+float ComputeRMSE(const std::vector<Texel>& Ref, const std::vector<Texel>& Texels, Uint32 Channel)
+{
+    double Error = 0;
+    for (size_t i = 0; i < Ref.size(); ++i)
+    {
+        const double d = static_cast<double>(Ref[i][Channel]) - static_cast<double>(Texels[i][Channel]);
+        Error += d * d;
+    }
+    return static_cast<float>(std::sqrt(Error / static_cast<double>(Ref.size())));
+}
+
+TEST(GraphicsTools_TextureCompressor, IsSupported)
+{
+    for (auto Fmt : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC1_UNORM_SRGB, TEX_FORMAT_BC2_UNORM, TEX_FORMAT_BC3_UNORM_SRGB,
+                     TEX_FORMAT_BC4_UNORM, TEX_FORMAT_BC5_UNORM, TEX_FORMAT_BC7_UNORM, TEX_FORMAT_BC7_UNORM_SRGB})
+    {
+        EXPECT_TRUE(IsTextureCompressionSupported(Fmt)) << GetTextureFormatAttribs(Fmt).Name;
+    }
+    for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_BC6H_UF16, TEX_FORMAT_BC4_SNORM, TEX_FORMAT_UNKNOWN})
+    {
+        EXPECT_FALSE(IsTextureCompressionSupported(Fmt)) << GetTextureFormatAttribs(Fmt).Name;
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, Quality)
+{
+    constexpr Uint32 Width  = 37;
+    constexpr Uint32 Height = 21;
+
+    const auto Ref = GenerateTestImage(Width, Height);
+
+    // BC1 encodes texels with alpha below 128 as transparent black
+    auto OpaqueRef = Ref;
+    for (auto& t : OpaqueRef)
+        t[3] = 255;
+
+    // The colors of the test image do not lie on a line in most blocks,
+    // so single-subset formats can't reproduce them exactly.
+    struct FormatInfo
+    {
+        TEXTURE_FORMAT Format;
+        Uint32         NumChannels;
+        float          MaxRMSE;
+    };
+    // clang-format off
+    constexpr FormatInfo Formats[] =
+    {
+        {TEX_FORMAT_BC1_UNORM, 3, 8.5f},
+        {TEX_FORMAT_BC2_UNORM, 4, 8.5f},
+        {TEX_FORMAT_BC3_UNORM, 4, 8.5f},
+        {TEX_FORMAT_BC4_UNORM, 1, 1.5f},
+        {TEX_FORMAT_BC5_UNORM, 2, 2.0f},
+        {TEX_FORMAT_BC7_UNORM, 4, 8.0f},
+    };
+    // clang-format on
+
+    for (const auto& Fmt : Formats)
+    {
+        const auto& Src    = Fmt.Format == TEX_FORMAT_BC1_UNORM ? OpaqueRef : Ref;
+        const auto  Data   = Compress(Fmt.Format, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height);
+        const auto  Texels = DecodeTexture(Fmt.Format, Data, Width, Height);
+        for (Uint32 ch = 0; ch < Fmt.NumChannels; ++ch)
+        {
+            EXPECT_LE(ComputeRMSE(Src, Texels, ch), Fmt.MaxRMSE) << GetTextureFormatAttribs(Fmt.Format).Name << " channel " << ch;
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, SolidColor)
+{
+    const Texel Color = {200, 100, 50, 150};
+
+    std::vector<Texel> Src(5 * 6, Color);
+    for (auto Fmt : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC4_UNORM, TEX_FORMAT_BC5_UNORM, TEX_FORMAT_BC7_UNORM})
+    {
+        const auto Data   = Compress(Fmt, TEX_FORMAT_RGBA8_UNORM, Src.data(), 5, 6);
+        const auto Texels = DecodeTexture(Fmt, Data, 5, 6);
+        for (const auto& t : Texels)
+        {
+            // BC4 and BC5 channels and BC3 alpha are exact; 5:6:5 quantization error is at most 4
+            const Uint32 NumChannels = Fmt == TEX_FORMAT_BC4_UNORM ? 1 : (Fmt == TEX_FORMAT_BC5_UNORM ? 2 : (Fmt == TEX_FORMAT_BC1_UNORM ? 3 : 4));
+            const int    Tolerance   = (Fmt == TEX_FORMAT_BC4_UNORM || Fmt == TEX_FORMAT_BC5_UNORM) ? 0 : (Fmt == TEX_FORMAT_BC7_UNORM ? 1 : 4);
+            for (Uint32 ch = 0; ch < NumChannels; ++ch)
+            {
+                const int MaxError = (Fmt == TEX_FORMAT_BC3_UNORM && ch == 3) ? 0 : Tolerance;
+                EXPECT_LE(std::abs(int{t[ch]} - int{Color[ch]}), MaxError) << GetTextureFormatAttribs(Fmt).Name << " channel " << ch;
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, BC1Transparency)
+{
+    constexpr Uint32 Width  = 8;
+    constexpr Uint32 Height = 4;
+
+    std::vector<Texel> Src(Width * Height);
+    for (Uint32 i = 0; i < Src.size(); ++i)
+    {
+        const auto x = i % Width;
+        // The first block is fully transparent, the second one has a transparent checker pattern
+        const bool IsTransparent = x < 4 || (i % 2) == 0;
+        Src[i]                   = {static_cast<Uint8>(x * 30), 128, static_cast<Uint8>(255 - x * 30), static_cast<Uint8>(IsTransparent ? 0 : 255)};
+    }
+
+    const auto Data   = Compress(TEX_FORMAT_BC1_UNORM, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height);
+    const auto Texels = DecodeTexture(TEX_FORMAT_BC1_UNORM, Data, Width, Height);
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        EXPECT_EQ(Texels[i][3], Src[i][3]) << "Texel " << i;
+        if (Src[i][3] != 0)
+        {
+            for (Uint32 ch = 0; ch < 3; ++ch)
+                EXPECT_LE(std::abs(int{Texels[i][ch]} - int{Src[i][ch]}), 12) << "Texel " << i;
+        }
+    }
+}
+
+TEST(GraphicsTools_TextureCompressor, SrcFormats)
+{
+    constexpr Uint32 Width  = 13;
+    constexpr Uint32 Height = 10;
+
+    const auto Src = GenerateTestImage(Width, Height);
+
+    std::vector<Uint8> BGRA(Width * Height * 4);
+    std::vector<Uint8> R(Width * Height);
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        BGRA[i * 4 + 0] = Src[i][2];
+        BGRA[i * 4 + 1] = Src[i][1];
+        BGRA[i * 4 + 2] = Src[i][0];
+        BGRA[i * 4 + 3] = Src[i][3];
+        R[i]            = Src[i][0];
+    }
+
+    EXPECT_EQ(Compress(TEX_FORMAT_BC7_UNORM, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height),
+              Compress(TEX_FORMAT_BC7_UNORM, TEX_FORMAT_BGRA8_UNORM, BGRA.data(), Width, Height));
+    EXPECT_EQ(Compress(TEX_FORMAT_BC4_UNORM, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height),
+              Compress(TEX_FORMAT_BC4_UNORM, TEX_FORMAT_R8_UNORM, R.data(), Width, Height));
+}
+
+TEST(GraphicsTools_TextureCompressor, Multithreaded)
+{
+    constexpr Uint32 Width  = 130;
+    constexpr Uint32 Height = 75;
+
+    const auto Src = GenerateTestImage(Width, Height);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    CreateThreadPool(ThreadPoolCreateInfo{4}, &pThreadPool);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (auto Fmt : {TEX_FORMAT_BC1_UNORM, TEX_FORMAT_BC3_UNORM, TEX_FORMAT_BC7_UNORM})
+    {
+        EXPECT_EQ(Compress(Fmt, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height),
+                  Compress(Fmt, TEX_FORMAT_RGBA8_UNORM, Src.data(), Width, Height, pThreadPool))
+            << GetTextureFormatAttribs(Fmt).Name;
+    }
+}
+
+} // namespace
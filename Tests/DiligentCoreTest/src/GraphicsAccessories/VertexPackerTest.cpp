@@ -0,0 +1,376 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "VertexPacker.hpp"
+#include "BasicMath.hpp"
+#include "ThreadPool.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+float HalfToFloat(Uint16 h)
+{
+    const int Exponent = (h >> 10) & 0x1F;
+    const int Mantissa = h & 0x3FF;
+
+    float f;
+    if (Exponent == 0)
+        f = std::ldexp(static_cast<float>(Mantissa), -24);
+    else if (Exponent == 31)
+        f = Mantissa == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    else
+        f = std::ldexp(static_cast<float>(Mantissa + 1024), Exponent - 25);
+    return (h & 0x8000) != 0 ? -f : f;
+}
+
+// Same decoding as in the documentation of VERTEX_PACKING_OCT_SNORM16
+float3 DecodeOctahedral(Int16 x, Int16 y)
+{
+    const float ex = std::max(static_cast<float>(x) / 32767.f, -1.f);
+    const float ey = std::max(static_cast<float>(y) / 32767.f, -1.f);
+
+    float3      n{ex, ey, 1.f - std::abs(ex) - std::abs(ey)};
+    const float t = std::min(std::max(-n.z, 0.f), 1.f);
+    n.x += n.x >= 0 ? -t : t;
+    n.y += n.y >= 0 ? -t : t;
+    return normalize(n);
+}
+
+template <typename T>
+std::vector<T> PackSingleAttribute(const VertexAttributePackInfo& Attrib, const std::vector<float>& Src, Uint32 NumVertices)
+{
+    VertexPacker Packer{&Attrib, 1};
+    EXPECT_EQ(Packer.GetStride() % sizeof(T), 0u);
+
+    std::vector<T> Dst(NumVertices * Packer.GetStride() / sizeof(T));
+
+    VertexAttributeSource Source;
+    Source.pData = Src.data();
+    Packer.Pack(&Source, NumVertices, Dst.data());
+    return Dst;
+}
+
+TEST(GraphicsTools_VertexPacker, InputLayout)
+{
+    VertexAttributePackInfo Attribs[5];
+    Attribs[0].InputIndex    = 0;
+    Attribs[0].NumComponents = 3;
+    Attribs[0].Packing       = VERTEX_PACKING_SNORM16;
+    Attribs[1].InputIndex    = 1;
+    Attribs[1].NumComponents = 3;
+    Attribs[1].Packing       = VERTEX_PACKING_OCT_SNORM16;
+    Attribs[2].InputIndex    = 2;
+    Attribs[2].NumComponents = 2;
+    Attribs[2].Packing       = VERTEX_PACKING_FLOAT16;
+    Attribs[3].InputIndex    = 3;
+    Attribs[3].NumComponents = 4;
+    Attribs[3].Packing       = VERTEX_PACKING_UNORM10_10_10_2;
+    Attribs[4].InputIndex    = 5;
+    Attribs[4].NumComponents = 1;
+    Attribs[4].Packing       = VERTEX_PACKING_FLOAT32;
+
+    VertexPacker Packer{Attribs, _countof(Attribs), 2};
+    EXPECT_EQ(Packer.GetStride(), 24u);
+
+    const auto Layout = Packer.GetInputLayout();
+    ASSERT_EQ(Layout.NumElements, 5u);
+
+    struct ExpectedElement
+    {
+        Uint32     InputIndex;
+        Uint32     NumComponents;
+        VALUE_TYPE ValueType;
+        bool       IsNormalized;
+        Uint32     Offset;
+    };
+    const ExpectedElement Expected[] =
+        {
+            {0, 4, VT_INT16, true, 0},
+            {1, 2, VT_INT16, true, 8},
+            {2, 2, VT_FLOAT16, false, 12},
+            {3, 1, VT_UINT32, false, 16},
+            {5, 1, VT_FLOAT32, false, 20},
+        };
+    for (Uint32 i = 0; i < Layout.NumElements; ++i)
+    {
+        const auto& Elem = Layout.LayoutElements[i];
+        EXPECT_EQ(Elem.InputIndex, Expected[i].InputIndex) << i;
+        EXPECT_EQ(Elem.BufferSlot, 2u) << i;
+        EXPECT_EQ(Elem.NumComponents, Expected[i].NumComponents) << i;
+        EXPECT_EQ(Elem.ValueType, Expected[i].ValueType) << i;
+        EXPECT_EQ(Elem.IsNormalized, Expected[i].IsNormalized) << i;
+        EXPECT_EQ(Elem.RelativeOffset, Expected[i].Offset) << i;
+        EXPECT_EQ(Elem.Stride, 24u) << i;
+    }
+}
+
+TEST(GraphicsTools_VertexPacker, Float16)
+{
+    const float Inf = std::numeric_limits<float>::infinity();
+
+    const std::pair<float, Uint16> RefValues[] =
+        {
+            {0.f, 0x0000},
+            {1.f, 0x3C00},
+            {-2.f, 0xC000},
+            {0.5f, 0x3800},
+            {65504.f, 0x7BFF},
+            {65520.f, 0x7C00}, // Rounds up to infinity
+            {1e+10f, 0x7C00},
+            {-Inf, 0xFC00},
+            {Inf, 0x7C00},
+            {6.103515625e-5f, 0x0400},  // The smallest normal
+            {5.9604645e-8f, 0x0001},    // The smallest denormal
+            {2.98023224e-8f, 0x0000},   // Tie, rounds to even
+            {8.94069672e-8f, 0x0002},   // Tie, rounds to even
+            {1.00048828125f, 0x3C00},   // 1 + 2^-11, tie, rounds to even
+            {1.00146484375f, 0x3C02},   // 1 + 3 * 2^-11, tie, rounds to even
+            {1.0009765625f, 0x3C01},    // 1 + 2^-10
+            {0.333333333f, 0x3555},
+        };
+
+    std::vector<float> Src;
+    for (const auto& Ref : RefValues)
+        Src.push_back(Ref.first);
+    Src.push_back(std::numeric_limits<float>::quiet_NaN());
+
+    VertexAttributePackInfo Attrib;
+    Attrib.NumComponents = 2;
+    Attrib.Packing       = VERTEX_PACKING_FLOAT16;
+
+    const auto Dst = PackSingleAttribute<Uint16>(Attrib, Src, static_cast<Uint32>(Src.size() / 2));
+    ASSERT_EQ(Dst.size(), Src.size());
+    for (size_t i = 0; i < _countof(RefValues); ++i)
+        EXPECT_EQ(Dst[i], RefValues[i].second) << "Value: " << RefValues[i].first;
+    EXPECT_TRUE(std::isnan(HalfToFloat(Dst[_countof(RefValues)])));
+
+    // Random values must be rounded to the nearest representable value
+    std::mt19937                          Gen{7};
+    std::uniform_real_distribution<float> Dist{-1000.f, 1000.f};
+
+    Src.resize(4096);
+    for (auto& Value : Src)
+        Value = Dist(Gen);
+
+    const auto Halfs = PackSingleAttribute<Uint16>(Attrib, Src, static_cast<Uint32>(Src.size() / 2));
+    for (size_t i = 0; i < Src.size(); ++i)
+    {
+        const auto h     = Halfs[i];
+        const auto Error = std::abs(HalfToFloat(h) - Src[i]);
+        EXPECT_LE(Error, std::abs(HalfToFloat(static_cast<Uint16>(h + 1)) - Src[i])) << Src[i];
+        EXPECT_LE(Error, std::abs(HalfToFloat(static_cast<Uint16>(h - 1)) - Src[i])) << Src[i];
+    }
+}
+
+TEST(GraphicsTools_VertexPacker, Normalized16)
+{
+    const std::vector<float> Src = {-1.f, 1.f, 0.f, 0.5f, -0.5f, 2.f, -2.f, 0.25f, 1e-6f, -1e-6f};
+
+    VertexAttributePackInfo Attrib;
+    Attrib.NumComponents = 2;
+
+    Attrib.Packing = VERTEX_PACKING_SNORM16;
+
+    const auto Snorm = PackSingleAttribute<Int16>(Attrib, Src, 5);
+    EXPECT_EQ(Snorm, (std::vector<Int16>{-32767, 32767, 0, 16384, -16384, 32767, -32767, 8192, 0, 0}));
+
+    Attrib.Packing = VERTEX_PACKING_UNORM16;
+
+    const auto Unorm = PackSingleAttribute<Uint16>(Attrib, Src, 5);
+    EXPECT_EQ(Unorm, (std::vector<Uint16>{0, 65535, 0, 32768, 0, 65535, 0, 16384, 0, 0}));
+}
+
+TEST(GraphicsTools_VertexPacker, Padding)
+{
+    const std::vector<float> Src = {0.5f, 0.25f, -0.5f, 1.f, 0.f, -1.f, 0.125f, 0.375f, 0.75f};
+
+    VertexAttributePackInfo Attrib;
+    Attrib.NumComponents = 3;
+    Attrib.Packing       = VERTEX_PACKING_FLOAT16;
+
+    // Missing fourth component is 1
+    const auto Halfs = PackSingleAttribute<Uint16>(Attrib, Src, 3);
+    ASSERT_EQ(Halfs.size(), 12u);
+    for (Uint32 v = 0; v < 3; ++v)
+    {
+        for (Uint32 c = 0; c < 3; ++c)
+            EXPECT_EQ(HalfToFloat(Halfs[v * 4 + c]), Src[v * 3 + c]);
+        EXPECT_EQ(Halfs[v * 4 + 3], 0x3C00);
+    }
+
+    Attrib.NumComponents = 1;
+    Attrib.Packing       = VERTEX_PACKING_SNORM16;
+
+    // Missing second component is 0
+    const auto Snorm = PackSingleAttribute<Int16>(Attrib, Src, 3);
+    EXPECT_EQ(Snorm, (std::vector<Int16>{16384, 0, 8192, 0, -16384, 0}));
+}
+
+TEST(GraphicsTools_VertexPacker, Octahedral)
+{
+    std::mt19937                          Gen{11};
+    std::uniform_real_distribution<float> Dist{-1.f, 1.f};
+
+    std::vector<float3> Normals = {
+        float3{1, 0, 0},
+        float3{-1, 0, 0},
+        float3{0, 1, 0},
+        float3{0, -1, 0},
+        float3{0, 0, 1},
+        float3{0, 0, -1},
+        float3{1, 1, -1},
+        float3{-3, 2, -5},
+    };
+    while (Normals.size() < 1001)
+    {
+        const float3 n{Dist(Gen), Dist(Gen), Dist(Gen)};
+        if (length(n) > 0.1f)
+            Normals.push_back(n);
+    }
+
+    std::vector<float> Src;
+    for (const auto& n : Normals)
+        Src.insert(Src.end(), {n.x, n.y, n.z});
+
+    VertexAttributePackInfo Attrib;
+    Attrib.NumComponents = 3;
+    Attrib.Packing       = VERTEX_PACKING_OCT_SNORM16;
+
+    const auto Dst = PackSingleAttribute<Int16>(Attrib, Src, static_cast<Uint32>(Normals.size()));
+    ASSERT_EQ(Dst.size(), Normals.size() * 2);
+    for (size_t i = 0; i < Normals.size(); ++i)
+    {
+        const auto Decoded = DecodeOctahedral(Dst[i * 2], Dst[i * 2 + 1]);
+        EXPECT_GT(dot(Decoded, normalize(Normals[i])), 0.99999f) << Normals[i].x << ' ' << Normals[i].y << ' ' << Normals[i].z;
+    }
+}
+
+TEST(GraphicsTools_VertexPacker, Unorm10_10_10_2)
+{
+    VertexAttributePackInfo Attrib;
+    Attrib.NumComponents = 3;
+    Attrib.Packing       = VERTEX_PACKING_UNORM10_10_10_2;
+    Attrib.Scale         = float4{0.5f, 0.5f, 0.5f, 0.5f};
+    Attrib.Bias          = float4{0.5f, 0.5f, 0.5f, 0.5f};
+
+    // Normals in [-1, 1] are mapped to [0, 1]
+    const std::vector<float> Src = {-1.f, 0.f, 1.f, 2.f, 0.5f, -0.5f};
+
+    const auto Dst = PackSingleAttribute<Uint32>(Attrib, Src, 2);
+    ASSERT_EQ(Dst.size(), 2u);
+    EXPECT_EQ(Dst[0], 0u | (512u << 10u) | (1023u << 20u) | (3u << 30u));
+    EXPECT_EQ(Dst[1], 1023u | (767u << 10u) | (256u << 20u) | (3u << 30u));
+}
+
+TEST(GraphicsTools_VertexPacker, Interleaved)
+{
+    constexpr Uint32 NumVertices = 10007;
+
+    struct SrcVertex
+    {
+        float3 Pos;
+        float3 Normal;
+        float2 UV;
+    };
+    std::vector<SrcVertex> Vertices(NumVertices);
+
+    std::mt19937                          Gen{3};
+    std::uniform_real_distribution<float> Dist{-1.f, 1.f};
+    for (auto& Vert : Vertices)
+    {
+        Vert.Pos    = float3{Dist(Gen), Dist(Gen), Dist(Gen)} * 100.f + float3{50, 0, 0};
+        Vert.Normal = normalize(float3{Dist(Gen), Dist(Gen), Dist(Gen)} + float3{0, 0, 2});
+        Vert.UV     = float2{Dist(Gen), Dist(Gen)} * 0.5f + float2{0.5f, 0.5f};
+    }
+
+    VertexAttributePackInfo Attribs[3];
+    Attribs[0].InputIndex    = 0;
+    Attribs[0].NumComponents = 3;
+    Attribs[0].Packing       = VERTEX_PACKING_SNORM16;
+    Attribs[0].Scale         = float4{0.01f, 0.01f, 0.01f, 1};
+    Attribs[0].Bias          = float4{-0.5f, 0, 0, 0};
+    Attribs[1].InputIndex    = 1;
+    Attribs[1].NumComponents = 3;
+    Attribs[1].Packing       = VERTEX_PACKING_OCT_SNORM16;
+    Attribs[2].InputIndex    = 2;
+    Attribs[2].NumComponents = 2;
+    Attribs[2].Packing       = VERTEX_PACKING_UNORM16;
+
+    VertexPacker Packer{Attribs, _countof(Attribs)};
+    ASSERT_EQ(Packer.GetStride(), 16u);
+
+    VertexAttributeSource Sources[3];
+    Sources[0].pData  = &Vertices[0].Pos;
+    Sources[0].Stride = sizeof(SrcVertex);
+    Sources[1].pData  = &Vertices[0].Normal;
+    Sources[1].Stride = sizeof(SrcVertex);
+    Sources[2].pData  = &Vertices[0].UV;
+    Sources[2].Stride = sizeof(SrcVertex);
+
+    std::vector<Uint8> Packed(NumVertices * Packer.GetStride());
+    Packer.Pack(Sources, NumVertices, Packed.data());
+
+    for (Uint32 v = 0; v < NumVertices; ++v)
+    {
+        Int16  Pos[4];
+        Int16  Normal[2];
+        Uint16 UV[2];
+        std::memcpy(Pos, &Packed[v * 16 + 0], sizeof(Pos));
+        std::memcpy(Normal, &Packed[v * 16 + 8], sizeof(Normal));
+        std::memcpy(UV, &Packed[v * 16 + 12], sizeof(UV));
+
+        const auto& Ref = Vertices[v];
+        for (Uint32 c = 0; c < 3; ++c)
+            ASSERT_NEAR((Pos[c] / 32767.f + Attribs[0].Bias[c] * -1.f) / Attribs[0].Scale[c], Ref.Pos[c], 0.01f) << v;
+        ASSERT_EQ(Pos[3], 32767) << v;
+        ASSERT_GT(dot(DecodeOctahedral(Normal[0], Normal[1]), Ref.Normal), 0.99999f) << v;
+        for (Uint32 c = 0; c < 2; ++c)
+            ASSERT_NEAR(UV[c] / 65535.f, Ref.UV[c], 1e-5f) << v;
+    }
+
+    // The result must not depend on the thread pool
+    RefCntAutoPtr<IThreadPool> pThreadPool;
+    CreateThreadPool(ThreadPoolCreateInfo{4}, &pThreadPool);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::vector<Uint8> PackedMT(Packed.size());
+    Packer.Pack(Sources, NumVertices, PackedMT.data(), pThreadPool);
+    EXPECT_EQ(Packed, PackedMT);
+}
+
+} // namespace
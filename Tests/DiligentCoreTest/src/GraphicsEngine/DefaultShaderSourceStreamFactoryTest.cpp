@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <string>
+
+#include "DefaultShaderSourceStreamFactory.h"
+#include "FileWrapper.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void WriteTestFile(const char* Path, const std::string& Content)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Content.data(), Content.size()));
+}
+
+std::string ReadStream(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    if (!pStream)
+        return "<null>";
+
+    RefCntAutoPtr<IDataBlob> pData;
+    pStream->ReadBlob2(&pData);
+    return std::string{static_cast<const char*>(pData->GetConstDataPtr()), pData->GetSize()};
+}
+
+TEST(GraphicsEngine_DefaultShaderSourceStreamFactory, PrefetchIncludes)
+{
+    const std::string MainSource = "#include \"ShaderFactoryTestInc0.tmp\"\n"
+                                   "  #  include <ShaderFactoryTestInc1.tmp>\n"
+                                   "#include \"ShaderFactoryTestMissing.tmp\"\n"
+                                   "void main(){}\n";
+    const std::string Inc0Source = "#include \"ShaderFactoryTestInc2.tmp\"\n"
+                                   "float4 f0;\n";
+    const std::string Inc1Source = "float4 f1;\n";
+    const std::string Inc2Source = "float4 f2;\n";
+
+    WriteTestFile("ShaderFactoryTestMain.tmp", MainSource);
+    WriteTestFile("ShaderFactoryTestInc0.tmp", Inc0Source);
+    WriteTestFile("ShaderFactoryTestInc1.tmp", Inc1Source);
+    WriteTestFile("ShaderFactoryTestInc2.tmp", Inc2Source);
+
+    {
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+        CreateDefaultShaderSourceStreamFactory(nullptr, &pFactory);
+        ASSERT_NE(pFactory, nullptr);
+
+        // Whether the include files are served from the prefetched data or read
+        // on demand depends on timing, but the contents must always match.
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestMain.tmp"), MainSource);
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestInc0.tmp"), Inc0Source);
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestInc1.tmp"), Inc1Source);
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestInc2.tmp"), Inc2Source);
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestMissing.tmp"), "<null>");
+
+        // Prefetched data is handed out once, so modified files are read again
+        WriteTestFile("ShaderFactoryTestInc1.tmp", "float4 f1_modified;\n");
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryTestInc1.tmp"), "float4 f1_modified;\n");
+    }
+
+    for (const auto* Name : {"ShaderFactoryTestMain.tmp", "ShaderFactoryTestInc0.tmp", "ShaderFactoryTestInc1.tmp", "ShaderFactoryTestInc2.tmp"})
+        FileSystem::DeleteFile(Name);
+}
+
+TEST(GraphicsEngine_DefaultShaderSourceStreamFactory, FileCache)
+{
+    const std::string Source = "#include \"ShaderFactoryCacheTestMissing0.tmp\"\n"
+                               "#include \"ShaderFactoryCacheTestMissing1.tmp\"\n"
+                               "void main(){}\n";
+    WriteTestFile("ShaderFactoryCacheTest.tmp", Source);
+
+    {
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+        CreateDefaultShaderSourceStreamFactory(nullptr, &pFactory);
+        ASSERT_NE(pFactory, nullptr);
+
+        auto ReadBlob = [&]() {
+            RefCntAutoPtr<IFileStream> pStream;
+            pFactory->CreateInputStream("ShaderFactoryCacheTest.tmp", &pStream);
+            RefCntAutoPtr<IDataBlob> pData;
+            if (pStream)
+                pStream->ReadBlob2(&pData);
+            return pData;
+        };
+
+        auto pData0 = ReadBlob();
+        auto pData1 = ReadBlob();
+        ASSERT_TRUE(pData0 && pData1);
+        EXPECT_EQ(std::string(static_cast<const char*>(pData1->GetConstDataPtr()), pData1->GetSize()), Source);
+
+        ShaderSourceStreamFactoryStats Stats;
+        ASSERT_TRUE(GetDefaultShaderSourceStreamFactoryStats(pFactory, &Stats));
+        EXPECT_EQ(Stats.NumRequests, 2u);
+        if (Stats.NumCachedFiles == 0)
+        {
+            FileSystem::DeleteFile("ShaderFactoryCacheTest.tmp");
+            GTEST_SKIP() << "The platform does not support file status queries";
+        }
+
+        // The cached data is shared, not copied
+        EXPECT_EQ(pData0->GetConstDataPtr(), pData1->GetConstDataPtr());
+        EXPECT_EQ(Stats.NumCacheHits, 1u);
+        EXPECT_EQ(Stats.NumCachedFiles, 1u);
+        EXPECT_EQ(Stats.NumIncludeDirectives, 2u);
+        EXPECT_EQ(Stats.BytesServedFromCache, Source.size());
+        EXPECT_EQ(Stats.CachedDataSize, Source.size());
+
+        // Modified files are read again
+        WriteTestFile("ShaderFactoryCacheTest.tmp", "void main(){}\n");
+        EXPECT_EQ(ReadStream(pFactory, "ShaderFactoryCacheTest.tmp"), "void main(){}\n");
+        ASSERT_TRUE(GetDefaultShaderSourceStreamFactoryStats(pFactory, &Stats));
+        EXPECT_EQ(Stats.NumInvalidations, 1u);
+        EXPECT_EQ(Stats.NumIncludeDirectives, 0u);
+    }
+
+    FileSystem::DeleteFile("ShaderFactoryCacheTest.tmp");
+}
+
+} // namespace
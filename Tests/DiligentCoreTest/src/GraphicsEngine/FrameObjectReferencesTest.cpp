@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "FrameObjectReferences.hpp"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+class TestObject final : public ObjectBase<IObject>
+{
+public:
+    TestObject(IReferenceCounters* pRefCounters) :
+        ObjectBase<IObject>{pRefCounters}
+    {}
+};
+
+RefCntAutoPtr<TestObject> CreateTestObject()
+{
+    return RefCntAutoPtr<TestObject>{MakeNewRCObj<TestObject>()()};
+}
+
+TEST(GraphicsEngine_FrameObjectReferences, AddAndReset)
+{
+    FrameObjectReferences Refs;
+    EXPECT_EQ(Refs.GetSize(), size_t{0});
+    EXPECT_FALSE(Refs.Add(nullptr));
+
+    auto pObj0 = CreateTestObject();
+    auto pObj1 = CreateTestObject();
+
+    EXPECT_TRUE(Refs.Add(pObj0));
+    EXPECT_EQ(pObj0->GetReferenceCounters()->GetNumStrongRefs(), 2);
+
+    // Adding the same object again must not touch its reference counter
+    EXPECT_FALSE(Refs.Add(pObj0));
+    EXPECT_EQ(pObj0->GetReferenceCounters()->GetNumStrongRefs(), 2);
+
+    EXPECT_TRUE(Refs.Add(pObj1));
+    EXPECT_EQ(Refs.GetSize(), size_t{2});
+    EXPECT_TRUE(Refs.Contains(pObj0));
+    EXPECT_TRUE(Refs.Contains(pObj1));
+
+    Refs.Reset();
+    EXPECT_EQ(Refs.GetSize(), size_t{0});
+    EXPECT_FALSE(Refs.Contains(pObj0));
+    EXPECT_EQ(pObj0->GetReferenceCounters()->GetNumStrongRefs(), 1);
+    EXPECT_EQ(pObj1->GetReferenceCounters()->GetNumStrongRefs(), 1);
+}
+
+TEST(GraphicsEngine_FrameObjectReferences, KeepsObjectsAlive)
+{
+    FrameObjectReferences Refs;
+
+    RefCntWeakPtr<TestObject> pWeakObj;
+    {
+        auto pObj = CreateTestObject();
+        pWeakObj  = RefCntWeakPtr<TestObject>{pObj};
+        Refs.Add(pObj);
+    }
+    EXPECT_TRUE(pWeakObj.Lock());
+
+    Refs.Reset();
+    EXPECT_FALSE(pWeakObj.Lock());
+}
+
+TEST(GraphicsEngine_FrameObjectReferences, Rehash)
+{
+    FrameObjectReferences Refs;
+
+    std::vector<RefCntAutoPtr<TestObject>> Objects;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Objects.emplace_back(CreateTestObject());
+        EXPECT_TRUE(Refs.Add(Objects.back()));
+    }
+    EXPECT_EQ(Refs.GetSize(), Objects.size());
+
+    for (auto& pObj : Objects)
+    {
+        EXPECT_TRUE(Refs.Contains(pObj));
+        EXPECT_FALSE(Refs.Add(pObj));
+        EXPECT_EQ(pObj->GetReferenceCounters()->GetNumStrongRefs(), 2);
+    }
+
+    Refs.Reset();
+    for (auto& pObj : Objects)
+        EXPECT_EQ(pObj->GetReferenceCounters()->GetNumStrongRefs(), 1);
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "LiveObjectRegistry.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+std::vector<LiveObjectInfo> GetObjects(IDataBlob* pBlob)
+{
+    const auto* pObjects = reinterpret_cast<const LiveObjectInfo*>(pBlob->GetConstDataPtr());
+    return std::vector<LiveObjectInfo>{pObjects, pObjects + pBlob->GetSize() / sizeof(LiveObjectInfo)};
+}
+
+TEST(GraphicsEngine_LiveObjectRegistry, Snapshot)
+{
+    LiveObjectRegistry Registry;
+
+    const auto Buff0 = Registry.Register(DEVICE_OBJECT_TYPE_BUFFER, "Buffer 0");
+    const auto Tex0  = Registry.Register(DEVICE_OBJECT_TYPE_TEXTURE, "Texture 0");
+    Registry.SetSize(Buff0, 1024);
+    Registry.SetSize(Tex0, 4096);
+
+    Registry.SetFrameNumber(5);
+    const auto Buff1 = Registry.Register(DEVICE_OBJECT_TYPE_BUFFER, "Buffer 1");
+    Registry.SetSize(Buff1, 256);
+
+    ResourceSnapshot Snapshot;
+    Registry.CaptureSnapshot(Snapshot, nullptr);
+    EXPECT_EQ(Snapshot.FrameNumber, 5u);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_BUFFER], 2u);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE], 1u);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_SAMPLER], 0u);
+    EXPECT_EQ(Snapshot.ObjectSizes[DEVICE_OBJECT_TYPE_BUFFER], 1280u);
+    EXPECT_EQ(Snapshot.ObjectSizes[DEVICE_OBJECT_TYPE_TEXTURE], 4096u);
+
+    RefCntAutoPtr<IDataBlob> pObjects0;
+    Snapshot = {};
+    Registry.CaptureSnapshot(Snapshot, &pObjects0);
+    ASSERT_NE(pObjects0, nullptr);
+    const auto Objects0 = GetObjects(pObjects0);
+    ASSERT_EQ(Objects0.size(), 3u);
+    EXPECT_STREQ(Objects0[0].Name, "Buffer 0");
+    EXPECT_STREQ(Objects0[1].Name, "Texture 0");
+    EXPECT_STREQ(Objects0[2].Name, "Buffer 1");
+    EXPECT_EQ(Objects0[1].Type, DEVICE_OBJECT_TYPE_TEXTURE);
+    EXPECT_EQ(Objects0[1].Size, 4096u);
+    EXPECT_EQ(Objects0[0].CreationFrame, 0u);
+    EXPECT_EQ(Objects0[2].CreationFrame, 5u);
+    EXPECT_LT(Objects0[0].SerialNumber, Objects0[1].SerialNumber);
+    EXPECT_LT(Objects0[1].SerialNumber, Objects0[2].SerialNumber);
+
+    // The id of the released buffer is reused, but the serial number is not
+    Registry.Unregister(Buff0);
+    const auto Buff2 = Registry.Register(DEVICE_OBJECT_TYPE_BUFFER, "Buffer 2");
+    EXPECT_EQ(Buff2, Buff0);
+
+    RefCntAutoPtr<IDataBlob> pObjects1;
+    Snapshot = {};
+    Registry.CaptureSnapshot(Snapshot, &pObjects1);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_BUFFER], 2u);
+    EXPECT_EQ(Snapshot.ObjectSizes[DEVICE_OBJECT_TYPE_BUFFER], 256u);
+    const auto Objects1 = GetObjects(pObjects1);
+    ASSERT_EQ(Objects1.size(), 3u);
+    EXPECT_STREQ(Objects1[0].Name, "Texture 0");
+    EXPECT_STREQ(Objects1[1].Name, "Buffer 1");
+    EXPECT_STREQ(Objects1[2].Name, "Buffer 2");
+    EXPECT_GT(Objects1[2].SerialNumber, Objects0[2].SerialNumber);
+
+    // The first snapshot is not affected by the later changes
+    EXPECT_STREQ(GetObjects(pObjects0)[0].Name, "Buffer 0");
+
+    Registry.Unregister(Tex0);
+    Registry.Unregister(Buff1);
+    Registry.Unregister(Buff2);
+
+    RefCntAutoPtr<IDataBlob> pObjects2;
+    Snapshot = {};
+    Registry.CaptureSnapshot(Snapshot, &pObjects2);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_BUFFER], 0u);
+    EXPECT_EQ(Snapshot.NumObjects[DEVICE_OBJECT_TYPE_TEXTURE], 0u);
+    ASSERT_NE(pObjects2, nullptr);
+    EXPECT_EQ(pObjects2->GetSize(), 0u);
+}
+
+} // namespace
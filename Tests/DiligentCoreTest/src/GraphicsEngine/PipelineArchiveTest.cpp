@@ -0,0 +1,391 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "PipelineArchive.hpp"
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+RefCntAutoPtr<IDataBlob> MakeBlob(const std::vector<Uint8>& Data)
+{
+    RefCntAutoPtr<IDataBlob> pBlob{MakeNewRCObj<DataBlobImpl>{}(Data.size())};
+    if (!Data.empty())
+        memcpy(pBlob->GetDataPtr(), Data.data(), Data.size());
+    return pBlob;
+}
+
+RefCntAutoPtr<IDataBlob> CreateTestArchive()
+{
+    PipelineArchiveWriter Writer;
+
+    const Uint32 VSByteCode[] = {0x07230203, 1, 2, 3};
+    const Uint8  PSByteCode[] = {0xDE, 0xAD, 0xBE, 0xEF, 0x01};
+
+    PipelineArchiveShaderResource PSResources[2];
+    PSResources[0].Name      = "g_Texture";
+    PSResources[0].Type      = SHADER_RESOURCE_TYPE_TEXTURE_SRV;
+    PSResources[1].Name      = "g_Buffers";
+    PSResources[1].Type      = SHADER_RESOURCE_TYPE_BUFFER_SRV;
+    PSResources[1].ArraySize = 4;
+    PSResources[1].Flags     = PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER;
+
+    PipelineArchiveShaderDesc ShaderDesc;
+    ShaderDesc.Name         = "TestVS";
+    ShaderDesc.DeviceType   = RENDER_DEVICE_TYPE_VULKAN;
+    ShaderDesc.ShaderType   = SHADER_TYPE_VERTEX;
+    ShaderDesc.EntryPoint   = "VSMain";
+    ShaderDesc.ByteCode     = VSByteCode;
+    ShaderDesc.ByteCodeSize = sizeof(VSByteCode);
+    EXPECT_TRUE(Writer.AddShader(ShaderDesc));
+
+    ShaderDesc.Name                       = "TestPS";
+    ShaderDesc.ShaderType                 = SHADER_TYPE_PIXEL;
+    ShaderDesc.EntryPoint                 = "PSMain";
+    ShaderDesc.UseCombinedTextureSamplers = true;
+    ShaderDesc.CombinedSamplerSuffix      = "_smplr";
+    ShaderDesc.ByteCode                   = PSByteCode;
+    ShaderDesc.ByteCodeSize               = sizeof(PSByteCode);
+    ShaderDesc.Resources                  = PSResources;
+    ShaderDesc.NumResources               = _countof(PSResources);
+    EXPECT_TRUE(Writer.AddShader(ShaderDesc));
+
+    // Same name, different device type
+    ShaderDesc.DeviceType   = RENDER_DEVICE_TYPE_D3D12;
+    ShaderDesc.NumResources = 0;
+    EXPECT_TRUE(Writer.AddShader(ShaderDesc));
+
+    PipelineResourceDesc Resources[] =
+        {
+            {SHADER_TYPE_PIXEL, "g_Texture", 1, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL, "g_Buffers", 4, SHADER_RESOURCE_TYPE_BUFFER_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC, PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER},
+        };
+
+    SamplerDesc SamLinearWrap;
+    SamLinearWrap.AddressU = TEXTURE_ADDRESS_WRAP;
+    SamLinearWrap.AddressV = TEXTURE_ADDRESS_WRAP;
+    SamLinearWrap.MaxLOD   = 8;
+
+    ImmutableSamplerDesc ImtblSamplers[] =
+        {
+            {SHADER_TYPE_PIXEL, "g_Texture", SamLinearWrap},
+        };
+
+    PipelineResourceSignatureDesc SignDesc;
+    SignDesc.Name                       = "TestSignature";
+    SignDesc.Resources                  = Resources;
+    SignDesc.NumResources               = _countof(Resources);
+    SignDesc.ImmutableSamplers          = ImtblSamplers;
+    SignDesc.NumImmutableSamplers       = _countof(ImtblSamplers);
+    SignDesc.BindingIndex               = 2;
+    SignDesc.UseCombinedTextureSamplers = true;
+    SignDesc.CombinedSamplerSuffix      = "_smplr";
+    SignDesc.SRBAllocationGranularity   = 16;
+    EXPECT_TRUE(Writer.AddResourceSignature(SignDesc));
+
+    LayoutElement LayoutElems[] =
+        {
+            LayoutElement{0, 0, 3, VT_FLOAT32, False},
+            LayoutElement{1, 1, 4, VT_UINT8, True, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+        };
+
+    const char* ShaderNames[]    = {"TestVS", "TestPS"};
+    const char* SignatureNames[] = {"TestSignature"};
+
+    PipelineArchivePipelineDesc PipelineDesc;
+    PipelineDesc.Name                     = "TestPipeline";
+    PipelineDesc.SRBAllocationGranularity = 8;
+    PipelineDesc.ShaderNames              = ShaderNames;
+    PipelineDesc.NumShaders               = _countof(ShaderNames);
+    PipelineDesc.SignatureNames           = SignatureNames;
+    PipelineDesc.NumSignatures            = _countof(SignatureNames);
+
+    auto& GraphicsPipeline                                  = PipelineDesc.GraphicsPipeline;
+    GraphicsPipeline.NumRenderTargets                       = 2;
+    GraphicsPipeline.RTVFormats[0]                          = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    GraphicsPipeline.RTVFormats[1]                          = TEX_FORMAT_RG16_FLOAT;
+    GraphicsPipeline.DSVFormat                              = TEX_FORMAT_D32_FLOAT;
+    GraphicsPipeline.PrimitiveTopology                      = PRIMITIVE_TOPOLOGY_LINE_STRIP;
+    GraphicsPipeline.RasterizerDesc.CullMode                = CULL_MODE_FRONT;
+    GraphicsPipeline.DepthStencilDesc.DepthFunc             = COMPARISON_FUNC_GREATER;
+    GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = True;
+    GraphicsPipeline.SmplDesc.Count                         = 4;
+    GraphicsPipeline.InputLayout.LayoutElements             = LayoutElems;
+    GraphicsPipeline.InputLayout.NumElements                = _countof(LayoutElems);
+    EXPECT_TRUE(Writer.AddPipeline(PipelineDesc));
+
+    const char* CSName[] = {"TestCS"};
+
+    PipelineArchivePipelineDesc ComputeDesc;
+    ComputeDesc.Name         = "TestCompute";
+    ComputeDesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    ComputeDesc.ShaderNames  = CSName;
+    ComputeDesc.NumShaders   = 1;
+    EXPECT_TRUE(Writer.AddPipeline(ComputeDesc));
+
+    std::vector<Uint8> Data;
+    Writer.Serialize(Data);
+    return MakeBlob(Data);
+}
+
+TEST(PipelineArchiveTest, Shaders)
+{
+    auto pArchive = CreateTestArchive();
+
+    PipelineArchiveReader Reader{pArchive};
+    EXPECT_EQ(Reader.GetShaderCount(), 3u);
+    EXPECT_EQ(Reader.GetResourceSignatureCount(), 1u);
+    EXPECT_EQ(Reader.GetPipelineCount(), 2u);
+
+    {
+        ShaderCreateInfo ShaderCI;
+        ASSERT_TRUE(Reader.GetShader("TestVS", RENDER_DEVICE_TYPE_VULKAN, ShaderCI));
+        EXPECT_STREQ(ShaderCI.Desc.Name, "TestVS");
+        EXPECT_EQ(ShaderCI.Desc.ShaderType, SHADER_TYPE_VERTEX);
+        EXPECT_STREQ(ShaderCI.EntryPoint, "VSMain");
+        ASSERT_EQ(ShaderCI.ByteCodeSize, 4 * sizeof(Uint32));
+        EXPECT_EQ(reinterpret_cast<size_t>(ShaderCI.ByteCode) % sizeof(Uint32), 0u);
+        const auto* pWords = static_cast<const Uint32*>(ShaderCI.ByteCode);
+        EXPECT_EQ(pWords[0], 0x07230203u);
+        EXPECT_EQ(pWords[3], 3u);
+        // The byte code is not copied
+        EXPECT_GE(static_cast<const Uint8*>(ShaderCI.ByteCode), static_cast<const Uint8*>(pArchive->GetConstDataPtr()));
+    }
+
+    {
+        ShaderCreateInfo                           ShaderCI;
+        std::vector<PipelineArchiveShaderResource> Resources;
+        ASSERT_TRUE(Reader.GetShader("TestPS", RENDER_DEVICE_TYPE_VULKAN, ShaderCI, &Resources));
+        EXPECT_EQ(ShaderCI.Desc.ShaderType, SHADER_TYPE_PIXEL);
+        EXPECT_TRUE(ShaderCI.UseCombinedTextureSamplers);
+        EXPECT_STREQ(ShaderCI.CombinedSamplerSuffix, "_smplr");
+        EXPECT_EQ(ShaderCI.ByteCodeSize, 5u);
+        ASSERT_EQ(Resources.size(), 2u);
+        EXPECT_STREQ(Resources[0].Name, "g_Texture");
+        EXPECT_EQ(Resources[0].Type, SHADER_RESOURCE_TYPE_TEXTURE_SRV);
+        EXPECT_EQ(Resources[0].ArraySize, 1u);
+        EXPECT_STREQ(Resources[1].Name, "g_Buffers");
+        EXPECT_EQ(Resources[1].ArraySize, 4u);
+        EXPECT_EQ(Resources[1].Flags, PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER);
+
+        ASSERT_TRUE(Reader.GetShader("TestPS", RENDER_DEVICE_TYPE_D3D12, ShaderCI, &Resources));
+        EXPECT_TRUE(Resources.empty());
+    }
+
+    ShaderCreateInfo ShaderCI;
+    EXPECT_FALSE(Reader.GetShader("TestVS", RENDER_DEVICE_TYPE_D3D11, ShaderCI));
+    EXPECT_FALSE(Reader.GetShader("Missing", RENDER_DEVICE_TYPE_VULKAN, ShaderCI));
+}
+
+TEST(PipelineArchiveTest, ResourceSignatures)
+{
+    auto pArchive = CreateTestArchive();
+
+    PipelineArchiveReader Reader{pArchive};
+
+    PipelineResourceSignatureDesc     Desc;
+    std::vector<PipelineResourceDesc> Resources;
+    std::vector<ImmutableSamplerDesc> ImtblSamplers;
+    EXPECT_FALSE(Reader.GetResourceSignature("Missing", Desc, Resources, ImtblSamplers));
+    ASSERT_TRUE(Reader.GetResourceSignature("TestSignature", Desc, Resources, ImtblSamplers));
+
+    EXPECT_STREQ(Desc.Name, "TestSignature");
+    EXPECT_EQ(Desc.BindingIndex, 2);
+    EXPECT_TRUE(Desc.UseCombinedTextureSamplers);
+    EXPECT_STREQ(Desc.CombinedSamplerSuffix, "_smplr");
+    EXPECT_EQ(Desc.SRBAllocationGranularity, 16u);
+
+    ASSERT_EQ(Desc.NumResources, 2u);
+    EXPECT_EQ(Desc.Resources, Resources.data());
+    EXPECT_STREQ(Resources[1].Name, "g_Buffers");
+    EXPECT_EQ(Resources[1].ShaderStages, SHADER_TYPE_PIXEL);
+    EXPECT_EQ(Resources[1].ArraySize, 4u);
+    EXPECT_EQ(Resources[1].ResourceType, SHADER_RESOURCE_TYPE_BUFFER_SRV);
+    EXPECT_EQ(Resources[1].VarType, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    EXPECT_EQ(Resources[1].Flags, PIPELINE_RESOURCE_FLAG_FORMATTED_BUFFER);
+
+    ASSERT_EQ(Desc.NumImmutableSamplers, 1u);
+    EXPECT_STREQ(ImtblSamplers[0].SamplerOrTextureName, "g_Texture");
+    EXPECT_EQ(ImtblSamplers[0].ShaderStages, SHADER_TYPE_PIXEL);
+    EXPECT_EQ(ImtblSamplers[0].Desc.AddressU, TEXTURE_ADDRESS_WRAP);
+    EXPECT_EQ(ImtblSamplers[0].Desc.AddressW, TEXTURE_ADDRESS_CLAMP);
+    EXPECT_EQ(ImtblSamplers[0].Desc.MaxLOD, 8.f);
+}
+
+TEST(PipelineArchiveTest, Pipelines)
+{
+    auto pArchive = CreateTestArchive();
+
+    PipelineArchiveReader Reader{pArchive};
+
+    {
+        PipelineArchiveReader::PipelineInfo Info;
+        EXPECT_FALSE(Reader.GetPipeline("Missing", Info));
+        ASSERT_TRUE(Reader.GetPipeline("TestPipeline", Info));
+
+        EXPECT_STREQ(Info.Name, "TestPipeline");
+        EXPECT_EQ(Info.PipelineType, PIPELINE_TYPE_GRAPHICS);
+        EXPECT_EQ(Info.SRBAllocationGranularity, 8u);
+        ASSERT_EQ(Info.ShaderNames.size(), 2u);
+        EXPECT_STREQ(Info.ShaderNames[0], "TestVS");
+        EXPECT_STREQ(Info.ShaderNames[1], "TestPS");
+        ASSERT_EQ(Info.SignatureNames.size(), 1u);
+        EXPECT_STREQ(Info.SignatureNames[0], "TestSignature");
+
+        const auto& GraphicsPipeline = Info.GraphicsPipeline;
+        EXPECT_EQ(GraphicsPipeline.NumRenderTargets, 2);
+        EXPECT_EQ(GraphicsPipeline.RTVFormats[0], TEX_FORMAT_RGBA8_UNORM_SRGB);
+        EXPECT_EQ(GraphicsPipeline.RTVFormats[1], TEX_FORMAT_RG16_FLOAT);
+        EXPECT_EQ(GraphicsPipeline.RTVFormats[2], TEX_FORMAT_UNKNOWN);
+        EXPECT_EQ(GraphicsPipeline.DSVFormat, TEX_FORMAT_D32_FLOAT);
+        EXPECT_EQ(GraphicsPipeline.PrimitiveTopology, PRIMITIVE_TOPOLOGY_LINE_STRIP);
+        EXPECT_EQ(GraphicsPipeline.RasterizerDesc.CullMode, CULL_MODE_FRONT);
+        EXPECT_EQ(GraphicsPipeline.DepthStencilDesc.DepthFunc, COMPARISON_FUNC_GREATER);
+        EXPECT_TRUE(GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable);
+        EXPECT_EQ(GraphicsPipeline.SmplDesc.Count, 4);
+        EXPECT_EQ(GraphicsPipeline.pRenderPass, nullptr);
+
+        ASSERT_EQ(GraphicsPipeline.InputLayout.NumElements, 2u);
+        EXPECT_EQ(GraphicsPipeline.InputLayout.LayoutElements, Info.LayoutElements.data());
+        const auto& Elem = Info.LayoutElements[1];
+        EXPECT_STREQ(Elem.HLSLSemantic, "ATTRIB");
+        EXPECT_EQ(Elem.InputIndex, 1u);
+        EXPECT_EQ(Elem.BufferSlot, 1u);
+        EXPECT_EQ(Elem.NumComponents, 4u);
+        EXPECT_EQ(Elem.ValueType, VT_UINT8);
+        EXPECT_TRUE(Elem.IsNormalized);
+        EXPECT_EQ(Elem.Frequency, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE);
+    }
+
+    {
+        PipelineArchiveReader::PipelineInfo Info;
+        ASSERT_TRUE(Reader.GetPipeline("TestCompute", Info));
+        EXPECT_EQ(Info.PipelineType, PIPELINE_TYPE_COMPUTE);
+        ASSERT_EQ(Info.ShaderNames.size(), 1u);
+        EXPECT_STREQ(Info.ShaderNames[0], "TestCS");
+        EXPECT_TRUE(Info.SignatureNames.empty());
+        EXPECT_TRUE(Info.LayoutElements.empty());
+    }
+}
+
+TEST(PipelineArchiveTest, Names)
+{
+    auto pArchive = CreateTestArchive();
+
+    PipelineArchiveReader Reader{pArchive};
+
+    auto ToSortedStrings = [](const std::vector<const char*>& Names) {
+        std::vector<std::string> Strings{Names.begin(), Names.end()};
+        std::sort(Strings.begin(), Strings.end());
+        return Strings;
+    };
+
+    EXPECT_EQ(ToSortedStrings(Reader.GetShaderNames(RENDER_DEVICE_TYPE_VULKAN)), (std::vector<std::string>{"TestPS", "TestVS"}));
+    EXPECT_EQ(ToSortedStrings(Reader.GetShaderNames(RENDER_DEVICE_TYPE_D3D12)), (std::vector<std::string>{"TestPS"}));
+    EXPECT_TRUE(Reader.GetShaderNames(RENDER_DEVICE_TYPE_D3D11).empty());
+    EXPECT_EQ(ToSortedStrings(Reader.GetResourceSignatureNames()), (std::vector<std::string>{"TestSignature"}));
+    EXPECT_EQ(ToSortedStrings(Reader.GetPipelineNames()), (std::vector<std::string>{"TestCompute", "TestPipeline"}));
+}
+
+TEST(PipelineArchiveTest, Duplicates)
+{
+    PipelineArchiveWriter Writer;
+
+    const Uint32 ByteCode[] = {1, 2};
+
+    PipelineArchiveShaderDesc ShaderDesc;
+    ShaderDesc.Name         = "Shader";
+    ShaderDesc.DeviceType   = RENDER_DEVICE_TYPE_VULKAN;
+    ShaderDesc.ShaderType   = SHADER_TYPE_COMPUTE;
+    ShaderDesc.ByteCode     = ByteCode;
+    ShaderDesc.ByteCodeSize = sizeof(ByteCode);
+    EXPECT_TRUE(Writer.AddShader(ShaderDesc));
+    EXPECT_FALSE(Writer.AddShader(ShaderDesc));
+
+    PipelineResourceSignatureDesc SignDesc;
+    SignDesc.Name = "Signature";
+    EXPECT_TRUE(Writer.AddResourceSignature(SignDesc));
+    EXPECT_FALSE(Writer.AddResourceSignature(SignDesc));
+
+    PipelineArchivePipelineDesc PipelineDesc;
+    PipelineDesc.Name         = "Pipeline";
+    PipelineDesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    EXPECT_TRUE(Writer.AddPipeline(PipelineDesc));
+    EXPECT_FALSE(Writer.AddPipeline(PipelineDesc));
+
+    PipelineDesc.Name         = "RayTracing";
+    PipelineDesc.PipelineType = PIPELINE_TYPE_RAY_TRACING;
+    EXPECT_FALSE(Writer.AddPipeline(PipelineDesc));
+}
+
+TEST(PipelineArchiveTest, InvalidData)
+{
+    EXPECT_THROW(PipelineArchiveReader{nullptr}, std::runtime_error);
+
+    std::vector<Uint8> Garbage(64, 0xCD);
+    EXPECT_THROW(PipelineArchiveReader{MakeBlob(Garbage)}, std::runtime_error);
+
+    auto               pArchive = CreateTestArchive();
+    const auto*        pData    = static_cast<const Uint8*>(pArchive->GetConstDataPtr());
+    std::vector<Uint8> Truncated{pData, pData + pArchive->GetSize() / 2};
+    EXPECT_THROW(PipelineArchiveReader{MakeBlob(Truncated)}, std::runtime_error);
+}
+
+TEST(PipelineArchiveTest, InvalidCount)
+{
+    auto               pArchive = CreateTestArchive();
+    const auto*        pData    = static_cast<const Uint8*>(pArchive->GetConstDataPtr());
+    std::vector<Uint8> Data{pData, pData + pArchive->GetSize()};
+
+    // Find the signature resource count that follows the combined sampler suffix and the SRB allocation granularity
+    const Uint8 Pattern[] = {'_', 's', 'm', 'p', 'l', 'r', '\0', 16, 0, 0, 0, 2, 0, 0, 0};
+    auto        It        = std::search(Data.begin(), Data.end(), std::begin(Pattern), std::end(Pattern));
+    ASSERT_NE(It, Data.end());
+    const Uint32 HugeCount = 0x7FFFFFFF;
+    memcpy(&*(It + sizeof(Pattern) - sizeof(Uint32)), &HugeCount, sizeof(HugeCount));
+
+    // The record sizes are intact, so the archive itself loads fine
+    PipelineArchiveReader Reader{MakeBlob(Data)};
+
+    PipelineResourceSignatureDesc     Desc;
+    std::vector<PipelineResourceDesc> Resources;
+    std::vector<ImmutableSamplerDesc> ImtblSamplers;
+    EXPECT_THROW(Reader.GetResourceSignature("TestSignature", Desc, Resources, ImtblSamplers), std::runtime_error);
+    EXPECT_TRUE(Resources.empty());
+}
+
+} // namespace
@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include "ResidencyEviction.hpp"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestObject
+{
+    int    Id;
+    Uint64 Size;
+    Uint64 LastUsedFrame;
+};
+
+std::vector<int> GetIds(const std::vector<TestObject*>& Objects)
+{
+    std::vector<int> Ids;
+    for (const auto* pObject : Objects)
+        Ids.push_back(pObject->Id);
+    return Ids;
+}
+
+std::vector<TestObject*> GetPointers(std::vector<TestObject>& Objects)
+{
+    std::vector<TestObject*> Pointers;
+    for (auto& Object : Objects)
+        Pointers.push_back(&Object);
+    return Pointers;
+}
+
+// Budget of 1000 bytes, frame 10 is being recorded, frame 9 has been completed
+ResidencyEvictionAttribs GetAttribs(Uint64 CurrentUsage, Uint64 RequiredSize = 0)
+{
+    ResidencyEvictionAttribs Attribs;
+    Attribs.Budget             = 1000;
+    Attribs.CurrentUsage       = CurrentUsage;
+    Attribs.RequiredSize       = RequiredSize;
+    Attribs.CurrentFrame       = 10;
+    Attribs.LastCompletedFrame = 9;
+    Attribs.EvictionFrameCount = 2;
+    return Attribs;
+}
+
+TEST(GraphicsEngine_ResidencyEviction, WithinBudget)
+{
+    std::vector<TestObject> Objects = {{0, 100, 1}, {1, 100, 2}};
+
+    auto Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(900)), 0u);
+    EXPECT_TRUE(Candidates.empty());
+
+    Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(900, 100)), 0u);
+    EXPECT_TRUE(Candidates.empty());
+}
+
+TEST(GraphicsEngine_ResidencyEviction, LeastRecentlyUsedFirst)
+{
+    std::vector<TestObject> Objects = {{0, 100, 5}, {1, 100, 2}, {2, 100, 7}, {3, 100, 2}, {4, 100, 1}};
+
+    // 50 bytes over the budget: one object is enough
+    auto Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(1050)), 100u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{4}));
+
+    // 250 bytes over the budget. Objects used in the same frame keep their order.
+    Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(1250)), 300u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{4, 1, 3}));
+
+    // The size of the objects being made resident counts towards the usage
+    Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(950, 300)), 300u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{4, 1, 3}));
+}
+
+TEST(GraphicsEngine_ResidencyEviction, LargeObjects)
+{
+    std::vector<TestObject> Objects = {{0, 10, 3}, {1, 500, 4}, {2, 20, 1}};
+
+    // Eviction order does not depend on the object size
+    auto Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(1100)), 530u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{2, 0, 1}));
+}
+
+TEST(GraphicsEngine_ResidencyEviction, RecentlyUsedObjects)
+{
+    // Objects used in the last EvictionFrameCount frames are never evicted
+    std::vector<TestObject> Objects = {{0, 100, 8}, {1, 100, 9}, {2, 100, 10}, {3, 100, 7}};
+
+    auto Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, GetAttribs(2000)), 200u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{3, 0}));
+
+    auto Attribs               = GetAttribs(2000);
+    Attribs.EvictionFrameCount = 4;
+    Candidates                 = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, Attribs), 0u);
+    EXPECT_TRUE(Candidates.empty());
+}
+
+TEST(GraphicsEngine_ResidencyEviction, PendingFrames)
+{
+    // Objects used in frames that the GPU has not completed may still be accessed by command lists
+    std::vector<TestObject> Objects = {{0, 100, 3}, {1, 100, 5}, {2, 100, 6}};
+
+    auto Attribs               = GetAttribs(2000);
+    Attribs.LastCompletedFrame = 5;
+
+    auto Candidates = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, Attribs), 200u);
+    EXPECT_EQ(GetIds(Candidates), (std::vector<int>{0, 1}));
+
+    Attribs.LastCompletedFrame = 0;
+    Candidates                 = GetPointers(Objects);
+    EXPECT_EQ(SelectResidencyEvictionCandidates(Candidates, Attribs), 0u);
+    EXPECT_TRUE(Candidates.empty());
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "ShaderVariableNameIndex.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Local copy that can be bound to the const references taken by EXPECT_EQ
+constexpr Uint32 InvalidIndex = ShaderVariableNameIndex::InvalidIndex;
+
+ShaderVariableNameIndex CreateIndex(const std::vector<std::string>& Names)
+{
+    return ShaderVariableNameIndex{
+        static_cast<Uint32>(Names.size()),
+        [&Names](Uint32 Index) {
+            return Names[Index].c_str();
+        } //
+    };
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, Empty)
+{
+    const std::vector<std::string> Names;
+
+    auto Index = CreateIndex(Names);
+    EXPECT_EQ(Index.Find("g_Texture"), InvalidIndex);
+    EXPECT_EQ(Index.Find(""), InvalidIndex);
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, Find)
+{
+    std::vector<std::string> Names;
+    for (Uint32 i = 0; i < 257; ++i)
+        Names.emplace_back("g_Variable" + std::to_string(i));
+
+    auto Index = CreateIndex(Names);
+    for (Uint32 i = 0; i < Names.size(); ++i)
+    {
+        // Look up a copy to make sure that strings are compared by value
+        const std::string Name = Names[i];
+        EXPECT_EQ(Index.Find(Name.c_str()), i);
+    }
+
+    EXPECT_EQ(Index.Find("g_Variable"), InvalidIndex);
+    EXPECT_EQ(Index.Find("g_Variable257"), InvalidIndex);
+    EXPECT_EQ(Index.Find("g_Variable00"), InvalidIndex);
+}
+
+TEST(GraphicsEngine_ShaderVariableNameIndex, DuplicateNames)
+{
+    const std::vector<std::string> Names = {"g_Tex", "g_Sam", "g_Tex"};
+
+    auto Index = CreateIndex(Names);
+    EXPECT_EQ(Index.Find("g_Tex"), 0u);
+    EXPECT_EQ(Index.Find("g_Sam"), 1u);
+}
+
+} // namespace
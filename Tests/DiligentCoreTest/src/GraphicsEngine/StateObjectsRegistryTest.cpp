@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
+
+#include "StateObjectsRegistry.hpp"
+#include "ResourceMappingImpl.hpp"
+#include "ObjectBase.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "Timer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct TestObjectDesc : DeviceObjectAttribs
+{
+    Uint32 Value = 0;
+
+    bool operator==(const TestObjectDesc& RHS) const
+    {
+        return Value == RHS.Value;
+    }
+};
+
+} // namespace
+
+namespace std
+{
+template <>
+struct hash<TestObjectDesc>
+{
+    size_t operator()(const TestObjectDesc& Desc) const
+    {
+        return Diligent::ComputeHash(Desc.Value);
+    }
+};
+} // namespace std
+
+namespace
+{
+
+class TestObject final : public ObjectBase<IDeviceObject>
+{
+public:
+    TestObject(IReferenceCounters* pRefCounters, const TestObjectDesc& Desc) :
+        ObjectBase<IDeviceObject>{pRefCounters},
+        m_Desc{Desc}
+    {}
+
+    virtual const DeviceObjectAttribs& DILIGENT_CALL_TYPE GetDesc() const override { return m_Desc; }
+    virtual Int32 DILIGENT_CALL_TYPE GetUniqueID() const override { return static_cast<Int32>(m_Desc.Value); }
+    virtual void DILIGENT_CALL_TYPE SetUserData(IObject* pUserData) override {}
+    virtual IObject* DILIGENT_CALL_TYPE GetUserData() const override { return nullptr; }
+
+private:
+    const TestObjectDesc m_Desc;
+};
+
+RefCntAutoPtr<IDeviceObject> CreateTestObject(Uint32 Value)
+{
+    TestObjectDesc Desc;
+    Desc.Value = Value;
+    return RefCntAutoPtr<IDeviceObject>{MakeNewRCObj<TestObject>()(Desc)};
+}
+
+TEST(GraphicsEngine_StateObjectsRegistry, AddFind)
+{
+    StateObjectsRegistry<TestObjectDesc> Registry{DefaultRawMemoryAllocator::GetAllocator(), "test"};
+
+    constexpr Uint32                          NumObjects = 256;
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        Objects.emplace_back(CreateTestObject(i));
+        Registry.Add(static_cast<const TestObjectDesc&>(Objects.back()->GetDesc()), Objects.back());
+    }
+
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        TestObjectDesc Desc;
+        Desc.Value = i;
+
+        RefCntAutoPtr<IDeviceObject> pObject;
+        Registry.Find(Desc, &pObject);
+        EXPECT_EQ(pObject, Objects[i]);
+    }
+
+    // Expired objects are not returned
+    Objects[0].Release();
+    Registry.ReportDeletedObject();
+
+    TestObjectDesc Desc;
+    Desc.Value = 0;
+    RefCntAutoPtr<IDeviceObject> pObject;
+    Registry.Find(Desc, &pObject);
+    EXPECT_EQ(pObject, nullptr);
+
+    Objects.clear();
+}
+
+TEST(GraphicsEngine_ResourceMapping, AddGetRemove)
+{
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    RefCntAutoPtr<IResourceMapping> pMapping{MakeNewRCObj<ResourceMappingImpl>()(RawAllocator)};
+
+    constexpr Uint32                          NumObjects = 256;
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        Objects.emplace_back(CreateTestObject(i));
+        pMapping->AddResource(("Resource" + std::to_string(i)).c_str(), Objects.back(), true);
+    }
+    IDeviceObject* ppArray[] = {Objects[0], Objects[1], Objects[2]};
+    pMapping->AddResourceArray("Array", 0, ppArray, Uint32{3}, true);
+    EXPECT_EQ(pMapping->GetSize(), size_t{NumObjects} + 3);
+
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMapping->GetResource(("Resource" + std::to_string(i)).c_str(), &pObject, 0);
+        EXPECT_EQ(pObject, Objects[i]);
+    }
+    for (Uint32 i = 0; i < Uint32{3}; ++i)
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMapping->GetResource("Array", &pObject, i);
+        EXPECT_EQ(pObject, ppArray[i]);
+    }
+
+    pMapping->RemoveResourceByName("Resource10", 0);
+    pMapping->RemoveResourceByName("Array", 1);
+    EXPECT_EQ(pMapping->GetSize(), size_t{NumObjects} + 1);
+
+    RefCntAutoPtr<IDeviceObject> pObject;
+    pMapping->GetResource("Resource10", &pObject, 0);
+    EXPECT_EQ(pObject, nullptr);
+    pMapping->GetResource("Array", &pObject, 1);
+    EXPECT_EQ(pObject, nullptr);
+}
+
+TEST(GraphicsEngine_ResourceMapping, GetResourceByHash)
+{
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    RefCntAutoPtr<IResourceMapping> pMapping{MakeNewRCObj<ResourceMappingImpl>()(RawAllocator)};
+
+    RefCntAutoPtr<ResourceMappingImpl> pMappingImpl{pMapping, IID_ResourceMappingImpl};
+    ASSERT_NE(pMappingImpl, nullptr);
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    for (Uint32 i = 0; i < 4; ++i)
+        Objects.emplace_back(CreateTestObject(i));
+
+    pMapping->AddResource("Tex", Objects[0], true);
+    IDeviceObject* ppArray[] = {Objects[1], Objects[2], Objects[3]};
+    pMapping->AddResourceArray("Array", 0, ppArray, Uint32{3}, true);
+
+    const auto TexHash   = CStringHash<Char>{}("Tex");
+    const auto ArrayHash = CStringHash<Char>{}("Array");
+
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMappingImpl->GetResource("Tex", TexHash, &pObject, 0);
+        EXPECT_EQ(pObject, Objects[0]);
+    }
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMappingImpl->GetResource("Array", ArrayHash, &pObject, i);
+        EXPECT_EQ(pObject, ppArray[i]);
+    }
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMappingImpl->GetResource("Tex", TexHash, &pObject, 1);
+        EXPECT_EQ(pObject, nullptr);
+    }
+}
+
+// Measures lookup throughput with many threads querying the registry and the resource
+// mapping, compared to a hash map protected by a single lock.
+TEST(GraphicsEngine_StateObjectsRegistry, DISABLED_ContentionPerformance)
+{
+    auto& RawAllocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    constexpr Uint32 NumObjects       = 1024;
+    constexpr Uint32 LookupsPerThread = 1 << 18;
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<RefCntAutoPtr<IDeviceObject>> Objects;
+    std::vector<std::string>                  Names;
+
+    StateObjectsRegistry<TestObjectDesc> Registry{RawAllocator, "test"};
+    RefCntAutoPtr<IResourceMapping>      pMapping{MakeNewRCObj<ResourceMappingImpl>()(RawAllocator)};
+
+    ThreadingTools::LockFlag                                     SingleLockFlag;
+    std::unordered_map<TestObjectDesc, RefCntWeakPtr<IDeviceObject>> SingleLockMap;
+
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        Objects.emplace_back(CreateTestObject(i));
+        const auto& Desc = static_cast<const TestObjectDesc&>(Objects.back()->GetDesc());
+        Registry.Add(Desc, Objects.back());
+        SingleLockMap.emplace(Desc, RefCntWeakPtr<IDeviceObject>{Objects.back()});
+
+        Names.emplace_back("Resource" + std::to_string(i));
+        pMapping->AddResource(Names.back().c_str(), Objects.back(), true);
+    }
+
+    auto RunThreads = [&](const auto& Lookup) {
+        std::atomic<Uint32> NumFound{0};
+
+        Timer T;
+
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&, t]() {
+                Uint32 Found = 0;
+                for (Uint32 i = 0; i < LookupsPerThread; ++i)
+                {
+                    if (Lookup((i * 7919u + t * 104729u) % NumObjects))
+                        ++Found;
+                }
+                NumFound.fetch_add(Found);
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        EXPECT_EQ(NumFound.load(), NumThreads * LookupsPerThread);
+        return T.GetElapsedTime();
+    };
+
+    const auto SingleLockTime = RunThreads([&](Uint32 Idx) {
+        TestObjectDesc Desc;
+        Desc.Value = Idx;
+
+        ThreadingTools::LockHelper Lock{SingleLockFlag};
+
+        auto It = SingleLockMap.find(Desc);
+        return It != SingleLockMap.end() && It->second.Lock() != nullptr;
+    });
+
+    const auto RegistryTime = RunThreads([&](Uint32 Idx) {
+        TestObjectDesc Desc;
+        Desc.Value = Idx;
+
+        RefCntAutoPtr<IDeviceObject> pObject;
+        Registry.Find(Desc, &pObject);
+        return pObject != nullptr;
+    });
+
+    const auto MappingTime = RunThreads([&](Uint32 Idx) {
+        RefCntAutoPtr<IDeviceObject> pObject;
+        pMapping->GetResource(Names[Idx].c_str(), &pObject, 0);
+        return pObject != nullptr;
+    });
+
+    LOG_INFO_MESSAGE(NumThreads, " threads x ", LookupsPerThread, " lookups: single lock: ", SingleLockTime * 1000.0,
+                     " ms, StateObjectsRegistry: ", RegistryTime * 1000.0,
+                     " ms, ResourceMapping: ", MappingTime * 1000.0, " ms");
+
+    // Release the objects before the registry is destroyed
+    pMapping.Release();
+    Objects.clear();
+}
+
+} // namespace
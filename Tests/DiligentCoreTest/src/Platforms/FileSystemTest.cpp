@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "FileSystem.hpp"
+#include "FileWrapper.hpp"
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS
+#    include <fcntl.h>
+#    include <unistd.h>
+#    include "PosixMappedFileView.hpp"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Platforms_FileSystem, WatchDirectory)
+{
+    auto pWatcher = FileSystem::WatchDirectory(".");
+    if (!pWatcher)
+    {
+        GTEST_SKIP() << "Directory change notifications are not supported on this platform";
+    }
+
+    std::vector<String> ModifiedFiles;
+    pWatcher->GetModifiedFiles(ModifiedFiles);
+
+    {
+        FileWrapper File{"DirectoryWatcherTest.tmp", EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File != nullptr);
+        ASSERT_TRUE(File->Write("test", 4));
+    }
+
+    // Notifications are delivered asynchronously
+    bool Found = false;
+    for (int i = 0; i < 100 && !Found; ++i)
+    {
+        ModifiedFiles.clear();
+        pWatcher->GetModifiedFiles(ModifiedFiles);
+        Found = std::find(ModifiedFiles.begin(), ModifiedFiles.end(), "DirectoryWatcherTest.tmp") != ModifiedFiles.end();
+        if (!Found)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_TRUE(Found);
+
+    FileSystem::DeleteFile("DirectoryWatcherTest.tmp");
+}
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS
+TEST(Platforms_FileSystem, PosixMappedFileViewRegion)
+{
+    const char* FileName = "PosixMappedFileViewTest.tmp";
+
+    std::vector<Uint8> Data(20000);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 7 + i / 256);
+    {
+        FileWrapper File{FileName, EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File != nullptr);
+        ASSERT_TRUE(File->Write(Data.data(), Data.size()));
+    }
+
+    const int fd = open(FileName, O_RDONLY);
+    ASSERT_GE(fd, 0);
+    {
+        // Offsets that are not page-aligned are used by uncompressed Android assets
+        const size_t Offset = 5003;
+        const size_t Size   = 9001;
+
+        auto pView = PosixMappedFileView::Create(fd, Offset, Size);
+        ASSERT_NE(pView, nullptr);
+        ASSERT_EQ(pView->GetSize(), Size);
+        EXPECT_EQ(memcmp(pView->GetData(), Data.data() + Offset, Size), 0);
+
+        EXPECT_EQ(PosixMappedFileView::Create(fd, 0, 0), nullptr);
+    }
+    close(fd);
+
+    FileSystem::DeleteFile(FileName);
+}
+#endif
+
+} // namespace
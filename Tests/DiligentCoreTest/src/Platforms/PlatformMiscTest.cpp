@@ -27,6 +27,9 @@
 
 #include "PlatformMisc.hpp"
 
+#include <cstring>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace Diligent;
@@ -79,4 +82,87 @@ TEST(Platforms_PlatformMisc, CountOneBits)
     EXPECT_EQ(PlatformMisc::CountOneBits((Uint64{1} << 63) - 1), Uint64{63});
 }
 
+TEST(Platforms_PlatformMisc, GetCPUInfo)
+{
+    const auto Info = PlatformMisc::GetCPUInfo();
+    EXPECT_GE(Info.NumLogicalProcessors, Uint32{1});
+    EXPECT_GE(Info.NumCores, Uint32{1});
+    EXPECT_LE(Info.NumCores, Info.NumLogicalProcessors);
+    ASSERT_FALSE(Info.Clusters.empty());
+
+    Uint32 NumLogicalProcessors = 0;
+    Uint64 ProcessorMask        = 0;
+    for (size_t i = 0; i < Info.Clusters.size(); ++i)
+    {
+        const auto& Cluster = Info.Clusters[i];
+        EXPECT_GE(Cluster.NumLogicalProcessors, Cluster.NumCores);
+        if (i > 0)
+        {
+            EXPECT_LT(Cluster.Performance, Info.Clusters[i - 1].Performance);
+        }
+        EXPECT_EQ(ProcessorMask & Cluster.ProcessorMask, Uint64{0}) << "Clusters must not overlap";
+        ProcessorMask |= Cluster.ProcessorMask;
+        NumLogicalProcessors += Cluster.NumLogicalProcessors;
+    }
+    EXPECT_EQ(NumLogicalProcessors, Info.NumLogicalProcessors);
+    EXPECT_EQ(Info.GetPerformanceProcessorMask(), Info.Clusters[0].ProcessorMask);
+}
+
+TEST(Platforms_PlatformMisc, SetCurrentThreadAffinity)
+{
+#if PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_UNIVERSAL_WINDOWS
+    GTEST_SKIP() << "Thread affinity is not supported on this platform";
+#else
+    const auto PerfMask = PlatformMisc::GetCPUInfo().GetPerformanceProcessorMask();
+    ASSERT_NE(PerfMask, Uint64{0});
+
+    // Use a separate thread to not affect the affinity of the test thread
+    std::thread Worker{
+        [PerfMask]() {
+            const auto PrevMask = PlatformMisc::SetCurrentThreadAffinity(PerfMask);
+            ASSERT_NE(PrevMask, Uint64{0});
+
+            const auto LastProcessorMask = Uint64{1} << PlatformMisc::GetMSB(PerfMask & PrevMask);
+            EXPECT_NE(PlatformMisc::SetCurrentThreadAffinity(LastProcessorMask), Uint64{0});
+            EXPECT_EQ(PlatformMisc::SetCurrentThreadAffinity(PrevMask), LastProcessorMask);
+        } //
+    };
+    Worker.join();
+#endif
+}
+
+TEST(Platforms_PlatformMisc, SetCurrentThreadPriority)
+{
+    // Lowering the priority does not require privileges, but it may not be possible to raise
+    // it back, so use a separate thread.
+    std::thread Worker{
+        []() {
+            const auto PrevPriority = PlatformMisc::SetCurrentThreadPriority(PlatformMisc::ThreadPriority::BelowNormal);
+            EXPECT_NE(PrevPriority, PlatformMisc::ThreadPriority::Unknown);
+            EXPECT_EQ(PlatformMisc::SetCurrentThreadPriority(PlatformMisc::ThreadPriority::Lowest), PlatformMisc::ThreadPriority::BelowNormal);
+        } //
+    };
+    Worker.join();
+}
+
+TEST(Platforms_PlatformMisc, LargePages)
+{
+    const auto LargePageSize = PlatformMisc::GetLargePageSize();
+    if (LargePageSize == 0)
+        GTEST_SKIP() << "Large pages are not supported on this platform";
+
+    EXPECT_EQ(PlatformMisc::AllocateLargePages(LargePageSize + 1), nullptr);
+
+    const auto Size    = LargePageSize * 2;
+    auto*      pMemory = static_cast<Uint8*>(PlatformMisc::AllocateLargePages(Size));
+    if (pMemory == nullptr)
+        GTEST_SKIP() << "Large pages are not available to the process";
+
+    EXPECT_EQ(reinterpret_cast<size_t>(pMemory) % LargePageSize, size_t{0});
+    memset(pMemory, 0xAB, Size);
+    EXPECT_EQ(pMemory[Size - 1], Uint8{0xAB});
+
+    PlatformMisc::FreeLargePages(pMemory, Size);
+}
+
 } // namespace
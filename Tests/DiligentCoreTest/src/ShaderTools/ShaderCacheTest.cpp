@@ -0,0 +1,291 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *  
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *  
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *  
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence), 
+ *  contract, or otherwise, unless required by applicable law (such as deliberate 
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental, 
+ *  or consequential damages of any character arising as a result of this License or 
+ *  out of the use or inability to use the software (including but not limited to damages 
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and 
+ *  all other commercial damages or losses), even if such Contributor has been advised 
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ShaderCache.hpp"
+#include "DefaultShaderSourceStreamFactory.h"
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void WriteTestFile(const char* Path, const std::string& Content)
+{
+    FileWrapper File{Path, EFileAccessMode::Overwrite};
+    ASSERT_TRUE(File != nullptr);
+    ASSERT_TRUE(File->Write(Content.data(), Content.size()));
+}
+
+std::string ToString(const IDataBlob* pBlob)
+{
+    return pBlob != nullptr ?
+        std::string{static_cast<const char*>(pBlob->GetConstDataPtr()), pBlob->GetSize()} :
+        std::string{"<null>"};
+}
+
+ShaderCreateInfo GetTestShaderCI()
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.EntryPoint      = "main";
+    return ShaderCI;
+}
+
+constexpr char TestSource[] = "float4 main() : SV_Target { return float4(0.0, 0.0, 0.0, 0.0); }";
+
+ShaderCache::Key ComputeTestKey(const ShaderCreateInfo& ShaderCI, const char* Source = TestSource)
+{
+    return ShaderCache::ComputeKey(ShaderCI, Source, strlen(Source), "FXC", {5, 0});
+}
+
+TEST(ShaderTools_ShaderCache, Key)
+{
+    const auto ShaderCI = GetTestShaderCI();
+    const auto RefKey   = ComputeTestKey(ShaderCI);
+    EXPECT_EQ(RefKey, ComputeTestKey(ShaderCI));
+    EXPECT_EQ(RefKey.GetHash(), ComputeTestKey(ShaderCI).GetHash());
+
+    EXPECT_NE(RefKey, ComputeTestKey(ShaderCI, "float4 main() : SV_Target { return float4(1.0, 0.0, 0.0, 0.0); }"));
+    EXPECT_NE(RefKey, ShaderCache::ComputeKey(ShaderCI, TestSource, strlen(TestSource), "DXC", {5, 0}));
+    EXPECT_NE(RefKey, ShaderCache::ComputeKey(ShaderCI, TestSource, strlen(TestSource), "FXC", {5, 1}));
+    EXPECT_NE(RefKey, ShaderCache::ComputeKey(ShaderCI, TestSource, strlen(TestSource), "FXC", {5, 0, 0}));
+
+    {
+        auto CI            = ShaderCI;
+        CI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        EXPECT_NE(RefKey, ComputeTestKey(CI));
+    }
+    {
+        auto CI       = ShaderCI;
+        CI.EntryPoint = "main2";
+        EXPECT_NE(RefKey, ComputeTestKey(CI));
+    }
+    {
+        auto CI         = ShaderCI;
+        CI.CompileFlags = SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS;
+        EXPECT_NE(RefKey, ComputeTestKey(CI));
+    }
+    {
+        const ShaderMacro Macros0[] = {{"A", "1"}, {}};
+        const ShaderMacro Macros1[] = {{"A", "2"}, {}};
+        const ShaderMacro Macros2[] = {{"A1", ""}, {}};
+
+        auto CI   = ShaderCI;
+        CI.Macros = Macros0;
+        const auto Key0 = ComputeTestKey(CI);
+        CI.Macros       = Macros1;
+        const auto Key1 = ComputeTestKey(CI);
+        CI.Macros       = Macros2;
+        const auto Key2 = ComputeTestKey(CI);
+        EXPECT_NE(RefKey, Key0);
+        EXPECT_NE(Key0, Key1);
+        EXPECT_NE(Key0, Key2);
+    }
+    {
+        // Macros that follow a macro with null definition must be hashed too
+        const ShaderMacro Macros0[] = {{"A", nullptr}, {"B", "1"}, {}};
+        const ShaderMacro Macros1[] = {{"A", nullptr}, {"B", "2"}, {}};
+        const ShaderMacro Macros2[] = {{"A", ""}, {"B", "1"}, {}};
+
+        auto CI   = ShaderCI;
+        CI.Macros = Macros0;
+        const auto Key0 = ComputeTestKey(CI);
+        CI.Macros       = Macros1;
+        const auto Key1 = ComputeTestKey(CI);
+        CI.Macros       = Macros2;
+        const auto Key2 = ComputeTestKey(CI);
+        EXPECT_NE(Key0, Key1);
+        // Null definition is equivalent to an empty one
+        EXPECT_EQ(Key0, Key2);
+    }
+}
+
+TEST(ShaderTools_ShaderCache, KeyIsNotAmbiguous)
+{
+    ShaderCache::Key Key0;
+    Key0.AppendData("ab", 2);
+    Key0.AppendData("c", 1);
+
+    ShaderCache::Key Key1;
+    Key1.AppendData("a", 1);
+    Key1.AppendData("bc", 2);
+    EXPECT_NE(Key0, Key1);
+
+    ShaderCache::Key NullStr;
+    NullStr.AppendString(nullptr);
+    ShaderCache::Key EmptyStr;
+    EmptyStr.AppendString("");
+    EXPECT_NE(NullStr, EmptyStr);
+}
+
+TEST(ShaderTools_ShaderCache, FindAdd)
+{
+    ShaderCache Cache;
+
+    const auto ShaderCI = GetTestShaderCI();
+    const auto Key0     = ComputeTestKey(ShaderCI);
+    const auto Key1     = ComputeTestKey(ShaderCI, "void main() {}");
+
+    EXPECT_EQ(Cache.Find(Key0), nullptr);
+
+    const std::string ByteCode0 = "Byte code 0";
+    const std::string ByteCode1 = "Byte code 1";
+    Cache.Add(Key0, ByteCode0.data(), ByteCode0.size());
+    EXPECT_EQ(ToString(Cache.Find(Key0)), ByteCode0);
+    EXPECT_EQ(Cache.Find(Key1), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pByteCode1{MakeNewRCObj<DataBlobImpl>{}(ByteCode1.size())};
+    memcpy(pByteCode1->GetDataPtr(), ByteCode1.data(), ByteCode1.size());
+    Cache.Add(Key1, pByteCode1);
+    EXPECT_EQ(Cache.Find(Key1), pByteCode1);
+
+    // The first byte code for the key is kept
+    Cache.Add(Key0, ByteCode1.data(), ByteCode1.size());
+    EXPECT_EQ(ToString(Cache.Find(Key0)), ByteCode0);
+}
+
+TEST(ShaderTools_ShaderCache, CompilerOutput)
+{
+    ShaderCache Cache;
+
+    const auto Key = ComputeTestKey(GetTestShaderCI());
+
+    IDataBlob* pCompilerOutput = MakeNewRCObj<DataBlobImpl>{}(4);
+    pCompilerOutput->AddRef();
+
+    // A miss does not touch the output: the compiler sets it
+    EXPECT_EQ(Cache.Find(Key, &pCompilerOutput), nullptr);
+    EXPECT_NE(pCompilerOutput, nullptr);
+
+    const Uint32 ByteCode = 0x07230203;
+    Cache.Add(Key, &ByteCode, sizeof(ByteCode));
+
+    // A hit means no compilation, so there is no compiler output
+    EXPECT_NE(Cache.Find(Key, &pCompilerOutput), nullptr);
+    EXPECT_EQ(pCompilerOutput, nullptr);
+    if (pCompilerOutput != nullptr)
+        pCompilerOutput->Release();
+}
+
+TEST(ShaderTools_ShaderCache, Includes)
+{
+    WriteTestFile("ShaderCacheTestInc.tmp", "float4 g_Color;\n");
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    CreateDefaultShaderSourceStreamFactory(nullptr, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    auto ShaderCI                       = GetTestShaderCI();
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+
+    constexpr char Source[] = "#include \"ShaderCacheTestInc.tmp\"\n"
+                              "float4 main() : SV_Target { return g_Color; }\n";
+
+    const auto Key0 = ComputeTestKey(ShaderCI, Source);
+    EXPECT_EQ(Key0, ComputeTestKey(ShaderCI, Source));
+
+    // Changing the included file invalidates the key
+    WriteTestFile("ShaderCacheTestInc.tmp", "float4 g_Color = float4(1.0, 0.0, 0.0, 1.0);\n");
+    const auto Key1 = ComputeTestKey(ShaderCI, Source);
+    EXPECT_NE(Key0, Key1);
+
+    ShaderCache Cache;
+    Cache.Add(Key0, "0", 1);
+    EXPECT_EQ(Cache.Find(Key1), nullptr);
+
+    FileSystem::DeleteFile("ShaderCacheTestInc.tmp");
+}
+
+TEST(ShaderTools_ShaderCache, Disk)
+{
+    const char*       Dir      = "ShaderCacheTest.tmp";
+    const auto        ShaderCI = GetTestShaderCI();
+    const auto        Key0     = ComputeTestKey(ShaderCI);
+    // The key data has the same size as that of Key0
+    const auto        Key1     = ComputeTestKey(ShaderCI, "float4 main() : SV_Target { return float4(1.0, 0.0, 0.0, 0.0); }");
+    const std::string ByteCode = "Byte code";
+    ASSERT_EQ(Key0.GetData().size(), Key1.GetData().size());
+
+    auto GetFilePath = [&](const ShaderCache::Key& Key) {
+        char Name[32];
+        snprintf(Name, sizeof(Name), "%016llx.bin", static_cast<unsigned long long>(Key.GetHash()));
+        return std::string{Dir} + FileSystem::GetSlashSymbol() + Name;
+    };
+    FileSystem::DeleteFile(GetFilePath(Key0).c_str());
+    FileSystem::DeleteFile(GetFilePath(Key1).c_str());
+
+    {
+        ShaderCache Cache{Dir};
+        Cache.Add(Key0, ByteCode.data(), ByteCode.size());
+    }
+    ASSERT_TRUE(FileSystem::FileExists(GetFilePath(Key0).c_str()));
+
+    {
+        // The byte code is loaded by another cache instance
+        ShaderCache Cache{Dir};
+        EXPECT_EQ(ToString(Cache.Find(Key0)), ByteCode);
+        EXPECT_EQ(Cache.Find(Key1), nullptr);
+    }
+
+    {
+        // Simulate a hash collision: the file for Key1 contains the data of Key0.
+        std::vector<Uint8> FileData;
+        {
+            FileWrapper File{GetFilePath(Key0).c_str(), EFileAccessMode::Read};
+            ASSERT_TRUE(File != nullptr);
+            FileData.resize(File->GetSize());
+            ASSERT_TRUE(File->Read(FileData.data(), FileData.size()));
+        }
+        // The key hash follows the magic number and the version in the file header
+        const Uint64 Key1Hash = Key1.GetHash();
+        memcpy(&FileData[8], &Key1Hash, sizeof(Key1Hash));
+        {
+            FileWrapper File{GetFilePath(Key1).c_str(), EFileAccessMode::Overwrite};
+            ASSERT_TRUE(File != nullptr);
+            ASSERT_TRUE(File->Write(FileData.data(), FileData.size()));
+        }
+
+        ShaderCache Cache{Dir};
+        EXPECT_EQ(Cache.Find(Key1), nullptr);
+    }
+
+    FileSystem::DeleteFile(GetFilePath(Key0).c_str());
+    FileSystem::DeleteFile(GetFilePath(Key1).c_str());
+}
+
+} // namespace
@@ -29,21 +29,25 @@
 
 void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 {
-    const struct DeviceContextDesc* pDesc       = NULL;
-    Uint64                          FrameNumber = 0;
+    const struct DeviceContextDesc*  pDesc       = NULL;
+    Uint64                           FrameNumber = 0;
+    const struct DeviceContextStats* pStats      = NULL;
+    struct IMemoryAllocator*         pFrameAlloc = NULL;
 
     pDesc = IDeviceContext_GetDesc(pCtx);
     (void)(pDesc);
 
-    IDeviceContext_Begin(pCtx, 0u);
+    IDeviceContext_Begin(pCtx, 0u, COMMAND_LIST_FLAG_NONE);
 
     IDeviceContext_TransitionShaderResources(pCtx, (struct IPipelineState*)NULL, (struct IShaderResourceBinding*)NULL);
     IDeviceContext_TransitionResourceStates(pCtx, 1u, (const struct StateTransitionDesc*)NULL);
 
     IDeviceContext_SetPipelineState(pCtx, (struct IPipelineState*)NULL);
     IDeviceContext_CommitShaderResources(pCtx, (struct IShaderResourceBinding*)NULL, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    IDeviceContext_SetInlineConstants(pCtx, (const void*)NULL, 0u, 0u);
     IDeviceContext_SetStencilRef(pCtx, 1u);
     IDeviceContext_SetBlendFactors(pCtx, (const float*)NULL);
+    IDeviceContext_SetDynamicStates(pCtx, (struct DynamicStateAttribs*)NULL);
     IDeviceContext_SetVertexBuffers(pCtx, 0u, 1u, (struct IBuffer**)NULL, (const Uint32*)NULL, RESOURCE_STATE_TRANSITION_MODE_NONE, SET_VERTEX_BUFFERS_FLAG_RESET);
     IDeviceContext_InvalidateState(pCtx);
     IDeviceContext_SetIndexBuffer(pCtx, (struct IBuffer*)NULL, 0u, RESOURCE_STATE_TRANSITION_MODE_NONE);
@@ -60,6 +64,8 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     IDeviceContext_DrawIndexed(pCtx, (struct DrawIndexedAttribs*)NULL);
     IDeviceContext_DrawIndirect(pCtx, (struct DrawIndirectAttribs*)NULL, (struct IBuffer*)NULL);
     IDeviceContext_DrawIndexedIndirect(pCtx, (struct DrawIndexedIndirectAttribs*)NULL, (struct IBuffer*)NULL);
+    IDeviceContext_DrawIndirectCount(pCtx, (struct DrawIndirectCountAttribs*)NULL, (struct IBuffer*)NULL, (struct IBuffer*)NULL);
+    IDeviceContext_DrawIndexedIndirectCount(pCtx, (struct DrawIndexedIndirectCountAttribs*)NULL, (struct IBuffer*)NULL, (struct IBuffer*)NULL);
     IDeviceContext_DrawMesh(pCtx, (struct DrawMeshAttribs*)NULL);
     IDeviceContext_DrawMeshIndirect(pCtx, (struct DrawMeshIndirectAttribs*)NULL, (struct IBuffer*)NULL);
     IDeviceContext_DrawMeshIndirectCount(pCtx, (struct DrawMeshIndirectCountAttribs*)NULL, (struct IBuffer*)NULL, (struct IBuffer*)NULL);
@@ -79,22 +85,34 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
     FrameNumber = IDeviceContext_GetFrameNumber(pCtx);
     (void)(FrameNumber);
 
+    pStats = IDeviceContext_GetStats(pCtx);
+    (void)(pStats);
+
+    pFrameAlloc = IDeviceContext_GetFrameAllocator(pCtx);
+    (void)(pFrameAlloc);
+
     IDeviceContext_BeginQuery(pCtx, (struct IQuery*)NULL);
     IDeviceContext_EndQuery(pCtx, (struct IQuery*)NULL);
+    IDeviceContext_BeginConditionalRendering(pCtx, (struct IQuery*)NULL);
+    IDeviceContext_EndConditionalRendering(pCtx);
 
     IDeviceContext_UpdateBuffer(pCtx, (struct IBuffer*)NULL, 1u, 1u, NULL, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_CopyBuffer(pCtx, (struct IBuffer*)NULL, 0u, RESOURCE_STATE_TRANSITION_MODE_NONE, (struct IBuffer*)NULL, 0u, 128u, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_MapBuffer(pCtx, (struct IBuffer*)NULL, MAP_WRITE, MAP_FLAG_DISCARD, (void**)NULL);
     IDeviceContext_UnmapBuffer(pCtx, (struct IBuffer*)NULL, MAP_WRITE);
     IDeviceContext_UpdateTexture(pCtx, (struct ITexture*)NULL, 0u, 0u, (const struct Box*)NULL, (const struct TextureSubResData*)NULL, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_NONE);
+    IDeviceContext_UpdateTextureRegions(pCtx, (struct ITexture*)NULL, (const struct TextureRegionUpdate*)NULL, 0u, RESOURCE_STATE_TRANSITION_MODE_NONE);
     IDeviceContext_CopyTexture(pCtx, (const struct CopyTextureAttribs*)NULL);
     IDeviceContext_MapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u, MAP_WRITE, MAP_FLAG_DISCARD, (const struct Box*)NULL, (struct MappedTextureSubresource*)NULL);
     IDeviceContext_UnmapTextureSubresource(pCtx, (struct ITexture*)NULL, 0u, 0u);
     IDeviceContext_GenerateMips(pCtx, (struct ITextureView*)NULL);
+    IDeviceContext_GenerateMipsBatch(pCtx, (struct ITextureView**)NULL, 0);
     IDeviceContext_ResolveTextureSubresource(pCtx, (struct ITexture*)NULL, (struct ITexture*)NULL, (const struct ResolveTextureSubresourceAttribs*)NULL);
+    IDeviceContext_UpdateTileMappings(pCtx, (const struct UpdateTileMappingsAttribs*)NULL);
 
     IDeviceContext_BuildBLAS(pCtx, (struct BuildBLASAttribs*)NULL);
     IDeviceContext_BuildTLAS(pCtx, (struct BuildTLASAttribs*)NULL);
+    IDeviceContext_BuildBLASBatch(pCtx, (struct BuildBLASBatchAttribs*)NULL);
     IDeviceContext_CopyBLAS(pCtx, (struct CopyBLASAttribs*)NULL);
     IDeviceContext_CopyTLAS(pCtx, (struct CopyTLASAttribs*)NULL);
     IDeviceContext_WriteBLASCompactedSize(pCtx, (struct WriteBLASCompactedSizeAttribs*)NULL);
@@ -37,4 +37,8 @@ void TestEngineFactortCInterface(struct IEngineFactory* pFactory)
 
     struct Version MinVersion = {0, 0};
     IEngineFactory_EnumerateAdapters(pFactory, MinVersion, (Uint32*)NULL, (struct GraphicsAdapterInfo*)NULL);
+
+    struct ThreadPoolCreateInfo PoolCI = {0};
+    struct IThreadPool*         pPool  = NULL;
+    IEngineFactory_CreateThreadPool(pFactory, &PoolCI, &pPool);
 }
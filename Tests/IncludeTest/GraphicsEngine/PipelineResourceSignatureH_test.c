@@ -46,4 +46,6 @@ void TestPipelineResourceSignature(struct IPipelineResourceSignature* pSign)
     (void)Comp;
 
     IPipelineResourceSignature_InitializeStaticSRBResources(pSign, (struct IShaderResourceBinding*)NULL);
+
+    IPipelineResourceSignature_GetCachedShaderResourceBinding(pSign, (const CachedSRBResource*)NULL, 0, (struct IShaderResourceBinding**)NULL);
 }
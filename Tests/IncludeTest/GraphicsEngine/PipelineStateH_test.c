@@ -49,4 +49,10 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
     (void)Compatible;
 
     IPipelineState_InitializeStaticSRBResources(pPSO, (struct IShaderResourceBinding*)NULL);
+
+    PIPELINE_STATE_STATUS Status = IPipelineState_GetStatus(pPSO);
+    (void)Status;
+
+    bool Swapped = IPipelineState_SwapShaders(pPSO, (IPipelineState*)NULL);
+    (void)Swapped;
 }
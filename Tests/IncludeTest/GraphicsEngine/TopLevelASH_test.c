@@ -32,6 +32,8 @@ void TestTopLevelAS_CInterface(ITopLevelAS* pTLAS)
     TLASInstanceDesc InstDesc = ITopLevelAS_GetInstanceDesc(pTLAS, "Name");
     (void)InstDesc;
 
+    InstDesc = ITopLevelAS_GetInstanceDescByIndex(pTLAS, 0);
+
     TLASBuildInfo BuildInfo = ITopLevelAS_GetBuildInfo(pTLAS);
     (void)BuildInfo;
 
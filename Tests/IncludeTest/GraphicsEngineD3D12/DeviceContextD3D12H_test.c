@@ -35,4 +35,7 @@ void TestDeviceContextD3D12_CInterface(IDeviceContextD3D12* pCtx)
 
     ID3D12GraphicsCommandList* pd3d12CmdList = IDeviceContextD3D12_GetD3D12CommandList(pCtx);
     (void)pd3d12CmdList;
+
+    ExecuteIndirectAttribsD3D12 Attribs = {0};
+    IDeviceContextD3D12_ExecuteIndirect(pCtx, &Attribs);
 }
@@ -32,4 +32,7 @@ void TestBufferGL_CInterface(IBufferGL* pBuffer)
 {
     GLuint Handle = IBufferGL_GetGLBufferHandle(pBuffer);
     (void)Handle;
+
+    bool IsPersistent = IBufferGL_IsPersistentlyMapped(pBuffer);
+    (void)IsPersistent;
 }
@@ -38,6 +38,8 @@ void TestCommandQueueVk_CInterface(ICommandQueueVk* pQueue)
 
     ICommandQueueVk_Present(pQueue, (VkPresentInfoKHR*)NULL);
 
+    ICommandQueueVk_BindSparse(pQueue, (VkBindSparseInfo*)NULL);
+
     VkQueue vkQueue = ICommandQueueVk_GetVkQueue(pQueue);
     (void)vkQueue;
 